@@ -5,47 +5,126 @@
 /* Description: Class to represent a collection of a single asset type
 /************************************************************************/
 #pragma once
+#include <mutex>
+#include <atomic>
+#include <stdint.h>
+#include "Engine/Assets/AssetDB.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Utility/StringID.hpp"
 #include "Engine/Rendering/Resources/Texture.hpp"
 
+// Entries are stored in fixed chunks that are never moved, so readers never see a reallocation
+#define ASSET_COLLECTION_CHUNK_SIZE (256)
+#define ASSET_COLLECTION_MAX_CHUNKS (256)
+#define ASSET_COLLECTION_INITIAL_TABLE_SIZE (64)		// Power of two, doubled whenever it's half full
+
+// Lookups from any thread never lock - only adds are serialized, and they publish each entry with
+// a release store after it's fully written
+// Assets are never removed, so an AssetID stays valid for the whole run
 template <typename RESOURCETYPE>
 class AssetCollection
 {
 	// Only the database can access any members of this class
 	friend class AssetDB;
 
+private:
+	//-----Private Types-----
+
+	struct AssetEntry_t
+	{
+		std::string		name;
+		StringID		nameHash = 0;		// Stored with the entry so tables grow without rehashing strings
+		RESOURCETYPE*	resource = nullptr;
+	};
+
+	// Open addressed with linear probing, each slot holding an AssetID + 1 (0 is empty)
+	// Replaced tables are kept, since a reader could still be probing one
+	struct AssetTable_t
+	{
+		uint32_t				capacity = 0;
+		std::atomic<uint32_t>*	slots = nullptr;
+		AssetTable_t*			previousTable = nullptr;
+	};
+
+
 private:
 	//-----Private Methods-----
 
 	static RESOURCETYPE*	GetAsset(const std::string& name);
+	static RESOURCETYPE*	GetAsset(AssetID assetID);
+	static AssetID			GetAssetID(const std::string& name);
 	static bool				AddAsset(const std::string& name, RESOURCETYPE* resource);
+	static int				GetAssetCount();
+
+	static AssetEntry_t&	GetEntry(AssetID assetID);
+	static AssetID			FindInTable(const AssetTable_t* table, const std::string& name, StringID nameHash);
+	static void				InsertInTable(AssetTable_t* table, AssetID assetID, StringID nameHash);
+	static AssetTable_t*	CreateTable(uint32_t capacity, uint32_t assetCount, AssetTable_t* previousTable);
 
 
 private:
 	//-----Private Data-----
 
-	static std::map<std::string, RESOURCETYPE*> s_collection;
+	static std::atomic<AssetEntry_t*>	s_chunks[ASSET_COLLECTION_MAX_CHUNKS];
+	static std::atomic<uint32_t>		s_assetCount;
+	static std::atomic<AssetTable_t*>	s_table;
+	static std::mutex					s_addLock;
 
 };
 
 
+template <typename RESOURCETYPE>
+std::atomic<typename AssetCollection<RESOURCETYPE>::AssetEntry_t*> AssetCollection<RESOURCETYPE>::s_chunks[ASSET_COLLECTION_MAX_CHUNKS];
+
+template <typename RESOURCETYPE>
+std::atomic<uint32_t> AssetCollection<RESOURCETYPE>::s_assetCount(0);
+
+template <typename RESOURCETYPE>
+std::atomic<typename AssetCollection<RESOURCETYPE>::AssetTable_t*> AssetCollection<RESOURCETYPE>::s_table(nullptr);
+
+template <typename RESOURCETYPE>
+std::mutex AssetCollection<RESOURCETYPE>::s_addLock;
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the resource given by the name, returns nullptr if not found
 //
 template <typename RESOURCETYPE>
-std::map<std::string, RESOURCETYPE*> AssetCollection<RESOURCETYPE>::s_collection;
+RESOURCETYPE* AssetCollection<RESOURCETYPE>::GetAsset(const std::string& name)
+{
+	return GetAsset(GetAssetID(name));
+}
+
 
+//-----------------------------------------------------------------------------------------------
+// Returns the resource with the ID, without hashing anything; nullptr if it isn't one of this collection's
+//
 template <typename RESOURCETYPE>
-RESOURCETYPE* AssetCollection<RESOURCETYPE>::GetAsset(const std::string& name)
+RESOURCETYPE* AssetCollection<RESOURCETYPE>::GetAsset(AssetID assetID)
 {
-	bool resourceExists = (s_collection.find(name) != s_collection.end());
-	
-	if (resourceExists)
+	if (assetID >= s_assetCount.load(std::memory_order_acquire))
 	{
-		return s_collection[name];
+		return nullptr;
 	}
 
-	return nullptr;
+	return GetEntry(assetID).resource;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the ID of the resource given by the name, or INVALID_ASSET_ID if not found
+//
+template <typename RESOURCETYPE>
+AssetID AssetCollection<RESOURCETYPE>::GetAssetID(const std::string& name)
+{
+	const AssetTable_t* table = s_table.load(std::memory_order_acquire);
+
+	if (table == nullptr)
+	{
+		return INVALID_ASSET_ID;
+	}
+
+	return FindInTable(table, name, HashStringID(name));
 }
 
 
@@ -55,12 +134,140 @@ RESOURCETYPE* AssetCollection<RESOURCETYPE>::GetAsset(const std::string& name)
 template <typename RESOURCETYPE>
 bool AssetCollection<RESOURCETYPE>::AddAsset(const std::string& name, RESOURCETYPE* resource)
 {
-	bool resourceAlreadyExists = s_collection.find(name) != s_collection.end();
+	std::lock_guard<std::mutex> lock(s_addLock);
+
+	StringID nameHash = InternStringID(name);
+	AssetTable_t* table = s_table.load(std::memory_order_relaxed);
+
+	bool resourceAlreadyExists = (table != nullptr && FindInTable(table, name, nameHash) != INVALID_ASSET_ID);
+
+	if (resourceAlreadyExists)
+	{
+		return false;
+	}
+
+	AssetID assetID = s_assetCount.load(std::memory_order_relaxed);
+	ASSERT_OR_DIE(assetID < ASSET_COLLECTION_CHUNK_SIZE * ASSET_COLLECTION_MAX_CHUNKS, Stringf("Error: AssetCollection::AddAsset() is full, couldn't add \"%s\"", name.c_str()));
+
+	uint32_t chunkIndex = assetID / ASSET_COLLECTION_CHUNK_SIZE;
+	if (s_chunks[chunkIndex].load(std::memory_order_relaxed) == nullptr)
+	{
+		s_chunks[chunkIndex].store(new AssetEntry_t[ASSET_COLLECTION_CHUNK_SIZE], std::memory_order_release);
+	}
+
+	AssetEntry_t& entry = GetEntry(assetID);
+	entry.name = name;
+	entry.nameHash = nameHash;
+	entry.resource = resource;
+
+	// Keep the table at most half full, so probes stay short and always hit an empty slot
+	if (table == nullptr || (assetID + 1) * 2 > table->capacity)
+	{
+		uint32_t capacity = (table == nullptr ? ASSET_COLLECTION_INITIAL_TABLE_SIZE : table->capacity * 2);
+		AssetTable_t* newTable = CreateTable(capacity, assetID, table);
+
+		InsertInTable(newTable, assetID, nameHash);
+		s_assetCount.store(assetID + 1, std::memory_order_release);
+		s_table.store(newTable, std::memory_order_release);
+	}
+	else
+	{
+		s_assetCount.store(assetID + 1, std::memory_order_release);
+		InsertInTable(table, assetID, nameHash);
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of resources in the collection, whose IDs are 0 to count - 1
+//
+template <typename RESOURCETYPE>
+int AssetCollection<RESOURCETYPE>::GetAssetCount()
+{
+	return (int) s_assetCount.load(std::memory_order_acquire);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the entry for the ID, which must already be allocated
+//
+template <typename RESOURCETYPE>
+typename AssetCollection<RESOURCETYPE>::AssetEntry_t& AssetCollection<RESOURCETYPE>::GetEntry(AssetID assetID)
+{
+	AssetEntry_t* chunk = s_chunks[assetID / ASSET_COLLECTION_CHUNK_SIZE].load(std::memory_order_acquire);
+	return chunk[assetID % ASSET_COLLECTION_CHUNK_SIZE];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Probes the table for the name, comparing hashes before strings
+//
+template <typename RESOURCETYPE>
+AssetID AssetCollection<RESOURCETYPE>::FindInTable(const AssetTable_t* table, const std::string& name, StringID nameHash)
+{
+	uint32_t mask = table->capacity - 1;
+	uint32_t slotIndex = nameHash & mask;
+
+	while (true)
+	{
+		uint32_t slotValue = table->slots[slotIndex].load(std::memory_order_acquire);
+
+		if (slotValue == 0)
+		{
+			return INVALID_ASSET_ID;
+		}
+
+		const AssetEntry_t& entry = GetEntry(slotValue - 1);
+		if (entry.nameHash == nameHash && entry.name == name)
+		{
+			return slotValue - 1;
+		}
+
+		slotIndex = (slotIndex + 1) & mask;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Puts the ID in the first empty slot from its hash, publishing the entry to readers of the table
+//
+template <typename RESOURCETYPE>
+void AssetCollection<RESOURCETYPE>::InsertInTable(AssetTable_t* table, AssetID assetID, StringID nameHash)
+{
+	uint32_t mask = table->capacity - 1;
+	uint32_t slotIndex = nameHash & mask;
+
+	while (table->slots[slotIndex].load(std::memory_order_relaxed) != 0)
+	{
+		slotIndex = (slotIndex + 1) & mask;
+	}
+
+	table->slots[slotIndex].store(assetID + 1, std::memory_order_release);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Makes a table holding the first assetCount entries, to be published in place of the previous one
+//
+template <typename RESOURCETYPE>
+typename AssetCollection<RESOURCETYPE>::AssetTable_t* AssetCollection<RESOURCETYPE>::CreateTable(uint32_t capacity, uint32_t assetCount, AssetTable_t* previousTable)
+{
+	AssetTable_t* table = new AssetTable_t();
+	table->capacity = capacity;
+	table->slots = new std::atomic<uint32_t>[capacity];
+	table->previousTable = previousTable;
+
+	for (uint32_t slotIndex = 0; slotIndex < capacity; ++slotIndex)
+	{
+		table->slots[slotIndex].store(0, std::memory_order_relaxed);
+	}
 
-	if (!resourceAlreadyExists)
+	for (AssetID assetID = 0; assetID < assetCount; ++assetID)
 	{
-		s_collection[name] = resource;
+		InsertInTable(table, assetID, GetEntry(assetID).nameHash);
 	}
 
-	return !resourceAlreadyExists;
+	return table;
 }
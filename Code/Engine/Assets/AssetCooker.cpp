@@ -0,0 +1,565 @@
+/************************************************************************/
+/* File: AssetCooker.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the AssetCooker class
+/************************************************************************/
+#include "Engine/Core/File.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Assets/AssetCooker.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Assets/AssimpLoader.hpp"
+#include "Engine/Assets/XmlSchema.hpp"
+#include "Engine/Assets/CookedMeshFile.hpp"
+#include "Engine/Assets/CookedXmlFile.hpp"
+#include "Engine/Assets/AssetHotReloader.hpp"
+#include "Engine/Networking/BytePacker.hpp"
+#include "Engine/Rendering/Animation/Pose.hpp"
+#include "Engine/Core/Time/ProfileScoped.hpp"
+#include "Engine/Rendering/Meshes/MeshBuilder.hpp"
+#include "Engine/Rendering/Animation/Skeleton.hpp"
+#include "Engine/Core/DeveloperConsole/Command.hpp"
+#include "Engine/Core/DeveloperConsole/DevConsole.hpp"
+#include "Engine/Rendering/Meshes/MeshGroupBuilder.hpp"
+#include "Engine/Rendering/Animation/AnimationClip.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Matrices are written as their raw floats
+static_assert(sizeof(Matrix44) == 64, "Matrix44 changed size, bump COOKED_SKELETON_VERSION and COOKED_ANIMATION_VERSION");
+
+// Packs start this big and grow as they're written
+#define COOKER_INITIAL_PACKER_SIZE (4096)
+
+static std::string		RemoveExtension(const std::string& filepath);
+static bool				WritePackerToFile(const std::string& filepath, const BytePacker& packer);
+static BytePacker*		ReadFileToPacker(const std::string& filepath);
+static void				WriteCookedString(BytePacker& packer, const std::string& text);
+static bool				ReadCookedString(BytePacker& packer, std::string& out_text);
+
+template <typename T>
+static bool				ReadCookedValue(BytePacker& packer, T& out_value);
+
+void Command_CookModel(Command& cmd);
+void Command_CookObj(Command& cmd);
+void Command_CookXml(Command& cmd);
+
+
+//-----------------------------------------------------------------------------------------------
+// Registers the cooking commands
+//
+void AssetCooker::InitializeConsoleCommands()
+{
+	Command::Register("cook_model",		"Cooks a model Assimp can read into .cmesh/.cskel/.canim files. Params: f=source, o=output path without extension",	Command_CookModel);
+	Command::Register("cook_obj",		"Cooks an obj file into a .cmesh, one mesh per material. Params: f=source, o=output file",								Command_CookObj);
+	Command::Register("cook_xml",		"Cooks an xml data file into a .cxml. Params: f=source, o=output file, s=schema to check it against",						Command_CookXml);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Imports the model through Assimp and writes its geometry, skeleton and clips out cooked
+// Meshes are skinned only if the model has bones, matching AssimpLoader::ImportMesh()
+//
+bool AssetCooker::CookModel(const std::string& sourcePath, const std::string& outputBasePath)
+{
+	PROFILE_SCOPE_CATEGORY("AssetCooker::CookModel", "Assets");
+
+	AssimpLoader loader;
+	loader.OpenFile(sourcePath);
+
+	Skeleton* skeleton = loader.ImportSkeleton();
+	if (skeleton->GetBoneCount() == 0)
+	{
+		delete skeleton;
+		skeleton = nullptr;
+	}
+
+	std::vector<MeshBuilder*> builders;
+	loader.ImportMeshBuilders(builders, skeleton);
+
+	eCookedVertexType vertexType = (skeleton != nullptr ? COOKED_VERTEX_SKINNED : COOKED_VERTEX_LIT);
+	bool succeeded = CookedMeshFile::WriteToFile(outputBasePath + ".cmesh", builders, vertexType);
+
+	for (int builderIndex = 0; builderIndex < (int) builders.size(); ++builderIndex)
+	{
+		delete builders[builderIndex];
+	}
+
+	if (skeleton != nullptr)
+	{
+		succeeded = WriteSkeletonFile(outputBasePath + ".cskel", skeleton) && succeeded;
+
+		std::vector<AnimationClip*> clips = loader.ImportAnimation(skeleton);
+		if (clips.size() > 0)
+		{
+			succeeded = WriteAnimationFile(outputBasePath + ".canim", clips) && succeeded;
+		}
+
+		for (int clipIndex = 0; clipIndex < (int) clips.size(); ++clipIndex)
+		{
+			delete clips[clipIndex];
+		}
+
+		delete skeleton;
+	}
+
+	loader.CloseFile();
+
+	LogTaggedPrintf("ASSETS", "Cooked \"%s\" to \"%s\"%s", sourcePath.c_str(), outputBasePath.c_str(), (succeeded ? "" : " with errors"));
+	return succeeded;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Parses the obj file and writes a mesh per material, in the order AssetDB::CreateOrGetMeshGroup() gives them
+//
+bool AssetCooker::CookObj(const std::string& sourcePath, const std::string& outputPath)
+{
+	PROFILE_SCOPE_CATEGORY("AssetCooker::CookObj", "Assets");
+
+	MeshGroupBuilder mgb;
+	mgb.LoadFromObjFile(sourcePath);
+
+	if (mgb.GetMeshCount() == 0)
+	{
+		LogTaggedPrintf("ASSETS", "Error: AssetCooker::CookObj() found no meshes in \"%s\"", sourcePath.c_str());
+		return false;
+	}
+
+	bool succeeded = CookedMeshFile::WriteToFile(outputPath, mgb.GetMeshBuilders(), COOKED_VERTEX_LIT);
+
+	LogTaggedPrintf("ASSETS", "Cooked \"%s\" to \"%s\"%s", sourcePath.c_str(), outputPath.c_str(), (succeeded ? "" : " with errors"));
+	return succeeded;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Parses the source directly, not through LoadXmlDocument(), which would read an existing cooked file
+//
+bool AssetCooker::CookXml(const std::string& sourcePath, const std::string& outputPath, const std::string& schemaPath /*= ""*/)
+{
+	PROFILE_SCOPE_CATEGORY("AssetCooker::CookXml", "Assets");
+
+	File sourceFile;
+	if (!sourceFile.OpenMapped(sourcePath.c_str()))
+	{
+		LogTaggedPrintf("ASSETS", "Error: Couldn't open \"%s\" to cook", sourcePath.c_str());
+		return false;
+	}
+
+	XMLDocument document;
+	XMLError error = document.Parse(sourceFile.GetData(), sourceFile.GetSize());
+
+	if (error != tinyxml2::XML_SUCCESS)
+	{
+		LogTaggedPrintf("ASSETS", "Error: Couldn't parse \"%s\" to cook, line %i: %s", sourcePath.c_str(), document.GetErrorLineNum(), document.ErrorName());
+		return false;
+	}
+
+	if (schemaPath.size() > 0)
+	{
+		XmlSchema schema;
+		if (!schema.LoadFromFile(schemaPath) || !schema.Validate(document, sourcePath))
+		{
+			LogTaggedPrintf("ASSETS", "Error: \"%s\" doesn't match schema \"%s\", not cooked", sourcePath.c_str(), schemaPath.c_str());
+			return false;
+		}
+	}
+
+	bool succeeded = CookedXmlFile::WriteToFile(outputPath, document, sourceFile.GetData(), sourceFile.GetSize());
+
+	LogTaggedPrintf("ASSETS", "Cooked \"%s\" to \"%s\"%s", sourcePath.c_str(), outputPath.c_str(), (succeeded ? "" : " with errors"));
+	return succeeded;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes every bone's name, parent and matrices, in bone index order so parents stay before children
+//
+bool AssetCooker::WriteSkeletonFile(const std::string& filepath, const Skeleton* skeleton)
+{
+	BytePacker packer(COOKER_INITIAL_PACKER_SIZE, malloc(COOKER_INITIAL_PACKER_SIZE), true);
+
+	unsigned int boneCount = skeleton->GetBoneCount();
+	const std::vector<std::string>& boneNames = skeleton->GetAllBoneNames();
+
+	packer.Write<uint32_t>(COOKED_SKELETON_FOURCC);
+	packer.Write<uint32_t>(COOKED_SKELETON_VERSION);
+	packer.Write<uint32_t>(boneCount);
+
+	for (unsigned int boneIndex = 0; boneIndex < boneCount; ++boneIndex)
+	{
+		const BoneData_t& bone = skeleton->GetBoneData(boneIndex);
+
+		WriteCookedString(packer, boneNames[boneIndex]);
+		packer.Write<int32_t>(bone.parentIndex);
+		packer.Write(bone.localTransform);
+		packer.Write(bone.worldTransform);
+		packer.Write(bone.boneToMeshMatrix);
+		packer.Write(bone.meshToBoneMatrix);
+		packer.Write(bone.offsetMatrix);
+		packer.Write(bone.preRotation);
+	}
+
+	return WritePackerToFile(filepath, packer);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a new skeleton from the cooked file, or nullptr if it can't be read
+//
+Skeleton* AssetCooker::LoadSkeletonFile(const std::string& filepath)
+{
+	PROFILE_SCOPE_CATEGORY("AssetCooker::LoadSkeletonFile", "Assets");
+
+	BytePacker* packer = ReadFileToPacker(filepath);
+	if (packer == nullptr)
+	{
+		return nullptr;
+	}
+
+	uint32_t fourCC = 0;
+	uint32_t version = 0;
+	uint32_t boneCount = 0;
+
+	bool succeeded = ReadCookedValue(*packer, fourCC) && ReadCookedValue(*packer, version) && ReadCookedValue(*packer, boneCount);
+	succeeded = succeeded && (fourCC == COOKED_SKELETON_FOURCC) && (version == COOKED_SKELETON_VERSION);
+
+	Skeleton* skeleton = new Skeleton();
+
+	for (uint32_t boneIndex = 0; succeeded && boneIndex < boneCount; ++boneIndex)
+	{
+		std::string boneName;
+		int32_t parentIndex = -1;
+		BoneData_t bone;
+
+		succeeded = ReadCookedString(*packer, boneName) && ReadCookedValue(*packer, parentIndex)
+			&& ReadCookedValue(*packer, bone.localTransform) && ReadCookedValue(*packer, bone.worldTransform)
+			&& ReadCookedValue(*packer, bone.boneToMeshMatrix) && ReadCookedValue(*packer, bone.meshToBoneMatrix)
+			&& ReadCookedValue(*packer, bone.offsetMatrix) && ReadCookedValue(*packer, bone.preRotation);
+
+		// Names are unique in a skeleton, so a repeat would put the bone in the wrong slot
+		succeeded = succeeded && (parentIndex < (int32_t) boneIndex) && ((uint32_t) skeleton->CreateOrGetBoneMapping(boneName) == boneIndex);
+
+		if (succeeded)
+		{
+			skeleton->SetParentBoneIndex(boneIndex, parentIndex);
+			skeleton->SetLocalTransform(boneIndex, bone.localTransform);
+			skeleton->SetWorldTransform(boneIndex, bone.worldTransform);
+			skeleton->SetBoneToMeshMatrix(boneIndex, bone.boneToMeshMatrix);
+			skeleton->SetMeshToBoneMatrix(boneIndex, bone.meshToBoneMatrix);
+			skeleton->SetOffsetMatrix(boneIndex, bone.offsetMatrix);
+			skeleton->SetBonePreRotation(boneIndex, bone.preRotation);
+		}
+	}
+
+	delete packer;
+
+	if (!succeeded)
+	{
+		LogTaggedPrintf("ASSETS", "Error: \"%s\" isn't a cooked skeleton of version %i, or is truncated", filepath.c_str(), COOKED_SKELETON_VERSION);
+		delete skeleton;
+
+		return nullptr;
+	}
+
+	return skeleton;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes every clip's poses as sampled, so loads don't resample or concatenate anything
+//
+bool AssetCooker::WriteAnimationFile(const std::string& filepath, const std::vector<AnimationClip*>& clips)
+{
+	BytePacker packer(COOKER_INITIAL_PACKER_SIZE, malloc(COOKER_INITIAL_PACKER_SIZE), true);
+
+	packer.Write<uint32_t>(COOKED_ANIMATION_FOURCC);
+	packer.Write<uint32_t>(COOKED_ANIMATION_VERSION);
+	packer.Write<uint32_t>((uint32_t) clips.size());
+
+	for (int clipIndex = 0; clipIndex < (int) clips.size(); ++clipIndex)
+	{
+		AnimationClip* clip = clips[clipIndex];
+		uint32_t poseCount = (uint32_t) clip->GetPoseCount();
+		uint32_t boneCount = (poseCount > 0 ? clip->GetPoseAtIndex(0)->GetBoneCount() : 0);
+
+		WriteCookedString(packer, clip->GetName());
+		packer.Write<uint32_t>(poseCount);
+		packer.Write<uint32_t>(boneCount);
+		packer.Write<float>(1.f / clip->GetFrameDurationSeconds());
+
+		for (uint32_t poseIndex = 0; poseIndex < poseCount; ++poseIndex)
+		{
+			const Pose* pose = clip->GetPoseAtIndex(poseIndex);
+
+			for (uint32_t boneIndex = 0; boneIndex < boneCount; ++boneIndex)
+			{
+				packer.Write(pose->GetBoneTransform(boneIndex));
+			}
+		}
+	}
+
+	return WritePackerToFile(filepath, packer);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Appends the file's clips to out_clips, returning false if it can't be read or doesn't match the skeleton
+//
+bool AssetCooker::LoadAnimationFile(const std::string& filepath, const Skeleton* skeleton, std::vector<AnimationClip*>& out_clips)
+{
+	PROFILE_SCOPE_CATEGORY("AssetCooker::LoadAnimationFile", "Assets");
+
+	BytePacker* packer = ReadFileToPacker(filepath);
+	if (packer == nullptr)
+	{
+		return false;
+	}
+
+	uint32_t fourCC = 0;
+	uint32_t version = 0;
+	uint32_t clipCount = 0;
+
+	bool succeeded = ReadCookedValue(*packer, fourCC) && ReadCookedValue(*packer, version) && ReadCookedValue(*packer, clipCount);
+	succeeded = succeeded && (fourCC == COOKED_ANIMATION_FOURCC) && (version == COOKED_ANIMATION_VERSION);
+
+	std::vector<AnimationClip*> clips;
+
+	for (uint32_t clipIndex = 0; succeeded && clipIndex < clipCount; ++clipIndex)
+	{
+		std::string name;
+		uint32_t poseCount = 0;
+		uint32_t boneCount = 0;
+		float framesPerSecond = 0.f;
+
+		succeeded = ReadCookedString(*packer, name) && ReadCookedValue(*packer, poseCount) && ReadCookedValue(*packer, boneCount) && ReadCookedValue(*packer, framesPerSecond);
+		succeeded = succeeded && (boneCount == skeleton->GetBoneCount()) && (framesPerSecond > 0.f);
+
+		// Check the poses are all there before allocating for them
+		succeeded = succeeded && ((uint64_t) poseCount * boneCount * sizeof(Matrix44) <= packer->GetRemainingReadableByteCount());
+
+		if (!succeeded)
+		{
+			break;
+		}
+
+		AnimationClip* clip = new AnimationClip();
+		clip->Initialize(poseCount, skeleton, framesPerSecond);
+		clip->SetName(name);
+
+		for (uint32_t poseIndex = 0; poseIndex < poseCount; ++poseIndex)
+		{
+			Pose* pose = clip->GetPoseAtIndex(poseIndex);
+			pose->Initialize(skeleton);
+
+			for (uint32_t boneIndex = 0; boneIndex < boneCount; ++boneIndex)
+			{
+				Matrix44 transform;
+				ReadCookedValue(*packer, transform);
+				pose->SetBoneTransform(boneIndex, transform);
+			}
+
+			pose->DecomposeWorldMatrices();
+		}
+
+		clips.push_back(clip);
+	}
+
+	delete packer;
+
+	if (!succeeded)
+	{
+		LogTaggedPrintf("ASSETS", "Error: \"%s\" isn't a cooked animation of version %i for this skeleton, or is truncated", filepath.c_str(), COOKED_ANIMATION_VERSION);
+
+		for (int clipIndex = 0; clipIndex < (int) clips.size(); ++clipIndex)
+		{
+			delete clips[clipIndex];
+		}
+
+		return false;
+	}
+
+	out_clips.insert(out_clips.end(), clips.begin(), clips.end());
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the path with everything from the last '.' of the file name removed
+//
+static std::string RemoveExtension(const std::string& filepath)
+{
+	size_t dotIndex = filepath.find_last_of('.');
+	size_t slashIndex = filepath.find_last_of("/\\");
+
+	if (dotIndex == std::string::npos || (slashIndex != std::string::npos && dotIndex < slashIndex))
+	{
+		return filepath;
+	}
+
+	return filepath.substr(0, dotIndex);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Writes everything packed so far to the file, as binary
+//
+static bool WritePackerToFile(const std::string& filepath, const BytePacker& packer)
+{
+	File file;
+	if (!file.Open(filepath.c_str(), "wb"))
+	{
+		LogTaggedPrintf("ASSETS", "Error: AssetCooker couldn't open \"%s\" for writing", filepath.c_str());
+		return false;
+	}
+
+	file.Write((uint8_t*) packer.GetBuffer(), packer.GetWrittenByteCount());
+	return file.Close();
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Reads the whole file in one go into a packer that owns it, or returns nullptr if it can't be opened
+//
+static BytePacker* ReadFileToPacker(const std::string& filepath)
+{
+	size_t fileSize = 0;
+	void* buffer = FileReadBinaryToNewBuffer(filepath.c_str(), fileSize);
+
+	if (buffer == nullptr)
+	{
+		LogTaggedPrintf("ASSETS", "Error: AssetCooker couldn't open \"%s\"", filepath.c_str());
+		return nullptr;
+	}
+
+	// Counting the null after the data, so empty files still have a buffer
+	BytePacker* packer = new BytePacker(fileSize + 1, buffer, true);
+	packer->AdvanceWriteHead(fileSize);
+
+	return packer;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Writes the string as a 32-bit length followed by its characters
+//
+static void WriteCookedString(BytePacker& packer, const std::string& text)
+{
+	packer.Write<uint32_t>((uint32_t) text.size());
+	packer.WriteBytes(text.size(), text.c_str());
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Reads a string written by WriteCookedString(), returning false if the packer runs out first
+//
+static bool ReadCookedString(BytePacker& packer, std::string& out_text)
+{
+	uint32_t length = 0;
+	if (!ReadCookedValue(packer, length) || length > packer.GetRemainingReadableByteCount())
+	{
+		return false;
+	}
+
+	out_text.resize(length);
+	if (length > 0)
+	{
+		packer.ReadBytes(&out_text[0], length);
+	}
+
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Reads the value, returning false if the packer runs out first
+//
+template <typename T>
+static bool ReadCookedValue(BytePacker& packer, T& out_value)
+{
+	return (packer.Read(out_value) == sizeof(T));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Command for cooking a model through Assimp
+//
+void Command_CookModel(Command& cmd)
+{
+	std::string sourcePath;
+	if (!cmd.GetParam("f", sourcePath))
+	{
+		ConsoleErrorf("No model specified, use -f");
+		return;
+	}
+
+	std::string outputBasePath = RemoveExtension(sourcePath);
+	cmd.GetParam("o", outputBasePath, &outputBasePath);
+
+	if (AssetCooker::CookModel(sourcePath, outputBasePath))
+	{
+		AssetHotReloader::TrackCookSource(sourcePath, outputBasePath, false);
+		ConsolePrintf(Rgba::GREEN, "Cooked \"%s\" to \"%s\"", sourcePath.c_str(), outputBasePath.c_str());
+	}
+	else
+	{
+		ConsoleErrorf("Couldn't cook \"%s\", see the log", sourcePath.c_str());
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Command for cooking an obj file
+//
+void Command_CookObj(Command& cmd)
+{
+	std::string sourcePath;
+	if (!cmd.GetParam("f", sourcePath))
+	{
+		ConsoleErrorf("No obj file specified, use -f");
+		return;
+	}
+
+	std::string outputPath = RemoveExtension(sourcePath) + ".cmesh";
+	cmd.GetParam("o", outputPath, &outputPath);
+
+	if (AssetCooker::CookObj(sourcePath, outputPath))
+	{
+		AssetHotReloader::TrackCookSource(sourcePath, outputPath, true);
+		ConsolePrintf(Rgba::GREEN, "Cooked \"%s\" to \"%s\"", sourcePath.c_str(), outputPath.c_str());
+	}
+	else
+	{
+		ConsoleErrorf("Couldn't cook \"%s\", see the log", sourcePath.c_str());
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Command for cooking an xml data file
+//
+void Command_CookXml(Command& cmd)
+{
+	std::string sourcePath;
+	if (!cmd.GetParam("f", sourcePath))
+	{
+		ConsoleErrorf("No xml file specified, use -f");
+		return;
+	}
+
+	std::string outputPath = CookedXmlFile::GetCookedPath(sourcePath);
+	cmd.GetParam("o", outputPath, &outputPath);
+
+	std::string schemaPath;
+	cmd.GetParam("s", schemaPath, &schemaPath);
+
+	if (AssetCooker::CookXml(sourcePath, outputPath, schemaPath))
+	{
+		ConsolePrintf(Rgba::GREEN, "Cooked \"%s\" to \"%s\"", sourcePath.c_str(), outputPath.c_str());
+	}
+	else
+	{
+		ConsoleErrorf("Couldn't cook \"%s\", see the log", sourcePath.c_str());
+	}
+}
@@ -0,0 +1,54 @@
+/************************************************************************/
+/* File: AssetCooker.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Offline step that turns source models into the engine's
+/*				binary formats, so runtime loads skip Assimp and OBJ parsing
+/*				 .cmesh - meshes, read by CookedMeshFile
+/*				 .cskel - skeleton bones and bind pose
+/*				 .canim - animation clips, poses already in model space
+/*				 .cxml	- XML data files, read by CookedXmlFile
+/************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+
+class Skeleton;
+class AnimationClip;
+
+// "CSKL" and "CANM", read as little endian uint32s
+#define COOKED_SKELETON_FOURCC (0x4C4B5343)
+#define COOKED_ANIMATION_FOURCC (0x4D4E4143)
+
+#define COOKED_SKELETON_VERSION (1)
+#define COOKED_ANIMATION_VERSION (1)
+
+class AssetCooker
+{
+public:
+	//-----Public Methods-----
+
+	static void InitializeConsoleCommands();
+
+	// Writes outputBasePath + .cmesh, and .cskel and .canim if the model has bones and clips
+	static bool CookModel(const std::string& sourcePath, const std::string& outputBasePath);
+	static bool CookObj(const std::string& sourcePath, const std::string& outputPath);
+
+	// Checks the file against the schema first if one is given, failing the cook on any problem
+	// LoadXmlDocument() only picks up cooked files at CookedXmlFile::GetCookedPath() of their source
+	static bool CookXml(const std::string& sourcePath, const std::string& outputPath, const std::string& schemaPath = "");
+
+	static bool			WriteSkeletonFile(const std::string& filepath, const Skeleton* skeleton);
+	static Skeleton*	LoadSkeletonFile(const std::string& filepath);
+
+	// Clips are tied to the skeleton they're loaded with, which must have the bones they were cooked with
+	static bool			WriteAnimationFile(const std::string& filepath, const std::vector<AnimationClip*>& clips);
+	static bool			LoadAnimationFile(const std::string& filepath, const Skeleton* skeleton, std::vector<AnimationClip*>& out_clips);
+
+
+private:
+	//-----Private Methods-----
+
+	AssetCooker() {}
+
+};
@@ -7,9 +7,17 @@
 #include "Engine/Core/Image.hpp"
 #include "Engine/Assets/AssetDB.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/LogSystem.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Assets/AssetLoadJob.hpp"
+#include "Engine/Assets/AssetResidency.hpp"
+#include "Engine/Assets/CookedMeshFile.hpp"
+#include "Engine/Assets/AssetHotReloader.hpp"
 #include "Engine/Assets/AssetCollection.hpp"
+#include "Engine/Core/JobSystem/JobSystem.hpp"
+#include "Engine/Core/JobSystem/MainThreadScheduler.hpp"
 #include "Engine/Core/Time/ProfileScoped.hpp"
+#include "Engine/Core/Time/ProfileCounters.hpp"
 #include "Engine/Rendering/Shaders/Shader.hpp"
 #include "Engine/Rendering/Resources/Skybox.hpp"
 #include "Engine/Rendering/Resources/Texture.hpp"
@@ -24,264 +32,348 @@
 #include "Engine/Rendering/Meshes/MeshGroupBuilder.hpp"
 #include "Engine/Rendering/Materials/MaterialInstance.hpp"
 
+std::map<const void*, AssetLoadJob*> AssetDB::s_pendingLoads;
+
+std::map<std::string, BuiltInAsset_t> AssetDB::s_builtInAssets[NUM_BUILT_IN_ASSET_TYPES];
+std::thread::id AssetDB::s_builtInThreadID;
+int AssetDB::s_builtInsPrecompiledPerFrame = 0;
+
+// C Functions
+static Mesh* CreatePlaceholderMesh();
+static Mesh* CreateWireCubeMesh();
+static Mesh* CreatePointMesh();
+static Mesh* CreateSphereMesh();
+static Mesh* CreateBoneMesh();
+
 //-----------------------------------------------------------------------------------------------
-// Constructs all the built-in assets for the Engine, called at start up
+// Registers all the built-in assets for the Engine, called at start up
+// Nothing is made here - each built-in is made the first time it's gotten by name
 //
 void AssetDB::CreateBuiltInAssets()
 {
+	s_builtInThreadID = std::this_thread::get_id();
+
+	if (IsEngineHeadless())
+	{
+		return;
+	}
+
 	//--------------------Textures--------------------
-	CreateTextures();
+	RegisterBuiltInTextures();
 
 	//--------------------Shaders--------------------
-	CreateShaders();
+	RegisterBuiltInShaders();
 
 	//-------------------Materials-------------------
-	CreateMaterials();
+	RegisterBuiltInMaterials();
 
 	//---------------------Meshes--------------------
-	CreateMeshes();
+	RegisterBuiltInMeshes();
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Creates all built-in textures for the engine, and stores them in the AssetDB
+// Creates all built-in textures for the engine now, instead of when they're first used
 //
 void AssetDB::CreateTextures()
 {
-	Texture* whiteTexture = new Texture();
-	whiteTexture->CreateFromImage(&Image::IMAGE_WHITE);
-	AssetCollection<Texture>::AddAsset("White", whiteTexture);
+	CreateAllBuiltInsOfType(BUILT_IN_TEXTURE);
+}
 
-	Texture* whiteTextureTint = new Texture();
-	whiteTextureTint->CreateFromImage(&Image::IMAGE_WHITE_TINT);
-	AssetCollection<Texture>::AddAsset("White_Tint", whiteTextureTint);
 
-	Texture* flatTexture = new Texture();
-	flatTexture->CreateFromImage(&Image::IMAGE_FLAT);
-	AssetCollection<Texture>::AddAsset("Flat", flatTexture);
+//-----------------------------------------------------------------------------------------------
+// Creates all built-in shaders for the engine now, instead of when they're first used
+// Their compiles are all issued before any is checked, so the driver can work on them together
+//
+void AssetDB::CreateShaders()
+{
+	ShaderProgram::BeginParallelCompile();
+	CreateAllBuiltInsOfType(BUILT_IN_SHADER);
+	ShaderProgram::EndParallelCompile();
+}
 
-	Texture* blackTexture = new Texture();
-	blackTexture->CreateFromImage(&Image::IMAGE_BLACK);
-	AssetCollection<Texture>::AddAsset("Black", blackTexture);
 
-	Texture* defaultTexture = new Texture();
-	defaultTexture->CreateFromImage(&Image::IMAGE_DEFAULT_TEXTURE);
-	AssetCollection<Texture>::AddAsset("Default", defaultTexture);
+//-----------------------------------------------------------------------------------------------
+// Creates all built-in materials for the engine now, instead of when they're first used
+//
+void AssetDB::CreateMaterials()
+{
+	CreateAllBuiltInsOfType(BUILT_IN_MATERIAL);
+}
 
-	Texture* gradientTexture = new Texture();
-	gradientTexture->CreateFromFile("Data/Images/Debug/Gradient.png");
-	AssetCollection<Texture>::AddAsset("Gradient", gradientTexture);
+
+//-----------------------------------------------------------------------------------------------
+// Creates all built-in meshes for the engine now, instead of when they're first used
+//
+void AssetDB::CreateMeshes()
+{
+	CreateAllBuiltInsOfType(BUILT_IN_MESH);
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Creates all built-in shaders for the engine, and stores them in the AssetDB
+// Has FinalizeAsyncLoads() make the built-ins nobody's used yet, a few each frame
 //
-void AssetDB::CreateShaders()
+void AssetDB::PrecompileBuiltInAssets(int assetsPerFrame /*= BUILT_IN_PRECOMPILE_PER_FRAME*/)
 {
-	ShaderProgram* invalidProgram = new ShaderProgram(ShaderSource::INVALID_SHADER_NAME);
-	bool loadSuccessful = invalidProgram->LoadProgramFromSources(ShaderSource::INVALID_VS, ShaderSource::INVALID_FS, true);
-	ASSERT_OR_DIE(loadSuccessful, "Error: Renderer::CreateBuildInShaders() could not build the Invalid Shader.");
-
-	// Get the invalid shader in first
-	Shader* invalidShader = new Shader(ShaderSource::INVALID_RENDER_STATE, invalidProgram);
-	AssetCollection<Shader>::AddAsset(ShaderSource::INVALID_SHADER_NAME, invalidShader);
-
-	// Then construct all others, since if they fail to compile we assign them the invalid shader data
-	Shader* defaultOpaque	= Shader::BuildShader(ShaderSource::DEFAULT_OPAQUE_NAME,	ShaderSource::DEFAULT_OPAQUE_VS,	ShaderSource::DEFAULT_OPAQUE_FS,	ShaderSource::DEFAULT_OPAQUE_STATE,		ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE);
-	Shader* defaultAlpha	= Shader::BuildShader(ShaderSource::DEFAULT_ALPHA_NAME,		ShaderSource::DEFAULT_ALPHA_VS,		ShaderSource::DEFAULT_ALPHA_FS,		ShaderSource::DEFAULT_ALPHA_STATE,		ShaderSource::DEFAULT_ALPHA_LAYER,	ShaderSource::DEFAULT_ALPHA_QUEUE);
-	Shader* uiShader		= Shader::BuildShader(ShaderSource::UI_SHADER_NAME,			ShaderSource::UI_SHADER_VS,			ShaderSource::UI_SHADER_FS,			ShaderSource::UI_SHADER_STATE,			ShaderSource::DEFAULT_ALPHA_LAYER,	ShaderSource::DEFAULT_ALPHA_QUEUE);
-	Shader* debugShader		= Shader::BuildShader(ShaderSource::DEBUG_RENDER_NAME,		ShaderSource::DEBUG_RENDER_VS,		ShaderSource::DEBUG_RENDER_FS,		ShaderSource::DEBUG_RENDER_STATE,		ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE);
-	Shader* xrayShader		= Shader::BuildShader(ShaderSource::XRAY_SHADER_NAME,		ShaderSource::XRAY_SHADER_VS,		ShaderSource::XRAY_SHADER_FS,		ShaderSource::XRAY_SHADER_STATE,		ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE);
-	Shader* phongOpaque		= Shader::BuildShader(ShaderSource::PHONG_OPAQUE_NAME,		ShaderSource::PHONG_OPAQUE_VS,		ShaderSource::PHONG_OPAQUE_FS,		ShaderSource::PHONG_OPAQUE_STATE,		ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE);
-	Shader* phongAlpha		= Shader::BuildShader(ShaderSource::PHONG_ALPHA_NAME,		ShaderSource::PHONG_ALPHA_VS,		ShaderSource::PHONG_ALPHA_FS,		ShaderSource::PHONG_ALPHA_STATE,		ShaderSource::DEFAULT_ALPHA_LAYER,	ShaderSource::DEFAULT_ALPHA_QUEUE);
-	Shader* vertexNormal	= Shader::BuildShader(ShaderSource::VERTEX_NORMAL_NAME,		ShaderSource::VERTEX_NORMAL_VS,		ShaderSource::VERTEX_NORMAL_FS,		ShaderSource::VERTEX_NORMAL_STATE,		ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE);
-	Shader* vertexTangent	= Shader::BuildShader(ShaderSource::VERTEX_TANGENT_NAME,	ShaderSource::VERTEX_TANGENT_VS,	ShaderSource::VERTEX_TANGENT_FS,	ShaderSource::VERTEX_TANGENT_STATE,		ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE);
-	Shader* vertexBitangent	= Shader::BuildShader(ShaderSource::VERTEX_BITANGENT_NAME,	ShaderSource::VERTEX_BITANGENT_VS,	ShaderSource::VERTEX_BITANGENT_FS,	ShaderSource::VERTEX_BITANGENT_STATE,	ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE);
-	Shader* surfaceNormal	= Shader::BuildShader(ShaderSource::SURFACE_NORMAL_NAME,	ShaderSource::SURFACE_NORMAL_VS,	ShaderSource::SURFACE_NORMAL_FS,	ShaderSource::SURFACE_NORMAL_STATE,		ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE);
-	Shader* worldNormal		= Shader::BuildShader(ShaderSource::WORLD_NORMAL_NAME,		ShaderSource::WORLD_NORMAL_VS,		ShaderSource::WORLD_NORMAL_FS,		ShaderSource::WORLD_NORMAL_STATE,		ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE);
-	Shader* diffuse			= Shader::BuildShader(ShaderSource::DIFFUSE_NAME,			ShaderSource::DIFFUSE_VS,			ShaderSource::DIFFUSE_FS,			ShaderSource::DIFFUSE_STATE,			ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE);
-	Shader* specular		= Shader::BuildShader(ShaderSource::SPECULAR_NAME,			ShaderSource::SPECULAR_VS,			ShaderSource::SPECULAR_FS,			ShaderSource::SPECULAR_STATE,			ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE);
-	Shader* lighting		= Shader::BuildShader(ShaderSource::LIGHTING_NAME,			ShaderSource::LIGHTING_VS,			ShaderSource::LIGHTING_FS,			ShaderSource::LIGHTING_STATE,			ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE);
-	Shader* uv				= Shader::BuildShader(ShaderSource::UV_NAME,				ShaderSource::UV_VS,				ShaderSource::UV_FS,				ShaderSource::UV_STATE,					ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE);
-	Shader* skybox			= Shader::BuildShader(ShaderSource::SKYBOX_SHADER_NAME,		ShaderSource::SKYBOX_SHADER_VS,		ShaderSource::SKYBOX_SHADER_FS,		ShaderSource::SKYBOX_SHADER_STATE,		ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE);
-
-	Shader* opaqueInstanced			= Shader::BuildShader(ShaderSource::DEFAULT_OPAQUE_INSTANCED_NAME,	ShaderSource::DEFAULT_OPAQUE_INSTANCED_VS,	ShaderSource::DEFAULT_OPAQUE_INSTANCED_FS,	ShaderSource::DEFAULT_OPAQUE_INSTANCED_STATE,		ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE);
-	Shader* alphaInstanced			= Shader::BuildShader(ShaderSource::DEFAULT_ALPHA_INSTANCED_NAME,	ShaderSource::DEFAULT_ALPHA_INSTANCED_VS,	ShaderSource::DEFAULT_ALPHA_INSTANCED_FS,	ShaderSource::DEFAULT_ALPHA_INSTANCED_STATE,		ShaderSource::DEFAULT_ALPHA_LAYER,	ShaderSource::DEFAULT_ALPHA_QUEUE);
-	Shader* phongOpaqueInstanced	= Shader::BuildShader(ShaderSource::PHONG_OPAQUE_INSTANCED_NAME,	ShaderSource::PHONG_OPAQUE_INSTANCED_VS,	ShaderSource::PHONG_OPAQUE_INSTANCED_FS,	ShaderSource::PHONG_OPAQUE_INSTANCED_STATE,			ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE);
-	Shader* phongAlphaInstanced		= Shader::BuildShader(ShaderSource::PHONG_ALPHA_INSTANCED_NAME,		ShaderSource::PHONG_ALPHA_INSTANCED_VS,		ShaderSource::PHONG_ALPHA_INSTANCED_FS,		ShaderSource::PHONG_ALPHA_INSTANCED_STATE,			ShaderSource::DEFAULT_ALPHA_LAYER,	ShaderSource::DEFAULT_ALPHA_QUEUE);
-
-	// Add the shaders in!
-	AssetCollection<Shader>::AddAsset(ShaderSource::DEFAULT_OPAQUE_NAME,	defaultOpaque);
-	AssetCollection<Shader>::AddAsset(ShaderSource::DEFAULT_ALPHA_NAME,		defaultAlpha);
-	AssetCollection<Shader>::AddAsset(ShaderSource::UI_SHADER_NAME,			uiShader);
-	AssetCollection<Shader>::AddAsset(ShaderSource::DEBUG_RENDER_NAME,		debugShader);
-	AssetCollection<Shader>::AddAsset(ShaderSource::XRAY_SHADER_NAME,		xrayShader);
-	AssetCollection<Shader>::AddAsset(ShaderSource::PHONG_OPAQUE_NAME,		phongOpaque);
-	AssetCollection<Shader>::AddAsset(ShaderSource::PHONG_ALPHA_NAME,		phongAlpha);
-	AssetCollection<Shader>::AddAsset(ShaderSource::VERTEX_NORMAL_NAME,		vertexNormal);
-	AssetCollection<Shader>::AddAsset(ShaderSource::VERTEX_TANGENT_NAME,	vertexTangent);
-	AssetCollection<Shader>::AddAsset(ShaderSource::VERTEX_BITANGENT_NAME,	vertexBitangent);
-	AssetCollection<Shader>::AddAsset(ShaderSource::SURFACE_NORMAL_NAME,	surfaceNormal);
-	AssetCollection<Shader>::AddAsset(ShaderSource::WORLD_NORMAL_NAME,		worldNormal);
-	AssetCollection<Shader>::AddAsset(ShaderSource::DIFFUSE_NAME,			diffuse);
-	AssetCollection<Shader>::AddAsset(ShaderSource::SPECULAR_NAME,			specular);
-	AssetCollection<Shader>::AddAsset(ShaderSource::LIGHTING_NAME,			lighting);
-	AssetCollection<Shader>::AddAsset(ShaderSource::UV_NAME,				uv);
-	AssetCollection<Shader>::AddAsset(ShaderSource::SKYBOX_SHADER_NAME,		skybox);
-
-	AssetCollection<Shader>::AddAsset(ShaderSource::DEFAULT_OPAQUE_INSTANCED_NAME,	opaqueInstanced);
-	AssetCollection<Shader>::AddAsset(ShaderSource::DEFAULT_ALPHA_INSTANCED_NAME,	alphaInstanced);
-	AssetCollection<Shader>::AddAsset(ShaderSource::PHONG_OPAQUE_INSTANCED_NAME,	phongOpaqueInstanced);
-	AssetCollection<Shader>::AddAsset(ShaderSource::PHONG_ALPHA_INSTANCED_NAME,		phongAlphaInstanced);
-}
-
-
-//-----------------------------------------------------------------------------------------------
-// Creates all built-in materials for the engine, and stores them in the AssetDB
+	s_builtInsPrecompiledPerFrame = MaxInt(assetsPerFrame, 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Registers all built-in textures for the engine
 //
-void AssetDB::CreateMaterials()
+void AssetDB::RegisterBuiltInTextures()
 {
-	Material* debugMaterial = new Material("Debug_Render");
-	debugMaterial->SetDiffuse(AssetDB::GetTexture("White"));
-	debugMaterial->SetShader(AssetDB::GetShader(ShaderSource::DEBUG_RENDER_NAME));
+	RegisterBuiltIn(BUILT_IN_TEXTURE, "White",		[]() { AddBuiltInTexture("White",		&Image::IMAGE_WHITE); });
+	RegisterBuiltIn(BUILT_IN_TEXTURE, "White_Tint",	[]() { AddBuiltInTexture("White_Tint",	&Image::IMAGE_WHITE_TINT); });
+	RegisterBuiltIn(BUILT_IN_TEXTURE, "Flat",		[]() { AddBuiltInTexture("Flat",		&Image::IMAGE_FLAT); });
+	RegisterBuiltIn(BUILT_IN_TEXTURE, "Black",		[]() { AddBuiltInTexture("Black",		&Image::IMAGE_BLACK); });
+	RegisterBuiltIn(BUILT_IN_TEXTURE, "Default",	[]() { AddBuiltInTexture("Default",		&Image::IMAGE_DEFAULT_TEXTURE); });
 
-	AssetCollection<Material>::AddAsset("Debug_Render", debugMaterial);
+	RegisterBuiltIn(BUILT_IN_TEXTURE, "Gradient", []()
+	{
+		Texture* gradientTexture = new Texture();
+		gradientTexture->CreateFromFile("Data/Images/Debug/Gradient.png");
+		AssetCollection<Texture>::AddAsset("Gradient", gradientTexture);
+	});
+}
 
-	Material* xrayMaterial = new Material("X_Ray");
-	xrayMaterial->SetDiffuse(AssetDB::GetTexture("White"));
-	xrayMaterial->SetShader(AssetDB::GetShader(ShaderSource::XRAY_SHADER_NAME));
 
-	AssetCollection<Material>::AddAsset("X_Ray", xrayMaterial);
+//-----------------------------------------------------------------------------------------------
+// Registers all built-in shaders for the engine
+//
+void AssetDB::RegisterBuiltInShaders()
+{
+	RegisterBuiltIn(BUILT_IN_SHADER, ShaderSource::INVALID_SHADER_NAME, []()
+	{
+		ShaderProgram* invalidProgram = new ShaderProgram(ShaderSource::INVALID_SHADER_NAME);
+		bool loadSuccessful = invalidProgram->LoadProgramFromSources(ShaderSource::INVALID_VS, ShaderSource::INVALID_FS, true);
+		ASSERT_OR_DIE(loadSuccessful, "Error: AssetDB::RegisterBuiltInShaders() could not build the Invalid Shader.");
 
-	Material* defaultOpaque = new Material("Default_Opaque");
-	defaultOpaque->SetDiffuse(AssetDB::GetTexture("White"));
-	defaultOpaque->SetShader(AssetDB::GetShader(ShaderSource::DEFAULT_OPAQUE_NAME));
+		Shader* invalidShader = new Shader(ShaderSource::INVALID_RENDER_STATE, invalidProgram);
+		AssetCollection<Shader>::AddAsset(ShaderSource::INVALID_SHADER_NAME, invalidShader);
+	});
 
-	AssetCollection<Material>::AddAsset("Default_Opaque", defaultOpaque);
+	// If any of these fail to compile they're assigned the invalid shader data
+	struct BuiltInShaderSource_t
+	{
+		const char* name;
+		const char* vsSource;
+		const char* fsSource;
+		const RenderState* state;
+		unsigned int layer;
+		SortingQueue queue;
+		ShaderKeywords keywords;	// The variant of the sources to compile, none if left off
+		bool isDeferrable;			// Writes its surface to the G-buffer for deferred cameras, false if left off
+	};
+
+	const BuiltInShaderSource_t shaderSources[] =
+	{
+		{ ShaderSource::DEFAULT_OPAQUE_NAME,			ShaderSource::DEFAULT_OPAQUE_VS,			ShaderSource::DEFAULT_OPAQUE_FS,			&ShaderSource::DEFAULT_OPAQUE_STATE,			ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE },
+		{ ShaderSource::DEFAULT_ALPHA_NAME,				ShaderSource::DEFAULT_ALPHA_VS,				ShaderSource::DEFAULT_ALPHA_FS,				&ShaderSource::DEFAULT_ALPHA_STATE,				ShaderSource::DEFAULT_ALPHA_LAYER,	ShaderSource::DEFAULT_ALPHA_QUEUE },
+		{ ShaderSource::UI_SHADER_NAME,					ShaderSource::UI_SHADER_VS,					ShaderSource::UI_SHADER_FS,					&ShaderSource::UI_SHADER_STATE,					ShaderSource::DEFAULT_ALPHA_LAYER,	ShaderSource::DEFAULT_ALPHA_QUEUE },
+		{ ShaderSource::UI_SDF_SHADER_NAME,				ShaderSource::UI_SHADER_VS,					ShaderSource::UI_SDF_SHADER_FS,				&ShaderSource::UI_SHADER_STATE,					ShaderSource::DEFAULT_ALPHA_LAYER,	ShaderSource::DEFAULT_ALPHA_QUEUE },
+		{ ShaderSource::DEBUG_RENDER_NAME,				ShaderSource::DEBUG_RENDER_VS,				ShaderSource::DEBUG_RENDER_FS,				&ShaderSource::DEBUG_RENDER_STATE,				ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE },
+		{ ShaderSource::XRAY_SHADER_NAME,				ShaderSource::XRAY_SHADER_VS,				ShaderSource::XRAY_SHADER_FS,				&ShaderSource::XRAY_SHADER_STATE,				ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE },
+		{ ShaderSource::PHONG_OPAQUE_NAME,				ShaderSource::PHONG_OPAQUE_VS,				ShaderSource::PHONG_OPAQUE_FS,				&ShaderSource::PHONG_OPAQUE_STATE,				ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE, SHADER_KEYWORDS_NONE, true },
+		{ ShaderSource::PHONG_ALPHA_NAME,				ShaderSource::PHONG_ALPHA_VS,				ShaderSource::PHONG_ALPHA_FS,				&ShaderSource::PHONG_ALPHA_STATE,				ShaderSource::DEFAULT_ALPHA_LAYER,	ShaderSource::DEFAULT_ALPHA_QUEUE },
+		{ ShaderSource::VERTEX_NORMAL_NAME,				ShaderSource::VERTEX_NORMAL_VS,				ShaderSource::VERTEX_NORMAL_FS,				&ShaderSource::VERTEX_NORMAL_STATE,				ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE },
+		{ ShaderSource::VERTEX_TANGENT_NAME,			ShaderSource::VERTEX_TANGENT_VS,			ShaderSource::VERTEX_TANGENT_FS,			&ShaderSource::VERTEX_TANGENT_STATE,			ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE },
+		{ ShaderSource::VERTEX_BITANGENT_NAME,			ShaderSource::VERTEX_BITANGENT_VS,			ShaderSource::VERTEX_BITANGENT_FS,			&ShaderSource::VERTEX_BITANGENT_STATE,			ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE },
+		{ ShaderSource::SURFACE_NORMAL_NAME,			ShaderSource::SURFACE_NORMAL_VS,			ShaderSource::SURFACE_NORMAL_FS,			&ShaderSource::SURFACE_NORMAL_STATE,			ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE },
+		{ ShaderSource::WORLD_NORMAL_NAME,				ShaderSource::WORLD_NORMAL_VS,				ShaderSource::WORLD_NORMAL_FS,				&ShaderSource::WORLD_NORMAL_STATE,				ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE },
+		{ ShaderSource::DIFFUSE_NAME,					ShaderSource::DIFFUSE_VS,					ShaderSource::DIFFUSE_FS,					&ShaderSource::DIFFUSE_STATE,					ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE },
+		{ ShaderSource::SPECULAR_NAME,					ShaderSource::SPECULAR_VS,					ShaderSource::SPECULAR_FS,					&ShaderSource::SPECULAR_STATE,					ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE },
+		{ ShaderSource::LIGHTING_NAME,					ShaderSource::LIGHTING_VS,					ShaderSource::LIGHTING_FS,					&ShaderSource::LIGHTING_STATE,					ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE },
+		{ ShaderSource::UV_NAME,						ShaderSource::UV_VS,						ShaderSource::UV_FS,						&ShaderSource::UV_STATE,						ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE },
+		{ ShaderSource::SKYBOX_SHADER_NAME,				ShaderSource::SKYBOX_SHADER_VS,				ShaderSource::SKYBOX_SHADER_FS,				&ShaderSource::SKYBOX_SHADER_STATE,				ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE },
+		{ ShaderSource::DEPTH_ONLY_NAME,				ShaderSource::DEPTH_ONLY_VS,				ShaderSource::DEPTH_ONLY_FS,				&ShaderSource::DEPTH_ONLY_STATE,				ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE },
+		{ ShaderSource::DEFERRED_GBUFFER_NAME,			ShaderSource::DEFERRED_GBUFFER_VS,			ShaderSource::DEFERRED_GBUFFER_FS,			&ShaderSource::DEFERRED_GBUFFER_STATE,			ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE },
+		{ ShaderSource::DEFERRED_LIGHTING_NAME,			ShaderSource::DEFERRED_LIGHTING_VS,			ShaderSource::DEFERRED_LIGHTING_FS,			&ShaderSource::DEFERRED_LIGHTING_STATE,			ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE },
+
+		{ ShaderSource::DEFAULT_OPAQUE_INSTANCED_NAME,	ShaderSource::DEFAULT_OPAQUE_INSTANCED_VS,	ShaderSource::DEFAULT_OPAQUE_INSTANCED_FS,	&ShaderSource::DEFAULT_OPAQUE_INSTANCED_STATE,	ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE, SHADER_KEYWORD_INSTANCED },
+		{ ShaderSource::DEFAULT_ALPHA_INSTANCED_NAME,	ShaderSource::DEFAULT_ALPHA_INSTANCED_VS,	ShaderSource::DEFAULT_ALPHA_INSTANCED_FS,	&ShaderSource::DEFAULT_ALPHA_INSTANCED_STATE,	ShaderSource::DEFAULT_ALPHA_LAYER,	ShaderSource::DEFAULT_ALPHA_QUEUE, SHADER_KEYWORD_INSTANCED },
+		{ ShaderSource::PHONG_OPAQUE_INSTANCED_NAME,	ShaderSource::PHONG_OPAQUE_INSTANCED_VS,	ShaderSource::PHONG_OPAQUE_INSTANCED_FS,	&ShaderSource::PHONG_OPAQUE_INSTANCED_STATE,	ShaderSource::DEFAULT_OPAQUE_LAYER, ShaderSource::DEFAULT_OPAQUE_QUEUE, SHADER_KEYWORD_INSTANCED, true },
+		{ ShaderSource::PHONG_ALPHA_INSTANCED_NAME,		ShaderSource::PHONG_ALPHA_INSTANCED_VS,		ShaderSource::PHONG_ALPHA_INSTANCED_FS,		&ShaderSource::PHONG_ALPHA_INSTANCED_STATE,		ShaderSource::DEFAULT_ALPHA_LAYER,	ShaderSource::DEFAULT_ALPHA_QUEUE, SHADER_KEYWORD_INSTANCED },
+		{ ShaderSource::GPU_PARTICLE_NAME,				ShaderSource::GPU_PARTICLE_VS,				ShaderSource::GPU_PARTICLE_FS,				&ShaderSource::GPU_PARTICLE_STATE,				ShaderSource::DEFAULT_ALPHA_LAYER,	ShaderSource::DEFAULT_ALPHA_QUEUE }
+	};
+
+	for (const BuiltInShaderSource_t& source : shaderSources)
+	{
+		RegisterBuiltIn(BUILT_IN_SHADER, source.name, [source]()
+		{
+			AddBuiltInShader(source.name, source.vsSource, source.fsSource, source.state, source.layer, (int) source.queue, source.keywords, source.isDeferrable);
+		});
+	}
+}
 
-	Material* defaultAlpha = new Material("Default_Alpha");
-	defaultAlpha->SetDiffuse(AssetDB::GetTexture("White_Tint"));
-	defaultAlpha->SetShader(AssetDB::GetShader(ShaderSource::DEFAULT_ALPHA_NAME));
 
-	AssetCollection<Material>::AddAsset("Default_Alpha", defaultAlpha);
+//-----------------------------------------------------------------------------------------------
+// Registers all built-in materials for the engine; their textures and shaders are made along with them
+//
+void AssetDB::RegisterBuiltInMaterials()
+{
+	RegisterBuiltIn(BUILT_IN_MATERIAL, "Debug_Render",		[]() { AddBuiltInMaterial("Debug_Render",	GetTexture("White"),		ShaderSource::DEBUG_RENDER_NAME); });
+	RegisterBuiltIn(BUILT_IN_MATERIAL, "X_Ray",				[]() { AddBuiltInMaterial("X_Ray",			GetTexture("White"),		ShaderSource::XRAY_SHADER_NAME); });
+	RegisterBuiltIn(BUILT_IN_MATERIAL, "Depth_Only",		[]() { AddBuiltInMaterial("Depth_Only",		nullptr,					ShaderSource::DEPTH_ONLY_NAME); });
+	RegisterBuiltIn(BUILT_IN_MATERIAL, "Deferred_GBuffer",	[]() { AddBuiltInMaterial("Deferred_GBuffer", nullptr,				ShaderSource::DEFERRED_GBUFFER_NAME); });
+	RegisterBuiltIn(BUILT_IN_MATERIAL, "Deferred_Lighting",	[]() { AddBuiltInMaterial("Deferred_Lighting", nullptr,				ShaderSource::DEFERRED_LIGHTING_NAME); });
+	RegisterBuiltIn(BUILT_IN_MATERIAL, "Default_Opaque",	[]() { AddBuiltInMaterial("Default_Opaque",	GetTexture("White"),		ShaderSource::DEFAULT_OPAQUE_NAME); });
+	RegisterBuiltIn(BUILT_IN_MATERIAL, "Default_Alpha",		[]() { AddBuiltInMaterial("Default_Alpha",	GetTexture("White_Tint"),	ShaderSource::DEFAULT_ALPHA_NAME); });
+	RegisterBuiltIn(BUILT_IN_MATERIAL, "GPU_Particle",		[]() { AddBuiltInMaterial("GPU_Particle",	GetTexture("White"),		ShaderSource::GPU_PARTICLE_NAME); });
+	RegisterBuiltIn(BUILT_IN_MATERIAL, "Phong_Opaque",		[]() { AddBuiltInMaterial("Phong_Opaque",	GetTexture("Default"),		ShaderSource::PHONG_OPAQUE_NAME); });
+	RegisterBuiltIn(BUILT_IN_MATERIAL, "UI",				[]() { AddBuiltInMaterial("UI",				GetTexture("White"),		ShaderSource::UI_SHADER_NAME); });
+	RegisterBuiltIn(BUILT_IN_MATERIAL, "FLChan",			[]() { AddBuiltInMaterial("FLChan",			CreateOrGetTexture("Data/Images/DevConsole/FLChan.png"), ShaderSource::UI_SHADER_NAME); });
+	RegisterBuiltIn(BUILT_IN_MATERIAL, "Skybox",			[]() { AddBuiltInMaterial("Skybox",			GetTexture("White"),		ShaderSource::SKYBOX_SHADER_NAME); });
+	RegisterBuiltIn(BUILT_IN_MATERIAL, "Gradient",			[]() { AddBuiltInMaterial("Gradient",		GetTexture("Gradient"),		ShaderSource::UI_SHADER_NAME); });
+}
 
-	Material* phongMaterial = new Material("Phong_Opaque");
-	phongMaterial->SetDiffuse(GetTexture("Default"));
-	phongMaterial->SetShader(GetShader(ShaderSource::PHONG_OPAQUE_NAME));
 
-	AssetCollection<Material>::AddAsset("Phong_Opaque", phongMaterial);
+//-----------------------------------------------------------------------------------------------
+// Registers all built-in meshes for the engine
+//
+void AssetDB::RegisterBuiltInMeshes()
+{
+	RegisterBuiltIn(BUILT_IN_MESH, "Cube",		[]() { AssetCollection<Mesh>::AddAsset("Cube",		CreatePlaceholderMesh()); });
+	RegisterBuiltIn(BUILT_IN_MESH, "Wire_Cube",	[]() { AssetCollection<Mesh>::AddAsset("Wire_Cube",	CreateWireCubeMesh()); });
+	RegisterBuiltIn(BUILT_IN_MESH, "Point",		[]() { AssetCollection<Mesh>::AddAsset("Point",		CreatePointMesh()); });
+	RegisterBuiltIn(BUILT_IN_MESH, "Sphere",	[]() { AssetCollection<Mesh>::AddAsset("Sphere",	CreateSphereMesh()); });
+	RegisterBuiltIn(BUILT_IN_MESH, "Bone",		[]() { AssetCollection<Mesh>::AddAsset("Bone",		CreateBoneMesh()); });
+}
 
-	Material* uiMat = new Material("UI");
-	uiMat->SetDiffuse(AssetDB::GetTexture("White"));
-	uiMat->SetShader(AssetDB::GetShader(ShaderSource::UI_SHADER_NAME));
 
-	AssetCollection<Material>::AddAsset("UI", uiMat);
+//-----------------------------------------------------------------------------------------------
+// Adds the built-in to be made the first time it's gotten
+//
+void AssetDB::RegisterBuiltIn(eBuiltInAssetType type, const std::string& name, const std::function<void()>& createFunction)
+{
+	BuiltInAsset_t& builtIn = s_builtInAssets[type][name];
+	builtIn.createFunction = createFunction;
+	builtIn.isCreated = false;
+}
 
-	Material* flChanMat = new Material("FLChan");
-	flChanMat->SetDiffuse(CreateOrGetTexture("Data/Images/DevConsole/FLChan.png"));
-	flChanMat->SetShader(AssetDB::GetShader(ShaderSource::UI_SHADER_NAME));
 
-	AssetCollection<Material>::AddAsset("FLChan", flChanMat);
+//-----------------------------------------------------------------------------------------------
+// Makes the built-in of the given name, returning false if there isn't one or it was already made
+//
+bool AssetDB::CreateBuiltIn(eBuiltInAssetType type, const std::string& name)
+{
+	std::map<std::string, BuiltInAsset_t>::iterator itr = s_builtInAssets[type].find(name);
 
-	Material* skyboxMat = new Material("Skybox");
-	skyboxMat->SetDiffuse(AssetDB::GetTexture("White"));
-	skyboxMat->SetShader(AssetDB::GetShader(ShaderSource::SKYBOX_SHADER_NAME));
+	if (itr == s_builtInAssets[type].end() || itr->second.isCreated)
+	{
+		return false;
+	}
 
-	AssetCollection<Material>::AddAsset("Skybox", skyboxMat);
+	ASSERT_OR_DIE(std::this_thread::get_id() == s_builtInThreadID, Stringf("Error: AssetDB::CreateBuiltIn() tried to make built-in \"%s\" off the main thread", name.c_str()));
 
-	Material* gradientMat = new Material("Gradient");
-	gradientMat->SetDiffuse(AssetDB::GetTexture("Gradient"));
-	gradientMat->SetShader(AssetDB::GetShader(ShaderSource::UI_SHADER_NAME));
+	// Set first, since materials get their textures and shaders which could come back here
+	itr->second.isCreated = true;
+	itr->second.createFunction();
 
-	AssetCollection<Material>::AddAsset("Gradient", gradientMat);
+	LogTaggedPrintf("ASSETS", "Created built-in \"%s\" on first use", name.c_str());
+	return true;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Creates all built-in meshes for the engine, and stores them in the AssetDB
+// Makes every built-in of the type that hasn't been made yet
 //
-void AssetDB::CreateMeshes()
+void AssetDB::CreateAllBuiltInsOfType(eBuiltInAssetType type)
 {
-	// Cube
-	MeshBuilder mb;
-	mb.BeginBuilding(PRIMITIVE_TRIANGLES, true);
-	mb.PushCube(Vector3::ZERO, Vector3::ONES);
-	mb.FinishBuilding();
-	Mesh* cube = mb.CreateMesh();
-
-	AssetCollection<Mesh>::AddAsset("Cube", cube);
-
-	// Wire cube
-	mb.Clear();
-	mb.BeginBuilding(PRIMITIVE_LINES, false);
-	mb.PushLine(Vector3(-0.5f, -0.5f, -0.5f), Vector3(0.5f, -0.5f, -0.5f));
-	mb.PushLine(Vector3(0.5f, -0.5f, -0.5f), Vector3(0.5f, 0.5f, -0.5f));
-	mb.PushLine(Vector3(0.5f, 0.5f, -0.5f), Vector3(-0.5f, 0.5f, -0.5f));
-	mb.PushLine(Vector3(-0.5f, 0.5f, -0.5f), Vector3(-0.5f, -0.5f, -0.5f));
+	for (std::map<std::string, BuiltInAsset_t>::iterator itr = s_builtInAssets[type].begin(); itr != s_builtInAssets[type].end(); itr++)
+	{
+		CreateBuiltIn(type, itr->first);
+	}
+}
 
-	mb.PushLine(Vector3(-0.5f, -0.5f, 0.5f), Vector3(0.5f, -0.5f, 0.5f));
-	mb.PushLine(Vector3(0.5f, -0.5f, 0.5f), Vector3(0.5f, 0.5f, 0.5f));
-	mb.PushLine(Vector3(0.5f, 0.5f, 0.5f), Vector3(-0.5f, 0.5f, 0.5f));
-	mb.PushLine(Vector3(-0.5f, 0.5f, 0.5f), Vector3(-0.5f, -0.5f, 0.5f));
 
-	mb.PushLine(Vector3(-0.5f, -0.5f, -0.5f), Vector3(-0.5f, -0.5f, 0.5f));
-	mb.PushLine(Vector3(0.5f, -0.5f, -0.5f), Vector3(0.5f, -0.5f, 0.5f));
-	mb.PushLine(Vector3(0.5f, 0.5f, -0.5f), Vector3(0.5f, 0.5f, 0.5f));
-	mb.PushLine(Vector3(-0.5f, 0.5f, -0.5f), Vector3(-0.5f, 0.5f, 0.5f));
+//-----------------------------------------------------------------------------------------------
+// Makes up to the per frame count of built-ins nobody's used yet, stopping once they're all made
+//
+void AssetDB::CreatePrecompiledBuiltIns()
+{
+	int createdCount = 0;
 
-	mb.FinishBuilding();
-	Mesh* wireCube = mb.CreateMesh();
+	// Shaders first, they're what costs the most when first used
+	const eBuiltInAssetType typeOrder[] = { BUILT_IN_SHADER, BUILT_IN_TEXTURE, BUILT_IN_MATERIAL, BUILT_IN_MESH };
 
-	AssetCollection<Mesh>::AddAsset("Wire_Cube", wireCube);
+	for (eBuiltInAssetType type : typeOrder)
+	{
+		// The frame's shaders compile together, and are finished before any material could use them
+		bool isShaderType = (type == BUILT_IN_SHADER);
+		if (isShaderType)
+		{
+			ShaderProgram::BeginParallelCompile();
+		}
 
-	// Point
-	mb.Clear();
-	mb.BeginBuilding(PRIMITIVE_LINES, false);
-	mb.PushPoint(Vector3::ZERO);
-	mb.FinishBuilding();
-	Mesh* point = mb.CreateMesh();
+		for (std::map<std::string, BuiltInAsset_t>::iterator itr = s_builtInAssets[type].begin(); itr != s_builtInAssets[type].end(); itr++)
+		{
+			if (createdCount >= s_builtInsPrecompiledPerFrame)
+			{
+				break;
+			}
+
+			if (CreateBuiltIn(type, itr->first))
+			{
+				createdCount++;
+			}
+		}
 
-	AssetCollection<Mesh>::AddAsset("Point", point);
+		if (isShaderType)
+		{
+			ShaderProgram::EndParallelCompile();
+		}
 
-	// Sphere
-	mb.Clear();
-	mb.BeginBuilding(PRIMITIVE_TRIANGLES, true);
-	mb.PushUVSphere(Vector3::ZERO, 1.f, 8, 4);
-	mb.FinishBuilding();
-	Mesh* sphere = mb.CreateMesh();
+		if (createdCount >= s_builtInsPrecompiledPerFrame)
+		{
+			return;
+		}
+	}
 
-	AssetCollection<Mesh>::AddAsset("Sphere", sphere);
+	// Got through everything without hitting the limit, so there's nothing left to make
+	s_builtInsPrecompiledPerFrame = 0;
+	LogTaggedPrintf("ASSETS", "Finished precompiling built-in assets");
+}
 
-	// Bone
-	mb.Clear();
-	mb.BeginBuilding(PRIMITIVE_LINES, false);
 
-	// Small "back" facing shape
-	mb.PushLine(Vector3(0.f, 0.f, -0.5f), Vector3(0.f, 0.5f, 0.f));
-	mb.PushLine(Vector3(0.f, 0.f, -0.5f), Vector3(0.f, -0.5f, 0.f));
-	mb.PushLine(Vector3(0.f, 0.f, -0.5f), Vector3(0.5f, 0.f, 0.f));
-	mb.PushLine(Vector3(0.f, 0.f, -0.5f), Vector3(-0.5f, 0.f, 0.f));
+//-----------------------------------------------------------------------------------------------
+// Makes a texture from the image and adds it under the name
+//
+void AssetDB::AddBuiltInTexture(const std::string& name, const Image* image)
+{
+	Texture* texture = new Texture();
+	texture->CreateFromImage(image);
+	AssetCollection<Texture>::AddAsset(name, texture);
+}
 
-	// Larget "forward" shape
-	mb.PushLine(Vector3(0.f, 0.5f, 0.f), Vector3(0.f, 0.f, 2.f));
-	mb.PushLine(Vector3(0.f, -0.5f, 0.f), Vector3(0.f, 0.f, 2.f));
-	mb.PushLine(Vector3(0.5f, 0.f, 0.f), Vector3(0.f, 0.f, 2.f));
-	mb.PushLine(Vector3(-0.5f, 0.f, 0.f), Vector3(0.f, 0.f, 2.f));
 
-	// Line going right
-	mb.PushLine(Vector3::ZERO, Vector3(0.5f, 0.f, 0.f), Rgba::RED);
+//-----------------------------------------------------------------------------------------------
+// Builds the shader from source and adds it under the name
+//
+void AssetDB::AddBuiltInShader(const std::string& name, const char* vsSource, const char* fsSource, const RenderState* state, unsigned int layer, int queue, uint32_t keywords, bool isDeferrable)
+{
+	Shader* shader = Shader::BuildShader(name, vsSource, fsSource, *state, layer, (SortingQueue) queue, keywords);
+	shader->SetDeferrable(isDeferrable);
+	AssetCollection<Shader>::AddAsset(name, shader);
+}
 
-	// Line going up
-	mb.PushLine(Vector3::ZERO, Vector3(0.f, 0.5f, 0.f), Rgba::GREEN);
 
-	// Line through the center
-	mb.PushLine(Vector3(0.f, 0.f, -0.5f), Vector3(0.f, 0.f, 2.f), Rgba::BLUE);
+//-----------------------------------------------------------------------------------------------
+// Makes a material with the diffuse (if any) and shader, and adds it under the name
+//
+void AssetDB::AddBuiltInMaterial(const std::string& name, Texture* diffuse, const std::string& shaderName)
+{
+	Material* material = new Material(name);
 
-	mb.FinishBuilding();
-	Mesh* boneMesh = mb.CreateMesh<Vertex3D_PCU>();
+	if (diffuse != nullptr)
+	{
+		material->SetDiffuse(diffuse);
+	}
 
-	AssetCollection<Mesh>::AddAsset("Bone", boneMesh);
+	material->SetShader(GetShader(shaderName));
+	AssetCollection<Material>::AddAsset(name, material);
 }
 
 
@@ -314,8 +406,13 @@ Image* AssetDB::CreateOrGetImage(const std::string& filepath)
 		}
 
 		AssetCollection<Image>::AddAsset(filepath, img);
+		AssetResidency::Track(RESIDENCY_ASSET_IMAGE, img, filepath);
+		PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_ASSETS_LOADED);
 	}
 
+	// The pointer could be kept anywhere, so it's never evicted from here on
+	AssetResidency::SetPinned(img, true);
+
 	return img;
 }
 
@@ -326,6 +423,12 @@ Image* AssetDB::CreateOrGetImage(const std::string& filepath)
 Texture* AssetDB::GetTexture(const std::string& filename)
 {
 	Texture* texture = AssetCollection<Texture>::GetAsset(filename);
+
+	if (texture == nullptr && CreateBuiltIn(BUILT_IN_TEXTURE, filename))
+	{
+		texture = AssetCollection<Texture>::GetAsset(filename);
+	}
+
 	return texture;
 }
 
@@ -335,7 +438,7 @@ Texture* AssetDB::GetTexture(const std::string& filename)
 //
 Texture* AssetDB::CreateOrGetTexture(const std::string& filepath, bool generateMipMaps /*= false*/)
 {
-	Texture* texture = AssetCollection<Texture>::GetAsset(filepath);
+	Texture* texture = GetTexture(filepath);
 
 	if (texture == nullptr)
 	{
@@ -349,12 +452,36 @@ Texture* AssetDB::CreateOrGetTexture(const std::string& filepath, bool generateM
 		}
 
 		AssetCollection<Texture>::AddAsset(filepath, texture);
+		AssetHotReloader::TrackTexture(filepath, texture, generateMipMaps);
+		AssetResidency::Track(RESIDENCY_ASSET_TEXTURE, texture, filepath, generateMipMaps);
+		PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_ASSETS_LOADED);
 	}
 
+	AssetResidency::SetPinned(texture, true);
+
 	return texture;
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the ID of the texture given by filepath, or INVALID_ASSET_ID if it doesn't exist
+//
+AssetID AssetDB::GetTextureID(const std::string& filepath)
+{
+	GetTexture(filepath); // Makes it first if it's a built-in
+	return AssetCollection<Texture>::GetAssetID(filepath);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the texture with the ID, or null if there isn't one
+//
+Texture* AssetDB::GetTexture(AssetID textureID)
+{
+	return AssetCollection<Texture>::GetAsset(textureID);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the TextureCube given by name, returning null if it doesn't exist
 //
@@ -376,6 +503,7 @@ TextureCube* AssetDB::CreateOrGetTextureCube(const std::string& filepath)
 		textureCube = new TextureCube();
 		textureCube->CreateFromFile(filepath);
 		AssetCollection<TextureCube>::AddAsset(filepath, textureCube);
+		PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_ASSETS_LOADED);
 	}
 
 	return textureCube;
@@ -404,6 +532,7 @@ Skybox* AssetDB::CreateOrGetSkybox(const std::string& textureName)
 		skybox = new Skybox(skyboxTexture);
 
 		AssetCollection<Skybox>::AddAsset(textureName, skybox);
+		PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_ASSETS_LOADED);
 	}
 
 	return skybox;
@@ -430,6 +559,7 @@ SpriteSheet* AssetDB::CreateOrGetSpriteSheet(const std::string& spritesheetPath)
 	{
 		spritesheet = SpriteSheet::LoadSpriteSheet(spritesheetPath);
 		AssetCollection<SpriteSheet>::AddAsset(spritesheetPath, spritesheet);
+		PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_ASSETS_LOADED);
 	}
 
 	return spritesheet;
@@ -449,7 +579,7 @@ BitmapFont* AssetDB::GetBitmapFont(const std::string& filename)
 //-----------------------------------------------------------------------------------------------
 // Returns the BitmapFont given by name, attempting to construct it if it doesn't exist
 //
-BitmapFont* AssetDB::CreateOrGetBitmapFont(const std::string& fontPath)
+BitmapFont* AssetDB::CreateOrGetBitmapFont(const std::string& fontPath, bool isSignedDistanceField /*= false*/)
 {
 	BitmapFont* font = AssetCollection<BitmapFont>::GetAsset(fontPath);
 	
@@ -463,8 +593,10 @@ BitmapFont* AssetDB::CreateOrGetBitmapFont(const std::string& fontPath)
 
 		SpriteSheet spriteSheet = SpriteSheet(*fontTexture, IntVector2(16, 16));
 		font = new BitmapFont(spriteSheet, 1.0f);
+		font->SetIsSignedDistanceField(isSignedDistanceField);
 
 		AssetCollection<BitmapFont>::AddAsset(fontPath, font);
+		PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_ASSETS_LOADED);
 	}
 
 	return font;
@@ -476,7 +608,14 @@ BitmapFont* AssetDB::CreateOrGetBitmapFont(const std::string& fontPath)
 //
 Mesh* AssetDB::GetMesh(const std::string& filename)
 {
-	return AssetCollection<Mesh>::GetAsset(filename);
+	Mesh* mesh = AssetCollection<Mesh>::GetAsset(filename);
+
+	if (mesh == nullptr && CreateBuiltIn(BUILT_IN_MESH, filename))
+	{
+		mesh = AssetCollection<Mesh>::GetAsset(filename);
+	}
+
+	return mesh;
 }
 
 
@@ -485,16 +624,36 @@ Mesh* AssetDB::GetMesh(const std::string& filename)
 //
 Mesh* AssetDB::CreateOrGetMesh(const std::string& meshPath)
 {
-	Mesh* mesh = AssetCollection<Mesh>::GetAsset(meshPath);
+	Mesh* mesh = GetMesh(meshPath);
 
 	if (mesh == nullptr)
 	{
-		MeshBuilder mb;
-		mb.LoadFromObjFile(meshPath);
-		mesh = mb.CreateMesh();
+		if (CookedMeshFile::IsCookedMeshPath(meshPath))
+		{
+			CookedMeshFile cookedFile;
+			if (!cookedFile.LoadFromFile(meshPath) || cookedFile.GetMeshCount() == 0)
+			{
+				ConsoleErrorf("Couldn't load cooked mesh \"%s\"", meshPath.c_str());
+				return nullptr;
+			}
+
+			mesh = cookedFile.CreateMesh(0);
+		}
+		else
+		{
+			MeshBuilder mb;
+			mb.LoadFromObjFile(meshPath);
+			mesh = mb.CreateMesh();
+		}
+
 		AssetCollection<Mesh>::AddAsset(meshPath, mesh);
+		AssetHotReloader::TrackMesh(meshPath, mesh);
+		AssetResidency::Track(RESIDENCY_ASSET_MESH, mesh, meshPath);
+		PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_ASSETS_LOADED);
 	}
 
+	AssetResidency::SetPinned(mesh, true);
+
 	return mesh;
 }
 
@@ -504,13 +663,32 @@ Mesh* AssetDB::CreateOrGetMesh(const std::string& meshPath)
 //
 void AssetDB::AddMesh(const std::string& name, Mesh* mesh)
 {
-	Mesh* existingMesh = AssetCollection<Mesh>::GetAsset(name);
+	Mesh* existingMesh = GetMesh(name);
 	ASSERT_OR_DIE(existingMesh == nullptr, Stringf("Error: AssetDB::AddMesh() tried to add a duplicate mesh of name \"%s\"", name.c_str()));
 
 	AssetCollection<Mesh>::AddAsset(name, mesh);
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the ID of the mesh given by filename, or INVALID_ASSET_ID if it doesn't exist
+//
+AssetID AssetDB::GetMeshID(const std::string& filename)
+{
+	GetMesh(filename); // Makes it first if it's a built-in
+	return AssetCollection<Mesh>::GetAssetID(filename);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the mesh with the ID, or null if there isn't one
+//
+Mesh* AssetDB::GetMesh(AssetID meshID)
+{
+	return AssetCollection<Mesh>::GetAsset(meshID);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the Mesh Group given by filename, returning null if it doesn't exist
 //
@@ -529,12 +707,32 @@ MeshGroup* AssetDB::CreateOrGetMeshGroup(const std::string& filepath)
 
 	if (group == nullptr)
 	{
-		MeshGroupBuilder mgb;
-		mgb.LoadFromObjFile(filepath);
-		group = mgb.CreateMeshGroup();
+		if (CookedMeshFile::IsCookedMeshPath(filepath))
+		{
+			CookedMeshFile cookedFile;
+			if (!cookedFile.LoadFromFile(filepath))
+			{
+				ConsoleErrorf("Couldn't load cooked mesh \"%s\"", filepath.c_str());
+				return nullptr;
+			}
+
+			group = cookedFile.CreateMeshGroup();
+		}
+		else
+		{
+			MeshGroupBuilder mgb;
+			mgb.LoadFromObjFile(filepath);
+			group = mgb.CreateMeshGroup();
+		}
+
 		AssetCollection<MeshGroup>::AddAsset(filepath, group);
+		AssetHotReloader::TrackMeshGroup(filepath, group);
+		AssetResidency::Track(RESIDENCY_ASSET_MESH_GROUP, group, filepath);
+		PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_ASSETS_LOADED);
 	}
 
+	AssetResidency::SetPinned(group, true);
+
 	return group;
 }
 
@@ -544,7 +742,14 @@ MeshGroup* AssetDB::CreateOrGetMeshGroup(const std::string& filepath)
 //
 Shader* AssetDB::GetShader(const std::string& name)
 {
-	return AssetCollection<Shader>::GetAsset(name);
+	Shader* shader = AssetCollection<Shader>::GetAsset(name);
+
+	if (shader == nullptr && CreateBuiltIn(BUILT_IN_SHADER, name))
+	{
+		shader = AssetCollection<Shader>::GetAsset(name);
+	}
+
+	return shader;
 }
 
 
@@ -553,41 +758,65 @@ Shader* AssetDB::GetShader(const std::string& name)
 //
 Shader* AssetDB::CreateOrGetShader(const std::string& shaderPath)
 {
-	Shader* shader = AssetCollection<Shader>::GetAsset(shaderPath);
+	Shader* shader = GetShader(shaderPath);
 
 	if (shader == nullptr)
 	{
 		shader = new Shader(shaderPath);
 		AssetCollection<Shader>::AddAsset(shaderPath, shader);
+		AssetHotReloader::TrackShader(shaderPath, shader);
+		PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_ASSETS_LOADED);
 	}
 
 	return shader;
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the ID of the shader given by name, or INVALID_ASSET_ID if it doesn't exist
+//
+AssetID AssetDB::GetShaderID(const std::string& name)
+{
+	GetShader(name); // Makes it first if it's a built-in
+	return AssetCollection<Shader>::GetAssetID(name);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the shader with the ID, or null if there isn't one
+//
+Shader* AssetDB::GetShader(AssetID shaderID)
+{
+	return AssetCollection<Shader>::GetAsset(shaderID);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Reloads and compiles all shader programs from file
+// The compiles are all issued at once without waiting on any, and each program keeps its old version
+// until the Renderer swaps the new one in, so the reload doesn't stall the frame
 //
 void AssetDB::ReloadShaderPrograms()
 {
-	// Get an iterator over the shader collection
-	std::map<std::string, Shader*> shaders = AssetCollection<Shader>::s_collection;
-	std::map<std::string, Shader*>::iterator shaderItr = shaders.begin();
+	// IDs are every index up to the count
+	int shaderCount = AssetCollection<Shader>::GetAssetCount();
+	int reloadCount = 0;
 
-	for(shaderItr; shaderItr != shaders.end(); shaderItr++)
+	for (AssetID shaderID = 0; shaderID < (AssetID) shaderCount; ++shaderID)
 	{
 		// Check to ensure that we don't attempt to load a built-in shader
-		ShaderProgram* currProgram = shaderItr->second->GetProgram();
+		ShaderProgram* currProgram = AssetCollection<Shader>::GetAsset(shaderID)->GetProgram();
 		if (currProgram->WasBuiltFromSource())
 		{
 			continue;
 		}
 
-		// Attempt the reload, will assign invalid shader if broken
-		currProgram->LoadProgramFromFiles(currProgram->GetVSFilePathOrSource().c_str(), currProgram->GetFSFilePathOrSource().c_str());
+		// Attempt the reload, will assign invalid shader once it's finished if broken
+		currProgram->LoadProgramFromFilesAsync(currProgram->GetVSFilePathOrSource().c_str(), currProgram->GetFSFilePathOrSource().c_str(), currProgram->GetKeywords());
+		reloadCount++;
 	}
 
-	ConsolePrintf(Rgba::GREEN, "ShaderPrograms reloaded successfully");
+	ConsolePrintf(Rgba::GREEN, "Reloading %i ShaderPrograms, each is swapped in once it's compiled", reloadCount);
 }
 
 
@@ -597,6 +826,12 @@ void AssetDB::ReloadShaderPrograms()
 Material* AssetDB::GetSharedMaterial(const std::string& name)
 {
 	Material* material = AssetCollection<Material>::GetAsset(name);
+
+	if (material == nullptr && CreateBuiltIn(BUILT_IN_MATERIAL, name))
+	{
+		material = AssetCollection<Material>::GetAsset(name);
+	}
+
 	return material;
 }
 
@@ -624,7 +859,7 @@ MaterialInstance* AssetDB::CreateMaterialInstance(const std::string& name)
 //
 Material* AssetDB::CreateOrGetSharedMaterial(const std::string& materialPath)
 {
-	Material* material = AssetCollection<Material>::GetAsset(materialPath);
+	Material* material = GetSharedMaterial(materialPath);
 
 	if (material == nullptr)
 	{
@@ -638,7 +873,467 @@ Material* AssetDB::CreateOrGetSharedMaterial(const std::string& materialPath)
 		}
 
 		AssetCollection<Material>::AddAsset(materialPath, material);
+		AssetHotReloader::TrackMaterial(materialPath, material);
+		PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_ASSETS_LOADED);
+	}
+
+	return material;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the ID of the shared material given by name, or INVALID_ASSET_ID if it doesn't exist
+//
+AssetID AssetDB::GetSharedMaterialID(const std::string& name)
+{
+	GetSharedMaterial(name); // Makes it first if it's a built-in
+	return AssetCollection<Material>::GetAssetID(name);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the shared material with the ID, or null if there isn't one
+//
+Material* AssetDB::GetSharedMaterial(AssetID materialID)
+{
+	return AssetCollection<Material>::GetAsset(materialID);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the Texture given by filepath, queueing it to load on a disk worker if it doesn't exist
+// Until then it holds the default texture
+//
+Texture* AssetDB::CreateOrGetTextureAsync(const std::string& filepath, bool generateMipMaps /*= false*/, JobPriority priority /*= JOB_PRIORITY_BACKGROUND*/, AssetLoadedCallback callback /*= nullptr*/, void* userData /*= nullptr*/)
+{
+	Texture* texture = GetTexture(filepath);
+
+	if (texture != nullptr)
+	{
+		AssetResidency::SetPinned(texture, true);
+		AddLoadedCallback(texture, filepath, callback, userData);
+		return texture;
+	}
+
+	texture = new Texture();
+	AssetCollection<Texture>::AddAsset(filepath, texture);
+	AssetHotReloader::TrackTexture(filepath, texture, generateMipMaps);
+	AssetResidency::Track(RESIDENCY_ASSET_TEXTURE, texture, filepath, generateMipMaps);
+
+	// Already decoded for the CPU, so there's nothing to wait on
+	Image* image = AssetCollection<Image>::GetAsset(filepath);
+	if (image != nullptr)
+	{
+		if (!image->IsFlippedForTextures())
+		{
+			image->FlipVertical();
+		}
+
+		texture->CreateFromImage(image, generateMipMaps);
+		PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_ASSETS_LOADED);
+		AddLoadedCallback(texture, filepath, callback, userData);
+
+		return texture;
+	}
+
+	texture->CreateFromImage(&Image::IMAGE_DEFAULT_TEXTURE);
+	QueueAsyncLoad(new TextureLoadJob(filepath, texture, generateMipMaps, priority), callback, userData);
+
+	return texture;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the Mesh given by filepath, queueing it to load on a disk worker if it doesn't exist
+// Until then it's a unit cube
+//
+Mesh* AssetDB::CreateOrGetMeshAsync(const std::string& filepath, JobPriority priority /*= JOB_PRIORITY_BACKGROUND*/, AssetLoadedCallback callback /*= nullptr*/, void* userData /*= nullptr*/)
+{
+	Mesh* mesh = GetMesh(filepath);
+
+	if (mesh != nullptr)
+	{
+		AssetResidency::SetPinned(mesh, true);
+		AddLoadedCallback(mesh, filepath, callback, userData);
+		return mesh;
+	}
+
+	mesh = CreatePlaceholderMesh();
+	AssetCollection<Mesh>::AddAsset(filepath, mesh);
+	AssetHotReloader::TrackMesh(filepath, mesh);
+	AssetResidency::Track(RESIDENCY_ASSET_MESH, mesh, filepath);
+	QueueAsyncLoad(new MeshLoadJob(filepath, mesh, priority), callback, userData);
+
+	return mesh;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the Mesh Group given by filepath, queueing it to load on a disk worker if it doesn't exist
+// Until then it's a single unit cube, and that mesh is reused for the group's first
+//
+MeshGroup* AssetDB::CreateOrGetMeshGroupAsync(const std::string& filepath, JobPriority priority /*= JOB_PRIORITY_BACKGROUND*/, AssetLoadedCallback callback /*= nullptr*/, void* userData /*= nullptr*/)
+{
+	MeshGroup* group = AssetCollection<MeshGroup>::GetAsset(filepath);
+
+	if (group != nullptr)
+	{
+		AssetResidency::SetPinned(group, true);
+		AddLoadedCallback(group, filepath, callback, userData);
+		return group;
+	}
+
+	group = new MeshGroup();
+	group->AddMeshUnique(CreatePlaceholderMesh());
+	AssetCollection<MeshGroup>::AddAsset(filepath, group);
+	AssetHotReloader::TrackMeshGroup(filepath, group);
+	AssetResidency::Track(RESIDENCY_ASSET_MESH_GROUP, group, filepath);
+	QueueAsyncLoad(new MeshGroupLoadJob(filepath, group, priority), callback, userData);
+
+	return group;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the shared material given by name, loading it if it doesn't exist with its textures
+// loaded async; the material file itself is small, and its shader has to compile on this thread
+//
+Material* AssetDB::CreateOrGetSharedMaterialAsync(const std::string& materialPath, JobPriority texturePriority /*= JOB_PRIORITY_BACKGROUND*/)
+{
+	Material* material = GetSharedMaterial(materialPath);
+
+	if (material == nullptr)
+	{
+		material = new Material(materialPath);
+		bool success = material->LoadFromFile(materialPath, true, texturePriority);
+
+		if (!success)
+		{
+			delete material;
+			return nullptr;
+		}
+
+		AssetCollection<Material>::AddAsset(materialPath, material);
+		AssetHotReloader::TrackMaterial(materialPath, material);
+		PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_ASSETS_LOADED);
 	}
 
 	return material;
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Uploads the async loads that have finished decoding and calls their callbacks, as many as fit in
+// the frame's main thread budget; the rest wait for the next frame
+//
+void AssetDB::FinalizeAsyncLoads()
+{
+	JobSystem* jobSystem = JobSystem::GetInstance();
+
+	if (s_pendingLoads.size() > 0 && jobSystem != nullptr)
+	{
+		float secondsSpent = jobSystem->FinalizeFinishedJobsOfTypeForBudget(ASSET_LOAD_JOB_TYPE, MainThreadScheduler::GetRemainingFrameSeconds());
+		MainThreadScheduler::ChargeFrameSeconds(secondsSpent);
+	}
+
+	if (s_builtInsPrecompiledPerFrame > 0)
+	{
+		CreatePrecompiledBuiltIns();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Waits for every async load to finish and finalizes them, for loading screens
+//
+void AssetDB::BlockUntilAsyncLoadsFinished()
+{
+	PROFILE_SCOPE_CATEGORY("AssetDB::BlockUntilAsyncLoadsFinished", "Assets");
+	JobSystem* jobSystem = JobSystem::GetInstance();
+
+	if (s_pendingLoads.size() > 0 && jobSystem != nullptr)
+	{
+		jobSystem->BlockUntilAllJobsOfTypeAreFinalized(ASSET_LOAD_JOB_TYPE);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the asset is still waiting on its async load
+//
+bool AssetDB::IsAsyncLoadPending(const void* asset)
+{
+	return (s_pendingLoads.find(asset) != s_pendingLoads.end());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of async loads that haven't been finalized
+//
+int AssetDB::GetPendingAsyncLoadCount()
+{
+	return (int) s_pendingLoads.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues the texture's file to be decoded and uploaded over its current texels
+//
+void AssetDB::ReloadTextureAsync(Texture* texture, const std::string& filepath, bool generateMipMaps)
+{
+	ASSERT_OR_DIE(!IsAsyncLoadPending(texture), Stringf("Error: AssetDB::ReloadTextureAsync() called on \"%s\" while it's still loading", filepath.c_str()));
+	QueueAsyncLoad(new TextureLoadJob(filepath, texture, generateMipMaps, JOB_PRIORITY_NORMAL), nullptr, nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues the mesh's file to be parsed and uploaded over its current geometry
+//
+void AssetDB::ReloadMeshAsync(Mesh* mesh, const std::string& filepath)
+{
+	ASSERT_OR_DIE(!IsAsyncLoadPending(mesh), Stringf("Error: AssetDB::ReloadMeshAsync() called on \"%s\" while it's still loading", filepath.c_str()));
+	QueueAsyncLoad(new MeshLoadJob(filepath, mesh, JOB_PRIORITY_NORMAL), nullptr, nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues the group's file to be parsed and uploaded over its current meshes
+//
+void AssetDB::ReloadMeshGroupAsync(MeshGroup* meshGroup, const std::string& filepath)
+{
+	ASSERT_OR_DIE(!IsAsyncLoadPending(meshGroup), Stringf("Error: AssetDB::ReloadMeshGroupAsync() called on \"%s\" while it's still loading", filepath.c_str()));
+	QueueAsyncLoad(new MeshGroupLoadJob(filepath, meshGroup, JOB_PRIORITY_NORMAL), nullptr, nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a handle to the texture given by filepath, loading it async if it doesn't exist
+// Only assets first made through the Acquire functions can be evicted, the others have had raw pointers handed out
+//
+AssetHandle<Texture> AssetDB::AcquireTexture(const std::string& filepath, bool generateMipMaps /*= false*/, JobPriority priority /*= JOB_PRIORITY_NORMAL*/)
+{
+	Texture* texture = GetTexture(filepath);
+
+	if (texture == nullptr)
+	{
+		texture = CreateOrGetTextureAsync(filepath, generateMipMaps, priority);
+		AssetResidency::SetPinned(texture, false); // Nothing else has the pointer yet
+	}
+
+	return AssetHandle<Texture>(texture);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a handle to the mesh given by filepath, loading it async if it doesn't exist
+//
+AssetHandle<Mesh> AssetDB::AcquireMesh(const std::string& filepath, JobPriority priority /*= JOB_PRIORITY_NORMAL*/)
+{
+	Mesh* mesh = GetMesh(filepath);
+
+	if (mesh == nullptr)
+	{
+		mesh = CreateOrGetMeshAsync(filepath, priority);
+		AssetResidency::SetPinned(mesh, false);
+	}
+
+	return AssetHandle<Mesh>(mesh);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a handle to the mesh group given by filepath, loading it async if it doesn't exist
+//
+AssetHandle<MeshGroup> AssetDB::AcquireMeshGroup(const std::string& filepath, JobPriority priority /*= JOB_PRIORITY_NORMAL*/)
+{
+	MeshGroup* group = AssetCollection<MeshGroup>::GetAsset(filepath);
+
+	if (group == nullptr)
+	{
+		group = CreateOrGetMeshGroupAsync(filepath, priority);
+		AssetResidency::SetPinned(group, false);
+	}
+
+	return AssetHandle<MeshGroup>(group);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a handle to the image given by filepath, loading it right away if it doesn't exist
+// The handle is invalid if the image couldn't be loaded
+//
+AssetHandle<Image> AssetDB::AcquireImage(const std::string& filepath)
+{
+	Image* image = AssetCollection<Image>::GetAsset(filepath);
+
+	if (image == nullptr)
+	{
+		image = CreateOrGetImage(filepath);
+		AssetResidency::SetPinned(image, false);
+	}
+
+	return AssetHandle<Image>(image);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues the load on the disk workers, or runs it right here if there's no JobSystem
+//
+void AssetDB::QueueAsyncLoad(AssetLoadJob* job, AssetLoadedCallback callback, void* userData)
+{
+	if (callback != nullptr)
+	{
+		job->AddCallback(callback, userData);
+	}
+
+	s_pendingLoads[job->GetAsset()] = job;
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+
+	if (jobSystem != nullptr)
+	{
+		jobSystem->QueueJob(job);
+	}
+	else
+	{
+		job->Execute();
+		job->Finalize();
+		delete job;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Calls the callback once the asset is loaded - later if it's pending, otherwise now
+// An asset whose async load failed is reported as loaded, since it has been (with its placeholder)
+//
+void AssetDB::AddLoadedCallback(const void* asset, const std::string& filepath, AssetLoadedCallback callback, void* userData)
+{
+	if (callback == nullptr)
+	{
+		return;
+	}
+
+	std::map<const void*, AssetLoadJob*>::iterator itr = s_pendingLoads.find(asset);
+
+	if (itr != s_pendingLoads.end())
+	{
+		itr->second->AddCallback(callback, userData);
+	}
+	else
+	{
+		callback(filepath, true, userData);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Called by the job as it's finalized, before its callbacks
+//
+void AssetDB::OnAsyncLoadFinished(AssetLoadJob* job)
+{
+	s_pendingLoads.erase(job->GetAsset());
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns a new unit cube, which async meshes hold until they've loaded
+//
+static Mesh* CreatePlaceholderMesh()
+{
+	MeshBuilder mb;
+	mb.BeginBuilding(PRIMITIVE_TRIANGLES, true);
+	mb.PushCube(Vector3::ZERO, Vector3::ONES);
+	mb.FinishBuilding();
+
+	return mb.CreateMesh();
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns a new unit cube made of lines
+//
+static Mesh* CreateWireCubeMesh()
+{
+	MeshBuilder mb;
+	mb.BeginBuilding(PRIMITIVE_LINES, false);
+	mb.PushLine(Vector3(-0.5f, -0.5f, -0.5f), Vector3(0.5f, -0.5f, -0.5f));
+	mb.PushLine(Vector3(0.5f, -0.5f, -0.5f), Vector3(0.5f, 0.5f, -0.5f));
+	mb.PushLine(Vector3(0.5f, 0.5f, -0.5f), Vector3(-0.5f, 0.5f, -0.5f));
+	mb.PushLine(Vector3(-0.5f, 0.5f, -0.5f), Vector3(-0.5f, -0.5f, -0.5f));
+
+	mb.PushLine(Vector3(-0.5f, -0.5f, 0.5f), Vector3(0.5f, -0.5f, 0.5f));
+	mb.PushLine(Vector3(0.5f, -0.5f, 0.5f), Vector3(0.5f, 0.5f, 0.5f));
+	mb.PushLine(Vector3(0.5f, 0.5f, 0.5f), Vector3(-0.5f, 0.5f, 0.5f));
+	mb.PushLine(Vector3(-0.5f, 0.5f, 0.5f), Vector3(-0.5f, -0.5f, 0.5f));
+
+	mb.PushLine(Vector3(-0.5f, -0.5f, -0.5f), Vector3(-0.5f, -0.5f, 0.5f));
+	mb.PushLine(Vector3(0.5f, -0.5f, -0.5f), Vector3(0.5f, -0.5f, 0.5f));
+	mb.PushLine(Vector3(0.5f, 0.5f, -0.5f), Vector3(0.5f, 0.5f, 0.5f));
+	mb.PushLine(Vector3(-0.5f, 0.5f, -0.5f), Vector3(-0.5f, 0.5f, 0.5f));
+
+	mb.FinishBuilding();
+	return mb.CreateMesh();
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns a new single point mesh
+//
+static Mesh* CreatePointMesh()
+{
+	MeshBuilder mb;
+	mb.BeginBuilding(PRIMITIVE_LINES, false);
+	mb.PushPoint(Vector3::ZERO);
+	mb.FinishBuilding();
+
+	return mb.CreateMesh();
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns a new low poly unit sphere
+//
+static Mesh* CreateSphereMesh()
+{
+	MeshBuilder mb;
+	mb.BeginBuilding(PRIMITIVE_TRIANGLES, true);
+	mb.PushUVSphere(Vector3::ZERO, 1.f, 8, 4);
+	mb.FinishBuilding();
+
+	return mb.CreateMesh();
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns a new bone gizmo, pointing down +z with its right and up axes colored
+//
+static Mesh* CreateBoneMesh()
+{
+	MeshBuilder mb;
+	mb.BeginBuilding(PRIMITIVE_LINES, false);
+
+	// Small "back" facing shape
+	mb.PushLine(Vector3(0.f, 0.f, -0.5f), Vector3(0.f, 0.5f, 0.f));
+	mb.PushLine(Vector3(0.f, 0.f, -0.5f), Vector3(0.f, -0.5f, 0.f));
+	mb.PushLine(Vector3(0.f, 0.f, -0.5f), Vector3(0.5f, 0.f, 0.f));
+	mb.PushLine(Vector3(0.f, 0.f, -0.5f), Vector3(-0.5f, 0.f, 0.f));
+
+	// Larget "forward" shape
+	mb.PushLine(Vector3(0.f, 0.5f, 0.f), Vector3(0.f, 0.f, 2.f));
+	mb.PushLine(Vector3(0.f, -0.5f, 0.f), Vector3(0.f, 0.f, 2.f));
+	mb.PushLine(Vector3(0.5f, 0.f, 0.f), Vector3(0.f, 0.f, 2.f));
+	mb.PushLine(Vector3(-0.5f, 0.f, 0.f), Vector3(0.f, 0.f, 2.f));
+
+	// Line going right
+	mb.PushLine(Vector3::ZERO, Vector3(0.5f, 0.f, 0.f), Rgba::RED);
+
+	// Line going up
+	mb.PushLine(Vector3::ZERO, Vector3(0.f, 0.5f, 0.f), Rgba::GREEN);
+
+	// Line through the center
+	mb.PushLine(Vector3(0.f, 0.f, -0.5f), Vector3(0.f, 0.f, 2.f), Rgba::BLUE);
+
+	mb.FinishBuilding();
+	return mb.CreateMesh<Vertex3D_PCU>();
+}
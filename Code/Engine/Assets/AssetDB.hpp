@@ -6,8 +6,14 @@
 				all game and engine assets
 /************************************************************************/
 #pragma once
+#include <map>
+#include <thread>
 #include <vector>
 #include <string>
+#include <stdint.h>
+#include <functional>
+#include "Engine/Core/JobSystem/Job.hpp"
+#include "Engine/Assets/AssetResidency.hpp"
 
 class Mesh;
 class Image;
@@ -23,18 +29,56 @@ class TextureCube;
 class Skeleton;
 class ShaderProgram;
 class MaterialInstance;
+class AssetLoadJob;
+struct RenderState;
+
+// Index of an asset in its type's collection, for hot paths to cache instead of looking up by name
+// Only meaningful for the type it was gotten for, and valid for the whole run
+typedef uint32_t AssetID;
+#define INVALID_ASSET_ID (0xFFFFFFFF)
+
+// Called on the main thread once an async load has finished; on failure the asset keeps its placeholder
+typedef void(*AssetLoadedCallback)(const std::string& filepath, bool wasSuccessful, void* userData);
+
+// Built-ins are registered by CreateBuiltInAssets(), and only made the first time they're gotten by name
+enum eBuiltInAssetType
+{
+	BUILT_IN_TEXTURE,
+	BUILT_IN_SHADER,
+	BUILT_IN_MATERIAL,
+	BUILT_IN_MESH,
+	NUM_BUILT_IN_ASSET_TYPES
+};
+
+struct BuiltInAsset_t
+{
+	std::function<void()>	createFunction;		// Adds the asset to its collection
+	bool					isCreated = false;
+};
+
+// How many built-ins PrecompileBuiltInAssets() makes per frame by default, each about one shader compile or cache load
+#define BUILT_IN_PRECOMPILE_PER_FRAME (4)
 
 class AssetDB
 {
+	friend class AssetLoadJob;
+
 public:
 	//-----Public Methods-----
 
+	// Registers the built-ins without making any; each is made the first time it's gotten by name, which
+	// has to be on the thread that called this (the one with the GL context)
+	// Headless runs register none, as every built-in lives on the GPU
 	static void CreateBuiltInAssets();
-		static void CreateTextures();
-		static void CreateShaders();
+		static void CreateTextures();		// Each of these makes every built-in of its type right away,
+		static void CreateShaders();		// for anything that would rather pay for them up front (shaders compile in parallel)
 		static void CreateMaterials();
 		static void CreateMeshes();
 
+	// Makes the built-ins nothing has asked for yet a few per frame in FinalizeAsyncLoads(), so they're ready
+	// by the time they're used without stalling startup; 0 stops
+	static void PrecompileBuiltInAssets(int assetsPerFrame = BUILT_IN_PRECOMPILE_PER_FRAME);
+
 	// Images
 	static Image* GetImage(const std::string& filename);
 	static Image* CreateOrGetImage(const std::string& filename);
@@ -42,6 +86,8 @@ public:
 	// Textures
 	static Texture* GetTexture(const std::string& filename);
 	static Texture* CreateOrGetTexture(const std::string& filename, bool generateMipMaps = false);
+	static AssetID	GetTextureID(const std::string& filename);
+	static Texture* GetTexture(AssetID textureID);
 	
 	// Texture Cubes
 	static TextureCube* GetTextureCube(const std::string& filename);
@@ -57,12 +103,14 @@ public:
 
 	// Fonts
 	static BitmapFont* GetBitmapFont(const std::string& filename);
-	static BitmapFont* CreateOrGetBitmapFont(const std::string& filename);
+	static BitmapFont* CreateOrGetBitmapFont(const std::string& filename, bool isSignedDistanceField = false);	// Flag is only used if it's constructed
 
 	// Meshes
 	static Mesh*	GetMesh(const std::string& filename);
 	static Mesh*	CreateOrGetMesh(const std::string& filename);
 	static void		AddMesh(const std::string& name, Mesh* mesh);
+	static AssetID	GetMeshID(const std::string& filename);
+	static Mesh*	GetMesh(AssetID meshID);
 
 	// Mesh Groups
 	static MeshGroup* GetMeshGroup(const std::string& filename);
@@ -71,6 +119,8 @@ public:
 	// Shaders
 	static Shader*	GetShader(const std::string& name);
 	static Shader*	CreateOrGetShader(const std::string& name);
+	static AssetID	GetShaderID(const std::string& name);
+	static Shader*	GetShader(AssetID shaderID);
 	static void		ReloadShaderPrograms();
 	
 
@@ -78,9 +128,67 @@ public:
 	static Material*			GetSharedMaterial(const std::string& name);
 	static MaterialInstance*	CreateMaterialInstance(const std::string& name);
 	static Material*			CreateOrGetSharedMaterial(const std::string& name);
+	static AssetID				GetSharedMaterialID(const std::string& name);
+	static Material*			GetSharedMaterial(AssetID materialID);
+
+	// Async loads - the asset is returned right away holding a placeholder (the default texture, a cube),
+	// and filled in place once its file is decoded on a disk worker and uploaded by FinalizeAsyncLoads()
+	// The callback is called then, or right away if the asset was already loaded
+	// Meshes copied somewhere else (e.g. a MeshArena) before they finish keep the placeholder geometry
+	static Texture*				CreateOrGetTextureAsync(const std::string& filename, bool generateMipMaps = false, JobPriority priority = JOB_PRIORITY_BACKGROUND, AssetLoadedCallback callback = nullptr, void* userData = nullptr);
+	static Mesh*				CreateOrGetMeshAsync(const std::string& filename, JobPriority priority = JOB_PRIORITY_BACKGROUND, AssetLoadedCallback callback = nullptr, void* userData = nullptr);
+	static MeshGroup*			CreateOrGetMeshGroupAsync(const std::string& filename, JobPriority priority = JOB_PRIORITY_BACKGROUND, AssetLoadedCallback callback = nullptr, void* userData = nullptr);
+	static Material*			CreateOrGetSharedMaterialAsync(const std::string& name, JobPriority texturePriority = JOB_PRIORITY_BACKGROUND);
+
+	static void					FinalizeAsyncLoads(); // Main thread, called by the Renderer at the start of each frame
+	static void					BlockUntilAsyncLoadsFinished();
+	static bool					IsAsyncLoadPending(const void* asset);
+	static int					GetPendingAsyncLoadCount();
+
+	// Hot reloading - the file is decoded again on a disk worker and swapped into the existing asset by
+	// FinalizeAsyncLoads(), so nothing holding it has to change; on failure the asset keeps its current data
+	static void					ReloadTextureAsync(Texture* texture, const std::string& filepath, bool generateMipMaps);
+	static void					ReloadMeshAsync(Mesh* mesh, const std::string& filepath);
+	static void					ReloadMeshGroupAsync(MeshGroup* meshGroup, const std::string& filepath);
+
+	// Residency - handles keep the asset loaded, while assets no handle refers to can be evicted to stay within
+	// AssetResidency's budgets and are reloaded when next acquired; anything gotten as a raw pointer is never evicted
+	// Textures and meshes load async and hold placeholders until they're resident, images load right away
+	static AssetHandle<Texture>		AcquireTexture(const std::string& filepath, bool generateMipMaps = false, JobPriority priority = JOB_PRIORITY_NORMAL);
+	static AssetHandle<Mesh>		AcquireMesh(const std::string& filepath, JobPriority priority = JOB_PRIORITY_NORMAL);
+	static AssetHandle<MeshGroup>	AcquireMeshGroup(const std::string& filepath, JobPriority priority = JOB_PRIORITY_NORMAL);
+	static AssetHandle<Image>		AcquireImage(const std::string& filepath);
+
+
+private:
+	//-----Private Methods-----
+
+	// Built-ins
+	static void					RegisterBuiltInTextures();
+	static void					RegisterBuiltInShaders();
+	static void					RegisterBuiltInMaterials();
+	static void					RegisterBuiltInMeshes();
+	static void					RegisterBuiltIn(eBuiltInAssetType type, const std::string& name, const std::function<void()>& createFunction);
+	static bool					CreateBuiltIn(eBuiltInAssetType type, const std::string& name);
+	static void					CreateAllBuiltInsOfType(eBuiltInAssetType type);
+	static void					CreatePrecompiledBuiltIns();
+
+	static void					AddBuiltInTexture(const std::string& name, const Image* image);
+	static void					AddBuiltInShader(const std::string& name, const char* vsSource, const char* fsSource, const RenderState* state, unsigned int layer, int queue, uint32_t keywords, bool isDeferrable);
+	static void					AddBuiltInMaterial(const std::string& name, Texture* diffuse, const std::string& shaderName);
+
+	static void					QueueAsyncLoad(AssetLoadJob* job, AssetLoadedCallback callback, void* userData);
+	static void					AddLoadedCallback(const void* asset, const std::string& filepath, AssetLoadedCallback callback, void* userData);
+	static void					OnAsyncLoadFinished(AssetLoadJob* job);
 
 
 private:
 	//-----Private Data-----
 
+	static std::map<const void*, AssetLoadJob*> s_pendingLoads; // Keyed by asset, main thread only
+
+	static std::map<std::string, BuiltInAsset_t>	s_builtInAssets[NUM_BUILT_IN_ASSET_TYPES];	// Filled at startup, then only changed on the main thread
+	static std::thread::id							s_builtInThreadID;
+	static int										s_builtInsPrecompiledPerFrame;
+
 };
@@ -0,0 +1,726 @@
+/************************************************************************/
+/* File: AssetHotReloader.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the AssetHotReloader class
+/************************************************************************/
+#include <set>
+#include <ctype.h>
+#include "Engine/Assets/AssetDB.hpp"
+#include "Engine/Core/Time/Time.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Assets/AssetCooker.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Assets/AssetHotReloader.hpp"
+#include "Engine/Assets/AssetResidency.hpp"
+#include "Engine/Core/JobSystem/JobSystem.hpp"
+#include "Engine/Core/JobSystem/FunctionJob.hpp"
+#include "Engine/Rendering/Shaders/Shader.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
+#include "Engine/Rendering/Materials/Material.hpp"
+#include "Engine/Rendering/Shaders/ShaderProgram.hpp"
+#include "Engine/Core/DeveloperConsole/Command.hpp"
+#include "Engine/Core/DeveloperConsole/DevConsole.hpp"
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+
+// Size of the buffer the OS reports changes into, overflowing it drops that batch of changes
+#define HOT_RELOAD_NOTIFY_BUFFER_SIZE (32 * 1024)
+
+std::vector<AssetHotReloader::TrackedAsset_t>		AssetHotReloader::s_assets;
+std::map<const void*, int>							AssetHotReloader::s_assetIndices;
+std::map<std::string, std::vector<int>>				AssetHotReloader::s_fileAssets;
+std::mutex											AssetHotReloader::s_changeLock;
+std::map<std::string, uint64_t>						AssetHotReloader::s_changedFiles;
+std::atomic<bool>									AssetHotReloader::s_isWatching(false);
+ThreadHandle_t										AssetHotReloader::s_watchThread = nullptr;
+
+// Cooks run on a disk worker, and the strings don't fit in a FunctionJob
+struct HotReloadCookRequest_t
+{
+	std::string sourcePath;
+	std::string outputPath;
+	bool		isObj = false;
+};
+
+// C functions
+void Command_HotReload(Command& cmd);
+void Command_ReloadAsset(Command& cmd);
+void Command_AssetDependents(Command& cmd);
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts watching the data directory for changes
+//
+void AssetHotReloader::Initialize()
+{
+	if (s_isWatching)
+	{
+		return;
+	}
+
+	s_isWatching = true;
+	s_watchThread = Thread::Create(WatchThreadEntry, nullptr, "AssetWatcher", THREAD_AFFINITY_ANY, THREAD_PRIORITY_SETTING_BELOW_NORMAL);
+
+	LogTaggedPrintf("ASSETS", "Hot reloading assets in \"%s\"", HOT_RELOAD_WATCH_DIRECTORY);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stops the watcher thread, changes it already reported but that haven't settled are dropped
+//
+void AssetHotReloader::Shutdown()
+{
+	if (!s_isWatching)
+	{
+		return;
+	}
+
+	s_isWatching = false;
+
+	Thread::Join(s_watchThread);
+	s_watchThread = nullptr;
+
+	std::lock_guard<std::mutex> lock(s_changeLock);
+	s_changedFiles.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the watcher thread is running
+//
+bool AssetHotReloader::IsWatching()
+{
+	return s_isWatching;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Registers the hot reload commands
+//
+void AssetHotReloader::InitializeConsoleCommands()
+{
+	Command::Register("hot_reload",		"Starts or stops reloading assets as their files change. Params: e=enabled",			Command_HotReload);
+	Command::Register("reload_asset",	"Reloads the assets loaded from a file, and everything that depends on them. Params: f=file",	Command_ReloadAsset);
+	Command::Register("asset_deps",		"Lists what reload_asset would reload for a file. Params: f=file",						Command_AssetDependents);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reloads every file that's gone HOT_RELOAD_SETTLE_SECONDS without changing
+//
+void AssetHotReloader::Update()
+{
+	if (!s_isWatching)
+	{
+		return;
+	}
+
+	PROFILE_SCOPE_CATEGORY("AssetHotReloader::Update", "Assets");
+
+	std::vector<std::string> settledFiles;
+	uint64_t currentTime = GetPerformanceCounter();
+	uint64_t settleDuration = TimeSystem::SecondsToPerformanceCount(HOT_RELOAD_SETTLE_SECONDS);
+
+	{
+		std::lock_guard<std::mutex> lock(s_changeLock);
+		std::map<std::string, uint64_t>::iterator itr = s_changedFiles.begin();
+
+		while (itr != s_changedFiles.end())
+		{
+			if (currentTime - itr->second >= settleDuration)
+			{
+				settledFiles.push_back(itr->first);
+				itr = s_changedFiles.erase(itr);
+			}
+			else
+			{
+				++itr;
+			}
+		}
+	}
+
+	for (const std::string& filepath : settledFiles)
+	{
+		ReloadFile(filepath);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Tracks a texture loaded from file
+//
+void AssetHotReloader::TrackTexture(const std::string& filepath, Texture* texture, bool generateMipMaps)
+{
+	int assetIndex = AddTrackedAsset(HOT_RELOAD_ASSET_TEXTURE, texture, filepath);
+	s_assets[assetIndex].generateMipMaps = generateMipMaps;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Tracks a mesh loaded from file
+//
+void AssetHotReloader::TrackMesh(const std::string& filepath, Mesh* mesh)
+{
+	AddTrackedAsset(HOT_RELOAD_ASSET_MESH, mesh, filepath);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Tracks a mesh group loaded from file, whose meshes are all loaded from that same file
+//
+void AssetHotReloader::TrackMeshGroup(const std::string& filepath, MeshGroup* meshGroup)
+{
+	AddTrackedAsset(HOT_RELOAD_ASSET_MESH_GROUP, meshGroup, filepath);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Tracks a shader loaded from its .shader file, which also reloads when its program's stages change
+//
+void AssetHotReloader::TrackShader(const std::string& filepath, Shader* shader)
+{
+	int assetIndex = AddTrackedAsset(HOT_RELOAD_ASSET_SHADER, shader, filepath);
+	AddShaderFiles(assetIndex, shader);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Tracks a material loaded from file, which depends on its shader and textures
+//
+void AssetHotReloader::TrackMaterial(const std::string& filepath, Material* material)
+{
+	int assetIndex = AddTrackedAsset(HOT_RELOAD_ASSET_MATERIAL, material, filepath);
+	AddMaterialDependencies(assetIndex, material);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Tracks a source model cooked to outputPath, so editing the source cooks it again
+//
+void AssetHotReloader::TrackCookSource(const std::string& sourcePath, const std::string& outputPath, bool isObj)
+{
+	for (const TrackedAsset_t& trackedAsset : s_assets)
+	{
+		if (trackedAsset.type == HOT_RELOAD_ASSET_COOK_SOURCE && trackedAsset.filepath == sourcePath && trackedAsset.cookOutputPath == outputPath)
+		{
+			return;
+		}
+	}
+
+	TrackedAsset_t cookSource;
+	cookSource.type = HOT_RELOAD_ASSET_COOK_SOURCE;
+	cookSource.filepath = sourcePath;
+	cookSource.cookOutputPath = outputPath;
+	cookSource.isCookedFromObj = isObj;
+
+	s_assets.push_back(cookSource);
+	AddFileForAsset(sourcePath, (int) s_assets.size() - 1);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reloads the assets loaded from the file, then the assets depending on those that need it
+//
+int AssetHotReloader::ReloadFile(const std::string& filepath)
+{
+	std::vector<int> reloadOrder;
+	GetReloadOrder(filepath, reloadOrder);
+
+	if (reloadOrder.size() == 0)
+	{
+		return 0;
+	}
+
+	PROFILE_SCOPE_CATEGORY("AssetHotReloader::ReloadFile", "Assets");
+
+	int reloadCount = 0;
+	for (int assetIndex : reloadOrder)
+	{
+		if (ReloadAsset(assetIndex))
+		{
+			++reloadCount;
+		}
+	}
+
+	LogTaggedPrintf("ASSETS", "Hot reload of \"%s\" reloaded %i of %i assets", filepath.c_str(), reloadCount, (int) reloadOrder.size());
+	return reloadCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the files ReloadFile() would reload for the file, the file itself first
+//
+void AssetHotReloader::GetReloadFilePaths(const std::string& filepath, std::vector<std::string>& out_filepaths)
+{
+	std::vector<int> reloadOrder;
+	GetReloadOrder(filepath, reloadOrder);
+
+	for (int assetIndex : reloadOrder)
+	{
+		out_filepaths.push_back(s_assets[assetIndex].filepath);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the asset to the graph if it isn't already, returning its index
+//
+int AssetHotReloader::AddTrackedAsset(eHotReloadAssetType type, void* asset, const std::string& filepath)
+{
+	std::map<const void*, int>::iterator itr = s_assetIndices.find(asset);
+
+	if (itr != s_assetIndices.end())
+	{
+		return itr->second;
+	}
+
+	TrackedAsset_t trackedAsset;
+	trackedAsset.type = type;
+	trackedAsset.asset = asset;
+	trackedAsset.filepath = filepath;
+
+	int assetIndex = (int) s_assets.size();
+	s_assets.push_back(trackedAsset);
+	s_assetIndices[asset] = assetIndex;
+
+	AddFileForAsset(filepath, assetIndex);
+
+	return assetIndex;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Marks the asset as loaded from the file, so a change to it reloads the asset
+//
+void AssetHotReloader::AddFileForAsset(const std::string& filepath, int assetIndex)
+{
+	std::vector<int>& fileAssets = s_fileAssets[NormalizePath(filepath)];
+
+	for (int existingIndex : fileAssets)
+	{
+		if (existingIndex == assetIndex)
+		{
+			return;
+		}
+	}
+
+	fileAssets.push_back(assetIndex);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Marks the asset at dependentIndex as built using dependency, if dependency is tracked at all
+// Built-in assets (the white texture, source shaders) aren't, since they never change
+//
+void AssetHotReloader::AddDependency(const void* dependency, int dependentIndex)
+{
+	std::map<const void*, int>::iterator itr = s_assetIndices.find(dependency);
+
+	if (itr == s_assetIndices.end() || itr->second == dependentIndex)
+	{
+		return;
+	}
+
+	std::vector<int>& dependentIndices = s_assets[itr->second].dependentIndices;
+
+	for (int existingIndex : dependentIndices)
+	{
+		if (existingIndex == dependentIndex)
+		{
+			return;
+		}
+	}
+
+	dependentIndices.push_back(dependentIndex);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the shader program's stage files to the shader, which may have changed if the .shader did
+//
+void AssetHotReloader::AddShaderFiles(int shaderIndex, const Shader* shader)
+{
+	const ShaderProgram* program = shader->GetProgram();
+
+	if (program == nullptr || program->WasBuiltFromSource())
+	{
+		return;
+	}
+
+	AddFileForAsset(program->GetVSFilePathOrSource(), shaderIndex);
+	AddFileForAsset(program->GetFSFilePathOrSource(), shaderIndex);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the material as a dependent of its shader and textures
+//
+void AssetHotReloader::AddMaterialDependencies(int materialIndex, const Material* material)
+{
+	AddDependency(material->GetShader(), materialIndex);
+
+	for (int textureIndex = 0; textureIndex < MAX_TEXTURES_SAMPLERS; ++textureIndex)
+	{
+		const Texture* texture = material->GetTexture(textureIndex);
+
+		if (texture != nullptr)
+		{
+			AddDependency(texture, materialIndex);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the assets loaded from the file followed by their dependents breadth first, each once,
+// so a material always reloads after the shader it's rebuilt against
+//
+void AssetHotReloader::GetReloadOrder(const std::string& filepath, std::vector<int>& out_assetIndices)
+{
+	std::map<std::string, std::vector<int>>::iterator itr = s_fileAssets.find(NormalizePath(filepath));
+
+	if (itr == s_fileAssets.end())
+	{
+		return;
+	}
+
+	std::set<int> queuedIndices(itr->second.begin(), itr->second.end());
+	out_assetIndices.insert(out_assetIndices.end(), itr->second.begin(), itr->second.end());
+
+	for (size_t orderIndex = 0; orderIndex < out_assetIndices.size(); ++orderIndex)
+	{
+		const TrackedAsset_t& trackedAsset = s_assets[out_assetIndices[orderIndex]];
+
+		if (!DoesReloadAffectDependents(trackedAsset.type))
+		{
+			continue;
+		}
+
+		for (int dependentIndex : trackedAsset.dependentIndices)
+		{
+			if (queuedIndices.insert(dependentIndex).second)
+			{
+				out_assetIndices.push_back(dependentIndex);
+			}
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reloads the single asset in place, returning false if it failed or had to wait
+// Assets already loading are tried again once that load finishes, by re-reporting their file as changed
+//
+bool AssetHotReloader::ReloadAsset(int assetIndex)
+{
+	// Copied, since reloading can track new assets and grow the list
+	TrackedAsset_t trackedAsset = s_assets[assetIndex];
+
+	if (trackedAsset.asset != nullptr && AssetDB::IsAsyncLoadPending(trackedAsset.asset))
+	{
+		AddChangedFile(trackedAsset.filepath);
+		return false;
+	}
+
+	// Evicted assets read the file again when they're next acquired anyway
+	if (trackedAsset.asset != nullptr && !AssetResidency::IsResident(trackedAsset.asset))
+	{
+		return false;
+	}
+
+	switch (trackedAsset.type)
+	{
+	case HOT_RELOAD_ASSET_TEXTURE:
+		AssetDB::ReloadTextureAsync((Texture*) trackedAsset.asset, trackedAsset.filepath, trackedAsset.generateMipMaps);
+		break;
+	case HOT_RELOAD_ASSET_MESH:
+		AssetDB::ReloadMeshAsync((Mesh*) trackedAsset.asset, trackedAsset.filepath);
+		break;
+	case HOT_RELOAD_ASSET_MESH_GROUP:
+		AssetDB::ReloadMeshGroupAsync((MeshGroup*) trackedAsset.asset, trackedAsset.filepath);
+		break;
+	case HOT_RELOAD_ASSET_SHADER:
+	{
+		// Compiles here, GL programs can only be built on the main thread
+		Shader* shader = (Shader*) trackedAsset.asset;
+		if (!shader->LoadFromFile(trackedAsset.filepath))
+		{
+			return false;
+		}
+
+		AddShaderFiles(assetIndex, shader);
+	}
+		break;
+	case HOT_RELOAD_ASSET_MATERIAL:
+	{
+		Material* material = (Material*) trackedAsset.asset;
+		if (!material->ReloadFromFile(trackedAsset.filepath))
+		{
+			return false;
+		}
+
+		AddMaterialDependencies(assetIndex, material);
+	}
+		break;
+	case HOT_RELOAD_ASSET_COOK_SOURCE:
+		QueueCook(trackedAsset);
+		break;
+	default:
+		ERROR_AND_DIE(Stringf("Error: AssetHotReloader::ReloadAsset() has no reload for \"%s\"", trackedAsset.filepath.c_str()));
+		break;
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Cooks the source again on a disk worker; writing the output is itself a change the watcher sees,
+// which reloads whatever was loaded from it
+//
+void AssetHotReloader::QueueCook(const TrackedAsset_t& cookSource)
+{
+	HotReloadCookRequest_t* request = new HotReloadCookRequest_t();
+	request->sourcePath = cookSource.filepath;
+	request->outputPath = cookSource.cookOutputPath;
+	request->isObj = cookSource.isCookedFromObj;
+
+	auto cook = [request]()
+	{
+		if (request->isObj)
+		{
+			AssetCooker::CookObj(request->sourcePath, request->outputPath);
+		}
+		else
+		{
+			AssetCooker::CookModel(request->sourcePath, request->outputPath);
+		}
+
+		delete request;
+	};
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+
+	if (jobSystem != nullptr)
+	{
+		jobSystem->QueueJob(new FunctionJob(cook, JOB_PRIORITY_BACKGROUND, WORKER_FLAGS_DISK));
+	}
+	else
+	{
+		cook();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the assets built using one of this type need rebuilding when it reloads
+// Textures and meshes are swapped in place, so anything pointing at them just sees the new data;
+// materials made their property blocks from their shader's layout, which may have changed
+//
+bool AssetHotReloader::DoesReloadAffectDependents(eHotReloadAssetType type)
+{
+	return (type == HOT_RELOAD_ASSET_SHADER);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records the file as changed now, restarting its settle time; called from the watcher thread
+//
+void AssetHotReloader::AddChangedFile(const std::string& filepath)
+{
+	std::lock_guard<std::mutex> lock(s_changeLock);
+	s_changedFiles[filepath] = GetPerformanceCounter();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Watcher thread - waits on the OS for changes under the watch directory and records them
+// Wakes up regularly to see if it's been shut down, since the wait can't otherwise be interrupted
+//
+void AssetHotReloader::WatchThreadEntry(void* params)
+{
+	UNUSED(params);
+
+	HANDLE directoryHandle = CreateFileA(HOT_RELOAD_WATCH_DIRECTORY, FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+
+	if (directoryHandle == INVALID_HANDLE_VALUE)
+	{
+		LogTaggedPrintf("ASSETS", "Error: AssetHotReloader couldn't watch \"%s\"", HOT_RELOAD_WATCH_DIRECTORY);
+		s_isWatching = false;
+		return;
+	}
+
+	OVERLAPPED overlapped = {};
+	overlapped.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+
+	DWORD* notifyBuffer = (DWORD*) malloc(HOT_RELOAD_NOTIFY_BUFFER_SIZE);	// FILE_NOTIFY_INFORMATION needs DWORD alignment
+	DWORD notifyFilter = FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE;
+
+	while (s_isWatching)
+	{
+		ResetEvent(overlapped.hEvent);
+
+		if (!ReadDirectoryChangesW(directoryHandle, notifyBuffer, HOT_RELOAD_NOTIFY_BUFFER_SIZE, TRUE, notifyFilter, nullptr, &overlapped, nullptr))
+		{
+			LogTaggedPrintf("ASSETS", "Error: AssetHotReloader stopped watching \"%s\", error %u", HOT_RELOAD_WATCH_DIRECTORY, (unsigned int) GetLastError());
+			break;
+		}
+
+		while (s_isWatching && WaitForSingleObject(overlapped.hEvent, 100) == WAIT_TIMEOUT) {}
+
+		DWORD byteCount = 0;
+		if (!s_isWatching)
+		{
+			CancelIo(directoryHandle);
+			GetOverlappedResult(directoryHandle, &overlapped, &byteCount, TRUE);
+			break;
+		}
+
+		if (!GetOverlappedResult(directoryHandle, &overlapped, &byteCount, FALSE))
+		{
+			continue;
+		}
+
+		// Too many changes at once to fit in the buffer, so the OS reported none of them
+		if (byteCount == 0)
+		{
+			LogTaggedPrintf("ASSETS", "Warning: AssetHotReloader missed a batch of changes, use reload_asset for anything that didn't reload");
+			continue;
+		}
+
+		const uint8_t* currentEntry = (const uint8_t*) notifyBuffer;
+
+		while (true)
+		{
+			const FILE_NOTIFY_INFORMATION* notifyInfo = (const FILE_NOTIFY_INFORMATION*) currentEntry;
+
+			// Saves through a temporary file end in a rename, and deletes have nothing to reload
+			if (notifyInfo->Action == FILE_ACTION_MODIFIED || notifyInfo->Action == FILE_ACTION_ADDED || notifyInfo->Action == FILE_ACTION_RENAMED_NEW_NAME)
+			{
+				int wideLength = (int) (notifyInfo->FileNameLength / sizeof(WCHAR));
+				char relativePath[MAX_PATH];
+				int pathLength = WideCharToMultiByte(CP_UTF8, 0, notifyInfo->FileName, wideLength, relativePath, MAX_PATH - 1, nullptr, nullptr);
+
+				if (pathLength > 0)
+				{
+					AddChangedFile(NormalizePath(std::string(HOT_RELOAD_WATCH_DIRECTORY) + "/" + std::string(relativePath, pathLength)));
+				}
+			}
+
+			if (notifyInfo->NextEntryOffset == 0)
+			{
+				break;
+			}
+
+			currentEntry += notifyInfo->NextEntryOffset;
+		}
+	}
+
+	free(notifyBuffer);
+	CloseHandle(overlapped.hEvent);
+	CloseHandle(directoryHandle);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the path as it's keyed in the graph - lower case with forward slashes, since the OS reports
+// paths however it likes and matches them case insensitively
+//
+std::string AssetHotReloader::NormalizePath(const std::string& filepath)
+{
+	std::string normalizedPath = filepath;
+
+	for (size_t charIndex = 0; charIndex < normalizedPath.size(); ++charIndex)
+	{
+		char currentChar = normalizedPath[charIndex];
+		normalizedPath[charIndex] = (currentChar == '\\' ? '/' : (char) tolower((unsigned char) currentChar));
+	}
+
+	while (normalizedPath.compare(0, 2, "./") == 0)
+	{
+		normalizedPath.erase(0, 2);
+	}
+
+	return normalizedPath;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Command for starting or stopping the watcher
+//
+void Command_HotReload(Command& cmd)
+{
+	bool shouldWatch = true;
+	cmd.GetParam("e", shouldWatch, &shouldWatch);
+
+	if (shouldWatch)
+	{
+		AssetHotReloader::Initialize();
+		ConsolePrintf(Rgba::GREEN, "Hot reloading assets in \"%s\"", HOT_RELOAD_WATCH_DIRECTORY);
+	}
+	else
+	{
+		AssetHotReloader::Shutdown();
+		ConsolePrintf(Rgba::GREEN, "Hot reloading stopped");
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Command for reloading a file by hand, whether or not it's being watched
+//
+void Command_ReloadAsset(Command& cmd)
+{
+	std::string filepath;
+	if (!cmd.GetParam("f", filepath))
+	{
+		ConsoleErrorf("No file specified, use -f");
+		return;
+	}
+
+	int reloadCount = AssetHotReloader::ReloadFile(filepath);
+
+	if (reloadCount > 0)
+	{
+		ConsolePrintf(Rgba::GREEN, "Reloaded %i assets from \"%s\"", reloadCount, filepath.c_str());
+	}
+	else
+	{
+		ConsoleWarningf("Nothing reloaded from \"%s\", it may not be loaded or is still loading", filepath.c_str());
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Command for listing what a change to a file would reload
+//
+void Command_AssetDependents(Command& cmd)
+{
+	std::string filepath;
+	if (!cmd.GetParam("f", filepath))
+	{
+		ConsoleErrorf("No file specified, use -f");
+		return;
+	}
+
+	std::vector<std::string> reloadPaths;
+	AssetHotReloader::GetReloadFilePaths(filepath, reloadPaths);
+
+	if (reloadPaths.size() == 0)
+	{
+		ConsoleWarningf("No loaded assets come from \"%s\"", filepath.c_str());
+		return;
+	}
+
+	ConsolePrintf(Rgba::GREEN, "A change to \"%s\" reloads:", filepath.c_str());
+
+	for (const std::string& reloadPath : reloadPaths)
+	{
+		ConsolePrintf(Rgba::GREEN, "  %s", reloadPath.c_str());
+	}
+}
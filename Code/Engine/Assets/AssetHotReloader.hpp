@@ -0,0 +1,126 @@
+/************************************************************************/
+/* File: AssetHotReloader.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Watches the data directory on its own thread and reloads
+/*				only the assets built from files that changed, plus the
+/*				assets depending on them (material -> shader, textures)
+/************************************************************************/
+#pragma once
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "Engine/Core/Threading/Threading.hpp"
+
+class Mesh;
+class Shader;
+class Texture;
+class Material;
+class MeshGroup;
+
+// Watched recursively, relative to the working directory; assets loaded from elsewhere are only reloaded by command
+#define HOT_RELOAD_WATCH_DIRECTORY "Data"
+
+// Editors save in several writes, so a file is only reloaded once it's gone this long without changing
+#define HOT_RELOAD_SETTLE_SECONDS (0.25)
+
+enum eHotReloadAssetType
+{
+	HOT_RELOAD_ASSET_TEXTURE,
+	HOT_RELOAD_ASSET_MESH,
+	HOT_RELOAD_ASSET_MESH_GROUP,
+	HOT_RELOAD_ASSET_SHADER,
+	HOT_RELOAD_ASSET_MATERIAL,
+	HOT_RELOAD_ASSET_COOK_SOURCE,	// A source model that's cooked again when it changes - its output then reloads on its own
+	NUM_HOT_RELOAD_ASSET_TYPES
+};
+
+
+class AssetHotReloader
+{
+public:
+	//-----Public Methods-----
+
+	// Starts and stops the watcher thread, tracking happens either way so it can be started whenever
+	static void Initialize();
+	static void Shutdown();
+	static bool IsWatching();
+
+	static void InitializeConsoleCommands();
+
+	// Main thread, called by the Renderer at the start of each frame before async loads are finalized
+	// Texture and mesh reloads are decoded on the disk workers and swapped in by AssetDB::FinalizeAsyncLoads(),
+	// while shaders and materials reload here since they need the GL context
+	static void Update();
+
+	// Recording the graph, called by the AssetDB and the cook commands as assets are made; main thread only
+	static void TrackTexture(const std::string& filepath, Texture* texture, bool generateMipMaps);
+	static void TrackMesh(const std::string& filepath, Mesh* mesh);
+	static void TrackMeshGroup(const std::string& filepath, MeshGroup* meshGroup);
+	static void TrackShader(const std::string& filepath, Shader* shader);
+	static void TrackMaterial(const std::string& filepath, Material* material);
+	static void TrackCookSource(const std::string& sourcePath, const std::string& outputPath, bool isObj);
+
+	// Reloads everything loaded from the file and what depends on it, returning how many assets that was
+	static int	ReloadFile(const std::string& filepath);
+
+	// Returns the files of every asset that ReloadFile() would reload, in the order it would
+	static void	GetReloadFilePaths(const std::string& filepath, std::vector<std::string>& out_filepaths);
+
+
+private:
+	//-----Private Types-----
+
+	struct TrackedAsset_t
+	{
+		eHotReloadAssetType	type = NUM_HOT_RELOAD_ASSET_TYPES;
+		void*				asset = nullptr;		// Null for cook sources
+		std::string			filepath;				// File it's loaded from, the .shader for shaders
+		std::string			cookOutputPath;			// Cook sources only
+		bool				isCookedFromObj = false;
+		bool				generateMipMaps = false;	// Textures only
+		std::vector<int>	dependentIndices;		// Assets built using this one
+	};
+
+
+private:
+	//-----Private Methods-----
+
+	AssetHotReloader() {}
+
+	static int			AddTrackedAsset(eHotReloadAssetType type, void* asset, const std::string& filepath);
+	static void			AddFileForAsset(const std::string& filepath, int assetIndex);
+	static void			AddDependency(const void* dependency, int dependentIndex);
+	static void			AddShaderFiles(int shaderIndex, const Shader* shader);
+	static void			AddMaterialDependencies(int materialIndex, const Material* material);
+
+	static void			GetReloadOrder(const std::string& filepath, std::vector<int>& out_assetIndices);
+	static bool			ReloadAsset(int assetIndex);
+	static void			QueueCook(const TrackedAsset_t& cookSource);
+	static bool			DoesReloadAffectDependents(eHotReloadAssetType type);
+
+	static void			AddChangedFile(const std::string& filepath);
+	static void			WatchThreadEntry(void* params);
+
+	static std::string	NormalizePath(const std::string& filepath);
+
+
+private:
+	//-----Private Data-----
+
+	// The graph, main thread only; assets are never unloaded, so indices stay valid
+	static std::vector<TrackedAsset_t>				s_assets;
+	static std::map<const void*, int>				s_assetIndices;
+	static std::map<std::string, std::vector<int>>	s_fileAssets;	// Normalized path to the assets loaded from it
+
+	// Written by the watcher thread, paths mapped to when they last changed
+	static std::mutex								s_changeLock;
+	static std::map<std::string, uint64_t>			s_changedFiles;
+
+	static std::atomic<bool>						s_isWatching;
+	static ThreadHandle_t							s_watchThread;
+
+};
@@ -0,0 +1,340 @@
+/************************************************************************/
+/* File: AssetLoadJob.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the AssetLoadJob classes
+/************************************************************************/
+#include "Engine/Core/File.hpp"
+#include "Engine/Core/Image.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Assets/AssetLoadJob.hpp"
+#include "Engine/Assets/CookedMeshFile.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/Meshes/Mesh.hpp"
+#include "Engine/Core/JobSystem/JobSystem.hpp"
+#include "Engine/Core/Time/ProfileScoped.hpp"
+#include "Engine/Core/Time/ProfileCounters.hpp"
+#include "Engine/Rendering/Resources/Texture.hpp"
+#include "Engine/Rendering/Meshes/MeshBuilder.hpp"
+#include "Engine/Core/DeveloperConsole/DevConsole.hpp"
+#include "Engine/Rendering/Resources/CompressedImage.hpp"
+#include "Engine/Rendering/Buffers/GPUUploadQueue.hpp"
+#include "Engine/Rendering/Meshes/MeshGroupBuilder.hpp"
+#include "ThirdParty/stb/stb_image.h"
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - asset loads only run on the disk workers
+//
+AssetLoadJob::AssetLoadJob(const std::string& filepath, const void* asset, JobPriority priority)
+	: m_filepath(filepath)
+	, m_asset(asset)
+{
+	m_jobType = ASSET_LOAD_JOB_TYPE;
+	m_jobFlags = WORKER_FLAGS_DISK;
+	m_priority = priority;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads and decodes the file on the disk worker
+//
+void AssetLoadJob::Execute()
+{
+	PROFILE_SCOPE_CATEGORY("AssetLoadJob::Execute", "Assets");
+	m_wasDecoded = Decode();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Uploads the decoded data into the asset and calls back everyone waiting on it, on the main thread
+// A failed load leaves the placeholder in place, since the asset has already been handed out
+//
+void AssetLoadJob::Finalize()
+{
+	PROFILE_SCOPE_CATEGORY("AssetLoadJob::Finalize", "Assets");
+
+	if (m_wasDecoded)
+	{
+		Upload();
+		PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_ASSETS_LOADED);
+	}
+	else
+	{
+		LogTaggedPrintf("ASSETS", "Warning: Couldn't load \"%s\", it will keep its placeholder", m_filepath.c_str());
+		ConsoleWarningf("Couldn't load \"%s\", it will keep its placeholder", m_filepath.c_str());
+	}
+
+	// No longer pending by the time the callbacks run, so they can queue loads for the same asset
+	AssetDB::OnAsyncLoadFinished(this);
+
+	int numCallbacks = (int) m_callbacks.size();
+	for (int callbackIndex = 0; callbackIndex < numCallbacks; ++callbackIndex)
+	{
+		m_callbacks[callbackIndex].callback(m_filepath, m_wasDecoded, m_callbacks[callbackIndex].userData);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a callback to call once the load finishes; main thread only
+//
+void AssetLoadJob::AddCallback(AssetLoadedCallback callback, void* userData)
+{
+	AssetLoadedCallback_t entry;
+	entry.callback = callback;
+	entry.userData = userData;
+
+	m_callbacks.push_back(entry);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+TextureLoadJob::TextureLoadJob(const std::string& filepath, Texture* texture, bool generateMipMaps, JobPriority priority)
+	: AssetLoadJob(filepath, texture, priority)
+	, m_texture(texture)
+	, m_generateMipMaps(generateMipMaps)
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor - the decoded image isn't kept once it's on the GPU
+//
+TextureLoadJob::~TextureLoadJob()
+{
+	if (m_image != nullptr)
+	{
+		delete m_image;
+		m_image = nullptr;
+	}
+
+	if (m_compressedImage != nullptr)
+	{
+		delete m_compressedImage;
+		m_compressedImage = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Decodes the image and flips it for the GPU
+// Uses stb directly instead of Image::LoadFromFile(), which reports errors to the console
+// Compressed files are only mapped, and decode their fallback source image instead if they're unreadable
+//
+bool TextureLoadJob::Decode()
+{
+	std::string imagePath = GetFilePath();
+
+	if (CompressedImage::IsCompressedImagePath(imagePath))
+	{
+		m_compressedImage = new CompressedImage();
+
+		if (m_compressedImage->LoadFromFile(imagePath))
+		{
+			return true;
+		}
+
+		delete m_compressedImage;
+		m_compressedImage = nullptr;
+
+		imagePath = CompressedImage::GetFallbackImagePath(imagePath);
+
+		if (imagePath.size() == 0)
+		{
+			return false;
+		}
+
+		LogTaggedPrintf("ASSETS", "Warning: TextureLoadJob couldn't use \"%s\", falling back to \"%s\"", GetFilePath().c_str(), imagePath.c_str());
+	}
+
+	// Through File so packed images are found, and mapped so there's no read copy for stb to decode from
+	File file;
+	if (!file.OpenMapped(imagePath.c_str()))
+	{
+		return false;
+	}
+
+	IntVector2 dimensions;
+	int numComponents = 0;
+	unsigned char* imageData = stbi_load_from_memory((const stbi_uc*) file.GetData(), (int) file.GetSize(), &dimensions.x, &dimensions.y, &numComponents, 0);
+	file.Close();
+
+	if (imageData == nullptr)
+	{
+		return false;
+	}
+
+	m_image = new Image(dimensions, numComponents, imageData);
+
+	if (!m_image->IsFlippedForTextures())
+	{
+		m_image->FlipVertical();
+	}
+
+	// Drivers store RGB8 as RGBA8 anyway, and would otherwise expand it on the main thread during the upload
+	if (m_image->GetNumComponentsPerTexel() == 3)
+	{
+		m_image->ConvertToRGBA();
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Replaces the placeholder texels with the image's
+// If the GPU can't sample the compressed format, its fallback image is loaded here instead
+//
+void TextureLoadJob::Upload()
+{
+	if (m_compressedImage != nullptr)
+	{
+		if (!m_texture->CreateFromCompressedImage(m_compressedImage))
+		{
+			std::string fallbackPath = CompressedImage::GetFallbackImagePath(GetFilePath());
+
+			if (fallbackPath.size() > 0)
+			{
+				LogTaggedPrintf("ASSETS", "Warning: TextureLoadJob's GPU can't sample \"%s\", falling back to \"%s\"", GetFilePath().c_str(), fallbackPath.c_str());
+				m_texture->CreateFromFile(fallbackPath, m_generateMipMaps);
+			}
+			else
+			{
+				LogTaggedPrintf("ASSETS", "Error: TextureLoadJob's GPU can't sample \"%s\", and it has no source image to fall back to", GetFilePath().c_str());
+			}
+		}
+
+		return;
+	}
+
+	// Queued rather than uploaded here, so a large image is spread across frames; the texture
+	// keeps its placeholder until the last of it lands
+	GPUUploadQueue::QueueTextureUpload(m_texture, m_image->GetTexelDimensions(), m_image->GetNumComponentsPerTexel(), m_image->GetImageData(), m_generateMipMaps);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+MeshLoadJob::MeshLoadJob(const std::string& filepath, Mesh* mesh, JobPriority priority)
+	: AssetLoadJob(filepath, mesh, priority)
+	, m_mesh(mesh)
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+MeshLoadJob::~MeshLoadJob()
+{
+	if (m_meshBuilder != nullptr)
+	{
+		delete m_meshBuilder;
+		m_meshBuilder = nullptr;
+	}
+
+	if (m_cookedFile != nullptr)
+	{
+		delete m_cookedFile;
+		m_cookedFile = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Parses the obj file into a builder, or reads the cooked file as it is
+//
+bool MeshLoadJob::Decode()
+{
+	if (CookedMeshFile::IsCookedMeshPath(GetFilePath()))
+	{
+		m_cookedFile = new CookedMeshFile();
+		return (m_cookedFile->LoadFromFile(GetFilePath()) && m_cookedFile->GetMeshCount() > 0);
+	}
+
+	m_meshBuilder = new MeshBuilder();
+	m_meshBuilder->LoadFromObjFile(GetFilePath());
+
+	return (m_meshBuilder->GetVertexCount() > 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Replaces the placeholder geometry with the file's
+//
+void MeshLoadJob::Upload()
+{
+	if (m_cookedFile != nullptr)
+	{
+		m_cookedFile->UpdateMesh(0, *m_mesh);
+		return;
+	}
+
+	m_meshBuilder->UpdateMesh(*m_mesh);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+MeshGroupLoadJob::MeshGroupLoadJob(const std::string& filepath, MeshGroup* meshGroup, JobPriority priority)
+	: AssetLoadJob(filepath, meshGroup, priority)
+	, m_meshGroup(meshGroup)
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+MeshGroupLoadJob::~MeshGroupLoadJob()
+{
+	if (m_meshGroupBuilder != nullptr)
+	{
+		delete m_meshGroupBuilder;
+		m_meshGroupBuilder = nullptr;
+	}
+
+	if (m_cookedFile != nullptr)
+	{
+		delete m_cookedFile;
+		m_cookedFile = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Parses the obj file into a builder per material, or reads the cooked file as it is
+//
+bool MeshGroupLoadJob::Decode()
+{
+	if (CookedMeshFile::IsCookedMeshPath(GetFilePath()))
+	{
+		m_cookedFile = new CookedMeshFile();
+		return (m_cookedFile->LoadFromFile(GetFilePath()) && m_cookedFile->GetMeshCount() > 0);
+	}
+
+	m_meshGroupBuilder = new MeshGroupBuilder();
+	m_meshGroupBuilder->LoadFromObjFile(GetFilePath());
+
+	return (m_meshGroupBuilder->GetMeshCount() > 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Replaces the placeholder meshes with the file's, reusing the placeholder's mesh for the first
+//
+void MeshGroupLoadJob::Upload()
+{
+	if (m_cookedFile != nullptr)
+	{
+		m_cookedFile->UpdateMeshGroup(*m_meshGroup);
+		return;
+	}
+
+	m_meshGroupBuilder->UpdateMeshGroup(*m_meshGroup);
+}
@@ -0,0 +1,144 @@
+/************************************************************************/
+/* File: AssetLoadJob.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Jobs for the AssetDB's async loads - each decodes its file
+/*				on a disk worker, then uploads into the placeholder asset
+/*				it was given when finalized on the main thread
+/************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include "Engine/Assets/AssetDB.hpp"
+#include "Engine/Core/JobSystem/Job.hpp"
+
+// Job type of every AssetLoadJob, so the AssetDB only finalizes its own
+#define ASSET_LOAD_JOB_TYPE (0x41444221)
+
+class Image;
+class CompressedImage;
+class MeshBuilder;
+class MeshGroupBuilder;
+class CookedMeshFile;
+
+struct AssetLoadedCallback_t
+{
+	AssetLoadedCallback	callback = nullptr;
+	void*				userData = nullptr;
+};
+
+
+class AssetLoadJob : public Job
+{
+public:
+	//-----Public Methods-----
+
+	AssetLoadJob(const std::string& filepath, const void* asset, JobPriority priority);
+
+	virtual void		Execute() override;		// Disk worker
+	virtual void		Finalize() override;	// Main thread
+
+	void				AddCallback(AssetLoadedCallback callback, void* userData);
+
+	const std::string&	GetFilePath() const { return m_filepath; }
+	const void*			GetAsset() const { return m_asset; }
+
+
+protected:
+	//-----Protected Methods-----
+
+	// Reads and decodes the file without touching the GPU or the AssetDB, returning false on failure
+	virtual bool		Decode() = 0;
+
+	// Puts the decoded data into the asset, only called if Decode() succeeded
+	virtual void		Upload() = 0;
+
+
+private:
+	//-----Private Data-----
+
+	std::string							m_filepath;
+	const void*							m_asset = nullptr;
+	bool								m_wasDecoded = false;
+	std::vector<AssetLoadedCallback_t>	m_callbacks;
+
+};
+
+
+class TextureLoadJob : public AssetLoadJob
+{
+public:
+	//-----Public Methods-----
+
+	TextureLoadJob(const std::string& filepath, Texture* texture, bool generateMipMaps, JobPriority priority);
+	virtual ~TextureLoadJob();
+
+
+protected:
+	//-----Protected Methods-----
+
+	virtual bool	Decode() override;
+	virtual void	Upload() override;
+
+
+private:
+	//-----Private Data-----
+
+	Texture*			m_texture = nullptr;
+	Image*				m_image = nullptr;
+	CompressedImage*	m_compressedImage = nullptr;
+	bool				m_generateMipMaps = false;
+
+};
+
+
+class MeshLoadJob : public AssetLoadJob
+{
+public:
+	//-----Public Methods-----
+
+	MeshLoadJob(const std::string& filepath, Mesh* mesh, JobPriority priority);
+	virtual ~MeshLoadJob();
+
+
+protected:
+	//-----Protected Methods-----
+
+	virtual bool	Decode() override;
+	virtual void	Upload() override;
+
+
+private:
+	//-----Private Data-----
+
+	Mesh*			m_mesh = nullptr;
+	MeshBuilder*	m_meshBuilder = nullptr;
+	CookedMeshFile*	m_cookedFile = nullptr;		// Used instead of the builder for .cmesh files
+
+};
+
+
+class MeshGroupLoadJob : public AssetLoadJob
+{
+public:
+	//-----Public Methods-----
+
+	MeshGroupLoadJob(const std::string& filepath, MeshGroup* meshGroup, JobPriority priority);
+	virtual ~MeshGroupLoadJob();
+
+
+protected:
+	//-----Protected Methods-----
+
+	virtual bool	Decode() override;
+	virtual void	Upload() override;
+
+
+private:
+	//-----Private Data-----
+
+	MeshGroup*			m_meshGroup = nullptr;
+	MeshGroupBuilder*	m_meshGroupBuilder = nullptr;
+	CookedMeshFile*		m_cookedFile = nullptr;		// Used instead of the builder for .cmesh files
+
+};
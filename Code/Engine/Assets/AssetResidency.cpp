@@ -0,0 +1,560 @@
+/************************************************************************/
+/* File: AssetResidency.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the AssetResidency class
+/************************************************************************/
+#include <algorithm>
+#include "Engine/Core/Image.hpp"
+#include "Engine/Assets/AssetDB.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/Meshes/Mesh.hpp"
+#include "Engine/Assets/AssetResidency.hpp"
+#include "Engine/Rendering/Meshes/MeshGroup.hpp"
+#include "Engine/Rendering/Resources/Texture.hpp"
+#include "Engine/Rendering/Meshes/MeshBuilder.hpp"
+#include "Engine/Rendering/Buffers/GPUUploadQueue.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
+#include "Engine/Core/DeveloperConsole/Command.hpp"
+#include "Engine/Core/DeveloperConsole/DevConsole.hpp"
+
+std::vector<AssetResidency::ResidentAsset_t>	AssetResidency::s_assets;
+std::map<const void*, int>						AssetResidency::s_assetIndices;
+uint64_t										AssetResidency::s_frameNumber = 0;
+
+size_t AssetResidency::s_budgets[NUM_RESIDENCY_CATEGORIES] =
+{
+	RESIDENCY_DEFAULT_TEXTURE_BUDGET_BYTES,
+	RESIDENCY_DEFAULT_MESH_BUDGET_BYTES,
+	RESIDENCY_DEFAULT_IMAGE_BUDGET_BYTES
+};
+
+const char* g_residencyCategoryNames[NUM_RESIDENCY_CATEGORIES] =
+{
+	"texture",
+	"mesh",
+	"image"
+};
+
+// C functions
+void Command_Residency(Command& cmd);
+void Command_ResidencyBudget(Command& cmd);
+static float ToMegabytes(size_t byteCount);
+
+
+//-----------------------------------------------------------------------------------------------
+// Registers the residency commands
+//
+void AssetResidency::InitializeConsoleCommands()
+{
+	Command::Register("residency",			"Prints each asset category's memory against its budget. Params: c=category to list the assets of",	Command_Residency);
+	Command::Register("residency_budget",	"Sets an asset category's memory budget. Params: c=category (texture, mesh, image), mb=megabytes",		Command_ResidencyBudget);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Refreshes every asset's size and evicts from the categories over budget
+// Sizes are taken each frame since async loads and hot reloads change them without telling anyone
+//
+void AssetResidency::Update()
+{
+	PROFILE_SCOPE_CATEGORY("AssetResidency::Update", "Assets");
+
+	s_frameNumber++;
+
+	int numAssets = (int) s_assets.size();
+	for (int assetIndex = 0; assetIndex < numAssets; ++assetIndex)
+	{
+		ResidentAsset_t& residentAsset = s_assets[assetIndex];
+		residentAsset.byteCount = (residentAsset.isResident ? CalculateByteCount(residentAsset) : 0);
+	}
+
+	for (int categoryIndex = 0; categoryIndex < NUM_RESIDENCY_CATEGORIES; ++categoryIndex)
+	{
+		EnforceBudget((eResidencyCategory) categoryIndex);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts tracking an asset loaded from file, does nothing if it's already tracked
+//
+void AssetResidency::Track(eResidencyAssetType type, void* asset, const std::string& filepath, bool generateMipMaps /*= false*/)
+{
+	if (s_assetIndices.find(asset) != s_assetIndices.end())
+	{
+		return;
+	}
+
+	ResidentAsset_t residentAsset;
+	residentAsset.type = type;
+	residentAsset.asset = asset;
+	residentAsset.filepath = filepath;
+	residentAsset.generateMipMaps = generateMipMaps;
+	residentAsset.lastUsedFrame = s_frameNumber;
+
+	s_assetIndices[asset] = (int) s_assets.size();
+	s_assets.push_back(residentAsset);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets whether the asset can ever be evicted, ignoring assets that aren't tracked
+// Pinning an evicted asset reloads it, since nothing would bring it back otherwise
+//
+void AssetResidency::SetPinned(const void* asset, bool isPinned)
+{
+	ResidentAsset_t* residentAsset = GetResidentAsset(asset);
+
+	if (residentAsset == nullptr)
+	{
+		return;
+	}
+
+	residentAsset->isPinned = isPinned;
+
+	if (isPinned && !residentAsset->isResident)
+	{
+		Restore(*residentAsset);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a reference to the asset, queueing a reload if it had been evicted
+// Untracked assets (built in, or made in code) are never evicted, so there's nothing to count
+//
+void AssetResidency::AddReference(const void* asset)
+{
+	ResidentAsset_t* residentAsset = GetResidentAsset(asset);
+
+	if (residentAsset == nullptr)
+	{
+		return;
+	}
+
+	residentAsset->referenceCount++;
+	residentAsset->lastUsedFrame = s_frameNumber;
+
+	if (!residentAsset->isResident)
+	{
+		Restore(*residentAsset);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes a reference to the asset, which becomes evictable once none are left
+//
+void AssetResidency::RemoveReference(const void* asset)
+{
+	ResidentAsset_t* residentAsset = GetResidentAsset(asset);
+
+	if (residentAsset == nullptr)
+	{
+		return;
+	}
+
+	ASSERT_OR_DIE(residentAsset->referenceCount > 0, Stringf("Error: AssetResidency::RemoveReference called on \"%s\" with no references", residentAsset->filepath.c_str()));
+
+	residentAsset->referenceCount--;
+	residentAsset->lastUsedFrame = s_frameNumber;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the asset holds its loaded data rather than a placeholder, or isn't tracked
+// Assets being restored count as resident, their reload is already on its way
+//
+bool AssetResidency::IsResident(const void* asset)
+{
+	ResidentAsset_t* residentAsset = GetResidentAsset(asset);
+
+	return (residentAsset == nullptr || residentAsset->isResident);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the category's budget, enforced on the next Update()
+//
+void AssetResidency::SetBudget(eResidencyCategory category, size_t byteCount)
+{
+	s_budgets[category] = byteCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the category's budget in bytes
+//
+size_t AssetResidency::GetBudget(eResidencyCategory category)
+{
+	return s_budgets[category];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns how many bytes the category's resident assets took as of the last Update()
+//
+size_t AssetResidency::GetResidentByteCount(eResidencyCategory category)
+{
+	size_t byteCount = 0;
+
+	for (const ResidentAsset_t& residentAsset : s_assets)
+	{
+		if (GetCategoryForType(residentAsset.type) == category)
+		{
+			byteCount += residentAsset.byteCount;
+		}
+	}
+
+	return byteCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the name of the category, as the console commands take it
+//
+const char* AssetResidency::GetCategoryName(eResidencyCategory category)
+{
+	return g_residencyCategoryNames[category];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds the category with the given name, returning false if there isn't one
+//
+bool AssetResidency::GetCategoryFromName(const std::string& name, eResidencyCategory& out_category)
+{
+	for (int categoryIndex = 0; categoryIndex < NUM_RESIDENCY_CATEGORIES; ++categoryIndex)
+	{
+		if (name == g_residencyCategoryNames[categoryIndex])
+		{
+			out_category = (eResidencyCategory) categoryIndex;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Prints the usage of each category, then lists the given one's assets largest first
+//
+void AssetResidency::PrintResidency(eResidencyCategory listCategory /*= NUM_RESIDENCY_CATEGORIES*/)
+{
+	for (int categoryIndex = 0; categoryIndex < NUM_RESIDENCY_CATEGORIES; ++categoryIndex)
+	{
+		eResidencyCategory category = (eResidencyCategory) categoryIndex;
+
+		int trackedCount = 0;
+		int residentCount = 0;
+		int referencedCount = 0;
+		int pinnedCount = 0;
+
+		for (const ResidentAsset_t& residentAsset : s_assets)
+		{
+			if (GetCategoryForType(residentAsset.type) == category)
+			{
+				trackedCount++;
+				residentCount	+= (residentAsset.isResident ? 1 : 0);
+				referencedCount	+= (residentAsset.referenceCount > 0 ? 1 : 0);
+				pinnedCount		+= (residentAsset.isPinned ? 1 : 0);
+			}
+		}
+
+		size_t byteCount = GetResidentByteCount(category);
+		Rgba color = (byteCount > s_budgets[category] ? Rgba::ORANGE : Rgba::GREEN);
+
+		ConsolePrintf(color, "%-8s %8.2f MB of %8.2f MB, %i of %i resident (%i referenced, %i pinned)",
+			g_residencyCategoryNames[category], ToMegabytes(byteCount), ToMegabytes(s_budgets[category]), residentCount, trackedCount, referencedCount, pinnedCount);
+	}
+
+	if (listCategory == NUM_RESIDENCY_CATEGORIES)
+	{
+		return;
+	}
+
+	std::vector<int> assetIndices;
+	for (int assetIndex = 0; assetIndex < (int) s_assets.size(); ++assetIndex)
+	{
+		if (GetCategoryForType(s_assets[assetIndex].type) == listCategory)
+		{
+			assetIndices.push_back(assetIndex);
+		}
+	}
+
+	std::sort(assetIndices.begin(), assetIndices.end(), [](int a, int b)
+	{
+		return s_assets[a].byteCount > s_assets[b].byteCount;
+	});
+
+	for (int assetIndex : assetIndices)
+	{
+		const ResidentAsset_t& residentAsset = s_assets[assetIndex];
+
+		const char* state = (residentAsset.isPinned ? "pinned" : (residentAsset.isResident ? "resident" : "evicted"));
+		ConsolePrintf(Rgba::WHITE, "  %8.2f MB  %-8s refs %-3i %s", ToMegabytes(residentAsset.byteCount), state, residentAsset.referenceCount, residentAsset.filepath.c_str());
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the entry for the asset, or nullptr if it isn't tracked
+//
+AssetResidency::ResidentAsset_t* AssetResidency::GetResidentAsset(const void* asset)
+{
+	std::map<const void*, int>::iterator itr = s_assetIndices.find(asset);
+
+	if (itr == s_assetIndices.end())
+	{
+		return nullptr;
+	}
+
+	return &s_assets[itr->second];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns how much memory the asset's data takes in its category
+//
+size_t AssetResidency::CalculateByteCount(const ResidentAsset_t& residentAsset)
+{
+	switch (residentAsset.type)
+	{
+	case RESIDENCY_ASSET_TEXTURE:
+		return ((const Texture*) residentAsset.asset)->GetGPUByteCount();
+	case RESIDENCY_ASSET_MESH:
+		return ((const Mesh*) residentAsset.asset)->GetGPUByteCount();
+	case RESIDENCY_ASSET_MESH_GROUP:
+	{
+		const MeshGroup* group = (const MeshGroup*) residentAsset.asset;
+		size_t byteCount = 0;
+
+		for (int meshIndex = 0; meshIndex < group->GetMeshCount(); ++meshIndex)
+		{
+			byteCount += group->GetMesh(meshIndex)->GetGPUByteCount();
+		}
+
+		return byteCount;
+	}
+	case RESIDENCY_ASSET_IMAGE:
+		return ((const Image*) residentAsset.asset)->GetByteCount();
+	default:
+		return 0;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Evicts the category's least recently used unreferenced assets until it's within budget
+// Assets still loading are skipped, their upload would put the data right back
+//
+void AssetResidency::EnforceBudget(eResidencyCategory category)
+{
+	size_t residentByteCount = GetResidentByteCount(category);
+
+	if (residentByteCount <= s_budgets[category])
+	{
+		return;
+	}
+
+	std::vector<int> candidateIndices;
+	for (int assetIndex = 0; assetIndex < (int) s_assets.size(); ++assetIndex)
+	{
+		const ResidentAsset_t& residentAsset = s_assets[assetIndex];
+
+		bool isEvictable = residentAsset.isResident && !residentAsset.isPinned && residentAsset.referenceCount == 0
+			&& GetCategoryForType(residentAsset.type) == category && !AssetDB::IsAsyncLoadPending(residentAsset.asset);
+
+		if (isEvictable)
+		{
+			candidateIndices.push_back(assetIndex);
+		}
+	}
+
+	std::sort(candidateIndices.begin(), candidateIndices.end(), [](int a, int b)
+	{
+		return s_assets[a].lastUsedFrame < s_assets[b].lastUsedFrame;
+	});
+
+	int evictedCount = 0;
+	size_t evictedByteCount = 0;
+
+	for (int assetIndex : candidateIndices)
+	{
+		if (residentByteCount <= s_budgets[category])
+		{
+			break;
+		}
+
+		ResidentAsset_t& residentAsset = s_assets[assetIndex];
+		residentByteCount -= residentAsset.byteCount;
+		evictedByteCount += residentAsset.byteCount;
+		evictedCount++;
+
+		Evict(residentAsset);
+	}
+
+	if (evictedCount > 0)
+	{
+		LogTaggedPrintf("ASSETS", "Evicted %i %s assets (%.2f MB) to stay within budget", evictedCount, g_residencyCategoryNames[category], ToMegabytes(evictedByteCount));
+	}
+
+	if (residentByteCount > s_budgets[category])
+	{
+		LogTaggedPrintf("ASSETS", "Warning: %s assets are %.2f MB over budget, but everything left is referenced or pinned",
+			g_residencyCategoryNames[category], ToMegabytes(residentByteCount - s_budgets[category]));
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Swaps the asset's data for its placeholder in place, so pointers and AssetIDs to it stay valid
+//
+void AssetResidency::Evict(ResidentAsset_t& residentAsset)
+{
+	switch (residentAsset.type)
+	{
+	case RESIDENCY_ASSET_TEXTURE:
+		((Texture*) residentAsset.asset)->CreateFromImage(&Image::IMAGE_DEFAULT_TEXTURE);
+		break;
+	case RESIDENCY_ASSET_MESH:
+	case RESIDENCY_ASSET_MESH_GROUP:
+	{
+		// Uploads still queued would otherwise land over the placeholder
+		GPUUploadQueue::CancelUploads(residentAsset.asset);
+
+		MeshBuilder mb;
+		mb.BeginBuilding(PRIMITIVE_TRIANGLES, true);
+		mb.PushCube(Vector3::ZERO, Vector3::ONES);
+		mb.FinishBuilding();
+
+		if (residentAsset.type == RESIDENCY_ASSET_MESH)
+		{
+			mb.UpdateMesh(*(Mesh*) residentAsset.asset);
+		}
+		else
+		{
+			// Every mesh gets the cube rather than being deleted, pointers taken from the group may still be around
+			MeshGroup* group = (MeshGroup*) residentAsset.asset;
+
+			for (int meshIndex = 0; meshIndex < group->GetMeshCount(); ++meshIndex)
+			{
+				mb.UpdateMesh(*group->GetMesh(meshIndex));
+			}
+		}
+	}
+		break;
+	case RESIDENCY_ASSET_IMAGE:
+		((Image*) residentAsset.asset)->Unload();
+		break;
+	default:
+		break;
+	}
+
+	residentAsset.isResident = false;
+	residentAsset.byteCount = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Loads an evicted asset's data back in, through the async loads for anything on the GPU
+// Images load right away, since they're read on the CPU by whoever acquired them
+//
+void AssetResidency::Restore(ResidentAsset_t& residentAsset)
+{
+	switch (residentAsset.type)
+	{
+	case RESIDENCY_ASSET_TEXTURE:
+		AssetDB::ReloadTextureAsync((Texture*) residentAsset.asset, residentAsset.filepath, residentAsset.generateMipMaps);
+		break;
+	case RESIDENCY_ASSET_MESH:
+		AssetDB::ReloadMeshAsync((Mesh*) residentAsset.asset, residentAsset.filepath);
+		break;
+	case RESIDENCY_ASSET_MESH_GROUP:
+		AssetDB::ReloadMeshGroupAsync((MeshGroup*) residentAsset.asset, residentAsset.filepath);
+		break;
+	case RESIDENCY_ASSET_IMAGE:
+		if (!((Image*) residentAsset.asset)->LoadFromFile(residentAsset.filepath))
+		{
+			LogTaggedPrintf("ASSETS", "Error: Couldn't reload evicted image \"%s\", it will stay empty", residentAsset.filepath.c_str());
+		}
+		break;
+	default:
+		break;
+	}
+
+	residentAsset.isResident = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the budget category the asset type counts against
+//
+eResidencyCategory AssetResidency::GetCategoryForType(eResidencyAssetType type)
+{
+	switch (type)
+	{
+	case RESIDENCY_ASSET_TEXTURE:		return RESIDENCY_CATEGORY_TEXTURE;
+	case RESIDENCY_ASSET_MESH:			return RESIDENCY_CATEGORY_MESH;
+	case RESIDENCY_ASSET_MESH_GROUP:	return RESIDENCY_CATEGORY_MESH;
+	case RESIDENCY_ASSET_IMAGE:			return RESIDENCY_CATEGORY_IMAGE;
+	default:
+		return NUM_RESIDENCY_CATEGORIES;
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the byte count in megabytes, for printing
+//
+static float ToMegabytes(size_t byteCount)
+{
+	return (float) byteCount / (1024.f * 1024.f);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Command for printing residency, optionally listing one category's assets
+//
+void Command_Residency(Command& cmd)
+{
+	std::string categoryName;
+	eResidencyCategory listCategory = NUM_RESIDENCY_CATEGORIES;
+
+	if (cmd.GetParam("c", categoryName) && !AssetResidency::GetCategoryFromName(categoryName, listCategory))
+	{
+		ConsoleErrorf("Unknown category \"%s\", use texture, mesh or image", categoryName.c_str());
+		return;
+	}
+
+	AssetResidency::PrintResidency(listCategory);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Command for changing a category's budget
+//
+void Command_ResidencyBudget(Command& cmd)
+{
+	std::string categoryName;
+	eResidencyCategory category;
+
+	if (!cmd.GetParam("c", categoryName) || !AssetResidency::GetCategoryFromName(categoryName, category))
+	{
+		ConsoleErrorf("No valid category specified, use -c with texture, mesh or image");
+		return;
+	}
+
+	float megabytes = 0.f;
+	if (!cmd.GetParam("mb", megabytes) || megabytes < 0.f)
+	{
+		ConsoleErrorf("No budget specified, use -mb");
+		return;
+	}
+
+	AssetResidency::SetBudget(category, (size_t) (megabytes * 1024.f * 1024.f));
+	ConsolePrintf(Rgba::GREEN, "%s budget set to %.2f MB", categoryName.c_str(), megabytes);
+}
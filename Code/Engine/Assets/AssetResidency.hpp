@@ -0,0 +1,185 @@
+/************************************************************************/
+/* File: AssetResidency.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Keeps the file-loaded textures, meshes and images within
+/*				per-category memory budgets, unloading the least recently
+/*				used ones that nothing holds a handle to
+/************************************************************************/
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+class Mesh;
+class Image;
+class Texture;
+class MeshGroup;
+
+// Defaults for each category's budget, changeable with SetBudget() or the residency_budget command
+#define RESIDENCY_DEFAULT_TEXTURE_BUDGET_BYTES	((size_t) 512 * 1024 * 1024)
+#define RESIDENCY_DEFAULT_MESH_BUDGET_BYTES		((size_t) 256 * 1024 * 1024)
+#define RESIDENCY_DEFAULT_IMAGE_BUDGET_BYTES	((size_t) 256 * 1024 * 1024)
+
+enum eResidencyCategory
+{
+	RESIDENCY_CATEGORY_TEXTURE,		// VRAM
+	RESIDENCY_CATEGORY_MESH,		// VRAM, mesh groups included
+	RESIDENCY_CATEGORY_IMAGE,		// RAM, CPU-side images kept by the AssetDB
+	NUM_RESIDENCY_CATEGORIES
+};
+
+enum eResidencyAssetType
+{
+	RESIDENCY_ASSET_TEXTURE,
+	RESIDENCY_ASSET_MESH,
+	RESIDENCY_ASSET_MESH_GROUP,
+	RESIDENCY_ASSET_IMAGE,
+	NUM_RESIDENCY_ASSET_TYPES
+};
+
+
+class AssetResidency
+{
+public:
+	//-----Public Methods-----
+
+	static void InitializeConsoleCommands();
+
+	// Main thread, called by the Renderer at the start of each frame after async loads are finalized
+	// Evicts unreferenced assets, least recently used first, from each category that's over budget
+	static void Update();
+
+	// Recording the assets, called by the AssetDB as they're made; main thread only
+	// Assets start pinned, since the raw pointer the AssetDB returns could be held anywhere
+	static void Track(eResidencyAssetType type, void* asset, const std::string& filepath, bool generateMipMaps = false);
+	static void SetPinned(const void* asset, bool isPinned);
+
+	// Called by AssetHandles; adding a reference to an evicted asset reloads it
+	static void AddReference(const void* asset);
+	static void RemoveReference(const void* asset);
+
+	static bool		IsResident(const void* asset);
+	static void		SetBudget(eResidencyCategory category, size_t byteCount);
+	static size_t	GetBudget(eResidencyCategory category);
+	static size_t	GetResidentByteCount(eResidencyCategory category);
+
+	static const char*	GetCategoryName(eResidencyCategory category);
+	static bool			GetCategoryFromName(const std::string& name, eResidencyCategory& out_category);
+
+	// Prints each category's usage against its budget to the console, then the assets of listCategory by size
+	static void			PrintResidency(eResidencyCategory listCategory = NUM_RESIDENCY_CATEGORIES);
+
+
+private:
+	//-----Private Types-----
+
+	struct ResidentAsset_t
+	{
+		eResidencyAssetType	type = NUM_RESIDENCY_ASSET_TYPES;
+		void*				asset = nullptr;
+		std::string			filepath;
+		bool				generateMipMaps = false;	// Textures only
+
+		int					referenceCount = 0;
+		bool				isPinned = true;
+		bool				isResident = true;
+		size_t				byteCount = 0;				// Refreshed each Update(), placeholders aren't counted
+		uint64_t			lastUsedFrame = 0;			// Last frame a reference was added or removed
+	};
+
+
+private:
+	//-----Private Methods-----
+
+	AssetResidency() {}
+
+	static ResidentAsset_t*		GetResidentAsset(const void* asset);
+	static size_t				CalculateByteCount(const ResidentAsset_t& residentAsset);
+	static void					EnforceBudget(eResidencyCategory category);
+
+	static void					Evict(ResidentAsset_t& residentAsset);
+	static void					Restore(ResidentAsset_t& residentAsset);
+
+	static eResidencyCategory	GetCategoryForType(eResidencyAssetType type);
+
+
+private:
+	//-----Private Data-----
+
+	// Assets are evicted in place rather than deleted, so indices and pointers stay valid; main thread only
+	static std::vector<ResidentAsset_t>		s_assets;
+	static std::map<const void*, int>		s_assetIndices;
+
+	static size_t							s_budgets[NUM_RESIDENCY_CATEGORIES];
+	static uint64_t							s_frameNumber;
+
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// A reference to an asset that keeps it from being evicted, gotten from AssetDB::Acquire*()
+// Dereference it when it's used rather than keeping the pointer, evicted assets hold placeholders
+// Main thread only, like the rest of the AssetDB
+//
+template <typename T>
+class AssetHandle
+{
+public:
+	//-----Public Methods-----
+
+	AssetHandle() {}
+
+	explicit AssetHandle(T* asset)
+		: m_asset(asset)
+	{
+		if (m_asset != nullptr)
+		{
+			AssetResidency::AddReference(m_asset);
+		}
+	}
+
+	AssetHandle(const AssetHandle<T>& copy)
+		: AssetHandle(copy.m_asset)
+	{
+	}
+
+	~AssetHandle()
+	{
+		Release();
+	}
+
+	AssetHandle<T>& operator=(const AssetHandle<T>& copy)
+	{
+		if (copy.m_asset != nullptr)
+		{
+			AssetResidency::AddReference(copy.m_asset);
+		}
+
+		Release();
+		m_asset = copy.m_asset;
+
+		return *this;
+	}
+
+	void Release()
+	{
+		if (m_asset != nullptr)
+		{
+			AssetResidency::RemoveReference(m_asset);
+			m_asset = nullptr;
+		}
+	}
+
+	T*		Get() const			{ return m_asset; }
+	T*		operator->() const	{ return m_asset; }
+	bool	IsValid() const		{ return (m_asset != nullptr); }
+
+
+private:
+	//-----Private Data-----
+
+	T* m_asset = nullptr;
+
+};
@@ -11,6 +11,8 @@
 #include "Engine/Assets/AssimpLoader.hpp"
 #include "Engine/Rendering/Animation/Pose.hpp"
 #include "Engine/Core/Time/ProfileScoped.hpp"
+#include "Engine/Core/JobSystem/ParallelFor.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
 #include "Engine/Rendering/Core/Renderable.hpp"
 #include "Engine/Rendering/Resources/Sampler.hpp"
 #include "Engine/Rendering/Meshes/MeshBuilder.hpp"
@@ -20,9 +22,23 @@
 #include "Engine/Rendering/Animation/AnimationClip.hpp"
 #include "Engine/Rendering/DebugRendering/DebugRenderSystem.hpp"
 
+#include <algorithm>
+#include <unordered_map>
+
 // Assimp importer, so we don't need to pass it between open/close files
 Assimp::Importer g_importer;
 
+// Meshes are big enough to be a job each, poses are batched since one bone pass is quick
+#define ASSIMP_MESHES_PER_JOB (1)
+#define ASSIMP_POSES_PER_JOB (8)
+
+// One frame of one clip, flattened so every clip's frames are sampled in the same parallel loop
+struct AssimpPoseFrame_t
+{
+	int animationIndex;
+	int frameIndex;
+};
+
 // C utility functions
 std::vector<Texture*>	LoadAssimpMaterialTextures(aiMaterial* aimaterial, aiTextureType type);
 Matrix44				GetNodeWorldTransform(aiNode* node);
@@ -31,6 +47,10 @@ Quaternion				ConvertAiQuaternionToMyQuaternion(aiQuaternion aiQuat);
 void					DebugPrintAnimation(aiAnimation* anim);
 void					DebugPrintAITree(aiNode* node, const std::string& indent);
 
+static const aiNodeAnim*	FindChannel(const std::unordered_map<std::string, const aiNodeAnim*>& channelsByName, const std::string& nodeName);
+template <typename KEY_TYPE>
+static int					FindKeyIndexAtTime(const KEY_TYPE* keys, unsigned int numKeys, int firstKeyIndex, float time, bool& out_found);
+
 
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -100,6 +120,19 @@ Renderable* AssimpLoader::ImportMesh(Skeleton* skeleton /*= nullptr*/)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Traverses the Assimp tree and fills a builder per aiMesh, without making any meshes or materials
+// Used by the AssetCooker, which writes the geometry out rather than uploading it
+//
+void AssimpLoader::ImportMeshBuilders(std::vector<MeshBuilder*>& out_builders, Skeleton* skeleton /*= nullptr*/)
+{
+	std::vector<AssimpMeshInstance_t> instances;
+	GatherMeshInstances_FromNode(m_scene->mRootNode, Matrix44::IDENTITY, instances);
+
+	BuildMeshBuilders_FromInstances(instances, skeleton, out_builders);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Traverses the Assimp root node to assemble animations
 // If a tick offset is specified, it starts creating all animations starting from the offset - is
@@ -129,7 +162,7 @@ void AssimpLoader::InitializeSkeleton(Skeleton* skeleton)
 {
 	// 1. Get all the bone names in the tree, done by recursively walking the tree
 	// and pulling out all bone names from the meshes.
-	std::vector<std::string> boneNames;
+	std::unordered_set<std::string> boneNames;
 	GetBoneNamesFromNode(boneNames);
 
 	// 2. Create all the mappings for the bones in the correct order, with the root bone
@@ -153,7 +186,7 @@ void AssimpLoader::InitializeSkeleton(Skeleton* skeleton)
 // Traverses the Assimp scene to pull all bone names from the meshes' bone structs, 
 // and stores them uniquely in the out_names parameter.
 // 
-void AssimpLoader::GetBoneNamesFromNode(std::vector<std::string>& out_names)
+void AssimpLoader::GetBoneNamesFromNode(std::unordered_set<std::string>& out_names)
 {
 	// Iterate across all meshes in the scene
 	for (unsigned int meshIndex = 0; meshIndex < m_scene->mNumMeshes; ++meshIndex)
@@ -164,13 +197,9 @@ void AssimpLoader::GetBoneNamesFromNode(std::vector<std::string>& out_names)
 		for (unsigned int boneIndex = 0; boneIndex < currMesh->mNumBones; ++boneIndex)
 		{
 			aiBone* currBone = currMesh->mBones[boneIndex];
-			std::string boneName = std::string(currBone->mName.C_Str());
-		
-			// If we don't already have the name in the list, store the name
-			if (std::find(out_names.begin(), out_names.end(), boneName) == out_names.end())
-			{
-				out_names.push_back(boneName);
-			}
+
+			// Set ignores names already stored, meshes share most of their bones
+			out_names.insert(std::string(currBone->mName.C_Str()));
 		}
 	}
 }
@@ -182,11 +211,11 @@ void AssimpLoader::GetBoneNamesFromNode(std::vector<std::string>& out_names)
 // parent bone always comes before it's children, for calculating to-world matrices. As a result, we
 // Walk the tree to find the order they appear in, creating unique mappings for each as we go
 // 
-void AssimpLoader::CreateBoneMappingsFromNode(aiNode* node, const std::vector<std::string>& boneNames, Skeleton* skeleton)
+void AssimpLoader::CreateBoneMappingsFromNode(aiNode* node, const std::unordered_set<std::string>& boneNames, Skeleton* skeleton)
 {
 	// If the name of this node is a bone name, create or get the mapping
 	std::string nodeName = node->mName.C_Str();
-	if (std::find(boneNames.begin(), boneNames.end(), nodeName) != boneNames.end())
+	if (boneNames.find(nodeName) != boneNames.end())
 	{
 		skeleton->CreateOrGetBoneMapping(nodeName); // Creates a mapping if one doesn't exist, otherwise returns the existing one
 	}
@@ -230,7 +259,7 @@ void AssimpLoader::SetBoneOffsetData(aiNode* node, Skeleton* skeleton)
 			Matrix44 nodeTransform = GetNodeWorldTransform(node);					// Why we need to recursively walk the tree
 			Matrix44 offset = ConvertAiMatrixToMyMatrix(currBone->mOffsetMatrix);	// Inverse bind pose
 
-			Matrix44 finalWorldToBone = offset * Matrix44::GetInverse(nodeTransform);
+			Matrix44 finalWorldToBone = offset * Matrix44::GetInverseAffine(nodeTransform);
 			skeleton->SetOffsetMatrix(boneMapping, finalWorldToBone);
 		}
 	}
@@ -280,7 +309,7 @@ void AssimpLoader::ExtractBoneTransform(aiNode* ainode, const Matrix44& accumula
 		skeleton->SetParentBoneIndex(thisBoneIndex, parentBoneIndex);
 
 		skeleton->SetMeshToBoneMatrix(thisBoneIndex, offsetMatrix);
-		skeleton->SetBoneToMeshMatrix(thisBoneIndex, Matrix44::GetInverse(offsetMatrix));
+		skeleton->SetBoneToMeshMatrix(thisBoneIndex, Matrix44::GetInverseAffine(offsetMatrix));
 	}
 
 	// Grab PreRotations, since animations don't have pre-rotation channels and need these prepended
@@ -329,7 +358,7 @@ void AssimpLoader::BuildLocalMatrices(Skeleton* skeleton)
 			// Get the parent transform
 			BoneData_t parentBone = skeleton->GetBoneData(parentIndex);
 			Matrix44 parentWorldInverse = parentBone.worldTransform;
-			parentWorldInverse.Invert();
+			parentWorldInverse.InvertAffine();
 
 			// Multiply our parent's inverse with our world to get our local
 			Matrix44 localTransform = parentWorldInverse * currBone.worldTransform;
@@ -359,48 +388,165 @@ void AssimpLoader::BuildLocalMatrices(Skeleton* skeleton)
 //
 void AssimpLoader::BuildMeshesAndMaterials_FromScene(Renderable* renderable, Skeleton* skeleton)
 {
-	// Done recursively from the root
-	//									Node					Parent Transform		Renderable		Skeleton
-	BuildMeshesAndMaterials_FromNode(	m_scene->mRootNode,		Matrix44::IDENTITY,		renderable,		skeleton);
+	PROFILE_SCOPE_CATEGORY("AssimpLoader::BuildMeshesAndMaterials", "Assets");
+
+	std::vector<AssimpMeshInstance_t> instances;
+	GatherMeshInstances_FromNode(m_scene->mRootNode, Matrix44::IDENTITY, instances);
+
+	std::vector<MeshBuilder*> builders;
+	BuildMeshBuilders_FromInstances(instances, skeleton, builders);
+
+	// Meshes and materials make GPU resources and go through the AssetDB, so they're made here, in tree order
+	// Each aiMaterial is only built once, and shared by every mesh that uses it
+	std::vector<Material*> materials(m_scene->mNumMaterials, nullptr);
+
+	for (int instanceIndex = 0; instanceIndex < (int) instances.size(); ++instanceIndex)
+	{
+		// Only build with skinned vertices if bones are present
+		// Model meshes are static, so indexed ones share their layout's arena
+		MeshBuilder* mb = builders[instanceIndex];
+		Mesh* mesh = new Mesh();
+		mesh->SetStoredInArena(mb->GetDrawInstruction().m_usingIndices);
+
+		if (skeleton != nullptr)
+		{
+			mb->UpdateMesh<VertexSkinned>(*mesh);
+		}
+		else
+		{
+			mb->UpdateMesh<VertexLit>(*mesh);
+		}
+
+		delete mb;
+
+		unsigned int materialIndex = instances[instanceIndex].mesh->mMaterialIndex;
+		Material* material = AssetDB::GetSharedMaterial("Default_Opaque");
+
+		if (materialIndex < m_scene->mNumMaterials)
+		{
+			if (materials[materialIndex] == nullptr)
+			{
+				materials[materialIndex] = BuildMaterial_FromAIMaterial(m_scene->mMaterials[materialIndex], skeleton);
+			}
+
+			material = materials[materialIndex];
+		}
+
+		// Add the draw!
+		RenderableDraw_t draw;
+		draw.sharedMaterial = material;
+		draw.mesh = mesh;
+
+		renderable->AddDraw(draw);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructs the material for the given aiMaterial, loading the textures it references
+//
+Material* AssimpLoader::BuildMaterial_FromAIMaterial(aiMaterial* aimaterial, Skeleton* skeleton)
+{
+	std::vector<Texture*> diffuse, normal;
+
+	diffuse		= LoadAssimpMaterialTextures(aimaterial,	aiTextureType_DIFFUSE);
+	normal		= LoadAssimpMaterialTextures(aimaterial,	aiTextureType_NORMALS);
+
+	// Make the material, defaulting missing textures to built-in engine textures
+	Material* material = new Material();
+	if (diffuse.size() > 0)
+	{
+		material->SetDiffuse(diffuse[0]); // Only pull the first texture
+	}
+	else
+	{
+		material->SetDiffuse(AssetDB::GetTexture("Default"));
+	}
+
+	if (normal.size() > 0)
+	{
+		material->SetNormal(normal[0]); // Only pull the first texture
+	}
+	else
+	{
+		material->SetNormal(AssetDB::GetTexture("Flat"));
+	}
+
+
+	// If we have a skeleton, then use a skinning shader
+	if (skeleton != nullptr)
+	{
+		material->SetShader(AssetDB::CreateOrGetShader("Data/Shaders/Skinning.shader"));
+	}
+	else
+	{
+		material->SetShader(AssetDB::CreateOrGetShader("Phong_Opaque"));
+	}
+
+	// Set up a linear sampler for looks
+	Sampler* sampler = new Sampler();
+	sampler->Initialize(SAMPLER_FILTER_LINEAR_MIPMAP_LINEAR, EDGE_SAMPLING_REPEAT);
+	material->SetSampler(0, sampler);
+	material->SetProperty("SPECULAR_AMOUNT", 0.3f);
+	material->SetProperty("SPECULAR_POWER", 10.f);
+
+	return material;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Builds all meshes and materials from the data on the given node
+// Flattens the node tree into the aiMeshes it uses, with the model space transform of each use
+// Depth first, so the instances come out in the order the tree was always built in
 //
-void AssimpLoader::BuildMeshesAndMaterials_FromNode(aiNode* node, const Matrix44& parentTransform, Renderable* renderable, Skeleton* skeleton)
+void AssimpLoader::GatherMeshInstances_FromNode(aiNode* node, const Matrix44& parentTransform, std::vector<AssimpMeshInstance_t>& out_instances) const
 {
-	// Get the node transform
-	 Matrix44 currTransform = ConvertAiMatrixToMyMatrix(node->mTransformation);
-	 currTransform = parentTransform * currTransform;
-
-	 // Build a mesh from each aiMesh struct used by this node
-	 int numMeshes = (int) node->mNumMeshes;
-
-	 for (int meshIndex = 0; meshIndex < numMeshes; ++meshIndex)
-	 {
-		 BuildMeshAndMaterials_FromAIMesh(m_scene->mMeshes[node->mMeshes[meshIndex]], currTransform, renderable, skeleton);
-	 }
-
-	 // Recursively call on child nodes
-	 int numChildren = node->mNumChildren;
-	 for (int childIndex = 0; childIndex < numChildren; ++childIndex)
-	 {
-		 BuildMeshesAndMaterials_FromNode(node->mChildren[childIndex], currTransform, renderable, skeleton);
-	 }
+	Matrix44 currTransform = parentTransform * ConvertAiMatrixToMyMatrix(node->mTransformation);
+
+	int numMeshes = (int) node->mNumMeshes;
+	for (int meshIndex = 0; meshIndex < numMeshes; ++meshIndex)
+	{
+		AssimpMeshInstance_t instance;
+		instance.mesh = m_scene->mMeshes[node->mMeshes[meshIndex]];
+		instance.transform = currTransform;
+
+		out_instances.push_back(instance);
+	}
+
+	int numChildren = (int) node->mNumChildren;
+	for (int childIndex = 0; childIndex < numChildren; ++childIndex)
+	{
+		GatherMeshInstances_FromNode(node->mChildren[childIndex], currTransform, out_instances);
+	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Constructs the mesh and material data from the given aiMesh structure
-// The transformation passed is the space the current mesh exists in, and is used to convert
-// all mesh vertices into "model/world" space
+// Fills a builder per instance across the job system; each builder only reads its aiMesh and the skeleton
+// Builders are appended in instance order, regardless of which finished first
 //
-void AssimpLoader::BuildMeshAndMaterials_FromAIMesh(aiMesh* aimesh, const Matrix44& transformation, Renderable* renderable, Skeleton* skeleton)
+void AssimpLoader::BuildMeshBuilders_FromInstances(const std::vector<AssimpMeshInstance_t>& instances, Skeleton* skeleton, std::vector<MeshBuilder*>& out_builders) const
 {
-	//-----Build the mesh from this aiMesh-----
+	PROFILE_SCOPE_CATEGORY("AssimpLoader::BuildMeshBuilders", "Assets");
+
+	int firstBuilderIndex = (int) out_builders.size();
+	out_builders.resize(firstBuilderIndex + instances.size(), nullptr);
 
-	MeshBuilder mb;
+	ParallelFor(0, (int) instances.size(), ASSIMP_MESHES_PER_JOB, [&](int instanceIndex)
+	{
+		MeshBuilder* mb = new MeshBuilder();
+		BuildMeshBuilder_FromAIMesh(instances[instanceIndex].mesh, instances[instanceIndex].transform, skeleton, *mb);
+
+		out_builders[firstBuilderIndex + instanceIndex] = mb;
+	});
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Fills the builder with the aiMesh's vertices and indices, transformed into model space
+// Bone weights are only added if a skeleton is given to map the bone names to
+//
+void AssimpLoader::BuildMeshBuilder_FromAIMesh(aiMesh* aimesh, const Matrix44& transformation, Skeleton* skeleton, MeshBuilder& mb) const
+{
 	mb.BeginBuilding(PRIMITIVE_TRIANGLES, true);
 
 	// Iterate across vertices
@@ -481,7 +627,7 @@ void AssimpLoader::BuildMeshAndMaterials_FromAIMesh(aiMesh* aimesh, const Matrix
 			aiBone* currBone = aimesh->mBones[boneIndex];
 			std::string boneName = currBone->mName.C_Str();
 
-			unsigned int mappingIndex = skeleton->GetBoneMapping(boneName);
+			int mappingIndex = skeleton->GetBoneMapping(boneName);
 
 			ASSERT_OR_DIE(mappingIndex >= 0, Stringf("Error: Mesh built with a bone name without a registered slot."));
 
@@ -492,81 +638,15 @@ void AssimpLoader::BuildMeshAndMaterials_FromAIMesh(aiMesh* aimesh, const Matrix
 				float weightValue = currBone->mWeights[weightIndex].mWeight;
 
 				// Set the index and weight data in the vertex buffer
-				mb.AddBoneData(vertexIndex, mappingIndex, weightValue);
+				mb.AddBoneData(vertexIndex, (unsigned int) mappingIndex, weightValue);
 			}
 		}
 	}
 	
 	mb.FinishBuilding();
-	Mesh* mesh;
-	
-	// Only build with skinned vertices if bones are present
-	if (skeleton != nullptr)
-	{
-		mesh = mb.CreateMesh<VertexSkinned>();
-	}
-	else
-	{
-		mesh = mb.CreateMesh<VertexLit>();
-	}
-
-
-	//-----Build the material for this mesh-----
-
-	Material* material = AssetDB::GetSharedMaterial("Default_Opaque");
-	if (aimesh->mMaterialIndex >= 0)
-	{
-		aiMaterial* aimaterial = m_scene->mMaterials[aimesh->mMaterialIndex];
-		std::vector<Texture*> diffuse, normal;
-
-		diffuse		= LoadAssimpMaterialTextures(aimaterial,	aiTextureType_DIFFUSE);
-		normal		= LoadAssimpMaterialTextures(aimaterial,	aiTextureType_NORMALS);
-
-		// Make the material, defaulting missing textures to built-in engine textures
-		material = new Material();
-		if (diffuse.size() > 0)
-		{
-			material->SetDiffuse(diffuse[0]); // Only pull the first texture
-		}
-		else
-		{
-			material->SetDiffuse(AssetDB::GetTexture("Default"));
-		}
 
-		if (normal.size() > 0)
-		{
-			material->SetNormal(normal[0]); // Only pull the first texture
-		}
-		else
-		{
-			material->SetNormal(AssetDB::GetTexture("Flat"));
-		}
-
-
-		// If we have a skeleton, then use a skinning shader
-		if (skeleton != nullptr)
-		{
-			material->SetShader(AssetDB::CreateOrGetShader("Data/Shaders/Skinning.shader"));
-		}
-		else
-		{
-			material->SetShader(AssetDB::CreateOrGetShader("Phong_Opaque"));
-		}
-
-		// Set up a linear sampler for looks
-		Sampler* sampler = new Sampler();
-		sampler->Initialize(SAMPLER_FILTER_LINEAR_MIPMAP_LINEAR, EDGE_SAMPLING_REPEAT);
-		material->SetSampler(0, sampler);
-		material->SetProperty("SPECULAR_AMOUNT", 0.3f);
-		material->SetProperty("SPECULAR_POWER", 10.f);
-	}
-
-	// Add the draw!
-	RenderableDraw_t draw;
-	draw.sharedMaterial = material;
-	draw.mesh = mesh;
-
-    renderable->AddDraw(draw);
+	// Bone data is part of each vertex, so only vertices with the same weights get welded
+	mb.Optimize();
 }
 
 
@@ -579,23 +659,50 @@ void AssimpLoader::BuildMeshAndMaterials_FromAIMesh(aiMesh* aimesh, const Matrix
 
 //-----------------------------------------------------------------------------------------------
 // Builds all animations from the Assimp tree and stores them in the vector provided
+// Every frame of every clip is independent once the clips are made, so they're all sampled in one parallel loop
 //
 void AssimpLoader::BuildAnimations(Skeleton* skeleton, std::vector<AnimationClip*>& animations, int firstFrameIndex)
 {
-	unsigned int animationCount = m_scene->mNumAnimations;
+	PROFILE_SCOPE_CATEGORY("AssimpLoader::BuildAnimations", "Assets");
 
-	for (unsigned int animationIndex = 0; animationIndex < animationCount; ++animationIndex)
+	int animationCount = (int) m_scene->mNumAnimations;
+	int firstClipIndex = (int) animations.size();
+
+	std::vector<std::vector<AssimpBoneChannels_t>> clipBoneChannels(animationCount);
+	std::vector<AssimpPoseFrame_t> frames;
+
+	for (int animationIndex = 0; animationIndex < animationCount; ++animationIndex)
 	{
-		AnimationClip* clip = BuildAnimation(animationIndex, skeleton, firstFrameIndex);
+		AnimationClip* clip = CreateAnimation(animationIndex, skeleton, firstFrameIndex);
 		animations.push_back(clip);
+
+		BuildBoneChannels(m_scene->mAnimations[animationIndex], skeleton, clipBoneChannels[animationIndex]);
+
+		for (int frameIndex = 0; frameIndex < clip->GetPoseCount(); ++frameIndex)
+		{
+			frames.push_back(AssimpPoseFrame_t{ animationIndex, frameIndex });
+		}
 	}
+
+	ParallelFor(0, (int) frames.size(), ASSIMP_POSES_PER_JOB, [&](int workIndex)
+	{
+		int animationIndex = frames[workIndex].animationIndex;
+		int frameIndex = frames[workIndex].frameIndex;
+
+		aiAnimation* aianimation = m_scene->mAnimations[animationIndex];
+		AnimationClip* clip = animations[firstClipIndex + animationIndex];
+
+		// Pass our time in number of ticks, since channels store times as number of ticks
+		float time = (frameIndex * clip->GetFrameDurationSeconds() * (float) aianimation->mTicksPerSecond);
+		FillPoseForTime(clip->GetPoseAtIndex(frameIndex), clipBoneChannels[animationIndex], time, skeleton, firstFrameIndex);
+	});
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Builds a single animation, from the aiAnimation struct at the given index
+// Makes the clip for the aiAnimation at the given index, with room for every frame but none sampled yet
 //
-AnimationClip* AssimpLoader::BuildAnimation(unsigned int animationIndex, Skeleton* skeleton, int tickOffset)
+AnimationClip* AssimpLoader::CreateAnimation(unsigned int animationIndex, Skeleton* skeleton, int tickOffset) const
 {
 	aiAnimation* aianimation = m_scene->mAnimations[animationIndex];
 
@@ -604,8 +711,6 @@ AnimationClip* AssimpLoader::BuildAnimation(unsigned int animationIndex, Skeleto
 	float durationSeconds = (float) numTicks / (float) aianimation->mTicksPerSecond;
 
 	float framesPerSecond = 30.f;	// Import at 30 fps
-	float secondsPerFrame = 1.f / framesPerSecond;
-
 	int numFramesToGenerate = Ceiling(durationSeconds * framesPerSecond);
 
 	// Create the animation clip
@@ -613,57 +718,76 @@ AnimationClip* AssimpLoader::BuildAnimation(unsigned int animationIndex, Skeleto
 	animation->Initialize(numFramesToGenerate, skeleton, framesPerSecond);
 	animation->SetName(aianimation->mName.C_Str());
 
-	// Iterate across the frames, and build a pose for each
-	for (int frameIndex = 0; frameIndex < numFramesToGenerate; ++frameIndex)
+	return animation;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds the channels for each bone in the animation, indexed by bone
+// Done once per clip, instead of searching every channel by name for every bone on every frame
+//
+void AssimpLoader::BuildBoneChannels(const aiAnimation* aianimation, const Skeleton* skeleton, std::vector<AssimpBoneChannels_t>& out_boneChannels) const
+{
+	std::unordered_map<std::string, const aiNodeAnim*> channelsByName;
+	channelsByName.reserve(aianimation->mNumChannels);
+
+	for (unsigned int channelIndex = 0; channelIndex < aianimation->mNumChannels; ++channelIndex)
 	{
-		Pose* pose = animation->GetPoseAtIndex(frameIndex);
+		const aiNodeAnim* channel = aianimation->mChannels[channelIndex];
 
-		// Pass our time in number of ticks, since channels store times as number of ticks
-		float time = (frameIndex * secondsPerFrame * (float) aianimation->mTicksPerSecond);
-		FillPoseForTime(pose, aianimation, time, skeleton, tickOffset);
+		// Keep the first channel of a name, as the old linear search did
+		channelsByName.insert(std::make_pair(std::string(channel->mNodeName.C_Str()), channel));
 	}
 
-	return animation;
+	const std::vector<std::string>& boneNames = skeleton->GetAllBoneNames();
+	out_boneChannels.resize(boneNames.size());
+
+	for (int boneIndex = 0; boneIndex < (int) boneNames.size(); ++boneIndex)
+	{
+		const std::string& boneName = boneNames[boneIndex];
+		AssimpBoneChannels_t& boneChannels = out_boneChannels[boneIndex];
+
+		boneChannels.channel				= FindChannel(channelsByName, boneName);
+		boneChannels.translationChannel		= FindChannel(channelsByName, boneName + "_$AssimpFbx$_Translation");
+		boneChannels.rotationChannel		= FindChannel(channelsByName, boneName + "_$AssimpFbx$_Rotation");
+		boneChannels.scaleChannel			= FindChannel(channelsByName, boneName + "_$AssimpFbx$_Scale");
+	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
 // Fills in the pose given for the animation at time time
+// Only reads the scene and skeleton, so poses can be filled on any thread
 //
-void AssimpLoader::FillPoseForTime(Pose* out_pose, aiAnimation* aianimation, float time, Skeleton* skeleton, int tickOffset)
+void AssimpLoader::FillPoseForTime(Pose* out_pose, const std::vector<AssimpBoneChannels_t>& boneChannels, float time, const Skeleton* skeleton, int tickOffset) const
 {
 	// Initialize the pose
-	std::vector<std::string> boneNames = skeleton->GetAllBoneNames();
 	out_pose->Initialize(skeleton);
 	
-	// Iterate across all bones
-	int numBones = (int) boneNames.size();
+	// Iterate across all bones, the channels are in bone index order
+	int numBones = (int) boneChannels.size();
 
-	for (int boneNameIndex = 0; boneNameIndex < numBones; ++boneNameIndex)
+	for (int boneIndex = 0; boneIndex < numBones; ++boneIndex)
 	{
-		std::string currBoneName = boneNames[boneNameIndex];
-		int boneDataIndex = skeleton->GetBoneMapping(currBoneName);
-
-		// Get the channel for the bone
-		aiNodeAnim* channel = GetChannelForBone(currBoneName, aianimation);
+		const aiNodeAnim* channel = boneChannels[boneIndex].channel;
 
 		// If the channel exists, get the transform at the current time
 		if (channel != nullptr)
 		{
-			Matrix44 boneTransform = GetLocalTransfromAtTime(channel, time, skeleton->GetBoneData(boneDataIndex).preRotation, tickOffset);
-			out_pose->SetBoneTransform(boneDataIndex, boneTransform);
+			Matrix44 boneTransform = GetLocalTransfromAtTime(channel, time, skeleton->GetBoneData(boneIndex).preRotation, tickOffset);
+			out_pose->SetBoneTransform(boneIndex, boneTransform);
 		}
 		else
 		{
 			// Assimp may have separated the animation channel for this bone into 3 separate channels, so we look for them
 			Matrix44 boneTransform;
-			bool channelsExist = ConstructTransformFromSeparatedChannels(currBoneName, aianimation, time, skeleton, boneTransform, tickOffset);
+			bool channelsExist = ConstructTransformFromSeparatedChannels(boneChannels[boneIndex], boneIndex, time, skeleton, boneTransform, tickOffset);
 
 			// If they existed as separate channels, then set the transform
 			// Otherwise leave the transform alone, which was already initialized to the bind pose bone's local transform
 			if (channelsExist)
 			{
-				out_pose->SetBoneTransform(boneDataIndex, boneTransform);
+				out_pose->SetBoneTransform(boneIndex, boneTransform);
 			}
 		}
 	}
@@ -673,32 +797,10 @@ void AssimpLoader::FillPoseForTime(Pose* out_pose, aiAnimation* aianimation, flo
 }
 
 
-//-----------------------------------------------------------------------------------------------
-// Find the channel corresponding to the given bone name, returning nullptr if it doesn't exist
-//
-aiNodeAnim* AssimpLoader::GetChannelForBone(const std::string& boneName, aiAnimation* animation) const
-{
-	int numChannels = animation->mNumChannels;
-
-	for (int channelIndex = 0; channelIndex < numChannels; ++channelIndex)
-	{
-		aiNodeAnim* currChannel = animation->mChannels[channelIndex];
-
-		std::string nodeName = currChannel->mNodeName.C_Str();
-		if (nodeName == boneName)
-		{
-			return currChannel;
-		}
-	}
-
-	return nullptr;
-}
-
-
 //-----------------------------------------------------------------------------------------------
 // Determines the transform to use from the channel at the given time
 //
-Matrix44 AssimpLoader::GetLocalTransfromAtTime(aiNodeAnim* channel, float time, const Matrix44& preRotation, int tickOffset)
+Matrix44 AssimpLoader::GetLocalTransfromAtTime(const aiNodeAnim* channel, float time, const Matrix44& preRotation, int tickOffset) const
 {
 	// Assumes the start time for all nodes is mTime == 0
 
@@ -741,15 +843,7 @@ aiVector3D AssimpLoader::GetAnimationTranslationAtTime(const aiNodeAnim* channel
 	if ((int) channel->mNumPositionKeys > firstFrameIndex)
 	{
 		bool found = false;
-		for (unsigned int translationKeyIndex = firstFrameIndex; translationKeyIndex < channel->mNumPositionKeys - 1; ++translationKeyIndex)
-		{
-			if (channel->mPositionKeys[translationKeyIndex + 1].mTime > time + timeOffset)
-			{
-				positionKeyIndex = translationKeyIndex;
-				found = true;
-				break;
-			}
-		}
+		positionKeyIndex = FindKeyIndexAtTime(channel->mPositionKeys, channel->mNumPositionKeys, firstFrameIndex, time + timeOffset, found);
 
 		// Clamp to the end of the channel if our current time is pass the end
 		if (!found)
@@ -788,7 +882,7 @@ aiVector3D AssimpLoader::GetAnimationTranslationAtTime(const aiNodeAnim* channel
 //-----------------------------------------------------------------------------------------------
 // Gets the rotation of the channel at the given time, accounting for the offset
 //
-aiQuaternion AssimpLoader::GetAnimationRotationAtTime(aiNodeAnim* channel, float time, int tickOffset) const
+aiQuaternion AssimpLoader::GetAnimationRotationAtTime(const aiNodeAnim* channel, float time, int tickOffset) const
 {
 	if (tickOffset >= (int) channel->mNumRotationKeys)
 	{
@@ -802,15 +896,7 @@ aiQuaternion AssimpLoader::GetAnimationRotationAtTime(aiNodeAnim* channel, float
 	if ((int) channel->mNumRotationKeys > tickOffset)
 	{
 		bool found = false;
-		for (unsigned int index = tickOffset; index < channel->mNumRotationKeys - 1; ++index)
-		{
-			if (channel->mRotationKeys[index + 1].mTime > time + timeOffset)
-			{
-				rotationKeyIndex = index;
-				found = true;
-				break;
-			}
-		}
+		rotationKeyIndex = FindKeyIndexAtTime(channel->mRotationKeys, channel->mNumRotationKeys, tickOffset, time + timeOffset, found);
 
 		// Clamp to front
 		if (channel->mRotationKeys[rotationKeyIndex].mTime > time + timeOffset)
@@ -848,7 +934,7 @@ aiQuaternion AssimpLoader::GetAnimationRotationAtTime(aiNodeAnim* channel, float
 //-----------------------------------------------------------------------------------------------
 // Gets the scale of the channel at the given time, accounting for the offset
 //
-aiVector3D AssimpLoader::GetAnimationScaleAtTime(aiNodeAnim* channel, float time, int tickOffset) const
+aiVector3D AssimpLoader::GetAnimationScaleAtTime(const aiNodeAnim* channel, float time, int tickOffset) const
 {
 	if (tickOffset >= (int) channel->mNumScalingKeys)
 	{
@@ -863,15 +949,7 @@ aiVector3D AssimpLoader::GetAnimationScaleAtTime(aiNodeAnim* channel, float time
 	if ((int) channel->mNumScalingKeys > tickOffset)
 	{
 		bool found = false;
-		for (unsigned int scaleKeyIndex = tickOffset; scaleKeyIndex < channel->mNumScalingKeys - 1; ++scaleKeyIndex)
-		{
-			if (channel->mScalingKeys[scaleKeyIndex + 1].mTime > time + timeOffset)
-			{
-				firstKeyIndex = scaleKeyIndex;
-				found = true;
-				break;
-			}
-		}
+		firstKeyIndex = FindKeyIndexAtTime(channel->mScalingKeys, channel->mNumScalingKeys, tickOffset, time + timeOffset, found);
 
 		// Clamp to the end of the channel if our current time is pass the end
 		if (!found)
@@ -908,49 +986,41 @@ aiVector3D AssimpLoader::GetAnimationScaleAtTime(aiNodeAnim* channel, float time
 
 
 //-----------------------------------------------------------------------------------------------
-// Constructs the animation for the given bone name from 3 separate channels:
+// Constructs the animation for the given bone from 3 separate channels:
 //		boneName__$AssimpFbx$_Translation
 //		boneName__$AssimpFbx$_Rotation
 //		boneName__$AssimpFbx$_Scale
 // It's not guarenteed that all three (or any at all) exist
 // Returns true if at least one existed
 //
-bool AssimpLoader::ConstructTransformFromSeparatedChannels(const std::string& boneName, aiAnimation* animation, float time, Skeleton* skeleton, Matrix44& out_transform, int firstFrameIndex) const
+bool AssimpLoader::ConstructTransformFromSeparatedChannels(const AssimpBoneChannels_t& boneChannels, int boneIndex, float time, const Skeleton* skeleton, Matrix44& out_transform, int firstFrameIndex) const
 {
 	bool channelFound = false;
+	BoneData_t boneData = skeleton->GetBoneData(boneIndex);
 
 	// Translation
-	std::string translationChannelName = boneName + "_$AssimpFbx$_Translation";
 	aiVector3D translation = aiVector3D(0.f, 0.f, 0.f);
-
-	aiNodeAnim* translationChannel = GetChannelForBone(translationChannelName, animation);
 	
-	if (translationChannel != nullptr)
+	if (boneChannels.translationChannel != nullptr)
 	{
-		translation = GetAnimationTranslationAtTime(translationChannel, time, firstFrameIndex);
+		translation = GetAnimationTranslationAtTime(boneChannels.translationChannel, time, firstFrameIndex);
 		channelFound = true;
 	}
 	else 
 	{
-		Matrix44 localTransform = skeleton->GetBoneData(skeleton->GetBoneMapping(boneName)).localTransform;
-		Vector3 positionOld = Matrix44::ExtractTranslation(localTransform);
+		Vector3 positionOld = Matrix44::ExtractTranslation(boneData.localTransform);
 		translation = aiVector3D(positionOld.x, positionOld.y, positionOld.z);
 	}
 
 	// Prerotation - from skeleton
-	int boneMapping = skeleton->GetBoneMapping(boneName);
-	BoneData_t boneData = skeleton->GetBoneData(boneMapping);
 	Matrix44 preRotation = boneData.preRotation;
 
 	// Rotation
-	std::string rotationChannelName = boneName + "_$AssimpFbx$_Rotation";
 	aiQuaternion rotation;
 
-	aiNodeAnim* rotationChannel = GetChannelForBone(rotationChannelName, animation);
-
-	if (rotationChannel != nullptr)
+	if (boneChannels.rotationChannel != nullptr)
 	{
-		rotation = GetAnimationRotationAtTime(rotationChannel, time, firstFrameIndex);
+		rotation = GetAnimationRotationAtTime(boneChannels.rotationChannel, time, firstFrameIndex);
 		channelFound = true;
 	}
 
@@ -959,20 +1029,16 @@ bool AssimpLoader::ConstructTransformFromSeparatedChannels(const std::string& bo
 	Matrix44 finalRotation = preRotation * rotationMat;
 
 	// Scale
-	std::string scaleChannelName = boneName + "_$AssimpFbx$_Scale";
 	aiVector3D scale = aiVector3D(1.f, 1.f, 1.f);
 
-	aiNodeAnim* scaleChannel = GetChannelForBone(scaleChannelName, animation);
-
-	if (scaleChannel != nullptr)
+	if (boneChannels.scaleChannel != nullptr)
 	{
-		scale = GetAnimationScaleAtTime(scaleChannel, time, firstFrameIndex);
+		scale = GetAnimationScaleAtTime(boneChannels.scaleChannel, time, firstFrameIndex);
 		channelFound = true;
 	}
 	else 
 	{
-		Matrix44 localTransform = skeleton->GetBoneData(skeleton->GetBoneMapping(boneName)).localTransform;
-		Vector3 scaleOld = Matrix44::ExtractScale(localTransform);
+		Vector3 scaleOld = Matrix44::ExtractScale(boneData.localTransform);
 		scale = aiVector3D(scaleOld.x, scaleOld.y, scaleOld.z);
 	}
 
@@ -1095,6 +1161,40 @@ Quaternion ConvertAiQuaternionToMyQuaternion(aiQuaternion aiQuat)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the channel animating the node of the given name, or nullptr if there isn't one
+//
+static const aiNodeAnim* FindChannel(const std::unordered_map<std::string, const aiNodeAnim*>& channelsByName, const std::string& nodeName)
+{
+	std::unordered_map<std::string, const aiNodeAnim*>::const_iterator itr = channelsByName.find(nodeName);
+
+	if (itr != channelsByName.end())
+	{
+		return itr->second;
+	}
+
+	return nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the index of the last key at or before time, by binary search from firstKeyIndex on
+// out_found is false if time is at or past the last key, in which case the channel clamps to it
+//
+template <typename KEY_TYPE>
+static int FindKeyIndexAtTime(const KEY_TYPE* keys, unsigned int numKeys, int firstKeyIndex, float time, bool& out_found)
+{
+	// First key after firstKeyIndex that starts after time - the key before it is the one we're in
+	const KEY_TYPE* nextKey = std::upper_bound(keys + firstKeyIndex + 1, keys + numKeys, time, [](float searchTime, const KEY_TYPE& key)
+	{
+		return searchTime < key.mTime;
+	});
+
+	out_found = (nextKey != keys + numKeys);
+	return (out_found ? (int) (nextKey - keys) - 1 : firstKeyIndex);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Recursively prints out the AI tree, including node names and all matrix transforms for each node
 //
@@ -7,6 +7,7 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <unordered_set>
 #include "Engine/Math/Matrix44.hpp"
 
 #include "ThirdParty/assimp/include/assimp/scene.h"
@@ -20,6 +21,8 @@ class Renderable;
 class Skeleton;
 class AnimationClip;
 class Pose;
+class Material;
+class MeshBuilder;
 
 struct aiNode;
 struct aiMesh;
@@ -30,6 +33,24 @@ struct aiAnimation;
 struct aiString;
 struct aiAnimation;
 
+// An aiMesh and the model space transform of the node it's used by; the node tree is flattened
+// into these first so the meshes can be built in parallel
+struct AssimpMeshInstance_t
+{
+	aiMesh*		mesh = nullptr;
+	Matrix44	transform;
+};
+
+// The channels that animate one bone in an animation, found once per clip so sampling each frame
+// doesn't search the channels by name; separated channels are only used if there's no single channel
+struct AssimpBoneChannels_t
+{
+	const aiNodeAnim* channel = nullptr;
+	const aiNodeAnim* translationChannel = nullptr;
+	const aiNodeAnim* rotationChannel = nullptr;
+	const aiNodeAnim* scaleChannel = nullptr;
+};
+
 
 class AssimpLoader
 {
@@ -42,6 +63,7 @@ public:
 
 	// Parsing the Assimp scene for information
 	Renderable*						ImportMesh(Skeleton* skeleton = nullptr);
+	void							ImportMeshBuilders(std::vector<MeshBuilder*>& out_builders, Skeleton* skeleton = nullptr);
 	Skeleton*						ImportSkeleton();
 	std::vector<AnimationClip*>		ImportAnimation(Skeleton* skeleton, int firstFrame = 0);
 
@@ -51,8 +73,8 @@ private:
 
 	// Skeleton loading
 	void InitializeSkeleton(Skeleton* skeleton);
-		void GetBoneNamesFromNode(std::vector<std::string>& out_names);
-		void CreateBoneMappingsFromNode(aiNode* node, const std::vector<std::string>& boneNames, Skeleton* skeleton);
+		void GetBoneNamesFromNode(std::unordered_set<std::string>& out_names);
+		void CreateBoneMappingsFromNode(aiNode* node, const std::unordered_set<std::string>& boneNames, Skeleton* skeleton);
 		void SetBoneOffsetData(aiNode* node, Skeleton* skeleton);
 		void BuildBoneHierarchy(Skeleton* skeleton);
 		void ExtractBoneTransform(aiNode* ainode, const Matrix44& accumulatedTransform, int parentBoneIndex, Skeleton* skeleton);
@@ -61,20 +83,22 @@ private:
 
 	// Meshes and materials
 	void BuildMeshesAndMaterials_FromScene(Renderable* renderable, Skeleton* skeleton);
-		void BuildMeshesAndMaterials_FromNode(aiNode* node, const Matrix44& parentTransform, Renderable* renderable, Skeleton* skeleton);
-			void BuildMeshAndMaterials_FromAIMesh(aiMesh* mesh, const Matrix44& transformation, Renderable* renderable, Skeleton* skeleton);
+		Material* BuildMaterial_FromAIMaterial(aiMaterial* aimaterial, Skeleton* skeleton);
+	void GatherMeshInstances_FromNode(aiNode* node, const Matrix44& parentTransform, std::vector<AssimpMeshInstance_t>& out_instances) const;
+	void BuildMeshBuilders_FromInstances(const std::vector<AssimpMeshInstance_t>& instances, Skeleton* skeleton, std::vector<MeshBuilder*>& out_builders) const;
+		void BuildMeshBuilder_FromAIMesh(aiMesh* mesh, const Matrix44& transformation, Skeleton* skeleton, MeshBuilder& out_builder) const;
 
 
 	// Animation
 	void BuildAnimations(Skeleton* skeleton, std::vector<AnimationClip*>& animations, int firstFrameIndex);
-		AnimationClip* BuildAnimation(unsigned int animationIndex, Skeleton* skeleton,  int firstFrameIndex);
-			void FillPoseForTime(Pose* out_pose, aiAnimation* aianimation, float time, Skeleton* skeleton,  int firstFrameIndex);
-				aiNodeAnim* GetChannelForBone(const std::string& boneName, aiAnimation* animation) const;
-				Matrix44	GetLocalTransfromAtTime(aiNodeAnim* channel, float time, const Matrix44& preRotation,  int firstFrameIndex);
+		AnimationClip* CreateAnimation(unsigned int animationIndex, Skeleton* skeleton,  int firstFrameIndex) const;
+		void BuildBoneChannels(const aiAnimation* aianimation, const Skeleton* skeleton, std::vector<AssimpBoneChannels_t>& out_boneChannels) const;
+			void FillPoseForTime(Pose* out_pose, const std::vector<AssimpBoneChannels_t>& boneChannels, float time, const Skeleton* skeleton,  int firstFrameIndex) const;
+				Matrix44	GetLocalTransfromAtTime(const aiNodeAnim* channel, float time, const Matrix44& preRotation,  int firstFrameIndex) const;
 					aiVector3D		GetAnimationTranslationAtTime(const aiNodeAnim* channel, float time,  int firstFrameIndex) const;
-					aiQuaternion	GetAnimationRotationAtTime(aiNodeAnim* channel, float time,  int firstFrameIndex) const;
-					aiVector3D		GetAnimationScaleAtTime(aiNodeAnim* channel, float time,  int firstFrameIndex) const;
-				bool	ConstructTransformFromSeparatedChannels(const std::string& boneName, aiAnimation* animation, float time, Skeleton* skeleton, Matrix44& out_transform,  int firstFrameIndex) const;
+					aiQuaternion	GetAnimationRotationAtTime(const aiNodeAnim* channel, float time,  int firstFrameIndex) const;
+					aiVector3D		GetAnimationScaleAtTime(const aiNodeAnim* channel, float time,  int firstFrameIndex) const;
+				bool	ConstructTransformFromSeparatedChannels(const AssimpBoneChannels_t& boneChannels, int boneIndex, float time, const Skeleton* skeleton, Matrix44& out_transform,  int firstFrameIndex) const;
 
 
 private:
@@ -0,0 +1,412 @@
+/************************************************************************/
+/* File: CookedMeshFile.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the CookedMeshFile class
+/************************************************************************/
+#include "Engine/Core/File.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Assets/CookedMeshFile.hpp"
+#include "Engine/Rendering/Meshes/Mesh.hpp"
+#include "Engine/Core/Time/ProfileScoped.hpp"
+#include "Engine/Rendering/Meshes/MeshGroup.hpp"
+#include "Engine/Rendering/Meshes/MeshBuilder.hpp"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+// The layout is the file format, so it can't change without a version bump
+static_assert(sizeof(CookedMeshFileHeader_t) == 16, "CookedMeshFileHeader_t changed size, bump COOKED_MESH_VERSION");
+static_assert(sizeof(CookedMeshRecord_t) == 72, "CookedMeshRecord_t changed size, bump COOKED_MESH_VERSION");
+
+static unsigned int	GetStrideForVertexType(eCookedVertexType vertexType);
+static size_t		AppendPadding(std::vector<uint8_t>& buffer);
+
+template <typename VERT_TYPE>
+static void			AppendVertices(std::vector<uint8_t>& buffer, MeshBuilder& mb);
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+CookedMeshFile::~CookedMeshFile()
+{
+	if (m_data != nullptr)
+	{
+		free(m_data);
+		m_data = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads the whole file in one go and checks every record points inside it
+// Only logs on failure, since this runs on the disk workers for async loads
+//
+bool CookedMeshFile::LoadFromFile(const std::string& filepath)
+{
+	PROFILE_SCOPE_CATEGORY("CookedMeshFile::LoadFromFile", "Assets");
+
+	if (m_data != nullptr)
+	{
+		free(m_data);
+		m_data = nullptr;
+	}
+
+	m_filepath = filepath;
+	m_data = (uint8_t*) FileReadBinaryToNewBuffer(filepath.c_str(), m_dataSize);
+
+	if (m_data == nullptr)
+	{
+		LogTaggedPrintf("ASSETS", "Error: CookedMeshFile couldn't open \"%s\"", filepath.c_str());
+		return false;
+	}
+
+	if (!ValidateData())
+	{
+		free(m_data);
+		m_data = nullptr;
+		m_dataSize = 0;
+
+		return false;
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of meshes in the loaded file
+//
+int CookedMeshFile::GetMeshCount() const
+{
+	if (m_data == nullptr)
+	{
+		return 0;
+	}
+
+	return (int) ((const CookedMeshFileHeader_t*) m_data)->meshCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Uploads the mesh's buffers from the file data as they are, with no conversion
+//
+void CookedMeshFile::UpdateMesh(int meshIndex, Mesh& out_mesh) const
+{
+	PROFILE_SCOPE_CATEGORY("CookedMeshFile::UpdateMesh", "Meshes");
+
+	const CookedMeshRecord_t* record = GetRecord(meshIndex);
+	ASSERT_OR_DIE(record != nullptr, Stringf("Error: CookedMeshFile::UpdateMesh() has no mesh %i in \"%s\"", meshIndex, m_filepath.c_str()));
+
+	const void* vertices = m_data + record->vertexDataOffset;
+	const unsigned int* indices = (const unsigned int*) (m_data + record->indexDataOffset);
+
+	switch (record->vertexType)
+	{
+	case COOKED_VERTEX_PCU:
+		out_mesh.SetVertices(record->vertexCount, (const Vertex3D_PCU*) vertices);
+		break;
+	case COOKED_VERTEX_LIT:
+		out_mesh.SetVertices(record->vertexCount, (const VertexLit*) vertices);
+		break;
+	case COOKED_VERTEX_SKINNED:
+		out_mesh.SetVertices(record->vertexCount, (const VertexSkinned*) vertices);
+		break;
+	default:
+		break;
+	}
+
+	out_mesh.SetIndices(record->indexCount, (record->indexCount > 0 ? indices : nullptr));
+	out_mesh.SetDrawInstruction((PrimitiveType) record->primitiveType, (record->usesIndices != 0), record->startIndex, record->elementCount);
+
+	if (record->vertexCount > 0)
+	{
+		Vector3 mins = Vector3(record->boundsMins[0], record->boundsMins[1], record->boundsMins[2]);
+		Vector3 maxs = Vector3(record->boundsMaxs[0], record->boundsMaxs[1], record->boundsMaxs[2]);
+
+		out_mesh.SetBounds(AABB3(mins, maxs));
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a new mesh for the record at the index
+//
+Mesh* CookedMeshFile::CreateMesh(int meshIndex) const
+{
+	Mesh* mesh = new Mesh();
+
+	// Cooked meshes are static, so can share their layout's arena
+	const CookedMeshRecord_t* record = GetRecord(meshIndex);
+	mesh->SetStoredInArena(record != nullptr && record->usesIndices != 0);
+
+	UpdateMesh(meshIndex, *mesh);
+
+	return mesh;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a new group with a mesh for each record
+//
+MeshGroup* CookedMeshFile::CreateMeshGroup() const
+{
+	MeshGroup* group = new MeshGroup();
+	UpdateMeshGroup(*group);
+
+	return group;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Rebuilds the group in place, reusing its meshes in order so pointers taken from it stay valid
+//
+void CookedMeshFile::UpdateMeshGroup(MeshGroup& out_group) const
+{
+	int meshCount = GetMeshCount();
+
+	for (int meshIndex = 0; meshIndex < meshCount; ++meshIndex)
+	{
+		if (meshIndex < out_group.GetMeshCount())
+		{
+			UpdateMesh(meshIndex, *out_group.GetMesh(meshIndex));
+		}
+		else
+		{
+			out_group.AddMeshUnique(CreateMesh(meshIndex));
+		}
+	}
+
+	while (out_group.GetMeshCount() > meshCount)
+	{
+		Mesh* extraMesh = out_group.GetMesh(meshCount);
+		out_group.RemoveMesh(meshCount);
+		delete extraMesh;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the file is a cooked mesh, by its extension
+//
+bool CookedMeshFile::IsCookedMeshPath(const std::string& filepath)
+{
+	const std::string extension = ".cmesh";
+
+	if (filepath.size() < extension.size())
+	{
+		return false;
+	}
+
+	return (filepath.compare(filepath.size() - extension.size(), extension.size(), extension) == 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the builders out as one file, converting every vertex to the given type now so loads don't have to
+// Builders must have finished building
+//
+bool CookedMeshFile::WriteToFile(const std::string& filepath, const std::vector<MeshBuilder*>& builders, eCookedVertexType vertexType)
+{
+	PROFILE_SCOPE_CATEGORY("CookedMeshFile::WriteToFile", "Assets");
+
+	int meshCount = (int) builders.size();
+	unsigned int vertexStride = GetStrideForVertexType(vertexType);
+
+	// Header and records go first, the records are filled in as the data is appended behind them
+	std::vector<uint8_t> buffer;
+	buffer.resize(sizeof(CookedMeshFileHeader_t) + sizeof(CookedMeshRecord_t) * meshCount, 0);
+
+	CookedMeshFileHeader_t header;
+	header.fourCC = COOKED_MESH_FOURCC;
+	header.version = COOKED_MESH_VERSION;
+	header.meshCount = (uint32_t) meshCount;
+	header.reserved = 0;
+	memcpy(buffer.data(), &header, sizeof(header));
+
+	for (int meshIndex = 0; meshIndex < meshCount; ++meshIndex)
+	{
+		MeshBuilder* mb = builders[meshIndex];
+		DrawInstruction instruction = mb->GetDrawInstruction();
+		const std::vector<unsigned int>& indices = mb->GetIndices();
+		AABB3 bounds = mb->GetBounds();
+
+		CookedMeshRecord_t record;
+		record.vertexType = (uint32_t) vertexType;
+		record.vertexStride = vertexStride;
+		record.vertexCount = (uint32_t) mb->GetVertexCount();
+		record.indexCount = (uint32_t) indices.size();
+		record.primitiveType = (uint32_t) instruction.m_primType;
+		record.usesIndices = (instruction.m_usingIndices ? 1 : 0);
+		record.startIndex = instruction.m_startIndex;
+		record.elementCount = instruction.m_elementCount;
+
+		record.boundsMins[0] = bounds.mins.x;
+		record.boundsMins[1] = bounds.mins.y;
+		record.boundsMins[2] = bounds.mins.z;
+		record.boundsMaxs[0] = bounds.maxs.x;
+		record.boundsMaxs[1] = bounds.maxs.y;
+		record.boundsMaxs[2] = bounds.maxs.z;
+
+		record.vertexDataOffset = AppendPadding(buffer);
+		switch (vertexType)
+		{
+		case COOKED_VERTEX_PCU:
+			AppendVertices<Vertex3D_PCU>(buffer, *mb);
+			break;
+		case COOKED_VERTEX_LIT:
+			AppendVertices<VertexLit>(buffer, *mb);
+			break;
+		case COOKED_VERTEX_SKINNED:
+			AppendVertices<VertexSkinned>(buffer, *mb);
+			break;
+		default:
+			ERROR_AND_DIE(Stringf("Error: CookedMeshFile::WriteToFile() given bad vertex type %i", (int) vertexType));
+			break;
+		}
+
+		record.indexDataOffset = AppendPadding(buffer);
+		if (indices.size() > 0)
+		{
+			const uint8_t* indexBytes = (const uint8_t*) indices.data();
+			buffer.insert(buffer.end(), indexBytes, indexBytes + indices.size() * sizeof(unsigned int));
+		}
+
+		memcpy(buffer.data() + sizeof(CookedMeshFileHeader_t) + sizeof(CookedMeshRecord_t) * meshIndex, &record, sizeof(record));
+	}
+
+	File file;
+	if (!file.Open(filepath.c_str(), "wb"))
+	{
+		LogTaggedPrintf("ASSETS", "Error: CookedMeshFile couldn't open \"%s\" for writing", filepath.c_str());
+		return false;
+	}
+
+	file.Write(buffer.data(), buffer.size());
+	return file.Close();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Checks the header and that every record's data lies inside the file, with the stride this build expects
+//
+bool CookedMeshFile::ValidateData()
+{
+	if (m_dataSize < sizeof(CookedMeshFileHeader_t))
+	{
+		LogTaggedPrintf("ASSETS", "Error: \"%s\" is too small to be a cooked mesh", m_filepath.c_str());
+		return false;
+	}
+
+	const CookedMeshFileHeader_t* header = (const CookedMeshFileHeader_t*) m_data;
+
+	if (header->fourCC != COOKED_MESH_FOURCC)
+	{
+		LogTaggedPrintf("ASSETS", "Error: \"%s\" isn't a cooked mesh", m_filepath.c_str());
+		return false;
+	}
+
+	if (header->version != COOKED_MESH_VERSION)
+	{
+		LogTaggedPrintf("ASSETS", "Error: \"%s\" was cooked as version %u, expected %u - it needs re-cooking", m_filepath.c_str(), header->version, COOKED_MESH_VERSION);
+		return false;
+	}
+
+	uint64_t recordsEnd = sizeof(CookedMeshFileHeader_t) + (uint64_t) sizeof(CookedMeshRecord_t) * header->meshCount;
+	if (recordsEnd > m_dataSize)
+	{
+		LogTaggedPrintf("ASSETS", "Error: \"%s\" is truncated, its %u mesh records don't fit", m_filepath.c_str(), header->meshCount);
+		return false;
+	}
+
+	for (uint32_t meshIndex = 0; meshIndex < header->meshCount; ++meshIndex)
+	{
+		const CookedMeshRecord_t* record = GetRecord((int) meshIndex);
+
+		if (record->vertexType >= NUM_COOKED_VERTEX_TYPES || record->vertexStride != GetStrideForVertexType((eCookedVertexType) record->vertexType))
+		{
+			LogTaggedPrintf("ASSETS", "Error: \"%s\" mesh %u has a vertex type or stride this build doesn't match - it needs re-cooking", m_filepath.c_str(), meshIndex);
+			return false;
+		}
+
+		if (record->primitiveType >= NUM_PRIMITIVE_TYPES)
+		{
+			LogTaggedPrintf("ASSETS", "Error: \"%s\" mesh %u has a bad primitive type", m_filepath.c_str(), meshIndex);
+			return false;
+		}
+
+		bool isAligned = (record->vertexDataOffset % COOKED_MESH_DATA_ALIGNMENT == 0) && (record->indexDataOffset % COOKED_MESH_DATA_ALIGNMENT == 0);
+		uint64_t vertexDataEnd = record->vertexDataOffset + (uint64_t) record->vertexCount * record->vertexStride;
+		uint64_t indexDataEnd = record->indexDataOffset + (uint64_t) record->indexCount * sizeof(unsigned int);
+
+		if (!isAligned || record->vertexDataOffset < recordsEnd || vertexDataEnd > m_dataSize || record->indexDataOffset < recordsEnd || indexDataEnd > m_dataSize)
+		{
+			LogTaggedPrintf("ASSETS", "Error: \"%s\" mesh %u has data outside the file", m_filepath.c_str(), meshIndex);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the record at the index, or nullptr if there isn't one
+//
+const CookedMeshRecord_t* CookedMeshFile::GetRecord(int meshIndex) const
+{
+	if (meshIndex < 0 || meshIndex >= GetMeshCount())
+	{
+		return nullptr;
+	}
+
+	return (const CookedMeshRecord_t*) (m_data + sizeof(CookedMeshFileHeader_t) + sizeof(CookedMeshRecord_t) * meshIndex);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the size of the vertex struct the type is uploaded as
+//
+static unsigned int GetStrideForVertexType(eCookedVertexType vertexType)
+{
+	switch (vertexType)
+	{
+	case COOKED_VERTEX_PCU:		return Vertex3D_PCU::LAYOUT.GetStride();
+	case COOKED_VERTEX_LIT:		return VertexLit::LAYOUT.GetStride();
+	case COOKED_VERTEX_SKINNED:	return VertexSkinned::LAYOUT.GetStride();
+	default:
+		return 0;
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Pads the buffer out to the data alignment, returning the offset the next data will start at
+//
+static size_t AppendPadding(std::vector<uint8_t>& buffer)
+{
+	size_t alignedSize = (buffer.size() + (COOKED_MESH_DATA_ALIGNMENT - 1)) & ~((size_t) COOKED_MESH_DATA_ALIGNMENT - 1);
+	buffer.resize(alignedSize, 0);
+
+	return alignedSize;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Converts the builder's vertices to the type and appends their bytes
+//
+template <typename VERT_TYPE>
+static void AppendVertices(std::vector<uint8_t>& buffer, MeshBuilder& mb)
+{
+	int vertexCount = mb.GetVertexCount();
+	size_t startOffset = buffer.size();
+	buffer.resize(startOffset + sizeof(VERT_TYPE) * vertexCount, 0);
+
+	for (int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		VERT_TYPE vertex = mb.GetVertex<VERT_TYPE>(vertexIndex);
+		memcpy(buffer.data() + startOffset + sizeof(VERT_TYPE) * vertexIndex, &vertex, sizeof(VERT_TYPE));
+	}
+}
@@ -0,0 +1,101 @@
+/************************************************************************/
+/* File: CookedMeshFile.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Reader for the binary mesh files written by the AssetCooker,
+/*				which hold vertices already in their GPU layout so loading
+/*				is one read and a straight buffer upload per mesh
+/************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+class Mesh;
+class MeshGroup;
+class MeshBuilder;
+
+// "CMSH" in the file, read as a little endian uint32
+#define COOKED_MESH_FOURCC (0x48534D43)
+
+// Bump whenever the layout below or any vertex struct changes, old files are rejected and need re-cooking
+#define COOKED_MESH_VERSION (1)
+
+// Vertex and index data start on this boundary from the start of the file
+#define COOKED_MESH_DATA_ALIGNMENT (16)
+
+enum eCookedVertexType
+{
+	COOKED_VERTEX_PCU,
+	COOKED_VERTEX_LIT,
+	COOKED_VERTEX_SKINNED,
+	NUM_COOKED_VERTEX_TYPES
+};
+
+struct CookedMeshFileHeader_t
+{
+	uint32_t fourCC;
+	uint32_t version;
+	uint32_t meshCount;
+	uint32_t reserved;
+};
+
+// One per mesh, directly after the header; offsets are from the start of the file
+struct CookedMeshRecord_t
+{
+	uint32_t vertexType;
+	uint32_t vertexStride;
+	uint32_t vertexCount;
+	uint32_t indexCount;
+
+	uint32_t primitiveType;
+	uint32_t usesIndices;
+	uint32_t startIndex;
+	uint32_t elementCount;
+
+	float boundsMins[3];
+	float boundsMaxs[3];
+
+	uint64_t vertexDataOffset;
+	uint64_t indexDataOffset;
+};
+
+
+class CookedMeshFile
+{
+public:
+	//-----Public Methods-----
+
+	CookedMeshFile() {}
+	~CookedMeshFile();
+
+	// Reads and validates the whole file, safe to call off the main thread
+	bool	LoadFromFile(const std::string& filepath);
+
+	int		GetMeshCount() const;
+
+	// Main thread only, these make the GL calls
+	void		UpdateMesh(int meshIndex, Mesh& out_mesh) const;
+	Mesh*		CreateMesh(int meshIndex) const;
+	MeshGroup*	CreateMeshGroup() const;
+	void		UpdateMeshGroup(MeshGroup& out_group) const;
+
+	static bool IsCookedMeshPath(const std::string& filepath);
+	static bool WriteToFile(const std::string& filepath, const std::vector<MeshBuilder*>& builders, eCookedVertexType vertexType);
+
+
+private:
+	//-----Private Methods-----
+
+	bool						ValidateData();
+	const CookedMeshRecord_t*	GetRecord(int meshIndex) const;
+
+
+private:
+	//-----Private Data-----
+
+	std::string		m_filepath;
+	uint8_t*		m_data = nullptr;
+	size_t			m_dataSize = 0;
+
+};
@@ -0,0 +1,411 @@
+/************************************************************************/
+/* File: CookedXmlFile.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the CookedXmlFile class
+/************************************************************************/
+#include "Engine/Core/File.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Assets/CookedXmlFile.hpp"
+#include "Engine/Core/Time/ProfileScoped.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
+#include <map>
+#include <vector>
+#include <string.h>
+
+// The layout is the file format, so it can't change without a version bump
+static_assert(sizeof(CookedXmlFileHeader_t) == 40, "CookedXmlFileHeader_t changed size, bump COOKED_XML_VERSION");
+static_assert(sizeof(CookedXmlElement_t) == 24, "CookedXmlElement_t changed size, bump COOKED_XML_VERSION");
+static_assert(sizeof(CookedXmlAttribute_t) == 8, "CookedXmlAttribute_t changed size, bump COOKED_XML_VERSION");
+
+// Strings are interned as they're written, names especially repeat on every element
+struct CookedXmlWriteState_t
+{
+	std::vector<CookedXmlElement_t>		elements;
+	std::vector<CookedXmlAttribute_t>	attributes;
+	std::vector<uint32_t>				stringOffsets;
+	std::vector<char>					stringData;
+	std::map<std::string, uint32_t>		stringIndices;
+};
+
+static uint32_t		InternString(CookedXmlWriteState_t& state, const char* text);
+static void			AppendElement(CookedXmlWriteState_t& state, const XMLElement* element, uint32_t parentIndex);
+
+template <typename T>
+static void			AppendArray(std::vector<uint8_t>& buffer, const std::vector<T>& values);
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+CookedXmlFile::~CookedXmlFile()
+{
+	Close();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Maps the file, which stays mapped until Close() as the records point into it
+//
+bool CookedXmlFile::LoadFromFile(const std::string& filepath)
+{
+	PROFILE_SCOPE_CATEGORY("CookedXmlFile::LoadFromFile", "Assets");
+
+	Close();
+
+	m_filepath = filepath;
+	m_file = new File();
+
+	if (!m_file->OpenMapped(filepath.c_str()))
+	{
+		Close();
+		return false;
+	}
+
+	if (!ValidateData())
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Unmaps the file
+//
+void CookedXmlFile::Close()
+{
+	if (m_file != nullptr)
+	{
+		m_file->Close();
+
+		delete m_file;
+		m_file = nullptr;
+	}
+
+	m_header = nullptr;
+	m_elements = nullptr;
+	m_attributes = nullptr;
+	m_stringOffsets = nullptr;
+	m_stringData = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Makes an element for each record, in order, appending each to its parent
+// Nothing is scanned or unescaped, the strings are copied in as they were cooked
+//
+XMLError CookedXmlFile::BuildDocument(XMLDocument& out_document) const
+{
+	PROFILE_SCOPE_CATEGORY("CookedXmlFile::BuildDocument", "Assets");
+
+	out_document.Clear();
+
+	if (m_header == nullptr)
+	{
+		return tinyxml2::XML_ERROR_FILE_READ_ERROR;
+	}
+
+	std::vector<XMLElement*> createdElements;
+	createdElements.resize(m_header->elementCount, nullptr);
+
+	for (uint32_t elementIndex = 0; elementIndex < m_header->elementCount; ++elementIndex)
+	{
+		const CookedXmlElement_t& record = m_elements[elementIndex];
+		XMLElement* element = out_document.NewElement(GetString(record.nameIndex));
+
+		for (uint32_t attributeIndex = record.firstAttribute; attributeIndex < record.firstAttribute + record.attributeCount; ++attributeIndex)
+		{
+			const CookedXmlAttribute_t& attribute = m_attributes[attributeIndex];
+			element->SetAttribute(GetString(attribute.nameIndex), GetString(attribute.valueIndex));
+		}
+
+		if (record.textIndex != COOKED_XML_NO_INDEX)
+		{
+			element->SetText(GetString(record.textIndex));
+		}
+
+		if (record.parentIndex == COOKED_XML_NO_INDEX)
+		{
+			out_document.InsertEndChild(element);
+		}
+		else
+		{
+			createdElements[record.parentIndex]->InsertEndChild(element);
+		}
+
+		createdElements[elementIndex] = element;
+	}
+
+	return tinyxml2::XML_SUCCESS;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the source the file was cooked from has changed since
+//
+bool CookedXmlFile::IsStale(const char* sourceData, size_t sourceSize) const
+{
+	if (m_header == nullptr)
+	{
+		return true;
+	}
+
+	return (m_header->sourceSize != (uint64_t) sourceSize || m_header->sourceHash != HashSource(sourceData, sourceSize));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the path the source's cooked file is at, the same with the extension swapped
+//
+std::string CookedXmlFile::GetCookedPath(const std::string& sourcePath)
+{
+	size_t dotIndex = sourcePath.find_last_of('.');
+	size_t slashIndex = sourcePath.find_last_of("/\\");
+
+	if (dotIndex == std::string::npos || (slashIndex != std::string::npos && dotIndex < slashIndex))
+	{
+		return sourcePath + ".cxml";
+	}
+
+	return sourcePath.substr(0, dotIndex) + ".cxml";
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// FNV-1a over the source bytes - hashing the mapped source is far cheaper than parsing it
+//
+uint64_t CookedXmlFile::HashSource(const char* sourceData, size_t sourceSize)
+{
+	uint64_t hash = 14695981039346656037ULL;
+
+	for (size_t byteIndex = 0; byteIndex < sourceSize; ++byteIndex)
+	{
+		hash ^= (uint64_t) (uint8_t) sourceData[byteIndex];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Flattens the document's elements in document order, then writes the header, records and strings
+//
+bool CookedXmlFile::WriteToFile(const std::string& filepath, const XMLDocument& document, const char* sourceData, size_t sourceSize)
+{
+	PROFILE_SCOPE_CATEGORY("CookedXmlFile::WriteToFile", "Assets");
+
+	CookedXmlWriteState_t state;
+
+	const XMLElement* rootElement = document.FirstChildElement();
+	while (rootElement != nullptr)
+	{
+		AppendElement(state, rootElement, COOKED_XML_NO_INDEX);
+		rootElement = rootElement->NextSiblingElement();
+	}
+
+	CookedXmlFileHeader_t header;
+	header.fourCC = COOKED_XML_FOURCC;
+	header.version = COOKED_XML_VERSION;
+	header.elementCount = (uint32_t) state.elements.size();
+	header.attributeCount = (uint32_t) state.attributes.size();
+	header.stringCount = (uint32_t) state.stringOffsets.size();
+	header.stringDataSize = (uint32_t) state.stringData.size();
+	header.sourceSize = (uint64_t) sourceSize;
+	header.sourceHash = HashSource(sourceData, sourceSize);
+
+	std::vector<uint8_t> buffer;
+	buffer.resize(sizeof(header));
+	memcpy(buffer.data(), &header, sizeof(header));
+
+	AppendArray(buffer, state.elements);
+	AppendArray(buffer, state.attributes);
+	AppendArray(buffer, state.stringOffsets);
+	AppendArray(buffer, state.stringData);
+
+	File file;
+	if (!file.Open(filepath.c_str(), "wb"))
+	{
+		LogTaggedPrintf("ASSETS", "Error: CookedXmlFile couldn't open \"%s\" for writing", filepath.c_str());
+		return false;
+	}
+
+	file.Write(buffer.data(), buffer.size());
+	return file.Close();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Checks the header, that every array fits in the file, and that every index the records hold is in range
+//
+bool CookedXmlFile::ValidateData()
+{
+	size_t dataSize = m_file->GetSize();
+	const char* data = m_file->GetData();
+
+	if (dataSize < sizeof(CookedXmlFileHeader_t))
+	{
+		LogTaggedPrintf("ASSETS", "Error: \"%s\" is too small to be cooked xml", m_filepath.c_str());
+		return false;
+	}
+
+	const CookedXmlFileHeader_t* header = (const CookedXmlFileHeader_t*) data;
+
+	if (header->fourCC != COOKED_XML_FOURCC)
+	{
+		LogTaggedPrintf("ASSETS", "Error: \"%s\" isn't cooked xml", m_filepath.c_str());
+		return false;
+	}
+
+	if (header->version != COOKED_XML_VERSION)
+	{
+		LogTaggedPrintf("ASSETS", "Error: \"%s\" was cooked as version %u, expected %u - it needs re-cooking", m_filepath.c_str(), header->version, COOKED_XML_VERSION);
+		return false;
+	}
+
+	uint64_t elementsOffset		= sizeof(CookedXmlFileHeader_t);
+	uint64_t attributesOffset	= elementsOffset + (uint64_t) sizeof(CookedXmlElement_t) * header->elementCount;
+	uint64_t stringsOffset		= attributesOffset + (uint64_t) sizeof(CookedXmlAttribute_t) * header->attributeCount;
+	uint64_t stringDataOffset	= stringsOffset + (uint64_t) sizeof(uint32_t) * header->stringCount;
+	uint64_t fileEnd			= stringDataOffset + header->stringDataSize;
+
+	if (fileEnd != dataSize || header->stringDataSize == 0 || data[fileEnd - 1] != '\0')
+	{
+		LogTaggedPrintf("ASSETS", "Error: \"%s\" is truncated or has trailing data", m_filepath.c_str());
+		return false;
+	}
+
+	// Point in now, the checks below go through them
+	m_header		= header;
+	m_elements		= (const CookedXmlElement_t*) (data + elementsOffset);
+	m_attributes	= (const CookedXmlAttribute_t*) (data + attributesOffset);
+	m_stringOffsets	= (const uint32_t*) (data + stringsOffset);
+	m_stringData	= data + stringDataOffset;
+
+	for (uint32_t stringIndex = 0; stringIndex < header->stringCount; ++stringIndex)
+	{
+		if (m_stringOffsets[stringIndex] >= header->stringDataSize)
+		{
+			LogTaggedPrintf("ASSETS", "Error: \"%s\" string %u is outside the file", m_filepath.c_str(), stringIndex);
+			return false;
+		}
+	}
+
+	for (uint32_t elementIndex = 0; elementIndex < header->elementCount; ++elementIndex)
+	{
+		const CookedXmlElement_t& element = m_elements[elementIndex];
+
+		bool areStringsValid = (element.nameIndex < header->stringCount) && (element.textIndex == COOKED_XML_NO_INDEX || element.textIndex < header->stringCount);
+		bool isParentValid = (element.parentIndex == COOKED_XML_NO_INDEX || element.parentIndex < elementIndex);
+		bool areAttributesValid = ((uint64_t) element.firstAttribute + element.attributeCount <= header->attributeCount);
+
+		if (!areStringsValid || !isParentValid || !areAttributesValid)
+		{
+			LogTaggedPrintf("ASSETS", "Error: \"%s\" element %u is malformed", m_filepath.c_str(), elementIndex);
+			return false;
+		}
+	}
+
+	for (uint32_t attributeIndex = 0; attributeIndex < header->attributeCount; ++attributeIndex)
+	{
+		const CookedXmlAttribute_t& attribute = m_attributes[attributeIndex];
+
+		if (attribute.nameIndex >= header->stringCount || attribute.valueIndex >= header->stringCount)
+		{
+			LogTaggedPrintf("ASSETS", "Error: \"%s\" attribute %u is malformed", m_filepath.c_str(), attributeIndex);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the string at the index, null terminated in the file
+//
+const char* CookedXmlFile::GetString(uint32_t stringIndex) const
+{
+	return m_stringData + m_stringOffsets[stringIndex];
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the index of the string, adding it if it's the first of its kind
+//
+static uint32_t InternString(CookedXmlWriteState_t& state, const char* text)
+{
+	std::string key = (text != nullptr ? text : "");
+
+	std::map<std::string, uint32_t>::const_iterator itr = state.stringIndices.find(key);
+	if (itr != state.stringIndices.end())
+	{
+		return itr->second;
+	}
+
+	uint32_t stringIndex = (uint32_t) state.stringOffsets.size();
+	state.stringOffsets.push_back((uint32_t) state.stringData.size());
+	state.stringData.insert(state.stringData.end(), key.c_str(), key.c_str() + key.size() + 1);
+	state.stringIndices[key] = stringIndex;
+
+	return stringIndex;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Appends the element and its attributes, then its children after it
+//
+static void AppendElement(CookedXmlWriteState_t& state, const XMLElement* element, uint32_t parentIndex)
+{
+	uint32_t elementIndex = (uint32_t) state.elements.size();
+
+	CookedXmlElement_t record;
+	record.nameIndex = InternString(state, element->Name());
+	record.textIndex = (element->GetText() != nullptr ? InternString(state, element->GetText()) : COOKED_XML_NO_INDEX);
+	record.parentIndex = parentIndex;
+	record.firstAttribute = (uint32_t) state.attributes.size();
+	record.attributeCount = 0;
+	record.reserved = 0;
+
+	const XMLAttribute* attribute = element->FirstAttribute();
+	while (attribute != nullptr)
+	{
+		CookedXmlAttribute_t attributeRecord;
+		attributeRecord.nameIndex = InternString(state, attribute->Name());
+		attributeRecord.valueIndex = InternString(state, attribute->Value());
+
+		state.attributes.push_back(attributeRecord);
+		record.attributeCount++;
+
+		attribute = attribute->Next();
+	}
+
+	state.elements.push_back(record);
+
+	const XMLElement* child = element->FirstChildElement();
+	while (child != nullptr)
+	{
+		AppendElement(state, child, elementIndex);
+		child = child->NextSiblingElement();
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Appends the values' bytes to the buffer
+//
+template <typename T>
+static void AppendArray(std::vector<uint8_t>& buffer, const std::vector<T>& values)
+{
+	if (values.size() == 0)
+	{
+		return;
+	}
+
+	const uint8_t* bytes = (const uint8_t*) values.data();
+	buffer.insert(buffer.end(), bytes, bytes + values.size() * sizeof(T));
+}
@@ -0,0 +1,98 @@
+/************************************************************************/
+/* File: CookedXmlFile.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Flat binary form of an XML data file, written by the
+/*				AssetCooker and read in place from a mapping, so loading
+/*				a definition file skips the text parse
+/************************************************************************/
+#pragma once
+#include "Engine/Core/Utility/XmlUtilities.hpp"
+#include <string>
+#include <stdint.h>
+
+class File;
+
+// "CXML" in the file, read as a little endian uint32
+#define COOKED_XML_FOURCC (0x4C4D5843)
+
+// Bump whenever the layout below changes, old files are rejected and the source is parsed instead
+#define COOKED_XML_VERSION (1)
+
+#define COOKED_XML_NO_INDEX (0xFFFFFFFF)
+
+// Followed by the element records, the attribute records, the string offsets and then the string data
+struct CookedXmlFileHeader_t
+{
+	uint32_t fourCC;
+	uint32_t version;
+	uint32_t elementCount;
+	uint32_t attributeCount;
+	uint32_t stringCount;
+	uint32_t stringDataSize;
+	uint64_t sourceSize;		// Of the XML the file was cooked from, to tell when it's stale
+	uint64_t sourceHash;
+};
+
+// Elements are in document order, so every element's parent comes before it and its children
+// are in order after it; attributes are in each element's order, a range per element
+struct CookedXmlElement_t
+{
+	uint32_t nameIndex;
+	uint32_t textIndex;			// COOKED_XML_NO_INDEX if the element has no text
+	uint32_t parentIndex;		// COOKED_XML_NO_INDEX for the root elements
+	uint32_t firstAttribute;
+	uint32_t attributeCount;
+	uint32_t reserved;
+};
+
+struct CookedXmlAttribute_t
+{
+	uint32_t nameIndex;
+	uint32_t valueIndex;
+};
+
+
+class CookedXmlFile
+{
+public:
+	//-----Public Methods-----
+
+	CookedXmlFile() {}
+	~CookedXmlFile();
+
+	// Maps the file and checks every record and string lies inside it
+	bool		LoadFromFile(const std::string& filepath);
+	void		Close();
+
+	// Fills the document with the cooked elements, so it reads like the parsed source did
+	XMLError	BuildDocument(XMLDocument& out_document) const;
+
+	bool		IsStale(const char* sourceData, size_t sourceSize) const;
+
+	static std::string	GetCookedPath(const std::string& sourcePath);		// Same path, .cxml in place of the extension
+	static uint64_t		HashSource(const char* sourceData, size_t sourceSize);
+
+	// Writes the document's elements, attributes and text; comments and declarations are dropped
+	static bool			WriteToFile(const std::string& filepath, const XMLDocument& document, const char* sourceData, size_t sourceSize);
+
+
+private:
+	//-----Private Methods-----
+
+	bool		ValidateData();
+	const char*	GetString(uint32_t stringIndex) const;
+
+
+private:
+	//-----Private Data-----
+
+	std::string						m_filepath;
+	File*							m_file = nullptr;
+	const CookedXmlFileHeader_t*	m_header = nullptr;
+	const CookedXmlElement_t*		m_elements = nullptr;
+	const CookedXmlAttribute_t*		m_attributes = nullptr;
+	const uint32_t*					m_stringOffsets = nullptr;
+	const char*						m_stringData = nullptr;
+
+};
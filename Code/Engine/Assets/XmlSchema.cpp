@@ -0,0 +1,289 @@
+/************************************************************************/
+/* File: XmlSchema.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the XmlSchema class
+/************************************************************************/
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Assets/XmlSchema.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+static bool IsNumberText(const std::string& text, bool mustBeInt);
+static bool AreDelimitedNumbers(const char* valueText, char delimiter, int minCount, int maxCount, bool mustBeInts);
+
+
+//-----------------------------------------------------------------------------------------------
+// Loads the elements and their attributes from the schema file
+//
+bool XmlSchema::LoadFromFile(const std::string& filepath)
+{
+	XMLDocument document;
+	XMLError error = LoadXmlDocument(document, filepath);
+
+	if (error != tinyxml2::XML_SUCCESS)
+	{
+		LogTaggedPrintf("ASSETS", "Error: Couldn't load XML schema \"%s\"", filepath.c_str());
+		return false;
+	}
+
+	m_elements.clear();
+
+	const XMLElement* rootElement = document.RootElement();
+	const XMLElement* elementElement = (rootElement != nullptr ? rootElement->FirstChildElement("Element") : nullptr);
+
+	while (elementElement != nullptr)
+	{
+		std::string elementName = ParseXmlAttribute(*elementElement, "name", "");
+		XmlSchemaElement_t& schemaElement = m_elements[elementName];
+
+		const XMLElement* attributeElement = elementElement->FirstChildElement("Attribute");
+		while (attributeElement != nullptr)
+		{
+			XmlSchemaAttribute_t schemaAttribute;
+			schemaAttribute.name = ParseXmlAttribute(*attributeElement, "name", "");
+			schemaAttribute.type = GetValueTypeFromText(ParseXmlAttribute(*attributeElement, "type", "string"));
+			schemaAttribute.isRequired = ParseXmlAttribute(*attributeElement, "required", false);
+
+			if (schemaAttribute.type == NUM_XML_VALUE_TYPES)
+			{
+				LogTaggedPrintf("ASSETS", "Error: XML schema \"%s\" gives attribute \"%s\" on \"%s\" an unknown type", filepath.c_str(), schemaAttribute.name.c_str(), elementName.c_str());
+				return false;
+			}
+
+			schemaElement.attributes.push_back(schemaAttribute);
+			attributeElement = attributeElement->NextSiblingElement("Attribute");
+		}
+
+		elementElement = elementElement->NextSiblingElement("Element");
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Checks every element in the document, logging all problems rather than stopping at the first
+//
+bool XmlSchema::Validate(const XMLDocument& document, const std::string& documentName) const
+{
+	bool isValid = true;
+
+	const XMLElement* rootElement = document.FirstChildElement();
+	while (rootElement != nullptr)
+	{
+		isValid = ValidateElement(*rootElement, documentName) && isValid;
+		rootElement = rootElement->NextSiblingElement();
+	}
+
+	return isValid;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if ParseXmlAttribute() for the type would read the whole text, not just fall back on
+// whatever parts of it happen to be numbers
+//
+bool XmlSchema::IsValueOfType(const char* valueText, eXmlValueType type)
+{
+	std::string text = valueText;
+
+	switch (type)
+	{
+	case XML_VALUE_STRING:
+		return true;
+	case XML_VALUE_INT:
+		return IsNumberText(text, true);
+	case XML_VALUE_UINT:
+		return IsNumberText(text, true) && (text.find('-') == std::string::npos);
+	case XML_VALUE_CHAR:
+		return (text.size() > 0);
+	case XML_VALUE_BOOL:
+	{
+		std::string lowerText = text;
+		for (int charIndex = 0; charIndex < (int) lowerText.size(); ++charIndex)
+		{
+			lowerText[charIndex] = (char) tolower(lowerText[charIndex]);
+		}
+
+		return (lowerText == "true" || lowerText == "false" || IsNumberText(text, true));
+	}
+	case XML_VALUE_FLOAT:
+		return IsNumberText(text, false);
+	case XML_VALUE_RGBA:
+	{
+		// Same delimiter choice as Rgba::SetFromText()
+		char delimiter = (text.find(',') != std::string::npos ? ',' : ' ');
+		bool areInts = (text.find('.') == std::string::npos);
+		return AreDelimitedNumbers(valueText, delimiter, 3, 4, areInts);
+	}
+	case XML_VALUE_VECTOR2:
+		return AreDelimitedNumbers(valueText, ',', 2, 2, false);
+	case XML_VALUE_VECTOR3:
+		return AreDelimitedNumbers(valueText, ',', 3, 3, false);
+	case XML_VALUE_INTVECTOR2:
+		return AreDelimitedNumbers(valueText, ',', 2, 2, true);
+	case XML_VALUE_INTVECTOR3:
+		return AreDelimitedNumbers(valueText, ',', 3, 3, true);
+	case XML_VALUE_INTRANGE:
+		return AreDelimitedNumbers(valueText, '~', 1, 2, true);
+	case XML_VALUE_FLOATRANGE:
+		return AreDelimitedNumbers(valueText, '~', 1, 2, false);
+	case XML_VALUE_AABB2:
+		return AreDelimitedNumbers(valueText, ',', 4, 4, false);
+	default:
+		return false;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the type the schema text names, or NUM_XML_VALUE_TYPES if it isn't one
+//
+eXmlValueType XmlSchema::GetValueTypeFromText(const std::string& typeText)
+{
+	static const char* s_typeNames[NUM_XML_VALUE_TYPES] =
+	{
+		"string", "int", "uint", "char", "bool", "float", "rgba", "vector2", "vector3", "intvector2", "intvector3", "intrange", "floatrange", "aabb2"
+	};
+
+	for (int typeIndex = 0; typeIndex < NUM_XML_VALUE_TYPES; ++typeIndex)
+	{
+		if (typeText == s_typeNames[typeIndex])
+		{
+			return (eXmlValueType) typeIndex;
+		}
+	}
+
+	return NUM_XML_VALUE_TYPES;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Checks the element's name and attributes against the schema, then its children
+//
+bool XmlSchema::ValidateElement(const XMLElement& element, const std::string& documentName) const
+{
+	bool isValid = true;
+	const char* elementName = element.Name();
+
+	std::map<std::string, XmlSchemaElement_t>::const_iterator itr = m_elements.find(elementName);
+	if (itr == m_elements.end())
+	{
+		LogTaggedPrintf("ASSETS", "Error: \"%s\" has element \"%s\" (line %i), which the schema doesn't have", documentName.c_str(), elementName, element.GetLineNum());
+		return false;
+	}
+
+	const std::vector<XmlSchemaAttribute_t>& schemaAttributes = itr->second.attributes;
+
+	// Every attribute is listed and parses as its type
+	const XMLAttribute* attribute = element.FirstAttribute();
+	while (attribute != nullptr)
+	{
+		const XmlSchemaAttribute_t* schemaAttribute = nullptr;
+		for (int attributeIndex = 0; attributeIndex < (int) schemaAttributes.size(); ++attributeIndex)
+		{
+			if (schemaAttributes[attributeIndex].name == attribute->Name())
+			{
+				schemaAttribute = &schemaAttributes[attributeIndex];
+				break;
+			}
+		}
+
+		if (schemaAttribute == nullptr)
+		{
+			LogTaggedPrintf("ASSETS", "Error: \"%s\" element \"%s\" (line %i) has attribute \"%s\", which the schema doesn't list", documentName.c_str(), elementName, element.GetLineNum(), attribute->Name());
+			isValid = false;
+		}
+		else if (!IsValueOfType(attribute->Value(), schemaAttribute->type))
+		{
+			LogTaggedPrintf("ASSETS", "Error: \"%s\" element \"%s\" (line %i) attribute \"%s\" has value \"%s\", which isn't its type", documentName.c_str(), elementName, element.GetLineNum(), attribute->Name(), attribute->Value());
+			isValid = false;
+		}
+
+		attribute = attribute->Next();
+	}
+
+	// Required ones are all there
+	for (int attributeIndex = 0; attributeIndex < (int) schemaAttributes.size(); ++attributeIndex)
+	{
+		const XmlSchemaAttribute_t& schemaAttribute = schemaAttributes[attributeIndex];
+
+		if (schemaAttribute.isRequired && element.Attribute(schemaAttribute.name.c_str()) == nullptr)
+		{
+			LogTaggedPrintf("ASSETS", "Error: \"%s\" element \"%s\" (line %i) is missing required attribute \"%s\"", documentName.c_str(), elementName, element.GetLineNum(), schemaAttribute.name.c_str());
+			isValid = false;
+		}
+	}
+
+	const XMLElement* child = element.FirstChildElement();
+	while (child != nullptr)
+	{
+		isValid = ValidateElement(*child, documentName) && isValid;
+		child = child->NextSiblingElement();
+	}
+
+	return isValid;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns true if the text is a single number, allowing the whitespace around it the parsers skip
+//
+static bool IsNumberText(const std::string& text, bool mustBeInt)
+{
+	const char* start = text.c_str();
+	while (isspace((unsigned char) *start))
+	{
+		start++;
+	}
+
+	if (*start == '\0')
+	{
+		return false;
+	}
+
+	char* end = nullptr;
+	if (mustBeInt)
+	{
+		strtol(start, &end, 10);
+	}
+	else
+	{
+		strtod(start, &end);
+	}
+
+	while (isspace((unsigned char) *end))
+	{
+		end++;
+	}
+
+	return (end != start && *end == '\0');
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns true if the text is between minCount and maxCount numbers split by the delimiter
+//
+static bool AreDelimitedNumbers(const char* valueText, char delimiter, int minCount, int maxCount, bool mustBeInts)
+{
+	std::vector<std::string> tokens = Tokenize(valueText, delimiter);
+	int tokenCount = (int) tokens.size();
+
+	if (tokenCount < minCount || tokenCount > maxCount)
+	{
+		return false;
+	}
+
+	for (int tokenIndex = 0; tokenIndex < tokenCount; ++tokenIndex)
+	{
+		if (!IsNumberText(tokens[tokenIndex], mustBeInts))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,80 @@
+/************************************************************************/
+/* File: XmlSchema.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: The elements and typed attributes a kind of XML data file
+/*				may have, checked by the AssetCooker so bad data fails at
+/*				cook time instead of parsing to defaults at runtime
+/************************************************************************/
+#pragma once
+#include "Engine/Core/Utility/XmlUtilities.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+// One per ParseXmlAttribute() overload, named in the schema by the text in the comments
+enum eXmlValueType
+{
+	XML_VALUE_STRING,		// "string"
+	XML_VALUE_INT,			// "int"
+	XML_VALUE_UINT,			// "uint"
+	XML_VALUE_CHAR,			// "char"
+	XML_VALUE_BOOL,			// "bool"
+	XML_VALUE_FLOAT,		// "float"
+	XML_VALUE_RGBA,			// "rgba"
+	XML_VALUE_VECTOR2,		// "vector2"
+	XML_VALUE_VECTOR3,		// "vector3"
+	XML_VALUE_INTVECTOR2,	// "intvector2"
+	XML_VALUE_INTVECTOR3,	// "intvector3"
+	XML_VALUE_INTRANGE,		// "intrange"
+	XML_VALUE_FLOATRANGE,	// "floatrange"
+	XML_VALUE_AABB2,		// "aabb2"
+	NUM_XML_VALUE_TYPES
+};
+
+struct XmlSchemaAttribute_t
+{
+	std::string		name;
+	eXmlValueType	type = XML_VALUE_STRING;
+	bool			isRequired = false;
+};
+
+struct XmlSchemaElement_t
+{
+	std::vector<XmlSchemaAttribute_t> attributes;
+};
+
+// Schema files look like:
+//	<XmlSchema>
+//		<Element name="SpriteAnim">
+//			<Attribute name="name" type="string" required="true"/>
+//			<Attribute name="fps" type="float"/>
+//		</Element>
+//	</XmlSchema>
+class XmlSchema
+{
+public:
+	//-----Public Methods-----
+
+	bool LoadFromFile(const std::string& filepath);
+
+	// Logs every element the schema doesn't have, attribute it doesn't list, required attribute that's
+	// missing and value that won't parse as its type; returns true if there were none
+	bool Validate(const XMLDocument& document, const std::string& documentName) const;
+
+	static bool IsValueOfType(const char* valueText, eXmlValueType type);
+	static eXmlValueType GetValueTypeFromText(const std::string& typeText);
+
+
+private:
+	//-----Private Methods-----
+
+	bool ValidateElement(const XMLElement& element, const std::string& documentName) const;
+
+
+private:
+	//-----Private Data-----
+
+	std::map<std::string, XmlSchemaElement_t> m_elements;
+
+};
@@ -1,5 +1,7 @@
 #include "Engine/Assets/AssetDB.hpp"
+#include "Engine/Math/Vector3.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/LogSystem.hpp"
 #include "Engine/Audio/AudioSystem.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Rendering/Core/Renderer.hpp"
@@ -31,12 +33,34 @@
 // Singleton AudioSystem instance
 AudioSystem* AudioSystem::s_instance = nullptr;
 
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Both the engine and FMOD are left handed and y up by default, so vectors convert directly
+//
+static FMOD_VECTOR ToFMODVector(const Vector3& vector)
+{
+	FMOD_VECTOR fmodVector;
+	fmodVector.x = vector.x;
+	fmodVector.y = vector.y;
+	fmodVector.z = vector.z;
+
+	return fmodVector;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Initialization code based on example from "FMOD Studio Programmers API for Windows"
 //
 AudioSystem::AudioSystem()
 	: m_fmodSystem( nullptr )
 {
+	// Headless runs keep the system without FMOD, so sounds are all missing and nothing plays
+	if (IsEngineHeadless())
+	{
+		LogTaggedPrintf("AUDIO", "Running headless, FMOD not initialized");
+		return;
+	}
+
 	FMOD_RESULT result;
 	result = FMOD::System_Create( &m_fmodSystem );
 	ValidateResult( result );
@@ -44,14 +68,31 @@ AudioSystem::AudioSystem()
 	result = m_fmodSystem->setDSPBufferSize(64, 64);
 	ValidateResult(result);
 
-	result = m_fmodSystem->init( 512, FMOD_INIT_NORMAL, nullptr );
+	// Must be set before init()
+	result = m_fmodSystem->setSoftwareChannels(AUDIO_MAX_REAL_VOICES);
+	ValidateResult(result);
+
+	result = m_fmodSystem->init( AUDIO_MAX_VIRTUAL_VOICES, FMOD_INIT_NORMAL | FMOD_INIT_VOL0_BECOMES_VIRTUAL, nullptr );
 	ValidateResult( result );
+
+	FMOD_ADVANCEDSETTINGS advancedSettings;
+	memset(&advancedSettings, 0, sizeof(advancedSettings));
+	advancedSettings.cbSize = sizeof(advancedSettings);
+	advancedSettings.vol0virtualvol = AUDIO_VIRTUAL_VOLUME_THRESHOLD;
+
+	result = m_fmodSystem->setAdvancedSettings(&advancedSettings);
+	ValidateResult(result);
 }
 
 
 //-----------------------------------------------------------------------------------------------
 AudioSystem::~AudioSystem()
 {
+	if (m_fmodSystem == nullptr)
+	{
+		return;
+	}
+
 	FMOD_RESULT result = m_fmodSystem->release();
 	ValidateResult( result );
 
@@ -85,9 +126,42 @@ AudioSystem* AudioSystem::GetInstance()
 
 
 //-----------------------------------------------------------------------------------------------
+// Also checks on the sounds loading in the background, dropping any that failed
+//
 void AudioSystem::BeginFrame()
 {
+	if (m_fmodSystem == nullptr)
+	{
+		return;
+	}
+
 	m_fmodSystem->update();
+
+	for (int pendingIndex = (int) m_pendingSounds.size() - 1; pendingIndex >= 0; --pendingIndex)
+	{
+		SoundID soundID = m_pendingSounds[pendingIndex];
+		FMOD::Sound* sound = m_registeredSounds[soundID];
+
+		FMOD_OPENSTATE openState;
+		FMOD_RESULT result = sound->getOpenState(&openState, nullptr, nullptr, nullptr);
+
+		if (openState == FMOD_OPENSTATE_LOADING || openState == FMOD_OPENSTATE_CONNECTING)
+		{
+			continue;
+		}
+
+		if (openState == FMOD_OPENSTATE_ERROR)
+		{
+			LogTaggedPrintf("AUDIO", "Sound %u failed to load in the background, FMOD error code %i", (unsigned int) soundID, (int) result);
+
+			// Stays registered so the ID stays valid, it just won't play
+			sound->release();
+			m_registeredSounds[soundID] = nullptr;
+		}
+
+		m_pendingSounds[pendingIndex] = m_pendingSounds.back();
+		m_pendingSounds.pop_back();
+	}
 }
 
 
@@ -111,22 +185,34 @@ FMOD::Sound* AudioSystem::GetSoundForSoundID(SoundID soundID)
 
 
 //-----------------------------------------------------------------------------------------------
-SoundID AudioSystem::CreateOrGetSound( const std::string& soundFilePath )
+// The file's first load decides whether it's streamed or loaded async
+//
+SoundID AudioSystem::CreateOrGetSound( const std::string& soundFilePath, bool isStreamed, bool loadAsync )
 {
 	std::map< std::string, SoundID >::iterator found = m_registeredSoundIDs.find( soundFilePath );
 	if( found != m_registeredSoundIDs.end() )
 	{
 		return found->second;
 	}
-	else
+	else if (m_fmodSystem != nullptr)
 	{
+		FMOD_MODE mode = FMOD_DEFAULT;
+		mode |= (isStreamed ? FMOD_CREATESTREAM : 0);
+		mode |= (loadAsync ? FMOD_NONBLOCKING : 0);
+
 		FMOD::Sound* newSound = nullptr;
-		m_fmodSystem->createSound( soundFilePath.c_str(), FMOD_DEFAULT, nullptr, &newSound );
+		m_fmodSystem->createSound( soundFilePath.c_str(), mode, nullptr, &newSound );
 		if( newSound )
 		{
 			SoundID newSoundID = m_registeredSounds.size();
 			m_registeredSoundIDs[ soundFilePath ] = newSoundID;
 			m_registeredSounds.push_back( newSound );
+
+			if (loadAsync)
+			{
+				m_pendingSounds.push_back(newSoundID);
+			}
+
 			return newSoundID;
 		}
 	}
@@ -148,33 +234,64 @@ SoundID AudioSystem::GetSound(const std::string& soundFilePath)
 }
 
 
-//-----------------------------------------------------------------------------------------------
-SoundPlaybackID AudioSystem::PlaySound( SoundID soundID, bool isLooped, float volume, float balance, float speed, bool isPaused )
+// Returns true if the sound has loaded and can play, false while loading in the background or if it failed
+//
+bool AudioSystem::IsSoundReady(SoundID soundID) const
 {
 	size_t numSounds = m_registeredSounds.size();
-	if( soundID < 0 || soundID >= numSounds )
-		return MISSING_SOUND_ID;
+	if (soundID < 0 || soundID >= numSounds || m_registeredSounds[soundID] == nullptr)
+		return false;
 
-	FMOD::Sound* sound = m_registeredSounds[ soundID ];
-	if( !sound )
-		return MISSING_SOUND_ID;
+	FMOD_OPENSTATE openState;
+	m_registeredSounds[soundID]->getOpenState(&openState, nullptr, nullptr, nullptr);
 
-	FMOD::Channel* channelAssignedToSound = nullptr;
-	m_fmodSystem->playSound( sound, nullptr, isPaused, &channelAssignedToSound );
+	return (openState != FMOD_OPENSTATE_LOADING && openState != FMOD_OPENSTATE_CONNECTING && openState != FMOD_OPENSTATE_ERROR);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of sounds still loading in the background, as of the start of the frame
+//
+int AudioSystem::GetPendingLoadCount() const
+{
+	return (int) m_pendingSounds.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Lower priority numbers are kept real over higher ones once the real voices are all in use
+//
+SoundPlaybackID AudioSystem::PlaySound( SoundID soundID, bool isLooped, float volume, float balance, float speed, bool isPaused, int priority )
+{
+	FMOD::Channel* channelAssignedToSound = StartChannel(soundID, (isLooped ? FMOD_LOOP_NORMAL : FMOD_LOOP_OFF) | FMOD_2D, isLooped, volume, speed, priority);
 	if( channelAssignedToSound )
 	{
-		int loopCount = isLooped ? -1 : 0;
-		unsigned int playbackMode = isLooped ? FMOD_LOOP_NORMAL : FMOD_LOOP_OFF;
-		float frequency;
-		channelAssignedToSound->setMode(playbackMode);
-		channelAssignedToSound->getFrequency( &frequency );
-		channelAssignedToSound->setFrequency( frequency * speed );
-		channelAssignedToSound->setVolume( volume );
 		channelAssignedToSound->setPan( balance );
-		channelAssignedToSound->setLoopCount( loopCount );
+		channelAssignedToSound->setPaused( isPaused );
+	}
+
+	return (channelAssignedToSound != nullptr ? (SoundPlaybackID) channelAssignedToSound : MISSING_SOUND_ID);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Plays the sound in 3D, attenuated by its distance to the listener - past AUDIO_3D_MAX_DISTANCE it's
+// silent, so virtual
+//
+SoundPlaybackID AudioSystem::PlaySoundAtPosition( SoundID soundID, const Vector3& position, bool isLooped, float volume, float speed, int priority )
+{
+	FMOD_MODE mode = (isLooped ? FMOD_LOOP_NORMAL : FMOD_LOOP_OFF) | FMOD_3D | FMOD_3D_LINEARSQUAREROLLOFF;
+
+	FMOD::Channel* channelAssignedToSound = StartChannel(soundID, mode, isLooped, volume, speed, priority);
+	if( channelAssignedToSound )
+	{
+		FMOD_VECTOR fmodPosition = ToFMODVector(position);
+		channelAssignedToSound->set3DMinMaxDistance( AUDIO_3D_MIN_DISTANCE, AUDIO_3D_MAX_DISTANCE );
+		channelAssignedToSound->set3DAttributes( &fmodPosition, nullptr );
+		channelAssignedToSound->setPaused( false );
 	}
 
-	return (SoundPlaybackID) channelAssignedToSound;
+	return (channelAssignedToSound != nullptr ? (SoundPlaybackID) channelAssignedToSound : MISSING_SOUND_ID);
 }
 
 
@@ -200,7 +317,11 @@ void AudioSystem::StopSound( SoundPlaybackID soundPlaybackID )
 {
 	if( soundPlaybackID == MISSING_SOUND_ID )
 	{
-		ERROR_RECOVERABLE( "WARNING: attempt to set volume on missing sound playback ID!" );
+		if (m_fmodSystem != nullptr)
+		{
+			ERROR_RECOVERABLE( "WARNING: attempt to set volume on missing sound playback ID!" );
+		}
+
 		return;
 	}
 
@@ -216,7 +337,11 @@ void AudioSystem::SetSoundPlaybackVolume( SoundPlaybackID soundPlaybackID, float
 {
 	if( soundPlaybackID == MISSING_SOUND_ID )
 	{
-		ERROR_RECOVERABLE( "WARNING: attempt to set volume on missing sound playback ID!" );
+		if (m_fmodSystem != nullptr)
+		{
+			ERROR_RECOVERABLE( "WARNING: attempt to set volume on missing sound playback ID!" );
+		}
+
 		return;
 	}
 
@@ -232,7 +357,11 @@ void AudioSystem::SetSoundPlaybackBalance( SoundPlaybackID soundPlaybackID, floa
 {
 	if( soundPlaybackID == MISSING_SOUND_ID )
 	{
-		ERROR_RECOVERABLE( "WARNING: attempt to set balance on missing sound playback ID!" );
+		if (m_fmodSystem != nullptr)
+		{
+			ERROR_RECOVERABLE( "WARNING: attempt to set balance on missing sound playback ID!" );
+		}
+
 		return;
 	}
 
@@ -250,7 +379,11 @@ void AudioSystem::SetSoundPlaybackSpeed( SoundPlaybackID soundPlaybackID, float
 {
 	if( soundPlaybackID == MISSING_SOUND_ID )
 	{
-		ERROR_RECOVERABLE( "WARNING: attempt to set speed on missing sound playback ID!" );
+		if (m_fmodSystem != nullptr)
+		{
+			ERROR_RECOVERABLE( "WARNING: attempt to set speed on missing sound playback ID!" );
+		}
+
 		return;
 	}
 
@@ -267,12 +400,37 @@ void AudioSystem::SetSoundPlaybackSpeed( SoundPlaybackID soundPlaybackID, float
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Moves a sound played with PlaySoundAtPosition()
+//
+void AudioSystem::SetSoundPlaybackPosition( SoundPlaybackID soundPlaybackID, const Vector3& position )
+{
+	if( soundPlaybackID == MISSING_SOUND_ID )
+	{
+		if (m_fmodSystem != nullptr)
+		{
+			ERROR_RECOVERABLE( "WARNING: attempt to set position on missing sound playback ID!" );
+		}
+
+		return;
+	}
+
+	FMOD::Channel* channelAssignedToSound = (FMOD::Channel*) soundPlaybackID;
+	FMOD_VECTOR fmodPosition = ToFMODVector(position);
+	channelAssignedToSound->set3DAttributes( &fmodPosition, nullptr );
+}
+
+
 //-----------------------------------------------------------------------------------------------
 bool AudioSystem::IsSoundFinished(SoundPlaybackID soundPlaybackID) const
 {
 	if (soundPlaybackID == MISSING_SOUND_ID)
 	{
-		ERROR_RECOVERABLE("WARNING: Checking for finished sound with a null playback ID");
+		if (m_fmodSystem != nullptr)
+		{
+			ERROR_RECOVERABLE("WARNING: Checking for finished sound with a null playback ID");
+		}
+
 		return true;
 	}
 
@@ -285,6 +443,74 @@ bool AudioSystem::IsSoundFinished(SoundPlaybackID soundPlaybackID) const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the paused channel the sound is playing on, or nullptr if the sound is missing or not loaded yet
+// Past AUDIO_MAX_VIRTUAL_VOICES FMOD steals the lowest priority voice for it
+//
+FMOD::Channel* AudioSystem::StartChannel(SoundID soundID, FMOD_MODE mode, bool isLooped, float volume, float speed, int priority)
+{
+	size_t numSounds = m_registeredSounds.size();
+	if( soundID < 0 || soundID >= numSounds )
+		return nullptr;
+
+	FMOD::Sound* sound = m_registeredSounds[ soundID ];
+	if( !sound )
+		return nullptr;
+
+	// Fails with FMOD_ERR_NOTREADY while loading in the background
+	FMOD::Channel* channelAssignedToSound = nullptr;
+	FMOD_RESULT result = m_fmodSystem->playSound( sound, nullptr, true, &channelAssignedToSound );
+	if( result != FMOD_OK || !channelAssignedToSound )
+		return nullptr;
+
+	float frequency;
+	channelAssignedToSound->setMode( mode );
+	channelAssignedToSound->setPriority( ClampInt(priority, 0, 256) );
+	channelAssignedToSound->getFrequency( &frequency );
+	channelAssignedToSound->setFrequency( frequency * speed );
+	channelAssignedToSound->setVolume( volume );
+	channelAssignedToSound->setLoopCount( isLooped ? -1 : 0 );
+
+	return channelAssignedToSound;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets where positioned sounds are heard from
+//
+void AudioSystem::SetListener(const Vector3& position, const Vector3& forward, const Vector3& up)
+{
+	if (m_fmodSystem == nullptr)
+	{
+		return;
+	}
+
+	FMOD_VECTOR fmodPosition = ToFMODVector(position);
+	FMOD_VECTOR fmodForward = ToFMODVector(forward);
+	FMOD_VECTOR fmodUp = ToFMODVector(up);
+
+	FMOD_RESULT result = m_fmodSystem->set3DListenerAttributes(0, &fmodPosition, nullptr, &fmodForward, &fmodUp);
+	ValidateResult(result);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of voices playing, real or virtual, and how many of them are real and being mixed
+//
+void AudioSystem::GetVoiceCounts(int& out_playingCount, int& out_realCount) const
+{
+	out_playingCount = 0;
+	out_realCount = 0;
+
+	if (m_fmodSystem == nullptr)
+	{
+		return;
+	}
+
+	m_fmodSystem->getChannelsPlaying(&out_playingCount, &out_realCount);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void AudioSystem::ValidateResult( FMOD_RESULT result )
 {
@@ -306,12 +532,13 @@ FMOD::System* AudioSystem::GetFMODSystem() const
 
 //-----------------------------------------------------------------------------------------------
 // Loads the given file defining a set of audio groups and attempts to construct them
+// With loadAsync the clips load in the background, so a level's sounds can be preloaded without a hitch
 //
-void AudioSystem::LoadAudioGroupFile(const std::string& filepath)
+void AudioSystem::LoadAudioGroupFile(const std::string& filepath, bool loadAsync)
 {
 	// Load the document
 	XMLDocument document;
-	XMLError error = document.LoadFile(filepath.c_str());
+	XMLError error = LoadXmlDocument(document, filepath);
 
 	if (error != tinyxml2::XML_SUCCESS)
 	{
@@ -325,7 +552,7 @@ void AudioSystem::LoadAudioGroupFile(const std::string& filepath)
 
 	while (groupElement != nullptr)
 	{
-		AudioGroup* group = new AudioGroup(*groupElement);
+		AudioGroup* group = new AudioGroup(*groupElement, loadAsync);
 		s_instance->m_audioGroups[group->GetName()] = group;
 
 		groupElement = groupElement->NextSiblingElement();
@@ -339,10 +566,12 @@ void AudioSystem::LoadAudioGroupFile(const std::string& filepath)
 
 //-----------------------------------------------------------------------------------------------
 // Constructor from XML
+// Groups or single clips marked stream="true" are streamed, for music and long ambience
 //
-AudioGroup::AudioGroup(const XMLElement& groupElement)
+AudioGroup::AudioGroup(const XMLElement& groupElement, bool loadAsync)
 {
 	m_name = ParseXmlAttribute(groupElement, "name", "");
+	bool isGroupStreamed = ParseXmlAttribute(groupElement, "stream", false);
 
 	const XMLElement* clipElement = groupElement.FirstChildElement();
 
@@ -358,7 +587,8 @@ AudioGroup::AudioGroup(const XMLElement& groupElement)
 			continue;
 		}
 
-		SoundID clipID = audio->CreateOrGetSound(clipSourcePath);
+		bool isStreamed = ParseXmlAttribute(*clipElement, "stream", isGroupStreamed);
+		SoundID clipID = audio->CreateOrGetSound(clipSourcePath, isStreamed, loadAsync);
 		m_sounds.push_back(clipID);
 
 		clipElement = clipElement->NextSiblingElement();
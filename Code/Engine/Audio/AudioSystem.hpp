@@ -13,8 +13,21 @@ typedef size_t SoundID;
 typedef size_t SoundPlaybackID;
 constexpr size_t MISSING_SOUND_ID = (size_t)(-1); // for bad SoundIDs and SoundPlaybackIDs
 
+// Voice budget - FMOD tracks up to the virtual count, and only mixes the real count; past that the
+// least audible and lowest priority voices go virtual, costing nothing until they're audible again
+#define AUDIO_MAX_VIRTUAL_VOICES (512)
+#define AUDIO_MAX_REAL_VOICES (64)
+#define AUDIO_VIRTUAL_VOLUME_THRESHOLD (0.001f)	// Voices quieter than this go virtual, even under the real count
+
+#define AUDIO_DEFAULT_PRIORITY (128)			// FMOD priorities, 0 is the most important and 256 the least
+
+// Positioned sounds are at full volume within the min distance, and silent (so virtual) past the max
+#define AUDIO_3D_MIN_DISTANCE (1.f)
+#define AUDIO_3D_MAX_DISTANCE (50.f)
+
 
 //-----------------------------------------------------------------------------------------------
+class Vector3;
 class AudioGroup;
 class AudioSystem;
 
@@ -26,22 +39,35 @@ public:
 	static void					Initialize();
 	static void					Shutdown();
 	static AudioSystem*			GetInstance();
-	static void					LoadAudioGroupFile(const std::string& filepath);
+	static void					LoadAudioGroupFile(const std::string& filepath, bool loadAsync=false);
 
 	virtual void				BeginFrame();
 	virtual void				EndFrame();
 
 	virtual FMOD::Sound*		GetSoundForSoundID(SoundID soundID);
-	virtual SoundID				CreateOrGetSound( const std::string& soundFilePath );
+
+	// Streamed sounds decode from disk as they play instead of loading whole - for music and long ambience,
+	//	but each can only play once at a time
+	// Async sounds load in the background, and play as MISSING_SOUND_ID until IsSoundReady()
+	virtual SoundID				CreateOrGetSound( const std::string& soundFilePath, bool isStreamed=false, bool loadAsync=false );
 	virtual SoundID				GetSound(const std::string& soundFilePath);
-	virtual SoundPlaybackID		PlaySound( SoundID soundID, bool isLooped=false, float volume=1.f, float balance=0.0f, float speed=1.0f, bool isPaused=false );
+	virtual bool				IsSoundReady(SoundID soundID) const;
+	int							GetPendingLoadCount() const;
+
+	virtual SoundPlaybackID		PlaySound( SoundID soundID, bool isLooped=false, float volume=1.f, float balance=0.0f, float speed=1.0f, bool isPaused=false, int priority=AUDIO_DEFAULT_PRIORITY );
+	virtual SoundPlaybackID		PlaySoundAtPosition( SoundID soundID, const Vector3& position, bool isLooped=false, float volume=1.f, float speed=1.0f, int priority=AUDIO_DEFAULT_PRIORITY );
 	virtual SoundPlaybackID		PlaySoundFromAudioGroup(const std::string& groupName, bool isLooped=false, float volume=1.f, float balance=0.0f, float speed=1.0f, bool isPaused=false );
 	virtual void				StopSound( SoundPlaybackID soundPlaybackID );
 	virtual void				SetSoundPlaybackVolume( SoundPlaybackID soundPlaybackID, float volume );	// volume is in [0,1]
 	virtual void				SetSoundPlaybackBalance( SoundPlaybackID soundPlaybackID, float balance );	// balance is in [-1,1], where 0 is L/R centered
 	virtual void				SetSoundPlaybackSpeed( SoundPlaybackID soundPlaybackID, float speed );		// speed is frequency multiplier (1.0 == normal)
+	virtual void				SetSoundPlaybackPosition( SoundPlaybackID soundPlaybackID, const Vector3& position );	// Only for sounds played at a position
 	virtual bool				IsSoundFinished(SoundPlaybackID soundPlaybackID) const;
 
+	// Positioned sounds are heard from here, usually the camera
+	virtual void				SetListener(const Vector3& position, const Vector3& forward, const Vector3& up);
+	void						GetVoiceCounts(int& out_playingCount, int& out_realCount) const;
+
 	virtual void				ValidateResult( FMOD_RESULT result );
 
 	FMOD::System*				GetFMODSystem() const;
@@ -51,6 +77,7 @@ protected:
 	FMOD::System*						m_fmodSystem;
 	std::map< std::string, SoundID >	m_registeredSoundIDs;
 	std::vector< FMOD::Sound* >			m_registeredSounds;
+	std::vector< SoundID >				m_pendingSounds;		// Still loading in the background
 
 	std::map<std::string, AudioGroup*>	m_audioGroups;
 
@@ -63,6 +90,9 @@ protected:
 	virtual ~AudioSystem();
 	AudioSystem(const AudioSystem& copy) = delete;
 
+	// Starts the sound paused, so the caller can finish setting it up before it's heard
+	FMOD::Channel*				StartChannel(SoundID soundID, FMOD_MODE mode, bool isLooped, float volume, float speed, int priority);
+
 
 private:
 	//-----Private Data-----
@@ -77,7 +107,7 @@ class AudioGroup
 public:
 	//-----Public Methods-----
 
-	AudioGroup(const XMLElement& groupElement);
+	AudioGroup(const XMLElement& groupElement, bool loadAsync);
 
 	// Accessors
 	std::string GetName() const;
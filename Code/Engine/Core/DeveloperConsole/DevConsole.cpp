@@ -5,6 +5,7 @@
 /* Description: Implementation of the Developer Console class
 /************************************************************************/
 #include <stdarg.h>
+#include <stdio.h>
 #include "Engine/Core/File.hpp"
 #include "Engine/Core/Window.hpp"
 #include "Engine/Core/Time/Time.hpp"
@@ -13,8 +14,17 @@
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Core/Time/Clock.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Assets/AssetCooker.hpp"
+#include "Engine/Assets/AssetHotReloader.hpp"
+#include "Engine/Assets/AssetResidency.hpp"
+#include "Engine/Core/VirtualFileSystem.hpp"
 #include "Engine/Rendering/Core/Renderer.hpp"
+#include "Engine/Rendering/Meshes/Mesh.hpp"
 #include "Engine/Core/Time/ProfileScoped.hpp"
+#include "Engine/Rendering/Core/Renderable.hpp"
+#include "Engine/Rendering/Meshes/MeshBuilder.hpp"
+#include "Engine/Core/Time/BenchmarkSuite.hpp"
+#include "Engine/Rendering/Core/RenderBenchmark.hpp"
 #include "Engine/Core/DeveloperConsole/Command.hpp"
 #include "Engine/Rendering/Animation/SpriteAnim.hpp"
 #include "Engine/Networking/RemoteCommandService.hpp"
@@ -167,10 +177,17 @@ DevConsole::DevConsole()
 	m_inputFieldBounds = AABB2(Vector2::ZERO, Vector2(consoleOrthoWidth, TEXT_HEIGHT + 2.f * TEXT_PADDING));		// Leave space for padding above and below lines
 	m_consoleLogBounds = AABB2(Vector2(0.f, TEXT_HEIGHT + 2.f * TEXT_PADDING), Vector2(consoleOrthoWidth, Renderer::UI_ORTHO_HEIGHT));
 
+	m_logLines.resize(DEVCONSOLE_MAX_LOG_LINES);
+
 	// Set up reference to the window to listen to Windows messages
 	theWindow->RegisterHandler(ConsoleMessageHandler);
 
-	SetUpFLChan();
+	// Headless consoles only run commands and print, so nothing to draw with
+	m_FLChanAnimations = nullptr;
+	if (!IsEngineHeadless())
+	{
+		SetUpFLChan();
+	}
 }
 
 
@@ -183,6 +200,20 @@ DevConsole::~DevConsole()
 
 	delete m_FLChanAnimations;
 	m_FLChanAnimations = nullptr;
+
+	for (int chunkIndex = 0; chunkIndex < DEVCONSOLE_LOG_CHUNK_COUNT; ++chunkIndex)
+	{
+		LogChunk_t& chunk = m_logChunks[chunkIndex];
+
+		delete chunk.renderable;
+		chunk.renderable = nullptr;
+
+		delete chunk.mesh;
+		chunk.mesh = nullptr;
+
+		delete chunk.builder;
+		chunk.builder = nullptr;
+	}
 }
 
 
@@ -395,31 +426,75 @@ void DevConsole::RenderInputField(Renderer* renderer, BitmapFont* font) const
 
 //-----------------------------------------------------------------------------------------------
 // Draws the log text (past commands entered and results)
+// Only the lines on screen are drawn, each chunk of them from its mesh as a range of its indices
 //
 void DevConsole::RenderLogWindow(Renderer* renderer, BitmapFont* font) const
 {
+	UNUSED(font);
+
 	// Draw the background
 	Material* uiMaterial = AssetDB::CreateOrGetSharedMaterial("UI");
 	renderer->Draw2DQuad(m_consoleLogBounds, AABB2::UNIT_SQUARE_OFFCENTER, LOG_BOX_COLOR, uiMaterial);
 
 	//-----Draw the log text-----
-	AABB2 currentLogLineBounds = AABB2(Vector2(m_inputFieldBounds.mins.x, m_inputFieldBounds.mins.y + TEXT_HEIGHT), Vector2(m_consoleLogBounds.maxs.x, m_inputFieldBounds.maxs.y + TEXT_HEIGHT));
-	currentLogLineBounds.Translate(Vector2(TEXT_PADDING * Window::GetInstance()->GetAspect(), TEXT_PADDING));
-	std::vector<ConsoleOutputText>::const_reverse_iterator rItr = m_consoleOutputLog.rbegin();
-	for (rItr; rItr != m_consoleOutputLog.rend(); rItr++)
+	if (m_logLineCount == m_oldestLogLine)
 	{
-		renderer->DrawTextInBox2D(rItr->m_text, currentLogLineBounds, Vector2::ZERO, TEXT_HEIGHT, TEXT_DRAW_OVERRUN, font, rItr->m_color);
-		currentLogLineBounds.Translate(Vector2(0.f, TEXT_HEIGHT + TEXT_PADDING));
+		return;
+	}
+
+	// Lines are drawn from the bottom up, newest first
+	uint64_t newestVisibleLine = m_logLineCount - 1 - (uint64_t) m_logScrollOffset;
+	uint64_t visibleLineCount = (uint64_t) GetVisibleLogLineCount();
+	uint64_t oldestVisibleLine = (newestVisibleLine - m_oldestLogLine + 1 > visibleLineCount ? newestVisibleLine - visibleLineCount + 1 : m_oldestLogLine);
+
+	float lineSpacing = TEXT_HEIGHT + TEXT_PADDING;
+	float newestLineY = m_inputFieldBounds.maxs.y + TEXT_PADDING;
+
+	uint64_t firstChunkLine = oldestVisibleLine - (oldestVisibleLine % DEVCONSOLE_LINES_PER_CHUNK);
+	for (uint64_t chunkFirstLine = firstChunkLine; chunkFirstLine <= newestVisibleLine; chunkFirstLine += DEVCONSOLE_LINES_PER_CHUNK)
+	{
+		const LogChunk_t& chunk = m_logChunks[(chunkFirstLine / DEVCONSOLE_LINES_PER_CHUNK) % DEVCONSOLE_LOG_CHUNK_COUNT];
+
+		// Line range within the chunk, limited to what's made it to the GPU
+		int firstLine = (int) ((oldestVisibleLine > chunkFirstLine ? oldestVisibleLine : chunkFirstLine) - chunkFirstLine);
+		int endLine = (int) ((newestVisibleLine - chunkFirstLine) + 1);
+		endLine = MinInt(endLine, chunk.uploadedLineCount);
 
-		// Check if the next line is off of the screen - break if so
-		if (currentLogLineBounds.mins.y > Renderer::UI_ORTHO_HEIGHT)
+		if (chunk.renderable == nullptr || firstLine >= endLine)
 		{
-			break;
+			continue;
+		}
+
+		unsigned int startIndex = chunk.lineStartIndices[firstLine];
+		unsigned int elementCount = chunk.lineStartIndices[endLine] - startIndex;
+
+		if (elementCount == 0)
+		{
+			continue;
 		}
+
+		// Glyphs are built with the chunk's first line at y = 0, going down
+		float chunkY = newestLineY + (float) (newestVisibleLine - chunkFirstLine) * lineSpacing;
+		chunk.renderable->SetModelMatrix(0, Matrix44::MakeTranslation(Vector3(0.f, chunkY, 0.f)));
+		chunk.mesh->SetDrawInstruction(PRIMITIVE_TRIANGLES, true, startIndex, elementCount);
+
+		renderer->DrawRenderable(chunk.renderable);
 	}
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the number of log lines that fit above the input field, counting one partly on screen
+//
+int DevConsole::GetVisibleLogLineCount() const
+{
+	float lineSpacing = TEXT_HEIGHT + TEXT_PADDING;
+	float logHeight = Renderer::UI_ORTHO_HEIGHT - (m_inputFieldBounds.maxs.y + TEXT_PADDING);
+
+	return Ceiling(logHeight / lineSpacing);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Draws the FPS to the screen
 //
@@ -531,6 +606,13 @@ void DevConsole::SetUpFLChan()
 //
 void DevConsole::Update()
 {
+	// No log to build or scroll, output just goes to stdout
+	if (IsEngineHeadless())
+	{
+		FlushOutputQueue();
+		return;
+	}
+
 	float deltaTime = Clock::GetMasterDeltaTime();
 
 	// Update the blink timer
@@ -549,7 +631,15 @@ void DevConsole::Update()
 	}
 	m_FLChanAnimations->Update(deltaTime);
 
+	// Three lines per notch of the wheel
+	float wheelDelta = InputSystem::GetMouse().GetMouseWheelDelta();
+	if (wheelDelta != 0.f)
+	{
+		ScrollLog((int) (wheelDelta * 3.f));
+	}
+
 	FlushOutputQueue();
+	UploadLogChunks();
 }
 
 
@@ -559,6 +649,11 @@ void DevConsole::Update()
 void DevConsole::Render() const
 {
 	Renderer* renderer = Renderer::GetInstance();
+	if (renderer == nullptr)
+	{
+		return;
+	}
+
 	renderer->SetCurrentCamera(renderer->GetUICamera());
 
 	BitmapFont* font = AssetDB::CreateOrGetBitmapFont("Data/Images/Fonts/ConsoleFont.png");
@@ -624,7 +719,15 @@ void DevConsole::AddToMessageQueue(ConsoleOutputText text)
 //
 std::vector<ConsoleOutputText> DevConsole::GetConsoleLog()
 {
-	return s_instance->m_consoleOutputLog;
+	std::vector<ConsoleOutputText> consoleLog;
+	consoleLog.reserve((size_t) (s_instance->m_logLineCount - s_instance->m_oldestLogLine));
+
+	for (uint64_t lineIndex = s_instance->m_oldestLogLine; lineIndex < s_instance->m_logLineCount; ++lineIndex)
+	{
+		consoleLog.push_back(s_instance->m_logLines[lineIndex % DEVCONSOLE_MAX_LOG_LINES]);
+	}
+
+	return consoleLog;
 }
 
 
@@ -633,7 +736,9 @@ std::vector<ConsoleOutputText> DevConsole::GetConsoleLog()
 //
 void DevConsole::ClearConsoleLog()
 {
-	s_instance->m_consoleOutputLog.clear();
+	// The glyphs stay in their chunks, but nothing before this is drawn
+	s_instance->m_oldestLogLine = s_instance->m_logLineCount;
+	s_instance->m_logScrollOffset = 0;
 }
 
 
@@ -724,6 +829,17 @@ void DevConsole::ProcessKeydownCode(unsigned char keyCode)
 	case VK_DOWN:
 		HandleDownArrow();
 		break;
+	case VK_PRIOR:
+		// Page up
+		ScrollLog(GetVisibleLogLineCount() - 1);
+		break;
+	case VK_NEXT:
+		// Page down
+		ScrollLog(-(GetVisibleLogLineCount() - 1));
+		break;
+	case VK_END:
+		ScrollLogToBottom();
+		break;
 	default:
 		// Do nothing here, or else we risk doing duplicate things for a character
 		break;
@@ -810,11 +926,21 @@ void DevConsole::Initialize()
 	Command::Register("hook_console_to_logsystem",		"Enables rendering of the log window and text",			Command_HookToLogSystem);
 	Command::Register("run_batch",						"Runs a batch job file",								Command_RunBatchFile);
 
+	BenchmarkSuite::InitializeConsoleCommands();
+	RenderBenchmark::InitializeConsoleCommands();
+	AssetCooker::InitializeConsoleCommands();
+	AssetHotReloader::InitializeConsoleCommands();
+	AssetResidency::InitializeConsoleCommands();
+	VirtualFileSystem::InitializeConsoleCommands();
+
 	// Load the DevConsole History
 	s_instance->LoadCommandHistoryFromFile();
 
 	// Load the font here to prevent hitch on first log open
-	AssetDB::CreateOrGetBitmapFont("Data/Images/Fonts/ConsoleFont.png");
+	if (!IsEngineHeadless())
+	{
+		AssetDB::CreateOrGetBitmapFont("Data/Images/Fonts/ConsoleFont.png");
+	}
 }
 
 
@@ -904,6 +1030,9 @@ void DevConsole::RemoveConsoleHook(DevConsole_cb callback)
 //
 void DevConsole::FlushOutputQueue()
 {
+	bool isHeadless = IsEngineHeadless();
+	BitmapFont* font = (isHeadless ? nullptr : AssetDB::CreateOrGetBitmapFont("Data/Images/Fonts/ConsoleFont.png"));
+
 	ConsoleOutputText text;
 	while (m_messageQueue.Dequeue(text)) // returns false when empty
 	{
@@ -913,8 +1042,165 @@ void DevConsole::FlushOutputQueue()
 			m_consoleHooks[i].callback(text, m_consoleHooks[i].args);
 		}
 
-		// Push the text to the output log
-		m_consoleOutputLog.push_back(text);
+		// Headless servers have no log window, so the text goes to their console
+		if (isHeadless)
+		{
+			printf("%s\n", text.m_text.c_str());
+			continue;
+		}
+
+		// Push the text to the output log, a line for each line of the text
+		std::vector<std::string> textLines = Tokenize(text.m_text, '\n');
+
+		for (int lineIndex = 0; lineIndex < (int) textLines.size(); ++lineIndex)
+		{
+			ConsoleOutputText line = text;
+			line.m_text = textLines[lineIndex];
+
+			AppendLogLine(line, font);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Scrolls the log back by the number of lines given, or forward if negative
+//
+void DevConsole::ScrollLog(int lineDelta)
+{
+	int maxScrollOffset = MaxInt((int) (m_logLineCount - m_oldestLogLine) - 1, 0);
+	m_logScrollOffset = ClampInt(m_logScrollOffset + lineDelta, 0, maxScrollOffset);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Scrolls the log forward to show the newest line
+//
+void DevConsole::ScrollLogToBottom()
+{
+	m_logScrollOffset = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the line to the ring, and its glyphs to the end of the newest chunk
+// Starting a chunk reuses the one with the oldest lines, dropping all of them
+//
+void DevConsole::AppendLogLine(const ConsoleOutputText& line, BitmapFont* font)
+{
+	uint64_t lineIndex = m_logLineCount;
+	int lineInChunk = (int) (lineIndex % DEVCONSOLE_LINES_PER_CHUNK);
+	LogChunk_t& chunk = m_logChunks[(lineIndex / DEVCONSOLE_LINES_PER_CHUNK) % DEVCONSOLE_LOG_CHUNK_COUNT];
+
+	if (lineInChunk == 0)
+	{
+		if (chunk.builder == nullptr)
+		{
+			chunk.builder = new MeshBuilder();
+		}
+
+		chunk.builder->Clear();
+		chunk.builder->SetOutputVertexType<VertexLit>();
+		chunk.lineStartIndices[0] = 0;
+		chunk.lineCount = 0;
+		chunk.uploadedLineCount = 0;
+
+		if (lineIndex >= DEVCONSOLE_MAX_LOG_LINES)
+		{
+			uint64_t firstKeptLine = lineIndex - DEVCONSOLE_MAX_LOG_LINES + DEVCONSOLE_LINES_PER_CHUNK;
+			m_oldestLogLine = (m_oldestLogLine > firstKeptLine ? m_oldestLogLine : firstKeptLine);
+		}
+	}
+
+	m_logLines[lineIndex % DEVCONSOLE_MAX_LOG_LINES] = line;
+
+	// Glyphs laid out as DrawText2D would, relative to the chunk's first line
+	float glyphWidth = font->GetGlyphAspect() * TEXT_HEIGHT;
+	Vector2 glyphBottomLeft = Vector2(m_inputFieldBounds.mins.x + TEXT_PADDING * Window::GetInstance()->GetAspect(), -(float) lineInChunk * (TEXT_HEIGHT + TEXT_PADDING));
+
+	chunk.builder->BeginBuilding(PRIMITIVE_TRIANGLES, true);
+
+	for (int charIndex = 0; charIndex < (int) line.m_text.size(); ++charIndex)
+	{
+		// Nothing past the edge of the window is seen
+		if (glyphBottomLeft.x >= m_consoleLogBounds.maxs.x)
+		{
+			break;
+		}
+
+		char currentChar = line.m_text[charIndex];
+
+		if (currentChar != ' ')
+		{
+			AABB2 glyphBounds = AABB2(glyphBottomLeft, glyphBottomLeft + Vector2(glyphWidth, TEXT_HEIGHT));
+			chunk.builder->Push2DQuad(glyphBounds, font->GetGlyphUVs(currentChar), line.m_color);
+		}
+
+		glyphBottomLeft.x += glyphWidth;
+	}
+
+	chunk.builder->FinishBuilding();
+
+	chunk.lineCount++;
+	chunk.lineStartIndices[chunk.lineCount] = (unsigned int) chunk.builder->GetIndexCount();
+
+	m_logLineCount++;
+
+	// Keep the same lines on screen while scrolled back
+	if (m_logScrollOffset > 0)
+	{
+		ScrollLog(1);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Uploads the chunks with lines added since their last upload - only the newest one or two, normally
+//
+void DevConsole::UploadLogChunks()
+{
+	if (m_logLineCount == 0)
+	{
+		return;
+	}
+
+	Renderer* renderer = Renderer::GetInstance();
+	BitmapFont* font = AssetDB::CreateOrGetBitmapFont("Data/Images/Fonts/ConsoleFont.png");
+
+	// Lines are only added to the newest chunks, so walk back from it until one is up to date
+	uint64_t newestChunk = (m_logLineCount - 1) / DEVCONSOLE_LINES_PER_CHUNK;
+	for (int chunksChecked = 0; chunksChecked < DEVCONSOLE_LOG_CHUNK_COUNT && chunksChecked <= (int) newestChunk; ++chunksChecked)
+	{
+		LogChunk_t& chunk = m_logChunks[(newestChunk - chunksChecked) % DEVCONSOLE_LOG_CHUNK_COUNT];
+
+		if (chunk.uploadedLineCount == chunk.lineCount)
+		{
+			break;
+		}
+
+		if (chunk.mesh == nullptr)
+		{
+			chunk.mesh = new Mesh();
+		}
+
+		chunk.builder->UpdateMesh<VertexLit>(*chunk.mesh);
+		chunk.uploadedLineCount = chunk.lineCount;
+
+		if (chunk.renderable == nullptr)
+		{
+			RenderableDraw_t draw;
+			draw.mesh = chunk.mesh;
+			draw.sharedMaterial = renderer->GetFontMaterial(font);
+
+			chunk.renderable = new Renderable();
+			chunk.renderable->AddDraw(draw);
+			chunk.renderable->AddInstanceMatrix(Matrix44::IDENTITY);
+		}
+		else
+		{
+			// Rebind, in case the buffers were reallocated to grow
+			chunk.renderable->SetDraw(0, chunk.renderable->GetDraw(0));
+		}
 	}
 }
 
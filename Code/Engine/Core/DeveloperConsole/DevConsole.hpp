@@ -10,13 +10,24 @@
 #include "Engine/Math/Matrix44.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/DataStructures/ThreadSafeQueue.hpp"
+#include <stdint.h>
 #include <vector>
 
 #define MAX_HISTORY_WRITE_COUNT 32
 
+// Lines kept for scrollback - the oldest are dropped a chunk at a time once it's full
+#define DEVCONSOLE_MAX_LOG_LINES (8192)
+
+// The log's glyphs are kept on the GPU in chunks of this many lines, and only the newest chunk is ever added to
+#define DEVCONSOLE_LINES_PER_CHUNK (64)
+#define DEVCONSOLE_LOG_CHUNK_COUNT (DEVCONSOLE_MAX_LOG_LINES / DEVCONSOLE_LINES_PER_CHUNK)
+
 TODO("Max console line length, or line wrap");
+class Mesh;
 class Renderer;
 class BitmapFont;
+class Renderable;
+class MeshBuilder;
 class SpriteAnimSet;
 
 struct ConsoleOutputText
@@ -79,6 +90,25 @@ public:
 
 	void				FlushOutputQueue();
 
+	// Scrollback, in lines back from the newest
+	void				ScrollLog(int lineDelta);
+	void				ScrollLogToBottom();
+
+
+private:
+	//-----Private Types-----
+
+	// Glyphs of consecutive lines of the log, in a mesh that's only appended to until the chunk is reused
+	struct LogChunk_t
+	{
+		MeshBuilder*	builder = nullptr;
+		Mesh*			mesh = nullptr;
+		Renderable*		renderable = nullptr;
+		unsigned int	lineStartIndices[DEVCONSOLE_LINES_PER_CHUNK + 1];	// Index of each line's first glyph, then the end of the last
+		int				lineCount = 0;
+		int				uploadedLineCount = 0;								// Lines in the mesh, the rest are only in the builder
+	};
+
 
 private:
 	//-----Private Methods-----
@@ -104,6 +134,11 @@ private:
 	void		RenderLogWindow(Renderer* renderer, BitmapFont* font) const;
 	void		RenderFPS() const;
 	void		RenderFLChan() const;
+	int			GetVisibleLogLineCount() const;
+
+	// Log
+	void		AppendLogLine(const ConsoleOutputText& line, BitmapFont* font);
+	void		UploadLogChunks();
 
 	void		SetUpFLChan();
 
@@ -123,7 +158,14 @@ private:
 
 	std::string	m_inputBuffer;								// What is shown as the user is typing
 	ThreadSafeQueue<ConsoleOutputText>	m_messageQueue;			// For thread safety
-	std::vector<ConsoleOutputText>		m_consoleOutputLog;		// Log that is printed to screen as a list
+
+	// Log that is printed to screen, as a ring of lines - line N is in slot N % DEVCONSOLE_MAX_LOG_LINES,
+	// and its glyphs in chunk (N / DEVCONSOLE_LINES_PER_CHUNK) % DEVCONSOLE_LOG_CHUNK_COUNT
+	std::vector<ConsoleOutputText>		m_logLines;
+	LogChunk_t							m_logChunks[DEVCONSOLE_LOG_CHUNK_COUNT];
+	uint64_t							m_logLineCount = 0;		// Lines ever added
+	uint64_t							m_oldestLogLine = 0;	// Lines before this were cleared or dropped
+	int									m_logScrollOffset = 0;	// Lines scrolled back from the newest
 
 	std::vector<std::string> m_commandHistory;				// List of previously entered strings (not the log)
 	int	m_historyIndex;										// Current location in history to render		
@@ -9,4 +9,28 @@
 #include "Engine/Core/Utility/Blackboard.hpp"
 #include "Engine/Rendering/Resources/SpriteSheet.hpp"
 
-Blackboard* g_gameConfigBlackboard = nullptr;
\ No newline at end of file
+Blackboard* g_gameConfigBlackboard = nullptr;
+
+static bool s_isEngineHeadless = false;
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets whether the engine systems start as null backends, for servers that only need to simulate
+//
+void SetEngineHeadless(bool isHeadless)
+{
+	s_isEngineHeadless = isHeadless;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the engine is running without a window, rendering, audio or input
+//
+bool IsEngineHeadless()
+{
+#if defined( ENGINE_HEADLESS )
+	return true;
+#else
+	return s_isEngineHeadless;
+#endif
+}
@@ -16,6 +16,12 @@ class Blackboard;
 
 extern Blackboard* g_gameConfigBlackboard;
 
+// Headless runs (dedicated servers) start the Window, Renderer, AudioSystem, InputSystem and DevConsole
+// as null backends - no OS window, GL context, shaders, FMOD or device polling
+// Set it before initializing any of them; building with ENGINE_HEADLESS forces it on
+void SetEngineHeadless(bool isHeadless);
+bool IsEngineHeadless();
+
 // Macro to make TODO's and UNIMPLEMENTED reminders appear in build output
 #define _QUOTE(x) # x
 #define QUOTE(x) _QUOTE(x)
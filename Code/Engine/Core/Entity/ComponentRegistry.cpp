@@ -0,0 +1,55 @@
+/************************************************************************/
+/* File: ComponentRegistry.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the ComponentRegistry class
+/************************************************************************/
+#include <mutex>
+#include <atomic>
+#include "Engine/Core/Entity/ComponentRegistry.hpp"
+#include "Engine/Core/Entity/EntityArchetype.hpp"
+#include "Engine/Core/Utility/StringUtils.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+
+// Written once per type under the lock, and only read after the ID has been handed out
+static ComponentTypeInfo_t	s_typeInfos[ENTITY_MAX_COMPONENT_TYPES];
+static std::atomic<int>		s_typeCount{ 0 };
+static std::mutex			s_registerLock;
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the move/destruct info for the component type
+//
+const ComponentTypeInfo_t& ComponentRegistry::GetTypeInfo(int typeID)
+{
+	return s_typeInfos[typeID];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of component types registered so far
+//
+int ComponentRegistry::GetTypeCount()
+{
+	return s_typeCount.load(std::memory_order_acquire);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the type, returning its ID; only ever called once per type by GetTypeID()
+//
+int ComponentRegistry::RegisterType(const ComponentTypeInfo_t& info)
+{
+	ASSERT_OR_DIE(info.alignment <= ENTITY_CHUNK_ALIGNMENT, Stringf("Error: Component type alignment %u is more than the chunk alignment of %u", (unsigned int)info.alignment, (unsigned int)ENTITY_CHUNK_ALIGNMENT));
+
+	s_registerLock.lock();
+
+	int typeID = s_typeCount.load(std::memory_order_relaxed);
+	GUARANTEE_OR_DIE(typeID < ENTITY_MAX_COMPONENT_TYPES, Stringf("Error: More than %i component types registered", ENTITY_MAX_COMPONENT_TYPES));
+
+	s_typeInfos[typeID] = info;
+	s_typeCount.store(typeID + 1, std::memory_order_release);
+
+	s_registerLock.unlock();
+	return typeID;
+}
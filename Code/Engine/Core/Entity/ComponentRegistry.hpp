@@ -0,0 +1,106 @@
+/************************************************************************/
+/* File: ComponentRegistry.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Assigns each component type used in an EntityWorld a
+/*				small ID, and keeps what's needed to move and destroy it
+/*				without knowing the type
+/************************************************************************/
+#pragma once
+#include <new>
+#include <utility>
+#include <stddef.h>
+#include <stdint.h>
+
+// One bit per type in a ComponentMask
+#define ENTITY_MAX_COMPONENT_TYPES (64)
+
+typedef uint64_t ComponentMask;
+
+struct ComponentTypeInfo_t
+{
+	size_t	size = 0;
+	size_t	alignment = 0;
+	void	(*moveAndDestruct)(void* destination, void* source) = nullptr;	// Move constructs into destination, then destructs the source
+	void	(*destruct)(void* component) = nullptr;
+};
+
+
+class ComponentRegistry
+{
+public:
+	//-----Public Methods-----
+
+	// The ID is assigned on the first call for the type, from any thread
+	template <typename T> static int			GetTypeID();
+	template <typename T> static ComponentMask	GetTypeMask();
+
+	static const ComponentTypeInfo_t&			GetTypeInfo(int typeID);
+	static int									GetTypeCount();
+
+
+private:
+	//-----Private Methods-----
+
+	ComponentRegistry() {}
+
+	static int RegisterType(const ComponentTypeInfo_t& info);
+
+	template <typename T> static void MoveAndDestructComponent(void* destination, void* source);
+	template <typename T> static void DestructComponent(void* component);
+
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the ID of the component type, registering it on the first call
+//
+template <typename T>
+int ComponentRegistry::GetTypeID()
+{
+	static const int s_typeID = []()
+	{
+		ComponentTypeInfo_t info;
+		info.size = sizeof(T);
+		info.alignment = alignof(T);
+		info.moveAndDestruct = &MoveAndDestructComponent<T>;
+		info.destruct = &DestructComponent<T>;
+
+		return RegisterType(info);
+	}();
+
+	return s_typeID;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the bit for the component type
+//
+template <typename T>
+ComponentMask ComponentRegistry::GetTypeMask()
+{
+	return ((ComponentMask)1 << GetTypeID<T>());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Moves the component to uninitialized memory, leaving nothing behind in the source
+//
+template <typename T>
+void ComponentRegistry::MoveAndDestructComponent(void* destination, void* source)
+{
+	T* sourceComponent = reinterpret_cast<T*>(source);
+
+	new (destination) T(std::move(*sourceComponent));
+	sourceComponent->~T();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructs the component in place
+//
+template <typename T>
+void ComponentRegistry::DestructComponent(void* component)
+{
+	reinterpret_cast<T*>(component)->~T();
+}
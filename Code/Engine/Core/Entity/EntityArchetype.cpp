@@ -0,0 +1,234 @@
+/************************************************************************/
+/* File: EntityArchetype.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the EntityArchetype class
+/************************************************************************/
+#include <new>
+#include "Engine/Core/Entity/EntityArchetype.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Rounds the offset up to the alignment, which must be a power of two
+//
+static size_t AlignOffset(size_t offset, size_t alignment)
+{
+	return (offset + (alignment - 1)) & ~(alignment - 1);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+EntityArchetype::EntityArchetype(ComponentMask mask)
+	: m_mask(mask)
+{
+	for (int typeID = 0; typeID < ENTITY_MAX_COMPONENT_TYPES; ++typeID)
+	{
+		m_componentOffsets[typeID] = -1;
+
+		if ((mask & ((ComponentMask)1 << typeID)) != 0)
+		{
+			m_typeIDs.push_back(typeID);
+		}
+	}
+
+	ComputeChunkLayout();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor - destructs every component left and frees the chunks
+//
+EntityArchetype::~EntityArchetype()
+{
+	for (int chunkIndex = 0; chunkIndex < (int)m_chunks.size(); ++chunkIndex)
+	{
+		EntityChunk_t* chunk = m_chunks[chunkIndex];
+
+		for (int typeIndex = 0; typeIndex < (int)m_typeIDs.size(); ++typeIndex)
+		{
+			int typeID = m_typeIDs[typeIndex];
+			const ComponentTypeInfo_t& info = ComponentRegistry::GetTypeInfo(typeID);
+			uint8_t* components = (uint8_t*)GetComponentArray(chunk, typeID);
+
+			for (int row = 0; row < chunk->count; ++row)
+			{
+				info.destruct(components + row * info.size);
+			}
+		}
+
+		operator delete[](chunk->data, std::align_val_t(ENTITY_CHUNK_ALIGNMENT));
+		delete chunk;
+	}
+
+	m_chunks.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the entity to the end of the last chunk, making a new chunk if it's full
+// Returns the row, with the chunk index in out_chunkIndex
+//
+int EntityArchetype::AddEntity(EntityID entityID, int& out_chunkIndex)
+{
+	if (m_chunks.size() == 0 || m_chunks.back()->count == m_chunkCapacity)
+	{
+		EntityChunk_t* chunk = new EntityChunk_t();
+		chunk->data = new (std::align_val_t(ENTITY_CHUNK_ALIGNMENT)) uint8_t[m_chunkBytes];
+
+		m_chunks.push_back(chunk);
+	}
+
+	out_chunkIndex = (int)m_chunks.size() - 1;
+	EntityChunk_t* chunk = m_chunks.back();
+
+	int row = chunk->count++;
+	GetEntityIDs(chunk)[row] = entityID;
+
+	return row;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes the row, moving the archetype's last entity into it to keep the chunks packed
+// Returns the ID of the entity that was moved, or INVALID_ENTITY_ID if the row was the last
+//
+EntityID EntityArchetype::RemoveEntity(int chunkIndex, int row, bool destructComponents)
+{
+	EntityChunk_t* chunk = m_chunks[chunkIndex];
+	EntityChunk_t* lastChunk = m_chunks.back();
+	int lastRow = lastChunk->count - 1;
+
+	ASSERT_OR_DIE(row < chunk->count, "Error: EntityArchetype::RemoveEntity() given a row past the end of the chunk");
+
+	bool isLast = (chunk == lastChunk && row == lastRow);
+	EntityID movedEntity = INVALID_ENTITY_ID;
+
+	for (int typeIndex = 0; typeIndex < (int)m_typeIDs.size(); ++typeIndex)
+	{
+		int typeID = m_typeIDs[typeIndex];
+		const ComponentTypeInfo_t& info = ComponentRegistry::GetTypeInfo(typeID);
+
+		uint8_t* hole = (uint8_t*)GetComponentArray(chunk, typeID) + row * info.size;
+
+		if (destructComponents)
+		{
+			info.destruct(hole);
+		}
+
+		if (!isLast)
+		{
+			uint8_t* last = (uint8_t*)GetComponentArray(lastChunk, typeID) + lastRow * info.size;
+			info.moveAndDestruct(hole, last);
+		}
+	}
+
+	if (!isLast)
+	{
+		movedEntity = GetEntityIDs(lastChunk)[lastRow];
+		GetEntityIDs(chunk)[row] = movedEntity;
+	}
+
+	lastChunk->count--;
+
+	// Only the last chunk is ever partially full, so it's the only one that can empty out
+	if (lastChunk->count == 0)
+	{
+		operator delete[](lastChunk->data, std::align_val_t(ENTITY_CHUNK_ALIGNMENT));
+		delete lastChunk;
+		m_chunks.pop_back();
+	}
+
+	return movedEntity;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of entities in the archetype
+//
+int EntityArchetype::GetEntityCount() const
+{
+	if (m_chunks.size() == 0)
+	{
+		return 0;
+	}
+
+	return ((int)m_chunks.size() - 1) * m_chunkCapacity + m_chunks.back()->count;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the chunk's array of entity IDs
+//
+EntityID* EntityArchetype::GetEntityIDs(const EntityChunk_t* chunk) const
+{
+	return reinterpret_cast<EntityID*>(chunk->data);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the chunk's array of the component, nullptr if the archetype doesn't have it
+//
+void* EntityArchetype::GetComponentArray(const EntityChunk_t* chunk, int typeID) const
+{
+	int offset = m_componentOffsets[typeID];
+	return (offset >= 0 ? chunk->data + offset : nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the entity's component, nullptr if the archetype doesn't have it
+//
+void* EntityArchetype::GetComponent(int chunkIndex, int row, int typeID) const
+{
+	uint8_t* components = (uint8_t*)GetComponentArray(m_chunks[chunkIndex], typeID);
+
+	if (components == nullptr)
+	{
+		return nullptr;
+	}
+
+	return components + row * ComponentRegistry::GetTypeInfo(typeID).size;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Fits as many entities as possible in ENTITY_CHUNK_BYTES, with each array aligned for its type
+//
+void EntityArchetype::ComputeChunkLayout()
+{
+	size_t bytesPerEntity = sizeof(EntityID);
+	for (int typeIndex = 0; typeIndex < (int)m_typeIDs.size(); ++typeIndex)
+	{
+		bytesPerEntity += ComponentRegistry::GetTypeInfo(m_typeIDs[typeIndex]).size;
+	}
+
+	int capacity = (int)(ENTITY_CHUNK_BYTES / bytesPerEntity);
+	capacity = (capacity < 1 ? 1 : capacity);
+
+	// Alignment padding can push it over, so back off until it fits
+	while (true)
+	{
+		size_t offset = sizeof(EntityID) * capacity;
+
+		for (int typeIndex = 0; typeIndex < (int)m_typeIDs.size(); ++typeIndex)
+		{
+			const ComponentTypeInfo_t& info = ComponentRegistry::GetTypeInfo(m_typeIDs[typeIndex]);
+
+			offset = AlignOffset(offset, info.alignment);
+			m_componentOffsets[m_typeIDs[typeIndex]] = (int)offset;
+			offset += info.size * capacity;
+		}
+
+		if (offset <= ENTITY_CHUNK_BYTES || capacity == 1)
+		{
+			m_chunkCapacity = capacity;
+			m_chunkBytes = (offset > ENTITY_CHUNK_BYTES ? AlignOffset(offset, ENTITY_CHUNK_ALIGNMENT) : ENTITY_CHUNK_BYTES);
+			break;
+		}
+
+		capacity--;
+	}
+}
@@ -0,0 +1,75 @@
+/************************************************************************/
+/* File: EntityArchetype.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Storage for every entity with exactly the same set of
+/*				components, packed into fixed size chunks with each
+/*				component in its own array
+/************************************************************************/
+#pragma once
+#include <vector>
+#include <stdint.h>
+#include "Engine/Core/Entity/ComponentRegistry.hpp"
+
+typedef uint64_t EntityID;		// Index in the low 32 bits, generation in the high 32
+#define INVALID_ENTITY_ID (0)	// Generations start at 1, so no live entity is ever 0
+
+#define ENTITY_CHUNK_BYTES (16 * 1024)
+#define ENTITY_CHUNK_ALIGNMENT (64)
+
+// Chunk layout is the entity IDs, then one array per component in type ID order
+// Every chunk but the archetype's last is full
+struct EntityChunk_t
+{
+	uint8_t*	data = nullptr;
+	int			count = 0;
+};
+
+
+class EntityArchetype
+{
+public:
+	//-----Public Methods-----
+
+	EntityArchetype(ComponentMask mask);
+	~EntityArchetype();
+
+	// Reserves a row at the end, with the components left uninitialized for the caller to construct
+	int						AddEntity(EntityID entityID, int& out_chunkIndex);
+
+	// Fills the hole with the archetype's last entity, returning the entity that moved (INVALID_ENTITY_ID if none)
+	// Without destructComponents the row's components must already be moved out
+	EntityID				RemoveEntity(int chunkIndex, int row, bool destructComponents);
+
+	ComponentMask			GetMask() const						{ return m_mask; }
+	bool					HasComponent(int typeID) const		{ return (m_componentOffsets[typeID] >= 0); }
+	const std::vector<int>&	GetTypeIDs() const					{ return m_typeIDs; }
+	int						GetEntityCount() const;
+	int						GetChunkCount() const				{ return (int)m_chunks.size(); }
+	int						GetChunkCapacity() const			{ return m_chunkCapacity; }
+	EntityChunk_t*			GetChunk(int chunkIndex) const		{ return m_chunks[chunkIndex]; }
+
+	EntityID*				GetEntityIDs(const EntityChunk_t* chunk) const;
+	void*					GetComponentArray(const EntityChunk_t* chunk, int typeID) const;
+	void*					GetComponent(int chunkIndex, int row, int typeID) const;
+
+
+private:
+	//-----Private Methods-----
+
+	EntityArchetype(const EntityArchetype& copy) = delete;
+
+	void					ComputeChunkLayout();
+
+
+private:
+	//-----Private Data-----
+
+	ComponentMask					m_mask = 0;
+	std::vector<int>				m_typeIDs;
+	int								m_componentOffsets[ENTITY_MAX_COMPONENT_TYPES];		// Byte offset of each component's array in a chunk, -1 if not in this archetype
+	int								m_chunkCapacity = 0;
+	size_t							m_chunkBytes = ENTITY_CHUNK_BYTES;					// More only if a single entity doesn't fit
+	std::vector<EntityChunk_t*>		m_chunks;
+
+};
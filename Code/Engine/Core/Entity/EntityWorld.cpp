@@ -0,0 +1,272 @@
+/************************************************************************/
+/* File: EntityWorld.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the EntityWorld class
+/************************************************************************/
+#include "Engine/Core/Entity/EntityWorld.hpp"
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Packs the index and generation into an ID
+//
+static EntityID MakeEntityID(uint32_t index, uint32_t generation)
+{
+	return ((EntityID)generation << 32) | (EntityID)index;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+EntityWorld::EntityWorld()
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+EntityWorld::~EntityWorld()
+{
+	Clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Creates an entity with no components
+//
+EntityID EntityWorld::CreateEntity()
+{
+	ASSERT_OR_DIE(m_iterationDepth == 0, "Error: EntityWorld::CreateEntity() called while iterating");
+
+	uint32_t index;
+	if (m_freeIndices.size() > 0)
+	{
+		index = m_freeIndices.back();
+		m_freeIndices.pop_back();
+	}
+	else
+	{
+		index = (uint32_t)m_records.size();
+		m_records.push_back(EntityRecord_t());
+	}
+
+	EntityRecord_t& record = m_records[index];
+	EntityID entityID = MakeEntityID(index, record.generation);
+
+	record.archetype = GetOrCreateArchetype(0);
+	record.row = record.archetype->AddEntity(entityID, record.chunkIndex);
+
+	m_entityCount++;
+	return entityID;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destroys the entity and all its components; stale IDs are ignored
+//
+void EntityWorld::DestroyEntity(EntityID entityID)
+{
+	ASSERT_OR_DIE(m_iterationDepth == 0, "Error: EntityWorld::DestroyEntity() called while iterating");
+
+	EntityRecord_t* record = GetRecord(entityID);
+
+	if (record == nullptr)
+	{
+		return;
+	}
+
+	EntityID movedEntity = record->archetype->RemoveEntity(record->chunkIndex, record->row, true);
+
+	if (movedEntity != INVALID_ENTITY_ID)
+	{
+		EntityRecord_t& movedRecord = m_records[(uint32_t)movedEntity];
+		movedRecord.chunkIndex = record->chunkIndex;
+		movedRecord.row = record->row;
+	}
+
+	// Bumping the generation invalidates every copy of the old ID; 0 is skipped so IDs are never INVALID_ENTITY_ID
+	record->archetype = nullptr;
+	record->generation = (record->generation == UINT32_MAX ? 1 : record->generation + 1);
+
+	m_freeIndices.push_back((uint32_t)entityID);
+	m_entityCount--;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the ID refers to an entity that hasn't been destroyed
+//
+bool EntityWorld::IsAlive(EntityID entityID) const
+{
+	return (GetRecord(entityID) != nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of live entities
+//
+int EntityWorld::GetEntityCount() const
+{
+	return m_entityCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of distinct component sets seen so far
+//
+int EntityWorld::GetArchetypeCount() const
+{
+	return (int)m_archetypes.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destroys every entity and archetype
+//
+void EntityWorld::Clear()
+{
+	ASSERT_OR_DIE(m_iterationDepth == 0, "Error: EntityWorld::Clear() called while iterating");
+
+	for (int archetypeIndex = 0; archetypeIndex < (int)m_archetypes.size(); ++archetypeIndex)
+	{
+		delete m_archetypes[archetypeIndex];
+	}
+
+	m_archetypes.clear();
+	m_archetypesByMask.clear();
+
+	// Keep the generations, so IDs from before the clear stay dead
+	m_freeIndices.clear();
+	for (uint32_t index = 0; index < (uint32_t)m_records.size(); ++index)
+	{
+		EntityRecord_t& record = m_records[index];
+
+		if (record.archetype != nullptr)
+		{
+			record.archetype = nullptr;
+			record.generation = (record.generation == UINT32_MAX ? 1 : record.generation + 1);
+		}
+
+		m_freeIndices.push_back(index);
+	}
+
+	m_entityCount = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the entity's record, nullptr if the ID is stale
+//
+EntityWorld::EntityRecord_t* EntityWorld::GetRecord(EntityID entityID)
+{
+	uint32_t index = (uint32_t)entityID;
+	uint32_t generation = (uint32_t)(entityID >> 32);
+
+	if (index >= (uint32_t)m_records.size())
+	{
+		return nullptr;
+	}
+
+	EntityRecord_t& record = m_records[index];
+	return (record.archetype != nullptr && record.generation == generation ? &record : nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the entity's record, nullptr if the ID is stale
+//
+const EntityWorld::EntityRecord_t* EntityWorld::GetRecord(EntityID entityID) const
+{
+	return const_cast<EntityWorld*>(this)->GetRecord(entityID);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the archetype for exactly the given components, making it if this is the first use
+//
+EntityArchetype* EntityWorld::GetOrCreateArchetype(ComponentMask mask)
+{
+	std::unordered_map<ComponentMask, EntityArchetype*>::iterator itr = m_archetypesByMask.find(mask);
+
+	if (itr != m_archetypesByMask.end())
+	{
+		return itr->second;
+	}
+
+	EntityArchetype* archetype = new EntityArchetype(mask);
+	m_archetypes.push_back(archetype);
+	m_archetypesByMask[mask] = archetype;
+
+	return archetype;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Moves the entity's components to the archetype for newMask; components not in the new archetype
+// are destructed, and ones only in the new archetype are left for the caller to construct
+//
+void EntityWorld::MoveToArchetype(EntityID entityID, EntityRecord_t& record, ComponentMask newMask)
+{
+	EntityArchetype* oldArchetype = record.archetype;
+	EntityArchetype* newArchetype = GetOrCreateArchetype(newMask);
+
+	int newChunkIndex = 0;
+	int newRow = newArchetype->AddEntity(entityID, newChunkIndex);
+
+	const std::vector<int>& oldTypeIDs = oldArchetype->GetTypeIDs();
+	for (int typeIndex = 0; typeIndex < (int)oldTypeIDs.size(); ++typeIndex)
+	{
+		int typeID = oldTypeIDs[typeIndex];
+		const ComponentTypeInfo_t& info = ComponentRegistry::GetTypeInfo(typeID);
+		void* oldComponent = oldArchetype->GetComponent(record.chunkIndex, record.row, typeID);
+
+		if (newArchetype->HasComponent(typeID))
+		{
+			info.moveAndDestruct(newArchetype->GetComponent(newChunkIndex, newRow, typeID), oldComponent);
+		}
+		else
+		{
+			info.destruct(oldComponent);
+		}
+	}
+
+	EntityID movedEntity = oldArchetype->RemoveEntity(record.chunkIndex, record.row, false);
+
+	if (movedEntity != INVALID_ENTITY_ID)
+	{
+		EntityRecord_t& movedRecord = m_records[(uint32_t)movedEntity];
+		movedRecord.chunkIndex = record.chunkIndex;
+		movedRecord.row = record.row;
+	}
+
+	record.archetype = newArchetype;
+	record.chunkIndex = newChunkIndex;
+	record.row = newRow;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Collects every chunk of every archetype with all the components in the mask
+//
+void EntityWorld::GetMatchingChunks(ComponentMask mask, std::vector<ChunkQueryEntry_t>& out_chunks) const
+{
+	for (int archetypeIndex = 0; archetypeIndex < (int)m_archetypes.size(); ++archetypeIndex)
+	{
+		EntityArchetype* archetype = m_archetypes[archetypeIndex];
+
+		if ((archetype->GetMask() & mask) != mask)
+		{
+			continue;
+		}
+
+		for (int chunkIndex = 0; chunkIndex < archetype->GetChunkCount(); ++chunkIndex)
+		{
+			ChunkQueryEntry_t entry;
+			entry.archetype = archetype;
+			entry.chunk = archetype->GetChunk(chunkIndex);
+
+			out_chunks.push_back(entry);
+		}
+	}
+}
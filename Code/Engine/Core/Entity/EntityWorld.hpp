@@ -0,0 +1,257 @@
+/************************************************************************/
+/* File: EntityWorld.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Entities as IDs with components stored by archetype, so
+/*				per-frame systems walk packed arrays instead of chasing
+/*				pointers; queries can be split across the JobSystem
+/************************************************************************/
+#pragma once
+#include <tuple>
+#include <vector>
+#include <unordered_map>
+#include "Engine/Core/Entity/EntityArchetype.hpp"
+#include "Engine/Core/JobSystem/ParallelFor.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+
+// Systems that own their objects elsewhere can still use the layout by storing pointers as components,
+// i.e. world.AddComponent<Renderable*>(entity, renderable) next to a Transform and a bounds component
+// Components must be movable; they're moved whenever the entity changes archetype or another is removed
+
+class EntityWorld
+{
+public:
+	//-----Public Methods-----
+
+	EntityWorld();
+	~EntityWorld();
+
+	EntityID	CreateEntity();
+	void		DestroyEntity(EntityID entityID);
+	bool		IsAlive(EntityID entityID) const;
+	int			GetEntityCount() const;
+	int			GetArchetypeCount() const;
+	void		Clear();
+
+	// Replaces the component if the entity already has one; the reference is valid until the next structural change
+	template <typename T> T&	AddComponent(EntityID entityID, const T& component = T());
+	template <typename T> void	RemoveComponent(EntityID entityID);
+	template <typename T> T*	GetComponent(EntityID entityID) const;	// nullptr if the entity doesn't have it
+	template <typename T> bool	HasComponent(EntityID entityID) const;
+
+	// Calls function(EntityID, COMPONENTS&...) for every entity that has all of the components
+	// No creating, destroying, adding or removing during iteration
+	template <typename... COMPONENTS, typename FUNCTION> void ForEach(FUNCTION function);
+
+	// Same as ForEach, but with chunksPerJob chunks given to each job; the function is called concurrently,
+	// so it may only write the components it's given
+	template <typename... COMPONENTS, typename FUNCTION> void ParallelForEach(FUNCTION function, int chunksPerJob = 1);
+
+
+private:
+	//-----Private Types-----
+
+	struct EntityRecord_t
+	{
+		uint32_t			generation = 1;
+		EntityArchetype*	archetype = nullptr;	// nullptr while the index is free
+		int					chunkIndex = 0;
+		int					row = 0;
+	};
+
+	struct ChunkQueryEntry_t
+	{
+		EntityArchetype*	archetype = nullptr;
+		EntityChunk_t*		chunk = nullptr;
+	};
+
+
+private:
+	//-----Private Methods-----
+
+	EntityWorld(const EntityWorld& copy) = delete;
+
+	EntityRecord_t*			GetRecord(EntityID entityID);
+	const EntityRecord_t*	GetRecord(EntityID entityID) const;
+	EntityArchetype*		GetOrCreateArchetype(ComponentMask mask);
+	void					MoveToArchetype(EntityID entityID, EntityRecord_t& record, ComponentMask newMask);
+	void					GetMatchingChunks(ComponentMask mask, std::vector<ChunkQueryEntry_t>& out_chunks) const;
+
+	template <typename... COMPONENTS, typename FUNCTION>
+	static void				ForEachInChunk(EntityArchetype* archetype, EntityChunk_t* chunk, FUNCTION& function);
+
+	template <typename... COMPONENTS>
+	static ComponentMask	GetQueryMask();
+
+
+private:
+	//-----Private Data-----
+
+	std::vector<EntityRecord_t>							m_records;
+	std::vector<uint32_t>								m_freeIndices;
+	int													m_entityCount = 0;
+
+	std::vector<EntityArchetype*>						m_archetypes;
+	std::unordered_map<ComponentMask, EntityArchetype*>	m_archetypesByMask;
+
+	int													m_iterationDepth = 0;	// Structural changes are blocked while above 0
+
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the component to the entity, moving it to the archetype with the component
+//
+template <typename T>
+T& EntityWorld::AddComponent(EntityID entityID, const T& component /*= T()*/)
+{
+	ASSERT_OR_DIE(m_iterationDepth == 0, "Error: EntityWorld::AddComponent() called while iterating");
+
+	EntityRecord_t* record = GetRecord(entityID);
+	ASSERT_OR_DIE(record != nullptr, "Error: EntityWorld::AddComponent() called on a dead entity");
+
+	int typeID = ComponentRegistry::GetTypeID<T>();
+	T* existing = reinterpret_cast<T*>(record->archetype->GetComponent(record->chunkIndex, record->row, typeID));
+
+	if (existing != nullptr)
+	{
+		*existing = component;
+		return *existing;
+	}
+
+	MoveToArchetype(entityID, *record, record->archetype->GetMask() | ComponentRegistry::GetTypeMask<T>());
+
+	void* slot = record->archetype->GetComponent(record->chunkIndex, record->row, typeID);
+	return *(new (slot) T(component));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes the component from the entity, if it has it
+//
+template <typename T>
+void EntityWorld::RemoveComponent(EntityID entityID)
+{
+	ASSERT_OR_DIE(m_iterationDepth == 0, "Error: EntityWorld::RemoveComponent() called while iterating");
+
+	EntityRecord_t* record = GetRecord(entityID);
+	ComponentMask typeMask = ComponentRegistry::GetTypeMask<T>();
+
+	if (record == nullptr || (record->archetype->GetMask() & typeMask) == 0)
+	{
+		return;
+	}
+
+	MoveToArchetype(entityID, *record, record->archetype->GetMask() & ~typeMask);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the entity's component, or nullptr if it's dead or doesn't have one
+//
+template <typename T>
+T* EntityWorld::GetComponent(EntityID entityID) const
+{
+	const EntityRecord_t* record = GetRecord(entityID);
+
+	if (record == nullptr)
+	{
+		return nullptr;
+	}
+
+	return reinterpret_cast<T*>(record->archetype->GetComponent(record->chunkIndex, record->row, ComponentRegistry::GetTypeID<T>()));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the entity is alive and has the component
+//
+template <typename T>
+bool EntityWorld::HasComponent(EntityID entityID) const
+{
+	const EntityRecord_t* record = GetRecord(entityID);
+	return (record != nullptr && (record->archetype->GetMask() & ComponentRegistry::GetTypeMask<T>()) != 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Calls the function on every entity with all of the components, a chunk at a time
+//
+template <typename... COMPONENTS, typename FUNCTION>
+void EntityWorld::ForEach(FUNCTION function)
+{
+	ComponentMask queryMask = GetQueryMask<COMPONENTS...>();
+	m_iterationDepth++;
+
+	for (int archetypeIndex = 0; archetypeIndex < (int)m_archetypes.size(); ++archetypeIndex)
+	{
+		EntityArchetype* archetype = m_archetypes[archetypeIndex];
+
+		if ((archetype->GetMask() & queryMask) != queryMask)
+		{
+			continue;
+		}
+
+		for (int chunkIndex = 0; chunkIndex < archetype->GetChunkCount(); ++chunkIndex)
+		{
+			ForEachInChunk<COMPONENTS...>(archetype, archetype->GetChunk(chunkIndex), function);
+		}
+	}
+
+	m_iterationDepth--;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Calls the function on every entity with all of the components, with the chunks spread across jobs
+//
+template <typename... COMPONENTS, typename FUNCTION>
+void EntityWorld::ParallelForEach(FUNCTION function, int chunksPerJob /*= 1*/)
+{
+	std::vector<ChunkQueryEntry_t> chunks;
+	GetMatchingChunks(GetQueryMask<COMPONENTS...>(), chunks);
+
+	m_iterationDepth++;
+
+	ParallelFor(0, (int)chunks.size(), chunksPerJob, [&chunks, &function](int chunkIndex)
+	{
+		ForEachInChunk<COMPONENTS...>(chunks[chunkIndex].archetype, chunks[chunkIndex].chunk, function);
+	});
+
+	m_iterationDepth--;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Looks up each component's array once, then walks the rows
+//
+template <typename... COMPONENTS, typename FUNCTION>
+void EntityWorld::ForEachInChunk(EntityArchetype* archetype, EntityChunk_t* chunk, FUNCTION& function)
+{
+	EntityID* entityIDs = archetype->GetEntityIDs(chunk);
+	std::tuple<COMPONENTS*...> componentArrays(reinterpret_cast<COMPONENTS*>(archetype->GetComponentArray(chunk, ComponentRegistry::GetTypeID<COMPONENTS>()))...);
+
+	int count = chunk->count;
+	for (int row = 0; row < count; ++row)
+	{
+		function(entityIDs[row], std::get<COMPONENTS*>(componentArrays)[row]...);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the mask with the bit of each of the components set
+//
+template <typename... COMPONENTS>
+ComponentMask EntityWorld::GetQueryMask()
+{
+	ComponentMask mask = 0;
+	ComponentMask typeMasks[] = { (ComponentMask)0, ComponentRegistry::GetTypeMask<COMPONENTS>()... };
+
+	for (int typeIndex = 0; typeIndex < (int)(sizeof(typeMasks) / sizeof(typeMasks[0])); ++typeIndex)
+	{
+		mask |= typeMasks[typeIndex];
+	}
+
+	return mask;
+}
@@ -2,35 +2,17 @@
 /* File: EventSubscription.cpp
 /* Author: Andrew Chase
 /* Date: May 5th 2019
-/* Description: Implementation of the EventSubscription subclasses used by
-/*				the EventSystem
+/* Description: Implementation of the non-template subscription thunks
+/*				used by the EventSystem
 /************************************************************************/
 #include "Engine/Core/EventSystem/EventSubscription.hpp"
 
 
 //-----------------------------------------------------------------------------------------------
-// Constructor for an event that calls a standalone C function or a class static function
+// Calls the stored standalone C function or class static function
 //
-EventFunctionSubscription::EventFunctionSubscription(EventFunctionCallback callback)
-	: m_functionCallback(callback)
+bool InvokeEventFunction(const EventSubscription_t& subscription, NamedProperties& args)
 {
+	EventFunctionCallback callback = subscription.GetCallback<EventFunctionCallback>();
+	return callback(args);
 }
-
-
-//-----------------------------------------------------------------------------------------------
-// Destructor for an event that calls a standalone C function or a class static function
-//
-EventFunctionSubscription::~EventFunctionSubscription()
-{
-	m_functionCallback = nullptr;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-// Calls the function callback for this subscription
-//
-bool EventFunctionSubscription::Execute(NamedProperties& args)
-{
-	return m_functionCallback(args);
-}
-
@@ -2,70 +2,63 @@
 /* File: EventSubscription.hpp
 /* Author: Andrew Chase
 /* Date: May 5th 2019
-/* Description: Classes for representing subscriptions within the Event
-/*				System
+/* Description: Subscriptions within the Event System, stored by value
+/*				with a thunk for the kind of callback they call
 /************************************************************************/
 #pragma once
+#include <string.h>
+#include <stdint.h>
+#include <type_traits>
+#include "Engine/Core/Utility/StringID.hpp"
 
 class NamedProperties;
 typedef bool(*EventFunctionCallback)(NamedProperties& args);
 
-class EventSubscription
-{
-public:
-	//-----Public Methods-----
-	EventSubscription() {}
-	virtual ~EventSubscription() {}
-	virtual bool Execute(NamedProperties& args) = 0;
-};
-
-
-class EventFunctionSubscription : public EventSubscription
-{
-	friend class EventSystem;
-
-public:
-	//-----Public Methods-----
-
-	EventFunctionSubscription(EventFunctionCallback callback);
-	virtual ~EventFunctionSubscription();
-	virtual bool Execute(NamedProperties& args) override;
+// The StringID of the event name, so EVENT_ID() of a literal is worked out at compile time
+typedef StringID EventID;
 
+#define EVENT_ID(name) SID(name)
 
-private:
-	//-----Private Data-----
+// Big enough for a pointer to a method of any class, including ones with multiple or virtual bases
+#define EVENT_CALLBACK_STORAGE_SIZE (24)
 
-	EventFunctionCallback m_functionCallback = nullptr;
+// Returned on subscribing, for unsubscribing without knowing the callback
+struct EventSubscriptionHandle_t
+{
+	EventID		eventID = 0;
+	uint32_t	subscriptionID = 0;		// 0 is never handed out
 
+	bool IsValid() const { return (subscriptionID != 0); }
 };
 
+struct EventSubscription_t;
+typedef bool(*EventInvoke_cb)(const EventSubscription_t& subscription, NamedProperties& args);
 
-template <typename T>
-class EventObjectMethodSubscription : public EventSubscription
+// The callback is copied into the storage, and invoke knows its type
+struct EventSubscription_t
 {
-public:
-
-	friend class EventSystem;
-
-	// For saving off the function callback for each templated class version
-	typedef bool(T::*EventObjectMethodCallback)(NamedProperties& args);
-
-
-public:
-	//-----Public Methods-----
-
-	EventObjectMethodSubscription(EventObjectMethodCallback callback, T& object);
-	virtual ~EventObjectMethodSubscription();
-	virtual bool Execute(NamedProperties& args) override;
+	uint32_t		subscriptionID = 0;
+	EventInvoke_cb	invoke = nullptr;
+	void*			object = nullptr;		// nullptr for function subscriptions
+	alignas(8) unsigned char callbackStorage[EVENT_CALLBACK_STORAGE_SIZE];
+
+	template <typename CALLBACK_TYPE>
+	void		SetCallback(const CALLBACK_TYPE& callback);
+	template <typename CALLBACK_TYPE>
+	bool		HasCallback(const CALLBACK_TYPE& callback) const;
+	template <typename CALLBACK_TYPE>
+	CALLBACK_TYPE GetCallback() const;
+};
 
 
-private:
-	//-----Private Data-----
+//////////////////////////////////////////////////////////////////////////
+// Invoke Thunks
+//////////////////////////////////////////////////////////////////////////
 
-	T& m_object;
-	EventObjectMethodCallback m_methodCallback = nullptr;
+bool InvokeEventFunction(const EventSubscription_t& subscription, NamedProperties& args);
 
-};
+template <typename T, typename T_Method>
+bool InvokeEventObjectMethod(const EventSubscription_t& subscription, NamedProperties& args);
 
 
 //////////////////////////////////////////////////////////////////////////
@@ -74,31 +67,47 @@ private:
 
 
 //-----------------------------------------------------------------------------------------------
-// Constructor
+// Copies the callback into the subscription's storage
+//
+template <typename CALLBACK_TYPE>
+void EventSubscription_t::SetCallback(const CALLBACK_TYPE& callback)
+{
+	static_assert(sizeof(CALLBACK_TYPE) <= EVENT_CALLBACK_STORAGE_SIZE, "Event callback is too large for the subscription's storage");
+
+	memset(callbackStorage, 0, sizeof(callbackStorage));
+	memcpy(callbackStorage, &callback, sizeof(CALLBACK_TYPE));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the storage holds the given callback
 //
-template <typename T>
-EventObjectMethodSubscription<T>::EventObjectMethodSubscription(EventObjectMethodCallback callback, T& object)
-	: m_methodCallback(callback)
-	, m_object(object)
+template <typename CALLBACK_TYPE>
+bool EventSubscription_t::HasCallback(const CALLBACK_TYPE& callback) const
 {
+	return (memcmp(callbackStorage, &callback, sizeof(CALLBACK_TYPE)) == 0);
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Destructor
+// Returns the callback copied out of the storage
 //
-template <typename T>
-EventObjectMethodSubscription<T>::~EventObjectMethodSubscription()
+template <typename CALLBACK_TYPE>
+CALLBACK_TYPE EventSubscription_t::GetCallback() const
 {
-	m_methodCallback = nullptr;
+	CALLBACK_TYPE callback;
+	memcpy(&callback, callbackStorage, sizeof(CALLBACK_TYPE));
+
+	return callback;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Calls the method callback on the given object for this subscription
+// Calls the stored method on the subscription's object
 //
-template <typename T>
-bool EventObjectMethodSubscription<T>::Execute(NamedProperties& args)
+template <typename T, typename T_Method>
+bool InvokeEventObjectMethod(const EventSubscription_t& subscription, NamedProperties& args)
 {
-	return (m_object.*m_methodCallback)(args);
+	T_Method method = subscription.GetCallback<T_Method>();
+	return (((T*) subscription.object)->*method)(args);
 }
@@ -6,6 +6,7 @@
 /************************************************************************/
 #include "Engine/Core/EventSystem/EventSystem.hpp"
 #include "Engine/DataStructures/NamedProperties.hpp"
+#include "Engine/Core/Utility/StringUtils.hpp"
 #include "Engine/Core/Utility/ErrorWarningAssert.hpp"
 
 // Singleton instance
@@ -16,15 +17,29 @@ EventSystem* EventSystem::s_instance = nullptr;
 // Constructor
 //
 EventSystem::EventSystem()
+	: m_postedEvents(EVENT_SYSTEM_POST_QUEUE_CAPACITY)
+	, m_hasOverflowEvents(false)
 {
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Destructor
+// Destructor - posted events that were never dispatched are dropped
 //
 EventSystem::~EventSystem()
 {
+	PostedEvent_t postedEvent;
+	while (m_postedEvents.Dequeue(postedEvent))
+	{
+		delete postedEvent.args;
+	}
+
+	for (PostedEvent_t& overflowEvent : m_overflowEvents)
+	{
+		delete overflowEvent.args;
+	}
+
+	m_overflowEvents.clear();
 }
 
 
@@ -63,13 +78,13 @@ EventSystem* EventSystem::GetInstance()
 //-----------------------------------------------------------------------------------------------
 // Adds a subscription for the given function callback
 //
-void EventSystem::SubscribeEventCallbackFunction(const char* eventNameToSubTo, EventFunctionCallback callback)
+EventSubscriptionHandle_t EventSystem::SubscribeEventCallbackFunction(const char* eventNameToSubTo, EventFunctionCallback callback)
 {
-	EventFunctionSubscription* subscription = new EventFunctionSubscription(callback);
+	EventSubscription_t subscription;
+	subscription.invoke = &InvokeEventFunction;
+	subscription.SetCallback(callback);
 
-	// This creates the entry if there isn't one already
-	std::vector<EventSubscription*>& subsToEvent = m_subscriptions[eventNameToSubTo];
-	subsToEvent.push_back(subscription);
+	return AddSubscription(eventNameToSubTo, subscription);
 }
 
 
@@ -78,32 +93,56 @@ void EventSystem::SubscribeEventCallbackFunction(const char* eventNameToSubTo, E
 //
 void EventSystem::UnsubscribeEventCallbackFunction(const char* eventNameToUnsubFrom, EventFunctionCallback callback)
 {
-	std::vector<EventSubscription*>& subsToEvent = m_subscriptions[eventNameToUnsubFrom];
+	EventEntry_t* entry = FindEvent(HashStringID(eventNameToUnsubFrom));
 
-	int numSubs = (int)subsToEvent.size();
-	for (int subIndex = 0; subIndex < numSubs; ++subIndex)
+	if (entry != nullptr)
 	{
-		EventFunctionSubscription* currSub = dynamic_cast<EventFunctionSubscription*>(subsToEvent[subIndex]);
-
-		if (currSub != nullptr) // currSub is a standalone function subscription
+		int numSubs = (int)entry->subscriptions.size();
+		for (int subIndex = 0; subIndex < numSubs; ++subIndex)
 		{
-			if (currSub->m_functionCallback == callback) // currSub is the one for the given callback
-			{
-				subsToEvent.erase(subsToEvent.begin() + subIndex);
-
-				if (subsToEvent.size() == 0)
-				{
-					m_subscriptions.erase(eventNameToUnsubFrom);
-				}
+			const EventSubscription_t& currSub = entry->subscriptions[subIndex];
 
-				delete currSub;
+			if (currSub.invoke == &InvokeEventFunction && currSub.HasCallback(callback)) // currSub is the one for the given callback
+			{
+				RemoveSubscription(*entry, subIndex);
 				return;
 			}
 		}
 	}
 
 	// This is only reached if we don't find an event for this object and method callback
-	LogTaggedPrintf("EVENT", "Tried to unsubscribe a function subscription from event named \"%s\" but couldn't find it");
+	LogTaggedPrintf("EVENT", "Tried to unsubscribe a function subscription from event named \"%s\" but couldn't find it", eventNameToUnsubFrom);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes the subscription the handle was returned for, and invalidates the handle
+//
+bool EventSystem::Unsubscribe(EventSubscriptionHandle_t& handle)
+{
+	if (!handle.IsValid())
+	{
+		return false;
+	}
+
+	EventEntry_t* entry = FindEvent(handle.eventID);
+	uint32_t subscriptionID = handle.subscriptionID;
+	handle = EventSubscriptionHandle_t();
+
+	if (entry != nullptr)
+	{
+		int numSubs = (int)entry->subscriptions.size();
+		for (int subIndex = 0; subIndex < numSubs; ++subIndex)
+		{
+			if (entry->subscriptions[subIndex].subscriptionID == subscriptionID)
+			{
+				RemoveSubscription(*entry, subIndex);
+				return true;
+			}
+		}
+	}
+
+	return false;
 }
 
 
@@ -112,24 +151,286 @@ void EventSystem::UnsubscribeEventCallbackFunction(const char* eventNameToUnsubF
 //
 void EventSystem::FireEvent(const char* eventName, NamedProperties& args)
 {
-	bool subsToEventExist = (m_subscriptions.find(eventName) != m_subscriptions.end());
+	FireEvent(HashStringID(eventName), args);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Calls all callbacks subscribed to the event, in the order they subscribed, until one consumes it
+// Callbacks can subscribe and unsubscribe while it fires, so the entry is looked up by index each time
+//
+void EventSystem::FireEvent(EventID eventID, NamedProperties& args)
+{
+	EventEntry_t* entry = FindEvent(eventID);
 
-	if (subsToEventExist)
+	if (entry == nullptr)
 	{
-		std::vector<EventSubscription*>& subsToEvent = m_subscriptions[eventName];
+		return;
+	}
 
-		int numSubs = (int)subsToEvent.size();
+	size_t eventIndex = entry - m_events.data();
 
-		for (int subIndex = 0; subIndex < numSubs; ++subIndex)
+	for (size_t subIndex = 0; subIndex < m_events[eventIndex].subscriptions.size(); ++subIndex)
+	{
+		const EventSubscription_t& subscription = m_events[eventIndex].subscriptions[subIndex];
+		bool subConsumedEvent = subscription.invoke(subscription, args);
+
+		if (subConsumedEvent)
+		{
+			break;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues the event to be fired by the main thread on the next DispatchPostedEvents()
+//
+void EventSystem::PostEvent(const char* eventName, NamedProperties* args /*= nullptr*/, eEventCoalesceMode coalesceMode /*= EVENT_COALESCE_NONE*/)
+{
+	PostEvent(HashStringID(eventName), args, coalesceMode);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues the event to be fired by the main thread on the next DispatchPostedEvents()
+// Once the queue is full for the frame the rest go to the overflow list, which is dispatched after it,
+// and posts keep going there until the next dispatch so none jump ahead of those posted before them
+//
+void EventSystem::PostEvent(EventID eventID, NamedProperties* args /*= nullptr*/, eEventCoalesceMode coalesceMode /*= EVENT_COALESCE_NONE*/)
+{
+	PostedEvent_t postedEvent;
+	postedEvent.eventID = eventID;
+	postedEvent.args = args;
+	postedEvent.coalesceMode = coalesceMode;
+
+	if (!m_hasOverflowEvents.load(std::memory_order_acquire) && m_postedEvents.Enqueue(postedEvent))
+	{
+		return;
+	}
+
+	m_overflowLock.lock();
+	m_overflowEvents.push_back(postedEvent);
+	m_hasOverflowEvents.store(true, std::memory_order_release);
+	m_overflowLock.unlock();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Dispatches the events posted since the last frame
+//
+void EventSystem::BeginFrame()
+{
+	DispatchPostedEvents();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Fires everything posted so far, in the order it was posted on each thread
+// The batch is taken before any are fired, so events posted by the handlers wait for the next dispatch
+//
+void EventSystem::DispatchPostedEvents()
+{
+	// Handlers calling this again would clear the batch being dispatched
+	if (m_isDispatchingPostedEvents)
+	{
+		return;
+	}
+
+	m_isDispatchingPostedEvents = true;
+	m_dispatchBatch.clear();
+
+	PostedEvent_t postedEvent;
+	while (m_postedEvents.Dequeue(postedEvent))
+	{
+		m_dispatchBatch.push_back(postedEvent);
+	}
+
+	if (m_hasOverflowEvents.load(std::memory_order_acquire))
+	{
+		m_overflowLock.lock();
+
+		// Anything a thread queued before its first overflowed post is visible once its lock is taken,
+		// so draining again here keeps each thread's queued events ahead of its overflowed ones
+		while (m_postedEvents.Dequeue(postedEvent))
+		{
+			m_dispatchBatch.push_back(postedEvent);
+		}
+
+		m_dispatchBatch.insert(m_dispatchBatch.end(), m_overflowEvents.begin(), m_overflowEvents.end());
+		m_overflowEvents.clear();
+		m_hasOverflowEvents.store(false, std::memory_order_relaxed);
+		m_overflowLock.unlock();
+	}
+
+	// Walked from the back so the latest of each coalesced event is the one kept
+	m_coalescedEventIDs.clear();
+	for (int batchIndex = (int) m_dispatchBatch.size() - 1; batchIndex >= 0; --batchIndex)
+	{
+		PostedEvent_t& currEvent = m_dispatchBatch[batchIndex];
+		if (currEvent.coalesceMode != EVENT_COALESCE_KEEP_LATEST)
 		{
-			bool subConsumedEvent = subsToEvent[subIndex]->Execute(args);
+			continue;
+		}
 
-			if (subConsumedEvent)
+		bool alreadyKept = false;
+		for (EventID keptID : m_coalescedEventIDs)
+		{
+			if (keptID == currEvent.eventID)
 			{
+				alreadyKept = true;
 				break;
 			}
 		}
+
+		if (alreadyKept)
+		{
+			currEvent.isCoalescedAway = true;
+		}
+		else
+		{
+			m_coalescedEventIDs.push_back(currEvent.eventID);
+		}
 	}
+
+	for (size_t batchIndex = 0; batchIndex < m_dispatchBatch.size(); ++batchIndex)
+	{
+		const PostedEvent_t& currEvent = m_dispatchBatch[batchIndex];
+
+		if (!currEvent.isCoalescedAway)
+		{
+			if (currEvent.args != nullptr)
+			{
+				FireEvent(currEvent.eventID, *currEvent.args);
+			}
+			else
+			{
+				NamedProperties emptyArgs;
+				FireEvent(currEvent.eventID, emptyArgs);
+			}
+		}
+
+		delete currEvent.args;
+	}
+
+	m_dispatchBatch.clear();
+	m_isDispatchingPostedEvents = false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the event with the ID, or nullptr if nothing has subscribed to it yet
+//
+EventSystem::EventEntry_t* EventSystem::FindEvent(EventID eventID)
+{
+	if (m_eventSlots.size() == 0)
+	{
+		return nullptr;
+	}
+
+	uint32_t mask = (uint32_t) m_eventSlots.size() - 1;
+	uint32_t slotIndex = eventID & mask;
+
+	while (m_eventSlots[slotIndex] != 0)
+	{
+		EventEntry_t& entry = m_events[m_eventSlots[slotIndex] - 1];
+		if (entry.eventID == eventID)
+		{
+			return &entry;
+		}
+
+		slotIndex = (slotIndex + 1) & mask;
+	}
+
+	return nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the event for the name, adding it if it's new and growing the slots to stay at most half full
+//
+EventSystem::EventEntry_t& EventSystem::GetOrCreateEvent(const char* eventName)
+{
+	EventID eventID = InternStringID(eventName);
+	EventEntry_t* existing = FindEvent(eventID);
+
+	if (existing != nullptr)
+	{
+		GUARANTEE_OR_DIE(existing->name == eventName, Stringf("Error: EventSystem event names \"%s\" and \"%s\" hash to the same ID, rename one", existing->name.c_str(), eventName));
+		return *existing;
+	}
+
+	EventEntry_t entry;
+	entry.eventID = eventID;
+	entry.name = eventName;
+	m_events.push_back(entry);
+
+	if (m_events.size() * 2 > m_eventSlots.size())
+	{
+		size_t slotCount = (m_eventSlots.size() > 0 ? m_eventSlots.size() * 2 : EVENT_SYSTEM_INITIAL_SLOT_COUNT);
+		m_eventSlots.assign(slotCount, 0);
+
+		for (uint32_t eventIndex = 0; eventIndex < (uint32_t) m_events.size(); ++eventIndex)
+		{
+			InsertInSlots(eventIndex);
+		}
+	}
+	else
+	{
+		InsertInSlots((uint32_t) m_events.size() - 1);
+	}
+
+	return m_events.back();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Puts the event's index in the first empty slot from its ID
+//
+void EventSystem::InsertInSlots(uint32_t eventIndex)
+{
+	uint32_t mask = (uint32_t) m_eventSlots.size() - 1;
+	uint32_t slotIndex = m_events[eventIndex].eventID & mask;
+
+	while (m_eventSlots[slotIndex] != 0)
+	{
+		slotIndex = (slotIndex + 1) & mask;
+	}
+
+	m_eventSlots[slotIndex] = eventIndex + 1;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Gives the subscription an ID and appends it to the event's subscriptions
+//
+EventSubscriptionHandle_t EventSystem::AddSubscription(const char* eventName, EventSubscription_t& subscription)
+{
+	EventEntry_t& entry = GetOrCreateEvent(eventName);
+
+	subscription.subscriptionID = m_nextSubscriptionID++;
+	if (m_nextSubscriptionID == 0)
+	{
+		m_nextSubscriptionID = 1;
+	}
+
+	entry.subscriptions.push_back(subscription);
+
+	EventSubscriptionHandle_t handle;
+	handle.eventID = entry.eventID;
+	handle.subscriptionID = subscription.subscriptionID;
+
+	return handle;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes the subscription, keeping the rest in the order they subscribed
+// The event itself is kept even when it has no subscriptions left, so the slots never need tombstones
+//
+void EventSystem::RemoveSubscription(EventEntry_t& entry, int subscriptionIndex)
+{
+	entry.subscriptions.erase(entry.subscriptions.begin() + subscriptionIndex);
 }
 
 
@@ -151,3 +452,43 @@ void FireEvent(const char* eventName, NamedProperties& args)
 	EventSystem* eventSystem = EventSystem::GetInstance();
 	eventSystem->FireEvent(eventName, args);
 }
+
+
+//---C FUNCTION----------------------------------------------------------------------------------
+// Shortcut function for firing an event by ID with no parameters
+//
+void FireEvent(EventID eventID)
+{
+	NamedProperties args;
+	FireEvent(eventID, args);
+}
+
+
+//---C FUNCTION----------------------------------------------------------------------------------
+// Shortcut function for firing an event by ID on the singleton EventSystem instance
+//
+void FireEvent(EventID eventID, NamedProperties& args)
+{
+	EventSystem* eventSystem = EventSystem::GetInstance();
+	eventSystem->FireEvent(eventID, args);
+}
+
+
+//---C FUNCTION----------------------------------------------------------------------------------
+// Shortcut function for posting an event by name to the singleton EventSystem instance
+//
+void PostEvent(const char* eventName, NamedProperties* args /*= nullptr*/, eEventCoalesceMode coalesceMode /*= EVENT_COALESCE_NONE*/)
+{
+	EventSystem* eventSystem = EventSystem::GetInstance();
+	eventSystem->PostEvent(eventName, args, coalesceMode);
+}
+
+
+//---C FUNCTION----------------------------------------------------------------------------------
+// Shortcut function for posting an event by ID to the singleton EventSystem instance
+//
+void PostEvent(EventID eventID, NamedProperties* args /*= nullptr*/, eEventCoalesceMode coalesceMode /*= EVENT_COALESCE_NONE*/)
+{
+	EventSystem* eventSystem = EventSystem::GetInstance();
+	eventSystem->PostEvent(eventID, args, coalesceMode);
+}
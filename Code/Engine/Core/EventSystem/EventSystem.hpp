@@ -7,10 +7,26 @@
 #pragma once
 #include "Engine/Core/LogSystem.hpp"
 #include "Engine/Core/EventSystem/EventSubscription.hpp"
-#include <map>
+#include "Engine/DataStructures/MPMCQueue.hpp"
+#include <mutex>
+#include <atomic>
 #include <string>
 #include <vector>
 
+// Events are found by ID through an open addressed table, kept at most half full
+#define EVENT_SYSTEM_INITIAL_SLOT_COUNT (64)
+
+// Posted events wait in a lock free queue of this size, with any past it (and any posted after those,
+// until the next dispatch) kept in a locked overflow list
+#define EVENT_SYSTEM_POST_QUEUE_CAPACITY (4096)
+
+// For posted events, what to do with others of the same event posted the same frame
+enum eEventCoalesceMode
+{
+	EVENT_COALESCE_NONE,		// Each is dispatched
+	EVENT_COALESCE_KEEP_LATEST	// Only the last one posted with this mode is dispatched, i.e. for window resizes
+};
+
 class NamedProperties;
 class EventSystem
 {
@@ -21,15 +37,48 @@ public:
 	static void			Shutdown();
 	static EventSystem* GetInstance();
 
-	void SubscribeEventCallbackFunction(const char* eventNameToSubTo, EventFunctionCallback callback);
+	EventSubscriptionHandle_t SubscribeEventCallbackFunction(const char* eventNameToSubTo, EventFunctionCallback callback);
 	void UnsubscribeEventCallbackFunction(const char* eventNameToUnsubFrom, EventFunctionCallback callback);
 
 	template <typename T, typename T_Method>
-	void SubscribeEventCallbackObjectMethod(const char* eventNameToSubTo, T_Method callback, T& object);
+	EventSubscriptionHandle_t SubscribeEventCallbackObjectMethod(const char* eventNameToSubTo, T_Method callback, T& object);
 	template <typename T, typename T_Method>
 	void UnsubscribeEventCallbackObjectMethod(const char* eventNameToUnsubFrom, T_Method callback, T& object);
 
+	// Returns false if the subscription was already removed
+	bool Unsubscribe(EventSubscriptionHandle_t& handle);
+
+	// Firing by ID, i.e. FireEvent(EVENT_ID("name"), args), doesn't hash or allocate
 	void FireEvent(const char* eventName, NamedProperties& args);
+	void FireEvent(EventID eventID, NamedProperties& args);
+
+	// Safe from any thread - the event is queued and fired on the main thread by DispatchPostedEvents()
+	// The args are owned by the system once posted, and deleted after dispatch
+	void PostEvent(const char* eventName, NamedProperties* args = nullptr, eEventCoalesceMode coalesceMode = EVENT_COALESCE_NONE);
+	void PostEvent(EventID eventID, NamedProperties* args = nullptr, eEventCoalesceMode coalesceMode = EVENT_COALESCE_NONE);
+
+	// Called by the main thread at the start of the frame, dispatches everything posted since the last one
+	void BeginFrame();
+	void DispatchPostedEvents();
+
+
+private:
+	//-----Private Types-----
+
+	struct EventEntry_t
+	{
+		EventID								eventID = 0;
+		std::string							name;				// For messages, and catching two names that hash the same
+		std::vector<EventSubscription_t>	subscriptions;		// In the order they were made
+	};
+
+	struct PostedEvent_t
+	{
+		EventID				eventID = 0;
+		NamedProperties*	args = nullptr;
+		eEventCoalesceMode	coalesceMode = EVENT_COALESCE_NONE;
+		bool				isCoalescedAway = false;	// Set on dispatch when a later post replaces it
+	};
 
 
 private:
@@ -40,11 +89,30 @@ private:
 	~EventSystem();
 	EventSystem(const EventSystem& copy) = delete;
 
+	EventEntry_t*				FindEvent(EventID eventID);
+	EventEntry_t&				GetOrCreateEvent(const char* eventName);
+	void						InsertInSlots(uint32_t eventIndex);
+	EventSubscriptionHandle_t	AddSubscription(const char* eventName, EventSubscription_t& subscription);
+	void						RemoveSubscription(EventEntry_t& entry, int subscriptionIndex);
+
 
 private:
 	//-----Private Data-----
 
-	std::map<std::string, std::vector<EventSubscription*>> m_subscriptions;
+	std::vector<EventEntry_t>	m_events;			// Never removed from, so indices into it stay valid
+	std::vector<uint32_t>		m_eventSlots;		// Index into m_events + 1 per slot, 0 is empty
+	uint32_t					m_nextSubscriptionID = 1;
+
+	// Posted from any thread; only the main thread drains
+	MPMCQueue<PostedEvent_t>	m_postedEvents;
+	std::mutex					m_overflowLock;
+	std::vector<PostedEvent_t>	m_overflowEvents;
+	std::atomic<bool>			m_hasOverflowEvents;
+
+	// Reused by each dispatch, so draining doesn't allocate once they've grown
+	std::vector<PostedEvent_t>	m_dispatchBatch;
+	std::vector<EventID>		m_coalescedEventIDs;
+	bool						m_isDispatchingPostedEvents = false;
 
 	static EventSystem* s_instance;
 
@@ -59,13 +127,14 @@ private:
 // Creates and adds an object method subscription for the given object and callback
 //
 template <typename T, typename T_Method>
-void EventSystem::SubscribeEventCallbackObjectMethod(const char* eventNameToSubTo, T_Method callback, T& object)
+EventSubscriptionHandle_t EventSystem::SubscribeEventCallbackObjectMethod(const char* eventNameToSubTo, T_Method callback, T& object)
 {
-	EventObjectMethodSubscription<T>* subscription = new EventObjectMethodSubscription<T>(callback, object);
+	EventSubscription_t subscription;
+	subscription.invoke = &InvokeEventObjectMethod<T, T_Method>;
+	subscription.object = &object;
+	subscription.SetCallback(callback);
 
-	// This creates the entry if there isn't one already
-	std::vector<EventSubscription*>& subsToEvent = m_subscriptions[eventNameToSubTo];
-	subsToEvent.push_back(subscription);
+	return AddSubscription(eventNameToSubTo, subscription);
 }
 
 
@@ -75,32 +144,27 @@ void EventSystem::SubscribeEventCallbackObjectMethod(const char* eventNameToSubT
 template <typename T, typename T_Method>
 void EventSystem::UnsubscribeEventCallbackObjectMethod(const char* eventNameToUnsubFrom, T_Method callback, T& object)
 {
-	std::vector<EventSubscription*>& subsToEvent = m_subscriptions[eventNameToUnsubFrom];
+	EventEntry_t* entry = FindEvent(HashStringID(eventNameToUnsubFrom));
 
-	int numSubs = (int)subsToEvent.size();
-	for (int subIndex = 0; subIndex < numSubs; ++subIndex)
+	if (entry != nullptr)
 	{
-		EventObjectMethodSubscription<T>* currSub = dynamic_cast<EventObjectMethodSubscription<T>*>(subsToEvent[subIndex]);
+		EventInvoke_cb invoke = &InvokeEventObjectMethod<T, T_Method>;
 
-		if (currSub != nullptr) // currSub is an object method subscription
+		int numSubs = (int)entry->subscriptions.size();
+		for (int subIndex = 0; subIndex < numSubs; ++subIndex)
 		{
-			if (currSub->m_methodCallback == callback && &currSub->m_object == &object) // currSub is the one for the given object and callback
-			{
-				subsToEvent.erase(subsToEvent.begin() + subIndex);
+			const EventSubscription_t& currSub = entry->subscriptions[subIndex];
 
-				if (subsToEvent.size() == 0)
-				{
-					m_subscriptions.erase(eventNameToUnsubFrom);
-				}
-
-				delete currSub;
+			if (currSub.invoke == invoke && currSub.object == &object && currSub.HasCallback(callback)) // currSub is the one for the given object and callback
+			{
+				RemoveSubscription(*entry, subIndex);
 				return;
 			}
 		}
 	}
 
 	// This is only reached if we don't find an event for this object and method callback
-	LogTaggedPrintf("EVENT", "Tried to unsubscribe an object method subscription from event named \"%s\" but couldn't find it");
+	LogTaggedPrintf("EVENT", "Tried to unsubscribe an object method subscription from event named \"%s\" but couldn't find it", eventNameToUnsubFrom);
 }
 
 
@@ -109,3 +173,7 @@ void EventSystem::UnsubscribeEventCallbackObjectMethod(const char* eventNameToUn
 //////////////////////////////////////////////////////////////////////////
 void FireEvent(const char* name);
 void FireEvent(const char* eventName, NamedProperties& args);
+void FireEvent(EventID eventID);
+void FireEvent(EventID eventID, NamedProperties& args);
+void PostEvent(const char* eventName, NamedProperties* args = nullptr, eEventCoalesceMode coalesceMode = EVENT_COALESCE_NONE);
+void PostEvent(EventID eventID, NamedProperties* args = nullptr, eEventCoalesceMode coalesceMode = EVENT_COALESCE_NONE);
@@ -5,9 +5,11 @@
 /* Description: Implementation of the File Class + helper functions
 /************************************************************************/
 #include "Engine/Core/File.hpp"
+#include "Engine/Core/VirtualFileSystem.hpp"
 #include "Engine/Core/DeveloperConsole/DevConsole.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include <stdio.h>
+#include <string.h>
 #include <cstdlib>
 
 // For Windows directory functions
@@ -60,6 +62,12 @@ bool CloseFile(FILE* fileHandle)
 //
 void* FileReadToNewBuffer( char const *filename, size_t& out_size)
 {
+	char* packedData = VirtualFileSystem::ReadFromPacksToNewBuffer(filename, true, out_size);
+	if (packedData != nullptr)
+	{
+		return packedData;
+	}
+
 	FILE* fp = OpenFile(filename, "r");
 	if (fp == nullptr) 
 	{
@@ -84,6 +92,41 @@ void* FileReadToNewBuffer( char const *filename, size_t& out_size)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Reads the whole file into a new buffer, opened as binary so nothing gets translated on Windows
+// The buffer has a null after the data, and is nullptr if the file couldn't be opened
+//
+void* FileReadBinaryToNewBuffer(const char* filename, size_t& out_size)
+{
+	char* packedData = VirtualFileSystem::ReadFromPacksToNewBuffer(filename, false, out_size);
+	if (packedData != nullptr)
+	{
+		return packedData;
+	}
+
+	out_size = 0;
+
+	FILE* fp = OpenFile(filename, "rb");
+	if (fp == nullptr)
+	{
+		return nullptr;
+	}
+
+	fseek(fp, 0L, SEEK_END);
+	long fileSize = ftell(fp);
+	fseek(fp, 0L, SEEK_SET);
+
+	size_t bufferSize = (fileSize > 0 ? (size_t) fileSize : 0);
+	unsigned char* buffer = (unsigned char*) malloc(bufferSize + 1U);
+
+	out_size = fread(buffer, 1, bufferSize, fp);
+	buffer[out_size] = NULL;
+
+	CloseFile(fp);
+	return buffer;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Writes to the file given by filename, returning false if the file doesn't exist
 // Currently overwrites all file contents, does NOT append
@@ -126,6 +169,21 @@ std::string GetFullFilePath(const std::string& localFilePath)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns true if filepath names an existing file (not a directory)
+//
+bool DoesFileExist(const std::string& filepath)
+{
+	if (VirtualFileSystem::IsInPacks(filepath))
+	{
+		return true;
+	}
+
+	DWORD attributes = GetFileAttributesA(filepath.c_str());
+	return (attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY) == 0);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Destructor
 //
@@ -136,14 +194,21 @@ File::~File()
 
 //-----------------------------------------------------------------------------------------------
 // Opens the file given by filepath, using the appropriate flags
+// Read only opens check the packs first, and are then already in memory
 //
 bool File::Open(const char* filepath, const char* flags)
 {
-	if (m_filePointer != nullptr)
+	if (m_filePointer != nullptr || m_isMapped || m_data != nullptr)
 	{
 		Close();
 	}
 
+	bool isReadOnly = (strchr(flags, 'r') != nullptr && strchr(flags, '+') == nullptr);
+	if (isReadOnly && VirtualFileSystem::OpenFromPacks(filepath, (strchr(flags, 'b') == nullptr), *this))
+	{
+		return true;
+	}
+
 	m_filePointer = (void*) OpenFile(filepath, flags);
 
 	if (m_filePointer != nullptr)
@@ -156,6 +221,75 @@ bool File::Open(const char* filepath, const char* flags)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Maps the file read only, so its contents can be used in place without reading them into a buffer
+// Packed files point into the pack's mapping instead, unless they had to be decompressed
+//
+bool File::OpenMapped(const char* filepath)
+{
+	Close();
+
+	if (VirtualFileSystem::OpenFromPacks(filepath, false, *this))
+	{
+		return true;
+	}
+
+	return OpenMappedFromDisk(filepath);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Maps the file on disk, pages are only read as they're touched
+//
+bool File::OpenMappedFromDisk(const char* filepath)
+{
+	Close();
+
+	HANDLE fileHandle = CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize))
+	{
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	m_mappedFileHandle = (void*) fileHandle;
+	m_filePathOpened = filepath;
+	m_isMapped = true;
+	m_size = (size_t) fileSize.QuadPart;
+
+	// Empty files can't be mapped, but are still open with no data
+	if (m_size == 0)
+	{
+		return true;
+	}
+
+	HANDLE mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	void* view = (mappingHandle != NULL ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr);
+
+	if (view == nullptr)
+	{
+		if (mappingHandle != NULL)
+		{
+			CloseHandle(mappingHandle);
+		}
+
+		Close();
+		return false;
+	}
+
+	m_mappingHandle = (void*) mappingHandle;
+	m_data = (const char*) view;
+
+	return true;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Closes the file currently opened by this file
 //
@@ -164,7 +298,30 @@ bool File::Close()
 	bool success = CloseFile((FILE*) m_filePointer);
 	m_filePointer = nullptr;
 
-	if (m_data != nullptr)
+	if (m_isMapped)
+	{
+		if (m_data != nullptr)
+		{
+			UnmapViewOfFile((void*) m_data);
+			m_data = nullptr;
+		}
+
+		if (m_mappingHandle != nullptr)
+		{
+			CloseHandle((HANDLE) m_mappingHandle);
+			m_mappingHandle = nullptr;
+		}
+
+		CloseHandle((HANDLE) m_mappedFileHandle);
+		m_mappedFileHandle = nullptr;
+		m_isMapped = false;
+	}
+	else if (m_isPackView)
+	{
+		m_data = nullptr;
+		m_isPackView = false;
+	}
+	else if (m_data != nullptr)
 	{
 		free((void*)m_data);
 		m_data = nullptr;
@@ -180,6 +337,20 @@ bool File::Close()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Opens the file over the data, which is either freed on Close() or belongs to a mounted pack
+//
+void File::OpenInMemory(const char* filepath, const char* data, size_t size, bool takeOwnership)
+{
+	Close();
+
+	m_filePathOpened = filepath;
+	m_data = data;
+	m_size = size;
+	m_isPackView = !takeOwnership;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Writes the buffer data to the file currently opened by this file
 //
@@ -207,11 +378,78 @@ void File::Flush()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Copies up to maxByteCount bytes from the current offset, returning how many were read
+// Lets a decoder start on the first chunk instead of waiting for, and holding, the whole file
+//
+size_t File::Read(void* out_buffer, size_t maxByteCount)
+{
+	if (m_data != nullptr || m_isMapped)
+	{
+		size_t remainingBytes = (m_offset < m_size ? m_size - m_offset : 0);
+		size_t amountToRead = (maxByteCount < remainingBytes ? maxByteCount : remainingBytes);
+
+		memcpy(out_buffer, m_data + m_offset, amountToRead);
+		m_offset += amountToRead;
+		m_isAtEndOfFile = (m_offset >= m_size);
+
+		return amountToRead;
+	}
+
+	if (m_filePointer == nullptr)
+	{
+		return 0;
+	}
+
+	size_t amountRead = fread(out_buffer, 1, maxByteCount, (FILE*) m_filePointer);
+	m_isAtEndOfFile = (amountRead < maxByteCount);
+
+	return amountRead;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Moves the read offset by byteCount, clamped to the file
+//
+bool File::Skip(long byteCount)
+{
+	if (m_data != nullptr || m_isMapped)
+	{
+		if (byteCount < 0 && (size_t) -byteCount > m_offset)
+		{
+			m_offset = 0;
+		}
+		else
+		{
+			m_offset += byteCount;
+			m_offset = (m_offset > m_size ? m_size : m_offset);
+		}
+
+		m_isAtEndOfFile = (m_offset >= m_size);
+		return true;
+	}
+
+	if (m_filePointer == nullptr)
+	{
+		return false;
+	}
+
+	m_isAtEndOfFile = false;
+	return (fseek((FILE*) m_filePointer, byteCount, SEEK_CUR) == 0);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Reads the file contents into memory
 //
 bool File::LoadFileToMemory()
 {
+	// Already in memory, mapped or read from a pack
+	if (m_isMapped || m_data != nullptr)
+	{
+		return true;
+	}
+
 	m_size = 0U; 
 
 	FILE* fp = (FILE*) m_filePointer;
@@ -249,8 +487,9 @@ unsigned int File::GetNextLine(std::string& out_string)
 		return m_lineNumber;
 	}
 
-	unsigned int endIndex = m_offset;
-	while (m_data[endIndex] != '\n' && endIndex < m_size)
+	// Bounds checked first, since mapped data isn't null terminated
+	size_t endIndex = m_offset;
+	while (endIndex < m_size && m_data[endIndex] != '\n')
 	{
 		endIndex++;
 	}
@@ -298,3 +537,12 @@ std::string File::GetFilePathOpened() const
 {
 	return m_filePathOpened;
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the data points at mapped pages rather than a copy, from disk or a pack
+//
+bool File::IsMapped() const
+{
+	return (m_isMapped || m_isPackView);
+}
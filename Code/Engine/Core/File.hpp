@@ -4,23 +4,25 @@
 /* Date: July 10th, 2018
 /* Description: File for File I/O utility functions
 /************************************************************************/
+#pragma once
 #include <string>
 #include "Engine/Core/EngineCommon.hpp"
 
 TODO("Remove these excess functions, and make everything use the File class");
 TODO("Make enumeration for file open flags");
-TODO("Update files to not have to load all to memory");
 TODO("File flush");
 
-// File I/O
+// File I/O - OpenFile() always goes to disk, the rest check the mounted packs first (see VirtualFileSystem)
 FILE*				OpenFile(const char* filepath, const char* flags);
 bool				CloseFile(FILE* fileHandle);
 void*				FileReadToNewBuffer( char const *filename, size_t& out_size);
+void*				FileReadBinaryToNewBuffer(const char* filename, size_t& out_size);
 bool				FileWriteFromBuffer(char const *filename, char const* buffer, int bufferSize);
 					
 // Windows directory
 std::string			GetWorkingDirectory();
 std::string			GetFullFilePath(const std::string& localFilePath);
+bool				DoesFileExist(const std::string& filepath);
 
 
 // Class to represent a single file object
@@ -33,23 +35,33 @@ public:
 	File() {}
 	~File();
 
-	// Opening/Closing
+	// Opening/Closing, reads are served from the mounted packs when they have the file
 	bool Open(const char* filepath, const char* flags);
+	bool OpenMapped(const char* filepath);		// Read only, GetData() then points at the file's pages instead of a copy
+	bool OpenMappedFromDisk(const char* filepath);	// Skips the packs, for mapping the packs themselves
 	bool Close();
 
+	// For the VirtualFileSystem, opens the file over data already in memory; owned data is freed on Close()
+	void OpenInMemory(const char* filepath, const char* data, size_t size, bool takeOwnership);
+
 	// Read/Writing
-	bool LoadFileToMemory();
-	void Write(const char* buffer, size_t length);
-	void Write(uint8_t* buffer, size_t length);
-	void Flush();
+	bool	LoadFileToMemory();
+	void	Write(const char* buffer, size_t length);
+	void	Write(uint8_t* buffer, size_t length);
+	void	Flush();
+
+	// Streaming reads from the current offset, out of memory if the file is loaded or mapped
+	size_t	Read(void* out_buffer, size_t maxByteCount);
+	bool	Skip(long byteCount);		// Negative to go back
 
 	// For manipulating files loaded into memory
 	unsigned int	GetNextLine(std::string& out_string);
 	bool			IsAtEndOfFile() const;
 
 	size_t			GetSize() const;
-	const char*		GetData() const;
+	const char*		GetData() const;		// Not null terminated if mapped
 	std::string		GetFilePathOpened() const;
+	bool			IsMapped() const;
 
 
 private:
@@ -63,8 +75,14 @@ private:
 	size_t		m_size = 0;
 	const char* m_data = nullptr;
 
+	// Mapped views, as HANDLEs to keep windows.h out of this header
+	void*		m_mappedFileHandle = nullptr;
+	void*		m_mappingHandle = nullptr;
+	bool		m_isMapped = false;
+	bool		m_isPackView = false;	// m_data points into a mounted pack, which owns it
+
 	// For parsing file contents loaded into memory
-	unsigned int	m_offset = 0;
+	size_t			m_offset = 0;
 	bool			m_isAtEndOfFile = false;
 	unsigned int	m_lineNumber = 0;
 
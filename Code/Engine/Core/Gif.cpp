@@ -29,9 +29,6 @@ Gif::Gif()
 //
 Gif::~Gif()
 {
-	delete m_stopwatch;
-	m_stopwatch = nullptr;
-
 	free((void*)m_gifData);
 	m_gifData = nullptr;
 	
@@ -85,8 +82,7 @@ bool Gif::LoadFromFile(const std::string& filepath)
 
 
 	// For now just play the gif at the rate given by the first frame's delay
-	m_stopwatch = new Stopwatch(nullptr);
-	m_stopwatch->SetInterval((float) delays[0] / 1000.f);
+	m_stopwatch.SetInterval((float) delays[0] / 1000.f);
 
 	// Return success
 	return true;
@@ -107,7 +103,7 @@ IntVector2 Gif::GetDimensions() const
 //
 Texture* Gif::GetNextFrame()
 {
-	m_currFrameIndex += (int) m_stopwatch->DecrementByIntervalAll();
+	m_currFrameIndex += (int) m_stopwatch.DecrementByIntervalAll();
 
 	if (m_currFrameIndex > (unsigned int) m_frameTextures.size() - 1)
 	{
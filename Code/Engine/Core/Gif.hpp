@@ -7,9 +7,9 @@
 #pragma once
 #include <vector>
 #include "Engine/Core/Image.hpp"
+#include "Engine/Core/Time/Stopwatch.hpp"
 
 class Texture;
-class Stopwatch;
 
 class Gif
 {
@@ -36,7 +36,7 @@ private:
 	unsigned char*			m_gifData;
 
 	// For playback
-	Stopwatch*				m_stopwatch;
+	Stopwatch				m_stopwatch;
 	unsigned int			m_currFrameIndex;
 	std::vector<Texture*>	m_frameTextures;
 
@@ -5,12 +5,37 @@
 /* Bugs: None
 /* Description: Implementation of the Image class, indexed as top left (0,0)
 /************************************************************************/
+#include <math.h>
+#include <string.h>
+#include "Engine/Core/File.hpp"
 #include "Engine/Core/Image.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/JobSystem/ParallelFor.hpp"
 #include "Engine/Core/Utility/StringUtils.hpp"
 #include "Engine/Core/Utility/ErrorWarningAssert.hpp"
 #include "Engine/Core/DeveloperConsole/DevConsole.hpp"
 #include "ThirdParty/stb/stb_image.h"
 
+// SSSE3 has the byte shuffle the RGB to RGBA expansion needs, SSE2 alone doesn't
+#if defined(__SSSE3__) || defined(__AVX__)
+#define IMAGE_SIMD_SSSE3
+#include <tmmintrin.h>
+#endif
+
+// Roughly how many bytes of rows each job takes, smaller images are done on the calling thread
+#define IMAGE_BYTES_PER_JOB (64 * 1024)
+
+#define IMAGE_KAISER_RADIUS (3.f)	// In destination texels
+#define IMAGE_KAISER_BETA (4.f)
+
+// Taps for one destination texel along one axis, of a separable resize
+struct ImageFilterTaps_t
+{
+	int		firstSourceIndex = 0;
+	int		weightStart = 0;		// Into the weights array shared by all the taps
+	int		weightCount = 0;
+};
+
 // 4 texel white image, used for solid color rendering
 const Image Image::IMAGE_WHITE;
 const Image Image::IMAGE_WHITE_TINT = Image(IntVector2(2, 2), Rgba(255, 255, 255, 150));
@@ -18,6 +43,17 @@ const Image Image::IMAGE_FLAT = Image(IntVector2(2, 2), Rgba(127, 127, 255, 255)
 const Image Image::IMAGE_BLACK = Image(IntVector2(2, 2), Rgba::BLACK);
 const Image Image::IMAGE_DEFAULT_TEXTURE = Image(IntVector2(64, 64), IntVector2(8, 8), Rgba::BLUE, Rgba::GRAY);
 
+// stb reads through these, so it decodes the file as it comes in instead of from a copy of all of it
+static int	ReadImageFileChunk(void* user, char* out_data, int size);
+static void	SkipImageFile(void* user, int byteCount);
+static int	IsAtEndOfImageFile(void* user);
+
+static int		GetRowsPerJob(int rowByteCount);
+static float	EvaluateImageFilter(ImageFilter filter, float distance);
+static float	EvaluateBesselI0(float x);
+static void		BuildFilterTaps(ImageFilter filter, int sourceSize, int destinationSize, std::vector<ImageFilterTaps_t>& out_taps, std::vector<float>& out_weights);
+static void		HalveImageRows(const unsigned char* source, const IntVector2& sourceDimensions, unsigned char* destination, int numComponents, int destinationRowBegin, int destinationRowEnd);
+
 
 //-----------------------------------------------------------------------------------------------
 // Default constructor, just makes a white 2x2 texel image
@@ -124,8 +160,20 @@ bool Image::LoadFromFile(const std::string& filepath)
 	m_numComponentsPerTexel = 0;		// Filled in for us to indicate how many color/alpha components the image had (e.g. 3=RGB, 4=RGBA)
 	int numComponentsRequested = 0;		// don't care; we support 3 (RGB) or 4 (RGBA)
 
-	// Load (and decompress) the image RGB(A) bytes from a file on disk
-	m_imageData = stbi_load(filepath.c_str(), &m_dimensions.x, &m_dimensions.y, &m_numComponentsPerTexel, numComponentsRequested);
+	// Load (and decompress) the image RGB(A) bytes from a file on disk, streamed in chunks
+	File file;
+	Unload();
+
+	if (file.Open(filepath.c_str(), "rb"))
+	{
+		stbi_io_callbacks callbacks;
+		callbacks.read = ReadImageFileChunk;
+		callbacks.skip = SkipImageFile;
+		callbacks.eof = IsAtEndOfImageFile;
+
+		m_imageData = stbi_load_from_callbacks(&callbacks, &file, &m_dimensions.x, &m_dimensions.y, &m_numComponentsPerTexel, numComponentsRequested);
+		file.Close();
+	}
 
 	if (DevConsole::GetInstance() != nullptr)
 	{
@@ -234,6 +282,15 @@ bool Image::IsFlippedForTextures() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns how much memory the texel data takes
+//
+size_t Image::GetByteCount() const
+{
+	return (size_t) GetTexelCount() * (size_t) m_numComponentsPerTexel;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Sets the texel at (x, y) to the color specified
 //
@@ -252,32 +309,440 @@ void Image::SetTexel(int x, int y, const Rgba& color)
 
 
 //-----------------------------------------------------------------------------------------------
-// Flips the image horizontally (over the X axis, making the top row the bottom row, and so on) 
+// Flips the image vertically (making the top row the bottom row, and so on), swapping rows in place
 //
 void Image::FlipVertical()
 {
-	// Create a temp vector for assembly
-	int numTexels = GetTexelCount();
+	int rowByteCount = m_dimensions.x * m_numComponentsPerTexel;
+	int halfHeight = m_dimensions.y / 2;
 
-	int numComponents = numTexels * m_numComponentsPerTexel;
-	unsigned char* newBuffer = (unsigned char*)malloc(sizeof(unsigned char) * numComponents);
+	ParallelForRange(0, halfHeight, GetRowsPerJob(rowByteCount), [this, rowByteCount](int rowBegin, int rowEnd)
+	{
+		unsigned char swapBuffer[1024];
+
+		for (int rowIndex = rowBegin; rowIndex < rowEnd; ++rowIndex)
+		{
+			unsigned char* topRow = m_imageData + (size_t) rowIndex * rowByteCount;
+			unsigned char* bottomRow = m_imageData + (size_t) (m_dimensions.y - 1 - rowIndex) * rowByteCount;
 
-	for (int rowIndex = m_dimensions.y - 1; rowIndex >= 0; --rowIndex)	// Start from the last (bottom) row and work back up
+			for (int byteOffset = 0; byteOffset < rowByteCount; byteOffset += (int) sizeof(swapBuffer))
+			{
+				size_t byteCount = (size_t) MinInt((int) sizeof(swapBuffer), rowByteCount - byteOffset);
+
+				memcpy(swapBuffer, topRow + byteOffset, byteCount);
+				memcpy(topRow + byteOffset, bottomRow + byteOffset, byteCount);
+				memcpy(bottomRow + byteOffset, swapBuffer, byteCount);
+			}
+		}
+	});
+
+	m_isFlippedForTextures = !m_isFlippedForTextures;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Expands the texels to RGBA - grayscale is copied to rgb, and alpha is opaque if there wasn't any
+//
+void Image::ConvertToRGBA()
+{
+	if (m_numComponentsPerTexel == 4 || m_imageData == nullptr)
 	{
-		for (int colIndex = 0; colIndex < m_dimensions.x; ++colIndex)
+		return;
+	}
+
+	int sourceComponents = m_numComponentsPerTexel;
+	unsigned char* sourceData = m_imageData;
+	unsigned char* destinationData = (unsigned char*)malloc(sizeof(unsigned char) * 4 * GetTexelCount());
+
+	ParallelForRange(0, m_dimensions.y, GetRowsPerJob(m_dimensions.x * 4), [&](int rowBegin, int rowEnd)
+	{
+		int texelBegin = rowBegin * m_dimensions.x;
+		int texelEnd = rowEnd * m_dimensions.x;
+
+		const unsigned char* source = sourceData + (size_t) texelBegin * sourceComponents;
+		unsigned char* destination = destinationData + (size_t) texelBegin * 4;
+		int texelIndex = texelBegin;
+
+#if defined(IMAGE_SIMD_SSSE3)
+		if (sourceComponents == 3)
 		{
-			Rgba currTexel = GetTexelColor(colIndex, rowIndex);
+			// 4 texels a step - 16 bytes are loaded for the 12 used, so stop while that's still in bounds
+			const __m128i expandMask = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+			const __m128i alphaBits = _mm_set1_epi32((int) 0xFF000000);
+			int lastSafeTexel = MinInt(texelEnd, GetTexelCount() - 2);
 
-			// Temporarily swap the buffers to make use of the SetTexel function
-			unsigned char* temp = m_imageData;
-			m_imageData = newBuffer;
-			SetTexel(colIndex, m_dimensions.y - rowIndex - 1, currTexel);
-			m_imageData = temp;
+			for (; texelIndex + 4 <= lastSafeTexel; texelIndex += 4)
+			{
+				__m128i rgb = _mm_loadu_si128((const __m128i*) source);
+				__m128i rgba = _mm_or_si128(_mm_shuffle_epi8(rgb, expandMask), alphaBits);
+				_mm_storeu_si128((__m128i*) destination, rgba);
+
+				source += 12;
+				destination += 16;
+			}
+		}
+#endif
+
+		for (; texelIndex < texelEnd; ++texelIndex)
+		{
+			unsigned char r = source[0];
+			unsigned char g = (sourceComponents >= 3 ? source[1] : r);
+			unsigned char b = (sourceComponents >= 3 ? source[2] : r);
+			unsigned char a = (sourceComponents == 2 ? source[1] : 255);
+
+			destination[0] = r;
+			destination[1] = g;
+			destination[2] = b;
+			destination[3] = a;
+
+			source += sourceComponents;
+			destination += 4;
 		}
+	});
+
+	free(m_imageData);
+	m_imageData = destinationData;
+	m_numComponentsPerTexel = 4;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Collapses the texels to one component of luminance, in 8 bit fixed point so the loop vectorizes
+//
+void Image::ConvertToGrayscale()
+{
+	if (m_numComponentsPerTexel == 1 || m_imageData == nullptr)
+	{
+		return;
 	}
 
+	int sourceComponents = m_numComponentsPerTexel;
+	unsigned char* sourceData = m_imageData;
+	unsigned char* destinationData = (unsigned char*)malloc(sizeof(unsigned char) * GetTexelCount());
+
+	ParallelForRange(0, m_dimensions.y, GetRowsPerJob(m_dimensions.x * sourceComponents), [&](int rowBegin, int rowEnd)
+	{
+		int texelBegin = rowBegin * m_dimensions.x;
+		int texelEnd = rowEnd * m_dimensions.x;
+
+		if (sourceComponents == 2)
+		{
+			for (int texelIndex = texelBegin; texelIndex < texelEnd; ++texelIndex)
+			{
+				destinationData[texelIndex] = sourceData[texelIndex * 2];
+			}
+
+			return;
+		}
+
+		// Same weights as GetTexelGrayScale(), out of 256
+		for (int texelIndex = texelBegin; texelIndex < texelEnd; ++texelIndex)
+		{
+			const unsigned char* source = sourceData + (size_t) texelIndex * sourceComponents;
+			unsigned int luminance = 54u * source[0] + 183u * source[1] + 19u * source[2] + 128u;
+
+			destinationData[texelIndex] = (unsigned char) (luminance >> 8);
+		}
+	});
+
 	free(m_imageData);
-	m_imageData = newBuffer;
+	m_imageData = destinationData;
+	m_numComponentsPerTexel = 1;
+}
 
-	m_isFlippedForTextures = !m_isFlippedForTextures;
+
+//-----------------------------------------------------------------------------------------------
+// Returns a new image of this one resampled to the dimensions, filtering along x then y
+// Edges are clamped, and texels are filtered as they're stored (not premultiplied or linearized)
+//
+Image* Image::CreateResized(const IntVector2& dimensions, ImageFilter filter /*= IMAGE_FILTER_KAISER*/) const
+{
+	GUARANTEE_OR_DIE(dimensions.x > 0 && dimensions.y > 0, Stringf("Error: Image::CreateResized() given dimensions (%i, %i)", dimensions.x, dimensions.y));
+
+	int numComponents = m_numComponentsPerTexel;
+
+	std::vector<ImageFilterTaps_t> xTaps, yTaps;
+	std::vector<float> xWeights, yWeights;
+	BuildFilterTaps(filter, m_dimensions.x, dimensions.x, xTaps, xWeights);
+	BuildFilterTaps(filter, m_dimensions.y, dimensions.y, yTaps, yWeights);
+
+	// Horizontal pass, every source row to the destination width
+	int intermediateRowCount = dimensions.x * numComponents;
+	std::vector<float> intermediate((size_t) intermediateRowCount * m_dimensions.y);
+
+	ParallelForRange(0, m_dimensions.y, GetRowsPerJob(m_dimensions.x * numComponents), [&](int rowBegin, int rowEnd)
+	{
+		for (int rowIndex = rowBegin; rowIndex < rowEnd; ++rowIndex)
+		{
+			const unsigned char* sourceRow = m_imageData + (size_t) rowIndex * m_dimensions.x * numComponents;
+			float* destinationRow = &intermediate[(size_t) rowIndex * intermediateRowCount];
+
+			for (int x = 0; x < dimensions.x; ++x)
+			{
+				const ImageFilterTaps_t& taps = xTaps[x];
+				float sums[4] = { 0.f, 0.f, 0.f, 0.f };
+
+				for (int tapIndex = 0; tapIndex < taps.weightCount; ++tapIndex)
+				{
+					int sourceX = ClampInt(taps.firstSourceIndex + tapIndex, 0, m_dimensions.x - 1);
+					float weight = xWeights[taps.weightStart + tapIndex];
+
+					for (int componentIndex = 0; componentIndex < numComponents; ++componentIndex)
+					{
+						sums[componentIndex] += weight * (float) sourceRow[sourceX * numComponents + componentIndex];
+					}
+				}
+
+				for (int componentIndex = 0; componentIndex < numComponents; ++componentIndex)
+				{
+					destinationRow[x * numComponents + componentIndex] = sums[componentIndex];
+				}
+			}
+		}
+	});
+
+	// Vertical pass, into the bytes
+	unsigned char* resizedData = (unsigned char*)malloc(sizeof(unsigned char) * dimensions.x * dimensions.y * numComponents);
+
+	ParallelForRange(0, dimensions.y, GetRowsPerJob(intermediateRowCount), [&](int rowBegin, int rowEnd)
+	{
+		for (int rowIndex = rowBegin; rowIndex < rowEnd; ++rowIndex)
+		{
+			const ImageFilterTaps_t& taps = yTaps[rowIndex];
+			unsigned char* destinationRow = resizedData + (size_t) rowIndex * intermediateRowCount;
+
+			for (int valueIndex = 0; valueIndex < intermediateRowCount; ++valueIndex)
+			{
+				float sum = 0.f;
+
+				for (int tapIndex = 0; tapIndex < taps.weightCount; ++tapIndex)
+				{
+					int sourceY = ClampInt(taps.firstSourceIndex + tapIndex, 0, m_dimensions.y - 1);
+					sum += yWeights[taps.weightStart + tapIndex] * intermediate[(size_t) sourceY * intermediateRowCount + valueIndex];
+				}
+
+				destinationRow[valueIndex] = (unsigned char) ClampInt((int) (sum + 0.5f), 0, 255);
+			}
+		}
+	});
+
+	Image* resizedImage = new Image(dimensions, numComponents, resizedData);
+	resizedImage->m_isFlippedForTextures = m_isFlippedForTextures;
+
+	return resizedImage;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Pushes each level below this one, halving down to 1x1
+// Box filtering with even dimensions averages 2x2 blocks directly, anything else is resampled
+//
+void Image::CreateMipChain(std::vector<Image*>& out_mipLevels, ImageFilter filter /*= IMAGE_FILTER_BOX*/) const
+{
+	const Image* previousLevel = this;
+
+	while (previousLevel->m_dimensions.x > 1 || previousLevel->m_dimensions.y > 1)
+	{
+		IntVector2 previousDimensions = previousLevel->m_dimensions;
+		IntVector2 levelDimensions = IntVector2(MaxInt(previousDimensions.x / 2, 1), MaxInt(previousDimensions.y / 2, 1));
+
+		Image* level = nullptr;
+		bool canHalve = (previousDimensions.x % 2 == 0) && (previousDimensions.y % 2 == 0);
+
+		if (filter == IMAGE_FILTER_BOX && canHalve)
+		{
+			int numComponents = previousLevel->m_numComponentsPerTexel;
+			unsigned char* levelData = (unsigned char*)malloc(sizeof(unsigned char) * levelDimensions.x * levelDimensions.y * numComponents);
+
+			ParallelForRange(0, levelDimensions.y, GetRowsPerJob(previousDimensions.x * numComponents * 2), [&](int rowBegin, int rowEnd)
+			{
+				HalveImageRows(previousLevel->m_imageData, previousDimensions, levelData, numComponents, rowBegin, rowEnd);
+			});
+
+			level = new Image(levelDimensions, numComponents, levelData);
+			level->m_isFlippedForTextures = m_isFlippedForTextures;
+		}
+		else
+		{
+			// Kaiser from the previous level rather than the top keeps the taps per texel constant
+			level = previousLevel->CreateResized(levelDimensions, filter);
+		}
+
+		out_mipLevels.push_back(level);
+		previousLevel = level;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Frees the texel data, leaving the image empty
+//
+void Image::Unload()
+{
+	free((void*)m_imageData);
+	m_imageData = nullptr;
+
+	m_dimensions = IntVector2(0, 0);
+	m_numComponentsPerTexel = 0;
+	m_isFlippedForTextures = false;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Reads the next chunk stb asks for, returning how many bytes were read
+//
+static int ReadImageFileChunk(void* user, char* out_data, int size)
+{
+	return (int) ((File*) user)->Read(out_data, (size_t) size);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Skips ahead, or back if byteCount is negative
+//
+static void SkipImageFile(void* user, int byteCount)
+{
+	((File*) user)->Skip((long) byteCount);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns nonzero once the file has been read to the end
+//
+static int IsAtEndOfImageFile(void* user)
+{
+	return (((File*) user)->IsAtEndOfFile() ? 1 : 0);
+}
+
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns how many rows of the given size make up about IMAGE_BYTES_PER_JOB
+//
+static int GetRowsPerJob(int rowByteCount)
+{
+	return MaxInt(IMAGE_BYTES_PER_JOB / MaxInt(rowByteCount, 1), 1);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the filter's weight at the distance, in destination texels, from the texel's center
+//
+static float EvaluateImageFilter(ImageFilter filter, float distance)
+{
+	distance = fabsf(distance);
+
+	if (filter == IMAGE_FILTER_BOX)
+	{
+		return (distance < 0.5f ? 1.f : 0.f);
+	}
+
+	if (distance >= IMAGE_KAISER_RADIUS)
+	{
+		return 0.f;
+	}
+
+	float sinc = 1.f;
+	if (distance > 0.0001f)
+	{
+		float piDistance = 3.14159265f * distance;
+		sinc = sinf(piDistance) / piDistance;
+	}
+
+	float windowPosition = distance / IMAGE_KAISER_RADIUS;
+	float window = EvaluateBesselI0(IMAGE_KAISER_BETA * sqrtf(1.f - windowPosition * windowPosition)) / EvaluateBesselI0(IMAGE_KAISER_BETA);
+
+	return sinc * window;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Zeroth order modified Bessel function of the first kind, by its power series
+//
+static float EvaluateBesselI0(float x)
+{
+	float sum = 1.f;
+	float term = 1.f;
+	float halfXSquared = 0.25f * x * x;
+
+	for (int termIndex = 1; termIndex < 16; ++termIndex)
+	{
+		term *= halfXSquared / (float) (termIndex * termIndex);
+		sum += term;
+	}
+
+	return sum;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Works out which source texels each destination texel reads along one axis, and their normalized weights
+// Minifying widens the filter to cover the source texels each destination texel spans
+//
+static void BuildFilterTaps(ImageFilter filter, int sourceSize, int destinationSize, std::vector<ImageFilterTaps_t>& out_taps, std::vector<float>& out_weights)
+{
+	float sourcePerDestination = (float) sourceSize / (float) destinationSize;
+	float filterScale = MaxFloat(sourcePerDestination, 1.f);
+	float radius = (filter == IMAGE_FILTER_BOX ? 0.5f : IMAGE_KAISER_RADIUS) * filterScale;
+
+	out_taps.resize(destinationSize);
+
+	for (int destinationIndex = 0; destinationIndex < destinationSize; ++destinationIndex)
+	{
+		float center = ((float) destinationIndex + 0.5f) * sourcePerDestination;
+		int first = (int) floorf(center - radius);
+		int last = (int) ceilf(center + radius);
+
+		ImageFilterTaps_t& taps = out_taps[destinationIndex];
+		taps.firstSourceIndex = first;
+		taps.weightStart = (int) out_weights.size();
+
+		float weightSum = 0.f;
+		for (int sourceIndex = first; sourceIndex <= last; ++sourceIndex)
+		{
+			float weight = EvaluateImageFilter(filter, ((float) sourceIndex + 0.5f - center) / filterScale);
+
+			out_weights.push_back(weight);
+			weightSum += weight;
+		}
+
+		taps.weightCount = (int) out_weights.size() - taps.weightStart;
+
+		if (weightSum != 0.f)
+		{
+			for (int weightIndex = taps.weightStart; weightIndex < taps.weightStart + taps.weightCount; ++weightIndex)
+			{
+				out_weights[weightIndex] /= weightSum;
+			}
+		}
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Averages 2x2 blocks of the source into the destination rows, the source dimensions must be even
+//
+static void HalveImageRows(const unsigned char* source, const IntVector2& sourceDimensions, unsigned char* destination, int numComponents, int destinationRowBegin, int destinationRowEnd)
+{
+	int sourceRowBytes = sourceDimensions.x * numComponents;
+	int destinationWidth = sourceDimensions.x / 2;
+
+	for (int rowIndex = destinationRowBegin; rowIndex < destinationRowEnd; ++rowIndex)
+	{
+		const unsigned char* topRow = source + (size_t) (rowIndex * 2) * sourceRowBytes;
+		const unsigned char* bottomRow = topRow + sourceRowBytes;
+		unsigned char* destinationRow = destination + (size_t) rowIndex * destinationWidth * numComponents;
+
+		for (int x = 0; x < destinationWidth; ++x)
+		{
+			for (int componentIndex = 0; componentIndex < numComponents; ++componentIndex)
+			{
+				int left = (x * 2) * numComponents + componentIndex;
+				int right = left + numComponents;
+
+				unsigned int sum = topRow[left] + topRow[right] + bottomRow[left] + bottomRow[right] + 2u;
+				destinationRow[x * numComponents + componentIndex] = (unsigned char) (sum >> 2);
+			}
+		}
+	}
 }
@@ -12,7 +12,14 @@
 #include "Engine/Math/IntVector2.hpp"
 #include "Engine/Core/Image.hpp"
 #include "Engine/Core/EngineCommon.hpp"
-TODO("Make flip Y fast (profile)");
+
+// Filters for resizing and making mips
+enum ImageFilter
+{
+	IMAGE_FILTER_BOX,		// Average of the texels covered, cheapest
+	IMAGE_FILTER_KAISER,	// Kaiser windowed sinc, sharper for minification at a few more taps per texel
+	NUM_IMAGE_FILTERS
+};
 
 class Image
 {
@@ -35,9 +42,21 @@ public:
 	int						GetNumComponentsPerTexel() const;
 	const unsigned char*	GetImageData() const;
 	bool					IsFlippedForTextures() const;
+	size_t					GetByteCount() const;
 
 	void SetTexel( int x, int y, const Rgba& color );
+
+	// These split the image's rows across the JobSystem when it's big enough to be worth it
 	void FlipVertical();
+	void ConvertToRGBA();			// Expands 1-3 component images to 4, with opaque alpha
+	void ConvertToGrayscale();		// Collapses to 1 component (luminance), dropping alpha
+
+	// Returned images belong to the caller, and keep the texel order (flipped or not) of this one
+	Image*	CreateResized(const IntVector2& dimensions, ImageFilter filter = IMAGE_FILTER_KAISER) const;
+	void	CreateMipChain(std::vector<Image*>& out_mipLevels, ImageFilter filter = IMAGE_FILTER_BOX) const;	// Level 1 down to 1x1, not including this one
+
+	// Frees the texel data, leaving an empty image that can be loaded again
+	void Unload();
 
 
 public:
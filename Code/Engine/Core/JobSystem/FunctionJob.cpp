@@ -0,0 +1,204 @@
+/************************************************************************/
+/* File: FunctionJob.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the FunctionJob class and its pool
+/************************************************************************/
+#include <atomic>
+#include "Engine/Core/JobSystem/FunctionJob.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+
+struct FunctionJobPool_t;
+
+// Every block starts with this, in front of the FunctionJob, so it can go back to the pool it came from
+// 16 bytes, so the job behind it keeps the heap's alignment
+struct FunctionJobBlockHeader_t
+{
+	FunctionJobPool_t*			pool = nullptr;
+	FunctionJobBlockHeader_t*	next = nullptr;		// While free
+};
+
+static_assert(sizeof(FunctionJobBlockHeader_t) % 16 == 0, "FunctionJobBlockHeader_t must keep the FunctionJob 16 byte aligned");
+
+// Each thread allocates from its own pool, and blocks always go back to the pool they came from - jobs are
+// usually queued on one thread and deleted on the worker that finalized them, so this is what keeps the
+// queueing thread's pool stocked
+// The owner frees its own blocks onto freeList directly; other threads push them onto returnList, which
+// the owner takes whole when freeList runs out (exchanging the whole list, so there's no ABA)
+// The pool is also kept alive by every block it has handed out, so blocks freed after the owning thread
+// exits still have somewhere to go; whoever drops the last reference frees the pool
+struct FunctionJobPool_t
+{
+	FunctionJobBlockHeader_t*				freeList = nullptr;		// Owning thread only
+	int										numFree = 0;
+	std::atomic<FunctionJobBlockHeader_t*>	returnList;
+	std::atomic<int>						refCount;				// The owning thread, plus each block handed out
+
+	FunctionJobPool_t()
+		: returnList(nullptr)
+		, refCount(1)
+	{
+	}
+};
+
+static void		FreeBlockList(FunctionJobBlockHeader_t* block);
+static void		ReleasePool(FunctionJobPool_t* pool);
+
+// Owns the calling thread's pool, giving up the thread's reference when the thread exits
+struct FunctionJobThreadPool_t
+{
+	FunctionJobPool_t* pool = new FunctionJobPool_t();
+
+	~FunctionJobThreadPool_t()
+	{
+		FreeBlockList(pool->freeList);
+		pool->freeList = nullptr;
+		pool->numFree = 0;
+
+		ReleasePool(pool);
+		pool = nullptr;
+	}
+};
+
+static thread_local FunctionJobThreadPool_t s_functionJobPool;
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor - destroys the stored callable
+//
+FunctionJob::~FunctionJob()
+{
+	if (m_destroyFunction != nullptr)
+	{
+		m_destroyFunction(m_storage);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Runs the stored callable
+//
+void FunctionJob::Execute()
+{
+	m_invokeFunction(m_storage);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns memory for a FunctionJob from the calling thread's pool, taking back the blocks other threads
+// have returned to it first, and only going to the heap when there are none
+//
+void* FunctionJob::operator new(size_t size)
+{
+	ASSERT_OR_DIE(size == sizeof(FunctionJob), "FunctionJob allocated with the wrong size");
+
+	FunctionJobPool_t* pool = s_functionJobPool.pool;
+
+	if (pool->freeList == nullptr)
+	{
+		FunctionJobBlockHeader_t* returned = pool->returnList.exchange(nullptr, std::memory_order_acquire);
+
+		while (returned != nullptr)
+		{
+			FunctionJobBlockHeader_t* next = returned->next;
+
+			if (pool->numFree < FUNCTION_JOB_MAX_CACHED_PER_THREAD)
+			{
+				returned->next = pool->freeList;
+				pool->freeList = returned;
+				pool->numFree++;
+			}
+			else
+			{
+				::operator delete(returned);
+			}
+
+			returned = next;
+		}
+	}
+
+	FunctionJobBlockHeader_t* block = pool->freeList;
+
+	if (block != nullptr)
+	{
+		pool->freeList = block->next;
+		pool->numFree--;
+	}
+	else
+	{
+		block = new (::operator new(sizeof(FunctionJobBlockHeader_t) + sizeof(FunctionJob))) FunctionJobBlockHeader_t();
+		block->pool = pool;
+	}
+
+	pool->refCount.fetch_add(1, std::memory_order_relaxed);
+	return (block + 1);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the memory to the pool it came from - straight onto its free list when that's the calling
+// thread's pool (or to the heap if the pool is full), onto its return list otherwise
+//
+void FunctionJob::operator delete(void* memory)
+{
+	if (memory == nullptr)
+	{
+		return;
+	}
+
+	FunctionJobBlockHeader_t* block = reinterpret_cast<FunctionJobBlockHeader_t*>(memory) - 1;
+	FunctionJobPool_t* pool = block->pool;
+
+	if (pool == s_functionJobPool.pool)
+	{
+		if (pool->numFree >= FUNCTION_JOB_MAX_CACHED_PER_THREAD)
+		{
+			::operator delete(block);
+		}
+		else
+		{
+			block->next = pool->freeList;
+			pool->freeList = block;
+			pool->numFree++;
+		}
+	}
+	else
+	{
+		FunctionJobBlockHeader_t* head = pool->returnList.load(std::memory_order_relaxed);
+
+		do
+		{
+			block->next = head;
+		} while (!pool->returnList.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	ReleasePool(pool);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Frees every block of the list back to the heap
+//
+static void FreeBlockList(FunctionJobBlockHeader_t* block)
+{
+	while (block != nullptr)
+	{
+		FunctionJobBlockHeader_t* next = block->next;
+		::operator delete(block);
+		block = next;
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Drops a reference to the pool, freeing it and the blocks returned to it if that was the last one
+// The last reference can only be dropped after the owning thread has exited, so nothing else touches it
+//
+static void ReleasePool(FunctionJobPool_t* pool)
+{
+	if (pool->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		FreeBlockList(pool->returnList.exchange(nullptr, std::memory_order_acquire));
+		delete pool;
+	}
+}
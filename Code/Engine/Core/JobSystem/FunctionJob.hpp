@@ -0,0 +1,114 @@
+/************************************************************************/
+/* File: FunctionJob.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Job that runs a lambda/callable stored inline in the job,
+/*				allocated from a per-thread pool so queueing small tasks
+/*				doesn't touch the heap
+/************************************************************************/
+#pragma once
+#include <new>
+#include <utility>
+#include <type_traits>
+#include "Engine/Core/JobSystem/Job.hpp"
+#include "Engine/Core/JobSystem/JobSystem.hpp"
+
+// Max size of a callable (i.e. a lambda's captures) that can be stored in a FunctionJob
+#define FUNCTION_JOB_STORAGE_SIZE (64)
+
+// Max number of free FunctionJobs each thread keeps around for reuse
+#define FUNCTION_JOB_MAX_CACHED_PER_THREAD (4096)
+
+
+class FunctionJob final : public Job
+{
+public:
+	//-----Public Methods-----
+
+	template <typename FUNCTION>
+	FunctionJob(FUNCTION&& function, JobPriority priority = JOB_PRIORITY_NORMAL, uint32_t jobFlags = WORKER_FLAGS_ALL_BUT_DISK);
+	virtual ~FunctionJob();
+
+	virtual void Execute() override;
+
+	// Pooled allocation - memory comes from the calling thread's pool, and goes back to the pool it came from
+	// whichever thread frees it
+	static void* operator new(size_t size);
+	static void operator delete(void* memory);
+
+
+private:
+	//-----Private Methods-----
+
+	template <typename FUNCTION>
+	static void InvokeStoredFunction(void* storage);
+
+	template <typename FUNCTION>
+	static void DestroyStoredFunction(void* storage);
+
+
+private:
+	//-----Private Data-----
+
+	typedef void(*StoredFunction_cb)(void* storage);
+
+	alignas(16) unsigned char	m_storage[FUNCTION_JOB_STORAGE_SIZE];
+	StoredFunction_cb			m_invokeFunction = nullptr;
+	StoredFunction_cb			m_destroyFunction = nullptr;
+
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - copies/moves the callable into the job's inline storage
+// By default the job finalizes on the worker, since there's nothing left to do on the main thread
+//
+template <typename FUNCTION>
+FunctionJob::FunctionJob(FUNCTION&& function, JobPriority priority /*= JOB_PRIORITY_NORMAL*/, uint32_t jobFlags /*= WORKER_FLAGS_ALL_BUT_DISK*/)
+{
+	typedef typename std::decay<FUNCTION>::type StoredType;
+
+	static_assert(sizeof(StoredType) <= FUNCTION_JOB_STORAGE_SIZE, "FunctionJob callable is too large, capture less or use a Job subclass");
+	static_assert(alignof(StoredType) <= 16, "FunctionJob callable is over aligned");
+
+	new (m_storage) StoredType(std::forward<FUNCTION>(function));
+
+	m_invokeFunction = &InvokeStoredFunction<StoredType>;
+	m_destroyFunction = &DestroyStoredFunction<StoredType>;
+
+	m_priority = priority;
+	m_jobFlags = jobFlags;
+	m_finalizeOnWorker = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Calls the stored callable
+//
+template <typename FUNCTION>
+void FunctionJob::InvokeStoredFunction(void* storage)
+{
+	(*reinterpret_cast<FUNCTION*>(storage))();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructs the stored callable
+//
+template <typename FUNCTION>
+void FunctionJob::DestroyStoredFunction(void* storage)
+{
+	reinterpret_cast<FUNCTION*>(storage)->~FUNCTION();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues the callable to run on a worker thread without any heap allocation (once the calling
+// thread's pool is warm)
+// Returns the ID of the job
+//
+template <typename FUNCTION>
+int QueueFunctionJob(FUNCTION&& function, JobPriority priority = JOB_PRIORITY_NORMAL)
+{
+	return QueueJob(new FunctionJob(std::forward<FUNCTION>(function), priority));
+}
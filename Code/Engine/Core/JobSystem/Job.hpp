@@ -6,12 +6,26 @@
 /*				the JobSystem; Abstract class, must be derived from
 /************************************************************************/
 #pragma once
+#include <atomic>
+#include <vector>
 #include <stdint.h>
 
+// Workers always drain higher priorities first
+enum JobPriority
+{
+	JOB_PRIORITY_CRITICAL,		// Must finish this frame (animation poses, culling, etc)
+	JOB_PRIORITY_NORMAL,
+	JOB_PRIORITY_BACKGROUND,	// Asset decoding, streaming; never allowed to occupy every worker
+	NUM_JOB_PRIORITIES
+};
+
+struct JobFiber_t;
+
 
 class Job
 {
 	friend class JobSystem;
+	friend class JobWorkerThread;
 
 public:
 	//-----Public Methods-----
@@ -22,7 +36,14 @@ public:
 	virtual void		Execute() = 0; // No parameters, since this is meant to be derived from, so parameters exist on the derived class
 	virtual void		Finalize() {}
 	inline int			GetID() const { return m_jobID; }
+	inline int			GetJobType() const { return m_jobType; }
 	inline uint32_t		GetJobFlags() const { return m_jobFlags; }
+	inline JobPriority	GetPriority() const { return m_priority; }
+	inline void			SetPriority(JobPriority priority) { m_priority = priority; } // Only before the job is queued
+
+	// Rough main thread seconds Finalize() takes, for the budgeted finalizes; 0 if unknown, so only the time measured counts
+	inline float		GetFinalizeCostEstimate() const { return m_finalizeCostSeconds; }
+	inline void			SetFinalizeCostEstimate(float seconds) { m_finalizeCostSeconds = seconds; } // Until the job is finalized
 
 
 protected:
@@ -31,5 +52,30 @@ protected:
 	int			m_jobID = -1;
 	int			m_jobType = -1;
 	uint32_t	m_jobFlags = 0xffffffff;
+	JobPriority	m_priority = JOB_PRIORITY_NORMAL;
+	float		m_finalizeCostSeconds = 0.f;
+	bool		m_finalizeOnWorker = false; // If true, Finalize() is called on the worker and the job is deleted right away instead of waiting in the finished list
+
+
+private:
+	//-----Private Data-----
+
+	// Dependency tracking, managed by the JobSystem
+	// A job is only pushed to the workers once all its predecessors have finished executing
+	// The continuation list is guarded by the job's slot in the JobSlotTable
+	std::atomic<int>	m_numPendingDependencies{ 0 };
+	std::vector<Job*>	m_continuations;	// Jobs waiting on this one
+
+	// Intrusive links for the finished list, so finishing and finalizing never allocate
+	Job*				m_nextFinished = nullptr;
+	Job*				m_prevFinished = nullptr;
+
+	// Set while the job is suspended inside Execute(), so whoever picks it up next resumes the fiber
+	JobFiber_t*			m_fiber = nullptr;
+
+	// For the JobStats, as performance counts
+	uint64_t			m_readyHPC = 0;		// Its last dependency finished, or it was queued without any
+	uint64_t			m_startHPC = 0;		// First picked up by a worker, resuming from a suspend doesn't count
+	uint64_t			m_finishedHPC = 0;
 
 };
@@ -0,0 +1,321 @@
+/************************************************************************/
+/* File: JobSlotTable.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the JobSlotTable class
+/************************************************************************/
+#include "Engine/Core/JobSystem/Job.hpp"
+#include "Engine/Core/JobSystem/JobSlotTable.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+#include <thread>
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+JobSlotTable::JobSlotTable()
+{
+	for (int blockIndex = 0; blockIndex < JOB_SLOT_MAX_BLOCKS; ++blockIndex)
+	{
+		m_blocks[blockIndex] = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor - does not delete any jobs still referenced, the JobSystem handles that
+//
+JobSlotTable::~JobSlotTable()
+{
+	for (int blockIndex = 0; blockIndex < JOB_SLOT_MAX_BLOCKS; ++blockIndex)
+	{
+		delete[] m_blocks[blockIndex].load();
+		m_blocks[blockIndex] = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Gives the job a slot and returns the ID that now refers to it
+//
+int JobSlotTable::AllocateSlot(Job* job, JobStatus initialStatus)
+{
+	uint32_t slotIndex;
+
+	if (!PopFreeIndex(slotIndex))
+	{
+		int newIndex = m_numSlotsCreated.fetch_add(1);
+		ASSERT_OR_DIE(newIndex < (1 << JOB_SLOT_INDEX_BITS), "JobSlotTable ran out of slots - too many jobs alive at once");
+
+		slotIndex = (uint32_t)newIndex;
+	}
+
+	JobSlot_t* slot = GetOrCreateSlotAtIndex(slotIndex);
+
+	// Generation keeps IDs unique across reuse of the slot, and the ID positive
+	slot->generation = (slot->generation + 1) & 0x7FFF;
+	int jobID = (int)((slot->generation << JOB_SLOT_INDEX_BITS) | slotIndex);
+
+	slot->job = job;
+	slot->jobType = job->GetJobType();
+	slot->status = initialStatus;
+	slot->jobID = jobID; // Publish last
+
+	return jobID;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the slot for the given job ID to the free list
+//
+void JobSlotTable::FreeSlot(int jobID)
+{
+	JobSlot_t* slot = GetSlot(jobID);
+
+	if (slot == nullptr || slot->jobID != jobID)
+	{
+		return;
+	}
+
+	slot->jobID = -1;
+	slot->status = JOB_STATUS_NOT_FOUND;
+	slot->job = nullptr;
+	slot->jobType = -1;
+	slot->isInFinalizeList = false;
+
+	PushFreeIndex((uint32_t)(jobID & JOB_SLOT_INDEX_MASK));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the slot the given ID maps to, or nullptr if the block was never created
+// The slot may belong to a different job if the given one has already been finalized
+//
+JobSlot_t* JobSlotTable::GetSlot(int jobID) const
+{
+	if (jobID < 0)
+	{
+		return nullptr;
+	}
+
+	return GetSlotAtIndex(jobID & JOB_SLOT_INDEX_MASK);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the slot at the given index, or nullptr if it hasn't been created
+//
+JobSlot_t* JobSlotTable::GetSlotAtIndex(int slotIndex) const
+{
+	JobSlot_t* block = m_blocks[slotIndex / JOB_SLOT_BLOCK_SIZE].load();
+
+	if (block == nullptr)
+	{
+		return nullptr;
+	}
+
+	return &block[slotIndex % JOB_SLOT_BLOCK_SIZE];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the status of the job, or NOT_FOUND if the ID is stale (already finalized)
+//
+JobStatus JobSlotTable::GetStatus(int jobID) const
+{
+	JobSlot_t* slot = GetSlot(jobID);
+
+	if (slot == nullptr || slot->jobID != jobID)
+	{
+		return JOB_STATUS_NOT_FOUND;
+	}
+
+	JobStatus status = (JobStatus)slot->status.load();
+
+	// Slot could have been freed and reused between the two reads
+	if (slot->jobID != jobID)
+	{
+		return JOB_STATUS_NOT_FOUND;
+	}
+
+	return status;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the status of the job, does nothing if the ID is stale
+// Only the thread currently responsible for the job should call this
+//
+void JobSlotTable::SetStatus(int jobID, JobStatus status)
+{
+	JobSlot_t* slot = GetSlot(jobID);
+
+	if (slot != nullptr && slot->jobID == jobID)
+	{
+		slot->status = status;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the job for the ID, or nullptr if the ID is stale
+// Only safe to dereference if the caller knows the job can't be finalized out from under it
+//
+Job* JobSlotTable::GetJob(int jobID) const
+{
+	JobSlot_t* slot = GetSlot(jobID);
+
+	if (slot == nullptr || slot->jobID != jobID)
+	{
+		return nullptr;
+	}
+
+	return slot->job;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if any live job of the given type is waiting, queued or running
+//
+bool JobSlotTable::IsJobOfTypeUnfinished(int jobType) const
+{
+	int numSlots = m_numSlotsCreated.load();
+
+	for (int slotIndex = 0; slotIndex < numSlots; ++slotIndex)
+	{
+		JobSlot_t* slot = GetSlotAtIndex(slotIndex);
+
+		if (slot == nullptr || slot->jobID < 0 || slot->jobType != jobType)
+		{
+			continue;
+		}
+
+		int status = slot->status.load();
+		if (status != JOB_STATUS_FINISHED && status != JOB_STATUS_NOT_FOUND)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if any job of the given type hasn't been finalized yet
+//
+bool JobSlotTable::IsJobOfTypeAlive(int jobType) const
+{
+	int numSlots = m_numSlotsCreated.load();
+
+	for (int slotIndex = 0; slotIndex < numSlots; ++slotIndex)
+	{
+		JobSlot_t* slot = GetSlotAtIndex(slotIndex);
+
+		if (slot != nullptr && slot->jobID >= 0 && slot->jobType == jobType)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Spins until the slot's continuation lock is acquired; held very briefly, so a spin is fine
+//
+void JobSlotTable::LockContinuations(JobSlot_t* slot)
+{
+	while (slot->continuationLock.test_and_set(std::memory_order_acquire))
+	{
+		std::this_thread::yield();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Releases the slot's continuation lock
+//
+void JobSlotTable::UnlockContinuations(JobSlot_t* slot)
+{
+	slot->continuationLock.clear(std::memory_order_release);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the slot at the index, creating its block if this is the first slot used in it
+//
+JobSlot_t* JobSlotTable::GetOrCreateSlotAtIndex(uint32_t slotIndex)
+{
+	uint32_t blockIndex = slotIndex / JOB_SLOT_BLOCK_SIZE;
+	JobSlot_t* block = m_blocks[blockIndex].load();
+
+	if (block == nullptr)
+	{
+		// Could race with another thread allocating in the same block, loser deletes theirs
+		JobSlot_t* newBlock = new JobSlot_t[JOB_SLOT_BLOCK_SIZE];
+		JobSlot_t* expected = nullptr;
+
+		if (m_blocks[blockIndex].compare_exchange_strong(expected, newBlock))
+		{
+			block = newBlock;
+		}
+		else
+		{
+			delete[] newBlock;
+			block = expected;
+		}
+	}
+
+	return &block[slotIndex % JOB_SLOT_BLOCK_SIZE];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Pushes the slot index onto the free list
+//
+void JobSlotTable::PushFreeIndex(uint32_t slotIndex)
+{
+	JobSlot_t* slot = GetSlotAtIndex((int)slotIndex);
+	uint64_t oldHead = m_freeListHead.load();
+	uint64_t newHead;
+
+	do 
+	{
+		slot->nextFreeIndex = (uint32_t)(oldHead & 0xFFFFFFFF);
+
+		uint64_t tag = (oldHead >> 32) + 1;
+		newHead = (tag << 32) | (uint64_t)(slotIndex + 1);
+
+	} while (!m_freeListHead.compare_exchange_weak(oldHead, newHead));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Pops a slot index off the free list, returning false if it's empty
+//
+bool JobSlotTable::PopFreeIndex(uint32_t& out_slotIndex)
+{
+	uint64_t oldHead = m_freeListHead.load();
+	uint64_t newHead;
+
+	do 
+	{
+		uint32_t headIndexPlusOne = (uint32_t)(oldHead & 0xFFFFFFFF);
+
+		if (headIndexPlusOne == 0)
+		{
+			return false;
+		}
+
+		out_slotIndex = headIndexPlusOne - 1;
+		uint32_t nextIndexPlusOne = GetSlotAtIndex((int)out_slotIndex)->nextFreeIndex.load();
+
+		uint64_t tag = (oldHead >> 32) + 1;
+		newHead = (tag << 32) | (uint64_t)nextIndexPlusOne;
+
+	} while (!m_freeListHead.compare_exchange_weak(oldHead, newHead));
+
+	return true;
+}
@@ -0,0 +1,87 @@
+/************************************************************************/
+/* File: JobSlotTable.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Lock-free table of job handles; every live job owns a slot,
+/*				and its job ID encodes the slot index plus a generation so
+/*				status lookups are O(1) and stale IDs are detected
+/************************************************************************/
+#pragma once
+#include <atomic>
+#include <stdint.h>
+
+#define JOB_SLOT_INDEX_BITS		(16)
+#define JOB_SLOT_INDEX_MASK		((1 << JOB_SLOT_INDEX_BITS) - 1)
+#define JOB_SLOT_BLOCK_SIZE		(1024)
+#define JOB_SLOT_MAX_BLOCKS		((1 << JOB_SLOT_INDEX_BITS) / JOB_SLOT_BLOCK_SIZE)
+
+class Job;
+
+enum JobStatus
+{
+	JOB_STATUS_WAITING_ON_DEPENDENCIES,
+	JOB_STATUS_QUEUED,
+	JOB_STATUS_RUNNING,
+	JOB_STATUS_FINISHED,
+	JOB_STATUS_NOT_FOUND
+};
+
+struct JobSlot_t
+{
+	std::atomic<int>		jobID{ -1 };				// -1 when the slot is free
+	std::atomic<int>		status{ JOB_STATUS_NOT_FOUND };
+	Job*					job = nullptr;
+	int						jobType = -1;				// Copied so type queries never touch the job itself
+	uint32_t				generation = 0;				// Only touched by the thread that owns the slot
+	std::atomic<uint32_t>	nextFreeIndex{ 0 };
+	bool					isInFinalizeList = false;	// Guarded by the JobSystem's finalize lock
+
+	// Guards the job's continuation list, and the transition to finished
+	// Lives in the slot rather than the job, since slots are never freed
+	std::atomic_flag		continuationLock = ATOMIC_FLAG_INIT;
+};
+
+
+class JobSlotTable
+{
+public:
+	//-----Public Methods-----
+
+	JobSlotTable();
+	~JobSlotTable();
+
+	int			AllocateSlot(Job* job, JobStatus initialStatus); // Returns the job ID
+	void		FreeSlot(int jobID);
+
+	JobSlot_t*	GetSlot(int jobID) const; // Returns the slot the ID maps to, which may since have been reused
+	JobStatus	GetStatus(int jobID) const;
+	void		SetStatus(int jobID, JobStatus status);
+	Job*		GetJob(int jobID) const;
+
+	bool		IsJobOfTypeUnfinished(int jobType) const;
+	bool		IsJobOfTypeAlive(int jobType) const;
+	int			GetHighWaterMark() const { return m_numSlotsCreated.load(); }
+	JobSlot_t*	GetSlotAtIndex(int slotIndex) const;
+
+	static void	LockContinuations(JobSlot_t* slot);
+	static void	UnlockContinuations(JobSlot_t* slot);
+
+
+private:
+	//-----Private Methods-----
+
+	JobSlot_t*	GetOrCreateSlotAtIndex(uint32_t slotIndex);
+	void		PushFreeIndex(uint32_t slotIndex);
+	bool		PopFreeIndex(uint32_t& out_slotIndex);
+
+
+private:
+	//-----Private Data-----
+
+	std::atomic<JobSlot_t*>		m_blocks[JOB_SLOT_MAX_BLOCKS];
+	std::atomic<int>			m_numSlotsCreated{ 0 };
+
+	// Treiber stack of free slot indices; high 32 bits are an ABA tag, low 32 are index + 1 (0 is empty)
+	std::atomic<uint64_t>		m_freeListHead{ 0 };
+
+};
@@ -0,0 +1,245 @@
+/************************************************************************/
+/* File: JobStats.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the JobStats class
+/************************************************************************/
+#include "Engine/Core/Time/Time.hpp"
+#include "Engine/Core/Time/ProfileHistogram.hpp"
+#include "Engine/Core/JobSystem/JobStats.hpp"
+#include "Engine/Core/Utility/StringUtils.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+JobStats::JobStats()
+{
+	for (int typeIndex = 0; typeIndex < JOB_STATS_MAX_JOB_TYPES; ++typeIndex)
+	{
+		m_types[typeIndex] = nullptr;
+	}
+
+	m_otherTypes.name = "Other";
+	CreateHistograms(&m_otherTypes);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+JobStats::~JobStats()
+{
+	int typeCount = m_typeCount;
+	for (int typeIndex = 0; typeIndex < typeCount; ++typeIndex)
+	{
+		DestroyHistograms(m_types[typeIndex]);
+		delete m_types[typeIndex];
+		m_types[typeIndex] = nullptr;
+	}
+
+	DestroyHistograms(&m_otherTypes);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds how long the job waited for a worker and how long it ran to its type's histograms
+//
+void JobStats::RecordExecution(int jobType, uint64_t waitHPC, uint64_t runHPC)
+{
+	float waitMilliseconds = (float) (TimeSystem::PerformanceCountToSeconds(waitHPC) * 1000.0);
+	float runMilliseconds = (float) (TimeSystem::PerformanceCountToSeconds(runHPC) * 1000.0);
+
+	JobTypeStats_t* typeStats = GetOrCreateTypeStats(jobType);
+
+	typeStats->lock.lock();
+	{
+		typeStats->waitHistogram->AddSample(waitMilliseconds);
+		typeStats->runHistogram->AddSample(runMilliseconds);
+		typeStats->jobCount++;
+	}
+	typeStats->lock.unlock();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds how long the job sat finished before it was finalized to its type's histogram
+//
+void JobStats::RecordFinalize(int jobType, uint64_t latencyHPC)
+{
+	float latencyMilliseconds = (float) (TimeSystem::PerformanceCountToSeconds(latencyHPC) * 1000.0);
+
+	JobTypeStats_t* typeStats = GetOrCreateTypeStats(jobType);
+
+	typeStats->lock.lock();
+	{
+		typeStats->finalizeHistogram->AddSample(latencyMilliseconds);
+	}
+	typeStats->lock.unlock();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Clears every type's histograms, the types themselves are kept
+//
+void JobStats::Reset()
+{
+	int typeCount = m_typeCount.load(std::memory_order_acquire);
+
+	for (int typeIndex = 0; typeIndex <= typeCount; ++typeIndex)
+	{
+		JobTypeStats_t* typeStats = (typeIndex < typeCount ? m_types[typeIndex] : &m_otherTypes);
+
+		typeStats->lock.lock();
+		{
+			typeStats->waitHistogram->Clear();
+			typeStats->runHistogram->Clear();
+			typeStats->finalizeHistogram->Clear();
+			typeStats->jobCount = 0;
+		}
+		typeStats->lock.unlock();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Appends three lines for each type that's had a job since the last reset - wait, run and finalize
+//
+void JobStats::GetSummaryText(std::vector<std::string>& out_lines)
+{
+	int typeCount = m_typeCount.load(std::memory_order_acquire);
+
+	for (int typeIndex = 0; typeIndex <= typeCount; ++typeIndex)
+	{
+		JobTypeStats_t* typeStats = (typeIndex < typeCount ? m_types[typeIndex] : &m_otherTypes);
+
+		typeStats->lock.lock();
+		{
+			if (typeStats->jobCount > 0)
+			{
+				out_lines.push_back(typeStats->waitHistogram->GetSummaryText());
+				out_lines.push_back(typeStats->runHistogram->GetSummaryText());
+				out_lines.push_back(typeStats->finalizeHistogram->GetSummaryText());
+			}
+		}
+		typeStats->lock.unlock();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of job types with their own stats, not counting "Other"
+//
+int JobStats::GetJobTypeCount() const
+{
+	return m_typeCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the name the type is shown with - its characters if all four bytes are printable,
+// otherwise the number
+//
+std::string JobStats::GetJobTypeName(int jobType)
+{
+	if (jobType == -1)
+	{
+		return "Untyped";
+	}
+
+	char characters[5];
+	bool isPrintable = true;
+
+	for (int byteIndex = 0; byteIndex < 4; ++byteIndex)
+	{
+		characters[byteIndex] = (char) ((jobType >> (8 * (3 - byteIndex))) & 0xFF);
+		isPrintable = isPrintable && (characters[byteIndex] >= ' ' && characters[byteIndex] <= '~');
+	}
+
+	characters[4] = '\0';
+
+	if (isPrintable)
+	{
+		return std::string(characters);
+	}
+
+	return Stringf("%i", jobType);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the stats for the type, adding them if this is the type's first job
+// Once there's no room for more types, new ones are all kept together as "Other"
+//
+JobTypeStats_t* JobStats::GetOrCreateTypeStats(int jobType)
+{
+	int typeCount = m_typeCount.load(std::memory_order_acquire);
+	for (int typeIndex = 0; typeIndex < typeCount; ++typeIndex)
+	{
+		if (m_types[typeIndex]->jobType == jobType)
+		{
+			return m_types[typeIndex];
+		}
+	}
+
+	JobTypeStats_t* typeStats = &m_otherTypes;
+
+	m_registrationLock.lock();
+	{
+		// Could have been added while we waited on the lock
+		int lockedTypeCount = m_typeCount.load(std::memory_order_relaxed);
+		bool wasFound = false;
+
+		for (int typeIndex = typeCount; typeIndex < lockedTypeCount; ++typeIndex)
+		{
+			if (m_types[typeIndex]->jobType == jobType)
+			{
+				typeStats = m_types[typeIndex];
+				wasFound = true;
+				break;
+			}
+		}
+
+		if (!wasFound && lockedTypeCount < JOB_STATS_MAX_JOB_TYPES)
+		{
+			typeStats = new JobTypeStats_t();
+			typeStats->jobType = jobType;
+			typeStats->name = GetJobTypeName(jobType);
+			CreateHistograms(typeStats);
+
+			// Published only once it's complete
+			m_types[lockedTypeCount] = typeStats;
+			m_typeCount.store(lockedTypeCount + 1, std::memory_order_release);
+		}
+	}
+	m_registrationLock.unlock();
+
+	return typeStats;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Makes the type's three histograms, named by the type
+//
+void JobStats::CreateHistograms(JobTypeStats_t* typeStats)
+{
+	typeStats->waitHistogram		= new ProfileHistogram(Stringf("Job %s wait", typeStats->name.c_str()), JOB_STATS_WINDOW_SIZE, JOB_STATS_SLOW_MS);
+	typeStats->runHistogram			= new ProfileHistogram(Stringf("Job %s run", typeStats->name.c_str()), JOB_STATS_WINDOW_SIZE, JOB_STATS_SLOW_MS);
+	typeStats->finalizeHistogram	= new ProfileHistogram(Stringf("Job %s finalize", typeStats->name.c_str()), JOB_STATS_WINDOW_SIZE, JOB_STATS_SLOW_MS);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes the type's histograms
+//
+void JobStats::DestroyHistograms(JobTypeStats_t* typeStats)
+{
+	delete typeStats->waitHistogram;
+	typeStats->waitHistogram = nullptr;
+
+	delete typeStats->runHistogram;
+	typeStats->runHistogram = nullptr;
+
+	delete typeStats->finalizeHistogram;
+	typeStats->finalizeHistogram = nullptr;
+}
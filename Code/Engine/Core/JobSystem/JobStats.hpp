@@ -0,0 +1,86 @@
+/************************************************************************/
+/* File: JobStats.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Percentiles of how long jobs of each type wait, run and
+/*				wait to be finalized, for sizing the worker threads
+/************************************************************************/
+#pragma once
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+class ProfileHistogram;
+
+#define JOB_STATS_MAX_JOB_TYPES (32)		// Types past this are all kept together as "Other"
+#define JOB_STATS_WINDOW_SIZE (4096)		// Jobs each histogram keeps
+#define JOB_STATS_SLOW_MS (16.6f)			// Any one time over a frame at 60hz counts as a hitch
+
+// All jobs with one m_jobType
+struct JobTypeStats_t
+{
+	int					jobType = -1;
+	std::string			name;
+	std::mutex			lock;
+
+	ProfileHistogram*	waitHistogram = nullptr;		// From having no dependencies left to starting on a worker
+	ProfileHistogram*	runHistogram = nullptr;			// Execute(), including any time it was suspended
+	ProfileHistogram*	finalizeHistogram = nullptr;	// From finishing to being finalized
+	uint64_t			jobCount = 0;
+};
+
+// Time a worker spent running jobs or waiting on them, since the stats were last reset
+struct JobWorkerStats_t
+{
+	std::string			name;
+	uint32_t			flags = 0;
+	double				busySeconds = 0.0;
+	double				idleSeconds = 0.0;
+	uint64_t			jobsRun = 0;
+};
+
+class JobStats
+{
+public:
+	//-----Public Methods-----
+
+	JobStats();
+	~JobStats();
+
+	JobStats(const JobStats& copy) = delete;
+	JobStats& operator=(const JobStats& copy) = delete;
+
+	// Any thread, the times are performance counts
+	void				RecordExecution(int jobType, uint64_t waitHPC, uint64_t runHPC);
+	void				RecordFinalize(int jobType, uint64_t latencyHPC);
+
+	void				Reset();
+
+	// The wait, run and finalize summaries of each type, p50/p95/p99/max and hitches
+	void				GetSummaryText(std::vector<std::string>& out_lines);
+	int					GetJobTypeCount() const;
+
+	// Types are usually four characters packed into an int, so those are shown as the characters
+	static std::string	GetJobTypeName(int jobType);
+
+
+private:
+	//-----Private Methods-----
+
+	JobTypeStats_t*		GetOrCreateTypeStats(int jobType);
+	static void			CreateHistograms(JobTypeStats_t* typeStats);
+	static void			DestroyHistograms(JobTypeStats_t* typeStats);
+
+
+private:
+	//-----Private Data-----
+
+	// Types are only ever added, so they're found without the lock
+	JobTypeStats_t*		m_types[JOB_STATS_MAX_JOB_TYPES];
+	std::atomic<int>	m_typeCount{ 0 };
+	std::mutex			m_registrationLock;
+	JobTypeStats_t		m_otherTypes;
+
+};
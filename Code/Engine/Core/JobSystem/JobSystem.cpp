@@ -4,13 +4,24 @@
 /* Date: May the 4th (be with you) 2019
 /* Description: 
 /************************************************************************/
+#include "Engine/Core/Time/Time.hpp"
+#include "Engine/Core/Time/ProfileCounters.hpp"
 #include "Engine/Core/JobSystem/Job.hpp"
 #include "Engine/Core/JobSystem/JobSystem.hpp"
+#include "Engine/Core/JobSystem/JobSlotTable.hpp"
 #include "Engine/Core/JobSystem/JobWorkerThread.hpp"
+#include "Engine/Core/JobSystem/WorkStealingQueue.hpp"
+#include "Engine/Core/DeveloperConsole/Command.hpp"
+#include "Engine/Core/DeveloperConsole/DevConsole.hpp"
+#include "Engine/Core/Utility/StringUtils.hpp"
 #include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+#include <thread>
 
 JobSystem* JobSystem::s_instance = nullptr;
 
+// Console commands
+void Command_JobStats(Command& cmd);
+
 
 //-----------------------------------------------------------------------------------------------
 // Creates the singleton instance, does not create any worker threads
@@ -19,6 +30,17 @@ void JobSystem::Initialize()
 {
 	ASSERT_OR_DIE(s_instance == nullptr, "JobSystem::Initialize() called twice!");
 	s_instance = new JobSystem();
+
+	InitializeConsoleCommands();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets up the JobSystem console commands
+//
+void JobSystem::InitializeConsoleCommands()
+{
+	Command::Register("jobstats", "Prints wait/run/finalize percentiles per job type and each worker's utilization, -r to reset after.", Command_JobStats);
 }
 
 
@@ -45,16 +67,55 @@ JobSystem* JobSystem::GetInstance()
 
 //-----------------------------------------------------------------------------------------------
 // Creates a thread that will begin pulling jobs from the queue, with the given work flags
+// Workers with the same flags share a steal domain
+// The name shows up in the debugger and profiler, affinity pins the thread to the given logical processors
+//
+void JobSystem::CreateWorkerThread(const char* name, WorkerThreadFlags flags, uint64_t affinityMask /*= THREAD_AFFINITY_ANY*/, eThreadPriority priority /*= THREAD_PRIORITY_SETTING_NORMAL*/)
+{
+	m_domainLock.lock();
+	{
+		JobStealDomain_t* domain = GetOrCreateDomainForFlags(flags);
+
+		// Thread will block on the domain lock until we're done adding it
+		JobWorkerThread* workerThread = new JobWorkerThread(name, flags, affinityMask, priority, domain, this);
+		m_workerThreads.push_back(workerThread);
+		domain->workers.push_back(workerThread);
+
+		// Any jobs that were waiting for a capable worker can now be distributed
+		PushUnassignedJobs();
+	}
+	m_domainLock.unlock();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Creates worker threads laid out for this machine's cores: one below normal priority disk thread,
+// and a compute worker pinned to each core not used by the main or render threads
+// Also pins the calling (main) thread to its core from the layout
 //
-void JobSystem::CreateWorkerThread(const char* name, WorkerThreadFlags flags)
+void JobSystem::CreateDefaultWorkerThreads()
 {
-	JobWorkerThread* workerThread = new JobWorkerThread(name, flags, this);
-	m_workerThreads.push_back(workerThread);
+	ThreadLayout_t layout = Thread::GetDefaultLayout();
+
+	if (layout.mainThreadAffinity != THREAD_AFFINITY_ANY)
+	{
+		Thread::SetThisThreadAffinity(layout.mainThreadAffinity);
+	}
+
+	CreateWorkerThread("Disk Worker", WORKER_FLAGS_DISK, layout.diskThreadAffinity, THREAD_PRIORITY_SETTING_BELOW_NORMAL);
+
+	int numWorkers = (int)layout.workerThreadAffinities.size();
+	for (int workerIndex = 0; workerIndex < numWorkers; ++workerIndex)
+	{
+		std::string workerName = Stringf("Compute Worker %i", workerIndex);
+		CreateWorkerThread(workerName.c_str(), WORKER_FLAGS_ALL_BUT_DISK, layout.workerThreadAffinities[workerIndex]);
+	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
 // Tells the thread to finish the job it is currently working on and then destroys it
+// Any jobs still in its local queue are handed off to the rest of its domain
 //
 void JobSystem::DestroyWorkerThread(const char* name)
 {
@@ -66,11 +127,42 @@ void JobSystem::DestroyWorkerThread(const char* name)
 
 		if (workerThread->GetName() == name)
 		{
+			// Only changed on this thread, but the stats walk it from others; not held over the join,
+			// as the worker may need it to finish its job
+			m_domainLock.lock();
 			m_workerThreads.erase(m_workerThreads.begin() + threadIndex);
+			m_domainLock.unlock();
 
 			workerThread->StopRunning();
 			workerThread->Join();
 
+			m_domainLock.lock();
+			{
+				std::vector<JobWorkerThread*>& domainWorkers = workerThread->m_domain->workers;
+
+				for (int domainIndex = 0; domainIndex < (int)domainWorkers.size(); ++domainIndex)
+				{
+					if (domainWorkers[domainIndex] == workerThread)
+					{
+						domainWorkers.erase(domainWorkers.begin() + domainIndex);
+						break;
+					}
+				}
+
+				// Redistribute the jobs it never got to
+				std::deque<Job*> leftOverJobs;
+				workerThread->m_localQueue.MoveAllJobsTo(leftOverJobs);
+
+				for (int jobIndex = 0; jobIndex < (int)leftOverJobs.size(); ++jobIndex)
+				{
+					Job* job = leftOverJobs[jobIndex];
+					workerThread->m_domain->numQueuedJobs[job->m_priority]--;
+
+					PushJobToDomain(job, FindDomainForJob(job));
+				}
+			}
+			m_domainLock.unlock();
+
 			delete workerThread;
 			return;
 		}
@@ -80,6 +172,7 @@ void JobSystem::DestroyWorkerThread(const char* name)
 
 //-----------------------------------------------------------------------------------------------
 // Tells all worker thread to finish the job they're executing, then join
+// Jobs left in the local queues are moved to the unassigned list
 //
 void JobSystem::DestroyAllWorkerThreads()
 {
@@ -97,340 +190,1146 @@ void JobSystem::DestroyAllWorkerThreads()
 		m_workerThreads[threadIndex]->Join();
 	}
 
-	m_workerThreads.clear();
+	m_domainLock.lock();
+	{
+		for (int threadIndex = 0; threadIndex < numThreads; ++threadIndex)
+		{
+			m_workerThreads[threadIndex]->m_localQueue.MoveAllJobsTo(m_unassignedJobs);
+			delete m_workerThreads[threadIndex];
+		}
+
+		int numDomains = (int)m_stealDomains.size();
+		for (int domainIndex = 0; domainIndex < numDomains; ++domainIndex)
+		{
+			delete m_stealDomains[domainIndex];
+		}
+
+		m_stealDomains.clear();
+		m_workerThreads.clear();
+	}
+	m_domainLock.unlock();
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Adds the given job to the "todo" list for worker threads to work on
-// Returns the ID assigned to the job
+// Returns the number of worker threads currently created
 //
-int JobSystem::QueueJob(Job* job)
+int JobSystem::GetWorkerThreadCount() const
 {
-	job->m_jobID = m_nextJobID;
+	return (int)m_workerThreads.size();
+}
 
-	m_queuedLock.lock();
-	{
-		m_queuedJobs.push_back(job);
-	}
-	m_queuedLock.unlock();
 
-	m_nextJobID++;
-	if (m_nextJobID < 0)
-	{
-		m_nextJobID = 0;
-	}
+//-----------------------------------------------------------------------------------------------
+// Sets how many times an idle worker re-checks for work (yielding in between) before it goes to
+// sleep; higher values trade idle CPU time for lower dispatch latency, 0 sleeps immediately
+//
+void JobSystem::SetWorkerSpinCount(int spinCount)
+{
+	m_workerSpinCount = (spinCount > 0 ? spinCount : 0);
+}
 
-	return job->m_jobID;
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of times an idle worker checks for work before sleeping
+//
+int JobSystem::GetWorkerSpinCount() const
+{
+	return m_workerSpinCount;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Clears and deletes all jobs that exist in the JobSystem
+// Sets how many workers in each domain are never given background jobs, so critical and normal
+// jobs don't have to wait behind long running background work
 //
-void JobSystem::DestroyAllJobs()
+void JobSystem::SetReservedForegroundWorkerCount(int workerCount)
 {
-	// Queued - just delete them
-	m_queuedLock.lock();
-	{
-		int numQueued = (int)m_queuedJobs.size();
+	m_reservedForegroundWorkers = (workerCount > 0 ? workerCount : 0);
+}
 
-		for (int queuedIndex = 0; queuedIndex < numQueued; ++queuedIndex)
+
+//-----------------------------------------------------------------------------------------------
+// Returns how many workers in each domain are kept free of background jobs
+//
+int JobSystem::GetReservedForegroundWorkerCount() const
+{
+	return m_reservedForegroundWorkers;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets whether workers run jobs on fibers
+// With fibers on, a job that calls BlockUntilJobIsFinalized() is suspended and its worker goes on
+// to other work, instead of the worker blocking until the other job is done
+//
+void JobSystem::SetFiberExecutionEnabled(bool enabled)
+{
+	m_useFibers = enabled;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if workers run jobs on fibers
+//
+bool JobSystem::IsFiberExecutionEnabled() const
+{
+	return m_useFibers;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the per job type timings
+//
+JobStats& JobSystem::GetStats()
+{
+	return m_stats;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Appends the busy and idle time of every current worker since the stats were last reset
+//
+void JobSystem::GetWorkerStats(std::vector<JobWorkerStats_t>& out_workerStats)
+{
+	m_domainLock.lock_shared();
+	{
+		for (int threadIndex = 0; threadIndex < (int)m_workerThreads.size(); ++threadIndex)
 		{
-			delete m_queuedJobs[queuedIndex];
-		}
+			JobWorkerThread* worker = m_workerThreads[threadIndex];
 
-		m_queuedJobs.clear();
+			JobWorkerStats_t workerStats;
+			workerStats.name = worker->GetName();
+			workerStats.flags = worker->GetWorkerFlags();
+			workerStats.busySeconds = TimeSystem::PerformanceCountToSeconds(worker->GetBusyHPC());
+			workerStats.idleSeconds = TimeSystem::PerformanceCountToSeconds(worker->GetIdleHPC());
+			workerStats.jobsRun = worker->GetJobsRunCount();
+
+			out_workerStats.push_back(workerStats);
+		}
 	}
+	m_domainLock.unlock_shared();
+}
 
-	m_queuedLock.unlock();
 
-	// This list *SHOULD* be empty
-	ASSERT_OR_DIE(m_runningJobs.size() == 0, "JobSystem destructor still had running jobs");
+//-----------------------------------------------------------------------------------------------
+// Clears the job type histograms and the workers' times, so they cover from now on
+//
+void JobSystem::ResetStats()
+{
+	m_stats.Reset();
 
-	// Finished jobs - Don't finalize, since we cannot guarantee anything still exists
-	m_finishedLock.lock();
+	m_domainLock.lock_shared();
 	{
-		int numFinished = (int)m_finishedJobs.size();
-
-		for (int finishedIndex = 0; finishedIndex < numFinished; ++finishedIndex)
+		for (int threadIndex = 0; threadIndex < (int)m_workerThreads.size(); ++threadIndex)
 		{
-			delete m_finishedJobs[finishedIndex];
+			m_workerThreads[threadIndex]->ResetStats();
 		}
-
-		m_finishedJobs.clear();
 	}
-	m_finishedLock.unlock();
+	m_domainLock.unlock_shared();
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Returns the current status of the job given by the ID
+// Adds the given job to the "todo" list for worker threads to work on
+// Returns the ID assigned to the job
 //
-JobStatus JobSystem::GetJobStatus(int jobID)
+int JobSystem::QueueJob(Job* job)
+{
+	int jobID = m_slotTable.AllocateSlot(job, JOB_STATUS_QUEUED);
+	job->m_jobID = jobID;
+
+	PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_JOBS_QUEUED);
+	PushReadyJob(job);
+
+	return jobID;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues the job to run once the job given by predecessorJobID has finished executing
+// If the predecessor has already finished (or doesn't exist), the job is runnable immediately
+// Returns the ID assigned to the job
+//
+int JobSystem::QueueJob(Job* job, int predecessorJobID)
+{
+	std::vector<int> predecessors;
+	predecessors.push_back(predecessorJobID);
+
+	return QueueJob(job, predecessors);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues the job to run once all the predecessor jobs have finished executing, so whole graphs
+// of work can be queued at once without blocking on each stage
+// *NOTE* Only Execute() is ordered - predecessors may not be finalized before this job runs
+// Returns the ID assigned to the job
+//
+int JobSystem::QueueJob(Job* job, const std::vector<int>& predecessorJobIDs)
 {
-	bool jobFound = false;
+	// Hold one dependency ourselves while wiring up, so the job can't be released
+	// by a predecessor finishing before we're done
+	job->m_numPendingDependencies = 1;
 
-	// Check queued jobs
-	m_queuedLock.lock_shared();
+	int jobID = m_slotTable.AllocateSlot(job, JOB_STATUS_WAITING_ON_DEPENDENCIES);
+	job->m_jobID = jobID;
+
+	PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_JOBS_QUEUED);
+
+	int numPredecessors = (int)predecessorJobIDs.size();
+	for (int predecessorIndex = 0; predecessorIndex < numPredecessors; ++predecessorIndex)
 	{
-		int numQueued = (int)m_queuedJobs.size();
+		int predecessorID = predecessorJobIDs[predecessorIndex];
+		JobSlot_t* slot = m_slotTable.GetSlot(predecessorID);
+
+		if (slot == nullptr || predecessorID == jobID)
+		{
+			continue;
+		}
 
-		for (int queuedIndex = 0; queuedIndex < numQueued; ++queuedIndex)
+		// A job only becomes finished under its slot's lock and is only deleted after that, so
+		// seeing it unfinished under the lock means it's safe to attach to
+		JobSlotTable::LockContinuations(slot);
 		{
-			if (m_queuedJobs[queuedIndex]->m_jobID == jobID)
+			if (slot->jobID == predecessorID && slot->status != JOB_STATUS_FINISHED)
 			{
-				jobFound = true;
-				break;
+				job->m_numPendingDependencies++;
+				slot->job->m_continuations.push_back(job);
 			}
 		}
+		JobSlotTable::UnlockContinuations(slot);
+	}
+
+	// Release our hold - if everything was already done, it's ready now
+	if (--job->m_numPendingDependencies == 0)
+	{
+		PushReadyJob(job);
 	}
-	m_queuedLock.unlock_shared();
 
-	if (jobFound)
+	return jobID;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Called once a job has finished executing, before it's handed off for finalization
+// Marks it finished and pushes any continuations that no longer have anything left to wait on
+//
+void JobSystem::ReleaseContinuations(Job* finishedJob)
+{
+	std::vector<Job*> continuations;
+	JobSlot_t* slot = m_slotTable.GetSlot(finishedJob->m_jobID);
+
+	JobSlotTable::LockContinuations(slot);
 	{
-		return JOB_STATUS_QUEUED;
+		slot->status = JOB_STATUS_FINISHED;
+		continuations.swap(finishedJob->m_continuations);
 	}
+	JobSlotTable::UnlockContinuations(slot);
 
-	// Check running jobs
-	m_runningLock.lock_shared();
+	int numContinuations = (int)continuations.size();
+	for (int continuationIndex = 0; continuationIndex < numContinuations; ++continuationIndex)
 	{
-		int numRunning = (int)m_runningJobs.size();
+		Job* continuation = continuations[continuationIndex];
 
-		for (int runningIndex = 0; runningIndex < numRunning; ++runningIndex)
+		if (--continuation->m_numPendingDependencies == 0)
 		{
-			if (m_runningJobs[runningIndex]->m_jobID == jobID)
-			{
-				jobFound = true;
-				break;
-			}
+			PushReadyJob(continuation);
 		}
 	}
-	m_runningLock.unlock_shared();
+}
 
-	if (jobFound)
-	{
-		return JOB_STATUS_RUNNING;
-	}
 
-	// Check finished jobs
-	m_finishedLock.lock_shared();
-	{
-		int numFinished = (int)m_finishedJobs.size();
+//-----------------------------------------------------------------------------------------------
+// Called by a worker once it has switched off the fiber of a job that suspended itself to wait
+// on jobID; the job is queued again once jobID finishes, or right away if it already has
+//
+void JobSystem::ResumeJobWhenFinished(Job* suspendedJob, int jobID)
+{
+	bool isWaiting = false;
+	JobSlot_t* slot = m_slotTable.GetSlot(jobID);
 
-		for (int finishedIndex = 0; finishedIndex < numFinished; ++finishedIndex)
+	if (slot != nullptr)
+	{
+		// Same rules as attaching a continuation in QueueJob()
+		JobSlotTable::LockContinuations(slot);
 		{
-			if (m_finishedJobs[finishedIndex]->m_jobID == jobID)
+			if (slot->jobID == jobID && slot->status != JOB_STATUS_FINISHED)
 			{
-				jobFound = true;
-				break;
+				suspendedJob->m_numPendingDependencies = 1;
+				slot->job->m_continuations.push_back(suspendedJob);
+				isWaiting = true;
 			}
 		}
+		JobSlotTable::UnlockContinuations(slot);
 	}
-	m_finishedLock.unlock_shared();
 
-	if (jobFound)
+	if (!isWaiting)
 	{
-		return JOB_STATUS_FINISHED;
+		PushReadyJob(suspendedJob);
 	}
-
-	return JOB_STATUS_NOT_FOUND;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Returns true if this job has finished running and is waiting for finalization
+// Puts a job with no outstanding dependencies in front of the workers
+// Jobs pushed from a worker go on that worker's local queue if it can run them, otherwise
+// they are handed to a worker in a capable domain
 //
-bool JobSystem::IsJobFinished(int jobID)
+void JobSystem::PushReadyJob(Job* job)
 {
-	bool jobFinished = false;
+	m_slotTable.SetStatus(job->m_jobID, JOB_STATUS_QUEUED);
+
+	// A job resuming from a suspend has already been waited on
+	if (job->m_startHPC == 0)
+	{
+		job->m_readyHPC = GetPerformanceCounter();
+	}
 
-	// Check finished jobs
-	m_finishedLock.lock_shared();
+	m_domainLock.lock_shared();
 	{
-		int numFinished = (int)m_finishedJobs.size();
+		JobWorkerThread* currentWorker = JobWorkerThread::GetCurrentWorker();
 
-		for (int finishedIndex = 0; finishedIndex < numFinished; ++finishedIndex)
+		if (currentWorker != nullptr && (job->m_jobFlags & currentWorker->m_workerFlags) == job->m_jobFlags)
+		{
+			PushJobToWorker(job, currentWorker);
+			job = nullptr;
+		}
+		else
 		{
-			if (m_finishedJobs[finishedIndex]->m_jobID == jobID)
+			JobStealDomain_t* domain = FindDomainForJob(job);
+
+			if (domain != nullptr)
 			{
-				jobFinished = true;
+				PushJobToDomain(job, domain);
+				job = nullptr;
 			}
 		}
 	}
-	m_finishedLock.unlock_shared();
+	m_domainLock.unlock_shared();
 
-	return jobFinished;
+	// No worker can run it right now, so hold onto it until one is created
+	if (job != nullptr)
+	{
+		m_domainLock.lock();
+		PushJobToDomain(job, FindDomainForJob(job));
+		m_domainLock.unlock();
+	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Finalizes all jobs in the finished list
+// Pushes a job that has finished executing onto the finished list, lock-free
+// Must be the last thing the worker does with the job, since it can be finalized right after
 //
-void JobSystem::FinalizeAllFinishedJobs()
+void JobSystem::PushFinishedJob(Job* finishedJob)
 {
-	m_finishedLock.lock();
-	{
-		int numFinished = (int)m_finishedJobs.size();
-
-		for (int finishedIndex = 0; finishedIndex < numFinished; ++finishedIndex)
-		{
-			m_finishedJobs[finishedIndex]->Finalize();
-			delete m_finishedJobs[finishedIndex];
-		}
+	Job* oldHead = m_finishedHead.load();
 
-		m_finishedJobs.clear();
-	}
-	m_finishedLock.unlock();
+	do 
+	{
+		finishedJob->m_nextFinished = oldHead;
+	} while (!m_finishedHead.compare_exchange_weak(oldHead, finishedJob));
 }
 
 
-//------------------------------------------------------------------------------
-// Finalizes all jobs in the finished list that are the given ID
+//-----------------------------------------------------------------------------------------------
+// Takes everything pushed to the finished list and appends it to the finalize list, oldest first
+// Assumes m_finalizeLock is held
 //
-void JobSystem::FinalizeAllFinishedJobsOfType(int jobType)
+void JobSystem::DrainFinishedJobs()
 {
-	m_finishedLock.lock();
+	Job* pushedJobs = m_finishedHead.exchange(nullptr);
+
+	// Pushed list is newest first, so reverse it
+	Job* oldestFirst = nullptr;
+	while (pushedJobs != nullptr)
+	{
+		Job* next = pushedJobs->m_nextFinished;
+		pushedJobs->m_nextFinished = oldestFirst;
+		oldestFirst = pushedJobs;
+		pushedJobs = next;
+	}
+
+	while (oldestFirst != nullptr)
 	{
-		int numFinished = (int)m_finishedJobs.size();
+		Job* job = oldestFirst;
+		oldestFirst = oldestFirst->m_nextFinished;
 
-		for (int finishedIndex = 0; finishedIndex < numFinished; ++finishedIndex)
+		job->m_prevFinished = m_finalizeListTail;
+		job->m_nextFinished = nullptr;
+		m_slotTable.GetSlot(job->m_jobID)->isInFinalizeList = true;
+
+		if (m_finalizeListTail != nullptr)
+		{
+			m_finalizeListTail->m_nextFinished = job;
+		}
+		else
 		{
-			if (m_finishedJobs[finishedIndex]->m_jobType == jobType)
-			m_finishedJobs[finishedIndex]->Finalize();
-			delete m_finishedJobs[finishedIndex];
+			m_finalizeListHead = job;
 		}
 
-		m_finishedJobs.clear();
+		m_finalizeListTail = job;
 	}
-	m_finishedLock.unlock();
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Waits until the given job is complete, then immediately finalizes and destroys it
+// Unlinks the job from the finalize list, finalizes it, frees its slot and deletes it
+// Assumes m_finalizeLock is held
 //
-void JobSystem::BlockUntilJobIsFinalized(int jobID)
+void JobSystem::FinalizeAndDestroyJob(Job* job)
 {
-	while (!IsJobFinished(jobID))
+	if (job->m_prevFinished != nullptr)
+	{
+		job->m_prevFinished->m_nextFinished = job->m_nextFinished;
+	}
+	else
+	{
+		m_finalizeListHead = job->m_nextFinished;
+	}
+
+	if (job->m_nextFinished != nullptr)
 	{
-		// Spinwait
+		job->m_nextFinished->m_prevFinished = job->m_prevFinished;
 	}
+	else
+	{
+		m_finalizeListTail = job->m_prevFinished;
+	}
+
+	job->Finalize();
+	m_slotTable.FreeSlot(job->m_jobID);
+	m_stats.RecordFinalize(job->m_jobType, GetPerformanceCounter() - job->m_finishedHPC);
+
+	delete job;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finalizes the finished jobs oldest first while their estimates fit in the time left, measuring as it goes
+// Jobs past the budget stay in the list in order for the next call; returns the seconds spent
+//
+float JobSystem::FinalizeFinishedJobsWithinBudget(bool matchType, int jobType, float budgetSeconds)
+{
+	uint64_t startHPC = GetPerformanceCounter();
+	float secondsSpent = 0.f;
+	bool finalizedAny = false;
 
-	// Job is done - find it and finalize it, then delete it
-	m_finishedLock.lock();
+	m_finalizeLock.lock();
 	{
-		int numFinished = (int)m_finishedJobs.size();
+		DrainFinishedJobs();
 
-		for (int finishedIndex = 0; finishedIndex < numFinished; ++finishedIndex)
+		Job* job = m_finalizeListHead;
+		while (job != nullptr)
 		{
-			if (m_finishedJobs[finishedIndex]->m_jobID == jobID)
+			Job* next = job->m_nextFinished;
+
+			if (!matchType || job->m_jobType == jobType)
 			{
-				m_finishedJobs[finishedIndex]->Finalize();
+				if (finalizedAny && secondsSpent + job->m_finalizeCostSeconds > budgetSeconds)
+				{
+					break;
+				}
 
-				delete m_finishedJobs[finishedIndex];
-				m_finishedJobs.erase(m_finishedJobs.begin() + finishedIndex);
-				break;
+				FinalizeAndDestroyJob(job);
+				finalizedAny = true;
+				secondsSpent = (float) TimeSystem::PerformanceCountToSeconds(GetPerformanceCounter() - startHPC);
 			}
+
+			job = next;
 		}
 	}
-	m_finishedLock.unlock();
+	m_finalizeLock.unlock();
+
+	return secondsSpent;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Waits until all jobs of the give type are in the finished list only, and when done so finalizes
-// and deletes all
-// *NOTE* Only guarentees that it will wait for all job types that are pushed BEFORE this function
-// is called - Don't push any more after calling this!
+// Clears and deletes all jobs that exist in the JobSystem
+// Should only be called while no jobs are running
 //
-void JobSystem::BlockUntilAllJobsOfTypeAreFinalized(int jobType)
+void JobSystem::DestroyAllJobs()
 {
-	bool jobOfTypeStillQueuedOrRunning = true;
-
-	while (jobOfTypeStillQueuedOrRunning)
+	// Queued jobs are all referenced by the slot table, so just forget the queues
+	m_domainLock.lock();
 	{
-		jobOfTypeStillQueuedOrRunning = false;
+		int numDomains = (int)m_stealDomains.size();
 
-		// Check queued jobs
-		m_queuedLock.lock_shared();
-		m_runningLock.lock_shared();
+		for (int domainIndex = 0; domainIndex < numDomains; ++domainIndex)
 		{
-			int numQueued = (int)m_queuedJobs.size();
+			std::vector<JobWorkerThread*>& workers = m_stealDomains[domainIndex]->workers;
+			int numWorkers = (int)workers.size();
 
-			for (int queuedIndex = 0; queuedIndex < numQueued; ++queuedIndex)
+			for (int workerIndex = 0; workerIndex < numWorkers; ++workerIndex)
 			{
-				if (m_queuedJobs[queuedIndex]->m_jobType == jobType)
-				{
-					jobOfTypeStillQueuedOrRunning = true;
-					break;
-				}
+				std::deque<Job*> discardedJobs;
+				workers[workerIndex]->m_localQueue.MoveAllJobsTo(discardedJobs);
 			}
 
-			int numRunning = (int)m_runningJobs.size();
-			for (int runningIndex = 0; runningIndex < numRunning; ++runningIndex)
+			for (int priority = 0; priority < NUM_JOB_PRIORITIES; ++priority)
 			{
-				if (m_runningJobs[runningIndex]->m_jobType == jobType)
-				{
-					jobOfTypeStillQueuedOrRunning = true;
-					break;
-				}
+				m_stealDomains[domainIndex]->numQueuedJobs[priority] = 0;
 			}
 		}
-		m_runningLock.unlock_shared();
-		m_queuedLock.unlock_shared();
-	}
 
-	// No jobs of the given type are queued or running...
-	// *Technically* someone could push a new job of the given type RIGHT NOW, but they shouldn't
-	// be pushing more after this function is called.....
-	// i.e. only the thread calling this function should be the one pushing jobs of this type, at least
-	// at the same time
+		m_unassignedJobs.clear();
+	}
+	m_domainLock.unlock();
 
-	// Finalize all the finished jobs of the type
-	m_finishedLock.lock();
+	m_finalizeLock.lock();
 	{
-		int numFinished = (int)m_finishedJobs.size();
+		m_finishedHead = nullptr;
+		m_finalizeListHead = nullptr;
+		m_finalizeListTail = nullptr;
 
-		for (int finishedIndex = numFinished - 1; finishedIndex >= 0; --finishedIndex)
+		// Finished jobs - Don't finalize, since we cannot guarantee anything still exists
+		int numSlots = m_slotTable.GetHighWaterMark();
+		for (int slotIndex = 0; slotIndex < numSlots; ++slotIndex)
 		{
-			if (m_finishedJobs[finishedIndex]->m_jobType == jobType)
-			{
-				m_finishedJobs[finishedIndex]->Finalize();
+			JobSlot_t* slot = m_slotTable.GetSlotAtIndex(slotIndex);
+			int jobID = slot->jobID;
 
-				delete m_finishedJobs[finishedIndex];
-				m_finishedJobs.erase(m_finishedJobs.begin() + finishedIndex);
+			if (jobID < 0)
+			{
+				continue;
 			}
+
+			// This *SHOULD* never happen
+			ASSERT_OR_DIE(slot->status != JOB_STATUS_RUNNING, "JobSystem destroyed jobs while some were still running");
+
+			delete slot->job;
+			m_slotTable.FreeSlot(jobID);
 		}
 	}
-	m_finishedLock.unlock();
+	m_finalizeLock.unlock();
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Constructor
+// Returns the current status of the job given by the ID
 //
-JobSystem::JobSystem()
+JobStatus JobSystem::GetJobStatus(int jobID)
 {
+	return m_slotTable.GetStatus(jobID);
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Destructor
+// Returns the number of jobs of the given priority waiting in the worker queues
 //
-JobSystem::~JobSystem()
+int JobSystem::GetQueuedJobCount(JobPriority priority)
 {
-	DestroyAllWorkerThreads();
-	DestroyAllJobs();
+	int count = 0;
+
+	m_domainLock.lock_shared();
+	{
+		int numDomains = (int)m_stealDomains.size();
+		for (int domainIndex = 0; domainIndex < numDomains; ++domainIndex)
+		{
+			count += m_stealDomains[domainIndex]->numQueuedJobs[priority];
+		}
+	}
+	m_domainLock.unlock_shared();
+
+	return count;
 }
 
 
-//---C FUNCTION----------------------------------------------------------------------------------
-// Shortcut/Helper function for queueing a job to the JobSystem singleton instance
-// Returns the ID of the job
+//-----------------------------------------------------------------------------------------------
+// Returns true if this job has finished running and is waiting for finalization
 //
-int QueueJob(Job* job)
+bool JobSystem::IsJobFinished(int jobID)
 {
-	JobSystem* jobSystem = JobSystem::GetInstance();
-	return jobSystem->QueueJob(job);
+	return (m_slotTable.GetStatus(jobID) == JOB_STATUS_FINISHED);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finalizes all jobs in the finished list
+//
+void JobSystem::FinalizeAllFinishedJobs()
+{
+	m_finalizeLock.lock();
+	{
+		DrainFinishedJobs();
+
+		while (m_finalizeListHead != nullptr)
+		{
+			FinalizeAndDestroyJob(m_finalizeListHead);
+		}
+	}
+	m_finalizeLock.unlock();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finalizes finished jobs until the budget is used up, see FinalizeFinishedJobsWithinBudget()
+//
+float JobSystem::FinalizeFinishedJobsForBudget(float budgetSeconds)
+{
+	return FinalizeFinishedJobsWithinBudget(false, -1, budgetSeconds);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finalizes finished jobs of the given type until the budget is used up, see FinalizeFinishedJobsWithinBudget()
+//
+float JobSystem::FinalizeFinishedJobsOfTypeForBudget(int jobType, float budgetSeconds)
+{
+	return FinalizeFinishedJobsWithinBudget(true, jobType, budgetSeconds);
+}
+
+
+//------------------------------------------------------------------------------
+// Finalizes all jobs in the finished list that are the given type
+//
+void JobSystem::FinalizeAllFinishedJobsOfType(int jobType)
+{
+	m_finalizeLock.lock();
+	{
+		DrainFinishedJobs();
+
+		Job* job = m_finalizeListHead;
+		while (job != nullptr)
+		{
+			Job* next = job->m_nextFinished;
+
+			if (job->m_jobType == jobType)
+			{
+				FinalizeAndDestroyJob(job);
+			}
+
+			job = next;
+		}
+	}
+	m_finalizeLock.unlock();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Waits until the given job is complete, then immediately finalizes and destroys it
+// Called from a job running on a fiber, the job is suspended until the other job has finished
+// executing, and its worker runs other jobs in the meantime
+//
+void JobSystem::BlockUntilJobIsFinalized(int jobID)
+{
+	JobStatus initialStatus = m_slotTable.GetStatus(jobID);
+
+	if (initialStatus != JOB_STATUS_FINISHED && initialStatus != JOB_STATUS_NOT_FOUND)
+	{
+		// Does nothing if we're not on a job fiber, so we just block below as normal
+		JobWorkerThread::SuspendCurrentJobUntilFinished(jobID);
+	}
+
+	while (true)
+	{
+		JobStatus status = m_slotTable.GetStatus(jobID);
+
+		if (status == JOB_STATUS_NOT_FOUND)
+		{
+			// Already finalized by someone else (or never existed)
+			return;
+		}
+
+		if (status == JOB_STATUS_FINISHED)
+		{
+			bool wasFinalized = false;
+
+			// Only finalizers delete listed jobs, so while holding the lock a listed slot means it's still alive
+			// Jobs that finalize on their worker never go on the list, so don't touch the job until it's there
+			m_finalizeLock.lock();
+			{
+				DrainFinishedJobs();
+
+				JobSlot_t* slot = m_slotTable.GetSlot(jobID);
+
+				if (slot->jobID != jobID)
+				{
+					wasFinalized = true;
+				}
+				else if (slot->isInFinalizeList)
+				{
+					FinalizeAndDestroyJob(slot->job);
+					wasFinalized = true;
+				}
+
+				// Otherwise the worker is still just finishing up
+			}
+			m_finalizeLock.unlock();
+
+			if (wasFinalized)
+			{
+				return;
+			}
+		}
+
+		std::this_thread::yield();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Waits until all jobs of the give type are in the finished list only, and when done so finalizes
+// and deletes all
+// *NOTE* Only guarentees that it will wait for all job types that are pushed BEFORE this function
+// is called - Don't push any more after calling this!
+//
+void JobSystem::BlockUntilAllJobsOfTypeAreFinalized(int jobType)
+{
+	while (m_slotTable.IsJobOfTypeUnfinished(jobType))
+	{
+		std::this_thread::yield();
+	}
+
+	// No jobs of the given type are waiting, queued or running...
+	// *Technically* someone could push a new job of the given type RIGHT NOW, but they shouldn't
+	// be pushing more after this function is called.....
+	// i.e. only the thread calling this function should be the one pushing jobs of this type, at least
+	// at the same time
+
+	// A job can be marked finished slightly before it lands on the finished list, so wait for those too
+	bool allPushed = false;
+	while (!allPushed)
+	{
+		m_finalizeLock.lock();
+		{
+			DrainFinishedJobs();
+
+			Job* job = m_finalizeListHead;
+			while (job != nullptr)
+			{
+				Job* next = job->m_nextFinished;
+
+				if (job->m_jobType == jobType)
+				{
+					FinalizeAndDestroyJob(job);
+				}
+
+				job = next;
+			}
+
+			allPushed = !m_slotTable.IsJobOfTypeAlive(jobType);
+		}
+		m_finalizeLock.unlock();
+
+		if (!allPushed)
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+JobSystem::JobSystem()
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+JobSystem::~JobSystem()
+{
+	DestroyAllWorkerThreads();
+	DestroyAllJobs();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the domain for workers of exactly the given flags, creating one if it doesn't exist
+// Assumes m_domainLock is held exclusively
+//
+JobStealDomain_t* JobSystem::GetOrCreateDomainForFlags(WorkerThreadFlags flags)
+{
+	int numDomains = (int)m_stealDomains.size();
+
+	for (int domainIndex = 0; domainIndex < numDomains; ++domainIndex)
+	{
+		if (m_stealDomains[domainIndex]->flags == flags)
+		{
+			return m_stealDomains[domainIndex];
+		}
+	}
+
+	JobStealDomain_t* domain = new JobStealDomain_t();
+	domain->flags = flags;
+	m_stealDomains.push_back(domain);
+
+	return domain;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a domain with workers capable of running the given job, preferring a domain that
+// matches the job's flags exactly (so disk jobs go to the disk threads first)
+// Returns nullptr if no current worker can run the job
+// Assumes m_domainLock is held
+//
+JobStealDomain_t* JobSystem::FindDomainForJob(Job* job)
+{
+	JobStealDomain_t* capableDomain = nullptr;
+	int numDomains = (int)m_stealDomains.size();
+
+	for (int domainIndex = 0; domainIndex < numDomains; ++domainIndex)
+	{
+		JobStealDomain_t* domain = m_stealDomains[domainIndex];
+
+		if (domain->workers.size() == 0 || (job->m_jobFlags & domain->flags) != job->m_jobFlags)
+		{
+			continue;
+		}
+
+		if (domain->flags == job->m_jobFlags)
+		{
+			return domain;
+		}
+
+		if (capableDomain == nullptr)
+		{
+			capableDomain = domain;
+		}
+	}
+
+	return capableDomain;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Pushes the job onto the local queue of a worker in the domain, round robin
+// If domain is nullptr the job is put on the unassigned list, which requires m_domainLock to
+// be held exclusively; otherwise a shared lock is enough
+//
+void JobSystem::PushJobToDomain(Job* job, JobStealDomain_t* domain)
+{
+	if (domain == nullptr)
+	{
+		m_unassignedJobs.push_back(job);
+		return;
+	}
+
+	unsigned int workerIndex = domain->nextWorkerIndex.fetch_add(1) % (unsigned int)domain->workers.size();
+	PushJobToWorker(job, domain->workers[workerIndex]);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Pushes the job onto the worker's local queue, and wakes up the domain if anyone is asleep
+// Assumes m_domainLock is held
+//
+void JobSystem::PushJobToWorker(Job* job, JobWorkerThread* worker)
+{
+	JobStealDomain_t* domain = worker->m_domain;
+	domain->numQueuedJobs[job->m_priority]++;
+
+	worker->m_localQueue.PushBack(job);
+	WakeWorkersInDomain(domain, false);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Moves any unassigned jobs that can now be run to a capable domain
+// Assumes m_domainLock is held exclusively
+//
+void JobSystem::PushUnassignedJobs()
+{
+	std::deque<Job*> stillUnassigned;
+
+	int numUnassigned = (int)m_unassignedJobs.size();
+	for (int jobIndex = 0; jobIndex < numUnassigned; ++jobIndex)
+	{
+		Job* job = m_unassignedJobs[jobIndex];
+		JobStealDomain_t* domain = FindDomainForJob(job);
+
+		if (domain != nullptr)
+		{
+			PushJobToDomain(job, domain);
+		}
+		else
+		{
+			stillUnassigned.push_back(job);
+		}
+	}
+
+	m_unassignedJobs.swap(stillUnassigned);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a job for the worker to run, highest priority first; for each priority the worker checks
+// its own queue and then steals from the other workers in its domain
+// Background jobs are only taken if no critical jobs are queued in the domain and there's a free
+// background slot, so some workers are always available for frame-critical work
+// The job is marked running before being returned
+// Returns nullptr if no work could be found
+//
+Job* JobSystem::GetJobForWorker(JobWorkerThread* worker)
+{
+	Job* job = nullptr;
+
+	m_domainLock.lock_shared();
+	{
+		JobStealDomain_t* domain = worker->m_domain;
+		std::vector<JobWorkerThread*>& victims = domain->workers;
+		int numVictims = (int)victims.size();
+
+		for (int priorityIndex = 0; priorityIndex < NUM_JOB_PRIORITIES && job == nullptr; ++priorityIndex)
+		{
+			JobPriority priority = (JobPriority)priorityIndex;
+
+			// Skip empty priorities without touching any queue locks
+			if (domain->numQueuedJobs[priority] <= 0)
+			{
+				continue;
+			}
+
+			bool isBackground = (priority == JOB_PRIORITY_BACKGROUND);
+			if (isBackground && !TryReserveBackgroundSlot(domain))
+			{
+				break;
+			}
+
+			job = PopJobFromQueue(worker, priority, false);
+
+			// Start at a different victim each time so thieves spread out
+			int startIndex = (int)(worker->m_stealCounter++ % (unsigned int)(numVictims > 0 ? numVictims : 1));
+
+			for (int victimOffset = 0; victimOffset < numVictims && job == nullptr; ++victimOffset)
+			{
+				JobWorkerThread* victim = victims[(startIndex + victimOffset) % numVictims];
+
+				if (victim != worker)
+				{
+					job = PopJobFromQueue(victim, priority, true);
+				}
+			}
+
+			if (isBackground && job == nullptr)
+			{
+				ReleaseBackgroundSlot(domain);
+			}
+		}
+	}
+	m_domainLock.unlock_shared();
+
+	return job;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Pops a job of the given priority from the worker's queue and marks it as running
+// The owner pops the newest job, thieves take the oldest and give up if the queue is busy
+//
+Job* JobSystem::PopJobFromQueue(JobWorkerThread* queueOwner, JobPriority priority, bool isSteal)
+{
+	WorkStealingQueue* queue = &queueOwner->m_localQueue;
+
+	if (isSteal)
+	{
+		if (!queue->m_lock.try_lock())
+		{
+			return nullptr;
+		}
+	}
+	else
+	{
+		queue->m_lock.lock();
+	}
+
+	Job* job = nullptr;
+	std::deque<Job*>& jobs = queue->m_jobs[priority];
+
+	if (jobs.size() > 0)
+	{
+		if (isSteal)
+		{
+			job = jobs.front();
+			jobs.pop_front();
+		}
+		else
+		{
+			job = jobs.back();
+			jobs.pop_back();
+		}
+	}
+
+	queue->m_lock.unlock();
+
+	if (job != nullptr)
+	{
+		queueOwner->m_domain->numQueuedJobs[priority]--;
+		m_slotTable.SetStatus(job->m_jobID, JOB_STATUS_RUNNING);
+	}
+
+	return job;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Tries to claim one of the domain's background slots, returning true if one was claimed
+// Fails while critical jobs are waiting, or once all but the reserved workers are busy with
+// background jobs
+//
+bool JobSystem::TryReserveBackgroundSlot(JobStealDomain_t* domain)
+{
+	if (domain->numQueuedJobs[JOB_PRIORITY_CRITICAL] > 0)
+	{
+		return false;
+	}
+
+	int maxBackgroundJobs = (int)domain->workers.size() - m_reservedForegroundWorkers;
+	if (maxBackgroundJobs < 1)
+	{
+		maxBackgroundJobs = 1;
+	}
+
+	int numRunning = domain->numRunningBackgroundJobs.load();
+	while (numRunning < maxBackgroundJobs)
+	{
+		if (domain->numRunningBackgroundJobs.compare_exchange_weak(numRunning, numRunning + 1))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Gives back a background slot claimed with TryReserveBackgroundSlot
+//
+void JobSystem::ReleaseBackgroundSlot(JobStealDomain_t* domain)
+{
+	domain->numRunningBackgroundJobs--;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Wakes sleeping workers in the domain so they can pick up newly pushed work
+// Only touches the semaphore if someone is actually asleep, so pushing stays cheap when busy
+//
+void JobSystem::WakeWorkersInDomain(JobStealDomain_t* domain, bool wakeAll)
+{
+	int numSleeping = domain->numSleepingWorkers.load();
+
+	if (numSleeping > 0)
+	{
+		domain->wakeSemaphore.Release(wakeAll ? (unsigned int)numSleeping : 1U);
+	}
+}
+
+
+//---C FUNCTION----------------------------------------------------------------------------------
+// Shortcut/Helper function for queueing a job to the JobSystem singleton instance
+// Returns the ID of the job
+//
+int QueueJob(Job* job)
+{
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	return jobSystem->QueueJob(job);
+}
+
+
+//---C FUNCTION----------------------------------------------------------------------------------
+// Shortcut for queueing a job that runs once the predecessor has finished
+// Returns the ID of the job
+//
+int QueueJob(Job* job, int predecessorJobID)
+{
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	return jobSystem->QueueJob(job, predecessorJobID);
+}
+
+
+//---C FUNCTION----------------------------------------------------------------------------------
+// Shortcut for queueing a job that runs once all the predecessors have finished
+// Returns the ID of the job
+//
+int QueueJob(Job* job, const std::vector<int>& predecessorJobIDs)
+{
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	return jobSystem->QueueJob(job, predecessorJobIDs);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Prints the percentiles of each job type, and how busy each worker and each domain of workers
+// with the same flags has been, since the last reset
+//
+void Command_JobStats(Command& cmd)
+{
+	JobSystem* jobSystem = JobSystem::GetInstance();
+
+	std::vector<std::string> typeLines;
+	jobSystem->GetStats().GetSummaryText(typeLines);
+
+	ConsolePrintf(Rgba::GREEN, "Job times over the last %i jobs of each type, over %.2f ms counts as a hitch:", JOB_STATS_WINDOW_SIZE, JOB_STATS_SLOW_MS);
+	for (int lineIndex = 0; lineIndex < (int)typeLines.size(); ++lineIndex)
+	{
+		ConsolePrintf(Rgba::GREEN, "%s", typeLines[lineIndex].c_str());
+	}
+
+	std::vector<JobWorkerStats_t> workerStats;
+	jobSystem->GetWorkerStats(workerStats);
+
+	ConsolePrintf(Rgba::GREEN, "Workers:");
+
+	// Domains are the workers with the same flags, totalled as the workers are printed
+	std::vector<JobWorkerStats_t> domainStats;
+	std::vector<int> domainWorkerCounts;
+
+	for (int workerIndex = 0; workerIndex < (int)workerStats.size(); ++workerIndex)
+	{
+		const JobWorkerStats_t& worker = workerStats[workerIndex];
+		double totalSeconds = worker.busySeconds + worker.idleSeconds;
+		double busyPercent = (totalSeconds > 0.0 ? 100.0 * worker.busySeconds / totalSeconds : 0.0);
+
+		ConsolePrintf(Rgba::GREEN, "%-*s flags: 0x%08x  busy: %6.2f%%  jobs: %llu", 24, worker.name.c_str(), worker.flags, busyPercent, worker.jobsRun);
+
+		int domainIndex = 0;
+		while (domainIndex < (int)domainStats.size() && domainStats[domainIndex].flags != worker.flags)
+		{
+			domainIndex++;
+		}
+
+		if (domainIndex == (int)domainStats.size())
+		{
+			JobWorkerStats_t domain;
+			domain.flags = worker.flags;
+			domainStats.push_back(domain);
+			domainWorkerCounts.push_back(0);
+		}
+
+		domainStats[domainIndex].busySeconds += worker.busySeconds;
+		domainStats[domainIndex].idleSeconds += worker.idleSeconds;
+		domainStats[domainIndex].jobsRun += worker.jobsRun;
+		domainWorkerCounts[domainIndex]++;
+	}
+
+	ConsolePrintf(Rgba::GREEN, "Domains:");
+	for (int domainIndex = 0; domainIndex < (int)domainStats.size(); ++domainIndex)
+	{
+		const JobWorkerStats_t& domain = domainStats[domainIndex];
+		double totalSeconds = domain.busySeconds + domain.idleSeconds;
+		double busyPercent = (totalSeconds > 0.0 ? 100.0 * domain.busySeconds / totalSeconds : 0.0);
+
+		ConsolePrintf(Rgba::GREEN, "flags: 0x%08x  workers: %i  busy: %6.2f%%  jobs: %llu", domain.flags, domainWorkerCounts[domainIndex], busyPercent, domain.jobsRun);
+	}
+
+	ConsolePrintf(Rgba::GREEN, "Queued now - critical: %i  normal: %i  background: %i",
+		jobSystem->GetQueuedJobCount(JOB_PRIORITY_CRITICAL), jobSystem->GetQueuedJobCount(JOB_PRIORITY_NORMAL), jobSystem->GetQueuedJobCount(JOB_PRIORITY_BACKGROUND));
+
+	bool shouldReset = false;
+	cmd.GetParam("r", shouldReset, &shouldReset);
+
+	if (shouldReset)
+	{
+		jobSystem->ResetStats();
+		ConsolePrintf(Rgba::GREEN, "Job stats reset.");
+	}
 }
@@ -5,17 +5,16 @@
 /* Description: Class for the multi-threaded job system
 /************************************************************************/
 #pragma once
+#include <deque>
+#include <atomic>
+#include <mutex>
 #include <vector>
 #include <shared_mutex>
-
-enum JobStatus
-{
-	JOB_STATUS_QUEUED,
-	JOB_STATUS_RUNNING,
-	JOB_STATUS_FINISHED,
-	JOB_STATUS_NOT_FOUND
-};
-
+#include "Engine/Core/JobSystem/Job.hpp"
+#include "Engine/Core/JobSystem/JobStats.hpp"
+#include "Engine/Core/Threading/Semaphore.hpp"
+#include "Engine/Core/Threading/Threading.hpp"
+#include "Engine/Core/JobSystem/JobSlotTable.hpp"
 
 enum WorkerThreadFlags : uint32_t
 {
@@ -25,7 +24,37 @@ enum WorkerThreadFlags : uint32_t
 };
 
 
-class Job;
+class JobWorkerThread;
+class WorkStealingQueue;
+
+// All workers created with the same flags form a domain, and only steal from each other
+// Any worker in a domain is guaranteed to be able to run any job placed in that domain
+struct JobStealDomain_t
+{
+	WorkerThreadFlags				flags;
+	std::vector<JobWorkerThread*>	workers;
+	std::atomic<unsigned int>		nextWorkerIndex{ 0 }; // Round robin for jobs queued from outside the domain
+
+	// Idle workers sleep on this instead of polling, signaled whenever a job is pushed to the domain
+	Semaphore						wakeSemaphore;
+	std::atomic<int>				numSleepingWorkers{ 0 };
+	// Per priority depth of all the queues in the domain, and how many background jobs are running
+	std::atomic<int>				numQueuedJobs[NUM_JOB_PRIORITIES];
+	std::atomic<int>				numRunningBackgroundJobs{ 0 };
+
+	JobStealDomain_t()
+	{
+		for (int priority = 0; priority < NUM_JOB_PRIORITIES; ++priority) { numQueuedJobs[priority] = 0; }
+	}
+};
+
+// How many times an idle worker re-checks for work before going to sleep
+#define DEFAULT_WORKER_SPIN_COUNT (64)
+
+// How many workers in each domain are kept free of background jobs, so frame-critical work always
+// has somewhere to run (domains with a single worker still run background jobs)
+#define DEFAULT_RESERVED_FOREGROUND_WORKERS (1)
+
 
 class JobSystem
 {
@@ -38,21 +67,43 @@ public:
 	static void			Shutdown();
 	static JobSystem*	GetInstance();
 
-	void				CreateWorkerThread(const char* name, WorkerThreadFlags flags);
+	void				CreateWorkerThread(const char* name, WorkerThreadFlags flags, uint64_t affinityMask = THREAD_AFFINITY_ANY, eThreadPriority priority = THREAD_PRIORITY_SETTING_NORMAL);
+	void				CreateDefaultWorkerThreads();
 	void				DestroyWorkerThread(const char* name);
 	void				DestroyAllWorkerThreads();
+	int					GetWorkerThreadCount() const;
+	void				SetWorkerSpinCount(int spinCount);
+	int					GetWorkerSpinCount() const;
+	void				SetReservedForegroundWorkerCount(int workerCount);
+	int					GetReservedForegroundWorkerCount() const;
+	void				SetFiberExecutionEnabled(bool enabled);
+	bool				IsFiberExecutionEnabled() const;
 
 	int					QueueJob(Job* job);
+	int					QueueJob(Job* job, int predecessorJobID);
+	int					QueueJob(Job* job, const std::vector<int>& predecessorJobIDs);
 	void				DestroyAllJobs();
 
 	JobStatus			GetJobStatus(int jobID);
+	int					GetQueuedJobCount(JobPriority priority);
 	bool				IsJobFinished(int jobID);
 
 	void				FinalizeAllFinishedJobs();
 	void				FinalizeAllFinishedJobsOfType(int jobType);
+
+	// Time-sliced finalizing, oldest first, stopping once the next job's cost estimate won't fit in what's left
+	// of the budget; at least one is always finalized, so a backlog drains; returns the seconds spent
+	float				FinalizeFinishedJobsForBudget(float budgetSeconds);
+	float				FinalizeFinishedJobsOfTypeForBudget(int jobType, float budgetSeconds);
 	void				BlockUntilJobIsFinalized(int jobID);
 	void				BlockUntilAllJobsOfTypeAreFinalized(int jobType);
 
+	// Wait, run and finalize times of each job type and each worker's busy/idle time, for sizing the
+	// workers of each WorkerThreadFlags domain; the profiler's counters keep the per frame totals
+	JobStats&			GetStats();
+	void				GetWorkerStats(std::vector<JobWorkerStats_t>& out_workerStats);
+	void				ResetStats();
+
 
 private:
 	//-----Private Methods-----
@@ -62,18 +113,56 @@ private:
 	~JobSystem();
 	JobSystem(const JobSystem& copy) = delete;
 
+	static void			InitializeConsoleCommands();
+
+	// Dependencies
+	void				ReleaseContinuations(Job* finishedJob);
+	void				ResumeJobWhenFinished(Job* suspendedJob, int jobID);
+
+	// Finishing
+	void				PushFinishedJob(Job* finishedJob);
+	void				DrainFinishedJobs();
+	void				FinalizeAndDestroyJob(Job* job);
+	float				FinalizeFinishedJobsWithinBudget(bool matchType, int jobType, float budgetSeconds);
+
+	// Scheduling
+	void				PushReadyJob(Job* job);
+	JobStealDomain_t*	GetOrCreateDomainForFlags(WorkerThreadFlags flags);
+	JobStealDomain_t*	FindDomainForJob(Job* job);
+	void				PushJobToDomain(Job* job, JobStealDomain_t* domain);
+	void				PushJobToWorker(Job* job, JobWorkerThread* worker);
+	void				PushUnassignedJobs();
+	Job*				GetJobForWorker(JobWorkerThread* worker);
+	Job*				PopJobFromQueue(JobWorkerThread* queueOwner, JobPriority priority, bool isSteal);
+	bool				TryReserveBackgroundSlot(JobStealDomain_t* domain);
+	void				ReleaseBackgroundSlot(JobStealDomain_t* domain);
+	void				WakeWorkersInDomain(JobStealDomain_t* domain, bool wakeAll);
+
 
 private:
 	//-----Private Data-----
 
-	std::vector<JobWorkerThread*>	m_workerThreads;
-	std::shared_mutex				m_queuedLock;
-	std::shared_mutex				m_runningLock;
-	std::shared_mutex				m_finishedLock;
-	std::vector<Job*>				m_queuedJobs;
-	std::vector<Job*>				m_runningJobs;
-	std::vector<Job*>				m_finishedJobs;
-	int								m_nextJobID = 0;
+	std::vector<JobWorkerThread*>	m_workerThreads;	// Changed by the main thread under m_domainLock, read by others under it
+
+	// Queued jobs live in the worker's local queues, grouped by steal domain
+	std::shared_mutex				m_domainLock;
+	std::vector<JobStealDomain_t*>	m_stealDomains;
+	std::deque<Job*>				m_unassignedJobs; // Jobs that no current worker can run, protected by m_domainLock
+
+	// Every job that hasn't been finalized owns a slot, which holds its status
+	JobSlotTable					m_slotTable;
+
+	// Finished jobs are pushed lock-free by the workers; whoever finalizes drains them into
+	// a doubly linked list under the finalize lock, so any single job can be removed in O(1)
+	std::atomic<Job*>				m_finishedHead{ nullptr };
+	std::mutex						m_finalizeLock;
+	Job*							m_finalizeListHead = nullptr;
+	Job*							m_finalizeListTail = nullptr;
+	std::atomic<int>				m_workerSpinCount{ DEFAULT_WORKER_SPIN_COUNT };
+	std::atomic<int>				m_reservedForegroundWorkers{ DEFAULT_RESERVED_FOREGROUND_WORKERS };
+	std::atomic<bool>				m_useFibers{ false };
+
+	JobStats						m_stats;
 
 	static JobSystem*				s_instance;
 
@@ -85,3 +174,5 @@ private:
 //////////////////////////////////////////////////////////////////////////
 
 int QueueJob(Job* job);
+int QueueJob(Job* job, int predecessorJobID);
+int QueueJob(Job* job, const std::vector<int>& predecessorJobIDs);
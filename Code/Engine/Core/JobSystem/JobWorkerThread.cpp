@@ -5,17 +5,27 @@
 /* Description: Implementation of the JobWorkerThread class
 /************************************************************************/
 #include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/Time/Time.hpp"
+#include "Engine/Core/Time/Profiler.hpp"
+#include "Engine/Core/Time/ProfileCounters.hpp"
 #include "Engine/Core/JobSystem/Job.hpp"
 #include "Engine/Core/JobSystem/JobSystem.hpp"
 #include "Engine/Core/JobSystem/JobWorkerThread.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+
+// The worker running on the calling thread, so jobs queued from inside a job stay local
+static thread_local JobWorkerThread* s_currentWorker = nullptr;
 
 
 //------------------------------------------------------------------------------
 // Constructor
 //
-JobWorkerThread::JobWorkerThread(const char* name, WorkerThreadFlags flags, JobSystem* jobSystem)
+JobWorkerThread::JobWorkerThread(const char* name, WorkerThreadFlags flags, uint64_t affinityMask, eThreadPriority priority, JobStealDomain_t* domain, JobSystem* jobSystem)
 	: m_name(name)
 	, m_workerFlags(flags)
+	, m_affinityMask(affinityMask)
+	, m_priority(priority)
+	, m_domain(domain)
 	, m_jobSystem(jobSystem)
 {
 	m_threadHandle = std::thread(&JobWorkerThread::JobWorkerThreadEntry, this);
@@ -35,6 +45,18 @@ JobWorkerThread::~JobWorkerThread()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Zeroes the busy and idle time and the jobs run, for measuring from now
+// Time the worker is adding as this runs may be kept or lost
+//
+void JobWorkerThread::ResetStats()
+{
+	m_busyHPC = 0;
+	m_idleHPC = 0;
+	m_jobsRunCount = 0;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Tells the thread to finish the current job (if there is one)
 // Does *NOT* join the thread
@@ -42,6 +64,9 @@ JobWorkerThread::~JobWorkerThread()
 void JobWorkerThread::StopRunning()
 {
 	m_isRunning = false;
+
+	// Wake everyone in the domain, since we can't target just this thread
+	m_jobSystem->WakeWorkersInDomain(m_domain, true);
 }
 
 
@@ -65,90 +90,324 @@ void JobWorkerThread::Join()
 //
 void JobWorkerThread::JobWorkerThreadEntry()
 {
+	s_currentWorker = this;
+
+	// Set up the OS side of the thread before doing any work
+	Thread::SetThisThreadName(m_name.c_str());
+	Profiler::RegisterThisThread(m_name.c_str());
+
+	if (m_affinityMask != THREAD_AFFINITY_ANY)
+	{
+		Thread::SetThisThreadAffinity(m_affinityMask);
+	}
+
+	if (m_priority != THREAD_PRIORITY_SETTING_NORMAL)
+	{
+		Thread::SetThisThreadPriority(m_priority);
+	}
+
+	// Become a fiber so jobs can be run on (and suspended on) fibers of their own
+	m_schedulerFiber = Fiber::ConvertThisThreadToFiber(this);
+
 	while (m_isRunning)
 	{
-		// Get a job
-		Job* nextJob = DequeueJobForExecution();
+		// Get a job, sleeping until one is available
+		uint64_t waitStartHPC = GetPerformanceCounter();
+		Job* nextJob = WaitForJob();
+		uint64_t waitEndHPC = GetPerformanceCounter();
 
-		// Execute it if we got one
+		m_idleHPC += (waitEndHPC - waitStartHPC);
+		PROFILE_COUNTER_ADD(PROFILE_COUNTER_WORKER_IDLE_MICROSECONDS, (uint64_t) (TimeSystem::PerformanceCountToSeconds(waitEndHPC - waitStartHPC) * 1000000.0));
+
+		// Execute it if we got one - might have been woken up to stop running instead
 		if (nextJob != nullptr)
 		{
-			nextJob->Execute();
+			bool isSuspended = (nextJob->m_fiber != nullptr);
+			bool canUseFibers = (m_schedulerFiber != nullptr && m_jobSystem->IsFiberExecutionEnabled());
 
-			// Put it in finished list
-			MarkJobAsFinished(nextJob);
+			if (isSuspended || canUseFibers)
+			{
+				RunJobOnFiber(nextJob);
+			}
+			else
+			{
+				RunJob(nextJob);
+			}
+
+			// Until it finished or suspended, so time suspended doesn't count as busy
+			uint64_t runEndHPC = GetPerformanceCounter();
+
+			m_busyHPC += (runEndHPC - waitEndHPC);
+			m_jobsRunCount++;
+			PROFILE_COUNTER_ADD(PROFILE_COUNTER_WORKER_BUSY_MICROSECONDS, (uint64_t) (TimeSystem::PerformanceCountToSeconds(runEndHPC - waitEndHPC) * 1000000.0));
 		}
-		else
+	}
+
+	DestroyFreeFibers();
+
+	if (m_schedulerFiber != nullptr)
+	{
+		Fiber::ConvertThisFiberToThread();
+		m_schedulerFiber = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Executes the job and hands it off as finished
+// The job may suspend inside Execute() and finish on a different worker, so the worker is
+// looked up again afterwards instead of being passed in
+//
+void JobWorkerThread::RunJob(Job* job)
+{
+	// Job may be deleted once it's marked finished, so grab this now
+	bool isBackground = (job->GetPriority() == JOB_PRIORITY_BACKGROUND);
+	uint32_t jobID = (uint32_t) job->GetID();
+
+	job->m_startHPC = GetPerformanceCounter();
+	uint64_t waitHPC = job->m_startHPC - job->m_readyHPC;
+
+	// Async, since the job can resume on another worker after suspending
+	Profiler::BeginAsyncMeasurement("Job", jobID);
+	job->Execute();
+	Profiler::EndAsyncMeasurement("Job", jobID);
+
+	job->m_finishedHPC = GetPerformanceCounter();
+
+	PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_JOBS_RUN);
+	PROFILE_COUNTER_ADD(PROFILE_COUNTER_JOB_WAIT_MICROSECONDS, (uint64_t) (TimeSystem::PerformanceCountToSeconds(waitHPC) * 1000000.0));
+
+	JobWorkerThread* worker = GetCurrentWorker();
+	JobSystem* jobSystem = worker->m_jobSystem;
+
+	jobSystem->m_stats.RecordExecution(job->m_jobType, waitHPC, job->m_finishedHPC - job->m_startHPC);
+
+	// Kick off anything that was waiting on it, *before* it can be finalized and deleted
+	jobSystem->ReleaseContinuations(job);
+
+	// Put it in finished list
+	worker->MarkJobAsFinished(job);
+
+	if (isBackground)
+	{
+		jobSystem->ReleaseBackgroundSlot(worker->m_domain);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts the job on a free fiber, or resumes the fiber it was suspended on
+// Returns once the job has finished or suspended itself again
+//
+void JobWorkerThread::RunJobOnFiber(Job* job)
+{
+	JobFiber_t* fiber = job->m_fiber;
+
+	if (fiber != nullptr)
+	{
+		job->m_fiber = nullptr;
+	}
+	else
+	{
+		fiber = AcquireFiber();
+		fiber->job = job;
+	}
+
+	m_currentFiber = fiber;
+	Fiber::SwitchTo(fiber->handle);
+
+	// Back on the scheduler - the fiber either finished its job or suspended it
+	m_currentFiber = nullptr;
+
+	if (m_suspendedJob != nullptr)
+	{
+		Job* suspendedJob = m_suspendedJob;
+		m_suspendedJob = nullptr;
+
+		suspendedJob->m_fiber = fiber;
+
+		// Don't hold a background slot while not running, one is claimed again when it's picked back up
+		if (suspendedJob->GetPriority() == JOB_PRIORITY_BACKGROUND)
 		{
-			// No jobs for us exist, might as well sleep a little since there might not be a job soon
-			// Also reduces the amount of contention for accessing the vectors on the JobSystem
-			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			m_jobSystem->ReleaseBackgroundSlot(m_domain);
 		}
+
+		// Only safe now that nothing is running on the fiber, since another worker could resume it immediately
+		m_jobSystem->ResumeJobWhenFinished(suspendedJob, m_suspendedOnJobID);
+	}
+	else
+	{
+		m_freeFibers.push_back(fiber);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a fiber to run a new job on, reusing ones this worker has freed up
+//
+JobFiber_t* JobWorkerThread::AcquireFiber()
+{
+	if (m_freeFibers.size() > 0)
+	{
+		JobFiber_t* fiber = m_freeFibers.back();
+		m_freeFibers.pop_back();
+
+		return fiber;
+	}
+
+	JobFiber_t* fiber = new JobFiber_t();
+	fiber->handle = Fiber::Create(JobFiberEntry, fiber, DEFAULT_FIBER_STACK_SIZE);
+	ASSERT_OR_DIE(fiber->handle != nullptr, "Couldn't create a job fiber");
+
+	return fiber;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Frees the fibers this worker isn't using, called before the thread exits
+// Fibers of suspended jobs belong to those jobs, not to any worker
+//
+void JobWorkerThread::DestroyFreeFibers()
+{
+	int numFibers = (int)m_freeFibers.size();
+	for (int fiberIndex = 0; fiberIndex < numFibers; ++fiberIndex)
+	{
+		Fiber::Destroy(m_freeFibers[fiberIndex]->handle);
+		delete m_freeFibers[fiberIndex];
+	}
+
+	m_freeFibers.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Entry for all job fibers; runs whatever job it's given, then hands control back to the
+// scheduler of the worker it ended up on
+//
+void JobWorkerThread::JobFiberEntry(void* fiberData)
+{
+	JobFiber_t* fiber = (JobFiber_t*)fiberData;
+
+	while (true)
+	{
+		RunJob(fiber->job);
+		fiber->job = nullptr;
+
+		Fiber::SwitchTo(GetCurrentWorker()->m_schedulerFiber);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Suspends the job running on the calling fiber until the job given by jobID has finished executing
+// Returns false without suspending if the caller isn't a job running on a fiber
+// When this returns true the job has been resumed, usually on a different worker
+//
+bool JobWorkerThread::SuspendCurrentJobUntilFinished(int jobID)
+{
+	JobWorkerThread* worker = GetCurrentWorker();
+
+	if (worker == nullptr || worker->m_currentFiber == nullptr)
+	{
+		return false;
 	}
+
+	// The scheduler registers the wait once we've switched off, so we can't be resumed while still running
+	worker->m_suspendedJob = worker->m_currentFiber->job;
+	worker->m_suspendedOnJobID = jobID;
+
+	Fiber::SwitchTo(worker->m_schedulerFiber);
+
+	return true;
 }
 
 
 //-----------------------------------------------------------------------------------------------
 // Gets a job from the JobSystem to execute that satisfies this worker thread's flags
-// Removes the job from the queued list and puts it in the running list
+// Checks this worker's local queue first, then steals from the other workers in its domain
+// The job is already marked as running when returned
 //
 Job* JobWorkerThread::DequeueJobForExecution()
 {
-	Job* jobToExecute = nullptr;
+	return m_jobSystem->GetJobForWorker(this);
+}
 
-	m_jobSystem->m_queuedLock.lock();
-	m_jobSystem->m_runningLock.lock();
+
+//-----------------------------------------------------------------------------------------------
+// Returns a job to execute, spinning for a short while if there isn't one before going to sleep
+// on the domain's semaphore until new work is pushed
+// Returns nullptr if the thread was told to stop running while waiting
+//
+Job* JobWorkerThread::WaitForJob()
+{
+	int spinCount = m_jobSystem->GetWorkerSpinCount();
+
+	while (m_isRunning)
 	{
-		int numQueuedJobs = (int)m_jobSystem->m_queuedJobs.size();
+		Job* job = DequeueJobForExecution();
 
-		for (int queueIndex = 0; queueIndex < numQueuedJobs; ++queueIndex)
+		// Spin phase - work usually comes in bursts, so look again before paying for a sleep
+		for (int spinIndex = 0; spinIndex < spinCount && job == nullptr && m_isRunning; ++spinIndex)
 		{
-			uint32_t jobFlags = m_jobSystem->m_queuedJobs[queueIndex]->GetJobFlags();
+			std::this_thread::yield();
+			job = DequeueJobForExecution();
+		}
 
-			if ((jobFlags & m_workerFlags) == jobFlags)
-			{
-				jobToExecute = m_jobSystem->m_queuedJobs[queueIndex];
-				m_jobSystem->m_queuedJobs.erase(m_jobSystem->m_queuedJobs.begin() + queueIndex);
-				break;
-			}
+		if (job != nullptr)
+		{
+			return job;
 		}
 
-		if (jobToExecute != nullptr)
+		// Announce we're going to sleep *before* the last check, so a job pushed in between
+		// is either seen here or wakes us up
+		m_domain->numSleepingWorkers++;
+
+		job = DequeueJobForExecution();
+		if (job == nullptr && m_isRunning)
+		{
+			m_domain->wakeSemaphore.Acquire();
+		}
+
+		m_domain->numSleepingWorkers--;
+
+		if (job != nullptr)
 		{
-			m_jobSystem->m_runningJobs.push_back(jobToExecute);
+			return job;
 		}
 	}
-	m_jobSystem->m_runningLock.unlock();
-	m_jobSystem->m_queuedLock.unlock();
 
-	return jobToExecute;
+	return nullptr;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Removes the given job from the running list and adds it to the finished list
+// Hands the finished job off for finalization
+// Jobs that finalize on the worker are finalized and deleted here instead
 //
 void JobWorkerThread::MarkJobAsFinished(Job* finishedJob)
 {
-	std::vector<Job*>& runningJobs = m_jobSystem->m_runningJobs;
-	std::vector<Job*>& finishedJobs = m_jobSystem->m_finishedJobs;
+	if (finishedJob->m_finalizeOnWorker)
+	{
+		finishedJob->Finalize();
+		m_jobSystem->m_stats.RecordFinalize(finishedJob->m_jobType, GetPerformanceCounter() - finishedJob->m_finishedHPC);
 
-	m_jobSystem->m_runningLock.lock();
-	m_jobSystem->m_finishedLock.lock();
+		m_jobSystem->m_slotTable.FreeSlot(finishedJob->m_jobID);
+		delete finishedJob;
+	}
+	else
 	{
-		int numRunningJobs = (int)runningJobs.size();
+		m_jobSystem->PushFinishedJob(finishedJob);
+	}
+}
 
-		for (int runningIndex = 0; runningIndex < numRunningJobs; ++runningIndex)
-		{
-			if (runningJobs[runningIndex] == finishedJob)
-			{
-				runningJobs.erase(runningJobs.begin() + runningIndex);
-				break;
-			}
-		}
 
-		finishedJobs.push_back(finishedJob);
-	}
-	m_jobSystem->m_finishedLock.unlock();
-	m_jobSystem->m_runningLock.unlock();
+//-----------------------------------------------------------------------------------------------
+// Returns the worker that is running on the calling thread, or nullptr if the calling thread
+// isn't a JobWorkerThread
+// Never inlined, so the thread local is re-read after a fiber switch instead of being cached
+// from whichever thread the fiber was on before
+//
+__declspec(noinline) JobWorkerThread* JobWorkerThread::GetCurrentWorker()
+{
+	return s_currentWorker;
 }
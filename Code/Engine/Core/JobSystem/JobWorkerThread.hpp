@@ -6,38 +6,72 @@
 /************************************************************************/
 #pragma once
 #include "Engine/Core/JobSystem/JobSystem.hpp"
+#include "Engine/Core/JobSystem/WorkStealingQueue.hpp"
+#include "Engine/Core/Threading/Fiber.hpp"
+#include <atomic>
 #include <thread>
 #include <string>
+#include <vector>
 
 
 
 class Job;
 class JobSystem;
 
+// Fiber that jobs are executed on, so a job can be suspended mid-Execute() without blocking its worker
+// Fibers aren't tied to a worker - a suspended job resumes on whichever worker picks it up
+struct JobFiber_t
+{
+	FiberHandle_t	handle = nullptr;
+	Job*			job = nullptr;	// Job currently running on (or suspended on) the fiber
+};
+
 class JobWorkerThread
 {
+	friend class JobSystem;
+
 public:
 	//-----Public Methods-----
 
-	JobWorkerThread(const char* name, WorkerThreadFlags flags, JobSystem* jobSystem);
+	JobWorkerThread(const char* name, WorkerThreadFlags flags, uint64_t affinityMask, eThreadPriority priority, JobStealDomain_t* domain, JobSystem* jobSystem);
 	~JobWorkerThread();
 
 	inline std::string	GetName() const { return m_name; }
 	inline bool			IsRunning() const { return m_isRunning; }
+	inline uint64_t		GetAffinityMask() const { return m_affinityMask; }
 	inline JobSystem*	GetOwningJobSystem() const { return m_jobSystem; }
 	inline std::thread&	GetThreadHandle() { return m_threadHandle; }
+	inline uint32_t		GetWorkerFlags() const { return (uint32_t) m_workerFlags; }
+
+	// Since the last reset, as performance counts
+	inline uint64_t		GetBusyHPC() const { return m_busyHPC; }
+	inline uint64_t		GetIdleHPC() const { return m_idleHPC; }
+	inline uint64_t		GetJobsRunCount() const { return m_jobsRunCount; }
+	void				ResetStats();
 
 	void				StopRunning();
 	void				Join();
 
+	static JobWorkerThread* GetCurrentWorker(); // nullptr if the calling thread isn't a worker
+
 
 private:
 	//-----Private Methods
 
 	void JobWorkerThreadEntry();
 	Job* DequeueJobForExecution();
+	Job* WaitForJob();
 	void MarkJobAsFinished(Job* finishedJob);
 
+	// Fibers
+	void		RunJobOnFiber(Job* job);
+	JobFiber_t*	AcquireFiber();
+	void		DestroyFreeFibers();
+
+	static void RunJob(Job* job);
+	static void JobFiberEntry(void* fiberData);
+	static bool SuspendCurrentJobUntilFinished(int jobID);
+
 
 private:
 	//-----Private Data-----
@@ -45,7 +79,26 @@ private:
 	std::string			m_name;
 	std::thread			m_threadHandle;
 	WorkerThreadFlags	m_workerFlags;
-	bool				m_isRunning = true;
+	std::atomic<bool>	m_isRunning{ true };
+	uint64_t			m_affinityMask = THREAD_AFFINITY_ANY;
+	eThreadPriority		m_priority = THREAD_PRIORITY_SETTING_NORMAL;
 	JobSystem*			m_jobSystem = nullptr;
 
+	// Work stealing
+	WorkStealingQueue	m_localQueue;
+	JobStealDomain_t*	m_domain = nullptr;
+	unsigned int		m_stealCounter = 0;
+
+	// Fibers - the thread itself becomes the scheduler fiber, which jobs switch back to when they finish or suspend
+	FiberHandle_t				m_schedulerFiber = nullptr;
+	JobFiber_t*					m_currentFiber = nullptr;
+	Job*						m_suspendedJob = nullptr;	// Set by a job suspending itself, for the scheduler to pick up
+	int							m_suspendedOnJobID = -1;
+	std::vector<JobFiber_t*>	m_freeFibers;
+
+	// Stats, only added to by the worker
+	std::atomic<uint64_t>		m_busyHPC{ 0 };
+	std::atomic<uint64_t>		m_idleHPC{ 0 };
+	std::atomic<uint64_t>		m_jobsRunCount{ 0 };
+
 };
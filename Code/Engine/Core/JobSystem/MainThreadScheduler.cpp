@@ -0,0 +1,175 @@
+/************************************************************************/
+/* File: MainThreadScheduler.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the MainThreadScheduler class
+/************************************************************************/
+#include "Engine/Core/Time/Time.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
+#include "Engine/Core/JobSystem/MainThreadScheduler.hpp"
+
+std::mutex						MainThreadScheduler::s_queueLock;
+std::deque<MainThreadTask_t>	MainThreadScheduler::s_queues[NUM_JOB_PRIORITIES];
+float							MainThreadScheduler::s_frameBudgetSeconds = MAIN_THREAD_DEFAULT_FRAME_BUDGET_SECONDS;
+float							MainThreadScheduler::s_frameSecondsSpent = 0.f;
+float							MainThreadScheduler::s_lastFrameSeconds = 0.f;
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues the task to run on the main thread in a later Update()
+//
+void MainThreadScheduler::QueueTask(MainThreadTask_cb task, float costEstimateSeconds /*= 0.f*/, JobPriority priority /*= JOB_PRIORITY_NORMAL*/)
+{
+	MainThreadTask_t entry;
+	entry.task = task;
+	entry.costSeconds = costEstimateSeconds;
+
+	s_queueLock.lock();
+	s_queues[priority].push_back(entry);
+	s_queueLock.unlock();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts the frame's budget over, keeping what the last frame spent for the debug display
+//
+void MainThreadScheduler::BeginFrame()
+{
+	s_lastFrameSeconds = s_frameSecondsSpent;
+	s_frameSecondsSpent = 0.f;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Runs tasks in priority order while their estimates fit in what's left of the budget, measuring each
+// Runs at least one a frame even if the budget was already spent, so nothing waits forever
+//
+void MainThreadScheduler::Update()
+{
+	PROFILE_SCOPE_CATEGORY("MainThreadScheduler::Update", "Core");
+
+	bool ranAny = false;
+	MainThreadTask_t task;
+
+	while (PopNextTask(task, GetRemainingFrameSeconds(), !ranAny))
+	{
+		uint64_t startHPC = GetPerformanceCounter();
+		task.task();
+		ChargeFrameSeconds((float) TimeSystem::PerformanceCountToSeconds(GetPerformanceCounter() - startHPC));
+
+		ranAny = true;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Runs every queued task, including any queued by the tasks themselves
+//
+void MainThreadScheduler::RunAllTasks()
+{
+	PROFILE_SCOPE_CATEGORY("MainThreadScheduler::RunAllTasks", "Core");
+
+	MainThreadTask_t task;
+	while (PopNextTask(task, 0.f, true))
+	{
+		task.task();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the seconds left in this frame's budget, 0 once it's spent
+//
+float MainThreadScheduler::GetRemainingFrameSeconds()
+{
+	float remaining = s_frameBudgetSeconds - s_frameSecondsSpent;
+	return (remaining > 0.f ? remaining : 0.f);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Counts main thread work done elsewhere against this frame's budget
+//
+void MainThreadScheduler::ChargeFrameSeconds(float seconds)
+{
+	s_frameSecondsSpent += seconds;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of tasks waiting to run
+//
+int MainThreadScheduler::GetQueuedTaskCount()
+{
+	int count = 0;
+
+	s_queueLock.lock();
+	for (int priority = 0; priority < NUM_JOB_PRIORITIES; ++priority)
+	{
+		count += (int) s_queues[priority].size();
+	}
+	s_queueLock.unlock();
+
+	return count;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the seconds of budgeted work the last frame did
+//
+float MainThreadScheduler::GetLastFrameSeconds()
+{
+	return s_lastFrameSeconds;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the seconds of main thread work allowed each frame
+//
+void MainThreadScheduler::SetFrameBudgetSeconds(float seconds)
+{
+	s_frameBudgetSeconds = (seconds > 0.f ? seconds : 0.f);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the seconds of main thread work allowed each frame
+//
+float MainThreadScheduler::GetFrameBudgetSeconds()
+{
+	return s_frameBudgetSeconds;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Takes the oldest task of the highest priority waiting, if it fits in maxCostSeconds or the cost is ignored
+// Only the front is checked, so tasks never run out of order within a priority
+//
+bool MainThreadScheduler::PopNextTask(MainThreadTask_t& out_task, float maxCostSeconds, bool ignoreCost)
+{
+	bool found = false;
+
+	s_queueLock.lock();
+	for (int priority = 0; priority < NUM_JOB_PRIORITIES; ++priority)
+	{
+		if (s_queues[priority].size() == 0)
+		{
+			continue;
+		}
+
+		MainThreadTask_t& front = s_queues[priority].front();
+
+		// Out of budget at the highest priority waiting, so lower ones don't get to jump ahead of it
+		if (ignoreCost || (maxCostSeconds > 0.f && front.costSeconds <= maxCostSeconds))
+		{
+			out_task = front;
+			s_queues[priority].pop_front();
+			found = true;
+		}
+
+		break;
+	}
+	s_queueLock.unlock();
+
+	return found;
+}
@@ -0,0 +1,75 @@
+/************************************************************************/
+/* File: MainThreadScheduler.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Time-sliced queue for work that has to run on the main
+/*				(GL) thread, like VAO creation or shader links, run a
+/*				budgeted amount a frame instead of all at once
+/************************************************************************/
+#pragma once
+#include <deque>
+#include <mutex>
+#include <functional>
+#include "Engine/Core/JobSystem/Job.hpp"
+
+// Seconds of main thread work a frame, shared by the queued tasks and the budgeted job finalizes
+#define MAIN_THREAD_DEFAULT_FRAME_BUDGET_SECONDS (0.002f)
+
+typedef std::function<void()> MainThreadTask_cb;
+
+struct MainThreadTask_t
+{
+	MainThreadTask_cb	task;
+	float				costSeconds = 0.f;		// Estimate, 0 if unknown
+};
+
+
+class MainThreadScheduler
+{
+public:
+	//-----Public Methods-----
+
+	// Queuing may be done from any thread; tasks run in order within each priority, critical first
+	static void		QueueTask(MainThreadTask_cb task, float costEstimateSeconds = 0.f, JobPriority priority = JOB_PRIORITY_NORMAL);
+
+	// Main thread only, from here down
+	// Starts the frame's budget; called by the Renderer before anything spends it
+	static void		BeginFrame();
+
+	// Runs tasks until the next one's estimate won't fit in what's left of the frame's budget, always running
+	// at least one so a backlog drains
+	static void		Update();
+
+	// Runs everything queued regardless of budget, for loading screens and shutdown
+	static void		RunAllTasks();
+
+	// For other budgeted main thread work, like JobSystem::FinalizeFinishedJobsForBudget(), to share the frame's budget
+	static float	GetRemainingFrameSeconds();
+	static void		ChargeFrameSeconds(float seconds);
+
+	static int		GetQueuedTaskCount();
+	static float	GetLastFrameSeconds();		// Spent by the last frame, tasks and charges together
+
+	static void		SetFrameBudgetSeconds(float seconds);
+	static float	GetFrameBudgetSeconds();
+
+
+private:
+	//-----Private Methods-----
+
+	MainThreadScheduler() {}
+
+	static bool		PopNextTask(MainThreadTask_t& out_task, float maxCostSeconds, bool ignoreCost);
+
+
+private:
+	//-----Private Data-----
+
+	static std::mutex					s_queueLock;
+	static std::deque<MainThreadTask_t>	s_queues[NUM_JOB_PRIORITIES];
+
+	static float						s_frameBudgetSeconds;
+	static float						s_frameSecondsSpent;
+	static float						s_lastFrameSeconds;
+
+};
@@ -0,0 +1,107 @@
+/************************************************************************/
+/* File: ParallelFor.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the parallel loop helpers
+/************************************************************************/
+#include "Engine/Core/JobSystem/JobSystem.hpp"
+#include "Engine/Core/JobSystem/FunctionJob.hpp"
+#include "Engine/Core/JobSystem/ParallelFor.hpp"
+#include <memory>
+#include <thread>
+
+// State shared between the calling thread and the helper jobs
+// Chunks are claimed dynamically off an atomic counter, so fast threads take more of the range
+// Ref counted since a helper job might only get to run after the loop has already finished
+struct ParallelForState_t
+{
+	int					begin = 0;
+	int					end = 0;
+	int					grainSize = 1;
+	int					numChunks = 0;
+	ParallelRange_cb	rangeFunction;
+
+	std::atomic<int>	nextChunkIndex{ 0 };
+	std::atomic<int>	numChunksFinished{ 0 };
+};
+
+static void ProcessChunksUntilNoneRemain(ParallelForState_t& state);
+
+
+//-----------------------------------------------------------------------------------------------
+// Claims and runs chunks until every chunk has been claimed
+//
+static void ProcessChunksUntilNoneRemain(ParallelForState_t& state)
+{
+	int chunkIndex = state.nextChunkIndex.fetch_add(1);
+
+	while (chunkIndex < state.numChunks)
+	{
+		int rangeBegin = state.begin + chunkIndex * state.grainSize;
+		int rangeEnd = rangeBegin + state.grainSize;
+
+		if (rangeEnd > state.end)
+		{
+			rangeEnd = state.end;
+		}
+
+		state.rangeFunction(rangeBegin, rangeEnd);
+		state.numChunksFinished++;
+
+		chunkIndex = state.nextChunkIndex.fetch_add(1);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Splits [begin, end) into chunks of grainSize and processes them across the workers and the
+// calling thread, returning once the whole range is done
+//
+void ParallelForRange(int begin, int end, int grainSize, const ParallelRange_cb& rangeFunction)
+{
+	if (end <= begin)
+	{
+		return;
+	}
+
+	if (grainSize < 1)
+	{
+		grainSize = 1;
+	}
+
+	int numChunks = ((end - begin) + grainSize - 1) / grainSize;
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	int numWorkers = (jobSystem != nullptr ? jobSystem->GetWorkerThreadCount() : 0);
+
+	// Not worth (or not possible) going wide
+	if (numChunks == 1 || numWorkers == 0)
+	{
+		rangeFunction(begin, end);
+		return;
+	}
+
+	std::shared_ptr<ParallelForState_t> state = std::make_shared<ParallelForState_t>();
+	state->begin = begin;
+	state->end = end;
+	state->grainSize = grainSize;
+	state->numChunks = numChunks;
+	state->rangeFunction = rangeFunction;
+
+	// One helper per worker at most, and never more helpers than there are chunks the calling thread won't take
+	int numHelpers = (numChunks - 1 < numWorkers ? numChunks - 1 : numWorkers);
+
+	// Helpers just claim chunks until they run out; pooled, and deleted on the worker when done
+	for (int helperIndex = 0; helperIndex < numHelpers; ++helperIndex)
+	{
+		jobSystem->QueueJob(new FunctionJob([state]() { ProcessChunksUntilNoneRemain(*state); }));
+	}
+
+	// Help out, then wait for the chunks other threads are still in the middle of
+	ProcessChunksUntilNoneRemain(*state);
+
+	while (state->numChunksFinished.load() < numChunks)
+	{
+		std::this_thread::yield();
+	}
+}
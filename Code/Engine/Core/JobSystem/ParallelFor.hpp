@@ -0,0 +1,76 @@
+/************************************************************************/
+/* File: ParallelFor.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Data-parallel loop helpers built on the JobSystem
+/************************************************************************/
+#pragma once
+#include <vector>
+#include <functional>
+
+// Signature for a callback that processes the indices [rangeBegin, rangeEnd)
+typedef std::function<void(int rangeBegin, int rangeEnd)> ParallelRange_cb;
+
+
+//-----------------------------------------------------------------------------------------------
+// Splits [begin, end) into chunks of grainSize indices and runs rangeFunction on each chunk,
+// spread across the worker threads with the calling thread helping
+// Returns once every chunk has been processed
+// Falls back to running inline if there's no JobSystem or only one chunk
+//
+void ParallelForRange(int begin, int end, int grainSize, const ParallelRange_cb& rangeFunction);
+
+
+//-----------------------------------------------------------------------------------------------
+// Calls function(index) for every index in [begin, end), in parallel
+// Order of calls is not defined, so function must be safe to call concurrently on distinct indices
+//
+template <typename FUNCTION>
+void ParallelFor(int begin, int end, int grainSize, FUNCTION function)
+{
+	ParallelForRange(begin, end, grainSize, [&function](int rangeBegin, int rangeEnd)
+	{
+		for (int index = rangeBegin; index < rangeEnd; ++index)
+		{
+			function(index);
+		}
+	});
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reduces [begin, end) in parallel
+// rangeFunction(rangeBegin, rangeEnd, identity) returns the partial result for one chunk, and
+// combine(a, b) merges two partial results; partials are combined in index order on the calling
+// thread, so combine only needs to be associative, not commutative
+//
+template <typename T, typename RANGE_FUNCTION, typename COMBINE_FUNCTION>
+T ParallelReduce(int begin, int end, int grainSize, const T& identity, RANGE_FUNCTION rangeFunction, COMBINE_FUNCTION combine)
+{
+	if (end <= begin)
+	{
+		return identity;
+	}
+
+	if (grainSize < 1)
+	{
+		grainSize = 1;
+	}
+
+	int numChunks = ((end - begin) + grainSize - 1) / grainSize;
+	std::vector<T> partialResults(numChunks, identity);
+
+	ParallelForRange(begin, end, grainSize, [&](int rangeBegin, int rangeEnd)
+	{
+		int chunkIndex = (rangeBegin - begin) / grainSize;
+		partialResults[chunkIndex] = rangeFunction(rangeBegin, rangeEnd, identity);
+	});
+
+	T result = identity;
+	for (int chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex)
+	{
+		result = combine(result, partialResults[chunkIndex]);
+	}
+
+	return result;
+}
@@ -0,0 +1,66 @@
+/************************************************************************/
+/* File: WorkStealingQueue.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the WorkStealingQueue class
+/************************************************************************/
+#include "Engine/Core/JobSystem/WorkStealingQueue.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the job to the back of the queue
+//
+void WorkStealingQueue::PushBack(Job* job)
+{
+	m_lock.lock();
+	m_jobs[job->GetPriority()].push_back(job);
+	m_lock.unlock();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of jobs currently in the queue
+//
+int WorkStealingQueue::GetCount()
+{
+	int count = 0;
+
+	m_lock.lock();
+	for (int priority = 0; priority < NUM_JOB_PRIORITIES; ++priority)
+	{
+		count += (int)m_jobs[priority].size();
+	}
+	m_lock.unlock();
+
+	return count;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of jobs of the given priority currently in the queue
+//
+int WorkStealingQueue::GetCount(JobPriority priority)
+{
+	m_lock.lock();
+	int count = (int)m_jobs[priority].size();
+	m_lock.unlock();
+
+	return count;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Empties this queue into the given list, highest priority first, preserving order within a priority
+//
+void WorkStealingQueue::MoveAllJobsTo(std::deque<Job*>& out_jobs)
+{
+	m_lock.lock();
+	{
+		for (int priority = 0; priority < NUM_JOB_PRIORITIES; ++priority)
+		{
+			out_jobs.insert(out_jobs.end(), m_jobs[priority].begin(), m_jobs[priority].end());
+			m_jobs[priority].clear();
+		}
+	}
+	m_lock.unlock();
+}
@@ -0,0 +1,39 @@
+/************************************************************************/
+/* File: WorkStealingQueue.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Per-worker double ended job queue; the owning worker pushes
+/*				and pops from the back, other workers steal from the front
+/************************************************************************/
+#pragma once
+#include <deque>
+#include <mutex>
+#include "Engine/Core/JobSystem/Job.hpp"
+
+class WorkStealingQueue
+{
+	friend class JobSystem;
+
+public:
+	//-----Public Methods-----
+
+	WorkStealingQueue() {}
+	~WorkStealingQueue() {}
+
+	// Popping is done by the JobSystem, which marks the job as running once it has it
+	// Owner pops from the back (LIFO, keeps recently pushed work hot in cache), thieves take the front
+	// Each priority has its own deque, so higher priorities can be drained first
+	void	PushBack(Job* job);
+
+	int		GetCount();
+	int		GetCount(JobPriority priority);
+	void	MoveAllJobsTo(std::deque<Job*>& out_jobs);
+
+
+private:
+	//-----Private Data-----
+
+	std::mutex			m_lock;
+	std::deque<Job*>	m_jobs[NUM_JOB_PRIORITIES];
+
+};
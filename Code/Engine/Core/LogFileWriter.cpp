@@ -0,0 +1,412 @@
+/************************************************************************/
+/* File: LogFileWriter.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the LogFileWriter class
+/************************************************************************/
+#include <new>
+#include <stdio.h>
+#include <string.h>
+#include "Engine/Core/File.hpp"
+#include "Engine/Core/Time/Time.hpp"
+#include "Engine/Core/LogFileWriter.hpp"
+#include "Engine/Core/Utility/Compression.hpp"
+#include "Engine/Core/JobSystem/FunctionJob.hpp"
+
+// Compressed segment header, followed by blocks of [raw size][compressed size][data], compressed size 0 meaning stored raw
+static const uint32_t LOG_SEGMENT_MAGIC = 0x474C5A4C;	// "LZLG"
+static const uint32_t LOG_SEGMENT_VERSION = 1;
+
+static bool CompressSegment(const std::string& sourcePath, const std::string& destinationPath);
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+LogFileWriter::LogFileWriter(const LogFileWriterOptions_t& options /*= LogFileWriterOptions_t()*/)
+	: m_options(options)
+{
+	m_bufferCapacity = ((options.bufferBytes + LOG_WRITER_BLOCK_BYTES - 1) / LOG_WRITER_BLOCK_BYTES) * LOG_WRITER_BLOCK_BYTES;
+	if (m_bufferCapacity == 0)
+	{
+		m_bufferCapacity = LOG_WRITER_BLOCK_BYTES;
+	}
+
+	m_buffer = new (std::align_val_t(LOG_WRITER_BLOCK_BYTES)) uint8_t[m_bufferCapacity];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+LogFileWriter::~LogFileWriter()
+{
+	Close();
+
+	operator delete[](m_buffer, std::align_val_t(LOG_WRITER_BLOCK_BYTES));
+	m_buffer = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Opens the file for writing, truncating it
+//
+bool LogFileWriter::Open(const std::string& filepath)
+{
+	Close();
+
+	m_file = new File();
+	if (!m_file->Open(filepath.c_str(), "w+"))
+	{
+		delete m_file;
+		m_file = nullptr;
+		return false;
+	}
+
+	m_filePath = filepath;
+	m_segmentBytes = 0;
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes out anything buffered and closes the file
+//
+void LogFileWriter::Close()
+{
+	if (m_file == nullptr)
+	{
+		return;
+	}
+
+	WriteBufferToFile();
+
+	m_file->Close();
+	delete m_file;
+	m_file = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the writer has a file open
+//
+bool LogFileWriter::IsOpen() const
+{
+	return (m_file != nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Appends the text to the buffer, writing the buffer out each time it fills
+// Rotation is only checked between writes, so a line never straddles two segments
+//
+void LogFileWriter::Write(const char* text, size_t length)
+{
+	if (m_file == nullptr || length == 0)
+	{
+		return;
+	}
+
+	if (m_bufferedBytes == 0)
+	{
+		m_firstBufferedHPC = GetPerformanceCounter();
+	}
+
+	m_segmentBytes += length;
+
+	while (length > 0)
+	{
+		size_t spaceLeft = m_bufferCapacity - m_bufferedBytes;
+		size_t amountToCopy = (length < spaceLeft ? length : spaceLeft);
+
+		memcpy(m_buffer + m_bufferedBytes, text, amountToCopy);
+		m_bufferedBytes += amountToCopy;
+		text += amountToCopy;
+		length -= amountToCopy;
+
+		if (m_bufferedBytes == m_bufferCapacity)
+		{
+			WriteBufferToFile();
+			m_firstBufferedHPC = GetPerformanceCounter();
+		}
+	}
+
+	if (m_options.maxSegmentBytes > 0 && m_segmentBytes >= m_options.maxSegmentBytes)
+	{
+		RotateSegment();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes out the buffer and flushes the file to disk
+//
+void LogFileWriter::Flush()
+{
+	if (m_file == nullptr)
+	{
+		return;
+	}
+
+	WriteBufferToFile();
+	m_file->Flush();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Flushes if the oldest buffered text has waited longer than the flush interval
+//
+void LogFileWriter::FlushIfStale()
+{
+	if (m_bufferedBytes == 0)
+	{
+		return;
+	}
+
+	double secondsWaited = TimeSystem::PerformanceCountToSeconds(GetPerformanceCounter() - m_firstBufferedHPC);
+	if (secondsWaited >= m_options.flushIntervalSeconds)
+	{
+		Flush();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the path of the file currently being written
+//
+const std::string& LogFileWriter::GetFilePath() const
+{
+	return m_filePath;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of segments rotated out since the file was opened
+//
+int LogFileWriter::GetRotatedSegmentCount() const
+{
+	return m_rotatedSegmentCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the path the segment is renamed to when rotated out, before any compression
+//
+std::string LogFileWriter::GetSegmentPath(int segmentNumber) const
+{
+	size_t extensionStart = m_filePath.find_last_of('.');
+	size_t directoryEnd = m_filePath.find_last_of("/\\");
+
+	char segmentSuffix[16];
+	snprintf(segmentSuffix, sizeof(segmentSuffix), "_%03i", segmentNumber);
+
+	if (extensionStart == std::string::npos || (directoryEnd != std::string::npos && extensionStart < directoryEnd))
+	{
+		return m_filePath + segmentSuffix;
+	}
+
+	return m_filePath.substr(0, extensionStart) + segmentSuffix + m_filePath.substr(extensionStart);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Decompresses a segment made with compressRotatedSegments back into a text file
+//
+bool LogFileWriter::DecompressSegment(const std::string& sourcePath, const std::string& destinationPath)
+{
+	File source;
+	if (!source.Open(sourcePath.c_str(), "rb"))
+	{
+		return false;
+	}
+
+	uint32_t header[2];
+	if (source.Read(header, sizeof(header)) != sizeof(header) || header[0] != LOG_SEGMENT_MAGIC || header[1] != LOG_SEGMENT_VERSION)
+	{
+		return false;
+	}
+
+	File destination;
+	if (!destination.Open(destinationPath.c_str(), "wb"))
+	{
+		return false;
+	}
+
+	uint8_t* packedBlock = new uint8_t[LOG_SEGMENT_COMPRESSED_BLOCK_BYTES];
+	uint8_t* rawBlock = new uint8_t[LOG_SEGMENT_COMPRESSED_BLOCK_BYTES];
+	bool succeeded = true;
+
+	uint32_t blockSizes[2];
+	while (source.Read(blockSizes, sizeof(blockSizes)) == sizeof(blockSizes))
+	{
+		uint32_t rawSize = blockSizes[0];
+		uint32_t packedSize = blockSizes[1];
+
+		if (rawSize > LOG_SEGMENT_COMPRESSED_BLOCK_BYTES || packedSize > LOG_SEGMENT_COMPRESSED_BLOCK_BYTES)
+		{
+			succeeded = false;
+			break;
+		}
+
+		if (packedSize == 0)
+		{
+			succeeded = (source.Read(rawBlock, rawSize) == rawSize);
+		}
+		else
+		{
+			succeeded = (source.Read(packedBlock, packedSize) == packedSize) && LZDecompress(packedBlock, packedSize, rawBlock, rawSize);
+		}
+
+		if (!succeeded)
+		{
+			break;
+		}
+
+		destination.Write(rawBlock, rawSize);
+	}
+
+	delete[] packedBlock;
+	delete[] rawBlock;
+
+	destination.Close();
+	return succeeded;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes everything in the buffer to the file
+// Only partial buffers from flushes are written in sizes that aren't whole blocks
+//
+void LogFileWriter::WriteBufferToFile()
+{
+	if (m_bufferedBytes == 0)
+	{
+		return;
+	}
+
+	m_file->Write(m_buffer, m_bufferedBytes);
+	m_bufferedBytes = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Closes the current segment and renames it aside, then starts a new one at the file's path
+// The closed segment is compressed on a background disk job, if enabled
+//
+void LogFileWriter::RotateSegment()
+{
+	Flush();
+	m_file->Close();
+
+	std::string segmentPath = GetSegmentPath(m_rotatedSegmentCount + 1);
+
+	// Segments left by an earlier run of the same file are replaced
+	remove(segmentPath.c_str());
+	remove((segmentPath + LOG_SEGMENT_COMPRESSED_EXTENSION).c_str());
+
+	// If it can't be renamed keep appending to it, trying again once another segment's worth is written
+	bool wasRenamed = (rename(m_filePath.c_str(), segmentPath.c_str()) == 0);
+	bool wasReopened = m_file->Open(m_filePath.c_str(), (wasRenamed ? "w+" : "a+"));
+	m_segmentBytes = 0;
+
+	if (!wasReopened)
+	{
+		delete m_file;
+		m_file = nullptr;
+	}
+
+	if (!wasRenamed)
+	{
+		return;
+	}
+
+	m_rotatedSegmentCount++;
+
+	if (!m_options.compressRotatedSegments)
+	{
+		return;
+	}
+
+	std::string* rawSegmentPath = new std::string(segmentPath);
+
+	auto compress = [rawSegmentPath]()
+	{
+		if (CompressSegment(*rawSegmentPath, *rawSegmentPath + LOG_SEGMENT_COMPRESSED_EXTENSION))
+		{
+			remove(rawSegmentPath->c_str());
+		}
+
+		delete rawSegmentPath;
+	};
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+
+	if (jobSystem != nullptr)
+	{
+		jobSystem->QueueJob(new FunctionJob(compress, JOB_PRIORITY_BACKGROUND, WORKER_FLAGS_DISK));
+	}
+	else
+	{
+		compress();
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Compresses the file into a segment of LZ blocks, removing the partial output if anything fails
+//
+static bool CompressSegment(const std::string& sourcePath, const std::string& destinationPath)
+{
+	File source;
+	if (!source.Open(sourcePath.c_str(), "rb"))
+	{
+		return false;
+	}
+
+	File destination;
+	if (!destination.Open(destinationPath.c_str(), "wb"))
+	{
+		return false;
+	}
+
+	uint32_t header[2] = { LOG_SEGMENT_MAGIC, LOG_SEGMENT_VERSION };
+	destination.Write((uint8_t*) header, sizeof(header));
+
+	uint8_t* rawBlock = new uint8_t[LOG_SEGMENT_COMPRESSED_BLOCK_BYTES];
+	uint8_t* packedBlock = new uint8_t[LOG_SEGMENT_COMPRESSED_BLOCK_BYTES];
+
+	size_t rawSize = source.Read(rawBlock, LOG_SEGMENT_COMPRESSED_BLOCK_BYTES);
+	while (rawSize > 0)
+	{
+		// Blocks that don't shrink are stored as is
+		size_t packedSize = LZCompress(rawBlock, rawSize, packedBlock, rawSize - 1);
+
+		uint32_t blockSizes[2] = { (uint32_t) rawSize, (uint32_t) packedSize };
+		destination.Write((uint8_t*) blockSizes, sizeof(blockSizes));
+
+		if (packedSize > 0)
+		{
+			destination.Write(packedBlock, packedSize);
+		}
+		else
+		{
+			destination.Write(rawBlock, rawSize);
+		}
+
+		rawSize = source.Read(rawBlock, LOG_SEGMENT_COMPRESSED_BLOCK_BYTES);
+	}
+
+	delete[] rawBlock;
+	delete[] packedBlock;
+
+	bool succeeded = source.IsAtEndOfFile();
+	destination.Close();
+
+	if (!succeeded)
+	{
+		remove(destinationPath.c_str());
+	}
+
+	return succeeded;
+}
@@ -0,0 +1,84 @@
+/************************************************************************/
+/* File: LogFileWriter.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Buffered log file that writes in large aligned blocks,
+/*				rotating into numbered segments once it gets too big
+/*				and optionally compressing them on a background job
+/************************************************************************/
+#pragma once
+#include <string>
+#include <stdint.h>
+#include <stddef.h>
+
+class File;
+
+// Writes are whole multiples of this, from a buffer aligned to it, so the file is written a page at a time
+#define LOG_WRITER_BLOCK_BYTES (4096)
+
+// Compressed segments are a header, then blocks of up to this many bytes compressed with LZCompress()
+#define LOG_SEGMENT_COMPRESSED_BLOCK_BYTES (65536)
+#define LOG_SEGMENT_COMPRESSED_EXTENSION ".lz"
+
+struct LogFileWriterOptions_t
+{
+	size_t	bufferBytes = 256 * 1024;				// Rounded up to LOG_WRITER_BLOCK_BYTES
+	double	flushIntervalSeconds = 1.0;				// Longest buffered text waits to be written, for FlushIfStale()
+	size_t	maxSegmentBytes = 64 * 1024 * 1024;		// 0 never rotates
+	bool	compressRotatedSegments = false;
+};
+
+
+class LogFileWriter
+{
+public:
+	//-----Public Methods-----
+
+	explicit LogFileWriter(const LogFileWriterOptions_t& options = LogFileWriterOptions_t());
+	~LogFileWriter();
+
+	// Truncates the file; Close() writes out whatever is buffered
+	bool				Open(const std::string& filepath);
+	void				Close();
+	bool				IsOpen() const;
+
+	// Not thread safe - meant to be used by the log thread alone
+	void				Write(const char* text, size_t length);
+	void				Flush();			// Writes the buffer and flushes the file to disk
+	void				FlushIfStale();		// Flushes if buffered text has waited longer than the flush interval
+
+	const std::string&	GetFilePath() const;
+	int					GetRotatedSegmentCount() const;
+
+	// Rotated segments are named <file>_<n>.<extension>, with LOG_SEGMENT_COMPRESSED_EXTENSION appended when compressed
+	std::string			GetSegmentPath(int segmentNumber) const;
+
+	// For reading compressed segments back, returns false if the source is missing or malformed
+	static bool			DecompressSegment(const std::string& sourcePath, const std::string& destinationPath);
+
+
+private:
+	//-----Private Methods-----
+
+	LogFileWriter(const LogFileWriter& copy) = delete;
+
+	void				WriteBufferToFile();
+	void				RotateSegment();
+
+
+private:
+	//-----Private Data-----
+
+	LogFileWriterOptions_t	m_options;
+	std::string				m_filePath;
+	File*					m_file = nullptr;
+
+	uint8_t*				m_buffer = nullptr;
+	size_t					m_bufferCapacity = 0;
+	size_t					m_bufferedBytes = 0;
+	uint64_t				m_firstBufferedHPC = 0;		// When the oldest buffered text was written
+
+	size_t					m_segmentBytes = 0;			// Written to the current segment, including what's buffered
+	int						m_rotatedSegmentCount = 0;
+
+};
@@ -5,6 +5,9 @@
 /* Description: Implementation of the LogSystem class
 /************************************************************************/
 #include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
 #include <iostream>
 #include "Engine/Core/File.hpp"
 #include "Engine/Core/LogSystem.hpp"
@@ -27,18 +30,76 @@ TODO("Make this singleton");
 // For LogPrintf, ensuring we don't copy anything too large
 const int STRINGF_STACK_LOCAL_TEMP_LENGTH = 2048;
 
+// Records processed under one hold of the callback lock
+const int LOG_PROCESS_BATCH_SIZE = 64;
+
+// Longest the log thread sleeps without being signaled, in case a wake was missed
+const unsigned int LOG_THREAD_MAX_WAIT_MS = 100;
+
+// Longest single conversion specification captured, from the '%' to the conversion character
+const int LOG_MAX_CONVERSION_LENGTH = 32;
+const int LOG_TAG_CACHE_SIZE = 16;	// Per thread, direct mapped by tag pointer
+
+static_assert((LOG_RECORD_COUNT & (LOG_RECORD_COUNT - 1)) == 0, "LOG_RECORD_COUNT must be a power of two");
+
 // Static members
 bool											LogSystem::s_isRunning = true;
-File*											LogSystem::s_logFile = nullptr;
-File*											LogSystem::s_timeStampFile = nullptr;
+LogFileWriter*									LogSystem::s_logFileWriter = nullptr;
+LogFileWriter*									LogSystem::s_timeStampFileWriter = nullptr;
+std::atomic<uint32_t>							LogSystem::s_flushRequestCount{ 0 };
+std::atomic<uint32_t>							LogSystem::s_flushCompletedCount{ 0 };
 const char*										LogSystem::LOG_FILE_NAME_FORMAT = "Data/Logs/SystemLog_%s.log";
 ThreadHandle_t									LogSystem::s_logThread = nullptr;
-std::shared_mutex								LogSystem::s_callbackLock;
-ThreadSafeQueue<LogMessage_t>					LogSystem::s_logQueue;
-std::map<std::string, LogFilteredCallback_t>	LogSystem::s_callbacks;
+std::mutex										LogSystem::s_callbackWriteLock;
+std::atomic<LogCallbackList_t*>					LogSystem::s_callbackList{ nullptr };
+std::vector<LogCallbackList_t*>					LogSystem::s_retiredCallbackLists;
+std::atomic<bool>								LogSystem::s_hasRetiredCallbackLists{ false };
+std::mutex										LogSystem::s_tagLock;
+ConcurrentHashMap<StringID, int>				LogSystem::s_tagIDs;
+std::string										LogSystem::s_tagNames[LOG_MAX_TAG_COUNT];
+int												LogSystem::s_tagCount = 0;
+LogRecordSlot_t*								LogSystem::s_records = nullptr;
+alignas(64) std::atomic<size_t>					LogSystem::s_enqueuePosition{ 0 };
+alignas(64) std::atomic<size_t>					LogSystem::s_dequeuePosition{ 0 };
+Semaphore										LogSystem::s_logSignal;
+std::atomic<bool>								LogSystem::s_isLogThreadWaiting{ false };
+
+// Types of the arguments captured into a record, each stored as a type byte then the value
+enum eLogArgumentType : uint8_t
+{
+	LOG_ARGUMENT_NONE,			// "%%", no argument
+	LOG_ARGUMENT_INT,
+	LOG_ARGUMENT_LONG,
+	LOG_ARGUMENT_LONG_LONG,
+	LOG_ARGUMENT_SIZE,
+	LOG_ARGUMENT_INTMAX,
+	LOG_ARGUMENT_PTRDIFF,
+	LOG_ARGUMENT_DOUBLE,
+	LOG_ARGUMENT_LONG_DOUBLE,
+	LOG_ARGUMENT_POINTER,
+	LOG_ARGUMENT_STRING,		// Stored as a uint16_t length, then the characters and a terminator
+	LOG_ARGUMENT_UNSUPPORTED	// Wide characters, %n, or anything not recognized - formatted when logged instead
+};
+
+// One conversion specification of a format string
+struct LogConversion_t
+{
+	int					length = 0;		// Characters from the '%' through the conversion character
+	int					starCount = 0;	// '*' widths and precisions, each taking an int argument before the value
+	eLogArgumentType	type = LOG_ARGUMENT_UNSUPPORTED;
+};
+
+// Record capturing and formatting
+static bool ParseLogConversion(const char* conversionStart, LogConversion_t& out_conversion);
+static bool CaptureLogArguments(LogRecord_t& record, const char* format, va_list args);
+static void FormatLogRecord(const LogRecord_t& record, LogMessage_t& out_message);
+static uint16_t GetCachedTagID(const char* tag);
+
+// Set on the log thread, so FlushLog() knows not to wait on itself
+static thread_local bool s_isLogThread = false;
 
 // Callback for writing the log to the system file
-static void WriteToFile(LogMessage_t log, void* fileptr);
+static void WriteToFile(LogMessage_t log, void* writerptr);
 static void WriteToDebugOutput(LogMessage_t log, void* fileptr);
 static void Command_ShowAllTags(Command& cmd);
 static void Command_HideAllTags(Command& cmd);
@@ -47,44 +108,46 @@ static void Command_HideAllTags(Command& cmd);
 //-----------------------------------------------------------------------------------------------
 // Initializes the system
 //
-void LogSystem::Initialize()
+// Files are buffered and rotated as fileOptions says, written out by the log thread
+//
+void LogSystem::Initialize(const LogFileWriterOptions_t& fileOptions /*= LogFileWriterOptions_t()*/)
 {
 	// Ensure the directory we need for the files exists
 	CreateDirectoryA("Data/Logs", NULL);
 
-	// Make the file objects
-	s_logFile = new File();
+	// Make the file writers
+	s_logFileWriter = new LogFileWriter(fileOptions);
 
 	// Get the paths, and open the files
 	std::string logFileName = Stringf(LOG_FILE_NAME_FORMAT, "HOST");
-	bool success = s_logFile->Open(logFileName.c_str(), "w+");
+	bool success = s_logFileWriter->Open(logFileName);
 
 	int count = 0;
 	while (!success)
 	{
 		count++;
 		logFileName = Stringf(LOG_FILE_NAME_FORMAT, Stringf("%s_%i", "CLIENT", count).c_str());
-		success = s_logFile->Open(logFileName.c_str(), "w+");
+		success = s_logFileWriter->Open(logFileName);
 	}
 
 	// Make a file writer for the latest log file
 	LogCallBack_t writerCallback;
 	writerCallback.callback = WriteToFile;
 	writerCallback.name = "Log File Writer";
-	writerCallback.argumentData = s_logFile;
+	writerCallback.argumentData = s_logFileWriter;
 	AddCallback(writerCallback);
 
 
 	// Also open a time stamp file for record keeping
-	s_timeStampFile = new File();
+	s_timeStampFileWriter = new LogFileWriter(fileOptions);
 	std::string timeStampName = Stringf(LOG_FILE_NAME_FORMAT, GetFormattedSystemDateAndTime().c_str());
 
-	success = s_timeStampFile->Open(timeStampName.c_str(), "w+");
+	success = s_timeStampFileWriter->Open(timeStampName);
 
 	if (success)
 	{
 		writerCallback.name = "Time Stamped File Writer";
-		writerCallback.argumentData = s_timeStampFile;
+		writerCallback.argumentData = s_timeStampFileWriter;
 		AddCallback(writerCallback);
 	}
 
@@ -98,6 +161,13 @@ void LogSystem::Initialize()
 	SetCallbackToBlackList("Debug Output", false);
 	AddCallbackFilter("Debug Output", "DEBUG");
 
+	// Make the ring before the log thread starts reading it
+	s_records = new LogRecordSlot_t[LOG_RECORD_COUNT];
+	for (size_t slotIndex = 0; slotIndex < LOG_RECORD_COUNT; ++slotIndex)
+	{
+		s_records[slotIndex].sequence.store(slotIndex, std::memory_order_relaxed);
+	}
+
 	s_logThread = Thread::Create(&ProcessLog, nullptr);
 	s_isRunning = true;
 
@@ -113,23 +183,36 @@ void LogSystem::Shutdown()
 {
 	s_isRunning = false;
 
-	// Flush the rest of the log
+	// Wake the log thread so it flushes the rest of the log and exits
+	s_logSignal.Release();
 	Thread::Join(s_logThread);
 	s_logThread = nullptr;
 
-	if (s_logFile != nullptr)
-	{
-		s_logFile->Close();
-		delete s_logFile;
-		s_logFile = nullptr;
-	}
+	// Logs made from here on are dropped
+	delete[] s_records;
+	s_records = nullptr;
+
+	// Callbacks added from here on are never called, but still freed here
+	s_callbackWriteLock.lock();
 
-	if (s_timeStampFile != nullptr)
+	delete s_callbackList.exchange(nullptr);
+
+	for (LogCallbackList_t* retiredList : s_retiredCallbackLists)
 	{
-		s_timeStampFile->Close();
-		delete s_timeStampFile;
-		s_timeStampFile = nullptr;
+		delete retiredList;
 	}
+
+	s_retiredCallbackLists.clear();
+	s_hasRetiredCallbackLists.store(false);
+
+	s_callbackWriteLock.unlock();
+
+	// Closing writes out what's still buffered
+	delete s_logFileWriter;
+	s_logFileWriter = nullptr;
+
+	delete s_timeStampFileWriter;
+	s_timeStampFileWriter = nullptr;
 }
 
 
@@ -143,22 +226,100 @@ bool LogSystem::IsRunning()
 
 
 //-----------------------------------------------------------------------------------------------
-// Adds the given log message to the LogSystem
+// Adds the given log message to the LogSystem, already formatted
+// Text past what fits in a record is cut off
 //
 void LogSystem::AddLog(LogMessage_t message)
 {
-	s_logQueue.Enqueue(message);
+	if (s_records == nullptr)
+	{
+		return;
+	}
+
+	size_t position;
+	LogRecordSlot_t* slot = ClaimRecord(position);
+	LogRecord_t& record = slot->record;
+
+	// Callbacks run later on the log thread, so this is the only place the time it happened is known
+	record.hpc = (message.hpc != 0 ? message.hpc : GetPerformanceCounter());
+	record.tagID = (uint16_t) GetTagID(message.tag.c_str());
+
+	size_t textLength = message.message.size();
+	if (textLength > LOG_RECORD_PAYLOAD_BYTES - 1)
+	{
+		textLength = LOG_RECORD_PAYLOAD_BYTES - 1;
+	}
+
+	memcpy(record.payload, message.message.c_str(), textLength);
+	record.payload[textLength] = '\0';
+	record.payloadBytes = (uint16_t) textLength;
+	record.isFormatted = true;
+
+	CommitRecord(slot, position);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a log to be formatted on the log thread, copying the format and its arguments into a record
+// Strings are copied, so they don't need to outlive the call; formats with arguments that can't be
+// captured, or that don't fit in a record, are formatted here instead
+//
+void LogSystem::AddLogv(const char* tag, const char* format, va_list args)
+{
+	if (s_records == nullptr)
+	{
+		return;
+	}
+
+	size_t position;
+	LogRecordSlot_t* slot = ClaimRecord(position);
+	LogRecord_t& record = slot->record;
+
+	record.hpc = GetPerformanceCounter();
+	record.tagID = GetCachedTagID(tag);
+
+	// Captured from a copy, since the arguments are read again if they can't be
+	va_list captureArgs;
+	va_copy(captureArgs, args);
+	bool wasCaptured = CaptureLogArguments(record, format, captureArgs);
+	va_end(captureArgs);
+
+	if (!wasCaptured)
+	{
+		char* text = (char*) record.payload;
+		vsnprintf_s(text, LOG_RECORD_PAYLOAD_BYTES, _TRUNCATE, format, args);
+		text[LOG_RECORD_PAYLOAD_BYTES - 1] = '\0'; // In case vsnprintf overran (doesn't auto-terminate)
+
+		record.payloadBytes = (uint16_t) strlen(text);
+		record.isFormatted = true;
+	}
+
+	CommitRecord(slot, position);
 }
 
 
 //-----------------------------------------------------------------------------------------------
 // Adds the callback hook to the list of callbacks to call when a message is processed
+// Replaces the hook of the same name if there is one, keeping its filters
 //
 void LogSystem::AddCallback(LogCallBack_t callback)
 {
-	s_callbackLock.lock();
-	s_callbacks[callback.name].logCallback = callback;
-	s_callbackLock.unlock();
+	s_callbackWriteLock.lock();
+
+	LogCallbackList_t* callbackList = CopyCallbackList();
+	LogFilteredCallback_t* existing = FindCallback(callbackList, callback.name);
+
+	if (existing != nullptr)
+	{
+		existing->logCallback = callback;
+	}
+	else
+	{
+		callbackList->callbacks.push_back(LogFilteredCallback_t(callback));
+	}
+
+	PublishCallbackList(callbackList);
+	s_callbackWriteLock.unlock();
 }
 
 
@@ -177,13 +338,33 @@ void LogSystem::AddCallback(const char* name, Log_cb callback, void* argumentDat
 //
 void LogSystem::FlushLog()
 {
-	while (!s_logQueue.IsEmpty())
+	// The writers belong to the log thread, so it's asked to process everything logged so far and flush them
+	if (s_logThread != nullptr && !s_isLogThread)
 	{
-		// Spin wait
+		uint32_t requestNumber = s_flushRequestCount.fetch_add(1) + 1;
+		s_logSignal.Release();
+
+		// Shutdown() flushes everything once the thread stops, so there's no waiting past that
+		while ((int32_t) (s_flushCompletedCount.load(std::memory_order_acquire) - requestNumber) < 0 && IsRunning())
+		{
+			Thread::YieldThisThread();
+		}
+
+		return;
+	}
+
+	// Called from the log thread itself, or with it not running
+	ProcessAllLogsInQueue();
+
+	if (s_logFileWriter != nullptr)
+	{
+		s_logFileWriter->Flush();
+	}
+
+	if (s_timeStampFileWriter != nullptr)
+	{
+		s_timeStampFileWriter->Flush();
 	}
-	
-	// Flush the files
-	s_logFile->Flush();
 }
 
 
@@ -192,20 +373,24 @@ void LogSystem::FlushLog()
 //
 void LogSystem::AddCallbackFilter(const std::string& callbackName, const std::string& filter)
 {
-	s_callbackLock.lock();
+	int tagID = GetTagID(filter.c_str());
 
-	std::map<std::string, LogFilteredCallback_t>::iterator itr = s_callbacks.find(callbackName);
+	s_callbackWriteLock.lock();
 
-	if (itr != s_callbacks.end())
-	{
-		itr->second.filters.InsertUnique(filter);
-	}
-	else
+	LogCallbackList_t* callbackList = CopyCallbackList();
+	LogFilteredCallback_t* callback = FindCallback(callbackList, callbackName);
+
+	if (callback == nullptr)
 	{
+		delete callbackList;
+		s_callbackWriteLock.unlock();
 		ERROR_AND_DIE(Stringf("Error: LogSystem::AddCallbackFilter received callback name that doesn't exist, name was \"%s\"", callbackName.c_str()));
 	}
 
-	s_callbackLock.unlock();
+	callback->filters.set(tagID);
+
+	PublishCallbackList(callbackList);
+	s_callbackWriteLock.unlock();
 }
 
 
@@ -214,20 +399,24 @@ void LogSystem::AddCallbackFilter(const std::string& callbackName, const std::st
 //
 void LogSystem::RemoveCallBackFilter(const std::string& callbackName, const std::string& filter)
 {
-	s_callbackLock.lock();
+	int tagID = GetTagID(filter.c_str());
 
-	std::map<std::string, LogFilteredCallback_t>::iterator itr = s_callbacks.find(callbackName);
+	s_callbackWriteLock.lock();
 
-	if (itr != s_callbacks.end())
-	{
-		itr->second.filters.Remove(filter);
-	}
-	else
+	LogCallbackList_t* callbackList = CopyCallbackList();
+	LogFilteredCallback_t* callback = FindCallback(callbackList, callbackName);
+
+	if (callback == nullptr)
 	{
+		delete callbackList;
+		s_callbackWriteLock.unlock();
 		ERROR_AND_DIE(Stringf("Error: LogSystem::RemoveCallbackFilter received callback name that doesn't exist, name was \"%s\"", callbackName.c_str()));
 	}
 
-	s_callbackLock.unlock();
+	callback->filters.reset(tagID);
+
+	PublishCallbackList(callbackList);
+	s_callbackWriteLock.unlock();
 }
 
 
@@ -236,21 +425,23 @@ void LogSystem::RemoveCallBackFilter(const std::string& callbackName, const std:
 //
 void LogSystem::SetCallbackToBlackList(const std::string& callbackName, bool isBlackList)
 {
-	s_callbackLock.lock();
+	s_callbackWriteLock.lock();
 
-	std::map<std::string, LogFilteredCallback_t>::iterator itr = s_callbacks.find(callbackName);
+	LogCallbackList_t* callbackList = CopyCallbackList();
+	LogFilteredCallback_t* callback = FindCallback(callbackList, callbackName);
 
-	if (itr != s_callbacks.end())
-	{
-		itr->second.isBlackList = isBlackList;
-		itr->second.filters.Clear();
-	}
-	else
+	if (callback == nullptr)
 	{
+		delete callbackList;
+		s_callbackWriteLock.unlock();
 		ERROR_AND_DIE(Stringf("Error: LogSystem::SetCallbackToBlackList received callback name that doesn't exist, name was \"%s\"", callbackName.c_str()));
 	}
 
-	s_callbackLock.unlock();
+	callback->isBlackList = isBlackList;
+	callback->filters.reset();
+
+	PublishCallbackList(callbackList);
+	s_callbackWriteLock.unlock();
 }
 
 
@@ -259,16 +450,18 @@ void LogSystem::SetCallbackToBlackList(const std::string& callbackName, bool isB
 //
 void LogSystem::ShowAllTags()
 {
-	s_callbackLock.lock();
-	std::map<std::string, LogFilteredCallback_t>::iterator itr = s_callbacks.begin();
+	s_callbackWriteLock.lock();
 
-	while (itr != s_callbacks.end())
+	LogCallbackList_t* callbackList = CopyCallbackList();
+
+	for (LogFilteredCallback_t& callback : callbackList->callbacks)
 	{
-		itr->second.isBlackList = true;
-		itr->second.filters.Clear();
+		callback.isBlackList = true;
+		callback.filters.reset();
 	}
 
-	s_callbackLock.unlock();
+	PublishCallbackList(callbackList);
+	s_callbackWriteLock.unlock();
 }
 
 
@@ -277,16 +470,73 @@ void LogSystem::ShowAllTags()
 //
 void LogSystem::HideAllTags()
 {
-	s_callbackLock.lock();
-	std::map<std::string, LogFilteredCallback_t>::iterator itr = s_callbacks.begin();
+	s_callbackWriteLock.lock();
+
+	LogCallbackList_t* callbackList = CopyCallbackList();
+
+	for (LogFilteredCallback_t& callback : callbackList->callbacks)
+	{
+		callback.isBlackList = false;
+		callback.filters.reset();
+	}
+
+	PublishCallbackList(callbackList);
+	s_callbackWriteLock.unlock();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the ID of the tag, interning it if it hasn't been used before
+// Once LOG_MAX_TAG_COUNT - 1 tags are interned, new tags all share the overflow ID
+// Known tags only take a shard's read lock; s_tagLock just serializes handing out new IDs
+//
+int LogSystem::GetTagID(const char* tag)
+{
+	// Hashed in place, so a log of a known tag doesn't allocate
+	StringID tagNameID = HashStringID(tag);
+	int tagID = -1;
+
+	if (s_tagIDs.Get(tagNameID, tagID))
+	{
+		return tagID;
+	}
+
+	s_tagLock.lock();
+
+	// Another thread may have interned it while this one waited
+	if (s_tagIDs.Get(tagNameID, tagID))
+	{
+		s_tagLock.unlock();
+		return tagID;
+	}
+
+	InternStringID(tag);
+	tagID = LOG_MAX_TAG_COUNT - 1;
 
-	while (itr != s_callbacks.end())
+	if (s_tagCount < LOG_MAX_TAG_COUNT - 1)
 	{
-		itr->second.isBlackList = false;
-		itr->second.filters.Clear();
+		tagID = s_tagCount++;
+		s_tagNames[tagID] = tag;
 	}
+	else if (s_tagNames[tagID].empty())
+	{
+		s_tagNames[tagID] = LOG_OVERFLOW_TAG_NAME;
+	}
+
+	s_tagIDs.Insert(tagNameID, tagID);
+	s_tagLock.unlock();
+
+	return tagID;
+}
+
 
-	s_callbackLock.unlock();
+//-----------------------------------------------------------------------------------------------
+// Returns the name of the interned tag
+// Names are set before their IDs are handed out and never change, so this doesn't lock
+//
+const std::string& LogSystem::GetTagName(int tagID)
+{
+	return s_tagNames[tagID];
 }
 
 
@@ -302,61 +552,631 @@ void LogSystem::InitializeConsoleCommands()
 
 //-----------------------------------------------------------------------------------------------
 // Log Thread
-// Constantly spins/sleeps, processing and removing messages in the queue
+// Processes the records in the ring, then sleeps until a producer signals there are more
 //
 void LogSystem::ProcessLog(void*)
 {
+	s_isLogThread = true;
+
 	while (IsRunning())
 	{
 		ProcessAllLogsInQueue();
-		Thread::SleepThisThreadFor(10); TODO("Use a semaphore here")
+		ServiceFileWriters();
+
+		// Flagged before checking the ring again, so a producer committing after the check sees the flag and signals
+		s_isLogThreadWaiting.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if (!IsNextRecordReady() && !IsFlushRequested())
+		{
+			s_logSignal.AcquireFor(LOG_THREAD_MAX_WAIT_MS);
+		}
+
+		s_isLogThreadWaiting.store(false, std::memory_order_relaxed);
 	}
 
 	// Ensure the last of the messages are processed before terminating
 	ProcessAllLogsInQueue();
+	ServiceFileWriters();
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Processes the messages in the queue, emptying it
+// Flushes the file writers if FlushLog() asked, otherwise only the ones holding text past their interval
+// The log thread wakes at least every LOG_THREAD_MAX_WAIT_MS, so that's as late as a timed flush can be
+//
+void LogSystem::ServiceFileWriters()
+{
+	uint32_t requestCount = s_flushRequestCount.load(std::memory_order_acquire);
+	bool isFlushRequested = (requestCount != s_flushCompletedCount.load(std::memory_order_relaxed));
+
+	if (isFlushRequested)
+	{
+		// Logs committed before the request may have landed after the last pass over the ring
+		ProcessAllLogsInQueue();
+	}
+
+	LogFileWriter* writers[2] = { s_logFileWriter, s_timeStampFileWriter };
+	for (LogFileWriter* writer : writers)
+	{
+		if (writer == nullptr)
+		{
+			continue;
+		}
+
+		if (isFlushRequested)
+		{
+			writer->Flush();
+		}
+		else
+		{
+			writer->FlushIfStale();
+		}
+	}
+
+	if (isFlushRequested)
+	{
+		s_flushCompletedCount.store(requestCount, std::memory_order_release);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if a FlushLog() call is waiting on the log thread
+//
+bool LogSystem::IsFlushRequested()
+{
+	return (s_flushRequestCount.load(std::memory_order_acquire) != s_flushCompletedCount.load(std::memory_order_relaxed));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Formats and processes the records in the ring, emptying it
+// Records are taken in batches, with the callback list loaded once per batch
 //
 void LogSystem::ProcessAllLogsInQueue()
 {
-	LogMessage_t message;
-	while (s_logQueue.Dequeue(message)) // Returns false when the queue is empty
+	LogMessage_t message;	// Reused, so the strings keep their capacity
+
+	while (IsNextRecordReady())
+	{
+		// Lists retired before this are no longer being read, since this thread is the only reader
+		FreeRetiredCallbackLists();
+		const LogCallbackList_t* callbackList = s_callbackList.load(std::memory_order_acquire);
+
+		for (int batchIndex = 0; batchIndex < LOG_PROCESS_BATCH_SIZE && IsNextRecordReady(); ++batchIndex)
+		{
+			size_t position = s_dequeuePosition.load(std::memory_order_relaxed);
+			LogRecordSlot_t& slot = s_records[position & (LOG_RECORD_COUNT - 1)];
+
+			FormatLogRecord(slot.record, message);
+			uint16_t tagID = slot.record.tagID;
+
+			// Free the slot for the next lap before the callbacks, which can be slow
+			// Producers can overwrite the record from here on, so only the copies above are read after
+			slot.sequence.store(position + LOG_RECORD_COUNT, std::memory_order_release);
+			s_dequeuePosition.store(position + 1, std::memory_order_relaxed);
+
+			if (callbackList == nullptr)
+			{
+				continue;
+			}
+
+			for (const LogFilteredCallback_t& callback : callbackList->callbacks)
+			{
+				// Only process the message if it's on our whitelist OR not on our blacklist, depending on our state
+				if (callback.filters.test(tagID) != callback.isBlackList)
+				{
+					callback.logCallback.callback(message, callback.logCallback.argumentData);
+				}
+			}
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the record after the last one processed has been committed
+//
+bool LogSystem::IsNextRecordReady()
+{
+	if (s_records == nullptr)
+	{
+		return false;
+	}
+
+	size_t position = s_dequeuePosition.load(std::memory_order_relaxed);
+	return (s_records[position & (LOG_RECORD_COUNT - 1)].sequence.load(std::memory_order_acquire) == position + 1);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Claims the next free record in the ring for the calling thread to write
+// Waits if the log thread has fallen a full ring behind, giving it time to catch up
+//
+LogRecordSlot_t* LogSystem::ClaimRecord(size_t& out_position)
+{
+	size_t position = s_enqueuePosition.load(std::memory_order_relaxed);
+
+	while (true)
+	{
+		LogRecordSlot_t* slot = &s_records[position & (LOG_RECORD_COUNT - 1)];
+		size_t sequence = slot->sequence.load(std::memory_order_acquire);
+		intptr_t difference = (intptr_t) sequence - (intptr_t) position;
+
+		if (difference == 0)
+		{
+			// Free for this lap, try to claim it
+			if (s_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+			{
+				out_position = position;
+				return slot;
+			}
+		}
+		else if (difference < 0)
+		{
+			// Still holds last lap's record, so the ring is full
+			Thread::YieldThisThread();
+			position = s_enqueuePosition.load(std::memory_order_relaxed);
+		}
+		else
+		{
+			// Another producer got here first
+			position = s_enqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Hands the written record to the log thread, signaling it if it's waiting
+//
+void LogSystem::CommitRecord(LogRecordSlot_t* slot, size_t position)
+{
+	slot->sequence.store(position + 1, std::memory_order_release);
+
+	// Pairs with the fence in ProcessLog(), so either the log thread sees the record or this sees it waiting
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	// Only the producer that clears the flag signals, so a burst of logs costs one wake
+	if (s_isLogThreadWaiting.load(std::memory_order_relaxed) && s_isLogThreadWaiting.exchange(false))
+	{
+		s_logSignal.Release();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a new copy of the current callback list for a change to be made to, to then be published
+//
+LogCallbackList_t* LogSystem::CopyCallbackList()
+{
+	LogCallbackList_t* currentList = s_callbackList.load(std::memory_order_relaxed);
+
+	if (currentList != nullptr)
+	{
+		return new LogCallbackList_t(*currentList);
+	}
+
+	return new LogCallbackList_t();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Makes the list the one the log thread reads, retiring the last one for it to free
+//
+void LogSystem::PublishCallbackList(LogCallbackList_t* callbackList)
+{
+	LogCallbackList_t* oldList = s_callbackList.exchange(callbackList, std::memory_order_acq_rel);
+
+	if (oldList != nullptr)
+	{
+		s_retiredCallbackLists.push_back(oldList);
+		s_hasRetiredCallbackLists.store(true, std::memory_order_release);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the callback of the given name in the list, or nullptr if there isn't one
+//
+LogFilteredCallback_t* LogSystem::FindCallback(LogCallbackList_t* callbackList, const std::string& callbackName)
+{
+	for (LogFilteredCallback_t& callback : callbackList->callbacks)
+	{
+		if (callback.logCallback.name == callbackName)
+		{
+			return &callback;
+		}
+	}
+
+	return nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes the lists replaced since the last batch, called only by the log thread before it loads the list
+//
+void LogSystem::FreeRetiredCallbackLists()
+{
+	if (!s_hasRetiredCallbackLists.load(std::memory_order_acquire))
+	{
+		return;
+	}
+
+	s_callbackWriteLock.lock();
+
+	for (LogCallbackList_t* retiredList : s_retiredCallbackLists)
+	{
+		delete retiredList;
+	}
+
+	s_retiredCallbackLists.clear();
+	s_hasRetiredCallbackLists.store(false, std::memory_order_relaxed);
+
+	s_callbackWriteLock.unlock();
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Parses the conversion specification starting at the '%', as printf would
+// Returns false if it's longer than LOG_MAX_CONVERSION_LENGTH or its argument can't be captured
+//
+static bool ParseLogConversion(const char* conversionStart, LogConversion_t& out_conversion)
+{
+	out_conversion = LogConversion_t();
+	const char* cursor = conversionStart + 1;
+
+	if (*cursor == '%')
+	{
+		out_conversion.length = 2;
+		out_conversion.type = LOG_ARGUMENT_NONE;
+		return true;
+	}
+
+	// Flags
+	while (*cursor != '\0' && strchr("-+ #0", *cursor) != nullptr)
+	{
+		cursor++;
+	}
+
+	// Width
+	if (*cursor == '*')
+	{
+		out_conversion.starCount++;
+		cursor++;
+	}
+
+	while (*cursor >= '0' && *cursor <= '9')
+	{
+		cursor++;
+	}
+
+	// Precision
+	if (*cursor == '.')
+	{
+		cursor++;
+
+		if (*cursor == '*')
+		{
+			out_conversion.starCount++;
+			cursor++;
+		}
+
+		while (*cursor >= '0' && *cursor <= '9')
+		{
+			cursor++;
+		}
+	}
+
+	// Length modifier, including MSVC's I, I32 and I64
+	eLogArgumentType integerType = LOG_ARGUMENT_INT;
+	bool isLongModifier = false;
+	bool isLongDouble = false;
+
+	switch (*cursor)
+	{
+	case 'h': cursor += (cursor[1] == 'h' ? 2 : 1); break;
+	case 'l':
+		if (cursor[1] == 'l')	{ integerType = LOG_ARGUMENT_LONG_LONG; cursor += 2; }
+		else					{ integerType = LOG_ARGUMENT_LONG; isLongModifier = true; cursor++; }
+		break;
+	case 'L': isLongDouble = true; cursor++; break;
+	case 'z': integerType = LOG_ARGUMENT_SIZE; cursor++; break;
+	case 'j': integerType = LOG_ARGUMENT_INTMAX; cursor++; break;
+	case 't': integerType = LOG_ARGUMENT_PTRDIFF; cursor++; break;
+	case 'I':
+		if (cursor[1] == '6' && cursor[2] == '4')		{ integerType = LOG_ARGUMENT_LONG_LONG; cursor += 3; }
+		else if (cursor[1] == '3' && cursor[2] == '2')	{ integerType = LOG_ARGUMENT_INT; cursor += 3; }
+		else											{ integerType = LOG_ARGUMENT_SIZE; cursor++; }
+		break;
+	default:
+		break;
+	}
+
+	// Conversion
+	switch (*cursor)
+	{
+	case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+		out_conversion.type = integerType;
+		break;
+	case 'c':
+		out_conversion.type = (isLongModifier ? LOG_ARGUMENT_UNSUPPORTED : LOG_ARGUMENT_INT);
+		break;
+	case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+		out_conversion.type = (isLongDouble ? LOG_ARGUMENT_LONG_DOUBLE : LOG_ARGUMENT_DOUBLE);
+		break;
+	case 's':
+		out_conversion.type = (isLongModifier ? LOG_ARGUMENT_UNSUPPORTED : LOG_ARGUMENT_STRING);
+		break;
+	case 'p':
+		out_conversion.type = LOG_ARGUMENT_POINTER;
+		break;
+	default:
+		out_conversion.type = LOG_ARGUMENT_UNSUPPORTED;
+		break;
+	}
+
+	out_conversion.length = (int) (cursor - conversionStart) + 1;
+
+	return (out_conversion.type != LOG_ARGUMENT_UNSUPPORTED && out_conversion.length < LOG_MAX_CONVERSION_LENGTH);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Appends the argument's type and value to the payload, returning false if it doesn't fit
+//
+static bool WriteLogArgument(LogRecord_t& record, size_t& bytesUsed, eLogArgumentType type, const void* value, size_t valueBytes)
+{
+	if (bytesUsed + 1 + valueBytes > LOG_RECORD_PAYLOAD_BYTES)
+	{
+		return false;
+	}
+
+	record.payload[bytesUsed] = (uint8_t) type;
+	memcpy(&record.payload[bytesUsed + 1], value, valueBytes);
+	bytesUsed += 1 + valueBytes;
+
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Reads the argument's value after its type byte, advancing the cursor past it
+//
+template <typename T>
+static T ReadLogArgument(const uint8_t*& cursor)
+{
+	T value;
+	memcpy(&value, cursor + 1, sizeof(T));
+	cursor += 1 + sizeof(T);
+
+	return value;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Formats the one conversion with its value, and the '*' widths and precisions before it
+//
+template <typename T>
+static int FormatLogConversion(char* buffer, size_t bufferSize, const char* conversion, const int* stars, int starCount, T value)
+{
+	switch (starCount)
+	{
+	case 0:		return snprintf(buffer, bufferSize, conversion, value);
+	case 1:		return snprintf(buffer, bufferSize, conversion, stars[0], value);
+	default:	return snprintf(buffer, bufferSize, conversion, stars[0], stars[1], value);
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Copies the format string into the payload followed by each of its arguments, strings copied inline
+// Returns false if they don't all fit, or one can't be captured
+//
+static bool CaptureLogArguments(LogRecord_t& record, const char* format, va_list args)
+{
+	size_t formatBytes = strlen(format) + 1;
+	if (formatBytes > LOG_RECORD_PAYLOAD_BYTES)
 	{
-		s_callbackLock.lock_shared();
+		return false;
+	}
 
-		std::map<std::string, LogFilteredCallback_t>::iterator itr = s_callbacks.begin();
+	memcpy(record.payload, format, formatBytes);
+	size_t bytesUsed = formatBytes;
 
-		for (itr; itr != s_callbacks.end(); itr++)
+	for (const char* cursor = strchr(format, '%'); cursor != nullptr; cursor = strchr(cursor, '%'))
+	{
+		LogConversion_t conversion;
+		if (!ParseLogConversion(cursor, conversion))
 		{
-			LogCallBack_t logCallback = itr->second.logCallback;
+			return false;
+		}
 
-			// Only process the message if it's on our whitelist OR not on our blacklist, depending on our state
-			if (itr->second.isBlackList && !itr->second.filters.Contains(message.tag))
+		cursor += conversion.length;
+
+		for (int starIndex = 0; starIndex < conversion.starCount; ++starIndex)
+		{
+			int star = va_arg(args, int);
+			if (!WriteLogArgument(record, bytesUsed, LOG_ARGUMENT_INT, &star, sizeof(star))) { return false; }
+		}
+
+		bool didFit = true;
+
+		switch (conversion.type)
+		{
+		case LOG_ARGUMENT_NONE:
+			break;
+		case LOG_ARGUMENT_INT:			{ int value = va_arg(args, int);						didFit = WriteLogArgument(record, bytesUsed, conversion.type, &value, sizeof(value)); } break;
+		case LOG_ARGUMENT_LONG:			{ long value = va_arg(args, long);						didFit = WriteLogArgument(record, bytesUsed, conversion.type, &value, sizeof(value)); } break;
+		case LOG_ARGUMENT_LONG_LONG:	{ long long value = va_arg(args, long long);			didFit = WriteLogArgument(record, bytesUsed, conversion.type, &value, sizeof(value)); } break;
+		case LOG_ARGUMENT_SIZE:			{ size_t value = va_arg(args, size_t);					didFit = WriteLogArgument(record, bytesUsed, conversion.type, &value, sizeof(value)); } break;
+		case LOG_ARGUMENT_INTMAX:		{ intmax_t value = va_arg(args, intmax_t);				didFit = WriteLogArgument(record, bytesUsed, conversion.type, &value, sizeof(value)); } break;
+		case LOG_ARGUMENT_PTRDIFF:		{ ptrdiff_t value = va_arg(args, ptrdiff_t);			didFit = WriteLogArgument(record, bytesUsed, conversion.type, &value, sizeof(value)); } break;
+		case LOG_ARGUMENT_DOUBLE:		{ double value = va_arg(args, double);					didFit = WriteLogArgument(record, bytesUsed, conversion.type, &value, sizeof(value)); } break;
+		case LOG_ARGUMENT_LONG_DOUBLE:	{ long double value = va_arg(args, long double);		didFit = WriteLogArgument(record, bytesUsed, conversion.type, &value, sizeof(value)); } break;
+		case LOG_ARGUMENT_POINTER:		{ void* value = va_arg(args, void*);					didFit = WriteLogArgument(record, bytesUsed, conversion.type, &value, sizeof(value)); } break;
+		case LOG_ARGUMENT_STRING:
+		{
+			const char* text = va_arg(args, const char*);
+			if (text == nullptr)
 			{
-				logCallback.callback(message, logCallback.argumentData);
+				text = "(null)";
 			}
-			else if (!itr->second.isBlackList && itr->second.filters.Contains(message.tag))
+
+			// Length, then the characters with their terminator
+			size_t textLength = strlen(text);
+			uint16_t storedLength = (uint16_t) textLength;
+
+			didFit = (textLength + 1 <= LOG_RECORD_PAYLOAD_BYTES) && WriteLogArgument(record, bytesUsed, conversion.type, &storedLength, sizeof(storedLength));
+			didFit = didFit && (bytesUsed + textLength + 1 <= LOG_RECORD_PAYLOAD_BYTES);
+
+			if (didFit)
 			{
-				logCallback.callback(message, logCallback.argumentData);
+				memcpy(&record.payload[bytesUsed], text, textLength + 1);
+				bytesUsed += textLength + 1;
 			}
 		}
+		break;
+		default:
+			return false;
+		}
 
-		s_callbackLock.unlock_shared();
+		if (!didFit)
+		{
+			return false;
+		}
 	}
+
+	record.payloadBytes = (uint16_t) bytesUsed;
+	record.isFormatted = false;
+
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Makes the message for the record, formatting its captured arguments into the text
+//
+static void FormatLogRecord(const LogRecord_t& record, LogMessage_t& out_message)
+{
+	out_message.tag = LogSystem::GetTagName(record.tagID);
+	out_message.hpc = record.hpc;
+
+	const char* format = (const char*) record.payload;
+	if (record.isFormatted)
+	{
+		out_message.message.assign(format, record.payloadBytes);
+		return;
+	}
+
+	out_message.message.clear();
+
+	const uint8_t* argumentCursor = record.payload + strlen(format) + 1;
+	char conversionText[LOG_MAX_CONVERSION_LENGTH];
+	char buffer[STRINGF_STACK_LOCAL_TEMP_LENGTH];
+
+	const char* cursor = format;
+	while (*cursor != '\0')
+	{
+		// Text up to the next conversion is copied as is
+		const char* conversionStart = strchr(cursor, '%');
+		if (conversionStart == nullptr)
+		{
+			out_message.message.append(cursor);
+			break;
+		}
+
+		out_message.message.append(cursor, conversionStart - cursor);
+
+		// Already parsed when captured, so it's known to be supported
+		LogConversion_t conversion;
+		ParseLogConversion(conversionStart, conversion);
+		cursor = conversionStart + conversion.length;
+
+		if (conversion.type == LOG_ARGUMENT_NONE)
+		{
+			out_message.message.push_back('%');
+			continue;
+		}
+
+		memcpy(conversionText, conversionStart, conversion.length);
+		conversionText[conversion.length] = '\0';
+
+		int stars[2] = { 0, 0 };
+		for (int starIndex = 0; starIndex < conversion.starCount; ++starIndex)
+		{
+			stars[starIndex] = ReadLogArgument<int>(argumentCursor);
+		}
+
+		int written = 0;
+		switch ((eLogArgumentType) *argumentCursor)
+		{
+		case LOG_ARGUMENT_INT:			written = FormatLogConversion(buffer, sizeof(buffer), conversionText, stars, conversion.starCount, ReadLogArgument<int>(argumentCursor));			break;
+		case LOG_ARGUMENT_LONG:			written = FormatLogConversion(buffer, sizeof(buffer), conversionText, stars, conversion.starCount, ReadLogArgument<long>(argumentCursor));			break;
+		case LOG_ARGUMENT_LONG_LONG:	written = FormatLogConversion(buffer, sizeof(buffer), conversionText, stars, conversion.starCount, ReadLogArgument<long long>(argumentCursor));		break;
+		case LOG_ARGUMENT_SIZE:			written = FormatLogConversion(buffer, sizeof(buffer), conversionText, stars, conversion.starCount, ReadLogArgument<size_t>(argumentCursor));		break;
+		case LOG_ARGUMENT_INTMAX:		written = FormatLogConversion(buffer, sizeof(buffer), conversionText, stars, conversion.starCount, ReadLogArgument<intmax_t>(argumentCursor));		break;
+		case LOG_ARGUMENT_PTRDIFF:		written = FormatLogConversion(buffer, sizeof(buffer), conversionText, stars, conversion.starCount, ReadLogArgument<ptrdiff_t>(argumentCursor));		break;
+		case LOG_ARGUMENT_DOUBLE:		written = FormatLogConversion(buffer, sizeof(buffer), conversionText, stars, conversion.starCount, ReadLogArgument<double>(argumentCursor));		break;
+		case LOG_ARGUMENT_LONG_DOUBLE:	written = FormatLogConversion(buffer, sizeof(buffer), conversionText, stars, conversion.starCount, ReadLogArgument<long double>(argumentCursor));	break;
+		case LOG_ARGUMENT_POINTER:		written = FormatLogConversion(buffer, sizeof(buffer), conversionText, stars, conversion.starCount, ReadLogArgument<void*>(argumentCursor));			break;
+		case LOG_ARGUMENT_STRING:
+		{
+			uint16_t textLength = ReadLogArgument<uint16_t>(argumentCursor);
+			const char* text = (const char*) argumentCursor;
+			argumentCursor += textLength + 1;
+
+			written = FormatLogConversion(buffer, sizeof(buffer), conversionText, stars, conversion.starCount, text);
+		}
+		break;
+		default:
+			break;
+		}
+
+		if (written > 0)
+		{
+			out_message.message.append(buffer, (written < (int) sizeof(buffer) ? written : (int) sizeof(buffer) - 1));
+		}
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the tag's ID, from a per thread cache keyed on the tag's pointer so literals skip the lock
+// Hits are checked against the name, since the pointer could be a buffer that's been reused
+//
+static uint16_t GetCachedTagID(const char* tag)
+{
+	struct TagCacheEntry_t
+	{
+		const char*	tag = nullptr;
+		uint16_t	tagID = 0;
+	};
+
+	thread_local TagCacheEntry_t tagCache[LOG_TAG_CACHE_SIZE];
+
+	TagCacheEntry_t& entry = tagCache[(((uintptr_t) tag) >> 3) & (LOG_TAG_CACHE_SIZE - 1)];
+	if (entry.tag == tag && strcmp(LogSystem::GetTagName(entry.tagID).c_str(), tag) == 0)
+	{
+		return entry.tagID;
+	}
+
+	entry.tag = tag;
+	entry.tagID = (uint16_t) LogSystem::GetTagID(tag);
+
+	return entry.tagID;
 }
 
 
 //-----------------------------------------------------------------------------------------------
 // Callback for writing a log to the log file
 //
-static void WriteToFile(LogMessage_t log, void* fileptr)
+static void WriteToFile(LogMessage_t log, void* writerptr)
 {
-	File* file = (File*) fileptr;
+	LogFileWriter* writer = (LogFileWriter*) writerptr;
 	std::string toPrint = Stringf("[%s] %s: %s\n", GetFormattedSystemTime().c_str(), log.tag.c_str(), log.message.c_str());
-	file->Write(toPrint.c_str(), toPrint.size());
+	writer->Write(toPrint.c_str(), toPrint.size());
 }
 
 
@@ -410,32 +1230,16 @@ void LogPrintString(const std::string& textLiteral)
 //
 void LogPrintv(char const* format, va_list args)
 {
-	char textLiteral[STRINGF_STACK_LOCAL_TEMP_LENGTH];
-	vsnprintf_s(textLiteral, STRINGF_STACK_LOCAL_TEMP_LENGTH, _TRUNCATE, format, args);	
-	textLiteral[STRINGF_STACK_LOCAL_TEMP_LENGTH - 1] = '\0'; // In case vsnprintf overran (doesn't auto-terminate)
-
-	LogMessage_t log;
-	log.message	= std::string(textLiteral);
-	log.tag = "";
-
-	LogSystem::AddLog(log);
+	LogSystem::AddLogv("", format, args);
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Adds the given tag and text to the log system as a log
+// Adds the given tag and text to the log system as a log, formatted later on the log thread
 //
 void LogTaggedPrintv(char const* tag, char const* format, va_list args)
 {
-	char textLiteral[STRINGF_STACK_LOCAL_TEMP_LENGTH];
-	vsnprintf_s(textLiteral, STRINGF_STACK_LOCAL_TEMP_LENGTH, _TRUNCATE, format, args);	
-	textLiteral[STRINGF_STACK_LOCAL_TEMP_LENGTH - 1] = '\0'; // In case vsnprintf overran (doesn't auto-terminate)
-													
-	LogMessage_t log;
-	log.message	= std::string(textLiteral);
-	log.tag = tag;
-
-	LogSystem::AddLog(log);
+	LogSystem::AddLogv(tag, format, args);
 }
 
 
@@ -6,13 +6,43 @@
 /************************************************************************/
 #pragma once
 #include "Engine/Core/Threading/Threading.hpp"
-#include "Engine/DataStructures/ThreadSafeSet.hpp"
-#include "Engine/DataStructures/ThreadSafeMap.hpp"
-#include "Engine/DataStructures/ThreadSafeQueue.hpp"
-#include <shared_mutex>
+#include "Engine/Core/Threading/Semaphore.hpp"
+#include "Engine/Core/LogFileWriter.hpp"
+#include "Engine/Core/Utility/StringID.hpp"
+#include "Engine/DataStructures/ConcurrentHashMap.hpp"
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <bitset>
 #include <string>
+#include <vector>
+#include <stdint.h>
 
-class File;
+// Logs wait on the log thread as fixed size records in a preallocated ring, formatted by the log thread
+#define LOG_RECORD_COUNT (4096)
+#define LOG_RECORD_PAYLOAD_BYTES (960)
+
+// Tags are interned into IDs the first time they're used, with filters kept as a bit per ID
+// Tags past the limit all share the last ID, named LOG_OVERFLOW_TAG_NAME
+#define LOG_MAX_TAG_COUNT (512)
+#define LOG_OVERFLOW_TAG_NAME "TAG_OVERFLOW"
+
+// Format string and captured arguments of a log, or its text if it was formatted when logged
+struct LogRecord_t
+{
+	uint64_t	hpc = 0;
+	uint16_t	tagID = 0;
+	uint16_t	payloadBytes = 0;
+	bool		isFormatted = false;	// Set when the arguments couldn't be captured, or the log was added already formatted
+	uint8_t		payload[LOG_RECORD_PAYLOAD_BYTES];
+};
+
+// Sequence says whose turn it is: == position means free to write, == position + 1 means written and free to read
+struct LogRecordSlot_t
+{
+	std::atomic<size_t>	sequence{ 0 };
+	LogRecord_t			record;
+};
 
 // Struct to represent a single log
 struct LogMessage_t
@@ -23,6 +53,7 @@ struct LogMessage_t
 
 	std::string tag;
 	std::string message;
+	uint64_t	hpc = 0;	// When it was logged, stamped by LogSystem::AddLog() on the logging thread
 
 };
 
@@ -42,18 +73,23 @@ struct LogCallBack_t
 
 };
 
-// Struct for a callback with a filtered list
-// This allows us to pass the LogCallback_t around by value, since
-// inside the set the std::mutex can't be copied (thus, can't copy LogFilteredCallback_t)
+// Struct for a callback with its tag filters, a bit per tag ID
 struct LogFilteredCallback_t
 {
 	LogFilteredCallback_t() {}
 	LogFilteredCallback_t(LogCallBack_t logCallback)
 	 : logCallback(logCallback) {}
 
-	LogCallBack_t				logCallback;
-	ThreadSafeSet<std::string>	filters;
-	bool						isBlackList = true;
+	LogCallBack_t					logCallback;
+	std::bitset<LOG_MAX_TAG_COUNT>	filters;
+	bool							isBlackList = true;
+};
+
+// Every callback, published whole and never changed after, so the log thread reads it without locking
+// Changes copy the current list and publish the copy, the old one freed by the log thread between batches
+struct LogCallbackList_t
+{
+	std::vector<LogFilteredCallback_t> callbacks;	// In the order they were added
 };
 
 class LogSystem
@@ -62,7 +98,7 @@ public:
 	//-----Public Methods-----
 
 	// Initialization
-	static void Initialize();
+	static void Initialize(const LogFileWriterOptions_t& fileOptions = LogFileWriterOptions_t());
 	static void Shutdown();
 
 	// Accessors
@@ -70,6 +106,7 @@ public:
 
 	// Mutators
 	static void AddLog(LogMessage_t message);
+	static void AddLogv(const char* tag, const char* format, va_list args);	// Formatted later on the log thread, so only costs a copy here
 	static void AddCallback(LogCallBack_t callback);
 	static void AddCallback(const char* name, Log_cb callback, void* argumentData);
 	static void FlushLog();
@@ -81,6 +118,10 @@ public:
 	static void ShowAllTags();
 	static void HideAllTags();
 
+	// Tags
+	static int					GetTagID(const char* tag);	// Interns the tag if it's new
+	static const std::string&	GetTagName(int tagID);
+
 
 private:
 	//-----Private Methods-----
@@ -96,22 +137,55 @@ private:
 	// Log thread functions
 	static void ProcessLog(void*);
 	static void ProcessAllLogsInQueue();
+	static void ServiceFileWriters();
+	static bool IsFlushRequested();
+	static bool IsNextRecordReady();
+
+	// For producers, writing straight into the ring - Claim waits for room if the log thread is a full ring behind
+	static LogRecordSlot_t* ClaimRecord(size_t& out_position);
+	static void				CommitRecord(LogRecordSlot_t* slot, size_t position);
+
+	// For changing the callbacks, with s_callbackWriteLock held
+	static LogCallbackList_t*		CopyCallbackList();
+	static void						PublishCallbackList(LogCallbackList_t* callbackList);
+	static LogFilteredCallback_t*	FindCallback(LogCallbackList_t* callbackList, const std::string& callbackName);
+	static void						FreeRetiredCallbackLists();
 
 
 private:
 	//-----Private Data-----
 
-	// For writing to the log file
-	static File* s_logFile;
-	static File* s_timeStampFile;
+	// For writing to the log files, only used by the log thread while it's running
+	static LogFileWriter* s_logFileWriter;
+	static LogFileWriter* s_timeStampFileWriter;
+
+	// FlushLog() bumps the request count, and waits for the log thread to catch the completed count up to it
+	static std::atomic<uint32_t> s_flushRequestCount;
+	static std::atomic<uint32_t> s_flushCompletedCount;
 
 	static bool s_isRunning;
 	static ThreadHandle_t s_logThread;
-	static ThreadSafeQueue<LogMessage_t> s_logQueue;
+
+	// Ring of records, many producers and the log thread consuming
+	static LogRecordSlot_t* s_records;
+	alignas(64) static std::atomic<size_t> s_enqueuePosition;
+	alignas(64) static std::atomic<size_t> s_dequeuePosition;
+
+	// The log thread sleeps on the semaphore, and is only signaled by producers when it's flagged as waiting
+	static Semaphore s_logSignal;
+	static std::atomic<bool> s_isLogThreadWaiting;
 	
-	// Callbacks
-	static std::shared_mutex s_callbackLock;
-	static std::map<std::string, LogFilteredCallback_t> s_callbacks;
+	// Callbacks, only locked by changes to them
+	static std::mutex s_callbackWriteLock;
+	static std::atomic<LogCallbackList_t*> s_callbackList;
+	static std::vector<LogCallbackList_t*> s_retiredCallbackLists;
+	static std::atomic<bool> s_hasRetiredCallbackLists;
+
+	// Interned tags, names set before their ID is first handed out and never changed
+	static std::mutex s_tagLock;
+	static ConcurrentHashMap<StringID, int> s_tagIDs;		// By the StringID of the tag, read on every log, written once per new tag
+	static std::string s_tagNames[LOG_MAX_TAG_COUNT];
+	static int s_tagCount;
 
 	// Statics
 	static LogSystem* s_instance;
@@ -0,0 +1,312 @@
+/************************************************************************/
+/* File: LinearAllocator.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the LinearAllocator, FrameArena and
+/*				scratch arenas
+/************************************************************************/
+#include <new>
+#include "Engine/Core/Memory/LinearAllocator.hpp"
+#include "Engine/Core/Utility/StringUtils.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+
+LinearAllocator*	FrameArena::s_allocators[2] = { nullptr, nullptr };
+int					FrameArena::s_currentIndex = 0;
+uint64_t			FrameArena::s_frameNumber = 0;
+size_t				FrameArena::s_lastFrameByteCount = 0;
+
+// Made on the thread's first use, destroyed with the thread
+static thread_local LinearAllocator s_threadScratchAllocator(SCRATCH_ARENA_INITIAL_BYTES);
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Rounds the address up to the alignment, which must be a power of two
+//
+static uintptr_t AlignAddress(uintptr_t address, size_t alignment)
+{
+	return (address + (alignment - 1)) & ~((uintptr_t)alignment - 1);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+LinearAllocator::LinearAllocator(size_t initialBytes)
+	: m_initialBytes(initialBytes)
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+LinearAllocator::~LinearAllocator()
+{
+	FreeAllBlocks();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns byteCount bytes aligned to alignment, chaining on a new block if the current one is full
+//
+void* LinearAllocator::Allocate(size_t byteCount, size_t alignment /*= LINEAR_ALLOCATOR_DEFAULT_ALIGNMENT*/)
+{
+	ASSERT_OR_DIE(alignment > 0 && (alignment & (alignment - 1)) == 0, Stringf("Error: LinearAllocator::Allocate() given alignment %u, must be a power of two", (unsigned int)alignment));
+
+	while (m_blockIndex < (int)m_blocks.size())
+	{
+		Block_t& block = m_blocks[m_blockIndex];
+
+		uintptr_t blockStart = (uintptr_t)block.memory;
+		uintptr_t alignedAddress = AlignAddress(blockStart + m_offset, alignment);
+		size_t endOffset = (size_t)(alignedAddress - blockStart) + byteCount;
+
+		if (endOffset <= block.capacity)
+		{
+			m_offset = endOffset;
+
+			size_t usedBytes = GetUsedBytes();
+			m_peakUsedBytes = (usedBytes > m_peakUsedBytes ? usedBytes : m_peakUsedBytes);
+
+			return (void*)alignedAddress;
+		}
+
+		// Doesn't fit, move on to the next block (rewinding can leave later blocks to reuse)
+		m_previousBlocksUsedBytes += block.capacity;
+		m_blockIndex++;
+		m_offset = 0;
+	}
+
+	// Out of blocks, so chain on one at least double the last
+	size_t lastCapacity = (m_blocks.size() > 0 ? m_blocks.back().capacity : m_initialBytes / 2);
+	size_t neededBytes = byteCount + alignment;
+
+	Block_t newBlock;
+	newBlock.capacity = (lastCapacity * 2 > neededBytes ? lastCapacity * 2 : neededBytes);
+
+	// Through operator new rather than malloc, so the MemoryTracker sees it
+	newBlock.memory = (uint8_t*) ::operator new(newBlock.capacity);
+	m_blocks.push_back(newBlock);
+
+	return Allocate(byteCount, alignment);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Frees everything allocated; if more than one block was needed they're merged into one that fits the peak
+//
+void LinearAllocator::Reset()
+{
+	if (m_blocks.size() > 1)
+	{
+		size_t totalCapacity = GetCapacity();
+		FreeAllBlocks();
+
+		Block_t mergedBlock;
+		mergedBlock.capacity = totalCapacity;
+		mergedBlock.memory = (uint8_t*) ::operator new(mergedBlock.capacity);
+		m_blocks.push_back(mergedBlock);
+	}
+
+	m_blockIndex = 0;
+	m_offset = 0;
+	m_previousBlocksUsedBytes = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the current position, to rewind back to
+//
+LinearAllocatorMarker_t LinearAllocator::GetMarker() const
+{
+	LinearAllocatorMarker_t marker;
+	marker.blockIndex = m_blockIndex;
+	marker.offset = m_offset;
+
+	return marker;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Frees everything allocated since the marker was taken; blocks chained since are kept for reuse
+//
+void LinearAllocator::RewindToMarker(const LinearAllocatorMarker_t& marker)
+{
+	ASSERT_OR_DIE(marker.blockIndex < m_blockIndex || (marker.blockIndex == m_blockIndex && marker.offset <= m_offset), "Error: LinearAllocator::RewindToMarker() given a marker past the current position");
+
+	for (int blockIndex = marker.blockIndex; blockIndex < m_blockIndex; ++blockIndex)
+	{
+		m_previousBlocksUsedBytes -= m_blocks[blockIndex].capacity;
+	}
+
+	m_blockIndex = marker.blockIndex;
+	m_offset = marker.offset;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the bytes used since the last reset; blocks that were skipped over count as fully used
+//
+size_t LinearAllocator::GetUsedBytes() const
+{
+	return m_previousBlocksUsedBytes + m_offset;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the most bytes ever in use at once
+//
+size_t LinearAllocator::GetPeakUsedBytes() const
+{
+	return m_peakUsedBytes;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the total size of all blocks
+//
+size_t LinearAllocator::GetCapacity() const
+{
+	size_t totalCapacity = 0;
+
+	for (int blockIndex = 0; blockIndex < (int)m_blocks.size(); ++blockIndex)
+	{
+		totalCapacity += m_blocks[blockIndex].capacity;
+	}
+
+	return totalCapacity;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Frees every block
+//
+void LinearAllocator::FreeAllBlocks()
+{
+	for (int blockIndex = 0; blockIndex < (int)m_blocks.size(); ++blockIndex)
+	{
+		::operator delete(m_blocks[blockIndex].memory);
+	}
+
+	m_blocks.clear();
+	m_blockIndex = 0;
+	m_offset = 0;
+	m_previousBlocksUsedBytes = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Allocates from the current frame's arena
+//
+void* FrameArena::Allocate(size_t byteCount, size_t alignment /*= LINEAR_ALLOCATOR_DEFAULT_ALIGNMENT*/)
+{
+	return GetAllocator()->Allocate(byteCount, alignment);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the current frame's allocator, made on first use
+//
+LinearAllocator* FrameArena::GetAllocator()
+{
+	if (s_allocators[s_currentIndex] == nullptr)
+	{
+		s_allocators[s_currentIndex] = new LinearAllocator(FRAME_ARENA_INITIAL_BYTES);
+	}
+
+	return s_allocators[s_currentIndex];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Swaps to the other arena, which is reset; what the last frame allocated stays valid through this one
+//
+void FrameArena::BeginFrame()
+{
+	LinearAllocator* lastFrameAllocator = s_allocators[s_currentIndex];
+	s_lastFrameByteCount = (lastFrameAllocator != nullptr ? lastFrameAllocator->GetUsedBytes() : 0);
+
+	s_currentIndex = 1 - s_currentIndex;
+	s_frameNumber++;
+
+	if (s_allocators[s_currentIndex] != nullptr)
+	{
+		s_allocators[s_currentIndex]->Reset();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Frees both arenas
+//
+void FrameArena::Shutdown()
+{
+	for (int allocatorIndex = 0; allocatorIndex < 2; ++allocatorIndex)
+	{
+		delete s_allocators[allocatorIndex];
+		s_allocators[allocatorIndex] = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of frames begun, allocations are valid for the frame they were made in and the next
+//
+uint64_t FrameArena::GetFrameNumber()
+{
+	return s_frameNumber;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns how many bytes were allocated during the last frame
+//
+size_t FrameArena::GetLastFrameByteCount()
+{
+	return s_lastFrameByteCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the calling thread's scratch allocator
+//
+LinearAllocator* GetThreadScratchAllocator()
+{
+	return &s_threadScratchAllocator;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - remembers where the thread's scratch arena was
+//
+ScratchScope::ScratchScope()
+	: m_allocator(GetThreadScratchAllocator())
+{
+	m_marker = m_allocator->GetMarker();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor - frees everything allocated from the scratch arena since the constructor
+// The outermost scope resets the arena instead, so any chained blocks get merged
+//
+ScratchScope::~ScratchScope()
+{
+	if (m_marker.blockIndex == 0 && m_marker.offset == 0)
+	{
+		m_allocator->Reset();
+	}
+	else
+	{
+		m_allocator->RewindToMarker(m_marker);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Allocates from the thread's scratch arena, freed when the scope ends
+//
+void* ScratchScope::Allocate(size_t byteCount, size_t alignment /*= LINEAR_ALLOCATOR_DEFAULT_ALIGNMENT*/)
+{
+	return m_allocator->Allocate(byteCount, alignment);
+}
@@ -0,0 +1,212 @@
+/************************************************************************/
+/* File: LinearAllocator.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Bump allocators for transient memory - the double buffered
+/*				frame arena, per-thread scratch arenas, and an STL allocator
+/*				adaptor so containers can use either
+/************************************************************************/
+#pragma once
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+#define LINEAR_ALLOCATOR_DEFAULT_ALIGNMENT (16)
+#define FRAME_ARENA_INITIAL_BYTES ((size_t) 1024 * 1024)
+#define SCRATCH_ARENA_INITIAL_BYTES ((size_t) 256 * 1024)
+
+// Where an allocator was at, to rewind back to
+struct LinearAllocatorMarker_t
+{
+	int		blockIndex = 0;
+	size_t	offset = 0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Hands out memory by bumping an offset, freeing everything at once on Reset()
+// Running out of room chains another block; Reset() then merges them into one the size of the peak,
+// so a steady workload settles on a single block and never touches the heap
+// Not thread safe - each thread has its own scratch arena for that
+//
+class LinearAllocator
+{
+public:
+	//-----Public Methods-----
+
+	// Nothing is allocated until the first Allocate()
+	LinearAllocator(size_t initialBytes);
+	~LinearAllocator();
+
+	void*						Allocate(size_t byteCount, size_t alignment = LINEAR_ALLOCATOR_DEFAULT_ALIGNMENT);
+	template <typename T> T*	AllocateArray(size_t count);	// Uninitialized, and never destructed
+
+	void						Reset();
+
+	// Frees everything allocated after the marker, for stack-like use
+	LinearAllocatorMarker_t		GetMarker() const;
+	void						RewindToMarker(const LinearAllocatorMarker_t& marker);
+
+	size_t						GetUsedBytes() const;		// Since the last Reset(), including alignment padding
+	size_t						GetPeakUsedBytes() const;	// Highest ever
+	size_t						GetCapacity() const;
+
+
+private:
+	//-----Private Types-----
+
+	struct Block_t
+	{
+		uint8_t*	memory = nullptr;
+		size_t		capacity = 0;
+	};
+
+
+private:
+	//-----Private Methods-----
+
+	LinearAllocator(const LinearAllocator& copy) = delete;
+
+	void	FreeAllBlocks();
+
+
+private:
+	//-----Private Data-----
+
+	std::vector<Block_t>	m_blocks;
+	int						m_blockIndex = 0;
+	size_t					m_offset = 0;
+	size_t					m_previousBlocksUsedBytes = 0;	// Everything in the blocks before m_blockIndex
+	size_t					m_initialBytes = 0;
+	size_t					m_peakUsedBytes = 0;
+
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Frame arena - allocations live until the end of the following frame, so data made this frame can
+// still be read while the next one is built; main thread only
+// Flipped by the master Clock's BeginFrame()
+//
+class FrameArena
+{
+public:
+	//-----Public Methods-----
+
+	static void*							Allocate(size_t byteCount, size_t alignment = LINEAR_ALLOCATOR_DEFAULT_ALIGNMENT);
+	template <typename T> static T*			AllocateArray(size_t count);
+	static LinearAllocator*					GetAllocator();
+
+	static void								BeginFrame();
+	static void								Shutdown();
+
+	static uint64_t							GetFrameNumber();
+	static size_t							GetLastFrameByteCount();
+
+
+private:
+	//-----Private Methods-----
+
+	FrameArena() {}
+
+
+private:
+	//-----Private Data-----
+
+	static LinearAllocator*		s_allocators[2];
+	static int					s_currentIndex;
+	static uint64_t				s_frameNumber;
+	static size_t				s_lastFrameByteCount;
+
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Scratch arenas - one per thread, for temporaries that don't outlive the function using them
+// Use through a ScratchScope, which rewinds everything allocated inside it when it goes out of scope
+//
+LinearAllocator* GetThreadScratchAllocator();
+
+class ScratchScope
+{
+public:
+	//-----Public Methods-----
+
+	ScratchScope();
+	~ScratchScope();
+
+	void*						Allocate(size_t byteCount, size_t alignment = LINEAR_ALLOCATOR_DEFAULT_ALIGNMENT);
+	template <typename T> T*	AllocateArray(size_t count);
+	LinearAllocator*			GetAllocator() const { return m_allocator; }
+
+
+private:
+	//-----Private Methods-----
+
+	ScratchScope(const ScratchScope& copy) = delete;
+
+
+private:
+	//-----Private Data-----
+
+	LinearAllocator*		m_allocator = nullptr;
+	LinearAllocatorMarker_t	m_marker;
+
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// STL allocator over a LinearAllocator, deallocation does nothing
+// i.e. ArenaVector<int> indices(LinearStlAllocator<int>(FrameArena::GetAllocator()));
+//
+template <typename T>
+class LinearStlAllocator
+{
+public:
+	typedef T value_type;
+
+	LinearStlAllocator(LinearAllocator* allocator) : m_allocator(allocator) {}
+	template <typename U> LinearStlAllocator(const LinearStlAllocator<U>& other) : m_allocator(other.m_allocator) {}
+
+	T*		allocate(size_t count) { return m_allocator->AllocateArray<T>(count); }
+	void	deallocate(T*, size_t) {}
+
+	template <typename U> bool operator==(const LinearStlAllocator<U>& other) const { return m_allocator == other.m_allocator; }
+	template <typename U> bool operator!=(const LinearStlAllocator<U>& other) const { return m_allocator != other.m_allocator; }
+
+	LinearAllocator* m_allocator = nullptr;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, LinearStlAllocator<T>>;
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns uninitialized memory for count elements of T, aligned for T
+//
+template <typename T>
+T* LinearAllocator::AllocateArray(size_t count)
+{
+	size_t alignment = (alignof(T) > LINEAR_ALLOCATOR_DEFAULT_ALIGNMENT ? alignof(T) : LINEAR_ALLOCATOR_DEFAULT_ALIGNMENT);
+	return reinterpret_cast<T*>(Allocate(sizeof(T) * count, alignment));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns uninitialized memory for count elements of T from this frame's arena
+//
+template <typename T>
+T* FrameArena::AllocateArray(size_t count)
+{
+	return GetAllocator()->AllocateArray<T>(count);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns uninitialized memory for count elements of T from the thread's scratch arena
+//
+template <typename T>
+T* ScratchScope::AllocateArray(size_t count)
+{
+	return m_allocator->AllocateArray<T>(count);
+}
@@ -0,0 +1,778 @@
+/************************************************************************/
+/* File: MemoryTracker.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the MemoryTracker class
+/************************************************************************/
+#include "Game/Framework/EngineBuildPreferences.hpp" // Only game code in engine
+
+#include "Engine/Core/Memory/MemoryTracker.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/Utility/StringUtils.hpp"
+#include "Engine/Core/DeveloperConsole/Command.hpp"
+#include "Engine/Core/DeveloperConsole/DevConsole.hpp"
+#include <map>
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+
+// Commands
+void Command_MemoryReport(Command& cmd);
+void Command_MemorySnapshot(Command& cmd);
+void Command_MemoryDiff(Command& cmd);
+
+#ifdef MEMORY_TRACKING_ENABLED
+
+#include <new>
+#include <mutex>
+#include <atomic>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#include <DbgHelp.h>
+#pragma comment(lib, "dbghelp.lib") // For naming the callsites
+
+#define MEMORY_TRACKER_GUARD (0xA110)
+#define MEMORY_TRACKER_OVERFLOW_CALLSITE (MEMORY_TRACKER_MAX_CALLSITES)
+#define MEMORY_TRACKER_MAX_SYMBOL_LENGTH (256)
+
+// In front of every allocation, 16 bytes so the memory after it keeps malloc's alignment
+struct MemoryAllocationHeader_t
+{
+	uint64_t	byteCount;
+	uint32_t	callsiteIndex;
+	uint16_t	tagIndex;
+	uint16_t	guard;
+};
+static_assert(sizeof(MemoryAllocationHeader_t) == 16, "MemoryAllocationHeader_t must keep allocations 16 byte aligned");
+
+// Updated from any thread; the frame counts only by BeginFrame()
+struct MemoryCounters_t
+{
+	std::atomic<int64_t>	liveBytes;
+	std::atomic<int64_t>	liveAllocationCount;
+	std::atomic<int64_t>	peakLiveBytes;
+	std::atomic<uint64_t>	totalAllocationCount;
+
+	uint64_t				lastFrameTotalAllocationCount;
+	uint64_t				frameAllocationCount;
+};
+
+// A slot in the callsite table, claimed by the first allocation with its stack hash
+struct MemoryCallsite_t
+{
+	std::atomic<uint64_t>	stackHash;
+	std::atomic<bool>		isReady;		// Set once the frames are written
+	void*					frames[MEMORY_TRACKER_CALLSTACK_DEPTH];
+	MemoryCounters_t		counters;
+};
+
+// Everything here is zero or constant initialized, as allocations start before any constructors run
+static const char*			s_tagNames[MEMORY_TRACKER_MAX_TAGS] = { "Untagged" };
+static MemoryCounters_t		s_tagCounters[MEMORY_TRACKER_MAX_TAGS];
+static std::atomic<int>		s_tagCount(1);
+static std::mutex			s_tagLock;
+
+static MemoryCallsite_t		s_callsites[MEMORY_TRACKER_MAX_CALLSITES + 1];	// The last is the overflow
+static MemoryCounters_t		s_totalCounters;
+static int					s_frameNumber = 0;
+
+static thread_local int		s_threadTagStack[MEMORY_TRACKER_TAG_STACK_DEPTH];
+static thread_local int		s_threadTagDepth = 0;
+
+// Main thread only, for the commands and UI
+static std::map<int, std::string>		s_callsiteNames;
+static bool								s_areSymbolsInitialized = false;
+static std::vector<MemorySnapshot_t*>	s_snapshots;
+static int								s_nextSnapshotID = 0;
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Adds an allocation of byteCount to the counters, raising the peak if it's passed
+//
+void AddAllocation(MemoryCounters_t& counters, int64_t byteCount)
+{
+	int64_t liveBytes = counters.liveBytes.fetch_add(byteCount, std::memory_order_relaxed) + byteCount;
+	counters.liveAllocationCount.fetch_add(1, std::memory_order_relaxed);
+	counters.totalAllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+	int64_t peakLiveBytes = counters.peakLiveBytes.load(std::memory_order_relaxed);
+	while (liveBytes > peakLiveBytes && !counters.peakLiveBytes.compare_exchange_weak(peakLiveBytes, liveBytes, std::memory_order_relaxed)) {}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Removes a freed allocation of byteCount from the counters
+//
+void RemoveAllocation(MemoryCounters_t& counters, int64_t byteCount)
+{
+	counters.liveBytes.fetch_sub(byteCount, std::memory_order_relaxed);
+	counters.liveAllocationCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Moves the count of allocations made since the last call into the frame count
+//
+void RollFrameCounters(MemoryCounters_t& counters)
+{
+	uint64_t totalAllocationCount = counters.totalAllocationCount.load(std::memory_order_relaxed);
+
+	counters.frameAllocationCount = totalAllocationCount - counters.lastFrameTotalAllocationCount;
+	counters.lastFrameTotalAllocationCount = totalAllocationCount;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns a copy of the counters
+//
+MemoryStats_t GetStatsFromCounters(const MemoryCounters_t& counters)
+{
+	MemoryStats_t stats;
+	stats.liveBytes				= counters.liveBytes.load(std::memory_order_relaxed);
+	stats.liveAllocationCount	= counters.liveAllocationCount.load(std::memory_order_relaxed);
+	stats.peakLiveBytes			= counters.peakLiveBytes.load(std::memory_order_relaxed);
+	stats.totalAllocationCount	= counters.totalAllocationCount.load(std::memory_order_relaxed);
+	stats.frameAllocationCount	= counters.frameAllocationCount;
+
+	return stats;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the index of the tag with the name, adding it if it's new
+// Returns the untagged index if the tags are full
+//
+int FindOrAddTag(const char* tagName)
+{
+	int tagCount = s_tagCount.load(std::memory_order_acquire);
+	for (int tagIndex = 0; tagIndex < tagCount; ++tagIndex)
+	{
+		if (s_tagNames[tagIndex] == tagName || strcmp(s_tagNames[tagIndex], tagName) == 0)
+		{
+			return tagIndex;
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(s_tagLock);
+
+	// Another thread may have added it while this one waited
+	tagCount = s_tagCount.load(std::memory_order_acquire);
+	for (int tagIndex = 0; tagIndex < tagCount; ++tagIndex)
+	{
+		if (strcmp(s_tagNames[tagIndex], tagName) == 0)
+		{
+			return tagIndex;
+		}
+	}
+
+	if (tagCount == MEMORY_TRACKER_MAX_TAGS)
+	{
+		return 0;
+	}
+
+	s_tagNames[tagCount] = tagName;
+	s_tagCount.store(tagCount + 1, std::memory_order_release);
+
+	return tagCount;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the index of the callsite for the calling thread's stack, claiming a slot if it's new
+//
+uint32_t FindOrAddCallsite()
+{
+	void* frames[MEMORY_TRACKER_CALLSTACK_DEPTH] = {};
+	::RtlCaptureStackBackTrace(1, MEMORY_TRACKER_CALLSTACK_DEPTH, frames, nullptr);
+
+	// FNV-1a over the return addresses, 0 is kept for empty slots
+	uint64_t stackHash = 14695981039346656037ULL;
+	for (int frameIndex = 0; frameIndex < MEMORY_TRACKER_CALLSTACK_DEPTH; ++frameIndex)
+	{
+		stackHash ^= (uint64_t) frames[frameIndex];
+		stackHash *= 1099511628211ULL;
+	}
+
+	if (stackHash == 0)
+	{
+		stackHash = 1;
+	}
+
+	uint32_t callsiteIndex = (uint32_t) (stackHash & (MEMORY_TRACKER_MAX_CALLSITES - 1));
+	for (int probeCount = 0; probeCount < MEMORY_TRACKER_MAX_CALLSITES; ++probeCount)
+	{
+		MemoryCallsite_t& callsite = s_callsites[callsiteIndex];
+		uint64_t slotHash = callsite.stackHash.load(std::memory_order_acquire);
+
+		if (slotHash == 0 && callsite.stackHash.compare_exchange_strong(slotHash, stackHash, std::memory_order_acq_rel))
+		{
+			memcpy(callsite.frames, frames, sizeof(frames));
+			callsite.isReady.store(true, std::memory_order_release);
+			return callsiteIndex;
+		}
+
+		// Either it was this stack's already, or another thread just claimed it for this stack
+		if (slotHash == stackHash)
+		{
+			return callsiteIndex;
+		}
+
+		callsiteIndex = (callsiteIndex + 1) & (MEMORY_TRACKER_MAX_CALLSITES - 1);
+	}
+
+	return MEMORY_TRACKER_OVERFLOW_CALLSITE;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns true if the symbol is part of allocating rather than what asked for the memory
+//
+bool IsAllocatorSymbol(const char* symbolName)
+{
+	return (strncmp(symbolName, "std::", 5) == 0
+		|| strncmp(symbolName, "operator new", 12) == 0
+		|| strncmp(symbolName, "MemoryTracker::", 15) == 0
+		|| strncmp(symbolName, "FindOrAddCallsite", 17) == 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true, as the global new and delete in this file are counting
+//
+bool MemoryTracker::IsEnabled()
+{
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Updates the allocation counts of the frame that just ended
+//
+void MemoryTracker::BeginFrame()
+{
+	s_frameNumber++;
+
+	RollFrameCounters(s_totalCounters);
+
+	int tagCount = s_tagCount.load(std::memory_order_acquire);
+	for (int tagIndex = 0; tagIndex < tagCount; ++tagIndex)
+	{
+		RollFrameCounters(s_tagCounters[tagIndex]);
+	}
+
+	for (int callsiteIndex = 0; callsiteIndex <= MEMORY_TRACKER_MAX_CALLSITES; ++callsiteIndex)
+	{
+		RollFrameCounters(s_callsites[callsiteIndex].counters);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Makes the tag the one allocations on this thread are counted under, until it's popped
+//
+void MemoryTracker::PushTag(const char* tagName)
+{
+	int tagIndex = FindOrAddTag(tagName);
+
+	// Past the depth the innermost tag that fit is used, but the pushes are still counted to pop them
+	if (s_threadTagDepth < MEMORY_TRACKER_TAG_STACK_DEPTH)
+	{
+		s_threadTagStack[s_threadTagDepth] = tagIndex;
+	}
+
+	s_threadTagDepth++;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Goes back to the tag pushed before the last one
+//
+void MemoryTracker::PopTag()
+{
+	ASSERT_OR_DIE(s_threadTagDepth > 0, "Error: MemoryTracker::PopTag() called with no tag pushed");
+	s_threadTagDepth--;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the counts across every allocation
+//
+MemoryStats_t MemoryTracker::GetTotalStats()
+{
+	return GetStatsFromCounters(s_totalCounters);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the counts of every tag, the untagged allocations first
+//
+void MemoryTracker::GetTagStats(std::vector<MemoryTagStats_t>& out_tags)
+{
+	out_tags.clear();
+
+	int tagCount = s_tagCount.load(std::memory_order_acquire);
+	for (int tagIndex = 0; tagIndex < tagCount; ++tagIndex)
+	{
+		MemoryTagStats_t tag;
+		tag.name = s_tagNames[tagIndex];
+		tag.stats = GetStatsFromCounters(s_tagCounters[tagIndex]);
+
+		out_tags.push_back(tag);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the counts of every callsite that has allocated, in table order
+//
+void MemoryTracker::GetCallsiteStats(std::vector<MemoryCallsiteStats_t>& out_callsites)
+{
+	out_callsites.clear();
+
+	for (int callsiteIndex = 0; callsiteIndex <= MEMORY_TRACKER_MAX_CALLSITES; ++callsiteIndex)
+	{
+		const MemoryCallsite_t& callsite = s_callsites[callsiteIndex];
+
+		if (callsite.counters.totalAllocationCount.load(std::memory_order_relaxed) == 0)
+		{
+			continue;
+		}
+
+		MemoryCallsiteStats_t stats;
+		stats.callsiteIndex = callsiteIndex;
+		stats.stats = GetStatsFromCounters(callsite.counters);
+
+		out_callsites.push_back(stats);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the function, file and line that made the allocations at the callsite, looked up once
+// through the debug symbols
+//
+std::string MemoryTracker::GetCallsiteName(int callsiteIndex)
+{
+	if (callsiteIndex == MEMORY_TRACKER_OVERFLOW_CALLSITE)
+	{
+		return "(Callsite table full)";
+	}
+
+	if (callsiteIndex < 0 || callsiteIndex > MEMORY_TRACKER_MAX_CALLSITES || !s_callsites[callsiteIndex].isReady.load(std::memory_order_acquire))
+	{
+		return "(Unknown)";
+	}
+
+	std::map<int, std::string>::const_iterator itr = s_callsiteNames.find(callsiteIndex);
+	if (itr != s_callsiteNames.end())
+	{
+		return itr->second;
+	}
+
+	HANDLE process = ::GetCurrentProcess();
+
+	if (!s_areSymbolsInitialized)
+	{
+		::SymSetOptions(SYMOPT_UNDNAME | SYMOPT_DEFERRED_LOADS | SYMOPT_LOAD_LINES);
+		s_areSymbolsInitialized = (::SymInitialize(process, nullptr, TRUE) == TRUE);
+	}
+
+	const MemoryCallsite_t& callsite = s_callsites[callsiteIndex];
+	std::string name = Stringf("0x%p", callsite.frames[0]);
+
+	for (int frameIndex = 0; s_areSymbolsInitialized && frameIndex < MEMORY_TRACKER_CALLSTACK_DEPTH && callsite.frames[frameIndex] != nullptr; ++frameIndex)
+	{
+		ULONG64 symbolBuffer[(sizeof(SYMBOL_INFO) + MEMORY_TRACKER_MAX_SYMBOL_LENGTH + sizeof(ULONG64) - 1) / sizeof(ULONG64)];
+		SYMBOL_INFO* symbol = (SYMBOL_INFO*) symbolBuffer;
+		symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+		symbol->MaxNameLen = MEMORY_TRACKER_MAX_SYMBOL_LENGTH;
+
+		DWORD64 address = (DWORD64) callsite.frames[frameIndex];
+		if (!::SymFromAddr(process, address, nullptr, symbol) || IsAllocatorSymbol(symbol->Name))
+		{
+			continue;
+		}
+
+		IMAGEHLP_LINE64 line;
+		line.SizeOfStruct = sizeof(IMAGEHLP_LINE64);
+		DWORD lineDisplacement = 0;
+
+		if (::SymGetLineFromAddr64(process, address, &lineDisplacement, &line))
+		{
+			const char* fileName = strrchr(line.FileName, '\\');
+			fileName = (fileName != nullptr ? fileName + 1 : line.FileName);
+
+			name = Stringf("%s (%s:%u)", symbol->Name, fileName, (unsigned int) line.LineNumber);
+		}
+		else
+		{
+			name = symbol->Name;
+		}
+
+		break;
+	}
+
+	s_callsiteNames[callsiteIndex] = name;
+	return name;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies out every tag's and callsite's counts
+//
+void MemoryTracker::TakeSnapshot(MemorySnapshot_t& out_snapshot)
+{
+	out_snapshot.frameNumber = s_frameNumber;
+	out_snapshot.total = GetTotalStats();
+
+	GetTagStats(out_snapshot.tags);
+	GetCallsiteStats(out_snapshot.callsites);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Allocates byteCount behind a header recording who it's counted under
+// Returns nullptr if the heap is out of memory
+//
+void* MemoryTracker::Allocate(size_t byteCount)
+{
+	MemoryAllocationHeader_t* header = (MemoryAllocationHeader_t*) malloc(sizeof(MemoryAllocationHeader_t) + byteCount);
+
+	if (header == nullptr)
+	{
+		return nullptr;
+	}
+
+	int tagIndex = 0;
+	if (s_threadTagDepth > 0)
+	{
+		tagIndex = s_threadTagStack[(s_threadTagDepth < MEMORY_TRACKER_TAG_STACK_DEPTH ? s_threadTagDepth : MEMORY_TRACKER_TAG_STACK_DEPTH) - 1];
+	}
+
+	header->byteCount = byteCount;
+	header->callsiteIndex = FindOrAddCallsite();
+	header->tagIndex = (uint16_t) tagIndex;
+	header->guard = MEMORY_TRACKER_GUARD;
+
+	AddAllocation(s_totalCounters, (int64_t) byteCount);
+	AddAllocation(s_tagCounters[tagIndex], (int64_t) byteCount);
+	AddAllocation(s_callsites[header->callsiteIndex].counters, (int64_t) byteCount);
+
+	return (header + 1);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Frees memory from Allocate(), taking it off the counters it was added to
+//
+void MemoryTracker::Free(void* memory)
+{
+	if (memory == nullptr)
+	{
+		return;
+	}
+
+	MemoryAllocationHeader_t* header = ((MemoryAllocationHeader_t*) memory) - 1;
+	ASSERT_OR_DIE(header->guard == MEMORY_TRACKER_GUARD, "Error: MemoryTracker::Free() called on memory it didn't allocate, or freed twice");
+
+	RemoveAllocation(s_totalCounters, (int64_t) header->byteCount);
+	RemoveAllocation(s_tagCounters[header->tagIndex], (int64_t) header->byteCount);
+	RemoveAllocation(s_callsites[header->callsiteIndex].counters, (int64_t) header->byteCount);
+
+	header->guard = 0;
+	free(header);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Global new and delete, replaced for the whole program so everything allocated with new is counted
+//
+void* operator new(size_t byteCount)
+{
+	void* memory = MemoryTracker::Allocate(byteCount);
+
+	if (memory == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+
+	return memory;
+}
+
+void* operator new[](size_t byteCount)											{ return operator new(byteCount); }
+void* operator new(size_t byteCount, const std::nothrow_t&) noexcept			{ return MemoryTracker::Allocate(byteCount); }
+void* operator new[](size_t byteCount, const std::nothrow_t&) noexcept			{ return MemoryTracker::Allocate(byteCount); }
+void operator delete(void* memory) noexcept										{ MemoryTracker::Free(memory); }
+void operator delete[](void* memory) noexcept									{ MemoryTracker::Free(memory); }
+void operator delete(void* memory, size_t byteCount) noexcept					{ UNUSED(byteCount); MemoryTracker::Free(memory); }
+void operator delete[](void* memory, size_t byteCount) noexcept					{ UNUSED(byteCount); MemoryTracker::Free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept				{ MemoryTracker::Free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept			{ MemoryTracker::Free(memory); }
+
+
+#else // If not defined, nothing is counted
+
+#pragma warning(push)
+#pragma warning(disable: 4100) // Ignore unused variable warnings
+bool				MemoryTracker::IsEnabled() { return false; }
+void				MemoryTracker::BeginFrame() {}
+void				MemoryTracker::PushTag(const char* tagName) {}
+void				MemoryTracker::PopTag() {}
+MemoryStats_t		MemoryTracker::GetTotalStats() { return MemoryStats_t(); }
+void				MemoryTracker::GetTagStats(std::vector<MemoryTagStats_t>& out_tags) { out_tags.clear(); }
+void				MemoryTracker::GetCallsiteStats(std::vector<MemoryCallsiteStats_t>& out_callsites) { out_callsites.clear(); }
+std::string			MemoryTracker::GetCallsiteName(int callsiteIndex) { return "(Unknown)"; }
+void				MemoryTracker::TakeSnapshot(MemorySnapshot_t& out_snapshot) { out_snapshot = MemorySnapshot_t(); }
+void*				MemoryTracker::Allocate(size_t byteCount) { return malloc(byteCount); }
+void				MemoryTracker::Free(void* memory) { free(memory); }
+#pragma warning(pop)
+
+#endif // MEMORY_TRACKING_ENABLED
+
+
+//-----------------------------------------------------------------------------------------------
+// Registers the memory report, snapshot and diff commands
+//
+void MemoryTracker::InitializeConsoleCommands()
+{
+	Command::Register("mem_report",		"Prints every tag and the top n callsites by live bytes, or by allocations last frame with -s frame.",	Command_MemoryReport);
+	Command::Register("mem_snapshot",	"Takes a snapshot of the memory counts to diff against later.",											Command_MemorySnapshot);
+	Command::Register("mem_diff",		"Prints the n callsites that changed most from snapshot a (or the latest) to b (or now).",		Command_MemoryDiff);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Prints the line to the console and the log, so reports can be compared after the run
+//
+void PrintMemoryLine(const Rgba& color, const std::string& text)
+{
+	ConsolePrintf(color, "%s", text.c_str());
+	LogTaggedPrintf("MEMORY", "%s", text.c_str());
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns false if the tracker isn't counting, after telling the console why
+//
+bool CheckMemoryTrackingEnabled()
+{
+	if (!MemoryTracker::IsEnabled())
+	{
+		ConsoleErrorf("Memory tracking isn't enabled, define MEMORY_TRACKING_ENABLED in EngineBuildPreferences.hpp");
+		return false;
+	}
+
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the snapshot with the ID, or the latest for -1; nullptr if it was never taken or has been dropped
+//
+MemorySnapshot_t* FindMemorySnapshot(int snapshotID)
+{
+#ifdef MEMORY_TRACKING_ENABLED
+	if (snapshotID < 0)
+	{
+		return (s_snapshots.size() > 0 ? s_snapshots.back() : nullptr);
+	}
+
+	for (int index = 0; index < (int) s_snapshots.size(); ++index)
+	{
+		if (s_snapshots[index]->id == snapshotID)
+		{
+			return s_snapshots[index];
+		}
+	}
+#else
+	UNUSED(snapshotID);
+#endif
+
+	return nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Prints the total, each tag and the top callsites
+//
+void Command_MemoryReport(Command& cmd)
+{
+	if (!CheckMemoryTrackingEnabled())
+	{
+		return;
+	}
+
+	int entryCount = 10;
+	std::string sortBy = "live";
+
+	cmd.GetParam("n", entryCount, &entryCount);
+	cmd.GetParam("s", sortBy, &sortBy);
+
+	bool sortByFrame = (sortBy == "frame");
+
+	MemoryStats_t total = MemoryTracker::GetTotalStats();
+	PrintMemoryLine(Rgba::GREEN, Stringf("Total: %.2f KB live in %lld allocations, %.2f KB peak, %llu allocations last frame",
+		(float) total.liveBytes / 1024.f, total.liveAllocationCount, (float) total.peakLiveBytes / 1024.f, total.frameAllocationCount));
+
+	std::vector<MemoryTagStats_t> tags;
+	MemoryTracker::GetTagStats(tags);
+
+	for (int tagIndex = 0; tagIndex < (int) tags.size(); ++tagIndex)
+	{
+		const MemoryStats_t& stats = tags[tagIndex].stats;
+		PrintMemoryLine(Rgba::WHITE, Stringf("  [%s] %.2f KB live in %lld allocations, %.2f KB peak, %llu allocations last frame",
+			tags[tagIndex].name.c_str(), (float) stats.liveBytes / 1024.f, stats.liveAllocationCount, (float) stats.peakLiveBytes / 1024.f, stats.frameAllocationCount));
+	}
+
+	std::vector<MemoryCallsiteStats_t> callsites;
+	MemoryTracker::GetCallsiteStats(callsites);
+
+	std::sort(callsites.begin(), callsites.end(), [sortByFrame](const MemoryCallsiteStats_t& a, const MemoryCallsiteStats_t& b)
+	{
+		return (sortByFrame ? a.stats.frameAllocationCount > b.stats.frameAllocationCount : a.stats.liveBytes > b.stats.liveBytes);
+	});
+
+	entryCount = MinInt(entryCount, (int) callsites.size());
+	PrintMemoryLine(Rgba::GREEN, Stringf("Top %i callsites by %s:", entryCount, (sortByFrame ? "allocations last frame" : "live bytes")));
+
+	for (int callsiteIndex = 0; callsiteIndex < entryCount; ++callsiteIndex)
+	{
+		const MemoryStats_t& stats = callsites[callsiteIndex].stats;
+		PrintMemoryLine(Rgba::WHITE, Stringf("  %.2f KB live in %lld, %llu last frame - %s",
+			(float) stats.liveBytes / 1024.f, stats.liveAllocationCount, stats.frameAllocationCount, MemoryTracker::GetCallsiteName(callsites[callsiteIndex].callsiteIndex).c_str()));
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Keeps a snapshot of the counts, dropping the oldest if there are too many
+//
+void Command_MemorySnapshot(Command& cmd)
+{
+	UNUSED(cmd);
+
+	if (!CheckMemoryTrackingEnabled())
+	{
+		return;
+	}
+
+#ifdef MEMORY_TRACKING_ENABLED
+	if ((int) s_snapshots.size() == MEMORY_TRACKER_MAX_SNAPSHOTS)
+	{
+		delete s_snapshots[0];
+		s_snapshots.erase(s_snapshots.begin());
+	}
+
+	MemorySnapshot_t* snapshot = new MemorySnapshot_t();
+	MemoryTracker::TakeSnapshot(*snapshot);
+	snapshot->id = s_nextSnapshotID++;
+
+	s_snapshots.push_back(snapshot);
+
+	PrintMemoryLine(Rgba::GREEN, Stringf("Took memory snapshot %i at frame %i, %.2f KB live", snapshot->id, snapshot->frameNumber, (float) snapshot->total.liveBytes / 1024.f));
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Prints the tags and callsites whose live bytes grew the most between two snapshots, and the
+// ones that allocated the most in between - leaks show in the first, allocation storms in the second
+//
+void Command_MemoryDiff(Command& cmd)
+{
+	if (!CheckMemoryTrackingEnabled())
+	{
+		return;
+	}
+
+	int firstID = -1;
+	int secondID = -1;
+	int entryCount = 10;
+
+	cmd.GetParam("a", firstID);
+	cmd.GetParam("b", secondID);
+	cmd.GetParam("n", entryCount, &entryCount);
+
+	MemorySnapshot_t* first = FindMemorySnapshot(firstID);
+	if (first == nullptr)
+	{
+		ConsoleErrorf("No memory snapshot to diff from, take one with mem_snapshot");
+		return;
+	}
+
+	MemorySnapshot_t now;
+	MemorySnapshot_t* second = &now;
+
+	if (secondID >= 0)
+	{
+		second = FindMemorySnapshot(secondID);
+		if (second == nullptr)
+		{
+			ConsoleErrorf("No memory snapshot %i to diff to", secondID);
+			return;
+		}
+	}
+	else
+	{
+		MemoryTracker::TakeSnapshot(now);
+	}
+
+	PrintMemoryLine(Rgba::GREEN, Stringf("Memory from frame %i to %i: %+.2f KB live, %+lld live allocations, %llu allocations made",
+		first->frameNumber, second->frameNumber, (float) (second->total.liveBytes - first->total.liveBytes) / 1024.f,
+		second->total.liveAllocationCount - first->total.liveAllocationCount, second->total.totalAllocationCount - first->total.totalAllocationCount));
+
+	// Tags are only ever added, so the first snapshot's are at the front of the second's
+	for (int tagIndex = 0; tagIndex < (int) second->tags.size(); ++tagIndex)
+	{
+		MemoryStats_t before = (tagIndex < (int) first->tags.size() ? first->tags[tagIndex].stats : MemoryStats_t());
+		const MemoryStats_t& after = second->tags[tagIndex].stats;
+
+		PrintMemoryLine(Rgba::WHITE, Stringf("  [%s] %+.2f KB live, %+lld live allocations, %llu allocations made", second->tags[tagIndex].name.c_str(),
+			(float) (after.liveBytes - before.liveBytes) / 1024.f, after.liveAllocationCount - before.liveAllocationCount, after.totalAllocationCount - before.totalAllocationCount));
+	}
+
+	// Callsite deltas
+	std::map<int, MemoryStats_t> firstCallsites;
+	for (int index = 0; index < (int) first->callsites.size(); ++index)
+	{
+		firstCallsites[first->callsites[index].callsiteIndex] = first->callsites[index].stats;
+	}
+
+	std::vector<MemoryCallsiteStats_t> deltas;
+	for (int index = 0; index < (int) second->callsites.size(); ++index)
+	{
+		MemoryCallsiteStats_t delta = second->callsites[index];
+		const MemoryStats_t& before = firstCallsites[delta.callsiteIndex];
+
+		delta.stats.liveBytes				-= before.liveBytes;
+		delta.stats.liveAllocationCount		-= before.liveAllocationCount;
+		delta.stats.totalAllocationCount	-= before.totalAllocationCount;
+
+		deltas.push_back(delta);
+	}
+
+	entryCount = MinInt(entryCount, (int) deltas.size());
+
+	std::sort(deltas.begin(), deltas.end(), [](const MemoryCallsiteStats_t& a, const MemoryCallsiteStats_t& b) { return a.stats.liveBytes > b.stats.liveBytes; });
+	PrintMemoryLine(Rgba::GREEN, Stringf("Top %i callsites by live bytes gained:", entryCount));
+
+	for (int index = 0; index < entryCount && deltas[index].stats.liveBytes > 0; ++index)
+	{
+		PrintMemoryLine(Rgba::WHITE, Stringf("  %+.2f KB live, %+lld live allocations - %s", (float) deltas[index].stats.liveBytes / 1024.f,
+			deltas[index].stats.liveAllocationCount, MemoryTracker::GetCallsiteName(deltas[index].callsiteIndex).c_str()));
+	}
+
+	std::sort(deltas.begin(), deltas.end(), [](const MemoryCallsiteStats_t& a, const MemoryCallsiteStats_t& b) { return a.stats.totalAllocationCount > b.stats.totalAllocationCount; });
+	PrintMemoryLine(Rgba::GREEN, Stringf("Top %i callsites by allocations made:", entryCount));
+
+	for (int index = 0; index < entryCount && deltas[index].stats.totalAllocationCount > 0; ++index)
+	{
+		PrintMemoryLine(Rgba::WHITE, Stringf("  %llu allocations - %s", deltas[index].stats.totalAllocationCount,
+			MemoryTracker::GetCallsiteName(deltas[index].callsiteIndex).c_str()));
+	}
+}
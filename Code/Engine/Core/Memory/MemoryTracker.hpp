@@ -0,0 +1,92 @@
+/************************************************************************/
+/* File: MemoryTracker.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Counts every heap allocation made through new by tag and
+/*				by callsite, with MEMORY_TRACKING_ENABLED defined in
+/*				EngineBuildPreferences.hpp
+/************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#define MEMORY_TRACKER_MAX_TAGS (64)
+#define MEMORY_TRACKER_TAG_STACK_DEPTH (16)
+#define MEMORY_TRACKER_MAX_CALLSITES (4096)			// Power of two - past it, allocations are counted on one overflow callsite
+#define MEMORY_TRACKER_CALLSTACK_DEPTH (8)			// Frames kept per callsite, to find the first one outside the allocator
+#define MEMORY_TRACKER_MAX_SNAPSHOTS (8)
+
+#define MEMORY_TAG_SCOPE_NAME_INNER(line) __memoryTag_##line
+#define MEMORY_TAG_SCOPE_NAME(line) MEMORY_TAG_SCOPE_NAME_INNER(line)
+#define MEMORY_TAG_SCOPE(tagName) MemoryTagScoped MEMORY_TAG_SCOPE_NAME(__LINE__)(tagName)
+
+// Counters for a tag, a callsite, or every allocation
+struct MemoryStats_t
+{
+	int64_t		liveBytes = 0;
+	int64_t		liveAllocationCount = 0;
+	int64_t		peakLiveBytes = 0;
+	uint64_t	totalAllocationCount = 0;		// Ever made
+	uint64_t	frameAllocationCount = 0;		// Made during the last frame
+};
+
+struct MemoryTagStats_t
+{
+	std::string		name;
+	MemoryStats_t	stats;
+};
+
+struct MemoryCallsiteStats_t
+{
+	int				callsiteIndex = -1;			// Stable for the whole run, so snapshots can be matched up by it
+	MemoryStats_t	stats;
+};
+
+// Every tag's and callsite's counts at one moment, for diffing against another
+struct MemorySnapshot_t
+{
+	int									id = -1;
+	int									frameNumber = 0;
+	MemoryStats_t						total;
+	std::vector<MemoryTagStats_t>		tags;
+	std::vector<MemoryCallsiteStats_t>	callsites;
+};
+
+
+class MemoryTracker
+{
+public:
+	//-----Public Methods-----
+
+	static bool				IsEnabled();
+	static void				InitializeConsoleCommands();
+	static void				BeginFrame();			// Rolls the per frame counts over, called by the Profiler
+
+	// Allocations are attributed to the innermost tag on the allocating thread; names must outlive the tracker
+	static void				PushTag(const char* tagName);
+	static void				PopTag();
+
+	// Accessors, only the callsites that have allocated are returned
+	static MemoryStats_t	GetTotalStats();
+	static void				GetTagStats(std::vector<MemoryTagStats_t>& out_tags);
+	static void				GetCallsiteStats(std::vector<MemoryCallsiteStats_t>& out_callsites);
+	static std::string		GetCallsiteName(int callsiteIndex);	// Symbolized, the first frame outside the allocator and the standard library
+	static void				TakeSnapshot(MemorySnapshot_t& out_snapshot);
+
+	// For the global operator new and delete
+	static void*			Allocate(size_t byteCount);
+	static void				Free(void* memory);
+
+};
+
+
+class MemoryTagScoped
+{
+public:
+	//-----Public Methods-----
+
+	MemoryTagScoped(const char* tagName)	{ MemoryTracker::PushTag(tagName); }
+	~MemoryTagScoped()						{ MemoryTracker::PopTag(); }
+
+};
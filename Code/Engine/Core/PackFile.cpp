@@ -0,0 +1,460 @@
+/************************************************************************/
+/* File: PackFile.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the PackFile class
+/************************************************************************/
+#include <algorithm>
+#include "Engine/Core/PackFile.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/VirtualFileSystem.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
+#include "ThirdParty/stb/stb_image.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+
+// The layout is the file format, so it can't change without a version bump
+static_assert(sizeof(PackFileHeader_t) == 32, "PackFileHeader_t changed size, bump PACK_FILE_VERSION");
+static_assert(sizeof(PackFileEntry_t) == 40, "PackFileEntry_t changed size, bump PACK_FILE_VERSION");
+
+// Compressed entries are only kept if they save at least 1/PACK_FILE_MIN_SAVING_FRACTION of the file,
+// otherwise reading them in place beats decompressing
+#define PACK_FILE_MIN_SAVING_FRACTION (8)
+
+// Defined with stb_image_write's implementation, which doesn't declare it in its header
+unsigned char* stbi_zlib_compress(unsigned char* data, int data_len, int* out_len, int quality);
+
+// A file found for packing
+struct PackSourceFile_t
+{
+	std::string diskPath;
+	std::string normalizedPath;
+	uint32_t	pathHash = 0;
+};
+
+static void		AddFilesInDirectory(const std::string& directory, std::vector<PackSourceFile_t>& out_files);
+static uint8_t*	ReadLooseFile(const std::string& filepath, size_t& out_size);
+static bool		WritePadding(FILE* fp, uint64_t& inout_offset);
+
+
+//-----------------------------------------------------------------------------------------------
+// Maps the pack and validates its tables
+//
+bool PackFile::Open(const std::string& filepath)
+{
+	PROFILE_SCOPE_CATEGORY("PackFile::Open", "Files");
+
+	m_filepath = filepath;
+
+	if (!m_file.OpenMappedFromDisk(filepath.c_str()))
+	{
+		LogTaggedPrintf("FILES", "Error: PackFile couldn't open \"%s\"", filepath.c_str());
+		return false;
+	}
+
+	if (!ValidateData())
+	{
+		m_file.Close();
+		m_header = nullptr;
+		m_entries = nullptr;
+		m_pathTable = nullptr;
+
+		return false;
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Binary searches the table for the path's hash, then compares paths in case of collisions
+//
+const PackFileEntry_t* PackFile::FindEntry(const std::string& normalizedPath, uint32_t pathHash) const
+{
+	if (m_entries == nullptr)
+	{
+		return nullptr;
+	}
+
+	const PackFileEntry_t* begin = m_entries;
+	const PackFileEntry_t* end = m_entries + m_header->entryCount;
+
+	const PackFileEntry_t* entry = std::lower_bound(begin, end, pathHash, [](const PackFileEntry_t& a, uint32_t hash)
+	{
+		return a.pathHash < hash;
+	});
+
+	for (; entry != end && entry->pathHash == pathHash; ++entry)
+	{
+		if (entry->pathLength == normalizedPath.size() && memcmp(m_pathTable + entry->pathOffset, normalizedPath.data(), entry->pathLength) == 0)
+		{
+			return entry;
+		}
+	}
+
+	return nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the entry's bytes as they're stored in the pack
+//
+const uint8_t* PackFile::GetStoredData(const PackFileEntry_t& entry) const
+{
+	return (const uint8_t*) m_file.GetData() + entry.dataOffset;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies or decompresses the entry into a new buffer, null terminated for text parsers
+// Only logs on failure, since this runs on the disk workers for async loads
+//
+char* PackFile::ReadToNewBuffer(const PackFileEntry_t& entry) const
+{
+	char* buffer = (char*) malloc((size_t) entry.size + 1U);
+
+	if ((entry.flags & PACK_ENTRY_FLAG_COMPRESSED) == 0)
+	{
+		memcpy(buffer, GetStoredData(entry), (size_t) entry.size);
+	}
+	else
+	{
+		int decompressedSize = stbi_zlib_decode_buffer(buffer, (int) entry.size, (const char*) GetStoredData(entry), (int) entry.storedSize);
+
+		if (decompressedSize != (int) entry.size)
+		{
+			LogTaggedPrintf("FILES", "Error: PackFile couldn't decompress \"%s\" from \"%s\"", GetEntryPath(entry).c_str(), m_filepath.c_str());
+			free(buffer);
+
+			return nullptr;
+		}
+	}
+
+	buffer[entry.size] = '\0';
+	return buffer;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of files in the pack
+//
+int PackFile::GetEntryCount() const
+{
+	return (m_header != nullptr ? (int) m_header->entryCount : 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the path the pack was opened from
+//
+const std::string& PackFile::GetFilePath() const
+{
+	return m_filepath;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// FNV-1a of the normalized path, the same on every platform so packs can be built anywhere
+//
+uint32_t PackFile::HashPath(const std::string& normalizedPath)
+{
+	uint32_t hash = 2166136261u;
+
+	for (size_t charIndex = 0; charIndex < normalizedPath.size(); ++charIndex)
+	{
+		hash = (hash ^ (uint32_t) (uint8_t) normalizedPath[charIndex]) * 16777619u;
+	}
+
+	return hash;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes a pack of every file under the directory, with paths as they'd be opened from the working directory
+// Reads loose files directly, so mounted packs don't end up packed into the new one
+//
+bool PackFile::WriteFromDirectory(const std::string& directory, const std::string& packPath, bool compressEntries)
+{
+	PROFILE_SCOPE_CATEGORY("PackFile::WriteFromDirectory", "Files");
+
+	std::vector<PackSourceFile_t> files;
+	AddFilesInDirectory(directory, files);
+
+	if (files.size() == 0)
+	{
+		LogTaggedPrintf("FILES", "Error: PackFile found no files to pack in \"%s\"", directory.c_str());
+		return false;
+	}
+
+	std::sort(files.begin(), files.end(), [](const PackSourceFile_t& a, const PackSourceFile_t& b)
+	{
+		return (a.pathHash != b.pathHash ? a.pathHash < b.pathHash : a.normalizedPath < b.normalizedPath);
+	});
+
+	// Tables go right after the header, with sizes known up front, so the data can be streamed after them
+	std::vector<PackFileEntry_t> entries(files.size());
+	std::string pathTable;
+
+	for (size_t fileIndex = 0; fileIndex < files.size(); ++fileIndex)
+	{
+		entries[fileIndex].pathHash = files[fileIndex].pathHash;
+		entries[fileIndex].pathOffset = (uint32_t) pathTable.size();
+		entries[fileIndex].pathLength = (uint32_t) files[fileIndex].normalizedPath.size();
+		pathTable += files[fileIndex].normalizedPath;
+	}
+
+	PackFileHeader_t header;
+	header.fourCC = PACK_FILE_FOURCC;
+	header.version = PACK_FILE_VERSION;
+	header.entryCount = (uint32_t) entries.size();
+	header.pathTableSize = (uint32_t) pathTable.size();
+	header.entryTableOffset = sizeof(PackFileHeader_t);
+	header.pathTableOffset = header.entryTableOffset + sizeof(PackFileEntry_t) * entries.size();
+
+	FILE* fp = OpenFile(packPath.c_str(), "wb");
+	if (fp == nullptr)
+	{
+		LogTaggedPrintf("FILES", "Error: PackFile couldn't open \"%s\" for writing", packPath.c_str());
+		return false;
+	}
+
+	// Tables are written last, once the entries know where their data went
+	uint64_t offset = header.pathTableOffset + pathTable.size();
+	fseek(fp, (long) offset, SEEK_SET);
+	bool succeeded = WritePadding(fp, offset);
+
+	uint64_t totalSize = 0;
+	uint64_t totalStoredSize = 0;
+
+	for (size_t fileIndex = 0; succeeded && fileIndex < files.size(); ++fileIndex)
+	{
+		size_t fileSize = 0;
+		uint8_t* fileData = ReadLooseFile(files[fileIndex].diskPath, fileSize);
+
+		if (fileData == nullptr)
+		{
+			LogTaggedPrintf("FILES", "Error: PackFile couldn't read \"%s\"", files[fileIndex].diskPath.c_str());
+			succeeded = false;
+			break;
+		}
+
+		const uint8_t* storedData = fileData;
+		size_t storedSize = fileSize;
+		uint8_t* compressedData = nullptr;
+
+		if (compressEntries && fileSize > 0 && fileSize <= INT_MAX)
+		{
+			int compressedSize = 0;
+			compressedData = stbi_zlib_compress(fileData, (int) fileSize, &compressedSize, 8);
+
+			if (compressedData != nullptr && (size_t) compressedSize < fileSize - (fileSize / PACK_FILE_MIN_SAVING_FRACTION))
+			{
+				storedData = compressedData;
+				storedSize = (size_t) compressedSize;
+				entries[fileIndex].flags |= PACK_ENTRY_FLAG_COMPRESSED;
+			}
+		}
+
+		entries[fileIndex].dataOffset = offset;
+		entries[fileIndex].storedSize = storedSize;
+		entries[fileIndex].size = fileSize;
+
+		succeeded = (fwrite(storedData, 1, storedSize, fp) == storedSize);
+		offset += storedSize;
+		succeeded = succeeded && WritePadding(fp, offset);
+
+		totalSize += fileSize;
+		totalStoredSize += storedSize;
+
+		free(compressedData);
+		free(fileData);
+	}
+
+	if (succeeded)
+	{
+		fseek(fp, 0L, SEEK_SET);
+		succeeded = (fwrite(&header, sizeof(PackFileHeader_t), 1, fp) == 1)
+			&& (fwrite(entries.data(), sizeof(PackFileEntry_t), entries.size(), fp) == entries.size())
+			&& (fwrite(pathTable.data(), 1, pathTable.size(), fp) == pathTable.size());
+	}
+
+	succeeded = CloseFile(fp) && succeeded;
+
+	if (!succeeded)
+	{
+		LogTaggedPrintf("FILES", "Error: PackFile couldn't write \"%s\"", packPath.c_str());
+		return false;
+	}
+
+	LogTaggedPrintf("FILES", "Packed %i files from \"%s\" into \"%s\", %.2f MB stored as %.2f MB", (int) files.size(), directory.c_str(), packPath.c_str(),
+		(float) totalSize / (1024.f * 1024.f), (float) totalStoredSize / (1024.f * 1024.f));
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Checks the tables are in bounds, sorted, and point at data inside the file
+//
+bool PackFile::ValidateData()
+{
+	size_t fileSize = m_file.GetSize();
+	const char* data = m_file.GetData();
+
+	if (data == nullptr || fileSize < sizeof(PackFileHeader_t))
+	{
+		LogTaggedPrintf("FILES", "Error: \"%s\" is too small to be a pack", m_filepath.c_str());
+		return false;
+	}
+
+	m_header = (const PackFileHeader_t*) data;
+
+	if (m_header->fourCC != PACK_FILE_FOURCC || m_header->version != PACK_FILE_VERSION)
+	{
+		LogTaggedPrintf("FILES", "Error: \"%s\" isn't a version %i pack, rebuild it", m_filepath.c_str(), PACK_FILE_VERSION);
+		return false;
+	}
+
+	uint64_t entryTableEnd = m_header->entryTableOffset + (uint64_t) m_header->entryCount * sizeof(PackFileEntry_t);
+	uint64_t pathTableEnd = m_header->pathTableOffset + m_header->pathTableSize;
+
+	if ((m_header->entryTableOffset % 8) != 0 || entryTableEnd > fileSize || pathTableEnd > fileSize)
+	{
+		LogTaggedPrintf("FILES", "Error: \"%s\" has its tables out of bounds", m_filepath.c_str());
+		return false;
+	}
+
+	m_entries = (const PackFileEntry_t*) (data + m_header->entryTableOffset);
+	m_pathTable = data + m_header->pathTableOffset;
+
+	for (uint32_t entryIndex = 0; entryIndex < m_header->entryCount; ++entryIndex)
+	{
+		const PackFileEntry_t& entry = m_entries[entryIndex];
+
+		bool isInBounds = ((uint64_t) entry.pathOffset + entry.pathLength <= m_header->pathTableSize)
+			&& (entry.dataOffset <= fileSize) && (entry.storedSize <= fileSize - entry.dataOffset);
+
+		bool isSorted = (entryIndex == 0 || m_entries[entryIndex - 1].pathHash <= entry.pathHash);
+		bool isStoredSizeValid = ((entry.flags & PACK_ENTRY_FLAG_COMPRESSED) != 0 ? entry.size <= INT_MAX : entry.storedSize == entry.size);
+
+		if (!isInBounds || !isSorted || !isStoredSizeValid)
+		{
+			LogTaggedPrintf("FILES", "Error: \"%s\" has an invalid entry at index %u", m_filepath.c_str(), entryIndex);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the entry's path, for logging
+//
+std::string PackFile::GetEntryPath(const PackFileEntry_t& entry) const
+{
+	return std::string(m_pathTable + entry.pathOffset, entry.pathLength);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Adds every file under the directory, recursing into subdirectories
+//
+static void AddFilesInDirectory(const std::string& directory, std::vector<PackSourceFile_t>& out_files)
+{
+	WIN32_FIND_DATAA findData;
+	HANDLE findHandle = FindFirstFileA((directory + "/*").c_str(), &findData);
+
+	if (findHandle == INVALID_HANDLE_VALUE)
+	{
+		return;
+	}
+
+	do
+	{
+		std::string name = findData.cFileName;
+
+		if (name == "." || name == "..")
+		{
+			continue;
+		}
+
+		std::string diskPath = directory + "/" + name;
+		std::string normalizedPath = VirtualFileSystem::NormalizePath(diskPath);
+
+		if ((findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+		{
+			if (VirtualFileSystem::NormalizePath(name) != PACK_FILE_EXCLUDED_DIRECTORY)
+			{
+				AddFilesInDirectory(diskPath, out_files);
+			}
+
+			continue;
+		}
+
+		// Packs aren't packed into each other
+		bool isPack = (normalizedPath.size() >= strlen(PACK_FILE_EXTENSION)
+			&& normalizedPath.compare(normalizedPath.size() - strlen(PACK_FILE_EXTENSION), std::string::npos, PACK_FILE_EXTENSION) == 0);
+
+		if (!isPack)
+		{
+			PackSourceFile_t file;
+			file.diskPath = diskPath;
+			file.normalizedPath = normalizedPath;
+			file.pathHash = PackFile::HashPath(normalizedPath);
+
+			out_files.push_back(file);
+		}
+
+	} while (FindNextFileA(findHandle, &findData));
+
+	FindClose(findHandle);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Reads a loose file from disk into a malloc'd buffer, skipping the VirtualFileSystem
+//
+static uint8_t* ReadLooseFile(const std::string& filepath, size_t& out_size)
+{
+	out_size = 0;
+
+	FILE* fp = OpenFile(filepath.c_str(), "rb");
+	if (fp == nullptr)
+	{
+		return nullptr;
+	}
+
+	fseek(fp, 0L, SEEK_END);
+	long fileSize = ftell(fp);
+	fseek(fp, 0L, SEEK_SET);
+
+	// Empty files are still packed, so they exist in the pack like they did on disk
+	uint8_t* buffer = (uint8_t*) malloc(fileSize > 0 ? (size_t) fileSize : 1U);
+	out_size = (fileSize > 0 ? fread(buffer, 1, (size_t) fileSize, fp) : 0);
+
+	CloseFile(fp);
+	return buffer;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Writes zeroes up to the next PACK_FILE_DATA_ALIGNMENT boundary
+//
+static bool WritePadding(FILE* fp, uint64_t& inout_offset)
+{
+	static const uint8_t s_zeroes[PACK_FILE_DATA_ALIGNMENT] = {};
+
+	size_t paddingSize = (size_t) ((PACK_FILE_DATA_ALIGNMENT - (inout_offset % PACK_FILE_DATA_ALIGNMENT)) % PACK_FILE_DATA_ALIGNMENT);
+	inout_offset += paddingSize;
+
+	return (paddingSize == 0 || fwrite(s_zeroes, 1, paddingSize, fp) == paddingSize);
+}
@@ -0,0 +1,104 @@
+/************************************************************************/
+/* File: PackFile.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: An archive of many data files behind one mapped handle,
+/*				with a table of contents sorted by path hash so finding
+/*				a file is a binary search instead of an open and stat
+/************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "Engine/Core/File.hpp"
+
+// "EPAK" in the file, read as a little endian uint32
+#define PACK_FILE_FOURCC (0x4B415045)
+
+// Bump whenever the layout below changes, old packs are rejected and need rebuilding
+#define PACK_FILE_VERSION (1)
+
+// Entry data starts on this boundary, so mapped views of uncompressed entries can be read in place
+#define PACK_FILE_DATA_ALIGNMENT (16)
+
+#define PACK_FILE_EXTENSION ".pak"
+
+// Written at runtime rather than loaded, so never packed
+#define PACK_FILE_EXCLUDED_DIRECTORY "logs"
+
+enum ePackEntryFlags
+{
+	PACK_ENTRY_FLAG_COMPRESSED = (1 << 0)	// Zlib stream, decompressed into its own buffer when opened
+};
+
+struct PackFileHeader_t
+{
+	uint32_t fourCC;
+	uint32_t version;
+	uint32_t entryCount;
+	uint32_t pathTableSize;
+
+	uint64_t entryTableOffset;
+	uint64_t pathTableOffset;
+};
+
+// Sorted by pathHash then path; paths are normalized (see VirtualFileSystem::NormalizePath) and not null terminated
+struct PackFileEntry_t
+{
+	uint32_t pathHash;
+	uint32_t flags;
+	uint32_t pathOffset;		// Into the path table
+	uint32_t pathLength;
+
+	uint64_t dataOffset;		// From the start of the file
+	uint64_t storedSize;		// Bytes in the file, compressed or not
+	uint64_t size;				// Bytes once decompressed
+};
+
+
+class PackFile
+{
+public:
+	//-----Public Methods-----
+
+	PackFile() {}
+	~PackFile() {}
+
+	// Maps the pack and checks every entry fits in it; safe to call off the main thread
+	bool					Open(const std::string& filepath);
+
+	// Returns the entry for the normalized path, or nullptr if the pack doesn't have it
+	const PackFileEntry_t*	FindEntry(const std::string& normalizedPath, uint32_t pathHash) const;
+
+	// The entry's bytes as stored, pointing into the mapped pack
+	const uint8_t*			GetStoredData(const PackFileEntry_t& entry) const;
+
+	// Returns the entry's contents in a new malloc'd buffer with a null after them, or nullptr if it can't be decompressed
+	char*					ReadToNewBuffer(const PackFileEntry_t& entry) const;
+
+	int						GetEntryCount() const;
+	const std::string&		GetFilePath() const;
+
+	static uint32_t			HashPath(const std::string& normalizedPath);
+
+	// Packs every file under the directory (except PACK_FILE_EXCLUDED_DIRECTORY), compressing those it shrinks if asked
+	static bool				WriteFromDirectory(const std::string& directory, const std::string& packPath, bool compressEntries);
+
+
+private:
+	//-----Private Methods-----
+
+	bool					ValidateData();
+	std::string				GetEntryPath(const PackFileEntry_t& entry) const;
+
+
+private:
+	//-----Private Data-----
+
+	File					m_file;		// Mapped for as long as the pack is open
+	std::string				m_filepath;
+	const PackFileHeader_t*	m_header = nullptr;
+	const PackFileEntry_t*	m_entries = nullptr;
+	const char*				m_pathTable = nullptr;
+
+};
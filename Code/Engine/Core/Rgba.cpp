@@ -10,44 +10,21 @@
 #include "Engine/Math/MathUtils.hpp"
 #include <string>
 
-// Defining the constant color values
-const Rgba Rgba::WHITE			= Rgba();
-const Rgba Rgba::CYAN			= Rgba(0, 255, 255, 255);
-const Rgba Rgba::MAGENTA		= Rgba(255, 0, 255, 255);
-const Rgba Rgba::YELLOW			= Rgba(255, 255, 0, 255);
-const Rgba Rgba::RED			= Rgba(255, 0, 0, 255);
-const Rgba Rgba::BLUE			= Rgba(0, 0, 255, 255);
-const Rgba Rgba::ORANGE			= Rgba(255, 128, 0, 255);
-const Rgba Rgba::PURPLE			= Rgba(128, 0, 255, 255);
-const Rgba Rgba::GREEN			= Rgba(0, 255, 0, 255);
-const Rgba Rgba::LIGHT_BLUE		= Rgba(0, 128, 255, 255);
-const Rgba Rgba::BROWN			= Rgba(153, 76, 0, 255);
-const Rgba Rgba::BLACK			= Rgba(0, 0, 0, 255);
-const Rgba Rgba::GRAY			= Rgba(128, 128, 128, 255);
-const Rgba Rgba::DARK_GREEN		= Rgba(100, 200, 0, 255);
-
-//-----------------------------------------------------------------------------------------------
-// Default constructor - initializes it to opaque white
-//
-Rgba::Rgba()
-	: r(static_cast<unsigned char>(255))
-	, g(static_cast<unsigned char>(255))
-	, b(static_cast<unsigned char>(255))
-	, a(static_cast<unsigned char>(255))
-{
-}
-
-
-//-----------------------------------------------------------------------------------------------
-// Constructor for explicit byte values
-//
-Rgba::Rgba(unsigned char redByte, unsigned char greenByte, unsigned char blueByte, unsigned char alphabyte)
-	: r(redByte)
-	, g(greenByte)
-	, b(blueByte)
-	, a(alphabyte)
-{
-}
+// Defining the constant color values - constexpr, so they're baked into the image instead of set up at startup
+constexpr Rgba Rgba::WHITE			= Rgba();
+constexpr Rgba Rgba::CYAN			= Rgba(0, 255, 255, 255);
+constexpr Rgba Rgba::MAGENTA		= Rgba(255, 0, 255, 255);
+constexpr Rgba Rgba::YELLOW			= Rgba(255, 255, 0, 255);
+constexpr Rgba Rgba::RED			= Rgba(255, 0, 0, 255);
+constexpr Rgba Rgba::BLUE			= Rgba(0, 0, 255, 255);
+constexpr Rgba Rgba::ORANGE			= Rgba(255, 128, 0, 255);
+constexpr Rgba Rgba::PURPLE			= Rgba(128, 0, 255, 255);
+constexpr Rgba Rgba::GREEN			= Rgba(0, 255, 0, 255);
+constexpr Rgba Rgba::LIGHT_BLUE		= Rgba(0, 128, 255, 255);
+constexpr Rgba Rgba::BROWN			= Rgba(153, 76, 0, 255);
+constexpr Rgba Rgba::BLACK			= Rgba(0, 0, 0, 255);
+constexpr Rgba Rgba::GRAY			= Rgba(128, 128, 128, 255);
+constexpr Rgba Rgba::DARK_GREEN		= Rgba(100, 200, 0, 255);
 
 
 //-----------------------------------------------------------------------------------------------
@@ -59,15 +36,6 @@ Rgba::Rgba(float red, float green, float blue, float alpha)
 }
 
 
-//-----------------------------------------------------------------------------------------------
-// Sets the values of the rgba to the int values provided
-//
-Rgba::Rgba(int red, int green, int blue, int alpha)
-{
-	SetAsInts(red, green, blue, alpha);
-}
-
-
 //-----------------------------------------------------------------------------------------------
 // Sets the values of the rgba to the byte values provided
 //
@@ -275,18 +243,3 @@ Rgba Rgba::GetRandomColor()
 
 	return Rgba(red, green, blue, (unsigned char)255);
 }
-
-
-//-----------------------------------------------------------------------------------------------
-// Comparison for Rgba's
-//
-bool Rgba::operator==(const Rgba& other) const
-{
-	bool rEquals = (r == other.r);
-	bool gEquals = (g == other.g);
-	bool bEquals = (b == other.b);
-	bool aEquals = (a == other.a);
-
-	return (rEquals && gEquals && bEquals && aEquals);
-}
-
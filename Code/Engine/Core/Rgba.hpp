@@ -14,15 +14,15 @@ class Rgba
 public:
 
 	// Default constructor - initializes it to opaque white
-	Rgba();
+	constexpr Rgba();
 	// Construct from individual byte values
-	explicit Rgba(unsigned char redByte, unsigned char greenByte, unsigned char blueByte, unsigned char alphabyte=255);
+	constexpr explicit Rgba(unsigned char redByte, unsigned char greenByte, unsigned char blueByte, unsigned char alphabyte=255);
 	
 	// Construct from normalized float values
 	explicit Rgba(float red, float green, float blue, float alpha);
 
 	// Construct from int values
-	explicit Rgba(int red, int green, int blue, int alpha);
+	constexpr explicit Rgba(int red, int green, int blue, int alpha);
 
 	// Sets all values by byte
 	void SetAsBytes(unsigned char redByte, unsigned char greenByte, unsigned char blueByte, unsigned char alphabyte=255);
@@ -46,7 +46,7 @@ public:
 	bool SetFromText(const char* text);
 	
 	// Operators
-	bool	operator==(const Rgba& other) const;
+	constexpr bool	operator==(const Rgba& other) const;
 
 	static Rgba GetRandomColor();
 
@@ -79,3 +79,58 @@ public:
 	static const Rgba GRAY;
 	static const Rgba DARK_GREEN;
 };
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Constexpr definitions - in the header so constants and tables built from
+// them are worked out at compile time
+///////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------------------------
+// Default constructor - initializes it to opaque white
+//
+constexpr Rgba::Rgba()
+	: r(static_cast<unsigned char>(255))
+	, g(static_cast<unsigned char>(255))
+	, b(static_cast<unsigned char>(255))
+	, a(static_cast<unsigned char>(255))
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor for explicit byte values
+//
+constexpr Rgba::Rgba(unsigned char redByte, unsigned char greenByte, unsigned char blueByte, unsigned char alphabyte)
+	: r(redByte)
+	, g(greenByte)
+	, b(blueByte)
+	, a(alphabyte)
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the values of the rgba to the int values provided
+//
+constexpr Rgba::Rgba(int red, int green, int blue, int alpha)
+	: r((unsigned char)red)
+	, g((unsigned char)green)
+	, b((unsigned char)blue)
+	, a((unsigned char)alpha)
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Comparison for Rgba's
+//
+constexpr bool Rgba::operator==(const Rgba& other) const
+{
+	bool rEquals = (r == other.r);
+	bool gEquals = (g == other.g);
+	bool bEquals = (b == other.b);
+	bool aEquals = (a == other.a);
+
+	return (rEquals && gEquals && bEquals && aEquals);
+}
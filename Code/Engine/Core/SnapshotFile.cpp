@@ -0,0 +1,460 @@
+/************************************************************************/
+/* File: SnapshotFile.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the SnapshotWriter and SnapshotReader classes
+/************************************************************************/
+#include <algorithm>
+#include <string.h>
+#include "Engine/Core/SnapshotFile.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/JobSystem/FunctionJob.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
+
+// The layout is the file format, so it can't change without a version bump
+static_assert(sizeof(SnapshotFileHeader_t) == 32, "SnapshotFileHeader_t changed size, bump SNAPSHOT_FILE_VERSION");
+static_assert(sizeof(SnapshotSectionEntry_t) == 32, "SnapshotSectionEntry_t changed size, bump SNAPSHOT_FILE_VERSION");
+static_assert((sizeof(SnapshotFileHeader_t) % SNAPSHOT_DATA_ALIGNMENT) == 0, "SnapshotFileHeader_t must keep the first section aligned");
+
+// Starting size of the writer's buffer, it doubles from here
+#define SNAPSHOT_INITIAL_BUFFER_SIZE (64 * 1024)
+
+static bool WriteSnapshotToFile(const std::string& filepath, const void* data, size_t size);
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor, leaving room for the header
+//
+SnapshotWriter::SnapshotWriter(uint32_t userVersion /*= 0*/)
+	: m_userVersion(userVersion)
+{
+	m_packer = new BytePacker(SNAPSHOT_INITIAL_BUFFER_SIZE, true, LITTLE_ENDIAN);
+	m_packer->AdvanceWriteHead(sizeof(SnapshotFileHeader_t));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+SnapshotWriter::~SnapshotWriter()
+{
+	delete m_packer;
+	m_packer = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts a packed section at the next aligned offset, returning the packer to write it with
+//
+BytePacker* SnapshotWriter::BeginSection(const char* name)
+{
+	ASSERT_OR_DIE(!m_isInSection, Stringf("Error: SnapshotWriter::BeginSection() called for \"%s\" before the last section ended", name));
+
+	AddSection(name, SNAPSHOT_SECTION_PACKED, 1U, 0U, nullptr);
+	m_isInSection = true;
+
+	return m_packer;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Ends the packed section, sizing it to what was written
+//
+void SnapshotWriter::EndSection()
+{
+	ASSERT_OR_DIE(m_isInSection, "Error: SnapshotWriter::EndSection() called with no section begun");
+
+	m_packer->FlushBits();
+
+	SnapshotSectionEntry_t& entry = m_sections.back();
+	entry.elementCount = (uint64_t) m_packer->GetWrittenByteCount() - entry.dataOffset;
+
+	m_isInSection = false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Appends the directory sorted by name hash, then goes back to fill in the header
+//
+void SnapshotWriter::Finalize()
+{
+	if (m_isFinalized)
+	{
+		return;
+	}
+
+	ASSERT_OR_DIE(!m_isInSection, "Error: SnapshotWriter::Finalize() called before the last section ended");
+
+	std::sort(m_sections.begin(), m_sections.end(), [](const SnapshotSectionEntry_t& a, const SnapshotSectionEntry_t& b)
+	{
+		return a.nameHash < b.nameHash;
+	});
+
+	AlignWriteHead();
+
+	SnapshotFileHeader_t header;
+	header.fourCC = SNAPSHOT_FILE_FOURCC;
+	header.version = SNAPSHOT_FILE_VERSION;
+	header.userVersion = m_userVersion;
+	header.sectionCount = (uint32_t) m_sections.size();
+	header.directoryOffset = (uint64_t) m_packer->GetWrittenByteCount();
+	header.totalSize = header.directoryOffset + sizeof(SnapshotSectionEntry_t) * m_sections.size();
+
+	if (m_sections.size() > 0)
+	{
+		m_packer->WriteBytes(sizeof(SnapshotSectionEntry_t) * m_sections.size(), m_sections.data());
+	}
+
+	// Header goes over the space left for it at the start
+	m_packer->ResetWrite();
+	m_packer->WriteBytes(sizeof(SnapshotFileHeader_t), &header);
+	m_packer->AdvanceWriteHead((size_t) header.totalSize - sizeof(SnapshotFileHeader_t));
+
+	m_isFinalized = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the finished snapshot
+//
+const void* SnapshotWriter::GetData()
+{
+	Finalize();
+	return m_packer->GetBuffer();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the size of the finished snapshot, in bytes
+//
+size_t SnapshotWriter::GetSize()
+{
+	Finalize();
+	return m_packer->GetWrittenByteCount();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the snapshot to disk on this thread
+//
+bool SnapshotWriter::WriteToFile(const std::string& filepath)
+{
+	PROFILE_SCOPE_CATEGORY("SnapshotWriter::WriteToFile", "Files");
+
+	Finalize();
+	return WriteSnapshotToFile(filepath, m_packer->GetBuffer(), m_packer->GetWrittenByteCount());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Gives the buffer to a disk worker job to write and free, so the game thread only pays for the finalize
+//
+int SnapshotWriter::WriteToFileAsync(const std::string& filepath)
+{
+	Finalize();
+
+	BytePacker* packer = m_packer;
+	std::string* path = new std::string(filepath);
+
+	auto write = [packer, path]()
+	{
+		WriteSnapshotToFile(*path, packer->GetBuffer(), packer->GetWrittenByteCount());
+
+		delete packer;
+		delete path;
+	};
+
+	// Start over, so the writer can be reused for the next snapshot
+	m_packer = new BytePacker(SNAPSHOT_INITIAL_BUFFER_SIZE, true, LITTLE_ENDIAN);
+	m_packer->AdvanceWriteHead(sizeof(SnapshotFileHeader_t));
+	m_sections.clear();
+	m_isFinalized = false;
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+
+	if (jobSystem != nullptr)
+	{
+		return jobSystem->QueueJob(new FunctionJob(write, JOB_PRIORITY_BACKGROUND, WORKER_FLAGS_DISK));
+	}
+
+	write();
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a directory entry at the next aligned offset, copying the data in raw if there is any
+// Raw copies skip the packer's endian swap, since arrays are read back in place
+//
+void SnapshotWriter::AddSection(const char* name, eSnapshotSectionType type, uint32_t elementSize, uint64_t elementCount, const void* data)
+{
+	ASSERT_OR_DIE(!m_isFinalized, Stringf("Error: SnapshotWriter added section \"%s\" after the snapshot was finalized", name));
+	ASSERT_OR_DIE(!m_isInSection, Stringf("Error: SnapshotWriter added section \"%s\" inside another section", name));
+
+	SnapshotSectionEntry_t entry;
+	entry.nameHash = HashSnapshotSectionName(name);
+	entry.type = (uint32_t) type;
+	entry.elementSize = elementSize;
+	entry.elementCount = elementCount;
+
+	for (size_t sectionIndex = 0; sectionIndex < m_sections.size(); ++sectionIndex)
+	{
+		GUARANTEE_OR_DIE(m_sections[sectionIndex].nameHash != entry.nameHash, Stringf("Error: SnapshotWriter section \"%s\" was added twice or collides with another name", name));
+	}
+
+	AlignWriteHead();
+	entry.dataOffset = (uint64_t) m_packer->GetWrittenByteCount();
+
+	size_t byteCount = (size_t) (elementSize * elementCount);
+
+	if (byteCount > 0)
+	{
+		m_packer->Reserve(m_packer->GetWrittenByteCount() + byteCount);
+		memcpy(m_packer->GetWriteHead(), data, byteCount);
+		m_packer->AdvanceWriteHead(byteCount);
+	}
+
+	m_sections.push_back(entry);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Pads with zeros up to the next SNAPSHOT_DATA_ALIGNMENT boundary
+//
+void SnapshotWriter::AlignWriteHead()
+{
+	static const uint8_t s_padding[SNAPSHOT_DATA_ALIGNMENT] = {};
+
+	size_t remainder = m_packer->GetWrittenByteCount() % SNAPSHOT_DATA_ALIGNMENT;
+
+	if (remainder != 0)
+	{
+		m_packer->WriteBytes(SNAPSHOT_DATA_ALIGNMENT - remainder, s_padding);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Maps the snapshot and validates its directory
+//
+bool SnapshotReader::OpenFile(const std::string& filepath)
+{
+	PROFILE_SCOPE_CATEGORY("SnapshotReader::OpenFile", "Files");
+
+	Close();
+
+	if (!m_file.OpenMapped(filepath.c_str()))
+	{
+		LogTaggedPrintf("FILES", "Error: SnapshotReader couldn't open \"%s\"", filepath.c_str());
+		return false;
+	}
+
+	m_data = (const uint8_t*) m_file.GetData();
+	m_size = m_file.GetSize();
+
+	if (!ValidateData(filepath))
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads the snapshot from memory the caller keeps alive, i.e. one received over the network
+//
+bool SnapshotReader::OpenFromMemory(const void* data, size_t size)
+{
+	Close();
+
+	m_data = (const uint8_t*) data;
+	m_size = size;
+
+	if (!ValidateData("memory"))
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Releases the snapshot, invalidating any arrays returned from it
+//
+void SnapshotReader::Close()
+{
+	if (m_file.GetData() != nullptr)
+	{
+		m_file.Close();
+	}
+
+	m_data = nullptr;
+	m_size = 0;
+	m_header = nullptr;
+	m_sections = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the game's state version the snapshot was written with
+//
+uint32_t SnapshotReader::GetUserVersion() const
+{
+	return (m_header != nullptr ? m_header->userVersion : 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of sections in the snapshot
+//
+int SnapshotReader::GetSectionCount() const
+{
+	return (m_header != nullptr ? (int) m_header->sectionCount : 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the snapshot has a section of the given name
+//
+bool SnapshotReader::HasSection(const char* name) const
+{
+	return (FindSection(name) != nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a non-owning packer over the section, for reading with the BytePacker functions
+//
+BytePacker SnapshotReader::GetSectionPacker(const char* name) const
+{
+	size_t byteCount = 0;
+	void* data = const_cast<void*>(GetSectionData(name, SNAPSHOT_SECTION_PACKED, 1U, byteCount));
+
+	BytePacker packer(byteCount, data, false, LITTLE_ENDIAN);
+	packer.AdvanceWriteHead(byteCount);
+
+	return packer;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Checks the header and directory, and that every section is aligned and inside the snapshot
+// Only the directory is touched, so a mapped file doesn't page in any section data here
+//
+bool SnapshotReader::ValidateData(const std::string& source)
+{
+	if (m_data == nullptr || m_size < sizeof(SnapshotFileHeader_t) || ((size_t) m_data % SNAPSHOT_DATA_ALIGNMENT) != 0)
+	{
+		LogTaggedPrintf("FILES", "Error: Snapshot from \"%s\" is too small or misaligned", source.c_str());
+		return false;
+	}
+
+	m_header = (const SnapshotFileHeader_t*) m_data;
+
+	if (m_header->fourCC != SNAPSHOT_FILE_FOURCC || m_header->version != SNAPSHOT_FILE_VERSION)
+	{
+		LogTaggedPrintf("FILES", "Error: Snapshot from \"%s\" isn't a version %i snapshot", source.c_str(), SNAPSHOT_FILE_VERSION);
+		return false;
+	}
+
+	uint64_t directoryEnd = m_header->directoryOffset + (uint64_t) m_header->sectionCount * sizeof(SnapshotSectionEntry_t);
+
+	if (m_header->totalSize > m_size || (m_header->directoryOffset % SNAPSHOT_DATA_ALIGNMENT) != 0 || directoryEnd > m_header->totalSize)
+	{
+		LogTaggedPrintf("FILES", "Error: Snapshot from \"%s\" is truncated or has its directory out of bounds", source.c_str());
+		return false;
+	}
+
+	m_sections = (const SnapshotSectionEntry_t*) (m_data + m_header->directoryOffset);
+
+	for (uint32_t sectionIndex = 0; sectionIndex < m_header->sectionCount; ++sectionIndex)
+	{
+		const SnapshotSectionEntry_t& entry = m_sections[sectionIndex];
+
+		bool isTypeValid = (entry.type == SNAPSHOT_SECTION_ARRAY || (entry.type == SNAPSHOT_SECTION_PACKED && entry.elementSize == 1));
+		bool isAligned = ((entry.dataOffset % SNAPSHOT_DATA_ALIGNMENT) == 0);
+		bool isInBounds = (entry.dataOffset <= m_header->directoryOffset)
+			&& (entry.elementSize == 0 || entry.elementCount <= (m_header->directoryOffset - entry.dataOffset) / entry.elementSize);
+		bool isSorted = (sectionIndex == 0 || m_sections[sectionIndex - 1].nameHash < entry.nameHash);
+
+		if (!isTypeValid || !isAligned || !isInBounds || !isSorted)
+		{
+			LogTaggedPrintf("FILES", "Error: Snapshot from \"%s\" has an invalid section at index %u", source.c_str(), sectionIndex);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Binary searches the directory for the name's hash
+//
+const SnapshotSectionEntry_t* SnapshotReader::FindSection(const char* name) const
+{
+	if (m_sections == nullptr)
+	{
+		return nullptr;
+	}
+
+	uint32_t nameHash = HashSnapshotSectionName(name);
+
+	const SnapshotSectionEntry_t* begin = m_sections;
+	const SnapshotSectionEntry_t* end = m_sections + m_header->sectionCount;
+
+	const SnapshotSectionEntry_t* entry = std::lower_bound(begin, end, nameHash, [](const SnapshotSectionEntry_t& a, uint32_t hash)
+	{
+		return a.nameHash < hash;
+	});
+
+	return (entry != end && entry->nameHash == nameHash ? entry : nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the section's data in place if it's there with the expected layout, otherwise nullptr
+//
+const void* SnapshotReader::GetSectionData(const char* name, eSnapshotSectionType type, uint32_t elementSize, size_t& out_elementCount) const
+{
+	out_elementCount = 0;
+	const SnapshotSectionEntry_t* entry = FindSection(name);
+
+	if (entry == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (entry->type != (uint32_t) type || entry->elementSize != elementSize)
+	{
+		LogTaggedPrintf("FILES", "Error: Snapshot section \"%s\" doesn't have the layout asked for, element size %u", name, entry->elementSize);
+		return nullptr;
+	}
+
+	out_elementCount = (size_t) entry->elementCount;
+	return (m_data + entry->dataOffset);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Writes the whole snapshot in one go, logging on failure since this runs on the disk worker
+//
+static bool WriteSnapshotToFile(const std::string& filepath, const void* data, size_t size)
+{
+	File file;
+	if (!file.Open(filepath.c_str(), "wb"))
+	{
+		LogTaggedPrintf("FILES", "Error: Snapshot couldn't open \"%s\" for writing", filepath.c_str());
+		return false;
+	}
+
+	file.Write((const char*) data, size);
+	file.Close();
+
+	return true;
+}
@@ -0,0 +1,212 @@
+/************************************************************************/
+/* File: SnapshotFile.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Versioned binary snapshot of game state, for quicksaves,
+/*				server migration and late join - named sections of raw
+/*				POD arrays or BytePacker data behind a sorted directory,
+/*				laid out so a mapped file is read in place
+/************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <type_traits>
+#include "Engine/Core/File.hpp"
+#include "Engine/Networking/BytePacker.hpp"
+
+// "ESNP" in the file, read as a little endian uint32
+#define SNAPSHOT_FILE_FOURCC (0x504E5345)
+
+// Bump whenever the layout below changes; the game's own state version is separate, see GetUserVersion()
+#define SNAPSHOT_FILE_VERSION (1)
+
+// Section data starts on this boundary, so arrays of anything up to this alignment are read in place
+#define SNAPSHOT_DATA_ALIGNMENT (16)
+
+enum eSnapshotSectionType : uint32_t
+{
+	SNAPSHOT_SECTION_ARRAY = 0,		// elementCount elements of elementSize bytes, as they were in memory
+	SNAPSHOT_SECTION_PACKED			// Written and read with the BytePacker functions
+};
+
+struct SnapshotFileHeader_t
+{
+	uint32_t fourCC;
+	uint32_t version;
+	uint32_t userVersion;
+	uint32_t sectionCount;
+
+	uint64_t directoryOffset;
+	uint64_t totalSize;
+};
+
+// Sorted by nameHash, so finding a section is a binary search and only touches the directory
+struct SnapshotSectionEntry_t
+{
+	uint32_t nameHash;
+	uint32_t type;
+	uint32_t elementSize;		// 1 for packed sections
+	uint32_t padding = 0;
+
+	uint64_t elementCount;
+	uint64_t dataOffset;		// From the start of the snapshot, a multiple of SNAPSHOT_DATA_ALIGNMENT
+};
+
+// FNV-1a of a section name
+constexpr uint32_t HashSnapshotSectionName(const char* name, uint32_t hash = 2166136261u)
+{
+	return (*name == '\0' ? hash : HashSnapshotSectionName(name + 1, (hash ^ (uint32_t) (uint8_t) *name) * 16777619u));
+}
+
+
+class SnapshotWriter
+{
+public:
+	//-----Public Methods-----
+
+	// userVersion is the game's version of its state, for the reader to check or convert from
+	SnapshotWriter(uint32_t userVersion = 0);
+	~SnapshotWriter();
+
+	// Arrays are copied as is, so only types that are safe to memcpy, and pointers mean nothing on load
+	template <typename T> void	WriteArray(const char* name, const T* elements, size_t elementCount);
+	template <typename T> void	WriteArray(const char* name, const std::vector<T>& elements);
+
+	// Everything written to the returned packer until EndSection() goes in the section
+	BytePacker*					BeginSection(const char* name);
+	void						EndSection();
+
+	// Writes the directory and header; no sections can be added after
+	void						Finalize();
+
+	// The whole snapshot, i.e. for sending to a joining client - finalizes first
+	const void*					GetData();
+	size_t						GetSize();
+
+	bool						WriteToFile(const std::string& filepath);
+
+	// Hands the snapshot to the disk worker to write, leaving the writer empty; returns the job ID to
+	// wait on, or -1 if it was written here since there's no JobSystem
+	int							WriteToFileAsync(const std::string& filepath);
+
+
+private:
+	//-----Private Methods-----
+
+	SnapshotWriter(const SnapshotWriter& copy) = delete;
+
+	void						AddSection(const char* name, eSnapshotSectionType type, uint32_t elementSize, uint64_t elementCount, const void* data);
+	void						AlignWriteHead();
+
+
+private:
+	//-----Private Data-----
+
+	BytePacker*							m_packer = nullptr;
+	uint32_t							m_userVersion = 0;
+	std::vector<SnapshotSectionEntry_t>	m_sections;
+	bool								m_isInSection = false;
+	bool								m_isFinalized = false;
+
+};
+
+
+class SnapshotReader
+{
+public:
+	//-----Public Methods-----
+
+	SnapshotReader() {}
+	~SnapshotReader() {}
+
+	// Maps the file, so only the pages of the sections read are ever loaded
+	bool			OpenFile(const std::string& filepath);
+
+	// Reads in place from 16 byte aligned memory that must outlive the reader, i.e. a received late join snapshot
+	bool			OpenFromMemory(const void* data, size_t size);
+	void			Close();
+
+	uint32_t		GetUserVersion() const;
+	int				GetSectionCount() const;
+	bool			HasSection(const char* name) const;
+
+	// Points at the array in the snapshot, nullptr if the section is missing or has a different element size
+	template <typename T> const T*	GetArray(const char* name, size_t& out_elementCount) const;
+	template <typename T> bool		ReadArray(const char* name, std::vector<T>& out_elements) const;
+
+	// A packer reading the section in place, empty if the section is missing or isn't packed
+	BytePacker		GetSectionPacker(const char* name) const;
+
+
+private:
+	//-----Private Methods-----
+
+	bool							ValidateData(const std::string& source);
+	const SnapshotSectionEntry_t*	FindSection(const char* name) const;
+	const void*						GetSectionData(const char* name, eSnapshotSectionType type, uint32_t elementSize, size_t& out_elementCount) const;
+
+
+private:
+	//-----Private Data-----
+
+	File							m_file;		// Mapped for as long as the snapshot is open from a file
+	const uint8_t*					m_data = nullptr;
+	size_t							m_size = 0;
+	const SnapshotFileHeader_t*		m_header = nullptr;
+	const SnapshotSectionEntry_t*	m_sections = nullptr;
+
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the elements as one raw, aligned block
+//
+template <typename T>
+void SnapshotWriter::WriteArray(const char* name, const T* elements, size_t elementCount)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "SnapshotWriter::WriteArray() only takes types that are safe to memcpy");
+	static_assert(alignof(T) <= SNAPSHOT_DATA_ALIGNMENT, "SnapshotWriter::WriteArray() type is over aligned for the snapshot");
+
+	AddSection(name, SNAPSHOT_SECTION_ARRAY, (uint32_t) sizeof(T), (uint64_t) elementCount, elements);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the vector's elements as one raw, aligned block
+//
+template <typename T>
+void SnapshotWriter::WriteArray(const char* name, const std::vector<T>& elements)
+{
+	WriteArray(name, elements.data(), elements.size());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the array in place, with no copy
+//
+template <typename T>
+const T* SnapshotReader::GetArray(const char* name, size_t& out_elementCount) const
+{
+	static_assert(std::is_trivially_copyable<T>::value, "SnapshotReader::GetArray() only takes types that are safe to memcpy");
+	return reinterpret_cast<const T*>(GetSectionData(name, SNAPSHOT_SECTION_ARRAY, (uint32_t) sizeof(T), out_elementCount));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies the array out into the vector, returning false if it's missing
+//
+template <typename T>
+bool SnapshotReader::ReadArray(const char* name, std::vector<T>& out_elements) const
+{
+	size_t elementCount = 0;
+	const T* elements = GetArray<T>(name, elementCount);
+
+	if (elements == nullptr)
+	{
+		return false;
+	}
+
+	out_elements.assign(elements, elements + elementCount);
+	return true;
+}
@@ -0,0 +1,393 @@
+/************************************************************************/
+/* File: StartupGraph.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the StartupGraph class
+/************************************************************************/
+#include "Engine/Core/StartupGraph.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/Time/Time.hpp"
+#include "Engine/Core/Threading/Threading.hpp"
+#include "Engine/Core/JobSystem/JobSystem.hpp"
+#include "Engine/Core/JobSystem/FunctionJob.hpp"
+#include "Engine/Core/Utility/StringUtils.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+
+// Taken during static initialization, the closest the engine gets to the process starting
+static uint64_t s_processStartHPC = GetPerformanceCounter();
+
+double StartupGraph::s_lastGraphSeconds = -1.0;
+double StartupGraph::s_timeToFirstFrameSeconds = -1.0;
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+StartupGraph::~StartupGraph()
+{
+	Clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a step with no dependencies
+//
+void StartupGraph::AddStep(const std::string& name, StartupStep_cb callback, void* args, eStartupStepThread thread /*= STARTUP_STEP_MAIN_THREAD*/)
+{
+	AddStep(name, callback, args, thread, std::vector<std::string>());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a step that only runs once all the named steps have finished
+//
+void StartupGraph::AddStep(const std::string& name, StartupStep_cb callback, void* args, eStartupStepThread thread, const std::vector<std::string>& dependencies)
+{
+	ASSERT_OR_DIE(callback != nullptr, Stringf("Error: StartupGraph::AddStep() given a null callback for step %s", name.c_str()));
+	ASSERT_OR_DIE(GetStep(name) == nullptr, Stringf("Error: StartupGraph::AddStep() added step %s twice", name.c_str()));
+
+	StartupStep_t* step = new StartupStep_t();
+	step->name = name;
+	step->callback = callback;
+	step->args = args;
+	step->thread = thread;
+	step->dependencies = dependencies;
+
+	m_steps.push_back(step);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Makes an existing step wait on another, i.e. for games adding their own steps in front of the engine's
+//
+void StartupGraph::AddDependency(const std::string& stepName, const std::string& dependencyName)
+{
+	StartupStep_t* step = GetStep(stepName);
+	ASSERT_OR_DIE(step != nullptr, Stringf("Error: StartupGraph::AddDependency() couldn't find step %s", stepName.c_str()));
+
+	step->dependencies.push_back(dependencyName);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes all steps
+//
+void StartupGraph::Clear()
+{
+	for (int stepIndex = 0; stepIndex < (int)m_steps.size(); ++stepIndex)
+	{
+		delete m_steps[stepIndex];
+	}
+
+	m_steps.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Runs all steps in dependency order
+// Each pass queues every ready worker/disk step first, so they overlap with the main thread step run after
+//
+bool StartupGraph::Run()
+{
+	if (!ResolveDependencies())
+	{
+		return false;
+	}
+
+	uint64_t startHPC = GetPerformanceCounter();
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	bool useJobs = (jobSystem != nullptr && jobSystem->GetWorkerThreadCount() > 0);
+
+	int numSteps = (int)m_steps.size();
+	int numFinished = 0;
+
+	while (numFinished < numSteps)
+	{
+		StartupStep_t* mainThreadStep = nullptr;
+
+		for (int stepIndex = 0; stepIndex < numSteps; ++stepIndex)
+		{
+			StartupStep_t* step = m_steps[stepIndex];
+
+			if (step->isFinished)
+			{
+				continue;
+			}
+
+			if (step->isStarted)
+			{
+				if (step->isExecuted.load(std::memory_order_acquire))
+				{
+					step->isFinished = true;
+					numFinished++;
+				}
+
+				continue;
+			}
+
+			if (!AreDependenciesFinished(step))
+			{
+				continue;
+			}
+
+			if (step->thread == STARTUP_STEP_MAIN_THREAD || !useJobs)
+			{
+				if (mainThreadStep == nullptr)
+				{
+					mainThreadStep = step;
+				}
+
+				continue;
+			}
+
+			uint32_t jobFlags = (step->thread == STARTUP_STEP_DISK ? WORKER_FLAGS_DISK : WORKER_FLAGS_ALL_BUT_DISK);
+
+			step->isStarted = true;
+			QueueJob(new FunctionJob([step]() { ExecuteStep(step); }, JOB_PRIORITY_CRITICAL, jobFlags));
+		}
+
+		if (mainThreadStep != nullptr)
+		{
+			mainThreadStep->isStarted = true;
+			ExecuteStep(mainThreadStep);
+		}
+		else if (numFinished < numSteps)
+		{
+			// Everything left is waiting on a worker
+			Thread::YieldThisThread();
+		}
+	}
+
+	m_lastRunHPC = GetPerformanceCounter() - startHPC;
+	s_lastGraphSeconds = TimeSystem::PerformanceCountToSeconds(m_lastRunHPC);
+
+	LogResults();
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of steps added
+//
+int StartupGraph::GetStepCount() const
+{
+	return (int)m_steps.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns how long the last Run() took, from the first step starting to the last finishing
+//
+double StartupGraph::GetLastRunSeconds() const
+{
+	return TimeSystem::PerformanceCountToSeconds(m_lastRunHPC);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns how long the given step took to run, on whichever thread ran it
+//
+double StartupGraph::GetStepSeconds(const std::string& name) const
+{
+	StartupStep_t* step = GetStep(name);
+
+	if (step == nullptr || !step->isFinished)
+	{
+		return -1.0;
+	}
+
+	return TimeSystem::PerformanceCountToSeconds(step->durationHPC);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Logs the time from static initialization to the end of the first frame
+//
+void StartupGraph::ReportFirstFrame()
+{
+	if (s_timeToFirstFrameSeconds >= 0.0)
+	{
+		return;
+	}
+
+	s_timeToFirstFrameSeconds = TimeSystem::PerformanceCountToSeconds(GetPerformanceCounter() - s_processStartHPC);
+
+	if (s_lastGraphSeconds >= 0.0)
+	{
+		LogTaggedPrintf("STARTUP", "Time to first frame: %.2f ms (startup graph %.2f ms)", s_timeToFirstFrameSeconds * 1000.0, s_lastGraphSeconds * 1000.0);
+	}
+	else
+	{
+		LogTaggedPrintf("STARTUP", "Time to first frame: %.2f ms", s_timeToFirstFrameSeconds * 1000.0);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the time to first frame in seconds, or -1 if the first frame hasn't been reported
+//
+double StartupGraph::GetTimeToFirstFrameSeconds()
+{
+	return s_timeToFirstFrameSeconds;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the step with the given name, nullptr if it doesn't exist
+//
+StartupStep_t* StartupGraph::GetStep(const std::string& name) const
+{
+	for (int stepIndex = 0; stepIndex < (int)m_steps.size(); ++stepIndex)
+	{
+		if (m_steps[stepIndex]->name == name)
+		{
+			return m_steps[stepIndex];
+		}
+	}
+
+	return nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Turns the dependency names into indices and resets the steps for running
+// Returns false if a dependency doesn't exist or the steps depend on each other in a cycle
+//
+bool StartupGraph::ResolveDependencies()
+{
+	int numSteps = (int)m_steps.size();
+
+	for (int stepIndex = 0; stepIndex < numSteps; ++stepIndex)
+	{
+		StartupStep_t* step = m_steps[stepIndex];
+
+		step->dependencyIndices.clear();
+		step->isStarted = false;
+		step->isFinished = false;
+		step->isExecuted = false;
+		step->durationHPC = 0;
+
+		for (int depIndex = 0; depIndex < (int)step->dependencies.size(); ++depIndex)
+		{
+			int foundIndex = -1;
+			for (int otherIndex = 0; otherIndex < numSteps; ++otherIndex)
+			{
+				if (m_steps[otherIndex]->name == step->dependencies[depIndex])
+				{
+					foundIndex = otherIndex;
+					break;
+				}
+			}
+
+			if (foundIndex == -1)
+			{
+				ERROR_RECOVERABLE(Stringf("Error: StartupGraph step %s depends on missing step %s", step->name.c_str(), step->dependencies[depIndex].c_str()));
+				return false;
+			}
+
+			step->dependencyIndices.push_back(foundIndex);
+		}
+	}
+
+	// Peel off steps with every dependency peeled, anything left over is in a cycle
+	std::vector<bool> isPeeled(numSteps, false);
+	int numPeeled = 0;
+	bool peeledAny = true;
+
+	while (peeledAny)
+	{
+		peeledAny = false;
+
+		for (int stepIndex = 0; stepIndex < numSteps; ++stepIndex)
+		{
+			if (isPeeled[stepIndex])
+			{
+				continue;
+			}
+
+			bool allPeeled = true;
+			const std::vector<int>& dependencyIndices = m_steps[stepIndex]->dependencyIndices;
+
+			for (int depIndex = 0; depIndex < (int)dependencyIndices.size(); ++depIndex)
+			{
+				allPeeled = allPeeled && isPeeled[dependencyIndices[depIndex]];
+			}
+
+			if (allPeeled)
+			{
+				isPeeled[stepIndex] = true;
+				numPeeled++;
+				peeledAny = true;
+			}
+		}
+	}
+
+	if (numPeeled < numSteps)
+	{
+		std::string cycleSteps;
+		for (int stepIndex = 0; stepIndex < numSteps; ++stepIndex)
+		{
+			if (!isPeeled[stepIndex])
+			{
+				cycleSteps += (cycleSteps.size() > 0 ? ", " : "") + m_steps[stepIndex]->name;
+			}
+		}
+
+		ERROR_RECOVERABLE(Stringf("Error: StartupGraph has a dependency cycle between steps: %s", cycleSteps.c_str()));
+		return false;
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if every step this step depends on has finished
+//
+bool StartupGraph::AreDependenciesFinished(const StartupStep_t* step) const
+{
+	for (int depIndex = 0; depIndex < (int)step->dependencyIndices.size(); ++depIndex)
+	{
+		if (!m_steps[step->dependencyIndices[depIndex]]->isFinished)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Logs each step's time and where it ran
+//
+void StartupGraph::LogResults() const
+{
+	static const char* s_threadNames[] = { "main", "worker", "disk" };
+
+	uint64_t totalStepHPC = 0;
+	for (int stepIndex = 0; stepIndex < (int)m_steps.size(); ++stepIndex)
+	{
+		const StartupStep_t* step = m_steps[stepIndex];
+		totalStepHPC += step->durationHPC;
+
+		LogTaggedPrintf("STARTUP", "%-32s %8.2f ms (%s)", step->name.c_str(), TimeSystem::PerformanceCountToSeconds(step->durationHPC) * 1000.0, s_threadNames[step->thread]);
+	}
+
+	LogTaggedPrintf("STARTUP", "Startup graph ran %i steps in %.2f ms, %.2f ms if run in sequence", (int)m_steps.size(),
+		TimeSystem::PerformanceCountToSeconds(m_lastRunHPC) * 1000.0, TimeSystem::PerformanceCountToSeconds(totalStepHPC) * 1000.0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Runs the step's callback and times it; called on the main thread or a worker
+//
+void StartupGraph::ExecuteStep(StartupStep_t* step)
+{
+	uint64_t startHPC = GetPerformanceCounter();
+	step->callback(step->args);
+	step->durationHPC = GetPerformanceCounter() - startHPC;
+
+	step->isExecuted.store(true, std::memory_order_release);
+}
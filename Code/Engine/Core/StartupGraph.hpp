@@ -0,0 +1,94 @@
+/************************************************************************/
+/* File: StartupGraph.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Declarative list of engine/game startup steps with their
+/*				dependencies, run in dependency order with independent
+/*				steps spread across the JobSystem
+/************************************************************************/
+#pragma once
+#include <atomic>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+// Called once to run the step, on whichever thread the step asked for
+typedef void(*StartupStep_cb)(void* args);
+
+// Where a step is allowed to run
+enum eStartupStepThread
+{
+	STARTUP_STEP_MAIN_THREAD,	// Window, GL context, anything touching the renderer or thread-local state
+	STARTUP_STEP_WORKER,		// CPU work with no thread affinity (shader source preprocessing, font parsing)
+	STARTUP_STEP_DISK			// Blocking file IO (audio banks, opening the log file), on the disk worker
+};
+
+struct StartupStep_t
+{
+	std::string					name;
+	StartupStep_cb				callback = nullptr;
+	void*						args = nullptr;
+	eStartupStepThread			thread = STARTUP_STEP_MAIN_THREAD;
+	std::vector<std::string>	dependencies;
+
+	// Set up by Run()
+	std::vector<int>			dependencyIndices;
+	bool						isStarted = false;
+	bool						isFinished = false;		// Only read and written on the main thread
+	std::atomic<bool>			isExecuted{ false };	// Set by whichever thread ran it
+	uint64_t					durationHPC = 0;
+};
+
+
+class StartupGraph
+{
+public:
+	//-----Public Methods-----
+
+	StartupGraph() {}
+	~StartupGraph();
+
+	// Dependencies are the names of other steps, which don't need to be added yet
+	void	AddStep(const std::string& name, StartupStep_cb callback, void* args, eStartupStepThread thread = STARTUP_STEP_MAIN_THREAD);
+	void	AddStep(const std::string& name, StartupStep_cb callback, void* args, eStartupStepThread thread, const std::vector<std::string>& dependencies);
+	void	AddDependency(const std::string& stepName, const std::string& dependencyName);
+	void	Clear();
+
+	// Runs every step, returning once all have finished; must be called on the main thread
+	// Worker and disk steps run inline if the JobSystem isn't running
+	// Returns false without running anything if a dependency is missing or there's a cycle
+	bool	Run();
+
+	int		GetStepCount() const;
+	double	GetLastRunSeconds() const;
+	double	GetStepSeconds(const std::string& name) const;	// -1 if the step doesn't exist or hasn't run
+
+	// Time to first frame - the Renderer calls this at the end of its first frame, headless games call it
+	// themselves after their first update; only the first call does anything
+	static void		ReportFirstFrame();
+	static double	GetTimeToFirstFrameSeconds();				// -1 until the first frame is reported
+
+
+private:
+	//-----Private Methods-----
+
+	StartupGraph(const StartupGraph& copy) = delete;
+
+	StartupStep_t*	GetStep(const std::string& name) const;
+	bool			ResolveDependencies();
+	bool			AreDependenciesFinished(const StartupStep_t* step) const;
+	void			LogResults() const;
+
+	static void		ExecuteStep(StartupStep_t* step);
+
+
+private:
+	//-----Private Data-----
+
+	std::vector<StartupStep_t*>	m_steps;	// Pointers, since the steps hold atomics and are shared with the jobs
+	uint64_t					m_lastRunHPC = 0;
+
+	static double				s_lastGraphSeconds;
+	static double				s_timeToFirstFrameSeconds;
+
+};
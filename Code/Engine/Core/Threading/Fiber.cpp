@@ -0,0 +1,125 @@
+/************************************************************************/
+/* File: Fiber.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the fiber API
+/************************************************************************/
+#include "Engine/Core/Threading/Fiber.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+#if defined( _WIN32 )
+#define PLATFORM_WINDOWS
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#endif
+
+// For entering the callback through the OS's calling convention
+struct FiberStartArgs_t
+{
+	Fiber_cb	callback = nullptr;
+	void*		userData = nullptr;
+};
+
+#ifdef PLATFORM_WINDOWS
+static void WINAPI FiberStartEntry(void* args);
+#endif
+
+
+//-----------------------------------------------------------------------------------------------
+// Converts the calling thread into a fiber so it can switch to others, returning its fiber handle
+// Returns nullptr if fibers aren't supported on this platform
+//
+FiberHandle_t Fiber::ConvertThisThreadToFiber(void *paramData /*= nullptr*/)
+{
+#ifdef PLATFORM_WINDOWS
+	return ConvertThreadToFiber(paramData);
+#else
+	UNUSED(paramData);
+	return nullptr;
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Turns the calling fiber back into a plain thread, should be called before the thread exits
+//
+void Fiber::ConvertThisFiberToThread()
+{
+#ifdef PLATFORM_WINDOWS
+	ConvertFiberToThread();
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Creates a fiber that will run the callback the first time it's switched to
+// Returns nullptr if the fiber couldn't be created
+//
+FiberHandle_t Fiber::Create(Fiber_cb cb, void *paramData /*= nullptr*/, size_t stackSize /*= DEFAULT_FIBER_STACK_SIZE*/)
+{
+#ifdef PLATFORM_WINDOWS
+	FiberStartArgs_t* args = new FiberStartArgs_t();
+	args->callback = cb;
+	args->userData = paramData;
+
+	FiberHandle_t fiber = CreateFiber(stackSize, FiberStartEntry, args);
+
+	if (fiber == nullptr)
+	{
+		delete args;
+	}
+
+	return fiber;
+#else
+	UNUSED(cb);
+	UNUSED(paramData);
+	UNUSED(stackSize);
+	return nullptr;
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Frees the fiber and its stack
+//
+void Fiber::Destroy(FiberHandle_t fiber)
+{
+#ifdef PLATFORM_WINDOWS
+	DeleteFiber(fiber);
+#else
+	UNUSED(fiber);
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Saves the state of the running fiber and resumes the given one
+// Returns once something switches back to the calling fiber, possibly on a different thread
+//
+void Fiber::SwitchTo(FiberHandle_t fiber)
+{
+#ifdef PLATFORM_WINDOWS
+	SwitchToFiber(fiber);
+#else
+	UNUSED(fiber);
+#endif
+}
+
+
+#ifdef PLATFORM_WINDOWS
+//-----------------------------------------------------------------------------------------------
+// Entry for all fibers, calls into the callback given on creation
+//
+static void WINAPI FiberStartEntry(void* args)
+{
+	FiberStartArgs_t* startArgs = (FiberStartArgs_t*)args;
+
+	Fiber_cb callback = startArgs->callback;
+	void* userData = startArgs->userData;
+	delete startArgs;
+
+	callback(userData);
+}
+#endif
@@ -0,0 +1,31 @@
+/************************************************************************/
+/* File: Fiber.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: API for creating and switching between fibers (user-mode
+/*				threads that are scheduled cooperatively)
+/************************************************************************/
+#pragma once
+#include <stddef.h>
+
+typedef void* FiberHandle_t;
+
+// Fiber callback function (what the fiber enters into), must never return
+typedef void (*Fiber_cb)(void *paramData);
+
+// Jobs are small, so fibers don't need the 1MB default thread stack
+#define DEFAULT_FIBER_STACK_SIZE (64 * 1024)
+
+namespace Fiber
+{
+	// A thread has to become a fiber before it can switch to one; returns nullptr if fibers aren't supported
+	FiberHandle_t	ConvertThisThreadToFiber(void *paramData = nullptr);
+	void			ConvertThisFiberToThread();
+
+	// Creating/destroying - never destroy the fiber that's currently running
+	FiberHandle_t	Create(Fiber_cb cb, void *paramData = nullptr, size_t stackSize = DEFAULT_FIBER_STACK_SIZE);
+	void			Destroy(FiberHandle_t fiber);
+
+	// Stops running the current fiber and resumes the given one on this thread
+	void			SwitchTo(FiberHandle_t fiber);
+}
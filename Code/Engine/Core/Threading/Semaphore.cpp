@@ -0,0 +1,86 @@
+/************************************************************************/
+/* File: Semaphore.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the Semaphore class
+/************************************************************************/
+#include "Engine/Core/Threading/Semaphore.hpp"
+#include <chrono>
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+Semaphore::Semaphore(unsigned int initialCount /*= 0*/)
+	: m_count(initialCount)
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Blocks the calling thread until the count is non-zero, then decrements it
+//
+void Semaphore::Acquire()
+{
+	std::unique_lock<std::mutex> lock(m_lock);
+	m_condition.wait(lock, [this]() { return m_count > 0; });
+
+	m_count--;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Decrements the count if it is non-zero, without blocking
+// Returns true if the count was decremented
+//
+bool Semaphore::TryAcquire()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	if (m_count > 0)
+	{
+		m_count--;
+		return true;
+	}
+
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Blocks the calling thread until the count is non-zero or the time runs out
+// Returns true if the count was decremented
+//
+bool Semaphore::AcquireFor(unsigned int milliseconds)
+{
+	std::unique_lock<std::mutex> lock(m_lock);
+	bool acquired = m_condition.wait_for(lock, std::chrono::milliseconds(milliseconds), [this]() { return m_count > 0; });
+
+	if (acquired)
+	{
+		m_count--;
+	}
+
+	return acquired;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Increments the count, waking up to count threads that are waiting on it
+//
+void Semaphore::Release(unsigned int count /*= 1*/)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_count += count;
+	}
+
+	if (count == 1)
+	{
+		m_condition.notify_one();
+	}
+	else
+	{
+		m_condition.notify_all();
+	}
+}
@@ -0,0 +1,34 @@
+/************************************************************************/
+/* File: Semaphore.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Counting semaphore for putting threads to sleep until
+/*				there is work for them to do
+/************************************************************************/
+#pragma once
+#include <mutex>
+#include <condition_variable>
+
+
+class Semaphore
+{
+public:
+	//-----Public Methods-----
+
+	Semaphore(unsigned int initialCount = 0);
+	~Semaphore() {}
+
+	void Acquire();								// Blocks until the count is non-zero, then decrements it
+	bool TryAcquire();							// Non-blocking, returns true if the count was decremented
+	bool AcquireFor(unsigned int milliseconds);	// Blocks for at most the given time, returns true if acquired
+	void Release(unsigned int count = 1);		// Increments the count, waking up to count waiting threads
+
+
+private:
+	//-----Private Data-----
+
+	std::mutex				m_lock;
+	std::condition_variable	m_condition;
+	unsigned int			m_count = 0;
+
+};
@@ -5,10 +5,35 @@
 /* Description: Implementation of the threading API
 /************************************************************************/
 #include <chrono>
+#include <string>
 #include "Engine/Core/File.hpp"
 #include "Engine/Core/Threading/Threading.hpp"
 #include "Engine/Core/DeveloperConsole/Command.hpp"
 
+#if defined( _WIN32 )
+#define PLATFORM_WINDOWS
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#endif
+
+// For setting the name/affinity/priority on a new thread from inside it, before it runs the callback
+struct ThreadStartArgs_t
+{
+	Thread_cb		callback = nullptr;
+	void*			userData = nullptr;
+	std::string		name;
+	uint64_t		affinityMask = THREAD_AFFINITY_ANY;
+	eThreadPriority priority = THREAD_PRIORITY_SETTING_NORMAL;
+};
+
+static void ThreadStartEntry(void* args);
+static ThreadTopology_t QueryTopology();
+static bool SetThreadAffinityNative(void* nativeHandle, uint64_t affinityMask);
+static bool SetThreadPriorityNative(void* nativeHandle, eThreadPriority priority);
+static void SetThreadNameNative(void* nativeHandle, const char* name);
+
 
 //-----------------------------------------------------------------------------------------------
 // Creates a thread, returning the handle
@@ -20,6 +45,24 @@ ThreadHandle_t Thread::Create(Thread_cb cb, void *paramData /*= nullptr */)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Creates a thread with the given name, affinity and priority, which are applied on the new
+// thread before the callback is entered
+//
+ThreadHandle_t Thread::Create(Thread_cb cb, void *paramData, const char* name, uint64_t affinityMask /*= THREAD_AFFINITY_ANY*/, eThreadPriority priority /*= THREAD_PRIORITY_SETTING_NORMAL*/)
+{
+	ThreadStartArgs_t* args = new ThreadStartArgs_t();
+	args->callback = cb;
+	args->userData = paramData;
+	args->name = (name != nullptr ? name : "");
+	args->affinityMask = affinityMask;
+	args->priority = priority;
+
+	ThreadHandle_t handle = new std::thread(ThreadStartEntry, args);
+	return handle;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Makes the calling thread wait/block until the thread given by handle finishes
 //
@@ -65,3 +108,267 @@ void Thread::YieldThisThread()
 {
 	std::this_thread::yield();
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the name of the thread given by handle
+//
+void Thread::SetName(ThreadHandle_t handle, const char* name)
+{
+	SetThreadNameNative((void*)handle->native_handle(), name);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the name of the calling thread
+//
+void Thread::SetThisThreadName(const char* name)
+{
+#ifdef PLATFORM_WINDOWS
+	SetThreadNameNative(GetCurrentThread(), name);
+#else
+	UNUSED(name);
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Restricts the thread to the logical processors in the mask
+//
+bool Thread::SetAffinity(ThreadHandle_t handle, uint64_t affinityMask)
+{
+	return SetThreadAffinityNative((void*)handle->native_handle(), affinityMask);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Restricts the calling thread to the logical processors in the mask
+//
+bool Thread::SetThisThreadAffinity(uint64_t affinityMask)
+{
+#ifdef PLATFORM_WINDOWS
+	return SetThreadAffinityNative(GetCurrentThread(), affinityMask);
+#else
+	UNUSED(affinityMask);
+	return false;
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the scheduling priority of the thread
+//
+bool Thread::SetPriority(ThreadHandle_t handle, eThreadPriority priority)
+{
+	return SetThreadPriorityNative((void*)handle->native_handle(), priority);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the scheduling priority of the calling thread
+//
+bool Thread::SetThisThreadPriority(eThreadPriority priority)
+{
+#ifdef PLATFORM_WINDOWS
+	return SetThreadPriorityNative(GetCurrentThread(), priority);
+#else
+	UNUSED(priority);
+	return false;
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the processor layout of the machine, queried once on first use
+//
+const ThreadTopology_t& Thread::GetTopology()
+{
+	static ThreadTopology_t s_topology = QueryTopology();
+	return s_topology;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a thread layout for this machine: main thread on the first physical core, render thread
+// on the second, and one compute worker on each remaining physical core
+// The disk thread is left unpinned since it spends its time blocked on IO
+// With too few cores to give everything its own, workers share the cores that exist
+//
+ThreadLayout_t Thread::GetDefaultLayout()
+{
+	const ThreadTopology_t& topology = GetTopology();
+	int numCores = topology.numPhysicalCores;
+
+	ThreadLayout_t layout;
+
+	if (numCores <= 2)
+	{
+		// Not enough to pin anything usefully, give the OS full control and just one worker
+		layout.workerThreadAffinities.push_back(THREAD_AFFINITY_ANY);
+		return layout;
+	}
+
+	layout.mainThreadAffinity = topology.physicalCoreMasks[0];
+	layout.renderThreadAffinity = topology.physicalCoreMasks[1];
+
+	for (int coreIndex = 2; coreIndex < numCores; ++coreIndex)
+	{
+		layout.workerThreadAffinities.push_back(topology.physicalCoreMasks[coreIndex]);
+	}
+
+	return layout;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Entry for threads created with a name/affinity/priority, applies them then runs the callback
+//
+static void ThreadStartEntry(void* args)
+{
+	ThreadStartArgs_t* startArgs = reinterpret_cast<ThreadStartArgs_t*>(args);
+
+	if (startArgs->name.size() > 0)
+	{
+		Thread::SetThisThreadName(startArgs->name.c_str());
+	}
+
+	if (startArgs->affinityMask != THREAD_AFFINITY_ANY)
+	{
+		Thread::SetThisThreadAffinity(startArgs->affinityMask);
+	}
+
+	if (startArgs->priority != THREAD_PRIORITY_SETTING_NORMAL)
+	{
+		Thread::SetThisThreadPriority(startArgs->priority);
+	}
+
+	Thread_cb callback = startArgs->callback;
+	void* userData = startArgs->userData;
+	delete startArgs;
+
+	callback(userData);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Asks the OS for the logical processor and physical core layout
+//
+static ThreadTopology_t QueryTopology()
+{
+	ThreadTopology_t topology;
+
+	unsigned int hardwareConcurrency = std::thread::hardware_concurrency();
+	topology.numLogicalProcessors = (hardwareConcurrency > 0 ? (int)hardwareConcurrency : 1);
+
+#ifdef PLATFORM_WINDOWS
+	DWORD bufferSize = 0;
+	GetLogicalProcessorInformation(nullptr, &bufferSize);
+
+	if (bufferSize > 0)
+	{
+		std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> infos(bufferSize / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+
+		if (GetLogicalProcessorInformation(infos.data(), &bufferSize))
+		{
+			for (int infoIndex = 0; infoIndex < (int)infos.size(); ++infoIndex)
+			{
+				if (infos[infoIndex].Relationship == RelationProcessorCore)
+				{
+					topology.physicalCoreMasks.push_back((uint64_t)infos[infoIndex].ProcessorMask);
+				}
+			}
+		}
+	}
+#endif
+
+	// Couldn't query it, so treat every logical processor as its own core
+	if (topology.physicalCoreMasks.size() == 0)
+	{
+		int numMaskable = (topology.numLogicalProcessors < 64 ? topology.numLogicalProcessors : 64);
+
+		for (int processorIndex = 0; processorIndex < numMaskable; ++processorIndex)
+		{
+			topology.physicalCoreMasks.push_back((uint64_t)1 << processorIndex);
+		}
+	}
+
+	topology.numPhysicalCores = (int)topology.physicalCoreMasks.size();
+
+	return topology;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the affinity of the thread through the OS
+//
+static bool SetThreadAffinityNative(void* nativeHandle, uint64_t affinityMask)
+{
+#ifdef PLATFORM_WINDOWS
+	if (affinityMask == THREAD_AFFINITY_ANY)
+	{
+		DWORD_PTR processMask, systemMask;
+		GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask);
+		affinityMask = (uint64_t)processMask;
+	}
+
+	return (SetThreadAffinityMask((HANDLE)nativeHandle, (DWORD_PTR)affinityMask) != 0);
+#else
+	UNUSED(nativeHandle);
+	UNUSED(affinityMask);
+	return false;
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the priority of the thread through the OS
+//
+static bool SetThreadPriorityNative(void* nativeHandle, eThreadPriority priority)
+{
+#ifdef PLATFORM_WINDOWS
+	int nativePriority = THREAD_PRIORITY_NORMAL;
+
+	switch (priority)
+	{
+	case THREAD_PRIORITY_SETTING_LOWEST:		nativePriority = THREAD_PRIORITY_LOWEST;		break;
+	case THREAD_PRIORITY_SETTING_BELOW_NORMAL:	nativePriority = THREAD_PRIORITY_BELOW_NORMAL;	break;
+	case THREAD_PRIORITY_SETTING_NORMAL:		nativePriority = THREAD_PRIORITY_NORMAL;		break;
+	case THREAD_PRIORITY_SETTING_ABOVE_NORMAL:	nativePriority = THREAD_PRIORITY_ABOVE_NORMAL;	break;
+	case THREAD_PRIORITY_SETTING_HIGHEST:		nativePriority = THREAD_PRIORITY_HIGHEST;		break;
+	case THREAD_PRIORITY_SETTING_TIME_CRITICAL:	nativePriority = THREAD_PRIORITY_TIME_CRITICAL;	break;
+	default:
+		break;
+	}
+
+	return (SetThreadPriority((HANDLE)nativeHandle, nativePriority) != 0);
+#else
+	UNUSED(nativeHandle);
+	UNUSED(priority);
+	return false;
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the name of the thread through the OS
+// SetThreadDescription only exists on Windows 10 1607+, so it's looked up at runtime
+//
+static void SetThreadNameNative(void* nativeHandle, const char* name)
+{
+#ifdef PLATFORM_WINDOWS
+	typedef HRESULT(WINAPI *SetThreadDescription_fn)(HANDLE, PCWSTR);
+	static SetThreadDescription_fn s_setThreadDescription = (SetThreadDescription_fn)GetProcAddress(GetModuleHandleA("Kernel32.dll"), "SetThreadDescription");
+
+	if (s_setThreadDescription != nullptr && name != nullptr)
+	{
+		wchar_t wideName[128];
+		size_t numConverted = 0;
+		mbstowcs_s(&numConverted, wideName, name, _TRUNCATE);
+
+		s_setThreadDescription((HANDLE)nativeHandle, wideName);
+	}
+#else
+	UNUSED(nativeHandle);
+	UNUSED(name);
+#endif
+}
@@ -6,19 +6,52 @@
 /************************************************************************/
 #pragma once
 #include <thread>
+#include <vector>
+#include <stdint.h>
 #include "Engine/Core/EngineCommon.hpp"
 
 TODO("Return handles as void*")
-TODO("Add name thread functionality");
 typedef std::thread* ThreadHandle_t; 
 
 // Thread callback function (what the thread enters into)
 typedef void (*Thread_cb)(void *paramData); 
 
+// Scheduling priority of a thread, relative to the rest of the process
+enum eThreadPriority
+{
+	THREAD_PRIORITY_SETTING_LOWEST,
+	THREAD_PRIORITY_SETTING_BELOW_NORMAL,
+	THREAD_PRIORITY_SETTING_NORMAL,
+	THREAD_PRIORITY_SETTING_ABOVE_NORMAL,
+	THREAD_PRIORITY_SETTING_HIGHEST,
+	THREAD_PRIORITY_SETTING_TIME_CRITICAL
+};
+
+// An affinity of 0 means "let the OS decide"
+#define THREAD_AFFINITY_ANY (0)
+
+// Processor layout of the machine, as reported by the OS
+struct ThreadTopology_t
+{
+	int						numLogicalProcessors = 1;
+	int						numPhysicalCores = 1;
+	std::vector<uint64_t>	physicalCoreMasks;	// Logical processors (hyperthreads) belonging to each physical core
+};
+
+// Suggested placement of the engine's threads; one physical core each where possible
+struct ThreadLayout_t
+{
+	uint64_t				mainThreadAffinity = THREAD_AFFINITY_ANY;
+	uint64_t				renderThreadAffinity = THREAD_AFFINITY_ANY;
+	uint64_t				diskThreadAffinity = THREAD_AFFINITY_ANY;
+	std::vector<uint64_t>	workerThreadAffinities;	// One entry per compute worker to create
+};
+
 namespace Thread
 {
 	// Creating
 	ThreadHandle_t Create( Thread_cb cb, void *user_data = nullptr ); 
+	ThreadHandle_t Create( Thread_cb cb, void *user_data, const char* name, uint64_t affinityMask = THREAD_AFFINITY_ANY, eThreadPriority priority = THREAD_PRIORITY_SETTING_NORMAL );
 
 	// Releasing - how we free an above resource
 	// Join will wait until the thread is complete before return control to the calling thread
@@ -33,4 +66,20 @@ namespace Thread
 	// Control
 	void SleepThisThreadFor(unsigned int ms); 
 	void YieldThisThread(); 
+
+	// Naming, shows up in the debugger, profiler captures and OS tools
+	void SetName(ThreadHandle_t handle, const char* name);
+	void SetThisThreadName(const char* name);
+
+	// Pinning - mask bit N is logical processor N; returns false if the OS rejected the mask
+	bool SetAffinity(ThreadHandle_t handle, uint64_t affinityMask);
+	bool SetThisThreadAffinity(uint64_t affinityMask);
+
+	// Priority
+	bool SetPriority(ThreadHandle_t handle, eThreadPriority priority);
+	bool SetThisThreadPriority(eThreadPriority priority);
+
+	// Topology
+	const ThreadTopology_t&	GetTopology();
+	ThreadLayout_t			GetDefaultLayout();
 }
@@ -0,0 +1,1197 @@
+/************************************************************************/
+/* File: BenchmarkSuite.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the BenchmarkSuite class, and the
+/*				engine's benchmark cases
+/************************************************************************/
+#include "Engine/Core/File.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Matrix44.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Quaternion.hpp"
+#include "Engine/Math/IntVector2.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/Time/Time.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Utility/HeatMap.hpp"
+#include "Engine/Core/Utility/NoiseBatch.hpp"
+#include "Engine/Core/Utility/SmoothNoise.hpp"
+#include "Engine/Core/Time/BenchmarkSuite.hpp"
+#include "Engine/Networking/NetSession.hpp"
+#include "Engine/Networking/NetPacket.hpp"
+#include "Engine/Networking/NetMessage.hpp"
+#include "Engine/Networking/BytePacker.hpp"
+#include "Engine/Core/JobSystem/JobSystem.hpp"
+#include "Engine/Core/JobSystem/FunctionJob.hpp"
+#include "Engine/Rendering/Meshes/MeshBuilder.hpp"
+#include "Engine/Core/DeveloperConsole/Command.hpp"
+#include "Engine/Core/DeveloperConsole/DevConsole.hpp"
+#include "Engine/Rendering/Core/ForwardRenderingPath.hpp"
+#include <atomic>
+#include <thread>
+#include <algorithm>
+
+#define BENCHMARK_MATRIX_COUNT (256)				// Inputs cycled through, so the work can't be hoisted out of the loop
+#define BENCHMARK_BYTE_PACKER_SIZE (4096)
+#define BENCHMARK_PACKET_MESSAGE_COUNT (16)
+#define BENCHMARK_HEAT_MAP_SIZE (64)
+#define BENCHMARK_LARGE_HEAT_MAP_SIZE (512)			// Enough tiles to spread across the workers
+#define BENCHMARK_SORT_KEY_COUNT (4096)				// About the draw calls of a busy camera pass
+#define BENCHMARK_POINT_COUNT (1024)
+#define BENCHMARK_NOISE_ROW_SIZE (256)				// Same sample positions as the scalar noise cases
+#define BENCHMARK_BONE_COUNT (128)					// Rotations blended per iteration, about one skinned character
+#define BENCHMARK_SIMD_CHECK_TOLERANCE (0.0001f)	// Relative to each element's size, SIMD inverses are in floats and the reference in doubles
+
+// Static members
+std::vector<BenchmarkCase_t>	BenchmarkSuite::s_cases;
+bool							BenchmarkSuite::s_areEngineCasesRegistered = false;
+
+// Written by Consume(), volatile so the values have to be computed
+static volatile float			s_floatSink = 0.f;
+static volatile uint64_t		s_integerSink = 0;
+
+void Command_BenchmarkRun(Command& cmd);
+void Command_BenchmarkList(Command& cmd);
+void Command_BenchmarkCompare(Command& cmd);
+void Command_BenchmarkCheckSIMD(Command& cmd);
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts timing the case's loop
+//
+void BenchmarkTimer::Start()
+{
+	m_startHPC = GetPerformanceCounter();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stops timing, adding the time since Start() to the elapsed time
+//
+void BenchmarkTimer::Stop()
+{
+	m_elapsedHPC += GetPerformanceCounter() - m_startHPC;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the time spent between Start() and Stop() calls
+//
+uint64_t BenchmarkTimer::GetElapsedHPC() const
+{
+	return m_elapsedHPC;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Fills the matrices with model matrices of random transforms
+//
+void MakeRandomMatrices(std::vector<Matrix44>& out_matrices)
+{
+	out_matrices.resize(BENCHMARK_MATRIX_COUNT);
+
+	for (int matrixIndex = 0; matrixIndex < BENCHMARK_MATRIX_COUNT; ++matrixIndex)
+	{
+		Vector3 translation = Vector3(GetRandomFloatInRange(-100.f, 100.f), GetRandomFloatInRange(-100.f, 100.f), GetRandomFloatInRange(-100.f, 100.f));
+		Vector3 rotation = Vector3(GetRandomFloatInRange(0.f, 360.f), GetRandomFloatInRange(0.f, 360.f), GetRandomFloatInRange(0.f, 360.f));
+		Vector3 scale = Vector3(GetRandomFloatInRange(0.5f, 2.f), GetRandomFloatInRange(0.5f, 2.f), GetRandomFloatInRange(0.5f, 2.f));
+
+		out_matrices[matrixIndex] = Matrix44::MakeModelMatrix(translation, rotation, scale);
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// One iteration is one 4x4 multiply
+//
+bool Benchmark_Matrix44Multiply(int iterationCount, BenchmarkTimer& timer)
+{
+	std::vector<Matrix44> matrices;
+	MakeRandomMatrices(matrices);
+
+	Matrix44 result;
+
+	timer.Start();
+	for (int iteration = 0; iteration < iterationCount; ++iteration)
+	{
+		result = result * matrices[iteration % BENCHMARK_MATRIX_COUNT];
+	}
+	timer.Stop();
+
+	BenchmarkSuite::Consume(result.Tw);
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// One iteration is one general 4x4 inverse
+//
+bool Benchmark_Matrix44Invert(int iterationCount, BenchmarkTimer& timer)
+{
+	std::vector<Matrix44> matrices;
+	MakeRandomMatrices(matrices);
+
+	float sum = 0.f;
+
+	timer.Start();
+	for (int iteration = 0; iteration < iterationCount; ++iteration)
+	{
+		Matrix44 inverse = Matrix44::GetInverse(matrices[iteration % BENCHMARK_MATRIX_COUNT]);
+		sum += inverse.Tx;
+	}
+	timer.Stop();
+
+	BenchmarkSuite::Consume(sum);
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// One iteration is one scalar 4x4 multiply, to compare the SIMD one against
+//
+bool Benchmark_Matrix44MultiplyReference(int iterationCount, BenchmarkTimer& timer)
+{
+	std::vector<Matrix44> matrices;
+	MakeRandomMatrices(matrices);
+
+	Matrix44 result;
+
+	timer.Start();
+	for (int iteration = 0; iteration < iterationCount; ++iteration)
+	{
+		result = Matrix44::MultiplyReference(result, matrices[iteration % BENCHMARK_MATRIX_COUNT]);
+	}
+	timer.Stop();
+
+	BenchmarkSuite::Consume(result.Tw);
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// One iteration is one scalar general 4x4 inverse
+//
+bool Benchmark_Matrix44InvertReference(int iterationCount, BenchmarkTimer& timer)
+{
+	std::vector<Matrix44> matrices;
+	MakeRandomMatrices(matrices);
+
+	float sum = 0.f;
+
+	timer.Start();
+	for (int iteration = 0; iteration < iterationCount; ++iteration)
+	{
+		Matrix44 inverse = Matrix44::GetInverseReference(matrices[iteration % BENCHMARK_MATRIX_COUNT]);
+		sum += inverse.Tx;
+	}
+	timer.Stop();
+
+	BenchmarkSuite::Consume(sum);
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// One iteration is one affine inverse
+//
+bool Benchmark_Matrix44InvertAffine(int iterationCount, BenchmarkTimer& timer)
+{
+	std::vector<Matrix44> matrices;
+	MakeRandomMatrices(matrices);
+
+	float sum = 0.f;
+
+	timer.Start();
+	for (int iteration = 0; iteration < iterationCount; ++iteration)
+	{
+		Matrix44 inverse = Matrix44::GetInverseAffine(matrices[iteration % BENCHMARK_MATRIX_COUNT]);
+		sum += inverse.Tx;
+	}
+	timer.Stop();
+
+	BenchmarkSuite::Consume(sum);
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// One iteration transforms BENCHMARK_POINT_COUNT points by one matrix
+//
+bool Benchmark_Matrix44TransformPoints(int iterationCount, BenchmarkTimer& timer)
+{
+	std::vector<Matrix44> matrices;
+	MakeRandomMatrices(matrices);
+
+	std::vector<Vector3> points;
+	for (int pointIndex = 0; pointIndex < BENCHMARK_POINT_COUNT; ++pointIndex)
+	{
+		points.push_back(Vector3(GetRandomFloatInRange(-10.f, 10.f), GetRandomFloatInRange(-10.f, 10.f), GetRandomFloatInRange(-10.f, 10.f)));
+	}
+
+	std::vector<Vector3> results(BENCHMARK_POINT_COUNT);
+	float sum = 0.f;
+
+	timer.Start();
+	for (int iteration = 0; iteration < iterationCount; ++iteration)
+	{
+		matrices[iteration % BENCHMARK_MATRIX_COUNT].TransformPoints(points.data(), BENCHMARK_POINT_COUNT, results.data());
+		sum += results[iteration % BENCHMARK_POINT_COUNT].x;
+	}
+	timer.Stop();
+
+	BenchmarkSuite::Consume(sum);
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Fills the array with random unit quaternions
+//
+void MakeRandomRotations(std::vector<Quaternion>& out_rotations)
+{
+	for (int rotationIndex = 0; rotationIndex < BENCHMARK_BONE_COUNT; ++rotationIndex)
+	{
+		Vector3 eulerAngles = Vector3(GetRandomFloatInRange(0.f, 360.f), GetRandomFloatInRange(0.f, 360.f), GetRandomFloatInRange(0.f, 360.f));
+		out_rotations.push_back(Quaternion::FromEuler(eulerAngles));
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// One iteration blends BENCHMARK_BONE_COUNT rotations with the batch approximate slerp, compare per
+// rotation against quaternion_slerp
+//
+bool Benchmark_QuaternionFastSlerpArray(int iterationCount, BenchmarkTimer& timer)
+{
+	std::vector<Quaternion> starts;
+	std::vector<Quaternion> ends;
+	MakeRandomRotations(starts);
+	MakeRandomRotations(ends);
+
+	std::vector<Quaternion> results(BENCHMARK_BONE_COUNT);
+	float sum = 0.f;
+
+	timer.Start();
+	for (int iteration = 0; iteration < iterationCount; ++iteration)
+	{
+		float fraction = (float) (iteration % 64) / 64.f;
+		Quaternion::FastSlerpArray(starts.data(), ends.data(), BENCHMARK_BONE_COUNT, fraction, results.data());
+
+		sum += results[iteration % BENCHMARK_BONE_COUNT].s;
+	}
+	timer.Stop();
+
+	BenchmarkSuite::Consume(sum);
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the largest difference between the values, relative to the reference's size (or 1, near zero)
+//
+float GetMaxRelativeError(const float* values, const float* referenceValues, int valueCount)
+{
+	float maxError = 0.f;
+
+	for (int valueIndex = 0; valueIndex < valueCount; ++valueIndex)
+	{
+		float scale = MaxFloat(AbsoluteValue(referenceValues[valueIndex]), 1.f);
+		maxError = MaxFloat(maxError, AbsoluteValue(values[valueIndex] - referenceValues[valueIndex]) / scale);
+	}
+
+	return maxError;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// One iteration is one slerp between random rotations
+//
+bool Benchmark_QuaternionSlerp(int iterationCount, BenchmarkTimer& timer)
+{
+	std::vector<Quaternion> rotations;
+	for (int rotationIndex = 0; rotationIndex < BENCHMARK_MATRIX_COUNT; ++rotationIndex)
+	{
+		rotations.push_back(Quaternion::FromEuler(Vector3(GetRandomFloatInRange(0.f, 360.f), GetRandomFloatInRange(0.f, 360.f), GetRandomFloatInRange(0.f, 360.f))));
+	}
+
+	float sum = 0.f;
+
+	timer.Start();
+	for (int iteration = 0; iteration < iterationCount; ++iteration)
+	{
+		const Quaternion& start = rotations[iteration % BENCHMARK_MATRIX_COUNT];
+		const Quaternion& end = rotations[(iteration + 1) % BENCHMARK_MATRIX_COUNT];
+
+		Quaternion result = Quaternion::Slerp(start, end, (float) (iteration & 0xFF) * (1.f / 255.f));
+		sum += result.s;
+	}
+	timer.Stop();
+
+	BenchmarkSuite::Consume(sum);
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// One iteration builds a 32x16 UV sphere, the builder's vertices reused between them
+//
+bool Benchmark_MeshBuilderSphere(int iterationCount, BenchmarkTimer& timer)
+{
+	MeshBuilder builder;
+	uint64_t vertexCount = 0;
+
+	timer.Start();
+	for (int iteration = 0; iteration < iterationCount; ++iteration)
+	{
+		builder.Clear();
+		builder.BeginBuilding(PRIMITIVE_TRIANGLES, true);
+		builder.PushUVSphere(Vector3::ZERO, 1.f, 32, 16);
+		builder.FinishBuilding();
+
+		vertexCount += builder.GetVertexCount();
+	}
+	timer.Stop();
+
+	BenchmarkSuite::Consume(vertexCount);
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// One iteration builds one cube
+//
+bool Benchmark_MeshBuilderCube(int iterationCount, BenchmarkTimer& timer)
+{
+	MeshBuilder builder;
+	uint64_t vertexCount = 0;
+
+	timer.Start();
+	for (int iteration = 0; iteration < iterationCount; ++iteration)
+	{
+		builder.Clear();
+		builder.BeginBuilding(PRIMITIVE_TRIANGLES, true);
+		builder.PushCube(Vector3::ZERO, Vector3::ONES);
+		builder.FinishBuilding();
+
+		vertexCount += builder.GetVertexCount();
+	}
+	timer.Stop();
+
+	BenchmarkSuite::Consume(vertexCount);
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// One iteration writes 16 uint32s and 16 floats, from the start of the buffer
+//
+bool Benchmark_BytePackerWrite(int iterationCount, BenchmarkTimer& timer)
+{
+	BytePacker packer(BENCHMARK_BYTE_PACKER_SIZE, true);
+
+	timer.Start();
+	for (int iteration = 0; iteration < iterationCount; ++iteration)
+	{
+		packer.ResetWrite();
+
+		for (int valueIndex = 0; valueIndex < 16; ++valueIndex)
+		{
+			packer.Write((uint32_t) (iteration + valueIndex));
+			packer.Write((float) valueIndex * 0.5f);
+		}
+	}
+	timer.Stop();
+
+	BenchmarkSuite::Consume((uint64_t) packer.GetWrittenByteCount());
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// One iteration reads back what one iteration of the write case writes
+//
+bool Benchmark_BytePackerRead(int iterationCount, BenchmarkTimer& timer)
+{
+	BytePacker packer(BENCHMARK_BYTE_PACKER_SIZE, true);
+
+	for (int valueIndex = 0; valueIndex < 16; ++valueIndex)
+	{
+		packer.Write((uint32_t) valueIndex);
+		packer.Write((float) valueIndex * 0.5f);
+	}
+
+	uint64_t sum = 0;
+
+	timer.Start();
+	for (int iteration = 0; iteration < iterationCount; ++iteration)
+	{
+		packer.ResetRead();
+
+		for (int valueIndex = 0; valueIndex < 16; ++valueIndex)
+		{
+			uint32_t integerValue;
+			float floatValue;
+
+			packer.Read(integerValue);
+			packer.Read(floatValue);
+
+			sum += integerValue + (uint64_t) floatValue;
+		}
+	}
+	timer.Stop();
+
+	BenchmarkSuite::Consume(sum);
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Makes the 32 byte heartbeat messages the packet cases write, with a session for their definitions
+//
+void MakeBenchmarkMessages(NetSession* session, std::vector<NetMessage*>& out_messages)
+{
+	for (int messageIndex = 0; messageIndex < BENCHMARK_PACKET_MESSAGE_COUNT; ++messageIndex)
+	{
+		NetMessage* message = new NetMessage("heartbeat", session);
+
+		for (int valueIndex = 0; valueIndex < 8; ++valueIndex)
+		{
+			message->Write((uint32_t) (messageIndex * 8 + valueIndex));
+		}
+
+		out_messages.push_back(message);
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Writes the header and messages to the packet, the way the session fills one to send
+//
+void WriteBenchmarkPacket(NetPacket& packet, const std::vector<NetMessage*>& messages)
+{
+	packet.Reset();
+	packet.AdvanceWriteHead(PACKET_HEADER_SIZE);
+
+	for (int messageIndex = 0; messageIndex < (int) messages.size(); ++messageIndex)
+	{
+		packet.WriteMessage(messages[messageIndex]);
+	}
+
+	packet.WriteHeader(PacketHeader_t(0, (uint8_t) messages.size()));
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// One iteration writes a packet of 16 messages
+//
+bool Benchmark_NetPacketWrite(int iterationCount, BenchmarkTimer& timer)
+{
+	NetSession* session = new NetSession();
+	std::vector<NetMessage*> messages;
+	MakeBenchmarkMessages(session, messages);
+
+	NetPacket packet;
+
+	timer.Start();
+	for (int iteration = 0; iteration < iterationCount; ++iteration)
+	{
+		WriteBenchmarkPacket(packet, messages);
+	}
+	timer.Stop();
+
+	BenchmarkSuite::Consume((uint64_t) packet.GetWrittenByteCount());
+
+	for (int messageIndex = 0; messageIndex < (int) messages.size(); ++messageIndex)
+	{
+		delete messages[messageIndex];
+	}
+
+	delete session;
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// One iteration reads the header and the 16 messages back out of the packet
+//
+bool Benchmark_NetPacketRead(int iterationCount, BenchmarkTimer& timer)
+{
+	NetSession* session = new NetSession();
+	std::vector<NetMessage*> messages;
+	MakeBenchmarkMessages(session, messages);
+
+	NetPacket packet;
+	WriteBenchmarkPacket(packet, messages);
+
+	NetMessage readMessage;
+	uint64_t payloadBytes = 0;
+
+	timer.Start();
+	for (int iteration = 0; iteration < iterationCount; ++iteration)
+	{
+		packet.ResetRead();
+
+		PacketHeader_t header;
+		packet.ReadHeader(header);
+
+		for (int messageIndex = 0; messageIndex < header.totalMessageCount; ++messageIndex)
+		{
+			packet.ReadMessage(&readMessage, session);
+			payloadBytes += readMessage.GetPayloadSize();
+		}
+	}
+	timer.Stop();
+
+	BenchmarkSuite::Consume(payloadBytes);
+
+	for (int messageIndex = 0; messageIndex < (int) messages.size(); ++messageIndex)
+	{
+		delete messages[messageIndex];
+	}
+
+	delete session;
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// One iteration solves a 64x64 map from a seed in the middle, to any distance
+//
+bool Benchmark_HeatMapSolve(int iterationCount, BenchmarkTimer& timer)
+{
+	HeatMap heatMap(IntVector2(BENCHMARK_HEAT_MAP_SIZE, BENCHMARK_HEAT_MAP_SIZE), 9999.f);
+	IntVector2 seedCoords = IntVector2(BENCHMARK_HEAT_MAP_SIZE / 2, BENCHMARK_HEAT_MAP_SIZE / 2);
+
+	timer.Start();
+	for (int iteration = 0; iteration < iterationCount; ++iteration)
+	{
+		heatMap.Clear(9999.f);
+		heatMap.Seed(0.f, seedCoords);
+		heatMap.SolveMapUpToDistance(9998.f);
+	}
+	timer.Stop();
+
+	BenchmarkSuite::Consume(heatMap.GetHeat(IntVector2(0, 0)));
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// One iteration solves a 512x512 map from seeds in each corner and the middle, tiled across the JobSystem
+//
+bool Benchmark_HeatMapSolveParallel(int iterationCount, BenchmarkTimer& timer)
+{
+	HeatMap heatMap(IntVector2(BENCHMARK_LARGE_HEAT_MAP_SIZE, BENCHMARK_LARGE_HEAT_MAP_SIZE), 99999.f);
+
+	std::vector<IntVector2> seedCoords;
+	seedCoords.push_back(IntVector2(0, 0));
+	seedCoords.push_back(IntVector2(BENCHMARK_LARGE_HEAT_MAP_SIZE - 1, 0));
+	seedCoords.push_back(IntVector2(0, BENCHMARK_LARGE_HEAT_MAP_SIZE - 1));
+	seedCoords.push_back(IntVector2(BENCHMARK_LARGE_HEAT_MAP_SIZE - 1, BENCHMARK_LARGE_HEAT_MAP_SIZE - 1));
+	seedCoords.push_back(IntVector2(BENCHMARK_LARGE_HEAT_MAP_SIZE / 2, BENCHMARK_LARGE_HEAT_MAP_SIZE / 2));
+
+	timer.Start();
+	for (int iteration = 0; iteration < iterationCount; ++iteration)
+	{
+		heatMap.Clear(99999.f);
+		heatMap.Seed(0.f, seedCoords);
+		heatMap.SolveMapUpToDistanceParallel(99998.f);
+	}
+	timer.Stop();
+
+	BenchmarkSuite::Consume(heatMap.GetHeat(IntVector2(BENCHMARK_LARGE_HEAT_MAP_SIZE / 4, BENCHMARK_LARGE_HEAT_MAP_SIZE / 4)));
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// One iteration is one sample of 4 octave 2D fractal noise
+//
+bool Benchmark_SmoothNoise2D(int iterationCount, BenchmarkTimer& timer)
+{
+	float sum = 0.f;
+
+	timer.Start();
+	for (int iteration = 0; iteration < iterationCount; ++iteration)
+	{
+		sum += Compute2dFractalNoise((float) (iteration & 0xFF) * 0.37f, (float) (iteration >> 8) * 0.37f, 10.f, 4);
+	}
+	timer.Stop();
+
+	BenchmarkSuite::Consume(sum);
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// One iteration is one sample of 4 octave 2D fractal noise, evaluated a grid row at a time on this thread
+//
+bool Benchmark_SmoothNoise2DBatch(int iterationCount, BenchmarkTimer& timer)
+{
+	float rowNoise[BENCHMARK_NOISE_ROW_SIZE];
+	float sum = 0.f;
+
+	timer.Start();
+	for (int iteration = 0; iteration < iterationCount; iteration += BENCHMARK_NOISE_ROW_SIZE)
+	{
+		int rowSize = MinInt(BENCHMARK_NOISE_ROW_SIZE, iterationCount - iteration);
+		Vector2 rowOrigin = Vector2(0.f, (float) (iteration / BENCHMARK_NOISE_ROW_SIZE) * 0.37f);
+
+		Compute2dFractalNoiseGrid(rowNoise, IntVector2(rowSize, 1), rowOrigin, Vector2(0.37f, 0.37f), 10.f, 4, 0.5f, 2.f, true, 0, false);
+		sum += rowNoise[0];
+	}
+	timer.Stop();
+
+	BenchmarkSuite::Consume(sum);
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// One iteration is one sample of 4 octave 3D fractal noise
+//
+bool Benchmark_SmoothNoise3D(int iterationCount, BenchmarkTimer& timer)
+{
+	float sum = 0.f;
+
+	timer.Start();
+	for (int iteration = 0; iteration < iterationCount; ++iteration)
+	{
+		sum += Compute3dFractalNoise((float) (iteration & 0x3F) * 0.37f, (float) ((iteration >> 6) & 0x3F) * 0.37f, (float) (iteration >> 12) * 0.37f, 10.f, 4);
+	}
+	timer.Stop();
+
+	BenchmarkSuite::Consume(sum);
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// One iteration is queueing one empty job, all of them queued before waiting for them to finish
+//
+bool Benchmark_JobSystemThroughput(int iterationCount, BenchmarkTimer& timer)
+{
+	JobSystem* jobSystem = JobSystem::GetInstance();
+
+	if (jobSystem == nullptr || jobSystem->GetWorkerThreadCount() == 0)
+	{
+		return false;
+	}
+
+	std::atomic<int> finishedCount(0);
+	std::atomic<int>* finishedCounter = &finishedCount;
+
+	timer.Start();
+	for (int iteration = 0; iteration < iterationCount; ++iteration)
+	{
+		jobSystem->QueueJob(new FunctionJob([finishedCounter]() { finishedCounter->fetch_add(1, std::memory_order_relaxed); }));
+	}
+
+	while (finishedCount.load(std::memory_order_relaxed) < iterationCount)
+	{
+		std::this_thread::yield();
+	}
+	timer.Stop();
+
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// One iteration sorts the keys of 4096 draw calls, the sort ForwardRenderingPath does per pass
+// Draw calls can't be made without a renderer, so the keys are random ones packed the same way
+//
+bool Benchmark_ForwardRenderingSort(int iterationCount, BenchmarkTimer& timer)
+{
+	std::vector<uint64_t> sourceKeys(BENCHMARK_SORT_KEY_COUNT);
+	for (int keyIndex = 0; keyIndex < BENCHMARK_SORT_KEY_COUNT; ++keyIndex)
+	{
+		// A few layers and queues, with random state/depth bits below them
+		uint64_t layerAndQueue = (uint64_t) GetRandomIntLessThan(4) << 56;
+		uint64_t state = ((uint64_t) GetRandomIntLessThan(0x10000) << 32) | (uint64_t) (uint32_t) GetRandomIntLessThan(0x7FFFFFFF);
+
+		sourceKeys[keyIndex] = layerAndQueue | state;
+	}
+
+	std::vector<uint64_t> keys;
+	std::vector<int> drawOrder;
+	std::vector<uint64_t> scratchKeys;
+	std::vector<int> scratchOrder;
+
+	uint64_t checksum = 0;
+
+	timer.Start();
+	for (int iteration = 0; iteration < iterationCount; ++iteration)
+	{
+		keys = sourceKeys;
+		drawOrder.resize(BENCHMARK_SORT_KEY_COUNT);
+
+		for (int keyIndex = 0; keyIndex < BENCHMARK_SORT_KEY_COUNT; ++keyIndex)
+		{
+			drawOrder[keyIndex] = keyIndex;
+		}
+
+		ForwardRenderingPath::RadixSortKeys(keys, drawOrder, scratchKeys, scratchOrder);
+		checksum += (uint64_t) drawOrder[0];
+	}
+	timer.Stop();
+
+	BenchmarkSuite::Consume(checksum);
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Registers the benchmark commands
+//
+void BenchmarkSuite::InitializeConsoleCommands()
+{
+	Command::Register("benchmark_run",		"Runs the benchmarks containing n, writing the results to f. Params: n=filter, s=samples, ms=sample length, f=file",	Command_BenchmarkRun);
+	Command::Register("benchmark_list",		"Lists the benchmark cases.",																						Command_BenchmarkList);
+	Command::Register("benchmark_compare",	"Compares the medians of two benchmark result files, a=before, b=after",											Command_BenchmarkCompare);
+	Command::Register("benchmark_check_simd", "Checks the Matrix44 SIMD kernels give the same results as their scalar references",						Command_BenchmarkCheckSIMD);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a case to the suite, replacing any with the same name
+//
+void BenchmarkSuite::RegisterCase(const std::string& name, BenchmarkFunction function)
+{
+	RegisterEngineCases();
+
+	for (int caseIndex = 0; caseIndex < (int) s_cases.size(); ++caseIndex)
+	{
+		if (s_cases[caseIndex].name == name)
+		{
+			s_cases[caseIndex].function = function;
+			return;
+		}
+	}
+
+	BenchmarkCase_t benchmarkCase;
+	benchmarkCase.name = name;
+	benchmarkCase.function = function;
+
+	s_cases.push_back(benchmarkCase);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the names of every case, in the order they run
+//
+void BenchmarkSuite::GetCaseNames(std::vector<std::string>& out_names)
+{
+	RegisterEngineCases();
+
+	for (int caseIndex = 0; caseIndex < (int) s_cases.size(); ++caseIndex)
+	{
+		out_names.push_back(s_cases[caseIndex].name);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Runs the matching cases in order, skipping any that can't run in this process
+//
+void BenchmarkSuite::Run(const std::string& filter, int sampleCount, float sampleMilliseconds, std::vector<BenchmarkResult_t>& out_results)
+{
+	RegisterEngineCases();
+
+	for (int caseIndex = 0; caseIndex < (int) s_cases.size(); ++caseIndex)
+	{
+		const BenchmarkCase_t& benchmarkCase = s_cases[caseIndex];
+
+		if (filter.size() > 0 && benchmarkCase.name.find(filter) == std::string::npos)
+		{
+			continue;
+		}
+
+		BenchmarkResult_t result;
+		if (RunCase(benchmarkCase, sampleCount, sampleMilliseconds, result))
+		{
+			out_results.push_back(result);
+		}
+		else
+		{
+			LogTaggedPrintf("BENCHMARK", "Skipped \"%s\", it can't run in this process", benchmarkCase.name.c_str());
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the results as CSV, one case per line, with the build it's from in a comment on top
+//
+bool BenchmarkSuite::WriteResults(const std::string& filePath, const std::vector<BenchmarkResult_t>& results)
+{
+	File file;
+	if (!file.Open(filePath.c_str(), "w"))
+	{
+		return false;
+	}
+
+#ifdef _DEBUG
+	const char* configuration = "Debug";
+#else
+	const char* configuration = "Release";
+#endif
+
+	std::string text = Stringf("# %s build, compiled %s %s\n", configuration, __DATE__, __TIME__);
+	text += "name,iterations_per_sample,samples,min_ns,median_ns,mean_ns,max_ns\n";
+
+	for (int resultIndex = 0; resultIndex < (int) results.size(); ++resultIndex)
+	{
+		const BenchmarkResult_t& result = results[resultIndex];
+
+		text += Stringf("%s,%i,%i,%.3f,%.3f,%.3f,%.3f\n", result.name.c_str(), result.iterationsPerSample, result.sampleCount,
+			result.minNanoseconds, result.medianNanoseconds, result.meanNanoseconds, result.maxNanoseconds);
+	}
+
+	file.Write(text.c_str(), text.size());
+	file.Close();
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads results written by WriteResults(), skipping the comment, the column names and any
+// malformed lines
+//
+bool BenchmarkSuite::ReadResults(const std::string& filePath, std::vector<BenchmarkResult_t>& out_results)
+{
+	File file;
+	if (!file.Open(filePath.c_str(), "r"))
+	{
+		return false;
+	}
+
+	file.LoadFileToMemory();
+
+	while (!file.IsAtEndOfFile())
+	{
+		std::string line;
+		file.GetNextLine(line);
+
+		if (line.size() == 0 || line[0] == '#' || line.find("name,") == 0)
+		{
+			continue;
+		}
+
+		std::vector<std::string> tokens = Tokenize(line, ',');
+		if (tokens.size() != 7)
+		{
+			continue;
+		}
+
+		BenchmarkResult_t result;
+		result.name					= tokens[0];
+		result.iterationsPerSample	= StringToInt(tokens[1]);
+		result.sampleCount			= StringToInt(tokens[2]);
+		result.minNanoseconds		= (double) StringToFloat(tokens[3]);
+		result.medianNanoseconds	= (double) StringToFloat(tokens[4]);
+		result.meanNanoseconds		= (double) StringToFloat(tokens[5]);
+		result.maxNanoseconds		= (double) StringToFloat(tokens[6]);
+
+		out_results.push_back(result);
+	}
+
+	file.Close();
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stores the value where the compiler has to assume it's read
+//
+void BenchmarkSuite::Consume(float value)
+{
+	s_floatSink = s_floatSink + value;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stores the value where the compiler has to assume it's read
+//
+void BenchmarkSuite::Consume(uint64_t value)
+{
+	s_integerSink = s_integerSink + value;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the engine's cases, once
+//
+void BenchmarkSuite::RegisterEngineCases()
+{
+	if (s_areEngineCasesRegistered)
+	{
+		return;
+	}
+
+	s_areEngineCasesRegistered = true;
+
+	RegisterCase("matrix44_multiply",			Benchmark_Matrix44Multiply);
+	RegisterCase("matrix44_invert",				Benchmark_Matrix44Invert);
+	RegisterCase("matrix44_multiply_reference",	Benchmark_Matrix44MultiplyReference);
+	RegisterCase("matrix44_invert_reference",	Benchmark_Matrix44InvertReference);
+	RegisterCase("matrix44_invert_affine",		Benchmark_Matrix44InvertAffine);
+	RegisterCase("matrix44_transform_points",	Benchmark_Matrix44TransformPoints);
+	RegisterCase("quaternion_slerp",			Benchmark_QuaternionSlerp);
+	RegisterCase("quaternion_fast_slerp_array",	Benchmark_QuaternionFastSlerpArray);
+	RegisterCase("meshbuilder_sphere",			Benchmark_MeshBuilderSphere);
+	RegisterCase("meshbuilder_cube",			Benchmark_MeshBuilderCube);
+	RegisterCase("bytepacker_write",			Benchmark_BytePackerWrite);
+	RegisterCase("bytepacker_read",				Benchmark_BytePackerRead);
+	RegisterCase("netpacket_write",				Benchmark_NetPacketWrite);
+	RegisterCase("netpacket_read",				Benchmark_NetPacketRead);
+	RegisterCase("heatmap_solve",				Benchmark_HeatMapSolve);
+	RegisterCase("heatmap_solve_parallel",		Benchmark_HeatMapSolveParallel);
+	RegisterCase("smoothnoise_fractal_2d",		Benchmark_SmoothNoise2D);
+	RegisterCase("smoothnoise_fractal_2d_batch",	Benchmark_SmoothNoise2DBatch);
+	RegisterCase("smoothnoise_fractal_3d",		Benchmark_SmoothNoise3D);
+	RegisterCase("jobsystem_throughput",		Benchmark_JobSystemThroughput);
+	RegisterCase("forwardrendering_sort",		Benchmark_ForwardRenderingSort);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds how many iterations make a sample about sampleMilliseconds long, then times the samples
+// Returns false if the case can't run
+//
+bool BenchmarkSuite::RunCase(const BenchmarkCase_t& benchmarkCase, int sampleCount, float sampleMilliseconds, BenchmarkResult_t& out_result)
+{
+	uint64_t targetSampleHPC = TimeSystem::SecondsToPerformanceCount((double) sampleMilliseconds * 0.001);
+
+	// Doubling also warms the caches up before the samples that count
+	int iterationCount = 1;
+	while (true)
+	{
+		BenchmarkTimer timer;
+		if (!benchmarkCase.function(iterationCount, timer))
+		{
+			return false;
+		}
+
+		if (timer.GetElapsedHPC() >= targetSampleHPC || iterationCount >= BENCHMARK_MAX_ITERATIONS_PER_SAMPLE)
+		{
+			break;
+		}
+
+		iterationCount *= 2;
+	}
+
+	std::vector<double> sampleNanoseconds;
+	for (int sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex)
+	{
+		BenchmarkTimer timer;
+		benchmarkCase.function(iterationCount, timer);
+
+		double seconds = TimeSystem::PerformanceCountToSeconds(timer.GetElapsedHPC());
+		sampleNanoseconds.push_back((seconds * 1000000000.0) / (double) iterationCount);
+	}
+
+	std::sort(sampleNanoseconds.begin(), sampleNanoseconds.end());
+
+	double sum = 0.0;
+	for (int sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex)
+	{
+		sum += sampleNanoseconds[sampleIndex];
+	}
+
+	out_result.name					= benchmarkCase.name;
+	out_result.iterationsPerSample	= iterationCount;
+	out_result.sampleCount			= sampleCount;
+	out_result.minNanoseconds		= sampleNanoseconds.front();
+	out_result.medianNanoseconds	= sampleNanoseconds[sampleCount / 2];
+	out_result.meanNanoseconds		= sum / (double) sampleCount;
+	out_result.maxNanoseconds		= sampleNanoseconds.back();
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Runs the benchmarks, printing each result and writing them all to a file
+//
+void Command_BenchmarkRun(Command& cmd)
+{
+	std::string filter;
+	int sampleCount = BENCHMARK_DEFAULT_SAMPLE_COUNT;
+	float sampleMilliseconds = BENCHMARK_DEFAULT_SAMPLE_MS;
+	std::string filePath = "Data/Logs/Benchmarks.csv";
+
+	cmd.GetParam("n", filter);
+	cmd.GetParam("s", sampleCount, &sampleCount);
+	cmd.GetParam("ms", sampleMilliseconds, &sampleMilliseconds);
+	cmd.GetParam("f", filePath, &filePath);
+
+	if (sampleCount < 1)
+	{
+		ConsoleErrorf("Need at least one sample, got %i", sampleCount);
+		return;
+	}
+
+	std::vector<BenchmarkResult_t> results;
+	BenchmarkSuite::Run(filter, sampleCount, sampleMilliseconds, results);
+
+	if (results.size() == 0)
+	{
+		ConsoleErrorf("No benchmarks matching \"%s\" could run", filter.c_str());
+		return;
+	}
+
+	for (int resultIndex = 0; resultIndex < (int) results.size(); ++resultIndex)
+	{
+		const BenchmarkResult_t& result = results[resultIndex];
+
+		ConsolePrintf(Rgba::GREEN, "%-*s median %*.2f ns, min %*.2f ns, max %*.2f ns (%i x %i)", 26, result.name.c_str(),
+			12, result.medianNanoseconds, 12, result.minNanoseconds, 12, result.maxNanoseconds, result.sampleCount, result.iterationsPerSample);
+	}
+
+	if (BenchmarkSuite::WriteResults(filePath, results))
+	{
+		ConsolePrintf(Rgba::GREEN, "Wrote %i benchmark results to \"%s\".", (int) results.size(), filePath.c_str());
+	}
+	else
+	{
+		ConsoleErrorf("Couldn't open \"%s\" for the benchmark results.", filePath.c_str());
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Prints the name of every case
+//
+void Command_BenchmarkList(Command& cmd)
+{
+	UNUSED(cmd);
+
+	std::vector<std::string> names;
+	BenchmarkSuite::GetCaseNames(names);
+
+	for (int nameIndex = 0; nameIndex < (int) names.size(); ++nameIndex)
+	{
+		ConsolePrintf(Rgba::GREEN, "%s", names[nameIndex].c_str());
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Prints the change in median for every case in both files, red for slower and green for faster
+//
+void Command_BenchmarkCompare(Command& cmd)
+{
+	std::string beforePath;
+	std::string afterPath = "Data/Logs/Benchmarks.csv";
+
+	if (!cmd.GetParam("a", beforePath))
+	{
+		ConsoleErrorf("No results to compare against specified, use -a");
+		return;
+	}
+
+	cmd.GetParam("b", afterPath, &afterPath);
+
+	std::vector<BenchmarkResult_t> beforeResults;
+	std::vector<BenchmarkResult_t> afterResults;
+
+	if (!BenchmarkSuite::ReadResults(beforePath, beforeResults) || !BenchmarkSuite::ReadResults(afterPath, afterResults))
+	{
+		ConsoleErrorf("Couldn't read \"%s\" and \"%s\"", beforePath.c_str(), afterPath.c_str());
+		return;
+	}
+
+	for (int afterIndex = 0; afterIndex < (int) afterResults.size(); ++afterIndex)
+	{
+		const BenchmarkResult_t& after = afterResults[afterIndex];
+
+		for (int beforeIndex = 0; beforeIndex < (int) beforeResults.size(); ++beforeIndex)
+		{
+			const BenchmarkResult_t& before = beforeResults[beforeIndex];
+
+			if (before.name != after.name || before.medianNanoseconds <= 0.0)
+			{
+				continue;
+			}
+
+			float percentChange = (float) (((after.medianNanoseconds - before.medianNanoseconds) / before.medianNanoseconds) * 100.0);
+
+			Rgba color = Rgba::WHITE;
+			if (percentChange > BENCHMARK_COMPARE_THRESHOLD_PERCENT)
+			{
+				color = Rgba::RED;
+			}
+			else if (percentChange < -BENCHMARK_COMPARE_THRESHOLD_PERCENT)
+			{
+				color = Rgba::GREEN;
+			}
+
+			ConsolePrintf(color, "%-*s %*.2f ns -> %*.2f ns (%+.1f%%)", 26, after.name.c_str(), 12, before.medianNanoseconds, 12, after.medianNanoseconds, percentChange);
+			break;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Runs every Matrix44 kernel and its scalar reference on random model matrices, printing the worst differences
+//
+void Command_BenchmarkCheckSIMD(Command& cmd)
+{
+	UNUSED(cmd);
+
+	std::vector<Matrix44> matrices;
+	MakeRandomMatrices(matrices);
+
+	float multiplyError = 0.f;
+	float inverseError = 0.f;
+	float affineInverseError = 0.f;
+	float transformError = 0.f;
+
+	for (int matrixIndex = 0; matrixIndex < BENCHMARK_MATRIX_COUNT; ++matrixIndex)
+	{
+		const Matrix44& left = matrices[matrixIndex];
+		const Matrix44& right = matrices[(matrixIndex + 1) % BENCHMARK_MATRIX_COUNT];
+
+		Matrix44 product = left * right;
+		Matrix44 productReference = Matrix44::MultiplyReference(left, right);
+		Matrix44 inverse = Matrix44::GetInverse(left);
+		Matrix44 affineInverse = Matrix44::GetInverseAffine(left);
+		Matrix44 inverseReference = Matrix44::GetInverseReference(left);
+
+		multiplyError		= MaxFloat(multiplyError,		GetMaxRelativeError(&product.Ix,		&productReference.Ix, 16));
+		inverseError		= MaxFloat(inverseError,		GetMaxRelativeError(&inverse.Ix,		&inverseReference.Ix, 16));
+		affineInverseError	= MaxFloat(affineInverseError,	GetMaxRelativeError(&affineInverse.Ix,	&inverseReference.Ix, 16));
+
+		// Batch transforms, against the reference of each point and vector alone
+		Vector3 points[2] = { right.GetTVector().xyz(), right.GetIVector().xyz() };
+		Vector3 transformedPoints[2];
+		Vector3 transformedVectors[2];
+
+		left.TransformPoints(points, 2, transformedPoints);
+		left.TransformVectors(points, 2, transformedVectors);
+
+		for (int pointIndex = 0; pointIndex < 2; ++pointIndex)
+		{
+			Vector4 pointReference = Matrix44::TransformReference(left, Vector4(points[pointIndex], 1.f));
+			Vector4 vectorReference = Matrix44::TransformReference(left, Vector4(points[pointIndex], 0.f));
+
+			transformError = MaxFloat(transformError, GetMaxRelativeError(&transformedPoints[pointIndex].x, &pointReference.x, 3));
+			transformError = MaxFloat(transformError, GetMaxRelativeError(&transformedVectors[pointIndex].x, &vectorReference.x, 3));
+		}
+	}
+
+	float errors[4] = { multiplyError, inverseError, affineInverseError, transformError };
+	const char* names[4] = { "Multiply", "Inverse", "Affine inverse", "Transform" };
+
+	ConsolePrintf(Rgba::GREEN, "Matrix44 kernels: %s, over %i random matrices", Matrix44::GetSIMDPathName(), BENCHMARK_MATRIX_COUNT);
+
+	for (int kernelIndex = 0; kernelIndex < 4; ++kernelIndex)
+	{
+		Rgba color = (errors[kernelIndex] <= BENCHMARK_SIMD_CHECK_TOLERANCE ? Rgba::GREEN : Rgba::RED);
+		ConsolePrintf(color, "%-*s max relative error %g", 16, names[kernelIndex], errors[kernelIndex]);
+	}
+}
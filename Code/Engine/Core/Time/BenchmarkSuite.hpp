@@ -0,0 +1,97 @@
+/************************************************************************/
+/* File: BenchmarkSuite.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Microbenchmarks of engine systems, run from the console
+/*				and written to a CSV file that can be compared across builds
+/************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#define BENCHMARK_DEFAULT_SAMPLE_COUNT (15)
+#define BENCHMARK_DEFAULT_SAMPLE_MS (10.f)				// Iterations per sample are doubled until a sample takes this long
+#define BENCHMARK_MAX_ITERATIONS_PER_SAMPLE (1 << 24)
+#define BENCHMARK_COMPARE_THRESHOLD_PERCENT (5.f)		// Changes in the median smaller than this are shown as noise
+
+// Cases do their setup, then time only the loop with Start() and Stop()
+class BenchmarkTimer
+{
+public:
+	//-----Public Methods-----
+
+	void		Start();
+	void		Stop();
+	uint64_t	GetElapsedHPC() const;
+
+
+private:
+	//-----Private Data-----
+
+	uint64_t	m_startHPC = 0;
+	uint64_t	m_elapsedHPC = 0;
+
+};
+
+// Runs the operation measured iterationCount times, between the timer's Start() and Stop()
+// Returns false if the case can't run in this process (e.g. no job workers)
+typedef bool(*BenchmarkFunction)(int iterationCount, BenchmarkTimer& timer);
+
+struct BenchmarkCase_t
+{
+	std::string			name;
+	BenchmarkFunction	function = nullptr;
+};
+
+// Times are per iteration, over the samples
+struct BenchmarkResult_t
+{
+	std::string	name;
+	int			iterationsPerSample = 0;
+	int			sampleCount = 0;
+	double		minNanoseconds = 0.0;
+	double		medianNanoseconds = 0.0;
+	double		meanNanoseconds = 0.0;
+	double		maxNanoseconds = 0.0;
+};
+
+
+class BenchmarkSuite
+{
+public:
+	//-----Public Methods-----
+
+	static void		InitializeConsoleCommands();
+
+	// The engine's cases are registered on the first use; games can add their own
+	static void		RegisterCase(const std::string& name, BenchmarkFunction function);
+	static void		GetCaseNames(std::vector<std::string>& out_names);
+
+	// Runs every case whose name contains the filter (all of them if it's empty), blocking until done
+	static void		Run(const std::string& filter, int sampleCount, float sampleMilliseconds, std::vector<BenchmarkResult_t>& out_results);
+
+	static bool		WriteResults(const std::string& filePath, const std::vector<BenchmarkResult_t>& results);
+	static bool		ReadResults(const std::string& filePath, std::vector<BenchmarkResult_t>& out_results);
+
+	// Keeps the compiler from optimizing away work whose result is otherwise unused
+	static void		Consume(float value);
+	static void		Consume(uint64_t value);
+
+
+private:
+	//-----Private Methods-----
+
+	BenchmarkSuite() = delete;
+
+	static void		RegisterEngineCases();
+	static bool		RunCase(const BenchmarkCase_t& benchmarkCase, int sampleCount, float sampleMilliseconds, BenchmarkResult_t& out_result);
+
+
+private:
+	//-----Private Data-----
+
+	static std::vector<BenchmarkCase_t>	s_cases;
+	static bool							s_areEngineCasesRegistered;
+
+};
@@ -8,21 +8,21 @@
 #include "Engine/Core/Time/Time.hpp"
 #include "Engine/Core/Time/Clock.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Memory/LinearAllocator.hpp"
 
 
 // Master clock of the system, constructed before main()
 Clock		Clock::s_masterClock;
 std::string Clock::s_frameFormattedSystemTime;
+unsigned int Clock::s_stepCount = 0;
 
 
 //-----------------------------------------------------------------------------------------------
 // Default constructor - no parent
 //
 Clock::Clock()
-	: m_parent(nullptr)
-	, m_scale(1.0f)
-	, m_isPaused(false)
 {
+	m_clockID = AllocateClockEntry(INVALID_CLOCK_ID);
 	ResetTimeData();
 }
 
@@ -31,16 +31,31 @@ Clock::Clock()
 // Constructor for a specified parent
 //
 Clock::Clock(Clock* parent)
-	: m_parent(parent)
-	, m_scale(1.0f)
-	, m_isPaused(false)
 {
+	m_clockID = AllocateClockEntry(parent != nullptr ? parent->m_clockID : INVALID_CLOCK_ID);
 	ResetTimeData();
+}
+
 
-	if (m_parent != nullptr)
+//-----------------------------------------------------------------------------------------------
+// Destructor - frees the table entry, giving this clock's children to its parent
+// The parent's index is lower than this clock's, so the children still come after it
+//
+Clock::~Clock()
+{
+	std::vector<ClockTableEntry_t>& table = GetClockTable();
+	ClockID parentID = table[m_clockID].parentID;
+
+	for (int entryIndex = m_clockID + 1; entryIndex < (int) table.size(); ++entryIndex)
 	{
-		m_parent->AddChild(this);
+		if (table[entryIndex].isInUse && table[entryIndex].parentID == m_clockID)
+		{
+			table[entryIndex].parentID = parentID;
+		}
 	}
+
+	table[m_clockID] = ClockTableEntry_t();
+	m_clockID = INVALID_CLOCK_ID;
 }
 
 
@@ -71,6 +86,9 @@ void Clock::BeginFrame()
 
 	// Update based on elapsed
 	FrameStep(elapsed);
+
+	// Frees the frame before last's transient allocations
+	FrameArena::BeginFrame();
 }
 
 
@@ -88,7 +106,7 @@ Clock* Clock::GetMasterClock()
 //
 uint64_t Clock::GetMasterTotalTime()
 {
-	return s_masterClock.m_totalData.m_hpc;
+	return s_masterClock.GetTotalHPC();
 }
 
 
@@ -97,7 +115,7 @@ uint64_t Clock::GetMasterTotalTime()
 //
 float Clock::GetMasterDeltaTime()
 {
-	return (float) s_masterClock.m_frameData.m_seconds;
+	return s_masterClock.GetDeltaTime();
 }
 
 
@@ -106,46 +124,31 @@ float Clock::GetMasterDeltaTime()
 //
 float Clock::GetMasterFPS()
 {
-	return (1.f / (float) s_masterClock.m_frameData.m_seconds);
+	return (1.f / s_masterClock.GetDeltaTime());
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Updates the time data of this clock and all children of this clock
+// Updates the time data of this clock and all of its descendants
+// Descendants are always later in the table, so one pass from this clock reaches them all after their parents
 //
 void Clock::FrameStep(uint64_t elapsedHPC)
 {
-	m_frameCount++;
+	std::vector<ClockTableEntry_t>& table = GetClockTable();
+	unsigned int stepNumber = ++s_stepCount;
 
-	if (m_isPaused)
-	{
-		elapsedHPC = 0;
-	}
-	else
-	{
-		// Apply scaling
-		elapsedHPC = (uint64_t)((double)elapsedHPC * m_scale);
-	}
-
-	double elapsedSeconds = TimeSystem::PerformanceCountToSeconds(elapsedHPC);
+	StepClockEntry(table[m_clockID], elapsedHPC, stepNumber);
 
-	// Clamp the elapsed to fit the delta max
-	if (elapsedSeconds > m_deltaLimitSeconds)
+	int tableSize = (int) table.size();
+	for (int entryIndex = m_clockID + 1; entryIndex < tableSize; ++entryIndex)
 	{
-		elapsedSeconds = m_deltaLimitSeconds;
-		elapsedHPC = TimeSystem::SecondsToPerformanceCount(elapsedSeconds);
-	}
-
-	m_frameData.m_seconds = elapsedSeconds;
-	m_frameData.m_hpc = elapsedHPC;
+		ClockTableEntry_t& entry = table[entryIndex];
 
-	m_totalData.m_seconds += elapsedSeconds;
-	m_totalData.m_hpc += elapsedHPC;
-
-	// Step all children
-	for (int clockIndex = 0; clockIndex < (int) m_childClocks.size(); ++clockIndex)
-	{
-		m_childClocks[clockIndex]->FrameStep(elapsedHPC);
+		// Only step clocks whose parent was stepped this pass, with the parent's scaled time
+		if (entry.isInUse && entry.parentID != INVALID_CLOCK_ID && table[entry.parentID].lastStepNumber == stepNumber)
+		{
+			StepClockEntry(entry, table[entry.parentID].frameData.m_hpc, stepNumber);
+		}
 	}
 }
 
@@ -155,22 +158,12 @@ void Clock::FrameStep(uint64_t elapsedHPC)
 //
 void Clock::ResetTimeData()
 {
-	m_lastFrameHPC = GetPerformanceCounter();
-	memset(&m_frameData, 0, sizeof(TimeData_t));
-	memset(&m_totalData, 0, sizeof(TimeData_t));
-	m_frameCount = 0;
-}
-
+	ClockTableEntry_t& entry = GetClockTable()[m_clockID];
 
-//-----------------------------------------------------------------------------------------------
-// Adds the given child clock to the list of children of this clock
-//
-void Clock::AddChild(Clock* child)
-{
-	if (child != nullptr)
-	{
-		m_childClocks.push_back(child);
-	}
+	m_lastFrameHPC = GetPerformanceCounter();
+	entry.frameData = TimeData_t();
+	entry.totalData = TimeData_t();
+	entry.frameCount = 0;
 }
 
 
@@ -179,7 +172,7 @@ void Clock::AddChild(Clock* child)
 //
 void Clock::SetMaxDeltaTime(float maxSeconds)
 {
-	m_deltaLimitSeconds = maxSeconds;
+	GetClockTable()[m_clockID].deltaLimitSeconds = maxSeconds;
 }
 
 
@@ -188,7 +181,7 @@ void Clock::SetMaxDeltaTime(float maxSeconds)
 //
 void Clock::SetScale(float newScale)
 {
-	m_scale = newScale;
+	GetClockTable()[m_clockID].scale = newScale;
 }
 
 
@@ -197,7 +190,7 @@ void Clock::SetScale(float newScale)
 //
 void Clock::SetPaused(bool pauseState)
 {
-	m_isPaused = pauseState;
+	GetClockTable()[m_clockID].isPaused = pauseState;
 }
 
 
@@ -206,7 +199,7 @@ void Clock::SetPaused(bool pauseState)
 //
 float Clock::GetDeltaTime() const
 {
-	return (float) m_frameData.m_seconds;
+	return GetDeltaTimeForClock(m_clockID);
 }
 
 
@@ -215,7 +208,7 @@ float Clock::GetDeltaTime() const
 //
 uint64_t Clock::GetFrameHPC() const
 {
-	return m_frameData.m_hpc;
+	return GetClockTable()[m_clockID].frameData.m_hpc;
 }
 
 
@@ -224,7 +217,7 @@ uint64_t Clock::GetFrameHPC() const
 //
 float Clock::GetTotalSeconds() const
 {
-	return (float) m_totalData.m_seconds;
+	return GetTotalSecondsForClock(m_clockID);
 }
 
 
@@ -233,5 +226,129 @@ float Clock::GetTotalSeconds() const
 //
 uint64_t Clock::GetTotalHPC() const
 {
-	return m_totalData.m_hpc;
+	return GetTotalHPCForClock(m_clockID);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the index of this clock's entry in the clock table
+//
+ClockID Clock::GetID() const
+{
+	return m_clockID;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the frame time (scaled) of the clock with the given ID, in seconds
+//
+float Clock::GetDeltaTimeForClock(ClockID clockID)
+{
+	return (float) GetClockTable()[clockID].frameData.m_seconds;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the total time passed (after scales) of the clock with the given ID, in seconds
+//
+float Clock::GetTotalSecondsForClock(ClockID clockID)
+{
+	return (float) GetClockTable()[clockID].totalData.m_seconds;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the total time passed (after scales) of the clock with the given ID, in performance counts
+//
+uint64_t Clock::GetTotalHPCForClock(ClockID clockID)
+{
+	return GetClockTable()[clockID].totalData.m_hpc;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of entries in the clock table, including freed ones
+//
+int Clock::GetClockTableSize()
+{
+	return (int) GetClockTable().size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the table of every clock's state
+// Made on first use, since clocks can be constructed before main() in any translation unit
+//
+std::vector<ClockTableEntry_t>& Clock::GetClockTable()
+{
+	static std::vector<ClockTableEntry_t> s_clockTable;
+	return s_clockTable;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Takes a free entry after the parent's, or adds one to the end, returning its ID
+//
+ClockID Clock::AllocateClockEntry(ClockID parentID)
+{
+	std::vector<ClockTableEntry_t>& table = GetClockTable();
+
+	// Freed entries before the parent can't be reused, the parent has to step first
+	ClockID clockID = INVALID_CLOCK_ID;
+	for (int entryIndex = parentID + 1; entryIndex < (int) table.size(); ++entryIndex)
+	{
+		if (!table[entryIndex].isInUse)
+		{
+			clockID = entryIndex;
+			break;
+		}
+	}
+
+	if (clockID == INVALID_CLOCK_ID)
+	{
+		clockID = (ClockID) table.size();
+		table.push_back(ClockTableEntry_t());
+	}
+
+	ClockTableEntry_t& entry = table[clockID];
+	entry = ClockTableEntry_t();
+	entry.parentID = parentID;
+	entry.isInUse = true;
+
+	return clockID;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Updates the entry's time data with the elapsed time, after its pause, scale and delta limit
+//
+void Clock::StepClockEntry(ClockTableEntry_t& entry, uint64_t elapsedHPC, unsigned int stepNumber)
+{
+	entry.frameCount++;
+	entry.lastStepNumber = stepNumber;
+
+	if (entry.isPaused)
+	{
+		elapsedHPC = 0;
+	}
+	else
+	{
+		// Apply scaling
+		elapsedHPC = (uint64_t)((double)elapsedHPC * entry.scale);
+	}
+
+	double elapsedSeconds = TimeSystem::PerformanceCountToSeconds(elapsedHPC);
+
+	// Clamp the elapsed to fit the delta max
+	if (elapsedSeconds > entry.deltaLimitSeconds)
+	{
+		elapsedSeconds = entry.deltaLimitSeconds;
+		elapsedHPC = TimeSystem::SecondsToPerformanceCount(elapsedSeconds);
+	}
+
+	entry.frameData.m_seconds = elapsedSeconds;
+	entry.frameData.m_hpc = elapsedHPC;
+
+	entry.totalData.m_seconds += elapsedSeconds;
+	entry.totalData.m_hpc += elapsedHPC;
 }
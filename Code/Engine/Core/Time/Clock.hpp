@@ -8,6 +8,10 @@
 #include <stdint.h>
 #include <vector>
 
+// Index of a clock's row in the clock table
+typedef int ClockID;
+#define INVALID_CLOCK_ID (-1)
+
 
 // Struct for a set of time data, in hpc and seconds
 struct TimeData_t
@@ -22,23 +26,39 @@ struct TimeData_t
 
 };
 
+// A clock's state, kept in one flat table instead of on the clock - children always have higher
+// indices than their parents, so stepping the table in index order updates parents first
+struct ClockTableEntry_t
+{
+	ClockID			parentID = INVALID_CLOCK_ID;
+	bool			isInUse = false;
+	bool			isPaused = false;
+	double			scale = 1.0;
+	double			deltaLimitSeconds = 99999999.0;
+	unsigned int	frameCount = 0;
+	unsigned int	lastStepNumber = 0;		// Step this entry was last updated in, so children know their parent stepped
+
+	TimeData_t		frameData;
+	TimeData_t		totalData;
+};
+
 
 class Clock
 {
 public:
 	//-----Public Methods-----
 
-	// Constructors
+	// Constructors - clocks are a handle to their table entry, main thread only
 	Clock();
 	Clock(Clock* parent);
+	~Clock();
 
 	static void Initialize();
 	void		BeginFrame();
-	void		FrameStep(uint64_t elapsedHPC);
+	void		FrameStep(uint64_t elapsedHPC);		// Steps this clock and its descendants in one pass over the table
 
 	// Mutators
 	void ResetTimeData();
-	void AddChild(Clock* child);
 
 	void SetMaxDeltaTime(float maxSeconds);
 	void SetScale(float newScale);
@@ -51,6 +71,13 @@ public:
 
 	float		GetTotalSeconds() const;
 	uint64_t	GetTotalHPC() const;
+	ClockID		GetID() const;
+
+	// For things that keep a clock's ID instead of a pointer, i.e. Stopwatches
+	static float	GetDeltaTimeForClock(ClockID clockID);
+	static float	GetTotalSecondsForClock(ClockID clockID);
+	static uint64_t	GetTotalHPCForClock(ClockID clockID);
+	static int		GetClockTableSize();
 
 	static Clock*	GetMasterClock();
 	static uint64_t GetMasterTotalTime();
@@ -63,23 +90,20 @@ private:
 
 	Clock(const Clock& copy) = delete;	// No copying allowed
 
+	// Table management
+	static std::vector<ClockTableEntry_t>&	GetClockTable();
+	static ClockID							AllocateClockEntry(ClockID parentID);
+	static void								StepClockEntry(ClockTableEntry_t& entry, uint64_t elapsedHPC, unsigned int stepNumber);
+
 
 private:
 	//-----Private Data-----
 
-	Clock* m_parent;	// This clock's hierarchical parent
-	std::vector<Clock*> m_childClocks;
-
-	unsigned int	m_frameCount;
-	double			m_scale;
-	bool			m_isPaused;
-	double			m_deltaLimitSeconds = 99999999.f;
-
-	TimeData_t		m_frameData;
-	TimeData_t		m_totalData;
-
+	ClockID			m_clockID = INVALID_CLOCK_ID;
 	uint64_t		m_lastFrameHPC;
 
+	static unsigned int s_stepCount;
+
 	// Not a pointer - is constructed before main
 	static Clock s_masterClock;
 
@@ -0,0 +1,204 @@
+/************************************************************************/
+/* File: FixedStepScheduler.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the FixedStepScheduler class
+/************************************************************************/
+#include "Engine/Core/Time/FixedStepScheduler.hpp"
+#include "Engine/Core/Time/Time.hpp"
+#include "Engine/Core/Time/Clock.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - uses the master clock if none is given
+//
+FixedStepScheduler::FixedStepScheduler(double stepsPerSecond /*= FIXED_STEP_DEFAULT_HZ*/, Clock* referenceClock /*= nullptr*/)
+{
+	SetStepRate(stepsPerSecond);
+	SetClock(referenceClock);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Accumulates the reference clock's frame time and runs the steps that fit
+//
+int FixedStepScheduler::Update()
+{
+	return Advance(m_referenceClock->GetFrameHPC());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Accumulates the elapsed time and runs every whole step in the accumulator, up to the max per update
+// Anything past the max is dropped down to less than a step, so a frame that takes longer than the steps
+// it runs doesn't leave more for the next frame - the simulation slows down instead of spiraling
+//
+int FixedStepScheduler::Advance(uint64_t elapsedHPC)
+{
+	m_accumulatedHPC += elapsedHPC;
+
+	uint64_t numDueSteps = m_accumulatedHPC / m_stepHPC;
+	if (numDueSteps > (uint64_t) m_maxStepsPerUpdate)
+	{
+		m_droppedStepCount += (numDueSteps - (uint64_t) m_maxStepsPerUpdate);
+		m_accumulatedHPC = (m_accumulatedHPC % m_stepHPC) + ((uint64_t) m_maxStepsPerUpdate * m_stepHPC);
+	}
+
+	double stepSeconds = GetStepSeconds();
+	int numSteps = 0;
+
+	while (m_accumulatedHPC >= m_stepHPC)
+	{
+		m_accumulatedHPC -= m_stepHPC;
+		m_stepCount++;
+		numSteps++;
+
+		if (m_stepCallback != nullptr)
+		{
+			m_stepCallback(stepSeconds, m_stepCount, m_stepCallbackArgs);
+		}
+	}
+
+	m_lastUpdateStepCount = numSteps;
+	if (numSteps > 0)
+	{
+		m_lastStepHPC = GetPerformanceCounter();
+	}
+
+	return numSteps;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Clears the accumulator and the step counts, i.e. after loading or a long pause
+//
+void FixedStepScheduler::Reset()
+{
+	m_accumulatedHPC = 0;
+	m_stepCount = 0;
+	m_lastUpdateStepCount = 0;
+	m_droppedStepCount = 0;
+	m_lastStepHPC = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Blocks until the next step is due, measured from the last Update() that stepped and what's left in
+// the accumulator - for servers running the simulation with nothing else to pace them
+//
+void FixedStepScheduler::WaitForNextStep() const
+{
+	if (m_lastStepHPC == 0)
+	{
+		return;
+	}
+
+	uint64_t hpcUntilStep = (m_accumulatedHPC < m_stepHPC ? m_stepHPC - m_accumulatedHPC : 0);
+	WaitUntilPerformanceCounter(m_lastStepHPC + hpcUntilStep);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the seconds of the clock's time until the accumulator holds another step
+//
+double FixedStepScheduler::GetSecondsUntilNextStep() const
+{
+	uint64_t hpcUntilStep = (m_accumulatedHPC < m_stepHPC ? m_stepHPC - m_accumulatedHPC : 0);
+	return TimeSystem::PerformanceCountToSeconds(hpcUntilStep);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets how many steps run per second of the clock's time
+//
+void FixedStepScheduler::SetStepRate(double stepsPerSecond)
+{
+	ASSERT_OR_DIE(stepsPerSecond > 0.0, Stringf("Error: FixedStepScheduler given a step rate of %f", stepsPerSecond));
+
+	m_stepHPC = TimeSystem::SecondsToPerformanceCount(1.0 / stepsPerSecond);
+	m_stepHPC = (m_stepHPC > 0 ? m_stepHPC : 1);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the most steps one update can run, with anything more dropped
+//
+void FixedStepScheduler::SetMaxStepsPerUpdate(int maxSteps)
+{
+	m_maxStepsPerUpdate = MaxInt(maxSteps, 1);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the clock Update() takes its time from, the master clock if null
+//
+void FixedStepScheduler::SetClock(Clock* referenceClock)
+{
+	m_referenceClock = (referenceClock != nullptr ? referenceClock : Clock::GetMasterClock());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the function called for each step
+//
+void FixedStepScheduler::SetStepCallback(FixedStep_cb callback, void* args)
+{
+	m_stepCallback = callback;
+	m_stepCallbackArgs = args;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of steps run per second of the clock's time
+//
+double FixedStepScheduler::GetStepRate() const
+{
+	return (1.0 / GetStepSeconds());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the length of one step
+//
+double FixedStepScheduler::GetStepSeconds() const
+{
+	return TimeSystem::PerformanceCountToSeconds(m_stepHPC);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the fraction of a step left in the accumulator, to blend from the previous step's state to the latest
+//
+float FixedStepScheduler::GetInterpolationAlpha() const
+{
+	return (float) ((double) m_accumulatedHPC / (double) m_stepHPC);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the total number of steps run
+//
+uint64_t FixedStepScheduler::GetStepCount() const
+{
+	return m_stepCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of steps the last update ran
+//
+int FixedStepScheduler::GetLastUpdateStepCount() const
+{
+	return m_lastUpdateStepCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of steps dropped for being past the max per update
+//
+uint64_t FixedStepScheduler::GetDroppedStepCount() const
+{
+	return m_droppedStepCount;
+}
@@ -0,0 +1,71 @@
+/************************************************************************/
+/* File: FixedStepScheduler.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Runs the simulation at a fixed rate from a variable frame
+/*				rate, accumulating clock time into whole steps and leaving
+/*				the remainder as an interpolation alpha for rendering
+/************************************************************************/
+#pragma once
+#include <stdint.h>
+
+class Clock;
+
+#define FIXED_STEP_DEFAULT_HZ (60.0)
+#define FIXED_STEP_DEFAULT_MAX_STEPS_PER_UPDATE (5)		// Past this the time is dropped, so a slow step can't snowball
+
+// Called once per step with the fixed step size
+typedef void(*FixedStep_cb)(double stepSeconds, uint64_t stepNumber, void* args);
+
+
+class FixedStepScheduler
+{
+public:
+	//-----Public Methods-----
+
+	// Time comes from the clock's scaled delta, so pausing or scaling the clock does the same to the simulation
+	FixedStepScheduler(double stepsPerSecond = FIXED_STEP_DEFAULT_HZ, Clock* referenceClock = nullptr);
+
+	// Adds the clock's last frame to the accumulator and runs every whole step in it, returning the steps run
+	// Advance() takes the time directly instead, i.e. when driving the simulation without a clock
+	int			Update();
+	int			Advance(uint64_t elapsedHPC);
+	void		Reset();
+
+	// Headless loops - blocks until the next step is due by the performance counter, rather than by rendering
+	// Call Update() (after the clock's BeginFrame()) once it returns
+	void		WaitForNextStep() const;
+	double		GetSecondsUntilNextStep() const;
+
+	// Settings
+	void		SetStepRate(double stepsPerSecond);
+	void		SetMaxStepsPerUpdate(int maxSteps);
+	void		SetClock(Clock* referenceClock);
+	void		SetStepCallback(FixedStep_cb callback, void* args);
+
+	// Accessors
+	double		GetStepRate() const;
+	double		GetStepSeconds() const;
+	float		GetInterpolationAlpha() const;	// How far into the next step the frame is, in [0, 1), to blend the last two states
+	uint64_t	GetStepCount() const;			// Total steps run since the last Reset()
+	int			GetLastUpdateStepCount() const;
+	uint64_t	GetDroppedStepCount() const;	// Steps dropped by the max steps per update
+
+
+private:
+	//-----Private Data-----
+
+	Clock*			m_referenceClock = nullptr;
+	uint64_t		m_stepHPC = 0;
+	int				m_maxStepsPerUpdate = FIXED_STEP_DEFAULT_MAX_STEPS_PER_UPDATE;
+
+	uint64_t		m_accumulatedHPC = 0;
+	uint64_t		m_stepCount = 0;
+	int				m_lastUpdateStepCount = 0;
+	uint64_t		m_droppedStepCount = 0;
+	uint64_t		m_lastStepHPC = 0;		// Performance counter at the last Update() that stepped, for headless waits
+
+	FixedStep_cb	m_stepCallback = nullptr;
+	void*			m_stepCallbackArgs = nullptr;
+
+};
@@ -0,0 +1,246 @@
+/************************************************************************/
+/* File: ProfileCounters.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the ProfileCounters class
+/************************************************************************/
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/Time/ProfileCounters.hpp"
+#include <mutex>
+#include <atomic>
+#include <string.h>
+
+// One thread's running totals, never reset so the main thread can read them without stopping it
+struct ProfileCounterBlock_t
+{
+	std::atomic<uint64_t>	totals[PROFILER_MAX_COUNTERS];
+	bool					isShared;		// Written by several threads, so adds must be atomic
+
+	ProfileCounterBlock_t(bool isSharedBlock)
+		: isShared(isSharedBlock)
+	{
+		for (int counterIndex = 0; counterIndex < PROFILER_MAX_COUNTERS; ++counterIndex)
+		{
+			totals[counterIndex].store(0, std::memory_order_relaxed);
+		}
+	}
+};
+
+static const char* s_engineCounterNames[NUM_ENGINE_PROFILE_COUNTERS] =
+{
+	"Draw Calls",
+	"Compute Dispatches",
+	"State Changes",
+	"Texture Binds",
+	"Buffer Uploads",
+	"Bytes Uploaded",
+	"Jobs Queued",
+	"Jobs Run",
+	"Job Wait us",
+	"Worker Busy us",
+	"Worker Idle us",
+	"Packets Sent",
+	"Bytes Sent",
+	"Packets Received",
+	"Bytes Received",
+	"Assets Loaded"
+};
+
+// Names are written once each under the lock, before the count that includes them is published
+static const char*				s_counterNames[PROFILER_MAX_COUNTERS];
+static std::atomic<int>			s_counterCount(0);
+static std::mutex				s_registrationLock;
+
+// Blocks are never freed, since a thread that exits can still have counts the next frame hasn't taken
+static ProfileCounterBlock_t*	s_threadBlocks[PROFILER_MAX_COUNTER_THREADS];
+static std::atomic<int>			s_threadBlockCount(0);
+static ProfileCounterBlock_t	s_sharedBlock(true);
+static thread_local ProfileCounterBlock_t* s_threadBlock = nullptr;
+
+// Main thread only
+static uint64_t					s_lastTotals[PROFILER_MAX_COUNTERS];
+static uint64_t					s_lastFrameValues[PROFILER_MAX_COUNTERS];
+
+static void						RegisterEngineCountersIfNeeded();
+static ProfileCounterBlock_t*	CreateBlockForThisThread();
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the index of the counter with the name, adding it if there isn't one
+//
+int ProfileCounters::RegisterCounter(const char* name)
+{
+	RegisterEngineCountersIfNeeded();
+	std::lock_guard<std::mutex> lock(s_registrationLock);
+
+	int counterCount = s_counterCount.load(std::memory_order_relaxed);
+	for (int counterIndex = 0; counterIndex < counterCount; ++counterIndex)
+	{
+		if (strcmp(s_counterNames[counterIndex], name) == 0)
+		{
+			return counterIndex;
+		}
+	}
+
+	if (counterCount >= PROFILER_MAX_COUNTERS)
+	{
+		LogTaggedPrintf("PROFILER", "Warning: Counter \"%s\" can't be registered, already at %i counters", name, PROFILER_MAX_COUNTERS);
+		return -1;
+	}
+
+	s_counterNames[counterCount] = name;
+	s_counterCount.store(counterCount + 1, std::memory_order_release);
+
+	return counterCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds to the counter's total on the calling thread
+//
+void ProfileCounters::Add(int counterIndex, uint64_t amount /*= 1*/)
+{
+	if ((unsigned int) counterIndex >= PROFILER_MAX_COUNTERS)
+	{
+		return;
+	}
+
+	ProfileCounterBlock_t* block = s_threadBlock;
+	if (block == nullptr)
+	{
+		block = CreateBlockForThisThread();
+	}
+
+	std::atomic<uint64_t>& total = block->totals[counterIndex];
+
+	// A thread's own block is only written by it, so a plain load and store is enough and avoids the locked add
+	if (block->isShared)
+	{
+		total.fetch_add(amount, std::memory_order_relaxed);
+	}
+	else
+	{
+		total.store(total.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sums every thread's totals, and takes the last frame's off them to get this frame's counts
+//
+void ProfileCounters::EndFrame(uint64_t* out_frameValues)
+{
+	RegisterEngineCountersIfNeeded();
+
+	uint64_t totals[PROFILER_MAX_COUNTERS];
+	for (int counterIndex = 0; counterIndex < PROFILER_MAX_COUNTERS; ++counterIndex)
+	{
+		totals[counterIndex] = s_sharedBlock.totals[counterIndex].load(std::memory_order_relaxed);
+	}
+
+	int blockCount = s_threadBlockCount.load(std::memory_order_acquire);
+	for (int blockIndex = 0; blockIndex < blockCount; ++blockIndex)
+	{
+		const ProfileCounterBlock_t* block = s_threadBlocks[blockIndex];
+
+		for (int counterIndex = 0; counterIndex < PROFILER_MAX_COUNTERS; ++counterIndex)
+		{
+			totals[counterIndex] += block->totals[counterIndex].load(std::memory_order_relaxed);
+		}
+	}
+
+	for (int counterIndex = 0; counterIndex < PROFILER_MAX_COUNTERS; ++counterIndex)
+	{
+		s_lastFrameValues[counterIndex] = totals[counterIndex] - s_lastTotals[counterIndex];
+		s_lastTotals[counterIndex] = totals[counterIndex];
+	}
+
+	memcpy(out_frameValues, s_lastFrameValues, sizeof(s_lastFrameValues));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of counters registered, the engine's included
+//
+int ProfileCounters::GetCounterCount()
+{
+	RegisterEngineCountersIfNeeded();
+	return s_counterCount.load(std::memory_order_acquire);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the name of the counter, or nullptr if it isn't registered
+//
+const char* ProfileCounters::GetCounterName(int counterIndex)
+{
+	if (counterIndex < 0 || counterIndex >= GetCounterCount())
+	{
+		return nullptr;
+	}
+
+	return s_counterNames[counterIndex];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the counter's count during the last completed frame
+//
+uint64_t ProfileCounters::GetLastFrameValue(int counterIndex)
+{
+	if ((unsigned int) counterIndex >= PROFILER_MAX_COUNTERS)
+	{
+		return 0;
+	}
+
+	return s_lastFrameValues[counterIndex];
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Puts the engine's counters at the indices of eProfileCounter, before any a game registers
+//
+static void RegisterEngineCountersIfNeeded()
+{
+	if (s_counterCount.load(std::memory_order_acquire) > 0)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(s_registrationLock);
+
+	if (s_counterCount.load(std::memory_order_relaxed) == 0)
+	{
+		for (int counterIndex = 0; counterIndex < NUM_ENGINE_PROFILE_COUNTERS; ++counterIndex)
+		{
+			s_counterNames[counterIndex] = s_engineCounterNames[counterIndex];
+		}
+
+		s_counterCount.store(NUM_ENGINE_PROFILE_COUNTERS, std::memory_order_release);
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Gives the calling thread its own block to add to, or the shared one if they've run out
+//
+static ProfileCounterBlock_t* CreateBlockForThisThread()
+{
+	std::lock_guard<std::mutex> lock(s_registrationLock);
+
+	int blockCount = s_threadBlockCount.load(std::memory_order_relaxed);
+
+	if (blockCount >= PROFILER_MAX_COUNTER_THREADS)
+	{
+		s_threadBlock = &s_sharedBlock;
+	}
+	else
+	{
+		s_threadBlocks[blockCount] = new ProfileCounterBlock_t(false);
+		s_threadBlockCount.store(blockCount + 1, std::memory_order_release);
+
+		s_threadBlock = s_threadBlocks[blockCount];
+	}
+
+	return s_threadBlock;
+}
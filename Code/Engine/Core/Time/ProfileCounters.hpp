@@ -0,0 +1,73 @@
+/************************************************************************/
+/* File: ProfileCounters.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Named per frame counts (draw calls, uploads, jobs, packets)
+/*				accumulated per thread and rolled over by the Profiler
+/************************************************************************/
+#pragma once
+#include "Game/Framework/EngineBuildPreferences.hpp" // Only game code in engine
+#include <stdint.h>
+
+#define PROFILER_MAX_COUNTERS (32)
+#define PROFILER_MAX_COUNTER_THREADS (64)		// Threads past this share one block, with contended adds
+
+// Compile away without PROFILING_ENABLED, like PROFILE_SCOPE
+#ifdef PROFILING_ENABLED
+#define PROFILE_COUNTER_ADD(counterIndex, amount) ProfileCounters::Add(counterIndex, amount)
+#else
+#define PROFILE_COUNTER_ADD(counterIndex, amount)
+#endif
+
+#define PROFILE_COUNTER_INCREMENT(counterIndex) PROFILE_COUNTER_ADD(counterIndex, 1)
+
+// The engine's counters, always registered first; games add theirs with RegisterCounter()
+enum eProfileCounter
+{
+	PROFILE_COUNTER_DRAW_CALLS,
+	PROFILE_COUNTER_COMPUTE_DISPATCHES,
+	PROFILE_COUNTER_STATE_CHANGES,		// Sent to the driver, redundant ones skipped by the GLStateCache aren't counted
+	PROFILE_COUNTER_TEXTURE_BINDS,
+	PROFILE_COUNTER_BUFFER_UPLOADS,
+	PROFILE_COUNTER_BYTES_UPLOADED,
+	PROFILE_COUNTER_JOBS_QUEUED,
+	PROFILE_COUNTER_JOBS_RUN,
+	PROFILE_COUNTER_JOB_WAIT_MICROSECONDS,		// Summed over the jobs started, from being ready to starting
+	PROFILE_COUNTER_WORKER_BUSY_MICROSECONDS,	// Summed over all workers
+	PROFILE_COUNTER_WORKER_IDLE_MICROSECONDS,
+	PROFILE_COUNTER_PACKETS_SENT,
+	PROFILE_COUNTER_BYTES_SENT,
+	PROFILE_COUNTER_PACKETS_RECEIVED,
+	PROFILE_COUNTER_BYTES_RECEIVED,
+	PROFILE_COUNTER_ASSETS_LOADED,
+	NUM_ENGINE_PROFILE_COUNTERS
+};
+
+
+class ProfileCounters
+{
+public:
+	//-----Public Methods-----
+
+	// Returns the index of the counter with the name, adding it if there isn't one; -1 if there's no room
+	// The name must outlive the counters, usually a literal
+	static int			RegisterCounter(const char* name);
+
+	// Any thread - each adds to its own totals, so there's no contention between threads
+	static void			Add(int counterIndex, uint64_t amount = 1);
+
+	// Main thread only, called by the Profiler at each frame boundary
+	// Writes each counter's count since the last call, for PROFILER_MAX_COUNTERS counters
+	static void			EndFrame(uint64_t* out_frameValues);
+
+	static int			GetCounterCount();
+	static const char*	GetCounterName(int counterIndex);
+	static uint64_t		GetLastFrameValue(int counterIndex);
+
+
+private:
+	//-----Private Methods-----
+
+	ProfileCounters() = delete;
+
+};
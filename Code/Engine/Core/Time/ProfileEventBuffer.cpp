@@ -0,0 +1,147 @@
+/************************************************************************/
+/* File: ProfileEventBuffer.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the ProfileEventBuffer class
+/************************************************************************/
+#include "Engine/Core/Time/Time.hpp"
+#include "Engine/Core/Time/ProfileEventBuffer.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
+
+#define PROFILER_THREAD_EVENT_MASK (PROFILER_THREAD_EVENT_CAPACITY - 1)
+
+static_assert((PROFILER_THREAD_EVENT_CAPACITY & PROFILER_THREAD_EVENT_MASK) == 0, "PROFILER_THREAD_EVENT_CAPACITY must be a power of two");
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - allocates the whole ring up front
+//
+ProfileEventBuffer::ProfileEventBuffer(const std::string& threadName)
+	: m_threadName(threadName)
+	, m_writeIndex(0)
+{
+	m_events = new ProfileEvent_t[PROFILER_THREAD_EVENT_CAPACITY];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+ProfileEventBuffer::~ProfileEventBuffer()
+{
+	delete[] m_events;
+	m_events = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records the start of a scope
+//
+void ProfileEventBuffer::PushBeginEvent(uint16_t scopeId)
+{
+	PushBeginEvent(scopeId, GetPerformanceCounter());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records the start of a scope at the given time
+//
+void ProfileEventBuffer::PushBeginEvent(uint16_t scopeId, uint64_t hpc)
+{
+	m_openScopeCount++;
+	PushEvent(PROFILE_EVENT_BEGIN, scopeId, 0, hpc);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records the end of the innermost open scope
+//
+void ProfileEventBuffer::PushEndEvent()
+{
+	PushEndEvent(GetPerformanceCounter());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records the end of the innermost open scope at the given time
+//
+void ProfileEventBuffer::PushEndEvent(uint64_t hpc)
+{
+	m_openScopeCount--;
+	PushEvent(PROFILE_EVENT_END, PROFILER_INVALID_SCOPE_ID, 0, hpc);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records an event that isn't part of the thread's scope stack
+//
+void ProfileEventBuffer::PushMarkerEvent(eProfileEventType type, uint16_t scopeId, uint32_t value)
+{
+	PushEvent(type, scopeId, value, GetPerformanceCounter());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of scopes begun but not yet ended on this thread
+//
+int ProfileEventBuffer::GetOpenScopeCount() const
+{
+	return m_openScopeCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the index the next event will be written to
+//
+uint64_t ProfileEventBuffer::GetWriteIndex() const
+{
+	return m_writeIndex.load(std::memory_order_acquire);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the event at the given index, which is only valid if it's still available
+//
+const ProfileEvent_t& ProfileEventBuffer::GetEvent(uint64_t eventIndex) const
+{
+	return m_events[eventIndex & PROFILER_THREAD_EVENT_MASK];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the event has been written and not since overwritten
+// Checking after reading a range tells whether the writer lapped it during the read
+//
+bool ProfileEventBuffer::IsEventAvailable(uint64_t eventIndex) const
+{
+	uint64_t writeIndex = GetWriteIndex();
+
+	// Strictly less, as the slot for writeIndex may be mid-write
+	return (eventIndex < writeIndex) && (writeIndex - eventIndex < PROFILER_THREAD_EVENT_CAPACITY);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the name of the thread that writes to this buffer
+//
+const std::string& ProfileEventBuffer::GetThreadName() const
+{
+	return m_threadName;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the event and then publishes it, so a reader that sees the index sees the event
+//
+void ProfileEventBuffer::PushEvent(eProfileEventType type, uint16_t scopeId, uint32_t value, uint64_t hpc)
+{
+	uint64_t writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+
+	ProfileEvent_t& event = m_events[writeIndex & PROFILER_THREAD_EVENT_MASK];
+	event.hpc = hpc;
+	event.value = value;
+	event.scopeId = scopeId;
+	event.type = type;
+
+	m_writeIndex.store(writeIndex + 1, std::memory_order_release);
+}
@@ -0,0 +1,78 @@
+/************************************************************************/
+/* File: ProfileEventBuffer.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Fixed-capacity ring of profile scope events, written by
+/*				one thread and read back by the profiler on the main one
+/************************************************************************/
+#pragma once
+#include <atomic>
+#include <string>
+#include <stdint.h>
+
+#define PROFILER_THREAD_EVENT_CAPACITY (1 << 17) // Per thread, so 2MB each
+
+enum eProfileEventType : uint16_t
+{
+	PROFILE_EVENT_BEGIN,
+	PROFILE_EVENT_END,			// Ends the innermost open scope on the thread
+	PROFILE_EVENT_MARKER,		// A point in time, e.g. a packet sent
+	PROFILE_EVENT_ASYNC_BEGIN,	// Spans matched by name and value instead of nesting, so they can end on another thread
+	PROFILE_EVENT_ASYNC_END
+};
+
+// Names are kept in the ProfileScopeRegistry, so an event is just its scope's ID and the time
+struct ProfileEvent_t
+{
+	uint64_t			hpc;
+	uint32_t			value;		// Marker value or async ID, unused by scopes
+	uint16_t			scopeId;	// PROFILER_INVALID_SCOPE_ID for scope ends
+	eProfileEventType	type;
+};
+
+static_assert(sizeof(ProfileEvent_t) == 16, "ProfileEvent_t should stay 16 bytes");
+
+
+class ProfileEventBuffer
+{
+public:
+	//-----Public Methods-----
+
+	ProfileEventBuffer(const std::string& threadName);
+	~ProfileEventBuffer();
+
+	ProfileEventBuffer(const ProfileEventBuffer& copy) = delete;
+	ProfileEventBuffer& operator=(const ProfileEventBuffer& copy) = delete;
+
+	// Owning thread only - never allocates, the oldest events are overwritten when full
+	// Timestamps can be given for times measured elsewhere (e.g. the GPU), but must not go backwards
+	void					PushBeginEvent(uint16_t scopeId);
+	void					PushBeginEvent(uint16_t scopeId, uint64_t hpc);
+	void					PushEndEvent();
+	void					PushEndEvent(uint64_t hpc);
+	void					PushMarkerEvent(eProfileEventType type, uint16_t scopeId, uint32_t value);	// Markers and async spans
+	int						GetOpenScopeCount() const;
+
+	// Any thread - indices free run, so an event's index is stable for as long as it's kept
+	uint64_t				GetWriteIndex() const;
+	const ProfileEvent_t&	GetEvent(uint64_t eventIndex) const;
+	bool					IsEventAvailable(uint64_t eventIndex) const;	// False once it's been overwritten
+
+	const std::string&		GetThreadName() const;
+
+
+private:
+	//-----Private Methods-----
+
+	void					PushEvent(eProfileEventType type, uint16_t scopeId, uint32_t value, uint64_t hpc);
+
+
+private:
+	//-----Private Data-----
+
+	std::string				m_threadName;
+	ProfileEvent_t*			m_events = nullptr;
+	std::atomic<uint64_t>	m_writeIndex;
+	int						m_openScopeCount = 0;
+
+};
@@ -0,0 +1,264 @@
+/************************************************************************/
+/* File: ProfileHistogram.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the ProfileHistogram class
+/************************************************************************/
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time/ProfileHistogram.hpp"
+#include "Engine/Core/Utility/StringUtils.hpp"
+#include <math.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+ProfileHistogram::ProfileHistogram(const std::string& name, int windowSize, float hitchThresholdMilliseconds)
+	: m_name(name)
+	, m_windowSize(windowSize)
+{
+	ASSERT_OR_DIE(windowSize > 0, Stringf("Error: ProfileHistogram \"%s\" created with window size %i", name.c_str(), windowSize));
+
+	m_samples = new uint32_t[windowSize];
+	SetHitchThreshold(hitchThresholdMilliseconds);
+	Clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+ProfileHistogram::~ProfileHistogram()
+{
+	delete[] m_samples;
+	m_samples = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the duration to the window, removing the oldest one if it's full
+//
+void ProfileHistogram::AddSample(float milliseconds)
+{
+	// Clamped to what fits in the 32 bits, about 71 minutes
+	double microseconds = (double) milliseconds * 1000.0;
+	uint32_t sample = (microseconds <= 0.0 ? 0 : (microseconds >= 4294967295.0 ? 0xFFFFFFFF : (uint32_t) microseconds));
+
+	if (m_sampleCount == m_windowSize)
+	{
+		uint32_t oldestSample = m_samples[m_nextSampleIndex];
+
+		m_bucketCounts[GetBucketIndex(oldestSample)]--;
+		m_windowSumMicroseconds -= oldestSample;
+
+		if (oldestSample > m_hitchThresholdMicroseconds)
+		{
+			m_windowHitchCount--;
+		}
+	}
+	else
+	{
+		m_sampleCount++;
+	}
+
+	m_samples[m_nextSampleIndex] = sample;
+	m_nextSampleIndex = (m_nextSampleIndex + 1) % m_windowSize;
+
+	m_bucketCounts[GetBucketIndex(sample)]++;
+	m_windowSumMicroseconds += sample;
+	m_totalSampleCount++;
+
+	if (sample > m_hitchThresholdMicroseconds)
+	{
+		m_windowHitchCount++;
+		m_totalHitchCount++;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes all samples, from the window and the totals
+//
+void ProfileHistogram::Clear()
+{
+	memset(m_bucketCounts, 0, sizeof(m_bucketCounts));
+
+	m_sampleCount = 0;
+	m_nextSampleIndex = 0;
+	m_windowSumMicroseconds = 0;
+	m_windowHitchCount = 0;
+	m_totalSampleCount = 0;
+	m_totalHitchCount = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the duration samples must be over to count as hitches, recounting the window
+// The total since the last clear can't be recounted, so it only uses the new threshold from here on
+//
+void ProfileHistogram::SetHitchThreshold(float milliseconds)
+{
+	m_hitchThresholdMicroseconds = (milliseconds <= 0.f ? 0 : (uint32_t) (milliseconds * 1000.f));
+
+	m_windowHitchCount = 0;
+	for (int sampleIndex = 0; sampleIndex < m_sampleCount; ++sampleIndex)
+	{
+		if (m_samples[sampleIndex] > m_hitchThresholdMicroseconds)
+		{
+			m_windowHitchCount++;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the duration the given percent of the window's samples are at or under, as the highest
+// value of the bucket it falls in
+//
+float ProfileHistogram::GetPercentile(float percentile) const
+{
+	if (m_sampleCount == 0)
+	{
+		return 0.f;
+	}
+
+	// The sample at this rank (1 being the fastest) is the percentile
+	int targetRank = (int) ceilf((percentile / 100.f) * (float) m_sampleCount);
+	targetRank = (targetRank < 1 ? 1 : (targetRank > m_sampleCount ? m_sampleCount : targetRank));
+
+	int rank = 0;
+	for (int bucketIndex = 0; bucketIndex < PROFILE_HISTOGRAM_BUCKET_COUNT; ++bucketIndex)
+	{
+		rank += m_bucketCounts[bucketIndex];
+
+		if (rank >= targetRank)
+		{
+			// Don't report past the largest real sample
+			float bucketMilliseconds = (float) GetBucketHighestValue(bucketIndex) * 0.001f;
+			float maxMilliseconds = GetMax();
+
+			return (bucketMilliseconds < maxMilliseconds ? bucketMilliseconds : maxMilliseconds);
+		}
+	}
+
+	return GetMax();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the largest sample in the window exactly, in milliseconds
+//
+float ProfileHistogram::GetMax() const
+{
+	uint32_t maxSample = 0;
+
+	for (int sampleIndex = 0; sampleIndex < m_sampleCount; ++sampleIndex)
+	{
+		if (m_samples[sampleIndex] > maxSample)
+		{
+			maxSample = m_samples[sampleIndex];
+		}
+	}
+
+	return (float) maxSample * 0.001f;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the mean of the samples in the window, in milliseconds
+//
+float ProfileHistogram::GetAverage() const
+{
+	if (m_sampleCount == 0)
+	{
+		return 0.f;
+	}
+
+	return (float) ((double) m_windowSumMicroseconds / (double) m_sampleCount) * 0.001f;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of samples in the window
+//
+int ProfileHistogram::GetSampleCount() const
+{
+	return m_sampleCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of samples in the window over the hitch threshold
+//
+int ProfileHistogram::GetHitchCount() const
+{
+	return m_windowHitchCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of samples added since the last clear
+//
+uint64_t ProfileHistogram::GetTotalSampleCount() const
+{
+	return m_totalSampleCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of samples over the hitch threshold since the last clear
+//
+uint64_t ProfileHistogram::GetTotalHitchCount() const
+{
+	return m_totalHitchCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the name of the frame or scope this histogram is for
+//
+const std::string& ProfileHistogram::GetName() const
+{
+	return m_name;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the percentiles and hitch counts as one line, for the console and the log
+//
+std::string ProfileHistogram::GetSummaryText() const
+{
+	return Stringf("%-*s p50: %*.2f ms  p95: %*.2f ms  p99: %*.2f ms  max: %*.2f ms  hitches: %i/%i (%llu/%llu total)",
+		24, m_name.c_str(), 7, GetPercentile(50.f), 7, GetPercentile(95.f), 7, GetPercentile(99.f), 7, GetMax(),
+		m_windowHitchCount, m_sampleCount, m_totalHitchCount, m_totalSampleCount);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the bucket the value falls in - values under 64 get one each, then each power of
+// two above that is split into PROFILE_HISTOGRAM_SUB_BUCKET_COUNT even buckets
+//
+int ProfileHistogram::GetBucketIndex(uint32_t microseconds)
+{
+	int shift = 0;
+	while ((microseconds >> shift) >= (2 * PROFILE_HISTOGRAM_SUB_BUCKET_COUNT))
+	{
+		shift++;
+	}
+
+	return shift * PROFILE_HISTOGRAM_SUB_BUCKET_COUNT + (int) (microseconds >> shift);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the largest value that falls in the given bucket
+//
+uint32_t ProfileHistogram::GetBucketHighestValue(int bucketIndex)
+{
+	int shift = (bucketIndex / PROFILE_HISTOGRAM_SUB_BUCKET_COUNT) - 1;
+	shift = (shift < 0 ? 0 : shift);
+
+	uint64_t subBucket = (uint64_t) (bucketIndex - shift * PROFILE_HISTOGRAM_SUB_BUCKET_COUNT);
+	return (uint32_t) (((subBucket + 1) << shift) - 1);
+}
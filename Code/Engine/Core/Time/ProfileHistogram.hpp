@@ -0,0 +1,76 @@
+/************************************************************************/
+/* File: ProfileHistogram.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Rolling histogram of durations over a window of samples,
+/*				for percentiles and hitch counts over a long history
+/************************************************************************/
+#pragma once
+#include <string>
+#include <stdint.h>
+
+// Buckets are linear within each power of two of microseconds, 32 to a power, so a percentile
+// is within ~3% of the real sample (exact under 64us)
+#define PROFILE_HISTOGRAM_SUB_BUCKET_BITS (5)
+#define PROFILE_HISTOGRAM_SUB_BUCKET_COUNT (1 << PROFILE_HISTOGRAM_SUB_BUCKET_BITS)
+#define PROFILE_HISTOGRAM_BUCKET_COUNT ((33 - PROFILE_HISTOGRAM_SUB_BUCKET_BITS) * PROFILE_HISTOGRAM_SUB_BUCKET_COUNT)	// Enough for any 32 bit value
+
+
+class ProfileHistogram
+{
+public:
+	//-----Public Methods-----
+
+	ProfileHistogram(const std::string& name, int windowSize, float hitchThresholdMilliseconds);
+	~ProfileHistogram();
+
+	ProfileHistogram(const ProfileHistogram& copy) = delete;
+	ProfileHistogram& operator=(const ProfileHistogram& copy) = delete;
+
+	// Constant time, the oldest sample drops out once the window is full
+	void				AddSample(float milliseconds);
+	void				Clear();
+	void				SetHitchThreshold(float milliseconds);
+
+	// Over the samples in the window
+	float				GetPercentile(float percentile) const;	// In [0, 100], in milliseconds
+	float				GetMax() const;
+	float				GetAverage() const;
+	int					GetSampleCount() const;
+	int					GetHitchCount() const;					// Samples over the hitch threshold
+
+	// Since the last clear, beyond the window
+	uint64_t			GetTotalSampleCount() const;
+	uint64_t			GetTotalHitchCount() const;
+
+	const std::string&	GetName() const;
+	std::string			GetSummaryText() const;					// p50/p95/p99/max and hitches, on one line
+
+
+private:
+	//-----Private Methods-----
+
+	static int			GetBucketIndex(uint32_t microseconds);
+	static uint32_t		GetBucketHighestValue(int bucketIndex);
+
+
+private:
+	//-----Private Data-----
+
+	std::string			m_name;
+	uint32_t			m_hitchThresholdMicroseconds;
+
+	// Window, a ring of the exact samples so the oldest can be taken back out of its bucket
+	uint32_t*			m_samples = nullptr;
+	int					m_windowSize = 0;
+	int					m_sampleCount = 0;
+	int					m_nextSampleIndex = 0;
+	uint64_t			m_windowSumMicroseconds = 0;
+	int					m_windowHitchCount = 0;
+
+	uint32_t			m_bucketCounts[PROFILE_HISTOGRAM_BUCKET_COUNT];
+
+	uint64_t			m_totalSampleCount = 0;
+	uint64_t			m_totalHitchCount = 0;
+
+};
@@ -3,7 +3,6 @@
 
 ProfileLogScoped::ProfileLogScoped(const char* name)
 {
-	m_name = name;
 	Profiler::PushMeasurement(name);
 }
 
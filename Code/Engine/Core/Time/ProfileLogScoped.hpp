@@ -12,10 +12,4 @@ public:
 	ProfileLogScoped(const char* name);
 	~ProfileLogScoped();
 
-
-private:
-	//-----Private Data-----
-
-	std::string m_name;
-
 };
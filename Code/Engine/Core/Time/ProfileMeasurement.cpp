@@ -20,6 +20,19 @@ ProfileMeasurement::ProfileMeasurement(const char* name)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Constructor - for a measurement that already started
+//
+ProfileMeasurement::ProfileMeasurement(const char* name, uint64_t startHPC)
+	: m_name(name)
+	, m_startHPC(startHPC)
+	, m_endHPC(startHPC)
+	, m_frameNumber(-1)
+	, m_parent(nullptr)
+{
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Destructor
 //
@@ -18,6 +18,7 @@ public:
 
 	// Initializers
 	ProfileMeasurement(const char* name);
+	ProfileMeasurement(const char* name, uint64_t startHPC);	// For rebuilding from recorded events
 	~ProfileMeasurement();
 
 	// Mutators
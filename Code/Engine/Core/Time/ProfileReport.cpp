@@ -20,6 +20,7 @@ ProfileReport::ProfileReport(int frameNumber)
 	, m_frameNumber(frameNumber)
 	, m_type(REPORT_TYPE_TREE)
 	, m_sortOrder(REPORT_SORT_TOTAL_TIME)
+	, m_allocationCount(-1)
 {
 }
 
@@ -36,7 +37,7 @@ ProfileReport::~ProfileReport()
 //-----------------------------------------------------------------------------------------------
 // Fills this report in a tree format, so it can be printed showing hierarchy
 //
-void ProfileReport::InitializeAsTreeReport(ProfileMeasurement* stack, eSortOrder sortOrder)
+void ProfileReport::InitializeAsTreeReport(ProfileMeasurement* stack, const std::vector<ProfileMeasurement*>& threadStacks, eSortOrder sortOrder)
 {
 	ASSERT_OR_DIE(m_rootEntry == nullptr, "Error: ProfileReport::InitializeAsTreeReport called on an already initialized report");
 
@@ -46,6 +47,12 @@ void ProfileReport::InitializeAsTreeReport(ProfileMeasurement* stack, eSortOrder
 	m_rootEntry = new ProfileReportEntry(stack->m_name);
 	m_rootEntry->PopulateTree(stack);
 
+	for (int threadIndex = 0; threadIndex < (int) threadStacks.size(); ++threadIndex)
+	{
+		ProfileReportEntry* threadEntry = m_rootEntry->GetOrCreateReportEntryForChild(threadStacks[threadIndex]->m_name);
+		threadEntry->PopulateTree(threadStacks[threadIndex]);
+	}
+
 	Finalize();
 }
 
@@ -53,7 +60,7 @@ void ProfileReport::InitializeAsTreeReport(ProfileMeasurement* stack, eSortOrder
 //-----------------------------------------------------------------------------------------------
 // Fills this report in a flat format, so it can be printed flat
 //
-void ProfileReport::InitializeAsFlatReport(ProfileMeasurement* stack, eSortOrder sortOrder)
+void ProfileReport::InitializeAsFlatReport(ProfileMeasurement* stack, const std::vector<ProfileMeasurement*>& threadStacks, eSortOrder sortOrder)
 {
 	ASSERT_OR_DIE(m_rootEntry == nullptr, "Error: ProfileReport::InitializeAsFlatReport called on an already initialized report");
 
@@ -69,6 +76,11 @@ void ProfileReport::InitializeAsFlatReport(ProfileMeasurement* stack, eSortOrder
 		m_rootEntry->PopulateFlat(stack->m_children[childIndex]);
 	}
 
+	for (int threadIndex = 0; threadIndex < (int) threadStacks.size(); ++threadIndex)
+	{
+		m_rootEntry->PopulateFlat(threadStacks[threadIndex]);
+	}
+
 	Finalize();
 }
 
@@ -82,7 +94,34 @@ void ProfileReport::Finalize()
 	double totalSeconds = TimeSystem::PerformanceCountToSeconds(m_rootEntry->m_totalTime);
 	m_rootEntry->RecursivelyCalculatePercentTimes(totalSeconds);
 
-	// Sort children in descending order based on our sort flag
+	SortEntries();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the order the entries are sorted in, sorting them again only if it changed
+//
+void ProfileReport::SetSortOrder(eSortOrder sortOrder)
+{
+	if (m_sortOrder == sortOrder)
+	{
+		return;
+	}
+
+	m_sortOrder = sortOrder;
+	SortEntries();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sorts all children in descending order based on the sort order
+//
+void ProfileReport::SortEntries()
+{
+	if (m_rootEntry == nullptr)
+	{
+		return;
+	}
 
 	if (m_sortOrder == REPORT_SORT_TOTAL_TIME)
 	{
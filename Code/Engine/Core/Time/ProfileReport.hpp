@@ -32,11 +32,21 @@ public:
 	ProfileReport(int frameNumber);
 	~ProfileReport();
 
-	void InitializeAsFlatReport(ProfileMeasurement* stack, eSortOrder sortOrder);
-	void InitializeAsTreeReport(ProfileMeasurement* stack, eSortOrder sortOrder);
+	// Thread stacks are the other threads' scopes for the frame, reported under the root
+	void InitializeAsFlatReport(ProfileMeasurement* stack, const std::vector<ProfileMeasurement*>& threadStacks, eSortOrder sortOrder);
+	void InitializeAsTreeReport(ProfileMeasurement* stack, const std::vector<ProfileMeasurement*>& threadStacks, eSortOrder sortOrder);
 
 	void Finalize();
 
+	// Re-sorts the entries if they aren't already in the given order, so a new order only costs the reports shown
+	void SetSortOrder(eSortOrder sortOrder);
+
+
+private:
+	//-----Private Methods-----
+
+	void SortEntries();
+
 
 public:
 	//-----Public Data-----
@@ -45,4 +55,5 @@ public:
 	eReportType				m_type;
 	ProfileReportEntry*		m_rootEntry;
 	eSortOrder				m_sortOrder;
+	int						m_allocationCount;	// Made during the frame, -1 if they weren't counted
 };
@@ -0,0 +1,159 @@
+/************************************************************************/
+/* File: ProfileScopeRegistry.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the ProfileScopeRegistry class
+/************************************************************************/
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/Time/Profiler.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+
+#define PROFILER_SCOPE_NAME_CACHE_MASK (PROFILER_SCOPE_NAME_CACHE_SIZE - 1)
+
+static_assert(PROFILER_MAX_SCOPE_COUNT <= 65536, "PROFILER_MAX_SCOPE_COUNT must fit in the 16 bit scope IDs");
+static_assert((PROFILER_SCOPE_NAME_CACHE_SIZE & PROFILER_SCOPE_NAME_CACHE_MASK) == 0, "PROFILER_SCOPE_NAME_CACHE_SIZE must be a power of two");
+
+// Written once each under the lock, then only read - a descriptor is set before the count
+// that includes it is published
+static ProfileScopeDescriptor_t	s_descriptors[PROFILER_MAX_SCOPE_COUNT] = { { "<Overflow>", "", 0, "Default" } };
+static std::atomic<int>			s_scopeCount(1);
+static std::mutex				s_registrationLock;
+
+// Runtime names by pointer, checked before taking the lock
+struct ProfileScopeNameCacheEntry_t
+{
+	const char*	name;
+	uint16_t	scopeId;
+};
+
+static thread_local ProfileScopeNameCacheEntry_t s_nameCache[PROFILER_SCOPE_NAME_CACHE_SIZE];
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a descriptor for the scope and returns its ID
+//
+uint16_t ProfileScopeRegistry::RegisterScope(const char* name, const char* file, int line, const char* category)
+{
+	std::lock_guard<std::mutex> lock(s_registrationLock);
+	return RegisterScopeLocked(name, file, line, category);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the ID for a name given at runtime, registering it the first time the pointer is seen
+// The string must not change for as long as the pointer is used, as only the pointer is checked
+//
+uint16_t ProfileScopeRegistry::GetScopeIdForName(const char* name)
+{
+	ProfileScopeNameCacheEntry_t& cacheEntry = s_nameCache[((uintptr_t) name >> 3) & PROFILER_SCOPE_NAME_CACHE_MASK];
+
+	if (cacheEntry.name == name && name != nullptr)
+	{
+		return cacheEntry.scopeId;
+	}
+
+	std::lock_guard<std::mutex> lock(s_registrationLock);
+
+	// Shared by every thread, so a name is only registered once
+	static std::unordered_map<const char*, uint16_t> s_runtimeNameIds;
+
+	uint16_t scopeId;
+	std::unordered_map<const char*, uint16_t>::const_iterator itr = s_runtimeNameIds.find(name);
+
+	if (itr != s_runtimeNameIds.end())
+	{
+		scopeId = itr->second;
+	}
+	else
+	{
+		scopeId = RegisterScopeLocked(name, "", 0, "Runtime");
+
+		if (scopeId != PROFILER_INVALID_SCOPE_ID)
+		{
+			s_runtimeNameIds[name] = scopeId;
+		}
+	}
+
+	cacheEntry.name = name;
+	cacheEntry.scopeId = scopeId;
+
+	return scopeId;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the descriptor for the ID, or the overflow one if it isn't registered
+//
+const ProfileScopeDescriptor_t& ProfileScopeRegistry::GetDescriptor(uint16_t scopeId)
+{
+	if ((int) scopeId >= s_scopeCount.load(std::memory_order_acquire))
+	{
+		return s_descriptors[PROFILER_INVALID_SCOPE_ID];
+	}
+
+	return s_descriptors[scopeId];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the name of the scope with the ID
+//
+const char* ProfileScopeRegistry::GetName(uint16_t scopeId)
+{
+	return GetDescriptor(scopeId).name;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of descriptors, including the overflow one
+//
+int ProfileScopeRegistry::GetScopeCount()
+{
+	return s_scopeCount.load(std::memory_order_acquire);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the descriptor, with the registration lock already held
+//
+uint16_t ProfileScopeRegistry::RegisterScopeLocked(const char* name, const char* file, int line, const char* category)
+{
+	int scopeCount = s_scopeCount.load(std::memory_order_relaxed);
+
+	if (scopeCount >= PROFILER_MAX_SCOPE_COUNT)
+	{
+		LogTaggedPrintf("PROFILER", "Warning: Scope \"%s\" can't be registered, already at %i scopes", name, PROFILER_MAX_SCOPE_COUNT);
+		return PROFILER_INVALID_SCOPE_ID;
+	}
+
+	ProfileScopeDescriptor_t& descriptor = s_descriptors[scopeCount];
+	descriptor.name		= (name != nullptr ? name : "<Unnamed>");
+	descriptor.file		= (file != nullptr ? file : "");
+	descriptor.line		= line;
+	descriptor.category = (category != nullptr ? category : "Default");
+
+	s_scopeCount.store(scopeCount + 1, std::memory_order_release);
+
+	return (uint16_t) scopeCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - begins the registered scope on the calling thread
+//
+ProfileScopeMeasurement::ProfileScopeMeasurement(uint16_t scopeId)
+{
+	Profiler::PushMeasurement(scopeId);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor - ends it
+//
+ProfileScopeMeasurement::~ProfileScopeMeasurement()
+{
+	Profiler::PopMeasurement();
+}
@@ -0,0 +1,77 @@
+/************************************************************************/
+/* File: ProfileScopeRegistry.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Static descriptors for profiled scopes, so events only
+/*				record a 16 bit ID, and the PROFILE_SCOPE macros
+/************************************************************************/
+#pragma once
+#include "Game/Framework/EngineBuildPreferences.hpp" // Only game code in engine
+#include <stdint.h>
+
+#define PROFILER_MAX_SCOPE_COUNT (8192)					// Past it, scopes are recorded under the overflow descriptor
+#define PROFILER_INVALID_SCOPE_ID (0)					// Scope ends, and scopes registered past the limit
+#define PROFILER_SCOPE_NAME_CACHE_SIZE (256)			// Per thread, power of two
+
+#define PROFILE_SCOPE_ID_NAME_INNER(line) __profileScopeId_##line
+#define PROFILE_SCOPE_ID_NAME(line) PROFILE_SCOPE_ID_NAME_INNER(line)
+#define PROFILE_SCOPE_TIMER_NAME_INNER(line) __profileScopeTimer_##line
+#define PROFILE_SCOPE_TIMER_NAME(line) PROFILE_SCOPE_TIMER_NAME_INNER(line)
+
+// The descriptor is registered the first time the line runs, after that only the ID and
+// timestamps are recorded; without PROFILING_ENABLED these compile away entirely
+#ifdef PROFILING_ENABLED
+#define PROFILE_SCOPE_CATEGORY(name, category) \
+	static const uint16_t PROFILE_SCOPE_ID_NAME(__LINE__) = ProfileScopeRegistry::RegisterScope(name, __FILE__, __LINE__, category); \
+	ProfileScopeMeasurement PROFILE_SCOPE_TIMER_NAME(__LINE__)(PROFILE_SCOPE_ID_NAME(__LINE__))
+#else
+#define PROFILE_SCOPE_CATEGORY(name, category)
+#endif
+
+#define PROFILE_SCOPE(name) PROFILE_SCOPE_CATEGORY(name, "Default")
+#define PROFILE_SCOPE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+
+// Strings must outlive the profiler, usually literals
+struct ProfileScopeDescriptor_t
+{
+	const char*		name = nullptr;
+	const char*		file = nullptr;
+	int				line = 0;
+	const char*		category = nullptr;
+};
+
+
+class ProfileScopeRegistry
+{
+public:
+	//-----Public Methods-----
+
+	// Any thread - descriptors are never removed, so an ID is valid for the whole run
+	static uint16_t							RegisterScope(const char* name, const char* file, int line, const char* category);
+	static uint16_t							GetScopeIdForName(const char* name); // For names only known at runtime, registered once per pointer
+
+	static const ProfileScopeDescriptor_t&	GetDescriptor(uint16_t scopeId);
+	static const char*						GetName(uint16_t scopeId);
+	static int								GetScopeCount();
+
+
+private:
+	//-----Private Methods-----
+
+	ProfileScopeRegistry() = delete;
+
+	static uint16_t							RegisterScopeLocked(const char* name, const char* file, int line, const char* category);
+
+};
+
+
+// Used by PROFILE_SCOPE, defined out of line so this header doesn't have to include Profiler.hpp
+class ProfileScopeMeasurement
+{
+public:
+	//-----Public Methods-----
+
+	ProfileScopeMeasurement(uint16_t scopeId);
+	~ProfileScopeMeasurement();
+
+};
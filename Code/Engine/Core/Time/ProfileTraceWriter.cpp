@@ -0,0 +1,403 @@
+/************************************************************************/
+/* File: ProfileTraceWriter.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the ProfileTraceWriter class
+/************************************************************************/
+#include "Engine/Core/File.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/Time/Time.hpp"
+#include "Engine/Core/Time/ProfileCounters.hpp"
+#include "Engine/Core/Time/ProfileEventBuffer.hpp"
+#include "Engine/Core/Time/ProfileTraceWriter.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
+#include <stdio.h>
+
+// Every event is in the one process, with the thread's buffer index as its thread ID
+#define PROFILE_TRACE_PROCESS_ID (1)
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Appends the string as a JSON string body, escaping quotes, backslashes and control characters
+//
+void AppendEscapedTraceString(std::string& text, const char* string)
+{
+	for (const char* character = string; *character != '\0'; ++character)
+	{
+		char currChar = *character;
+
+		if (currChar == '"' || currChar == '\\')
+		{
+			text += '\\';
+			text += currChar;
+		}
+		else if ((unsigned char) currChar < 0x20)
+		{
+			text += ' ';
+		}
+		else
+		{
+			text += currChar;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+ProfileTraceWriter::ProfileTraceWriter()
+{
+	for (int threadIndex = 0; threadIndex < PROFILER_MAX_THREAD_COUNT; ++threadIndex)
+	{
+		m_openScopeCounts[threadIndex] = 0;
+		m_isThreadNamed[threadIndex] = false;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor - finishes the file if it's still open
+//
+ProfileTraceWriter::~ProfileTraceWriter()
+{
+	Close();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Creates the trace file and writes the start of the event list
+//
+bool ProfileTraceWriter::Open(const std::string& filePath)
+{
+	Close();
+
+	m_file = new File();
+	if (!m_file->Open(filePath.c_str(), "w"))
+	{
+		LogTaggedPrintf("PROFILER", "Error: ProfileTraceWriter::Open() couldn't open file \"%s\"", filePath.c_str());
+
+		delete m_file;
+		m_file = nullptr;
+		return false;
+	}
+
+	for (int threadIndex = 0; threadIndex < PROFILER_MAX_THREAD_COUNT; ++threadIndex)
+	{
+		m_openScopeCounts[threadIndex] = 0;
+		m_isThreadNamed[threadIndex] = false;
+	}
+
+	m_text.clear();
+	m_text.reserve(PROFILE_TRACE_FLUSH_SIZE * 2);
+	m_text += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+	m_startHPC = 0;
+	m_lastFrameEndHPC = 0;
+	m_frameCount = 0;
+	m_hasWrittenEvent = false;
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Ends the scopes left open at the end of the last frame, and closes the file
+//
+void ProfileTraceWriter::Close()
+{
+	if (m_file == nullptr)
+	{
+		return;
+	}
+
+	char eventText[128];
+	for (int threadIndex = 0; threadIndex < PROFILER_MAX_THREAD_COUNT; ++threadIndex)
+	{
+		for (int scopeIndex = 0; scopeIndex < m_openScopeCounts[threadIndex]; ++scopeIndex)
+		{
+			AppendEventSeparator();
+			snprintf(eventText, sizeof(eventText), "{\"ph\":\"E\",\"ts\":%.3f,\"pid\":%i,\"tid\":%i}", GetTimestamp(m_lastFrameEndHPC), PROFILE_TRACE_PROCESS_ID, threadIndex);
+			m_text += eventText;
+		}
+
+		m_openScopeCounts[threadIndex] = 0;
+	}
+
+	m_text += "\n]}\n";
+	FlushText();
+
+	LogTaggedPrintf("PROFILER", "Wrote %i frames to trace \"%s\"", m_frameCount, m_file->GetFilePathOpened().c_str());
+
+	m_file->Close();
+	delete m_file;
+	m_file = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if frames can be written
+//
+bool ProfileTraceWriter::IsOpen() const
+{
+	return (m_file != nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Appends every thread's events for the frame, with timestamps relative to the first frame
+//
+void ProfileTraceWriter::WriteFrame(const ProfileFrame_t& frame, ProfileEventBuffer* const* threadBuffers)
+{
+	if (m_file == nullptr)
+	{
+		return;
+	}
+
+	if (m_frameCount == 0)
+	{
+		m_startHPC = frame.startHPC;
+	}
+
+	for (int threadIndex = 0; threadIndex < frame.threadCount; ++threadIndex)
+	{
+		ProfileEventBuffer* buffer = threadBuffers[threadIndex];
+
+		if (!m_isThreadNamed[threadIndex])
+		{
+			AppendThreadName(threadIndex, buffer->GetThreadName());
+			m_isThreadNamed[threadIndex] = true;
+		}
+
+		if (!AppendThreadEvents(frame, threadIndex, buffer))
+		{
+			LogTaggedPrintf("PROFILER", "Warning: Thread \"%s\" overwrote its events for frame %i before they were written to the trace", buffer->GetThreadName().c_str(), frame.frameNumber);
+		}
+	}
+
+	AppendFrameCounters(frame);
+
+	m_lastFrameEndHPC = frame.endHPC;
+	m_frameCount++;
+
+	if (m_text.size() >= PROFILE_TRACE_FLUSH_SIZE)
+	{
+		FlushText();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Appends the message as an instant event across every thread's track, named by its tag
+//
+void ProfileTraceWriter::WriteLogMessage(const LogMessage_t& message)
+{
+	if (m_file == nullptr || m_frameCount == 0)
+	{
+		return;
+	}
+
+	char eventText[128];
+
+	AppendEventSeparator();
+	m_text += "{\"name\":\"";
+	AppendEscapedTraceString(m_text, (message.tag.size() > 0 ? message.tag.c_str() : "Log"));
+
+	snprintf(eventText, sizeof(eventText), "\",\"cat\":\"log\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":%i,\"tid\":0,\"args\":{\"message\":\"", GetTimestamp(message.hpc), PROFILE_TRACE_PROCESS_ID);
+	m_text += eventText;
+
+	AppendEscapedTraceString(m_text, message.message.c_str());
+	m_text += "\"}}";
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of frames written since the file was opened
+//
+int ProfileTraceWriter::GetFrameCount() const
+{
+	return m_frameCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the path of the open file, or empty if there isn't one
+//
+std::string ProfileTraceWriter::GetFilePath() const
+{
+	return (m_file != nullptr ? m_file->GetFilePathOpened() : std::string());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Appends the thread's events in the frame as trace events
+// Returns false and appends nothing if the thread's writer lapped them while they were read
+//
+bool ProfileTraceWriter::AppendThreadEvents(const ProfileFrame_t& frame, int threadIndex, ProfileEventBuffer* buffer)
+{
+	uint64_t startIndex = frame.threadEventStarts[threadIndex];
+	uint64_t endIndex = frame.threadEventEnds[threadIndex];
+
+	if (startIndex == endIndex)
+	{
+		return true;
+	}
+
+	if (!buffer->IsEventAvailable(startIndex))
+	{
+		return false;
+	}
+
+	m_threadText.clear();
+	int openScopeCount = m_openScopeCounts[threadIndex];
+	bool hasWrittenEvent = m_hasWrittenEvent;
+
+	char eventText[128];
+	for (uint64_t eventIndex = startIndex; eventIndex < endIndex; ++eventIndex)
+	{
+		const ProfileEvent_t& event = buffer->GetEvent(eventIndex);
+		double timestamp = GetTimestamp(event.hpc);
+
+		// Scopes that began before the trace did can't be ended
+		if (event.type == PROFILE_EVENT_END && openScopeCount == 0)
+		{
+			continue;
+		}
+
+		m_threadText += (hasWrittenEvent ? ",\n" : "");
+		hasWrittenEvent = true;
+
+		if (event.type == PROFILE_EVENT_END)
+		{
+			snprintf(eventText, sizeof(eventText), "{\"ph\":\"E\",\"ts\":%.3f,\"pid\":%i,\"tid\":%i}", timestamp, PROFILE_TRACE_PROCESS_ID, threadIndex);
+			m_threadText += eventText;
+
+			openScopeCount--;
+			continue;
+		}
+
+		const ProfileScopeDescriptor_t& descriptor = ProfileScopeRegistry::GetDescriptor(event.scopeId);
+
+		m_threadText += "{\"name\":\"";
+		AppendEscapedTraceString(m_threadText, descriptor.name);
+
+		switch (event.type)
+		{
+		case PROFILE_EVENT_BEGIN:
+			m_threadText += "\",\"cat\":\"";
+			AppendEscapedTraceString(m_threadText, descriptor.category);
+			snprintf(eventText, sizeof(eventText), "\",\"ph\":\"B\",\"ts\":%.3f,\"pid\":%i,\"tid\":%i}", timestamp, PROFILE_TRACE_PROCESS_ID, threadIndex);
+			openScopeCount++;
+			break;
+		case PROFILE_EVENT_MARKER:
+			snprintf(eventText, sizeof(eventText), "\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":%i,\"tid\":%i,\"args\":{\"value\":%u}}", timestamp, PROFILE_TRACE_PROCESS_ID, threadIndex, event.value);
+			break;
+		case PROFILE_EVENT_ASYNC_BEGIN:
+			snprintf(eventText, sizeof(eventText), "\",\"cat\":\"async\",\"ph\":\"b\",\"id\":%u,\"ts\":%.3f,\"pid\":%i,\"tid\":%i}", event.value, timestamp, PROFILE_TRACE_PROCESS_ID, threadIndex);
+			break;
+		case PROFILE_EVENT_ASYNC_END:
+			snprintf(eventText, sizeof(eventText), "\",\"cat\":\"async\",\"ph\":\"e\",\"id\":%u,\"ts\":%.3f,\"pid\":%i,\"tid\":%i}", event.value, timestamp, PROFILE_TRACE_PROCESS_ID, threadIndex);
+			break;
+		default:
+			break;
+		}
+
+		m_threadText += eventText;
+	}
+
+	// The writer may have lapped the range while it was read
+	if (!buffer->IsEventAvailable(startIndex))
+	{
+		return false;
+	}
+
+	m_text += m_threadText;
+	m_openScopeCounts[threadIndex] = openScopeCount;
+	m_hasWrittenEvent = hasWrittenEvent;
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Appends the metadata event that names the thread's track
+//
+void ProfileTraceWriter::AppendThreadName(int threadIndex, const std::string& threadName)
+{
+	char eventText[128];
+
+	AppendEventSeparator();
+	snprintf(eventText, sizeof(eventText), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%i,\"tid\":%i,\"args\":{\"name\":\"", PROFILE_TRACE_PROCESS_ID, threadIndex);
+	m_text += eventText;
+	AppendEscapedTraceString(m_text, threadName.c_str());
+	m_text += "\"}}";
+
+	// Keeps the tracks in registration order, so the main thread is on top
+	AppendEventSeparator();
+	snprintf(eventText, sizeof(eventText), "{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":%i,\"tid\":%i,\"args\":{\"sort_index\":%i}}", PROFILE_TRACE_PROCESS_ID, threadIndex, threadIndex);
+	m_text += eventText;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Appends a counter event for each counter at the start of the frame, holding its count for the frame
+// Each counter gets its own track, since their scales are nothing alike
+//
+void ProfileTraceWriter::AppendFrameCounters(const ProfileFrame_t& frame)
+{
+	char eventText[128];
+	double timestamp = GetTimestamp(frame.startHPC);
+
+	int counterCount = ProfileCounters::GetCounterCount();
+	for (int counterIndex = 0; counterIndex < counterCount; ++counterIndex)
+	{
+		AppendEventSeparator();
+		m_text += "{\"name\":\"";
+		AppendEscapedTraceString(m_text, ProfileCounters::GetCounterName(counterIndex));
+
+		snprintf(eventText, sizeof(eventText), "\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":%i,\"args\":{\"value\":%llu}}", timestamp, PROFILE_TRACE_PROCESS_ID, frame.counterValues[counterIndex]);
+		m_text += eventText;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Appends the comma before the next event, if there's an event before it
+//
+void ProfileTraceWriter::AppendEventSeparator()
+{
+	if (m_hasWrittenEvent)
+	{
+		m_text += ",\n";
+	}
+
+	m_hasWrittenEvent = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the time since the start of the trace in microseconds, the trace format's unit
+// Events published just after a frame boundary can be stamped just before it, so it's clamped
+//
+double ProfileTraceWriter::GetTimestamp(uint64_t hpc) const
+{
+	if (hpc <= m_startHPC)
+	{
+		return 0.0;
+	}
+
+	return TimeSystem::PerformanceCountToSeconds(hpc - m_startHPC) * 1000000.0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the buffered text to the file
+//
+void ProfileTraceWriter::FlushText()
+{
+	if (m_text.size() > 0)
+	{
+		m_file->Write(m_text.c_str(), m_text.size());
+		m_text.clear();
+	}
+}
@@ -0,0 +1,72 @@
+/************************************************************************/
+/* File: ProfileTraceWriter.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Writes profiler frames out as Chrome Trace Event JSON,
+/*				for chrome://tracing or the Perfetto UI
+/************************************************************************/
+#pragma once
+#include "Engine/Core/Time/Profiler.hpp"
+#include <string>
+#include <stdint.h>
+
+#define PROFILE_TRACE_FLUSH_SIZE (1024 * 1024)
+
+class File;
+struct LogMessage_t;
+class ProfileEventBuffer;
+
+class ProfileTraceWriter
+{
+public:
+	//-----Public Methods-----
+
+	ProfileTraceWriter();
+	~ProfileTraceWriter();
+
+	ProfileTraceWriter(const ProfileTraceWriter& copy) = delete;
+	ProfileTraceWriter& operator=(const ProfileTraceWriter& copy) = delete;
+
+	bool			Open(const std::string& filePath);
+	void			Close();
+	bool			IsOpen() const;
+
+	// Frames must be written oldest first, and without gaps for scopes that cross frames to pair up
+	// Events are buffered and written to the file in large chunks, so this can be called every frame
+	void			WriteFrame(const ProfileFrame_t& frame, ProfileEventBuffer* const* threadBuffers);
+
+	// Written as global instant events, so only after the first frame
+	void			WriteLogMessage(const LogMessage_t& message);
+
+	int				GetFrameCount() const;
+	std::string		GetFilePath() const;
+
+
+private:
+	//-----Private Methods-----
+
+	bool			AppendThreadEvents(const ProfileFrame_t& frame, int threadIndex, ProfileEventBuffer* buffer);
+	void			AppendThreadName(int threadIndex, const std::string& threadName);
+	void			AppendFrameCounters(const ProfileFrame_t& frame);
+	void			AppendEventSeparator();
+	double			GetTimestamp(uint64_t hpc) const;
+	void			FlushText();
+
+
+private:
+	//-----Private Data-----
+
+	File*			m_file = nullptr;
+	std::string		m_text;
+	std::string		m_threadText;		// One thread's events for a frame, kept only if they weren't overwritten while read
+
+	uint64_t		m_startHPC = 0;
+	uint64_t		m_lastFrameEndHPC = 0;
+	int				m_frameCount = 0;
+	bool			m_hasWrittenEvent = false;
+
+	// Per thread, for pairing scope ends with begins across frames
+	int				m_openScopeCounts[PROFILER_MAX_THREAD_COUNT];
+	bool			m_isThreadNamed[PROFILER_MAX_THREAD_COUNT];
+
+};
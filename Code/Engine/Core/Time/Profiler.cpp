@@ -15,18 +15,42 @@
 #include "Engine/Core/Time/Profiler.hpp"
 #include "Engine/Rendering/Meshes/Mesh.hpp"
 #include "Engine/Rendering/Core/Renderer.hpp"
+#include "Engine/Core/Utility/StringID.hpp"
 #include "Engine/Core/Time/ProfileReport.hpp"
+#include "Engine/Core/Time/ProfileHistogram.hpp"
 #include "Engine/Rendering/Resources/Sampler.hpp"
 #include "Engine/Core/Time/ProfileMeasurement.hpp"
 #include "Engine/Core/Time/ProfileReportEntry.hpp"
+#include "Engine/Core/Time/ProfileEventBuffer.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
+#include "Engine/Core/Time/ProfileTraceWriter.hpp"
+#include "Engine/Core/JobSystem/JobSystem.hpp"
+#include "Engine/Core/Memory/MemoryTracker.hpp"
 #include "Engine/Core/DeveloperConsole/Command.hpp"
 #include "Engine/Rendering/Materials/MaterialInstance.hpp"
+#include <mutex>
+#include <algorithm>
+#include <string.h>
 
 #ifdef PROFILING_ENABLED
 
 // Singleton instance
 Profiler*			Profiler::s_instance = nullptr;	
 
+static_assert(PROFILER_HITCH_CAPTURE_FRAMES_BEFORE + PROFILER_HITCH_CAPTURE_FRAMES_AFTER + 1 <= PROFILER_MAX_REPORT_COUNT, "Error: Hitch captures need more frames than the profiler keeps");
+
+// The calling thread's event buffer, checked against the profiler's generation so a thread that
+// outlives a profiler shutdown doesn't write into a deleted buffer
+static thread_local ProfileEventBuffer*	s_threadEventBuffer = nullptr;
+static thread_local int					s_threadEventBufferGeneration = 0;
+static int								s_profilerGeneration = 0;
+
+// The most recent log messages, for hitch captures - written on the log thread, so not on the instance
+static LogMessage_t						s_recentLogMessages[PROFILER_MAX_LOG_MESSAGES];
+static int								s_recentLogMessageCount = 0;
+static int								s_nextLogMessageIndex = 0;
+static std::mutex						s_recentLogMessageLock;
+
 // UI constants
 AABB2				Profiler::s_fpsBorderBounds;
 AABB2				Profiler::s_frameBorderBounds;
@@ -78,6 +102,7 @@ MaterialInstance*	Profiler::s_rottyTopsMaterial = nullptr;
 unsigned int	IncrementIndexWithWrapAround(unsigned int currentIndex);
 unsigned int	DecrementIndexWithWrapAround(unsigned int currentIndex);
 void			DestroyStack(ProfileMeasurement* stack);
+void			RecordRecentLogMessage(LogMessage_t message, void* argumentData);
 
 // Commands
 void Command_ProfilerShow(Command& cmd);
@@ -86,6 +111,16 @@ void Command_ProfilerPause(Command& cmd);
 void Command_ProfilerResume(Command& cmd);
 void Command_ProfilerReportType(Command& cmd);
 void Command_ProfilerSortOrder(Command& cmd);
+void Command_ProfilerExportTrace(Command& cmd);
+void Command_ProfilerTraceStart(Command& cmd);
+void Command_ProfilerTraceStop(Command& cmd);
+void Command_ProfilerHistogram(Command& cmd);
+void Command_ProfilerHistogramAdd(Command& cmd);
+void Command_ProfilerHistogramRemove(Command& cmd);
+void Command_ProfilerHistogramClear(Command& cmd);
+void Command_ProfilerHitchThreshold(Command& cmd);
+void Command_ProfilerCounters(Command& cmd);
+void Command_ProfilerHitchCapture(Command& cmd);
 
 //-----------------------------------------------------------------------------------------------
 // Constructor
@@ -95,18 +130,48 @@ Profiler::Profiler()
 	, m_reportSortOrder(REPORT_SORT_TOTAL_TIME)
 	, m_isOpen(false)
 	, m_isPaused(false)
+	, m_isViewingRemote(false)
+	, m_currentTab(PROFILER_TAB_CPU)
 	, m_currentFrameNumber(0)
 	, m_firstSelectionIndex(-1)
 	, m_secondSelectionIndex(-1)
 	, m_isSelectingFrames(false)
 	, m_framesPerSecond(0.f)
+	, m_threadBufferCount(0)
+	, m_frameHistoryHead(-1)
+	, m_frameHistoryCount(0)
+	, m_isFrameOpen(false)
+	, m_traceCapture(nullptr)
+	, m_scopeHistogramCount(0)
+	, m_hitchThresholdMilliseconds(PROFILER_DEFAULT_HITCH_THRESHOLD_MS)
+	, m_isHitchCaptureEnabled(true)
+	, m_hitchCaptureFrameNumber(-1)
+	, m_hitchCaptureMilliseconds(0.f)
+	, m_hitchCaptureFramesRemaining(0)
+	, m_nextHitchCaptureHPC(0)
+	, m_pushedReportCount(0)
+	, m_selectionReport(nullptr)
+	, m_selectionReportPushCount(0)
+	, m_selectionReportFirstIndex(-1)
+	, m_selectionReportSecondIndex(-1)
 {
+	m_frameHistogram = new ProfileHistogram("Frame", PROFILER_HISTOGRAM_WINDOW_SIZE, m_hitchThresholdMilliseconds);
+
+	for (int i = 0; i < PROFILER_MAX_SCOPE_HISTOGRAMS; ++i)
+	{
+		m_scopeHistograms[i] = nullptr;
+	}
+
 	// Initialize all reports to nullptr
 	for (int i = 0; i < PROFILER_MAX_REPORT_COUNT; ++i)
 	{
-		m_measurements[i] = nullptr;
 		m_reports[i] = nullptr;
 	}
+
+	for (int i = 0; i < PROFILER_MAX_THREAD_COUNT; ++i)
+	{
+		m_threadBuffers[i] = nullptr;
+	}
 }
 
 
@@ -115,26 +180,36 @@ Profiler::Profiler()
 //
 Profiler::~Profiler()
 {
-	// Profile stacks
-	for (int i = 0; i < PROFILER_MAX_REPORT_COUNT; ++i)
+	// Finishes the trace file
+	if (m_traceCapture != nullptr)
 	{
-		if (m_measurements[i] != nullptr)
-		{
-			delete m_measurements[i];
-			m_measurements[i] = nullptr;
-		}
+		delete m_traceCapture;
+		m_traceCapture = nullptr;
 	}
 
+	// Histograms
+	delete m_frameHistogram;
+	m_frameHistogram = nullptr;
 
-	// Reports
-	for (int i = 0; i < PROFILER_MAX_REPORT_COUNT; ++i)
+	for (int i = 0; i < m_scopeHistogramCount; ++i)
+	{
+		delete m_scopeHistograms[i];
+		m_scopeHistograms[i] = nullptr;
+	}
+
+	// Event buffers
+	for (int i = 0; i < PROFILER_MAX_THREAD_COUNT; ++i)
 	{
-		if (m_reports[i] != nullptr)
+		if (m_threadBuffers[i] != nullptr)
 		{
-			delete m_reports[i];
-			m_reports[i] = nullptr;
+			delete m_threadBuffers[i];
+			m_threadBuffers[i] = nullptr;
 		}
 	}
+
+
+	// Reports
+	ClearReports();
 }
 
 
@@ -144,9 +219,16 @@ Profiler::~Profiler()
 void Profiler::Initialize()
 {
 	s_instance = new Profiler();
+	s_profilerGeneration++;
+
+	// The initializing thread is the main thread, and gets buffer 0
+	s_threadEventBuffer = s_instance->CreateEventBuffer("Main");
+	s_threadEventBufferGeneration = s_profilerGeneration;
 
 	InitializeUILayout();
 	InitializeConsoleCommands();
+
+	LogSystem::AddCallback("Profiler", RecordRecentLogMessage, nullptr);
 }
 
 
@@ -237,6 +319,18 @@ void Profiler::InitializeConsoleCommands()
 	Command::Register("profiler_resume",		"Resumes the profiler report generation.",					Command_ProfilerResume);
 	Command::Register("profiler_report_type",	"Sets the profiler report type to the one specified",		Command_ProfilerReportType);
 	Command::Register("profiler_sort_order",	"Sets the profiler child sort order to the one provided.",	Command_ProfilerSortOrder);
+	Command::Register("profiler_export_trace",	"Writes the last n frames to a Chrome trace file f.",		Command_ProfilerExportTrace);
+	Command::Register("profiler_trace_start",	"Starts streaming every frame to a Chrome trace file f.",	Command_ProfilerTraceStart);
+	Command::Register("profiler_trace_stop",	"Stops the running trace capture and closes its file.",		Command_ProfilerTraceStop);
+	Command::Register("profiler_histogram",			"Prints frame and scope time percentiles and hitch counts.",	Command_ProfilerHistogram);
+	Command::Register("profiler_histogram_add",		"Keeps percentiles for the scope with name n.",					Command_ProfilerHistogramAdd);
+	Command::Register("profiler_histogram_remove",	"Stops keeping percentiles for the scope with name n.",			Command_ProfilerHistogramRemove);
+	Command::Register("profiler_histogram_clear",	"Clears the frame and scope time histograms.",					Command_ProfilerHistogramClear);
+	Command::Register("profiler_hitch_threshold",	"Sets the time t in ms frames and scopes must be over to hitch.",	Command_ProfilerHitchThreshold);
+	Command::Register("profiler_counters",			"Prints every counter's count for the last frame.",				Command_ProfilerCounters);
+	Command::Register("profiler_hitch_capture",		"Enables writing traces around hitching frames with e, or toggles.",	Command_ProfilerHitchCapture);
+
+	MemoryTracker::InitializeConsoleCommands();
 
 }
 
@@ -280,50 +374,54 @@ void Profiler::Render()
 void Profiler::BeginFrame()
 {
 	s_instance->m_currentFrameNumber++;
+	MemoryTracker::BeginFrame();
 
-	// Set up the stack frame
-	if (s_instance->m_measurements[0] != nullptr) // Check if we already have a measurement
+	// Finish off the last frame
+	if (s_instance->m_isFrameOpen)
 	{
-		if (s_instance->m_measurements[PROFILER_MAX_REPORT_COUNT - 1] != nullptr)
-		{
-			DestroyStack(s_instance->m_measurements[PROFILER_MAX_REPORT_COUNT - 1]);
-		}
+		s_instance->PopMeasurement();
 
-		for (int i = PROFILER_MAX_REPORT_COUNT - 1; i > 0; --i)
-		{
-			s_instance->m_measurements[i] = s_instance->m_measurements[i - 1];
-		}
+		ASSERT_OR_DIE(s_threadEventBuffer->GetOpenScopeCount() == 0, "Error: Profiler::MarkFrame called before the previous frame could finish"); // if not 0, someone forgot to pop after a push somewhere
+	}
 
-		s_instance->PopMeasurement(); // Pop the stack at 0, which finalizes the last frame, and should make [0] null
+	// Ends the last frame and starts this one at the same point in every thread's events
+	s_instance->RecordFrameBoundary();
 
-		ASSERT_OR_DIE(s_instance->m_measurements[0] == nullptr, "Error: Profiler::MarkFrame called before the previous frame could finish"); // if not null, someone forgot to pop after a push somewhere
+	if (s_instance->m_traceCapture != nullptr && s_instance->GetCompletedFrame(0) != nullptr)
+	{
+		s_instance->m_traceCapture->WriteFrame(*s_instance->GetCompletedFrame(0), s_instance->m_threadBuffers);
 	}
 
-	// Making a report for the last frame before starting the report generation of the previous frame
-	if (s_instance->m_measurements[1] != nullptr && !s_instance->m_isPaused && s_instance->m_isOpen)
+	s_instance->PushMeasurement("Frame");
+	s_instance->m_isFrameOpen = true;
+
+	const ProfileFrame_t* lastFrame = s_instance->GetCompletedFrame(0);
+
+	// Histograms are always of this process, and cheap enough to keep while the profiler is closed
+	if (lastFrame != nullptr)
 	{
-		ProfileReport* report = BuildReportForFrame(s_instance->m_measurements[1]);
-		s_instance->PushReport(report);
+		s_instance->m_frameHistogram->AddSample((float) TimeSystem::PerformanceCountToSeconds(lastFrame->endHPC - lastFrame->startHPC) * 1000.f);
+		s_instance->UpdateScopeHistograms(*lastFrame);
+		s_instance->UpdateHitchCapture(*lastFrame);
 	}
 
-	s_instance->PushMeasurement("Frame"); // Push a new frame into [0]
+	// Remote reports and fps come in with PushRemoteReport() instead
+	if (s_instance->m_isViewingRemote)
+	{
+		return;
+	}
 
-	// Update the fps if we can
-	if (s_instance->m_measurements[1] != nullptr)
+	// Only build a report for the frame that finished if it's going to be shown
+	if (lastFrame != nullptr && !s_instance->m_isPaused && s_instance->m_isOpen)
 	{
-		float frameTime = (float) TimeSystem::PerformanceCountToSeconds(s_instance->m_measurements[1]->GetTotalTime_Inclusive());
-		s_instance->m_framesPerSecond = (1.0f / frameTime);
+		ProfileReport* report = BuildReportForFrame(*lastFrame, s_instance->m_generatingReportType, s_instance->m_reportSortOrder);
+		s_instance->PushReport(report);
+	}
 
-		// Color the FPS text
-		s_fpsTextColor = s_graphRedColor;
-		if (s_instance->m_framesPerSecond > 55.f)
-		{
-			s_fpsTextColor = s_graphGreenColor;
-		}
-		else if (s_instance->m_framesPerSecond > 30.f)
-		{
-			s_fpsTextColor = s_graphYellowColor;
-		}
+	// Update the fps if we can
+	if (lastFrame != nullptr)
+	{
+		s_instance->UpdateFramesPerSecond((float) TimeSystem::PerformanceCountToSeconds(lastFrame->endHPC - lastFrame->startHPC));
 	}
 }
 
@@ -460,6 +558,12 @@ void Profiler::ProcessKeyboardInput()
 	{
 		WriteHistoryAverageToLog();
 	}
+
+	// Tab between the frame's scopes, memory and counters
+	if (input->WasKeyJustPressed('T'))
+	{
+		m_currentTab = (eProfilerTab) ((m_currentTab + 1) % NUM_PROFILER_TABS);
+	}
 }
 
 
@@ -474,35 +578,344 @@ void Profiler::EndFrame()
 //-----------------------------------------------------------------------------------------------
 // Pushes a new profile measurement to the current stack, starting the stack if there isn't one yet
 //
+// Safe to call from any thread; only records an event, the tree is rebuilt from them when needed
+//
 void Profiler::PushMeasurement(const char* name)
 {
-	ProfileMeasurement* measurement = new ProfileMeasurement(name);
+	ProfileEventBuffer* buffer = GetEventBufferForThisThread();
 
-	// Set the parent relationship, and the appropriate frame number (though current stack frame number should equal current frame number on profiler)
-	if (s_instance->m_measurements[0] == nullptr)
+	if (buffer != nullptr)
 	{
-		measurement->m_frameNumber = s_instance->m_currentFrameNumber;
-		s_instance->m_measurements[0] = measurement;
+		buffer->PushBeginEvent(ProfileScopeRegistry::GetScopeIdForName(name));
 	}
-	else
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts a new measurement of a scope registered with the ProfileScopeRegistry
+//
+void Profiler::PushMeasurement(uint16_t scopeId)
+{
+	ProfileEventBuffer* buffer = GetEventBufferForThisThread();
+
+	if (buffer != nullptr)
 	{
-		measurement->m_frameNumber = s_instance->m_measurements[0]->m_frameNumber;
-		measurement->m_parent = s_instance->m_measurements[0];
-		s_instance->m_measurements[0]->m_children.push_back(measurement);
-		s_instance->m_measurements[0] = measurement;
+		buffer->PushBeginEvent(scopeId);
 	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Sets the current stack pointer back one level, to point at the current measurement's parent
+// Ends the calling thread's innermost measurement
 //
 void Profiler::PopMeasurement()
 {
-	ASSERT_OR_DIE(s_instance->m_measurements[0] != nullptr, Stringf("Error::Profiler::PopStack called when the current stack was empty"));
+	ProfileEventBuffer* buffer = GetEventBufferForThisThread();
+
+	if (buffer != nullptr)
+	{
+		ASSERT_OR_DIE(buffer->GetOpenScopeCount() > 0, Stringf("Error::Profiler::PopStack called when the current stack was empty on thread \"%s\"", buffer->GetThreadName().c_str()));
+		buffer->PushEndEvent();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records a point in time on the calling thread, with a value to show alongside it
+//
+void Profiler::RecordMarker(const char* name, uint32_t value /*= 0*/)
+{
+	ProfileEventBuffer* buffer = GetEventBufferForThisThread();
+
+	if (buffer != nullptr)
+	{
+		buffer->PushMarkerEvent(PROFILE_EVENT_MARKER, ProfileScopeRegistry::GetScopeIdForName(name), value);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts a span identified by name and id rather than by the thread's scope stack, e.g. a job
+// that can suspend on one worker and resume on another
+//
+void Profiler::BeginAsyncMeasurement(const char* name, uint32_t id)
+{
+	ProfileEventBuffer* buffer = GetEventBufferForThisThread();
+
+	if (buffer != nullptr)
+	{
+		buffer->PushMarkerEvent(PROFILE_EVENT_ASYNC_BEGIN, ProfileScopeRegistry::GetScopeIdForName(name), id);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Ends the span with the same name and id, from any thread
+//
+void Profiler::EndAsyncMeasurement(const char* name, uint32_t id)
+{
+	ProfileEventBuffer* buffer = GetEventBufferForThisThread();
+
+	if (buffer != nullptr)
+	{
+		buffer->PushMarkerEvent(PROFILE_EVENT_ASYNC_END, ProfileScopeRegistry::GetScopeIdForName(name), id);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Creates an event buffer that isn't tied to a thread, and returns its index
+//
+int Profiler::RegisterTimeline(const char* timelineName)
+{
+	if (s_instance == nullptr)
+	{
+		return -1;
+	}
+
+	int bufferIndex = -1;
+	s_instance->CreateEventBuffer(timelineName, &bufferIndex);
+
+	return bufferIndex;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts a measurement on the timeline that began at the given time
+//
+void Profiler::PushTimelineMeasurement(int timelineIndex, const char* name, uint64_t startHPC)
+{
+	if (s_instance != nullptr && timelineIndex >= 0)
+	{
+		s_instance->m_threadBuffers[timelineIndex]->PushBeginEvent(ProfileScopeRegistry::GetScopeIdForName(name), startHPC);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Ends the timeline's innermost measurement at the given time
+//
+void Profiler::PopTimelineMeasurement(int timelineIndex, uint64_t endHPC)
+{
+	if (s_instance != nullptr && timelineIndex >= 0)
+	{
+		s_instance->m_threadBuffers[timelineIndex]->PushEndEvent(endHPC);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Creates the calling thread's event buffer under the given name, if it doesn't have one yet
+// Threads that don't register get one with a generic name on their first measurement
+//
+void Profiler::RegisterThisThread(const char* threadName)
+{
+	if (s_instance == nullptr)
+	{
+		return;
+	}
+
+	if (s_threadEventBufferGeneration != s_profilerGeneration || s_threadEventBuffer == nullptr)
+	{
+		s_threadEventBuffer = s_instance->CreateEventBuffer(threadName);
+		s_threadEventBufferGeneration = s_profilerGeneration;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the calling thread's event buffer, creating it on the thread's first measurement
+// Returns nullptr if the profiler isn't running or has no buffers left
+//
+ProfileEventBuffer* Profiler::GetEventBufferForThisThread()
+{
+	if (s_instance == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (s_threadEventBufferGeneration != s_profilerGeneration)
+	{
+		int threadNumber = s_instance->m_threadBufferCount.load();
+		s_threadEventBuffer = s_instance->CreateEventBuffer(Stringf("Thread %i", threadNumber));
+		s_threadEventBufferGeneration = s_profilerGeneration;
+	}
+
+	return s_threadEventBuffer;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Allocates an event buffer and adds it to the list read from each frame
+//
+ProfileEventBuffer* Profiler::CreateEventBuffer(const std::string& threadName, int* out_bufferIndex /*= nullptr*/)
+{
+	std::lock_guard<std::mutex> lock(m_threadRegistrationLock);
+
+	int bufferIndex = m_threadBufferCount.load();
+
+	if (bufferIndex >= PROFILER_MAX_THREAD_COUNT)
+	{
+		LogTaggedPrintf("PROFILER", "Warning: Thread \"%s\" can't be profiled, already profiling %i threads", threadName.c_str(), PROFILER_MAX_THREAD_COUNT);
+		return nullptr;
+	}
+
+	ProfileEventBuffer* buffer = new ProfileEventBuffer(threadName);
+	m_threadBuffers[bufferIndex] = buffer;
+
+	// Published after the buffer is set, so the main thread never reads a null one
+	m_threadBufferCount.store(bufferIndex + 1);
+
+	if (out_bufferIndex != nullptr)
+	{
+		*out_bufferIndex = bufferIndex;
+	}
+
+	return buffer;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Closes the current frame into the history and opens the next, at each thread's write index
+//
+void Profiler::RecordFrameBoundary()
+{
+	uint64_t boundaryHPC = GetPerformanceCounter();
+	int threadCount = m_threadBufferCount.load();
+
+	// The counts since the last boundary are the frame's that's ending
+	ProfileCounters::EndFrame(m_currentFrame.counterValues);
+
+	if (m_isFrameOpen)
+	{
+		m_currentFrame.endHPC = boundaryHPC;
+
+		for (int threadIndex = 0; threadIndex < m_currentFrame.threadCount; ++threadIndex)
+		{
+			m_currentFrame.threadEventEnds[threadIndex] = m_threadBuffers[threadIndex]->GetWriteIndex();
+		}
+
+		m_frameHistoryHead = (m_frameHistoryHead + 1) % PROFILER_MAX_REPORT_COUNT;
+		m_frameHistory[m_frameHistoryHead] = m_currentFrame;
+		m_frameHistoryCount = MinInt(m_frameHistoryCount + 1, PROFILER_MAX_REPORT_COUNT);
+	}
+
+	// Threads that registered mid frame only start counting from this one
+	m_currentFrame.frameNumber = m_currentFrameNumber;
+	m_currentFrame.startHPC = boundaryHPC;
+	m_currentFrame.endHPC = boundaryHPC;
+	m_currentFrame.threadCount = threadCount;
+
+	for (int threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+	{
+		m_currentFrame.threadEventStarts[threadIndex] = m_threadBuffers[threadIndex]->GetWriteIndex();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the completed frame the given number of frames ago (0 being the last one), or nullptr
+// if the history doesn't go back that far
+//
+const ProfileFrame_t* Profiler::GetCompletedFrame(int age) const
+{
+	if (age < 0 || age >= m_frameHistoryCount)
+	{
+		return nullptr;
+	}
+
+	int historyIndex = (m_frameHistoryHead - age + PROFILER_MAX_REPORT_COUNT) % PROFILER_MAX_REPORT_COUNT;
+	return &m_frameHistory[historyIndex];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Rebuilds the measurement tree of one thread for the given frame from its events
+// The main thread's tree is rooted at "Frame"; other threads get a root named after the thread
+// whose time is the sum of its scopes, since they don't have a frame scope of their own.
+// Scopes still open at the end of the frame are cut off there, and ends of scopes begun in an
+// earlier frame are skipped. Markers and async spans only show up in exported traces.
+// Returns nullptr if there's nothing, or the events were overwritten
+//
+ProfileMeasurement* Profiler::BuildStackForThread(const ProfileFrame_t& frame, int threadIndex) const
+{
+	ProfileEventBuffer* buffer = m_threadBuffers[threadIndex];
+	uint64_t startIndex = frame.threadEventStarts[threadIndex];
+	uint64_t endIndex = frame.threadEventEnds[threadIndex];
+
+	if (startIndex == endIndex || !buffer->IsEventAvailable(startIndex))
+	{
+		return nullptr;
+	}
+
+	bool isMainThread = (threadIndex == 0);
+
+	ProfileMeasurement* root = nullptr;
+	ProfileMeasurement* current = nullptr;
+
+	if (!isMainThread)
+	{
+		root = new ProfileMeasurement(buffer->GetThreadName().c_str(), 0);
+		root->m_frameNumber = frame.frameNumber;
+		current = root;
+	}
+
+	for (uint64_t eventIndex = startIndex; eventIndex < endIndex; ++eventIndex)
+	{
+		const ProfileEvent_t& event = buffer->GetEvent(eventIndex);
+
+		if (event.type == PROFILE_EVENT_BEGIN)
+		{
+			ProfileMeasurement* measurement = new ProfileMeasurement(ProfileScopeRegistry::GetName(event.scopeId), event.hpc);
+			measurement->m_frameNumber = frame.frameNumber;
+
+			if (current == nullptr)
+			{
+				root = measurement;
+			}
+			else
+			{
+				measurement->m_parent = current;
+				current->m_children.push_back(measurement);
+			}
+
+			current = measurement;
+		}
+		else if (event.type == PROFILE_EVENT_END && current != nullptr && (current != root || isMainThread))
+		{
+			current->m_endHPC = event.hpc;
+			current = current->m_parent;
+		}
+	}
+
+	// Close off whatever is still open
+	while (current != nullptr && (current != root || isMainThread))
+	{
+		current->m_endHPC = frame.endHPC;
+		current = current->m_parent;
+	}
 
-	s_instance->m_measurements[0]->Finish();
-	s_instance->m_measurements[0] = s_instance->m_measurements[0]->m_parent;
+	// The writer may have lapped the range while it was read
+	bool wasOverwritten = !buffer->IsEventAvailable(startIndex);
+
+	if (root == nullptr || wasOverwritten || (!isMainThread && root->m_children.size() == 0))
+	{
+		delete root;
+		return nullptr;
+	}
+
+	if (!isMainThread)
+	{
+		uint64_t busyHPC = 0;
+		for (int childIndex = 0; childIndex < (int) root->m_children.size(); ++childIndex)
+		{
+			busyHPC += root->m_children[childIndex]->GetTotalTime_Inclusive();
+		}
+
+		root->m_endHPC = busyHPC;
+	}
+
+	return root;
 }
 
 
@@ -524,17 +937,11 @@ void Profiler::SetGeneratingReportType(eReportType reportType)
 
 //-----------------------------------------------------------------------------------------------
 // Sets the sorting order of all reports to the one specified
+// Reports are only sorted again as they're shown, so the history isn't rebuilt for it
 //
 void Profiler::SetReportSortingOrder(eSortOrder order)
 {
-	bool orderChanged = s_instance->m_reportSortOrder != order;
 	s_instance->m_reportSortOrder = order;
-
-	// Update all the reports to be the new order
-	if (orderChanged)
-	{
-		s_instance->FlushReports();
-	}
 }
 
 
@@ -666,6 +1073,8 @@ float Profiler::GetAverageTotalTime(int index1, int index2) const
 
 //-----------------------------------------------------------------------------------------------
 // Returns a report that show the accumulated time and percentages of all reports within the indices
+// Each scope path is the difference of its running totals at the two ends of the range, so this
+// costs the same for two reports as for the whole history
 //
 ProfileReport* Profiler::GetAccumulatedReport(int firstIndex, int secondIndex) const
 {
@@ -685,15 +1094,68 @@ ProfileReport* Profiler::GetAccumulatedReport(int firstIndex, int secondIndex) c
 
 	ProfileReport* report = new ProfileReport(-1);
 	report->m_rootEntry = new ProfileReportEntry("Frame");
+	report->m_sortOrder = m_reportSortOrder;
 
-	for (int reportIndex = startIndex; reportIndex <= endIndex; ++reportIndex)
-	{
-		ProfileReport* currReport = m_reports[reportIndex];
-		if (currReport == nullptr) { break; }
+	// Only as far back as there are reports
+	int reportCount = (m_pushedReportCount < PROFILER_MAX_REPORT_COUNT ? (int) m_pushedReportCount : PROFILER_MAX_REPORT_COUNT);
+	startIndex = MaxInt(startIndex, 0);
+	endIndex = MinInt(endIndex, reportCount - 1);
 
-		AddEntryInfoRecursive(currReport->m_rootEntry, report->m_rootEntry);
+	if (startIndex > endIndex)
+	{
+		report->Finalize();
+		return report;
 	}
 
+	// Totals as of the newest report in the range, less those from before the oldest
+	const std::vector<ProfileScopeTotals_t>& newerTotals = m_scopeTotals[(m_pushedReportCount - startIndex) % (PROFILER_MAX_REPORT_COUNT + 1)];
+	const std::vector<ProfileScopeTotals_t>& olderTotals = m_scopeTotals[(m_pushedReportCount - endIndex - 1) % (PROFILER_MAX_REPORT_COUNT + 1)];
+
+	// Parents come before their children, so each entry's parent is made before it
+	std::vector<ProfileReportEntry*> pathEntries(newerTotals.size(), nullptr);
+
+	for (int pathIndex = 0; pathIndex < (int) newerTotals.size(); ++pathIndex)
+	{
+		ProfileScopeTotals_t totals = newerTotals[pathIndex];
+		if (pathIndex < (int) olderTotals.size())
+		{
+			totals.callCount -= olderTotals[pathIndex].callCount;
+			totals.totalTime -= olderTotals[pathIndex].totalTime;
+			totals.selfTime -= olderTotals[pathIndex].selfTime;
+		}
+
+		// Didn't run within the range
+		if (totals.callCount == 0)
+		{
+			continue;
+		}
+
+		const ProfileScopePath_t& path = m_scopePaths[pathIndex];
+		ProfileReportEntry* entry = nullptr;
+
+		if (path.parentIndex == -1)
+		{
+			entry = report->m_rootEntry;
+		}
+		else
+		{
+			ProfileReportEntry* parentEntry = pathEntries[path.parentIndex];
+			if (parentEntry == nullptr)
+			{
+				continue;
+			}
+
+			entry = new ProfileReportEntry(path.name);
+			entry->m_parent = parentEntry;
+			parentEntry->m_children.push_back(entry);
+		}
+
+		entry->m_callCount += (unsigned int) totals.callCount;
+		entry->m_totalTime += totals.totalTime;
+		entry->m_selfTime += totals.selfTime;
+
+		pathEntries[pathIndex] = entry;
+	}
 
 	report->Finalize();
 	return report;
@@ -701,21 +1163,28 @@ ProfileReport* Profiler::GetAccumulatedReport(int firstIndex, int secondIndex) c
 
 
 //-----------------------------------------------------------------------------------------------
-// Recursively accumulates all entry data from the source to the destination
+// Returns the accumulated report of the graph selection, building it again only if the selection
+// changed or a report was pushed since
 //
-void Profiler::AddEntryInfoRecursive(ProfileReportEntry* srcEntry, ProfileReportEntry* dstEntry) const
+ProfileReport* Profiler::GetSelectionReport() const
 {
-	dstEntry->AccumulateData(srcEntry);
+	bool isStale = (m_selectionReport == nullptr
+		|| m_selectionReportPushCount != m_pushedReportCount
+		|| m_selectionReportFirstIndex != m_firstSelectionIndex
+		|| m_selectionReportSecondIndex != m_secondSelectionIndex);
 
-	for (int srcChildIndex = 0; srcChildIndex < (int) srcEntry->m_children.size(); ++srcChildIndex)
+	if (isStale)
 	{
-		ProfileReportEntry* currSrcChild = srcEntry->m_children[srcChildIndex];
-		std::string srcChildName = currSrcChild->m_name;
-
-		ProfileReportEntry* currDstChild = dstEntry->GetOrCreateReportEntryForChild(srcChildName);
+		delete m_selectionReport;
 
-		AddEntryInfoRecursive(currSrcChild, currDstChild);
+		m_selectionReport = GetAccumulatedReport(m_firstSelectionIndex, m_secondSelectionIndex);
+		m_selectionReportPushCount = m_pushedReportCount;
+		m_selectionReportFirstIndex = m_firstSelectionIndex;
+		m_selectionReportSecondIndex = m_secondSelectionIndex;
 	}
+
+	m_selectionReport->SetSortOrder(m_reportSortOrder);
+	return m_selectionReport;
 }
 
 
@@ -754,73 +1223,696 @@ void Profiler::WriteHistoryAverageToLog() const
 	LogPrintf("---------- FRAME PROFILE - AVERAGE OF THE LAST %u FRAMES ----------", PROFILER_MAX_REPORT_COUNT);
 	RecursivelyWriteAverageReportToLog(currEntry, PROFILER_MAX_REPORT_COUNT, 0);
 
-	ConsolePrintf(Rgba::GREEN, "Wrote the current %u samples in the history to the log file", PROFILER_MAX_REPORT_COUNT);
-}
+	LogPrintf("---------- PERCENTILES OF THE LAST %i FRAMES, HITCHES OVER %.2f MS ----------", m_frameHistogram->GetSampleCount(), m_hitchThresholdMilliseconds);
+	LogPrintf("%s", m_frameHistogram->GetSummaryText().c_str());
 
+	for (int histogramIndex = 0; histogramIndex < m_scopeHistogramCount; ++histogramIndex)
+	{
+		LogPrintf("%s", m_scopeHistograms[histogramIndex]->GetSummaryText().c_str());
+	}
 
-//-----------------------------------------------------------------------------------------------
-// Builds the report to represent the given performance frame
-//
-ProfileReport* Profiler::BuildReportForFrame(ProfileMeasurement* stack)
-{
-	ProfileReport* report = new ProfileReport(stack->m_frameNumber);
+	LogPrintf("---------- COUNTERS - AVERAGE OF THE LAST %i FRAMES ----------", m_frameHistoryCount);
 
-	switch (s_instance->m_generatingReportType)
+	int counterCount = ProfileCounters::GetCounterCount();
+	for (int counterIndex = 0; counterIndex < counterCount && m_frameHistoryCount > 0; ++counterIndex)
 	{
-	case REPORT_TYPE_TREE:
-		report->InitializeAsTreeReport(stack, s_instance->m_reportSortOrder);
-		break;
+		uint64_t sum = 0;
+		for (int age = 0; age < m_frameHistoryCount; ++age)
+		{
+			sum += GetCompletedFrame(age)->counterValues[counterIndex];
+		}
+
+		LogPrintf("%-*s %.1f", 24, ProfileCounters::GetCounterName(counterIndex), (double) sum / (double) m_frameHistoryCount);
+	}
+
+	if (JobSystem::GetInstance() != nullptr)
+	{
+		std::vector<std::string> jobLines;
+		JobSystem::GetInstance()->GetStats().GetSummaryText(jobLines);
+
+		LogPrintf("---------- JOBS - PERCENTILES OF THE LAST %i JOBS OF EACH TYPE ----------", JOB_STATS_WINDOW_SIZE);
+		for (int lineIndex = 0; lineIndex < (int) jobLines.size(); ++lineIndex)
+		{
+			LogPrintf("%s", jobLines[lineIndex].c_str());
+		}
+	}
+
+	ConsolePrintf(Rgba::GREEN, "Wrote the current %u samples in the history to the log file", PROFILER_MAX_REPORT_COUNT);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the last frameCount completed frames in the history to a trace file, oldest first
+// Frames whose events were already overwritten are left out by the writer
+//
+bool Profiler::ExportTrace(const std::string& filePath, int frameCount /*= PROFILER_MAX_REPORT_COUNT*/)
+{
+	frameCount = ClampInt(frameCount, 0, s_instance->m_frameHistoryCount);
+
+	ProfileTraceWriter writer;
+	if (!writer.Open(filePath))
+	{
+		return false;
+	}
+
+	for (int age = frameCount - 1; age >= 0; --age)
+	{
+		writer.WriteFrame(*s_instance->GetCompletedFrame(age), s_instance->m_threadBuffers);
+	}
+
+	writer.Close();
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts writing every frame to the file as it completes, replacing any capture already running
+// Unlike the history, a capture isn't limited in length
+//
+bool Profiler::BeginTraceCapture(const std::string& filePath)
+{
+	EndTraceCapture();
+
+	ProfileTraceWriter* writer = new ProfileTraceWriter();
+	if (!writer->Open(filePath))
+	{
+		delete writer;
+		return false;
+	}
+
+	s_instance->m_traceCapture = writer;
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finishes the running trace capture's file
+//
+void Profiler::EndTraceCapture()
+{
+	if (s_instance->m_traceCapture != nullptr)
+	{
+		delete s_instance->m_traceCapture;
+		s_instance->m_traceCapture = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if frames are being streamed to a trace file
+//
+bool Profiler::IsCapturingTrace()
+{
+	return (s_instance->m_traceCapture != nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a new report for the completed frame age frames ago, 0 being the last one
+// Unlike the shown reports these are built whether the profiler is open or not
+//
+ProfileReport* Profiler::CreateReportForFrame(int age, eReportType reportType, eSortOrder sortOrder)
+{
+	const ProfileFrame_t* frame = s_instance->GetCompletedFrame(age);
+
+	if (frame == nullptr)
+	{
+		return nullptr;
+	}
+
+	return BuildReportForFrame(*frame, reportType, sortOrder);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts keeping percentiles of the scope with the given name, returning false if it's already
+// kept or there's no room for it
+//
+bool Profiler::AddScopeHistogram(const std::string& scopeName)
+{
+	if (s_instance->m_scopeHistogramCount >= PROFILER_MAX_SCOPE_HISTOGRAMS)
+	{
+		return false;
+	}
+
+	for (int histogramIndex = 0; histogramIndex < s_instance->m_scopeHistogramCount; ++histogramIndex)
+	{
+		if (s_instance->m_scopeHistograms[histogramIndex]->GetName() == scopeName)
+		{
+			return false;
+		}
+	}
+
+	s_instance->m_scopeHistograms[s_instance->m_scopeHistogramCount] = new ProfileHistogram(scopeName, PROFILER_HISTOGRAM_WINDOW_SIZE, s_instance->m_hitchThresholdMilliseconds);
+	s_instance->m_scopeHistogramCount++;
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stops keeping percentiles of the scope with the given name, returning false if it wasn't kept
+//
+bool Profiler::RemoveScopeHistogram(const std::string& scopeName)
+{
+	for (int histogramIndex = 0; histogramIndex < s_instance->m_scopeHistogramCount; ++histogramIndex)
+	{
+		if (s_instance->m_scopeHistograms[histogramIndex]->GetName() == scopeName)
+		{
+			delete s_instance->m_scopeHistograms[histogramIndex];
+
+			s_instance->m_scopeHistogramCount--;
+			s_instance->m_scopeHistograms[histogramIndex] = s_instance->m_scopeHistograms[s_instance->m_scopeHistogramCount];
+			s_instance->m_scopeHistograms[s_instance->m_scopeHistogramCount] = nullptr;
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes every sample from the frame and scope histograms
+//
+void Profiler::ClearHistograms()
+{
+	s_instance->m_frameHistogram->Clear();
+
+	for (int histogramIndex = 0; histogramIndex < s_instance->m_scopeHistogramCount; ++histogramIndex)
+	{
+		s_instance->m_scopeHistograms[histogramIndex]->Clear();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the time frames and scopes must take longer than to count as hitches
+//
+void Profiler::SetHitchThreshold(float milliseconds)
+{
+	s_instance->m_hitchThresholdMilliseconds = milliseconds;
+	s_instance->m_frameHistogram->SetHitchThreshold(milliseconds);
+
+	for (int histogramIndex = 0; histogramIndex < s_instance->m_scopeHistogramCount; ++histogramIndex)
+	{
+		s_instance->m_scopeHistograms[histogramIndex]->SetHitchThreshold(milliseconds);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the time frames and scopes must take longer than to count as hitches
+//
+float Profiler::GetHitchThreshold()
+{
+	return s_instance->m_hitchThresholdMilliseconds;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the frame histogram followed by the scope ones, owned by the profiler
+//
+void Profiler::GetHistograms(std::vector<const ProfileHistogram*>& out_histograms)
+{
+	out_histograms.push_back(s_instance->m_frameHistogram);
+
+	for (int histogramIndex = 0; histogramIndex < s_instance->m_scopeHistogramCount; ++histogramIndex)
+	{
+		out_histograms.push_back(s_instance->m_scopeHistograms[histogramIndex]);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Enables or disables writing traces around hitching frames; disabling drops any pending capture
+//
+void Profiler::SetHitchCaptureEnabled(bool isEnabled)
+{
+	s_instance->m_isHitchCaptureEnabled = isEnabled;
+
+	if (!isEnabled)
+	{
+		s_instance->m_hitchCaptureFrameNumber = -1;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if hitching frames are written out to traces
+//
+bool Profiler::IsHitchCaptureEnabled()
+{
+	return s_instance->m_isHitchCaptureEnabled;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Switches between showing this process's frames and the reports pushed from another one
+// The history is cleared either way, as the two can't be mixed in the graph
+//
+void Profiler::SetRemoteView(bool isViewingRemote)
+{
+	if (s_instance->m_isViewingRemote == isViewingRemote)
+	{
+		return;
+	}
+
+	s_instance->ClearReports();
+
+	s_instance->m_isViewingRemote = isViewingRemote;
+	s_instance->SetSelectionState(-1, -1, false);
+
+	// Back to the local frames, which are all still in the history
+	s_instance->FlushReports();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the profiler is showing reports from another process
+//
+bool Profiler::IsViewingRemote()
+{
+	return s_instance->m_isViewingRemote;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a report received from another process as the latest, deleting it if it won't be shown
+//
+void Profiler::PushRemoteReport(ProfileReport* report)
+{
+	if (!s_instance->m_isViewingRemote || s_instance->m_isPaused)
+	{
+		delete report;
+		return;
+	}
+
+	s_instance->PushReport(report);
+	s_instance->m_currentFrameNumber = (int) report->m_frameNumber;
+	s_instance->UpdateFramesPerSecond((float) TimeSystem::PerformanceCountToSeconds(report->m_rootEntry->m_totalTime));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Builds the report to represent the given performance frame, rebuilding its measurements from
+// the recorded events and then discarding them
+// Returns nullptr if the main thread's events for the frame have already been overwritten
+//
+ProfileReport* Profiler::BuildReportForFrame(const ProfileFrame_t& frame, eReportType reportType, eSortOrder sortOrder)
+{
+	MEMORY_TAG_SCOPE("Profiler");
+
+	ProfileMeasurement* stack = s_instance->BuildStackForThread(frame, 0);
+
+	if (stack == nullptr)
+	{
+		return nullptr;
+	}
+
+	std::vector<ProfileMeasurement*> threadStacks;
+	for (int threadIndex = 1; threadIndex < frame.threadCount; ++threadIndex)
+	{
+		ProfileMeasurement* threadStack = s_instance->BuildStackForThread(frame, threadIndex);
+
+		if (threadStack != nullptr)
+		{
+			threadStacks.push_back(threadStack);
+		}
+	}
+
+	ProfileReport* report = new ProfileReport(frame.frameNumber);
+
+	switch (reportType)
+	{
+	case REPORT_TYPE_TREE:
+		report->InitializeAsTreeReport(stack, threadStacks, sortOrder);
+		break;
 	case REPORT_TYPE_FLAT:
-		report->InitializeAsFlatReport(stack, s_instance->m_reportSortOrder);
+		report->InitializeAsFlatReport(stack, threadStacks, sortOrder);
 		break;
 	default:
 		break;
 	}
 
+	DestroyStack(stack);
+	for (int threadIndex = 0; threadIndex < (int) threadStacks.size(); ++threadIndex)
+	{
+		DestroyStack(threadStacks[threadIndex]);
+	}
+
 	return report;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Adds the given report to the list in the front, removing and deleting the last if it is full
+// Adds the given report to the list in the front, removing and deleting the last if it is full
+// The report's entries are added onto the running totals, as of this push
+//
+void Profiler::PushReport(ProfileReport* report)
+{
+	const std::vector<ProfileScopeTotals_t>& previousTotals = m_scopeTotals[m_pushedReportCount % (PROFILER_MAX_REPORT_COUNT + 1)];
+	m_pushedReportCount++;
+
+	std::vector<ProfileScopeTotals_t>& totals = m_scopeTotals[m_pushedReportCount % (PROFILER_MAX_REPORT_COUNT + 1)];
+	totals = previousTotals;
+
+	if (report != nullptr && report->m_rootEntry != nullptr)
+	{
+		AddEntryToScopeTotals(report->m_rootEntry, -1, totals);
+	}
+
+	// Check the end
+	if (m_reports[PROFILER_MAX_REPORT_COUNT - 1] != nullptr)
+	{
+		delete m_reports[PROFILER_MAX_REPORT_COUNT - 1];
+	}
+
+	// Shift all report pointers over one
+	for (int i = PROFILER_MAX_REPORT_COUNT - 1; i > 0; --i)
+	{
+		s_instance->m_reports[i] = s_instance->m_reports[i - 1];
+	}
+
+	// Put the new report at the front
+	s_instance->m_reports[0] = report;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes all reports and their running totals
+//
+void Profiler::ClearReports()
+{
+	for (int index = 0; index < PROFILER_MAX_REPORT_COUNT; ++index)
+	{
+		if (m_reports[index] != nullptr)
+		{
+			delete m_reports[index];
+			m_reports[index] = nullptr;
+		}
+	}
+
+	for (int index = 0; index <= PROFILER_MAX_REPORT_COUNT; ++index)
+	{
+		m_scopeTotals[index].clear();
+	}
+
+	m_scopePaths.clear();
+	m_scopePathIndices.clear();
+	m_pushedReportCount = 0;
+
+	if (m_selectionReport != nullptr)
+	{
+		delete m_selectionReport;
+		m_selectionReport = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the entry and all its children onto the totals, by their scope paths
+//
+void Profiler::AddEntryToScopeTotals(const ProfileReportEntry* entry, int parentPathIndex, std::vector<ProfileScopeTotals_t>& totals)
+{
+	int pathIndex = GetOrCreateScopePathIndex(parentPathIndex, entry->m_name);
+
+	if (pathIndex >= (int) totals.size())
+	{
+		totals.resize(pathIndex + 1);
+	}
+
+	totals[pathIndex].callCount += entry->m_callCount;
+	totals[pathIndex].totalTime += entry->m_totalTime;
+	totals[pathIndex].selfTime += entry->m_selfTime;
+
+	for (int childIndex = 0; childIndex < (int) entry->m_children.size(); ++childIndex)
+	{
+		AddEntryToScopeTotals(entry->m_children[childIndex], pathIndex, totals);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the index of the scope path with the given name under the given parent, adding it if
+// this is the first report it's been in
+//
+int Profiler::GetOrCreateScopePathIndex(int parentPathIndex, const std::string& name)
+{
+	uint64_t key = ((uint64_t) (uint32_t) (parentPathIndex + 1) << 32) | (uint64_t) HashStringID(name);
+
+	std::unordered_map<uint64_t, int>::const_iterator itr = m_scopePathIndices.find(key);
+	if (itr != m_scopePathIndices.end())
+	{
+		GUARANTEE_OR_DIE(m_scopePaths[itr->second].name == name, Stringf("Error: Profiler scopes \"%s\" and \"%s\" have the same StringID", m_scopePaths[itr->second].name.c_str(), name.c_str()));
+		return itr->second;
+	}
+
+	ProfileScopePath_t path;
+	path.parentIndex = parentPathIndex;
+	path.name = name;
+
+	int pathIndex = (int) m_scopePaths.size();
+	m_scopePaths.push_back(path);
+	m_scopePathIndices[key] = pathIndex;
+
+	return pathIndex;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the fps shown from the last frame's duration, and colors it
+//
+void Profiler::UpdateFramesPerSecond(float frameSeconds)
+{
+	m_framesPerSecond = (1.0f / frameSeconds);
+
+	// Color the FPS text
+	s_fpsTextColor = s_graphRedColor;
+	if (m_framesPerSecond > 55.f)
+	{
+		s_fpsTextColor = s_graphGreenColor;
+	}
+	else if (m_framesPerSecond > 30.f)
+	{
+		s_fpsTextColor = s_graphYellowColor;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the frame's total time in each kept scope to its histogram, straight from the events so
+// nothing is built when the profiler is closed
+// Only the outermost of nested scopes with the same name is counted, scopes still open at the
+// end of the frame are cut off there, and scopes that didn't run this frame get no sample
+//
+void Profiler::UpdateScopeHistograms(const ProfileFrame_t& frame)
+{
+	if (m_scopeHistogramCount == 0)
+	{
+		return;
+	}
+
+	// Which kept scope each open scope is, or -1, kept up in a fixed stack
+	const int maxDepth = 64;
+	int openScopeHistograms[maxDepth];
+	uint64_t openScopeStartHPCs[maxDepth];
+
+	uint64_t scopeTotalHPCs[PROFILER_MAX_SCOPE_HISTOGRAMS] = {};
+	int scopeOpenCounts[PROFILER_MAX_SCOPE_HISTOGRAMS] = {};
+	bool wasScopeSeen[PROFILER_MAX_SCOPE_HISTOGRAMS] = {};
+
+	for (int threadIndex = 0; threadIndex < frame.threadCount; ++threadIndex)
+	{
+		ProfileEventBuffer* buffer = m_threadBuffers[threadIndex];
+		uint64_t startIndex = frame.threadEventStarts[threadIndex];
+		uint64_t endIndex = frame.threadEventEnds[threadIndex];
+
+		if (startIndex == endIndex || !buffer->IsEventAvailable(startIndex))
+		{
+			continue;
+		}
+
+		int depth = 0;
+		for (uint64_t eventIndex = startIndex; eventIndex < endIndex; ++eventIndex)
+		{
+			const ProfileEvent_t& event = buffer->GetEvent(eventIndex);
+
+			if (event.type == PROFILE_EVENT_BEGIN)
+			{
+				int histogramIndex = -1;
+				for (int scopeIndex = 0; scopeIndex < m_scopeHistogramCount; ++scopeIndex)
+				{
+					if (strcmp(ProfileScopeRegistry::GetName(event.scopeId), m_scopeHistograms[scopeIndex]->GetName().c_str()) == 0)
+					{
+						histogramIndex = scopeIndex;
+						break;
+					}
+				}
+
+				if (depth < maxDepth)
+				{
+					openScopeHistograms[depth] = histogramIndex;
+					openScopeStartHPCs[depth] = event.hpc;
+
+					if (histogramIndex >= 0)
+					{
+						scopeOpenCounts[histogramIndex]++;
+					}
+				}
+
+				depth++;
+			}
+			else if (event.type == PROFILE_EVENT_END && depth > 0) // Ends of scopes from earlier frames are skipped
+			{
+				depth--;
+
+				if (depth < maxDepth && openScopeHistograms[depth] >= 0)
+				{
+					int histogramIndex = openScopeHistograms[depth];
+					scopeOpenCounts[histogramIndex]--;
+
+					if (scopeOpenCounts[histogramIndex] == 0)
+					{
+						scopeTotalHPCs[histogramIndex] += event.hpc - openScopeStartHPCs[depth];
+						wasScopeSeen[histogramIndex] = true;
+					}
+				}
+			}
+		}
+
+		// Close off whatever is still open
+		while (depth > 0)
+		{
+			depth--;
+
+			if (depth < maxDepth && openScopeHistograms[depth] >= 0)
+			{
+				int histogramIndex = openScopeHistograms[depth];
+				scopeOpenCounts[histogramIndex]--;
+
+				if (scopeOpenCounts[histogramIndex] == 0)
+				{
+					scopeTotalHPCs[histogramIndex] += frame.endHPC - openScopeStartHPCs[depth];
+					wasScopeSeen[histogramIndex] = true;
+				}
+			}
+		}
+	}
+
+	for (int histogramIndex = 0; histogramIndex < m_scopeHistogramCount; ++histogramIndex)
+	{
+		if (wasScopeSeen[histogramIndex])
+		{
+			m_scopeHistograms[histogramIndex]->AddSample((float) TimeSystem::PerformanceCountToSeconds(scopeTotalHPCs[histogramIndex]) * 1000.f);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts a capture if the frame hitched, or counts down to writing the pending one
+// Frames over the threshold while a capture is pending or cooling down are left in that capture
 //
-void Profiler::PushReport(ProfileReport* report)
+void Profiler::UpdateHitchCapture(const ProfileFrame_t& frame)
 {
-	// Check the end
-	if (m_reports[PROFILER_MAX_REPORT_COUNT - 1] != nullptr)
+	if (!m_isHitchCaptureEnabled)
 	{
-		delete m_reports[PROFILER_MAX_REPORT_COUNT - 1];
+		return;
 	}
 
-	// Shift all report pointers over one
-	for (int i = PROFILER_MAX_REPORT_COUNT - 1; i > 0; --i)
+	if (m_hitchCaptureFrameNumber >= 0)
 	{
-		s_instance->m_reports[i] = s_instance->m_reports[i - 1];
+		m_hitchCaptureFramesRemaining--;
+
+		if (m_hitchCaptureFramesRemaining <= 0)
+		{
+			WriteHitchCapture();
+		}
+
+		return;
 	}
 
-	// Put the new report at the front
-	s_instance->m_reports[0] = report;
+	float frameMilliseconds = (float) TimeSystem::PerformanceCountToSeconds(frame.endHPC - frame.startHPC) * 1000.f;
+
+	if (frameMilliseconds > m_hitchThresholdMilliseconds && frame.endHPC >= m_nextHitchCaptureHPC)
+	{
+		m_hitchCaptureFrameNumber = frame.frameNumber;
+		m_hitchCaptureMilliseconds = frameMilliseconds;
+		m_hitchCaptureFramesRemaining = PROFILER_HITCH_CAPTURE_FRAMES_AFTER;
+
+		LogTaggedPrintf("PROFILER", "Hitch: frame %i took %.2f ms", frame.frameNumber, frameMilliseconds);
+	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Constructs all the reports in the parallel report array to reflect the current measurement array
+// Writes the pending hitch's frames from the history to a trace, with the log messages made
+// during them; messages the log thread hasn't processed yet are missed
 //
-void Profiler::FlushReports()
+void Profiler::WriteHitchCapture()
 {
-	for (int index = 0; index < PROFILER_MAX_REPORT_COUNT - 1; ++index)
+	int frameCount = MinInt(PROFILER_HITCH_CAPTURE_FRAMES_BEFORE + PROFILER_HITCH_CAPTURE_FRAMES_AFTER + 1, m_frameHistoryCount);
+	std::string filePath = Stringf("Data/Logs/Hitch_%s_Frame%i.json", GetFormattedSystemDateAndTime().c_str(), m_hitchCaptureFrameNumber);
+
+	ProfileTraceWriter writer;
+	if (frameCount > 0 && writer.Open(filePath))
 	{
-		// Cleanup first (slow but safe)
-		if (m_reports[index] != nullptr)
+		for (int age = frameCount - 1; age >= 0; --age)
 		{
-			delete m_reports[index];
-			m_reports[index] = nullptr;
+			writer.WriteFrame(*GetCompletedFrame(age), m_threadBuffers);
+		}
+
+		uint64_t startHPC = GetCompletedFrame(frameCount - 1)->startHPC;
+		uint64_t endHPC = GetCompletedFrame(0)->endHPC;
+
+		s_recentLogMessageLock.lock();
+		{
+			int firstIndex = (s_nextLogMessageIndex - s_recentLogMessageCount + PROFILER_MAX_LOG_MESSAGES) % PROFILER_MAX_LOG_MESSAGES;
+
+			for (int messageNumber = 0; messageNumber < s_recentLogMessageCount; ++messageNumber)
+			{
+				const LogMessage_t& message = s_recentLogMessages[(firstIndex + messageNumber) % PROFILER_MAX_LOG_MESSAGES];
+
+				if (message.hpc >= startHPC && message.hpc <= endHPC)
+				{
+					writer.WriteLogMessage(message);
+				}
+			}
 		}
+		s_recentLogMessageLock.unlock();
 
-		// Reports lag one frame behind active measurements
-		if (m_measurements[index + 1] != nullptr)
+		writer.Close();
+		LogTaggedPrintf("PROFILER", "Wrote the %i frames around the %.2f ms hitch in frame %i to \"%s\"", frameCount, m_hitchCaptureMilliseconds, m_hitchCaptureFrameNumber, filePath.c_str());
+	}
+
+	// Writing the capture can hitch too, so the cooldown starts after it
+	m_nextHitchCaptureHPC = GetPerformanceCounter() + TimeSystem::SecondsToPerformanceCount(PROFILER_HITCH_CAPTURE_COOLDOWN_SECONDS);
+	m_hitchCaptureFrameNumber = -1;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructs all the reports in the parallel report array to reflect the frame history
+//
+void Profiler::FlushReports()
+{
+	// Remote reports can't be rebuilt here, they're replaced as new ones arrive
+	if (m_isViewingRemote)
+	{
+		return;
+	}
+
+	ClearReports();
+
+	// Pushed oldest first, so the running totals build up in order and report 0 ends up the latest
+	for (int age = PROFILER_MAX_REPORT_COUNT - 1; age >= 0; --age)
+	{
+		const ProfileFrame_t* frame = GetCompletedFrame(age);
+		if (frame != nullptr)
 		{
-			m_reports[index] = BuildReportForFrame(m_measurements[index + 1]);
+			PushReport(BuildReportForFrame(*frame, m_generatingReportType, m_reportSortOrder));
 		}
 	}
 }
@@ -851,7 +1943,9 @@ void Profiler::RenderTitleInfo() const
 	std::string frameText	= Stringf("FRAME: %*i",		6,	m_currentFrameNumber);
 	std::string fpsText		= Stringf("FPS: %*.2f",		8,	m_framesPerSecond);
 
-	renderer->DrawTextInBox2D("PROFILER",	s_titleBounds,		Vector2::ZERO, s_titleFontSize,		TEXT_DRAW_OVERRUN, font, s_fontHighlightColor);
+	std::string titleText	= (m_isViewingRemote ? "PROFILER [REMOTE]" : "PROFILER");
+
+	renderer->DrawTextInBox2D(titleText,	s_titleBounds,		Vector2::ZERO, s_titleFontSize,		TEXT_DRAW_SHRINK_TO_FIT, font, s_fontHighlightColor);
 	renderer->DrawTextInBox2D(frameText,	s_frameBounds,		Vector2::ZERO, s_fpsFrameFontSize,	TEXT_DRAW_OVERRUN, font, s_fontHighlightColor);	
 	renderer->DrawTextInBox2D(fpsText,		s_fpsBounds,		Vector2::ZERO, s_fpsFrameFontSize,	TEXT_DRAW_OVERRUN, font, s_fpsTextColor);
 
@@ -1006,7 +2100,11 @@ void Profiler::RenderGraph() const
 		detailText = "Mouse: HIDDEN\n";
 	}
 
-	if (m_generatingReportType == REPORT_TYPE_FLAT)
+	if (m_isViewingRemote)
+	{
+		detailText += "View: REMOTE\n";
+	}
+	else if (m_generatingReportType == REPORT_TYPE_FLAT)
 	{
 		detailText += "View: FLAT\n";
 	}
@@ -1017,11 +2115,29 @@ void Profiler::RenderGraph() const
 
 	if (m_reportSortOrder == REPORT_SORT_SELF_TIME)
 	{
-		detailText += "Sort: SELF";
+		detailText += "Sort: SELF\n";
 	}
 	else
 	{
-		detailText += "Sort: TOTAL";
+		detailText += "Sort: TOTAL\n";
+	}
+
+	switch (m_currentTab)
+	{
+	case PROFILER_TAB_MEMORY:
+		detailText += "Tab: MEMORY";
+		break;
+	case PROFILER_TAB_COUNTERS:
+		detailText += "Tab: COUNTERS";
+		break;
+	default:
+		detailText += "Tab: CPU";
+		break;
+	}
+
+	if (m_reports[0] != nullptr && m_reports[0]->m_allocationCount >= 0)
+	{
+		detailText += Stringf("\nAllocs: %i", m_reports[0]->m_allocationCount);
 	}
 
 	renderer->DrawTextInBox2D(detailText, s_graphDetailsBounds, Vector2::ONES, s_viewDataFontSize, TEXT_DRAW_OVERRUN, font, s_fontColor);
@@ -1038,7 +2154,9 @@ void Profiler::RenderGraph() const
 	}
 
 	averageTime *= 1000.f;
-	renderer->DrawTextInBox2D(Stringf("Average Frame: %*.2f ms", 5, averageTime), s_graphDetailsBounds, Vector2(1.f, 0.f), s_viewDataFontSize, TEXT_DRAW_OVERRUN, font, s_fontColor);
+
+	std::string percentileText = Stringf("p99 (%i): %*.2f ms\nHitches: %i\n", m_frameHistogram->GetSampleCount(), 5, m_frameHistogram->GetPercentile(99.f), m_frameHistogram->GetHitchCount());
+	renderer->DrawTextInBox2D(percentileText + Stringf("Average Frame: %*.2f ms", 5, averageTime), s_graphDetailsBounds, Vector2(1.f, 0.f), s_viewDataFontSize, TEXT_DRAW_OVERRUN, font, s_fontColor);
 }
 
 
@@ -1056,6 +2174,18 @@ void Profiler::RenderData() const
 	renderer->Draw2DQuad(s_viewDataBorderBounds,		AABB2::UNIT_SQUARE_OFFCENTER, s_borderColor,	material);
 	renderer->Draw2DQuad(s_viewDataBounds,				AABB2::UNIT_SQUARE_OFFCENTER, s_backgroundColor, material);
 
+	if (m_currentTab == PROFILER_TAB_MEMORY)
+	{
+		RenderMemoryData();
+		return;
+	}
+
+	if (m_currentTab == PROFILER_TAB_COUNTERS)
+	{
+		RenderCounterData();
+		return;
+	}
+
 	//std::string headingText = Stringf("FUNCTION NAME%*sCALLS%*s%% TOTAL%*sTIME%*s%% SELF%*sTIME", 12, "", 5, "", 8, "", 6, "", 8, "");
 	std::string headingText = Stringf("%-*s%*s%*s%*s%*s%*s", 
 		44, "FUNCTION NAME", 8, "CALLS", 10, "% TOTAL", 10, "TIME", 10, "% SELF", 10, "TIME");
@@ -1068,14 +2198,16 @@ void Profiler::RenderData() const
 
 	if (m_isSelectingFrames) // Display the data from the selected frames
 	{
-		ProfileReport* report = GetAccumulatedReport(m_firstSelectionIndex, m_secondSelectionIndex);
+		ProfileReport* report = GetSelectionReport();
 		RecursivelyPrintEntry(0, entryBounds, report->m_rootEntry);
-		delete report;
 	}
 	else // Display the data from the root of the last report
 	{
 		ProfileReport* report = m_reports[0];
 		if (report == nullptr) { return; }
+
+		// Sorted here instead of when the order changes, so only the shown report is ever re-sorted
+		report->SetSortOrder(m_reportSortOrder);
 		RecursivelyPrintEntry(0, entryBounds, report->m_rootEntry);
 	}
 }
@@ -1109,6 +2241,141 @@ void Profiler::RecursivelyPrintEntry(unsigned int indent, AABB2& drawBounds, Pro
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Renders the memory tab - the total and every tag, then the callsites with the most live bytes
+// for as many rows as fit
+//
+void Profiler::RenderMemoryData() const
+{
+	Renderer* renderer	= Renderer::GetInstance();
+	BitmapFont* font	= AssetDB::GetBitmapFont("Data/Images/Fonts/ConsoleFont.png");
+
+	std::string headingText = Stringf("%-*s%*s%*s%*s%*s",
+		44, "TAG / CALLSITE", 12, "LIVE KB", 12, "PEAK KB", 12, "LIVE", 12, "FRAME");
+
+	renderer->DrawTextInBox2D(headingText, s_viewHeadingBounds, Vector2::ZERO, s_viewHeadingFontSize, TEXT_DRAW_OVERRUN, font, s_fontHighlightColor);
+
+	AABB2 rowBounds = AABB2(Vector2(s_viewDataBounds.mins.x, s_viewDataBounds.maxs.y - s_viewDataFontSize), s_viewDataBounds.maxs);
+
+	if (!MemoryTracker::IsEnabled())
+	{
+		renderer->DrawTextInBox2D("Memory tracking isn't enabled, define MEMORY_TRACKING_ENABLED in EngineBuildPreferences.hpp", rowBounds, Vector2::ZERO, s_viewDataFontSize, TEXT_DRAW_OVERRUN, font, s_fontColor);
+		return;
+	}
+
+	MemoryStats_t total = MemoryTracker::GetTotalStats();
+
+	std::vector<MemoryTagStats_t> tags;
+	MemoryTracker::GetTagStats(tags);
+
+	std::vector<MemoryCallsiteStats_t> callsites;
+	MemoryTracker::GetCallsiteStats(callsites);
+	std::sort(callsites.begin(), callsites.end(), [](const MemoryCallsiteStats_t& a, const MemoryCallsiteStats_t& b) { return a.stats.liveBytes > b.stats.liveBytes; });
+
+	int rowCount = (int) (s_viewDataBounds.GetDimensions().y / s_viewDataFontSize);
+	int callsiteRowCount = rowCount - (int) tags.size() - 2; // The total and a blank row
+
+	std::vector<std::string> rowNames;
+	std::vector<MemoryStats_t> rowStats;
+
+	rowNames.push_back("Total");
+	rowStats.push_back(total);
+
+	for (int tagIndex = 0; tagIndex < (int) tags.size(); ++tagIndex)
+	{
+		rowNames.push_back(Stringf("  [%s]", tags[tagIndex].name.c_str()));
+		rowStats.push_back(tags[tagIndex].stats);
+	}
+
+	for (int callsiteIndex = 0; callsiteIndex < callsiteRowCount && callsiteIndex < (int) callsites.size(); ++callsiteIndex)
+	{
+		std::string name = MemoryTracker::GetCallsiteName(callsites[callsiteIndex].callsiteIndex);
+		if (name.size() > 42)
+		{
+			name = name.substr(0, 39) + "...";
+		}
+
+		rowNames.push_back(name);
+		rowStats.push_back(callsites[callsiteIndex].stats);
+	}
+
+	for (int rowIndex = 0; rowIndex < (int) rowNames.size(); ++rowIndex)
+	{
+		// Blank row between the tags and the callsites
+		if (rowIndex == (int) tags.size() + 1)
+		{
+			rowBounds.Translate(Vector2(0.f, -s_viewDataFontSize));
+		}
+
+		const MemoryStats_t& stats = rowStats[rowIndex];
+		std::string text = Stringf("%-*s%*.2f%*.2f%*lld%*llu", 44, rowNames[rowIndex].c_str(),
+			12, (float) stats.liveBytes / 1024.f, 12, (float) stats.peakLiveBytes / 1024.f, 12, stats.liveAllocationCount, 12, stats.frameAllocationCount);
+
+		renderer->DrawTextInBox2D(text, rowBounds, Vector2::ZERO, s_viewDataFontSize, TEXT_DRAW_OVERRUN, font, s_fontColor);
+		rowBounds.Translate(Vector2(0.f, -s_viewDataFontSize));
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Renders the counters tab - each counter's count for the last frame, and its average and max
+// over the frame history
+//
+void Profiler::RenderCounterData() const
+{
+	Renderer* renderer	= Renderer::GetInstance();
+	BitmapFont* font	= AssetDB::GetBitmapFont("Data/Images/Fonts/ConsoleFont.png");
+
+	std::string headingText = Stringf("%-*s%*s%*s%*s", 44, "COUNTER", 14, "LAST FRAME", 14, "AVERAGE", 14, "MAX");
+	renderer->DrawTextInBox2D(headingText, s_viewHeadingBounds, Vector2::ZERO, s_viewHeadingFontSize, TEXT_DRAW_OVERRUN, font, s_fontHighlightColor);
+
+	AABB2 rowBounds = AABB2(Vector2(s_viewDataBounds.mins.x, s_viewDataBounds.maxs.y - s_viewDataFontSize), s_viewDataBounds.maxs);
+
+	const ProfileFrame_t* lastFrame = GetCompletedFrame(0);
+	if (lastFrame == nullptr)
+	{
+		return;
+	}
+
+	int counterCount = ProfileCounters::GetCounterCount();
+	for (int counterIndex = 0; counterIndex < counterCount; ++counterIndex)
+	{
+		uint64_t sum = 0;
+		uint64_t max = 0;
+
+		for (int age = 0; age < m_frameHistoryCount; ++age)
+		{
+			uint64_t value = GetCompletedFrame(age)->counterValues[counterIndex];
+
+			sum += value;
+			max = (value > max ? value : max);
+		}
+
+		double average = (double) sum / (double) m_frameHistoryCount;
+
+		std::string text = Stringf("%-*s%*llu%*.1f%*llu", 44, ProfileCounters::GetCounterName(counterIndex),
+			14, lastFrame->counterValues[counterIndex], 14, average, 14, max);
+
+		renderer->DrawTextInBox2D(text, rowBounds, Vector2::ZERO, s_viewDataFontSize, TEXT_DRAW_OVERRUN, font, s_fontColor);
+		rowBounds.Translate(Vector2(0.f, -s_viewDataFontSize));
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Log callback that keeps the most recent messages for hitch captures, run on the log thread
+//
+void RecordRecentLogMessage(LogMessage_t message, void* argumentData)
+{
+	UNUSED(argumentData);
+	std::lock_guard<std::mutex> lock(s_recentLogMessageLock);
+
+	s_recentLogMessages[s_nextLogMessageIndex] = message;
+	s_nextLogMessageIndex = (s_nextLogMessageIndex + 1) % PROFILER_MAX_LOG_MESSAGES;
+	s_recentLogMessageCount = MinInt(s_recentLogMessageCount + 1, PROFILER_MAX_LOG_MESSAGES);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Recursively deletes the measurement stack
 //
@@ -1268,6 +2535,204 @@ void Command_ProfilerSortOrder(Command& cmd)
 }
 
 
+
+//-----------------------------------------------------------------------------------------------
+// Writes the frames in the history to a trace file
+//
+void Command_ProfilerExportTrace(Command& cmd)
+{
+	std::string filePath = "Data/Logs/ProfileTrace.json";
+	int frameCount = PROFILER_MAX_REPORT_COUNT;
+
+	cmd.GetParam("f", filePath, &filePath);
+	cmd.GetParam("n", frameCount, &frameCount);
+
+	if (Profiler::ExportTrace(filePath, frameCount))
+	{
+		ConsolePrintf(Rgba::GREEN, "Wrote the profiler history to \"%s\".", filePath.c_str());
+	}
+	else
+	{
+		ConsoleErrorf("Couldn't open \"%s\" for the trace.", filePath.c_str());
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts streaming frames to a trace file
+//
+void Command_ProfilerTraceStart(Command& cmd)
+{
+	std::string filePath = "Data/Logs/ProfileCapture.json";
+	cmd.GetParam("f", filePath, &filePath);
+
+	if (Profiler::BeginTraceCapture(filePath))
+	{
+		ConsolePrintf(Rgba::GREEN, "Capturing profiler frames to \"%s\".", filePath.c_str());
+	}
+	else
+	{
+		ConsoleErrorf("Couldn't open \"%s\" for the trace.", filePath.c_str());
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stops the running trace capture
+//
+void Command_ProfilerTraceStop(Command& cmd)
+{
+	UNUSED(cmd);
+
+	if (!Profiler::IsCapturingTrace())
+	{
+		ConsoleWarningf("No profiler trace capture is running.");
+		return;
+	}
+
+	Profiler::EndTraceCapture();
+	ConsolePrintf(Rgba::GREEN, "Profiler trace capture stopped.");
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Prints the percentiles and hitch counts of the frame and each kept scope
+//
+void Command_ProfilerHistogram(Command& cmd)
+{
+	UNUSED(cmd);
+
+	std::vector<const ProfileHistogram*> histograms;
+	Profiler::GetHistograms(histograms);
+
+	ConsolePrintf(Rgba::GREEN, "Percentiles of the last %i frames, hitches over %.2f ms:", histograms[0]->GetSampleCount(), Profiler::GetHitchThreshold());
+
+	for (int histogramIndex = 0; histogramIndex < (int) histograms.size(); ++histogramIndex)
+	{
+		ConsolePrintf(Rgba::GREEN, "%s", histograms[histogramIndex]->GetSummaryText().c_str());
+	}
+
+	// Job histograms are read under their own locks, so they're printed from the JobSystem's text
+	if (JobSystem::GetInstance() != nullptr)
+	{
+		std::vector<std::string> jobLines;
+		JobSystem::GetInstance()->GetStats().GetSummaryText(jobLines);
+
+		for (int lineIndex = 0; lineIndex < (int) jobLines.size(); ++lineIndex)
+		{
+			ConsolePrintf(Rgba::GREEN, "%s", jobLines[lineIndex].c_str());
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts keeping percentiles for the named scope
+//
+void Command_ProfilerHistogramAdd(Command& cmd)
+{
+	std::string scopeName;
+	if (!cmd.GetParam("n", scopeName))
+	{
+		ConsoleErrorf("No scope name specified, use -n");
+		return;
+	}
+
+	if (Profiler::AddScopeHistogram(scopeName))
+	{
+		ConsolePrintf(Rgba::GREEN, "Keeping percentiles for scope \"%s\".", scopeName.c_str());
+	}
+	else
+	{
+		ConsoleErrorf("Scope \"%s\" is already kept, or there's already %i.", scopeName.c_str(), PROFILER_MAX_SCOPE_HISTOGRAMS);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stops keeping percentiles for the named scope
+//
+void Command_ProfilerHistogramRemove(Command& cmd)
+{
+	std::string scopeName;
+	if (!cmd.GetParam("n", scopeName))
+	{
+		ConsoleErrorf("No scope name specified, use -n");
+		return;
+	}
+
+	if (Profiler::RemoveScopeHistogram(scopeName))
+	{
+		ConsolePrintf(Rgba::GREEN, "Stopped keeping percentiles for scope \"%s\".", scopeName.c_str());
+	}
+	else
+	{
+		ConsoleErrorf("Scope \"%s\" isn't kept.", scopeName.c_str());
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Clears the frame and scope histograms
+//
+void Command_ProfilerHistogramClear(Command& cmd)
+{
+	UNUSED(cmd);
+
+	Profiler::ClearHistograms();
+	ConsolePrintf(Rgba::GREEN, "Profiler histograms cleared.");
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the hitch threshold, in milliseconds
+//
+void Command_ProfilerHitchThreshold(Command& cmd)
+{
+	float thresholdMilliseconds = PROFILER_DEFAULT_HITCH_THRESHOLD_MS;
+	cmd.GetParam("t", thresholdMilliseconds, &thresholdMilliseconds);
+
+	Profiler::SetHitchThreshold(thresholdMilliseconds);
+	ConsolePrintf(Rgba::GREEN, "Frames and scopes over %.2f ms now count as hitches.", thresholdMilliseconds);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Prints each counter's count during the last completed frame
+//
+void Command_ProfilerCounters(Command& cmd)
+{
+	UNUSED(cmd);
+
+	int counterCount = ProfileCounters::GetCounterCount();
+	for (int counterIndex = 0; counterIndex < counterCount; ++counterIndex)
+	{
+		ConsolePrintf(Rgba::GREEN, "%-*s %llu", 24, ProfileCounters::GetCounterName(counterIndex), ProfileCounters::GetLastFrameValue(counterIndex));
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Enables or disables hitch captures, toggling them if not specified
+//
+void Command_ProfilerHitchCapture(Command& cmd)
+{
+	bool isEnabled = !Profiler::IsHitchCaptureEnabled();
+	cmd.GetParam("e", isEnabled, &isEnabled);
+
+	Profiler::SetHitchCaptureEnabled(isEnabled);
+
+	if (isEnabled)
+	{
+		ConsolePrintf(Rgba::GREEN, "Frames over %.2f ms will write a trace of the frames around them to Data/Logs.", Profiler::GetHitchThreshold());
+	}
+	else
+	{
+		ConsolePrintf(Rgba::GREEN, "Hitch captures disabled.");
+	}
+}
+
+
 #else // If not defined, put empty stubs for all functions
 
 Profiler::Profiler() {}
@@ -1288,7 +2753,36 @@ void				Profiler::ProcessKeyboardInput() {}
 void				Profiler::Render() {}
 void				Profiler::EndFrame() {}											
 void				Profiler::PushMeasurement(const char* name) {}
+void				Profiler::PushMeasurement(uint16_t scopeId) {}
 void				Profiler::PopMeasurement() {}
+void				Profiler::RegisterThisThread(const char* threadName) {}
+void				Profiler::RecordMarker(const char* name, uint32_t value /*= 0*/) {}
+void				Profiler::BeginAsyncMeasurement(const char* name, uint32_t id) {}
+void				Profiler::EndAsyncMeasurement(const char* name, uint32_t id) {}
+int					Profiler::RegisterTimeline(const char* timelineName) { return -1; }
+void				Profiler::PushTimelineMeasurement(int timelineIndex, const char* name, uint64_t startHPC) {}
+void				Profiler::PopTimelineMeasurement(int timelineIndex, uint64_t endHPC) {}
+bool				Profiler::ExportTrace(const std::string& filePath, int frameCount /*= PROFILER_MAX_REPORT_COUNT*/) { return false; }
+bool				Profiler::BeginTraceCapture(const std::string& filePath) { return false; }
+void				Profiler::EndTraceCapture() {}
+bool				Profiler::IsCapturingTrace() { return false; }
+ProfileReport*		Profiler::CreateReportForFrame(int age, eReportType reportType, eSortOrder sortOrder) { return nullptr; }
+void				Profiler::SetRemoteView(bool isViewingRemote) {}
+bool				Profiler::IsViewingRemote() { return false; }
+void				Profiler::PushRemoteReport(ProfileReport* report) { delete report; }
+bool				Profiler::AddScopeHistogram(const std::string& scopeName) { return false; }
+bool				Profiler::RemoveScopeHistogram(const std::string& scopeName) { return false; }
+void				Profiler::ClearHistograms() {}
+void				Profiler::SetHitchThreshold(float milliseconds) {}
+float				Profiler::GetHitchThreshold() { return 0.f; }
+void				Profiler::GetHistograms(std::vector<const ProfileHistogram*>& out_histograms) {}
+void				Profiler::SetHitchCaptureEnabled(bool isEnabled) {}
+bool				Profiler::IsHitchCaptureEnabled() { return false; }
+ProfileEventBuffer*	Profiler::GetEventBufferForThisThread() { return nullptr; }
+ProfileEventBuffer*	Profiler::CreateEventBuffer(const std::string& threadName, int* out_bufferIndex /*= nullptr*/) { return nullptr; }
+void				Profiler::RecordFrameBoundary() {}
+const ProfileFrame_t* Profiler::GetCompletedFrame(int age) const { return nullptr; }
+ProfileMeasurement*	Profiler::BuildStackForThread(const ProfileFrame_t& frame, int threadIndex) const { return nullptr; }
 void				Profiler::SetGeneratingReportType(eReportType reportType) {}
 void				Profiler::Show() {}
 void				Profiler::Hide() {}
@@ -1299,14 +2793,23 @@ bool				Profiler::IsProfilerOpen() { return false; }
 Profiler*			Profiler::GetInstance() { return nullptr; }
 float				Profiler::GetAverageTotalTime(int startIndex, int endIndex) const { return 0.f; }
 ProfileReport*		Profiler::GetAccumulatedReport(int firstIndex, int secondIndex) const { return nullptr; }
-void				Profiler::AddEntryInfoRecursive(ProfileReportEntry* sourceEntry, ProfileReportEntry* destinationEntry) const {}
-ProfileReport*		Profiler::BuildReportForFrame(ProfileMeasurement* stack) { return nullptr; }
+ProfileReport*		Profiler::GetSelectionReport() const { return nullptr; }
+ProfileReport*		Profiler::BuildReportForFrame(const ProfileFrame_t& frame, eReportType reportType, eSortOrder sortOrder) { return nullptr; }
 void				Profiler::PushReport(ProfileReport* report) {}
+void				Profiler::ClearReports() {}
+void				Profiler::AddEntryToScopeTotals(const ProfileReportEntry* entry, int parentPathIndex, std::vector<ProfileScopeTotals_t>& totals) {}
+int					Profiler::GetOrCreateScopePathIndex(int parentPathIndex, const std::string& name) { return -1; }
+void				Profiler::UpdateFramesPerSecond(float frameSeconds) {}
+void				Profiler::UpdateScopeHistograms(const ProfileFrame_t& frame) {}
+void				Profiler::UpdateHitchCapture(const ProfileFrame_t& frame) {}
+void				Profiler::WriteHitchCapture() {}
 void				Profiler::FlushReports() {} 
 void				Profiler::RenderTitleInfo() const {}
 void				Profiler::RenderGraph() const {}
 void				Profiler::RenderData() const {}
 void				Profiler::RecursivelyPrintEntry(unsigned int indent, AABB2& drawBounds, ProfileReportEntry* entry) const {}
+void				Profiler::RenderMemoryData() const {}
+void				Profiler::RenderCounterData() const {}
 
 #pragma warning(pop)
 #endif // PROFILING_ENABLED
\ No newline at end of file
@@ -5,17 +5,70 @@
 /* Description: Class to represent a profile result for a single frame
 /************************************************************************/
 #pragma once
+#include <mutex>
+#include <atomic>
+#include <string>
 #include <vector>
+#include <stdint.h>
+#include <unordered_map>
 #include "Engine/Core/Rgba.hpp"
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Core/Time/ProfileReport.hpp"
+#include "Engine/Core/Time/ProfileCounters.hpp"
 
 #define PROFILER_MAX_REPORT_COUNT (128)
+#define PROFILER_MAX_THREAD_COUNT (32)
+#define PROFILER_HISTOGRAM_WINDOW_SIZE (3600)			// Frames, a minute at 60hz
+#define PROFILER_MAX_SCOPE_HISTOGRAMS (16)
+#define PROFILER_DEFAULT_HITCH_THRESHOLD_MS (33.3f)		// Two frames at 60hz
+#define PROFILER_HITCH_CAPTURE_FRAMES_BEFORE (90)		// Frames written before and after a hitching frame, from the history
+#define PROFILER_HITCH_CAPTURE_FRAMES_AFTER (30)
+#define PROFILER_HITCH_CAPTURE_COOLDOWN_SECONDS (10.0)	// So a run of hitches only writes one capture
+#define PROFILER_MAX_LOG_MESSAGES (256)					// Most recent log messages kept for hitch captures
 
 class Gif;
 class Mesh;
 class MaterialInstance;
 class ProfileMeasurement;
+class ProfileHistogram;
+class ProfileEventBuffer;
+class ProfileTraceWriter;
+
+// Where each thread's events for a frame are, so its measurements can be rebuilt when needed
+struct ProfileFrame_t
+{
+	int			frameNumber = -1;
+	uint64_t	startHPC = 0;
+	uint64_t	endHPC = 0;
+	int			threadCount = 0;
+	uint64_t	threadEventStarts[PROFILER_MAX_THREAD_COUNT];
+	uint64_t	threadEventEnds[PROFILER_MAX_THREAD_COUNT];
+	uint64_t	counterValues[PROFILER_MAX_COUNTERS];		// Counts during the frame, indexed like ProfileCounters
+};
+
+// A scope where it sits in the reports, under its parent's path - the same name under two parents is two paths
+struct ProfileScopePath_t
+{
+	int			parentIndex = -1;		// -1 for the report's root
+	std::string	name;
+};
+
+// Sums of a scope path's entries over every report pushed so far
+struct ProfileScopeTotals_t
+{
+	uint64_t	callCount = 0;
+	uint64_t	totalTime = 0;
+	uint64_t	selfTime = 0;
+};
+
+// What the data view shows, cycled through with 'T'
+enum eProfilerTab
+{
+	PROFILER_TAB_CPU,
+	PROFILER_TAB_MEMORY,
+	PROFILER_TAB_COUNTERS,
+	NUM_PROFILER_TABS
+};
 
 class Profiler
 {
@@ -39,8 +92,19 @@ public:
 	static void									EndFrame();
 												
 	// Mutators											
-	static void									PushMeasurement(const char* name);
+	static void									PushMeasurement(const char* name);	// Looks the name up each time, PROFILE_SCOPE registers it once
+	static void									PushMeasurement(uint16_t scopeId);
 	static void									PopMeasurement();
+	static void									RegisterThisThread(const char* threadName); // Optional, names the thread in reports
+	static void									RecordMarker(const char* name, uint32_t value = 0);
+	static void									BeginAsyncMeasurement(const char* name, uint32_t id); // May end on a different thread, only shows in traces
+	static void									EndAsyncMeasurement(const char* name, uint32_t id);
+
+	// Timelines are tracks for times measured elsewhere and reported later (e.g. GPU timer queries),
+	// each written by one thread at a time in time order; returns -1 if there's no room for one
+	static int									RegisterTimeline(const char* timelineName);
+	static void									PushTimelineMeasurement(int timelineIndex, const char* name, uint64_t startHPC);
+	static void									PopTimelineMeasurement(int timelineIndex, uint64_t endHPC);
 	static void									SetGeneratingReportType(eReportType reportType);
 	static void									SetReportSortingOrder(eSortOrder order);
 
@@ -58,10 +122,37 @@ public:
 
 	// Producers
 	float										GetAverageTotalTime(int startIndex, int endIndex) const;
-	ProfileReport*								GetAccumulatedReport(int firstIndex, int secondIndex) const;
-	void											AddEntryInfoRecursive(ProfileReportEntry* sourceEntry, ProfileReportEntry* destinationEntry) const;
+	ProfileReport*								GetAccumulatedReport(int firstIndex, int secondIndex) const; // Owned by the caller
 	void										WriteHistoryAverageToLog() const;
 
+	// Chrome Trace Event JSON export, of the frames in the history or streamed for as long as a capture runs
+	static bool									ExportTrace(const std::string& filePath, int frameCount = PROFILER_MAX_REPORT_COUNT);
+	static bool									BeginTraceCapture(const std::string& filePath);
+	static void									EndTraceCapture();
+	static bool									IsCapturingTrace();
+
+	// Reports for frames in the history, owned by the caller; nullptr if the frame's events are gone
+	static ProfileReport*						CreateReportForFrame(int age, eReportType reportType, eSortOrder sortOrder);
+
+	// Frame times, and the times of scopes added by name, are kept for PROFILER_HISTOGRAM_WINDOW_SIZE
+	// frames whether or not the profiler is open; a scope's time is its total for the frame, over all threads
+	static bool									AddScopeHistogram(const std::string& scopeName);
+	static bool									RemoveScopeHistogram(const std::string& scopeName);
+	static void									ClearHistograms();
+	static void									SetHitchThreshold(float milliseconds);
+	static float								GetHitchThreshold();
+	static void									GetHistograms(std::vector<const ProfileHistogram*>& out_histograms); // The frame's first
+
+	// While enabled, a frame over the hitch threshold writes a trace of the frames around it, with the
+	// log messages from that time, to Data/Logs once the frames after it have completed
+	static void									SetHitchCaptureEnabled(bool isEnabled);
+	static bool									IsHitchCaptureEnabled();
+
+	// Remote view shows reports received from another process instead of this one's frames
+	static void									SetRemoteView(bool isViewingRemote);
+	static bool									IsViewingRemote();
+	static void									PushRemoteReport(ProfileReport* report); // Takes ownership
+
 
 private:
 	//-----Private Methods-----
@@ -71,10 +162,26 @@ private:
 	~Profiler();
 	Profiler(const Profiler& copy) = delete;
 
-	static ProfileReport*						BuildReportForFrame(ProfileMeasurement* stack);
+	// Capture
+	static ProfileEventBuffer*					GetEventBufferForThisThread();
+	ProfileEventBuffer*							CreateEventBuffer(const std::string& threadName, int* out_bufferIndex = nullptr);
+	void										RecordFrameBoundary();
+	const ProfileFrame_t*						GetCompletedFrame(int age) const;
+
+	// Lazily rebuilding measurements and reports from the capture
+	ProfileMeasurement*							BuildStackForThread(const ProfileFrame_t& frame, int threadIndex) const;
+	static ProfileReport*						BuildReportForFrame(const ProfileFrame_t& frame, eReportType reportType, eSortOrder sortOrder);
 	void										PushReport(ProfileReport* report);
+	void										ClearReports();
+	void										AddEntryToScopeTotals(const ProfileReportEntry* entry, int parentPathIndex, std::vector<ProfileScopeTotals_t>& totals);
+	int											GetOrCreateScopePathIndex(int parentPathIndex, const std::string& name);
+	ProfileReport*								GetSelectionReport() const;
+	void										UpdateFramesPerSecond(float frameSeconds);
+	void										UpdateScopeHistograms(const ProfileFrame_t& frame);
+	void										UpdateHitchCapture(const ProfileFrame_t& frame);
+	void										WriteHitchCapture();
 
-	void										FlushReports(); // Used when we need to regenerate all the reports at once, for starting generation or switching types
+	void										FlushReports(); // Used when we need to regenerate all the reports at once, for starting generation or switching types - not for sorting
 
 
 	// UI Rendering
@@ -82,22 +189,64 @@ private:
 	void										RenderGraph() const;
 	void										RenderData() const;
 	void											RecursivelyPrintEntry(unsigned int indent, AABB2& drawBounds, ProfileReportEntry* entry) const;
+	void										RenderMemoryData() const;
+	void										RenderCounterData() const;
 
 
 private:
 	//-----Private Data-----
 
-	// Stacks, used for measuring, 0 is always the latest one
-	ProfileMeasurement*		m_measurements[PROFILER_MAX_REPORT_COUNT];
+	// Capture, one event buffer per thread that's profiled, 0 is the main thread
+	ProfileEventBuffer*		m_threadBuffers[PROFILER_MAX_THREAD_COUNT];
+	std::atomic<int>		m_threadBufferCount;
+	std::mutex				m_threadRegistrationLock;
+
+	// Frame history, a ring with m_frameHistoryHead at the most recently completed frame
+	ProfileFrame_t			m_currentFrame;
+	ProfileFrame_t			m_frameHistory[PROFILER_MAX_REPORT_COUNT];
+	int						m_frameHistoryHead;
+	int						m_frameHistoryCount;
+	bool					m_isFrameOpen;
+
+	// Streamed each frame while a trace capture is running
+	ProfileTraceWriter*		m_traceCapture;
+
+	// Percentiles over a longer history than the reports
+	ProfileHistogram*		m_frameHistogram;
+	ProfileHistogram*		m_scopeHistograms[PROFILER_MAX_SCOPE_HISTOGRAMS];
+	int						m_scopeHistogramCount;
+	float					m_hitchThresholdMilliseconds;
+
+	// Hitch capture
+	bool					m_isHitchCaptureEnabled;
+	int						m_hitchCaptureFrameNumber;			// The frame that hitched, -1 if no capture is pending
+	float					m_hitchCaptureMilliseconds;
+	int						m_hitchCaptureFramesRemaining;		// Frames still to complete before it's written
+	uint64_t				m_nextHitchCaptureHPC;
 
 	// Reports, 0 is always the latest
 	eReportType				m_generatingReportType;
 	eSortOrder				m_reportSortOrder;
-	ProfileReport*			m_reports[PROFILER_MAX_REPORT_COUNT]; // Parallel array to measurement, but LAGS BEHIND ONE FRAME (report at 0 is measurement 1)
+	ProfileReport*			m_reports[PROFILER_MAX_REPORT_COUNT]; // Parallel to the frame history, so report 0 is the last completed frame
+
+	// Running totals of every scope path as of each push, so a range of reports is accumulated from
+	// the totals at its two ends instead of merging every report in it
+	std::vector<ProfileScopePath_t>		m_scopePaths;			// Parents always come before their children
+	std::unordered_map<uint64_t, int>	m_scopePathIndices;		// By the parent's index and the name's StringID
+	std::vector<ProfileScopeTotals_t>	m_scopeTotals[PROFILER_MAX_REPORT_COUNT + 1]; // Ring by push count, indexed by path
+	uint64_t							m_pushedReportCount;
+
+	// The graph selection's accumulated report, only rebuilt when the selection or the reports change
+	mutable ProfileReport*				m_selectionReport;
+	mutable uint64_t					m_selectionReportPushCount;
+	mutable int							m_selectionReportFirstIndex;
+	mutable int							m_selectionReportSecondIndex;
 
 	// State
 	bool					m_isOpen;
 	bool					m_isPaused;
+	bool					m_isViewingRemote;
+	eProfilerTab			m_currentTab;
 	int						m_currentFrameNumber;
 	float					m_framesPerSecond;
 
@@ -15,13 +15,8 @@ TODO("Pause stopwatch");
 // Constructor, refers to the master clock of nullptr is passed
 //
 Stopwatch::Stopwatch(Clock* referenceClock)
-	: m_referenceClock(referenceClock)
 {
-	if (m_referenceClock == nullptr)
-	{
-		m_referenceClock = Clock::GetMasterClock();
-	}
-
+	SetClock(referenceClock);
 	Reset();
 }
 
@@ -31,7 +26,7 @@ Stopwatch::Stopwatch(Clock* referenceClock)
 //
 Stopwatch::Stopwatch()
 {
-	m_referenceClock = Clock::GetMasterClock();
+	m_referenceClockID = Clock::GetMasterClock()->GetID();
 
 	Reset();
 }
@@ -42,7 +37,7 @@ Stopwatch::Stopwatch()
 //
 void Stopwatch::Reset()
 {
-	m_startHPC = m_referenceClock->GetTotalHPC();
+	m_startHPC = Clock::GetTotalHPCForClock(m_referenceClockID);
 	m_endHPC = m_startHPC;
 }
 
@@ -52,12 +47,12 @@ void Stopwatch::Reset()
 //
 void Stopwatch::SetClock(Clock* clock)
 {
-	m_referenceClock = clock;
-
-	if (m_referenceClock == nullptr)
+	if (clock == nullptr)
 	{
-		m_referenceClock = Clock::GetMasterClock();
+		clock = Clock::GetMasterClock();
 	}
+
+	m_referenceClockID = clock->GetID();
 }
 
 
@@ -67,7 +62,7 @@ void Stopwatch::SetClock(Clock* clock)
 void Stopwatch::SetInterval(float seconds)
 {
 	uint64_t interval = TimeSystem::SecondsToPerformanceCount(seconds);
-	m_startHPC = m_referenceClock->GetTotalHPC();
+	m_startHPC = Clock::GetTotalHPCForClock(m_referenceClockID);
 	m_endHPC = m_startHPC + interval;
 }
 
@@ -81,7 +76,7 @@ void Stopwatch::SetElapsedTime(float secondsElapsed)
 	uint64_t intervalLength = m_endHPC - m_startHPC;
 
 	uint64_t elapsedHPC = TimeSystem::SecondsToPerformanceCount(secondsElapsed);
-	uint64_t currentHPC = m_referenceClock->GetTotalHPC();
+	uint64_t currentHPC = Clock::GetTotalHPCForClock(m_referenceClockID);
 
 	m_startHPC = currentHPC - elapsedHPC;
 	m_endHPC = m_startHPC + intervalLength;
@@ -129,7 +124,7 @@ bool Stopwatch::DecrementByIntervalOnce()
 //
 int Stopwatch::DecrementByIntervalAll()
 {
-	uint64_t currentHPC = m_referenceClock->GetTotalHPC();
+	uint64_t currentHPC = Clock::GetTotalHPCForClock(m_referenceClockID);
 	uint64_t interval = m_endHPC - m_startHPC;
 
 	int numElapses = 0;
@@ -149,7 +144,7 @@ int Stopwatch::DecrementByIntervalAll()
 //
 float Stopwatch::GetElapsedTime() const
 {
-	uint64_t currentHPC = m_referenceClock->GetTotalHPC();
+	uint64_t currentHPC = Clock::GetTotalHPCForClock(m_referenceClockID);
 	uint64_t elapsedHPC = currentHPC - m_startHPC;
 
 	return (float) TimeSystem::PerformanceCountToSeconds(elapsedHPC);
@@ -174,7 +169,7 @@ float Stopwatch::GetElapsedTimeNormalized() const
 //
 float Stopwatch::GetTimeUntilIntervalEnds() const
 {
-	uint64_t currentHPC = m_referenceClock->GetTotalHPC();
+	uint64_t currentHPC = Clock::GetTotalHPCForClock(m_referenceClockID);
 
 	float endSeconds = (float) TimeSystem::PerformanceCountToSeconds(m_endHPC);
 	float currentSeconds = (float) TimeSystem::PerformanceCountToSeconds(currentHPC);
@@ -192,7 +187,7 @@ float Stopwatch::GetTimeUntilIntervalEnds() const
 //
 bool Stopwatch::HasIntervalElapsed() const
 {
-	uint64_t currentHPC = m_referenceClock->GetTotalHPC();
+	uint64_t currentHPC = Clock::GetTotalHPCForClock(m_referenceClockID);
 	
 	return (currentHPC >= m_endHPC);
 }
@@ -203,7 +198,7 @@ bool Stopwatch::HasIntervalElapsed() const
 //
 float Stopwatch::GetTotalSeconds() const
 {
-	return m_referenceClock->GetTotalSeconds();
+	return Clock::GetTotalSecondsForClock(m_referenceClockID);
 }
 
 
@@ -212,5 +207,5 @@ float Stopwatch::GetTotalSeconds() const
 //
 float Stopwatch::GetDeltaSeconds() const
 {
-	return m_referenceClock->GetDeltaTime();
+	return Clock::GetDeltaTimeForClock(m_referenceClockID);
 }
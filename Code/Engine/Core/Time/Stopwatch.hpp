@@ -6,9 +6,9 @@
 /************************************************************************/
 #pragma once
 #include <stdint.h>
+#include "Engine/Core/Time/Clock.hpp"
 
-class Clock;
-
+// Value type - keeps the clock's ID rather than a pointer, so stopwatches can be members instead of allocated
 class Stopwatch
 {
 public:
@@ -39,7 +39,7 @@ public:
 private:
 	//-----Private Data-----
 
-	Clock* m_referenceClock = nullptr;
+	ClockID m_referenceClockID = INVALID_CLOCK_ID;
 
 	uint64_t m_startHPC;
 	uint64_t m_endHPC;
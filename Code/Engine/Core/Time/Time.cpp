@@ -8,6 +8,7 @@
 #include <Windows.h>
 #include "Engine/Core/Time/Time.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Threading/Threading.hpp"
 
 // Singleton TimeSystem instance
 TimeSystem TimeSystem::s_timeSystem;
@@ -70,6 +71,34 @@ uint64_t GetPerformanceCounter()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Blocks until the HPC reaches the target, sleeping for most of the wait and spinning for the end
+// Sleeps are only accurate to the timer resolution, so callers waiting often should raise it to 1ms
+//
+void WaitUntilPerformanceCounter(uint64_t targetHPC)
+{
+	uint64_t spinHPC = TimeSystem::SecondsToPerformanceCount(TIME_WAIT_SPIN_SECONDS);
+	uint64_t currentHPC = GetPerformanceCounter();
+
+	while (currentHPC < targetHPC)
+	{
+		uint64_t remainingHPC = targetHPC - currentHPC;
+
+		if (remainingHPC > spinHPC)
+		{
+			unsigned int sleepMs = (unsigned int) (TimeSystem::PerformanceCountToSeconds(remainingHPC - spinHPC) * 1000.0);
+			Thread::SleepThisThreadFor(sleepMs > 0 ? sleepMs : 1);
+		}
+		else
+		{
+			Thread::YieldThisThread();
+		}
+
+		currentHPC = GetPerformanceCounter();
+	}
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the data in time in the format MONTH_DAY_YEAR_HOUR_MINUTE_SECOND
 //
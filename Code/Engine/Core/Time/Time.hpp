@@ -8,6 +8,9 @@
 #include <stdint.h>
 #include <string>
 
+// WaitUntilPerformanceCounter() sleeps until this close to the target, then spins
+#define TIME_WAIT_SPIN_SECONDS (0.002)
+
 class TimeSystem
 {
 public:
@@ -55,5 +58,6 @@ private:
 //--------------------------------C FUNCTIONS-------------------------------------
 
 uint64_t	GetPerformanceCounter();
+void		WaitUntilPerformanceCounter(uint64_t targetHPC);	// Sleep() overshoots, so the end of the wait spins
 std::string GetFormattedSystemDateAndTime();
 std::string GetFormattedSystemTime();
\ No newline at end of file
@@ -0,0 +1,257 @@
+/************************************************************************/
+/* File: Compression.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the LZ block compressor
+/************************************************************************/
+#include "Engine/Core/Utility/Compression.hpp"
+#include <string.h>
+
+#define LZ_MIN_MATCH (4)
+#define LZ_MAX_OFFSET (0xffff)
+#define LZ_HASH_BITS (12)
+#define LZ_TOKEN_MAX_LENGTH (15)
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the 4 bytes at the given location, unaligned
+//
+static uint32_t ReadUInt32(const uint8_t* location)
+{
+	uint32_t value;
+	memcpy(&value, location, sizeof(uint32_t));
+
+	return value;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the hash table slot for the 4 byte sequence
+//
+static uint32_t HashSequence(uint32_t sequence)
+{
+	return (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Writes the part of a length past the token's 15, as 255s and a remainder
+//
+static bool WriteExtraLengthBytes(size_t length, uint8_t* destination, size_t destinationCapacity, size_t& writeIndex)
+{
+	while (length >= 255)
+	{
+		if (writeIndex >= destinationCapacity)
+		{
+			return false;
+		}
+
+		destination[writeIndex++] = 255;
+		length -= 255;
+	}
+
+	if (writeIndex >= destinationCapacity)
+	{
+		return false;
+	}
+
+	destination[writeIndex++] = (uint8_t) length;
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Reads the extra length bytes that follow a token length of 15, adding them to the length
+//
+static bool ReadExtraLengthBytes(const uint8_t* source, size_t sourceSize, size_t& readIndex, size_t& length)
+{
+	uint8_t lengthByte;
+
+	do
+	{
+		if (readIndex >= sourceSize)
+		{
+			return false;
+		}
+
+		lengthByte = source[readIndex++];
+		length += lengthByte;
+
+	} while (lengthByte == 255);
+
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Writes one sequence, a matchLength of 0 being the literals only last sequence
+//
+static bool WriteSequence(const uint8_t* literals, size_t literalCount, size_t matchLength, size_t offset, uint8_t* destination, size_t destinationCapacity, size_t& writeIndex)
+{
+	if (writeIndex >= destinationCapacity)
+	{
+		return false;
+	}
+
+	size_t tokenIndex = writeIndex++;
+	uint8_t token = (uint8_t) ((literalCount >= LZ_TOKEN_MAX_LENGTH ? LZ_TOKEN_MAX_LENGTH : literalCount) << 4);
+
+	if (literalCount >= LZ_TOKEN_MAX_LENGTH && !WriteExtraLengthBytes(literalCount - LZ_TOKEN_MAX_LENGTH, destination, destinationCapacity, writeIndex))
+	{
+		return false;
+	}
+
+	if (literalCount > destinationCapacity - writeIndex)
+	{
+		return false;
+	}
+
+	memcpy(destination + writeIndex, literals, literalCount);
+	writeIndex += literalCount;
+
+	if (matchLength > 0)
+	{
+		if (destinationCapacity - writeIndex < 2)
+		{
+			return false;
+		}
+
+		destination[writeIndex++] = (uint8_t) (offset & 0xff);
+		destination[writeIndex++] = (uint8_t) (offset >> 8);
+
+		size_t matchCode = matchLength - LZ_MIN_MATCH;
+		token |= (uint8_t) (matchCode >= LZ_TOKEN_MAX_LENGTH ? LZ_TOKEN_MAX_LENGTH : matchCode);
+
+		if (matchCode >= LZ_TOKEN_MAX_LENGTH && !WriteExtraLengthBytes(matchCode - LZ_TOKEN_MAX_LENGTH, destination, destinationCapacity, writeIndex))
+		{
+			return false;
+		}
+	}
+
+	destination[tokenIndex] = token;
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Compresses the source with greedy matches found through a hash of the last position each 4 byte
+// sequence was seen at
+//
+size_t LZCompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationCapacity)
+{
+	int lastPositions[1 << LZ_HASH_BITS];
+	memset(lastPositions, 0xff, sizeof(lastPositions));
+
+	size_t writeIndex = 0;
+	size_t literalStart = 0;
+	size_t position = 0;
+
+	while (position + LZ_MIN_MATCH <= sourceSize)
+	{
+		uint32_t sequence = ReadUInt32(source + position);
+		uint32_t hash = HashSequence(sequence);
+
+		int candidate = lastPositions[hash];
+		lastPositions[hash] = (int) position;
+
+		if (candidate < 0 || position - (size_t) candidate > LZ_MAX_OFFSET || ReadUInt32(source + candidate) != sequence)
+		{
+			++position;
+			continue;
+		}
+
+		// Matches may run into the bytes they produce, the decompressor copies forward a byte at a time
+		size_t matchLength = LZ_MIN_MATCH;
+		while (position + matchLength < sourceSize && source[candidate + matchLength] == source[position + matchLength])
+		{
+			++matchLength;
+		}
+
+		if (!WriteSequence(source + literalStart, position - literalStart, matchLength, position - (size_t) candidate, destination, destinationCapacity, writeIndex))
+		{
+			return 0;
+		}
+
+		position += matchLength;
+		literalStart = position;
+	}
+
+	if (!WriteSequence(source + literalStart, sourceSize - literalStart, 0, 0, destination, destinationCapacity, writeIndex))
+	{
+		return 0;
+	}
+
+	return writeIndex;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Decompresses a block made by LZCompress()
+//
+bool LZDecompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t decompressedSize)
+{
+	size_t readIndex = 0;
+	size_t writeIndex = 0;
+
+	while (readIndex < sourceSize)
+	{
+		uint8_t token = source[readIndex++];
+
+		// Literals
+		size_t literalCount = (token >> 4);
+		if (literalCount == LZ_TOKEN_MAX_LENGTH && !ReadExtraLengthBytes(source, sourceSize, readIndex, literalCount))
+		{
+			return false;
+		}
+
+		if (literalCount > sourceSize - readIndex || literalCount > decompressedSize - writeIndex)
+		{
+			return false;
+		}
+
+		memcpy(destination + writeIndex, source + readIndex, literalCount);
+		readIndex += literalCount;
+		writeIndex += literalCount;
+
+		// The last sequence has no match
+		if (readIndex == sourceSize)
+		{
+			break;
+		}
+
+		// Match
+		if (sourceSize - readIndex < 2)
+		{
+			return false;
+		}
+
+		size_t offset = (size_t) source[readIndex] | ((size_t) source[readIndex + 1] << 8);
+		readIndex += 2;
+
+		if (offset == 0 || offset > writeIndex)
+		{
+			return false;
+		}
+
+		size_t matchLength = (token & LZ_TOKEN_MAX_LENGTH);
+		if (matchLength == LZ_TOKEN_MAX_LENGTH && !ReadExtraLengthBytes(source, sourceSize, readIndex, matchLength))
+		{
+			return false;
+		}
+
+		matchLength += LZ_MIN_MATCH;
+
+		if (matchLength > decompressedSize - writeIndex)
+		{
+			return false;
+		}
+
+		for (size_t matchIndex = 0; matchIndex < matchLength; ++matchIndex)
+		{
+			destination[writeIndex] = destination[writeIndex - offset];
+			++writeIndex;
+		}
+	}
+
+	return (writeIndex == decompressedSize);
+}
@@ -0,0 +1,21 @@
+/************************************************************************/
+/* File: Compression.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Small LZ77 block compressor in the style of LZ4, for
+/*				buffers of up to 64KB
+/************************************************************************/
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// A block is a run of sequences of [token][literals][2 byte offset][match length], the token holding
+// 4 bits each of literal count and match length - 4, with 15 meaning more length bytes follow
+// The last sequence is literals only
+
+// Returns the compressed size, or 0 if it didn't fit in destinationCapacity
+size_t	LZCompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationCapacity);
+
+// Returns false if the block is malformed or doesn't decompress to exactly decompressedSize bytes,
+// never reading or writing out of bounds, so it's safe on untrusted data
+bool	LZDecompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t decompressedSize);
@@ -0,0 +1,917 @@
+/************************************************************************/
+/* File: GridPathfinder.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the GridPathfinder class
+/************************************************************************/
+#include "Engine/Core/Utility/GridPathfinder.hpp"
+#include "Engine/Core/Utility/HeatMap.hpp"
+#include "Engine/Core/Utility/StringUtils.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+#include "Engine/Core/JobSystem/ParallelFor.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <algorithm>
+#include <functional>
+
+// Border runs at least this long get a portal at each end instead of one in the middle, so paths
+// along a wide opening don't all funnel through its center
+#define GRID_PATH_LONG_PORTAL_RUN (6)
+
+// Requests each job of FindPaths() takes at a time
+#define GRID_PATH_BATCH_GRAIN_SIZE (8)
+
+#define GRID_PATH_UNREACHED_COST (3.402823466e+38F)
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+GridPathfinder::GridPathfinder(const HeatMap& costs, int clusterSize /*= GRID_PATH_DEFAULT_CLUSTER_SIZE*/)
+	: m_clusterSize(clusterSize)
+{
+	ASSERT_OR_DIE(clusterSize >= 0, Stringf("Error: GridPathfinder constructed with a negative cluster size, %i", clusterSize));
+	SetCosts(costs);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+GridPathfinder::~GridPathfinder()
+{
+	ASSERT_OR_DIE(m_freeScratches.size() == m_scratches.size(), "Error: GridPathfinder destroyed while finding a path");
+
+	for (int scratchIndex = 0; scratchIndex < (int) m_scratches.size(); ++scratchIndex)
+	{
+		delete m_scratches[scratchIndex];
+	}
+
+	m_scratches.clear();
+	m_freeScratches.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies the costs and rebuilds everything made from them
+//
+void GridPathfinder::SetCosts(const HeatMap& costs)
+{
+	m_dimensions = costs.GetDimensions();
+
+	int cellCount = (int) costs.GetCellCount();
+	m_costs.resize(cellCount);
+	m_minStepCost = GRID_PATH_BLOCKED_COST;
+
+	for (int cellIndex = 0; cellIndex < cellCount; ++cellIndex)
+	{
+		float cost = costs.GetHeat(cellIndex);
+		ASSERT_OR_DIE(cost >= 0.f, Stringf("Error: GridPathfinder given a negative cost, %.2f at cell %i", cost, cellIndex));
+
+		m_costs[cellIndex] = cost;
+		m_minStepCost = MinFloat(m_minStepCost, cost);
+	}
+
+	if (m_minStepCost >= GRID_PATH_BLOCKED_COST)
+	{
+		m_minStepCost = 0.f;	// Nothing is passable, so the estimate doesn't matter
+	}
+
+	BuildHierarchy();
+
+	m_cacheLock.lock();
+	for (int cacheIndex = 0; cacheIndex < GRID_PATH_CACHE_SIZE; ++cacheIndex)
+	{
+		m_cache[cacheIndex].isValid = false;
+		m_cache[cacheIndex].path.clear();
+	}
+	m_cacheLock.unlock();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds the path, through the hierarchy if the ends are far enough apart for it to be cheaper
+//
+bool GridPathfinder::FindPath(const IntVector2& start, const IntVector2& end, std::vector<IntVector2>& out_path)
+{
+	SearchScratch_t* scratch = AcquireScratch();
+	bool wasFound = FindPathWithScratch(*scratch, start, end, true, out_path);
+	ReleaseScratch(scratch);
+
+	return wasFound;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds the lowest cost path, searching the full grid
+//
+bool GridPathfinder::FindExactPath(const IntVector2& start, const IntVector2& end, std::vector<IntVector2>& out_path)
+{
+	SearchScratch_t* scratch = AcquireScratch();
+	bool wasFound = FindPathWithScratch(*scratch, start, end, false, out_path);
+	ReleaseScratch(scratch);
+
+	return wasFound;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds the paths of the batch in parallel, each job reusing one scratch for all of its requests
+//
+void GridPathfinder::FindPaths(std::vector<GridPathRequest_t>& requests)
+{
+	ParallelForRange(0, (int) requests.size(), GRID_PATH_BATCH_GRAIN_SIZE, [&](int rangeBegin, int rangeEnd)
+	{
+		SearchScratch_t* scratch = AcquireScratch();
+
+		for (int requestIndex = rangeBegin; requestIndex < rangeEnd; ++requestIndex)
+		{
+			GridPathRequest_t& request = requests[requestIndex];
+			request.wasFound = FindPathWithScratch(*scratch, request.start, request.end, true, request.path);
+		}
+
+		ReleaseScratch(scratch);
+	});
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the width x height of the grid
+//
+IntVector2 GridPathfinder::GetDimensions() const
+{
+	return m_dimensions;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the cells per side of the clusters, 0 if there's no hierarchy
+//
+int GridPathfinder::GetClusterSize() const
+{
+	return m_clusterSize;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of portal cells in the hierarchy
+//
+int GridPathfinder::GetPortalCount() const
+{
+	return (int) m_portalNodes.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of paths served from the cache since the costs were last set
+//
+unsigned int GridPathfinder::GetCacheHitCount() const
+{
+	return m_cacheHitCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of paths searched for since the costs were last set
+//
+unsigned int GridPathfinder::GetCacheMissCount() const
+{
+	return m_cacheMissCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Builds the portals on every cluster border and the costs between the portals of each cluster
+//
+void GridPathfinder::BuildHierarchy()
+{
+	m_portalNodes.clear();
+	m_portalEdges.clear();
+	m_clusterNodes.clear();
+	m_portalNodeByCell.clear();
+	m_clusterCounts = IntVector2::ZERO;
+
+	m_cacheHitCount = 0;
+	m_cacheMissCount = 0;
+
+	if (m_clusterSize == 0)
+	{
+		return;
+	}
+
+	m_clusterCounts = IntVector2((m_dimensions.x + m_clusterSize - 1) / m_clusterSize, (m_dimensions.y + m_clusterSize - 1) / m_clusterSize);
+	m_clusterNodes.resize(m_clusterCounts.x * m_clusterCounts.y);
+	m_portalNodeByCell.assign(m_costs.size(), -1);
+
+	std::vector<std::vector<PortalEdge_t>> nodeEdges;
+
+	// Portals between each cluster and the ones east and north of it, at each run of border cells
+	// passable on both sides
+	for (int clusterIndex = 0; clusterIndex < (int) m_clusterNodes.size(); ++clusterIndex)
+	{
+		IntVector2 clusterMins, clusterMaxs;
+		GetClusterBounds(clusterIndex, clusterMins, clusterMaxs);
+
+		if (clusterMaxs.x < m_dimensions.x)
+		{
+			int runLength = 0;
+			for (int yIndex = clusterMins.y; yIndex <= clusterMaxs.y; ++yIndex)
+			{
+				int cellIndex = yIndex * m_dimensions.x + (clusterMaxs.x - 1);
+				bool isOpen = (yIndex < clusterMaxs.y && IsPassable(cellIndex) && IsPassable(cellIndex + 1));
+
+				if (isOpen)
+				{
+					runLength++;
+				}
+				else if (runLength > 0)
+				{
+					AddPortalsAlongBorder(cellIndex - runLength * m_dimensions.x, 1, runLength, m_dimensions.x, nodeEdges);
+					runLength = 0;
+				}
+			}
+		}
+
+		if (clusterMaxs.y < m_dimensions.y)
+		{
+			int runLength = 0;
+			for (int xIndex = clusterMins.x; xIndex <= clusterMaxs.x; ++xIndex)
+			{
+				int cellIndex = (clusterMaxs.y - 1) * m_dimensions.x + xIndex;
+				bool isOpen = (xIndex < clusterMaxs.x && IsPassable(cellIndex) && IsPassable(cellIndex + m_dimensions.x));
+
+				if (isOpen)
+				{
+					runLength++;
+				}
+				else if (runLength > 0)
+				{
+					AddPortalsAlongBorder(cellIndex - runLength, m_dimensions.x, runLength, 1, nodeEdges);
+					runLength = 0;
+				}
+			}
+		}
+	}
+
+	// Costs between the portals of each cluster, only through the cluster
+	SearchScratch_t* scratch = AcquireScratch();
+
+	for (int clusterIndex = 0; clusterIndex < (int) m_clusterNodes.size(); ++clusterIndex)
+	{
+		IntVector2 clusterMins, clusterMaxs;
+		GetClusterBounds(clusterIndex, clusterMins, clusterMaxs);
+
+		const std::vector<int>& clusterNodes = m_clusterNodes[clusterIndex];
+		for (int fromIndex = 0; fromIndex < (int) clusterNodes.size(); ++fromIndex)
+		{
+			int fromNode = clusterNodes[fromIndex];
+			SearchCostsInRegion(*scratch, m_portalNodes[fromNode].cellIndex, clusterMins, clusterMaxs, false);
+
+			for (int toIndex = 0; toIndex < (int) clusterNodes.size(); ++toIndex)
+			{
+				int toNode = clusterNodes[toIndex];
+				float cost = GetSearchedCost(*scratch, m_portalNodes[toNode].cellIndex);
+
+				if (toNode != fromNode && cost < GRID_PATH_UNREACHED_COST)
+				{
+					PortalEdge_t edge;
+					edge.toNode = toNode;
+					edge.cost = cost;
+					nodeEdges[fromNode].push_back(edge);
+				}
+			}
+		}
+	}
+
+	ReleaseScratch(scratch);
+
+	// Flattened, so a search walks one array
+	for (int nodeIndex = 0; nodeIndex < (int) m_portalNodes.size(); ++nodeIndex)
+	{
+		m_portalNodes[nodeIndex].firstEdge = (int) m_portalEdges.size();
+		m_portalNodes[nodeIndex].edgeCount = (int) nodeEdges[nodeIndex].size();
+		m_portalEdges.insert(m_portalEdges.end(), nodeEdges[nodeIndex].begin(), nodeEdges[nodeIndex].end());
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the portal pairs for a run of open border cells, starting at cellIndex and continuing by
+// stepAlongBorder, each paired with the cell stepToNeighbor from it in the next cluster
+//
+void GridPathfinder::AddPortalsAlongBorder(int cellIndex, int stepToNeighbor, int runLength, int stepAlongBorder, std::vector<std::vector<PortalEdge_t>>& nodeEdges)
+{
+	int offsets[2] = { runLength / 2, -1 };
+	if (runLength >= GRID_PATH_LONG_PORTAL_RUN)
+	{
+		offsets[0] = 0;
+		offsets[1] = runLength - 1;
+	}
+
+	for (int offsetIndex = 0; offsetIndex < 2 && offsets[offsetIndex] >= 0; ++offsetIndex)
+	{
+		int nearCell = cellIndex + offsets[offsetIndex] * stepAlongBorder;
+		int farCell = nearCell + stepToNeighbor;
+
+		int nearNode = GetOrCreatePortalNode(nearCell, nodeEdges);
+		int farNode = GetOrCreatePortalNode(farCell, nodeEdges);
+
+		// Each way costs stepping onto the other cell
+		PortalEdge_t edge;
+		edge.toNode = farNode;
+		edge.cost = m_costs[farCell];
+		nodeEdges[nearNode].push_back(edge);
+
+		edge.toNode = nearNode;
+		edge.cost = m_costs[nearCell];
+		nodeEdges[farNode].push_back(edge);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the portal node of the cell, making it if the cell isn't a portal yet
+// Corner cells can be a portal for two borders, so they share the one node
+//
+int GridPathfinder::GetOrCreatePortalNode(int cellIndex, std::vector<std::vector<PortalEdge_t>>& nodeEdges)
+{
+	if (m_portalNodeByCell[cellIndex] >= 0)
+	{
+		return m_portalNodeByCell[cellIndex];
+	}
+
+	PortalNode_t node;
+	node.cellIndex = cellIndex;
+	node.clusterIndex = GetClusterIndex(cellIndex);
+
+	int nodeIndex = (int) m_portalNodes.size();
+	m_portalNodes.push_back(node);
+	m_clusterNodes[node.clusterIndex].push_back(nodeIndex);
+	m_portalNodeByCell[cellIndex] = nodeIndex;
+	nodeEdges.emplace_back();
+
+	return nodeIndex;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a free scratch sized for the grid and hierarchy, making one if all are in use
+//
+GridPathfinder::SearchScratch_t* GridPathfinder::AcquireScratch()
+{
+	SearchScratch_t* scratch = nullptr;
+
+	m_scratchLock.lock();
+	if (m_freeScratches.size() > 0)
+	{
+		scratch = m_freeScratches.back();
+		m_freeScratches.pop_back();
+	}
+	else
+	{
+		scratch = new SearchScratch_t();
+		m_scratches.push_back(scratch);
+	}
+	m_scratchLock.unlock();
+
+	// Only grows, new entries have a stamp of 0 which no search uses
+	if (scratch->cellCosts.size() < m_costs.size())
+	{
+		scratch->cellCosts.resize(m_costs.size());
+		scratch->cellCameFrom.resize(m_costs.size());
+		scratch->cellStamps.resize(m_costs.size(), 0);
+	}
+
+	size_t nodeCount = m_portalNodes.size() + 2;	// The start and end join the graph at the end for a search
+	if (scratch->nodeCosts.size() < nodeCount)
+	{
+		scratch->nodeCosts.resize(nodeCount);
+		scratch->nodeCameFrom.resize(nodeCount);
+		scratch->nodeStamps.resize(nodeCount, 0);
+	}
+
+	return scratch;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the scratch to be used by another search
+//
+void GridPathfinder::ReleaseScratch(SearchScratch_t* scratch)
+{
+	m_scratchLock.lock();
+	m_freeScratches.push_back(scratch);
+	m_scratchLock.unlock();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds the path with the given scratch, from the cache if it's there
+// Ends close enough to each other to not be worth the hierarchy search the full grid, as they'd
+// only cross a cluster or two anyway
+//
+bool GridPathfinder::FindPathWithScratch(SearchScratch_t& scratch, const IntVector2& start, const IntVector2& end, bool useHierarchy, std::vector<IntVector2>& out_path)
+{
+	out_path.clear();
+
+	bool areEndsValid = (start.x >= 0 && start.x < m_dimensions.x && start.y >= 0 && start.y < m_dimensions.y && end.x >= 0 && end.x < m_dimensions.x && end.y >= 0 && end.y < m_dimensions.y);
+	if (!areEndsValid)
+	{
+		return false;
+	}
+
+	int startIndex = start.y * m_dimensions.x + start.x;
+	int endIndex = end.y * m_dimensions.x + end.x;
+
+	if (!IsPassable(endIndex))
+	{
+		return false;
+	}
+
+	int distance = AbsoluteValue(end.x - start.x) + AbsoluteValue(end.y - start.y);
+	useHierarchy = (useHierarchy && m_clusterSize > 0 && distance >= 2 * m_clusterSize);
+
+	// Only the hierarchy's paths are cached, the full grid search is exact and is asked for as such
+	uint64_t cacheKey = ((uint64_t) startIndex << 32) | (uint64_t) endIndex;
+	if (useHierarchy && GetCachedPath(cacheKey, out_path))
+	{
+		return true;
+	}
+
+	out_path.push_back(start);
+
+	bool wasFound = false;
+	if (useHierarchy)
+	{
+		wasFound = FindPathInHierarchy(scratch, startIndex, endIndex, out_path);
+	}
+	else
+	{
+		wasFound = SearchCells(scratch, startIndex, endIndex, IntVector2::ZERO, m_dimensions, out_path);
+	}
+
+	if (!wasFound)
+	{
+		out_path.clear();
+		return false;
+	}
+
+	if (useHierarchy)
+	{
+		AddCachedPath(cacheKey, out_path);
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Joins the start and end to the portals of their clusters, A*s across the portal graph, then
+// refines each step of it back into cells; the path is near but not always exactly the cheapest
+//
+bool GridPathfinder::FindPathInHierarchy(SearchScratch_t& scratch, int startIndex, int endIndex, std::vector<IntVector2>& out_path)
+{
+	int startCluster = GetClusterIndex(startIndex);
+	int endCluster = GetClusterIndex(endIndex);
+	const std::vector<int>& startNodes = m_clusterNodes[startCluster];
+	const std::vector<int>& endNodes = m_clusterNodes[endCluster];
+
+	IntVector2 startMins, startMaxs, endMins, endMaxs;
+	GetClusterBounds(startCluster, startMins, startMaxs);
+	GetClusterBounds(endCluster, endMins, endMaxs);
+
+	// Costs from the start to its cluster's portals, and from the end cluster's portals to the end
+	SearchCostsInRegion(scratch, startIndex, startMins, startMaxs, false);
+	scratch.startNodeCosts.resize(startNodes.size());
+	for (int nodeIndex = 0; nodeIndex < (int) startNodes.size(); ++nodeIndex)
+	{
+		scratch.startNodeCosts[nodeIndex] = GetSearchedCost(scratch, m_portalNodes[startNodes[nodeIndex]].cellIndex);
+	}
+
+	SearchCostsInRegion(scratch, endIndex, endMins, endMaxs, true);
+	scratch.endNodeCosts.resize(endNodes.size());
+	for (int nodeIndex = 0; nodeIndex < (int) endNodes.size(); ++nodeIndex)
+	{
+		scratch.endNodeCosts[nodeIndex] = GetSearchedCost(scratch, m_portalNodes[endNodes[nodeIndex]].cellIndex);
+	}
+
+	// A* over the portals, with the start and end as the last two nodes
+	int startNode = (int) m_portalNodes.size();
+	int endNode = startNode + 1;
+
+	BeginNodeSearch(scratch);
+	std::vector<OpenEntry_t>& openList = scratch.openList;
+	std::greater<OpenEntry_t> compare;
+
+	auto relaxNode = [&](int nodeIndex, float costSoFar, int cameFrom)
+	{
+		if (scratch.nodeStamps[nodeIndex] == scratch.nodeStamp && scratch.nodeCosts[nodeIndex] <= costSoFar)
+		{
+			return;
+		}
+
+		scratch.nodeStamps[nodeIndex] = scratch.nodeStamp;
+		scratch.nodeCosts[nodeIndex] = costSoFar;
+		scratch.nodeCameFrom[nodeIndex] = cameFrom;
+
+		int cellIndex = (nodeIndex == endNode ? endIndex : m_portalNodes[nodeIndex].cellIndex);
+
+		OpenEntry_t entry;
+		entry.index = nodeIndex;
+		entry.costSoFar = costSoFar;
+		entry.priority = costSoFar + GetEstimate(cellIndex, endIndex);
+		openList.push_back(entry);
+		std::push_heap(openList.begin(), openList.end(), compare);
+	};
+
+	relaxNode(startNode, 0.f, -1);
+	bool wasFound = false;
+
+	while (openList.size() > 0)
+	{
+		std::pop_heap(openList.begin(), openList.end(), compare);
+		OpenEntry_t entry = openList.back();
+		openList.pop_back();
+
+		if (entry.costSoFar > scratch.nodeCosts[entry.index])
+		{
+			continue;
+		}
+
+		if (entry.index == endNode)
+		{
+			wasFound = true;
+			break;
+		}
+
+		if (entry.index == startNode)
+		{
+			for (int nodeIndex = 0; nodeIndex < (int) startNodes.size(); ++nodeIndex)
+			{
+				if (scratch.startNodeCosts[nodeIndex] < GRID_PATH_UNREACHED_COST)
+				{
+					relaxNode(startNodes[nodeIndex], scratch.startNodeCosts[nodeIndex], startNode);
+				}
+			}
+
+			continue;
+		}
+
+		const PortalNode_t& node = m_portalNodes[entry.index];
+		for (int edgeIndex = node.firstEdge; edgeIndex < node.firstEdge + node.edgeCount; ++edgeIndex)
+		{
+			const PortalEdge_t& edge = m_portalEdges[edgeIndex];
+			relaxNode(edge.toNode, entry.costSoFar + edge.cost, entry.index);
+		}
+
+		if (node.clusterIndex == endCluster)
+		{
+			int endNodeIndex = (int) (std::find(endNodes.begin(), endNodes.end(), entry.index) - endNodes.begin());
+			if (scratch.endNodeCosts[endNodeIndex] < GRID_PATH_UNREACHED_COST)
+			{
+				relaxNode(endNode, entry.costSoFar + scratch.endNodeCosts[endNodeIndex], entry.index);
+			}
+		}
+	}
+
+	openList.clear();
+
+	if (!wasFound)
+	{
+		return false;
+	}
+
+	scratch.abstractPath.clear();
+	for (int nodeIndex = endNode; nodeIndex != startNode; nodeIndex = scratch.nodeCameFrom[nodeIndex])
+	{
+		scratch.abstractPath.push_back(nodeIndex);
+	}
+	std::reverse(scratch.abstractPath.begin(), scratch.abstractPath.end());
+
+	// Refine each step - within a cluster it's searched, across a border it's the one step
+	int previousNode = startNode;
+	for (int pathIndex = 0; pathIndex < (int) scratch.abstractPath.size(); ++pathIndex)
+	{
+		int currNode = scratch.abstractPath[pathIndex];
+		int previousCell = (previousNode == startNode ? startIndex : m_portalNodes[previousNode].cellIndex);
+		int currCell = (currNode == endNode ? endIndex : m_portalNodes[currNode].cellIndex);
+
+		int previousCluster = GetClusterIndex(previousCell);
+		bool isInOneCluster = (previousCluster == GetClusterIndex(currCell));
+
+		if (isInOneCluster)
+		{
+			IntVector2 clusterMins, clusterMaxs;
+			GetClusterBounds(previousCluster, clusterMins, clusterMaxs);
+
+			if (!SearchCells(scratch, previousCell, currCell, clusterMins, clusterMaxs, out_path))
+			{
+				return false;
+			}
+		}
+		else
+		{
+			out_path.push_back(IntVector2(currCell % m_dimensions.x, currCell / m_dimensions.x));
+		}
+
+		previousNode = currNode;
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// A* with a binary heap of cells, skipping stale entries when they come out like the HeatMap solve
+// Appends the path after the start cell to out_path, and returns false if the end can't be reached
+//
+bool GridPathfinder::SearchCells(SearchScratch_t& scratch, int startIndex, int endIndex, const IntVector2& regionMins, const IntVector2& regionMaxs, std::vector<IntVector2>& out_path)
+{
+	BeginCellSearch(scratch);
+	std::vector<OpenEntry_t>& openList = scratch.openList;
+	std::greater<OpenEntry_t> compare;
+
+	scratch.cellStamps[startIndex] = scratch.cellStamp;
+	scratch.cellCosts[startIndex] = 0.f;
+	scratch.cellCameFrom[startIndex] = -1;
+
+	OpenEntry_t startEntry;
+	startEntry.index = startIndex;
+	startEntry.priority = GetEstimate(startIndex, endIndex);
+	openList.push_back(startEntry);
+
+	bool wasFound = false;
+
+	while (openList.size() > 0)
+	{
+		std::pop_heap(openList.begin(), openList.end(), compare);
+		OpenEntry_t entry = openList.back();
+		openList.pop_back();
+
+		int currIndex = entry.index;
+		if (entry.costSoFar > scratch.cellCosts[currIndex])
+		{
+			continue;
+		}
+
+		// The estimate never overestimates and drops by at most a step's cost, so the first time the end comes out it's the cheapest
+		if (currIndex == endIndex)
+		{
+			wasFound = true;
+			break;
+		}
+
+		int neighbors[4];
+		int neighborCount = GetNeighborsInRegion(currIndex, regionMins, regionMaxs, neighbors);
+
+		for (int neighborIndex = 0; neighborIndex < neighborCount; ++neighborIndex)
+		{
+			int neighbor = neighbors[neighborIndex];
+			if (!IsPassable(neighbor))
+			{
+				continue;
+			}
+
+			float newCost = entry.costSoFar + m_costs[neighbor];
+			bool isNew = (scratch.cellStamps[neighbor] != scratch.cellStamp);
+
+			if (isNew || newCost < scratch.cellCosts[neighbor])
+			{
+				scratch.cellStamps[neighbor] = scratch.cellStamp;
+				scratch.cellCosts[neighbor] = newCost;
+				scratch.cellCameFrom[neighbor] = currIndex;
+
+				OpenEntry_t neighborEntry;
+				neighborEntry.index = neighbor;
+				neighborEntry.costSoFar = newCost;
+				neighborEntry.priority = newCost + GetEstimate(neighbor, endIndex);
+				openList.push_back(neighborEntry);
+				std::push_heap(openList.begin(), openList.end(), compare);
+			}
+		}
+	}
+
+	openList.clear();
+
+	if (!wasFound)
+	{
+		return false;
+	}
+
+	scratch.segment.clear();
+	for (int cellIndex = endIndex; cellIndex != startIndex; cellIndex = scratch.cellCameFrom[cellIndex])
+	{
+		scratch.segment.push_back(IntVector2(cellIndex % m_dimensions.x, cellIndex / m_dimensions.x));
+	}
+
+	out_path.insert(out_path.end(), scratch.segment.rbegin(), scratch.segment.rend());
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Dijkstra over the whole region from the source, with no goal to stop at
+// Reversed, each cell gets the cost of going from it to the source instead
+//
+void GridPathfinder::SearchCostsInRegion(SearchScratch_t& scratch, int sourceIndex, const IntVector2& regionMins, const IntVector2& regionMaxs, bool isReversed)
+{
+	BeginCellSearch(scratch);
+	std::vector<OpenEntry_t>& openList = scratch.openList;
+	std::greater<OpenEntry_t> compare;
+
+	scratch.cellStamps[sourceIndex] = scratch.cellStamp;
+	scratch.cellCosts[sourceIndex] = 0.f;
+
+	OpenEntry_t sourceEntry;
+	sourceEntry.index = sourceIndex;
+	openList.push_back(sourceEntry);
+
+	while (openList.size() > 0)
+	{
+		std::pop_heap(openList.begin(), openList.end(), compare);
+		OpenEntry_t entry = openList.back();
+		openList.pop_back();
+
+		int currIndex = entry.index;
+		if (entry.costSoFar > scratch.cellCosts[currIndex])
+		{
+			continue;
+		}
+
+		int neighbors[4];
+		int neighborCount = GetNeighborsInRegion(currIndex, regionMins, regionMaxs, neighbors);
+
+		for (int neighborIndex = 0; neighborIndex < neighborCount; ++neighborIndex)
+		{
+			int neighbor = neighbors[neighborIndex];
+			if (!IsPassable(neighbor))
+			{
+				continue;
+			}
+
+			// Steps cost the cell stepped onto, which going backwards is the one we came from
+			float newCost = entry.costSoFar + (isReversed ? m_costs[currIndex] : m_costs[neighbor]);
+			bool isNew = (scratch.cellStamps[neighbor] != scratch.cellStamp);
+
+			if (isNew || newCost < scratch.cellCosts[neighbor])
+			{
+				scratch.cellStamps[neighbor] = scratch.cellStamp;
+				scratch.cellCosts[neighbor] = newCost;
+
+				OpenEntry_t neighborEntry;
+				neighborEntry.index = neighbor;
+				neighborEntry.costSoFar = newCost;
+				neighborEntry.priority = newCost;
+				openList.push_back(neighborEntry);
+				std::push_heap(openList.begin(), openList.end(), compare);
+			}
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the cost SearchCostsInRegion() found for the cell, GRID_PATH_UNREACHED_COST if it didn't reach it
+//
+float GridPathfinder::GetSearchedCost(const SearchScratch_t& scratch, int cellIndex) const
+{
+	return (scratch.cellStamps[cellIndex] == scratch.cellStamp ? scratch.cellCosts[cellIndex] : GRID_PATH_UNREACHED_COST);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts a new search of the cells, only clearing the stamps when they wrap
+//
+void GridPathfinder::BeginCellSearch(SearchScratch_t& scratch) const
+{
+	scratch.openList.clear();
+	scratch.cellStamp++;
+
+	if (scratch.cellStamp == 0)
+	{
+		std::fill(scratch.cellStamps.begin(), scratch.cellStamps.end(), 0);
+		scratch.cellStamp = 1;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts a new search of the portal graph, only clearing the stamps when they wrap
+//
+void GridPathfinder::BeginNodeSearch(SearchScratch_t& scratch) const
+{
+	scratch.openList.clear();
+	scratch.nodeStamp++;
+
+	if (scratch.nodeStamp == 0)
+	{
+		std::fill(scratch.nodeStamps.begin(), scratch.nodeStamps.end(), 0);
+		scratch.nodeStamp = 1;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the Manhattan distance between the cells at the cheapest step cost, never more than the real cost
+//
+float GridPathfinder::GetEstimate(int fromIndex, int toIndex) const
+{
+	int xDistance = AbsoluteValue((fromIndex % m_dimensions.x) - (toIndex % m_dimensions.x));
+	int yDistance = AbsoluteValue((fromIndex / m_dimensions.x) - (toIndex / m_dimensions.x));
+
+	return (float) (xDistance + yDistance) * m_minStepCost;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the indices of the cell's 4 neighbors that are inside the region, returning how many there are
+//
+int GridPathfinder::GetNeighborsInRegion(int index, const IntVector2& regionMins, const IntVector2& regionMaxs, int* out_neighbors) const
+{
+	int x = index % m_dimensions.x;
+	int y = index / m_dimensions.x;
+	int neighborCount = 0;
+
+	if (y > regionMins.y)		{ out_neighbors[neighborCount++] = index - m_dimensions.x; }	// South
+	if (y < regionMaxs.y - 1)	{ out_neighbors[neighborCount++] = index + m_dimensions.x; }	// North
+	if (x > regionMins.x)		{ out_neighbors[neighborCount++] = index - 1; }					// West
+	if (x < regionMaxs.x - 1)	{ out_neighbors[neighborCount++] = index + 1; }					// East
+
+	return neighborCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the index of the cluster containing the cell
+//
+int GridPathfinder::GetClusterIndex(int cellIndex) const
+{
+	int clusterX = (cellIndex % m_dimensions.x) / m_clusterSize;
+	int clusterY = (cellIndex / m_dimensions.x) / m_clusterSize;
+
+	return clusterY * m_clusterCounts.x + clusterX;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the cells of the cluster as [out_mins, out_maxs), smaller along the far edges of the grid
+//
+void GridPathfinder::GetClusterBounds(int clusterIndex, IntVector2& out_mins, IntVector2& out_maxs) const
+{
+	out_mins = IntVector2((clusterIndex % m_clusterCounts.x) * m_clusterSize, (clusterIndex / m_clusterCounts.x) * m_clusterSize);
+	out_maxs = IntVector2(MinInt(out_mins.x + m_clusterSize, m_dimensions.x), MinInt(out_mins.y + m_clusterSize, m_dimensions.y));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the cell can be stepped onto
+//
+bool GridPathfinder::IsPassable(int cellIndex) const
+{
+	return (m_costs[cellIndex] < GRID_PATH_BLOCKED_COST);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies the cached path for the key into out_path, returning false if it isn't cached
+//
+bool GridPathfinder::GetCachedPath(uint64_t key, std::vector<IntVector2>& out_path)
+{
+	int slot = (int) ((key * 0x9E3779B97F4A7C15ull) >> 32) & (GRID_PATH_CACHE_SIZE - 1);
+
+	m_cacheLock.lock();
+
+	CachedPath_t& entry = m_cache[slot];
+	bool isHit = (entry.isValid && entry.key == key);
+
+	if (isHit)
+	{
+		out_path = entry.path;
+		m_cacheHitCount++;
+	}
+	else
+	{
+		m_cacheMissCount++;
+	}
+
+	m_cacheLock.unlock();
+
+	return isHit;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Caches the path for the key, replacing whichever path was in its slot
+//
+void GridPathfinder::AddCachedPath(uint64_t key, const std::vector<IntVector2>& path)
+{
+	int slot = (int) ((key * 0x9E3779B97F4A7C15ull) >> 32) & (GRID_PATH_CACHE_SIZE - 1);
+
+	m_cacheLock.lock();
+
+	CachedPath_t& entry = m_cache[slot];
+	entry.key = key;
+	entry.isValid = true;
+	entry.path = path;
+
+	m_cacheLock.unlock();
+}
@@ -0,0 +1,178 @@
+/************************************************************************/
+/* File: GridPathfinder.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Point to point paths on a grid of step costs, with A*
+/*				for short paths and a cluster/portal hierarchy (HPA*)
+/*				for long ones, cached and batched across the JobSystem
+/************************************************************************/
+#pragma once
+#include <mutex>
+#include <vector>
+#include <stdint.h>
+#include "Engine/Math/IntVector2.hpp"
+
+class HeatMap;
+
+// Cells costing at least this can't be stepped onto
+#define GRID_PATH_BLOCKED_COST (9999.f)
+
+// Cells per side of the clusters of the hierarchy; 0 searches every path on the full grid
+#define GRID_PATH_DEFAULT_CLUSTER_SIZE (16)
+
+// Found paths kept by start and end, direct mapped - power of two
+#define GRID_PATH_CACHE_SIZE (256)
+
+// One path of a batch given to FindPaths()
+struct GridPathRequest_t
+{
+	IntVector2				start;
+	IntVector2				end;
+
+	std::vector<IntVector2>	path;				// Start to end inclusive, empty if there's no path
+	bool					wasFound = false;
+};
+
+class GridPathfinder
+{
+public:
+	//-----Public Methods-----
+
+	// Costs are the cost of stepping onto each cell, the same as a HeatMap cost map, so at least zero
+	// They're copied, so changes to the HeatMap after need SetCosts() again
+	GridPathfinder(const HeatMap& costs, int clusterSize = GRID_PATH_DEFAULT_CLUSTER_SIZE);
+	~GridPathfinder();
+
+	// Rebuilds the hierarchy and drops the cache - not while any path is being found
+	void SetCosts(const HeatMap& costs);
+
+	// Safe from any thread, so long as SetCosts() isn't running
+	// Paths are start to end inclusive, like HeatMap::GetGreedyShortestPath(); returns false, with an empty path, if there's none
+	bool FindPath(const IntVector2& start, const IntVector2& end, std::vector<IntVector2>& out_path);
+	bool FindExactPath(const IntVector2& start, const IntVector2& end, std::vector<IntVector2>& out_path);	// Always A* on the full grid, never the hierarchy
+
+	// Finds every path of the batch across the JobSystem, returning once they're all done
+	void FindPaths(std::vector<GridPathRequest_t>& requests);
+
+	// Producers
+	IntVector2		GetDimensions() const;
+	int				GetClusterSize() const;
+	int				GetPortalCount() const;
+	unsigned int	GetCacheHitCount() const;
+	unsigned int	GetCacheMissCount() const;
+
+
+private:
+	//-----Private Types-----
+
+	struct PortalEdge_t
+	{
+		int		toNode = -1;
+		float	cost = 0.f;
+	};
+
+	// A cell on a cluster border with a passable neighbor across it
+	struct PortalNode_t
+	{
+		int cellIndex = -1;
+		int clusterIndex = -1;
+		int firstEdge = 0;			// Into m_portalEdges
+		int edgeCount = 0;
+	};
+
+	struct OpenEntry_t
+	{
+		float	priority = 0.f;		// Cost so far plus the estimate to the goal
+		float	costSoFar = 0.f;
+		int		index = -1;
+
+		bool operator>(const OpenEntry_t& other) const { return priority > other.priority; }
+	};
+
+	// Everything one search needs, sized once and reused; cells and nodes are only valid where
+	// their stamp is the current one, so a search never clears the arrays
+	struct SearchScratch_t
+	{
+		std::vector<float>			cellCosts;
+		std::vector<int>			cellCameFrom;
+		std::vector<uint32_t>		cellStamps;
+		uint32_t					cellStamp = 0;
+
+		std::vector<float>			nodeCosts;
+		std::vector<int>			nodeCameFrom;
+		std::vector<uint32_t>		nodeStamps;
+		uint32_t					nodeStamp = 0;
+
+		std::vector<float>			startNodeCosts;		// Of the portals in the start's cluster, from the start
+		std::vector<float>			endNodeCosts;		// Of the portals in the end's cluster, to the end
+		std::vector<OpenEntry_t>	openList;			// Binary heap, min first
+		std::vector<int>			abstractPath;
+		std::vector<IntVector2>		segment;
+	};
+
+	struct CachedPath_t
+	{
+		uint64_t				key = 0;
+		bool					isValid = false;
+		std::vector<IntVector2>	path;
+	};
+
+
+private:
+	//-----Private Methods-----
+
+	void				BuildHierarchy();
+	void				AddPortalsAlongBorder(int cellIndex, int stepToNeighbor, int runLength, int stepAlongBorder, std::vector<std::vector<PortalEdge_t>>& nodeEdges);
+	int					GetOrCreatePortalNode(int cellIndex, std::vector<std::vector<PortalEdge_t>>& nodeEdges);
+
+	SearchScratch_t*	AcquireScratch();
+	void				ReleaseScratch(SearchScratch_t* scratch);
+
+	bool				FindPathWithScratch(SearchScratch_t& scratch, const IntVector2& start, const IntVector2& end, bool useHierarchy, std::vector<IntVector2>& out_path);
+	bool				FindPathInHierarchy(SearchScratch_t& scratch, int startIndex, int endIndex, std::vector<IntVector2>& out_path);
+
+	// A* from start to end within [regionMins, regionMaxs), appending the cells after the start to out_path
+	bool				SearchCells(SearchScratch_t& scratch, int startIndex, int endIndex, const IntVector2& regionMins, const IntVector2& regionMaxs, std::vector<IntVector2>& out_path);
+
+	// Dijkstra over the region from the source, or to it if reversed, read back with GetSearchedCost()
+	void				SearchCostsInRegion(SearchScratch_t& scratch, int sourceIndex, const IntVector2& regionMins, const IntVector2& regionMaxs, bool isReversed);
+	float				GetSearchedCost(const SearchScratch_t& scratch, int cellIndex) const;
+
+	void				BeginCellSearch(SearchScratch_t& scratch) const;
+	void				BeginNodeSearch(SearchScratch_t& scratch) const;
+	float				GetEstimate(int fromIndex, int toIndex) const;
+	int					GetNeighborsInRegion(int index, const IntVector2& regionMins, const IntVector2& regionMaxs, int* out_neighbors) const;
+	int					GetClusterIndex(int cellIndex) const;
+	void				GetClusterBounds(int clusterIndex, IntVector2& out_mins, IntVector2& out_maxs) const;
+	bool				IsPassable(int cellIndex) const;
+
+	bool				GetCachedPath(uint64_t key, std::vector<IntVector2>& out_path);
+	void				AddCachedPath(uint64_t key, const std::vector<IntVector2>& path);
+
+
+private:
+	//-----Private Data-----
+
+	IntVector2	m_dimensions;
+	std::vector<float> m_costs;
+	float		m_minStepCost = 1.f;		// Scales the Manhattan estimate, so it never overestimates
+
+	// Hierarchy
+	int									m_clusterSize = 0;
+	IntVector2							m_clusterCounts = IntVector2::ZERO;
+	std::vector<PortalNode_t>			m_portalNodes;
+	std::vector<PortalEdge_t>			m_portalEdges;
+	std::vector<std::vector<int>>		m_clusterNodes;			// Portal nodes of each cluster
+	std::vector<int>					m_portalNodeByCell;		// -1 for cells that aren't portals
+
+	// Scratch for searches, one per search running at once
+	std::mutex							m_scratchLock;
+	std::vector<SearchScratch_t*>		m_scratches;
+	std::vector<SearchScratch_t*>		m_freeScratches;
+
+	std::mutex							m_cacheLock;
+	CachedPath_t						m_cache[GRID_PATH_CACHE_SIZE];
+	unsigned int						m_cacheHitCount = 0;
+	unsigned int						m_cacheMissCount = 0;
+
+};
@@ -9,6 +9,9 @@
 #include "Engine/Core/Utility/StringUtils.hpp"
 #include "Engine/Core/Utility/ErrorWarningAssert.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/JobSystem/ParallelFor.hpp"
+#include <algorithm>
+#include <functional>
 
 //-----------------------------------------------------------------------------------------------
 // Constructor - makes the map of dimensions and initializes all cells to the initial heat value
@@ -30,7 +33,9 @@ HeatMap::HeatMap(const HeatMap& copy)
 {
 	m_heatPerGridCell = copy.m_heatPerGridCell;
 	m_dimensions = copy.m_dimensions;
+	m_clearValue = copy.m_clearValue;
 	m_maxDistanceSolved = copy.m_maxDistanceSolved;
+	m_sourceHeat = copy.m_sourceHeat;
 
 	if (copy.m_costMap != nullptr)
 	{
@@ -39,6 +44,19 @@ HeatMap::HeatMap(const HeatMap& copy)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+HeatMap::~HeatMap()
+{
+	if (m_costMap != nullptr)
+	{
+		delete m_costMap;
+		m_costMap = nullptr;
+	}
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Sets all cells to have the given clear value
 //
@@ -49,6 +67,11 @@ void HeatMap::Clear(float clearValue)
 	{
 		m_heatPerGridCell[i] = clearValue;
 	}
+
+	// Nothing left to update incrementally
+	m_clearValue = clearValue;
+	m_maxDistanceSolved = -1.f;
+	m_sourceHeat.clear();
 }
 
 
@@ -115,75 +138,579 @@ void HeatMap::Seed(float seedValue, const IntVector2& seedLocation)
 
 //-----------------------------------------------------------------------------------------------
 // Solves this distance map up to a set distance
+// Dijkstra from every source at once, so each cell is settled once instead of the map being swept
+// until nothing changes
 //
 void HeatMap::SolveMapUpToDistance(float maxDist, const HeatMap* costs/*= nullptr*/)
 {
-	// No cost specified, so each step costs 1 by default
-	bool costsProvided = (costs != nullptr);
-	if (!costsProvided)
+	BeginSolve(maxDist, costs);
+	float maxStepCost = GetMaxStepCost(m_costMap);
+
+	std::vector<int> sources;
+	GatherSources(IntVector2::ZERO, m_dimensions, maxDist, sources);
+
+	SolveRegion(IntVector2::ZERO, m_dimensions, sources, maxDist, m_costMap, maxStepCost);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Solves the map the same as SolveMapUpToDistance(), for maps large enough to split across the JobSystem
+// Each round solves every tile that changed in parallel, each only within itself, then passes what
+// reached the tile edges on to the neighboring tiles; repeats until no tile edge improves its neighbor
+//
+void HeatMap::SolveMapUpToDistanceParallel(float maxDistance, const HeatMap* costs /*= nullptr*/, int tileSize /*= HEATMAP_DEFAULT_TILE_SIZE*/)
+{
+	ASSERT_OR_DIE(tileSize > 0, "Error: HeatMap::SolveMapUpToDistanceParallel() needs a tile size of at least 1");
+
+	BeginSolve(maxDistance, costs);
+	costs = m_costMap;
+
+	float maxStepCost = GetMaxStepCost(costs);
+	const float* costValues = (costs != nullptr ? costs->m_heatPerGridCell.data() : nullptr);
+
+	IntVector2 tileCounts = IntVector2((m_dimensions.x + tileSize - 1) / tileSize, (m_dimensions.y + tileSize - 1) / tileSize);
+	int tileCount = tileCounts.x * tileCounts.y;
+
+	std::vector<std::vector<int>> tileSources(tileCount);
+	std::vector<char> isTileDirty(tileCount, 1);
+	std::vector<int> dirtyTiles;
+	bool isFirstRound = true;
+
+	while (true)
 	{
-		costs = new HeatMap(m_dimensions, 1.f);
+		dirtyTiles.clear();
+		for (int tileIndex = 0; tileIndex < tileCount; ++tileIndex)
+		{
+			if (isTileDirty[tileIndex] != 0)
+			{
+				dirtyTiles.push_back(tileIndex);
+				isTileDirty[tileIndex] = 0;
+			}
+		}
+
+		if (dirtyTiles.size() == 0)
+		{
+			break;
+		}
+
+		// Tiles only touch their own cells and sources, so they can solve at the same time
+		ParallelFor(0, (int) dirtyTiles.size(), 1, [&](int dirtyIndex)
+		{
+			int tileIndex = dirtyTiles[dirtyIndex];
+			IntVector2 tileMins = IntVector2((tileIndex % tileCounts.x) * tileSize, (tileIndex / tileCounts.x) * tileSize);
+			IntVector2 tileMaxs = IntVector2(MinInt(tileMins.x + tileSize, m_dimensions.x), MinInt(tileMins.y + tileSize, m_dimensions.y));
+
+			if (isFirstRound)
+			{
+				GatherSources(tileMins, tileMaxs, maxDistance, tileSources[tileIndex]);
+			}
+
+			SolveRegion(tileMins, tileMaxs, tileSources[tileIndex], maxDistance, costs, maxStepCost);
+			tileSources[tileIndex].clear();
+		});
+
+		isFirstRound = false;
+
+		// Only the solved tiles changed, so only their edges can improve a neighbor
+		for (int dirtyIndex = 0; dirtyIndex < (int) dirtyTiles.size(); ++dirtyIndex)
+		{
+			int tileIndex = dirtyTiles[dirtyIndex];
+			IntVector2 tileMins = IntVector2((tileIndex % tileCounts.x) * tileSize, (tileIndex / tileCounts.x) * tileSize);
+			IntVector2 tileMaxs = IntVector2(MinInt(tileMins.x + tileSize, m_dimensions.x), MinInt(tileMins.y + tileSize, m_dimensions.y));
+
+			for (int yIndex = tileMins.y; yIndex < tileMaxs.y; ++yIndex)
+			{
+				for (int xIndex = tileMins.x; xIndex < tileMaxs.x; ++xIndex)
+				{
+					bool isOnEdge = (xIndex == tileMins.x || xIndex == tileMaxs.x - 1 || yIndex == tileMins.y || yIndex == tileMaxs.y - 1);
+					if (!isOnEdge)
+					{
+						xIndex = tileMaxs.x - 2;	// Skip to the last column of the row
+						continue;
+					}
+
+					int currIndex = GetIndex(xIndex, yIndex);
+					int neighbors[4];
+					int neighborCount = GetNeighborsInRegion(currIndex, IntVector2::ZERO, m_dimensions, neighbors);
+
+					for (int neighborIndex = 0; neighborIndex < neighborCount; ++neighborIndex)
+					{
+						int neighbor = neighbors[neighborIndex];
+						IntVector2 neighborCoords = GetCoordsForIndex(neighbor);
+
+						bool isInTile = (neighborCoords.x >= tileMins.x && neighborCoords.x < tileMaxs.x && neighborCoords.y >= tileMins.y && neighborCoords.y < tileMaxs.y);
+						if (isInTile)
+						{
+							continue;
+						}
+
+						float newDistance = m_heatPerGridCell[currIndex] + (costValues != nullptr ? costValues[neighbor] : 1.f);
+						if (newDistance < m_heatPerGridCell[neighbor] && newDistance < maxDistance)
+						{
+							m_heatPerGridCell[neighbor] = newDistance;
+
+							int neighborTile = (neighborCoords.y / tileSize) * tileCounts.x + (neighborCoords.x / tileSize);
+							tileSources[neighborTile].push_back(neighbor);
+							isTileDirty[neighborTile] = 1;
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Clears the map to maxDistance, so unreached cells are never sources, then solves it from every seed with the cost map
+//
+void HeatMap::SolveFlowField(const std::vector<IntVector2>& seedCoords, float maxDistance, float seedValue /*= 0.f*/)
+{
+	Clear(maxDistance);
+	Seed(seedValue, seedCoords);
+	SolveMapUpToDistance(maxDistance);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the costs solves use when not given any; to change the costs of a map already solved, use UpdateCost()
+//
+void HeatMap::SetCostMap(const HeatMap& costs)
+{
+	ASSERT_OR_DIE(costs.m_dimensions == m_dimensions, "Error: HeatMap::SetCostMap() given a cost map of different dimensions");
+
+	if (&costs == m_costMap)
+	{
+		return;
 	}
 
-	// Keep iterating until we no longer notice a change in the map
-	bool valueChanged = true;
-	while (valueChanged)
+	if (m_costMap == nullptr)
 	{
-		valueChanged = false;
+		m_costMap = new HeatMap(m_dimensions, 1.f);
+	}
+
+	m_costMap->m_heatPerGridCell = costs.m_heatPerGridCell;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Changes the cost of stepping onto the cell, re-solving only the cells it changes
+// A lower cost spreads out from the cell; a higher one first resets the cells whose heat came through it
+//
+void HeatMap::UpdateCost(const IntVector2& cellCoords, float newCost)
+{
+	ASSERT_OR_DIE(m_maxDistanceSolved >= 0.f, "Error: HeatMap::UpdateCost() called on a map that isn't solved");
+	ASSERT_OR_DIE(AreCoordsValid(cellCoords), Stringf("Error: HeatMap::UpdateCost() received bad coords, coords were (%d,%d)", cellCoords.x, cellCoords.y));
+	ASSERT_OR_DIE(newCost >= 0.f, Stringf("Error: HeatMap::UpdateCost() given a negative cost, cost was %f", newCost));
+
+	if (m_costMap == nullptr)
+	{
+		m_costMap = new HeatMap(m_dimensions, 1.f);
+	}
+
+	int index = GetIndex(cellCoords.x, cellCoords.y);
+	float oldCost = m_costMap->m_heatPerGridCell[index];
+	m_costMap->m_heatPerGridCell[index] = newCost;
 
-		// Iterate across the map
-		for (int xIndex = 0; xIndex < m_dimensions.x; xIndex++)
+	if (newCost > oldCost)
+	{
+		RaiseFromCell(index);
+	}
+	else if (newCost < oldCost)
+	{
+		LowerFromCell(index);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Seeds the cell with the value, or changes the value of a seed already there, re-solving only the cells it changes
+//
+void HeatMap::UpdateSeed(const IntVector2& cellCoords, float seedValue)
+{
+	ASSERT_OR_DIE(m_maxDistanceSolved >= 0.f, "Error: HeatMap::UpdateSeed() called on a map that isn't solved");
+	ASSERT_OR_DIE(AreCoordsValid(cellCoords), Stringf("Error: HeatMap::UpdateSeed() received bad coords, coords were (%d,%d)", cellCoords.x, cellCoords.y));
+
+	int index = GetIndex(cellCoords.x, cellCoords.y);
+	float oldValue = m_sourceHeat[index];
+	m_sourceHeat[index] = seedValue;
+
+	if (seedValue > oldValue)
+	{
+		RaiseFromCell(index);
+	}
+	else if (seedValue < oldValue)
+	{
+		LowerFromCell(index);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes the seed at the cell, putting it back to the clear value before re-solving the cells it reached
+//
+void HeatMap::RemoveSeed(const IntVector2& cellCoords)
+{
+	UpdateSeed(cellCoords, m_clearValue);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Keeps what the incremental updates need - the costs and the heat everything is solved from
+//
+void HeatMap::BeginSolve(float maxDistance, const HeatMap* costs)
+{
+	if (costs != nullptr && costs != m_costMap)
+	{
+		SetCostMap(*costs);
+	}
+
+	m_sourceHeat = m_heatPerGridCell;
+	m_maxDistanceSolved = maxDistance;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the cost of stepping onto the cell
+//
+float HeatMap::GetStepCost(int index) const
+{
+	return (m_costMap != nullptr ? m_costMap->m_heatPerGridCell[index] : 1.f);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Spreads a cheaper cell out - the cell takes its neighbors' heat under its new cost, or its new
+// seed, and any of it that's lower spreads from there; nothing else can change
+//
+void HeatMap::LowerFromCell(int index)
+{
+	m_heatPerGridCell[index] = MinFloat(m_heatPerGridCell[index], m_sourceHeat[index]);
+
+	std::vector<int> sources;
+	if (m_heatPerGridCell[index] < m_maxDistanceSolved)
+	{
+		sources.push_back(index);
+	}
+
+	int neighbors[4];
+	int neighborCount = GetNeighborsInRegion(index, IntVector2::ZERO, m_dimensions, neighbors);
+
+	for (int neighborIndex = 0; neighborIndex < neighborCount; ++neighborIndex)
+	{
+		if (m_heatPerGridCell[neighbors[neighborIndex]] < m_maxDistanceSolved)
+		{
+			sources.push_back(neighbors[neighborIndex]);
+		}
+	}
+
+	const float* costValues = (m_costMap != nullptr ? m_costMap->m_heatPerGridCell.data() : nullptr);
+	SolveRegionWithPriorityQueue(IntVector2::ZERO, m_dimensions, sources, m_maxDistanceSolved, costValues);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Re-solves the cells whose heat came through a cell that got more expensive
+// Walks out from the cell to every neighbor whose heat is exactly its parent's plus its own cost, resets
+// them to their sources, then solves them again from the untouched cells around them; a neighbor with an
+// equal path elsewhere is reset too, which only costs a little more work
+//
+void HeatMap::RaiseFromCell(int index)
+{
+	if (m_isInvalidated.size() != m_heatPerGridCell.size())
+	{
+		m_isInvalidated.assign(m_heatPerGridCell.size(), 0);
+	}
+
+	std::vector<int> invalidCells;
+	invalidCells.push_back(index);
+	m_isInvalidated[index] = 1;
+
+	int neighbors[4];
+
+	for (int invalidIndex = 0; invalidIndex < (int) invalidCells.size(); ++invalidIndex)
+	{
+		int currIndex = invalidCells[invalidIndex];
+		int neighborCount = GetNeighborsInRegion(currIndex, IntVector2::ZERO, m_dimensions, neighbors);
+
+		for (int neighborIndex = 0; neighborIndex < neighborCount; ++neighborIndex)
 		{
-			for (int yIndex = 0; yIndex < m_dimensions.y; yIndex++)
+			int neighbor = neighbors[neighborIndex];
+			float neighborHeat = m_heatPerGridCell[neighbor];
+
+			// Compared exactly, as solves store the same sum
+			bool isFromCurr = (neighborHeat == m_heatPerGridCell[currIndex] + GetStepCost(neighbor));
+			bool isFromOwnSource = (neighborHeat >= m_sourceHeat[neighbor]);
+
+			if (m_isInvalidated[neighbor] == 0 && neighborHeat < m_maxDistanceSolved && isFromCurr && !isFromOwnSource)
 			{
-				int currIndex = GetIndex(xIndex, yIndex);
+				m_isInvalidated[neighbor] = 1;
+				invalidCells.push_back(neighbor);
+			}
+		}
+	}
+
+	for (int invalidIndex = 0; invalidIndex < (int) invalidCells.size(); ++invalidIndex)
+	{
+		m_heatPerGridCell[invalidCells[invalidIndex]] = m_sourceHeat[invalidCells[invalidIndex]];
+	}
+
+	// Solve again from the seeds among the reset cells and every solved cell bordering them
+	std::vector<int> sources;
+	for (int invalidIndex = 0; invalidIndex < (int) invalidCells.size(); ++invalidIndex)
+	{
+		int currIndex = invalidCells[invalidIndex];
+		if (m_heatPerGridCell[currIndex] < m_maxDistanceSolved)
+		{
+			sources.push_back(currIndex);
+		}
+
+		int neighborCount = GetNeighborsInRegion(currIndex, IntVector2::ZERO, m_dimensions, neighbors);
+		for (int neighborIndex = 0; neighborIndex < neighborCount; ++neighborIndex)
+		{
+			int neighbor = neighbors[neighborIndex];
+			if (m_isInvalidated[neighbor] == 0 && m_heatPerGridCell[neighbor] < m_maxDistanceSolved)
+			{
+				sources.push_back(neighbor);
+			}
+		}
+	}
+
+	for (int invalidIndex = 0; invalidIndex < (int) invalidCells.size(); ++invalidIndex)
+	{
+		m_isInvalidated[invalidCells[invalidIndex]] = 0;
+	}
 
-				// Update the current index by checking all 4 neighbors
-				int southIndex      = GetIndex(xIndex, yIndex - 1);
-				bool southChanged   = UpdateCurrFromNeighbor(currIndex, southIndex, maxDist, costs);
+	const float* costValues = (m_costMap != nullptr ? m_costMap->m_heatPerGridCell.data() : nullptr);
+	SolveRegionWithPriorityQueue(IntVector2::ZERO, m_dimensions, sources, m_maxDistanceSolved, costValues);
+}
 
-				int northIndex      = GetIndex(xIndex, yIndex + 1);
-				bool northChanged   = UpdateCurrFromNeighbor(currIndex, northIndex, maxDist, costs);
 
-				int westIndex       = GetIndex(xIndex - 1, yIndex);
-				bool westChanged    = UpdateCurrFromNeighbor(currIndex, westIndex, maxDist, costs);
+//-----------------------------------------------------------------------------------------------
+// Returns the largest cost of stepping onto a cell, checking none are negative
+//
+float HeatMap::GetMaxStepCost(const HeatMap* costs) const
+{
+	if (costs == nullptr)
+	{
+		return 1.f;
+	}
+
+	ASSERT_OR_DIE(costs->m_dimensions == m_dimensions, "Error: HeatMap solve given a cost map of different dimensions");
+
+	float minCost = 0.f;
+	float maxCost = 0.f;
+
+	int numCells = (int) costs->m_heatPerGridCell.size();
+	for (int cellIndex = 0; cellIndex < numCells; ++cellIndex)
+	{
+		float cost = costs->m_heatPerGridCell[cellIndex];
+		minCost = (cellIndex == 0 || cost < minCost ? cost : minCost);
+		maxCost = (cellIndex == 0 || cost > maxCost ? cost : maxCost);
+	}
+
+	ASSERT_OR_DIE(minCost >= 0.f, Stringf("Error: HeatMap solve given a negative cost, min cost was %f", minCost));
+
+	// The bucket queue needs every step to move at least one bucket along, so a cost under 1 rules it out
+	if (minCost < 1.f)
+	{
+		return -1.f;
+	}
+
+	return maxCost;
+}
 
-				int eastIndex       = GetIndex(xIndex + 1, yIndex);
-				bool eastChanged    = UpdateCurrFromNeighbor(currIndex, eastIndex, maxDist, costs);
 
-				// Update if we changed or not
-				valueChanged = valueChanged || northChanged || southChanged || eastChanged || westChanged;
+//-----------------------------------------------------------------------------------------------
+// Adds the index of every cell in the region below maxDistance, the only cells that can spread heat
+//
+void HeatMap::GatherSources(const IntVector2& regionMins, const IntVector2& regionMaxs, float maxDistance, std::vector<int>& out_sources) const
+{
+	for (int yIndex = regionMins.y; yIndex < regionMaxs.y; ++yIndex)
+	{
+		for (int xIndex = regionMins.x; xIndex < regionMaxs.x; ++xIndex)
+		{
+			int index = GetIndex(xIndex, yIndex);
+			if (m_heatPerGridCell[index] < maxDistance)
+			{
+				out_sources.push_back(index);
 			}
 		}
 	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Solves the region with a bucket queue when the costs allow it, otherwise a binary heap
+// maxStepCost is negative when a cost is under 1
+//
+void HeatMap::SolveRegion(const IntVector2& regionMins, const IntVector2& regionMaxs, std::vector<int>& sources, float maxDistance, const HeatMap* costs, float maxStepCost)
+{
+	if (sources.size() == 0)
+	{
+		return;
+	}
+
+	const float* costValues = (costs != nullptr ? costs->m_heatPerGridCell.data() : nullptr);
+
+	// Bucket levels are ints from the lowest source, so the range must fit in one
+	float minSourceHeat = m_heatPerGridCell[sources[0]];
+	for (int sourceIndex = 1; sourceIndex < (int) sources.size(); ++sourceIndex)
+	{
+		minSourceHeat = MinFloat(minSourceHeat, m_heatPerGridCell[sources[sourceIndex]]);
+	}
 
-	if (!costsProvided)
+	bool canUseBuckets = (maxStepCost >= 1.f && maxStepCost <= HEATMAP_MAX_BUCKET_STEP_COST && (maxDistance - minSourceHeat) < 1000000000.f);
+
+	if (canUseBuckets)
 	{
-		delete costs;
+		SolveRegionWithBucketQueue(regionMins, regionMaxs, sources, maxDistance, costValues, maxStepCost);
+	}
+	else
+	{
+		SolveRegionWithPriorityQueue(regionMins, regionMaxs, sources, maxDistance, costValues);
 	}
 }
 
 
-//----------------------------------------------------------------------------------
-// Updates the distance value at currIndex based on the distance value of neighborIndex
+//-----------------------------------------------------------------------------------------------
+// Dial's algorithm - buckets one unit of heat wide, in a ring of one more than the largest step
+// Every cost is at least 1, so a settled cell only ever adds to later buckets, and every cell in the
+// current bucket is already final whatever order they come out in
 //
-bool HeatMap::UpdateCurrFromNeighbor(int currIndex, int neighborIndex, float maxDistance, const HeatMap* costs)
+void HeatMap::SolveRegionWithBucketQueue(const IntVector2& regionMins, const IntVector2& regionMaxs, std::vector<int>& sources, float maxDistance, const float* costValues, float maxStepCost)
 {
-	// Bad index, just return false
-	if (neighborIndex == -1) { return false; }
+	const std::vector<float>& heat = m_heatPerGridCell;
+
+	// Sources are taken in as the levels reach them, as they can be further apart than the ring
+	std::sort(sources.begin(), sources.end(), [&heat](int first, int second) { return heat[first] < heat[second]; });
 
-	float currDistance = m_heatPerGridCell[currIndex];
-	float newDistance = m_heatPerGridCell[neighborIndex] + costs->GetHeat(currIndex);
+	float baseHeat = heat[sources[0]];
+	int bucketCount = (int) maxStepCost + 2;
+	std::vector<std::vector<int>> buckets(bucketCount);
 
-	bool isWithinMaxDist = (newDistance < maxDistance);
+	IntVector2 regionDimensions = regionMaxs - regionMins;
+	std::vector<char> isSettled(regionDimensions.x * regionDimensions.y, 0);
 
-	if (newDistance < currDistance && isWithinMaxDist)
+	int pendingCount = 0;
+	int nextSource = 0;
+	int level = 0;
+	int sourceCount = (int) sources.size();
+
+	while (pendingCount > 0 || nextSource < sourceCount)
 	{
-		m_heatPerGridCell[currIndex] = newDistance;
-		return true;
-	} 
+		// Nothing queued, so jump straight to the next source
+		if (pendingCount == 0)
+		{
+			level = MaxInt(level, (int) (heat[sources[nextSource]] - baseHeat));
+		}
+
+		std::vector<int>& bucket = buckets[level % bucketCount];
+
+		while (nextSource < sourceCount && (int) (heat[sources[nextSource]] - baseHeat) <= level)
+		{
+			bucket.push_back(sources[nextSource]);
+			pendingCount++;
+			nextSource++;
+		}
 
-	return false;
+		for (int entryIndex = 0; entryIndex < (int) bucket.size(); ++entryIndex)
+		{
+			int currIndex = bucket[entryIndex];
+			pendingCount--;
+
+			IntVector2 coords = GetCoordsForIndex(currIndex);
+			int localIndex = (coords.y - regionMins.y) * regionDimensions.x + (coords.x - regionMins.x);
+
+			// Stale entries - the cell was already settled, or has since been lowered into a later bucket
+			if (isSettled[localIndex] != 0 || (int) (heat[currIndex] - baseHeat) != level)
+			{
+				continue;
+			}
+
+			isSettled[localIndex] = 1;
+
+			int neighbors[4];
+			int neighborCount = GetNeighborsInRegion(currIndex, regionMins, regionMaxs, neighbors);
+
+			for (int neighborIndex = 0; neighborIndex < neighborCount; ++neighborIndex)
+			{
+				int neighbor = neighbors[neighborIndex];
+				float newDistance = heat[currIndex] + (costValues != nullptr ? costValues[neighbor] : 1.f);
+
+				if (newDistance < heat[neighbor] && newDistance < maxDistance)
+				{
+					m_heatPerGridCell[neighbor] = newDistance;
+					buckets[((int) (newDistance - baseHeat)) % bucketCount].push_back(neighbor);
+					pendingCount++;
+				}
+			}
+		}
+
+		bucket.clear();
+		level++;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Dijkstra with a binary heap, for any costs; cells lowered again are pushed again, and the older
+// entries skipped when they come out
+//
+void HeatMap::SolveRegionWithPriorityQueue(const IntVector2& regionMins, const IntVector2& regionMaxs, const std::vector<int>& sources, float maxDistance, const float* costValues)
+{
+	typedef std::pair<float, int> HeatEntry;
+	std::priority_queue<HeatEntry, std::vector<HeatEntry>, std::greater<HeatEntry>> queue;
+
+	for (int sourceIndex = 0; sourceIndex < (int) sources.size(); ++sourceIndex)
+	{
+		queue.push(HeatEntry(m_heatPerGridCell[sources[sourceIndex]], sources[sourceIndex]));
+	}
+
+	while (!queue.empty())
+	{
+		HeatEntry entry = queue.top();
+		queue.pop();
+
+		int currIndex = entry.second;
+		if (entry.first > m_heatPerGridCell[currIndex])
+		{
+			continue;
+		}
+
+		int neighbors[4];
+		int neighborCount = GetNeighborsInRegion(currIndex, regionMins, regionMaxs, neighbors);
+
+		for (int neighborIndex = 0; neighborIndex < neighborCount; ++neighborIndex)
+		{
+			int neighbor = neighbors[neighborIndex];
+			float newDistance = entry.first + (costValues != nullptr ? costValues[neighbor] : 1.f);
+
+			if (newDistance < m_heatPerGridCell[neighbor] && newDistance < maxDistance)
+			{
+				m_heatPerGridCell[neighbor] = newDistance;
+				queue.push(HeatEntry(newDistance, neighbor));
+			}
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the indices of the cell's 4 neighbors that are inside the region, returning how many there are
+//
+int HeatMap::GetNeighborsInRegion(int index, const IntVector2& regionMins, const IntVector2& regionMaxs, int* out_neighbors) const
+{
+	int x = index % m_dimensions.x;
+	int y = index / m_dimensions.x;
+	int neighborCount = 0;
+
+	if (y > regionMins.y)		{ out_neighbors[neighborCount++] = index - m_dimensions.x; }	// South
+	if (y < regionMaxs.y - 1)	{ out_neighbors[neighborCount++] = index + m_dimensions.x; }	// North
+	if (x > regionMins.x)		{ out_neighbors[neighborCount++] = index - 1; }					// West
+	if (x < regionMaxs.x - 1)	{ out_neighbors[neighborCount++] = index + 1; }					// East
+
+	return neighborCount;
 }
 
 
@@ -223,6 +750,15 @@ unsigned int HeatMap::GetCellCount() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the width x height of the grid
+//
+IntVector2 HeatMap::GetDimensions() const
+{
+	return m_dimensions;
+}
+
+
 //----------------------------------------------------------------------------------
 // Gets the index for the position (x, y)
 // Returns -1 for coords out of bounds
@@ -320,6 +856,36 @@ IntVector2 HeatMap::GetMinNeighborCoords(const IntVector2& currCoords) const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the step towards the lowest neighbor of the cell, the way a flow field points
+// Unlike GetMinNeighborCoords() ties aren't randomized, so every agent on the cell goes the same way
+//
+IntVector2 HeatMap::GetFlowDirection(const IntVector2& cellCoords) const
+{
+	if (!AreCoordsValid(cellCoords))
+	{
+		return IntVector2::ZERO;
+	}
+
+	static const IntVector2 s_steps[4] = { IntVector2::STEP_NORTH, IntVector2::STEP_SOUTH, IntVector2::STEP_EAST, IntVector2::STEP_WEST };
+
+	float minHeat = GetHeat(cellCoords);
+	IntVector2 direction = IntVector2::ZERO;
+
+	for (int stepIndex = 0; stepIndex < 4; ++stepIndex)
+	{
+		float neighborHeat = GetHeat(cellCoords + s_steps[stepIndex]);
+		if (neighborHeat < minHeat)
+		{
+			minHeat = neighborHeat;
+			direction = s_steps[stepIndex];
+		}
+	}
+
+	return direction;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns true if the coords are in bounds, false otherwise
 bool HeatMap::AreCoordsValid(const IntVector2& coords) const
@@ -10,6 +10,12 @@
 #include <queue>
 #include "Engine/Math/IntVector2.hpp"
 
+// Costs up to this, all at least 1, solve with a bucket queue; anything else uses a binary heap
+#define HEATMAP_MAX_BUCKET_STEP_COST (1024.f)
+
+// Cells per side of the tiles the parallel solve works on
+#define HEATMAP_DEFAULT_TILE_SIZE (64)
+
 class HeatMap
 {
 public:
@@ -17,6 +23,7 @@ public:
 
 	HeatMap(const IntVector2& dimensions, float initialHeatValuePerCell);
 	HeatMap(const HeatMap& copy);
+	~HeatMap();
 
 	// Mutators
 	void Clear(float clearValue);
@@ -25,7 +32,21 @@ public:
 	void AddHeat(const IntVector2& cellCoords, float addAmount);
 	void Seed(float seedValue, const IntVector2& seedLocation);
 	void Seed(float seedValue, const std::vector<IntVector2>& seedCoords);
+	// Cells below maxDistance are the sources, at their current heat; costs are the cost of stepping onto each cell,
+	// at least zero - the map's own cost map if not given, or 1 everywhere without one
+	// The costs are kept as the cost map, and the heat before the solve as the sources, for the updates below
 	void SolveMapUpToDistance(float maxDistance, const HeatMap* costs = nullptr);
+	void SolveMapUpToDistanceParallel(float maxDistance, const HeatMap* costs = nullptr, int tileSize = HEATMAP_DEFAULT_TILE_SIZE);
+
+	// Clears the map and solves it from all the seeds at once with the cost map, for following with GetFlowDirection()
+	void SolveFlowField(const std::vector<IntVector2>& seedCoords, float maxDistance, float seedValue = 0.f);
+
+	// Incremental updates of a solved map, only re-solving the cells the change reaches
+	// Anything changed through SetHeat(), Seed() or AddHeat() since the solve isn't tracked by these
+	void SetCostMap(const HeatMap& costs);
+	void UpdateCost(const IntVector2& cellCoords, float newCost);
+	void UpdateSeed(const IntVector2& cellCoords, float seedValue);
+	void RemoveSeed(const IntVector2& cellCoords);
 
 	// Accessors
 	float GetHeat(const IntVector2& cellCoords) const;
@@ -33,17 +54,31 @@ public:
 
 	// Producers
 	unsigned int GetCellCount() const;
+	IntVector2	GetDimensions() const;
 	int			GetIndex(int x, int y) const;
 	IntVector2  GetCoordsForIndex(unsigned int index) const;
 	void		GetGreedyShortestPath(const IntVector2& pathStartCoords, const IntVector2& pathEndCoords, std::vector<IntVector2>& path) const;
 	IntVector2	GetMinNeighborCoords(const IntVector2& currCoords) const;
+	IntVector2	GetFlowDirection(const IntVector2& cellCoords) const;		// Step to the lowest neighbor, ZERO if none is lower
 	bool		AreCoordsValid(const IntVector2& coords) const;
 
 
 private:
 	//-----Private Methods-----
 
-	bool UpdateCurrFromNeighbor(int currIndex, int neighborIndex, float maxDistance, const HeatMap* costs);
+	void	BeginSolve(float maxDistance, const HeatMap* costs);
+	float	GetStepCost(int index) const;
+	void	LowerFromCell(int index);
+	void	RaiseFromCell(int index);
+
+	float	GetMaxStepCost(const HeatMap* costs) const;
+	void	GatherSources(const IntVector2& regionMins, const IntVector2& regionMaxs, float maxDistance, std::vector<int>& out_sources) const;
+
+	// Solves the cells in [regionMins, regionMaxs) from the sources, touching nothing outside the region
+	void	SolveRegion(const IntVector2& regionMins, const IntVector2& regionMaxs, std::vector<int>& sources, float maxDistance, const HeatMap* costs, float maxStepCost);
+	void	SolveRegionWithBucketQueue(const IntVector2& regionMins, const IntVector2& regionMaxs, std::vector<int>& sources, float maxDistance, const float* costValues, float maxStepCost);
+	void	SolveRegionWithPriorityQueue(const IntVector2& regionMins, const IntVector2& regionMaxs, const std::vector<int>& sources, float maxDistance, const float* costValues);
+	int		GetNeighborsInRegion(int index, const IntVector2& regionMins, const IntVector2& regionMaxs, int* out_neighbors) const;
 
 
 private:
@@ -52,6 +87,9 @@ private:
 	std::vector<float> m_heatPerGridCell;	// Ordered from bottom-left, across rows then up
 	IntVector2 m_dimensions;				// Width x height of the grid
 
-	int m_maxDistanceSolved;				// Set when the HeatMap is solved up to a certain distance from seeds
-	HeatMap* m_costMap;						// Costs associated with a solve
+	float m_clearValue = 0.f;				// Heat of a cell no seed reaches
+	float m_maxDistanceSolved = -1.f;		// Set when the HeatMap is solved up to a certain distance from seeds
+	HeatMap* m_costMap = nullptr;			// Costs associated with a solve
+	std::vector<float> m_sourceHeat;		// Heat of each cell before the last solve, seeds and unreached cells
+	std::vector<char> m_isInvalidated;		// Scratch for RaiseFromCell(), always all zero outside of it
 };
\ No newline at end of file
@@ -0,0 +1,878 @@
+/************************************************************************/
+/* File: NoiseBatch.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the batch noise functions
+/************************************************************************/
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include "Game/Framework/EngineBuildPreferences.hpp"
+#include "Engine/Core/Utility/NoiseBatch.hpp"
+#include "Engine/Core/JobSystem/ParallelFor.hpp"
+
+// Same compile time selection as Matrix44, except 8 lanes need AVX2 for the integer hashing - 4 lanes
+// with SSE2 or NEON otherwise, and one lane as the scalar reference when MATRIX44_FORCE_SCALAR is defined
+#if !defined(MATRIX44_FORCE_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#if defined(__AVX2__)
+#define NOISE_BATCH_SIMD_AVX2
+#include <immintrin.h>
+#else
+#define NOISE_BATCH_SIMD_SSE
+#include <emmintrin.h>
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#endif
+#elif !defined(MATRIX44_FORCE_SCALAR) && (defined(__ARM_NEON) || defined(_M_ARM64))
+#define NOISE_BATCH_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+// The kernels are written once against these; integer lanes hold the raw noise bits, and wrap like the scalar hash
+#if defined(NOISE_BATCH_SIMD_AVX2)
+
+typedef __m256 Lanes_t;
+typedef __m256i IntLanes_t;
+#define LANE_COUNT (8)
+
+static inline Lanes_t		LoadLanes(const float* values)						{ return _mm256_loadu_ps(values); }
+static inline void			StoreLanes(float* out_values, Lanes_t a)			{ _mm256_storeu_ps(out_values, a); }
+static inline Lanes_t		SplatLanes(float value)								{ return _mm256_set1_ps(value); }
+static inline Lanes_t		AddLanes(Lanes_t a, Lanes_t b)						{ return _mm256_add_ps(a, b); }
+static inline Lanes_t		SubtractLanes(Lanes_t a, Lanes_t b)					{ return _mm256_sub_ps(a, b); }
+static inline Lanes_t		MultiplyLanes(Lanes_t a, Lanes_t b)					{ return _mm256_mul_ps(a, b); }
+static inline Lanes_t		DivideLanes(Lanes_t a, Lanes_t b)					{ return _mm256_div_ps(a, b); }
+static inline Lanes_t		FloorLanes(Lanes_t a)								{ return _mm256_floor_ps(a); }
+static inline IntLanes_t	ConvertToIntLanes(Lanes_t a)						{ return _mm256_cvttps_epi32(a); }
+static inline Lanes_t		ConvertToFloatLanes(IntLanes_t a)					{ return _mm256_cvtepi32_ps(a); }
+static inline IntLanes_t	AsIntLanes(Lanes_t a)								{ return _mm256_castps_si256(a); }
+static inline Lanes_t		AsFloatLanes(IntLanes_t a)							{ return _mm256_castsi256_ps(a); }
+
+static inline IntLanes_t	LoadIntLanes(const int* values)						{ return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values)); }
+static inline void			StoreIntLanes(unsigned int* out_values, IntLanes_t a) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(out_values), a); }
+static inline IntLanes_t	SplatIntLanes(unsigned int value)					{ return _mm256_set1_epi32(static_cast<int>(value)); }
+static inline IntLanes_t	AddIntLanes(IntLanes_t a, IntLanes_t b)				{ return _mm256_add_epi32(a, b); }
+static inline IntLanes_t	SubtractIntLanes(IntLanes_t a, IntLanes_t b)		{ return _mm256_sub_epi32(a, b); }
+static inline IntLanes_t	MultiplyIntLanes(IntLanes_t a, IntLanes_t b)		{ return _mm256_mullo_epi32(a, b); }
+static inline IntLanes_t	AndIntLanes(IntLanes_t a, IntLanes_t b)				{ return _mm256_and_si256(a, b); }
+static inline IntLanes_t	AndNotIntLanes(IntLanes_t a, IntLanes_t b)			{ return _mm256_andnot_si256(a, b); }	// ~a & b
+static inline IntLanes_t	OrIntLanes(IntLanes_t a, IntLanes_t b)				{ return _mm256_or_si256(a, b); }
+static inline IntLanes_t	XorIntLanes(IntLanes_t a, IntLanes_t b)				{ return _mm256_xor_si256(a, b); }
+static inline IntLanes_t	ShiftRightIntLanes(IntLanes_t a, int bitCount)		{ return _mm256_srl_epi32(a, _mm_cvtsi32_si128(bitCount)); }
+static inline IntLanes_t	ShiftLeftIntLanes(IntLanes_t a, int bitCount)		{ return _mm256_sll_epi32(a, _mm_cvtsi32_si128(bitCount)); }
+static inline IntLanes_t	GetLaneIndices()									{ return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+
+#elif defined(NOISE_BATCH_SIMD_SSE)
+
+typedef __m128 Lanes_t;
+typedef __m128i IntLanes_t;
+#define LANE_COUNT (4)
+
+static inline Lanes_t		LoadLanes(const float* values)						{ return _mm_loadu_ps(values); }
+static inline void			StoreLanes(float* out_values, Lanes_t a)			{ _mm_storeu_ps(out_values, a); }
+static inline Lanes_t		SplatLanes(float value)								{ return _mm_set1_ps(value); }
+static inline Lanes_t		AddLanes(Lanes_t a, Lanes_t b)						{ return _mm_add_ps(a, b); }
+static inline Lanes_t		SubtractLanes(Lanes_t a, Lanes_t b)					{ return _mm_sub_ps(a, b); }
+static inline Lanes_t		MultiplyLanes(Lanes_t a, Lanes_t b)					{ return _mm_mul_ps(a, b); }
+static inline Lanes_t		DivideLanes(Lanes_t a, Lanes_t b)					{ return _mm_div_ps(a, b); }
+static inline IntLanes_t	ConvertToIntLanes(Lanes_t a)						{ return _mm_cvttps_epi32(a); }
+static inline Lanes_t		ConvertToFloatLanes(IntLanes_t a)					{ return _mm_cvtepi32_ps(a); }
+static inline IntLanes_t	AsIntLanes(Lanes_t a)								{ return _mm_castps_si128(a); }
+static inline Lanes_t		AsFloatLanes(IntLanes_t a)							{ return _mm_castsi128_ps(a); }
+
+static inline IntLanes_t	LoadIntLanes(const int* values)						{ return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values)); }
+static inline void			StoreIntLanes(unsigned int* out_values, IntLanes_t a) { _mm_storeu_si128(reinterpret_cast<__m128i*>(out_values), a); }
+static inline IntLanes_t	SplatIntLanes(unsigned int value)					{ return _mm_set1_epi32(static_cast<int>(value)); }
+static inline IntLanes_t	AddIntLanes(IntLanes_t a, IntLanes_t b)				{ return _mm_add_epi32(a, b); }
+static inline IntLanes_t	SubtractIntLanes(IntLanes_t a, IntLanes_t b)		{ return _mm_sub_epi32(a, b); }
+static inline IntLanes_t	AndIntLanes(IntLanes_t a, IntLanes_t b)				{ return _mm_and_si128(a, b); }
+static inline IntLanes_t	AndNotIntLanes(IntLanes_t a, IntLanes_t b)			{ return _mm_andnot_si128(a, b); }		// ~a & b
+static inline IntLanes_t	OrIntLanes(IntLanes_t a, IntLanes_t b)				{ return _mm_or_si128(a, b); }
+static inline IntLanes_t	XorIntLanes(IntLanes_t a, IntLanes_t b)				{ return _mm_xor_si128(a, b); }
+static inline IntLanes_t	ShiftRightIntLanes(IntLanes_t a, int bitCount)		{ return _mm_srl_epi32(a, _mm_cvtsi32_si128(bitCount)); }
+static inline IntLanes_t	ShiftLeftIntLanes(IntLanes_t a, int bitCount)		{ return _mm_sll_epi32(a, _mm_cvtsi32_si128(bitCount)); }
+static inline IntLanes_t	GetLaneIndices()									{ return _mm_setr_epi32(0, 1, 2, 3); }
+
+#if defined(__SSE4_1__)
+
+static inline Lanes_t		FloorLanes(Lanes_t a)								{ return _mm_floor_ps(a); }
+static inline IntLanes_t	MultiplyIntLanes(IntLanes_t a, IntLanes_t b)		{ return _mm_mullo_epi32(a, b); }
+
+#else
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// SSE2 has no floor, so truncate and step down the lanes that were negative with a fraction
+//
+static inline Lanes_t FloorLanes(Lanes_t a)
+{
+	Lanes_t truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+	Lanes_t stepDown = _mm_and_ps(_mm_cmpgt_ps(truncated, a), _mm_set1_ps(1.f));
+
+	return _mm_sub_ps(truncated, stepDown);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// SSE2 has no 32 bit multiply, so multiply the even and odd lanes as 64 bit and keep the low halves
+//
+static inline IntLanes_t MultiplyIntLanes(IntLanes_t a, IntLanes_t b)
+{
+	__m128i evenProducts = _mm_mul_epu32(a, b);
+	__m128i oddProducts = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(evenProducts, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(oddProducts, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+#endif
+
+#elif defined(NOISE_BATCH_SIMD_NEON)
+
+typedef float32x4_t Lanes_t;
+typedef uint32x4_t IntLanes_t;
+#define LANE_COUNT (4)
+
+static inline Lanes_t		LoadLanes(const float* values)						{ return vld1q_f32(values); }
+static inline void			StoreLanes(float* out_values, Lanes_t a)			{ vst1q_f32(out_values, a); }
+static inline Lanes_t		SplatLanes(float value)								{ return vdupq_n_f32(value); }
+static inline Lanes_t		AddLanes(Lanes_t a, Lanes_t b)						{ return vaddq_f32(a, b); }
+static inline Lanes_t		SubtractLanes(Lanes_t a, Lanes_t b)					{ return vsubq_f32(a, b); }
+static inline Lanes_t		MultiplyLanes(Lanes_t a, Lanes_t b)					{ return vmulq_f32(a, b); }
+static inline Lanes_t		DivideLanes(Lanes_t a, Lanes_t b)					{ return vdivq_f32(a, b); }
+static inline Lanes_t		FloorLanes(Lanes_t a)								{ return vrndmq_f32(a); }
+static inline IntLanes_t	ConvertToIntLanes(Lanes_t a)						{ return vreinterpretq_u32_s32(vcvtq_s32_f32(a)); }
+static inline Lanes_t		ConvertToFloatLanes(IntLanes_t a)					{ return vcvtq_f32_s32(vreinterpretq_s32_u32(a)); }
+static inline IntLanes_t	AsIntLanes(Lanes_t a)								{ return vreinterpretq_u32_f32(a); }
+static inline Lanes_t		AsFloatLanes(IntLanes_t a)							{ return vreinterpretq_f32_u32(a); }
+
+static inline IntLanes_t	LoadIntLanes(const int* values)						{ return vld1q_u32(reinterpret_cast<const uint32_t*>(values)); }
+static inline void			StoreIntLanes(unsigned int* out_values, IntLanes_t a) { vst1q_u32(reinterpret_cast<uint32_t*>(out_values), a); }
+static inline IntLanes_t	SplatIntLanes(unsigned int value)					{ return vdupq_n_u32(value); }
+static inline IntLanes_t	AddIntLanes(IntLanes_t a, IntLanes_t b)				{ return vaddq_u32(a, b); }
+static inline IntLanes_t	SubtractIntLanes(IntLanes_t a, IntLanes_t b)		{ return vsubq_u32(a, b); }
+static inline IntLanes_t	MultiplyIntLanes(IntLanes_t a, IntLanes_t b)		{ return vmulq_u32(a, b); }
+static inline IntLanes_t	AndIntLanes(IntLanes_t a, IntLanes_t b)				{ return vandq_u32(a, b); }
+static inline IntLanes_t	AndNotIntLanes(IntLanes_t a, IntLanes_t b)			{ return vbicq_u32(b, a); }				// ~a & b
+static inline IntLanes_t	OrIntLanes(IntLanes_t a, IntLanes_t b)				{ return vorrq_u32(a, b); }
+static inline IntLanes_t	XorIntLanes(IntLanes_t a, IntLanes_t b)				{ return veorq_u32(a, b); }
+static inline IntLanes_t	ShiftRightIntLanes(IntLanes_t a, int bitCount)		{ return vshlq_u32(a, vdupq_n_s32(-bitCount)); }
+static inline IntLanes_t	ShiftLeftIntLanes(IntLanes_t a, int bitCount)		{ return vshlq_u32(a, vdupq_n_s32(bitCount)); }
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns 0 to 3 across the lanes
+//
+static inline IntLanes_t GetLaneIndices()
+{
+	static const uint32_t laneIndices[4] = { 0u, 1u, 2u, 3u };
+	return vld1q_u32(laneIndices);
+}
+
+#else
+
+// Scalar reference - one lane
+typedef float Lanes_t;
+typedef uint32_t IntLanes_t;
+#define LANE_COUNT (1)
+
+static inline Lanes_t		LoadLanes(const float* values)						{ return *values; }
+static inline void			StoreLanes(float* out_values, Lanes_t a)			{ *out_values = a; }
+static inline Lanes_t		SplatLanes(float value)								{ return value; }
+static inline Lanes_t		AddLanes(Lanes_t a, Lanes_t b)						{ return a + b; }
+static inline Lanes_t		SubtractLanes(Lanes_t a, Lanes_t b)					{ return a - b; }
+static inline Lanes_t		MultiplyLanes(Lanes_t a, Lanes_t b)					{ return a * b; }
+static inline Lanes_t		DivideLanes(Lanes_t a, Lanes_t b)					{ return a / b; }
+static inline Lanes_t		FloorLanes(Lanes_t a)								{ return floorf(a); }
+static inline IntLanes_t	ConvertToIntLanes(Lanes_t a)						{ return static_cast<uint32_t>(static_cast<int>(a)); }
+static inline Lanes_t		ConvertToFloatLanes(IntLanes_t a)					{ return static_cast<float>(static_cast<int>(a)); }
+static inline IntLanes_t	AsIntLanes(Lanes_t a)								{ uint32_t bits; memcpy(&bits, &a, sizeof(bits)); return bits; }
+static inline Lanes_t		AsFloatLanes(IntLanes_t a)							{ float value; memcpy(&value, &a, sizeof(value)); return value; }
+
+static inline IntLanes_t	LoadIntLanes(const int* values)						{ return static_cast<uint32_t>(*values); }
+static inline void			StoreIntLanes(unsigned int* out_values, IntLanes_t a) { *out_values = a; }
+static inline IntLanes_t	SplatIntLanes(unsigned int value)					{ return value; }
+static inline IntLanes_t	AddIntLanes(IntLanes_t a, IntLanes_t b)				{ return a + b; }
+static inline IntLanes_t	SubtractIntLanes(IntLanes_t a, IntLanes_t b)		{ return a - b; }
+static inline IntLanes_t	MultiplyIntLanes(IntLanes_t a, IntLanes_t b)		{ return a * b; }
+static inline IntLanes_t	AndIntLanes(IntLanes_t a, IntLanes_t b)				{ return a & b; }
+static inline IntLanes_t	AndNotIntLanes(IntLanes_t a, IntLanes_t b)			{ return ~a & b; }
+static inline IntLanes_t	OrIntLanes(IntLanes_t a, IntLanes_t b)				{ return a | b; }
+static inline IntLanes_t	XorIntLanes(IntLanes_t a, IntLanes_t b)				{ return a ^ b; }
+static inline IntLanes_t	ShiftRightIntLanes(IntLanes_t a, int bitCount)		{ return a >> bitCount; }
+static inline IntLanes_t	ShiftLeftIntLanes(IntLanes_t a, int bitCount)		{ return a << bitCount; }
+static inline IntLanes_t	GetLaneIndices()									{ return 0u; }
+
+#endif
+
+// Shared by every octave loop, the same as the scalar functions
+#define NOISE_OCTAVE_OFFSET (0.636764989593174f)
+
+// Parameters every smooth noise function takes
+struct NoiseSettings_t
+{
+	float			scale;
+	unsigned int	numOctaves;
+	float			octavePersistence;
+	float			octaveScale;
+	bool			renormalize;
+	unsigned int	seed;
+};
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Get1dNoiseUint() on every lane
+//
+static inline IntLanes_t GetNoiseUintLanes(IntLanes_t positionX, unsigned int seed)
+{
+	const unsigned int BIT_NOISE1 = 0xD2A80A23;
+	const unsigned int BIT_NOISE2 = 0xA884F197;
+	const unsigned int BIT_NOISE3 = 0x1B56C4E9;
+
+	IntLanes_t mangledBits = MultiplyIntLanes(positionX, SplatIntLanes(BIT_NOISE1));
+	mangledBits = AddIntLanes(mangledBits, SplatIntLanes(seed));
+	mangledBits = XorIntLanes(mangledBits, ShiftRightIntLanes(mangledBits, 7));
+	mangledBits = AddIntLanes(mangledBits, SplatIntLanes(BIT_NOISE2));
+	mangledBits = XorIntLanes(mangledBits, ShiftRightIntLanes(mangledBits, 8));
+	mangledBits = MultiplyIntLanes(mangledBits, SplatIntLanes(BIT_NOISE3));
+	mangledBits = XorIntLanes(mangledBits, ShiftRightIntLanes(mangledBits, 11));
+
+	return mangledBits;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Get2dNoiseUint() on every lane
+//
+static inline IntLanes_t Get2dNoiseUintLanes(IntLanes_t indexX, IntLanes_t indexY, unsigned int seed)
+{
+	const unsigned int PRIME_NUMBER = 198491317;
+	return GetNoiseUintLanes(AddIntLanes(indexX, MultiplyIntLanes(indexY, SplatIntLanes(PRIME_NUMBER))), seed);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Get3dNoiseUint() on every lane
+//
+static inline IntLanes_t Get3dNoiseUintLanes(IntLanes_t indexX, IntLanes_t indexY, IntLanes_t indexZ, unsigned int seed)
+{
+	const unsigned int PRIME1 = 198491317;
+	const unsigned int PRIME2 = 6542989;
+
+	IntLanes_t index = AddIntLanes(indexX, MultiplyIntLanes(indexY, SplatIntLanes(PRIME1)));
+	index = AddIntLanes(index, MultiplyIntLanes(indexZ, SplatIntLanes(PRIME2)));
+
+	return GetNoiseUintLanes(index, seed);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Maps the noise bits to [0,1] - the lanes only convert signed ints, so the halves are converted separately
+//
+static inline Lanes_t ConvertNoiseToZeroToOneLanes(IntLanes_t noise)
+{
+	Lanes_t highHalf = ConvertToFloatLanes(ShiftRightIntLanes(noise, 16));
+	Lanes_t lowHalf = ConvertToFloatLanes(AndIntLanes(noise, SplatIntLanes(0xFFFF)));
+	Lanes_t asFloat = AddLanes(MultiplyLanes(highHalf, SplatLanes(65536.f)), lowHalf);
+
+	return MultiplyLanes(asFloat, SplatLanes((float) (1.0 / (double) 0xFFFFFFFF)));
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// SmoothStep3() on every lane, in the same order of operations
+//
+static inline Lanes_t SmoothStep3Lanes(Lanes_t t)
+{
+	Lanes_t one = SplatLanes(1.f);
+	Lanes_t flipped = SubtractLanes(one, t);
+	Lanes_t smoothStart = MultiplyLanes(t, t);
+	Lanes_t smoothStop = SubtractLanes(one, MultiplyLanes(flipped, flipped));
+
+	return AddLanes(MultiplyLanes(flipped, smoothStart), MultiplyLanes(t, smoothStop));
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Divides out the total amplitude and pushes the noise towards the extents, as the scalar functions do
+//
+static inline Lanes_t RenormalizeLanes(Lanes_t totalNoise, float totalAmplitude, bool renormalize)
+{
+	if (!renormalize || totalAmplitude <= 0.f)
+	{
+		return totalNoise;
+	}
+
+	Lanes_t half = SplatLanes(0.5f);
+
+	totalNoise = DivideLanes(totalNoise, SplatLanes(totalAmplitude));
+	totalNoise = AddLanes(MultiplyLanes(totalNoise, half), half);
+	totalNoise = SmoothStep3Lanes(totalNoise);
+	totalNoise = SubtractLanes(MultiplyLanes(totalNoise, SplatLanes(2.0f)), SplatLanes(1.f));
+
+	return totalNoise;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Blends between two values on every lane by the weight of the second
+//
+static inline Lanes_t BlendLanes(Lanes_t first, Lanes_t second, Lanes_t secondWeight, Lanes_t firstWeight)
+{
+	return AddLanes(MultiplyLanes(secondWeight, second), MultiplyLanes(firstWeight, first));
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Compute2dFractalNoise() on every lane
+//
+static Lanes_t Compute2dFractalNoiseLanes(Lanes_t posX, Lanes_t posY, const NoiseSettings_t& settings)
+{
+	Lanes_t one = SplatLanes(1.f);
+	Lanes_t totalNoise = SplatLanes(0.f);
+	float totalAmplitude = 0.f;
+	float currentAmplitude = 1.f;
+	float invScale = (1.f / settings.scale);
+	unsigned int seed = settings.seed;
+
+	Lanes_t currentX = MultiplyLanes(posX, SplatLanes(invScale));
+	Lanes_t currentY = MultiplyLanes(posY, SplatLanes(invScale));
+
+	for (unsigned int octaveNum = 0; octaveNum < settings.numOctaves; ++octaveNum)
+	{
+		Lanes_t cellMinsX = FloorLanes(currentX);
+		Lanes_t cellMinsY = FloorLanes(currentY);
+		IntLanes_t indexWestX = ConvertToIntLanes(cellMinsX);
+		IntLanes_t indexSouthY = ConvertToIntLanes(cellMinsY);
+		IntLanes_t indexEastX = AddIntLanes(indexWestX, SplatIntLanes(1));
+		IntLanes_t indexNorthY = AddIntLanes(indexSouthY, SplatIntLanes(1));
+
+		Lanes_t valueSouthWest = ConvertNoiseToZeroToOneLanes(Get2dNoiseUintLanes(indexWestX, indexSouthY, seed));
+		Lanes_t valueSouthEast = ConvertNoiseToZeroToOneLanes(Get2dNoiseUintLanes(indexEastX, indexSouthY, seed));
+		Lanes_t valueNorthWest = ConvertNoiseToZeroToOneLanes(Get2dNoiseUintLanes(indexWestX, indexNorthY, seed));
+		Lanes_t valueNorthEast = ConvertNoiseToZeroToOneLanes(Get2dNoiseUintLanes(indexEastX, indexNorthY, seed));
+
+		Lanes_t weightEast = SmoothStep3Lanes(SubtractLanes(currentX, cellMinsX));
+		Lanes_t weightNorth = SmoothStep3Lanes(SubtractLanes(currentY, cellMinsY));
+		Lanes_t weightWest = SubtractLanes(one, weightEast);
+		Lanes_t weightSouth = SubtractLanes(one, weightNorth);
+
+		Lanes_t blendSouth = BlendLanes(valueSouthWest, valueSouthEast, weightEast, weightWest);
+		Lanes_t blendNorth = BlendLanes(valueNorthWest, valueNorthEast, weightEast, weightWest);
+		Lanes_t blendTotal = AddLanes(MultiplyLanes(weightSouth, blendSouth), MultiplyLanes(weightNorth, blendNorth));
+		Lanes_t noiseThisOctave = MultiplyLanes(SplatLanes(2.f), SubtractLanes(blendTotal, SplatLanes(0.5f)));
+
+		totalNoise = AddLanes(totalNoise, MultiplyLanes(noiseThisOctave, SplatLanes(currentAmplitude)));
+		totalAmplitude += currentAmplitude;
+		currentAmplitude *= settings.octavePersistence;
+		currentX = AddLanes(MultiplyLanes(currentX, SplatLanes(settings.octaveScale)), SplatLanes(NOISE_OCTAVE_OFFSET));
+		currentY = AddLanes(MultiplyLanes(currentY, SplatLanes(settings.octaveScale)), SplatLanes(NOISE_OCTAVE_OFFSET));
+		++seed;
+	}
+
+	return RenormalizeLanes(totalNoise, totalAmplitude, settings.renormalize);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Compute3dFractalNoise() on every lane
+//
+static Lanes_t Compute3dFractalNoiseLanes(Lanes_t posX, Lanes_t posY, Lanes_t posZ, const NoiseSettings_t& settings)
+{
+	Lanes_t one = SplatLanes(1.f);
+	Lanes_t totalNoise = SplatLanes(0.f);
+	float totalAmplitude = 0.f;
+	float currentAmplitude = 1.f;
+	float invScale = (1.f / settings.scale);
+	unsigned int seed = settings.seed;
+
+	Lanes_t currentX = MultiplyLanes(posX, SplatLanes(invScale));
+	Lanes_t currentY = MultiplyLanes(posY, SplatLanes(invScale));
+	Lanes_t currentZ = MultiplyLanes(posZ, SplatLanes(invScale));
+
+	for (unsigned int octaveNum = 0; octaveNum < settings.numOctaves; ++octaveNum)
+	{
+		Lanes_t cellMinsX = FloorLanes(currentX);
+		Lanes_t cellMinsY = FloorLanes(currentY);
+		Lanes_t cellMinsZ = FloorLanes(currentZ);
+		IntLanes_t indexWestX = ConvertToIntLanes(cellMinsX);
+		IntLanes_t indexSouthY = ConvertToIntLanes(cellMinsY);
+		IntLanes_t indexBelowZ = ConvertToIntLanes(cellMinsZ);
+		IntLanes_t indexEastX = AddIntLanes(indexWestX, SplatIntLanes(1));
+		IntLanes_t indexNorthY = AddIntLanes(indexSouthY, SplatIntLanes(1));
+		IntLanes_t indexAboveZ = AddIntLanes(indexBelowZ, SplatIntLanes(1));
+
+		Lanes_t aboveSouthWest = ConvertNoiseToZeroToOneLanes(Get3dNoiseUintLanes(indexWestX, indexSouthY, indexAboveZ, seed));
+		Lanes_t aboveSouthEast = ConvertNoiseToZeroToOneLanes(Get3dNoiseUintLanes(indexEastX, indexSouthY, indexAboveZ, seed));
+		Lanes_t aboveNorthWest = ConvertNoiseToZeroToOneLanes(Get3dNoiseUintLanes(indexWestX, indexNorthY, indexAboveZ, seed));
+		Lanes_t aboveNorthEast = ConvertNoiseToZeroToOneLanes(Get3dNoiseUintLanes(indexEastX, indexNorthY, indexAboveZ, seed));
+		Lanes_t belowSouthWest = ConvertNoiseToZeroToOneLanes(Get3dNoiseUintLanes(indexWestX, indexSouthY, indexBelowZ, seed));
+		Lanes_t belowSouthEast = ConvertNoiseToZeroToOneLanes(Get3dNoiseUintLanes(indexEastX, indexSouthY, indexBelowZ, seed));
+		Lanes_t belowNorthWest = ConvertNoiseToZeroToOneLanes(Get3dNoiseUintLanes(indexWestX, indexNorthY, indexBelowZ, seed));
+		Lanes_t belowNorthEast = ConvertNoiseToZeroToOneLanes(Get3dNoiseUintLanes(indexEastX, indexNorthY, indexBelowZ, seed));
+
+		Lanes_t weightEast = SmoothStep3Lanes(SubtractLanes(currentX, cellMinsX));
+		Lanes_t weightNorth = SmoothStep3Lanes(SubtractLanes(currentY, cellMinsY));
+		Lanes_t weightAbove = SmoothStep3Lanes(SubtractLanes(currentZ, cellMinsZ));
+		Lanes_t weightWest = SubtractLanes(one, weightEast);
+		Lanes_t weightSouth = SubtractLanes(one, weightNorth);
+		Lanes_t weightBelow = SubtractLanes(one, weightAbove);
+
+		Lanes_t blendBelowSouth = BlendLanes(belowSouthWest, belowSouthEast, weightEast, weightWest);
+		Lanes_t blendBelowNorth = BlendLanes(belowNorthWest, belowNorthEast, weightEast, weightWest);
+		Lanes_t blendAboveSouth = BlendLanes(aboveSouthWest, aboveSouthEast, weightEast, weightWest);
+		Lanes_t blendAboveNorth = BlendLanes(aboveNorthWest, aboveNorthEast, weightEast, weightWest);
+		Lanes_t blendBelow = AddLanes(MultiplyLanes(weightSouth, blendBelowSouth), MultiplyLanes(weightNorth, blendBelowNorth));
+		Lanes_t blendAbove = AddLanes(MultiplyLanes(weightSouth, blendAboveSouth), MultiplyLanes(weightNorth, blendAboveNorth));
+		Lanes_t blendTotal = AddLanes(MultiplyLanes(weightBelow, blendBelow), MultiplyLanes(weightAbove, blendAbove));
+		Lanes_t noiseThisOctave = MultiplyLanes(SplatLanes(2.f), SubtractLanes(blendTotal, SplatLanes(0.5f)));
+
+		totalNoise = AddLanes(totalNoise, MultiplyLanes(noiseThisOctave, SplatLanes(currentAmplitude)));
+		totalAmplitude += currentAmplitude;
+		currentAmplitude *= settings.octavePersistence;
+		currentX = AddLanes(MultiplyLanes(currentX, SplatLanes(settings.octaveScale)), SplatLanes(NOISE_OCTAVE_OFFSET));
+		currentY = AddLanes(MultiplyLanes(currentY, SplatLanes(settings.octaveScale)), SplatLanes(NOISE_OCTAVE_OFFSET));
+		currentZ = AddLanes(MultiplyLanes(currentZ, SplatLanes(settings.octaveScale)), SplatLanes(NOISE_OCTAVE_OFFSET));
+		++seed;
+	}
+
+	return RenormalizeLanes(totalNoise, totalAmplitude, settings.renormalize);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Dots the 2D Perlin gradient the noise picks with the displacement, without a table lookup
+// The 8 gradients are (c,s) rotated by 45 degree steps, so from the 3 bits: bits 0^1 swap the components,
+// bits 1^2 flip x, and bit 2 flips y - the same vectors as the scalar table, in the same order
+//
+static inline Lanes_t DotPerlinGradient2dLanes(IntLanes_t noise, Lanes_t displacementX, Lanes_t displacementY)
+{
+	IntLanes_t oneBit = SplatIntLanes(1);
+	IntLanes_t gradientIndex = AndIntLanes(noise, SplatIntLanes(7));
+	IntLanes_t shiftedOnce = ShiftRightIntLanes(gradientIndex, 1);
+	IntLanes_t shiftedTwice = ShiftRightIntLanes(gradientIndex, 2);
+
+	IntLanes_t swapMask = SubtractIntLanes(SplatIntLanes(0), AndIntLanes(XorIntLanes(gradientIndex, shiftedOnce), oneBit));
+	IntLanes_t flipXBit = ShiftLeftIntLanes(AndIntLanes(XorIntLanes(shiftedOnce, shiftedTwice), oneBit), 31);
+	IntLanes_t flipYBit = ShiftLeftIntLanes(AndIntLanes(shiftedTwice, oneBit), 31);
+
+	IntLanes_t longComponent = AsIntLanes(SplatLanes(0.923879533f));
+	IntLanes_t shortComponent = AsIntLanes(SplatLanes(0.382683432f));
+
+	IntLanes_t gradientXBits = OrIntLanes(AndIntLanes(swapMask, shortComponent), AndNotIntLanes(swapMask, longComponent));
+	IntLanes_t gradientYBits = OrIntLanes(AndIntLanes(swapMask, longComponent), AndNotIntLanes(swapMask, shortComponent));
+
+	Lanes_t gradientX = AsFloatLanes(XorIntLanes(gradientXBits, flipXBit));
+	Lanes_t gradientY = AsFloatLanes(XorIntLanes(gradientYBits, flipYBit));
+
+	return AddLanes(MultiplyLanes(gradientX, displacementX), MultiplyLanes(gradientY, displacementY));
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Dots the 3D Perlin gradient the noise picks with the displacement; the gradients point at the cube
+// corners, so bits 0, 1 and 2 flip x, y and z
+//
+static inline Lanes_t DotPerlinGradient3dLanes(IntLanes_t noise, Lanes_t displacementX, Lanes_t displacementY, Lanes_t displacementZ)
+{
+	IntLanes_t oneBit = SplatIntLanes(1);
+	IntLanes_t component = AsIntLanes(SplatLanes(sqrtf(3.f) / 3.f));
+
+	Lanes_t gradientX = AsFloatLanes(XorIntLanes(component, ShiftLeftIntLanes(AndIntLanes(noise, oneBit), 31)));
+	Lanes_t gradientY = AsFloatLanes(XorIntLanes(component, ShiftLeftIntLanes(AndIntLanes(ShiftRightIntLanes(noise, 1), oneBit), 31)));
+	Lanes_t gradientZ = AsFloatLanes(XorIntLanes(component, ShiftLeftIntLanes(AndIntLanes(ShiftRightIntLanes(noise, 2), oneBit), 31)));
+
+	Lanes_t dotXY = AddLanes(MultiplyLanes(gradientX, displacementX), MultiplyLanes(gradientY, displacementY));
+	return AddLanes(dotXY, MultiplyLanes(gradientZ, displacementZ));
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Compute2dPerlinNoise() on every lane
+//
+static Lanes_t Compute2dPerlinNoiseLanes(Lanes_t posX, Lanes_t posY, const NoiseSettings_t& settings)
+{
+	Lanes_t one = SplatLanes(1.f);
+	Lanes_t totalNoise = SplatLanes(0.f);
+	float totalAmplitude = 0.f;
+	float currentAmplitude = 1.f;
+	float invScale = (1.f / settings.scale);
+	unsigned int seed = settings.seed;
+
+	Lanes_t currentX = MultiplyLanes(posX, SplatLanes(invScale));
+	Lanes_t currentY = MultiplyLanes(posY, SplatLanes(invScale));
+
+	for (unsigned int octaveNum = 0; octaveNum < settings.numOctaves; ++octaveNum)
+	{
+		Lanes_t cellMinsX = FloorLanes(currentX);
+		Lanes_t cellMinsY = FloorLanes(currentY);
+		IntLanes_t indexWestX = ConvertToIntLanes(cellMinsX);
+		IntLanes_t indexSouthY = ConvertToIntLanes(cellMinsY);
+		IntLanes_t indexEastX = AddIntLanes(indexWestX, SplatIntLanes(1));
+		IntLanes_t indexNorthY = AddIntLanes(indexSouthY, SplatIntLanes(1));
+
+		Lanes_t fromWestX = SubtractLanes(currentX, cellMinsX);
+		Lanes_t fromSouthY = SubtractLanes(currentY, cellMinsY);
+		Lanes_t fromEastX = SubtractLanes(currentX, AddLanes(cellMinsX, one));
+		Lanes_t fromNorthY = SubtractLanes(currentY, AddLanes(cellMinsY, one));
+
+		Lanes_t dotSouthWest = DotPerlinGradient2dLanes(Get2dNoiseUintLanes(indexWestX, indexSouthY, seed), fromWestX, fromSouthY);
+		Lanes_t dotSouthEast = DotPerlinGradient2dLanes(Get2dNoiseUintLanes(indexEastX, indexSouthY, seed), fromEastX, fromSouthY);
+		Lanes_t dotNorthWest = DotPerlinGradient2dLanes(Get2dNoiseUintLanes(indexWestX, indexNorthY, seed), fromWestX, fromNorthY);
+		Lanes_t dotNorthEast = DotPerlinGradient2dLanes(Get2dNoiseUintLanes(indexEastX, indexNorthY, seed), fromEastX, fromNorthY);
+
+		Lanes_t weightEast = SmoothStep3Lanes(fromWestX);
+		Lanes_t weightNorth = SmoothStep3Lanes(fromSouthY);
+		Lanes_t weightWest = SubtractLanes(one, weightEast);
+		Lanes_t weightSouth = SubtractLanes(one, weightNorth);
+
+		Lanes_t blendSouth = BlendLanes(dotSouthWest, dotSouthEast, weightEast, weightWest);
+		Lanes_t blendNorth = BlendLanes(dotNorthWest, dotNorthEast, weightEast, weightWest);
+		Lanes_t blendTotal = AddLanes(MultiplyLanes(weightSouth, blendSouth), MultiplyLanes(weightNorth, blendNorth));
+		Lanes_t noiseThisOctave = MultiplyLanes(blendTotal, SplatLanes(1.f / 0.662578106f));
+
+		totalNoise = AddLanes(totalNoise, MultiplyLanes(noiseThisOctave, SplatLanes(currentAmplitude)));
+		totalAmplitude += currentAmplitude;
+		currentAmplitude *= settings.octavePersistence;
+		currentX = AddLanes(MultiplyLanes(currentX, SplatLanes(settings.octaveScale)), SplatLanes(NOISE_OCTAVE_OFFSET));
+		currentY = AddLanes(MultiplyLanes(currentY, SplatLanes(settings.octaveScale)), SplatLanes(NOISE_OCTAVE_OFFSET));
+		++seed;
+	}
+
+	return RenormalizeLanes(totalNoise, totalAmplitude, settings.renormalize);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Compute3dPerlinNoise() on every lane
+//
+static Lanes_t Compute3dPerlinNoiseLanes(Lanes_t posX, Lanes_t posY, Lanes_t posZ, const NoiseSettings_t& settings)
+{
+	Lanes_t one = SplatLanes(1.f);
+	Lanes_t totalNoise = SplatLanes(0.f);
+	float totalAmplitude = 0.f;
+	float currentAmplitude = 1.f;
+	float invScale = (1.f / settings.scale);
+	unsigned int seed = settings.seed;
+
+	Lanes_t currentX = MultiplyLanes(posX, SplatLanes(invScale));
+	Lanes_t currentY = MultiplyLanes(posY, SplatLanes(invScale));
+	Lanes_t currentZ = MultiplyLanes(posZ, SplatLanes(invScale));
+
+	for (unsigned int octaveNum = 0; octaveNum < settings.numOctaves; ++octaveNum)
+	{
+		Lanes_t cellMinsX = FloorLanes(currentX);
+		Lanes_t cellMinsY = FloorLanes(currentY);
+		Lanes_t cellMinsZ = FloorLanes(currentZ);
+		IntLanes_t indexWestX = ConvertToIntLanes(cellMinsX);
+		IntLanes_t indexSouthY = ConvertToIntLanes(cellMinsY);
+		IntLanes_t indexBelowZ = ConvertToIntLanes(cellMinsZ);
+		IntLanes_t indexEastX = AddIntLanes(indexWestX, SplatIntLanes(1));
+		IntLanes_t indexNorthY = AddIntLanes(indexSouthY, SplatIntLanes(1));
+		IntLanes_t indexAboveZ = AddIntLanes(indexBelowZ, SplatIntLanes(1));
+
+		Lanes_t fromWestX = SubtractLanes(currentX, cellMinsX);
+		Lanes_t fromSouthY = SubtractLanes(currentY, cellMinsY);
+		Lanes_t fromBelowZ = SubtractLanes(currentZ, cellMinsZ);
+		Lanes_t fromEastX = SubtractLanes(currentX, AddLanes(cellMinsX, one));
+		Lanes_t fromNorthY = SubtractLanes(currentY, AddLanes(cellMinsY, one));
+		Lanes_t fromAboveZ = SubtractLanes(currentZ, AddLanes(cellMinsZ, one));
+
+		Lanes_t dotBelowSW = DotPerlinGradient3dLanes(Get3dNoiseUintLanes(indexWestX, indexSouthY, indexBelowZ, seed), fromWestX, fromSouthY, fromBelowZ);
+		Lanes_t dotBelowSE = DotPerlinGradient3dLanes(Get3dNoiseUintLanes(indexEastX, indexSouthY, indexBelowZ, seed), fromEastX, fromSouthY, fromBelowZ);
+		Lanes_t dotBelowNW = DotPerlinGradient3dLanes(Get3dNoiseUintLanes(indexWestX, indexNorthY, indexBelowZ, seed), fromWestX, fromNorthY, fromBelowZ);
+		Lanes_t dotBelowNE = DotPerlinGradient3dLanes(Get3dNoiseUintLanes(indexEastX, indexNorthY, indexBelowZ, seed), fromEastX, fromNorthY, fromBelowZ);
+		Lanes_t dotAboveSW = DotPerlinGradient3dLanes(Get3dNoiseUintLanes(indexWestX, indexSouthY, indexAboveZ, seed), fromWestX, fromSouthY, fromAboveZ);
+		Lanes_t dotAboveSE = DotPerlinGradient3dLanes(Get3dNoiseUintLanes(indexEastX, indexSouthY, indexAboveZ, seed), fromEastX, fromSouthY, fromAboveZ);
+		Lanes_t dotAboveNW = DotPerlinGradient3dLanes(Get3dNoiseUintLanes(indexWestX, indexNorthY, indexAboveZ, seed), fromWestX, fromNorthY, fromAboveZ);
+		Lanes_t dotAboveNE = DotPerlinGradient3dLanes(Get3dNoiseUintLanes(indexEastX, indexNorthY, indexAboveZ, seed), fromEastX, fromNorthY, fromAboveZ);
+
+		Lanes_t weightEast = SmoothStep3Lanes(fromWestX);
+		Lanes_t weightNorth = SmoothStep3Lanes(fromSouthY);
+		Lanes_t weightAbove = SmoothStep3Lanes(fromBelowZ);
+		Lanes_t weightWest = SubtractLanes(one, weightEast);
+		Lanes_t weightSouth = SubtractLanes(one, weightNorth);
+		Lanes_t weightBelow = SubtractLanes(one, weightAbove);
+
+		Lanes_t blendBelowSouth = BlendLanes(dotBelowSW, dotBelowSE, weightEast, weightWest);
+		Lanes_t blendBelowNorth = BlendLanes(dotBelowNW, dotBelowNE, weightEast, weightWest);
+		Lanes_t blendAboveSouth = BlendLanes(dotAboveSW, dotAboveSE, weightEast, weightWest);
+		Lanes_t blendAboveNorth = BlendLanes(dotAboveNW, dotAboveNE, weightEast, weightWest);
+		Lanes_t blendBelow = AddLanes(MultiplyLanes(weightSouth, blendBelowSouth), MultiplyLanes(weightNorth, blendBelowNorth));
+		Lanes_t blendAbove = AddLanes(MultiplyLanes(weightSouth, blendAboveSouth), MultiplyLanes(weightNorth, blendAboveNorth));
+		Lanes_t blendTotal = AddLanes(MultiplyLanes(weightBelow, blendBelow), MultiplyLanes(weightAbove, blendAbove));
+		Lanes_t noiseThisOctave = MultiplyLanes(blendTotal, SplatLanes(1.f / 0.793856621f));
+
+		totalNoise = AddLanes(totalNoise, MultiplyLanes(noiseThisOctave, SplatLanes(currentAmplitude)));
+		totalAmplitude += currentAmplitude;
+		currentAmplitude *= settings.octavePersistence;
+		currentX = AddLanes(MultiplyLanes(currentX, SplatLanes(settings.octaveScale)), SplatLanes(NOISE_OCTAVE_OFFSET));
+		currentY = AddLanes(MultiplyLanes(currentY, SplatLanes(settings.octaveScale)), SplatLanes(NOISE_OCTAVE_OFFSET));
+		currentZ = AddLanes(MultiplyLanes(currentZ, SplatLanes(settings.octaveScale)), SplatLanes(NOISE_OCTAVE_OFFSET));
+		++seed;
+	}
+
+	return RenormalizeLanes(totalNoise, totalAmplitude, settings.renormalize);
+}
+
+
+// Kernels the drivers below run across arrays and grids
+typedef Lanes_t (*NoiseKernel2d_t)(Lanes_t posX, Lanes_t posY, const NoiseSettings_t& settings);
+typedef Lanes_t (*NoiseKernel3d_t)(Lanes_t posX, Lanes_t posY, Lanes_t posZ, const NoiseSettings_t& settings);
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Runs the kernel across the arrays a group of lanes at a time; the tail is copied out to a full group
+//
+static void RunNoiseBatch(NoiseKernel3d_t kernel, const float* posX, const float* posY, const float* posZ, float* out_noise, int count, const NoiseSettings_t& settings)
+{
+	int index = 0;
+	for (; index + LANE_COUNT <= count; index += LANE_COUNT)
+	{
+		StoreLanes(&out_noise[index], kernel(LoadLanes(&posX[index]), LoadLanes(&posY[index]), LoadLanes(&posZ[index]), settings));
+	}
+
+	if (index < count)
+	{
+		float tailX[LANE_COUNT] = {};
+		float tailY[LANE_COUNT] = {};
+		float tailZ[LANE_COUNT] = {};
+		float tailNoise[LANE_COUNT];
+
+		int tailCount = count - index;
+		for (int laneIndex = 0; laneIndex < tailCount; ++laneIndex)
+		{
+			tailX[laneIndex] = posX[index + laneIndex];
+			tailY[laneIndex] = posY[index + laneIndex];
+			tailZ[laneIndex] = posZ[index + laneIndex];
+		}
+
+		StoreLanes(tailNoise, kernel(LoadLanes(tailX), LoadLanes(tailY), LoadLanes(tailZ), settings));
+
+		for (int laneIndex = 0; laneIndex < tailCount; ++laneIndex)
+		{
+			out_noise[index + laneIndex] = tailNoise[laneIndex];
+		}
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// 2D version of the above
+//
+static void RunNoiseBatch(NoiseKernel2d_t kernel, const float* posX, const float* posY, float* out_noise, int count, const NoiseSettings_t& settings)
+{
+	int index = 0;
+	for (; index + LANE_COUNT <= count; index += LANE_COUNT)
+	{
+		StoreLanes(&out_noise[index], kernel(LoadLanes(&posX[index]), LoadLanes(&posY[index]), settings));
+	}
+
+	if (index < count)
+	{
+		float tailX[LANE_COUNT] = {};
+		float tailY[LANE_COUNT] = {};
+		float tailNoise[LANE_COUNT];
+
+		int tailCount = count - index;
+		for (int laneIndex = 0; laneIndex < tailCount; ++laneIndex)
+		{
+			tailX[laneIndex] = posX[index + laneIndex];
+			tailY[laneIndex] = posY[index + laneIndex];
+		}
+
+		StoreLanes(tailNoise, kernel(LoadLanes(tailX), LoadLanes(tailY), settings));
+
+		for (int laneIndex = 0; laneIndex < tailCount; ++laneIndex)
+		{
+			out_noise[index + laneIndex] = tailNoise[laneIndex];
+		}
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Runs the kernel over the grid's rows, split across the JobSystem if asked; a 2D kernel ignores posZ
+// Sample positions are computed from the integer coords each time, so a row is the same as the scalar
+// origin + x * spacing, rather than drifting from adding up the spacing
+//
+static void RunNoiseGrid(NoiseKernel2d_t kernel2d, NoiseKernel3d_t kernel3d, float* out_noise, const IntVector2& dimensions, const Vector2& origin, const Vector2& spacing, float posZ, const NoiseSettings_t& settings, bool useJobs)
+{
+	if (dimensions.x <= 0 || dimensions.y <= 0)
+	{
+		return;
+	}
+
+	int rowsPerJob = (useJobs ? NOISE_GRID_ROWS_PER_JOB : dimensions.y);
+
+	ParallelForRange(0, dimensions.y, rowsPerJob, [&](int rowBegin, int rowEnd)
+	{
+		Lanes_t laneZ = SplatLanes(posZ);
+
+		for (int yIndex = rowBegin; yIndex < rowEnd; ++yIndex)
+		{
+			Lanes_t laneY = SplatLanes(origin.y + (float) yIndex * spacing.y);
+			float* rowNoise = &out_noise[yIndex * dimensions.x];
+
+			for (int xIndex = 0; xIndex < dimensions.x; xIndex += LANE_COUNT)
+			{
+				IntLanes_t laneIndices = AddIntLanes(SplatIntLanes((unsigned int) xIndex), GetLaneIndices());
+				Lanes_t laneX = AddLanes(SplatLanes(origin.x), MultiplyLanes(ConvertToFloatLanes(laneIndices), SplatLanes(spacing.x)));
+
+				Lanes_t noise = (kernel2d != nullptr ? kernel2d(laneX, laneY, settings) : kernel3d(laneX, laneY, laneZ, settings));
+
+				if (xIndex + LANE_COUNT <= dimensions.x)
+				{
+					StoreLanes(&rowNoise[xIndex], noise);
+				}
+				else
+				{
+					// Lanes past the row end sampled valid positions, they just aren't kept
+					float tailNoise[LANE_COUNT];
+					StoreLanes(tailNoise, noise);
+
+					for (int laneIndex = 0; xIndex + laneIndex < dimensions.x; ++laneIndex)
+					{
+						rowNoise[xIndex + laneIndex] = tailNoise[laneIndex];
+					}
+				}
+			}
+		}
+	});
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Packs the parameters every function takes
+//
+static NoiseSettings_t MakeNoiseSettings(float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed)
+{
+	NoiseSettings_t settings;
+
+	settings.scale = scale;
+	settings.numOctaves = numOctaves;
+	settings.octavePersistence = octavePersistence;
+	settings.octaveScale = octaveScale;
+	settings.renormalize = renormalize;
+	settings.seed = seed;
+
+	return settings;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of points each kernel evaluates at once
+//
+int GetNoiseBatchLaneCount()
+{
+	return LANE_COUNT;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Raw noise for every index
+//
+void Get1dNoiseUintBatch(const int* indices, unsigned int* out_noise, int count, unsigned int seed)
+{
+	int index = 0;
+	for (; index + LANE_COUNT <= count; index += LANE_COUNT)
+	{
+		StoreIntLanes(&out_noise[index], GetNoiseUintLanes(LoadIntLanes(&indices[index]), seed));
+	}
+
+	if (index < count)
+	{
+		int tailIndices[LANE_COUNT] = {};
+		unsigned int tailNoise[LANE_COUNT];
+
+		for (int laneIndex = 0; index + laneIndex < count; ++laneIndex)
+		{
+			tailIndices[laneIndex] = indices[index + laneIndex];
+		}
+
+		StoreIntLanes(tailNoise, GetNoiseUintLanes(LoadIntLanes(tailIndices), seed));
+
+		for (int laneIndex = 0; index + laneIndex < count; ++laneIndex)
+		{
+			out_noise[index + laneIndex] = tailNoise[laneIndex];
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Compute2dFractalNoise() at every point
+//
+void Compute2dFractalNoiseBatch(const float* posX, const float* posY, float* out_noise, int count, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed)
+{
+	NoiseSettings_t settings = MakeNoiseSettings(scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+	RunNoiseBatch(Compute2dFractalNoiseLanes, posX, posY, out_noise, count, settings);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Compute3dFractalNoise() at every point
+//
+void Compute3dFractalNoiseBatch(const float* posX, const float* posY, const float* posZ, float* out_noise, int count, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed)
+{
+	NoiseSettings_t settings = MakeNoiseSettings(scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+	RunNoiseBatch(Compute3dFractalNoiseLanes, posX, posY, posZ, out_noise, count, settings);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Compute2dPerlinNoise() at every point
+//
+void Compute2dPerlinNoiseBatch(const float* posX, const float* posY, float* out_noise, int count, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed)
+{
+	NoiseSettings_t settings = MakeNoiseSettings(scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+	RunNoiseBatch(Compute2dPerlinNoiseLanes, posX, posY, out_noise, count, settings);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Compute3dPerlinNoise() at every point
+//
+void Compute3dPerlinNoiseBatch(const float* posX, const float* posY, const float* posZ, float* out_noise, int count, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed)
+{
+	NoiseSettings_t settings = MakeNoiseSettings(scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+	RunNoiseBatch(Compute3dPerlinNoiseLanes, posX, posY, posZ, out_noise, count, settings);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Compute2dFractalNoise() across the grid
+//
+void Compute2dFractalNoiseGrid(float* out_noise, const IntVector2& dimensions, const Vector2& origin, const Vector2& spacing, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed, bool useJobs)
+{
+	NoiseSettings_t settings = MakeNoiseSettings(scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+	RunNoiseGrid(Compute2dFractalNoiseLanes, nullptr, out_noise, dimensions, origin, spacing, 0.f, settings, useJobs);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Compute2dPerlinNoise() across the grid
+//
+void Compute2dPerlinNoiseGrid(float* out_noise, const IntVector2& dimensions, const Vector2& origin, const Vector2& spacing, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed, bool useJobs)
+{
+	NoiseSettings_t settings = MakeNoiseSettings(scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+	RunNoiseGrid(Compute2dPerlinNoiseLanes, nullptr, out_noise, dimensions, origin, spacing, 0.f, settings, useJobs);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Compute3dFractalNoise() across the grid, at the height posZ
+//
+void Compute3dFractalNoiseGrid(float* out_noise, const IntVector2& dimensions, const Vector2& origin, const Vector2& spacing, float posZ, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed, bool useJobs)
+{
+	NoiseSettings_t settings = MakeNoiseSettings(scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+	RunNoiseGrid(nullptr, Compute3dFractalNoiseLanes, out_noise, dimensions, origin, spacing, posZ, settings, useJobs);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Compute3dPerlinNoise() across the grid, at the height posZ
+//
+void Compute3dPerlinNoiseGrid(float* out_noise, const IntVector2& dimensions, const Vector2& origin, const Vector2& spacing, float posZ, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed, bool useJobs)
+{
+	NoiseSettings_t settings = MakeNoiseSettings(scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+	RunNoiseGrid(nullptr, Compute3dPerlinNoiseLanes, out_noise, dimensions, origin, spacing, posZ, settings, useJobs);
+}
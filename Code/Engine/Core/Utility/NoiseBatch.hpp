@@ -0,0 +1,46 @@
+/************************************************************************/
+/* File: NoiseBatch.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: SIMD versions of the RawNoise and SmoothNoise functions,
+/*				evaluating arrays of points or whole grids at a time; the
+/*				scalar functions stay as the reference
+/************************************************************************/
+#pragma once
+#include "Engine/Math/Vector2.hpp"
+#include "Engine/Math/Vector3.hpp"
+#include "Engine/Math/IntVector2.hpp"
+
+// Rows of a grid given to each job
+#define NOISE_GRID_ROWS_PER_JOB (16)
+
+// Which kernels were compiled in - 8 lanes with AVX2, 4 with SSE2 or NEON, or 1 without SIMD
+int GetNoiseBatchLaneCount();
+
+
+//-----------------------------------------------------------------------------------------------
+// Raw noise for count indices at once, the same bits as Get1dNoiseUint()
+//
+void Get1dNoiseUintBatch( const int* indices, unsigned int* out_noise, int count, unsigned int seed=0 );
+
+
+//-----------------------------------------------------------------------------------------------
+// Smooth noise at count points, the points given as separate arrays of components
+// Parameters are the same as the SmoothNoise functions; results match them to within float rounding,
+//	as the scalar ones map the raw noise to floats in doubles
+//
+void Compute2dFractalNoiseBatch( const float* posX, const float* posY, float* out_noise, int count, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0 );
+void Compute3dFractalNoiseBatch( const float* posX, const float* posY, const float* posZ, float* out_noise, int count, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0 );
+void Compute2dPerlinNoiseBatch( const float* posX, const float* posY, float* out_noise, int count, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0 );
+void Compute3dPerlinNoiseBatch( const float* posX, const float* posY, const float* posZ, float* out_noise, int count, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0 );
+
+
+//-----------------------------------------------------------------------------------------------
+// Smooth noise on a 2D grid, sampled at origin + (x, y) * spacing and written row by row from the bottom
+// out_noise needs dimensions.x * dimensions.y floats; 3D grids are the z = posZ slice
+// With useJobs the rows are split across the JobSystem, NOISE_GRID_ROWS_PER_JOB at a time
+//
+void Compute2dFractalNoiseGrid( float* out_noise, const IntVector2& dimensions, const Vector2& origin, const Vector2& spacing, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0, bool useJobs=true );
+void Compute2dPerlinNoiseGrid( float* out_noise, const IntVector2& dimensions, const Vector2& origin, const Vector2& spacing, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0, bool useJobs=true );
+void Compute3dFractalNoiseGrid( float* out_noise, const IntVector2& dimensions, const Vector2& origin, const Vector2& spacing, float posZ, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0, bool useJobs=true );
+void Compute3dPerlinNoiseGrid( float* out_noise, const IntVector2& dimensions, const Vector2& origin, const Vector2& spacing, float posZ, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0, bool useJobs=true );
@@ -0,0 +1,86 @@
+/************************************************************************/
+/* File: StringID.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the StringID intern table
+/************************************************************************/
+#include "Engine/Core/Utility/StringID.hpp"
+#include "Engine/Core/Utility/StringUtils.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+
+#ifdef STRING_ID_REVERSE_LOOKUP
+#include <string>
+#include <shared_mutex>
+#include <unordered_map>
+
+// Only inserted into, and map nodes don't move, so the text pointers handed out stay valid
+static std::shared_mutex						s_internLock;
+static std::unordered_map<StringID, std::string>	s_internedText;
+#endif
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the ID of the text, recording the text for the reverse lookup if it's on
+//
+StringID InternStringID(std::string_view text)
+{
+	StringID id = HashStringID(text);
+
+#ifdef STRING_ID_REVERSE_LOOKUP
+	s_internLock.lock_shared();
+	std::unordered_map<StringID, std::string>::const_iterator itr = s_internedText.find(id);
+	bool isInterned = (itr != s_internedText.end());
+	bool isCollision = (isInterned && itr->second != text);
+	s_internLock.unlock_shared();
+
+	if (!isInterned)
+	{
+		s_internLock.lock();
+		std::pair<std::unordered_map<StringID, std::string>::iterator, bool> result = s_internedText.insert(std::make_pair(id, std::string(text)));
+		isCollision = (!result.second && result.first->second != text);
+		s_internLock.unlock();
+	}
+
+	GUARANTEE_OR_DIE(!isCollision, Stringf("Error: InternStringID() found \"%.*s\" hashes the same as \"%s\", rename one", (int) text.size(), text.data(), GetStringIDText(id)));
+#endif
+
+	return id;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the text interned for the ID, or the number if there isn't any
+//
+const char* GetStringIDText(StringID id)
+{
+#ifdef STRING_ID_REVERSE_LOOKUP
+	s_internLock.lock_shared();
+	std::unordered_map<StringID, std::string>::const_iterator itr = s_internedText.find(id);
+	const char* text = (itr != s_internedText.end() ? itr->second.c_str() : nullptr);
+	s_internLock.unlock_shared();
+
+	if (text != nullptr)
+	{
+		return text;
+	}
+#endif
+
+	return StringfTemp("#%08x", id);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of IDs with their text kept
+//
+int GetInternedStringIDCount()
+{
+#ifdef STRING_ID_REVERSE_LOOKUP
+	s_internLock.lock_shared();
+	int count = (int) s_internedText.size();
+	s_internLock.unlock_shared();
+
+	return count;
+#else
+	return 0;
+#endif
+}
@@ -0,0 +1,51 @@
+/************************************************************************/
+/* File: StringID.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Interned string IDs - names hashed once, with FNV-1a, so
+/*				lookups and compares are on 32-bit IDs instead of strings
+/************************************************************************/
+#pragma once
+#include <stdint.h>
+#include <string_view>
+#include <type_traits>
+
+typedef uint32_t StringID;
+
+// FNV-1a of nothing, so an empty name
+#define EMPTY_STRING_ID (2166136261u)
+
+// Debug builds keep the text of every interned ID, to show in place of a bare number and to catch
+// two names that hash the same; define it to keep them in any build
+#if defined(_DEBUG) && !defined(STRING_ID_REVERSE_LOOKUP)
+#define STRING_ID_REVERSE_LOOKUP
+#endif
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Hashes the text into its ID - constexpr, so SID() of a literal is worked out at compile time
+// Doesn't intern, so is free to call from any thread on every lookup
+//
+constexpr StringID HashStringID(std::string_view text)
+{
+	uint32_t hash = 2166136261u;
+
+	for (size_t charIndex = 0; charIndex < text.size(); ++charIndex)
+	{
+		hash = (hash ^ (uint32_t) (uint8_t) text[charIndex]) * 16777619u;
+	}
+
+	return hash;
+}
+
+// Forces the hash of a literal to compile time, i.e. SID("DebugRenderPass")
+#define SID(text) (std::integral_constant<StringID, HashStringID(text)>::value)
+
+// Hashes the text and, with the reverse lookup on, records it for GetStringIDText()
+// Call where a name is registered (assets added, events created, bones made...), not on lookups
+StringID	InternStringID(std::string_view text);
+
+// The interned text of the ID; without the reverse lookup, or if it was never interned, a temp
+// string of the number - valid until the next call on the same thread, like StringfTemp()
+const char*	GetStringIDText(StringID id);
+
+int			GetInternedStringIDCount();		// 0 without the reverse lookup
@@ -1,5 +1,6 @@
 #include <cstring>
 #include <stdarg.h>
+#include <charconv>
 #include "Engine/Core/Utility/StringUtils.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 
@@ -15,16 +16,37 @@ const int STRINGF_STACK_LOCAL_TEMP_LENGTH = 2048;
 
 
 //-----------------------------------------------------------------------------------------------
+// Formats on the stack, and only if it doesn't fit there formats again into the string at its full length
+//
 const std::string Stringf( const char* format, ... )
 {
 	char textLiteral[ STRINGF_STACK_LOCAL_TEMP_LENGTH ];
 	va_list variableArgumentList;
 	va_start( variableArgumentList, format );
-	vsnprintf_s( textLiteral, STRINGF_STACK_LOCAL_TEMP_LENGTH, _TRUNCATE, format, variableArgumentList );	
+
+	va_list argumentListCopy;
+	va_copy( argumentListCopy, variableArgumentList );
+
+	int length = vsnprintf( textLiteral, STRINGF_STACK_LOCAL_TEMP_LENGTH, format, variableArgumentList );
 	va_end( variableArgumentList );
-	textLiteral[ STRINGF_STACK_LOCAL_TEMP_LENGTH - 1 ] = '\0'; // In case vsnprintf overran (doesn't auto-terminate)
 
-	return std::string( textLiteral );
+	if (length < 0)
+	{
+		va_end( argumentListCopy );
+		return std::string();
+	}
+
+	if (length < STRINGF_STACK_LOCAL_TEMP_LENGTH)
+	{
+		va_end( argumentListCopy );
+		return std::string( textLiteral, length );
+	}
+
+	std::string result( (size_t) length, '\0' );
+	vsnprintf( &result[0], length + 1, format, argumentListCopy );
+	va_end( argumentListCopy );
+
+	return result;
 }
 
 
@@ -50,36 +72,173 @@ const std::string Stringf( const int maxLength, const char* format, ... )
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Formats into the buffer given, truncating if it doesn't fit; returns the number of characters written
+//
+int StringfToBuffer(char* out_buffer, int bufferSize, const char* format, ...)
+{
+	va_list variableArgumentList;
+	va_start( variableArgumentList, format );
+	int length = StringvToBuffer(out_buffer, bufferSize, format, variableArgumentList);
+	va_end( variableArgumentList );
+
+	return length;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Formats the argument list into the buffer given, truncating if it doesn't fit; returns the number of characters written
+//
+int StringvToBuffer(char* out_buffer, int bufferSize, const char* format, va_list args)
+{
+	if (bufferSize <= 0)
+	{
+		return 0;
+	}
+
+	int length = vsnprintf(out_buffer, bufferSize, format, args);
+
+	if (length < 0)
+	{
+		out_buffer[0] = '\0';
+		return 0;
+	}
+
+	return (length < bufferSize ? length : bufferSize - 1);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Formats into this thread's temp buffer, which is overwritten by the next call on the thread
+//
+const char* StringfTemp(const char* format, ...)
+{
+	thread_local char s_tempBuffer[STRINGF_STACK_LOCAL_TEMP_LENGTH];
+
+	va_list variableArgumentList;
+	va_start( variableArgumentList, format );
+	StringvToBuffer(s_tempBuffer, STRINGF_STACK_LOCAL_TEMP_LENGTH, format, variableArgumentList);
+	va_end( variableArgumentList );
+
+	return s_tempBuffer;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 const std::vector<std::string> Tokenize(const std::string& stringToTokenize, const char delimiter)
 {
 	std::vector<std::string> tokens;
-	
-	// Set up the substring indices
-	size_t subStringStartIndex = stringToTokenize.find_first_not_of(delimiter);
-	if (subStringStartIndex == std::string::npos) { return tokens; }	// Return if the entire string is just delimiters
-	size_t subStringEndPostion = stringToTokenize.find(delimiter, subStringStartIndex + 1);
-
-	// Iterate across the entire string
-	while (subStringEndPostion != std::string::npos)
+
+	std::string_view remainingText = stringToTokenize;
+	std::string_view token;
+
+	while (GetNextToken(remainingText, delimiter, token))
 	{
-		// Create the substring
-		size_t substringLength = (subStringEndPostion - subStringStartIndex);
-		tokens.push_back(std::string(stringToTokenize, subStringStartIndex, substringLength));
-
-		// Update the indices
-		subStringStartIndex = stringToTokenize.find_first_not_of(delimiter, subStringEndPostion + 1);
-		if (subStringStartIndex == std::string::npos) { return tokens; } // Return if the rest of the string is just delimiters
-		subStringEndPostion = stringToTokenize.find(delimiter, subStringStartIndex + 1);
+		tokens.emplace_back(token);
 	}
 
-	// Add the rest of the string
-	tokens.push_back(std::string(stringToTokenize, subStringStartIndex));
-
 	return tokens;
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Takes the next token off the front of the text, skipping any delimiters before it
+// Returns false if there's nothing but delimiters left
+//
+bool GetNextToken(std::string_view& inout_text, const char delimiter, std::string_view& out_token)
+{
+	size_t tokenStart = inout_text.find_first_not_of(delimiter);
+	if (tokenStart == std::string_view::npos)
+	{
+		inout_text = std::string_view();
+		return false;
+	}
+
+	size_t tokenEnd = inout_text.find(delimiter, tokenStart + 1);
+	if (tokenEnd == std::string_view::npos)
+	{
+		out_token = inout_text.substr(tokenStart);
+		inout_text = std::string_view();
+	}
+	else
+	{
+		out_token = inout_text.substr(tokenStart, tokenEnd - tokenStart);
+		inout_text = inout_text.substr(tokenEnd + 1);
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Splits the text into views of its tokens, same as Tokenize(); returns the number of tokens
+//
+int TokenizeView(std::string_view text, const char delimiter, std::vector<std::string_view>& out_tokens)
+{
+	out_tokens.clear();
+
+	std::string_view token;
+	while (GetNextToken(text, delimiter, token))
+	{
+		out_tokens.push_back(token);
+	}
+
+	return (int) out_tokens.size();
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the start of the number in the text, past any leading whitespace and '+' that from_chars doesn't take
+//
+static const char* GetNumberStart(std::string_view text)
+{
+	const char* current = text.data();
+	const char* end = text.data() + text.size();
+
+	while (current < end && (*current == ' ' || *current == '\t' || *current == '\r' || *current == '\n'))
+	{
+		++current;
+	}
+
+	if (current < end && *current == '+')
+	{
+		++current;
+	}
+
+	return current;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Parses the float at the front of the text
+//
+bool ParseFloat(std::string_view text, float& out_value)
+{
+	std::from_chars_result result = std::from_chars(GetNumberStart(text), text.data() + text.size(), out_value);
+	return (result.ec == std::errc());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Parses the int at the front of the text
+//
+bool ParseInt(std::string_view text, int& out_value)
+{
+	std::from_chars_result result = std::from_chars(GetNumberStart(text), text.data() + text.size(), out_value);
+	return (result.ec == std::errc());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Parses the unsigned int at the front of the text
+//
+bool ParseUnsignedInt(std::string_view text, unsigned int& out_value)
+{
+	std::from_chars_result result = std::from_chars(GetNumberStart(text), text.data() + text.size(), out_value);
+	return (result.ec == std::errc());
+}
+
+
 //-----------------------------------------------------------------------------------------------
 int GetStringLength(const char* string)
 {
@@ -126,16 +285,22 @@ bool IsStringNullOrEmpty(const std::string& string)
 
 
 //-----------------------------------------------------------------------------------------------
-float StringToFloat(const std::string& text)
+float StringToFloat(std::string_view text)
 {
-	return (float) atof(text.c_str());
+	float value = 0.f;
+	ParseFloat(text, value);
+
+	return value;
 }
 
 //-----------------------------------------------------------------------------------------------
 
-int StringToInt(const std::string& text)
+int StringToInt(std::string_view text)
 {
-	return atoi(text.c_str());
+	int value = 0;
+	ParseInt(text, value);
+
+	return value;
 }
 
 
@@ -164,7 +329,7 @@ bool StringToBool(const std::string& text, bool& out_bool)
 //
 bool SetFromText(const std::string& text, Vector3& out_val)
 {
-	size_t firstComma = static_cast<int>(text.find(","));
+	size_t firstComma = text.find(",");
 
 	// No comma present in text
 	if (firstComma == std::string::npos)
@@ -181,9 +346,10 @@ bool SetFromText(const std::string& text, Vector3& out_val)
 	}
 
 	// Set the values
-	out_val.x = static_cast<float>(atof(std::string(text, 0, firstComma).c_str()));
-	out_val.y = static_cast<float>(atof(std::string(text, firstComma + 1, secondComma - firstComma - 1).c_str()));
-	out_val.z = static_cast<float>(atof(std::string(text, secondComma + 1).c_str()));
+	std::string_view textView = text;
+	out_val.x = StringToFloat(textView.substr(0, firstComma));
+	out_val.y = StringToFloat(textView.substr(firstComma + 1, secondComma - firstComma - 1));
+	out_val.z = StringToFloat(textView.substr(secondComma + 1));
 
 	return true;
 }
@@ -194,8 +360,7 @@ bool SetFromText(const std::string& text, Vector3& out_val)
 //
 bool SetFromText(const std::string& text, float& out_value)
 {
-	out_value = (float) atof(text.c_str());
-	return true;
+	return ParseFloat(text, out_value);
 }
 
 
@@ -204,8 +369,7 @@ bool SetFromText(const std::string& text, float& out_value)
 //
 bool SetFromText(const std::string& text, int& out_value)
 {
-	out_value = atoi(text.c_str());
-	return true;
+	return ParseInt(text, out_value);
 }
 
 
@@ -214,8 +378,7 @@ bool SetFromText(const std::string& text, int& out_value)
 //
 bool SetFromText(const std::string& text, unsigned int& out_value)
 {
-	out_value = atoi(text.c_str());
-	return true;
+	return ParseUnsignedInt(text, out_value);
 }
 
 
@@ -264,8 +427,9 @@ bool SetFromText(const std::string& text, Vector2& out_value)
 	}
 
 	// Set the values
-	out_value.x = static_cast<float>(atof(std::string(text, 0, firstComma).c_str()));
-	out_value.y = static_cast<float>(atof(std::string(text, firstComma + 1).c_str()));
+	std::string_view textView = text;
+	out_value.x = StringToFloat(textView.substr(0, firstComma));
+	out_value.y = StringToFloat(textView.substr(firstComma + 1));
 
 	return true;
 }
@@ -286,8 +450,15 @@ bool SetFromText(const std::string& text, std::string& out_value)
 //
 bool SetFromText(const std::string& text, unsigned short& out_value)
 {
-	out_value = (unsigned short) atoi(text.c_str());
-	return true;
+	unsigned int value = 0;
+	bool succeeded = ParseUnsignedInt(text, value);
+
+	if (succeeded)
+	{
+		out_value = (unsigned short) value;
+	}
+
+	return succeeded;
 }
 
 
@@ -296,9 +467,20 @@ bool SetFromText(const std::string& text, unsigned short& out_value)
 //
 bool SetFromText(const std::string& text, IntVector3& out_value)
 {
-	std::vector<std::string> tokens = Tokenize(text, ' ');
+	std::string_view remainingText = text;
+	std::string_view tokens[3];
+
+	for (int tokenIndex = 0; tokenIndex < 3; ++tokenIndex)
+	{
+		if (!GetNextToken(remainingText, ' ', tokens[tokenIndex]))
+		{
+			return false;
+		}
+	}
 
-	if (tokens.size() != 3)
+	// Exactly three
+	std::string_view extraToken;
+	if (GetNextToken(remainingText, ' ', extraToken))
 	{
 		return false;
 	}
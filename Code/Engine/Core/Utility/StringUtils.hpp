@@ -2,6 +2,9 @@
 //-----------------------------------------------------------------------------------------------
 #include <string>
 #include <vector>
+#include <stdarg.h>
+#include <stdint.h>
+#include <string_view>
 
 class Vector2;
 class Vector3;
@@ -13,16 +16,35 @@ class NamedProperties;
 //-----------------------------------------------------------------------------------------------
 const std::string Stringf( const char* format, ... );
 const std::string Stringf( const int maxLength, const char* format, ... );
+
+// Format into the caller's buffer without allocating, truncating to fit; returns the length written
+int StringfToBuffer(char* out_buffer, int bufferSize, const char* format, ...);
+int StringvToBuffer(char* out_buffer, int bufferSize, const char* format, va_list args);
+
+// Formats into a thread local buffer, valid until the next call on the same thread - for passing straight on
+const char* StringfTemp(const char* format, ...);
+
 const std::vector<std::string> Tokenize(const std::string& stringToTokenize, const char delimiter);
 
+// Tokenizing without copying - the views point into the text, so mustn't outlive it
+// GetNextToken() consumes the next token from the front of the text, returning false once there are none
+bool GetNextToken(std::string_view& inout_text, const char delimiter, std::string_view& out_token);
+int  TokenizeView(std::string_view text, const char delimiter, std::vector<std::string_view>& out_tokens);	// Replaces out_tokens' contents, keeping its capacity
+
+// Parses the number at the front of the text, after any whitespace or '+', like atof/atoi but without copying or locale
+// Returns false, leaving out_value alone, if there isn't one
+bool ParseFloat(std::string_view text, float& out_value);
+bool ParseInt(std::string_view text, int& out_value);
+bool ParseUnsignedInt(std::string_view text, unsigned int& out_value);
+
 int GetStringLength(const char* string);
 int GetCharacterCount(const std::string& text, const char character);
 
 bool IsStringNullOrEmpty(const char* string);
 bool IsStringNullOrEmpty(const std::string& string);
 
-float StringToFloat(const std::string& text);
-int StringToInt(const std::string& text);
+float StringToFloat(std::string_view text);	// 0 if the text isn't a number
+int StringToInt(std::string_view text);
 
 bool SetFromText(const std::string& text, float& out_value);
 bool SetFromText(const std::string& text, int& out_value);
@@ -17,6 +17,48 @@
 #include "Engine/Math/IntVector2.hpp"
 #include "Engine/Math/IntVector3.hpp"
 #include "Engine/Math/AABB2.hpp"
+#include "Engine/Core/File.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Assets/CookedXmlFile.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// Parses the file into the document, returning the same errors as XMLDocument::LoadFile()
+// tinyxml still copies the text for its in place parsing, but straight from the mapped pages
+// If the file has been cooked the document is built from the .cxml instead, as long as it was cooked
+// from this version of the source - or always, if the source wasn't shipped
+//
+XMLError LoadXmlDocument(XMLDocument& out_document, const std::string& filepath)
+{
+	std::string cookedPath = CookedXmlFile::GetCookedPath(filepath);
+	bool isCookedPath = (cookedPath == filepath);
+
+	File file;
+	bool hasSource = !isCookedPath && file.OpenMapped(filepath.c_str());
+
+	CookedXmlFile cookedFile;
+	if (cookedFile.LoadFromFile(cookedPath))
+	{
+		if (!hasSource || !cookedFile.IsStale(file.GetData(), file.GetSize()))
+		{
+			file.Close();
+			return cookedFile.BuildDocument(out_document);
+		}
+
+		LogTaggedPrintf("ASSETS", "\"%s\" changed since it was cooked, parsing the source instead", filepath.c_str());
+	}
+
+	if (!hasSource)
+	{
+		out_document.Clear();
+		return tinyxml2::XML_ERROR_FILE_NOT_FOUND;
+	}
+
+	XMLError error = out_document.Parse(file.GetData(), file.GetSize());
+	file.Close();
+
+	return error;
+}
 
 //-----------------------------------------------------------------------------------------------
 // Gets an attribute value and returns it as an int
@@ -24,6 +24,10 @@ class IntVector2;
 class IntVector3;
 class AABB2;
 
+// Maps the file and parses it from the mapping, rather than reading it into a buffer of its own first
+// A cooked .cxml next to it is used instead when it's up to date, see CookedXmlFile
+XMLError		LoadXmlDocument(XMLDocument& out_document, const std::string& filepath);
+
 int				ParseXmlAttribute( const XMLElement& element, const char* attributeName, int defaultValue );
 unsigned int	ParseXmlAttribute(const XMLElement& element, const char* attributeName, unsigned int defaultValue);
 char			ParseXmlAttribute( const XMLElement& element, const char* attributeName, char defaultValue );
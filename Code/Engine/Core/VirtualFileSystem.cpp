@@ -0,0 +1,370 @@
+/************************************************************************/
+/* File: VirtualFileSystem.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the VirtualFileSystem class
+/************************************************************************/
+#include <ctype.h>
+#include <algorithm>
+#include "Engine/Core/File.hpp"
+#include "Engine/Core/PackFile.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/VirtualFileSystem.hpp"
+#include "Engine/Core/DeveloperConsole/Command.hpp"
+#include "Engine/Core/DeveloperConsole/DevConsole.hpp"
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+
+std::vector<PackFile*>		VirtualFileSystem::s_packs;
+std::mutex					VirtualFileSystem::s_packLock;
+std::once_flag				VirtualFileSystem::s_defaultMountFlag;
+std::atomic<uint64_t>		VirtualFileSystem::s_packHitCount(0);
+std::atomic<uint64_t>		VirtualFileSystem::s_packMissCount(0);
+
+// C functions
+void Command_VirtualFileSystem(Command& cmd);
+void Command_MountPack(Command& cmd);
+void Command_BuildPack(Command& cmd);
+
+
+//-----------------------------------------------------------------------------------------------
+// Mounts the packs in VFS_PACK_DIRECTORY, if no lookup has already
+//
+void VirtualFileSystem::Initialize()
+{
+	std::call_once(s_defaultMountFlag, MountDefaultPacks);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Unmounts every pack, lookups after this go to disk
+//
+void VirtualFileSystem::Shutdown()
+{
+	// Consumes the flag if nothing was looked up yet, so the default packs aren't mounted again
+	std::call_once(s_defaultMountFlag, []() {});
+	UnmountAllPacks();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Registers the pack commands
+//
+void VirtualFileSystem::InitializeConsoleCommands()
+{
+	Command::Register("vfs",		"Lists the mounted packs and how many file lookups they've served",										Command_VirtualFileSystem);
+	Command::Register("mount_pack",	"Mounts a pack, checked before the loose files and packs mounted earlier. Params: f=file",				Command_MountPack);
+	Command::Register("build_pack",	"Packs every file in a directory. Params: d=directory, o=output pack, c=compress files it shrinks",		Command_BuildPack);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Opens and mounts the pack, returning false if it couldn't be opened
+//
+bool VirtualFileSystem::MountPack(const std::string& packPath)
+{
+	PackFile* pack = new PackFile();
+
+	if (!pack->Open(packPath))
+	{
+		delete pack;
+		return false;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(s_packLock);
+		s_packs.push_back(pack);
+	}
+
+	LogTaggedPrintf("FILES", "Mounted pack \"%s\" with %i files", packPath.c_str(), pack->GetEntryCount());
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Unmaps every pack; files already opened from a pack point into it, so they must be closed first
+//
+void VirtualFileSystem::UnmountAllPacks()
+{
+	std::lock_guard<std::mutex> lock(s_packLock);
+
+	for (PackFile* pack : s_packs)
+	{
+		delete pack;
+	}
+
+	s_packs.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of packs mounted
+//
+int VirtualFileSystem::GetMountedPackCount()
+{
+	std::lock_guard<std::mutex> lock(s_packLock);
+	return (int) s_packs.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Opens a packed file into out_file, either as a view of the pack or in its own buffer
+//
+bool VirtualFileSystem::OpenFromPacks(const std::string& filepath, bool isText, File& out_file)
+{
+	const PackFile* pack = nullptr;
+	const PackFileEntry_t* entry = FindEntry(filepath, pack);
+
+	if (entry == nullptr)
+	{
+		return false;
+	}
+
+	// Nothing to translate or decompress, so the file can be read straight out of the mapping
+	if (!isText && (entry->flags & PACK_ENTRY_FLAG_COMPRESSED) == 0)
+	{
+		out_file.OpenInMemory(filepath.c_str(), (const char*) pack->GetStoredData(*entry), (size_t) entry->size, false);
+		return true;
+	}
+
+	char* buffer = pack->ReadToNewBuffer(*entry);
+	if (buffer == nullptr)
+	{
+		return false;
+	}
+
+	size_t size = (isText ? CollapseLineEndings(buffer, (size_t) entry->size) : (size_t) entry->size);
+	out_file.OpenInMemory(filepath.c_str(), buffer, size, true);
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads a packed file into a new buffer the caller frees
+//
+char* VirtualFileSystem::ReadFromPacksToNewBuffer(const std::string& filepath, bool isText, size_t& out_size)
+{
+	const PackFile* pack = nullptr;
+	const PackFileEntry_t* entry = FindEntry(filepath, pack);
+
+	if (entry == nullptr)
+	{
+		return nullptr;
+	}
+
+	char* buffer = pack->ReadToNewBuffer(*entry);
+	if (buffer == nullptr)
+	{
+		return nullptr;
+	}
+
+	out_size = (isText ? CollapseLineEndings(buffer, (size_t) entry->size) : (size_t) entry->size);
+	return buffer;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if a mounted pack has the file
+//
+bool VirtualFileSystem::IsInPacks(const std::string& filepath)
+{
+	const PackFile* pack = nullptr;
+	return (FindEntry(filepath, pack) != nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the path as it's stored in packs, so "Data\Images\A.png" and "./data/images/a.png" match
+//
+std::string VirtualFileSystem::NormalizePath(const std::string& filepath)
+{
+	std::string normalizedPath = filepath;
+
+	for (size_t charIndex = 0; charIndex < normalizedPath.size(); ++charIndex)
+	{
+		char currChar = normalizedPath[charIndex];
+		normalizedPath[charIndex] = (currChar == '\\' ? '/' : (char) tolower((unsigned char) currChar));
+	}
+
+	while (normalizedPath.compare(0, 2, "./") == 0)
+	{
+		normalizedPath.erase(0, 2);
+	}
+
+	return normalizedPath;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Prints each pack, the one checked first at the top
+//
+void VirtualFileSystem::PrintStatus()
+{
+	std::lock_guard<std::mutex> lock(s_packLock);
+
+	if (s_packs.size() == 0)
+	{
+		ConsoleWarningf("No packs mounted, every file is read from disk");
+	}
+
+	for (int packIndex = (int) s_packs.size() - 1; packIndex >= 0; --packIndex)
+	{
+		ConsolePrintf(Rgba::GREEN, "  %s (%i files)", s_packs[packIndex]->GetFilePath().c_str(), s_packs[packIndex]->GetEntryCount());
+	}
+
+	ConsolePrintf(Rgba::GREEN, "%llu lookups served from packs, %llu went to disk", (uint64_t) s_packHitCount, (uint64_t) s_packMissCount);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Mounts every pack in VFS_PACK_DIRECTORY, sorted by name
+//
+void VirtualFileSystem::MountDefaultPacks()
+{
+	std::vector<std::string> packPaths;
+
+	WIN32_FIND_DATAA findData;
+	HANDLE findHandle = FindFirstFileA(VFS_PACK_DIRECTORY "/*" PACK_FILE_EXTENSION, &findData);
+
+	if (findHandle == INVALID_HANDLE_VALUE)
+	{
+		return;
+	}
+
+	do
+	{
+		if ((findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
+		{
+			packPaths.push_back(std::string(VFS_PACK_DIRECTORY "/") + findData.cFileName);
+		}
+
+	} while (FindNextFileA(findHandle, &findData));
+
+	FindClose(findHandle);
+
+	std::sort(packPaths.begin(), packPaths.end());
+
+	for (const std::string& packPath : packPaths)
+	{
+		MountPack(packPath);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the entry for the file from the last mounted pack that has it, and that pack
+//
+const PackFileEntry_t* VirtualFileSystem::FindEntry(const std::string& filepath, const PackFile*& out_pack)
+{
+	std::call_once(s_defaultMountFlag, MountDefaultPacks);
+
+	std::lock_guard<std::mutex> lock(s_packLock);
+
+	if (s_packs.size() == 0)
+	{
+		return nullptr;
+	}
+
+	std::string normalizedPath = NormalizePath(filepath);
+	uint32_t pathHash = PackFile::HashPath(normalizedPath);
+
+	for (int packIndex = (int) s_packs.size() - 1; packIndex >= 0; --packIndex)
+	{
+		const PackFileEntry_t* entry = s_packs[packIndex]->FindEntry(normalizedPath, pathHash);
+
+		if (entry != nullptr)
+		{
+			out_pack = s_packs[packIndex];
+			s_packHitCount++;
+
+			return entry;
+		}
+	}
+
+	s_packMissCount++;
+	return nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Collapses "\r\n" into "\n" in place, returning the new size; the buffer stays null terminated
+//
+size_t VirtualFileSystem::CollapseLineEndings(char* buffer, size_t size)
+{
+	size_t writeIndex = 0;
+
+	for (size_t readIndex = 0; readIndex < size; ++readIndex)
+	{
+		if (buffer[readIndex] == '\r' && readIndex + 1 < size && buffer[readIndex + 1] == '\n')
+		{
+			continue;
+		}
+
+		buffer[writeIndex++] = buffer[readIndex];
+	}
+
+	buffer[writeIndex] = '\0';
+	return writeIndex;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Command for listing the mounted packs
+//
+void Command_VirtualFileSystem(Command& cmd)
+{
+	UNUSED(cmd);
+	VirtualFileSystem::PrintStatus();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Command for mounting a pack by hand
+//
+void Command_MountPack(Command& cmd)
+{
+	std::string filepath;
+	if (!cmd.GetParam("f", filepath))
+	{
+		ConsoleErrorf("No pack specified, use -f");
+		return;
+	}
+
+	if (VirtualFileSystem::MountPack(filepath))
+	{
+		ConsolePrintf(Rgba::GREEN, "Mounted \"%s\"", filepath.c_str());
+	}
+	else
+	{
+		ConsoleErrorf("Couldn't mount \"%s\", see the log", filepath.c_str());
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Command for building a pack from a directory, i.e. "build_pack -d Data -o Data.pak -c true"
+//
+void Command_BuildPack(Command& cmd)
+{
+	std::string directory = "Data";
+	std::string packPath = "Data" PACK_FILE_EXTENSION;
+	bool compress = true;
+
+	cmd.GetParam("d", directory, &directory);
+	cmd.GetParam("o", packPath, &packPath);
+	cmd.GetParam("c", compress, &compress);
+
+	if (PackFile::WriteFromDirectory(directory, packPath, compress))
+	{
+		ConsolePrintf(Rgba::GREEN, "Packed \"%s\" into \"%s\", mount it or restart to use it", directory.c_str(), packPath.c_str());
+	}
+	else
+	{
+		ConsoleErrorf("Couldn't pack \"%s\", see the log", directory.c_str());
+	}
+}
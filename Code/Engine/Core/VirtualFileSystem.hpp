@@ -0,0 +1,80 @@
+/************************************************************************/
+/* File: VirtualFileSystem.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Looks files up in the mounted packs before the loose files
+/*				on disk; File and FileReadToNewBuffer() go through it for
+/*				reads, so loaders don't need to know where data lives
+/************************************************************************/
+#pragma once
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+class File;
+class PackFile;
+struct PackFileEntry_t;
+
+// Every pack in here is mounted the first time a file is looked up, in name order so later ones override earlier ones
+// Packs win over loose files, so unmount them (or don't build them) when hot reloading from the data folder
+#define VFS_PACK_DIRECTORY "."
+
+
+class VirtualFileSystem
+{
+public:
+	//-----Public Methods-----
+
+	// Both are optional - lookups mount the default packs on their own, and packs are unmapped at exit anyway
+	static void Initialize();
+	static void Shutdown();
+
+	static void InitializeConsoleCommands();
+
+	// Packs mounted later are checked first; mount and unmount while nothing's loading, lookups don't hold the packs
+	static bool MountPack(const std::string& packPath);
+	static void UnmountAllPacks();
+	static int	GetMountedPackCount();
+
+	// Opens the file in out_file if a pack has it, returning false if it should be opened from disk instead
+	// Text reads collapse "\r\n" into "\n", the same as the CRT does for loose files opened without 'b'
+	// Uncompressed binary reads point into the pack's mapping without copying
+	static bool		OpenFromPacks(const std::string& filepath, bool isText, File& out_file);
+
+	// Returns the file in a new null-terminated malloc'd buffer if a pack has it, or nullptr if it should be read from disk
+	static char*	ReadFromPacksToNewBuffer(const std::string& filepath, bool isText, size_t& out_size);
+
+	static bool		IsInPacks(const std::string& filepath);
+
+	// Lowercase, forward slashes, and no leading "./" - how paths are stored in packs
+	static std::string NormalizePath(const std::string& filepath);
+
+	// Main thread only, prints the mounted packs and how many lookups they've served
+	static void PrintStatus();
+
+
+private:
+	//-----Private Methods-----
+
+	VirtualFileSystem() {}
+
+	static void						MountDefaultPacks();
+	static const PackFileEntry_t*	FindEntry(const std::string& filepath, const PackFile*& out_pack);
+
+	static size_t					CollapseLineEndings(char* buffer, size_t size);
+
+
+private:
+	//-----Private Data-----
+
+	static std::vector<PackFile*>	s_packs;		// Checked back to front
+	static std::mutex				s_packLock;
+	static std::once_flag			s_defaultMountFlag;
+
+	// Lookups served by a pack vs. sent to disk, for seeing what a pack saves
+	static std::atomic<uint64_t>	s_packHitCount;
+	static std::atomic<uint64_t>	s_packMissCount;
+
+};
@@ -19,6 +19,14 @@ Window* Window::s_instance = nullptr;
 // Function declaration for the constructor's use
 LRESULT CALLBACK WindowsMessageHandlingProcedure( HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam );
 
+// What the message thread needs to create the window, on the creating thread's stack until it exists
+struct WindowThreadArgs_t
+{
+	Window*		window = nullptr;
+	RECT		clientRect;
+	DWORD		ownerThreadID = 0;
+};
+
 // C functions for setting up a window
 
 //-----------------------------------------------------------------------------------------------
@@ -163,6 +171,16 @@ Window::Window(float clientAspect/*=1.77777f*/, const std::string& windowTitle/*
 {
 	s_instance = this;
 
+	// Headless windows only keep the size, for the systems that lay themselves out by it
+	if (IsEngineHeadless())
+	{
+		m_hwnd = nullptr;
+		m_heightInPixels	= WINDOW_HEADLESS_DEFAULT_HEIGHT;
+		m_widthInPixels		= static_cast<unsigned int>(m_heightInPixels * clientAspect);
+		m_windowTitle = windowTitle;
+		return;
+	}
+
 	// Get desktop rect, dimensions, aspect
 	RECT desktopRect = GetDesktopRect();
 
@@ -190,8 +208,8 @@ Window::Window(float clientAspect/*=1.77777f*/, const std::string& windowTitle/*
 	RECT clientRect = GetClientRect(desktopWidth, desktopHeight, m_widthInPixels, m_heightInPixels);
 
 	// Calculate the outer dimensions of the physical window, including frame et. al.
-	m_hwnd = FinalizeWindow(clientRect, windowTitle);
 	m_windowTitle = windowTitle;
+	StartMessageThread(&clientRect);
 }
 
 
@@ -201,6 +219,15 @@ Window::Window(float clientAspect/*=1.77777f*/, const std::string& windowTitle/*
 Window::Window(unsigned int widthInPixels, unsigned int heightInPixels, const std::string& windowTitle/*="NO TITLE SET"*/)
 {
 	s_instance = this;
+
+	if (IsEngineHeadless())
+	{
+		m_hwnd = nullptr;
+		m_widthInPixels = widthInPixels;
+		m_heightInPixels = heightInPixels;
+		m_windowTitle = windowTitle;
+		return;
+	}
 	
 	// Get desktop rect, dimensions, aspect
 	RECT desktopRect = GetDesktopRect();
@@ -230,47 +257,109 @@ Window::Window(unsigned int widthInPixels, unsigned int heightInPixels, const st
 	RECT clientRect = GetClientRect(desktopWidth, desktopHeight, m_widthInPixels, m_heightInPixels);
 
 	// Create the window
-	m_hwnd = FinalizeWindow(clientRect, windowTitle);
 	m_windowTitle = windowTitle;
+	StartMessageThread(&clientRect);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts the thread that creates and pumps the OS window, returning once the window exists
+//
+void Window::StartMessageThread(void* clientRect)
+{
+	WindowThreadArgs_t args;
+	args.window = this;
+	args.clientRect = *((RECT*) clientRect);
+	args.ownerThreadID = GetCurrentThreadId();
+
+	m_messageThread = Thread::Create(MessageThreadEntry, &args, "Window Messages", THREAD_AFFINITY_ANY, THREAD_PRIORITY_SETTING_ABOVE_NORMAL);
+
+	// The args are on this stack, and everything after this needs the handle
+	while (!m_isWindowCreated)
+	{
+		Thread::YieldThisThread();
+	}
+
+	GUARANTEE_OR_DIE(m_hwnd != nullptr, "Error: Window couldn't create its OS window");
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Message Pump for the system, is called when the OS receives an input interrupt and processes
-// the input accordingly
+// Entry for the message thread - creates the window, so its messages come to this thread, then
+// pumps them until the window is shut down
+//
+void Window::MessageThreadEntry(void* args)
+{
+	WindowThreadArgs_t* threadArgs = (WindowThreadArgs_t*) args;
+	Window* window = threadArgs->window;
+
+	HWND hwnd = FinalizeWindow(threadArgs->clientRect, window->m_windowTitle);
+
+	// Shares the creating thread's input state, so the cursor shown, hidden and set from the game
+	// thread is still this window's, and GetActiveWindow() from there still finds it
+	if (hwnd != NULL)
+	{
+		AttachThreadInput(GetCurrentThreadId(), threadArgs->ownerThreadID, TRUE);
+	}
+
+	window->m_hwnd = hwnd;
+	window->m_messageThreadID = GetCurrentThreadId();
+	window->m_isWindowCreated = true;	// Args are gone after this
+
+	if (hwnd == NULL)
+	{
+		return;
+	}
+
+	MSG queuedMessage;
+	while (GetMessage(&queuedMessage, NULL, 0, 0) > 0)
+	{
+		TranslateMessage(&queuedMessage);
+		DispatchMessage(&queuedMessage);
+	}
+
+	DestroyWindow(hwnd);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Message Pump for the system, is called on the message thread when the OS receives an input
+// interrupt, and queues it for the handlers to run on the game thread
+// The handlers can't answer in time, so the default behaviour always happens - except for closing,
+// which is left to them
 //
 LRESULT CALLBACK WindowsMessageHandlingProcedure( HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam )
 {
-	//  Give the custom handlers a chance to run first; 
 	Window *window = Window::GetInstance(); 
-	std::vector<windows_message_handler_cb> handlers = window->GetHandlers();
 
-	bool returnDefaultProc = true;
 	if (nullptr != window) 
 	{
-		for (int i = 0; i < static_cast<int>(handlers.size()); ++i) 
-		{
-			// If any return true then do default windows behavior
-			returnDefaultProc = returnDefaultProc && handlers[i]( msg, wparam, lparam ); 
-		}
+		window->QueueMessage(msg, wparam, lparam);
 	}
 
-	if (returnDefaultProc)
-	{
-		return DefWindowProc( hwnd, msg, wparam, lparam );	// do default windows behaviour
-	}
-	else
+	if (msg == WM_CLOSE)
 	{
 		return 0;
 	}
+
+	return DefWindowProc( hwnd, msg, wparam, lparam );	// do default windows behaviour
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Destructor, just sets the singleton instance to nullptr
+// Destructor - ends the message thread, which destroys the OS window on its way out
 //
 Window::~Window()
 {
+	if (m_messageThread != nullptr)
+	{
+		PostThreadMessage(m_messageThreadID, WM_QUIT, 0, 0);
+		Thread::Join(m_messageThread);
+
+		m_messageThread = nullptr;
+		m_hwnd = nullptr;
+	}
+
 	// Unregister all handlers on this window
 	m_handlers.clear();
 }
@@ -357,6 +446,70 @@ std::vector<windows_message_handler_cb> Window::GetHandlers() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Queues the message for the handlers, from the message thread
+// Messages sent for every cursor move are skipped, nothing reads them and the cursor position is
+// always current from the Mouse, so they won't fill the queue while the game thread is busy loading
+//
+bool Window::QueueMessage(unsigned int msg, size_t wparam, size_t lparam)
+{
+	if (msg == WM_MOUSEMOVE || msg == WM_NCMOUSEMOVE || msg == WM_NCHITTEST || msg == WM_SETCURSOR)
+	{
+		return true;
+	}
+
+	WindowMessage_t message;
+	message.msg = msg;
+	message.wparam = wparam;
+	message.lparam = lparam;
+
+	// Waiting for room could deadlock with a game thread call that sends to the window, like SetTitle()
+	if (!m_messages.Enqueue(message))
+	{
+		m_droppedMessageCount++;
+		return false;
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Pops the oldest message the message thread has queued, returning false if there are none
+//
+bool Window::PopMessage(WindowMessage_t& out_message)
+{
+	return m_messages.Dequeue(out_message);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Runs the handlers on the given message in the order they were registered, stopping at the first
+// one to consume it
+//
+bool Window::RunHandlers(const WindowMessage_t& message) const
+{
+	for (int i = 0; i < static_cast<int>(m_handlers.size()); ++i)
+	{
+		if (!m_handlers[i](message.msg, message.wparam, message.lparam))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of messages dropped for the queue being full, since the window was created
+//
+int Window::GetDroppedMessageCount() const
+{
+	return m_droppedMessageCount;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the width of the window in pixels
 //
@@ -407,6 +560,11 @@ AABB2 Window::GetWindowBounds() const
 //
 bool Window::IsWindowInFocus() const
 {
+	if (m_hwnd == nullptr)
+	{
+		return false;
+	}
+
 	HWND active = GetActiveWindow();
 	return (m_hwnd == active);
 }
@@ -418,6 +576,14 @@ bool Window::IsWindowInFocus() const
 void Window::SetTitle(const std::string& newTitle)
 {
 	m_windowTitle = newTitle;
+
+	// Headless servers show it on their console instead
+	if (m_hwnd == nullptr)
+	{
+		SetConsoleTitleA(newTitle.c_str());
+		return;
+	}
+
 	SetWindowTextA((HWND)m_hwnd, newTitle.c_str());
 }
 
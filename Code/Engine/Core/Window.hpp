@@ -4,13 +4,35 @@
 /* Date: January 30th, 2017
 /* Description: Class to represent a Windows window
 /************************************************************************/
+#pragma once
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/IntVector2.hpp"
+#include "Engine/Core/Threading/Threading.hpp"
+#include "Engine/DataStructures/SPSCQueue.hpp"
+#include <atomic>
+#include <string>
 #include <vector>
 
 // Listeners to input that can be bound and passed input to, before the Engine gets it
 typedef bool (*windows_message_handler_cb)( unsigned int msg, size_t wparam, size_t lparam ); 
 
+// Client height a headless window reports when only given an aspect, it has nothing to fit to
+#define WINDOW_HEADLESS_DEFAULT_HEIGHT (1080)
+
+// Messages the window's thread can have waiting for the game thread, past this they're dropped
+#define WINDOW_MESSAGE_QUEUE_SIZE (4096)
+
+// Bytes kept between the members the message thread writes and the game thread's, at least a cache line
+#define WINDOW_THREAD_PADDING_SIZE (64)
+
+// A message as the window's thread received it, for the handlers to be run on later
+struct WindowMessage_t
+{
+	unsigned int	msg = 0;
+	size_t			wparam = 0;
+	size_t			lparam = 0;
+};
+
 class Window
 {
 public:
@@ -18,11 +40,19 @@ public:
 
 	void	RegisterHandler( windows_message_handler_cb cb );		// Adds the given listener to the list of listeners	
 	void	UnregisterHandler( windows_message_handler_cb cb );		// Removes the given listener from the list of listeners
-	void*	GetHandle() const { return m_hwnd; }					// Returns the hwnd reference
+	void*	GetHandle() const { return m_hwnd; }					// Returns the hwnd reference, nullptr when headless
 	void	SetTitle(const std::string& newTitle);					// Sets the title of the window
 
 	std::vector<windows_message_handler_cb> GetHandlers() const;	// Returns the list of listeners for input
 
+	// The OS window is created and pumped on its own thread, so moving, resizing or any other modal loop
+	// only stalls that thread; its messages are queued and the handlers run on whichever thread pops them
+	// By then the OS has already had DefWindowProc for them, except WM_CLOSE, which is left to the handlers
+	bool	QueueMessage(unsigned int msg, size_t wparam, size_t lparam);	// Window thread only, false if it was dropped
+	bool	PopMessage(WindowMessage_t& out_message);						// One consumer thread only
+	bool	RunHandlers(const WindowMessage_t& message) const;				// False once a handler consumes it, in registration order
+	int		GetDroppedMessageCount() const;
+
 	unsigned int	GetWidthInPixels() const;
 	unsigned int	GetHeightInPixels() const;
 	IntVector2		GetDimensions() const;
@@ -51,6 +81,9 @@ private:
 	~Window();
 	Window(const Window& copy) = delete;
 
+	void			StartMessageThread(void* clientRect);					// Waits until the window exists
+	static void		MessageThreadEntry(void* args);
+
 
 private:
 
@@ -60,6 +93,17 @@ private:
 	// Windows message listeners 
 	std::vector<windows_message_handler_cb> m_handlers; 
 
+	// Message thread, which owns the OS window
+	// What it writes is padded off from the game thread's members rather than aligned - the window is
+	// created with new, and the heap doesn't honor alignment past 16 bytes
+	ThreadHandle_t					m_messageThread = nullptr;
+	uint8_t							m_threadPadding0[WINDOW_THREAD_PADDING_SIZE];
+	std::atomic<unsigned long>		m_messageThreadID{ 0 };
+	std::atomic<bool>				m_isWindowCreated{ false };
+	SPSCQueue<WindowMessage_t>		m_messages{ WINDOW_MESSAGE_QUEUE_SIZE };
+	std::atomic<int>				m_droppedMessageCount{ 0 };
+	uint8_t							m_threadPadding1[WINDOW_THREAD_PADDING_SIZE];
+
 	// Title to be displayed on this window
 	std::string m_windowTitle;
 
@@ -0,0 +1,139 @@
+/************************************************************************/
+/* File: ByteRingBuffer.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the ByteRingBuffer class
+/************************************************************************/
+#include "Engine/DataStructures/ByteRingBuffer.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+ByteRingBuffer::ByteRingBuffer(size_t capacity)
+{
+	size_t roundedCapacity = 2;
+	while (roundedCapacity < capacity)
+	{
+		roundedCapacity <<= 1;
+	}
+
+	m_mask = roundedCapacity - 1;
+	m_buffer = new uint8_t[roundedCapacity];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+ByteRingBuffer::~ByteRingBuffer()
+{
+	delete[] m_buffer;
+	m_buffer = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the total number of bytes the ring can hold
+//
+size_t ByteRingBuffer::GetCapacity() const
+{
+	return m_mask + 1;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of bytes written and not yet consumed
+//
+size_t ByteRingBuffer::GetReadableByteCount() const
+{
+	return m_writeIndex - m_readIndex;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of bytes that can be written before the ring is full
+//
+size_t ByteRingBuffer::GetWritableByteCount() const
+{
+	return GetCapacity() - GetReadableByteCount();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns how many bytes can be written contiguously at out_writeHead, to be followed by CommitWrite()
+//
+size_t ByteRingBuffer::GetWriteSpan(uint8_t*& out_writeHead)
+{
+	size_t writeOffset = (m_writeIndex & m_mask);
+	size_t untilEnd = GetCapacity() - writeOffset;
+	size_t writable = GetWritableByteCount();
+
+	out_writeHead = m_buffer + writeOffset;
+	return (writable < untilEnd ? writable : untilEnd);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Makes the bytes written into the last write span readable
+//
+void ByteRingBuffer::CommitWrite(size_t byteCount)
+{
+	ASSERT_OR_DIE(byteCount <= GetWritableByteCount(), "Error: ByteRingBuffer::CommitWrite() committed more than was writable");
+	m_writeIndex += byteCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies up to byteCount readable bytes into out_data without consuming them, returning the amount copied
+//
+size_t ByteRingBuffer::Peek(void* out_data, size_t byteCount) const
+{
+	size_t readable = GetReadableByteCount();
+	size_t amountToCopy = (byteCount < readable ? byteCount : readable);
+
+	size_t readOffset = (m_readIndex & m_mask);
+	size_t untilEnd = GetCapacity() - readOffset;
+	size_t firstCopy = (amountToCopy < untilEnd ? amountToCopy : untilEnd);
+
+	memcpy(out_data, m_buffer + readOffset, firstCopy);
+	memcpy((uint8_t*) out_data + firstCopy, m_buffer, amountToCopy - firstCopy);
+
+	return amountToCopy;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns how many readable bytes are contiguous at out_readHead, before the ring wraps
+//
+size_t ByteRingBuffer::GetReadSpan(const uint8_t*& out_readHead) const
+{
+	size_t readOffset = (m_readIndex & m_mask);
+	size_t untilEnd = GetCapacity() - readOffset;
+	size_t readable = GetReadableByteCount();
+
+	out_readHead = m_buffer + readOffset;
+	return (readable < untilEnd ? readable : untilEnd);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Frees up the oldest readable bytes for writing
+//
+void ByteRingBuffer::Consume(size_t byteCount)
+{
+	ASSERT_OR_DIE(byteCount <= GetReadableByteCount(), "Error: ByteRingBuffer::Consume() consumed more than was readable");
+	m_readIndex += byteCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Drops everything readable; the memory is kept
+//
+void ByteRingBuffer::Clear()
+{
+	m_readIndex = 0;
+	m_writeIndex = 0;
+}
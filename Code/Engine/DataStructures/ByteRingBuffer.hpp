@@ -0,0 +1,51 @@
+/************************************************************************/
+/* File: ByteRingBuffer.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Fixed-capacity ring of bytes, for stream data that's
+/*				written in chunks and read back out in whole messages
+/************************************************************************/
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+class ByteRingBuffer
+{
+public:
+	//-----Public Methods-----
+
+	// Capacity is rounded up to a power of two, and allocated once
+	explicit ByteRingBuffer(size_t capacity);
+	~ByteRingBuffer();
+
+	ByteRingBuffer(const ByteRingBuffer& copy) = delete;
+	ByteRingBuffer& operator=(const ByteRingBuffer& copy) = delete;
+
+	size_t		GetCapacity() const;
+	size_t		GetReadableByteCount() const;
+	size_t		GetWritableByteCount() const;
+
+	// Writing in place, e.g. a socket receive straight into the buffer - the span stops at the end
+	// of the memory, so a full fill can take two spans
+	size_t		GetWriteSpan(uint8_t*& out_writeHead);
+	void		CommitWrite(size_t byteCount);
+
+	// Reading - Peek() copies across the wrap, GetReadSpan() points at the bytes up to it
+	size_t		Peek(void* out_data, size_t byteCount) const;
+	size_t		GetReadSpan(const uint8_t*& out_readHead) const;
+	void		Consume(size_t byteCount);
+
+	void		Clear();
+
+
+private:
+	//-----Private Data-----
+
+	uint8_t*	m_buffer = nullptr;
+	size_t		m_mask = 0;
+
+	// Free running, only masked to index, so full and empty aren't ambiguous
+	size_t		m_readIndex = 0;
+	size_t		m_writeIndex = 0;
+
+};
@@ -0,0 +1,321 @@
+/************************************************************************/
+/* File: ConcurrentHashMap.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Sharded hash map and set for many threads, each shard
+/*				behind its own reader-writer lock so lookups only
+/*				contend with writes to the same shard
+/************************************************************************/
+#pragma once
+#include <stdint.h>
+#include <functional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+// Power of two; more shards means less contention, at the cost of memory and slower whole-container operations
+#define CONCURRENT_HASH_DEFAULT_SHARD_COUNT (32)
+
+// Bytes kept between one shard and the next, at least a cache line
+#define CONCURRENT_HASH_SHARD_PADDING_SIZE (64)
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Picks a shard from the upper bits of the hash, so the std::unordered_map inside still gets
+// well spread low bits
+//
+inline size_t GetConcurrentHashShardIndex(size_t hash, size_t shardCount)
+{
+	uint64_t mixed = (uint64_t)hash * 0x9E3779B97F4A7C15ull;
+	return (size_t)(mixed >> 40) & (shardCount - 1);
+}
+
+
+template <typename K, typename T, typename HASH = std::hash<K>, size_t SHARD_COUNT = CONCURRENT_HASH_DEFAULT_SHARD_COUNT>
+class ConcurrentHashMap
+{
+	static_assert((SHARD_COUNT & (SHARD_COUNT - 1)) == 0, "ConcurrentHashMap shard count must be a power of two");
+
+public:
+	//-----Public Methods-----
+
+	ConcurrentHashMap() {}
+	ConcurrentHashMap(const ConcurrentHashMap& copy) = delete;
+	ConcurrentHashMap& operator=(const ConcurrentHashMap& copy) = delete;
+
+	// Adds the value, replacing any value already at the key
+	void Insert(const K& key, const T& value)
+	{
+		Shard_t& shard = GetShard(key);
+
+		shard.lock.lock();
+		shard.map[key] = value;
+		shard.lock.unlock();
+	}
+
+	// Adds the value only if the key isn't in the map yet
+	// Returns false if it was, with the existing value in out_existingValue if given
+	bool TryInsert(const K& key, const T& value, T* out_existingValue = nullptr)
+	{
+		Shard_t& shard = GetShard(key);
+
+		shard.lock.lock();
+		std::pair<typename MapType::iterator, bool> result = shard.map.insert(std::make_pair(key, value));
+
+		if (!result.second && out_existingValue != nullptr)
+		{
+			*out_existingValue = result.first->second;
+		}
+
+		shard.lock.unlock();
+		return result.second;
+	}
+
+	// Removes the key, returning false if it wasn't in the map
+	bool Erase(const K& key)
+	{
+		Shard_t& shard = GetShard(key);
+
+		shard.lock.lock();
+		bool itemExisted = (shard.map.erase(key) > 0);
+		shard.lock.unlock();
+
+		return itemExisted;
+	}
+
+	// Copies the value out, since it can change as soon as the shard is unlocked
+	bool Get(const K& key, T& out_value) const
+	{
+		const Shard_t& shard = GetShard(key);
+
+		shard.lock.lock_shared();
+		typename MapType::const_iterator itr = shard.map.find(key);
+		bool itemExists = (itr != shard.map.end());
+
+		if (itemExists)
+		{
+			out_value = itr->second;
+		}
+
+		shard.lock.unlock_shared();
+		return itemExists;
+	}
+
+	bool Contains(const K& key) const
+	{
+		const Shard_t& shard = GetShard(key);
+
+		shard.lock.lock_shared();
+		bool itemExists = (shard.map.find(key) != shard.map.end());
+		shard.lock.unlock_shared();
+
+		return itemExists;
+	}
+
+	// Locks one shard at a time, so the total can be off if other threads are inserting or erasing
+	size_t GetSize() const
+	{
+		size_t size = 0;
+
+		for (size_t shardIndex = 0; shardIndex < SHARD_COUNT; ++shardIndex)
+		{
+			m_shards[shardIndex].lock.lock_shared();
+			size += m_shards[shardIndex].map.size();
+			m_shards[shardIndex].lock.unlock_shared();
+		}
+
+		return size;
+	}
+
+	void Clear()
+	{
+		for (size_t shardIndex = 0; shardIndex < SHARD_COUNT; ++shardIndex)
+		{
+			m_shards[shardIndex].lock.lock();
+			m_shards[shardIndex].map.clear();
+			m_shards[shardIndex].lock.unlock();
+		}
+	}
+
+	// Calls visitor(key, value) for every entry, holding each shard's read lock while in it
+	// The visitor must not modify this map
+	template <typename VISITOR>
+	void ForEach(VISITOR&& visitor) const
+	{
+		for (size_t shardIndex = 0; shardIndex < SHARD_COUNT; ++shardIndex)
+		{
+			const Shard_t& shard = m_shards[shardIndex];
+
+			shard.lock.lock_shared();
+			for (typename MapType::const_iterator itr = shard.map.begin(); itr != shard.map.end(); ++itr)
+			{
+				visitor(itr->first, itr->second);
+			}
+			shard.lock.unlock_shared();
+		}
+	}
+
+
+private:
+	//-----Private Types-----
+
+	typedef std::unordered_map<K, T, HASH> MapType;
+
+	// Padded by a cache line, so locking one shard doesn't invalidate its neighbor - padding rather than
+	// alignas, as maps are often members of heap allocated objects, and the heap doesn't honor alignment past 16 bytes
+	struct Shard_t
+	{
+		mutable std::shared_mutex	lock;
+		MapType						map;
+		uint8_t						padding[CONCURRENT_HASH_SHARD_PADDING_SIZE];
+	};
+
+
+private:
+	//-----Private Methods-----
+
+	Shard_t& GetShard(const K& key)
+	{
+		return m_shards[GetConcurrentHashShardIndex(m_hasher(key), SHARD_COUNT)];
+	}
+
+	const Shard_t& GetShard(const K& key) const
+	{
+		return m_shards[GetConcurrentHashShardIndex(m_hasher(key), SHARD_COUNT)];
+	}
+
+
+private:
+	//-----Private Data-----
+
+	Shard_t		m_shards[SHARD_COUNT];
+	HASH		m_hasher;
+
+};
+
+
+template <typename T, typename HASH = std::hash<T>, size_t SHARD_COUNT = CONCURRENT_HASH_DEFAULT_SHARD_COUNT>
+class ConcurrentHashSet
+{
+	static_assert((SHARD_COUNT & (SHARD_COUNT - 1)) == 0, "ConcurrentHashSet shard count must be a power of two");
+
+public:
+	//-----Public Methods-----
+
+	ConcurrentHashSet() {}
+	ConcurrentHashSet(const ConcurrentHashSet& copy) = delete;
+	ConcurrentHashSet& operator=(const ConcurrentHashSet& copy) = delete;
+
+	// Returns false if the value was already in the set
+	bool Insert(const T& value)
+	{
+		Shard_t& shard = GetShard(value);
+
+		shard.lock.lock();
+		bool wasInserted = shard.set.insert(value).second;
+		shard.lock.unlock();
+
+		return wasInserted;
+	}
+
+	// Returns false if the value wasn't in the set
+	bool Erase(const T& value)
+	{
+		Shard_t& shard = GetShard(value);
+
+		shard.lock.lock();
+		bool itemExisted = (shard.set.erase(value) > 0);
+		shard.lock.unlock();
+
+		return itemExisted;
+	}
+
+	bool Contains(const T& value) const
+	{
+		const Shard_t& shard = GetShard(value);
+
+		shard.lock.lock_shared();
+		bool itemExists = (shard.set.find(value) != shard.set.end());
+		shard.lock.unlock_shared();
+
+		return itemExists;
+	}
+
+	// Locks one shard at a time, so the total can be off if other threads are inserting or erasing
+	size_t GetSize() const
+	{
+		size_t size = 0;
+
+		for (size_t shardIndex = 0; shardIndex < SHARD_COUNT; ++shardIndex)
+		{
+			m_shards[shardIndex].lock.lock_shared();
+			size += m_shards[shardIndex].set.size();
+			m_shards[shardIndex].lock.unlock_shared();
+		}
+
+		return size;
+	}
+
+	void Clear()
+	{
+		for (size_t shardIndex = 0; shardIndex < SHARD_COUNT; ++shardIndex)
+		{
+			m_shards[shardIndex].lock.lock();
+			m_shards[shardIndex].set.clear();
+			m_shards[shardIndex].lock.unlock();
+		}
+	}
+
+	// Calls visitor(value) for every value, holding each shard's read lock while in it
+	// The visitor must not modify this set
+	template <typename VISITOR>
+	void ForEach(VISITOR&& visitor) const
+	{
+		for (size_t shardIndex = 0; shardIndex < SHARD_COUNT; ++shardIndex)
+		{
+			const Shard_t& shard = m_shards[shardIndex];
+
+			shard.lock.lock_shared();
+			for (typename SetType::const_iterator itr = shard.set.begin(); itr != shard.set.end(); ++itr)
+			{
+				visitor(*itr);
+			}
+			shard.lock.unlock_shared();
+		}
+	}
+
+
+private:
+	//-----Private Types-----
+
+	typedef std::unordered_set<T, HASH> SetType;
+
+	// Padded the same as the map's
+	struct Shard_t
+	{
+		mutable std::shared_mutex	lock;
+		SetType						set;
+		uint8_t						padding[CONCURRENT_HASH_SHARD_PADDING_SIZE];
+	};
+
+
+private:
+	//-----Private Methods-----
+
+	Shard_t& GetShard(const T& value)
+	{
+		return m_shards[GetConcurrentHashShardIndex(m_hasher(value), SHARD_COUNT)];
+	}
+
+	const Shard_t& GetShard(const T& value) const
+	{
+		return m_shards[GetConcurrentHashShardIndex(m_hasher(value), SHARD_COUNT)];
+	}
+
+
+private:
+	//-----Private Data-----
+
+	Shard_t		m_shards[SHARD_COUNT];
+	HASH		m_hasher;
+
+};
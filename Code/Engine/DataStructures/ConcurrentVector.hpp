@@ -0,0 +1,222 @@
+/************************************************************************/
+/* File: ConcurrentVector.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Append-only vector any number of threads can push to and
+/*				read from without locking; elements never move once added
+/************************************************************************/
+#pragma once
+#include <new>
+#include <atomic>
+#include <utility>
+#include <stddef.h>
+#include <stdint.h>
+
+// Bucket b holds FIRST_BUCKET_SIZE << b elements, so 32 buckets covers more than anything will ever push
+#define CONCURRENT_VECTOR_FIRST_BUCKET_BITS (5)
+#define CONCURRENT_VECTOR_MAX_BUCKETS (32)
+
+template <typename T>
+class ConcurrentVector
+{
+public:
+	//-----Public Methods-----
+
+	ConcurrentVector()
+	{
+		for (int bucketIndex = 0; bucketIndex < CONCURRENT_VECTOR_MAX_BUCKETS; ++bucketIndex)
+		{
+			m_buckets[bucketIndex] = nullptr;
+		}
+	}
+
+	~ConcurrentVector()
+	{
+		Clear();
+	}
+
+	ConcurrentVector(const ConcurrentVector& copy) = delete;
+	ConcurrentVector& operator=(const ConcurrentVector& copy) = delete;
+
+	// Adds the value to the end, returning its index, without waiting on other pushes
+	// The element is visible to GetSize() once every push before it has also finished
+	size_t PushBack(const T& value)
+	{
+		return EmplaceBack(value);
+	}
+
+	size_t PushBack(T&& value)
+	{
+		return EmplaceBack(std::move(value));
+	}
+
+	template <typename... ARGS>
+	size_t EmplaceBack(ARGS&&... args)
+	{
+		size_t index = m_reservedCount.fetch_add(1, std::memory_order_relaxed);
+
+		int bucketIndex;
+		size_t indexInBucket;
+		GetBucketForIndex(index, bucketIndex, indexInBucket);
+
+		Slot_t& slot = GetOrCreateBucket(bucketIndex)[indexInBucket];
+		new (slot.storage) T(std::forward<ARGS>(args)...);
+		slot.isReady.store(true, std::memory_order_seq_cst);
+
+		PublishReadySlots();
+		return index;
+	}
+
+	// Any index below GetSize() is safe to read from any thread, and the reference stays valid until Clear()
+	T& operator[](size_t index)
+	{
+		int bucketIndex;
+		size_t indexInBucket;
+		GetBucketForIndex(index, bucketIndex, indexInBucket);
+
+		return *reinterpret_cast<T*>(m_buckets[bucketIndex].load(std::memory_order_acquire)[indexInBucket].storage);
+	}
+
+	const T& operator[](size_t index) const
+	{
+		int bucketIndex;
+		size_t indexInBucket;
+		GetBucketForIndex(index, bucketIndex, indexInBucket);
+
+		return *reinterpret_cast<const T*>(m_buckets[bucketIndex].load(std::memory_order_acquire)[indexInBucket].storage);
+	}
+
+	size_t GetSize() const
+	{
+		return m_publishedCount.load(std::memory_order_acquire);
+	}
+
+	bool IsEmpty() const
+	{
+		return (GetSize() == 0);
+	}
+
+	// Not thread safe - only call once nothing else is using the vector
+	void Clear()
+	{
+		size_t count = m_publishedCount.load(std::memory_order_acquire);
+
+		for (size_t index = 0; index < count; ++index)
+		{
+			(*this)[index].~T();
+		}
+
+		for (int bucketIndex = 0; bucketIndex < CONCURRENT_VECTOR_MAX_BUCKETS; ++bucketIndex)
+		{
+			Slot_t* bucket = m_buckets[bucketIndex].load(std::memory_order_relaxed);
+
+			if (bucket != nullptr)
+			{
+				::operator delete(bucket);
+				m_buckets[bucketIndex] = nullptr;
+			}
+		}
+
+		m_reservedCount = 0;
+		m_publishedCount = 0;
+	}
+
+
+private:
+	//-----Private Types-----
+
+	// Set ready once constructed, so the count can be moved past it by whichever push gets there first
+	struct Slot_t
+	{
+		std::atomic<bool>			isReady;
+		alignas(T) unsigned char	storage[sizeof(T)];
+	};
+
+
+private:
+	//-----Private Methods-----
+
+	// Index + FIRST_BUCKET_SIZE has its highest bit at (bucket + FIRST_BUCKET_BITS)
+	static void GetBucketForIndex(size_t index, int& out_bucketIndex, size_t& out_indexInBucket)
+	{
+		uint64_t offsetIndex = (uint64_t)index + ((uint64_t)1 << CONCURRENT_VECTOR_FIRST_BUCKET_BITS);
+
+		int highestBit = 0;
+		while ((offsetIndex >> (highestBit + 1)) != 0)
+		{
+			highestBit++;
+		}
+
+		out_bucketIndex = highestBit - CONCURRENT_VECTOR_FIRST_BUCKET_BITS;
+		out_indexInBucket = (size_t)(offsetIndex - ((uint64_t)1 << highestBit));
+	}
+
+	static size_t GetBucketSize(int bucketIndex)
+	{
+		return ((size_t)1 << (bucketIndex + CONCURRENT_VECTOR_FIRST_BUCKET_BITS));
+	}
+
+	// Whoever loses the race to make a bucket frees theirs and uses the winner's
+	Slot_t* GetOrCreateBucket(int bucketIndex)
+	{
+		Slot_t* bucket = m_buckets[bucketIndex].load(std::memory_order_acquire);
+
+		if (bucket == nullptr)
+		{
+			size_t bucketSize = GetBucketSize(bucketIndex);
+			Slot_t* newBucket = (Slot_t*) ::operator new(sizeof(Slot_t) * bucketSize);
+
+			for (size_t slotIndex = 0; slotIndex < bucketSize; ++slotIndex)
+			{
+				new (&newBucket[slotIndex].isReady) std::atomic<bool>(false);
+			}
+
+			if (m_buckets[bucketIndex].compare_exchange_strong(bucket, newBucket, std::memory_order_acq_rel, std::memory_order_acquire))
+			{
+				bucket = newBucket;
+			}
+			else
+			{
+				::operator delete(newBucket);
+			}
+		}
+
+		return bucket;
+	}
+
+	// Moves the published count past every ready slot at the front, so a push finishing out of order
+	// leaves its slot for the push before it to publish instead of waiting on it
+	// Seq cst with the ready store, so either this sees the later slot ready or that push sees this count
+	void PublishReadySlots()
+	{
+		size_t count = m_publishedCount.load(std::memory_order_seq_cst);
+
+		while (true)
+		{
+			int bucketIndex;
+			size_t indexInBucket;
+			GetBucketForIndex(count, bucketIndex, indexInBucket);
+
+			Slot_t* bucket = m_buckets[bucketIndex].load(std::memory_order_acquire);
+			if (bucket == nullptr || !bucket[indexInBucket].isReady.load(std::memory_order_seq_cst))
+			{
+				return;
+			}
+
+			// Failing means another push moved it, so carry on from where it got to
+			if (m_publishedCount.compare_exchange_weak(count, count + 1, std::memory_order_seq_cst, std::memory_order_seq_cst))
+			{
+				count++;
+			}
+		}
+	}
+
+
+private:
+	//-----Private Data-----
+
+	std::atomic<Slot_t*>	m_buckets[CONCURRENT_VECTOR_MAX_BUCKETS];
+	std::atomic<size_t>		m_reservedCount{ 0 };
+	std::atomic<size_t>		m_publishedCount{ 0 };
+
+};
@@ -0,0 +1,188 @@
+/************************************************************************/
+/* File: MPMCQueue.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Bounded lock-free ring buffer safe for any number of
+/*				producer and consumer threads
+/************************************************************************/
+#pragma once
+#include <atomic>
+#include <vector>
+#include <stdint.h>
+#include "Engine/Core/EngineCommon.hpp"
+
+// Bytes kept between the enqueue and dequeue positions, at least a cache line
+#define MPMC_QUEUE_PADDING_SIZE (64)
+
+template <typename T>
+class MPMCQueue
+{
+public:
+	//-----Public Methods-----
+
+	// Capacity is rounded up to a power of two
+	explicit MPMCQueue(int capacity)
+	{
+		size_t roundedCapacity = 2;
+		while (roundedCapacity < (size_t)capacity)
+		{
+			roundedCapacity <<= 1;
+		}
+
+		m_mask = roundedCapacity - 1;
+		m_cells = new Cell_t[roundedCapacity];
+
+		for (size_t cellIndex = 0; cellIndex < roundedCapacity; ++cellIndex)
+		{
+			m_cells[cellIndex].sequence.store(cellIndex, std::memory_order_relaxed);
+		}
+	}
+
+	~MPMCQueue()
+	{
+		delete[] m_cells;
+		m_cells = nullptr;
+	}
+
+	MPMCQueue(const MPMCQueue& copy) = delete;
+	MPMCQueue& operator=(const MPMCQueue& copy) = delete;
+
+
+	// For adding to the queue
+	// Returns false if the queue is full
+	bool Enqueue(T&& value)
+	{
+		Cell_t* cell = nullptr;
+		size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			cell = &m_cells[position & m_mask];
+			size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+
+			if (difference == 0)
+			{
+				// Cell is free for this lap, try to claim it
+				if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (difference < 0)
+			{
+				// Cell still holds last lap's value, so we're full
+				return false;
+			}
+			else
+			{
+				// Another producer got here first
+				position = m_enqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		cell->data = std::move(value);
+		cell->sequence.store(position + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	bool Enqueue(const T& value)
+	{
+		T copy = value;
+		return Enqueue(std::move(copy));
+	}
+
+
+	// For removing and returning from the queue
+	// Returns false if the queue is empty
+	bool Dequeue(T& out_value)
+	{
+		Cell_t* cell = nullptr;
+		size_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			cell = &m_cells[position & m_mask];
+			size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			intptr_t difference = (intptr_t)sequence - (intptr_t)(position + 1);
+
+			if (difference == 0)
+			{
+				if (m_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (difference < 0)
+			{
+				// Nothing has been written here yet, so we're empty
+				return false;
+			}
+			else
+			{
+				position = m_dequeuePosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		out_value = std::move(cell->data);
+
+		// Mark the cell free for the next lap
+		cell->sequence.store(position + m_mask + 1, std::memory_order_release);
+
+		return true;
+	}
+
+
+	// Moves up to maxCount items onto the back of out_values, returning how many were taken
+	int DequeueBatch(std::vector<T>& out_values, int maxCount)
+	{
+		int numTaken = 0;
+		T value;
+
+		while (numTaken < maxCount && Dequeue(value))
+		{
+			out_values.push_back(std::move(value));
+			numTaken++;
+		}
+
+		return numTaken;
+	}
+
+
+	// For checking if the queue is empty, doesn't lock
+	// Only a snapshot while other threads are pushing or popping
+	bool IsEmpty() const
+	{
+		return (m_dequeuePosition.load(std::memory_order_acquire) >= m_enqueuePosition.load(std::memory_order_acquire));
+	}
+
+	int GetCapacity() const
+	{
+		return (int)(m_mask + 1);
+	}
+
+
+private:
+	//-----Private Data-----
+
+	// Sequence tells whose turn it is on the cell: == position means free to write,
+	// == position + 1 means written and free to read
+	struct Cell_t
+	{
+		std::atomic<size_t>	sequence{ 0 };
+		T					data;
+	};
+
+	Cell_t*				m_cells = nullptr;
+	size_t				m_mask = 0;
+
+	// Kept on separate cache lines so producers and consumers don't contend, by padding rather than alignas -
+	// queues are members of heap allocated objects, and the heap doesn't honor alignment past 16 bytes
+	uint8_t				m_padding0[MPMC_QUEUE_PADDING_SIZE];
+	std::atomic<size_t> m_enqueuePosition{ 0 };
+	uint8_t				m_padding1[MPMC_QUEUE_PADDING_SIZE];
+	std::atomic<size_t> m_dequeuePosition{ 0 };
+	uint8_t				m_padding2[MPMC_QUEUE_PADDING_SIZE];
+
+};
@@ -7,11 +7,84 @@
 #include "Engine/DataStructures/NamedProperties.hpp"
 
 
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+NamedProperties::~NamedProperties()
+{
+	Clear();
+
+	if (m_properties != m_inlineProperties)
+	{
+		delete[] m_properties;
+		m_properties = m_inlineProperties;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copy constructor - values on the heap are cloned, so each copy owns its own
+//
+NamedProperties::NamedProperties(const NamedProperties& copy)
+{
+	CopyFrom(copy);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Move constructor
+//
+NamedProperties::NamedProperties(NamedProperties&& other)
+{
+	MoveFrom(other);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copy assignment
+//
+NamedProperties& NamedProperties::operator=(const NamedProperties& copy)
+{
+	if (this != &copy)
+	{
+		Clear();
+		CopyFrom(copy);
+	}
+
+	return *this;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Move assignment
+//
+NamedProperties& NamedProperties::operator=(NamedProperties&& other)
+{
+	if (this != &other)
+	{
+		Clear();
+		MoveFrom(other);
+	}
+
+	return *this;
+}
+
+
 //------------------------------------------------------------------------------
 // Helper for const char* version of Set template, to ensure the string is saved off
 // within this NamedProperties
 //
 void NamedProperties::Set(const std::string& name, const char* value)
+{
+	Set(name.c_str(), std::string(value));
+}
+
+
+//------------------------------------------------------------------------------
+// Helper for const char* version of Set template, to ensure the string is saved off
+// within this NamedProperties
+//
+void NamedProperties::Set(const char* name, const char* value)
 {
 	Set(name, std::string(value));
 }
@@ -20,25 +93,291 @@ void NamedProperties::Set(const std::string& name, const char* value)
 //------------------------------------------------------------------------------
 // Helper for const char* version of Get template
 //
-std::string NamedProperties::Get(const std::string& name, const char* defaultValue)
+std::string NamedProperties::Get(const std::string& name, const char* defaultValue) const
+{
+	return Get(name.c_str(), std::string(defaultValue));
+}
+
+
+//------------------------------------------------------------------------------
+// Helper for const char* version of Get template
+//
+std::string NamedProperties::Get(const char* name, const char* defaultValue) const
 {
 	return Get(name, std::string(defaultValue));
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Returns the string representation of this property set
+// Returns true if there's a property of the given name, of any type
+//
+bool NamedProperties::Contains(const char* name) const
+{
+	return (FindProperty(name) != nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes the property of the given name, if there is one
+//
+void NamedProperties::Remove(const char* name)
+{
+	bool found = false;
+	int index = FindIndex(name, HashName(name), found);
+
+	if (!found)
+	{
+		return;
+	}
+
+	ReleaseValue(m_properties[index]);
+
+	for (int moveIndex = index; moveIndex < m_count - 1; ++moveIndex)
+	{
+		m_properties[moveIndex] = std::move(m_properties[moveIndex + 1]);
+	}
+
+	m_count--;
+	m_properties[m_count] = NamedProperty_t();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes all properties, keeping the capacity
+//
+void NamedProperties::Clear()
+{
+	for (int index = 0; index < m_count; ++index)
+	{
+		ReleaseValue(m_properties[index]);
+		m_properties[index] = NamedProperty_t();
+	}
+
+	m_count = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of properties
+//
+int NamedProperties::GetCount() const
+{
+	return m_count;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the string representation of this property set, in name hash order
 //
 std::string NamedProperties::ToString() const
 {
 	std::string totalString;
-	std::map<std::string, BaseProperty*>::const_iterator itr = m_properties.begin();
 
-	for (itr; itr != m_properties.end(); itr++)
+	for (int index = 0; index < m_count; ++index)
 	{
-		totalString += Stringf("Name: %s - Value: %s\n", itr->first.c_str(), itr->second->GetValueAsString().c_str());
+		const NamedProperty_t& property = m_properties[index];
+		std::string valueString = (property.heapValue != nullptr ? property.heapValue->GetValueAsString() : property.inlineToString(property.inlineValue));
+
+		totalString += Stringf("Name: %s - Value: %s\n", property.name.c_str(), valueString.c_str());
 	}
 
 	return totalString;
 }
 
+
+//-----------------------------------------------------------------------------------------------
+// FNV-1a of the name
+//
+uint32_t NamedProperties::HashName(const char* name)
+{
+	uint32_t hash = 2166136261u;
+
+	while (*name != '\0')
+	{
+		hash = (hash ^ (uint32_t) (uint8_t) *name) * 16777619u;
+		++name;
+	}
+
+	return hash;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Binary searches the properties by hash, then checks the names of any with the same hash
+// Returns the index of the property if found, otherwise the index it would be inserted at
+//
+int NamedProperties::FindIndex(const char* name, uint32_t nameHash, bool& out_found) const
+{
+	int low = 0;
+	int high = m_count;
+
+	while (low < high)
+	{
+		int middle = (low + high) / 2;
+
+		if (m_properties[middle].nameHash < nameHash)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	for (int index = low; index < m_count && m_properties[index].nameHash == nameHash; ++index)
+	{
+		if (m_properties[index].name == name)
+		{
+			out_found = true;
+			return index;
+		}
+	}
+
+	out_found = false;
+	return low;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the property of the given name, or nullptr if there isn't one
+//
+const NamedProperty_t* NamedProperties::FindProperty(const char* name) const
+{
+	bool found = false;
+	int index = FindIndex(name, HashName(name), found);
+
+	return (found ? &m_properties[index] : nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the property of the given name, inserting an empty one in hash order if there isn't one
+//
+NamedProperty_t& NamedProperties::GetOrAddProperty(const char* name)
+{
+	uint32_t nameHash = HashName(name);
+
+	bool found = false;
+	int index = FindIndex(name, nameHash, found);
+
+	if (found)
+	{
+		return m_properties[index];
+	}
+
+	if (m_count == m_capacity)
+	{
+		Reserve(m_capacity * 2);
+	}
+
+	for (int moveIndex = m_count; moveIndex > index; --moveIndex)
+	{
+		m_properties[moveIndex] = std::move(m_properties[moveIndex - 1]);
+	}
+
+	m_count++;
+
+	NamedProperty_t& property = m_properties[index];
+	property = NamedProperty_t();
+	property.nameHash = nameHash;
+	property.name = name;
+
+	return property;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Moves the properties to a heap array, if they need more room than they have
+//
+void NamedProperties::Reserve(int capacity)
+{
+	if (capacity <= m_capacity)
+	{
+		return;
+	}
+
+	MEMORY_TAG_SCOPE("NamedProperties");
+	NamedProperty_t* newProperties = new NamedProperty_t[capacity];
+
+	for (int index = 0; index < m_count; ++index)
+	{
+		newProperties[index] = std::move(m_properties[index]);
+		m_properties[index] = NamedProperty_t();
+	}
+
+	if (m_properties != m_inlineProperties)
+	{
+		delete[] m_properties;
+	}
+
+	m_properties = newProperties;
+	m_capacity = capacity;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies the properties into this one, which must be empty, cloning the values on the heap
+//
+void NamedProperties::CopyFrom(const NamedProperties& copy)
+{
+	Reserve(copy.m_count);
+
+	for (int index = 0; index < copy.m_count; ++index)
+	{
+		m_properties[index] = copy.m_properties[index];
+
+		if (copy.m_properties[index].heapValue != nullptr)
+		{
+			m_properties[index].heapValue = copy.m_properties[index].heapValue->Clone();
+		}
+	}
+
+	m_count = copy.m_count;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Takes the properties from the other one, which is left empty; this one must be empty
+//
+void NamedProperties::MoveFrom(NamedProperties& other)
+{
+	if (other.m_properties != other.m_inlineProperties)
+	{
+		// Take the heap array whole
+		if (m_properties != m_inlineProperties)
+		{
+			delete[] m_properties;
+		}
+
+		m_properties = other.m_properties;
+		m_capacity = other.m_capacity;
+		m_count = other.m_count;
+
+		other.m_properties = other.m_inlineProperties;
+		other.m_capacity = NAMED_PROPERTIES_INLINE_COUNT;
+		other.m_count = 0;
+
+		return;
+	}
+
+	for (int index = 0; index < other.m_count; ++index)
+	{
+		m_properties[index] = std::move(other.m_properties[index]);
+		other.m_properties[index] = NamedProperty_t();
+	}
+
+	m_count = other.m_count;
+	other.m_count = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes the property's value if it was on the heap
+//
+void NamedProperties::ReleaseValue(NamedProperty_t& property)
+{
+	delete property.heapValue;
+	property.heapValue = nullptr;
+	property.inlineToString = nullptr;
+}
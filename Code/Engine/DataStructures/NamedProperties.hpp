@@ -6,16 +6,29 @@
 /************************************************************************/
 #pragma once
 #include <string>
-#include <map>
+#include <string.h>
+#include <stdint.h>
+#include <type_traits>
 #include "Engine/Core/Utility/StringUtils.hpp"
+#include "Engine/Core/Memory/MemoryTracker.hpp"
+
+// Trivially copyable values up to this size are stored in the property itself, anything else in a TypedProperty
+#define NAMED_PROPERTY_INLINE_BYTES (16)
+
+// Properties held without allocating, past this they move to the heap
+#define NAMED_PROPERTIES_INLINE_COUNT (4)
+
 
 class BaseProperty
 {
 public:
 	//-----Public Methods-----
 
+	virtual ~BaseProperty() {}
+
 	virtual std::string GetValueAsString() const = 0;
 	virtual void const* GetTypeID() const = 0;
+	virtual BaseProperty* Clone() const = 0;
 
 };
 
@@ -50,6 +63,12 @@ public:
 		return &s_typeID;
 	}
 
+	//-----------------------------------------------------------------------------------------------
+	virtual BaseProperty* Clone() const override
+	{
+		return new TypedProperty<T>(*this);
+	}
+
 	//-----------------------------------------------------------------------------------------------
 	static void const* GetTypeIDStatic()
 	{
@@ -66,46 +85,87 @@ private:
 };
 
 
+// One entry of the bag, kept sorted by name hash
+struct NamedProperty_t
+{
+	uint32_t		nameHash = 0;
+	void const*		typeID = nullptr;				// TypedProperty<T>::GetTypeIDStatic() either way it's stored
+	std::string		name;
+	BaseProperty*	heapValue = nullptr;			// Only for values that don't fit inline
+	std::string		(*inlineToString)(const unsigned char* value) = nullptr;
+	alignas(16) unsigned char inlineValue[NAMED_PROPERTY_INLINE_BYTES];
+};
+
+
 class NamedProperties
 {
 public:
 	//-----Public Methods-----
 
+	NamedProperties() {}
+	~NamedProperties();
+	NamedProperties(const NamedProperties& copy);
+	NamedProperties(NamedProperties&& other);
+	NamedProperties& operator=(const NamedProperties& copy);
+	NamedProperties& operator=(NamedProperties&& other);
+
 	//-----------------------------------------------------------------------------------------------
 	template <typename T>
 	void Set(const std::string& name, const T& value)
 	{
-		bool alreadyExists = m_properties.find(name) != m_properties.end();
-		
-		if (alreadyExists) // Avoid type mismatching
+		Set(name.c_str(), value);
+	}
+
+	//-----------------------------------------------------------------------------------------------
+	template <typename T>
+	void Set(const char* name, const T& value)
+	{
+		// Replaced whole, to avoid type mismatching
+		NamedProperty_t& property = GetOrAddProperty(name);
+		ReleaseValue(property);
+
+		property.typeID = TypedProperty<T>::GetTypeIDStatic();
+
+		if constexpr (IsStoredInline<T>())
+		{
+			memcpy(property.inlineValue, &value, sizeof(T));
+			property.inlineToString = &InlineValueToString<T>;
+		}
+		else
 		{
-			BaseProperty* bp = m_properties[name];
-			m_properties.erase(name);
+			MEMORY_TAG_SCOPE("NamedProperties");
 
-			delete bp;
+			TypedProperty<T>* tp = new TypedProperty<T>();
+			tp->SetValue(value);
+			property.heapValue = tp;
 		}
+	}
 
-		TypedProperty<T>* tp = new TypedProperty<T>();
-		tp->SetValue(value);
-		m_properties[name] = tp;
+	//-----------------------------------------------------------------------------------------------
+	template <typename T>
+	T Get(const std::string& name, const T& defaultValue) const
+	{
+		return Get(name.c_str(), defaultValue);
 	}
 
 	//-----------------------------------------------------------------------------------------------
 	template <typename T>
-	T Get(const std::string& name, const T& defaultValue)
+	T Get(const char* name, const T& defaultValue) const
 	{
-		bool propertyExists = m_properties.find(name) != m_properties.end();
+		const NamedProperty_t* property = FindProperty(name);
 
-		if (propertyExists)
+		// Check types
+		if (property != nullptr && property->typeID == TypedProperty<T>::GetTypeIDStatic())
 		{
-			BaseProperty* bp = m_properties[name];
-
-			// Check types
-			if (bp->GetTypeID() == TypedProperty<T>::GetTypeIDStatic())
+			if constexpr (IsStoredInline<T>())
 			{
-				TypedProperty<T>* tp = static_cast<TypedProperty<T>*>(bp);
-				return tp->GetValue();
+				T value;
+				memcpy(&value, property->inlineValue, sizeof(T));
+				return value;
 			}
+
+			TypedProperty<T>* tp = static_cast<TypedProperty<T>*>(property->heapValue);
+			return tp->GetValue();
 		}
 
 		// Property doesn't exist or is mismatched type, return the default
@@ -114,14 +174,71 @@ public:
 
 	//---String/Const Char* Helpers-----
 	void		Set(const std::string& name, const char* value);
-	std::string Get(const std::string& name, const char* defaultValue);
+	void		Set(const char* name, const char* value);
+	std::string Get(const std::string& name, const char* defaultValue) const;
+	std::string Get(const char* name, const char* defaultValue) const;
+
+	bool		Contains(const char* name) const;
+	void		Remove(const char* name);
+	void		Clear();
+	int			GetCount() const;
 
 	std::string ToString() const;
 
 
+private:
+	//-----Private Methods-----
+
+	template <typename T>
+	static constexpr bool	IsStoredInline();
+	template <typename T>
+	static std::string		InlineValueToString(const unsigned char* value);
+
+	static uint32_t			HashName(const char* name);
+
+	int						FindIndex(const char* name, uint32_t nameHash, bool& out_found) const;
+	const NamedProperty_t*	FindProperty(const char* name) const;
+	NamedProperty_t&		GetOrAddProperty(const char* name);
+	void					Reserve(int capacity);
+	void					CopyFrom(const NamedProperties& copy);
+	void					MoveFrom(NamedProperties& other);
+	static void				ReleaseValue(NamedProperty_t& property);
+
+
 private:
 	//-----Private Data-----
 
-	std::map<std::string, BaseProperty*> m_properties;
+	NamedProperty_t		m_inlineProperties[NAMED_PROPERTIES_INLINE_COUNT];
+	NamedProperty_t*	m_properties = m_inlineProperties;		// Either the inline array or one on the heap
+	int					m_count = 0;
+	int					m_capacity = NAMED_PROPERTIES_INLINE_COUNT;
 
 };
+
+
+//////////////////////////////////////////////////////////////////////////
+// Template Implementations
+//////////////////////////////////////////////////////////////////////////
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if values of the type are memcpy'd into the property instead of allocated
+//
+template <typename T>
+constexpr bool NamedProperties::IsStoredInline()
+{
+	return (std::is_trivially_copyable<T>::value && sizeof(T) <= NAMED_PROPERTY_INLINE_BYTES && alignof(T) <= 16);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the string of a value stored inline, for ToString()
+//
+template <typename T>
+std::string NamedProperties::InlineValueToString(const unsigned char* value)
+{
+	T typedValue;
+	memcpy(&typedValue, value, sizeof(T));
+
+	return ::ToString(typedValue);
+}
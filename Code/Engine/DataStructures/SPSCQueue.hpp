@@ -0,0 +1,155 @@
+/************************************************************************/
+/* File: SPSCQueue.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Bounded lock-free ring buffer for one producer thread
+/*				and one consumer thread
+/************************************************************************/
+#pragma once
+#include <atomic>
+#include <vector>
+#include <stdint.h>
+#include "Engine/Core/EngineCommon.hpp"
+
+// Bytes kept between the producer's and consumer's members, at least a cache line
+#define SPSC_QUEUE_PADDING_SIZE (64)
+
+template <typename T>
+class SPSCQueue
+{
+public:
+	//-----Public Methods-----
+
+	// Capacity is rounded up to a power of two
+	explicit SPSCQueue(int capacity)
+	{
+		size_t roundedCapacity = 2;
+		while (roundedCapacity < (size_t)capacity)
+		{
+			roundedCapacity <<= 1;
+		}
+
+		m_mask = roundedCapacity - 1;
+		m_buffer = new T[roundedCapacity];
+	}
+
+	~SPSCQueue()
+	{
+		delete[] m_buffer;
+		m_buffer = nullptr;
+	}
+
+	SPSCQueue(const SPSCQueue& copy) = delete;
+	SPSCQueue& operator=(const SPSCQueue& copy) = delete;
+
+
+	// For adding to the queue, producer thread only
+	// Returns false if the queue is full
+	bool Enqueue(T&& value)
+	{
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+
+		// Only re-read the consumer's index when our cached copy says we're full
+		if (tail - m_cachedHead > m_mask)
+		{
+			m_cachedHead = m_head.load(std::memory_order_acquire);
+
+			if (tail - m_cachedHead > m_mask)
+			{
+				return false;
+			}
+		}
+
+		m_buffer[tail & m_mask] = std::move(value);
+		m_tail.store(tail + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	bool Enqueue(const T& value)
+	{
+		T copy = value;
+		return Enqueue(std::move(copy));
+	}
+
+
+	// For removing and returning from the queue, consumer thread only
+	// Returns false if the queue is empty
+	bool Dequeue(T& out_value)
+	{
+		size_t head = m_head.load(std::memory_order_relaxed);
+
+		if (head == m_cachedTail)
+		{
+			m_cachedTail = m_tail.load(std::memory_order_acquire);
+
+			if (head == m_cachedTail)
+			{
+				return false;
+			}
+		}
+
+		out_value = std::move(m_buffer[head & m_mask]);
+		m_head.store(head + 1, std::memory_order_release);
+
+		return true;
+	}
+
+
+	// Moves up to maxCount items onto the back of out_values, consumer thread only
+	// Only publishes the new head once, so the producer sees the space freed in one go
+	int DequeueBatch(std::vector<T>& out_values, int maxCount)
+	{
+		size_t head = m_head.load(std::memory_order_relaxed);
+		m_cachedTail = m_tail.load(std::memory_order_acquire);
+
+		size_t numAvailable = m_cachedTail - head;
+		int numToTake = (int)(numAvailable < (size_t)maxCount ? numAvailable : (size_t)maxCount);
+
+		for (int index = 0; index < numToTake; ++index)
+		{
+			out_values.push_back(std::move(m_buffer[(head + index) & m_mask]));
+		}
+
+		if (numToTake > 0)
+		{
+			m_head.store(head + numToTake, std::memory_order_release);
+		}
+
+		return numToTake;
+	}
+
+
+	// For checking if the queue is empty, doesn't lock
+	bool IsEmpty() const
+	{
+		return (m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire));
+	}
+
+	int GetCapacity() const
+	{
+		return (int)(m_mask + 1);
+	}
+
+
+private:
+	//-----Private Data-----
+
+	T*					m_buffer = nullptr;
+	size_t				m_mask = 0;
+
+	// Each side is kept on its own cache line by a full line of padding, rather than alignas - queues are
+	// members of heap allocated objects, and the heap doesn't honor alignment past 16 bytes
+	uint8_t				m_padding0[SPSC_QUEUE_PADDING_SIZE];
+
+	// Consumer side
+	std::atomic<size_t> m_head{ 0 };
+	size_t				m_cachedTail = 0;
+	uint8_t				m_padding1[SPSC_QUEUE_PADDING_SIZE];
+
+	// Producer side
+	std::atomic<size_t> m_tail{ 0 };
+	size_t				m_cachedHead = 0;
+	uint8_t				m_padding2[SPSC_QUEUE_PADDING_SIZE];
+
+};
@@ -0,0 +1,125 @@
+/************************************************************************/
+/* File: SlabAllocator.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the SlabAllocator class
+/************************************************************************/
+#include "Engine/DataStructures/SlabAllocator.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - the first slab is made on the first allocation
+//
+SlabAllocator::SlabAllocator(size_t blockSize, int blocksPerSlab)
+	: m_blocksPerSlab(blocksPerSlab)
+{
+	ASSERT_OR_DIE(blockSize > 0 && blocksPerSlab > 0, "Error: SlabAllocator created with an empty block or slab size");
+
+	if (blockSize < sizeof(SlabFreeBlock_t))
+	{
+		blockSize = sizeof(SlabFreeBlock_t);
+	}
+
+	m_blockSize = (blockSize + 15) & ~((size_t) 15);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor - frees every slab, so no blocks can be in use anymore
+//
+SlabAllocator::~SlabAllocator()
+{
+	for (int slabIndex = 0; slabIndex < (int) m_slabs.size(); ++slabIndex)
+	{
+		::operator delete(m_slabs[slabIndex]);
+	}
+
+	m_slabs.clear();
+	m_freeList = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a block from the free list, adding a slab first if it's empty
+//
+void* SlabAllocator::Allocate()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	if (m_freeList == nullptr)
+	{
+		AddSlab();
+	}
+
+	SlabFreeBlock_t* block = m_freeList;
+	m_freeList = block->next;
+	m_allocatedCount++;
+
+	return block;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Puts the block back on the free list; slabs are kept for the allocator's lifetime
+//
+void SlabAllocator::Free(void* block)
+{
+	if (block == nullptr)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	SlabFreeBlock_t* freeBlock = reinterpret_cast<SlabFreeBlock_t*>(block);
+	freeBlock->next = m_freeList;
+	m_freeList = freeBlock;
+	m_allocatedCount--;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the size of each block, after rounding
+//
+size_t SlabAllocator::GetBlockSize() const
+{
+	return m_blockSize;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of slabs allocated so far
+//
+int SlabAllocator::GetSlabCount() const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	return (int) m_slabs.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of blocks currently handed out
+//
+int SlabAllocator::GetAllocatedCount() const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	return m_allocatedCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Allocates a new slab and links all of its blocks onto the free list, in address order
+//
+void SlabAllocator::AddSlab()
+{
+	unsigned char* slab = (unsigned char*) ::operator new(m_blockSize * m_blocksPerSlab);
+	m_slabs.push_back(slab);
+
+	for (int blockIndex = m_blocksPerSlab - 1; blockIndex >= 0; --blockIndex)
+	{
+		SlabFreeBlock_t* block = reinterpret_cast<SlabFreeBlock_t*>(slab + blockIndex * m_blockSize);
+		block->next = m_freeList;
+		m_freeList = block;
+	}
+}
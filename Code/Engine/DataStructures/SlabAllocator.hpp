@@ -0,0 +1,57 @@
+/************************************************************************/
+/* File: SlabAllocator.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Fixed-size block allocator that carves blocks out of
+/*				large slabs and recycles them through a free list
+/************************************************************************/
+#pragma once
+#include <mutex>
+#include <vector>
+
+// Free blocks are linked through their own memory
+struct SlabFreeBlock_t
+{
+	SlabFreeBlock_t* next = nullptr;
+};
+
+
+class SlabAllocator
+{
+public:
+	//-----Public Methods-----
+
+	// Blocks are 16 byte aligned, so blockSize is rounded up to a multiple of 16
+	SlabAllocator(size_t blockSize, int blocksPerSlab);
+	~SlabAllocator();
+
+	SlabAllocator(const SlabAllocator& copy) = delete;
+	SlabAllocator& operator=(const SlabAllocator& copy) = delete;
+
+	// Thread safe - only Allocate() on an empty free list goes to the heap, for a whole slab
+	void*	Allocate();
+	void	Free(void* block);
+
+	size_t	GetBlockSize() const;
+	int		GetSlabCount() const;
+	int		GetAllocatedCount() const;
+
+
+private:
+	//-----Private Methods-----
+
+	void	AddSlab();	// m_lock must be held
+
+
+private:
+	//-----Private Data-----
+
+	size_t					m_blockSize = 0;
+	int						m_blocksPerSlab = 0;
+
+	mutable std::mutex		m_lock;
+	SlabFreeBlock_t*		m_freeList = nullptr;
+	std::vector<void*>		m_slabs;
+	int						m_allocatedCount = 0;
+
+};
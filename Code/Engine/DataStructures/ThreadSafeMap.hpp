@@ -24,10 +24,10 @@ public:
 	}
 
 	// For removing from map
-	bool Erase()
+	bool Erase(const K& key)
 	{
 		m_lock.lock(); // Blocks
-		std::map<K,T>::iterator itr = m_map.find(out_value);
+		typename std::map<K,T>::iterator itr = m_map.find(key);
 		bool itemExists = (itr != m_map.end());
 
 		if (itemExists)
@@ -44,7 +44,7 @@ public:
 	{
 		m_lock.lock_shared();
 
-		std::set::iterator<T> itr = m_map.find(key);
+		typename std::map<K,T>::const_iterator itr = m_map.find(key);
 		bool itemExists = (itr != m_map.end());
 
 		if (itemExists)
@@ -68,7 +68,7 @@ public:
 private:
 	//-----Private Data-----
 
-	std::shared_mutex m_lock;
+	mutable std::shared_mutex m_lock;
 	std::map<K,T> m_map;
 
 };
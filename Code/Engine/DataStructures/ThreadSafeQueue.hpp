@@ -7,6 +7,7 @@
 #pragma once
 #include <queue>
 #include <mutex>
+#include <atomic>
 #include "Engine/Core/EngineCommon.hpp"
 
 template <typename T>
@@ -20,6 +21,17 @@ public:
 	{
 		m_lock.lock(); // Blocks
 		m_queue.push(value);
+		m_size++;
+		m_lock.unlock();
+	}
+
+
+	// For adding to the queue without copying
+	void Enqueue(T&& value)
+	{
+		m_lock.lock(); // Blocks
+		m_queue.push(std::move(value));
+		m_size++;
 		m_lock.unlock();
 	}
 
@@ -32,8 +44,9 @@ public:
 
 		if (hasItem)
 		{
-			out_value = m_queue.front();
+			out_value = std::move(m_queue.front());
 			m_queue.pop();
+			m_size--;
 		}
 
 		m_lock.unlock();
@@ -41,14 +54,10 @@ public:
 	}
 
 	
-	// For checking if the queue is empty
-	bool IsEmpty()
+	// For checking if the queue is empty, doesn't lock
+	bool IsEmpty() const
 	{
-		m_lock.lock();
-		bool isEmpty = m_queue.empty();
-		m_lock.unlock();
-
-		return isEmpty;
+		return (m_size.load(std::memory_order_acquire) == 0);
 	}
 
 
@@ -57,5 +66,6 @@ private:
 
 	std::mutex m_lock;
 	std::queue<T> m_queue;
+	std::atomic<int> m_size{ 0 };
 
 };
@@ -0,0 +1,40 @@
+/************************************************************************/
+/* File: InputEvent.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: A single timestamped input change, queued by the
+/*				InputSystem for games that read input between frames
+/************************************************************************/
+#pragma once
+#include <stdint.h>
+#include "Engine/Math/Vector2.hpp"
+#include "Engine/Math/IntVector2.hpp"
+
+// Keys come from the window's messages, mouse events from raw mouse input, and controller
+// events from controller polling - each only while it's enabled
+enum eInputEventType
+{
+	INPUT_EVENT_KEY_DOWN,					// code is the key code
+	INPUT_EVENT_KEY_UP,
+	INPUT_EVENT_MOUSE_MOVE,					// mouseDelta is the raw mouse movement
+	INPUT_EVENT_MOUSE_BUTTON_DOWN,			// code is the MouseButton
+	INPUT_EVENT_MOUSE_BUTTON_UP,
+	INPUT_EVENT_MOUSE_WHEEL,				// value.x is the wheel delta, 1 per notch
+	INPUT_EVENT_CONTROLLER_CONNECTED,
+	INPUT_EVENT_CONTROLLER_DISCONNECTED,
+	INPUT_EVENT_CONTROLLER_BUTTON_DOWN,		// code is the XboxButtonID
+	INPUT_EVENT_CONTROLLER_BUTTON_UP,
+	INPUT_EVENT_CONTROLLER_STICK,			// code is the XboxStickID, value the raw stick position in [-1,1]
+	INPUT_EVENT_CONTROLLER_TRIGGER,			// code is the XboxTriggerID, value.x the trigger in [0,1]
+	NUM_INPUT_EVENT_TYPES
+};
+
+struct InputEvent_t
+{
+	eInputEventType	type = INPUT_EVENT_KEY_DOWN;
+	uint64_t		timestamp = 0;						// GetPerformanceCounter() when the input was read
+	int				controllerNumber = 0;				// Controller events only
+	int				code = 0;
+	IntVector2		mouseDelta = IntVector2::ZERO;
+	Vector2			value = Vector2::ZERO;
+};
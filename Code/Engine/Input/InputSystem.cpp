@@ -8,12 +8,16 @@
 /************************************************************************/
 #include "Engine/Core/Window.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/Time/Time.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
 #endif		// Always #define this before #including <windows.h>
 #include <windows.h>
+#include <mmsystem.h>
+#pragma comment( lib, "winmm" )	// For timeBeginPeriod(), so the polling thread can sleep for 1ms
 
 // Singleton instance
 InputSystem* InputSystem::s_instance = nullptr;
@@ -93,36 +97,119 @@ InputSystem::InputSystem()
 	for (int i = 0; i < NUM_CONTROLLERS; i++)
 	{
 		m_xboxControllers[i] = XboxController(i);
+		m_hasControllerSnapshots[i] = false;
 	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
 // Destructor - made private (use InputSystem::Shutdown() instead)
+// Stops the input threads, which reference this system
 //
 InputSystem::~InputSystem()
 {
+	StopControllerPolling();
+	EnableRawMouseInput(false);
 }
 
 
-//-----------------------------------------------------------------------------------------------
-// Processes all Windows messages (WM_xxx) for this app that have queued up since last frame.
-// For each message in the queue, our WindowsMessageHandlingProcedure (or "WinProc") function
-//	is called, telling us what happened (key up/down, minimized/restored, gained/lost focus, etc.)
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Reads one WM_INPUT message, handing mouse movement to the Mouse and queueing it as events
+// RIDEV_INPUTSINK delivers input while the game is in the background too, so that's ignored
 //
-void RunMessagePump()
+static void ProcessRawInput(HRAWINPUT rawInputHandle)
 {
-	MSG queuedMessage;
-	for( ;; )
+	RAWINPUT rawInput;
+	UINT rawInputSize = sizeof(rawInput);
+
+	if (GetRawInputData(rawInputHandle, RID_INPUT, &rawInput, &rawInputSize, sizeof(RAWINPUTHEADER)) == (UINT) -1)
+	{
+		return;
+	}
+
+	HWND gameWindow = (HWND) Window::GetInstance()->GetHandle();
+	if (rawInput.header.dwType != RIM_TYPEMOUSE || GetForegroundWindow() != gameWindow)
+	{
+		return;
+	}
+
+	InputSystem* input = InputSystem::GetInstance();
+	const RAWMOUSE& rawMouse = rawInput.data.mouse;
+
+	InputEvent_t inputEvent;
+	inputEvent.timestamp = GetPerformanceCounter();
+
+	// Tablets and remote desktops report absolute positions, those are left to the cursor
+	if ((rawMouse.usFlags & MOUSE_MOVE_ABSOLUTE) == 0 && (rawMouse.lLastX != 0 || rawMouse.lLastY != 0))
+	{
+		InputSystem::GetMouse().OnRawMouseMove(rawMouse.lLastX, rawMouse.lLastY);
+
+		inputEvent.type = INPUT_EVENT_MOUSE_MOVE;
+		inputEvent.mouseDelta = IntVector2(rawMouse.lLastX, rawMouse.lLastY);
+		input->PushEvent(inputEvent);
+	}
+
+	// Button transitions, in MouseButton order
+	const USHORT downFlags[NUM_MOUSEBUTTONS] = { RI_MOUSE_LEFT_BUTTON_DOWN, RI_MOUSE_RIGHT_BUTTON_DOWN, RI_MOUSE_MIDDLE_BUTTON_DOWN };
+	const USHORT upFlags[NUM_MOUSEBUTTONS] = { RI_MOUSE_LEFT_BUTTON_UP, RI_MOUSE_RIGHT_BUTTON_UP, RI_MOUSE_MIDDLE_BUTTON_UP };
+
+	for (int buttonIndex = 0; buttonIndex < NUM_MOUSEBUTTONS; ++buttonIndex)
 	{
-		const BOOL wasMessagePresent = PeekMessage( &queuedMessage, NULL, 0, 0, PM_REMOVE );
-		if( !wasMessagePresent )
+		if ((rawMouse.usButtonFlags & (downFlags[buttonIndex] | upFlags[buttonIndex])) != 0)
 		{
-			break;
+			inputEvent.type = ((rawMouse.usButtonFlags & downFlags[buttonIndex]) != 0 ? INPUT_EVENT_MOUSE_BUTTON_DOWN : INPUT_EVENT_MOUSE_BUTTON_UP);
+			inputEvent.code = buttonIndex;
+			input->PushEvent(inputEvent);
 		}
+	}
+
+	if ((rawMouse.usButtonFlags & RI_MOUSE_WHEEL) != 0)
+	{
+		inputEvent.type = INPUT_EVENT_MOUSE_WHEEL;
+		inputEvent.code = 0;
+		inputEvent.value = Vector2((float) (short) rawMouse.usButtonData * (1.f / (float) WHEEL_DELTA), 0.f);
+		input->PushEvent(inputEvent);
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Message handler for the raw input thread's message-only window
+//
+static LRESULT CALLBACK RawInputWindowProcedure(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam)
+{
+	switch (msg)
+	{
+	case WM_INPUT:
+		// Still passed on to DefWindowProc, which frees the input
+		ProcessRawInput((HRAWINPUT) lparam);
+		break;
+	case WM_CLOSE:
+		DestroyWindow(hwnd);
+		return 0;
+	case WM_DESTROY:
+		PostQuitMessage(0);
+		return 0;
+	}
+
+	return DefWindowProc(hwnd, msg, wparam, lparam);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Processes all Windows messages (WM_xxx) for this app that have queued up since last frame.
+// The window's own thread has already pumped them into its queue, so this only runs the handlers,
+//	telling us what happened (key up/down, minimized/restored, gained/lost focus, etc.)
+//	and never waits on the OS, even while the window is being moved or resized
+//
+void RunMessagePump()
+{
+	Window* window = Window::GetInstance();
 
-		TranslateMessage( &queuedMessage );
-		DispatchMessage( &queuedMessage );
+	WindowMessage_t message;
+	while (window->PopMessage(message))
+	{
+		window->RunHandlers(message);
 	}
 }
 
@@ -158,10 +245,24 @@ void InputSystem::Shutdown()
 //
 void InputSystem::BeginFrame()
 {
+	// No window or devices to read - keys stay released and controllers disconnected
+	if (IsEngineHeadless())
+	{
+		ResetJustKeyStates();
+		return;
+	}
+
 	m_mouse.BeginFrame();
 	ResetJustKeyStates();
 	UpdateControllers();
 	RunMessagePump();
+
+	int droppedMessageCount = Window::GetInstance()->GetDroppedMessageCount();
+	if (droppedMessageCount > m_reportedDroppedMessageCount)
+	{
+		LogTaggedPrintf("INPUT", "Window message queue was full, %i messages dropped", droppedMessageCount - m_reportedDroppedMessageCount);
+		m_reportedDroppedMessageCount = droppedMessageCount;
+	}
 }
 
 
@@ -181,6 +282,13 @@ void InputSystem::OnKeyPressed(unsigned char keyCode)
 	if (!m_keyStates[keyCode].m_isPressed)
 	{
 		m_keyStates[keyCode].m_wasJustPressed = true;
+
+		// Repeats aren't queued
+		InputEvent_t inputEvent;
+		inputEvent.type = INPUT_EVENT_KEY_DOWN;
+		inputEvent.timestamp = GetPerformanceCounter();
+		inputEvent.code = keyCode;
+		PushEvent(inputEvent);
 	}
 
 	m_keyStates[keyCode].m_isPressed = true;
@@ -195,6 +303,12 @@ void InputSystem::OnKeyReleased(unsigned char keyCode)
 	m_keyStates[keyCode].m_isPressed = false;
 	
 	m_keyStates[keyCode].m_wasJustReleased = true;
+
+	InputEvent_t inputEvent;
+	inputEvent.type = INPUT_EVENT_KEY_UP;
+	inputEvent.timestamp = GetPerformanceCounter();
+	inputEvent.code = keyCode;
+	PushEvent(inputEvent);
 }
 
 
@@ -233,6 +347,163 @@ XboxController& InputSystem::GetController(int controllerNumber)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Starts or stops reading the mouse through raw input, on a thread with its own message-only window
+// so the input is read as it arrives, not when the frame next pumps messages
+//
+void InputSystem::EnableRawMouseInput(bool shouldEnable)
+{
+	if (shouldEnable == (m_rawInputThread != nullptr) || IsEngineHeadless())
+	{
+		return;
+	}
+
+	if (shouldEnable)
+	{
+		m_rawInputThreadState = INPUT_THREAD_STARTING;
+		m_rawInputThread = Thread::Create(RawInputThreadEntry, this, "Raw Input", THREAD_AFFINITY_ANY, THREAD_PRIORITY_SETTING_HIGHEST);
+
+		// Wait for the window, so a disable right after has something to close
+		while (m_rawInputThreadState == INPUT_THREAD_STARTING)
+		{
+			Thread::YieldThisThread();
+		}
+
+		if (m_rawInputThreadState == INPUT_THREAD_STOPPED)
+		{
+			Thread::Join(m_rawInputThread);
+			m_rawInputThread = nullptr;
+
+			LogTaggedPrintf("INPUT", "Couldn't register for raw mouse input, using the cursor only");
+			return;
+		}
+
+		m_mouse.SetRawInputEnabled(true);
+	}
+	else
+	{
+		HWND rawInputWindow = (HWND) m_rawInputWindow.load();
+		if (rawInputWindow != nullptr)
+		{
+			PostMessage(rawInputWindow, WM_CLOSE, 0, 0);
+		}
+
+		Thread::Join(m_rawInputThread);
+		m_rawInputThread = nullptr;
+
+		m_mouse.SetRawInputEnabled(false);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the mouse is read through raw input
+//
+bool InputSystem::IsRawMouseInputEnabled() const
+{
+	return (m_rawInputThread != nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts polling the controllers on their own thread
+//
+void InputSystem::StartControllerPolling(float pollHz)
+{
+	if (IsEngineHeadless())
+	{
+		return;
+	}
+
+	if (m_controllerPollThread != nullptr)
+	{
+		StopControllerPolling();
+	}
+
+	m_controllerPollHz = ClampFloat(pollHz, 1.f, 1000.f);
+
+	for (int controllerIndex = 0; controllerIndex < NUM_CONTROLLERS; ++controllerIndex)
+	{
+		m_hasControllerSnapshots[controllerIndex] = false;
+	}
+
+	m_isPollingControllers = true;
+	m_controllerPollThread = Thread::Create(ControllerPollThreadEntry, this, "Controller Poll", THREAD_AFFINITY_ANY, THREAD_PRIORITY_SETTING_HIGHEST);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stops the polling thread, the controllers are polled in BeginFrame again
+//
+void InputSystem::StopControllerPolling()
+{
+	if (m_controllerPollThread == nullptr)
+	{
+		return;
+	}
+
+	m_isPollingControllers = false;
+	Thread::Join(m_controllerPollThread);
+	m_controllerPollThread = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the controllers are polled on their own thread
+//
+bool InputSystem::IsPollingControllers() const
+{
+	return (m_controllerPollThread != nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Turns the event queue on or off; turning it off drops whatever wasn't popped
+//
+void InputSystem::EnableEventQueue(bool shouldEnable)
+{
+	m_isEventQueueEnabled = shouldEnable;
+
+	if (!shouldEnable)
+	{
+		InputEvent_t discarded;
+		while (m_events.Dequeue(discarded)) {}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if input changes are being queued
+//
+bool InputSystem::IsEventQueueEnabled() const
+{
+	return m_isEventQueueEnabled;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues the event, if the queue is on
+//
+void InputSystem::PushEvent(const InputEvent_t& inputEvent)
+{
+	if (m_isEventQueueEnabled.load(std::memory_order_relaxed))
+	{
+		m_events.Enqueue(inputEvent);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Pops the oldest event, returning false once there are none
+// Events from different threads are in the order they were queued, so sort by timestamp if exact
+// ordering across devices matters
+//
+bool InputSystem::PopEvent(InputEvent_t& out_event)
+{
+	return m_events.Dequeue(out_event);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the InputSystem singleton instance
 //
@@ -277,8 +548,25 @@ void InputSystem::ResetJustKeyStates()
 //-----------------------------------------------------------------------------------------------
 // Fetches the last-frame input for each controller from XInput
 //
+// When polled on their own thread, applies the latest poll instead
+//
 void InputSystem::UpdateControllers()
 {
+	if (m_controllerPollThread != nullptr)
+	{
+		std::lock_guard<std::mutex> lock(m_controllerSnapshotLock);
+
+		for (int i = 0; i < NUM_CONTROLLERS; i++)
+		{
+			if (m_hasControllerSnapshots[i])
+			{
+				m_xboxControllers[i].ApplySnapshot(m_controllerSnapshots[i]);
+			}
+		}
+
+		return;
+	}
+
 	for (int i = 0; i < NUM_CONTROLLERS; i++)
 	{
 		m_xboxControllers[i].Update();
@@ -286,3 +574,179 @@ void InputSystem::UpdateControllers()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Entry for the controller polling thread - polls each controller at the poll rate, queueing what
+// changed and keeping the latest poll for the next frame
+//
+void InputSystem::ControllerPollThreadEntry(void* args)
+{
+	InputSystem* input = (InputSystem*) args;
+
+	// The default timer resolution makes a 1ms sleep around 15ms
+	timeBeginPeriod(1);
+
+	XboxControllerSnapshot_t reportedSnapshots[NUM_CONTROLLERS];
+	uint64_t nextPollTimes[NUM_CONTROLLERS] = {};
+
+	uint64_t disconnectedPollInterval = TimeSystem::SecondsToPerformanceCount(INPUT_DISCONNECTED_POLL_SECONDS);
+	unsigned int sleepMilliseconds = (unsigned int) MaxInt(1, (int) (1000.f / input->m_controllerPollHz));
+
+	while (input->m_isPollingControllers)
+	{
+		for (int controllerIndex = 0; controllerIndex < NUM_CONTROLLERS; ++controllerIndex)
+		{
+			uint64_t timestamp = GetPerformanceCounter();
+			if (timestamp < nextPollTimes[controllerIndex])
+			{
+				continue;
+			}
+
+			XboxControllerSnapshot_t snapshot;
+			if (!input->m_xboxControllers[controllerIndex].PollSnapshot(snapshot))
+			{
+				continue;
+			}
+
+			input->QueueControllerChanges(controllerIndex, reportedSnapshots[controllerIndex], snapshot, timestamp);
+
+			nextPollTimes[controllerIndex] = (snapshot.isConnected ? 0 : timestamp + disconnectedPollInterval);
+
+			std::lock_guard<std::mutex> lock(input->m_controllerSnapshotLock);
+			input->m_controllerSnapshots[controllerIndex] = snapshot;
+			input->m_hasControllerSnapshots[controllerIndex] = true;
+		}
+
+		Thread::SleepThisThreadFor(sleepMilliseconds);
+	}
+
+	timeEndPeriod(1);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Entry for the raw input thread - registers a message-only window for raw mouse input and pumps
+// its messages until it's closed
+//
+void InputSystem::RawInputThreadEntry(void* args)
+{
+	InputSystem* input = (InputSystem*) args;
+
+	WNDCLASSEX windowClassDescription;
+	memset(&windowClassDescription, 0, sizeof(windowClassDescription));
+	windowClassDescription.cbSize = sizeof(windowClassDescription);
+	windowClassDescription.lpfnWndProc = static_cast<WNDPROC>(RawInputWindowProcedure);
+	windowClassDescription.hInstance = GetModuleHandle(NULL);
+	windowClassDescription.lpszClassName = TEXT("Raw Input Window Class");
+	RegisterClassEx(&windowClassDescription);		// Fails harmlessly if already registered from a previous enable
+
+	HWND rawInputWindow = CreateWindowEx(0, windowClassDescription.lpszClassName, TEXT(""), 0, 0, 0, 0, 0, HWND_MESSAGE, NULL, windowClassDescription.hInstance, NULL);
+
+	RAWINPUTDEVICE mouseDevice;
+	mouseDevice.usUsagePage = 0x01;		// Generic desktop controls
+	mouseDevice.usUsage = 0x02;			// Mouse
+	mouseDevice.dwFlags = RIDEV_INPUTSINK;
+	mouseDevice.hwndTarget = rawInputWindow;
+
+	if (rawInputWindow == NULL || !RegisterRawInputDevices(&mouseDevice, 1, sizeof(mouseDevice)))
+	{
+		if (rawInputWindow != NULL)
+		{
+			DestroyWindow(rawInputWindow);
+		}
+
+		input->m_rawInputThreadState = INPUT_THREAD_STOPPED;
+		return;
+	}
+
+	input->m_rawInputWindow = rawInputWindow;
+	input->m_rawInputThreadState = INPUT_THREAD_RUNNING;
+
+	MSG queuedMessage;
+	while (GetMessage(&queuedMessage, NULL, 0, 0) > 0)
+	{
+		DispatchMessage(&queuedMessage);
+	}
+
+	mouseDevice.dwFlags = RIDEV_REMOVE;
+	mouseDevice.hwndTarget = NULL;
+	RegisterRawInputDevices(&mouseDevice, 1, sizeof(mouseDevice));
+
+	input->m_rawInputWindow = nullptr;
+	input->m_rawInputThreadState = INPUT_THREAD_STOPPED;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues the changes since the controller was last reported, and updates what's been reported
+// Sticks are only reported once they've moved past the threshold, so they're compared against their
+// last report rather than the last poll, or a slow drift would never be reported
+//
+void InputSystem::QueueControllerChanges(int controllerNumber, XboxControllerSnapshot_t& reportedSnapshot, const XboxControllerSnapshot_t& snapshot, uint64_t timestamp)
+{
+	const XboxControllerSnapshot_t lastSnapshot = reportedSnapshot;
+
+	InputEvent_t inputEvent;
+	inputEvent.timestamp = timestamp;
+	inputEvent.controllerNumber = controllerNumber;
+
+	if (snapshot.isConnected != lastSnapshot.isConnected)
+	{
+		inputEvent.type = (snapshot.isConnected ? INPUT_EVENT_CONTROLLER_CONNECTED : INPUT_EVENT_CONTROLLER_DISCONNECTED);
+		PushEvent(inputEvent);
+	}
+
+	if (snapshot.isConnected && lastSnapshot.isConnected && snapshot.packetNumber == lastSnapshot.packetNumber)
+	{
+		return;
+	}
+
+	// A disconnected snapshot is all zero, so disconnecting releases everything
+	unsigned short changedButtons = snapshot.buttonFlags ^ lastSnapshot.buttonFlags;
+	for (int buttonIndex = 0; buttonIndex < NUM_XBOX_BUTTONS; ++buttonIndex)
+	{
+		unsigned short buttonMask = XboxController::GetButtonMask((XboxButtonID) buttonIndex);
+
+		if ((changedButtons & buttonMask) != 0)
+		{
+			inputEvent.type = ((snapshot.buttonFlags & buttonMask) != 0 ? INPUT_EVENT_CONTROLLER_BUTTON_DOWN : INPUT_EVENT_CONTROLLER_BUTTON_UP);
+			inputEvent.code = buttonIndex;
+			PushEvent(inputEvent);
+		}
+	}
+
+	for (int stickIndex = 0; stickIndex < NUM_XBOX_STICKS; ++stickIndex)
+	{
+		int deltaX = AbsoluteValue((int) snapshot.stickAxes[stickIndex][0] - (int) lastSnapshot.stickAxes[stickIndex][0]);
+		int deltaY = AbsoluteValue((int) snapshot.stickAxes[stickIndex][1] - (int) lastSnapshot.stickAxes[stickIndex][1]);
+
+		if (deltaX >= INPUT_STICK_EVENT_THRESHOLD || deltaY >= INPUT_STICK_EVENT_THRESHOLD)
+		{
+			inputEvent.type = INPUT_EVENT_CONTROLLER_STICK;
+			inputEvent.code = stickIndex;
+			inputEvent.value = Vector2(RangeMapFloat((float) snapshot.stickAxes[stickIndex][0], -32768.f, 32767.f, -1.f, 1.f), RangeMapFloat((float) snapshot.stickAxes[stickIndex][1], -32768.f, 32767.f, -1.f, 1.f));
+			PushEvent(inputEvent);
+
+			reportedSnapshot.stickAxes[stickIndex][0] = snapshot.stickAxes[stickIndex][0];
+			reportedSnapshot.stickAxes[stickIndex][1] = snapshot.stickAxes[stickIndex][1];
+		}
+	}
+
+	for (int triggerIndex = 0; triggerIndex < NUM_XBOX_TRIGGERS; ++triggerIndex)
+	{
+		if (snapshot.triggerValues[triggerIndex] != lastSnapshot.triggerValues[triggerIndex])
+		{
+			inputEvent.type = INPUT_EVENT_CONTROLLER_TRIGGER;
+			inputEvent.code = triggerIndex;
+			inputEvent.value = Vector2((float) snapshot.triggerValues[triggerIndex] * (1.f / 255.f), 0.f);
+			PushEvent(inputEvent);
+		}
+	}
+
+	reportedSnapshot.isConnected = snapshot.isConnected;
+	reportedSnapshot.packetNumber = snapshot.packetNumber;
+	reportedSnapshot.buttonFlags = snapshot.buttonFlags;
+	reportedSnapshot.triggerValues[XBOX_TRIGGER_LEFT] = snapshot.triggerValues[XBOX_TRIGGER_LEFT];
+	reportedSnapshot.triggerValues[XBOX_TRIGGER_RIGHT] = snapshot.triggerValues[XBOX_TRIGGER_RIGHT];
+}
+
+
@@ -7,9 +7,27 @@
 /* Description: Class used for keyboard and Xbox Controller input
 /************************************************************************/
 #pragma once
+#include <mutex>
+#include <atomic>
 #include "Engine/Input/Mouse.hpp"
+#include "Engine/Input/InputEvent.hpp"
+#include "Engine/Core/Threading/Threading.hpp"
 #include "Engine/Input/KeyButtonState.hpp"
 #include "Engine/Input/XboxController.hpp"
+#include "Engine/DataStructures/ThreadSafeQueue.hpp"
+
+// Controller polling rate, on its own thread - capped at 1000Hz by the sleep granularity
+#define INPUT_DEFAULT_CONTROLLER_POLL_HZ (1000.f)
+#define INPUT_DISCONNECTED_POLL_SECONDS (1.0)			// XInput stalls reading a missing controller, so those are checked rarely
+#define INPUT_STICK_EVENT_THRESHOLD (256)				// Raw axis change before a stick event is queued, so stick noise doesn't flood the queue
+
+// Lifetime of the raw input thread, so starting it can wait on its window
+enum eInputThreadState
+{
+	INPUT_THREAD_STARTING,
+	INPUT_THREAD_RUNNING,
+	INPUT_THREAD_STOPPED
+};
 
 class InputSystem
 {
@@ -34,6 +52,22 @@ public:
 	// Accessor for controllers
 	XboxController& GetController(int controllerNumber);
 
+	// Raw mouse input, read on its own thread so it doesn't wait on the frame's message pump
+	void EnableRawMouseInput(bool shouldEnable);
+	bool IsRawMouseInputEnabled() const;
+
+	// Polls the controllers on their own thread, queueing changes as they happen; the frame state
+	// is then taken from the latest poll instead of polling in BeginFrame
+	void StartControllerPolling(float pollHz = INPUT_DEFAULT_CONTROLLER_POLL_HZ);
+	void StopControllerPolling();
+	bool IsPollingControllers() const;
+
+	// Every input change in the order it happened, timestamped - off by default, nothing drains it otherwise
+	void EnableEventQueue(bool shouldEnable);
+	bool IsEventQueueEnabled() const;
+	void PushEvent(const InputEvent_t& inputEvent);			// Any thread, dropped while the queue is off
+	bool PopEvent(InputEvent_t& out_event);
+
 	// Accessor for the singleton instance
 	static InputSystem* GetInstance();
 	static Mouse& GetMouse();
@@ -50,6 +84,12 @@ private:
 	void ResetJustKeyStates();	// Resets the 'Just' key states every frame
 	void UpdateControllers();	// Fetches controller input from XInput
 
+	// Threads
+	static void ControllerPollThreadEntry(void* args);
+	static void RawInputThreadEntry(void* args);
+
+	void		QueueControllerChanges(int controllerNumber, XboxControllerSnapshot_t& reportedSnapshot, const XboxControllerSnapshot_t& snapshot, uint64_t timestamp);
+
 
 public:
 	//-----Public Data-----
@@ -85,6 +125,25 @@ private:
 	KeyButtonState m_keyStates[NUM_KEYS];
 	XboxController m_xboxControllers[NUM_CONTROLLERS];
 
+	int								m_reportedDroppedMessageCount = 0;	// From the window's message queue, so each drop is logged once
+
+	// Event queue
+	ThreadSafeQueue<InputEvent_t>	m_events;
+	std::atomic<bool>				m_isEventQueueEnabled{ false };
+
+	// Controller polling
+	ThreadHandle_t					m_controllerPollThread = nullptr;
+	std::atomic<bool>				m_isPollingControllers{ false };
+	float							m_controllerPollHz = INPUT_DEFAULT_CONTROLLER_POLL_HZ;
+	std::mutex						m_controllerSnapshotLock;
+	XboxControllerSnapshot_t		m_controllerSnapshots[NUM_CONTROLLERS];		// Latest poll of each
+	bool							m_hasControllerSnapshots[NUM_CONTROLLERS];	// False until the first successful poll
+
+	// Raw mouse input
+	ThreadHandle_t					m_rawInputThread = nullptr;
+	std::atomic<void*>				m_rawInputWindow{ nullptr };			// Message-only window receiving WM_INPUT, nullptr once it closes
+	std::atomic<eInputThreadState>	m_rawInputThreadState{ INPUT_THREAD_STOPPED };
+
 	static InputSystem* s_instance;	// The singleton InputSystem instance
 
 };
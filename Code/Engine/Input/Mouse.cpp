@@ -23,6 +23,9 @@ void Mouse::BeginFrame()
 	// Reset the mouse wheel
 	m_currFrameWheel = 0.f;
 
+	// Take the raw movement since last frame
+	m_frameRawDelta = IntVector2(m_rawDeltaX.exchange(0), m_rawDeltaY.exchange(0));
+
 	// Reset the 'just' data members before starting
 	m_buttons[MOUSEBUTTON_LEFT].m_wasJustPressed = false;
 	m_buttons[MOUSEBUTTON_LEFT].m_wasJustReleased = false;
@@ -100,6 +103,29 @@ void Mouse::OnMouseWheel(size_t wParam)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Callback for raw mouse movement, called on the raw input thread as the mouse reports it
+//
+void Mouse::OnRawMouseMove(int deltaX, int deltaY)
+{
+	m_rawDeltaX.fetch_add(deltaX, std::memory_order_relaxed);
+	m_rawDeltaY.fetch_add(deltaY, std::memory_order_relaxed);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets whether raw input is running, clearing any movement left over from the last time it was
+//
+void Mouse::SetRawInputEnabled(bool isEnabled)
+{
+	m_isRawInputEnabled = isEnabled;
+
+	m_rawDeltaX = 0;
+	m_rawDeltaY = 0;
+	m_frameRawDelta = IntVector2::ZERO;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Sets the cursor position to the one given
 //
@@ -249,6 +275,25 @@ float Mouse::GetMouseWheelDelta() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the raw mouse movement as of the start of this frame, in the mouse's own counts
+// Zero unless raw input is enabled
+//
+IntVector2 Mouse::GetRawMouseDelta() const
+{
+	return m_frameRawDelta;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the InputSystem is reading raw mouse input
+//
+bool Mouse::IsRawInputEnabled() const
+{
+	return m_isRawInputEnabled;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns whether the cursor is currently visible
 //
@@ -5,6 +5,7 @@
 /* Description: Class to represent a mouse input device
 /************************************************************************/
 #pragma once
+#include <atomic>
 #include "Engine/Math/IntVector2.hpp"
 #include "Engine/Input/KeyButtonState.hpp"
 
@@ -41,6 +42,8 @@ public:
 	// Callbacks
 	void OnMouseButton(size_t wParam);
 	void OnMouseWheel(size_t wParam);
+	void OnRawMouseMove(int deltaX, int deltaY);	// From the raw input thread
+	void SetRawInputEnabled(bool isEnabled);		// Set by the InputSystem when it starts or stops raw input
 
 	// Mutators
 	void SetCursorPosition(const IntVector2& newPosition);
@@ -54,6 +57,8 @@ public:
 	Vector2		GetCursorUIPosition();
 	IntVector2	GetMouseDelta() const;
 	float		GetMouseWheelDelta() const;
+	IntVector2	GetRawMouseDelta() const;		// Raw mouse counts since last frame, without cursor acceleration or clipping
+	bool		IsRawInputEnabled() const;
 
 	bool		IsCursorShown() const;
 	bool		IsCursorLocked() const;
@@ -87,4 +92,10 @@ private:
 	// Buttons
 	KeyButtonState m_buttons[NUM_MOUSEBUTTONS];		// Buttons on the mouse
 
+	// Raw input, accumulated off the main thread and taken each BeginFrame
+	bool				m_isRawInputEnabled = false;
+	std::atomic<int>	m_rawDeltaX{ 0 };
+	std::atomic<int>	m_rawDeltaY{ 0 };
+	IntVector2			m_frameRawDelta = IntVector2::ZERO;
+
 };
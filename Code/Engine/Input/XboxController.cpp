@@ -15,6 +15,25 @@
 #include <Xinput.h>
 #pragma comment( lib, "xinput9_1_0" ) // Link in the xinput.lib static library // #Eiserloh: Xinput 1_4 doesn't work in Windows 7; use 9_1_0 explicitly for broadest compatibility
 
+// XInput flags in XboxButtonID order
+static const unsigned short s_buttonMasks[NUM_XBOX_BUTTONS] =
+{
+	XINPUT_GAMEPAD_A,
+	XINPUT_GAMEPAD_B,
+	XINPUT_GAMEPAD_X,
+	XINPUT_GAMEPAD_Y,
+	XINPUT_GAMEPAD_DPAD_UP,
+	XINPUT_GAMEPAD_DPAD_DOWN,
+	XINPUT_GAMEPAD_DPAD_LEFT,
+	XINPUT_GAMEPAD_DPAD_RIGHT,
+	XINPUT_GAMEPAD_LEFT_THUMB,
+	XINPUT_GAMEPAD_RIGHT_THUMB,
+	XINPUT_GAMEPAD_LEFT_SHOULDER,
+	XINPUT_GAMEPAD_RIGHT_SHOULDER,
+	XINPUT_GAMEPAD_START,
+	XINPUT_GAMEPAD_BACK
+};
+
 
 //-----------------------------------------------------------------------------------------------
 // Only constructor, - the controllerNumber should match the controller's index in the InputSystem Array
@@ -30,45 +49,74 @@ XboxController::XboxController(int controllerNumber /* = 0 */)
 // 
 void XboxController::Update() 
 {
-	// Fetch the XInput information
+	XboxControllerSnapshot_t snapshot;
+
+	if (PollSnapshot(snapshot))
+	{
+		ApplySnapshot(snapshot);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Fetches the XInput information; returns false if the read failed for anything but a disconnect,
+// in which case the controller should be left as it was
+// 
+bool XboxController::PollSnapshot(XboxControllerSnapshot_t& out_snapshot) const
+{
 	XINPUT_STATE xboxControllerState;
 	memset(&xboxControllerState, 0, sizeof(xboxControllerState));
 
 	DWORD errorStatus = XInputGetState(m_controllerNumber, &xboxControllerState);
 
+	out_snapshot = XboxControllerSnapshot_t();
+
 	if (errorStatus == ERROR_SUCCESS)
+	{
+		out_snapshot.isConnected = true;
+		out_snapshot.packetNumber = xboxControllerState.dwPacketNumber;
+		out_snapshot.buttonFlags = xboxControllerState.Gamepad.wButtons;
+
+		out_snapshot.stickAxes[XBOX_STICK_LEFT][0] = xboxControllerState.Gamepad.sThumbLX;
+		out_snapshot.stickAxes[XBOX_STICK_LEFT][1] = xboxControllerState.Gamepad.sThumbLY;
+		out_snapshot.stickAxes[XBOX_STICK_RIGHT][0] = xboxControllerState.Gamepad.sThumbRX;
+		out_snapshot.stickAxes[XBOX_STICK_RIGHT][1] = xboxControllerState.Gamepad.sThumbRY;
+
+		out_snapshot.triggerValues[XBOX_TRIGGER_LEFT] = xboxControllerState.Gamepad.bLeftTrigger;
+		out_snapshot.triggerValues[XBOX_TRIGGER_RIGHT] = xboxControllerState.Gamepad.bRightTrigger;
+
+		return true;
+	}
+
+	return (errorStatus == ERROR_DEVICE_NOT_CONNECTED);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Updates the controller states with the polled values
+// 
+void XboxController::ApplySnapshot(const XboxControllerSnapshot_t& snapshot)
+{
+	if (snapshot.isConnected)
 	{
 		// Is connected, so get its input
 		m_isConnected = true;
 
 		// Update all of the buttons
-		WORD buttonFlags = xboxControllerState.Gamepad.wButtons;
-
-		UpdateButtonState(XBOX_BUTTON_A,					buttonFlags, XINPUT_GAMEPAD_A);
-		UpdateButtonState(XBOX_BUTTON_B,					buttonFlags, XINPUT_GAMEPAD_B);
-		UpdateButtonState(XBOX_BUTTON_X,					buttonFlags, XINPUT_GAMEPAD_X);
-		UpdateButtonState(XBOX_BUTTON_Y,					buttonFlags, XINPUT_GAMEPAD_Y);
-		UpdateButtonState(XBOX_BUTTON_DPAD_UP,				buttonFlags, XINPUT_GAMEPAD_DPAD_UP);
-		UpdateButtonState(XBOX_BUTTON_DPAD_DOWN,			buttonFlags, XINPUT_GAMEPAD_DPAD_DOWN);
-		UpdateButtonState(XBOX_BUTTON_DPAD_LEFT,			buttonFlags, XINPUT_GAMEPAD_DPAD_LEFT);
-		UpdateButtonState(XBOX_BUTTON_DPAD_RIGHT,			buttonFlags, XINPUT_GAMEPAD_DPAD_RIGHT);
-		UpdateButtonState(XBOX_BUTTON_THUMBCLICK_LEFT,		buttonFlags, XINPUT_GAMEPAD_LEFT_THUMB);
-		UpdateButtonState(XBOX_BUTTON_THUMBCLICK_RIGHT,		buttonFlags, XINPUT_GAMEPAD_RIGHT_THUMB);
-		UpdateButtonState(XBOX_BUTTON_LB,					buttonFlags, XINPUT_GAMEPAD_LEFT_SHOULDER);
-		UpdateButtonState(XBOX_BUTTON_RB,					buttonFlags, XINPUT_GAMEPAD_RIGHT_SHOULDER);
-		UpdateButtonState(XBOX_BUTTON_START,				buttonFlags, XINPUT_GAMEPAD_START);
-		UpdateButtonState(XBOX_BUTTON_BACK,					buttonFlags, XINPUT_GAMEPAD_BACK);
+		for (int buttonIndex = 0; buttonIndex < NUM_XBOX_BUTTONS; ++buttonIndex)
+		{
+			UpdateButtonState((XboxButtonID) buttonIndex, snapshot.buttonFlags, s_buttonMasks[buttonIndex]);
+		}
 
 		// Update the sticks
-		UpdateStickState(XBOX_STICK_LEFT,	xboxControllerState.Gamepad.sThumbLX, xboxControllerState.Gamepad.sThumbLY);
-		UpdateStickState(XBOX_STICK_RIGHT,	xboxControllerState.Gamepad.sThumbRX, xboxControllerState.Gamepad.sThumbRY);
-
+		UpdateStickState(XBOX_STICK_LEFT,	snapshot.stickAxes[XBOX_STICK_LEFT][0], snapshot.stickAxes[XBOX_STICK_LEFT][1]);
+		UpdateStickState(XBOX_STICK_RIGHT,	snapshot.stickAxes[XBOX_STICK_RIGHT][0], snapshot.stickAxes[XBOX_STICK_RIGHT][1]);
 
 		// Update the triggers
-		UpdateTriggerState(XBOX_TRIGGER_LEFT,	 xboxControllerState.Gamepad.bLeftTrigger);
-		UpdateTriggerState(XBOX_TRIGGER_RIGHT,	 xboxControllerState.Gamepad.bRightTrigger);
+		UpdateTriggerState(XBOX_TRIGGER_LEFT,	 snapshot.triggerValues[XBOX_TRIGGER_LEFT]);
+		UpdateTriggerState(XBOX_TRIGGER_RIGHT,	 snapshot.triggerValues[XBOX_TRIGGER_RIGHT]);
 	}
-	else if (errorStatus == ERROR_DEVICE_NOT_CONNECTED)
+	else
 	{
 		m_isConnected = false;
 		ResetButtonStates();
@@ -78,6 +126,15 @@ void XboxController::Update()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the XInput flag for the button
+// 
+unsigned short XboxController::GetButtonMask(XboxButtonID buttonID)
+{
+	return s_buttonMasks[buttonID];
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Updates the button given by buttonID with the XInput information this frame
 // 
@@ -82,6 +82,17 @@ enum XboxTriggerID
 };
 
 
+// The controller as XInput last reported it, so it can be polled on one thread and applied on another
+struct XboxControllerSnapshot_t
+{
+	bool			isConnected = false;
+	unsigned int	packetNumber = 0;						// Changes whenever XInput sees the state change
+	unsigned short	buttonFlags = 0;
+	short			stickAxes[NUM_XBOX_STICKS][2] = {};		// Raw (x, y)
+	unsigned char	triggerValues[NUM_XBOX_TRIGGERS] = {};
+};
+
+
 class XboxController
 {
 
@@ -93,6 +104,11 @@ public: // Methods
 
 	void Update();														// Fetches the controller input from XInput
 
+	bool PollSnapshot(XboxControllerSnapshot_t& out_snapshot) const;	// Reads XInput without changing the controller, any thread; false on a failed read
+	void ApplySnapshot(const XboxControllerSnapshot_t& snapshot);		// Updates the frame state from a poll
+
+	static unsigned short GetButtonMask(XboxButtonID buttonID);			// XInput button flag for the button
+
 	bool IsButtonPressed(XboxButtonID buttonID) const;					// Returns whether the button is currently pressed
 	bool WasButtonJustPressed(XboxButtonID buttonID) const;				// Returns whether the button was just pressed this frame
 	bool WasButtonJustReleased(XboxButtonID buttonID) const;			// Returns whether the button was just released this frame
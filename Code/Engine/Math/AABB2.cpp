@@ -11,40 +11,10 @@
 #include "Engine/Math/MathUtils.hpp"
 
 
-// Constant square values
-const AABB2 AABB2::UNIT_SQUARE_CENTERED = AABB2(Vector2(-1.f, -1.f), Vector2(1.f, 1.f));
-const AABB2 AABB2::HALF_UNIT_SQUARE_CENTERED = AABB2(Vector2(-0.5f, -0.5f), Vector2(0.5f, 0.5f));
-const AABB2 AABB2::UNIT_SQUARE_OFFCENTER = AABB2(Vector2(0.f, 0.f), Vector2(1.f, 1.f));
-
-
-//-----------------------------------------------------------------------------------------------
-// Constructs a Box2D using explicit float boundaries
-//
-AABB2::AABB2(float minX, float minY, float maxX, float maxY)
-	: mins(Vector2(minX, minY))
-	, maxs(Vector2(maxX, maxY))
-{
-}
-
-
-//-----------------------------------------------------------------------------------------------
-// Constructs a Box2D using two Vector2D objects to represent the bounds
-//
-AABB2::AABB2(const Vector2& referenceMins, const Vector2& referenceMaxs)
-	: mins(referenceMins)
-	, maxs(referenceMaxs)
-{
-}
-
-
-//-----------------------------------------------------------------------------------------------
-// Constructs a Box2D using a center point and XY-offsets for boundaries
-//
-AABB2::AABB2(const Vector2& center, float radiusX, float radiusY)
-	: mins(Vector2((center.x - radiusX), (center.y - radiusY)))
-	, maxs(Vector2((center.x + radiusX), (center.y + radiusY)))
-{
-}
+// Constant square values - constexpr, so they're baked into the image instead of set up at startup
+constexpr AABB2 AABB2::UNIT_SQUARE_CENTERED = AABB2(Vector2(-1.f, -1.f), Vector2(1.f, 1.f));
+constexpr AABB2 AABB2::HALF_UNIT_SQUARE_CENTERED = AABB2(Vector2(-0.5f, -0.5f), Vector2(0.5f, 0.5f));
+constexpr AABB2 AABB2::UNIT_SQUARE_OFFCENTER = AABB2(Vector2(0.f, 0.f), Vector2(1.f, 1.f));
 
 
 //-----------------------------------------------------------------------------------------------
@@ -286,78 +256,6 @@ Vector2 AABB2::GetTopLeft() const
 }
 
 
-//-----------------------------------------------------------------------------------------------
-// Moves the box boundaries in the direction given by translation, works the same as Translate
-//
-void AABB2::operator+=(const Vector2& translation)
-{
-	mins.x += translation.x;
-	mins.y += translation.y;
-	maxs.x += translation.x;
-	maxs.y += translation.y;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-// Moves the box boundaries in the direction opposite of antiTranslation
-//
-void AABB2::operator-=(const Vector2& antiTranslation)
-{
-	mins.x -= antiTranslation.x;
-	mins.y -= antiTranslation.y;
-	maxs.x -= antiTranslation.x;
-	maxs.y -= antiTranslation.y;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-// Returns a copy of this box with all corners scaled by the given scalar
-//
-AABB2 AABB2::operator*(float scalar) const
-{
-	AABB2 scaledBox;
-
-	scaledBox.mins = mins * scalar;
-	scaledBox.maxs = maxs * scalar;
-
-	return scaledBox;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-// Returns a copy of this box after being translated in the direction of translation
-//
-AABB2 AABB2::operator+(const Vector2& translation) const
-{
-	AABB2 translatedBox;
-	
-	translatedBox.mins.x = (this->mins.x + translation.x);
-	translatedBox.mins.y = (this->mins.y + translation.y);
-
-	translatedBox.maxs.x = (this->maxs.x + translation.x);
-	translatedBox.maxs.y = (this->maxs.y + translation.y);
-
-	return translatedBox;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-// Returns a copy of this box after being translated in the opposite direction of antiTranslation
-//
-AABB2 AABB2::operator-(const Vector2& antiTranslation) const
-{
-	AABB2 antiTranslatedBox;
-
-	antiTranslatedBox.mins.x = (this->mins.x - antiTranslation.x);
-	antiTranslatedBox.mins.y = (this->mins.y - antiTranslation.y);
-
-	antiTranslatedBox.maxs.x = (this->maxs.x - antiTranslation.x);
-	antiTranslatedBox.maxs.y = (this->maxs.y - antiTranslation.y);
-
-	return antiTranslatedBox;
-}
-
-
 //-----------------------------------------------------------------------------------------------
 // Checks if the given Box2Ds a and b overlap (either their boundaries intersect, or one is contained
 // in another
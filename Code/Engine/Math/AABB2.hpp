@@ -19,11 +19,11 @@ public:
 	Vector2 maxs;															// Maximum x and y values of the box
 
 	//-----Constructors-----
-	~AABB2() {}
+	~AABB2() = default;
 	AABB2() {}
-	explicit AABB2(float minX, float minY, float maxX, float maxY);			// Construct using four float values for the bounds
-	explicit AABB2(const Vector2& mins, const Vector2& maxs);				// Construct using two Vector2D's to represent the bounds
-	explicit AABB2(const Vector2& center, float radiusX, float radiusY);	// Construct using a center and XY offsets (radii)
+	constexpr explicit AABB2(float minX, float minY, float maxX, float maxY);	// Construct using four float values for the bounds
+	constexpr explicit AABB2(const Vector2& mins, const Vector2& maxs);		// Construct using two Vector2D's to represent the bounds
+	constexpr explicit AABB2(const Vector2& center, float radiusX, float radiusY);	// Construct using a center and XY offsets (radii)
 
 
 	//-----Mutators-----
@@ -48,11 +48,11 @@ public:
 	Vector2 GetTopLeft() const;
 
 	//-----Operators-----
-	void operator+=(const Vector2& translation);							// Works like Translate, linear move
-	void operator-=(const Vector2& antiTranslation);						// Inverse of Translate, moves the box opposite of antiTranslation
-	AABB2 operator+(const Vector2& translation) const;						// Returns a copy of this box with an offset added to it
-	AABB2 operator-(const Vector2& antiTranslation) const;					// Returns a copy of this box with an offset subtracted to it
-	AABB2 operator*(float scalar) const;									// Returns a copy of this box with all corners scaled by the given scalar
+	constexpr void operator+=(const Vector2& translation);					// Works like Translate, linear move
+	constexpr void operator-=(const Vector2& antiTranslation);				// Inverse of Translate, moves the box opposite of antiTranslation
+	constexpr AABB2 operator+(const Vector2& translation) const;			// Returns a copy of this box with an offset added to it
+	constexpr AABB2 operator-(const Vector2& antiTranslation) const;		// Returns a copy of this box with an offset subtracted to it
+	constexpr AABB2 operator*(float scalar) const;							// Returns a copy of this box with all corners scaled by the given scalar
 
 	static const AABB2 UNIT_SQUARE_CENTERED;								// Square centered at (0,0) with width 2
 	static const AABB2 HALF_UNIT_SQUARE_CENTERED;							// Square centered at (0,0) with width 1
@@ -60,6 +60,92 @@ public:
 };
 
 
+///////////////////////////////////////////////////////////////////////////////
+// Constexpr definitions - in the header so constants and tables built from
+// them are worked out at compile time
+///////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------------------------
+// Constructs a Box2D using explicit float boundaries
+//
+constexpr AABB2::AABB2(float minX, float minY, float maxX, float maxY)
+	: mins(Vector2(minX, minY))
+	, maxs(Vector2(maxX, maxY))
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructs a Box2D using two Vector2D objects to represent the bounds
+//
+constexpr AABB2::AABB2(const Vector2& referenceMins, const Vector2& referenceMaxs)
+	: mins(referenceMins)
+	, maxs(referenceMaxs)
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructs a Box2D using a center point and XY-offsets for boundaries
+//
+constexpr AABB2::AABB2(const Vector2& center, float radiusX, float radiusY)
+	: mins(Vector2((center.x - radiusX), (center.y - radiusY)))
+	, maxs(Vector2((center.x + radiusX), (center.y + radiusY)))
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Moves the box boundaries in the direction given by translation, works the same as Translate
+//
+constexpr void AABB2::operator+=(const Vector2& translation)
+{
+	mins.x += translation.x;
+	mins.y += translation.y;
+	maxs.x += translation.x;
+	maxs.y += translation.y;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Moves the box boundaries in the direction opposite of antiTranslation
+//
+constexpr void AABB2::operator-=(const Vector2& antiTranslation)
+{
+	mins.x -= antiTranslation.x;
+	mins.y -= antiTranslation.y;
+	maxs.x -= antiTranslation.x;
+	maxs.y -= antiTranslation.y;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a copy of this box with all corners scaled by the given scalar
+//
+constexpr AABB2 AABB2::operator*(float scalar) const
+{
+	return AABB2(mins * scalar, maxs * scalar);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a copy of this box after being translated in the direction of translation
+//
+constexpr AABB2 AABB2::operator+(const Vector2& translation) const
+{
+	return AABB2(mins + translation, maxs + translation);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a copy of this box after being translated in the opposite direction of antiTranslation
+//
+constexpr AABB2 AABB2::operator-(const Vector2& antiTranslation) const
+{
+	return AABB2(mins - antiTranslation, maxs - antiTranslation);
+}
+
+
 bool DoAABB2sOverlap(const AABB2& boxOne, const AABB2& boxTwo);								// Checks for overlap, including boundaries
 
 const AABB2 Interpolate(const AABB2& start, const AABB2& end, float fractionTowardEnd);		// Interpolates the mins/maxes of the boxes
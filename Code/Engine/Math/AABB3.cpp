@@ -4,7 +4,10 @@
 /* Date: March 26th, 2018
 /* Description: Implementation of the AABB3 class
 /************************************************************************/
+#include <limits>
 #include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Matrix44.hpp"
+#include "Engine/Math/MathUtils.hpp"
 
 
 // Static constants
@@ -134,6 +137,58 @@ AABB3 AABB3::GetTranslated(const Vector3& translation) const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the axis-aligned box that encloses this box after it's transformed by the matrix
+// Transforms the center, and sums the absolute value of each basis scaled by the half extents
+//
+AABB3 AABB3::GetTransformed(const Matrix44& transform) const
+{
+	Vector3 center = GetCenter();
+	Vector3 halfExtents = GetDimensions() * 0.5f;
+
+	Vector4 transformedCenter = transform.TransformPoint(center);
+
+	Vector3 transformedExtents;
+	transformedExtents.x = AbsoluteValue(transform.Ix) * halfExtents.x + AbsoluteValue(transform.Jx) * halfExtents.y + AbsoluteValue(transform.Kx) * halfExtents.z;
+	transformedExtents.y = AbsoluteValue(transform.Iy) * halfExtents.x + AbsoluteValue(transform.Jy) * halfExtents.y + AbsoluteValue(transform.Ky) * halfExtents.z;
+	transformedExtents.z = AbsoluteValue(transform.Iz) * halfExtents.x + AbsoluteValue(transform.Jz) * halfExtents.y + AbsoluteValue(transform.Kz) * halfExtents.z;
+
+	return AABB3(transformedCenter.xyz(), transformedExtents.x, transformedExtents.y, transformedExtents.z);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the smallest box that contains both this box and other
+//
+AABB3 AABB3::GetUnion(const AABB3& other) const
+{
+	Vector3 unionMins = Vector3(MinFloat(mins.x, other.mins.x), MinFloat(mins.y, other.mins.y), MinFloat(mins.z, other.mins.z));
+	Vector3 unionMaxs = Vector3(MaxFloat(maxs.x, other.maxs.x), MaxFloat(maxs.y, other.maxs.y), MaxFloat(maxs.z, other.maxs.z));
+
+	return AABB3(unionMins, unionMaxs);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns this box grown by margin in every direction
+//
+AABB3 AABB3::GetExpanded(float margin) const
+{
+	Vector3 marginVector = Vector3(margin, margin, margin);
+	return AABB3(mins - marginVector, maxs + marginVector);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the total area of the box's six faces
+//
+float AABB3::GetSurfaceArea() const
+{
+	Vector3 dimensions = GetDimensions();
+	return 2.f * (dimensions.x * dimensions.y + dimensions.y * dimensions.z + dimensions.z * dimensions.x);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns whether the box bounds contains the given point
 //
@@ -152,6 +207,16 @@ bool AABB3::ContainsPoint(const Vector3& point) const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns whether the given box is entirely inside this one, boundaries included
+//
+bool AABB3::ContainsBox(const AABB3& box) const
+{
+	return (box.mins.x >= mins.x && box.mins.y >= mins.y && box.mins.z >= mins.z
+		&& box.maxs.x <= maxs.x && box.maxs.y <= maxs.y && box.maxs.z <= maxs.z);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Checks if the given AABB3s a and b overlap (either their boundaries intersect, or one is contained
 // in another
@@ -191,3 +256,59 @@ bool DoAABB3sOverlap(const AABB3& a, const AABB3& b)
 
 	return doOverlap;
 }
+
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the ray hits the box within maxDistance, clipping it against each pair of planes
+// The distance is along the direction, so it's only in world units for unit length directions
+//
+bool RaycastAABB3(const Vector3& start, const Vector3& inverseDirection, float maxDistance, const AABB3& box, float& out_distance)
+{
+	float minT = 0.f;
+	float maxT = maxDistance;
+
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		float startValue = (&start.x)[axis];
+		float inverse = (&inverseDirection.x)[axis];
+
+		float nearT = ((&box.mins.x)[axis] - startValue) * inverse;
+		float farT = ((&box.maxs.x)[axis] - startValue) * inverse;
+
+		if (nearT > farT)
+		{
+			float temp = nearT;
+			nearT = farT;
+			farT = temp;
+		}
+
+		// The comparisons are written so NaNs (a parallel ray starting on a plane) don't clip
+		minT = (nearT > minT ? nearT : minT);
+		maxT = (farT < maxT ? farT : maxT);
+
+		if (minT > maxT)
+		{
+			return false;
+		}
+	}
+
+	out_distance = minT;
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the reciprocal of each component, for RaycastAABB3()
+//
+Vector3 GetRayInverseDirection(const Vector3& direction)
+{
+	const float infinity = std::numeric_limits<float>::infinity();
+
+	Vector3 inverseDirection;
+	inverseDirection.x = (direction.x != 0.f ? 1.f / direction.x : infinity);
+	inverseDirection.y = (direction.y != 0.f ? 1.f / direction.y : infinity);
+	inverseDirection.z = (direction.z != 0.f ? 1.f / direction.z : infinity);
+
+	return inverseDirection;
+}
@@ -7,6 +7,8 @@
 #pragma once
 #include "Engine/Math/Vector3.hpp"
 
+class Matrix44;
+
 
 class AABB3
 {
@@ -35,7 +37,12 @@ public:
 	Vector3 GetBackTopLeft() const;
 
 	AABB3	GetTranslated(const Vector3& translation) const;
+	AABB3	GetTransformed(const Matrix44& transform) const;		// Box that encloses this box after transforming it
+	AABB3	GetUnion(const AABB3& other) const;						// Smallest box enclosing both
+	AABB3	GetExpanded(float margin) const;						// Grown by margin on every side
+	float	GetSurfaceArea() const;
 	bool	ContainsPoint(const Vector3& point) const;
+	bool	ContainsBox(const AABB3& box) const;
 
 	//-----Static Constants-----
 	static const AABB3 UNIT_CUBE;
@@ -44,3 +51,8 @@ public:
 
 bool DoAABB3sOverlap(const AABB3& boxOne, const AABB3& boxTwo);								// Checks for overlap, including boundaries
 
+// Slab test; out_distance is where the ray enters the box, or 0 if it starts inside
+// inverseDirection is from GetRayInverseDirection(), so batches of boxes can share it
+bool	RaycastAABB3(const Vector3& start, const Vector3& inverseDirection, float maxDistance, const AABB3& box, float& out_distance);
+Vector3 GetRayInverseDirection(const Vector3& direction);	// 1 / direction per component, infinite for components of 0
+
@@ -0,0 +1,598 @@
+/************************************************************************/
+/* File: AABBTree.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the AABBTree class
+/************************************************************************/
+#include <algorithm>
+#include "Engine/Math/Frustum.hpp"
+#include "Engine/Math/AABBTree.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+// Nodes still to visit; per thread so queries can run on workers, and kept so they don't allocate
+static thread_local std::vector<int> s_traversalStack;
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+AABBTree::AABBTree(float fatMargin /*= AABB_TREE_DEFAULT_FAT_MARGIN*/)
+	: m_fatMargin(fatMargin)
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a leaf for the bounds and returns its ID
+//
+int AABBTree::AddLeaf(const AABB3& bounds, void* userData)
+{
+	int leafIndex = AllocateNode();
+
+	AABBTreeNode_t& leaf = m_nodes[leafIndex];
+	leaf.bounds = bounds.GetExpanded(m_fatMargin);
+	leaf.leafBounds = bounds;
+	leaf.userData = userData;
+	leaf.height = 0;
+
+	InsertLeaf(leafIndex);
+	m_leafCount++;
+
+	return leafIndex;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes the leaf, freeing its ID
+//
+void AABBTree::RemoveLeaf(int leafID)
+{
+	ASSERT_OR_DIE(leafID >= 0 && leafID < (int) m_nodes.size() && m_nodes[leafID].height == 0, Stringf("Error: AABBTree::RemoveLeaf received invalid leaf %i", leafID));
+
+	RemoveLeafFromHierarchy(leafID);
+	FreeNode(leafID);
+	m_leafCount--;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes every leaf
+//
+void AABBTree::Clear()
+{
+	m_nodes.clear();
+	m_rootIndex = AABB_TREE_NULL_NODE;
+	m_freeListHead = AABB_TREE_NULL_NODE;
+	m_leafCount = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the leaf's bounds, only moving it in the tree once they leave its fattened bounds
+// The new fattened bounds lead along the displacement, so a steadily moving leaf stays put longer
+//
+bool AABBTree::UpdateLeaf(int leafID, const AABB3& bounds, const Vector3& displacement /*= Vector3::ZERO*/)
+{
+	ASSERT_OR_DIE(leafID >= 0 && leafID < (int) m_nodes.size() && m_nodes[leafID].height == 0, Stringf("Error: AABBTree::UpdateLeaf received invalid leaf %i", leafID));
+
+	m_nodes[leafID].leafBounds = bounds;
+
+	if (m_nodes[leafID].bounds.ContainsBox(bounds))
+	{
+		return false;
+	}
+
+	RemoveLeafFromHierarchy(leafID);
+
+	AABB3 fatBounds = bounds.GetExpanded(m_fatMargin);
+	Vector3 lead = displacement * AABB_TREE_DISPLACEMENT_MULTIPLIER;
+
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		float axisLead = (&lead.x)[axis];
+
+		if (axisLead < 0.f)
+		{
+			(&fatBounds.mins.x)[axis] += axisLead;
+		}
+		else
+		{
+			(&fatBounds.maxs.x)[axis] += axisLead;
+		}
+	}
+
+	m_nodes[leafID].bounds = fatBounds;
+	InsertLeaf(leafID);
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the user data the leaf was added with
+//
+void* AABBTree::GetUserData(int leafID) const
+{
+	return m_nodes[leafID].userData;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the leaf's bounds as last set, not fattened
+//
+AABB3 AABBTree::GetLeafBounds(int leafID) const
+{
+	return m_nodes[leafID].leafBounds;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of leaves in the tree
+//
+int AABBTree::GetLeafCount() const
+{
+	return m_leafCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of levels below the root, 0 for an empty tree or a single leaf
+//
+int AABBTree::GetHeight() const
+{
+	return (m_rootIndex == AABB_TREE_NULL_NODE ? 0 : m_nodes[m_rootIndex].height);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds the leaves overlapping the box
+//
+void AABBTree::QueryAABB(const AABB3& box, std::vector<int>& out_leafIDs) const
+{
+	QueryLeaves([&box](const AABB3& bounds) { return DoAABB3sOverlap(bounds, box); }, out_leafIDs);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds the leaves overlapping the sphere
+//
+void AABBTree::QuerySphere(const Vector3& center, float radius, std::vector<int>& out_leafIDs) const
+{
+	QueryLeaves([&center, radius](const AABB3& bounds) { return DoesBoxSphereOverlap(bounds, center, radius); }, out_leafIDs);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds the leaves overlapping the frustum, conservatively (see Frustum::DoesAABB3Overlap())
+//
+void AABBTree::QueryFrustum(const Frustum& frustum, std::vector<int>& out_leafIDs) const
+{
+	QueryLeaves([&frustum](const AABB3& bounds) { return frustum.DoesAABB3Overlap(bounds); }, out_leafIDs);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds the nearest leaf the ray enters, skipping any subtree that starts past the best hit so far
+//
+bool AABBTree::Raycast(const Vector3& start, const Vector3& direction, float maxDistance, AABBTreeRaycastHit_t& out_hit) const
+{
+	out_hit = AABBTreeRaycastHit_t();
+
+	if (m_rootIndex == AABB_TREE_NULL_NODE)
+	{
+		return false;
+	}
+
+	Vector3 inverseDirection = GetRayInverseDirection(direction);
+	float closestDistance = maxDistance;
+
+	std::vector<int>& stack = s_traversalStack;
+	stack.clear();
+	stack.push_back(m_rootIndex);
+
+	while (stack.size() > 0)
+	{
+		int nodeIndex = stack.back();
+		const AABBTreeNode_t& node = m_nodes[nodeIndex];
+		stack.pop_back();
+
+		float distance;
+		if (!RaycastAABB3(start, inverseDirection, closestDistance, node.bounds, distance))
+		{
+			continue;
+		}
+
+		if (node.IsLeaf())
+		{
+			if (RaycastAABB3(start, inverseDirection, closestDistance, node.leafBounds, distance))
+			{
+				closestDistance = distance;
+				out_hit.leafID = nodeIndex;
+				out_hit.distance = distance;
+			}
+		}
+		else
+		{
+			stack.push_back(node.children[0]);
+			stack.push_back(node.children[1]);
+		}
+	}
+
+	return (out_hit.leafID != AABB_TREE_NULL_NODE);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds every leaf the ray enters within maxDistance, nearest first
+//
+void AABBTree::RaycastAll(const Vector3& start, const Vector3& direction, float maxDistance, std::vector<AABBTreeRaycastHit_t>& out_hits) const
+{
+	if (m_rootIndex == AABB_TREE_NULL_NODE)
+	{
+		return;
+	}
+
+	Vector3 inverseDirection = GetRayInverseDirection(direction);
+	size_t firstHitIndex = out_hits.size();
+
+	std::vector<int>& stack = s_traversalStack;
+	stack.clear();
+	stack.push_back(m_rootIndex);
+
+	while (stack.size() > 0)
+	{
+		int nodeIndex = stack.back();
+		const AABBTreeNode_t& node = m_nodes[nodeIndex];
+		stack.pop_back();
+
+		float distance;
+		if (!RaycastAABB3(start, inverseDirection, maxDistance, node.bounds, distance))
+		{
+			continue;
+		}
+
+		if (node.IsLeaf())
+		{
+			if (RaycastAABB3(start, inverseDirection, maxDistance, node.leafBounds, distance))
+			{
+				AABBTreeRaycastHit_t hit;
+				hit.leafID = nodeIndex;
+				hit.distance = distance;
+
+				out_hits.push_back(hit);
+			}
+		}
+		else
+		{
+			stack.push_back(node.children[0]);
+			stack.push_back(node.children[1]);
+		}
+	}
+
+	std::sort(out_hits.begin() + firstHitIndex, out_hits.end(), [](const AABBTreeRaycastHit_t& a, const AABBTreeRaycastHit_t& b) { return a.distance < b.distance; });
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Runs QueryAABB() for each box, with each box's results starting at out_offsets[boxIndex]
+//
+void AABBTree::QueryAABBs(const AABB3* boxes, int boxCount, std::vector<int>& out_leafIDs, std::vector<int>& out_offsets) const
+{
+	out_offsets.resize(boxCount + 1);
+
+	for (int boxIndex = 0; boxIndex < boxCount; ++boxIndex)
+	{
+		out_offsets[boxIndex] = (int) out_leafIDs.size();
+		QueryAABB(boxes[boxIndex], out_leafIDs);
+	}
+
+	out_offsets[boxCount] = (int) out_leafIDs.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Runs QuerySphere() for each sphere, with each sphere's results starting at out_offsets[sphereIndex]
+//
+void AABBTree::QuerySpheres(const Vector3* centers, const float* radii, int sphereCount, std::vector<int>& out_leafIDs, std::vector<int>& out_offsets) const
+{
+	out_offsets.resize(sphereCount + 1);
+
+	for (int sphereIndex = 0; sphereIndex < sphereCount; ++sphereIndex)
+	{
+		out_offsets[sphereIndex] = (int) out_leafIDs.size();
+		QuerySphere(centers[sphereIndex], radii[sphereIndex], out_leafIDs);
+	}
+
+	out_offsets[sphereCount] = (int) out_leafIDs.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Runs Raycast() for each ray, misses have a leafID of AABB_TREE_NULL_NODE
+//
+void AABBTree::RaycastBatch(const Vector3* starts, const Vector3* directions, int rayCount, float maxDistance, AABBTreeRaycastHit_t* out_hits) const
+{
+	for (int rayIndex = 0; rayIndex < rayCount; ++rayIndex)
+	{
+		Raycast(starts[rayIndex], directions[rayIndex], maxDistance, out_hits[rayIndex]);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a node off the free list, or a new one if the list is empty
+// Can grow m_nodes, so references to nodes don't survive calling this
+//
+int AABBTree::AllocateNode()
+{
+	int nodeIndex = m_freeListHead;
+
+	if (nodeIndex == AABB_TREE_NULL_NODE)
+	{
+		nodeIndex = (int) m_nodes.size();
+		m_nodes.push_back(AABBTreeNode_t());
+	}
+	else
+	{
+		m_freeListHead = m_nodes[nodeIndex].parent;
+		m_nodes[nodeIndex] = AABBTreeNode_t();
+	}
+
+	return nodeIndex;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Puts the node back on the free list
+//
+void AABBTree::FreeNode(int nodeIndex)
+{
+	AABBTreeNode_t& node = m_nodes[nodeIndex];
+
+	node.parent = m_freeListHead;
+	node.height = -1;
+	node.userData = nullptr;
+
+	m_freeListHead = nodeIndex;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Pairs the leaf with the sibling that grows the tree's total surface area the least, walking down
+// from the root and stopping early once pairing here is cheaper than descending (Catto's heuristic)
+//
+void AABBTree::InsertLeaf(int leafIndex)
+{
+	if (m_rootIndex == AABB_TREE_NULL_NODE)
+	{
+		m_rootIndex = leafIndex;
+		m_nodes[leafIndex].parent = AABB_TREE_NULL_NODE;
+		return;
+	}
+
+	AABB3 leafBounds = m_nodes[leafIndex].bounds;
+	int siblingIndex = m_rootIndex;
+
+	while (!m_nodes[siblingIndex].IsLeaf())
+	{
+		const AABBTreeNode_t& node = m_nodes[siblingIndex];
+
+		float area = node.bounds.GetSurfaceArea();
+		float combinedArea = node.bounds.GetUnion(leafBounds).GetSurfaceArea();
+
+		// Cost of a new parent here, and of the growth every node below would inherit
+		float cost = 2.f * combinedArea;
+		float inheritanceCost = 2.f * (combinedArea - area);
+
+		float childCosts[2];
+		for (int childSlot = 0; childSlot < 2; ++childSlot)
+		{
+			const AABBTreeNode_t& child = m_nodes[node.children[childSlot]];
+			float unionArea = child.bounds.GetUnion(leafBounds).GetSurfaceArea();
+
+			childCosts[childSlot] = (child.IsLeaf() ? unionArea : unionArea - child.bounds.GetSurfaceArea()) + inheritanceCost;
+		}
+
+		if (cost < childCosts[0] && cost < childCosts[1])
+		{
+			break;
+		}
+
+		siblingIndex = (childCosts[0] < childCosts[1] ? node.children[0] : node.children[1]);
+	}
+
+	int oldParentIndex = m_nodes[siblingIndex].parent;
+	int newParentIndex = AllocateNode();
+
+	AABBTreeNode_t& newParent = m_nodes[newParentIndex];
+	newParent.parent = oldParentIndex;
+	newParent.bounds = m_nodes[siblingIndex].bounds.GetUnion(leafBounds);
+	newParent.height = m_nodes[siblingIndex].height + 1;
+	newParent.children[0] = siblingIndex;
+	newParent.children[1] = leafIndex;
+
+	if (oldParentIndex != AABB_TREE_NULL_NODE)
+	{
+		AABBTreeNode_t& oldParent = m_nodes[oldParentIndex];
+		oldParent.children[oldParent.children[0] == siblingIndex ? 0 : 1] = newParentIndex;
+	}
+	else
+	{
+		m_rootIndex = newParentIndex;
+	}
+
+	m_nodes[siblingIndex].parent = newParentIndex;
+	m_nodes[leafIndex].parent = newParentIndex;
+
+	RefitAncestors(newParentIndex);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Detaches the leaf, replacing its parent with its sibling
+//
+void AABBTree::RemoveLeafFromHierarchy(int leafIndex)
+{
+	if (leafIndex == m_rootIndex)
+	{
+		m_rootIndex = AABB_TREE_NULL_NODE;
+		return;
+	}
+
+	int parentIndex = m_nodes[leafIndex].parent;
+	const AABBTreeNode_t& parent = m_nodes[parentIndex];
+
+	int grandParentIndex = parent.parent;
+	int siblingIndex = (parent.children[0] == leafIndex ? parent.children[1] : parent.children[0]);
+
+	m_nodes[siblingIndex].parent = grandParentIndex;
+	FreeNode(parentIndex);
+
+	if (grandParentIndex != AABB_TREE_NULL_NODE)
+	{
+		AABBTreeNode_t& grandParent = m_nodes[grandParentIndex];
+		grandParent.children[grandParent.children[0] == parentIndex ? 0 : 1] = siblingIndex;
+
+		RefitAncestors(grandParentIndex);
+	}
+	else
+	{
+		m_rootIndex = siblingIndex;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Walks up from the node, rebalancing and recomputing the bounds and height of each ancestor
+//
+void AABBTree::RefitAncestors(int nodeIndex)
+{
+	while (nodeIndex != AABB_TREE_NULL_NODE)
+	{
+		nodeIndex = Balance(nodeIndex);
+
+		AABBTreeNode_t& node = m_nodes[nodeIndex];
+		const AABBTreeNode_t& firstChild = m_nodes[node.children[0]];
+		const AABBTreeNode_t& secondChild = m_nodes[node.children[1]];
+
+		node.height = 1 + (firstChild.height > secondChild.height ? firstChild.height : secondChild.height);
+		node.bounds = firstChild.bounds.GetUnion(secondChild.bounds);
+
+		nodeIndex = node.parent;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// If one child of the node is more than one level taller than the other, rotates the taller child
+// up into the node's place, returning the index of the node now at this position
+//
+int AABBTree::Balance(int nodeIndex)
+{
+	AABBTreeNode_t& a = m_nodes[nodeIndex];
+
+	if (a.IsLeaf() || a.height < 2)
+	{
+		return nodeIndex;
+	}
+
+	int bIndex = a.children[0];
+	int cIndex = a.children[1];
+	int balance = m_nodes[cIndex].height - m_nodes[bIndex].height;
+
+	if (balance > -2 && balance < 2)
+	{
+		return nodeIndex;
+	}
+
+	// Rotate the taller child (up) into the node's place, the node becomes its child
+	int upSlot = (balance > 0 ? 1 : 0);
+	int upIndex = a.children[upSlot];
+	int otherIndex = a.children[1 - upSlot];
+
+	AABBTreeNode_t& up = m_nodes[upIndex];
+	int fIndex = up.children[0];
+	int gIndex = up.children[1];
+
+	up.children[0] = nodeIndex;
+	up.parent = a.parent;
+	a.parent = upIndex;
+
+	if (up.parent != AABB_TREE_NULL_NODE)
+	{
+		AABBTreeNode_t& upParent = m_nodes[up.parent];
+		upParent.children[upParent.children[0] == nodeIndex ? 0 : 1] = upIndex;
+	}
+	else
+	{
+		m_rootIndex = upIndex;
+	}
+
+	// The taller of up's children stays with it, the shorter moves down under the node
+	const AABBTreeNode_t& f = m_nodes[fIndex];
+	const AABBTreeNode_t& g = m_nodes[gIndex];
+
+	int keptIndex = (f.height > g.height ? fIndex : gIndex);
+	int movedIndex = (f.height > g.height ? gIndex : fIndex);
+
+	up.children[1] = keptIndex;
+	a.children[upSlot] = movedIndex;
+	a.children[1 - upSlot] = otherIndex;
+	m_nodes[movedIndex].parent = nodeIndex;
+
+	const AABBTreeNode_t& other = m_nodes[otherIndex];
+	const AABBTreeNode_t& moved = m_nodes[movedIndex];
+	const AABBTreeNode_t& kept = m_nodes[keptIndex];
+
+	a.bounds = other.bounds.GetUnion(moved.bounds);
+	a.height = 1 + (other.height > moved.height ? other.height : moved.height);
+
+	up.bounds = a.bounds.GetUnion(kept.bounds);
+	up.height = 1 + (a.height > kept.height ? a.height : kept.height);
+
+	return upIndex;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Walks the tree, descending into nodes whose fattened bounds pass the test and appending leaves
+// whose real bounds do
+//
+template <typename OverlapTest>
+void AABBTree::QueryLeaves(const OverlapTest& overlaps, std::vector<int>& out_leafIDs) const
+{
+	if (m_rootIndex == AABB_TREE_NULL_NODE)
+	{
+		return;
+	}
+
+	std::vector<int>& stack = s_traversalStack;
+	stack.clear();
+	stack.push_back(m_rootIndex);
+
+	while (stack.size() > 0)
+	{
+		int nodeIndex = stack.back();
+		const AABBTreeNode_t& node = m_nodes[nodeIndex];
+		stack.pop_back();
+
+		if (!overlaps(node.bounds))
+		{
+			continue;
+		}
+
+		if (node.IsLeaf())
+		{
+			if (overlaps(node.leafBounds))
+			{
+				out_leafIDs.push_back(nodeIndex);
+			}
+		}
+		else
+		{
+			stack.push_back(node.children[0]);
+			stack.push_back(node.children[1]);
+		}
+	}
+}
@@ -0,0 +1,107 @@
+/************************************************************************/
+/* File: AABBTree.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Dynamic bounding volume hierarchy of AABB3s, for finding
+/*				what's near a point, ray, box or frustum without checking
+/*				everything; leaves are inserted, moved and removed one at
+/*				a time, and the tree is kept balanced as it goes
+/************************************************************************/
+#pragma once
+#include <vector>
+#include "Engine/Math/AABB3.hpp"
+
+class Frustum;
+
+// Leaves are stored with their bounds grown by this much, so small moves don't have to touch the tree
+#define AABB_TREE_DEFAULT_FAT_MARGIN (0.1f)
+
+// A moving leaf's fattened bounds also stretch this many frames along its displacement
+#define AABB_TREE_DISPLACEMENT_MULTIPLIER (2.f)
+
+#define AABB_TREE_NULL_NODE (-1)
+
+struct AABBTreeNode_t
+{
+	AABB3	bounds;								// Fattened for leaves, the union of the children otherwise
+	AABB3	leafBounds;							// Leaves only, the bounds queries are tested against
+	void*	userData = nullptr;
+
+	int		parent = AABB_TREE_NULL_NODE;		// The next free node, while on the free list
+	int		children[2] = { AABB_TREE_NULL_NODE, AABB_TREE_NULL_NODE };
+	int		height = -1;						// 0 for leaves, -1 while free
+
+	bool IsLeaf() const { return children[0] == AABB_TREE_NULL_NODE; }
+};
+
+struct AABBTreeRaycastHit_t
+{
+	int		leafID = AABB_TREE_NULL_NODE;		// AABB_TREE_NULL_NODE on a miss
+	float	distance = 0.f;						// Along the ray's direction, to where it enters the leaf's bounds
+};
+
+
+class AABBTree
+{
+public:
+	//-----Public Methods-----
+
+	AABBTree(float fatMargin = AABB_TREE_DEFAULT_FAT_MARGIN);
+	~AABBTree() {}
+
+	// Leaf IDs stay valid until the leaf is removed, and are reused after that
+	int			AddLeaf(const AABB3& bounds, void* userData);
+	void		RemoveLeaf(int leafID);
+	void		Clear();
+
+	// Returns true if the leaf had to be reinserted, false if its fattened bounds still held it
+	bool		UpdateLeaf(int leafID, const AABB3& bounds, const Vector3& displacement = Vector3::ZERO);
+
+	void*		GetUserData(int leafID) const;
+	AABB3		GetLeafBounds(int leafID) const;
+	int			GetLeafCount() const;
+	int			GetHeight() const;
+
+	// Append the IDs of leaves whose bounds overlap, in no particular order
+	void		QueryAABB(const AABB3& box, std::vector<int>& out_leafIDs) const;
+	void		QuerySphere(const Vector3& center, float radius, std::vector<int>& out_leafIDs) const;
+	void		QueryFrustum(const Frustum& frustum, std::vector<int>& out_leafIDs) const;
+
+	// Closest leaf bounds along the ray; the tree only knows boxes, so hits against the real shape are up to the caller
+	bool		Raycast(const Vector3& start, const Vector3& direction, float maxDistance, AABBTreeRaycastHit_t& out_hit) const;
+
+	// Every leaf the ray passes through, sorted nearest first
+	void		RaycastAll(const Vector3& start, const Vector3& direction, float maxDistance, std::vector<AABBTreeRaycastHit_t>& out_hits) const;
+
+	// Batch versions; out_offsets gets a start index into out_leafIDs per query, plus one past the end
+	void		QueryAABBs(const AABB3* boxes, int boxCount, std::vector<int>& out_leafIDs, std::vector<int>& out_offsets) const;
+	void		QuerySpheres(const Vector3* centers, const float* radii, int sphereCount, std::vector<int>& out_leafIDs, std::vector<int>& out_offsets) const;
+	void		RaycastBatch(const Vector3* starts, const Vector3* directions, int rayCount, float maxDistance, AABBTreeRaycastHit_t* out_hits) const;
+
+
+private:
+	//-----Private Methods-----
+
+	int			AllocateNode();
+	void		FreeNode(int nodeIndex);
+
+	void		InsertLeaf(int leafIndex);
+	void		RemoveLeafFromHierarchy(int leafIndex);
+	void		RefitAncestors(int nodeIndex);
+	int			Balance(int nodeIndex);
+
+	// Visits every leaf whose bounds pass the test, which also prunes the internal nodes
+	template <typename OverlapTest>
+	void		QueryLeaves(const OverlapTest& overlaps, std::vector<int>& out_leafIDs) const;
+
+
+private:
+	//-----Private Data-----
+
+	std::vector<AABBTreeNode_t> m_nodes;
+	int		m_rootIndex = AABB_TREE_NULL_NODE;
+	int		m_freeListHead = AABB_TREE_NULL_NODE;
+	int		m_leafCount = 0;
+	float	m_fatMargin = AABB_TREE_DEFAULT_FAT_MARGIN;
+
+};
@@ -0,0 +1,525 @@
+/************************************************************************/
+/* File: BoundsBatch.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the AABB3Batch and SphereBatch classes
+/************************************************************************/
+#include <string.h>
+#include "Game/Framework/EngineBuildPreferences.hpp"
+#include "Engine/Math/BoundsBatch.hpp"
+#include "Engine/Math/Frustum.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+#include "Engine/Core/Utility/StringUtils.hpp"
+
+// Same compile time selection as Matrix44 - 8 lanes with AVX, 4 with SSE or NEON, and one
+// lane as the scalar reference when MATRIX44_FORCE_SCALAR is defined or there's no SIMD
+#if !defined(MATRIX44_FORCE_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#if defined(__AVX__)
+#define BOUNDS_BATCH_SIMD_AVX
+#include <immintrin.h>
+#else
+#define BOUNDS_BATCH_SIMD_SSE
+#include <emmintrin.h>
+#endif
+#elif !defined(MATRIX44_FORCE_SCALAR) && (defined(__ARM_NEON) || defined(_M_ARM64))
+#define BOUNDS_BATCH_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+// The kernels are written once against these - a lane mask is all ones where the test passed
+// The arrays are only float aligned in std::vector, so every load is unaligned
+#if defined(BOUNDS_BATCH_SIMD_AVX)
+
+typedef __m256 Lanes_t;
+#define LANE_COUNT (8)
+
+static inline Lanes_t	LoadLanes(const float* values)			{ return _mm256_loadu_ps(values); }
+static inline Lanes_t	SplatLanes(float value)					{ return _mm256_set1_ps(value); }
+static inline Lanes_t	AddLanes(Lanes_t a, Lanes_t b)			{ return _mm256_add_ps(a, b); }
+static inline Lanes_t	SubtractLanes(Lanes_t a, Lanes_t b)		{ return _mm256_sub_ps(a, b); }
+static inline Lanes_t	MultiplyLanes(Lanes_t a, Lanes_t b)		{ return _mm256_mul_ps(a, b); }
+static inline Lanes_t	MaxLanes(Lanes_t a, Lanes_t b)			{ return _mm256_max_ps(a, b); }
+static inline Lanes_t	GreaterOrEqualLanes(Lanes_t a, Lanes_t b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+static inline Lanes_t	GreaterLanes(Lanes_t a, Lanes_t b)		{ return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+static inline Lanes_t	AndLanes(Lanes_t a, Lanes_t b)			{ return _mm256_and_ps(a, b); }
+static inline Lanes_t	AllLanes()								{ return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+static inline uint32_t	GetLaneBits(Lanes_t mask)				{ return static_cast<uint32_t>(_mm256_movemask_ps(mask)); }
+
+#elif defined(BOUNDS_BATCH_SIMD_SSE)
+
+typedef __m128 Lanes_t;
+#define LANE_COUNT (4)
+
+static inline Lanes_t	LoadLanes(const float* values)			{ return _mm_loadu_ps(values); }
+static inline Lanes_t	SplatLanes(float value)					{ return _mm_set1_ps(value); }
+static inline Lanes_t	AddLanes(Lanes_t a, Lanes_t b)			{ return _mm_add_ps(a, b); }
+static inline Lanes_t	SubtractLanes(Lanes_t a, Lanes_t b)		{ return _mm_sub_ps(a, b); }
+static inline Lanes_t	MultiplyLanes(Lanes_t a, Lanes_t b)		{ return _mm_mul_ps(a, b); }
+static inline Lanes_t	MaxLanes(Lanes_t a, Lanes_t b)			{ return _mm_max_ps(a, b); }
+static inline Lanes_t	GreaterOrEqualLanes(Lanes_t a, Lanes_t b) { return _mm_cmpge_ps(a, b); }
+static inline Lanes_t	GreaterLanes(Lanes_t a, Lanes_t b)		{ return _mm_cmpgt_ps(a, b); }
+static inline Lanes_t	AndLanes(Lanes_t a, Lanes_t b)			{ return _mm_and_ps(a, b); }
+static inline Lanes_t	AllLanes()								{ return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+static inline uint32_t	GetLaneBits(Lanes_t mask)				{ return static_cast<uint32_t>(_mm_movemask_ps(mask)); }
+
+#elif defined(BOUNDS_BATCH_SIMD_NEON)
+
+// Comparisons give uint32x4_t masks on NEON, so lanes are kept as floats and reinterpreted for the logic
+typedef float32x4_t Lanes_t;
+#define LANE_COUNT (4)
+
+static inline Lanes_t	LoadLanes(const float* values)			{ return vld1q_f32(values); }
+static inline Lanes_t	SplatLanes(float value)					{ return vdupq_n_f32(value); }
+static inline Lanes_t	AddLanes(Lanes_t a, Lanes_t b)			{ return vaddq_f32(a, b); }
+static inline Lanes_t	SubtractLanes(Lanes_t a, Lanes_t b)		{ return vsubq_f32(a, b); }
+static inline Lanes_t	MultiplyLanes(Lanes_t a, Lanes_t b)		{ return vmulq_f32(a, b); }
+static inline Lanes_t	MaxLanes(Lanes_t a, Lanes_t b)			{ return vmaxq_f32(a, b); }
+static inline Lanes_t	GreaterOrEqualLanes(Lanes_t a, Lanes_t b) { return vreinterpretq_f32_u32(vcgeq_f32(a, b)); }
+static inline Lanes_t	GreaterLanes(Lanes_t a, Lanes_t b)		{ return vreinterpretq_f32_u32(vcgtq_f32(a, b)); }
+static inline Lanes_t	AndLanes(Lanes_t a, Lanes_t b)			{ return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+static inline Lanes_t	AllLanes()								{ return vreinterpretq_f32_u32(vdupq_n_u32(0xFFFFFFFFu)); }
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// NEON has no movemask, so weight each lane by its bit and add them up
+//
+static inline uint32_t GetLaneBits(Lanes_t mask)
+{
+	static const uint32_t laneWeights[4] = { 1u, 2u, 4u, 8u };
+	uint32x4_t weighted = vandq_u32(vreinterpretq_u32_f32(mask), vld1q_u32(laneWeights));
+	uint32x2_t pairSums = vadd_u32(vget_low_u32(weighted), vget_high_u32(weighted));
+
+	return vget_lane_u32(vpadd_u32(pairSums, pairSums), 0);
+}
+
+#else
+
+// Scalar reference - one lane, with masks as 1.f or 0.f
+typedef float Lanes_t;
+#define LANE_COUNT (1)
+
+static inline Lanes_t	LoadLanes(const float* values)			{ return *values; }
+static inline Lanes_t	SplatLanes(float value)					{ return value; }
+static inline Lanes_t	AddLanes(Lanes_t a, Lanes_t b)			{ return a + b; }
+static inline Lanes_t	SubtractLanes(Lanes_t a, Lanes_t b)		{ return a - b; }
+static inline Lanes_t	MultiplyLanes(Lanes_t a, Lanes_t b)		{ return a * b; }
+static inline Lanes_t	MaxLanes(Lanes_t a, Lanes_t b)			{ return (a > b ? a : b); }
+static inline Lanes_t	GreaterOrEqualLanes(Lanes_t a, Lanes_t b) { return (a >= b ? 1.f : 0.f); }
+static inline Lanes_t	GreaterLanes(Lanes_t a, Lanes_t b)		{ return (a > b ? 1.f : 0.f); }
+static inline Lanes_t	AndLanes(Lanes_t a, Lanes_t b)			{ return a * b; }
+static inline Lanes_t	AllLanes()								{ return 1.f; }
+static inline uint32_t	GetLaneBits(Lanes_t mask)				{ return (mask != 0.f ? 1u : 0u); }
+
+#endif
+
+// LANE_COUNT divides 32, so a group of lanes never straddles two mask words
+static_assert(BOUNDS_BATCH_PADDING % LANE_COUNT == 0, "Bounds batches must be padded to a multiple of the SIMD width");
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Grows the padded array to hold index, filling the new lanes with zeros
+//
+static void EnsurePaddedSize(std::vector<float>& values, int index)
+{
+	int paddedSize = ((index / BOUNDS_BATCH_PADDING) + 1) * BOUNDS_BATCH_PADDING;
+
+	if (static_cast<int>(values.size()) < paddedSize)
+	{
+		values.resize(paddedSize, 0.f);
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Clears the masks, ready for each group of lanes to OR its bits in
+//
+static void ClearMasks(uint32_t* out_masks, int boundsCount)
+{
+	memset(out_masks, 0, GetBoundsMaskWordCount(boundsCount) * sizeof(uint32_t));
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// ORs the group's lane bits into the masks at the group's first index
+//
+static inline void StoreLaneBits(uint32_t* out_masks, int firstIndex, Lanes_t passed)
+{
+	out_masks[firstIndex >> 5] |= (GetLaneBits(passed) << (firstIndex & 31));
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Turns off the bits past the last bound, which the kernels set from the padding lanes
+//
+static void ClearMaskPadding(uint32_t* out_masks, int boundsCount)
+{
+	int usedBitsInLastWord = (boundsCount & 31);
+
+	if (usedBitsInLastWord > 0)
+	{
+		out_masks[boundsCount >> 5] &= ((1u << usedBitsInLastWord) - 1u);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the box to the end of the batch, and returns its index
+//
+int AABB3Batch::Add(const AABB3& box)
+{
+	int index = m_count;
+
+	EnsurePaddedSize(m_minX, index);
+	EnsurePaddedSize(m_minY, index);
+	EnsurePaddedSize(m_minZ, index);
+	EnsurePaddedSize(m_maxX, index);
+	EnsurePaddedSize(m_maxY, index);
+	EnsurePaddedSize(m_maxZ, index);
+
+	m_count++;
+	Set(index, box);
+
+	return index;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Replaces the box at the given index
+//
+void AABB3Batch::Set(int index, const AABB3& box)
+{
+	ASSERT_OR_DIE(index >= 0 && index < m_count, Stringf("Error: AABB3Batch::Set called with index %i, batch only has %i boxes", index, m_count));
+
+	m_minX[index] = box.mins.x;
+	m_minY[index] = box.mins.y;
+	m_minZ[index] = box.mins.z;
+	m_maxX[index] = box.maxs.x;
+	m_maxY[index] = box.maxs.y;
+	m_maxZ[index] = box.maxs.z;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the box at the given index
+//
+AABB3 AABB3Batch::Get(int index) const
+{
+	ASSERT_OR_DIE(index >= 0 && index < m_count, Stringf("Error: AABB3Batch::Get called with index %i, batch only has %i boxes", index, m_count));
+
+	return AABB3(Vector3(m_minX[index], m_minY[index], m_minZ[index]), Vector3(m_maxX[index], m_maxY[index], m_maxZ[index]));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reserves space for count boxes, so adding that many won't allocate
+//
+void AABB3Batch::Reserve(int count)
+{
+	size_t paddedCount = static_cast<size_t>(((count + BOUNDS_BATCH_PADDING - 1) / BOUNDS_BATCH_PADDING) * BOUNDS_BATCH_PADDING);
+
+	m_minX.reserve(paddedCount);
+	m_minY.reserve(paddedCount);
+	m_minZ.reserve(paddedCount);
+	m_maxX.reserve(paddedCount);
+	m_maxY.reserve(paddedCount);
+	m_maxZ.reserve(paddedCount);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes all boxes, keeping the memory
+//
+void AABB3Batch::Clear()
+{
+	m_minX.clear();
+	m_minY.clear();
+	m_minZ.clear();
+	m_maxX.clear();
+	m_maxY.clear();
+	m_maxZ.clear();
+	m_count = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of boxes in the batch
+//
+int AABB3Batch::GetCount() const
+{
+	return m_count;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the bit of every box not entirely behind one of the frustum planes
+// Tests the corner furthest along each plane's normal, which for a given plane is the same corner
+// of every box - so the min or max array per axis is picked once, instead of per box
+//
+void AABB3Batch::CullAgainstFrustum(const Frustum& frustum, uint32_t* out_visibleMasks) const
+{
+	ClearMasks(out_visibleMasks, m_count);
+
+	if (m_count == 0)
+	{
+		return;
+	}
+
+	Lanes_t planeX[NUM_FRUSTUM_PLANES];
+	Lanes_t planeY[NUM_FRUSTUM_PLANES];
+	Lanes_t planeZ[NUM_FRUSTUM_PLANES];
+	Lanes_t planeW[NUM_FRUSTUM_PLANES];
+	const float* cornerX[NUM_FRUSTUM_PLANES];
+	const float* cornerY[NUM_FRUSTUM_PLANES];
+	const float* cornerZ[NUM_FRUSTUM_PLANES];
+
+	for (int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES; ++planeIndex)
+	{
+		Vector4 plane = frustum.GetPlane(static_cast<eFrustumPlane>(planeIndex));
+
+		planeX[planeIndex] = SplatLanes(plane.x);
+		planeY[planeIndex] = SplatLanes(plane.y);
+		planeZ[planeIndex] = SplatLanes(plane.z);
+		planeW[planeIndex] = SplatLanes(plane.w);
+
+		cornerX[planeIndex] = (plane.x >= 0.f ? m_maxX.data() : m_minX.data());
+		cornerY[planeIndex] = (plane.y >= 0.f ? m_maxY.data() : m_minY.data());
+		cornerZ[planeIndex] = (plane.z >= 0.f ? m_maxZ.data() : m_minZ.data());
+	}
+
+	Lanes_t zero = SplatLanes(0.f);
+
+	for (int boxIndex = 0; boxIndex < m_count; boxIndex += LANE_COUNT)
+	{
+		Lanes_t visible = AllLanes();
+
+		for (int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES; ++planeIndex)
+		{
+			Lanes_t distance = AddLanes(MultiplyLanes(planeX[planeIndex], LoadLanes(cornerX[planeIndex] + boxIndex)), planeW[planeIndex]);
+			distance = AddLanes(distance, MultiplyLanes(planeY[planeIndex], LoadLanes(cornerY[planeIndex] + boxIndex)));
+			distance = AddLanes(distance, MultiplyLanes(planeZ[planeIndex], LoadLanes(cornerZ[planeIndex] + boxIndex)));
+
+			visible = AndLanes(visible, GreaterOrEqualLanes(distance, zero));
+		}
+
+		StoreLaneBits(out_visibleMasks, boxIndex, visible);
+	}
+
+	ClearMaskPadding(out_visibleMasks, m_count);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the bit of every box that overlaps the given one, touching doesn't count
+//
+void AABB3Batch::FindOverlapsWithBox(const AABB3& box, uint32_t* out_overlapMasks) const
+{
+	ClearMasks(out_overlapMasks, m_count);
+
+	if (m_count == 0)
+	{
+		return;
+	}
+
+	Lanes_t boxMinX = SplatLanes(box.mins.x);
+	Lanes_t boxMinY = SplatLanes(box.mins.y);
+	Lanes_t boxMinZ = SplatLanes(box.mins.z);
+	Lanes_t boxMaxX = SplatLanes(box.maxs.x);
+	Lanes_t boxMaxY = SplatLanes(box.maxs.y);
+	Lanes_t boxMaxZ = SplatLanes(box.maxs.z);
+
+	for (int boxIndex = 0; boxIndex < m_count; boxIndex += LANE_COUNT)
+	{
+		Lanes_t overlapX = AndLanes(GreaterLanes(LoadLanes(&m_maxX[boxIndex]), boxMinX), GreaterLanes(boxMaxX, LoadLanes(&m_minX[boxIndex])));
+		Lanes_t overlapY = AndLanes(GreaterLanes(LoadLanes(&m_maxY[boxIndex]), boxMinY), GreaterLanes(boxMaxY, LoadLanes(&m_minY[boxIndex])));
+		Lanes_t overlapZ = AndLanes(GreaterLanes(LoadLanes(&m_maxZ[boxIndex]), boxMinZ), GreaterLanes(boxMaxZ, LoadLanes(&m_minZ[boxIndex])));
+
+		StoreLaneBits(out_overlapMasks, boxIndex, AndLanes(overlapX, AndLanes(overlapY, overlapZ)));
+	}
+
+	ClearMaskPadding(out_overlapMasks, m_count);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the sphere to the end of the batch, and returns its index
+//
+int SphereBatch::Add(const Vector3& center, float radius)
+{
+	int index = m_count;
+
+	EnsurePaddedSize(m_centerX, index);
+	EnsurePaddedSize(m_centerY, index);
+	EnsurePaddedSize(m_centerZ, index);
+	EnsurePaddedSize(m_radius, index);
+
+	m_count++;
+	Set(index, center, radius);
+
+	return index;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Replaces the sphere at the given index
+//
+void SphereBatch::Set(int index, const Vector3& center, float radius)
+{
+	ASSERT_OR_DIE(index >= 0 && index < m_count, Stringf("Error: SphereBatch::Set called with index %i, batch only has %i spheres", index, m_count));
+
+	m_centerX[index] = center.x;
+	m_centerY[index] = center.y;
+	m_centerZ[index] = center.z;
+	m_radius[index] = radius;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the center of the sphere at the given index
+//
+Vector3 SphereBatch::GetCenter(int index) const
+{
+	ASSERT_OR_DIE(index >= 0 && index < m_count, Stringf("Error: SphereBatch::GetCenter called with index %i, batch only has %i spheres", index, m_count));
+
+	return Vector3(m_centerX[index], m_centerY[index], m_centerZ[index]);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the radius of the sphere at the given index
+//
+float SphereBatch::GetRadius(int index) const
+{
+	ASSERT_OR_DIE(index >= 0 && index < m_count, Stringf("Error: SphereBatch::GetRadius called with index %i, batch only has %i spheres", index, m_count));
+
+	return m_radius[index];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reserves space for count spheres, so adding that many won't allocate
+//
+void SphereBatch::Reserve(int count)
+{
+	size_t paddedCount = static_cast<size_t>(((count + BOUNDS_BATCH_PADDING - 1) / BOUNDS_BATCH_PADDING) * BOUNDS_BATCH_PADDING);
+
+	m_centerX.reserve(paddedCount);
+	m_centerY.reserve(paddedCount);
+	m_centerZ.reserve(paddedCount);
+	m_radius.reserve(paddedCount);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes all spheres, keeping the memory
+//
+void SphereBatch::Clear()
+{
+	m_centerX.clear();
+	m_centerY.clear();
+	m_centerZ.clear();
+	m_radius.clear();
+	m_count = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of spheres in the batch
+//
+int SphereBatch::GetCount() const
+{
+	return m_count;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the bit of every sphere not entirely behind one of the frustum planes
+//
+void SphereBatch::CullAgainstFrustum(const Frustum& frustum, uint32_t* out_visibleMasks) const
+{
+	ClearMasks(out_visibleMasks, m_count);
+
+	if (m_count == 0)
+	{
+		return;
+	}
+
+	// Radii are in world units, so the planes need unit normals
+	Lanes_t planeX[NUM_FRUSTUM_PLANES];
+	Lanes_t planeY[NUM_FRUSTUM_PLANES];
+	Lanes_t planeZ[NUM_FRUSTUM_PLANES];
+	Lanes_t planeW[NUM_FRUSTUM_PLANES];
+
+	for (int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES; ++planeIndex)
+	{
+		Vector4 plane = frustum.GetNormalizedPlane(static_cast<eFrustumPlane>(planeIndex));
+
+		planeX[planeIndex] = SplatLanes(plane.x);
+		planeY[planeIndex] = SplatLanes(plane.y);
+		planeZ[planeIndex] = SplatLanes(plane.z);
+		planeW[planeIndex] = SplatLanes(plane.w);
+	}
+
+	for (int sphereIndex = 0; sphereIndex < m_count; sphereIndex += LANE_COUNT)
+	{
+		Lanes_t centerX = LoadLanes(&m_centerX[sphereIndex]);
+		Lanes_t centerY = LoadLanes(&m_centerY[sphereIndex]);
+		Lanes_t centerZ = LoadLanes(&m_centerZ[sphereIndex]);
+		Lanes_t negativeRadius = SubtractLanes(SplatLanes(0.f), LoadLanes(&m_radius[sphereIndex]));
+
+		Lanes_t visible = AllLanes();
+
+		for (int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES; ++planeIndex)
+		{
+			Lanes_t distance = AddLanes(MultiplyLanes(planeX[planeIndex], centerX), planeW[planeIndex]);
+			distance = AddLanes(distance, MultiplyLanes(planeY[planeIndex], centerY));
+			distance = AddLanes(distance, MultiplyLanes(planeZ[planeIndex], centerZ));
+
+			visible = AndLanes(visible, GreaterOrEqualLanes(distance, negativeRadius));
+		}
+
+		StoreLaneBits(out_visibleMasks, sphereIndex, visible);
+	}
+
+	ClearMaskPadding(out_visibleMasks, m_count);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the bit of every sphere that touches or overlaps the box
+// Distance from the center to the box is how far outside the slab it is on each axis, or 0 inside
+//
+void SphereBatch::FindOverlapsWithBox(const AABB3& box, uint32_t* out_overlapMasks) const
+{
+	ClearMasks(out_overlapMasks, m_count);
+
+	if (m_count == 0)
+	{
+		return;
+	}
+
+	Lanes_t boxMinX = SplatLanes(box.mins.x);
+	Lanes_t boxMinY = SplatLanes(box.mins.y);
+	Lanes_t boxMinZ = SplatLanes(box.mins.z);
+	Lanes_t boxMaxX = SplatLanes(box.maxs.x);
+	Lanes_t boxMaxY = SplatLanes(box.maxs.y);
+	Lanes_t boxMaxZ = SplatLanes(box.maxs.z);
+	Lanes_t zero = SplatLanes(0.f);
+
+	for (int sphereIndex = 0; sphereIndex < m_count; sphereIndex += LANE_COUNT)
+	{
+		Lanes_t centerX = LoadLanes(&m_centerX[sphereIndex]);
+		Lanes_t centerY = LoadLanes(&m_centerY[sphereIndex]);
+		Lanes_t centerZ = LoadLanes(&m_centerZ[sphereIndex]);
+		Lanes_t radius = LoadLanes(&m_radius[sphereIndex]);
+
+		Lanes_t outsideX = MaxLanes(MaxLanes(SubtractLanes(boxMinX, centerX), SubtractLanes(centerX, boxMaxX)), zero);
+		Lanes_t outsideY = MaxLanes(MaxLanes(SubtractLanes(boxMinY, centerY), SubtractLanes(centerY, boxMaxY)), zero);
+		Lanes_t outsideZ = MaxLanes(MaxLanes(SubtractLanes(boxMinZ, centerZ), SubtractLanes(centerZ, boxMaxZ)), zero);
+
+		Lanes_t distanceSquared = AddLanes(AddLanes(MultiplyLanes(outsideX, outsideX), MultiplyLanes(outsideY, outsideY)), MultiplyLanes(outsideZ, outsideZ));
+
+		StoreLaneBits(out_overlapMasks, sphereIndex, GreaterOrEqualLanes(MultiplyLanes(radius, radius), distanceSquared));
+	}
+
+	ClearMaskPadding(out_overlapMasks, m_count);
+}
@@ -0,0 +1,88 @@
+/************************************************************************/
+/* File: BoundsBatch.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Structure-of-arrays lists of boxes and spheres, for testing
+/*				a frustum or a box against all of them at once with SIMD;
+/*				results come back as bitmasks, one bit per bound
+/************************************************************************/
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "Engine/Math/AABB3.hpp"
+
+class Frustum;
+
+// Arrays are padded to a multiple of this, so the kernels never need a scalar tail
+#define BOUNDS_BATCH_PADDING (8)
+
+// Number of uint32_t words needed to hold one bit per bound
+inline int		GetBoundsMaskWordCount(int boundsCount) { return (boundsCount + 31) / 32; }
+inline bool		IsBoundsMaskBitSet(const uint32_t* mask, int index) { return (mask[index >> 5] & (1u << (index & 31))) != 0; }
+
+
+class AABB3Batch
+{
+public:
+	//-----Public Methods-----
+
+	AABB3Batch() {}
+	~AABB3Batch() {}
+
+	int		Add(const AABB3& box);				// Returns the index of the box
+	void	Set(int index, const AABB3& box);
+	AABB3	Get(int index) const;
+	void	Reserve(int count);
+	void	Clear();
+	int		GetCount() const;
+
+	// out_masks needs GetBoundsMaskWordCount(GetCount()) words; bit i is set if box i passes
+	void	CullAgainstFrustum(const Frustum& frustum, uint32_t* out_visibleMasks) const;	// Same conservative test as Frustum::DoesAABB3Overlap
+	void	FindOverlapsWithBox(const AABB3& box, uint32_t* out_overlapMasks) const;		// Same test as DoAABB3sOverlap
+
+
+private:
+	//-----Private Data-----
+
+	std::vector<float> m_minX;
+	std::vector<float> m_minY;
+	std::vector<float> m_minZ;
+	std::vector<float> m_maxX;
+	std::vector<float> m_maxY;
+	std::vector<float> m_maxZ;
+	int m_count = 0;
+
+};
+
+
+class SphereBatch
+{
+public:
+	//-----Public Methods-----
+
+	SphereBatch() {}
+	~SphereBatch() {}
+
+	int		Add(const Vector3& center, float radius);	// Returns the index of the sphere
+	void	Set(int index, const Vector3& center, float radius);
+	Vector3	GetCenter(int index) const;
+	float	GetRadius(int index) const;
+	void	Reserve(int count);
+	void	Clear();
+	int		GetCount() const;
+
+	// out_masks needs GetBoundsMaskWordCount(GetCount()) words; bit i is set if sphere i passes
+	void	CullAgainstFrustum(const Frustum& frustum, uint32_t* out_visibleMasks) const;	// Same test as Frustum::DoesSphereOverlap
+	void	FindOverlapsWithBox(const AABB3& box, uint32_t* out_overlapMasks) const;		// Same test as DoesBoxSphereOverlap
+
+
+private:
+	//-----Private Data-----
+
+	std::vector<float> m_centerX;
+	std::vector<float> m_centerY;
+	std::vector<float> m_centerZ;
+	std::vector<float> m_radius;
+	int m_count = 0;
+
+};
@@ -5,9 +5,40 @@
 /* Bugs: None
 /* Description: Implementation of the CubicSpline class
 /************************************************************************/
+#include <algorithm>
 #include "Engine/Math/CubicSpline.hpp"
 
 
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Evaluates the Hermite curve in polynomial form, which also gives the velocity for little extra
+//
+static inline void EvaluateHermiteCurve(const Vector2& startPos, const Vector2& startVel, const Vector2& endPos, const Vector2& endVel, float t,
+	Vector2* out_position, Vector2* out_velocity)
+{
+	float t2 = t * t;
+	float t3 = t2 * t;
+
+	if (out_position != nullptr)
+	{
+		float startPosWeight	= 2.f * t3 - 3.f * t2 + 1.f;
+		float startVelWeight	= t3 - 2.f * t2 + t;
+		float endPosWeight		= -2.f * t3 + 3.f * t2;
+		float endVelWeight		= t3 - t2;
+
+		*out_position = startPos * startPosWeight + startVel * startVelWeight + endPos * endPosWeight + endVel * endVelWeight;
+	}
+
+	if (out_velocity != nullptr)
+	{
+		float displacementWeight	= 6.f * t - 6.f * t2;
+		float startVelWeight		= 3.f * t2 - 4.f * t + 1.f;
+		float endVelWeight			= 3.f * t2 - 2.f * t;
+
+		*out_velocity = (endPos - startPos) * displacementWeight + startVel * startVelWeight + endVel * endVelWeight;
+	}
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Constructs a cubic spline give the position and number of points (velocities optional)
 // If velocities aren't specified, they are defaulted to (0,0)
@@ -23,6 +54,8 @@ CubicSpline2D::CubicSpline2D(const Vector2* positionsArray, int numPoints, const
 //
 void CubicSpline2D::AppendPoint(const Vector2& position, const Vector2& velocity/*=Vector2::ZERO */)
 {
+	m_isArcLengthTableDirty = true;
+
 	m_positions.push_back(position);
 	m_velocities.push_back(velocity);
 }
@@ -67,6 +100,8 @@ void CubicSpline2D::AppendPositions(const Vector2* positionsArray, int numPoints
 //
 void CubicSpline2D::InsertPoint(int insertBeforeIndex, const Vector2& position, const Vector2& velocity/*=Vector2::ZERO */)
 {
+	m_isArcLengthTableDirty = true;
+
 	m_positions.insert(m_positions.begin() + insertBeforeIndex, position);
 	m_velocities.insert(m_velocities.begin() + insertBeforeIndex, velocity);
 }
@@ -77,6 +112,8 @@ void CubicSpline2D::InsertPoint(int insertBeforeIndex, const Vector2& position,
 //
 void CubicSpline2D::RemovePoint(int pointIndex)
 {
+	m_isArcLengthTableDirty = true;
+
 	m_positions.erase(m_positions.begin() + pointIndex);
 	m_velocities.erase(m_velocities.begin() + pointIndex);
 }
@@ -87,6 +124,8 @@ void CubicSpline2D::RemovePoint(int pointIndex)
 //
 void CubicSpline2D::RemoveAllPoints()
 {
+	m_isArcLengthTableDirty = true;
+
 	m_positions.clear();
 	m_velocities.clear();
 }
@@ -97,6 +136,8 @@ void CubicSpline2D::RemoveAllPoints()
 //
 void CubicSpline2D::SetPoint(int pointIndex, const Vector2& newPosition, const Vector2& newVelocity)
 {
+	m_isArcLengthTableDirty = true;
+
 	m_positions[pointIndex] = newPosition;
 	m_velocities[pointIndex] = newVelocity;
 }
@@ -107,6 +148,8 @@ void CubicSpline2D::SetPoint(int pointIndex, const Vector2& newPosition, const V
 //
 void CubicSpline2D::SetPosition(int pointIndex, const Vector2& newPosition)
 {
+	m_isArcLengthTableDirty = true;
+
 	m_positions[pointIndex] = newPosition;
 }
 
@@ -116,6 +159,8 @@ void CubicSpline2D::SetPosition(int pointIndex, const Vector2& newPosition)
 //
 void CubicSpline2D::SetVelocity(int pointIndex, const Vector2& newVelocity)
 {
+	m_isArcLengthTableDirty = true;
+
 	m_velocities[pointIndex] = newVelocity;
 }
 
@@ -237,3 +282,238 @@ Vector2 CubicSpline2D::EvaluateAtNormalizedParametric(float t) const
 
 	 return EvaluateAtCumulativeParametric(cumulativeParametric);
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the velocity of the spline at the given cumulative parameter t
+//
+Vector2 CubicSpline2D::EvaluateVelocityAtCumulativeParametric(float t) const
+{
+	int startPosIndex		= ClampInt(static_cast<int>(t), 0, GetNumPoints() - 2);
+	float curveParameter	= (t - static_cast<float>(startPosIndex));
+
+	Vector2 velocity;
+	EvaluateHermiteCurve(m_positions[startPosIndex], m_velocities[startPosIndex], m_positions[startPosIndex + 1], m_velocities[startPosIndex + 1], curveParameter, nullptr, &velocity);
+
+	return velocity;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Evaluates the position (and optionally velocity) at each cumulative parameter t, with the same
+// clamping and extrapolation past the ends as EvaluateAtCumulativeParametric()
+//
+void CubicSpline2D::EvaluateAtCumulativeParametrics(const float* tValues, int count, Vector2* out_positions, Vector2* out_velocities /*= nullptr*/) const
+{
+	int lastCurveIndex = GetNumPoints() - 2;
+
+	for (int index = 0; index < count; ++index)
+	{
+		float t = tValues[index];
+
+		int startPosIndex		= ClampInt(static_cast<int>(t), 0, lastCurveIndex);
+		float curveParameter	= (t - static_cast<float>(startPosIndex));
+
+		EvaluateHermiteCurve(m_positions[startPosIndex], m_velocities[startPosIndex], m_positions[startPosIndex + 1], m_velocities[startPosIndex + 1], curveParameter,
+			&out_positions[index], (out_velocities != nullptr ? &out_velocities[index] : nullptr));
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Rebuilds the arc length table if the points changed since it was last built
+//
+void CubicSpline2D::UpdateArcLengthTable() const
+{
+	if (!m_isArcLengthTableDirty)
+	{
+		return;
+	}
+
+	m_isArcLengthTableDirty = false;
+	m_arcLengths.clear();
+	m_arcLengths.push_back(0.f);
+
+	int numCurves = GetNumPoints() - 1;
+	if (numCurves < 1)
+	{
+		return;
+	}
+
+	// Three point Gauss-Legendre over each sample interval, integrating the speed
+	const float gaussOffset = 0.7745966692f;	// sqrt(3/5)
+	const float gaussOuterWeight = 5.f / 9.f;
+	const float gaussInnerWeight = 8.f / 9.f;
+
+	float intervalSize = 1.f / static_cast<float>(SPLINE_ARC_LENGTH_SAMPLES_PER_CURVE);
+	float halfInterval = 0.5f * intervalSize;
+	float totalLength = 0.f;
+
+	m_arcLengths.reserve(numCurves * SPLINE_ARC_LENGTH_SAMPLES_PER_CURVE + 1);
+
+	for (int curveIndex = 0; curveIndex < numCurves; ++curveIndex)
+	{
+		const Vector2& startPos = m_positions[curveIndex];
+		const Vector2& startVel = m_velocities[curveIndex];
+		const Vector2& endPos	= m_positions[curveIndex + 1];
+		const Vector2& endVel	= m_velocities[curveIndex + 1];
+
+		for (int sampleIndex = 0; sampleIndex < SPLINE_ARC_LENGTH_SAMPLES_PER_CURVE; ++sampleIndex)
+		{
+			float intervalCenter = (static_cast<float>(sampleIndex) + 0.5f) * intervalSize;
+
+			Vector2 lowVelocity, centerVelocity, highVelocity;
+			EvaluateHermiteCurve(startPos, startVel, endPos, endVel, intervalCenter - gaussOffset * halfInterval, nullptr, &lowVelocity);
+			EvaluateHermiteCurve(startPos, startVel, endPos, endVel, intervalCenter, nullptr, &centerVelocity);
+			EvaluateHermiteCurve(startPos, startVel, endPos, endVel, intervalCenter + gaussOffset * halfInterval, nullptr, &highVelocity);
+
+			float intervalLength = halfInterval * (gaussOuterWeight * lowVelocity.GetLength() + gaussInnerWeight * centerVelocity.GetLength() + gaussOuterWeight * highVelocity.GetLength());
+
+			totalLength += intervalLength;
+			m_arcLengths.push_back(totalLength);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the length along the curve from the first point to the last
+//
+float CubicSpline2D::GetLength() const
+{
+	UpdateArcLengthTable();
+	return m_arcLengths.back();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the cumulative parameter the given distance along the curve is at; distances past
+// either end are clamped to it
+//
+float CubicSpline2D::GetCumulativeParametricAtDistance(float distance) const
+{
+	UpdateArcLengthTable();
+
+	int sampleIndex = FindArcLengthSampleIndex(distance, -1);
+	return GetCumulativeParametricAtSample(sampleIndex, distance);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the position the given distance along the curve, so evenly spaced distances move
+// at a constant speed no matter how the points are spaced
+//
+Vector2 CubicSpline2D::EvaluateAtDistance(float distance) const
+{
+	return EvaluateAtCumulativeParametric(GetCumulativeParametricAtDistance(distance));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Evaluates the position (and optionally velocity) at each distance along the curve
+//
+void CubicSpline2D::EvaluateAtDistances(const float* distances, int count, Vector2* out_positions, Vector2* out_velocities /*= nullptr*/) const
+{
+	UpdateArcLengthTable();
+
+	int lastCurveIndex = GetNumPoints() - 2;
+	int sampleIndex = -1;
+
+	for (int index = 0; index < count; ++index)
+	{
+		sampleIndex = FindArcLengthSampleIndex(distances[index], sampleIndex);
+		float t = GetCumulativeParametricAtSample(sampleIndex, distances[index]);
+
+		int startPosIndex		= ClampInt(static_cast<int>(t), 0, lastCurveIndex);
+		float curveParameter	= (t - static_cast<float>(startPosIndex));
+
+		EvaluateHermiteCurve(m_positions[startPosIndex], m_velocities[startPosIndex], m_positions[startPosIndex + 1], m_velocities[startPosIndex + 1], curveParameter,
+			&out_positions[index], (out_velocities != nullptr ? &out_velocities[index] : nullptr));
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Appends numSamples positions evenly spaced along the curve, including both ends
+//
+void CubicSpline2D::SampleAtConstantSpeed(int numSamples, std::vector<Vector2>& out_positions) const
+{
+	if (numSamples <= 0)
+	{
+		return;
+	}
+
+	float spacing = (numSamples > 1 ? GetLength() / static_cast<float>(numSamples - 1) : 0.f);
+
+	int firstIndex = (int) out_positions.size();
+	out_positions.resize(firstIndex + numSamples);
+
+	int lastCurveIndex = GetNumPoints() - 2;
+	int sampleIndex = -1;
+
+	for (int index = 0; index < numSamples; ++index)
+	{
+		float distance = spacing * static_cast<float>(index);
+
+		sampleIndex = FindArcLengthSampleIndex(distance, sampleIndex);
+		float t = GetCumulativeParametricAtSample(sampleIndex, distance);
+
+		int startPosIndex		= ClampInt(static_cast<int>(t), 0, lastCurveIndex);
+		float curveParameter	= (t - static_cast<float>(startPosIndex));
+
+		EvaluateHermiteCurve(m_positions[startPosIndex], m_velocities[startPosIndex], m_positions[startPosIndex + 1], m_velocities[startPosIndex + 1], curveParameter,
+			&out_positions[firstIndex + index], nullptr);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the index of the table interval containing the distance, clamped to the first or last
+// interval; a valid search start at or before the distance is walked forward from, otherwise
+// the table is binary searched
+//
+int CubicSpline2D::FindArcLengthSampleIndex(float distance, int searchStartIndex) const
+{
+	int lastIntervalIndex = (int) m_arcLengths.size() - 2;
+
+	if (lastIntervalIndex < 0)
+	{
+		return 0;
+	}
+
+	if (searchStartIndex >= 0 && searchStartIndex <= lastIntervalIndex && m_arcLengths[searchStartIndex] <= distance)
+	{
+		int sampleIndex = searchStartIndex;
+
+		while (sampleIndex < lastIntervalIndex && m_arcLengths[sampleIndex + 1] <= distance)
+		{
+			sampleIndex++;
+		}
+
+		return sampleIndex;
+	}
+
+	int firstGreaterIndex = (int) (std::upper_bound(m_arcLengths.begin(), m_arcLengths.end(), distance) - m_arcLengths.begin());
+	return ClampInt(firstGreaterIndex - 1, 0, lastIntervalIndex);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the cumulative parameter for the distance within the given table interval, which is
+// treated as being traveled at a constant speed
+//
+float CubicSpline2D::GetCumulativeParametricAtSample(int sampleIndex, float distance) const
+{
+	if ((int) m_arcLengths.size() < 2)
+	{
+		return 0.f;
+	}
+
+	float intervalStart = m_arcLengths[sampleIndex];
+	float intervalLength = m_arcLengths[sampleIndex + 1] - intervalStart;
+
+	float fraction = (intervalLength > 0.f ? (distance - intervalStart) / intervalLength : 0.f);
+	fraction = ClampFloatZeroToOne(fraction);
+
+	return (static_cast<float>(sampleIndex) + fraction) * (1.f / static_cast<float>(SPLINE_ARC_LENGTH_SAMPLES_PER_CURVE));
+}
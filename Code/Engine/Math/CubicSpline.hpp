@@ -55,6 +55,10 @@ T EvaluateCubicHermite( const T& startPos, const T& startVel, const T& endPos, c
 // 
 // Cubic Hermite/Bezier spline of Vector2 positions / velocities
 /////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Arc length is sampled this many times per curve, for mapping distances back to parameters
+#define SPLINE_ARC_LENGTH_SAMPLES_PER_CURVE (16)
+
 class CubicSpline2D
 {
 public:
@@ -84,10 +88,39 @@ public:
 	int				GetVelocities( std::vector<Vector2>& out_velocities ) const;
 	Vector2			EvaluateAtCumulativeParametric( float t ) const;
 	Vector2			EvaluateAtNormalizedParametric( float t ) const;
+	Vector2			EvaluateVelocityAtCumulativeParametric( float t ) const;
+
+	// Batch versions, over cumulative parametric t values; out_velocities is optional
+	void			EvaluateAtCumulativeParametrics( const float* tValues, int count, Vector2* out_positions, Vector2* out_velocities=nullptr ) const;
+
+	// Arc length - the table is rebuilt on the first query after the points change, so call
+	// UpdateArcLengthTable() after editing if the spline is then sampled from several threads
+	void			UpdateArcLengthTable() const;
+	float			GetLength() const;
+	float			GetCumulativeParametricAtDistance( float distance ) const;
+	Vector2			EvaluateAtDistance( float distance ) const;
+
+	// Batch versions by distance; increasing distances walk the table from the last lookup instead of searching it
+	void			EvaluateAtDistances( const float* distances, int count, Vector2* out_positions, Vector2* out_velocities=nullptr ) const;
+
+	// Constant speed sampling - numSamples points evenly spaced along the curve, ends included
+	void			SampleAtConstantSpeed( int numSamples, std::vector<Vector2>& out_positions ) const;
+
+
+protected:
+	//-----Private Methods-----
+
+	int				FindArcLengthSampleIndex( float distance, int searchStartIndex ) const;
+	float			GetCumulativeParametricAtSample( int sampleIndex, float distance ) const;
+
 
 protected:
 	//-----Private Data-----
 
 	std::vector<Vector2>	m_positions;
 	std::vector<Vector2>	m_velocities;
+
+	// Distance along the curve at each sample, SPLINE_ARC_LENGTH_SAMPLES_PER_CURVE per curve plus the end
+	mutable std::vector<float>	m_arcLengths;
+	mutable bool				m_isArcLengthTableDirty = true;
 };
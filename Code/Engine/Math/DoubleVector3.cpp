@@ -0,0 +1,113 @@
+/************************************************************************/
+/* File: DoubleVector3.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the DoubleVector3 class
+/************************************************************************/
+#include <math.h>
+#include "Engine/Math/DoubleVector3.hpp"
+
+const DoubleVector3 DoubleVector3::ZERO = DoubleVector3(0.0, 0.0, 0.0);
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor from components
+//
+DoubleVector3::DoubleVector3(double initialX, double initialY, double initialZ)
+	: x(initialX), y(initialY), z(initialZ)
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor from a float vector
+//
+DoubleVector3::DoubleVector3(const Vector3& floatVector)
+	: x((double)floatVector.x), y((double)floatVector.y), z((double)floatVector.z)
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the two vectors
+//
+const DoubleVector3 DoubleVector3::operator+(const DoubleVector3& vecToAdd) const
+{
+	return DoubleVector3(x + vecToAdd.x, y + vecToAdd.y, z + vecToAdd.z);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Subtracts the given vector from this one
+//
+const DoubleVector3 DoubleVector3::operator-(const DoubleVector3& vecToSubtract) const
+{
+	return DoubleVector3(x - vecToSubtract.x, y - vecToSubtract.y, z - vecToSubtract.z);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Scales the vector uniformly
+//
+const DoubleVector3 DoubleVector3::operator*(double uniformScale) const
+{
+	return DoubleVector3(x * uniformScale, y * uniformScale, z * uniformScale);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the given vector to this one
+//
+void DoubleVector3::operator+=(const DoubleVector3& vecToAdd)
+{
+	x += vecToAdd.x;
+	y += vecToAdd.y;
+	z += vecToAdd.z;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Subtracts the given vector from this one
+//
+void DoubleVector3::operator-=(const DoubleVector3& vecToSubtract)
+{
+	x -= vecToSubtract.x;
+	y -= vecToSubtract.y;
+	z -= vecToSubtract.z;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the vectors are exactly equal
+//
+bool DoubleVector3::operator==(const DoubleVector3& compare) const
+{
+	return (x == compare.x && y == compare.y && z == compare.z);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the vectors differ at all
+//
+bool DoubleVector3::operator!=(const DoubleVector3& compare) const
+{
+	return !(*this == compare);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the magnitude of the vector
+//
+double DoubleVector3::GetLength() const
+{
+	return sqrt((x * x) + (y * y) + (z * z));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the vector rounded to float precision
+//
+Vector3 DoubleVector3::ToVector3() const
+{
+	return Vector3((float)x, (float)y, (float)z);
+}
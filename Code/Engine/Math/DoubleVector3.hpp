@@ -0,0 +1,46 @@
+/************************************************************************/
+/* File: DoubleVector3.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Double precision vector of three elements, for world
+/*				positions too far from the origin to keep in floats
+/************************************************************************/
+#pragma once
+#include "Engine/Math/Vector3.hpp"
+
+//-----------------------------------------------------------------------------------------------
+class DoubleVector3
+{
+
+public:
+	//-----Public Methods-----
+
+	// Construction/Destruction
+	DoubleVector3() {}
+	explicit DoubleVector3(double initialX, double initialY, double initialZ);
+	explicit DoubleVector3(const Vector3& floatVector);
+
+	// Operators
+	const DoubleVector3 operator+(const DoubleVector3& vecToAdd) const;
+	const DoubleVector3 operator-(const DoubleVector3& vecToSubtract) const;
+	const DoubleVector3 operator*(double uniformScale) const;
+	void operator+=(const DoubleVector3& vecToAdd);
+	void operator-=(const DoubleVector3& vecToSubtract);
+	bool operator==(const DoubleVector3& compare) const;
+	bool operator!=(const DoubleVector3& compare) const;
+
+	double	GetLength() const;
+	Vector3	ToVector3() const;		// Only precise when the vector is small, i.e. an offset between two nearby positions
+
+	// Static constants
+	const static DoubleVector3 ZERO;
+
+
+public:
+	//-----Public Data-----
+
+	double x = 0.0;
+	double y = 0.0;
+	double z = 0.0;
+
+};
@@ -0,0 +1,80 @@
+/************************************************************************/
+/* File: FixedPoint.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the FixedPoint class
+/************************************************************************/
+#include <math.h>
+#include "Engine/Math/FixedPoint.hpp"
+
+const FixedPoint FixedPoint::ZERO = FixedPoint(0);
+const FixedPoint FixedPoint::ONE = FixedPoint(1);
+const FixedPoint FixedPoint::HALF = FixedPoint::FromRaw(FIXED_POINT_ONE_RAW / 2);
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the nearest fixed point number to the float
+// Rounding of a given float is the same everywhere, but values computed in floats aren't - only
+// convert content that every machine loads identically
+//
+FixedPoint FixedPoint::FromFloat(float value)
+{
+	return FromRaw((int32_t) floorf(value * (float) FIXED_POINT_ONE_RAW + 0.5f));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the value as a float, for rendering and debug output only
+//
+float FixedPoint::ToFloat() const
+{
+	return (float) m_raw / (float) FIXED_POINT_ONE_RAW;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the magnitude of the value
+//
+FixedPoint FixedPoint::GetAbsoluteValue() const
+{
+	return (m_raw < 0 ? FromRaw(-m_raw) : *this);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the square root, rounded down, by integer square root of the raw value shifted up by
+// the fraction bits (sqrt(raw * 2^16) is the raw 16.16 root)
+//
+FixedPoint FixedPoint::GetSquareRoot() const
+{
+	if (m_raw <= 0)
+	{
+		return ZERO;
+	}
+
+	uint64_t remainder = (uint64_t) m_raw << FIXED_POINT_FRACTION_BITS;
+	uint64_t root = 0;
+	uint64_t bit = (uint64_t) 1 << 62;
+
+	while (bit > remainder)
+	{
+		bit >>= 2;
+	}
+
+	while (bit != 0)
+	{
+		if (remainder >= root + bit)
+		{
+			remainder -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else
+		{
+			root >>= 1;
+		}
+
+		bit >>= 2;
+	}
+
+	return FromRaw((int32_t) root);
+}
@@ -0,0 +1,198 @@
+/************************************************************************/
+/* File: FixedPoint.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: 16.16 fixed point number, for simulation math that must
+/*				give bit identical results on every machine (lockstep)
+/************************************************************************/
+#pragma once
+#include <stdint.h>
+
+#define FIXED_POINT_FRACTION_BITS (16)
+#define FIXED_POINT_ONE_RAW (1 << FIXED_POINT_FRACTION_BITS)
+
+//-----------------------------------------------------------------------------------------------
+class FixedPoint
+{
+
+public:
+	//-----Public Methods-----
+
+	// Construction/Destruction
+	FixedPoint() {}
+	constexpr explicit FixedPoint(int wholeValue);
+
+	// Only integer operations are used past construction, so results never depend on the FPU
+	// FromFloat() and ToFloat() are for content and display - a simulation shouldn't feed floats back in
+	static constexpr FixedPoint FromRaw(int32_t rawValue);
+	static constexpr FixedPoint FromRatio(int numerator, int denominator);
+	static FixedPoint			FromFloat(float value);
+
+	// Operators
+	constexpr const FixedPoint operator+(const FixedPoint& toAdd) const;
+	constexpr const FixedPoint operator-(const FixedPoint& toSubtract) const;
+	constexpr const FixedPoint operator*(const FixedPoint& toMultiply) const;
+	constexpr const FixedPoint operator/(const FixedPoint& divisor) const;
+	constexpr const FixedPoint operator-() const;
+	constexpr void operator+=(const FixedPoint& toAdd);
+	constexpr void operator-=(const FixedPoint& toSubtract);
+	constexpr void operator*=(const FixedPoint& toMultiply);
+	constexpr void operator/=(const FixedPoint& divisor);
+
+	constexpr bool operator==(const FixedPoint& compare) const;
+	constexpr bool operator!=(const FixedPoint& compare) const;
+	constexpr bool operator<(const FixedPoint& compare) const;
+	constexpr bool operator<=(const FixedPoint& compare) const;
+	constexpr bool operator>(const FixedPoint& compare) const;
+	constexpr bool operator>=(const FixedPoint& compare) const;
+
+	constexpr int32_t	GetRaw() const;
+	constexpr int		GetFloor() const;		// Largest whole number not above the value
+	float				ToFloat() const;
+
+	FixedPoint			GetAbsoluteValue() const;
+	FixedPoint			GetSquareRoot() const;	// Zero for negative values
+
+	// Static constants
+	const static FixedPoint ZERO;
+	const static FixedPoint ONE;
+	const static FixedPoint HALF;
+
+
+public:
+	//-----Public Data-----
+
+	int32_t m_raw = 0;
+
+};
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Constexpr definitions - in the header so constants built from them are
+// worked out at compile time
+///////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------------------------
+// Constructor from a whole number
+//
+constexpr FixedPoint::FixedPoint(int wholeValue)
+	: m_raw((int32_t) ((uint32_t) wholeValue << FIXED_POINT_FRACTION_BITS))
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the fixed point number with the given raw 16.16 bits, i.e. as read off the network
+//
+constexpr FixedPoint FixedPoint::FromRaw(int32_t rawValue)
+{
+	FixedPoint result = FixedPoint(0);
+	result.m_raw = rawValue;
+	return result;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns numerator / denominator, for exact constants like 1/3 without going through a float
+//
+constexpr FixedPoint FixedPoint::FromRatio(int numerator, int denominator)
+{
+	return FromRaw((int32_t) (((int64_t) numerator * FIXED_POINT_ONE_RAW) / denominator));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Operators - multiply and divide widen to 64 bits so the intermediate can't overflow
+//
+constexpr const FixedPoint FixedPoint::operator+(const FixedPoint& toAdd) const
+{
+	return FromRaw(m_raw + toAdd.m_raw);
+}
+
+constexpr const FixedPoint FixedPoint::operator-(const FixedPoint& toSubtract) const
+{
+	return FromRaw(m_raw - toSubtract.m_raw);
+}
+
+constexpr const FixedPoint FixedPoint::operator*(const FixedPoint& toMultiply) const
+{
+	return FromRaw((int32_t) (((int64_t) m_raw * (int64_t) toMultiply.m_raw) >> FIXED_POINT_FRACTION_BITS));
+}
+
+constexpr const FixedPoint FixedPoint::operator/(const FixedPoint& divisor) const
+{
+	return FromRaw((int32_t) (((int64_t) m_raw * FIXED_POINT_ONE_RAW) / (int64_t) divisor.m_raw));
+}
+
+constexpr const FixedPoint FixedPoint::operator-() const
+{
+	return FromRaw(-m_raw);
+}
+
+constexpr void FixedPoint::operator+=(const FixedPoint& toAdd)
+{
+	*this = *this + toAdd;
+}
+
+constexpr void FixedPoint::operator-=(const FixedPoint& toSubtract)
+{
+	*this = *this - toSubtract;
+}
+
+constexpr void FixedPoint::operator*=(const FixedPoint& toMultiply)
+{
+	*this = *this * toMultiply;
+}
+
+constexpr void FixedPoint::operator/=(const FixedPoint& divisor)
+{
+	*this = *this / divisor;
+}
+
+constexpr bool FixedPoint::operator==(const FixedPoint& compare) const
+{
+	return m_raw == compare.m_raw;
+}
+
+constexpr bool FixedPoint::operator!=(const FixedPoint& compare) const
+{
+	return m_raw != compare.m_raw;
+}
+
+constexpr bool FixedPoint::operator<(const FixedPoint& compare) const
+{
+	return m_raw < compare.m_raw;
+}
+
+constexpr bool FixedPoint::operator<=(const FixedPoint& compare) const
+{
+	return m_raw <= compare.m_raw;
+}
+
+constexpr bool FixedPoint::operator>(const FixedPoint& compare) const
+{
+	return m_raw > compare.m_raw;
+}
+
+constexpr bool FixedPoint::operator>=(const FixedPoint& compare) const
+{
+	return m_raw >= compare.m_raw;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the raw 16.16 bits, for sending or hashing into a checksum
+//
+constexpr int32_t FixedPoint::GetRaw() const
+{
+	return m_raw;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the largest whole number not above the value (the shift is arithmetic, so rounds down)
+//
+constexpr int FixedPoint::GetFloor() const
+{
+	return (int) (m_raw >> FIXED_POINT_FRACTION_BITS);
+}
@@ -0,0 +1,128 @@
+/************************************************************************/
+/* File: Frustum.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the Frustum class
+/************************************************************************/
+#include <math.h>
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Frustum.hpp"
+#include "Engine/Math/Matrix44.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+// Distance of the point from the plane, scaled by the plane normal's length
+static float GetPlaneDistance(const Vector4& plane, const Vector3& point);
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor, from the combined projection * view matrix
+// Each plane is a sum or difference of the W row with the X, Y or Z row of the matrix, since
+// a point is inside when -w <= x, y, z <= w in clip space
+//
+Frustum::Frustum(const Matrix44& viewProjection)
+{
+	const Matrix44& m = viewProjection;
+
+	Vector4 rowX = Vector4(m.Ix, m.Jx, m.Kx, m.Tx);
+	Vector4 rowY = Vector4(m.Iy, m.Jy, m.Ky, m.Ty);
+	Vector4 rowZ = Vector4(m.Iz, m.Jz, m.Kz, m.Tz);
+	Vector4 rowW = Vector4(m.Iw, m.Jw, m.Kw, m.Tw);
+
+	m_planes[FRUSTUM_PLANE_LEFT]	= rowW + rowX;
+	m_planes[FRUSTUM_PLANE_RIGHT]	= rowW - rowX;
+	m_planes[FRUSTUM_PLANE_BOTTOM]	= rowW + rowY;
+	m_planes[FRUSTUM_PLANE_TOP]		= rowW - rowY;
+	m_planes[FRUSTUM_PLANE_NEAR]	= rowW + rowZ;
+	m_planes[FRUSTUM_PLANE_FAR]		= rowW - rowZ;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the point is inside or on the frustum
+//
+bool Frustum::ContainsPoint(const Vector3& point) const
+{
+	for (int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES; ++planeIndex)
+	{
+		if (GetPlaneDistance(m_planes[planeIndex], point) < 0.f)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true unless the box is entirely behind one of the planes
+//
+bool Frustum::DoesAABB3Overlap(const AABB3& box) const
+{
+	Vector3 center = box.GetCenter();
+	Vector3 halfExtents = box.GetDimensions() * 0.5f;
+
+	for (int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES; ++planeIndex)
+	{
+		const Vector4& plane = m_planes[planeIndex];
+
+		// Projected "radius" of the box onto the plane normal
+		float radius = AbsoluteValue(plane.x) * halfExtents.x + AbsoluteValue(plane.y) * halfExtents.y + AbsoluteValue(plane.z) * halfExtents.z;
+
+		if (GetPlaneDistance(plane, center) < -radius)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true unless the sphere is entirely behind one of the planes
+//
+bool Frustum::DoesSphereOverlap(const Vector3& center, float radius) const
+{
+	for (int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES; ++planeIndex)
+	{
+		Vector4 plane = GetNormalizedPlane(static_cast<eFrustumPlane>(planeIndex));
+
+		if (GetPlaneDistance(plane, center) < -radius)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the given plane, as (normal, distance)
+//
+Vector4 Frustum::GetPlane(eFrustumPlane plane) const
+{
+	return m_planes[plane];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the given plane scaled so its normal has unit length
+//
+Vector4 Frustum::GetNormalizedPlane(eFrustumPlane plane) const
+{
+	const Vector4& unnormalized = m_planes[plane];
+	float normalLength = sqrtf(unnormalized.x * unnormalized.x + unnormalized.y * unnormalized.y + unnormalized.z * unnormalized.z);
+
+	return unnormalized * (1.f / normalLength);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the signed distance from the plane to the point, scaled by the length of the normal
+//
+static float GetPlaneDistance(const Vector4& plane, const Vector3& point)
+{
+	return plane.x * point.x + plane.y * point.y + plane.z * point.z + plane.w;
+}
@@ -0,0 +1,47 @@
+/************************************************************************/
+/* File: Frustum.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Class to represent the six planes of a camera's view volume
+/************************************************************************/
+#pragma once
+#include "Engine/Math/Vector4.hpp"
+
+class AABB3;
+class Matrix44;
+
+enum eFrustumPlane
+{
+	FRUSTUM_PLANE_LEFT,
+	FRUSTUM_PLANE_RIGHT,
+	FRUSTUM_PLANE_BOTTOM,
+	FRUSTUM_PLANE_TOP,
+	FRUSTUM_PLANE_NEAR,
+	FRUSTUM_PLANE_FAR,
+	NUM_FRUSTUM_PLANES
+};
+
+
+class Frustum
+{
+public:
+	//-----Public Methods-----
+
+	Frustum() {}
+	explicit Frustum(const Matrix44& viewProjection); // Extracts the planes in world space from a projection * view matrix
+
+	bool	ContainsPoint(const Vector3& point) const;
+	bool	DoesAABB3Overlap(const AABB3& box) const;	// Conservative - may return true for boxes just outside a corner
+	bool	DoesSphereOverlap(const Vector3& center, float radius) const;	// Conservative in the same way
+
+	Vector4 GetPlane(eFrustumPlane plane) const;
+	Vector4 GetNormalizedPlane(eFrustumPlane plane) const;	// Unit normal, so distances are in world units
+
+
+private:
+	//-----Private Data-----
+
+	// Planes are (normal, distance) with normals pointing into the frustum, not normalized
+	Vector4 m_planes[NUM_FRUSTUM_PLANES];
+
+};
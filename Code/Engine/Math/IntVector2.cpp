@@ -12,44 +12,18 @@
 #include "Engine/Math/MathUtils.hpp"
 
 
-// Initialize the static constants
-const IntVector2 IntVector2::ZERO				= IntVector2(0, 0);
-const IntVector2 IntVector2::STEP_NORTH			= IntVector2(0, 1);
-const IntVector2 IntVector2::STEP_SOUTH			= IntVector2(0, -1);
-const IntVector2 IntVector2::STEP_EAST			= IntVector2(1, 0);
-const IntVector2 IntVector2::STEP_WEST			= IntVector2(-1, 0);
-const IntVector2 IntVector2::STEP_NORTHEAST		= IntVector2(1, 1);
-const IntVector2 IntVector2::STEP_NORTHWEST		= IntVector2(-1, 1);
-const IntVector2 IntVector2::STEP_SOUTHEAST		= IntVector2(1, -1);
-const IntVector2 IntVector2::STEP_SOUTHWEST		= IntVector2(-1, -1);
+// Initialize the static constants - constexpr, so they're baked into the image instead of set up at startup
+constexpr IntVector2 IntVector2::ZERO				= IntVector2(0, 0);
+constexpr IntVector2 IntVector2::STEP_NORTH			= IntVector2(0, 1);
+constexpr IntVector2 IntVector2::STEP_SOUTH			= IntVector2(0, -1);
+constexpr IntVector2 IntVector2::STEP_EAST			= IntVector2(1, 0);
+constexpr IntVector2 IntVector2::STEP_WEST			= IntVector2(-1, 0);
+constexpr IntVector2 IntVector2::STEP_NORTHEAST		= IntVector2(1, 1);
+constexpr IntVector2 IntVector2::STEP_NORTHWEST		= IntVector2(-1, 1);
+constexpr IntVector2 IntVector2::STEP_SOUTHEAST		= IntVector2(1, -1);
+constexpr IntVector2 IntVector2::STEP_SOUTHWEST		= IntVector2(-1, -1);
 
 
-//-----------------------------------------------------------------------------------------------
-// Copy constructor
-IntVector2::IntVector2( const IntVector2& copy )
-  	: x( copy.x )
-	, y( copy.y )
-{
-}
-
-
-//-----------------------------------------------------------------------------------------------
-// Explicit constructor
-IntVector2::IntVector2( int initialX, int initialY )
-	: x( initialX )
-	, y( initialY )
-{
-}
-
-
-//-----------------------------------------------------------------------------------------------
-// Explicit float constructor
-IntVector2::IntVector2(float initialX, float initialY)
-	: x(static_cast<int>(initialX))
-	, y(static_cast<int>(initialY))
-{
-}
-
 //-----------------------------------------------------------------------------------------------
 // Explicit float vector constructor
 IntVector2::IntVector2(const Vector2& floatVector)
@@ -59,115 +33,6 @@ IntVector2::IntVector2(const Vector2& floatVector)
 }
 
 
-//-----------------------------------------------------------------------------------------------
-// Constructor - from single int value
-IntVector2::IntVector2(int initialValue)
-	: x(initialValue), y(initialValue)
-{
-}
-
-//------------------------------ Operator Overloads ---------------------------------------------
-
-//-----------------------------------------------------------------------------------------------
-const IntVector2 IntVector2::operator + ( const IntVector2& vecToAdd ) const
-{
-	return IntVector2( (x + vecToAdd.x), (y + vecToAdd.y) );
-}
-
-
-//-----------------------------------------------------------------------------------------------
-const IntVector2 IntVector2::operator-( const IntVector2& vecToSubtract ) const
-{
-	return IntVector2( (x - vecToSubtract.x), (y - vecToSubtract.y) );
-}
-
-
-//-----------------------------------------------------------------------------------------------
-bool IntVector2::operator<(const IntVector2& compare) const
-{
-	// Compare on y, using x as a tie breaker
-	if		(y < compare.y) { return true; }
-	else if (compare.y < y) { return false; }
-	else if (x < compare.x) { return true; }
-	else
-	{
-		return false;
-	}
-}
-
-
-//-----------------------------------------------------------------------------------------------
-const IntVector2 IntVector2::operator*( int uniformScale ) const
-{
-	return IntVector2( (x * uniformScale), (y * uniformScale) );
-}
-
-
-//-----------------------------------------------------------------------------------------------
-const IntVector2 IntVector2::operator/(int divisor) const
-{
-	return IntVector2((x / divisor), (y / divisor));
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void IntVector2::operator+=( const IntVector2& vecToAdd )
-{
-	x += vecToAdd.x;
-	y += vecToAdd.y;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void IntVector2::operator-=( const IntVector2& vecToSubtract )
-{
-	x -= vecToSubtract.x;
-	y -= vecToSubtract.y;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void IntVector2::operator*=( const int uniformScale )
-{
-	x *= uniformScale;
-	y *= uniformScale;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void IntVector2::operator=( const IntVector2& copyFrom )
-{
-	x = copyFrom.x;
-	y = copyFrom.y;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-const IntVector2 operator*( int uniformScale, const IntVector2& vecToScale )
-{
-	return IntVector2( static_cast<int>(vecToScale.x * uniformScale), static_cast<int>(vecToScale.y * uniformScale) );
-}
-
-
-//-----------------------------------------------------------------------------------------------
-bool IntVector2::operator==( const IntVector2& compare ) const
-{
-	if ( x == compare.x && y == compare.y ) {
-		return true;
-	}
-	return false;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-bool IntVector2::operator!=( const IntVector2& compare ) const
-{
-	if ( x != compare.x || y != compare.y ) {
-		return true;
-	}
-	return false;
-}
-
 
 //-----------------------------------------------------------------------------------------------
 // Calculates the magnitude (length) of the vector and returns it
@@ -18,29 +18,29 @@ public:
 	//-----Public Methods-----
 
 	// Construction/Destruction
-	~IntVector2() {}														// destructor: do nothing (for speed)
+	~IntVector2() = default;												// destructor: do nothing (for speed)
 	IntVector2() {}															// default constructor: do nothing (for speed)
-	IntVector2( const IntVector2& copyFrom );								// copy constructor (from another vec2)
-	explicit IntVector2( int initialX, int initialY );						// explicit constructor (from x, y)
-	explicit IntVector2( float initialX, float initialY );					// explicit float constructor
+	constexpr IntVector2( const IntVector2& copyFrom ) = default;			// copy constructor (from another vec2)
+	constexpr explicit IntVector2( int initialX, int initialY );			// explicit constructor (from x, y)
+	constexpr explicit IntVector2( float initialX, float initialY );		// explicit float constructor
 	explicit IntVector2(const Vector2& floatVector);
-	IntVector2(int initialValue);
+	constexpr IntVector2(int initialValue);
 																			// Operators
-	const IntVector2 operator+( const IntVector2& vecToAdd ) const;			// vec2 + vec2
-	const IntVector2 operator-( const IntVector2& vecToSubtract ) const;	// vec2 - vec2
-	const IntVector2 operator*( int uniformScale ) const;					// vec2 * int
-	const IntVector2 operator/(int divisor) const;
+	constexpr const IntVector2 operator+( const IntVector2& vecToAdd ) const;	// vec2 + vec2
+	constexpr const IntVector2 operator-( const IntVector2& vecToSubtract ) const;	// vec2 - vec2
+	constexpr const IntVector2 operator*( int uniformScale ) const;			// vec2 * int
+	constexpr const IntVector2 operator/(int divisor) const;
 
-	void operator+=( const IntVector2& vecToAdd );							// vec2 += vec2
-	void operator-=( const IntVector2& vecToSubtract );						// vec2 -= vec2
-	void operator*=( const int uniformScale );								// vec2 *= int
-	void operator=( const IntVector2& copyFrom );							// vec2 = vec2
-	bool operator==( const IntVector2& compare ) const;						// vec2 == vec2
-	bool operator!=( const IntVector2& compare ) const;						// vec2 != vec2
+	constexpr void operator+=( const IntVector2& vecToAdd );				// vec2 += vec2
+	constexpr void operator-=( const IntVector2& vecToSubtract );			// vec2 -= vec2
+	constexpr void operator*=( const int uniformScale );					// vec2 *= int
+	IntVector2& operator=( const IntVector2& copyFrom ) = default;			// vec2 = vec2
+	constexpr bool operator==( const IntVector2& compare ) const;			// vec2 == vec2
+	constexpr bool operator!=( const IntVector2& compare ) const;			// vec2 != vec2
 
-	bool operator<( const IntVector2& compare ) const;						// Used in particular for keys in maps
+	constexpr bool operator<( const IntVector2& compare ) const;			// Used in particular for keys in maps
 
-	friend const IntVector2 operator*( int uniformScale, const IntVector2& vecToScale );	// int * vec2
+	friend constexpr const IntVector2 operator*( int uniformScale, const IntVector2& vecToScale );	// int * vec2
 
 	float	GetLength() const;							// Calculates the magnitude of the vector
 	float	GetLengthSquared() const;					// Calculates the squared magnitude of the vector
@@ -71,3 +71,127 @@ public:
 	int x;
 	int y;
 };
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Constexpr definitions - in the header so constants and tables built from
+// them are worked out at compile time
+///////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------------------------
+// Explicit constructor
+constexpr IntVector2::IntVector2( int initialX, int initialY )
+	: x( initialX )
+	, y( initialY )
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Explicit float constructor
+constexpr IntVector2::IntVector2(float initialX, float initialY)
+	: x(static_cast<int>(initialX))
+	, y(static_cast<int>(initialY))
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - from single int value
+constexpr IntVector2::IntVector2(int initialValue)
+	: x(initialValue), y(initialValue)
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const IntVector2 IntVector2::operator + ( const IntVector2& vecToAdd ) const
+{
+	return IntVector2( (x + vecToAdd.x), (y + vecToAdd.y) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const IntVector2 IntVector2::operator-( const IntVector2& vecToSubtract ) const
+{
+	return IntVector2( (x - vecToSubtract.x), (y - vecToSubtract.y) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const IntVector2 IntVector2::operator*( int uniformScale ) const
+{
+	return IntVector2( (x * uniformScale), (y * uniformScale) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const IntVector2 IntVector2::operator/(int divisor) const
+{
+	return IntVector2((x / divisor), (y / divisor));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr void IntVector2::operator+=( const IntVector2& vecToAdd )
+{
+	x += vecToAdd.x;
+	y += vecToAdd.y;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr void IntVector2::operator-=( const IntVector2& vecToSubtract )
+{
+	x -= vecToSubtract.x;
+	y -= vecToSubtract.y;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr void IntVector2::operator*=( const int uniformScale )
+{
+	x *= uniformScale;
+	y *= uniformScale;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr bool IntVector2::operator==( const IntVector2& compare ) const
+{
+	if ( x == compare.x && y == compare.y ) {
+		return true;
+	}
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr bool IntVector2::operator!=( const IntVector2& compare ) const
+{
+	if ( x != compare.x || y != compare.y ) {
+		return true;
+	}
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr bool IntVector2::operator<(const IntVector2& compare) const
+{
+	// Compare on y, using x as a tie breaker
+	if		(y < compare.y) { return true; }
+	else if (compare.y < y) { return false; }
+	else if (x < compare.x) { return true; }
+	else
+	{
+		return false;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const IntVector2 operator*( int uniformScale, const IntVector2& vecToScale )
+{
+	return IntVector2( static_cast<int>(vecToScale.x * uniformScale), static_cast<int>(vecToScale.y * uniformScale) );
+}
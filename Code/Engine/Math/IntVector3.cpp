@@ -10,46 +10,9 @@
 #include "Engine/Math/MathUtils.hpp"
 
 
-// Initialize the static constants
- const IntVector3 IntVector3::ZERO				= IntVector3(0, 0, 0);
- const IntVector3 IntVector3::ONES				= IntVector3(1, 1, 1);
-
-//-----------------------------------------------------------------------------------------------
-// default constructor
-IntVector3::IntVector3()
-	: x(0), y(0), z(0)
-{
-}
-
-
-//-----------------------------------------------------------------------------------------------
-// Copy constructor
-IntVector3::IntVector3( const IntVector3& copy )
-	: x( copy.x )
-	, y( copy.y )
-	, z( copy.z )
-{
-}
-
-
-//-----------------------------------------------------------------------------------------------
-// Explicit constructor
-IntVector3::IntVector3( int initialX, int initialY, int initialZ )
-	: x( initialX )
-	, y( initialY )
-	, z( initialZ )
-{
-}
-
-
-//-----------------------------------------------------------------------------------------------
-// Explicit float constructor
-IntVector3::IntVector3(float initialX, float initialY, float initialZ)
-	: x(static_cast<int>(initialX))
-	, y(static_cast<int>(initialY))
-	, z(static_cast<int>(initialZ))
-{
-}
+// Initialize the static constants - constexpr, so they're baked into the image instead of set up at startup
+constexpr IntVector3 IntVector3::ZERO				= IntVector3(0, 0, 0);
+constexpr IntVector3 IntVector3::ONES				= IntVector3(1, 1, 1);
 
 
 //-----------------------------------------------------------------------------------------------
@@ -60,108 +23,6 @@ IntVector3::IntVector3(const Vector3& copyFrom)
 }
 
 
-//-----------------------------------------------------------------------------------------------
-// Explicit constructor from single int
-IntVector3::IntVector3(int initialValue)
-	: x(initialValue), y(initialValue), z(initialValue)
-{
-}
-
-//------------------------------ Operator Overloads ---------------------------------------------
-
-//-----------------------------------------------------------------------------------------------
-const IntVector3 IntVector3::operator + ( const IntVector3& vecToAdd ) const
-{
-	return IntVector3( (x + vecToAdd.x), (y + vecToAdd.y), (z + vecToAdd.z));
-}
-
-
-//-----------------------------------------------------------------------------------------------
-const IntVector3 IntVector3::operator-( const IntVector3& vecToSubtract ) const
-{
-	return IntVector3( (x - vecToSubtract.x), (y - vecToSubtract.y), (z - vecToSubtract.z) );
-}
-
-
-//-----------------------------------------------------------------------------------------------
-const IntVector3 IntVector3::operator*( int uniformScale ) const
-{
-	return IntVector3( (x * uniformScale), (y * uniformScale), (z * uniformScale) );
-}
-
-
-//-----------------------------------------------------------------------------------------------
-const IntVector3 IntVector3::operator/(int divisor) const
-{
-	return IntVector3(x / divisor, y / divisor, z / divisor);
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void IntVector3::operator+=( const IntVector3& vecToAdd )
-{
-	x += vecToAdd.x;
-	y += vecToAdd.y;
-	z += vecToAdd.z;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void IntVector3::operator-=( const IntVector3& vecToSubtract )
-{
-	x -= vecToSubtract.x;
-	y -= vecToSubtract.y;
-	z -= vecToSubtract.z;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void IntVector3::operator*=( const int uniformScale )
-{
-	x *= uniformScale;
-	y *= uniformScale;
-	z *= uniformScale;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void IntVector3::operator=( const IntVector3& copyFrom )
-{
-	x = copyFrom.x;
-	y = copyFrom.y;
-	z = copyFrom.z;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-const IntVector3 operator*( int uniformScale, const IntVector3& vecToScale )
-{
-	return IntVector3( (vecToScale.x * uniformScale), (vecToScale.y * uniformScale), (vecToScale.z * uniformScale) );
-}
-
-
-//-----------------------------------------------------------------------------------------------
-bool IntVector3::operator==( const IntVector3& compare ) const
-{
-	if ( x == compare.x && y == compare.y && z == compare.z ) 
-	{
-		return true;
-	}
-	return false;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-bool IntVector3::operator!=( const IntVector3& compare ) const
-{
-	if ( x != compare.x || y != compare.y || z != compare.z ) 
-	{
-		return true;
-	}
-	return false;
-}
-
-
 //-----------------------------------------------------------------------------------------------
 // Calculates the magnitude (length) of the vector and returns it
 //
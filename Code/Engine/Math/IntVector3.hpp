@@ -17,29 +17,29 @@ public:
 	//-----Public Methods-----
 
 	// Construction/Destruction
-	~IntVector3() {}														// destructor: do nothing (for speed)
-	IntVector3();															// default constructor: Initialize to 0
-	IntVector3( const IntVector3& copyFrom );								// copy constructor
-	explicit IntVector3( int initialX, int initialY, int initialZ );		// explicit constructor
-	explicit IntVector3( float initialX, float initialY, float initialZ );	// explicit float constructor
+	~IntVector3() = default;												// destructor: do nothing (for speed)
+	constexpr IntVector3();													// default constructor: Initialize to 0
+	constexpr IntVector3( const IntVector3& copyFrom ) = default;			// copy constructor
+	constexpr explicit IntVector3( int initialX, int initialY, int initialZ );	// explicit constructor
+	constexpr explicit IntVector3( float initialX, float initialY, float initialZ );	// explicit float constructor
 	explicit IntVector3(const Vector3& copyFrom);
-	explicit IntVector3(int initialValue);
-	
+	constexpr explicit IntVector3(int initialValue);
+
 	// Operators
-	const IntVector3 operator+( const IntVector3& vecToAdd ) const;			// vec2 + vec2
-	const IntVector3 operator-( const IntVector3& vecToSubtract ) const;	// vec2 - vec2
-	const IntVector3 operator*( int uniformScale ) const;					// vec2 * int
-	const IntVector3 operator/(int divisor) const;
+	constexpr const IntVector3 operator+( const IntVector3& vecToAdd ) const;	// vec2 + vec2
+	constexpr const IntVector3 operator-( const IntVector3& vecToSubtract ) const;	// vec2 - vec2
+	constexpr const IntVector3 operator*( int uniformScale ) const;			// vec2 * int
+	constexpr const IntVector3 operator/(int divisor) const;
 
-	void operator+=( const IntVector3& vecToAdd );							// vec2 += vec2
-	void operator-=( const IntVector3& vecToSubtract );						// vec2 -= vec2
-	void operator*=( const int uniformScale );								// vec2 *= int
+	constexpr void operator+=( const IntVector3& vecToAdd );				// vec2 += vec2
+	constexpr void operator-=( const IntVector3& vecToSubtract );			// vec2 -= vec2
+	constexpr void operator*=( const int uniformScale );					// vec2 *= int
 
-	void operator=( const IntVector3& copyFrom );							// vec2 = vec2
-	bool operator==( const IntVector3& compare ) const;						// vec2 == vec2
-	bool operator!=( const IntVector3& compare ) const;						// vec2 != vec2
+	IntVector3& operator=( const IntVector3& copyFrom ) = default;			// vec2 = vec2
+	constexpr bool operator==( const IntVector3& compare ) const;			// vec2 == vec2
+	constexpr bool operator!=( const IntVector3& compare ) const;			// vec2 != vec2
 
-	friend const IntVector3 operator*( int uniformScale, const IntVector3& vecToScale );	// int * vec2
+	friend constexpr const IntVector3 operator*( int uniformScale, const IntVector3& vecToScale );	// int * vec2
 
 	float	GetLength() const;							// Calculates the magnitude of the vector
 	float	GetLengthSquared() const;					// Calculates the squared magnitude of the vector
@@ -68,3 +68,128 @@ public:
 	int y;
 	int z;
 };
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Constexpr definitions - in the header so constants and tables built from
+// them are worked out at compile time
+///////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------------------------
+// default constructor
+constexpr IntVector3::IntVector3()
+	: x(0), y(0), z(0)
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Explicit constructor
+constexpr IntVector3::IntVector3( int initialX, int initialY, int initialZ )
+	: x( initialX )
+	, y( initialY )
+	, z( initialZ )
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Explicit float constructor
+constexpr IntVector3::IntVector3(float initialX, float initialY, float initialZ)
+	: x(static_cast<int>(initialX))
+	, y(static_cast<int>(initialY))
+	, z(static_cast<int>(initialZ))
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Explicit constructor from single int
+constexpr IntVector3::IntVector3(int initialValue)
+	: x(initialValue), y(initialValue), z(initialValue)
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const IntVector3 IntVector3::operator + ( const IntVector3& vecToAdd ) const
+{
+	return IntVector3( (x + vecToAdd.x), (y + vecToAdd.y), (z + vecToAdd.z));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const IntVector3 IntVector3::operator-( const IntVector3& vecToSubtract ) const
+{
+	return IntVector3( (x - vecToSubtract.x), (y - vecToSubtract.y), (z - vecToSubtract.z) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const IntVector3 IntVector3::operator*( int uniformScale ) const
+{
+	return IntVector3( (x * uniformScale), (y * uniformScale), (z * uniformScale) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const IntVector3 IntVector3::operator/(int divisor) const
+{
+	return IntVector3(x / divisor, y / divisor, z / divisor);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr void IntVector3::operator+=( const IntVector3& vecToAdd )
+{
+	x += vecToAdd.x;
+	y += vecToAdd.y;
+	z += vecToAdd.z;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr void IntVector3::operator-=( const IntVector3& vecToSubtract )
+{
+	x -= vecToSubtract.x;
+	y -= vecToSubtract.y;
+	z -= vecToSubtract.z;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr void IntVector3::operator*=( const int uniformScale )
+{
+	x *= uniformScale;
+	y *= uniformScale;
+	z *= uniformScale;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr bool IntVector3::operator==( const IntVector3& compare ) const
+{
+	if ( x == compare.x && y == compare.y && z == compare.z )
+	{
+		return true;
+	}
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr bool IntVector3::operator!=( const IntVector3& compare ) const
+{
+	if ( x != compare.x || y != compare.y || z != compare.z )
+	{
+		return true;
+	}
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const IntVector3 operator*( int uniformScale, const IntVector3& vecToScale )
+{
+	return IntVector3( (vecToScale.x * uniformScale), (vecToScale.y * uniformScale), (vecToScale.z * uniformScale) );
+}
@@ -8,6 +8,7 @@
 /************************************************************************/
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/Quaternion.hpp"
+#include "Engine/Math/RandomGenerator.hpp"
 #include <math.h>
 #include <cstdlib>
 
@@ -322,7 +323,7 @@ float GetAngleBetweenZeroThreeSixty(float angleDegrees)
 //
 float GetRandomFloatZeroToOne()
 {
-	return static_cast<float>(rand()) * (1.f / static_cast<float>(RAND_MAX));
+	return RandomGenerator::GetThreadDefault().GetFloatZeroToOne();
 }
 
 
@@ -331,9 +332,7 @@ float GetRandomFloatZeroToOne()
 //
 float GetRandomFloatInRange(float minInclusive, float maxInclusive)
 {
-	float ratio = GetRandomFloatZeroToOne();
-
-	return ((maxInclusive - minInclusive) * ratio) + minInclusive;
+	return RandomGenerator::GetThreadDefault().GetFloatInRange(minInclusive, maxInclusive);
 }
 
 
@@ -342,7 +341,7 @@ float GetRandomFloatInRange(float minInclusive, float maxInclusive)
 //
 int GetRandomIntLessThan(int maxNotInclusive)
 {
-	return rand() % maxNotInclusive;
+	return RandomGenerator::GetThreadDefault().GetIntLessThan(maxNotInclusive);
 }
 
 
@@ -351,7 +350,7 @@ int GetRandomIntLessThan(int maxNotInclusive)
 //
 int GetRandomIntInRange(int minInclusive, int maxInclusive)
 {
-	return (rand() % (maxInclusive - minInclusive + 1)) + minInclusive; 
+	return RandomGenerator::GetThreadDefault().GetIntInRange(minInclusive, maxInclusive);
 }
 
 
@@ -360,7 +359,7 @@ int GetRandomIntInRange(int minInclusive, int maxInclusive)
 //
 bool GetRandomTrueOrFalse()
 {
-	return ((rand() % 2) == 0);
+	return RandomGenerator::GetThreadDefault().GetTrueOrFalse();
 }
 
 
@@ -369,19 +368,7 @@ bool GetRandomTrueOrFalse()
 //
 bool CheckRandomChance(float chanceForSuccess)
 {
-	if (chanceForSuccess >= 1.f)
-	{
-		return true;
-	}
-	else if (chanceForSuccess <= 0.f)
-	{
-		return false;
-	}
-	else
-	{
-		float outcome = GetRandomFloatZeroToOne();
-		return (outcome <= chanceForSuccess);
-	}
+	return RandomGenerator::GetThreadDefault().CheckChance(chanceForSuccess);
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -395,14 +382,11 @@ Vector2 GetRandomPointWithinCircle()
 
 
 //-----------------------------------------------------------------------------------------------
-// Rounds inValue to the nearest integer, with 0.5 rounding to 1, -0.5 rounding to 0
+// Returns a random unit vector, uniformly distributed over the sphere
 //
 Vector3 GetRandomPointOnSphere()
 {
-	float theta = GetRandomFloatInRange(0.f, 360.f);
-	float phi = GetRandomFloatInRange(0.f, 360.f);
-
-	return SphericalToCartesian(1, theta, phi);
+	return RandomGenerator::GetThreadDefault().GetPointOnSphere();
 }
 
 
@@ -1165,23 +1149,14 @@ bool DoSpheresOverlap(const Vector3& posA, float radiusA, const Vector3& posB, f
 
 
 //-----------------------------------------------------------------------------------------------
-// Returns whether the given box and sphere overlap
+// Returns whether the given box and sphere overlap, by clamping the sphere's center onto the box
 //
 bool DoesBoxSphereOverlap(const AABB3& boxBounds, const Vector3& sphereCenter, float sphereRadius)
 {
-	Vector3 boxCenter = boxBounds.GetCenter();
-
-	if (boxBounds.ContainsPoint(sphereCenter))
-	{
-		return true;
-	}
-
-	Vector3 directionToBox = (boxCenter - sphereCenter);
-	float distance = directionToBox.NormalizeAndGetLength();
-
-	float magnitude = MinFloat(sphereRadius, distance);
-
-	Vector3 closestPosition = sphereCenter + (magnitude * directionToBox);
+	Vector3 closestPoint;
+	closestPoint.x = ClampFloat(sphereCenter.x, boxBounds.mins.x, boxBounds.maxs.x);
+	closestPoint.y = ClampFloat(sphereCenter.y, boxBounds.mins.y, boxBounds.maxs.y);
+	closestPoint.z = ClampFloat(sphereCenter.z, boxBounds.mins.z, boxBounds.maxs.z);
 
-	return boxBounds.ContainsPoint(closestPosition);
+	return ((closestPoint - sphereCenter).GetLengthSquared() <= sphereRadius * sphereRadius);
 }
@@ -18,6 +18,8 @@
 #include "Engine/Math/IntVector3.hpp"
 #include <stdint.h>
 
+class Quaternion;
+
 // Constants
 const float PI = 3.1415926535897932384626433832795f;
 
@@ -83,6 +85,7 @@ float	TurnToward(float currentDegrees, float goalDegrees, float maxTurnDegrees);
 float	DotProduct(const Vector2& a, const Vector2& b);									// Returns the dot product between a and b
 float	DotProduct(const Vector3& a, const Vector3& b);	
 float	DotProduct(const Vector4& a, const Vector4& b);
+float	DotProduct(const Quaternion& a, const Quaternion& b);
 Vector3 CrossProduct(const Vector3& a, const Vector3& b);								// Returns the cross product between a and b
 Vector3 Reflect(const Vector3& incidentVector, const Vector3& normal);					// Reflects the incident vector about the normal
 bool	Refract(const Vector3& incidentVector, const Vector3& normal, float niOverNt, Vector3& out_refractedVector); // Returns true if the given vector will refract across the surface, false otherwise
@@ -4,6 +4,7 @@
 /* Date: November 10th, 2017
 /* Description: Implementation of the Matrix44 class
 /************************************************************************/
+#include <math.h>
 #include "Game/Framework/EngineBuildPreferences.hpp"
 #include "Engine/Core/Window.hpp"
 #include "Engine/Math/Vector4.hpp"
@@ -12,104 +13,215 @@
 #include "Engine/Math/Quaternion.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 
-const Matrix44 Matrix44::IDENTITY = Matrix44();
+// The SIMD kernels are picked at compile time from what the target supports, define
+// MATRIX44_FORCE_SCALAR in EngineBuildPreferences to build the scalar reference versions instead
+#if !defined(MATRIX44_FORCE_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MATRIX44_SIMD_SSE
+#include <emmintrin.h>
+#if defined(__AVX__)
+#define MATRIX44_SIMD_AVX
+#include <immintrin.h>
+#endif
+#elif !defined(MATRIX44_FORCE_SCALAR) && (defined(__ARM_NEON) || defined(_M_ARM64))
+#define MATRIX44_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+constexpr Matrix44 Matrix44::IDENTITY = Matrix44();
+
+// The basis vectors are 16 contiguous floats, so each loads as one register
+// Matrices and vectors aren't 16 byte aligned in containers, so every load and store is unaligned
+#if defined(MATRIX44_SIMD_SSE)
+
+#define SSE_SHUFFLE(vec, x, y, z, w) _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(vec), _MM_SHUFFLE(w, z, y, x)))
+#define SSE_SHUFFLE2(a, b, x, y, z, w) _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x))
+#define SSE_SPLAT(vec, index) SSE_SHUFFLE(vec, index, index, index, index)
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the columns weighted by the vector's components, i.e. the matrix times the vector
+//
+static inline __m128 TransformSSE(const __m128* columns, __m128 vector)
+{
+	__m128 xy = _mm_add_ps(_mm_mul_ps(columns[0], SSE_SPLAT(vector, 0)), _mm_mul_ps(columns[1], SSE_SPLAT(vector, 1)));
+	__m128 zw = _mm_add_ps(_mm_mul_ps(columns[2], SSE_SPLAT(vector, 2)), _mm_mul_ps(columns[3], SSE_SPLAT(vector, 3)));
 
-//-----------------------------------------------------------------------------------------------
-// Default constructor, sets to Identity
+	return _mm_add_ps(xy, zw);
+}
+
+#if defined(MATRIX44_SIMD_AVX)
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// TransformSSE() on two vectors at once, with the columns in both halves of each register
 //
-Matrix44::Matrix44()
+static inline __m256 TransformPairAVX(const __m256* columns, __m256 vectors)
 {
-	SetIdentity();
+	__m256 xy = _mm256_add_ps(_mm256_mul_ps(columns[0], _mm256_shuffle_ps(vectors, vectors, _MM_SHUFFLE(0, 0, 0, 0))), _mm256_mul_ps(columns[1], _mm256_shuffle_ps(vectors, vectors, _MM_SHUFFLE(1, 1, 1, 1))));
+	__m256 zw = _mm256_add_ps(_mm256_mul_ps(columns[2], _mm256_shuffle_ps(vectors, vectors, _MM_SHUFFLE(2, 2, 2, 2))), _mm256_mul_ps(columns[3], _mm256_shuffle_ps(vectors, vectors, _MM_SHUFFLE(3, 3, 3, 3))));
+
+	return _mm256_add_ps(xy, zw);
 }
+#endif
 
 
-//-----------------------------------------------------------------------------------------------
-// Constructor, from a 16-element float array (float[16])
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Loads the matrix's basis vectors
 //
-Matrix44::Matrix44(const float* sixteenValuesBasisMajor)
+static inline void LoadColumnsSSE(const Matrix44& matrix, __m128* out_columns)
 {
-	Ix = sixteenValuesBasisMajor[0];
-	Iy = sixteenValuesBasisMajor[1];
-	Iz = sixteenValuesBasisMajor[2];
-	Iw = sixteenValuesBasisMajor[3];
+	out_columns[0] = _mm_loadu_ps(&matrix.Ix);
+	out_columns[1] = _mm_loadu_ps(&matrix.Jx);
+	out_columns[2] = _mm_loadu_ps(&matrix.Kx);
+	out_columns[3] = _mm_loadu_ps(&matrix.Tx);
+}
 
-	Jx = sixteenValuesBasisMajor[4];
-	Jy = sixteenValuesBasisMajor[5];
-	Jz = sixteenValuesBasisMajor[6];
-	Jw = sixteenValuesBasisMajor[7];
 
-	Kx = sixteenValuesBasisMajor[8];
-	Ky = sixteenValuesBasisMajor[9];
-	Kz = sixteenValuesBasisMajor[10];
-	Kw = sixteenValuesBasisMajor[11];
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Stores the xyz of the register into the vector
+//
+static inline void StoreVector3SSE(__m128 value, Vector3& out_vector)
+{
+	_mm_storel_pi((__m64*) &out_vector.x, value);
+	_mm_store_ss(&out_vector.z, _mm_movehl_ps(value, value));
+}
 
-	Tx = sixteenValuesBasisMajor[12];
-	Ty = sixteenValuesBasisMajor[13];
-	Tz = sixteenValuesBasisMajor[14];
-	Tw = sixteenValuesBasisMajor[15];
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the cross product of the xyz of both, with a w of a.w * b.w - a.w * b.w, zero for finite values
+//
+static inline __m128 CrossProductSSE(__m128 a, __m128 b)
+{
+	__m128 partial = _mm_sub_ps(_mm_mul_ps(a, SSE_SHUFFLE(b, 1, 2, 0, 3)), _mm_mul_ps(SSE_SHUFFLE(a, 1, 2, 0, 3), b));
+	return SSE_SHUFFLE(partial, 1, 2, 0, 3);
 }
 
 
-//-----------------------------------------------------------------------------------------------
-// Constructor, from the explicit I, J, K basis vectors and T translation vector
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the sum of the four components in every component
 //
-Matrix44::Matrix44(const Vector3& iBasis, const Vector3& jBasis, const Vector3& kBasis, const Vector3& translation/*=Vector3::ZERO*/)
-	: Matrix44()
+static inline __m128 HorizontalSumSSE(__m128 value)
 {
-	Ix = iBasis.x;
-	Iy = iBasis.y;
-	Iz = iBasis.z;
+	__m128 pairSums = _mm_add_ps(value, SSE_SHUFFLE(value, 2, 3, 0, 1));
+	return _mm_add_ps(pairSums, SSE_SHUFFLE(pairSums, 1, 0, 3, 2));
+}
 
-	Jx = jBasis.x;
-	Jy = jBasis.y;
-	Jz = jBasis.z;
 
-	Kx = kBasis.x;
-	Ky = kBasis.y;
-	Kz = kBasis.z;
+// The general inverse works on the matrix as four 2x2 blocks, each held in one register as (m00, m01, m10, m11)
 
-	Tx = translation.x;
-	Ty = translation.y;
-	Tz = translation.z;
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the 2x2 product a * b
+//
+static inline __m128 Matrix22MultiplySSE(__m128 a, __m128 b)
+{
+	return _mm_add_ps(_mm_mul_ps(a, SSE_SHUFFLE(b, 0, 3, 0, 3)), _mm_mul_ps(SSE_SHUFFLE(a, 1, 0, 3, 2), SSE_SHUFFLE(b, 2, 1, 2, 1)));
 }
 
 
-//-----------------------------------------------------------------------------------------------
-// Constructor from Vector4 column vectors
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the 2x2 product adjugate(a) * b
 //
-Matrix44::Matrix44(const Vector4& iBasis, const Vector4& jBasis, const Vector4& kBasis, const Vector4& translation/*=Vector3::ZERO*/)
+static inline __m128 Matrix22AdjugateMultiplySSE(__m128 a, __m128 b)
 {
-	Ix = iBasis.x;
-	Iy = iBasis.y;
-	Iz = iBasis.z;
-	Iw = iBasis.w;
+	return _mm_sub_ps(_mm_mul_ps(SSE_SHUFFLE(a, 3, 3, 0, 0), b), _mm_mul_ps(SSE_SHUFFLE(a, 1, 1, 2, 2), SSE_SHUFFLE(b, 2, 3, 0, 1)));
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the 2x2 product a * adjugate(b)
+//
+static inline __m128 Matrix22MultiplyAdjugateSSE(__m128 a, __m128 b)
+{
+	return _mm_sub_ps(_mm_mul_ps(a, SSE_SHUFFLE(b, 3, 0, 3, 0)), _mm_mul_ps(SSE_SHUFFLE(a, 1, 0, 3, 2), SSE_SHUFFLE(b, 2, 1, 2, 1)));
+}
+
+#elif defined(MATRIX44_SIMD_NEON)
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the columns weighted by the vector's components, i.e. the matrix times the vector
+//
+static inline float32x4_t TransformNEON(const float32x4_t* columns, float32x4_t vector)
+{
+	float32x2_t xy = vget_low_f32(vector);
+	float32x2_t zw = vget_high_f32(vector);
+
+	float32x4_t result = vmulq_lane_f32(columns[0], xy, 0);
+	result = vmlaq_lane_f32(result, columns[1], xy, 1);
+	result = vmlaq_lane_f32(result, columns[2], zw, 0);
+	result = vmlaq_lane_f32(result, columns[3], zw, 1);
 
-	Jx = jBasis.x;
-	Jy = jBasis.y;
-	Jz = jBasis.z;
-	Jw = iBasis.w;
+	return result;
+}
 
-	Kx = kBasis.x;
-	Ky = kBasis.y;
-	Kz = kBasis.z;
-	Kw = kBasis.w;
 
-	Tx = translation.x;
-	Ty = translation.y;
-	Tz = translation.z;
-	Tw = translation.w;
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Loads the matrix's basis vectors
+//
+static inline void LoadColumnsNEON(const Matrix44& matrix, float32x4_t* out_columns)
+{
+	out_columns[0] = vld1q_f32(&matrix.Ix);
+	out_columns[1] = vld1q_f32(&matrix.Jx);
+	out_columns[2] = vld1q_f32(&matrix.Kx);
+	out_columns[3] = vld1q_f32(&matrix.Tx);
 }
 
 
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Stores the xyz of the register into the vector
+//
+static inline void StoreVector3NEON(float32x4_t value, Vector3& out_vector)
+{
+	vst1_f32(&out_vector.x, vget_low_f32(value));
+	vst1q_lane_f32(&out_vector.z, value, 2);
+}
+
+#endif
+
+
 //-----------------------------------------------------------------------------------------------
 // Operator for multiplying matrices
 //
 const Matrix44 Matrix44::operator*(const Matrix44& rightMat) const
 {
-	Matrix44 result = *this;
-	result.Append(rightMat);
+#if defined(MATRIX44_SIMD_AVX)
+	// Two result basis vectors per register, so the left columns are in both halves
+	__m256 columns[4];
+	columns[0] = _mm256_broadcast_ps((const __m128*) &Ix);
+	columns[1] = _mm256_broadcast_ps((const __m128*) &Jx);
+	columns[2] = _mm256_broadcast_ps((const __m128*) &Kx);
+	columns[3] = _mm256_broadcast_ps((const __m128*) &Tx);
+
+	Matrix44 result;
+	_mm256_storeu_ps(&result.Ix, TransformPairAVX(columns, _mm256_loadu_ps(&rightMat.Ix)));
+	_mm256_storeu_ps(&result.Kx, TransformPairAVX(columns, _mm256_loadu_ps(&rightMat.Kx)));
+
+	return result;
+
+#elif defined(MATRIX44_SIMD_SSE)
+	// Each result basis vector is this matrix times that one of rightMat's
+	__m128 columns[4];
+	LoadColumnsSSE(*this, columns);
+
+	Matrix44 result;
+	_mm_storeu_ps(&result.Ix, TransformSSE(columns, _mm_loadu_ps(&rightMat.Ix)));
+	_mm_storeu_ps(&result.Jx, TransformSSE(columns, _mm_loadu_ps(&rightMat.Jx)));
+	_mm_storeu_ps(&result.Kx, TransformSSE(columns, _mm_loadu_ps(&rightMat.Kx)));
+	_mm_storeu_ps(&result.Tx, TransformSSE(columns, _mm_loadu_ps(&rightMat.Tx)));
 
 	return result;
+
+#elif defined(MATRIX44_SIMD_NEON)
+	float32x4_t columns[4];
+	LoadColumnsNEON(*this, columns);
+
+	Matrix44 result;
+	vst1q_f32(&result.Ix, TransformNEON(columns, vld1q_f32(&rightMat.Ix)));
+	vst1q_f32(&result.Jx, TransformNEON(columns, vld1q_f32(&rightMat.Jx)));
+	vst1q_f32(&result.Kx, TransformNEON(columns, vld1q_f32(&rightMat.Kx)));
+	vst1q_f32(&result.Tx, TransformNEON(columns, vld1q_f32(&rightMat.Tx)));
+
+	return result;
+
+#else
+	return MultiplyReference(*this, rightMat);
+#endif
 }
 
 
@@ -226,13 +338,161 @@ Vector4 Matrix44::TransformVector(const Vector3& vector) const
 // Transforms the given Vector4 by this matrix
 //
 Vector4 Matrix44::Transform(const Vector4& vector) const
+{
+#if defined(MATRIX44_SIMD_SSE)
+	__m128 columns[4];
+	LoadColumnsSSE(*this, columns);
+
+	Vector4 result;
+	_mm_storeu_ps(&result.x, TransformSSE(columns, _mm_loadu_ps(&vector.x)));
+
+	return result;
+
+#elif defined(MATRIX44_SIMD_NEON)
+	float32x4_t columns[4];
+	LoadColumnsNEON(*this, columns);
+
+	Vector4 result;
+	vst1q_f32(&result.x, TransformNEON(columns, vld1q_f32(&vector.x)));
+
+	return result;
+
+#else
+	return TransformReference(*this, vector);
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Transforms each point by this matrix (w = 1), keeping the xyz of the results
+//
+void Matrix44::TransformPoints(const Vector3* points, int count, Vector3* out_points) const
+{
+#if defined(MATRIX44_SIMD_SSE)
+	__m128 columns[4];
+	LoadColumnsSSE(*this, columns);
+
+	// Vector3s are 12 bytes, so the components are loaded one at a time rather than reading past the last one
+	for (int pointIndex = 0; pointIndex < count; ++pointIndex)
+	{
+		const Vector3& point = points[pointIndex];
+
+		__m128 xy = _mm_add_ps(_mm_mul_ps(columns[0], _mm_set1_ps(point.x)), _mm_mul_ps(columns[1], _mm_set1_ps(point.y)));
+		__m128 zw = _mm_add_ps(_mm_mul_ps(columns[2], _mm_set1_ps(point.z)), columns[3]);
+
+		StoreVector3SSE(_mm_add_ps(xy, zw), out_points[pointIndex]);
+	}
+
+#elif defined(MATRIX44_SIMD_NEON)
+	float32x4_t columns[4];
+	LoadColumnsNEON(*this, columns);
+
+	for (int pointIndex = 0; pointIndex < count; ++pointIndex)
+	{
+		const Vector3& point = points[pointIndex];
+
+		float32x4_t result = vmlaq_n_f32(columns[3], columns[0], point.x);
+		result = vmlaq_n_f32(result, columns[1], point.y);
+		result = vmlaq_n_f32(result, columns[2], point.z);
+
+		StoreVector3NEON(result, out_points[pointIndex]);
+	}
+
+#else
+	for (int pointIndex = 0; pointIndex < count; ++pointIndex)
+	{
+		out_points[pointIndex] = TransformPoint(points[pointIndex]).xyz();
+	}
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Transforms each vector by this matrix (w = 0), keeping the xyz of the results
+//
+void Matrix44::TransformVectors(const Vector3* vectors, int count, Vector3* out_vectors) const
+{
+#if defined(MATRIX44_SIMD_SSE)
+	__m128 columns[4];
+	LoadColumnsSSE(*this, columns);
+
+	for (int vectorIndex = 0; vectorIndex < count; ++vectorIndex)
+	{
+		const Vector3& vector = vectors[vectorIndex];
+
+		__m128 xy = _mm_add_ps(_mm_mul_ps(columns[0], _mm_set1_ps(vector.x)), _mm_mul_ps(columns[1], _mm_set1_ps(vector.y)));
+		__m128 result = _mm_add_ps(xy, _mm_mul_ps(columns[2], _mm_set1_ps(vector.z)));
+
+		StoreVector3SSE(result, out_vectors[vectorIndex]);
+	}
+
+#elif defined(MATRIX44_SIMD_NEON)
+	float32x4_t columns[4];
+	LoadColumnsNEON(*this, columns);
+
+	for (int vectorIndex = 0; vectorIndex < count; ++vectorIndex)
+	{
+		const Vector3& vector = vectors[vectorIndex];
+
+		float32x4_t result = vmulq_n_f32(columns[0], vector.x);
+		result = vmlaq_n_f32(result, columns[1], vector.y);
+		result = vmlaq_n_f32(result, columns[2], vector.z);
+
+		StoreVector3NEON(result, out_vectors[vectorIndex]);
+	}
+
+#else
+	for (int vectorIndex = 0; vectorIndex < count; ++vectorIndex)
+	{
+		out_vectors[vectorIndex] = TransformVector(vectors[vectorIndex]).xyz();
+	}
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Transforms each Vector4 by this matrix
+//
+void Matrix44::Transform(const Vector4* vectorsToTransform, int count, Vector4* out_vectors) const
+{
+#if defined(MATRIX44_SIMD_SSE)
+	__m128 columns[4];
+	LoadColumnsSSE(*this, columns);
+
+	for (int vectorIndex = 0; vectorIndex < count; ++vectorIndex)
+	{
+		_mm_storeu_ps(&out_vectors[vectorIndex].x, TransformSSE(columns, _mm_loadu_ps(&vectorsToTransform[vectorIndex].x)));
+	}
+
+#elif defined(MATRIX44_SIMD_NEON)
+	float32x4_t columns[4];
+	LoadColumnsNEON(*this, columns);
+
+	for (int vectorIndex = 0; vectorIndex < count; ++vectorIndex)
+	{
+		vst1q_f32(&out_vectors[vectorIndex].x, TransformNEON(columns, vld1q_f32(&vectorsToTransform[vectorIndex].x)));
+	}
+
+#else
+	for (int vectorIndex = 0; vectorIndex < count; ++vectorIndex)
+	{
+		out_vectors[vectorIndex] = TransformReference(*this, vectorsToTransform[vectorIndex]);
+	}
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Scalar version of Transform(), one dot product per row
+//
+Vector4 Matrix44::TransformReference(const Matrix44& matrix, const Vector4& vector)
 {
 	Vector4 result;
 
-	result.x = DotProduct(GetXVector(), vector);
-	result.y = DotProduct(GetYVector(), vector);
-	result.z = DotProduct(GetZVector(), vector);
-	result.w = DotProduct(GetWVector(), vector);
+	result.x = DotProduct(matrix.GetXVector(), vector);
+	result.y = DotProduct(matrix.GetYVector(), vector);
+	result.z = DotProduct(matrix.GetZVector(), vector);
+	result.w = DotProduct(matrix.GetWVector(), vector);
 
 	return result;
 }
@@ -298,32 +558,42 @@ void Matrix44::SetValues(const float* sixteenValuesBasisMajor)
 //
 void Matrix44::Append(const Matrix44& matrixToAppend)
 {
-	// Copy old values for calculation
-	Matrix44 oldValues = *this;
+	(*this) = (*this) * matrixToAppend;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Scalar version of operator*, one dot product per element
+//
+Matrix44 Matrix44::MultiplyReference(const Matrix44& leftMat, const Matrix44& rightMat)
+{
+	Matrix44 result;
 
 	// New I basis vector
-	Ix = DotProduct(oldValues.GetXVector(), matrixToAppend.GetIVector());
-	Iy = DotProduct(oldValues.GetYVector(), matrixToAppend.GetIVector());
-	Iz = DotProduct(oldValues.GetZVector(), matrixToAppend.GetIVector());
-	Iw = DotProduct(oldValues.GetWVector(), matrixToAppend.GetIVector());
+	result.Ix = DotProduct(leftMat.GetXVector(), rightMat.GetIVector());
+	result.Iy = DotProduct(leftMat.GetYVector(), rightMat.GetIVector());
+	result.Iz = DotProduct(leftMat.GetZVector(), rightMat.GetIVector());
+	result.Iw = DotProduct(leftMat.GetWVector(), rightMat.GetIVector());
 
 	// New J basis vector
-	Jx = DotProduct(oldValues.GetXVector(), matrixToAppend.GetJVector());
-	Jy = DotProduct(oldValues.GetYVector(), matrixToAppend.GetJVector());
-	Jz = DotProduct(oldValues.GetZVector(), matrixToAppend.GetJVector());
-	Jw = DotProduct(oldValues.GetWVector(), matrixToAppend.GetJVector());
+	result.Jx = DotProduct(leftMat.GetXVector(), rightMat.GetJVector());
+	result.Jy = DotProduct(leftMat.GetYVector(), rightMat.GetJVector());
+	result.Jz = DotProduct(leftMat.GetZVector(), rightMat.GetJVector());
+	result.Jw = DotProduct(leftMat.GetWVector(), rightMat.GetJVector());
 
 	// New K basis vector
-	Kx = DotProduct(oldValues.GetXVector(), matrixToAppend.GetKVector());
-	Ky = DotProduct(oldValues.GetYVector(), matrixToAppend.GetKVector());
-	Kz = DotProduct(oldValues.GetZVector(), matrixToAppend.GetKVector());
-	Kw = DotProduct(oldValues.GetWVector(), matrixToAppend.GetKVector());
+	result.Kx = DotProduct(leftMat.GetXVector(), rightMat.GetKVector());
+	result.Ky = DotProduct(leftMat.GetYVector(), rightMat.GetKVector());
+	result.Kz = DotProduct(leftMat.GetZVector(), rightMat.GetKVector());
+	result.Kw = DotProduct(leftMat.GetWVector(), rightMat.GetKVector());
 
 	// New T basis vector
-	Tx = DotProduct(oldValues.GetXVector(), matrixToAppend.GetTVector());
-	Ty = DotProduct(oldValues.GetYVector(), matrixToAppend.GetTVector());
-	Tz = DotProduct(oldValues.GetZVector(), matrixToAppend.GetTVector());
-	Tw = DotProduct(oldValues.GetWVector(), matrixToAppend.GetTVector());
+	result.Tx = DotProduct(leftMat.GetXVector(), rightMat.GetTVector());
+	result.Ty = DotProduct(leftMat.GetYVector(), rightMat.GetTVector());
+	result.Tz = DotProduct(leftMat.GetZVector(), rightMat.GetTVector());
+	result.Tw = DotProduct(leftMat.GetWVector(), rightMat.GetTVector());
+
+	return result;
 }
 
 
@@ -363,6 +633,15 @@ void Matrix44::Invert()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Inverts the matrix, which must only rotate, scale and translate
+//
+void Matrix44::InvertAffine()
+{
+	(*this) = Matrix44::GetInverseAffine(*this);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the I vector of the matrix
 //
@@ -489,6 +768,24 @@ Matrix44 Matrix44::MakeModelMatrix(const Vector3& translation, const Vector3& ro
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Constructs the model matrix straight from the rotation's basis vectors, scaled, without any concatenation
+//
+Matrix44 Matrix44::MakeModelMatrix(const Vector3& translation, const Quaternion& rotation, const Vector3& scale)
+{
+	float const s = rotation.s;
+	float const x = rotation.v.x;
+	float const y = rotation.v.y;
+	float const z = rotation.v.z;
+
+	Vector3 iBasis = Vector3(1.0f - 2.0f * (y * y + z * z),	2.0f * (x * y + s * z),			2.0f * (x * z - s * y));
+	Vector3 jBasis = Vector3(2.0f * (x * y - s * z),			1.0f - 2.0f * (x * x + z * z),	2.0f * (y * z + s * x));
+	Vector3 kBasis = Vector3(2.0f * (x * z + s * y),			2.0f * (y * z - s * x),			1.0f - 2.0f * (x * x + y * y));
+
+	return Matrix44(iBasis * scale.x, jBasis * scale.y, kBasis * scale.z, translation);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Constructs an orthographic matrix give the axis bounds
 //
@@ -569,10 +866,209 @@ Vector3 Matrix44::ExtractScale(const Matrix44& scaleMatrix)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Splits the matrix into translation, rotation and scale; the rotation is recovered from the
+// normalized basis vectors with the largest of (s, x, y, z) solved first, so it stays precise
+//
+void Matrix44::DecomposeModelMatrix(const Matrix44& modelMatrix, Vector3& out_translation, Quaternion& out_rotation, Vector3& out_scale)
+{
+	Vector3 iBasis = modelMatrix.GetIVector().xyz();
+	Vector3 jBasis = modelMatrix.GetJVector().xyz();
+	Vector3 kBasis = modelMatrix.GetKVector().xyz();
+
+	out_translation = modelMatrix.GetTVector().xyz();
+	out_scale = Vector3(iBasis.GetLength(), jBasis.GetLength(), kBasis.GetLength());
+
+	// A mirror can't be a rotation, so keep it in the scale
+	if (DotProduct(CrossProduct(iBasis, jBasis), kBasis) < 0.f)
+	{
+		out_scale.x = -out_scale.x;
+	}
+
+	if (out_scale.x == 0.f || out_scale.y == 0.f || out_scale.z == 0.f)
+	{
+		out_rotation = Quaternion::IDENTITY;
+		return;
+	}
+
+	iBasis /= out_scale.x;
+	jBasis /= out_scale.y;
+	kBasis /= out_scale.z;
+
+	float trace = iBasis.x + jBasis.y + kBasis.z;
+
+	if (trace > 0.f)
+	{
+		float scalar = sqrtf(trace + 1.0f) * 2.0f;
+		out_rotation = Quaternion(0.25f * scalar, (jBasis.z - kBasis.y) / scalar, (kBasis.x - iBasis.z) / scalar, (iBasis.y - jBasis.x) / scalar);
+	}
+	else if (iBasis.x > jBasis.y && iBasis.x > kBasis.z)
+	{
+		float scalar = sqrtf(1.0f + iBasis.x - jBasis.y - kBasis.z) * 2.0f;
+		out_rotation = Quaternion((jBasis.z - kBasis.y) / scalar, 0.25f * scalar, (jBasis.x + iBasis.y) / scalar, (kBasis.x + iBasis.z) / scalar);
+	}
+	else if (jBasis.y > kBasis.z)
+	{
+		float scalar = sqrtf(1.0f + jBasis.y - iBasis.x - kBasis.z) * 2.0f;
+		out_rotation = Quaternion((kBasis.x - iBasis.z) / scalar, (jBasis.x + iBasis.y) / scalar, 0.25f * scalar, (kBasis.y + jBasis.z) / scalar);
+	}
+	else
+	{
+		float scalar = sqrtf(1.0f + kBasis.z - iBasis.x - jBasis.y) * 2.0f;
+		out_rotation = Quaternion((iBasis.y - jBasis.x) / scalar, (kBasis.x + iBasis.z) / scalar, (kBasis.y + jBasis.z) / scalar, 0.25f * scalar);
+	}
+
+	out_rotation.Normalize();
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the inverse of the given matrix
 //
 Matrix44 Matrix44::GetInverse(const Matrix44& matrix)
+{
+#if defined(MATRIX44_SIMD_SSE)
+	// Block inverse of [A B; C D], with the 2x2 blocks from the basis vectors; since the inverse of a
+	// transpose is the transpose of the inverse, the basis vectors can be treated as rows throughout
+	__m128 rows[4];
+	LoadColumnsSSE(matrix, rows);
+
+	__m128 A = _mm_movelh_ps(rows[0], rows[1]);
+	__m128 B = _mm_movehl_ps(rows[1], rows[0]);
+	__m128 C = _mm_movelh_ps(rows[2], rows[3]);
+	__m128 D = _mm_movehl_ps(rows[3], rows[2]);
+
+	// Determinants of each block as (|A|, |B|, |C|, |D|)
+	__m128 blockDeterminants = _mm_sub_ps(
+		_mm_mul_ps(SSE_SHUFFLE2(rows[0], rows[2], 0, 2, 0, 2), SSE_SHUFFLE2(rows[1], rows[3], 1, 3, 1, 3)),
+		_mm_mul_ps(SSE_SHUFFLE2(rows[0], rows[2], 1, 3, 1, 3), SSE_SHUFFLE2(rows[1], rows[3], 0, 2, 0, 2)));
+
+	__m128 detA = SSE_SPLAT(blockDeterminants, 0);
+	__m128 detB = SSE_SPLAT(blockDeterminants, 1);
+	__m128 detC = SSE_SPLAT(blockDeterminants, 2);
+	__m128 detD = SSE_SPLAT(blockDeterminants, 3);
+
+	__m128 adjugateDxC = Matrix22AdjugateMultiplySSE(D, C);
+	__m128 adjugateAxB = Matrix22AdjugateMultiplySSE(A, B);
+
+	// The inverse is [X Y; Z W] / |M|, built here as the adjugates of each block
+	__m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), Matrix22MultiplySSE(B, adjugateDxC));
+	__m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), Matrix22MultiplySSE(C, adjugateAxB));
+	__m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), Matrix22MultiplyAdjugateSSE(D, adjugateAxB));
+	__m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), Matrix22MultiplyAdjugateSSE(A, adjugateDxC));
+
+	// |M| = |A||D| + |B||C| - trace((A#B)(D#C))
+	__m128 trace = HorizontalSumSSE(_mm_mul_ps(adjugateAxB, SSE_SHUFFLE(adjugateDxC, 0, 2, 1, 3)));
+	__m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+
+	// The adjugate's signs are folded into the reciprocal
+	__m128 signedInverseDet = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), det);
+
+	X = _mm_mul_ps(X, signedInverseDet);
+	Y = _mm_mul_ps(Y, signedInverseDet);
+	Z = _mm_mul_ps(Z, signedInverseDet);
+	W = _mm_mul_ps(W, signedInverseDet);
+
+	// Taking each block's adjugate and putting the blocks back into rows in one shuffle
+	Matrix44 inverse;
+	_mm_storeu_ps(&inverse.Ix, SSE_SHUFFLE2(X, Y, 3, 1, 3, 1));
+	_mm_storeu_ps(&inverse.Jx, SSE_SHUFFLE2(X, Y, 2, 0, 2, 0));
+	_mm_storeu_ps(&inverse.Kx, SSE_SHUFFLE2(Z, W, 3, 1, 3, 1));
+	_mm_storeu_ps(&inverse.Tx, SSE_SHUFFLE2(Z, W, 2, 0, 2, 0));
+
+	return inverse;
+
+#else
+	// No NEON version yet, the scalar one is fast enough for where general inverses are used
+	return GetInverseReference(matrix);
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the inverse of the matrix, which must only rotate, scale and translate
+// The 3x3 part is inverted with cross products, and the translation is undone with it
+//
+Matrix44 Matrix44::GetInverseAffine(const Matrix44& matrix)
+{
+#if defined(MATRIX44_SIMD_SSE)
+	__m128 columns[4];
+	LoadColumnsSSE(matrix, columns);
+
+	// Rows of the inverted 3x3, before dividing by the determinant
+	__m128 row0 = CrossProductSSE(columns[1], columns[2]);
+	__m128 row1 = CrossProductSSE(columns[2], columns[0]);
+	__m128 row2 = CrossProductSSE(columns[0], columns[1]);
+	__m128 row3 = _mm_setzero_ps();
+
+	__m128 inverseDet = _mm_div_ps(_mm_set1_ps(1.f), HorizontalSumSSE(_mm_mul_ps(columns[0], row0)));
+
+	row0 = _mm_mul_ps(row0, inverseDet);
+	row1 = _mm_mul_ps(row1, inverseDet);
+	row2 = _mm_mul_ps(row2, inverseDet);
+
+	// Now the inverse's basis vectors, with w = 0
+	_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+	__m128 translation = columns[3];
+	__m128 rotatedTranslation = _mm_add_ps(_mm_add_ps(_mm_mul_ps(row0, SSE_SPLAT(translation, 0)), _mm_mul_ps(row1, SSE_SPLAT(translation, 1))), _mm_mul_ps(row2, SSE_SPLAT(translation, 2)));
+
+	Matrix44 inverse;
+	_mm_storeu_ps(&inverse.Ix, row0);
+	_mm_storeu_ps(&inverse.Jx, row1);
+	_mm_storeu_ps(&inverse.Kx, row2);
+	_mm_storeu_ps(&inverse.Tx, _mm_sub_ps(_mm_setr_ps(0.f, 0.f, 0.f, 1.f), rotatedTranslation));
+
+	return inverse;
+
+#else
+	return GetInverseAffineReference(matrix);
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Scalar version of GetInverseAffine()
+//
+Matrix44 Matrix44::GetInverseAffineReference(const Matrix44& matrix)
+{
+	Vector3 iBasis = Vector3(matrix.Ix, matrix.Iy, matrix.Iz);
+	Vector3 jBasis = Vector3(matrix.Jx, matrix.Jy, matrix.Jz);
+	Vector3 kBasis = Vector3(matrix.Kx, matrix.Ky, matrix.Kz);
+	Vector3 translation = Vector3(matrix.Tx, matrix.Ty, matrix.Tz);
+
+	float inverseDet = 1.f / DotProduct(iBasis, CrossProduct(jBasis, kBasis));
+
+	Vector3 row0 = CrossProduct(jBasis, kBasis) * inverseDet;
+	Vector3 row1 = CrossProduct(kBasis, iBasis) * inverseDet;
+	Vector3 row2 = CrossProduct(iBasis, jBasis) * inverseDet;
+
+	Matrix44 inverse;
+
+	inverse.Ix = row0.x;
+	inverse.Iy = row1.x;
+	inverse.Iz = row2.x;
+
+	inverse.Jx = row0.y;
+	inverse.Jy = row1.y;
+	inverse.Jz = row2.y;
+
+	inverse.Kx = row0.z;
+	inverse.Ky = row1.z;
+	inverse.Kz = row2.z;
+
+	inverse.Tx = -DotProduct(row0, translation);
+	inverse.Ty = -DotProduct(row1, translation);
+	inverse.Tz = -DotProduct(row2, translation);
+
+	return inverse;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Scalar version of GetInverse(), in doubles
+//
+Matrix44 Matrix44::GetInverseReference(const Matrix44& matrix)
 {
 	double inv[16];
 	double det;
@@ -743,6 +1239,32 @@ Matrix44 Matrix44::GetInverse() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the inverse of the matrix, which must only rotate, scale and translate
+//
+Matrix44 Matrix44::GetInverseAffine() const
+{
+	return Matrix44::GetInverseAffine(*this);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the name of the kernels this build uses
+//
+const char* Matrix44::GetSIMDPathName()
+{
+#if defined(MATRIX44_SIMD_AVX)
+	return "AVX";
+#elif defined(MATRIX44_SIMD_SSE)
+	return "SSE";
+#elif defined(MATRIX44_SIMD_NEON)
+	return "NEON";
+#else
+	return "Scalar";
+#endif
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Interpolates between the two matrices and returns the result
 //
@@ -813,7 +1335,6 @@ Matrix44 Matrix44::MakeRotation(const Vector3& rotation)
 }
 
 
-
 //-----------------------------------------------------------------------------------------------
 // Constructs a rotation matrix from the given quaternion and returns it
 // ONLY WORKS WITH Y-UP LEFT HANDED SYSTEM
@@ -18,10 +18,10 @@ public:
 	//-----Public Methods-----
 
 	// Constructors
-	Matrix44(); // default-construct to Identity matrix (via variable initialization), for speed
-	explicit Matrix44(const float* sixteenValuesBasisMajor); // float[16] array in order Ix, Iy...
-	explicit Matrix44(const Vector3& iBasis, const Vector3& jBasis, const Vector3& kBasis, const Vector3& translation=Vector3::ZERO);
-	explicit Matrix44(const Vector4& iBasis, const Vector4& jBasis, const Vector4& kBasis, const Vector4& translation=Vector4::ZERO);
+	constexpr Matrix44(); // default-construct to Identity matrix (via variable initialization), for speed
+	constexpr explicit Matrix44(const float* sixteenValuesBasisMajor); // float[16] array in order Ix, Iy...
+	constexpr explicit Matrix44(const Vector3& iBasis, const Vector3& jBasis, const Vector3& kBasis, const Vector3& translation=Vector3::ZERO);
+	constexpr explicit Matrix44(const Vector4& iBasis, const Vector4& jBasis, const Vector4& kBasis, const Vector4& translation=Vector4::ZERO);
 
 	// Operators
 	const Matrix44	operator*(const Matrix44& rightMat) const;			
@@ -38,6 +38,12 @@ public:
 
 	Vector4 Transform(const Vector4& vectorToTransform) const;
 
+	// Batch transforms, for many points or vectors under one matrix; the results can't overlap the inputs
+	// The Vector3 versions drop the transformed w, so are for affine matrices
+	void	TransformPoints(const Vector3* points, int count, Vector3* out_points) const;
+	void	TransformVectors(const Vector3* vectors, int count, Vector3* out_vectors) const;
+	void	Transform(const Vector4* vectorsToTransform, int count, Vector4* out_vectors) const;
+
 	// Mutators
 	void SetIdentity();
 	void SetValues(const float* sixteenValuesBasisMajor);		// float[16] array in order Ix, Iy...
@@ -45,6 +51,7 @@ public:
 	void Append(const Matrix44& matrixToAppend);				// Concatenate on the right	
 	void Transpose();
 	void Invert();
+	void InvertAffine();										// Only for matrices with (Iw, Jw, Kw, Tw) = (0, 0, 0, 1)
 
 	// Accessor helpers
 	Vector4 GetIVector() const;
@@ -58,6 +65,7 @@ public:
 	Vector4 GetWVector() const;
 
 	Matrix44 GetInverse() const;
+	Matrix44 GetInverseAffine() const;
 
 	//--Static Producers--
 
@@ -69,6 +77,7 @@ public:
 	static Matrix44 MakeScaleUniform(float uniformScale);
 
 	static Matrix44 MakeModelMatrix(const Vector3& translation, const Vector3& rotation, const Vector3& scale);
+	static Matrix44 MakeModelMatrix(const Vector3& translation, const Quaternion& rotation, const Vector3& scale);	// Any coordinate system, unlike MakeRotation(Quaternion)
 
 	// Projection
 	static Matrix44 MakeOrtho(float leftX, float rightX, float bottomY, float topY, float nearZ, float farZ);
@@ -83,7 +92,19 @@ public:
 	static Vector3 ExtractRotationDegrees(const Matrix44& rotationMatrix);
 	static Vector3 ExtractScale(const Matrix44& scaleMatrix);
 
+	// Splits a model matrix back into the parts MakeModelMatrix() takes; a mirrored matrix comes back with a negative x scale
+	static void DecomposeModelMatrix(const Matrix44& modelMatrix, Vector3& out_translation, Quaternion& out_rotation, Vector3& out_scale);
+
 	static Matrix44 GetInverse(const Matrix44& matrix);
+	static Matrix44 GetInverseAffine(const Matrix44& matrix);	// Rotation, scale and translation only, much cheaper than GetInverse()
+
+	// Scalar versions of the SIMD kernels above, kept as the reference they're checked against
+	static Matrix44 MultiplyReference(const Matrix44& leftMat, const Matrix44& rightMat);
+	static Vector4	TransformReference(const Matrix44& matrix, const Vector4& vectorToTransform);
+	static Matrix44 GetInverseReference(const Matrix44& matrix);
+	static Matrix44 GetInverseAffineReference(const Matrix44& matrix);
+
+	static const char* GetSIMDPathName();						// The kernels this build was compiled with, "AVX", "SSE", "NEON" or "Scalar"
 
 
 public:
@@ -120,4 +141,96 @@ public:
 	const static Matrix44 IDENTITY;
 };
 
+
+///////////////////////////////////////////////////////////////////////////////
+// Constexpr definitions - in the header so constants and tables built from
+// them are worked out at compile time
+///////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------------------------
+// Default constructor, identity from the member initializers
+//
+constexpr Matrix44::Matrix44()
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor, from a 16-element float array (float[16])
+//
+constexpr Matrix44::Matrix44(const float* sixteenValuesBasisMajor)
+{
+	Ix = sixteenValuesBasisMajor[0];
+	Iy = sixteenValuesBasisMajor[1];
+	Iz = sixteenValuesBasisMajor[2];
+	Iw = sixteenValuesBasisMajor[3];
+
+	Jx = sixteenValuesBasisMajor[4];
+	Jy = sixteenValuesBasisMajor[5];
+	Jz = sixteenValuesBasisMajor[6];
+	Jw = sixteenValuesBasisMajor[7];
+
+	Kx = sixteenValuesBasisMajor[8];
+	Ky = sixteenValuesBasisMajor[9];
+	Kz = sixteenValuesBasisMajor[10];
+	Kw = sixteenValuesBasisMajor[11];
+
+	Tx = sixteenValuesBasisMajor[12];
+	Ty = sixteenValuesBasisMajor[13];
+	Tz = sixteenValuesBasisMajor[14];
+	Tw = sixteenValuesBasisMajor[15];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor, from the explicit I, J, K basis vectors and T translation vector
+//
+constexpr Matrix44::Matrix44(const Vector3& iBasis, const Vector3& jBasis, const Vector3& kBasis, const Vector3& translation/*=Vector3::ZERO*/)
+	: Matrix44()
+{
+	Ix = iBasis.x;
+	Iy = iBasis.y;
+	Iz = iBasis.z;
+
+	Jx = jBasis.x;
+	Jy = jBasis.y;
+	Jz = jBasis.z;
+
+	Kx = kBasis.x;
+	Ky = kBasis.y;
+	Kz = kBasis.z;
+
+	Tx = translation.x;
+	Ty = translation.y;
+	Tz = translation.z;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor from Vector4 column vectors
+//
+constexpr Matrix44::Matrix44(const Vector4& iBasis, const Vector4& jBasis, const Vector4& kBasis, const Vector4& translation/*=Vector3::ZERO*/)
+{
+	Ix = iBasis.x;
+	Iy = iBasis.y;
+	Iz = iBasis.z;
+	Iw = iBasis.w;
+
+	Jx = jBasis.x;
+	Jy = jBasis.y;
+	Jz = jBasis.z;
+	Jw = jBasis.w;
+
+	Kx = kBasis.x;
+	Ky = kBasis.y;
+	Kz = kBasis.z;
+	Kw = kBasis.w;
+
+	Tx = translation.x;
+	Ty = translation.y;
+	Tz = translation.z;
+	Tw = translation.w;
+}
+
+
 Matrix44 Interpolate(const Matrix44& start, const Matrix44& end, float fractionTowardEnd);
@@ -5,13 +5,143 @@
 /* Description: Implementation of the Quaternion class
 /************************************************************************/
 #include <math.h>
+#include "Game/Framework/EngineBuildPreferences.hpp"
 #include "Engine/Math/Matrix44.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/Quaternion.hpp"
 
+// The batch kernels use the same compile time switch as the Matrix44 ones
+#if !defined(MATRIX44_FORCE_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define QUATERNION_SIMD_SSE
+#include <emmintrin.h>
+#endif
+
 // Constants
 const Quaternion Quaternion::IDENTITY = Quaternion();
 
+// (s, x, y, z) are 16 contiguous bytes, so a quaternion loads as one register
+static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Quaternion isn't 4 packed floats, the batch kernels need updating");
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the fraction to nlerp by so the result moves at the speed slerp would, given the absolute
+// cosine of the angle between the quaternions; the polynomial fit is exact at 0, 0.5 and 1
+//
+static inline float GetSlerpCorrectedFraction(float absCosAngle, float fractionTowardEnd)
+{
+	float t = fractionTowardEnd;
+	float d = absCosAngle;
+
+	float a = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+	float b = 0.848013f + d * (-1.06021f + d * 0.215638f);
+	float k = a * (t - 0.5f) * (t - 0.5f) + b;
+
+	return t + t * (t - 0.5f) * (t - 1.0f) * k;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Lerps start toward end (flipped onto start's side) by the fraction and normalizes the result
+//
+static inline Quaternion NlerpWithFraction(const Quaternion& start, const Quaternion& end, float cosAngle, float fractionTowardEnd)
+{
+	float endSign = (cosAngle < 0.f ? -1.0f : 1.0f);
+	float startFraction = 1.0f - fractionTowardEnd;
+	float endFraction = endSign * fractionTowardEnd;
+
+	Quaternion result = Quaternion(startFraction * start.s + endFraction * end.s, startFraction * start.v + endFraction * end.v);
+	result.Normalize();
+
+	return result;
+}
+
+
+#if defined(QUATERNION_SIMD_SSE)
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Blends four quaternions at once, transposed so each register holds one component of all four
+//
+static inline void BlendFourSSE(const Quaternion* starts, const Quaternion* ends, __m128 fraction, bool correctForSlerp, Quaternion* out_results)
+{
+	__m128 startS = _mm_loadu_ps(&starts[0].s);
+	__m128 startX = _mm_loadu_ps(&starts[1].s);
+	__m128 startY = _mm_loadu_ps(&starts[2].s);
+	__m128 startZ = _mm_loadu_ps(&starts[3].s);
+	_MM_TRANSPOSE4_PS(startS, startX, startY, startZ);
+
+	__m128 endS = _mm_loadu_ps(&ends[0].s);
+	__m128 endX = _mm_loadu_ps(&ends[1].s);
+	__m128 endY = _mm_loadu_ps(&ends[2].s);
+	__m128 endZ = _mm_loadu_ps(&ends[3].s);
+	_MM_TRANSPOSE4_PS(endS, endX, endY, endZ);
+
+	__m128 cosAngle = _mm_add_ps(_mm_add_ps(_mm_mul_ps(startS, endS), _mm_mul_ps(startX, endX)), _mm_add_ps(_mm_mul_ps(startY, endY), _mm_mul_ps(startZ, endZ)));
+
+	// Take the shorter arc by flipping end onto start's side, done by moving the dot's sign bit onto it
+	__m128 signMask = _mm_set1_ps(-0.f);
+	__m128 endSign = _mm_and_ps(cosAngle, signMask);
+	endS = _mm_xor_ps(endS, endSign);
+	endX = _mm_xor_ps(endX, endSign);
+	endY = _mm_xor_ps(endY, endSign);
+	endZ = _mm_xor_ps(endZ, endSign);
+
+	if (correctForSlerp)
+	{
+		__m128 d = _mm_andnot_ps(signMask, cosAngle);
+		__m128 a = _mm_add_ps(_mm_set1_ps(1.0904f), _mm_mul_ps(d, _mm_add_ps(_mm_set1_ps(-3.2452f), _mm_mul_ps(d, _mm_sub_ps(_mm_set1_ps(3.55645f), _mm_mul_ps(d, _mm_set1_ps(1.43519f)))))));
+		__m128 b = _mm_add_ps(_mm_set1_ps(0.848013f), _mm_mul_ps(d, _mm_add_ps(_mm_set1_ps(-1.06021f), _mm_mul_ps(d, _mm_set1_ps(0.215638f)))));
+
+		__m128 centered = _mm_sub_ps(fraction, _mm_set1_ps(0.5f));
+		__m128 k = _mm_add_ps(_mm_mul_ps(a, _mm_mul_ps(centered, centered)), b);
+		__m128 cubic = _mm_mul_ps(_mm_mul_ps(fraction, centered), _mm_sub_ps(fraction, _mm_set1_ps(1.0f)));
+
+		fraction = _mm_add_ps(fraction, _mm_mul_ps(cubic, k));
+	}
+
+	__m128 resultS = _mm_add_ps(startS, _mm_mul_ps(_mm_sub_ps(endS, startS), fraction));
+	__m128 resultX = _mm_add_ps(startX, _mm_mul_ps(_mm_sub_ps(endX, startX), fraction));
+	__m128 resultY = _mm_add_ps(startY, _mm_mul_ps(_mm_sub_ps(endY, startY), fraction));
+	__m128 resultZ = _mm_add_ps(startZ, _mm_mul_ps(_mm_sub_ps(endZ, startZ), fraction));
+
+	// Full precision divide rather than _mm_rsqrt_ps(), ~12 bits isn't enough once errors build up down a skeleton
+	__m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(resultS, resultS), _mm_mul_ps(resultX, resultX)), _mm_add_ps(_mm_mul_ps(resultY, resultY), _mm_mul_ps(resultZ, resultZ)));
+	__m128 inverseLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSquared));
+
+	resultS = _mm_mul_ps(resultS, inverseLength);
+	resultX = _mm_mul_ps(resultX, inverseLength);
+	resultY = _mm_mul_ps(resultY, inverseLength);
+	resultZ = _mm_mul_ps(resultZ, inverseLength);
+
+	_MM_TRANSPOSE4_PS(resultS, resultX, resultY, resultZ);
+	_mm_storeu_ps(&out_results[0].s, resultS);
+	_mm_storeu_ps(&out_results[1].s, resultX);
+	_mm_storeu_ps(&out_results[2].s, resultY);
+	_mm_storeu_ps(&out_results[3].s, resultZ);
+}
+#endif
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Runs the batch blend, four at a time with SIMD and the remainder one at a time
+//
+static void BlendArray(const Quaternion* starts, const Quaternion* ends, int count, float fractionTowardEnd, bool correctForSlerp, Quaternion* out_results)
+{
+	int index = 0;
+
+#if defined(QUATERNION_SIMD_SSE)
+	__m128 fraction = _mm_set1_ps(fractionTowardEnd);
+
+	for (; index + 4 <= count; index += 4)
+	{
+		BlendFourSSE(&starts[index], &ends[index], fraction, correctForSlerp, &out_results[index]);
+	}
+#endif
+
+	for (; index < count; ++index)
+	{
+		out_results[index] = (correctForSlerp ? Quaternion::FastSlerp(starts[index], ends[index], fractionTowardEnd) : Quaternion::Nlerp(starts[index], ends[index], fractionTowardEnd));
+	}
+}
+
 
 //-----------------------------------------------------------------------------------------------
 // Constructor
@@ -367,6 +497,45 @@ Quaternion Quaternion::Slerp(const Quaternion& a, const Quaternion& b, float fra
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Linearly interpolates from start to end along the shorter arc and normalizes the result
+//
+Quaternion Quaternion::Nlerp(const Quaternion& start, const Quaternion& end, float fractionTowardEnd)
+{
+	return NlerpWithFraction(start, end, DotProduct(start, end), fractionTowardEnd);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Approximates Slerp() with an nlerp by a corrected fraction, avoiding the trig
+//
+Quaternion Quaternion::FastSlerp(const Quaternion& start, const Quaternion& end, float fractionTowardEnd)
+{
+	float cosAngle = DotProduct(start, end);
+	float correctedFraction = GetSlerpCorrectedFraction(fabsf(cosAngle), fractionTowardEnd);
+
+	return NlerpWithFraction(start, end, cosAngle, correctedFraction);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Nlerps each pair of quaternions by the same fraction into out_results
+//
+void Quaternion::NlerpArray(const Quaternion* starts, const Quaternion* ends, int count, float fractionTowardEnd, Quaternion* out_results)
+{
+	BlendArray(starts, ends, count, fractionTowardEnd, false, out_results);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// FastSlerps each pair of quaternions by the same fraction into out_results
+//
+void Quaternion::FastSlerpArray(const Quaternion* starts, const Quaternion* ends, int count, float fractionTowardEnd, Quaternion* out_results)
+{
+	BlendArray(starts, ends, count, fractionTowardEnd, true, out_results);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the conjugate of this quaternion
 //
@@ -4,6 +4,7 @@
 /* Date: June 12th, 2018
 /* Description: Class to represent a Quaternion rotation
 /************************************************************************/
+#pragma once
 #include "Engine/Math/Vector3.hpp"
 
 class Quaternion
@@ -50,6 +51,16 @@ public:
 	static Quaternion Lerp(const Quaternion& a, const Quaternion& b, float fractionTowardEnd);
 	static Quaternion Slerp(const Quaternion& start, const Quaternion& end, float fractionTowardEnd);
 
+	// Normalized lerp down the shorter arc - the same path as Slerp() but not at a constant speed
+	static Quaternion Nlerp(const Quaternion& start, const Quaternion& end, float fractionTowardEnd);
+
+	// Nlerp() with the fraction bent by a fitted polynomial to match Slerp()'s speed, no trig; off from Slerp() by ~1e-3 at most
+	static Quaternion FastSlerp(const Quaternion& start, const Quaternion& end, float fractionTowardEnd);
+
+	// Batch versions for blending whole poses, SIMD four at a time where supported; the results may alias either input
+	static void NlerpArray(const Quaternion* starts, const Quaternion* ends, int count, float fractionTowardEnd, Quaternion* out_results);
+	static void FastSlerpArray(const Quaternion* starts, const Quaternion* ends, int count, float fractionTowardEnd, Quaternion* out_results);
+
 
 public:
 	//-----Public Data-----
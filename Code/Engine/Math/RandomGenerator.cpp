@@ -0,0 +1,251 @@
+/************************************************************************/
+/* File: RandomGenerator.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the RandomGenerator class
+/************************************************************************/
+#include <math.h>
+#include <atomic>
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/Time/Time.hpp"
+#include "Engine/Math/RandomGenerator.hpp"
+
+#define PCG_MULTIPLIER (6364136223846793005ULL)
+
+// Generators seeded from the clock are also offset by this, so two made in the same tick still differ
+static std::atomic<uint64_t>	s_unseededCount(0);
+
+// Threads take the next stream the first time they use their default
+static std::atomic<uint64_t>	s_nextThreadStream(RANDOM_GENERATOR_DEFAULT_STREAM + 1);
+
+static std::atomic<bool>		s_hasDefaultSeed(false);
+static std::atomic<uint64_t>	s_defaultSeed(0);
+
+
+//-----------------------------------------------------------------------------------------------
+// Default constructor, seeds from the performance counter
+//
+RandomGenerator::RandomGenerator()
+{
+	uint64_t count = s_unseededCount++;
+	Seed(GetPerformanceCounter() ^ (count * 0x9E3779B97F4A7C15ULL), count);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor, for a reproducible sequence
+//
+RandomGenerator::RandomGenerator(uint64_t seed, uint64_t stream /*= 0*/)
+{
+	Seed(seed, stream);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Restarts the generator; each stream is a different sequence for the same seed
+//
+void RandomGenerator::Seed(uint64_t seed, uint64_t stream /*= 0*/)
+{
+	m_state = 0;
+	m_increment = (stream << 1) | 1;
+
+	GetNextUInt32();
+	m_state += seed;
+	GetNextUInt32();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the next 32 random bits (PCG-XSH-RR)
+//
+uint32_t RandomGenerator::GetNextUInt32()
+{
+	uint64_t oldState = m_state;
+	m_state = oldState * PCG_MULTIPLIER + m_increment;
+
+	uint32_t xorShifted = (uint32_t) (((oldState >> 18u) ^ oldState) >> 27u);
+	uint32_t rotation = (uint32_t) (oldState >> 59u);
+
+	return (xorShifted >> rotation) | (xorShifted << ((0u - rotation) & 31u));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a random float between zero and one, inclusive
+//
+float RandomGenerator::GetFloatZeroToOne()
+{
+	// The top 24 bits, all a float holds exactly
+	return (float) (GetNextUInt32() >> 8) * (1.f / 16777215.f);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a random float between minInclusive and maxInclusive
+//
+float RandomGenerator::GetFloatInRange(float minInclusive, float maxInclusive)
+{
+	return ((maxInclusive - minInclusive) * GetFloatZeroToOne()) + minInclusive;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a random int between zero (inclusive) and maxExclusive, using Lemire's multiply and
+// rejecting the few values that would make some results more likely than others
+//
+int RandomGenerator::GetIntLessThan(int maxExclusive)
+{
+	if (maxExclusive <= 1)
+	{
+		return 0;
+	}
+
+	uint32_t range = (uint32_t) maxExclusive;
+	uint64_t product = (uint64_t) GetNextUInt32() * range;
+
+	if ((uint32_t) product < range)
+	{
+		uint32_t threshold = (0u - range) % range;
+
+		while ((uint32_t) product < threshold)
+		{
+			product = (uint64_t) GetNextUInt32() * range;
+		}
+	}
+
+	return (int) (product >> 32);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a random int between minInclusive and maxInclusive
+//
+int RandomGenerator::GetIntInRange(int minInclusive, int maxInclusive)
+{
+	return GetIntLessThan(maxInclusive - minInclusive + 1) + minInclusive;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Randomly returns true or false
+//
+bool RandomGenerator::GetTrueOrFalse()
+{
+	return ((GetNextUInt32() & 0x80000000u) != 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true with the given chance, between 0.f and 1.f
+//
+bool RandomGenerator::CheckChance(float chanceForSuccess)
+{
+	if (chanceForSuccess >= 1.f)
+	{
+		return true;
+	}
+	else if (chanceForSuccess <= 0.f)
+	{
+		return false;
+	}
+
+	return (GetFloatZeroToOne() <= chanceForSuccess);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a random unit vector in 2D
+//
+Vector2 RandomGenerator::GetPointOnCircle()
+{
+	float radians = GetFloatZeroToOne() * 2.f * PI;
+	return Vector2(cosf(radians), sinf(radians));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a random unit vector in 3D, uniform over the sphere - picking z uniformly gives equal
+// area bands (Archimedes), where picking two angles would bunch points at the poles
+//
+Vector3 RandomGenerator::GetPointOnSphere()
+{
+	float z = GetFloatInRange(-1.f, 1.f);
+	float radians = GetFloatZeroToOne() * 2.f * PI;
+	float radius = sqrtf(MaxFloat(1.f - z * z, 0.f));
+
+	return Vector3(radius * cosf(radians), radius * sinf(radians), z);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Fills the array with random floats between zero and one
+//
+void RandomGenerator::FillFloatsZeroToOne(float* out_values, int count)
+{
+	for (int index = 0; index < count; ++index)
+	{
+		out_values[index] = GetFloatZeroToOne();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Fills the array with random floats between minInclusive and maxInclusive
+//
+void RandomGenerator::FillFloatsInRange(float* out_values, int count, float minInclusive, float maxInclusive)
+{
+	float range = maxInclusive - minInclusive;
+
+	for (int index = 0; index < count; ++index)
+	{
+		out_values[index] = range * GetFloatZeroToOne() + minInclusive;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Fills the array with random unit vectors
+//
+void RandomGenerator::FillPointsOnSphere(Vector3* out_points, int count)
+{
+	for (int index = 0; index < count; ++index)
+	{
+		out_points[index] = GetPointOnSphere();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the generator for the calling thread, made the first time the thread asks for it
+//
+RandomGenerator& RandomGenerator::GetThreadDefault()
+{
+	static thread_local RandomGenerator s_threadDefault = []()
+	{
+		uint64_t stream = s_nextThreadStream++;
+
+		if (s_hasDefaultSeed)
+		{
+			return RandomGenerator(s_defaultSeed, stream);
+		}
+
+		RandomGenerator generator;
+		generator.Seed(generator.GetNextUInt32() ^ GetPerformanceCounter(), stream);
+
+		return generator;
+	}();
+
+	return s_threadDefault;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Seeds the calling thread's default and the defaults of threads that haven't used theirs yet
+//
+void RandomGenerator::SetDefaultSeed(uint64_t seed)
+{
+	s_defaultSeed = seed;
+	s_hasDefaultSeed = true;
+
+	GetThreadDefault().Seed(seed, RANDOM_GENERATOR_DEFAULT_STREAM);
+}
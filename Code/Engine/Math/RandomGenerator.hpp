@@ -0,0 +1,57 @@
+/************************************************************************/
+/* File: RandomGenerator.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Seedable PCG32 random number generator; the MathUtils
+/*				random functions use a default instance per thread
+/************************************************************************/
+#pragma once
+#include <stdint.h>
+#include "Engine/Math/Vector2.hpp"
+#include "Engine/Math/Vector3.hpp"
+
+// Stream the thread defaults count up from, each thread gets its own so they never share a sequence
+#define RANDOM_GENERATOR_DEFAULT_STREAM (0x5851F42D4C957F2DULL)
+
+
+class RandomGenerator
+{
+public:
+	//-----Public Methods-----
+
+	RandomGenerator();													// Seeded from the clock and a counter, different every time
+	explicit RandomGenerator(uint64_t seed, uint64_t stream = 0);		// Same seed and stream, same sequence
+
+	void		Seed(uint64_t seed, uint64_t stream = 0);
+
+	uint32_t	GetNextUInt32();
+	float		GetFloatZeroToOne();									// Inclusive of both ends
+	float		GetFloatInRange(float minInclusive, float maxInclusive);
+	int			GetIntLessThan(int maxExclusive);						// Unbiased, unlike rand() % max
+	int			GetIntInRange(int minInclusive, int maxInclusive);
+	bool		GetTrueOrFalse();
+	bool		CheckChance(float chanceForSuccess);
+
+	Vector2		GetPointOnCircle();										// Unit vectors, uniformly distributed
+	Vector3		GetPointOnSphere();
+
+	// Batch versions, for filling particle or sample buffers in one call
+	void		FillFloatsZeroToOne(float* out_values, int count);
+	void		FillFloatsInRange(float* out_values, int count, float minInclusive, float maxInclusive);
+	void		FillPointsOnSphere(Vector3* out_points, int count);
+
+	// The calling thread's generator, seeded on first use
+	static RandomGenerator& GetThreadDefault();
+
+	// Reseeds the calling thread's default, and makes threads seed theirs from it (offset by their own stream)
+	// instead of the clock on first use, for reproducing a run; threads already running keep their sequence
+	static void				SetDefaultSeed(uint64_t seed);
+
+
+private:
+	//-----Private Data-----
+
+	uint64_t m_state = 0;
+	uint64_t m_increment = 1;	// Picks the stream, always odd
+
+};
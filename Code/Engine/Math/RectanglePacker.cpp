@@ -0,0 +1,195 @@
+/************************************************************************/
+/* File: RectanglePacker.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the RectanglePacker class
+/************************************************************************/
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RectanglePacker.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+RectanglePacker::RectanglePacker(const IntVector2& dimensions)
+{
+	Reset(dimensions);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Empties the packer, with the new dimensions
+//
+void RectanglePacker::Reset(const IntVector2& dimensions)
+{
+	m_dimensions = dimensions;
+	m_usedArea = 0;
+
+	SkylineNode_t floor;
+	floor.x = 0;
+	floor.y = 0;
+	floor.width = dimensions.x;
+
+	m_skyline.clear();
+	m_skyline.push_back(floor);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds the lowest spot the rectangle fits, breaking ties by the narrowest segment, and places it there
+//
+bool RectanglePacker::Pack(const IntVector2& size, IntVector2& out_position)
+{
+	if (size.x <= 0 || size.y <= 0)
+	{
+		return false;
+	}
+
+	int bestIndex = -1;
+	int bestTop = 0;
+	int bestWidth = 0;
+	IntVector2 bestPosition;
+
+	for (int nodeIndex = 0; nodeIndex < (int) m_skyline.size(); ++nodeIndex)
+	{
+		int y = GetFitY(nodeIndex, size);
+
+		if (y < 0)
+		{
+			continue;
+		}
+
+		int top = y + size.y;
+		int width = m_skyline[nodeIndex].width;
+
+		if (bestIndex == -1 || top < bestTop || (top == bestTop && width < bestWidth))
+		{
+			bestIndex = nodeIndex;
+			bestTop = top;
+			bestWidth = width;
+			bestPosition = IntVector2(m_skyline[nodeIndex].x, y);
+		}
+	}
+
+	if (bestIndex == -1)
+	{
+		return false;
+	}
+
+	AddSkylineLevel(bestIndex, bestPosition, size);
+	m_usedArea += size.x * size.y;
+
+	out_position = bestPosition;
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the dimensions being packed into
+//
+IntVector2 RectanglePacker::GetDimensions() const
+{
+	return m_dimensions;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the fraction of the area that's been packed into
+//
+float RectanglePacker::GetOccupancy() const
+{
+	int totalArea = m_dimensions.x * m_dimensions.y;
+	return (totalArea > 0 ? (float) m_usedArea / (float) totalArea : 0.f);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the y the rectangle would sit at with its left edge on the node, resting on every node
+// it spans, or -1 if it would go out of bounds
+//
+int RectanglePacker::GetFitY(int nodeIndex, const IntVector2& size) const
+{
+	int x = m_skyline[nodeIndex].x;
+
+	if (x + size.x > m_dimensions.x)
+	{
+		return -1;
+	}
+
+	int y = 0;
+	int widthLeft = size.x;
+
+	while (widthLeft > 0)
+	{
+		if (nodeIndex >= (int) m_skyline.size())
+		{
+			return -1;
+		}
+
+		y = MaxInt(y, m_skyline[nodeIndex].y);
+
+		if (y + size.y > m_dimensions.y)
+		{
+			return -1;
+		}
+
+		widthLeft -= m_skyline[nodeIndex].width;
+		nodeIndex++;
+	}
+
+	return y;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Raises the skyline over the rectangle placed, trimming or removing the nodes it covers
+//
+void RectanglePacker::AddSkylineLevel(int nodeIndex, const IntVector2& position, const IntVector2& size)
+{
+	SkylineNode_t newNode;
+	newNode.x = position.x;
+	newNode.y = position.y + size.y;
+	newNode.width = size.x;
+
+	m_skyline.insert(m_skyline.begin() + nodeIndex, newNode);
+
+	// Cut the covered part off the nodes to the right
+	int currIndex = nodeIndex + 1;
+	while (currIndex < (int) m_skyline.size())
+	{
+		const SkylineNode_t& previous = m_skyline[currIndex - 1];
+		SkylineNode_t& current = m_skyline[currIndex];
+
+		int previousRight = previous.x + previous.width;
+
+		if (current.x >= previousRight)
+		{
+			break;
+		}
+
+		int overlap = previousRight - current.x;
+		current.x += overlap;
+		current.width -= overlap;
+
+		if (current.width > 0)
+		{
+			break;
+		}
+
+		m_skyline.erase(m_skyline.begin() + currIndex);
+	}
+
+	// Merge neighbours at the same height
+	for (int mergeIndex = 0; mergeIndex < (int) m_skyline.size() - 1;)
+	{
+		if (m_skyline[mergeIndex].y == m_skyline[mergeIndex + 1].y)
+		{
+			m_skyline[mergeIndex].width += m_skyline[mergeIndex + 1].width;
+			m_skyline.erase(m_skyline.begin() + mergeIndex + 1);
+		}
+		else
+		{
+			++mergeIndex;
+		}
+	}
+}
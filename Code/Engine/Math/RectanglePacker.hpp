@@ -0,0 +1,56 @@
+/************************************************************************/
+/* File: RectanglePacker.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Skyline bottom-left packer, for placing many small
+/*				rectangles (i.e. images in an atlas) into one large one
+/************************************************************************/
+#pragma once
+#include <vector>
+#include "Engine/Math/IntVector2.hpp"
+
+
+class RectanglePacker
+{
+public:
+	//-----Public Methods-----
+
+	RectanglePacker(const IntVector2& dimensions);
+
+	void		Reset(const IntVector2& dimensions);
+
+	// Places the rectangle as low as it can go, returns false if it doesn't fit anywhere
+	// Packing largest first (by height) packs tightest
+	bool		Pack(const IntVector2& size, IntVector2& out_position);
+
+	IntVector2	GetDimensions() const;
+	float		GetOccupancy() const;		// Fraction of the area packed into
+
+
+private:
+	//-----Private Types-----
+
+	// A horizontal segment of the top edge of everything packed so far
+	struct SkylineNode_t
+	{
+		int x;
+		int y;
+		int width;
+	};
+
+
+private:
+	//-----Private Methods-----
+
+	int			GetFitY(int nodeIndex, const IntVector2& size) const;	// -1 if it can't fit there
+	void		AddSkylineLevel(int nodeIndex, const IntVector2& position, const IntVector2& size);
+
+
+private:
+	//-----Private Data-----
+
+	IntVector2					m_dimensions;
+	std::vector<SkylineNode_t>	m_skyline;		// Left to right
+	int							m_usedArea = 0;
+
+};
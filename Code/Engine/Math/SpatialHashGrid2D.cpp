@@ -0,0 +1,447 @@
+/************************************************************************/
+/* File: SpatialHashGrid2D.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the SpatialHashGrid2D class
+/************************************************************************/
+#include <stdint.h>
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/SpatialHashGrid2D.hpp"
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns true if the disc touches the box, by clamping its center onto the box
+//
+static bool DoesDiscOverlapAABB2(const Vector2& center, float radius, const AABB2& box)
+{
+	Vector2 closestPoint;
+	closestPoint.x = ClampFloat(center.x, box.mins.x, box.maxs.x);
+	closestPoint.y = ClampFloat(center.y, box.mins.y, box.maxs.y);
+
+	return ((closestPoint - center).GetLengthSquared() <= radius * radius);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the componentwise max of the two cells - the first cell two cell ranges share
+//
+static inline IntVector2 GetSharedMinCell(const IntVector2& a, const IntVector2& b)
+{
+	return IntVector2((a.x > b.x ? a.x : b.x), (a.y > b.y ? a.y : b.y));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+SpatialHashGrid2D::SpatialHashGrid2D(float cellSize, int bucketCount /*= SPATIAL_HASH_DEFAULT_BUCKET_COUNT*/)
+	: m_cellSize(cellSize)
+	, m_inverseCellSize(1.f / cellSize)
+{
+	ASSERT_OR_DIE(cellSize > 0.f, Stringf("Error: SpatialHashGrid2D created with cell size %f, must be positive", cellSize));
+
+	int roundedBucketCount = 1;
+	while (roundedBucketCount < bucketCount)
+	{
+		roundedBucketCount <<= 1;
+	}
+
+	m_bucketMask = roundedBucketCount - 1;
+	m_bucketHeads.resize(roundedBucketCount, SPATIAL_HASH_INVALID_ID);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds an entity with the given bounds, returning its ID
+//
+int SpatialHashGrid2D::Insert(const AABB2& bounds, void* userData /*= nullptr*/)
+{
+	int entityID;
+
+	if (m_freeEntityIDs.size() > 0)
+	{
+		entityID = m_freeEntityIDs.back();
+		m_freeEntityIDs.pop_back();
+	}
+	else
+	{
+		entityID = (int) m_entityBounds.size();
+
+		m_entityBounds.push_back(bounds);
+		m_entityMinCells.push_back(IntVector2());
+		m_entityMaxCells.push_back(IntVector2());
+		m_entityUserData.push_back(nullptr);
+		m_entityFirstEntries.push_back(SPATIAL_HASH_INVALID_ID);
+	}
+
+	m_entityBounds[entityID] = bounds;
+	m_entityUserData[entityID] = userData;
+	m_entityCount++;
+
+	LinkEntity(entityID);
+
+	return entityID;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds an entity for the disc, stored as the box around it
+//
+int SpatialHashGrid2D::Insert(const Vector2& center, float radius, void* userData /*= nullptr*/)
+{
+	return Insert(AABB2(center, radius, radius), userData);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds an entity for the disc
+//
+int SpatialHashGrid2D::Insert(const Disc2& disc, void* userData /*= nullptr*/)
+{
+	return Insert(disc.center, disc.radius, userData);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes the entity, freeing its ID
+//
+void SpatialHashGrid2D::Remove(int entityID)
+{
+	ASSERT_OR_DIE(entityID >= 0 && entityID < (int) m_entityFirstEntries.size() && m_entityFirstEntries[entityID] != SPATIAL_HASH_INVALID_ID,
+		Stringf("Error: SpatialHashGrid2D::Remove received invalid ID %i", entityID));
+
+	UnlinkEntity(entityID);
+
+	m_entityUserData[entityID] = nullptr;
+	m_freeEntityIDs.push_back(entityID);
+	m_entityCount--;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes every entity, keeping the storage for reuse
+//
+void SpatialHashGrid2D::Clear()
+{
+	std::fill(m_bucketHeads.begin(), m_bucketHeads.end(), SPATIAL_HASH_INVALID_ID);
+
+	m_entries.clear();
+	m_freeEntryHead = SPATIAL_HASH_INVALID_ID;
+
+	m_entityBounds.clear();
+	m_entityMinCells.clear();
+	m_entityMaxCells.clear();
+	m_entityUserData.clear();
+	m_entityFirstEntries.clear();
+	m_freeEntityIDs.clear();
+	m_entityCount = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the entity's bounds, relinking it only if it covers different cells now
+//
+void SpatialHashGrid2D::Move(int entityID, const AABB2& newBounds)
+{
+	ASSERT_OR_DIE(entityID >= 0 && entityID < (int) m_entityFirstEntries.size() && m_entityFirstEntries[entityID] != SPATIAL_HASH_INVALID_ID,
+		Stringf("Error: SpatialHashGrid2D::Move received invalid ID %i", entityID));
+
+	IntVector2 newMinCell = GetCellCoords(newBounds.mins);
+	IntVector2 newMaxCell = GetCellCoords(newBounds.maxs);
+
+	m_entityBounds[entityID] = newBounds;
+
+	if (newMinCell == m_entityMinCells[entityID] && newMaxCell == m_entityMaxCells[entityID])
+	{
+		return;
+	}
+
+	UnlinkEntity(entityID);
+	LinkEntity(entityID);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Moves the entity to the box around the disc
+//
+void SpatialHashGrid2D::Move(int entityID, const Vector2& newCenter, float newRadius)
+{
+	Move(entityID, AABB2(newCenter, newRadius, newRadius));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Moves the entity to the box around the disc
+//
+void SpatialHashGrid2D::Move(int entityID, const Disc2& newDisc)
+{
+	Move(entityID, newDisc.center, newDisc.radius);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the entity's bounds
+//
+const AABB2& SpatialHashGrid2D::GetBounds(int entityID) const
+{
+	return m_entityBounds[entityID];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the user data the entity was inserted with
+//
+void* SpatialHashGrid2D::GetUserData(int entityID) const
+{
+	return m_entityUserData[entityID];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of entities in the grid
+//
+int SpatialHashGrid2D::GetEntityCount() const
+{
+	return m_entityCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Appends the entities whose bounds overlap the region
+//
+void SpatialHashGrid2D::QueryRegion(const AABB2& region, std::vector<int>& out_entityIDs) const
+{
+	ForEachInRegion(region, [&](int entityID)
+	{
+		if (DoAABB2sOverlap(m_entityBounds[entityID], region))
+		{
+			out_entityIDs.push_back(entityID);
+		}
+	});
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Appends the entities whose bounds touch the disc
+//
+void SpatialHashGrid2D::QueryRadius(const Vector2& center, float radius, std::vector<int>& out_entityIDs) const
+{
+	ForEachInRegion(AABB2(center, radius, radius), [&](int entityID)
+	{
+		if (DoesDiscOverlapAABB2(center, radius, m_entityBounds[entityID]))
+		{
+			out_entityIDs.push_back(entityID);
+		}
+	});
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Appends the entities whose bounds touch the disc
+//
+void SpatialHashGrid2D::QueryDisc(const Disc2& disc, std::vector<int>& out_entityIDs) const
+{
+	QueryRadius(disc.center, disc.radius, out_entityIDs);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Appends each overlapping pair once, checking only entities that share a cell; a pair sharing
+// several cells is reported from the first of them, so no set of seen pairs is needed
+//
+void SpatialHashGrid2D::FindOverlappingPairs(std::vector<SpatialHashPair_t>& out_pairs) const
+{
+	int bucketCount = (int) m_bucketHeads.size();
+
+	for (int bucketIndex = 0; bucketIndex < bucketCount; ++bucketIndex)
+	{
+		for (int firstIndex = m_bucketHeads[bucketIndex]; firstIndex != SPATIAL_HASH_INVALID_ID; firstIndex = m_entries[firstIndex].nextInBucket)
+		{
+			const SpatialHashEntry_t& first = m_entries[firstIndex];
+
+			for (int secondIndex = first.nextInBucket; secondIndex != SPATIAL_HASH_INVALID_ID; secondIndex = m_entries[secondIndex].nextInBucket)
+			{
+				const SpatialHashEntry_t& second = m_entries[secondIndex];
+
+				// Other cells can hash to the same bucket
+				if (!(first.cell == second.cell))
+				{
+					continue;
+				}
+
+				int firstID = first.entityID;
+				int secondID = second.entityID;
+
+				if (!(GetSharedMinCell(m_entityMinCells[firstID], m_entityMinCells[secondID]) == first.cell))
+				{
+					continue;
+				}
+
+				if (DoAABB2sOverlap(m_entityBounds[firstID], m_entityBounds[secondID]))
+				{
+					SpatialHashPair_t pair;
+					pair.firstID = (firstID < secondID ? firstID : secondID);
+					pair.secondID = (firstID < secondID ? secondID : firstID);
+
+					out_pairs.push_back(pair);
+				}
+			}
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the cell containing the position
+//
+IntVector2 SpatialHashGrid2D::GetCellCoords(const Vector2& position) const
+{
+	return IntVector2(Floor(position.x * m_inverseCellSize), Floor(position.y * m_inverseCellSize));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the bucket the cell's entries are listed in
+//
+int SpatialHashGrid2D::GetBucketIndex(const IntVector2& cell) const
+{
+	uint32_t hash = ((uint32_t) cell.x * 73856093u) ^ ((uint32_t) cell.y * 19349663u);
+	return (int) (hash & (uint32_t) m_bucketMask);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds an entry for every cell the entity's bounds cover
+//
+void SpatialHashGrid2D::LinkEntity(int entityID)
+{
+	const AABB2& bounds = m_entityBounds[entityID];
+
+	IntVector2 minCell = GetCellCoords(bounds.mins);
+	IntVector2 maxCell = GetCellCoords(bounds.maxs);
+
+	m_entityMinCells[entityID] = minCell;
+	m_entityMaxCells[entityID] = maxCell;
+
+	for (int cellY = minCell.y; cellY <= maxCell.y; ++cellY)
+	{
+		for (int cellX = minCell.x; cellX <= maxCell.x; ++cellX)
+		{
+			IntVector2 cell = IntVector2(cellX, cellY);
+			int bucketIndex = GetBucketIndex(cell);
+
+			// Can grow m_entries, so no references are held across it
+			int entryIndex = AllocateEntry();
+			SpatialHashEntry_t& entry = m_entries[entryIndex];
+
+			entry.cell = cell;
+			entry.entityID = entityID;
+
+			entry.previousInBucket = SPATIAL_HASH_INVALID_ID;
+			entry.nextInBucket = m_bucketHeads[bucketIndex];
+
+			if (entry.nextInBucket != SPATIAL_HASH_INVALID_ID)
+			{
+				m_entries[entry.nextInBucket].previousInBucket = entryIndex;
+			}
+
+			m_bucketHeads[bucketIndex] = entryIndex;
+
+			entry.nextInEntity = m_entityFirstEntries[entityID];
+			m_entityFirstEntries[entityID] = entryIndex;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes the entity's entries from their buckets and frees them
+//
+void SpatialHashGrid2D::UnlinkEntity(int entityID)
+{
+	int entryIndex = m_entityFirstEntries[entityID];
+
+	while (entryIndex != SPATIAL_HASH_INVALID_ID)
+	{
+		SpatialHashEntry_t& entry = m_entries[entryIndex];
+		int nextEntryIndex = entry.nextInEntity;
+
+		if (entry.previousInBucket != SPATIAL_HASH_INVALID_ID)
+		{
+			m_entries[entry.previousInBucket].nextInBucket = entry.nextInBucket;
+		}
+		else
+		{
+			m_bucketHeads[GetBucketIndex(entry.cell)] = entry.nextInBucket;
+		}
+
+		if (entry.nextInBucket != SPATIAL_HASH_INVALID_ID)
+		{
+			m_entries[entry.nextInBucket].previousInBucket = entry.previousInBucket;
+		}
+
+		entry.entityID = SPATIAL_HASH_INVALID_ID;
+		entry.nextInEntity = m_freeEntryHead;
+		m_freeEntryHead = entryIndex;
+
+		entryIndex = nextEntryIndex;
+	}
+
+	m_entityFirstEntries[entityID] = SPATIAL_HASH_INVALID_ID;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns an entry off the free list, or a new one if it's empty
+//
+int SpatialHashGrid2D::AllocateEntry()
+{
+	if (m_freeEntryHead != SPATIAL_HASH_INVALID_ID)
+	{
+		int entryIndex = m_freeEntryHead;
+		m_freeEntryHead = m_entries[entryIndex].nextInEntity;
+
+		return entryIndex;
+	}
+
+	m_entries.push_back(SpatialHashEntry_t());
+	return (int) m_entries.size() - 1;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Calls visit once for each entity with an entry in the region's cells; entities covering several
+// of those cells are only visited from the first, so nothing needs to remember what's been seen
+//
+template <typename Visitor>
+void SpatialHashGrid2D::ForEachInRegion(const AABB2& region, const Visitor& visit) const
+{
+	IntVector2 minCell = GetCellCoords(region.mins);
+	IntVector2 maxCell = GetCellCoords(region.maxs);
+
+	for (int cellY = minCell.y; cellY <= maxCell.y; ++cellY)
+	{
+		for (int cellX = minCell.x; cellX <= maxCell.x; ++cellX)
+		{
+			IntVector2 cell = IntVector2(cellX, cellY);
+
+			for (int entryIndex = m_bucketHeads[GetBucketIndex(cell)]; entryIndex != SPATIAL_HASH_INVALID_ID; entryIndex = m_entries[entryIndex].nextInBucket)
+			{
+				const SpatialHashEntry_t& entry = m_entries[entryIndex];
+
+				if (!(entry.cell == cell))
+				{
+					continue;
+				}
+
+				if (!(GetSharedMinCell(m_entityMinCells[entry.entityID], minCell) == cell))
+				{
+					continue;
+				}
+
+				visit(entry.entityID);
+			}
+		}
+	}
+}
@@ -0,0 +1,108 @@
+/************************************************************************/
+/* File: SpatialHashGrid2D.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Uniform grid of 2D cells hashed into a fixed bucket table,
+/*				for finding what's in a region, near a point or touching
+/*				what else without testing every pair; everything lives in
+/*				flat arrays so queries don't allocate or chase pointers
+/************************************************************************/
+#pragma once
+#include <vector>
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/Disc2.hpp"
+#include "Engine/Math/IntVector2.hpp"
+
+// Rounded up to a power of two; more buckets than occupied cells keeps the lists short
+#define SPATIAL_HASH_DEFAULT_BUCKET_COUNT (16384)
+
+#define SPATIAL_HASH_INVALID_ID (-1)
+
+struct SpatialHashPair_t
+{
+	int firstID;
+	int secondID;
+};
+
+// One per cell an entity covers, linked into its bucket's list and its entity's list
+struct SpatialHashEntry_t
+{
+	IntVector2	cell;
+	int			entityID		= SPATIAL_HASH_INVALID_ID;
+	int			nextInBucket	= SPATIAL_HASH_INVALID_ID;
+	int			previousInBucket = SPATIAL_HASH_INVALID_ID;
+	int			nextInEntity	= SPATIAL_HASH_INVALID_ID;		// Also the free list
+};
+
+
+class SpatialHashGrid2D
+{
+public:
+	//-----Public Methods-----
+
+	// Cells should be about the size of a typical entity - entities many cells across are slow to insert and move
+	SpatialHashGrid2D(float cellSize, int bucketCount = SPATIAL_HASH_DEFAULT_BUCKET_COUNT);
+	~SpatialHashGrid2D() {}
+
+	// IDs stay valid until removed, and are reused after that
+	int			Insert(const AABB2& bounds, void* userData = nullptr);
+	int			Insert(const Vector2& center, float radius, void* userData = nullptr);
+	int			Insert(const Disc2& disc, void* userData = nullptr);
+	void		Remove(int entityID);
+	void		Clear();
+
+	// Only relinks the entity if it changed cells, so small moves just store the bounds
+	void		Move(int entityID, const AABB2& newBounds);
+	void		Move(int entityID, const Vector2& newCenter, float newRadius);
+	void		Move(int entityID, const Disc2& newDisc);
+
+	const AABB2&	GetBounds(int entityID) const;
+	void*			GetUserData(int entityID) const;
+	int				GetEntityCount() const;
+
+	// Queries append every overlapping entity once, in no particular order; reuse the vectors and they won't allocate
+	void		QueryRegion(const AABB2& region, std::vector<int>& out_entityIDs) const;
+	void		QueryRadius(const Vector2& center, float radius, std::vector<int>& out_entityIDs) const;
+	void		QueryDisc(const Disc2& disc, std::vector<int>& out_entityIDs) const;
+
+	// Broad phase - every pair of entities whose bounds overlap, once each
+	void		FindOverlappingPairs(std::vector<SpatialHashPair_t>& out_pairs) const;
+
+
+private:
+	//-----Private Methods-----
+
+	IntVector2	GetCellCoords(const Vector2& position) const;
+	int			GetBucketIndex(const IntVector2& cell) const;
+
+	void		LinkEntity(int entityID);
+	void		UnlinkEntity(int entityID);
+	int			AllocateEntry();
+
+	// Visits each entity overlapping the region once, from the one cell both cover that's closest to their mins
+	template <typename Visitor>
+	void		ForEachInRegion(const AABB2& region, const Visitor& visit) const;
+
+
+private:
+	//-----Private Data-----
+
+	float		m_cellSize;
+	float		m_inverseCellSize;
+	int			m_bucketMask;
+
+	std::vector<int>				m_bucketHeads;
+
+	std::vector<SpatialHashEntry_t>	m_entries;
+	int								m_freeEntryHead = SPATIAL_HASH_INVALID_ID;
+
+	// Per entity, indexed by ID
+	std::vector<AABB2>				m_entityBounds;
+	std::vector<IntVector2>			m_entityMinCells;
+	std::vector<IntVector2>			m_entityMaxCells;
+	std::vector<void*>				m_entityUserData;
+	std::vector<int>				m_entityFirstEntries;	// SPATIAL_HASH_INVALID_ID when the ID is free
+	std::vector<int>				m_freeEntityIDs;
+	int								m_entityCount = 0;
+
+};
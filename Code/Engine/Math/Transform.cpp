@@ -35,6 +35,9 @@ void Transform::operator=(const Transform& copyFrom)
 	position = copyFrom.position;
 	rotation = copyFrom.rotation;
 	scale = copyFrom.scale;
+
+	m_precisePosition = copyFrom.m_precisePosition;
+	m_precisePositionAsFloat = copyFrom.m_precisePositionAsFloat;
 }
 
 
@@ -92,7 +95,9 @@ void Transform::SetParentTransform(Transform* parent)
 //
 void Transform::TranslateWorld(const Vector3& worldTranslation)
 {
-	position += worldTranslation;
+	// Accumulate in double, so many small steps far from the origin aren't rounded away
+	SyncPrecisePosition();
+	SetPrecisePosition(m_precisePosition + DoubleVector3(worldTranslation));
 }
 
 
@@ -133,6 +138,17 @@ void Transform::Scale(const Vector3& deltaScale)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Sets the position in double precision, with the float position set to the nearest float
+//
+void Transform::SetPrecisePosition(const DoubleVector3& newPosition)
+{
+	m_precisePosition = newPosition;
+	position = newPosition.ToVector3();
+	m_precisePositionAsFloat = position;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the model matrix of this transform, recalculating it if it's outdated
 //
@@ -227,6 +243,64 @@ Vector3 Transform::GetWorldRotation()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the double precision position of the transform, in parent space
+//
+DoubleVector3 Transform::GetPrecisePosition()
+{
+	SyncPrecisePosition();
+	return m_precisePosition;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the double precision world position of the transform
+// Children are assumed near their parents, so only the offset from the parent goes through floats
+//
+DoubleVector3 Transform::GetPreciseWorldPosition()
+{
+	SyncPrecisePosition();
+
+	if (m_parentTransform == nullptr)
+	{
+		return m_precisePosition;
+	}
+
+	Vector4 offsetFromParent = m_parentTransform->GetWorldMatrix() * Vector4(position, 0.f);
+	return m_parentTransform->GetPreciseWorldPosition() + DoubleVector3(offsetFromParent.xyz());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the world matrix translated so origin is at zero, with the subtraction done in double
+// precision so the result stays precise however far both are from the world origin
+//
+Matrix44 Transform::GetWorldMatrixRelativeTo(const DoubleVector3& origin)
+{
+	Matrix44 relativeMatrix = GetWorldMatrix();
+	Vector3 relativePosition = (GetPreciseWorldPosition() - origin).ToVector3();
+
+	relativeMatrix.Tx = relativePosition.x;
+	relativeMatrix.Ty = relativePosition.y;
+	relativeMatrix.Tz = relativePosition.z;
+
+	return relativeMatrix;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Resets the precise position to the float one if position was written since it was last set
+//
+void Transform::SyncPrecisePosition()
+{
+	if (position != m_precisePositionAsFloat)
+	{
+		m_precisePosition = DoubleVector3(position);
+		m_precisePositionAsFloat = position;
+	}
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Recalculates the model matrix of this transform given its current position, rotation, and scale
 //
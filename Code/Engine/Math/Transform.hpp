@@ -7,6 +7,7 @@
 #pragma once
 #include "Engine/Math/Vector3.hpp"
 #include "Engine/Math/Matrix44.hpp"
+#include "Engine/Math/DoubleVector3.hpp"
 
 class Transform
 {
@@ -31,6 +32,10 @@ public:
 	void Rotate(const Vector3& deltaRotation);
 	void Scale(const Vector3& deltaScale);
 
+	// Double precision position in parent space, for transforms far from the world origin
+	// Writing position directly (or with the float setters) resets it to the float value
+	void SetPrecisePosition(const DoubleVector3& newPosition);
+
 	Matrix44 GetLocalMatrix();	// Matrix that transforms this space to parent's space
 	Matrix44 GetWorldMatrix();	// Matrix that transforms this space to absolute world space
 	Matrix44 GetParentsToWorldMatrix();
@@ -42,11 +47,16 @@ public:
 	Vector3 GetWorldPosition();
 	Vector3 GetWorldRotation();
 
+	DoubleVector3	GetPrecisePosition();
+	DoubleVector3	GetPreciseWorldPosition();
+	Matrix44		GetWorldMatrixRelativeTo(const DoubleVector3& origin);	// World matrix with the translation taken from origin in double precision
+
 
 private:
 	//-----Private Methods-----
 
 	void CheckAndUpdateLocalMatrix();
+	void SyncPrecisePosition();
 
 
 public:
@@ -67,5 +77,8 @@ private:
 
 	Matrix44 m_localMatrix;
 
+	DoubleVector3	m_precisePosition = DoubleVector3::ZERO;
+	Vector3			m_precisePositionAsFloat = Vector3::ZERO;	// What position was when m_precisePosition was last set, to notice direct writes
+
 	Transform* m_parentTransform = nullptr;
 };
@@ -12,34 +12,18 @@
 #include "Engine/Math/IntVector2.hpp"
 
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomGenerator.hpp"
 #include "Engine/Core/Utility/ErrorWarningAssert.hpp"
 #include "Engine/Core/Utility/StringUtils.hpp"
 
 
-// Initialize the static constants
-const Vector2 Vector2::ZERO = Vector2(0.f, 0.f);
-const Vector2 Vector2::ONES = Vector2(1.f, 1.f);
-const Vector2 Vector2::X_AXIS = Vector2(1.0f, 0.f);
-const Vector2 Vector2::Y_AXIS = Vector2(0.f, 1.0f);
-const Vector2 Vector2::MINUS_X_AXIS = Vector2(-1.0f, 0.f);
-const Vector2 Vector2::MINUS_Y_AXIS = Vector2(0.f, -1.0f);
-
-//-----------------------------------------------------------------------------------------------
-// Copy constructor
-Vector2::Vector2( const Vector2& copy )
-	: x( copy.x )
-	, y( copy.y )
-{
-}
-
-
-//-----------------------------------------------------------------------------------------------
-// Explicit constructor - floats
-Vector2::Vector2( float initialX, float initialY )
-	: x( initialX )
-	, y( initialY )
-{
-}
+// Initialize the static constants - constexpr, so they're baked into the image instead of set up at startup
+constexpr Vector2 Vector2::ZERO = Vector2(0.f, 0.f);
+constexpr Vector2 Vector2::ONES = Vector2(1.f, 1.f);
+constexpr Vector2 Vector2::X_AXIS = Vector2(1.0f, 0.f);
+constexpr Vector2 Vector2::Y_AXIS = Vector2(0.f, 1.0f);
+constexpr Vector2 Vector2::MINUS_X_AXIS = Vector2(-1.0f, 0.f);
+constexpr Vector2 Vector2::MINUS_Y_AXIS = Vector2(0.f, -1.0f);
 
 
 //-----------------------------------------------------------------------------------------------
@@ -51,123 +35,6 @@ Vector2::Vector2(const IntVector2& copyFrom)
 }
 
 
-//-----------------------------------------------------------------------------------------------
-// Explicit constructor - ints
-Vector2::Vector2( int initialX, int initialY )
-	: x( static_cast<float>(initialX))
-	, y( static_cast<float>(initialY))
-{
-}
-
-
-//-----------------------------------------------------------------------------------------------
-// Single float constructor
-Vector2::Vector2(float initialValue)
-	: x(initialValue)
-	, y(initialValue)
-{
-}
-
-//------------------------------ Operator Overloads ---------------------------------------------
-
-//-----------------------------------------------------------------------------------------------
-const Vector2 Vector2::operator + ( const Vector2& vecToAdd ) const
-{
-	return Vector2( (x + vecToAdd.x), (y + vecToAdd.y) );
-}
-
-
-//-----------------------------------------------------------------------------------------------
-const Vector2 Vector2::operator-( const Vector2& vecToSubtract ) const
-{
-	return Vector2( (x - vecToSubtract.x), (y - vecToSubtract.y) );
-}
-
-
-//-----------------------------------------------------------------------------------------------
-const Vector2 Vector2::operator*( float uniformScale ) const
-{
-	return Vector2( (x * uniformScale), (y * uniformScale) );
-}
-
-
-//-----------------------------------------------------------------------------------------------
-const Vector2 Vector2::operator/( float inverseScale ) const
-{
-	float multScaler = (1.f / inverseScale);
-	return Vector2( (x * multScaler), (y * multScaler) );
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void Vector2::operator+=( const Vector2& vecToAdd )
-{
-	x += vecToAdd.x;
-	y += vecToAdd.y;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void Vector2::operator-=( const Vector2& vecToSubtract )
-{
-	x -= vecToSubtract.x;
-	y -= vecToSubtract.y;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void Vector2::operator*=( const float uniformScale )
-{
-	x *= uniformScale;
-	y *= uniformScale;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void Vector2::operator/=( const float uniformDivisor )
-{
-	float multScaler = (1.f / uniformDivisor);
-
-	x *= multScaler;
-	y *= multScaler;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void Vector2::operator=( const Vector2& copyFrom )
-{
-	x = copyFrom.x;
-	y = copyFrom.y;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-const Vector2 operator*( float uniformScale, const Vector2& vecToScale )
-{
-	return Vector2( (vecToScale.x * uniformScale), (vecToScale.y * uniformScale) );
-}
-
-
-//-----------------------------------------------------------------------------------------------
-bool Vector2::operator==( const Vector2& compare ) const
-{
-	if ( x == compare.x && y == compare.y ) {
-		return true;
-	}
-	return false;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-bool Vector2::operator!=( const Vector2& compare ) const
-{
-	if ( x != compare.x || y != compare.y ) {
-		return true;
-	}
-	return false;
-}
-
-
 //-----------------------------------------------------------------------------------------------
 // Calculates the magnitude (length) of the vector and returns it
 //
@@ -238,18 +105,18 @@ float Vector2::GetOrientationDegrees() const
 //
 bool Vector2::SetFromText(const char* text)
 {
-	std::string stringText = std::string(text);
+	std::string_view stringText = text;
 
 	size_t commaPosition = stringText.find(",");
 
 	// No comma present in text
-	if (commaPosition == std::string::npos)
+	if (commaPosition == std::string_view::npos)
 	{
 		return false;
 	}
 
-	x = static_cast<float>(atof(std::string(stringText, 0, commaPosition).c_str()));
-	y = static_cast<float>(atof(std::string(stringText, commaPosition + 1).c_str()));
+	x = StringToFloat(stringText.substr(0, commaPosition));
+	y = StringToFloat(stringText.substr(commaPosition + 1));
 
 	return true;
 }
@@ -274,10 +141,7 @@ Vector2 Vector2::MakeDirectionAtDegrees(float degrees)
 //
 Vector2 Vector2::GetRandomVector(float desiredMagnitude)
 {
-	float randomDegrees = GetRandomFloatInRange(0.f, 360.f);
-	Vector2 randomUnitVector = MakeDirectionAtDegrees(randomDegrees);
-
-	return (desiredMagnitude * randomUnitVector);
+	return (desiredMagnitude * RandomGenerator::GetThreadDefault().GetPointOnCircle());
 }
 
 
@@ -18,28 +18,28 @@ public:
 	//-----Public Methods-----
 
 	// Construction/Destruction
-	~Vector2() {}											// destructor: do nothing (for speed)
+	~Vector2() = default;									// destructor: do nothing (for speed)
 	Vector2() {}											// default constructor: do nothing (for speed)
-	Vector2( const Vector2& copyFrom );						// copy constructor (from another vec2)
-	explicit Vector2( float initialX, float initialY );		// explicit constructor (from x, y)
-	explicit Vector2( int initialX, int initialY );			// explicit int constructor
+	constexpr Vector2( const Vector2& copyFrom ) = default;	// copy constructor (from another vec2)
+	constexpr explicit Vector2( float initialX, float initialY );	// explicit constructor (from x, y)
+	constexpr explicit Vector2( int initialX, int initialY );	// explicit int constructor
 	explicit Vector2(const IntVector2& intVector);			// Creates a Vector2 from an IntVector2
-	explicit Vector2(float initialValue);					// Creates a Vector2 from the single float
+	constexpr explicit Vector2(float initialValue);			// Creates a Vector2 from the single float
 
 																		// Operators
-	const	Vector2 operator+( const Vector2& vecToAdd ) const;			// vec2 + vec2
-	const	Vector2 operator-( const Vector2& vecToSubtract ) const;	// vec2 - vec2
-	const	Vector2 operator*( float uniformScale ) const;				// vec2 * float
-	const	Vector2 operator/( float inverseScale ) const;				// vec2 / float
-	void	operator+=( const Vector2& vecToAdd );						// vec2 += vec2
-	void	operator-=( const Vector2& vecToSubtract );					// vec2 -= vec2
-	void	operator*=( const float uniformScale );						// vec2 *= float
-	void	operator/=( const float uniformDivisor );					// vec2 /= float
-	void	operator=( const Vector2& copyFrom );						// vec2 = vec2
-	bool	operator==( const Vector2& compare ) const;					// vec2 == vec2
-	bool	operator!=( const Vector2& compare ) const;					// vec2 != vec2
-
-	friend const Vector2 operator*( float uniformScale, const Vector2& vecToScale );	// float * vec2
+	constexpr const	Vector2 operator+( const Vector2& vecToAdd ) const;	// vec2 + vec2
+	constexpr const	Vector2 operator-( const Vector2& vecToSubtract ) const;	// vec2 - vec2
+	constexpr const	Vector2 operator*( float uniformScale ) const;		// vec2 * float
+	constexpr const	Vector2 operator/( float inverseScale ) const;		// vec2 / float
+	constexpr void	operator+=( const Vector2& vecToAdd );				// vec2 += vec2
+	constexpr void	operator-=( const Vector2& vecToSubtract );			// vec2 -= vec2
+	constexpr void	operator*=( const float uniformScale );				// vec2 *= float
+	constexpr void	operator/=( const float uniformDivisor );			// vec2 /= float
+	Vector2&		operator=( const Vector2& copyFrom ) = default;		// vec2 = vec2
+	constexpr bool	operator==( const Vector2& compare ) const;			// vec2 == vec2
+	constexpr bool	operator!=( const Vector2& compare ) const;			// vec2 != vec2
+
+	friend constexpr const Vector2 operator*( float uniformScale, const Vector2& vecToScale );	// float * vec2
 
 	float	GetLength() const;							// Calculates the magnitude of the vector
 	float	GetLengthSquared() const;					// Calculates the squared magnitude of the vector
@@ -65,6 +65,129 @@ public:
 	float y;
 };
 
+
+///////////////////////////////////////////////////////////////////////////////
+// Constexpr definitions - in the header so constants and tables built from
+// them are worked out at compile time
+///////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------------------------
+// Explicit constructor - floats
+constexpr Vector2::Vector2( float initialX, float initialY )
+	: x( initialX )
+	, y( initialY )
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Explicit constructor - ints
+constexpr Vector2::Vector2( int initialX, int initialY )
+	: x( static_cast<float>(initialX))
+	, y( static_cast<float>(initialY))
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Single float constructor
+constexpr Vector2::Vector2(float initialValue)
+	: x(initialValue)
+	, y(initialValue)
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const Vector2 Vector2::operator + ( const Vector2& vecToAdd ) const
+{
+	return Vector2( (x + vecToAdd.x), (y + vecToAdd.y) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const Vector2 Vector2::operator-( const Vector2& vecToSubtract ) const
+{
+	return Vector2( (x - vecToSubtract.x), (y - vecToSubtract.y) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const Vector2 Vector2::operator*( float uniformScale ) const
+{
+	return Vector2( (x * uniformScale), (y * uniformScale) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const Vector2 Vector2::operator/( float inverseScale ) const
+{
+	float multScaler = (1.f / inverseScale);
+	return Vector2( (x * multScaler), (y * multScaler) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr void Vector2::operator+=( const Vector2& vecToAdd )
+{
+	x += vecToAdd.x;
+	y += vecToAdd.y;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr void Vector2::operator-=( const Vector2& vecToSubtract )
+{
+	x -= vecToSubtract.x;
+	y -= vecToSubtract.y;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr void Vector2::operator*=( const float uniformScale )
+{
+	x *= uniformScale;
+	y *= uniformScale;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr void Vector2::operator/=( const float uniformDivisor )
+{
+	float multScaler = (1.f / uniformDivisor);
+
+	x *= multScaler;
+	y *= multScaler;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const Vector2 operator*( float uniformScale, const Vector2& vecToScale )
+{
+	return Vector2( (vecToScale.x * uniformScale), (vecToScale.y * uniformScale) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr bool Vector2::operator==( const Vector2& compare ) const
+{
+	if ( x == compare.x && y == compare.y ) {
+		return true;
+	}
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr bool Vector2::operator!=( const Vector2& compare ) const
+{
+	if ( x != compare.x || y != compare.y ) {
+		return true;
+	}
+	return false;
+}
+
+
 //-----Standalone Functions-----
 
 // Returns the distance between points a and b
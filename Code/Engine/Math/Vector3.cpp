@@ -10,38 +10,19 @@
 #include "Engine/Math/Vector3.hpp"
 #include "Engine/Math/IntVector3.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/Utility/StringUtils.hpp"
 
 
-// Initialize the static constants
-const Vector3 Vector3::ZERO	= Vector3(0.f, 0.f, 0.f);
-const Vector3 Vector3::ONES	= Vector3(1.f, 1.f, 1.f);
+// Initialize the static constants - constexpr, so they're baked into the image instead of set up at startup
+constexpr Vector3 Vector3::ZERO	= Vector3(0.f, 0.f, 0.f);
+constexpr Vector3 Vector3::ONES	= Vector3(1.f, 1.f, 1.f);
 
-const Vector3 Vector3::X_AXIS			= Vector3(1.0f, 0.f, 0.f);
-const Vector3 Vector3::Y_AXIS			= Vector3(0.f, 1.0f, 0.f);
-const Vector3 Vector3::Z_AXIS			= Vector3(0.f, 0.f, 1.f);
-const Vector3 Vector3::MINUS_X_AXIS		= Vector3(-1.0f, 0.f, 0.f);
-const Vector3 Vector3::MINUS_Y_AXIS		= Vector3(0.f, -1.0f, 0.f);
-const Vector3 Vector3::MINUS_Z_AXIS		= Vector3(0.f, 0.f, -1.f);
-
-
-//-----------------------------------------------------------------------------------------------
-// Copy constructor
-Vector3::Vector3( const Vector3& copy )
-	: x( copy.x )
-	, y( copy.y )
-	, z(copy.z)
-{
-}
-
-
-//-----------------------------------------------------------------------------------------------
-// Explicit constructor
-Vector3::Vector3( float initialX, float initialY, float initialZ)
-	: x( initialX )
-	, y( initialY )
-	, z(initialZ)
-{
-}
+constexpr Vector3 Vector3::X_AXIS			= Vector3(1.0f, 0.f, 0.f);
+constexpr Vector3 Vector3::Y_AXIS			= Vector3(0.f, 1.0f, 0.f);
+constexpr Vector3 Vector3::Z_AXIS			= Vector3(0.f, 0.f, 1.f);
+constexpr Vector3 Vector3::MINUS_X_AXIS		= Vector3(-1.0f, 0.f, 0.f);
+constexpr Vector3 Vector3::MINUS_Y_AXIS		= Vector3(0.f, -1.0f, 0.f);
+constexpr Vector3 Vector3::MINUS_Z_AXIS		= Vector3(0.f, 0.f, -1.f);
 
 
 //-----------------------------------------------------------------------------------------------
@@ -55,128 +36,6 @@ Vector3::Vector3(const IntVector3& intVector)
 }
 
 
-//-----------------------------------------------------------------------------------------------
-// Constructor - from a single float value
-//
-Vector3::Vector3(float value)
-	: x(value), y(value), z(value)
-{
-}
-
-
-//-----------------------------------------------------------------------------------------------
-// Constructor from ints
-//
-Vector3::Vector3(int initialX, int initialY, int initialZ)
-	: x((float)initialX), y((float)initialY), z((float)initialZ)
-{
-}
-
-//------------------------------ Operator Overloads ---------------------------------------------
-
-//-----------------------------------------------------------------------------------------------
-const Vector3 Vector3::operator + ( const Vector3& vecToAdd ) const
-{
-	return Vector3( (x + vecToAdd.x), (y + vecToAdd.y), (z + vecToAdd.z));
-}
-
-
-//-----------------------------------------------------------------------------------------------
-const Vector3 Vector3::operator-( const Vector3& vecToSubtract ) const
-{
-	return Vector3( (x - vecToSubtract.x), (y - vecToSubtract.y) , (z - vecToSubtract.z));
-}
-
-
-//-----------------------------------------------------------------------------------------------
-const Vector3 Vector3::operator*( float uniformScale ) const
-{
-	return Vector3( (x * uniformScale), (y * uniformScale), (z * uniformScale) );
-}
-
-
-//-----------------------------------------------------------------------------------------------
-const Vector3 Vector3::operator/( float inverseScale ) const
-{
-	float multScaler = (1.f / inverseScale);
-	return Vector3( (x * multScaler), (y * multScaler), (z * multScaler) );
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void Vector3::operator+=( const Vector3& vecToAdd )
-{
-	x += vecToAdd.x;
-	y += vecToAdd.y;
-	z += vecToAdd.z;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void Vector3::operator-=( const Vector3& vecToSubtract )
-{
-	x -= vecToSubtract.x;
-	y -= vecToSubtract.y;
-	z -= vecToSubtract.z;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void Vector3::operator*=( const float uniformScale )
-{
-	x *= uniformScale;
-	y *= uniformScale;
-	z *= uniformScale;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void Vector3::operator/=( const float uniformDivisor )
-{
-	float multScaler = (1.f / uniformDivisor);
-
-	x *= multScaler;
-	y *= multScaler;
-	z *= multScaler;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void Vector3::operator=( const Vector3& copyFrom )
-{
-	x = copyFrom.x;
-	y = copyFrom.y;
-	z = copyFrom.z;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-const Vector3 operator*( float uniformScale, const Vector3& vecToScale )
-{
-	return Vector3( (vecToScale.x * uniformScale), (vecToScale.y * uniformScale), (vecToScale.z * uniformScale) );
-}
-
-
-//-----------------------------------------------------------------------------------------------
-bool Vector3::operator==( const Vector3& compare ) const
-{
-	if ( x == compare.x && y == compare.y && z == compare.z ) {
-		return true;
-	}
-	return false;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-bool Vector3::operator!=( const Vector3& compare ) const
-{
-	if ( x != compare.x || y != compare.y || z != compare.z ) {
-		return true;
-	}
-	return false;
-}
-
-
 //-----------------------------------------------------------------------------------------------
 // Calculates the magnitude (length) of the vector and returns it
 //
@@ -245,18 +104,18 @@ Vector3 Vector3::GetNormalized() const
 bool Vector3::SetFromText(const char* text)
 {
 	bool usingCommas = true;
-	std::string stringText = std::string(text);
+	std::string_view stringText = text;
 
 	size_t firstComma = stringText.find(",");
 
 	// No comma present in text, so instead look for spaces
-	if (firstComma == std::string::npos)
+	if (firstComma == std::string_view::npos)
 	{
 		usingCommas = false;
 		firstComma = stringText.find(" ");
 
 		// No spaces either, so return false
-		if (firstComma == std::string::npos)
+		if (firstComma == std::string_view::npos)
 		{
 			return false;
 		}
@@ -266,15 +125,15 @@ bool Vector3::SetFromText(const char* text)
 	size_t secondComma = (usingCommas ? stringText.find(",", firstComma + 1) : stringText.find(" ", firstComma + 1));
 
 	// No second comma/space present in text
-	if (secondComma == std::string::npos)
+	if (secondComma == std::string_view::npos)
 	{
 		return false;
 	}
 
 	// Set the values
-	x = static_cast<float>(atof(std::string(stringText, 0, firstComma).c_str()));
-	y = static_cast<float>(atof(std::string(stringText, firstComma + 1, secondComma - firstComma - 1).c_str()));
-	z = static_cast<float>(atof(std::string(stringText, secondComma + 1).c_str()));
+	x = StringToFloat(stringText.substr(0, firstComma));
+	y = StringToFloat(stringText.substr(firstComma + 1, secondComma - firstComma - 1));
+	z = StringToFloat(stringText.substr(secondComma + 1));
 
 	return true;
 }
@@ -300,18 +159,10 @@ Vector2 Vector3::xz() const
 
 //-----------------------------------------------------------------------------------------------
 // Returns a randomly oriented vector given the desired magnitude
-// NOT EFFICIENT
 //
 Vector3 Vector3::GetRandomVector(float desiredMagnitude)
 {
-	Vector3 randomVector;
-	randomVector.x = GetRandomFloatInRange(0.f, 1.f);
-	randomVector.y = GetRandomFloatInRange(0.f, 1.f);
-	randomVector.z = GetRandomFloatInRange(0.f, 1.f);
-
-	Vector3 randomUnitVector = randomVector.GetNormalized();
-
-	return (desiredMagnitude * randomUnitVector);
+	return (desiredMagnitude * GetRandomPointOnSphere());
 }
 
 
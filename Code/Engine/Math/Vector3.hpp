@@ -18,28 +18,28 @@ public:
 	//-----Public Methods-----
 
 	// Construction/Destruction
-	~Vector3() {}															// destructor: do nothing (for speed)
+	~Vector3() = default;													// destructor: do nothing (for speed)
 	Vector3() {}															// default constructor: do nothing (for speed)
-	Vector3( const Vector3& copyFrom );										// copy constructor (from another vec2)
-	explicit Vector3( float initialX, float initialY, float initialZ);		// explicit constructor (from x, y)
-	explicit Vector3(int initialX, int initialY, int initialZ);		// explicit constructor (from x, y)
+	constexpr Vector3( const Vector3& copyFrom ) = default;					// copy constructor (from another vec2)
+	constexpr explicit Vector3( float initialX, float initialY, float initialZ);	// explicit constructor (from x, y)
+	constexpr explicit Vector3(int initialX, int initialY, int initialZ);	// explicit constructor (from x, y)
 	explicit Vector3(const IntVector3& intVector);							// constructor from an IntVector3
-	Vector3(float value);
+	constexpr Vector3(float value);
 
 	// Operators
-	const	Vector3 operator+( const Vector3& vecToAdd ) const;				// vec3 + vec3
-	const	Vector3 operator-( const Vector3& vecToSubtract ) const;		// vec3 - vec3
-	const	Vector3 operator*( float uniformScale ) const;					// vec3 * float
-	const	Vector3 operator/( float inverseScale ) const;					// vec3 / float
-	void	operator+=( const Vector3& vecToAdd );							// vec3 += vec3
-	void	operator-=( const Vector3& vecToSubtract );						// vec3 -= vec3
-	void	operator*=( const float uniformScale );							// vec3 *= float
-	void	operator/=( const float uniformDivisor );						// vec3 /= float
-	void	operator=( const Vector3& copyFrom );							// vec3 = vec3
-	bool	operator==( const Vector3& compare ) const;						// vec3 == vec3
-	bool	operator!=( const Vector3& compare ) const;						// vec3 != vec3
-
-	friend const Vector3 operator*( float uniformScale, const Vector3& vecToScale );	// float * vec2
+	constexpr const	Vector3 operator+( const Vector3& vecToAdd ) const;		// vec3 + vec3
+	constexpr const	Vector3 operator-( const Vector3& vecToSubtract ) const;	// vec3 - vec3
+	constexpr const	Vector3 operator*( float uniformScale ) const;			// vec3 * float
+	constexpr const	Vector3 operator/( float inverseScale ) const;			// vec3 / float
+	constexpr void	operator+=( const Vector3& vecToAdd );					// vec3 += vec3
+	constexpr void	operator-=( const Vector3& vecToSubtract );				// vec3 -= vec3
+	constexpr void	operator*=( const float uniformScale );					// vec3 *= float
+	constexpr void	operator/=( const float uniformDivisor );				// vec3 /= float
+	Vector3&	operator=( const Vector3& copyFrom ) = default;				// vec3 = vec3
+	constexpr bool	operator==( const Vector3& compare ) const;				// vec3 == vec3
+	constexpr bool	operator!=( const Vector3& compare ) const;				// vec3 != vec3
+
+	friend constexpr const Vector3 operator*( float uniformScale, const Vector3& vecToScale );	// float * vec2
 
 	float	GetLength() const;									// Calculates the magnitude of the vector
 	float	GetLengthSquared() const;							// Calculates the squared magnitude of the vector
@@ -70,4 +70,132 @@ public:
 	float z;
 };
 
+
+///////////////////////////////////////////////////////////////////////////////
+// Constexpr definitions - in the header so constants and tables built from
+// them are worked out at compile time
+///////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------------------------
+// Explicit constructor
+constexpr Vector3::Vector3( float initialX, float initialY, float initialZ)
+	: x( initialX )
+	, y( initialY )
+	, z(initialZ)
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - from a single float value
+//
+constexpr Vector3::Vector3(float value)
+	: x(value), y(value), z(value)
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor from ints
+//
+constexpr Vector3::Vector3(int initialX, int initialY, int initialZ)
+	: x((float)initialX), y((float)initialY), z((float)initialZ)
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const Vector3 Vector3::operator + ( const Vector3& vecToAdd ) const
+{
+	return Vector3( (x + vecToAdd.x), (y + vecToAdd.y), (z + vecToAdd.z));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const Vector3 Vector3::operator-( const Vector3& vecToSubtract ) const
+{
+	return Vector3( (x - vecToSubtract.x), (y - vecToSubtract.y) , (z - vecToSubtract.z));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const Vector3 Vector3::operator*( float uniformScale ) const
+{
+	return Vector3( (x * uniformScale), (y * uniformScale), (z * uniformScale) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const Vector3 Vector3::operator/( float inverseScale ) const
+{
+	float multScaler = (1.f / inverseScale);
+	return Vector3( (x * multScaler), (y * multScaler), (z * multScaler) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr void Vector3::operator+=( const Vector3& vecToAdd )
+{
+	x += vecToAdd.x;
+	y += vecToAdd.y;
+	z += vecToAdd.z;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr void Vector3::operator-=( const Vector3& vecToSubtract )
+{
+	x -= vecToSubtract.x;
+	y -= vecToSubtract.y;
+	z -= vecToSubtract.z;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr void Vector3::operator*=( const float uniformScale )
+{
+	x *= uniformScale;
+	y *= uniformScale;
+	z *= uniformScale;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr void Vector3::operator/=( const float uniformDivisor )
+{
+	float multScaler = (1.f / uniformDivisor);
+
+	x *= multScaler;
+	y *= multScaler;
+	z *= multScaler;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr bool Vector3::operator==( const Vector3& compare ) const
+{
+	if ( x == compare.x && y == compare.y && z == compare.z ) {
+		return true;
+	}
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr bool Vector3::operator!=( const Vector3& compare ) const
+{
+	if ( x != compare.x || y != compare.y || z != compare.z ) {
+		return true;
+	}
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const Vector3 operator*( float uniformScale, const Vector3& vecToScale )
+{
+	return Vector3( (vecToScale.x * uniformScale), (vecToScale.y * uniformScale), (vecToScale.z * uniformScale) );
+}
+
+
 const Vector3 Interpolate(const Vector3& start, const Vector3& end, float fractionTowardEnd);
@@ -11,156 +11,16 @@
 #include "Engine/Math/MathUtils.hpp"
 
 
-// Initialize the static constants
-const Vector4 Vector4::ZERO	= Vector4(0.f, 0.f, 0.f, 1.0f);
-const Vector4 Vector4::ONES	= Vector4(1.f, 1.f, 1.f, 1.0f);
+// Initialize the static constants - constexpr, so they're baked into the image instead of set up at startup
+constexpr Vector4 Vector4::ZERO	= Vector4(0.f, 0.f, 0.f, 1.0f);
+constexpr Vector4 Vector4::ONES	= Vector4(1.f, 1.f, 1.f, 1.0f);
 					
-const Vector4 Vector4::X_AXIS			= Vector4(1.0f,	 0.f,  0.f, 1.0f);
-const Vector4 Vector4::Y_AXIS			= Vector4(0.f,	 1.0f, 0.f, 1.0f);
-const Vector4 Vector4::Z_AXIS			= Vector4(0.f,	 0.f,  1.f, 1.0f);
-const Vector4 Vector4::MINUS_X_AXIS		= Vector4(-1.0f, 0.f,  0.f, 1.0f);
-const Vector4 Vector4::MINUS_Y_AXIS		= Vector4(0.f,	-1.0f, 0.f, 1.0f);
-const Vector4 Vector4::MINUS_Z_AXIS		= Vector4(0.f,	 0.f, -1.f, 1.0f);
-
-
-//-----------------------------------------------------------------------------------------------
-// Copy constructor
-Vector4::Vector4( const Vector4& copy )
-	: x( copy.x )
-	, y( copy.y )
-	, z(copy.z)
-	, w(copy.w)
-{
-}
-
-
-//-----------------------------------------------------------------------------------------------
-// Explicit constructor
-Vector4::Vector4( float initialX, float initialY, float initialZ, float initialW)
-	: x( initialX )
-	, y( initialY )
-	, z(initialZ)
-	, w(initialW)
-{
-}
-
-
-//-----------------------------------------------------------------------------------------------
-// Constructor from Vector3
-Vector4::Vector4(const Vector3& xyzVector, float wValue)
-	: x(xyzVector.x), y(xyzVector.y), z(xyzVector.z), w(wValue)
-{
-}
-
-
-//------------------------------ Operator Overloads ---------------------------------------------
-
-//-----------------------------------------------------------------------------------------------
-const Vector4 Vector4::operator + ( const Vector4& vecToAdd ) const
-{
-	return Vector4( (x + vecToAdd.x), (y + vecToAdd.y), (z + vecToAdd.z), (w + vecToAdd.w));
-}
-
-
-//-----------------------------------------------------------------------------------------------
-const Vector4 Vector4::operator-( const Vector4& vecToSubtract ) const
-{
-	return Vector4( (x - vecToSubtract.x), (y - vecToSubtract.y) , (z - vecToSubtract.z), (w - vecToSubtract.w));
-}
-
-
-//-----------------------------------------------------------------------------------------------
-const Vector4 Vector4::operator*( float uniformScale ) const
-{
-	return Vector4( (x * uniformScale), (y * uniformScale), (z * uniformScale), (w * uniformScale));
-}
-
-
-//-----------------------------------------------------------------------------------------------
-const Vector4 Vector4::operator/( float inverseScale ) const
-{
-	float multScaler = (1.f / inverseScale);
-	return Vector4( (x * multScaler), (y * multScaler), (z * multScaler), (w * multScaler) );
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void Vector4::operator+=( const Vector4& vecToAdd )
-{
-	x += vecToAdd.x;
-	y += vecToAdd.y;
-	z += vecToAdd.z;
-	w += vecToAdd.w;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void Vector4::operator-=( const Vector4& vecToSubtract )
-{
-	x -= vecToSubtract.x;
-	y -= vecToSubtract.y;
-	z -= vecToSubtract.z;
-	w -= vecToSubtract.w;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void Vector4::operator*=( const float uniformScale )
-{
-	x *= uniformScale;
-	y *= uniformScale;
-	z *= uniformScale;
-	w *= uniformScale;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void Vector4::operator/=( const float uniformDivisor )
-{
-	float multScaler = (1.f / uniformDivisor);
-
-	x *= multScaler;
-	y *= multScaler;
-	z *= multScaler;
-	w *= multScaler;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void Vector4::operator=( const Vector4& copyFrom )
-{
-	x = copyFrom.x;
-	y = copyFrom.y;
-	z = copyFrom.z;
-	w = copyFrom.w;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-const Vector4 operator*( float uniformScale, const Vector4& vecToScale )
-{
-	return Vector4( (vecToScale.x * uniformScale), (vecToScale.y * uniformScale), (vecToScale.z * uniformScale), (vecToScale.w * uniformScale) );
-}
-
-
-//-----------------------------------------------------------------------------------------------
-bool Vector4::operator==( const Vector4& compare ) const
-{
-	if (x == compare.x && y == compare.y && z == compare.z && w == compare.w) {
-		return true;
-	}
-	return false;
-}
-
-
-//-----------------------------------------------------------------------------------------------
-bool Vector4::operator!=( const Vector4& compare ) const
-{
-	if ( x != compare.x || y != compare.y || z != compare.z || w != compare.w) {
-		return true;
-	}
-	return false;
-}
+constexpr Vector4 Vector4::X_AXIS			= Vector4(1.0f,	 0.f,  0.f, 1.0f);
+constexpr Vector4 Vector4::Y_AXIS			= Vector4(0.f,	 1.0f, 0.f, 1.0f);
+constexpr Vector4 Vector4::Z_AXIS			= Vector4(0.f,	 0.f,  1.f, 1.0f);
+constexpr Vector4 Vector4::MINUS_X_AXIS		= Vector4(-1.0f, 0.f,  0.f, 1.0f);
+constexpr Vector4 Vector4::MINUS_Y_AXIS		= Vector4(0.f,	-1.0f, 0.f, 1.0f);
+constexpr Vector4 Vector4::MINUS_Z_AXIS		= Vector4(0.f,	 0.f, -1.f, 1.0f);
 
 
 //-----------------------------------------------------------------------------------------------
@@ -16,26 +16,26 @@ public:
 	//-----Public Methods-----
 
 	// Construction/Destruction
-	~Vector4() {}																			// destructor: do nothing (for speed)
+	~Vector4() = default;																	// destructor: do nothing (for speed)
 	Vector4() {}																			// default constructor: do nothing (for speed)
-	Vector4( const Vector4& copyFrom );														// copy constructor (from another vec2)
-	explicit Vector4( float initialX, float initialY, float initialZ, float initialW);		// explicit constructor (from x, y, z, w)
+	constexpr Vector4( const Vector4& copyFrom ) = default;									// copy constructor (from another vec2)
+	constexpr explicit Vector4( float initialX, float initialY, float initialZ, float initialW);	// explicit constructor (from x, y, z, w)
 
-	explicit Vector4(const Vector3& xyzVector, float wValue);
+	constexpr explicit Vector4(const Vector3& xyzVector, float wValue);
 																			// Operators
-	const	Vector4 operator+( const Vector4& vecToAdd ) const;				// vec3 + vec3
-	const	Vector4 operator-( const Vector4& vecToSubtract ) const;		// vec3 - vec3
-	const	Vector4 operator*( float uniformScale ) const;					// vec3 * float
-	const	Vector4 operator/( float inverseScale ) const;					// vec3 / float
-	void	operator+=( const Vector4& vecToAdd );							// vec3 += vec3
-	void	operator-=( const Vector4& vecToSubtract );						// vec3 -= vec3
-	void	operator*=( const float uniformScale );							// vec3 *= float
-	void	operator/=( const float uniformDivisor );						// vec3 /= float
-	void	operator=( const Vector4& copyFrom );							// vec3 = vec3
-	bool	operator==( const Vector4& compare ) const;						// vec3 == vec3
-	bool	operator!=( const Vector4& compare ) const;						// vec3 != vec3
-
-	friend const Vector4 operator*( float uniformScale, const Vector4& vecToScale );	// float * vec2
+	constexpr const	Vector4 operator+( const Vector4& vecToAdd ) const;		// vec3 + vec3
+	constexpr const	Vector4 operator-( const Vector4& vecToSubtract ) const;	// vec3 - vec3
+	constexpr const	Vector4 operator*( float uniformScale ) const;			// vec3 * float
+	constexpr const	Vector4 operator/( float inverseScale ) const;			// vec3 / float
+	constexpr void	operator+=( const Vector4& vecToAdd );					// vec3 += vec3
+	constexpr void	operator-=( const Vector4& vecToSubtract );				// vec3 -= vec3
+	constexpr void	operator*=( const float uniformScale );					// vec3 *= float
+	constexpr void	operator/=( const float uniformDivisor );				// vec3 /= float
+	Vector4&	operator=( const Vector4& copyFrom ) = default;				// vec3 = vec3
+	constexpr bool	operator==( const Vector4& compare ) const;				// vec3 == vec3
+	constexpr bool	operator!=( const Vector4& compare ) const;				// vec3 != vec3
+
+	friend constexpr const Vector4 operator*( float uniformScale, const Vector4& vecToScale );	// float * vec2
 
 	float	GetLength() const;									// Calculates the magnitude of the vector
 	float	GetLengthSquared() const;							// Calculates the squared magnitude of the vector
@@ -64,4 +64,127 @@ public:
 	float w;
 };
 
+
+///////////////////////////////////////////////////////////////////////////////
+// Constexpr definitions - in the header so constants and tables built from
+// them are worked out at compile time
+///////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------------------------
+// Explicit constructor
+constexpr Vector4::Vector4( float initialX, float initialY, float initialZ, float initialW)
+	: x( initialX )
+	, y( initialY )
+	, z(initialZ)
+	, w(initialW)
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor from Vector3
+constexpr Vector4::Vector4(const Vector3& xyzVector, float wValue)
+	: x(xyzVector.x), y(xyzVector.y), z(xyzVector.z), w(wValue)
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const Vector4 Vector4::operator + ( const Vector4& vecToAdd ) const
+{
+	return Vector4( (x + vecToAdd.x), (y + vecToAdd.y), (z + vecToAdd.z), (w + vecToAdd.w));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const Vector4 Vector4::operator-( const Vector4& vecToSubtract ) const
+{
+	return Vector4( (x - vecToSubtract.x), (y - vecToSubtract.y) , (z - vecToSubtract.z), (w - vecToSubtract.w));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const Vector4 Vector4::operator*( float uniformScale ) const
+{
+	return Vector4( (x * uniformScale), (y * uniformScale), (z * uniformScale), (w * uniformScale));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const Vector4 Vector4::operator/( float inverseScale ) const
+{
+	float multScaler = (1.f / inverseScale);
+	return Vector4( (x * multScaler), (y * multScaler), (z * multScaler), (w * multScaler) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr void Vector4::operator+=( const Vector4& vecToAdd )
+{
+	x += vecToAdd.x;
+	y += vecToAdd.y;
+	z += vecToAdd.z;
+	w += vecToAdd.w;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr void Vector4::operator-=( const Vector4& vecToSubtract )
+{
+	x -= vecToSubtract.x;
+	y -= vecToSubtract.y;
+	z -= vecToSubtract.z;
+	w -= vecToSubtract.w;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr void Vector4::operator*=( const float uniformScale )
+{
+	x *= uniformScale;
+	y *= uniformScale;
+	z *= uniformScale;
+	w *= uniformScale;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr void Vector4::operator/=( const float uniformDivisor )
+{
+	float multScaler = (1.f / uniformDivisor);
+
+	x *= multScaler;
+	y *= multScaler;
+	z *= multScaler;
+	w *= multScaler;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr bool Vector4::operator==( const Vector4& compare ) const
+{
+	if (x == compare.x && y == compare.y && z == compare.z && w == compare.w) {
+		return true;
+	}
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr bool Vector4::operator!=( const Vector4& compare ) const
+{
+	if ( x != compare.x || y != compare.y || z != compare.z || w != compare.w) {
+		return true;
+	}
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr const Vector4 operator*( float uniformScale, const Vector4& vecToScale )
+{
+	return Vector4( (vecToScale.x * uniformScale), (vecToScale.y * uniformScale), (vecToScale.z * uniformScale), (vecToScale.w * uniformScale) );
+}
+
+
 const Vector4 Interpolate(const Vector4& start, const Vector4& end, float fractionTowardEnd);
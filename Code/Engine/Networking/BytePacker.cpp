@@ -4,12 +4,18 @@
 /* Date: September 20th, 2018
 /* Description: Implementation of the BytePacker class
 /************************************************************************/
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Quaternion.hpp"
 #include "Engine/Core/LogSystem.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Networking/BytePacker.hpp"
+#include <math.h>
 #include <stdlib.h>
 #include <cstring>
 
+// Smallest three components of a normalized quaternion are within +-1/sqrt(2)
+#define QUATERNION_COMPONENT_RANGE (0.70710678f)
+
 //-----------------------------------------------------------------------------------------------
 // Constructor
 //
@@ -230,7 +236,7 @@ bool BytePacker::WriteString(const std::string& string)
 	WriteSize(characterCount);
 
 	// Make sure the buffer has enough room
-	if (GetRemainingWritableByteCount() < characterCount)
+	if (GetRemainingWritableByteCount() < (size_t)characterCount)
 	{
 		bool expanded = ExpandBuffer(characterCount);
 
@@ -268,12 +274,264 @@ size_t BytePacker::ReadString(std::string& out_string)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Writes the low bitCount bits of value, writing out each byte as it fills
+//
+bool BytePacker::WriteBits(uint32_t value, int bitCount)
+{
+	ASSERT_OR_DIE(bitCount >= 1 && bitCount <= 32, Stringf("Error: BytePacker::WriteBits() called with %i bits", bitCount).c_str());
+
+	if (bitCount < 32)
+	{
+		value &= (1u << bitCount) - 1;
+	}
+
+	// Push the bits through in chunks that always fit on top of the pending ones
+	int bitsLeft = bitCount;
+	while (bitsLeft > 0)
+	{
+		int chunkSize = MinInt(bitsLeft, 8);
+
+		m_bitWriteBuffer |= (value & ((1u << chunkSize) - 1)) << m_bitWriteCount;
+		m_bitWriteCount += chunkSize;
+
+		value >>= chunkSize;
+		bitsLeft -= chunkSize;
+
+		while (m_bitWriteCount >= 8)
+		{
+			uint8_t byte = (uint8_t) (m_bitWriteBuffer & 0xFF);
+			if (!WriteBytes(1, &byte))
+			{
+				return false;
+			}
+
+			m_bitWriteBuffer >>= 8;
+			m_bitWriteCount -= 8;
+		}
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes a single bit
+//
+bool BytePacker::WriteBit(bool value)
+{
+	return WriteBits((value ? 1 : 0), 1);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes out the partial byte left from bit writes, padded with zeros
+//
+bool BytePacker::FlushBits()
+{
+	if (m_bitWriteCount == 0)
+	{
+		return true;
+	}
+
+	uint8_t byte = (uint8_t) (m_bitWriteBuffer & 0xFF);
+	m_bitWriteBuffer = 0;
+	m_bitWriteCount = 0;
+
+	return WriteBytes(1, &byte);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads bitCount bits into out_value, reading in each byte as it's needed
+// Returns false if the buffer ran out first
+//
+bool BytePacker::ReadBits(uint32_t& out_value, int bitCount)
+{
+	ASSERT_OR_DIE(bitCount >= 1 && bitCount <= 32, Stringf("Error: BytePacker::ReadBits() called with %i bits", bitCount).c_str());
+
+	out_value = 0;
+	int bitsRead = 0;
+
+	while (bitsRead < bitCount)
+	{
+		if (m_bitReadCount == 0)
+		{
+			uint8_t byte;
+			if (ReadBytes(&byte, 1) == 0)
+			{
+				return false;
+			}
+
+			m_bitReadBuffer = byte;
+			m_bitReadCount = 8;
+		}
+
+		int chunkSize = MinInt(bitCount - bitsRead, m_bitReadCount);
+
+		out_value |= (m_bitReadBuffer & ((1u << chunkSize) - 1)) << bitsRead;
+		m_bitReadBuffer >>= chunkSize;
+		m_bitReadCount -= chunkSize;
+		bitsRead += chunkSize;
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads a single bit
+//
+bool BytePacker::ReadBit(bool& out_value)
+{
+	uint32_t value;
+	bool success = ReadBits(value, 1);
+
+	out_value = (value != 0);
+	return success;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Drops the rest of the partial byte, so the read head is back on the byte after the bits
+//
+void BytePacker::EndBitRead()
+{
+	m_bitReadBuffer = 0;
+	m_bitReadCount = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the value as bitCount bits of fixed point over the range
+//
+bool BytePacker::WriteQuantizedFloat(float value, float minValue, float maxValue, int bitCount)
+{
+	double maxQuantized = (double) (bitCount == 32 ? 0xFFFFFFFF : (1u << bitCount) - 1);
+
+	double normalized = (double) (value - minValue) / (double) (maxValue - minValue);
+	normalized = (normalized < 0.0 ? 0.0 : (normalized > 1.0 ? 1.0 : normalized));
+
+	uint32_t quantized = (uint32_t) (normalized * maxQuantized + 0.5);
+	return WriteBits(quantized, bitCount);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads a float written by WriteQuantizedFloat() with the same range and bit count
+//
+bool BytePacker::ReadQuantizedFloat(float& out_value, float minValue, float maxValue, int bitCount)
+{
+	double maxQuantized = (double) (bitCount == 32 ? 0xFFFFFFFF : (1u << bitCount) - 1);
+
+	uint32_t quantized;
+	bool success = ReadBits(quantized, bitCount);
+
+	out_value = minValue + (float) ((double) quantized / maxQuantized) * (maxValue - minValue);
+	return success;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the rotation with the smallest three encoding
+// q and -q are the same rotation, so the sign is flipped to make the dropped component positive
+//
+bool BytePacker::WriteQuaternion(const Quaternion& rotation, int bitsPerComponent /*= 10*/)
+{
+	float components[4] = { rotation.s, rotation.v.x, rotation.v.y, rotation.v.z };
+
+	int largestIndex = 0;
+	for (int index = 1; index < 4; ++index)
+	{
+		if (AbsoluteValue(components[index]) > AbsoluteValue(components[largestIndex]))
+		{
+			largestIndex = index;
+		}
+	}
+
+	float sign = (components[largestIndex] < 0.f ? -1.f : 1.f);
+
+	bool success = WriteBits((uint32_t) largestIndex, 2);
+
+	for (int index = 0; index < 4; ++index)
+	{
+		if (index != largestIndex)
+		{
+			success = WriteQuantizedFloat(sign * components[index], -QUATERNION_COMPONENT_RANGE, QUATERNION_COMPONENT_RANGE, bitsPerComponent) && success;
+		}
+	}
+
+	return success;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads a rotation written by WriteQuaternion(), rebuilding the largest component from the unit length
+//
+bool BytePacker::ReadQuaternion(Quaternion& out_rotation, int bitsPerComponent /*= 10*/)
+{
+	uint32_t largestIndex;
+	bool success = ReadBits(largestIndex, 2);
+
+	float components[4];
+	float sumOfSquares = 0.f;
+
+	for (int index = 0; index < 4; ++index)
+	{
+		if (index != (int) largestIndex)
+		{
+			success = ReadQuantizedFloat(components[index], -QUATERNION_COMPONENT_RANGE, QUATERNION_COMPONENT_RANGE, bitsPerComponent) && success;
+			sumOfSquares += components[index] * components[index];
+		}
+	}
+
+	components[largestIndex] = sqrtf(MaxFloat(1.f - sumOfSquares, 0.f));
+
+	out_rotation = Quaternion(components[0], components[1], components[2], components[3]);
+	return success;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the number of significant bits minus one in 5 bits, then the significant bits
+//
+bool BytePacker::WriteVariableBitUInt(uint32_t value)
+{
+	int bitCount = 1;
+	while (bitCount < 32 && (value >> bitCount) != 0)
+	{
+		bitCount++;
+	}
+
+	bool success = WriteBits((uint32_t) (bitCount - 1), 5);
+	return WriteBits(value, bitCount) && success;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads a value written by WriteVariableBitUInt()
+//
+bool BytePacker::ReadVariableBitUInt(uint32_t& out_value)
+{
+	uint32_t bitCountMinusOne;
+	if (!ReadBits(bitCountMinusOne, 5))
+	{
+		out_value = 0;
+		return false;
+	}
+
+	return ReadBits(out_value, (int) bitCountMinusOne + 1);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Resets the write (and read) head to the start of the buffer
 //
 void BytePacker::ResetWrite()
 {
 	m_writeHead = 0;
+	m_bitWriteBuffer = 0;
+	m_bitWriteCount = 0;
 	ResetRead();
 }
 
@@ -284,6 +542,8 @@ void BytePacker::ResetWrite()
 void BytePacker::ResetRead()
 {
 	m_readHead = 0;
+	m_bitReadBuffer = 0;
+	m_bitReadCount = 0;
 }
 
 
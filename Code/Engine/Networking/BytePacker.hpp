@@ -9,6 +9,8 @@
 #include <string>
 #include <stdint.h>
 
+class Quaternion;
+
 class BytePacker
 {
 
@@ -55,6 +57,29 @@ public:
 	bool			WriteString(const std::string& string);
 	size_t			ReadString(std::string& out_string); // max_str_size should be enough to contain the null terminator as well; 
 
+	// Bit packing - bits are written low bit first into whole bytes at the write head, so a run of
+	// bit writes must end with FlushBits() before any byte writes, and reads must mirror it with EndBitRead()
+	bool			WriteBits(uint32_t value, int bitCount);	// bitCount of 1 to 32
+	bool			WriteBit(bool value);
+	bool			FlushBits();								// Pads the last partial byte with zeros
+	bool			ReadBits(uint32_t& out_value, int bitCount);
+	bool			ReadBit(bool& out_value);
+	void			EndBitRead();								// Skips the padding of the last partial byte
+
+	// Clamps to [minValue, maxValue] and spends bitCount bits on it, so the error is at most half a step
+	// of (maxValue - minValue) / (2^bitCount - 1)
+	bool			WriteQuantizedFloat(float value, float minValue, float maxValue, int bitCount);
+	bool			ReadQuantizedFloat(float& out_value, float minValue, float maxValue, int bitCount);
+
+	// Smallest three - 2 bits for the largest component, which is rebuilt on read, and bitsPerComponent
+	// for each of the other three; the rotation has to be normalized
+	bool			WriteQuaternion(const Quaternion& rotation, int bitsPerComponent = 10);
+	bool			ReadQuaternion(Quaternion& out_rotation, int bitsPerComponent = 10);
+
+	// 5 bits of bit count, then only the significant bits, so small values stay small
+	bool			WriteVariableBitUInt(uint32_t value);
+	bool			ReadVariableBitUInt(uint32_t& out_value);
+
 	// HELPERS
 	void			ResetWrite();  // resets writing to the beginning of the buffer.  Make sure read head stays valid (<= write_head)
 	void			ResetRead();   // resets reading to the beginning of the buffer
@@ -74,12 +99,18 @@ protected:
 	//-----Protected Data----
 	
 	uint8_t*		m_buffer = nullptr;
-	size_t			m_bufferCapacity;
+	size_t			m_bufferCapacity = 0;
 	bool			m_ownsMemory = true;
 
-	size_t			m_readHead;
-	size_t			m_writeHead;
+	size_t			m_readHead = 0;
+	size_t			m_writeHead = 0;
 
 	eEndianness		m_endianness;
 
+	// Bits not yet filling a whole byte, low bit first
+	uint32_t		m_bitWriteBuffer = 0;
+	int				m_bitWriteCount = 0;
+	uint32_t		m_bitReadBuffer = 0;
+	int				m_bitReadCount = 0;
+
 };
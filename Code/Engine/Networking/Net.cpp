@@ -8,6 +8,7 @@
 #include "Engine/Core/LogSystem.hpp"
 #include "Engine/Networking/TCPSocket.hpp"
 #include "Engine/Networking/NetAddress.hpp"
+#include "Engine/Networking/NetSoakTest.hpp"
 #include "Engine/Core/DeveloperConsole/Command.hpp"
 #include "Engine/Core/Utility/ErrorWarningAssert.hpp"
 
@@ -39,6 +40,7 @@ bool Net::Initialize()
 	if (success)
 	{
 		s_isRunning = true;
+		NetSoakTest::InitializeConsoleCommands();
 	}
 	
 	return success;
@@ -0,0 +1,327 @@
+/************************************************************************/
+/* File: NetCapture.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the NetCapture classes
+/************************************************************************/
+#include "Engine/Core/File.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/Time/Time.hpp"
+#include "Engine/Networking/NetCapture.hpp"
+#include <string.h>
+
+#define NET_CAPTURE_FILE_HEADER_SIZE (sizeof(uint32_t) + sizeof(uint16_t))
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Appends the bytes of the value to the buffer
+//
+template <typename T>
+void AppendToCaptureBuffer(std::vector<uint8_t>& buffer, const T& value)
+{
+	const uint8_t* bytes = (const uint8_t*) &value;
+	buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Reads a value out of the data at offset, advancing it
+//
+template <typename T>
+T ReadFromCaptureData(const uint8_t* data, size_t& offset)
+{
+	T value;
+	memcpy(&value, data + offset, sizeof(T));
+	offset += sizeof(T);
+
+	return value;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+NetCaptureWriter::NetCaptureWriter()
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor - writes out anything still buffered
+//
+NetCaptureWriter::~NetCaptureWriter()
+{
+	Close();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Creates the capture file and starts its clock, replacing any capture already open
+//
+bool NetCaptureWriter::Open(const std::string& filePath)
+{
+	Close();
+
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	m_file = new File();
+	if (!m_file->Open(filePath.c_str(), "wb"))
+	{
+		LogTaggedPrintf("NET", "Error: NetCaptureWriter::Open() couldn't open file \"%s\"", filePath.c_str());
+
+		delete m_file;
+		m_file = nullptr;
+		return false;
+	}
+
+	m_buffer.clear();
+	m_buffer.reserve(NET_CAPTURE_FLUSH_SIZE + NET_CAPTURE_RECORD_HEADER_SIZE + UINT16_MAX);
+
+	AppendToCaptureBuffer(m_buffer, (uint32_t) NET_CAPTURE_MAGIC);
+	AppendToCaptureBuffer(m_buffer, (uint16_t) NET_CAPTURE_VERSION);
+
+	m_startHPC = GetPerformanceCounter();
+	m_recordCount = 0;
+	m_isOpen = true;
+
+	LogTaggedPrintf("NET", "Started capturing traffic to \"%s\"", filePath.c_str());
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the rest of the records and closes the file
+//
+void NetCaptureWriter::Close()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	if (m_file == nullptr)
+	{
+		return;
+	}
+
+	m_isOpen = false;
+	FlushBuffer();
+
+	LogTaggedPrintf("NET", "Stopped capturing traffic to \"%s\", %u records written", m_file->GetFilePathOpened().c_str(), m_recordCount);
+
+	m_file->Close();
+	delete m_file;
+	m_file = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if records are being written
+//
+bool NetCaptureWriter::IsOpen() const
+{
+	return m_isOpen;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a record of the bytes sent to or received from the address, timestamped now
+//
+void NetCaptureWriter::Record(eNetCaptureRecordType type, const NetAddress_t& address, const void* data, size_t byteCount)
+{
+	if (!m_isOpen || byteCount > UINT16_MAX)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	// Closed while waiting on the lock
+	if (m_file == nullptr)
+	{
+		return;
+	}
+
+	float time = (float) TimeSystem::PerformanceCountToSeconds(GetPerformanceCounter() - m_startHPC);
+
+	AppendToCaptureBuffer(m_buffer, time);
+	AppendToCaptureBuffer(m_buffer, (uint8_t) type);
+	AppendToCaptureBuffer(m_buffer, (uint32_t) address.ipv4Address);
+	AppendToCaptureBuffer(m_buffer, (uint16_t) address.port);
+	AppendToCaptureBuffer(m_buffer, (uint16_t) byteCount);
+
+	const uint8_t* bytes = (const uint8_t*) data;
+	m_buffer.insert(m_buffer.end(), bytes, bytes + byteCount);
+
+	m_recordCount++;
+
+	if (m_buffer.size() >= NET_CAPTURE_FLUSH_SIZE)
+	{
+		FlushBuffer();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of records written since the capture was opened
+//
+unsigned int NetCaptureWriter::GetRecordCount() const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	return m_recordCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the buffered records to the file
+//
+void NetCaptureWriter::FlushBuffer()
+{
+	if (m_buffer.size() > 0)
+	{
+		m_file->Write(m_buffer.data(), m_buffer.size());
+		m_file->Flush();
+		m_buffer.clear();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+NetCaptureReader::NetCaptureReader()
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+NetCaptureReader::~NetCaptureReader()
+{
+	Close();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Loads the capture file into memory and checks its header
+//
+bool NetCaptureReader::Open(const std::string& filePath)
+{
+	Close();
+
+	m_file = new File();
+	if (!m_file->Open(filePath.c_str(), "rb") || !m_file->LoadFileToMemory())
+	{
+		LogTaggedPrintf("NET", "Error: NetCaptureReader::Open() couldn't load file \"%s\"", filePath.c_str());
+
+		Close();
+		return false;
+	}
+
+	m_data = (const uint8_t*) m_file->GetData();
+	m_size = m_file->GetSize();
+	m_offset = 0;
+
+	if (m_size < NET_CAPTURE_FILE_HEADER_SIZE)
+	{
+		LogTaggedPrintf("NET", "Error: NetCaptureReader::Open() file \"%s\" is too small to be a capture", filePath.c_str());
+
+		Close();
+		return false;
+	}
+
+	uint32_t magic = ReadFromCaptureData<uint32_t>(m_data, m_offset);
+	uint16_t version = ReadFromCaptureData<uint16_t>(m_data, m_offset);
+
+	if (magic != NET_CAPTURE_MAGIC || version != NET_CAPTURE_VERSION)
+	{
+		LogTaggedPrintf("NET", "Error: NetCaptureReader::Open() file \"%s\" isn't a version %i capture", filePath.c_str(), NET_CAPTURE_VERSION);
+
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Frees the loaded capture
+//
+void NetCaptureReader::Close()
+{
+	if (m_file != nullptr)
+	{
+		m_file->Close();
+		delete m_file;
+		m_file = nullptr;
+	}
+
+	m_data = nullptr;
+	m_size = 0;
+	m_offset = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if a capture is loaded
+//
+bool NetCaptureReader::IsOpen() const
+{
+	return (m_data != nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the next record without moving past it
+//
+bool NetCaptureReader::PeekNextRecord(NetCaptureRecord_t& out_record) const
+{
+	if (m_data == nullptr || m_size - m_offset < NET_CAPTURE_RECORD_HEADER_SIZE)
+	{
+		return false;
+	}
+
+	size_t offset = m_offset;
+
+	out_record.time = ReadFromCaptureData<float>(m_data, offset);
+	uint8_t type = ReadFromCaptureData<uint8_t>(m_data, offset);
+	out_record.address.ipv4Address = ReadFromCaptureData<uint32_t>(m_data, offset);
+	out_record.address.port = ReadFromCaptureData<uint16_t>(m_data, offset);
+	out_record.byteCount = ReadFromCaptureData<uint16_t>(m_data, offset);
+
+	if (type >= NUM_NET_CAPTURE_RECORD_TYPES || m_size - offset < out_record.byteCount)
+	{
+		return false;
+	}
+
+	out_record.type = (eNetCaptureRecordType) type;
+	out_record.data = m_data + offset;
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the next record and moves past it
+//
+bool NetCaptureReader::GetNextRecord(NetCaptureRecord_t& out_record)
+{
+	if (!PeekNextRecord(out_record))
+	{
+		return false;
+	}
+
+	m_offset += NET_CAPTURE_RECORD_HEADER_SIZE + out_record.byteCount;
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Goes back to the first record
+//
+void NetCaptureReader::Rewind()
+{
+	if (m_data != nullptr)
+	{
+		m_offset = NET_CAPTURE_FILE_HEADER_SIZE;
+	}
+}
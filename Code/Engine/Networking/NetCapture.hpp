@@ -0,0 +1,114 @@
+/************************************************************************/
+/* File: NetCapture.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Classes to record sent and received network traffic to a
+/*				file, and to read it back for replaying
+/************************************************************************/
+#pragma once
+#include "Engine/Networking/NetAddress.hpp"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+class File;
+
+// File layout - the magic and version, then records back to back, each a header and its bytes
+#define NET_CAPTURE_MAGIC (0x5041434e)				// "NCAP"
+#define NET_CAPTURE_VERSION (1)
+#define NET_CAPTURE_RECORD_HEADER_SIZE (13)			// Time, type, ip, port and byte count
+#define NET_CAPTURE_FLUSH_SIZE (64 * 1024)			// Records are buffered until there's this much to write
+
+enum eNetCaptureRecordType : uint8_t
+{
+	NET_CAPTURE_UDP_RECEIVED = 0,
+	NET_CAPTURE_UDP_SENT,
+	NET_CAPTURE_TCP_RECEIVED,		// Whole messages without their length prefix, not the stream chunks they arrived in
+	NET_CAPTURE_TCP_SENT,
+	NUM_NET_CAPTURE_RECORD_TYPES
+};
+
+// A record read from a capture, the data points into the reader's copy of the file
+struct NetCaptureRecord_t
+{
+	float					time = 0.f;			// Seconds since the capture started
+	eNetCaptureRecordType	type = NET_CAPTURE_UDP_RECEIVED;
+	NetAddress_t			address;			// The sender for received records, receiver for sent
+	uint16_t				byteCount = 0;
+	const uint8_t*			data = nullptr;
+};
+
+
+class NetCaptureWriter
+{
+public:
+	//-----Public Methods-----
+
+	NetCaptureWriter();
+	~NetCaptureWriter();
+
+	NetCaptureWriter(const NetCaptureWriter& copy) = delete;
+	NetCaptureWriter& operator=(const NetCaptureWriter& copy) = delete;
+
+	bool	Open(const std::string& filePath);
+	void	Close();
+	bool	IsOpen() const;
+
+	// Thread safe, and cheap to call while closed
+	void	Record(eNetCaptureRecordType type, const NetAddress_t& address, const void* data, size_t byteCount);
+
+	unsigned int	GetRecordCount() const;
+
+
+private:
+	//-----Private Methods-----
+
+	void	FlushBuffer();	// m_lock must be held
+
+
+private:
+	//-----Private Data-----
+
+	std::atomic<bool>		m_isOpen{ false };
+	mutable std::mutex		m_lock;
+	File*					m_file = nullptr;
+	std::vector<uint8_t>	m_buffer;
+	uint64_t				m_startHPC = 0;
+	unsigned int			m_recordCount = 0;
+
+};
+
+
+class NetCaptureReader
+{
+public:
+	//-----Public Methods-----
+
+	NetCaptureReader();
+	~NetCaptureReader();
+
+	NetCaptureReader(const NetCaptureReader& copy) = delete;
+	NetCaptureReader& operator=(const NetCaptureReader& copy) = delete;
+
+	// Loads the whole capture, returning false if it's missing or not a capture
+	bool	Open(const std::string& filePath);
+	void	Close();
+	bool	IsOpen() const;
+
+	// Records come out in the order they were captured; returns false at the end, or on a truncated record
+	bool	PeekNextRecord(NetCaptureRecord_t& out_record) const;
+	bool	GetNextRecord(NetCaptureRecord_t& out_record);
+	void	Rewind();
+
+
+private:
+	//-----Private Data-----
+
+	File*					m_file = nullptr;
+	const uint8_t*			m_data = nullptr;
+	size_t					m_size = 0;
+	size_t					m_offset = 0;
+
+};
@@ -8,15 +8,19 @@
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Core/Time/Clock.hpp"
 #include "Engine/Core/Time/Stopwatch.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
 #include "Engine/Networking/UDPSocket.hpp"
 #include "Engine/Networking/NetPacket.hpp"
 #include "Engine/Networking/NetMessage.hpp"
 #include "Engine/Networking/NetSession.hpp"
 #include "Engine/Networking/NetConnection.hpp"
+#include "Engine/Networking/NetObjectView.hpp"
 #include "Engine/Networking/NetObjectSystem.hpp"
+#include <algorithm>
 
 #define RELIABLE_RESEND_INTERVAL (0.1) // 100 ms
-#define RELIABLE_WINDOW (32)
+#define RELIABLE_EARLY_RESEND_INTERVAL (0.05) // Age a reliable may be resent at to fill a packet that's going out anyway
+#define HEARTBEAT_PIGGYBACK_FRACTION (0.5f) // Of the heartbeat interval elapsed, for a heartbeat to ride along with other traffic
 
 
 //- C FUNCTION ----------------------------------------------------------------------------------------------
@@ -40,6 +44,8 @@ NetConnection::NetConnection(NetSession* session, const NetConnectionInfo_t& con
 	{
 		m_heartbeatTimer.SetInterval(m_owningSession->GetHeartbeatInterval());
 	}
+
+	m_bandwidthTimer.SetInterval(BANDWIDTH_MEASURE_INTERVAL);
 }
 
 
@@ -55,14 +61,15 @@ NetConnection::~NetConnection()
 
 	m_outboundUnreliables.clear();
 
-	for (int i = 0; i < (int)m_unconfirmedReliables.size(); ++i)
+	for (int i = 0; i < RELIABLE_WINDOW; ++i)
 	{
 		delete m_unconfirmedReliables[i];
+		m_unconfirmedReliables[i] = nullptr;
 	}
 
-	m_unconfirmedReliables.clear();
+	m_unconfirmedReliableCount = 0;
 
-	for (int i = 0; i < m_unsentReliables.size(); ++i)
+	for (int i = 0; i < (int)m_unsentReliables.size(); ++i)
 	{
 		delete m_unsentReliables[i];
 	}
@@ -90,6 +97,18 @@ void NetConnection::SetConnectionState(eConnectionState state)
 //
 void NetConnection::Send(NetMessage* msg)
 {
+	m_owningSession->LockNetState();
+
+	// Packed once here, so resends don't pay for it again
+	if (msg->IsCompressed() && !msg->PackPayload())
+	{
+		LogTaggedPrintf("NET", "Error: Dropped message %s to index %i, it couldn't be packed", msg->GetDefinition()->name.c_str(), m_connectionInfo.sessionIndex);
+		delete msg;
+
+		m_owningSession->UnlockNetState();
+		return;
+	}
+
 	if (msg->IsReliable())
 	{
 		if (msg->IsInOrder())
@@ -109,6 +128,8 @@ void NetConnection::Send(NetMessage* msg)
 
 	ConsolePrintf("Message sent: %s", msg->GetDefinition()->name.c_str());
 	LogTaggedPrintf("NET", "Message sent to index %i: %s", m_connectionInfo.sessionIndex, msg->GetDefinition()->name.c_str());
+
+	m_owningSession->UnlockNetState();
 }
 
 
@@ -125,13 +146,35 @@ bool IsReliableReadyForResend(NetMessage* message)
 }
 
 
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns true if the reliable message is old enough to be resent early, in space a packet has left over
+//
+bool IsReliableReadyForEarlyResend(NetMessage* message)
+{
+	float totalTime = Clock::GetMasterClock()->GetTotalSeconds();
+
+	return (totalTime - message->GetLastSentTime() >= RELIABLE_EARLY_RESEND_INTERVAL);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Sort comparator for packing unreliables largest first
+//
+bool IsMessageLarger(const NetMessage* first, const NetMessage* second)
+{
+	return (first->GetHeaderSize() + first->GetPayloadSize() > second->GetHeaderSize() + second->GetPayloadSize());
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Sends all pending messages out of the socket
 //
 void NetConnection::FlushMessages()
 {
-	// Package them all into one NetPacket
-	NetPacket* packet = new NetPacket();
+	PROFILE_SCOPE_CATEGORY("NetConnection::FlushMessages", "Net");
+
+	// Package them all into one NetPacket, sent with the session's other outgoing packets
+	NetPacket* packet = m_owningSession->GetOutgoingPacket();
 	packet->AdvanceWriteHead(PACKET_HEADER_SIZE); // Advance the write head now, and write the header later
 	packet->SetSenderConnectionIndex(m_owningSession->GetLocalConnectionIndex());
 	packet->SetReceiverConnectionIndex(m_connectionInfo.sessionIndex);
@@ -139,19 +182,28 @@ void NetConnection::FlushMessages()
 	uint8_t messagesWritten = 0;
 	PacketTracker_t* tracker = CreateTrackerForAck(m_nextAckToSend);
 
-	// Write unconfirmed messages first
-	int unconfirmedCount = (int) m_unconfirmedReliables.size();
-	
-	for (int unconfirmedIndex = 0; unconfirmedIndex < unconfirmedCount; ++unconfirmedIndex)
+	// Write unconfirmed messages first, oldest first
+	int unconfirmedRemaining = m_unconfirmedReliableCount;
+
+	for (int offset = 0; offset < RELIABLE_WINDOW && unconfirmedRemaining > 0; ++offset)
 	{
-		if (IsReliableReadyForResend(m_unconfirmedReliables[unconfirmedIndex]))
+		NetMessage* unconfirmedMessage = m_unconfirmedReliables[(uint16_t)(m_oldestUnconfirmedReliableID + offset) % RELIABLE_WINDOW];
+
+		if (unconfirmedMessage == nullptr)
 		{
-			bool success = packet->WriteMessage(m_unconfirmedReliables[unconfirmedIndex]);
+			continue;
+		}
+
+		--unconfirmedRemaining;
+
+		if (IsReliableReadyForResend(unconfirmedMessage))
+		{
+			bool success = WriteMessageToPacket(packet, unconfirmedMessage);
 
 			if (success)
 			{
-				tracker->AddReliableID(m_unconfirmedReliables[unconfirmedIndex]->GetReliableID());
-				m_unconfirmedReliables[unconfirmedIndex]->ResetTimeLastSent();
+				tracker->AddReliableID(unconfirmedMessage->GetReliableID());
+				unconfirmedMessage->ResetTimeLastSent();
 				++messagesWritten;
 			}
 		}
@@ -167,13 +219,13 @@ void NetConnection::FlushMessages()
 			unsentMessage->AssignReliableID(m_nextReliableIDToSend);
 			++m_nextReliableIDToSend;
 
-			if (packet->WriteMessage(unsentMessage))
+			if (WriteMessageToPacket(packet, unsentMessage))
 			{
 				tracker->AddReliableID(unsentMessage->GetReliableID());
 
 				// Update the lists
 				m_unsentReliables.erase(m_unsentReliables.begin());
-				m_unconfirmedReliables.push_back(unsentMessage);
+				AddUnconfirmedReliable(unsentMessage);
 				--unsentIndex;
 
 				unsentMessage->ResetTimeLastSent();
@@ -182,55 +234,111 @@ void NetConnection::FlushMessages()
 		}
 	}
 
-	// Write unreliables last
-	for (int msgIndex = 0; msgIndex < m_outboundUnreliables.size(); ++msgIndex)
+	// Write unreliables next, largest first so the small ones fill in the gaps left
+	std::stable_sort(m_outboundUnreliables.begin(), m_outboundUnreliables.end(), IsMessageLarger);
+
+	for (int msgIndex = 0; msgIndex < (int)m_outboundUnreliables.size(); ++msgIndex)
 	{
 		NetMessage* msg = m_outboundUnreliables[msgIndex];
 
 		// Check if the message will fit
-		if (packet->CanFitMessage(msg))
+		if (packet->CanFitMessage(msg) && WriteMessageToPacket(packet, msg))
 		{
-			packet->WriteMessage(msg);
 			messagesWritten++;
 		}
+		else
+		{
+			m_owningSession->RecordMessageDropped(msg);
+		}
 
 		delete m_outboundUnreliables[msgIndex];
 	}
 	
-	// If we have any snapshots to send and the room, send them out
-	bool done = false;
+	// Fill the rest with snapshots, highest priority first; ones that don't fit the packet or the budget
+	// keep their priority and are tried again next flush
 	NetObjectSystem* netObjSystem = m_owningSession->GetNetObjectSystem();
+	const std::vector<NetObjectView*>& objectViews = netObjSystem->GetSnapshotViewsByPriority(m_connectionInfo.sessionIndex);
+
+	size_t budgetRemaining = (size_t) (m_sendScale * (float) m_snapshotByteBudget);
+	int viewCount = (int) objectViews.size();
 
-	while (m_owningSession != nullptr && !done)
+	for (int viewIndex = 0; viewIndex < viewCount; ++viewIndex)
 	{
-		NetMessage snapshotMessage = NetMessage("netobj_update", m_owningSession);
-		bool hasUpdate = netObjSystem->GetNextSnapshotUpdateMessage(&snapshotMessage, m_connectionInfo.sessionIndex);
+		NetObjectView* objectView = objectViews[viewIndex];
 
-		if (hasUpdate && packet->CanFitMessage(&snapshotMessage))
+		NetMessage snapshotMessage = NetMessage(m_owningSession->GetMessageDefinitionByHash(NET_MESSAGE_HASH("netobj_update")));
+		if (!netObjSystem->WriteSnapshotUpdateMessage(objectView, &snapshotMessage))
 		{
-			bool success = packet->WriteMessage(&snapshotMessage);
-			if (success)
-			{
-				messagesWritten++;
-			}
-			else
-			{
-				done = true;
-			}
+			continue;
 		}
-		else
+
+		size_t messageSize = snapshotMessage.GetHeaderSize() + snapshotMessage.GetPayloadSize();
+		if (messageSize > budgetRemaining || !packet->CanFitMessage(&snapshotMessage))
+		{
+			continue;
+		}
+
+		if (!WriteMessageToPacket(packet, &snapshotMessage))
+		{
+			break;
+		}
+
+		messagesWritten++;
+		budgetRemaining -= messageSize;
+
+		// Stop once the tracker can't tell us which snapshots were acked
+		uint16_t sequence = objectView->CommitPendingSnapshot();
+		if (!tracker->AddSnapshot(objectView->GetNetObject()->GetNetworkID(), sequence))
+		{
+			break;
+		}
+	}
+
+	// If the packet is going out with data anyway, top it up with unconfirmed reliables that are close
+	// to their resend, so they don't need a packet of their own later
+	unconfirmedRemaining = (messagesWritten > 0 ? m_unconfirmedReliableCount : 0);
+
+	for (int offset = 0; offset < RELIABLE_WINDOW && unconfirmedRemaining > 0; ++offset)
+	{
+		NetMessage* unconfirmedMessage = m_unconfirmedReliables[(uint16_t)(m_oldestUnconfirmedReliableID + offset) % RELIABLE_WINDOW];
+
+		if (unconfirmedMessage == nullptr)
+		{
+			continue;
+		}
+
+		--unconfirmedRemaining;
+
+		// Ones already written to this packet were just reset, so are skipped here
+		if (IsReliableReadyForEarlyResend(unconfirmedMessage) && packet->CanFitMessage(unconfirmedMessage))
 		{
-			done = true;
+			if (WriteMessageToPacket(packet, unconfirmedMessage))
+			{
+				tracker->AddReliableID(unconfirmedMessage->GetReliableID());
+				unconfirmedMessage->ResetTimeLastSent();
+				++messagesWritten;
+			}
 		}
 	}
 
 	PacketHeader_t header = CreateHeaderForNextSend(messagesWritten);
 	packet->WriteHeader(header);
 
+	UpdateBandwidthMeasurement(packet->GetWrittenByteCount());
+
+	// Fill stats, over the same window as loss
+	m_fillBytesSent += packet->GetWrittenByteCount();
+	m_fillPacketsSent++;
+
+	if (m_fillPacketsSent >= LOSS_WINDOW_COUNT)
+	{
+		m_fillRatio = (float) m_fillBytesSent / (float) (m_fillPacketsSent * PACKET_MTU);
+		m_fillBytesSent = 0;
+		m_fillPacketsSent = 0;
+	}
+
 	// Update the latest ack sent for the connection
 	OnPacketSend(header);
-
-	m_owningSession->SendPacket(packet);
 		
 	// Clear the unreliable list, even if not all were sent
 	m_outboundUnreliables.clear();
@@ -241,6 +349,24 @@ void NetConnection::FlushMessages()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Sets the most bytes of snapshot updates written per flush
+//
+void NetConnection::SetSnapshotByteBudget(size_t byteBudget)
+{
+	m_snapshotByteBudget = byteBudget;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the most bytes of snapshot updates written per flush
+//
+size_t NetConnection::GetSnapshotByteBudget() const
+{
+	return m_snapshotByteBudget;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the name (ID) of the user this connection points to
 //
@@ -303,24 +429,50 @@ void NetConnection::SetNetTickRate(float hertz)
 
 //-----------------------------------------------------------------------------------------------
 // Returns whether the connection should send based on the tick rate of the connection and the owning
-// session
+// session, slowed by congestion control
+// The session only flushes on its own tick, so a connection at the session rate always sends on it
 //
 bool NetConnection::HasNetTickElapsed() const
+{
+	float sendInterval = GetSendInterval();
+
+	if (sendInterval <= m_owningSession->GetTimeBetweenSends())
+	{
+		return true;
+	}
+
+	return (m_sendTimer.GetElapsedTime() >= sendInterval);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the seconds between sends to this connection, the slower of the connection and session tick
+// rates divided by the send scale
+// A connection with no tick rate at either level stays unlimited, only its snapshot budget is scaled
+//
+float NetConnection::GetSendInterval() const
 {
 	float sessionTime = m_owningSession->GetTimeBetweenSends();
 	float sendInterval = MaxFloat(sessionTime, m_timeBetweenSends);
 
-	return (m_sendTimer.GetElapsedTime() >= sendInterval);
+	return (sendInterval / m_sendScale);
 }
 
 
 //-----------------------------------------------------------------------------------------------
 // Returns true if the connection should send a heartbeat
+// Heartbeats go out early if the connection is flushing this tick anyway, so they share its packet
+// instead of needing one of their own
 //
 bool NetConnection::HasHeartbeatElapsed()
 {
 	bool elapsed = m_heartbeatTimer.HasIntervalElapsed();
 
+	if (!elapsed && (HasOutboundMessages() || NeedsToForceSend()))
+	{
+		elapsed = (m_heartbeatTimer.GetElapsedTimeNormalized() >= HEARTBEAT_PIGGYBACK_FRACTION);
+	}
+
 	if (elapsed)
 	{
 		m_heartbeatTimer.SetInterval(m_owningSession->GetHeartbeatInterval());
@@ -371,7 +523,7 @@ void NetConnection::OnPacketSend(const PacketHeader_t& header)
 	tracker->timeSent = Clock::GetMasterClock()->GetTotalSeconds();
 
 	m_packetsSent++;
-	if (m_packetsSent >= LOSS_WINDOW_COUNT)
+	if (m_packetsSent >= (int)LOSS_WINDOW_COUNT)
 	{
 		UpdateLossCalculation();
 	}
@@ -395,6 +547,8 @@ void NetConnection::OnPacketSend(const PacketHeader_t& header)
 //
 bool NetConnection::OnPacketReceived(const PacketHeader_t& header)
 {
+	PROFILE_SCOPE_CATEGORY("NetConnection::OnPacketReceived", "Net");
+
 	// Call on the highest received ack
 	OnAckConfirmed(header.highestReceivedAck);
 
@@ -446,7 +600,12 @@ bool NetConnection::OnPacketReceived(const PacketHeader_t& header)
 			m_receivedBitfield |= mask;
 		}
 
-		// Force send next tick to maintain RTT
+		// Force send soon to maintain RTT, the ack is held a tick in case data goes out to carry it
+		if (!m_forceSendNextTick)
+		{
+			m_pendingAckTimer.Reset();
+		}
+
 		m_forceSendNextTick = true;
 	}
 	
@@ -457,21 +616,54 @@ bool NetConnection::OnPacketReceived(const PacketHeader_t& header)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the fraction of packets lost over the last loss window
+//
+float NetConnection::GetLoss() const
+{
+	return m_loss;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the congestion control scale on the send rate and snapshot budget, 1 being unthrottled
+//
+float NetConnection::GetSendScale() const
+{
+	return m_sendScale;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the bytes sent per second to this connection, as of the last measurement
+//
+float NetConnection::GetBytesPerSecond() const
+{
+	return m_bytesPerSecond;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns true if the connection has any pending outbound messages
 //
 bool NetConnection::HasOutboundMessages() const
 {
-	return (m_unsentReliables.size() > 0 || m_unconfirmedReliables.size() > 0 || m_outboundUnreliables.size() > 0);
+	return (m_unsentReliables.size() > 0 || m_unconfirmedReliableCount > 0 || m_outboundUnreliables.size() > 0);
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Returns true if the connection should send a packet next frame to maintain RTT
+// Returns true if the connection should send a packet this frame to maintain RTT
+// Acks are only sent on their own once they've waited a net tick without other traffic to carry them
 //
 bool NetConnection::NeedsToForceSend() const
 {
-	return m_forceSendNextTick;
+	if (!m_forceSendNextTick)
+	{
+		return false;
+	}
+
+	return (m_pendingAckTimer.GetElapsedTime() >= GetSendInterval());
 }
 
 
@@ -480,8 +672,8 @@ bool NetConnection::NeedsToForceSend() const
 //
 std::string NetConnection::GetDebugInfo() const
 {
-	std::string debugText = Stringf("   %-*i%-*s%-*s%-*.2f%-*.2f%-*.2f%-*.2f%-*i%-*i%-*s",
-		6, m_connectionInfo.sessionIndex, 10, m_connectionInfo.name.c_str(), 21, m_connectionInfo.address.ToString().c_str(), 8, 1000.f * m_rtt, 7, m_loss, 7, m_lastReceivedTimer.GetElapsedTime(), 7, m_lastSentTimer.GetElapsedTime(), 8, m_nextAckToSend - 1, 8, m_highestReceivedAck, 10, GetStateAsString().c_str());
+	std::string debugText = Stringf("   %-*i%-*s%-*s%-*.2f%-*.2f%-*.2f%-*.1f%-*.2f%-*.2f%-*.2f%-*.2f%-*i%-*i%-*s",
+		6, m_connectionInfo.sessionIndex, 10, m_connectionInfo.name.c_str(), 21, m_connectionInfo.address.ToString().c_str(), 8, 1000.f * m_rtt, 7, m_loss, 7, m_fillRatio, 7, m_packetsPerSecond, 8, m_bytesPerSecond / 1024.f, 7, m_sendScale, 7, m_lastReceivedTimer.GetElapsedTime(), 7, m_lastSentTimer.GetElapsedTime(), 8, m_nextAckToSend - 1, 8, m_highestReceivedAck, 10, GetStateAsString().c_str());
 
 	return debugText;
 }
@@ -492,6 +684,8 @@ std::string NetConnection::GetDebugInfo() const
 //
 void NetConnection::OnAckConfirmed(uint16_t ack)
 {
+	PROFILE_SCOPE_CATEGORY("NetConnection::OnAckConfirmed", "Net");
+
 	PacketTracker_t* tracker = GetTrackerForAck(ack);
 
 	if (tracker == nullptr)
@@ -504,6 +698,11 @@ void NetConnection::OnAckConfirmed(uint16_t ack)
 
 	float timeDilation = (currentTime - tracker->timeSent);
 
+	if (m_lowestRTT < 0.f || timeDilation < m_lowestRTT)
+	{
+		m_lowestRTT = timeDilation;
+	}
+
 	// Blend in this RTT to our existing RTT
 	bool shouldUpdate = true;
 	for (int i = 1; i < m_nextAckToSend - ack; ++i)
@@ -524,17 +723,13 @@ void NetConnection::OnAckConfirmed(uint16_t ack)
 	// Remove reliable messages that have been confirmed
 	for (int reliableIndex = (int)tracker->m_reliablesInPacket - 1; reliableIndex >= 0 ; --reliableIndex)
 	{
-		uint16_t currID = tracker->m_sentReliableIDs[reliableIndex];
+		RemoveUnconfirmedReliable(tracker->m_sentReliableIDs[reliableIndex]);
+	}
 
-		for (int unconfirmedIndex = 0; unconfirmedIndex < (int)m_unconfirmedReliables.size(); ++unconfirmedIndex)
-		{
-			if (m_unconfirmedReliables[unconfirmedIndex]->GetReliableID() == currID)
-			{
-				delete m_unconfirmedReliables[unconfirmedIndex];
-				m_unconfirmedReliables.erase(m_unconfirmedReliables.begin() + unconfirmedIndex);
-				break;
-			}
-		}
+	// Snapshots in it can now be delta baselines
+	if (tracker->m_snapshotsInPacket > 0)
+	{
+		m_owningSession->GetNetObjectSystem()->OnSnapshotsAcked(m_connectionInfo.sessionIndex, *tracker);
 	}
 
 	// It has been received, so invalidate
@@ -604,82 +799,112 @@ void NetConnection::InvalidateTracker(uint16_t ack)
 
 
 //-----------------------------------------------------------------------------------------------
-// Returns the oldest unconfirmed reliable id that we sent
+// Returns true if the next reliable ID to send fits in the window after the oldest unconfirmed one
 //
 bool NetConnection::NextSendIsWithinReliableWindow() const
 {
-	// Get the oldest unconfirmed id
-	int unconfirmedCount = (int)m_unconfirmedReliables.size();
-	uint16_t oldestID = 0;
-	bool found = false;
-	for (int i = 0; i < unconfirmedCount; ++i)
+	if (m_unconfirmedReliableCount == 0)
 	{
-		if (!found || CycleLessThan(m_unconfirmedReliables[i]->GetReliableID(), oldestID))
-		{
-			oldestID = m_unconfirmedReliables[i]->GetReliableID();
-			found = true;
-		}
+		return true;
 	}
 
-	if (!found)
+	uint16_t distanceFromOldest = m_nextReliableIDToSend - m_oldestUnconfirmedReliableID;
+	return (distanceFromOldest < RELIABLE_WINDOW);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Puts the just sent reliable in its slot of the unconfirmed window
+//
+void NetConnection::AddUnconfirmedReliable(NetMessage* message)
+{
+	uint16_t reliableID = message->GetReliableID();
+	int slotIndex = reliableID % RELIABLE_WINDOW;
+
+	ASSERT_OR_DIE(m_unconfirmedReliables[slotIndex] == nullptr, Stringf("Error: NetConnection::AddUnconfirmedReliable() sent reliable %i outside the window", reliableID));
+
+	if (m_unconfirmedReliableCount == 0)
 	{
-		return true;
+		m_oldestUnconfirmedReliableID = reliableID;
 	}
 
-	// Ensure our next send would fit within the window
-	uint16_t maxIDCanSend = oldestID + RELIABLE_WINDOW;
-	return CycleLessThan(m_nextReliableIDToSend, maxIDCanSend);
+	m_unconfirmedReliables[slotIndex] = message;
+	m_unconfirmedReliableCount++;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes the reliable with the given ID if it's still unconfirmed, and moves the oldest ID up
+// past any slots already confirmed
+//
+void NetConnection::RemoveUnconfirmedReliable(uint16_t reliableID)
+{
+	int slotIndex = reliableID % RELIABLE_WINDOW;
+	NetMessage* message = m_unconfirmedReliables[slotIndex];
+
+	// Acks for a resend can come in after the message was already confirmed
+	if (message == nullptr || message->GetReliableID() != reliableID)
+	{
+		return;
+	}
+
+	delete message;
+	m_unconfirmedReliables[slotIndex] = nullptr;
+	m_unconfirmedReliableCount--;
+
+	if (reliableID != m_oldestUnconfirmedReliableID)
+	{
+		return;
+	}
+
+	while (m_unconfirmedReliableCount > 0 && m_unconfirmedReliables[m_oldestUnconfirmedReliableID % RELIABLE_WINDOW] == nullptr)
+	{
+		++m_oldestUnconfirmedReliableID;
+	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
 // Returns whether the reliable ID has already been processed (recently) by the connection
+// IDs older than the window are treated as received
 //
 bool NetConnection::HasReliableIDAlreadyBeenReceived(uint16_t reliableID) const
 {
-	int receivedCount = (int)m_receivedReliableIDs.size();
+	uint16_t distance = m_highestReceivedReliableID - reliableID;
 
-	// First check if it's outside the window
-	uint16_t minID = m_highestReceivedReliableID - RELIABLE_WINDOW + 1;
-	if (CycleLessThan(reliableID, minID))
+	// Newer than everything received so far
+	if ((distance & 0x8000) != 0)
 	{
-		return true;
+		return false;
 	}
 
-	// Within window, just check if it is in our received list
-	for (int receivedIndex = 0; receivedIndex < receivedCount; ++receivedIndex)
+	if (distance >= RELIABLE_WINDOW)
 	{
-		if (m_receivedReliableIDs[receivedIndex] == reliableID)
-		{
-			return true;
-		}
+		return true;
 	}
 
-	return false;
+	return ((m_receivedReliableBitfield & (1u << distance)) != 0);
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Stores the reliable ID on this connection's list of processed IDs
+// Marks the reliable ID as processed in the received window, sliding the window if it's the new highest
 //
 void NetConnection::AddProcessedReliableID(uint16_t reliableID)
 {
-	if (CycleLessThan(m_highestReceivedReliableID, reliableID))
+	uint16_t distance = m_highestReceivedReliableID - reliableID;
+
+	if ((distance & 0x8000) != 0)
 	{
+		uint16_t shift = reliableID - m_highestReceivedReliableID;
+		m_receivedReliableBitfield = (shift >= 32 ? 0 : (m_receivedReliableBitfield << shift));
+		m_receivedReliableBitfield |= 1u;
+
 		m_highestReceivedReliableID = reliableID;
 	}
-
-	m_receivedReliableIDs.push_back(reliableID);
-
-	for (int i = 0; i < (int) m_receivedReliableIDs.size(); ++i)
+	else if (distance < RELIABLE_WINDOW)
 	{
-		uint16_t minID = m_highestReceivedReliableID - RELIABLE_WINDOW + 1;
-
-		if (CycleLessThan(m_receivedReliableIDs[i], minID))
-		{
-			m_receivedReliableIDs.erase(m_receivedReliableIDs.begin() + i);
-			--i;
-		}
+		m_receivedReliableBitfield |= (1u << distance);
 	}
 }
 
@@ -694,6 +919,62 @@ void NetConnection::UpdateLossCalculation()
 	// Reset the current count for the next window
 	m_packetsSent = 0;
 	m_lossCount = 0;
+
+	UpdateCongestionControl();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adjusts the send scale for the loss window just finished - halved if it was congested, and stepped
+// back up otherwise, so the connection keeps probing for the rate the link can take
+//
+void NetConnection::UpdateCongestionControl()
+{
+	if (!m_owningSession->IsCongestionControlEnabled())
+	{
+		m_sendScale = 1.f;
+		return;
+	}
+
+	bool isLossHigh = (m_loss > CONGESTION_LOSS_THRESHOLD);
+	bool isRTTHigh = (m_lowestRTT >= 0.f && m_rtt - m_lowestRTT > CONGESTION_RTT_THRESHOLD);
+
+	if (isLossHigh || isRTTHigh)
+	{
+		float oldScale = m_sendScale;
+		m_sendScale = MaxFloat(m_sendScale * CONGESTION_DECREASE_FACTOR, CONGESTION_MIN_SEND_SCALE);
+
+		if (m_sendScale < oldScale)
+		{
+			LogTaggedPrintf("NET", "Connection %i congested (loss %.2f, rtt %.0fms), send scale lowered to %.3f", m_connectionInfo.sessionIndex, m_loss, 1000.f * m_rtt, m_sendScale);
+		}
+	}
+	else
+	{
+		m_sendScale = MinFloat(m_sendScale + CONGESTION_INCREASE_STEP, 1.f);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a sent packet to the bandwidth measurement, updating the rates once the interval has passed
+//
+void NetConnection::UpdateBandwidthMeasurement(size_t packetBytes)
+{
+	m_bandwidthBytesSent += packetBytes;
+	m_bandwidthPacketsSent++;
+
+	if (m_bandwidthTimer.HasIntervalElapsed())
+	{
+		float elapsedTime = m_bandwidthTimer.GetElapsedTime();
+
+		m_bytesPerSecond = (float) m_bandwidthBytesSent / elapsedTime;
+		m_packetsPerSecond = (float) m_bandwidthPacketsSent / elapsedTime;
+
+		m_bandwidthBytesSent = 0;
+		m_bandwidthPacketsSent = 0;
+		m_bandwidthTimer.SetInterval(BANDWIDTH_MEASURE_INTERVAL);
+	}
 }
 
 
@@ -725,7 +1006,7 @@ std::string NetConnection::GetStateAsString() const
 //
 NetSequenceChannel* NetConnection::GetSequenceChannel(uint8_t sequenceChannelID)
 {
-	if (sequenceChannelID > MAX_SEQUENCE_CHANNELS)
+	if (sequenceChannelID >= MAX_SEQUENCE_CHANNELS)
 	{
 		return nullptr;
 	}
@@ -753,6 +1034,7 @@ bool NetConnection::IsNextMessageInSequence(NetMessage* message)
 
 //-----------------------------------------------------------------------------------------------
 // Adds the given message to the appropriate channel to be processed in order later
+// Takes ownership of the message
 //
 void NetConnection::QueueInOrderMessage(NetMessage* message)
 {
@@ -766,6 +1048,10 @@ void NetConnection::QueueInOrderMessage(NetMessage* message)
 	{
 		channel->AddOutOfOrderMessage(message);
 	}
+	else
+	{
+		delete message;
+	}
 }
 
 
@@ -776,3 +1062,20 @@ float NetConnection::GetTimeSinceLastReceive() const
 {
 	return m_lastReceivedTimer.GetElapsedTime();
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the message to the packet, counting it in the session's stats if it was written
+//
+bool NetConnection::WriteMessageToPacket(NetPacket* packet, NetMessage* message)
+{
+	PROFILE_SCOPE_CATEGORY("NetConnection::WriteMessageToPacket", "Net");
+
+	if (!packet->WriteMessage(message))
+	{
+		return false;
+	}
+
+	m_owningSession->RecordMessageSent(message);
+	return true;
+}
@@ -18,8 +18,18 @@ class NetMessage;
 
 #define MAX_UNACKED_HISTORY (256)
 #define MAX_RELIABLES_PER_PACKET (32)
-#define RELIABLE_WINDOW (32)
+#define RELIABLE_WINDOW (32)			// At most 32, the received IDs are tracked in a 32 bit field
 #define MAX_SEQUENCE_CHANNELS (32)
+#define MAX_SNAPSHOTS_PER_PACKET (64)
+#define DEFAULT_SNAPSHOT_BYTE_BUDGET (PACKET_MTU)	// Per flush, so the default only limits by the packet
+
+// Congestion control - the send scale divides the send rate and multiplies the snapshot budget
+#define CONGESTION_LOSS_THRESHOLD (0.05f)		// Loss over a window above this backs off
+#define CONGESTION_RTT_THRESHOLD (0.1f)			// As does RTT this many seconds above the lowest seen
+#define CONGESTION_DECREASE_FACTOR (0.5f)
+#define CONGESTION_INCREASE_STEP (0.125f)		// Added back for each window without congestion
+#define CONGESTION_MIN_SEND_SCALE (0.125f)
+#define BANDWIDTH_MEASURE_INTERVAL (1.0f)
 
 struct PacketTracker_t
 {
@@ -36,11 +46,26 @@ struct PacketTracker_t
 		return true;
 	}
 
+	bool AddSnapshot(uint16_t networkID, uint16_t sequence)
+	{
+		if (m_snapshotsInPacket == MAX_SNAPSHOTS_PER_PACKET)
+		{
+			return false;
+		}
+
+		m_sentSnapshotNetworkIDs[m_snapshotsInPacket] = networkID;
+		m_sentSnapshotSequences[m_snapshotsInPacket] = sequence;
+		++m_snapshotsInPacket;
+
+		return true;
+	}
+
 	void Clear()
 	{
 		packetAck = INVALID_PACKET_ACK;
 		timeSent = -1.0f;
 		m_reliablesInPacket = 0;
+		m_snapshotsInPacket = 0;
 	}
 
 	uint16_t	packetAck = INVALID_PACKET_ACK;
@@ -48,6 +73,11 @@ struct PacketTracker_t
 
 	uint16_t m_sentReliableIDs[MAX_RELIABLES_PER_PACKET];
 	unsigned int m_reliablesInPacket = 0;
+
+	// Snapshot updates in the packet, which become delta baselines once it's acked
+	uint16_t m_sentSnapshotNetworkIDs[MAX_SNAPSHOTS_PER_PACKET];
+	uint16_t m_sentSnapshotSequences[MAX_SNAPSHOTS_PER_PACKET];
+	unsigned int m_snapshotsInPacket = 0;
 };
 
 enum eConnectionState
@@ -90,16 +120,24 @@ public:
 	// Network tick
 	void						SetNetTickRate(float hertz);
 	bool						HasNetTickElapsed() const;
+	float						GetSendInterval() const;
 
 	// Heartbeat
 	bool						HasHeartbeatElapsed();
 
+	// NetObject updates - the most bytes of snapshot updates added to each flush
+	void						SetSnapshotByteBudget(size_t byteBudget);
+	size_t						GetSnapshotByteBudget() const;
+
 	// Reliable delivery
 	bool						OnPacketReceived(const PacketHeader_t& header);
 	bool						HasReliableIDAlreadyBeenReceived(uint16_t reliableID) const;
 	void						AddProcessedReliableID(uint16_t reliableID);
 
-	// RTT/Loss
+	// RTT/Loss/Fill
+	float						GetLoss() const;
+	float						GetSendScale() const;
+	float						GetBytesPerSecond() const;
 	bool						HasOutboundMessages() const;
 	bool						NeedsToForceSend() const;
 
@@ -127,12 +165,18 @@ private:
 	PacketTracker_t*			GetTrackerForAck(uint16_t ack);
 	void						InvalidateTracker(uint16_t ack);
 	bool						NextSendIsWithinReliableWindow() const;
+	void						AddUnconfirmedReliable(NetMessage* message);
+	void						RemoveUnconfirmedReliable(uint16_t reliableID);
 
 	// RTT/Loss
 	void						UpdateLossCalculation();
+	void						UpdateCongestionControl();
+	void						UpdateBandwidthMeasurement(size_t packetBytes);
 
 	std::string					GetStateAsString() const;
 
+	bool						WriteMessageToPacket(NetPacket* packet, NetMessage* message);
+
 
 private:
 	//-----Private Data-----
@@ -144,9 +188,14 @@ private:
 
 	std::vector<NetMessage*>	m_outboundUnreliables;
 	std::vector<NetMessage*>	m_unsentReliables;
-	std::vector<NetMessage*>	m_unconfirmedReliables;
 
-	std::vector<uint16_t>		m_receivedReliableIDs;
+	// Sent but not yet acked, indexed by reliable ID % RELIABLE_WINDOW
+	NetMessage*					m_unconfirmedReliables[RELIABLE_WINDOW] = { nullptr };
+	int							m_unconfirmedReliableCount = 0;
+	uint16_t					m_oldestUnconfirmedReliableID = 0;
+
+	// Bit i is set if m_highestReceivedReliableID - i was processed
+	uint32_t					m_receivedReliableBitfield = 0;
 
 	// For net tick
 	float						m_timeBetweenSends = 0.f;
@@ -154,6 +203,8 @@ private:
 
 	Stopwatch					m_heartbeatTimer;
 
+	size_t						m_snapshotByteBudget = DEFAULT_SNAPSHOT_BYTE_BUDGET;
+
 	// Reliable delivery
 	uint16_t m_nextAckToSend = 0;
 	uint16_t m_highestReceivedAck = INVALID_PACKET_ACK;
@@ -174,8 +225,25 @@ private:
 
 	float m_loss = 0.f;
 	float m_rtt = 0.f;
+	float m_lowestRTT = -1.f;	// Of single samples, so it's close to the link's RTT without queueing
+
+	// Congestion control
+	float m_sendScale = 1.f;
+
+	// Bandwidth, measured over BANDWIDTH_MEASURE_INTERVAL
+	Stopwatch m_bandwidthTimer;
+	size_t m_bandwidthBytesSent = 0;
+	unsigned int m_bandwidthPacketsSent = 0;
+	float m_bytesPerSecond = 0.f;
+	float m_packetsPerSecond = 0.f;
+
+	// Average fraction of the MTU used by sent packets, over the loss window
+	size_t m_fillBytesSent = 0;
+	unsigned int m_fillPacketsSent = 0;
+	float m_fillRatio = 0.f;
 
 	bool m_forceSendNextTick = false;
+	Stopwatch m_pendingAckTimer;
 
 	static constexpr float RTT_BLEND_FACTOR = 0.01f;
 	static constexpr unsigned int LOSS_WINDOW_COUNT = 50;
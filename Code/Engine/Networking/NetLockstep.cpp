@@ -0,0 +1,718 @@
+/************************************************************************/
+/* File: NetLockstep.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the NetLockstep class
+/************************************************************************/
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include "Engine/Networking/NetLockstep.hpp"
+#include "Engine/Networking/NetSession.hpp"
+#include "Engine/Networking/NetMessage.hpp"
+#include "Engine/Networking/NetConnection.hpp"
+#include "Engine/Core/Time/FixedStepScheduler.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/Utility/StringUtils.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the bit for the connection index in a player mask
+//
+static uint64_t GetPlayerBit(uint8_t playerIndex)
+{
+	return ((uint64_t) 1 << playerIndex);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns true if the tick is within half the window of the center tick, on either side
+//
+static bool IsTickInWindow(uint32_t tick, uint32_t centerTick)
+{
+	int32_t offset = (int32_t) (tick - centerTick);
+	return (offset >= -(NET_LOCKSTEP_TICK_WINDOW / 2) && offset < (NET_LOCKSTEP_TICK_WINDOW / 2));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+NetLockstep::NetLockstep(NetSession* session)
+	: m_session(session)
+{
+	for (int index = 0; index < MAX_CONNECTIONS; ++index)
+	{
+		m_leaveTicks[index] = UINT32_MAX;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+NetLockstep::~NetLockstep()
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts the game in lockstep with every ready connection, telling them the tick and players to start with
+//
+void NetLockstep::Start()
+{
+	ASSERT_OR_DIE(m_session->IsHosting(), "Error: NetLockstep::Start() called on a client, only the host starts lockstep");
+
+	uint64_t playerMask = 0;
+	for (uint8_t connectionIndex = 0; connectionIndex < MAX_CONNECTIONS; ++connectionIndex)
+	{
+		NetConnection* connection = m_session->GetConnection(connectionIndex);
+
+		if (connection != nullptr && (connection == m_session->GetMyConnection() || connection->IsReady()))
+		{
+			playerMask |= GetPlayerBit(connectionIndex);
+		}
+	}
+
+	// Sent before any input, and on the same channel, so every client has started by the time inputs arrive from the host
+	NetMessage* message = new NetMessage("lockstep_start", m_session);
+	message->Write((uint32_t) 0);
+	message->Write(playerMask);
+	message->Write((uint8_t) m_inputDelay);
+	m_session->BroadcastMessage(message);
+
+	BeginAtTick(0, playerMask, m_inputDelay);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stops running, dropping every kept input and checksum
+//
+void NetLockstep::Stop()
+{
+	m_isRunning = false;
+	m_playerMask = 0;
+	m_currentTick = 0;
+	m_nextLocalInputTick = 0;
+
+	for (int slotIndex = 0; slotIndex < NET_LOCKSTEP_TICK_WINDOW; ++slotIndex)
+	{
+		m_ticks[slotIndex] = LockstepTick_t();
+	}
+
+	for (int index = 0; index < MAX_CONNECTIONS; ++index)
+	{
+		m_leaveTicks[index] = UINT32_MAX;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if another local input should be submitted before running ticks
+//
+bool NetLockstep::NeedsLocalInput() const
+{
+	if (!m_isRunning)
+	{
+		return false;
+	}
+
+	uint8_t myIndex = m_session->GetMyConnection()->GetSessionIndex();
+	if (!IsPlayer(myIndex) || m_nextLocalInputTick >= m_leaveTicks[myIndex])
+	{
+		return false;
+	}
+
+	return (m_nextLocalInputTick <= m_currentTick + (uint32_t) m_inputDelay);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Schedules the input for the next tick that doesn't have one, and sends it to every other peer
+//
+void NetLockstep::SubmitLocalInput(const void* data, uint16_t byteCount)
+{
+	ASSERT_OR_DIE(m_isRunning, "Error: NetLockstep::SubmitLocalInput() called while not running");
+	ASSERT_OR_DIE(byteCount <= NET_LOCKSTEP_MAX_INPUT_SIZE, Stringf("Error: NetLockstep::SubmitLocalInput() given %u bytes, the max is %i", (unsigned int) byteCount, NET_LOCKSTEP_MAX_INPUT_SIZE));
+
+	uint32_t tick = m_nextLocalInputTick;
+	m_nextLocalInputTick++;
+
+	AddInput(tick, m_session->GetMyConnection()->GetSessionIndex(), data, byteCount);
+
+	NetMessage* message = new NetMessage("lockstep_input", m_session);
+	message->Write(tick);
+	message->Write(byteCount);
+	message->WriteBytes(byteCount, data);
+	m_session->BroadcastMessage(message);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if every player still in the game has an input for the current tick
+//
+bool NetLockstep::IsTickReady() const
+{
+	if (!m_isRunning)
+	{
+		return false;
+	}
+
+	const LockstepTick_t* slot = GetTickSlot(m_currentTick);
+	uint64_t receivedMask = (slot != nullptr ? slot->receivedMask : 0);
+
+	for (uint8_t playerIndex = 0; playerIndex < MAX_CONNECTIONS; ++playerIndex)
+	{
+		if (IsPlayer(playerIndex) && m_currentTick < m_leaveTicks[playerIndex] && (receivedMask & GetPlayerBit(playerIndex)) == 0)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the inputs of the current tick, in player order so every peer applies them the same way
+// Only valid once IsTickReady()
+//
+void NetLockstep::GetTickInputs(std::vector<NetLockstepInput_t>& out_inputs) const
+{
+	out_inputs.clear();
+
+	const LockstepTick_t* slot = GetTickSlot(m_currentTick);
+	if (slot == nullptr)
+	{
+		return;
+	}
+
+	for (int inputIndex = 0; inputIndex < (int) slot->inputs.size(); ++inputIndex)
+	{
+		const NetLockstepInput_t& input = slot->inputs[inputIndex];
+
+		if (IsPlayer(input.playerIndex) && m_currentTick < m_leaveTicks[input.playerIndex])
+		{
+			out_inputs.push_back(input);
+		}
+	}
+
+	std::sort(out_inputs.begin(), out_inputs.end(), [](const NetLockstepInput_t& a, const NetLockstepInput_t& b)
+	{
+		return a.playerIndex < b.playerIndex;
+	});
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Ends the current tick with the checksum of the state it left, and moves on to the next
+// Every NET_LOCKSTEP_CHECKSUM_INTERVAL ticks the checksum is sent for the other peers to compare
+//
+void NetLockstep::FinishTick(uint32_t checksum)
+{
+	ASSERT_OR_DIE(IsTickReady(), Stringf("Error: NetLockstep::FinishTick() called on tick %u before it was ready", m_currentTick));
+
+	uint32_t tick = m_currentTick;
+	LockstepTick_t* slot = GetTickSlot(tick);
+
+	slot->hasLocalChecksum = true;
+	slot->localChecksum = checksum;
+
+	for (int pendingIndex = 0; pendingIndex < (int) slot->pendingChecksums.size(); ++pendingIndex)
+	{
+		uint64_t pending = slot->pendingChecksums[pendingIndex];
+		CompareChecksum(tick, (uint8_t) (pending >> 32), (uint32_t) pending);
+	}
+	slot->pendingChecksums.clear();
+
+	if ((tick % NET_LOCKSTEP_CHECKSUM_INTERVAL) == 0)
+	{
+		NetMessage* message = new NetMessage("lockstep_checksum", m_session);
+		message->Write(tick);
+		message->Write(checksum);
+		m_session->BroadcastMessage(message);
+	}
+
+	m_currentTick++;
+	UpdateInputDelay();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Folds the bytes into the checksum
+//
+uint32_t NetLockstep::AccumulateChecksum(const void* data, size_t byteCount, uint32_t checksum /*= 2166136261u*/)
+{
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+
+	for (size_t byteIndex = 0; byteIndex < byteCount; ++byteIndex)
+	{
+		checksum = (checksum ^ (uint32_t) bytes[byteIndex]) * 16777619u;
+	}
+
+	return checksum;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets how long a tick is, for working out the input delay an RTT needs
+//
+void NetLockstep::SetTickSeconds(float tickSeconds)
+{
+	ASSERT_OR_DIE(tickSeconds > 0.f, Stringf("Error: NetLockstep given a tick of %f seconds", tickSeconds));
+	m_tickSeconds = tickSeconds;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the tick length to one step of the scheduler, for simulations that lockstep every fixed step
+//
+void NetLockstep::SetTickSecondsFromFixedStep(const FixedStepScheduler& scheduler)
+{
+	SetTickSeconds((float) scheduler.GetStepSeconds());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the function called when a desync is first detected
+//
+void NetLockstep::SetDesyncCallback(NetLockstepDesync_cb callback)
+{
+	m_desyncCallback = callback;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if started and not yet stopped
+//
+bool NetLockstep::IsRunning() const
+{
+	return m_isRunning;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the next tick to be simulated
+//
+uint32_t NetLockstep::GetCurrentTick() const
+{
+	return m_currentTick;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns how many ticks ahead local inputs are scheduled
+//
+int NetLockstep::GetInputDelay() const
+{
+	return m_inputDelay;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if a checksum from another player hasn't matched since starting
+//
+bool NetLockstep::HasDesynced() const
+{
+	return m_hasDesynced;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the first tick a checksum didn't match on, only valid if HasDesynced()
+//
+uint32_t NetLockstep::GetDesyncTick() const
+{
+	return m_desyncTick;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the connection was in the game when it started
+//
+bool NetLockstep::IsPlayer(uint8_t connectionIndex) const
+{
+	return (connectionIndex < MAX_CONNECTIONS && (m_playerMask & GetPlayerBit(connectionIndex)) != 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Called by the session as a connection is destroyed
+// The host picks the tick the player leaves on, after the last input it has from them, and tells
+// everyone; clients keep waiting on the player's inputs until they hear it
+//
+void NetLockstep::OnConnectionLeft(uint8_t connectionIndex)
+{
+	if (!m_isRunning || !IsPlayer(connectionIndex) || m_leaveTicks[connectionIndex] != UINT32_MAX || !m_session->IsHosting())
+	{
+		return;
+	}
+
+	uint32_t leaveTick = m_currentTick;
+	for (uint32_t tick = m_currentTick; IsTickInWindow(tick, m_currentTick); ++tick)
+	{
+		const LockstepTick_t* slot = GetTickSlot(tick);
+
+		if (slot != nullptr && (slot->receivedMask & GetPlayerBit(connectionIndex)) != 0)
+		{
+			leaveTick = tick + 1;
+		}
+	}
+
+	NetMessage* message = new NetMessage("lockstep_leave", m_session);
+	message->Write(connectionIndex);
+	message->Write(leaveTick);
+	m_session->BroadcastMessage(message);
+
+	RemovePlayerFromTick(connectionIndex, leaveTick);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads the host's start message and starts with its tick and players
+//
+bool NetLockstep::ReadStartMessage(NetMessage* message)
+{
+	uint32_t startTick = 0;
+	uint64_t playerMask = 0;
+	uint8_t startDelay = 0;
+
+	if (!message->Read(startTick) || !message->Read(playerMask) || !message->Read(startDelay))
+	{
+		LogTaggedPrintf("NET", "Error: NetLockstep::ReadStartMessage() couldn't read the start");
+		return false;
+	}
+
+	BeginAtTick(startTick, playerMask, (int) startDelay);
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads a player's input for a tick
+// Inputs from other clients can arrive before the host's start does, so they're kept while not running
+//
+bool NetLockstep::ReadInputMessage(NetMessage* message, uint8_t playerIndex)
+{
+	uint32_t tick = 0;
+	uint16_t byteCount = 0;
+	uint8_t data[NET_LOCKSTEP_MAX_INPUT_SIZE];
+
+	if (!message->Read(tick) || !message->Read(byteCount) || byteCount > NET_LOCKSTEP_MAX_INPUT_SIZE || message->ReadBytes(data, byteCount) != byteCount)
+	{
+		LogTaggedPrintf("NET", "Error: NetLockstep::ReadInputMessage() couldn't read the input from connection %u", (unsigned int) playerIndex);
+		return false;
+	}
+
+	if (m_isRunning && (!IsPlayer(playerIndex) || tick >= m_leaveTicks[playerIndex]))
+	{
+		return false;
+	}
+
+	AddInput(tick, playerIndex, data, byteCount);
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads a player's checksum for a tick, comparing it now if this peer has already finished the tick
+//
+bool NetLockstep::ReadChecksumMessage(NetMessage* message, uint8_t playerIndex)
+{
+	uint32_t tick = 0;
+	uint32_t checksum = 0;
+
+	if (!message->Read(tick) || !message->Read(checksum))
+	{
+		LogTaggedPrintf("NET", "Error: NetLockstep::ReadChecksumMessage() couldn't read the checksum from connection %u", (unsigned int) playerIndex);
+		return false;
+	}
+
+	if (!m_isRunning || !IsPlayer(playerIndex))
+	{
+		return false;
+	}
+
+	LockstepTick_t* slot = GetTickSlot(tick);
+	if (slot == nullptr)
+	{
+		return false;
+	}
+
+	if (slot->hasLocalChecksum)
+	{
+		CompareChecksum(tick, playerIndex, checksum);
+	}
+	else
+	{
+		slot->pendingChecksums.push_back(((uint64_t) playerIndex << 32) | (uint64_t) checksum);
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads which player left and the tick the host dropped them on
+//
+bool NetLockstep::ReadLeaveMessage(NetMessage* message)
+{
+	uint8_t playerIndex = INVALID_CONNECTION_INDEX;
+	uint32_t leaveTick = 0;
+
+	if (!message->Read(playerIndex) || !message->Read(leaveTick) || playerIndex >= MAX_CONNECTIONS)
+	{
+		LogTaggedPrintf("NET", "Error: NetLockstep::ReadLeaveMessage() couldn't read the player that left");
+		return false;
+	}
+
+	RemovePlayerFromTick(playerIndex, leaveTick);
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts running at the tick with the given players
+// The first ticks are inside every player's delay, so they start with empty inputs for everyone
+//
+void NetLockstep::BeginAtTick(uint32_t startTick, uint64_t playerMask, int startDelay)
+{
+	m_isRunning = true;
+	m_playerMask = playerMask;
+	m_currentTick = startTick;
+	m_inputDelay = startDelay;
+	m_ticksOverNeededDelay = 0;
+	m_hasDesynced = false;
+	m_desyncTick = 0;
+
+	for (int index = 0; index < MAX_CONNECTIONS; ++index)
+	{
+		m_leaveTicks[index] = UINT32_MAX;
+	}
+
+	for (int delayIndex = 0; delayIndex < startDelay; ++delayIndex)
+	{
+		for (uint8_t playerIndex = 0; playerIndex < MAX_CONNECTIONS; ++playerIndex)
+		{
+			if (IsPlayer(playerIndex))
+			{
+				AddInput(startTick + (uint32_t) delayIndex, playerIndex, nullptr, 0);
+			}
+		}
+	}
+
+	m_nextLocalInputTick = startTick + (uint32_t) startDelay;
+
+	LogTaggedPrintf("NET", "Lockstep started at tick %u with an input delay of %i ticks", startTick, startDelay);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the slot for the tick, reusing the one of the tick a window before it; nullptr if the
+// tick is too far from the current one to be kept
+//
+NetLockstep::LockstepTick_t* NetLockstep::GetTickSlot(uint32_t tick)
+{
+	if (!IsTickInWindow(tick, m_currentTick))
+	{
+		return nullptr;
+	}
+
+	LockstepTick_t& slot = m_ticks[tick % NET_LOCKSTEP_TICK_WINDOW];
+
+	if (slot.tick != tick)
+	{
+		slot.tick = tick;
+		slot.receivedMask = 0;
+		slot.inputs.clear();
+		slot.hasLocalChecksum = false;
+		slot.localChecksum = 0;
+		slot.pendingChecksums.clear();
+	}
+
+	return &slot;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the slot for the tick, nullptr if nothing has been kept for it
+//
+const NetLockstep::LockstepTick_t* NetLockstep::GetTickSlot(uint32_t tick) const
+{
+	if (!IsTickInWindow(tick, m_currentTick))
+	{
+		return nullptr;
+	}
+
+	const LockstepTick_t& slot = m_ticks[tick % NET_LOCKSTEP_TICK_WINDOW];
+	return (slot.tick == tick ? &slot : nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Keeps the player's input for the tick; a second input for the same tick is ignored
+//
+void NetLockstep::AddInput(uint32_t tick, uint8_t playerIndex, const void* data, uint16_t byteCount)
+{
+	LockstepTick_t* slot = GetTickSlot(tick);
+
+	if (slot == nullptr)
+	{
+		LogTaggedPrintf("NET", "Warning: NetLockstep dropped the input for tick %u from connection %u, %u is the current tick", tick, (unsigned int) playerIndex, m_currentTick);
+		return;
+	}
+
+	if ((slot->receivedMask & GetPlayerBit(playerIndex)) != 0)
+	{
+		return;
+	}
+
+	NetLockstepInput_t input;
+	input.playerIndex = playerIndex;
+	input.byteCount = byteCount;
+
+	if (byteCount > 0)
+	{
+		memcpy(input.data, data, byteCount);
+	}
+
+	slot->inputs.push_back(input);
+	slot->receivedMask |= GetPlayerBit(playerIndex);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Drops the player from the leave tick on; earlier ticks still missing their input get an empty one,
+// since the player can't send them anymore
+//
+void NetLockstep::RemovePlayerFromTick(uint8_t playerIndex, uint32_t leaveTick)
+{
+	if (!IsPlayer(playerIndex))
+	{
+		return;
+	}
+
+	m_leaveTicks[playerIndex] = leaveTick;
+
+	for (uint32_t tick = m_currentTick; tick < leaveTick && IsTickInWindow(tick, m_currentTick); ++tick)
+	{
+		AddInput(tick, playerIndex, nullptr, 0);
+	}
+
+	LogTaggedPrintf("NET", "Lockstep dropped connection %u from tick %u", (unsigned int) playerIndex, leaveTick);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Compares the player's checksum for the tick against this peer's, flagging the first mismatch
+//
+void NetLockstep::CompareChecksum(uint32_t tick, uint8_t playerIndex, uint32_t checksum)
+{
+	const LockstepTick_t* slot = GetTickSlot(tick);
+
+	if (slot == nullptr || !slot->hasLocalChecksum || slot->localChecksum == checksum || m_hasDesynced)
+	{
+		return;
+	}
+
+	m_hasDesynced = true;
+	m_desyncTick = tick;
+
+	LogTaggedPrintf("NET", "Error: Lockstep desync on tick %u - connection %u has checksum 0x%08x, this peer has 0x%08x", tick, (unsigned int) playerIndex, checksum, slot->localChecksum);
+
+	if (m_desyncCallback)
+	{
+		m_desyncCallback(tick, playerIndex);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the input delay to cover half the worst RTT to the other players, so local inputs reach them
+// before they need them; grows right away, but only shrinks by a tick after a while over what's needed,
+// so one good RTT sample doesn't cause a stall
+//
+void NetLockstep::UpdateInputDelay()
+{
+	float maxRTT = 0.f;
+	NetConnection* myConnection = m_session->GetMyConnection();
+
+	for (uint8_t connectionIndex = 0; connectionIndex < MAX_CONNECTIONS; ++connectionIndex)
+	{
+		NetConnection* connection = m_session->GetConnection(connectionIndex);
+
+		if (connection != nullptr && connection != myConnection && IsPlayer(connectionIndex) && m_currentTick < m_leaveTicks[connectionIndex])
+		{
+			maxRTT = std::max(maxRTT, connection->GetRTT());
+		}
+	}
+
+	int neededDelay = (int) ceilf((0.5f * maxRTT + NET_LOCKSTEP_DELAY_MARGIN_SECONDS) / m_tickSeconds);
+	neededDelay = std::min(std::max(neededDelay, NET_LOCKSTEP_MIN_INPUT_DELAY), NET_LOCKSTEP_MAX_INPUT_DELAY);
+
+	if (neededDelay > m_inputDelay)
+	{
+		m_inputDelay = neededDelay;
+		m_ticksOverNeededDelay = 0;
+	}
+	else if (neededDelay < m_inputDelay)
+	{
+		m_ticksOverNeededDelay++;
+
+		if (m_ticksOverNeededDelay >= NET_LOCKSTEP_DELAY_LOWER_TICKS)
+		{
+			m_inputDelay--;
+			m_ticksOverNeededDelay = 0;
+		}
+	}
+	else
+	{
+		m_ticksOverNeededDelay = 0;
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Callback for when the host's lockstep start message is received
+//
+bool OnLockstepStart(NetMessage* msg, const NetSender_t& sender)
+{
+	if (sender.connectionIndex != sender.netSession->GetHostConnection()->GetSessionIndex())
+	{
+		return false;
+	}
+
+	return sender.netSession->GetLockstep()->ReadStartMessage(msg);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Callback for when a player's input for a tick is received
+//
+bool OnLockstepInput(NetMessage* msg, const NetSender_t& sender)
+{
+	return sender.netSession->GetLockstep()->ReadInputMessage(msg, sender.connectionIndex);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Callback for when a player's checksum for a tick is received
+//
+bool OnLockstepChecksum(NetMessage* msg, const NetSender_t& sender)
+{
+	return sender.netSession->GetLockstep()->ReadChecksumMessage(msg, sender.connectionIndex);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Callback for when the host drops a player that left from the game
+//
+bool OnLockstepLeave(NetMessage* msg, const NetSender_t& sender)
+{
+	if (sender.connectionIndex != sender.netSession->GetHostConnection()->GetSessionIndex())
+	{
+		return false;
+	}
+
+	return sender.netSession->GetLockstep()->ReadLeaveMessage(msg);
+}
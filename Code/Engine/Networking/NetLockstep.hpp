@@ -0,0 +1,148 @@
+/************************************************************************/
+/* File: NetLockstep.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Deterministic lockstep on a NetSession - peers only send
+/*				their input per tick, and every peer runs the same ticks
+/*				with the same inputs, checking checksums for desyncs
+/************************************************************************/
+#pragma once
+#include <vector>
+#include <stdint.h>
+#include <functional>
+
+class NetSession;
+class NetMessage;
+class FixedStepScheduler;
+
+// Same as NetSession's, which isn't included here as it has no include guard
+#ifndef INVALID_CONNECTION_INDEX
+#define INVALID_CONNECTION_INDEX (0xff)
+#endif
+
+#ifndef MAX_CONNECTIONS
+#define MAX_CONNECTIONS (64)
+#endif
+
+// All lockstep messages share their own in-order channel, so a start or leave is always seen in order
+// with the inputs around it, and nothing waits behind the NetObjectSystem's traffic
+#define NET_LOCKSTEP_SEQUENCE_CHANNEL (1)
+
+#define NET_LOCKSTEP_MAX_INPUT_SIZE (256)				// Bytes of one player's input for one tick
+#define NET_LOCKSTEP_TICK_WINDOW (128)					// Ticks kept, centered on the current one; half must be more than twice the max delay
+#define NET_LOCKSTEP_MIN_INPUT_DELAY (1)
+#define NET_LOCKSTEP_MAX_INPUT_DELAY (30)
+#define NET_LOCKSTEP_DEFAULT_INPUT_DELAY (4)
+#define NET_LOCKSTEP_DELAY_MARGIN_SECONDS (0.02f)		// Added to half the RTT, to cover jitter
+#define NET_LOCKSTEP_DELAY_LOWER_TICKS (120)			// Ticks the delay has to be more than needed before it drops by one
+#define NET_LOCKSTEP_CHECKSUM_INTERVAL (10)				// Ticks between checksums sent
+
+// One player's input for a tick, as given to SubmitLocalInput() on their machine
+struct NetLockstepInput_t
+{
+	uint8_t		playerIndex = INVALID_CONNECTION_INDEX;		// The player's connection index
+	uint16_t	byteCount = 0;
+	uint8_t		data[NET_LOCKSTEP_MAX_INPUT_SIZE];
+};
+
+// Called once, on the first tick a checksum from another player doesn't match this one
+typedef std::function<void(uint32_t tick, uint8_t playerIndex)> NetLockstepDesync_cb;
+
+
+class NetLockstep
+{
+public:
+	//-----Public Methods-----
+
+	NetLockstep(NetSession* session);
+	~NetLockstep();
+
+	// Host only - starts every ready connection in lockstep from tick 0
+	// Clients start when the host's start message reaches them
+	void						Start();
+	void						Stop();
+
+	// Each fixed step, while NeedsLocalInput() submit the local input (empty is fine), then run every
+	// ready tick - GetTickInputs(), simulate with them, and FinishTick() with a checksum of the state
+	// More than one input is needed as the delay grows, and none for a step as it shrinks
+	bool						NeedsLocalInput() const;
+	void						SubmitLocalInput(const void* data, uint16_t byteCount);
+
+	bool						IsTickReady() const;
+	void						GetTickInputs(std::vector<NetLockstepInput_t>& out_inputs) const;	// Ordered by player index
+	void						FinishTick(uint32_t checksum);
+
+	// FNV-1a, for folding the simulation state into the checksum given to FinishTick()
+	static uint32_t				AccumulateChecksum(const void* data, size_t byteCount, uint32_t checksum = 2166136261u);
+
+	// Settings
+	void						SetTickSeconds(float tickSeconds);
+	void						SetTickSecondsFromFixedStep(const FixedStepScheduler& scheduler);
+	void						SetDesyncCallback(NetLockstepDesync_cb callback);
+
+	// Accessors
+	bool						IsRunning() const;
+	uint32_t					GetCurrentTick() const;
+	int							GetInputDelay() const;
+	bool						HasDesynced() const;
+	uint32_t					GetDesyncTick() const;
+	bool						IsPlayer(uint8_t connectionIndex) const;
+
+	// Session hooks
+	void						OnConnectionLeft(uint8_t connectionIndex);
+	bool						ReadStartMessage(NetMessage* message);
+	bool						ReadInputMessage(NetMessage* message, uint8_t playerIndex);
+	bool						ReadChecksumMessage(NetMessage* message, uint8_t playerIndex);
+	bool						ReadLeaveMessage(NetMessage* message);
+
+
+private:
+	//-----Private Methods-----
+
+	struct LockstepTick_t;
+
+	void						BeginAtTick(uint32_t startTick, uint64_t playerMask, int startDelay);
+	LockstepTick_t*				GetTickSlot(uint32_t tick);
+	const LockstepTick_t*		GetTickSlot(uint32_t tick) const;
+	void						AddInput(uint32_t tick, uint8_t playerIndex, const void* data, uint16_t byteCount);
+	void						RemovePlayerFromTick(uint8_t playerIndex, uint32_t leaveTick);
+	void						CompareChecksum(uint32_t tick, uint8_t playerIndex, uint32_t checksum);
+	void						UpdateInputDelay();
+
+
+private:
+	//-----Private Data-----
+
+	// Peers are never more than the max delay apart, so every input and checksum is for a tick within half
+	// the window of the current one
+	struct LockstepTick_t
+	{
+		uint32_t							tick = 0;
+		uint64_t							receivedMask = 0;		// Players with an input in inputs
+		std::vector<NetLockstepInput_t>		inputs;
+
+		bool								hasLocalChecksum = false;
+		uint32_t							localChecksum = 0;
+		std::vector<uint64_t>				pendingChecksums;		// Received before this peer finished the tick, player index above the checksum
+	};
+
+	NetSession*					m_session = nullptr;
+	bool						m_isRunning = false;
+
+	uint64_t					m_playerMask = 0;				// Connection indices in the game, the same on every peer
+	uint32_t					m_currentTick = 0;				// Next tick to simulate
+	uint32_t					m_nextLocalInputTick = 0;
+	LockstepTick_t				m_ticks[NET_LOCKSTEP_TICK_WINDOW];
+
+	// Players that left are dropped from the tick the host says, so every peer drops them at the same one
+	uint32_t					m_leaveTicks[MAX_CONNECTIONS];
+
+	float						m_tickSeconds = 1.f / 60.f;
+	int							m_inputDelay = NET_LOCKSTEP_DEFAULT_INPUT_DELAY;
+	int							m_ticksOverNeededDelay = 0;
+
+	bool						m_hasDesynced = false;
+	uint32_t					m_desyncTick = 0;
+	NetLockstepDesync_cb		m_desyncCallback = nullptr;
+
+};
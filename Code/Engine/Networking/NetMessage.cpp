@@ -5,8 +5,22 @@
 /* Description: Implementation of the NetMessage class
 /************************************************************************/
 #include "Engine/Core/Time/Clock.hpp"
+#include "Engine/Core/LogSystem.hpp"
 #include "Engine/Networking/NetMessage.hpp"
 #include "Engine/Networking/NetSession.hpp"
+#include "Engine/DataStructures/SlabAllocator.hpp"
+#include "Engine/Core/Utility/Compression.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the allocator all heap messages come from, created on first use
+//
+static SlabAllocator& GetMessageAllocator()
+{
+	static SlabAllocator s_messageAllocator(sizeof(NetMessage), NET_MESSAGES_PER_SLAB);
+	return s_messageAllocator;
+}
 
 //-----------------------------------------------------------------------------------------------
 // Default constructor
@@ -36,6 +50,7 @@ NetMessage::NetMessage(const NetMessageDefinition_t* definition)
 	: BytePacker(MESSAGE_MTU, m_payload, false, LITTLE_ENDIAN)
 	, m_definition(definition)
 {
+	m_bufferCapacity = GetWritableCapacity();
 }
 
 
@@ -45,7 +60,6 @@ NetMessage::NetMessage(const NetMessageDefinition_t* definition)
 NetMessage::NetMessage(NetMessage&& moveFrom)
 	: BytePacker(MESSAGE_MTU, m_payload, false, LITTLE_ENDIAN)
 {
-	m_bufferCapacity = moveFrom.m_bufferCapacity;
 	m_endianness = moveFrom.m_endianness;
 	m_readHead = moveFrom.m_readHead;
 	m_writeHead = moveFrom.m_writeHead;
@@ -55,8 +69,9 @@ NetMessage::NetMessage(NetMessage&& moveFrom)
 	m_reliableID = moveFrom.m_reliableID;
 
 	m_sequenceID = moveFrom.m_sequenceID;
+	m_isPayloadPacked = moveFrom.m_isPayloadPacked;
 
-	memcpy(m_payload, moveFrom.m_payload, MESSAGE_MTU);
+	CopyPayloadFrom(moveFrom);
 
 	// Invalidate
 	moveFrom.m_buffer = nullptr;
@@ -69,7 +84,6 @@ NetMessage::NetMessage(NetMessage&& moveFrom)
 NetMessage::NetMessage(const NetMessage& copy)
 	: BytePacker(MESSAGE_MTU, m_payload, false, LITTLE_ENDIAN)
 {
-	m_bufferCapacity = copy.m_bufferCapacity;
 	m_endianness = copy.m_endianness;
 	m_readHead = copy.m_readHead;
 	m_writeHead = copy.m_writeHead;
@@ -79,8 +93,9 @@ NetMessage::NetMessage(const NetMessage& copy)
 	m_reliableID = copy.m_reliableID;
 
 	m_sequenceID = copy.m_sequenceID;
+	m_isPayloadPacked = copy.m_isPayloadPacked;
 
-	memcpy(m_payload, copy.m_payload, MESSAGE_MTU);
+	CopyPayloadFrom(copy);
 }
 
 
@@ -106,7 +121,6 @@ NetMessage::~NetMessage()
 //
 NetMessage& NetMessage::operator=(NetMessage&& moveFrom)
 {
-	m_bufferCapacity = moveFrom.m_bufferCapacity;
 	m_endianness = moveFrom.m_endianness;
 	m_readHead = moveFrom.m_readHead;
 	m_writeHead = moveFrom.m_writeHead;
@@ -116,8 +130,9 @@ NetMessage& NetMessage::operator=(NetMessage&& moveFrom)
 	m_reliableID = moveFrom.m_reliableID;
 
 	m_sequenceID = moveFrom.m_sequenceID;
+	m_isPayloadPacked = moveFrom.m_isPayloadPacked;
 
-	memcpy(m_payload, moveFrom.m_payload, m_bufferCapacity);
+	CopyPayloadFrom(moveFrom);
 
 	// Invalidate
 	moveFrom.m_buffer = nullptr;
@@ -131,7 +146,6 @@ NetMessage& NetMessage::operator=(NetMessage&& moveFrom)
 //
 NetMessage& NetMessage::operator=(const NetMessage& copy)
 {
-	m_bufferCapacity = copy.m_bufferCapacity;
 	m_endianness = copy.m_endianness;
 	m_readHead = copy.m_readHead;
 	m_writeHead = copy.m_writeHead;
@@ -141,8 +155,9 @@ NetMessage& NetMessage::operator=(const NetMessage& copy)
 	m_reliableID = copy.m_reliableID;
 
 	m_sequenceID = copy.m_sequenceID;
+	m_isPayloadPacked = copy.m_isPayloadPacked;
 
-	memcpy(m_payload, copy.m_payload, MESSAGE_MTU);
+	CopyPayloadFrom(copy);
 
 	return *this;
 }
@@ -189,7 +204,7 @@ float NetMessage::GetLastSentTime() const
 //
 bool NetMessage::RequiresConnection() const
 {
-	return ((m_definition->options & NET_MSG_OPTION_CONNECTIONLESS) != NET_MSG_OPTION_CONNECTIONLESS);
+	return (m_definition->RequiresConnection());
 }
 
 
@@ -212,23 +227,20 @@ bool NetMessage::IsInOrder() const
 
 
 //-----------------------------------------------------------------------------------------------
-// Returns the size of the message header, depends on whether it is a reliable message or not
+// Returns true if payloads of this message are packed with compression
 //
-uint16_t NetMessage::GetHeaderSize() const
+bool NetMessage::IsCompressed() const
 {
-	uint16_t size = sizeof(uint8_t);
-
-	if (IsReliable())
-	{
-		size += sizeof(uint16_t);
+	return (m_definition->IsCompressed());
+}
 
-		if (IsInOrder())
-		{
-			size += (sizeof(uint16_t) + sizeof(uint8_t));
-		}
-	}
 
-	return size;
+//-----------------------------------------------------------------------------------------------
+// Returns the size of the message header, depends on whether it is a reliable message or not
+//
+uint16_t NetMessage::GetHeaderSize() const
+{
+	return m_definition->GetHeaderSize();
 }
 
 
@@ -266,3 +278,185 @@ uint8_t NetMessage::GetSequenceChannelID() const
 {
 	return m_definition->sequenceChannelIndex;
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Points the message at the payload instead of its own buffer, filled and ready to read
+// The payload isn't written to, any writes fail as the view has no room left
+//
+void NetMessage::SetAsView(const NetMessageDefinition_t* definition, const void* payload, uint16_t payloadSize)
+{
+	m_definition = definition;
+	m_isPayloadPacked = false;
+
+	m_buffer = (uint8_t*) payload;
+	m_bufferCapacity = payloadSize;
+	m_ownsMemory = false;
+
+	m_readHead = 0;
+	m_writeHead = payloadSize;
+	m_bitReadBuffer = 0;
+	m_bitReadCount = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the message reads from a payload it doesn't own, see SetAsView()
+//
+bool NetMessage::IsView() const
+{
+	return (m_buffer != m_payload);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies the written part of the source's payload into this message's own buffer, whether the
+// source is a view or not, leaving this message as a regular one
+//
+void NetMessage::CopyPayloadFrom(const NetMessage& source)
+{
+	if (&source != this)
+	{
+		memcpy(m_payload, source.m_buffer, source.m_writeHead);
+	}
+
+	m_buffer = m_payload;
+	m_bufferCapacity = (m_isPayloadPacked ? MESSAGE_MTU : GetWritableCapacity());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns how much payload can be written, short of the MTU by the size prefix for compressed
+// definitions so the payload always fits once it's packed
+//
+size_t NetMessage::GetWritableCapacity() const
+{
+	if (m_definition != nullptr && m_definition->IsCompressed())
+	{
+		return MESSAGE_MTU - sizeof(uint16_t);
+	}
+
+	return MESSAGE_MTU;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns memory for a NetMessage from the message slabs, only going to the heap for a new slab
+//
+void* NetMessage::operator new(size_t size)
+{
+	ASSERT_OR_DIE(size == sizeof(NetMessage), "NetMessage allocated with the wrong size");
+	return GetMessageAllocator().Allocate();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the memory to the message slabs
+//
+void NetMessage::operator delete(void* memory)
+{
+	GetMessageAllocator().Free(memory);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Prefixes the payload with its uncompressed size and compresses it, if it's large enough and
+// compression makes it smaller - a size of 0 means the rest is stored as is
+// Does nothing if already packed, so copies of a sent message aren't packed twice
+// Returns false, leaving the message as it was, if an uncompressed payload leaves no room for the prefix
+//
+bool NetMessage::PackPayload()
+{
+	if (m_isPayloadPacked)
+	{
+		return true;
+	}
+
+	ASSERT_OR_DIE(!IsView(), Stringf("Error: NetMessage::PackPayload() called on a view of message \"%s\"", GetName().c_str()));
+
+	uint16_t rawSize = GetPayloadSize();
+
+	uint8_t packed[MESSAGE_MTU];
+	size_t packedSize = 0;
+
+	if (rawSize >= NET_COMPRESSION_THRESHOLD)
+	{
+		packedSize = LZCompress(m_payload, rawSize, packed, rawSize - sizeof(uint16_t));
+	}
+
+	uint16_t sizePrefix = rawSize;
+	if (packedSize == 0)
+	{
+		if (rawSize + sizeof(uint16_t) > MESSAGE_MTU)
+		{
+			LogTaggedPrintf("NET", "Error: NetMessage::PackPayload() had no room for the size of uncompressed message \"%s\" (%i bytes)", GetName().c_str(), (int) rawSize);
+			return false;
+		}
+
+		memcpy(packed, m_payload, rawSize);
+		packedSize = rawSize;
+		sizePrefix = 0;
+	}
+
+	ResetWrite();
+	ResetRead();
+
+	// The prefix takes the room held back from writers
+	m_bufferCapacity = MESSAGE_MTU;
+	Write(sizePrefix);
+	WriteBytes(packedSize, packed);
+
+	m_isPayloadPacked = true;
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Replaces a packed payload with the original, returning false if it was malformed
+// A view is unpacked straight from the payload it views into this message's own buffer, after
+// which it's no longer a view
+//
+bool NetMessage::UnpackPayload()
+{
+	uint16_t rawSize = 0;
+	if (Read(rawSize) != sizeof(uint16_t))
+	{
+		return false;
+	}
+
+	size_t packedSize = GetPayloadSize() - sizeof(uint16_t);
+
+	const uint8_t* packed = m_buffer + sizeof(uint16_t);
+
+	if (rawSize == 0)
+	{
+		memmove(m_payload, packed, packedSize);
+		rawSize = (uint16_t) packedSize;
+	}
+	else
+	{
+		// Regular messages decompress over their own packed payload, so it's moved out of the way first
+		uint8_t packedCopy[MESSAGE_MTU];
+
+		if (!IsView())
+		{
+			memcpy(packedCopy, packed, packedSize);
+			packed = packedCopy;
+		}
+
+		if (rawSize > MESSAGE_MTU || !LZDecompress(packed, packedSize, m_payload, rawSize))
+		{
+			return false;
+		}
+	}
+
+	m_buffer = m_payload;
+	m_bufferCapacity = MESSAGE_MTU;
+
+	ResetWrite();
+	ResetRead();
+	AdvanceWriteHead(rawSize);
+
+	m_isPayloadPacked = false;
+	return true;
+}
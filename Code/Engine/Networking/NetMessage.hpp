@@ -12,6 +12,12 @@
 // Limit messages to 1KB
 #define MESSAGE_MTU 1024
 
+// Payloads smaller than this are sent as is, even if their definition is compressed
+#define NET_COMPRESSION_THRESHOLD (128)
+
+// Messages are allocated from slabs of this many, which are kept and reused for the program's lifetime
+#define NET_MESSAGES_PER_SLAB (64)
+
 class BytePacker;
 class NetConnection;
 class NetMessage;
@@ -37,6 +43,10 @@ public:
 	NetMessage& operator=(NetMessage&& moveFrom);
 	NetMessage& operator=(const NetMessage&);
 
+	// Pooled allocation - heap messages come from a shared slab allocator, and go back to it on delete
+	static void* operator new(size_t size);
+	static void operator delete(void* memory);
+
 	// Accessors
 	uint8_t							GetDefinitionID() const;
 	const NetMessageDefinition_t*	GetDefinition() const;
@@ -50,15 +60,34 @@ public:
 	bool							RequiresConnection() const;
 	bool							IsReliable() const;
 	bool							IsInOrder() const;
+	bool							IsCompressed() const;
 
 	uint16_t						GetHeaderSize() const;
 	uint16_t						GetPayloadSize() const;
 
+	// Views - read only messages over a payload owned by someone else, like a received packet's buffer,
+	// so they're only valid as long as it is; copying or moving a view copies the payload into the new message
+	void							SetAsView(const NetMessageDefinition_t* definition, const void* payload, uint16_t payloadSize);
+	bool							IsView() const;
+
 	// Mutators
 	void							ResetTimeLastSent();
 	void							AssignReliableID(uint16_t reliableID);
 	void							AssignSequenceID(uint16_t sequenceID);
 
+	// For compressed definitions - the payload is packed once before it's first sent, and unpacked
+	// when it's read out of a packet; their payloads can be written up to 2 bytes short of the MTU,
+	// leaving room for the size prefix, and packing fails on payloads that don't leave it
+	bool							PackPayload();
+	bool							UnpackPayload();
+
+
+private:
+	//-----Private Methods-----
+
+	void							CopyPayloadFrom(const NetMessage& source);
+	size_t							GetWritableCapacity() const;
+
 
 private:
 	//-----Private Data-----
@@ -70,6 +99,7 @@ private:
 	uint16_t						m_sequenceID;
 
 	float							m_lastSentTime;
+	bool							m_isPayloadPacked = false;
 	const NetMessageDefinition_t*	m_definition;
 
 };
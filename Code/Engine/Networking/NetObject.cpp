@@ -1,6 +1,7 @@
 #include "Engine/Networking/NetObject.hpp"
 #include "Engine/Networking/NetObjectType.hpp"
 #include <stdlib.h>
+#include <string.h>
 
 NetObject::NetObject(const NetObjectType_t* type, uint16_t networkID, void* localObject, bool doIOwnObject)
 	: m_netObjectType(type), m_networkID(networkID), m_localObjectPtr(localObject), m_doIOwnObject(doIOwnObject)
@@ -10,6 +11,18 @@ NetObject::NetObject(const NetObjectType_t* type, uint16_t networkID, void* loca
 
 	m_localSnapshot = malloc(snapShotSize);
 	m_lastReceivedSnapshot = malloc(snapShotSize);
+	m_interpolatedSnapshot = malloc(snapShotSize);
+
+	for (int sampleIndex = 0; sampleIndex < NET_INTERPOLATION_BUFFER_SIZE; ++sampleIndex)
+	{
+		m_interpolationSamples[sampleIndex].snapshot = malloc(snapShotSize);
+	}
+
+	// Only the owner's state is ever rewound
+	if (m_doIOwnObject)
+	{
+		m_historySnapshots = (uint8_t*) malloc(snapShotSize * NET_LAG_COMPENSATION_HISTORY_SIZE);
+	}
 }
 
 NetObject::~NetObject()
@@ -25,6 +38,24 @@ NetObject::~NetObject()
 		free(m_lastReceivedSnapshot);
 		m_lastReceivedSnapshot = nullptr;
 	}
+
+	if (m_interpolatedSnapshot != nullptr)
+	{
+		free(m_interpolatedSnapshot);
+		m_interpolatedSnapshot = nullptr;
+	}
+
+	for (int sampleIndex = 0; sampleIndex < NET_INTERPOLATION_BUFFER_SIZE; ++sampleIndex)
+	{
+		free(m_interpolationSamples[sampleIndex].snapshot);
+		m_interpolationSamples[sampleIndex].snapshot = nullptr;
+	}
+
+	if (m_historySnapshots != nullptr)
+	{
+		free(m_historySnapshots);
+		m_historySnapshots = nullptr;
+	}
 }
 
 const NetObjectType_t* NetObject::GetNetObjectType() const
@@ -42,6 +73,11 @@ void* NetObject::GetLastReceivedSnapshot() const
 	return m_lastReceivedSnapshot;
 }
 
+void* NetObject::GetInterpolatedSnapshot() const
+{
+	return m_interpolatedSnapshot;
+}
+
 void* NetObject::GetLocalObject() const
 {
 	return m_localObjectPtr;
@@ -57,3 +93,228 @@ bool NetObject::DoIOwn() const
 	return m_doIOwnObject;
 }
 
+void NetObject::StoreReceivedSnapshot(uint16_t sequence, const uint8_t* bytes, size_t byteCount)
+{
+	SnapshotRecord_t& record = m_receivedSnapshots[sequence % NET_SNAPSHOT_HISTORY_SIZE];
+
+	// A late packet mustn't replace a newer snapshot the sender may be using as a baseline
+	if (record.sequence != INVALID_SNAPSHOT_SEQUENCE && IsSnapshotSequenceNewer(record.sequence, sequence))
+	{
+		return;
+	}
+
+	record.sequence = sequence;
+	record.bytes.assign(bytes, bytes + byteCount);
+}
+
+const SnapshotRecord_t* NetObject::GetReceivedSnapshot(uint16_t sequence) const
+{
+	const SnapshotRecord_t& record = m_receivedSnapshots[sequence % NET_SNAPSHOT_HISTORY_SIZE];
+
+	if (record.sequence != sequence)
+	{
+		return nullptr;
+	}
+
+	return &record;
+}
+
+bool NetObject::IsNewerThanLastApplied(uint16_t sequence) const
+{
+	return (m_lastAppliedSequence == INVALID_SNAPSHOT_SEQUENCE || IsSnapshotSequenceNewer(sequence, m_lastAppliedSequence));
+}
+
+void NetObject::SetLastAppliedSequence(uint16_t sequence)
+{
+	m_lastAppliedSequence = sequence;
+}
+
+
+void NetObject::SetLocalSnapshotTime(float time)
+{
+	m_localSnapshotTime = time;
+}
+
+float NetObject::GetLocalSnapshotTime() const
+{
+	return m_localSnapshotTime;
+}
+
+void* NetObject::AddInterpolationSample(float time, uint16_t sequence)
+{
+	for (int sampleIndex = 0; sampleIndex < m_interpolationSampleCount; ++sampleIndex)
+	{
+		if (m_interpolationSamples[sampleIndex].sequence == sequence)
+		{
+			return nullptr;
+		}
+	}
+
+	if (m_interpolationSampleCount == NET_INTERPOLATION_BUFFER_SIZE)
+	{
+		if (time <= m_interpolationSamples[0].time)
+		{
+			return nullptr;
+		}
+
+		// Drop the oldest, moving its buffer to the end to be reused
+		InterpolationSample_t oldest = m_interpolationSamples[0];
+		for (int sampleIndex = 1; sampleIndex < m_interpolationSampleCount; ++sampleIndex)
+		{
+			m_interpolationSamples[sampleIndex - 1] = m_interpolationSamples[sampleIndex];
+		}
+
+		m_interpolationSamples[m_interpolationSampleCount - 1] = oldest;
+		m_interpolationSampleCount--;
+	}
+
+	// Insertion sort from the back, since samples almost always arrive in order
+	int insertIndex = m_interpolationSampleCount;
+	InterpolationSample_t newSample = m_interpolationSamples[insertIndex];
+
+	while (insertIndex > 0 && m_interpolationSamples[insertIndex - 1].time > time)
+	{
+		m_interpolationSamples[insertIndex] = m_interpolationSamples[insertIndex - 1];
+		insertIndex--;
+	}
+
+	newSample.time = time;
+	newSample.sequence = sequence;
+	m_interpolationSamples[insertIndex] = newSample;
+	m_interpolationSampleCount++;
+
+	return newSample.snapshot;
+}
+
+void NetObject::DropSamplesBefore(float time)
+{
+	int dropCount = 0;
+	while (dropCount + 1 < m_interpolationSampleCount && m_interpolationSamples[dropCount + 1].time <= time)
+	{
+		dropCount++;
+	}
+
+	if (dropCount == 0)
+	{
+		return;
+	}
+
+	// Rotate the dropped buffers to the back so they're reused
+	InterpolationSample_t dropped[NET_INTERPOLATION_BUFFER_SIZE];
+	for (int sampleIndex = 0; sampleIndex < dropCount; ++sampleIndex)
+	{
+		dropped[sampleIndex] = m_interpolationSamples[sampleIndex];
+	}
+
+	for (int sampleIndex = dropCount; sampleIndex < NET_INTERPOLATION_BUFFER_SIZE; ++sampleIndex)
+	{
+		m_interpolationSamples[sampleIndex - dropCount] = m_interpolationSamples[sampleIndex];
+	}
+
+	for (int sampleIndex = 0; sampleIndex < dropCount; ++sampleIndex)
+	{
+		m_interpolationSamples[NET_INTERPOLATION_BUFFER_SIZE - dropCount + sampleIndex] = dropped[sampleIndex];
+	}
+
+	m_interpolationSampleCount -= dropCount;
+}
+
+void NetObject::HoldNewestSampleUntil(float time)
+{
+	if (m_interpolationSampleCount > 0 && m_interpolationSamples[m_interpolationSampleCount - 1].time < time)
+	{
+		m_interpolationSamples[m_interpolationSampleCount - 1].time = time;
+	}
+}
+
+int NetObject::GetInterpolationSampleCount() const
+{
+	return m_interpolationSampleCount;
+}
+
+const InterpolationSample_t& NetObject::GetInterpolationSample(int index) const
+{
+	return m_interpolationSamples[index];
+}
+
+void NetObject::RecordSnapshotHistory(float time)
+{
+	if (m_historySnapshots == nullptr)
+	{
+		return;
+	}
+
+	int newestIndex = (m_historyStart + m_historyCount - 1) % NET_LAG_COMPENSATION_HISTORY_SIZE;
+	if (m_historyCount > 0 && time - m_historyTimes[newestIndex] < NET_LAG_COMPENSATION_RECORD_INTERVAL)
+	{
+		return;
+	}
+
+	// Overwrite the oldest once full
+	int writeIndex;
+	if (m_historyCount == NET_LAG_COMPENSATION_HISTORY_SIZE)
+	{
+		writeIndex = m_historyStart;
+		m_historyStart = (m_historyStart + 1) % NET_LAG_COMPENSATION_HISTORY_SIZE;
+	}
+	else
+	{
+		writeIndex = (m_historyStart + m_historyCount) % NET_LAG_COMPENSATION_HISTORY_SIZE;
+		m_historyCount++;
+	}
+
+	size_t snapshotSize = m_netObjectType->snapshotSize;
+	memcpy(m_historySnapshots + writeIndex * snapshotSize, m_localSnapshot, snapshotSize);
+	m_historyTimes[writeIndex] = time;
+}
+
+bool NetObject::GetSnapshotAtTime(float time, void* out_snapshot) const
+{
+	if (m_historyCount == 0)
+	{
+		return false;
+	}
+
+	size_t snapshotSize = m_netObjectType->snapshotSize;
+
+	// Walk back from the newest, as rewinds are rarely more than a few hundred ms
+	int laterIndex = -1;
+	for (int offset = m_historyCount - 1; offset >= 0; --offset)
+	{
+		int index = (m_historyStart + offset) % NET_LAG_COMPENSATION_HISTORY_SIZE;
+		const uint8_t* snapshot = m_historySnapshots + index * snapshotSize;
+
+		if (m_historyTimes[index] <= time)
+		{
+			if (laterIndex == -1 || m_netObjectType->interpolateSnapshot == nullptr)
+			{
+				memcpy(out_snapshot, snapshot, snapshotSize);
+			}
+			else
+			{
+				float earlierTime = m_historyTimes[index];
+				float t = (time - earlierTime) / (m_historyTimes[laterIndex] - earlierTime);
+
+				m_netObjectType->interpolateSnapshot(out_snapshot, snapshot, m_historySnapshots + laterIndex * snapshotSize, t);
+			}
+
+			return true;
+		}
+
+		laterIndex = index;
+	}
+
+	// Older than everything kept
+	memcpy(out_snapshot, m_historySnapshots + m_historyStart * snapshotSize, snapshotSize);
+	return true;
+}
+
+int NetObject::GetSnapshotHistoryCount() const
+{
+	return m_historyCount;
+}
+
+float NetObject::GetOldestSnapshotHistoryTime() const
+{
+	return (m_historyCount > 0 ? m_historyTimes[m_historyStart] : 0.f);
+}
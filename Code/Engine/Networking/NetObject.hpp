@@ -6,9 +6,43 @@
 /************************************************************************/
 #pragma once
 #include <stdint.h.>
+#include <vector>
+#include <stddef.h>
 
 struct NetObjectType_t;
 
+// Serialized snapshots kept for delta encoding, on both the sending and receiving side
+#define NET_SNAPSHOT_HISTORY_SIZE (16)
+#define INVALID_SNAPSHOT_SEQUENCE (0xffff)
+
+struct SnapshotRecord_t
+{
+	uint16_t				sequence = INVALID_SNAPSHOT_SEQUENCE;
+	std::vector<uint8_t>	bytes;
+};
+
+// Decoded snapshots kept for interpolation on the receiving side, oldest first
+#define NET_INTERPOLATION_BUFFER_SIZE (8)
+
+struct InterpolationSample_t
+{
+	float					time = 0.f;		// Net time the owner made the snapshot at
+	uint16_t				sequence = INVALID_SNAPSHOT_SEQUENCE;
+	void*					snapshot = nullptr;
+};
+
+// Past local snapshots kept by owners for lag compensation, taken at most once per interval, so they
+// cover about a second however fast the host updates
+#define NET_LAG_COMPENSATION_HISTORY_SIZE (64)
+#define NET_LAG_COMPENSATION_RECORD_INTERVAL (1.f / 60.f)
+
+// Returns true if sequence a comes after b, allowing for wrap around
+inline bool IsSnapshotSequenceNewer(uint16_t a, uint16_t b)
+{
+	uint16_t distance = a - b;
+	return (distance != 0 && (distance & 0x8000) == 0);
+}
+
 class NetObject
 {
 public:
@@ -20,10 +54,36 @@ public:
 	const NetObjectType_t*	GetNetObjectType() const;
 	void*					GetLocalSnapshot() const;
 	void*					GetLastReceivedSnapshot() const;
+	void*					GetInterpolatedSnapshot() const;
 	void*					GetLocalObject() const;
 	uint16_t				GetNetworkID() const;
 	bool					DoIOwn() const;
 
+	// Receiving - snapshots are rebuilt from deltas against one that was stored here earlier
+	void					StoreReceivedSnapshot(uint16_t sequence, const uint8_t* bytes, size_t byteCount);
+	const SnapshotRecord_t*	GetReceivedSnapshot(uint16_t sequence) const;
+	bool					IsNewerThanLastApplied(uint16_t sequence) const;
+	void					SetLastAppliedSequence(uint16_t sequence);
+
+	// Owner side - the net time the local snapshot was made at
+	void					SetLocalSnapshotTime(float time);
+	float					GetLocalSnapshotTime() const;
+
+	// Interpolation - returns the snapshot to read the sample into, or nullptr if it's a duplicate or
+	// older than everything kept; when full the oldest sample is dropped to make room
+	void*					AddInterpolationSample(float time, uint16_t sequence);
+	void					DropSamplesBefore(float time);	// Keeps the last sample at or before time
+	void					HoldNewestSampleUntil(float time);
+	int						GetInterpolationSampleCount() const;
+	const InterpolationSample_t& GetInterpolationSample(int index) const;
+
+	// Lag compensation - owners keep a ring of their recent local snapshots, in one block allocated with
+	// the object; looking one up blends the two around the time if the type can, clamped to what's kept
+	void					RecordSnapshotHistory(float time);
+	bool					GetSnapshotAtTime(float time, void* out_snapshot) const;
+	int						GetSnapshotHistoryCount() const;
+	float					GetOldestSnapshotHistoryTime() const;
+
 
 private:
 	//-----Private Data-----
@@ -35,5 +95,18 @@ private:
 
 	void*					m_localSnapshot = nullptr;
 	void*					m_lastReceivedSnapshot = nullptr;
+	void*					m_interpolatedSnapshot = nullptr;
+	float					m_localSnapshotTime = 0.f;
+
+	SnapshotRecord_t		m_receivedSnapshots[NET_SNAPSHOT_HISTORY_SIZE];	// By sequence % NET_SNAPSHOT_HISTORY_SIZE
+	uint16_t				m_lastAppliedSequence = INVALID_SNAPSHOT_SEQUENCE;
+
+	InterpolationSample_t	m_interpolationSamples[NET_INTERPOLATION_BUFFER_SIZE];	// Sorted by time
+	int						m_interpolationSampleCount = 0;
+
+	uint8_t*				m_historySnapshots = nullptr;	// NET_LAG_COMPENSATION_HISTORY_SIZE snapshots back to back, owners only
+	float					m_historyTimes[NET_LAG_COMPENSATION_HISTORY_SIZE];
+	int						m_historyStart = 0;				// Index of the oldest
+	int						m_historyCount = 0;
 
 };
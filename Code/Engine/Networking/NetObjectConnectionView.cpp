@@ -1,6 +1,8 @@
 #include "Engine/Networking/NetObject.hpp"
 #include "Engine/Networking/NetObjectView.hpp"
+#include "Engine/Networking/NetObjectType.hpp"
 #include "Engine/Networking/NetObjectConnectionView.hpp"
+#include <algorithm>
 
 NetObjectConnectionView::~NetObjectConnectionView()
 {
@@ -16,12 +18,23 @@ NetObjectConnectionView::~NetObjectConnectionView()
 
 void NetObjectConnectionView::AddNetObjectView(NetObjectView* objectView)
 {
+	uint16_t networkID = objectView->GetNetObject()->GetNetworkID();
+
+	// Continue the sequence of an earlier view of this object, if there was one
+	std::map<uint16_t, uint16_t>::iterator itr = m_removedViewSequences.find(networkID);
+	if (itr != m_removedViewSequences.end())
+	{
+		objectView->SetNextSequence(itr->second);
+		m_removedViewSequences.erase(itr);
+	}
+
 	m_objectViews.push_back(objectView);
+	m_viewsByNetworkID[networkID] = objectView;
 }
 
 void NetObjectConnectionView::AddNetObjectView(NetObject* netObject)
 {
-	m_objectViews.push_back(new NetObjectView(netObject));
+	AddNetObjectView(new NetObjectView(netObject));
 }
 
 void NetObjectConnectionView::RemoveNetObjectView(NetObject* netObject)
@@ -32,6 +45,10 @@ void NetObjectConnectionView::RemoveNetObjectView(NetObject* netObject)
 	{
 		if (m_objectViews[viewIndex]->GetNetObject() == netObject)
 		{
+			uint16_t networkID = netObject->GetNetworkID();
+			m_removedViewSequences[networkID] = m_objectViews[viewIndex]->GetNextSequence();
+			m_viewsByNetworkID.erase(networkID);
+
 			delete m_objectViews[viewIndex];
 			m_objectViews.erase(m_objectViews.begin() + viewIndex);
 			break;
@@ -44,29 +61,55 @@ int NetObjectConnectionView::GetViewCount() const
 	return (int)m_objectViews.size();
 }
 
-NetObjectView* NetObjectConnectionView::GetNextObjectViewToSendUpdateFor() const
+NetObjectView* NetObjectConnectionView::GetViewAtIndex(int viewIndex) const
 {
-	int objectViewCount = (int)m_objectViews.size();
-	NetObjectView* nextViewToUpdate = nullptr;
+	return m_objectViews[viewIndex];
+}
+
+const std::vector<NetObjectView*>& NetObjectConnectionView::GetViewsByPriority(uint8_t connectionIndex)
+{
+	float elapsedTime = m_priorityTimer.GetElapsedTime();
+	m_priorityTimer.Reset();
 
+	m_viewsByPriority.clear();
+
+	int objectViewCount = (int)m_objectViews.size();
 	for (int i = 0; i < objectViewCount; ++i)
 	{
 		NetObjectView* currView = m_objectViews[i];
+		NetObject* netObject = currView->GetNetObject();
 
 		// Only Update others with objects that we own
 		// Redundant check! If we don't own it, we won't (shouldn't) have a view for
 		// it to begin with
-		if (!currView->GetNetObject()->DoIOwn())
+		if (!netObject->DoIOwn())
 		{
 			continue;
 		}
 
-		if (currView->GetTimeSinceLastSend() > 0.f && (nextViewToUpdate == nullptr || nextViewToUpdate->GetTimeSinceLastSend() < currView->GetTimeSinceLastSend()))
-		{
-			nextViewToUpdate = currView;
-		}
+		const NetObjectType_t* type = netObject->GetNetObjectType();
+		float relevance = (type->getRelevance != nullptr ? type->getRelevance(netObject->GetLocalObject(), connectionIndex) : 1.f);
+
+		currView->AccumulatePriority(elapsedTime * type->priorityWeight * relevance);
+		m_viewsByPriority.push_back(currView);
 	}
 
-	return nextViewToUpdate;
+	std::stable_sort(m_viewsByPriority.begin(), m_viewsByPriority.end(), [](const NetObjectView* a, const NetObjectView* b)
+	{
+		return a->GetPriority() > b->GetPriority();
+	});
+
+	return m_viewsByPriority;
 }
 
+NetObjectView* NetObjectConnectionView::GetNetObjectViewForNetworkID(uint16_t networkID) const
+{
+	std::map<uint16_t, NetObjectView*>::const_iterator itr = m_viewsByNetworkID.find(networkID);
+
+	if (itr == m_viewsByNetworkID.end())
+	{
+		return nullptr;
+	}
+
+	return itr->second;
+}
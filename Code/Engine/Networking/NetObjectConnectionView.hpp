@@ -6,7 +6,10 @@
 /*				NetObjects as seen from the host
 /************************************************************************/
 #pragma once
+#include <map>
 #include <vector>
+#include <stdint.h>
+#include "Engine/Core/Time/Stopwatch.hpp"
 
 class NetObject;
 class NetObjectView;
@@ -23,12 +26,21 @@ public:
 	void RemoveNetObjectView(NetObject* netObject);
 
 	int GetViewCount() const;
-	NetObjectView* GetNextObjectViewToSendUpdateFor() const;
+	NetObjectView* GetViewAtIndex(int viewIndex) const;
+	NetObjectView* GetNetObjectViewForNetworkID(uint16_t networkID) const;
+
+	// Adds the time since the last call, times each object's weight and relevance, to its priority,
+	// then returns the owned views from highest priority to lowest
+	const std::vector<NetObjectView*>& GetViewsByPriority(uint8_t connectionIndex);
 
 	
 private:
 	//-----Private Data-----
 	
 	std::vector<NetObjectView*> m_objectViews;
+	std::map<uint16_t, NetObjectView*> m_viewsByNetworkID;
+	std::map<uint16_t, uint16_t> m_removedViewSequences;		// Next sequence of views removed, by network ID
+	std::vector<NetObjectView*> m_viewsByPriority;	// Reused each tick
+	Stopwatch m_priorityTimer;
 
 };
@@ -0,0 +1,192 @@
+/************************************************************************/
+/* File: NetObjectInterestGrid.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the NetObjectInterestGrid class
+/************************************************************************/
+#include <math.h>
+#include "Engine/Networking/NetObject.hpp"
+#include "Engine/Networking/NetObjectType.hpp"
+#include "Engine/Networking/NetObjectInterestGrid.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+NetObjectInterestGrid::NetObjectInterestGrid(float interestRadius)
+{
+	SetInterestRadius(interestRadius);
+
+	for (int connectionIndex = 0; connectionIndex < MAX_CONNECTIONS; ++connectionIndex)
+	{
+		m_hasFocus[connectionIndex] = false;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the position the connection sees objects around, usually their player's
+//
+void NetObjectInterestGrid::SetConnectionFocus(uint8_t connectionIndex, const Vector3& position)
+{
+	ASSERT_OR_DIE(connectionIndex < MAX_CONNECTIONS, "Error: NetObjectInterestGrid::SetConnectionFocus() received bad connection index");
+
+	m_hasFocus[connectionIndex] = true;
+	m_focusPositions[connectionIndex] = position;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes the connection's focus, so it's given every object
+//
+void NetObjectInterestGrid::ClearConnectionFocus(uint8_t connectionIndex)
+{
+	ASSERT_OR_DIE(connectionIndex < MAX_CONNECTIONS, "Error: NetObjectInterestGrid::ClearConnectionFocus() received bad connection index");
+	m_hasFocus[connectionIndex] = false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the radius objects become relevant within, which is also the grid's cell size
+//
+void NetObjectInterestGrid::SetInterestRadius(float interestRadius)
+{
+	ASSERT_OR_DIE(interestRadius > 0.f, "Error: NetObjectInterestGrid::SetInterestRadius() received a non-positive radius");
+	m_interestRadius = interestRadius;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the radius objects become relevant within
+//
+float NetObjectInterestGrid::GetInterestRadius() const
+{
+	return m_interestRadius;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Rehashes the owned objects into cells by the positions in their current local snapshots
+//
+void NetObjectInterestGrid::Update(const std::vector<NetObject*>& ownedObjects)
+{
+	std::map<int64_t, std::vector<NetObject*>>::iterator itr = m_cells.begin();
+	for (itr; itr != m_cells.end(); itr++)
+	{
+		itr->second.clear();
+	}
+
+	m_alwaysRelevantObjects.clear();
+	m_allObjects = ownedObjects;
+
+	int objectCount = (int) ownedObjects.size();
+	for (int objectIndex = 0; objectIndex < objectCount; ++objectIndex)
+	{
+		NetObject* netObject = ownedObjects[objectIndex];
+		const NetObjectType_t* type = netObject->GetNetObjectType();
+
+		if (type->getSnapshotPosition == nullptr)
+		{
+			m_alwaysRelevantObjects.push_back(netObject);
+			continue;
+		}
+
+		Vector3 position = type->getSnapshotPosition(netObject->GetLocalSnapshot());
+		int64_t key = GetCellKey(GetCellCoordinate(position.x), GetCellCoordinate(position.y), GetCellCoordinate(position.z));
+
+		m_cells[key].push_back(netObject);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the objects within the radius of the connection's focus, searching only the cells the
+// radius can reach, plus the objects that are always relevant
+//
+void NetObjectInterestGrid::GetRelevantObjects(uint8_t connectionIndex, std::vector<NetObject*>& out_objects) const
+{
+	out_objects.clear();
+
+	if (!m_hasFocus[connectionIndex])
+	{
+		out_objects = m_allObjects;
+		return;
+	}
+
+	out_objects = m_alwaysRelevantObjects;
+
+	Vector3 focus = m_focusPositions[connectionIndex];
+	float radiusSquared = m_interestRadius * m_interestRadius;
+
+	int focusX = GetCellCoordinate(focus.x);
+	int focusY = GetCellCoordinate(focus.y);
+	int focusZ = GetCellCoordinate(focus.z);
+
+	for (int cellZ = focusZ - 1; cellZ <= focusZ + 1; ++cellZ)
+	{
+		for (int cellY = focusY - 1; cellY <= focusY + 1; ++cellY)
+		{
+			for (int cellX = focusX - 1; cellX <= focusX + 1; ++cellX)
+			{
+				std::map<int64_t, std::vector<NetObject*>>::const_iterator itr = m_cells.find(GetCellKey(cellX, cellY, cellZ));
+				if (itr == m_cells.end())
+				{
+					continue;
+				}
+
+				const std::vector<NetObject*>& cellObjects = itr->second;
+				int cellObjectCount = (int) cellObjects.size();
+
+				for (int objectIndex = 0; objectIndex < cellObjectCount; ++objectIndex)
+				{
+					NetObject* netObject = cellObjects[objectIndex];
+					Vector3 position = netObject->GetNetObjectType()->getSnapshotPosition(netObject->GetLocalSnapshot());
+
+					if ((position - focus).GetLengthSquared() <= radiusSquared)
+					{
+						out_objects.push_back(netObject);
+					}
+				}
+			}
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Keeps objects until they're past the leave radius; only objects with positions are ever asked about
+//
+bool NetObjectInterestGrid::ShouldStayRelevant(const NetObject* netObject, uint8_t connectionIndex) const
+{
+	const NetObjectType_t* type = netObject->GetNetObjectType();
+
+	if (!m_hasFocus[connectionIndex] || type->getSnapshotPosition == nullptr)
+	{
+		return true;
+	}
+
+	float leaveRadius = m_interestRadius * NET_INTEREST_LEAVE_SCALE;
+	Vector3 position = type->getSnapshotPosition(netObject->GetLocalSnapshot());
+
+	return ((position - m_focusPositions[connectionIndex]).GetLengthSquared() <= leaveRadius * leaveRadius);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Packs the cell coordinates into one key, 21 bits each
+//
+int64_t NetObjectInterestGrid::GetCellKey(int cellX, int cellY, int cellZ) const
+{
+	int64_t mask = (1 << 21) - 1;
+	return ((int64_t) (cellX & mask)) | (((int64_t) (cellY & mask)) << 21) | (((int64_t) (cellZ & mask)) << 42);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the cell along one axis the position falls in
+//
+int NetObjectInterestGrid::GetCellCoordinate(float position) const
+{
+	return (int) floorf(position / m_interestRadius);
+}
@@ -0,0 +1,63 @@
+/************************************************************************/
+/* File: NetObjectInterestGrid.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Relevance query that hashes objects into a uniform grid
+/*				by their snapshot position, and gives each connection
+/*				the objects within a radius of its focus
+/************************************************************************/
+#pragma once
+#include <map>
+#include "Engine/Math/Vector3.hpp"
+#include "Engine/Networking/NetObjectRelevanceQuery.hpp"
+
+// Same as NetSession's, which isn't included here as it has no include guard
+#ifndef MAX_CONNECTIONS
+#define MAX_CONNECTIONS (64)
+#endif
+
+// Objects stay relevant until they're this much farther than the radius they entered at
+#define NET_INTEREST_LEAVE_SCALE (1.2f)
+
+
+class NetObjectInterestGrid : public NetObjectRelevanceQuery
+{
+public:
+	//-----Public Methods-----
+
+	NetObjectInterestGrid(float interestRadius);
+
+	// Connections without a focus get every object, as if there were no interest management
+	void			SetConnectionFocus(uint8_t connectionIndex, const Vector3& position);
+	void			ClearConnectionFocus(uint8_t connectionIndex);
+
+	void			SetInterestRadius(float interestRadius);
+	float			GetInterestRadius() const;
+
+	// NetObjectRelevanceQuery
+	virtual void	Update(const std::vector<NetObject*>& ownedObjects) override;
+	virtual void	GetRelevantObjects(uint8_t connectionIndex, std::vector<NetObject*>& out_objects) const override;
+	virtual bool	ShouldStayRelevant(const NetObject* netObject, uint8_t connectionIndex) const override;
+
+
+private:
+	//-----Private Methods-----
+
+	int64_t			GetCellKey(int cellX, int cellY, int cellZ) const;
+	int				GetCellCoordinate(float position) const;
+
+
+private:
+	//-----Private Data-----
+
+	float									m_interestRadius = 0.f;	// Also the cell size, so a query covers 3x3x3 cells
+
+	bool									m_hasFocus[MAX_CONNECTIONS];
+	Vector3									m_focusPositions[MAX_CONNECTIONS];
+
+	// Rebuilt each Update(); cells are cleared rather than erased so their storage is reused
+	std::map<int64_t, std::vector<NetObject*>>	m_cells;
+	std::vector<NetObject*>					m_alwaysRelevantObjects;	// Types without a snapshot position
+	std::vector<NetObject*>					m_allObjects;
+
+};
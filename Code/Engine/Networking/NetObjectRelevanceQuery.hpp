@@ -0,0 +1,31 @@
+/************************************************************************/
+/* File: NetObjectRelevanceQuery.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Interface for deciding which of our NetObjects each
+/*				connection should have replicated to it
+/************************************************************************/
+#pragma once
+#include <vector>
+#include <stdint.h>
+
+class NetObject;
+
+class NetObjectRelevanceQuery
+{
+public:
+	//-----Public Methods-----
+
+	virtual ~NetObjectRelevanceQuery() {}
+
+	// Called once per NetObjectSystem::Update() with the objects we own, before any of the queries
+	virtual void	Update(const std::vector<NetObject*>& ownedObjects) = 0;
+
+	// Fills out_objects with the owned objects the connection should have
+	virtual void	GetRelevantObjects(uint8_t connectionIndex, std::vector<NetObject*>& out_objects) const = 0;
+
+	// Asked for objects the connection has that GetRelevantObjects() didn't return, so leaving
+	// can be looser than entering and objects on the edge don't flicker in and out
+	virtual bool	ShouldStayRelevant(const NetObject* netObject, uint8_t connectionIndex) const = 0;
+
+};
@@ -6,6 +6,33 @@
 #include "Engine/Networking/NetObjectSystem.hpp"
 #include "Engine/Core/Utility/ErrorWarningAssert.hpp"
 #include "Engine/Networking/NetObjectConnectionView.hpp"
+#include "Engine/Networking/NetConnection.hpp"
+#include "Engine/Networking/NetObjectRelevanceQuery.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/Time/Clock.hpp"
+#include <string.h>
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the net time as the milliseconds written in snapshot updates, which wrap every ~65 seconds
+//
+uint16_t QuantizeSnapshotTime(float time)
+{
+	return (uint16_t) ((uint32_t) (time * 1000.f) & 0xffff);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the time of the wrapped milliseconds closest to the reference, which must be within ~32 seconds
+//
+float UnquantizeSnapshotTime(uint16_t quantizedTime, float referenceTime)
+{
+	int64_t referenceMilliseconds = (int64_t) (referenceTime * 1000.f);
+	int16_t offset = (int16_t) (quantizedTime - (uint16_t) (referenceMilliseconds & 0xffff));
+
+	return (float) (referenceMilliseconds + offset) * 0.001f;
+}
+
 
 //-----------------------------------------------------------------------------------------------
 // Constructor
@@ -25,6 +52,14 @@ NetObjectSystem::NetObjectSystem(NetSession* session)
 //
 NetObjectSystem::~NetObjectSystem()
 {
+	// The NetObjects are ours, the local objects they point to aren't
+	for (int objIndex = 0; objIndex < (int) m_netObjects.size(); ++objIndex)
+	{
+		delete m_netObjects[objIndex];
+	}
+
+	m_netObjects.clear();
+
 	for (int i = 0; i < MAX_CONNECTIONS; ++i)
 	{
 		if (m_connectionViews[i] != nullptr)
@@ -42,6 +77,13 @@ NetObjectSystem::~NetObjectSystem()
 void NetObjectSystem::Update()
 {
 	UpdateLocalSnapshots();
+	UpdateInterpolationDelay();
+	ApplyReceivedSnapshots();
+
+	if (m_relevanceQuery != nullptr)
+	{
+		UpdateInterest();
+	}
 }
 
 
@@ -100,10 +142,18 @@ void NetObjectSystem::RegisterNetObjectType(const NetObjectType_t& type)
 	}
 
 	m_netObjectTypes.push_back(type);
+
+	if (type.snapshotSize > m_deltaBaselineScratch.size())
+	{
+		m_deltaBaselineScratch.resize(type.snapshotSize);
+		m_deltaResultScratch.resize(type.snapshotSize);
+	}
 }
 
 void NetObjectSystem::SyncObject(uint8_t typeID, void* localObject)
 {
+	m_session->LockNetState();
+
 	uint16_t networkID = GetUnusedNetworkID();
 	const NetObjectType_t* type = GetNetObjectTypeForTypeID(typeID);
 	ASSERT_OR_DIE(type != nullptr, "Error: NetObjectSystem::SyncObject() couldn't find type.");
@@ -112,25 +162,23 @@ void NetObjectSystem::SyncObject(uint8_t typeID, void* localObject)
 	NetObject* netObj = new NetObject(type, networkID, localObject, true);
 	m_netObjects.push_back(netObj);
 
-	// Add it to all connection views
-	AddNetObjectViewToAllConnectionViews(netObj);
-
-	// Send a create message
-	NetMessage* createMessage = new NetMessage("netobj_create", m_session);
-
-	// Write the NetObjectSystem-side information
-	createMessage->Write(typeID);
-	createMessage->Write(networkID);
+	// With interest management the next Update() sends it to the connections it's relevant to
+	if (m_relevanceQuery == nullptr)
+	{
+		// Add it to all connection views
+		AddNetObjectViewToAllConnectionViews(netObj);
 
-	// Let the game write it's information
-	type->writeCreate(*createMessage, localObject);
+		// Send it out to all connections
+		m_session->BroadcastMessage(CreateConstructMessage(netObj));
+	}
 
-	// Send it out to all connections
-	m_session->BroadcastMessage(createMessage);
+	m_session->UnlockNetState();
 }
 
 void NetObjectSystem::UnsyncObject(void* localObject)
 {
+	m_session->LockNetState();
+
 	// Get the NetObject for it
 	int objCount = (int)m_netObjects.size();
 
@@ -148,19 +196,32 @@ void NetObjectSystem::UnsyncObject(void* localObject)
 	ASSERT_OR_DIE(netObject != nullptr, "Error: NetObjectSystem::UnsyncObject() couldn't find object.");
 	ASSERT_OR_DIE(netObject->DoIOwn(), "Error: NetObjectSystem::UnsyncObject() tried to unsync object it doens't own.");
 
-	// Remove it from our views
-	RemoveNetObjectViewFromAllConnectionViews(netObject);
+	// With interest management only the connections that have it need to hear about it
+	if (m_relevanceQuery != nullptr)
+	{
+		for (int connectionIndex = 0; connectionIndex < MAX_CONNECTIONS; ++connectionIndex)
+		{
+			NetObjectConnectionView* connectionView = m_connectionViews[connectionIndex];
+			NetConnection* connection = m_session->GetConnection((uint8_t) connectionIndex);
 
-	NetMessage* destroyMessage = new NetMessage("netobj_destroy", m_session);
+			if (connectionView != nullptr && connection != nullptr && connectionView->GetNetObjectViewForNetworkID(netObject->GetNetworkID()) != nullptr)
+			{
+				connection->Send(CreateDestroyMessage(netObject));
+			}
+		}
 
-	// Write the network ID
-	destroyMessage->Write(netObject->GetNetworkID());
+		RemoveNetObjectViewFromAllConnectionViews(netObject);
+	}
+	else
+	{
+		// Remove it from our views
+		RemoveNetObjectViewFromAllConnectionViews(netObject);
 
-	// Let the game write any destroy information (most of the time is empty)
-	netObject->GetNetObjectType()->writeDestroy(*destroyMessage, localObject);
+		// Broadcast it
+		m_session->BroadcastMessage(CreateDestroyMessage(netObject));
+	}
 
-	// Broadcast it
-	m_session->BroadcastMessage(destroyMessage);
+	m_session->UnlockNetState();
 }
 
 void NetObjectSystem::AddConnectionViewForIndex(uint8_t connectionIndex)
@@ -170,8 +231,8 @@ void NetObjectSystem::AddConnectionViewForIndex(uint8_t connectionIndex)
 
 	NetObjectConnectionView* connView = new NetObjectConnectionView();
 
-	// Add in all current net objects in the system
-	for (int i = 0; i < (int)m_netObjects.size(); ++i)
+	// Add in all current net objects in the system, unless interest management will add them as they're relevant
+	for (int i = 0; i < (int)m_netObjects.size() && m_relevanceQuery == nullptr; ++i)
 	{
 		connView->AddNetObjectView(m_netObjects[i]);
 	}
@@ -188,64 +249,309 @@ void NetObjectSystem::ClearConnectionViewForIndex(uint8_t connectionIndex)
 	m_connectionViews[connectionIndex] = nullptr;
 }
 
+//-----------------------------------------------------------------------------------------------
+// Sets the query deciding which objects each connection has, see the header
+// Must be set before any objects are synced or connections are added
+//
+void NetObjectSystem::SetRelevanceQuery(NetObjectRelevanceQuery* query)
+{
+	ASSERT_OR_DIE(m_netObjects.size() == 0, "Error: NetObjectSystem::SetRelevanceQuery() called with objects already synced.");
+	m_relevanceQuery = query;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the query deciding which objects each connection has, nullptr if every connection has all of them
+//
+NetObjectRelevanceQuery* NetObjectSystem::GetRelevanceQuery() const
+{
+	return m_relevanceQuery;
+}
+
+
 std::vector<NetMessage*> NetObjectSystem::GetMessagesToConstructAllNetObjects() const
 {
 	std::vector<NetMessage*> messages;
 
+	// The interest pass sends the creates for objects as they become relevant to the connection
+	if (m_relevanceQuery != nullptr)
+	{
+		return messages;
+	}
+
 	int objCount = (int)m_netObjects.size();
 
 	for (int objIndex = 0; objIndex < objCount; ++objIndex)
 	{
-		const NetObject* obj = m_netObjects[objIndex];
+		messages.push_back(CreateConstructMessage(m_netObjects[objIndex]));
+	}
 
-		NetMessage* msg = new NetMessage("netobj_create", m_session);
+	return messages;
+}
 
-		msg->Write(obj->GetNetObjectType()->id);
-		msg->Write(obj->GetNetworkID());
 
-		obj->GetNetObjectType()->writeCreate(*msg, obj->GetLocalObject());
+//-----------------------------------------------------------------------------------------------
+// Returns the connection's views of objects we own, highest update priority first
+//
+const std::vector<NetObjectView*>& NetObjectSystem::GetSnapshotViewsByPriority(uint8_t connectionIndex)
+{
+	static const std::vector<NetObjectView*> s_noViews;
 
-		messages.push_back(msg);
+	if (m_netObjects.size() == 0)
+	{
+		return s_noViews;
 	}
 
-	return messages;
+	NetObjectConnectionView* connectionView = m_connectionViews[connectionIndex];
+	ASSERT_OR_DIE(connectionView != nullptr, "Error: NetObjectSystem::GetSnapshotViewsByPriority() had null ConnectionView for current connection.");
+
+	return connectionView->GetViewsByPriority(connectionIndex);
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Creates and returns the next snapshot message to send out, based on age
-// Returns false if a message couldn't be created
+// Writes the view's update message, to be committed with NetObjectView::CommitPendingSnapshot() if it's sent
+// Objects unchanged since the connection's baseline are skipped; the rest are written as the fields
+// (or for types without field deltas, the bytes) that changed against it, or in full when there's no
+// baseline to use
+// Returns false if the object doesn't need an update
 //
-bool NetObjectSystem::GetNextSnapshotUpdateMessage(NetMessage* out_message, uint8_t connectionIndex)
+bool NetObjectSystem::WriteSnapshotUpdateMessage(NetObjectView* objectView, NetMessage* out_message)
 {
-	int netObjectCount = (int)m_netObjects.size();
+	NetObject* netObject = objectView->GetNetObject();
+	const NetObjectType_t* type = netObject->GetNetObjectType();
+
+	NetMessage serialized;
+	type->writeSnapshot(serialized, netObject->GetLocalSnapshot());
+
+	const uint8_t* bytes = (const uint8_t*) serialized.GetBuffer();
+	size_t byteCount = serialized.GetWrittenByteCount();
+
+	// Byte deltas need the same layout as the baseline, field deltas are decoded so can change size
+	const SnapshotRecord_t* baseline = objectView->GetUsableBaseline();
+	if (baseline != nullptr && type->writeSnapshotDelta == nullptr && baseline->bytes.size() != byteCount)
+	{
+		baseline = nullptr;
+	}
 
-	if (netObjectCount == 0)
+	// The connection already has this exact state, so it has nothing to wait for
+	if (baseline != nullptr && baseline->bytes.size() == byteCount && memcmp(baseline->bytes.data(), bytes, byteCount) == 0)
 	{
+		objectView->ResetPriority();
 		return false;
 	}
 
-	// Find the NetObjectView with minimum age
+	objectView->SetPendingSnapshot(bytes, byteCount);
+
+	out_message->Write(netObject->GetNetworkID());
+	out_message->Write(objectView->GetNextSequence());
+	out_message->Write(QuantizeSnapshotTime(netObject->GetLocalSnapshotTime()));
+
+	if (baseline == nullptr)
+	{
+		out_message->Write((uint16_t) INVALID_SNAPSHOT_SEQUENCE);
+		out_message->WriteSize(byteCount);
+
+		for (size_t byteIndex = 0; byteIndex < byteCount; ++byteIndex)
+		{
+			out_message->Write(bytes[byteIndex]);
+		}
+	}
+	else if (type->writeSnapshotDelta != nullptr)
+	{
+		out_message->Write(baseline->sequence);
+
+		// Compared as decoded, so the sender diffs against exactly what the receiver will fill from
+		void* baselineSnapshot = m_deltaBaselineScratch.data();
+		NetMessage baselineMessage(out_message->GetDefinition(), (void*) baseline->bytes.data(), (int16_t) baseline->bytes.size());
+		baselineMessage.AdvanceWriteHead(baseline->bytes.size());
+
+		type->readSnapshot(baselineMessage, baselineSnapshot);
+		type->writeSnapshotDelta(*out_message, netObject->GetLocalSnapshot(), baselineSnapshot);
+	}
+	else
+	{
+		out_message->Write(baseline->sequence);
+
+		// Mask of the changed bytes, then just those bytes
+		for (size_t byteIndex = 0; byteIndex < byteCount; ++byteIndex)
+		{
+			out_message->WriteBit(bytes[byteIndex] != baseline->bytes[byteIndex]);
+		}
+		out_message->FlushBits();
+
+		for (size_t byteIndex = 0; byteIndex < byteCount; ++byteIndex)
+		{
+			if (bytes[byteIndex] != baseline->bytes[byteIndex])
+			{
+				out_message->Write(bytes[byteIndex]);
+			}
+		}
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Called when a packet to the connection is acked, making its snapshots candidates for the baselines
+//
+void NetObjectSystem::OnSnapshotsAcked(uint8_t connectionIndex, const PacketTracker_t& tracker)
+{
 	NetObjectConnectionView* connectionView = m_connectionViews[connectionIndex];
-	ASSERT_OR_DIE(connectionView != nullptr, "Error: NetObjectSystem::GetNextSnapshotUpdateMessage() had null ConnectionView for current connection.");
+	if (connectionView == nullptr)
+	{
+		return;
+	}
+
+	for (int snapshotIndex = 0; snapshotIndex < (int) tracker.m_snapshotsInPacket; ++snapshotIndex)
+	{
+		NetObjectView* objectView = connectionView->GetNetObjectViewForNetworkID(tracker.m_sentSnapshotNetworkIDs[snapshotIndex]);
+
+		// Object may have been unsynced since
+		if (objectView != nullptr)
+		{
+			objectView->OnSnapshotAcked(tracker.m_sentSnapshotSequences[snapshotIndex]);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Rebuilds the snapshot in the update message, keeps it for later deltas, and reads it into the
+// object's last received snapshot if it's newer than the one there
+// Returns false if the message was bad or its baseline is no longer kept
+//
+bool NetObjectSystem::ReadSnapshotUpdateMessage(NetMessage* message)
+{
+	uint16_t networkID = 0xffff;
 
-	NetObjectView* objectView = connectionView->GetNextObjectViewToSendUpdateFor();
+	if (!message->Read(networkID))
+	{
+		ERROR_AND_DIE("Error: NetObjectSystem::ReadSnapshotUpdateMessage() couldn't read the network ID");
+	}
 
-	// Returns null if all the views have an elapsed time of 0.f, meaning they're up-to-date already
-	if (objectView == nullptr)
+	uint16_t sequence;
+	uint16_t quantizedTime;
+	uint16_t baselineSequence;
+	if (message->Read(sequence) < sizeof(uint16_t) || message->Read(quantizedTime) < sizeof(uint16_t)
+		|| message->Read(baselineSequence) < sizeof(uint16_t))
+	{
+		return false;
+	}
+
+	NetObject* netObject = GetNetObjectForNetworkID(networkID);
+
+	if (netObject == nullptr)
 	{
 		return false;
 	}
 
-	NetObject* netObject = objectView->GetNetObject();
 	const NetObjectType_t* type = netObject->GetNetObjectType();
 
-	// Write the network ID
-	out_message->Write(netObject->GetNetworkID());
+	uint8_t bytes[MESSAGE_MTU];
+	size_t byteCount = 0;
+
+	if (baselineSequence == INVALID_SNAPSHOT_SEQUENCE)
+	{
+		message->ReadSize(&byteCount);
+
+		if (byteCount > MESSAGE_MTU || message->GetRemainingReadableByteCount() < byteCount)
+		{
+			return false;
+		}
+
+		for (size_t byteIndex = 0; byteIndex < byteCount; ++byteIndex)
+		{
+			message->Read(bytes[byteIndex]);
+		}
+	}
+	else
+	{
+		const SnapshotRecord_t* baseline = netObject->GetReceivedSnapshot(baselineSequence);
+
+		if (baseline == nullptr)
+		{
+			return false;
+		}
+
+		byteCount = baseline->bytes.size();
+
+		// Field deltas fill the baseline's decoded snapshot in, then serialize it again to keep as the next baseline
+		if (type->readSnapshotDelta != nullptr)
+		{
+			void* baselineSnapshot = m_deltaBaselineScratch.data();
+			void* resultSnapshot = m_deltaResultScratch.data();
+
+			NetMessage baselineMessage(message->GetDefinition(), (void*) baseline->bytes.data(), (int16_t) byteCount);
+			baselineMessage.AdvanceWriteHead(byteCount);
+			type->readSnapshot(baselineMessage, baselineSnapshot);
+
+			if (!type->readSnapshotDelta(*message, baselineSnapshot, resultSnapshot))
+			{
+				return false;
+			}
+
+			NetMessage serialized;
+			type->writeSnapshot(serialized, resultSnapshot);
+
+			byteCount = serialized.GetWrittenByteCount();
+			if (byteCount > MESSAGE_MTU)
+			{
+				return false;
+			}
+
+			memcpy(bytes, serialized.GetBuffer(), byteCount);
+		}
+		else
+		{
+			bool changed[MESSAGE_MTU];
+			for (size_t byteIndex = 0; byteIndex < byteCount; ++byteIndex)
+			{
+				if (!message->ReadBit(changed[byteIndex]))
+				{
+					return false;
+				}
+			}
+			message->EndBitRead();
+
+			for (size_t byteIndex = 0; byteIndex < byteCount; ++byteIndex)
+			{
+				bytes[byteIndex] = baseline->bytes[byteIndex];
+
+				if (changed[byteIndex] && message->Read(bytes[byteIndex]) == 0)
+				{
+					return false;
+				}
+			}
+		}
+	}
+
+	netObject->StoreReceivedSnapshot(sequence, bytes, byteCount);
 
-	// Write the snapshot
-	type->writeSnapshot(*out_message, netObject->GetLocalSnapshot());
-	objectView->ResetTimeSinceLastSend();
+	float snapshotTime = UnquantizeSnapshotTime(quantizedTime, m_session->GetCurrentNetTime());
+
+	// Late packets still serve as baselines and fill in the interpolation buffer, but never roll the
+	// last received snapshot back
+	if (netObject->IsNewerThanLastApplied(sequence))
+	{
+		OnSnapshotSampleReceived(netObject, snapshotTime);
+
+		NetMessage snapshotMessage(message->GetDefinition(), bytes, (int16_t) byteCount);
+		snapshotMessage.AdvanceWriteHead(byteCount);
+
+		type->readSnapshot(snapshotMessage, netObject->GetLastReceivedSnapshot());
+		netObject->SetLastAppliedSequence(sequence);
+	}
+
+	void* sampleSnapshot = netObject->AddInterpolationSample(snapshotTime, sequence);
+	if (sampleSnapshot != nullptr)
+	{
+		NetMessage snapshotMessage(message->GetDefinition(), bytes, (int16_t) byteCount);
+		snapshotMessage.AdvanceWriteHead(byteCount);
+
+		type->readSnapshot(snapshotMessage, sampleSnapshot);
+	}
 
 	return true;
 }
@@ -314,14 +620,171 @@ void NetObjectSystem::UpdateLocalSnapshots()
 {
 	int netObjCount = (int)m_netObjects.size();
 
+	float currentTime = m_session->GetCurrentNetTime();
+
 	for (int i = 0; i < netObjCount; ++i)
 	{
 		const NetObjectType_t* type = m_netObjects[i]->GetNetObjectType();
 		type->makeSnapshot(m_netObjects[i]->GetLocalSnapshot(), m_netObjects[i]->GetLocalObject());
+		m_netObjects[i]->SetLocalSnapshotTime(currentTime);
+
+		if (m_netObjects[i]->DoIOwn())
+		{
+			m_netObjects[i]->RecordSnapshotHistory(currentTime);
+		}
 	}
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Moves the delay toward the time between snapshots plus a few deviations of their transit time,
+// slowly, so objects slow down or speed up slightly instead of jumping when it changes
+//
+void NetObjectSystem::UpdateInterpolationDelay()
+{
+	float targetDelay = m_averageSnapshotSpacing + NET_INTERPOLATION_JITTER_SCALE * m_snapshotJitter;
+	targetDelay = ClampFloat(targetDelay, NET_INTERPOLATION_MIN_DELAY, NET_INTERPOLATION_MAX_DELAY);
+
+	float maxChange = NET_INTERPOLATION_DELAY_ADJUST_RATE * Clock::GetMasterDeltaTime();
+	m_interpolationDelay += ClampFloat(targetDelay - m_interpolationDelay, -maxChange, maxChange);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Applies the state of each object we don't own at the delayed net time, blended between the two
+// samples around it or the newest one if it's run past them all
+//
+void NetObjectSystem::ApplyReceivedSnapshots()
+{
+	float renderTime = m_session->GetCurrentNetTime() - m_interpolationDelay;
+	int netObjCount = (int)m_netObjects.size();
+
+	for (int i = 0; i < netObjCount; ++i)
+	{
+		NetObject* netObject = m_netObjects[i];
+		const NetObjectType_t* type = netObject->GetNetObjectType();
+
+		if (netObject->DoIOwn() || type->applySnapshot == nullptr)
+		{
+			continue;
+		}
+
+		netObject->DropSamplesBefore(renderTime);
+
+		int sampleCount = netObject->GetInterpolationSampleCount();
+		if (sampleCount == 0)
+		{
+			continue;
+		}
+
+		const InterpolationSample_t& from = netObject->GetInterpolationSample(0);
+
+		if (sampleCount == 1 || renderTime <= from.time)
+		{
+			type->applySnapshot(from.snapshot, netObject->GetLocalObject());
+			continue;
+		}
+
+		// Dropping samples left the first at or before renderTime, so this is the one after
+		const InterpolationSample_t& to = netObject->GetInterpolationSample(1);
+
+		if (type->interpolateSnapshot == nullptr)
+		{
+			type->applySnapshot(from.snapshot, netObject->GetLocalObject());
+			continue;
+		}
+
+		float t = ClampFloat((renderTime - from.time) / (to.time - from.time), 0.f, 1.f);
+		type->interpolateSnapshot(netObject->GetInterpolatedSnapshot(), from.snapshot, to.snapshot, t);
+		type->applySnapshot(netObject->GetInterpolatedSnapshot(), netObject->GetLocalObject());
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Updates the jitter buffer estimates with a snapshot that's newer than any received for the object
+// Jitter is the smoothed change in transit time between snapshots, as in RTP (RFC 3550)
+//
+void NetObjectSystem::OnSnapshotSampleReceived(NetObject* netObject, float snapshotTime)
+{
+	float transit = m_session->GetCurrentNetTime() - snapshotTime;
+
+	if (m_hasSnapshotTransit)
+	{
+		float deviation = AbsoluteValue(transit - m_lastSnapshotTransit);
+		m_snapshotJitter += (deviation - m_snapshotJitter) * (1.f / 16.f);
+	}
+
+	m_lastSnapshotTransit = transit;
+	m_hasSnapshotTransit = true;
+
+	int sampleCount = netObject->GetInterpolationSampleCount();
+	if (sampleCount == 0)
+	{
+		return;
+	}
+
+	// Updates are skipped while an object doesn't change, so a long gap means it held its last state
+	// until about a snapshot ago, rather than slowly moving there the whole time
+	float spacing = snapshotTime - netObject->GetInterpolationSample(sampleCount - 1).time;
+
+	if (spacing > NET_INTERPOLATION_MAX_DELAY)
+	{
+		netObject->HoldNewestSampleUntil(snapshotTime - m_averageSnapshotSpacing);
+	}
+	else if (spacing > 0.f)
+	{
+		m_averageSnapshotSpacing += (spacing - m_averageSnapshotSpacing) * 0.1f;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns how far behind net time received snapshots are applied
+//
+float NetObjectSystem::GetInterpolationDelay() const
+{
+	return m_interpolationDelay;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the smoothed deviation in the transit time of received snapshots
+//
+float NetObjectSystem::GetSnapshotJitter() const
+{
+	return m_snapshotJitter;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the net time the connection was seeing when what it's sending now was made; with no
+// connection at the index, there's nothing to compensate for
+//
+float NetObjectSystem::GetLagCompensationTime(uint8_t connectionIndex, float viewDelay /*= 0.f*/) const
+{
+	float currentTime = m_session->GetCurrentNetTime();
+	NetConnection* connection = m_session->GetConnection(connectionIndex);
+
+	if (connection == nullptr)
+	{
+		return currentTime;
+	}
+
+	return currentTime - 0.5f * connection->GetRTT() - viewDelay;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Gets the state of the owned object as the connection saw it, see GetLagCompensationTime()
+// Returns false if the object has no history, like objects owned by someone else
+//
+bool NetObjectSystem::GetSnapshotForConnection(const NetObject* netObject, uint8_t connectionIndex, void* out_snapshot, float viewDelay /*= 0.f*/) const
+{
+	return netObject->GetSnapshotAtTime(GetLagCompensationTime(connectionIndex, viewDelay), out_snapshot);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns a network id that isn't in use
 //
@@ -366,6 +829,110 @@ uint16_t NetObjectSystem::GetUnusedNetworkID()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Gives each ready connection views of the owned objects the relevance query returns for it, sending
+// creates for the new ones, and destroys for the ones it has that are no longer relevant
+//
+void NetObjectSystem::UpdateInterest()
+{
+	m_ownedObjects.clear();
+
+	int objCount = (int)m_netObjects.size();
+	for (int objIndex = 0; objIndex < objCount; ++objIndex)
+	{
+		if (m_netObjects[objIndex]->DoIOwn())
+		{
+			m_ownedObjects.push_back(m_netObjects[objIndex]);
+		}
+	}
+
+	m_relevanceQuery->Update(m_ownedObjects);
+
+	for (int connectionIndex = 0; connectionIndex < MAX_CONNECTIONS; ++connectionIndex)
+	{
+		NetObjectConnectionView* connectionView = m_connectionViews[connectionIndex];
+		NetConnection* connection = m_session->GetConnection((uint8_t) connectionIndex);
+
+		// Connections still joining get their objects once they're ready, like the construct messages
+		if (connectionView == nullptr || connection == nullptr || connection->IsMe() || !connection->IsReady())
+		{
+			continue;
+		}
+
+		m_interestStamp++;
+		m_relevanceQuery->GetRelevantObjects((uint8_t) connectionIndex, m_relevantObjects);
+
+		// Entering
+		int relevantCount = (int)m_relevantObjects.size();
+		for (int relevantIndex = 0; relevantIndex < relevantCount; ++relevantIndex)
+		{
+			NetObject* netObject = m_relevantObjects[relevantIndex];
+			NetObjectView* objectView = connectionView->GetNetObjectViewForNetworkID(netObject->GetNetworkID());
+
+			if (objectView == nullptr)
+			{
+				objectView = new NetObjectView(netObject);
+				connectionView->AddNetObjectView(objectView);
+
+				connection->Send(CreateConstructMessage(netObject));
+			}
+
+			objectView->SetInterestStamp(m_interestStamp);
+		}
+
+		// Leaving
+		for (int viewIndex = connectionView->GetViewCount() - 1; viewIndex >= 0; --viewIndex)
+		{
+			NetObjectView* objectView = connectionView->GetViewAtIndex(viewIndex);
+			NetObject* netObject = objectView->GetNetObject();
+
+			if (objectView->GetInterestStamp() == m_interestStamp || m_relevanceQuery->ShouldStayRelevant(netObject, (uint8_t) connectionIndex))
+			{
+				continue;
+			}
+
+			connection->Send(CreateDestroyMessage(netObject));
+			connectionView->RemoveNetObjectView(netObject);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a new netobj_create message for the object
+//
+NetMessage* NetObjectSystem::CreateConstructMessage(const NetObject* netObject) const
+{
+	NetMessage* createMessage = new NetMessage("netobj_create", m_session);
+
+	// Write the NetObjectSystem-side information
+	createMessage->Write(netObject->GetNetObjectType()->id);
+	createMessage->Write(netObject->GetNetworkID());
+
+	// Let the game write it's information
+	netObject->GetNetObjectType()->writeCreate(*createMessage, netObject->GetLocalObject());
+
+	return createMessage;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a new netobj_destroy message for the object
+//
+NetMessage* NetObjectSystem::CreateDestroyMessage(const NetObject* netObject) const
+{
+	NetMessage* destroyMessage = new NetMessage("netobj_destroy", m_session);
+
+	// Write the network ID
+	destroyMessage->Write(netObject->GetNetworkID());
+
+	// Let the game write any destroy information (most of the time is empty)
+	netObject->GetNetObjectType()->writeDestroy(*destroyMessage, netObject->GetLocalObject());
+
+	return destroyMessage;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Adds a view for the given NetObject to all NetConnectionViews
 //
@@ -10,10 +10,19 @@
 #include <stdint.h>
 #include "Engine/Networking/NetObjectType.hpp"
 
+// Jitter buffer - received snapshots are applied this far behind net time, enough to cover the time
+// between snapshots plus a few deviations of their transit time
+#define NET_INTERPOLATION_MIN_DELAY (0.05f)
+#define NET_INTERPOLATION_MAX_DELAY (0.5f)
+#define NET_INTERPOLATION_JITTER_SCALE (3.f)
+#define NET_INTERPOLATION_DELAY_ADJUST_RATE (0.1f)		// Seconds of delay per second, so changes aren't seen as hitches
+
 class NetObject;
 class NetSession;
+struct PacketTracker_t;
 class NetObjectView;
 class NetObjectConnectionView;
+class NetObjectRelevanceQuery;
 
 class NetObjectSystem
 {
@@ -36,24 +45,50 @@ public:
 	void AddConnectionViewForIndex(uint8_t connectionIndex);
 	void ClearConnectionViewForIndex(uint8_t connectionIndex);
 
+	// Interest management - with a query set, each ready connection only has the objects it returns,
+	// and is sent creates and destroys as they enter and leave; not owned, nullptr replicates everything
+	void SetRelevanceQuery(NetObjectRelevanceQuery* query);
+	NetObjectRelevanceQuery* GetRelevanceQuery() const;
+
 	std::vector<NetMessage*>	GetMessagesToConstructAllNetObjects() const;
-	bool						GetNextSnapshotUpdateMessage(NetMessage* out_message, uint8_t connectionIndex);
+
+	// Snapshot updates are deltas against the last snapshot the connection acked, see NetObjectView
+	// A view's update is only committed once it's actually in a packet, so views that don't fit keep their priority
+	const std::vector<NetObjectView*>&	GetSnapshotViewsByPriority(uint8_t connectionIndex);
+	bool						WriteSnapshotUpdateMessage(NetObjectView* objectView, NetMessage* out_message);
+	void						OnSnapshotsAcked(uint8_t connectionIndex, const PacketTracker_t& tracker);
+	bool						ReadSnapshotUpdateMessage(NetMessage* message);
+
+	// Lag compensation - owned objects keep their recent snapshots, so a connection's actions can be checked
+	// against the state it saw, about half its RTT ago; viewDelay adds however far behind it renders, like
+	// its interpolation delay, if the game knows it
+	float						GetLagCompensationTime(uint8_t connectionIndex, float viewDelay = 0.f) const;
+	bool						GetSnapshotForConnection(const NetObject* netObject, uint8_t connectionIndex, void* out_snapshot, float viewDelay = 0.f) const;
 
 	// Accessors
 	const NetObjectType_t*	GetNetObjectTypeForTypeID(uint8_t typeID) const;
 	NetObject*				GetNetObjectForLocalObject(void* localObject);
 	NetObject*				GetNetObjectForNetworkID(uint16_t networkID);
+	float					GetInterpolationDelay() const;
+	float					GetSnapshotJitter() const;
 
 
 private:
 	//-----Private Methods-----
 	
 	void			UpdateLocalSnapshots();
+	void			UpdateInterpolationDelay();
+	void			ApplyReceivedSnapshots();
+	void			OnSnapshotSampleReceived(NetObject* netObject, float snapshotTime);
 	uint16_t		GetUnusedNetworkID();
 
 	void			AddNetObjectViewToAllConnectionViews(NetObject* netObject);
 	void			RemoveNetObjectViewFromAllConnectionViews(NetObject* netObject);
 
+	void			UpdateInterest();
+	NetMessage*		CreateConstructMessage(const NetObject* netObject) const;
+	NetMessage*		CreateDestroyMessage(const NetObject* netObject) const;
+
 
 private:
 	//-----Private Data-----
@@ -65,4 +100,20 @@ private:
 
 	NetObjectConnectionView*		m_connectionViews[MAX_CONNECTIONS];
 
+	NetObjectRelevanceQuery*		m_relevanceQuery = nullptr;
+	uint32_t						m_interestStamp = 0;
+	std::vector<NetObject*>			m_ownedObjects;			// Scratch for the interest pass
+	std::vector<NetObject*>			m_relevantObjects;
+
+	// Jitter buffer, estimated from the snapshots received
+	float							m_interpolationDelay = NET_INTERPOLATION_MIN_DELAY;
+	float							m_snapshotJitter = 0.f;			// Smoothed deviation of transit time
+	float							m_lastSnapshotTransit = 0.f;
+	bool							m_hasSnapshotTransit = false;
+	float							m_averageSnapshotSpacing = 0.f;	// Smoothed time between an object's snapshots
+
+	// Field deltas decode the baseline to compare and fill from, sized to the largest registered snapshot
+	std::vector<uint8_t>			m_deltaBaselineScratch;
+	std::vector<uint8_t>			m_deltaResultScratch;
+
 };
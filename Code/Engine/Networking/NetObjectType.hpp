@@ -6,6 +6,7 @@
 /************************************************************************/
 #pragma once
 #include <stdint.h>
+#include "Engine/Math/Vector3.hpp"
 
 class NetMessage;
 
@@ -19,6 +20,20 @@ typedef void(*NetObjectWriteSnapshot)(NetMessage& msg, const void* snapshot);
 typedef void(*NetObjectReadSnapshot)(NetMessage& msg, void* out_snapshot);
 typedef void(*NetObjectApplySnapshot)(void* snapshot, void* object);
 
+// Field deltas - for types written by fields, i.e. through NetSnapshotSchema; written against the decoded baseline,
+// and read back into the full snapshot from it
+typedef void(*NetObjectWriteSnapshotDelta)(NetMessage& msg, const void* snapshot, const void* baseline);
+typedef bool(*NetObjectReadSnapshotDelta)(NetMessage& msg, const void* baseline, void* out_snapshot);
+
+// Blends two snapshots, t from 0 at from to 1 at to
+typedef void(*NetObjectInterpolateSnapshot)(void* out_snapshot, const void* from, const void* to, float t);
+
+// How much the object matters to the connection, like 0 for out of view up to 1 for right next to them
+typedef float(*NetObjectGetRelevance)(const void* object, uint8_t connectionIndex);
+
+// Where the object is, for spatial relevance queries like NetObjectInterestGrid
+typedef Vector3(*NetObjectGetSnapshotPosition)(const void* snapshot);
+
 struct NetObjectType_t
 {
 	// ID
@@ -37,4 +52,21 @@ struct NetObjectType_t
 	NetObjectReadSnapshot		readSnapshot;
 	NetObjectApplySnapshot		applySnapshot;
 
+	// Updates against a baseline carry a mask of the changed fields and just those; types without these
+	// send a mask of the serialized bytes that changed instead
+	NetObjectWriteSnapshotDelta	writeSnapshotDelta = nullptr;
+	NetObjectReadSnapshotDelta	readSnapshotDelta = nullptr;
+
+	// Received snapshots are applied a jitter buffer's delay behind net time; types without this
+	// step from one snapshot to the next instead of blending
+	NetObjectInterpolateSnapshot	interpolateSnapshot = nullptr;
+
+	// Update priority - accumulates each tick by elapsed time * weight * relevance, so heavier or more
+	// relevant types are sent sooner; relevance is 1 without a callback
+	float						priorityWeight = 1.f;
+	NetObjectGetRelevance		getRelevance = nullptr;
+
+	// Interest management - types without a position are relevant to every connection
+	NetObjectGetSnapshotPosition	getSnapshotPosition = nullptr;
+
 };
\ No newline at end of file
@@ -21,3 +21,100 @@ void NetObjectView::ResetTimeSinceLastSend()
 	m_lastSentTimer.Reset();
 }
 
+uint16_t NetObjectView::GetNextSequence() const
+{
+	return m_nextSequence;
+}
+
+void NetObjectView::SetPendingSnapshot(const uint8_t* bytes, size_t byteCount)
+{
+	m_pendingSnapshot.sequence = m_nextSequence;
+	m_pendingSnapshot.bytes.assign(bytes, bytes + byteCount);
+}
+
+uint16_t NetObjectView::CommitPendingSnapshot()
+{
+	uint16_t sequence = m_nextSequence;
+
+	SnapshotRecord_t& record = m_sentSnapshots[sequence % NET_SNAPSHOT_HISTORY_SIZE];
+	record.sequence = sequence;
+	record.bytes.swap(m_pendingSnapshot.bytes);
+	m_pendingSnapshot.sequence = INVALID_SNAPSHOT_SEQUENCE;
+
+	m_priority = 0.f;
+	m_lastSentTimer.Reset();
+
+	++m_nextSequence;
+	if (m_nextSequence == INVALID_SNAPSHOT_SEQUENCE)
+	{
+		++m_nextSequence;
+	}
+
+	return sequence;
+}
+
+void NetObjectView::OnSnapshotAcked(uint16_t sequence)
+{
+	const SnapshotRecord_t& record = m_sentSnapshots[sequence % NET_SNAPSHOT_HISTORY_SIZE];
+
+	// Already replaced by a newer send, or older than the baseline we have
+	if (record.sequence != sequence)
+	{
+		return;
+	}
+
+	if (m_baseline.sequence != INVALID_SNAPSHOT_SEQUENCE && !IsSnapshotSequenceNewer(sequence, m_baseline.sequence))
+	{
+		return;
+	}
+
+	m_baseline = record;
+}
+
+const SnapshotRecord_t* NetObjectView::GetUsableBaseline() const
+{
+	if (m_baseline.sequence == INVALID_SNAPSHOT_SEQUENCE)
+	{
+		return nullptr;
+	}
+
+	// The receiver keeps the last NET_SNAPSHOT_HISTORY_SIZE sequences, so past that it may be gone
+	uint16_t distance = m_nextSequence - m_baseline.sequence;
+	if (distance >= NET_SNAPSHOT_HISTORY_SIZE)
+	{
+		return nullptr;
+	}
+
+	return &m_baseline;
+}
+
+void NetObjectView::SetInterestStamp(uint32_t stamp)
+{
+	m_interestStamp = stamp;
+}
+
+uint32_t NetObjectView::GetInterestStamp() const
+{
+	return m_interestStamp;
+}
+
+void NetObjectView::SetNextSequence(uint16_t sequence)
+{
+	m_nextSequence = sequence;
+}
+
+void NetObjectView::AccumulatePriority(float amount)
+{
+	m_priority += amount;
+}
+
+void NetObjectView::ResetPriority()
+{
+	m_priority = 0.f;
+}
+
+float NetObjectView::GetPriority() const
+{
+	return m_priority;
+}
+
@@ -7,8 +7,7 @@
 /************************************************************************/
 #pragma once
 #include "Engine/Core/Time/Stopwatch.hpp"
-
-class NetObject;
+#include "Engine/Networking/NetObject.hpp"
 
 class NetObjectView
 {
@@ -24,10 +23,38 @@ public:
 	float GetTimeSinceLastSend() const;
 	NetObject* GetNetObject() const;
 
+	// Delta baselines - the newest snapshot the connection acked is the baseline, while it's
+	// still recent enough that the receiver is guaranteed to have kept it
+	// Updates are written with the next sequence, and only recorded once they make it into a packet
+	uint16_t				GetNextSequence() const;
+	void					SetPendingSnapshot(const uint8_t* bytes, size_t byteCount);
+	uint16_t				CommitPendingSnapshot();
+	void					OnSnapshotAcked(uint16_t sequence);
+	const SnapshotRecord_t*	GetUsableBaseline() const;
+
+	// Interest - stamped by each interest pass the object is relevant in; the sequence is carried
+	// over when a connection loses and regains an object, so late updates from before can't look newer
+	void					SetInterestStamp(uint32_t stamp);
+	uint32_t				GetInterestStamp() const;
+	void					SetNextSequence(uint16_t sequence);
+
+	// Priority - grows until the object is sent, so objects left out of a full packet go first next time
+	void					AccumulatePriority(float amount);
+	void					ResetPriority();
+	float					GetPriority() const;
+
 	
 private:
 	//-----Private Data-----
 	
 	NetObject* m_netObject = nullptr;
 	Stopwatch m_lastSentTimer;
+
+	SnapshotRecord_t	m_sentSnapshots[NET_SNAPSHOT_HISTORY_SIZE];	// By sequence % NET_SNAPSHOT_HISTORY_SIZE
+	uint16_t			m_nextSequence = 0;
+	SnapshotRecord_t	m_baseline;
+	SnapshotRecord_t	m_pendingSnapshot;
+
+	float				m_priority = 0.f;
+	uint32_t			m_interestStamp = 0;
 };
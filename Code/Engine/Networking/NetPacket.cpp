@@ -7,6 +7,18 @@
 #include "Engine/Networking/NetPacket.hpp"
 #include "Engine/Networking/NetMessage.hpp"
 #include "Engine/Networking/NetSession.hpp"
+#include "Engine/DataStructures/SlabAllocator.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the allocator all heap packets come from, created on first use
+//
+static SlabAllocator& GetPacketAllocator()
+{
+	static SlabAllocator s_packetAllocator(sizeof(NetPacket), NET_PACKETS_PER_SLAB);
+	return s_packetAllocator;
+}
 
 //-----------------------------------------------------------------------------------------------
 // Constructor
@@ -140,7 +152,8 @@ bool NetPacket::WriteMessage(const NetMessage* message)
 
 
 //-----------------------------------------------------------------------------------------------
-// Reads the message and returns it in out_message
+// Reads the message and returns it in out_message, as a view into this packet's buffer unless it had
+// to be decompressed, so it's only valid until the packet is reset
 //
 bool NetPacket::ReadMessage(NetMessage* out_message, NetSession* session)
 {
@@ -204,23 +217,41 @@ bool NetPacket::ReadMessage(NetMessage* out_message, NetSession* session)
 		}
 	}
 
-	// Read the message payload
+	// The message views its payload in place, it's only copied if it has to outlive the packet
 	int16_t payloadSize = headerAndPayloadSize - msgHeaderSize;
-	int8_t payload[MESSAGE_MTU];
-	amountRead = ReadBytes(payload, payloadSize);
+	if (payloadSize < 0 || payloadSize > MESSAGE_MTU || (size_t) payloadSize > GetRemainingReadableByteCount())
+	{
+		return false;
+	}
 
-	// Construct the message
-	*out_message = NetMessage(definition, payload, payloadSize);
+	out_message->SetAsView(definition, m_buffer + m_readHead, (uint16_t) payloadSize);
+	AdvanceReadHead(payloadSize);
 
 	out_message->AssignReliableID(reliableID);
 	out_message->AssignSequenceID(sequenceID);
 
-	out_message->AdvanceWriteHead(payloadSize);
+	if (definition->IsCompressed())
+	{
+		return out_message->UnpackPayload();
+	}
 
 	return true;
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Empties the packet and clears its connection indices, so pooled packets can be reused
+//
+void NetPacket::Reset()
+{
+	ResetRead();
+	ResetWrite();
+
+	m_senderIndex = INVALID_CONNECTION_INDEX;
+	m_receiverIndex = INVALID_CONNECTION_INDEX;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Sets the sender connection index of the packet to the one provided
 //
@@ -268,3 +299,22 @@ bool NetPacket::CanFitMessage(const NetMessage* message) const
 
 	return (freeSpace >= messageSize);
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns memory for a NetPacket from the packet slabs, only going to the heap for a new slab
+//
+void* NetPacket::operator new(size_t size)
+{
+	ASSERT_OR_DIE(size == sizeof(NetPacket), "NetPacket allocated with the wrong size");
+	return GetPacketAllocator().Allocate();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the memory to the packet slabs
+//
+void NetPacket::operator delete(void* memory)
+{
+	GetPacketAllocator().Free(memory);
+}
@@ -24,6 +24,9 @@
 
 #define INVALID_PACKET_ACK (0xffff)
 
+// Packets are allocated from slabs of this many, which are kept and reused for the program's lifetime
+#define NET_PACKETS_PER_SLAB (32)
+
 // Predeclarations
 class NetMessage;
 
@@ -58,6 +61,10 @@ public:
 	NetPacket();
 	NetPacket(uint8_t* buffer, size_t bufferSize);
 
+	// Pooled allocation - heap packets come from a shared slab allocator, and go back to it on delete
+	static void* operator new(size_t size);
+	static void operator delete(void* memory);
+
 	// Header Methods
 	void		WriteHeader(const PacketHeader_t& header);
 	bool		ReadHeader(PacketHeader_t& out_header);
@@ -67,6 +74,7 @@ public:
 	bool		ReadMessage(NetMessage* out_message, NetSession* session);
 
 	// Mutators
+	void		Reset();		// Empties the packet for reuse
 	void		SetSenderConnectionIndex(uint8_t index);
 	void		SetReceiverConnectionIndex(uint8_t index);
 
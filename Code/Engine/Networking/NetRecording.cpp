@@ -0,0 +1,302 @@
+/************************************************************************/
+/* File: NetRecording.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the NetRecording classes
+/************************************************************************/
+#include "Engine/Core/File.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Networking/NetRecording.hpp"
+#include <string.h>
+
+#define NET_RECORDING_FILE_HEADER_SIZE (sizeof(uint32_t) + sizeof(uint16_t))
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Appends the bytes of the value to the buffer
+//
+template <typename T>
+void AppendToRecordingBuffer(std::vector<uint8_t>& buffer, const T& value)
+{
+	const uint8_t* bytes = (const uint8_t*) &value;
+	buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Reads a value out of the data at offset, advancing it
+//
+template <typename T>
+T ReadFromRecordingData(const uint8_t* data, size_t& offset)
+{
+	T value;
+	memcpy(&value, data + offset, sizeof(T));
+	offset += sizeof(T);
+
+	return value;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+NetRecordingWriter::NetRecordingWriter()
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor - writes out anything still buffered
+//
+NetRecordingWriter::~NetRecordingWriter()
+{
+	Close();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Creates the recording file, replacing any recording already open
+//
+bool NetRecordingWriter::Open(const std::string& filePath)
+{
+	Close();
+
+	m_file = new File();
+	if (!m_file->Open(filePath.c_str(), "wb"))
+	{
+		LogTaggedPrintf("NET", "Error: NetRecordingWriter::Open() couldn't open file \"%s\"", filePath.c_str());
+
+		delete m_file;
+		m_file = nullptr;
+		return false;
+	}
+
+	m_buffer.clear();
+	m_buffer.reserve(NET_RECORDING_FLUSH_SIZE + NET_RECORDING_RECORD_HEADER_SIZE + UINT16_MAX);
+
+	AppendToRecordingBuffer(m_buffer, (uint32_t) NET_RECORDING_MAGIC);
+	AppendToRecordingBuffer(m_buffer, (uint16_t) NET_RECORDING_VERSION);
+
+	m_recordCount = 0;
+
+	LogTaggedPrintf("NET", "Started recording messages to \"%s\"", filePath.c_str());
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the rest of the records and closes the file
+//
+void NetRecordingWriter::Close()
+{
+	if (m_file == nullptr)
+	{
+		return;
+	}
+
+	FlushBuffer();
+
+	LogTaggedPrintf("NET", "Stopped recording messages to \"%s\", %u records written", m_file->GetFilePathOpened().c_str(), m_recordCount);
+
+	m_file->Close();
+	delete m_file;
+	m_file = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if records are being written
+//
+bool NetRecordingWriter::IsOpen() const
+{
+	return (m_file != nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a record of the message payload, stamped with the net time it ran at
+//
+void NetRecordingWriter::Record(float netTime, uint32_t nameHash, const void* data, size_t byteCount)
+{
+	if (m_file == nullptr || byteCount > UINT16_MAX)
+	{
+		return;
+	}
+
+	AppendToRecordingBuffer(m_buffer, netTime);
+	AppendToRecordingBuffer(m_buffer, nameHash);
+	AppendToRecordingBuffer(m_buffer, (uint16_t) byteCount);
+
+	const uint8_t* bytes = (const uint8_t*) data;
+	m_buffer.insert(m_buffer.end(), bytes, bytes + byteCount);
+
+	m_recordCount++;
+
+	if (m_buffer.size() >= NET_RECORDING_FLUSH_SIZE)
+	{
+		FlushBuffer();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of records written since the recording was opened
+//
+unsigned int NetRecordingWriter::GetRecordCount() const
+{
+	return m_recordCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the buffered records to the file
+//
+void NetRecordingWriter::FlushBuffer()
+{
+	if (m_buffer.size() > 0)
+	{
+		m_file->Write(m_buffer.data(), m_buffer.size());
+		m_file->Flush();
+		m_buffer.clear();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+NetRecordingReader::NetRecordingReader()
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+NetRecordingReader::~NetRecordingReader()
+{
+	Close();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Loads the recording into memory and checks its header
+//
+bool NetRecordingReader::Open(const std::string& filePath)
+{
+	Close();
+
+	m_file = new File();
+	if (!m_file->Open(filePath.c_str(), "rb") || !m_file->LoadFileToMemory())
+	{
+		LogTaggedPrintf("NET", "Error: NetRecordingReader::Open() couldn't load file \"%s\"", filePath.c_str());
+
+		Close();
+		return false;
+	}
+
+	m_data = (const uint8_t*) m_file->GetData();
+	m_size = m_file->GetSize();
+	m_offset = 0;
+
+	if (m_size < NET_RECORDING_FILE_HEADER_SIZE)
+	{
+		LogTaggedPrintf("NET", "Error: NetRecordingReader::Open() file \"%s\" is too small to be a recording", filePath.c_str());
+
+		Close();
+		return false;
+	}
+
+	uint32_t magic = ReadFromRecordingData<uint32_t>(m_data, m_offset);
+	uint16_t version = ReadFromRecordingData<uint16_t>(m_data, m_offset);
+
+	if (magic != NET_RECORDING_MAGIC || version != NET_RECORDING_VERSION)
+	{
+		LogTaggedPrintf("NET", "Error: NetRecordingReader::Open() file \"%s\" isn't a version %i recording", filePath.c_str(), NET_RECORDING_VERSION);
+
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Frees the loaded recording
+//
+void NetRecordingReader::Close()
+{
+	if (m_file != nullptr)
+	{
+		m_file->Close();
+		delete m_file;
+		m_file = nullptr;
+	}
+
+	m_data = nullptr;
+	m_size = 0;
+	m_offset = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if a recording is loaded
+//
+bool NetRecordingReader::IsOpen() const
+{
+	return (m_data != nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the next record without moving past it
+//
+bool NetRecordingReader::PeekNextRecord(NetRecordingRecord_t& out_record) const
+{
+	if (m_data == nullptr || m_size - m_offset < NET_RECORDING_RECORD_HEADER_SIZE)
+	{
+		return false;
+	}
+
+	size_t offset = m_offset;
+
+	out_record.netTime = ReadFromRecordingData<float>(m_data, offset);
+	out_record.nameHash = ReadFromRecordingData<uint32_t>(m_data, offset);
+	out_record.byteCount = ReadFromRecordingData<uint16_t>(m_data, offset);
+
+	if (m_size - offset < out_record.byteCount)
+	{
+		return false;
+	}
+
+	out_record.data = m_data + offset;
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the next record and moves past it
+//
+bool NetRecordingReader::GetNextRecord(NetRecordingRecord_t& out_record)
+{
+	if (!PeekNextRecord(out_record))
+	{
+		return false;
+	}
+
+	m_offset += NET_RECORDING_RECORD_HEADER_SIZE + out_record.byteCount;
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Goes back to the first record
+//
+void NetRecordingReader::Rewind()
+{
+	if (m_data != nullptr)
+	{
+		m_offset = NET_RECORDING_FILE_HEADER_SIZE;
+	}
+}
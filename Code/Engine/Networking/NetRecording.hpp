@@ -0,0 +1,100 @@
+/************************************************************************/
+/* File: NetRecording.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Classes to record the messages a session runs, NetObject
+/*				traffic and game events, to a file and read them back for
+/*				playback without a server
+/************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+class File;
+
+// File layout - the magic and version, then records back to back, each a header and its payload
+// Unlike a NetCapture these are whole message payloads after decompression, so no connection is needed to read them
+#define NET_RECORDING_MAGIC (0x4C50524E)				// "NRPL"
+#define NET_RECORDING_VERSION (1)
+#define NET_RECORDING_RECORD_HEADER_SIZE (10)			// Net time, definition name hash and byte count
+#define NET_RECORDING_FLUSH_SIZE (64 * 1024)			// Records are buffered until there's this much to write
+
+// A record read from a recording, the data points into the reader's copy of the file
+struct NetRecordingRecord_t
+{
+	float			netTime = 0.f;			// Session net time the message ran at
+	uint32_t		nameHash = 0;			// Of the message definition, so IDs can differ between builds
+	uint16_t		byteCount = 0;
+	const uint8_t*	data = nullptr;
+};
+
+
+class NetRecordingWriter
+{
+public:
+	//-----Public Methods-----
+
+	NetRecordingWriter();
+	~NetRecordingWriter();
+
+	NetRecordingWriter(const NetRecordingWriter& copy) = delete;
+	NetRecordingWriter& operator=(const NetRecordingWriter& copy) = delete;
+
+	bool	Open(const std::string& filePath);
+	void	Close();
+	bool	IsOpen() const;
+
+	// Game thread only, like the message callbacks it's recorded from
+	void	Record(float netTime, uint32_t nameHash, const void* data, size_t byteCount);
+
+	unsigned int	GetRecordCount() const;
+
+
+private:
+	//-----Private Methods-----
+
+	void	FlushBuffer();
+
+
+private:
+	//-----Private Data-----
+
+	File*					m_file = nullptr;
+	std::vector<uint8_t>	m_buffer;
+	unsigned int			m_recordCount = 0;
+
+};
+
+
+class NetRecordingReader
+{
+public:
+	//-----Public Methods-----
+
+	NetRecordingReader();
+	~NetRecordingReader();
+
+	NetRecordingReader(const NetRecordingReader& copy) = delete;
+	NetRecordingReader& operator=(const NetRecordingReader& copy) = delete;
+
+	// Loads the whole recording, returning false if it's missing or not a recording
+	bool	Open(const std::string& filePath);
+	void	Close();
+	bool	IsOpen() const;
+
+	// Records come out in the order they were recorded; returns false at the end, or on a truncated record
+	bool	PeekNextRecord(NetRecordingRecord_t& out_record) const;
+	bool	GetNextRecord(NetRecordingRecord_t& out_record);
+	void	Rewind();
+
+
+private:
+	//-----Private Data-----
+
+	File*					m_file = nullptr;
+	const uint8_t*			m_data = nullptr;
+	size_t					m_size = 0;
+	size_t					m_offset = 0;
+
+};
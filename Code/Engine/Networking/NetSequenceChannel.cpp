@@ -4,9 +4,16 @@
 /* Date: October 31st 2018
 /* Description: Implementation of the NetSequenceChannel class
 /************************************************************************/
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/Time/Clock.hpp"
 #include "Engine/Networking/NetMessage.hpp"
+#include "Engine/Networking/NetSession.hpp"
+#include "Engine/Networking/NetConnection.hpp"
 #include "Engine/Networking/NetSequenceChannel.hpp"
 
+static_assert((NET_SEQUENCE_WINDOW & (NET_SEQUENCE_WINDOW - 1)) == 0 && NET_SEQUENCE_WINDOW <= 0x10000, "NET_SEQUENCE_WINDOW must be a power of two that divides the sequence ID range");
+static_assert(NET_SEQUENCE_WINDOW >= RELIABLE_WINDOW, "NET_SEQUENCE_WINDOW must hold every in-order message the reliable window lets through");
+
 
 //-----------------------------------------------------------------------------------------------
 // Destructor
@@ -18,25 +25,42 @@ NetSequenceChannel::~NetSequenceChannel()
 
 
 //-----------------------------------------------------------------------------------------------
-// Adds the given message to the queue to be processed later, avoiding duplicates
+// Holds the given message in its slot to be processed once the ones before it are, deleting it
+// instead if it's a duplicate or too far ahead to have a slot
 //
 void NetSequenceChannel::AddOutOfOrderMessage(NetMessage* msg)
 {
-	// Check for duplicates
-	int numMessages = (int)m_outOfOrderMessages.size();
-	uint16_t sequenceIDToFind = msg->GetSequenceID();
+	uint16_t sequenceID = msg->GetSequenceID();
+	uint16_t distanceAhead = sequenceID - m_nextSequenceIDToProcess;
 
-	for (int i = 0; i < numMessages; ++i)
+	// Reliable acks are per packet, so a well behaved sender never gets this far ahead
+	if (distanceAhead >= NET_SEQUENCE_WINDOW)
 	{
-		if (m_outOfOrderMessages[i]->GetSequenceID() == sequenceIDToFind)
-		{
-			// Already exists, so return
-			return;
-		}
+		LogTaggedPrintf("NET", "NetSequenceChannel dropped in-order message %u, %u ahead of the next expected", sequenceID, distanceAhead);
+		m_stats.outOfWindowCount++;
+		delete msg;
+		return;
+	}
+
+	int slot = sequenceID % NET_SEQUENCE_WINDOW;
+	if (m_heldMessages[slot] != nullptr)
+	{
+		m_stats.duplicateCount++;
+		delete msg;
+		return;
+	}
+
+	if (m_heldCount == 0)
+	{
+		m_blockedSinceTime = Clock::GetMasterClock()->GetTotalSeconds();
+		m_stats.blockedCount++;
 	}
 
-	// Doesn't exist, so add it
-	m_outOfOrderMessages.push_back(msg);
+	m_heldMessages[slot] = msg;
+	m_heldCount++;
+
+	m_stats.heldCount++;
+	m_stats.peakHeldCount = (m_heldCount > (int) m_stats.peakHeldCount ? (unsigned int) m_heldCount : m_stats.peakHeldCount);
 }
 
 
@@ -50,25 +74,28 @@ uint16_t NetSequenceChannel::GetAndIncrementNextIDToSend()
 
 
 //-----------------------------------------------------------------------------------------------
-// Returns the next sequential packet in the queue to process, nullptr if the next expected
-// message isn't in the list
+// Returns the held message with the next expected ID, nullptr if it hasn't arrived
+// The caller owns the message returned
 //
 NetMessage* NetSequenceChannel::GetNextMessageToProcess()
 {
-	// Search for the next expected ID in the list
-	int numMessages = (int)m_outOfOrderMessages.size();
+	int slot = m_nextSequenceIDToProcess % NET_SEQUENCE_WINDOW;
+	NetMessage* msg = m_heldMessages[slot];
 
-	for (int i = 0; i < numMessages; ++i)
+	if (msg == nullptr)
 	{
-		NetMessage* msg = m_outOfOrderMessages.at(i);
-		if (msg->GetSequenceID() == m_nextSequenceIDToProcess)
-		{
-			m_outOfOrderMessages.erase(m_outOfOrderMessages.begin() + i);
-			return msg;
-		}
+		return nullptr;
+	}
+
+	m_heldMessages[slot] = nullptr;
+	m_heldCount--;
+
+	if (m_heldCount == 0)
+	{
+		EndBlocking();
 	}
 
-	return nullptr;
+	return msg;
 }
 
 
@@ -86,12 +113,16 @@ void NetSequenceChannel::IncrementNextExpectedID()
 //
 void NetSequenceChannel::ClearOutOfOrderMessages()
 {
-	for (int i = 0; i < (int)m_outOfOrderMessages.size(); ++i)
+	for (int slot = 0; slot < NET_SEQUENCE_WINDOW; ++slot)
 	{
-		delete m_outOfOrderMessages[i];
+		if (m_heldMessages[slot] != nullptr)
+		{
+			delete m_heldMessages[slot];
+			m_heldMessages[slot] = nullptr;
+		}
 	}
 
-	m_outOfOrderMessages.clear();
+	m_heldCount = 0;
 }
 
 
@@ -102,3 +133,62 @@ bool NetSequenceChannel::IsMessageNextExpected(uint16_t sequenceID) const
 {
 	return (m_nextSequenceIDToProcess == sequenceID);
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of messages waiting on an earlier one
+//
+int NetSequenceChannel::GetHeldMessageCount() const
+{
+	return m_heldCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns how long the channel has been holding messages, 0 if it isn't
+//
+float NetSequenceChannel::GetCurrentBlockedSeconds() const
+{
+	if (m_heldCount == 0)
+	{
+		return 0.f;
+	}
+
+	return Clock::GetMasterClock()->GetTotalSeconds() - m_blockedSinceTime;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the channel's traffic stats
+//
+const NetSequenceChannelStats_t& NetSequenceChannel::GetStats() const
+{
+	return m_stats;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts the stats over; a block in progress is counted again from now
+//
+void NetSequenceChannel::ResetStats()
+{
+	m_stats = NetSequenceChannelStats_t();
+
+	if (m_heldCount > 0)
+	{
+		m_blockedSinceTime = Clock::GetMasterClock()->GetTotalSeconds();
+		m_stats.blockedCount = 1;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the block that just ended to the stats, once the last held message is taken
+//
+void NetSequenceChannel::EndBlocking()
+{
+	float blockedSeconds = Clock::GetMasterClock()->GetTotalSeconds() - m_blockedSinceTime;
+
+	m_stats.totalBlockedSeconds += blockedSeconds;
+	m_stats.longestBlockedSeconds = (blockedSeconds > m_stats.longestBlockedSeconds ? blockedSeconds : m_stats.longestBlockedSeconds);
+}
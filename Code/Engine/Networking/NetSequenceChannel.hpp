@@ -6,7 +6,25 @@
 /************************************************************************/
 #pragma once
 #include <stdint.h>
-#include <vector>
+
+// Messages held while waiting on an earlier one, by sequence ID % window; a power of two so the
+// slots stay the same across the ID wrapping, and at least RELIABLE_WINDOW, which bounds how far
+// ahead of the next expected ID a sender can get
+#define NET_SEQUENCE_WINDOW (64)
+
+// Since the channel was made, or the stats were last reset
+struct NetSequenceChannelStats_t
+{
+	unsigned int	heldCount = 0;				// Arrived ahead of a missing message, so had to wait
+	unsigned int	duplicateCount = 0;
+	unsigned int	outOfWindowCount = 0;		// Too far ahead to hold, dropped
+	unsigned int	peakHeldCount = 0;
+
+	// Head-of-line blocking - from a message first being held until none are
+	unsigned int	blockedCount = 0;
+	float			totalBlockedSeconds = 0.f;
+	float			longestBlockedSeconds = 0.f;
+};
 
 class NetMessage;
 class NetSequenceChannel
@@ -17,7 +35,7 @@ public:
 	~NetSequenceChannel();
 
 	// Mutators/Accessors
-	void		AddOutOfOrderMessage(NetMessage* msg);
+	void		AddOutOfOrderMessage(NetMessage* msg);		// Takes ownership, deleting duplicates and ones out of the window
 	uint16_t	GetAndIncrementNextIDToSend();
 	NetMessage* GetNextMessageToProcess();
 	void		IncrementNextExpectedID();
@@ -25,13 +43,29 @@ public:
 
 	// Producers
 	bool		IsMessageNextExpected(uint16_t sequenceID) const;
+	int			GetHeldMessageCount() const;
+	float		GetCurrentBlockedSeconds() const;		// 0 if nothing is held
+
+	const NetSequenceChannelStats_t&	GetStats() const;
+	void								ResetStats();
 	
 
+private:
+	//-----Private Methods-----
+
+	void		EndBlocking();
+
+
 private:
 	//-----Private Data-----
 	
 	uint16_t m_nextSequenceIDToSend = 0;
 	uint16_t m_nextSequenceIDToProcess = 0;
-	std::vector<NetMessage*> m_outOfOrderMessages;
+
+	NetMessage*	m_heldMessages[NET_SEQUENCE_WINDOW] = { nullptr };
+	int			m_heldCount = 0;
+	float		m_blockedSinceTime = 0.f;
+
+	NetSequenceChannelStats_t m_stats;
 
 };
@@ -7,7 +7,13 @@
 #include "Engine/Assets/AssetDB.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/Time/Time.hpp"
 #include "Engine/Core/Time/Clock.hpp"
+#include "Engine/Core/Time/FixedStepScheduler.hpp"
+#include "Engine/Core/Time/Profiler.hpp"
+#include "Engine/Core/Time/ProfileCounters.hpp"
+#include "Engine/Core/Memory/MemoryTracker.hpp"
+#include "Engine/Core/Threading/Threading.hpp"
 #include "Engine/Networking/NetObject.hpp"
 #include "Engine/Networking/UDPSocket.hpp"
 #include "Engine/Networking/NetPacket.hpp"
@@ -16,6 +22,7 @@
 #include "Engine/Rendering/Core/Renderer.hpp"
 #include "Engine/Networking/NetConnection.hpp"
 #include "Engine/Networking/NetObjectSystem.hpp"
+#include "Engine/Networking/NetLockstep.hpp"
 
 // Message callbacks
 bool OnPing(NetMessage* msg, const NetSender_t& sender);
@@ -25,13 +32,34 @@ bool OnNetObjectCreate(NetMessage* msg, const NetSender_t& sender);
 bool OnNetObjectDestroy(NetMessage* msg, const NetSender_t& sender);
 bool OnNetObjectUpdate(NetMessage* msg, const NetSender_t& sender);
 
+bool OnLockstepStart(NetMessage* msg, const NetSender_t& sender);
+bool OnLockstepInput(NetMessage* msg, const NetSender_t& sender);
+bool OnLockstepChecksum(NetMessage* msg, const NetSender_t& sender);
+bool OnLockstepLeave(NetMessage* msg, const NetSender_t& sender);
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the address packed into one integer, for looking connections up by address
+//
+static uint64_t GetAddressKey(const NetAddress_t& address)
+{
+	return (((uint64_t) address.ipv4Address) << 16) | ((uint64_t) address.port);
+}
+
 
 //-----------------------------------------------------------------------------------------------
 // Constructor
 //
 NetSession::NetSession()
+	: m_deliveries(NET_DELIVERY_QUEUE_SIZE)
 {
 	m_netObjectSystem = new NetObjectSystem(this);
+	m_lockstep = new NetLockstep(this);
+
+	memset(m_recordedMessages, 0, sizeof(m_recordedMessages));
+	m_recordedMessages[NET_MSG_OBJ_CREATE] = true;
+	m_recordedMessages[NET_MSG_OBJ_DESTROY] = true;
+	m_recordedMessages[NET_MSG_OBJ_UPDATE] = true;
 
 	RegisterCoreMessages();
 	m_netClock.Reset();
@@ -51,6 +79,31 @@ NetSession::~NetSession()
 		delete m_netObjectSystem;
 		m_netObjectSystem = nullptr;
 	}
+
+	if (m_lockstep != nullptr)
+	{
+		delete m_lockstep;
+		m_lockstep = nullptr;
+	}
+
+	// Receive thread is joined, so the packet pools can be freed without the lock
+	for (int index = 0; index < (int) m_receiveQueue.size(); ++index)
+	{
+		delete m_receiveQueue[index].packet;
+	}
+	m_receiveQueue.clear();
+
+	for (int index = 0; index < (int) m_freeReceivePackets.size(); ++index)
+	{
+		delete m_freeReceivePackets[index];
+	}
+	m_freeReceivePackets.clear();
+
+	for (int index = 0; index < (int) m_outgoingPackets.size(); ++index)
+	{
+		delete m_outgoingPackets[index];
+	}
+	m_outgoingPackets.clear();
 }
 
 
@@ -140,13 +193,26 @@ void NetSession::Join(const std::string& myName, NetConnectionInfo_t& hostInfo)
 //
 void NetSession::ShutdownSession()
 {
-	// Join the receiving thread
+	// Join the receiving thread - the net thread gives up waiting on the state lock once this is cleared
 	m_isReceiving = false;
 	if (m_receivingThread.joinable())
 	{
 		m_receivingThread.join();
 	}
 
+	// Messages the net thread accepted but the game never got to are dropped with the connections
+	NetDelivery_t delivery;
+	while (m_deliveries.Dequeue(delivery))
+	{
+		delete delivery.message;
+	}
+
+	for (int index = 0; index < (int) m_pendingDeliveries.size(); ++index)
+	{
+		delete m_pendingDeliveries[index].message;
+	}
+	m_pendingDeliveries.clear();
+
 	// Send hang up messages
 	for (int i = 0; i < MAX_CONNECTIONS; ++i)
 	{
@@ -160,6 +226,9 @@ void NetSession::ShutdownSession()
 	// Force a send out to get the hang up received
 	ProcessOutgoing();
 
+	// Nothing left to play with, so don't have the host tell everyone as each connection goes
+	m_lockstep->Stop();
+
 	// Then delete them all
 	for (int i = 0; i < MAX_CONNECTIONS; ++i)
 	{
@@ -184,6 +253,11 @@ void NetSession::ShutdownSession()
 	}
 
 	m_hostConnection = nullptr;
+	m_connectionIndicesByAddress.clear();
+
+	// A replay needs the connections it built up, so it can't outlive them; captures keep going
+	m_isReplaying = false;
+	m_replay.Close();
 	
 	if (m_boundSocket != nullptr)
 	{
@@ -260,6 +334,15 @@ eSessionError NetSession::GetLastError(std::string& out_errorMessage)
 //
 void NetSession::Update()
 {
+	MEMORY_TAG_SCOPE("Net");
+	LockNetState();
+
+	// Feed in the replay's packets that are due, to be processed with the rest
+	UpdateReplay();
+
+	// Run the recording's messages that are due, with no connections involved
+	UpdatePlayback();
+
 	// Processes all received packets in the queue
 	ProcessIncoming();
 
@@ -314,6 +397,8 @@ void NetSession::Update()
 	default:
 		break;
 	}
+
+	UnlockNetState();
 }
 
 
@@ -322,6 +407,8 @@ void NetSession::Update()
 //
 void NetSession::RenderDebugInfo() const
 {
+	LockNetState();
+
 	AABB2 bounds = Renderer::GetUIBounds();
 	Renderer* renderer = Renderer::GetInstance();
 
@@ -361,7 +448,7 @@ void NetSession::RenderDebugInfo() const
 	renderer->DrawTextInBox2D(stateText, bounds, Vector2::ZERO, fontHeight, TEXT_DRAW_OVERRUN, font, Rgba::YELLOW);
 	bounds.Translate(Vector2(0.f, -2.f * fontHeight));
 
-	std::string netTimeText = Stringf("Net time: %.2f", GetCurrentNetTime());
+	std::string netTimeText = Stringf("Net time: %.2f | Rejected packets: %u", GetCurrentNetTime(), m_rejectedPacketCount);
 
 	renderer->DrawTextInBox2D(netTimeText, bounds, Vector2::ZERO, fontHeight, TEXT_DRAW_OVERRUN, font, Rgba::YELLOW);
 	bounds.Translate(Vector2(0.f, -2.f * fontHeight));
@@ -369,8 +456,8 @@ void NetSession::RenderDebugInfo() const
 	renderer->DrawTextInBox2D("Connections:", bounds, Vector2::ZERO, fontHeight, TEXT_DRAW_OVERRUN, font);
 	bounds.Translate(Vector2(0.f, -fontHeight));
 
-	std::string headingText = Stringf("-- %-*s%-*s%-*s%-*s%-*s%-*s%-*s%-*s%-*s%-*s",
-		6, "INDEX", 10, "NAME", 21, "ADDRESS", 8, "RTT(ms)", 7, "LOSS", 7, "LRCV", 7, "LSNT", 8, "SNTACK", 8, "RCVACK", 10, "STATE");
+	std::string headingText = Stringf("-- %-*s%-*s%-*s%-*s%-*s%-*s%-*s%-*s%-*s%-*s%-*s%-*s%-*s%-*s",
+		6, "INDEX", 10, "NAME", 21, "ADDRESS", 8, "RTT(ms)", 7, "LOSS", 7, "FILL", 7, "PKT/S", 8, "KB/S", 7, "SCALE", 7, "LRCV", 7, "LSNT", 8, "SNTACK", 8, "RCVACK", 10, "STATE");
 
 	renderer->DrawTextInBox2D(headingText.c_str(), bounds, Vector2::ZERO, fontHeight, TEXT_DRAW_OVERRUN, font);
 	bounds.Translate(Vector2(0.f, -fontHeight));
@@ -385,6 +472,86 @@ void NetSession::RenderDebugInfo() const
 			bounds.Translate(Vector2(0.f, -fontHeight));
 		}
 	}
+
+	// Traffic by message definition, only the ones with any
+	bounds.Translate(Vector2(0.f, -fontHeight));
+	renderer->DrawTextInBox2D("Messages:", bounds, Vector2::ZERO, fontHeight, TEXT_DRAW_OVERRUN, font);
+	bounds.Translate(Vector2(0.f, -fontHeight));
+
+	std::string messageHeadingText = Stringf("-- %-*s%-*s%-*s%-*s%-*s%-*s%-*s",
+		24, "NAME", 8, "SENT", 10, "SENT(KB)", 8, "RCVD", 10, "RCVD(KB)", 8, "DROPS", 10, "CB(ms)");
+
+	renderer->DrawTextInBox2D(messageHeadingText.c_str(), bounds, Vector2::ZERO, fontHeight, TEXT_DRAW_OVERRUN, font);
+	bounds.Translate(Vector2(0.f, -fontHeight));
+
+	for (int index = 0; index < MAX_MESSAGE_DEFINITIONS; ++index)
+	{
+		const NetMessageStats_t& stats = m_messageStats[index];
+
+		if (m_messageDefinitions[index] == nullptr || (stats.sentCount == 0 && stats.receivedCount == 0 && stats.droppedCount == 0))
+		{
+			continue;
+		}
+
+		double averageCallbackMs = 0.0;
+		if (stats.callbackCount > 0)
+		{
+			averageCallbackMs = 1000.0 * TimeSystem::PerformanceCountToSeconds(stats.callbackHPC) / (double) stats.callbackCount;
+		}
+
+		std::string statsText = Stringf("-- %-*s%-*u%-*.2f%-*u%-*.2f%-*u%-*.3f",
+			24, m_messageDefinitions[index]->name.c_str(), 8, stats.sentCount, 10, (float) stats.sentBytes / 1024.f, 8, stats.receivedCount,
+			10, (float) stats.receivedBytes / 1024.f, 8, stats.droppedCount, 10, averageCallbackMs);
+
+		renderer->DrawTextInBox2D(statsText.c_str(), bounds, Vector2::ZERO, fontHeight, TEXT_DRAW_OVERRUN, font);
+		bounds.Translate(Vector2(0.f, -fontHeight));
+	}
+
+	UnlockNetState();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets whether the receive thread also processes packets and sends, see the header
+//
+void NetSession::SetNetThreadEnabled(bool enabled)
+{
+	ASSERT_OR_DIE(m_state == SESSION_DISCONNECTED, "Error: NetSession::SetNetThreadEnabled() called while the session was running.");
+	m_useNetThread = enabled;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the net thread processes packets and sends for this session
+//
+bool NetSession::IsNetThreadEnabled() const
+{
+	return m_useNetThread;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Locks the connection and net object state against the net thread; recursive, so callbacks and
+// game code called from Update() can lock again
+//
+void NetSession::LockNetState() const
+{
+	if (m_useNetThread)
+	{
+		m_netStateLock.lock();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Releases the lock taken in LockNetState()
+//
+void NetSession::UnlockNetState() const
+{
+	if (m_useNetThread)
+	{
+		m_netStateLock.unlock();
+	}
 }
 
 
@@ -397,10 +564,25 @@ void NetSession::RegisterMessageDefinition(uint8_t messageID, const std::string&
 	if (m_messageDefinitions[messageID] != nullptr)
 	{
 		LogTaggedPrintf("NET", "Warning - NetSession::RegisterMessageDefinition() registered duplicate definition id for \"%s\" and \"%s\"", m_messageDefinitions[messageID]->name.c_str(), name.c_str());
+		m_messageDefinitionIDsByHash.erase(m_messageDefinitions[messageID]->nameHash);
 		delete m_messageDefinitions[messageID];
 	}
 
-	m_messageDefinitions[messageID] = new NetMessageDefinition_t(messageID, name, callback, options, sequenceChannelIndex);
+	NetMessageDefinition_t* definition = new NetMessageDefinition_t(messageID, name, callback, options, sequenceChannelIndex);
+
+	// Names are only ever looked up by hash, so two can't share one
+	std::map<uint32_t, uint8_t>::iterator itr = m_messageDefinitionIDsByHash.find(definition->nameHash);
+	if (itr != m_messageDefinitionIDsByHash.end())
+	{
+		const NetMessageDefinition_t* existing = m_messageDefinitions[itr->second];
+		ASSERT_OR_DIE(existing->name == name, Stringf("Error: NetSession::RegisterMessageDefinition() names \"%s\" and \"%s\" have the same hash", existing->name.c_str(), name.c_str()));
+
+		LogTaggedPrintf("NET", "Warning - NetSession::RegisterMessageDefinition() registered \"%s\" under a second id, lookups by name now return id %i", name.c_str(), messageID);
+	}
+
+	m_messageDefinitions[messageID] = definition;
+	m_messageDefinitionIDsByHash[definition->nameHash] = messageID;
+	m_messageStats[messageID] = NetMessageStats_t();
 }
 
 
@@ -449,6 +631,7 @@ bool NetSession::BindSocket(unsigned short port, uint16_t portRange)
 	{
 		m_boundSocket = newSocket;
 		m_isReceiving = true;
+		m_netThreadStartHPC = GetPerformanceCounter();
 		m_receivingThread = std::thread(&NetSession::ReceiveIncoming, this);
 		LogTaggedPrintf("NET", "NetSession bound to address %s", newSocket->GetNetAddress().ToString().c_str());
 	}
@@ -479,10 +662,83 @@ bool NetSession::SendPacket(const NetPacket* packet)
 
 	size_t amountSent = m_boundSocket->SendTo(address, packet->GetBuffer(), packet->GetWrittenByteCount());
 
+	PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_PACKETS_SENT);
+	PROFILE_COUNTER_ADD(PROFILE_COUNTER_BYTES_SENT, packet->GetWrittenByteCount());
+
 	return amountSent > 0;
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns an empty packet for a connection to fill, which is sent to its receiver connection on the
+// next FlushOutgoingPackets() - the session owns it, and reuses it after the flush
+//
+NetPacket* NetSession::GetOutgoingPacket()
+{
+	if (m_outgoingPacketCount == NET_SEND_BATCH_SIZE)
+	{
+		FlushOutgoingPackets();
+	}
+
+	if (m_outgoingPacketCount == (int) m_outgoingPackets.size())
+	{
+		m_outgoingPackets.push_back(new NetPacket());
+	}
+
+	NetPacket* packet = m_outgoingPackets[m_outgoingPacketCount];
+	m_outgoingPacketCount++;
+
+	packet->Reset();
+	return packet;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sends all packets from GetOutgoingPacket() with one batched socket send
+// Packets for connections destroyed since they were filled are dropped
+//
+void NetSession::FlushOutgoingPackets()
+{
+	UDPDatagram_t datagrams[NET_SEND_BATCH_SIZE];
+	int numDatagrams = 0;
+
+	for (int packetIndex = 0; packetIndex < m_outgoingPacketCount; ++packetIndex)
+	{
+		NetPacket* packet = m_outgoingPackets[packetIndex];
+		uint8_t receiverIndex = packet->GetReceiverConnectionIndex();
+
+		NetConnection* connection = (receiverIndex < MAX_CONNECTIONS ? m_boundConnections[receiverIndex] : nullptr);
+		if (connection == nullptr)
+		{
+			continue;
+		}
+
+		UDPDatagram_t& datagram = datagrams[numDatagrams];
+		datagram.address = connection->GetAddress();
+		datagram.buffer = packet->m_localBuffer;
+		datagram.byteCount = packet->GetWrittenByteCount();
+
+		numDatagrams++;
+	}
+
+	if (numDatagrams > 0 && m_boundSocket != nullptr && !m_isReplaying)
+	{
+		m_boundSocket->SendBatch(datagrams, numDatagrams);
+
+		for (int datagramIndex = 0; datagramIndex < numDatagrams; ++datagramIndex)
+		{
+			m_capture.Record(NET_CAPTURE_UDP_SENT, datagrams[datagramIndex].address, datagrams[datagramIndex].buffer, datagrams[datagramIndex].byteCount);
+			Profiler::RecordMarker("Net Send", (uint32_t) datagrams[datagramIndex].byteCount);
+
+			PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_PACKETS_SENT);
+			PROFILE_COUNTER_ADD(PROFILE_COUNTER_BYTES_SENT, datagrams[datagramIndex].byteCount);
+		}
+	}
+
+	m_outgoingPacketCount = 0;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the definition given by name
 //
@@ -491,6 +747,11 @@ bool NetSession::SendMessageDirect(NetMessage* message, const NetSender_t& sende
 	NetPacket packet;
 	packet.AdvanceWriteHead(PACKET_HEADER_SIZE);
 
+	if (message->IsCompressed() && !message->PackPayload())
+	{
+		return false;
+	}
+
 	packet.WriteMessage(message);
 
 	PacketHeader_t header;
@@ -499,7 +760,20 @@ bool NetSession::SendMessageDirect(NetMessage* message, const NetSender_t& sende
 
 	packet.WriteHeader(header);
 
+	// Replayed senders don't exist, so act as if it went out
+	if (m_isReplaying)
+	{
+		return true;
+	}
+
 	size_t amountSent = m_boundSocket->SendTo(sender.address, packet.GetBuffer(), packet.GetWrittenByteCount());
+	m_capture.Record(NET_CAPTURE_UDP_SENT, sender.address, packet.GetBuffer(), packet.GetWrittenByteCount());
+	Profiler::RecordMarker("Net Send", (uint32_t) packet.GetWrittenByteCount());
+
+	PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_PACKETS_SENT);
+	PROFILE_COUNTER_ADD(PROFILE_COUNTER_BYTES_SENT, packet.GetWrittenByteCount());
+
+	RecordMessageSent(message);
 
 	return (amountSent > 0);
 }
@@ -510,6 +784,16 @@ bool NetSession::SendMessageDirect(NetMessage* message, const NetSender_t& sende
 //
 void NetSession::BroadcastMessage(NetMessage* message)
 {
+	// Packed before the first send, since a connection drops (and deletes) messages that can't be
+	// packed and the copies are made from this one
+	if (message->IsCompressed() && !message->PackPayload())
+	{
+		LogTaggedPrintf("NET", "Error: Dropped broadcast of message %s, it couldn't be packed", message->GetDefinition()->name.c_str());
+		delete message;
+
+		return;
+	}
+
 	bool firstSent = false;
 	for (int i = 0; i < MAX_CONNECTIONS; ++i)
 	{
@@ -527,6 +811,12 @@ void NetSession::BroadcastMessage(NetMessage* message)
 			}
 		}
 	}
+
+	// No one to send it to, so no connection took it
+	if (!firstSent)
+	{
+		delete message;
+	}
 }
 
 
@@ -535,28 +825,40 @@ void NetSession::BroadcastMessage(NetMessage* message)
 //
 const NetMessageDefinition_t* NetSession::GetMessageDefinition(const std::string& name) const
 {
-	for (int index = 0; index < MAX_MESSAGE_DEFINITIONS; ++index)
+	const NetMessageDefinition_t* definition = GetMessageDefinitionByHash(HashStringID(name));
+
+	// An unregistered name could still share a hash with a registered one
+	if (definition == nullptr || definition->name != name)
 	{
-		if (m_messageDefinitions[index] != nullptr && m_messageDefinitions[index]->name == name)
-		{
-			return m_messageDefinitions[index];
-		}
+		ERROR_AND_DIE(Stringf("Error: Message definition \"%s\" doesn't exist", name.c_str()));
 	}
 
-	ERROR_AND_DIE("Message definition doesn't exist");
+	return definition;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Returns the definition at the given index
+// Returns the definition whose name has the given hash, see NET_MESSAGE_HASH()
 //
-const NetMessageDefinition_t* NetSession::GetMessageDefinition(const uint8_t index)
+const NetMessageDefinition_t* NetSession::GetMessageDefinitionByHash(uint32_t nameHash) const
 {
-	if (index >= MAX_MESSAGE_DEFINITIONS)
+	std::map<uint32_t, uint8_t>::const_iterator itr = m_messageDefinitionIDsByHash.find(nameHash);
+
+	if (itr == m_messageDefinitionIDsByHash.end())
 	{
-		ERROR_AND_DIE("Message definition doesn't exist");
+		return nullptr;
 	}
 
+	return m_messageDefinitions[itr->second];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the definition at the given index, nullptr if none is registered there
+// The table has a slot for every uint8_t, so any index is in range
+//
+const NetMessageDefinition_t* NetSession::GetMessageDefinition(const uint8_t index)
+{
 	return m_messageDefinitions[index];
 }
 
@@ -566,13 +868,12 @@ const NetMessageDefinition_t* NetSession::GetMessageDefinition(const uint8_t ind
 //
 bool NetSession::GetMessageDefinitionIndex(const std::string& name, uint8_t& out_index)
 {
-	for (uint8_t index = 0; index < MAX_MESSAGE_DEFINITIONS; ++index)
+	const NetMessageDefinition_t* definition = GetMessageDefinitionByHash(HashStringID(name));
+
+	if (definition != nullptr && definition->name == name)
 	{
-		if (m_messageDefinitions[index]->name == name)
-		{
-			out_index = index;
-			return true;
-		}
+		out_index = definition->id;
+		return true;
 	}
 
 	LogTaggedPrintf("NET", "Error - NetSession::GetMessageDefinition() couldn't find definition for name %s", name.c_str());
@@ -580,6 +881,53 @@ bool NetSession::GetMessageDefinitionIndex(const std::string& name, uint8_t& out
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the traffic stats of the definition with the given ID
+//
+const NetMessageStats_t& NetSession::GetMessageStats(uint8_t definitionID) const
+{
+	return m_messageStats[definitionID];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Zeroes the stats of every definition
+//
+void NetSession::ResetMessageStats()
+{
+	LockNetState();
+
+	for (int index = 0; index < MAX_MESSAGE_DEFINITIONS; ++index)
+	{
+		m_messageStats[index] = NetMessageStats_t();
+	}
+
+	UnlockNetState();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Counts the message as sent, at the size it takes in a packet
+// The net state lock must be held, as it is for flushes
+//
+void NetSession::RecordMessageSent(const NetMessage* message)
+{
+	NetMessageStats_t& stats = m_messageStats[message->GetDefinitionID()];
+
+	stats.sentCount++;
+	stats.sentBytes += sizeof(uint16_t) + message->GetHeaderSize() + message->GetPayloadSize();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Counts the message as dropped, for sends that never made it in a packet or receives that were rejected
+//
+void NetSession::RecordMessageDropped(const NetMessage* message)
+{
+	m_messageStats[message->GetDefinitionID()].droppedCount++;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the NetConnection at the given index, nullptr if out of range
 //
@@ -631,7 +979,7 @@ NetConnection* NetSession::GetHostConnection() const
 //
 bool NetSession::IsConnectionListFull() const
 {
-	for (int i = 0; i < MAX_CONNECTIONS; ++i)
+	for (int i = 0; i < m_maxConnections; ++i)
 	{
 		if (m_boundConnections[i] == nullptr)
 		{
@@ -643,6 +991,31 @@ bool NetSession::IsConnectionListFull() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Sets how many connections this session takes when hosting, clamped to [1, MAX_CONNECTIONS]
+//
+void NetSession::SetMaxConnections(int maxConnections)
+{
+	if (m_state != SESSION_DISCONNECTED)
+	{
+		ConsoleWarningf("NetSession::SetMaxConnections() called while the session was active");
+		LogTaggedPrintf("NET", "NetSession::SetMaxConnections() ignored, the session wasn't disconnected");
+		return;
+	}
+
+	m_maxConnections = ClampInt(maxConnections, 1, MAX_CONNECTIONS);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns how many connections this session takes when hosting
+//
+int NetSession::GetMaxConnections() const
+{
+	return m_maxConnections;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns whether a connection already exists for the given sender
 //
@@ -654,21 +1027,7 @@ bool NetSession::DoesConnectionForAddressExist(const NetSender_t& sender) const
 	}
 
 	// Sender doesn't have an index, but might be connectionless - check for the address
-	for (int i = 0; i < MAX_CONNECTIONS; ++i)
-	{
-		if (m_boundConnections[i] == nullptr)
-		{
-			continue;
-		}
-
-		if (m_boundConnections[i]->GetAddress() == sender.address)
-		{
-			return true;
-		}
-	}
-
-	// Invalid connection index and couldn't find address with port, so it's new
-	return false;
+	return (GetConnectionIndexForAddress(sender.address) != INVALID_CONNECTION_INDEX);
 }
 
 
@@ -695,6 +1054,21 @@ unsigned int NetSession::GetConnectionCount() const
 //
 void NetSession::ProcessIncoming()
 {
+	// The net thread already accepted the messages, so only the callbacks are left
+	if (m_useNetThread)
+	{
+		NetDelivery_t delivery;
+		while (m_deliveries.Dequeue(delivery))
+		{
+			RunMessageCallback(delivery.message, delivery.senderAddress, delivery.connectionIndex);
+			delete delivery.message;
+		}
+
+		return;
+	}
+
+	m_processedPackets.clear();
+
 	bool done = false;
 	while (!done)
 	{
@@ -703,27 +1077,52 @@ void NetSession::ProcessIncoming()
 		
 		if (packetReceived)
 		{
-			if (VerifyPacket(pending.packet))
+			if (VerifyPacket(pending.packet, pending.senderAddress))
 			{
 				ProcessReceivedPacket(pending.packet, pending.senderAddress);
 			}
 			else
 			{
-				LogTaggedPrintf("NET", "Received a bad packet from address %s, message was %i bytes", pending.senderAddress.ToString().c_str(), pending.packet->GetWrittenByteCount());
+				m_rejectedPacketCount++;
 			}
 
-			delete pending.packet;
+			m_processedPackets.push_back(pending.packet);
 		}
 
 		done = !packetReceived;
 	}
+
+	// Hand the packets back to the receive thread all at once
+	if (m_processedPackets.size() > 0)
+	{
+		m_receiveLock.lock();
+		m_freeReceivePackets.insert(m_freeReceivePackets.end(), m_processedPackets.begin(), m_processedPackets.end());
+		m_receiveLock.unlock();
+
+		m_processedPackets.clear();
+	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
 // Send out all pending messages
+// Does nothing while the net thread is running, it sends on its own tick
 //
 void NetSession::ProcessOutgoing()
+{
+	if (m_useNetThread && m_isReceiving)
+	{
+		return;
+	}
+
+	FlushConnections();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sends heartbeats and flushes every connection with something to send, then sends the packets together
+//
+void NetSession::FlushConnections()
 {
 	// Flush each connection
 	for (int index = 0; index < MAX_CONNECTIONS; ++index)
@@ -735,7 +1134,7 @@ void NetSession::ProcessOutgoing()
 			// Check heartbeat
 			if (currConnection != m_myConnection && currConnection->HasHeartbeatElapsed())
 			{
-				const NetMessageDefinition_t* definition = GetMessageDefinition("heartbeat");
+				const NetMessageDefinition_t* definition = GetMessageDefinitionByHash(NET_MESSAGE_HASH("heartbeat"));
 
 				if (definition != nullptr)
 				{
@@ -747,12 +1146,15 @@ void NetSession::ProcessOutgoing()
 			}
 
 			// Check send rate
-			if ((currConnection->HasOutboundMessages() || currConnection->NeedsToForceSend()))
+			if ((currConnection->HasOutboundMessages() || currConnection->NeedsToForceSend()) && currConnection->HasNetTickElapsed())
 			{
 				currConnection->FlushMessages();
 			}
 		}
 	}
+
+	// Send every connection's packet together
+	FlushOutgoingPackets();
 }
 
 
@@ -794,6 +1196,17 @@ void NetSession::SetNetTickRate(float hertz)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Sends once every stepsPerSend steps of the scheduler, so snapshots line up with simulation steps
+// instead of the render rate
+//
+void NetSession::SetNetTickRateFromFixedStep(const FixedStepScheduler& scheduler, int stepsPerSend /*= 1*/)
+{
+	ASSERT_OR_DIE(stepsPerSend > 0, Stringf("Error: NetSession given %i steps per send", stepsPerSend));
+	SetNetTickRate((float) (scheduler.GetStepRate() / (double) stepsPerSend));
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the time to wait between sending messages
 //
@@ -822,21 +1235,259 @@ float NetSession::GetHeartbeatInterval() const
 
 
 //-----------------------------------------------------------------------------------------------
-// Returns the host time that this client last received
+// Sets whether connections adapt their send rate to loss and RTT, or always send at the tick rate
 //
-float NetSession::GetLastHostTime() const
+void NetSession::SetCongestionControlEnabled(bool enabled)
 {
-	return m_lastHostTime;
+	m_congestionControlEnabled = enabled;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Returns the current time of this session
+// Returns whether connections adapt their send rate to loss and RTT
 //
-float NetSession::GetCurrentNetTime() const
+bool NetSession::IsCongestionControlEnabled() const
 {
-	if (IsHosting())
-	{
+	return m_congestionControlEnabled;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts recording all traffic to the file, replacing any capture in progress
+//
+bool NetSession::StartCapture(const std::string& filePath)
+{
+	return m_capture.Open(filePath);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finishes writing the capture in progress, if any
+//
+void NetSession::StopCapture()
+{
+	m_capture.Close();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if traffic is being recorded
+//
+bool NetSession::IsCapturing() const
+{
+	return m_capture.IsOpen();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Loads the capture and starts feeding its received datagrams in, speed times as fast as they came
+// The session must already be bound, by hosting or joining
+//
+bool NetSession::StartReplay(const std::string& filePath, float speed /*= 1.f*/)
+{
+	LockNetState();
+
+	if (m_boundSocket == nullptr || speed <= 0.f)
+	{
+		LogTaggedPrintf("NET", "Error: NetSession::StartReplay() needs a bound session and a positive speed");
+		UnlockNetState();
+		return false;
+	}
+
+	bool opened = m_replay.Open(filePath);
+
+	if (opened)
+	{
+		m_isReplaying = true;
+		m_replaySpeed = speed;
+		m_replayStartTime = GetReceiveClockTime();
+
+		LogTaggedPrintf("NET", "Replaying capture \"%s\" at %.2fx speed", filePath.c_str(), speed);
+	}
+
+	UnlockNetState();
+	return opened;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stops the replay in progress, going back to sending on the wire
+//
+void NetSession::StopReplay()
+{
+	LockNetState();
+
+	if (m_isReplaying)
+	{
+		LogTaggedPrintf("NET", "Replay stopped");
+	}
+
+	m_isReplaying = false;
+	m_replay.Close();
+
+	UnlockNetState();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if a capture is being replayed
+//
+bool NetSession::IsReplaying() const
+{
+	return m_isReplaying;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts recording the marked messages to the file, replacing any recording in progress
+//
+bool NetSession::StartRecording(const std::string& filePath)
+{
+	return m_recording.Open(filePath);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finishes writing the recording in progress, if any
+//
+void NetSession::StopRecording()
+{
+	m_recording.Close();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if messages are being recorded
+//
+bool NetSession::IsRecording() const
+{
+	return m_recording.IsOpen();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets whether messages of the definition are recorded as their callbacks run
+//
+void NetSession::SetMessageRecorded(uint8_t messageID, bool isRecorded)
+{
+	m_recordedMessages[messageID] = isRecorded;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records the message's payload at the current net time, if recording
+//
+void NetSession::RecordMessage(const NetMessage* message)
+{
+	if (!m_recording.IsOpen())
+	{
+		return;
+	}
+
+	m_recording.Record(GetCurrentNetTime(), message->GetDefinition()->nameHash, message->GetBuffer(), message->GetPayloadSize());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Loads the recording and starts running its messages from the net time of the first one
+//
+bool NetSession::StartPlayback(const std::string& filePath, float speed /*= 1.f*/)
+{
+	LockNetState();
+
+	if (m_state != SESSION_DISCONNECTED || speed <= 0.f)
+	{
+		LogTaggedPrintf("NET", "Error: NetSession::StartPlayback() needs a disconnected session and a positive speed");
+		UnlockNetState();
+		return false;
+	}
+
+	bool opened = m_playback.Open(filePath);
+
+	if (opened)
+	{
+		NetRecordingRecord_t record;
+		float startTime = (m_playback.PeekNextRecord(record) ? record.netTime : 0.f);
+
+		m_isPlayingBack = true;
+		m_playbackSpeed = speed;
+		m_currentClientTime = startTime;
+		m_desiredClientTime = startTime;
+		m_lastHostTime = startTime;
+
+		LogTaggedPrintf("NET", "Playing back recording \"%s\" at %.2fx speed", filePath.c_str(), speed);
+	}
+
+	UnlockNetState();
+	return opened;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stops the playback in progress, leaving the objects it created as they are
+//
+void NetSession::StopPlayback()
+{
+	LockNetState();
+
+	if (m_isPlayingBack)
+	{
+		LogTaggedPrintf("NET", "Playback stopped");
+	}
+
+	m_isPlayingBack = false;
+	m_playback.Close();
+
+	UnlockNetState();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if a recording is being played back
+//
+bool NetSession::IsPlayingBack() const
+{
+	return m_isPlayingBack;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets how many times faster than recorded the playback runs, for benchmarks or scrubbing
+//
+void NetSession::SetPlaybackSpeed(float speed)
+{
+	if (speed > 0.f)
+	{
+		m_playbackSpeed = speed;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the playback speed
+//
+float NetSession::GetPlaybackSpeed() const
+{
+	return m_playbackSpeed;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the host time that this client last received
+//
+float NetSession::GetLastHostTime() const
+{
+	return m_lastHostTime;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the current time of this session
+//
+float NetSession::GetCurrentNetTime() const
+{
+	if (IsHosting())
+	{
 		return m_netClock.GetElapsedTime();
 	}
 
@@ -862,6 +1513,15 @@ NetObjectSystem* NetSession::GetNetObjectSystem() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the lockstep state of this session
+//
+NetLockstep* NetSession::GetLockstep() const
+{
+	return m_lockstep;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Creates a connection with the given info and attempts to bind it if valid
 //
@@ -885,6 +1545,7 @@ void NetSession::DestroyConnection(NetConnection* connection)
 {
 	// Remove the connection view from the NetObjectSystem
 	m_netObjectSystem->ClearConnectionViewForIndex(connection->GetSessionIndex());
+	m_lockstep->OnConnectionLeft(connection->GetSessionIndex());
 
 	// Remove the connection from the list if bound connections if bound
 	if (connection->IsConnected())
@@ -892,6 +1553,12 @@ void NetSession::DestroyConnection(NetConnection* connection)
 		uint8_t index = connection->GetSessionIndex();
 		m_boundConnections[index] = nullptr;
 
+		std::map<uint64_t, uint8_t>::iterator itr = m_connectionIndicesByAddress.find(GetAddressKey(connection->GetAddress()));
+		if (itr != m_connectionIndicesByAddress.end() && itr->second == index)
+		{
+			m_connectionIndicesByAddress.erase(itr);
+		}
+
 		// Call the game-side callback
 		m_onLeaveCallback(connection);
 	}
@@ -924,6 +1591,7 @@ void NetSession::BindConnection(uint8_t index, NetConnection* connection)
 	}
 
 	m_boundConnections[index] = connection;
+	m_connectionIndicesByAddress[GetAddressKey(connection->GetAddress())] = index;
 
 	// Update the connection's index stored internally
 	connection->SetSessionIndex(index);
@@ -939,12 +1607,28 @@ void NetSession::BindConnection(uint8_t index, NetConnection* connection)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the index of the bound connection with the given address, or INVALID_CONNECTION_INDEX
+//
+uint8_t NetSession::GetConnectionIndexForAddress(const NetAddress_t& address) const
+{
+	std::map<uint64_t, uint8_t>::const_iterator itr = m_connectionIndicesByAddress.find(GetAddressKey(address));
+
+	if (itr == m_connectionIndicesByAddress.end())
+	{
+		return INVALID_CONNECTION_INDEX;
+	}
+
+	return itr->second;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns an index in th
 //
 uint8_t NetSession::GetFreeConnectionIndex() const
 {
-	for (uint8_t i = 0; i < MAX_CONNECTIONS; ++i)
+	for (uint8_t i = 0; i < m_maxConnections; ++i)
 	{
 		if (m_boundConnections[i] == nullptr)
 		{
@@ -1007,56 +1691,357 @@ void NetSession::RegisterCoreMessages()
 	RegisterMessageDefinition(NET_MSG_HANG_UP, "hang_up", OnHangUp);
 
 	// NetObjectSystem
-	RegisterMessageDefinition(NET_MSG_OBJ_CREATE, "netobj_create", OnNetObjectCreate, NET_MSG_OPTION_IN_ORDER);
+	RegisterMessageDefinition(NET_MSG_OBJ_CREATE, "netobj_create", OnNetObjectCreate, (eNetMessageOption) (NET_MSG_OPTION_IN_ORDER | NET_MSG_OPTION_COMPRESSED));
 	RegisterMessageDefinition(NET_MSG_OBJ_DESTROY, "netobj_destroy", OnNetObjectDestroy, NET_MSG_OPTION_IN_ORDER);
 	RegisterMessageDefinition(NET_MSG_OBJ_UPDATE, "netobj_update", OnNetObjectUpdate);
+
+	// Lockstep
+	RegisterMessageDefinition(NET_MSG_LOCKSTEP_START, "lockstep_start", OnLockstepStart, NET_MSG_OPTION_IN_ORDER, NET_LOCKSTEP_SEQUENCE_CHANNEL);
+	RegisterMessageDefinition(NET_MSG_LOCKSTEP_INPUT, "lockstep_input", OnLockstepInput, NET_MSG_OPTION_IN_ORDER, NET_LOCKSTEP_SEQUENCE_CHANNEL);
+	RegisterMessageDefinition(NET_MSG_LOCKSTEP_CHECKSUM, "lockstep_checksum", OnLockstepChecksum, NET_MSG_OPTION_IN_ORDER, NET_LOCKSTEP_SEQUENCE_CHANNEL);
+	RegisterMessageDefinition(NET_MSG_LOCKSTEP_LEAVE, "lockstep_leave", OnLockstepLeave, NET_MSG_OPTION_IN_ORDER, NET_LOCKSTEP_SEQUENCE_CHANNEL);
 }
 
 
 //-----------------------------------------------------------------------------------------------
 // Receives on the bound sockets, and adds the messages to the queue
-// Runs on a separate thread
+// Runs on a separate thread; sleeps until datagrams arrive, then reads them in batches straight into
+// pooled packets and queues the whole batch under one lock
+// As the net thread it also processes the ready packets, and flushes the connections every net tick
 //
 void NetSession::ReceiveIncoming()
 {
-	while (m_isReceiving)
+	if (m_useNetThread)
+	{
+		Thread::SetThisThreadName("Net");
+		Profiler::RegisterThisThread("Net");
+	}
+
+	MEMORY_TAG_SCOPE("Net");
+
+	float nextSendTime = 0.f;
+
+	NetPacket* packets[NET_RECEIVE_BATCH_SIZE];
+	UDPDatagram_t datagrams[NET_RECEIVE_BATCH_SIZE];
+
+	m_receiveLock.lock();
+	for (int index = 0; index < NET_RECEIVE_BATCH_SIZE; ++index)
 	{
-		NetAddress_t senderAddress;
-		uint8_t buffer[PACKET_MTU];
+		packets[index] = TakeFreeReceivePacket();
+	}
+	m_receiveLock.unlock();
 
-		size_t amountReceived = m_boundSocket->ReceiveFrom(&senderAddress, buffer, PACKET_MTU);
+	while (m_isReceiving)
+	{
+		unsigned int waitMilliseconds = NET_RECEIVE_WAIT_MILLISECONDS;
 
-		if (amountReceived > 0)
+		if (m_useNetThread)
 		{
-			// Check if we should keep the packet, or simulate loss
-			if (!CheckRandomChance(m_lossChance))
+			ProcessReadyReceivesOnNetThread();
+
+			float currentTime = GetReceiveClockTime();
+			if (currentTime >= nextSendTime && TryLockNetStateOnNetThread())
 			{
-				NetPacket* packet = new NetPacket(buffer, PACKET_MTU);
+				FlushConnections();
+				m_netStateLock.unlock();
+
+				nextSendTime = currentTime + m_timeBetweenSends;
+			}
+
+			// Wake up in time for the next send tick
+			float secondsUntilSend = MaxFloat(nextSendTime - GetReceiveClockTime(), 0.f);
+			waitMilliseconds = MinInt((int) (secondsUntilSend * 1000.f), NET_RECEIVE_WAIT_MILLISECONDS);
+		}
+
+		if (!m_boundSocket->WaitForReceive(waitMilliseconds))
+		{
+			continue;
+		}
+
+		for (int index = 0; index < NET_RECEIVE_BATCH_SIZE; ++index)
+		{
+			datagrams[index].buffer = packets[index]->m_localBuffer;
+			datagrams[index].bufferSize = PACKET_MTU;
+		}
+
+		int numReceived = m_boundSocket->ReceiveBatch(datagrams, NET_RECEIVE_BATCH_SIZE);
 
-				packet->AdvanceWriteHead(amountReceived);
+		if (numReceived == 0)
+		{
+			continue;
+		}
+
+		for (int index = 0; index < numReceived; ++index)
+		{
+			m_capture.Record(NET_CAPTURE_UDP_RECEIVED, datagrams[index].address, datagrams[index].buffer, datagrams[index].byteCount);
+			Profiler::RecordMarker("Net Receive", (uint32_t) datagrams[index].byteCount);
+
+			PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_PACKETS_RECEIVED);
+			PROFILE_COUNTER_ADD(PROFILE_COUNTER_BYTES_RECEIVED, datagrams[index].byteCount);
+		}
 
-				PendingReceive pending;
-				pending.packet = packet;
-				pending.senderAddress = senderAddress;
+		float receiveTime = GetReceiveClockTime();
 
-				float latency = m_latencyRange.GetRandomInRange() * 0.001f;
-				pending.timeStamp = Clock::GetMasterClock()->GetTotalSeconds() + latency;
+		m_receiveLock.lock();
 
-				PushNewReceive(pending);
+		for (int index = 0; index < numReceived; ++index)
+		{
+			// Check if we should keep the packet, or simulate loss - lost packets are just read over next time
+			if (CheckRandomChance(m_lossChance))
+			{
+				continue;
 			}
+
+			NetPacket* packet = packets[index];
+			packet->Reset();
+			packet->AdvanceWriteHead(datagrams[index].byteCount);
+
+			PendingReceive pending;
+			pending.packet = packet;
+			pending.senderAddress = datagrams[index].address;
+
+			float latency = m_latencyRange.GetRandomInRange() * 0.001f;
+			pending.timeStamp = receiveTime + latency;
+
+			PushNewReceive(pending);
+
+			packets[index] = TakeFreeReceivePacket();
 		}
+
+		m_receiveLock.unlock();
 	}
 
+	// Keep the unused packets for the next time the session binds
+	m_receiveLock.lock();
+	m_freeReceivePackets.insert(m_freeReceivePackets.end(), packets, packets + NET_RECEIVE_BATCH_SIZE);
+	m_receiveLock.unlock();
+
 	LogTaggedPrintf("NET", "NetSession Receive thread joined");
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Net thread only - verifies and processes every receive whose simulated latency has passed,
+// queueing the accepted messages for the game thread
+//
+void NetSession::ProcessReadyReceivesOnNetThread()
+{
+	// Messages held back last time go first, to keep them in order
+	PushPendingDeliveries();
+
+	if (!TryLockNetStateOnNetThread())
+	{
+		return;
+	}
+
+	m_processedPackets.clear();
+
+	PendingReceive pending;
+	while (GetNextReceive(pending))
+	{
+		if (VerifyPacket(pending.packet, pending.senderAddress))
+		{
+			ProcessReceivedPacket(pending.packet, pending.senderAddress);
+		}
+		else
+		{
+			m_rejectedPacketCount++;
+		}
+
+		m_processedPackets.push_back(pending.packet);
+	}
+
+	m_netStateLock.unlock();
+
+	if (m_processedPackets.size() > 0)
+	{
+		m_receiveLock.lock();
+		m_freeReceivePackets.insert(m_freeReceivePackets.end(), m_processedPackets.begin(), m_processedPackets.end());
+		m_receiveLock.unlock();
+
+		m_processedPackets.clear();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Net thread only - moves the held back deliveries onto the queue until it fills
+//
+void NetSession::PushPendingDeliveries()
+{
+	int numPushed = 0;
+	int numPending = (int) m_pendingDeliveries.size();
+
+	while (numPushed < numPending && m_deliveries.Enqueue(m_pendingDeliveries[numPushed]))
+	{
+		numPushed++;
+	}
+
+	m_pendingDeliveries.erase(m_pendingDeliveries.begin(), m_pendingDeliveries.begin() + numPushed);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Net thread only - takes the state lock, yielding while the game thread has it
+// Returns false if the session shuts down first, as the game thread may be joining this thread
+// while holding the lock
+//
+bool NetSession::TryLockNetStateOnNetThread()
+{
+	while (!m_netStateLock.try_lock())
+	{
+		if (!m_isReceiving)
+		{
+			return false;
+		}
+
+		Thread::YieldThisThread();
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the time used to stamp and release receives
+// The net thread runs between frames, so it uses real time since binding instead of the frame clock
+//
+float NetSession::GetReceiveClockTime() const
+{
+	if (m_useNetThread)
+	{
+		return (float) TimeSystem::PerformanceCountToSeconds(GetPerformanceCounter() - m_netThreadStartHPC);
+	}
+
+	return Clock::GetMasterClock()->GetTotalSeconds();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a packet from the free list, or a new one if it's empty
+// m_receiveLock must be held
+//
+NetPacket* NetSession::TakeFreeReceivePacket()
+{
+	if (m_freeReceivePackets.size() == 0)
+	{
+		return new NetPacket();
+	}
+
+	NetPacket* packet = m_freeReceivePackets.back();
+	m_freeReceivePackets.pop_back();
+
+	return packet;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues the replay's received datagrams that are due by now, as if the socket had just read them,
+// stopping the replay once they run out
+// The net state lock must be held
+//
+void NetSession::UpdateReplay()
+{
+	if (!m_isReplaying)
+	{
+		return;
+	}
+
+	float currentTime = GetReceiveClockTime();
+	float replayTime = (currentTime - m_replayStartTime) * m_replaySpeed;
+
+	NetCaptureRecord_t record;
+
+	m_receiveLock.lock();
+
+	while (m_replay.PeekNextRecord(record) && record.time <= replayTime)
+	{
+		m_replay.GetNextRecord(record);
+
+		if (record.type != NET_CAPTURE_UDP_RECEIVED || record.byteCount > PACKET_MTU)
+		{
+			continue;
+		}
+
+		NetPacket* packet = TakeFreeReceivePacket();
+		packet->Reset();
+
+		memcpy(packet->m_localBuffer, record.data, record.byteCount);
+		packet->AdvanceWriteHead(record.byteCount);
+
+		PendingReceive pending;
+		pending.packet = packet;
+		pending.senderAddress = record.address;
+		pending.timeStamp = currentTime;
+
+		PushNewReceive(pending);
+	}
+
+	bool isFinished = !m_replay.PeekNextRecord(record);
+
+	m_receiveLock.unlock();
+
+	if (isFinished)
+	{
+		LogTaggedPrintf("NET", "Replay finished");
+		StopReplay();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Advances the net time by the frame at the playback speed, runs the recorded messages it passed,
+// then updates the NetObjectSystem as a ready client would, stopping once the recording runs out
+// The net state lock must be held
+//
+void NetSession::UpdatePlayback()
+{
+	if (!m_isPlayingBack)
+	{
+		return;
+	}
+
+	m_currentClientTime += m_netClock.GetDeltaSeconds() * m_playbackSpeed;
+	m_desiredClientTime = m_currentClientTime;
+
+	NetRecordingRecord_t record;
+
+	while (m_playback.PeekNextRecord(record) && record.netTime <= m_currentClientTime)
+	{
+		m_playback.GetNextRecord(record);
+
+		const NetMessageDefinition_t* definition = GetMessageDefinitionByHash(record.nameHash);
+
+		if (definition == nullptr || record.byteCount > MESSAGE_MTU)
+		{
+			continue;
+		}
+
+		NetMessage message;
+		message.SetAsView(definition, record.data, record.byteCount);
+
+		RunMessageCallback(&message, NetAddress_t(), INVALID_CONNECTION_INDEX);
+	}
+
+	if (m_netObjectSystem != nullptr)
+	{
+		m_netObjectSystem->Update();
+	}
+
+	if (!m_playback.PeekNextRecord(record))
+	{
+		LogTaggedPrintf("NET", "Playback finished");
+		StopPlayback();
+	}
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Pushes a new receive in the correct location in the location array
+// m_receiveLock must be held
 //
 void NetSession::PushNewReceive(PendingReceive& pending)
 {
-	m_receiveLock.lock();
 	bool pushed = false;
 	for (unsigned int i = 0; i < (unsigned int) m_receiveQueue.size(); ++i)
 	{
@@ -1072,8 +2057,6 @@ void NetSession::PushNewReceive(PendingReceive& pending)
 	{
 		m_receiveQueue.push_back(pending);
 	}
-
-	m_receiveLock.unlock();
 }
 
 
@@ -1091,7 +2074,7 @@ bool NetSession::GetNextReceive(PendingReceive& out_pending)
 	}
 	
 	// Else check if the first packet is ready to be processed
-	float currTime = Clock::GetMasterClock()->GetTotalSeconds();
+	float currTime = GetReceiveClockTime();
 
 	bool packetReady = false;
 	if (m_receiveQueue[0].timeStamp <= currTime)
@@ -1107,39 +2090,95 @@ bool NetSession::GetNextReceive(PendingReceive& out_pending)
 
 
 //-----------------------------------------------------------------------------------------------
-// Verifies that the packet is of correct format
+// Verifies that the packet is of correct format, before any NetMessage is made from it
+// Checks are cheapest first, and only packets from connections log why they failed, so floods of stray
+// traffic don't flood the log too - rejected packets are counted in the debug info instead
 //
-bool NetSession::VerifyPacket(NetPacket* packet)
+bool NetSession::VerifyPacket(NetPacket* packet, const NetAddress_t& senderAddress)
 {
 	// Enough room for the packet header
 	PacketHeader_t header;
 	if (!packet->ReadHeader(header))
 	{
-		LogTaggedPrintf("NET", "NetSession::VerifyPacket() failed, packet was less than size of header.");
 		return false;
 	}
 
-	// Check the sender connection index, and ensure it is valid
-	// (Index isn't the invalid index but is either out of range or has no connection associated with it)
-	int connIndex = header.senderConnectionIndex;
-	if (connIndex != INVALID_CONNECTION_INDEX && (connIndex >= MAX_CONNECTIONS || m_boundConnections[connIndex] == nullptr))
+	// A packet naming a connection has to come from that connection's address, one that doesn't is
+	// treated as from the connection at its address, if there is one
+	uint8_t connIndex = header.senderConnectionIndex;
+	if (connIndex != INVALID_CONNECTION_INDEX)
 	{
-		return false;
+		if (connIndex >= MAX_CONNECTIONS || m_boundConnections[connIndex] == nullptr || !(m_boundConnections[connIndex]->GetAddress() == senderAddress))
+		{
+			return false;
+		}
 	}
+	else
+	{
+		connIndex = GetConnectionIndexForAddress(senderAddress);
+	}
+
+	bool hasConnection = (connIndex != INVALID_CONNECTION_INDEX);
 
-	// Peek at the header and verify the messages
+	// Peek at each message's size and definition, without reading the payloads
 	uint8_t messageCount = header.totalMessageCount;
+	int connectionlessCount = 0;
 
 	for (int i = 0; i < messageCount; ++i)
 	{
 		uint16_t messageSize;
-		packet->Read(messageSize);
+		if (packet->Read(messageSize) != sizeof(uint16_t))
+		{
+			if (hasConnection)
+			{
+				LogTaggedPrintf("NET", "NetSession::VerifyPacket() failed, packet from %s was cut off in a message size.", senderAddress.ToString().c_str());
+			}
+
+			return false;
+		}
+
+		uint8_t definitionID;
+		if (messageSize < sizeof(uint8_t) || packet->Peek(&definitionID, sizeof(uint8_t)) != sizeof(uint8_t))
+		{
+			if (hasConnection)
+			{
+				LogTaggedPrintf("NET", "NetSession::VerifyPacket() failed, packet from %s had a message with no ID.", senderAddress.ToString().c_str());
+			}
+
+			return false;
+		}
+
+		const NetMessageDefinition_t* definition = m_messageDefinitions[definitionID];
+		if (definition == nullptr)
+		{
+			return false;
+		}
+
+		if (!definition->RequiresConnection())
+		{
+			connectionlessCount++;
+		}
+
+		uint16_t headerSize = definition->GetHeaderSize();
+		if (messageSize < headerSize || messageSize - headerSize > MESSAGE_MTU)
+		{
+			if (hasConnection)
+			{
+				LogTaggedPrintf("NET", "NetSession::VerifyPacket() failed, packet from %s had a \"%s\" message of bad size %u.", senderAddress.ToString().c_str(), definition->name.c_str(), messageSize);
+			}
+
+			return false;
+		}
 
 		bool couldAdvance = packet->AdvanceReadHead(messageSize);
 
 		if (!couldAdvance)
 		{
-			LogTaggedPrintf("NET", "NetSession::VerifyPacket() failed, packet message count and size went over the packet size.");
+			if (hasConnection)
+			{
+				LogTaggedPrintf("NET", "NetSession::VerifyPacket() failed, packet from %s message count and size went over the packet size.", senderAddress.ToString().c_str());
+			}
+
 			return false;
 		}
 	}
@@ -1147,7 +2186,18 @@ bool NetSession::VerifyPacket(NetPacket* packet)
 	// Check for under the limit
 	if (packet->GetRemainingReadableByteCount() > 0)
 	{
-		LogTaggedPrintf("NET", "NetSession::VerifyPacket() failed, packet message count and sizes were under the packet size.");
+		if (hasConnection)
+		{
+			LogTaggedPrintf("NET", "NetSession::VerifyPacket() failed, packet from %s message count and sizes were under the packet size.", senderAddress.ToString().c_str());
+		}
+
+		return false;
+	}
+
+	// Without a connection only connectionless messages are processed, so if there are none (or it's
+	// just acks) nothing in it would be
+	if (!hasConnection && connectionlessCount == 0)
+	{
 		return false;
 	}
 	
@@ -1165,9 +2215,17 @@ void NetSession::ProcessReceivedPacket(NetPacket* packet, const NetAddress_t& se
 	// Get the messages out
 	PacketHeader_t header;
 	packet->ReadHeader(header);
-	packet->SetSenderConnectionIndex(header.senderConnectionIndex);
 
-	NetConnection* connection = GetConnection(header.senderConnectionIndex);
+	// Senders that don't know their index yet are still found by address
+	uint8_t connectionIndex = header.senderConnectionIndex;
+	if (connectionIndex == INVALID_CONNECTION_INDEX)
+	{
+		connectionIndex = GetConnectionIndexForAddress(senderAddress);
+	}
+
+	packet->SetSenderConnectionIndex(connectionIndex);
+
+	NetConnection* connection = GetConnection(connectionIndex);
 
 	// Update the connection's acknowledgment data if there is one
 	if (connection != nullptr)
@@ -1180,8 +2238,20 @@ void NetSession::ProcessReceivedPacket(NetPacket* packet, const NetAddress_t& se
 
 	for (int i = 0; i < messageCount; ++i)
 	{
+		// Views into the packet, only valid for the callback; queuing it or handing it to the game
+		// thread copies it
 		NetMessage message;
-		packet->ReadMessage(&message, this); // Need to pass the session to look up the definition
+		size_t readableBefore = packet->GetRemainingReadableByteCount();
+
+		if (!packet->ReadMessage(&message, this)) // Need to pass the session to look up the definition
+		{
+			LogTaggedPrintf("NET", "Received a malformed message from address %s, dropping the rest of the packet", senderAddress.ToString().c_str());
+			break;
+		}
+
+		NetMessageStats_t& stats = m_messageStats[message.GetDefinitionID()];
+		stats.receivedCount++;
+		stats.receivedBytes += readableBefore - packet->GetRemainingReadableByteCount();
 
 		ConsolePrintf("Received message: %s", message.GetDefinition()->name.c_str());
 
@@ -1191,7 +2261,7 @@ void NetSession::ProcessReceivedPacket(NetPacket* packet, const NetAddress_t& se
 		if (shouldProcess)
 		{
 			// Process
-			ProcessReceivedMessage(&message, senderAddress, header.senderConnectionIndex);
+			ProcessReceivedMessage(&message, senderAddress, connectionIndex);
 
 			// In order - check all messages in sequence after it
 			if (message.IsInOrder())
@@ -1204,7 +2274,7 @@ void NetSession::ProcessReceivedPacket(NetPacket* packet, const NetAddress_t& se
 
 				while (nextMessage != nullptr)
 				{
-					ProcessReceivedMessage(nextMessage, senderAddress, header.senderConnectionIndex);
+					ProcessReceivedMessage(nextMessage, senderAddress, connectionIndex);
 				
 					delete nextMessage;
 					nextMessage = channel->GetNextMessageToProcess();
@@ -1225,12 +2295,14 @@ bool NetSession::ShouldMessageBeProcessed(NetMessage* message, NetConnection* co
 	if (message->RequiresConnection() && !connectionExists)
 	{
 		LogTaggedPrintf("NET", "Received message \"%s\" from a connectionless client that requires a connection", message->GetName().c_str());
+		RecordMessageDropped(message);
 		return false;
 	}
 
 	// Double process check
 	if (message->IsReliable() && connection->HasReliableIDAlreadyBeenReceived(message->GetReliableID()))
 	{
+		RecordMessageDropped(message);
 		return false;
 	}
 
@@ -1239,6 +2311,7 @@ bool NetSession::ShouldMessageBeProcessed(NetMessage* message, NetConnection* co
 	if (message->IsInOrder() && channel == nullptr)
 	{
 		LogTaggedPrintf("NET", "ProcessIncoming received in-order message with a bad sequence channel ID, ID was %i", message->GetSequenceChannelID());
+		RecordMessageDropped(message);
 		return false;
 	}
 
@@ -1259,18 +2332,16 @@ bool NetSession::ShouldMessageBeProcessed(NetMessage* message, NetConnection* co
 
 //-----------------------------------------------------------------------------------------------
 // Processes the message
+// On the net thread the message is marked processed right away, and moved to the game thread for its callback
 //
 void NetSession::ProcessReceivedMessage(NetMessage* message, const NetAddress_t& address, uint8_t connectionIndex)
 {
-	NetSender_t sender;
-	sender.address = address;
-	sender.netSession = this;
-	sender.connectionIndex = connectionIndex;
-
-	const NetMessageDefinition_t* definition = message->GetDefinition();
-	definition->callback(message, sender);
+	if (!m_useNetThread)
+	{
+		RunMessageCallback(message, address, connectionIndex);
+	}
 
-	NetConnection* connection = GetConnection(sender.connectionIndex);
+	NetConnection* connection = GetConnection(connectionIndex);
 	if (message->IsReliable() && connection != nullptr)
 	{
 		connection->AddProcessedReliableID(message->GetReliableID());
@@ -1286,6 +2357,52 @@ void NetSession::ProcessReceivedMessage(NetMessage* message, const NetAddress_t&
 			channel->IncrementNextExpectedID();
 		}
 	}
+
+	if (m_useNetThread)
+	{
+		NetDelivery_t delivery;
+		delivery.message = new NetMessage();
+		*delivery.message = std::move(*message);
+		delivery.senderAddress = address;
+		delivery.connectionIndex = connectionIndex;
+
+		// Hold it back if the game thread has fallen behind, rather than lose it after it was acked
+		if (m_pendingDeliveries.size() > 0 || !m_deliveries.Enqueue(delivery))
+		{
+			m_pendingDeliveries.push_back(delivery);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Calls the message's definition callback
+//
+void NetSession::RunMessageCallback(NetMessage* message, const NetAddress_t& address, uint8_t connectionIndex)
+{
+	NetSender_t sender;
+	sender.address = address;
+	sender.netSession = this;
+	sender.connectionIndex = connectionIndex;
+
+	const NetMessageDefinition_t* definition = message->GetDefinition();
+
+	// Recorded before the callback reads it, so the whole payload is there
+	if (m_recordedMessages[definition->id] && !m_isPlayingBack)
+	{
+		RecordMessage(message);
+	}
+
+	Profiler::PushMeasurement(definition->name.c_str());
+	uint64_t startHPC = GetPerformanceCounter();
+
+	definition->callback(message, sender);
+
+	NetMessageStats_t& stats = m_messageStats[definition->id];
+	stats.callbackCount++;
+	stats.callbackHPC += GetPerformanceCounter() - startHPC;
+
+	Profiler::PopMeasurement();
 }
 
 
@@ -1743,23 +2860,5 @@ bool OnNetObjectDestroy(NetMessage* msg, const NetSender_t& sender)
 bool OnNetObjectUpdate(NetMessage* msg, const NetSender_t& sender)
 {
 	NetObjectSystem* netObjSystem = sender.netSession->GetNetObjectSystem();
-
-	uint16_t networkID = 0xffff;
-
-	if (!msg->Read(networkID))
-	{
-		ERROR_AND_DIE("Error: OnNetObjectCreate() couldn't read the network ID");
-	}
-
-	NetObject* netObject = netObjSystem->GetNetObjectForNetworkID(networkID);
-
-	if (netObject == nullptr)
-	{
-		return false;
-	}
-
-	const NetObjectType_t* type = netObject->GetNetObjectType();
-	type->readSnapshot(*msg, netObject->GetLastReceivedSnapshot());
-
-	return true;
+	return netObjSystem->ReadSnapshotUpdateMessage(msg);
 }
\ No newline at end of file
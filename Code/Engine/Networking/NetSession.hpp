@@ -6,13 +6,21 @@
 /************************************************************************/
 #include "Engine/Math/FloatRange.hpp"
 #include "Engine/Core/Time/Stopwatch.hpp"
+#include "Engine/Core/Utility/StringID.hpp"
 #include "Engine/Networking/NetAddress.hpp"
 #include "Engine/Networking/NetMessage.hpp"
+#include "Engine/Networking/NetCapture.hpp"
+#include "Engine/Networking/NetRecording.hpp"
 #include "Engine/DataStructures/ThreadSafeVector.hpp"
+#include "Engine/DataStructures/SPSCQueue.hpp"
+#include <map>
 #include <vector>
 #include <string>
 #include <mutex>
+#include <thread>
+#include <atomic>
 #include <functional>
+#include <type_traits>
 
 class UDPSocket;
 class NetPacket;
@@ -21,15 +29,33 @@ class BytePacker;
 class NetConnection;
 class NetSession;
 class NetObjectSystem;
+class NetLockstep;
+class FixedStepScheduler;
 
 #define INVALID_CONNECTION_INDEX (0xff)
-#define MAX_CONNECTIONS (32)
+
+// Connection indices are a uint8_t on the wire, with 0xff meaning none, so a build can raise this as
+// far as 254; each session can be capped below it with SetMaxConnections()
+#ifndef MAX_CONNECTIONS
+#define MAX_CONNECTIONS (64)
+#endif
+
+static_assert(MAX_CONNECTIONS > 0 && MAX_CONNECTIONS < INVALID_CONNECTION_INDEX, "MAX_CONNECTIONS must fit in a uint8_t connection index");
+
 #define MAX_MESSAGE_DEFINITIONS (256)
 #define DEFAULT_PORT_RANGE (10)
 #define JOIN_TIMEOUT (10)
 #define CONNECTION_LAST_RECEIVED_TIMEOUT (10)
 #define NET_MAX_TIME_DILATION (0.1f)
 
+// Datagrams read per socket call on the receive thread, and packets gathered per socket send
+#define NET_RECEIVE_BATCH_SIZE (32)
+#define NET_SEND_BATCH_SIZE (32)
+#define NET_RECEIVE_WAIT_MILLISECONDS (10)		// Longest the receive thread sleeps before checking for shutdown
+
+// Messages the net thread can have decoded ahead of the game thread before it holds them back
+#define NET_DELIVERY_QUEUE_SIZE (1024)
+
 struct NetSender_t
 {
 	NetAddress_t	address;
@@ -59,6 +85,12 @@ enum eNetCoreMessage : uint8_t
 	NET_MSG_OBJ_DESTROY,		// reliable, in-order
 	NET_MSG_OBJ_UPDATE,			// unreliable
 
+	// For lockstep, all on its own sequence channel
+	NET_MSG_LOCKSTEP_START,		// reliable, in-order
+	NET_MSG_LOCKSTEP_INPUT,		// reliable, in-order
+	NET_MSG_LOCKSTEP_CHECKSUM,	// reliable, in-order
+	NET_MSG_LOCKSTEP_LEAVE,		// reliable, in-order
+
 	NET_MSG_CORE_COUNT
 };
 
@@ -68,16 +100,33 @@ enum eNetMessageOption : uint32_t
 	NET_MSG_OPTION_CONNECTIONLESS = (1 << 0),
 	NET_MSG_OPTION_RELIABLE = (1 << 1),
 	NET_MSG_OPTION_IN_ORDER = (1 << 2) | NET_MSG_OPTION_RELIABLE, // All in-order traffic is reliable!
+	NET_MSG_OPTION_COMPRESSED = (1 << 3), // Payloads of at least NET_COMPRESSION_THRESHOLD bytes are compressed, costs 2 bytes on all others
+};
+
+// The StringID of a message name, worked out at compile time for a literal, for looking definitions
+// up with GetMessageDefinitionByHash() instead of comparing strings
+#define NET_MESSAGE_HASH(name) SID(name)
+
+// Traffic of one message definition since the session was made, or the stats were last reset
+struct NetMessageStats_t
+{
+	unsigned int	sentCount = 0;			// Resends included, as they cost bandwidth all the same
+	uint64_t		sentBytes = 0;			// As written to packets, with headers and after compression
+	unsigned int	receivedCount = 0;
+	uint64_t		receivedBytes = 0;
+	unsigned int	droppedCount = 0;		// Unreliables that didn't fit their packet, and received ones that were rejected
+	unsigned int	callbackCount = 0;
+	uint64_t		callbackHPC = 0;		// Total time spent in the callback
 };
 
-// Callback for the NetSession messages
+// Callback for the NetSession messages - the message may view a packet buffer, so it must be copied to be kept
 typedef bool(*NetMessage_cb)(NetMessage* msg, const NetSender_t& sender);
 typedef void(*NetSessionConnectionEvent_cb)(void* args);
 
 struct NetMessageDefinition_t
 {
 	NetMessageDefinition_t(uint8_t _id, const std::string& _name, NetMessage_cb _callback, eNetMessageOption _options, uint8_t _sequenceChannelIndex = 0)
-		: id(_id), name(_name), callback(_callback), options(_options), sequenceChannelIndex(_sequenceChannelIndex) {}
+		: id(_id), name(_name), nameHash(InternStringID(_name)), callback(_callback), options(_options), sequenceChannelIndex(_sequenceChannelIndex) {}
 
 	bool IsReliable() const
 	{
@@ -89,8 +138,37 @@ struct NetMessageDefinition_t
 		return (options & NET_MSG_OPTION_IN_ORDER) == NET_MSG_OPTION_IN_ORDER;
 	}
 
+	bool IsCompressed() const
+	{
+		return (options & NET_MSG_OPTION_COMPRESSED) == NET_MSG_OPTION_COMPRESSED;
+	}
+
+	bool RequiresConnection() const
+	{
+		return (options & NET_MSG_OPTION_CONNECTIONLESS) != NET_MSG_OPTION_CONNECTIONLESS;
+	}
+
+	// ID, then the reliable ID, then the sequence ID and channel
+	uint16_t GetHeaderSize() const
+	{
+		uint16_t size = sizeof(uint8_t);
+
+		if (IsReliable())
+		{
+			size += sizeof(uint16_t);
+
+			if (IsInOrder())
+			{
+				size += (sizeof(uint16_t) + sizeof(uint8_t));
+			}
+		}
+
+		return size;
+	}
+
 	uint8_t				id;
 	std::string			name = "";
+	StringID			nameHash = 0;
 	NetMessage_cb		callback = nullptr;
 	eNetMessageOption	options;
 	uint8_t				sequenceChannelIndex;
@@ -103,6 +181,14 @@ struct PendingReceive
 	NetAddress_t	senderAddress;
 };
 
+// A message the net thread decoded and accepted, for the game thread to run the callback of
+struct NetDelivery_t
+{
+	NetMessage*		message = nullptr;
+	NetAddress_t	senderAddress;
+	uint8_t			connectionIndex = INVALID_CONNECTION_INDEX;
+};
+
 // Host/Join
 struct NetConnectionInfo_t
 {
@@ -156,8 +242,21 @@ public:
 
 	void							RenderDebugInfo() const;
 
+	// Net thread - when enabled, the receive thread also verifies packets, processes acks and decodes
+	// messages, and flushes sends at the net tick rate; the game thread only runs message callbacks
+	// Can only be changed while disconnected
+	void							SetNetThreadEnabled(bool enabled);
+	bool							IsNetThreadEnabled() const;
+
+	// Held by the net thread while it touches connections, and by Update(); game code touching
+	// connections or net objects outside of Update() while the net thread runs must hold it too
+	void							LockNetState() const;
+	void							UnlockNetState() const;
+
 	// Sending
 	bool							SendPacket(const NetPacket* packet);
+	NetPacket*						GetOutgoingPacket();
+	void							FlushOutgoingPackets();
 	bool							SendMessageDirect(NetMessage* message, const NetSender_t& sender);
 	void							BroadcastMessage(NetMessage* message);
 
@@ -165,8 +264,15 @@ public:
 	void							RegisterMessageDefinition(uint8_t messageID, const std::string& name, NetMessage_cb callback, eNetMessageOption options = NET_MSG_OPTION_NONE, uint8_t sequenceChannelIndex = 0);
 	const NetMessageDefinition_t*	GetMessageDefinition(const std::string& name) const;
 	const NetMessageDefinition_t*	GetMessageDefinition(const uint8_t index);
+	const NetMessageDefinition_t*	GetMessageDefinitionByHash(uint32_t nameHash) const;	// Returns nullptr if none is registered
 	bool							GetMessageDefinitionIndex(const std::string& name, uint8_t& out_index);
 
+	// Message stats, by definition ID
+	const NetMessageStats_t&		GetMessageStats(uint8_t definitionID) const;
+	void							ResetMessageStats();
+	void							RecordMessageSent(const NetMessage* message);		// For connections as they write to packets
+	void							RecordMessageDropped(const NetMessage* message);
+
 	// Connections
 	NetConnection*					GetConnection(uint8_t connectionIndex) const;
 	uint8_t							GetLocalConnectionIndex() const;
@@ -174,6 +280,11 @@ public:
 	NetConnection*					GetMyConnection() const;
 	NetConnection*					GetHostConnection() const;
 	bool							IsConnectionListFull() const;
+
+	// Limits how many connections a host takes, up to MAX_CONNECTIONS - for running several smaller
+	// sessions in one process, each on its own port; only changeable while disconnected
+	void							SetMaxConnections(int maxConnections);
+	int								GetMaxConnections() const;
 	bool							DoesConnectionForAddressExist(const NetSender_t& sender) const;
 	unsigned int					GetConnectionCount() const;
 
@@ -188,12 +299,47 @@ public:
 
 	// Network tick
 	void							SetNetTickRate(float hertz);
+	void							SetNetTickRateFromFixedStep(const FixedStepScheduler& scheduler, int stepsPerSend = 1);
 	float							GetTimeBetweenSends() const;
 
 	// Heartbeat
 	void							SetConnectionHeartbeatInterval(float hertz);
 	float							GetHeartbeatInterval() const;
 
+	// Congestion control - connections back their send rate and snapshot budget off as loss and RTT rise
+	void							SetCongestionControlEnabled(bool enabled);
+	bool							IsCongestionControlEnabled() const;
+
+	// Capture - records every datagram sent and received, before simulated loss and latency
+	bool							StartCapture(const std::string& filePath);
+	void							StopCapture();
+	bool							IsCapturing() const;
+
+	// Replay - the received datagrams of a capture are fed back in as if they just arrived, at speed times
+	// the rate they were captured at; nothing is put on the wire until it ends, so a bound session can be
+	// driven headless, like a host benchmarked under recorded load
+	bool							StartReplay(const std::string& filePath, float speed = 1.f);
+	void							StopReplay();
+	bool							IsReplaying() const;
+
+	// Recording - the payloads of messages as their callbacks run, stamped with net time; NetObject creates,
+	// destroys and updates by default, plus any game messages marked; made on a client, started before it joins
+	// so the recording has the creates of objects that were already there
+	bool							StartRecording(const std::string& filePath);
+	void							StopRecording();
+	bool							IsRecording() const;
+	void							SetMessageRecorded(uint8_t messageID, bool isRecorded);
+	void							RecordMessage(const NetMessage* message);	// For game events that aren't received, before they're sent
+
+	// Playback - runs a recording's messages through their callbacks as the net time passes them, speed times
+	// as fast as they were recorded, so the NetObjectSystem plays a match back with no server; the session
+	// must be disconnected, and the same message definitions and NetObject types registered
+	bool							StartPlayback(const std::string& filePath, float speed = 1.f);
+	void							StopPlayback();
+	bool							IsPlayingBack() const;
+	void							SetPlaybackSpeed(float speed);
+	float							GetPlaybackSpeed() const;
+
 	// Net Clock
 	float							GetLastHostTime() const;
 	float							GetCurrentNetTime() const;
@@ -202,6 +348,9 @@ public:
 	// NetObject System
 	NetObjectSystem*				GetNetObjectSystem() const;
 
+	// Lockstep - the alternative to NetObjects, for simulations too big to replicate; only inputs are sent
+	NetLockstep*					GetLockstep() const;
+
 
 private:
 	//-----Private Methods-----
@@ -213,19 +362,29 @@ private:
 	void							DestroyConnection(NetConnection* connection);
 	void							BindConnection(uint8_t index, NetConnection* connection);
 	uint8_t							GetFreeConnectionIndex() const;
+	uint8_t							GetConnectionIndexForAddress(const NetAddress_t& address) const;
 	void							CheckForDisconnects();
 
 	void							RegisterCoreMessages();
 
 	void							ReceiveIncoming();
-
+	void							ProcessReadyReceivesOnNetThread();
+	void							PushPendingDeliveries();
+	bool							TryLockNetStateOnNetThread();
+	float							GetReceiveClockTime() const;
+	void							FlushConnections();
+
+	void							UpdateReplay();
+	void							UpdatePlayback();
 	void							PushNewReceive(PendingReceive& pending);
 	bool							GetNextReceive(PendingReceive& out_pending);
+	NetPacket*						TakeFreeReceivePacket();
 
-	bool							VerifyPacket(NetPacket* packet);
+	bool							VerifyPacket(NetPacket* packet, const NetAddress_t& senderAddress);
 	void							ProcessReceivedPacket(NetPacket* packet, const NetAddress_t& senderAddress);
 	bool							ShouldMessageBeProcessed(NetMessage* message, NetConnection* connection);
 	void							ProcessReceivedMessage(NetMessage* message, const NetAddress_t& address, uint8_t connectionIndex);
+	void							RunMessageCallback(NetMessage* message, const NetAddress_t& address, uint8_t connectionIndex);
 
 	void							UpdateClientTime();
 
@@ -259,9 +418,13 @@ private:
 	NetConnection* m_myConnection = nullptr;
 	NetConnection* m_hostConnection = nullptr;
 
-	UDPSocket*									m_boundSocket;
+	UDPSocket*									m_boundSocket = nullptr;
 	NetConnection*								m_boundConnections[MAX_CONNECTIONS];
+	std::map<uint64_t, uint8_t>					m_connectionIndicesByAddress;	// Bound connections, by GetAddressKey()
+	unsigned int								m_rejectedPacketCount = 0;
 	const NetMessageDefinition_t*				m_messageDefinitions[MAX_MESSAGE_DEFINITIONS];
+	std::map<uint32_t, uint8_t>					m_messageDefinitionIDsByHash;
+	NetMessageStats_t							m_messageStats[MAX_MESSAGE_DEFINITIONS];
 
 	Stopwatch									m_joinTimer;
 	Stopwatch									m_stateTimer;
@@ -274,7 +437,34 @@ private:
 	std::thread									m_receivingThread;
 	std::mutex									m_receiveLock;
 	std::vector<PendingReceive>					m_receiveQueue;
-	bool m_isReceiving = false;
+	std::vector<NetPacket*>						m_freeReceivePackets;		// Processed packets for the receive thread to reuse, guarded by m_receiveLock
+	std::vector<NetPacket*>						m_processedPackets;			// Returned to the free list once per ProcessIncoming()
+	std::atomic<bool>							m_isReceiving{ false };
+
+	// Net thread
+	bool										m_useNetThread = false;
+	uint64_t									m_netThreadStartHPC = 0;
+	mutable std::recursive_mutex				m_netStateLock;
+	SPSCQueue<NetDelivery_t>					m_deliveries;				// Net thread to game thread, in the order they were accepted
+	std::vector<NetDelivery_t>					m_pendingDeliveries;		// Net thread only, accepted while the queue was full
+
+	// Sending - packets are filled by the connections and sent together once they've all flushed
+	std::vector<NetPacket*>						m_outgoingPackets;			// Pool, only the first m_outgoingPacketCount are in use
+	int											m_outgoingPacketCount = 0;
+
+	// Capture/replay
+	NetCaptureWriter							m_capture;
+	NetCaptureReader							m_replay;
+	bool										m_isReplaying = false;
+	float										m_replaySpeed = 1.f;
+	float										m_replayStartTime = 0.f;
+
+	// Recording/playback
+	NetRecordingWriter							m_recording;
+	bool										m_recordedMessages[MAX_MESSAGE_DEFINITIONS];
+	NetRecordingReader							m_playback;
+	bool										m_isPlayingBack = false;
+	float										m_playbackSpeed = 1.f;
 
 	// Network tick in seconds
 	float										m_timeBetweenSends = 0.f;
@@ -282,6 +472,9 @@ private:
 	// Heartbeat in seconds
 	float										m_heartBeatInverval = 1.f;
 
+	bool										m_congestionControlEnabled = true;
+	int											m_maxConnections = MAX_CONNECTIONS;
+
 	// Net clock
 	float										m_lastHostTime = 0.f;
 	float										m_desiredClientTime = 0.f;
@@ -290,4 +483,5 @@ private:
 
 	// NetObjectSystem
 	NetObjectSystem*							m_netObjectSystem = nullptr;
+	NetLockstep*								m_lockstep = nullptr;
 };
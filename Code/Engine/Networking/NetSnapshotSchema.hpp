@@ -0,0 +1,341 @@
+/************************************************************************/
+/* File: NetSnapshotSchema.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Compile-time field descriptions of a NetObject type's
+/*				snapshot, generating its copy, packing, interpolation
+/*				and per-field delta callbacks
+/************************************************************************/
+#pragma once
+#include <math.h>
+#include <tuple>
+#include <string.h>
+#include <stdint.h>
+#include <utility>
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/Vector3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Quaternion.hpp"
+#include "Engine/Networking/BytePacker.hpp"
+#include "Engine/Networking/NetMessage.hpp"
+#include "Engine/Networking/NetObjectType.hpp"
+
+// Largest packed size of one field, for comparing fields as they'd be written
+#define NET_SNAPSHOT_FIELD_MAX_BYTES (16)
+
+//-----------------------------------------------------------------------------------------------
+// Encodings - how one field is packed; each writes and reads bits only, so a snapshot is one bit stream
+// Quantized values re-quantize to the same bits once read, which the per-field deltas rely on
+//-----------------------------------------------------------------------------------------------
+
+// A float clamped to [minValue, maxValue] in bitCount bits
+struct NetQuantizedFloat_t
+{
+	constexpr NetQuantizedFloat_t(float minValue, float maxValue, int bitCount)
+		: m_minValue(minValue), m_maxValue(maxValue), m_bitCount(bitCount) {}
+
+	bool Write(BytePacker& packer, float value) const	{ return packer.WriteQuantizedFloat(value, m_minValue, m_maxValue, m_bitCount); }
+	bool Read(BytePacker& packer, float& out_value) const	{ return packer.ReadQuantizedFloat(out_value, m_minValue, m_maxValue, m_bitCount); }
+	void Interpolate(float& out_value, float from, float to, float t) const { out_value = ::Interpolate(from, to, t); }
+
+	float	m_minValue;
+	float	m_maxValue;
+	int		m_bitCount;
+};
+
+// Degrees wrapped into [0, 360) in bitCount bits, blended down the shorter arc
+struct NetQuantizedAngle_t
+{
+	constexpr NetQuantizedAngle_t(int bitCount)
+		: m_bitCount(bitCount) {}
+
+	bool Write(BytePacker& packer, float degrees) const
+	{
+		float wrapped = fmodf(degrees, 360.f);
+		wrapped = (wrapped < 0.f ? wrapped + 360.f : wrapped);
+
+		// One step short of 360, so 360 itself isn't a second encoding of 0
+		float maxDegrees = 360.f - 360.f / (float) (1u << m_bitCount);
+		return packer.WriteQuantizedFloat(wrapped, 0.f, maxDegrees, m_bitCount);
+	}
+
+	bool Read(BytePacker& packer, float& out_degrees) const
+	{
+		float maxDegrees = 360.f - 360.f / (float) (1u << m_bitCount);
+		return packer.ReadQuantizedFloat(out_degrees, 0.f, maxDegrees, m_bitCount);
+	}
+
+	void Interpolate(float& out_degrees, float from, float to, float t) const { out_degrees = from + GetAngularDisplacement(from, to) * t; }
+
+	int		m_bitCount;
+};
+
+// Each component clamped to [minValue, maxValue] in bitCount bits
+struct NetQuantizedVector3_t
+{
+	constexpr NetQuantizedVector3_t(float minValue, float maxValue, int bitCount)
+		: m_minValue(minValue), m_maxValue(maxValue), m_bitCount(bitCount) {}
+
+	bool Write(BytePacker& packer, const Vector3& value) const
+	{
+		return (packer.WriteQuantizedFloat(value.x, m_minValue, m_maxValue, m_bitCount)
+			&& packer.WriteQuantizedFloat(value.y, m_minValue, m_maxValue, m_bitCount)
+			&& packer.WriteQuantizedFloat(value.z, m_minValue, m_maxValue, m_bitCount));
+	}
+
+	bool Read(BytePacker& packer, Vector3& out_value) const
+	{
+		return (packer.ReadQuantizedFloat(out_value.x, m_minValue, m_maxValue, m_bitCount)
+			&& packer.ReadQuantizedFloat(out_value.y, m_minValue, m_maxValue, m_bitCount)
+			&& packer.ReadQuantizedFloat(out_value.z, m_minValue, m_maxValue, m_bitCount));
+	}
+
+	void Interpolate(Vector3& out_value, const Vector3& from, const Vector3& to, float t) const { out_value = ::Interpolate(from, to, t); }
+
+	float	m_minValue;
+	float	m_maxValue;
+	int		m_bitCount;
+};
+
+// A normalized rotation as its smallest three components
+struct NetQuantizedQuaternion_t
+{
+	constexpr NetQuantizedQuaternion_t(int bitsPerComponent = 10)
+		: m_bitsPerComponent(bitsPerComponent) {}
+
+	bool Write(BytePacker& packer, const Quaternion& value) const	{ return packer.WriteQuaternion(value, m_bitsPerComponent); }
+	bool Read(BytePacker& packer, Quaternion& out_value) const		{ return packer.ReadQuaternion(out_value, m_bitsPerComponent); }
+	void Interpolate(Quaternion& out_value, const Quaternion& from, const Quaternion& to, float t) const { out_value = Quaternion::Slerp(from, to, t); }
+
+	int		m_bitsPerComponent;
+};
+
+// An unsigned int in as few bits as its value needs; steps instead of blending, like counts and states
+struct NetVariableUInt_t
+{
+	constexpr NetVariableUInt_t() {}
+
+	bool Write(BytePacker& packer, uint32_t value) const		{ return packer.WriteVariableBitUInt(value); }
+	bool Read(BytePacker& packer, uint32_t& out_value) const	{ return packer.ReadVariableBitUInt(out_value); }
+	void Interpolate(uint32_t& out_value, uint32_t from, uint32_t to, float t) const { UNUSED(to); UNUSED(t); out_value = from; }
+};
+
+// One bit; steps instead of blending
+struct NetBool_t
+{
+	constexpr NetBool_t() {}
+
+	bool Write(BytePacker& packer, bool value) const		{ return packer.WriteBit(value); }
+	bool Read(BytePacker& packer, bool& out_value) const	{ return packer.ReadBit(out_value); }
+	void Interpolate(bool& out_value, bool from, bool to, float t) const { UNUSED(to); UNUSED(t); out_value = from; }
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// A replicated field - the member it's copied from on the owner, the snapshot member it's kept in,
+// and the member it's applied to on the others (usually the same one)
+//
+template <typename OBJECT, typename SNAPSHOT, typename T, typename ENCODING>
+struct NetSnapshotField_t
+{
+	T OBJECT::*		objectMember;
+	T SNAPSHOT::*	snapshotMember;
+	ENCODING		encoding;
+};
+
+template <typename OBJECT, typename SNAPSHOT, typename T, typename ENCODING>
+constexpr NetSnapshotField_t<OBJECT, SNAPSHOT, T, ENCODING> MakeNetSnapshotField(T OBJECT::* objectMember, T SNAPSHOT::* snapshotMember, const ENCODING& encoding)
+{
+	return NetSnapshotField_t<OBJECT, SNAPSHOT, T, ENCODING>{ objectMember, snapshotMember, encoding };
+}
+
+//-----------------------------------------------------------------------------------------------
+// Calls func on each field of the tuple, in order
+//
+template <typename FIELDS, typename FUNC, size_t... INDICES>
+void ForEachNetSnapshotField(const FIELDS& fields, FUNC&& func, std::index_sequence<INDICES...>)
+{
+	int expand[] = { 0, (func(std::get<INDICES>(fields), INDICES), 0)... };
+	UNUSED(expand);
+}
+
+template <typename FIELDS, typename FUNC>
+void ForEachNetSnapshotField(const FIELDS& fields, FUNC&& func)
+{
+	ForEachNetSnapshotField(fields, func, std::make_index_sequence<std::tuple_size<FIELDS>::value>());
+}
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the two values would be written the same, so a delta doesn't need to send the field
+//
+template <typename ENCODING, typename T>
+bool IsNetSnapshotFieldSameOnWire(const ENCODING& encoding, const T& first, const T& second)
+{
+	uint8_t firstBytes[NET_SNAPSHOT_FIELD_MAX_BYTES];
+	uint8_t secondBytes[NET_SNAPSHOT_FIELD_MAX_BYTES];
+
+	BytePacker firstPacker(NET_SNAPSHOT_FIELD_MAX_BYTES, firstBytes, false);
+	BytePacker secondPacker(NET_SNAPSHOT_FIELD_MAX_BYTES, secondBytes, false);
+
+	encoding.Write(firstPacker, first);
+	encoding.Write(secondPacker, second);
+	firstPacker.FlushBits();
+	secondPacker.FlushBits();
+
+	size_t byteCount = firstPacker.GetWrittenByteCount();
+	return (byteCount == secondPacker.GetWrittenByteCount() && memcmp(firstBytes, secondBytes, byteCount) == 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Generates a type's snapshot callbacks from a schema, a struct declaring:
+//
+//	typedef <game object> Object;
+//	typedef <snapshot struct> Snapshot;
+//	static constexpr auto Fields() { return std::make_tuple(MakeNetSnapshotField(&Object::position, &Snapshot::position, NetQuantizedVector3_t(-200.f, 200.f, 20)), ...); }
+//
+// Snapshot must be trivially copyable; members not in the schema are left as they are
+// The field list is a constant, so each callback compiles down to the field accesses and bit writes
+//
+template <typename SCHEMA>
+class NetSnapshotSchema
+{
+public:
+	//-----Public Methods-----
+
+	typedef typename SCHEMA::Object		Object;
+	typedef typename SCHEMA::Snapshot	Snapshot;
+
+	static_assert(std::tuple_size<decltype(SCHEMA::Fields())>::value > 0, "NetSnapshotSchema needs at least one field");
+
+	NetSnapshotSchema() = delete;
+
+	// Sets the snapshot size and callbacks, including the field deltas; creates, destroys and priority are left to the type
+	static void FillType(NetObjectType_t& type)
+	{
+		type.snapshotSize = sizeof(Snapshot);
+		type.makeSnapshot = MakeSnapshot;
+		type.writeSnapshot = WriteSnapshot;
+		type.readSnapshot = ReadSnapshot;
+		type.applySnapshot = ApplySnapshot;
+		type.interpolateSnapshot = InterpolateSnapshot;
+		type.writeSnapshotDelta = WriteSnapshotDelta;
+		type.readSnapshotDelta = ReadSnapshotDelta;
+	}
+
+	static constexpr size_t GetFieldCount() { return std::tuple_size<decltype(SCHEMA::Fields())>::value; }
+
+
+	//-----Generated Callbacks-----
+
+	static void MakeSnapshot(void* snapshot, const void* object)
+	{
+		Snapshot* typedSnapshot = (Snapshot*) snapshot;
+		const Object* typedObject = (const Object*) object;
+
+		ForEachNetSnapshotField(SCHEMA::Fields(), [&](const auto& field, size_t)
+		{
+			typedSnapshot->*field.snapshotMember = typedObject->*field.objectMember;
+		});
+	}
+
+	static void ApplySnapshot(void* snapshot, void* object)
+	{
+		const Snapshot* typedSnapshot = (const Snapshot*) snapshot;
+		Object* typedObject = (Object*) object;
+
+		ForEachNetSnapshotField(SCHEMA::Fields(), [&](const auto& field, size_t)
+		{
+			typedObject->*field.objectMember = typedSnapshot->*field.snapshotMember;
+		});
+	}
+
+	static void WriteSnapshot(NetMessage& msg, const void* snapshot)
+	{
+		const Snapshot* typedSnapshot = (const Snapshot*) snapshot;
+
+		ForEachNetSnapshotField(SCHEMA::Fields(), [&](const auto& field, size_t)
+		{
+			field.encoding.Write(msg, typedSnapshot->*field.snapshotMember);
+		});
+
+		msg.FlushBits();
+	}
+
+	static void ReadSnapshot(NetMessage& msg, void* out_snapshot)
+	{
+		Snapshot* typedSnapshot = (Snapshot*) out_snapshot;
+
+		ForEachNetSnapshotField(SCHEMA::Fields(), [&](const auto& field, size_t)
+		{
+			field.encoding.Read(msg, typedSnapshot->*field.snapshotMember);
+		});
+
+		msg.EndBitRead();
+	}
+
+	static void InterpolateSnapshot(void* out_snapshot, const void* from, const void* to, float t)
+	{
+		Snapshot* typedSnapshot = (Snapshot*) out_snapshot;
+		const Snapshot* fromSnapshot = (const Snapshot*) from;
+		const Snapshot* toSnapshot = (const Snapshot*) to;
+
+		memcpy(typedSnapshot, fromSnapshot, sizeof(Snapshot));
+
+		ForEachNetSnapshotField(SCHEMA::Fields(), [&](const auto& field, size_t)
+		{
+			field.encoding.Interpolate(typedSnapshot->*field.snapshotMember, fromSnapshot->*field.snapshotMember, toSnapshot->*field.snapshotMember, t);
+		});
+	}
+
+	// A bit per field for whether it changed from the baseline, then only the fields that did
+	static void WriteSnapshotDelta(NetMessage& msg, const void* snapshot, const void* baseline)
+	{
+		const Snapshot* typedSnapshot = (const Snapshot*) snapshot;
+		const Snapshot* baselineSnapshot = (const Snapshot*) baseline;
+
+		bool changed[GetFieldCount()];
+		ForEachNetSnapshotField(SCHEMA::Fields(), [&](const auto& field, size_t fieldIndex)
+		{
+			changed[fieldIndex] = !IsNetSnapshotFieldSameOnWire(field.encoding, typedSnapshot->*field.snapshotMember, baselineSnapshot->*field.snapshotMember);
+			msg.WriteBit(changed[fieldIndex]);
+		});
+
+		ForEachNetSnapshotField(SCHEMA::Fields(), [&](const auto& field, size_t fieldIndex)
+		{
+			if (changed[fieldIndex])
+			{
+				field.encoding.Write(msg, typedSnapshot->*field.snapshotMember);
+			}
+		});
+
+		msg.FlushBits();
+	}
+
+	// Fields that didn't change are taken from the baseline; returns false if the message ran out
+	static bool ReadSnapshotDelta(NetMessage& msg, const void* baseline, void* out_snapshot)
+	{
+		Snapshot* typedSnapshot = (Snapshot*) out_snapshot;
+		memcpy(typedSnapshot, baseline, sizeof(Snapshot));
+
+		bool succeeded = true;
+		bool changed[GetFieldCount()];
+
+		for (size_t fieldIndex = 0; fieldIndex < GetFieldCount(); ++fieldIndex)
+		{
+			succeeded = succeeded && msg.ReadBit(changed[fieldIndex]);
+		}
+
+		ForEachNetSnapshotField(SCHEMA::Fields(), [&](const auto& field, size_t fieldIndex)
+		{
+			if (succeeded && changed[fieldIndex])
+			{
+				succeeded = field.encoding.Read(msg, typedSnapshot->*field.snapshotMember);
+			}
+		});
+
+		msg.EndBitRead();
+		return succeeded;
+	}
+
+};
@@ -0,0 +1,573 @@
+/************************************************************************/
+/* File: NetSoakTest.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the NetSoakTest class
+/************************************************************************/
+#include "Engine/Networking/NetSoakTest.hpp"
+#include "Engine/Networking/NetSession.hpp"
+#include "Engine/Networking/NetMessage.hpp"
+#include "Engine/Networking/NetConnection.hpp"
+#include "Engine/Networking/NetObjectSystem.hpp"
+#include "Engine/Networking/NetSnapshotSchema.hpp"
+#include "Engine/Core/Time/Time.hpp"
+#include "Engine/Core/Time/Clock.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/Threading/Threading.hpp"
+#include "Engine/Core/DeveloperConsole/Command.hpp"
+#include "Engine/Core/DeveloperConsole/DevConsole.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <algorithm>
+#include <atomic>
+
+// Allocations can only be counted through the debug CRT
+#if defined(_MSC_VER) && defined(_DEBUG)
+#include <crtdbg.h>
+#define NET_SOAK_COUNT_ALLOCATIONS
+#endif
+
+#define NET_SOAK_OBJECT_TYPE_ID (0)				// The sessions are the test's own, so nothing else registers types on them
+#define NET_SOAK_SETTLE_TIME (1.f)				// Creates go out before measuring starts, so only steady state is measured
+#define NET_SOAK_AREA_SIZE (200.f)
+
+// The synthetic game object, circling its center
+struct NetSoakObject_t
+{
+	Vector3	position;
+	float	heading = 0.f;
+
+	Vector3	center;
+	float	radius = 0.f;
+	float	degreesPerSecond = 0.f;
+	float	startAngle = 0.f;
+};
+
+struct NetSoakSnapshot_t
+{
+	Vector3	position;
+	float	heading = 0.f;
+};
+
+// Replicated at about the precision a game would
+struct NetSoakSnapshotSchema_t
+{
+	typedef NetSoakObject_t		Object;
+	typedef NetSoakSnapshot_t	Snapshot;
+
+	static constexpr auto Fields()
+	{
+		return std::make_tuple(
+			MakeNetSnapshotField(&NetSoakObject_t::position, &NetSoakSnapshot_t::position, NetQuantizedVector3_t(-NET_SOAK_AREA_SIZE, NET_SOAK_AREA_SIZE, 20)),
+			MakeNetSnapshotField(&NetSoakObject_t::heading, &NetSoakSnapshot_t::heading, NetQuantizedFloat_t(0.f, 360.f, 12)));
+	}
+};
+
+// Objects made on the clients by creates, freed when the test ends if no destroy came for them
+static std::vector<NetSoakObject_t*> s_clientObjects;
+
+#ifdef NET_SOAK_COUNT_ALLOCATIONS
+static std::atomic<uint64_t> s_allocationCount(0);
+#endif
+
+void Command_NetSoak(Command& cmd);
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Writes where the object starts
+//
+void WriteSoakCreate(NetMessage& msg, void* object)
+{
+	NetSoakObject_t* soakObject = (NetSoakObject_t*) object;
+
+	msg.Write(soakObject->position);
+	msg.Write(soakObject->heading);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Makes the client's copy of the object
+//
+void* ReadSoakCreate(NetMessage& msg)
+{
+	NetSoakObject_t* soakObject = new NetSoakObject_t();
+
+	msg.Read(soakObject->position);
+	msg.Read(soakObject->heading);
+
+	s_clientObjects.push_back(soakObject);
+	return soakObject;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Nothing to write, the object is deleted as is
+//
+void WriteSoakDestroy(NetMessage& msg, void* object)
+{
+	UNUSED(msg);
+	UNUSED(object);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Deletes the client's copy of the object
+//
+void ReadSoakDestroy(NetMessage* msg, void* object)
+{
+	UNUSED(msg);
+
+	std::vector<NetSoakObject_t*>::iterator itr = std::find(s_clientObjects.begin(), s_clientObjects.end(), (NetSoakObject_t*) object);
+	if (itr != s_clientObjects.end())
+	{
+		s_clientObjects.erase(itr);
+	}
+
+	delete (NetSoakObject_t*) object;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Registers the synthetic object type on the session
+//
+void RegisterSoakObjectType(NetSession* session)
+{
+	NetObjectType_t type;
+	type.id = NET_SOAK_OBJECT_TYPE_ID;
+
+	type.writeCreate = WriteSoakCreate;
+	type.readCreate = ReadSoakCreate;
+	type.writeDestroy = WriteSoakDestroy;
+	type.readDestroy = ReadSoakDestroy;
+
+	NetSnapshotSchema<NetSoakSnapshotSchema_t>::FillType(type);
+
+	session->GetNetObjectSystem()->RegisterNetObjectType(type);
+}
+
+
+#ifdef NET_SOAK_COUNT_ALLOCATIONS
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Debug CRT hook, counts every allocation on every thread while the measurement runs
+//
+int CountSoakAllocation(int allocType, void* userData, size_t size, int blockType, long requestNumber, const unsigned char* fileName, int lineNumber)
+{
+	UNUSED(userData);
+	UNUSED(size);
+	UNUSED(blockType);
+	UNUSED(requestNumber);
+	UNUSED(fileName);
+	UNUSED(lineNumber);
+
+	if (allocType == _HOOK_ALLOC || allocType == _HOOK_REALLOC)
+	{
+		s_allocationCount++;
+	}
+
+	return TRUE;
+}
+#endif
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the percentile of the sorted values, nearest rank
+//
+float GetSortedPercentile(const std::vector<float>& sortedValues, float percentile)
+{
+	if (sortedValues.size() == 0)
+	{
+		return 0.f;
+	}
+
+	int index = (int) (percentile * (float) sortedValues.size());
+	index = ClampInt(index, 0, (int) sortedValues.size() - 1);
+
+	return sortedValues[index];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - the client count is capped so every client has a connection slot
+//
+NetSoakTest::NetSoakTest(const NetSoakTestConfig_t& config)
+	: m_config(config)
+{
+	m_config.clientCount = ClampInt(m_config.clientCount, 1, MAX_CONNECTIONS - 1);
+	m_config.objectsPerClient = MaxInt(m_config.objectsPerClient, 0);
+	m_config.tickRate = MaxFloat(m_config.tickRate, 1.f);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+NetSoakTest::~NetSoakTest()
+{
+	ShutdownSessions();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Joins the clients, syncs the objects, lets the creates settle and then measures for the duration
+//
+bool NetSoakTest::Run(NetSoakTestResults_t& out_results)
+{
+	out_results = NetSoakTestResults_t();
+
+	if (!StartSessions())
+	{
+		ShutdownSessions();
+		return false;
+	}
+
+	bool allJoined = WaitForClientsToJoin();
+	out_results.clientsJoined = GetJoinedClientCount();
+
+	if (!allJoined)
+	{
+		LogTaggedPrintf("NET", "Error: NetSoakTest::Run() only %i of %i clients joined", out_results.clientsJoined, m_config.clientCount);
+
+		ShutdownSessions();
+		return false;
+	}
+
+	// Everyone's in, so each client hears about every object through the usual creates
+	int objectCount = m_config.clientCount * m_config.objectsPerClient;
+	for (int objectIndex = 0; objectIndex < objectCount; ++objectIndex)
+	{
+		NetSoakObject_t* soakObject = new NetSoakObject_t();
+		soakObject->center = Vector3(GetRandomFloatInRange(-0.5f, 0.5f) * NET_SOAK_AREA_SIZE, 0.f, GetRandomFloatInRange(-0.5f, 0.5f) * NET_SOAK_AREA_SIZE);
+		soakObject->radius = GetRandomFloatInRange(1.f, 20.f);
+		soakObject->degreesPerSecond = GetRandomFloatInRange(-90.f, 90.f);
+		soakObject->startAngle = GetRandomFloatInRange(0.f, 360.f);
+
+		m_hostObjects.push_back(soakObject);
+	}
+
+	MoveObjects(0.f);
+	for (int objectIndex = 0; objectIndex < objectCount; ++objectIndex)
+	{
+		m_host->GetNetObjectSystem()->SyncObject(NET_SOAK_OBJECT_TYPE_ID, m_hostObjects[objectIndex]);
+	}
+
+	uint64_t tickHPC = TimeSystem::SecondsToPerformanceCount(1.0 / (double) m_config.tickRate);
+	uint64_t startHPC = GetPerformanceCounter();
+	uint64_t nextTickHPC = startHPC;
+
+	while (TimeSystem::PerformanceCountToSeconds(GetPerformanceCounter() - startHPC) < NET_SOAK_SETTLE_TIME)
+	{
+		Tick((float) TimeSystem::PerformanceCountToSeconds(GetPerformanceCounter() - startHPC));
+
+		nextTickHPC += tickHPC;
+		SleepUntil(nextTickHPC);
+	}
+
+	// Measure
+	m_hostTickTimes.clear();
+	m_hostTickTimes.reserve((size_t) (m_config.duration * m_config.tickRate) + 1);
+
+	double hostToClientBytes = 0.0;
+	double clientToHostBytes = 0.0;
+
+#ifdef NET_SOAK_COUNT_ALLOCATIONS
+	s_allocationCount = 0;
+	_CRT_ALLOC_HOOK oldHook = _CrtSetAllocHook(CountSoakAllocation);
+#endif
+
+	uint64_t measureStartHPC = GetPerformanceCounter();
+	nextTickHPC = measureStartHPC;
+
+	while (TimeSystem::PerformanceCountToSeconds(GetPerformanceCounter() - measureStartHPC) < m_config.duration)
+	{
+		float time = (float) TimeSystem::PerformanceCountToSeconds(GetPerformanceCounter() - startHPC);
+
+		float hostTickMs = Tick(time);
+		if (m_hostTickTimes.size() < m_hostTickTimes.capacity())
+		{
+			m_hostTickTimes.push_back(hostTickMs);
+		}
+
+		// Send rates, as each side's connections measure them
+		for (int clientIndex = 0; clientIndex < (int) m_clients.size(); ++clientIndex)
+		{
+			NetConnection* hostConnection = m_clients[clientIndex]->GetHostConnection();
+			NetConnection* clientConnection = m_host->GetConnection(m_clients[clientIndex]->GetLocalConnectionIndex());
+
+			if (hostConnection != nullptr)
+			{
+				clientToHostBytes += hostConnection->GetBytesPerSecond();
+			}
+
+			if (clientConnection != nullptr)
+			{
+				hostToClientBytes += clientConnection->GetBytesPerSecond();
+			}
+		}
+
+		out_results.tickCount++;
+
+		nextTickHPC += tickHPC;
+		SleepUntil(nextTickHPC);
+	}
+
+#ifdef NET_SOAK_COUNT_ALLOCATIONS
+	_CrtSetAllocHook(oldHook);
+	out_results.allocationsPerTick = (float) s_allocationCount / (float) MaxInt(out_results.tickCount, 1);
+#endif
+
+	out_results.clientsJoined = GetJoinedClientCount();
+
+	std::sort(m_hostTickTimes.begin(), m_hostTickTimes.end());
+	out_results.hostTickMsP50 = GetSortedPercentile(m_hostTickTimes, 0.5f);
+	out_results.hostTickMsP90 = GetSortedPercentile(m_hostTickTimes, 0.9f);
+	out_results.hostTickMsP99 = GetSortedPercentile(m_hostTickTimes, 0.99f);
+	out_results.hostTickMsMax = (m_hostTickTimes.size() > 0 ? m_hostTickTimes.back() : 0.f);
+
+	double sampleCount = (double) MaxInt(out_results.tickCount * (int) m_clients.size(), 1);
+	out_results.hostToClientBytesPerSecond = (float) (hostToClientBytes / sampleCount);
+	out_results.clientToHostBytesPerSecond = (float) (clientToHostBytes / sampleCount);
+
+	ShutdownSessions();
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Registers the net_soak command
+//
+void NetSoakTest::InitializeConsoleCommands()
+{
+	Command::Register("net_soak", "Benchmarks a host against synthetic clients. Params: c=clients, o=objects per client, d=duration, t=tick rate, p=port, thread=use net thread", Command_NetSoak);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Hosts, and starts every client joining over the host's address
+//
+bool NetSoakTest::StartSessions()
+{
+	m_host = new NetSession();
+	m_host->SetNetThreadEnabled(m_config.useNetThread);
+	m_host->SetMaxConnections(m_config.clientCount + 1);
+	RegisterSoakObjectType(m_host);
+
+	m_host->Host("soak_host", m_config.port);
+
+	NetConnection* hostConnection = m_host->GetMyConnection();
+	if (!m_host->IsHosting() || hostConnection == nullptr)
+	{
+		LogTaggedPrintf("NET", "Error: NetSoakTest::StartSessions() couldn't host on port %u", m_config.port);
+		return false;
+	}
+
+	for (int clientIndex = 0; clientIndex < m_config.clientCount; ++clientIndex)
+	{
+		NetSession* client = new NetSession();
+		client->SetNetThreadEnabled(m_config.useNetThread);
+		RegisterSoakObjectType(client);
+
+		NetConnectionInfo_t hostInfo;
+		hostInfo.address = hostConnection->GetAddress();
+		hostInfo.name = "soak_host";
+		hostInfo.sessionIndex = 0;
+
+		client->Join(Stringf("soak_client_%i", clientIndex), hostInfo);
+		m_clients.push_back(client);
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Disconnects and deletes every session, and the objects made for them
+//
+void NetSoakTest::ShutdownSessions()
+{
+	for (int clientIndex = 0; clientIndex < (int) m_clients.size(); ++clientIndex)
+	{
+		delete m_clients[clientIndex];
+	}
+
+	m_clients.clear();
+
+	if (m_host != nullptr)
+	{
+		delete m_host;
+		m_host = nullptr;
+	}
+
+	for (int objectIndex = 0; objectIndex < (int) m_hostObjects.size(); ++objectIndex)
+	{
+		delete m_hostObjects[objectIndex];
+	}
+
+	m_hostObjects.clear();
+
+	for (int objectIndex = 0; objectIndex < (int) s_clientObjects.size(); ++objectIndex)
+	{
+		delete s_clientObjects[objectIndex];
+	}
+
+	s_clientObjects.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Ticks everything until every client is in, or the join would have timed out
+//
+bool NetSoakTest::WaitForClientsToJoin()
+{
+	uint64_t tickHPC = TimeSystem::SecondsToPerformanceCount(1.0 / (double) m_config.tickRate);
+	uint64_t startHPC = GetPerformanceCounter();
+	uint64_t nextTickHPC = startHPC;
+
+	while (GetJoinedClientCount() < (int) m_clients.size())
+	{
+		float time = (float) TimeSystem::PerformanceCountToSeconds(GetPerformanceCounter() - startHPC);
+		if (time > (float) JOIN_TIMEOUT + 1.f)
+		{
+			return false;
+		}
+
+		Tick(time);
+
+		nextTickHPC += tickHPC;
+		SleepUntil(nextTickHPC);
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Steps the master clock, moves the objects and updates every session like a frame would
+//
+float NetSoakTest::Tick(float time)
+{
+	Clock::GetMasterClock()->BeginFrame();
+	MoveObjects(time);
+
+	uint64_t hostStartHPC = GetPerformanceCounter();
+
+	m_host->Update();
+	m_host->ProcessOutgoing();
+
+	uint64_t hostEndHPC = GetPerformanceCounter();
+
+	for (int clientIndex = 0; clientIndex < (int) m_clients.size(); ++clientIndex)
+	{
+		m_clients[clientIndex]->Update();
+		m_clients[clientIndex]->ProcessOutgoing();
+	}
+
+	return (float) (1000.0 * TimeSystem::PerformanceCountToSeconds(hostEndHPC - hostStartHPC));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sleeps most of the way to the tick, then spins the rest, as sleeps are only ms accurate
+//
+void NetSoakTest::SleepUntil(uint64_t hpc) const
+{
+	uint64_t currentHPC = GetPerformanceCounter();
+
+	while (currentHPC < hpc)
+	{
+		double secondsLeft = TimeSystem::PerformanceCountToSeconds(hpc - currentHPC);
+		if (secondsLeft > 0.002)
+		{
+			Thread::SleepThisThreadFor(1);
+		}
+		else
+		{
+			Thread::YieldThisThread();
+		}
+
+		currentHPC = GetPerformanceCounter();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Puts every host object where it is on its circle at the time
+//
+void NetSoakTest::MoveObjects(float time)
+{
+	for (int objectIndex = 0; objectIndex < (int) m_hostObjects.size(); ++objectIndex)
+	{
+		NetSoakObject_t* soakObject = m_hostObjects[objectIndex];
+
+		float angle = soakObject->startAngle + soakObject->degreesPerSecond * time;
+		soakObject->position = soakObject->center + soakObject->radius * Vector3(CosDegrees(angle), 0.f, SinDegrees(angle));
+		soakObject->heading = GetAngleBetweenZeroThreeSixty(angle + (soakObject->degreesPerSecond >= 0.f ? 90.f : -90.f));
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of clients whose join has finished
+//
+int NetSoakTest::GetJoinedClientCount() const
+{
+	int joinedCount = 0;
+
+	for (int clientIndex = 0; clientIndex < (int) m_clients.size(); ++clientIndex)
+	{
+		NetConnection* myConnection = m_clients[clientIndex]->GetMyConnection();
+
+		if (myConnection != nullptr && myConnection->IsReady())
+		{
+			joinedCount++;
+		}
+	}
+
+	return joinedCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// CONSOLE COMMANDS
+//-----------------------------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------------------------
+// Runs a soak test with the given params, printing and logging the results
+//
+void Command_NetSoak(Command& cmd)
+{
+	NetSoakTestConfig_t config;
+
+	int port = config.port;
+	cmd.GetParam("c", config.clientCount, &config.clientCount);
+	cmd.GetParam("o", config.objectsPerClient, &config.objectsPerClient);
+	cmd.GetParam("d", config.duration, &config.duration);
+	cmd.GetParam("t", config.tickRate, &config.tickRate);
+	cmd.GetParam("p", port, &port);
+	cmd.GetParam("thread", config.useNetThread, &config.useNetThread);
+	config.port = (uint16_t) port;
+
+	ConsolePrintf("Running net soak test, %i clients with %i objects each for %.1f seconds...", config.clientCount, config.objectsPerClient, config.duration);
+
+	NetSoakTest soakTest(config);
+	NetSoakTestResults_t results;
+
+	if (!soakTest.Run(results))
+	{
+		ConsoleErrorf("Net soak test failed, %i clients joined", results.clientsJoined);
+		return;
+	}
+
+	std::string tickText = Stringf("Host tick (ms) - p50: %.3f | p90: %.3f | p99: %.3f | max: %.3f, over %i ticks",
+		results.hostTickMsP50, results.hostTickMsP90, results.hostTickMsP99, results.hostTickMsMax, results.tickCount);
+
+	std::string bandwidthText = Stringf("Per client (KB/s) - host to client: %.2f | client to host: %.2f",
+		results.hostToClientBytesPerSecond / 1024.f, results.clientToHostBytesPerSecond / 1024.f);
+
+	std::string allocationText = (results.allocationsPerTick >= 0.f ? Stringf("Allocations per tick: %.2f", results.allocationsPerTick) : "Allocations per tick: not counted in this build");
+
+	ConsolePrintf(Rgba::GREEN, "%s", tickText.c_str());
+	ConsolePrintf(Rgba::GREEN, "%s", bandwidthText.c_str());
+	ConsolePrintf(Rgba::GREEN, "%s", allocationText.c_str());
+
+	LogTaggedPrintf("NET", "Net soak test, %i clients, %i objects each: %s; %s; %s", results.clientsJoined, config.objectsPerClient, tickText.c_str(), bandwidthText.c_str(), allocationText.c_str());
+}
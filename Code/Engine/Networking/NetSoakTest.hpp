@@ -0,0 +1,87 @@
+/************************************************************************/
+/* File: NetSoakTest.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Headless benchmark of a host NetSession under load from
+/*				synthetic clients in the same process, over loopback
+/************************************************************************/
+#pragma once
+#include <vector>
+#include <stdint.h>
+
+class NetSession;
+struct NetSoakObject_t;
+
+struct NetSoakTestConfig_t
+{
+	int			clientCount = 8;
+	int			objectsPerClient = 16;		// Synced by the host, so the host replicates clientCount * this
+	float		duration = 10.f;			// Seconds measured, after every client has joined
+	float		tickRate = 60.f;			// Host and client ticks per second
+	uint16_t	port = 30500;
+	bool		useNetThread = false;
+};
+
+struct NetSoakTestResults_t
+{
+	int			clientsJoined = 0;
+	int			tickCount = 0;
+
+	// Host NetSession::Update() time
+	float		hostTickMsP50 = 0.f;
+	float		hostTickMsP90 = 0.f;
+	float		hostTickMsP99 = 0.f;
+	float		hostTickMsMax = 0.f;
+
+	// Averaged over the clients and the ticks measured
+	float		hostToClientBytesPerSecond = 0.f;
+	float		clientToHostBytesPerSecond = 0.f;
+
+	// Allocations across the process per tick, through the debug CRT's hook; -1 in builds without it
+	float		allocationsPerTick = -1.f;
+};
+
+
+class NetSoakTest
+{
+public:
+	//-----Public Methods-----
+
+	NetSoakTest(const NetSoakTestConfig_t& config);
+	~NetSoakTest();
+
+	NetSoakTest(const NetSoakTest& copy) = delete;
+	NetSoakTest& operator=(const NetSoakTest& copy) = delete;
+
+	// Blocks for the join plus the duration, stepping the master clock itself, so the rest of the
+	// game doesn't update while it runs; returns false if not every client could join
+	bool	Run(NetSoakTestResults_t& out_results);
+
+	static void InitializeConsoleCommands();
+
+
+private:
+	//-----Private Methods-----
+
+	bool	StartSessions();
+	void	ShutdownSessions();
+	bool	WaitForClientsToJoin();
+
+	float	Tick(float time);		// Returns the host's update time, in ms
+	void	SleepUntil(uint64_t hpc) const;
+	void	MoveObjects(float time);
+	int		GetJoinedClientCount() const;
+
+
+private:
+	//-----Private Data-----
+
+	NetSoakTestConfig_t				m_config;
+
+	NetSession*						m_host = nullptr;
+	std::vector<NetSession*>		m_clients;
+	std::vector<NetSoakObject_t*>	m_hostObjects;
+
+	std::vector<float>				m_hostTickTimes;	// Ms, reserved up front so measuring doesn't allocate
+
+};
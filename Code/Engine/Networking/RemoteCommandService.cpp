@@ -9,17 +9,21 @@
 #include "Engine/Core/Time/Time.hpp"
 #include "Engine/Core/Time/Stopwatch.hpp"
 #include "Engine/Networking/BytePacker.hpp"
+#include "Engine/DataStructures/ByteRingBuffer.hpp"
 #include "Engine/Rendering/Core/Renderer.hpp"
 #include "Engine/Core/Utility/StringUtils.hpp"
 #include "Engine/Core/Threading/Threading.hpp"
 #include "Engine/Rendering/Materials/Material.hpp"
 #include "Engine/Core/DeveloperConsole/Command.hpp"
+#include "Engine/Networking/RemoteProfiler.hpp"
 #include "Engine/Networking/RemoteCommandService.hpp"
 #include "Engine/Core/DeveloperConsole/DevConsole.hpp"
 
 #define DEFAULT_SERVICE_PORT 29283
 #define MAX_CLIENTS 32
 #define DELAY_TIME 5
+#define RECEIVE_BUFFER_SIZE (128 * 1024)	// Room for the largest message, a 2 byte size and up to 0xffff bytes
+#define MESSAGE_SIZE_BYTES 2
 
 // For checking thread ID's
 #if defined( _WIN32 )
@@ -37,6 +41,7 @@ void Command_RemoteCommandAll(Command& cmd);
 void Command_RemoteJoin(Command& cmd);
 void Command_RemoteHost(Command& cmd);
 void Command_CloneProcess(Command& cmd);
+void Command_RemoteCapture(Command& cmd);
 
 // For sending echo responses
 void SendEchoResponse(ConsoleOutputText text, void* args);
@@ -52,6 +57,8 @@ void RemoteCommandService::Initialize()
 {
 	s_instance = new RemoteCommandService();
 	InitializeConsoleCommands();
+
+	RemoteProfiler::Initialize();
 }
 
 
@@ -60,6 +67,8 @@ void RemoteCommandService::Initialize()
 //
 void RemoteCommandService::Shutdown()
 {
+	RemoteProfiler::Shutdown();
+
 	delete s_instance;
 	s_instance = nullptr;
 }
@@ -82,6 +91,8 @@ void RemoteCommandService::BeginFrame()
 	default:
 		break;
 	}
+
+	RemoteProfiler::BeginFrame();
 }
 
 
@@ -200,6 +211,8 @@ bool RemoteCommandService::Send(const std::string& message, int connectionIndex,
 	s_instance->m_connections[connectionIndex]->Send(&msgBigEndian, 2);
 	int amountSent = s_instance->m_connections[connectionIndex]->Send(sendPack.GetBuffer(), messageLength);
 
+	s_instance->m_capture.Record(NET_CAPTURE_TCP_SENT, s_instance->m_connections[connectionIndex]->GetNetAddress(), sendPack.GetBuffer(), messageLength);
+
 	if (amountSent > 0)
 	{
 		LogTaggedPrintf("RCS", "Sent message \"%s\" to connection index %i", message.c_str(), connectionIndex);
@@ -213,6 +226,53 @@ bool RemoteCommandService::Send(const std::string& message, int connectionIndex,
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Sends a message of raw data to the connection at index, for the type's handler on the other end
+// Not logged as the text messages are, since these can go out every frame
+//
+bool RemoteCommandService::SendData(eRemoteMessageType type, const void* data, size_t byteCount, int connectionIndex)
+{
+	ASSERT_OR_DIE(type > REMOTE_MESSAGE_ECHO && type < NUM_REMOTE_MESSAGE_TYPES, Stringf("Error: RemoteCommandService::SendData() called with message type %i", (int) type).c_str());
+
+	if (connectionIndex >= (int)s_instance->m_connections.size() || (byteCount + 1) > 0xffff)
+	{
+		return false;
+	}
+
+	BytePacker sendPack(BIG_ENDIAN);
+
+	sendPack.WriteBytes(1, &type);
+	sendPack.WriteBytes(byteCount, data);
+
+	uint16_t messageLength = (uint16_t)sendPack.GetWrittenByteCount();
+	uint16_t msgBigEndian = messageLength;
+	ToEndianness(2, &msgBigEndian, BIG_ENDIAN);
+
+	s_instance->m_connections[connectionIndex]->Send(&msgBigEndian, 2);
+	int amountSent = s_instance->m_connections[connectionIndex]->Send(sendPack.GetBuffer(), messageLength);
+
+	s_instance->m_capture.Record(NET_CAPTURE_TCP_SENT, s_instance->m_connections[connectionIndex]->GetNetAddress(), sendPack.GetBuffer(), messageLength);
+
+	if (amountSent < (int) messageLength)
+	{
+		LogTaggedPrintf("RCS", "Failed to send a %u byte message of type %i to connection index %i", messageLength, (int) type, connectionIndex);
+	}
+
+	return (amountSent == (int) messageLength);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the function that processes messages of the given type, replacing any set before
+//
+void RemoteCommandService::RegisterMessageHandler(eRemoteMessageType type, RemoteMessageHandler handler)
+{
+	ASSERT_OR_DIE(type > REMOTE_MESSAGE_ECHO && type < NUM_REMOTE_MESSAGE_TYPES, Stringf("Error: RemoteCommandService::RegisterMessageHandler() called with message type %i", (int) type).c_str());
+
+	s_instance->m_messageHandlers[type] = handler;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Sets the join request address to signal if the RCS should join an address
 //
@@ -248,6 +308,16 @@ int RemoteCommandService::GetConnectionCount()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the index of the connection that sent the command being run, for commands that reply
+// with more than an echo; -1 if the command didn't come from a connection
+//
+int RemoteCommandService::GetCommandSourceConnectionIndex()
+{
+	return s_instance->m_commandSourceConnectionIndex;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Constructor
 //
@@ -256,7 +326,11 @@ RemoteCommandService::RemoteCommandService()
 	, m_hostListenPort(DEFAULT_SERVICE_PORT)
 {
 	m_hostListenSocket.SetBlocking(false);
-	m_delayTimer = new Stopwatch(nullptr);
+
+	for (int typeIndex = 0; typeIndex < NUM_REMOTE_MESSAGE_TYPES; ++typeIndex)
+	{
+		m_messageHandlers[typeIndex] = nullptr;
+	}
 
 	InitializeUILayout();
 
@@ -279,6 +353,24 @@ void RemoteCommandService::InitializeUILayout()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Starts recording the messages sent and received to the file, replacing any capture in progress
+//
+bool RemoteCommandService::StartCapture(const std::string& filePath)
+{
+	return s_instance->m_capture.Open(filePath);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finishes writing the capture in progress, if any
+//
+void RemoteCommandService::StopCapture()
+{
+	s_instance->m_capture.Close();
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Registers the console commands for the RCS into the command system
 //
@@ -291,6 +383,8 @@ void RemoteCommandService::InitializeConsoleCommands()
 	Command::Register("rc_join", "Tells the RCS to connect to the host at the supplied address.", Command_RemoteJoin);
 	Command::Register("rc_host", "Tries to host an RCS with the given port.", Command_RemoteHost);
 	Command::Register("clone_process", "Clones the current process up to the number specified", Command_CloneProcess);
+
+	Command::Register("rc_capture", "Starts recording RCS traffic to the file given, or stops if none is.", Command_RemoteCapture);
 }
 
 
@@ -299,22 +393,7 @@ void RemoteCommandService::InitializeConsoleCommands()
 //
 RemoteCommandService::~RemoteCommandService()
 {
-	for (int i = 0; i < (int)m_connections.size(); ++i)
-	{
-		m_connections[i]->Close();
-		delete m_connections[i];
-	}
-
-	m_connections.clear();
-
-	for (int j = 0; j < (int)m_buffers.size(); ++j)
-	{
-		delete m_buffers[j];
-	}
-
-	m_buffers.clear();
-
-	m_hostListenSocket.Close();
+	CloseAllConnections();
 }
 
 
@@ -366,8 +445,7 @@ void RemoteCommandService::Update_TryToJoinLocal()
 
 	// Connected successfully, store off socket and go to client state
 	joinSocket->SetBlocking(false);
-	m_connections.push_back(joinSocket);
-	m_buffers.push_back(new BytePacker(BIG_ENDIAN));
+	AddConnection(joinSocket);
 	m_state = STATE_CLIENT;
 
 	LogTaggedPrintf("RCS", "RCS is a host");
@@ -397,8 +475,7 @@ void RemoteCommandService::Update_TryToJoinAddress()
 	}
 
 	joinSocket->SetBlocking(false);
-	m_connections.push_back(joinSocket);
-	m_buffers.push_back(new BytePacker(BIG_ENDIAN));
+	AddConnection(joinSocket);
 	m_state = STATE_CLIENT;
 
 	LogTaggedPrintf("RCS", "RCS successfully joined address %s", m_joinRequestAddress.c_str());
@@ -417,13 +494,17 @@ void RemoteCommandService::Update_TryToHost()
 
 	if (!isListening)
 	{
-		m_delayTimer->SetInterval(DELAY_TIME);
+		m_delayTimer.SetInterval(DELAY_TIME);
 		m_state = STATE_DELAY;
 
 		LogTaggedPrintf("RCS", "RCS failed to host, moving to delay");
 	}
 	else
 	{
+		// Accepts only happen once the poll says one is queued, so they can't block
+		m_hostListenSocket.SetBlocking(false);
+		m_poller.AddSocket(&m_hostListenSocket);
+
 		m_state = STATE_HOST;
 
 		LogTaggedPrintf("RCS", "RCS is now hosting");
@@ -436,9 +517,9 @@ void RemoteCommandService::Update_TryToHost()
 //
 void RemoteCommandService::Update_Delay()
 {
-	if (m_delayTimer->HasIntervalElapsed())
+	if (m_delayTimer.HasIntervalElapsed())
 	{
-		m_delayTimer->Reset();
+		m_delayTimer.Reset();
 		m_state = STATE_INITIAL;
 	
 		LogTaggedPrintf("RCS", "Entered Initial State");
@@ -458,7 +539,7 @@ void RemoteCommandService::Update_Host()
 		LogTaggedPrintf("RCS", "Entered Initial State");
 	}
 
-	CheckForNewConnections();
+	// New connections are accepted as the listen socket comes up ready in the poll
 	ProcessAllConnections();
 	CleanUpClosedConnections();
 }
@@ -490,97 +571,157 @@ void RemoteCommandService::Update_Client()
 
 
 //-----------------------------------------------------------------------------------------------
-// Checks if there are any new connections connecting to the listen socket
+// Accepts every connection queued on the listen socket
 //
 void RemoteCommandService::CheckForNewConnections()
 {
-	m_hostListenSocket.SetBlocking(false);
 	TCPSocket* socket = m_hostListenSocket.Accept();
 
-	if (socket != nullptr)
+	while (socket != nullptr)
 	{
-		m_connections.push_back(socket);
-		m_buffers.push_back(new BytePacker(BIG_ENDIAN));
+		AddConnection(socket);
+		socket = m_hostListenSocket.Accept();
 	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Processes all connections, used in the update loop for Clients and Hosts
+// Polls all connections at once and processes the ones with something to read, used in the update
+// loop for Clients and Hosts
 //
 void RemoteCommandService::ProcessAllConnections()
 {
-	for (int connectionIndex = 0; connectionIndex < (int)m_connections.size(); ++connectionIndex)
+	const std::vector<SocketPollResult_t>& readySockets = m_poller.Poll();
+
+	for (int readyIndex = 0; readyIndex < (int) readySockets.size(); ++readyIndex)
 	{
-		ProcessConnection(connectionIndex);
+		const SocketPollResult_t& result = readySockets[readyIndex];
+
+		if (result.socket == &m_hostListenSocket)
+		{
+			CheckForNewConnections();
+			continue;
+		}
+
+		// Commands run for earlier connections can close the others
+		int connectionIndex = GetConnectionIndex(result.socket);
+		if (connectionIndex < 0)
+		{
+			continue;
+		}
+
+		// Whatever arrived before a hang up is still processed
+		if (result.isReadable)
+		{
+			ProcessConnection(connectionIndex);
+		}
+
+		connectionIndex = GetConnectionIndex(result.socket);
+		if (result.hasFailed && connectionIndex >= 0)
+		{
+			m_connections[connectionIndex]->Close();
+		}
 	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Processes the given connection by calling receive on the socket
+// Receives everything waiting on the given connection into its ring, and processes every whole
+// message in it
 //
 void RemoteCommandService::ProcessConnection(int connectionIndex)
 {
 	TCPSocket* connection = m_connections[connectionIndex];
-	BytePacker *buffer = m_buffers[connectionIndex];
-
-	buffer->Reserve(2);
+	ByteRingBuffer* buffer = m_buffers[connectionIndex];
 
-	// Need to get the message length still
-	if (buffer->GetWrittenByteCount() < 2)
+	// Receive straight into the ring, until it's full or the socket has nothing left
+	while (buffer->GetWritableByteCount() > 0)
 	{
-		int amountReceived = connection->Receive(buffer->GetWriteHead(), 2 - buffer->GetWrittenByteCount());
-		buffer->AdvanceWriteHead(amountReceived);
+		uint8_t* writeHead;
+		size_t spanSize = buffer->GetWriteSpan(writeHead);
+
+		int amountReceived = connection->Receive(writeHead, spanSize);
+		if (amountReceived <= 0)
+		{
+			break;
+		}
+
+		buffer->CommitWrite(amountReceived);
+
+		if ((size_t) amountReceived < spanSize)
+		{
+			break;
+		}
 	}
 
-	bool isReadyToProcess = false;
-	if (buffer->GetWrittenByteCount() >= 2)
+	while (buffer->GetReadableByteCount() >= MESSAGE_SIZE_BYTES)
 	{
-		uint16_t len;
-		buffer->Peek(&len, sizeof(len));
+		uint16_t messageSize;
+		buffer->Peek(&messageSize, MESSAGE_SIZE_BYTES);
+		FromEndianness(MESSAGE_SIZE_BYTES, &messageSize, BIG_ENDIAN);
 
-		// Reserve enough for the size 
-		buffer->Reserve(len + 2U);
+		if (buffer->GetReadableByteCount() < MESSAGE_SIZE_BYTES + (size_t) messageSize)
+		{
+			break;
+		}
 
-		size_t bytesNeeded = len + 2U - buffer->GetWrittenByteCount();
+		buffer->Consume(MESSAGE_SIZE_BYTES);
 
-		// If we still need more of the message
-		if (bytesNeeded > 0)
+		// Read in place unless the message wraps around the end of the ring
+		const uint8_t* messageData;
+		if (buffer->GetReadSpan(messageData) < messageSize)
 		{
-			size_t read = connection->Receive(buffer->GetWriteHead(), bytesNeeded);
-			buffer->AdvanceWriteHead(read);
-
-			bytesNeeded -= read;
+			m_messageScratch.resize(messageSize);
+			buffer->Peek(m_messageScratch.data(), messageSize);
+			messageData = m_messageScratch.data();
 		}
 
-		isReadyToProcess = (bytesNeeded == 0);
-	}
+		m_capture.Record(NET_CAPTURE_TCP_RECEIVED, connection->GetNetAddress(), messageData, messageSize);
 
-	if (isReadyToProcess)
-	{
-		buffer->AdvanceReadHead(2U);
-		ProcessMessage(connectionIndex);
+		BytePacker message(messageSize, (void*) messageData, false, BIG_ENDIAN);
+		message.AdvanceWriteHead(messageSize);
+
+		ProcessMessage(connectionIndex, message);
+
+		// The command may have closed connections, this one's ring with them
+		if (connectionIndex >= (int) m_connections.size() || m_connections[connectionIndex] != connection)
+		{
+			return;
+		}
 
-		// Clean up to be used
-		buffer->ResetWrite();
+		buffer->Consume(messageSize);
 	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Processes the message fully received on the given connection index
+// Processes a message fully received on the given connection index
 //
-void RemoteCommandService::ProcessMessage(int connectionIndex)
+void RemoteCommandService::ProcessMessage(int connectionIndex, BytePacker& message)
 {
 	TCPSocket* connection = m_connections[connectionIndex];
-	BytePacker *buffer = m_buffers[connectionIndex];
 
-	bool isEcho;
-	buffer->ReadBytes(&isEcho, 1);;
+	uint8_t type = REMOTE_MESSAGE_COMMAND;
+	message.ReadBytes(&type, 1);
+
+	if (type > REMOTE_MESSAGE_ECHO)
+	{
+		if (type < NUM_REMOTE_MESSAGE_TYPES && m_messageHandlers[type] != nullptr)
+		{
+			m_messageHandlers[type](connectionIndex, message);
+		}
+		else
+		{
+			LogTaggedPrintf("RCS", "Warning: Dropped a message of type %i from connection index %i, nothing handles it", (int) type, connectionIndex);
+		}
+
+		return;
+	}
+
+	bool isEcho = (type == REMOTE_MESSAGE_ECHO);
 
 	std::string str;
-	if (buffer->ReadString(str))
+	if (message.ReadString(str))
 	{
 		// Succeeded in getting a command string
 		if (isEcho)
@@ -593,7 +734,11 @@ void RemoteCommandService::ProcessMessage(int connectionIndex)
 		{
 			// Run the command, sending back the echo response
 			DevConsole::AddConsoleHook(SendEchoResponse, &connectionIndex);
+			m_commandSourceConnectionIndex = connectionIndex;
+
 			Command::Run(str);
+
+			m_commandSourceConnectionIndex = -1;
 			DevConsole::RemoveConsoleHook(SendEchoResponse);
 		}
 	}
@@ -609,9 +754,11 @@ void RemoteCommandService::CleanUpClosedConnections()
 	{
 		if (m_connections[i]->IsClosed())
 		{
+			m_poller.RemoveSocket(m_connections[i]);
+			delete m_connections[i];
 			m_connections.erase(m_connections.begin() + i);
 			
-			// Free up the byte packer for this connection
+			// Free up the ring for this connection
 			delete m_buffers[i];
 			m_buffers.erase(m_buffers.begin() + i);
 		}
@@ -619,6 +766,34 @@ void RemoteCommandService::CleanUpClosedConnections()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Adds the connected socket to the connections, and to the poll
+//
+void RemoteCommandService::AddConnection(TCPSocket* connection)
+{
+	m_connections.push_back(connection);
+	m_buffers.push_back(new ByteRingBuffer(RECEIVE_BUFFER_SIZE));
+	m_poller.AddSocket(connection);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the index of the connection using the given socket, -1 if there isn't one
+//
+int RemoteCommandService::GetConnectionIndex(const Socket* connection) const
+{
+	for (int index = 0; index < (int) m_connections.size(); ++index)
+	{
+		if (m_connections[index] == connection)
+		{
+			return index;
+		}
+	}
+
+	return -1;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Closes all connections on the RCS
 //
@@ -626,6 +801,7 @@ void RemoteCommandService::CloseAllConnections()
 {
 	// Ensure we're no longer hosting
 	m_hostListenSocket.Close();
+	m_poller.Clear();
 
 	// Close all existing connections
 	for (int index = 0; index < (int)m_connections.size(); ++index)
@@ -838,3 +1014,29 @@ void SendEchoResponse(ConsoleOutputText text, void* args)
 
 	RemoteCommandService::Send(text.m_text, connectionIndex, true);
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts capturing RCS traffic to the file given with f, or stops the capture without one
+//
+void Command_RemoteCapture(Command& cmd)
+{
+	std::string filePath;
+	cmd.GetParam("f", filePath);
+
+	if (filePath.size() == 0)
+	{
+		RemoteCommandService::StopCapture();
+		ConsolePrintf("RCS capture stopped");
+		return;
+	}
+
+	if (RemoteCommandService::StartCapture(filePath))
+	{
+		ConsolePrintf("Capturing RCS traffic to \"%s\"", filePath.c_str());
+	}
+	else
+	{
+		ConsoleErrorf("Couldn't open \"%s\" for the capture", filePath.c_str());
+	}
+}
@@ -6,6 +6,9 @@
 /************************************************************************/
 #pragma once
 #include "Engine/Networking/TCPSocket.hpp"
+#include "Engine/Networking/NetCapture.hpp"
+#include "Engine/Networking/SocketPoller.hpp"
+#include "Engine/Core/Time/Stopwatch.hpp"
 #include <vector>
 
 // Enum to control state flow
@@ -21,9 +24,22 @@ enum eServiceState
 	NUM_STATES
 };
 
+// First byte of every message - commands and echoes keep the values of the old isEcho flag
+enum eRemoteMessageType : uint8_t
+{
+	REMOTE_MESSAGE_COMMAND = 0,
+	REMOTE_MESSAGE_ECHO = 1,
+	REMOTE_MESSAGE_PROFILER_FRAME,
+	REMOTE_MESSAGE_PROFILER_TRACE,
+	NUM_REMOTE_MESSAGE_TYPES
+};
+
 
-class Stopwatch;
 class BytePacker;
+class ByteRingBuffer;
+
+// For the messages that aren't command text, given the message with the read head after the type
+typedef void(*RemoteMessageHandler)(int connectionIndex, BytePacker& message);
 
 
 class RemoteCommandService
@@ -39,11 +55,18 @@ public:
 
 	// Statics
 	static bool Send(const std::string& message, int connectionIndex, bool isEcho);
+	static bool SendData(eRemoteMessageType type, const void* data, size_t byteCount, int connectionIndex);
+	static void RegisterMessageHandler(eRemoteMessageType type, RemoteMessageHandler handler);
 	static void Join(const std::string& address);
 	static void Host(unsigned short port);
 
 	static RemoteCommandService*	GetInstance();
 	static int						GetConnectionCount();
+	static int						GetCommandSourceConnectionIndex();	// The connection whose command is running, -1 outside of one
+
+	// Capture - records every message sent and received, see NetCapture
+	static bool						StartCapture(const std::string& filePath);
+	static void						StopCapture();
 
 
 private:
@@ -68,9 +91,11 @@ private:
 	void CheckForNewConnections();
 	void ProcessAllConnections();
 		void ProcessConnection(int connectionIndex);
-		void ProcessMessage(int connectionIndex);
+		void ProcessMessage(int connectionIndex, BytePacker& message);
 	void CleanUpClosedConnections();
 
+	void AddConnection(TCPSocket* connection);
+	int  GetConnectionIndex(const Socket* connection) const;
 	void CloseAllConnections();
 
 
@@ -81,10 +106,18 @@ private:
 	TCPSocket					m_hostListenSocket;
 	unsigned short				m_hostListenPort;
 
-	std::vector<TCPSocket*>		m_connections;
-	std::vector<BytePacker*>	m_buffers;
+	// Only the sockets the poller reports as ready are received on, each into its own ring
+	std::vector<TCPSocket*>			m_connections;
+	std::vector<ByteRingBuffer*>	m_buffers;
+	SocketPoller					m_poller;
+	std::vector<uint8_t>			m_messageScratch;	// For the messages that wrap around their ring
+
+	NetCaptureWriter			m_capture;
+
+	RemoteMessageHandler		m_messageHandlers[NUM_REMOTE_MESSAGE_TYPES];
+	int							m_commandSourceConnectionIndex = -1;
 
-	Stopwatch*					m_delayTimer = nullptr;
+	Stopwatch					m_delayTimer;
 	std::string					m_joinRequestAddress;
 
 
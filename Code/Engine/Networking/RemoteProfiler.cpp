@@ -0,0 +1,602 @@
+/************************************************************************/
+/* File: RemoteProfiler.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the RemoteProfiler class
+/************************************************************************/
+#include "Engine/Networking/RemoteProfiler.hpp"
+#include "Engine/Networking/RemoteCommandService.hpp"
+#include "Engine/Networking/BytePacker.hpp"
+#include "Engine/Networking/Endianness.hpp"
+#include "Engine/Core/File.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/Time/Time.hpp"
+#include "Engine/Core/Time/Profiler.hpp"
+#include "Engine/Core/Time/ProfileReport.hpp"
+#include "Engine/Core/Time/ProfileReportEntry.hpp"
+#include "Engine/Core/DeveloperConsole/Command.hpp"
+#include "Engine/Core/DeveloperConsole/DevConsole.hpp"
+#include "Engine/Core/Utility/StringUtils.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <atomic>
+#include <vector>
+#include <string.h>
+
+// Allocations can only be counted through the debug CRT
+#if defined(_MSC_VER) && defined(_DEBUG)
+#include <crtdbg.h>
+#define REMOTE_PROFILER_COUNT_ALLOCATIONS
+#endif
+
+#define REMOTE_PROFILER_OUTGOING_TRACE_PATH "Data/Logs/RemoteProfileTrace_Outgoing.json"
+
+#ifdef REMOTE_PROFILER_COUNT_ALLOCATIONS
+static std::atomic<int>	s_frameAllocationCount(0);
+static _CRT_ALLOC_HOOK	s_previousAllocHook = nullptr;
+#endif
+
+// Commands
+void Command_ProfilerRemoteStream(Command& cmd);
+void Command_ProfilerRemoteView(Command& cmd);
+void Command_ProfilerRemoteFetch(Command& cmd);
+void Command_ProfilerRemoteSendTrace(Command& cmd);
+
+// Singleton instance
+RemoteProfiler* RemoteProfiler::s_instance = nullptr;
+
+
+#ifdef REMOTE_PROFILER_COUNT_ALLOCATIONS
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Debug CRT hook, counts every allocation on every thread while streaming, passing it on to any
+// hook that was set before
+//
+int CountRemoteProfilerAllocation(int allocType, void* userData, size_t size, int blockType, long requestNumber, const unsigned char* fileName, int lineNumber)
+{
+	if (allocType == _HOOK_ALLOC || allocType == _HOOK_REALLOC)
+	{
+		s_frameAllocationCount++;
+	}
+
+	if (s_previousAllocHook != nullptr)
+	{
+		return s_previousAllocHook(allocType, userData, size, blockType, requestNumber, fileName, lineNumber);
+	}
+
+	return 1; // Nonzero lets the allocation go through
+}
+#endif
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the allocations counted since the last call, or -1 if they aren't counted in this build
+//
+int TakeFrameAllocationCount()
+{
+#ifdef REMOTE_PROFILER_COUNT_ALLOCATIONS
+	return s_frameAllocationCount.exchange(0);
+#else
+	return -1;
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Creates the instance and registers the RCS message handlers and the console commands
+//
+void RemoteProfiler::Initialize()
+{
+	s_instance = new RemoteProfiler();
+
+	RemoteCommandService::RegisterMessageHandler(REMOTE_MESSAGE_PROFILER_FRAME, ProcessFrameSummary);
+	RemoteCommandService::RegisterMessageHandler(REMOTE_MESSAGE_PROFILER_TRACE, ProcessTraceChunk);
+
+	InitializeConsoleCommands();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stops streaming and deletes the instance, dropping any trace still being sent or received
+//
+void RemoteProfiler::Shutdown()
+{
+	SetStreaming(false);
+
+	delete s_instance;
+	s_instance = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sends the summary of the last completed frame if streaming, and the next chunk of a trace
+//
+void RemoteProfiler::BeginFrame()
+{
+	if (Profiler::GetInstance() == nullptr || RemoteCommandService::GetConnectionCount() == 0)
+	{
+		return;
+	}
+
+	if (s_instance->m_isStreaming)
+	{
+		s_instance->SendFrameSummary();
+	}
+
+	s_instance->SendNextTraceChunk();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts or stops sending a summary of every frame to every connection
+//
+void RemoteProfiler::SetStreaming(bool isStreaming)
+{
+	if (s_instance->m_isStreaming == isStreaming)
+	{
+		return;
+	}
+
+	s_instance->m_isStreaming = isStreaming;
+	s_instance->m_lastSentFrameNumber = -1;
+
+#ifdef REMOTE_PROFILER_COUNT_ALLOCATIONS
+	if (isStreaming)
+	{
+		s_frameAllocationCount = 0;
+		s_previousAllocHook = _CrtSetAllocHook(CountRemoteProfilerAllocation);
+	}
+	else
+	{
+		_CrtSetAllocHook(s_previousAllocHook);
+		s_previousAllocHook = nullptr;
+	}
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if frame summaries are being sent
+//
+bool RemoteProfiler::IsStreaming()
+{
+	return s_instance->m_isStreaming;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Exports the last frameCount frames as a trace and starts sending it to the connection, replacing
+// any trace still being sent
+//
+bool RemoteProfiler::SendTrace(int connectionIndex, int frameCount)
+{
+	if (Profiler::GetInstance() == nullptr || connectionIndex < 0 || connectionIndex >= RemoteCommandService::GetConnectionCount())
+	{
+		return false;
+	}
+
+	if (!Profiler::ExportTrace(REMOTE_PROFILER_OUTGOING_TRACE_PATH, frameCount))
+	{
+		return false;
+	}
+
+	size_t fileSize;
+	uint8_t* trace = (uint8_t*) FileReadToNewBuffer(REMOTE_PROFILER_OUTGOING_TRACE_PATH, fileSize);
+
+	if (trace == nullptr)
+	{
+		return false;
+	}
+
+	s_instance->ClearOutgoingTrace();
+
+	// Read as text, so the size on disk can be more than what was read
+	s_instance->m_outgoingTrace = trace;
+	s_instance->m_outgoingTraceSize = strlen((const char*) trace);
+	s_instance->m_outgoingTraceOffset = 0;
+	s_instance->m_outgoingTraceConnectionIndex = connectionIndex;
+	s_instance->m_outgoingTraceConnectionCount = RemoteCommandService::GetConnectionCount();
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts or stops showing the received summaries in this process's profiler
+//
+void RemoteProfiler::SetViewing(bool isViewing)
+{
+	s_instance->m_isViewing = isViewing;
+
+	if (Profiler::GetInstance() != nullptr)
+	{
+		Profiler::SetRemoteView(isViewing);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if received summaries are shown in the profiler
+//
+bool RemoteProfiler::IsViewing()
+{
+	return s_instance->m_isViewing;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the file the next received trace is written to
+//
+void RemoteProfiler::SetTraceReceivePath(const std::string& filePath)
+{
+	s_instance->m_traceReceivePath = filePath;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+RemoteProfiler::~RemoteProfiler()
+{
+	ClearOutgoingTrace();
+	CloseIncomingTrace();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Registers the console commands for streaming and viewing
+//
+void RemoteProfiler::InitializeConsoleCommands()
+{
+	Command::Register("profiler_remote_stream",		"Sends a profiler summary of every frame to all RCS connections, -e false to stop.",	Command_ProfilerRemoteStream);
+	Command::Register("profiler_remote_view",		"Shows the profiler of the RCS connection i in this one, -e false to stop.",				Command_ProfilerRemoteView);
+	Command::Register("profiler_remote_fetch",		"Fetches the last n frames from RCS connection i as a trace file f.",					Command_ProfilerRemoteFetch);
+	Command::Register("profiler_remote_send_trace",	"Sends the last n frames as a trace to the RCS connection that ran it.",				Command_ProfilerRemoteSendTrace);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sends the top entries by self time of the last completed frame to every connection, once per frame
+//
+void RemoteProfiler::SendFrameSummary()
+{
+	ProfileReport* report = Profiler::CreateReportForFrame(0, REPORT_TYPE_FLAT, REPORT_SORT_SELF_TIME);
+
+	if (report == nullptr)
+	{
+		return;
+	}
+
+	if ((int) report->m_frameNumber == m_lastSentFrameNumber)
+	{
+		delete report;
+		return;
+	}
+
+	m_lastSentFrameNumber = (int) report->m_frameNumber;
+
+	ProfileReportEntry* rootEntry = report->m_rootEntry;
+	uint8_t entryCount = (uint8_t) MinInt((int) rootEntry->m_children.size(), REMOTE_PROFILER_TOP_ENTRY_COUNT);
+
+	BytePacker summary(BIG_ENDIAN);
+	summary.Write((int32_t) report->m_frameNumber);
+	summary.Write((float) (TimeSystem::PerformanceCountToSeconds(rootEntry->m_totalTime) * 1000.0));
+	summary.Write((int32_t) TakeFrameAllocationCount());
+	summary.Write(entryCount);
+
+	// Flat children are sorted by self time already
+	for (int entryIndex = 0; entryIndex < (int) entryCount; ++entryIndex)
+	{
+		ProfileReportEntry* entry = rootEntry->m_children[entryIndex];
+
+		summary.WriteString(entry->m_name);
+		summary.Write((uint32_t) entry->m_callCount);
+		summary.Write((float) (TimeSystem::PerformanceCountToSeconds(entry->m_totalTime) * 1000.0));
+		summary.Write((float) (TimeSystem::PerformanceCountToSeconds(entry->m_selfTime) * 1000.0));
+	}
+
+	delete report;
+
+	int connectionCount = RemoteCommandService::GetConnectionCount();
+	for (int connectionIndex = 0; connectionIndex < connectionCount; ++connectionIndex)
+	{
+		RemoteCommandService::SendData(REMOTE_MESSAGE_PROFILER_FRAME, summary.GetBuffer(), summary.GetWrittenByteCount(), connectionIndex);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sends the next chunk of the outgoing trace, if there is one
+//
+void RemoteProfiler::SendNextTraceChunk()
+{
+	if (m_outgoingTrace == nullptr)
+	{
+		return;
+	}
+
+	if (RemoteCommandService::GetConnectionCount() != m_outgoingTraceConnectionCount)
+	{
+		LogTaggedPrintf("RCS", "Warning: The RCS connections changed while sending a profiler trace, the rest of it won't be sent");
+		ClearOutgoingTrace();
+		return;
+	}
+
+	size_t chunkSize = m_outgoingTraceSize - m_outgoingTraceOffset;
+	if (chunkSize > REMOTE_PROFILER_TRACE_CHUNK_SIZE)
+	{
+		chunkSize = REMOTE_PROFILER_TRACE_CHUNK_SIZE;
+	}
+
+	BytePacker chunk(BIG_ENDIAN);
+	chunk.Write((uint32_t) m_outgoingTraceSize);
+	chunk.Write((uint32_t) m_outgoingTraceOffset);
+
+	// The trace text is copied as is
+	chunk.SetEndianness(GetPlatformEndianness());
+	chunk.WriteBytes(chunkSize, m_outgoingTrace + m_outgoingTraceOffset);
+
+	if (!RemoteCommandService::SendData(REMOTE_MESSAGE_PROFILER_TRACE, chunk.GetBuffer(), chunk.GetWrittenByteCount(), m_outgoingTraceConnectionIndex))
+	{
+		LogTaggedPrintf("RCS", "Warning: Couldn't send a profiler trace chunk to connection index %i, the rest of it won't be sent", m_outgoingTraceConnectionIndex);
+		ClearOutgoingTrace();
+		return;
+	}
+
+	m_outgoingTraceOffset += chunkSize;
+
+	if (m_outgoingTraceOffset == m_outgoingTraceSize)
+	{
+		LogTaggedPrintf("RCS", "Sent a %u byte profiler trace to connection index %i", (unsigned int) m_outgoingTraceSize, m_outgoingTraceConnectionIndex);
+		ClearOutgoingTrace();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Frees the trace being sent, if any
+//
+void RemoteProfiler::ClearOutgoingTrace()
+{
+	if (m_outgoingTrace != nullptr)
+	{
+		free(m_outgoingTrace);
+		m_outgoingTrace = nullptr;
+	}
+
+	m_outgoingTraceSize = 0;
+	m_outgoingTraceOffset = 0;
+	m_outgoingTraceConnectionIndex = -1;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Closes the file of the trace being received, if any
+//
+void RemoteProfiler::CloseIncomingTrace()
+{
+	if (m_incomingTrace != nullptr)
+	{
+		delete m_incomingTrace;
+		m_incomingTrace = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Rebuilds a flat report from a received frame summary and gives it to the profiler
+// The frame's time not in the top entries is left as the root's self time
+//
+void RemoteProfiler::ProcessFrameSummary(int connectionIndex, BytePacker& message)
+{
+	UNUSED(connectionIndex);
+
+	if (!s_instance->m_isViewing || Profiler::GetInstance() == nullptr)
+	{
+		return;
+	}
+
+	int32_t frameNumber;
+	float frameMs;
+	int32_t allocationCount;
+	uint8_t entryCount;
+
+	message.Read(frameNumber);
+	message.Read(frameMs);
+	message.Read(allocationCount);
+	message.Read(entryCount);
+
+	ProfileReport* report = new ProfileReport(frameNumber);
+	report->m_type = REPORT_TYPE_FLAT;
+	report->m_sortOrder = REPORT_SORT_SELF_TIME;
+	report->m_allocationCount = allocationCount;
+
+	ProfileReportEntry* rootEntry = new ProfileReportEntry("Frame");
+	rootEntry->m_callCount = 1;
+	rootEntry->m_totalTime = TimeSystem::SecondsToPerformanceCount((double) frameMs * 0.001);
+	report->m_rootEntry = rootEntry;
+
+	uint64_t entriesSelfTime = 0;
+	for (int entryIndex = 0; entryIndex < (int) entryCount; ++entryIndex)
+	{
+		std::string name;
+		uint32_t callCount;
+		float totalMs;
+		float selfMs;
+
+		message.ReadString(name);
+		message.Read(callCount);
+		message.Read(totalMs);
+		message.Read(selfMs);
+
+		ProfileReportEntry* entry = rootEntry->GetOrCreateReportEntryForChild(name);
+		entry->m_callCount = callCount;
+		entry->m_totalTime = TimeSystem::SecondsToPerformanceCount((double) totalMs * 0.001);
+		entry->m_selfTime = TimeSystem::SecondsToPerformanceCount((double) selfMs * 0.001);
+
+		entriesSelfTime += entry->m_selfTime;
+	}
+
+	// Other threads' entries can add up to more than the frame
+	rootEntry->m_selfTime = (entriesSelfTime < rootEntry->m_totalTime ? rootEntry->m_totalTime - entriesSelfTime : 0);
+
+	report->Finalize();
+	Profiler::PushRemoteReport(report);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes a received trace chunk to the receive path, the first one starting the file
+//
+void RemoteProfiler::ProcessTraceChunk(int connectionIndex, BytePacker& message)
+{
+	uint32_t traceSize;
+	uint32_t chunkOffset;
+
+	message.Read(traceSize);
+	message.Read(chunkOffset);
+
+	if (chunkOffset == 0)
+	{
+		s_instance->CloseIncomingTrace();
+
+		File* file = new File();
+		if (!file->Open(s_instance->m_traceReceivePath.c_str(), "wb"))
+		{
+			ConsoleErrorf("Couldn't open \"%s\" for the remote trace.", s_instance->m_traceReceivePath.c_str());
+			delete file;
+			return;
+		}
+
+		s_instance->m_incomingTrace = file;
+	}
+
+	// Missed the start of this trace, or couldn't open a file for it
+	if (s_instance->m_incomingTrace == nullptr)
+	{
+		return;
+	}
+
+	std::vector<uint8_t> chunk(message.GetRemainingReadableByteCount());
+
+	message.SetEndianness(GetPlatformEndianness());
+	message.ReadBytes(chunk.data(), chunk.size());
+
+	s_instance->m_incomingTrace->Write(chunk.data(), chunk.size());
+
+	if (chunkOffset + (uint32_t) chunk.size() >= traceSize)
+	{
+		s_instance->CloseIncomingTrace();
+		ConsolePrintf(Rgba::GREEN, "Received a %u byte profiler trace from connection %i, written to \"%s\".", traceSize, connectionIndex, s_instance->m_traceReceivePath.c_str());
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts or stops streaming frame summaries to every connection
+//
+void Command_ProfilerRemoteStream(Command& cmd)
+{
+	bool shouldStream = true;
+	cmd.GetParam("e", shouldStream, &shouldStream);
+
+	RemoteProfiler::SetStreaming(shouldStream);
+
+	if (shouldStream)
+	{
+		ConsolePrintf(Rgba::GREEN, "Streaming profiler frames to %i RCS connections.", RemoteCommandService::GetConnectionCount());
+	}
+	else
+	{
+		ConsolePrintf(Rgba::GREEN, "Stopped streaming profiler frames.");
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Shows the profiler of the connection given with i, asking it to stream, or goes back to this one
+//
+void Command_ProfilerRemoteView(Command& cmd)
+{
+	bool shouldView = true;
+	int connectionIndex = 0;
+
+	cmd.GetParam("e", shouldView, &shouldView);
+	cmd.GetParam("i", connectionIndex, &connectionIndex);
+
+	std::string streamCommand = Stringf("profiler_remote_stream -e %s", (shouldView ? "true" : "false"));
+
+	if (!RemoteCommandService::Send(streamCommand, connectionIndex, false))
+	{
+		ConsoleErrorf("Couldn't send the stream request to connection %i", connectionIndex);
+
+		// Nothing will arrive to show, but going back to the local frames still can
+		if (shouldView)
+		{
+			return;
+		}
+	}
+
+	RemoteProfiler::SetViewing(shouldView);
+
+	if (shouldView)
+	{
+		Profiler::Show();
+		ConsolePrintf(Rgba::GREEN, "Viewing the profiler of connection %i.", connectionIndex);
+	}
+	else
+	{
+		ConsolePrintf(Rgba::GREEN, "Viewing the local profiler.");
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Asks the connection given with i for a trace of its last n frames, to be written to f
+//
+void Command_ProfilerRemoteFetch(Command& cmd)
+{
+	int connectionIndex = 0;
+	int frameCount = PROFILER_MAX_REPORT_COUNT;
+	std::string filePath = "Data/Logs/RemoteProfileTrace.json";
+
+	cmd.GetParam("i", connectionIndex, &connectionIndex);
+	cmd.GetParam("n", frameCount, &frameCount);
+	cmd.GetParam("f", filePath, &filePath);
+
+	RemoteProfiler::SetTraceReceivePath(filePath);
+
+	if (RemoteCommandService::Send(Stringf("profiler_remote_send_trace -n %i", frameCount), connectionIndex, false))
+	{
+		ConsolePrintf(Rgba::GREEN, "Requested a trace from connection %i, it will be written to \"%s\".", connectionIndex, filePath.c_str());
+	}
+	else
+	{
+		ConsoleErrorf("Couldn't send the trace request to connection %i", connectionIndex);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sends a trace of the last n frames back to the connection that ran this
+//
+void Command_ProfilerRemoteSendTrace(Command& cmd)
+{
+	int connectionIndex = RemoteCommandService::GetCommandSourceConnectionIndex();
+
+	if (connectionIndex < 0)
+	{
+		ConsoleErrorf("profiler_remote_send_trace has to be run from an RCS connection, use profiler_export_trace instead");
+		return;
+	}
+
+	int frameCount = PROFILER_MAX_REPORT_COUNT;
+	cmd.GetParam("n", frameCount, &frameCount);
+
+	if (RemoteProfiler::SendTrace(connectionIndex, frameCount))
+	{
+		ConsolePrintf(Rgba::GREEN, "Sending a trace of the last %i frames.", frameCount);
+	}
+	else
+	{
+		ConsoleErrorf("Couldn't export a trace to send.");
+	}
+}
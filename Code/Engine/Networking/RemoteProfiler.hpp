@@ -0,0 +1,78 @@
+/************************************************************************/
+/* File: RemoteProfiler.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Streams profiler frame summaries and traces over the RCS,
+/*				so another process can show them in its own profiler
+/************************************************************************/
+#pragma once
+#include <string>
+#include <stdint.h>
+
+class File;
+class BytePacker;
+
+#define REMOTE_PROFILER_TOP_ENTRY_COUNT (16)			// Entries sent per frame, by self time
+#define REMOTE_PROFILER_TRACE_CHUNK_SIZE (16 * 1024)	// Trace bytes sent per frame, well under the socket's send buffer
+
+
+class RemoteProfiler
+{
+public:
+	//-----Public Methods-----
+
+	// Started and updated by the RCS
+	static void			Initialize();
+	static void			Shutdown();
+	static void			BeginFrame();
+
+	// Sending side - summaries go to every connection, a trace to the one that asked for it
+	static void			SetStreaming(bool isStreaming);
+	static bool			IsStreaming();
+	static bool			SendTrace(int connectionIndex, int frameCount);
+
+	// Viewing side - received summaries become the profiler's reports, traces are written to the path
+	static void			SetViewing(bool isViewing);
+	static bool			IsViewing();
+	static void			SetTraceReceivePath(const std::string& filePath);
+
+
+private:
+	//-----Private Methods-----
+
+	RemoteProfiler() {}
+	~RemoteProfiler();
+	RemoteProfiler(const RemoteProfiler& copy) = delete;
+
+	static void			InitializeConsoleCommands();
+
+	void				SendFrameSummary();
+	void				SendNextTraceChunk();
+	void				ClearOutgoingTrace();
+	void				CloseIncomingTrace();
+
+	static void			ProcessFrameSummary(int connectionIndex, BytePacker& message);
+	static void			ProcessTraceChunk(int connectionIndex, BytePacker& message);
+
+
+private:
+	//-----Private Data-----
+
+	bool				m_isStreaming = false;
+	bool				m_isViewing = false;
+	int					m_lastSentFrameNumber = -1;
+
+	// Trace being sent, a chunk a frame so it doesn't overrun the non-blocking socket
+	uint8_t*			m_outgoingTrace = nullptr;
+	size_t				m_outgoingTraceSize = 0;
+	size_t				m_outgoingTraceOffset = 0;
+	int					m_outgoingTraceConnectionIndex = -1;
+	int					m_outgoingTraceConnectionCount = 0;		// Indices shift if a connection closes, which ends the send
+
+	// Trace being received
+	File*				m_incomingTrace = nullptr;
+	std::string			m_traceReceivePath = "Data/Logs/RemoteProfileTrace.json";
+
+	static RemoteProfiler* s_instance;
+
+};
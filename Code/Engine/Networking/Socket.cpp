@@ -111,3 +111,12 @@ NetAddress_t Socket::GetNetAddress() const
 {
 	return m_address;
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the OS handle of this socket, INVALID_SOCKET if closed
+//
+Socket_t* Socket::GetSocketHandle() const
+{
+	return m_socketHandle;
+}
@@ -46,6 +46,7 @@ public:
 	bool IsBlocking() const;
 
 	NetAddress_t GetNetAddress() const;
+	Socket_t* GetSocketHandle() const; // for polling many sockets at once, see SocketPoller
 
 
 protected:
@@ -0,0 +1,128 @@
+/************************************************************************/
+/* File: SocketPoller.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the SocketPoller class
+/************************************************************************/
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Networking/SocketPoller.hpp"
+#include <algorithm>
+#include <stddef.h>
+
+#ifndef WIN_32_LEAN_AND_MEAN
+#define WIN_32_LEAN_AND_MEAN
+#endif
+#include <WinSock2.h>
+#include <WS2tcpip.h>
+#include <Windows.h>
+
+static_assert(sizeof(SocketPollEntry_t) == sizeof(WSAPOLLFD), "SocketPollEntry_t must match WSAPOLLFD");
+static_assert(offsetof(SocketPollEntry_t, events) == offsetof(WSAPOLLFD, events), "SocketPollEntry_t must match WSAPOLLFD");
+static_assert(offsetof(SocketPollEntry_t, returnedEvents) == offsetof(WSAPOLLFD, revents), "SocketPollEntry_t must match WSAPOLLFD");
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts watching the socket, if it isn't already
+//
+void SocketPoller::AddSocket(Socket* socket)
+{
+	if (std::find(m_sockets.begin(), m_sockets.end(), socket) == m_sockets.end())
+	{
+		m_sockets.push_back(socket);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stops watching the socket, to be called before it's deleted
+//
+void SocketPoller::RemoveSocket(Socket* socket)
+{
+	std::vector<Socket*>::iterator itr = std::find(m_sockets.begin(), m_sockets.end(), socket);
+
+	if (itr != m_sockets.end())
+	{
+		m_sockets.erase(itr);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stops watching every socket
+//
+void SocketPoller::Clear()
+{
+	m_sockets.clear();
+	m_entries.clear();
+	m_entrySockets.clear();
+	m_results.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of sockets being watched, closed or not
+//
+int SocketPoller::GetSocketCount() const
+{
+	return (int) m_sockets.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Polls every open socket in one call and returns the ones ready to read or that have failed
+//
+const std::vector<SocketPollResult_t>& SocketPoller::Poll(int timeoutMs /*= 0*/)
+{
+	m_results.clear();
+	m_entries.clear();
+	m_entrySockets.clear();
+
+	// Handles are refreshed every poll, as a socket gets a new one each time it connects
+	for (int socketIndex = 0; socketIndex < (int) m_sockets.size(); ++socketIndex)
+	{
+		Socket* socket = m_sockets[socketIndex];
+
+		if (!socket->IsClosed())
+		{
+			SocketPollEntry_t entry;
+			entry.handle = socket->GetSocketHandle();
+			entry.events = POLLRDNORM;
+			entry.returnedEvents = 0;
+
+			m_entries.push_back(entry);
+			m_entrySockets.push_back(socket);
+		}
+	}
+
+	if (m_entries.size() == 0)
+	{
+		return m_results;
+	}
+
+	int readyCount = ::WSAPoll((WSAPOLLFD*) m_entries.data(), (ULONG) m_entries.size(), timeoutMs);
+
+	if (readyCount == SOCKET_ERROR)
+	{
+		LogTaggedPrintf("NET", "Error: SocketPoller::Poll() failed, error code %i", ::WSAGetLastError());
+		return m_results;
+	}
+
+	for (int entryIndex = 0; entryIndex < (int) m_entries.size() && (int) m_results.size() < readyCount; ++entryIndex)
+	{
+		int16_t returnedEvents = m_entries[entryIndex].returnedEvents;
+
+		if (returnedEvents == 0)
+		{
+			continue;
+		}
+
+		SocketPollResult_t result;
+		result.socket = m_entrySockets[entryIndex];
+		result.isReadable = ((returnedEvents & POLLRDNORM) != 0);
+		result.hasFailed = ((returnedEvents & (POLLHUP | POLLERR | POLLNVAL)) != 0);
+
+		m_results.push_back(result);
+	}
+
+	return m_results;
+}
@@ -0,0 +1,53 @@
+/************************************************************************/
+/* File: SocketPoller.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Waits on a set of sockets at once and reports which are
+/*				ready, so idle sockets cost no receive calls
+/************************************************************************/
+#pragma once
+#include "Engine/Networking/Socket.hpp"
+#include <vector>
+
+// Laid out as a WSAPOLLFD, so the list can go to WSAPoll() as is without Windows.h here
+struct SocketPollEntry_t
+{
+	Socket_t*	handle;
+	int16_t		events;
+	int16_t		returnedEvents;
+};
+
+struct SocketPollResult_t
+{
+	Socket*		socket = nullptr;
+	bool		isReadable = false;		// Data is waiting, a listen socket has a connection to accept, or the peer closed
+	bool		hasFailed = false;		// Hung up or errored, nothing more will come
+};
+
+
+class SocketPoller
+{
+public:
+	//-----Public Methods-----
+
+	// Sockets are watched for reads until they're removed; closed ones are skipped, so a socket
+	// can be added before it connects
+	void									AddSocket(Socket* socket);
+	void									RemoveSocket(Socket* socket);
+	void									Clear();
+	int										GetSocketCount() const;
+
+	// One system call for all the sockets, waiting up to timeoutMs (0 to not wait) for any to be ready -
+	// only the ready ones are returned, and the list is reused by the next poll
+	const std::vector<SocketPollResult_t>&	Poll(int timeoutMs = 0);
+
+
+private:
+	//-----Private Data-----
+
+	std::vector<Socket*>					m_sockets;
+	std::vector<SocketPollEntry_t>			m_entries;
+	std::vector<Socket*>					m_entrySockets;		// Parallel to m_entries, without the closed sockets
+	std::vector<SocketPollResult_t>			m_results;
+
+};
@@ -35,7 +35,7 @@ TCPSocket::TCPSocket(Socket_t* socketHandle, NetAddress_t& netAddress, bool isLi
 {
 	m_socketHandle = socketHandle;
 	m_address = netAddress;
-	m_isListening = m_isListening;
+	m_hasConnected = !isListening; // Accepted sockets are connected already
 
 	SetBlocking(isBlocking);
 }
@@ -179,6 +179,14 @@ int TCPSocket::Receive(void *buffer, size_t const maxByteSize)
 			return sizeReceived;
 		}
 	}
+	else if (sizeReceived == 0 && maxByteSize > 0)
+	{
+		// Zero bytes is the peer closing the connection; a poll reports that as readable, so it
+		// would be received again every frame if the socket were kept
+		LogTaggedPrintf("NET", "TCPSocket::Receive() connection to %s was closed by the peer", m_address.ToString().c_str());
+		Close();
+		return 0;
+	}
 
 	// If it was less than 0 but not an error, just return 0
 	return ClampInt(sizeReceived, 0, (int)maxByteSize);
@@ -203,6 +211,7 @@ bool TCPSocket::Connect(const NetAddress_t& netAddress)
 
 	// Create a socket
 	m_socketHandle = (Socket_t*) ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	m_hasConnected = false;
 
 	if ((SOCKET)m_socketHandle == INVALID_SOCKET) {
 		LogTaggedPrintf("NET", "Error: Could not create socket");
@@ -230,6 +239,7 @@ bool TCPSocket::Connect(const NetAddress_t& netAddress)
 
 	if (IsBlocking())
 	{
+		m_hasConnected = true;
 		LogTaggedPrintf("NET", "Connected to %s", netAddress.ToString().c_str());
 	}
 	else
@@ -284,8 +294,8 @@ bool TCPSocket::IsListening() const
 //
 bool TCPSocket::IsStillConnecting()
 {
-	// Blocking sockets won't have this check
-	if (IsBlocking())
+	// Blocking sockets won't have this check, and connected ones are done with it
+	if (IsBlocking() || m_hasConnected)
 	{
 		return false;
 	}
@@ -320,6 +330,7 @@ bool TCPSocket::IsStillConnecting()
 	if ((fd.revents & POLLWRNORM) != 0)
 	{
 		// Socket can read/write, i.e. is connected
+		m_hasConnected = true;
 		return false;
 	}
 
@@ -339,6 +350,11 @@ bool TCPSocket::IsConnected()
 		return false;
 	}
 
+	if (m_hasConnected)
+	{
+		return true;
+	}
+
 	// Socket's good but not finished connecting
 	if (IsStillConnecting())
 	{
@@ -38,5 +38,6 @@ private:
 	//-----Private Data-----
 
 	bool				m_isListening = false;
+	bool				m_hasConnected = false;		// Saves polling the connect on every send and receive once it's done
 
 };
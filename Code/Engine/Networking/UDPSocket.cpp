@@ -94,7 +94,7 @@ size_t UDPSocket::SendTo(NetAddress_t const &netAddr, void const *data, size_t c
 		}
 	}
 
-	ASSERT_RECOVERABLE(sent == byte_count, "UDPSocket::SendTo() couldn't sent all the bytes.");
+	ASSERT_RECOVERABLE((size_t)sent == byte_count, "UDPSocket::SendTo() couldn't sent all the bytes.");
 	return (size_t)sent;
 }
 
@@ -139,3 +139,131 @@ size_t UDPSocket::ReceiveFrom(NetAddress_t *out_addr, void *buffer, size_t const
 
 	return 0;
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Sends each of the datagrams to its address, returning how many were sent
+// WinSock has no multi-datagram send outside of Registered I/O, so this is a sendto() per datagram;
+// callers still gather their sends so a platform with one can swap it in here
+//
+int UDPSocket::SendBatch(const UDPDatagram_t* datagrams, int datagramCount)
+{
+	if (IsClosed())
+	{
+		LogTaggedPrintf("NET", "Error: UDPSocket::SendBatch() called on a closed UDP socket.");
+		return 0;
+	}
+
+	SOCKET sock = (SOCKET)m_socketHandle;
+
+	int numSent = 0;
+	for (int datagramIndex = 0; datagramIndex < datagramCount; ++datagramIndex)
+	{
+		const UDPDatagram_t& datagram = datagrams[datagramIndex];
+
+		sockaddr_storage addr;
+		size_t addr_len;
+		datagram.address.ToSockAddr((sockaddr*)&addr, &addr_len);
+
+		int sent = ::sendto(sock, (char const*)datagram.buffer, (int)datagram.byteCount, 0, (sockaddr*)&addr, (int)addr_len);
+
+		if (sent <= 0)
+		{
+			int errorCode;
+			if (WasLastErrorFatal(errorCode))
+			{
+				LogTaggedPrintf("NET", "Error: UDPSocket::SendBatch() received fatal error %i.", errorCode);
+				Close();
+				break;
+			}
+
+			continue;
+		}
+
+		ASSERT_RECOVERABLE((size_t)sent == datagram.byteCount, "UDPSocket::SendBatch() couldn't send all the bytes.");
+		numSent++;
+	}
+
+	return numSent;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads the datagrams waiting on the socket into the given buffers, up to the max count, returning
+// how many were read
+// Like SendBatch(), a recvfrom() per datagram on WinSock, but stops on the first empty read instead
+// of costing the caller a call per datagram plus one
+//
+int UDPSocket::ReceiveBatch(UDPDatagram_t* datagrams, int maxDatagramCount)
+{
+	if (IsClosed())
+	{
+		LogTaggedPrintf("NET", "Error: UDPSocket::ReceiveBatch() called on a closed UDPSocket.");
+		return 0;
+	}
+
+	SOCKET sock = (SOCKET)m_socketHandle;
+
+	int numReceived = 0;
+	while (numReceived < maxDatagramCount)
+	{
+		UDPDatagram_t& datagram = datagrams[numReceived];
+
+		sockaddr_storage fromAddr;
+		int addrLen = sizeof(sockaddr_storage);
+
+		int received = ::recvfrom(sock, (char*)datagram.buffer, (int)datagram.bufferSize, 0, (sockaddr*)&fromAddr, &addrLen);
+
+		if (received > 0)
+		{
+			datagram.address = NetAddress_t((sockaddr*)&fromAddr);
+			datagram.byteCount = (size_t)received;
+			numReceived++;
+		}
+		else
+		{
+			int errorCode;
+			if (WasLastErrorFatal(errorCode))
+			{
+				Close();
+				break;
+			}
+
+			// Oversized datagrams and resets from an earlier send are skipped, would block means it's empty
+			if (errorCode == WSAEWOULDBLOCK)
+			{
+				break;
+			}
+		}
+	}
+
+	return numReceived;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Blocks until a datagram is ready to be read or the timeout passes, returning true if one is ready
+// Lets a receive loop sleep between datagrams instead of polling the non-blocking socket
+//
+bool UDPSocket::WaitForReceive(unsigned int timeoutMilliseconds) const
+{
+	if (IsClosed())
+	{
+		return false;
+	}
+
+	SOCKET sock = (SOCKET)m_socketHandle;
+
+	fd_set readSet;
+	FD_ZERO(&readSet);
+	FD_SET(sock, &readSet);
+
+	timeval timeout;
+	timeout.tv_sec = (long)(timeoutMilliseconds / 1000);
+	timeout.tv_usec = (long)((timeoutMilliseconds % 1000) * 1000);
+
+	// First parameter is ignored on Windows
+	int result = ::select(0, &readSet, nullptr, nullptr, &timeout);
+
+	return (result > 0);
+}
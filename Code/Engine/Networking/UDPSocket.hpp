@@ -7,6 +7,15 @@
 #pragma once
 #include "Engine/Networking/Socket.hpp"
 
+// One datagram of a batched send or receive
+struct UDPDatagram_t
+{
+	NetAddress_t	address;				// Send: where to send to, Receive: who sent it
+	void*			buffer = nullptr;		// Send: the data to send, Receive: where to read into
+	size_t			bufferSize = 0;			// Receive only, the most that can be read into buffer
+	size_t			byteCount = 0;			// Send: bytes to send, Receive: bytes received
+};
+
 class UDPSocket : public Socket
 {
 public:
@@ -20,4 +29,10 @@ public:
 	size_t SendTo(NetAddress_t const &addr, void const *data, size_t const byte_count);
 	size_t ReceiveFrom(NetAddress_t *out_addr, void *buffer, size_t const max_read_size);
 
+	// Batches - return how many datagrams were sent/received, stopping early if the socket runs dry or closes
+	int SendBatch(const UDPDatagram_t* datagrams, int datagramCount);
+	int ReceiveBatch(UDPDatagram_t* datagrams, int maxDatagramCount);
+
+	bool WaitForReceive(unsigned int timeoutMilliseconds) const;	// True if a datagram is ready to be read
+
 };
@@ -0,0 +1,504 @@
+/************************************************************************/
+/* File: AnimationBlendTree.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the AnimationBlendTree and BoneMask classes
+/************************************************************************/
+#include <math.h>
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/Animation/Pose.hpp"
+#include "Engine/Rendering/Animation/Skeleton.hpp"
+#include "Engine/Rendering/Animation/AnimationClip.hpp"
+#include "Engine/Rendering/Animation/AnimationBlendTree.hpp"
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Moves the normalized phase forward by the delta, wrapping it back into [0, 1)
+//
+static float AdvancePhase(float phase, float deltaSeconds, float durationSeconds)
+{
+	if (durationSeconds <= 0.f)
+	{
+		return 0.f;
+	}
+
+	phase += deltaSeconds / durationSeconds;
+	return phase - floorf(phase);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - every bone starts at the default weight
+//
+BoneMask::BoneMask(const Skeleton* skeleton, float defaultWeight /*= 0.f*/)
+	: m_skeleton(skeleton)
+{
+	m_boneWeights.resize(skeleton->GetBoneCount(), defaultWeight);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the weight of only the given bone
+//
+void BoneMask::SetBoneWeight(unsigned int boneIndex, float weight)
+{
+	ASSERT_OR_DIE(boneIndex < m_boneWeights.size(), Stringf("Error: BoneMask::SetBoneWeight received index out of range, index was %u", boneIndex));
+	m_boneWeights[boneIndex] = weight;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the weight of the bone and everything parented under it
+// Parents always come before their children, so one pass forward finds the whole chain
+//
+void BoneMask::SetBoneAndChildrenWeight(unsigned int boneIndex, float weight)
+{
+	ASSERT_OR_DIE(boneIndex < m_boneWeights.size(), Stringf("Error: BoneMask::SetBoneAndChildrenWeight received index out of range, index was %u", boneIndex));
+
+	unsigned int boneCount = (unsigned int) m_boneWeights.size();
+	std::vector<bool> isInChain(boneCount, false);
+
+	isInChain[boneIndex] = true;
+	m_boneWeights[boneIndex] = weight;
+
+	for (unsigned int childIndex = boneIndex + 1; childIndex < boneCount; ++childIndex)
+	{
+		int parentIndex = m_skeleton->GetBoneData(childIndex).parentIndex;
+
+		if (parentIndex >= 0 && isInChain[parentIndex])
+		{
+			isInChain[childIndex] = true;
+			m_boneWeights[childIndex] = weight;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the weight of the bone with the given name and everything parented under it
+//
+bool BoneMask::SetBoneAndChildrenWeight(const std::string& boneName, float weight)
+{
+	int boneIndex = m_skeleton->GetBoneMapping(boneName);
+
+	if (boneIndex < 0)
+	{
+		return false;
+	}
+
+	SetBoneAndChildrenWeight((unsigned int) boneIndex, weight);
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the weight of the bone at the given index
+//
+float BoneMask::GetBoneWeight(unsigned int boneIndex) const
+{
+	return m_boneWeights[boneIndex];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the weights of all bones, in skeleton order
+//
+const float* BoneMask::GetBoneWeights() const
+{
+	return m_boneWeights.data();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of bones the mask has weights for
+//
+unsigned int BoneMask::GetBoneCount() const
+{
+	return (unsigned int) m_boneWeights.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+AnimationBlendTree::~AnimationBlendTree()
+{
+	for (int stackIndex = 0; stackIndex < (int) m_poseStack.size(); ++stackIndex)
+	{
+		delete m_poseStack[stackIndex];
+	}
+
+	m_poseStack.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a parameter for blend and layer nodes to be driven by
+//
+int AnimationBlendTree::AddParameter(const std::string& name, float defaultValue /*= 0.f*/)
+{
+	ASSERT_OR_DIE(GetParameterIndex(name) == BLEND_TREE_INVALID_INDEX, Stringf("Error: AnimationBlendTree::AddParameter called twice for parameter \"%s\"", name.c_str()));
+
+	m_parameterNames.push_back(name);
+	m_parameterValues.push_back(defaultValue);
+
+	return (int) m_parameterValues.size() - 1;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a node that plays the clip, looping; the rate is ignored under a blend, which keeps its
+// children in step instead
+//
+int AnimationBlendTree::AddClipNode(AnimationClip* clip, float playbackRate /*= 1.f*/)
+{
+	ASSERT_OR_DIE(clip != nullptr && playbackRate > 0.f, "Error: AnimationBlendTree::AddClipNode received a null clip or non-positive playback rate");
+
+	BlendNode_t node;
+	node.type = BLEND_NODE_CLIP;
+	node.clip = clip;
+	node.playbackRate = playbackRate;
+
+	m_nodes.push_back(node);
+	return (int) m_nodes.size() - 1;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a 1D blend space driven by the parameter, with no children yet
+//
+int AnimationBlendTree::AddBlend1DNode(int parameterIndex)
+{
+	ASSERT_OR_DIE(parameterIndex >= 0 && parameterIndex < (int) m_parameterValues.size(), Stringf("Error: AnimationBlendTree::AddBlend1DNode received invalid parameter index %i", parameterIndex));
+
+	BlendNode_t node;
+	node.type = BLEND_NODE_BLEND_1D;
+	node.parameterIndex = parameterIndex;
+
+	m_nodes.push_back(node);
+	return (int) m_nodes.size() - 1;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a child to the blend space, played alone when the parameter is at the threshold
+//
+void AnimationBlendTree::AddBlend1DChild(int blendNodeIndex, int childNodeIndex, float threshold)
+{
+	ASSERT_OR_DIE(blendNodeIndex >= 0 && blendNodeIndex < (int) m_nodes.size() && m_nodes[blendNodeIndex].type == BLEND_NODE_BLEND_1D, Stringf("Error: AnimationBlendTree::AddBlend1DChild received invalid blend node %i", blendNodeIndex));
+	ASSERT_OR_DIE(childNodeIndex >= 0 && childNodeIndex < (int) m_nodes.size() && childNodeIndex != blendNodeIndex, Stringf("Error: AnimationBlendTree::AddBlend1DChild received invalid child node %i", childNodeIndex));
+
+	BlendChild_t child;
+	child.nodeIndex = childNodeIndex;
+	child.threshold = threshold;
+
+	// Kept sorted, so evaluating only has to find the pair around the parameter
+	std::vector<BlendChild_t>& children = m_nodes[blendNodeIndex].children;
+
+	std::vector<BlendChild_t>::iterator itr = children.begin();
+	while (itr != children.end() && itr->threshold <= threshold)
+	{
+		++itr;
+	}
+
+	children.insert(itr, child);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a node that plays the layer over the base, by the parameter's weight scaled by the mask
+//
+int AnimationBlendTree::AddLayerNode(int baseNodeIndex, int layerNodeIndex, int weightParameterIndex, const BoneMask* mask /*= nullptr*/)
+{
+	ASSERT_OR_DIE(baseNodeIndex >= 0 && baseNodeIndex < (int) m_nodes.size() && layerNodeIndex >= 0 && layerNodeIndex < (int) m_nodes.size(),
+		Stringf("Error: AnimationBlendTree::AddLayerNode received invalid nodes %i and %i", baseNodeIndex, layerNodeIndex));
+	ASSERT_OR_DIE(weightParameterIndex >= 0 && weightParameterIndex < (int) m_parameterValues.size(), Stringf("Error: AnimationBlendTree::AddLayerNode received invalid parameter index %i", weightParameterIndex));
+
+	BlendNode_t node;
+	node.type = BLEND_NODE_LAYER;
+	node.baseNodeIndex = baseNodeIndex;
+	node.layerNodeIndex = layerNodeIndex;
+	node.parameterIndex = weightParameterIndex;
+	node.mask = mask;
+
+	m_nodes.push_back(node);
+	return (int) m_nodes.size() - 1;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the node the tree is evaluated from
+//
+void AnimationBlendTree::SetRootNode(int nodeIndex)
+{
+	ASSERT_OR_DIE(nodeIndex >= 0 && nodeIndex < (int) m_nodes.size(), Stringf("Error: AnimationBlendTree::SetRootNode received invalid node %i", nodeIndex));
+	m_rootNodeIndex = nodeIndex;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the value of the parameter at the given index
+//
+void AnimationBlendTree::SetParameter(int parameterIndex, float value)
+{
+	ASSERT_OR_DIE(parameterIndex >= 0 && parameterIndex < (int) m_parameterValues.size(), Stringf("Error: AnimationBlendTree::SetParameter received invalid parameter index %i", parameterIndex));
+	m_parameterValues[parameterIndex] = value;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the value of the parameter with the given name, prefer the index version every frame
+//
+bool AnimationBlendTree::SetParameter(const std::string& name, float value)
+{
+	int parameterIndex = GetParameterIndex(name);
+
+	if (parameterIndex == BLEND_TREE_INVALID_INDEX)
+	{
+		return false;
+	}
+
+	m_parameterValues[parameterIndex] = value;
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the value of the parameter at the given index
+//
+float AnimationBlendTree::GetParameter(int parameterIndex) const
+{
+	return m_parameterValues[parameterIndex];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the index of the parameter with the given name, BLEND_TREE_INVALID_INDEX if there isn't one
+//
+int AnimationBlendTree::GetParameterIndex(const std::string& name) const
+{
+	for (int parameterIndex = 0; parameterIndex < (int) m_parameterNames.size(); ++parameterIndex)
+	{
+		if (m_parameterNames[parameterIndex] == name)
+		{
+			return parameterIndex;
+		}
+	}
+
+	return BLEND_TREE_INVALID_INDEX;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Advances every weighted node by the time since the last call and blends them into out_pose
+// Blends only touch the bones' local parts, the world matrices are built once at the end
+//
+void AnimationBlendTree::Evaluate(float timeSeconds, Pose& out_pose)
+{
+	ASSERT_OR_DIE(m_rootNodeIndex != BLEND_TREE_INVALID_INDEX, "Error: AnimationBlendTree::Evaluate called on a tree with no root node");
+
+	float deltaSeconds = (m_hasLastTime ? timeSeconds - m_lastTimeSeconds : 0.f);
+	if (deltaSeconds < 0.f)
+	{
+		deltaSeconds = 0.f;
+	}
+
+	m_lastTimeSeconds = timeSeconds;
+	m_hasLastTime = true;
+	m_clipsSampled = 0;
+
+	EvaluateNode(m_rootNodeIndex, deltaSeconds, -1.f, out_pose, 0);
+	out_pose.ConstructWorldMatricesFromLocalParts();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Makes the next Evaluate() start from where the nodes are without advancing them
+//
+void AnimationBlendTree::ResetTime()
+{
+	m_hasLastTime = false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of nodes in the tree
+//
+int AnimationBlendTree::GetNodeCount() const
+{
+	return (int) m_nodes.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns how many clips the last Evaluate() sampled, the rest were pruned for having no weight
+//
+int AnimationBlendTree::GetClipsSampledLastEvaluate() const
+{
+	return m_clipsSampled;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Evaluates the node's local parts into out_pose, which is the first child's output as well, so each
+// level of nesting only needs one more pose off the stack for the child blended into it
+// syncedPhase is the phase a parent blend has its children play at, or negative to use the node's own
+//
+void AnimationBlendTree::EvaluateNode(int nodeIndex, float deltaSeconds, float syncedPhase, Pose& out_pose, int stackDepth)
+{
+	BlendNode_t& node = m_nodes[nodeIndex];
+
+	switch (node.type)
+	{
+	case BLEND_NODE_CLIP:
+	{
+		node.phase = (syncedPhase >= 0.f ? syncedPhase : AdvancePhase(node.phase, deltaSeconds, GetNodeDurationSeconds(nodeIndex)));
+
+		node.clip->CalculateLocalPoseAtNormalizedTime(node.phase, out_pose);
+		m_clipsSampled++;
+	}
+	break;
+	case BLEND_NODE_BLEND_1D:
+	{
+		int firstChild, secondChild;
+		float fractionTowardSecond;
+		GetBlend1DWeights(node, firstChild, secondChild, fractionTowardSecond);
+
+		int firstNodeIndex = node.children[firstChild].nodeIndex;
+		int secondNodeIndex = node.children[secondChild].nodeIndex;
+
+		// Children play at one phase at the blended length, so a walk and a run stay in step
+		if (syncedPhase >= 0.f)
+		{
+			node.phase = syncedPhase;
+		}
+		else
+		{
+			float durationSeconds = Interpolate(GetNodeDurationSeconds(firstNodeIndex), GetNodeDurationSeconds(secondNodeIndex), fractionTowardSecond);
+			node.phase = AdvancePhase(node.phase, deltaSeconds, durationSeconds);
+		}
+
+		EvaluateNode(firstNodeIndex, deltaSeconds, node.phase, out_pose, stackDepth);
+
+		if (fractionTowardSecond > 0.f)
+		{
+			Pose* secondPose = GetStackPose(stackDepth);
+			secondPose->SetLOD(out_pose.GetLOD());
+			EvaluateNode(secondNodeIndex, deltaSeconds, node.phase, *secondPose, stackDepth + 1);
+
+			out_pose.SetLocalPartsToBlend(out_pose, *secondPose, fractionTowardSecond);
+		}
+	}
+	break;
+	case BLEND_NODE_LAYER:
+	{
+		EvaluateNode(node.baseNodeIndex, deltaSeconds, syncedPhase, out_pose, stackDepth);
+
+		float weight = ClampFloatZeroToOne(m_parameterValues[node.parameterIndex]);
+
+		// The layer keeps its own phase, an upper-body action shouldn't be stretched to the legs' cycle
+		if (weight > 0.f)
+		{
+			Pose* layerPose = GetStackPose(stackDepth);
+			layerPose->SetLOD(out_pose.GetLOD());
+			EvaluateNode(node.layerNodeIndex, deltaSeconds, -1.f, *layerPose, stackDepth + 1);
+
+			if (node.mask != nullptr)
+			{
+				ASSERT_OR_DIE(node.mask->GetBoneCount() == out_pose.GetBoneCount(), Stringf("Error: AnimationBlendTree layer mask has %u bones, pose has %u", node.mask->GetBoneCount(), out_pose.GetBoneCount()));
+				out_pose.SetLocalPartsToMaskedBlend(out_pose, *layerPose, weight, node.mask->GetBoneWeights());
+			}
+			else
+			{
+				out_pose.SetLocalPartsToBlend(out_pose, *layerPose, weight);
+			}
+		}
+	}
+	break;
+	default:
+		ERROR_AND_DIE(Stringf("Error: AnimationBlendTree::EvaluateNode found node of unknown type %i", (int) node.type));
+		break;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the length of one cycle of the node at its current weights
+//
+float AnimationBlendTree::GetNodeDurationSeconds(int nodeIndex) const
+{
+	const BlendNode_t& node = m_nodes[nodeIndex];
+
+	switch (node.type)
+	{
+	case BLEND_NODE_CLIP:
+		return node.clip->GetTotalDurationSeconds() / node.playbackRate;
+	case BLEND_NODE_BLEND_1D:
+	{
+		int firstChild, secondChild;
+		float fractionTowardSecond;
+		GetBlend1DWeights(node, firstChild, secondChild, fractionTowardSecond);
+
+		return Interpolate(GetNodeDurationSeconds(node.children[firstChild].nodeIndex), GetNodeDurationSeconds(node.children[secondChild].nodeIndex), fractionTowardSecond);
+	}
+	case BLEND_NODE_LAYER:
+		return GetNodeDurationSeconds(node.baseNodeIndex);
+	default:
+		return 0.f;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds the two children around the parameter's value and how far it is from the first to the second
+// Outside the thresholds, or right on one, the fraction is 0 so only one child is played
+//
+void AnimationBlendTree::GetBlend1DWeights(const BlendNode_t& node, int& out_firstChild, int& out_secondChild, float& out_fractionTowardSecond) const
+{
+	ASSERT_OR_DIE(node.children.size() > 0, "Error: AnimationBlendTree blend node has no children");
+
+	float value = m_parameterValues[node.parameterIndex];
+	int lastChild = (int) node.children.size() - 1;
+
+	out_fractionTowardSecond = 0.f;
+
+	if (value <= node.children[0].threshold)
+	{
+		out_firstChild = out_secondChild = 0;
+		return;
+	}
+
+	if (value >= node.children[lastChild].threshold)
+	{
+		out_firstChild = out_secondChild = lastChild;
+		return;
+	}
+
+	int firstChild = 0;
+	while (node.children[firstChild + 1].threshold <= value)
+	{
+		firstChild++;
+	}
+
+	float firstThreshold = node.children[firstChild].threshold;
+	float secondThreshold = node.children[firstChild + 1].threshold;
+
+	out_firstChild = firstChild;
+	out_secondChild = firstChild + 1;
+	out_fractionTowardSecond = (value - firstThreshold) / (secondThreshold - firstThreshold);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the scratch pose for the given nesting level, the clips set it up for their skeleton
+//
+Pose* AnimationBlendTree::GetStackPose(int stackDepth)
+{
+	while ((int) m_poseStack.size() <= stackDepth)
+	{
+		m_poseStack.push_back(new Pose());
+	}
+
+	return m_poseStack[stackDepth];
+}
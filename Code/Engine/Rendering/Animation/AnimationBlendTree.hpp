@@ -0,0 +1,138 @@
+/************************************************************************/
+/* File: AnimationBlendTree.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Graph of clips, 1D blend spaces and masked override layers,
+/*				evaluated in place on a small stack of reused poses - only
+/*				branches with weight are sampled, and only their local
+/*				parts are blended, with the world matrices built once
+/************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+
+class Pose;
+class Skeleton;
+class AnimationClip;
+
+#define BLEND_TREE_INVALID_INDEX (-1)
+
+enum eBlendNodeType
+{
+	BLEND_NODE_CLIP,
+	BLEND_NODE_BLEND_1D,		// Two children around a parameter's value, by the children's thresholds
+	BLEND_NODE_LAYER			// A layer over a base, weighted by a parameter and scaled per bone by a mask
+};
+
+// Weight per bone for a layer, i.e. 1 on the spine and arms for an upper-body override
+class BoneMask
+{
+public:
+	//-----Public Methods-----
+
+	BoneMask() {}
+	BoneMask(const Skeleton* skeleton, float defaultWeight = 0.f);
+
+	void			SetBoneWeight(unsigned int boneIndex, float weight);
+	void			SetBoneAndChildrenWeight(unsigned int boneIndex, float weight);		// The whole chain below it too
+	bool			SetBoneAndChildrenWeight(const std::string& boneName, float weight);	// False if the skeleton has no such bone
+
+	float			GetBoneWeight(unsigned int boneIndex) const;
+	const float*	GetBoneWeights() const;
+	unsigned int	GetBoneCount() const;
+
+
+private:
+	//-----Private Data-----
+
+	const Skeleton*		m_skeleton = nullptr;
+	std::vector<float>	m_boneWeights;
+
+};
+
+struct BlendChild_t
+{
+	int		nodeIndex = BLEND_TREE_INVALID_INDEX;
+	float	threshold = 0.f;		// Parameter value at which this child is played alone
+};
+
+struct BlendNode_t
+{
+	eBlendNodeType				type = BLEND_NODE_CLIP;
+
+	// Clip
+	AnimationClip*				clip = nullptr;
+	float						playbackRate = 1.f;
+
+	// Blend 1D, children sorted by threshold
+	std::vector<BlendChild_t>	children;
+	int							parameterIndex = BLEND_TREE_INVALID_INDEX;
+
+	// Layer, weighted by parameterIndex
+	int							baseNodeIndex = BLEND_TREE_INVALID_INDEX;
+	int							layerNodeIndex = BLEND_TREE_INVALID_INDEX;
+	const BoneMask*				mask = nullptr;		// Not owned, nullptr to layer every bone
+
+	// Normalized playback position, advanced only while the node has weight
+	float						phase = 0.f;
+};
+
+
+class AnimationBlendTree
+{
+public:
+	//-----Public Methods-----
+
+	AnimationBlendTree() {}
+	~AnimationBlendTree();
+	AnimationBlendTree(const AnimationBlendTree& copy) = delete;
+
+	// Building - each returns the index of what was added
+	int				AddParameter(const std::string& name, float defaultValue = 0.f);
+	int				AddClipNode(AnimationClip* clip, float playbackRate = 1.f);
+	int				AddBlend1DNode(int parameterIndex);
+	void			AddBlend1DChild(int blendNodeIndex, int childNodeIndex, float threshold);
+	int				AddLayerNode(int baseNodeIndex, int layerNodeIndex, int weightParameterIndex, const BoneMask* mask = nullptr);
+	void			SetRootNode(int nodeIndex);
+
+	// Parameters
+	void			SetParameter(int parameterIndex, float value);
+	bool			SetParameter(const std::string& name, float value);		// False if there's no such parameter
+	float			GetParameter(int parameterIndex) const;
+	int				GetParameterIndex(const std::string& name) const;
+
+	// Advances the tree to the given time and evaluates it into out_pose, world matrices included
+	// Deltas come from consecutive times, so call ResetTime() when restarting the clock driving it
+	void			Evaluate(float timeSeconds, Pose& out_pose);
+	void			ResetTime();
+
+	int				GetNodeCount() const;
+	int				GetClipsSampledLastEvaluate() const;
+
+
+private:
+	//-----Private Methods-----
+
+	void			EvaluateNode(int nodeIndex, float deltaSeconds, float syncedPhase, Pose& out_pose, int stackDepth);
+	float			GetNodeDurationSeconds(int nodeIndex) const;
+	void			GetBlend1DWeights(const BlendNode_t& node, int& out_firstChild, int& out_secondChild, float& out_fractionTowardSecond) const;
+	Pose*			GetStackPose(int stackDepth);
+
+
+private:
+	//-----Private Data-----
+
+	std::vector<BlendNode_t>	m_nodes;
+	int							m_rootNodeIndex = BLEND_TREE_INVALID_INDEX;
+
+	std::vector<std::string>	m_parameterNames;
+	std::vector<float>			m_parameterValues;
+
+	// Scratch poses for the children being blended in, one per level of nesting; only grows
+	std::vector<Pose*>			m_poseStack;
+
+	float						m_lastTimeSeconds = 0.f;
+	bool						m_hasLastTime = false;
+	int							m_clipsSampled = 0;
+
+};
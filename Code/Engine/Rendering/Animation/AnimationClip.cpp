@@ -1,12 +1,28 @@
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Rendering/Animation/Pose.hpp"
 #include "Engine/Rendering/Animation/AnimationClip.hpp"
 #include "Engine/Rendering/Animation/Skeleton.hpp"
 
 
+AnimationClip::~AnimationClip()
+{
+	delete[] m_poses;
+	m_poses = nullptr;
+
+	delete m_compressedAnimation;
+	m_compressedAnimation = nullptr;
+}
+
 void AnimationClip::Initialize(unsigned int numPoses, const Skeleton* skeleton, float framesPerSecond)
 {
-	m_poses = (Pose*) malloc(sizeof(Pose) * numPoses);
+	// Constructed, so the poses start empty and Initialize can tell they have no buffers yet
+	delete[] m_poses;
+	m_poses = new Pose[numPoses];
+
+	delete m_compressedAnimation;
+	m_compressedAnimation = nullptr;
 	m_numPoses = numPoses;
 
 	m_baseSkeleton = skeleton;
@@ -15,7 +31,7 @@ void AnimationClip::Initialize(unsigned int numPoses, const Skeleton* skeleton,
 	m_durationSeconds = numPoses * m_frameDuration;
 }
 
-Pose* AnimationClip::CalculatePoseAtTime(float t) const
+void AnimationClip::CalculatePoseAtTime(float t, Pose& out_pose) const
 {
 	while (t >= m_durationSeconds)
 	{
@@ -24,15 +40,30 @@ Pose* AnimationClip::CalculatePoseAtTime(float t) const
 
 	float normalizedTime = RangeMapFloat(t, 0.f, GetTotalDurationSeconds(), 0.f, 1.f);
 
-	return CalculatePoseAtNormalizedTime(normalizedTime);
+	CalculatePoseAtNormalizedTime(normalizedTime, out_pose);
+}
+
+Pose* AnimationClip::CalculatePoseAtTime(float t) const
+{
+	Pose* result = new Pose();
+	CalculatePoseAtTime(t, *result);
+
+	return result;
 }
 
 Pose* AnimationClip::GetPoseAtIndex(unsigned int poseIndex)
 {
+	ASSERT_OR_DIE(m_compressedAnimation == nullptr, Stringf("Error: AnimationClip::GetPoseAtIndex called on compressed clip \"%s\"", m_name.c_str()));
 	return &m_poses[poseIndex];
 }
 #include "Engine/Core/EngineCommon.hpp"
-Pose* AnimationClip::CalculatePoseAtNormalizedTime(float t) const
+void AnimationClip::CalculatePoseAtNormalizedTime(float t, Pose& out_pose) const
+{
+	CalculateLocalPoseAtNormalizedTime(t, out_pose);
+	out_pose.ConstructWorldMatricesFromLocalParts();
+}
+
+void AnimationClip::CalculateLocalPoseAtNormalizedTime(float t, Pose& out_pose) const
 {
 	// Loop the animation for now
 	while (t >= 1.0f)
@@ -42,6 +73,17 @@ Pose* AnimationClip::CalculatePoseAtNormalizedTime(float t) const
 
 	int numPoses = GetPoseCount();
 
+	if (m_compressedAnimation != nullptr)
+	{
+		if (out_pose.GetSkeleton() != m_baseSkeleton || out_pose.GetBoneCount() != m_compressedAnimation->GetBoneCount())
+		{
+			out_pose.Initialize(m_baseSkeleton);
+		}
+
+		m_compressedAnimation->SampleLocalPose(t * numPoses, out_pose);
+		return;
+	}
+
 	float timeIntoAnimation = (t * m_durationSeconds);
 
 	int firstPoseIndex = (int) (t * numPoses);
@@ -51,7 +93,15 @@ Pose* AnimationClip::CalculatePoseAtNormalizedTime(float t) const
 	//ASSERT_OR_DIE(currentTime <= timeIntoAnimation, "Error: current was over t");
 
 	float interpolationValue = (timeIntoAnimation - currentTime) / (m_durationSeconds / m_numPoses);
-	return CalcuateInterpolatedPose(firstPoseIndex, secondPoseIndex, interpolationValue);
+	CalculateInterpolatedLocalPose(firstPoseIndex, secondPoseIndex, interpolationValue, out_pose);
+}
+
+Pose* AnimationClip::CalculatePoseAtNormalizedTime(float t) const
+{
+	Pose* result = new Pose();
+	CalculatePoseAtNormalizedTime(t, *result);
+
+	return result;
 }
 
 int AnimationClip::GetPoseCount() const
@@ -70,11 +120,46 @@ float AnimationClip::GetFrameDurationSeconds() const
 	return m_frameDuration;
 }
 
+const std::string& AnimationClip::GetName() const
+{
+	return m_name;
+}
+
+const Skeleton* AnimationClip::GetSkeleton() const
+{
+	return m_baseSkeleton;
+}
+
 void AnimationClip::SetName(const std::string& name)
 {
 	m_name = name;
 }
 
+void AnimationClip::Compress(const AnimationCompressionSettings_t& settings)
+{
+	if (m_compressedAnimation != nullptr || m_numPoses == 0)
+	{
+		return;
+	}
+
+	unsigned int boneCount = m_poses[0].GetBoneCount();
+	size_t poseBytes = (size_t) m_numPoses * boneCount * (sizeof(Matrix44) + sizeof(Quaternion) + 2 * sizeof(Vector3));
+
+	m_compressedAnimation = new CompressedAnimation();
+	m_compressedAnimation->Build(m_poses, m_numPoses, settings);
+
+	delete[] m_poses;
+	m_poses = nullptr;
+
+	LogTaggedPrintf("ANIMATION", "Compressed clip \"%s\" from %u to %u bytes, %i keys for %u poses of %u bones",
+		m_name.c_str(), (unsigned int) poseBytes, (unsigned int) m_compressedAnimation->GetSizeBytes(), m_compressedAnimation->GetKeyCount(), m_numPoses, boneCount);
+}
+
+bool AnimationClip::IsCompressed() const
+{
+	return (m_compressedAnimation != nullptr);
+}
+
 // void AnimationClip::SetFramesPerSecond(float framesPerSecond)
 // {
 // 	m_framesPerSecond = framesPerSecond;
@@ -85,23 +170,16 @@ void AnimationClip::SetName(const std::string& name)
 // 	m_durationSeconds = durationSeconds;
 // }
 
-Pose* AnimationClip::CalcuateInterpolatedPose(unsigned int firstPoseIndex, unsigned int secondPoseIndex, float t) const
+void AnimationClip::CalculateInterpolatedLocalPose(unsigned int firstPoseIndex, unsigned int secondPoseIndex, float t, Pose& out_pose) const
 {
 	Pose* firstPose = &m_poses[firstPoseIndex];
 	Pose* secondPose = &m_poses[secondPoseIndex];
-	unsigned int transformCount = firstPose->GetBoneCount();
-
-	Pose* result = new Pose();
-	result->Initialize(m_baseSkeleton);
 
-	for (unsigned int transformIndex = 0; transformIndex < transformCount; ++transformIndex)
+	// The blend overwrites every bone, so a pose already set up for this skeleton is used as is
+	if (out_pose.GetSkeleton() != m_baseSkeleton || out_pose.GetBoneCount() != firstPose->GetBoneCount())
 	{
-		Matrix44 firstTransfrom = firstPose->GetBoneTransform(transformIndex);
-		Matrix44 secondTransfrom = secondPose->GetBoneTransform(transformIndex);
-
-		Matrix44 finalTransform = Interpolate(firstTransfrom, secondTransfrom, t);
-		result->SetBoneTransform(transformIndex, finalTransform);
+		out_pose.Initialize(m_baseSkeleton);
 	}
 
-	return result;
+	out_pose.SetLocalPartsToBlend(*firstPose, *secondPose, t);
 }
@@ -1,26 +1,46 @@
 #pragma once
+#include <string>
 #include <vector>
 #include "Engine/Rendering/Animation/Pose.hpp"
+#include "Engine/Rendering/Animation/CompressedAnimation.hpp"
 
 class AnimationClip
 {
 public:
 	//-----Public Methods-----
 
+	AnimationClip() {}
+	~AnimationClip();
+
 	void Initialize(unsigned int numPoses, const Skeleton* skeleton, float framesPerSecond);
 
 	// Accessors
 	Pose*	GetPoseAtIndex(unsigned int poseIndex);
+
+	// Samples into the given pose, which keeps its buffers between calls - use these every frame
+	void	CalculatePoseAtTime(float t, Pose& out_pose) const;
+	void	CalculatePoseAtNormalizedTime(float t, Pose& out_pose) const;
+
+	// Only the bones' local parts, for blending with other clips before the world matrices are built once
+	void	CalculateLocalPoseAtNormalizedTime(float t, Pose& out_pose) const;
+
+	// Allocates a new pose for the caller to delete
 	Pose*	CalculatePoseAtTime(float t) const;
 	Pose*	CalculatePoseAtNormalizedTime(float t) const;
 
 	int		GetPoseCount() const;
 	float	GetTotalDurationSeconds() const;
 	float	GetFrameDurationSeconds() const;
+	const std::string& GetName() const;
+	const Skeleton* GetSkeleton() const;
 
 	
 	// Mutators
 	void SetName(const std::string& name);
+
+	// Replaces the poses with per bone tracks, freeing them - sampling still works, GetPoseAtIndex() doesn't
+	void Compress(const AnimationCompressionSettings_t& settings = AnimationCompressionSettings_t());
+	bool IsCompressed() const;
 	//void SetFramesPerSecond(float framesPerSecond);
 	//void SetDurationSeconds(float durationSeconds);
 
@@ -28,7 +48,7 @@ public:
 private:
 	//-----Private Methods-----
 
-	Pose* CalcuateInterpolatedPose(unsigned int firstPoseIndex, unsigned int secondPoseIndex, float t) const;
+	void CalculateInterpolatedLocalPose(unsigned int firstPoseIndex, unsigned int secondPoseIndex, float t, Pose& out_pose) const;
 
 
 private:
@@ -39,6 +59,8 @@ private:
 	Pose* m_poses = nullptr;
 	unsigned int m_numPoses;
 
+	CompressedAnimation* m_compressedAnimation = nullptr;	// Once compressed, in place of m_poses
+
 	float m_durationSeconds;
 	float m_framesPerSecond;
 	float m_frameDuration;
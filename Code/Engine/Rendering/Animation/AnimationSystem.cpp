@@ -0,0 +1,424 @@
+/************************************************************************/
+/* File: AnimationSystem.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the AnimationSystem singleton class
+/************************************************************************/
+#include <algorithm>
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/JobSystem/ParallelFor.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
+#include "Engine/Rendering/Core/Renderer.hpp"
+#include "Engine/Rendering/Animation/Animator.hpp"
+#include "Engine/Rendering/Animation/AnimationSystem.hpp"
+
+// Singleton instance
+AnimationSystem* AnimationSystem::s_instance = nullptr;
+
+
+//-----------------------------------------------------------------------------------------------
+// Creates the singleton instance
+//
+void AnimationSystem::Initialize()
+{
+	ASSERT_OR_DIE(s_instance == nullptr, "AnimationSystem::Initialize() called twice!");
+	s_instance = new AnimationSystem();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes the singleton instance
+//
+void AnimationSystem::Shutdown()
+{
+	if (s_instance != nullptr)
+	{
+		delete s_instance;
+		s_instance = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the singleton instance
+//
+AnimationSystem* AnimationSystem::GetInstance()
+{
+	return s_instance;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Registers the animator to be updated each frame
+//
+void AnimationSystem::AddAnimator(Animator* animator)
+{
+	ASSERT_OR_DIE(std::find(m_animators.begin(), m_animators.end(), animator) == m_animators.end(), "Error: AnimationSystem::AddAnimator called on an animator already added");
+	m_animators.push_back(animator);
+
+	AnimatorLODState_t lodState;
+	lodState.updateOffset = m_nextUpdateOffset++;
+
+	m_lodStates.push_back(lodState);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stops updating the animator, order of the rest doesn't matter so it's swapped out
+//
+void AnimationSystem::RemoveAnimator(Animator* animator)
+{
+	std::vector<Animator*>::iterator itr = std::find(m_animators.begin(), m_animators.end(), animator);
+
+	if (itr != m_animators.end())
+	{
+		animator->SetSkinningPaletteOffset(-1);
+		animator->SetPoseSource(nullptr);
+
+		// Anything sharing its pose has none until the next update
+		for (Animator* otherAnimator : m_animators)
+		{
+			if (otherAnimator->GetPoseSource() == animator)
+			{
+				otherAnimator->SetPoseSource(nullptr);
+				otherAnimator->SetSkinningPaletteOffset(-1);
+			}
+		}
+
+		int animatorIndex = (int) (itr - m_animators.begin());
+
+		*itr = m_animators.back();
+		m_animators.pop_back();
+
+		m_lodStates[animatorIndex] = m_lodStates.back();
+		m_lodStates.pop_back();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of animators being updated
+//
+int AnimationSystem::GetAnimatorCount() const
+{
+	return (int) m_animators.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Updates every animator - each only touches its own poses and reads the clips, so they run
+// as independent jobs; within one the bones stay serial, since every child needs its parent
+// Far animators only update every few frames, blending their last two updates in between
+// Animators sharing poses are grouped first, so each group samples and skins once
+// The skinning matrices are written straight into the shared palette, then uploaded in one copy
+//
+void AnimationSystem::Update()
+{
+	PROFILE_SCOPE_CATEGORY("AnimationSystem::Update", "Animation");
+
+	int animatorCount = (int) m_animators.size();
+	m_frameNumber++;
+
+	// Pick the LODs and who updates this frame, cheap enough to not be worth a job
+	m_animatorsUpdated = 0;
+	m_poseShareEntries.clear();
+
+	for (int lod = 0; lod < ANIMATION_LOD_COUNT; ++lod)
+	{
+		m_lodCounts[lod] = 0;
+	}
+
+	for (int animatorIndex = 0; animatorIndex < animatorCount; ++animatorIndex)
+	{
+		Animator* animator = m_animators[animatorIndex];
+		AnimatorLODState_t& lodState = m_lodStates[animatorIndex];
+
+		int lod = CalculateLOD(animator);
+		if (lod != animator->GetLOD())
+		{
+			animator->SetLOD(lod);
+		}
+
+		int updateInterval = m_lodSettings.updateIntervals[lod];
+		lodState.poseSourceIndex = -1;
+		lodState.isSharingPose = false;
+
+		// Sharing animators update every frame, the sharing already makes them cheap
+		PoseShareEntry_t shareEntry;
+		if (animator->GetPoseShareKey(shareEntry.key))
+		{
+			shareEntry.animatorIndex = animatorIndex;
+			m_poseShareEntries.push_back(shareEntry);
+
+			lodState.isSharingPose = true;
+			updateInterval = 1;
+		}
+
+		if (updateInterval <= 1)
+		{
+			animator->ClearCachedSkinningMatrices();
+
+			lodState.isUpdatingThisFrame = true;
+			lodState.fractionTowardLatest = 1.f;
+		}
+		else
+		{
+			// Shows the previous update blending into the latest, so it's always one interval behind
+			int framesIntoInterval = (int) ((m_frameNumber + (unsigned int) lodState.updateOffset) % (unsigned int) updateInterval);
+
+			lodState.isUpdatingThisFrame = (framesIntoInterval == 0 || !animator->HasCachedSkinningMatrices());
+			lodState.fractionTowardLatest = (float) (framesIntoInterval + 1) / (float) updateInterval;
+		}
+
+		m_lodCounts[lod]++;
+	}
+
+	AssignPoseSources();
+
+	for (int animatorIndex = 0; animatorIndex < animatorCount; ++animatorIndex)
+	{
+		m_animatorsUpdated += (m_lodStates[animatorIndex].isUpdatingThisFrame ? 1 : 0);
+	}
+
+	ParallelFor(0, animatorCount, ANIMATORS_PER_JOB, [&](int animatorIndex)
+	{
+		Animator* animator = m_animators[animatorIndex];
+		const AnimatorLODState_t& lodState = m_lodStates[animatorIndex];
+
+		if (lodState.isUpdatingThisFrame)
+		{
+			animator->UpdatePose();
+
+			if (m_lodSettings.updateIntervals[animator->GetLOD()] > 1 && !lodState.isSharingPose)
+			{
+				animator->CacheSkinningMatrices();
+			}
+		}
+	});
+
+	// Bone counts are only known once the poses are sampled, so the offsets are assigned in between
+	// Animators sharing a pose share its range too, so their draws stay instanced with the group's
+	m_skinningPaletteSize = 0;
+
+	for (int animatorIndex = 0; animatorIndex < animatorCount; ++animatorIndex)
+	{
+		if (m_lodStates[animatorIndex].poseSourceIndex >= 0)
+		{
+			continue;
+		}
+
+		Animator* animator = m_animators[animatorIndex];
+		int matrixCount = (int) animator->GetSkinningMatrixCount();
+
+		animator->SetSkinningPaletteOffset(matrixCount > 0 ? m_skinningPaletteSize : -1);
+		m_skinningPaletteSize += matrixCount;
+	}
+
+	for (int animatorIndex = 0; animatorIndex < animatorCount; ++animatorIndex)
+	{
+		int sourceIndex = m_lodStates[animatorIndex].poseSourceIndex;
+
+		if (sourceIndex >= 0)
+		{
+			m_animators[animatorIndex]->SetSkinningPaletteOffset(m_animators[sourceIndex]->GetSkinningPaletteOffset());
+		}
+	}
+
+	if ((int) m_skinningPalette.size() < m_skinningPaletteSize)
+	{
+		m_skinningPalette.resize(m_skinningPaletteSize);
+	}
+
+	// Each animator writes its own range, so nothing is shared between the jobs
+	ParallelFor(0, animatorCount, ANIMATORS_PER_JOB, [&](int animatorIndex)
+	{
+		Animator* animator = m_animators[animatorIndex];
+		int paletteOffset = animator->GetSkinningPaletteOffset();
+
+		if (paletteOffset < 0 || m_lodStates[animatorIndex].poseSourceIndex >= 0)
+		{
+			return;
+		}
+
+		if (animator->HasCachedSkinningMatrices())
+		{
+			animator->WriteInterpolatedSkinningMatrices(&m_skinningPalette[paletteOffset], m_lodStates[animatorIndex].fractionTowardLatest);
+		}
+		else
+		{
+			animator->WriteSkinningMatrices(&m_skinningPalette[paletteOffset]);
+		}
+	});
+
+	// GL call, so back on this thread
+	if (m_skinningPaletteSize > 0)
+	{
+		m_skinningPaletteBuffer.CopyToGPU(sizeof(Matrix44) * m_skinningPaletteSize, m_skinningPalette.data());
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Binds the palette uploaded by the last Update() for the skinning shader
+//
+void AnimationSystem::BindSkinningPalette()
+{
+	m_skinningPaletteBuffer.Bind(SKINNING_BONE_BINDING);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the buffer the palette is uploaded to, for compute passes that skin with it
+//
+const RenderBuffer* AnimationSystem::GetSkinningPaletteBuffer() const
+{
+	return &m_skinningPaletteBuffer;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the skinning matrices of every animator as of the last Update()
+//
+const Matrix44* AnimationSystem::GetSkinningPalette() const
+{
+	return m_skinningPalette.data();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of matrices in the palette as of the last Update()
+//
+int AnimationSystem::GetSkinningPaletteSize() const
+{
+	return m_skinningPaletteSize;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets where LOD distances are measured from, usually the main camera's position, turning LOD on
+//
+void AnimationSystem::SetLODViewPosition(const Vector3& position)
+{
+	m_lodViewPosition = position;
+	m_isLODEnabled = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the distances and update rates of the LODs
+//
+void AnimationSystem::SetLODSettings(const AnimationLODSettings_t& settings)
+{
+	m_lodSettings = settings;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of animators that were at the given LOD in the last Update()
+//
+int AnimationSystem::GetAnimatorCountAtLOD(int lod) const
+{
+	return m_lodCounts[lod];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of animators whose poses were updated in the last Update()
+//
+int AnimationSystem::GetAnimatorsUpdatedLastFrame() const
+{
+	return m_animatorsUpdated;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of animators that used another's pose in the last Update()
+//
+int AnimationSystem::GetAnimatorsSharingPosesLastFrame() const
+{
+	return m_animatorsSharingPoses;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the LOD for the animator, from its distance to the view position in multiples of its radius
+//
+int AnimationSystem::CalculateLOD(const Animator* animator) const
+{
+	if (!m_isLODEnabled)
+	{
+		return 0;
+	}
+
+	float radius = animator->GetLODRadius();
+	float distanceSquared = (animator->GetLODCenter() - m_lodViewPosition).GetLengthSquared();
+
+	int lod = 0;
+	while (lod < ANIMATION_LOD_COUNT - 1)
+	{
+		float lodDistance = m_lodSettings.lodDistances[lod] * radius;
+
+		if (distanceSquared <= lodDistance * lodDistance)
+		{
+			break;
+		}
+
+		lod++;
+	}
+
+	return lod;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Groups this frame's sharing animators by key - the first of each group samples the pose, the
+// rest use it and skip their updates
+// Sorting the reused list keeps steady state frames from allocating, unlike a map rebuilt each frame
+//
+void AnimationSystem::AssignPoseSources()
+{
+	int animatorCount = (int) m_animators.size();
+	for (int animatorIndex = 0; animatorIndex < animatorCount; ++animatorIndex)
+	{
+		m_animators[animatorIndex]->SetPoseSource(nullptr);
+	}
+
+	std::sort(m_poseShareEntries.begin(), m_poseShareEntries.end());
+	m_animatorsSharingPoses = 0;
+
+	int entryCount = (int) m_poseShareEntries.size();
+	int groupStart = 0;
+
+	for (int entryIndex = 1; entryIndex < entryCount; ++entryIndex)
+	{
+		const PoseShareEntry_t& entry = m_poseShareEntries[entryIndex];
+		const PoseShareEntry_t& groupOwner = m_poseShareEntries[groupStart];
+
+		if (!(entry.key == groupOwner.key))
+		{
+			groupStart = entryIndex;
+			continue;
+		}
+
+		AnimatorLODState_t& lodState = m_lodStates[entry.animatorIndex];
+		lodState.poseSourceIndex = groupOwner.animatorIndex;
+		lodState.isUpdatingThisFrame = false;
+
+		m_animators[entry.animatorIndex]->SetPoseSource(m_animators[groupOwner.animatorIndex]);
+		m_animatorsSharingPoses++;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Orders by key, then by animator so the owner of each group is the same from frame to frame
+//
+bool PoseShareEntry_t::operator<(const PoseShareEntry_t& other) const
+{
+	if (!(key == other.key))
+	{
+		return (key < other.key);
+	}
+
+	return (animatorIndex < other.animatorIndex);
+}
@@ -0,0 +1,116 @@
+/************************************************************************/
+/* File: AnimationSystem.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Singleton that updates every registered Animator once a
+/*				frame - sampling, blending and skinning matrices in
+/*				parallel jobs, packed into one palette uploaded at once
+/************************************************************************/
+#pragma once
+#include <vector>
+#include "Engine/Math/Vector3.hpp"
+#include "Engine/Math/Matrix44.hpp"
+#include "Engine/Rendering/Animation/Animator.hpp"
+#include "Engine/Rendering/Animation/Skeleton.hpp"
+#include "Engine/Rendering/Buffers/RenderBuffer.hpp"
+
+// A character's update is a few hundred microseconds, so a handful per job keeps the overhead small
+#define ANIMATORS_PER_JOB (4)
+
+// Distances are in multiples of the animator's LOD radius, so it's roughly screen coverage
+struct AnimationLODSettings_t
+{
+	float	lodDistances[ANIMATION_LOD_COUNT - 1]	= { 25.f, 50.f, 100.f };	// Past each, the next LOD is used
+	int		updateIntervals[ANIMATION_LOD_COUNT]		= { 1, 2, 4, 8 };			// Frames between pose updates
+};
+
+// The system's bookkeeping for each animator, kept beside the list
+struct AnimatorLODState_t
+{
+	int		updateOffset = 0;					// Staggers reduced rate updates across frames
+	bool	isUpdatingThisFrame = false;
+	float	fractionTowardLatest = 1.f;
+	bool	isSharingPose = false;				// Grouped with others at the same clip time this frame, owner or not
+	int		poseSourceIndex = -1;				// Animator whose pose and palette range this one shares this frame
+};
+
+// An animator sharing its pose this frame, sorted by key so each group is contiguous
+struct PoseShareEntry_t
+{
+	PoseShareKey_t	key;
+	int				animatorIndex = -1;
+
+	bool operator<(const PoseShareEntry_t& other) const;
+};
+
+
+class AnimationSystem
+{
+public:
+	//-----Public Methods-----
+
+	static void				Initialize();
+	static void				Shutdown();
+	static AnimationSystem* GetInstance();
+
+	// The system doesn't own the animators, remove them before deleting them
+	void	AddAnimator(Animator* animator);
+	void	RemoveAnimator(Animator* animator);
+	int		GetAnimatorCount() const;
+
+	// Call once a frame on the render thread, before drawing anything skinned
+	// Afterwards each animator's GetLastPose() and GetSkinningPaletteOffset() are ready to use
+	void	Update();
+
+	// Every animator's skinning matrices back to back, each starting at its palette offset
+	// Skinned draws index it with their instance's bone offset, so characters sharing a mesh draw instanced
+	void			BindSkinningPalette();		// To SKINNING_BONE_BINDING, as a storage buffer
+	const RenderBuffer*	GetSkinningPaletteBuffer() const;
+	const Matrix44*	GetSkinningPalette() const;
+	int				GetSkinningPaletteSize() const;
+
+	// LOD is off, with everything updating every frame, until a view position is set
+	void			SetLODViewPosition(const Vector3& position);
+	void			SetLODSettings(const AnimationLODSettings_t& settings);
+	int				GetAnimatorCountAtLOD(int lod) const;		// As of the last Update()
+	int				GetAnimatorsUpdatedLastFrame() const;
+	int				GetAnimatorsSharingPosesLastFrame() const;	// Used another's pose instead of sampling their own
+
+
+private:
+	//-----Private Methods-----
+
+	// Singleton, use Initialize() instead
+	AnimationSystem() {}
+	~AnimationSystem() {}
+	AnimationSystem(const AnimationSystem& copy) = delete;
+
+	int				CalculateLOD(const Animator* animator) const;
+	void			AssignPoseSources();
+
+
+private:
+	//-----Private Data-----
+
+	std::vector<Animator*>				m_animators;
+	std::vector<AnimatorLODState_t>		m_lodStates;		// One per animator, in the same order
+
+	std::vector<Matrix44>	m_skinningPalette;			// Only grows, so steady state updates don't allocate
+	int						m_skinningPaletteSize = 0;	// Matrices used this frame
+	RenderBuffer			m_skinningPaletteBuffer;	// GL handle is created lazily on the first upload
+
+	AnimationLODSettings_t	m_lodSettings;
+	Vector3					m_lodViewPosition;
+	bool					m_isLODEnabled = false;
+	unsigned int			m_frameNumber = 0;
+	int						m_nextUpdateOffset = 0;
+	int						m_lodCounts[ANIMATION_LOD_COUNT] = {};
+	int						m_animatorsUpdated = 0;
+
+	// Per frame pose sharing, only grows like the palette
+	std::vector<PoseShareEntry_t>	m_poseShareEntries;
+	int								m_animatorsSharingPoses = 0;
+
+	static AnimationSystem* s_instance;
+
+};
@@ -6,11 +6,17 @@
 /************************************************************************/
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Core/Time/Stopwatch.hpp"
+#include "Engine/Rendering/Animation/Pose.hpp"
 #include "Engine/Rendering/Animation/Animator.hpp"
 #include "Engine/Rendering/Animation/AnimationClip.hpp"
+#include "Engine/Rendering/Animation/AnimationBlendTree.hpp"
 #include "Engine/Rendering/DebugRendering/DebugRenderSystem.hpp"
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Core/Utility/StringUtils.hpp"
+#include "Engine/Rendering/Core/Renderer.hpp"
+#include "Engine/Rendering/Animation/Skeleton.hpp"
+#include <math.h>
+#include <stdint.h>
 
 
 //-----------------------------------------------------------------------------------------------
@@ -18,9 +24,8 @@
 //
 Animator::Animator()
 {
-	m_currStopwatch = new Stopwatch(nullptr);
-	m_nextStopwatch = new Stopwatch(nullptr);
-	m_transitionStopwatch = new Stopwatch(nullptr);
+	m_currentPose = new Pose();
+	m_transitionPose = new Pose();
 }
 
 
@@ -29,14 +34,11 @@ Animator::Animator()
 //
 Animator::~Animator()
 {
-	delete m_currStopwatch;
-	m_currStopwatch = nullptr;
+	delete m_currentPose;
+	m_currentPose = nullptr;
 
-	delete m_nextStopwatch; 
-	m_nextStopwatch = nullptr;
-
-	delete m_transitionStopwatch;
-	m_transitionStopwatch = nullptr;
+	delete m_transitionPose;
+	m_transitionPose = nullptr;
 }
 
 
@@ -46,7 +48,8 @@ Animator::~Animator()
 void Animator::Play(AnimationClip* clip)
 {
 	m_currAnimation = clip;
-	m_currStopwatch->SetInterval(clip->GetTotalDurationSeconds());
+	m_currStopwatch.SetInterval(clip->GetTotalDurationSeconds());
+	m_blendTree = nullptr;
 
 	m_isPaused = false;
 	m_isTransitioning = false;
@@ -65,6 +68,13 @@ void Animator::TransitionToClip(AnimationClip* clip, float transitionTime)
 		return;
 	}
 
+	// Trees have no single clip to fade from, crossfades within one are done with a blend node
+	if (m_blendTree != nullptr)
+	{
+		Play(clip);
+		return;
+	}
+
 	// Clamp the transition to be at most the clip duration
 	float clipDuration = clip->GetTotalDurationSeconds();
 	if (clipDuration < transitionTime)
@@ -74,20 +84,72 @@ void Animator::TransitionToClip(AnimationClip* clip, float transitionTime)
 
 	// Set up for transition
 	m_nextAnimation = clip;
-	m_nextStopwatch->SetInterval(clipDuration);
-	m_transitionStopwatch->SetInterval(transitionTime);
+	m_nextStopwatch.SetInterval(clipDuration);
+	m_transitionStopwatch.SetInterval(transitionTime);
 	m_isTransitioning = true;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Returns the pose to render given the animator's current state
+// Plays the blend tree from where its nodes left off, in place of any clip
+//
+void Animator::PlayBlendTree(AnimationBlendTree* blendTree)
+{
+	m_blendTree = blendTree;
+	m_blendTree->ResetTime();
+	m_currStopwatch.Reset();
+
+	m_currAnimation = nullptr;
+	m_nextAnimation = nullptr;
+	m_isPaused = false;
+	m_isTransitioning = false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Samples and returns the pose to render given the animator's current state
+//
+const Pose* Animator::GetCurrentPose()
+{
+	UpdatePose();
+	return GetLastPose();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the pose from the last update, or nullptr if nothing has played yet
+//
+const Pose* Animator::GetLastPose() const
+{
+	if (m_poseSource != nullptr)
+	{
+		return m_poseSource->GetLastPose();
+	}
+
+	return (m_hasPose ? m_currentPose : nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Evaluates the blend tree, or samples the current clip blended with the next if transitioning, into
+// the animator's pose
+// Only touches this animator's state and reads the clips, so animators can update concurrently
 //
-Pose* Animator::GetCurrentPose()
+void Animator::UpdatePose()
 {
+	m_poseSource = nullptr;
+
+	if (m_blendTree != nullptr)
+	{
+		m_blendTree->Evaluate(m_currStopwatch.GetElapsedTime(), *m_currentPose);
+		m_hasPose = true;
+		return;
+	}
+
 	if (m_currAnimation == nullptr)
 	{
-		return nullptr;
+		m_hasPose = false;
+		return;
 	}
 
 	if (m_isTransitioning)
@@ -95,44 +157,324 @@ Pose* Animator::GetCurrentPose()
 		// Get the blend between the two
 
 		// Get times
-		float currTimeElapsed = m_currStopwatch->GetElapsedTimeNormalized();
-		float nextTimeElapsed = m_nextStopwatch->GetElapsedTimeNormalized();
+		float currTimeElapsed = m_currStopwatch.GetElapsedTimeNormalized();
+		float nextTimeElapsed = m_nextStopwatch.GetElapsedTimeNormalized();
 
 		// Get each respective pose
-		Pose* currentPose	= m_currAnimation->CalculatePoseAtNormalizedTime(currTimeElapsed);
-		Pose* nextPose		= m_nextAnimation->CalculatePoseAtNormalizedTime(nextTimeElapsed);
+		m_currAnimation->CalculatePoseAtNormalizedTime(currTimeElapsed, *m_currentPose);
+		m_nextAnimation->CalculatePoseAtNormalizedTime(nextTimeElapsed, *m_transitionPose);
 
 		// Interpolate the poses based on time into transition
-		float transitionTimeNormalized = m_transitionStopwatch->GetElapsedTimeNormalized();
-		int boneCount = currentPose->GetBoneCount();
-
-		for (int boneIndex = 0; boneIndex < boneCount; ++boneIndex)
-		{
-			currentPose->SetBoneTransform(boneIndex, Interpolate(currentPose->GetBoneTransform(boneIndex), nextPose->GetBoneTransform(boneIndex), transitionTimeNormalized));
-		}
+		float transitionTimeNormalized = m_transitionStopwatch.GetElapsedTimeNormalized();
+		m_currentPose->SetToBlend(*m_currentPose, *m_transitionPose, transitionTimeNormalized);
 
 		// Check if we're done transitioning
-		if (m_transitionStopwatch->HasIntervalElapsed())
+		if (m_transitionStopwatch.HasIntervalElapsed())
 		{
 			m_currAnimation = m_nextAnimation;
 			m_nextAnimation = nullptr;
 
 			// Need to swap stopwatches
-			Stopwatch* temp = m_currStopwatch; 
+			Stopwatch temp = m_currStopwatch; 
 			m_currStopwatch = m_nextStopwatch; 
 			m_nextStopwatch = temp;
 
 			m_isTransitioning = false;
 		}
-
-		// Return the result, cleaning up
-		delete nextPose; 
-		return currentPose;
 	}
 	else
 	{
-		// Just return the pose at time
-		float timeElapsed = m_currStopwatch->GetElapsedTimeNormalized();
-		return m_currAnimation->CalculatePoseAtNormalizedTime(timeElapsed);
+		// Just sample the pose at time, on the quantum if it may be shared
+		PoseShareKey_t shareKey;
+
+		if (GetPoseShareKey(shareKey))
+		{
+			m_currAnimation->CalculatePoseAtTime((float) shareKey.quantizedTime * shareKey.timeQuantum, *m_currentPose);
+		}
+		else
+		{
+			float timeElapsed = m_currStopwatch.GetElapsedTimeNormalized();
+			m_currAnimation->CalculatePoseAtNormalizedTime(timeElapsed, *m_currentPose);
+		}
+	}
+
+	m_hasPose = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of skinning matrices WriteSkinningMatrices() will write
+//
+unsigned int Animator::GetSkinningMatrixCount() const
+{
+	if (m_poseSource != nullptr)
+	{
+		return m_poseSource->GetSkinningMatrixCount();
+	}
+
+	return (m_hasPose ? m_currentPose->GetBoneCount() : 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Concatenates each bone's world transform with its inverse bind pose, to take skinned vertices
+// from mesh space to their posed position
+// out_matrices needs room for GetSkinningMatrixCount() matrices
+//
+void Animator::WriteSkinningMatrices(Matrix44* out_matrices) const
+{
+	if (m_poseSource != nullptr)
+	{
+		m_poseSource->WriteSkinningMatrices(out_matrices);
+		return;
+	}
+
+	if (!m_hasPose)
+	{
+		return;
+	}
+
+	const Skeleton* skeleton = m_currentPose->GetSkeleton();
+	const Matrix44* boneTransforms = m_currentPose->GetTotalBoneData();
+	unsigned int boneCount = m_currentPose->GetBoneCount();
+
+	int lod = m_currentPose->GetLOD();
+	bool isReduced = (lod > 0 && skeleton->HasLODBoneSets());
+
+	for (unsigned int boneIndex = 0; boneIndex < boneCount; ++boneIndex)
+	{
+		// Bones the LOD drops are held to their ancestor in bind pose, which skins the same as the ancestor
+		if (isReduced)
+		{
+			unsigned int sourceBone = skeleton->GetLODSourceBone(lod, boneIndex);
+
+			if (sourceBone != boneIndex)
+			{
+				out_matrices[boneIndex] = out_matrices[sourceBone];
+				continue;
+			}
+		}
+
+		out_matrices[boneIndex] = boneTransforms[boneIndex] * skeleton->GetBoneData(boneIndex).meshToBoneMatrix;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the index of this animator's first matrix in the AnimationSystem's skinning palette
+//
+int Animator::GetSkinningPaletteOffset() const
+{
+	return m_skinningPaletteOffset;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets where this animator's matrices were packed into the skinning palette
+//
+void Animator::SetSkinningPaletteOffset(int paletteOffset)
+{
+	m_skinningPaletteOffset = paletteOffset;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the bounds the LOD is picked from, usually the character's
+//
+void Animator::SetLODBounds(const Vector3& center, float radius)
+{
+	m_lodCenter = center;
+	m_lodRadius = radius;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the center of the LOD bounds
+//
+const Vector3& Animator::GetLODCenter() const
+{
+	return m_lodCenter;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the radius of the LOD bounds
+//
+float Animator::GetLODRadius() const
+{
+	return m_lodRadius;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the LOD the animator is animating at
+//
+int Animator::GetLOD() const
+{
+	return m_lod;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the LOD of the animator's poses, taking effect on the next update
+//
+void Animator::SetLOD(int lod)
+{
+	m_lod = ClampInt(lod, 0, ANIMATION_LOD_COUNT - 1);
+
+	m_currentPose->SetLOD(m_lod);
+	m_transitionPose->SetLOD(m_lod);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Keeps the skinning matrices of the pose just updated, along with the ones from the update before
+// The first cached update is used as both, so there's nothing stale to blend from
+//
+void Animator::CacheSkinningMatrices()
+{
+	m_previousSkinningMatrices.swap(m_latestSkinningMatrices);
+
+	m_latestSkinningMatrices.resize(GetSkinningMatrixCount());
+	WriteSkinningMatrices(m_latestSkinningMatrices.data());
+
+	if (!m_hasCachedSkinningMatrices || m_previousSkinningMatrices.size() != m_latestSkinningMatrices.size())
+	{
+		m_previousSkinningMatrices = m_latestSkinningMatrices;
+	}
+
+	m_hasCachedSkinningMatrices = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Forgets the cached skinning matrices, for when the animator goes back to updating every frame
+//
+void Animator::ClearCachedSkinningMatrices()
+{
+	m_hasCachedSkinningMatrices = false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if there are cached skinning matrices to interpolate between
+//
+bool Animator::HasCachedSkinningMatrices() const
+{
+	return m_hasCachedSkinningMatrices;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the blend of the last two cached updates - far away, lerping the matrices instead of
+// the poses doesn't shrink limbs enough to see
+// out_matrices needs room for the cached count, which is GetSkinningMatrixCount() as of the last cache
+//
+void Animator::WriteInterpolatedSkinningMatrices(Matrix44* out_matrices, float fractionTowardLatest) const
+{
+	int matrixCount = (int) m_latestSkinningMatrices.size();
+
+	for (int matrixIndex = 0; matrixIndex < matrixCount; ++matrixIndex)
+	{
+		out_matrices[matrixIndex] = Interpolate(m_previousSkinningMatrices[matrixIndex], m_latestSkinningMatrices[matrixIndex], fractionTowardLatest);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Turns pose sharing on or off, quantizing the clip time to the given step while it's on
+//
+void Animator::SetPoseSharing(bool isEnabled, float timeQuantumSeconds)
+{
+	ASSERT_OR_DIE(!isEnabled || timeQuantumSeconds > 0.f, Stringf("Error: Animator::SetPoseSharing() called with a time quantum of %.4f seconds", timeQuantumSeconds));
+
+	m_isPoseSharingEnabled = isEnabled;
+	m_poseShareQuantum = timeQuantumSeconds;
+
+	if (!isEnabled)
+	{
+		SetPoseSource(nullptr);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the animator has opted in to sharing poses
+//
+bool Animator::IsPoseSharingEnabled() const
+{
+	return m_isPoseSharingEnabled;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Gets what the animator's pose would be shared by this frame, the clip and the quantized time
+// into it; returns false if sharing is off or the animator isn't playing just a clip
+//
+bool Animator::GetPoseShareKey(PoseShareKey_t& out_key) const
+{
+	if (!m_isPoseSharingEnabled || m_blendTree != nullptr || m_isTransitioning || m_currAnimation == nullptr)
+	{
+		return false;
+	}
+
+	float clipDuration = m_currAnimation->GetTotalDurationSeconds();
+	float clipTime = fmodf(m_currStopwatch.GetElapsedTime(), clipDuration);
+
+	out_key.clip = m_currAnimation;
+	out_key.skeleton = m_currAnimation->GetSkeleton();
+	out_key.timeQuantum = m_poseShareQuantum;
+	out_key.quantizedTime = (int) floorf(clipTime / m_poseShareQuantum);
+	out_key.lod = m_lod;
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the animator whose pose and skinning matrices this one uses, nullptr if it has its own
+//
+const Animator* Animator::GetPoseSource() const
+{
+	return m_poseSource;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Uses the source's pose in place of this animator's own, until the next UpdatePose()
+// Clearing it leaves the animator without a pose until it's updated, as its own is stale
+//
+void Animator::SetPoseSource(const Animator* source)
+{
+	ASSERT_OR_DIE(source != this, "Error: Animator::SetPoseSource() called with the animator itself");
+
+	if (source == nullptr && m_poseSource != nullptr)
+	{
+		m_hasPose = false;
 	}
+
+	m_poseSource = source;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the keys are the same
+//
+bool PoseShareKey_t::operator==(const PoseShareKey_t& other) const
+{
+	return (clip == other.clip && skeleton == other.skeleton && timeQuantum == other.timeQuantum && quantizedTime == other.quantizedTime && lod == other.lod);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Orders keys so the same ones sort next to each other
+//
+bool PoseShareKey_t::operator<(const PoseShareKey_t& other) const
+{
+	if (clip != other.clip)						{ return ((uintptr_t) clip < (uintptr_t) other.clip); }
+	if (skeleton != other.skeleton)				{ return ((uintptr_t) skeleton < (uintptr_t) other.skeleton); }
+	if (timeQuantum != other.timeQuantum)		{ return (timeQuantum < other.timeQuantum); }
+	if (quantizedTime != other.quantizedTime)	{ return (quantizedTime < other.quantizedTime); }
+
+	return (lod < other.lod);
 }
@@ -5,10 +5,31 @@
 /* Description: Class to represent a skeletal animator
 /************************************************************************/
 #pragma once
+#include <vector>
+#include "Engine/Math/Vector3.hpp"
+#include "Engine/Math/Matrix44.hpp"
+#include "Engine/Core/Time/Stopwatch.hpp"
 
 class Pose;
-class Stopwatch;
+class Skeleton;
 class AnimationClip;
+class AnimationBlendTree;
+
+// Animators sharing poses sample their clip at multiples of this, so ones at nearby times match
+#define ANIMATION_DEFAULT_POSE_SHARE_QUANTUM (1.f / 30.f)
+
+// What animators sharing one sampled pose have in common for the frame
+struct PoseShareKey_t
+{
+	const AnimationClip*	clip = nullptr;
+	const Skeleton*			skeleton = nullptr;
+	float					timeQuantum = 0.f;
+	int						quantizedTime = 0;		// In multiples of the quantum, into the clip
+	int						lod = 0;
+
+	bool operator==(const PoseShareKey_t& other) const;
+	bool operator<(const PoseShareKey_t& other) const;
+};
 
 class Animator
 {
@@ -22,9 +43,47 @@ public:
 	// Playback controls
 	void	Play(AnimationClip* clip);
 	void	TransitionToClip(AnimationClip* clip, float transitionTime);
+	void	PlayBlendTree(AnimationBlendTree* blendTree);		// Not owned, and needs to be this animator's alone
 
 	// Accessors
-	Pose*	GetCurrentPose();
+	// The pose is owned by the animator and rewritten in place each call, so don't delete or hold onto it
+	const Pose*	GetCurrentPose();
+	const Pose*	GetLastPose() const;	// As of the last update, without sampling again
+
+	// Per frame update, split up so the AnimationSystem can run it in parallel jobs
+	void			UpdatePose();
+	unsigned int	GetSkinningMatrixCount() const;								// One per bone of the last pose, 0 if there isn't one
+	void			WriteSkinningMatrices(Matrix44* out_matrices) const;		// Bone to mesh space, for the skinning shader
+
+	// Where this animator's matrices start in the AnimationSystem's palette, -1 if it has none this frame
+	// Renderables drawing with it set this as their instance bone offset
+	int				GetSkinningPaletteOffset() const;
+	void			SetSkinningPaletteOffset(int paletteOffset);				// Only the AnimationSystem should call this
+
+	// What the AnimationSystem picks the LOD from - set the bounds to the character's each frame
+	void			SetLODBounds(const Vector3& center, float radius);
+	const Vector3&	GetLODCenter() const;
+	float			GetLODRadius() const;
+	int				GetLOD() const;
+	void			SetLOD(int lod);		// Animates only the skeleton's bone set for the LOD, if it has them
+
+	// For updating at a reduced rate - each update is cached, and the frames between blend the last two
+	void			CacheSkinningMatrices();
+	void			ClearCachedSkinningMatrices();
+	bool			HasCachedSkinningMatrices() const;
+	void			WriteInterpolatedSkinningMatrices(Matrix44* out_matrices, float fractionTowardLatest) const;
+
+	// Opt in to sharing - while playing a single clip, the AnimationSystem samples one pose and one
+	// range of skinning matrices for every sharing animator at the same quantized time of it
+	// Blend trees and transitions are always sampled per animator
+	void			SetPoseSharing(bool isEnabled, float timeQuantumSeconds = ANIMATION_DEFAULT_POSE_SHARE_QUANTUM);
+	bool			IsPoseSharingEnabled() const;
+	bool			GetPoseShareKey(PoseShareKey_t& out_key) const;		// False if the animator can't share this frame
+
+	// The animator whose pose this one uses this frame, nullptr if it samples its own
+	// Only the AnimationSystem should set it; updating the pose directly goes back to sampling its own
+	const Animator*	GetPoseSource() const;
+	void			SetPoseSource(const Animator* source);
 
 
 private:
@@ -32,12 +91,34 @@ private:
 
 	AnimationClip*	m_currAnimation = nullptr;
 	AnimationClip*	m_nextAnimation = nullptr;
+	AnimationBlendTree*	m_blendTree = nullptr;			// Played instead of the clips when set
+
+	Stopwatch		m_currStopwatch;
+	Stopwatch		m_nextStopwatch;
+	Stopwatch		m_transitionStopwatch;
 
-	Stopwatch*		m_currStopwatch			= nullptr;
-	Stopwatch*		m_nextStopwatch			= nullptr;
-	Stopwatch*		m_transitionStopwatch	= nullptr;
+	// Sampled into every call, so steady state playback doesn't allocate
+	Pose*			m_currentPose			= nullptr;
+	Pose*			m_transitionPose		= nullptr;
+	bool			m_hasPose				= false;
+
+	int				m_skinningPaletteOffset	= -1;
+
+	// LOD
+	Vector3			m_lodCenter;
+	float			m_lodRadius				= 1.f;
+	int				m_lod					= 0;
+
+	std::vector<Matrix44>	m_previousSkinningMatrices;
+	std::vector<Matrix44>	m_latestSkinningMatrices;
+	bool					m_hasCachedSkinningMatrices = false;
 
 	bool			m_isPaused				= false;
 	bool			m_isTransitioning		= false;
 
+	// Pose sharing
+	bool			m_isPoseSharingEnabled	= false;
+	float			m_poseShareQuantum		= ANIMATION_DEFAULT_POSE_SHARE_QUANTUM;
+	const Animator*	m_poseSource			= nullptr;
+
 };
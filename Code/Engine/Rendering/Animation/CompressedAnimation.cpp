@@ -0,0 +1,435 @@
+/************************************************************************/
+/* File: CompressedAnimation.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the CompressedAnimation class
+/************************************************************************/
+#include <math.h>
+#include <algorithm>
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/Animation/Pose.hpp"
+#include "Engine/Rendering/Animation/CompressedAnimation.hpp"
+
+#define VECTOR_QUANTIZATION_STEPS (65535.f)
+#define ROTATION_QUANTIZATION_SCALE (32767.f)
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the nearest quantization step to the value, within the range starting at rangeMin
+//
+static uint16_t QuantizeComponent(float value, float rangeMin, float rangeStep)
+{
+	if (rangeStep <= 0.f)
+	{
+		return 0;
+	}
+
+	return (uint16_t) ClampInt(RoundToNearestInt((value - rangeMin) / rangeStep), 0, (int) VECTOR_QUANTIZATION_STEPS);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the rotation component as a signed 16 bit fraction of one
+//
+static int16_t QuantizeRotationComponent(float value)
+{
+	return (int16_t) ClampInt(RoundToNearestInt(value * ROTATION_QUANTIZATION_SCALE), -32767, 32767);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the angle between the two rotations, taking q and -q as the same rotation
+// From the distance between them rather than their dot product, which is too close to 1 for
+// acos to resolve the small errors the tolerances are about
+//
+static float GetRotationErrorDegrees(const Quaternion& a, const Quaternion& b)
+{
+	float sign = (DotProduct(a, b) < 0.f ? -1.f : 1.f);
+
+	float deltaS = a.s - sign * b.s;
+	Vector3 deltaV = a.v - sign * b.v;
+	float distance = sqrtf(deltaS * deltaS + deltaV.GetLengthSquared());
+
+	return 4.f * ASinDegrees(ClampFloatZeroToOne(0.5f * distance));
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Picks the frames to keep a key at, greedily growing each segment until interpolating across it
+// misses a frame in between by more than the tolerance; the first and last frames are always kept
+// isSegmentWithinTolerance(startFrame, endFrame) checks every frame strictly between the two
+//
+template <typename SegmentTest>
+static void SelectKeyFrames(int frameCount, const SegmentTest& isSegmentWithinTolerance, std::vector<int>& out_keyFrames)
+{
+	out_keyFrames.clear();
+	out_keyFrames.push_back(0);
+
+	int segmentStart = 0;
+
+	for (int segmentEnd = 2; segmentEnd < frameCount; ++segmentEnd)
+	{
+		if (!isSegmentWithinTolerance(segmentStart, segmentEnd))
+		{
+			segmentStart = segmentEnd - 1;
+			out_keyFrames.push_back(segmentStart);
+		}
+	}
+
+	if (frameCount > 1)
+	{
+		out_keyFrames.push_back(frameCount - 1);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Builds the tracks from the clip's poses, which all need the same bone count
+//
+void CompressedAnimation::Build(const Pose* poses, unsigned int poseCount, const AnimationCompressionSettings_t& settings)
+{
+	ASSERT_OR_DIE(poseCount > 0 && poseCount <= COMPRESSED_ANIMATION_MAX_POSES,
+		Stringf("Error: CompressedAnimation::Build called with %u poses, must be between 1 and %i", poseCount, COMPRESSED_ANIMATION_MAX_POSES));
+
+	m_poseCount = poseCount;
+	m_boneCount = poses[0].GetBoneCount();
+
+	m_translationTracks.clear();
+	m_rotationTracks.clear();
+	m_scaleTracks.clear();
+	m_vectorKeyFrames.clear();
+	m_vectorKeyValues.clear();
+	m_rotationKeyFrames.clear();
+	m_rotationKeyValues.clear();
+
+	std::vector<Vector3> translations(poseCount);
+	std::vector<Quaternion> rotations(poseCount);
+	std::vector<Vector3> scales(poseCount);
+
+	for (unsigned int boneIndex = 0; boneIndex < m_boneCount; ++boneIndex)
+	{
+		for (unsigned int poseIndex = 0; poseIndex < poseCount; ++poseIndex)
+		{
+			ASSERT_OR_DIE(poses[poseIndex].GetBoneCount() == m_boneCount, Stringf("Error: CompressedAnimation::Build received poses with different bone counts"));
+
+			translations[poseIndex]	= poses[poseIndex].GetLocalTranslation(boneIndex);
+			rotations[poseIndex]	= poses[poseIndex].GetLocalRotation(boneIndex);
+			scales[poseIndex]		= poses[poseIndex].GetLocalScale(boneIndex);
+		}
+
+		AddVectorTrack(translations, settings.translationTolerance, m_translationTracks);
+		AddRotationTrack(rotations, settings.rotationToleranceDegrees);
+		AddVectorTrack(scales, settings.scaleTolerance, m_scaleTracks);
+	}
+
+	m_vectorKeyFrames.shrink_to_fit();
+	m_vectorKeyValues.shrink_to_fit();
+	m_rotationKeyFrames.shrink_to_fit();
+	m_rotationKeyValues.shrink_to_fit();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets every bone of the pose to the clip at the given frame position
+//
+void CompressedAnimation::SamplePose(float framePosition, Pose& out_pose) const
+{
+	SampleLocalPose(framePosition, out_pose);
+	out_pose.ConstructWorldMatricesFromLocalParts();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Decompresses the bones' local parts at the given frame position, for blending before the world
+// matrices are rebuilt
+//
+void CompressedAnimation::SampleLocalPose(float framePosition, Pose& out_pose) const
+{
+	ASSERT_OR_DIE(out_pose.GetBoneCount() == m_boneCount, Stringf("Error: CompressedAnimation::SampleLocalPose received a pose with %u bones, clip has %u", out_pose.GetBoneCount(), m_boneCount));
+
+	int frameIndex = ClampInt((int) framePosition, 0, (int) m_poseCount - 1);
+	float fractionTowardNext = ClampFloatZeroToOne(framePosition - (float) frameIndex);
+
+	// Only the bones the pose's LOD animates
+	unsigned int lodBoneCount;
+	const unsigned int* lodBones = out_pose.GetLODBoneIndices(lodBoneCount);
+
+	for (unsigned int lodIndex = 0; lodIndex < lodBoneCount; ++lodIndex)
+	{
+		unsigned int boneIndex = (lodBones != nullptr ? lodBones[lodIndex] : lodIndex);
+
+		Vector3 translation = SampleVectorTrack(m_translationTracks[boneIndex], frameIndex, fractionTowardNext);
+		Quaternion rotation = SampleRotationTrack(m_rotationTracks[boneIndex], frameIndex, fractionTowardNext);
+		Vector3 scale		= SampleVectorTrack(m_scaleTracks[boneIndex], frameIndex, fractionTowardNext);
+
+		out_pose.SetLocalTransform(boneIndex, translation, rotation, scale);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of poses the clip had before compression
+//
+unsigned int CompressedAnimation::GetPoseCount() const
+{
+	return m_poseCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of bones each pose has
+//
+unsigned int CompressedAnimation::GetBoneCount() const
+{
+	return m_boneCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the memory used by the tracks and keys
+//
+size_t CompressedAnimation::GetSizeBytes() const
+{
+	size_t trackBytes = (m_translationTracks.size() + m_scaleTracks.size()) * sizeof(CompressedVectorTrack_t) + m_rotationTracks.size() * sizeof(CompressedRotationTrack_t);
+	size_t keyBytes = (m_vectorKeyFrames.size() + m_vectorKeyValues.size() + m_rotationKeyFrames.size()) * sizeof(uint16_t) + m_rotationKeyValues.size() * sizeof(int16_t);
+
+	return sizeof(CompressedAnimation) + trackBytes + keyBytes;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the total number of keys kept across all tracks
+//
+int CompressedAnimation::GetKeyCount() const
+{
+	return (int) (m_vectorKeyFrames.size() + m_rotationKeyFrames.size());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Quantizes the values to the range they cover, then keeps only the keys needed to stay within tolerance
+// of the original values; the error is measured after quantizing, so it includes both
+//
+void CompressedAnimation::AddVectorTrack(const std::vector<Vector3>& values, float tolerance, std::vector<CompressedVectorTrack_t>& out_tracks)
+{
+	int frameCount = (int) values.size();
+
+	Vector3 mins = values[0];
+	Vector3 maxs = values[0];
+
+	for (int frameIndex = 1; frameIndex < frameCount; ++frameIndex)
+	{
+		mins = Vector3(MinFloat(mins.x, values[frameIndex].x), MinFloat(mins.y, values[frameIndex].y), MinFloat(mins.z, values[frameIndex].z));
+		maxs = Vector3(MaxFloat(maxs.x, values[frameIndex].x), MaxFloat(maxs.y, values[frameIndex].y), MaxFloat(maxs.z, values[frameIndex].z));
+	}
+
+	CompressedVectorTrack_t track;
+	track.firstKey = (uint32_t) m_vectorKeyFrames.size();
+	track.rangeMins = mins;
+	track.rangeStep = (maxs - mins) * (1.f / VECTOR_QUANTIZATION_STEPS);
+
+	std::vector<uint16_t> quantized(frameCount * 3);
+	std::vector<Vector3> dequantized(frameCount);
+
+	for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex)
+	{
+		uint16_t* components = &quantized[frameIndex * 3];
+		components[0] = QuantizeComponent(values[frameIndex].x, mins.x, track.rangeStep.x);
+		components[1] = QuantizeComponent(values[frameIndex].y, mins.y, track.rangeStep.y);
+		components[2] = QuantizeComponent(values[frameIndex].z, mins.z, track.rangeStep.z);
+
+		dequantized[frameIndex] = mins + Vector3(components[0] * track.rangeStep.x, components[1] * track.rangeStep.y, components[2] * track.rangeStep.z);
+	}
+
+	// Tracks that barely move, i.e. most scales, keep a single key
+	bool isConstant = true;
+	for (int frameIndex = 0; frameIndex < frameCount && isConstant; ++frameIndex)
+	{
+		isConstant = ((dequantized[0] - values[frameIndex]).GetLength() <= tolerance);
+	}
+
+	std::vector<int> keyFrames;
+
+	if (isConstant)
+	{
+		keyFrames.push_back(0);
+	}
+	else
+	{
+		SelectKeyFrames(frameCount, [&](int startFrame, int endFrame)
+		{
+			for (int frameIndex = startFrame + 1; frameIndex < endFrame; ++frameIndex)
+			{
+				float fraction = (float) (frameIndex - startFrame) / (float) (endFrame - startFrame);
+
+				if ((Interpolate(dequantized[startFrame], dequantized[endFrame], fraction) - values[frameIndex]).GetLength() > tolerance)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}, keyFrames);
+	}
+
+	for (int keyFrame : keyFrames)
+	{
+		m_vectorKeyFrames.push_back((uint16_t) keyFrame);
+		m_vectorKeyValues.insert(m_vectorKeyValues.end(), &quantized[keyFrame * 3], &quantized[keyFrame * 3] + 3);
+	}
+
+	track.keyCount = (uint32_t) keyFrames.size();
+	out_tracks.push_back(track);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Quantizes each component to 16 bits of [-1, 1], then keeps only the keys needed to stay within tolerance
+// Flips each rotation into the same hemisphere as the last, so neighbouring keys blend the short way
+//
+void CompressedAnimation::AddRotationTrack(std::vector<Quaternion>& values, float toleranceDegrees)
+{
+	int frameCount = (int) values.size();
+
+	for (int frameIndex = 1; frameIndex < frameCount; ++frameIndex)
+	{
+		if (DotProduct(values[frameIndex - 1], values[frameIndex]) < 0.f)
+		{
+			values[frameIndex] = values[frameIndex] * -1.f;
+		}
+	}
+
+	CompressedRotationTrack_t track;
+	track.firstKey = (uint32_t) m_rotationKeyFrames.size();
+
+	std::vector<int16_t> quantized(frameCount * 4);
+	std::vector<Quaternion> dequantized(frameCount);
+
+	for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex)
+	{
+		int16_t* components = &quantized[frameIndex * 4];
+		components[0] = QuantizeRotationComponent(values[frameIndex].s);
+		components[1] = QuantizeRotationComponent(values[frameIndex].v.x);
+		components[2] = QuantizeRotationComponent(values[frameIndex].v.y);
+		components[3] = QuantizeRotationComponent(values[frameIndex].v.z);
+
+		dequantized[frameIndex] = Quaternion(components[0], components[1], components[2], components[3]).GetNormalized();
+	}
+
+	bool isConstant = true;
+	for (int frameIndex = 0; frameIndex < frameCount && isConstant; ++frameIndex)
+	{
+		isConstant = (GetRotationErrorDegrees(dequantized[0], values[frameIndex]) <= toleranceDegrees);
+	}
+
+	std::vector<int> keyFrames;
+
+	if (isConstant)
+	{
+		keyFrames.push_back(0);
+	}
+	else
+	{
+		SelectKeyFrames(frameCount, [&](int startFrame, int endFrame)
+		{
+			for (int frameIndex = startFrame + 1; frameIndex < endFrame; ++frameIndex)
+			{
+				float fraction = (float) (frameIndex - startFrame) / (float) (endFrame - startFrame);
+
+				if (GetRotationErrorDegrees(Quaternion::FastSlerp(dequantized[startFrame], dequantized[endFrame], fraction), values[frameIndex]) > toleranceDegrees)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}, keyFrames);
+	}
+
+	for (int keyFrame : keyFrames)
+	{
+		m_rotationKeyFrames.push_back((uint16_t) keyFrame);
+		m_rotationKeyValues.insert(m_rotationKeyValues.end(), &quantized[keyFrame * 4], &quantized[keyFrame * 4] + 4);
+	}
+
+	track.keyCount = (uint32_t) keyFrames.size();
+	m_rotationTracks.push_back(track);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the track's value between frameIndex and the frame after it
+// Past the last key the track loops back to its first, the same as the uncompressed clip
+//
+Vector3 CompressedAnimation::SampleVectorTrack(const CompressedVectorTrack_t& track, int frameIndex, float fractionTowardNext) const
+{
+	if (track.keyCount == 1)
+	{
+		return GetVectorKey(track, 0);
+	}
+
+	const uint16_t* keyFrames = &m_vectorKeyFrames[track.firstKey];
+	uint32_t lastKey = track.keyCount - 1;
+
+	if (frameIndex >= (int) keyFrames[lastKey])
+	{
+		return Interpolate(GetVectorKey(track, lastKey), GetVectorKey(track, 0), fractionTowardNext);
+	}
+
+	uint32_t startKey = (uint32_t) (std::upper_bound(keyFrames, keyFrames + track.keyCount, (uint16_t) frameIndex) - keyFrames) - 1;
+	float startFrame = (float) keyFrames[startKey];
+	float endFrame = (float) keyFrames[startKey + 1];
+	float fraction = ((float) frameIndex + fractionTowardNext - startFrame) / (endFrame - startFrame);
+
+	return Interpolate(GetVectorKey(track, startKey), GetVectorKey(track, startKey + 1), fraction);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the track's rotation between frameIndex and the frame after it
+//
+Quaternion CompressedAnimation::SampleRotationTrack(const CompressedRotationTrack_t& track, int frameIndex, float fractionTowardNext) const
+{
+	if (track.keyCount == 1)
+	{
+		return GetRotationKey(track.firstKey);
+	}
+
+	const uint16_t* keyFrames = &m_rotationKeyFrames[track.firstKey];
+	uint32_t lastKey = track.keyCount - 1;
+
+	if (frameIndex >= (int) keyFrames[lastKey])
+	{
+		return Quaternion::FastSlerp(GetRotationKey(track.firstKey + lastKey), GetRotationKey(track.firstKey), fractionTowardNext);
+	}
+
+	uint32_t startKey = (uint32_t) (std::upper_bound(keyFrames, keyFrames + track.keyCount, (uint16_t) frameIndex) - keyFrames) - 1;
+	float startFrame = (float) keyFrames[startKey];
+	float endFrame = (float) keyFrames[startKey + 1];
+	float fraction = ((float) frameIndex + fractionTowardNext - startFrame) / (endFrame - startFrame);
+
+	return Quaternion::FastSlerp(GetRotationKey(track.firstKey + startKey), GetRotationKey(track.firstKey + startKey + 1), fraction);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the dequantized value of the track's key at keyIndex, counting from the track's first
+//
+Vector3 CompressedAnimation::GetVectorKey(const CompressedVectorTrack_t& track, uint32_t keyIndex) const
+{
+	const uint16_t* components = &m_vectorKeyValues[(track.firstKey + keyIndex) * 3];
+
+	return track.rangeMins + Vector3(components[0] * track.rangeStep.x, components[1] * track.rangeStep.y, components[2] * track.rangeStep.z);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the dequantized rotation at the given index into all rotation keys
+//
+Quaternion CompressedAnimation::GetRotationKey(uint32_t keyIndex) const
+{
+	const int16_t* components = &m_rotationKeyValues[keyIndex * 4];
+
+	return Quaternion(components[0], components[1], components[2], components[3]).GetNormalized();
+}
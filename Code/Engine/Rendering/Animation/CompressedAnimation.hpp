@@ -0,0 +1,97 @@
+/************************************************************************/
+/* File: CompressedAnimation.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Compressed form of an animation clip's poses - a track per
+/*				bone for each of translation, rotation and scale, with
+/*				keys that interpolate within tolerance removed and the
+/*				rest quantized to 16 bits a component
+/************************************************************************/
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "Engine/Math/Vector3.hpp"
+#include "Engine/Math/Quaternion.hpp"
+
+class Pose;
+
+// Key frames are stored as 16 bit indices
+#define COMPRESSED_ANIMATION_MAX_POSES (65535)
+
+// Per bone, relative to its parent - errors add up down the hierarchy, so long chains may want them tighter
+struct AnimationCompressionSettings_t
+{
+	float translationTolerance		= 0.001f;	// World units, before the parent's scale
+	float rotationToleranceDegrees	= 0.1f;
+	float scaleTolerance			= 0.001f;
+};
+
+// Translation and scale keys are quantized within the range the track covers
+struct CompressedVectorTrack_t
+{
+	uint32_t	firstKey = 0;
+	uint32_t	keyCount = 0;
+	Vector3		rangeMins;
+	Vector3		rangeStep;		// Size of one quantization step on each axis
+};
+
+struct CompressedRotationTrack_t
+{
+	uint32_t	firstKey = 0;
+	uint32_t	keyCount = 0;
+};
+
+
+class CompressedAnimation
+{
+public:
+	//-----Public Methods-----
+
+	CompressedAnimation() {}
+	~CompressedAnimation() {}
+
+	// Poses need their local parts set, which Pose::ConstructWorldMatrices() and DecomposeWorldMatrices() both do
+	void	Build(const Pose* poses, unsigned int poseCount, const AnimationCompressionSettings_t& settings);
+
+	// framePosition is in poses, from 0 up to the pose count, and loops from the last pose back to the first
+	// out_pose must already be initialized for the clip's skeleton
+	void	SamplePose(float framePosition, Pose& out_pose) const;
+	void	SampleLocalPose(float framePosition, Pose& out_pose) const;		// Leaves the world matrices stale
+
+	unsigned int	GetPoseCount() const;
+	unsigned int	GetBoneCount() const;
+	size_t			GetSizeBytes() const;
+	int				GetKeyCount() const;
+
+
+private:
+	//-----Private Methods-----
+
+	void		AddVectorTrack(const std::vector<Vector3>& values, float tolerance, std::vector<CompressedVectorTrack_t>& out_tracks);
+	void		AddRotationTrack(std::vector<Quaternion>& values, float toleranceDegrees);
+
+	Vector3		SampleVectorTrack(const CompressedVectorTrack_t& track, int frameIndex, float fractionTowardNext) const;
+	Quaternion	SampleRotationTrack(const CompressedRotationTrack_t& track, int frameIndex, float fractionTowardNext) const;
+
+	Vector3		GetVectorKey(const CompressedVectorTrack_t& track, uint32_t keyIndex) const;
+	Quaternion	GetRotationKey(uint32_t keyIndex) const;
+
+
+private:
+	//-----Private Data-----
+
+	unsigned int m_poseCount = 0;
+	unsigned int m_boneCount = 0;
+
+	// One of each per bone
+	std::vector<CompressedVectorTrack_t>	m_translationTracks;
+	std::vector<CompressedRotationTrack_t>	m_rotationTracks;
+	std::vector<CompressedVectorTrack_t>	m_scaleTracks;
+
+	// Keys of every track back to back, the frame they're at and their quantized value
+	std::vector<uint16_t>	m_vectorKeyFrames;
+	std::vector<uint16_t>	m_vectorKeyValues;				// 3 per key
+	std::vector<uint16_t>	m_rotationKeyFrames;
+	std::vector<int16_t>	m_rotationKeyValues;			// 4 per key, s then v
+
+};
@@ -0,0 +1,361 @@
+/************************************************************************/
+/* File: GPUSkinning.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the GPUSkinning static class
+/************************************************************************/
+#include "Engine/Assets/AssetDB.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
+#include "Engine/Rendering/Core/Vertex.hpp"
+#include "Engine/Rendering/Core/Renderer.hpp"
+#include "Engine/Rendering/Core/Renderable.hpp"
+#include "Engine/Rendering/Core/RenderScene.hpp"
+#include "Engine/Rendering/Meshes/Mesh.hpp"
+#include "Engine/Rendering/Materials/Material.hpp"
+#include "Engine/Rendering/Shaders/Shader.hpp"
+#include "Engine/Rendering/Shaders/ShaderSource.hpp"
+#include "Engine/Rendering/Shaders/ComputeShader.hpp"
+#include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include "Engine/Rendering/Animation/GPUSkinning.hpp"
+#include "Engine/Rendering/Animation/AnimationSystem.hpp"
+
+bool												GPUSkinning::s_isEnabled = true;
+std::map<const Renderable*, GPUSkinnedRenderable_t>	GPUSkinning::s_skinnedRenderables;
+unsigned int										GPUSkinning::s_frameNumber = 0;
+int													GPUSkinning::s_skinnedVertexCount = 0;
+ComputeShader*										GPUSkinning::s_skinningShader = nullptr;
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds the draws to skin this frame and makes sure each has its mesh and VAOs, freeing those of
+// renderables that are gone or no longer pre-skinned
+// Every instance is skinned, not just the ones a camera sees, since shadow casters can be off screen
+//
+bool GPUSkinning::PrepareScene(const std::vector<RenderableRecord_t>& records)
+{
+	PROFILE_SCOPE_CATEGORY("GPUSkinning::PrepareScene", "Rendering");
+
+	s_frameNumber++;
+	bool hasAnySkinned = false;
+
+	// Nothing to skin with until the AnimationSystem has a palette
+	if (s_isEnabled && AnimationSystem::GetInstance() != nullptr)
+	{
+		for (int recordIndex = 0; recordIndex < (int) records.size(); ++recordIndex)
+		{
+			const RenderableRecord_t& record = records[recordIndex];
+			if (record.renderable == nullptr || record.renderable->GetInstanceBoneOffsets() == nullptr)
+			{
+				continue;
+			}
+
+			GPUSkinnedRenderable_t& skinnedRenderable = s_skinnedRenderables[record.renderable];
+
+			if (UpdateSkinnedRenderable(record, skinnedRenderable))
+			{
+				skinnedRenderable.lastFramePrepared = s_frameNumber;
+				hasAnySkinned = true;
+			}
+		}
+	}
+
+	// The last frame's draw calls were already submitted, so anything not prepared this frame can go
+	std::map<const Renderable*, GPUSkinnedRenderable_t>::iterator itr = s_skinnedRenderables.begin();
+	while (itr != s_skinnedRenderables.end())
+	{
+		if (itr->second.lastFramePrepared == s_frameNumber)
+		{
+			itr++;
+			continue;
+		}
+
+		std::vector<GPUSkinnedDraw_t>& draws = itr->second.draws;
+		for (int drawIndex = 0; drawIndex < (int) draws.size(); ++drawIndex)
+		{
+			FreeSkinnedDraw(draws[drawIndex]);
+		}
+
+		itr = s_skinnedRenderables.erase(itr);
+	}
+
+	return hasAnySkinned;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Skins every prepared draw with the AnimationSystem's palette, then makes the results visible to
+// the vertex fetches of the passes after it
+//
+void GPUSkinning::Dispatch()
+{
+	PROFILE_SCOPE_CATEGORY("GPUSkinning::Dispatch", "Rendering");
+
+	s_skinnedVertexCount = 0;
+
+	AnimationSystem* animationSystem = AnimationSystem::GetInstance();
+	if (animationSystem == nullptr || animationSystem->GetSkinningPaletteBuffer()->GetHandle() == NULL)
+	{
+		return;
+	}
+
+	if (s_skinningShader == nullptr)
+	{
+		s_skinningShader = new ComputeShader();
+		s_skinningShader->InitializeFromSource(ShaderSource::GPU_SKINNING_CS, ShaderSource::GPU_SKINNING_NAME);
+		s_skinningShader->SetProfileName("GPUSkinning::Skin");
+	}
+
+	if (s_skinningShader->GetProgramHandle() == NULL)
+	{
+		return;
+	}
+
+	ComputeBindingTable bindings;
+	bindings.SetStorageBuffer(SKINNING_BONE_BINDING, animationSystem->GetSkinningPaletteBuffer());
+
+	std::map<const Renderable*, GPUSkinnedRenderable_t>::const_iterator itr;
+	for (itr = s_skinnedRenderables.begin(); itr != s_skinnedRenderables.end(); itr++)
+	{
+		const std::vector<GPUSkinnedDraw_t>& draws = itr->second.draws;
+
+		for (int drawIndex = 0; drawIndex < (int) draws.size(); ++drawIndex)
+		{
+			const GPUSkinnedDraw_t& draw = draws[drawIndex];
+			if (draw.skinnedMesh == nullptr)
+			{
+				continue;
+			}
+
+			unsigned int vertexCount = draw.sourceMesh->GetVertexBuffer()->GetVertexCount();
+
+			bindings.SetStorageBuffer(GPU_SKINNING_SOURCE_BINDING, draw.sourceMesh->GetVertexBuffer());
+			bindings.SetStorageBuffer(GPU_SKINNING_OUTPUT_BINDING, draw.skinnedMesh->GetVertexBuffer());
+			bindings.SetUniformUInt(0, vertexCount);
+			bindings.SetUniformUInt(1, draw.boneOffset);
+
+			int numGroups = (int) ((vertexCount + GPU_SKINNING_GROUP_SIZE - 1) / GPU_SKINNING_GROUP_SIZE);
+			s_skinningShader->Dispatch(bindings, numGroups, 1, 1);
+
+			s_skinnedVertexCount += (int) vertexCount;
+		}
+	}
+
+	// The skinned meshes are only read as vertex attributes
+	ComputeShader::InsertBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the renderable's skinned draws as of the last PrepareScene(), nullptr if it has none
+//
+const GPUSkinnedRenderable_t* GPUSkinning::GetSkinnedRenderable(const Renderable* renderable)
+{
+	std::map<const Renderable*, GPUSkinnedRenderable_t>::const_iterator itr = s_skinnedRenderables.find(renderable);
+
+	if (itr == s_skinnedRenderables.end() || itr->second.lastFramePrepared != s_frameNumber)
+	{
+		return nullptr;
+	}
+
+	return &itr->second;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets whether draws with a preskinned shader are skinned by the pre-pass; takes effect next frame
+//
+void GPUSkinning::SetEnabled(bool isEnabled)
+{
+	s_isEnabled = isEnabled;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the pre-pass skins the draws that can be
+//
+bool GPUSkinning::IsEnabled()
+{
+	return s_isEnabled;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of vertices the last Dispatch() skinned
+//
+int GPUSkinning::GetSkinnedVertexCount()
+{
+	return s_skinnedVertexCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Frees every skinned mesh and VAO, and the skinning shader
+//
+void GPUSkinning::Shutdown()
+{
+	std::map<const Renderable*, GPUSkinnedRenderable_t>::iterator itr;
+	for (itr = s_skinnedRenderables.begin(); itr != s_skinnedRenderables.end(); itr++)
+	{
+		std::vector<GPUSkinnedDraw_t>& draws = itr->second.draws;
+
+		for (int drawIndex = 0; drawIndex < (int) draws.size(); ++drawIndex)
+		{
+			FreeSkinnedDraw(draws[drawIndex]);
+		}
+	}
+
+	s_skinnedRenderables.clear();
+
+	if (s_skinningShader != nullptr)
+	{
+		delete s_skinningShader;
+		s_skinningShader = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Updates the skinned draws of the record's renderable, one per (draw, instance) of the draws that can be
+// pre-skinned - a single LOD of unpacked skinned vertices, with a material shader that names a preskinned one
+// Packed and LOD'd skinned draws are left to the vertex shader
+// Returns true if any draw is pre-skinned
+//
+bool GPUSkinning::UpdateSkinnedRenderable(const RenderableRecord_t& record, GPUSkinnedRenderable_t& skinnedRenderable)
+{
+	Renderable* renderable = record.renderable;
+	const uint32_t* boneOffsets = renderable->GetInstanceBoneOffsets();
+	int instanceCount = record.instanceCount;
+
+	std::vector<GPUSkinnedDraw_t>& draws = skinnedRenderable.draws;
+	int entryCount = record.drawCount * instanceCount;
+
+	// Free what's dropped before the resize copies the rest
+	for (int entryIndex = entryCount; entryIndex < (int) draws.size(); ++entryIndex)
+	{
+		FreeSkinnedDraw(draws[entryIndex]);
+	}
+
+	draws.resize(entryCount);
+	bool hasAnySkinned = false;
+
+	for (int dcIndex = 0; dcIndex < record.drawCount; ++dcIndex)
+	{
+		const Mesh* mesh = renderable->GetMeshForLOD(dcIndex, 0);
+		Material* material = renderable->GetMaterialForRender(dcIndex);
+
+		const Shader* preskinnedShader = nullptr;
+		bool canPreskin = (mesh != nullptr && material != nullptr && material->GetShader() != nullptr && renderable->GetLODCount(dcIndex) == 1
+			&& mesh->GetVertexLayout() == &VertexSkinned::LAYOUT && !mesh->IsStoredInArena() && mesh->GetVertexBuffer()->GetVertexCount() > 0);
+
+		if (canPreskin)
+		{
+			std::string preskinnedName = material->GetShader()->GetPreskinnedShaderName();
+
+			if (preskinnedName.size() > 0)
+			{
+				preskinnedShader = AssetDB::CreateOrGetShader(preskinnedName);
+			}
+		}
+
+		for (int instanceIndex = 0; instanceIndex < instanceCount; ++instanceIndex)
+		{
+			GPUSkinnedDraw_t& draw = draws[dcIndex * instanceCount + instanceIndex];
+
+			if (preskinnedShader != nullptr)
+			{
+				UpdateSkinnedDraw(draw, mesh, preskinnedShader, boneOffsets[instanceIndex]);
+				hasAnySkinned = true;
+			}
+			else
+			{
+				FreeSkinnedDraw(draw);
+			}
+		}
+	}
+
+	return hasAnySkinned;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Makes the draw's skinned mesh match the source mesh, rebuilding it if the source changed, and binds
+// its VAOs to the shader it'll be drawn with
+//
+void GPUSkinning::UpdateSkinnedDraw(GPUSkinnedDraw_t& draw, const Mesh* sourceMesh, const Shader* shader, uint32_t boneOffset)
+{
+	draw.boneOffset = boneOffset;
+
+	bool sourceChanged = (draw.skinnedMesh == nullptr || draw.sourceMesh != sourceMesh || draw.sourceRevision != sourceMesh->GetRevision());
+
+	if (sourceChanged)
+	{
+		if (draw.skinnedMesh == nullptr)
+		{
+			draw.skinnedMesh = new Mesh();
+		}
+
+		// Skinning only moves vertices, so the indices are copied once on the GPU
+		DrawInstruction instruction = sourceMesh->GetDrawInstruction();
+		unsigned int vertexCount = sourceMesh->GetVertexBuffer()->GetVertexCount();
+
+		draw.skinnedMesh->InitializeBuffersForCompute<VertexLit>(GPU_SKINNING_OUTPUT_BINDING, vertexCount, GPU_SKINNING_OUTPUT_BINDING, 0);
+
+		if (instruction.m_usingIndices)
+		{
+			draw.skinnedMesh->SetIndicesFromGPUBuffer(sourceMesh->GetIndexBuffer()->GetIndexCount(), sourceMesh->GetIndexBuffer()->GetHandle());
+		}
+
+		draw.skinnedMesh->SetDrawInstruction(instruction);
+
+		draw.sourceMesh = sourceMesh;
+		draw.sourceRevision = sourceMesh->GetRevision();
+	}
+
+	if (sourceChanged || draw.shader != shader)
+	{
+		Renderer* renderer = Renderer::GetInstance();
+		renderer->UpdateVAO(draw.vaoHandle, draw.skinnedMesh, shader);
+		renderer->UpdateDepthOnlyVAO(draw.depthVAOHandle, draw.skinnedMesh);
+
+		if (shader->IsDeferrable())
+		{
+			renderer->UpdateGBufferVAO(draw.gBufferVAOHandle, draw.skinnedMesh);
+		}
+
+		draw.shader = shader;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes the draw's skinned mesh and VAOs, leaving it not pre-skinned
+//
+void GPUSkinning::FreeSkinnedDraw(GPUSkinnedDraw_t& draw)
+{
+	Renderer* renderer = Renderer::GetInstance();
+
+	if (draw.vaoHandle != 0)
+	{
+		renderer->DeleteVAO(draw.vaoHandle);
+	}
+
+	if (draw.depthVAOHandle != 0)
+	{
+		renderer->DeleteVAO(draw.depthVAOHandle);
+	}
+
+	if (draw.gBufferVAOHandle != 0)
+	{
+		renderer->DeleteVAO(draw.gBufferVAOHandle);
+	}
+
+	if (draw.skinnedMesh != nullptr)
+	{
+		delete draw.skinnedMesh;
+		draw.skinnedMesh = nullptr;
+	}
+
+	draw = GPUSkinnedDraw_t();
+}
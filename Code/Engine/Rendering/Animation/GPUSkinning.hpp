@@ -0,0 +1,93 @@
+/************************************************************************/
+/* File: GPUSkinning.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Compute pre-pass that skins each skinned draw once a
+/*				frame into its own VertexLit mesh, so the shadow and
+/*				camera passes all draw it as static geometry
+/*				Static class - cannot be instantiated
+/************************************************************************/
+#pragma once
+#include <map>
+#include <vector>
+#include <stdint.h>
+
+class Mesh;
+class Shader;
+class Renderable;
+class ComputeShader;
+struct RenderableRecord_t;
+
+// Shader storage bindings of the source and skinned vertices, must match the GPU skinning shader
+// The palette is read from SKINNING_BONE_BINDING, the same as vertex shader skinning
+#define GPU_SKINNING_SOURCE_BINDING (16)
+#define GPU_SKINNING_OUTPUT_BINDING (17)
+
+#define GPU_SKINNING_GROUP_SIZE (64)		// Vertices per work group, must match the shader
+
+// One instance of one draw of a renderable, skinned into its own mesh
+struct GPUSkinnedDraw_t
+{
+	const Mesh*		sourceMesh = nullptr;		// The renderable's, to notice it being rebuilt
+	unsigned int	sourceRevision = 0;
+	uint32_t		boneOffset = 0;
+
+	Mesh*			skinnedMesh = nullptr;		// Null if this draw isn't pre-skinned
+	const Shader*	shader = nullptr;			// The material shader's preskinned one, drawn in its place
+	unsigned int	vaoHandle = 0;
+	unsigned int	depthVAOHandle = 0;
+	unsigned int	gBufferVAOHandle = 0;
+};
+
+// A renderable's skinned draws, ordered (draw, instance) like its record's world matrices
+struct GPUSkinnedRenderable_t
+{
+	std::vector<GPUSkinnedDraw_t>	draws;
+	unsigned int					lastFramePrepared = 0;
+};
+
+
+class GPUSkinning
+{
+public:
+	//-----Public Methods-----
+
+	GPUSkinning() = delete;
+
+	// Main thread, after the scene's records are updated and before any pass is recorded
+	// Returns true if anything needs to be skinned this frame, in which case Dispatch() must run before the passes
+	static bool PrepareScene(const std::vector<RenderableRecord_t>& records);
+
+	// Render thread, after the AnimationSystem uploads the frame's palette
+	static void Dispatch();
+
+	// Reads only, so the record jobs can call it between PrepareScene() calls; nullptr if nothing of the renderable is pre-skinned
+	static const GPUSkinnedRenderable_t* GetSkinnedRenderable(const Renderable* renderable);
+
+	// Only shaders with a preskinned shader set are affected, the rest always skin in the vertex shader
+	static void SetEnabled(bool isEnabled);
+	static bool IsEnabled();
+
+	static int	GetSkinnedVertexCount();	// Skinned by the last Dispatch()
+
+	static void Shutdown();					// Called when the Renderer shuts down
+
+
+private:
+	//-----Private Methods-----
+
+	static bool UpdateSkinnedRenderable(const RenderableRecord_t& record, GPUSkinnedRenderable_t& skinnedRenderable);
+	static void UpdateSkinnedDraw(GPUSkinnedDraw_t& draw, const Mesh* sourceMesh, const Shader* shader, uint32_t boneOffset);
+	static void FreeSkinnedDraw(GPUSkinnedDraw_t& draw);
+
+
+private:
+	//-----Private Data-----
+
+	static bool												s_isEnabled;
+	static std::map<const Renderable*, GPUSkinnedRenderable_t>	s_skinnedRenderables;
+	static unsigned int										s_frameNumber;
+	static int												s_skinnedVertexCount;
+	static ComputeShader*									s_skinningShader;
+
+};
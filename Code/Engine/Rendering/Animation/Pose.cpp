@@ -4,6 +4,7 @@
 /* Date: July 16th, 2018
 /* Description: Implementation of the Pose class
 /************************************************************************/
+#include "Engine/Math/MathUtils.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Rendering/Animation/Pose.hpp"
 #include "Engine/Rendering/Animation/Skeleton.hpp"
@@ -13,12 +14,41 @@
 // Destructor
 //
 Pose::~Pose()
+{
+	FreeBoneBuffers();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Frees the per bone arrays, leaving the pose empty
+//
+void Pose::FreeBoneBuffers()
 {
 	if (m_boneTransforms != NULL)
 	{
 		free(m_boneTransforms);
 		m_boneTransforms = NULL;
 	}
+
+	if (m_localTranslations != NULL)
+	{
+		free(m_localTranslations);
+		m_localTranslations = NULL;
+	}
+
+	if (m_localRotations != NULL)
+	{
+		free(m_localRotations);
+		m_localRotations = NULL;
+	}
+
+	if (m_localScales != NULL)
+	{
+		free(m_localScales);
+		m_localScales = NULL;
+	}
+
+	m_boneCount = 0;
 }
 
 
@@ -32,13 +62,24 @@ void Pose::Initialize(const Skeleton* skeleton)
 	ASSERT_OR_DIE(numBones <= 150, 
 		Stringf("Error: Pose::Initialize called for skeleton with more than 100 bones, unsupported. Count was %i", numBones));
 
-	m_boneTransforms = (Matrix44*) malloc (sizeof(Matrix44) * numBones);
-	m_boneCount = numBones;
+	// Poses sampled every frame are reinitialized for the same skeleton, so keep the buffers when they fit
+	if (m_boneTransforms == nullptr || (int) m_boneCount != numBones)
+	{
+		FreeBoneBuffers();
+
+		m_boneTransforms	= (Matrix44*) malloc(sizeof(Matrix44) * numBones);
+		m_localTranslations = (Vector3*) malloc(sizeof(Vector3) * numBones);
+		m_localRotations	= (Quaternion*) malloc(sizeof(Quaternion) * numBones);
+		m_localScales		= (Vector3*) malloc(sizeof(Vector3) * numBones);
+		m_boneCount = numBones;
+	}
+
 	m_skeleton = skeleton;
 
 	for (int i = 0; i < numBones; ++i)
 	{
 		m_boneTransforms[i] = skeleton->GetBoneData(i).localTransform;
+		Matrix44::DecomposeModelMatrix(m_boneTransforms[i], m_localTranslations[i], m_localRotations[i], m_localScales[i]);
 	}
 }
 
@@ -80,7 +121,9 @@ void Pose::ConstructWorldMatrices()
 {
 	for (int boneIndex = 0; boneIndex < (int) m_boneCount; ++boneIndex)
 	{	
-		BoneData_t boneData = m_skeleton->GetBoneData(boneIndex);
+		Matrix44::DecomposeModelMatrix(m_boneTransforms[boneIndex], m_localTranslations[boneIndex], m_localRotations[boneIndex], m_localScales[boneIndex]);
+
+		const BoneData_t& boneData = m_skeleton->GetBoneData(boneIndex);
 
 		int parentIndex = boneData.parentIndex;
 		ASSERT_OR_DIE(parentIndex < boneIndex, Stringf("Child was before parent in the pose transform array."));
@@ -96,6 +139,186 @@ void Pose::ConstructWorldMatrices()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Recovers each bone's local translation, rotation and scale from the world transforms, for poses
+// set one world matrix at a time (i.e. loaded from a cooked clip); a parent's non-uniform scale
+// under a rotated child can't be split exactly, and is blended as the closest fit
+//
+void Pose::DecomposeWorldMatrices()
+{
+	for (int boneIndex = 0; boneIndex < (int) m_boneCount; ++boneIndex)
+	{
+		int parentIndex = m_skeleton->GetBoneData(boneIndex).parentIndex;
+		ASSERT_OR_DIE(parentIndex < boneIndex, Stringf("Child was before parent in the pose transform array."));
+
+		Matrix44 localMatrix = m_boneTransforms[boneIndex];
+
+		if (parentIndex >= 0)
+		{
+			localMatrix = m_boneTransforms[parentIndex].GetInverseAffine() * localMatrix;
+		}
+
+		Matrix44::DecomposeModelMatrix(localMatrix, m_localTranslations[boneIndex], m_localRotations[boneIndex], m_localScales[boneIndex]);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets this pose to the blend of the two, in local space, and reconstructs the world matrices
+//
+void Pose::SetToBlend(const Pose& start, const Pose& end, float fractionTowardEnd)
+{
+	SetLocalPartsToBlend(start, end, fractionTowardEnd);
+	ConstructWorldMatricesFromLocalParts();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the local parts of this pose to the blend of the two, without rebuilding the world matrices
+//
+void Pose::SetLocalPartsToBlend(const Pose& start, const Pose& end, float fractionTowardEnd)
+{
+	ASSERT_OR_DIE(start.m_boneCount == m_boneCount && end.m_boneCount == m_boneCount,
+		Stringf("Error: Pose::SetLocalPartsToBlend received poses with different bone counts, %i and %i into %i", start.m_boneCount, end.m_boneCount, m_boneCount));
+
+	unsigned int lodBoneCount;
+	const unsigned int* lodBones = GetLODBoneIndices(lodBoneCount);
+
+	if (lodBones == nullptr)
+	{
+		Quaternion::FastSlerpArray(start.m_localRotations, end.m_localRotations, (int) m_boneCount, fractionTowardEnd, m_localRotations);
+
+		for (int boneIndex = 0; boneIndex < (int) m_boneCount; ++boneIndex)
+		{
+			m_localTranslations[boneIndex]	= Interpolate(start.m_localTranslations[boneIndex], end.m_localTranslations[boneIndex], fractionTowardEnd);
+			m_localScales[boneIndex]		= Interpolate(start.m_localScales[boneIndex], end.m_localScales[boneIndex], fractionTowardEnd);
+		}
+
+		return;
+	}
+
+	for (unsigned int lodIndex = 0; lodIndex < lodBoneCount; ++lodIndex)
+	{
+		unsigned int boneIndex = lodBones[lodIndex];
+
+		m_localTranslations[boneIndex]	= Interpolate(start.m_localTranslations[boneIndex], end.m_localTranslations[boneIndex], fractionTowardEnd);
+		m_localRotations[boneIndex]		= Quaternion::FastSlerp(start.m_localRotations[boneIndex], end.m_localRotations[boneIndex], fractionTowardEnd);
+		m_localScales[boneIndex]		= Interpolate(start.m_localScales[boneIndex], end.m_localScales[boneIndex], fractionTowardEnd);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the local parts of this pose to the blend of the two, with each bone's fraction scaled by its
+// weight - bones weighted to either end are copied rather than blended, as most of a mask usually is
+//
+void Pose::SetLocalPartsToMaskedBlend(const Pose& start, const Pose& end, float fractionTowardEnd, const float* boneWeights)
+{
+	ASSERT_OR_DIE(start.m_boneCount == m_boneCount && end.m_boneCount == m_boneCount,
+		Stringf("Error: Pose::SetLocalPartsToMaskedBlend received poses with different bone counts, %i and %i into %i", start.m_boneCount, end.m_boneCount, m_boneCount));
+
+	unsigned int lodBoneCount;
+	const unsigned int* lodBones = GetLODBoneIndices(lodBoneCount);
+
+	for (unsigned int lodIndex = 0; lodIndex < lodBoneCount; ++lodIndex)
+	{
+		unsigned int boneIndex = (lodBones != nullptr ? lodBones[lodIndex] : lodIndex);
+		float boneFraction = fractionTowardEnd * boneWeights[boneIndex];
+
+		if (boneFraction <= 0.f)
+		{
+			if (&start != this)
+			{
+				m_localTranslations[boneIndex]	= start.m_localTranslations[boneIndex];
+				m_localRotations[boneIndex]		= start.m_localRotations[boneIndex];
+				m_localScales[boneIndex]		= start.m_localScales[boneIndex];
+			}
+		}
+		else if (boneFraction >= 1.f)
+		{
+			m_localTranslations[boneIndex]	= end.m_localTranslations[boneIndex];
+			m_localRotations[boneIndex]		= end.m_localRotations[boneIndex];
+			m_localScales[boneIndex]		= end.m_localScales[boneIndex];
+		}
+		else
+		{
+			m_localTranslations[boneIndex]	= Interpolate(start.m_localTranslations[boneIndex], end.m_localTranslations[boneIndex], boneFraction);
+			m_localRotations[boneIndex]		= Quaternion::FastSlerp(start.m_localRotations[boneIndex], end.m_localRotations[boneIndex], boneFraction);
+			m_localScales[boneIndex]		= Interpolate(start.m_localScales[boneIndex], end.m_localScales[boneIndex], boneFraction);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets which of the skeleton's LOD bone sets the pose animates
+//
+void Pose::SetLOD(int lod)
+{
+	m_lod = ClampInt(lod, 0, ANIMATION_LOD_COUNT - 1);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the LOD the pose animates at
+//
+int Pose::GetLOD() const
+{
+	return m_lod;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the bones animated at the pose's LOD, or nullptr with the full bone count if that's all of them
+//
+const unsigned int* Pose::GetLODBoneIndices(unsigned int& out_boneCount) const
+{
+	if (m_lod == 0 || m_skeleton == nullptr || !m_skeleton->HasLODBoneSets())
+	{
+		out_boneCount = m_boneCount;
+		return nullptr;
+	}
+
+	const std::vector<unsigned int>& lodBones = m_skeleton->GetLODBoneIndices(m_lod);
+
+	out_boneCount = (unsigned int) lodBones.size();
+	return lodBones.data();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the local parts of the bone, leaving the world matrices stale until they're reconstructed
+//
+void Pose::SetLocalTransform(unsigned int boneIndex, const Vector3& translation, const Quaternion& rotation, const Vector3& scale)
+{
+	ASSERT_OR_DIE(boneIndex < m_boneCount, Stringf("Error: Pose::SetLocalTransform received index out of range, index was %i", boneIndex));
+
+	m_localTranslations[boneIndex]	= translation;
+	m_localRotations[boneIndex]		= rotation;
+	m_localScales[boneIndex]		= scale;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Rebuilds every world matrix from the local translations, rotations and scales
+//
+void Pose::ConstructWorldMatricesFromLocalParts()
+{
+	unsigned int lodBoneCount;
+	const unsigned int* lodBones = GetLODBoneIndices(lodBoneCount);
+
+	for (unsigned int lodIndex = 0; lodIndex < lodBoneCount; ++lodIndex)
+	{
+		unsigned int boneIndex = (lodBones != nullptr ? lodBones[lodIndex] : lodIndex);
+		Matrix44 localMatrix = Matrix44::MakeModelMatrix(m_localTranslations[boneIndex], m_localRotations[boneIndex], m_localScales[boneIndex]);
+
+		// Parents come first, so theirs are already rebuilt
+		int parentIndex = m_skeleton->GetBoneData(boneIndex).parentIndex;
+		m_boneTransforms[boneIndex] = (parentIndex >= 0 ? m_boneTransforms[parentIndex] * localMatrix : localMatrix);
+	}
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the transform for the bone at the given index
 //
@@ -107,6 +330,39 @@ Matrix44 Pose::GetBoneTransform(unsigned int boneIndex) const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the bone's translation relative to its parent
+//
+const Vector3& Pose::GetLocalTranslation(unsigned int boneIndex) const
+{
+	ASSERT_OR_DIE(boneIndex < m_boneCount, Stringf("Error: Pose::GetLocalTranslation received index out of range, index was %i", boneIndex));
+
+	return m_localTranslations[boneIndex];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the bone's rotation relative to its parent
+//
+const Quaternion& Pose::GetLocalRotation(unsigned int boneIndex) const
+{
+	ASSERT_OR_DIE(boneIndex < m_boneCount, Stringf("Error: Pose::GetLocalRotation received index out of range, index was %i", boneIndex));
+
+	return m_localRotations[boneIndex];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the bone's scale relative to its parent
+//
+const Vector3& Pose::GetLocalScale(unsigned int boneIndex) const
+{
+	ASSERT_OR_DIE(boneIndex < m_boneCount, Stringf("Error: Pose::GetLocalScale received index out of range, index was %i", boneIndex));
+
+	return m_localScales[boneIndex];
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the number of bones in this pose
 //
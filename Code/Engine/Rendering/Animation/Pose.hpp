@@ -8,6 +8,7 @@
 #pragma once
 #include <vector>
 #include "Engine/Math/Matrix44.hpp"
+#include "Engine/Math/Quaternion.hpp"
 
 class Skeleton;
 
@@ -19,6 +20,7 @@ public:
 	Pose() {}
 	~Pose();
 
+	// Resets the pose to the skeleton's bind pose, only allocating if the bone count changed
 	void			Initialize(const Skeleton* skeleton);
 
 	// Accessors
@@ -27,18 +29,54 @@ public:
 	const Matrix44* GetTotalBoneData() const;
 	const Skeleton* GetSkeleton() const;
 
+	const Vector3&		GetLocalTranslation(unsigned int boneIndex) const;
+	const Quaternion&	GetLocalRotation(unsigned int boneIndex) const;
+	const Vector3&		GetLocalScale(unsigned int boneIndex) const;
+
+	// Above 0, sampling, blending and rebuilding only touch the skeleton's LOD bone set, if it has them
+	// The world transforms of the other bones go stale - use the skeleton's LOD source bone instead
+	int					GetLOD() const;
+	const unsigned int*	GetLODBoneIndices(unsigned int& out_boneCount) const;	// nullptr if every bone is animated
+
 
 	// Mutators
+	void			SetLOD(int lod);		// Kept through Initialize(), so it can be set before the skeleton is known
 	void			SetBoneTransform(unsigned int index, const Matrix44& transform);
-	void			ConstructWorldMatrices();
+	void			ConstructWorldMatrices();			// From local transforms, keeping their parts for blending
+	void			DecomposeWorldMatrices();			// Recovers the local parts after setting world transforms directly
+
+	// For filling in a pose from its local parts, i.e. decompressing a clip - call ConstructWorldMatricesFromLocalParts() after
+	void			SetLocalTransform(unsigned int boneIndex, const Vector3& translation, const Quaternion& rotation, const Vector3& scale);
+	void			ConstructWorldMatricesFromLocalParts();
+
+	// Blends the local translation, rotation and scale of each bone and rebuilds the world matrices from them,
+	// so rotations don't shrink the way lerped matrices do; either pose can be this one
+	void			SetToBlend(const Pose& start, const Pose& end, float fractionTowardEnd);
+
+	// The same blend leaving the world matrices stale, for blending several poses before rebuilding them once
+	// The masked form scales the fraction per bone by boneWeights, one per bone
+	void			SetLocalPartsToBlend(const Pose& start, const Pose& end, float fractionTowardEnd);
+	void			SetLocalPartsToMaskedBlend(const Pose& start, const Pose& end, float fractionTowardEnd, const float* boneWeights);
+
+
+private:
+	//-----Private Methods-----
+
+	void			FreeBoneBuffers();
 
 
 private:
 	//-----Private Data-----
 
-	Matrix44* m_boneTransforms = nullptr;
+	Matrix44* m_boneTransforms = nullptr;			// World space, once constructed
 	unsigned int m_boneCount = 0;
 
-	const Skeleton* m_skeleton;
+	// Each bone relative to its parent, in arrays so the rotations blend in SIMD batches
+	Vector3*	m_localTranslations = nullptr;
+	Quaternion* m_localRotations = nullptr;
+	Vector3*	m_localScales = nullptr;
+
+	const Skeleton* m_skeleton = nullptr;
+	int				m_lod = 0;
 
 };
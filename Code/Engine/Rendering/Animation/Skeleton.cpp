@@ -4,6 +4,7 @@
 /* Date: June 15th, 2018
 /* Description: Implementation of the SkeletonBase class
 /************************************************************************/
+#include "Engine/Math/MathUtils.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Rendering/Animation/Skeleton.hpp"
 
@@ -11,7 +12,7 @@
 //-----------------------------------------------------------------------------------------------
 // Returns the bone data structure for the bone at the given index
 //
-BoneData_t Skeleton::GetBoneData(unsigned int boneIndex) const
+const BoneData_t& Skeleton::GetBoneData(unsigned int boneIndex) const
 {
 	ASSERT_OR_DIE(boneIndex < m_boneData.size(), Stringf("Error: SkeletonBase::SetOffsetMatrix received index out of bounds - size is %i, index is %i.", m_boneData.size(), boneIndex));
 
@@ -23,13 +24,22 @@ BoneData_t Skeleton::GetBoneData(unsigned int boneIndex) const
 // Returns the index of the bone given by name in the mappings array
 // Returns -1 if a bone of the given name doesn't exist
 //
-int Skeleton::GetBoneMapping(const std::string name) const
+int Skeleton::GetBoneMapping(const std::string& name) const
 {
-	bool nameExists = m_boneNameMappings.find(name) != m_boneNameMappings.end();
+	return GetBoneMapping(HashStringID(name));
+}
+
 
-	if (nameExists)
+//-----------------------------------------------------------------------------------------------
+// Returns the index of the bone given by the ID of its name, -1 if there isn't one
+//
+int Skeleton::GetBoneMapping(StringID boneNameID) const
+{
+	std::unordered_map<StringID, unsigned int>::const_iterator itr = m_boneNameMappings.find(boneNameID);
+
+	if (itr != m_boneNameMappings.end())
 	{
-		return m_boneNameMappings.at(name);
+		return (int) itr->second;
 	}
 
 	return -1;
@@ -42,24 +52,23 @@ int Skeleton::GetBoneMapping(const std::string name) const
 //
 int Skeleton::CreateOrGetBoneMapping(const std::string& boneName)
 {
-	bool nameExists = m_boneNameMappings.find(boneName) != m_boneNameMappings.end();
-	int boneIndex;
+	// One lookup either way - inserts the next index only if the name is new
+	unsigned int nextIndex = (unsigned int) m_boneData.size();
+	std::pair<std::unordered_map<StringID, unsigned int>::iterator, bool> result = m_boneNameMappings.insert(std::make_pair(InternStringID(boneName), nextIndex));
 
-	if (nameExists)
-	{
-		boneIndex = m_boneNameMappings[boneName];
-	}
-	else
+	if (result.second)
 	{
-		boneIndex = (unsigned int) m_boneData.size();
 		m_boneData.push_back(BoneData_t());
-		m_boneNameMappings[boneName] = boneIndex;
 
 		// Also add the name to the name's list
 		m_boneNames.push_back(boneName);
 	}
+	else
+	{
+		GUARANTEE_OR_DIE(m_boneNames[result.first->second] == boneName, Stringf("Error: Skeleton bone names \"%s\" and \"%s\" hash to the same ID, rename one", m_boneNames[result.first->second].c_str(), boneName.c_str()));
+	}
 
-	return boneIndex;
+	return (int) result.first->second;
 }
 
 
@@ -75,12 +84,23 @@ std::string Skeleton::GetRootBoneName() const
 //-----------------------------------------------------------------------------------------------
 // Returns the list of bone names for this skeleton
 //
-std::vector<std::string> Skeleton::GetAllBoneNames() const
+const std::vector<std::string>& Skeleton::GetAllBoneNames() const
 {
 	return m_boneNames;
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the name of the bone at the given index
+//
+const std::string& Skeleton::GetBoneName(unsigned int boneIndex) const
+{
+	ASSERT_OR_DIE(boneIndex < m_boneNames.size(), Stringf("Error: Skeleton::GetBoneName received index out of bounds - size is %i, index is %i.", m_boneNames.size(), boneIndex));
+
+	return m_boneNames[boneIndex];
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the number of bones in the skeleton
 //
@@ -167,3 +187,80 @@ void Skeleton::SetBonePreRotation(unsigned int boneIndex, const Matrix44& preRot
 
 	m_boneData[boneIndex].preRotation = preRotation;
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the last LOD the bone is animated at
+//
+void Skeleton::SetBoneMaxLOD(unsigned int boneIndex, int maxLOD)
+{
+	ASSERT_OR_DIE(boneIndex < m_boneData.size(), Stringf("Error: Skeleton::SetBoneMaxLOD received index out of bounds - size is %i, index is %i.", m_boneData.size(), boneIndex));
+
+	m_boneData[boneIndex].maxLOD = ClampInt(maxLOD, 0, ANIMATION_LOD_COUNT - 1);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Builds the bone lists for each LOD from the bones' max LODs
+// A dropped bone keeps its bind pose relative to its nearest animated ancestor, so its skinning
+// matrix works out to be exactly that ancestor's and can be copied instead of built
+//
+void Skeleton::BuildLODBoneSets()
+{
+	unsigned int boneCount = (unsigned int) m_boneData.size();
+	std::vector<bool> isAnimated(boneCount);
+
+	for (int lod = 0; lod < ANIMATION_LOD_COUNT; ++lod)
+	{
+		m_lodBoneIndices[lod].clear();
+		m_lodSourceBones[lod].resize(boneCount);
+
+		// Parents come first, so theirs are already decided
+		for (unsigned int boneIndex = 0; boneIndex < boneCount; ++boneIndex)
+		{
+			int parentIndex = m_boneData[boneIndex].parentIndex;
+			bool isRoot = (parentIndex < 0);
+
+			isAnimated[boneIndex] = isRoot || (m_boneData[boneIndex].maxLOD >= lod && isAnimated[parentIndex]);
+
+			if (isAnimated[boneIndex])
+			{
+				m_lodBoneIndices[lod].push_back(boneIndex);
+				m_lodSourceBones[lod][boneIndex] = boneIndex;
+			}
+			else
+			{
+				m_lodSourceBones[lod][boneIndex] = m_lodSourceBones[lod][parentIndex];
+			}
+		}
+	}
+
+	m_hasLODBoneSets = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if BuildLODBoneSets() was called; without them every LOD animates every bone
+//
+bool Skeleton::HasLODBoneSets() const
+{
+	return m_hasLODBoneSets;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the indices of the bones animated at the given LOD, parents before children
+//
+const std::vector<unsigned int>& Skeleton::GetLODBoneIndices(int lod) const
+{
+	return m_lodBoneIndices[lod];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the bone whose skinning matrix the given bone uses at the LOD
+//
+unsigned int Skeleton::GetLODSourceBone(int lod, unsigned int boneIndex) const
+{
+	return m_lodSourceBones[lod][boneIndex];
+}
@@ -5,11 +5,14 @@
 /* Description: Class to represent an animation skeleton resource (data, not state)
 /************************************************************************/
 #pragma once
-#include <map>
+#include <string>
 #include <vector>
+#include <unordered_map>
 #include "Engine/Math/Matrix44.hpp"
+#include "Engine/Core/Utility/StringID.hpp"
 
 #define MAX_BONES_PER_VERTEX (4) // Only support up to 4 bone weights per vertex
+#define ANIMATION_LOD_COUNT (4)	// LOD 0 is every bone at full rate, each after is further away
 
 // Structure to represent a single bone in the skeleton
 struct BoneData_t
@@ -21,6 +24,7 @@ struct BoneData_t
 	Matrix44	offsetMatrix;				// Assimp's offset matrix
 	Matrix44	preRotation;				// Pre-rotation for the bone
 	int			parentIndex = -1;			// Index of the parent of this bone, -1 indicates no parent (root)
+	int			maxLOD = ANIMATION_LOD_COUNT - 1;	// Last LOD the bone is animated at, past it it's held in its bind pose to its parent
 };
 
 class Skeleton
@@ -29,14 +33,22 @@ public:
 	//-----Public Methods-----
 
 	// Accessors
-	BoneData_t	GetBoneData(unsigned int boneIndex) const;
-	int			GetBoneMapping(const std::string name) const;
+	const BoneData_t&	GetBoneData(unsigned int boneIndex) const;		// By reference, since the pose loops read it per bone per frame
+	int			GetBoneMapping(const std::string& name) const;					// -1 if there's no bone of that name
+	int			GetBoneMapping(StringID boneNameID) const;						// i.e. GetBoneMapping(SID("Hips"))
 	int			CreateOrGetBoneMapping(const std::string& boneName);
 	
 	unsigned int	GetBoneCount() const;
 	std::string		GetRootBoneName() const;
+	const std::string& GetBoneName(unsigned int boneIndex) const;
 
-	std::vector<std::string> GetAllBoneNames() const;
+	const std::vector<std::string>& GetAllBoneNames() const;
+
+	// Reduced bone sets, once BuildLODBoneSets() is called - the bones animated at each LOD in order,
+	// and for every bone the one whose skinning matrix it shares there (itself if it's animated)
+	bool							HasLODBoneSets() const;
+	const std::vector<unsigned int>& GetLODBoneIndices(int lod) const;
+	unsigned int					GetLODSourceBone(int lod, unsigned int boneIndex) const;
 
 	// Mutators
 	void SetBoneToMeshMatrix(unsigned int boneIndex, const Matrix44& offsetMatrix);
@@ -47,12 +59,20 @@ public:
 	void SetOffsetMatrix(unsigned int boneIndex, const Matrix44& offsetTransform);
 	void SetBonePreRotation(unsigned int boneIndex, const Matrix44& prerotation);
 
+	// Fingers, face and twist bones are typically dropped first; a bone is never kept past its parent
+	void SetBoneMaxLOD(unsigned int boneIndex, int maxLOD);
+	void BuildLODBoneSets();		// Call once the hierarchy and max LODs are all set
+
 
 private:
 	//-----Private Data-----
 
-	std::map<std::string, unsigned int> m_boneNameMappings;		// Registry that maps bone names to element positions in the m_boneData array
+	std::unordered_map<StringID, unsigned int> m_boneNameMappings;		// Registry that maps bone name IDs to element positions in the m_boneData array
 	std::vector<BoneData_t>				m_boneData;				// Collection of bone information (transforms, parent indices)
 	std::vector<std::string>			m_boneNames;			// Names of all bones in the skeleton
 
+	bool								m_hasLODBoneSets = false;
+	std::vector<unsigned int>			m_lodBoneIndices[ANIMATION_LOD_COUNT];
+	std::vector<unsigned int>			m_lodSourceBones[ANIMATION_LOD_COUNT];
+
 };
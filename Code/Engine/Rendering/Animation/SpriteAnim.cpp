@@ -5,11 +5,13 @@
 /* Bugs: None
 /* Description: Implementation of the SpriteAnimation class
 /************************************************************************/
+#include <math.h>
 #include "Engine/Rendering/Animation/SpriteAnim.hpp"
 #include "Engine/Core/Utility/XmlUtilities.hpp"
 #include "Engine/Rendering/Animation/SpriteAnimDef.hpp"
 #include "Engine/Core/Utility/ErrorWarningAssert.hpp"
 #include "Engine/Core/Utility/StringUtils.hpp"
+#include "Engine/Math/MathUtils.hpp"
 
 //-----------------------------------------------------------------------------------------------
 // Constructs a SpriteAnimation given definition information, and sets all state information to the defaults
@@ -173,15 +175,8 @@ int SpriteAnim::GetPriority() const
 //
 float SpriteAnim::GetSecondsIntoSequence() const
 {
-	float secondsIntoSequence = m_secondsElapsed;
 	float sequenceDuration = m_spriteAnimDef->GetSequenceDuration();
-
-	while (secondsIntoSequence >= sequenceDuration)
-	{
-		secondsIntoSequence -= sequenceDuration;
-	}
-
-	return secondsIntoSequence;
+	return fmodf(m_secondsElapsed, sequenceDuration);
 }
 
 
@@ -244,21 +239,21 @@ void SpriteAnim::SetFractionElapsed(float fractionElapsed)
 //
 int SpriteAnim::CalculateCurrentAnimationFrameIndex() const
 {
-	float secondsIntoSequence = GetSecondsIntoSequence();
-
-	// Find the amount of time per frame
 	float secondsPerFrame = (1.f / m_spriteAnimDef->GetFramesPerSecond());
-	 
-	// Determine the frame number by finding which offset into the sequence we're
-	// in the middle of
-	int sequenceOffsetIndex = 0;
-	while (secondsIntoSequence > secondsPerFrame)
-	{
-		secondsIntoSequence -= secondsPerFrame;
-		sequenceOffsetIndex++;
-	}
+	return CalculateFrameIndex(m_secondsElapsed, secondsPerFrame, m_spriteAnimDef->GetSequenceDuration(), m_spriteAnimDef->GetNumFrames());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the index into the sequence of the frame shown at the given time, wrapping past the end
+// Frames cover (start, end], so a time exactly on a boundary still shows the frame ending there
+//
+int SpriteAnim::CalculateFrameIndex(float secondsElapsed, float secondsPerFrame, float sequenceDuration, int frameCount)
+{
+	float secondsIntoSequence = fmodf(secondsElapsed, sequenceDuration);
+	int sequenceOffsetIndex = static_cast<int>(ceilf(secondsIntoSequence / secondsPerFrame)) - 1;
 
-	return sequenceOffsetIndex;
+	return ClampInt(sequenceOffsetIndex, 0, frameCount - 1);
 }
 
 
@@ -62,6 +62,7 @@ public:
 
 	//-----Static Functions-----
 	static PlayMode ConvertStringToPlayMode(const std::string& playModeString);
+	static int		CalculateFrameIndex(float secondsElapsed, float secondsPerFrame, float sequenceDuration, int frameCount);	// Shared with SpriteAnimBatch
 
 private:
 	//-----Private Methods-----
@@ -0,0 +1,295 @@
+/************************************************************************/
+/* File: SpriteAnimBatch.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the SpriteAnimBatch class
+/************************************************************************/
+#include "Engine/Rendering/Animation/SpriteAnim.hpp"
+#include "Engine/Rendering/Animation/SpriteAnimDef.hpp"
+#include "Engine/Rendering/Animation/SpriteAnimBatch.hpp"
+#include "Engine/Core/Utility/StringUtils.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds an animation of the given definition, reusing a removed animation's index if there is one
+//
+int SpriteAnimBatch::AddAnimation(const SpriteAnimDef* definition, bool playImmediately, float secondsElapsed /*= 0.f*/)
+{
+	GUARANTEE_OR_DIE(definition != nullptr, "Error: SpriteAnimBatch::AddAnimation() called with a null definition");
+
+	int animationIndex;
+	if (m_freeIndices.size() > 0)
+	{
+		animationIndex = m_freeIndices.back();
+		m_freeIndices.pop_back();
+	}
+	else
+	{
+		animationIndex = static_cast<int>(m_definitions.size());
+
+		m_secondsElapsed.push_back(0.f);
+		m_secondsPerFrame.push_back(0.f);
+		m_durations.push_back(0.f);
+		m_frameCounts.push_back(0);
+		m_frameIndices.push_back(0);
+		m_flags.push_back(0);
+		m_definitions.push_back(nullptr);
+	}
+
+	m_flags[animationIndex] = SPRITE_ANIM_FLAG_IN_USE;
+	SetDefinition(animationIndex, definition);
+
+	if (playImmediately)
+	{
+		m_flags[animationIndex] |= SPRITE_ANIM_FLAG_PLAYING;
+	}
+
+	SetSecondsElapsed(animationIndex, secondsElapsed);
+
+	return animationIndex;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stops tracking the animation at the given index, which may be handed out again by AddAnimation()
+//
+void SpriteAnimBatch::RemoveAnimation(int animationIndex)
+{
+	ASSERT_OR_DIE(IsValidIndex(animationIndex), Stringf("Error: SpriteAnimBatch::RemoveAnimation() called on invalid index %i", animationIndex));
+
+	m_flags[animationIndex] = 0;
+	m_definitions[animationIndex] = nullptr;
+	m_freeIndices.push_back(animationIndex);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Switches the animation at the given index to a new definition, starting it from the beginning
+//
+void SpriteAnimBatch::SetDefinition(int animationIndex, const SpriteAnimDef* definition)
+{
+	ASSERT_OR_DIE(IsValidIndex(animationIndex), Stringf("Error: SpriteAnimBatch::SetDefinition() called on invalid index %i", animationIndex));
+	GUARANTEE_OR_DIE(definition != nullptr, "Error: SpriteAnimBatch::SetDefinition() called with a null definition");
+
+	m_definitions[animationIndex] = definition;
+	m_secondsPerFrame[animationIndex] = (1.f / static_cast<float>(definition->GetFramesPerSecond()));
+	m_durations[animationIndex] = definition->GetSequenceDuration();
+	m_frameCounts[animationIndex] = definition->GetNumFrames();
+
+	uint8_t keptFlags = (m_flags[animationIndex] & (SPRITE_ANIM_FLAG_IN_USE | SPRITE_ANIM_FLAG_PLAYING));
+	m_flags[animationIndex] = static_cast<uint8_t>(keptFlags | (definition->GetPlayMode() == PLAY_MODE_ONCE ? SPRITE_ANIM_FLAG_PLAY_ONCE : 0));
+
+	SetSecondsElapsed(animationIndex, 0.f);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reserves space for the given number of animations, to avoid growing while adding them
+//
+void SpriteAnimBatch::Reserve(int animationCount)
+{
+	m_secondsElapsed.reserve(animationCount);
+	m_secondsPerFrame.reserve(animationCount);
+	m_durations.reserve(animationCount);
+	m_frameCounts.reserve(animationCount);
+	m_frameIndices.reserve(animationCount);
+	m_flags.reserve(animationCount);
+	m_definitions.reserve(animationCount);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Advances every playing animation by deltaSeconds, then finds each one's current frame
+// Matches SpriteAnim::Update() - play once animations finish at the end of their sequence
+//
+void SpriteAnimBatch::Update(float deltaSeconds)
+{
+	int indexCount = static_cast<int>(m_flags.size());
+
+	float*			secondsElapsed	= m_secondsElapsed.data();
+	const float*	secondsPerFrame	= m_secondsPerFrame.data();
+	const float*	durations		= m_durations.data();
+	const int*		frameCounts		= m_frameCounts.data();
+	int*			frameIndices	= m_frameIndices.data();
+	uint8_t*		flags			= m_flags.data();
+
+	// Freed indices are never playing, so they don't need skipping here
+	for (int index = 0; index < indexCount; ++index)
+	{
+		secondsElapsed[index] += ((flags[index] & SPRITE_ANIM_FLAG_PLAYING) != 0 ? deltaSeconds : 0.f);
+	}
+
+	for (int index = 0; index < indexCount; ++index)
+	{
+		if ((flags[index] & SPRITE_ANIM_FLAG_IN_USE) == 0)
+		{
+			continue;
+		}
+
+		frameIndices[index] = SpriteAnim::CalculateFrameIndex(secondsElapsed[index], secondsPerFrame[index], durations[index], frameCounts[index]);
+
+		if ((flags[index] & SPRITE_ANIM_FLAG_PLAY_ONCE) != 0 && secondsElapsed[index] >= durations[index])
+		{
+			flags[index] |= SPRITE_ANIM_FLAG_FINISHED;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts playing the animation at the given index
+//
+void SpriteAnimBatch::Play(int animationIndex)
+{
+	ASSERT_OR_DIE(IsValidIndex(animationIndex), Stringf("Error: SpriteAnimBatch::Play() called on invalid index %i", animationIndex));
+	m_flags[animationIndex] |= SPRITE_ANIM_FLAG_PLAYING;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Freezes the animation at the given index, keeping its place in the sequence
+//
+void SpriteAnimBatch::Pause(int animationIndex)
+{
+	ASSERT_OR_DIE(IsValidIndex(animationIndex), Stringf("Error: SpriteAnimBatch::Pause() called on invalid index %i", animationIndex));
+	m_flags[animationIndex] &= static_cast<uint8_t>(~SPRITE_ANIM_FLAG_PLAYING);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the animation at the given index back to the beginning, paused
+//
+void SpriteAnimBatch::Reset(int animationIndex)
+{
+	Pause(animationIndex);
+	SetSecondsElapsed(animationIndex, 0.f);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the animation at the given index back to the beginning, and plays it
+//
+void SpriteAnimBatch::ResetAndPlay(int animationIndex)
+{
+	Play(animationIndex);
+	SetSecondsElapsed(animationIndex, 0.f);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Skips the animation at the given index to the given time, updating its frame right away
+//
+void SpriteAnimBatch::SetSecondsElapsed(int animationIndex, float secondsElapsed)
+{
+	ASSERT_OR_DIE(IsValidIndex(animationIndex), Stringf("Error: SpriteAnimBatch::SetSecondsElapsed() called on invalid index %i", animationIndex));
+
+	m_secondsElapsed[animationIndex] = secondsElapsed;
+	m_flags[animationIndex] &= static_cast<uint8_t>(~SPRITE_ANIM_FLAG_FINISHED);
+
+	UpdateFrame(animationIndex);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the definition of the animation at the given index
+//
+const SpriteAnimDef* SpriteAnimBatch::GetDefinition(int animationIndex) const
+{
+	ASSERT_OR_DIE(IsValidIndex(animationIndex), Stringf("Error: SpriteAnimBatch::GetDefinition() called on invalid index %i", animationIndex));
+	return m_definitions[animationIndex];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the animation at the given index is advancing with Update()
+//
+bool SpriteAnimBatch::IsPlaying(int animationIndex) const
+{
+	ASSERT_OR_DIE(IsValidIndex(animationIndex), Stringf("Error: SpriteAnimBatch::IsPlaying() called on invalid index %i", animationIndex));
+	return (m_flags[animationIndex] & SPRITE_ANIM_FLAG_PLAYING) != 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the animation at the given index is play once and has played through
+//
+bool SpriteAnimBatch::IsFinished(int animationIndex) const
+{
+	ASSERT_OR_DIE(IsValidIndex(animationIndex), Stringf("Error: SpriteAnimBatch::IsFinished() called on invalid index %i", animationIndex));
+	return (m_flags[animationIndex] & SPRITE_ANIM_FLAG_FINISHED) != 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the time played of the animation at the given index since it last started
+//
+float SpriteAnimBatch::GetSecondsElapsed(int animationIndex) const
+{
+	ASSERT_OR_DIE(IsValidIndex(animationIndex), Stringf("Error: SpriteAnimBatch::GetSecondsElapsed() called on invalid index %i", animationIndex));
+	return m_secondsElapsed[animationIndex];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the index into its sequence of the frame the animation at the given index is on
+//
+int SpriteAnimBatch::GetFrameIndex(int animationIndex) const
+{
+	ASSERT_OR_DIE(IsValidIndex(animationIndex), Stringf("Error: SpriteAnimBatch::GetFrameIndex() called on invalid index %i", animationIndex));
+	return m_frameIndices[animationIndex];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the sprite sheet texture of the animation at the given index
+//
+const Texture& SpriteAnimBatch::GetTexture(int animationIndex) const
+{
+	return GetDefinition(animationIndex)->GetTexture();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the UVs of the frame the animation at the given index is on
+//
+AABB2 SpriteAnimBatch::GetCurrentUVs(int animationIndex) const
+{
+	return GetDefinition(animationIndex)->GetCurrentUVCoords(m_frameIndices[animationIndex]);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of animations in the batch
+//
+int SpriteAnimBatch::GetAnimationCount() const
+{
+	return static_cast<int>(m_definitions.size() - m_freeIndices.size());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of indices handed out, including those since removed
+//
+int SpriteAnimBatch::GetIndexCount() const
+{
+	return static_cast<int>(m_definitions.size());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the index refers to an animation in the batch
+//
+bool SpriteAnimBatch::IsValidIndex(int animationIndex) const
+{
+	return (animationIndex >= 0 && animationIndex < static_cast<int>(m_flags.size()) && (m_flags[animationIndex] & SPRITE_ANIM_FLAG_IN_USE) != 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Recalculates the frame of a single animation, for changes made between updates
+//
+void SpriteAnimBatch::UpdateFrame(int animationIndex)
+{
+	m_frameIndices[animationIndex] = SpriteAnim::CalculateFrameIndex(m_secondsElapsed[animationIndex], m_secondsPerFrame[animationIndex], m_durations[animationIndex], m_frameCounts[animationIndex]);
+}
@@ -0,0 +1,85 @@
+/************************************************************************/
+/* File: SpriteAnimBatch.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Playback state for many sprite animations on one shared
+/*				timeline, stored field by field so a frame's advance is a
+/*				couple of tight loops instead of an Update() per SpriteAnim
+/************************************************************************/
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "Engine/Math/AABB2.hpp"
+
+class Texture;
+class SpriteAnimDef;
+
+#define SPRITE_ANIM_BATCH_INVALID_INDEX (-1)
+
+
+class SpriteAnimBatch
+{
+public:
+	//-----Public Methods-----
+
+	SpriteAnimBatch() {}
+	~SpriteAnimBatch() {}
+
+	// Returns the index the animation is referred to by, which stays valid until it's removed
+	int				AddAnimation(const SpriteAnimDef* definition, bool playImmediately, float secondsElapsed = 0.f);
+	void			RemoveAnimation(int animationIndex);	// Frees the index for a later AddAnimation()
+	void			SetDefinition(int animationIndex, const SpriteAnimDef* definition);	// Restarts from the beginning, keeping whether it's playing
+	void			Reserve(int animationCount);
+
+	// Advances every playing animation by the same delta, and finds the frame each one is on
+	void			Update(float deltaSeconds);
+
+	void			Play(int animationIndex);
+	void			Pause(int animationIndex);
+	void			Reset(int animationIndex);
+	void			ResetAndPlay(int animationIndex);
+	void			SetSecondsElapsed(int animationIndex, float secondsElapsed);
+
+	// Frame data is as of the last Update() or change to the animation
+	const SpriteAnimDef*	GetDefinition(int animationIndex) const;
+	bool			IsPlaying(int animationIndex) const;
+	bool			IsFinished(int animationIndex) const;
+	float			GetSecondsElapsed(int animationIndex) const;
+	int				GetFrameIndex(int animationIndex) const;
+	const Texture&	GetTexture(int animationIndex) const;
+	AABB2			GetCurrentUVs(int animationIndex) const;
+
+	int				GetAnimationCount() const;	// Live animations only
+	int				GetIndexCount() const;		// Including freed indices, for iterating with IsValidIndex()
+	bool			IsValidIndex(int animationIndex) const;
+
+
+private:
+	//-----Private Methods-----
+
+	void			UpdateFrame(int animationIndex);
+
+
+private:
+	//-----Private Data-----
+
+	enum eSpriteAnimFlags : uint8_t
+	{
+		SPRITE_ANIM_FLAG_IN_USE		= (1 << 0),
+		SPRITE_ANIM_FLAG_PLAYING	= (1 << 1),
+		SPRITE_ANIM_FLAG_FINISHED	= (1 << 2),
+		SPRITE_ANIM_FLAG_PLAY_ONCE	= (1 << 3)
+	};
+
+	// One element per index; the timing is copied out of the definitions so Update() never touches them
+	std::vector<float>					m_secondsElapsed;
+	std::vector<float>					m_secondsPerFrame;
+	std::vector<float>					m_durations;
+	std::vector<int>					m_frameCounts;
+	std::vector<int>					m_frameIndices;
+	std::vector<uint8_t>				m_flags;
+	std::vector<const SpriteAnimDef*>	m_definitions;
+
+	std::vector<int>					m_freeIndices;
+
+};
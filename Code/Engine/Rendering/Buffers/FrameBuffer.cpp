@@ -4,8 +4,10 @@
 /* Date: February 13th, 2018
 /* Description: Implementation of the FrameBuffer class
 /************************************************************************/
+#include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Rendering/Buffers/FrameBuffer.hpp"
 #include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include "Engine/Rendering/OpenGL/GLStateCache.hpp"
 #include "Engine/Rendering/Resources/Texture.hpp"
 
 
@@ -17,7 +19,14 @@ FrameBuffer::FrameBuffer()
 	, m_depthTarget(nullptr)
 	, m_width(0)
 	, m_height(0)
+	, m_viewport(AABB2::UNIT_SQUARE_OFFCENTER)
+	, m_resolutionScale(1.0f)
 {
+	for (int targetIndex = 0; targetIndex < FRAME_BUFFER_MAX_ADDITIONAL_COLOR_TARGETS; ++targetIndex)
+	{
+		m_additionalColorTargets[targetIndex] = nullptr;
+	}
+
 	glGenFramebuffers( 1, &m_handle ); 
 }
 
@@ -28,6 +37,7 @@ FrameBuffer::FrameBuffer()
 FrameBuffer::~FrameBuffer()
 {
 	glDeleteFramebuffers( 1, &m_handle ); 
+	GLStateCache::OnFramebufferDeleted(m_handle);
 }
 
 
@@ -49,6 +59,52 @@ void FrameBuffer::SetDepthTarget(Texture* depthTarget)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Sets the color target drawn to by fragment output index + 1; they should match the first target's size
+//
+void FrameBuffer::SetAdditionalColorTarget(unsigned int index, Texture* colorTarget)
+{
+	ASSERT_OR_DIE(index < FRAME_BUFFER_MAX_ADDITIONAL_COLOR_TARGETS, Stringf("Error: FrameBuffer::SetAdditionalColorTarget() received index %u, only %i are supported", index, FRAME_BUFFER_MAX_ADDITIONAL_COLOR_TARGETS));
+	m_additionalColorTargets[index] = colorTarget;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the region of the targets to draw to, in normalized (0..1) coordinates of their dimensions
+//
+void FrameBuffer::SetViewport(const AABB2& normalizedViewport)
+{
+	m_viewport = normalizedViewport;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the fraction of each axis of the targets drawn to; the viewport is scaled by it, so a
+// scaled scene is in the bottom left of the targets
+//
+void FrameBuffer::SetResolutionScale(float resolutionScale)
+{
+	m_resolutionScale = resolutionScale;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the texel rect of the targets drawn to
+// One target should be present (at least) and they should match
+//
+void FrameBuffer::GetPixelViewport(int& out_x, int& out_y, int& out_width, int& out_height) const
+{
+	IntVector2 dimensions = (m_colorTarget != nullptr ? m_colorTarget->GetDimensions() : m_depthTarget->GetDimensions());
+	float scaledWidth = m_resolutionScale * (float) dimensions.x;
+	float scaledHeight = m_resolutionScale * (float) dimensions.y;
+
+	out_x		= (int) (m_viewport.mins.x * scaledWidth);
+	out_y		= (int) (m_viewport.mins.y * scaledHeight);
+	out_width	= (int) (m_viewport.maxs.x * scaledWidth) - out_x;
+	out_height	= (int) (m_viewport.maxs.y * scaledHeight) - out_y;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the width of the color target (depth target should match it)
 //
@@ -93,26 +149,20 @@ bool FrameBuffer::Finalize()
 	GL_CHECK_ERROR();
 
 	// Set the viewport, based on the dimensions of the targets
-	// One target should be present (at least) and they should match
-	if (m_colorTarget != nullptr)
-	{
-		IntVector2 dimensions = m_colorTarget->GetDimensions();
-		glViewport(0, 0, dimensions.x, dimensions.y);
-	}
-	else
-	{
-		IntVector2 dimensions = m_depthTarget->GetDimensions();
-		glViewport(0, 0, dimensions.x, dimensions.y);
-	}
+	int viewportX, viewportY, viewportWidth, viewportHeight;
+	GetPixelViewport(viewportX, viewportY, viewportWidth, viewportHeight);
+
+	glViewport(viewportX, viewportY, viewportWidth, viewportHeight);
 
 	GL_CHECK_ERROR();
 
-	glBindFramebuffer( GL_FRAMEBUFFER, m_handle ); 
+	GLStateCache::BindFramebuffer(m_handle);
 
 	GL_CHECK_ERROR();
 
 	// keep track of which outputs go to which attachments; 
-	GLenum targets[1]; 
+	GLenum targets[1 + FRAME_BUFFER_MAX_ADDITIONAL_COLOR_TARGETS]; 
+	int numTargets = 1;
 
 	// Bind a color target to an attachment point
 	// and keep track of which locations to to which attachments. 
@@ -125,8 +175,23 @@ bool FrameBuffer::Finalize()
 
 	GL_CHECK_ERROR();
 
+	// Any others go to the attachments after, in order; unused ones are detached so a reused framebuffer doesn't keep them
+	for (int targetIndex = 0; targetIndex < FRAME_BUFFER_MAX_ADDITIONAL_COLOR_TARGETS; ++targetIndex)
+	{
+		Texture* target = m_additionalColorTargets[targetIndex];
+		glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1 + targetIndex, (target == nullptr ? NULL : target->GetHandle()), 0);
+
+		targets[1 + targetIndex] = (target == nullptr ? GL_NONE : GL_COLOR_ATTACHMENT1 + targetIndex);
+		if (target != nullptr)
+		{
+			numTargets = 2 + targetIndex;
+		}
+	}
+
+	GL_CHECK_ERROR();
+
 	// Update target bindings
-	glDrawBuffers( 1, targets ); 
+	glDrawBuffers( numTargets, targets ); 
 	
 	GL_CHECK_ERROR();
 
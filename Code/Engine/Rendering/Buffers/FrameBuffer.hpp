@@ -5,9 +5,13 @@
 /* Description: Class to represent a color/depth render target
 /************************************************************************/
 #pragma once
+#include "Engine/Math/AABB2.hpp"
 
 class Texture;
 
+// Color attachments past the first, for drawing to several targets at once (i.e. a G-buffer)
+#define FRAME_BUFFER_MAX_ADDITIONAL_COLOR_TARGETS (3)
+
 class FrameBuffer
 {
 public:
@@ -18,6 +22,12 @@ public:
 
 	void SetColorTarget(Texture* color_target); 
 	void SetDepthTarget(Texture* depth_target); 
+	void SetAdditionalColorTarget(unsigned int index, Texture* colorTarget);	// Attachment index + 1, nullptr to remove
+	void SetViewport(const AABB2& normalizedViewport);
+	void SetResolutionScale(float resolutionScale);		// Shrinks the viewport toward the targets' origin, for dynamic resolution
+
+	// Texel rect of the targets drawn to, the viewport after the resolution scale
+	void			GetPixelViewport(int& out_x, int& out_y, int& out_width, int& out_height) const;
 
 	unsigned int	GetWidth() const;
 	unsigned int	GetHeight() const;
@@ -33,7 +43,11 @@ public:
 	unsigned int	m_handle; 
 	Texture*		m_colorTarget; 
 	Texture*		m_depthTarget;
+	Texture*		m_additionalColorTargets[FRAME_BUFFER_MAX_ADDITIONAL_COLOR_TARGETS];
 
 	unsigned int	m_width;
 	unsigned int	m_height;
+
+	AABB2			m_viewport;		// Region of the targets drawn to, in 0..1 of their dimensions
+	float			m_resolutionScale;
 };
\ No newline at end of file
@@ -0,0 +1,233 @@
+/************************************************************************/
+/* File: GPUReadbackQueue.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the GPUReadbackQueue class
+/************************************************************************/
+#include <thread>
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/JobSystem/JobSystem.hpp"
+#include "Engine/Core/JobSystem/FunctionJob.hpp"
+#include "Engine/Rendering/Resources/Texture.hpp"
+#include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include "Engine/Rendering/OpenGL/GLStateCache.hpp"
+#include "Engine/Rendering/Buffers/RenderBuffer.hpp"
+#include "Engine/Rendering/Buffers/GPUReadbackQueue.hpp"
+
+GPUReadbackQueue::Readback_t	GPUReadbackQueue::s_readbacks[GPU_READBACK_MAX_IN_FLIGHT];
+GLuint							GPUReadbackQueue::s_readFramebuffer = NULL;
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads the texture into a free pixel buffer; the copy runs on the GPU, and the buffer isn't
+// touched by the CPU until its fence has passed
+//
+bool GPUReadbackQueue::QueueTextureReadback(const Texture* texture, GPUReadbackFinishedCallback callback, void* userData /*= nullptr*/)
+{
+	ASSERT_OR_DIE(texture != nullptr && callback != nullptr, "Error: GPUReadbackQueue::QueueTextureReadback() needs a texture and a callback");
+
+	Readback_t* readback = nullptr;
+	for (int readbackIndex = 0; readbackIndex < GPU_READBACK_MAX_IN_FLIGHT; ++readbackIndex)
+	{
+		if (s_readbacks[readbackIndex].state == READBACK_STATE_FREE)
+		{
+			readback = &s_readbacks[readbackIndex];
+			break;
+		}
+	}
+
+	if (readback == nullptr)
+	{
+		LogTaggedPrintf("RENDER", "Warning: GPUReadbackQueue has %i readbacks in flight, dropped a readback", GPU_READBACK_MAX_IN_FLIGHT);
+		return false;
+	}
+
+	IntVector2 dimensions = texture->GetDimensions();
+	size_t byteCount = (size_t) dimensions.x * (size_t) dimensions.y * 4;
+
+	// Buffers are kept between readbacks, only growing
+	if (readback->buffer == nullptr)
+	{
+		readback->buffer = new RenderBuffer();
+	}
+
+	if (readback->buffer->GetSize() < byteCount)
+	{
+		readback->buffer->AllocateOnGPU(byteCount);
+	}
+
+	if (s_readFramebuffer == NULL)
+	{
+		glGenFramebuffers(1, &s_readFramebuffer);
+	}
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, s_readFramebuffer);
+	glFramebufferTexture(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, texture->GetHandle(), 0);
+	GLStateCache::InvalidateFramebuffer();
+
+	// With a pack buffer bound the pixels go into it, and glReadPixels returns without waiting
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->buffer->GetHandle());
+	glReadPixels(0, 0, dimensions.x, dimensions.y, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, NULL);
+
+	glFramebufferTexture(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, NULL, 0);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, NULL);
+	GL_CHECK_ERROR();
+
+	readback->state = READBACK_STATE_WAITING_FOR_GPU;
+	readback->dimensions = dimensions;
+	readback->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	readback->callback = callback;
+	readback->userData = userData;
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Polls the fences without waiting, starting the callbacks of the finished readbacks
+//
+void GPUReadbackQueue::Update()
+{
+	for (int readbackIndex = 0; readbackIndex < GPU_READBACK_MAX_IN_FLIGHT; ++readbackIndex)
+	{
+		Readback_t& readback = s_readbacks[readbackIndex];
+
+		if (readback.state == READBACK_STATE_WAITING_FOR_GPU)
+		{
+			GLenum waitResult = glClientWaitSync(readback.fence, 0, 0);
+			if (waitResult == GL_ALREADY_SIGNALED || waitResult == GL_CONDITION_SATISFIED)
+			{
+				StartCallback(readback);
+			}
+		}
+		else if (readback.state == READBACK_STATE_IN_CALLBACK && readback.isCallbackFinished)
+		{
+			FinishReadback(readback);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finishes every readback in flight, waiting on the GPU and the callbacks
+//
+void GPUReadbackQueue::Shutdown()
+{
+	for (int readbackIndex = 0; readbackIndex < GPU_READBACK_MAX_IN_FLIGHT; ++readbackIndex)
+	{
+		Readback_t& readback = s_readbacks[readbackIndex];
+
+		if (readback.state == READBACK_STATE_WAITING_FOR_GPU)
+		{
+			glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+			StartCallback(readback);
+		}
+
+		while (readback.state == READBACK_STATE_IN_CALLBACK && !readback.isCallbackFinished)
+		{
+			std::this_thread::yield();
+		}
+
+		if (readback.state == READBACK_STATE_IN_CALLBACK)
+		{
+			FinishReadback(readback);
+		}
+
+		delete readback.buffer;
+		readback.buffer = nullptr;
+	}
+
+	if (s_readFramebuffer != NULL)
+	{
+		glDeleteFramebuffers(1, &s_readFramebuffer);
+		GLStateCache::OnFramebufferDeleted(s_readFramebuffer);
+		s_readFramebuffer = NULL;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of readbacks waiting on the GPU or their callbacks
+//
+int GPUReadbackQueue::GetInFlightCount()
+{
+	int inFlightCount = 0;
+
+	for (int readbackIndex = 0; readbackIndex < GPU_READBACK_MAX_IN_FLIGHT; ++readbackIndex)
+	{
+		if (s_readbacks[readbackIndex].state != READBACK_STATE_FREE)
+		{
+			inFlightCount++;
+		}
+	}
+
+	return inFlightCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Maps the finished buffer and runs the callback on a worker straight out of the mapping, so the
+// texels are never copied on the render thread
+//
+void GPUReadbackQueue::StartCallback(Readback_t& readback)
+{
+	glDeleteSync(readback.fence);
+	readback.fence = nullptr;
+
+	size_t byteCount = (size_t) readback.dimensions.x * (size_t) readback.dimensions.y * 4;
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer->GetHandle());
+	readback.mappedTexels = (const unsigned char*) glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, byteCount, GL_MAP_READ_BIT);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, NULL);
+	GL_CHECK_ERROR();
+
+	readback.state = READBACK_STATE_IN_CALLBACK;
+	readback.isCallbackFinished = false;
+
+	if (readback.mappedTexels == nullptr)
+	{
+		LogTaggedPrintf("RENDER", "Error: GPUReadbackQueue couldn't map a finished readback, dropped it");
+		readback.isCallbackFinished = true;
+		return;
+	}
+
+	Readback_t* readbackPtr = &readback;
+	auto runCallback = [readbackPtr]()
+	{
+		readbackPtr->callback(readbackPtr->mappedTexels, readbackPtr->dimensions, readbackPtr->userData);
+		readbackPtr->isCallbackFinished = true;
+	};
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	if (jobSystem != nullptr)
+	{
+		jobSystem->QueueJob(new FunctionJob(runCallback, JOB_PRIORITY_BACKGROUND, WORKER_FLAGS_DISK));
+	}
+	else
+	{
+		runCallback();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Unmaps the buffer of a readback whose callback has returned, freeing it for the next readback
+//
+void GPUReadbackQueue::FinishReadback(Readback_t& readback)
+{
+	if (readback.mappedTexels != nullptr)
+	{
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer->GetHandle());
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, NULL);
+		GL_CHECK_ERROR();
+
+		readback.mappedTexels = nullptr;
+	}
+
+	readback.callback = nullptr;
+	readback.userData = nullptr;
+	readback.state = READBACK_STATE_FREE;
+}
@@ -0,0 +1,81 @@
+/************************************************************************/
+/* File: GPUReadbackQueue.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Reads textures back to the CPU through pixel buffers,
+/*				handing the texels to a worker once the GPU has written
+/*				them instead of stalling the frame on glReadPixels
+/************************************************************************/
+#pragma once
+#include <atomic>
+#include "Engine/Math/IntVector2.hpp"
+#include "ThirdParty/gl/glcorearb.h"
+
+class Texture;
+class RenderBuffer;
+
+// Each readback in flight holds a pixel buffer, reused once its callback returns
+#define GPU_READBACK_MAX_IN_FLIGHT (4)
+
+// Called on a disk worker thread (or the render thread without a JobSystem) once the texels are on the CPU
+// Texels are RGBA8, bottom row first, and only valid for the call
+typedef void(*GPUReadbackFinishedCallback)(const unsigned char* texels, const IntVector2& dimensions, void* userData);
+
+class GPUReadbackQueue
+{
+public:
+	//-----Public Methods-----
+
+	// Render thread only
+	// Queues a copy of the RGBA8 color texture's current contents; returns false if too many readbacks are in flight
+	static bool	QueueTextureReadback(const Texture* texture, GPUReadbackFinishedCallback callback, void* userData = nullptr);
+
+	// Hands readbacks the GPU has finished to workers, and recycles the ones whose callbacks have returned
+	// Called by the Renderer each frame
+	static void	Update();
+	static void	Shutdown();		// Waits on every readback in flight, running their callbacks
+
+	static int	GetInFlightCount();
+
+
+private:
+	//-----Private Types-----
+
+	enum eReadbackState
+	{
+		READBACK_STATE_FREE,
+		READBACK_STATE_WAITING_FOR_GPU,
+		READBACK_STATE_IN_CALLBACK
+	};
+
+	struct Readback_t
+	{
+		eReadbackState				state = READBACK_STATE_FREE;
+		RenderBuffer*				buffer = nullptr;			// Made on first use, kept between readbacks
+		IntVector2					dimensions;
+		GLsync						fence = nullptr;
+
+		GPUReadbackFinishedCallback	callback = nullptr;
+		void*						userData = nullptr;
+
+		const unsigned char*		mappedTexels = nullptr;		// The buffer stays mapped while the worker reads it
+		std::atomic<bool>			isCallbackFinished{ false };
+	};
+
+
+private:
+	//-----Private Methods-----
+
+	GPUReadbackQueue() {}
+
+	static void	StartCallback(Readback_t& readback);
+	static void	FinishReadback(Readback_t& readback);
+
+
+private:
+	//-----Private Data-----
+
+	static Readback_t	s_readbacks[GPU_READBACK_MAX_IN_FLIGHT];
+	static GLuint		s_readFramebuffer;		// Textures are attached to this to be read
+
+};
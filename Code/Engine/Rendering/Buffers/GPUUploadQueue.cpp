@@ -0,0 +1,721 @@
+/************************************************************************/
+/* File: GPUUploadQueue.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the GPUUploadQueue class
+/************************************************************************/
+#include <string.h>
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/Core/Vertex.hpp"
+#include "Engine/Rendering/Meshes/Mesh.hpp"
+#include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include "Engine/Rendering/OpenGL/GLStateCache.hpp"
+#include "Engine/Core/Time/ProfileCounters.hpp"
+#include "Engine/Rendering/Resources/Texture.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
+#include "Engine/Rendering/Buffers/RenderBuffer.hpp"
+#include "Engine/Rendering/Buffers/GPUUploadQueue.hpp"
+
+// Pieces start at this alignment in the staging buffer, enough for any texel or vertex format's copies
+#define GPU_UPLOAD_STAGING_ALIGNMENT (16)
+
+// C Functions
+unsigned int CalculateMipLevelCount(const IntVector2& dimensions);
+
+std::mutex					GPUUploadQueue::s_queueLock;
+std::vector<GPUUpload_t*>	GPUUploadQueue::s_queuedUploads;
+int							GPUUploadQueue::s_nextUploadID = 0;
+std::vector<GPUUpload_t*>	GPUUploadQueue::s_pendingUploads;
+GPUUploadStagingSlot_t		GPUUploadQueue::s_stagingSlots[GPU_UPLOAD_STAGING_SLOT_COUNT];
+int							GPUUploadQueue::s_nextSlotIndex = 0;
+uint64_t					GPUUploadQueue::s_submittedSerial = 0;
+uint64_t					GPUUploadQueue::s_completedSerial = 0;
+size_t						GPUUploadQueue::s_frameByteBudget = GPU_UPLOAD_DEFAULT_FRAME_BUDGET_BYTES;
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the byte count rounded up to the staging alignment
+//
+static inline size_t AlignToStaging(size_t byteCount)
+{
+	return (byteCount + (GPU_UPLOAD_STAGING_ALIGNMENT - 1)) & ~((size_t) GPU_UPLOAD_STAGING_ALIGNMENT - 1);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies the texels to be uploaded into a new texture that replaces the given one's when finished
+// Texels are tightly packed rows of numComponents bytes a texel, bottom row first
+//
+int GPUUploadQueue::QueueTextureUpload(Texture* texture, const IntVector2& dimensions, unsigned int numComponents, const unsigned char* texels,
+	bool useMipMaps, GPUUploadFinishedCallback callback /*= nullptr*/, void* userData /*= nullptr*/)
+{
+	ASSERT_OR_DIE(dimensions.x > 0 && dimensions.y > 0, "Error: GPUUploadQueue::QueueTextureUpload() called with an empty texture");
+	ASSERT_OR_DIE(numComponents >= 1 && numComponents <= 4, Stringf("Error: GPUUploadQueue::QueueTextureUpload() called with %u components", numComponents));
+	ASSERT_OR_DIE((size_t) dimensions.x * numComponents <= GPU_UPLOAD_STAGING_SLOT_BYTES, "Error: GPUUploadQueue::QueueTextureUpload() called with rows wider than a staging buffer");
+
+	size_t byteCount = (size_t) dimensions.x * (size_t) dimensions.y * numComponents;
+
+	GPUUpload_t* upload = new GPUUpload_t();
+	upload->type = GPU_UPLOAD_TEXTURE;
+	upload->resource = texture;
+	upload->data.assign(texels, texels + byteCount);
+	upload->dimensions = dimensions;
+	upload->numComponents = numComponents;
+	upload->useMipMaps = useMipMaps;
+	upload->callback = callback;
+	upload->userData = userData;
+
+	return PushQueuedUpload(upload);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies the vertices and indices into an upload for the mesh, indices going right after the vertices
+//
+int GPUUploadQueue::QueueMeshUploadInternal(Mesh* mesh, const VertexLayout* layout, unsigned int vertexCount, const void* vertices,
+	unsigned int indexCount, const unsigned int* indices, const DrawInstruction& drawInstruction, GPUUploadFinishedCallback callback, void* userData)
+{
+	ASSERT_OR_DIE(vertexCount > 0, "Error: GPUUploadQueue::QueueMeshUpload() called with no vertices");
+
+	size_t vertexByteCount = (size_t) vertexCount * layout->GetStride();
+	size_t indexByteCount = (size_t) indexCount * sizeof(unsigned int);
+
+	GPUUpload_t* upload = new GPUUpload_t();
+	upload->type = GPU_UPLOAD_MESH;
+	upload->resource = mesh;
+	upload->data.resize(vertexByteCount + indexByteCount);
+	memcpy(upload->data.data(), vertices, vertexByteCount);
+
+	if (indexByteCount > 0)
+	{
+		memcpy(upload->data.data() + vertexByteCount, indices, indexByteCount);
+	}
+
+	upload->vertexLayout = layout;
+	upload->vertexCount = vertexCount;
+	upload->indexCount = indexCount;
+	upload->drawInstruction = drawInstruction;
+	upload->callback = callback;
+	upload->userData = userData;
+
+	return PushQueuedUpload(upload);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Gives the upload its ID and adds it to the queue, for the render thread to pick up
+//
+int GPUUploadQueue::PushQueuedUpload(GPUUpload_t* upload)
+{
+	std::lock_guard<std::mutex> lock(s_queueLock);
+
+	upload->id = s_nextUploadID++;
+	s_queuedUploads.push_back(upload);
+
+	return upload->id;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finishes the uploads whose copies the GPU is done with, then stages more for this frame
+//
+void GPUUploadQueue::Update()
+{
+	PROFILE_SCOPE_CATEGORY("GPUUploadQueue::Update", "Rendering");
+
+	{
+		std::lock_guard<std::mutex> lock(s_queueLock);
+		s_pendingUploads.insert(s_pendingUploads.end(), s_queuedUploads.begin(), s_queuedUploads.end());
+		s_queuedUploads.clear();
+	}
+
+	PollStagingFences();
+	FinishCompletedUploads();
+	StageUploads();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes the staging ring and every upload not yet finished, while the context still exists
+//
+void GPUUploadQueue::Shutdown()
+{
+	{
+		std::lock_guard<std::mutex> lock(s_queueLock);
+		s_pendingUploads.insert(s_pendingUploads.end(), s_queuedUploads.begin(), s_queuedUploads.end());
+		s_queuedUploads.clear();
+	}
+
+	for (GPUUpload_t* upload : s_pendingUploads)
+	{
+		DestroyUpload(upload);
+	}
+
+	s_pendingUploads.clear();
+
+	for (int slotIndex = 0; slotIndex < GPU_UPLOAD_STAGING_SLOT_COUNT; ++slotIndex)
+	{
+		GPUUploadStagingSlot_t& slot = s_stagingSlots[slotIndex];
+
+		if (slot.fence != nullptr)
+		{
+			glDeleteSync(slot.fence);
+			slot.fence = nullptr;
+		}
+
+		delete slot.buffer;
+		slot.buffer = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Drops the resource's unfinished uploads, leaving it with whatever it has now
+//
+void GPUUploadQueue::CancelUploads(const void* resource)
+{
+	{
+		std::lock_guard<std::mutex> lock(s_queueLock);
+
+		for (int uploadIndex = (int) s_queuedUploads.size() - 1; uploadIndex >= 0; --uploadIndex)
+		{
+			if (s_queuedUploads[uploadIndex]->resource == resource)
+			{
+				DestroyUpload(s_queuedUploads[uploadIndex]);
+				s_queuedUploads.erase(s_queuedUploads.begin() + uploadIndex);
+			}
+		}
+	}
+
+	// Staged pieces already copied into the upload's own storage, which nothing else references
+	for (int uploadIndex = (int) s_pendingUploads.size() - 1; uploadIndex >= 0; --uploadIndex)
+	{
+		if (s_pendingUploads[uploadIndex]->resource == resource)
+		{
+			DestroyUpload(s_pendingUploads[uploadIndex]);
+			s_pendingUploads.erase(s_pendingUploads.begin() + uploadIndex);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Called when a texture or mesh is deleted, so its uploads don't write into freed memory
+//
+void GPUUploadQueue::OnResourceDestroyed(const void* resource)
+{
+	CancelUploads(resource);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true once the upload has been swapped into its resource, or was cancelled
+//
+bool GPUUploadQueue::IsUploadFinished(int uploadID)
+{
+	std::lock_guard<std::mutex> lock(s_queueLock);
+
+	if (uploadID < 0 || uploadID >= s_nextUploadID)
+	{
+		return false;
+	}
+
+	for (const GPUUpload_t* upload : s_queuedUploads)
+	{
+		if (upload->id == uploadID)
+		{
+			return false;
+		}
+	}
+
+	for (const GPUUpload_t* upload : s_pendingUploads)
+	{
+		if (upload->id == uploadID)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the resource has any upload not yet finished
+//
+bool GPUUploadQueue::HasPendingUploads(const void* resource)
+{
+	std::lock_guard<std::mutex> lock(s_queueLock);
+
+	for (const GPUUpload_t* upload : s_queuedUploads)
+	{
+		if (upload->resource == resource)
+		{
+			return true;
+		}
+	}
+
+	for (const GPUUpload_t* upload : s_pendingUploads)
+	{
+		if (upload->resource == resource)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of uploads queued or in progress
+//
+int GPUUploadQueue::GetPendingUploadCount()
+{
+	std::lock_guard<std::mutex> lock(s_queueLock);
+	return (int) (s_queuedUploads.size() + s_pendingUploads.size());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of bytes left to stage across all uploads
+//
+size_t GPUUploadQueue::GetPendingByteCount()
+{
+	std::lock_guard<std::mutex> lock(s_queueLock);
+
+	size_t byteCount = 0;
+
+	for (const GPUUpload_t* upload : s_queuedUploads)
+	{
+		byteCount += upload->data.size();
+	}
+
+	for (const GPUUpload_t* upload : s_pendingUploads)
+	{
+		byteCount += upload->data.size() - upload->bytesStaged;
+	}
+
+	return byteCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the most bytes staged in a frame, capped at the size of a staging buffer
+//
+void GPUUploadQueue::SetFrameByteBudget(size_t byteBudget)
+{
+	ASSERT_OR_DIE(byteBudget > 0, "Error: GPUUploadQueue::SetFrameByteBudget() called with a budget of 0");
+	s_frameByteBudget = (byteBudget < GPU_UPLOAD_STAGING_SLOT_BYTES ? byteBudget : GPU_UPLOAD_STAGING_SLOT_BYTES);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the most bytes staged in a frame
+//
+size_t GPUUploadQueue::GetFrameByteBudget()
+{
+	return s_frameByteBudget;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Checks the staging fences without waiting, freeing the slots the GPU is done copying out of
+// Fences pass in submission order, so the newest that has passed covers every slot before it
+//
+void GPUUploadQueue::PollStagingFences()
+{
+	for (int slotIndex = 0; slotIndex < GPU_UPLOAD_STAGING_SLOT_COUNT; ++slotIndex)
+	{
+		GPUUploadStagingSlot_t& slot = s_stagingSlots[slotIndex];
+
+		if (slot.fence == nullptr)
+		{
+			continue;
+		}
+
+		GLenum waitResult = glClientWaitSync(slot.fence, 0, 0);
+		if (waitResult == GL_ALREADY_SIGNALED || waitResult == GL_CONDITION_SATISFIED)
+		{
+			glDeleteSync(slot.fence);
+			slot.fence = nullptr;
+
+			if (slot.serial > s_completedSerial)
+			{
+				s_completedSerial = slot.serial;
+			}
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Swaps in every upload that's fully staged and whose last copies have completed
+//
+void GPUUploadQueue::FinishCompletedUploads()
+{
+	for (int uploadIndex = 0; uploadIndex < (int) s_pendingUploads.size();)
+	{
+		GPUUpload_t* upload = s_pendingUploads[uploadIndex];
+
+		bool isFullyStaged = (upload->bytesStaged == upload->data.size());
+		if (isFullyStaged && upload->lastStagedSerial <= s_completedSerial)
+		{
+			s_pendingUploads.erase(s_pendingUploads.begin() + uploadIndex);
+			FinishUpload(upload);
+		}
+		else
+		{
+			uploadIndex++;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Fills this frame's staging slot with the next pieces of the pending uploads, oldest first, then
+// copies them to their storage and fences the slot; skipped when the slot's last copies haven't
+// passed, rather than stalling the frame on them
+//
+void GPUUploadQueue::StageUploads()
+{
+	if (s_pendingUploads.size() == 0)
+	{
+		return;
+	}
+
+	GPUUploadStagingSlot_t& slot = s_stagingSlots[s_nextSlotIndex];
+	if (slot.fence != nullptr)
+	{
+		return;
+	}
+
+	if (slot.buffer == nullptr)
+	{
+		slot.buffer = new RenderBuffer();
+		slot.buffer->AllocateOnGPU(GPU_UPLOAD_STAGING_SLOT_BYTES);
+	}
+
+	struct StagedPiece_t
+	{
+		GPUUpload_t*	upload;
+		size_t			stagingOffset;
+		size_t			uploadOffset;
+		size_t			byteCount;
+	};
+
+	std::vector<StagedPiece_t> pieces;
+	std::vector<GPUUpload_t*> arenaUploads;
+
+	size_t bytesLeft = s_frameByteBudget;
+	uint8_t* stagingData = nullptr;
+	size_t stagingTop = 0;
+	size_t stagedByteCount = 0;
+
+	for (GPUUpload_t* upload : s_pendingUploads)
+	{
+		if (upload->bytesStaged == upload->data.size())
+		{
+			continue;
+		}
+
+		// Alignment padding counts against the staging buffer, not the budget
+		size_t slotBytesLeft = GPU_UPLOAD_STAGING_SLOT_BYTES - stagingTop;
+		if (bytesLeft > slotBytesLeft)
+		{
+			bytesLeft = slotBytesLeft;
+		}
+
+		bool isFirstPiece = (pieces.size() == 0 && arenaUploads.size() == 0);
+		size_t pieceByteCount = GetNextPieceByteCount(upload, bytesLeft, isFirstPiece);
+
+		if (pieceByteCount == 0)
+		{
+			break;
+		}
+
+		// Meshes stored in an arena are written into it directly, in one go
+		if (upload->type == GPU_UPLOAD_MESH && ((Mesh*) upload->resource)->IsStoredInArena())
+		{
+			arenaUploads.push_back(upload);
+			bytesLeft -= (pieceByteCount < bytesLeft ? pieceByteCount : bytesLeft);
+			continue;
+		}
+
+		if (stagingData == nullptr)
+		{
+			glBindBuffer(GL_COPY_WRITE_BUFFER, slot.buffer->GetHandle());
+			stagingData = (uint8_t*) glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, GPU_UPLOAD_STAGING_SLOT_BYTES, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+			GL_CHECK_ERROR();
+
+			if (stagingData == nullptr)
+			{
+				LogTaggedPrintf("RENDER", "Error: GPUUploadQueue couldn't map staging buffer %i", s_nextSlotIndex);
+				glBindBuffer(GL_COPY_WRITE_BUFFER, NULL);
+				return;
+			}
+		}
+
+		StagedPiece_t piece;
+		piece.upload = upload;
+		piece.stagingOffset = stagingTop;
+		piece.uploadOffset = upload->bytesStaged;
+		piece.byteCount = pieceByteCount;
+		pieces.push_back(piece);
+
+		memcpy(stagingData + stagingTop, upload->data.data() + upload->bytesStaged, pieceByteCount);
+		upload->bytesStaged += pieceByteCount;
+		stagedByteCount += pieceByteCount;
+
+		stagingTop = AlignToStaging(stagingTop + pieceByteCount);
+		bytesLeft -= (pieceByteCount < bytesLeft ? pieceByteCount : bytesLeft);
+
+		if (bytesLeft == 0 || stagingTop >= GPU_UPLOAD_STAGING_SLOT_BYTES)
+		{
+			break;
+		}
+	}
+
+	// Copies can only read the staging buffer once it's unmapped
+	if (stagingData != nullptr)
+	{
+		glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, NULL);
+		GL_CHECK_ERROR();
+	}
+
+	if (pieces.size() > 0)
+	{
+		s_submittedSerial++;
+
+		for (const StagedPiece_t& piece : pieces)
+		{
+			CopyPiece(piece.upload, slot.buffer->GetHandle(), piece.stagingOffset, piece.uploadOffset, piece.byteCount);
+			piece.upload->lastStagedSerial = s_submittedSerial;
+		}
+
+		slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		slot.serial = s_submittedSerial;
+		s_nextSlotIndex = (s_nextSlotIndex + 1) % GPU_UPLOAD_STAGING_SLOT_COUNT;
+
+		PROFILE_COUNTER_ADD(PROFILE_COUNTER_BYTES_UPLOADED, stagedByteCount);
+	}
+
+	// Arena writes go through the driver's own copy, so they're done as far as the GPU's ordering goes
+	for (GPUUpload_t* upload : arenaUploads)
+	{
+		upload->bytesStaged = upload->data.size();
+
+		for (int uploadIndex = 0; uploadIndex < (int) s_pendingUploads.size(); ++uploadIndex)
+		{
+			if (s_pendingUploads[uploadIndex] == upload)
+			{
+				s_pendingUploads.erase(s_pendingUploads.begin() + uploadIndex);
+				break;
+			}
+		}
+
+		FinishUpload(upload);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns how much of the upload's remaining data to stage next within the bytes left
+// Textures are staged in whole rows, and arena meshes all at once; the first piece of a frame is
+// always taken so one larger than the budget still goes through
+//
+size_t GPUUploadQueue::GetNextPieceByteCount(const GPUUpload_t* upload, size_t bytesLeft, bool isFirstPiece)
+{
+	size_t bytesRemaining = upload->data.size() - upload->bytesStaged;
+
+	if (upload->type == GPU_UPLOAD_MESH && ((const Mesh*) upload->resource)->IsStoredInArena())
+	{
+		return ((isFirstPiece || bytesRemaining <= bytesLeft) ? bytesRemaining : 0);
+	}
+
+	if (upload->type == GPU_UPLOAD_TEXTURE)
+	{
+		size_t rowByteCount = (size_t) upload->dimensions.x * upload->numComponents;
+		size_t rowCount = (bytesLeft < bytesRemaining ? bytesLeft : bytesRemaining) / rowByteCount;
+
+		if (rowCount == 0 && isFirstPiece)
+		{
+			rowCount = 1;
+		}
+
+		return rowCount * rowByteCount;
+	}
+
+	// Buffer copies are kept a multiple of 4 bytes, except for the end of the data
+	size_t byteCount = (bytesLeft < bytesRemaining ? bytesLeft : bytesRemaining);
+	if (byteCount < bytesRemaining)
+	{
+		byteCount &= ~((size_t) 3);
+	}
+
+	return byteCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Makes the storage the upload's pieces are copied into, before its first piece
+//
+void GPUUploadQueue::CreateStorage(GPUUpload_t* upload)
+{
+	if (upload->type == GPU_UPLOAD_TEXTURE)
+	{
+		TextureFormat format = static_cast<TextureFormat>(upload->numComponents - 1);
+
+		upload->mipLevelCount = (upload->useMipMaps ? CalculateMipLevelCount(upload->dimensions) : 1);
+		if (upload->mipLevelCount == 0)
+		{
+			upload->mipLevelCount = 1;
+		}
+
+		glGenTextures(1, &upload->textureHandle);
+
+		GLStateCache::SetActiveTextureUnit(0);
+		GLStateCache::BindTexture(0, GL_TEXTURE_2D, upload->textureHandle);
+
+		glTexStorage2D(GL_TEXTURE_2D, upload->mipLevelCount, ToGLInternalFormat(format), upload->dimensions.x, upload->dimensions.y);
+		GL_CHECK_ERROR();
+
+		GLStateCache::BindTexture(0, GL_TEXTURE_2D, NULL);
+	}
+	else
+	{
+		size_t vertexByteCount = (size_t) upload->vertexCount * upload->vertexLayout->GetStride();
+		size_t indexByteCount = (size_t) upload->indexCount * sizeof(unsigned int);
+
+		upload->vertexBuffer = new RenderBuffer();
+		upload->vertexBuffer->AllocateOnGPU(vertexByteCount);
+
+		if (indexByteCount > 0)
+		{
+			upload->indexBuffer = new RenderBuffer();
+			upload->indexBuffer->AllocateOnGPU(indexByteCount);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies a staged piece from the staging buffer into the upload's storage
+// Mesh pieces may straddle the end of the vertices, and are split between the two buffers
+//
+void GPUUploadQueue::CopyPiece(GPUUpload_t* upload, GLuint stagingHandle, size_t stagingOffset, size_t uploadOffset, size_t byteCount)
+{
+	if (uploadOffset == 0)
+	{
+		CreateStorage(upload);
+	}
+
+	if (upload->type == GPU_UPLOAD_TEXTURE)
+	{
+		TextureFormat format = static_cast<TextureFormat>(upload->numComponents - 1);
+		size_t rowByteCount = (size_t) upload->dimensions.x * upload->numComponents;
+
+		GLStateCache::SetActiveTextureUnit(0);
+		GLStateCache::BindTexture(0, GL_TEXTURE_2D, upload->textureHandle);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stagingHandle);
+
+		// Rows are tightly packed, whatever their width
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+		glTexSubImage2D(GL_TEXTURE_2D, 0,
+			0, (GLint) (uploadOffset / rowByteCount),
+			upload->dimensions.x, (GLsizei) (byteCount / rowByteCount),
+			ToGLChannel(format), ToGLPixelLayout(format),
+			(const void*) stagingOffset);		// Offset into the unpack buffer
+		GL_CHECK_ERROR();
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, NULL);
+
+		if (upload->useMipMaps && uploadOffset + byteCount == upload->data.size())
+		{
+			glGenerateMipmap(GL_TEXTURE_2D);
+		}
+
+		GLStateCache::BindTexture(0, GL_TEXTURE_2D, NULL);
+	}
+	else
+	{
+		size_t vertexByteCount = upload->vertexBuffer->GetSize();
+
+		if (uploadOffset < vertexByteCount)
+		{
+			size_t vertexPieceByteCount = (uploadOffset + byteCount <= vertexByteCount ? byteCount : vertexByteCount - uploadOffset);
+			upload->vertexBuffer->CopySubDataFromGPUBuffer(vertexPieceByteCount, stagingHandle, stagingOffset, uploadOffset);
+
+			stagingOffset += vertexPieceByteCount;
+			uploadOffset += vertexPieceByteCount;
+			byteCount -= vertexPieceByteCount;
+		}
+
+		if (byteCount > 0)
+		{
+			upload->indexBuffer->CopySubDataFromGPUBuffer(byteCount, stagingHandle, stagingOffset, uploadOffset - vertexByteCount);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Swaps the upload's data into its resource, calls its callback and deletes it
+//
+void GPUUploadQueue::FinishUpload(GPUUpload_t* upload)
+{
+	if (upload->type == GPU_UPLOAD_TEXTURE)
+	{
+		Texture* texture = (Texture*) upload->resource;
+		texture->TakeUploadedTexture(upload->textureHandle, upload->dimensions, static_cast<TextureFormat>(upload->numComponents - 1), upload->mipLevelCount);
+		upload->textureHandle = NULL;
+	}
+	else
+	{
+		Mesh* mesh = (Mesh*) upload->resource;
+
+		if (mesh->IsStoredInArena())
+		{
+			const unsigned int* indices = (const unsigned int*) (upload->data.data() + (size_t) upload->vertexCount * upload->vertexLayout->GetStride());
+
+			mesh->SetArenaVertices(upload->vertexLayout, upload->vertexCount, upload->data.data());
+			mesh->SetPositionQuantization(Vector3::ZERO, Vector3::ONES);
+			mesh->SetIndices(upload->indexCount, indices);
+		}
+		else
+		{
+			// The mesh's old buffers go into the upload's, and are freed with it
+			mesh->TakeUploadedBuffers(upload->vertexLayout, upload->vertexCount, *upload->vertexBuffer, upload->indexCount, upload->indexBuffer);
+		}
+
+		mesh->SetDrawInstruction(upload->drawInstruction);
+	}
+
+	if (upload->callback != nullptr)
+	{
+		upload->callback(upload->id, upload->userData);
+	}
+
+	DestroyUpload(upload);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Frees the upload and any storage it still holds
+//
+void GPUUploadQueue::DestroyUpload(GPUUpload_t* upload)
+{
+	if (upload->textureHandle != NULL)
+	{
+		glDeleteTextures(1, &upload->textureHandle);
+		GLStateCache::OnTextureDeleted(upload->textureHandle);
+	}
+
+	delete upload->vertexBuffer;
+	delete upload->indexBuffer;
+	delete upload;
+}
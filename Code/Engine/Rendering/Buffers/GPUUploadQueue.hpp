@@ -0,0 +1,160 @@
+/************************************************************************/
+/* File: GPUUploadQueue.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Uploads texture and mesh data a budgeted number of bytes
+/*				a frame through a ring of staging buffers, swapping each
+/*				resource's new storage in once its fence has passed
+/************************************************************************/
+#pragma once
+#include <mutex>
+#include <vector>
+#include <stdint.h>
+#include "Engine/Math/IntVector2.hpp"
+#include "ThirdParty/gl/glcorearb.h"
+#include "Engine/Rendering/Meshes/Mesh.hpp"
+
+class Texture;
+class RenderBuffer;
+class VertexLayout;
+
+// Staging is a ring of buffers, one filled a frame, so the CPU never writes one the GPU may still be reading
+#define GPU_UPLOAD_STAGING_SLOT_COUNT (3)
+#define GPU_UPLOAD_STAGING_SLOT_BYTES ((size_t) 8 * 1024 * 1024)
+#define GPU_UPLOAD_DEFAULT_FRAME_BUDGET_BYTES ((size_t) 4 * 1024 * 1024)
+
+#define GPU_UPLOAD_INVALID_ID (-1)
+
+// Called on the render thread once the resource has its new data and can be drawn with it
+typedef void(*GPUUploadFinishedCallback)(int uploadID, void* userData);
+
+enum eGPUUploadType
+{
+	GPU_UPLOAD_TEXTURE,
+	GPU_UPLOAD_MESH
+};
+
+struct GPUUpload_t
+{
+	int							id = GPU_UPLOAD_INVALID_ID;
+	eGPUUploadType				type = GPU_UPLOAD_TEXTURE;
+	void*						resource = nullptr;
+	std::vector<uint8_t>		data;				// Texels bottom row first, or the vertices followed by the indices
+	size_t						bytesStaged = 0;
+	uint64_t					lastStagedSerial = 0;
+
+	GPUUploadFinishedCallback	callback = nullptr;
+	void*						userData = nullptr;
+
+	// Textures - uploaded into a texture of the queue's, which replaces the resource's once finished
+	IntVector2					dimensions = IntVector2::ZERO;
+	unsigned int				numComponents = 0;
+	bool						useMipMaps = false;
+	unsigned int				mipLevelCount = 0;
+	GLuint						textureHandle = NULL;
+
+	// Meshes - same, with buffers the mesh takes over
+	const VertexLayout*			vertexLayout = nullptr;
+	unsigned int				vertexCount = 0;
+	unsigned int				indexCount = 0;
+	DrawInstruction				drawInstruction;
+	RenderBuffer*				vertexBuffer = nullptr;
+	RenderBuffer*				indexBuffer = nullptr;
+};
+
+// One buffer of the staging ring, and the fence for the copies made out of it
+struct GPUUploadStagingSlot_t
+{
+	RenderBuffer*	buffer = nullptr;
+	GLsync			fence = nullptr;
+	uint64_t		serial = 0;
+};
+
+
+class GPUUploadQueue
+{
+public:
+	//-----Public Methods-----
+
+	// Queuing may be done from any thread, the data is copied; the resource keeps what it has until the upload finishes
+	// Returns the upload's ID, for IsUploadFinished()
+	static int		QueueTextureUpload(Texture* texture, const IntVector2& dimensions, unsigned int numComponents, const unsigned char* texels,
+						bool useMipMaps, GPUUploadFinishedCallback callback = nullptr, void* userData = nullptr);
+
+	template <typename VERT_TYPE>
+	static int		QueueMeshUpload(Mesh* mesh, unsigned int vertexCount, const VERT_TYPE* vertices, unsigned int indexCount, const unsigned int* indices,
+						const DrawInstruction& drawInstruction, GPUUploadFinishedCallback callback = nullptr, void* userData = nullptr);
+
+	// Render thread only, from here down
+	// Swaps in the finished uploads, then stages and copies up to the frame's budget; called by the Renderer each frame
+	static void		Update();
+	static void		Shutdown();
+
+	// Drops any uploads not yet finished for the resource, so they won't overwrite data set directly
+	static void		CancelUploads(const void* resource);
+	static void		OnResourceDestroyed(const void* resource);
+
+	static bool		IsUploadFinished(int uploadID);
+	static bool		HasPendingUploads(const void* resource);
+	static int		GetPendingUploadCount();
+	static size_t	GetPendingByteCount();
+
+	static void		SetFrameByteBudget(size_t byteBudget);
+	static size_t	GetFrameByteBudget();
+
+
+private:
+	//-----Private Methods-----
+
+	GPUUploadQueue() {}
+
+	static int		QueueMeshUploadInternal(Mesh* mesh, const VertexLayout* layout, unsigned int vertexCount, const void* vertices,
+						unsigned int indexCount, const unsigned int* indices, const DrawInstruction& drawInstruction,
+						GPUUploadFinishedCallback callback, void* userData);
+	static int		PushQueuedUpload(GPUUpload_t* upload);
+
+	static void		PollStagingFences();
+	static void		FinishCompletedUploads();
+	static void		StageUploads();
+
+	// Returns the bytes of the upload's next piece that fit in the budget left, 0 if none do
+	static size_t	GetNextPieceByteCount(const GPUUpload_t* upload, size_t bytesLeft, bool isFirstPiece);
+	static void		CreateStorage(GPUUpload_t* upload);
+	static void		CopyPiece(GPUUpload_t* upload, GLuint stagingHandle, size_t stagingOffset, size_t uploadOffset, size_t byteCount);
+
+	static void		FinishUpload(GPUUpload_t* upload);
+	static void		DestroyUpload(GPUUpload_t* upload);
+
+
+private:
+	//-----Private Data-----
+
+	// Queued from any thread, moved to the pending list on the render thread
+	static std::mutex					s_queueLock;
+	static std::vector<GPUUpload_t*>	s_queuedUploads;
+	static int							s_nextUploadID;
+
+	// Staged in order, an upload is finished once the fence of the last frame it was staged in has passed
+	static std::vector<GPUUpload_t*>	s_pendingUploads;
+
+	static GPUUploadStagingSlot_t		s_stagingSlots[GPU_UPLOAD_STAGING_SLOT_COUNT];
+	static int							s_nextSlotIndex;
+	static uint64_t						s_submittedSerial;
+	static uint64_t						s_completedSerial;
+
+	static size_t						s_frameByteBudget;
+
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues the vertices and indices to replace the mesh's, with the draw instruction it'll take along with them
+// Meshes stored in the MeshArena can't be staged into buffers of their own, so theirs are written straight into
+// the arena when their turn comes, still within the frame's budget
+//
+template <typename VERT_TYPE>
+int GPUUploadQueue::QueueMeshUpload(Mesh* mesh, unsigned int vertexCount, const VERT_TYPE* vertices, unsigned int indexCount, const unsigned int* indices,
+	const DrawInstruction& drawInstruction, GPUUploadFinishedCallback callback /*= nullptr*/, void* userData /*= nullptr*/)
+{
+	return QueueMeshUploadInternal(mesh, &VERT_TYPE::LAYOUT, vertexCount, vertices, indexCount, indices, drawInstruction, callback, userData);
+}
@@ -0,0 +1,238 @@
+/************************************************************************/
+/* File: InstanceDataStream.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the InstanceDataStream class
+/************************************************************************/
+#include <string.h>
+#include "Engine/Math/Vector4.hpp"
+#include "Engine/Math/Matrix44.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include "Engine/Rendering/Buffers/RenderBuffer.hpp"
+#include "Engine/Rendering/Buffers/InstanceDataStream.hpp"
+
+RenderBuffer*	InstanceDataStream::s_buffers[NUM_INSTANCE_STREAMS];
+uint8_t*		InstanceDataStream::s_mappedData[NUM_INSTANCE_STREAMS];
+const size_t	InstanceDataStream::s_elementSizes[NUM_INSTANCE_STREAMS] = { sizeof(Matrix44), sizeof(uint32_t), sizeof(Vector4) };
+
+GLsync			InstanceDataStream::s_fences[INSTANCE_STREAM_FRAME_COUNT];
+int				InstanceDataStream::s_frameIndex = 0;
+
+int				InstanceDataStream::s_writtenInstanceCount = 0;
+int				InstanceDataStream::s_overflowCount = 0;
+int				InstanceDataStream::s_lastFrameInstanceCount = 0;
+int				InstanceDataStream::s_lastFrameOverflowCount = 0;
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies the instances to the end of this frame's range; streams not given are left as they are,
+// since a draw without them doesn't read them
+//
+int InstanceDataStream::Write(const Matrix44* matrices, const uint32_t* boneOffsets, const Vector4* customData, int instanceCount)
+{
+	ASSERT_OR_DIE(matrices != nullptr && instanceCount > 0, "Error: InstanceDataStream::Write() needs instances to write");
+
+	if (s_writtenInstanceCount + instanceCount > INSTANCE_STREAM_MAX_INSTANCES_PER_FRAME)
+	{
+		s_overflowCount++;
+		return -1;
+	}
+
+	if (s_buffers[INSTANCE_STREAM_MATRICES] == nullptr)
+	{
+		Initialize();
+	}
+
+	int baseInstance = s_frameIndex * INSTANCE_STREAM_MAX_INSTANCES_PER_FRAME + s_writtenInstanceCount;
+
+	WriteStream(INSTANCE_STREAM_MATRICES, baseInstance, matrices, instanceCount);
+
+	if (boneOffsets != nullptr)
+	{
+		WriteStream(INSTANCE_STREAM_BONE_OFFSETS, baseInstance, boneOffsets, instanceCount);
+	}
+
+	if (customData != nullptr)
+	{
+		WriteStream(INSTANCE_STREAM_CUSTOM_DATA, baseInstance, customData, instanceCount);
+	}
+
+	s_writtenInstanceCount += instanceCount;
+
+	return baseInstance;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the handle of the stream's buffer, making the buffers if this is the first use
+//
+GLuint InstanceDataStream::GetBufferHandle(eInstanceStream stream)
+{
+	if (s_buffers[stream] == nullptr)
+	{
+		Initialize();
+	}
+
+	return s_buffers[stream]->GetHandle();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Moves on to the next frame's range, waiting out the GPU if it's still reading it from
+// INSTANCE_STREAM_FRAME_COUNT frames ago
+//
+void InstanceDataStream::BeginFrame()
+{
+	s_lastFrameInstanceCount = s_writtenInstanceCount;
+	s_lastFrameOverflowCount = s_overflowCount;
+
+	if (s_overflowCount > 0)
+	{
+		LogTaggedPrintf("RENDER", "InstanceDataStream was full for %i draws last frame, they uploaded their own instances", s_overflowCount);
+	}
+
+	s_frameIndex = (s_frameIndex + 1) % INSTANCE_STREAM_FRAME_COUNT;
+
+	if (s_fences[s_frameIndex] != nullptr)
+	{
+		// Almost always already signaled this long after
+		glClientWaitSync(s_fences[s_frameIndex], GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+		glDeleteSync(s_fences[s_frameIndex]);
+		s_fences[s_frameIndex] = nullptr;
+	}
+
+	s_writtenInstanceCount = 0;
+	s_overflowCount = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Fences the frame's range, so it isn't written again until the GPU is done with the frame
+//
+void InstanceDataStream::EndFrame()
+{
+	if (s_writtenInstanceCount > 0 && s_fences[s_frameIndex] == nullptr)
+	{
+		s_fences[s_frameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes the buffers and fences; needs the context, so is called before it's destroyed
+// Deleting a buffer unmaps it
+//
+void InstanceDataStream::Shutdown()
+{
+	for (int frameIndex = 0; frameIndex < INSTANCE_STREAM_FRAME_COUNT; ++frameIndex)
+	{
+		if (s_fences[frameIndex] != nullptr)
+		{
+			glDeleteSync(s_fences[frameIndex]);
+			s_fences[frameIndex] = nullptr;
+		}
+	}
+
+	for (int streamIndex = 0; streamIndex < NUM_INSTANCE_STREAMS; ++streamIndex)
+	{
+		if (s_buffers[streamIndex] != nullptr)
+		{
+			delete s_buffers[streamIndex];
+			s_buffers[streamIndex] = nullptr;
+		}
+
+		s_mappedData[streamIndex] = nullptr;
+	}
+
+	s_writtenInstanceCount = 0;
+	s_overflowCount = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the buffers are written through persistent mappings instead of mapped each write
+//
+bool InstanceDataStream::IsPersistentlyMapped()
+{
+	return (s_mappedData[INSTANCE_STREAM_MATRICES] != nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of instances written last frame
+//
+int InstanceDataStream::GetLastFrameInstanceCount()
+{
+	return s_lastFrameInstanceCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of writes last frame that didn't fit in the frame's range
+//
+int InstanceDataStream::GetLastFrameOverflowCount()
+{
+	return s_lastFrameOverflowCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Makes the buffers, sized for every frame's range; persistently mapped if the driver can,
+// otherwise allocated once and mapped unsynchronized on each write
+//
+void InstanceDataStream::Initialize()
+{
+	size_t instanceCapacity = (size_t) INSTANCE_STREAM_FRAME_COUNT * INSTANCE_STREAM_MAX_INSTANCES_PER_FRAME;
+
+	for (int streamIndex = 0; streamIndex < NUM_INSTANCE_STREAMS; ++streamIndex)
+	{
+		s_buffers[streamIndex] = new RenderBuffer();
+
+		size_t byteCount = instanceCapacity * s_elementSizes[streamIndex];
+		s_mappedData[streamIndex] = (uint8_t*) s_buffers[streamIndex]->AllocatePersistentOnGPU(byteCount);
+
+		if (s_mappedData[streamIndex] == nullptr)
+		{
+			s_buffers[streamIndex]->AllocateOnGPU(byteCount);
+		}
+	}
+
+	LogTaggedPrintf("RENDER", "InstanceDataStream made for %i instances a frame, %s", INSTANCE_STREAM_MAX_INSTANCES_PER_FRAME, (IsPersistentlyMapped() ? "persistently mapped" : "mapped per write"));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies the data into the stream's buffer at the given instance
+// The range hasn't been used by a draw this frame, and the fence saw the GPU finish with it last
+// time around, so without a persistent mapping it's written unsynchronized
+//
+void InstanceDataStream::WriteStream(eInstanceStream stream, int firstInstance, const void* data, int instanceCount)
+{
+	size_t byteOffset = (size_t) firstInstance * s_elementSizes[stream];
+	size_t byteCount = (size_t) instanceCount * s_elementSizes[stream];
+
+	if (s_mappedData[stream] != nullptr)
+	{
+		// Coherent, so visible to draws issued after this
+		memcpy(s_mappedData[stream] + byteOffset, data, byteCount);
+		return;
+	}
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, s_buffers[stream]->GetHandle());
+	void* destination = glMapBufferRange(GL_COPY_WRITE_BUFFER, byteOffset, byteCount, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+
+	if (destination != nullptr)
+	{
+		memcpy(destination, data, byteCount);
+		glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+	}
+	else
+	{
+		glBufferSubData(GL_COPY_WRITE_BUFFER, byteOffset, byteCount, data);
+	}
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, NULL);
+	GL_CHECK_ERROR();
+}
@@ -0,0 +1,76 @@
+/************************************************************************/
+/* File: InstanceDataStream.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Per-frame ring of instance data - model matrices, bone
+/*				offsets and custom data - that every instanced draw of the
+/*				frame streams into, drawing from its base instance
+/************************************************************************/
+#pragma once
+#include <stdint.h>
+#include "ThirdParty/gl/glcorearb.h"
+
+class Vector4;
+class Matrix44;
+class RenderBuffer;
+
+// A range of each buffer per frame in flight, so the CPU never writes instances the GPU may still be reading
+#define INSTANCE_STREAM_FRAME_COUNT (3)
+#define INSTANCE_STREAM_MAX_INSTANCES_PER_FRAME (32768)
+
+enum eInstanceStream
+{
+	INSTANCE_STREAM_MATRICES,			// Matrix44, INSTANCE_MODEL_MATRIX
+	INSTANCE_STREAM_BONE_OFFSETS,		// uint32_t, INSTANCE_BONE_OFFSET
+	INSTANCE_STREAM_CUSTOM_DATA,		// Vector4, INSTANCE_CUSTOM_DATA
+	NUM_INSTANCE_STREAMS
+};
+
+class InstanceDataStream
+{
+public:
+	//-----Public Methods-----
+
+	// Render thread only
+	// Copies the instances into this frame's range of each stream given, returning the base instance
+	// to draw them from; -1 once the frame's range is full, the draw then uploads them itself
+	static int		Write(const Matrix44* matrices, const uint32_t* boneOffsets, const Vector4* customData, int instanceCount);
+
+	// Buffers are the same every frame, so VAOs can point at them once with no offset
+	static GLuint	GetBufferHandle(eInstanceStream stream);
+
+	// Called by the Renderer each frame
+	static void		BeginFrame();
+	static void		EndFrame();
+	static void		Shutdown();
+
+	static bool		IsPersistentlyMapped();
+	static int		GetLastFrameInstanceCount();
+	static int		GetLastFrameOverflowCount();		// Draws that didn't fit
+
+
+private:
+	//-----Private Methods-----
+
+	InstanceDataStream() {}
+
+	static void	Initialize();
+	static void	WriteStream(eInstanceStream stream, int firstInstance, const void* data, int instanceCount);
+
+
+private:
+	//-----Private Data-----
+
+	static RenderBuffer*	s_buffers[NUM_INSTANCE_STREAMS];
+	static uint8_t*			s_mappedData[NUM_INSTANCE_STREAMS];		// Persistent mappings, nullptr without ARB_buffer_storage
+	static const size_t		s_elementSizes[NUM_INSTANCE_STREAMS];
+
+	static GLsync			s_fences[INSTANCE_STREAM_FRAME_COUNT];		// Signaled once the GPU is done with the frame's draws
+	static int				s_frameIndex;
+
+	static int				s_writtenInstanceCount;
+	static int				s_overflowCount;
+	static int				s_lastFrameInstanceCount;
+	static int				s_lastFrameOverflowCount;
+
+};
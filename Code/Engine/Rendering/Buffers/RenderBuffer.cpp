@@ -7,13 +7,16 @@
 /************************************************************************/
 #include "Engine/Rendering/Buffers/RenderBuffer.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time/ProfileCounters.hpp"
 #include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include "Engine/Rendering/OpenGL/GLStateCache.hpp"
 
 
 //-----------------------------------------------------------------------------------------------
 // Constructor - automatically generates a handle to a GPU-side buffer
 //
 RenderBuffer::RenderBuffer()
+	: m_bufferSize(0)
 {
 	glGenBuffers( 1, &m_handle ); 
 	GL_CHECK_ERROR();
@@ -28,6 +31,7 @@ RenderBuffer::~RenderBuffer()
 	// cleanup for a buffer; 
 	if (m_handle != NULL) {
 		glDeleteBuffers( 1, &m_handle ); 
+		GLStateCache::OnBufferDeleted(m_handle);
 		m_handle = NULL; 
 	}
 }
@@ -76,6 +80,9 @@ bool RenderBuffer::CopyToGPU( size_t const byte_count, void const *data)
 
 	GL_CHECK_ERROR();
 
+	PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_BUFFER_UPLOADS);
+	PROFILE_COUNTER_ADD(PROFILE_COUNTER_BYTES_UPLOADED, byte_count);
+
 	// buffer_size is a size_t member variable I keep around for 
 	// convenience
 	m_bufferSize = byte_count; 
@@ -107,6 +114,104 @@ bool RenderBuffer::CopyFromGPUBuffer(size_t const byte_count, unsigned int sourc
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Resizes the buffer on the GPU to the given size, discarding its contents
+//
+bool RenderBuffer::AllocateOnGPU(size_t const byte_count)
+{
+	if (byte_count <= 0)
+	{
+		return false;
+	}
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_handle);
+	glBufferData(GL_COPY_WRITE_BUFFER, byte_count, NULL, GL_DYNAMIC_DRAW);
+	GL_CHECK_ERROR();
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, NULL);
+
+	m_bufferSize = byte_count;
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Allocates immutable storage that stays mapped, coherently, so writes through the mapping reach
+// the GPU without a flush or unmap; nothing can reallocate the buffer after
+//
+void* RenderBuffer::AllocatePersistentOnGPU(size_t const byte_count)
+{
+	if (byte_count <= 0 || glBufferStorage == nullptr)
+	{
+		return nullptr;
+	}
+
+	GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_handle);
+	glBufferStorage(GL_COPY_WRITE_BUFFER, byte_count, NULL, flags);
+	void* mappedData = glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, byte_count, flags);
+	GL_CHECK_ERROR();
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, NULL);
+
+	if (mappedData != nullptr)
+	{
+		m_bufferSize = byte_count;
+	}
+
+	return mappedData;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies a range of the buffer at sourceHandle into this buffer at the given offset, without
+// resizing this buffer; the range must fit in both buffers
+//
+bool RenderBuffer::CopySubDataFromGPUBuffer(size_t const byte_count, unsigned int sourceHandle, size_t sourceOffset, size_t destinationOffset)
+{
+	if (byte_count <= 0 || destinationOffset + byte_count > m_bufferSize)
+	{
+		return false;
+	}
+
+	glBindBuffer(GL_COPY_READ_BUFFER, sourceHandle);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_handle);
+
+	glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, sourceOffset, destinationOffset, byte_count);
+	GL_CHECK_ERROR();
+
+	glBindBuffer(GL_COPY_READ_BUFFER, NULL);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, NULL);
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies the data into this buffer at the given offset, without resizing this buffer; the range
+// must fit in the buffer
+//
+bool RenderBuffer::CopySubDataToGPU(size_t const byte_count, void const *data, size_t destinationOffset)
+{
+	if (byte_count <= 0 || destinationOffset + byte_count > m_bufferSize)
+	{
+		return false;
+	}
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_handle);
+	glBufferSubData(GL_COPY_WRITE_BUFFER, destinationOffset, byte_count, data);
+	GL_CHECK_ERROR();
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, NULL);
+
+	PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_BUFFER_UPLOADS);
+	PROFILE_COUNTER_ADD(PROFILE_COUNTER_BYTES_UPLOADED, byte_count);
+
+	return true;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Binds this buffer to the given bind slot
 //
@@ -117,6 +222,22 @@ void RenderBuffer::Bind(unsigned int bindSlot)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Exchanges the handles and sizes of the two buffers
+//
+void RenderBuffer::SwapStorage(RenderBuffer& other)
+{
+	GLuint handle = m_handle;
+	size_t bufferSize = m_bufferSize;
+
+	m_handle = other.m_handle;
+	m_bufferSize = other.m_bufferSize;
+
+	other.m_handle = handle;
+	other.m_bufferSize = bufferSize;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns a pointer to the head of the data on the GPU
 //
@@ -26,8 +26,20 @@ public:
 	// Copies the contents of buffer from sourceHandle into this buffer
 	bool CopyFromGPUBuffer(size_t const byte_count, unsigned int sourceHandle);
 
+	// Sizes the buffer without initializing it, and copies ranges between buffers
+	bool AllocateOnGPU(size_t const byte_count);
+	bool CopySubDataFromGPUBuffer(size_t const byte_count, unsigned int sourceHandle, size_t sourceOffset, size_t destinationOffset);
+	bool CopySubDataToGPU(size_t const byte_count, void const *data, size_t destinationOffset);
+
+	// Gives the buffer immutable storage mapped for writing for as long as it lives, returning the
+	// mapping; nullptr if the driver can't, then the buffer can still be mapped the usual way
+	void* AllocatePersistentOnGPU(size_t const byte_count);
+
 	void Bind(unsigned int bindSlot);
 
+	// Exchanges GPU buffers with the other, i.e. to swap in one filled elsewhere
+	void SwapStorage(RenderBuffer& other);
+
 	void*	MapBufferData();
 	void	UnmapBufferData();
 
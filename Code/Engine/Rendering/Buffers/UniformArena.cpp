@@ -0,0 +1,216 @@
+/************************************************************************/
+/* File: UniformArena.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the UniformArena class
+/************************************************************************/
+#include <string.h>
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include "Engine/Rendering/OpenGL/GLStateCache.hpp"
+#include "Engine/Rendering/Buffers/RenderBuffer.hpp"
+#include "Engine/Rendering/Buffers/UniformArena.hpp"
+
+UniformArena::ArenaFrame_t	UniformArena::s_frames[UNIFORM_ARENA_FRAME_COUNT];
+int							UniformArena::s_frameIndex = 0;
+uint64_t					UniformArena::s_frameNumber = 0;
+
+std::vector<uint8_t>		UniformArena::s_stagingData;
+size_t						UniformArena::s_writtenByteCount = 0;
+size_t						UniformArena::s_uploadedByteCount = 0;
+size_t						UniformArena::s_offsetAlignment = 0;
+
+size_t						UniformArena::s_lastFrameByteCount = 0;
+int							UniformArena::s_uploadCount = 0;
+int							UniformArena::s_lastFrameUploadCount = 0;
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies the data into the frame's staging data at the next aligned offset; nothing goes to the
+// GPU until a range that hasn't been uploaded is bound
+//
+size_t UniformArena::Write(const void* data, size_t byteCount)
+{
+	ASSERT_OR_DIE(data != nullptr && byteCount > 0, "Error: UniformArena::Write() needs data to write");
+
+	if (s_offsetAlignment == 0)
+	{
+		GLint alignment = 0;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		s_offsetAlignment = (alignment > 0 ? (size_t) alignment : 256);
+	}
+
+	size_t byteOffset = ((s_writtenByteCount + s_offsetAlignment - 1) / s_offsetAlignment) * s_offsetAlignment;
+	size_t writeEnd = byteOffset + byteCount;
+
+	if (s_stagingData.size() < writeEnd)
+	{
+		size_t newSize = (s_stagingData.size() > 0 ? s_stagingData.size() * 2 : UNIFORM_ARENA_INITIAL_BYTES);
+		s_stagingData.resize(newSize > writeEnd ? newSize : writeEnd);
+	}
+
+	memcpy(s_stagingData.data() + byteOffset, data, byteCount);
+	s_writtenByteCount = writeEnd;
+
+	return byteOffset;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Binds the range of this frame's buffer, skipped by the state cache if it's already bound
+//
+void UniformArena::BindRange(unsigned int bindSlot, size_t byteOffset, size_t byteCount)
+{
+	if (byteOffset + byteCount > s_uploadedByteCount)
+	{
+		UploadPendingWrites();
+	}
+
+	GLStateCache::BindUniformBufferRange(bindSlot, s_frames[s_frameIndex].buffer->GetHandle(), byteOffset, byteCount);
+	GL_CHECK_ERROR();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Moves on to the next frame's buffer, waiting out the GPU if it's still reading it from
+// UNIFORM_ARENA_FRAME_COUNT frames ago
+//
+void UniformArena::BeginFrame()
+{
+	s_lastFrameByteCount = s_writtenByteCount;
+	s_lastFrameUploadCount = s_uploadCount;
+
+	s_frameIndex = (s_frameIndex + 1) % UNIFORM_ARENA_FRAME_COUNT;
+	s_frameNumber++;
+
+	ArenaFrame_t& frame = s_frames[s_frameIndex];
+	if (frame.fence != nullptr)
+	{
+		// Almost always already signaled this long after
+		glClientWaitSync(frame.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+		glDeleteSync(frame.fence);
+		frame.fence = nullptr;
+	}
+
+	s_writtenByteCount = 0;
+	s_uploadedByteCount = 0;
+	s_uploadCount = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Fences the frame's buffer, so it isn't written again until the GPU is done with the frame
+//
+void UniformArena::EndFrame()
+{
+	ArenaFrame_t& frame = s_frames[s_frameIndex];
+
+	if (frame.buffer != nullptr && frame.fence == nullptr)
+	{
+		frame.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes the buffers and fences; needs the context, so is called before it's destroyed
+//
+void UniformArena::Shutdown()
+{
+	for (int frameIndex = 0; frameIndex < UNIFORM_ARENA_FRAME_COUNT; ++frameIndex)
+	{
+		ArenaFrame_t& frame = s_frames[frameIndex];
+
+		if (frame.fence != nullptr)
+		{
+			glDeleteSync(frame.fence);
+			frame.fence = nullptr;
+		}
+
+		if (frame.buffer != nullptr)
+		{
+			delete frame.buffer;
+			frame.buffer = nullptr;
+		}
+	}
+
+	s_stagingData.clear();
+	s_stagingData.shrink_to_fit();
+
+	s_writtenByteCount = 0;
+	s_uploadedByteCount = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of the current frame, for blocks checking whether they were written this frame
+//
+uint64_t UniformArena::GetFrameNumber()
+{
+	return s_frameNumber;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the bytes written to the arena last frame, alignment included
+//
+size_t UniformArena::GetLastFrameByteCount()
+{
+	return s_lastFrameByteCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of uploads made last frame, one per run of writes that a bind needed
+//
+int UniformArena::GetLastFrameUploadCount()
+{
+	return s_lastFrameUploadCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Uploads every write since the last upload in one go
+// The range hasn't been used by a draw this frame, and the fence saw the GPU finish with it last
+// time around, so it's written unsynchronized
+//
+void UniformArena::UploadPendingWrites()
+{
+	ArenaFrame_t& frame = s_frames[s_frameIndex];
+
+	if (frame.buffer == nullptr)
+	{
+		frame.buffer = new RenderBuffer();
+	}
+
+	if (frame.buffer->GetSize() < s_writtenByteCount)
+	{
+		// New storage - draws already made keep reading the old, but everything written this frame is uploaded again
+		frame.buffer->AllocateOnGPU(s_stagingData.size());
+		s_uploadedByteCount = 0;
+
+		LogTaggedPrintf("RENDER", "UniformArena buffer %i grew to %u KB", s_frameIndex, (unsigned int) (s_stagingData.size() / 1024));
+	}
+
+	size_t byteCount = s_writtenByteCount - s_uploadedByteCount;
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, frame.buffer->GetHandle());
+	void* destination = glMapBufferRange(GL_COPY_WRITE_BUFFER, s_uploadedByteCount, byteCount, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+
+	if (destination != nullptr)
+	{
+		memcpy(destination, s_stagingData.data() + s_uploadedByteCount, byteCount);
+		glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+	}
+	else
+	{
+		glBufferSubData(GL_COPY_WRITE_BUFFER, s_uploadedByteCount, byteCount, s_stagingData.data() + s_uploadedByteCount);
+	}
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, NULL);
+	GL_CHECK_ERROR();
+
+	s_uploadedByteCount = s_writtenByteCount;
+	s_uploadCount++;
+}
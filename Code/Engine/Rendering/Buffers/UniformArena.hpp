@@ -0,0 +1,77 @@
+/************************************************************************/
+/* File: UniformArena.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Per-frame uniform buffer that per-draw uniform data is
+/*				sub-allocated from, bound by range instead of each block
+/*				owning and re-uploading its own buffer
+/************************************************************************/
+#pragma once
+#include <vector>
+#include <stdint.h>
+#include "ThirdParty/gl/glcorearb.h"
+
+class RenderBuffer;
+
+// A buffer per frame in flight, so the CPU never writes a range the GPU may still be reading
+#define UNIFORM_ARENA_FRAME_COUNT (3)
+#define UNIFORM_ARENA_INITIAL_BYTES ((size_t) 1024 * 1024)
+
+class UniformArena
+{
+public:
+	//-----Public Methods-----
+
+	// Render thread only
+	// Copies the data into this frame's arena, returning its offset; aligned for binding
+	static size_t	Write(const void* data, size_t byteCount);
+
+	// Binds the written range, uploading everything written since the last upload first if it's needed
+	// Writes made before a run of draws therefore go up together
+	static void		BindRange(unsigned int bindSlot, size_t byteOffset, size_t byteCount);
+
+	// Called by the Renderer each frame
+	static void		BeginFrame();
+	static void		EndFrame();
+	static void		Shutdown();
+
+	static uint64_t	GetFrameNumber();				// Offsets are only valid during the frame they were written
+	static size_t	GetLastFrameByteCount();
+	static int		GetLastFrameUploadCount();
+
+
+private:
+	//-----Private Types-----
+
+	struct ArenaFrame_t
+	{
+		RenderBuffer*	buffer = nullptr;		// Made on first use, only grows
+		GLsync			fence = nullptr;		// Signaled once the GPU is done with the frame's draws
+	};
+
+
+private:
+	//-----Private Methods-----
+
+	UniformArena() {}
+
+	static void	UploadPendingWrites();
+
+
+private:
+	//-----Private Data-----
+
+	static ArenaFrame_t			s_frames[UNIFORM_ARENA_FRAME_COUNT];
+	static int					s_frameIndex;
+	static uint64_t				s_frameNumber;
+
+	static std::vector<uint8_t>	s_stagingData;			// This frame's writes, the GPU buffer gets the same layout
+	static size_t				s_writtenByteCount;
+	static size_t				s_uploadedByteCount;
+	static size_t				s_offsetAlignment;		// GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, queried on first write
+
+	static size_t				s_lastFrameByteCount;
+	static int					s_uploadCount;
+	static int					s_lastFrameUploadCount;
+
+};
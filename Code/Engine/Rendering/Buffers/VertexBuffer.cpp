@@ -24,3 +24,12 @@ void VertexBuffer::SetVertexCount(unsigned int vertexCount)
 	m_vertexCount = vertexCount;
 	m_bufferSize = m_vertexLayout->GetStride() * vertexCount;
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the layout of the vertices in the buffer, without changing its contents
+//
+void VertexBuffer::SetVertexLayout(const VertexLayout* layout)
+{
+	m_vertexLayout = layout;
+}
@@ -57,6 +57,7 @@ public:
 	}
 
 	void				SetVertexCount(unsigned int vertexCount);
+	void				SetVertexLayout(const VertexLayout* layout);
 
 	unsigned int		GetVertexCount() const { return m_vertexCount; }
 	const VertexLayout* GetVertexLayout() const { return m_vertexLayout; }
@@ -6,6 +6,7 @@
 /************************************************************************/
 #include "Game/Framework/EngineBuildPreferences.hpp"
 #include "Engine/Rendering/Core/Camera.hpp"
+#include "Engine/Rendering/Core/HiZBuffer.hpp"
 #include "Engine/Core/Window.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Math/MathUtils.hpp"
@@ -47,6 +48,19 @@ Camera::Camera()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+Camera::~Camera()
+{
+	if (m_occlusionBuffer != nullptr)
+	{
+		delete m_occlusionBuffer;
+		m_occlusionBuffer = nullptr;
+	}
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Moves the camera in world space, given the direction and speed
 //
@@ -111,6 +125,16 @@ void Camera::SetPosition(const Vector3& position)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Sets the position of the camera in double precision, for cameras far from the world origin
+//
+void Camera::SetPrecisePosition(const DoubleVector3& position)
+{
+	m_transform.SetPrecisePosition(position);
+	m_viewMatrix = InvertLookAtMatrix(m_transform.GetWorldMatrix());
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Sets the color target of the Camera's FrameBuffer to the one passed
 //
@@ -129,6 +153,15 @@ void Camera::SetDepthTarget(Texture* depthTarget)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Sets the region of the camera's targets to render to, in normalized (0..1) coordinates
+//
+void Camera::SetViewport(const AABB2& normalizedViewport)
+{
+	m_frameBuffer.SetViewport(normalizedViewport);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Finalizes the Camera's FrameBuffer
 //
@@ -257,6 +290,129 @@ void Camera::SetDrawOrder(unsigned int order)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Sets whether the ForwardRenderingPath draws this camera's opaque geometry depth-only first, so
+// the lit pass only shades the visible surfaces
+//
+void Camera::SetDepthPrepassEnabled(bool enabled)
+{
+	m_isDepthPrepassEnabled = enabled;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets whether the ForwardRenderingPath culls renderables hidden behind this camera's last frame
+// of depth; the depths are dropped when disabled, so stale ones are never used
+//
+void Camera::SetOcclusionCullingEnabled(bool enabled)
+{
+	m_isOcclusionCullingEnabled = enabled;
+
+	if (!enabled && m_occlusionBuffer != nullptr)
+	{
+		delete m_occlusionBuffer;
+		m_occlusionBuffer = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the depth pre-pass is enabled for this camera
+//
+bool Camera::IsDepthPrepassEnabled() const
+{
+	return m_isDepthPrepassEnabled;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if occlusion culling is enabled for this camera
+//
+bool Camera::IsOcclusionCullingEnabled() const
+{
+	return m_isOcclusionCullingEnabled;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets whether the ForwardRenderingPath shades this camera's lit opaque draws forward, or deferred
+//
+void Camera::SetRenderingPath(eRenderingPath path)
+{
+	m_renderingPath = path;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the path this camera's lit opaque draws are shaded with
+//
+eRenderingPath Camera::GetRenderingPath() const
+{
+	return m_renderingPath;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets this camera up to render the same view as the given one, keeping its own targets
+//
+void Camera::CopyViewFrom(const Camera* camera)
+{
+	// By world matrix, since the other camera's transform may be parented
+	SetCameraMatrix(camera->GetCameraMatrix());
+	m_viewMatrix = camera->m_viewMatrix;
+	m_projectionMatrix = camera->m_projectionMatrix;
+	m_changeOfBasisMatrix = camera->m_changeOfBasisMatrix;
+
+	m_nearClipZ = camera->m_nearClipZ;
+	m_farClipZ = camera->m_farClipZ;
+	m_isCameraRelativeRenderingEnabled = camera->m_isCameraRelativeRenderingEnabled;
+
+	m_frameBuffer.SetViewport(camera->m_frameBuffer.m_viewport);
+	m_frameBuffer.SetResolutionScale(camera->m_frameBuffer.m_resolutionScale);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets whether the camera renders at the origin, with everything drawn moved relative to it
+//
+void Camera::SetCameraRelativeRenderingEnabled(bool enabled)
+{
+	m_isCameraRelativeRenderingEnabled = enabled;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the camera renders at the origin
+//
+bool Camera::IsCameraRelativeRenderingEnabled() const
+{
+	return m_isCameraRelativeRenderingEnabled;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the buffer of this camera's last frame of depths, creating it if it doesn't exist
+//
+HiZBuffer* Camera::GetOcclusionBuffer()
+{
+	if (m_occlusionBuffer == nullptr)
+	{
+		m_occlusionBuffer = new HiZBuffer();
+	}
+
+	return m_occlusionBuffer;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the LODs this camera's view rendered the scene's draws at last frame, one per draw instance
+//
+std::vector<uint8_t>& Camera::GetLODHistory()
+{
+	return m_lodHistory;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Update the camera's uniform buffer with the camera's current state
 //
@@ -264,16 +420,27 @@ void Camera::FinalizeUniformBuffer()
 {
 	CameraBufferData bufferData;
 
-	bufferData.m_viewMatrix = m_changeOfBasisMatrix * m_viewMatrix;
+	// Camera relative rendering keeps the large translation out of the shaders entirely
+	Matrix44 viewMatrix = (m_isCameraRelativeRenderingEnabled ? GetRelativeViewMatrix() : m_viewMatrix);
+	Matrix44 cameraMatrix = m_transform.GetWorldMatrix();
+
+	if (m_isCameraRelativeRenderingEnabled)
+	{
+		cameraMatrix.Tx = 0.f;
+		cameraMatrix.Ty = 0.f;
+		cameraMatrix.Tz = 0.f;
+	}
+
+	bufferData.m_viewMatrix = m_changeOfBasisMatrix * viewMatrix;
 	bufferData.m_projectionMatrix = m_projectionMatrix; // Append change of basis!
-	bufferData.m_cameraMatrix = m_transform.GetWorldMatrix();
+	bufferData.m_cameraMatrix = cameraMatrix;
 
 	bufferData.m_cameraX	= GetIVector();
 	bufferData.m_cameraY	= GetJVector();
 	bufferData.m_cameraZ	= GetKVector();
-	bufferData.m_cameraPosition = m_transform.position;
+	bufferData.m_cameraPosition = (m_isCameraRelativeRenderingEnabled ? Vector3::ZERO : m_transform.position);
 
-	bufferData.m_inverseViewProjection = Matrix44::GetInverse(m_viewMatrix) * Matrix44::GetInverse(m_projectionMatrix * m_changeOfBasisMatrix);
+	bufferData.m_inverseViewProjection = Matrix44::GetInverseAffine(viewMatrix) * Matrix44::GetInverse(m_projectionMatrix * m_changeOfBasisMatrix);
 	
 	m_uniformBuffer.SetCPUAndGPUData(sizeof(CameraBufferData), &bufferData);
 }
@@ -316,6 +483,15 @@ Matrix44 Camera::GetProjectionMatrix() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the world space view volume of the camera, for culling
+//
+Frustum Camera::GetFrustum() const
+{
+	return Frustum(m_projectionMatrix * m_viewMatrix);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the position of the camera
 //
@@ -325,6 +501,47 @@ Vector3 Camera::GetPosition() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the double precision world position of the camera
+//
+DoubleVector3 Camera::GetPrecisePosition() const
+{
+	return m_transform.GetPreciseWorldPosition();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the view matrix of the camera as if it were at the origin, for camera relative rendering
+//
+Matrix44 Camera::GetRelativeViewMatrix() const
+{
+	Matrix44 cameraMatrix = m_transform.GetWorldMatrix();
+
+	cameraMatrix.Tx = 0.f;
+	cameraMatrix.Ty = 0.f;
+	cameraMatrix.Tz = 0.f;
+
+	return InvertLookAtMatrix(cameraMatrix);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the model matrix (relative to worldOrigin) moved to be relative to this camera instead,
+// with the offset between the two taken in double precision
+//
+Matrix44 Camera::GetRelativeModelMatrix(const Matrix44& model, const DoubleVector3& worldOrigin) const
+{
+	Vector3 originOffset = (worldOrigin - GetPrecisePosition()).ToVector3();
+
+	Matrix44 relativeModel = model;
+	relativeModel.Tx += originOffset.x;
+	relativeModel.Ty += originOffset.y;
+	relativeModel.Tz += originOffset.z;
+
+	return relativeModel;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the rotation of the camera's transform
 //
@@ -5,6 +5,9 @@
 /* Description: Class to represent a draw-to buffer with projection
 /************************************************************************/
 #pragma once
+#include <vector>
+#include <stdint.h>
+#include "Engine/Math/Frustum.hpp"
 #include "Engine/Math/Matrix44.hpp"
 #include "Engine/Math/Transform.hpp"
 #include "Engine/Math/FloatRange.hpp"
@@ -13,6 +16,14 @@
 
 class Texture;
 class Matrix44;
+class HiZBuffer;
+
+// How the scene path shades a camera's lit opaque draws
+enum eRenderingPath
+{
+	RENDERING_PATH_FORWARD,		// Each draw lights its own fragments
+	RENDERING_PATH_DEFERRED		// Deferrable draws write a G-buffer, lit once per pixel after; the rest still draw forward
+};
 
 class Camera
 {
@@ -20,7 +31,7 @@ public:
 	//-----Public Methods-----
 
 	Camera();
-	~Camera() {}
+	~Camera();
 
 	// Movement
 	void					TranslateWorld(const Vector3& worldTranslation);
@@ -31,9 +42,11 @@ public:
 
 	void					SetTransform(const Transform& transform);
 	void					SetPosition(const Vector3& position);
+	void					SetPrecisePosition(const DoubleVector3& position);
 
 	void					SetColorTarget(Texture* color_target);
 	void					SetDepthTarget(Texture* depth_target);
+	void					SetViewport(const AABB2& normalizedViewport);
 
 	// Buffers
 	void					FinalizeFrameBuffer();
@@ -58,11 +71,35 @@ public:
 
 	void					SetDrawOrder(unsigned int order);
 
+	// Forward rendering options
+	void					SetDepthPrepassEnabled(bool enabled);
+	void					SetOcclusionCullingEnabled(bool enabled);
+	bool					IsDepthPrepassEnabled() const;
+	bool					IsOcclusionCullingEnabled() const;
+
+	void					SetRenderingPath(eRenderingPath path);
+	eRenderingPath			GetRenderingPath() const;
+
+	// Takes the other camera's view, projection, viewport and rendering flags, but not its targets
+	// For helper cameras drawing the same view into other targets, i.e. a G-buffer
+	void					CopyViewFrom(const Camera* camera);
+
+	// Renders with the camera at the origin, and draws offset from its precise position in double precision
+	// Anything drawn with this camera outside the ForwardRenderingPath needs GetRelativeModelMatrix()s
+	void					SetCameraRelativeRenderingEnabled(bool enabled);
+	bool					IsCameraRelativeRenderingEnabled() const;
+	HiZBuffer*				GetOcclusionBuffer();	// Created on first use, render thread only
+	std::vector<uint8_t>&	GetLODHistory();		// Only touched by this camera's render pass
+
 	Matrix44				GetCameraMatrix() const;
 	Matrix44				GetViewMatrix() const;
 	Matrix44				GetProjectionMatrix() const;
+	Frustum					GetFrustum() const;
 
 	Vector3					GetPosition() const;
+	DoubleVector3			GetPrecisePosition() const;
+	Matrix44				GetRelativeViewMatrix() const;		// View matrix with the camera at the origin
+	Matrix44				GetRelativeModelMatrix(const Matrix44& model, const DoubleVector3& worldOrigin) const;	// For a model relative to worldOrigin
 	Vector3					GetRotation() const;
 
 	Vector3					GetKVector() const;
@@ -107,4 +144,12 @@ private:
 	float m_fov;
 
 	unsigned int m_drawOrder;
+
+	bool		m_isDepthPrepassEnabled = false;
+	bool		m_isOcclusionCullingEnabled = false;
+	bool		m_isCameraRelativeRenderingEnabled = false;
+	eRenderingPath m_renderingPath = RENDERING_PATH_FORWARD;
+	HiZBuffer*	m_occlusionBuffer = nullptr;		// Last frame's depths, only made once occlusion culling is used
+
+	std::vector<uint8_t> m_lodHistory;				// LOD each draw instance of the scene rendered at last frame, for LOD hysteresis
 }; 
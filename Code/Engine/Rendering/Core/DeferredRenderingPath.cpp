@@ -0,0 +1,111 @@
+/************************************************************************/
+/* File: DeferredRenderingPath.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the DeferredRenderingPath static class
+/************************************************************************/
+#include "Engine/Core/Rgba.hpp"
+#include "Engine/Rendering/Core/Camera.hpp"
+#include "Engine/Rendering/Core/Vertex.hpp"
+#include "Engine/Rendering/Core/DrawCall.hpp"
+#include "Engine/Rendering/Meshes/Mesh.hpp"
+#include "Engine/Rendering/Resources/Texture.hpp"
+#include "Engine/Rendering/Materials/Material.hpp"
+#include "Engine/Rendering/Core/RenderCommandList.hpp"
+#include "Engine/Rendering/Resources/RenderTargetPool.hpp"
+#include "Engine/Rendering/Core/DeferredRenderingPath.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// Acquires the albedo and normal targets at the size of the view camera's, and points the helper
+// cameras at them and the view's own targets
+//
+bool DeferredRenderingPath::SetupGBuffer(Camera* viewCamera, GBufferTargets_t& out_gBuffer, Camera* gBufferCamera, Camera* lightingCamera)
+{
+	Texture* colorTarget = viewCamera->m_frameBuffer.m_colorTarget;
+	Texture* depthTarget = viewCamera->m_frameBuffer.m_depthTarget;
+
+	if (colorTarget == nullptr || depthTarget == nullptr)
+	{
+		return false;
+	}
+
+	IntVector2 dimensions = colorTarget->GetDimensions();
+	out_gBuffer.albedoTarget = RenderTargetPool::AcquireTransient(dimensions, TEXTURE_FORMAT_RGBA8);
+	out_gBuffer.normalTarget = RenderTargetPool::AcquireTransient(dimensions, TEXTURE_FORMAT_RGBA8);
+	out_gBuffer.depthTarget = depthTarget;
+
+	gBufferCamera->CopyViewFrom(viewCamera);
+	gBufferCamera->SetColorTarget(out_gBuffer.albedoTarget);
+	gBufferCamera->m_frameBuffer.SetAdditionalColorTarget(0, out_gBuffer.normalTarget);
+	gBufferCamera->SetDepthTarget(depthTarget);
+
+	// No depth, since the lighting samples it
+	lightingCamera->CopyViewFrom(viewCamera);
+	lightingCamera->SetColorTarget(colorTarget);
+	lightingCamera->SetDepthTarget(nullptr);
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the draw call can be drawn into the G-buffer instead of forward - a lit, unskinned
+// draw with a deferrable shader, drawn opaque with the usual depth and raster state
+//
+bool DeferredRenderingPath::CanDrawCallBeDeferred(const DrawCall& drawCall)
+{
+	const Mesh* mesh = drawCall.GetMesh();
+	if (mesh == nullptr || mesh->GetVertexLayout() == &VertexSkinned::LAYOUT || mesh->GetVertexLayout() == &VertexSkinnedPacked::LAYOUT || (drawCall.GetGBufferVAOHandle() == 0 && !mesh->IsStoredInArena()))
+	{
+		return false;
+	}
+
+	const Material* material = drawCall.GetMaterial();
+	const Shader* shader = drawCall.GetShader();
+	const RenderState& state = shader->GetRenderState();
+
+	bool isDeferrable = (material->IsUsingLights() && shader->IsDeferrable());
+	bool isOpaque = (shader->GetQueue() == SORTING_QUEUE_OPAQUE);
+	bool isDepthNormal = (state.m_shouldWriteDepth && (state.m_depthTest == DEPTH_TEST_LESS || state.m_depthTest == DEPTH_TEST_LEQUAL));
+	bool isRasterNormal = (state.m_fillMode == FILL_MODE_SOLID && state.m_cullMode == CULL_MODE_BACK && state.m_windOrder == WIND_COUNTER_CLOCKWISE);
+
+	return (isDeferrable && isOpaque && isDepthNormal && isRasterNormal);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records the deferrable draws into the G-buffer and the lighting of it into the view's color target
+// Runs on the pass's record job, so only touches the command list; the lights are the clusters
+// already bound for the view camera
+//
+void DeferredRenderingPath::RecordDeferredPasses(RenderCommandList& commands, const std::vector<DrawCall>& drawCalls, const std::vector<int>& drawOrder, 
+	const GBufferTargets_t* gBuffer, Camera* gBufferCamera, Camera* lightingCamera, Camera* viewCamera, const Rgba& ambience, std::vector<uint8_t>& out_isDeferred)
+{
+	int numDrawCalls = (int) drawCalls.size();
+	out_isDeferred.assign(numDrawCalls, 0);
+
+	commands.BeginProfile("DeferredGBuffer");
+	commands.SetCamera(gBufferCamera);
+
+	for (int drawIndex = 0; drawIndex < (int) drawOrder.size(); ++drawIndex)
+	{
+		int drawCallIndex = drawOrder[drawIndex];
+		const DrawCall& drawCall = drawCalls[drawCallIndex];
+
+		if (CanDrawCallBeDeferred(drawCall))
+		{
+			out_isDeferred[drawCallIndex] = 1;
+			commands.DrawGBuffer(drawCall);
+		}
+	}
+
+	commands.EndProfile();
+
+	commands.BeginProfile("DeferredLighting");
+	commands.SetCamera(lightingCamera);
+	commands.DrawDeferredLighting(gBuffer, ambience);
+	commands.EndProfile();
+
+	commands.SetCamera(viewCamera);
+}
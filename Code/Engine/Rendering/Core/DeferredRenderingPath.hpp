@@ -0,0 +1,50 @@
+/************************************************************************/
+/* File: DeferredRenderingPath.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: The deferred half of the scene path, for cameras set to
+/*				RENDERING_PATH_DEFERRED - their deferrable draws write a
+/*				G-buffer, which is then lit once per pixel with the
+/*				camera's light clusters; everything else still draws
+/*				forward, through the ForwardRenderingPath
+/*				Static class - cannot be instantiated
+/************************************************************************/
+#pragma once
+#include <vector>
+#include <stdint.h>
+
+class Rgba;
+class Camera;
+class Texture;
+class DrawCall;
+class RenderCommandList;
+
+// The surface of a deferred camera's view; albedo and normal are this frame's transient targets,
+// the depth is the camera's own so the forward draws after test against it
+struct GBufferTargets_t
+{
+	Texture* albedoTarget = nullptr;	// rgb surface color, a specular amount
+	Texture* normalTarget = nullptr;	// rgb world normal mapped to 0..1, a specular power
+	Texture* depthTarget = nullptr;
+};
+
+class DeferredRenderingPath
+{
+public:
+	//-----Public Methods-----
+
+	DeferredRenderingPath() = delete;
+
+	// Main thread - takes the G-buffer targets for this frame and sets the helper cameras up with the view camera's view,
+	// the G-buffer camera drawing the surface and the lighting one writing the view's color; returns false if the
+	// view camera is missing a color or depth target, in which case it renders forward
+	static bool SetupGBuffer(Camera* viewCamera, GBufferTargets_t& out_gBuffer, Camera* gBufferCamera, Camera* lightingCamera);
+
+	static bool CanDrawCallBeDeferred(const DrawCall& drawCall);
+
+	// Records the G-buffer draws, in draw order, then the lighting, leaving the view camera set for the forward draws
+	// out_isDeferred is set per draw call, nonzero for those drawn here that the forward draws should skip
+	static void RecordDeferredPasses(RenderCommandList& commands, const std::vector<DrawCall>& drawCalls, const std::vector<int>& drawOrder, 
+		const GBufferTargets_t* gBuffer, Camera* gBufferCamera, Camera* lightingCamera, Camera* viewCamera, const Rgba& ambience, std::vector<uint8_t>& out_isDeferred);
+
+};
@@ -4,9 +4,13 @@
 /* Date: May 2nd, 2018
 /* Description: Implementation of the DrawCall class
 /************************************************************************/
+#include <string.h>
 #include "Engine/Rendering/Core/DrawCall.hpp"
 #include "Engine/Rendering/Core/Renderable.hpp"
+#include "Engine/Rendering/Meshes/Mesh.hpp"
+#include "Engine/Rendering/Meshes/MeshArena.hpp"
 #include "Engine/Rendering/Materials/Material.hpp"
+#include "Engine/Rendering/Shaders/ShaderProgram.hpp"
 #include "Engine/Core/DeveloperConsole/DevConsole.hpp"
 
 //-----------------------------------------------------------------------------------------------
@@ -32,7 +36,7 @@ Matrix44 DrawCall::GetModelMatrix(unsigned int index) const
 //
 const Matrix44* DrawCall::GetModelMatrixBuffer() const
 {
-	return m_drawMatrices.data();
+	return m_drawMatrices;
 }
 
 
@@ -42,7 +46,25 @@ const Matrix44* DrawCall::GetModelMatrixBuffer() const
 //
 int DrawCall::GetModelMatrixCount() const
 {
-	return (int) m_drawMatrices.size();
+	return m_numDrawMatrices;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the skinning palette offset of each instance, or nullptr if the draw doesn't use one
+//
+const uint32_t* DrawCall::GetBoneOffsetBuffer() const
+{
+	return m_boneOffsets;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the custom data of each instance, or nullptr if the draw doesn't have any
+//
+const Vector4* DrawCall::GetCustomDataBuffer() const
+{
+	return m_customData;
 }
 
 
@@ -55,6 +77,33 @@ unsigned int DrawCall::GetVAOHandle() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the VAO handle of the mesh bound to the depth-only shader
+//
+unsigned int DrawCall::GetDepthVAOHandle() const
+{
+	return m_depthVAOHandle;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the VAO handle of the mesh bound to the G-buffer shader, 0 if the draw isn't deferrable
+//
+unsigned int DrawCall::GetGBufferVAOHandle() const
+{
+	return m_gBufferVAOHandle;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if this draw call's depth was drawn in a depth pre-pass
+//
+bool DrawCall::IsDepthPrepassed() const
+{
+	return m_isDepthPrepassed;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the material of the draw call
 //
@@ -64,6 +113,15 @@ Material* DrawCall::GetMaterial() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the shader the draw call is drawn with - the material's, unless it was set preskinned
+//
+const Shader* DrawCall::GetShader() const
+{
+	return (m_shaderOverride != nullptr ? m_shaderOverride : m_material->GetShader());
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Calculates the overall sort order for the draw call given its layer and queue order
 //
@@ -73,6 +131,15 @@ int DrawCall::GetSortOrder() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the key the draw call is sorted by, computed by ComputeSortKey()
+//
+uint64_t DrawCall::GetSortKey() const
+{
+	return m_sortKey;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the number of lights used by this draw call
 //
@@ -101,32 +168,64 @@ Rgba DrawCall::GetAmbience() const
 
 
 //-----------------------------------------------------------------------------------------------
-// Sets all members to be that from the renderable given
-// Returns false if there are no model instances for the renderable, meaning no need to draw
+// Returns true if the two draw calls can be drawn in one multi-draw - they must share all bound
+// state, and have indexed meshes of the same layout and primitive that the MeshArena can hold
 //
-bool DrawCall::SetDataFromRenderable(Renderable* renderable, int dcIndex)
+bool DrawCall::CanBatchWith(const DrawCall& other) const
 {
-	m_mesh = renderable->GetMesh(dcIndex);
-	m_material = renderable->GetMaterialForRender(dcIndex);
+	if (m_material != other.m_material || m_shaderOverride != other.m_shaderOverride || !MeshArena::CanMeshBeAdded(m_mesh) || !MeshArena::CanMeshBeAdded(other.m_mesh))
+	{
+		return false;
+	}
 
-	// Set all the matrix data
-	m_drawMatrices.clear();
+	// Multi-draws only stream the instance matrices
+	if (m_boneOffsets != nullptr || other.m_boneOffsets != nullptr || m_customData != nullptr || other.m_customData != nullptr)
+	{
+		return false;
+	}
 
-	int numMatrices = renderable->GetInstanceCount();
+	if (m_mesh->GetVertexLayout() != other.m_mesh->GetVertexLayout() || m_mesh->GetDrawInstruction().m_primType != other.m_mesh->GetDrawInstruction().m_primType)
+	{
+		return false;
+	}
 
-	if (numMatrices == 0)
+	if (!(m_ambience == other.m_ambience) || m_numLightsInUse != other.m_numLightsInUse || m_isDepthPrepassed != other.m_isDepthPrepassed)
 	{
-		ConsoleWarningf("Warning: DrawCall intialized with renderable with no instance matrices.");
 		return false;
 	}
 
-	for (int instanceIndex = 0; instanceIndex < numMatrices; ++instanceIndex)
+	for (int lightIndex = 0; lightIndex < m_numLightsInUse; ++lightIndex)
 	{
-		Matrix44 instanceMatrix = renderable->GetInstanceMatrix(instanceIndex);
-		Matrix44 drawMatrix = renderable->GetDraw(dcIndex).drawMatrix;
+		if (m_lights[lightIndex] != other.m_lights[lightIndex])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
 
-		Matrix44 matrixForRender = instanceMatrix * drawMatrix;
-		m_drawMatrices.push_back(matrixForRender);
+
+//-----------------------------------------------------------------------------------------------
+// Sets all members to be that from the renderable given, drawing with the given world matrices
+// (one per instance to draw, already multiplied by the draw's matrix) and optionally their bone offsets,
+// using the mesh of the given LOD
+// Returns false if there are no matrices to draw with, meaning no need to draw
+//
+bool DrawCall::SetDataFromRenderable(Renderable* renderable, int dcIndex, const Matrix44* drawMatrices, int numDrawMatrices, const uint32_t* boneOffsets /*= nullptr*/, int lodIndex /*= 0*/)
+{
+	m_mesh = renderable->GetMeshForLOD(dcIndex, lodIndex);
+	m_material = renderable->GetMaterialForRender(dcIndex);
+
+	m_drawMatrices = drawMatrices;
+	m_numDrawMatrices = numDrawMatrices;
+	m_boneOffsets = boneOffsets;
+	m_customData = nullptr;
+	m_shaderOverride = nullptr;
+
+	if (numDrawMatrices == 0)
+	{
+		return false;
 	}
 
 	const Shader* shader = m_material->GetShader();
@@ -134,12 +233,42 @@ bool DrawCall::SetDataFromRenderable(Renderable* renderable, int dcIndex)
 	m_renderQueue = shader->GetQueue();
 
 	// Set the VAO handle
-	m_vaoHandle = renderable->GetVAOHandleForDraw(dcIndex);
+	m_vaoHandle = renderable->GetVAOHandleForLOD(dcIndex, lodIndex);
+	m_depthVAOHandle = renderable->GetDepthVAOHandleForLOD(dcIndex, lodIndex);
+	m_gBufferVAOHandle = renderable->GetGBufferVAOHandleForLOD(dcIndex, lodIndex);
 
 	return true;
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Sets the per instance custom data, which makes the draw instanced even with one matrix
+//
+void DrawCall::SetCustomData(const Vector4* customData)
+{
+	m_customData = customData;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Swaps the draw to the mesh GPUSkinning already skinned, drawn as static geometry with the given
+// unskinned shader; the material's textures and properties are still used
+//
+void DrawCall::SetPreskinned(Mesh* skinnedMesh, const Shader* shader, unsigned int vaoHandle, unsigned int depthVAOHandle, unsigned int gBufferVAOHandle)
+{
+	m_mesh = skinnedMesh;
+	m_shaderOverride = shader;
+	m_boneOffsets = nullptr;
+
+	m_layer = shader->GetLayer();
+	m_renderQueue = shader->GetQueue();
+
+	m_vaoHandle = vaoHandle;
+	m_depthVAOHandle = depthVAOHandle;
+	m_gBufferVAOHandle = gBufferVAOHandle;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Sets the ambient light value for this draw to the value specified
 //
@@ -166,3 +295,56 @@ void DrawCall::SetNumLightsInUse(unsigned int lightsInUse)
 {
 	m_numLightsInUse = lightsInUse;
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets whether this draw call's depth was drawn in a depth pre-pass, so it's drawn without writing
+// depth and with a test that passes on the pre-pass's depths
+//
+void DrawCall::SetDepthPrepassed(bool isDepthPrepassed)
+{
+	m_isDepthPrepassed = isDepthPrepassed;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Packs everything the draw call is sorted by into one key, so sorting is a single integer compare
+//
+// Opaque:	layer(8) | queue(2) | shader(14) | material(14) | vao(10) | depth(16), nearest first
+// Alpha:	layer(8) | queue(2) | inverted depth(16), farthest first | shader(14) | material(14) | vao(10)
+//
+// Opaque draws are grouped by state to minimize binds, alpha draws have to be back to front
+// Shader, material and VAO fields are truncated IDs - collisions only cost an extra bind
+//
+void DrawCall::ComputeSortKey(const Vector3& cameraPosition)
+{
+	uint64_t layer = (uint64_t)(m_layer > 0xFF ? 0xFF : (m_layer < 0 ? 0 : m_layer));
+	uint64_t queue = (uint64_t)m_renderQueue & 0x3;
+
+	const Shader* shader = GetShader();
+	uint64_t shaderID = (uint64_t)(shader->GetProgram() != nullptr ? shader->GetProgram()->GetHandle() : 0) & 0x3FFF;
+	uint64_t materialID = (uint64_t)(((uintptr_t)m_material) >> 4) & 0x3FFF;
+	// Meshes stored in an arena share its VAO for the shader, so sort together by their layout
+	uint64_t vaoSource = ((m_mesh != nullptr && m_mesh->IsStoredInArena()) ? (uint64_t)(((uintptr_t)m_mesh->GetVertexLayout()) >> 4) : (uint64_t)m_vaoHandle);
+	uint64_t vaoID = vaoSource & 0x3FF;
+
+	// Positive floats order the same as their bit patterns, so the top bits make a coarse depth
+	Vector3 drawPosition = Matrix44::ExtractTranslation(m_drawMatrices[0]);
+	float distanceSquared = (drawPosition - cameraPosition).GetLengthSquared();
+
+	uint32_t distanceBits;
+	memcpy(&distanceBits, &distanceSquared, sizeof(float));
+	uint64_t depth = (uint64_t)(distanceBits >> 16) & 0xFFFF;
+
+	m_sortKey = (layer << 56) | (queue << 54);
+
+	if (m_renderQueue == SORTING_QUEUE_ALPHA)
+	{
+		uint64_t invertedDepth = 0xFFFF - depth;
+		m_sortKey |= (invertedDepth << 38) | (shaderID << 24) | (materialID << 10) | vaoID;
+	}
+	else
+	{
+		m_sortKey |= (shaderID << 40) | (materialID << 26) | (vaoID << 16) | depth;
+	}
+}
@@ -6,11 +6,13 @@
 /************************************************************************/
 #pragma once
 #include <vector>
+#include <stdint.h>
 #include "Engine/Math/Matrix44.hpp"
 #include "Engine/Rendering/Core/Light.hpp"
 #include "Engine/Rendering/Shaders/Shader.hpp"
 
 class Mesh;
+class Vector4;
 class Material;
 class Renderable;
 
@@ -22,22 +24,36 @@ public:
 	// Accessors
 	Mesh*			GetMesh() const;
 	Material*		GetMaterial() const;
+	const Shader*	GetShader() const;		// The material's, unless the draw was swapped to a preskinned copy
 	Matrix44		GetModelMatrix(unsigned int index) const;
 	const Matrix44* GetModelMatrixBuffer() const;
 	int				GetModelMatrixCount() const;
+	const uint32_t*	GetBoneOffsetBuffer() const;
+	const Vector4*	GetCustomDataBuffer() const;
 	unsigned int	GetVAOHandle() const;
+	unsigned int	GetDepthVAOHandle() const;
+	unsigned int	GetGBufferVAOHandle() const;
+	bool			IsDepthPrepassed() const;
 
 	int			GetSortOrder() const;
+	uint64_t	GetSortKey() const;
 	int			GetNumLights() const;
 	Light*		GetLight(unsigned int index) const;
 	Rgba		GetAmbience() const;
 
+	bool		CanBatchWith(const DrawCall& other) const;
+
 	// Mutators
-	bool SetDataFromRenderable(Renderable* renderable, int dcIndex);
+	bool SetDataFromRenderable(Renderable* renderable, int dcIndex, const Matrix44* drawMatrices, int numDrawMatrices, const uint32_t* boneOffsets = nullptr, int lodIndex = 0);
+	void SetCustomData(const Vector4* customData);		// One per matrix, same lifetime; cleared by SetDataFromRenderable()
+	void SetPreskinned(Mesh* skinnedMesh, const Shader* shader, unsigned int vaoHandle, unsigned int depthVAOHandle, unsigned int gBufferVAOHandle);
 	
 	void SetAmbience(const Rgba& ambience);
 	void SetLight(unsigned int index, Light* light);
 	void SetNumLightsInUse(unsigned int numLightsInUse);
+	void SetDepthPrepassed(bool isDepthPrepassed);
+
+	void ComputeSortKey(const Vector3& cameraPosition);
 
 
 private:
@@ -45,8 +61,14 @@ private:
 
 	Mesh*		m_mesh;
 	Material*	m_material;
+	const Shader* m_shaderOverride = nullptr;	// Set when GPUSkinning already skinned the mesh, drawn in place of the material's
 
-	std::vector<Matrix44> m_drawMatrices;
+	// Not owned - points into the scene's cached world matrices or the frame's scratch, so building
+	// a draw call never allocates; must stay valid until the draw call is drawn
+	const Matrix44* m_drawMatrices = nullptr;
+	int m_numDrawMatrices = 0;
+	const uint32_t* m_boneOffsets = nullptr;	// One per matrix if the draw is skinned from the AnimationSystem's palette, same lifetime
+	const Vector4* m_customData = nullptr;		// One per matrix if the instances have INSTANCE_CUSTOM_DATA, same lifetime
 
 	// Lights
 	Rgba m_ambience;
@@ -56,7 +78,13 @@ private:
 	// For sorting in the ForwardRenderingPath
 	int m_layer;
 	SortingQueue m_renderQueue;
+	uint64_t m_sortKey = 0;
 
 	unsigned int m_vaoHandle;
+	unsigned int m_depthVAOHandle = 0;
+	unsigned int m_gBufferVAOHandle = 0;
+
+	// Depth was already written by the pre-pass, so only the equal depths should be shaded
+	bool m_isDepthPrepassed = false;
 
 };
@@ -0,0 +1,216 @@
+/************************************************************************/
+/* File: DynamicResolution.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the DynamicResolution class
+/************************************************************************/
+#include <math.h>
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include "Engine/Rendering/Core/DynamicResolution.hpp"
+
+// Frame times are smoothed over a few frames, so one spike doesn't drop the resolution
+#define DYNAMIC_RESOLUTION_SMOOTHING (0.2f)
+
+// Scale changes once the smoothed time leaves this band around the target, by at most this much a frame
+#define DYNAMIC_RESOLUTION_LOWER_THRESHOLD (0.85f)
+#define DYNAMIC_RESOLUTION_UPPER_THRESHOLD (0.95f)
+#define DYNAMIC_RESOLUTION_MAX_STEP (0.05f)
+
+// Scales are snapped to this, so the scale doesn't change by a texel's worth every frame
+#define DYNAMIC_RESOLUTION_SCALE_INCREMENT (1.f / 64.f)
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+DynamicResolution::DynamicResolution()
+{
+	for (int frameIndex = 0; frameIndex < DYNAMIC_RESOLUTION_QUERY_FRAME_COUNT; ++frameIndex)
+	{
+		m_isFrameIssued[frameIndex] = false;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+DynamicResolution::~DynamicResolution()
+{
+	if (m_areQueriesCreated)
+	{
+		glDeleteQueries(DYNAMIC_RESOLUTION_QUERY_FRAME_COUNT * 2, &m_queryHandles[0][0]);
+		m_areQueriesCreated = false;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads the times of any frames the GPU has finished, updating the scale, then starts timing this one
+//
+void DynamicResolution::BeginFrame()
+{
+	if (!m_areQueriesCreated)
+	{
+		glGenQueries(DYNAMIC_RESOLUTION_QUERY_FRAME_COUNT * 2, &m_queryHandles[0][0]);
+		m_areQueriesCreated = true;
+	}
+
+	ReadFinishedFrames();
+
+	// Frame slot's queries are read or given up on by now, the ring is as deep as the GPU gets behind
+	m_currentFrameIndex = (m_currentFrameIndex + 1) % DYNAMIC_RESOLUTION_QUERY_FRAME_COUNT;
+	m_isFrameIssued[m_currentFrameIndex] = false;
+
+	glQueryCounter(m_queryHandles[m_currentFrameIndex][0], GL_TIMESTAMP);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Ends timing the frame
+//
+void DynamicResolution::EndFrame()
+{
+	if (!m_areQueriesCreated)
+	{
+		return;
+	}
+
+	glQueryCounter(m_queryHandles[m_currentFrameIndex][1], GL_TIMESTAMP);
+	m_isFrameIssued[m_currentFrameIndex] = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the GPU frame time to scale for
+//
+void DynamicResolution::SetTargetFrameMilliseconds(float targetMilliseconds)
+{
+	ASSERT_OR_DIE(targetMilliseconds > 0.f, Stringf("Error: DynamicResolution given a target frame time of %.2f ms", targetMilliseconds));
+	m_targetMilliseconds = targetMilliseconds;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the limits of the scale, clamping the current one into them
+//
+void DynamicResolution::SetScaleRange(float minScale, float maxScale)
+{
+	ASSERT_OR_DIE(minScale > 0.f && minScale <= maxScale && maxScale <= 1.f, Stringf("Error: DynamicResolution given a scale range of %.2f to %.2f", minScale, maxScale));
+
+	m_minScale = minScale;
+	m_maxScale = maxScale;
+	m_scale = ClampFloat(m_scale, m_minScale, m_maxScale);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns to the max scale, i.e. after a scene change makes the old timings meaningless
+//
+void DynamicResolution::Reset()
+{
+	m_scale = m_maxScale;
+	m_smoothedMilliseconds = 0.f;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the resolution scale of each axis
+//
+float DynamicResolution::GetScale() const
+{
+	return m_scale;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the smoothed GPU time of recent frames
+//
+float DynamicResolution::GetGPUFrameMilliseconds() const
+{
+	return m_smoothedMilliseconds;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the GPU frame time being scaled for
+//
+float DynamicResolution::GetTargetFrameMilliseconds() const
+{
+	return m_targetMilliseconds;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Updates the scale from the issued frames whose queries are ready, without waiting on any
+//
+void DynamicResolution::ReadFinishedFrames()
+{
+	// Oldest first, starting after the current frame
+	for (int offset = 1; offset <= DYNAMIC_RESOLUTION_QUERY_FRAME_COUNT; ++offset)
+	{
+		int frameIndex = (m_currentFrameIndex + offset) % DYNAMIC_RESOLUTION_QUERY_FRAME_COUNT;
+
+		if (!m_isFrameIssued[frameIndex])
+		{
+			continue;
+		}
+
+		GLint isAvailable = 0;
+		glGetQueryObjectiv(m_queryHandles[frameIndex][1], GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+
+		if (isAvailable == 0)
+		{
+			// Later frames can't be done either
+			break;
+		}
+
+		GLuint64 beginTime = 0;
+		GLuint64 endTime = 0;
+		glGetQueryObjectui64v(m_queryHandles[frameIndex][0], GL_QUERY_RESULT, &beginTime);
+		glGetQueryObjectui64v(m_queryHandles[frameIndex][1], GL_QUERY_RESULT, &endTime);
+
+		m_isFrameIssued[frameIndex] = false;
+
+		if (endTime > beginTime)
+		{
+			UpdateScale((float) ((double) (endTime - beginTime) * 1.0e-6));
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Moves the scale toward the one that would hit the target; GPU cost is roughly proportional to
+// the pixel count, so the scale goes with the square root of the time ratio
+//
+void DynamicResolution::UpdateScale(float gpuMilliseconds)
+{
+	if (m_smoothedMilliseconds == 0.f)
+	{
+		m_smoothedMilliseconds = gpuMilliseconds;
+	}
+	else
+	{
+		m_smoothedMilliseconds += (gpuMilliseconds - m_smoothedMilliseconds) * DYNAMIC_RESOLUTION_SMOOTHING;
+	}
+
+	float lowerMilliseconds = m_targetMilliseconds * DYNAMIC_RESOLUTION_LOWER_THRESHOLD;
+	float upperMilliseconds = m_targetMilliseconds * DYNAMIC_RESOLUTION_UPPER_THRESHOLD;
+
+	if (m_smoothedMilliseconds >= lowerMilliseconds && m_smoothedMilliseconds <= upperMilliseconds)
+	{
+		return;
+	}
+
+	// Aim for the middle of the band
+	float goalMilliseconds = 0.5f * (lowerMilliseconds + upperMilliseconds);
+	float idealScale = m_scale * sqrtf(goalMilliseconds / m_smoothedMilliseconds);
+
+	float step = ClampFloat(idealScale - m_scale, -DYNAMIC_RESOLUTION_MAX_STEP, DYNAMIC_RESOLUTION_MAX_STEP);
+	float newScale = roundf((m_scale + step) / DYNAMIC_RESOLUTION_SCALE_INCREMENT) * DYNAMIC_RESOLUTION_SCALE_INCREMENT;
+
+	m_scale = ClampFloat(newScale, m_minScale, m_maxScale);
+}
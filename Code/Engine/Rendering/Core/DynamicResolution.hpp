@@ -0,0 +1,62 @@
+/************************************************************************/
+/* File: DynamicResolution.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Picks the scene's render resolution scale each frame from
+/*				the GPU's frame times, lowering resolution before the
+/*				frame rate when GPU bound
+/************************************************************************/
+#pragma once
+
+// Frames of timestamp queries in flight, so results are read after the GPU is done with them
+#define DYNAMIC_RESOLUTION_QUERY_FRAME_COUNT (3)
+
+#define DYNAMIC_RESOLUTION_DEFAULT_TARGET_MS (16.0f)
+#define DYNAMIC_RESOLUTION_DEFAULT_MIN_SCALE (0.5f)
+
+class DynamicResolution
+{
+public:
+	//-----Public Methods-----
+
+	DynamicResolution();
+	~DynamicResolution();
+	DynamicResolution(const DynamicResolution& copy) = delete;
+
+	// Called by the Renderer around the frame's GPU work
+	void	BeginFrame();
+	void	EndFrame();
+
+	void	SetTargetFrameMilliseconds(float targetMilliseconds);
+	void	SetScaleRange(float minScale, float maxScale);
+	void	Reset();				// Back to the max scale, forgetting the frames measured
+
+	float	GetScale() const;		// Of each axis, so the pixel count goes with its square
+	float	GetGPUFrameMilliseconds() const;
+	float	GetTargetFrameMilliseconds() const;
+
+
+private:
+	//-----Private Methods-----
+
+	void	ReadFinishedFrames();
+	void	UpdateScale(float gpuMilliseconds);
+
+
+private:
+	//-----Private Data-----
+
+	// A begin and end timestamp per frame
+	unsigned int	m_queryHandles[DYNAMIC_RESOLUTION_QUERY_FRAME_COUNT][2];
+	bool			m_isFrameIssued[DYNAMIC_RESOLUTION_QUERY_FRAME_COUNT];
+	int				m_currentFrameIndex = 0;
+	bool			m_areQueriesCreated = false;
+
+	float			m_targetMilliseconds = DYNAMIC_RESOLUTION_DEFAULT_TARGET_MS;
+	float			m_minScale = DYNAMIC_RESOLUTION_DEFAULT_MIN_SCALE;
+	float			m_maxScale = 1.0f;
+
+	float			m_scale = 1.0f;
+	float			m_smoothedMilliseconds = 0.f;	// 0 until a frame has been measured
+
+};
@@ -4,232 +4,1037 @@
 /* Date: May 2nd, 2018
 /* Description: Implementation of the ForwardRenderingPath static class
 /************************************************************************/
+#include <math.h>
+#include <float.h>
+#include <string.h>
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Frustum.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/Core/Light.hpp"
 #include "Engine/Rendering/Core/Camera.hpp"
+#include "Engine/Rendering/Core/Vertex.hpp"
 #include "Engine/Rendering/Core/DrawCall.hpp"
+#include "Engine/Rendering/Core/HiZBuffer.hpp"
+#include "Engine/Rendering/Core/GPUProfiler.hpp"
 #include "Engine/Rendering/Core/Renderer.hpp"
+#include "Engine/Rendering/Core/RenderGraph.hpp"
 #include "Engine/Rendering/Core/Renderable.hpp"
 #include "Engine/Rendering/Core/RenderScene.hpp"
 #include "Engine/Rendering/Resources/Skybox.hpp"
 #include "Engine/Rendering/Materials/Material.hpp"
+#include "Engine/Rendering/Animation/GPUSkinning.hpp"
 #include "Engine/Rendering/Core/ForwardRenderingPath.hpp"
+#include "Engine/Rendering/Core/DeferredRenderingPath.hpp"
+#include "Engine/Rendering/Core/LightClusterGrid.hpp"
+#include "Engine/Rendering/Core/RenderCommandList.hpp"
+#include "Engine/Core/JobSystem/ParallelFor.hpp"
+#include "Engine/Core/JobSystem/FunctionJob.hpp"
+#include "Engine/Core/Time/ProfileLogScoped.hpp"
+
+// Renderables culled per job; each renderable tests all of its instances
+#define CULLING_RENDERABLES_PER_JOB (16)
+
+// How far past a shadow cascade toward the light casters are still rendered into it
+#define SHADOW_CASTER_DISTANCE (100.f)
+
+// Fraction past a LOD's screen size threshold an instance must get before a camera switches it
+#define LOD_HYSTERESIS (0.1f)
+
+// Working memory for recording a pass, so steady-state rendering doesn't allocate; each list only
+// grows to the size of the largest pass seen
+struct ForwardRenderingScratch_t
+{
+	std::vector<uint8_t>	visibility;
+	std::vector<int>		visibilityOffsets;
+	std::vector<Matrix44>	visibleMatrices;	// World matrices of the visible instances of partially culled draws
+	std::vector<uint32_t>	visibleBoneOffsets;	// Their skinning palette offsets, for renderables that have them
+	std::vector<Vector4>	visibleCustomData;	// And their custom data, the same
+	std::vector<DrawCall>	drawCalls;
+	std::vector<uint64_t>	sortKeys;
+	std::vector<uint64_t>	sortKeysScratch;
+	std::vector<int>		drawOrder;
+	std::vector<int>		drawOrderScratch;
+	std::vector<uint8_t>	lodLevels;			// Selected LOD per (draw, instance), for passes without a camera's history
+	std::vector<uint8_t>	isDeferred;			// Per draw call, nonzero if drawn into the G-buffer instead of forward
+};
+
+// A camera or shadow cascade render, recorded into its own command list on a job
+// Everything the job reads is copied in on the main thread, since later passes set the same shadow
+// cameras and lights up differently before this one is submitted
+struct ForwardRenderPass_t
+{
+	Camera*					camera = nullptr;
+	Matrix44				cameraMatrix;
+	Matrix44				projection;
+	Matrix44				viewProjection;		// World space, for culling against the records' bounds
+	Vector3					cameraPosition;		// In the space the draw calls are built in, for sorting
+
+	// Draw calls and lights are built relative to this, zero unless the camera renders camera relative
+	DoubleVector3			renderOrigin;
+	Matrix44				renderViewProjection;	// What the shaders see, for binning the lights
+	bool					isShadowPass = false;
+	bool					clearDepth = true;
+	Skybox*					skybox = nullptr;
+
+	// Camera passes only - set from the camera's toggles; the occlusion buffer is only read while recording
+	bool					useDepthPrepass = false;
+	HiZBuffer*				occlusionBuffer = nullptr;
+
+	// Camera passes keep their LODs across frames for hysteresis; shadow cameras are shared between view
+	// cameras, so their passes select from scratch each time with none
+	std::vector<uint8_t>*	lodLevels = nullptr;
+	float					lodHysteresis = 0.f;
+
+	// Camera passes only - the scene's lights as of this pass, binned into the pass's clusters
+	std::vector<LightData>	lightData;
+	std::vector<Light*>		lights;
+	LightClusterGrid*		lightClusters = nullptr;
+	LightProbeVolume*		lightProbes = nullptr;		// The scene's baked lights, nullptr for none
+
+	// Camera passes on the deferred path only - the helper cameras draw the camera's view into the G-buffer and
+	// light it back into the camera's color, and are made with the pass like the clusters
+	bool					isDeferred = false;
+	GBufferTargets_t		gBuffer;
+	Camera*					gBufferCamera = nullptr;
+	Camera*					lightingCamera = nullptr;
+
+	RenderCommandList			commands;
+	ForwardRenderingScratch_t	scratch;	// Must outlive the submit, draw calls point into it
+	int							recordJobID = -1;
+};
+
+// Reused every frame, and only grows to the most passes seen in a frame
+static std::vector<ForwardRenderPass_t*> s_renderPasses;
+static int s_renderPassCount = 0;
+static bool s_isRecording = false;
+static RenderGraph s_renderGraph;
 
 //-----------------------------------------------------------------------------------------------
 // Renders the given scene
 //
 void ForwardRenderingPath::Render(RenderScene* scene)
 {
+	RecordCommands(scene);
+	SubmitCommands();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets up every pass needed to render the scene (the shadow cascades each camera needs redrawn, then
+// the camera itself) and queues a job per pass to record its commands
+// Cameras and shadow fitting are set up here on the main thread; the jobs do the culling, draw call
+// construction, sorting and light binning, then SubmitCommands() plays the lists back in order
+//
+void ForwardRenderingPath::RecordCommands(RenderScene* scene)
+{
+	ASSERT_OR_DIE(!s_isRecording, "Error: ForwardRenderingPath::RecordCommands() called again before the last recording was submitted");
+	s_isRecording = true;
+	s_renderPassCount = 0;
+	s_renderGraph.Reset();
+
+	// The scene's sync point - play back what other threads queued, before anything reads it
+	scene->ApplyQueuedCommands();
 	scene->SortCameras();
-	
+
+	// Refresh the cached world data of anything that changed, once for all cameras
+	scene->UpdateRenderableRecords();
+
+	// Skin what can be once up front, so every shadow and camera pass draws the same skinned meshes
+	if (GPUSkinning::PrepareScene(scene->m_renderableRecords))
+	{
+		int skinningPass = s_renderGraph.AddPass("GPUSkinning", RENDER_GRAPH_PASS_COMPUTE, [](const RenderGraph&)
+		{
+			GPUSkinning::Dispatch();
+		});
+
+		s_renderGraph.SetPassHasSideEffects(skinningPass);
+	}
+
 	int numCameras = (int) scene->m_cameras.size();
 	for (int index = 0; index < numCameras; ++index)
 	{
-		// Render shadow textures
-		CreateShadowTexturesForCamera(scene, scene->m_cameras[index]);
+		Camera* camera = scene->m_cameras[index];
+
+		// Queues the shadow cascades first, so they're rendered before the camera samples them
+		AddShadowPassesForCamera(scene, camera);
+
+		ForwardRenderPass_t* pass = AddRenderPass(camera, false, true);
+		pass->skybox = scene->GetSkybox();
+
+		// Take in last frame's depths if the GPU has them ready, before the job can test against them
+		if (pass->occlusionBuffer != nullptr)
+		{
+			PROFILE_LOG_SCOPE("ForwardRenderingPath::ReadHiZ");
+			pass->occlusionBuffer->UpdateFromGPU();
+		}
+
+		// Baked lights are already in the scene's light probes, so only the rest are binned
+		pass->lightProbes = scene->GetLightProbeVolume();
+
+		for (Light* light : scene->m_lights)
+		{
+			if (!light->IsBaked())
+			{
+				pass->lights.push_back(light);
+				pass->lightData.push_back(light->GetLightData());
+			}
+		}
+
+		int numLights = (int) pass->lights.size();
+
+		// Shaders see positions relative to the render origin, so move the lights and shadow lookups to match
+		if (pass->renderOrigin != DoubleVector3::ZERO)
+		{
+			Vector3 renderOrigin = pass->renderOrigin.ToVector3();
+			Matrix44 toWorld = Matrix44::MakeTranslation(renderOrigin);
 
-		RenderSceneForCamera(scene->m_cameras[index], scene);
+			for (int lightIndex = 0; lightIndex < numLights; ++lightIndex)
+			{
+				LightData& data = pass->lightData[lightIndex];
+				data.m_position -= renderOrigin;
+
+				for (int cascadeIndex = 0; cascadeIndex < SHADOW_CASCADE_COUNT; ++cascadeIndex)
+				{
+					data.m_shadowVP[cascadeIndex] = data.m_shadowVP[cascadeIndex] * toWorld;
+				}
+			}
+		}
+
+		pass->recordJobID = QueueFunctionJob([pass, scene]() { RecordRenderPass(pass, scene); });
+		AddGraphPasses(pass, scene);
 	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Constructs the shadow textures to be used for shadow casting
+// Waits on each pass's recording and submits it to the Renderer, in the order the passes were added
+// Must be called on the render thread, after RecordCommands()
 //
-void ForwardRenderingPath::CreateShadowTexturesForCamera(RenderScene* scene, Camera* camera)
+void ForwardRenderingPath::SubmitCommands()
+{
+	ASSERT_OR_DIE(s_isRecording, "Error: ForwardRenderingPath::SubmitCommands() called without recording first");
+
+	// The scene's passes all write imported targets or have side effects, so none of them (and none of
+	// the record jobs they wait on) are culled
+	s_renderGraph.Compile();
+	s_renderGraph.Execute();
+
+	// Don't light draws made after the scene with its lights
+	Renderer::GetInstance()->ClearLightClusters();
+	Renderer::GetInstance()->ClearLightProbeVolume();
+
+	s_isRecording = false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the passes for the shadow textures to be used for shadow casting
+// Each light renders one cascade per cell of its shadow texture, fit to a slice of the camera's view,
+// and skips rendering entirely if its cascades and the scene's renderables haven't changed since last time
+//
+void ForwardRenderingPath::AddShadowPassesForCamera(RenderScene* scene, Camera* camera)
 {
 	int numLights = (int) scene->m_lights.size();
+	unsigned int renderablesRevision = scene->GetRenderablesRevision();
 
 	for (int lightIndex = 0; lightIndex < numLights; ++lightIndex)
 	{
 		Light* light = scene->m_lights[lightIndex];
-		if (light->IsShadowCasting())
+		if (light->IsShadowCasting() && !light->IsBaked())
 		{
-			Camera* shadowCamera = new Camera();
-			//Texture* color = new Texture();
-			//color->CreateRenderTarget(2048, 2048, TEXTURE_FORMAT_RGBA8);
+			LightData data = light->GetLightData();
+			bool cascadesChanged = false;
 
-			Vector3 cameraPos = camera->GetPosition();
+			// Fit each cascade to its slice of the view, and set the view projection to be used for the shadow test
+			float nearDistance = 0.f;
+			for (int cascadeIndex = 0; cascadeIndex < SHADOW_CASCADE_COUNT; ++cascadeIndex)
+			{
+				Camera* shadowCamera = light->GetShadowCamera(cascadeIndex);
+				float farDistance = light->GetShadowCascadeDistance(cascadeIndex);
 
-			shadowCamera->SetCameraMatrix(Matrix44::MakeLookAt(cameraPos - 100.f * light->GetLightData().m_lightDirection, cameraPos));
-			shadowCamera->SetProjectionOrtho(200.f, 200.f, -100.f, 1000.f);
+				FitShadowCascadeToView(shadowCamera, camera, data.m_lightDirection, nearDistance, farDistance);
 
-			// Set the view projection to be used for the shadow test
-			LightData data = light->GetLightData();
-			data.m_shadowVP = shadowCamera->GetProjectionMatrix() * shadowCamera->GetViewMatrix();
-			light->SetLightData(data);
+				Matrix44 shadowVP = shadowCamera->GetProjectionMatrix() * shadowCamera->GetViewMatrix();
+				if (!(shadowVP == data.m_shadowVP[cascadeIndex]))
+				{
+					data.m_shadowVP[cascadeIndex] = shadowVP;
+					cascadesChanged = true;
+				}
 
-			//shadowCamera->SetColorTarget(color);
-			shadowCamera->SetDepthTarget(light->GetShadowTexture());
+				nearDistance = farDistance;
+			}
 
-			RenderSceneForCamera(shadowCamera, scene);
+			// Nothing the shadow texture depends on moved, so its contents are still correct
+			if (!cascadesChanged && light->GetShadowRenderedRevision() == renderablesRevision)
+			{
+				continue;
+			}
 
-			//delete color;
-			delete shadowCamera;
+			light->SetLightData(data);
+
+			// The whole texture is cleared once, before the first cascade renders into its cell
+			for (int cascadeIndex = 0; cascadeIndex < SHADOW_CASCADE_COUNT; ++cascadeIndex)
+			{
+				ForwardRenderPass_t* pass = AddRenderPass(light->GetShadowCamera(cascadeIndex), true, (cascadeIndex == 0));
+				pass->recordJobID = QueueFunctionJob([pass, scene]() { RecordRenderPass(pass, scene); });
+				AddGraphPasses(pass, scene);
+			}
+
+			light->SetShadowRenderedRevision(renderablesRevision);
 		}
 	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Constructs all the draw calls necessary for a single renderable, and adds them to the given vector
+// Sets up the shadow camera as an ortho box looking down the light direction, enclosing the part of
+// the view camera's frustum between the two distances (measured along its view direction)
+// The box is sized by the slice's bounding sphere and snapped to whole texels in light space, so
+// it doesn't shimmer as the view moves or rotates, and it is extended toward the light so casters
+// outside of the view still render into it
 //
-void ForwardRenderingPath::ConstructDrawCallsForRenderable(Renderable* renderable, RenderScene* scene, std::vector<DrawCall>& drawCalls)
+void ForwardRenderingPath::FitShadowCascadeToView(Camera* shadowCamera, Camera* viewCamera, const Vector3& lightDirection, float nearDistance, float farDistance)
 {
-	int drawCount = renderable->GetDrawCountPerInstance();
+	// Corners of the full view frustum, from unprojecting the NDC cube
+	Matrix44 inverseViewProjection = (viewCamera->GetProjectionMatrix() * viewCamera->GetViewMatrix()).GetInverse();
+
+	Vector3 nearCorners[4];
+	Vector3 farCorners[4];
 
-	for (int dcIndex = 0; dcIndex < drawCount; ++dcIndex)
+	for (int cornerIndex = 0; cornerIndex < 4; ++cornerIndex)
 	{
-		DrawCall dc;
+		float ndcX = ((cornerIndex & 1) != 0 ? 1.f : -1.f);
+		float ndcY = ((cornerIndex & 2) != 0 ? 1.f : -1.f);
 
-		// Compute which lights contribute the most to this renderable
-		Material* material = renderable->GetMaterialForRender(dcIndex);
-		if (material->IsUsingLights())
-		{
-			TODO("Figure out how to find the 8 lights for each instance(?)");
-			ComputeLightsForDrawCall(dc, scene, renderable->GetInstancePosition(0));
-		}
+		Vector4 nearCorner = inverseViewProjection * Vector4(ndcX, ndcY, -1.f, 1.f);
+		Vector4 farCorner = inverseViewProjection * Vector4(ndcX, ndcY, 1.f, 1.f);
+
+		nearCorners[cornerIndex] = nearCorner.xyz() / nearCorner.w;
+		farCorners[cornerIndex] = farCorner.xyz() / farCorner.w;
+	}
+
+	// Distances are along the view direction, and the near and far planes are parallel, so every
+	// edge of the frustum is cut at the same fraction
+	Vector3 viewPosition = viewCamera->GetPosition();
+	Vector3 nearCenter = 0.25f * (nearCorners[0] + nearCorners[1] + nearCorners[2] + nearCorners[3]);
+	Vector3 farCenter = 0.25f * (farCorners[0] + farCorners[1] + farCorners[2] + farCorners[3]);
+	Vector3 viewDirection = (farCenter - nearCenter).GetNormalized();
+
+	float frustumNear = DotProduct(nearCenter - viewPosition, viewDirection);
+	float frustumFar = DotProduct(farCenter - viewPosition, viewDirection);
+	float frustumDepth = frustumFar - frustumNear;
+
+	float sliceStart = (ClampFloat(nearDistance, frustumNear, frustumFar) - frustumNear) / frustumDepth;
+	float sliceEnd = (ClampFloat(farDistance, frustumNear, frustumFar) - frustumNear) / frustumDepth;
+
+	Vector3 sliceCorners[8];
+	Vector3 sliceCenter = Vector3::ZERO;
+
+	for (int cornerIndex = 0; cornerIndex < 4; ++cornerIndex)
+	{
+		Vector3 edge = farCorners[cornerIndex] - nearCorners[cornerIndex];
 
-		bool hasModels = dc.SetDataFromRenderable(renderable, dcIndex);
-	
-		// Add the draw call to the list to render
-		if (hasModels)
+		sliceCorners[cornerIndex] = nearCorners[cornerIndex] + sliceStart * edge;
+		sliceCorners[cornerIndex + 4] = nearCorners[cornerIndex] + sliceEnd * edge;
+
+		sliceCenter += sliceCorners[cornerIndex] + sliceCorners[cornerIndex + 4];
+	}
+
+	sliceCenter /= 8.f;
+
+	float radius = 0.f;
+	for (int cornerIndex = 0; cornerIndex < 8; ++cornerIndex)
+	{
+		radius = MaxFloat(radius, (sliceCorners[cornerIndex] - sliceCenter).GetLength());
+	}
+
+	// Quantize the radius so the box size (and with it the texel size) stays fixed as the view rotates,
+	// and keep it nonzero for slices past the far plane
+	radius = MaxFloat(ceilf(radius * 16.f) / 16.f, 1.f / 16.f);
+
+	// Pick an up that can't be parallel to the light
+	Vector3 up = (AbsoluteValue(lightDirection.y) > 0.99f ? Vector3::Z_AXIS : Vector3::Y_AXIS);
+	Matrix44 lightRotation = Matrix44::MakeLookAt(Vector3::ZERO, lightDirection, up);
+	Matrix44 inverseLightRotation = lightRotation.GetInverseAffine();
+
+	// Snap the center to whole texels across the light's view plane
+	float cascadeResolution = (float) (SHADOW_TEXTURE_SIZE / SHADOW_CASCADE_ATLAS_WIDTH);
+	float texelSize = (2.f * radius) / cascadeResolution;
+
+	Vector3 lightSpaceCenter = inverseLightRotation.TransformPoint(sliceCenter).xyz();
+	lightSpaceCenter.x = floorf(lightSpaceCenter.x / texelSize) * texelSize;
+	lightSpaceCenter.y = floorf(lightSpaceCenter.y / texelSize) * texelSize;
+
+	Vector3 boxCenter = lightRotation.TransformPoint(lightSpaceCenter).xyz();
+	Vector3 shadowPosition = boxCenter - (radius + SHADOW_CASTER_DISTANCE) * lightDirection;
+
+	shadowCamera->SetCameraMatrix(Matrix44::MakeLookAt(shadowPosition, boxCenter, up));
+	shadowCamera->SetProjectionOrtho(2.f * radius, 2.f * radius, 0.f, 2.f * radius + SHADOW_CASTER_DISTANCE);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Takes the next pass from the pool and sets it to render with the camera as it is now
+// Camera passes also get a light cluster grid, created here since it makes GPU buffers
+//
+ForwardRenderPass_t* ForwardRenderingPath::AddRenderPass(Camera* camera, bool isShadowPass, bool clearDepth)
+{
+	if (s_renderPassCount == (int) s_renderPasses.size())
+	{
+		s_renderPasses.push_back(new ForwardRenderPass_t());
+	}
+
+	ForwardRenderPass_t* pass = s_renderPasses[s_renderPassCount];
+	s_renderPassCount++;
+
+	pass->camera = camera;
+	pass->cameraMatrix = camera->GetCameraMatrix();
+	pass->projection = camera->GetProjectionMatrix();
+	pass->viewProjection = camera->GetProjectionMatrix() * camera->GetViewMatrix();
+	pass->cameraPosition = camera->GetPosition();
+	pass->renderOrigin = DoubleVector3::ZERO;
+	pass->renderViewProjection = pass->viewProjection;
+
+	// Records keep their matrices relative to their renderable's origin, so moving the camera far away
+	// only changes the offsets applied as the draw calls are built
+	if (!isShadowPass && camera->IsCameraRelativeRenderingEnabled())
+	{
+		pass->cameraPosition = Vector3::ZERO;
+		pass->renderOrigin = camera->GetPrecisePosition();
+		pass->renderViewProjection = camera->GetProjectionMatrix() * camera->GetRelativeViewMatrix();
+	}
+
+	pass->isShadowPass = isShadowPass;
+	pass->clearDepth = clearDepth;
+	pass->skybox = nullptr;
+	pass->lightData.clear();
+	pass->lights.clear();
+	pass->lightProbes = nullptr;
+
+	pass->useDepthPrepass = (!isShadowPass && camera->IsDepthPrepassEnabled());
+	pass->occlusionBuffer = ((!isShadowPass && camera->IsOcclusionCullingEnabled()) ? camera->GetOcclusionBuffer() : nullptr);
+
+	pass->lodLevels = (isShadowPass ? &pass->scratch.lodLevels : &camera->GetLODHistory());
+	pass->lodHysteresis = (isShadowPass ? 0.f : LOD_HYSTERESIS);
+
+	if (!isShadowPass && pass->lightClusters == nullptr)
+	{
+		pass->lightClusters = new LightClusterGrid();
+	}
+
+	pass->isDeferred = false;
+	if (!isShadowPass && camera->GetRenderingPath() == RENDERING_PATH_DEFERRED)
+	{
+		if (pass->gBufferCamera == nullptr)
 		{
-			drawCalls.push_back(dc);
+			pass->gBufferCamera = new Camera();
+			pass->lightingCamera = new Camera();
 		}
+
+		pass->isDeferred = DeferredRenderingPath::SetupGBuffer(camera, pass->gBuffer, pass->gBufferCamera, pass->lightingCamera);
+
+		// The G-buffer already only shades what's visible, so there's nothing for a pre-pass to save
+		pass->useDepthPrepass = (pass->useDepthPrepass && !pass->isDeferred);
 	}
+
+	return pass;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Sorts the draw calls given for a camera draw
+// Adds the graph pass that waits on the pass's recording and submits it, writing the camera's targets
+// and reading the shadow maps; camera passes with occlusion culling also get their Hi-Z reduction
 //
-void ForwardRenderingPath::SortDrawCalls(std::vector<DrawCall>& drawCalls)
+void ForwardRenderingPath::AddGraphPasses(ForwardRenderPass_t* pass, RenderScene* scene)
 {
-	TODO("Sort alpha");
-	int numDrawCalls = (int) drawCalls.size();
+	const char* passName = (pass->isShadowPass ? "ShadowPass" : "CameraPass");
+	int graphPass = s_renderGraph.AddPass(passName, RENDER_GRAPH_PASS_GRAPHICS, [pass](const RenderGraph&)
+	{
+		JobSystem::GetInstance()->BlockUntilJobIsFinalized(pass->recordJobID);
+		pass->commands.Submit();
+	});
 
-	bool done = false;
+	Texture* colorTarget = pass->camera->m_frameBuffer.m_colorTarget;
+	Texture* depthTarget = pass->camera->m_frameBuffer.m_depthTarget;
 
-	while (!done)
+	if (colorTarget != nullptr)
 	{
-		done = true;
-		for (int index = 0; index < numDrawCalls - 1; ++index)
-		{
-			// Find one pair out of order, swap and continue iterating
-			if (drawCalls[index].GetSortOrder() > drawCalls[index + 1].GetSortOrder())
-			{
-				DrawCall temp = drawCalls[index];
-				drawCalls[index] = drawCalls[index + 1];
-				drawCalls[index + 1] = temp;
+		s_renderGraph.Write(graphPass, s_renderGraph.ImportTexture("CameraColor", colorTarget), RENDER_GRAPH_USAGE_COLOR_TARGET);
+	}
 
-				done = false;
-			}
+	if (depthTarget != nullptr)
+	{
+		s_renderGraph.Write(graphPass, s_renderGraph.ImportTexture("CameraDepth", depthTarget), RENDER_GRAPH_USAGE_DEPTH_TARGET);
+	}
+
+	if (pass->isDeferred)
+	{
+		s_renderGraph.Write(graphPass, s_renderGraph.ImportTexture("GBufferAlbedo", pass->gBuffer.albedoTarget), RENDER_GRAPH_USAGE_COLOR_TARGET);
+		s_renderGraph.Write(graphPass, s_renderGraph.ImportTexture("GBufferNormal", pass->gBuffer.normalTarget), RENDER_GRAPH_USAGE_COLOR_TARGET);
+	}
+
+	// Its job has to be waited on whatever it draws to
+	s_renderGraph.SetPassHasSideEffects(graphPass);
+
+	if (pass->isShadowPass)
+	{
+		return;
+	}
+
+	int numLights = (int) scene->m_lights.size();
+	for (int lightIndex = 0; lightIndex < numLights; ++lightIndex)
+	{
+		Light* light = scene->m_lights[lightIndex];
+
+		if (light->IsShadowCasting() && !light->IsBaked() && light->GetShadowTexture() != nullptr)
+		{
+			s_renderGraph.Read(graphPass, s_renderGraph.ImportTexture("ShadowMap", light->GetShadowTexture()), RENDER_GRAPH_USAGE_SAMPLED);
 		}
 	}
+
+	// Reduce this frame's depth for culling the next one; read back on the CPU, so outside the graph
+	if (pass->occlusionBuffer != nullptr && depthTarget != nullptr)
+	{
+		int hiZPass = s_renderGraph.AddPass("BuildHiZ", RENDER_GRAPH_PASS_COMPUTE, [pass](const RenderGraph&)
+		{
+			pass->occlusionBuffer->Build(pass->camera, pass->viewProjection);
+		});
+
+		s_renderGraph.Read(hiZPass, s_renderGraph.ImportTexture("CameraDepth", depthTarget), RENDER_GRAPH_USAGE_SAMPLED);
+		s_renderGraph.SetPassHasSideEffects(hiZPass);
+	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Renders the given scene using the given camera
+// Returns the frame's render graph, for adding passes between RecordCommands() and SubmitCommands()
 //
-void ForwardRenderingPath::RenderSceneForCamera(Camera* camera, RenderScene* scene)
+RenderGraph* ForwardRenderingPath::GetRenderGraph()
 {
-	Renderer* renderer = Renderer::GetInstance();
-	renderer->SetCurrentCamera(camera);
-	renderer->ClearDepth(1.0f);
+	return &s_renderGraph;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records the commands to render the scene for the pass into its command list
+// Runs on a job - only reads the pass's copied camera and light state and the scene's renderable
+// records, and never touches the Renderer
+//
+void ForwardRenderingPath::RecordRenderPass(ForwardRenderPass_t* pass, RenderScene* scene)
+{
+	RenderCommandList& commands = pass->commands;
+	ForwardRenderingScratch_t& scratch = pass->scratch;
+
+	commands.Reset();
+
+	if (pass->isShadowPass)
+	{
+		// Shadow cameras are refit for every view camera, so restore this pass's fit at submit
+		commands.SetCamera(pass->camera, pass->cameraMatrix, pass->projection);
+	}
+	else
+	{
+		commands.SetCamera(pass->camera);
+	}
 
-	Skybox* skybox = scene->GetSkybox();
+	if (pass->clearDepth)
+	{
+		commands.ClearDepth(1.0f);
+	}
 
-	if (skybox != nullptr)
+	if (pass->isShadowPass)
+	{
+		// Don't bind a shadow texture that may be the one being rendered to
+		commands.BindLightClusters(nullptr);
+	}
+	else
 	{
-		skybox->Render();
+		// Bin the scene's lights for this camera's view, used by every lit draw
+		pass->lightClusters->Build(pass->renderViewProjection, pass->lightData, pass->lights);
+		commands.BindLightClusters(pass->lightClusters);
+		commands.BindLightProbes(pass->lightProbes, pass->renderOrigin.ToVector3());
 	}
 
-	std::vector<DrawCall> drawCalls;
+	// Cull against the camera before building any draw calls
+	CullRenderables(Frustum(pass->viewProjection), pass->occlusionBuffer, scene, scratch.visibility, scratch.visibilityOffsets);
+
+	// Entries of renderables added since last frame start at the finest LOD
+	std::vector<uint8_t>& lodLevels = *pass->lodLevels;
+	lodLevels.resize(scratch.visibility.size(), 0);
+
+	std::vector<DrawCall>& drawCalls = scratch.drawCalls;
+	drawCalls.clear();
+
+	// Enough room for every instance to be partially culled, so pointers into it stay valid
+	scratch.visibleMatrices.clear();
+	scratch.visibleMatrices.reserve(scratch.visibility.size());
+	scratch.visibleBoneOffsets.clear();
+	scratch.visibleBoneOffsets.reserve(scratch.visibility.size());
+	scratch.visibleCustomData.clear();
+	scratch.visibleCustomData.reserve(scratch.visibility.size());
 
 	// Create draw calls for all renderables
-	int numRenderables = (int) scene->m_renderables.size();
-	for (int index = 0; index < numRenderables; ++index)
+	int numRecords = (int) scene->m_renderableRecords.size();
+	for (int index = 0; index < numRecords; ++index)
 	{	
-		Renderable* currRenderable = scene->m_renderables[index];
+		const RenderableRecord_t& record = scene->m_renderableRecords[index];
 
 		// Only construct draw calls if instances exist to draw in the renderable
-		if (currRenderable->GetInstanceCount() > 0)
+		if (record.instanceCount > 0)
 		{
-			ConstructDrawCallsForRenderable(currRenderable, scene, drawCalls);
+			int entryOffset = scratch.visibilityOffsets[index];
+			ConstructDrawCallsForRenderable(*pass, record, scene, drawCalls, scratch.visibility.data() + entryOffset, lodLevels.data() + entryOffset, scratch.visibleMatrices, scratch.visibleBoneOffsets, scratch.visibleCustomData);
 		}
 	}
 
 	// Sort the draw calls by their shader's layer and queue order
-	SortDrawCalls(drawCalls);
+	std::vector<int>& drawOrder = scratch.drawOrder;
+	SortDrawCalls(drawCalls, pass->cameraPosition, drawOrder, scratch);
+
+	// Deferred cameras draw and light their deferrable draws first, and leave the rest to forward below
+	if (pass->isDeferred)
+	{
+		DeferredRenderingPath::RecordDeferredPasses(commands, drawCalls, drawOrder, &pass->gBuffer, pass->gBufferCamera, pass->lightingCamera, pass->camera, scene->GetAmbience(), scratch.isDeferred);
+	}
 
-	// Iterate over all draw calls and draw them
-	for (int drawIndex = 0; drawIndex < (int) drawCalls.size(); ++drawIndex)
+	// Lay down the opaque depth first, so the lit draws only shade the fragments that end up visible
+	if (pass->useDepthPrepass)
 	{
-		DrawCall& dc = drawCalls[drawIndex];
-		renderer->Draw(dc);
-	} 
+		commands.BeginProfile("DepthPrepass");
+
+		for (int drawIndex = 0; drawIndex < (int) drawOrder.size(); ++drawIndex)
+		{
+			DrawCall& drawCall = drawCalls[drawOrder[drawIndex]];
+
+			if (CanDrawCallBeDepthPrepassed(drawCall))
+			{
+				drawCall.SetDepthPrepassed(true);
+				commands.DrawDepthOnly(drawCall);
+			}
+		}
+
+		commands.EndProfile();
+	}
+
+	// Shadow passes only write depth, so only camera passes draw the skybox
+	// Drawn after any pre-pass or G-buffer, so it only fills what the opaque geometry won't cover
+	if (!pass->isShadowPass && pass->skybox != nullptr)
+	{
+		commands.DrawSkybox(pass->skybox);
+	}
+
+	for (int drawIndex = 0; drawIndex < (int) drawOrder.size(); ++drawIndex)
+	{
+		int drawCallIndex = drawOrder[drawIndex];
+
+		if (pass->isDeferred && scratch.isDeferred[drawCallIndex] != 0)
+		{
+			continue;
+		}
+
+		commands.Draw(drawCalls[drawCallIndex]);
+	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Iterates over all lights in the scene and finds the 8 most contributing lights for the draw call,
-// and stores it in the draw call
+// Tests every instance of every draw of the scene's renderables against the frustum, and against the
+// occlusion buffer if one is given
+// out_visibility gets one entry per (draw, instance) of each renderable, nonzero if visible, starting at
+// that renderable's offset in out_visibilityOffsets and laid out the same as its record
+// Uses the bounds cached in the scene's records, and tests renderables in parallel on the JobSystem
 //
-void ForwardRenderingPath::ComputeLightsForDrawCall(DrawCall& drawCall, RenderScene* scene, const Vector3& position)
+void ForwardRenderingPath::CullRenderables(const Frustum& frustum, const HiZBuffer* occlusionBuffer, RenderScene* scene, std::vector<uint8_t>& out_visibility, std::vector<int>& out_visibilityOffsets)
 {
-	// Set the ambience
-	drawCall.SetAmbience(scene->GetAmbience());
+	std::vector<RenderableRecord_t>& records = scene->m_renderableRecords;
+	int numRecords = (int) records.size();
 
-	// Calculate all other lights
-	int totalLights = (int) scene->m_lights.size();
+	out_visibilityOffsets.resize(numRecords);
 
-	// Calculate all intensities, store in an array parallel to the light array
-	std::vector<float> intensities;
-	for (int lightIndex = 0; lightIndex < totalLights; ++lightIndex)
+	int totalEntries = 0;
+	for (int index = 0; index < numRecords; ++index)
 	{
-		float currIntensity = scene->m_lights[lightIndex]->CalculateIntensityForPosition(position);
-		intensities.push_back(currIntensity);
+		out_visibilityOffsets[index] = totalEntries;
+		totalEntries += records[index].drawCount * records[index].instanceCount;
 	}
 
-	// Sort the two parallel arrays by decreasing intensity
-	for (int i = 0; i < totalLights - 1; ++i)
+	out_visibility.resize(totalEntries);
+
+	ParallelFor(0, numRecords, CULLING_RENDERABLES_PER_JOB, [&](int recordIndex)
 	{
-		float maxValue = intensities[i];
-		int maxIndex = i;
+		const RenderableRecord_t& record = records[recordIndex];
+		uint8_t* visibility = out_visibility.data() + out_visibilityOffsets[recordIndex];
 
-		for (int j = i + 1; j < totalLights; ++j)
+		for (int drawIndex = 0; drawIndex < record.drawCount; ++drawIndex)
 		{
-			if (intensities[j] > intensities[maxIndex])
+			int firstEntry = drawIndex * record.instanceCount;
+
+			for (int instanceIndex = 0; instanceIndex < record.instanceCount; ++instanceIndex)
+			{
+				int entryIndex = firstEntry + instanceIndex;
+
+				bool isVisible = true;
+				if (record.hasBounds[drawIndex] != 0)
+				{
+					const AABB3& bounds = record.worldBounds[entryIndex];
+					isVisible = frustum.DoesAABB3Overlap(bounds) && (occlusionBuffer == nullptr || !occlusionBuffer->IsAABB3Occluded(bounds));
+				}
+
+				visibility[entryIndex] = (isVisible ? 1 : 0);
+			}
+		}
+	});
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the fraction of the screen's height the bounds' enclosing sphere covers in the view
+// Perspective views shrink it with the distance in w; bounds around the eye cover the whole screen
+//
+static float CalculateScreenSize(const AABB3& bounds, const Matrix44& viewProjection, const Matrix44& projection)
+{
+	float radius = 0.5f * (bounds.maxs - bounds.mins).GetLength();
+	float projectedRadius = radius * AbsoluteValue(projection.Jy);
+
+	bool isPerspective = (projection.Kw != 0.f);
+	if (!isPerspective)
+	{
+		return projectedRadius;
+	}
+
+	float w = viewProjection.TransformPoint(bounds.GetCenter()).w;
+	if (w <= radius)
+	{
+		return FLT_MAX;
+	}
+
+	return projectedRadius / w;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructs all the draw calls necessary for a single renderable, and adds them to the given vector
+// Only visible instances are drawn, given the renderable's section of the culling results
+// Draws with LODs pick one per visible instance from its screen size, starting from the one in
+// lodLevels and writing the choice back, and get one draw call for each LOD in use
+// Draw calls using every instance render straight from the record's matrices; the others copy their
+// instances' matrices into visibleMatrices, which must have the capacity reserved up front
+// Bone offsets and custom data are read from the renderable and compacted the same way into
+// visibleBoneOffsets and visibleCustomData
+//
+void ForwardRenderingPath::ConstructDrawCallsForRenderable(const ForwardRenderPass_t& pass, const RenderableRecord_t& record, RenderScene* scene, std::vector<DrawCall>& drawCalls, const uint8_t* visibility, uint8_t* lodLevels, std::vector<Matrix44>& visibleMatrices, std::vector<uint32_t>& visibleBoneOffsets, std::vector<Vector4>& visibleCustomData)
+{
+	Renderable* renderable = record.renderable;
+	int instanceCount = record.instanceCount;
+	const uint32_t* instanceBoneOffsets = renderable->GetInstanceBoneOffsets();
+	const Vector4* instanceCustomData = renderable->GetInstanceCustomDatas();
+	const GPUSkinnedRenderable_t* skinnedRenderable = GPUSkinning::GetSkinnedRenderable(renderable);
+
+	// Taken in double precision, so the offset is exact however far both are from the world origin
+	bool isOffset = (record.worldOrigin != pass.renderOrigin);
+	Vector3 originOffset = (record.worldOrigin - pass.renderOrigin).ToVector3();
+
+	for (int dcIndex = 0; dcIndex < record.drawCount; ++dcIndex)
+	{
+		int firstEntry = dcIndex * instanceCount;
+		const uint8_t* instanceVisibility = visibility + firstEntry;
+
+		int numVisible = 0;
+		for (int instanceIndex = 0; instanceIndex < instanceCount; ++instanceIndex)
+		{
+			numVisible += (instanceVisibility[instanceIndex] != 0 ? 1 : 0);
+		}
+
+		// Skip draws with no visible instances before doing any work for them
+		if (numVisible == 0)
+		{
+			continue;
+		}
+
+		// Draws GPUSkinning already skinned have a mesh per instance, so each visible one is its own static draw
+		const GPUSkinnedDraw_t* skinnedDraws = (skinnedRenderable != nullptr ? &skinnedRenderable->draws[firstEntry] : nullptr);
+		if (skinnedDraws != nullptr && skinnedDraws[0].skinnedMesh != nullptr)
+		{
+			ConstructPreskinnedDrawCalls(pass, record, scene, dcIndex, skinnedDraws, drawCalls, instanceVisibility, visibleMatrices);
+			continue;
+		}
+
+		// Only visible instances change LOD, so ones coming back into view resume where they were
+		int lodCount = renderable->GetLODCount(dcIndex);
+		uint8_t* instanceLODs = lodLevels + firstEntry;
+
+		if (lodCount > 1)
+		{
+			for (int instanceIndex = 0; instanceIndex < instanceCount; ++instanceIndex)
+			{
+				if (instanceVisibility[instanceIndex] == 0)
+				{
+					continue;
+				}
+
+				int lodIndex = 0;
+				if (record.hasBounds[dcIndex] != 0)
+				{
+					float screenSize = CalculateScreenSize(record.worldBounds[firstEntry + instanceIndex], pass.viewProjection, pass.projection);
+					lodIndex = renderable->SelectLOD(dcIndex, screenSize, instanceLODs[instanceIndex], pass.lodHysteresis);
+				}
+
+				instanceLODs[instanceIndex] = (uint8_t) lodIndex;
+			}
+		}
+
+		// Lights come from the camera's light clusters, only the ambience is set per draw
+		Material* material = renderable->GetMaterialForRender(dcIndex);
+
+		for (int lodIndex = 0; lodIndex < lodCount; ++lodIndex)
+		{
+			int numAtLOD = numVisible;
+			if (lodCount > 1)
+			{
+				numAtLOD = 0;
+				for (int instanceIndex = 0; instanceIndex < instanceCount; ++instanceIndex)
+				{
+					numAtLOD += ((instanceVisibility[instanceIndex] != 0 && instanceLODs[instanceIndex] == lodIndex) ? 1 : 0);
+				}
+			}
+
+			if (numAtLOD == 0)
+			{
+				continue;
+			}
+
+			const Matrix44* drawMatrices = &record.worldMatrices[firstEntry];
+			const uint32_t* drawBoneOffsets = instanceBoneOffsets;
+			const Vector4* drawCustomData = instanceCustomData;
+
+			if (numAtLOD < instanceCount || isOffset)
+			{
+				// Capacity was reserved for every entry, so this never reallocates out from under earlier draw calls
+				int firstVisibleMatrix = (int) visibleMatrices.size();
+				int firstVisibleBoneOffset = (int) visibleBoneOffsets.size();
+				int firstVisibleCustomData = (int) visibleCustomData.size();
+
+				for (int instanceIndex = 0; instanceIndex < instanceCount; ++instanceIndex)
+				{
+					if (instanceVisibility[instanceIndex] != 0 && (lodCount == 1 || instanceLODs[instanceIndex] == lodIndex))
+					{
+						visibleMatrices.push_back(record.worldMatrices[firstEntry + instanceIndex]);
+
+						if (isOffset)
+						{
+							Matrix44& drawMatrix = visibleMatrices.back();
+							drawMatrix.Tx += originOffset.x;
+							drawMatrix.Ty += originOffset.y;
+							drawMatrix.Tz += originOffset.z;
+						}
+
+						if (instanceBoneOffsets != nullptr)
+						{
+							visibleBoneOffsets.push_back(instanceBoneOffsets[instanceIndex]);
+						}
+
+						if (instanceCustomData != nullptr)
+						{
+							visibleCustomData.push_back(instanceCustomData[instanceIndex]);
+						}
+					}
+				}
+
+				drawMatrices = &visibleMatrices[firstVisibleMatrix];
+				drawBoneOffsets = (instanceBoneOffsets != nullptr ? &visibleBoneOffsets[firstVisibleBoneOffset] : nullptr);
+				drawCustomData = (instanceCustomData != nullptr ? &visibleCustomData[firstVisibleCustomData] : nullptr);
+			}
+
+			DrawCall dc;
+
+			if (material->IsUsingLights())
 			{
-				maxIndex = j;
-				maxValue = intensities[j];
+				dc.SetAmbience(scene->GetAmbience());
+			}
+
+			bool hasModels = dc.SetDataFromRenderable(renderable, dcIndex, drawMatrices, numAtLOD, drawBoneOffsets, lodIndex);
+			dc.SetCustomData(drawCustomData);
+
+			// Add the draw call to the list to render
+			if (hasModels)
+			{
+				drawCalls.push_back(dc);
 			}
 		}
+	}
+}
 
-		// If we find a max in the remainder of the list that isn't at the start,
-		// swap it to the front
-		if (maxIndex != i)
+
+//-----------------------------------------------------------------------------------------------
+// Adds a draw call per visible instance of the draw, each drawing the mesh GPUSkinning skinned for it with
+// the single instance's world matrix, copied into visibleMatrices if it has to be offset
+//
+void ForwardRenderingPath::ConstructPreskinnedDrawCalls(const ForwardRenderPass_t& pass, const RenderableRecord_t& record, RenderScene* scene, int dcIndex, const GPUSkinnedDraw_t* skinnedDraws, std::vector<DrawCall>& drawCalls, const uint8_t* instanceVisibility, std::vector<Matrix44>& visibleMatrices)
+{
+	Renderable* renderable = record.renderable;
+	int instanceCount = record.instanceCount;
+	int firstEntry = dcIndex * instanceCount;
+	const Vector4* instanceCustomData = renderable->GetInstanceCustomDatas();
+	Material* material = renderable->GetMaterialForRender(dcIndex);
+
+	bool isOffset = (record.worldOrigin != pass.renderOrigin);
+	Vector3 originOffset = (record.worldOrigin - pass.renderOrigin).ToVector3();
+
+	for (int instanceIndex = 0; instanceIndex < instanceCount; ++instanceIndex)
+	{
+		if (instanceVisibility[instanceIndex] == 0)
 		{
-			float tempValue = intensities[i];
-			Light* tempLight = scene->m_lights[i];
+			continue;
+		}
+
+		const Matrix44* drawMatrix = &record.worldMatrices[firstEntry + instanceIndex];
+
+		// At most one per entry, so this stays within the reserved capacity
+		if (isOffset)
+		{
+			visibleMatrices.push_back(*drawMatrix);
+
+			Matrix44& offsetMatrix = visibleMatrices.back();
+			offsetMatrix.Tx += originOffset.x;
+			offsetMatrix.Ty += originOffset.y;
+			offsetMatrix.Tz += originOffset.z;
 
-			intensities[i] = intensities[maxIndex];
-			scene->m_lights[i] = scene->m_lights[maxIndex];
+			drawMatrix = &offsetMatrix;
+		}
+
+		DrawCall dc;
 
-			intensities[maxIndex] = tempValue;
-			scene->m_lights[maxIndex] = tempLight;
+		if (material->IsUsingLights())
+		{
+			dc.SetAmbience(scene->GetAmbience());
 		}
+
+		if (!dc.SetDataFromRenderable(renderable, dcIndex, drawMatrix, 1))
+		{
+			continue;
+		}
+
+		dc.SetCustomData(instanceCustomData != nullptr ? &instanceCustomData[instanceIndex] : nullptr);
+
+		const GPUSkinnedDraw_t& skinned = skinnedDraws[instanceIndex];
+		dc.SetPreskinned(skinned.skinnedMesh, skinned.shader, skinned.vaoHandle, skinned.depthVAOHandle, skinned.gBufferVAOHandle);
+
+		drawCalls.push_back(dc);
 	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the draw call's depth can be drawn ahead of it by the depth-only shader - opaque,
+// depth tested and written as usual, with the same faces drawn and untransformed vertex positions
+// Shaders that discard fragments can't be detected here, so they shouldn't be in the opaque queue
+//
+bool ForwardRenderingPath::CanDrawCallBeDepthPrepassed(const DrawCall& drawCall)
+{
+	const Mesh* mesh = drawCall.GetMesh();
+	if (mesh == nullptr || mesh->GetVertexLayout() == &VertexSkinned::LAYOUT || mesh->GetVertexLayout() == &VertexSkinnedPacked::LAYOUT || (drawCall.GetDepthVAOHandle() == 0 && !mesh->IsStoredInArena()))
+	{
+		return false;
+	}
+
+	const Shader* shader = drawCall.GetShader();
+	const RenderState& state = shader->GetRenderState();
+
+	bool isOpaque = (shader->GetQueue() == SORTING_QUEUE_OPAQUE);
+	bool isDepthNormal = (state.m_shouldWriteDepth && (state.m_depthTest == DEPTH_TEST_LESS || state.m_depthTest == DEPTH_TEST_LEQUAL));
+	bool isRasterNormal = (state.m_fillMode == FILL_MODE_SOLID && state.m_cullMode == CULL_MODE_BACK && state.m_windOrder == WIND_COUNTER_CLOCKWISE);
 
-	// Light list is sorted in decending order by intensity for this position
-	// Just need to add the correct number of lights into the drawCall
-	int numLightsToUse = MinInt(totalLights, MAX_NUMBER_OF_LIGHTS);
+	return (isOpaque && isDepthNormal && isRasterNormal);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sorts the draw calls given for a camera draw by their packed sort key (layer, queue, then state
+// for opaque or back to front for alpha)
+// The draw calls themselves aren't moved - out_drawOrder is filled with their indices in draw order
+//
+void ForwardRenderingPath::SortDrawCalls(std::vector<DrawCall>& drawCalls, const Vector3& cameraPosition, std::vector<int>& out_drawOrder, ForwardRenderingScratch_t& scratch)
+{
+	int numDrawCalls = (int) drawCalls.size();
+
+	std::vector<uint64_t>& keys = scratch.sortKeys;
+	keys.resize(numDrawCalls);
+	out_drawOrder.resize(numDrawCalls);
+
+	for (int index = 0; index < numDrawCalls; ++index)
+	{
+		drawCalls[index].ComputeSortKey(cameraPosition);
+
+		keys[index] = drawCalls[index].GetSortKey();
+		out_drawOrder[index] = index;
+	}
+
+	RadixSortKeys(keys, out_drawOrder, scratch.sortKeysScratch, scratch.drawOrderScratch);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sorts the keys ascending with an LSD radix sort, one byte per pass, carrying the indices along
+// Passes where every key has the same byte (usually the layer and queue) are skipped
+//
+void ForwardRenderingPath::RadixSortKeys(std::vector<uint64_t>& keys, std::vector<int>& indices, std::vector<uint64_t>& scratchKeys, std::vector<int>& scratchIndices)
+{
+	int numKeys = (int) keys.size();
+
+	if (numKeys < 2)
+	{
+		return;
+	}
+
+	scratchKeys.resize(numKeys);
+	scratchIndices.resize(numKeys);
+
+	uint64_t* sourceKeys = keys.data();
+	int* sourceIndices = indices.data();
+	uint64_t* destKeys = scratchKeys.data();
+	int* destIndices = scratchIndices.data();
+
+	for (int shift = 0; shift < 64; shift += 8)
+	{
+		int counts[256] = { 0 };
+
+		for (int index = 0; index < numKeys; ++index)
+		{
+			counts[(sourceKeys[index] >> shift) & 0xFF]++;
+		}
+
+		// Nothing to reorder on this byte
+		if (counts[(sourceKeys[0] >> shift) & 0xFF] == numKeys)
+		{
+			continue;
+		}
+
+		// Turn the counts into starting offsets
+		int offset = 0;
+		for (int bucket = 0; bucket < 256; ++bucket)
+		{
+			int count = counts[bucket];
+			counts[bucket] = offset;
+			offset += count;
+		}
+
+		for (int index = 0; index < numKeys; ++index)
+		{
+			int destIndex = counts[(sourceKeys[index] >> shift) & 0xFF]++;
+
+			destKeys[destIndex] = sourceKeys[index];
+			destIndices[destIndex] = sourceIndices[index];
+		}
+
+		std::swap(sourceKeys, destKeys);
+		std::swap(sourceIndices, destIndices);
+	}
 
-	for (int lightIndex = 0; lightIndex < numLightsToUse; ++lightIndex)
+	// Odd number of passes leaves the result in the scratch buffers
+	if (sourceKeys != keys.data())
 	{
-		drawCall.SetLight(lightIndex, scene->m_lights[lightIndex]);
+		memcpy(keys.data(), sourceKeys, sizeof(uint64_t) * numKeys);
+		memcpy(indices.data(), sourceIndices, sizeof(int) * numKeys);
 	}
-	drawCall.SetNumLightsInUse(numLightsToUse);
 }
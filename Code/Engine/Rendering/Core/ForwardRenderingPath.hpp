@@ -6,10 +6,23 @@
 /*				Static class - cannot be instantiated
 /************************************************************************/
 #pragma once
+#include <vector>
+#include <stdint.h>
 
 class RenderScene;
 class Camera;
 class Renderer;
+class Matrix44;
+class Vector3;
+class Vector4;
+class Frustum;
+class DrawCall;
+class HiZBuffer;
+class RenderGraph;
+struct RenderableRecord_t;
+struct GPUSkinnedDraw_t;
+struct ForwardRenderPass_t;
+struct ForwardRenderingScratch_t;
 
 class ForwardRenderingPath
 {
@@ -20,16 +33,35 @@ public:
 
 	static void Render(RenderScene* scene);
 
+	// Render() split in two, so other main thread work can run while the passes record
+	// The scene and its lights/cameras must not change until the commands are submitted
+	static void RecordCommands(RenderScene* scene);
+	static void SubmitCommands();
+
+	// The frame's graph, with the scene's passes added by RecordCommands(); passes added after, i.e. image
+	// effects reading the camera targets, run after them in SubmitCommands()
+	static RenderGraph* GetRenderGraph();
+
+	// The draw call sort, public so the benchmarks can time it without a renderer
+	static void RadixSortKeys(std::vector<uint64_t>& keys, std::vector<int>& indices, std::vector<uint64_t>& scratchKeys, std::vector<int>& scratchIndices);
+
 
 private:
 	//-----Private Methods-----
 
-	static void CreateShadowTexturesForCamera(RenderScene* scene, Camera* camera);
+	static void AddShadowPassesForCamera(RenderScene* scene, Camera* camera);
+	static void FitShadowCascadeToView(Camera* shadowCamera, Camera* viewCamera, const Vector3& lightDirection, float nearDistance, float farDistance);
+
+	static ForwardRenderPass_t* AddRenderPass(Camera* camera, bool isShadowPass, bool clearDepth);
+	static void AddGraphPasses(ForwardRenderPass_t* pass, RenderScene* scene);
+	static void RecordRenderPass(ForwardRenderPass_t* pass, RenderScene* scene);
+
+	static void CullRenderables(const Frustum& frustum, const HiZBuffer* occlusionBuffer, RenderScene* scene, std::vector<uint8_t>& out_visibility, std::vector<int>& out_visibilityOffsets);
+	static void ConstructDrawCallsForRenderable(const ForwardRenderPass_t& pass, const RenderableRecord_t& record, RenderScene* scene, std::vector<DrawCall>& drawCalls, const uint8_t* visibility, uint8_t* lodLevels, std::vector<Matrix44>& visibleMatrices, std::vector<uint32_t>& visibleBoneOffsets, std::vector<Vector4>& visibleCustomData);
 
-	static void ConstructDrawCallsForRenderable(Renderable* renderable, RenderScene* scene, std::vector<DrawCall>& drawCalls);
+	static void ConstructPreskinnedDrawCalls(const ForwardRenderPass_t& pass, const RenderableRecord_t& record, RenderScene* scene, int dcIndex, const GPUSkinnedDraw_t* skinnedDraws, std::vector<DrawCall>& drawCalls, const uint8_t* instanceVisibility, std::vector<Matrix44>& visibleMatrices);
 
-	static void SortDrawCalls(std::vector<DrawCall>& drawCalls);
-	static void RenderSceneForCamera(Camera* camera, RenderScene* scene);
-	static void ComputeLightsForDrawCall(DrawCall& drawCall, RenderScene* scene, const Vector3& position);
+	static bool CanDrawCallBeDepthPrepassed(const DrawCall& drawCall);
+	static void SortDrawCalls(std::vector<DrawCall>& drawCalls, const Vector3& cameraPosition, std::vector<int>& out_drawOrder, ForwardRenderingScratch_t& scratch);
 
 };
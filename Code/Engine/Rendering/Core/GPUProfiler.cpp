@@ -0,0 +1,313 @@
+/************************************************************************/
+/* File: GPUProfiler.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the GPUProfiler class
+/************************************************************************/
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/Time/Time.hpp"
+#include "Engine/Core/Time/Profiler.hpp"
+#include "Engine/Rendering/Core/GPUProfiler.hpp"
+#include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include <string.h>
+
+GPUProfiler* GPUProfiler::s_instance = nullptr;
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - creates every query up front
+//
+GPUProfiler::GPUProfiler()
+{
+	for (int poolIndex = 0; poolIndex < GPU_PROFILER_POOL_COUNT; ++poolIndex)
+	{
+		glGenQueries(GPU_PROFILER_MAX_QUERIES_PER_FRAME, m_pools[poolIndex].queryHandles);
+	}
+
+	GL_CHECK_ERROR();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+GPUProfiler::~GPUProfiler()
+{
+	for (int poolIndex = 0; poolIndex < GPU_PROFILER_POOL_COUNT; ++poolIndex)
+	{
+		glDeleteQueries(GPU_PROFILER_MAX_QUERIES_PER_FRAME, m_pools[poolIndex].queryHandles);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes the queries, to be called while the GL context still exists
+//
+void GPUProfiler::Shutdown()
+{
+	if (s_instance != nullptr)
+	{
+		delete s_instance;
+		s_instance = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Moves on to the next pool, reporting what it measured GPU_PROFILER_POOL_COUNT frames ago
+//
+void GPUProfiler::BeginFrame()
+{
+	if (!InitializeIfProfiling())
+	{
+		return;
+	}
+
+	if (s_instance->m_openScopeCount > 0 || s_instance->m_skippedScopeCount > 0)
+	{
+		LogTaggedPrintf("PROFILER", "Warning: GPUProfiler::BeginFrame() called with %i GPU scopes still open", s_instance->m_openScopeCount + s_instance->m_skippedScopeCount);
+
+		while (s_instance->m_openScopeCount > 0)
+		{
+			PopScope();
+		}
+
+		s_instance->m_skippedScopeCount = 0;
+	}
+
+	s_instance->m_currentPoolIndex = (s_instance->m_currentPoolIndex + 1) % GPU_PROFILER_POOL_COUNT;
+	GPUQueryPool_t& pool = s_instance->m_pools[s_instance->m_currentPoolIndex];
+
+	s_instance->ReportPoolResults(pool);
+	s_instance->CalibratePool(pool);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts timing a scope of GPU work
+//
+void GPUProfiler::PushScope(const char* name)
+{
+	if (s_instance == nullptr)
+	{
+		return;
+	}
+
+	GPUQueryPool_t& pool = s_instance->m_pools[s_instance->m_currentPoolIndex];
+
+	// Leave room for the ends of every open scope, including this one
+	bool hasRoom = (pool.queryCount + s_instance->m_openScopeCount + 2 <= GPU_PROFILER_MAX_QUERIES_PER_FRAME);
+
+	if (!hasRoom || s_instance->m_skippedScopeCount > 0)
+	{
+		s_instance->m_skippedScopeCount++;
+		return;
+	}
+
+	s_instance->IssueQuery(name);
+	s_instance->m_openScopeCount++;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Ends the innermost GPU scope
+//
+void GPUProfiler::PopScope()
+{
+	if (s_instance == nullptr)
+	{
+		return;
+	}
+
+	if (s_instance->m_skippedScopeCount > 0)
+	{
+		s_instance->m_skippedScopeCount--;
+		return;
+	}
+
+	ASSERT_OR_DIE(s_instance->m_openScopeCount > 0, "Error: GPUProfiler::PopScope() called with no GPU scope open");
+
+	s_instance->IssueQuery(nullptr);
+	s_instance->m_openScopeCount--;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of frames whose results weren't ready when their pool was needed again
+//
+int GPUProfiler::GetDroppedFrameCount()
+{
+	return (s_instance != nullptr ? s_instance->m_droppedFrameCount : 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the times of the scopes in the last frame reported, in the order they were first pushed
+//
+void GPUProfiler::GetLastFrameScopeTimes(std::vector<GPUScopeTime_t>& out_scopeTimes)
+{
+	out_scopeTimes.clear();
+
+	if (s_instance != nullptr)
+	{
+		out_scopeTimes = s_instance->m_lastFrameScopeTimes;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Creates the instance once the Profiler is running, as it's initialized after the Renderer
+// Returns true if there's an instance to use
+//
+bool GPUProfiler::InitializeIfProfiling()
+{
+	if (s_instance != nullptr)
+	{
+		return true;
+	}
+
+	if (Profiler::GetInstance() == nullptr)
+	{
+		return false;
+	}
+
+	int timelineIndex = Profiler::RegisterTimeline("GPU");
+	if (timelineIndex < 0)
+	{
+		return false;
+	}
+
+	s_instance = new GPUProfiler();
+	s_instance->m_timelineIndex = timelineIndex;
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sends the pool's scopes to the Profiler's GPU timeline and empties it
+// Only the last query of the frame is checked, as the GPU finishes them in order
+//
+void GPUProfiler::ReportPoolResults(GPUQueryPool_t& pool)
+{
+	m_lastFrameScopeTimes.clear();
+
+	if (pool.queryCount == 0)
+	{
+		return;
+	}
+
+	GLint isAvailable = 0;
+	glGetQueryObjectiv(pool.queryHandles[pool.queryCount - 1], GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+
+	if (isAvailable == 0)
+	{
+		m_droppedFrameCount++;
+		pool.queryCount = 0;
+		return;
+	}
+
+	// The timeline's times can't go backwards, so keep them in order in case the conversion wobbles
+	uint64_t lastHPC = 0;
+
+	// Start times and names of the open scopes, for the frame's scope times
+	uint64_t openStartTimes[GPU_PROFILER_MAX_QUERIES_PER_FRAME / 2];
+	const char* openNames[GPU_PROFILER_MAX_QUERIES_PER_FRAME / 2];
+	int openCount = 0;
+
+	for (int queryIndex = 0; queryIndex < pool.queryCount; ++queryIndex)
+	{
+		GLuint64 gpuTime = 0;
+		glGetQueryObjectui64v(pool.queryHandles[queryIndex], GL_QUERY_RESULT, &gpuTime);
+
+		uint64_t hpc = ConvertGPUTimeToHPC(pool, (uint64_t) gpuTime);
+		hpc = (hpc < lastHPC ? lastHPC : hpc);
+		lastHPC = hpc;
+
+		if (pool.names[queryIndex] != nullptr)
+		{
+			Profiler::PushTimelineMeasurement(m_timelineIndex, pool.names[queryIndex], hpc);
+
+			openStartTimes[openCount] = (uint64_t) gpuTime;
+			openNames[openCount] = pool.names[queryIndex];
+			openCount++;
+		}
+		else
+		{
+			Profiler::PopTimelineMeasurement(m_timelineIndex, hpc);
+
+			openCount--;
+			AddScopeTime(openNames[openCount], (uint64_t) gpuTime - openStartTimes[openCount]);
+		}
+	}
+
+	pool.queryCount = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the scope's time, in nanoseconds, to the last frame's total for its name
+// Scopes are few enough a frame that a search beats hashing
+//
+void GPUProfiler::AddScopeTime(const char* name, uint64_t nanoseconds)
+{
+	float milliseconds = (float) ((double) nanoseconds * 1e-6);
+
+	for (int scopeIndex = 0; scopeIndex < (int) m_lastFrameScopeTimes.size(); ++scopeIndex)
+	{
+		if (m_lastFrameScopeTimes[scopeIndex].name == name || strcmp(m_lastFrameScopeTimes[scopeIndex].name, name) == 0)
+		{
+			m_lastFrameScopeTimes[scopeIndex].milliseconds += milliseconds;
+			return;
+		}
+	}
+
+	GPUScopeTime_t scopeTime;
+	scopeTime.name = name;
+	scopeTime.milliseconds = milliseconds;
+
+	m_lastFrameScopeTimes.push_back(scopeTime);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Pairs the GPU's current time with the CPU's, for the frame about to use the pool
+//
+void GPUProfiler::CalibratePool(GPUQueryPool_t& pool)
+{
+	GLint64 gpuTime = 0;
+	glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+
+	pool.calibrationHPC = GetPerformanceCounter();
+	pool.calibrationGPUTime = (int64_t) gpuTime;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the HPC the GPU timestamp (in nanoseconds) lines up with on the CPU
+//
+uint64_t GPUProfiler::ConvertGPUTimeToHPC(const GPUQueryPool_t& pool, uint64_t gpuTime) const
+{
+	int64_t deltaNanoseconds = (int64_t) gpuTime - pool.calibrationGPUTime;
+
+	if (deltaNanoseconds >= 0)
+	{
+		return pool.calibrationHPC + TimeSystem::SecondsToPerformanceCount((double) deltaNanoseconds * 1e-9);
+	}
+
+	uint64_t deltaHPC = TimeSystem::SecondsToPerformanceCount((double) -deltaNanoseconds * 1e-9);
+	return (deltaHPC < pool.calibrationHPC ? pool.calibrationHPC - deltaHPC : 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records the GPU time at this point in the command stream, without waiting for it
+//
+void GPUProfiler::IssueQuery(const char* name)
+{
+	GPUQueryPool_t& pool = m_pools[m_currentPoolIndex];
+
+	glQueryCounter(pool.queryHandles[pool.queryCount], GL_TIMESTAMP);
+	pool.names[pool.queryCount] = name;
+	pool.queryCount++;
+}
@@ -0,0 +1,102 @@
+/************************************************************************/
+/* File: GPUProfiler.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Times GPU work with timestamp queries, and reports it to
+/*				the Profiler on a "GPU" timeline a few frames later
+/************************************************************************/
+#pragma once
+#include <vector>
+#include <stdint.h>
+
+#define GPU_PROFILER_POOL_COUNT (2)					// Frames of queries in flight, so results are read a frame after the GPU finishes
+#define GPU_PROFILER_MAX_QUERIES_PER_FRAME (512)	// Two per scope
+
+#define GPU_PROFILE_SCOPE_NAME_INNER(line) __gpuScope_##line
+#define GPU_PROFILE_SCOPE_NAME(line) GPU_PROFILE_SCOPE_NAME_INNER(line)
+#define PROFILE_GPU_SCOPE(name) GPUProfileScoped GPU_PROFILE_SCOPE_NAME(__LINE__)(name)
+
+// One frame's timestamp queries, in the order they were issued
+struct GPUQueryPool_t
+{
+	unsigned int	queryHandles[GPU_PROFILER_MAX_QUERIES_PER_FRAME];
+	const char*		names[GPU_PROFILER_MAX_QUERIES_PER_FRAME];	// nullptr for the end of the innermost scope
+	int				queryCount = 0;
+
+	// A GPU timestamp and the CPU time from the same moment, for moving the results onto the CPU's clock
+	int64_t			calibrationGPUTime = 0;
+	uint64_t		calibrationHPC = 0;
+};
+
+// Total GPU time of every scope with the name in one frame, nested scopes included
+struct GPUScopeTime_t
+{
+	const char*		name = nullptr;
+	float			milliseconds = 0.f;
+};
+
+
+class GPUProfiler
+{
+public:
+	//-----Public Methods-----
+
+	static void		Shutdown();
+
+	// Called by the Renderer at the start of the frame - reports the oldest pool's results if the GPU
+	// has them, otherwise drops them rather than waiting
+	static void		BeginFrame();
+
+	// Scope names must outlive the profiler's history, usually literals
+	static void		PushScope(const char* name);
+	static void		PopScope();
+
+	static int		GetDroppedFrameCount();
+
+	// Scope times of the last frame reported, GPU_PROFILER_POOL_COUNT frames behind; empty if it was dropped
+	static void		GetLastFrameScopeTimes(std::vector<GPUScopeTime_t>& out_scopeTimes);
+
+
+private:
+	//-----Private Methods-----
+
+	GPUProfiler();
+	~GPUProfiler();
+	GPUProfiler(const GPUProfiler& copy) = delete;
+
+	static bool		InitializeIfProfiling();
+	void			ReportPoolResults(GPUQueryPool_t& pool);
+	void			AddScopeTime(const char* name, uint64_t nanoseconds);
+	void			CalibratePool(GPUQueryPool_t& pool);
+	uint64_t		ConvertGPUTimeToHPC(const GPUQueryPool_t& pool, uint64_t gpuTime) const;
+	void			IssueQuery(const char* name);
+
+
+private:
+	//-----Private Data-----
+
+	int				m_timelineIndex = -1;
+	GPUQueryPool_t	m_pools[GPU_PROFILER_POOL_COUNT];
+	int				m_currentPoolIndex = 0;
+
+	int				m_openScopeCount = 0;
+	int				m_skippedScopeCount = 0;	// Pushed while the pool was full, so their pops are skipped too
+	int				m_droppedFrameCount = 0;
+
+	std::vector<GPUScopeTime_t> m_lastFrameScopeTimes;
+
+	static GPUProfiler* s_instance;
+
+};
+
+
+// Times the GPU work issued in the enclosing C++ scope
+class GPUProfileScoped
+{
+public:
+	//-----Public Methods-----
+
+	GPUProfileScoped(const char* name)	{ GPUProfiler::PushScope(name); }
+	~GPUProfileScoped()					{ GPUProfiler::PopScope(); }
+
+};
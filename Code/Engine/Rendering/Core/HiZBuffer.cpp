@@ -0,0 +1,313 @@
+/************************************************************************/
+/* File: HiZBuffer.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the HiZBuffer class
+/************************************************************************/
+#include <math.h>
+#include <string.h>
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/Core/Camera.hpp"
+#include "Engine/Rendering/Core/HiZBuffer.hpp"
+#include "Engine/Rendering/Resources/Texture.hpp"
+#include "Engine/Rendering/Shaders/ShaderSource.hpp"
+#include "Engine/Rendering/Shaders/ComputeShader.hpp"
+#include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include "Engine/Rendering/OpenGL/GLStateCache.hpp"
+
+ComputeShader* HiZBuffer::s_reduceShader = nullptr;
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+HiZBuffer::HiZBuffer()
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor - frees the fence of a reduction that was never read
+//
+HiZBuffer::~HiZBuffer()
+{
+	if (m_fence != nullptr)
+	{
+		glDeleteSync(m_fence);
+		m_fence = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reduces the camera's depth target to the coarse grid on the GPU, to be read back by a later
+// UpdateFromGPU() once the GPU has finished it
+// Must be called after the camera's opaque draws, with the view projection they were drawn with
+//
+void HiZBuffer::Build(Camera* camera, const Matrix44& viewProjection)
+{
+	Texture* depthTarget = camera->m_frameBuffer.m_depthTarget;
+	if (depthTarget == nullptr)
+	{
+		return;
+	}
+
+	if (s_reduceShader == nullptr)
+	{
+		s_reduceShader = new ComputeShader();
+		s_reduceShader->InitializeFromSource(ShaderSource::HI_Z_REDUCE_CS, ShaderSource::HI_Z_REDUCE_NAME);
+		s_reduceShader->SetProfileName("HiZ::Reduce");
+	}
+
+	if (s_reduceShader->GetProgramHandle() == NULL)
+	{
+		return;
+	}
+
+	// Same viewport the FrameBuffer renders to
+	int viewportX, viewportY, viewportWidth, viewportHeight;
+	camera->m_frameBuffer.GetPixelViewport(viewportX, viewportY, viewportWidth, viewportHeight);
+
+	if (viewportWidth <= 0 || viewportHeight <= 0)
+	{
+		return;
+	}
+
+	int numGroupsX = HI_Z_GRID_WIDTH / HI_Z_GROUP_SIZE;
+	int gridHeight = (int) ceilf((float) HI_Z_GRID_WIDTH * (float) viewportHeight / (float) viewportWidth);
+	int numGroupsY = MaxInt((gridHeight + HI_Z_GROUP_SIZE - 1) / HI_Z_GROUP_SIZE, 1);
+
+	IntVector2 gridDimensions = IntVector2(numGroupsX * HI_Z_GROUP_SIZE, numGroupsY * HI_Z_GROUP_SIZE);
+	if (gridDimensions.x != m_gpuGridDimensions.x || gridDimensions.y != m_gpuGridDimensions.y)
+	{
+		m_gpuDepths.AllocateOnGPU(sizeof(float) * gridDimensions.x * gridDimensions.y);
+		m_gpuGridDimensions = gridDimensions;
+	}
+
+	// texelFetch ignores filtering, but a sampler with compare mode on this unit would break it
+	ComputeBindingTable bindings;
+	bindings.SetTexture(0, depthTarget, nullptr);
+	bindings.SetStorageBuffer(HI_Z_DEPTHS_BINDING, &m_gpuDepths);
+	bindings.SetUniformInt(0, viewportX);
+	bindings.SetUniformInt(1, viewportY);
+	bindings.SetUniformInt(2, viewportWidth);
+	bindings.SetUniformInt(3, viewportHeight);
+
+	s_reduceShader->Dispatch(bindings, numGroupsX, numGroupsY, 1);
+
+	// The depths are only read back by mapping the buffer
+	ComputeShader::InsertBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+
+	// Replaces any reduction not read yet; the older CPU pyramid is kept until this one arrives
+	if (m_fence != nullptr)
+	{
+		glDeleteSync(m_fence);
+	}
+
+	m_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	m_gpuViewProjection = viewProjection;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies the last reduction into the CPU pyramid if the GPU has finished it, without waiting
+// Must not be called while jobs may be testing against the pyramid
+//
+void HiZBuffer::UpdateFromGPU()
+{
+	if (m_fence == nullptr)
+	{
+		return;
+	}
+
+	GLenum waitResult = glClientWaitSync(m_fence, 0, 0);
+	if (waitResult != GL_ALREADY_SIGNALED && waitResult != GL_CONDITION_SATISFIED)
+	{
+		return;
+	}
+
+	glDeleteSync(m_fence);
+	m_fence = nullptr;
+
+	const float* gridDepths = (const float*) m_gpuDepths.MapBufferData();
+
+	if (gridDepths != nullptr)
+	{
+		BuildPyramid(gridDepths);
+
+		m_viewProjection = m_gpuViewProjection;
+		m_hasDepths = true;
+	}
+
+	m_gpuDepths.UnmapBufferData();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the bounds are entirely behind the depths the pyramid was built from
+// Bounds that cross the near plane or leave the screen are never occluded, those are left to the
+// frustum test; the depths are a frame old, so this is only as correct as the scene is still
+//
+bool HiZBuffer::IsAABB3Occluded(const AABB3& worldBounds) const
+{
+	if (!m_hasDepths)
+	{
+		return false;
+	}
+
+	// Screen rect and nearest depth of the box, as the depths' view projection sees it
+	Vector3 ndcMins = Vector3(1.f, 1.f, 1.f);
+	Vector3 ndcMaxs = Vector3(-1.f, -1.f, -1.f);
+
+	for (int cornerIndex = 0; cornerIndex < 8; ++cornerIndex)
+	{
+		Vector3 corner;
+		corner.x = ((cornerIndex & 1) != 0 ? worldBounds.maxs.x : worldBounds.mins.x);
+		corner.y = ((cornerIndex & 2) != 0 ? worldBounds.maxs.y : worldBounds.mins.y);
+		corner.z = ((cornerIndex & 4) != 0 ? worldBounds.maxs.z : worldBounds.mins.z);
+
+		Vector4 clipPosition = m_viewProjection * Vector4(corner, 1.f);
+		if (clipPosition.w <= 0.f)
+		{
+			return false;
+		}
+
+		Vector3 ndcPosition = clipPosition.xyz() / clipPosition.w;
+
+		ndcMins.x = MinFloat(ndcMins.x, ndcPosition.x);
+		ndcMins.y = MinFloat(ndcMins.y, ndcPosition.y);
+		ndcMins.z = MinFloat(ndcMins.z, ndcPosition.z);
+		ndcMaxs.x = MaxFloat(ndcMaxs.x, ndcPosition.x);
+		ndcMaxs.y = MaxFloat(ndcMaxs.y, ndcPosition.y);
+	}
+
+	if (ndcMins.z <= -1.f || ndcMaxs.x < -1.f || ndcMins.x > 1.f || ndcMaxs.y < -1.f || ndcMins.y > 1.f)
+	{
+		return false;
+	}
+
+	float nearestDepth = 0.5f * ndcMins.z + 0.5f;
+
+	// Rect in cells of the finest level
+	IntVector2 gridDimensions = m_levelDimensions[0];
+	float minX = (0.5f * ClampFloatNegativeOneToOne(ndcMins.x) + 0.5f) * (float) gridDimensions.x;
+	float maxX = (0.5f * ClampFloatNegativeOneToOne(ndcMaxs.x) + 0.5f) * (float) gridDimensions.x;
+	float minY = (0.5f * ClampFloatNegativeOneToOne(ndcMins.y) + 0.5f) * (float) gridDimensions.y;
+	float maxY = (0.5f * ClampFloatNegativeOneToOne(ndcMaxs.y) + 0.5f) * (float) gridDimensions.y;
+
+	// Go up levels until the rect covers at most 3x3 cells
+	int numLevels = (int) m_levelDimensions.size();
+	int level = 0;
+	int startX, endX, startY, endY;
+
+	while (true)
+	{
+		float cellSize = (float) (1 << level);
+		IntVector2 levelDimensions = m_levelDimensions[level];
+
+		startX = ClampInt((int) floorf(minX / cellSize), 0, levelDimensions.x - 1);
+		endX = ClampInt((int) floorf(maxX / cellSize), 0, levelDimensions.x - 1);
+		startY = ClampInt((int) floorf(minY / cellSize), 0, levelDimensions.y - 1);
+		endY = ClampInt((int) floorf(maxY / cellSize), 0, levelDimensions.y - 1);
+
+		if ((endX - startX < 3 && endY - startY < 3) || level == numLevels - 1)
+		{
+			break;
+		}
+
+		level++;
+	}
+
+	// Visible if anything under the rect is as far as the box's nearest point
+	for (int y = startY; y <= endY; ++y)
+	{
+		for (int x = startX; x <= endX; ++x)
+		{
+			if (GetDepth(level, x, y) >= nearestDepth)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes the reduce shader shared by all buffers, called when the Renderer shuts down
+//
+void HiZBuffer::DestroySharedResources()
+{
+	if (s_reduceShader != nullptr)
+	{
+		delete s_reduceShader;
+		s_reduceShader = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Fills the CPU pyramid, the finest level from the reduced grid and each coarser level from the
+// max of 2x2 cells of the one before it
+//
+void HiZBuffer::BuildPyramid(const float* finestDepths)
+{
+	m_levelDimensions.clear();
+	m_levelOffsets.clear();
+
+	IntVector2 levelDimensions = m_gpuGridDimensions;
+	int totalCells = 0;
+
+	while (true)
+	{
+		m_levelDimensions.push_back(levelDimensions);
+		m_levelOffsets.push_back(totalCells);
+		totalCells += levelDimensions.x * levelDimensions.y;
+
+		if (levelDimensions.x == 1 && levelDimensions.y == 1)
+		{
+			break;
+		}
+
+		levelDimensions = IntVector2((levelDimensions.x + 1) / 2, (levelDimensions.y + 1) / 2);
+	}
+
+	m_depths.resize(totalCells);
+	memcpy(m_depths.data(), finestDepths, sizeof(float) * m_gpuGridDimensions.x * m_gpuGridDimensions.y);
+
+	int numLevels = (int) m_levelDimensions.size();
+	for (int level = 1; level < numLevels; ++level)
+	{
+		IntVector2 sourceDimensions = m_levelDimensions[level - 1];
+		IntVector2 destinationDimensions = m_levelDimensions[level];
+		float* destination = &m_depths[m_levelOffsets[level]];
+
+		for (int y = 0; y < destinationDimensions.y; ++y)
+		{
+			// Odd sizes repeat the last row/column instead of reading past it
+			int sourceY0 = 2 * y;
+			int sourceY1 = MinInt(2 * y + 1, sourceDimensions.y - 1);
+
+			for (int x = 0; x < destinationDimensions.x; ++x)
+			{
+				int sourceX0 = 2 * x;
+				int sourceX1 = MinInt(2 * x + 1, sourceDimensions.x - 1);
+
+				destination[y * destinationDimensions.x + x] = MaxFloat(
+					GetDepth(level - 1, sourceX0, sourceY0), GetDepth(level - 1, sourceX1, sourceY0),
+					GetDepth(level - 1, sourceX0, sourceY1), GetDepth(level - 1, sourceX1, sourceY1));
+			}
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the farthest depth under the cell of the given pyramid level
+//
+float HiZBuffer::GetDepth(int level, int x, int y) const
+{
+	return m_depths[m_levelOffsets[level] + y * m_levelDimensions[level].x + x];
+}
@@ -0,0 +1,68 @@
+/************************************************************************/
+/* File: HiZBuffer.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Class to keep a coarse farthest-depth pyramid of a
+/*				camera's last frame, for occlusion culling the next one
+/************************************************************************/
+#pragma once
+#include <vector>
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Matrix44.hpp"
+#include "Engine/Math/IntVector2.hpp"
+#include "Engine/Rendering/Buffers/RenderBuffer.hpp"
+
+class Camera;
+class ComputeShader;
+
+// Shader storage binding of the reduced depths, must match the Hi-Z reduce shader
+#define HI_Z_DEPTHS_BINDING (9)
+
+#define HI_Z_GRID_WIDTH (128)		// Cells across the viewport in the finest level, height follows the aspect
+#define HI_Z_GROUP_SIZE (8)			// Threads per side of a reduce work group, must match the shader
+
+
+class HiZBuffer
+{
+public:
+	//-----Public Methods-----
+
+	HiZBuffer();
+	~HiZBuffer();
+
+	// Render thread only
+	void	Build(Camera* camera, const Matrix44& viewProjection);
+	void	UpdateFromGPU();
+
+	// Reads the CPU pyramid only, so can be called from jobs between UpdateFromGPU() calls
+	bool	IsAABB3Occluded(const AABB3& worldBounds) const;
+
+	static void DestroySharedResources();
+
+
+private:
+	//-----Private Methods-----
+
+	void	BuildPyramid(const float* finestDepths);
+	float	GetDepth(int level, int x, int y) const;
+
+
+private:
+	//-----Private Data-----
+
+	// GPU reduction of the camera's depth target, read back once its fence signals
+	RenderBuffer			m_gpuDepths;
+	IntVector2				m_gpuGridDimensions = IntVector2(0, 0);
+	Matrix44				m_gpuViewProjection;
+	GLsync					m_fence = nullptr;
+
+	// CPU pyramid, level 0 is the grid and each level after takes the max of 2x2 cells of the last
+	bool					m_hasDepths = false;
+	Matrix44				m_viewProjection;	// The one the pyramid's depths were rendered with
+	std::vector<float>		m_depths;
+	std::vector<IntVector2>	m_levelDimensions;
+	std::vector<int>		m_levelOffsets;
+
+	static ComputeShader*	s_reduceShader;
+
+};
@@ -4,10 +4,14 @@
 /* Date: May 2nd, 2018
 /* Description: Implementation of the light class
 /************************************************************************/
+#include <math.h>
 #include "Engine/Core/Rgba.hpp"
 #include "Engine/Rendering/Core/Light.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/Core/Camera.hpp"
 #include "Engine/Rendering/Resources/Texture.hpp"
+#include "Engine/Rendering/Resources/RenderTargetPool.hpp"
 
 
 //-----------------------------------------------------------------------------------------------
@@ -15,11 +19,7 @@
 //
 Light::~Light()
 {
-	if (m_shadowTexture != nullptr)
-	{
-		delete m_shadowTexture;
-		m_shadowTexture = nullptr;
-	}
+	SetShadowCasting(false);
 }
 
 
@@ -52,8 +52,22 @@ void Light::SetShadowCasting(bool castsShadows)
 	{
 		if (m_shadowTexture == nullptr)
 		{
-			m_shadowTexture = new Texture();
-			m_shadowTexture->CreateRenderTarget(4096, 4096, TEXTURE_FORMAT_D24S8);
+			// Pooled, so lights turning shadows on and off share the same few textures
+			m_shadowTexture = RenderTargetPool::Acquire(IntVector2(SHADOW_TEXTURE_SIZE, SHADOW_TEXTURE_SIZE), TEXTURE_FORMAT_D24S8);
+
+			// Cameras are kept for the life of the texture, each drawing to its cell of the atlas
+			float cellSize = 1.f / (float) SHADOW_CASCADE_ATLAS_WIDTH;
+
+			for (int cascadeIndex = 0; cascadeIndex < SHADOW_CASCADE_COUNT; ++cascadeIndex)
+			{
+				Vector2 cellMins = cellSize * Vector2((float) (cascadeIndex % SHADOW_CASCADE_ATLAS_WIDTH), (float) (cascadeIndex / SHADOW_CASCADE_ATLAS_WIDTH));
+
+				m_shadowCameras[cascadeIndex] = new Camera();
+				m_shadowCameras[cascadeIndex]->SetDepthTarget(m_shadowTexture);
+				m_shadowCameras[cascadeIndex]->SetViewport(AABB2(cellMins, cellMins + Vector2(cellSize, cellSize)));
+			}
+
+			m_shadowRenderedRevision = 0;
 		}
 
 		m_lightData.m_castsShadows = 1.0f;	// To indicate in the shader that we do shadows
@@ -62,7 +76,13 @@ void Light::SetShadowCasting(bool castsShadows)
 	{
 		if (m_shadowTexture != nullptr)
 		{
-			delete m_shadowTexture;
+			for (int cascadeIndex = 0; cascadeIndex < SHADOW_CASCADE_COUNT; ++cascadeIndex)
+			{
+				delete m_shadowCameras[cascadeIndex];
+				m_shadowCameras[cascadeIndex] = nullptr;
+			}
+
+			RenderTargetPool::Release(m_shadowTexture);
 			m_shadowTexture = nullptr;
 		}
 
@@ -71,6 +91,36 @@ void Light::SetShadowCasting(bool castsShadows)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Sets how far from the view the given shadow cascade reaches
+// Distances should increase with the cascade index
+//
+void Light::SetShadowCascadeDistance(int cascadeIndex, float distance)
+{
+	ASSERT_OR_DIE(cascadeIndex >= 0 && cascadeIndex < SHADOW_CASCADE_COUNT, Stringf("Error: Light::SetShadowCascadeDistance() received bad index %i", cascadeIndex));
+	m_shadowCascadeDistances[cascadeIndex] = distance;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the scene renderables revision the shadow texture was rendered with, so the next shadow
+// pass can be skipped if nothing changed; 0 forces the next pass to render
+//
+void Light::SetShadowRenderedRevision(unsigned int revision)
+{
+	m_shadowRenderedRevision = revision;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets whether the light is baked into the scene's light probes instead of lighting at runtime
+//
+void Light::SetBaked(bool isBaked)
+{
+	m_isBaked = isBaked;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the light data struct for this light
 //
@@ -89,6 +139,15 @@ bool Light::IsShadowCasting() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns true if the light is only applied through the scene's light probes
+//
+bool Light::IsBaked() const
+{
+	return m_isBaked;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the shadow texture used by this light, nullptr if it doesn't have one
 //
@@ -98,6 +157,35 @@ Texture* Light::GetShadowTexture() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the camera used to render the given shadow cascade, nullptr if this light doesn't cast shadows
+//
+Camera* Light::GetShadowCamera(int cascadeIndex) const
+{
+	ASSERT_OR_DIE(cascadeIndex >= 0 && cascadeIndex < SHADOW_CASCADE_COUNT, Stringf("Error: Light::GetShadowCamera() received bad index %i", cascadeIndex));
+	return m_shadowCameras[cascadeIndex];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns how far from the view the given shadow cascade reaches
+//
+float Light::GetShadowCascadeDistance(int cascadeIndex) const
+{
+	ASSERT_OR_DIE(cascadeIndex >= 0 && cascadeIndex < SHADOW_CASCADE_COUNT, Stringf("Error: Light::GetShadowCascadeDistance() received bad index %i", cascadeIndex));
+	return m_shadowCascadeDistances[cascadeIndex];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the scene renderables revision the shadow texture was last rendered with, 0 if never
+//
+unsigned int Light::GetShadowRenderedRevision() const
+{
+	return m_shadowRenderedRevision;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Given a position, calculates this light's intensity at that position (based on distance and
 // attenuation)
@@ -112,6 +200,52 @@ float Light::CalculateIntensityForPosition(const Vector3& position) const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the distance at which this light's intensity falls to minIntensity, or -1 if it never
+// does (directional lights, or lights with only constant attenuation)
+//
+float Light::CalculateRange(float minIntensity) const
+{
+	return CalculateRange(m_lightData, minIntensity);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the range of the given light data, as above
+// Only reads the data, so it can be used on copies taken for other threads
+//
+float Light::CalculateRange(const LightData& lightData, float minIntensity)
+{
+	if (lightData.m_directionFactor == 0.f)
+	{
+		return -1.f;
+	}
+
+	// Solve intensity / (a + b * d + c * d^2) = minIntensity for d
+	const Vector3& attenuation = lightData.m_attenuation;
+	float constantTerm = attenuation.x - (lightData.m_color.w / minIntensity);
+
+	// Never reaches minIntensity, even at the light's position
+	if (constantTerm >= 0.f)
+	{
+		return 0.f;
+	}
+
+	if (attenuation.z > 0.f)
+	{
+		float discriminant = attenuation.y * attenuation.y - 4.f * attenuation.z * constantTerm;
+		return (-attenuation.y + sqrtf(discriminant)) / (2.f * attenuation.z);
+	}
+
+	if (attenuation.y > 0.f)
+	{
+		return -constantTerm / attenuation.y;
+	}
+
+	return -1.f;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Constructs and returns a Light as a point light
 //
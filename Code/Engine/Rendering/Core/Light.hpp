@@ -11,7 +11,12 @@
 
 #define MAX_NUMBER_OF_LIGHTS (8)
 
+#define SHADOW_TEXTURE_SIZE (4096)
+#define SHADOW_CASCADE_COUNT (4)		// Must match the shaders
+#define SHADOW_CASCADE_ATLAS_WIDTH (2)	// Cascades per row of the shadow texture, must match the shaders
+
 class Texture;
+class Camera;
 
 // Light data for a single light
 struct LightData
@@ -27,7 +32,7 @@ struct LightData
 
 	Vector4 m_color;
 
-	Matrix44 m_shadowVP;
+	Matrix44 m_shadowVP[SHADOW_CASCADE_COUNT];
 
 	Vector3 m_padding0;
 	float m_castsShadows = 0.f;
@@ -45,14 +50,26 @@ public:
 	void		SetPosition(const Vector3& position);
 	void		SetLightData(const LightData& data);
 	void		SetShadowCasting(bool castsShadows);
+	void		SetShadowCascadeDistance(int cascadeIndex, float distance);
+	void		SetShadowRenderedRevision(unsigned int revision);
+
+	// Baked lights only reach the scene through its LightProbeVolume, so they take none of the
+	// runtime light budget and cast no shadow maps; they need re-baking to move
+	void		SetBaked(bool isBaked);
 
 	// Accessors
 	LightData	GetLightData() const;
 	bool		IsShadowCasting() const;
 	Texture*	GetShadowTexture() const;
+	Camera*		GetShadowCamera(int cascadeIndex) const;
+	float		GetShadowCascadeDistance(int cascadeIndex) const;
+	unsigned int GetShadowRenderedRevision() const;
+	bool		IsBaked() const;
 
 	// Producers
 	float		CalculateIntensityForPosition(const Vector3& position) const;
+	float		CalculateRange(float minIntensity) const;
+	static float CalculateRange(const LightData& lightData, float minIntensity);
 
 	// Statics
 	static Light* CreatePointLight(const Vector3& position, const Rgba& color = Rgba::WHITE, const Vector3& attenuation = Vector3(1.f, 0.f, 0.f));
@@ -66,6 +83,16 @@ private:
 	LightData m_lightData;
 
 	bool m_isShadowCasting = false;
+	bool m_isBaked = false;
 	Texture* m_shadowTexture = nullptr;
 
+	// One camera per cascade, each rendering to its own cell of the shadow texture
+	Camera* m_shadowCameras[SHADOW_CASCADE_COUNT] = { nullptr, nullptr, nullptr, nullptr };
+
+	// Distance from the view each cascade covers up to, increasing
+	float m_shadowCascadeDistances[SHADOW_CASCADE_COUNT] = { 10.f, 30.f, 80.f, 200.f };
+
+	// Scene renderables revision the shadow texture was last rendered with, 0 if it needs rendering
+	unsigned int m_shadowRenderedRevision = 0;
+
 };
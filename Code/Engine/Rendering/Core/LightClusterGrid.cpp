@@ -0,0 +1,282 @@
+/************************************************************************/
+/* File: LightClusterGrid.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the LightClusterGrid class
+/************************************************************************/
+#include <math.h>
+#include <string.h>
+#include "Engine/Math/Frustum.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/Core/LightClusterGrid.hpp"
+
+#define LIGHT_CLUSTER_TOTAL_COUNT (LIGHT_CLUSTER_COUNT_X * LIGHT_CLUSTER_COUNT_Y * LIGHT_CLUSTER_COUNT_Z)
+#define LIGHT_CLUSTER_HEADER_WORDS (sizeof(LightClusterHeader_t) / sizeof(uint32_t))
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - uploads an empty grid, so the lit shaders only use the lights set per draw
+//
+LightClusterGrid::LightClusterGrid()
+{
+	Clear();
+	UploadAndBind();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Bins the given lights into the clusters of the view, replacing any previous grid
+// lightData is a copy of each light's data taken by the caller (parallel to lights), and only the
+// copies are read, so grids can be built on any thread; UploadAndBind() sends the result to the GPU
+// Each light is bounded by a sphere where it falls below LIGHT_CLUSTER_MIN_INTENSITY, and added to
+// every cluster the sphere's depth range and screen bounds touch; lights without a falloff
+// (directional, or constant attenuation) are added to all clusters
+//
+void LightClusterGrid::Build(const Matrix44& viewProjection, const std::vector<LightData>& lightData, const std::vector<Light*>& lights)
+{
+	Frustum frustum = Frustum(viewProjection);
+
+	// Depth is measured from the near plane, and the far plane faces it
+	Vector4 nearPlane = frustum.GetNormalizedPlane(FRUSTUM_PLANE_NEAR);
+	Vector4 farPlane = frustum.GetNormalizedPlane(FRUSTUM_PLANE_FAR);
+	m_farDepth = nearPlane.w + farPlane.w;
+
+	// Keep at least a few slices worth of range for very shallow views
+	float firstSliceDepth = MinFloat(LIGHT_CLUSTER_FIRST_SLICE_DEPTH, m_farDepth / (float) LIGHT_CLUSTER_COUNT_Z);
+	float logDepthRatio = logf(m_farDepth / firstSliceDepth) / (float) (LIGHT_CLUSTER_COUNT_Z - 1);
+
+	m_header.dimensions[0] = LIGHT_CLUSTER_COUNT_X;
+	m_header.dimensions[1] = LIGHT_CLUSTER_COUNT_Y;
+	m_header.dimensions[2] = LIGHT_CLUSTER_COUNT_Z;
+	m_header.dimensions[3] = 0;
+	m_header.viewProjection = viewProjection;
+	m_header.nearPlane = nearPlane;
+	m_header.depthParams = Vector4(firstSliceDepth, 1.f / logDepthRatio, 0.f, 0.f);
+
+	// Find the clusters each light reaches
+	m_lightData.clear();
+	m_lightRanges.clear();
+	m_shadowCastingLight = nullptr;
+
+	int numLights = (int) lightData.size();
+	for (int lightIndex = 0; lightIndex < numLights; ++lightIndex)
+	{
+		LightData data = lightData[lightIndex];
+
+		if (data.m_color.w <= 0.f)
+		{
+			continue;
+		}
+
+		LightClusterRange_t range = { 0, LIGHT_CLUSTER_COUNT_X - 1, 0, LIGHT_CLUSTER_COUNT_Y - 1, 0, LIGHT_CLUSTER_COUNT_Z - 1 };
+		float radius = Light::CalculateRange(data, LIGHT_CLUSTER_MIN_INTENSITY);
+
+		if (radius >= 0.f && !GetClusterRangeForSphere(data.m_position, radius, range))
+		{
+			continue;
+		}
+
+		// Only one shadow texture can be bound, so only the first shadow casting light samples it
+		if (data.m_castsShadows != 0.f)
+		{
+			if (m_shadowCastingLight == nullptr)
+			{
+				m_shadowCastingLight = lights[lightIndex];
+			}
+			else
+			{
+				data.m_castsShadows = 0.f;
+			}
+		}
+
+		m_lightData.push_back(data);
+		m_lightRanges.push_back(range);
+	}
+
+	// Count the lights per cluster, storing counts in the (first, count) pairs
+	m_clusterData.assign(LIGHT_CLUSTER_HEADER_WORDS + 2 * LIGHT_CLUSTER_TOTAL_COUNT, 0);
+	uint32_t* clusterPairs = m_clusterData.data() + LIGHT_CLUSTER_HEADER_WORDS;
+
+	int numReachingLights = (int) m_lightRanges.size();
+	for (int lightIndex = 0; lightIndex < numReachingLights; ++lightIndex)
+	{
+		const LightClusterRange_t& range = m_lightRanges[lightIndex];
+
+		for (int z = range.minZ; z <= range.maxZ; ++z)
+		{
+			for (int y = range.minY; y <= range.maxY; ++y)
+			{
+				for (int x = range.minX; x <= range.maxX; ++x)
+				{
+					int clusterIndex = (z * LIGHT_CLUSTER_COUNT_Y + y) * LIGHT_CLUSTER_COUNT_X + x;
+					clusterPairs[2 * clusterIndex + 1]++;
+				}
+			}
+		}
+	}
+
+	// Lay the index lists out back to back after the pairs (entries are relative to the pairs)
+	m_clusterCursors.resize(LIGHT_CLUSTER_TOTAL_COUNT);
+	uint32_t totalEntries = 0;
+
+	for (int clusterIndex = 0; clusterIndex < LIGHT_CLUSTER_TOTAL_COUNT; ++clusterIndex)
+	{
+		uint32_t firstEntry = 2 * LIGHT_CLUSTER_TOTAL_COUNT + totalEntries;
+
+		clusterPairs[2 * clusterIndex] = firstEntry;
+		m_clusterCursors[clusterIndex] = firstEntry;
+
+		totalEntries += clusterPairs[2 * clusterIndex + 1];
+	}
+
+	m_clusterData.resize(m_clusterData.size() + totalEntries);
+	uint32_t* clusterEntries = m_clusterData.data() + LIGHT_CLUSTER_HEADER_WORDS;
+
+	for (int lightIndex = 0; lightIndex < numReachingLights; ++lightIndex)
+	{
+		const LightClusterRange_t& range = m_lightRanges[lightIndex];
+
+		for (int z = range.minZ; z <= range.maxZ; ++z)
+		{
+			for (int y = range.minY; y <= range.maxY; ++y)
+			{
+				for (int x = range.minX; x <= range.maxX; ++x)
+				{
+					int clusterIndex = (z * LIGHT_CLUSTER_COUNT_Y + y) * LIGHT_CLUSTER_COUNT_X + x;
+					clusterEntries[m_clusterCursors[clusterIndex]++] = (uint32_t) lightIndex;
+				}
+			}
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Empties the grid, so once uploaded draws outside of a camera pass only use the lights set on them
+//
+void LightClusterGrid::Clear()
+{
+	memset(&m_header, 0, sizeof(LightClusterHeader_t));
+
+	m_lightData.clear();
+	m_lightRanges.clear();
+	m_shadowCastingLight = nullptr;
+
+	m_clusterData.assign(LIGHT_CLUSTER_HEADER_WORDS, 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the shadow casting light whose shadow texture the clustered lights use, nullptr if none
+//
+Light* LightClusterGrid::GetShadowCastingLight() const
+{
+	return m_shadowCastingLight;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds the clusters touched by the sphere, returning false if it's entirely outside the view
+// The screen range comes from projecting the corners of the sphere's bounding box, and is the
+// whole screen if any corner is behind the camera
+//
+bool LightClusterGrid::GetClusterRangeForSphere(const Vector3& center, float radius, LightClusterRange_t& out_range) const
+{
+	const Vector4& nearPlane = m_header.nearPlane;
+	float depth = DotProduct(nearPlane.xyz(), center) + nearPlane.w;
+
+	if (depth + radius < 0.f || depth - radius > m_farDepth)
+	{
+		return false;
+	}
+
+	out_range.minZ = GetSliceForDepth(depth - radius);
+	out_range.maxZ = GetSliceForDepth(depth + radius);
+
+	Vector2 ndcMins = Vector2(1.f, 1.f);
+	Vector2 ndcMaxs = Vector2(-1.f, -1.f);
+
+	for (int cornerIndex = 0; cornerIndex < 8; ++cornerIndex)
+	{
+		Vector3 corner = center;
+		corner.x += ((cornerIndex & 1) != 0 ? radius : -radius);
+		corner.y += ((cornerIndex & 2) != 0 ? radius : -radius);
+		corner.z += ((cornerIndex & 4) != 0 ? radius : -radius);
+
+		Vector4 clipPosition = m_header.viewProjection * Vector4(corner, 1.f);
+
+		if (clipPosition.w <= 0.f)
+		{
+			out_range.minX = 0;
+			out_range.maxX = LIGHT_CLUSTER_COUNT_X - 1;
+			out_range.minY = 0;
+			out_range.maxY = LIGHT_CLUSTER_COUNT_Y - 1;
+
+			return true;
+		}
+
+		Vector2 ndcPosition = Vector2(clipPosition.x / clipPosition.w, clipPosition.y / clipPosition.w);
+
+		ndcMins.x = MinFloat(ndcMins.x, ndcPosition.x);
+		ndcMins.y = MinFloat(ndcMins.y, ndcPosition.y);
+		ndcMaxs.x = MaxFloat(ndcMaxs.x, ndcPosition.x);
+		ndcMaxs.y = MaxFloat(ndcMaxs.y, ndcPosition.y);
+	}
+
+	if (ndcMaxs.x < -1.f || ndcMins.x > 1.f || ndcMaxs.y < -1.f || ndcMins.y > 1.f)
+	{
+		return false;
+	}
+
+	out_range.minX = ClampInt((int) floorf((ndcMins.x * 0.5f + 0.5f) * (float) LIGHT_CLUSTER_COUNT_X), 0, LIGHT_CLUSTER_COUNT_X - 1);
+	out_range.maxX = ClampInt((int) floorf((ndcMaxs.x * 0.5f + 0.5f) * (float) LIGHT_CLUSTER_COUNT_X), 0, LIGHT_CLUSTER_COUNT_X - 1);
+	out_range.minY = ClampInt((int) floorf((ndcMins.y * 0.5f + 0.5f) * (float) LIGHT_CLUSTER_COUNT_Y), 0, LIGHT_CLUSTER_COUNT_Y - 1);
+	out_range.maxY = ClampInt((int) floorf((ndcMaxs.y * 0.5f + 0.5f) * (float) LIGHT_CLUSTER_COUNT_Y), 0, LIGHT_CLUSTER_COUNT_Y - 1);
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the depth slice containing the given distance from the near plane
+// Must match GetClusterLightRange() in the lit shaders
+//
+int LightClusterGrid::GetSliceForDepth(float depth) const
+{
+	float firstSliceDepth = m_header.depthParams.x;
+
+	if (depth <= firstSliceDepth)
+	{
+		return 0;
+	}
+
+	int slice = (int) (logf(depth / firstSliceDepth) * m_header.depthParams.y) + 1;
+	return MinInt(slice, LIGHT_CLUSTER_COUNT_Z - 1);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies the header and lists to the GPU and binds them for the lit shaders
+// Must be called on the render thread
+//
+void LightClusterGrid::UploadAndBind()
+{
+	memcpy(m_clusterData.data(), &m_header, sizeof(LightClusterHeader_t));
+
+	m_clusterBuffer.CopyToGPU(m_clusterData.size() * sizeof(uint32_t), m_clusterData.data());
+	m_clusterBuffer.Bind(LIGHT_CLUSTER_BINDING);
+
+	// Storage buffers can't be empty, so always upload at least one (unreferenced) light
+	if (m_lightData.size() == 0)
+	{
+		LightData unusedLight;
+		m_lightBuffer.CopyToGPU(sizeof(LightData), &unusedLight);
+	}
+	else
+	{
+		m_lightBuffer.CopyToGPU(m_lightData.size() * sizeof(LightData), m_lightData.data());
+	}
+
+	m_lightBuffer.Bind(CLUSTER_LIGHTS_BINDING);
+}
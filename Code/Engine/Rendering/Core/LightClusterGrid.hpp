@@ -0,0 +1,83 @@
+/************************************************************************/
+/* File: LightClusterGrid.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Class to bin a scene's lights into a 3D grid of view clusters
+/*				(screen tiles x depth slices) for clustered forward shading
+/************************************************************************/
+#pragma once
+#include <vector>
+#include <stdint.h>
+#include "Engine/Math/Matrix44.hpp"
+#include "Engine/Rendering/Core/Light.hpp"
+#include "Engine/Rendering/Buffers/RenderBuffer.hpp"
+
+// Shader storage bindings, must match the lit shaders
+#define LIGHT_CLUSTER_BINDING (6)
+#define CLUSTER_LIGHTS_BINDING (7)
+
+#define LIGHT_CLUSTER_COUNT_X (16)
+#define LIGHT_CLUSTER_COUNT_Y (9)
+#define LIGHT_CLUSTER_COUNT_Z (24)
+#define LIGHT_CLUSTER_FIRST_SLICE_DEPTH (1.f)		// Slices after the first get exponentially deeper
+#define LIGHT_CLUSTER_MIN_INTENSITY (1.f / 256.f)	// Lights are cut off where they get dimmer than this
+
+// Range of clusters a light reaches, inclusive
+struct LightClusterRange_t
+{
+	int minX; int maxX;
+	int minY; int maxY;
+	int minZ; int maxZ;
+};
+
+// Start of the cluster buffer, matches the lightClusterSSBO layout in the shaders
+struct LightClusterHeader_t
+{
+	unsigned int	dimensions[4];		// xyz cluster counts, 0 when no clusters are set
+	Matrix44		viewProjection;
+	Vector4			nearPlane;			// xyz unit normal into the view, w distance
+	Vector4			depthParams;		// x first slice depth, y 1 / log(slice depth ratio)
+};
+
+
+class LightClusterGrid
+{
+public:
+	//-----Public Methods-----
+
+	LightClusterGrid();
+
+	void	Build(const Matrix44& viewProjection, const std::vector<LightData>& lightData, const std::vector<Light*>& lights);
+	void	Clear();
+	void	UploadAndBind();
+
+	Light*	GetShadowCastingLight() const;
+
+
+private:
+	//-----Private Methods-----
+
+	bool	GetClusterRangeForSphere(const Vector3& center, float radius, LightClusterRange_t& out_range) const;
+	int		GetSliceForDepth(float depth) const;
+
+
+private:
+	//-----Private Data-----
+
+	LightClusterHeader_t m_header;
+
+	// Lights reaching any cluster this build, and the clusters they reach (parallel)
+	std::vector<LightData>				m_lightData;
+	std::vector<LightClusterRange_t>	m_lightRanges;
+	Light*								m_shadowCastingLight = nullptr;
+
+	// Header, then (first entry, count) per cluster, then the light index entries
+	std::vector<uint32_t>	m_clusterData;
+	std::vector<uint32_t>	m_clusterCursors;
+
+	float					m_farDepth = 0.f;
+
+	RenderBuffer			m_clusterBuffer;
+	RenderBuffer			m_lightBuffer;
+
+};
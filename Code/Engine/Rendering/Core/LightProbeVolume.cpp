@@ -0,0 +1,623 @@
+/************************************************************************/
+/* File: LightProbeVolume.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the LightProbeVolume class
+/************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "Engine/Core/File.hpp"
+#include "Engine/Math/AABBTree.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/Core/Light.hpp"
+#include "Engine/Rendering/Core/Renderable.hpp"
+#include "Engine/Rendering/Core/RenderScene.hpp"
+#include "Engine/Rendering/Core/LightProbeVolume.hpp"
+#include "Engine/Core/JobSystem/ParallelFor.hpp"
+#include "Engine/Core/Time/ProfileLogScoped.hpp"
+
+// The layouts are the file format and the shader's buffer, so they can't change without a version bump
+static_assert(sizeof(LightProbe_t) == 144, "LightProbe_t changed size, bump LIGHT_PROBE_FILE_VERSION");
+static_assert(sizeof(LightProbeFileHeader_t) == 64, "LightProbeFileHeader_t changed size, bump LIGHT_PROBE_FILE_VERSION");
+static_assert(sizeof(LightProbeVolumeHeader_t) == 3 * sizeof(Vector4), "LightProbeVolumeHeader_t must match lightProbeSSBO");
+
+#define LIGHT_PROBE_HEADER_VECTORS (sizeof(LightProbeVolumeHeader_t) / sizeof(Vector4))
+#define LIGHT_PROBE_BAKE_PROBES_PER_JOB (16)
+
+// Cosine lobe convolution per coefficient (pi, 2pi/3 and pi/4 for bands 0, 1 and 2), so the baked
+// coefficients are irradiance - a light straight along the normal gives its full Dot3 intensity
+static const float s_cosineLobeBands[LIGHT_PROBE_SH_COEFFICIENT_COUNT] =
+{
+	3.141593f,
+	2.094395f, 2.094395f, 2.094395f,
+	0.785398f, 0.785398f, 0.785398f, 0.785398f, 0.785398f
+};
+
+// Occluder hits for the probe being baked, per thread like AABBTree's traversal stack
+static thread_local std::vector<AABBTreeRaycastHit_t> s_occluderHits;
+
+static void		EvaluateSHBasis(const Vector3& direction, float* out_basis);
+static float	SmoothStepBetween(float edge0, float edge1, float value);
+static int		GetProbeCountForExtent(float extent, float spacing, int maxCount);
+static bool		IsLightBlocked(const AABBTree& occluders, const Vector3& start, const Vector3& direction, float maxDistance, const Vector3& lightPosition, bool isPointLight);
+static void		BakeProbe(const Vector3& position, const std::vector<LightData>& lights, const AABBTree* occluders, const LightProbeBakeSettings_t& settings, LightProbe_t& out_probe);
+static size_t	AppendPadding(std::vector<uint8_t>& buffer);
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - uploads an empty volume, so the lit shaders only use the ambience and their lights
+//
+LightProbeVolume::LightProbeVolume()
+{
+	Clear();
+	UploadAndBind(Vector3::ZERO);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Bakes over the union of the scene's static renderables' bounds
+//
+bool LightProbeVolume::Bake(RenderScene* scene, const LightProbeBakeSettings_t& settings /*= LightProbeBakeSettings_t()*/)
+{
+	AABB3 bounds;
+	bool hasBounds = false;
+
+	for (Renderable* renderable : scene->m_renderables)
+	{
+		if (!renderable->IsStatic())
+		{
+			continue;
+		}
+
+		int drawCount = renderable->GetDrawCountPerInstance();
+		int instanceCount = renderable->GetInstanceCount();
+
+		for (int instanceIndex = 0; instanceIndex < instanceCount; ++instanceIndex)
+		{
+			for (int drawIndex = 0; drawIndex < drawCount; ++drawIndex)
+			{
+				AABB3 drawBounds;
+				if (renderable->GetWorldBounds(drawIndex, instanceIndex, drawBounds))
+				{
+					bounds = (hasBounds ? bounds.GetUnion(drawBounds) : drawBounds);
+					hasBounds = true;
+				}
+			}
+		}
+	}
+
+	if (!hasBounds)
+	{
+		LogTaggedPrintf("RENDER", "Error: LightProbeVolume::Bake() found no static renderables with bounds to cover");
+		return false;
+	}
+
+	return Bake(scene, bounds, settings);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Places probes across the bounds at the settings' spacing and bakes each on the JobSystem
+// Each baked light is a delta from its direction, so it adds to the probe exactly, scaled by the same
+// attenuation and cone factor the shaders use; the static renderables' bounds are only a coarse
+// stand-in for the geometry, so probes are lit or not per light rather than soft shadowed
+//
+bool LightProbeVolume::Bake(RenderScene* scene, const AABB3& bounds, const LightProbeBakeSettings_t& settings /*= LightProbeBakeSettings_t()*/)
+{
+	PROFILE_LOG_SCOPE("LightProbeVolume::Bake");
+
+	float spacing = MaxFloat(settings.probeSpacing, 0.01f);
+	int maxCount = MaxInt(settings.maxProbesPerAxis, 1);
+	Vector3 extents = bounds.GetDimensions();
+
+	IntVector3 dimensions = IntVector3(
+		GetProbeCountForExtent(extents.x, spacing, maxCount),
+		GetProbeCountForExtent(extents.y, spacing, maxCount),
+		GetProbeCountForExtent(extents.z, spacing, maxCount));
+
+	SetGrid(bounds, dimensions);
+
+	// Copy the lights out, the jobs only read the copies
+	std::vector<LightData> lights;
+	for (Light* light : scene->m_lights)
+	{
+		if (light->IsBaked())
+		{
+			lights.push_back(light->GetLightData());
+		}
+	}
+
+	AABBTree* occluders = nullptr;
+	if (settings.useStaticOcclusion)
+	{
+		occluders = new AABBTree(0.f);
+
+		for (Renderable* renderable : scene->m_renderables)
+		{
+			if (!renderable->IsStatic())
+			{
+				continue;
+			}
+
+			int drawCount = renderable->GetDrawCountPerInstance();
+			int instanceCount = renderable->GetInstanceCount();
+
+			for (int instanceIndex = 0; instanceIndex < instanceCount; ++instanceIndex)
+			{
+				for (int drawIndex = 0; drawIndex < drawCount; ++drawIndex)
+				{
+					AABB3 drawBounds;
+					if (renderable->GetWorldBounds(drawIndex, instanceIndex, drawBounds))
+					{
+						occluders->AddLeaf(drawBounds, renderable);
+					}
+				}
+			}
+		}
+	}
+
+	int probeCount = GetProbeCount();
+	ParallelFor(0, probeCount, LIGHT_PROBE_BAKE_PROBES_PER_JOB, [this, &lights, occluders, &settings](int probeIndex)
+	{
+		IntVector3 coords;
+		coords.x = probeIndex % m_dimensions.x;
+		coords.y = (probeIndex / m_dimensions.x) % m_dimensions.y;
+		coords.z = probeIndex / (m_dimensions.x * m_dimensions.y);
+
+		BakeProbe(GetProbePosition(coords), lights, occluders, settings, m_probes[probeIndex]);
+	});
+
+	if (occluders != nullptr)
+	{
+		delete occluders;
+		occluders = nullptr;
+	}
+
+	LogTaggedPrintf("RENDER", "LightProbeVolume baked %i probes (%i x %i x %i) from %i lights", probeCount, dimensions.x, dimensions.y, dimensions.z, (int) lights.size());
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes all probes, so the shaders sample nothing
+//
+void LightProbeVolume::Clear()
+{
+	SetGrid(AABB3(Vector3::ZERO, Vector3::ZERO), IntVector3(0, 0, 0));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the probes as they are in memory, laid out like a cooked mesh file
+//
+bool LightProbeVolume::WriteToFile(const std::string& filepath) const
+{
+	std::vector<uint8_t> buffer;
+	buffer.resize(sizeof(LightProbeFileHeader_t), 0);
+
+	LightProbeFileHeader_t header;
+	header.fourCC = LIGHT_PROBE_FILE_FOURCC;
+	header.version = LIGHT_PROBE_FILE_VERSION;
+	header.probeCount = (uint32_t) m_probes.size();
+	header.coefficientCount = LIGHT_PROBE_SH_COEFFICIENT_COUNT;
+
+	header.boundsMins[0] = m_bounds.mins.x;
+	header.boundsMins[1] = m_bounds.mins.y;
+	header.boundsMins[2] = m_bounds.mins.z;
+	header.boundsMaxs[0] = m_bounds.maxs.x;
+	header.boundsMaxs[1] = m_bounds.maxs.y;
+	header.boundsMaxs[2] = m_bounds.maxs.z;
+
+	header.dimensions[0] = m_dimensions.x;
+	header.dimensions[1] = m_dimensions.y;
+	header.dimensions[2] = m_dimensions.z;
+	header.reserved = 0;
+
+	header.probeDataOffset = AppendPadding(buffer);
+	memcpy(buffer.data(), &header, sizeof(header));
+
+	if (m_probes.size() > 0)
+	{
+		const uint8_t* probeBytes = (const uint8_t*) m_probes.data();
+		buffer.insert(buffer.end(), probeBytes, probeBytes + m_probes.size() * sizeof(LightProbe_t));
+	}
+
+	File file;
+	if (!file.Open(filepath.c_str(), "wb"))
+	{
+		LogTaggedPrintf("RENDER", "Error: LightProbeVolume couldn't open \"%s\" for writing", filepath.c_str());
+		return false;
+	}
+
+	file.Write(buffer.data(), buffer.size());
+	return file.Close();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads a volume written by WriteToFile(), replacing any probes; the volume is left as it was on failure
+//
+bool LightProbeVolume::LoadFromFile(const std::string& filepath)
+{
+	size_t dataSize = 0;
+	uint8_t* data = (uint8_t*) FileReadBinaryToNewBuffer(filepath.c_str(), dataSize);
+
+	if (data == nullptr)
+	{
+		LogTaggedPrintf("RENDER", "Error: LightProbeVolume couldn't open \"%s\"", filepath.c_str());
+		return false;
+	}
+
+	LightProbeFileHeader_t header;
+	bool isValid = (dataSize >= sizeof(LightProbeFileHeader_t));
+
+	if (isValid)
+	{
+		memcpy(&header, data, sizeof(header));
+
+		isValid = (header.fourCC == LIGHT_PROBE_FILE_FOURCC && header.version == LIGHT_PROBE_FILE_VERSION && header.coefficientCount == LIGHT_PROBE_SH_COEFFICIENT_COUNT);
+	}
+
+	if (isValid)
+	{
+		// Dimensions all zero for an empty volume, otherwise all positive
+		int64_t expectedCount = (int64_t) header.dimensions[0] * (int64_t) header.dimensions[1] * (int64_t) header.dimensions[2];
+		bool hasValidDimensions = (header.dimensions[0] >= 0 && header.dimensions[1] >= 0 && header.dimensions[2] >= 0 && expectedCount == (int64_t) header.probeCount);
+
+		uint64_t probeBytes = (uint64_t) header.probeCount * sizeof(LightProbe_t);
+		isValid = (hasValidDimensions && header.probeDataOffset <= dataSize && probeBytes <= dataSize - header.probeDataOffset);
+	}
+
+	if (!isValid)
+	{
+		LogTaggedPrintf("RENDER", "Error: \"%s\" isn't a light probe file of version %i", filepath.c_str(), LIGHT_PROBE_FILE_VERSION);
+		free(data);
+
+		return false;
+	}
+
+	Vector3 mins = Vector3(header.boundsMins[0], header.boundsMins[1], header.boundsMins[2]);
+	Vector3 maxs = Vector3(header.boundsMaxs[0], header.boundsMaxs[1], header.boundsMaxs[2]);
+	SetGrid(AABB3(mins, maxs), IntVector3(header.dimensions[0], header.dimensions[1], header.dimensions[2]));
+
+	if (header.probeCount > 0)
+	{
+		memcpy(m_probes.data(), data + header.probeDataOffset, header.probeCount * sizeof(LightProbe_t));
+	}
+
+	free(data);
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Binds the probes for the lit shaders; only uploads when they've changed since the last upload, or
+// when the render origin has (only the header moves, but it shares the buffer)
+//
+void LightProbeVolume::UploadAndBind(const Vector3& renderOrigin)
+{
+	if (m_isUploadDirty || renderOrigin != m_uploadedRenderOrigin)
+	{
+		LightProbeVolumeHeader_t header;
+		header.volumeMins = Vector4(m_bounds.mins - renderOrigin, (HasProbes() ? 1.f : 0.f));
+		header.inverseCellSize = Vector4((m_cellSize.x > 0.f ? 1.f / m_cellSize.x : 0.f), (m_cellSize.y > 0.f ? 1.f / m_cellSize.y : 0.f), (m_cellSize.z > 0.f ? 1.f / m_cellSize.z : 0.f), 0.f);
+		header.dimensions[0] = (unsigned int) m_dimensions.x;
+		header.dimensions[1] = (unsigned int) m_dimensions.y;
+		header.dimensions[2] = (unsigned int) m_dimensions.z;
+		header.dimensions[3] = 0;
+
+		// Storage buffers can't be empty, so always upload at least one (unsampled) probe
+		size_t probeCount = (m_probes.size() > 0 ? m_probes.size() : 1);
+		m_uploadData.assign(LIGHT_PROBE_HEADER_VECTORS + probeCount * LIGHT_PROBE_SH_COEFFICIENT_COUNT, Vector4(0.f, 0.f, 0.f, 0.f));
+
+		memcpy(m_uploadData.data(), &header, sizeof(header));
+		if (m_probes.size() > 0)
+		{
+			memcpy(m_uploadData.data() + LIGHT_PROBE_HEADER_VECTORS, m_probes.data(), m_probes.size() * sizeof(LightProbe_t));
+		}
+
+		m_probeBuffer.CopyToGPU(m_uploadData.size() * sizeof(Vector4), m_uploadData.data());
+
+		m_isUploadDirty = false;
+		m_uploadedRenderOrigin = renderOrigin;
+	}
+
+	m_probeBuffer.Bind(LIGHT_PROBE_BINDING);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the irradiance at the position for a surface facing along the normal, trilinearly blended
+// between the 8 closest probes and clamped to the volume - zero if there are no probes
+//
+Vector3 LightProbeVolume::SampleIrradiance(const Vector3& position, const Vector3& normal) const
+{
+	if (!HasProbes())
+	{
+		return Vector3::ZERO;
+	}
+
+	Vector3 fromMins = position - m_bounds.mins;
+	float gridCoords[3];
+	gridCoords[0] = (m_cellSize.x > 0.f ? ClampFloat(fromMins.x / m_cellSize.x, 0.f, (float) (m_dimensions.x - 1)) : 0.f);
+	gridCoords[1] = (m_cellSize.y > 0.f ? ClampFloat(fromMins.y / m_cellSize.y, 0.f, (float) (m_dimensions.y - 1)) : 0.f);
+	gridCoords[2] = (m_cellSize.z > 0.f ? ClampFloat(fromMins.z / m_cellSize.z, 0.f, (float) (m_dimensions.z - 1)) : 0.f);
+
+	int maxCoords[3] = { m_dimensions.x - 1, m_dimensions.y - 1, m_dimensions.z - 1 };
+	int baseCoords[3];
+	float fractions[3];
+
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		baseCoords[axis] = (int) gridCoords[axis];
+		fractions[axis] = gridCoords[axis] - (float) baseCoords[axis];
+	}
+
+	Vector3 result = Vector3::ZERO;
+	for (int corner = 0; corner < 8; ++corner)
+	{
+		int offsets[3] = { (corner & 1), ((corner >> 1) & 1), ((corner >> 2) & 1) };
+		float weight = 1.f;
+
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			weight *= (offsets[axis] == 1 ? fractions[axis] : 1.f - fractions[axis]);
+		}
+
+		if (weight > 0.f)
+		{
+			IntVector3 coords = IntVector3(MinInt(baseCoords[0] + offsets[0], maxCoords[0]), MinInt(baseCoords[1] + offsets[1], maxCoords[1]), MinInt(baseCoords[2] + offsets[2], maxCoords[2]));
+			result += EvaluateProbe(GetProbeIndex(coords), normal) * weight;
+		}
+	}
+
+	return result;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the volume has any probes to sample
+//
+bool LightProbeVolume::HasProbes() const
+{
+	return (m_probes.size() > 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of probes in the volume
+//
+int LightProbeVolume::GetProbeCount() const
+{
+	return (int) m_probes.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of probes along each axis
+//
+IntVector3 LightProbeVolume::GetDimensions() const
+{
+	return m_dimensions;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the bounds the probes span, the outer probes are on its faces
+//
+AABB3 LightProbeVolume::GetBounds() const
+{
+	return m_bounds;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the world position of the probe at the grid coordinates
+//
+Vector3 LightProbeVolume::GetProbePosition(const IntVector3& coords) const
+{
+	return m_bounds.mins + Vector3(m_cellSize.x * (float) coords.x, m_cellSize.y * (float) coords.y, m_cellSize.z * (float) coords.z);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Resizes the grid to the dimensions over the bounds, with every probe unlit
+//
+void LightProbeVolume::SetGrid(const AABB3& bounds, const IntVector3& dimensions)
+{
+	m_bounds = bounds;
+	m_dimensions = dimensions;
+
+	Vector3 extents = bounds.GetDimensions();
+	m_cellSize.x = (dimensions.x > 1 ? extents.x / (float) (dimensions.x - 1) : 0.f);
+	m_cellSize.y = (dimensions.y > 1 ? extents.y / (float) (dimensions.y - 1) : 0.f);
+	m_cellSize.z = (dimensions.z > 1 ? extents.z / (float) (dimensions.z - 1) : 0.f);
+
+	LightProbe_t unlitProbe;
+	for (int coefficientIndex = 0; coefficientIndex < LIGHT_PROBE_SH_COEFFICIENT_COUNT; ++coefficientIndex)
+	{
+		unlitProbe.coefficients[coefficientIndex] = Vector4(0.f, 0.f, 0.f, 0.f);
+	}
+
+	m_probes.assign(dimensions.x * dimensions.y * dimensions.z, unlitProbe);
+	m_isUploadDirty = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the index into m_probes of the probe at the coordinates
+//
+int LightProbeVolume::GetProbeIndex(const IntVector3& coords) const
+{
+	return (coords.z * m_dimensions.y + coords.y) * m_dimensions.x + coords.x;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the probe's irradiance for the normal, never negative
+//
+Vector3 LightProbeVolume::EvaluateProbe(int probeIndex, const Vector3& normal) const
+{
+	float basis[LIGHT_PROBE_SH_COEFFICIENT_COUNT];
+	EvaluateSHBasis(normal, basis);
+
+	const LightProbe_t& probe = m_probes[probeIndex];
+	Vector3 result = Vector3::ZERO;
+
+	for (int coefficientIndex = 0; coefficientIndex < LIGHT_PROBE_SH_COEFFICIENT_COUNT; ++coefficientIndex)
+	{
+		result += probe.coefficients[coefficientIndex].xyz() * basis[coefficientIndex];
+	}
+
+	return Vector3(MaxFloat(result.x, 0.f), MaxFloat(result.y, 0.f), MaxFloat(result.z, 0.f));
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Writes the 9 real L2 spherical harmonics basis functions for the unit direction, in the probes' order
+//
+static void EvaluateSHBasis(const Vector3& direction, float* out_basis)
+{
+	float x = direction.x;
+	float y = direction.y;
+	float z = direction.z;
+
+	out_basis[0] = 0.282095f;
+	out_basis[1] = 0.488603f * y;
+	out_basis[2] = 0.488603f * z;
+	out_basis[3] = 0.488603f * x;
+	out_basis[4] = 1.092548f * x * y;
+	out_basis[5] = 1.092548f * y * z;
+	out_basis[6] = 0.315392f * (3.f * z * z - 1.f);
+	out_basis[7] = 1.092548f * x * z;
+	out_basis[8] = 0.546274f * (x * x - y * y);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Hermite step of the value between the edges, the same as GLSL's smoothstep()
+//
+static float SmoothStepBetween(float edge0, float edge1, float value)
+{
+	if (edge0 == edge1)
+	{
+		return (value < edge0 ? 0.f : 1.f);
+	}
+
+	float t = ClampFloatZeroToOne((value - edge0) / (edge1 - edge0));
+	return SmoothStep3(t);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the probes needed to cover the extent at the spacing, with one on each end
+//
+static int GetProbeCountForExtent(float extent, float spacing, int maxCount)
+{
+	if (extent <= 0.f)
+	{
+		return 1;
+	}
+
+	return ClampInt(Ceiling(extent / spacing) + 1, 1, maxCount);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns true if an occluder lies between the start and the light along the direction
+// Occluders around the probe or the light don't count, since their bounds can't say which side of
+// the real surface either is on
+//
+static bool IsLightBlocked(const AABBTree& occluders, const Vector3& start, const Vector3& direction, float maxDistance, const Vector3& lightPosition, bool isPointLight)
+{
+	std::vector<AABBTreeRaycastHit_t>& hits = s_occluderHits;
+	hits.clear();
+
+	occluders.RaycastAll(start, direction, maxDistance, hits);
+
+	for (const AABBTreeRaycastHit_t& hit : hits)
+	{
+		AABB3 occluderBounds = occluders.GetLeafBounds(hit.leafID);
+
+		if (occluderBounds.ContainsPoint(start) || (isPointLight && occluderBounds.ContainsPoint(lightPosition)))
+		{
+			continue;
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Projects every light reaching the position into the probe, as irradiance
+// Direction, attenuation and cone factor match AddLightContribution() in the lit shaders
+//
+static void BakeProbe(const Vector3& position, const std::vector<LightData>& lights, const AABBTree* occluders, const LightProbeBakeSettings_t& settings, LightProbe_t& out_probe)
+{
+	Vector3 coefficients[LIGHT_PROBE_SH_COEFFICIENT_COUNT];
+	for (int coefficientIndex = 0; coefficientIndex < LIGHT_PROBE_SH_COEFFICIENT_COUNT; ++coefficientIndex)
+	{
+		coefficients[coefficientIndex] = Vector3::ZERO;
+	}
+
+	float basis[LIGHT_PROBE_SH_COEFFICIENT_COUNT];
+
+	for (const LightData& light : lights)
+	{
+		bool isPointLight = (light.m_directionFactor > 0.5f);
+
+		Vector3 toLight = light.m_position - position;
+		float distance = toLight.NormalizeAndGetLength();
+		Vector3 directionToLight = (isPointLight ? toLight : light.m_lightDirection * -1.f);
+
+		float denominator = light.m_attenuation.x + light.m_attenuation.y * distance + light.m_attenuation.z * distance * distance;
+		float attenuation = (denominator > 0.f ? light.m_color.w / denominator : 0.f);
+		float coneFactor = SmoothStepBetween(light.m_dotOuterAngle, light.m_dotInnerAngle, DotProduct(toLight * -1.f, light.m_lightDirection));
+
+		float intensity = attenuation * coneFactor;
+		if (intensity <= 0.f || (isPointLight && distance == 0.f))
+		{
+			continue;
+		}
+
+		if (occluders != nullptr)
+		{
+			float maxDistance = (isPointLight ? distance : settings.directionalShadowDistance);
+
+			if (IsLightBlocked(*occluders, position, directionToLight, maxDistance, light.m_position, isPointLight))
+			{
+				continue;
+			}
+		}
+
+		Vector3 color = light.m_color.xyz() * intensity;
+		EvaluateSHBasis(directionToLight, basis);
+
+		for (int coefficientIndex = 0; coefficientIndex < LIGHT_PROBE_SH_COEFFICIENT_COUNT; ++coefficientIndex)
+		{
+			coefficients[coefficientIndex] += color * (basis[coefficientIndex] * s_cosineLobeBands[coefficientIndex]);
+		}
+	}
+
+	for (int coefficientIndex = 0; coefficientIndex < LIGHT_PROBE_SH_COEFFICIENT_COUNT; ++coefficientIndex)
+	{
+		out_probe.coefficients[coefficientIndex] = Vector4(coefficients[coefficientIndex], 0.f);
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Pads the buffer out to the file's data alignment, returning the aligned size
+//
+static size_t AppendPadding(std::vector<uint8_t>& buffer)
+{
+	size_t alignedSize = (buffer.size() + (LIGHT_PROBE_FILE_DATA_ALIGNMENT - 1)) & ~((size_t) LIGHT_PROBE_FILE_DATA_ALIGNMENT - 1);
+	buffer.resize(alignedSize, 0);
+
+	return alignedSize;
+}
@@ -0,0 +1,136 @@
+/************************************************************************/
+/* File: LightProbeVolume.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Grid of light probes over a scene's static geometry, each
+/*				holding the irradiance of the scene's baked lights as L2
+/*				spherical harmonics, baked across the JobSystem and
+/*				sampled by the lit shaders in place of those lights
+/************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Vector4.hpp"
+#include "Engine/Math/IntVector3.hpp"
+#include "Engine/Rendering/Buffers/RenderBuffer.hpp"
+
+class RenderScene;
+
+// Shader storage binding, must match the lit shaders
+#define LIGHT_PROBE_BINDING (18)
+
+// L2 spherical harmonics, must match the lit shaders
+#define LIGHT_PROBE_SH_COEFFICIENT_COUNT (9)
+
+#define LIGHT_PROBE_DEFAULT_SPACING (2.f)
+#define LIGHT_PROBE_DEFAULT_MAX_PER_AXIS (64)
+#define LIGHT_PROBE_DEFAULT_SHADOW_DISTANCE (1000.f)	// How far toward directional lights the bake looks for occluders
+
+// "CLPV" in the file, read as a little endian uint32
+#define LIGHT_PROBE_FILE_FOURCC (0x56504C43)
+
+// Bump whenever the layout below or the coefficient order changes, old files are rejected and need re-baking
+#define LIGHT_PROBE_FILE_VERSION (1)
+
+// Probe data starts on this boundary from the start of the file, the same as cooked meshes
+#define LIGHT_PROBE_FILE_DATA_ALIGNMENT (16)
+
+// One probe's irradiance, already convolved with the cosine lobe, so the shaders only evaluate the basis
+// Coefficients are rgb in xyz, w unused, in the order Y00, Y1-1, Y10, Y11, Y2-2, Y2-1, Y20, Y21, Y22
+struct LightProbe_t
+{
+	Vector4 coefficients[LIGHT_PROBE_SH_COEFFICIENT_COUNT];
+};
+
+// Start of the probe buffer, matches the lightProbeSSBO layout in the shaders
+struct LightProbeVolumeHeader_t
+{
+	Vector4			volumeMins;			// xyz relative to the render origin, w 1 when there are probes
+	Vector4			inverseCellSize;	// xyz, 0 on axes with a single probe
+	unsigned int	dimensions[4];		// xyz probe counts
+};
+
+struct LightProbeFileHeader_t
+{
+	uint32_t fourCC;
+	uint32_t version;
+	uint32_t probeCount;
+	uint32_t coefficientCount;
+
+	float boundsMins[3];
+	float boundsMaxs[3];
+
+	int32_t dimensions[3];
+	uint32_t reserved;
+
+	uint64_t probeDataOffset;		// From the start of the file
+};
+
+struct LightProbeBakeSettings_t
+{
+	float	probeSpacing = LIGHT_PROBE_DEFAULT_SPACING;
+	int		maxProbesPerAxis = LIGHT_PROBE_DEFAULT_MAX_PER_AXIS;	// The spacing widens to fit big scenes
+
+	// Lights are blocked by the bounds of the scene's static renderables, except boxes the probe is inside
+	bool	useStaticOcclusion = true;
+	float	directionalShadowDistance = LIGHT_PROBE_DEFAULT_SHADOW_DISTANCE;
+};
+
+
+class LightProbeVolume
+{
+public:
+	//-----Public Methods-----
+
+	LightProbeVolume();
+
+	// Bakes the scene's baked lights (Light::IsBaked()) into probes over the bounds, across the JobSystem
+	// Without bounds the volume covers the scene's static renderables; returns false if there's nothing to cover
+	// Main thread, not while the scene is rendering; returns once every probe is done
+	bool	Bake(RenderScene* scene, const LightProbeBakeSettings_t& settings = LightProbeBakeSettings_t());
+	bool	Bake(RenderScene* scene, const AABB3& bounds, const LightProbeBakeSettings_t& settings = LightProbeBakeSettings_t());
+	void	Clear();
+
+	// Baked volumes are saved and loaded as they are, so shipping builds never bake
+	bool	WriteToFile(const std::string& filepath) const;
+	bool	LoadFromFile(const std::string& filepath);
+
+	// Uploads the probes if they changed, offset so the shaders can sample positions relative to the render origin
+	void	UploadAndBind(const Vector3& renderOrigin);
+
+	// The same irradiance the shaders sample, for lighting things on the CPU (i.e. particles, or debugging)
+	Vector3 SampleIrradiance(const Vector3& position, const Vector3& normal) const;
+
+	// Accessors
+	bool		HasProbes() const;
+	int			GetProbeCount() const;
+	IntVector3	GetDimensions() const;
+	AABB3		GetBounds() const;
+	Vector3		GetProbePosition(const IntVector3& coords) const;
+
+
+private:
+	//-----Private Methods-----
+
+	void	SetGrid(const AABB3& bounds, const IntVector3& dimensions);
+	int		GetProbeIndex(const IntVector3& coords) const;
+	Vector3 EvaluateProbe(int probeIndex, const Vector3& normal) const;
+
+
+private:
+	//-----Private Data-----
+
+	AABB3						m_bounds;
+	IntVector3					m_dimensions = IntVector3(0, 0, 0);
+	Vector3						m_cellSize = Vector3::ZERO;
+	std::vector<LightProbe_t>	m_probes;		// x fastest, then y, then z
+
+	// Header then probes, as the shaders read them
+	std::vector<Vector4>		m_uploadData;
+	RenderBuffer				m_probeBuffer;
+	bool						m_isUploadDirty = true;
+	Vector3						m_uploadedRenderOrigin = Vector3::ZERO;
+
+};
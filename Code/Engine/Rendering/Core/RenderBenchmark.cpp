@@ -0,0 +1,686 @@
+/************************************************************************/
+/* File: RenderBenchmark.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the RenderBenchmark class
+/************************************************************************/
+#include "Engine/Core/File.hpp"
+#include "Engine/Core/Window.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/CubicSpline.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/Time/Time.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time/Profiler.hpp"
+#include "Engine/Core/Time/ProfileCounters.hpp"
+#include "Engine/Core/Time/ProfileHistogram.hpp"
+#include "Engine/Core/Memory/MemoryTracker.hpp"
+#include "Engine/Rendering/Core/Camera.hpp"
+#include "Engine/Rendering/Core/Renderer.hpp"
+#include "Engine/Rendering/Core/GPUProfiler.hpp"
+#include "Engine/Rendering/Core/RenderBenchmark.hpp"
+#include "Engine/Core/DeveloperConsole/Command.hpp"
+#include "Engine/Core/DeveloperConsole/DevConsole.hpp"
+#include <string.h>
+
+std::vector<RenderBenchmarkScene_t>		RenderBenchmark::s_scenes;
+
+bool									RenderBenchmark::s_isRunning = false;
+bool									RenderBenchmark::s_isMeasuring = false;
+int										RenderBenchmark::s_sceneIndex = -1;
+Camera*									RenderBenchmark::s_camera = nullptr;
+float									RenderBenchmark::s_durationSeconds = 0.f;
+std::string								RenderBenchmark::s_reportPath;
+std::string								RenderBenchmark::s_tracePath;
+int										RenderBenchmark::s_previousVSyncMode = VSYNC_ON;
+float									RenderBenchmark::s_previousFrameRateCap = 0.f;
+
+uint64_t								RenderBenchmark::s_startHPC = 0;
+uint64_t								RenderBenchmark::s_measureStartHPC = 0;
+uint64_t								RenderBenchmark::s_lastFrameHPC = 0;
+
+int										RenderBenchmark::s_frameCount = 0;
+ProfileHistogram*						RenderBenchmark::s_cpuFrameTimes = nullptr;
+std::vector<RenderBenchmarkGPUPass_t>	RenderBenchmark::s_gpuPasses;
+uint64_t								RenderBenchmark::s_totalDrawCalls = 0;
+uint64_t								RenderBenchmark::s_minDrawCalls = 0;
+uint64_t								RenderBenchmark::s_maxDrawCalls = 0;
+int64_t									RenderBenchmark::s_startLiveBytes = 0;
+int64_t									RenderBenchmark::s_endLiveBytes = 0;
+int64_t									RenderBenchmark::s_peakLiveBytes = 0;
+uint64_t								RenderBenchmark::s_totalAllocations = 0;
+
+// Console commands
+void Command_RenderBenchmark(Command& cmd);
+void Command_RenderBenchmarkStop(Command& cmd);
+void Command_RenderBenchmarkList(Command& cmd);
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Appends the string as a JSON string body, escaping quotes, backslashes and control characters
+//
+void AppendEscapedBenchmarkString(std::string& text, const char* string)
+{
+	for (const char* character = string; *character != '\0'; ++character)
+	{
+		char currChar = *character;
+
+		if (currChar == '"' || currChar == '\\')
+		{
+			text += '\\';
+			text += currChar;
+		}
+		else if ((unsigned char) currChar < 0x20)
+		{
+			text += ' ';
+		}
+		else
+		{
+			text += currChar;
+		}
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Appends the histogram's percentiles as the members of a JSON object, in milliseconds
+//
+void AppendHistogramMembers(std::string& text, const ProfileHistogram& histogram)
+{
+	text += Stringf("\"frames\": %i, \"averageMs\": %.4f, \"p50Ms\": %.4f, \"p90Ms\": %.4f, \"p95Ms\": %.4f, \"p99Ms\": %.4f, \"maxMs\": %.4f, \"hitches\": %i",
+		histogram.GetSampleCount(), histogram.GetAverage(), histogram.GetPercentile(50.f), histogram.GetPercentile(90.f),
+		histogram.GetPercentile(95.f), histogram.GetPercentile(99.f), histogram.GetMax(), histogram.GetHitchCount());
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Returns the point on the Catmull-Rom spline through the points, t in [0, 1] over the whole path
+//
+Vector3 EvaluatePathAtNormalizedTime(const std::vector<Vector3>& points, float normalizedTime)
+{
+	int pointCount = (int) points.size();
+	if (pointCount == 1)
+	{
+		return points[0];
+	}
+
+	float cumulativeT = ClampFloat(normalizedTime, 0.f, 1.f) * (float) (pointCount - 1);
+	int curveIndex = ClampInt((int) cumulativeT, 0, pointCount - 2);
+	float curveT = cumulativeT - (float) curveIndex;
+
+	// Velocities in units per curve, one sided at the ends
+	const Vector3& start = points[curveIndex];
+	const Vector3& end = points[curveIndex + 1];
+
+	Vector3 startVelocity = (curveIndex > 0 ? (end - points[curveIndex - 1]) * 0.5f : (end - start));
+	Vector3 endVelocity = (curveIndex + 2 < pointCount ? (points[curveIndex + 2] - start) * 0.5f : (end - start));
+
+	return EvaluateCubicHermite(start, startVelocity, end, endVelocity, curveT);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Registers the console commands
+//
+void RenderBenchmark::InitializeConsoleCommands()
+{
+	Command::Register("render_benchmark",		"Flies the camera through a registered scene with vsync off, writing a JSON report. Params: s=scene, d=seconds, f=report file, t=trace file",	Command_RenderBenchmark);
+	Command::Register("render_benchmark_stop",	"Ends the running render benchmark early, writing what was measured",																	Command_RenderBenchmarkStop);
+	Command::Register("render_benchmark_list",	"Lists the scenes the render benchmark can fly through",																				Command_RenderBenchmarkList);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Ends any run without a report and frees the measurements, before the Renderer goes
+//
+void RenderBenchmark::Shutdown()
+{
+	if (s_isRunning)
+	{
+		LogTaggedPrintf("RENDER", "Warning: RenderBenchmark shut down during a run, no report was written");
+
+		if (Profiler::GetInstance() != nullptr && s_isMeasuring && s_tracePath.size() > 0)
+		{
+			Profiler::EndTraceCapture();
+		}
+
+		s_isRunning = false;
+		s_isMeasuring = false;
+		s_camera = nullptr;
+	}
+
+	ClearMeasurements();
+	s_scenes.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the scene, replacing any with the same name
+//
+void RenderBenchmark::RegisterScene(const RenderBenchmarkScene_t& scene)
+{
+	ASSERT_OR_DIE(scene.loadFunction != nullptr, Stringf("Error: RenderBenchmark scene \"%s\" registered without a load function", scene.name.c_str()));
+	ASSERT_OR_DIE(scene.pathPositions.size() > 0, Stringf("Error: RenderBenchmark scene \"%s\" registered without a camera path", scene.name.c_str()));
+	ASSERT_OR_DIE(scene.lookTargets.size() == 0 || scene.lookTargets.size() == scene.pathPositions.size(), Stringf("Error: RenderBenchmark scene \"%s\" has %i look targets for %i path positions", scene.name.c_str(), (int) scene.lookTargets.size(), (int) scene.pathPositions.size()));
+	ASSERT_OR_DIE(!s_isRunning, "Error: RenderBenchmark::RegisterScene() called during a run");
+
+	for (int sceneIndex = 0; sceneIndex < (int) s_scenes.size(); ++sceneIndex)
+	{
+		if (s_scenes[sceneIndex].name == scene.name)
+		{
+			s_scenes[sceneIndex] = scene;
+			return;
+		}
+	}
+
+	s_scenes.push_back(scene);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the names of the registered scenes
+//
+void RenderBenchmark::GetSceneNames(std::vector<std::string>& out_names)
+{
+	for (int sceneIndex = 0; sceneIndex < (int) s_scenes.size(); ++sceneIndex)
+	{
+		out_names.push_back(s_scenes[sceneIndex].name);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Loads the scene and starts the run, turning off vsync and the frame rate cap until it ends
+// Returns false if there's already a run, the scene isn't registered or it didn't load
+//
+bool RenderBenchmark::Start(const std::string& sceneName, float durationSeconds, const std::string& reportPath, const std::string& tracePath)
+{
+	Renderer* renderer = Renderer::GetInstance();
+
+	if (s_isRunning || renderer == nullptr || durationSeconds <= 0.f)
+	{
+		return false;
+	}
+
+	const RenderBenchmarkScene_t* scene = FindScene(sceneName);
+	if (scene == nullptr)
+	{
+		return false;
+	}
+
+	Camera* camera = scene->loadFunction(scene->name);
+	if (camera == nullptr)
+	{
+		LogTaggedPrintf("RENDER", "Warning: RenderBenchmark scene \"%s\" didn't load", scene->name.c_str());
+		return false;
+	}
+
+	ClearMeasurements();
+	s_cpuFrameTimes = new ProfileHistogram("CPU Frame", RENDER_BENCHMARK_MAX_FRAMES, RENDER_BENCHMARK_HITCH_MS);
+
+	s_sceneIndex = (int) (scene - s_scenes.data());
+	s_camera = camera;
+	s_durationSeconds = durationSeconds;
+	s_reportPath = reportPath;
+	s_tracePath = tracePath;
+
+	s_previousVSyncMode = (int) renderer->GetVSyncMode();
+	s_previousFrameRateCap = renderer->GetFrameRateCap();
+	renderer->SetVSyncMode(VSYNC_OFF);
+	renderer->SetFrameRateCap(0.f);
+
+	s_isRunning = true;
+	s_isMeasuring = false;
+	s_startHPC = GetPerformanceCounter();
+	s_lastFrameHPC = s_startHPC;
+
+	UpdateCamera(0.f);
+
+	LogTaggedPrintf("RENDER", "RenderBenchmark started on \"%s\" for %.1f seconds", scene->name.c_str(), durationSeconds);
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Ends the run before its duration, still writing the report
+//
+void RenderBenchmark::Stop()
+{
+	if (s_isRunning)
+	{
+		Finish(false);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Measures the frame that just ended, then places the camera for the next one
+// The GPU times are GPU_PROFILER_POOL_COUNT frames behind, which doesn't matter over a whole run
+//
+void RenderBenchmark::BeginFrame()
+{
+	if (!s_isRunning)
+	{
+		return;
+	}
+
+	uint64_t currentHPC = GetPerformanceCounter();
+
+	if (!s_isMeasuring)
+	{
+		float warmupSeconds = (float) TimeSystem::PerformanceCountToSeconds(currentHPC - s_startHPC);
+
+		if (warmupSeconds >= RENDER_BENCHMARK_WARMUP_SECONDS)
+		{
+			StartMeasuring(currentHPC);
+		}
+
+		s_lastFrameHPC = currentHPC;
+		UpdateCamera(0.f);
+		return;
+	}
+
+	RecordFrame(currentHPC);
+
+	float elapsedSeconds = (float) TimeSystem::PerformanceCountToSeconds(currentHPC - s_measureStartHPC);
+	if (elapsedSeconds >= s_durationSeconds)
+	{
+		Finish(true);
+		return;
+	}
+
+	UpdateCamera(elapsedSeconds / s_durationSeconds);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true while a run is flying the camera, warmup included
+//
+bool RenderBenchmark::IsRunning()
+{
+	return s_isRunning;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Ends the warmup, starting the trace and taking the memory baseline
+//
+void RenderBenchmark::StartMeasuring(uint64_t currentHPC)
+{
+	s_isMeasuring = true;
+	s_measureStartHPC = currentHPC;
+
+	if (s_tracePath.size() > 0)
+	{
+		if (Profiler::GetInstance() == nullptr || !Profiler::BeginTraceCapture(s_tracePath))
+		{
+			LogTaggedPrintf("RENDER", "Warning: RenderBenchmark couldn't capture a trace to \"%s\"", s_tracePath.c_str());
+			s_tracePath.clear();
+		}
+	}
+
+	if (MemoryTracker::IsEnabled())
+	{
+		MemoryStats_t memoryStats = MemoryTracker::GetTotalStats();
+
+		s_startLiveBytes = memoryStats.liveBytes;
+		s_peakLiveBytes = memoryStats.liveBytes;
+		s_totalAllocations = memoryStats.totalAllocationCount;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the frame that just ended to the measurements
+//
+void RenderBenchmark::RecordFrame(uint64_t currentHPC)
+{
+	float cpuMilliseconds = (float) (TimeSystem::PerformanceCountToSeconds(currentHPC - s_lastFrameHPC) * 1000.0);
+	s_lastFrameHPC = currentHPC;
+
+	s_cpuFrameTimes->AddSample(cpuMilliseconds);
+	s_frameCount++;
+
+	// Counters are only kept with PROFILING_ENABLED, otherwise these stay zero
+	uint64_t drawCalls = ProfileCounters::GetLastFrameValue(PROFILE_COUNTER_DRAW_CALLS);
+
+	s_totalDrawCalls += drawCalls;
+	s_minDrawCalls = (s_frameCount == 1 ? drawCalls : (drawCalls < s_minDrawCalls ? drawCalls : s_minDrawCalls));
+	s_maxDrawCalls = (drawCalls > s_maxDrawCalls ? drawCalls : s_maxDrawCalls);
+
+	// GPU passes, by name - scope names are usually literals, so the pointers mostly match
+	std::vector<GPUScopeTime_t> scopeTimes;
+	GPUProfiler::GetLastFrameScopeTimes(scopeTimes);
+
+	for (int scopeIndex = 0; scopeIndex < (int) scopeTimes.size(); ++scopeIndex)
+	{
+		const GPUScopeTime_t& scopeTime = scopeTimes[scopeIndex];
+		RenderBenchmarkGPUPass_t* pass = nullptr;
+
+		for (int passIndex = 0; passIndex < (int) s_gpuPasses.size(); ++passIndex)
+		{
+			if (s_gpuPasses[passIndex].name == scopeTime.name || strcmp(s_gpuPasses[passIndex].name, scopeTime.name) == 0)
+			{
+				pass = &s_gpuPasses[passIndex];
+				break;
+			}
+		}
+
+		if (pass == nullptr)
+		{
+			RenderBenchmarkGPUPass_t newPass;
+			newPass.name = scopeTime.name;
+			newPass.histogram = new ProfileHistogram(scopeTime.name, RENDER_BENCHMARK_MAX_FRAMES, RENDER_BENCHMARK_HITCH_MS);
+
+			s_gpuPasses.push_back(newPass);
+			pass = &s_gpuPasses.back();
+		}
+
+		pass->histogram->AddSample(scopeTime.milliseconds);
+	}
+
+	if (MemoryTracker::IsEnabled())
+	{
+		int64_t liveBytes = MemoryTracker::GetTotalStats().liveBytes;
+
+		s_endLiveBytes = liveBytes;
+		s_peakLiveBytes = (liveBytes > s_peakLiveBytes ? liveBytes : s_peakLiveBytes);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Places the camera on the scene's path, normalizedTime in [0, 1] over the run
+//
+void RenderBenchmark::UpdateCamera(float normalizedTime)
+{
+	const RenderBenchmarkScene_t& scene = s_scenes[s_sceneIndex];
+	Vector3 position = EvaluatePathAtNormalizedTime(scene.pathPositions, normalizedTime);
+
+	Vector3 target;
+	if (scene.lookTargets.size() > 0)
+	{
+		target = EvaluatePathAtNormalizedTime(scene.lookTargets, normalizedTime);
+	}
+	else
+	{
+		// Along the path, looking back from the end
+		float lookAheadT = 0.01f;
+		Vector3 ahead = EvaluatePathAtNormalizedTime(scene.pathPositions, normalizedTime + lookAheadT);
+
+		if (normalizedTime + lookAheadT > 1.f)
+		{
+			Vector3 behind = EvaluatePathAtNormalizedTime(scene.pathPositions, normalizedTime - lookAheadT);
+			ahead = position + (position - behind);
+		}
+
+		target = ahead;
+	}
+
+	// Stationary paths keep whatever way the camera faced
+	if ((target - position).GetLengthSquared() > 0.0001f)
+	{
+		s_camera->LookAt(position, target);
+	}
+	else
+	{
+		s_camera->SetPosition(position);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Ends the run, writing the report and putting the Renderer's settings back
+//
+void RenderBenchmark::Finish(bool wasCompleted)
+{
+	if (s_isMeasuring && s_tracePath.size() > 0)
+	{
+		Profiler::EndTraceCapture();
+	}
+
+	if (MemoryTracker::IsEnabled())
+	{
+		s_totalAllocations = MemoryTracker::GetTotalStats().totalAllocationCount - s_totalAllocations;
+	}
+
+	const RenderBenchmarkScene_t& scene = s_scenes[s_sceneIndex];
+
+	if (WriteReport(s_reportPath, wasCompleted))
+	{
+		ConsolePrintf(Rgba::GREEN, "Render benchmark \"%s\": %i frames, CPU %s", scene.name.c_str(), s_frameCount, s_cpuFrameTimes->GetSummaryText().c_str());
+		ConsolePrintf(Rgba::GREEN, "Wrote the report to \"%s\".", s_reportPath.c_str());
+	}
+	else
+	{
+		ConsoleErrorf("Couldn't open \"%s\" for the render benchmark report.", s_reportPath.c_str());
+	}
+
+	Renderer* renderer = Renderer::GetInstance();
+	renderer->SetVSyncMode((eVSyncMode) s_previousVSyncMode);
+	renderer->SetFrameRateCap(s_previousFrameRateCap);
+
+	s_isRunning = false;
+	s_isMeasuring = false;
+	s_camera = nullptr;
+
+	if (scene.unloadFunction != nullptr)
+	{
+		scene.unloadFunction(scene.name);
+	}
+
+	LogTaggedPrintf("RENDER", "RenderBenchmark finished \"%s\" after %i frames%s", scene.name.c_str(), s_frameCount, (wasCompleted ? "" : ", stopped early"));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the run's measurements as JSON, returning false if the file couldn't be opened
+//
+bool RenderBenchmark::WriteReport(const std::string& filePath, bool wasCompleted)
+{
+	File file;
+	if (!file.Open(filePath.c_str(), "w"))
+	{
+		return false;
+	}
+
+#ifdef _DEBUG
+	const char* configuration = "Debug";
+#else
+	const char* configuration = "Release";
+#endif
+
+	const RenderBenchmarkScene_t& scene = s_scenes[s_sceneIndex];
+	float measuredSeconds = (float) TimeSystem::PerformanceCountToSeconds(s_lastFrameHPC - s_measureStartHPC);
+
+	std::string text = "{\n\t\"scene\": \"";
+	AppendEscapedBenchmarkString(text, scene.name.c_str());
+	text += "\",\n";
+
+	text += Stringf("\t\"build\": \"%s\",\n\t\"compiled\": \"%s %s\",\n", configuration, __DATE__, __TIME__);
+	text += Stringf("\t\"completed\": %s,\n\t\"durationSeconds\": %.3f,\n\t\"measuredSeconds\": %.3f,\n\t\"warmupSeconds\": %.3f,\n",
+		(wasCompleted ? "true" : "false"), s_durationSeconds, measuredSeconds, RENDER_BENCHMARK_WARMUP_SECONDS);
+
+	IntVector2 resolution = Window::GetInstance()->GetDimensions();
+	text += Stringf("\t\"resolution\": [%i, %i],\n", resolution.x, resolution.y);
+
+	// CPU
+	text += "\t\"cpuFrameTime\": { ";
+	AppendHistogramMembers(text, *s_cpuFrameTimes);
+	text += " },\n";
+
+	// GPU
+	text += Stringf("\t\"gpuDroppedFrames\": %i,\n", GPUProfiler::GetDroppedFrameCount());
+	text += "\t\"gpuPasses\": [";
+
+	for (int passIndex = 0; passIndex < (int) s_gpuPasses.size(); ++passIndex)
+	{
+		text += (passIndex > 0 ? ",\n\t\t{ \"name\": \"" : "\n\t\t{ \"name\": \"");
+		AppendEscapedBenchmarkString(text, s_gpuPasses[passIndex].name);
+		text += "\", ";
+		AppendHistogramMembers(text, *s_gpuPasses[passIndex].histogram);
+		text += " }";
+	}
+
+	text += (s_gpuPasses.size() > 0 ? "\n\t],\n" : "],\n");
+
+	// Draw calls
+	double averageDrawCalls = (s_frameCount > 0 ? (double) s_totalDrawCalls / (double) s_frameCount : 0.0);
+	text += Stringf("\t\"drawCalls\": { \"average\": %.2f, \"min\": %llu, \"max\": %llu },\n", averageDrawCalls, s_minDrawCalls, s_maxDrawCalls);
+
+	// Memory
+	if (MemoryTracker::IsEnabled())
+	{
+		text += Stringf("\t\"memory\": { \"startLiveBytes\": %lld, \"endLiveBytes\": %lld, \"peakLiveBytes\": %lld, \"allocations\": %llu },\n",
+			s_startLiveBytes, s_endLiveBytes, s_peakLiveBytes, s_totalAllocations);
+	}
+	else
+	{
+		text += "\t\"memory\": null,\n";
+	}
+
+	// Trace
+	if (s_tracePath.size() > 0)
+	{
+		text += "\t\"trace\": \"";
+		AppendEscapedBenchmarkString(text, s_tracePath.c_str());
+		text += "\"\n}\n";
+	}
+	else
+	{
+		text += "\t\"trace\": null\n}\n";
+	}
+
+	file.Write(text.c_str(), text.size());
+	file.Close();
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Frees the last run's measurements
+//
+void RenderBenchmark::ClearMeasurements()
+{
+	if (s_cpuFrameTimes != nullptr)
+	{
+		delete s_cpuFrameTimes;
+		s_cpuFrameTimes = nullptr;
+	}
+
+	for (int passIndex = 0; passIndex < (int) s_gpuPasses.size(); ++passIndex)
+	{
+		delete s_gpuPasses[passIndex].histogram;
+	}
+
+	s_gpuPasses.clear();
+
+	s_frameCount = 0;
+	s_totalDrawCalls = 0;
+	s_minDrawCalls = 0;
+	s_maxDrawCalls = 0;
+	s_startLiveBytes = 0;
+	s_endLiveBytes = 0;
+	s_peakLiveBytes = 0;
+	s_totalAllocations = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the scene with the name, nullptr if there isn't one
+//
+const RenderBenchmarkScene_t* RenderBenchmark::FindScene(const std::string& sceneName)
+{
+	for (int sceneIndex = 0; sceneIndex < (int) s_scenes.size(); ++sceneIndex)
+	{
+		if (s_scenes[sceneIndex].name == sceneName)
+		{
+			return &s_scenes[sceneIndex];
+		}
+	}
+
+	return nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts a render benchmark run
+//
+void Command_RenderBenchmark(Command& cmd)
+{
+	std::string sceneName;
+	float durationSeconds = RENDER_BENCHMARK_DEFAULT_SECONDS;
+	std::string reportPath;
+	std::string tracePath;
+
+	cmd.GetParam("s", sceneName);
+	cmd.GetParam("d", durationSeconds, &durationSeconds);
+	cmd.GetParam("f", reportPath);
+	cmd.GetParam("t", tracePath);
+
+	if (RenderBenchmark::IsRunning())
+	{
+		ConsoleErrorf("A render benchmark is already running, stop it with render_benchmark_stop");
+		return;
+	}
+
+	if (durationSeconds <= 0.f)
+	{
+		ConsoleErrorf("Need a duration greater than zero, got %.2f", durationSeconds);
+		return;
+	}
+
+	if (reportPath.size() == 0)
+	{
+		reportPath = Stringf("Data/Logs/RenderBenchmark_%s.json", sceneName.c_str());
+	}
+
+	if (!RenderBenchmark::Start(sceneName, durationSeconds, reportPath, tracePath))
+	{
+		ConsoleErrorf("Couldn't start a render benchmark of \"%s\", see render_benchmark_list", sceneName.c_str());
+		return;
+	}
+
+	ConsolePrintf(Rgba::GREEN, "Flying through \"%s\" for %.1f seconds, after %.1f seconds of warmup.", sceneName.c_str(), durationSeconds, RENDER_BENCHMARK_WARMUP_SECONDS);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Ends the running render benchmark early
+//
+void Command_RenderBenchmarkStop(Command& cmd)
+{
+	UNUSED(cmd);
+
+	if (!RenderBenchmark::IsRunning())
+	{
+		ConsoleErrorf("No render benchmark is running");
+		return;
+	}
+
+	RenderBenchmark::Stop();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Lists the registered scenes
+//
+void Command_RenderBenchmarkList(Command& cmd)
+{
+	UNUSED(cmd);
+
+	std::vector<std::string> sceneNames;
+	RenderBenchmark::GetSceneNames(sceneNames);
+
+	if (sceneNames.size() == 0)
+	{
+		ConsolePrintf(Rgba::GREEN, "No render benchmark scenes are registered.");
+		return;
+	}
+
+	for (int sceneIndex = 0; sceneIndex < (int) sceneNames.size(); ++sceneIndex)
+	{
+		ConsolePrintf(Rgba::GREEN, "%s", sceneNames[sceneIndex].c_str());
+	}
+}
@@ -0,0 +1,118 @@
+/************************************************************************/
+/* File: RenderBenchmark.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Scripted camera flythroughs of a game's scenes with vsync
+/*				off, reporting CPU/GPU frame times, draw calls and memory
+/*				to a JSON file
+/************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "Engine/Math/Vector3.hpp"
+
+class Camera;
+class ProfileHistogram;
+
+#define RENDER_BENCHMARK_DEFAULT_SECONDS (30.f)
+#define RENDER_BENCHMARK_WARMUP_SECONDS (1.f)			// Held at the path's start, unmeasured, so loading hitches aren't counted
+#define RENDER_BENCHMARK_MAX_FRAMES (1 << 18)			// Percentile window; longer runs keep only the latest frames
+#define RENDER_BENCHMARK_HITCH_MS (33.3f)
+
+// Loads the scene and returns the camera to fly, nullptr if it couldn't; the game keeps updating and
+// rendering the scene as usual, but shouldn't move the camera while RenderBenchmark::IsRunning()
+typedef Camera*(*RenderBenchmarkLoadFunction)(const std::string& sceneName);
+typedef void(*RenderBenchmarkUnloadFunction)(const std::string& sceneName);
+
+struct RenderBenchmarkScene_t
+{
+	std::string						name;
+	RenderBenchmarkLoadFunction		loadFunction = nullptr;
+	RenderBenchmarkUnloadFunction	unloadFunction = nullptr;		// Optional
+
+	// The camera passes through the positions in order, at a constant rate of points over the run
+	// With look targets (one per position) it looks at the interpolated target, otherwise along the path
+	std::vector<Vector3>			pathPositions;
+	std::vector<Vector3>			lookTargets;
+};
+
+// One GPU scope's times over the run
+struct RenderBenchmarkGPUPass_t
+{
+	const char*			name = nullptr;
+	ProfileHistogram*	histogram = nullptr;
+};
+
+
+class RenderBenchmark
+{
+public:
+	//-----Public Methods-----
+
+	static void		InitializeConsoleCommands();
+	static void		Shutdown();
+
+	// Replaces any scene with the same name
+	static void		RegisterScene(const RenderBenchmarkScene_t& scene);
+	static void		GetSceneNames(std::vector<std::string>& out_names);
+
+	// Starts flying the scene; the report is written when the run ends, with a trace of the
+	// measured frames alongside if the trace path isn't empty
+	static bool		Start(const std::string& sceneName, float durationSeconds, const std::string& reportPath, const std::string& tracePath);
+	static void		Stop();		// Ends the run early, writing what was measured
+
+	// Called by the Renderer at the start of each frame - measures the last one and moves the camera
+	static void		BeginFrame();
+
+	static bool		IsRunning();
+
+
+private:
+	//-----Private Methods-----
+
+	RenderBenchmark() = delete;
+
+	static void		StartMeasuring(uint64_t currentHPC);
+	static void		RecordFrame(uint64_t currentHPC);
+	static void		UpdateCamera(float normalizedTime);
+	static void		Finish(bool wasCompleted);
+	static bool		WriteReport(const std::string& filePath, bool wasCompleted);
+	static void		ClearMeasurements();
+
+	static const RenderBenchmarkScene_t* FindScene(const std::string& sceneName);
+
+
+private:
+	//-----Private Data-----
+
+	static std::vector<RenderBenchmarkScene_t>	s_scenes;
+
+	// The current run
+	static bool									s_isRunning;
+	static bool									s_isMeasuring;				// Past the warmup
+	static int									s_sceneIndex;
+	static Camera*								s_camera;
+	static float								s_durationSeconds;
+	static std::string							s_reportPath;
+	static std::string							s_tracePath;
+	static int									s_previousVSyncMode;		// eVSyncMode
+	static float								s_previousFrameRateCap;
+
+	static uint64_t								s_startHPC;
+	static uint64_t								s_measureStartHPC;
+	static uint64_t								s_lastFrameHPC;
+
+	// Measurements
+	static int									s_frameCount;
+	static ProfileHistogram*					s_cpuFrameTimes;
+	static std::vector<RenderBenchmarkGPUPass_t> s_gpuPasses;
+	static uint64_t								s_totalDrawCalls;
+	static uint64_t								s_minDrawCalls;
+	static uint64_t								s_maxDrawCalls;
+	static int64_t								s_startLiveBytes;
+	static int64_t								s_endLiveBytes;
+	static int64_t								s_peakLiveBytes;
+	static uint64_t								s_totalAllocations;
+
+};
@@ -0,0 +1,346 @@
+/************************************************************************/
+/* File: RenderCommandList.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the RenderCommandList class
+/************************************************************************/
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time/Profiler.hpp"
+#include "Engine/Rendering/Core/Camera.hpp"
+#include "Engine/Rendering/Core/Renderer.hpp"
+#include "Engine/Rendering/Core/GPUProfiler.hpp"
+#include "Engine/Rendering/Resources/Skybox.hpp"
+#include "Engine/Rendering/Shaders/ComputeShader.hpp"
+#include "Engine/Rendering/Core/RenderCommandList.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes all recorded commands, keeping the memory for the next recording
+//
+void RenderCommandList::Reset()
+{
+	m_commands.clear();
+	m_drawCalls.clear();
+	m_cameraStates.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records setting the camera as the Renderer's current camera, using its matrices as they are at submit
+//
+void RenderCommandList::SetCamera(Camera* camera)
+{
+	RenderCommand_t command;
+	command.type = RENDER_COMMAND_SET_CAMERA;
+	command.camera = camera;
+
+	m_commands.push_back(command);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records setting the camera as the Renderer's current camera, first setting it to the given matrices
+// Used for cameras that other passes set up differently before this list is submitted
+//
+void RenderCommandList::SetCamera(Camera* camera, const Matrix44& cameraMatrix, const Matrix44& projection)
+{
+	RenderCameraState_t state;
+	state.cameraMatrix = cameraMatrix;
+	state.projection = projection;
+
+	RenderCommand_t command;
+	command.type = RENDER_COMMAND_SET_CAMERA;
+	command.camera = camera;
+	command.cameraStateIndex = (int) m_cameraStates.size();
+
+	m_cameraStates.push_back(state);
+	m_commands.push_back(command);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records clearing the current camera's depth target to the given value
+//
+void RenderCommandList::ClearDepth(float depth)
+{
+	RenderCommand_t command;
+	command.type = RENDER_COMMAND_CLEAR_DEPTH;
+	command.clearDepth = depth;
+
+	m_commands.push_back(command);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records rendering the skybox with the current camera
+//
+void RenderCommandList::DrawSkybox(Skybox* skybox)
+{
+	RenderCommand_t command;
+	command.type = RENDER_COMMAND_DRAW_SKYBOX;
+	command.skybox = skybox;
+
+	m_commands.push_back(command);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records binding the light clusters for the following draws
+// The grid is uploaded at submit, so it must not be rebuilt until then
+//
+void RenderCommandList::BindLightClusters(LightClusterGrid* lightClusters)
+{
+	RenderCommand_t command;
+	command.type = RENDER_COMMAND_BIND_LIGHT_CLUSTERS;
+	command.lightClusters = lightClusters;
+
+	m_commands.push_back(command);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records binding the light probes for the following draws, nullptr for none
+// The probes are uploaded at submit, so they must not be re-baked until then
+//
+void RenderCommandList::BindLightProbes(LightProbeVolume* lightProbes, const Vector3& renderOrigin)
+{
+	RenderCommand_t command;
+	command.type = RENDER_COMMAND_BIND_LIGHT_PROBES;
+	command.lightProbes = lightProbes;
+	command.renderOrigin = renderOrigin;
+
+	m_commands.push_back(command);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records drawing the draw call, which is copied into the list
+// The matrices it points to aren't copied, and must stay valid until the list is submitted
+// Draw calls that can be batched with the one recorded just before are added to its command
+//
+void RenderCommandList::Draw(const DrawCall& drawCall)
+{
+	if (m_commands.size() > 0 && m_commands.back().type == RENDER_COMMAND_DRAW)
+	{
+		RenderCommand_t& lastCommand = m_commands.back();
+
+		if (m_drawCalls[lastCommand.drawCallIndex].CanBatchWith(drawCall))
+		{
+			lastCommand.drawCallCount++;
+			m_drawCalls.push_back(drawCall);
+			return;
+		}
+	}
+
+	RenderCommand_t command;
+	command.type = RENDER_COMMAND_DRAW;
+	command.drawCallIndex = (int) m_drawCalls.size();
+	command.drawCallCount = 1;
+
+	m_drawCalls.push_back(drawCall);
+	m_commands.push_back(command);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records drawing only the draw call's depth, for depth pre-passes
+//
+void RenderCommandList::DrawDepthOnly(const DrawCall& drawCall)
+{
+	RenderCommand_t command;
+	command.type = RENDER_COMMAND_DRAW_DEPTH_ONLY;
+	command.drawCallIndex = (int) m_drawCalls.size();
+
+	m_drawCalls.push_back(drawCall);
+	m_commands.push_back(command);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records drawing the draw call's surface into the current camera's G-buffer targets
+//
+void RenderCommandList::DrawGBuffer(const DrawCall& drawCall)
+{
+	RenderCommand_t command;
+	command.type = RENDER_COMMAND_DRAW_GBUFFER;
+	command.drawCallIndex = (int) m_drawCalls.size();
+
+	m_drawCalls.push_back(drawCall);
+	m_commands.push_back(command);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records lighting the G-buffer into the current camera's color target, with the bound light clusters
+//
+void RenderCommandList::DrawDeferredLighting(const GBufferTargets_t* gBuffer, const Rgba& ambience)
+{
+	RenderCommand_t command;
+	command.type = RENDER_COMMAND_DRAW_DEFERRED_LIGHTING;
+	command.gBuffer = gBuffer;
+	command.ambience = ambience;
+
+	m_commands.push_back(command);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records running the compute shader with the table's bindings, without a barrier after
+//
+void RenderCommandList::DispatchCompute(ComputeShader* shader, const ComputeBindingTable* bindings, int numGroupsX, int numGroupsY, int numGroupsZ)
+{
+	RenderCommand_t command;
+	command.type = RENDER_COMMAND_DISPATCH_COMPUTE;
+	command.computeShader = shader;
+	command.computeBindings = bindings;
+	command.groupCounts[0] = numGroupsX;
+	command.groupCounts[1] = numGroupsY;
+	command.groupCounts[2] = numGroupsZ;
+
+	m_commands.push_back(command);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records running the compute shader with group counts the GPU reads from the argument buffer
+//
+void RenderCommandList::DispatchComputeIndirect(ComputeShader* shader, const ComputeBindingTable* bindings, const RenderBuffer* argumentBuffer, size_t byteOffset /*= 0*/)
+{
+	RenderCommand_t command;
+	command.type = RENDER_COMMAND_DISPATCH_COMPUTE_INDIRECT;
+	command.computeShader = shader;
+	command.computeBindings = bindings;
+	command.argumentBuffer = argumentBuffer;
+	command.argumentOffset = byteOffset;
+
+	m_commands.push_back(command);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records a memory barrier, so the commands after see what earlier dispatches wrote
+//
+void RenderCommandList::InsertBarrier(unsigned int barrierBits)
+{
+	RenderCommand_t command;
+	command.type = RENDER_COMMAND_BARRIER;
+	command.barrierBits = barrierBits;
+
+	m_commands.push_back(command);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records starting a profiler measurement, so the submit time of the commands up to the matching
+// EndProfile() shows in the profiler, and their GPU time on its GPU timeline
+//
+void RenderCommandList::BeginProfile(const char* profileName)
+{
+	RenderCommand_t command;
+	command.type = RENDER_COMMAND_BEGIN_PROFILE;
+	command.profileName = profileName;
+
+	m_commands.push_back(command);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Records ending the last started profiler measurement
+//
+void RenderCommandList::EndProfile()
+{
+	RenderCommand_t command;
+	command.type = RENDER_COMMAND_END_PROFILE;
+
+	m_commands.push_back(command);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Executes all recorded commands on the Renderer, in order
+// The list is left as is, so it can be submitted again until it's reset
+//
+void RenderCommandList::Submit() const
+{
+	Renderer* renderer = Renderer::GetInstance();
+
+	int numCommands = (int) m_commands.size();
+	for (int commandIndex = 0; commandIndex < numCommands; ++commandIndex)
+	{
+		const RenderCommand_t& command = m_commands[commandIndex];
+
+		switch (command.type)
+		{
+		case RENDER_COMMAND_SET_CAMERA:
+			if (command.cameraStateIndex >= 0)
+			{
+				const RenderCameraState_t& state = m_cameraStates[command.cameraStateIndex];
+				command.camera->SetCameraMatrix(state.cameraMatrix);
+				command.camera->SetProjection(state.projection);
+			}
+
+			renderer->SetCurrentCamera(command.camera);
+			break;
+		case RENDER_COMMAND_CLEAR_DEPTH:
+			renderer->ClearDepth(command.clearDepth);
+			break;
+		case RENDER_COMMAND_DRAW_SKYBOX:
+			command.skybox->Render();
+			break;
+		case RENDER_COMMAND_BIND_LIGHT_CLUSTERS:
+			renderer->BindLightClusters(command.lightClusters);
+			break;
+		case RENDER_COMMAND_BIND_LIGHT_PROBES:
+			renderer->BindLightProbeVolume(command.lightProbes, command.renderOrigin);
+			break;
+		case RENDER_COMMAND_DRAW:
+			if (command.drawCallCount > 1)
+			{
+				renderer->DrawBatch(&m_drawCalls[command.drawCallIndex], command.drawCallCount);
+			}
+			else
+			{
+				renderer->Draw(m_drawCalls[command.drawCallIndex]);
+			}
+			break;
+		case RENDER_COMMAND_DRAW_DEPTH_ONLY:
+			renderer->DrawDepthOnly(m_drawCalls[command.drawCallIndex]);
+			break;
+		case RENDER_COMMAND_DRAW_GBUFFER:
+			renderer->DrawGBuffer(m_drawCalls[command.drawCallIndex]);
+			break;
+		case RENDER_COMMAND_DRAW_DEFERRED_LIGHTING:
+			renderer->DrawDeferredLighting(*command.gBuffer, command.ambience);
+			break;
+		case RENDER_COMMAND_DISPATCH_COMPUTE:
+			command.computeShader->Dispatch(*command.computeBindings, command.groupCounts[0], command.groupCounts[1], command.groupCounts[2]);
+			break;
+		case RENDER_COMMAND_DISPATCH_COMPUTE_INDIRECT:
+			command.computeShader->DispatchIndirect(*command.computeBindings, command.argumentBuffer, command.argumentOffset);
+			break;
+		case RENDER_COMMAND_BARRIER:
+			ComputeShader::InsertBarrier(command.barrierBits);
+			break;
+		case RENDER_COMMAND_BEGIN_PROFILE:
+			Profiler::PushMeasurement(command.profileName);
+			GPUProfiler::PushScope(command.profileName);
+			break;
+		case RENDER_COMMAND_END_PROFILE:
+			GPUProfiler::PopScope();
+			Profiler::PopMeasurement();
+			break;
+		default:
+			ERROR_AND_DIE(Stringf("Error: RenderCommandList::Submit() encountered unknown command type %i", (int) command.type));
+			break;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of recorded commands
+//
+int RenderCommandList::GetCommandCount() const
+{
+	return (int) m_commands.size();
+}
@@ -0,0 +1,114 @@
+/************************************************************************/
+/* File: RenderCommandList.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Class to record rendering commands off of the render thread,
+/*				later submitted to the Renderer in the order they were recorded
+/************************************************************************/
+#pragma once
+#include <vector>
+#include "Engine/Math/Matrix44.hpp"
+#include "Engine/Rendering/Core/DrawCall.hpp"
+
+class Camera;
+class Skybox;
+class RenderBuffer;
+class ComputeShader;
+class LightClusterGrid;
+class LightProbeVolume;
+class ComputeBindingTable;
+struct GBufferTargets_t;
+
+enum eRenderCommandType
+{
+	RENDER_COMMAND_SET_CAMERA,
+	RENDER_COMMAND_CLEAR_DEPTH,
+	RENDER_COMMAND_DRAW_SKYBOX,
+	RENDER_COMMAND_BIND_LIGHT_CLUSTERS,
+	RENDER_COMMAND_BIND_LIGHT_PROBES,
+	RENDER_COMMAND_DRAW,
+	RENDER_COMMAND_DRAW_DEPTH_ONLY,
+	RENDER_COMMAND_DRAW_GBUFFER,
+	RENDER_COMMAND_DRAW_DEFERRED_LIGHTING,
+	RENDER_COMMAND_DISPATCH_COMPUTE,
+	RENDER_COMMAND_DISPATCH_COMPUTE_INDIRECT,
+	RENDER_COMMAND_BARRIER,
+	RENDER_COMMAND_BEGIN_PROFILE,
+	RENDER_COMMAND_END_PROFILE
+};
+
+// Camera matrices to restore before the camera is used, for cameras set up differently by several passes
+struct RenderCameraState_t
+{
+	Matrix44 cameraMatrix;
+	Matrix44 projection;
+};
+
+// Only the members for the command's type are used
+struct RenderCommand_t
+{
+	eRenderCommandType	type;
+	Camera*				camera = nullptr;
+	Skybox*				skybox = nullptr;
+	LightClusterGrid*	lightClusters = nullptr;
+	LightProbeVolume*	lightProbes = nullptr;
+	Vector3				renderOrigin;				// Light probes only
+	int					cameraStateIndex = -1;		// -1 uses the camera as it is at submit
+	int					drawCallIndex = -1;
+	int					drawCallCount = 0;			// Consecutive batchable draw calls, drawn together
+	float				clearDepth = 1.f;
+	const char*			profileName = nullptr;		// Must outlive the list, usually a literal
+
+	// Deferred lighting - the targets must be left as they are until submit
+	const GBufferTargets_t*	gBuffer = nullptr;
+	Rgba					ambience;
+
+	// Compute - the shader, table and argument buffer must be left as they are until submit
+	ComputeShader*				computeShader = nullptr;
+	const ComputeBindingTable*	computeBindings = nullptr;
+	int							groupCounts[3] = { 0, 0, 0 };
+	const RenderBuffer*			argumentBuffer = nullptr;
+	size_t						argumentOffset = 0;
+	unsigned int				barrierBits = 0;
+};
+
+
+class RenderCommandList
+{
+public:
+	//-----Public Methods-----
+
+	// Recording - only touches the list, so lists can be recorded on any thread
+	void Reset();
+
+	void SetCamera(Camera* camera);
+	void SetCamera(Camera* camera, const Matrix44& cameraMatrix, const Matrix44& projection);
+	void ClearDepth(float depth);
+	void DrawSkybox(Skybox* skybox);
+	void BindLightClusters(LightClusterGrid* lightClusters);
+	void BindLightProbes(LightProbeVolume* lightProbes, const Vector3& renderOrigin);
+	void Draw(const DrawCall& drawCall);
+	void DrawDepthOnly(const DrawCall& drawCall);
+	void DrawGBuffer(const DrawCall& drawCall);
+	void DrawDeferredLighting(const GBufferTargets_t* gBuffer, const Rgba& ambience);
+	void DispatchCompute(ComputeShader* shader, const ComputeBindingTable* bindings, int numGroupsX, int numGroupsY, int numGroupsZ);
+	void DispatchComputeIndirect(ComputeShader* shader, const ComputeBindingTable* bindings, const RenderBuffer* argumentBuffer, size_t byteOffset = 0);
+	void InsertBarrier(unsigned int barrierBits);	// GL_*_BARRIER_BIT bits, for what reads the dispatches' writes
+	void BeginProfile(const char* profileName);
+	void EndProfile();
+
+	// Submitting - render thread only
+	void Submit() const;
+
+	int GetCommandCount() const;
+
+
+private:
+	//-----Private Data-----
+
+	// All reused between frames, so recording only allocates when a list grows
+	std::vector<RenderCommand_t>		m_commands;
+	std::vector<DrawCall>				m_drawCalls;
+	std::vector<RenderCameraState_t>	m_cameraStates;
+
+};
@@ -0,0 +1,571 @@
+/************************************************************************/
+/* File: RenderGraph.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the RenderGraph class
+/************************************************************************/
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time/Profiler.hpp"
+#include "Engine/Rendering/Core/GPUProfiler.hpp"
+#include "Engine/Rendering/Core/RenderGraph.hpp"
+#include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include "Engine/Rendering/Resources/RenderTargetPool.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes all passes and resources, keeping the memory for the next frame
+//
+void RenderGraph::Reset()
+{
+	for (int resourceIndex = 0; resourceIndex < m_resourceCount; ++resourceIndex)
+	{
+		GraphResource_t& resource = m_resources[resourceIndex];
+		ASSERT_OR_DIE(resource.isImported || resource.texture == nullptr, Stringf("Error: RenderGraph::Reset() called with transient \"%s\" still alive", resource.name));
+	}
+
+	m_resourceCount = 0;
+	m_passCount = 0;
+	m_isCompiled = false;
+	m_culledPassCount = 0;
+	m_transientTextureCount = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Declares a texture made for this frame; it's taken from the RenderTargetPool before its first
+// pass and returned after its last, so textures whose passes don't overlap share a target
+//
+RenderGraphResource RenderGraph::CreateTexture(const char* name, const IntVector2& dimensions, TextureFormat format)
+{
+	ASSERT_OR_DIE(!m_isCompiled, "Error: RenderGraph::CreateTexture() called after the graph was compiled");
+
+	if (m_resourceCount == (int) m_resources.size())
+	{
+		m_resources.push_back(GraphResource_t());
+	}
+
+	GraphResource_t& resource = m_resources[m_resourceCount];
+	resource = GraphResource_t();
+	resource.name = name;
+	resource.dimensions = dimensions;
+	resource.format = format;
+
+	return m_resourceCount++;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Declares a texture that lives outside the graph, i.e. a camera's targets or a shadow map
+// Imported resources are outputs of the graph, so passes writing them are never culled
+//
+RenderGraphResource RenderGraph::ImportTexture(const char* name, Texture* texture)
+{
+	ASSERT_OR_DIE(!m_isCompiled, "Error: RenderGraph::ImportTexture() called after the graph was compiled");
+	ASSERT_OR_DIE(texture != nullptr, Stringf("Error: RenderGraph::ImportTexture() given a null texture for \"%s\"", name));
+
+	for (int resourceIndex = 0; resourceIndex < m_resourceCount; ++resourceIndex)
+	{
+		if (m_resources[resourceIndex].isImported && m_resources[resourceIndex].texture == texture)
+		{
+			return resourceIndex;
+		}
+	}
+
+	if (m_resourceCount == (int) m_resources.size())
+	{
+		m_resources.push_back(GraphResource_t());
+	}
+
+	GraphResource_t& resource = m_resources[m_resourceCount];
+	resource = GraphResource_t();
+	resource.name = name;
+	resource.isImported = true;
+	resource.texture = texture;
+
+	return m_resourceCount++;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Declares a buffer that lives outside the graph, importing it again returns the same resource
+//
+RenderGraphResource RenderGraph::ImportBuffer(const char* name, RenderBuffer* buffer)
+{
+	ASSERT_OR_DIE(!m_isCompiled, "Error: RenderGraph::ImportBuffer() called after the graph was compiled");
+	ASSERT_OR_DIE(buffer != nullptr, Stringf("Error: RenderGraph::ImportBuffer() given a null buffer for \"%s\"", name));
+
+	for (int resourceIndex = 0; resourceIndex < m_resourceCount; ++resourceIndex)
+	{
+		if (m_resources[resourceIndex].buffer == buffer)
+		{
+			return resourceIndex;
+		}
+	}
+
+	if (m_resourceCount == (int) m_resources.size())
+	{
+		m_resources.push_back(GraphResource_t());
+	}
+
+	GraphResource_t& resource = m_resources[m_resourceCount];
+	resource = GraphResource_t();
+	resource.name = name;
+	resource.isImported = true;
+	resource.buffer = buffer;
+
+	return m_resourceCount++;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a pass to run after the ones already added, returning its index for declaring its accesses
+//
+int RenderGraph::AddPass(const char* name, eRenderGraphPassType type, const RenderGraphExecuteFunction& execute)
+{
+	ASSERT_OR_DIE(!m_isCompiled, "Error: RenderGraph::AddPass() called after the graph was compiled");
+
+	if (m_passCount == (int) m_passes.size())
+	{
+		m_passes.push_back(GraphPass_t());
+	}
+
+	GraphPass_t& pass = m_passes[m_passCount];
+	pass.name = name;
+	pass.type = type;
+	pass.execute = execute;
+	pass.reads.clear();
+	pass.writes.clear();
+	pass.hasSideEffects = false;
+
+	return m_passCount++;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Declares the pass reading the resource the given way
+//
+void RenderGraph::Read(int passIndex, RenderGraphResource resource, eRenderGraphUsage usage)
+{
+	ASSERT_OR_DIE(passIndex >= 0 && passIndex < m_passCount, Stringf("Error: RenderGraph::Read() given bad pass index %i", passIndex));
+	ASSERT_OR_DIE(resource >= 0 && resource < m_resourceCount, Stringf("Error: RenderGraph::Read() given bad resource %i", resource));
+	ASSERT_OR_DIE(usage >= RENDER_GRAPH_USAGE_SAMPLED, "Error: RenderGraph::Read() given a write usage");
+
+	GraphAccess_t access;
+	access.resource = resource;
+	access.usage = usage;
+
+	m_passes[passIndex].reads.push_back(access);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Declares the pass writing the resource the given way
+//
+void RenderGraph::Write(int passIndex, RenderGraphResource resource, eRenderGraphUsage usage)
+{
+	ASSERT_OR_DIE(passIndex >= 0 && passIndex < m_passCount, Stringf("Error: RenderGraph::Write() given bad pass index %i", passIndex));
+	ASSERT_OR_DIE(resource >= 0 && resource < m_resourceCount, Stringf("Error: RenderGraph::Write() given bad resource %i", resource));
+	ASSERT_OR_DIE(usage < RENDER_GRAPH_USAGE_SAMPLED, "Error: RenderGraph::Write() given a read usage");
+
+	GraphAccess_t access;
+	access.resource = resource;
+	access.usage = usage;
+
+	m_passes[passIndex].writes.push_back(access);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Keeps the pass from being culled, for passes whose results leave the graph some other way
+//
+void RenderGraph::SetPassHasSideEffects(int passIndex)
+{
+	ASSERT_OR_DIE(passIndex >= 0 && passIndex < m_passCount, Stringf("Error: RenderGraph::SetPassHasSideEffects() given bad pass index %i", passIndex));
+	m_passes[passIndex].hasSideEffects = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Culls the passes nothing needs, then works out when each transient lives and what barriers go
+// before each pass
+//
+void RenderGraph::Compile()
+{
+	ASSERT_OR_DIE(!m_isCompiled, "Error: RenderGraph::Compile() called twice on the same graph");
+
+	// Transients have to be written before they're read, since passes run in the order they're added
+	for (int passIndex = 0; passIndex < m_passCount; ++passIndex)
+	{
+		const GraphPass_t& pass = m_passes[passIndex];
+
+		for (int readIndex = 0; readIndex < (int) pass.reads.size(); ++readIndex)
+		{
+			const GraphResource_t& resource = m_resources[pass.reads[readIndex].resource];
+
+			if (resource.isImported)
+			{
+				continue;
+			}
+
+			bool isWrittenBefore = false;
+			for (int writerIndex = 0; writerIndex < passIndex && !isWrittenBefore; ++writerIndex)
+			{
+				const std::vector<GraphAccess_t>& writes = m_passes[writerIndex].writes;
+
+				for (int writeIndex = 0; writeIndex < (int) writes.size(); ++writeIndex)
+				{
+					if (writes[writeIndex].resource == pass.reads[readIndex].resource)
+					{
+						isWrittenBefore = true;
+						break;
+					}
+				}
+			}
+
+			ASSERT_OR_DIE(isWrittenBefore, Stringf("Error: RenderGraph pass \"%s\" reads transient \"%s\" before any pass writes it", pass.name, resource.name));
+		}
+	}
+
+	CullPasses();
+	ComputeLifetimes();
+	ComputeBarriers();
+
+	m_isCompiled = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Runs the passes that weren't culled in order, acquiring and releasing the transients around them
+//
+void RenderGraph::Execute()
+{
+	ASSERT_OR_DIE(m_isCompiled, "Error: RenderGraph::Execute() called before the graph was compiled");
+
+	for (int passIndex = 0; passIndex < m_passCount; ++passIndex)
+	{
+		GraphPass_t& pass = m_passes[passIndex];
+
+		if (pass.isCulled)
+		{
+			continue;
+		}
+
+		for (int acquireIndex = 0; acquireIndex < (int) pass.acquiredTextures.size(); ++acquireIndex)
+		{
+			GraphResource_t& resource = m_resources[pass.acquiredTextures[acquireIndex]];
+			resource.texture = RenderTargetPool::AcquireTransient(resource.dimensions, resource.format);
+		}
+
+		if (pass.barrierBits != 0)
+		{
+			glMemoryBarrier(pass.barrierBits);
+			GL_CHECK_ERROR();
+		}
+
+		Profiler::PushMeasurement(pass.name);
+		GPUProfiler::PushScope(pass.name);
+
+		pass.execute(*this);
+
+		GPUProfiler::PopScope();
+		Profiler::PopMeasurement();
+
+		// Released as soon as they've been read, so the next pass to acquire the same size and format reuses them
+		for (int releaseIndex = 0; releaseIndex < (int) pass.releasedTextures.size(); ++releaseIndex)
+		{
+			GraphResource_t& resource = m_resources[pass.releasedTextures[releaseIndex]];
+			RenderTargetPool::Release(resource.texture);
+			resource.texture = nullptr;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the texture of the resource; transients are only valid during the passes that use them
+//
+Texture* RenderGraph::GetTexture(RenderGraphResource resource) const
+{
+	ASSERT_OR_DIE(resource >= 0 && resource < m_resourceCount, Stringf("Error: RenderGraph::GetTexture() given bad resource %i", resource));
+
+	const GraphResource_t& graphResource = m_resources[resource];
+	ASSERT_OR_DIE(graphResource.texture != nullptr, Stringf("Error: RenderGraph::GetTexture() called on \"%s\" outside of the passes that use it", graphResource.name));
+
+	return graphResource.texture;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the buffer of the resource
+//
+RenderBuffer* RenderGraph::GetBuffer(RenderGraphResource resource) const
+{
+	ASSERT_OR_DIE(resource >= 0 && resource < m_resourceCount, Stringf("Error: RenderGraph::GetBuffer() given bad resource %i", resource));
+
+	const GraphResource_t& graphResource = m_resources[resource];
+	ASSERT_OR_DIE(graphResource.buffer != nullptr, Stringf("Error: RenderGraph::GetBuffer() called on \"%s\", which isn't a buffer", graphResource.name));
+
+	return graphResource.buffer;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of passes added
+//
+int RenderGraph::GetPassCount() const
+{
+	return m_passCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of passes the last compile culled
+//
+int RenderGraph::GetCulledPassCount() const
+{
+	return m_culledPassCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of transient textures used by the passes that weren't culled
+//
+int RenderGraph::GetTransientTextureCount() const
+{
+	return m_transientTextureCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Culls the passes whose writes are never read - each pass is referenced once per resource it
+// writes, and each resource once per read (imported ones once more, for whatever reads them after
+// the graph); unreferenced resources unreference their writers, which unreference what they read
+//
+void RenderGraph::CullPasses()
+{
+	for (int resourceIndex = 0; resourceIndex < m_resourceCount; ++resourceIndex)
+	{
+		m_resources[resourceIndex].readCount = (m_resources[resourceIndex].isImported ? 1 : 0);
+	}
+
+	for (int passIndex = 0; passIndex < m_passCount; ++passIndex)
+	{
+		GraphPass_t& pass = m_passes[passIndex];
+		pass.referenceCount = (int) pass.writes.size() + (pass.hasSideEffects ? 1 : 0);
+		pass.isCulled = false;
+
+		for (int readIndex = 0; readIndex < (int) pass.reads.size(); ++readIndex)
+		{
+			m_resources[pass.reads[readIndex].resource].readCount++;
+		}
+	}
+
+	m_cullStack.clear();
+	for (int resourceIndex = 0; resourceIndex < m_resourceCount; ++resourceIndex)
+	{
+		if (m_resources[resourceIndex].readCount == 0)
+		{
+			m_cullStack.push_back(resourceIndex);
+		}
+	}
+
+	while (m_cullStack.size() > 0)
+	{
+		int resourceIndex = m_cullStack.back();
+		m_cullStack.pop_back();
+
+		for (int passIndex = 0; passIndex < m_passCount; ++passIndex)
+		{
+			GraphPass_t& pass = m_passes[passIndex];
+
+			for (int writeIndex = 0; writeIndex < (int) pass.writes.size(); ++writeIndex)
+			{
+				if (pass.writes[writeIndex].resource != resourceIndex)
+				{
+					continue;
+				}
+
+				pass.referenceCount--;
+
+				if (pass.referenceCount == 0)
+				{
+					pass.isCulled = true;
+
+					for (int readIndex = 0; readIndex < (int) pass.reads.size(); ++readIndex)
+					{
+						GraphResource_t& readResource = m_resources[pass.reads[readIndex].resource];
+						readResource.readCount--;
+
+						if (readResource.readCount == 0)
+						{
+							m_cullStack.push_back(pass.reads[readIndex].resource);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// Passes that access nothing and have no side effects do nothing anyone can see
+	m_culledPassCount = 0;
+	for (int passIndex = 0; passIndex < m_passCount; ++passIndex)
+	{
+		GraphPass_t& pass = m_passes[passIndex];
+
+		if (pass.referenceCount <= 0)
+		{
+			pass.isCulled = true;
+		}
+
+		if (pass.isCulled)
+		{
+			m_culledPassCount++;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds the first and last pass left using each transient, for when it's acquired and released
+//
+void RenderGraph::ComputeLifetimes()
+{
+	for (int resourceIndex = 0; resourceIndex < m_resourceCount; ++resourceIndex)
+	{
+		m_resources[resourceIndex].firstPassIndex = -1;
+		m_resources[resourceIndex].lastPassIndex = -1;
+	}
+
+	for (int passIndex = 0; passIndex < m_passCount; ++passIndex)
+	{
+		GraphPass_t& pass = m_passes[passIndex];
+		pass.acquiredTextures.clear();
+		pass.releasedTextures.clear();
+
+		if (pass.isCulled)
+		{
+			continue;
+		}
+
+		for (int accessIndex = 0; accessIndex < (int) (pass.reads.size() + pass.writes.size()); ++accessIndex)
+		{
+			bool isRead = (accessIndex < (int) pass.reads.size());
+			int resourceIndex = (isRead ? pass.reads[accessIndex].resource : pass.writes[accessIndex - pass.reads.size()].resource);
+			GraphResource_t& resource = m_resources[resourceIndex];
+
+			if (resource.firstPassIndex == -1)
+			{
+				resource.firstPassIndex = passIndex;
+			}
+
+			resource.lastPassIndex = passIndex;
+		}
+	}
+
+	m_transientTextureCount = 0;
+	for (int resourceIndex = 0; resourceIndex < m_resourceCount; ++resourceIndex)
+	{
+		const GraphResource_t& resource = m_resources[resourceIndex];
+
+		if (resource.isImported || resource.firstPassIndex == -1)
+		{
+			continue;
+		}
+
+		m_passes[resource.firstPassIndex].acquiredTextures.push_back(resourceIndex);
+		m_passes[resource.lastPassIndex].releasedTextures.push_back(resourceIndex);
+		m_transientTextureCount++;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds the barrier each pass needs for the image and storage writes of earlier passes; render
+// target writes are coherent in GL, so only those need one
+//
+void RenderGraph::ComputeBarriers()
+{
+	for (int resourceIndex = 0; resourceIndex < m_resourceCount; ++resourceIndex)
+	{
+		m_resources[resourceIndex].hasIncoherentWrite = false;
+		m_resources[resourceIndex].barrierBitsIssued = 0;
+	}
+
+	for (int passIndex = 0; passIndex < m_passCount; ++passIndex)
+	{
+		GraphPass_t& pass = m_passes[passIndex];
+		pass.barrierBits = 0;
+
+		if (pass.isCulled)
+		{
+			continue;
+		}
+
+		// Writes after an incoherent write need the barrier too, so they land after it
+		for (int accessIndex = 0; accessIndex < (int) (pass.reads.size() + pass.writes.size()); ++accessIndex)
+		{
+			bool isRead = (accessIndex < (int) pass.reads.size());
+			const GraphAccess_t& access = (isRead ? pass.reads[accessIndex] : pass.writes[accessIndex - pass.reads.size()]);
+			GraphResource_t& resource = m_resources[access.resource];
+
+			if (!resource.hasIncoherentWrite)
+			{
+				continue;
+			}
+
+			GLbitfield usageBits = GetBarrierBitsForUsage(access.usage, resource.buffer != nullptr);
+			pass.barrierBits |= (usageBits & ~resource.barrierBitsIssued);
+			resource.barrierBitsIssued |= usageBits;
+		}
+
+		for (int writeIndex = 0; writeIndex < (int) pass.writes.size(); ++writeIndex)
+		{
+			GraphResource_t& resource = m_resources[pass.writes[writeIndex].resource];
+
+			if (IsIncoherentWrite(pass.writes[writeIndex].usage))
+			{
+				resource.hasIncoherentWrite = true;
+				resource.barrierBitsIssued = 0;
+			}
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the barrier bits that make incoherent writes visible to the given access
+//
+GLbitfield RenderGraph::GetBarrierBitsForUsage(eRenderGraphUsage usage, bool isBuffer)
+{
+	switch (usage)
+	{
+	case RENDER_GRAPH_USAGE_COLOR_TARGET:
+	case RENDER_GRAPH_USAGE_DEPTH_TARGET:
+		return GL_FRAMEBUFFER_BARRIER_BIT;
+	case RENDER_GRAPH_USAGE_IMAGE_WRITE:
+	case RENDER_GRAPH_USAGE_IMAGE_READ:
+		return GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+	case RENDER_GRAPH_USAGE_STORAGE_WRITE:
+	case RENDER_GRAPH_USAGE_STORAGE_READ:
+		return GL_SHADER_STORAGE_BARRIER_BIT;
+	case RENDER_GRAPH_USAGE_SAMPLED:
+		return GL_TEXTURE_FETCH_BARRIER_BIT;
+	case RENDER_GRAPH_USAGE_UNIFORM_READ:
+		return GL_UNIFORM_BARRIER_BIT;
+	case RENDER_GRAPH_USAGE_INDIRECT_ARGUMENTS:
+		return GL_COMMAND_BARRIER_BIT;
+	case RENDER_GRAPH_USAGE_CPU_READ:
+		return (isBuffer ? GL_BUFFER_UPDATE_BARRIER_BIT : GL_TEXTURE_UPDATE_BARRIER_BIT);
+	default:
+		return GL_ALL_BARRIER_BITS;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if writes of the usage need a barrier before anything reads them
+//
+bool RenderGraph::IsIncoherentWrite(eRenderGraphUsage usage)
+{
+	return (usage == RENDER_GRAPH_USAGE_IMAGE_WRITE || usage == RENDER_GRAPH_USAGE_STORAGE_WRITE);
+}
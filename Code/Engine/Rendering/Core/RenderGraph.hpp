@@ -0,0 +1,155 @@
+/************************************************************************/
+/* File: RenderGraph.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Frame's passes declared with the resources they read and
+/*				write, compiled to cull what nothing reads, give transient
+/*				targets lifetimes from the RenderTargetPool, and place the
+/*				memory barriers compute writes need
+/************************************************************************/
+#pragma once
+#include <vector>
+#include <functional>
+#include "Engine/Math/IntVector2.hpp"
+#include "Engine/Rendering/OpenGL/glTypes.hpp"
+#include "ThirdParty/gl/glcorearb.h"
+
+class Texture;
+class RenderGraph;
+class RenderBuffer;
+
+typedef int RenderGraphResource;
+#define RENDER_GRAPH_INVALID_RESOURCE (-1)
+
+enum eRenderGraphPassType
+{
+	RENDER_GRAPH_PASS_GRAPHICS,
+	RENDER_GRAPH_PASS_COMPUTE
+};
+
+enum eRenderGraphUsage
+{
+	// Writes
+	RENDER_GRAPH_USAGE_COLOR_TARGET,
+	RENDER_GRAPH_USAGE_DEPTH_TARGET,
+	RENDER_GRAPH_USAGE_IMAGE_WRITE,
+	RENDER_GRAPH_USAGE_STORAGE_WRITE,
+
+	// Reads
+	RENDER_GRAPH_USAGE_SAMPLED,
+	RENDER_GRAPH_USAGE_IMAGE_READ,
+	RENDER_GRAPH_USAGE_STORAGE_READ,
+	RENDER_GRAPH_USAGE_UNIFORM_READ,
+	RENDER_GRAPH_USAGE_INDIRECT_ARGUMENTS,
+	RENDER_GRAPH_USAGE_CPU_READ			// Mapped or read back
+};
+
+// Called on the render thread when the pass runs; transient textures are only valid inside it
+typedef std::function<void(const RenderGraph& graph)> RenderGraphExecuteFunction;
+
+// How to use, each frame:
+//	- Reset(), then import the textures and buffers that live outside the graph, and create the transient ones
+//	- AddPass() in the order they should run, declaring each one's Read()s and Write()s
+//	- Compile() and Execute()
+// Passes that write nothing read later, nor anything imported, are culled unless marked as having side effects
+// Passes run in the order they were added; with one GL queue, compute and graphics only need their barriers
+class RenderGraph
+{
+public:
+	//-----Public Methods-----
+
+	void				Reset();
+
+	RenderGraphResource	CreateTexture(const char* name, const IntVector2& dimensions, TextureFormat format);
+	RenderGraphResource	ImportTexture(const char* name, Texture* texture);		// Importing a texture again returns the same resource
+	RenderGraphResource	ImportBuffer(const char* name, RenderBuffer* buffer);
+
+	// Names must outlive the frame, usually literals; they're the profiler scopes of the passes
+	int					AddPass(const char* name, eRenderGraphPassType type, const RenderGraphExecuteFunction& execute);
+	void				Read(int passIndex, RenderGraphResource resource, eRenderGraphUsage usage);
+	void				Write(int passIndex, RenderGraphResource resource, eRenderGraphUsage usage);
+	void				SetPassHasSideEffects(int passIndex);
+
+	void				Compile();
+	void				Execute();
+
+	// For the execute functions
+	Texture*			GetTexture(RenderGraphResource resource) const;
+	RenderBuffer*		GetBuffer(RenderGraphResource resource) const;
+
+	// Of the last compile
+	int					GetPassCount() const;
+	int					GetCulledPassCount() const;
+	int					GetTransientTextureCount() const;
+
+
+private:
+	//-----Private Types-----
+
+	struct GraphResource_t
+	{
+		const char*		name = nullptr;
+		bool			isImported = false;
+		Texture*		texture = nullptr;			// Transient ones only while they're alive
+		RenderBuffer*	buffer = nullptr;
+		IntVector2		dimensions;
+		TextureFormat	format = TEXTURE_FORMAT_RGBA8;
+
+		// Compile state
+		int				readCount = 0;
+		int				firstPassIndex = -1;
+		int				lastPassIndex = -1;
+		GLbitfield		barrierBitsIssued = 0;		// Since the last incoherent write
+		bool			hasIncoherentWrite = false;
+	};
+
+	struct GraphAccess_t
+	{
+		RenderGraphResource	resource = RENDER_GRAPH_INVALID_RESOURCE;
+		eRenderGraphUsage	usage = RENDER_GRAPH_USAGE_SAMPLED;
+	};
+
+	struct GraphPass_t
+	{
+		const char*					name = nullptr;
+		eRenderGraphPassType		type = RENDER_GRAPH_PASS_GRAPHICS;
+		RenderGraphExecuteFunction	execute;
+		std::vector<GraphAccess_t>	reads;
+		std::vector<GraphAccess_t>	writes;
+		bool						hasSideEffects = false;
+
+		// Compile state
+		int							referenceCount = 0;
+		bool						isCulled = false;
+		GLbitfield					barrierBits = 0;		// Issued before the pass runs
+		std::vector<int>			acquiredTextures;		// Transients first used by the pass
+		std::vector<int>			releasedTextures;		// Transients last used by the pass
+	};
+
+
+private:
+	//-----Private Methods-----
+
+	void				CullPasses();
+	void				ComputeLifetimes();
+	void				ComputeBarriers();
+
+	static GLbitfield	GetBarrierBitsForUsage(eRenderGraphUsage usage, bool isBuffer);
+	static bool			IsIncoherentWrite(eRenderGraphUsage usage);
+
+
+private:
+	//-----Private Data-----
+
+	// Both reused between frames, so passes only allocate when the graph grows
+	std::vector<GraphResource_t>	m_resources;
+	int								m_resourceCount = 0;
+	std::vector<GraphPass_t>		m_passes;
+	int								m_passCount = 0;
+
+	bool							m_isCompiled = false;
+	int								m_culledPassCount = 0;
+	int								m_transientTextureCount = 0;
+	std::vector<int>				m_cullStack;
+
+};
@@ -4,9 +4,19 @@
 /* Date: May 2nd, 2018
 /* Description: Implementation of the RenderScene class
 /************************************************************************/
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Frustum.hpp"
 #include "Engine/Rendering/Core/Camera.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/Core/Renderable.hpp"
 #include "Engine/Rendering/Core/RenderScene.hpp"
+#include "Engine/Rendering/Meshes/Mesh.hpp"
+
+static bool IsRecordUpToDate(const RenderableRecord_t& record);
+static void RebuildRecord(RenderableRecord_t& record);
+
+template <typename OverlapTest>
+static void QueryRecords(const std::vector<RenderableRecord_t>& records, const OverlapTest& overlaps, std::vector<Renderable*>& out_renderables);
 
 
 //-----------------------------------------------------------------------------------------------
@@ -19,12 +29,32 @@ RenderScene::RenderScene(const std::string& name)
 
 
 //-----------------------------------------------------------------------------------------------
-// Adds the given renderable to the list of renderables
+// Destructor - doesn't delete anything in the scene, just the index over it
 //
-void RenderScene::AddRenderable(Renderable* renderable)
+RenderScene::~RenderScene()
 {
-	RemoveRenderable(renderable);
-	m_renderables.push_back(renderable);
+	if (m_spatialIndex != nullptr)
+	{
+		delete m_spatialIndex;
+		m_spatialIndex = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the given renderable to the list of renderables, returning its handle
+//
+RenderSceneHandle RenderScene::AddRenderable(Renderable* renderable)
+{
+	m_commandLock.lock();
+
+	uint32_t slotIndex = AllocateSlot();
+	InsertRenderable(slotIndex, renderable);
+	RenderSceneHandle handle = GetHandleForSlot(slotIndex);
+
+	m_commandLock.unlock();
+
+	return handle;
 }
 
 
@@ -53,15 +83,32 @@ void RenderScene::AddCamera(Camera* camera)
 //
 void RenderScene::RemoveRenderable(Renderable* toRemove)
 {
-	int numRenderables = (int) m_renderables.size();
-	for (int index = 0; index < numRenderables; ++index)
+	m_commandLock.lock();
+
+	std::unordered_map<const Renderable*, uint32_t>::iterator itr = m_slotsByRenderable.find(toRemove);
+	if (itr != m_slotsByRenderable.end())
 	{
-		if (m_renderables[index] == toRemove)
-		{
-			m_renderables.erase(m_renderables.begin() + index);
-			return;
-		}
+		RemoveRenderableAtIndex(m_slots[itr->second].denseIndex);
+	}
+
+	m_commandLock.unlock();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes the renderable with the handle, if it's still in the scene
+//
+void RenderScene::RemoveRenderable(RenderSceneHandle handle)
+{
+	m_commandLock.lock();
+
+	int denseIndex = GetDenseIndex(handle);
+	if (denseIndex >= 0)
+	{
+		RemoveRenderableAtIndex(denseIndex);
 	}
+
+	m_commandLock.unlock();
 }
 
 
@@ -105,9 +152,209 @@ void RenderScene::RemoveCamera(Camera* toRemove)
 //
 void RenderScene::RemoveAll()
 {
+	m_commandLock.lock();
+
+	// Slots reserved by queued adds stay reserved, the adds still apply later
+	for (const RenderableRecord_t& record : m_renderableRecords)
+	{
+		RenderableSlot_t& slot = m_slots[record.slotIndex];
+		slot.generation++;
+		slot.denseIndex = -1;
+		slot.isFree = true;
+
+		m_freeSlots.push_back(record.slotIndex);
+	}
+
+	m_slotsByRenderable.clear();
+	m_commandLock.unlock();
+
 	m_cameras.clear();
 	m_lights.clear();
 	m_renderables.clear();
+	m_renderableRecords.clear();
+
+	if (m_spatialIndex != nullptr)
+	{
+		m_spatialIndex->Clear();
+	}
+
+	MarkRenderablesChanged();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reserves a handle for the renderable, to be added at the next ApplyQueuedCommands()
+//
+RenderSceneHandle RenderScene::QueueAddRenderable(Renderable* renderable)
+{
+	m_commandLock.lock();
+
+	uint32_t slotIndex = AllocateSlot();
+	RenderSceneHandle handle = GetHandleForSlot(slotIndex);
+
+	RenderSceneCommand_t command;
+	command.type = RENDER_SCENE_COMMAND_ADD_RENDERABLE;
+	command.handle = handle;
+	command.renderable = renderable;
+	m_queuedCommands.push_back(command);
+
+	m_commandLock.unlock();
+
+	return handle;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues the renderable with the handle to be removed
+//
+void RenderScene::QueueRemoveRenderable(RenderSceneHandle handle)
+{
+	RenderSceneCommand_t command;
+	command.type = RENDER_SCENE_COMMAND_REMOVE_RENDERABLE;
+	command.handle = handle;
+
+	m_commandLock.lock();
+	m_queuedCommands.push_back(command);
+	m_commandLock.unlock();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues the light to be added
+//
+void RenderScene::QueueAddLight(Light* light)
+{
+	RenderSceneCommand_t command;
+	command.type = RENDER_SCENE_COMMAND_ADD_LIGHT;
+	command.light = light;
+
+	m_commandLock.lock();
+	m_queuedCommands.push_back(command);
+	m_commandLock.unlock();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues the light to be removed
+//
+void RenderScene::QueueRemoveLight(Light* toRemove)
+{
+	RenderSceneCommand_t command;
+	command.type = RENDER_SCENE_COMMAND_REMOVE_LIGHT;
+	command.light = toRemove;
+
+	m_commandLock.lock();
+	m_queuedCommands.push_back(command);
+	m_commandLock.unlock();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Applies every queued command in the order they were queued
+// Holds the lock throughout, as queueing adds may grow the slots - threads queueing meanwhile just wait
+//
+void RenderScene::ApplyQueuedCommands()
+{
+	m_commandLock.lock();
+
+	for (const RenderSceneCommand_t& command : m_queuedCommands)
+	{
+		switch (command.type)
+		{
+		case RENDER_SCENE_COMMAND_ADD_RENDERABLE:
+		{
+			// The slot was reserved when queued, unless a queued remove already released it
+			uint32_t slotIndex = (uint32_t) (command.handle & 0xFFFFFFFF);
+
+			if (m_slots[slotIndex].generation == (uint32_t) (command.handle >> 32) && !m_slots[slotIndex].isFree)
+			{
+				InsertRenderable(slotIndex, command.renderable);
+			}
+		}
+			break;
+		case RENDER_SCENE_COMMAND_REMOVE_RENDERABLE:
+		{
+			uint32_t slotIndex = (uint32_t) (command.handle & 0xFFFFFFFF);
+			int denseIndex = GetDenseIndex(command.handle);
+
+			if (denseIndex >= 0)
+			{
+				RemoveRenderableAtIndex(denseIndex);
+			}
+			else if (slotIndex < (uint32_t) m_slots.size() && m_slots[slotIndex].generation == (uint32_t) (command.handle >> 32) && !m_slots[slotIndex].isFree)
+			{
+				// Removed before its add was applied, so the add is skipped
+				m_slots[slotIndex].generation++;
+				m_slots[slotIndex].isFree = true;
+				m_freeSlots.push_back(slotIndex);
+			}
+		}
+			break;
+		case RENDER_SCENE_COMMAND_ADD_LIGHT:
+			AddLight(command.light);
+			break;
+		case RENDER_SCENE_COMMAND_REMOVE_LIGHT:
+			RemoveLight(command.light);
+			break;
+		default:
+			break;
+		}
+	}
+
+	m_queuedCommands.clear();
+	m_commandLock.unlock();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the handle's renderable is in the scene
+//
+bool RenderScene::IsHandleValid(RenderSceneHandle handle) const
+{
+	m_commandLock.lock();
+	bool isValid = (GetDenseIndex(handle) >= 0);
+	m_commandLock.unlock();
+
+	return isValid;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the renderable with the handle, nullptr if it isn't in the scene
+//
+Renderable* RenderScene::GetRenderable(RenderSceneHandle handle) const
+{
+	m_commandLock.lock();
+	int denseIndex = GetDenseIndex(handle);
+	m_commandLock.unlock();
+
+	return (denseIndex >= 0 ? m_renderables[denseIndex] : nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Rebuilds the cached world space data of any renderables that changed since the last update
+// Called once per frame before rendering, so every camera and shadow pass shares the results
+//
+void RenderScene::UpdateRenderableRecords()
+{
+	int numRecords = (int) m_renderableRecords.size();
+
+	for (int recordIndex = 0; recordIndex < numRecords; ++recordIndex)
+	{
+		RenderableRecord_t& record = m_renderableRecords[recordIndex];
+
+		if (!IsRecordUpToDate(record))
+		{
+			RebuildRecord(record);
+			MarkRenderablesChanged();
+
+			if (m_spatialIndex != nullptr)
+			{
+				UpdateSpatialLeaf(record);
+			}
+		}
+	}
 }
 
 
@@ -143,6 +390,16 @@ void RenderScene::SortCameras()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the revision of the scene's renderables, which changes whenever any of them is added,
+// removed or moved; used to skip re-rendering shadow maps when no caster changed
+//
+unsigned int RenderScene::GetRenderablesRevision() const
+{
+	return m_renderablesRevision;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the ambience of the scene
 //
@@ -188,6 +445,15 @@ Skybox* RenderScene::GetSkybox() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the light probes the scene's baked lights are in, nullptr if there are none
+//
+LightProbeVolume* RenderScene::GetLightProbeVolume() const
+{
+	return m_lightProbeVolume;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Sets the skybox of the scene to the one provided
 //
@@ -197,6 +463,16 @@ void RenderScene::SetSkybox(Skybox* skybox)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Sets the light probes the lit shaders sample for the scene's baked lights
+// The volume isn't owned, and must outlive the scene or be unset first
+//
+void RenderScene::SetLightProbeVolume(LightProbeVolume* volume)
+{
+	m_lightProbeVolume = volume;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Sets the ambience of the scene to the value specified
 //
@@ -204,3 +480,416 @@ void RenderScene::SetAmbience(const Rgba& ambience)
 {
 	m_ambience = ambience;
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Creates or destroys the tree over the renderables, filling it from the current records
+//
+void RenderScene::SetSpatialIndexEnabled(bool enabled)
+{
+	if (enabled == IsSpatialIndexEnabled())
+	{
+		return;
+	}
+
+	if (enabled)
+	{
+		m_spatialIndex = new AABBTree();
+
+		for (RenderableRecord_t& record : m_renderableRecords)
+		{
+			UpdateSpatialLeaf(record);
+		}
+	}
+	else
+	{
+		delete m_spatialIndex;
+		m_spatialIndex = nullptr;
+
+		for (RenderableRecord_t& record : m_renderableRecords)
+		{
+			record.spatialLeafID = AABB_TREE_NULL_NODE;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if spatial queries go through the tree
+//
+bool RenderScene::IsSpatialIndexEnabled() const
+{
+	return (m_spatialIndex != nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds the renderables whose bounds overlap the box
+//
+void RenderScene::QueryRenderables(const AABB3& bounds, std::vector<Renderable*>& out_renderables) const
+{
+	if (m_spatialIndex != nullptr)
+	{
+		std::vector<int> leafIDs;
+		m_spatialIndex->QueryAABB(bounds, leafIDs);
+		AppendQueriedRenderables(leafIDs, out_renderables);
+	}
+	else
+	{
+		QueryRecords(m_renderableRecords, [&bounds](const AABB3& recordBounds) { return DoAABB3sOverlap(recordBounds, bounds); }, out_renderables);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds the renderables whose bounds overlap the frustum, conservatively
+//
+void RenderScene::QueryRenderables(const Frustum& frustum, std::vector<Renderable*>& out_renderables) const
+{
+	if (m_spatialIndex != nullptr)
+	{
+		std::vector<int> leafIDs;
+		m_spatialIndex->QueryFrustum(frustum, leafIDs);
+		AppendQueriedRenderables(leafIDs, out_renderables);
+	}
+	else
+	{
+		QueryRecords(m_renderableRecords, [&frustum](const AABB3& recordBounds) { return frustum.DoesAABB3Overlap(recordBounds); }, out_renderables);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds the renderables whose bounds overlap the sphere, i.e. the ones a point light reaches
+//
+void RenderScene::QueryRenderablesInSphere(const Vector3& center, float radius, std::vector<Renderable*>& out_renderables) const
+{
+	if (m_spatialIndex != nullptr)
+	{
+		std::vector<int> leafIDs;
+		m_spatialIndex->QuerySphere(center, radius, leafIDs);
+		AppendQueriedRenderables(leafIDs, out_renderables);
+	}
+	else
+	{
+		QueryRecords(m_renderableRecords, [&center, radius](const AABB3& recordBounds) { return DoesBoxSphereOverlap(recordBounds, center, radius); }, out_renderables);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the renderable whose bounds the ray enters first, or nullptr if it hits none
+//
+Renderable* RenderScene::RaycastRenderables(const Vector3& start, const Vector3& direction, float maxDistance, float* out_distance /*= nullptr*/) const
+{
+	Renderable* closestRenderable = nullptr;
+	float closestDistance = maxDistance;
+
+	if (m_spatialIndex != nullptr)
+	{
+		AABBTreeRaycastHit_t hit;
+
+		if (m_spatialIndex->Raycast(start, direction, maxDistance, hit))
+		{
+			closestRenderable = (Renderable*) m_spatialIndex->GetUserData(hit.leafID);
+			closestDistance = hit.distance;
+		}
+	}
+	else
+	{
+		Vector3 inverseDirection = GetRayInverseDirection(direction);
+
+		for (const RenderableRecord_t& record : m_renderableRecords)
+		{
+			float distance;
+			if (record.hasAnyBounds && RaycastAABB3(start, inverseDirection, closestDistance, record.totalBounds, distance))
+			{
+				closestRenderable = record.renderable;
+				closestDistance = distance;
+			}
+		}
+	}
+
+	if (closestRenderable != nullptr && out_distance != nullptr)
+	{
+		*out_distance = closestDistance;
+	}
+
+	return closestRenderable;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Moves the record's leaf to its new bounds, adding or removing it if the record gained or lost them
+//
+void RenderScene::UpdateSpatialLeaf(RenderableRecord_t& record)
+{
+	bool hasLeaf = (record.spatialLeafID != AABB_TREE_NULL_NODE);
+
+	if (record.hasAnyBounds && hasLeaf)
+	{
+		m_spatialIndex->UpdateLeaf(record.spatialLeafID, record.totalBounds);
+	}
+	else if (record.hasAnyBounds)
+	{
+		record.spatialLeafID = m_spatialIndex->AddLeaf(record.totalBounds, record.renderable);
+	}
+	else if (hasLeaf)
+	{
+		m_spatialIndex->RemoveLeaf(record.spatialLeafID);
+		record.spatialLeafID = AABB_TREE_NULL_NODE;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Appends the renderables held by the tree leaves
+//
+void RenderScene::AppendQueriedRenderables(const std::vector<int>& leafIDs, std::vector<Renderable*>& out_renderables) const
+{
+	for (int leafID : leafIDs)
+	{
+		out_renderables.push_back((Renderable*) m_spatialIndex->GetUserData(leafID));
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a free handle slot, reusing removed ones first
+//
+uint32_t RenderScene::AllocateSlot()
+{
+	if (m_freeSlots.size() > 0)
+	{
+		uint32_t slotIndex = m_freeSlots.back();
+		m_freeSlots.pop_back();
+
+		m_slots[slotIndex].isFree = false;
+		return slotIndex;
+	}
+
+	m_slots.push_back(RenderableSlot_t());
+	return (uint32_t) (m_slots.size() - 1);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the handle of the slot's current generation
+//
+RenderSceneHandle RenderScene::GetHandleForSlot(uint32_t slotIndex) const
+{
+	return (((RenderSceneHandle) m_slots[slotIndex].generation) << 32) | (RenderSceneHandle) slotIndex;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns where the handle's renderable is in the lists, -1 if it isn't in them
+//
+int RenderScene::GetDenseIndex(RenderSceneHandle handle) const
+{
+	uint32_t slotIndex = (uint32_t) (handle & 0xFFFFFFFF);
+	uint32_t generation = (uint32_t) (handle >> 32);
+
+	if (slotIndex >= (uint32_t) m_slots.size() || m_slots[slotIndex].generation != generation)
+	{
+		return -1;
+	}
+
+	return m_slots[slotIndex].denseIndex;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Puts the renderable in the lists under the slot, removing it first if it's already there
+//
+void RenderScene::InsertRenderable(uint32_t slotIndex, Renderable* renderable)
+{
+	std::unordered_map<const Renderable*, uint32_t>::iterator itr = m_slotsByRenderable.find(renderable);
+	if (itr != m_slotsByRenderable.end())
+	{
+		RemoveRenderableAtIndex(m_slots[itr->second].denseIndex);
+	}
+
+	m_slots[slotIndex].denseIndex = (int) m_renderables.size();
+	m_slotsByRenderable[renderable] = slotIndex;
+
+	m_renderables.push_back(renderable);
+
+	RenderableRecord_t record;
+	record.renderable = renderable;
+	record.slotIndex = slotIndex;
+	m_renderableRecords.push_back(record);
+
+	MarkRenderablesChanged();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Swaps the last renderable into the removed one's place, freeing its slot
+// Render order comes from the sorted draw calls, so the lists' order doesn't matter
+//
+void RenderScene::RemoveRenderableAtIndex(int denseIndex)
+{
+	RenderableRecord_t& record = m_renderableRecords[denseIndex];
+
+	if (m_spatialIndex != nullptr && record.spatialLeafID != AABB_TREE_NULL_NODE)
+	{
+		m_spatialIndex->RemoveLeaf(record.spatialLeafID);
+	}
+
+	RenderableSlot_t& slot = m_slots[record.slotIndex];
+	slot.generation++;
+	slot.denseIndex = -1;
+	slot.isFree = true;
+
+	m_freeSlots.push_back(record.slotIndex);
+	m_slotsByRenderable.erase(record.renderable);
+
+	int lastIndex = (int) m_renderables.size() - 1;
+	if (denseIndex != lastIndex)
+	{
+		m_renderables[denseIndex] = m_renderables[lastIndex];
+		m_renderableRecords[denseIndex] = std::move(m_renderableRecords[lastIndex]);
+		m_slots[m_renderableRecords[denseIndex].slotIndex].denseIndex = denseIndex;
+	}
+
+	m_renderables.pop_back();
+	m_renderableRecords.pop_back();
+
+	MarkRenderablesChanged();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Moves the renderables revision forward, skipping 0 so it can be used as a "never seen" value
+//
+void RenderScene::MarkRenderablesChanged()
+{
+	++m_renderablesRevision;
+
+	if (m_renderablesRevision == 0)
+	{
+		m_renderablesRevision = 1;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the record still matches its renderable
+// Meshes can be rebuilt without the renderable knowing, so their bounds are checked too
+//
+static bool IsRecordUpToDate(const RenderableRecord_t& record)
+{
+	Renderable* renderable = record.renderable;
+
+	if (record.revision != renderable->GetRevision())
+	{
+		return false;
+	}
+
+	for (int drawIndex = 0; drawIndex < record.drawCount; ++drawIndex)
+	{
+		Mesh* mesh = renderable->GetMesh(drawIndex);
+		bool hasBounds = (mesh != nullptr && mesh->HasBounds());
+
+		if (hasBounds != (record.hasBounds[drawIndex] != 0))
+		{
+			return false;
+		}
+
+		if (hasBounds)
+		{
+			AABB3 bounds = mesh->GetBounds();
+			const AABB3& cachedBounds = record.localBounds[drawIndex];
+
+			if (!(bounds.mins == cachedBounds.mins) || !(bounds.maxs == cachedBounds.maxs))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Recomputes the world matrices and bounds of every draw of every instance in the record
+// Reuses the record's storage, so it only allocates when the renderable grows
+//
+static void RebuildRecord(RenderableRecord_t& record)
+{
+	Renderable* renderable = record.renderable;
+
+	record.revision = renderable->GetRevision();
+	record.drawCount = renderable->GetDrawCountPerInstance();
+	record.instanceCount = renderable->GetInstanceCount();
+	record.worldOrigin = renderable->GetWorldOrigin();
+
+	Vector3 worldOrigin = record.worldOrigin.ToVector3();
+
+	int numEntries = record.drawCount * record.instanceCount;
+	record.worldMatrices.resize(numEntries);
+	record.worldBounds.resize(numEntries);
+	record.localBounds.resize(record.drawCount);
+	record.hasBounds.resize(record.drawCount);
+
+	for (int drawIndex = 0; drawIndex < record.drawCount; ++drawIndex)
+	{
+		RenderableDraw_t draw = renderable->GetDraw(drawIndex);
+		bool hasBounds = (draw.mesh != nullptr && draw.mesh->HasBounds());
+
+		record.hasBounds[drawIndex] = (hasBounds ? 1 : 0);
+		record.localBounds[drawIndex] = (hasBounds ? draw.mesh->GetBounds() : AABB3());
+
+		for (int instanceIndex = 0; instanceIndex < record.instanceCount; ++instanceIndex)
+		{
+			int entryIndex = drawIndex * record.instanceCount + instanceIndex;
+
+			Matrix44 worldMatrix = renderable->GetInstanceMatrix(instanceIndex) * draw.drawMatrix;
+			record.worldMatrices[entryIndex] = worldMatrix;
+
+			if (hasBounds)
+			{
+				record.worldBounds[entryIndex] = record.localBounds[drawIndex].GetTransformed(worldMatrix);
+				record.worldBounds[entryIndex].mins += worldOrigin;
+				record.worldBounds[entryIndex].maxs += worldOrigin;
+			}
+		}
+	}
+
+	// One box around everything, for the spatial queries
+	record.hasAnyBounds = false;
+
+	for (int drawIndex = 0; drawIndex < record.drawCount; ++drawIndex)
+	{
+		if (record.hasBounds[drawIndex] == 0)
+		{
+			continue;
+		}
+
+		for (int instanceIndex = 0; instanceIndex < record.instanceCount; ++instanceIndex)
+		{
+			const AABB3& bounds = record.worldBounds[drawIndex * record.instanceCount + instanceIndex];
+
+			record.totalBounds = (record.hasAnyBounds ? record.totalBounds.GetUnion(bounds) : bounds);
+			record.hasAnyBounds = true;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Appends the renderable of every record whose total bounds pass the test, for queries without the index
+//
+template <typename OverlapTest>
+static void QueryRecords(const std::vector<RenderableRecord_t>& records, const OverlapTest& overlaps, std::vector<Renderable*>& out_renderables)
+{
+	for (const RenderableRecord_t& record : records)
+	{
+		if (record.hasAnyBounds && overlaps(record.totalBounds))
+		{
+			out_renderables.push_back(record.renderable);
+		}
+	}
+}
@@ -7,13 +7,65 @@
 /************************************************************************/
 #pragma once
 #include <map>
+#include <mutex>
 #include <vector>
+#include <stdint.h>
+#include <unordered_map>
 #include "Engine/Core/Rgba.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/AABBTree.hpp"
+#include "Engine/Math/Matrix44.hpp"
+#include "Engine/Math/DoubleVector3.hpp"
 
 class Renderable;
 class Light;
 class Camera;
 class Skybox;
+class LightProbeVolume;
+class Frustum;
+
+// Stable reference to a renderable in a scene, valid until it's removed - slot index in the low 32 bits,
+// generation in the high 32
+typedef uint64_t RenderSceneHandle;
+#define INVALID_RENDER_SCENE_HANDLE (0)
+
+// World space data for one renderable, cached across frames and cameras and only rebuilt when the
+// renderable (or one of its meshes' bounds) changes
+// Per instance entries are laid out [drawIndex * instanceCount + instanceIndex]
+struct RenderableRecord_t
+{
+	Renderable*				renderable = nullptr;
+	unsigned int			revision = 0;
+	int						drawCount = 0;
+	int						instanceCount = 0;
+
+	std::vector<Matrix44>	worldMatrices;	// instance model * draw matrix, relative to worldOrigin
+	std::vector<AABB3>		worldBounds;	// Absolute, for culling against the cameras' world space frustums
+	DoubleVector3			worldOrigin = DoubleVector3::ZERO;
+	std::vector<AABB3>		localBounds;	// Per draw, to notice meshes being rebuilt
+	std::vector<uint8_t>	hasBounds;		// Per draw, draws without bounds are never culled
+
+	AABB3					totalBounds;	// Union of worldBounds, valid if any draw has bounds
+	bool					hasAnyBounds = false;
+	int						spatialLeafID = AABB_TREE_NULL_NODE;
+	uint32_t				slotIndex = 0;	// The scene's handle slot, moved with the record on swap removes
+};
+
+enum eRenderSceneCommandType
+{
+	RENDER_SCENE_COMMAND_ADD_RENDERABLE,
+	RENDER_SCENE_COMMAND_REMOVE_RENDERABLE,
+	RENDER_SCENE_COMMAND_ADD_LIGHT,
+	RENDER_SCENE_COMMAND_REMOVE_LIGHT
+};
+
+struct RenderSceneCommand_t
+{
+	eRenderSceneCommandType	type;
+	RenderSceneHandle		handle = INVALID_RENDER_SCENE_HANDLE;
+	Renderable*				renderable = nullptr;
+	Light*					light = nullptr;
+};
 
 class RenderScene
 {
@@ -21,23 +73,40 @@ class RenderScene
 public:
 	//-----Public Methods-----
 
-	// To allow direct access to the lists for rendering
+	// To allow direct access to the lists for rendering and baking
 	friend class ForwardRenderingPath;
+	friend class LightProbeVolume;
 
-	// List mutators
-	void AddRenderable(Renderable* renderable);
+	// List mutators, main thread only and not while the scene is rendering
+	// Adding a renderable already in the scene removes it first, so it gets a new handle
+	RenderSceneHandle AddRenderable(Renderable* renderable);
 	void AddLight(Light* light);
 	void AddCamera(Camera* camera);
 
 	void RemoveRenderable(Renderable* toRemove);
+	void RemoveRenderable(RenderSceneHandle handle);
 	void RemoveLight(Light* toRemove);
 	void RemoveCamera(Camera* toRemove);
 	void RemoveAll();
 
+	// Queued mutators, for any thread - they take effect in order at the next ApplyQueuedCommands(),
+	// which the ForwardRenderingPath calls before rendering the scene
+	// A queued add's handle can be queued for removal straight away, even before it's applied
+	RenderSceneHandle QueueAddRenderable(Renderable* renderable);
+	void QueueRemoveRenderable(RenderSceneHandle handle);
+	void QueueAddLight(Light* light);
+	void QueueRemoveLight(Light* toRemove);
+	void ApplyQueuedCommands();		// Main thread
+
+	bool		IsHandleValid(RenderSceneHandle handle) const;		// False once removed, and until a queued add is applied
+	Renderable* GetRenderable(RenderSceneHandle handle) const;
+
 	void SetSkybox(Skybox* skybox);
 	void SetAmbience(const Rgba& ambience);
+	void SetLightProbeVolume(LightProbeVolume* volume);		// Not owned, nullptr for none
 
 	void SortCameras();
+	void UpdateRenderableRecords();
 
 	Rgba GetAmbience() const;
 
@@ -47,13 +116,41 @@ public:
 	int GetCameraCount();
 
 	Skybox* GetSkybox() const;
+	LightProbeVolume* GetLightProbeVolume() const;
+	unsigned int GetRenderablesRevision() const;
+
+	// Spatial queries over the renderables, as of the last UpdateRenderableRecords(); renderables without
+	// bounds are never found. They check every renderable unless the index is enabled, which keeps an
+	// AABBTree of them - worth it for picking, light assignment and gameplay queries over big scenes
+	void		SetSpatialIndexEnabled(bool enabled);
+	bool		IsSpatialIndexEnabled() const;
+
+	void		QueryRenderables(const AABB3& bounds, std::vector<Renderable*>& out_renderables) const;
+	void		QueryRenderables(const Frustum& frustum, std::vector<Renderable*>& out_renderables) const;
+	void		QueryRenderablesInSphere(const Vector3& center, float radius, std::vector<Renderable*>& out_renderables) const;
+	Renderable* RaycastRenderables(const Vector3& start, const Vector3& direction, float maxDistance, float* out_distance = nullptr) const;	// Against bounds only
+
+
+private:
+	//-----Private Methods-----
+
+	void MarkRenderablesChanged();
+
+	// Handles
+	uint32_t			AllocateSlot();		// Call with m_commandLock held
+	RenderSceneHandle	GetHandleForSlot(uint32_t slotIndex) const;
+	int					GetDenseIndex(RenderSceneHandle handle) const;
+	void				InsertRenderable(uint32_t slotIndex, Renderable* renderable);
+	void				RemoveRenderableAtIndex(int denseIndex);
+	void UpdateSpatialLeaf(RenderableRecord_t& record);
+	void AppendQueriedRenderables(const std::vector<int>& leafIDs, std::vector<Renderable*>& out_renderables) const;
 
 
 public:
 	//-----Deleted Methods-----
 
 	RenderScene(const std::string& name);
-	~RenderScene() {}
+	~RenderScene();
 	RenderScene(const RenderScene& copy) = delete;
 
 
@@ -65,8 +162,31 @@ private:
 	std::vector<Light*>			m_lights;
 	std::vector<Camera*>		m_cameras;
 
+	// Parallel to m_renderables
+	std::vector<RenderableRecord_t> m_renderableRecords;
+
+	// Handle slots, by the handle's index; reserved by queued adds before they're in the lists
+	struct RenderableSlot_t
+	{
+		uint32_t	generation = 1;
+		int			denseIndex = -1;	// Into m_renderables, -1 while free or pending
+		bool		isFree = false;
+	};
+
+	std::vector<RenderableSlot_t>			m_slots;
+	std::vector<uint32_t>					m_freeSlots;
+	std::unordered_map<const Renderable*, uint32_t> m_slotsByRenderable;	// For removing by pointer
+
+	// Commands queued from other threads; the lock also guards slot allocation
+	mutable std::mutex						m_commandLock;
+	std::vector<RenderSceneCommand_t>		m_queuedCommands;
+	unsigned int m_renderablesRevision = 1;	// Changes whenever a renderable is added, removed or rebuilt; never 0
+
+	AABBTree* m_spatialIndex = nullptr;		// Leaves hold the Renderable*, nullptr when disabled
+
 	Rgba m_ambience;
 
 	Skybox* m_skybox = nullptr;
+	LightProbeVolume* m_lightProbeVolume = nullptr;		// The baked lights, sampled by the lit shaders
 
 };
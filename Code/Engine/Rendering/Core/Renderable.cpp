@@ -4,10 +4,12 @@
 /* Date: May 2nd, 2018
 /* Description: Implementation of the renderable class
 /************************************************************************/
+#include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/Transform.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Rendering/Core/Renderer.hpp"
 #include "Engine/Rendering/Core/Renderable.hpp"
+#include "Engine/Rendering/Shaders/Shader.hpp"
 #include "Engine/Core/Utility/XmlUtilities.hpp"
 #include "Engine/Rendering/Meshes/MeshGroup.hpp"
 #include "Engine/Rendering/Core/RenderScene.hpp"
@@ -40,6 +42,7 @@ void Renderable::AddDraw(const RenderableDraw_t& draw)
 {
 	m_draws.push_back(draw);
 	BindMeshToMaterial((int) m_draws.size() - 1);
+	MarkDirty();
 }
 
 
@@ -51,6 +54,39 @@ void Renderable::SetInstanceMatrix(unsigned int instanceIndex, const Matrix44& m
 {
 	ASSERT_OR_DIE(instanceIndex < m_instanceModels.size(), Stringf("Error: Renderable::SetInstanceMatrix received index out of range, index was %i", instanceIndex));
 	m_instanceModels[instanceIndex] = model;
+	MarkDirty();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets which skinning matrices the instance draws with
+//
+void Renderable::SetInstanceBoneOffset(unsigned int instanceIndex, uint32_t boneOffset)
+{
+	ASSERT_OR_DIE(instanceIndex < m_instanceModels.size(), Stringf("Error: Renderable::SetInstanceBoneOffset received index out of range, index was %i", instanceIndex));
+
+	if (m_instanceBoneOffsets.size() == 0)
+	{
+		m_instanceBoneOffsets.resize(m_instanceModels.size(), 0);
+	}
+
+	m_instanceBoneOffsets[instanceIndex] = boneOffset;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the custom data the instance draws with
+//
+void Renderable::SetInstanceCustomData(unsigned int instanceIndex, const Vector4& customData)
+{
+	ASSERT_OR_DIE(instanceIndex < m_instanceModels.size(), Stringf("Error: Renderable::SetInstanceCustomData received index out of range, index was %i", instanceIndex));
+
+	if (m_instanceCustomData.size() == 0)
+	{
+		m_instanceCustomData.resize(m_instanceModels.size(), Vector4::ONES);
+	}
+
+	m_instanceCustomData[instanceIndex] = customData;
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -60,6 +96,18 @@ void Renderable::SetInstanceMatrix(unsigned int instanceIndex, const Matrix44& m
 void Renderable::AddInstanceMatrix(const Matrix44& model)
 {
 	m_instanceModels.push_back(model);
+
+	if (m_instanceBoneOffsets.size() > 0)
+	{
+		m_instanceBoneOffsets.push_back(0);
+	}
+
+	if (m_instanceCustomData.size() > 0)
+	{
+		m_instanceCustomData.push_back(Vector4::ONES);
+	}
+
+	MarkDirty();
 }
 
 
@@ -69,6 +117,58 @@ void Renderable::AddInstanceMatrix(const Matrix44& model)
 void Renderable::RemoveInstanceMatrix(unsigned int instanceIndex)
 {
 	m_instanceModels.erase(m_instanceModels.begin() + instanceIndex);
+
+	if (m_instanceBoneOffsets.size() > 0)
+	{
+		m_instanceBoneOffsets.erase(m_instanceBoneOffsets.begin() + instanceIndex);
+	}
+
+	if (m_instanceCustomData.size() > 0)
+	{
+		m_instanceCustomData.erase(m_instanceCustomData.begin() + instanceIndex);
+	}
+
+	MarkDirty();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Replaces all instance matrices with the ones given, for systems rebuilding every instance each frame
+//
+void Renderable::SetInstanceMatrices(const Matrix44* models, unsigned int instanceCount)
+{
+	m_instanceModels.assign(models, models + instanceCount);
+
+	if (m_instanceBoneOffsets.size() > 0)
+	{
+		m_instanceBoneOffsets.resize(instanceCount, 0);
+	}
+
+	if (m_instanceCustomData.size() > 0)
+	{
+		m_instanceCustomData.resize(instanceCount, Vector4::ONES);
+	}
+
+	MarkDirty();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the world position the instance matrices are relative to
+//
+void Renderable::SetWorldOrigin(const DoubleVector3& worldOrigin)
+{
+	m_worldOrigin = worldOrigin;
+	MarkDirty();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets whether the renderable is static scenery, for baking light probes
+//
+void Renderable::SetStatic(bool isStatic)
+{
+	m_isStatic = isStatic;
 }
 
 
@@ -79,6 +179,7 @@ void Renderable::SetMesh(unsigned int index, Mesh* mesh)
 {
 	ASSERT_OR_DIE(index < m_draws.size(), Stringf("Error: Renderable::SetMesh received index out of range, index was %i", index));
 	m_draws[index].mesh = mesh;
+	MarkDirty();
 }
 
 
@@ -89,6 +190,7 @@ void Renderable::SetModelMatrix(unsigned int index, const Matrix44& model)
 {
 	ASSERT_OR_DIE(index < m_draws.size(), Stringf("Error: Renderable::SetModelMatrix received index out of range, index was %i", index));
 	m_draws[index].drawMatrix = model;
+	MarkDirty();
 }
 
 
@@ -99,6 +201,7 @@ void Renderable::SetDraw(unsigned int index, RenderableDraw_t draw)
 {
 	m_draws[index] = draw;
 	BindMeshToMaterial(index);
+	MarkDirty();
 }
 
 
@@ -109,6 +212,7 @@ void Renderable::SetSharedMaterial(unsigned int index, Material* sharedMaterial)
 {
 	ASSERT_OR_DIE(index < m_draws.size(), Stringf("Error: Renderable::SetSharedMaterial received index out of range, index was %i", index));
 	m_draws[index].sharedMaterial = sharedMaterial;
+	MarkDirty();
 }
 
 
@@ -119,6 +223,85 @@ void Renderable::SetMaterialInstance(unsigned int index, MaterialInstance* mater
 {
 	ASSERT_OR_DIE(index < m_draws.size(), Stringf("Error: Renderable::SetMaterialInstance received index out of range, index was %i", index));
 	m_draws[index].materialInstance = materialInstance;
+	MarkDirty();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a lower detail mesh for the draw, used when an instance covers less than maxScreenSize of the
+// screen's height; the LODs are kept sorted so smaller screen sizes come later
+//
+void Renderable::AddLOD(unsigned int drawIndex, Mesh* mesh, float maxScreenSize)
+{
+	ASSERT_OR_DIE(drawIndex < m_draws.size(), Stringf("Error: Renderable::AddLOD received index out of range, index was %i", drawIndex));
+	ASSERT_OR_DIE(mesh != nullptr, "Error: Renderable::AddLOD received a null mesh");
+
+	std::vector<RenderableLOD_t>& lods = m_draws[drawIndex].lods;
+
+	RenderableLOD_t lod;
+	lod.mesh = mesh;
+	lod.maxScreenSize = maxScreenSize;
+
+	int insertIndex = 0;
+	while (insertIndex < (int) lods.size() && lods[insertIndex].maxScreenSize >= maxScreenSize)
+	{
+		insertIndex++;
+	}
+
+	lods.insert(lods.begin() + insertIndex, lod);
+
+	BindMeshToMaterial(drawIndex);
+	MarkDirty();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Replaces the draw's LODs with the ones the group has for the mesh at the index
+// The group keeps owning the meshes
+//
+void Renderable::SetLODsFromMeshGroup(unsigned int drawIndex, const MeshGroup* group, int meshIndex)
+{
+	ClearLODs(drawIndex);
+
+	const std::vector<MeshLOD_t>& groupLODs = group->GetLODs(meshIndex);
+
+	for (int lodIndex = 0; lodIndex < (int) groupLODs.size(); ++lodIndex)
+	{
+		AddLOD(drawIndex, groupLODs[lodIndex].mesh, groupLODs[lodIndex].maxScreenSize);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes the draw's LODs, so it always draws its own mesh
+//
+void Renderable::ClearLODs(unsigned int drawIndex)
+{
+	ASSERT_OR_DIE(drawIndex < m_draws.size(), Stringf("Error: Renderable::ClearLODs received index out of range, index was %i", drawIndex));
+
+	std::vector<RenderableLOD_t>& lods = m_draws[drawIndex].lods;
+	Renderer* renderer = Renderer::GetInstance();
+
+	for (int lodIndex = 0; lodIndex < (int) lods.size(); ++lodIndex)
+	{
+		if (lods[lodIndex].vaoHandle != 0)
+		{
+			renderer->DeleteVAO(lods[lodIndex].vaoHandle);
+		}
+
+		if (lods[lodIndex].depthVAOHandle != 0)
+		{
+			renderer->DeleteVAO(lods[lodIndex].depthVAOHandle);
+		}
+
+		if (lods[lodIndex].gBufferVAOHandle != 0)
+		{
+			renderer->DeleteVAO(lods[lodIndex].gBufferVAOHandle);
+		}
+	}
+
+	lods.clear();
+	MarkDirty();
 }
 
 
@@ -159,6 +342,7 @@ Material* Renderable::GetMaterialInstance(unsigned int drawIndex)
 	if (m_draws[drawIndex].materialInstance == nullptr)
 	{
 		m_draws[drawIndex].materialInstance = new MaterialInstance(m_draws[drawIndex].sharedMaterial);
+		MarkDirty();
 	}
 
 	return m_draws[drawIndex].materialInstance;
@@ -174,6 +358,60 @@ Matrix44 Renderable::GetInstanceMatrix(unsigned int instanceIndex) const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the world position the instance matrices are relative to
+//
+DoubleVector3 Renderable::GetWorldOrigin() const
+{
+	return m_worldOrigin;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the renderable is static scenery
+//
+bool Renderable::IsStatic() const
+{
+	return m_isStatic;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the skinning palette offset of the instance, 0 if none were set
+//
+uint32_t Renderable::GetInstanceBoneOffset(unsigned int instanceIndex) const
+{
+	return (m_instanceBoneOffsets.size() > 0 ? m_instanceBoneOffsets[instanceIndex] : 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the skinning palette offsets of all instances, or nullptr if the renderable doesn't use them
+//
+const uint32_t* Renderable::GetInstanceBoneOffsets() const
+{
+	return (m_instanceBoneOffsets.size() > 0 ? m_instanceBoneOffsets.data() : nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the custom data of the instance, white if none were set
+//
+Vector4 Renderable::GetInstanceCustomData(unsigned int instanceIndex) const
+{
+	return (m_instanceCustomData.size() > 0 ? m_instanceCustomData[instanceIndex] : Vector4::ONES);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the custom data of all instances, or nullptr if the renderable doesn't use any
+//
+const Vector4* Renderable::GetInstanceCustomDatas() const
+{
+	return (m_instanceCustomData.size() > 0 ? m_instanceCustomData.data() : nullptr);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the instance material if one was created, otherwise returns the shared material
 //
@@ -197,12 +435,127 @@ unsigned int Renderable::GetVAOHandleForDraw(unsigned int drawIndex) const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the Vertex Array Object handle for the given draw's mesh bound to the depth-only shader
+//
+unsigned int Renderable::GetDepthVAOHandleForDraw(unsigned int drawIndex) const
+{
+	return m_draws[drawIndex].depthVAOHandle;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the Vertex Array Object handle for the given draw's mesh bound to the G-buffer shader, 0 if not deferrable
+//
+unsigned int Renderable::GetGBufferVAOHandleForDraw(unsigned int drawIndex) const
+{
+	return m_draws[drawIndex].gBufferVAOHandle;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of LODs of the draw, counting its own mesh
+//
+int Renderable::GetLODCount(unsigned int drawIndex) const
+{
+	return (int) m_draws[drawIndex].lods.size() + 1;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the mesh the draw renders with at the given LOD
+//
+Mesh* Renderable::GetMeshForLOD(unsigned int drawIndex, int lodIndex) const
+{
+	return (lodIndex == 0 ? m_draws[drawIndex].mesh : m_draws[drawIndex].lods[lodIndex - 1].mesh);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the Vertex Array Object handle for the given LOD of the draw
+//
+unsigned int Renderable::GetVAOHandleForLOD(unsigned int drawIndex, int lodIndex) const
+{
+	return (lodIndex == 0 ? m_draws[drawIndex].vaoHandle : m_draws[drawIndex].lods[lodIndex - 1].vaoHandle);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the Vertex Array Object handle for the given LOD of the draw bound to the depth-only shader
+//
+unsigned int Renderable::GetDepthVAOHandleForLOD(unsigned int drawIndex, int lodIndex) const
+{
+	return (lodIndex == 0 ? m_draws[drawIndex].depthVAOHandle : m_draws[drawIndex].lods[lodIndex - 1].depthVAOHandle);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the Vertex Array Object handle for the given LOD of the draw bound to the G-buffer shader
+//
+unsigned int Renderable::GetGBufferVAOHandleForLOD(unsigned int drawIndex, int lodIndex) const
+{
+	return (lodIndex == 0 ? m_draws[drawIndex].gBufferVAOHandle : m_draws[drawIndex].lods[lodIndex - 1].gBufferVAOHandle);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the LOD the draw should render at for an instance covering screenSize of the screen's
+// height, starting from the LOD it rendered at last and only switching once the size is clear of
+// the threshold by the hysteresis fraction
+//
+int Renderable::SelectLOD(unsigned int drawIndex, float screenSize, int currentLOD, float hysteresis) const
+{
+	const std::vector<RenderableLOD_t>& lods = m_draws[drawIndex].lods;
+
+	int lodCount = (int) lods.size() + 1;
+	int lodIndex = ClampInt(currentLOD, 0, lodCount - 1);
+
+	// LOD n is used below lods[n - 1]'s screen size
+	while (lodIndex + 1 < lodCount && screenSize < lods[lodIndex].maxScreenSize * (1.f - hysteresis))
+	{
+		lodIndex++;
+	}
+
+	while (lodIndex > 0 && screenSize > lods[lodIndex - 1].maxScreenSize * (1.f + hysteresis))
+	{
+		lodIndex--;
+	}
+
+	return lodIndex;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the position of the renderable if it has a transform, or (0,0,0) otherwise
 //
 Vector3 Renderable::GetInstancePosition(unsigned int instanceIndex) const
 {
-	return m_instanceModels[instanceIndex].GetTVector().xyz();
+	return m_instanceModels[instanceIndex].GetTVector().xyz() + m_worldOrigin.ToVector3();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Computes the world space bounds of one draw of one instance, using the mesh's local bounds
+// Returns false if the mesh doesn't have bounds, in which case it should be treated as always visible
+//
+bool Renderable::GetWorldBounds(unsigned int drawIndex, unsigned int instanceIndex, AABB3& out_bounds) const
+{
+	const RenderableDraw_t& draw = m_draws[drawIndex];
+
+	if (draw.mesh == nullptr || !draw.mesh->HasBounds())
+	{
+		return false;
+	}
+
+	// Same matrix the draw call renders with
+	Matrix44 worldMatrix = m_instanceModels[instanceIndex] * draw.drawMatrix;
+	out_bounds = draw.mesh->GetBounds().GetTransformed(worldMatrix);
+
+	Vector3 worldOrigin = m_worldOrigin.ToVector3();
+	out_bounds.mins += worldOrigin;
+	out_bounds.maxs += worldOrigin;
+
+	return true;
 }
 
 
@@ -224,12 +577,24 @@ int Renderable::GetInstanceCount() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the revision of the renderable, which changes any time its draws or instances do
+//
+unsigned int Renderable::GetRevision() const
+{
+	return m_revision;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Clears the instance matrix data
 //
 void Renderable::ClearInstances()
 {
 	m_instanceModels.clear();
+	m_instanceBoneOffsets.clear();
+	m_instanceCustomData.clear();
+	MarkDirty();
 }
 
 
@@ -250,14 +615,27 @@ void Renderable::ClearDraws()
 			delete m_draws[drawIndex].materialInstance;
 		}
 
-		// Also check to free the VAO
+		// Also check to free the VAOs, the LODs' included
 		if (m_draws[drawIndex].vaoHandle != 0)
 		{
 			renderer->DeleteVAO(m_draws[drawIndex].vaoHandle);
 		}
+
+		if (m_draws[drawIndex].depthVAOHandle != 0)
+		{
+			renderer->DeleteVAO(m_draws[drawIndex].depthVAOHandle);
+		}
+
+		if (m_draws[drawIndex].gBufferVAOHandle != 0)
+		{
+			renderer->DeleteVAO(m_draws[drawIndex].gBufferVAOHandle);
+		}
+
+		ClearLODs(drawIndex);
 	}
 
 	m_draws.clear();
+	MarkDirty();
 }
 
 
@@ -287,4 +665,39 @@ void Renderable::BindMeshToMaterial(unsigned int drawIndex)
 
 	Renderer* renderer = Renderer::GetInstance();
 	renderer->UpdateVAO(m_draws[drawIndex].vaoHandle, mesh, material);
+	renderer->UpdateDepthOnlyVAO(m_draws[drawIndex].depthVAOHandle, mesh);
+
+	// Only deferrable shaders' draws can go through a deferred camera's G-buffer
+	bool isDeferrable = (material->GetShader() != nullptr && material->GetShader()->IsDeferrable());
+	if (isDeferrable)
+	{
+		renderer->UpdateGBufferVAO(m_draws[drawIndex].gBufferVAOHandle, mesh);
+	}
+
+	std::vector<RenderableLOD_t>& lods = m_draws[drawIndex].lods;
+	for (int lodIndex = 0; lodIndex < (int) lods.size(); ++lodIndex)
+	{
+		renderer->UpdateVAO(lods[lodIndex].vaoHandle, lods[lodIndex].mesh, material);
+		renderer->UpdateDepthOnlyVAO(lods[lodIndex].depthVAOHandle, lods[lodIndex].mesh);
+
+		if (isDeferrable)
+		{
+			renderer->UpdateGBufferVAO(lods[lodIndex].gBufferVAOHandle, lods[lodIndex].mesh);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Bumps the revision so anything caching data from this renderable rebuilds it
+//
+void Renderable::MarkDirty()
+{
+	m_revision++;
+
+	// Skip 0 on wrap around, since caches use it to mean "never built"
+	if (m_revision == 0)
+	{
+		m_revision = 1;
+	}
 }
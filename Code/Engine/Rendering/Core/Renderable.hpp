@@ -5,13 +5,29 @@
 /* Description: Class to represent an object to be rendered (mesh and material)
 /************************************************************************/
 #pragma once
+#include <stdint.h>
+#include "Engine/Math/Vector4.hpp"
 #include "Engine/Math/Matrix44.hpp"
+#include "Engine/Math/DoubleVector3.hpp"
 #include "Engine/Rendering/Meshes/Mesh.hpp"
 
 class Material;
+class MeshGroup;
 class MeshBuilder;
 class MaterialInstance;
 
+// A lower detail mesh a draw switches to when its instance covers less than maxScreenSize of the
+// screen's height, as a fraction of it
+struct RenderableLOD_t
+{
+	Mesh*			mesh = nullptr;
+	float			maxScreenSize = 0.f;
+
+	unsigned int	vaoHandle = 0;
+	unsigned int	depthVAOHandle = 0;
+	unsigned int	gBufferVAOHandle = 0;
+};
+
 struct RenderableDraw_t
 {
 	Matrix44			drawMatrix;
@@ -20,6 +36,10 @@ struct RenderableDraw_t
 	MaterialInstance*	materialInstance = nullptr;
 
 	unsigned int vaoHandle = 0;
+	unsigned int depthVAOHandle = 0;	// Mesh bound to the depth-only shader, for depth pre-passes
+	unsigned int gBufferVAOHandle = 0;	// Mesh bound to the G-buffer shader, only if the material's shader is deferrable
+
+	std::vector<RenderableLOD_t> lods;	// LOD 1 onward, finest first - the mesh above is LOD 0
 };
 
 class Renderable
@@ -37,12 +57,34 @@ public:
 	void SetInstanceMatrix(unsigned int instanceIndex, const Matrix44& model);
 	void AddInstanceMatrix(const Matrix44& model);
 	void RemoveInstanceMatrix(unsigned int instanceIndex);
+	void SetInstanceMatrices(const Matrix44* models, unsigned int instanceCount);		// Replaces every instance
+
+	// Instance matrices are relative to this double precision world position, so content far from the
+	// world origin keeps float precision without rebuilding its matrices; zero by default
+	void SetWorldOrigin(const DoubleVector3& worldOrigin);
+
+	// Static renderables are what a LightProbeVolume bakes around and occludes its lights with
+	// Doesn't change the revision, the probes need baking again to see the change
+	void SetStatic(bool isStatic);
+
+	// Index of the instance's first matrix in the AnimationSystem's skinning palette, for skinned draws
+	// Doesn't change the revision, so it can be set every frame without rebuilding the scene's caches
+	void SetInstanceBoneOffset(unsigned int instanceIndex, uint32_t boneOffset);
+
+	// Per instance vec4 the shader reads as INSTANCE_CUSTOM_DATA, i.e. a tint; instances never given one read white
+	// Doesn't change the revision either
+	void SetInstanceCustomData(unsigned int instanceIndex, const Vector4& customData);
 
 	void SetMesh(unsigned int index, Mesh* mesh);
 	void SetModelMatrix(unsigned int index, const Matrix44& model);
 	void SetSharedMaterial(unsigned int index, Material* sharedMaterial);
 	void SetMaterialInstance(unsigned int index, MaterialInstance* materialInstance);
 
+	// LODs are drawn with the draw's material, and selected per instance by the ForwardRenderingPath
+	void AddLOD(unsigned int drawIndex, Mesh* mesh, float maxScreenSize);
+	void SetLODsFromMeshGroup(unsigned int drawIndex, const MeshGroup* group, int meshIndex);
+	void ClearLODs(unsigned int drawIndex);
+
 
 	// Accessors
 	RenderableDraw_t	GetDraw(unsigned int drawIndex) const;
@@ -50,14 +92,34 @@ public:
 	Mesh*				GetMesh(unsigned int drawIndex) const;
 	Material*			GetSharedMaterial(unsigned int drawIndex) const;
 	Material*			GetMaterialInstance(unsigned int drawIndex);
-	Matrix44			GetInstanceMatrix(unsigned int instanceIndex) const;
+	Matrix44			GetInstanceMatrix(unsigned int instanceIndex) const;	// Relative to the world origin
+	DoubleVector3		GetWorldOrigin() const;
+	bool				IsStatic() const;
+	uint32_t			GetInstanceBoneOffset(unsigned int instanceIndex) const;
+	const uint32_t*		GetInstanceBoneOffsets() const;		// One per instance, nullptr if none were ever set
+	Vector4				GetInstanceCustomData(unsigned int instanceIndex) const;
+	const Vector4*		GetInstanceCustomDatas() const;		// One per instance, nullptr if none were ever set
 
 	Material*			GetMaterialForRender(unsigned int drawIndex) const;
 
 	unsigned int		GetVAOHandleForDraw(unsigned int drawIndex) const;
+	unsigned int		GetDepthVAOHandleForDraw(unsigned int drawIndex) const;
+	unsigned int		GetGBufferVAOHandleForDraw(unsigned int drawIndex) const;
+
+	// LOD 0 is the draw's own mesh
+	int					GetLODCount(unsigned int drawIndex) const;
+	Mesh*				GetMeshForLOD(unsigned int drawIndex, int lodIndex) const;
+	unsigned int		GetVAOHandleForLOD(unsigned int drawIndex, int lodIndex) const;
+	unsigned int		GetDepthVAOHandleForLOD(unsigned int drawIndex, int lodIndex) const;
+	unsigned int		GetGBufferVAOHandleForLOD(unsigned int drawIndex, int lodIndex) const;
+
+	// Moving to a coarser LOD takes a screen size hysteresis below its threshold, and back up to a finer
+	// one as far above it, so instances near a threshold don't flicker between the two
+	int					SelectLOD(unsigned int drawIndex, float screenSize, int currentLOD, float hysteresis) const;
 
 	// Producers
 	Vector3 GetInstancePosition(unsigned int instanceIndex) const;
+	bool	GetWorldBounds(unsigned int drawIndex, unsigned int instanceIndex, AABB3& out_bounds) const;
 
 	int		GetDrawCountPerInstance() const;
 	int		GetInstanceCount() const;
@@ -66,17 +128,26 @@ public:
 	void	ClearDraws();
 	void	ClearAll();
 
+	unsigned int GetRevision() const; // Changes whenever the draws or instances change, for caching
+
 
 private:
 	//-----Private Methods-----
 
 	void BindMeshToMaterial(unsigned int drawIndex);
+	void MarkDirty();
 
 
 private:
 	//-----Private Data-----
 
 	std::vector<Matrix44>			m_instanceModels;
+	std::vector<uint32_t>			m_instanceBoneOffsets;	// Empty until one is set, then kept to the instance count
+	std::vector<Vector4>			m_instanceCustomData;	// Same
 	std::vector<RenderableDraw_t>	m_draws;
+	DoubleVector3					m_worldOrigin = DoubleVector3::ZERO;
+	bool							m_isStatic = false;
+
+	unsigned int					m_revision = 1; // 0 is never used, so caches can start there
 
 };
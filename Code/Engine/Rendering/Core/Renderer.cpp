@@ -14,6 +14,7 @@
 #include "Engine/Rendering/Core/Renderer.hpp"
 #include "Engine/Rendering/Resources/Texture.hpp"
 #include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include "Engine/Rendering/OpenGL/GLStateCache.hpp"
 #include "Engine/Rendering/Shaders/Shader.hpp"
 #include "Engine/Rendering/Shaders/ShaderProgram.hpp"
 #include "Engine/Rendering/Buffers/RenderBuffer.hpp"
@@ -24,14 +25,39 @@
 #include "Engine/Core/File.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Rendering/Meshes/MeshBuilder.hpp"
+#include "Engine/Rendering/Meshes/MeshArena.hpp"
+#include "Engine/Rendering/Buffers/GPUUploadQueue.hpp"
+#include "Engine/Rendering/Buffers/GPUReadbackQueue.hpp"
+#include "Engine/Rendering/Resources/RenderTargetPool.hpp"
+#include "Engine/Rendering/Buffers/UniformArena.hpp"
+#include "Engine/Rendering/Buffers/InstanceDataStream.hpp"
+#include "Engine/Rendering/Core/HiZBuffer.hpp"
+#include "Engine/Rendering/Core/DeferredRenderingPath.hpp"
+#include "Engine/Rendering/Particles/GPUParticleEmitter.hpp"
+#include "Engine/Rendering/Animation/GPUSkinning.hpp"
+#include "Engine/Rendering/Core/GPUProfiler.hpp"
+#include "Engine/Rendering/Core/RenderBenchmark.hpp"
+#include "Engine/Rendering/Shaders/ShaderSource.hpp"
 #include "Engine/Rendering/DebugRendering/DebugRenderSystem.hpp"
 #include "Engine/Assets/AssetDB.hpp"
+#include "Engine/Assets/AssetHotReloader.hpp"
+#include "Engine/Assets/AssetResidency.hpp"
 #include "Engine/Core/Time/Clock.hpp"
+#include "Engine/Core/Time/FixedStepScheduler.hpp"
+#include "Engine/Core/Time/ProfileCounters.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
 #include "Engine/Rendering/Materials/Material.hpp"
 #include "Engine/Rendering/Materials/MaterialPropertyBlock.hpp"
 #include "Engine/Rendering/Shaders/PropertyBlockDescription.hpp"
 #include "Engine/Rendering/Core/Light.hpp"
 #include "Engine/Core/Threading/Threading.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/StartupGraph.hpp"
+#include "Engine/Core/JobSystem/MainThreadScheduler.hpp"
+#include "Engine/Rendering/OpenGL/GLLoaderThread.hpp"
+#include <string.h>
+#include <mmsystem.h>
+#pragma comment( lib, "winmm" )	// For timeBeginPeriod(), so the frame rate cap can sleep for 1ms
 
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "ThirdParty/gl/glcorearb.h"
@@ -46,7 +72,11 @@ const char*			Renderer::SHADER_DIRECTORY		= "Data\\Shaders\\";
 const float			Renderer::UI_ORTHO_HEIGHT		= 1080.f;
 AABB2				Renderer::s_UIOrthoBounds;
 
-void SaveScreenshotToFile(void* args);
+// Layouts not drawn for this many frames are evicted, or any not drawn this frame past the max count
+#define TEXT_LAYOUT_CACHE_UNUSED_FRAMES (60)
+#define TEXT_LAYOUT_CACHE_MAX_COUNT (2048)
+
+void SaveScreenshotToFile(const unsigned char* texels, const IntVector2& dimensions, void* userData);
 
 
 //********************Structs for Uniform Buffer Data********************
@@ -56,12 +86,16 @@ struct TimeBufferData
 {
 	TimeBufferData()
 		: m_gameDeltaTime(0.f), m_gameTotalTime(0.f)
-		, m_systemDeltaTime(0.f), m_systemTotalTime(0.f) {}
+		, m_systemDeltaTime(0.f), m_systemTotalTime(0.f)
+		, m_fixedStepAlpha(0.f), m_fixedStepSeconds(0.f), m_padding0(Vector2::ZERO) {}
 
 	float m_gameDeltaTime;
 	float m_gameTotalTime;
 	float m_systemDeltaTime;
 	float m_systemTotalTime;
+	float m_fixedStepAlpha;		// Interpolation alpha of the game's fixed step scheduler, 0 if none is set
+	float m_fixedStepSeconds;
+	Vector2 m_padding0;
 };
 
 // Buffer for light data for all lights
@@ -125,14 +159,68 @@ Renderer::Renderer()
 //
 Renderer::~Renderer()
 {
+	// Delete the font materials
+	std::map<const BitmapFont*, Material*>::iterator fontItr = m_fontMaterials.begin();
+	for (fontItr; fontItr != m_fontMaterials.end(); ++fontItr)
+	{
+		delete fontItr->second;
+	}
+
+	m_fontMaterials.clear();
+
+	delete m_fontSDFSampler;
+	m_fontSDFSampler = nullptr;
+
+	// Delete the image effect materials, they own their shaders
+	std::map<const ShaderProgram*, Material*>::iterator effectItr = m_effectMaterials.begin();
+	for (effectItr; effectItr != m_effectMaterials.end(); ++effectItr)
+	{
+		delete effectItr->second;
+	}
+
+	m_effectMaterials.clear();
+
+	// Dynamic resolution targets and the framebuffers of the upscale
+	delete m_sceneColorTarget;
+	m_sceneColorTarget = nullptr;
+
+	delete m_sceneDepthTarget;
+	m_sceneDepthTarget = nullptr;
+
+	if (m_resolveFramebuffers[0] != NULL)
+	{
+		glDeleteFramebuffers(2, m_resolveFramebuffers);
+		GLStateCache::OnFramebufferDeleted(m_resolveFramebuffers[0]);
+		GLStateCache::OnFramebufferDeleted(m_resolveFramebuffers[1]);
+		m_resolveFramebuffers[0] = NULL;
+		m_resolveFramebuffers[1] = NULL;
+	}
+
 	// Delete cameras
 	delete m_defaultCamera;
 	delete m_UICamera;
 	delete m_effectsCamera;
 
+	// Frame fences, and the timer resolution raised for the frame rate cap
+	DeleteFrameFences();
+	SetFrameRateCap(0.f);
+
 	// Free the vao 
 	glDeleteVertexArrays(1, &m_defaultVAO);
+	GLStateCache::OnVertexArrayDeleted(m_defaultVAO);
 	GL_CHECK_ERROR();
+
+	// Arena buffers and VAOs need the context, so go before it does
+	GLLoaderThread::Shutdown();
+	GPUUploadQueue::Shutdown();
+	GPUReadbackQueue::Shutdown();
+	UniformArena::Shutdown();
+	InstanceDataStream::Shutdown();
+	RenderTargetPool::Shutdown();
+	MeshArena::DestroyAllArenas();
+	HiZBuffer::DestroySharedResources();
+	GPUParticleEmitter::DestroySharedResources();
+	GPUSkinning::Shutdown();
 }
 
 
@@ -142,6 +230,14 @@ Renderer::~Renderer()
 void Renderer::Initialize()
 {
 	GUARANTEE_OR_DIE(s_instance == nullptr, "Error: Renderer::Initialize() called when the Renderer instance exists.");
+
+	// No context to render with, the game skips rendering entirely
+	if (IsEngineHeadless())
+	{
+		LogTaggedPrintf("RENDER", "Running headless, no renderer created");
+		return;
+	}
+
 	new Renderer();
 
 	// Static setup
@@ -154,6 +250,10 @@ void Renderer::Initialize()
 //
 void Renderer::Shutdown()
 {
+	// Queries are deleted while the context still exists
+	RenderBenchmark::Shutdown();
+	GPUProfiler::Shutdown();
+
 	if (s_instance != nullptr)
 	{
 		delete s_instance;
@@ -179,11 +279,67 @@ void Renderer::BeginFrame()
 	// Leftover errors from the last frame?
 	GL_CHECK_ERROR();
 
+	// Wait on the GPU and the frame rate cap before the game samples its input for this frame
+	WaitForFramePacing();
+
+	// Start counting this frame's state changes
+	GLStateCache::BeginFrame();
+
+	// Pick the scene's resolution from the frames the GPU has finished, and start timing this one
+	if (m_isDynamicResolutionEnabled)
+	{
+		m_dynamicResolution.BeginFrame();
+		m_isSceneResolved = false;
+	}
+
+	// Report GPU times from a couple frames ago, and start measuring this one
+	GPUProfiler::BeginFrame();
+
+	// Measure the last frame of a benchmark run and fly its camera, before the game renders with it
+	RenderBenchmark::BeginFrame();
+
+	// Main thread work below is time-sliced out of one budget a frame, so a burst of it doesn't hitch
+	MainThreadScheduler::BeginFrame();
+
+	// Queue reloads of changed files, then upload any assets that finished loading in the background
+	AssetHotReloader::Update();
+	AssetDB::FinalizeAsyncLoads();
+
+	// Swap in the shader programs the driver has finished compiling since last frame
+	ShaderProgram::UpdateAsyncCompiles();
+
+	// Then whatever GL work was queued for this thread, with what's left of the budget
+	MainThreadScheduler::Update();
+
+	// Hand over the objects the loader thread made, once the GPU is past their fences
+	GLLoaderThread::Update();
+
+	// Stage this frame's share of the queued uploads, and swap in the ones the GPU has finished
+	GPUUploadQueue::Update();
+	GPUReadbackQueue::Update();
+
+	// Per-draw uniforms go into the next frame's arena; the model binding can't be left pointing into an old frame's
+	UniformArena::BeginFrame();
+	BindModelMatrix(Matrix44::IDENTITY);
+	InstanceDataStream::BeginFrame();
+
+	// Sizes are known now that uploads are done, so evict whatever's over budget
+	AssetResidency::Update();
+
 	// Set the default shader program to the current program reference
 	SetCurrentCamera(nullptr);
 	ClearScreen(Rgba(0,0,0,0));
 	ClearDepth();
 
+	// The default camera draws to the scene targets with dynamic resolution, so the UI's depth is cleared here
+	// Its color is overwritten by the upscale
+	if (m_isDynamicResolutionEnabled)
+	{
+		m_UICamera->FinalizeFrameBuffer();
+		ClearDepth();
+		m_defaultCamera->FinalizeFrameBuffer();
+	}
+
 	// Update the time uniform buffer on the gpu
 	UpdateTimeData();
 
@@ -197,38 +353,47 @@ void Renderer::BeginFrame()
 //
 void Renderer::EndFrame()
 {
-	// Copy the default frame buffer to the back buffer before swapping
-	m_defaultCamera->FinalizeFrameBuffer();
-	CopyFrameBuffer( nullptr, &m_defaultCamera->m_frameBuffer ); 
+	// Draw whatever's still batched, and resolve any effects left unfinished
+	FlushImmediateDraws();
+	FinalizeImageEffects();
 
-	// "Present" the backbuffer by swapping in our color target buffer
-	SwapBuffers(gHDC); 
+	EvictUnusedTextLayouts();
+	RenderTargetPool::EndFrame();
+	m_frameNumber++;
 
-	// Save off the (newly swapped) back buffer to file
+	// Read the finished frame back for the screenshot, written to file on a worker once the GPU gets to it
 	if (m_saveScreenshotThisFrame)
 	{
-		// Get and setup buffer info
-		IntVector2 dimensions = m_defaultColorTarget->GetDimensions();
-		int numTexels = dimensions.x * dimensions.y;
-		char* buffer = (char*) malloc(sizeof(char) * numTexels * 4);	// 4 components, request the screenshot in RGBA format
-
-		// Read the back buffer
-		glReadPixels((GLint)0, (GLint)0, (GLint)dimensions.x, (GLint)dimensions.y, GL_RGBA, GL_UNSIGNED_BYTE, buffer);
+		GPUReadbackQueue::QueueTextureReadback(m_defaultColorTarget, SaveScreenshotToFile);
+		m_saveScreenshotThisFrame = false;
+	}
 
-		GL_CHECK_ERROR();
+	// Copy the default frame buffer to the back buffer before swapping
+	// With dynamic resolution the default camera draws to the scene targets, but the UI camera is always native
+	{
+		PROFILE_GPU_SCOPE("FinalizeFrame");
+		Camera* finalCamera = (m_isDynamicResolutionEnabled ? m_UICamera : m_defaultCamera);
+		finalCamera->FinalizeFrameBuffer();
+		CopyFrameBuffer( nullptr, &finalCamera->m_frameBuffer );
+	}
 
-		// Set up thread arguments
-		char** args = (char**) malloc(sizeof(char*) + sizeof(IntVector2));
+	if (m_isDynamicResolutionEnabled)
+	{
+		m_dynamicResolution.EndFrame();
+	}
 
-		*(args) = buffer;
-		*((IntVector2*)(args + 1)) = dimensions;
+	UniformArena::EndFrame();
+	InstanceDataStream::EndFrame();
 
+	// "Present" the backbuffer by swapping in our color target buffer
+	SwapBuffers(gHDC); 
 
-		// Write to file, thread will clean up our allocations
-		Thread::CreateAndDetach(SaveScreenshotToFile, args);
+	// Mark the frame's end, so later frames can wait on the GPU finishing it
+	FenceFrameInFlight();
 
-		// Reset flag
-		m_saveScreenshotThisFrame = false;
+	if (m_frameNumber == 1)
+	{
+		StartupGraph::ReportFirstFrame();
 	}
 }
 
@@ -238,9 +403,12 @@ void Renderer::EndFrame()
 //
 void Renderer::ClearScreen(const Rgba& clearColor)
 {
+	FlushImmediateDraws();
+
 	float red, green, blue, alpha;
 	clearColor.GetAsFloats(red, green, blue, alpha);
 
+	GLStateCache::SetColorMask(true);
 	glClearColor(red, green, blue, alpha);
 	glClear(GL_COLOR_BUFFER_BIT);
 }
@@ -251,6 +419,9 @@ void Renderer::ClearScreen(const Rgba& clearColor)
 //
 void Renderer::ClearScreen(const Vector3& clearColor)
 {
+	FlushImmediateDraws();
+
+	GLStateCache::SetColorMask(true);
 	glClearColor(clearColor.x, clearColor.y, clearColor.z, 1.0f);
 	glClear(GL_COLOR_BUFFER_BIT);
 }
@@ -261,39 +432,53 @@ void Renderer::ClearScreen(const Vector3& clearColor)
 //
 void Renderer::ApplyImageEffect(ShaderProgram* program)
 {
-	UNUSED(program)
-	UNIMPLEMENTED();
-// 	DisableDepth();
-// 
-// 	// Set up the effects targets if they aren't already set up
-// 	if (m_effectsSource == nullptr)
-// 	{
-// 		m_effectsSource = m_defaultColorTarget;
-// 		if (m_effectsDestination == nullptr)
-// 		{
-// 			m_effectsDestination = new Texture();
-// 			m_effectsDestination->CreateRenderTarget(m_effectsSource->GetDimensions().x, m_effectsSource->GetDimensions().y, TEXTURE_FORMAT_RGBA8);
-// 		}
-// 	}
-// 
-// 	// Draw using the effects camera - to the scratch target
-// 	m_effectsCamera->SetColorTarget(m_effectsDestination);
-// 	SetCurrentCamera(m_effectsCamera);
-// 
-// 	// Set the shader program to the one provided
-// 	Shader* effectShader = new Shader(program);
-// 	SetCurrentShader(effectShader);
-// 
-// 	// Bind the current source as a texture
-// 	BindTexture(0, m_effectsSource->GetHandle());
-// 	
-// 	// Draw the previous buffer as an AABB2 across the entire new render target
-// 	Draw2DQuad(AABB2::UNIT_SQUARE_CENTERED, AABB2::UNIT_SQUARE_OFFCENTER, Rgba::WHITE);
-// 
-// 	// Swap the pointers around for the next effect
-// 	Texture* temp			= m_effectsSource;
-// 	m_effectsSource			= m_effectsDestination;
-// 	m_effectsDestination	= temp;
+	ASSERT_OR_DIE(program != nullptr, "Error: Renderer::ApplyImageEffect() was passed a null program");
+
+	// The first effect of a chain reads the default color target, or the scene's scaled region of its target
+	// before it's upscaled; later effects draw at that scaled size, so they're cheaper too
+	AABB2 sourceUVs = AABB2::UNIT_SQUARE_OFFCENTER;
+	IntVector2 destinationDimensions;
+
+	if (m_effectsSource == nullptr)
+	{
+		bool readsScene = (m_isDynamicResolutionEnabled && !m_isSceneResolved);
+		m_effectsSource = (readsScene ? m_sceneColorTarget : m_defaultColorTarget);
+	}
+
+	if (m_effectsSource == m_sceneColorTarget)
+	{
+		IntVector2 sceneDimensions = m_sceneColorTarget->GetDimensions();
+		destinationDimensions = GetScaledSceneDimensions();
+		sourceUVs.maxs = Vector2((float) destinationDimensions.x / (float) sceneDimensions.x, (float) destinationDimensions.y / (float) sceneDimensions.y);
+	}
+	else
+	{
+		destinationDimensions = m_effectsSource->GetDimensions();
+	}
+
+	// Draws made so far have to land in the source first
+	FlushImmediateDraws();
+
+	// Draw using the effects camera - to a pooled scratch target
+	m_effectsDestination = RenderTargetPool::AcquireTransient(destinationDimensions, m_effectsSource->GetFormat());
+	m_effectsCamera->SetColorTarget(m_effectsDestination);
+	SetCurrentCamera(m_effectsCamera);
+
+	// Draw the previous buffer as an AABB2 across the entire new render target
+	Material* effectMaterial = GetImageEffectMaterial(program);
+	effectMaterial->SetDiffuse(m_effectsSource);
+
+	Draw2DQuad(AABB2::UNIT_SQUARE_CENTERED, sourceUVs, Rgba::WHITE, effectMaterial);
+	FlushImmediateDraws();
+
+	// The source has been read, so the next effect's destination can reuse it; a chain only ever needs two
+	if (m_effectsSource != m_defaultColorTarget && m_effectsSource != m_sceneColorTarget)
+	{
+		RenderTargetPool::Release(m_effectsSource);
+	}
+
+	m_effectsSource = m_effectsDestination;
+	m_effectsDestination = nullptr;
 }
 
 
@@ -302,266 +487,461 @@ void Renderer::ApplyImageEffect(ShaderProgram* program)
 //
 void Renderer::FinalizeImageEffects()
 {
-	UNIMPLEMENTED();
-// 	// Null target means no effects have been applied, so nothing to finalize
-// 	if (m_effectsSource == nullptr)
-// 	{
-// 		return;
-// 	}
-// 
-// 	// An odd number of effects were applied, so ensure the default color target is the final result
-// 	if (m_effectsSource != m_defaultColorTarget)
-// 	{
-// 		Texture::CopyTexture(m_effectsSource, m_defaultColorTarget);
-// 		m_effectsDestination = m_effectsSource;
-// 	}
-// 
-// 	// Signal we're done with our current effects processing
-// 	m_effectsSource = nullptr;
-// 
-// 	SetCurrentCamera(nullptr);
-// 	EnableDepth(DEPTH_TEST_LESS, true);
-}
+	// The scene needs upscaling with or without effects, which finishes those too
+	if (m_isDynamicResolutionEnabled && !m_isSceneResolved)
+	{
+		ResolveScene();
+		SetCurrentCamera(nullptr);
+		return;
+	}
+
+	// Null target means no effects have been applied, so nothing to finalize
+	if (m_effectsSource == nullptr)
+	{
+		return;
+	}
 
+	// Ensure the default color target is the final result
+	if (m_effectsSource != m_defaultColorTarget)
+	{
+		Texture::CopyTexture(m_effectsSource, m_defaultColorTarget);
+		RenderTargetPool::Release(m_effectsSource);
+	}
 
-//-----------------------------------------------------------------------------------------------
-// Creates a render target to be used for intermediate rendering
-//
-Texture* Renderer::CreateRenderTarget(unsigned int width, unsigned int height, TextureFormat format /*= TEXTURE_FORMAT_RGBA8*/)
-{
-	Texture* texture = new Texture();
-	texture->CreateRenderTarget(width, height, format);
+	// Signal we're done with our current effects processing
+	m_effectsSource = nullptr;
 
-	return texture;
+	m_effectsCamera->SetColorTarget(m_defaultColorTarget);
+	SetCurrentCamera(nullptr);
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Creates a depth stencil target texture and returns it
+// Turns dynamic resolution on or off; call between frames, as it changes the default camera's targets
+// The scene targets are made the first time it's turned on, matching the default ones
 //
-Texture* Renderer::CreateDepthTarget(unsigned int width, unsigned int height)
+void Renderer::SetDynamicResolutionEnabled(bool isEnabled)
 {
-	return CreateRenderTarget(width, height, TEXTURE_FORMAT_D24S8);
+	if (isEnabled == m_isDynamicResolutionEnabled)
+	{
+		return;
+	}
+
+	FlushImmediateDraws();
+
+	if (isEnabled && m_sceneColorTarget == nullptr)
+	{
+		IntVector2 dimensions = m_defaultColorTarget->GetDimensions();
+		m_sceneColorTarget = CreateRenderTarget(dimensions.x, dimensions.y, m_defaultColorTarget->GetFormat());
+		m_sceneDepthTarget = CreateDepthTarget(dimensions.x, dimensions.y);
+	}
+
+	m_isDynamicResolutionEnabled = isEnabled;
+
+	// Nothing's been drawn to the scene targets yet, so there's nothing to upscale until the next frame
+	m_isSceneResolved = true;
+	m_dynamicResolution.Reset();
+
+	m_defaultCamera->SetColorTarget(GetSceneColorTarget());
+	m_defaultCamera->SetDepthTarget(GetSceneDepthTarget());
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Returns the color target used by the default camera
+// Returns whether scene cameras are drawing at a dynamic resolution
 //
-Texture* Renderer::GetDefaultColorTarget() const
+bool Renderer::IsDynamicResolutionEnabled() const
 {
-	return m_defaultColorTarget;
+	return m_isDynamicResolutionEnabled;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Returns the depth target used by the default camera
+// Returns the dynamic resolution state, for setting its target frame time and scale range
 //
-Texture* Renderer::GetDefaultDepthTarget() const
+DynamicResolution& Renderer::GetDynamicResolution()
 {
-	return m_defaultDepthTarget;
+	return m_dynamicResolution;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Returns the default camera of the renderer
+// Sets how many frames the CPU may have queued on the GPU, including the one being drawn
+// 1 waits on the GPU every frame for the least latency, more keep the GPU busy through CPU spikes
 //
-Camera* Renderer::GetDefaultCamera() const
+void Renderer::SetMaxFramesInFlight(int maxFramesInFlight)
 {
-	return m_defaultCamera;
+	m_maxFramesInFlight = ClampInt(maxFramesInFlight, 1, RENDERER_MAX_FRAMES_IN_FLIGHT);
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Sets the flag to take a screenshot during the next Renderer::EndFrame()
+// Returns the most frames the CPU may have queued on the GPU
 //
-void Renderer::SaveScreenshotAtEndOfFrame(const std::string& filename)
+int Renderer::GetMaxFramesInFlight() const
 {
-	TODO("Named screenshots, screenshot with console command");
-	UNUSED(filename);
-	m_saveScreenshotThisFrame = true;
+	return m_maxFramesInFlight;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Draws a textured AABB2 from the provided texture data
-// textureUVs are the texture coordinates of the bottom left and top right of the box
+// Caps the frame rate, with BeginFrame() waiting until 1 / framesPerSecond after the last frame started
+// The timer resolution is raised to 1ms while a cap is set, as the wait sleeps for most of it
 //
-void Renderer::Draw2DQuad(const AABB2& bounds, const AABB2& textureUVs, const Rgba& tint, Material* material /*= nullptr*/)
+void Renderer::SetFrameRateCap(float framesPerSecond)
 {
-	// Clear state
-	m_immediateBuilder.Clear();
+	float newCap = MaxFloat(framesPerSecond, 0.f);
 
-	// Build the mesh
-	m_immediateBuilder.BeginBuilding(PRIMITIVE_TRIANGLES, true);
-	m_immediateBuilder.Push2DQuad(bounds, textureUVs, tint);
-	m_immediateBuilder.FinishBuilding();
-	m_immediateBuilder.UpdateMesh(m_immediateMesh);
+	bool wasCapped = (m_frameRateCap > 0.f);
+	bool isCapped = (newCap > 0.f);
 
-	// Draw
-	if (material == nullptr)
+	if (isCapped && !wasCapped)
 	{
-		DrawMesh(&m_immediateMesh);
+		timeBeginPeriod(1);
 	}
-	else
+	else if (wasCapped && !isCapped)
 	{
-		DrawMeshWithMaterial(&m_immediateMesh, material);
+		timeEndPeriod(1);
 	}
+
+	m_frameRateCap = newCap;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Draws an oriented AABB2 in 3D space given the parameters
+// Returns the frame rate cap, 0 if there isn't one
 //
-void Renderer::Draw3DQuad(const Vector3& position, const Vector2& dimensions, const AABB2& textureUVs, const Vector3& right /*= Vector3::DIRECTION_RIGHT*/, const Vector3& up /*= Vector3::DIRECTION_UP*/, const Rgba& tint /*= Rgba::WHITE*/, const Vector2& pivot /*= Vector2(0.5f, 0.5f)*/, Material* material /*= nullptr*/)
+float Renderer::GetFrameRateCap() const
 {
-	// Clear state
-	m_immediateBuilder.Clear();
+	return m_frameRateCap;
+}
 
-	// Build the mesh
-	m_immediateBuilder.BeginBuilding(PRIMITIVE_TRIANGLES, true);
-	m_immediateBuilder.Push3DQuad(position, dimensions, textureUVs, tint, right, up, pivot);
-	m_immediateBuilder.FinishBuilding();
-	m_immediateBuilder.UpdateMesh(m_immediateMesh);
 
-	// Draw
-	if (material == nullptr)
+//-----------------------------------------------------------------------------------------------
+// Sets the swap interval for the vsync mode
+// Adaptive uses a negative interval, so a late frame swaps immediately instead of waiting a whole refresh
+//
+void Renderer::SetVSyncMode(eVSyncMode mode)
+{
+	if (wglSwapIntervalEXT == nullptr)
 	{
-		DrawMesh(&m_immediateMesh);
+		ConsoleWarningf("Warning: Renderer::SetVSyncMode() called without WGL_EXT_swap_control, the driver's vsync is used");
+		return;
 	}
-	else
+
+	if (mode == VSYNC_ADAPTIVE && !IsWGLExtensionSupported("WGL_EXT_swap_control_tear"))
 	{
-		DrawMeshWithMaterial(&m_immediateMesh, material);
+		ConsoleWarningf("Warning: Adaptive vsync needs WGL_EXT_swap_control_tear, using vsync on instead");
+		mode = VSYNC_ON;
 	}
+
+	int swapInterval = 0;
+	switch (mode)
+	{
+	case VSYNC_ON:			swapInterval = 1;	break;
+	case VSYNC_ADAPTIVE:	swapInterval = -1;	break;
+	default:
+		break;
+	}
+
+	wglSwapIntervalEXT(swapInterval);
+	m_vsyncMode = mode;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Draws a cube with the given corner positions and tint
+// Returns the vsync mode in use, which is on if adaptive was asked for without driver support
 //
-void Renderer::DrawSolidCube(const Vector3& center, const Vector3& dimensions, const Rgba& tint /*= Rgba::WHITE*/, const AABB2& topUVs /*= AABB2::UNIT_SQUARE_OFFCENTER*/, const AABB2& sideUVs /*= AABB2::UNIT_SQUARE_OFFCENTER*/, const AABB2& bottomUVs /*= AABB2::UNIT_SQUARE_OFFCENTER*/, Material* material /*= nulltpr*/)
+eVSyncMode Renderer::GetVSyncMode() const
 {
-	// Clear state
-	m_immediateBuilder.Clear();
+	return m_vsyncMode;
+}
 
-	// Build the mesh
-	m_immediateBuilder.BeginBuilding(PRIMITIVE_TRIANGLES, true);
-	m_immediateBuilder.PushCube(center, dimensions, tint, sideUVs, topUVs, bottomUVs);
-	m_immediateBuilder.FinishBuilding();
-	m_immediateBuilder.UpdateMesh(m_immediateMesh);
 
-	// Draw
-	if (material == nullptr)
-	{
-		DrawMesh(&m_immediateMesh);
-	}
-	else
-	{
-		DrawMeshWithMaterial(&m_immediateMesh, material);
-	}
+//-----------------------------------------------------------------------------------------------
+// Sets the function called at the start of each frame once the frame pacing waits are done
+// Games re-sample input here (i.e. the InputSystem's raw mouse delta) to aim the camera with the freshest input
+//
+void Renderer::SetLateInputSampleCallback(LateInputSample_cb callback, void* args)
+{
+	m_lateInputSampleCallback = callback;
+	m_lateInputSampleArgs = args;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Draws a wire cube using GLLines
+// Returns how long this frame's BeginFrame() waited on the GPU and the frame rate cap
 //
-void Renderer::DrawWireCube(const Vector3& center, const Vector3& dimensions, const Rgba& tint /*= Rgba::WHITE*/, Material* material /*= nullptr*/)
+float Renderer::GetLastFramePacingWaitSeconds() const
 {
-	Vector3 halfDimensions = dimensions * 0.5f;
-	Vector3 mins = center - halfDimensions;
-	Vector3 maxs = center + halfDimensions;
+	return m_lastFramePacingWaitSeconds;
+}
 
-	// Clear state
-	m_immediateBuilder.Clear();
 
-	// Build the mesh
-	m_immediateBuilder.BeginBuilding(PRIMITIVE_LINES, false);
+//-----------------------------------------------------------------------------------------------
+// Returns the texel size of the scaled region of the scene targets drawn to this frame
+//
+IntVector2 Renderer::GetScaledSceneDimensions() const
+{
+	IntVector2 dimensions = m_sceneColorTarget->GetDimensions();
+	float scale = m_dynamicResolution.GetScale();
 
-	m_immediateBuilder.PushLine(Vector3(mins.x, mins.y, mins.z), Vector3(maxs.x, mins.y, mins.z), tint);
-	m_immediateBuilder.PushLine(Vector3(maxs.x, mins.y, mins.z), Vector3(maxs.x, maxs.y, mins.z), tint);
-	m_immediateBuilder.PushLine(Vector3(maxs.x, maxs.y, mins.z), Vector3(mins.x, maxs.y, mins.z), tint);
-	m_immediateBuilder.PushLine(Vector3(mins.x, maxs.y, mins.z), Vector3(mins.x, mins.y, mins.z), tint);
+	int scaledWidth = MaxInt((int) (scale * (float) dimensions.x), 1);
+	int scaledHeight = MaxInt((int) (scale * (float) dimensions.y), 1);
 
-	m_immediateBuilder.PushLine(Vector3(mins.x, mins.y, maxs.z), Vector3(maxs.x, mins.y, maxs.z), tint);
-	m_immediateBuilder.PushLine(Vector3(maxs.x, mins.y, maxs.z), Vector3(maxs.x, maxs.y, maxs.z), tint);
-	m_immediateBuilder.PushLine(Vector3(maxs.x, maxs.y, maxs.z), Vector3(mins.x, maxs.y, maxs.z), tint);
-	m_immediateBuilder.PushLine(Vector3(mins.x, maxs.y, maxs.z), Vector3(mins.x, mins.y, maxs.z), tint);
+	return IntVector2(scaledWidth, scaledHeight);
+}
 
-	m_immediateBuilder.PushLine(Vector3(mins.x, mins.y, mins.z), Vector3(mins.x, mins.y, maxs.z), tint);
-	m_immediateBuilder.PushLine(Vector3(maxs.x, mins.y, mins.z), Vector3(maxs.x, mins.y, maxs.z), tint);
-	m_immediateBuilder.PushLine(Vector3(maxs.x, maxs.y, mins.z), Vector3(maxs.x, maxs.y, maxs.z), tint);
-	m_immediateBuilder.PushLine(Vector3(mins.x, maxs.y, mins.z), Vector3(mins.x, maxs.y, maxs.z), tint);
 
-	m_immediateBuilder.FinishBuilding();
-	m_immediateBuilder.UpdateMesh<Vertex3D_PCU>(m_immediateMesh);
+//-----------------------------------------------------------------------------------------------
+// Upscales the scene, or the result of the effects applied to it, into the default color target
+// Done once a frame, before the first native resolution camera draws or at the end of the frame
+//
+void Renderer::ResolveScene()
+{
+	m_isSceneResolved = true;
+	FlushImmediateDraws();
 
-	// Draw
-	if (material == nullptr)
+	if (m_effectsSource == nullptr || m_effectsSource == m_sceneColorTarget)
 	{
-		DrawMesh(&m_immediateMesh);
+		BlitToDefaultColorTarget(m_sceneColorTarget, GetScaledSceneDimensions());
 	}
 	else
 	{
-		DrawMeshWithMaterial(&m_immediateMesh, material);
+		// Effects drew at the scaled size, so all of their result is upscaled
+		BlitToDefaultColorTarget(m_effectsSource, m_effectsSource->GetDimensions());
+
+		if (m_effectsSource != m_defaultColorTarget)
+		{
+			RenderTargetPool::Release(m_effectsSource);
+		}
 	}
+
+	m_effectsSource = nullptr;
+	m_effectsCamera->SetColorTarget(m_defaultColorTarget);
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Draws a sphere with the given parameters
+// Stretches the bottom left region of the source over all of the default color target, filtered
 //
-void Renderer::DrawSphere(const Vector3& position, float radius, unsigned int numWedges, unsigned int numSlices, const Rgba& color /*= Rgba::WHITE*/, Material* material /*= nulltpr*/)
+void Renderer::BlitToDefaultColorTarget(const Texture* source, const IntVector2& sourceDimensions)
 {
-	// Clear state
-	m_immediateBuilder.Clear();
-
-	// Build the mesh
-	m_immediateBuilder.BeginBuilding(PRIMITIVE_TRIANGLES, true);
-	m_immediateBuilder.PushUVSphere(position, radius, numWedges, numSlices, color);
-	m_immediateBuilder.FinishBuilding();
-	m_immediateBuilder.UpdateMesh(m_immediateMesh);
-
-	// Draw
-	if (material == nullptr)
+	if (m_resolveFramebuffers[0] == NULL)
 	{
-		DrawMesh(&m_immediateMesh);
+		glGenFramebuffers(2, m_resolveFramebuffers);
 	}
-	else
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, m_resolveFramebuffers[0]);
+	glFramebufferTexture(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, source->GetHandle(), 0);
+
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_resolveFramebuffers[1]);
+	glFramebufferTexture(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, m_defaultColorTarget->GetHandle(), 0);
+
+	IntVector2 destinationDimensions = m_defaultColorTarget->GetDimensions();
+	glBlitFramebuffer(0, 0, sourceDimensions.x, sourceDimensions.y, 0, 0, destinationDimensions.x, destinationDimensions.y, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+
+	// Raw binds, so the cache doesn't know what's bound anymore
+	glBindFramebuffer(GL_FRAMEBUFFER, NULL);
+	GLStateCache::InvalidateFramebuffer();
+	GL_CHECK_ERROR();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the material for drawing the image effect program, making it the first time
+//
+Material* Renderer::GetImageEffectMaterial(ShaderProgram* program)
+{
+	std::map<const ShaderProgram*, Material*>::iterator itr = m_effectMaterials.find(program);
+	if (itr != m_effectMaterials.end())
 	{
-		DrawMeshWithMaterial(&m_immediateMesh, material);
+		return itr->second;
 	}
+
+	Material* effectMaterial = new Material();
+	effectMaterial->SetShader(new Shader(program), true);
+
+	m_effectMaterials[program] = effectMaterial;
+	return effectMaterial;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Draws the given sprite at the position with tint
+// Creates a render target to be used for intermediate rendering
 //
-void Renderer::DrawSprite(const Sprite* sprite, const Vector3& position, const Rgba& tint /*= Rgba::WHITE*/, const Vector3& right /*= Vector3::DIRECTION_RIGHT*/, const Vector3& up /*= Vector3::DIRECTION_UP*/)
+Texture* Renderer::CreateRenderTarget(unsigned int width, unsigned int height, TextureFormat format /*= TEXTURE_FORMAT_RGBA8*/)
 {
-	UNUSED(sprite)
-	UNUSED(position)
-	UNUSED(tint)
-	UNUSED(right)
-	UNUSED(up)
+	Texture* texture = new Texture();
+	texture->CreateRenderTarget(width, height, format);
 
-	UNIMPLEMENTED();
-// 	BindTexture(0, sprite->GetTexture().GetHandle());
-// 	Vector2 spriteDimensions	= sprite->GetDimensions();
-// 	Vector2 spritePivot			= sprite->GetPivot();
-// 	AABB2 spriteUVs				= sprite->GetUVs();
-// 
-// 	// Find the min and max X values for the sprite AABB2 draw bounds
-// 	float minX = -1.0f * (spritePivot.x * spriteDimensions.x);
-// 	float maxX = minX + spriteDimensions.x;
-// 
-// 	// Find the min and max X values for the sprite AABB2 draw bounds
-// 	float minY = -1.0f * (spritePivot.y * spriteDimensions.y);
-// 	float maxY = minY + spriteDimensions.y;
-// 
-// 	Vector3 bottomLeft 		= position + minX * right + minY * up;
-// 	Vector3 bottomRight 	= position + maxX * right + minY * up;
-// 	Vector3 topLeft 		= position + minX * right + maxY * up;
-// 	Vector3 topRight 		= position + maxX * right + maxY * up;
+	return texture;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Creates a depth stencil target texture and returns it
+//
+Texture* Renderer::CreateDepthTarget(unsigned int width, unsigned int height)
+{
+	return CreateRenderTarget(width, height, TEXTURE_FORMAT_D24S8);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the color target used by the default camera
+//
+Texture* Renderer::GetDefaultColorTarget() const
+{
+	return m_defaultColorTarget;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the depth target used by the default camera
+//
+Texture* Renderer::GetDefaultDepthTarget() const
+{
+	return m_defaultDepthTarget;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the color target scene cameras should draw to, scaled with dynamic resolution on
+//
+Texture* Renderer::GetSceneColorTarget() const
+{
+	return (m_isDynamicResolutionEnabled ? m_sceneColorTarget : m_defaultColorTarget);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the depth target scene cameras should draw to, scaled with dynamic resolution on
+//
+Texture* Renderer::GetSceneDepthTarget() const
+{
+	return (m_isDynamicResolutionEnabled ? m_sceneDepthTarget : m_defaultDepthTarget);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the default camera of the renderer
+//
+Camera* Renderer::GetDefaultCamera() const
+{
+	return m_defaultCamera;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the flag to take a screenshot during the next Renderer::EndFrame()
+//
+void Renderer::SaveScreenshotAtEndOfFrame(const std::string& filename)
+{
+	TODO("Named screenshots, screenshot with console command");
+	UNUSED(filename);
+	m_saveScreenshotThisFrame = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Draws a textured AABB2 from the provided texture data
+// textureUVs are the texture coordinates of the bottom left and top right of the box
+//
+void Renderer::Draw2DQuad(const AABB2& bounds, const AABB2& textureUVs, const Rgba& tint, Material* material /*= nullptr*/)
+{
+	MeshBuilder& builder = BeginImmediateDraw(material, PRIMITIVE_TRIANGLES, &VertexLit::LAYOUT);
+	builder.Push2DQuad(bounds, textureUVs, tint);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Draws an oriented AABB2 in 3D space given the parameters
+//
+void Renderer::Draw3DQuad(const Vector3& position, const Vector2& dimensions, const AABB2& textureUVs, const Vector3& right /*= Vector3::DIRECTION_RIGHT*/, const Vector3& up /*= Vector3::DIRECTION_UP*/, const Rgba& tint /*= Rgba::WHITE*/, const Vector2& pivot /*= Vector2(0.5f, 0.5f)*/, Material* material /*= nullptr*/)
+{
+	MeshBuilder& builder = BeginImmediateDraw(material, PRIMITIVE_TRIANGLES, &VertexLit::LAYOUT);
+	builder.Push3DQuad(position, dimensions, textureUVs, tint, right, up, pivot);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Draws a cube with the given corner positions and tint
+//
+void Renderer::DrawSolidCube(const Vector3& center, const Vector3& dimensions, const Rgba& tint /*= Rgba::WHITE*/, const AABB2& topUVs /*= AABB2::UNIT_SQUARE_OFFCENTER*/, const AABB2& sideUVs /*= AABB2::UNIT_SQUARE_OFFCENTER*/, const AABB2& bottomUVs /*= AABB2::UNIT_SQUARE_OFFCENTER*/, Material* material /*= nulltpr*/)
+{
+	MeshBuilder& builder = BeginImmediateDraw(material, PRIMITIVE_TRIANGLES, &VertexLit::LAYOUT);
+	builder.PushCube(center, dimensions, tint, sideUVs, topUVs, bottomUVs);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Draws a wire cube using GLLines
+//
+void Renderer::DrawWireCube(const Vector3& center, const Vector3& dimensions, const Rgba& tint /*= Rgba::WHITE*/, Material* material /*= nullptr*/)
+{
+	Vector3 halfDimensions = dimensions * 0.5f;
+	Vector3 mins = center - halfDimensions;
+	Vector3 maxs = center + halfDimensions;
+
+	MeshBuilder& builder = BeginImmediateDraw(material, PRIMITIVE_LINES, &Vertex3D_PCU::LAYOUT);
+
+	builder.PushLine(Vector3(mins.x, mins.y, mins.z), Vector3(maxs.x, mins.y, mins.z), tint);
+	builder.PushLine(Vector3(maxs.x, mins.y, mins.z), Vector3(maxs.x, maxs.y, mins.z), tint);
+	builder.PushLine(Vector3(maxs.x, maxs.y, mins.z), Vector3(mins.x, maxs.y, mins.z), tint);
+	builder.PushLine(Vector3(mins.x, maxs.y, mins.z), Vector3(mins.x, mins.y, mins.z), tint);
+
+	builder.PushLine(Vector3(mins.x, mins.y, maxs.z), Vector3(maxs.x, mins.y, maxs.z), tint);
+	builder.PushLine(Vector3(maxs.x, mins.y, maxs.z), Vector3(maxs.x, maxs.y, maxs.z), tint);
+	builder.PushLine(Vector3(maxs.x, maxs.y, maxs.z), Vector3(mins.x, maxs.y, maxs.z), tint);
+	builder.PushLine(Vector3(mins.x, maxs.y, maxs.z), Vector3(mins.x, mins.y, maxs.z), tint);
+
+	builder.PushLine(Vector3(mins.x, mins.y, mins.z), Vector3(mins.x, mins.y, maxs.z), tint);
+	builder.PushLine(Vector3(maxs.x, mins.y, mins.z), Vector3(maxs.x, mins.y, maxs.z), tint);
+	builder.PushLine(Vector3(maxs.x, maxs.y, mins.z), Vector3(maxs.x, maxs.y, maxs.z), tint);
+	builder.PushLine(Vector3(mins.x, maxs.y, mins.z), Vector3(mins.x, maxs.y, maxs.z), tint);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Draws a sphere with the given parameters
+//
+void Renderer::DrawSphere(const Vector3& position, float radius, unsigned int numWedges, unsigned int numSlices, const Rgba& color /*= Rgba::WHITE*/, Material* material /*= nulltpr*/)
+{
+	MeshBuilder& builder = BeginImmediateDraw(material, PRIMITIVE_TRIANGLES, &VertexLit::LAYOUT);
+	builder.PushUVSphere(position, radius, numWedges, numSlices, color);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Draws the given sprite at the position with tint
+//
+void Renderer::DrawSprite(const Sprite* sprite, const Vector3& position, const Rgba& tint /*= Rgba::WHITE*/, const Vector3& right /*= Vector3::DIRECTION_RIGHT*/, const Vector3& up /*= Vector3::DIRECTION_UP*/)
+{
+	UNUSED(sprite)
+	UNUSED(position)
+	UNUSED(tint)
+	UNUSED(right)
+	UNUSED(up)
+
+	UNIMPLEMENTED();
+// 	BindTexture(0, sprite->GetTexture().GetHandle());
+// 	Vector2 spriteDimensions	= sprite->GetDimensions();
+// 	Vector2 spritePivot			= sprite->GetPivot();
+// 	AABB2 spriteUVs				= sprite->GetUVs();
+// 
+// 	// Find the min and max X values for the sprite AABB2 draw bounds
+// 	float minX = -1.0f * (spritePivot.x * spriteDimensions.x);
+// 	float maxX = minX + spriteDimensions.x;
+// 
+// 	// Find the min and max X values for the sprite AABB2 draw bounds
+// 	float minY = -1.0f * (spritePivot.y * spriteDimensions.y);
+// 	float maxY = minY + spriteDimensions.y;
+// 
+// 	Vector3 bottomLeft 		= position + minX * right + minY * up;
+// 	Vector3 bottomRight 	= position + maxX * right + minY * up;
+// 	Vector3 topLeft 		= position + minX * right + maxY * up;
+// 	Vector3 topRight 		= position + maxX * right + maxY * up;
 // 
 // 	// Make the Vertex3D_PCU's (no indices)
 // 
@@ -582,95 +962,108 @@ void Renderer::DrawSprite(const Sprite* sprite, const Vector3& position, const R
 }
 
 
-//-----------------------------------------------------------------------------------------------
-// Draws text to the screen as a textured AABB2
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Mixes the value's hash into the running hash
 //
-void Renderer::DrawText2D(const std::string& text, const Vector2& drawMins, float cellHeight, BitmapFont* font, Rgba color/*=Rgba::WHITE*/, float aspectScale/*=1.0f*/)
-{	
-	ASSERT_OR_DIE(font != nullptr, Stringf("Error -  Renderer::DrawText2D was passed a null font."));
-
-	// Check if there's anything to draw, if not then return
-	if (text.size() == 0 || text.find_first_not_of(' ') == std::string::npos)
-	{
-		return;
-	}
-
-	// Build a mesh for the text
-	m_immediateBuilder.Clear();
-	m_immediateBuilder.BeginBuilding(PRIMITIVE_TRIANGLES, true);
+template <typename T>
+static void HashCombine(size_t& inout_hash, const T& value)
+{
+	inout_hash ^= std::hash<T>()(value) + 0x9e3779b9 + (inout_hash << 6) + (inout_hash >> 2);
+}
 
-	// Break the text up by the new line characters
-	std::vector<std::string> textLines = Tokenize(text, '\n');
 
-	for (int lineNumber = 0; lineNumber < static_cast<int>(textLines.size()); lineNumber++)
-	{
-		Vector2 glyphBottomLeft = Vector2(drawMins.x, (drawMins.y - lineNumber * cellHeight));
-		std::string currLine = textLines[lineNumber];
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the hash of everything that changes where a text box's glyphs go
+//
+static size_t HashTextLayoutKey(const std::string& text, const AABB2& box, const Vector2& alignment, float cellHeight, TextDrawMode drawMode, const BitmapFont* font, float aspectScale)
+{
+	size_t hash = std::hash<std::string>()(text);
 
-		// Append each letter of the current line to the text "mesh"
-		for (int charIndex = 0; charIndex < static_cast<int>(currLine.length()); charIndex++)
-		{
-			char currentChar = currLine[charIndex];			
-			float glyphWidth = (font->GetGlyphAspect() * cellHeight) * aspectScale;
+	HashCombine(hash, box.mins.x);
+	HashCombine(hash, box.mins.y);
+	HashCombine(hash, box.maxs.x);
+	HashCombine(hash, box.maxs.y);
+	HashCombine(hash, alignment.x);
+	HashCombine(hash, alignment.y);
+	HashCombine(hash, cellHeight);
+	HashCombine(hash, (int) drawMode);
+	HashCombine(hash, font);
+	HashCombine(hash, aspectScale);
 
-			// Don't draw spaces!
-			if (currentChar == ' ') 
-			{ 
-				glyphBottomLeft += Vector2(glyphWidth, 0.f);
-				continue; 
-			}
+	return hash;
+}
 
-			Vector2 glyphTopRight = glyphBottomLeft + Vector2(glyphWidth, cellHeight);
 
-			AABB2 drawBounds = AABB2(glyphBottomLeft, glyphTopRight);
-			AABB2 glyphUVs = font->GetGlyphUVs(currentChar);
-			m_immediateBuilder.Push2DQuad(drawBounds, glyphUVs, color);
+//-----------------------------------------------------------------------------------------------
+// Returns true if the layout was made from exactly these inputs
+//
+bool TextLayout_t::Matches(const std::string& _text, const AABB2& _box, const Vector2& _alignment, float _cellHeight, TextDrawMode _drawMode, const BitmapFont* _font, float _aspectScale) const
+{
+	return (font == _font && drawMode == _drawMode && cellHeight == _cellHeight && aspectScale == _aspectScale
+		&& box.mins == _box.mins && box.maxs == _box.maxs && alignment == _alignment && text == _text);
+}
 
-			// Increment the next bottom left position
-			glyphBottomLeft += Vector2(glyphWidth, 0.f);
-		}
-	} 
 
-	// Construct the Mesh
-	m_immediateBuilder.FinishBuilding();
-	m_immediateBuilder.UpdateMesh(m_immediateMesh);
+//-----------------------------------------------------------------------------------------------
+// Draws text to the screen as a textured AABB2
+//
+void Renderer::DrawText2D(const std::string& text, const Vector2& drawMins, float cellHeight, BitmapFont* font, Rgba color/*=Rgba::WHITE*/, float aspectScale/*=1.0f*/)
+{	
+	ASSERT_OR_DIE(font != nullptr, Stringf("Error -  Renderer::DrawText2D was passed a null font."));
 
-	// Set the texture and draw
-	Material fontMat = Material();
-	fontMat.SetDiffuse(&font->GetSpriteSheet().GetTexture());
-	fontMat.SetShader(AssetDB::CreateOrGetShader("UI"));
+	m_text2DGlyphs.clear();
+	LayoutText2D(text, drawMins, cellHeight, font, aspectScale, m_text2DGlyphs);
 
-	DrawMeshWithMaterial(&m_immediateMesh, &fontMat);
+	PushTextGlyphs(font, m_text2DGlyphs, color);
 }
 
 
 //-----------------------------------------------------------------------------------------------
 // Draws the given text in the box using the alignment and draw mode settings
+// The glyphs are laid out once and re-used on the following frames while the inputs stay the same;
+// color isn't part of the layout, so fading text doesn't lay it out again
 //
 void Renderer::DrawTextInBox2D(const std::string& text, const AABB2& drawBox, const Vector2& alignment, float cellHeight, TextDrawMode drawMode, BitmapFont* font, Rgba color/*=Rgba::WHITE*/, float aspectScale/*=1.0f*/)
 {
-	switch (drawMode)
+	ASSERT_OR_DIE(font != nullptr, Stringf("Error -  Renderer::DrawTextInBox2D was passed a null font."));
+
+	size_t layoutKey = HashTextLayoutKey(text, drawBox, alignment, cellHeight, drawMode, font, aspectScale);
+
+	// On a hash collision the older layout is replaced
+	TextLayout_t& layout = m_textLayouts[layoutKey];
+
+	if (!layout.Matches(text, drawBox, alignment, cellHeight, drawMode, font, aspectScale))
 	{
-	case TEXT_DRAW_SHRINK_TO_FIT:	{ DrawTextInBox2D_ShrinkToFit(text, drawBox, alignment, cellHeight, font, color, aspectScale); } break;
-	case TEXT_DRAW_OVERRUN:			{ DrawTextInBox2D_Overrun(text, drawBox, alignment, cellHeight, font, color, aspectScale); } break;
-	case TEXT_DRAW_WORD_WRAP:		{ DrawTextInBox2D_WordWrap(text, drawBox, alignment, cellHeight, font, color, aspectScale); } break;
-	default:
-		break;
+		layout.text			= text;
+		layout.box			= drawBox;
+		layout.alignment	= alignment;
+		layout.cellHeight	= cellHeight;
+		layout.drawMode		= drawMode;
+		layout.font			= font;
+		layout.aspectScale	= aspectScale;
+		layout.glyphs.clear();
+
+		switch (drawMode)
+		{
+		case TEXT_DRAW_SHRINK_TO_FIT:	{ LayoutTextInBox2D_ShrinkToFit(text, drawBox, alignment, cellHeight, font, aspectScale, layout.glyphs); } break;
+		case TEXT_DRAW_OVERRUN:			{ LayoutTextInBox2D_Overrun(text, drawBox, alignment, cellHeight, font, aspectScale, layout.glyphs); } break;
+		case TEXT_DRAW_WORD_WRAP:		{ LayoutTextInBox2D_WordWrap(text, drawBox, alignment, cellHeight, font, aspectScale, layout.glyphs); } break;
+		default:
+			break;
+		}
 	}
+
+	layout.lastUsedFrame = m_frameNumber;
+	PushTextGlyphs(font, layout.glyphs, color);
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Fetches the final back buffer state of the GPU and write to file
+// Writes the read back frame to file, on the worker the GPUReadbackQueue hands it to
 //
-void SaveScreenshotToFile(void* args)
+void SaveScreenshotToFile(const unsigned char* texels, const IntVector2& dimensions, void* userData)
 {
-	//-----Write the data to file-----
-	
-	char* buffer = *(char**)args;
-
-	char** secondArg = ((char**)(args)) + 1;
-	IntVector2 dimensions = *(IntVector2*)secondArg;
+	UNUSED(userData);
 
 	// Check to see if the directory exists (will make it if it doesn't exist, do nothing otherwise)
 	CreateDirectoryA("Data/Screenshots", NULL);
@@ -680,15 +1073,11 @@ void SaveScreenshotToFile(void* args)
 
 	// Write the image to file (image will be upsidedown, so flip on write)
 	stbi_flip_vertically_on_write(1);
-	stbi_write_png(tempName.c_str(), dimensions.x, dimensions.y, 4, buffer, 0);
+	stbi_write_png(tempName.c_str(), dimensions.x, dimensions.y, 4, texels, 0);
 	
 	// Write with date and time to archive
 	std::string archivedName = Stringf("Data/Screenshots/Screenshot_%s.png", GetFormattedSystemDateAndTime().c_str());
-	stbi_write_png(archivedName.c_str(), dimensions.x, dimensions.y, 4, buffer, 0);
-
-	// Clean up when we're done;
-	free(buffer);
-	free(args);
+	stbi_write_png(archivedName.c_str(), dimensions.x, dimensions.y, 4, texels, 0);
 
 	ConsolePrintf(Rgba::GREEN, "Screenshot written to %s and %s", tempName.c_str(), archivedName.c_str());
 }
@@ -699,11 +1088,25 @@ void SaveScreenshotToFile(void* args)
 //
 void Renderer::SetCurrentCamera(Camera* camera)
 {
+	// Batched draws go to the camera they were made under
+	FlushImmediateDraws();
+
 	// passing in nullptr resets the current camera to the default one
 	if (camera == nullptr) {
 		camera = m_defaultCamera; 
 	}
 
+	// Cameras on the scene targets draw to the scaled region of them
+	FrameBuffer& frameBuffer = camera->m_frameBuffer;
+	bool drawsScene = (m_isDynamicResolutionEnabled && (frameBuffer.m_colorTarget == m_sceneColorTarget || frameBuffer.m_depthTarget == m_sceneDepthTarget));
+	frameBuffer.SetResolutionScale(drawsScene ? m_dynamicResolution.GetScale() : 1.0f);
+
+	// Anything drawing over the default color target at native resolution draws over the upscaled scene
+	if (m_isDynamicResolutionEnabled && !m_isSceneResolved && frameBuffer.m_colorTarget == m_defaultColorTarget)
+	{
+		ResolveScene();
+	}
+
 	camera->FinalizeFrameBuffer(); // make sure the framebuffer is finished being setup; 
 
 	// Update the uniform block for the camera
@@ -725,6 +1128,30 @@ void Renderer::SetRendererGameClock(Clock* gameClock)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Sets the scheduler the game's simulation steps on, whose interpolation alpha is given to shaders
+//
+void Renderer::SetRendererFixedStep(const FixedStepScheduler* scheduler)
+{
+	m_fixedStepScheduler = scheduler;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the interpolation alpha of the fixed step scheduler, for blending states on the CPU
+// Returns 1 (the latest state) if there's no scheduler set
+//
+float Renderer::GetFixedStepAlpha() const
+{
+	if (m_fixedStepScheduler == nullptr)
+	{
+		return 1.f;
+	}
+
+	return m_fixedStepScheduler->GetInterpolationAlpha();
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Adjust the intensity of the ambient 
 //
@@ -869,6 +1296,69 @@ void Renderer::EnableLightsForDrawCall(const DrawCall* drawCall)
 			}
 		}
 	}
+
+	// The clustered lights share one shadow texture
+	Light* clusterShadowLight = m_boundLightClusters->GetShadowCastingLight();
+	if (clusterShadowLight != nullptr)
+	{
+		BindTexture(SHADOW_TEXTURE_BINDING, clusterShadowLight->GetShadowTexture(), m_shadowSampler);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Uploads the built light clusters, used by the lit shaders for all following draws
+// The grid isn't owned, and must stay alive until the clusters are cleared or replaced
+// Passing nullptr binds an empty grid, the same as ClearLightClusters()
+//
+void Renderer::BindLightClusters(LightClusterGrid* lightClusters)
+{
+	FlushImmediateDraws();
+
+	if (lightClusters == nullptr)
+	{
+		lightClusters = &m_lightClusterGrid;
+	}
+
+	m_boundLightClusters = lightClusters;
+	m_boundLightClusters->UploadAndBind();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes all clustered lights, so following draws are only lit by the ambience
+//
+void Renderer::ClearLightClusters()
+{
+	BindLightClusters(nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Uploads the volume's probes if needed, sampled by the lit shaders for all following draws
+// The volume isn't owned, and must stay alive until it's cleared or replaced; the render origin
+// is the one the draws are built relative to
+// Passing nullptr binds an empty volume, the same as ClearLightProbeVolume()
+//
+void Renderer::BindLightProbeVolume(LightProbeVolume* volume, const Vector3& renderOrigin)
+{
+	FlushImmediateDraws();
+
+	if (volume == nullptr)
+	{
+		volume = &m_emptyLightProbeVolume;
+	}
+
+	volume->UploadAndBind(renderOrigin);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes the light probes, so following draws get no baked lighting
+//
+void Renderer::ClearLightProbeVolume()
+{
+	BindLightProbeVolume(nullptr, Vector3::ZERO);
 }
 
 
@@ -903,13 +1393,11 @@ void Renderer::BindTexture(unsigned int bindSlot, const std::string& filename)
 //
 void Renderer::BindTexture(unsigned int bindSlot, const Texture* texture, const Sampler* sampler /*= nullptr*/)
 {
-	glActiveTexture(GL_TEXTURE0 + bindSlot);
-
 	// Get the texture target type
 	TextureType type = texture->GetTextureType();
 	GLenum glType = ToGLType(type);
 
-	glBindTexture(glType, texture->GetHandle());
+	GLStateCache::BindTexture(bindSlot, glType, texture->GetHandle());
 
 	// nullptr defaults the sampler to the default one on the renderer
 	if (sampler == nullptr)
@@ -917,25 +1405,48 @@ void Renderer::BindTexture(unsigned int bindSlot, const Texture* texture, const
 		sampler = m_defaultSampler;
 	}
 
-	glBindSampler(bindSlot, sampler->GetHandle());
+	GLStateCache::BindSampler(bindSlot, sampler->GetHandle());
 }
 
 
 //-----------------------------------------------------------------------------------------------
 // Binds the material state to the renderer
 //
-void Renderer::BindMaterial(Material* material)
+void Renderer::BindMaterial(Material* material, const ShaderProgram* program /*= nullptr*/)
 {
-	glUseProgram(material->GetShader()->GetProgram()->GetHandle());
+	if (program == nullptr)
+	{
+		program = material->GetShader()->GetProgram();
+	}
+
+	GLStateCache::UseProgram(program->GetHandle());
+
+	// Shaders reading their diffuse through the bindless table get its index as a property instead of the bind
+	// Only for the material's own program, the property was resolved against it
+	bool isDiffuseBindless = false;
+	if (program == material->GetShader()->GetProgram())
+	{
+		isDiffuseBindless = material->UpdateBindlessDiffuse(m_bindlessTextures);
+	}
+
+	if (isDiffuseBindless)
+	{
+		m_bindlessTextures.Bind();
+	}
 
 	// Bind all the textures/samplers
 	for (int textureIndex = 0; textureIndex < MAX_TEXTURES_SAMPLERS; ++textureIndex)
 	{
 		const Texture* texture = material->GetTexture(textureIndex);
 
-		if (texture != nullptr)
+		if (isDiffuseBindless && textureIndex == 0)
 		{
-			const Sampler* sampler = material->GetSampler(textureIndex);
+			continue;
+		}
+
+		if (texture != nullptr)
+		{
+			const Sampler* sampler = material->GetSampler(textureIndex);
 			BindTexture(textureIndex, texture, sampler);
 		}
 	}
@@ -946,12 +1457,17 @@ void Renderer::BindMaterial(Material* material)
 	for (int blockIndex = 0; blockIndex < numBlocks; ++blockIndex)
 	{
 		MaterialPropertyBlock* block = material->GetPropertyBlock(blockIndex);
+		unsigned int binding = block->GetDescription()->GetBlockBinding();
 
-		// Since we're in a draw, ensure the GPU data is up-to-date
-		block->CheckAndUpdateGPUData();
+		// Blocks made for a previous shader the current one doesn't read aren't worth uploading
+		if (!program->UsesBlockBinding(binding))
+		{
+			continue;
+		}
 
-		unsigned int binding = block->GetDescription()->GetBlockBinding();
-		BindUniformBuffer(binding, block->GetHandle());
+		// Blocks go into this frame's arena the first time they're bound, or again once they change
+		size_t arenaOffset = block->WriteToUniformArena();
+		UniformArena::BindRange(binding, arenaOffset, block->GetByteSize());
 	}
 }
 
@@ -961,7 +1477,7 @@ void Renderer::BindMaterial(Material* material)
 //
 void Renderer::BindUniformBuffer(unsigned int bindSlot, unsigned int bufferHandle) const
 {
-	glBindBufferBase(GL_UNIFORM_BUFFER, bindSlot, bufferHandle);
+	GLStateCache::BindUniformBuffer(bindSlot, bufferHandle);
 	GL_CHECK_ERROR();
 }
 
@@ -971,27 +1487,36 @@ void Renderer::BindUniformBuffer(unsigned int bindSlot, unsigned int bufferHandl
 //
 void Renderer::BindMeshToProgram(const ShaderProgram* program, const Mesh* mesh) const
 {
-	glUseProgram(program->GetHandle());
+	ASSERT_OR_DIE(!mesh->IsStoredInArena(), "Error: Renderer::BindMeshToProgram() called with a mesh stored in an arena, which has no buffers of its own");
+	BindVertexLayoutToProgram(program, mesh->GetVertexLayout(), mesh->GetVertexBuffer()->GetHandle(), mesh->GetIndexBuffer()->GetHandle());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Binds the vertex and index buffers to the current VAO, with the layout's attributes set up for
+// the program
+//
+void Renderer::BindVertexLayoutToProgram(const ShaderProgram* program, const VertexLayout* vertexLayout, unsigned int vertexBufferHandle, unsigned int indexBufferHandle) const
+{
+	GLStateCache::UseProgram(program->GetHandle());
 	GL_CHECK_ERROR();
 
 	// First bind the mesh information, vertices and indices
-	glBindBuffer(GL_ARRAY_BUFFER, mesh->GetVertexBuffer()->GetHandle());
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->GetIndexBuffer()->GetHandle());
+	glBindBuffer(GL_ARRAY_BUFFER, vertexBufferHandle);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBufferHandle);
 	GL_CHECK_ERROR();
 
-	const VertexLayout* vertexLayout = mesh->GetVertexLayout();
 	unsigned int vertexStride = vertexLayout->GetStride();
 
 	// Passing the data to the program
-	GLuint programHandle = program->GetHandle();
 	unsigned int numAttributes = vertexLayout->GetAttributeCount();
 
 	for (unsigned int attribIndex = 0; attribIndex < numAttributes; ++attribIndex)
 	{
 		const VertexAttribute& attribute = vertexLayout->GetAttribute(attribIndex);
 
-		// Try to find the attribute on the shader by its name
-		int bind = glGetAttribLocation(programHandle, attribute.m_name.c_str());
+		// Try to find the attribute in the program's reflected attributes by its name
+		int bind = program->GetAttributeLocation(attribute.m_name);
 
 		// If the attribute exists on the shader, then bind the data to it
 		if (bind >= 0)
@@ -999,8 +1524,8 @@ void Renderer::BindMeshToProgram(const ShaderProgram* program, const Mesh* mesh)
 			glEnableVertexAttribArray(bind);
 			GL_CHECK_ERROR();
 
-			// If we're using an int type, use glVertexAttrib-"I"-pointer, else just use glVertexAttribPointer
-			if (attribute.m_dataType == RDT_UNSIGNED_INT)  
+			// If we're using an int type the shader reads as ints, use glVertexAttrib-"I"-pointer, else just use glVertexAttribPointer
+			if (!attribute.m_isNormalized && !IsFloatingPointType(attribute.m_dataType))
 			{
 				glVertexAttribIPointer(bind,				// Where the bind point is at
 					attribute.m_elementCount,				// Number of components in this data type
@@ -1031,42 +1556,43 @@ void Renderer::BindMeshToProgram(const ShaderProgram* program, const Mesh* mesh)
 //
 void Renderer::BindRenderState(const RenderState& state) const
 {
+	// State matching what's already bound is skipped by the state cache
+
 	//-----Cull Mode-----
  	switch (state.m_cullMode)
  	{
  	case CULL_MODE_NONE:
- 		glDisable(GL_CULL_FACE);
+ 		GLStateCache::SetCullMode(false, GL_BACK);
  		break;
  	case CULL_MODE_BACK:
- 		glEnable(GL_CULL_FACE);
- 		glCullFace(GL_BACK);
+ 		GLStateCache::SetCullMode(true, GL_BACK);
  		break;
  	case CULL_MODE_FRONT:
- 		glEnable(GL_CULL_FACE);
- 		glCullFace(GL_FRONT);
+ 		GLStateCache::SetCullMode(true, GL_FRONT);
  		break;
  	default:
  		break;
  	}
 
 	// Fill Mode
-	glPolygonMode(GL_FRONT_AND_BACK, ToGLType(state.m_fillMode));
+	GLStateCache::SetPolygonMode(ToGLType(state.m_fillMode));
 	GL_CHECK_ERROR();
 
 	// Winding Order
-	glFrontFace(ToGLType(state.m_windOrder));
+	GLStateCache::SetFrontFace(ToGLType(state.m_windOrder));
 	GL_CHECK_ERROR();
 
 	// Blending
-	glEnable(GL_BLEND);
-	glBlendEquationSeparate(ToGLType(state.m_colorBlendOp), ToGLType(state.m_alphaBlendOp));
-	glBlendFuncSeparate(ToGLType(state.m_colorSrcFactor), ToGLType(state.m_colorDstFactor), ToGLType(state.m_alphaSrcFactor), ToGLType(state.m_alphaDstFactor));
+	GLStateCache::SetBlendState(ToGLType(state.m_colorBlendOp), ToGLType(state.m_alphaBlendOp), ToGLType(state.m_colorSrcFactor), ToGLType(state.m_colorDstFactor), ToGLType(state.m_alphaSrcFactor), ToGLType(state.m_alphaDstFactor));
 	GL_CHECK_ERROR();
 
 	// Depth
-	glEnable(GL_DEPTH_TEST);
-	glDepthFunc(ToGLType(state.m_depthTest));
-	glDepthMask(state.m_shouldWriteDepth ? GL_TRUE : GL_FALSE);
+	GLStateCache::SetDepthState(ToGLType(state.m_depthTest), state.m_shouldWriteDepth);
+	GLStateCache::SetDepthBias(state.m_depthBiasSlope, state.m_depthBiasConstant);
+	GL_CHECK_ERROR();
+
+	// Color
+	GLStateCache::SetColorMask(state.m_shouldWriteColor);
 	GL_CHECK_ERROR();
 }
 
@@ -1076,6 +1602,7 @@ void Renderer::BindRenderState(const RenderState& state) const
 //
 void Renderer::SetGLLineWidth(float lineWidth)
 {
+	FlushImmediateDraws();
 	glLineWidth(lineWidth);
 }
 
@@ -1085,7 +1612,24 @@ void Renderer::SetGLLineWidth(float lineWidth)
 //
 void Renderer::BindModelMatrix(const Matrix44& model)
 {
-	m_modelUniformBuffer.SetCPUAndGPUData(sizeof(model), &model);
+	size_t arenaOffset = UniformArena::Write(&model, sizeof(model));
+	UniformArena::BindRange(MODEL_BUFFER_BINDING, arenaOffset, sizeof(model));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Binds the data the built-in shaders decode the mesh's vertices with
+// Most meshes aren't encoded and share the identity data, so it's only uploaded when it changes
+//
+void Renderer::BindMeshDecodeData(const Mesh* mesh)
+{
+	MeshDecodeData_t data = mesh->GetDecodeData();
+
+	if (memcmp(&data, &m_boundMeshDecodeData, sizeof(data)) != 0)
+	{
+		m_meshUniformBuffer.SetCPUAndGPUData(sizeof(data), &data);
+		m_boundMeshDecodeData = data;
+	}
 }
 
 
@@ -1094,17 +1638,137 @@ void Renderer::BindModelMatrix(const Matrix44& model)
 //
 void Renderer::BindVAO(unsigned int vaoHandle)
 {
-	glBindVertexArray(vaoHandle);
+	GLStateCache::BindVertexArray(vaoHandle);
+	GL_CHECK_ERROR();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Binds the buffer of matrices to the current VAO as the program's per instance model matrix
+// Returns false if the program doesn't have an INSTANCE_MODEL_MATRIX attribute
+//
+bool Renderer::BindInstanceMatricesToProgram(const ShaderProgram* program, unsigned int instanceBufferHandle) const
+{
+	glBindBuffer(GL_ARRAY_BUFFER, instanceBufferHandle);
+
+	// Bind the model matrix to the program as a vertex attribute
+	int bind = program->GetAttributeLocation("INSTANCE_MODEL_MATRIX");
+
+	if (bind < 0)
+	{
+		return false;
+	}
+
+	// Bind the data to it as 4 separate vector4's (OpenGL doesn't support larger object bindings)
+	for (int offset = 0; offset < 4; offset++)
+	{
+		glEnableVertexAttribArray(bind + offset);
+		GL_CHECK_ERROR();
+
+		glVertexAttribPointer(bind + offset,		// Where the bind point is at, offsetting for each column of the matrix
+			4,										// Number of components in this data type (4 for Vector4)
+			GL_FLOAT,								// glType of this data, which is 4 floats
+			GL_FALSE,								// Don't normalize
+			sizeof(Matrix44),						// Stride by the size of a matrix, since we're doing a column at a time
+			(GLvoid*)(offset * sizeof(Vector4))		// offset into the matrix for this column
+		);
+	}	
+
+	// Make the bindings instanced, so they don't update per vertex
+	for (int offset = 0; offset < 4; offset++)
+	{
+		glVertexAttribDivisor(bind + offset, 1);
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Binds the instance buffer to the program's INSTANCE_BONE_OFFSET attribute, one uint per instance
+// that says where its skinning matrices start in the bound skinning palette
+// Returns false if the program doesn't have one
+//
+bool Renderer::BindInstanceBoneOffsetsToProgram(const ShaderProgram* program, unsigned int instanceBufferHandle) const
+{
+	glBindBuffer(GL_ARRAY_BUFFER, instanceBufferHandle);
+
+	int bind = program->GetAttributeLocation("INSTANCE_BONE_OFFSET");
+
+	if (bind < 0)
+	{
+		return false;
+	}
+
+	glEnableVertexAttribArray(bind);
 	GL_CHECK_ERROR();
+
+	// Integer attribute, so it isn't converted to a float
+	glVertexAttribIPointer(bind, 1, GL_UNSIGNED_INT, sizeof(uint32_t), (GLvoid*) 0);
+	glVertexAttribDivisor(bind, 1);
+
+	return true;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Updates the VAO by binding the mesh data to the program
+// Binds the instance buffer to the program's INSTANCE_CUSTOM_DATA attribute, one vec4 per instance,
+// or with no buffer disables the array so every instance reads white
+// Returns false if the program doesn't have one
+//
+bool Renderer::BindInstanceCustomDataToProgram(const ShaderProgram* program, unsigned int instanceBufferHandle) const
+{
+	int bind = program->GetAttributeLocation("INSTANCE_CUSTOM_DATA");
+
+	if (bind < 0)
+	{
+		return false;
+	}
+
+	if (instanceBufferHandle == NULL)
+	{
+		// The constant value is context state, not the VAO's, so is set again each draw
+		glDisableVertexAttribArray(bind);
+		glVertexAttrib4f(bind, 1.f, 1.f, 1.f, 1.f);
+		GL_CHECK_ERROR();
+
+		return true;
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, instanceBufferHandle);
+	glEnableVertexAttribArray(bind);
+	GL_CHECK_ERROR();
+
+	glVertexAttribPointer(bind, 4, GL_FLOAT, GL_FALSE, sizeof(Vector4), (GLvoid*) 0);
+	glVertexAttribDivisor(bind, 1);
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Updates the VAO by binding the mesh data to the material's program
 //
 void Renderer::UpdateVAO(unsigned int& vaoHandle, Mesh* mesh, Material* material)
 {
 	ASSERT_OR_DIE(mesh != nullptr && material != nullptr, Stringf("Error: Renderer::UpdateVAO() received null parameters."));
+	UpdateVAO(vaoHandle, mesh, material->GetShader());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Updates the VAO by binding the mesh data to the given shader's program, for draws that replace
+// their material's shader
+//
+void Renderer::UpdateVAO(unsigned int& vaoHandle, Mesh* mesh, const Shader* shader)
+{
+	ASSERT_OR_DIE(mesh != nullptr && shader != nullptr, Stringf("Error: Renderer::UpdateVAO() received null parameters."));
+
+	// Draws of meshes stored in an arena use its shared VAOs, so don't need one of their own
+	if (mesh->IsStoredInArena())
+	{
+		return;
+	}
 
 	// If a VAO isn't made yet for whoever called this, make one (lazy instantiation)
 	if (glIsVertexArray(vaoHandle) == GL_FALSE)
@@ -1113,21 +1777,178 @@ void Renderer::UpdateVAO(unsigned int& vaoHandle, Mesh* mesh, Material* material
 		GL_CHECK_ERROR();
 	}
  
-	glBindVertexArray(vaoHandle);
-
-	const Shader* shader = material->GetShader();
+	GLStateCache::BindVertexArray(vaoHandle);
 
 	// Do the binding
 	BindMeshToProgram(shader->GetProgram(), mesh);
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Updates the VAO by binding the mesh data to the depth-only shader, used by depth pre-passes
+//
+void Renderer::UpdateDepthOnlyVAO(unsigned int& vaoHandle, Mesh* mesh)
+{
+	ASSERT_OR_DIE(mesh != nullptr, Stringf("Error: Renderer::UpdateDepthOnlyVAO() received a null mesh."));
+
+	if (mesh->IsStoredInArena())
+	{
+		return;
+	}
+
+	if (glIsVertexArray(vaoHandle) == GL_FALSE)
+	{
+		glGenVertexArrays(1, &vaoHandle);
+		GL_CHECK_ERROR();
+	}
+
+	GLStateCache::BindVertexArray(vaoHandle);
+
+	const Shader* shader = AssetDB::GetShader(ShaderSource::DEPTH_ONLY_NAME);
+	BindMeshToProgram(shader->GetProgram(), mesh);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Updates the VAO by binding the mesh data to the G-buffer shader, used by deferred cameras
+//
+void Renderer::UpdateGBufferVAO(unsigned int& vaoHandle, Mesh* mesh)
+{
+	ASSERT_OR_DIE(mesh != nullptr, Stringf("Error: Renderer::UpdateGBufferVAO() received a null mesh."));
+
+	if (mesh->IsStoredInArena())
+	{
+		return;
+	}
+
+	if (glIsVertexArray(vaoHandle) == GL_FALSE)
+	{
+		glGenVertexArrays(1, &vaoHandle);
+		GL_CHECK_ERROR();
+	}
+
+	GLStateCache::BindVertexArray(vaoHandle);
+
+	const Shader* shader = AssetDB::GetShader(ShaderSource::DEFERRED_GBUFFER_NAME);
+	BindMeshToProgram(shader->GetProgram(), mesh);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Frees the Vertex Array Object on the gpu
 //
 void Renderer::DeleteVAO(unsigned int& vaoHandle) const
 {
 	glDeleteVertexArrays(1, &vaoHandle);
+	GLStateCache::OnVertexArrayDeleted(vaoHandle);
+	GL_CHECK_ERROR();
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the byte offset into the bound index buffer to start an indexed draw from
+//
+static const void* GetIndexOffset(const DrawInstruction& instruction)
+{
+	return reinterpret_cast<const void*>(static_cast<size_t>(instruction.m_startIndex) * sizeof(unsigned int));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the VAO to draw the mesh with the program - the draw's own, or for meshes stored in an
+// arena the arena's VAO for the program, with out_arenaEntry set to the mesh's range in it
+// Returns 0 if a stored mesh has nothing to draw yet
+//
+unsigned int Renderer::GetVAOForMeshDraw(const Mesh* mesh, const ShaderProgram* program, unsigned int drawVAOHandle, MeshArenaEntry_t& out_arenaEntry)
+{
+	out_arenaEntry = MeshArenaEntry_t();
+
+	if (!mesh->IsStoredInArena())
+	{
+		return drawVAOHandle;
+	}
+
+	MeshArena* arena = MeshArena::GetOrCreateArenaForLayout(mesh->GetVertexLayout());
+	if (!arena->GetEntryForMesh(mesh, out_arenaEntry))
+	{
+		return 0;
+	}
+
+	// Whether the program takes the matrices is found again on binding them, so isn't needed here
+	bool takesInstanceMatrices = false;
+
+	return arena->GetVAOForProgram(program, InstanceDataStream::GetBufferHandle(INSTANCE_STREAM_MATRICES), takesInstanceMatrices);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the instances to the InstanceDataStream and points the bound VAO's instance attributes at
+// its buffers, which stay the same so the draw just starts at the returned base instance
+// If the frame's range is full they're uploaded to the renderer's own buffers instead, from 0
+//
+int Renderer::BindInstancesForDraw(const ShaderProgram* program, const Matrix44* matrices, const uint32_t* boneOffsets, const Vector4* customData, int instanceCount)
+{
+	int baseInstance = InstanceDataStream::Write(matrices, boneOffsets, customData, instanceCount);
+
+	GLuint matrixHandle			= InstanceDataStream::GetBufferHandle(INSTANCE_STREAM_MATRICES);
+	GLuint boneOffsetHandle		= InstanceDataStream::GetBufferHandle(INSTANCE_STREAM_BONE_OFFSETS);
+	GLuint customDataHandle		= InstanceDataStream::GetBufferHandle(INSTANCE_STREAM_CUSTOM_DATA);
+
+	if (baseInstance < 0)
+	{
+		m_modelInstanceBuffer.CopyToGPU(sizeof(Matrix44) * instanceCount, matrices);
+		matrixHandle = m_modelInstanceBuffer.GetHandle();
+
+		if (boneOffsets != nullptr)
+		{
+			m_boneOffsetInstanceBuffer.CopyToGPU(sizeof(uint32_t) * instanceCount, boneOffsets);
+			boneOffsetHandle = m_boneOffsetInstanceBuffer.GetHandle();
+		}
+
+		if (customData != nullptr)
+		{
+			m_customDataInstanceBuffer.CopyToGPU(sizeof(Vector4) * instanceCount, customData);
+			customDataHandle = m_customDataInstanceBuffer.GetHandle();
+		}
+
+		baseInstance = 0;
+	}
+
+	bool boundMatrices = BindInstanceMatricesToProgram(program, matrixHandle);
+
+	if (!boundMatrices)
+	{
+		ConsoleWarningf("Warning: Renderer::Draw() attempted instanced draw with a shader that doesn't support instance draws");
+	}
+
+	// Shaders that don't skin from the palette, or take custom data, just don't have the attributes
+	if (boneOffsets != nullptr)
+	{
+		BindInstanceBoneOffsetsToProgram(program, boneOffsetHandle);
+	}
+
+	BindInstanceCustomDataToProgram(program, (customData != nullptr ? customDataHandle : NULL));
+
+	return baseInstance;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Draws the instruction's elements, offset to the mesh's range for meshes stored in an arena
+// Entries of meshes with their own buffers are all zero, so draw from the start of them
+//
+static void DrawInstructionInstanced(const DrawInstruction& instruction, const MeshArenaEntry_t& arenaEntry, int instanceCount, int baseInstance)
+{
+	if (instruction.m_usingIndices)
+	{
+		const void* indexOffset = reinterpret_cast<const void*>(static_cast<size_t>(arenaEntry.firstIndex + instruction.m_startIndex) * sizeof(unsigned int));
+		glDrawElementsInstancedBaseVertexBaseInstance(ToGLType(instruction.m_primType), instruction.m_elementCount, GL_UNSIGNED_INT, indexOffset, instanceCount, (GLint) arenaEntry.baseVertex, (GLuint) baseInstance);
+	}
+	else
+	{
+		glDrawArraysInstancedBaseInstance(ToGLType(instruction.m_primType), instruction.m_startIndex, instruction.m_elementCount, instanceCount, (GLuint) baseInstance);
+	}
+
 	GL_CHECK_ERROR();
 }
 
@@ -1137,10 +1958,24 @@ void Renderer::DeleteVAO(unsigned int& vaoHandle) const
 //
 void Renderer::Draw(const DrawCall& drawCall)
 {
+	FlushImmediateDraws();
+
+	const Mesh* mesh = drawCall.GetMesh();
+	const ShaderProgram* program = drawCall.GetShader()->GetProgram();
+
+	MeshArenaEntry_t arenaEntry;
+	unsigned int vaoHandle = GetVAOForMeshDraw(mesh, program, drawCall.GetVAOHandle(), arenaEntry);
+
+	if (vaoHandle == 0)
+	{
+		return;
+	}
+
 	// Bind all the state
-	BindVAO(drawCall.GetVAOHandle());
-	BindMaterial(drawCall.GetMaterial()); 
-	BindRenderState(drawCall.GetMaterial()->GetShader()->GetRenderState());
+	BindVAO(vaoHandle);
+	BindMaterial(drawCall.GetMaterial(), program);
+	BindRenderState(GetRenderStateForDrawCall(drawCall));
+	BindMeshDecodeData(mesh);
 
 	// Copy light data from draw call
 	SetAmbientLight(drawCall.GetAmbience());
@@ -1150,81 +1985,324 @@ void Renderer::Draw(const DrawCall& drawCall)
 	m_lightUniformBuffer.CheckAndUpdateGPUData();
 
 	// Bind the frame buffer
-	glBindFramebuffer(GL_FRAMEBUFFER, m_currentCamera->GetFrameBufferHandle()); 
+	GLStateCache::BindFramebuffer(m_currentCamera->GetFrameBufferHandle());
 	GL_CHECK_ERROR();
 
-	// MODEL BINDING - If there's more than one model, do instance draws
+	PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_DRAW_CALLS);
+
+	// MODEL BINDING - If there's more than one model, or the bone offsets or custom data are per instance, do instance draws
 	int matrixCount = drawCall.GetModelMatrixCount();
-	if (matrixCount > 1)
+	const uint32_t* boneOffsets = drawCall.GetBoneOffsetBuffer();
+	const Vector4* customData = drawCall.GetCustomDataBuffer();
+	if (matrixCount > 1 || boneOffsets != nullptr || customData != nullptr)
 	{
-		// Buffer the model data
-		m_modelInstanceBuffer.CopyToGPU(sizeof(Matrix44) * matrixCount, drawCall.GetModelMatrixBuffer());
+		int baseInstance = BindInstancesForDraw(program, drawCall.GetModelMatrixBuffer(), boneOffsets, customData, matrixCount);
 
-		glBindBuffer(GL_ARRAY_BUFFER, m_modelInstanceBuffer.GetHandle());
-
-		// Bind the model matrix to the program as a vertex attribute
-		int bind = glGetAttribLocation(drawCall.GetMaterial()->GetShader()->GetProgram()->GetHandle(), "INSTANCE_MODEL_MATRIX");
+		// Instance draw using the instruction
+		DrawInstructionInstanced(mesh->GetDrawInstruction(), arenaEntry, matrixCount, baseInstance);
+	}
+	else
+	{
+		// Just bind the singular model matrix as a uniform buffer
+		BindModelMatrix(drawCall.GetModelMatrix(0)); 
+		BindInstanceCustomDataToProgram(program, NULL);
 
-		// If the attribute exists on the shader, then bind the data to it as 4 separate vector4's (OpenGL doesn't support larger object bindings)
-		if (bind >= 0)
+		// Draw using the instruction
+		DrawInstruction instruction = mesh->GetDrawInstruction();
+		if (mesh->IsStoredInArena())
 		{
-			for (int offset = 0; offset < 4; offset++)
-			{
-				glEnableVertexAttribArray(bind + offset);
-				GL_CHECK_ERROR();
-
-				glVertexAttribPointer(bind + offset,		// Where the bind point is at, offsetting for each column of the matrix
-					4,										// Number of components in this data type (4 for Vector4)
-					GL_FLOAT,								// glType of this data, which is 4 floats
-					GL_FALSE,								// Don't normalize
-					sizeof(Matrix44),						// Stride by the size of a matrix, since we're doing a column at a time
-					(GLvoid*)(offset * sizeof(Vector4))		// offset into the matrix for this column
-				);
-			}	
-
-			// Make the bindings instanced, so they don't update per vertex
-			for (int offset = 0; offset < 4; offset++)
-			{
-				glVertexAttribDivisor(bind + offset, 1);
-			}
+			// Only the model buffer is read, the single instance doesn't matter
+			DrawInstructionInstanced(instruction, arenaEntry, 1, 0);
+		}
+		else if (instruction.m_usingIndices)
+		{
+			// Draw with indices
+			glDrawElements(ToGLType(instruction.m_primType), instruction.m_elementCount, GL_UNSIGNED_INT, GetIndexOffset(instruction));
 		}
 		else
 		{
-			ConsoleWarningf("Warning: Renderer::Draw() attempted instanced draw with a shader that doesn't support instance draws");
+			// Draw without indices
+			glDrawArrays(ToGLType(instruction.m_primType), instruction.m_startIndex, instruction.m_elementCount);
 		}
+		GL_CHECK_ERROR();
+	}
+}
 
-		// Instance draw using the instruction
-		DrawInstruction instruction = drawCall.GetMesh()->GetDrawInstruction();
-		if (instruction.m_usingIndices)
+
+//-----------------------------------------------------------------------------------------------
+// Draws all the draw calls with one multi-draw, reading the meshes from their layout's MeshArena
+// and each draw's matrices as instances
+// Falls back to drawing each draw call separately if any mesh can't go in the arena, or the
+// shader doesn't take instance matrices
+//
+void Renderer::DrawBatch(const DrawCall* drawCalls, int drawCallCount)
+{
+	FlushImmediateDraws();
+
+	const DrawCall& firstDrawCall = drawCalls[0];
+	MeshArena* arena = MeshArena::GetOrCreateArenaForLayout(firstDrawCall.GetMesh()->GetVertexLayout());
+
+	m_batchMatrices.clear();
+	m_batchCommands.clear();
+
+	// The mesh decode data is bound once for the whole batch, so every mesh needs the same
+	MeshDecodeData_t decodeData = firstDrawCall.GetMesh()->GetDecodeData();
+
+	bool canBatch = true;
+	for (int drawIndex = 0; drawIndex < drawCallCount; ++drawIndex)
+	{
+		const DrawCall& drawCall = drawCalls[drawIndex];
+		MeshDecodeData_t drawDecodeData = drawCall.GetMesh()->GetDecodeData();
+
+		MeshArenaEntry_t entry;
+		if (memcmp(&drawDecodeData, &decodeData, sizeof(decodeData)) != 0 || !arena->GetEntryForMesh(drawCall.GetMesh(), entry))
 		{
-			// Draw with indices
-			glDrawElementsInstanced(ToGLType(instruction.m_primType), instruction.m_elementCount, GL_UNSIGNED_INT, 0, matrixCount);
+			canBatch = false;
+			break;
 		}
-		else
+
+		int matrixCount = drawCall.GetModelMatrixCount();
+
+		DrawInstruction instruction = drawCall.GetMesh()->GetDrawInstruction();
+
+		DrawElementsIndirectCommand_t command;
+		command.count = instruction.m_elementCount;
+		command.instanceCount = matrixCount;
+		command.firstIndex = entry.firstIndex + instruction.m_startIndex;
+		command.baseVertex = (int) entry.baseVertex;
+		command.baseInstance = (unsigned int) m_batchMatrices.size();
+
+		m_batchCommands.push_back(command);
+
+		const Matrix44* matrices = drawCall.GetModelMatrixBuffer();
+		m_batchMatrices.insert(m_batchMatrices.end(), matrices, matrices + matrixCount);
+	}
+
+	const ShaderProgram* program = firstDrawCall.GetShader()->GetProgram();
+	bool takesInstanceMatrices = false;
+	GLuint vaoHandle = (canBatch ? arena->GetVAOForProgram(program, InstanceDataStream::GetBufferHandle(INSTANCE_STREAM_MATRICES), takesInstanceMatrices) : NULL);
+
+	// The batch's instances go in the stream together, so every command is offset by the same base
+	int streamBaseInstance = -1;
+	if (vaoHandle != NULL && takesInstanceMatrices)
+	{
+		streamBaseInstance = InstanceDataStream::Write(m_batchMatrices.data(), nullptr, nullptr, (int) m_batchMatrices.size());
+	}
+
+	// Draws that don't fit in the stream fall back to uploading their own
+	if (streamBaseInstance < 0)
+	{
+		for (int drawIndex = 0; drawIndex < drawCallCount; ++drawIndex)
 		{
-			// Draw without indices
-			glDrawArraysInstanced(ToGLType(instruction.m_primType), instruction.m_startIndex, instruction.m_elementCount, matrixCount);
+			Draw(drawCalls[drawIndex]);
 		}
+
+		return;
 	}
-	else
+
+	for (int commandIndex = 0; commandIndex < (int) m_batchCommands.size(); ++commandIndex)
 	{
-		// Just bind the singular model matrix as a uniform buffer
-		BindModelMatrix(drawCall.GetModelMatrix(0)); 
+		m_batchCommands[commandIndex].baseInstance += (unsigned int) streamBaseInstance;
+	}
+
+	m_batchIndirectBuffer.CopyToGPU(sizeof(DrawElementsIndirectCommand_t) * m_batchCommands.size(), m_batchCommands.data());
+
+	// Bind all the state, which is the same for every draw call in the batch
+	// A fallback draw can leave the arena VAO pointing at the renderer's own instance buffer, so point it back
+	BindVAO(vaoHandle);
+	BindInstanceMatricesToProgram(program, InstanceDataStream::GetBufferHandle(INSTANCE_STREAM_MATRICES));
+	BindInstanceCustomDataToProgram(program, NULL);
+	BindMaterial(firstDrawCall.GetMaterial(), program);
+	BindRenderState(GetRenderStateForDrawCall(firstDrawCall));
+	BindMeshDecodeData(firstDrawCall.GetMesh());
+
+	SetAmbientLight(firstDrawCall.GetAmbience());
+	EnableLightsForDrawCall(&firstDrawCall);
+	m_lightUniformBuffer.CheckAndUpdateGPUData();
+
+	GLStateCache::BindFramebuffer(m_currentCamera->GetFrameBufferHandle());
+	GL_CHECK_ERROR();
+
+	PrimitiveType primType = firstDrawCall.GetMesh()->GetDrawInstruction().m_primType;
+
+	// One call to the driver, however many draws it makes
+	PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_DRAW_CALLS);
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_batchIndirectBuffer.GetHandle());
+	glMultiDrawElementsIndirect(ToGLType(primType), GL_UNSIGNED_INT, 0, drawCallCount, 0);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, NULL);
+	GL_CHECK_ERROR();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Draws only the depth of the given draw call, with the depth-only shader and its mesh's depth VAO
+// Always draws instanced, since the depth-only shader only takes instance matrices
+//
+void Renderer::DrawDepthOnly(const DrawCall& drawCall)
+{
+	FlushImmediateDraws();
+
+	if (m_depthOnlyMaterial == nullptr)
+	{
+		m_depthOnlyMaterial = AssetDB::GetSharedMaterial("Depth_Only");
+	}
+
+	const Mesh* mesh = drawCall.GetMesh();
+	const ShaderProgram* program = m_depthOnlyMaterial->GetShader()->GetProgram();
+
+	MeshArenaEntry_t arenaEntry;
+	unsigned int vaoHandle = GetVAOForMeshDraw(mesh, program, drawCall.GetDepthVAOHandle(), arenaEntry);
+
+	if (vaoHandle == 0)
+	{
+		return;
+	}
+
+	BindVAO(vaoHandle);
+	BindMaterial(m_depthOnlyMaterial);
+	BindRenderState(m_depthOnlyMaterial->GetShader()->GetRenderState());
+	BindMeshDecodeData(mesh);
+
+	GLStateCache::BindFramebuffer(m_currentCamera->GetFrameBufferHandle());
+	GL_CHECK_ERROR();
+
+	int matrixCount = drawCall.GetModelMatrixCount();
+	int baseInstance = BindInstancesForDraw(program, drawCall.GetModelMatrixBuffer(), nullptr, nullptr, matrixCount);
+
+	PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_DRAW_CALLS);
+
+	DrawInstructionInstanced(mesh->GetDrawInstruction(), arenaEntry, matrixCount, baseInstance);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Draws the surface of the given draw call into the current camera's G-buffer targets, with the
+// G-buffer shader reading the draw's own material's textures and specular properties
+// Always draws instanced, like DrawDepthOnly()
+//
+void Renderer::DrawGBuffer(const DrawCall& drawCall)
+{
+	FlushImmediateDraws();
+
+	if (m_gBufferMaterial == nullptr)
+	{
+		m_gBufferMaterial = AssetDB::GetSharedMaterial("Deferred_GBuffer");
+	}
+
+	const Mesh* mesh = drawCall.GetMesh();
+	const ShaderProgram* program = m_gBufferMaterial->GetShader()->GetProgram();
+
+	MeshArenaEntry_t arenaEntry;
+	unsigned int vaoHandle = GetVAOForMeshDraw(mesh, program, drawCall.GetGBufferVAOHandle(), arenaEntry);
+
+	if (vaoHandle == 0)
+	{
+		return;
+	}
+
+	BindVAO(vaoHandle);
+	BindMaterial(drawCall.GetMaterial(), program);
+	BindRenderState(GetRenderStateForDrawCall(drawCall));
+	BindMeshDecodeData(mesh);
+
+	GLStateCache::BindFramebuffer(m_currentCamera->GetFrameBufferHandle());
+	GL_CHECK_ERROR();
+
+	int matrixCount = drawCall.GetModelMatrixCount();
+	int baseInstance = BindInstancesForDraw(program, drawCall.GetModelMatrixBuffer(), nullptr, nullptr, matrixCount);
+
+	PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_DRAW_CALLS);
+
+	DrawInstructionInstanced(mesh->GetDrawInstruction(), arenaEntry, matrixCount, baseInstance);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Lights every pixel of the G-buffer that was drawn to with the bound light clusters and the ambience,
+// writing into the current camera's color target with one fullscreen triangle
+// The current camera mustn't have the G-buffer's depth as its depth target, since it's read here
+//
+void Renderer::DrawDeferredLighting(const GBufferTargets_t& gBuffer, const Rgba& ambience)
+{
+	FlushImmediateDraws();
+
+	if (m_deferredLightingMaterial == nullptr)
+	{
+		m_deferredLightingMaterial = AssetDB::GetSharedMaterial("Deferred_Lighting");
+	}
+
+	BindVAO(m_defaultVAO);
+	BindMaterial(m_deferredLightingMaterial);
+	BindRenderState(m_deferredLightingMaterial->GetShader()->GetRenderState());
+
+	BindTexture(0, gBuffer.albedoTarget);
+	BindTexture(1, gBuffer.normalTarget);
+	BindTexture(2, gBuffer.depthTarget);
+
+	// Only the ambience of the light buffer is read, the lights all come from the clusters
+	SetAmbientLight(ambience);
+	m_lightUniformBuffer.CheckAndUpdateGPUData();
+
+	Light* clusterShadowLight = m_boundLightClusters->GetShadowCastingLight();
+	if (clusterShadowLight != nullptr)
+	{
+		BindTexture(SHADOW_TEXTURE_BINDING, clusterShadowLight->GetShadowTexture(), m_shadowSampler);
+	}
+
+	GLStateCache::BindFramebuffer(m_currentCamera->GetFrameBufferHandle());
+	GL_CHECK_ERROR();
+
+	PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_DRAW_CALLS);
+
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	GL_CHECK_ERROR();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Draws the mesh with the single indexed indirect command at the start of the given buffer, with
+// an identity model matrix; for draws whose counts the GPU writes itself, so they never need a
+// read back - whatever the material's shader reads by instance must already be bound
+//
+void Renderer::DrawMeshIndirect(unsigned int vaoHandle, Mesh* mesh, Material* material, unsigned int commandBufferHandle)
+{
+	FlushImmediateDraws();
 
-		// Draw using the instruction
-		DrawInstruction instruction = drawCall.GetMesh()->GetDrawInstruction();
-		if (instruction.m_usingIndices)
-		{
-			// Draw with indices
-			glDrawElements(ToGLType(instruction.m_primType), instruction.m_elementCount, GL_UNSIGNED_INT, 0);
-		}
-		else
-		{
-			// Draw without indices
-			glDrawArrays(ToGLType(instruction.m_primType), instruction.m_startIndex, instruction.m_elementCount);
-		}
-		GL_CHECK_ERROR();
+	BindVAO(vaoHandle);
+	BindMaterial(material);
+	BindRenderState(material->GetShader()->GetRenderState());
+	BindModelMatrix(Matrix44::IDENTITY);
+	BindMeshDecodeData(mesh);
+
+	GLStateCache::BindFramebuffer(m_currentCamera->GetFrameBufferHandle());
+	GL_CHECK_ERROR();
+
+	PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_DRAW_CALLS);
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBufferHandle);
+	glMultiDrawElementsIndirect(ToGLType(mesh->GetDrawInstruction().m_primType), GL_UNSIGNED_INT, 0, 1, 0);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, NULL);
+	GL_CHECK_ERROR();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the render state to draw the draw call with - its shader's, except when its depth was
+// already drawn by a pre-pass, in which case only fragments on the pre-pass depths pass and depth
+// isn't written again
+//
+RenderState Renderer::GetRenderStateForDrawCall(const DrawCall& drawCall) const
+{
+	RenderState state = drawCall.GetShader()->GetRenderState();
+
+	if (drawCall.IsDepthPrepassed())
+	{
+		state.m_depthTest = DEPTH_TEST_LEQUAL;
+		state.m_shouldWriteDepth = false;
 	}
+
+	return state;
 }
 
 
@@ -1244,6 +2322,9 @@ void Renderer::DrawMesh(Mesh* mesh)
 //
 void Renderer::DrawMeshWithMaterial(Mesh* mesh, Material* material)
 {
+	// Before touching the immediate renderable, which the flush draws with
+	FlushImmediateDraws();
+
 	RenderableDraw_t draw;
 	draw.sharedMaterial = material;
 	draw.mesh = mesh;
@@ -1262,12 +2343,30 @@ void Renderer::DrawMeshWithMaterial(Mesh* mesh, Material* material)
 //
 void Renderer::DrawRenderable(Renderable* renderable)
 {
+	FlushImmediateDraws();
+
 	int numDraws = renderable->GetDrawCountPerInstance();
+	int numInstances = renderable->GetInstanceCount();
+
+	if (numInstances == 0)
+	{
+		ConsoleWarningf("Warning: Renderer::DrawRenderable() called on a renderable with no instance matrices.");
+		return;
+	}
+
+	m_drawRenderableMatrices.resize(numInstances);
 
 	for (int drawIndex = 0; drawIndex < numDraws; ++drawIndex)
 	{
+		Matrix44 drawMatrix = renderable->GetDraw(drawIndex).drawMatrix;
+
+		for (int instanceIndex = 0; instanceIndex < numInstances; ++instanceIndex)
+		{
+			m_drawRenderableMatrices[instanceIndex] = renderable->GetInstanceMatrix(instanceIndex) * drawMatrix;
+		}
+
 		DrawCall dc;
-		dc.SetDataFromRenderable(renderable, drawIndex);
+		dc.SetDataFromRenderable(renderable, drawIndex, m_drawRenderableMatrices.data(), numInstances, renderable->GetInstanceBoneOffsets());
 		Draw(dc);
 	}
 }
@@ -1278,7 +2377,9 @@ void Renderer::DrawRenderable(Renderable* renderable)
 //
 void Renderer::ClearDepth(float clearDepth /*= 1.0f*/)
 {
-	glDepthMask(GL_TRUE);
+	FlushImmediateDraws();
+
+	GLStateCache::SetDepthMask(true);
 	glClearDepthf(clearDepth);
 	glClear(GL_DEPTH_BUFFER_BIT);
 }
@@ -1312,60 +2413,112 @@ const Sampler* Renderer::GetDefaultSampler() const
 
 
 //-----------------------------------------------------------------------------------------------
-// Draws the given text in the box in overrun style
+// Appends the glyph quads of the text, its first line's bottom left at drawMins and each line after below it
+//
+void Renderer::LayoutText2D(std::string_view text, const Vector2& drawMins, float cellHeight, const BitmapFont* font, float aspectScale, std::vector<TextLayoutGlyph_t>& out_glyphs) const
+{
+	// Break the text up by the new line characters
+	std::string_view remainingText = text;
+	std::string_view currLine;
+	int lineNumber = 0;
+
+	while (GetNextToken(remainingText, '\n', currLine))
+	{
+		Vector2 glyphBottomLeft = Vector2(drawMins.x, (drawMins.y - lineNumber * cellHeight));
+
+		for (int charIndex = 0; charIndex < static_cast<int>(currLine.length()); charIndex++)
+		{
+			char currentChar = currLine[charIndex];
+			float glyphWidth = (font->GetGlyphAspect(currentChar) * cellHeight) * aspectScale;
+
+			// Don't draw spaces!
+			if (currentChar != ' ')
+			{
+				TextLayoutGlyph_t glyph;
+				glyph.bounds = AABB2(glyphBottomLeft, glyphBottomLeft + Vector2(glyphWidth, cellHeight));
+				glyph.uvs = font->GetGlyphUVs(currentChar);
+
+				out_glyphs.push_back(glyph);
+			}
+
+			// Increment the next bottom left position
+			glyphBottomLeft += Vector2(glyphWidth, 0.f);
+		}
+
+		lineNumber++;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Lays out the given text in the box in overrun style
 //
-void Renderer::DrawTextInBox2D_Overrun(const std::string& text, const AABB2& drawBox, const Vector2& alignment, float cellHeight, BitmapFont* font, Rgba color/*=Rgba::WHITE*/, float aspectScale/*=1.0f*/)
+void Renderer::LayoutTextInBox2D_Overrun(std::string_view text, const AABB2& drawBox, const Vector2& alignment, float cellHeight, const BitmapFont* font, float aspectScale, std::vector<TextLayoutGlyph_t>& out_glyphs) const
 {
+	// Count the lines for padding calculation
+	std::string_view remainingText = text;
+	std::string_view currLine;
+	int lineCount = 0;
+
+	while (GetNextToken(remainingText, '\n', currLine))
+	{
+		lineCount++;
+	}
 
-	// Tokenize and get dimensions for padding calculation
-	std::vector<std::string> textLines = Tokenize(text, '\n');
 	Vector2 boxDimensions = drawBox.GetDimensions();
 
 	// yPadding
-	float totalHeight = cellHeight * static_cast<float>(textLines.size());
+	float totalHeight = cellHeight * static_cast<float>(lineCount);
 	float yPadding = boxDimensions.y - totalHeight;
 
 	// Calculate xPadding per-line
-	for (int lineNumber = 0; lineNumber < static_cast<int>(textLines.size()); lineNumber++)
+	remainingText = text;
+	int lineNumber = 0;
+
+	while (GetNextToken(remainingText, '\n', currLine))
 	{
-		float xPadding = (drawBox.maxs.x - drawBox.mins.x) - (font->GetStringWidth(textLines[lineNumber], cellHeight, aspectScale));
+		float xPadding = (drawBox.maxs.x - drawBox.mins.x) - (font->GetStringWidth(currLine, cellHeight, aspectScale));
 
-		// Set up draw position, compensating for the fact that DrawText2D works on a bottom-left is (0,0) coordinate system, here top-left is (0,0)
+		// Set up draw position, compensating for the fact that LayoutText2D works on a bottom-left is (0,0) coordinate system, here top-left is (0,0)
 		Vector2 drawPosition;
 		drawPosition.x = drawBox.mins.x + (xPadding * alignment.x);
-		drawPosition.y = drawBox.maxs.y - (yPadding * alignment.y) - ((lineNumber + 1) * cellHeight);	// Decrease by cell height once for every line already drawn
+		drawPosition.y = drawBox.maxs.y - (yPadding * alignment.y) - ((lineNumber + 1) * cellHeight);	// Decrease by cell height once for every line already laid out
 
-		// Still draw one line at a time, since we need to recalculate x-alignment per line
-		DrawText2D(textLines[lineNumber], drawPosition, cellHeight, font, color, aspectScale);
+		// Still one line at a time, since we need to recalculate x-alignment per line
+		LayoutText2D(currLine, drawPosition, cellHeight, font, aspectScale, out_glyphs);
+		lineNumber++;
 	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Draws the given text in the box in Shrink-to-fit style
+// Lays out the given text in the box in Shrink-to-fit style
 //
-void Renderer::DrawTextInBox2D_ShrinkToFit(const std::string& text, const AABB2& drawBox, const Vector2& alignment, float cellHeight, BitmapFont* font, Rgba color/*=Rgba::WHITE*/, float aspectScale/*=1.0f*/)
+void Renderer::LayoutTextInBox2D_ShrinkToFit(std::string_view text, const AABB2& drawBox, const Vector2& alignment, float cellHeight, const BitmapFont* font, float aspectScale, std::vector<TextLayoutGlyph_t>& out_glyphs) const
 {
-	std::vector<std::string> textLines = Tokenize(text, '\n');
 	Vector2 boxDimensions = drawBox.GetDimensions();
 
-	// Get the height
-	float totalHeight = cellHeight * static_cast<float>(textLines.size());
-
 	// Get the width - longest line for the smallest xScale
-	int longestLineNumber = -1;
+	std::string_view remainingText = text;
+	std::string_view currLine;
+	int lineCount = 0;
 	float longestLineLength = -1;
-	for (int lineNumber = 0; lineNumber < static_cast<int>(textLines.size()); lineNumber++)
+
+	while (GetNextToken(remainingText, '\n', currLine))
 	{
-		float currentLineLength = font->GetStringWidth(textLines[lineNumber], cellHeight, aspectScale);
+		float currentLineLength = font->GetStringWidth(currLine, cellHeight, aspectScale);
+		longestLineLength = MaxFloat(longestLineLength, currentLineLength);
+		lineCount++;
+	}
 
-		if (longestLineNumber == -1 || currentLineLength > longestLineLength)
-		{
-			longestLineNumber = lineNumber;
-			longestLineLength = currentLineLength;
-		}
+	if (lineCount == 0)
+	{
+		return;
 	}
 
+	// Get the height
+	float totalHeight = cellHeight * static_cast<float>(lineCount);
+
 	// Calculate the final scale - taking the minimum of the necessary x and y scales to fit in the box
 	float xScale = boxDimensions.x / longestLineLength;
 	float yScale = boxDimensions.y / totalHeight;
@@ -1377,18 +2530,18 @@ void Renderer::DrawTextInBox2D_ShrinkToFit(const std::string& text, const AABB2&
 		finalScale = 1.0f;
 	}
 
-	// Adjust the cell height to fit and then draw
+	// Adjust the cell height to fit
 	cellHeight *= finalScale;
 
-	// Draw using overrun, since it takes into consideration per line alignment, and we know we won't go outside box now
-	DrawTextInBox2D_Overrun(text, drawBox, alignment, cellHeight, font, color, aspectScale);
+	// Lay out using overrun, since it takes into consideration per line alignment, and we know we won't go outside box now
+	LayoutTextInBox2D_Overrun(text, drawBox, alignment, cellHeight, font, aspectScale, out_glyphs);
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Draws the given text in the box in word wrap style
+// Lays out the given text in the box in word wrap style
 //
-void Renderer::DrawTextInBox2D_WordWrap(const std::string& text, const AABB2& drawBox, const Vector2& alignment, float cellHeight, BitmapFont* font, Rgba color/*=Rgba::WHITE*/, float aspectScale/*=1.0f*/)
+void Renderer::LayoutTextInBox2D_WordWrap(const std::string& text, const AABB2& drawBox, const Vector2& alignment, float cellHeight, const BitmapFont* font, float aspectScale, std::vector<TextLayoutGlyph_t>& out_glyphs) const
 {
 	//-----State variables-----
 	std::string wordWrappedText;						// The final result string
@@ -1484,8 +2637,52 @@ void Renderer::DrawTextInBox2D_WordWrap(const std::string& text, const AABB2& dr
 		cellHeight *= scale;
 	}
 
-	// Draw all the lines with the correct alignment
-	DrawTextInBox2D_Overrun(wordWrappedText, drawBox, alignment, cellHeight, font, color, aspectScale);
+	// Lay out all the lines with the correct alignment
+	LayoutTextInBox2D_Overrun(wordWrappedText, drawBox, alignment, cellHeight, font, aspectScale, out_glyphs);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Pushes the laid out glyphs into the font's batch in the given color
+//
+void Renderer::PushTextGlyphs(BitmapFont* font, const std::vector<TextLayoutGlyph_t>& glyphs, const Rgba& color)
+{
+	// Check if there's anything to draw, if not then return
+	if (glyphs.size() == 0)
+	{
+		return;
+	}
+
+	// Consecutive text of the same font goes into one batch
+	MeshBuilder& builder = BeginImmediateDraw(GetFontMaterial(font), PRIMITIVE_TRIANGLES, &VertexLit::LAYOUT);
+
+	for (int glyphIndex = 0; glyphIndex < (int) glyphs.size(); ++glyphIndex)
+	{
+		builder.Push2DQuad(glyphs[glyphIndex].bounds, glyphs[glyphIndex].uvs, color);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes the text layouts that haven't been drawn in a while
+//
+void Renderer::EvictUnusedTextLayouts()
+{
+	// Past the limit only keep this frame's, something's drawing text that changes every frame
+	uint64_t maxUnusedFrames = (m_textLayouts.size() > TEXT_LAYOUT_CACHE_MAX_COUNT ? 0 : TEXT_LAYOUT_CACHE_UNUSED_FRAMES);
+
+	std::unordered_map<size_t, TextLayout_t>::iterator itr = m_textLayouts.begin();
+	while (itr != m_textLayouts.end())
+	{
+		if (m_frameNumber - itr->second.lastUsedFrame > maxUnusedFrames)
+		{
+			itr = m_textLayouts.erase(itr);
+		}
+		else
+		{
+			++itr;
+		}
+	}
 }
 
 
@@ -1503,6 +2700,9 @@ void Renderer::PostGLStartup()
 	m_shadowSampler = new Sampler();
 	m_shadowSampler->Initialize(SAMPLER_FILTER_LINEAR, EDGE_SAMPLING_CLAMP_TO_BORDER);
 
+	m_fontSDFSampler = new Sampler();
+	m_fontSDFSampler->Initialize(SAMPLER_FILTER_LINEAR, EDGE_SAMPLING_CLAMP_TO_EDGE);
+
 	// the default color and depth should match our output window
 	// so get width/height however you need to.
 	unsigned int windowWidth	= Window::GetInstance()->GetWidthInPixels(); 
@@ -1514,7 +2714,7 @@ void Renderer::PostGLStartup()
 
 	// Create the immediate renderable and the default VAO
 	glGenVertexArrays(1, &m_defaultVAO); 
-	glBindVertexArray(m_defaultVAO);
+	GLStateCache::BindVertexArray(m_defaultVAO);
 
 	RenderableDraw_t draw;
 	draw.mesh = &m_immediateMesh;
@@ -1533,12 +2733,112 @@ void Renderer::PostGLStartup()
 	// Setup Uniform buffers
 	m_timeUniformBuffer.InitializeCPUBufferForType<TimeBufferData>();
 	m_lightUniformBuffer.InitializeCPUBufferForType<LightBufferData>();
-	m_modelUniformBuffer.SetCPUAndGPUData(sizeof(Matrix44), &Matrix44::IDENTITY);
+	m_meshUniformBuffer.SetCPUAndGPUData(sizeof(MeshDecodeData_t), &m_boundMeshDecodeData);
 
 	// Bind the UniformBuffers to the correct slots
 	BindUniformBuffer(TIME_BUFFER_BINDING, m_timeUniformBuffer.GetHandle());
 	BindUniformBuffer(LIGHT_BUFFER_BINDING, m_lightUniformBuffer.GetHandle());
-	BindUniformBuffer(MODEL_BUFFER_BINDING, m_modelUniformBuffer.GetHandle());
+	BindModelMatrix(Matrix44::IDENTITY);
+	BindUniformBuffer(MESH_BUFFER_BINDING, m_meshUniformBuffer.GetHandle());
+
+	// Drivers differ in their default swap interval
+	SetVSyncMode(m_vsyncMode);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Waits until the GPU has at most m_maxFramesInFlight - 1 frames queued, then on the frame rate cap,
+// then calls the late input sample callback
+//
+void Renderer::WaitForFramePacing()
+{
+	uint64_t waitStartHPC = GetPerformanceCounter();
+
+	// The frame about to be drawn counts as in flight, so the one m_maxFramesInFlight back must be done
+	// Fences signal in order, so any older ones are done too and can go
+	for (int framesBack = m_maxFramesInFlight; framesBack <= RENDERER_MAX_FRAMES_IN_FLIGHT; ++framesBack)
+	{
+		if (m_frameNumber < (uint64_t) framesBack)
+		{
+			break;
+		}
+
+		int fenceIndex = (int) ((m_frameNumber - framesBack) % RENDERER_MAX_FRAMES_IN_FLIGHT);
+		GLsync& fence = m_frameFences[fenceIndex];
+
+		if (fence == nullptr)
+		{
+			continue;
+		}
+
+		if (framesBack == m_maxFramesInFlight)
+		{
+			GLenum waitResult = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+			ASSERT_RECOVERABLE(waitResult != GL_WAIT_FAILED, "Error: Renderer frame fence wait failed");
+		}
+
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+
+	WaitForFrameRateCap();
+
+	m_lastFrameStartHPC = GetPerformanceCounter();
+	m_lastFramePacingWaitSeconds = (float) TimeSystem::PerformanceCountToSeconds(m_lastFrameStartHPC - waitStartHPC);
+
+	if (m_lateInputSampleCallback != nullptr)
+	{
+		m_lateInputSampleCallback(m_lateInputSampleArgs);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Waits until the frame rate cap's interval has passed since the last frame started
+//
+void Renderer::WaitForFrameRateCap()
+{
+	if (m_frameRateCap <= 0.f || m_lastFrameStartHPC == 0)
+	{
+		return;
+	}
+
+	uint64_t targetHPC = m_lastFrameStartHPC + TimeSystem::SecondsToPerformanceCount(1.0 / (double) m_frameRateCap);
+	WaitUntilPerformanceCounter(targetHPC);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Places a fence after the frame's swap, in the ring slot of the frame just ended
+//
+void Renderer::FenceFrameInFlight()
+{
+	int fenceIndex = (int) ((m_frameNumber - 1) % RENDERER_MAX_FRAMES_IN_FLIGHT);
+	GLsync& fence = m_frameFences[fenceIndex];
+
+	// Only left if the frame wasn't waited on, i.e. frames in flight were raised - it's older than the new one anyway
+	if (fence != nullptr)
+	{
+		glDeleteSync(fence);
+	}
+
+	fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes the fences of any frames still in flight
+//
+void Renderer::DeleteFrameFences()
+{
+	for (int fenceIndex = 0; fenceIndex < RENDERER_MAX_FRAMES_IN_FLIGHT; ++fenceIndex)
+	{
+		if (m_frameFences[fenceIndex] != nullptr)
+		{
+			glDeleteSync(m_frameFences[fenceIndex]);
+			m_frameFences[fenceIndex] = nullptr;
+		}
+	}
 }
 
 
@@ -1561,6 +2861,12 @@ void Renderer::UpdateTimeData()
 	timeData->m_systemDeltaTime = master->GetDeltaTime();
 	timeData->m_systemTotalTime = master->GetTotalSeconds();
 
+	if (m_fixedStepScheduler != nullptr)
+	{
+		timeData->m_fixedStepAlpha		= m_fixedStepScheduler->GetInterpolationAlpha();
+		timeData->m_fixedStepSeconds	= (float) m_fixedStepScheduler->GetStepSeconds();
+	}
+
 	// CPU data set, now update the GPU
 	m_timeUniformBuffer.CheckAndUpdateGPUData();
 }
@@ -1568,12 +2874,60 @@ void Renderer::UpdateTimeData()
 
 //-----------------------------------------------------------------------------------------------
 // Draws to the screen given the vertices and the draw primitive type
+// Triangles, lines and points are added to the immediate batch, anything else is drawn on its own
 //
 void Renderer::DrawMeshImmediate(const Vertex3D_PCU* vertices, int vertexCount, PrimitiveType primitiveType /*= PRIMITIVE_TRIANGLES*/, const unsigned int* indices /*= nullptr*/, int indexCount /*= -1*/, Material* material/*= nullptr*/)
 {
+	bool isUsingIndices = indices != nullptr;
+
+	if (primitiveType == PRIMITIVE_TRIANGLES || primitiveType == PRIMITIVE_LINES || primitiveType == PRIMITIVE_POINTS)
+	{
+		MeshBuilder& builder = BeginImmediateDraw(material, primitiveType, &Vertex3D_PCU::LAYOUT);
+		int elementCount = (isUsingIndices ? indexCount : vertexCount);
+
+		// Triangle batches are indexed, so indices are offset to after the batch's vertices
+		if (primitiveType == PRIMITIVE_TRIANGLES)
+		{
+			unsigned int startVertex = (unsigned int) builder.GetVertexCount();
+			builder.ReserveVertices(startVertex + vertexCount);
+			builder.ReserveIndices(builder.GetIndexCount() + elementCount);
+
+			for (int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+			{
+				builder.SetColor(vertices[vertexIndex].m_color);
+				builder.SetUVs(vertices[vertexIndex].m_texUVs);
+				builder.PushVertex(vertices[vertexIndex].m_position);
+			}
+
+			for (int elementIndex = 0; elementIndex < elementCount; ++elementIndex)
+			{
+				unsigned int index = (isUsingIndices ? indices[elementIndex] : (unsigned int) elementIndex);
+				builder.PushIndex(startVertex + index);
+			}
+		}
+		else
+		{
+			// Line and point batches aren't, so indexed vertices are pushed in index order
+			builder.ReserveVertices(builder.GetVertexCount() + elementCount);
+
+			for (int elementIndex = 0; elementIndex < elementCount; ++elementIndex)
+			{
+				const Vertex3D_PCU& vertex = vertices[isUsingIndices ? indices[elementIndex] : elementIndex];
+
+				builder.SetColor(vertex.m_color);
+				builder.SetUVs(vertex.m_texUVs);
+				builder.PushVertex(vertex.m_position);
+			}
+		}
+
+		return;
+	}
+
+	// Keep the draw order with what's already batched
+	FlushImmediateDraws();
+
 	m_immediateMesh.SetVertices(vertexCount, vertices);
 
-	bool isUsingIndices = indices != nullptr;
 	if (isUsingIndices)
 	{
 		m_immediateMesh.SetIndices(indexCount, indices);
@@ -1604,48 +2958,152 @@ void Renderer::DrawMeshImmediate(const Vertex3D_PCU* vertices, int vertexCount,
 //
 void Renderer::DrawPoint(const Vector3& position, const Rgba& color, float radius, Material* material /*= nullptr*/)
 {
-	Vertex3D_PCU vertices[14];
+	MeshBuilder& builder = BeginImmediateDraw(material, PRIMITIVE_LINES, &Vertex3D_PCU::LAYOUT);
+	builder.PushPoint(position, color, radius);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Draws a line from startPos to endPos with the given colors
+// Lines of different widths don't batch together, the width is set when the batch is drawn
+//
+void Renderer::Draw3DLine(const Vector3& startPos, const Rgba& startColor, const Vector3& endPos, const Rgba& endColor, float width/*=1.0f*/, Material* material /*= nullptr*/)
+{
+	MeshBuilder& builder = BeginImmediateDraw(material, PRIMITIVE_LINES, &Vertex3D_PCU::LAYOUT, width);
+
+	builder.SetUVs(Vector2::ZERO);
+
+	builder.SetColor(startColor);
+	builder.PushVertex(startPos);
+
+	builder.SetColor(endColor);
+	builder.PushVertex(endPos);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Draws everything batched by the immediate draw functions, for ordering them against other drawing
+// Called automatically before any other draw and on state changes, so only needed around GL work done outside the Renderer
+//
+void Renderer::FlushImmediateDraws()
+{
+	if (m_immediateBatchMaterial == nullptr)
+	{
+		return;
+	}
+
+	PROFILE_SCOPE_CATEGORY("Renderer::FlushImmediateDraws", "Rendering");
 
-	vertices[0] = Vertex3D_PCU(position - Vector3::X_AXIS * radius, color, Vector2::ZERO);
-	vertices[1] = Vertex3D_PCU(position + Vector3::X_AXIS * radius, color, Vector2::ZERO);
+	// Emptied before drawing, since the draw comes back through here
+	Material* material = m_immediateBatchMaterial;
+	float lineWidth = m_immediateBatchLineWidth;
+	m_immediateBatchMaterial = nullptr;
 
-	vertices[2] = Vertex3D_PCU(position - Vector3::Y_AXIS * radius, color, Vector2::ZERO);
-	vertices[3] = Vertex3D_PCU(position + Vector3::Y_AXIS * radius, color, Vector2::ZERO);
+	m_immediateBuilder.FinishBuilding();
 
-	vertices[4] = Vertex3D_PCU(position - Vector3::Z_AXIS * radius, color, Vector2::ZERO);
-	vertices[5] = Vertex3D_PCU(position + Vector3::Z_AXIS * radius, color, Vector2::ZERO);
+	if (m_immediateBuilder.GetVertexCount() == 0)
+	{
+		m_immediateBuilder.Clear();
+		return;
+	}
 
-	vertices[6] = Vertex3D_PCU(position - Vector3(1.0f, 1.0f, 1.0f) * radius, color, Vector2::ZERO);
-	vertices[7] = Vertex3D_PCU(position + Vector3(1.0f, 1.0f, 1.0f) * radius, color, Vector2::ZERO);
+	if (m_immediateBatchLayout == &Vertex3D_PCU::LAYOUT)
+	{
+		m_immediateBuilder.UpdateMesh<Vertex3D_PCU>(m_immediateMesh);
+	}
+	else
+	{
+		m_immediateBuilder.UpdateMesh<VertexLit>(m_immediateMesh);
+	}
 
-	vertices[8] = Vertex3D_PCU(position - Vector3(-1.0f, 1.0f, 1.0f) * radius, color, Vector2::ZERO);
-	vertices[9] = Vertex3D_PCU(position + Vector3(-1.0f, 1.0f, 1.0f) * radius, color, Vector2::ZERO);
+	m_immediateBuilder.Clear();
 
-	vertices[10] = Vertex3D_PCU(position - Vector3(1.0f, 1.0f, -1.0f) * radius, color, Vector2::ZERO);
-	vertices[11] = Vertex3D_PCU(position + Vector3(1.0f, 1.0f, -1.0f) * radius, color, Vector2::ZERO);
+	if (lineWidth != 1.0f)
+	{
+		SetGLLineWidth(lineWidth);
+	}
 
-	vertices[12] = Vertex3D_PCU(position - Vector3(-1.0f, 1.0f, -1.0f) * radius, color, Vector2::ZERO);
-	vertices[13] = Vertex3D_PCU(position + Vector3(-1.0f, 1.0f, -1.0f) * radius, color, Vector2::ZERO);
+	DrawMeshWithMaterial(&m_immediateMesh, material);
 
-	DrawMeshImmediate(vertices, 14, PRIMITIVE_LINES, nullptr, -1, material);
+	if (lineWidth != 1.0f)
+	{
+		SetGLLineWidth(1.0f);
+	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Draws a line from startPos to endPos with the given colors
+// Returns the immediate builder to push a draw's geometry into, continuing the current batch if
+// it has the same material, primitive, vertex layout and line width, otherwise drawing it and starting a new one
+// Triangles are built indexed, lines and points aren't
 //
-void Renderer::Draw3DLine(const Vector3& startPos, const Rgba& startColor, const Vector3& endPos, const Rgba& endColor, float width/*=1.0f*/, Material* material /*= nullptr*/)
+MeshBuilder& Renderer::BeginImmediateDraw(Material* material, PrimitiveType primitiveType, const VertexLayout* vertexLayout, float lineWidth /*= 1.0f*/)
 {
-	SetGLLineWidth(width);
+	if (material == nullptr)
+	{
+		material = AssetDB::CreateOrGetSharedMaterial("Default_Opaque");
+	}
+
+	bool continuesBatch = (m_immediateBatchMaterial == material) 
+		&& (m_immediateBuilder.GetDrawInstruction().m_primType == primitiveType)
+		&& (m_immediateBatchLayout == vertexLayout) 
+		&& (m_immediateBatchLineWidth == lineWidth);
+
+	if (continuesBatch)
+	{
+		return m_immediateBuilder;
+	}
+
+	FlushImmediateDraws();
+
+	m_immediateBuilder.Clear();
+
+	if (vertexLayout == &Vertex3D_PCU::LAYOUT)
+	{
+		m_immediateBuilder.SetOutputVertexType<Vertex3D_PCU>();
+	}
+	else
+	{
+		ASSERT_OR_DIE(vertexLayout == &VertexLit::LAYOUT, "Error: Renderer::BeginImmediateDraw() called with an unsupported vertex layout");
+		m_immediateBuilder.SetOutputVertexType<VertexLit>();
+	}
 
-	Vertex3D_PCU vertices[2];
+	m_immediateBuilder.BeginBuilding(primitiveType, (primitiveType == PRIMITIVE_TRIANGLES));
 
-	vertices[0] = Vertex3D_PCU(startPos, startColor, Vector2::ZERO);
-	vertices[1] = Vertex3D_PCU(endPos, endColor, Vector2::ZERO);
+	m_immediateBatchMaterial = material;
+	m_immediateBatchLayout = vertexLayout;
+	m_immediateBatchLineWidth = lineWidth;
 
-	DrawMeshImmediate(vertices, 2, PRIMITIVE_LINES, nullptr, -1, material);
+	return m_immediateBuilder;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the UI material for drawing the font's text, making it the first time
+//
+Material* Renderer::GetFontMaterial(BitmapFont* font)
+{
+	std::map<const BitmapFont*, Material*>::iterator itr = m_fontMaterials.find(font);
+	if (itr != m_fontMaterials.end())
+	{
+		return itr->second;
+	}
 
-	SetGLLineWidth(1.0f);
+	Material* fontMaterial = new Material();
+	fontMaterial->SetDiffuse(&font->GetSpriteSheet().GetTexture());
+
+	if (font->IsSignedDistanceField())
+	{
+		fontMaterial->SetShader(AssetDB::CreateOrGetShader(ShaderSource::UI_SDF_SHADER_NAME));
+		fontMaterial->SetSampler(0, m_fontSDFSampler);
+	}
+	else
+	{
+		fontMaterial->SetShader(AssetDB::CreateOrGetShader("UI"));
+	}
+
+	m_fontMaterials[font] = fontMaterial;
+	return fontMaterial;
 }
 
 
@@ -1654,6 +3112,8 @@ void Renderer::Draw3DLine(const Vector3& startPos, const Rgba& startColor, const
 //
 bool Renderer::CopyFrameBuffer( FrameBuffer *destination, FrameBuffer *source )
 {
+	FlushImmediateDraws();
+
 	// we need at least the src.
 	if (source == nullptr) 
 	{
@@ -1701,6 +3161,7 @@ bool Renderer::CopyFrameBuffer( FrameBuffer *destination, FrameBuffer *source )
 	// Cleanup after ourselves
 	glBindFramebuffer( GL_READ_FRAMEBUFFER, NULL ); 
 	glBindFramebuffer( GL_DRAW_FRAMEBUFFER, NULL ); 
+	GLStateCache::InvalidateFramebuffer();
 
 	return GLSucceeded();
 }
@@ -6,6 +6,8 @@
 /* Description: Class used to call OpenGL functions to draw to screen
 /************************************************************************/
 #pragma once
+#include <map>
+#include <unordered_map>
 #include <string>
 #include <vector>
 #include "Engine/Core/Rgba.hpp"
@@ -20,14 +22,22 @@
 #include "Engine/Rendering/Core/Renderable.hpp"
 #include "Engine/Rendering/Meshes/MeshBuilder.hpp"
 #include "Engine/Rendering/Buffers/UniformBuffer.hpp"
+#include "Engine/Rendering/Core/LightClusterGrid.hpp"
+#include "Engine/Rendering/Core/LightProbeVolume.hpp"
+#include "Engine/Rendering/Core/DynamicResolution.hpp"
+#include "Engine/Rendering/Resources/BindlessTextureTable.hpp"
 // Defines
 #define TIME_BUFFER_BINDING (0)		// Updated once per frame
 #define CAMERA_BUFFER_BINDING (1)	// Updated ~once per frame
 #define MODEL_BUFFER_BINDING (2)	// Updated per draw
 #define LIGHT_BUFFER_BINDING (3)	// Updated one per frame
 #define SKINNING_BONE_BINDING (4)
+#define MESH_BUFFER_BINDING (5)		// Updated per draw, only when the mesh's decode data changes
 
-#define SHADOW_TEXTURE_BINDING (5)	// Slot for the shadow texture
+#define SHADOW_TEXTURE_BINDING (8)	// Slot for the shadow texture, matches gShadowDepth in the lit shaders
+
+#define RENDERER_MAX_FRAMES_IN_FLIGHT (3)		// Most frames the CPU may queue ahead of the GPU
+#define RENDERER_DEFAULT_FRAMES_IN_FLIGHT (2)
 
 // Class Predeclarations
 class Camera;
@@ -36,7 +46,11 @@ class Texture;
 class FrameBuffer;
 class ShaderProgram;
 class Clock;
+class FixedStepScheduler;
 class Material;
+class VertexLayout;
+struct MeshArenaEntry_t;
+struct GBufferTargets_t;
 
 // For TextInBox draw styles
 enum TextDrawMode
@@ -48,13 +62,60 @@ enum TextDrawMode
 	NUM_TEXT_DRAW_MODES
 };
 
+// How the buffer swap waits on the display's refresh
+enum eVSyncMode
+{
+	VSYNC_OFF,
+	VSYNC_ON,
+	VSYNC_ADAPTIVE,		// Syncs while keeping up with the refresh rate, tears instead of stalling when late
+	NUM_VSYNC_MODES
+};
+
+// Called at the start of a frame once the frame pacing waits are done
+typedef void(*LateInputSample_cb)(void* args);
+
+// A glyph quad of laid out text, colored when it's pushed
+struct TextLayoutGlyph_t
+{
+	AABB2 bounds;
+	AABB2 uvs;
+};
+
+// Glyphs of a DrawTextInBox2D() call, kept to re-use while it's drawn with the same inputs
+struct TextLayout_t
+{
+	bool Matches(const std::string& _text, const AABB2& _box, const Vector2& _alignment, float _cellHeight, TextDrawMode _drawMode, const BitmapFont* _font, float _aspectScale) const;
+
+	std::string						text;
+	AABB2							box;
+	Vector2							alignment;
+	float							cellHeight = 0.f;
+	TextDrawMode					drawMode = TEXT_DRAW_ERROR;
+	const BitmapFont*				font = nullptr;
+	float							aspectScale = 1.f;
+
+	std::vector<TextLayoutGlyph_t>	glyphs;
+	uint64_t						lastUsedFrame = 0;
+};
+
+
+// Layout of a glMultiDrawElementsIndirect command, as read by the GL
+struct DrawElementsIndirectCommand_t
+{
+	unsigned int count;
+	unsigned int instanceCount;
+	unsigned int firstIndex;
+	int baseVertex;
+	unsigned int baseInstance;
+};
+
 
 class Renderer
 {
 public:
 	//-----Structure-----
 
-	// Initialization
+	// Initialization - headless runs make no renderer, so GetInstance() returns nullptr
 	static void Initialize();
 	static void Shutdown();
 
@@ -76,10 +137,20 @@ public:
 
 	// Time
 	void SetRendererGameClock(Clock* gameClock);
+	void SetRendererFixedStep(const FixedStepScheduler* scheduler);
+	float GetFixedStepAlpha() const;
 
 	// Lines
 	void SetGLLineWidth(float lineWidth);
 
+	// Clustered lights, for the camera currently being rendered
+	void BindLightClusters(LightClusterGrid* lightClusters);
+	void ClearLightClusters();
+
+	// Baked light probes, for the scene currently being rendered
+	void BindLightProbeVolume(LightProbeVolume* volume, const Vector3& renderOrigin);
+	void ClearLightProbeVolume();
+
 
 private:
 	//-----Lighting-----
@@ -107,7 +178,7 @@ private:
 
 	// Material -------------------------------------------------------------------------------------------------------------------------------------
 
-	void BindMaterial(Material* material);
+	void BindMaterial(Material* material, const ShaderProgram* program = nullptr);	// Program overrides the material's own
 
 	// Texture
 	void BindTexture(unsigned int bindSlot, const std::string& filename);
@@ -119,11 +190,23 @@ private:
 	// Model Matrix ---------------------------------------------------------------------------------------------------------------------------------
 
 	void BindModelMatrix(const Matrix44& model);
+	void BindMeshDecodeData(const Mesh* mesh);
 
 	// VAO ------------------------------------------------------------------------------------------------------------------------------------------
 
 	void BindMeshToProgram(const ShaderProgram* program, const Mesh* mesh) const;
+	bool BindInstanceBoneOffsetsToProgram(const ShaderProgram* program, unsigned int instanceBufferHandle) const;
+	bool BindInstanceCustomDataToProgram(const ShaderProgram* program, unsigned int instanceBufferHandle) const;
 	void BindVAO(unsigned int vaoHandle);
+	RenderState GetRenderStateForDrawCall(const DrawCall& drawCall) const;
+
+
+public:
+	//-----VAO Setup-----
+
+	// For VAOs made outside the renderer, i.e. the MeshArenas' over their shared buffers
+	void BindVertexLayoutToProgram(const ShaderProgram* program, const VertexLayout* vertexLayout, unsigned int vertexBufferHandle, unsigned int indexBufferHandle) const;
+	bool BindInstanceMatricesToProgram(const ShaderProgram* program, unsigned int instanceBufferHandle) const;
 
 
 public:
@@ -135,6 +218,16 @@ public:
 	void DrawMeshWithMaterial(Mesh* mesh, Material* material);
 	void DrawRenderable(Renderable* renderable);
 	void Draw(const DrawCall& drawCall);
+	void DrawBatch(const DrawCall* drawCalls, int drawCallCount);	// Draw calls must satisfy DrawCall::CanBatchWith with the first
+	void DrawDepthOnly(const DrawCall& drawCall);					// Writes the draw call's depth only, for depth pre-passes
+	void DrawGBuffer(const DrawCall& drawCall);						// Writes the draw call's surface into the current camera's G-buffer targets
+	void DrawDeferredLighting(const GBufferTargets_t& gBuffer, const Rgba& ambience);	// Lights the G-buffer into the current camera's color target
+	void DrawMeshIndirect(unsigned int vaoHandle, Mesh* mesh, Material* material, unsigned int commandBufferHandle);	// Command's counts written on the GPU
+
+	// The convenience functions below batch consecutive draws of the same material, primitive and line width into one
+	// mesh, drawn when the batch changes, anything else is drawn, or the frame ends - flush before doing GL work of your own
+	// Materials mustn't be changed between their draws and the flush
+	void FlushImmediateDraws();
 
 	// Drawing convenience functions
 
@@ -165,6 +258,9 @@ public:
 	
 	//-----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 	void DrawTextInBox2D(const std::string& text, const AABB2& box, const Vector2& alignment, float cellHeight, TextDrawMode drawMode, BitmapFont* font, Rgba color=Rgba::WHITE, float aspectScale=1.0f);
+
+	// Material text of the font draws with, for meshes of glyphs built outside the renderer
+	Material* GetFontMaterial(BitmapFont* font);
 	
 	//-----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 	void ClearScreen(const Rgba& clearColor);
@@ -178,7 +274,34 @@ public:
 	//-----Post Processed Effects-----
 
 	void ApplyImageEffect(ShaderProgram* program);
-	void FinalizeImageEffects();
+	void FinalizeImageEffects();		// Also upscales the scene to the default color target, with dynamic resolution on
+
+
+public:
+	//-----Dynamic Resolution-----
+
+	// Scene cameras draw to a region of the scene targets picked from the GPU frame time, upscaled into the
+	// default color target before the UI camera draws, so the UI stays at native resolution
+	// Cameras drawing the scene should target GetSceneColorTarget() and GetSceneDepthTarget()
+	void				SetDynamicResolutionEnabled(bool isEnabled);
+	bool				IsDynamicResolutionEnabled() const;
+	DynamicResolution&	GetDynamicResolution();
+
+
+public:
+	//-----Frame Pacing-----
+
+	// BeginFrame() waits until at most maxFramesInFlight frames are queued on the GPU, then until the frame rate
+	// cap's interval has passed since the last frame started, then calls the late input sample callback
+	// Input read in the callback is as fresh as it can be for the frame about to be drawn
+	void				SetMaxFramesInFlight(int maxFramesInFlight);	// 1 to RENDERER_MAX_FRAMES_IN_FLIGHT
+	int					GetMaxFramesInFlight() const;
+	void				SetFrameRateCap(float framesPerSecond);			// 0 for no cap
+	float				GetFrameRateCap() const;
+	void				SetVSyncMode(eVSyncMode mode);					// Adaptive falls back to on without WGL_EXT_swap_control_tear
+	eVSyncMode			GetVSyncMode() const;
+	void				SetLateInputSampleCallback(LateInputSample_cb callback, void* args);
+	float				GetLastFramePacingWaitSeconds() const;
 
 
 public:
@@ -190,6 +313,9 @@ public:
 
 	// VAOs
 	void			UpdateVAO(unsigned int& vaoHandle, Mesh* mesh, Material* material);
+	void			UpdateVAO(unsigned int& vaoHandle, Mesh* mesh, const Shader* shader);
+	void			UpdateDepthOnlyVAO(unsigned int& vaoHandle, Mesh* mesh);
+	void			UpdateGBufferVAO(unsigned int& vaoHandle, Mesh* mesh);
 	void			DeleteVAO(unsigned int& vaoHandle) const;
 
 	// Screenshots
@@ -201,6 +327,8 @@ public:
 
 	Texture*		GetDefaultColorTarget() const;
 	Texture*		GetDefaultDepthTarget() const;
+	Texture*		GetSceneColorTarget() const;	// The default targets unless dynamic resolution is on
+	Texture*		GetSceneDepthTarget() const;
 
 	Camera*			GetDefaultCamera() const;
 	Camera*			GetUICamera() const;
@@ -217,10 +345,13 @@ private:
 	~Renderer();
 	Renderer(const Renderer& copy) = delete;
 
-	// DrawTextInBox2D helper functions
-	void DrawTextInBox2D_Overrun(const std::string& text, const AABB2& box, const Vector2& alignment, float cellHeight, BitmapFont* font, Rgba color=Rgba::WHITE, float aspectScale=1.0f);
-	void DrawTextInBox2D_ShrinkToFit(const std::string& text, const AABB2& box, const Vector2& alignment, float cellHeight, BitmapFont* font, Rgba color=Rgba::WHITE, float aspectScale=1.0f);
-	void DrawTextInBox2D_WordWrap(const std::string& text, const AABB2& box, const Vector2& alignment, float cellHeight, BitmapFont* font, Rgba color=Rgba::WHITE, float aspectScale=1.0f);
+	// Text layout helper functions, appending the glyphs to out_glyphs
+	void LayoutText2D(std::string_view text, const Vector2& drawMins, float cellHeight, const BitmapFont* font, float aspectScale, std::vector<TextLayoutGlyph_t>& out_glyphs) const;
+	void LayoutTextInBox2D_Overrun(std::string_view text, const AABB2& box, const Vector2& alignment, float cellHeight, const BitmapFont* font, float aspectScale, std::vector<TextLayoutGlyph_t>& out_glyphs) const;
+	void LayoutTextInBox2D_ShrinkToFit(std::string_view text, const AABB2& box, const Vector2& alignment, float cellHeight, const BitmapFont* font, float aspectScale, std::vector<TextLayoutGlyph_t>& out_glyphs) const;
+	void LayoutTextInBox2D_WordWrap(const std::string& text, const AABB2& box, const Vector2& alignment, float cellHeight, const BitmapFont* font, float aspectScale, std::vector<TextLayoutGlyph_t>& out_glyphs) const;
+	void PushTextGlyphs(BitmapFont* font, const std::vector<TextLayoutGlyph_t>& glyphs, const Rgba& color);
+	void EvictUnusedTextLayouts();
 
 	// For setting up the renderer after the OpenGL context is made
 	void PostGLStartup();
@@ -228,6 +359,29 @@ private:
 	// For updating time
 	void UpdateTimeData();
 
+	// Returns the builder to push the draw's geometry into, flushing the batch first if it can't take it
+	MeshBuilder& BeginImmediateDraw(Material* material, PrimitiveType primitiveType, const VertexLayout* vertexLayout, float lineWidth = 1.0f);
+
+	// Dynamic resolution
+	IntVector2 GetScaledSceneDimensions() const;
+	void ResolveScene();
+	void BlitToDefaultColorTarget(const Texture* source, const IntVector2& sourceDimensions);
+
+	// Frame pacing
+	void WaitForFramePacing();
+	void WaitForFrameRateCap();
+	void FenceFrameInFlight();
+	void DeleteFrameFences();
+
+	// Image effects each draw with a material around their program
+	Material* GetImageEffectMaterial(ShaderProgram* program);
+
+	// Meshes stored in an arena draw with its shared VAOs
+	unsigned int GetVAOForMeshDraw(const Mesh* mesh, const ShaderProgram* program, unsigned int drawVAOHandle, MeshArenaEntry_t& out_arenaEntry);
+
+	// Streams the instances for an instanced draw and points the VAO at them, returning the base instance to draw
+	int BindInstancesForDraw(const ShaderProgram* program, const Matrix44* matrices, const uint32_t* boneOffsets, const Vector4* customData, int instanceCount);
+
 
 public:
 	//-----Public Data-----
@@ -242,9 +396,22 @@ private:
 	Mesh					m_immediateMesh;
 	MeshBuilder				m_immediateBuilder;
 	Renderable				m_immediateRenderable;
+	std::vector<Matrix44>	m_drawRenderableMatrices; // Reused by DrawRenderable() so it doesn't allocate every draw
+
+	// Batch being built in m_immediateBuilder, empty when the material is null
+	Material*				m_immediateBatchMaterial = nullptr;
+	const VertexLayout*		m_immediateBatchLayout = nullptr;
+	float					m_immediateBatchLineWidth = 1.0f;
+	std::map<const BitmapFont*, Material*>	m_fontMaterials;	// Text is batched, so each font keeps its material
+
+	// Text boxes laid out in recent frames, by a hash of their inputs
+	std::unordered_map<size_t, TextLayout_t>	m_textLayouts;
+	std::vector<TextLayoutGlyph_t>				m_text2DGlyphs;		// Reused by DrawText2D() so it doesn't allocate every draw
+	uint64_t									m_frameNumber = 0;
 
 	Sampler*				m_defaultSampler = nullptr;
 	Sampler*				m_shadowSampler = nullptr;
+	Sampler*				m_fontSDFSampler = nullptr;	// Distance fields need filtering
 
 	Camera*					m_defaultCamera = nullptr;
 	Camera*					m_currentCamera = nullptr;
@@ -258,17 +425,54 @@ private:
 
 	// For post-processed effects
 	Camera*					m_effectsCamera;
-	Texture*				m_effectsSource = nullptr;
+	Texture*				m_effectsSource = nullptr;		// Default color target, or a pooled target of the last effect's
 	Texture*				m_effectsDestination = nullptr;
+	std::map<const ShaderProgram*, Material*>	m_effectMaterials;
+
+	// For dynamic resolution
+	bool					m_isDynamicResolutionEnabled = false;
+	bool					m_isSceneResolved = false;			// Set once the scene is upscaled this frame
+	DynamicResolution		m_dynamicResolution;
+	Texture*				m_sceneColorTarget = nullptr;		// Native size, drawn to a scaled region of
+	Texture*				m_sceneDepthTarget = nullptr;
+	unsigned int			m_resolveFramebuffers[2] = { 0, 0 };	// Read and draw, for the upscale blit
+
+	// For frame pacing
+	GLsync					m_frameFences[RENDERER_MAX_FRAMES_IN_FLIGHT] = { nullptr, nullptr, nullptr };	// Ring of the frames swapped, by frame number
+	int						m_maxFramesInFlight = RENDERER_DEFAULT_FRAMES_IN_FLIGHT;
+	float					m_frameRateCap = 0.f;
+	uint64_t				m_lastFrameStartHPC = 0;
+	float					m_lastFramePacingWaitSeconds = 0.f;
+	eVSyncMode				m_vsyncMode = VSYNC_ON;
+	LateInputSample_cb		m_lateInputSampleCallback = nullptr;
+	void*					m_lateInputSampleArgs = nullptr;
 
 	// Time
 	Clock* m_gameClock = nullptr;
+	const FixedStepScheduler* m_fixedStepScheduler = nullptr;
 
 	// Uniform buffers
 	UniformBuffer			m_timeUniformBuffer;
-	UniformBuffer			m_modelUniformBuffer;
+	UniformBuffer			m_meshUniformBuffer;
+	MeshDecodeData_t		m_boundMeshDecodeData;
+	// Instances go in the InstanceDataStream; these are only uploaded to by draws that don't fit in the frame's range
 	mutable RenderBuffer	m_modelInstanceBuffer;
+	RenderBuffer			m_boneOffsetInstanceBuffer;		// Skinning palette offsets of the instances, beside the matrices
+	RenderBuffer			m_customDataInstanceBuffer;		// Vector4 per instance, i.e. a color
+
+	// Multi-draw batches, drawn from the MeshArenas
+	RenderBuffer							m_batchIndirectBuffer;
+	std::vector<Matrix44>					m_batchMatrices;
+	std::vector<DrawElementsIndirectCommand_t>	m_batchCommands;
+
+	Material*				m_depthOnlyMaterial = nullptr;	// Cached, for depth pre-pass draws
+	Material*				m_gBufferMaterial = nullptr;	// Cached, for deferred cameras' G-buffer draws
+	Material*				m_deferredLightingMaterial = nullptr;
 	mutable UniformBuffer	m_lightUniformBuffer;
+	LightClusterGrid		m_lightClusterGrid;		// Empty grid, bound outside of camera passes
+	LightClusterGrid*		m_boundLightClusters = &m_lightClusterGrid;	// The lit shaders' per camera lights, built by the ForwardRenderingPath
+	LightProbeVolume		m_emptyLightProbeVolume;	// Bound outside of scenes with probes
+	BindlessTextureTable	m_bindlessTextures;			// Diffuses of materials whose shaders index the table, see Material::UpdateBindlessDiffuse()
 
 	// VAO
 	GLuint m_defaultVAO;
@@ -0,0 +1,248 @@
+/************************************************************************/
+/* File: SpriteBatcher.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the SpriteBatcher class
+/************************************************************************/
+#include "Engine/Assets/AssetDB.hpp"
+#include "Engine/Rendering/Core/Renderer.hpp"
+#include "Engine/Rendering/Core/SpriteBatcher.hpp"
+#include "Engine/Rendering/Resources/Sprite.hpp"
+#include "Engine/Rendering/Materials/MaterialInstance.hpp"
+#include "Engine/Rendering/Animation/SpriteAnimBatch.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+
+#define INDICES_PER_QUAD (6)
+#define VERTICES_PER_QUAD (4)
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+SpriteBatcher::SpriteBatcher(Material* baseMaterial /*= nullptr*/)
+	: m_baseMaterial(baseMaterial)
+{
+	if (m_baseMaterial == nullptr)
+	{
+		m_baseMaterial = AssetDB::CreateOrGetSharedMaterial("Default_Alpha");
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+SpriteBatcher::~SpriteBatcher()
+{
+	std::unordered_map<const Texture*, MaterialInstance*>::iterator itr = m_materials.begin();
+	for (itr; itr != m_materials.end(); ++itr)
+	{
+		delete itr->second;
+	}
+
+	m_materials.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the sprite at the given position, sized and pivoted by the sprite itself
+//
+void SpriteBatcher::AddSprite(const Sprite* sprite, const Vector3& position, const Rgba& tint /*= Rgba::WHITE*/, const Vector3& right /*= Vector3::X_AXIS*/, const Vector3& up /*= Vector3::Y_AXIS*/)
+{
+	AddQuad(&sprite->GetTexture(), sprite->GetUVs(), position, sprite->GetDimensions(), sprite->GetPivot(), tint, right, up);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a quad of the given texture and UVs, laid out the same as MeshBuilder::Push3DQuad()
+//
+void SpriteBatcher::AddQuad(const Texture* texture, const AABB2& uvs, const Vector3& position, const Vector2& dimensions, const Vector2& pivot /*= Vector2(0.5f, 0.5f)*/,
+	const Rgba& tint /*= Rgba::WHITE*/, const Vector3& right /*= Vector3::X_AXIS*/, const Vector3& up /*= Vector3::Y_AXIS*/)
+{
+	float minX = -1.0f * (pivot.x * dimensions.x);
+	float maxX = minX + dimensions.x;
+	float minY = -1.0f * (pivot.y * dimensions.y);
+	float maxY = minY + dimensions.y;
+
+	std::vector<Vertex3D_PCU>& vertices = GetBucketForTexture(texture).vertices;
+
+	vertices.push_back(Vertex3D_PCU(position + minX * right + minY * up, tint, uvs.GetBottomLeft()));
+	vertices.push_back(Vertex3D_PCU(position + maxX * right + minY * up, tint, uvs.GetBottomRight()));
+	vertices.push_back(Vertex3D_PCU(position + maxX * right + maxY * up, tint, uvs.GetTopRight()));
+	vertices.push_back(Vertex3D_PCU(position + minX * right + maxY * up, tint, uvs.GetTopLeft()));
+
+	m_quadCount++;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a quad showing the current frame of one of the batch's animations
+//
+void SpriteBatcher::AddAnimation(const SpriteAnimBatch& animations, int animationIndex, const Vector3& position, const Vector2& dimensions, const Vector2& pivot /*= Vector2(0.5f, 0.5f)*/,
+	const Rgba& tint /*= Rgba::WHITE*/, const Vector3& right /*= Vector3::X_AXIS*/, const Vector3& up /*= Vector3::Y_AXIS*/)
+{
+	AddQuad(&animations.GetTexture(animationIndex), animations.GetCurrentUVs(animationIndex), position, dimensions, pivot, tint, right, up);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Uploads every quad added this frame as one vertex buffer, and draws each texture's range of it
+// with one draw call, using the renderer's current camera
+//
+void SpriteBatcher::Draw()
+{
+	m_drawCountLastFrame = 0;
+
+	if (m_quadCount == 0)
+	{
+		return;
+	}
+
+	// Lay the buckets out back to back
+	m_vertices.clear();
+	m_vertices.reserve(m_quadCount * VERTICES_PER_QUAD);
+
+	int bucketCount = static_cast<int>(m_buckets.size());
+	for (int bucketIndex = 0; bucketIndex < bucketCount; ++bucketIndex)
+	{
+		const std::vector<Vertex3D_PCU>& bucketVertices = m_buckets[bucketIndex].vertices;
+		m_vertices.insert(m_vertices.end(), bucketVertices.begin(), bucketVertices.end());
+	}
+
+	m_mesh.SetVertices(static_cast<unsigned int>(m_vertices.size()), m_vertices.data());
+	EnsureIndexCapacity(static_cast<unsigned int>(m_quadCount));
+
+	Renderer* renderer = Renderer::GetInstance();
+	unsigned int firstQuad = 0;
+
+	for (int bucketIndex = 0; bucketIndex < bucketCount; ++bucketIndex)
+	{
+		const SpriteBatchBucket_t& bucket = m_buckets[bucketIndex];
+		unsigned int quadCount = static_cast<unsigned int>(bucket.vertices.size()) / VERTICES_PER_QUAD;
+
+		if (quadCount == 0)
+		{
+			continue;
+		}
+
+		m_mesh.SetDrawInstruction(PRIMITIVE_TRIANGLES, true, firstQuad * INDICES_PER_QUAD, quadCount * INDICES_PER_QUAD);
+		renderer->DrawMeshWithMaterial(&m_mesh, GetMaterialForTexture(bucket.texture));
+
+		firstQuad += quadCount;
+		m_drawCountLastFrame++;
+	}
+
+	Clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes all quads added since the last draw, keeping the buckets' memory for the next frame
+//
+void SpriteBatcher::Clear()
+{
+	int bucketCount = static_cast<int>(m_buckets.size());
+	for (int bucketIndex = 0; bucketIndex < bucketCount; ++bucketIndex)
+	{
+		m_buckets[bucketIndex].vertices.clear();
+	}
+
+	m_quadCount = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of quads added since the last draw
+//
+int SpriteBatcher::GetQuadCount() const
+{
+	return m_quadCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of draw calls the last Draw() made, one per texture drawn
+//
+int SpriteBatcher::GetDrawCountLastFrame() const
+{
+	return m_drawCountLastFrame;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the bucket of quads for the given texture, creating it the first time it's used
+//
+SpriteBatchBucket_t& SpriteBatcher::GetBucketForTexture(const Texture* texture)
+{
+	std::unordered_map<const Texture*, int>::const_iterator itr = m_bucketIndices.find(texture);
+
+	if (itr != m_bucketIndices.end())
+	{
+		return m_buckets[itr->second];
+	}
+
+	m_bucketIndices[texture] = static_cast<int>(m_buckets.size());
+
+	m_buckets.emplace_back();
+	m_buckets.back().texture = texture;
+
+	return m_buckets.back();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the copy of the base material that draws with the given texture
+//
+Material* SpriteBatcher::GetMaterialForTexture(const Texture* texture)
+{
+	std::unordered_map<const Texture*, MaterialInstance*>::const_iterator itr = m_materials.find(texture);
+
+	if (itr != m_materials.end())
+	{
+		return itr->second;
+	}
+
+	MaterialInstance* material = new MaterialInstance(m_baseMaterial);
+	material->SetDiffuse(texture);
+	m_materials[texture] = material;
+
+	return material;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Uploads quad indices covering at least the given number of quads, if they don't already
+//
+void SpriteBatcher::EnsureIndexCapacity(unsigned int quadCount)
+{
+	if (quadCount <= m_indexCapacityQuads)
+	{
+		return;
+	}
+
+	// Grow by half again, so a batch slowly gaining sprites doesn't upload every frame
+	unsigned int newCapacity = m_indexCapacityQuads + m_indexCapacityQuads / 2;
+	if (newCapacity < quadCount)
+	{
+		newCapacity = quadCount;
+	}
+
+	std::vector<unsigned int> indices;
+	indices.reserve(newCapacity * INDICES_PER_QUAD);
+
+	for (unsigned int quadIndex = 0; quadIndex < newCapacity; ++quadIndex)
+	{
+		unsigned int first = quadIndex * VERTICES_PER_QUAD;
+
+		indices.push_back(first + 0);
+		indices.push_back(first + 1);
+		indices.push_back(first + 2);
+
+		indices.push_back(first + 0);
+		indices.push_back(first + 2);
+		indices.push_back(first + 3);
+	}
+
+	m_mesh.SetIndices(static_cast<unsigned int>(indices.size()), indices.data());
+	m_indexCapacityQuads = newCapacity;
+}
@@ -0,0 +1,80 @@
+/************************************************************************/
+/* File: SpriteBatcher.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Collects a frame's sprites by texture into one vertex buffer,
+/*				uploaded once and drawn with one draw call per texture
+/************************************************************************/
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/Vector3.hpp"
+#include "Engine/Core/Rgba.hpp"
+#include "Engine/Rendering/Core/Vertex.hpp"
+#include "Engine/Rendering/Meshes/Mesh.hpp"
+
+class Sprite;
+class Texture;
+class Material;
+class MaterialInstance;
+class SpriteAnimBatch;
+
+// All quads sharing one texture this frame, in the order they were added
+struct SpriteBatchBucket_t
+{
+	const Texture*				texture = nullptr;
+	std::vector<Vertex3D_PCU>	vertices;		// 4 per quad
+};
+
+
+class SpriteBatcher
+{
+public:
+	//-----Public Methods-----
+
+	SpriteBatcher(Material* baseMaterial = nullptr);		// Textures are swapped onto copies of baseMaterial, Default_Alpha if null
+	~SpriteBatcher();
+	SpriteBatcher(const SpriteBatcher& copy) = delete;
+
+	void	AddSprite(const Sprite* sprite, const Vector3& position, const Rgba& tint = Rgba::WHITE, const Vector3& right = Vector3::X_AXIS, const Vector3& up = Vector3::Y_AXIS);
+	void	AddQuad(const Texture* texture, const AABB2& uvs, const Vector3& position, const Vector2& dimensions, const Vector2& pivot = Vector2(0.5f, 0.5f),
+				const Rgba& tint = Rgba::WHITE, const Vector3& right = Vector3::X_AXIS, const Vector3& up = Vector3::Y_AXIS);
+	void	AddAnimation(const SpriteAnimBatch& animations, int animationIndex, const Vector3& position, const Vector2& dimensions, const Vector2& pivot = Vector2(0.5f, 0.5f),
+				const Rgba& tint = Rgba::WHITE, const Vector3& right = Vector3::X_AXIS, const Vector3& up = Vector3::Y_AXIS);
+
+	// Uploads everything added since the last Draw() and draws it, then empties the batch for the next frame
+	void	Draw();
+	void	Clear();
+
+	int		GetQuadCount() const;
+	int		GetDrawCountLastFrame() const;
+
+
+private:
+	//-----Private Methods-----
+
+	SpriteBatchBucket_t&	GetBucketForTexture(const Texture* texture);
+	Material*				GetMaterialForTexture(const Texture* texture);
+	void					EnsureIndexCapacity(unsigned int quadCount);
+
+
+private:
+	//-----Private Data-----
+
+	Material*											m_baseMaterial = nullptr;
+
+	// Buckets are kept between frames so their memory is reused, emptied but not removed by Clear()
+	std::vector<SpriteBatchBucket_t>					m_buckets;
+	std::unordered_map<const Texture*, int>				m_bucketIndices;
+	std::unordered_map<const Texture*, MaterialInstance*>	m_materials;
+
+	// Every bucket back to back, uploaded in one go
+	std::vector<Vertex3D_PCU>							m_vertices;
+	Mesh												m_mesh;
+	unsigned int										m_indexCapacityQuads = 0;	// Quad indices only change with the capacity, so they're only uploaded when it grows
+
+	int													m_quadCount = 0;
+	int													m_drawCountLastFrame = 0;
+
+};
@@ -0,0 +1,454 @@
+/************************************************************************/
+/* File: TransformHierarchy.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the TransformHierarchy class
+/************************************************************************/
+#include <algorithm>
+#include "Engine/Rendering/Core/TransformHierarchy.hpp"
+#include "Engine/Rendering/Core/Renderable.hpp"
+#include "Engine/Core/JobSystem/ParallelFor.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Removes the element by moving the last one into its place
+//
+template <typename T>
+static void SwapRemove(std::vector<T>& elements, int index)
+{
+	elements[index] = elements.back();
+	elements.pop_back();
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Reorders the elements so that element i becomes the old element order[i]
+//
+template <typename T>
+static void Permute(std::vector<T>& elements, const std::vector<int>& order)
+{
+	std::vector<T> permuted;
+	permuted.reserve(elements.size());
+
+	for (int index = 0; index < (int)order.size(); ++index)
+	{
+		permuted.push_back(elements[order[index]]);
+	}
+
+	elements.swap(permuted);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a transform, returning its handle
+//
+TransformHandle TransformHierarchy::CreateTransform(const Vector3& position /*= Vector3::ZERO*/, const Vector3& rotation /*= Vector3::ZERO*/, const Vector3& scale /*= Vector3::ONES*/, TransformHandle parent /*= INVALID_TRANSFORM_HANDLE*/)
+{
+	ASSERT_OR_DIE(parent == INVALID_TRANSFORM_HANDLE || IsValid(parent), "Error: TransformHierarchy::CreateTransform() given an invalid parent");
+
+	TransformHandle handle;
+	if (m_freeHandles.size() > 0)
+	{
+		handle = m_freeHandles.back();
+		m_freeHandles.pop_back();
+	}
+	else
+	{
+		handle = (TransformHandle)m_denseIndexByHandle.size();
+		m_denseIndexByHandle.push_back(-1);
+	}
+
+	m_denseIndexByHandle[handle] = (int)m_handles.size();
+
+	m_positions.push_back(position);
+	m_rotations.push_back(rotation);
+	m_scales.push_back(scale);
+	m_worldMatrices.push_back(Matrix44::MakeModelMatrix(position, rotation, scale));
+	m_handles.push_back(handle);
+	m_parentHandles.push_back(parent);
+	m_parentIndices.push_back(-1);
+	m_isDirty.push_back(1);
+	m_wasChanged.push_back(0);
+	m_boundRenderables.push_back(nullptr);
+	m_boundInstanceIndices.push_back(0);
+
+	m_needsSort = true;
+	return handle;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes the transform; its children get its parent, and keep their local values
+//
+void TransformHierarchy::DestroyTransform(TransformHandle handle)
+{
+	int denseIndex = GetDenseIndex(handle);
+	TransformHandle parent = m_parentHandles[denseIndex];
+
+	for (int otherIndex = 0; otherIndex < (int)m_parentHandles.size(); ++otherIndex)
+	{
+		if (m_parentHandles[otherIndex] == handle)
+		{
+			m_parentHandles[otherIndex] = parent;
+			m_isDirty[otherIndex] = 1;
+		}
+	}
+
+	int lastIndex = (int)m_handles.size() - 1;
+	m_denseIndexByHandle[m_handles[lastIndex]] = denseIndex;
+	m_denseIndexByHandle[handle] = -1;
+	m_freeHandles.push_back(handle);
+
+	SwapRemove(m_positions, denseIndex);
+	SwapRemove(m_rotations, denseIndex);
+	SwapRemove(m_scales, denseIndex);
+	SwapRemove(m_worldMatrices, denseIndex);
+	SwapRemove(m_handles, denseIndex);
+	SwapRemove(m_parentHandles, denseIndex);
+	SwapRemove(m_parentIndices, denseIndex);
+	SwapRemove(m_isDirty, denseIndex);
+	SwapRemove(m_wasChanged, denseIndex);
+	SwapRemove(m_boundRenderables, denseIndex);
+	SwapRemove(m_boundInstanceIndices, denseIndex);
+
+	m_needsSort = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the handle refers to a live transform
+//
+bool TransformHierarchy::IsValid(TransformHandle handle) const
+{
+	return (handle >= 0 && handle < (int)m_denseIndexByHandle.size() && m_denseIndexByHandle[handle] >= 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reparents the transform, keeping its local values; INVALID_TRANSFORM_HANDLE makes it a root
+//
+void TransformHierarchy::SetParent(TransformHandle handle, TransformHandle parent)
+{
+	int denseIndex = GetDenseIndex(handle);
+
+	// Walk up from the new parent, to make sure the transform isn't one of its ancestors
+	TransformHandle ancestor = parent;
+	while (ancestor != INVALID_TRANSFORM_HANDLE)
+	{
+		ASSERT_OR_DIE(ancestor != handle, "Error: TransformHierarchy::SetParent() would make a transform its own ancestor");
+		ancestor = m_parentHandles[GetDenseIndex(ancestor)];
+	}
+
+	if (m_parentHandles[denseIndex] != parent)
+	{
+		m_parentHandles[denseIndex] = parent;
+		m_isDirty[denseIndex] = 1;
+		m_needsSort = true;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the transform's parent, INVALID_TRANSFORM_HANDLE for a root
+//
+TransformHandle TransformHierarchy::GetParent(TransformHandle handle) const
+{
+	return m_parentHandles[GetDenseIndex(handle)];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the position in parent space
+//
+void TransformHierarchy::SetLocalPosition(TransformHandle handle, const Vector3& position)
+{
+	int denseIndex = GetDenseIndex(handle);
+	m_positions[denseIndex] = position;
+	m_isDirty[denseIndex] = 1;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the rotation in parent space, as Euler angles in degrees
+//
+void TransformHierarchy::SetLocalRotation(TransformHandle handle, const Vector3& rotation)
+{
+	int denseIndex = GetDenseIndex(handle);
+	m_rotations[denseIndex] = rotation;
+	m_isDirty[denseIndex] = 1;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the scale in parent space
+//
+void TransformHierarchy::SetLocalScale(TransformHandle handle, const Vector3& scale)
+{
+	int denseIndex = GetDenseIndex(handle);
+	m_scales[denseIndex] = scale;
+	m_isDirty[denseIndex] = 1;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets all the local values at once
+//
+void TransformHierarchy::SetLocalTRS(TransformHandle handle, const Vector3& position, const Vector3& rotation, const Vector3& scale)
+{
+	int denseIndex = GetDenseIndex(handle);
+	m_positions[denseIndex] = position;
+	m_rotations[denseIndex] = rotation;
+	m_scales[denseIndex] = scale;
+	m_isDirty[denseIndex] = 1;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the position in parent space
+//
+Vector3 TransformHierarchy::GetLocalPosition(TransformHandle handle) const
+{
+	return m_positions[GetDenseIndex(handle)];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the rotation in parent space
+//
+Vector3 TransformHierarchy::GetLocalRotation(TransformHandle handle) const
+{
+	return m_rotations[GetDenseIndex(handle)];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the scale in parent space
+//
+Vector3 TransformHierarchy::GetLocalScale(TransformHandle handle) const
+{
+	return m_scales[GetDenseIndex(handle)];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the world matrix computed by the last update
+//
+const Matrix44& TransformHierarchy::GetWorldMatrix(TransformHandle handle) const
+{
+	return m_worldMatrices[GetDenseIndex(handle)];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the world position computed by the last update
+//
+Vector3 TransformHierarchy::GetWorldPosition(TransformHandle handle) const
+{
+	return Matrix44::ExtractTranslation(GetWorldMatrix(handle));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the last update recomputed the transform's world matrix
+//
+bool TransformHierarchy::WasChangedLastUpdate(TransformHandle handle) const
+{
+	return (m_wasChanged[GetDenseIndex(handle)] != 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Makes the transform drive the renderable's instance matrix; the instance must already exist
+//
+void TransformHierarchy::BindRenderableInstance(TransformHandle handle, Renderable* renderable, unsigned int instanceIndex)
+{
+	int denseIndex = GetDenseIndex(handle);
+	m_boundRenderables[denseIndex] = renderable;
+	m_boundInstanceIndices[denseIndex] = instanceIndex;
+
+	// So the renderable gets the current matrix on the next update
+	m_isDirty[denseIndex] = 1;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stops the transform from writing to its renderable
+//
+void TransformHierarchy::UnbindRenderable(TransformHandle handle)
+{
+	m_boundRenderables[GetDenseIndex(handle)] = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Recomputes the world matrix of every transform that changed, or whose parent did
+// Levels go in order, so a level's parents are always final; each level is split across the workers
+//
+void TransformHierarchy::UpdateWorldMatrices()
+{
+	PROFILE_SCOPE_CATEGORY("TransformHierarchy::UpdateWorldMatrices", "Scene");
+
+	if (m_needsSort)
+	{
+		SortByDepth();
+	}
+
+	int numLevels = (int)m_levelStarts.size() - 1;
+	for (int levelIndex = 0; levelIndex < numLevels; ++levelIndex)
+	{
+		ParallelForRange(m_levelStarts[levelIndex], m_levelStarts[levelIndex + 1], TRANSFORM_HIERARCHY_GRAIN_SIZE, [this](int rangeBegin, int rangeEnd)
+		{
+			UpdateLevel(rangeBegin, rangeEnd);
+		});
+	}
+
+	// Renderables aren't safe to write from several threads, so push the results on this one
+	m_lastUpdateChangedCount = 0;
+	for (int denseIndex = 0; denseIndex < (int)m_handles.size(); ++denseIndex)
+	{
+		if (m_wasChanged[denseIndex] == 0)
+		{
+			continue;
+		}
+
+		m_lastUpdateChangedCount++;
+
+		if (m_boundRenderables[denseIndex] != nullptr)
+		{
+			m_boundRenderables[denseIndex]->SetInstanceMatrix(m_boundInstanceIndices[denseIndex], m_worldMatrices[denseIndex]);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of live transforms
+//
+int TransformHierarchy::GetTransformCount() const
+{
+	return (int)m_handles.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns how many world matrices the last update recomputed
+//
+int TransformHierarchy::GetLastUpdateChangedCount() const
+{
+	return m_lastUpdateChangedCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the index of the handle's transform in the dense arrays
+//
+int TransformHierarchy::GetDenseIndex(TransformHandle handle) const
+{
+	ASSERT_OR_DIE(IsValid(handle), "Error: TransformHierarchy used with an invalid handle");
+	return m_denseIndexByHandle[handle];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sorts the dense arrays by depth, roots first; transforms at the same depth keep their order
+// Only needed after transforms are created, destroyed or reparented
+//
+void TransformHierarchy::SortByDepth()
+{
+	int numTransforms = (int)m_handles.size();
+
+	// Find each depth by walking up to the first ancestor with a known depth
+	std::vector<int> depths(numTransforms, -1);
+	std::vector<int> chain;
+	int maxDepth = -1;
+
+	for (int denseIndex = 0; denseIndex < numTransforms; ++denseIndex)
+	{
+		int currentIndex = denseIndex;
+		chain.clear();
+
+		while (currentIndex >= 0 && depths[currentIndex] < 0)
+		{
+			chain.push_back(currentIndex);
+
+			TransformHandle parent = m_parentHandles[currentIndex];
+			currentIndex = (parent == INVALID_TRANSFORM_HANDLE ? -1 : m_denseIndexByHandle[parent]);
+		}
+
+		int depth = (currentIndex >= 0 ? depths[currentIndex] : -1);
+		for (int chainIndex = (int)chain.size() - 1; chainIndex >= 0; --chainIndex)
+		{
+			depths[chain[chainIndex]] = ++depth;
+		}
+
+		maxDepth = (depths[denseIndex] > maxDepth ? depths[denseIndex] : maxDepth);
+	}
+
+	std::vector<int> order(numTransforms);
+	for (int denseIndex = 0; denseIndex < numTransforms; ++denseIndex)
+	{
+		order[denseIndex] = denseIndex;
+	}
+
+	std::stable_sort(order.begin(), order.end(), [&depths](int a, int b) { return depths[a] < depths[b]; });
+
+	Permute(m_positions, order);
+	Permute(m_rotations, order);
+	Permute(m_scales, order);
+	Permute(m_worldMatrices, order);
+	Permute(m_handles, order);
+	Permute(m_parentHandles, order);
+	Permute(m_isDirty, order);
+	Permute(m_wasChanged, order);
+	Permute(m_boundRenderables, order);
+	Permute(m_boundInstanceIndices, order);
+
+	for (int denseIndex = 0; denseIndex < numTransforms; ++denseIndex)
+	{
+		m_denseIndexByHandle[m_handles[denseIndex]] = denseIndex;
+	}
+
+	m_levelStarts.clear();
+	for (int denseIndex = 0; denseIndex < numTransforms; ++denseIndex)
+	{
+		TransformHandle parent = m_parentHandles[denseIndex];
+		m_parentIndices[denseIndex] = (parent == INVALID_TRANSFORM_HANDLE ? -1 : m_denseIndexByHandle[parent]);
+
+		int depth = depths[order[denseIndex]];
+		while ((int)m_levelStarts.size() <= depth)
+		{
+			m_levelStarts.push_back(denseIndex);
+		}
+	}
+
+	m_levelStarts.push_back(numTransforms);
+	m_needsSort = false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Updates the transforms in [levelStart, levelEnd), which must all be at the same depth
+//
+void TransformHierarchy::UpdateLevel(int levelStart, int levelEnd)
+{
+	for (int denseIndex = levelStart; denseIndex < levelEnd; ++denseIndex)
+	{
+		int parentIndex = m_parentIndices[denseIndex];
+		bool parentChanged = (parentIndex >= 0 && m_wasChanged[parentIndex] != 0);
+
+		if (m_isDirty[denseIndex] != 0 || parentChanged)
+		{
+			Matrix44 localMatrix = Matrix44::MakeModelMatrix(m_positions[denseIndex], m_rotations[denseIndex], m_scales[denseIndex]);
+			m_worldMatrices[denseIndex] = (parentIndex >= 0 ? m_worldMatrices[parentIndex] * localMatrix : localMatrix);
+
+			m_wasChanged[denseIndex] = 1;
+			m_isDirty[denseIndex] = 0;
+		}
+		else
+		{
+			m_wasChanged[denseIndex] = 0;
+		}
+	}
+}
@@ -0,0 +1,100 @@
+/************************************************************************/
+/* File: TransformHierarchy.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Scene-wide parent/child transforms stored as arrays sorted
+/*				by depth, so world matrices are updated in one pass per
+/*				level and only for transforms that changed
+/************************************************************************/
+#pragma once
+#include <vector>
+#include <stdint.h>
+#include "Engine/Math/Vector3.hpp"
+#include "Engine/Math/Matrix44.hpp"
+
+class Renderable;
+
+typedef int TransformHandle;
+#define INVALID_TRANSFORM_HANDLE (-1)
+
+// Transforms per job when a level is split across the JobSystem
+#define TRANSFORM_HIERARCHY_GRAIN_SIZE (256)
+
+
+class TransformHierarchy
+{
+public:
+	//-----Public Methods-----
+
+	TransformHierarchy() {}
+	~TransformHierarchy() {}
+
+	// Position, rotation (Euler degrees) and scale are in the parent's space, the same as Transform
+	TransformHandle		CreateTransform(const Vector3& position = Vector3::ZERO, const Vector3& rotation = Vector3::ZERO, const Vector3& scale = Vector3::ONES, TransformHandle parent = INVALID_TRANSFORM_HANDLE);
+	void				DestroyTransform(TransformHandle handle);	// Children are moved up to its parent, keeping their local values
+	bool				IsValid(TransformHandle handle) const;
+
+	void				SetParent(TransformHandle handle, TransformHandle parent);
+	TransformHandle		GetParent(TransformHandle handle) const;
+
+	// Mark the transform (and so its children) for the next update
+	void				SetLocalPosition(TransformHandle handle, const Vector3& position);
+	void				SetLocalRotation(TransformHandle handle, const Vector3& rotation);
+	void				SetLocalScale(TransformHandle handle, const Vector3& scale);
+	void				SetLocalTRS(TransformHandle handle, const Vector3& position, const Vector3& rotation, const Vector3& scale);
+
+	Vector3				GetLocalPosition(TransformHandle handle) const;
+	Vector3				GetLocalRotation(TransformHandle handle) const;
+	Vector3				GetLocalScale(TransformHandle handle) const;
+
+	// As of the last UpdateWorldMatrices()
+	const Matrix44&		GetWorldMatrix(TransformHandle handle) const;
+	Vector3				GetWorldPosition(TransformHandle handle) const;
+	bool				WasChangedLastUpdate(TransformHandle handle) const;
+
+	// The renderable's instance matrix is set to the world matrix whenever it changes
+	void				BindRenderableInstance(TransformHandle handle, Renderable* renderable, unsigned int instanceIndex);
+	void				UnbindRenderable(TransformHandle handle);
+
+	// Once per frame, after gameplay has moved things and before the scene is drawn
+	void				UpdateWorldMatrices();
+
+	int					GetTransformCount() const;
+	int					GetLastUpdateChangedCount() const;
+
+
+private:
+	//-----Private Methods-----
+
+	TransformHierarchy(const TransformHierarchy& copy) = delete;
+
+	int					GetDenseIndex(TransformHandle handle) const;
+	void				SortByDepth();
+	void				UpdateLevel(int levelStart, int levelEnd);
+
+
+private:
+	//-----Private Data-----
+
+	// Handles index this, so they stay put while the dense arrays are resorted
+	std::vector<int>				m_denseIndexByHandle;	// -1 when the handle is free
+	std::vector<TransformHandle>	m_freeHandles;
+
+	// Dense arrays, sorted by depth after SortByDepth() so parents always come before their children
+	std::vector<Vector3>			m_positions;
+	std::vector<Vector3>			m_rotations;
+	std::vector<Vector3>			m_scales;
+	std::vector<Matrix44>			m_worldMatrices;
+	std::vector<TransformHandle>	m_handles;
+	std::vector<TransformHandle>	m_parentHandles;
+	std::vector<int>				m_parentIndices;		// Dense index of the parent, -1 for roots; only valid once sorted
+	std::vector<uint8_t>			m_isDirty;				// Local values changed since the last update
+	std::vector<uint8_t>			m_wasChanged;			// World matrix was recomputed in the last update
+	std::vector<Renderable*>		m_boundRenderables;
+	std::vector<unsigned int>		m_boundInstanceIndices;
+
+	std::vector<int>				m_levelStarts;			// Dense index each depth starts at, plus the end
+	bool							m_needsSort = false;
+	int								m_lastUpdateChangedCount = 0;
+
+};
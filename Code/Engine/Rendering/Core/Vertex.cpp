@@ -5,7 +5,9 @@
 /* Description: Definitions of Vertex informations
 /************************************************************************/
 #include "Engine/Rendering/Core/Vertex.hpp"
+#include "Engine/Math/MathUtils.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include <string.h>
 
 //--------------------VERTEX TYPES--------------------
 
@@ -50,6 +52,34 @@ const VertexAttribute VertexSkinned::ATTRIBUTES[] =
 const unsigned int VertexSkinned::NUM_ATTRIBUTES = (sizeof(ATTRIBUTES) / sizeof(VertexAttribute));
 const VertexLayout VertexSkinned::LAYOUT = VertexLayout(sizeof(VertexSkinned), NUM_ATTRIBUTES, VertexSkinned::ATTRIBUTES);
 
+//-----VertexLitPacked (quantized position, color, half UVs, octahedral normal and tangent)-----
+const VertexAttribute VertexLitPacked::ATTRIBUTES[] =
+{
+	VertexAttribute("POSITION",		RDT_UNSIGNED_SHORT,	3,		true,		offsetof(VertexLitPacked, m_position)),
+	VertexAttribute("COLOR",		RDT_UNSIGNED_BYTE,	4,		true,		offsetof(VertexLitPacked, m_color)), 
+	VertexAttribute("UV",			RDT_HALF_FLOAT,		2,		false,		offsetof(VertexLitPacked, m_texUVs)),
+	VertexAttribute("NORMAL",		RDT_SHORT,			2,		true,		offsetof(VertexLitPacked, m_normal)),
+	VertexAttribute("TANGENT",		RDT_SHORT,			3,		true,		offsetof(VertexLitPacked, m_tangent))
+};
+
+const unsigned int VertexLitPacked::NUM_ATTRIBUTES = (sizeof(ATTRIBUTES) / sizeof(VertexAttribute));
+const VertexLayout VertexLitPacked::LAYOUT = VertexLayout(sizeof(VertexLitPacked), NUM_ATTRIBUTES, VertexLitPacked::ATTRIBUTES, VERTEX_ENCODING_QUANTIZED_POSITIONS | VERTEX_ENCODING_OCTAHEDRAL_NORMALS);
+
+//-----VertexSkinnedPacked (VertexLitPacked, 16-bit bone indices and 8-bit weights)-----
+const VertexAttribute VertexSkinnedPacked::ATTRIBUTES[] =
+{
+	VertexAttribute("POSITION",			RDT_UNSIGNED_SHORT,	3,						true,		offsetof(VertexSkinnedPacked, m_position)),
+	VertexAttribute("COLOR",			RDT_UNSIGNED_BYTE,	4,						true,		offsetof(VertexSkinnedPacked, m_color)), 
+	VertexAttribute("UV",				RDT_HALF_FLOAT,		2,						false,		offsetof(VertexSkinnedPacked, m_texUVs)),
+	VertexAttribute("NORMAL",			RDT_SHORT,			2,						true,		offsetof(VertexSkinnedPacked, m_normal)),
+	VertexAttribute("TANGENT",			RDT_SHORT,			3,						true,		offsetof(VertexSkinnedPacked, m_tangent)),
+	VertexAttribute("BONE_IDS",			RDT_UNSIGNED_SHORT,	MAX_BONES_PER_VERTEX,	false,		offsetof(VertexSkinnedPacked, m_bones)),
+	VertexAttribute("BONE_WEIGHTS",		RDT_UNSIGNED_BYTE,	MAX_BONES_PER_VERTEX,	true,		offsetof(VertexSkinnedPacked, m_boneWeights))
+};
+
+const unsigned int VertexSkinnedPacked::NUM_ATTRIBUTES = (sizeof(ATTRIBUTES) / sizeof(VertexAttribute));
+const VertexLayout VertexSkinnedPacked::LAYOUT = VertexLayout(sizeof(VertexSkinnedPacked), NUM_ATTRIBUTES, VertexSkinnedPacked::ATTRIBUTES, VERTEX_ENCODING_QUANTIZED_POSITIONS | VERTEX_ENCODING_OCTAHEDRAL_NORMALS);
+
 //-----VertexVoxel (position, color)-----
 const VertexAttribute VertexVoxel::ATTRIBUTES[] =
 {
@@ -63,15 +93,215 @@ const VertexLayout VertexVoxel::LAYOUT = VertexLayout(sizeof(VertexVoxel), NUM_A
 //--------------------END VERTEX TYPES--------------------
 
 
+//-----Attribute Encoding-----
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the value as a half float, rounded to nearest; values out of range become infinity,
+// and ones too small for a half's subnormals zero
+//
+static uint16_t FloatToHalf(float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	uint32_t sign = (bits >> 16) & 0x8000;
+	uint32_t floatExponent = (bits >> 23) & 0xFF;
+	uint32_t mantissa = bits & 0x007FFFFF;
+
+	// Infinity and NaN stay themselves
+	if (floatExponent == 0xFF)
+	{
+		return (uint16_t) (sign | 0x7C00 | (mantissa != 0 ? 0x0200 : 0));
+	}
+
+	int exponent = (int) floatExponent - 127 + 15;
+	if (exponent >= 31)
+	{
+		return (uint16_t) (sign | 0x7C00);
+	}
+
+	if (exponent <= 0)
+	{
+		if (exponent < -10)
+		{
+			return (uint16_t) sign;
+		}
+
+		// Subnormal, so the implicit leading 1 moves into the mantissa
+		mantissa |= 0x00800000;
+		uint32_t shift = (uint32_t) (14 - exponent);
+		uint32_t half = (mantissa >> shift) + ((mantissa >> (shift - 1)) & 1);
+
+		return (uint16_t) (sign | half);
+	}
+
+	// Rounding may carry into the exponent, which is still the right result
+	uint32_t half = (sign | ((uint32_t) exponent << 10) | (mantissa >> 13)) + ((mantissa >> 12) & 1);
+	return (uint16_t) half;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the value from -1 to 1 as a signed normalized 16-bit int
+//
+static int16_t QuantizeSignedNormalized(float value)
+{
+	return (int16_t) RoundToNearestInt(ClampFloatNegativeOneToOne(value) * 32767.f);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Writes the direction folded onto the octahedron, unwrapped to a square, as signed normalized xy
+// Matches DecodeOctahedral() in the built-in shaders; a zero direction decodes to +z
+//
+static void EncodeOctahedral(const Vector3& direction, int16_t* out_encoded)
+{
+	float sum = AbsoluteValue(direction.x) + AbsoluteValue(direction.y) + AbsoluteValue(direction.z);
+	if (sum == 0.f)
+	{
+		out_encoded[0] = 0;
+		out_encoded[1] = 0;
+		return;
+	}
+
+	float x = direction.x / sum;
+	float y = direction.y / sum;
+
+	// The lower half folds out over the corners
+	if (direction.z < 0.f)
+	{
+		float foldedX = (1.f - AbsoluteValue(y)) * (x >= 0.f ? 1.f : -1.f);
+		float foldedY = (1.f - AbsoluteValue(x)) * (y >= 0.f ? 1.f : -1.f);
+		x = foldedX;
+		y = foldedY;
+	}
+
+	out_encoded[0] = QuantizeSignedNormalized(x);
+	out_encoded[1] = QuantizeSignedNormalized(y);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Writes the attributes the packed vertex types share
+//
+static void EncodePackedLitAttributes(const VertexMaster& master, uint16_t* out_position, uint16_t* out_uvs, int16_t* out_normal, int16_t* out_tangent)
+{
+	memset(out_position, 0, sizeof(uint16_t) * 4);
+
+	out_uvs[0] = FloatToHalf(master.m_uvs.x);
+	out_uvs[1] = FloatToHalf(master.m_uvs.y);
+
+	EncodeOctahedral(master.m_normal, out_normal);
+	EncodeOctahedral(master.m_tangent.xyz(), out_tangent);
+	out_tangent[2] = (master.m_tangent.w < 0.f ? -32767 : 32767);
+	out_tangent[3] = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - from the master, without the position
+//
+VertexLitPacked::VertexLitPacked(const VertexMaster& master)
+	: m_color(master.m_color)
+{
+	EncodePackedLitAttributes(master, m_position, m_texUVs, m_normal, m_tangent);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - from the master, without the position
+// Weights are rounded so they still sum to one, with the rounding error taken by the largest
+//
+VertexSkinnedPacked::VertexSkinnedPacked(const VertexMaster& master)
+	: m_color(master.m_color)
+{
+	EncodePackedLitAttributes(master, m_position, m_texUVs, m_normal, m_tangent);
+
+	float weightSum = 0.f;
+	for (int i = 0; i < MAX_BONES_PER_VERTEX; ++i)
+	{
+		weightSum += master.m_boneWeights[i];
+	}
+
+	int largestIndex = 0;
+	int quantizedSum = 0;
+	for (int i = 0; i < MAX_BONES_PER_VERTEX; ++i)
+	{
+		ASSERT_OR_DIE(master.m_boneIndices[i] <= 0xFFFF, Stringf("Error: VertexSkinnedPacked can't index bone %u", master.m_boneIndices[i]));
+		m_bones[i] = (uint16_t) master.m_boneIndices[i];
+
+		float weight = (weightSum > 0.f ? master.m_boneWeights[i] / weightSum : 0.f);
+		int quantized = ClampInt(RoundToNearestInt(weight * 255.f), 0, 255);
+		m_boneWeights[i] = (uint8_t) quantized;
+		quantizedSum += quantized;
+
+		if (master.m_boneWeights[i] > master.m_boneWeights[largestIndex])
+		{
+			largestIndex = i;
+		}
+	}
+
+	if (weightSum > 0.f)
+	{
+		m_boneWeights[largestIndex] = (uint8_t) ClampInt(m_boneWeights[largestIndex] + 255 - quantizedSum, 0, 255);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the masters' positions into the vertices' POSITION attribute, normalized 16-bit across the bounds
+//
+void QuantizeVertexPositions(const VertexLayout& layout, uint8_t* vertices, const VertexMaster* masters, unsigned int vertexCount, const AABB3& bounds)
+{
+	ASSERT_OR_DIE(layout.HasEncoding(VERTEX_ENCODING_QUANTIZED_POSITIONS), "Error: QuantizeVertexPositions() called with a layout without quantized positions");
+
+	const VertexAttribute* positionAttribute = nullptr;
+	for (unsigned int attribIndex = 0; attribIndex < layout.GetAttributeCount(); ++attribIndex)
+	{
+		if (layout.GetAttribute(attribIndex).m_name == "POSITION")
+		{
+			positionAttribute = &layout.GetAttribute(attribIndex);
+			break;
+		}
+	}
+
+	ASSERT_OR_DIE(positionAttribute != nullptr && positionAttribute->m_dataType == RDT_UNSIGNED_SHORT, "Error: QuantizeVertexPositions() needs an unsigned short POSITION attribute");
+
+	// Flat axes all quantize to 0, which decodes to the mins
+	Vector3 dimensions = bounds.GetDimensions();
+	Vector3 inverseDimensions;
+	inverseDimensions.x = (dimensions.x > 0.f ? 1.f / dimensions.x : 0.f);
+	inverseDimensions.y = (dimensions.y > 0.f ? 1.f / dimensions.y : 0.f);
+	inverseDimensions.z = (dimensions.z > 0.f ? 1.f / dimensions.z : 0.f);
+
+	unsigned int stride = layout.GetStride();
+	for (unsigned int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		Vector3 normalized = (masters[vertexIndex].m_position - bounds.mins);
+		normalized.x *= inverseDimensions.x;
+		normalized.y *= inverseDimensions.y;
+		normalized.z *= inverseDimensions.z;
+
+		uint16_t quantized[3];
+		quantized[0] = (uint16_t) RoundToNearestInt(ClampFloatZeroToOne(normalized.x) * 65535.f);
+		quantized[1] = (uint16_t) RoundToNearestInt(ClampFloatZeroToOne(normalized.y) * 65535.f);
+		quantized[2] = (uint16_t) RoundToNearestInt(ClampFloatZeroToOne(normalized.z) * 65535.f);
+
+		memcpy(vertices + vertexIndex * stride + positionAttribute->m_memberOffset, quantized, sizeof(quantized));
+	}
+}
+
+
 //-----Vertex Layout-----
 
 //-----------------------------------------------------------------------------------------------
 // Constructor
 //
-VertexLayout::VertexLayout(unsigned int stride, unsigned int numAttributes, const VertexAttribute* attributes)
+VertexLayout::VertexLayout(unsigned int stride, unsigned int numAttributes, const VertexAttribute* attributes, unsigned int encodingFlags /*= VERTEX_ENCODING_NONE*/)
 	: m_vertexStride(stride)
 	, m_numAttributes(numAttributes)
 	, m_attributes(attributes)
+	, m_encodingFlags(encodingFlags)
 {
 }
 
@@ -103,3 +333,12 @@ unsigned int VertexLayout::GetStride() const
 {
 	return m_vertexStride;
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the layout's attributes are stored with the given encoding
+//
+bool VertexLayout::HasEncoding(VertexEncodingFlag flag) const
+{
+	return ((m_encodingFlags & flag) != 0);
+}
@@ -6,7 +6,9 @@
 /************************************************************************/
 #pragma once
 #include <vector>
+#include <stdint.h>
 #include "Engine/Core/Rgba.hpp"
+#include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/Vector2.hpp"
 #include "Engine/Math/Vector3.hpp"
 #include "Engine/Math/Vector4.hpp"
@@ -14,6 +16,14 @@
 
 #define MAX_BONES_PER_VERTEX (4)
 
+// How a layout's attributes are stored, for what shaders have to undo before using them
+enum VertexEncodingFlag
+{
+	VERTEX_ENCODING_NONE					= 0,
+	VERTEX_ENCODING_QUANTIZED_POSITIONS		= (1 << 0),		// POSITION is 0 to 1 across the mesh's bounds, see Mesh::SetPositionQuantization()
+	VERTEX_ENCODING_OCTAHEDRAL_NORMALS		= (1 << 1)		// NORMAL.xy and TANGENT.xy are octahedral, TANGENT.z the tangent's w
+};
+
 //-----Description for a single attribute of a vertex, a layout is made up of a collection of these-----
 struct VertexAttribute
 {
@@ -35,11 +45,12 @@ class VertexLayout
 public:
 	//-----Public Data-----
 
-	VertexLayout(unsigned int stride, unsigned int numAttributes, const VertexAttribute* attributes);
+	VertexLayout(unsigned int stride, unsigned int numAttributes, const VertexAttribute* attributes, unsigned int encodingFlags = VERTEX_ENCODING_NONE);
 
 	unsigned int			GetAttributeCount() const;
 	const VertexAttribute&	GetAttribute(unsigned int index) const;
 	unsigned int			GetStride() const;
+	bool					HasEncoding(VertexEncodingFlag flag) const;
 
 
 private:
@@ -48,6 +59,7 @@ private:
 	const VertexAttribute*			m_attributes;
 	unsigned int					m_numAttributes;
 	unsigned int					m_vertexStride;
+	unsigned int					m_encodingFlags;
 };
 
 //--------------------VERTEX TYPES--------------------
@@ -160,6 +172,55 @@ struct VertexSkinned
 };
 
 
+//-----------------------------------------------------------------------------------------------
+// Packed Lit Vertex - VertexLit in 28 bytes instead of 52, decoded by the built-in shaders
+// Positions are left zero by the constructor, MeshBuilder::UpdateMesh() quantizes them to the mesh's bounds
+//
+struct VertexLitPacked
+{
+	// Constructors
+	VertexLitPacked() {};
+	VertexLitPacked(const VertexMaster& master);
+
+	uint16_t	m_position[4];	// Normalized across the mesh's bounds, w is padding
+	Rgba		m_color;		// Color of the Vertex
+	uint16_t	m_texUVs[2];	// Half floats
+
+	int16_t		m_normal[2];	// Octahedral
+	int16_t		m_tangent[4];	// Octahedral xy, and z is the tangent's w; w is padding
+
+	static const VertexAttribute	ATTRIBUTES[];
+	static const VertexLayout		LAYOUT;
+	static const unsigned int		NUM_ATTRIBUTES;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Packed Skinned Vertex - VertexSkinned in 40 bytes instead of 84, decoded by the built-in shaders
+// Positions are left zero by the constructor, MeshBuilder::UpdateMesh() quantizes them to the mesh's bounds
+//
+struct VertexSkinnedPacked
+{
+	// Constructors
+	VertexSkinnedPacked() {};
+	VertexSkinnedPacked(const VertexMaster& master);
+
+	uint16_t	m_position[4];	// Normalized across the mesh's bounds, w is padding
+	Rgba		m_color;		// Color of the Vertex
+	uint16_t	m_texUVs[2];	// Half floats
+
+	int16_t		m_normal[2];	// Octahedral
+	int16_t		m_tangent[4];	// Octahedral xy, and z is the tangent's w; w is padding
+
+	uint16_t	m_bones[MAX_BONES_PER_VERTEX];			// Bone indices, so skeletons can have up to 65536 bones
+	uint8_t		m_boneWeights[MAX_BONES_PER_VERTEX];	// Normalized, always summing to exactly 255
+
+	static const VertexAttribute	ATTRIBUTES[];
+	static const VertexLayout		LAYOUT;
+	static const unsigned int		NUM_ATTRIBUTES;
+};
+
+
 //-----------------------------------------------------------------------------------------------
 // Byte-aligned voxel vertex
 //
@@ -180,3 +241,10 @@ struct VertexVoxel
 	static const VertexLayout		LAYOUT;
 	static const unsigned int		NUM_ATTRIBUTES;
 };
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the masters' positions into the vertices' POSITION attribute, normalized 16-bit across the bounds
+// For layouts with VERTEX_ENCODING_QUANTIZED_POSITIONS; the mesh then decodes them with the bounds' mins and dimensions
+//
+void QuantizeVertexPositions(const VertexLayout& layout, uint8_t* vertices, const VertexMaster* masters, unsigned int vertexCount, const AABB3& bounds);
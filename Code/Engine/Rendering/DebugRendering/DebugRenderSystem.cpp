@@ -5,29 +5,52 @@
 /* Description: System that controls all debug rendering tasks
 /************************************************************************/
 #include "Engine/Core/Window.hpp"
+#include "Engine/Assets/AssetDB.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/Time/Clock.hpp"
+#include "Engine/Core/LogSystem.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Rendering/Core/Camera.hpp"
 #include "Engine/Rendering/Core/Renderer.hpp"
+#include "Engine/Rendering/Core/GPUProfiler.hpp"
+#include "Engine/Rendering/Meshes/MeshBuilder.hpp"
+#include "Engine/Rendering/Materials/MaterialInstance.hpp"
 #include "Engine/Core/Utility/StringUtils.hpp"
 #include "Engine/Core/DeveloperConsole/Command.hpp"
 #include "Engine/Core/DeveloperConsole/DevConsole.hpp"
 
 #include "Engine/Rendering/DebugRendering/DebugRenderSystem.hpp"
-#include "Engine/Rendering/DebugRendering/DebugRenderTask_Cube.hpp"
-#include "Engine/Rendering/DebugRendering/DebugRenderTask_Point.hpp"
-#include "Engine/Rendering/DebugRendering/DebugRenderTask_Basis.hpp"
-#include "Engine/Rendering/DebugRendering/DebugRenderTask_Line2D.hpp"
-#include "Engine/Rendering/DebugRendering/DebugRenderTask_Line3D.hpp"
-#include "Engine/Rendering/DebugRendering/DebugRenderTask_Quad2D.hpp"
-#include "Engine/Rendering/DebugRendering/DebugRenderTask_Quad3D.hpp"
 #include "Engine/Rendering/DebugRendering/DebugRenderTask_Text2D.hpp"
-#include "Engine/Rendering/DebugRendering/DebugRenderTask_UVSphere.hpp"
-#include "Engine/Rendering/DebugRendering/DebugRenderTask_Skeleton.hpp"
 
 // Singleton instance
 DebugRenderSystem*	DebugRenderSystem::s_instance = nullptr;
 
+// Other threads' submissions
+DebugRenderSystem::DebugThreadBuffer_t*				DebugRenderSystem::s_threadBuffers[DEBUG_RENDER_MAX_SUBMIT_THREADS];
+std::atomic<int>									DebugRenderSystem::s_threadBufferCount(0);
+std::mutex											DebugRenderSystem::s_threadBufferLock;
+thread_local DebugRenderSystem::DebugThreadBuffer_t* DebugRenderSystem::s_threadBuffer = nullptr;
+std::thread::id										DebugRenderSystem::s_mainThreadID;
+
+// Wire cubes used to be a line mesh drawn this wide
+#define DEBUG_WIRE_CUBE_LINE_WIDTH (3.0f)
+
+// One draw's worth of primitives - everything with the same camera, depth, primitive, fill, texture and
+// line width - rebuilt every frame into the same mesh, so its vertex buffer is streamed instead of remade
+struct DebugRenderBatch_t
+{
+	DebugCamera			camera = DEBUG_CAMERA_WORLD;
+	eDebugBatchDepth	depth = DEBUG_BATCH_DEPTH_TEST;
+	PrimitiveType		primitiveType = PRIMITIVE_LINES;
+	FillMode			fillMode = FILL_MODE_SOLID;
+	const Texture*		texture = nullptr;
+	float				lineWidth = 1.0f;
+
+	MeshBuilder			builder;
+	Mesh				mesh;
+	MaterialInstance*	material = nullptr;
+};
+
 // Commands
 void Command_DebugRenderClear(Command& cmd);
 void Command_DebugRenderPause(Command& cmd);
@@ -52,6 +75,21 @@ DebugRenderSystem::~DebugRenderSystem()
 {
 	delete m_screenCamera;
 	m_screenCamera = nullptr;
+
+	for (int taskIndex = 0; taskIndex < (int) m_tasks.size(); ++taskIndex)
+	{
+		delete m_tasks[taskIndex];
+	}
+
+	m_tasks.clear();
+
+	for (int batchIndex = 0; batchIndex < (int) m_batches.size(); ++batchIndex)
+	{
+		delete m_batches[batchIndex]->material;
+		delete m_batches[batchIndex];
+	}
+
+	m_batches.clear();
 }
 
 
@@ -60,9 +98,16 @@ DebugRenderSystem::~DebugRenderSystem()
 //
 void DebugRenderSystem::Initialize(Camera* worldCamera /*nullptr*/)
 {
+	// Nothing to draw with - the Draw functions do nothing without an instance
+	if (IsEngineHeadless())
+	{
+		return;
+	}
+
 	if (s_instance == nullptr)
 	{
 		s_instance = new DebugRenderSystem();
+		s_mainThreadID = std::this_thread::get_id();
 
 		Renderer* renderer = Renderer::GetInstance();
 
@@ -113,21 +158,234 @@ void DebugRenderSystem::Shutdown()
 {
 	delete s_instance;
 	s_instance = nullptr;
+
+	// Threads submitting have stopped by now
+	int bufferCount = s_threadBufferCount.load();
+	for (int bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex)
+	{
+		delete s_threadBuffers[bufferIndex];
+		s_threadBuffers[bufferIndex] = nullptr;
+	}
+
+	s_threadBufferCount = 0;
 }
 
 
 //-----------------------------------------------------------------------------------------------
 // Calls Update and Render on all tasks in the system, deleting finished tasks
+// Main thread only, as is everything other than the Draw functions
 //
 void DebugRenderSystem::UpdateAndRender()
 {
+	if (s_instance == nullptr)
+	{
+		return;
+	}
+
+	MergeThreadBuffers();
 	Update();
 	Render();
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Calls update on all current tasks
+// Adds the primitive to the list it draws from; other threads add it to their own buffer, to be
+// merged next UpdateAndRender(), so nothing takes a lock
+//
+template <typename PRIMITIVE_TYPE>
+void DebugRenderSystem::Submit(std::vector<PRIMITIVE_TYPE> DebugPrimitiveLists_t::* list, const PRIMITIVE_TYPE& primitive)
+{
+	// Headless, so shared gameplay code can draw without checking
+	if (s_instance == nullptr)
+	{
+		return;
+	}
+
+	if (IsMainThread())
+	{
+		(s_instance->m_primitives.*list).push_back(primitive);
+		return;
+	}
+
+	DebugThreadBuffer_t* buffer = GetOrCreateThreadBuffer();
+	if (buffer == nullptr)
+	{
+		return;
+	}
+
+	// Flag the write before reading which list to write, so a merge swapping the lists after
+	// either sees the flag and waits for this write, or is seen here and this writes the new list
+	// Both sides need seq cst for that, acquire/release doesn't order a store before a later load
+	buffer->isWriting.store(true, std::memory_order_seq_cst);
+	int writeIndex = buffer->writeIndex.load(std::memory_order_seq_cst);
+
+	(buffer->lists[writeIndex].*list).push_back(primitive);
+
+	buffer->isWriting.store(false, std::memory_order_release);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if called on the thread that initialized the system
+//
+bool DebugRenderSystem::IsMainThread()
+{
+	return (std::this_thread::get_id() == s_mainThreadID);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the calling thread's buffer, making it on its first submit; nullptr once every
+// buffer is taken, then the thread's primitives are dropped
+//
+DebugRenderSystem::DebugThreadBuffer_t* DebugRenderSystem::GetOrCreateThreadBuffer()
+{
+	if (s_threadBuffer != nullptr)
+	{
+		return s_threadBuffer;
+	}
+
+	static thread_local bool s_hasWarned = false;
+	std::lock_guard<std::mutex> lock(s_threadBufferLock);
+
+	int bufferCount = s_threadBufferCount.load(std::memory_order_relaxed);
+	if (bufferCount >= DEBUG_RENDER_MAX_SUBMIT_THREADS)
+	{
+		if (!s_hasWarned)
+		{
+			LogTaggedPrintf("RENDER", "DebugRenderSystem has no buffers left for another thread, its primitives won't draw");
+			s_hasWarned = true;
+		}
+
+		return nullptr;
+	}
+
+	s_threadBuffer = new DebugThreadBuffer_t();
+	s_threadBuffers[bufferCount] = s_threadBuffer;
+
+	// Published last, so the merge only reads a buffer once it's in the array
+	s_threadBufferCount.store(bufferCount + 1, std::memory_order_release);
+
+	return s_threadBuffer;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Swaps which list each thread writes, then appends the old one to the main lists once any write
+// still going into it is done; writes are a single push, so the wait is short
+//
+void DebugRenderSystem::MergeThreadBuffers()
+{
+	int bufferCount = s_threadBufferCount.load(std::memory_order_acquire);
+
+	for (int bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex)
+	{
+		DebugThreadBuffer_t* buffer = s_threadBuffers[bufferIndex];
+
+		// Only changed here, so the relaxed read is the current value
+		int readIndex = buffer->writeIndex.load(std::memory_order_relaxed);
+		buffer->writeIndex.store(1 - readIndex, std::memory_order_seq_cst);
+
+		// Seq cst to pair with the flag store and list read in Submit()
+		while (buffer->isWriting.load(std::memory_order_seq_cst))
+		{
+			std::this_thread::yield();
+		}
+
+		DebugPrimitiveLists_t& lists = buffer->lists[readIndex];
+		AppendPrimitives(lists);
+
+		for (int textIndex = 0; textIndex < (int) lists.texts2D.size(); ++textIndex)
+		{
+			const DebugText2D_t& text2D = lists.texts2D[textIndex];
+			m_tasks.push_back(new DebugRenderTask_Text2D(text2D.text, text2D.bounds, text2D.options, text2D.textHeight, text2D.alignment));
+		}
+
+		// Keeps the capacity, so a thread submitting the same each frame stops allocating
+		lists.Clear();
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Appends every element of the source to the end of the destination
+//
+template <typename PRIMITIVE_TYPE>
+static void AppendArray(std::vector<PRIMITIVE_TYPE>& destination, const std::vector<PRIMITIVE_TYPE>& source)
+{
+	destination.insert(destination.end(), source.begin(), source.end());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Appends the lists' primitives to the ones being drawn
+//
+void DebugRenderSystem::AppendPrimitives(const DebugPrimitiveLists_t& lists)
+{
+	AppendArray(m_primitives.points,	lists.points);
+	AppendArray(m_primitives.lines3D,	lists.lines3D);
+	AppendArray(m_primitives.quads3D,	lists.quads3D);
+	AppendArray(m_primitives.bases,		lists.bases);
+	AppendArray(m_primitives.spheres,	lists.spheres);
+	AppendArray(m_primitives.cubes,		lists.cubes);
+	AppendArray(m_primitives.lines2D,	lists.lines2D);
+	AppendArray(m_primitives.quads2D,	lists.quads2D);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Clears every list, keeping their capacity
+//
+void DebugRenderSystem::DebugPrimitiveLists_t::Clear()
+{
+	points.clear();
+	lines3D.clear();
+	quads3D.clear();
+	bases.clear();
+	spheres.clear();
+	cubes.clear();
+	lines2D.clear();
+	quads2D.clear();
+	texts2D.clear();
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Removes the primitives that finished last update and ages the rest, keeping the array packed
+// A primitive finishes once its time runs out, so it's still drawn the frame it does
+//
+template <typename PRIMITIVE_TYPE>
+static void UpdatePrimitives(std::vector<PRIMITIVE_TYPE>& primitives, float deltaTime)
+{
+	int keptCount = 0;
+	int primitiveCount = (int) primitives.size();
+
+	for (int primitiveIndex = 0; primitiveIndex < primitiveCount; ++primitiveIndex)
+	{
+		PRIMITIVE_TYPE& primitive = primitives[primitiveIndex];
+
+		if (primitive.state.isFinished)
+		{
+			continue;
+		}
+
+		primitive.state.timeToLive -= deltaTime;
+		primitive.state.isFinished = (primitive.state.timeToLive < 0.f);
+
+		if (keptCount != primitiveIndex)
+		{
+			primitives[keptCount] = primitive;
+		}
+
+		keptCount++;
+	}
+
+	primitives.resize(keptCount);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Calls update on all current primitives and tasks
 //
 void DebugRenderSystem::Update()
 {
@@ -136,7 +394,18 @@ void DebugRenderSystem::Update()
 		return;
 	}
 
-	// First check for finished tasks
+	float deltaTime = Clock::GetMasterDeltaTime();
+
+	UpdatePrimitives(m_primitives.points, deltaTime);
+	UpdatePrimitives(m_primitives.lines3D, deltaTime);
+	UpdatePrimitives(m_primitives.quads3D, deltaTime);
+	UpdatePrimitives(m_primitives.bases, deltaTime);
+	UpdatePrimitives(m_primitives.spheres, deltaTime);
+	UpdatePrimitives(m_primitives.cubes, deltaTime);
+	UpdatePrimitives(m_primitives.lines2D, deltaTime);
+	UpdatePrimitives(m_primitives.quads2D, deltaTime);
+
+	// Then check for finished tasks
 	for (int taskIndex = 0; taskIndex < (int) m_tasks.size(); ++taskIndex)
 	{
 		if (m_tasks[taskIndex]->IsFinished())
@@ -155,12 +424,17 @@ void DebugRenderSystem::Update()
 
 
 //-----------------------------------------------------------------------------------------------
-// Draws all current tasks to screen
+// Draws all current primitives to screen, one draw per batch, then the tasks
 //
-void DebugRenderSystem::Render() const
+void DebugRenderSystem::Render()
 {
 	if (m_renderTasks)
 	{
+		PROFILE_GPU_SCOPE("DebugRender");
+
+		BuildBatches();
+		DrawBatches();
+
 		for (int taskIndex = 0; taskIndex < (int) m_tasks.size(); ++taskIndex)
 		{
 			m_tasks[taskIndex]->Render();
@@ -169,6 +443,379 @@ void DebugRenderSystem::Render() const
 }
 
 
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the number of batches the primitive draws in for its mode, filling their depths and colors
+// XRAY draws the parts behind geometry again, darkened
+//
+static int GetPrimitivePasses(DebugRenderMode renderMode, const Rgba& drawColor, eDebugBatchDepth* out_depths, Rgba* out_colors)
+{
+	out_colors[0] = drawColor;
+
+	switch (renderMode)
+	{
+	case DEBUG_RENDER_IGNORE_DEPTH:
+		out_depths[0] = DEBUG_BATCH_DEPTH_IGNORE;
+		return 1;
+	case DEBUG_RENDER_HIDDEN:
+		out_depths[0] = DEBUG_BATCH_DEPTH_HIDDEN;
+		return 1;
+	case DEBUG_RENDER_XRAY:
+		out_depths[0] = DEBUG_BATCH_DEPTH_TEST;
+		out_depths[1] = DEBUG_BATCH_DEPTH_HIDDEN;
+		out_colors[1] = drawColor;
+		out_colors[1].ScaleRGB(DebugRenderSystem::DEFAULT_XRAY_COLOR_SCALE);
+		return 2;
+	case DEBUG_RENDER_USE_DEPTH:
+	default:
+		out_depths[0] = DEBUG_BATCH_DEPTH_TEST;
+		return 1;
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the two colors multiplied together, for primitives with colors of their own
+//
+static Rgba MultiplyColors(const Rgba& first, const Rgba& second)
+{
+	float firstRed, firstGreen, firstBlue, firstAlpha;
+	float secondRed, secondGreen, secondBlue, secondAlpha;
+	first.GetAsFloats(firstRed, firstGreen, firstBlue, firstAlpha);
+	second.GetAsFloats(secondRed, secondGreen, secondBlue, secondAlpha);
+
+	return Rgba(firstRed * secondRed, firstGreen * secondGreen, firstBlue * secondBlue, firstAlpha * secondAlpha);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Pushes the 12 edges of the box as lines
+//
+static void PushWireCube(MeshBuilder& builder, const Vector3& center, const Vector3& dimensions, const Rgba& color)
+{
+	Vector3 halfDimensions = dimensions * 0.5f;
+	Vector3 corners[8];
+
+	for (int cornerIndex = 0; cornerIndex < 8; ++cornerIndex)
+	{
+		corners[cornerIndex] = center + Vector3(
+			((cornerIndex & 1) != 0 ? halfDimensions.x : -halfDimensions.x),
+			((cornerIndex & 2) != 0 ? halfDimensions.y : -halfDimensions.y),
+			((cornerIndex & 4) != 0 ? halfDimensions.z : -halfDimensions.z));
+	}
+
+	// Corners differing in one bit share an edge
+	for (int cornerIndex = 0; cornerIndex < 8; ++cornerIndex)
+	{
+		for (int axisBit = 1; axisBit < 8; axisBit <<= 1)
+		{
+			if ((cornerIndex & axisBit) == 0)
+			{
+				builder.PushLine(corners[cornerIndex], corners[cornerIndex | axisBit], color);
+			}
+		}
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Pushes the outline of the quad as lines
+//
+static void PushWireQuad(MeshBuilder& builder, const Vector3& position, const Vector2& dimensions, const Vector3& right, const Vector3& up, const Rgba& color)
+{
+	Vector3 halfRight = right * (0.5f * dimensions.x);
+	Vector3 halfUp = up * (0.5f * dimensions.y);
+
+	Vector3 bottomLeft	= position - halfRight - halfUp;
+	Vector3 bottomRight = position + halfRight - halfUp;
+	Vector3 topRight	= position + halfRight + halfUp;
+	Vector3 topLeft		= position - halfRight + halfUp;
+
+	builder.PushLine(bottomLeft, bottomRight, color);
+	builder.PushLine(bottomRight, topRight, color);
+	builder.PushLine(topRight, topLeft, color);
+	builder.PushLine(topLeft, bottomLeft, color);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Empties every batch and pushes the geometry of every primitive into the batches it draws in
+//
+void DebugRenderSystem::BuildBatches()
+{
+	PROFILE_SCOPE_CATEGORY("DebugRenderSystem::BuildBatches", "Rendering");
+
+	for (int batchIndex = 0; batchIndex < (int) m_batches.size(); ++batchIndex)
+	{
+		DebugRenderBatch_t* batch = m_batches[batchIndex];
+
+		batch->builder.Clear();
+		batch->builder.SetOutputVertexType<Vertex3D_PCU>();
+		batch->builder.BeginBuilding(batch->primitiveType, (batch->primitiveType == PRIMITIVE_TRIANGLES));
+	}
+
+	if (m_debugTexture == nullptr)
+	{
+		m_debugTexture = AssetDB::CreateOrGetTexture("Data/Images/Debug/Debug.png");
+	}
+
+	eDebugBatchDepth depths[2];
+	Rgba colors[2];
+
+	for (int index = 0; index < (int) m_primitives.points.size(); ++index)
+	{
+		const DebugPoint_t& point = m_primitives.points[index];
+		int passCount = GetPrimitivePasses(point.state.renderMode, point.state.CalculateDrawColor(), depths, colors);
+
+		for (int passIndex = 0; passIndex < passCount; ++passIndex)
+		{
+			// Points were always drawn with the radius as the line width
+			GetBatchBuilder(DEBUG_CAMERA_WORLD, depths[passIndex], PRIMITIVE_LINES, FILL_MODE_SOLID, nullptr, point.radius).PushPoint(point.position, colors[passIndex], point.radius);
+		}
+	}
+
+	for (int index = 0; index < (int) m_primitives.lines3D.size(); ++index)
+	{
+		const DebugLine3D_t& line = m_primitives.lines3D[index];
+		int passCount = GetPrimitivePasses(line.state.renderMode, line.state.CalculateDrawColor(), depths, colors);
+
+		for (int passIndex = 0; passIndex < passCount; ++passIndex)
+		{
+			GetBatchBuilder(DEBUG_CAMERA_WORLD, depths[passIndex], PRIMITIVE_LINES, FILL_MODE_SOLID, nullptr, line.lineWidth).PushLine(line.startPosition, line.endPosition, colors[passIndex]);
+		}
+	}
+
+	for (int index = 0; index < (int) m_primitives.bases.size(); ++index)
+	{
+		const DebugBasis_t& basis = m_primitives.bases[index];
+		int passCount = GetPrimitivePasses(basis.state.renderMode, basis.state.CalculateDrawColor(), depths, colors);
+		Vector3 position = Matrix44::ExtractTranslation(basis.basis);
+
+		for (int passIndex = 0; passIndex < passCount; ++passIndex)
+		{
+			MeshBuilder& builder = GetBatchBuilder(DEBUG_CAMERA_WORLD, depths[passIndex], PRIMITIVE_LINES, FILL_MODE_SOLID, nullptr, basis.scale);
+
+			builder.PushLine(position, position + basis.basis.GetIVector().xyz() * basis.scale, MultiplyColors(Rgba::RED, colors[passIndex]));
+			builder.PushLine(position, position + basis.basis.GetJVector().xyz() * basis.scale, MultiplyColors(Rgba::DARK_GREEN, colors[passIndex]));
+			builder.PushLine(position, position + basis.basis.GetKVector().xyz() * basis.scale, MultiplyColors(Rgba::BLUE, colors[passIndex]));
+		}
+	}
+
+	for (int index = 0; index < (int) m_primitives.quads3D.size(); ++index)
+	{
+		const DebugQuad3D_t& quad = m_primitives.quads3D[index];
+		int passCount = GetPrimitivePasses(quad.state.renderMode, quad.state.CalculateDrawColor(), depths, colors);
+		const Texture* texture = (quad.state.customTexture != nullptr ? quad.state.customTexture : m_debugTexture);
+
+		for (int passIndex = 0; passIndex < passCount; ++passIndex)
+		{
+			if (quad.state.isWireFrame)
+			{
+				PushWireQuad(GetBatchBuilder(DEBUG_CAMERA_WORLD, depths[passIndex], PRIMITIVE_LINES, FILL_MODE_SOLID, nullptr, 1.0f), quad.position, quad.dimensions, quad.rightVector, quad.upVector, colors[passIndex]);
+			}
+			else
+			{
+				GetBatchBuilder(DEBUG_CAMERA_WORLD, depths[passIndex], PRIMITIVE_TRIANGLES, FILL_MODE_SOLID, texture, 1.0f).Push3DQuad(quad.position, quad.dimensions, AABB2::UNIT_SQUARE_OFFCENTER, colors[passIndex], quad.rightVector, quad.upVector);
+			}
+		}
+	}
+
+	for (int index = 0; index < (int) m_primitives.spheres.size(); ++index)
+	{
+		const DebugSphere_t& sphere = m_primitives.spheres[index];
+		int passCount = GetPrimitivePasses(sphere.state.renderMode, sphere.state.CalculateDrawColor(), depths, colors);
+
+		FillMode fillMode = (sphere.state.isWireFrame ? FILL_MODE_WIRE : FILL_MODE_SOLID);
+		const Texture* texture = (sphere.state.isWireFrame ? nullptr : m_debugTexture);
+
+		for (int passIndex = 0; passIndex < passCount; ++passIndex)
+		{
+			GetBatchBuilder(DEBUG_CAMERA_WORLD, depths[passIndex], PRIMITIVE_TRIANGLES, fillMode, texture, 1.0f).PushUVSphere(sphere.position, sphere.radius, sphere.numWedges, sphere.numSlices, colors[passIndex]);
+		}
+	}
+
+	for (int index = 0; index < (int) m_primitives.cubes.size(); ++index)
+	{
+		const DebugCube_t& cube = m_primitives.cubes[index];
+		int passCount = GetPrimitivePasses(cube.state.renderMode, cube.state.CalculateDrawColor(), depths, colors);
+
+		for (int passIndex = 0; passIndex < passCount; ++passIndex)
+		{
+			if (cube.state.isWireFrame)
+			{
+				PushWireCube(GetBatchBuilder(DEBUG_CAMERA_WORLD, depths[passIndex], PRIMITIVE_LINES, FILL_MODE_SOLID, nullptr, DEBUG_WIRE_CUBE_LINE_WIDTH), cube.position, cube.dimensions, colors[passIndex]);
+			}
+			else
+			{
+				GetBatchBuilder(DEBUG_CAMERA_WORLD, depths[passIndex], PRIMITIVE_TRIANGLES, FILL_MODE_SOLID, m_debugTexture, 1.0f).PushCube(cube.position, cube.dimensions, colors[passIndex]);
+			}
+		}
+	}
+
+	// Screen space primitives never had an xray draw, so XRAY is just depth tested
+	for (int index = 0; index < (int) m_primitives.lines2D.size(); ++index)
+	{
+		const DebugLine2D_t& line = m_primitives.lines2D[index];
+		GetPrimitivePasses(line.state.renderMode, line.state.CalculateDrawColor(), depths, colors);
+
+		// The end's color goes between its own pair of colors over the lifetime
+		float normalizedTime = (line.state.lifetime != 0.f ? (line.state.lifetime - line.state.timeToLive) / line.state.lifetime : 1.f);
+		Rgba endColor = Interpolate(line.endStartColor, line.endEndColor, normalizedTime);
+
+		MeshBuilder& builder = GetBatchBuilder(DEBUG_CAMERA_SCREEN, depths[0], PRIMITIVE_LINES, FILL_MODE_SOLID, nullptr, line.lineWidth);
+
+		builder.SetUVs(Vector2::ZERO);
+		builder.SetColor(colors[0]);
+		builder.PushVertex(Vector3(line.startPosition.x, line.startPosition.y, 0.f));
+		builder.SetColor(endColor);
+		builder.PushVertex(Vector3(line.endPosition.x, line.endPosition.y, 0.f));
+	}
+
+	for (int index = 0; index < (int) m_primitives.quads2D.size(); ++index)
+	{
+		const DebugQuad2D_t& quad = m_primitives.quads2D[index];
+		GetPrimitivePasses(quad.state.renderMode, quad.state.CalculateDrawColor(), depths, colors);
+
+		FillMode fillMode = (quad.state.isWireFrame ? FILL_MODE_WIRE : FILL_MODE_SOLID);
+		const Texture* texture = (quad.state.isWireFrame ? nullptr : m_debugTexture);
+
+		GetBatchBuilder(DEBUG_CAMERA_SCREEN, depths[0], PRIMITIVE_TRIANGLES, fillMode, texture, 1.0f).Push2DQuad(quad.bounds, AABB2::UNIT_SQUARE_OFFCENTER, colors[0]);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Draws each batch that has geometry this frame in one call - the world's before the screen's,
+// and hidden, then depth tested, then depth ignoring within each camera
+//
+void DebugRenderSystem::DrawBatches()
+{
+	Renderer* renderer = Renderer::GetInstance();
+
+	DebugCamera cameraOrder[2] = { DEBUG_CAMERA_WORLD, DEBUG_CAMERA_SCREEN };
+
+	for (int cameraIndex = 0; cameraIndex < 2; ++cameraIndex)
+	{
+		DebugCamera camera = cameraOrder[cameraIndex];
+		renderer->SetCurrentCamera(camera == DEBUG_CAMERA_WORLD ? m_worldCamera : m_screenCamera);
+
+		for (int depthIndex = 0; depthIndex < NUM_DEBUG_BATCH_DEPTHS; ++depthIndex)
+		{
+			for (int batchIndex = 0; batchIndex < (int) m_batches.size(); ++batchIndex)
+			{
+				DebugRenderBatch_t* batch = m_batches[batchIndex];
+
+				if (batch->camera != camera || batch->depth != (eDebugBatchDepth) depthIndex)
+				{
+					continue;
+				}
+
+				batch->builder.FinishBuilding();
+
+				if (batch->builder.GetVertexCount() == 0)
+				{
+					continue;
+				}
+
+				batch->builder.UpdateMesh<Vertex3D_PCU>(batch->mesh);
+
+				renderer->SetGLLineWidth(batch->lineWidth);
+				renderer->DrawMeshWithMaterial(&batch->mesh, batch->material);
+			}
+		}
+	}
+
+	renderer->SetGLLineWidth(1.0f);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the builder of the batch with the given state, making the batch and its material if
+// this is the first primitive to need one
+//
+MeshBuilder& DebugRenderSystem::GetBatchBuilder(DebugCamera camera, eDebugBatchDepth depth, PrimitiveType primitiveType, FillMode fillMode, const Texture* texture, float lineWidth)
+{
+	for (int batchIndex = 0; batchIndex < (int) m_batches.size(); ++batchIndex)
+	{
+		DebugRenderBatch_t* batch = m_batches[batchIndex];
+
+		if (batch->camera == camera && batch->depth == depth && batch->primitiveType == primitiveType 
+			&& batch->fillMode == fillMode && batch->texture == texture && batch->lineWidth == lineWidth)
+		{
+			return batch->builder;
+		}
+	}
+
+	DebugRenderBatch_t* batch = new DebugRenderBatch_t();
+	batch->camera = camera;
+	batch->depth = depth;
+	batch->primitiveType = primitiveType;
+	batch->fillMode = fillMode;
+	batch->texture = texture;
+	batch->lineWidth = lineWidth;
+
+	batch->material = new MaterialInstance(AssetDB::GetSharedMaterial("Debug_Render"));
+
+	if (texture != nullptr)
+	{
+		batch->material->SetDiffuse(texture);
+	}
+
+	Shader* shader = batch->material->GetEditableShader();
+	shader->SetFillMode(fillMode);
+
+	switch (depth)
+	{
+	case DEBUG_BATCH_DEPTH_HIDDEN:
+		shader->EnableDepth(DEPTH_TEST_GREATER, false);
+		break;
+	case DEBUG_BATCH_DEPTH_IGNORE:
+		shader->DisableDepth();
+		break;
+	case DEBUG_BATCH_DEPTH_TEST:
+	default:
+		shader->EnableDepth(DEPTH_TEST_LESS, true);
+		break;
+	}
+
+	batch->builder.SetOutputVertexType<Vertex3D_PCU>();
+	batch->builder.BeginBuilding(primitiveType, (primitiveType == PRIMITIVE_TRIANGLES));
+
+	m_batches.push_back(batch);
+	return batch->builder;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies the options the primitive draws with and starts its lifetime
+//
+void DebugRenderSystem::DebugPrimitiveState_t::Initialize(const DebugRenderOptions& options)
+{
+	startColor		= options.m_startColor;
+	endColor		= options.m_endColor;
+	lifetime		= options.m_lifetime;
+	timeToLive		= options.m_lifetime;
+	renderMode		= options.m_renderMode;
+	isWireFrame		= options.m_isWireFrame;
+	isFinished		= false;
+	customTexture	= options.m_customTexture;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the color between the start and end colors for how far through its lifetime the primitive is
+//
+Rgba DebugRenderSystem::DebugPrimitiveState_t::CalculateDrawColor() const
+{
+	float normalizedTime = 1.f;
+	if (lifetime != 0.f)
+	{
+		normalizedTime = (lifetime - timeToLive) / lifetime;
+	}
+
+	return Interpolate(startColor, endColor, normalizedTime);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Sets the 3D camera for rendering to the one specified
 //
@@ -282,6 +929,9 @@ void DebugRenderSystem::Clear()
 	}
 
 	s_instance->m_tasks.clear();
+
+	// Batches are kept, they're emptied on the next build
+	s_instance->m_primitives.Clear();
 }
 
 
@@ -306,8 +956,12 @@ DebugRenderMode DebugRenderSystem::ConvertStringToRenderMode(const std::string&
 //
 void DebugRenderSystem::DrawPoint(const Vector3& position, const DebugRenderOptions& options, float radius /*= 1.0f*/)
 {
-	DebugRenderTask_Point* point = new DebugRenderTask_Point(position, options, radius);
-	s_instance->m_tasks.push_back(point);
+	DebugPoint_t point;
+	point.state.Initialize(options);
+	point.position = position;
+	point.radius = radius;
+
+	Submit(&DebugPrimitiveLists_t::points, point);
 }
 
 
@@ -330,8 +984,13 @@ void DebugRenderSystem::DrawPoint(const Vector3& position, float lifeTime, const
 //
 void DebugRenderSystem::Draw3DLine(const Vector3& startPosition, const Vector3& endPosition, const DebugRenderOptions& options, float lineWidth /*= 1.0f*/)
 {
-	DebugRenderTask_Line3D* line = new DebugRenderTask_Line3D(startPosition, endPosition, options, lineWidth);
-	s_instance->m_tasks.push_back(line);
+	DebugLine3D_t line;
+	line.state.Initialize(options);
+	line.startPosition = startPosition;
+	line.endPosition = endPosition;
+	line.lineWidth = lineWidth;
+
+	Submit(&DebugPrimitiveLists_t::lines3D, line);
 }
 
 
@@ -355,8 +1014,14 @@ void DebugRenderSystem::Draw3DLine(const Vector3& startPosition, const Vector3&
 //
 void DebugRenderSystem::Draw3DQuad(const Vector3& position, const Vector2& dimensions, const DebugRenderOptions& options, const Vector3& rightVector /*= Vector3::DIRECTION_RIGHT*/, const Vector3& upVector /*= Vector3::DIRECTION_UP*/)
 {
-	DebugRenderTask_Quad3D* quad = new DebugRenderTask_Quad3D(position, dimensions, options, rightVector, upVector);
-	s_instance->m_tasks.push_back(quad);
+	DebugQuad3D_t quad;
+	quad.state.Initialize(options);
+	quad.position = position;
+	quad.dimensions = dimensions;
+	quad.rightVector = rightVector;
+	quad.upVector = upVector;
+
+	Submit(&DebugPrimitiveLists_t::quads3D, quad);
 }
 
 
@@ -393,8 +1058,12 @@ void DebugRenderSystem::Draw3DQuadWithNormal(const Vector3& position, const Vect
 //
 void DebugRenderSystem::DrawBasis(const Matrix44& basis, const DebugRenderOptions& options, float scale /*= 1.0f*/)
 {
-	DebugRenderTask_Basis* task = new DebugRenderTask_Basis(basis, options, scale);
-	s_instance->m_tasks.push_back(task);
+	DebugBasis_t debugBasis;
+	debugBasis.state.Initialize(options);
+	debugBasis.basis = basis;
+	debugBasis.scale = scale;
+
+	Submit(&DebugPrimitiveLists_t::bases, debugBasis);
 }
 
 
@@ -418,8 +1087,14 @@ void DebugRenderSystem::DrawBasis(const Vector3& position, const Vector3& rotati
 //
 void DebugRenderSystem::DrawUVSphere(const Vector3& position, const DebugRenderOptions& options, float radius /*= 1.0f*/, unsigned int numSlices /*= 4*/, unsigned int numWedges /*= 8*/)
 {
-	DebugRenderTask_UVSphere* sphere = new DebugRenderTask_UVSphere(position, options, radius, numSlices, numWedges);
-	s_instance->m_tasks.push_back(sphere);
+	DebugSphere_t sphere;
+	sphere.state.Initialize(options);
+	sphere.position = position;
+	sphere.radius = radius;
+	sphere.numSlices = numSlices;
+	sphere.numWedges = numWedges;
+
+	Submit(&DebugPrimitiveLists_t::spheres, sphere);
 }
 
 
@@ -443,8 +1118,12 @@ void DebugRenderSystem::DrawUVSphere(const Vector3& position, float lifetime, co
 //
 void DebugRenderSystem::DrawCube(const Vector3& position, const DebugRenderOptions& options, const Vector3& dimensions)
 {
-	DebugRenderTask_Cube* cube = new DebugRenderTask_Cube(position, options, dimensions);
-	s_instance->m_tasks.push_back(cube);
+	DebugCube_t cube;
+	cube.state.Initialize(options);
+	cube.position = position;
+	cube.dimensions = dimensions;
+
+	Submit(&DebugPrimitiveLists_t::cubes, cube);
 }
 
 
@@ -468,8 +1147,11 @@ void DebugRenderSystem::DrawCube(const Vector3& position, float lifetime, const
 //
 void DebugRenderSystem::Draw2DQuad(const AABB2& bounds, const DebugRenderOptions& options)
 {
-	DebugRenderTask_Quad2D* quad = new DebugRenderTask_Quad2D(bounds, options);
-	s_instance->m_tasks.push_back(quad);
+	DebugQuad2D_t quad;
+	quad.state.Initialize(options);
+	quad.bounds = bounds;
+
+	Submit(&DebugPrimitiveLists_t::quads2D, quad);
 }
 
 
@@ -493,8 +1175,15 @@ void DebugRenderSystem::Draw2DQuad(const AABB2& bounds, const Rgba& color, float
 //
 void DebugRenderSystem::Draw2DLine(const Vector2& startPosition, const Vector2& endPosition, const DebugRenderOptions& options, const Rgba& endStartColor, const Rgba& endEndColor, float lineWidth /*= 1.0f*/)
 {
-	DebugRenderTask_Line2D* line = new DebugRenderTask_Line2D(startPosition, endPosition, options, endStartColor, endEndColor, lineWidth);
-	s_instance->m_tasks.push_back(line);
+	DebugLine2D_t line;
+	line.state.Initialize(options);
+	line.startPosition = startPosition;
+	line.endPosition = endPosition;
+	line.endStartColor = endStartColor;
+	line.endEndColor = endEndColor;
+	line.lineWidth = lineWidth;
+
+	Submit(&DebugPrimitiveLists_t::lines2D, line);
 }
 
 
@@ -518,8 +1207,23 @@ void DebugRenderSystem::Draw2DLine(const Vector2& startPosition, const Vector2&
 //
 void DebugRenderSystem::Draw2DText(const std::string& text, const AABB2& bounds, const DebugRenderOptions& options, float textHeight /*= 50.f*/, const Vector2& alignment /*=Vector2::ZERO*/)
 {
-	DebugRenderTask_Text2D* textTask = new DebugRenderTask_Text2D(text, bounds, options, textHeight, alignment);
-	s_instance->m_tasks.push_back(textTask);
+	if (IsMainThread())
+	{
+		DebugRenderTask_Text2D* textTask = new DebugRenderTask_Text2D(text, bounds, options, textHeight, alignment);
+		s_instance->m_tasks.push_back(textTask);
+	}
+	else
+	{
+		// Tasks are made on the main thread when merged
+		DebugText2D_t text2D;
+		text2D.text = text;
+		text2D.bounds = bounds;
+		text2D.options = options;
+		text2D.textHeight = textHeight;
+		text2D.alignment = alignment;
+
+		Submit(&DebugPrimitiveLists_t::texts2D, text2D);
+	}
 }
 
 
@@ -5,11 +5,31 @@
 /* Description: System that controls all debug rendering tasks
 /************************************************************************/
 #pragma once
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <string>
+#include <vector>
 #include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/Matrix44.hpp"
 #include "Engine/Rendering/DebugRendering/DebugRenderTask.hpp"
 
 class Camera;
-class Matrix44;
+class Texture;
+class MeshBuilder;
+struct DebugRenderBatch_t;
+
+// Threads other than the main one that can submit primitives
+#define DEBUG_RENDER_MAX_SUBMIT_THREADS (64)
+
+// Depth state a batch draws with; XRAY primitives draw in both the depth tested and hidden batches
+enum eDebugBatchDepth
+{
+	DEBUG_BATCH_DEPTH_HIDDEN,		// Drawn first, so the visible parts go over it
+	DEBUG_BATCH_DEPTH_TEST,
+	DEBUG_BATCH_DEPTH_IGNORE,		// Drawn last, over everything
+	NUM_DEBUG_BATCH_DEPTHS
+};
 
 class DebugRenderSystem
 {
@@ -84,6 +104,73 @@ public:
 	static constexpr float DEFAULT_XRAY_COLOR_SCALE = 0.25f;
 
 
+private:
+	//-----Private Types-----
+
+	// Lifetime and look every primitive has, kept by value so the primitive arrays are plain data
+	struct DebugPrimitiveState_t
+	{
+		Rgba			startColor;
+		Rgba			endColor;
+		float			lifetime = 0.f;
+		float			timeToLive = 0.f;
+		DebugRenderMode	renderMode = DEBUG_RENDER_USE_DEPTH;
+		bool			isWireFrame = false;
+		bool			isFinished = false;
+		const Texture*	customTexture = nullptr;
+
+		void Initialize(const DebugRenderOptions& options);
+		Rgba CalculateDrawColor() const;
+	};
+
+	struct DebugPoint_t		{ DebugPrimitiveState_t state; Vector3 position; float radius; };
+	struct DebugLine3D_t	{ DebugPrimitiveState_t state; Vector3 startPosition; Vector3 endPosition; float lineWidth; };
+	struct DebugQuad3D_t	{ DebugPrimitiveState_t state; Vector3 position; Vector2 dimensions; Vector3 rightVector; Vector3 upVector; };
+	struct DebugBasis_t		{ DebugPrimitiveState_t state; Matrix44 basis; float scale; };
+	struct DebugSphere_t	{ DebugPrimitiveState_t state; Vector3 position; float radius; unsigned int numSlices; unsigned int numWedges; };
+	struct DebugCube_t		{ DebugPrimitiveState_t state; Vector3 position; Vector3 dimensions; };
+	struct DebugLine2D_t	{ DebugPrimitiveState_t state; Vector2 startPosition; Vector2 endPosition; Rgba endStartColor; Rgba endEndColor; float lineWidth; };
+	struct DebugQuad2D_t	{ DebugPrimitiveState_t state; AABB2 bounds; };
+
+	// Text draws as a task, so threads other than the main one only record the call
+	struct DebugText2D_t
+	{
+		std::string			text;
+		AABB2				bounds;
+		DebugRenderOptions	options;
+		float				textHeight = 50.f;
+		Vector2				alignment;
+	};
+
+	// Every type's array, for the primitives being drawn and for each thread submitting them
+	struct DebugPrimitiveLists_t
+	{
+		std::vector<DebugPoint_t>	points;
+		std::vector<DebugLine3D_t>	lines3D;
+		std::vector<DebugQuad3D_t>	quads3D;
+		std::vector<DebugBasis_t>	bases;
+		std::vector<DebugSphere_t>	spheres;
+		std::vector<DebugCube_t>	cubes;
+		std::vector<DebugLine2D_t>	lines2D;
+		std::vector<DebugQuad2D_t>	quads2D;
+		std::vector<DebugText2D_t>	texts2D;		// Only used by other threads' lists
+
+		void Clear();
+	};
+
+	// One per thread that isn't the main one, written only by it
+	// The thread writes one list while the other is merged; isWriting marks a write in progress, so the
+	// merge can swap which list is written and wait out a write that started on the old one
+	struct DebugThreadBuffer_t
+	{
+		DebugPrimitiveLists_t	lists[2];
+		std::atomic<int>		writeIndex;
+		std::atomic<bool>		isWriting;
+
+		DebugThreadBuffer_t() : writeIndex(0), isWriting(false) {}
+	};
+
+
 private:
 	//-----Private Methods-----
 
@@ -93,7 +180,22 @@ private:
 
 	// Called by UpdateAndRender()
 	void Update();
-	void Render() const;
+	void Render();
+
+	// Adds the primitive to the main thread's lists, or the calling thread's buffer if it's another - lock free
+	template <typename PRIMITIVE_TYPE>
+	static void		Submit(std::vector<PRIMITIVE_TYPE> DebugPrimitiveLists_t::* list, const PRIMITIVE_TYPE& primitive);
+	static bool		IsMainThread();
+	static DebugThreadBuffer_t* GetOrCreateThreadBuffer();
+
+	// Moves everything other threads submitted since the last call into the main lists
+	void		MergeThreadBuffers();
+	void		AppendPrimitives(const DebugPrimitiveLists_t& lists);
+
+	// Primitives are rebuilt into the batches every frame, since their colors change over their lifetimes
+	void		BuildBatches();
+	void		DrawBatches();
+	MeshBuilder& GetBatchBuilder(DebugCamera camera, eDebugBatchDepth depth, PrimitiveType primitiveType, FillMode fillMode, const Texture* texture, float lineWidth);
 
 
 private:
@@ -105,12 +207,26 @@ private:
 	bool m_updatePaused = false;
 	bool m_renderTasks = true;
 
-	// All rendering tasks currently being drawn
+	// Primitives currently being drawn, one array per type
+	DebugPrimitiveLists_t m_primitives;
+
+	// Made the first time a primitive needs them, then reused every frame
+	std::vector<DebugRenderBatch_t*> m_batches;
+	const Texture* m_debugTexture = nullptr;
+
+	// Tasks that don't batch - text
 	std::vector<DebugRenderTask*> m_tasks;
 
 	// Singleton instance
 	static DebugRenderSystem* s_instance;
 
+	// Buffers are made on a thread's first submit and kept until shutdown, so threads must stop submitting before it
+	static DebugThreadBuffer_t*				s_threadBuffers[DEBUG_RENDER_MAX_SUBMIT_THREADS];
+	static std::atomic<int>					s_threadBufferCount;
+	static std::mutex						s_threadBufferLock;			// Only taken to make a buffer
+	static thread_local DebugThreadBuffer_t* s_threadBuffer;
+	static std::thread::id					s_mainThreadID;
+
 	// Constants
 	static constexpr float CAMERA_SPAWN_DISTANCE = 10.f;
 
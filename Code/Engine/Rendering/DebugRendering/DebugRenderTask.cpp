@@ -124,7 +124,20 @@ void DebugRenderTask::SetupDrawState(DebugRenderMode modeToDraw, float colorScal
 	// Set the tint
 	float red, green, blue, alpha;
 	drawColor.GetAsFloats(red, green, blue, alpha);
-	materialToUse->SetProperty("TINT", Vector4(red, green, blue, alpha));
+	SetTint(materialToUse, Vector4(red, green, blue, alpha));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the tint property of the material, through the handle so it isn't looked up every frame
+//
+void DebugRenderTask::SetTint(Material* material, const Vector4& tint) const
+{
+	if (!material->SetProperty(m_tintHandle, tint))
+	{
+		m_tintHandle = material->GetPropertyHandle("TINT");
+		material->SetProperty(m_tintHandle, tint);
+	}
 }
 
 
@@ -6,7 +6,9 @@
 /************************************************************************/
 #pragma once
 #include "Engine/Core/Rgba.hpp"
+#include "Engine/Math/Vector4.hpp"
 #include "Engine/Rendering/Core/Renderable.hpp"
+#include "Engine/Rendering/Materials/Material.hpp"
 
 class Texture;
 class Renderable;
@@ -78,6 +80,7 @@ protected:
 
 	void SetupDrawState(DebugRenderMode modeToDraw, float colorScale = 1.0f) const;
 	Rgba CalculateDrawColor(float colorScale = 1.0f) const;
+	void SetTint(Material* material, const Vector4& tint) const;
 
 
 protected:
@@ -88,6 +91,8 @@ protected:
 
 	Renderable*			m_renderable = nullptr;
 
+	mutable MaterialPropertyHandle_t m_tintHandle;	// Resolved on the first draw, and again if the shader changes
+
 	float m_timeToLive;
 	bool m_isFinished = false;
 	bool m_deleteMesh = false;
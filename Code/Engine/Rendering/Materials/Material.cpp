@@ -16,6 +16,7 @@
 #include "Engine/Rendering/Shaders/ShaderDescription.hpp"
 #include "Engine/Rendering/Shaders/PropertyDescription.hpp"
 #include "Engine/Rendering/Materials/MaterialPropertyBlock.hpp"
+#include "Engine/Rendering/Resources/BindlessTextureTable.hpp"
 #include "Engine/Rendering/Shaders/PropertyBlockDescription.hpp"
 
 #define TEXTURE_DIFFUSE_BIND (0)
@@ -58,26 +59,19 @@ Material::~Material()
 		delete m_shader;
 	}
 
-	// Delete property blocks
-	int numBlocks = (int) m_propertyBlocks.size();
-	for (int blockIndex = 0; blockIndex < numBlocks; ++blockIndex)
-	{
-		delete m_propertyBlocks[blockIndex];
-	}
-
-	m_propertyBlocks.clear();
+	DeletePropertyBlocks();
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Loads the material from an xml file given by filepath
+// Loads the material from an xml file given by filepath, optionally streaming its textures in
 // Returns true on success, false otherwise
 //
-bool Material::LoadFromFile(const std::string& filepath)
+bool Material::LoadFromFile(const std::string& filepath, bool loadTexturesAsync /*= false*/, JobPriority texturePriority /*= JOB_PRIORITY_BACKGROUND*/)
 {
 	// Load the document
 	XMLDocument document;
-	XMLError error = document.LoadFile(filepath.c_str());
+	XMLError error = LoadXmlDocument(document, filepath);
 
 	if (error != tinyxml2::XML_SUCCESS)
 	{
@@ -114,7 +108,16 @@ bool Material::LoadFromFile(const std::string& filepath)
 			std::string textureName = ParseXmlAttribute(*currElement, "name", "Invalid");
 			bool generateMipMaps = ParseXmlAttribute(*currElement, "generateMipMaps", false);
 
-			const Texture* texture = AssetDB::CreateOrGetTexture(textureName, generateMipMaps);
+			const Texture* texture = nullptr;
+			if (loadTexturesAsync)
+			{
+				texture = AssetDB::CreateOrGetTextureAsync(textureName, generateMipMaps, texturePriority);
+			}
+			else
+			{
+				texture = AssetDB::CreateOrGetTexture(textureName, generateMipMaps);
+			}
+
 			int bindPoint = ParseXmlAttribute(*currElement, "bind", 0);
 
 			m_textures[bindPoint] = texture;
@@ -201,12 +204,39 @@ bool Material::LoadFromFile(const std::string& filepath)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Reloads the material from file, for hot reloading; textures not already loaded are loaded async
+//
+bool Material::ReloadFromFile(const std::string& filepath)
+{
+	// The shader's uniform layout may have changed since these were made
+	DeletePropertyBlocks();
+
+	return LoadFromFile(filepath, true);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the number of Material Property Blocks currently in the material
 //
 int Material::GetPropertyBlockCount() const
 {
-	return (int) m_propertyBlocks.size();
+	int blockCount = (int) m_propertyBlocks.size();
+
+	if (m_sharedBlockSource != nullptr)
+	{
+		int numSharedBlocks = m_sharedBlockSource->GetPropertyBlockCount();
+
+		for (int sharedIndex = 0; sharedIndex < numSharedBlocks; ++sharedIndex)
+		{
+			if (!IsSharedBlockOverridden(m_sharedBlockSource->GetPropertyBlock(sharedIndex)))
+			{
+				blockCount++;
+			}
+		}
+	}
+
+	return blockCount;
 }
 
 
@@ -225,16 +255,45 @@ MaterialPropertyBlock* Material::GetPropertyBlock(const char* blockName) const
 		}
 	}
 
-	return nullptr;
+	return GetSharedPropertyBlock(blockName);
 }
 
 
 //-----------------------------------------------------------------------------------------------
 // Returns the property block given by the index if it exists, nullptr otherwise
+// This material's own blocks come first, then the shared ones it hasn't overridden
 //
 MaterialPropertyBlock* Material::GetPropertyBlock(int index) const
 {
-	return m_propertyBlocks[index];
+	int numOwnBlocks = (int) m_propertyBlocks.size();
+
+	if (index < numOwnBlocks)
+	{
+		return m_propertyBlocks[index];
+	}
+
+	if (m_sharedBlockSource != nullptr)
+	{
+		int sharedIndexToFind = index - numOwnBlocks;
+		int numSharedBlocks = m_sharedBlockSource->GetPropertyBlockCount();
+
+		for (int sharedIndex = 0; sharedIndex < numSharedBlocks; ++sharedIndex)
+		{
+			MaterialPropertyBlock* sharedBlock = m_sharedBlockSource->GetPropertyBlock(sharedIndex);
+
+			if (!IsSharedBlockOverridden(sharedBlock))
+			{
+				if (sharedIndexToFind == 0)
+				{
+					return sharedBlock;
+				}
+
+				sharedIndexToFind--;
+			}
+		}
+	}
+
+	return nullptr;
 }
 
 
@@ -291,6 +350,46 @@ bool Material::IsUsingLights() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Puts the diffuse in the bindless table and its index on the shader's property, if the shader has one
+// Returns true if the shader reads the diffuse from the table, so it doesn't need binding
+//
+bool Material::UpdateBindlessDiffuse(BindlessTextureTable& table)
+{
+	const Texture* diffuse = m_textures[TEXTURE_DIFFUSE_BIND];
+	const Sampler* sampler = m_samplers[TEXTURE_DIFFUSE_BIND];
+	const ShaderDescription* shaderDescription = m_shader->GetProgram()->GetUniformDescription();
+
+	bool isUpToDate = (diffuse == m_bindlessDiffuse && sampler == m_bindlessSampler && shaderDescription == m_bindlessShaderDescription
+		&& table.GetGeneration() == m_bindlessTableGeneration);
+	if (isUpToDate)
+	{
+		return m_isDiffuseBindless;
+	}
+
+	m_bindlessDiffuse = diffuse;
+	m_bindlessSampler = sampler;
+	m_bindlessShaderDescription = shaderDescription;
+	m_bindlessTableGeneration = table.GetGeneration();
+	m_isDiffuseBindless = false;
+
+	MaterialPropertyHandle_t handle = GetPropertyHandle(BINDLESS_TEXTURE_INDEX_PROPERTY);
+	if (diffuse == nullptr || !handle.IsValid() || handle.byteSize != sizeof(int))
+	{
+		return false;
+	}
+
+	// -1 if bindless isn't supported, then the diffuse is bound as usual
+	int textureIndex = table.AddTexture(diffuse, sampler);
+	if (textureIndex >= 0)
+	{
+		m_isDiffuseBindless = SetProperty(handle, textureIndex);
+	}
+
+	return m_isDiffuseBindless;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Sets the shader of the material to the one passed, deleting the existing one if it was instanced
 //
@@ -308,12 +407,9 @@ void Material::SetShader(Shader* shader, bool isInstancedShader)
 		m_isInstancedShader = isInstancedShader;
 	
 		// Delete all MaterialPropertyBlocks - the new shader may want to use them for other layouts
-		for (int blockIndex = 0; blockIndex < (int) m_propertyBlocks.size(); ++blockIndex)
-		{
-			delete m_propertyBlocks[blockIndex];
-		}
-	
-		m_propertyBlocks.clear();
+		// The base material's blocks were laid out for its shader too, so stop sharing them
+		DeletePropertyBlocks();
+		m_sharedBlockSource = nullptr;
 	}
 }
 
@@ -399,6 +495,76 @@ void Material::SetEmissive(const Texture* emissive)
 //
 bool Material::SetProperty(const char* propertyName, const void* data, size_t byteSize)
 {
+	MaterialPropertyHandle_t handle = GetPropertyHandle(propertyName);
+
+	if (!handle.IsValid())
+	{
+		return false;
+	}
+
+	// Size is just for a check, to ensure it matches
+	ASSERT_OR_DIE(handle.byteSize == byteSize, Stringf("Error: Material::SetProperty() had size mismatch - for property \"%s\", the passed size was %i, where description size has size %i", propertyName, byteSize, handle.byteSize));
+
+	return SetProperty(handle, data, byteSize);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the resolved property to the data specified, creating its block if it hasn't been yet
+// Returns false if the handle is invalid or was resolved against a different shader program
+//
+bool Material::SetProperty(const MaterialPropertyHandle_t& handle, const void* data, size_t byteSize)
+{
+	if (!handle.IsValid() || handle.shaderDescription != m_shader->GetProgram()->GetUniformDescription())
+	{
+		return false;
+	}
+
+	ASSERT_OR_DIE(handle.byteSize == byteSize, Stringf("Error: Material::SetProperty() had size mismatch - the passed size was %i, where the handle's property has size %i", byteSize, handle.byteSize));
+
+	// Bindings are unique among a material's blocks, and there are only ever a few
+	MaterialPropertyBlock* matBlock = nullptr;
+	int numBlocks = (int) m_propertyBlocks.size();
+
+	for (int blockIndex = 0; blockIndex < numBlocks; ++blockIndex)
+	{
+		if (m_propertyBlocks[blockIndex]->GetDescription()->GetBlockBinding() == handle.blockBinding)
+		{
+			matBlock = m_propertyBlocks[blockIndex];
+			break;
+		}
+	}
+
+	// Blocks still shared with the base material are copied the first time they're written
+	if (matBlock == nullptr)
+	{
+		MaterialPropertyBlock* sharedBlock = GetSharedPropertyBlock(handle.blockBinding);
+
+		if (sharedBlock != nullptr)
+		{
+			matBlock = CopySharedPropertyBlock(sharedBlock);
+		}
+	}
+
+	// A material block doesn't exist for this description yet, so make one
+	if (matBlock == nullptr)
+	{
+		matBlock = CreatePropertyBlock(handle.shaderDescription->GetBlockDescription(handle.shaderBlockIndex));
+	}
+
+	matBlock->SetPropertyData(handle.byteOffset, data, byteSize);
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds the property on the material's shader, returning where it lives for setting it later
+//
+MaterialPropertyHandle_t Material::GetPropertyHandle(const char* propertyName) const
+{
+	MaterialPropertyHandle_t handle;
+
+	StringID propertyNameID = HashStringID(propertyName);
 	const ShaderDescription* shaderInfo = m_shader->GetProgram()->GetUniformDescription();
 	int numBlocksOnShader = (int) shaderInfo->GetBlockCount();
 
@@ -409,36 +575,20 @@ bool Material::SetProperty(const char* propertyName, const void* data, size_t by
 		// If the uniform block is an engine reserved one, continue without checking properties
 		if (blockDescription->GetBlockBinding() < ENGINE_RESERVED_UNIFORM_BLOCK_COUNT) { continue; }
 
-		const PropertyDescription* propertyDescription = blockDescription->GetPropertyDescription(propertyName);
+		const PropertyDescription* propertyDescription = blockDescription->GetPropertyDescriptionByID(propertyNameID);
 
 		if (propertyDescription != nullptr)
 		{
-			// Found the block, so get the name
-			std::string blockName = blockDescription->GetName();
-			
-			// Now get the material block associated with this description
-			MaterialPropertyBlock* matBlock = GetPropertyBlock(blockName.c_str());
-			
-			// A material block doesn't exist for this description yet, so make one
-			if (matBlock == nullptr)
-			{
-				matBlock = CreatePropertyBlock(blockDescription);
-			}
-
-			// Size is just for a check, to ensure it matches
-			size_t actualSize = propertyDescription->GetSize();
-			ASSERT_OR_DIE(actualSize == byteSize, Stringf("Error: Material::SetProperty() had size mismatch - for property \"%s\", the passed size was %i, where description size has size %i", propertyName, byteSize, actualSize));
-
-			// Offset into the block
-			size_t offset = propertyDescription->GetOffset();
-
-			// Set the data and return
-			matBlock->UpdateCPUData(offset, byteSize, data);
-			return true;
+			handle.shaderDescription = shaderInfo;
+			handle.shaderBlockIndex = blockIndex;
+			handle.blockBinding = blockDescription->GetBlockBinding();
+			handle.byteOffset = propertyDescription->GetOffset();
+			handle.byteSize = propertyDescription->GetSize();
+			break;
 		}
 	}
 
-	return false;
+	return handle;
 }
 
 
@@ -447,7 +597,28 @@ bool Material::SetProperty(const char* propertyName, const void* data, size_t by
 //
 bool Material::SetPropertyBlock(const char* blockName, const void* data, size_t byteSize)
 {
-	MaterialPropertyBlock* block = GetPropertyBlock(blockName);
+	MaterialPropertyBlock* block = nullptr;
+	int numBlocks = (int) m_propertyBlocks.size();
+
+	for (int blockIndex = 0; blockIndex < numBlocks; ++blockIndex)
+	{
+		if (m_propertyBlocks[blockIndex]->GetName() == blockName)
+		{
+			block = m_propertyBlocks[blockIndex];
+			break;
+		}
+	}
+
+	// Never write through to a shared block, the other instances would see it
+	if (block == nullptr)
+	{
+		MaterialPropertyBlock* sharedBlock = GetSharedPropertyBlock(blockName);
+
+		if (sharedBlock != nullptr)
+		{
+			block = CopySharedPropertyBlock(sharedBlock);
+		}
+	}
 
 	if (block != nullptr)
 	{
@@ -506,3 +677,100 @@ MaterialPropertyBlock* Material::CreatePropertyBlock(const PropertyBlockDescript
 	m_propertyBlocks.push_back(block);
 	return block;
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes the blocks this material owns; shared blocks belong to the base material
+//
+void Material::DeletePropertyBlocks()
+{
+	int numBlocks = (int) m_propertyBlocks.size();
+	for (int blockIndex = 0; blockIndex < numBlocks; ++blockIndex)
+	{
+		delete m_propertyBlocks[blockIndex];
+	}
+
+	m_propertyBlocks.clear();
+	m_bindlessShaderDescription = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the base material's block with the binding if this material hasn't got its own, nullptr otherwise
+//
+MaterialPropertyBlock* Material::GetSharedPropertyBlock(unsigned int blockBinding) const
+{
+	if (m_sharedBlockSource == nullptr)
+	{
+		return nullptr;
+	}
+
+	int numSharedBlocks = m_sharedBlockSource->GetPropertyBlockCount();
+
+	for (int sharedIndex = 0; sharedIndex < numSharedBlocks; ++sharedIndex)
+	{
+		MaterialPropertyBlock* sharedBlock = m_sharedBlockSource->GetPropertyBlock(sharedIndex);
+
+		if (sharedBlock->GetDescription()->GetBlockBinding() == blockBinding)
+		{
+			return (IsSharedBlockOverridden(sharedBlock) ? nullptr : sharedBlock);
+		}
+	}
+
+	return nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the base material's block with the name if this material hasn't got its own, nullptr otherwise
+//
+MaterialPropertyBlock* Material::GetSharedPropertyBlock(const char* blockName) const
+{
+	if (m_sharedBlockSource == nullptr)
+	{
+		return nullptr;
+	}
+
+	MaterialPropertyBlock* sharedBlock = m_sharedBlockSource->GetPropertyBlock(blockName);
+
+	if (sharedBlock == nullptr || IsSharedBlockOverridden(sharedBlock))
+	{
+		return nullptr;
+	}
+
+	return sharedBlock;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if one of this material's own blocks has the shared block's binding or name
+//
+bool Material::IsSharedBlockOverridden(const MaterialPropertyBlock* sharedBlock) const
+{
+	unsigned int sharedBinding = sharedBlock->GetDescription()->GetBlockBinding();
+	int numBlocks = (int) m_propertyBlocks.size();
+
+	for (int blockIndex = 0; blockIndex < numBlocks; ++blockIndex)
+	{
+		const MaterialPropertyBlock* ownBlock = m_propertyBlocks[blockIndex];
+
+		if (ownBlock->GetDescription()->GetBlockBinding() == sharedBinding || ownBlock->GetName() == sharedBlock->GetName())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies the shared block into this material's own blocks, for writing to without the other
+// instances seeing it; it goes to the UniformArena like any other block, so needs no buffer of its own
+//
+MaterialPropertyBlock* Material::CopySharedPropertyBlock(const MaterialPropertyBlock* sharedBlock)
+{
+	MaterialPropertyBlock* block = new MaterialPropertyBlock(*sharedBlock);
+	m_propertyBlocks.push_back(block);
+	return block;
+}
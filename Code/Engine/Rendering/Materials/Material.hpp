@@ -7,6 +7,8 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <stdint.h>
+#include "Engine/Core/JobSystem/Job.hpp"
 #include "Engine/Core/Utility/XmlUtilities.hpp"
 
 #define MAX_TEXTURES_SAMPLERS (10)
@@ -14,8 +16,25 @@
 class Shader;
 class Texture;
 class Sampler;
+class BindlessTextureTable;
 class MaterialPropertyBlock;
+class ShaderDescription;
 class PropertyBlockDescription;
+
+// A property resolved from its name once, so it can be set every frame without the lookup
+// Valid on any material using the shader program it was resolved against; setting fails once
+// the material's program differs (i.e. the shader changed), and the handle should be resolved again
+struct MaterialPropertyHandle_t
+{
+	const ShaderDescription*	shaderDescription = nullptr;
+	int							shaderBlockIndex = -1;		// Of the block in the shader's description
+	unsigned int				blockBinding = 0;
+	size_t						byteOffset = 0;
+	size_t						byteSize = 0;
+
+	bool IsValid() const { return shaderDescription != nullptr; }
+};
+
 class Material
 {
 public:
@@ -27,9 +46,14 @@ public:
 	Material(const std::string& name);
 	virtual ~Material();
 
-	bool LoadFromFile(const std::string& filepath);
+	bool LoadFromFile(const std::string& filepath, bool loadTexturesAsync = false, JobPriority texturePriority = JOB_PRIORITY_BACKGROUND);
+
+	// Loads the file again over this material, with its property blocks rebuilt against the (possibly reloaded) shader
+	// Properties set from code since the last load are lost
+	bool ReloadFromFile(const std::string& filepath);
 
 	// Accessors
+	// Blocks an instance hasn't written are its base material's, shared with every other instance of it
 	int GetPropertyBlockCount() const;
 	MaterialPropertyBlock* GetPropertyBlock(int index) const;
 	MaterialPropertyBlock* GetPropertyBlock(const char* blockName) const;
@@ -42,6 +66,10 @@ public:
 
 	bool IsUsingLights() const;
 
+	// For shaders with a BINDLESS_TEXTURE_INDEX_PROPERTY, adds the diffuse to the table and sets its index
+	// on the property, again only once either changes; returns false if the diffuse needs binding
+	bool UpdateBindlessDiffuse(BindlessTextureTable& table);
+
 	// Mutators
 	void SetShader(Shader* shader, bool isInstancedShader = false);
 	void SetTexture(unsigned int bindPoint, const Texture* texture);
@@ -54,6 +82,10 @@ public:
 
 	// Uniform block mutators
 	bool SetProperty(const char* propertyName, const void* data, size_t byteSize);
+	bool SetProperty(const MaterialPropertyHandle_t& handle, const void* data, size_t byteSize);
+
+	// Returns an invalid handle if the shader has no such property outside the engine reserved blocks
+	MaterialPropertyHandle_t GetPropertyHandle(const char* propertyName) const;
 
 	// Template mutators
 	template <typename T>
@@ -62,6 +94,12 @@ public:
 		return SetProperty(propertyName, &value, sizeof(T));
 	}
 
+	template <typename T>
+	bool SetProperty(const MaterialPropertyHandle_t& handle, const T& value)
+	{
+		return SetProperty(handle, &value, sizeof(T));
+	}
+
 	bool SetPropertyBlock(const char* blockName, const void* data, size_t byteSize);
 
 	template <typename T>
@@ -75,6 +113,13 @@ protected:
 	//-----Protected Methods-----
 
 	MaterialPropertyBlock* CreatePropertyBlock(const PropertyBlockDescription* blockDescription);
+	void				   DeletePropertyBlocks();
+
+	// For the copy-on-write blocks of instances
+	MaterialPropertyBlock* GetSharedPropertyBlock(unsigned int blockBinding) const;
+	MaterialPropertyBlock* GetSharedPropertyBlock(const char* blockName) const;
+	bool				   IsSharedBlockOverridden(const MaterialPropertyBlock* sharedBlock) const;
+	MaterialPropertyBlock* CopySharedPropertyBlock(const MaterialPropertyBlock* sharedBlock);
 
 
 private:
@@ -88,7 +133,17 @@ private:
 	const Texture* m_textures[MAX_TEXTURES_SAMPLERS];
 	const Sampler* m_samplers[MAX_TEXTURES_SAMPLERS];
 
-	std::vector<MaterialPropertyBlock*> m_propertyBlocks; // An array of Uniform Buffers
+	std::vector<MaterialPropertyBlock*> m_propertyBlocks; // An array of Uniform Buffers, owned by this material
+
+	// Blocks with a binding not in m_propertyBlocks are read from here, and copied in on their first write
+	const Material*	m_sharedBlockSource = nullptr;
+
+	// What the bindless index was last set for; cleared with the blocks, as the property goes with them
+	const Texture*				m_bindlessDiffuse = nullptr;
+	const Sampler*				m_bindlessSampler = nullptr;
+	const ShaderDescription*	m_bindlessShaderDescription = nullptr;
+	uint32_t					m_bindlessTableGeneration = 0;		// Indices can be reused once anything's removed
+	bool						m_isDiffuseBindless = false;
 
 };
 
@@ -49,11 +49,7 @@ void MaterialInstance::ResetToBaseMaterial()
 		m_samplers[textureIndex] = m_baseMaterial->m_samplers[textureIndex];
 	}
 
-	// Deep copy uniform blocks
-	int numBlocks = m_baseMaterial->GetPropertyBlockCount();
-	for (int blockIndex = 0; blockIndex < numBlocks; ++blockIndex)
-	{
-		MaterialPropertyBlock* copyBlock = m_baseMaterial->m_propertyBlocks[blockIndex];
-		m_propertyBlocks.push_back(new MaterialPropertyBlock(*copyBlock));
-	}
+	// Uniform blocks are shared with the base material, and only copied once this instance writes them
+	DeletePropertyBlocks();
+	m_sharedBlockSource = m_baseMaterial;
 }
@@ -4,6 +4,8 @@
 /* Date: April 23nd, 2018
 /* Description: Implementation of the MaterialPropertyBlock class
 /************************************************************************/
+#include <cstring>
+#include "Engine/Rendering/Buffers/UniformArena.hpp"
 #include "Engine/Rendering/Materials/MaterialPropertyBlock.hpp"
 #include "Engine/Rendering/Shaders/PropertyBlockDescription.hpp"
 
@@ -14,6 +16,8 @@
 MaterialPropertyBlock::MaterialPropertyBlock(const PropertyBlockDescription* description)
 	: m_description(description)
 {
+	// Sized for the whole block up front, so properties can be copied straight in
+	InitializeCPUBuffer(description->GetBlockSize());
 }
 
 
@@ -24,6 +28,7 @@ MaterialPropertyBlock::MaterialPropertyBlock(const MaterialPropertyBlock& copyBl
 {
 	const PropertyBlockDescription* description = copyBlock.GetDescription();
 	m_description = new PropertyBlockDescription(*description);
+	m_ownsDescription = true;
 
 	// need to copy this Uniform buffer's CPU data as well
 	m_bufferSize = copyBlock.m_bufferSize;
@@ -34,6 +39,19 @@ MaterialPropertyBlock::MaterialPropertyBlock(const MaterialPropertyBlock& copyBl
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+MaterialPropertyBlock::~MaterialPropertyBlock()
+{
+	if (m_ownsDescription)
+	{
+		delete m_description;
+		m_description = nullptr;
+	}
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the name of this block
 //
@@ -41,3 +59,38 @@ std::string MaterialPropertyBlock::GetName() const
 {
 	return m_description->GetName();
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies the data into the CPU buffer at the offset, growing it only if the block was set smaller
+//
+void MaterialPropertyBlock::SetPropertyData(size_t byteOffset, const void* data, size_t byteSize)
+{
+	if (byteOffset + byteSize > m_bufferSize)
+	{
+		UpdateCPUData(byteOffset, byteSize, data);
+		return;
+	}
+
+	memcpy((unsigned char*) m_cpuBuffer + byteOffset, data, byteSize);
+	m_isCPUDirty = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the block's offset in this frame's arena, writing it there if it isn't already or has
+// changed since; blocks shared by many draws are only written once a frame
+//
+size_t MaterialPropertyBlock::WriteToUniformArena()
+{
+	uint64_t frameNumber = UniformArena::GetFrameNumber();
+
+	if (m_isCPUDirty || m_arenaFrameNumber != frameNumber)
+	{
+		m_arenaOffset = UniformArena::Write(m_cpuBuffer, m_bufferSize);
+		m_arenaFrameNumber = frameNumber;
+		m_isCPUDirty = false;
+	}
+
+	return m_arenaOffset;
+}
@@ -5,7 +5,9 @@
 /* Description: Class to represent a single material Vector2 property
 /************************************************************************/
 #pragma once
+#include <string>
 #include <vector>
+#include <stdint.h>
 #include "Engine/Rendering/Buffers/UniformBuffer.hpp"
 
 class PropertyBlockDescription;
@@ -17,15 +19,27 @@ public:
 
 	MaterialPropertyBlock(const PropertyBlockDescription* description);
 	MaterialPropertyBlock(const MaterialPropertyBlock& copyBlock);
+	~MaterialPropertyBlock();
 
 	// Accessors
 	std::string						GetName() const;
 	const PropertyBlockDescription* GetDescription() const { return m_description; }
 
+	// Writes the block into this frame's UniformArena the first time it's used in the frame, or again
+	// once it's changed, returning its offset there
+	size_t							WriteToUniformArena();
+
+	// Copies a property's data in at its offset, for handles resolved ahead of time
+	void							SetPropertyData(size_t byteOffset, const void* data, size_t byteSize);
+
 
 private:
 	//-----Private Data-----
 
 	const PropertyBlockDescription* m_description; // Descriptor for this data block
+	bool							m_ownsDescription = false;		// Copies keep their own, the source's shader may be reloaded
+
+	size_t							m_arenaOffset = 0;
+	uint64_t						m_arenaFrameNumber = UINT64_MAX;	// Frame the offset is valid during
 	
 };
@@ -0,0 +1,691 @@
+/************************************************************************/
+/* File: ChunkMesher.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the ChunkMesher class
+/************************************************************************/
+#include <string.h>
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/Core/Vertex.hpp"
+#include "Engine/Rendering/Meshes/Mesh.hpp"
+#include "Engine/Core/JobSystem/JobSystem.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
+#include "Engine/Rendering/Meshes/ChunkMesher.hpp"
+
+// Chunk's blocks with a one block border taken from the neighbors, so faces on the chunk's sides can be culled
+#define CHUNK_PADDED_DIMENSION (CHUNK_DIMENSION + 2)
+#define CHUNK_PADDED_BLOCK_COUNT (CHUNK_PADDED_DIMENSION * CHUNK_PADDED_DIMENSION * CHUNK_PADDED_DIMENSION)
+
+// Chunk coordinates are packed 21 bits an axis for the chunk map's keys
+#define CHUNK_KEY_AXIS_BITS (21)
+#define CHUNK_KEY_AXIS_MASK ((1ull << CHUNK_KEY_AXIS_BITS) - 1ull)
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the index of the block in a chunk's block array
+//
+static inline int GetBlockIndex(int x, int y, int z)
+{
+	return x + y * CHUNK_DIMENSION + z * CHUNK_DIMENSION * CHUNK_DIMENSION;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the index of the block in a padded block array, with coordinates from -1 to CHUNK_DIMENSION
+//
+static inline int GetPaddedBlockIndex(int x, int y, int z)
+{
+	return (x + 1) + (y + 1) * CHUNK_PADDED_DIMENSION + (z + 1) * CHUNK_PADDED_DIMENSION * CHUNK_PADDED_DIMENSION;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the floor of numerator / CHUNK_DIMENSION, rounding negatives down instead of towards zero
+//
+static inline int FloorDivideByChunkDimension(int numerator)
+{
+	return (numerator >= 0 ? numerator / CHUNK_DIMENSION : ((numerator + 1) / CHUNK_DIMENSION) - 1);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ChunkMeshJob - meshes a snapshot of one chunk on a worker, uploaded when
+// finalized on the main thread
+///////////////////////////////////////////////////////////////////////////////
+
+class ChunkMeshJob : public Job
+{
+public:
+	//-----Public Methods-----
+
+	ChunkMeshJob(ChunkMesher* mesher, ChunkMesherChunk_t* chunk);
+
+	virtual void	Execute() override;		// Worker
+	virtual void	Finalize() override;	// Main thread
+
+
+private:
+	//-----Private Methods-----
+
+	void			MeshFaceDirection(int axis, int sign);
+	void			PushFace(int axis, int sign, int slice, int uStart, int vStart, int width, int height, uint8_t blockType);
+
+
+public:
+	//-----Public Data-----
+
+	ChunkMesher*				m_mesher = nullptr;
+	ChunkMesherChunk_t*			m_chunk = nullptr;
+	IntVector3					m_blockOrigin;
+
+	uint8_t						m_paddedBlocks[CHUNK_PADDED_BLOCK_COUNT];
+	Rgba						m_blockColors[MAX_BLOCK_TYPES];
+
+	std::vector<VertexLit>		m_vertices;
+	std::vector<unsigned int>	m_indices;
+
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - snapshots the chunk's blocks and its neighbors' bordering ones, so edits made while
+// the job runs go into the next rebuild instead of racing this one; main thread only
+//
+ChunkMeshJob::ChunkMeshJob(ChunkMesher* mesher, ChunkMesherChunk_t* chunk)
+	: m_mesher(mesher)
+	, m_chunk(chunk)
+	, m_blockOrigin(chunk->chunkCoords * CHUNK_DIMENSION)
+{
+	m_jobType = CHUNK_MESH_JOB_TYPE;
+	m_jobFlags = WORKER_FLAGS_ALL_BUT_DISK;
+
+	memset(m_paddedBlocks, BLOCK_TYPE_AIR, sizeof(m_paddedBlocks));
+	memcpy(m_blockColors, mesher->m_blockColors, sizeof(m_blockColors));
+
+	for (int z = 0; z < CHUNK_DIMENSION; ++z)
+	{
+		for (int y = 0; y < CHUNK_DIMENSION; ++y)
+		{
+			memcpy(&m_paddedBlocks[GetPaddedBlockIndex(0, y, z)], &chunk->blocks[GetBlockIndex(0, y, z)], CHUNK_DIMENSION);
+		}
+	}
+
+	// Only the face neighbors matter, edges and corners never hide a face; missing neighbors are air
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		int uAxis = (axis + 1) % 3;
+		int vAxis = (axis + 2) % 3;
+
+		for (int sign = -1; sign <= 1; sign += 2)
+		{
+			int neighborOffset[3] = { 0, 0, 0 };
+			neighborOffset[axis] = sign;
+
+			const ChunkMesherChunk_t* neighbor = mesher->GetChunk(chunk->chunkCoords + IntVector3(neighborOffset[0], neighborOffset[1], neighborOffset[2]));
+			if (neighbor == nullptr)
+			{
+				continue;
+			}
+
+			int neighborSlice = (sign > 0 ? 0 : CHUNK_DIMENSION - 1);
+			int paddedSlice = (sign > 0 ? CHUNK_DIMENSION : -1);
+
+			for (int v = 0; v < CHUNK_DIMENSION; ++v)
+			{
+				for (int u = 0; u < CHUNK_DIMENSION; ++u)
+				{
+					int neighborCoords[3];
+					neighborCoords[axis] = neighborSlice;
+					neighborCoords[uAxis] = u;
+					neighborCoords[vAxis] = v;
+
+					int paddedCoords[3];
+					paddedCoords[axis] = paddedSlice;
+					paddedCoords[uAxis] = u;
+					paddedCoords[vAxis] = v;
+
+					m_paddedBlocks[GetPaddedBlockIndex(paddedCoords[0], paddedCoords[1], paddedCoords[2])] = neighbor->blocks[GetBlockIndex(neighborCoords[0], neighborCoords[1], neighborCoords[2])];
+				}
+			}
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Meshes the snapshot, one pass for each of the six face directions
+//
+void ChunkMeshJob::Execute()
+{
+	PROFILE_SCOPE_CATEGORY("ChunkMeshJob::Execute", "Meshes");
+
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		MeshFaceDirection(axis, 1);
+		MeshFaceDirection(axis, -1);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Uploads the built vertices and indices into the chunk's mesh
+//
+void ChunkMeshJob::Finalize()
+{
+	m_mesher->UploadBuild(m_chunk, this);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Greedy meshes the faces pointing along sign * axis - each slice of the chunk gets a mask of the
+// exposed faces there, and runs of the same block type in it are grown into the largest rectangles
+// they can, first along u then along v
+//
+void ChunkMeshJob::MeshFaceDirection(int axis, int sign)
+{
+	int uAxis = (axis + 1) % 3;
+	int vAxis = (axis + 2) % 3;
+
+	uint8_t mask[CHUNK_DIMENSION * CHUNK_DIMENSION];
+
+	for (int slice = 0; slice < CHUNK_DIMENSION; ++slice)
+	{
+		// A face is exposed where a solid block is next to air in the face direction
+		for (int v = 0; v < CHUNK_DIMENSION; ++v)
+		{
+			for (int u = 0; u < CHUNK_DIMENSION; ++u)
+			{
+				int coords[3];
+				coords[axis] = slice;
+				coords[uAxis] = u;
+				coords[vAxis] = v;
+
+				uint8_t blockType = m_paddedBlocks[GetPaddedBlockIndex(coords[0], coords[1], coords[2])];
+
+				coords[axis] += sign;
+				uint8_t neighborType = m_paddedBlocks[GetPaddedBlockIndex(coords[0], coords[1], coords[2])];
+
+				mask[u + v * CHUNK_DIMENSION] = (neighborType == BLOCK_TYPE_AIR ? blockType : BLOCK_TYPE_AIR);
+			}
+		}
+
+		// Merge the mask into rectangles, clearing each one out as it's pushed
+		for (int v = 0; v < CHUNK_DIMENSION; ++v)
+		{
+			int u = 0;
+			while (u < CHUNK_DIMENSION)
+			{
+				uint8_t blockType = mask[u + v * CHUNK_DIMENSION];
+
+				if (blockType == BLOCK_TYPE_AIR)
+				{
+					u++;
+					continue;
+				}
+
+				int width = 1;
+				while (u + width < CHUNK_DIMENSION && mask[u + width + v * CHUNK_DIMENSION] == blockType)
+				{
+					width++;
+				}
+
+				int height = 1;
+				bool canGrow = true;
+				while (v + height < CHUNK_DIMENSION && canGrow)
+				{
+					for (int rowU = u; rowU < u + width; ++rowU)
+					{
+						if (mask[rowU + (v + height) * CHUNK_DIMENSION] != blockType)
+						{
+							canGrow = false;
+							break;
+						}
+					}
+
+					if (canGrow)
+					{
+						height++;
+					}
+				}
+
+				PushFace(axis, sign, slice, u, v, width, height, blockType);
+
+				for (int rowV = v; rowV < v + height; ++rowV)
+				{
+					memset(&mask[u + rowV * CHUNK_DIMENSION], BLOCK_TYPE_AIR, width);
+				}
+
+				u += width;
+			}
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Pushes one merged face, wound like MeshBuilder::Push3DQuad() so the normal is CrossProduct(up, right)
+// UVs count blocks across the face, so textures repeat once a block
+//
+void ChunkMeshJob::PushFace(int axis, int sign, int slice, int uStart, int vStart, int width, int height, uint8_t blockType)
+{
+	int uAxis = (axis + 1) % 3;
+	int vAxis = (axis + 2) % 3;
+
+	float origin[3];
+	origin[axis] = (float) (slice + (sign > 0 ? 1 : 0));
+	origin[uAxis] = (float) uStart;
+	origin[vAxis] = (float) vStart;
+
+	float uExtent[3] = { 0.f, 0.f, 0.f };
+	uExtent[uAxis] = (float) width;
+
+	float vExtent[3] = { 0.f, 0.f, 0.f };
+	vExtent[vAxis] = (float) height;
+
+	float normal[3] = { 0.f, 0.f, 0.f };
+	normal[axis] = (float) sign;
+
+	Vector3 position = Vector3(origin[0], origin[1], origin[2]) + m_blockOrigin.GetAsFloats();
+	Vector3 uOffset = Vector3(uExtent[0], uExtent[1], uExtent[2]);
+	Vector3 vOffset = Vector3(vExtent[0], vExtent[1], vExtent[2]);
+
+	// Cyclic axes give CrossProduct(v, u) == -axis, so right and up swap between the two signs
+	Vector3 right	= (sign > 0 ? vOffset : uOffset);
+	Vector3 up		= (sign > 0 ? uOffset : vOffset);
+	float rightBlocks	= (float) (sign > 0 ? height : width);
+	float upBlocks		= (float) (sign > 0 ? width : height);
+
+	Vector3 faceNormal = Vector3(normal[0], normal[1], normal[2]);
+	Vector4 tangent = Vector4(right / rightBlocks, 1.0f);
+	const Rgba& color = m_blockColors[blockType];
+
+	unsigned int index = (unsigned int) m_vertices.size();
+
+	m_vertices.push_back(VertexLit(position,				color, Vector2(0.f, 0.f),					faceNormal, tangent));
+	m_vertices.push_back(VertexLit(position + right,		color, Vector2(rightBlocks, 0.f),			faceNormal, tangent));
+	m_vertices.push_back(VertexLit(position + right + up,	color, Vector2(rightBlocks, upBlocks),		faceNormal, tangent));
+	m_vertices.push_back(VertexLit(position + up,			color, Vector2(0.f, upBlocks),				faceNormal, tangent));
+
+	m_indices.push_back(index + 0);
+	m_indices.push_back(index + 1);
+	m_indices.push_back(index + 2);
+	m_indices.push_back(index + 0);
+	m_indices.push_back(index + 2);
+	m_indices.push_back(index + 3);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ChunkMesher
+///////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+ChunkMesher::ChunkMesher()
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor - waits out any rebuilds still in flight, since they point back at their chunks
+//
+ChunkMesher::~ChunkMesher()
+{
+	JobSystem* jobSystem = JobSystem::GetInstance();
+
+	for (ChunkMesherChunk_t* chunk : m_buildingChunks)
+	{
+		jobSystem->BlockUntilJobIsFinalized(chunk->buildJobID);
+	}
+
+	for (std::map<uint64_t, ChunkMesherChunk_t*>::iterator itr = m_chunks.begin(); itr != m_chunks.end(); ++itr)
+	{
+		delete itr->second->mesh;
+		delete itr->second;
+	}
+
+	m_chunks.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the block at the world block coordinates, dirtying the chunks whose faces it could change
+//
+void ChunkMesher::SetBlock(const IntVector3& blockCoords, uint8_t blockType)
+{
+	IntVector3 chunkCoords = GetChunkCoordsForBlock(blockCoords);
+	IntVector3 localCoords = blockCoords - chunkCoords * CHUNK_DIMENSION;
+
+	ChunkMesherChunk_t* chunk = GetOrCreateChunk(chunkCoords);
+
+	uint8_t& block = chunk->blocks[GetBlockIndex(localCoords.x, localCoords.y, localCoords.z)];
+	if (block == blockType)
+	{
+		return;
+	}
+
+	block = blockType;
+	MarkChunkDirty(chunk);
+
+	// Blocks on a side of the chunk show or hide the neighbor's faces against it
+	int local[3] = { localCoords.x, localCoords.y, localCoords.z };
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		int neighborOffset[3] = { 0, 0, 0 };
+
+		if (local[axis] == 0)
+		{
+			neighborOffset[axis] = -1;
+		}
+		else if (local[axis] == CHUNK_DIMENSION - 1)
+		{
+			neighborOffset[axis] = 1;
+		}
+		else
+		{
+			continue;
+		}
+
+		MarkChunkDirty(chunkCoords + IntVector3(neighborOffset[0], neighborOffset[1], neighborOffset[2]));
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the block at the world block coordinates, air if its chunk doesn't exist
+//
+uint8_t ChunkMesher::GetBlock(const IntVector3& blockCoords) const
+{
+	IntVector3 chunkCoords = GetChunkCoordsForBlock(blockCoords);
+	const ChunkMesherChunk_t* chunk = GetChunk(chunkCoords);
+
+	if (chunk == nullptr)
+	{
+		return BLOCK_TYPE_AIR;
+	}
+
+	IntVector3 localCoords = blockCoords - chunkCoords * CHUNK_DIMENSION;
+	return chunk->blocks[GetBlockIndex(localCoords.x, localCoords.y, localCoords.z)];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the vertex color faces of the block type are built with; only affects chunks rebuilt after
+//
+void ChunkMesher::SetBlockColor(uint8_t blockType, const Rgba& color)
+{
+	m_blockColors[blockType] = color;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Uploads the finished rebuilds, up to the max per update so a burst of edits is spread across
+// frames, then queues rebuilds for the dirty chunks that don't already have one in flight
+//
+void ChunkMesher::Update()
+{
+	PROFILE_SCOPE_CATEGORY("ChunkMesher::Update", "Meshes");
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+
+	int numUploaded = 0;
+	for (int buildIndex = 0; buildIndex < (int) m_buildingChunks.size() && numUploaded < m_maxUploadsPerUpdate;)
+	{
+		ChunkMesherChunk_t* chunk = m_buildingChunks[buildIndex];
+
+		if (jobSystem->IsJobFinished(chunk->buildJobID))
+		{
+			// Already finished, so this just finalizes it; removes the chunk from the building list
+			jobSystem->BlockUntilJobIsFinalized(chunk->buildJobID);
+			numUploaded++;
+		}
+		else
+		{
+			buildIndex++;
+		}
+	}
+
+	for (int dirtyIndex = (int) m_dirtyChunks.size() - 1; dirtyIndex >= 0; --dirtyIndex)
+	{
+		ChunkMesherChunk_t* chunk = m_dirtyChunks[dirtyIndex];
+
+		// Chunks still building are rebuilt once their current one is uploaded
+		if (chunk->buildJobID == -1)
+		{
+			QueueBuild(chunk);
+
+			m_dirtyChunks[dirtyIndex] = m_dirtyChunks.back();
+			m_dirtyChunks.pop_back();
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets how many finished rebuilds Update() uploads at most
+//
+void ChunkMesher::SetMaxUploadsPerUpdate(int maxUploads)
+{
+	ASSERT_OR_DIE(maxUploads > 0, Stringf("Error: ChunkMesher::SetMaxUploadsPerUpdate() called with %i uploads", maxUploads));
+	m_maxUploadsPerUpdate = maxUploads;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Rebuilds and uploads every dirty chunk before returning, for loading screens and tools
+//
+void ChunkMesher::FinishAllBuilds()
+{
+	JobSystem* jobSystem = JobSystem::GetInstance();
+
+	while (m_buildingChunks.size() > 0 || m_dirtyChunks.size() > 0)
+	{
+		while (m_buildingChunks.size() > 0)
+		{
+			jobSystem->BlockUntilJobIsFinalized(m_buildingChunks.back()->buildJobID);
+		}
+
+		for (ChunkMesherChunk_t* chunk : m_dirtyChunks)
+		{
+			QueueBuild(chunk);
+		}
+
+		m_dirtyChunks.clear();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the mesh of the chunk at the chunk coordinates, null if it's missing, unbuilt or empty
+//
+Mesh* ChunkMesher::GetChunkMesh(const IntVector3& chunkCoords) const
+{
+	const ChunkMesherChunk_t* chunk = GetChunk(chunkCoords);
+	return (chunk != nullptr ? chunk->mesh : nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Appends the mesh of every built chunk that has faces
+//
+void ChunkMesher::GetChunkMeshes(std::vector<Mesh*>& out_meshes) const
+{
+	for (std::map<uint64_t, ChunkMesherChunk_t*>::const_iterator itr = m_chunks.begin(); itr != m_chunks.end(); ++itr)
+	{
+		if (itr->second->mesh != nullptr)
+		{
+			out_meshes.push_back(itr->second->mesh);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of chunks that have had blocks set in them
+//
+int ChunkMesher::GetChunkCount() const
+{
+	return (int) m_chunks.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of rebuilds in flight or waiting to be uploaded
+//
+int ChunkMesher::GetBuildingChunkCount() const
+{
+	return (int) m_buildingChunks.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the coordinates of the chunk containing the world block coordinates
+//
+IntVector3 ChunkMesher::GetChunkCoordsForBlock(const IntVector3& blockCoords)
+{
+	return IntVector3(FloorDivideByChunkDimension(blockCoords.x), FloorDivideByChunkDimension(blockCoords.y), FloorDivideByChunkDimension(blockCoords.z));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the chunk at the chunk coordinates, null if none exists
+//
+ChunkMesherChunk_t* ChunkMesher::GetChunk(const IntVector3& chunkCoords) const
+{
+	std::map<uint64_t, ChunkMesherChunk_t*>::const_iterator itr = m_chunks.find(GetChunkKey(chunkCoords));
+	return (itr != m_chunks.end() ? itr->second : nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the chunk at the chunk coordinates, making an empty one if none exists
+// A new chunk dirties its neighbors, as their faces against it were built facing air
+//
+ChunkMesherChunk_t* ChunkMesher::GetOrCreateChunk(const IntVector3& chunkCoords)
+{
+	ChunkMesherChunk_t* chunk = GetChunk(chunkCoords);
+
+	if (chunk == nullptr)
+	{
+		chunk = new ChunkMesherChunk_t();
+		chunk->chunkCoords = chunkCoords;
+		memset(chunk->blocks, BLOCK_TYPE_AIR, sizeof(chunk->blocks));
+
+		m_chunks[GetChunkKey(chunkCoords)] = chunk;
+
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			for (int sign = -1; sign <= 1; sign += 2)
+			{
+				int neighborOffset[3] = { 0, 0, 0 };
+				neighborOffset[axis] = sign;
+
+				MarkChunkDirty(chunkCoords + IntVector3(neighborOffset[0], neighborOffset[1], neighborOffset[2]));
+			}
+		}
+	}
+
+	return chunk;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Marks the chunk to be rebuilt next Update()
+//
+void ChunkMesher::MarkChunkDirty(ChunkMesherChunk_t* chunk)
+{
+	if (!chunk->isDirty)
+	{
+		chunk->isDirty = true;
+		m_dirtyChunks.push_back(chunk);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Marks the chunk at the chunk coordinates to be rebuilt, if it exists
+//
+void ChunkMesher::MarkChunkDirty(const IntVector3& chunkCoords)
+{
+	ChunkMesherChunk_t* chunk = GetChunk(chunkCoords);
+
+	if (chunk != nullptr)
+	{
+		MarkChunkDirty(chunk);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Snapshots the chunk into a rebuild job and queues it
+//
+void ChunkMesher::QueueBuild(ChunkMesherChunk_t* chunk)
+{
+	ASSERT_OR_DIE(chunk->buildJobID == -1, "Error: ChunkMesher::QueueBuild() called on a chunk already building");
+
+	ChunkMeshJob* job = new ChunkMeshJob(this, chunk);
+
+	chunk->isDirty = false;
+	chunk->buildJobID = JobSystem::GetInstance()->QueueJob(job);
+	m_buildingChunks.push_back(chunk);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Puts the job's vertices and indices into the chunk's mesh, deleting it if the chunk has no faces
+// Chunk meshes are stored in the MeshArena, so a rebuild only rewrites the chunk's range of it
+//
+void ChunkMesher::UploadBuild(ChunkMesherChunk_t* chunk, const ChunkMeshJob* job)
+{
+	PROFILE_SCOPE_CATEGORY("ChunkMesher::UploadBuild", "Meshes");
+
+	chunk->buildJobID = -1;
+
+	for (int buildIndex = 0; buildIndex < (int) m_buildingChunks.size(); ++buildIndex)
+	{
+		if (m_buildingChunks[buildIndex] == chunk)
+		{
+			m_buildingChunks[buildIndex] = m_buildingChunks.back();
+			m_buildingChunks.pop_back();
+			break;
+		}
+	}
+
+	if (job->m_indices.size() == 0)
+	{
+		delete chunk->mesh;
+		chunk->mesh = nullptr;
+		return;
+	}
+
+	if (chunk->mesh == nullptr)
+	{
+		chunk->mesh = new Mesh();
+		chunk->mesh->SetStoredInArena(true);
+	}
+
+	Mesh* mesh = chunk->mesh;
+	unsigned int indexCount = (unsigned int) job->m_indices.size();
+
+	mesh->SetVertices((unsigned int) job->m_vertices.size(), job->m_vertices.data());
+	mesh->SetIndices(indexCount, job->m_indices.data());
+	mesh->SetDrawInstruction(PRIMITIVE_TRIANGLES, true, 0, indexCount);
+
+	Vector3 chunkMins = job->m_blockOrigin.GetAsFloats();
+	mesh->SetBounds(AABB3(chunkMins, chunkMins + Vector3((float) CHUNK_DIMENSION)));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Packs the chunk coordinates into a map key, 21 bits an axis
+//
+uint64_t ChunkMesher::GetChunkKey(const IntVector3& chunkCoords)
+{
+	uint64_t x = ((uint64_t) (uint32_t) chunkCoords.x) & CHUNK_KEY_AXIS_MASK;
+	uint64_t y = ((uint64_t) (uint32_t) chunkCoords.y) & CHUNK_KEY_AXIS_MASK;
+	uint64_t z = ((uint64_t) (uint32_t) chunkCoords.z) & CHUNK_KEY_AXIS_MASK;
+
+	return x | (y << CHUNK_KEY_AXIS_BITS) | (z << (2 * CHUNK_KEY_AXIS_BITS));
+}
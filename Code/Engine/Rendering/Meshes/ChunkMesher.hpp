@@ -0,0 +1,98 @@
+/************************************************************************/
+/* File: ChunkMesher.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Voxel grid split into fixed-size chunks, each meshed with
+/*				greedy face merging on the job threads when its blocks
+/*				change, and uploaded to its own mesh in the MeshArena
+/************************************************************************/
+#pragma once
+#include <map>
+#include <vector>
+#include <stdint.h>
+#include "Engine/Core/Rgba.hpp"
+#include "Engine/Math/IntVector3.hpp"
+
+// Job type of every chunk rebuild
+#define CHUNK_MESH_JOB_TYPE (0x43484b4d)
+
+#define CHUNK_DIMENSION (16)	// Blocks per side of a chunk
+#define CHUNK_BLOCK_COUNT (CHUNK_DIMENSION * CHUNK_DIMENSION * CHUNK_DIMENSION)
+
+#define CHUNK_DEFAULT_MAX_UPLOADS_PER_UPDATE (8)
+
+// Block type 0 is air, every other type is solid and colored by the mesher's palette
+#define BLOCK_TYPE_AIR (0)
+#define MAX_BLOCK_TYPES (256)
+
+class Mesh;
+class ChunkMeshJob;
+
+struct ChunkMesherChunk_t
+{
+	IntVector3	chunkCoords;
+	uint8_t		blocks[CHUNK_BLOCK_COUNT];		// x + y * CHUNK_DIMENSION + z * CHUNK_DIMENSION^2
+	Mesh*		mesh = nullptr;					// Null until built, and while the chunk has no faces
+	int			buildJobID = -1;				// Rebuild in flight, -1 if none
+	bool		isDirty = false;				// Changed since the last rebuild was queued
+};
+
+
+class ChunkMesher
+{
+	friend class ChunkMeshJob;
+
+public:
+	//-----Public Methods-----
+
+	ChunkMesher();
+	~ChunkMesher();
+
+	// Blocks are addressed in world block coordinates, chunks are made as blocks are set in them
+	// Changing a block dirties its chunk, and its neighbor if the block is on their shared face
+	void			SetBlock(const IntVector3& blockCoords, uint8_t blockType);
+	uint8_t			GetBlock(const IntVector3& blockCoords) const;
+	void			SetBlockColor(uint8_t blockType, const Rgba& color);
+
+	// Queues rebuilds for the dirty chunks and uploads up to the max of the finished ones; main thread only
+	void			Update();
+	void			SetMaxUploadsPerUpdate(int maxUploads);
+
+	// Blocks until every dirty chunk is rebuilt and uploaded
+	void			FinishAllBuilds();
+
+	// Meshes are in world block coordinates, with VertexLit vertices stored in the MeshArena
+	Mesh*			GetChunkMesh(const IntVector3& chunkCoords) const;
+	void			GetChunkMeshes(std::vector<Mesh*>& out_meshes) const;
+	int				GetChunkCount() const;
+	int				GetBuildingChunkCount() const;
+
+	static IntVector3 GetChunkCoordsForBlock(const IntVector3& blockCoords);
+
+
+private:
+	//-----Private Methods-----
+
+	ChunkMesherChunk_t*	GetChunk(const IntVector3& chunkCoords) const;
+	ChunkMesherChunk_t*	GetOrCreateChunk(const IntVector3& chunkCoords);
+	void				MarkChunkDirty(ChunkMesherChunk_t* chunk);
+	void				MarkChunkDirty(const IntVector3& chunkCoords);
+	void				QueueBuild(ChunkMesherChunk_t* chunk);
+
+	// Called when a rebuild finalizes on the main thread
+	void				UploadBuild(ChunkMesherChunk_t* chunk, const ChunkMeshJob* job);
+
+	static uint64_t		GetChunkKey(const IntVector3& chunkCoords);
+
+
+private:
+	//-----Private Data-----
+
+	std::map<uint64_t, ChunkMesherChunk_t*>	m_chunks;
+	std::vector<ChunkMesherChunk_t*>		m_dirtyChunks;
+	std::vector<ChunkMesherChunk_t*>		m_buildingChunks;
+
+	Rgba	m_blockColors[MAX_BLOCK_TYPES];
+	int		m_maxUploadsPerUpdate = CHUNK_DEFAULT_MAX_UPLOADS_PER_UPDATE;
+
+};
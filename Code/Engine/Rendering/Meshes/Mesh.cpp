@@ -5,7 +5,32 @@
 /* Description: Implementation of the Mesh class
 /************************************************************************/
 #include "Engine/Rendering/Meshes/Mesh.hpp"
+#include "Engine/Rendering/Meshes/MeshArena.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/Buffers/GPUUploadQueue.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor - removes the mesh from any arena it was copied into, or stored in, and drops its uploads
+//
+Mesh::~Mesh()
+{
+	MeshArena::OnMeshDestroyed(this);
+	GPUUploadQueue::OnResourceDestroyed(this);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets whether the mesh's data lives in its layout's MeshArena rather than in its own buffers
+//
+void Mesh::SetStoredInArena(bool isStoredInArena)
+{
+	bool hasData = (m_vertexBuffer.GetSize() > 0 || m_indexBuffer.GetSize() > 0 || m_arenaVertexCount > 0 || m_arenaIndexCount > 0);
+	ASSERT_OR_DIE(!hasData, "Error: Mesh::SetStoredInArena() called on a mesh that already has data");
+	ASSERT_OR_DIE(!m_isWrittenOnGPU, "Error: Mesh::SetStoredInArena() called on a mesh written by compute shaders");
+
+	m_isStoredInArena = isStoredInArena;
+}
 
 
 //-----------------------------------------------------------------------------------------------
@@ -13,7 +38,17 @@
 //
 void Mesh::SetIndices(unsigned int indexCount, const unsigned int* indices)
 {
-	m_indexBuffer.CopyToGPU(indexCount, indices);
+	if (m_isStoredInArena)
+	{
+		MeshArena::GetOrCreateArenaForLayout(m_vertexLayout)->WriteStoredIndices(this, indexCount, indices);
+		m_arenaIndexCount = indexCount;
+	}
+	else
+	{
+		m_indexBuffer.CopyToGPU(indexCount, indices);
+	}
+
+	m_revision++;
 }
 
 
@@ -22,7 +57,10 @@ void Mesh::SetIndices(unsigned int indexCount, const unsigned int* indices)
 //
 void Mesh::SetIndicesFromGPUBuffer(unsigned int indexCount, unsigned int sourceBufferHandle)
 {
+	AssertNotStoredInArena("SetIndicesFromGPUBuffer");
+
 	m_indexBuffer.CopyFromGPUBuffer(indexCount, sourceBufferHandle);
+	m_revision++;
 }
 
 
@@ -31,8 +69,11 @@ void Mesh::SetIndicesFromGPUBuffer(unsigned int indexCount, unsigned int sourceB
 //
 void Mesh::UpdateCounts(unsigned int vertexCount, unsigned int indexCount)
 {
+	AssertNotStoredInArena("UpdateCounts");
+
 	m_vertexBuffer.SetVertexCount(vertexCount);
 	m_indexBuffer.SetIndexCount(indexCount);
+	m_revision++;
 }
 
 
@@ -41,7 +82,9 @@ void Mesh::UpdateCounts(unsigned int vertexCount, unsigned int indexCount)
 //
 void Mesh::SetDrawInstruction(PrimitiveType type, bool useIndices, unsigned int startIndex, unsigned int elementCount)
 {
+	ASSERT_OR_DIE(useIndices || !m_isStoredInArena, "Error: Mesh::SetDrawInstruction() set a mesh stored in an arena to draw without indices");
 	m_drawInstruction = DrawInstruction(type, useIndices, startIndex, elementCount);
+	m_revision++;
 }
 
 
@@ -50,7 +93,9 @@ void Mesh::SetDrawInstruction(PrimitiveType type, bool useIndices, unsigned int
 //
 void Mesh::SetDrawInstruction(DrawInstruction instruction)
 {
+	ASSERT_OR_DIE(instruction.m_usingIndices || !m_isStoredInArena, "Error: Mesh::SetDrawInstruction() set a mesh stored in an arena to draw without indices");
 	m_drawInstruction = instruction;
+	m_revision++;
 }
 
 
@@ -88,3 +133,147 @@ const VertexLayout* Mesh::GetVertexLayout() const
 {
 	return m_vertexLayout;
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the local space bounds of the mesh, used for culling
+//
+void Mesh::SetBounds(const AABB3& bounds)
+{
+	m_bounds = bounds;
+	m_hasBounds = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the local space bounds of the mesh
+//
+AABB3 Mesh::GetBounds() const
+{
+	return m_bounds;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the mesh has bounds set, false if its extents aren't known
+//
+bool Mesh::HasBounds() const
+{
+	return m_hasBounds;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets how the built-in shaders map the quantized positions back into local space
+//
+void Mesh::SetPositionQuantization(const Vector3& offset, const Vector3& scale)
+{
+	m_positionOffset = offset;
+	m_positionScale = scale;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the data the built-in shaders decode the vertices with; identity for unencoded layouts
+//
+MeshDecodeData_t Mesh::GetDecodeData() const
+{
+	MeshDecodeData_t data;
+	data.positionOffset = m_positionOffset;
+	data.positionScale = m_positionScale;
+	data.hasOctahedralNormals = (m_vertexLayout->HasEncoding(VERTEX_ENCODING_OCTAHEDRAL_NORMALS) ? 1.f : 0.f);
+
+	return data;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the revision of the mesh's data, which changes whenever its buffers are set
+//
+unsigned int Mesh::GetRevision() const
+{
+	return m_revision;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the mesh's buffers are filled by compute shaders, so they can change at any time
+//
+bool Mesh::IsWrittenOnGPU() const
+{
+	return m_isWrittenOnGPU;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the mesh's data is in its layout's MeshArena, so it has no buffers of its own
+//
+bool Mesh::IsStoredInArena() const
+{
+	return m_isStoredInArena;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns how much video memory the mesh's vertex and index buffers take
+//
+size_t Mesh::GetGPUByteCount() const
+{
+	if (m_isStoredInArena)
+	{
+		return (size_t) m_arenaVertexCount * m_vertexLayout->GetStride() + (size_t) m_arenaIndexCount * sizeof(unsigned int);
+	}
+
+	return m_vertexBuffer.GetSize() + m_indexBuffer.GetSize();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the vertices into the mesh's range of the arena for the layout
+// Changing layout moves the mesh to the new layout's arena, leaving its indices behind
+//
+void Mesh::SetArenaVertices(const VertexLayout* layout, unsigned int vertexCount, const void* vertices)
+{
+	if (layout != m_vertexLayout)
+	{
+		MeshArena::GetOrCreateArenaForLayout(m_vertexLayout)->RemoveMesh(this);
+		m_arenaIndexCount = 0;
+	}
+
+	m_vertexLayout = layout;
+	MeshArena::GetOrCreateArenaForLayout(layout)->WriteStoredVertices(this, vertexCount, vertices);
+	m_arenaVertexCount = vertexCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Swaps the upload's buffers with the mesh's own, so the old data is freed along with the upload
+//
+void Mesh::TakeUploadedBuffers(const VertexLayout* layout, unsigned int vertexCount, RenderBuffer& vertexBuffer, unsigned int indexCount, RenderBuffer* indexBuffer)
+{
+	AssertNotStoredInArena("TakeUploadedBuffers");
+
+	m_vertexBuffer.SwapStorage(vertexBuffer);
+	m_vertexBuffer.SetVertexLayout(layout);
+	m_vertexBuffer.SetVertexCount(vertexCount);
+	m_vertexLayout = layout;
+
+	if (indexBuffer != nullptr)
+	{
+		m_indexBuffer.SwapStorage(*indexBuffer);
+	}
+
+	m_indexBuffer.SetIndexCount(indexCount);
+
+	SetPositionQuantization(Vector3::ZERO, Vector3::ONES);
+	m_revision++;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Checks the mesh has buffers of its own, for the functions that work on them directly
+//
+void Mesh::AssertNotStoredInArena(const char* functionName) const
+{
+	ASSERT_OR_DIE(!m_isStoredInArena, Stringf("Error: Mesh::%s() called on a mesh stored in an arena", functionName));
+}
@@ -5,10 +5,21 @@
 /* Description: Class to represent a set of vertices/indices for rendering
 /************************************************************************/
 #pragma once
+#include "Engine/Math/AABB3.hpp"
 #include "Engine/Rendering/Buffers/IndexBuffer.hpp"
 #include "Engine/Rendering/Buffers/VertexBuffer.hpp"
 
 
+// What the built-in shaders need to decode the mesh's vertices, std140 for the mesh uniform buffer
+struct MeshDecodeData_t
+{
+	Vector3 positionOffset = Vector3::ZERO;
+	float	hasOctahedralNormals = 0.f;		// 1 when the layout's NORMAL and TANGENT are octahedral
+	Vector3 positionScale = Vector3::ONES;
+	float	padding = 0.f;
+};
+
+
 struct DrawInstruction
 {
 	DrawInstruction() {}
@@ -24,21 +35,41 @@ struct DrawInstruction
 
 class Mesh
 {
+	friend class GPUUploadQueue;
+
 public:
 	//-----Public Methods-----
 
+	~Mesh();
+
+	// Keeps the vertices and indices in the MeshArena for the layout instead of buffers of the mesh's own,
+	// so every mesh of the layout draws with the arena's VAOs; must be set before any data, and only for
+	// indexed meshes set from the CPU - vertices go in before indices, as the arena is picked by the layout
+	void SetStoredInArena(bool isStoredInArena);
+
 	// Mutators
 	void SetIndices(unsigned int indexCount,	const unsigned int* indices);
 
 	template <typename VERT_TYPE>
 	void SetVertices(unsigned int vertexCount,	const VERT_TYPE* vertices)
 	{
-		bool succeeded = m_vertexBuffer.CopyToGPU(vertexCount, vertices);
-		
-		if (succeeded)
+		if (m_isStoredInArena)
 		{
-			m_vertexLayout = &VERT_TYPE::LAYOUT;
+			SetArenaVertices(&VERT_TYPE::LAYOUT, vertexCount, vertices);
 		}
+		else
+		{
+			bool succeeded = m_vertexBuffer.CopyToGPU(vertexCount, vertices);
+
+			if (succeeded)
+			{
+				m_vertexLayout = &VERT_TYPE::LAYOUT;
+			}
+		}
+
+		// Quantized positions have to be set again for the new vertices
+		SetPositionQuantization(Vector3::ZERO, Vector3::ONES);
+		m_revision++;
 	}
 
 	void SetIndicesFromGPUBuffer(unsigned int indexCount, unsigned int sourceBufferHandle);
@@ -46,17 +77,23 @@ public:
 	template <typename VERT_TYPE>
 	void SetVerticesFromGPUBuffer(unsigned int vertexCount, unsigned int sourceBufferHandle)
 	{
+		AssertNotStoredInArena("SetVerticesFromGPUBuffer");
 		bool succeeded = m_vertexBuffer.CopyFromGPUBuffer<VERT_TYPE>(vertexCount, sourceBufferHandle);
 
 		if (succeeded)
 		{
 			m_vertexLayout = &VERT_TYPE::LAYOUT;
 		}
+
+		SetPositionQuantization(Vector3::ZERO, Vector3::ONES);
+		m_revision++;
 	}
 
 	template <typename VERT_TYPE>
 	void InitializeBuffersForCompute(unsigned int vertexBindSlot, unsigned int initialVertexCount, unsigned int indexBindSlot, unsigned int initialIndexCount)
 	{
+		AssertNotStoredInArena("InitializeBuffersForCompute");
+
 		m_vertexBuffer.Bind(vertexBindSlot);
 		m_vertexBuffer.CopyToGPU<VERT_TYPE>(initialVertexCount, nullptr);
 
@@ -64,6 +101,10 @@ public:
 
 		m_indexBuffer.Bind(indexBindSlot);
 		m_indexBuffer.CopyToGPU(initialIndexCount, nullptr);
+
+		// Compute shaders write the buffers without the mesh knowing, so copies of it can't be kept
+		m_isWrittenOnGPU = true;
+		m_revision++;
 	}
 
 	void UpdateCounts(unsigned int vertexCount, unsigned int indexCount);
@@ -71,20 +112,58 @@ public:
 	void SetDrawInstruction(DrawInstruction instruction);
 	void SetDrawInstruction(PrimitiveType type, bool useIndices, unsigned int startIndex, unsigned int elementCount);
 
+	void SetBounds(const AABB3& bounds);
+
+	// For layouts with quantized positions - the built-in shaders decode them as offset + scale * POSITION
+	void SetPositionQuantization(const Vector3& offset, const Vector3& scale);
+
 	// Accessors
 	const VertexBuffer*		GetVertexBuffer() const;
 	const IndexBuffer*		GetIndexBuffer() const;
 	DrawInstruction		GetDrawInstruction() const;
 	const VertexLayout*	GetVertexLayout() const;
+	AABB3				GetBounds() const;
+	bool				HasBounds() const;
+	MeshDecodeData_t	GetDecodeData() const;
+	unsigned int		GetRevision() const;
+	bool				IsWrittenOnGPU() const;
+	bool				IsStoredInArena() const;
+	size_t				GetGPUByteCount() const;
+
+
+private:
+	//-----Private Methods-----
+
+	void SetArenaVertices(const VertexLayout* layout, unsigned int vertexCount, const void* vertices);
+
+	// For the GPUUploadQueue - swaps in the buffers an upload was staged into, in place of the mesh's own
+	void TakeUploadedBuffers(const VertexLayout* layout, unsigned int vertexCount, RenderBuffer& vertexBuffer, unsigned int indexCount, RenderBuffer* indexBuffer);
+	void AssertNotStoredInArena(const char* functionName) const;
 
 
 private:
 	//-----Private Data-----
 
+	// Left empty for meshes stored in an arena
 	VertexBuffer		m_vertexBuffer;
 	IndexBuffer			m_indexBuffer;
 	DrawInstruction		m_drawInstruction;
 
 	const VertexLayout* m_vertexLayout = &VertexLit::LAYOUT;
 
+	// Local space bounds for culling; meshes filled on the GPU don't have any and are never culled
+	AABB3				m_bounds;
+	bool				m_hasBounds = false;
+
+	Vector3				m_positionOffset = Vector3::ZERO;
+	Vector3				m_positionScale = Vector3::ONES;
+
+	// Changes whenever the buffers or draw instruction are set, so copies (i.e. in a MeshArena) can be refreshed
+	unsigned int		m_revision = 0;
+	bool				m_isWrittenOnGPU = false;
+
+	bool				m_isStoredInArena = false;
+	unsigned int		m_arenaVertexCount = 0;
+	unsigned int		m_arenaIndexCount = 0;
+
 };
@@ -0,0 +1,425 @@
+/************************************************************************/
+/* File: MeshArena.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the MeshArena class
+/************************************************************************/
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/Core/Vertex.hpp"
+#include "Engine/Rendering/Core/Renderer.hpp"
+#include "Engine/Rendering/Meshes/Mesh.hpp"
+#include "Engine/Rendering/Meshes/MeshArena.hpp"
+#include "Engine/Rendering/Shaders/ShaderProgram.hpp"
+#include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include "Engine/Rendering/OpenGL/GLStateCache.hpp"
+
+std::vector<MeshArena*> MeshArena::s_arenas;
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the arena for meshes of the given layout, creating it on first use
+//
+MeshArena* MeshArena::GetOrCreateArenaForLayout(const VertexLayout* layout)
+{
+	int numArenas = (int) s_arenas.size();
+	for (int arenaIndex = 0; arenaIndex < numArenas; ++arenaIndex)
+	{
+		if (s_arenas[arenaIndex]->m_layout == layout)
+		{
+			return s_arenas[arenaIndex];
+		}
+	}
+
+	MeshArena* arena = new MeshArena(layout);
+	s_arenas.push_back(arena);
+
+	return arena;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes all arenas and their GPU buffers, called when the Renderer shuts down
+//
+void MeshArena::DestroyAllArenas()
+{
+	int numArenas = (int) s_arenas.size();
+	for (int arenaIndex = 0; arenaIndex < numArenas; ++arenaIndex)
+	{
+		delete s_arenas[arenaIndex];
+	}
+
+	s_arenas.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes the mesh from whichever arena holds it, so its address can be reused
+//
+void MeshArena::OnMeshDestroyed(const Mesh* mesh)
+{
+	int numArenas = (int) s_arenas.size();
+	for (int arenaIndex = 0; arenaIndex < numArenas; ++arenaIndex)
+	{
+		s_arenas[arenaIndex]->RemoveMesh(mesh);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the mesh can be drawn from an arena - it must be indexed, and its buffers must
+// only change through the mesh so the copy can be kept up to date
+// Meshes stored in an arena are always in it, though only drawable once they have data
+//
+bool MeshArena::CanMeshBeAdded(const Mesh* mesh)
+{
+	if (mesh == nullptr || mesh->IsWrittenOnGPU() || !mesh->GetDrawInstruction().m_usingIndices)
+	{
+		return false;
+	}
+
+	if (mesh->IsStoredInArena())
+	{
+		return true;
+	}
+
+	return (mesh->GetVertexBuffer()->GetVertexCount() > 0 && mesh->GetIndexBuffer()->GetIndexCount() > 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns where the mesh's copy is in the arena, copying it in first if it isn't there yet or the
+// mesh changed since it was copied
+// Returns false if the mesh can't be added
+//
+bool MeshArena::GetEntryForMesh(const Mesh* mesh, MeshArenaEntry_t& out_entry)
+{
+	if (!CanMeshBeAdded(mesh) || mesh->GetVertexLayout() != m_layout)
+	{
+		return false;
+	}
+
+	std::map<const Mesh*, MeshArenaEntry_t>::const_iterator itr = m_entries.find(mesh);
+
+	// Stored meshes write their own ranges, so there's nothing to copy
+	if (mesh->IsStoredInArena())
+	{
+		if (itr == m_entries.end() || itr->second.vertexCount == 0 || itr->second.indexCount == 0)
+		{
+			return false;
+		}
+
+		out_entry = itr->second;
+		return true;
+	}
+
+	if (itr != m_entries.end())
+	{
+		if (itr->second.revision == mesh->GetRevision())
+		{
+			out_entry = itr->second;
+			return true;
+		}
+
+		RemoveMesh(mesh);
+	}
+
+	AddMesh(mesh, out_entry);
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a VAO that reads vertices and indices from the arena and, if the program takes them,
+// instance matrices from the given buffer, set up for the program's attributes
+// The instance buffer must be the same for every call, VAOs are cached per program
+// Multi-draws need the instance matrices, single draws of programs without them use the model buffer
+//
+GLuint MeshArena::GetVAOForProgram(const ShaderProgram* program, GLuint instanceBufferHandle, bool& out_takesInstanceMatrices)
+{
+	GLuint programHandle = program->GetHandle();
+
+	std::map<GLuint, MeshArenaVAO_t>::const_iterator itr = m_vaosByProgram.find(programHandle);
+	if (itr != m_vaosByProgram.end())
+	{
+		out_takesInstanceMatrices = itr->second.takesInstanceMatrices;
+		return itr->second.vaoHandle;
+	}
+
+	MeshArenaVAO_t vao;
+	glGenVertexArrays(1, &vao.vaoHandle);
+	GL_CHECK_ERROR();
+
+	Renderer* renderer = Renderer::GetInstance();
+
+	GLStateCache::BindVertexArray(vao.vaoHandle);
+	renderer->BindVertexLayoutToProgram(program, m_layout, m_vertexBuffer->GetHandle(), m_indexBuffer->GetHandle());
+	vao.takesInstanceMatrices = renderer->BindInstanceMatricesToProgram(program, instanceBufferHandle);
+
+	m_vaosByProgram[programHandle] = vao;
+
+	out_takesInstanceMatrices = vao.takesInstanceMatrices;
+	return vao.vaoHandle;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the stored mesh's vertices into its range; a new count gets a new range at the end,
+// and the old one is reclaimed by packing
+//
+void MeshArena::WriteStoredVertices(const Mesh* mesh, unsigned int vertexCount, const void* vertices)
+{
+	MeshArenaEntry_t& entry = GetOrCreateStoredEntry(mesh);
+
+	if (entry.vertexCount != vertexCount)
+	{
+		// Zeroed first so packing to make room doesn't move the old range
+		m_liveVertexCount -= entry.vertexCount;
+		entry.vertexCount = 0;
+
+		EnsureCapacity(vertexCount, 0);
+
+		entry.baseVertex = m_vertexTop;
+		entry.vertexCount = vertexCount;
+
+		m_vertexTop += vertexCount;
+		m_liveVertexCount += vertexCount;
+	}
+
+	unsigned int vertexStride = m_layout->GetStride();
+	m_vertexBuffer->CopySubDataToGPU(vertexCount * vertexStride, vertices, entry.baseVertex * vertexStride);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the stored mesh's indices into its range, as WriteStoredVertices() does the vertices
+//
+void MeshArena::WriteStoredIndices(const Mesh* mesh, unsigned int indexCount, const unsigned int* indices)
+{
+	MeshArenaEntry_t& entry = GetOrCreateStoredEntry(mesh);
+
+	if (entry.indexCount != indexCount)
+	{
+		m_liveIndexCount -= entry.indexCount;
+		entry.indexCount = 0;
+
+		EnsureCapacity(0, indexCount);
+
+		entry.firstIndex = m_indexTop;
+		entry.indexCount = indexCount;
+
+		m_indexTop += indexCount;
+		m_liveIndexCount += indexCount;
+	}
+
+	m_indexBuffer->CopySubDataToGPU(indexCount * sizeof(unsigned int), indices, entry.firstIndex * sizeof(unsigned int));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - allocates the initial buffers
+//
+MeshArena::MeshArena(const VertexLayout* layout)
+	: m_layout(layout)
+{
+	MoveToNewBuffers(MESH_ARENA_INITIAL_VERTEX_COUNT, MESH_ARENA_INITIAL_INDEX_COUNT, false);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+MeshArena::~MeshArena()
+{
+	DestroyVAOs();
+
+	delete m_vertexBuffer;
+	m_vertexBuffer = nullptr;
+
+	delete m_indexBuffer;
+	m_indexBuffer = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies the mesh's buffers onto the end of the arena
+//
+void MeshArena::AddMesh(const Mesh* mesh, MeshArenaEntry_t& out_entry)
+{
+	unsigned int vertexCount = mesh->GetVertexBuffer()->GetVertexCount();
+	unsigned int indexCount = mesh->GetIndexBuffer()->GetIndexCount();
+
+	EnsureCapacity(vertexCount, indexCount);
+
+	unsigned int vertexStride = m_layout->GetStride();
+	unsigned int indexStride = sizeof(unsigned int);
+
+	m_vertexBuffer->CopySubDataFromGPUBuffer(vertexCount * vertexStride, mesh->GetVertexBuffer()->GetHandle(), 0, m_vertexTop * vertexStride);
+	m_indexBuffer->CopySubDataFromGPUBuffer(indexCount * indexStride, mesh->GetIndexBuffer()->GetHandle(), 0, m_indexTop * indexStride);
+
+	out_entry.mesh = mesh;
+	out_entry.revision = mesh->GetRevision();
+	out_entry.baseVertex = m_vertexTop;
+	out_entry.vertexCount = vertexCount;
+	out_entry.firstIndex = m_indexTop;
+	out_entry.indexCount = indexCount;
+
+	m_entries[mesh] = out_entry;
+
+	m_vertexTop += vertexCount;
+	m_indexTop += indexCount;
+	m_liveVertexCount += vertexCount;
+	m_liveIndexCount += indexCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the entry of a mesh stored in the arena, making an empty one the first time
+//
+MeshArenaEntry_t& MeshArena::GetOrCreateStoredEntry(const Mesh* mesh)
+{
+	std::map<const Mesh*, MeshArenaEntry_t>::iterator itr = m_entries.find(mesh);
+
+	if (itr == m_entries.end())
+	{
+		MeshArenaEntry_t entry;
+		entry.mesh = mesh;
+		entry.isStored = true;
+
+		itr = m_entries.insert(std::make_pair(mesh, entry)).first;
+	}
+
+	ASSERT_OR_DIE(itr->second.isStored, "Error: MeshArena has a copy of a mesh that's now stored in it");
+	return itr->second;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Forgets the mesh's copy, or its stored data; its range is reclaimed the next time the arena is packed
+//
+void MeshArena::RemoveMesh(const Mesh* mesh)
+{
+	std::map<const Mesh*, MeshArenaEntry_t>::iterator itr = m_entries.find(mesh);
+
+	if (itr != m_entries.end())
+	{
+		m_liveVertexCount -= itr->second.vertexCount;
+		m_liveIndexCount -= itr->second.indexCount;
+
+		m_entries.erase(itr);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Makes room at the end of the arena for the given counts
+// If removed meshes take up most of the used space the live meshes are packed together first,
+// otherwise the buffers just double until they fit
+//
+void MeshArena::EnsureCapacity(unsigned int vertexCount, unsigned int indexCount)
+{
+	if (m_vertexTop + vertexCount <= m_vertexCapacity && m_indexTop + indexCount <= m_indexCapacity)
+	{
+		return;
+	}
+
+	bool shouldPack = ((m_vertexTop - m_liveVertexCount) > m_liveVertexCount || (m_indexTop - m_liveIndexCount) > m_liveIndexCount);
+
+	unsigned int requiredVertexCount = (shouldPack ? m_liveVertexCount : m_vertexTop) + vertexCount;
+	unsigned int requiredIndexCount = (shouldPack ? m_liveIndexCount : m_indexTop) + indexCount;
+
+	unsigned int newVertexCapacity = m_vertexCapacity;
+	unsigned int newIndexCapacity = m_indexCapacity;
+
+	while (newVertexCapacity < requiredVertexCount)
+	{
+		newVertexCapacity *= 2;
+	}
+
+	while (newIndexCapacity < requiredIndexCount)
+	{
+		newIndexCapacity *= 2;
+	}
+
+	MoveToNewBuffers(newVertexCapacity, newIndexCapacity, shouldPack);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Replaces the buffers with ones of the given capacities, copying the existing contents across
+// on the GPU; when packing, live meshes are moved down over the ranges of removed ones
+// VAOs point at the old buffers, so they're all recreated on next use
+//
+void MeshArena::MoveToNewBuffers(unsigned int vertexCapacity, unsigned int indexCapacity, bool packEntries)
+{
+	unsigned int vertexStride = m_layout->GetStride();
+	unsigned int indexStride = sizeof(unsigned int);
+
+	RenderBuffer* newVertexBuffer = new RenderBuffer();
+	RenderBuffer* newIndexBuffer = new RenderBuffer();
+
+	newVertexBuffer->AllocateOnGPU(vertexCapacity * vertexStride);
+	newIndexBuffer->AllocateOnGPU(indexCapacity * indexStride);
+
+	if (m_vertexBuffer != nullptr)
+	{
+		if (packEntries)
+		{
+			unsigned int vertexTop = 0;
+			unsigned int indexTop = 0;
+
+			std::map<const Mesh*, MeshArenaEntry_t>::iterator itr = m_entries.begin();
+			for (itr; itr != m_entries.end(); ++itr)
+			{
+				MeshArenaEntry_t& entry = itr->second;
+
+				newVertexBuffer->CopySubDataFromGPUBuffer(entry.vertexCount * vertexStride, m_vertexBuffer->GetHandle(), entry.baseVertex * vertexStride, vertexTop * vertexStride);
+				newIndexBuffer->CopySubDataFromGPUBuffer(entry.indexCount * indexStride, m_indexBuffer->GetHandle(), entry.firstIndex * indexStride, indexTop * indexStride);
+
+				entry.baseVertex = vertexTop;
+				entry.firstIndex = indexTop;
+
+				vertexTop += entry.vertexCount;
+				indexTop += entry.indexCount;
+			}
+
+			m_vertexTop = vertexTop;
+			m_indexTop = indexTop;
+		}
+		else
+		{
+			newVertexBuffer->CopySubDataFromGPUBuffer(m_vertexTop * vertexStride, m_vertexBuffer->GetHandle(), 0, 0);
+			newIndexBuffer->CopySubDataFromGPUBuffer(m_indexTop * indexStride, m_indexBuffer->GetHandle(), 0, 0);
+		}
+
+		delete m_vertexBuffer;
+		delete m_indexBuffer;
+	}
+
+	m_vertexBuffer = newVertexBuffer;
+	m_indexBuffer = newIndexBuffer;
+	m_vertexCapacity = vertexCapacity;
+	m_indexCapacity = indexCapacity;
+
+	DestroyVAOs();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes all VAOs made for the arena's current buffers
+//
+void MeshArena::DestroyVAOs()
+{
+	std::map<GLuint, MeshArenaVAO_t>::iterator itr = m_vaosByProgram.begin();
+	for (itr; itr != m_vaosByProgram.end(); ++itr)
+	{
+		GLuint vaoHandle = itr->second.vaoHandle;
+
+		if (vaoHandle != NULL)
+		{
+			glDeleteVertexArrays(1, &vaoHandle);
+			GLStateCache::OnVertexArrayDeleted(vaoHandle);
+		}
+	}
+
+	m_vaosByProgram.clear();
+}
@@ -0,0 +1,98 @@
+/************************************************************************/
+/* File: MeshArena.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Shared vertex/index buffers that meshes of one vertex
+/*				layout are copied or stored into, so many meshes can be
+/*				drawn with one VAO, or all in a single multi-draw
+/************************************************************************/
+#pragma once
+#include <map>
+#include <vector>
+#include "Engine/Rendering/Buffers/RenderBuffer.hpp"
+
+class Mesh;
+class VertexLayout;
+class ShaderProgram;
+
+// VAO for one program, which may or may not read the instance matrices
+struct MeshArenaVAO_t
+{
+	GLuint	vaoHandle = NULL;
+	bool	takesInstanceMatrices = false;
+};
+
+// Initial sizes of an arena's buffers, which double as needed
+#define MESH_ARENA_INITIAL_VERTEX_COUNT (64 * 1024)
+#define MESH_ARENA_INITIAL_INDEX_COUNT (192 * 1024)
+
+// Where a mesh's copy lives in its arena; indices are relative to baseVertex, as in the mesh
+struct MeshArenaEntry_t
+{
+	const Mesh*		mesh = nullptr;
+	bool			isStored = false;	// The arena holds the mesh's only copy, written by the mesh itself
+	unsigned int	revision = 0;
+	unsigned int	baseVertex = 0;
+	unsigned int	vertexCount = 0;
+	unsigned int	firstIndex = 0;
+	unsigned int	indexCount = 0;
+};
+
+
+class MeshArena
+{
+public:
+	//-----Public Methods-----
+
+	// Arenas are shared per vertex layout, render thread only
+	static MeshArena*	GetOrCreateArenaForLayout(const VertexLayout* layout);
+	static void			DestroyAllArenas();
+	static void			OnMeshDestroyed(const Mesh* mesh);
+	static bool			CanMeshBeAdded(const Mesh* mesh);
+
+	bool				GetEntryForMesh(const Mesh* mesh, MeshArenaEntry_t& out_entry);
+	GLuint				GetVAOForProgram(const ShaderProgram* program, GLuint instanceBufferHandle, bool& out_takesInstanceMatrices);
+
+	// For meshes stored in the arena - writes their data into their ranges, moving to new ranges when the counts change
+	void				WriteStoredVertices(const Mesh* mesh, unsigned int vertexCount, const void* vertices);
+	void				WriteStoredIndices(const Mesh* mesh, unsigned int indexCount, const unsigned int* indices);
+	void				RemoveMesh(const Mesh* mesh);
+
+
+private:
+	//-----Private Methods-----
+
+	explicit MeshArena(const VertexLayout* layout);
+	~MeshArena();
+	MeshArena(const MeshArena& copy) = delete;
+
+	void				AddMesh(const Mesh* mesh, MeshArenaEntry_t& out_entry);
+	MeshArenaEntry_t&	GetOrCreateStoredEntry(const Mesh* mesh);
+
+	void				EnsureCapacity(unsigned int vertexCount, unsigned int indexCount);
+	void				MoveToNewBuffers(unsigned int vertexCapacity, unsigned int indexCapacity, bool packEntries);
+	void				DestroyVAOs();
+
+
+private:
+	//-----Private Data-----
+
+	const VertexLayout*		m_layout = nullptr;
+
+	RenderBuffer*			m_vertexBuffer = nullptr;
+	RenderBuffer*			m_indexBuffer = nullptr;
+
+	// Meshes are only ever appended, ranges freed by removed meshes are reclaimed by packing when the buffers fill
+	unsigned int			m_vertexCapacity = 0;
+	unsigned int			m_indexCapacity = 0;
+	unsigned int			m_vertexTop = 0;
+	unsigned int			m_indexTop = 0;
+	unsigned int			m_liveVertexCount = 0;
+	unsigned int			m_liveIndexCount = 0;
+
+	std::map<const Mesh*, MeshArenaEntry_t>		m_entries;
+	std::map<GLuint, MeshArenaVAO_t>			m_vaosByProgram;
+
+	static std::vector<MeshArena*>				s_arenas;
+
+};
@@ -4,22 +4,28 @@
 /* Date: March 25th, 2018
 /* Description: Implementation of the MeshBuilder class
 /************************************************************************/
+#include <math.h>
 #include "Game/Framework/EngineBuildPreferences.hpp"
 #include "Engine/Core/File.hpp"
+#include "Engine/Core/LogSystem.hpp"
 #include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Rendering/Meshes/MeshBuilder.hpp"
+#include "Engine/Core/JobSystem/ParallelFor.hpp"
 #include "ThirdParty/mikkt/mikktspace.h"
 
+// Work per job when generating normals and tangents
+#define MESH_NORMAL_FACES_PER_JOB (4096)
+#define MESH_NORMAL_GROUPS_PER_JOB (4096)
+#define MESH_TANGENT_FACES_PER_JOB (16384)		// Smallest batch of whole mesh pieces given to MikkTSpace at once
 
-// MikkTSpace C functions
-static int	GetNumFaces(const SMikkTSpaceContext* pContext);
-static int	GetNumVerticesPerFace(const SMikkTSpaceContext* pContext, const int iFace);
-static void GetVertexPosition(const SMikkTSpaceContext * pContext, float fvPosOut[], const int iFace, const int iVert);
-static void GetVertexNormal(const SMikkTSpaceContext * pContext, float fvNormOut[], const int iFace, const int iVert);
-static void GetVertexUV(const SMikkTSpaceContext * pContext, float fvTexcOut[], const int iFace, const int iVert);
-static void SetVertexTangent(const SMikkTSpaceContext * pContext, const float fvTangent[], const float fSign, const int iFace, const int iVert);
+// How close positions must be for smooth normals to treat them as one
+#define MESH_POSITION_WELD_EPSILON (0.0001f)
+
+// Normal and tangent generation C functions
+static int	GroupVerticesByPosition(const std::vector<VertexMaster>& vertices, std::vector<int>& out_groupIDs);
+static bool	GenerateMikkTangentsByGroup(std::vector<VertexMaster>& vertices, const std::vector<int>& positionGroups, int groupCount);
 
 //-----------------------------------------------------------------------------------------------
 // Begins the build process by setting up the instruction
@@ -30,7 +36,7 @@ void MeshBuilder::BeginBuilding(PrimitiveType type, bool useIndices)
 	m_instruction.m_usingIndices = useIndices;
 
 	if (useIndices) { m_instruction.m_startIndex = (int) m_indices.size();  }
-	else			{ m_instruction.m_startIndex = (int) m_vertices.size(); }
+	else			{ m_instruction.m_startIndex = GetVertexCount(); }
 
 	// Reset the master
 	m_master = VertexMaster();
@@ -46,7 +52,7 @@ void MeshBuilder::FinishBuilding()
 	unsigned int endIndex;
 
 	if (m_instruction.m_usingIndices)	{ endIndex = (unsigned int) m_indices.size();  }
-	else								{ endIndex = (unsigned int) m_vertices.size(); }
+	else								{ endIndex = (unsigned int) GetVertexCount(); }
 
 	m_instruction.m_elementCount = (endIndex - m_instruction.m_startIndex);
 	m_isBuilding = false;
@@ -64,6 +70,35 @@ void MeshBuilder::Clear()
 	m_vertices.clear();
 	m_indices.clear();
 	m_isBuilding = false;
+
+	m_outputLayout = nullptr;
+	m_writeOutputVertex = nullptr;
+	m_outputVertices.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reserves space for the given number of vertices, in whichever form they're being kept
+//
+void MeshBuilder::ReserveVertices(int vertexCount)
+{
+	if (m_outputLayout != nullptr)
+	{
+		m_outputVertices.reserve(vertexCount * m_outputLayout->GetStride());
+	}
+	else
+	{
+		m_vertices.reserve(vertexCount);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reserves space for the given number of indices
+//
+void MeshBuilder::ReserveIndices(int indexCount)
+{
+	m_indices.reserve(indexCount);
 }
 
 
@@ -72,6 +107,9 @@ void MeshBuilder::Clear()
 //
 void MeshBuilder::LoadFromObjFile(const std::string& filePath)
 {
+	PROFILE_SCOPE_CATEGORY("MeshBuilder::LoadFromObjFile", "Meshes");
+	AssertHasMasters("LoadFromObjFile");
+
 	AssertBuildState(false, PRIMITIVE_TRIANGLES, false);
 	BeginBuilding(PRIMITIVE_TRIANGLES, false);
 
@@ -79,20 +117,18 @@ void MeshBuilder::LoadFromObjFile(const std::string& filePath)
 	const char* buffer = (const char*)FileReadToNewBuffer(filePath.c_str(), size);
 	if (buffer == nullptr) { return; }
 
-	std::string fileContents = std::string(buffer);
-
 	std::vector<Vector3> positions;
 	std::vector<Vector3> normals;
 	std::vector<Vector2> uvs;
 
-	std::vector<std::string> lines = Tokenize(fileContents, '\n');
-	int numLines = (int) lines.size();
+	// Lines and their tokens are views into the file's buffer, so nothing is copied per line
+	std::string_view remainingContents = buffer;
+	std::string_view currLine;
+	std::vector<std::string_view> tokens;
 
-	for (int lineIndex = 0; lineIndex < numLines; ++lineIndex)
+	while (GetNextToken(remainingContents, '\n', currLine))
 	{
-		std::string currLine = lines[lineIndex];
-
-		std::vector<std::string> tokens = Tokenize(currLine, ' ');
+		TokenizeView(currLine, ' ', tokens);
 
 		// Empty line check
 		if (tokens.size() == 0) { continue; }
@@ -169,6 +205,14 @@ void MeshBuilder::LoadFromObjFile(const std::string& filePath)
 	}
 
 	FinishBuilding();
+
+	// Every face corner got its own master, so most of them are duplicates
+	if (m_instruction.m_startIndex == 0)
+	{
+		MeshOptimizeStats_t stats = Optimize();
+		LogTaggedPrintf("ASSETS", "Optimized OBJ \"%s\" from %i to %i vertices, ACMR %.3f to %.3f",
+			filePath.c_str(), stats.vertexCountBefore, stats.vertexCountAfter, stats.acmrBefore, stats.acmrAfter);
+	}
 }
 
 
@@ -177,6 +221,8 @@ void MeshBuilder::LoadFromObjFile(const std::string& filePath)
 //
 void MeshBuilder::FlipHorizontal()
 {
+	AssertHasMasters("FlipHorizontal");
+
 	int numVertices = (int) m_vertices.size();
 
 	for (int vertexIndex = 0; vertexIndex < numVertices; ++vertexIndex)
@@ -197,6 +243,17 @@ Vector3 MeshBuilder::GetVertexPosition(int vboIndex) const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the master of the vertex at the given index, for copying builds between builders
+//
+const VertexMaster& MeshBuilder::GetVertexMaster(int index) const
+{
+	AssertHasMasters("GetVertexMaster");
+	ASSERT_OR_DIE(index >= 0 && index < (int) m_vertices.size(), Stringf("Error: MeshBuilder::GetVertexMaster() received bad index: %i", index).c_str());
+	return m_vertices[index];
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the normal of the vertex at the given index
 //
@@ -233,6 +290,42 @@ int MeshBuilder::GetNumTriangles() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the box enclosing all vertex positions in the builder
+//
+AABB3 MeshBuilder::GetBounds() const
+{
+	int numVertices = GetVertexCount();
+
+	if (numVertices == 0)
+	{
+		return AABB3(Vector3::ZERO, Vector3::ZERO);
+	}
+
+	if (m_outputLayout != nullptr)
+	{
+		return m_outputBounds;
+	}
+
+	AABB3 bounds = AABB3(m_vertices[0].m_position, m_vertices[0].m_position);
+
+	for (int vertexIndex = 1; vertexIndex < numVertices; ++vertexIndex)
+	{
+		const Vector3& position = m_vertices[vertexIndex].m_position;
+
+		bounds.mins.x = MinFloat(bounds.mins.x, position.x);
+		bounds.mins.y = MinFloat(bounds.mins.y, position.y);
+		bounds.mins.z = MinFloat(bounds.mins.z, position.z);
+
+		bounds.maxs.x = MaxFloat(bounds.maxs.x, position.x);
+		bounds.maxs.y = MaxFloat(bounds.maxs.y, position.y);
+		bounds.maxs.z = MaxFloat(bounds.maxs.z, position.z);
+	}
+
+	return bounds;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Sets the tangent of the vertex at the given index to the one specified
 //
@@ -248,6 +341,8 @@ void MeshBuilder::SetVertexTangent(int vboIndex, const Vector4& tangent)
 //
 void MeshBuilder::AddBoneData(int vboIndex, unsigned int boneIndex, float weight)
 {
+	AssertHasMasters("AddBoneData");
+
 	VertexMaster& vertex = m_vertices[vboIndex];
 
 	// Find the next weight slot
@@ -270,15 +365,22 @@ void MeshBuilder::AddBoneData(int vboIndex, unsigned int boneIndex, float weight
 //
 void MeshBuilder::GenerateFlatTBN()
 {
+	PROFILE_SCOPE_CATEGORY("MeshBuilder::GenerateFlatTBN", "Meshes");
+	AssertHasMasters("GenerateFlatTBN");
+
 	ASSERT_OR_DIE((int) m_vertices.size() % 3 == 0, Stringf("Error: MeshBuilder::GenerateFlatNormals() called with weird number of vertices: %i", (int) m_vertices.size()));
 	ASSERT_OR_DIE(m_instruction.m_primType == PRIMITIVE_TRIANGLES, Stringf("Error: MeshBuilder::GenerateFlatNormals() called on builder that isn't using triangles"));
 	ASSERT_OR_DIE(!m_instruction.m_usingIndices, Stringf("Error: MeshBuilder::GenerateFlatNormals() called on builder that is using indices."));
 
-	for (int faceIndex = 0; faceIndex < (int) m_vertices.size(); faceIndex += 3)
+	int faceCount = (int) m_vertices.size() / 3;
+
+	ParallelFor(0, faceCount, MESH_NORMAL_FACES_PER_JOB, [&](int faceIndex)
 	{
-		Vector3 a = m_vertices[faceIndex].m_position;
-		Vector3 b = m_vertices[faceIndex + 1].m_position;
-		Vector3 c = m_vertices[faceIndex + 2].m_position;
+		int firstVertex = faceIndex * 3;
+
+		Vector3 a = m_vertices[firstVertex].m_position;
+		Vector3 b = m_vertices[firstVertex + 1].m_position;
+		Vector3 c = m_vertices[firstVertex + 2].m_position;
 
 		Vector3 rightSide = b - a; // Order is important for the cross product
 		Vector3 leftSide = c - a;
@@ -286,116 +388,259 @@ void MeshBuilder::GenerateFlatTBN()
 		Vector3 normal = CrossProduct(leftSide, rightSide).GetNormalized();
 
 		// Set all to use the same normals
-		m_vertices[faceIndex].m_normal = normal;
-		m_vertices[faceIndex + 1].m_normal = normal;
-		m_vertices[faceIndex + 2].m_normal = normal;
-	}
+		m_vertices[firstVertex].m_normal = normal;
+		m_vertices[firstVertex + 1].m_normal = normal;
+		m_vertices[firstVertex + 2].m_normal = normal;
+	});
 
 	// Also generate tangents
 	GenerateMikkTangents(*this);
 }
 
 
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the hash of a cell of the position grid
+//
+static uint32_t HashPositionCell(int64_t cellX, int64_t cellY, int64_t cellZ)
+{
+	uint64_t hash = ((uint64_t) cellX * 73856093ull) ^ ((uint64_t) cellY * 19349663ull) ^ ((uint64_t) cellZ * 83492791ull);
+	return (uint32_t) (hash ^ (hash >> 32));
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Gives every vertex the group of the first vertex before it with a mostly equal position, or a new
+// group if there isn't one, and returns the number of groups
+// Group starters are hashed by their cell in a grid of epsilon sized cells, so a position only needs
+// checking against the starters in its own and neighboring cells
+//
+static int GroupVerticesByPosition(const std::vector<VertexMaster>& vertices, std::vector<int>& out_groupIDs)
+{
+	PROFILE_SCOPE_CATEGORY("GroupVerticesByPosition", "Meshes");
+
+	// Own cell first, since most matches are exact duplicates
+	static const int64_t s_cellOffsets[3] = { 0, -1, 1 };
+
+	int vertexCount = (int) vertices.size();
+	out_groupIDs.resize(vertexCount);
+
+	int tableSize = 16;
+	while (tableSize < vertexCount * 2)
+	{
+		tableSize *= 2;
+	}
+
+	uint32_t tableMask = (uint32_t) tableSize - 1;
+
+	// Each slot chains the group starters of the cells hashing to it
+	std::vector<int> slotHeads(tableSize, -1);
+	std::vector<int> nextInSlot(vertexCount, -1);
+
+	int groupCount = 0;
+
+	for (int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		const Vector3& position = vertices[vertexIndex].m_position;
+
+		int64_t cellX = (int64_t) floor((double) position.x / MESH_POSITION_WELD_EPSILON);
+		int64_t cellY = (int64_t) floor((double) position.y / MESH_POSITION_WELD_EPSILON);
+		int64_t cellZ = (int64_t) floor((double) position.z / MESH_POSITION_WELD_EPSILON);
+
+		int match = -1;
+		for (int neighborIndex = 0; neighborIndex < 27 && match < 0; ++neighborIndex)
+		{
+			uint32_t slot = HashPositionCell(cellX + s_cellOffsets[neighborIndex % 3], cellY + s_cellOffsets[(neighborIndex / 3) % 3], cellZ + s_cellOffsets[neighborIndex / 9]) & tableMask;
+
+			for (int starter = slotHeads[slot]; starter >= 0; starter = nextInSlot[starter])
+			{
+				if (AreMostlyEqual(position, vertices[starter].m_position, MESH_POSITION_WELD_EPSILON))
+				{
+					match = starter;
+					break;
+				}
+			}
+		}
+
+		if (match >= 0)
+		{
+			out_groupIDs[vertexIndex] = out_groupIDs[match];
+		}
+		else
+		{
+			out_groupIDs[vertexIndex] = groupCount;
+			groupCount++;
+
+			uint32_t slot = HashPositionCell(cellX, cellY, cellZ) & tableMask;
+			nextInSlot[vertexIndex] = slotHeads[slot];
+			slotHeads[slot] = vertexIndex;
+		}
+	}
+
+	return groupCount;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Generates the normals for all vertices in the MeshBuilder on a per-face basis, with smoothing
+// Vertices at the same position get the area weighted average normal of all their faces
+// Positions are grouped through a hash grid, and the face normals and group averages are computed
+// in parallel on the JobSystem
 //
 void MeshBuilder::GenerateSmoothNormals()
 {
+	PROFILE_SCOPE_CATEGORY("MeshBuilder::GenerateSmoothNormals", "Meshes");
+	AssertHasMasters("GenerateSmoothNormals");
+
 	ASSERT_OR_DIE((int) m_vertices.size() % 3 == 0, Stringf("Error: MeshBuilder::GenerateSmoothNormals() called with weird number of vertices: %i", (int) m_vertices.size()));
 	ASSERT_OR_DIE(m_instruction.m_primType == PRIMITIVE_TRIANGLES, Stringf("Error: MeshBuilder::GenerateSmoothNormals() called on builder that isn't using triangles"));
 	ASSERT_OR_DIE(!m_instruction.m_usingIndices, Stringf("Error: MeshBuilder::GenerateSmoothNormals() called on builder that is using indices."));
 
-	// We reset the master at the start of every build, so normal defaults to (0,0,0)
-	// If we still have (0,0,0) as a normal, then we assume normals haven't been assigned yet, so do that first
-	bool hasVertexNormals = m_vertices[0].m_normal != Vector3::ZERO;
-	if (!hasVertexNormals)
+	int vertexCount = (int) m_vertices.size();
+	int faceCount = vertexCount / 3;
+
+	// Face normals scaled by the face's area, which is half the cross product's length
+	std::vector<Vector3> weightedFaceNormals(faceCount);
+	std::vector<float> faceAreas(faceCount);
+
+	ParallelFor(0, faceCount, MESH_NORMAL_FACES_PER_JOB, [&](int faceIndex)
 	{
-		GenerateFlatTBN();
+		Vector3 a = m_vertices[3 * faceIndex].m_position;
+		Vector3 b = m_vertices[3 * faceIndex + 1].m_position;
+		Vector3 c = m_vertices[3 * faceIndex + 2].m_position;
+
+		Vector3 rightSide = (b - a);
+		Vector3 leftSide = (c - a);
+
+		weightedFaceNormals[faceIndex] = 0.5f * CrossProduct(leftSide, rightSide);
+		faceAreas[faceIndex] = weightedFaceNormals[faceIndex].GetLength();
+	});
+
+	// Find the vertices sharing each position, listed one group after another
+	std::vector<int> positionGroups;
+	int groupCount = GroupVerticesByPosition(m_vertices, positionGroups);
+
+	std::vector<int> groupOffsets(groupCount + 1, 0);
+	for (int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		groupOffsets[positionGroups[vertexIndex] + 1]++;
+	}
+
+	for (int groupIndex = 0; groupIndex < groupCount; ++groupIndex)
+	{
+		groupOffsets[groupIndex + 1] += groupOffsets[groupIndex];
 	}
 
-	std::vector<Vector3> positionsWithNormals;
+	std::vector<int> groupVertices(vertexCount);
+	std::vector<int> cursors(groupOffsets.begin(), groupOffsets.end() - 1);
+
+	for (int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		groupVertices[cursors[positionGroups[vertexIndex]]++] = vertexIndex;
+	}
 
-	for (int vertexIndex = 0; vertexIndex < (int) m_vertices.size(); ++vertexIndex)
+	// Each group writes only its own vertices, so the groups can be averaged in parallel
+	ParallelFor(0, groupCount, MESH_NORMAL_GROUPS_PER_JOB, [&](int groupIndex)
 	{
-		Vector3 currPosition = m_vertices[vertexIndex].m_position;
-	
-		// To avoid floating point errors, I'll check if we've done it myself, not use std::find()
-		bool positionAlreadyDone = false;
-		for (int finishedIndex = 0; finishedIndex < (int) positionsWithNormals.size(); ++finishedIndex)
+		Vector3 weightedNormal = Vector3::ZERO;
+		float totalArea = 0.f;
+
+		for (int groupVertexIndex = groupOffsets[groupIndex]; groupVertexIndex < groupOffsets[groupIndex + 1]; ++groupVertexIndex)
 		{
-			if (AreMostlyEqual(currPosition, positionsWithNormals[finishedIndex]))
-			{
-				positionAlreadyDone = true;
-			}
-		}
+			int faceIndex = groupVertices[groupVertexIndex] / 3;
 
-		if (positionAlreadyDone) { continue; }
+			weightedNormal += weightedFaceNormals[faceIndex];
+			totalArea += faceAreas[faceIndex];
+		}
 
-		// Find all copies of this position
-		std::vector<int> indices;
+		Vector3 averageNormal = (totalArea > 0.f ? weightedNormal / totalArea : Vector3::ZERO);
 
-		for (int positionIndex = 0; positionIndex < (int) m_vertices.size(); ++positionIndex)
+		for (int groupVertexIndex = groupOffsets[groupIndex]; groupVertexIndex < groupOffsets[groupIndex + 1]; ++groupVertexIndex)
 		{
-			if (AreMostlyEqual(currPosition, m_vertices[positionIndex].m_position))
-			{
-				indices.push_back(positionIndex);
-			}
+			m_vertices[groupVertices[groupVertexIndex]].m_normal = averageNormal;
 		}
+	});
 
-		// For each position copy, get the normal and area of the shared face
-		std::vector<Vector3> normals;
-		std::vector<float> faceAreas;
-		float totalArea = 0.f;
+	// Also generate tangents, reusing the position groups
+	GenerateMikkTangentsByGroup(m_vertices, positionGroups, groupCount);
+}
 
-		for (int index = 0; index < (int) indices.size(); ++index)
-		{
-			int faceIndex = indices[index] / 3;
 
-			Vector3 a = m_vertices[3 * faceIndex].m_position;
-			Vector3 b = m_vertices[3 * faceIndex + 1].m_position;
-			Vector3 c = m_vertices[3 * faceIndex + 2].m_position;
+//-----------------------------------------------------------------------------------------------
+// Welds vertices that are identical, reorders the triangles for post-transform cache hits and the
+// vertices for fetch locality, and returns the vertex counts and ACMR from before and after
+// Unindexed builders get indices made for them
+//
+MeshOptimizeStats_t MeshBuilder::Optimize()
+{
+	PROFILE_SCOPE_CATEGORY("MeshBuilder::Optimize", "Meshes");
+	AssertHasMasters("Optimize");
 
-			Vector3 rightSide = (b - a);
-			Vector3 leftSide = (c - a);
+	ASSERT_OR_DIE(!m_isBuilding, "Error: MeshBuilder::Optimize() called while building");
+	ASSERT_OR_DIE(m_instruction.m_primType == PRIMITIVE_TRIANGLES, "Error: MeshBuilder::Optimize() called on builder that isn't using triangles");
+	ASSERT_OR_DIE(m_instruction.m_startIndex == 0 && (int) m_instruction.m_elementCount == GetElementCount(), "Error: MeshBuilder::Optimize() called on builder with more than one build");
 
-			Vector3 normal = CrossProduct(leftSide, rightSide);
-			float area = normal.NormalizeAndGetLength() * 0.5f;
+	MeshOptimizeStats_t stats;
+	stats.vertexCountBefore = GetVertexCount();
 
-			totalArea += area;
-			faceAreas.push_back(area);
-			normals.push_back(normal);
-		}
+	MakeIndexed();
 
-		// Now we have all normals and face areas that this position is part of, so now calculate
-		// the weighed average
-		Vector3 averageNormal = Vector3::ZERO;
-		for (int index = 0; index < (int) indices.size(); ++index)
-		{
-			averageNormal += faceAreas[index] * normals[index];
-		}
+	stats.acmrBefore = CalculateACMR(m_indices.data(), GetIndexCount(), GetVertexCount());
 
-		averageNormal /= totalArea;
+	WeldVertices(m_vertices, m_indices);
+	OptimizeVertexCache(m_indices.data(), GetIndexCount(), GetVertexCount());
+	OptimizeVertexFetch(m_vertices, m_indices);
 
-		// Assign all vertices with this position the weighted normal
-		for (int index = 0; index < (int) indices.size(); ++index)
-		{
-			m_vertices[indices[index]].m_normal = averageNormal;
-		}
+	m_instruction = DrawInstruction(PRIMITIVE_TRIANGLES, true, 0, (unsigned int) m_indices.size());
 
-		// Done with this position, so add the position to the finished list
-		positionsWithNormals.push_back(currPosition);
-	}
+	stats.vertexCountAfter = GetVertexCount();
+	stats.acmrAfter = CalculateACMR(m_indices.data(), GetIndexCount(), GetVertexCount());
 
-	// Also generate tangents
-	GenerateMikkTangents(*this);
+	return stats;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reduces the triangles to about targetRatio of their count, collapsing the edges that change the
+// surface least, and stopping early rather than moving it more than maxError (a fraction of the
+// mesh's largest dimension); the result is optimized the same as Optimize()
+// Returns the largest error of the collapses made
+//
+float MeshBuilder::Simplify(float targetRatio, float maxError /*= 1.f*/)
+{
+	PROFILE_SCOPE_CATEGORY("MeshBuilder::Simplify", "Meshes");
+	AssertHasMasters("Simplify");
+
+	ASSERT_OR_DIE(!m_isBuilding, "Error: MeshBuilder::Simplify() called while building");
+	ASSERT_OR_DIE(m_instruction.m_primType == PRIMITIVE_TRIANGLES, "Error: MeshBuilder::Simplify() called on builder that isn't using triangles");
+	ASSERT_OR_DIE(m_instruction.m_startIndex == 0 && (int) m_instruction.m_elementCount == GetElementCount(), "Error: MeshBuilder::Simplify() called on builder with more than one build");
+
+	MakeIndexed();
+
+	// Vertices split only by duplication can't collapse, so weld them first
+	WeldVertices(m_vertices, m_indices);
+
+	int targetIndexCount = (int) (ClampFloatZeroToOne(targetRatio) * (float) (m_indices.size() / 3)) * 3;
+	float error = SimplifyMesh(m_vertices, m_indices, targetIndexCount, maxError);
+
+	OptimizeVertexCache(m_indices.data(), GetIndexCount(), GetVertexCount());
+	OptimizeVertexFetch(m_vertices, m_indices);
+
+	m_instruction = DrawInstruction(PRIMITIVE_TRIANGLES, true, 0, (unsigned int) m_indices.size());
+
+	return error;
 }
 
 
 //-----------------------------------------------------------------------------------------------
 // Returns the vertex count of the MeshBuilder
 //
-int MeshBuilder::GetVertexCount()
+int MeshBuilder::GetVertexCount() const
 {
+	if (m_outputLayout != nullptr)
+	{
+		return (int) (m_outputVertices.size() / m_outputLayout->GetStride());
+	}
+
 	return (int) m_vertices.size();
 }
 
@@ -403,7 +648,7 @@ int MeshBuilder::GetVertexCount()
 //-----------------------------------------------------------------------------------------------
 // Returns the index count of the MeshBuilder
 //
-int MeshBuilder::GetIndexCount()
+int MeshBuilder::GetIndexCount() const
 {
 	return (int) m_indices.size();
 }
@@ -412,7 +657,7 @@ int MeshBuilder::GetIndexCount()
 //-----------------------------------------------------------------------------------------------
 // Returns the element count of the MeshBuilder (vertex count if not using indices, index count otherwise)
 //
-int MeshBuilder::GetElementCount()
+int MeshBuilder::GetElementCount() const
 {
 	if (m_instruction.m_usingIndices)
 	{
@@ -423,6 +668,24 @@ int MeshBuilder::GetElementCount()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the indices pushed so far
+//
+const std::vector<unsigned int>& MeshBuilder::GetIndices() const
+{
+	return m_indices;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the draw instruction set when building finished
+//
+DrawInstruction MeshBuilder::GetDrawInstruction() const
+{
+	return m_instruction;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Sets the color on the vertex stamp to the one given
 //
@@ -465,9 +728,7 @@ void MeshBuilder::SetTangent(const Vector4& tangent)
 unsigned int MeshBuilder::PushVertex(const Vector3& position)
 {
 	m_master.m_position = position;
-
-	m_vertices.push_back(m_master);
-	return (unsigned int) m_vertices.size() - 1;
+	return AppendVertex(m_master);
 }
 
 
@@ -477,8 +738,71 @@ unsigned int MeshBuilder::PushVertex(const Vector3& position)
 unsigned int MeshBuilder::PushVertex(const VertexMaster& master)
 {
 	m_master = master;
-	m_vertices.push_back(m_master);
-	return (unsigned int) m_vertices.size() - 1;
+	return AppendVertex(m_master);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the vertex to the builder, converting it to the output type if one is set, and returns its index
+//
+unsigned int MeshBuilder::AppendVertex(const VertexMaster& master)
+{
+	if (m_outputLayout == nullptr)
+	{
+		m_vertices.push_back(master);
+		return (unsigned int) m_vertices.size() - 1;
+	}
+
+	unsigned int vertexIndex = (unsigned int) GetVertexCount();
+	const Vector3& position = master.m_position;
+
+	if (vertexIndex == 0)
+	{
+		m_outputBounds = AABB3(position, position);
+	}
+	else
+	{
+		m_outputBounds.mins.x = MinFloat(m_outputBounds.mins.x, position.x);
+		m_outputBounds.mins.y = MinFloat(m_outputBounds.mins.y, position.y);
+		m_outputBounds.mins.z = MinFloat(m_outputBounds.mins.z, position.z);
+
+		m_outputBounds.maxs.x = MaxFloat(m_outputBounds.maxs.x, position.x);
+		m_outputBounds.maxs.y = MaxFloat(m_outputBounds.maxs.y, position.y);
+		m_outputBounds.maxs.z = MaxFloat(m_outputBounds.maxs.z, position.z);
+	}
+
+	unsigned int stride = m_outputLayout->GetStride();
+	m_outputVertices.resize(m_outputVertices.size() + stride);
+	m_writeOutputVertex(master, &m_outputVertices[vertexIndex * stride]);
+
+	return vertexIndex;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Dies if the builder converts vertices as they're pushed, for functions that need the masters
+//
+void MeshBuilder::AssertHasMasters(const char* functionName) const
+{
+	ASSERT_OR_DIE(m_outputLayout == nullptr, Stringf("Error: MeshBuilder::%s() called on a builder with an output vertex type, which doesn't keep the masters", functionName));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Gives an unindexed builder one index per vertex, in order, so it can be optimized as indexed
+//
+void MeshBuilder::MakeIndexed()
+{
+	if (m_instruction.m_usingIndices)
+	{
+		return;
+	}
+
+	m_indices.resize(m_vertices.size());
+	for (int index = 0; index < (int) m_indices.size(); ++index)
+	{
+		m_indices[index] = (unsigned int) index;
+	}
 }
 
 
@@ -660,10 +984,15 @@ void MeshBuilder::PushCube(const AABB3& bounds, const Rgba& color /*= Rgba::WHIT
 //
 void MeshBuilder::PushUVSphere(const Vector3& spherePosition, float radius, unsigned int numWedges, unsigned int numSlices, const Rgba& color /*= Rgba::WHITE*/)
 {
+	PROFILE_SCOPE_CATEGORY("MeshBuilder::PushUVSphere", "Meshes");
+
 	AssertBuildState(true, PRIMITIVE_TRIANGLES, true);
 
 	SetColor(color);
 
+	// Indices are relative to the sphere's first vertex, so it can go after other geometry
+	unsigned int startVertex = (unsigned int) GetVertexCount();
+
 	// Pushing the vertices
 	for (int sliceIndex = 0; sliceIndex <= (int) numSlices; ++sliceIndex)
 	{
@@ -700,7 +1029,7 @@ void MeshBuilder::PushUVSphere(const Vector3& spherePosition, float radius, unsi
 	{
 		for (int wedgeIndex = 0; wedgeIndex < (int) numWedges; ++wedgeIndex)
 		{
-			unsigned int bottomLeft		= numVerticesPerSlice * sliceIndex + wedgeIndex;
+			unsigned int bottomLeft		= startVertex + numVerticesPerSlice * sliceIndex + wedgeIndex;
 			unsigned int bottomRight	= bottomLeft + 1;
 			unsigned int topRight		= bottomRight + numVerticesPerSlice;
 			unsigned int topLeft		= bottomLeft + numVerticesPerSlice;
@@ -717,6 +1046,8 @@ void MeshBuilder::PushUVSphere(const Vector3& spherePosition, float radius, unsi
 //
 void MeshBuilder::PushSurfacePatch(SurfacePatchFunction patchFunction, unsigned int numUSteps /*= 10*/, unsigned int numVSteps /*= 10*/, const Rgba& color /* = Rgba::WHITE*/)
 {
+	PROFILE_SCOPE_CATEGORY("MeshBuilder::PushSurfacePatch", "Meshes");
+
 	AssertBuildState(true, PRIMITIVE_TRIANGLES, true);
 	SetColor(color);
 
@@ -789,9 +1120,10 @@ void MeshBuilder::AssertBuildState(bool shouldBeBuilding, PrimitiveType primitiv
 //-----------------------------------------------------------------------------------------------
 // For object loading, parses the token and returns a vertex master
 //
-VertexMaster MeshBuilder::CreateMasterFromString(const std::string& text, const std::vector<Vector3>& positions, const std::vector<Vector3>& normals, const std::vector<Vector2>& uvs)
+VertexMaster MeshBuilder::CreateMasterFromString(std::string_view text, const std::vector<Vector3>& positions, const std::vector<Vector3>& normals, const std::vector<Vector2>& uvs)
 {
-	std::vector<std::string> indicesText = Tokenize(text, '/');
+	std::vector<std::string_view> indicesText;
+	TokenizeView(text, '/', indicesText);
 
 	// OBJ FILES USE 1-BASED INDEXING, SO SUBTRACT ONE FROM THEM
 	VertexMaster master;
@@ -804,7 +1136,7 @@ VertexMaster MeshBuilder::CreateMasterFromString(const std::string& text, const
 	// If either text coord or normal was omitted, then we need to see which was omitted
 	if (indicesText.size() == 2)
 	{
-		bool normalWasSpecified = (GetCharacterCount(text, '/') == 2); // Two slashes means position and normal
+		bool normalWasSpecified = (text.find("//") != std::string_view::npos); // Two slashes together means position and normal
 
 		if (normalWasSpecified)
 		{
@@ -833,10 +1165,18 @@ VertexMaster MeshBuilder::CreateMasterFromString(const std::string& text, const
 
 //-------------------------MikkT Tangent Space--------------------------------
 
+// The faces of one job's share of the mesh, all of them unindexed triangles
+struct MikkTangentBatch_t
+{
+	VertexMaster*	vertices = nullptr;
+	const int*		faces = nullptr;
+	int				faceCount = 0;
+};
+
 static int GetNumFaces(const SMikkTSpaceContext* pContext)
 {
-	MeshBuilder* mb = (MeshBuilder*)pContext->m_pUserData;
-	return mb->GetNumTriangles();
+	MikkTangentBatch_t* batch = (MikkTangentBatch_t*)pContext->m_pUserData;
+	return batch->faceCount;
 }
 
 static int GetNumVerticesPerFace(const SMikkTSpaceContext* pContext, const int iFace)
@@ -848,10 +1188,8 @@ static int GetNumVerticesPerFace(const SMikkTSpaceContext* pContext, const int i
 
 static void GetVertexPosition(const SMikkTSpaceContext * pContext, float fvPosOut[], const int iFace, const int iVert)
 {
-	MeshBuilder* mb = (MeshBuilder*)pContext->m_pUserData;
-	int vertexIndex = iFace * 3 + iVert;
-
-	Vector3 position = mb->GetVertexPosition(vertexIndex);
+	MikkTangentBatch_t* batch = (MikkTangentBatch_t*)pContext->m_pUserData;
+	const Vector3& position = batch->vertices[batch->faces[iFace] * 3 + iVert].m_position;
 
 	fvPosOut[0] = position.x;
 	fvPosOut[1] = position.y;
@@ -860,10 +1198,8 @@ static void GetVertexPosition(const SMikkTSpaceContext * pContext, float fvPosOu
 
 static void GetVertexNormal(const SMikkTSpaceContext * pContext, float fvNormOut[], const int iFace, const int iVert)
 {
-	MeshBuilder* mb = (MeshBuilder*)pContext->m_pUserData;
-	int vertexIndex = iFace * 3 + iVert;
-
-	Vector3 normal = mb->GetVertexNormal(vertexIndex);
+	MikkTangentBatch_t* batch = (MikkTangentBatch_t*)pContext->m_pUserData;
+	const Vector3& normal = batch->vertices[batch->faces[iFace] * 3 + iVert].m_normal;
 
 	fvNormOut[0] = normal.x;
 	fvNormOut[1] = normal.y;
@@ -872,151 +1208,240 @@ static void GetVertexNormal(const SMikkTSpaceContext * pContext, float fvNormOut
 
 static void GetVertexUV(const SMikkTSpaceContext * pContext, float fvTexcOut[], const int iFace, const int iVert)
 {
-	MeshBuilder* mb = (MeshBuilder*)pContext->m_pUserData;
-	int vertexIndex = iFace * 3 + iVert;
-
-	Vector2 uv = mb->GetVertexUV(vertexIndex);
+	MikkTangentBatch_t* batch = (MikkTangentBatch_t*)pContext->m_pUserData;
+	const Vector2& uv = batch->vertices[batch->faces[iFace] * 3 + iVert].m_uvs;
 
 	fvTexcOut[0] = uv.x;
 	fvTexcOut[1] = uv.y;
 }
 
-
-void SetVertexTangent(const SMikkTSpaceContext * pContext, const float fvTangent[], const float fSign, const int iFace, const int iVert)
+static void SetVertexTangent(const SMikkTSpaceContext * pContext, const float fvTangent[], const float fSign, const int iFace, const int iVert)
 {
-	MeshBuilder* mb = (MeshBuilder*)pContext->m_pUserData;
-	int vertexIndex = iFace * 3 + iVert;
-
-	Vector4 tangent = Vector4(fvTangent[0], fvTangent[1], fvTangent[2], fSign);
-
-	mb->SetVertexTangent(vertexIndex, tangent);
+	MikkTangentBatch_t* batch = (MikkTangentBatch_t*)pContext->m_pUserData;
+	batch->vertices[batch->faces[iFace] * 3 + iVert].m_tangent = Vector4(fvTangent[0], fvTangent[1], fvTangent[2], fSign);
 }
 
 
-bool GenerateMikkTangents(MeshBuilder& mb)
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the root of the group in the union-find forest, flattening the path to it
+//
+static int FindGroupRoot(std::vector<int>& parents, int group)
 {
-	SMikkTSpaceInterface mikkInterface;
+	int root = group;
+	while (parents[root] != root)
+	{
+		root = parents[root];
+	}
 
-	mikkInterface.m_getNumFaces = GetNumFaces;
-	mikkInterface.m_getNumVerticesOfFace = GetNumVerticesPerFace;
-	mikkInterface.m_getPosition = GetVertexPosition;
-	mikkInterface.m_getNormal = GetVertexNormal;
-	mikkInterface.m_getTexCoord = GetVertexUV;
+	while (parents[group] != root)
+	{
+		int next = parents[group];
+		parents[group] = root;
+		group = next;
+	}
 
-	mikkInterface.m_setTSpaceBasic = SetVertexTangent;
-	mikkInterface.m_setTSpace = NULL;
+	return root;
+}
 
-	SMikkTSpaceContext context;
-	context.m_pInterface = &mikkInterface;
-	context.m_pUserData = &mb;
 
-	return genTangSpaceDefault(&context);
-}
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Runs MikkTSpace over the unindexed triangles in parallel, one job per batch of whole connected
+// pieces of the mesh
+// MikkTSpace only shares tangents between faces with identical positions, so pieces that don't
+// share any position group can't affect each other, and the result matches one run over the mesh
+//
+static bool GenerateMikkTangentsByGroup(std::vector<VertexMaster>& vertices, const std::vector<int>& positionGroups, int groupCount)
+{
+	PROFILE_SCOPE_CATEGORY("GenerateMikkTangents", "Meshes");
 
+	int faceCount = (int) vertices.size() / 3;
 
-///////////////////////////////////////////////////////////////////////////////
-// Functions that depend on coordinate system
-///////////////////////////////////////////////////////////////////////////////
+	// Join the position groups each face touches, so every group ends up in one piece's root
+	std::vector<int> parents(groupCount);
+	for (int groupIndex = 0; groupIndex < groupCount; ++groupIndex)
+	{
+		parents[groupIndex] = groupIndex;
+	}
 
-#ifdef COORDINATE_SYSTEM_RIGHT_HAND_Z_UP
+	for (int faceIndex = 0; faceIndex < faceCount; ++faceIndex)
+	{
+		int root = FindGroupRoot(parents, positionGroups[faceIndex * 3]);
 
-//-----------------------------------------------------------------------------------------------
-// Pushes the vertices and indices needed to construct a 3D cube with the given params
-// FRONT faces -x, BACK faces +x, LEFT faces +y, RIGHT faces -y, TOP faces +z, BOTTOM faces -z
-//
-void MeshBuilder::PushCube(const Vector3& center, const Vector3& dimensions, const Rgba& color /*= Rgba::WHITE*/,
-	const AABB2& sideUVs /*= AABB2::UNIT_SQUARE_OFFCENTER*/, const AABB2& topUVs /*= AABB2::UNIT_SQUARE_OFFCENTER*/, const AABB2& bottomUVs /*= AABB2::UNIT_SQUARE_OFFCENTER*/)
-{
-	AssertBuildState(true, PRIMITIVE_TRIANGLES, true);
+		for (int corner = 1; corner < 3; ++corner)
+		{
+			int cornerRoot = FindGroupRoot(parents, positionGroups[faceIndex * 3 + corner]);
+			if (cornerRoot != root)
+			{
+				parents[cornerRoot] = root;
+			}
+		}
+	}
 
-	// Set up the corner vertices
-	AABB3 cubeBounds = AABB3(center - dimensions * 0.5f, center + dimensions * 0.5f);
+	// Sort the faces by piece, and cut the list into batches at piece boundaries
+	std::vector<int> pieceFaceCounts(groupCount + 1, 0);
+	std::vector<int> faceRoots(faceCount);
 
-	//-------------------------------------Front face--------------------------------------------------------
+	for (int faceIndex = 0; faceIndex < faceCount; ++faceIndex)
 	{
-		Vector3 position = Vector3(cubeBounds.mins.x, center.y, center.z);
-		Push3DQuad(position, Vector2(dimensions.y, dimensions.z), sideUVs, color, Vector3::MINUS_Y_AXIS, Vector3::Z_AXIS, Vector2(0.5f, 0.5f));
+		faceRoots[faceIndex] = FindGroupRoot(parents, positionGroups[faceIndex * 3]);
+		pieceFaceCounts[faceRoots[faceIndex] + 1]++;
 	}
 
-	//-------------------------------------Back face--------------------------------------------------------
+	for (int groupIndex = 0; groupIndex < groupCount; ++groupIndex)
 	{
-		Vector3 position = Vector3(cubeBounds.maxs.x, center.y, center.z);
-		Push3DQuad(position, Vector2(dimensions.y, dimensions.z), sideUVs, color, Vector3::Y_AXIS, Vector3::Z_AXIS, Vector2(0.5f, 0.5f));
+		pieceFaceCounts[groupIndex + 1] += pieceFaceCounts[groupIndex];
 	}
 
-	//-------------------------------------Left face--------------------------------------------------------
+	std::vector<int> sortedFaces(faceCount);
+	std::vector<int> cursors(pieceFaceCounts.begin(), pieceFaceCounts.end() - 1);
+
+	for (int faceIndex = 0; faceIndex < faceCount; ++faceIndex)
 	{
-		Vector3 position = Vector3(center.x, cubeBounds.maxs.y, center.z);
-		Push3DQuad(position, Vector2(dimensions.x, dimensions.z), sideUVs, color, Vector3::MINUS_X_AXIS, Vector3::Z_AXIS, Vector2(0.5f, 0.5f));
+		sortedFaces[cursors[faceRoots[faceIndex]]++] = faceIndex;
 	}
 
-	//-------------------------------------Right face--------------------------------------------------------
+	std::vector<MikkTangentBatch_t> batches;
+	MikkTangentBatch_t batch;
+	batch.vertices = vertices.data();
+	batch.faces = sortedFaces.data();
+
+	for (int groupIndex = 0; groupIndex < groupCount; ++groupIndex)
 	{
-		Vector3 position = Vector3(center.x, cubeBounds.mins.y, center.z);
-		Push3DQuad(position, Vector2(dimensions.x, dimensions.z), sideUVs, color, Vector3::X_AXIS, Vector3::Z_AXIS, Vector2(0.5f, 0.5f));
+		batch.faceCount += pieceFaceCounts[groupIndex + 1] - pieceFaceCounts[groupIndex];
+
+		if (batch.faceCount >= MESH_TANGENT_FACES_PER_JOB)
+		{
+			batches.push_back(batch);
+			batch.faces += batch.faceCount;
+			batch.faceCount = 0;
+		}
 	}
 
-	//-------------------------------------Top face--------------------------------------------------------
+	if (batch.faceCount > 0)
 	{
-		Vector3 position = Vector3(center.x, center.y, cubeBounds.maxs.z);
-		Push3DQuad(position, Vector2(dimensions.y, dimensions.x), topUVs, color, Vector3::MINUS_Y_AXIS, Vector3::X_AXIS, Vector2(0.5f, 0.5f));
+		batches.push_back(batch);
 	}
 
-	//-------------------------------------Bottom face--------------------------------------------------------
+	int numBatches = (int) batches.size();
+	std::vector<uint8_t> batchSucceeded(numBatches, 0);
+
+	ParallelFor(0, numBatches, 1, [&](int batchIndex)
 	{
-		Vector3 position = Vector3(center.x, center.y, cubeBounds.mins.z);
-		Push3DQuad(position, Vector2(dimensions.y, dimensions.x), bottomUVs, color, Vector3::MINUS_Y_AXIS, Vector3::MINUS_X_AXIS, Vector2(0.5f, 0.5f));
+		SMikkTSpaceInterface mikkInterface;
+
+		mikkInterface.m_getNumFaces = GetNumFaces;
+		mikkInterface.m_getNumVerticesOfFace = GetNumVerticesPerFace;
+		mikkInterface.m_getPosition = GetVertexPosition;
+		mikkInterface.m_getNormal = GetVertexNormal;
+		mikkInterface.m_getTexCoord = GetVertexUV;
+
+		mikkInterface.m_setTSpaceBasic = SetVertexTangent;
+		mikkInterface.m_setTSpace = NULL;
+
+		SMikkTSpaceContext context;
+		context.m_pInterface = &mikkInterface;
+		context.m_pUserData = &batches[batchIndex];
+
+		batchSucceeded[batchIndex] = (genTangSpaceDefault(&context) ? 1 : 0);
+	});
+
+	for (int batchIndex = 0; batchIndex < numBatches; ++batchIndex)
+	{
+		if (batchSucceeded[batchIndex] == 0)
+		{
+			return false;
+		}
 	}
+
+	return true;
 }
 
-#else // Left hand, Y up coordinate system
 
 //-----------------------------------------------------------------------------------------------
-// Pushes the vertices and indices needed to construct a 3D cube with the given params
+// Generates MikkTSpace tangents for the builder's unindexed triangles, from their normals and UVs
+// Returns false if MikkTSpace failed
+//
+bool GenerateMikkTangents(MeshBuilder& mb)
+{
+	mb.AssertHasMasters("GenerateMikkTangents");
+
+	std::vector<int> positionGroups;
+	int groupCount = GroupVerticesByPosition(mb.m_vertices, positionGroups);
+
+	return GenerateMikkTangentsByGroup(mb.m_vertices, positionGroups, groupCount);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions that depend on coordinate system
+///////////////////////////////////////////////////////////////////////////////
+
+// One quad of a cube - pushed at the center offset along normal by half the dimensions, sized by
+// the dimensions along right and up
+struct CubeFace_t
+{
+	Vector3 normal;
+	Vector3 right;
+	Vector3 up;
+	int		uvIndex;	// 0 for the side UVs, 1 for top, 2 for bottom
+};
+
+#ifdef COORDINATE_SYSTEM_RIGHT_HAND_Z_UP
+
+// FRONT faces -x, BACK faces +x, LEFT faces +y, RIGHT faces -y, TOP faces +z, BOTTOM faces -z
+static constexpr CubeFace_t s_cubeFaces[6] =
+{
+	{ Vector3(-1.f, 0.f, 0.f),	Vector3(0.f, -1.f, 0.f),	Vector3(0.f, 0.f, 1.f),		0 },	// Front
+	{ Vector3(1.f, 0.f, 0.f),	Vector3(0.f, 1.f, 0.f),		Vector3(0.f, 0.f, 1.f),		0 },	// Back
+	{ Vector3(0.f, 1.f, 0.f),	Vector3(-1.f, 0.f, 0.f),	Vector3(0.f, 0.f, 1.f),		0 },	// Left
+	{ Vector3(0.f, -1.f, 0.f),	Vector3(1.f, 0.f, 0.f),		Vector3(0.f, 0.f, 1.f),		0 },	// Right
+	{ Vector3(0.f, 0.f, 1.f),	Vector3(0.f, -1.f, 0.f),	Vector3(1.f, 0.f, 0.f),		1 },	// Top
+	{ Vector3(0.f, 0.f, -1.f),	Vector3(0.f, -1.f, 0.f),	Vector3(-1.f, 0.f, 0.f),	2 }		// Bottom
+};
+
+#else // Left hand, Y up coordinate system
+
 // FRONT faces -z, BACK faces +z, LEFT faces -x, RIGHT faces +x, TOP faces +y, BOTTOM faces -y
+static constexpr CubeFace_t s_cubeFaces[6] =
+{
+	{ Vector3(0.f, 0.f, -1.f),	Vector3(1.f, 0.f, 0.f),		Vector3(0.f, 1.f, 0.f),		0 },	// Front
+	{ Vector3(0.f, 0.f, 1.f),	Vector3(-1.f, 0.f, 0.f),	Vector3(0.f, 1.f, 0.f),		0 },	// Back
+	{ Vector3(-1.f, 0.f, 0.f),	Vector3(0.f, 0.f, -1.f),	Vector3(0.f, 1.f, 0.f),		0 },	// Left
+	{ Vector3(1.f, 0.f, 0.f),	Vector3(0.f, 0.f, 1.f),		Vector3(0.f, 1.f, 0.f),		0 },	// Right
+	{ Vector3(0.f, 1.f, 0.f),	Vector3(1.f, 0.f, 0.f),		Vector3(0.f, 0.f, 1.f),		1 },	// Top
+	{ Vector3(0.f, -1.f, 0.f),	Vector3(1.f, 0.f, 0.f),		Vector3(0.f, 0.f, -1.f),	2 }		// Bottom
+};
+
+#endif
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the size of the dimensions along the (axis-aligned, unit) axis, ignoring its sign
+//
+static inline float GetDimensionAlongAxis(const Vector3& axis, const Vector3& dimensions)
+{
+	return (axis.x * axis.x) * dimensions.x + (axis.y * axis.y) * dimensions.y + (axis.z * axis.z) * dimensions.z;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Pushes the vertices and indices needed to construct a 3D cube with the given params; the face
+// directions are in s_cubeFaces above, built at compile time for the engine's coordinate system
 //
 void MeshBuilder::PushCube(const Vector3& center, const Vector3& dimensions, const Rgba& color /*= Rgba::WHITE*/,
 	const AABB2& sideUVs /*= AABB2::UNIT_SQUARE_OFFCENTER*/, const AABB2& topUVs /*= AABB2::UNIT_SQUARE_OFFCENTER*/, const AABB2& bottomUVs /*= AABB2::UNIT_SQUARE_OFFCENTER*/)
 {
 	AssertBuildState(true, PRIMITIVE_TRIANGLES, true);
 
-	// Set up the corner vertices
-	AABB3 cubeBounds = AABB3(center - dimensions * 0.5f, center + dimensions * 0.5f);
-
-	//-------------------------------------Front face--------------------------------------------------------
-	{
-		Vector3 position = Vector3(center.x, center.y, cubeBounds.mins.z);
-		Push3DQuad(position, Vector2(dimensions.x, dimensions.y), sideUVs, color, Vector3::X_AXIS, Vector3::Y_AXIS, Vector2(0.5f, 0.5f));
-	}
-
-	//-------------------------------------Back face--------------------------------------------------------
-	{
-		Vector3 position = Vector3(center.x, center.y, cubeBounds.maxs.z);
-		Push3DQuad(position, Vector2(dimensions.x, dimensions.y), sideUVs, color, Vector3::MINUS_X_AXIS, Vector3::Y_AXIS, Vector2(0.5f, 0.5f));
-	}
-
-	//-------------------------------------Left face--------------------------------------------------------
-	{
-		Vector3 position = Vector3(cubeBounds.mins.x, center.y, center.z);
-		Push3DQuad(position, Vector2(dimensions.z, dimensions.y), sideUVs, color, Vector3::MINUS_Z_AXIS, Vector3::Y_AXIS, Vector2(0.5f, 0.5f));
-	}
+	const AABB2* faceUVs[3] = { &sideUVs, &topUVs, &bottomUVs };
 
-	//-------------------------------------Right face--------------------------------------------------------
+	for (int faceIndex = 0; faceIndex < 6; ++faceIndex)
 	{
-		Vector3 position = Vector3(cubeBounds.maxs.x, center.y, center.z);
-		Push3DQuad(position, Vector2(dimensions.z, dimensions.y), sideUVs, color, Vector3::Z_AXIS, Vector3::Y_AXIS, Vector2(0.5f, 0.5f));
-	}
+		const CubeFace_t& face = s_cubeFaces[faceIndex];
 
-	//-------------------------------------Top face--------------------------------------------------------
-	{
-		Vector3 position = Vector3(center.x, cubeBounds.maxs.y, center.z);
-		Push3DQuad(position, Vector2(dimensions.x, dimensions.z), topUVs, color, Vector3::X_AXIS, Vector3::Z_AXIS, Vector2(0.5f, 0.5f));
-	}
+		Vector3 halfOffset = Vector3(face.normal.x * dimensions.x, face.normal.y * dimensions.y, face.normal.z * dimensions.z) * 0.5f;
+		Vector2 faceDimensions = Vector2(GetDimensionAlongAxis(face.right, dimensions), GetDimensionAlongAxis(face.up, dimensions));
 
-	//-------------------------------------Bottom face--------------------------------------------------------
-	{
-		Vector3 position = Vector3(center.x, cubeBounds.mins.y, center.z);
-		Push3DQuad(position, Vector2(dimensions.x, dimensions.z), bottomUVs, color, Vector3::X_AXIS, Vector3::MINUS_Z_AXIS, Vector2(0.5f, 0.5f));
+		Push3DQuad(center + halfOffset, faceDimensions, *faceUVs[face.uvIndex], color, face.right, face.up, Vector2(0.5f, 0.5f));
 	}
 }
-#endif
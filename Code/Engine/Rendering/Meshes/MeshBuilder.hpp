@@ -5,13 +5,22 @@
 /* Description: Class to construct Meshes incrementally
 /************************************************************************/
 #pragma once
+#include <new>
+#include <string_view>
 #include <vector>
+#include <stdint.h>
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/AABB3.hpp"
 #include "Engine/Rendering/Meshes/Mesh.hpp"
+#include "Engine/Rendering/Meshes/MeshOptimizer.hpp"
 #include "Engine/Rendering/Core/Vertex.hpp"
+#include "Engine/Core/Memory/MemoryTracker.hpp"
+#include "Engine/Core/Memory/LinearAllocator.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
 
 typedef Vector3 (*SurfacePatchFunction)(const Vector2&);
+typedef void (*WriteVertex_cb)(const VertexMaster& master, uint8_t* out_vertex);
 class Matrix44;
 
 class MeshBuilder
@@ -23,6 +32,23 @@ public:
 	void FinishBuilding();
 	void Clear();
 
+	// Converts each vertex to VERT_TYPE as it's pushed instead of keeping its VertexMaster, so UpdateMesh()
+	// uploads straight from the builder; must be set while empty, and lasts until Clear()
+	// Manipulators, OBJ loading and the MikkTSpace/bone helpers need the masters, so can't be used with it
+	// Nor can types with quantized positions, which need the final bounds before they can be written
+	template <typename VERT_TYPE>
+	void SetOutputVertexType()
+	{
+		ASSERT_OR_DIE(GetVertexCount() == 0, "Error: MeshBuilder::SetOutputVertexType() called on a builder with vertices");
+		ASSERT_OR_DIE(!VERT_TYPE::LAYOUT.HasEncoding(VERTEX_ENCODING_QUANTIZED_POSITIONS), "Error: MeshBuilder::SetOutputVertexType() called with a quantized position vertex type");
+
+		m_outputLayout = &VERT_TYPE::LAYOUT;
+		m_writeOutputVertex = WriteVertex<VERT_TYPE>;
+	}
+
+	void ReserveVertices(int vertexCount);
+	void ReserveIndices(int indexCount);
+
 	// Stamp Functions
 	void			SetColor(const Rgba& color);
 	void			SetUVs(const Vector2& uvs);
@@ -59,17 +85,32 @@ public:
 	void	GenerateFlatTBN();
 	void	GenerateSmoothNormals();
 
+	// Welds identical vertices and reorders for the vertex cache and fetches; leaves the builder indexed
+	// Triangles only, and after FinishBuilding() on a builder holding just the one build
+	MeshOptimizeStats_t Optimize();
+
+	// Collapses edges down to about targetRatio of the triangles, optimizing the result as above
+	// Same requirements as Optimize(); returns the error reached, as a fraction of the mesh's size
+	float Simplify(float targetRatio, float maxError = 1.f);
+
 	// Accessors
 	template <typename VERT_TYPE>
 	VERT_TYPE GetVertex(int index)
 	{
+		AssertHasMasters("GetVertex");
 		VERT_TYPE vertex = VERT_TYPE(m_vertices[index]);
 		return vertex;
 	}
 
-	int		GetVertexCount();
-	int		GetIndexCount();
-	int		GetElementCount();
+	const VertexMaster& GetVertexMaster(int index) const;
+
+	int		GetVertexCount() const;
+	int		GetIndexCount() const;
+	int		GetElementCount() const;
+	AABB3	GetBounds() const;
+
+	const std::vector<unsigned int>&	GetIndices() const;
+	DrawInstruction						GetDrawInstruction() const;
 
 
 public:
@@ -106,27 +147,96 @@ public:
 	template <typename VERT_TYPE = VertexLit>
 	void UpdateMesh(Mesh& out_mesh) const
 	{
-		// Convert the list of VertexMasters to the specified vertex type
-		unsigned int vertexCount = (unsigned int) m_vertices.size();
-		VERT_TYPE* temp = (VERT_TYPE*)malloc(sizeof(VERT_TYPE) * vertexCount);
+		PROFILE_SCOPE_CATEGORY("MeshBuilder::UpdateMesh", "Meshes");
+		MEMORY_TAG_SCOPE("Meshes");
+
+		unsigned int vertexCount = (unsigned int) GetVertexCount();
 
-		for (unsigned int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+		if (m_outputLayout != nullptr)
+		{
+			// Already in the vertex type, so upload it as is
+			ASSERT_OR_DIE(m_outputLayout == &VERT_TYPE::LAYOUT, "Error: MeshBuilder::UpdateMesh() called with a vertex type other than the builder's output type");
+			out_mesh.SetVertices(vertexCount, reinterpret_cast<const VERT_TYPE*>(m_outputVertices.data()));
+		}
+		else
 		{
-			temp[vertexIndex] = VERT_TYPE(m_vertices[vertexIndex]);
+			// Convert the list of VertexMasters to the specified vertex type
+			// Only needed until it's uploaded, so it comes from the thread's scratch arena
+			ScratchScope scratch;
+			VERT_TYPE* temp = scratch.AllocateArray<VERT_TYPE>(vertexCount);
+
+			for (unsigned int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+			{
+				temp[vertexIndex] = VERT_TYPE(m_vertices[vertexIndex]);
+			}
+
+			// Packed types leave the positions to be normalized across the bounds
+			bool quantizePositions = (VERT_TYPE::LAYOUT.HasEncoding(VERTEX_ENCODING_QUANTIZED_POSITIONS) && vertexCount > 0);
+			AABB3 bounds = (quantizePositions ? GetBounds() : AABB3());
+
+			if (quantizePositions)
+			{
+				QuantizeVertexPositions(VERT_TYPE::LAYOUT, reinterpret_cast<uint8_t*>(temp), m_vertices.data(), vertexCount, bounds);
+			}
+
+			out_mesh.SetVertices(vertexCount, temp);
+
+			if (quantizePositions)
+			{
+				out_mesh.SetPositionQuantization(bounds.mins, bounds.GetDimensions());
+			}
 		}
 
 		// Set up the mesh
-		out_mesh.SetVertices(vertexCount, temp);
 		out_mesh.SetIndices((unsigned int) m_indices.size(), m_indices.data());
 		out_mesh.SetDrawInstruction(m_instruction);
 
-		free(temp);
+		if (vertexCount > 0)
+		{
+			out_mesh.SetBounds(GetBounds());
+		}
+	}
+
+	// Appends up to lodCount meshes, each simplified to about reductionPerLOD of the triangles of the
+	// one before, for Renderable::AddLOD() - stops early if a level couldn't be reduced any further
+	// Simplifies a copy, so the builder itself is left as is
+	template <typename VERT_TYPE = VertexLit>
+	void CreateLODMeshes(int lodCount, float reductionPerLOD, std::vector<Mesh*>& out_meshes, float maxError = 1.f) const
+	{
+		MeshBuilder lodBuilder = *this;
+
+		for (int lodIndex = 0; lodIndex < lodCount; ++lodIndex)
+		{
+			int triangleCountBefore = lodBuilder.GetNumTriangles();
+			lodBuilder.Simplify(reductionPerLOD, maxError);
+
+			if (lodBuilder.GetNumTriangles() >= triangleCountBefore)
+			{
+				break;
+			}
+
+			out_meshes.push_back(lodBuilder.CreateMesh<VERT_TYPE>());
+		}
 	}
 
 	void AssertBuildState(bool shouldBeBuilding, PrimitiveType primitiveType, bool shouldUseIndices) const;
 
 	// For Object file loading
-	static VertexMaster CreateMasterFromString(const std::string& text, const std::vector<Vector3>& positions, const std::vector<Vector3>& normals, const std::vector<Vector2>& uvs);
+	static VertexMaster CreateMasterFromString(std::string_view text, const std::vector<Vector3>& positions, const std::vector<Vector3>& normals, const std::vector<Vector2>& uvs);
+
+
+private:
+	//-----Private Methods-----
+
+	unsigned int	AppendVertex(const VertexMaster& master);
+	void			AssertHasMasters(const char* functionName) const;
+	void			MakeIndexed();
+
+	template <typename VERT_TYPE>
+	static void WriteVertex(const VertexMaster& master, uint8_t* out_vertex)
+	{
+		new (out_vertex) VERT_TYPE(master);
+	}
 
 
 private:
@@ -138,6 +248,15 @@ private:
 
 	std::vector<unsigned int>	m_indices;
 	std::vector<VertexMaster>	m_vertices;
+
+	// Used instead of m_vertices once an output type is set, with the bounds kept as they're pushed
+	const VertexLayout*			m_outputLayout = nullptr;
+	WriteVertex_cb				m_writeOutputVertex = nullptr;
+	std::vector<uint8_t>		m_outputVertices;
+	AABB3						m_outputBounds;
+
+	// Works on the masters directly, from jobs
+	friend bool GenerateMikkTangents(MeshBuilder& mb);
 	
 };
 
@@ -4,6 +4,7 @@
 /* Date: May 6th, 2018
 /* Description: Implementation of the MeshGroup class
 /************************************************************************/
+#include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Rendering/Meshes/Mesh.hpp"
 #include "Engine/Core/Utility/XmlUtilities.hpp"
 #include "Engine/Rendering/Meshes/MeshGroup.hpp"
@@ -19,9 +20,11 @@ MeshGroup::~MeshGroup()
 	for (int meshIndex = 0; meshIndex < numMeshes; ++meshIndex)
 	{
 		delete m_meshes[meshIndex];
+		DeleteLODs(meshIndex);
 	}
 
 	m_meshes.clear();
+	m_lods.clear();
 }
 
 
@@ -32,6 +35,7 @@ void MeshGroup::AddMeshUnique(Mesh* mesh)
 {
 	RemoveMesh(mesh);
 	m_meshes.push_back(mesh);
+	m_lods.push_back(std::vector<MeshLOD_t>());
 }
 
 
@@ -46,7 +50,7 @@ void MeshGroup::RemoveMesh(Mesh* mesh)
 	{
 		if (m_meshes[meshIndex] == mesh)
 		{
-			m_meshes.erase(m_meshes.begin() + meshIndex);
+			RemoveMesh(meshIndex);
 			break;
 		}
 	}
@@ -58,7 +62,10 @@ void MeshGroup::RemoveMesh(Mesh* mesh)
 //
 void MeshGroup::RemoveMesh(int index)
 {
+	DeleteLODs(index);
+
 	m_meshes.erase(m_meshes.begin() + index);
+	m_lods.erase(m_lods.begin() + index);
 }
 
 
@@ -78,3 +85,52 @@ int MeshGroup::GetMeshCount() const
 {
 	return (int) m_meshes.size();
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds a lower detail version of the mesh at the index, used below maxScreenSize of the screen's
+// height; the LODs are kept sorted so smaller screen sizes come later
+//
+void MeshGroup::AddLOD(int meshIndex, Mesh* lodMesh, float maxScreenSize)
+{
+	ASSERT_OR_DIE(meshIndex >= 0 && meshIndex < (int) m_meshes.size(), Stringf("Error: MeshGroup::AddLOD received index out of range, index was %i", meshIndex));
+
+	std::vector<MeshLOD_t>& lods = m_lods[meshIndex];
+
+	MeshLOD_t lod;
+	lod.mesh = lodMesh;
+	lod.maxScreenSize = maxScreenSize;
+
+	int insertIndex = 0;
+	while (insertIndex < (int) lods.size() && lods[insertIndex].maxScreenSize >= maxScreenSize)
+	{
+		insertIndex++;
+	}
+
+	lods.insert(lods.begin() + insertIndex, lod);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the LODs of the mesh at the index, finest first
+//
+const std::vector<MeshLOD_t>& MeshGroup::GetLODs(int meshIndex) const
+{
+	return m_lods[meshIndex];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes the LOD meshes of the mesh at the index
+//
+void MeshGroup::DeleteLODs(int meshIndex)
+{
+	std::vector<MeshLOD_t>& lods = m_lods[meshIndex];
+
+	for (int lodIndex = 0; lodIndex < (int) lods.size(); ++lodIndex)
+	{
+		delete lods[lodIndex].mesh;
+	}
+
+	lods.clear();
+}
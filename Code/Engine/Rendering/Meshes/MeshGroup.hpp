@@ -9,6 +9,13 @@
 
 class Mesh;
 
+// A lower detail version of a mesh, for draws covering less than maxScreenSize of the screen's height
+struct MeshLOD_t
+{
+	Mesh*	mesh = nullptr;
+	float	maxScreenSize = 0.f;
+};
+
 class MeshGroup
 {
 public:
@@ -23,10 +30,21 @@ public:
 	Mesh*	GetMesh(int index) const;
 	int		GetMeshCount() const;
 
+	// LODs of each mesh, kept coarsest last; the group owns them, and removing a mesh deletes its LODs
+	void							AddLOD(int meshIndex, Mesh* lodMesh, float maxScreenSize);
+	const std::vector<MeshLOD_t>&	GetLODs(int meshIndex) const;
+
+
+private:
+	//-----Private Methods-----
+
+	void DeleteLODs(int meshIndex);
+
 
 private:
 	//-----Private Data-----
 
 	std::vector<Mesh*> m_meshes;
+	std::vector<std::vector<MeshLOD_t>> m_lods;	// Parallel to m_meshes
 
 };
@@ -23,6 +23,24 @@ MeshGroupBuilder::~MeshGroupBuilder()
 	m_meshBuilders.clear();
 }
 
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of meshes the group will have, one per material used in the file
+//
+int MeshGroupBuilder::GetMeshCount() const
+{
+	return (int) m_meshBuilders.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the builders, one per material used in the file
+//
+const std::vector<MeshBuilder*>& MeshGroupBuilder::GetMeshBuilders() const
+{
+	return m_meshBuilders;
+}
+
 void MeshGroupBuilder::LoadFromObjFile(const std::string& filePath)
 {
 	// Load the file
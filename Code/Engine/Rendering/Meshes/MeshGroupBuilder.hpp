@@ -1,9 +1,10 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <math.h>
+#include "Engine/Math/MathUtils.hpp"
 #include "Engine/Rendering/Meshes/MeshGroup.hpp"
-
-class MeshBuilder;
+#include "Engine/Rendering/Meshes/MeshBuilder.hpp"
 
 class MeshGroupBuilder
 {
@@ -28,6 +29,59 @@ public:
 		return group;
 	}
 
+	// Rebuilds the group in place, reusing its meshes in order so pointers taken from it stay valid
+	template <typename VERT_TYPE = VertexLit>
+	void UpdateMeshGroup(MeshGroup& out_group) const
+	{
+		int numBuilders = (int) m_meshBuilders.size();
+
+		for (int builderIndex = 0; builderIndex < numBuilders; ++builderIndex)
+		{
+			if (builderIndex < out_group.GetMeshCount())
+			{
+				m_meshBuilders[builderIndex]->UpdateMesh<VERT_TYPE>(*out_group.GetMesh(builderIndex));
+			}
+			else
+			{
+				out_group.AddMeshUnique(m_meshBuilders[builderIndex]->CreateMesh<VERT_TYPE>());
+			}
+		}
+
+		while (out_group.GetMeshCount() > numBuilders)
+		{
+			Mesh* extraMesh = out_group.GetMesh(numBuilders);
+			out_group.RemoveMesh(numBuilders);
+			delete extraMesh;
+		}
+	}
+
+	// Gives each of the group's meshes up to lodCount simplified LODs, the first used below
+	// firstLODScreenSize of the screen's height; later ones shrink the screen size with the square root
+	// of the reduction, keeping about the same number of triangles per pixel
+	// Meant for a group just made from this builder - UpdateMeshGroup() leaves the LODs as they are
+	template <typename VERT_TYPE = VertexLit>
+	void AddLODsToMeshGroup(MeshGroup& out_group, int lodCount, float reductionPerLOD, float firstLODScreenSize) const
+	{
+		int numBuilders = MinInt((int) m_meshBuilders.size(), out_group.GetMeshCount());
+		float screenSizeScale = sqrtf(reductionPerLOD);
+
+		for (int builderIndex = 0; builderIndex < numBuilders; ++builderIndex)
+		{
+			std::vector<Mesh*> lodMeshes;
+			m_meshBuilders[builderIndex]->CreateLODMeshes<VERT_TYPE>(lodCount, reductionPerLOD, lodMeshes);
+
+			float screenSize = firstLODScreenSize;
+			for (int lodIndex = 0; lodIndex < (int) lodMeshes.size(); ++lodIndex)
+			{
+				out_group.AddLOD(builderIndex, lodMeshes[lodIndex], screenSize);
+				screenSize *= screenSizeScale;
+			}
+		}
+	}
+
+	int GetMeshCount() const;
+	const std::vector<MeshBuilder*>& GetMeshBuilders() const;
+
 
 private:
 
@@ -0,0 +1,899 @@
+/************************************************************************/
+/* File: MeshOptimizer.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the mesh optimization functions
+/************************************************************************/
+#include <math.h>
+#include <float.h>
+#include <string.h>
+#include <stdint.h>
+#include <algorithm>
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/Meshes/MeshOptimizer.hpp"
+
+// Forsyth's scoring constants, from "Linear-Speed Vertex Cache Optimisation"
+#define FORSYTH_CACHE_DECAY_POWER (1.5f)
+#define FORSYTH_LAST_TRIANGLE_SCORE (0.75f)
+#define FORSYTH_VALENCE_BOOST_SCALE (2.0f)
+#define FORSYTH_VALENCE_BOOST_POWER (0.5f)
+
+#define INVALID_VERTEX_INDEX (0xFFFFFFFF)
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the average number of vertices transformed per triangle, simulating a FIFO cache of
+// the given size as the triangles are drawn in order
+//
+float CalculateACMR(const unsigned int* indices, int indexCount, int vertexCount, int cacheSize /*= MESH_ACMR_CACHE_SIZE*/)
+{
+	int triangleCount = indexCount / 3;
+	if (triangleCount == 0)
+	{
+		return 0.f;
+	}
+
+	// A vertex is in the cache if fewer than cacheSize misses happened since it was last missed
+	std::vector<int> missTimestamps(vertexCount, -cacheSize - 1);
+	int missCount = 0;
+
+	for (int index = 0; index < indexCount; ++index)
+	{
+		unsigned int vertexIndex = indices[index];
+
+		if (missCount - missTimestamps[vertexIndex] > cacheSize)
+		{
+			missTimestamps[vertexIndex] = missCount;
+			missCount++;
+		}
+	}
+
+	return (float) missCount / (float) triangleCount;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the FNV-1a hash of the vertex's bytes
+//
+static uint32_t HashVertex(const VertexMaster& vertex)
+{
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&vertex);
+	uint32_t hash = 2166136261u;
+
+	for (size_t byteIndex = 0; byteIndex < sizeof(VertexMaster); ++byteIndex)
+	{
+		hash ^= bytes[byteIndex];
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes every vertex that's bitwise identical to an earlier one, with an open addressed hash
+// table of the vertices kept, and remaps the indices to the kept ones
+// Vertices keep their relative order, so the indices stay as cache friendly as they were
+//
+void WeldVertices(std::vector<VertexMaster>& vertices, std::vector<unsigned int>& indices)
+{
+	int vertexCount = (int) vertices.size();
+	if (vertexCount == 0)
+	{
+		return;
+	}
+
+	// At most half full, so probes stay short
+	uint32_t tableSize = 1;
+	while (tableSize < (uint32_t) vertexCount * 2)
+	{
+		tableSize <<= 1;
+	}
+
+	uint32_t tableMask = tableSize - 1;
+	std::vector<unsigned int> table(tableSize, INVALID_VERTEX_INDEX);
+	std::vector<unsigned int> remap(vertexCount);
+
+	// Kept vertices are compacted to the front as they're found, never past the one being read
+	unsigned int keptCount = 0;
+	for (int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		const VertexMaster& vertex = vertices[vertexIndex];
+		uint32_t slot = HashVertex(vertex) & tableMask;
+
+		while (table[slot] != INVALID_VERTEX_INDEX && memcmp(&vertices[table[slot]], &vertex, sizeof(VertexMaster)) != 0)
+		{
+			slot = (slot + 1) & tableMask;
+		}
+
+		if (table[slot] == INVALID_VERTEX_INDEX)
+		{
+			vertices[keptCount] = vertex;
+			table[slot] = keptCount;
+			keptCount++;
+		}
+
+		remap[vertexIndex] = table[slot];
+	}
+
+	vertices.resize(keptCount);
+
+	int indexCount = (int) indices.size();
+	for (int index = 0; index < indexCount; ++index)
+	{
+		indices[index] = remap[indices[index]];
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns Forsyth's score for a vertex, higher for vertices recently used and with few triangles left
+//
+static float CalculateVertexScore(int cachePosition, int remainingTriangleCount)
+{
+	if (remainingTriangleCount == 0)
+	{
+		return -1.f;
+	}
+
+	float score = 0.f;
+	if (cachePosition >= 0)
+	{
+		if (cachePosition < 3)
+		{
+			// Used by the last triangle, so fixed to not favor one edge of it
+			score = FORSYTH_LAST_TRIANGLE_SCORE;
+		}
+		else
+		{
+			float normalizedPosition = (float) (cachePosition - 3) / (float) (MESH_OPTIMIZE_CACHE_SIZE - 3);
+			score = powf(1.f - normalizedPosition, FORSYTH_CACHE_DECAY_POWER);
+		}
+	}
+
+	// Boost vertices with few triangles left, to finish them off instead of leaving lone triangles
+	score += FORSYTH_VALENCE_BOOST_SCALE * powf((float) remainingTriangleCount, -FORSYTH_VALENCE_BOOST_POWER);
+
+	return score;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Greedily emits the best scoring triangle using the vertices in a simulated LRU cache, rescoring
+// only the cached vertices' triangles after each one; when nothing cached has triangles left it
+// continues from the next triangle not emitted, in the original order
+//
+void OptimizeVertexCache(unsigned int* indices, int indexCount, int vertexCount)
+{
+	int triangleCount = indexCount / 3;
+	if (triangleCount == 0)
+	{
+		return;
+	}
+
+	// Triangles not yet emitted for each vertex, as ranges of one list
+	std::vector<int> remainingCounts(vertexCount, 0);
+	for (int index = 0; index < indexCount; ++index)
+	{
+		remainingCounts[indices[index]]++;
+	}
+
+	std::vector<int> adjacencyOffsets(vertexCount + 1, 0);
+	for (int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		adjacencyOffsets[vertexIndex + 1] = adjacencyOffsets[vertexIndex] + remainingCounts[vertexIndex];
+	}
+
+	std::vector<int> adjacency(indexCount);
+	std::vector<int> fillOffsets(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+	for (int index = 0; index < indexCount; ++index)
+	{
+		adjacency[fillOffsets[indices[index]]++] = index / 3;
+	}
+
+	std::vector<int> cachePositions(vertexCount, -1);
+	std::vector<float> vertexScores(vertexCount);
+	for (int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		vertexScores[vertexIndex] = CalculateVertexScore(-1, remainingCounts[vertexIndex]);
+	}
+
+	std::vector<float> triangleScores(triangleCount);
+	std::vector<uint8_t> isEmitted(triangleCount, 0);
+	for (int triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex)
+	{
+		const unsigned int* corners = &indices[3 * triangleIndex];
+		triangleScores[triangleIndex] = vertexScores[corners[0]] + vertexScores[corners[1]] + vertexScores[corners[2]];
+	}
+
+	std::vector<unsigned int> output;
+	output.reserve(indexCount);
+
+	unsigned int cache[MESH_OPTIMIZE_CACHE_SIZE + 3];
+	int cacheCount = 0;
+
+	int bestTriangle = -1;
+	int scanCursor = 0;
+
+	for (int emittedCount = 0; emittedCount < triangleCount; ++emittedCount)
+	{
+		if (bestTriangle == -1)
+		{
+			while (isEmitted[scanCursor] != 0)
+			{
+				scanCursor++;
+			}
+
+			bestTriangle = scanCursor;
+		}
+
+		const unsigned int* corners = &indices[3 * bestTriangle];
+		isEmitted[bestTriangle] = 1;
+		output.push_back(corners[0]);
+		output.push_back(corners[1]);
+		output.push_back(corners[2]);
+
+		// Take the triangle out of its vertices' remaining ranges
+		for (int cornerIndex = 0; cornerIndex < 3; ++cornerIndex)
+		{
+			unsigned int vertexIndex = corners[cornerIndex];
+			int* vertexTriangles = &adjacency[adjacencyOffsets[vertexIndex]];
+			int lastIndex = remainingCounts[vertexIndex] - 1;
+
+			for (int triangleIndex = 0; triangleIndex <= lastIndex; ++triangleIndex)
+			{
+				if (vertexTriangles[triangleIndex] == bestTriangle)
+				{
+					vertexTriangles[triangleIndex] = vertexTriangles[lastIndex];
+					remainingCounts[vertexIndex]--;
+					break;
+				}
+			}
+		}
+
+		// The triangle's vertices move to the front of the cache, the rest keep their order behind them
+		unsigned int newCache[MESH_OPTIMIZE_CACHE_SIZE + 3];
+		int newCacheCount = 0;
+
+		for (int cornerIndex = 0; cornerIndex < 3; ++cornerIndex)
+		{
+			bool isDuplicate = false;
+			for (int cacheIndex = 0; cacheIndex < newCacheCount; ++cacheIndex)
+			{
+				isDuplicate = isDuplicate || (newCache[cacheIndex] == corners[cornerIndex]);
+			}
+
+			if (!isDuplicate)
+			{
+				newCache[newCacheCount++] = corners[cornerIndex];
+			}
+		}
+
+		for (int cacheIndex = 0; cacheIndex < cacheCount; ++cacheIndex)
+		{
+			unsigned int vertexIndex = cache[cacheIndex];
+			if (vertexIndex != corners[0] && vertexIndex != corners[1] && vertexIndex != corners[2])
+			{
+				newCache[newCacheCount++] = vertexIndex;
+			}
+		}
+
+		// Rescore the cached vertices and any pushed out, carrying the change to their triangles
+		for (int cacheIndex = 0; cacheIndex < newCacheCount; ++cacheIndex)
+		{
+			unsigned int vertexIndex = newCache[cacheIndex];
+			int cachePosition = (cacheIndex < MESH_OPTIMIZE_CACHE_SIZE ? cacheIndex : -1);
+
+			cachePositions[vertexIndex] = cachePosition;
+
+			float newScore = CalculateVertexScore(cachePosition, remainingCounts[vertexIndex]);
+			float scoreChange = newScore - vertexScores[vertexIndex];
+			vertexScores[vertexIndex] = newScore;
+
+			const int* vertexTriangles = &adjacency[adjacencyOffsets[vertexIndex]];
+			for (int triangleIndex = 0; triangleIndex < remainingCounts[vertexIndex]; ++triangleIndex)
+			{
+				triangleScores[vertexTriangles[triangleIndex]] += scoreChange;
+			}
+		}
+
+		cacheCount = MinInt(newCacheCount, MESH_OPTIMIZE_CACHE_SIZE);
+		memcpy(cache, newCache, sizeof(unsigned int) * cacheCount);
+
+		// Next is the best triangle touching the cache, once all the scores are up to date
+		bestTriangle = -1;
+		float bestScore = -1.f;
+
+		for (int cacheIndex = 0; cacheIndex < cacheCount; ++cacheIndex)
+		{
+			unsigned int vertexIndex = cache[cacheIndex];
+			const int* vertexTriangles = &adjacency[adjacencyOffsets[vertexIndex]];
+
+			for (int triangleIndex = 0; triangleIndex < remainingCounts[vertexIndex]; ++triangleIndex)
+			{
+				int candidate = vertexTriangles[triangleIndex];
+				if (triangleScores[candidate] > bestScore)
+				{
+					bestScore = triangleScores[candidate];
+					bestTriangle = candidate;
+				}
+			}
+		}
+	}
+
+	memcpy(indices, output.data(), sizeof(unsigned int) * indexCount);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Moves the vertices into the order the indices first reference them, so vertex fetches walk
+// forward through memory; vertices no index uses are removed
+//
+void OptimizeVertexFetch(std::vector<VertexMaster>& vertices, std::vector<unsigned int>& indices)
+{
+	int vertexCount = (int) vertices.size();
+	int indexCount = (int) indices.size();
+
+	std::vector<unsigned int> remap(vertexCount, INVALID_VERTEX_INDEX);
+	unsigned int nextVertexIndex = 0;
+
+	for (int index = 0; index < indexCount; ++index)
+	{
+		unsigned int& vertexIndex = indices[index];
+
+		if (remap[vertexIndex] == INVALID_VERTEX_INDEX)
+		{
+			remap[vertexIndex] = nextVertexIndex++;
+		}
+
+		vertexIndex = remap[vertexIndex];
+	}
+
+	std::vector<VertexMaster> reordered(nextVertexIndex);
+	for (int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		if (remap[vertexIndex] != INVALID_VERTEX_INDEX)
+		{
+			reordered[remap[vertexIndex]] = vertices[vertexIndex];
+		}
+	}
+
+	vertices.swap(reordered);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Simplification
+//-----------------------------------------------------------------------------------------------
+
+#define SIMPLIFY_BORDER_WEIGHT (10.f)		// How firmly open borders hold their shape, relative to the surface
+#define SIMPLIFY_ERROR_LIMIT_SCALE (1.5f)	// How far past the error of its goal collapse a pass keeps collapsing
+#define SIMPLIFY_MIN_FLIP_COSINE (0.25f)	// Collapses turning a triangle's normal further than this are rejected
+#define SIMPLIFY_MAX_PASSES (64)
+
+enum eSimplifyVertexKind
+{
+	SIMPLIFY_VERTEX_INTERIOR,
+	SIMPLIFY_VERTEX_BORDER,		// On an edge only one triangle uses, and only collapses along such edges
+	SIMPLIFY_VERTEX_LOCKED		// Shares its position with another vertex (a UV or normal seam), so never moves
+};
+
+// Symmetric 4x4 matrix summing the squared distances to a set of weighted planes
+struct SimplifyQuadric_t
+{
+	float a2 = 0.f;	float ab = 0.f;	float ac = 0.f;	float ad = 0.f;
+	float b2 = 0.f;	float bc = 0.f;	float bd = 0.f;
+	float c2 = 0.f;	float cd = 0.f;
+	float d2 = 0.f;
+
+	float weight = 0.f;
+};
+
+struct SimplifyCollapse_t
+{
+	unsigned int	from;
+	unsigned int	to;
+	float			error;
+};
+
+// Triangles using each vertex, packed one vertex after another
+struct SimplifyAdjacency_t
+{
+	std::vector<int> offsets;	// One more than the vertex count, so a vertex's triangles end at the next one's offset
+	std::vector<int> triangles;
+};
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Adds the plane (normal, d) to the quadric, with the given weight
+//
+static void AddPlaneToQuadric(SimplifyQuadric_t& quadric, const Vector3& normal, float d, float weight)
+{
+	quadric.a2 += weight * normal.x * normal.x;
+	quadric.ab += weight * normal.x * normal.y;
+	quadric.ac += weight * normal.x * normal.z;
+	quadric.ad += weight * normal.x * d;
+	quadric.b2 += weight * normal.y * normal.y;
+	quadric.bc += weight * normal.y * normal.z;
+	quadric.bd += weight * normal.y * d;
+	quadric.c2 += weight * normal.z * normal.z;
+	quadric.cd += weight * normal.z * d;
+	quadric.d2 += weight * d * d;
+
+	quadric.weight += weight;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Adds the planes of one quadric to another
+//
+static void AddQuadric(SimplifyQuadric_t& quadric, const SimplifyQuadric_t& other)
+{
+	quadric.a2 += other.a2;
+	quadric.ab += other.ab;
+	quadric.ac += other.ac;
+	quadric.ad += other.ad;
+	quadric.b2 += other.b2;
+	quadric.bc += other.bc;
+	quadric.bd += other.bd;
+	quadric.c2 += other.c2;
+	quadric.cd += other.cd;
+	quadric.d2 += other.d2;
+
+	quadric.weight += other.weight;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the weighted average squared distance from the point to the quadric's planes
+//
+static float EvaluateQuadric(const SimplifyQuadric_t& quadric, const Vector3& point)
+{
+	if (quadric.weight <= 0.f)
+	{
+		return 0.f;
+	}
+
+	float x = point.x;
+	float y = point.y;
+	float z = point.z;
+
+	float error = quadric.a2 * x * x + quadric.b2 * y * y + quadric.c2 * z * z
+		+ 2.f * (quadric.ab * x * y + quadric.ac * x * z + quadric.bc * y * z)
+		+ 2.f * (quadric.ad * x + quadric.bd * y + quadric.cd * z)
+		+ quadric.d2;
+
+	return MaxFloat(error / quadric.weight, 0.f);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Finds the triangles using each vertex
+//
+static void BuildAdjacency(const std::vector<unsigned int>& indices, int vertexCount, SimplifyAdjacency_t& out_adjacency)
+{
+	int triangleCount = (int) indices.size() / 3;
+
+	out_adjacency.offsets.assign(vertexCount + 1, 0);
+	out_adjacency.triangles.resize(triangleCount * 3);
+
+	for (int index = 0; index < triangleCount * 3; ++index)
+	{
+		out_adjacency.offsets[indices[index] + 1]++;
+	}
+
+	for (int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		out_adjacency.offsets[vertexIndex + 1] += out_adjacency.offsets[vertexIndex];
+	}
+
+	// Fill each vertex's range, with a write cursor per vertex starting at its offset
+	std::vector<int> cursors(out_adjacency.offsets.begin(), out_adjacency.offsets.end() - 1);
+
+	for (int index = 0; index < triangleCount * 3; ++index)
+	{
+		out_adjacency.triangles[cursors[indices[index]]++] = index / 3;
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns true if a triangle using the vertex winds from it straight to the other vertex
+//
+static bool HasDirectedEdge(const SimplifyAdjacency_t& adjacency, const std::vector<unsigned int>& indices, unsigned int from, unsigned int to)
+{
+	for (int adjacencyIndex = adjacency.offsets[from]; adjacencyIndex < adjacency.offsets[from + 1]; ++adjacencyIndex)
+	{
+		const unsigned int* triangle = &indices[adjacency.triangles[adjacencyIndex] * 3];
+
+		for (int corner = 0; corner < 3; ++corner)
+		{
+			if (triangle[corner] == from && triangle[(corner + 1) % 3] == to)
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns true if only one triangle direction uses the edge, i.e. it's on an open border
+//
+static bool IsBorderEdge(const SimplifyAdjacency_t& adjacency, const std::vector<unsigned int>& indices, unsigned int a, unsigned int b)
+{
+	return (HasDirectedEdge(adjacency, indices, a, b) != HasDirectedEdge(adjacency, indices, b, a));
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Sorts the vertices by position, locking any that share one; the rest are border vertices if
+// any of their edges are
+//
+static void ClassifyVertices(const std::vector<Vector3>& positions, const std::vector<unsigned int>& indices, const SimplifyAdjacency_t& adjacency, std::vector<uint8_t>& out_kinds)
+{
+	int vertexCount = (int) positions.size();
+	out_kinds.assign(vertexCount, SIMPLIFY_VERTEX_INTERIOR);
+
+	std::vector<unsigned int> sortedVertices(vertexCount);
+	for (int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		sortedVertices[vertexIndex] = (unsigned int) vertexIndex;
+	}
+
+	std::sort(sortedVertices.begin(), sortedVertices.end(), [&](unsigned int a, unsigned int b)
+	{
+		const Vector3& positionA = positions[a];
+		const Vector3& positionB = positions[b];
+
+		if (positionA.x != positionB.x) { return positionA.x < positionB.x; }
+		if (positionA.y != positionB.y) { return positionA.y < positionB.y; }
+		return positionA.z < positionB.z;
+	});
+
+	for (int sortedIndex = 1; sortedIndex < vertexCount; ++sortedIndex)
+	{
+		unsigned int previous = sortedVertices[sortedIndex - 1];
+		unsigned int current = sortedVertices[sortedIndex];
+
+		if (positions[previous] == positions[current])
+		{
+			out_kinds[previous] = SIMPLIFY_VERTEX_LOCKED;
+			out_kinds[current] = SIMPLIFY_VERTEX_LOCKED;
+		}
+	}
+
+	int triangleCount = (int) indices.size() / 3;
+	for (int triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex)
+	{
+		for (int corner = 0; corner < 3; ++corner)
+		{
+			unsigned int a = indices[triangleIndex * 3 + corner];
+			unsigned int b = indices[triangleIndex * 3 + (corner + 1) % 3];
+
+			if (!HasDirectedEdge(adjacency, indices, b, a))
+			{
+				if (out_kinds[a] == SIMPLIFY_VERTEX_INTERIOR) { out_kinds[a] = SIMPLIFY_VERTEX_BORDER; }
+				if (out_kinds[b] == SIMPLIFY_VERTEX_INTERIOR) { out_kinds[b] = SIMPLIFY_VERTEX_BORDER; }
+			}
+		}
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Sums each vertex's quadric from the planes of its triangles, weighted by area, and gives border
+// edges a plane perpendicular to their triangle so borders keep their outline
+//
+static void BuildQuadrics(const std::vector<Vector3>& positions, const std::vector<unsigned int>& indices, const SimplifyAdjacency_t& adjacency, std::vector<SimplifyQuadric_t>& out_quadrics)
+{
+	out_quadrics.assign(positions.size(), SimplifyQuadric_t());
+
+	int triangleCount = (int) indices.size() / 3;
+	for (int triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex)
+	{
+		const unsigned int* triangle = &indices[triangleIndex * 3];
+
+		Vector3 normal = CrossProduct(positions[triangle[1]] - positions[triangle[0]], positions[triangle[2]] - positions[triangle[0]]);
+		float area = 0.5f * normal.NormalizeAndGetLength();
+
+		if (area <= 0.f)
+		{
+			continue;
+		}
+
+		float d = -DotProduct(normal, positions[triangle[0]]);
+
+		for (int corner = 0; corner < 3; ++corner)
+		{
+			AddPlaneToQuadric(out_quadrics[triangle[corner]], normal, d, area);
+		}
+
+		for (int corner = 0; corner < 3; ++corner)
+		{
+			unsigned int a = triangle[corner];
+			unsigned int b = triangle[(corner + 1) % 3];
+
+			if (HasDirectedEdge(adjacency, indices, b, a))
+			{
+				continue;
+			}
+
+			Vector3 edge = positions[b] - positions[a];
+			float edgeLengthSquared = edge.GetLengthSquared();
+
+			Vector3 borderNormal = CrossProduct(edge, normal);
+			if (borderNormal.NormalizeAndGetLength() <= 0.f)
+			{
+				continue;
+			}
+
+			float borderD = -DotProduct(borderNormal, positions[a]);
+			float borderWeight = SIMPLIFY_BORDER_WEIGHT * edgeLengthSquared;
+
+			AddPlaneToQuadric(out_quadrics[a], borderNormal, borderD, borderWeight);
+			AddPlaneToQuadric(out_quadrics[b], borderNormal, borderD, borderWeight);
+		}
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns true if moving the vertex onto the target would turn any of its remaining triangles over,
+// reading the triangles through the collapses already made this pass
+//
+static bool DoesCollapseFlipTriangle(const std::vector<Vector3>& positions, const std::vector<unsigned int>& indices, const SimplifyAdjacency_t& adjacency, const std::vector<unsigned int>& remap, unsigned int from, unsigned int to)
+{
+	for (int adjacencyIndex = adjacency.offsets[from]; adjacencyIndex < adjacency.offsets[from + 1]; ++adjacencyIndex)
+	{
+		const unsigned int* triangle = &indices[adjacency.triangles[adjacencyIndex] * 3];
+
+		unsigned int corners[3] = { remap[triangle[0]], remap[triangle[1]], remap[triangle[2]] };
+
+		// Triangles along the collapsed edge are removed, not flipped
+		if (corners[0] == to || corners[1] == to || corners[2] == to)
+		{
+			continue;
+		}
+
+		Vector3 normalBefore = CrossProduct(positions[corners[1]] - positions[corners[0]], positions[corners[2]] - positions[corners[0]]);
+
+		for (int corner = 0; corner < 3; ++corner)
+		{
+			if (corners[corner] == from)
+			{
+				corners[corner] = to;
+			}
+		}
+
+		Vector3 normalAfter = CrossProduct(positions[corners[1]] - positions[corners[0]], positions[corners[2]] - positions[corners[0]]);
+
+		float minDot = SIMPLIFY_MIN_FLIP_COSINE * normalBefore.GetLength() * normalAfter.GetLength();
+		if (DotProduct(normalBefore, normalAfter) <= minDot)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the number of the vertex's triangles that also use the target, read through the collapses
+// already made this pass - the triangles collapsing the edge removes
+//
+static int CountTrianglesOnEdge(const std::vector<unsigned int>& indices, const SimplifyAdjacency_t& adjacency, const std::vector<unsigned int>& remap, unsigned int from, unsigned int to)
+{
+	int count = 0;
+
+	for (int adjacencyIndex = adjacency.offsets[from]; adjacencyIndex < adjacency.offsets[from + 1]; ++adjacencyIndex)
+	{
+		const unsigned int* triangle = &indices[adjacency.triangles[adjacencyIndex] * 3];
+
+		if (remap[triangle[0]] == to || remap[triangle[1]] == to || remap[triangle[2]] == to)
+		{
+			count++;
+		}
+	}
+
+	return count;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Garland and Heckbert's quadric error simplification, restricted to collapsing vertices onto their
+// neighbors so no new vertices are made, applied in passes like meshoptimizer's: each pass finds every
+// vertex's cheapest collapse, then makes them in order of error, at most one per vertex, up to a little
+// past the collapse that would reach the target
+// Positions are scaled to the unit box first, which is what makes the errors relative
+//
+float SimplifyMesh(const std::vector<VertexMaster>& vertices, std::vector<unsigned int>& indices, int targetIndexCount, float maxError /*= 1.f*/)
+{
+	int vertexCount = (int) vertices.size();
+	int targetTriangleCount = MaxInt(targetIndexCount / 3, 0);
+
+	if ((int) indices.size() / 3 <= targetTriangleCount || vertexCount == 0)
+	{
+		return 0.f;
+	}
+
+	Vector3 minPosition = vertices[0].m_position;
+	Vector3 maxPosition = vertices[0].m_position;
+
+	for (int vertexIndex = 1; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		const Vector3& position = vertices[vertexIndex].m_position;
+
+		minPosition = Vector3(MinFloat(minPosition.x, position.x), MinFloat(minPosition.y, position.y), MinFloat(minPosition.z, position.z));
+		maxPosition = Vector3(MaxFloat(maxPosition.x, position.x), MaxFloat(maxPosition.y, position.y), MaxFloat(maxPosition.z, position.z));
+	}
+
+	Vector3 extents = maxPosition - minPosition;
+	float meshScale = MaxFloat(extents.x, MaxFloat(extents.y, extents.z));
+	if (meshScale <= 0.f)
+	{
+		return 0.f;
+	}
+
+	std::vector<Vector3> positions(vertexCount);
+	for (int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		positions[vertexIndex] = (vertices[vertexIndex].m_position - minPosition) / meshScale;
+	}
+
+	SimplifyAdjacency_t adjacency;
+	BuildAdjacency(indices, vertexCount, adjacency);
+
+	std::vector<uint8_t> kinds;
+	ClassifyVertices(positions, indices, adjacency, kinds);
+
+	std::vector<SimplifyQuadric_t> quadrics;
+	BuildQuadrics(positions, indices, adjacency, quadrics);
+
+	float maxErrorSquared = maxError * maxError;
+	float resultErrorSquared = 0.f;
+
+	std::vector<SimplifyCollapse_t> collapses;
+	std::vector<unsigned int> remap(vertexCount);
+	std::vector<uint8_t> isTouched(vertexCount);
+
+	for (int passIndex = 0; passIndex < SIMPLIFY_MAX_PASSES; ++passIndex)
+	{
+		int triangleCount = (int) indices.size() / 3;
+		if (triangleCount <= targetTriangleCount)
+		{
+			break;
+		}
+
+		if (passIndex > 0)
+		{
+			BuildAdjacency(indices, vertexCount, adjacency);
+		}
+
+		// Find each vertex's cheapest collapse onto a neighbor
+		collapses.clear();
+
+		for (unsigned int from = 0; from < (unsigned int) vertexCount; ++from)
+		{
+			if (kinds[from] == SIMPLIFY_VERTEX_LOCKED)
+			{
+				continue;
+			}
+
+			SimplifyCollapse_t best;
+			best.from = from;
+			best.to = from;
+			best.error = FLT_MAX;
+
+			for (int adjacencyIndex = adjacency.offsets[from]; adjacencyIndex < adjacency.offsets[from + 1]; ++adjacencyIndex)
+			{
+				const unsigned int* triangle = &indices[adjacency.triangles[adjacencyIndex] * 3];
+
+				for (int corner = 0; corner < 3; ++corner)
+				{
+					unsigned int to = triangle[corner];
+
+					// Border vertices slide along the border, else it'd pull in
+					if (to == from || (kinds[from] == SIMPLIFY_VERTEX_BORDER && !IsBorderEdge(adjacency, indices, from, to)))
+					{
+						continue;
+					}
+
+					float error = EvaluateQuadric(quadrics[from], positions[to]);
+					if (error < best.error)
+					{
+						best.to = to;
+						best.error = error;
+					}
+				}
+			}
+
+			if (best.to != from && best.error <= maxErrorSquared)
+			{
+				collapses.push_back(best);
+			}
+		}
+
+		if (collapses.size() == 0)
+		{
+			break;
+		}
+
+		std::sort(collapses.begin(), collapses.end(), [](const SimplifyCollapse_t& a, const SimplifyCollapse_t& b) { return a.error < b.error; });
+
+		// Each collapse removes about two triangles, so stop a little past the error of the one reaching the goal
+		int goalCollapseCount = MinInt((triangleCount - targetTriangleCount + 1) / 2, (int) collapses.size());
+		float passErrorLimit = collapses[MaxInt(goalCollapseCount - 1, 0)].error * SIMPLIFY_ERROR_LIMIT_SCALE;
+
+		for (int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+		{
+			remap[vertexIndex] = (unsigned int) vertexIndex;
+		}
+
+		isTouched.assign(vertexCount, 0);
+
+		int removedTriangleCount = 0;
+		int collapseCount = 0;
+
+		for (int collapseIndex = 0; collapseIndex < (int) collapses.size(); ++collapseIndex)
+		{
+			const SimplifyCollapse_t& collapse = collapses[collapseIndex];
+
+			if (collapse.error > passErrorLimit || triangleCount - removedTriangleCount <= targetTriangleCount)
+			{
+				break;
+			}
+
+			// Only one collapse per vertex each pass, so every collapse's error is still accurate
+			if (isTouched[collapse.from] != 0 || isTouched[collapse.to] != 0)
+			{
+				continue;
+			}
+
+			if (DoesCollapseFlipTriangle(positions, indices, adjacency, remap, collapse.from, collapse.to))
+			{
+				continue;
+			}
+
+			removedTriangleCount += CountTrianglesOnEdge(indices, adjacency, remap, collapse.from, collapse.to);
+
+			remap[collapse.from] = collapse.to;
+			AddQuadric(quadrics[collapse.to], quadrics[collapse.from]);
+
+			isTouched[collapse.from] = 1;
+			isTouched[collapse.to] = 1;
+
+			resultErrorSquared = MaxFloat(resultErrorSquared, collapse.error);
+			collapseCount++;
+		}
+
+		if (collapseCount == 0)
+		{
+			break;
+		}
+
+		// Apply the collapses, dropping the triangles that lost an edge
+		int writeIndex = 0;
+		for (int triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex)
+		{
+			unsigned int a = remap[indices[triangleIndex * 3 + 0]];
+			unsigned int b = remap[indices[triangleIndex * 3 + 1]];
+			unsigned int c = remap[indices[triangleIndex * 3 + 2]];
+
+			if (a != b && b != c && c != a)
+			{
+				indices[writeIndex++] = a;
+				indices[writeIndex++] = b;
+				indices[writeIndex++] = c;
+			}
+		}
+
+		indices.resize(writeIndex);
+	}
+
+	return sqrtf(resultErrorSquared);
+}
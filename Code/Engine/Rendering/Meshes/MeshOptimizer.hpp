@@ -0,0 +1,40 @@
+/************************************************************************/
+/* File: MeshOptimizer.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Functions for welding, reordering and simplifying indexed
+/*				triangle lists, so the GPU transforms and fetches fewer vertices
+/************************************************************************/
+#pragma once
+#include <vector>
+#include "Engine/Rendering/Core/Vertex.hpp"
+
+#define MESH_OPTIMIZE_CACHE_SIZE (32)	// LRU cache the reordering scores against
+#define MESH_ACMR_CACHE_SIZE (16)		// FIFO cache ACMR is measured with, closer to what hardware has
+
+// Result of MeshBuilder::Optimize()
+struct MeshOptimizeStats_t
+{
+	int		vertexCountBefore = 0;
+	int		vertexCountAfter = 0;
+	float	acmrBefore = 0.f;
+	float	acmrAfter = 0.f;
+};
+
+// Average cache miss ratio - vertices transformed per triangle, from 0.5 at best to 3 at worst
+float	CalculateACMR(const unsigned int* indices, int indexCount, int vertexCount, int cacheSize = MESH_ACMR_CACHE_SIZE);
+
+// Removes vertices identical to an earlier one, pointing the indices at the one kept
+void	WeldVertices(std::vector<VertexMaster>& vertices, std::vector<unsigned int>& indices);
+
+// Reorders the triangles for post-transform cache hits, with Forsyth's linear-speed algorithm
+void	OptimizeVertexCache(unsigned int* indices, int indexCount, int vertexCount);
+
+// Reorders the vertices in the order the indices first use them, dropping any unused
+void	OptimizeVertexFetch(std::vector<VertexMaster>& vertices, std::vector<unsigned int>& indices);
+
+// Collapses edges by quadric error until there are targetIndexCount indices left, or the next collapse
+// would move the surface more than maxError, as a fraction of the mesh's largest dimension
+// Vertices are only collapsed onto each other, so the vertex list is unchanged - OptimizeVertexFetch()
+// drops the ones left unused. Returns the largest error of the collapses made, in the same units
+float	SimplifyMesh(const std::vector<VertexMaster>& vertices, std::vector<unsigned int>& indices, int targetIndexCount, float maxError = 1.f);
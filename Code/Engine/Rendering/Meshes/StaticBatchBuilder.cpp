@@ -0,0 +1,261 @@
+/************************************************************************/
+/* File: StaticBatchBuilder.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the StaticBatchBuilder class
+/************************************************************************/
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/Core/Renderable.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
+#include "Engine/Rendering/Meshes/StaticBatchBuilder.hpp"
+
+// Cell coordinates are packed 21 bits an axis for the batch map's keys
+#define STATIC_BATCH_KEY_AXIS_BITS (21)
+#define STATIC_BATCH_KEY_AXIS_MASK ((1ull << STATIC_BATCH_KEY_AXIS_BITS) - 1ull)
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Packs the cell coordinates into a map key, 21 bits an axis
+//
+static uint64_t GetCellKey(const IntVector3& cellCoords)
+{
+	uint64_t x = ((uint64_t) (uint32_t) cellCoords.x) & STATIC_BATCH_KEY_AXIS_MASK;
+	uint64_t y = ((uint64_t) (uint32_t) cellCoords.y) & STATIC_BATCH_KEY_AXIS_MASK;
+	uint64_t z = ((uint64_t) (uint32_t) cellCoords.z) & STATIC_BATCH_KEY_AXIS_MASK;
+
+	return x | (y << STATIC_BATCH_KEY_AXIS_BITS) | (z << (2 * STATIC_BATCH_KEY_AXIS_BITS));
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the determinant of the matrix's upper 3x3, negative when it mirrors
+//
+static float CalculateBasisDeterminant(const Matrix44& matrix)
+{
+	Vector3 iBasis = Vector3(matrix.Ix, matrix.Iy, matrix.Iz);
+	Vector3 jBasis = Vector3(matrix.Jx, matrix.Jy, matrix.Jz);
+	Vector3 kBasis = Vector3(matrix.Kx, matrix.Ky, matrix.Kz);
+
+	return DotProduct(iBasis, CrossProduct(jBasis, kBasis));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+StaticBatchBuilder::StaticBatchBuilder(float cellSize /*= STATIC_BATCH_DEFAULT_CELL_SIZE*/)
+	: m_cellSize(cellSize)
+{
+	ASSERT_OR_DIE(cellSize > 0.f, Stringf("Error: StaticBatchBuilder constructed with a cell size of %f", cellSize));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+StaticBatchBuilder::~StaticBatchBuilder()
+{
+	Clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Transforms the builder's vertices into world space and appends its triangles to its batch
+// Normals go through the inverse transpose so non-uniform scales keep them perpendicular, and
+// mirroring matrices flip the winding and the tangents' handedness, so the faces stay outward
+//
+void StaticBatchBuilder::AddMesh(const MeshBuilder& builder, const Matrix44& model, Material* material)
+{
+	PROFILE_SCOPE_CATEGORY("StaticBatchBuilder::AddMesh", "Meshes");
+
+	DrawInstruction instruction = builder.GetDrawInstruction();
+	ASSERT_OR_DIE(instruction.m_primType == PRIMITIVE_TRIANGLES, "Error: StaticBatchBuilder::AddMesh() called with a builder that isn't triangles");
+
+	int vertexCount = builder.GetVertexCount();
+	if (vertexCount == 0)
+	{
+		return;
+	}
+
+	AABB3 worldBounds = builder.GetBounds().GetTransformed(model);
+	Vector3 worldCenter = worldBounds.GetCenter();
+	IntVector3 cellCoords = IntVector3(Floor(worldCenter.x / m_cellSize), Floor(worldCenter.y / m_cellSize), Floor(worldCenter.z / m_cellSize));
+
+	StaticBatch_t& batch = GetOrCreateBatch(material, cellCoords);
+	MeshBuilder* batchBuilder = batch.builder;
+
+	Matrix44 normalMatrix = model.GetInverse();
+	normalMatrix.Transpose();
+
+	bool isMirrored = (CalculateBasisDeterminant(model) < 0.f);
+	float tangentSign = (isMirrored ? -1.f : 1.f);
+
+	unsigned int baseVertex = (unsigned int) batchBuilder->GetVertexCount();
+	batchBuilder->ReserveVertices(baseVertex + vertexCount);
+
+	for (int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		VertexMaster master = builder.GetVertexMaster(vertexIndex);
+
+		master.m_position = model.TransformPoint(master.m_position).xyz();
+		master.m_normal = normalMatrix.TransformVector(master.m_normal).xyz();
+		master.m_normal.NormalizeAndGetLength();
+
+		Vector3 tangent = model.TransformVector(master.m_tangent.xyz()).xyz();
+		tangent.NormalizeAndGetLength();
+		master.m_tangent = Vector4(tangent, master.m_tangent.w * tangentSign);
+
+		batchBuilder->PushVertex(master);
+	}
+
+	// Unindexed builders draw their vertices in order
+	int elementCount = (int) instruction.m_elementCount;
+	const std::vector<unsigned int>& indices = builder.GetIndices();
+
+	batchBuilder->ReserveIndices(batchBuilder->GetIndexCount() + elementCount);
+
+	for (int element = 0; element + 2 < elementCount; element += 3)
+	{
+		unsigned int first	= instruction.m_startIndex + element;
+		unsigned int second	= first + 1;
+		unsigned int third	= first + 2;
+
+		if (instruction.m_usingIndices)
+		{
+			first	= indices[first];
+			second	= indices[second];
+			third	= indices[third];
+		}
+
+		if (isMirrored)
+		{
+			batchBuilder->PushIndices(baseVertex + first, baseVertex + third, baseVertex + second);
+		}
+		else
+		{
+			batchBuilder->PushIndices(baseVertex + first, baseVertex + second, baseVertex + third);
+		}
+	}
+
+	// Finished after every add so the batch is always usable; its instruction keeps starting at 0
+	batchBuilder->FinishBuilding();
+
+	batch.sourceMeshCount++;
+	m_sourceMeshCount++;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes all batches
+//
+void StaticBatchBuilder::Clear()
+{
+	for (StaticBatch_t& batch : m_batches)
+	{
+		delete batch.builder;
+		batch.builder = nullptr;
+	}
+
+	m_batches.clear();
+	m_batchIndices.clear();
+	m_sourceMeshCount = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of batches, one per material and cell that had meshes added
+//
+int StaticBatchBuilder::GetBatchCount() const
+{
+	return (int) m_batches.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the batch at the index; its builder is finished, so it can be uploaded or cooked
+//
+const StaticBatch_t& StaticBatchBuilder::GetBatch(int batchIndex) const
+{
+	ASSERT_OR_DIE(batchIndex >= 0 && batchIndex < (int) m_batches.size(), Stringf("Error: StaticBatchBuilder::GetBatch() received bad index: %i", batchIndex));
+	return m_batches[batchIndex];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of meshes added across all batches
+//
+int StaticBatchBuilder::GetSourceMeshCount() const
+{
+	return m_sourceMeshCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds one draw per mesh of the group, which must have been made by this builder
+//
+void StaticBatchBuilder::AddToRenderable(Renderable& renderable, const MeshGroup* group) const
+{
+	ASSERT_OR_DIE(group->GetMeshCount() == (int) m_batches.size(), "Error: StaticBatchBuilder::AddToRenderable() called with a group that doesn't match the batches");
+
+	for (int batchIndex = 0; batchIndex < (int) m_batches.size(); ++batchIndex)
+	{
+		RenderableDraw_t draw;
+		draw.drawMatrix = Matrix44::IDENTITY;
+		draw.mesh = group->GetMesh(batchIndex);
+		draw.sharedMaterial = m_batches[batchIndex].material;
+
+		renderable.AddDraw(draw);
+	}
+
+	// Vertices are already in world space
+	if (renderable.GetInstanceCount() == 0)
+	{
+		renderable.AddInstanceMatrix(Matrix44::IDENTITY);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes every batch to a cooked mesh file, one mesh per batch in batch order
+//
+bool StaticBatchBuilder::WriteToCookedFile(const std::string& filepath, eCookedVertexType vertexType) const
+{
+	std::vector<MeshBuilder*> builders;
+	builders.reserve(m_batches.size());
+
+	for (const StaticBatch_t& batch : m_batches)
+	{
+		builders.push_back(batch.builder);
+	}
+
+	return CookedMeshFile::WriteToFile(filepath, builders, vertexType);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the batch for the material and cell, starting a new one if there isn't one yet
+//
+StaticBatch_t& StaticBatchBuilder::GetOrCreateBatch(Material* material, const IntVector3& cellCoords)
+{
+	std::map<uint64_t, int>& cellBatches = m_batchIndices[material];
+	uint64_t cellKey = GetCellKey(cellCoords);
+
+	std::map<uint64_t, int>::iterator itr = cellBatches.find(cellKey);
+	if (itr != cellBatches.end())
+	{
+		return m_batches[itr->second];
+	}
+
+	StaticBatch_t batch;
+	batch.material = material;
+	batch.cellCoords = cellCoords;
+	batch.builder = new MeshBuilder();
+	batch.builder->BeginBuilding(PRIMITIVE_TRIANGLES, true);
+
+	cellBatches[cellKey] = (int) m_batches.size();
+	m_batches.push_back(batch);
+
+	return m_batches.back();
+}
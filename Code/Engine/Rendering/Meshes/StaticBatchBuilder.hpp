@@ -0,0 +1,103 @@
+/************************************************************************/
+/* File: StaticBatchBuilder.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Merges static meshes that share a material into batches,
+/*				pre-transformed into world space and split into grid
+/*				cells, so a level's small pieces cost a few culled draws
+/************************************************************************/
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "Engine/Math/Matrix44.hpp"
+#include "Engine/Math/IntVector3.hpp"
+#include "Engine/Assets/CookedMeshFile.hpp"
+#include "Engine/Rendering/Meshes/Mesh.hpp"
+#include "Engine/Rendering/Meshes/MeshGroup.hpp"
+#include "Engine/Rendering/Meshes/MeshBuilder.hpp"
+
+class Material;
+class Renderable;
+
+// Side length of the world space cells batches are split by; each cell is a separately culled range
+#define STATIC_BATCH_DEFAULT_CELL_SIZE (32.f)
+
+struct StaticBatch_t
+{
+	Material*		material = nullptr;
+	IntVector3		cellCoords;
+	MeshBuilder*	builder = nullptr;	// World space triangles, indexed
+	int				sourceMeshCount = 0;
+};
+
+
+class StaticBatchBuilder
+{
+public:
+	//-----Public Methods-----
+
+	explicit StaticBatchBuilder(float cellSize = STATIC_BATCH_DEFAULT_CELL_SIZE);
+	~StaticBatchBuilder();
+
+	// Appends the builder's triangles, transformed by the model matrix, to the batch for the material and the
+	// cell holding the center of their world bounds; the builder must be triangles and keep its vertex masters
+	void				AddMesh(const MeshBuilder& builder, const Matrix44& model, Material* material);
+	void				Clear();
+
+	// Batches are in the order they were first added to, so the same adds always give the same batches
+	int					GetBatchCount() const;
+	const StaticBatch_t& GetBatch(int batchIndex) const;
+	int					GetSourceMeshCount() const;
+
+	// Makes one mesh per batch, in batch order - stored in the MeshArena, so every batch of a vertex layout
+	// shares one vertex and index buffer, each batch being a range of them with its own bounds
+	template <typename VERT_TYPE>
+	MeshGroup*			CreateMeshGroup() const;
+
+	// Adds a draw per mesh of the group, with its batch's material, and an identity instance if the renderable has none
+	// Each draw is culled alone, and draws of one material are merged into a multi-draw by the forward path
+	void				AddToRenderable(Renderable& renderable, const MeshGroup* group) const;
+
+	// For cooking offline - materials aren't written, they're the batches' in the same order
+	bool				WriteToCookedFile(const std::string& filepath, eCookedVertexType vertexType) const;
+
+
+private:
+	//-----Private Methods-----
+
+	StaticBatch_t&		GetOrCreateBatch(Material* material, const IntVector3& cellCoords);
+
+
+private:
+	//-----Private Data-----
+
+	float								m_cellSize = STATIC_BATCH_DEFAULT_CELL_SIZE;
+	int									m_sourceMeshCount = 0;
+
+	std::vector<StaticBatch_t>			m_batches;
+	std::map<Material*, std::map<uint64_t, int>>	m_batchIndices;	// Batch index by material, then by packed cell coordinates
+
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Makes a MeshGroup of the batches, each mesh stored in its layout's MeshArena
+//
+template <typename VERT_TYPE>
+MeshGroup* StaticBatchBuilder::CreateMeshGroup() const
+{
+	MeshGroup* group = new MeshGroup();
+
+	for (const StaticBatch_t& batch : m_batches)
+	{
+		Mesh* mesh = new Mesh();
+		mesh->SetStoredInArena(true);
+		batch.builder->UpdateMesh<VERT_TYPE>(*mesh);
+
+		group->AddMeshUnique(mesh);
+	}
+
+	return group;
+}
@@ -0,0 +1,236 @@
+/************************************************************************/
+/* File: GLLoaderThread.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the GLLoaderThread class
+/************************************************************************/
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
+#include "Engine/Rendering/OpenGL/GLLoaderThread.hpp"
+
+HGLRC							GLLoaderThread::s_context = NULL;
+ThreadHandle_t					GLLoaderThread::s_thread = nullptr;
+std::atomic<bool>				GLLoaderThread::s_isRunning{ false };
+Semaphore						GLLoaderThread::s_wakeSemaphore;
+std::mutex						GLLoaderThread::s_queueLock;
+std::deque<GLLoaderTask_t>		GLLoaderThread::s_queuedTasks;
+std::vector<GLLoaderTask_t>		GLLoaderThread::s_fencedTasks;
+int								GLLoaderThread::s_nextTaskID = 0;
+std::vector<GLLoaderTask_t>		GLLoaderThread::s_waitingTasks;
+std::atomic<int>				GLLoaderThread::s_pendingTaskCount{ 0 };
+
+
+//-----------------------------------------------------------------------------------------------
+// Creates the context sharing the main one's objects, then the thread to make it current on
+//
+bool GLLoaderThread::Start()
+{
+	if (s_isRunning)
+	{
+		return true;
+	}
+
+	s_context = CreateSharedRenderContext();
+
+	if (s_context == NULL)
+	{
+		LogTaggedPrintf("RENDER", "Error: GLLoaderThread couldn't create a shared context, GL work will stay on the main thread");
+		return false;
+	}
+
+	s_isRunning = true;
+	s_thread = Thread::Create(ThreadEntry, nullptr, "GL Loader");
+
+	LogTaggedPrintf("RENDER", "GLLoaderThread started with a shared context");
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stops the thread once its current task is done, then deletes its context and any fences left
+//
+void GLLoaderThread::Shutdown()
+{
+	if (!s_isRunning)
+	{
+		return;
+	}
+
+	s_isRunning = false;
+	s_wakeSemaphore.Release();
+
+	Thread::Join(s_thread);
+	s_thread = nullptr;
+
+	DestroySharedRenderContext(s_context);
+	s_context = NULL;
+
+	s_queueLock.lock();
+	{
+		int droppedCount = (int) s_queuedTasks.size();
+		s_queuedTasks.clear();
+
+		s_waitingTasks.insert(s_waitingTasks.end(), s_fencedTasks.begin(), s_fencedTasks.end());
+		s_fencedTasks.clear();
+
+		if (droppedCount > 0)
+		{
+			LogTaggedPrintf("RENDER", "GLLoaderThread shut down with %i tasks that never ran", droppedCount);
+		}
+	}
+	s_queueLock.unlock();
+
+	for (int taskIndex = 0; taskIndex < (int) s_waitingTasks.size(); ++taskIndex)
+	{
+		glDeleteSync(s_waitingTasks[taskIndex].fence);
+	}
+
+	s_waitingTasks.clear();
+	s_pendingTaskCount = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the loader thread is taking tasks
+//
+bool GLLoaderThread::IsRunning()
+{
+	return s_isRunning;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues the task for the loader thread, returning its ID
+//
+int GLLoaderThread::QueueTask(GLLoaderTask_cb task, GLLoaderTaskFinished_cb onFinished /*= nullptr*/, void* userData /*= nullptr*/)
+{
+	if (!s_isRunning)
+	{
+		return GL_LOADER_INVALID_TASK_ID;
+	}
+
+	GLLoaderTask_t entry;
+	entry.task = task;
+	entry.onFinished = onFinished;
+	entry.userData = userData;
+
+	s_queueLock.lock();
+	{
+		entry.id = s_nextTaskID++;
+		s_queuedTasks.push_back(entry);
+	}
+	s_queueLock.unlock();
+
+	s_pendingTaskCount++;
+	s_wakeSemaphore.Release();
+
+	return entry.id;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Takes the tasks the loader has fenced, and calls back the ones whose fences have passed, in order
+//
+void GLLoaderThread::Update()
+{
+	PROFILE_SCOPE_CATEGORY("GLLoaderThread::Update", "Rendering");
+
+	s_queueLock.lock();
+	{
+		s_waitingTasks.insert(s_waitingTasks.end(), s_fencedTasks.begin(), s_fencedTasks.end());
+		s_fencedTasks.clear();
+	}
+	s_queueLock.unlock();
+
+	int finishedCount = 0;
+
+	for (int taskIndex = 0; taskIndex < (int) s_waitingTasks.size(); ++taskIndex)
+	{
+		GLLoaderTask_t& task = s_waitingTasks[taskIndex];
+
+		// Fences pass in order on the one context, so nothing after an unsignaled one can have passed either
+		GLenum waitResult = glClientWaitSync(task.fence, 0, 0);
+		if (waitResult != GL_ALREADY_SIGNALED && waitResult != GL_CONDITION_SATISFIED)
+		{
+			break;
+		}
+
+		glDeleteSync(task.fence);
+		task.fence = nullptr;
+
+		if (task.onFinished != nullptr)
+		{
+			task.onFinished(task.id, task.userData);
+		}
+
+		finishedCount++;
+	}
+
+	if (finishedCount > 0)
+	{
+		s_waitingTasks.erase(s_waitingTasks.begin(), s_waitingTasks.begin() + finishedCount);
+		s_pendingTaskCount -= finishedCount;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of tasks queued, running or waiting on their fence
+//
+int GLLoaderThread::GetPendingTaskCount()
+{
+	return s_pendingTaskCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Loader thread - makes the shared context current and runs tasks as they come in, fencing each
+// The fence is flushed right away, since the main context can only wait on it once it's been submitted
+//
+void GLLoaderThread::ThreadEntry(void* userData)
+{
+	UNUSED(userData);
+
+	if (!wglMakeCurrent(gHDC, s_context))
+	{
+		LogTaggedPrintf("RENDER", "Error: GLLoaderThread couldn't make its context current");
+		s_isRunning = false;
+		return;
+	}
+
+	while (s_isRunning)
+	{
+		s_wakeSemaphore.Acquire();
+
+		GLLoaderTask_t task;
+		bool hasTask = false;
+
+		s_queueLock.lock();
+		{
+			if (s_isRunning && s_queuedTasks.size() > 0)
+			{
+				task = s_queuedTasks.front();
+				s_queuedTasks.pop_front();
+				hasTask = true;
+			}
+		}
+		s_queueLock.unlock();
+
+		if (!hasTask)
+		{
+			continue;
+		}
+
+		task.task(task.userData);
+
+		task.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		glFlush();
+
+		s_queueLock.lock();
+		s_fencedTasks.push_back(task);
+		s_queueLock.unlock();
+	}
+
+	wglMakeCurrent(NULL, NULL);
+}
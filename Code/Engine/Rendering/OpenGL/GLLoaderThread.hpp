@@ -0,0 +1,82 @@
+/************************************************************************/
+/* File: GLLoaderThread.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Optional thread with its own GL context, shared with the
+/*				main one, for creating and filling buffers, textures and
+/*				programs off the main thread; finished work is handed
+/*				back behind a fence
+/************************************************************************/
+#pragma once
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <vector>
+#include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include "Engine/Core/Threading/Semaphore.hpp"
+#include "Engine/Core/Threading/Threading.hpp"
+
+#define GL_LOADER_INVALID_TASK_ID (-1)
+
+// Runs on the loader thread with its context current - raw GL calls only, since GLStateCache tracks the main
+// context's bindings; VAOs and FBOs aren't shared between contexts, so they're still made on the main thread
+typedef void(*GLLoaderTask_cb)(void* userData);
+
+// Runs on the main thread once the GPU is past everything the task did, so the objects are safe to bind there
+typedef void(*GLLoaderTaskFinished_cb)(int taskID, void* userData);
+
+struct GLLoaderTask_t
+{
+	int							id = GL_LOADER_INVALID_TASK_ID;
+	GLLoaderTask_cb				task = nullptr;
+	GLLoaderTaskFinished_cb		onFinished = nullptr;
+	void*						userData = nullptr;
+	GLsync						fence = nullptr;		// Made on the loader context after the task
+};
+
+
+class GLLoaderThread
+{
+public:
+	//-----Public Methods-----
+
+	// Main thread - creates the shared context and the thread; returns false if the driver won't share,
+	// in which case GL work stays on the main thread, i.e. through the MainThreadScheduler
+	static bool		Start();
+	static void		Shutdown();		// Drops tasks that haven't run; before the main context is destroyed
+	static bool		IsRunning();
+
+	// Any thread; returns GL_LOADER_INVALID_TASK_ID if the loader isn't running
+	static int		QueueTask(GLLoaderTask_cb task, GLLoaderTaskFinished_cb onFinished = nullptr, void* userData = nullptr);
+
+	// Main thread - calls back the tasks whose fences have passed; called by the Renderer each frame
+	static void		Update();
+
+	static int		GetPendingTaskCount();
+
+
+private:
+	//-----Private Methods-----
+
+	GLLoaderThread() {}
+
+	static void		ThreadEntry(void* userData);
+
+
+private:
+	//-----Private Data-----
+
+	static HGLRC						s_context;
+	static ThreadHandle_t				s_thread;
+	static std::atomic<bool>			s_isRunning;
+	static Semaphore					s_wakeSemaphore;
+
+	static std::mutex					s_queueLock;
+	static std::deque<GLLoaderTask_t>	s_queuedTasks;			// Waiting for the loader thread
+	static std::vector<GLLoaderTask_t>	s_fencedTasks;			// Run, waiting to be taken by the main thread
+	static int							s_nextTaskID;
+
+	static std::vector<GLLoaderTask_t>	s_waitingTasks;			// Main thread only, waiting on their fences
+	static std::atomic<int>				s_pendingTaskCount;
+
+};
@@ -0,0 +1,623 @@
+/************************************************************************/
+/* File: GLStateCache.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the GLStateCache static class
+/************************************************************************/
+#include <string.h>
+#include "Engine/Core/Time/ProfileCounters.hpp"
+#include "Engine/Rendering/OpenGL/GLStateCache.hpp"
+
+// Value for state that may not match the driver, so the next bind is always issued
+#define GL_STATE_UNKNOWN (0xFFFFFFFF)
+
+struct GLTextureBinding_t
+{
+	GLenum target;
+	GLuint handle;
+};
+
+// The state as last sent to the driver
+struct GLBoundState_t
+{
+	GLuint				program;
+	GLuint				vertexArray;
+	GLuint				framebuffer;
+	GLenum				activeTextureUnit;
+	GLTextureBinding_t	textures[GL_STATE_CACHE_MAX_TEXTURE_UNITS];
+	GLuint				samplers[GL_STATE_CACHE_MAX_TEXTURE_UNITS];
+	GLuint				uniformBuffers[GL_STATE_CACHE_MAX_UNIFORM_BUFFERS];
+	GLuint				uniformBufferRanges[GL_STATE_CACHE_MAX_UNIFORM_BUFFERS][2];	// Offset and size, both 0 for the whole buffer
+
+	GLenum				cullEnabled;
+	GLenum				cullFace;
+	GLenum				polygonMode;
+	GLenum				frontFace;
+	GLenum				polygonOffsetEnabled;
+	GLuint				polygonOffset[2];	// Bits of the floats, so they compare exactly
+
+	GLenum				blendEnabled;
+	GLenum				blendOps[2];
+	GLenum				blendFactors[4];
+	GLenum				colorMask;
+
+	GLenum				depthTestEnabled;
+	GLenum				depthFunc;
+	GLenum				depthMask;
+};
+
+static GLBoundState_t			s_boundState;
+static GLStateChangeCounts_t	s_currentFrameCounts;
+static GLStateChangeCounts_t	s_lastFrameCounts;
+static bool						s_isInitialized = false;
+
+static void InitializeIfNeeded();
+static bool ShouldIssue(eStateChangeType type, GLuint& boundValue, GLuint newValue);
+static void CountIssued(eStateChangeType type);
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of requested changes that were sent to the driver
+//
+int GLStateChangeCounts_t::GetTotalIssued() const
+{
+	int total = 0;
+	for (int typeIndex = 0; typeIndex < NUM_STATE_CHANGE_TYPES; ++typeIndex)
+	{
+		total += issued[typeIndex];
+	}
+
+	return total;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of requested changes that matched the bound state and were skipped
+//
+int GLStateChangeCounts_t::GetTotalSkipped() const
+{
+	int total = 0;
+	for (int typeIndex = 0; typeIndex < NUM_STATE_CHANGE_TYPES; ++typeIndex)
+	{
+		total += skipped[typeIndex];
+	}
+
+	return total;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Makes the program current
+//
+bool GLStateCache::UseProgram(GLuint programHandle)
+{
+	InitializeIfNeeded();
+
+	if (!ShouldIssue(STATE_CHANGE_PROGRAM, s_boundState.program, programHandle))
+	{
+		return false;
+	}
+
+	glUseProgram(programHandle);
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Binds the vertex array object
+//
+bool GLStateCache::BindVertexArray(GLuint vaoHandle)
+{
+	InitializeIfNeeded();
+
+	if (!ShouldIssue(STATE_CHANGE_VERTEX_ARRAY, s_boundState.vertexArray, vaoHandle))
+	{
+		return false;
+	}
+
+	glBindVertexArray(vaoHandle);
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Binds the framebuffer for both drawing and reading
+//
+bool GLStateCache::BindFramebuffer(GLuint framebufferHandle)
+{
+	InitializeIfNeeded();
+
+	if (!ShouldIssue(STATE_CHANGE_FRAMEBUFFER, s_boundState.framebuffer, framebufferHandle))
+	{
+		return false;
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, framebufferHandle);
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Binds the texture to the unit, which is left as the active unit if the bind is issued
+// Code editing the texture's storage should call SetActiveTextureUnit() first, since a skipped
+// bind leaves the active unit as is
+//
+bool GLStateCache::BindTexture(unsigned int unit, GLenum target, GLuint textureHandle)
+{
+	InitializeIfNeeded();
+
+	if (unit < GL_STATE_CACHE_MAX_TEXTURE_UNITS)
+	{
+		GLTextureBinding_t& binding = s_boundState.textures[unit];
+
+		if (binding.target == target && binding.handle == textureHandle)
+		{
+			s_currentFrameCounts.skipped[STATE_CHANGE_TEXTURE]++;
+			return false;
+		}
+
+		binding.target = target;
+		binding.handle = textureHandle;
+	}
+
+	CountIssued(STATE_CHANGE_TEXTURE);
+
+	SetActiveTextureUnit(unit);
+	glBindTexture(target, textureHandle);
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Binds the sampler to the texture unit
+//
+bool GLStateCache::BindSampler(unsigned int unit, GLuint samplerHandle)
+{
+	InitializeIfNeeded();
+
+	if (unit < GL_STATE_CACHE_MAX_TEXTURE_UNITS)
+	{
+		if (!ShouldIssue(STATE_CHANGE_SAMPLER, s_boundState.samplers[unit], samplerHandle))
+		{
+			return false;
+		}
+	}
+	else
+	{
+		CountIssued(STATE_CHANGE_SAMPLER);
+	}
+
+	glBindSampler(unit, samplerHandle);
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Binds the buffer to the uniform block binding point
+//
+bool GLStateCache::BindUniformBuffer(unsigned int bindSlot, GLuint bufferHandle)
+{
+	InitializeIfNeeded();
+
+	return BindUniformBufferRange(bindSlot, bufferHandle, 0, 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Binds the range of the buffer to the uniform block binding point, or all of it for a 0 byte count
+//
+bool GLStateCache::BindUniformBufferRange(unsigned int bindSlot, GLuint bufferHandle, size_t byteOffset, size_t byteCount)
+{
+	InitializeIfNeeded();
+
+	if (bindSlot < GL_STATE_CACHE_MAX_UNIFORM_BUFFERS)
+	{
+		GLuint* boundRange = s_boundState.uniformBufferRanges[bindSlot];
+
+		if (s_boundState.uniformBuffers[bindSlot] == bufferHandle && boundRange[0] == (GLuint) byteOffset && boundRange[1] == (GLuint) byteCount)
+		{
+			s_currentFrameCounts.skipped[STATE_CHANGE_UNIFORM_BUFFER]++;
+			return false;
+		}
+
+		s_boundState.uniformBuffers[bindSlot] = bufferHandle;
+		boundRange[0] = (GLuint) byteOffset;
+		boundRange[1] = (GLuint) byteCount;
+	}
+
+	CountIssued(STATE_CHANGE_UNIFORM_BUFFER);
+
+	if (byteCount == 0)
+	{
+		glBindBufferBase(GL_UNIFORM_BUFFER, bindSlot, bufferHandle);
+	}
+	else
+	{
+		glBindBufferRange(GL_UNIFORM_BUFFER, bindSlot, bufferHandle, (GLintptr) byteOffset, (GLsizeiptr) byteCount);
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Makes the texture unit active; not counted, since it only matters for the bind that follows
+//
+void GLStateCache::SetActiveTextureUnit(unsigned int unit)
+{
+	InitializeIfNeeded();
+
+	if (s_boundState.activeTextureUnit != unit)
+	{
+		glActiveTexture(GL_TEXTURE0 + unit);
+		s_boundState.activeTextureUnit = unit;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Enables or disables face culling, culling the given face when enabled
+//
+void GLStateCache::SetCullMode(bool cullEnabled, GLenum cullFace)
+{
+	InitializeIfNeeded();
+
+	GLenum enabled = (cullEnabled ? GL_TRUE : GL_FALSE);
+	if (ShouldIssue(STATE_CHANGE_RASTER, s_boundState.cullEnabled, enabled))
+	{
+		if (cullEnabled)
+		{
+			glEnable(GL_CULL_FACE);
+		}
+		else
+		{
+			glDisable(GL_CULL_FACE);
+		}
+	}
+
+	// The cull face is ignored while culling is disabled, so don't bother changing it
+	if (cullEnabled && ShouldIssue(STATE_CHANGE_RASTER, s_boundState.cullFace, cullFace))
+	{
+		glCullFace(cullFace);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the fill mode for both faces
+//
+void GLStateCache::SetPolygonMode(GLenum fillMode)
+{
+	InitializeIfNeeded();
+
+	if (ShouldIssue(STATE_CHANGE_RASTER, s_boundState.polygonMode, fillMode))
+	{
+		glPolygonMode(GL_FRONT_AND_BACK, fillMode);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the winding order of front faces
+//
+void GLStateCache::SetFrontFace(GLenum windOrder)
+{
+	InitializeIfNeeded();
+
+	if (ShouldIssue(STATE_CHANGE_RASTER, s_boundState.frontFace, windOrder))
+	{
+		glFrontFace(windOrder);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Enables blending with the given equations and factors
+//
+void GLStateCache::SetBlendState(GLenum colorOp, GLenum alphaOp, GLenum colorSrc, GLenum colorDst, GLenum alphaSrc, GLenum alphaDst)
+{
+	InitializeIfNeeded();
+
+	if (ShouldIssue(STATE_CHANGE_BLEND, s_boundState.blendEnabled, GL_TRUE))
+	{
+		glEnable(GL_BLEND);
+	}
+
+	GLenum* ops = s_boundState.blendOps;
+	if (ops[0] != colorOp || ops[1] != alphaOp)
+	{
+		ops[0] = colorOp;
+		ops[1] = alphaOp;
+
+		CountIssued(STATE_CHANGE_BLEND);
+		glBlendEquationSeparate(colorOp, alphaOp);
+	}
+	else
+	{
+		s_currentFrameCounts.skipped[STATE_CHANGE_BLEND]++;
+	}
+
+	GLenum* factors = s_boundState.blendFactors;
+	if (factors[0] != colorSrc || factors[1] != colorDst || factors[2] != alphaSrc || factors[3] != alphaDst)
+	{
+		factors[0] = colorSrc;
+		factors[1] = colorDst;
+		factors[2] = alphaSrc;
+		factors[3] = alphaDst;
+
+		CountIssued(STATE_CHANGE_BLEND);
+		glBlendFuncSeparate(colorSrc, colorDst, alphaSrc, alphaDst);
+	}
+	else
+	{
+		s_currentFrameCounts.skipped[STATE_CHANGE_BLEND]++;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Enables depth testing with the given function, and sets whether depth is written
+//
+void GLStateCache::SetDepthState(GLenum depthFunc, bool writeDepth)
+{
+	InitializeIfNeeded();
+
+	if (ShouldIssue(STATE_CHANGE_DEPTH, s_boundState.depthTestEnabled, GL_TRUE))
+	{
+		glEnable(GL_DEPTH_TEST);
+	}
+
+	if (ShouldIssue(STATE_CHANGE_DEPTH, s_boundState.depthFunc, depthFunc))
+	{
+		glDepthFunc(depthFunc);
+	}
+
+	SetDepthMask(writeDepth);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets whether depth is written, also needed for depth clears
+//
+void GLStateCache::SetDepthMask(bool writeDepth)
+{
+	InitializeIfNeeded();
+
+	GLenum mask = (writeDepth ? GL_TRUE : GL_FALSE);
+	if (ShouldIssue(STATE_CHANGE_DEPTH, s_boundState.depthMask, mask))
+	{
+		glDepthMask((GLboolean) mask);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets whether color is written, to all channels
+//
+void GLStateCache::SetColorMask(bool writeColor)
+{
+	InitializeIfNeeded();
+
+	GLenum mask = (writeColor ? GL_TRUE : GL_FALSE);
+	if (ShouldIssue(STATE_CHANGE_BLEND, s_boundState.colorMask, mask))
+	{
+		glColorMask((GLboolean) mask, (GLboolean) mask, (GLboolean) mask, (GLboolean) mask);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the polygon offset applied to filled primitives' depth; offset is disabled if both are zero
+//
+void GLStateCache::SetDepthBias(float slopeScale, float constantBias)
+{
+	InitializeIfNeeded();
+
+	bool isBiased = (slopeScale != 0.f || constantBias != 0.f);
+	if (ShouldIssue(STATE_CHANGE_RASTER, s_boundState.polygonOffsetEnabled, (isBiased ? GL_TRUE : GL_FALSE)))
+	{
+		if (isBiased)
+		{
+			glEnable(GL_POLYGON_OFFSET_FILL);
+		}
+		else
+		{
+			glDisable(GL_POLYGON_OFFSET_FILL);
+		}
+	}
+
+	if (!isBiased)
+	{
+		return;
+	}
+
+	GLuint offsetBits[2];
+	memcpy(&offsetBits[0], &slopeScale, sizeof(float));
+	memcpy(&offsetBits[1], &constantBias, sizeof(float));
+
+	GLuint* boundOffset = s_boundState.polygonOffset;
+	if (boundOffset[0] != offsetBits[0] || boundOffset[1] != offsetBits[1])
+	{
+		boundOffset[0] = offsetBits[0];
+		boundOffset[1] = offsetBits[1];
+
+		CountIssued(STATE_CHANGE_RASTER);
+		glPolygonOffset(slopeScale, constantBias);
+	}
+	else
+	{
+		s_currentFrameCounts.skipped[STATE_CHANGE_RASTER]++;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Marks all state as unknown, for after GL calls the cache didn't see
+//
+void GLStateCache::Invalidate()
+{
+	memset(&s_boundState, 0xFF, sizeof(GLBoundState_t));
+	s_isInitialized = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Marks the framebuffer binding as unknown, for after binding separate read and draw framebuffers
+//
+void GLStateCache::InvalidateFramebuffer()
+{
+	s_boundState.framebuffer = GL_STATE_UNKNOWN;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Forgets the program if it's current
+//
+void GLStateCache::OnProgramDeleted(GLuint programHandle)
+{
+	if (s_boundState.program == programHandle)
+	{
+		s_boundState.program = GL_STATE_UNKNOWN;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Forgets the vertex array if it's bound
+//
+void GLStateCache::OnVertexArrayDeleted(GLuint vaoHandle)
+{
+	if (s_boundState.vertexArray == vaoHandle)
+	{
+		s_boundState.vertexArray = GL_STATE_UNKNOWN;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Forgets the framebuffer if it's bound
+//
+void GLStateCache::OnFramebufferDeleted(GLuint framebufferHandle)
+{
+	if (s_boundState.framebuffer == framebufferHandle)
+	{
+		s_boundState.framebuffer = GL_STATE_UNKNOWN;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Forgets the texture on every unit it's bound to
+//
+void GLStateCache::OnTextureDeleted(GLuint textureHandle)
+{
+	for (int unit = 0; unit < GL_STATE_CACHE_MAX_TEXTURE_UNITS; ++unit)
+	{
+		if (s_boundState.textures[unit].handle == textureHandle)
+		{
+			s_boundState.textures[unit].handle = GL_STATE_UNKNOWN;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Forgets the sampler on every unit it's bound to
+//
+void GLStateCache::OnSamplerDeleted(GLuint samplerHandle)
+{
+	for (int unit = 0; unit < GL_STATE_CACHE_MAX_TEXTURE_UNITS; ++unit)
+	{
+		if (s_boundState.samplers[unit] == samplerHandle)
+		{
+			s_boundState.samplers[unit] = GL_STATE_UNKNOWN;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Forgets the buffer on every uniform binding point it's bound to
+//
+void GLStateCache::OnBufferDeleted(GLuint bufferHandle)
+{
+	for (int bindSlot = 0; bindSlot < GL_STATE_CACHE_MAX_UNIFORM_BUFFERS; ++bindSlot)
+	{
+		if (s_boundState.uniformBuffers[bindSlot] == bufferHandle)
+		{
+			s_boundState.uniformBuffers[bindSlot] = GL_STATE_UNKNOWN;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Saves off the last frame's counts and starts counting the new frame
+//
+void GLStateCache::BeginFrame()
+{
+	s_lastFrameCounts = s_currentFrameCounts;
+	memset(&s_currentFrameCounts, 0, sizeof(GLStateChangeCounts_t));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the counts of the frame in progress
+//
+const GLStateChangeCounts_t& GLStateCache::GetCurrentFrameCounts()
+{
+	return s_currentFrameCounts;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the counts of the last full frame
+//
+const GLStateChangeCounts_t& GLStateCache::GetLastFrameCounts()
+{
+	return s_lastFrameCounts;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts with all state unknown, since the context's defaults aren't assumed
+//
+static void InitializeIfNeeded()
+{
+	if (!s_isInitialized)
+	{
+		GLStateCache::Invalidate();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the new value differs from the bound one, updating the bound value and counts
+//
+static bool ShouldIssue(eStateChangeType type, GLuint& boundValue, GLuint newValue)
+{
+	if (boundValue == newValue)
+	{
+		s_currentFrameCounts.skipped[type]++;
+		return false;
+	}
+
+	boundValue = newValue;
+	CountIssued(type);
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Counts a change sent to the driver, in the cache's stats and the profiler's counters
+//
+static void CountIssued(eStateChangeType type)
+{
+	s_currentFrameCounts.issued[type]++;
+	PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_STATE_CHANGES);
+
+	if (type == STATE_CHANGE_TEXTURE)
+	{
+		PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_TEXTURE_BINDS);
+	}
+}
@@ -0,0 +1,85 @@
+/************************************************************************/
+/* File: GLStateCache.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Shadow copy of the bound OpenGL state, so binds that
+/*				wouldn't change anything are never sent to the driver
+/*				Static class - cannot be instantiated
+/************************************************************************/
+#pragma once
+#include "Engine/Rendering/OpenGL/glFunctions.hpp"
+
+// Texture units and buffer binding points tracked; binds past these are always issued
+#define GL_STATE_CACHE_MAX_TEXTURE_UNITS (16)
+#define GL_STATE_CACHE_MAX_UNIFORM_BUFFERS (16)
+
+enum eStateChangeType
+{
+	STATE_CHANGE_PROGRAM,
+	STATE_CHANGE_VERTEX_ARRAY,
+	STATE_CHANGE_FRAMEBUFFER,
+	STATE_CHANGE_TEXTURE,
+	STATE_CHANGE_SAMPLER,
+	STATE_CHANGE_UNIFORM_BUFFER,
+	STATE_CHANGE_RASTER,		// Cull, fill and winding
+	STATE_CHANGE_BLEND,
+	STATE_CHANGE_DEPTH,
+	NUM_STATE_CHANGE_TYPES
+};
+
+// Counts of requested state changes, split by whether they reached the driver
+struct GLStateChangeCounts_t
+{
+	int issued[NUM_STATE_CHANGE_TYPES];
+	int skipped[NUM_STATE_CHANGE_TYPES];
+
+	int GetTotalIssued() const;
+	int GetTotalSkipped() const;
+};
+
+
+class GLStateCache
+{
+public:
+	//-----Public Methods-----
+
+	GLStateCache() = delete;
+
+	// Binds - each returns true if the call was sent to the driver
+	static bool UseProgram(GLuint programHandle);
+	static bool BindVertexArray(GLuint vaoHandle);
+	static bool BindFramebuffer(GLuint framebufferHandle);
+	static bool BindTexture(unsigned int unit, GLenum target, GLuint textureHandle);
+	static bool BindSampler(unsigned int unit, GLuint samplerHandle);
+	static bool BindUniformBuffer(unsigned int bindSlot, GLuint bufferHandle);
+	static bool BindUniformBufferRange(unsigned int bindSlot, GLuint bufferHandle, size_t byteOffset, size_t byteCount);
+	static void SetActiveTextureUnit(unsigned int unit);
+
+	// Fixed function state
+	static void SetCullMode(bool cullEnabled, GLenum cullFace);
+	static void SetPolygonMode(GLenum fillMode);
+	static void SetFrontFace(GLenum windOrder);
+	static void SetBlendState(GLenum colorOp, GLenum alphaOp, GLenum colorSrc, GLenum colorDst, GLenum alphaSrc, GLenum alphaDst);
+	static void SetDepthState(GLenum depthFunc, bool writeDepth);
+	static void SetDepthMask(bool writeDepth);
+	static void SetColorMask(bool writeColor);
+	static void SetDepthBias(float slopeScale, float constantBias);
+
+	// For GL calls made around the cache - the state is re-sent on its next bind
+	static void Invalidate();
+	static void InvalidateFramebuffer();
+
+	// Deleted GL names can be reused by new objects, so they must be forgotten
+	static void OnProgramDeleted(GLuint programHandle);
+	static void OnVertexArrayDeleted(GLuint vaoHandle);
+	static void OnFramebufferDeleted(GLuint framebufferHandle);
+	static void OnTextureDeleted(GLuint textureHandle);
+	static void OnSamplerDeleted(GLuint samplerHandle);
+	static void OnBufferDeleted(GLuint bufferHandle);
+
+	// Stats
+	static void BeginFrame();
+	static const GLStateChangeCounts_t& GetCurrentFrameCounts();
+	static const GLStateChangeCounts_t& GetLastFrameCounts();
+
+};
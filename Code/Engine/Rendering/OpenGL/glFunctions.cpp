@@ -5,9 +5,12 @@
 /* Bugs: None
 /* Description: Initializes the gl functions handles to null
 /************************************************************************/
+#include "Engine/Core/Window.hpp"
 #include "Engine/Core/DeveloperConsole/DevConsole.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include <string.h>
+
 // Members needed to create a modern context
 HMODULE gGLLibrary  = NULL; 
 HWND gGLwnd         = NULL;    // window our context is attached to; 
@@ -18,6 +21,7 @@ HGLRC gGLContext    = NULL;    // our rendering context;
 PFNWGLGETEXTENSIONSSTRINGARBPROC	wglGetExtensionsStringARB = nullptr;
 PFNWGLCHOOSEPIXELFORMATARBPROC		wglChoosePixelFormatARB = nullptr;
 PFNWGLCREATECONTEXTATTRIBSARBPROC	wglCreateContextAttribsARB = nullptr;
+PFNWGLSWAPINTERVALEXTPROC			wglSwapIntervalEXT = nullptr;
 
 //----------GL drawing functions----------
 PFNGLCLEARPROC			glClear = nullptr;
@@ -35,11 +39,13 @@ PFNGLFRONTFACEPROC				glFrontFace = nullptr;
 PFNGLCULLFACEPROC				glCullFace = nullptr;
 
 PFNGLGETATTRIBLOCATIONPROC			glGetAttribLocation = nullptr;
+PFNGLGETACTIVEATTRIBPROC			glGetActiveAttrib = nullptr;
 PFNGLENABLEVERTEXATTRIBARRAYPROC	glEnableVertexAttribArray = nullptr;
 PFNGLVERTEXATTRIBPOINTERPROC		glVertexAttribPointer = nullptr;
 PFNGLVERTEXATTRIBIPOINTERPROC		glVertexAttribIPointer = nullptr;
 PFNGLVERTEXATTRIBDIVISORPROC		glVertexAttribDivisor = nullptr;
 PFNGLGETUNIFORMLOCATIONPROC			glGetUniformLocation = nullptr;
+PFNGLGETUNIFORMIVPROC				glGetUniformiv = nullptr;
 PFNGLUNIFORMMATRIX4FVPROC			glUniformMatrix4fv = nullptr;
 PFNGLUNIFORM1IPROC					glUniform1i = nullptr;
 PFNGLUNIFORM1UIPROC					glUniform1ui = nullptr;
@@ -52,6 +58,8 @@ PFNGLDRAWARRAYSPROC					glDrawArrays = nullptr;
 PFNGLDRAWELEMENTSPROC				glDrawElements = nullptr;
 PFNGLDRAWARRAYSINSTANCEDPROC		glDrawArraysInstanced = nullptr;
 PFNGLDRAWELEMENTSINSTANCEDPROC		glDrawElementsInstanced = nullptr;
+PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC	glDrawElementsInstancedBaseVertex = nullptr;
+PFNGLMULTIDRAWELEMENTSINDIRECTPROC	glMultiDrawElementsIndirect = nullptr;
 
 PFNGLGETACTIVEUNIFORMNAMEPROC		glGetActiveUniformName = nullptr;
 PFNGLGETACTIVEUNIFORMBLOCKIVPROC	glGetActiveUniformBlockiv = nullptr;
@@ -72,10 +80,21 @@ PFNGLGETPROGRAMIVPROC		glGetProgramiv = nullptr;
 PFNGLDELETEPROGRAMPROC		glDeleteProgram = nullptr;
 PFNGLDETACHSHADERPROC		glDetachShader = nullptr;
 PFNGLGETPROGRAMINFOLOGPROC	glGetProgramInfoLog = nullptr;
+PFNGLPROGRAMPARAMETERIPROC	glProgramParameteri = nullptr;
+PFNGLGETPROGRAMBINARYPROC	glGetProgramBinary = nullptr;
+PFNGLPROGRAMBINARYPROC		glProgramBinary = nullptr;
+
+PFNGLMAXSHADERCOMPILERTHREADSARBPROC	glMaxShaderCompilerThreadsARB = nullptr;
 
 PFNGLDISPATCHCOMPUTEPROC				glDispatchCompute = nullptr;
+PFNGLDISPATCHCOMPUTEINDIRECTPROC		glDispatchComputeIndirect = nullptr;
 PFNGLMEMORYBARRIERPROC					glMemoryBarrier = nullptr;
 
+PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC	glDrawElementsInstancedBaseVertexBaseInstance = nullptr;
+PFNGLDRAWARRAYSINSTANCEDBASEINSTANCEPROC				glDrawArraysInstancedBaseInstance = nullptr;
+
+PFNGLBUFFERSTORAGEPROC					glBufferStorage = nullptr;
+
 //----------Vertex Array Objects----------
 PFNGLGENVERTEXARRAYSPROC	glGenVertexArrays = nullptr;
 PFNGLBINDVERTEXARRAYPROC	glBindVertexArray = nullptr;
@@ -86,12 +105,29 @@ PFNGLISVERTEXARRAYPROC		glIsVertexArray = nullptr;
 PFNGLGENBUFFERSPROC			glGenBuffers = nullptr;
 PFNGLBINDBUFFERPROC			glBindBuffer = nullptr;
 PFNGLBINDBUFFERBASEPROC		glBindBufferBase = nullptr;
+PFNGLBINDBUFFERRANGEPROC	glBindBufferRange = nullptr;
 PFNGLBUFFERDATAPROC			glBufferData = nullptr;
+PFNGLBUFFERSUBDATAPROC		glBufferSubData = nullptr;
 PFNGLDELETEBUFFERSPROC      glDeleteBuffers = nullptr;
 PFNGLMAPBUFFERPROC			glMapBuffer = nullptr;
+PFNGLMAPBUFFERRANGEPROC		glMapBufferRange = nullptr;
 PFNGLUNMAPBUFFERPROC		glUnmapBuffer = nullptr;
 PFNGLCOPYBUFFERSUBDATAPROC	glCopyBufferSubData = nullptr;
 
+//----------Sync----------
+PFNGLFENCESYNCPROC			glFenceSync = nullptr;
+PFNGLCLIENTWAITSYNCPROC		glClientWaitSync = nullptr;
+PFNGLDELETESYNCPROC			glDeleteSync = nullptr;
+PFNGLFLUSHPROC				glFlush = nullptr;
+
+//----------Queries----------
+PFNGLGENQUERIESPROC				glGenQueries = nullptr;
+PFNGLDELETEQUERIESPROC			glDeleteQueries = nullptr;
+PFNGLQUERYCOUNTERPROC			glQueryCounter = nullptr;
+PFNGLGETQUERYOBJECTIVPROC		glGetQueryObjectiv = nullptr;
+PFNGLGETQUERYOBJECTUI64VPROC	glGetQueryObjectui64v = nullptr;
+PFNGLGETINTEGER64VPROC			glGetInteger64v = nullptr;
+
 
 //----------Frame Buffer----------
 PFNGLGENFRAMEBUFFERSPROC			glGenFramebuffers = nullptr;
@@ -103,6 +139,8 @@ PFNGLCHECKFRAMEBUFFERSTATUSPROC		glCheckFramebufferStatus = nullptr;
 PFNGLBLITFRAMEBUFFERPROC			glBlitFramebuffer = nullptr;
 PFNGLDEPTHFUNCPROC					glDepthFunc = nullptr;
 PFNGLDEPTHMASKPROC					glDepthMask = nullptr;
+PFNGLCOLORMASKPROC					glColorMask = nullptr;
+PFNGLPOLYGONOFFSETPROC				glPolygonOffset = nullptr;
 PFNGLCLEARDEPTHFPROC				glClearDepthf = nullptr;
 PFNGLVIEWPORTPROC					glViewport = nullptr;
 
@@ -119,11 +157,19 @@ PFNGLCOPYIMAGESUBDATAPROC	glCopyImageSubData = nullptr;
 
 PFNGLTEXSTORAGE2DPROC		glTexStorage2D = nullptr;
 PFNGLTEXSUBIMAGE2DPROC		glTexSubImage2D = nullptr;
+PFNGLTEXSTORAGE3DPROC		glTexStorage3D = nullptr;
+PFNGLTEXSUBIMAGE3DPROC		glTexSubImage3D = nullptr;
+PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC	glCompressedTexSubImage2D = nullptr;
 PFNGLDELETETEXTURESPROC		glDeleteTextures = nullptr;	
 PFNGLGENERATEMIPMAPPROC		glGenerateMipmap = nullptr;
 
 PFNGLBINDIMAGETEXTUREPROC	glBindImageTexture = nullptr;
 
+PFNGLGETTEXTUREHANDLEARBPROC				glGetTextureHandleARB = nullptr;
+PFNGLGETTEXTURESAMPLERHANDLEARBPROC			glGetTextureSamplerHandleARB = nullptr;
+PFNGLMAKETEXTUREHANDLERESIDENTARBPROC		glMakeTextureHandleResidentARB = nullptr;
+PFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC	glMakeTextureHandleNonResidentARB = nullptr;
+
 
 //-----Samplers-----
 PFNGLGENSAMPLERSPROC		glGenSamplers = nullptr;
@@ -138,6 +184,7 @@ PFNGLGETERRORPROC			glGetError = nullptr;
 PFNGLREADPIXELSPROC			glReadPixels = nullptr;
 PFNGLGETINTEGERI_VPROC		glGetIntegeri_v = nullptr;
 PFNGLGETINTEGERVPROC		glGetIntegerv = nullptr;
+PFNGLGETSTRINGPROC			glGetString = nullptr;
 
 //-----------------------------------------------------------------------------------------------
 //----------------------------------------Local Functions----------------------------------------
@@ -183,6 +230,9 @@ HGLRC CreateOldRenderContext(HDC hdc)
 }
 
 
+static HGLRC CreateContextForVersion(HDC hdc, HGLRC shareContext, int major, int minor);
+
+
 //------------------------------------------------------------------------
 // Creates a real context as a specific version (major.minor) (the modern context)
 //
@@ -237,7 +287,16 @@ HGLRC CreateRealRenderContext( HDC hdc, int major, int minor )
 	}
 
 	// Okay, HDC is setup to the right format, now create our GL context
+	return CreateContextForVersion(hdc, NULL, major, minor);
+}
+
 
+//-----------------------------------------------------------------------------------------------
+// Creates a core context of the version on the HDC, which must already have its pixel format set
+// Shares objects with shareContext, if it isn't NULL
+//
+static HGLRC CreateContextForVersion(HDC hdc, HGLRC shareContext, int major, int minor)
+{
 	// First, options for creating a debug context (potentially slower, but 
 	// driver may report more useful errors). 
 	int context_flags = 0; 
@@ -255,7 +314,7 @@ HGLRC CreateRealRenderContext( HDC hdc, int major, int minor )
 	};
 
 	// Try to create context
-	HGLRC context = wglCreateContextAttribsARB( hdc, NULL, attribs );
+	HGLRC context = wglCreateContextAttribsARB( hdc, shareContext, attribs );
 	if (context == NULL) {
 		return NULL; 
 	}
@@ -275,6 +334,43 @@ void BindNewWGLFunctions()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns true if the WGL extension is in the device context's extensions string
+// Names are matched whole, so WGL_EXT_swap_control doesn't match WGL_EXT_swap_control_tear
+//
+bool IsWGLExtensionSupported(const char* extensionName)
+{
+	if (wglGetExtensionsStringARB == nullptr || gHDC == NULL)
+	{
+		return false;
+	}
+
+	const char* extensions = wglGetExtensionsStringARB(gHDC);
+	if (extensions == nullptr)
+	{
+		return false;
+	}
+
+	size_t nameLength = strlen(extensionName);
+	const char* current = strstr(extensions, extensionName);
+
+	while (current != nullptr)
+	{
+		bool startsWord = (current == extensions || current[-1] == ' ');
+		bool endsWord = (current[nameLength] == ' ' || current[nameLength] == '\0');
+
+		if (startsWord && endsWord)
+		{
+			return true;
+		}
+
+		current = strstr(current + nameLength, extensionName);
+	}
+
+	return false;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Binds the GL functions we will be using to the current context, called after the modern context
 // is created
@@ -297,11 +393,13 @@ void BindGLFunctions()
 	GL_BIND_FUNCTION(glCullFace);
 
 	GL_BIND_FUNCTION(glGetAttribLocation);
+	GL_BIND_FUNCTION(glGetActiveAttrib);
 	GL_BIND_FUNCTION(glEnableVertexAttribArray);
 	GL_BIND_FUNCTION(glVertexAttribDivisor);
 	GL_BIND_FUNCTION(glVertexAttribPointer);
 	GL_BIND_FUNCTION(glVertexAttribIPointer);
 	GL_BIND_FUNCTION(glGetUniformLocation);
+	GL_BIND_FUNCTION(glGetUniformiv);
 	GL_BIND_FUNCTION(glUniformMatrix4fv);
 	GL_BIND_FUNCTION(glUniform1i);
 	GL_BIND_FUNCTION(glUniform1ui);
@@ -320,6 +418,8 @@ void BindGLFunctions()
 	GL_BIND_FUNCTION(glDrawElements);
 	GL_BIND_FUNCTION(glDrawArraysInstanced);
 	GL_BIND_FUNCTION(glDrawElementsInstanced);
+	GL_BIND_FUNCTION(glDrawElementsInstancedBaseVertex);
+	GL_BIND_FUNCTION(glMultiDrawElementsIndirect);
 
 	// Shader functions
 	GL_BIND_FUNCTION(glCreateShader);
@@ -336,10 +436,26 @@ void BindGLFunctions()
 	GL_BIND_FUNCTION(glDetachShader);
 	GL_BIND_FUNCTION(glGetProgramInfoLog);
 	GL_BIND_FUNCTION(glDeleteProgram);
+	GL_BIND_FUNCTION(glProgramParameteri);
+	GL_BIND_FUNCTION(glGetProgramBinary);
+	GL_BIND_FUNCTION(glProgramBinary);
+
+	// Vsync control, if the driver has it
+	GL_BIND_OPTIONAL_FUNCTION(wglSwapIntervalEXT);
+
+	// Background shader compiles, if the driver has them
+	GL_BIND_OPTIONAL_FUNCTION(glMaxShaderCompilerThreadsARB);
 
 	GL_BIND_FUNCTION(glDispatchCompute);
+	GL_BIND_FUNCTION(glDispatchComputeIndirect);
 	GL_BIND_FUNCTION(glMemoryBarrier);
 
+	GL_BIND_FUNCTION(glDrawElementsInstancedBaseVertexBaseInstance);
+	GL_BIND_FUNCTION(glDrawArraysInstancedBaseInstance);
+
+	// Persistently mapped buffers, if the driver has them
+	GL_BIND_OPTIONAL_FUNCTION(glBufferStorage);
+
 	// VAO
 	GL_BIND_FUNCTION(glGenVertexArrays);
 	GL_BIND_FUNCTION(glBindVertexArray);
@@ -350,12 +466,29 @@ void BindGLFunctions()
 	GL_BIND_FUNCTION(glGenBuffers);
 	GL_BIND_FUNCTION(glBindBuffer);
 	GL_BIND_FUNCTION(glBindBufferBase);
+	GL_BIND_FUNCTION(glBindBufferRange);
 	GL_BIND_FUNCTION(glBufferData);
+	GL_BIND_FUNCTION(glBufferSubData);
 	GL_BIND_FUNCTION(glDeleteBuffers);
 	GL_BIND_FUNCTION(glMapBuffer);
+	GL_BIND_FUNCTION(glMapBufferRange);
 	GL_BIND_FUNCTION(glUnmapBuffer);
 	GL_BIND_FUNCTION(glCopyBufferSubData);
 
+	// Sync
+	GL_BIND_FUNCTION(glFenceSync);
+	GL_BIND_FUNCTION(glClientWaitSync);
+	GL_BIND_FUNCTION(glDeleteSync);
+	GL_BIND_FUNCTION(glFlush);
+
+	// Queries
+	GL_BIND_FUNCTION(glGenQueries);
+	GL_BIND_FUNCTION(glDeleteQueries);
+	GL_BIND_FUNCTION(glQueryCounter);
+	GL_BIND_FUNCTION(glGetQueryObjectiv);
+	GL_BIND_FUNCTION(glGetQueryObjectui64v);
+	GL_BIND_FUNCTION(glGetInteger64v);
+
 	// Frame Buffer
 	GL_BIND_FUNCTION(glGenFramebuffers);
 	GL_BIND_FUNCTION(glDeleteFramebuffers);
@@ -366,6 +499,8 @@ void BindGLFunctions()
 	GL_BIND_FUNCTION(glBlitFramebuffer);
 	GL_BIND_FUNCTION(glDepthFunc);
 	GL_BIND_FUNCTION(glDepthMask);
+	GL_BIND_FUNCTION(glColorMask);
+	GL_BIND_FUNCTION(glPolygonOffset);
 	GL_BIND_FUNCTION(glClearDepthf);
 	GL_BIND_FUNCTION(glViewport);
 
@@ -380,10 +515,19 @@ void BindGLFunctions()
 	GL_BIND_FUNCTION(glCopyImageSubData);
 	GL_BIND_FUNCTION(glTexStorage2D);
 	GL_BIND_FUNCTION(glTexSubImage2D);
+	GL_BIND_FUNCTION(glTexStorage3D);
+	GL_BIND_FUNCTION(glTexSubImage3D);
+	GL_BIND_FUNCTION(glCompressedTexSubImage2D);
 	GL_BIND_FUNCTION(glDeleteTextures);	
 	GL_BIND_FUNCTION(glGenerateMipmap);
 	GL_BIND_FUNCTION(glBindImageTexture);
 
+	// Bindless textures, if the driver has them
+	GL_BIND_OPTIONAL_FUNCTION(glGetTextureHandleARB);
+	GL_BIND_OPTIONAL_FUNCTION(glGetTextureSamplerHandleARB);
+	GL_BIND_OPTIONAL_FUNCTION(glMakeTextureHandleResidentARB);
+	GL_BIND_OPTIONAL_FUNCTION(glMakeTextureHandleNonResidentARB);
+
 	// Sampler generation
 	GL_BIND_FUNCTION(glGenSamplers);
 	GL_BIND_FUNCTION(glSamplerParameteri);
@@ -396,6 +540,7 @@ void BindGLFunctions()
 	GL_BIND_FUNCTION(glReadPixels);
 	GL_BIND_FUNCTION(glGetIntegeri_v);
 	GL_BIND_FUNCTION(glGetIntegerv);
+	GL_BIND_FUNCTION(glGetString);
 }
 
 
@@ -407,8 +552,14 @@ bool GLStartup()
 	// Ensure that RenderStartup is only called once, so the modern context is created once
 	GUARANTEE_OR_DIE(gGLContext == NULL, "Error: GLStartup called after the context was already created.");
 
-	// Get the active window to render to
-	HWND hwnd = GetActiveWindow();
+	// No window to render to
+	if (IsEngineHeadless())
+	{
+		return false;
+	}
+
+	// Get the window to render to - by handle, it belongs to the window's message thread
+	HWND hwnd = (HWND) Window::GetInstance()->GetHandle();
 
 	// load and get a handle to the opengl dll (dynamic link library)
 	gGLLibrary = LoadLibraryA("opengl32.dll"); 
@@ -443,12 +594,45 @@ bool GLStartup()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Creates another context on the window that shares objects with the main one, for making current on
+// a loader thread; returns NULL if there's no main context or the driver won't share
+// Buffers, textures, programs and syncs are shared, but container objects like VAOs and FBOs never are
+//
+HGLRC CreateSharedRenderContext()
+{
+	if (gGLContext == NULL)
+	{
+		return NULL;
+	}
+
+	return CreateContextForVersion(gHDC, gGLContext, 4, 3);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes a context from CreateSharedRenderContext(), which mustn't be current on any thread
+//
+void DestroySharedRenderContext(HGLRC context)
+{
+	if (context != NULL)
+	{
+		wglDeleteContext(context);
+	}
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Cleans up the GL context and libraries, only called when the program is exiting
 // (Not necessary, but good to be in the habit of cleaning up)
 //
 void GLShutdown()
 {
+	if (gGLContext == NULL)
+	{
+		return;
+	}
+
 	wglMakeCurrent( gHDC, NULL ); 
 
 	wglDeleteContext( gGLContext ); 
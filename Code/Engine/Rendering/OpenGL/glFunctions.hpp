@@ -24,11 +24,19 @@ extern HGLRC gGLContext;    // our rendering context;
 bool	GLStartup();	
 void    GLShutdown();
 
+// Secondary contexts sharing the main one's objects, see GLLoaderThread; main thread, after GLStartup()
+HGLRC	CreateSharedRenderContext();
+void	DestroySharedRenderContext(HGLRC context);
+
 // Windows context creation functions
 extern PFNWGLGETEXTENSIONSSTRINGARBPROC		wglGetExtensionsStringARB;
 extern PFNWGLCHOOSEPIXELFORMATARBPROC		wglChoosePixelFormatARB;
 extern PFNWGLCREATECONTEXTATTRIBSARBPROC	wglCreateContextAttribsARB;
 
+// Swap interval (WGL_EXT_swap_control) - optional, nullptr if the driver doesn't have it
+extern PFNWGLSWAPINTERVALEXTPROC			wglSwapIntervalEXT;
+bool IsWGLExtensionSupported(const char* extensionName);
+
 // GL drawing functions
 extern PFNGLCLEARPROC					glClear;
 extern PFNGLCLEARCOLORPROC				glClearColor;
@@ -46,11 +54,13 @@ extern PFNGLCULLFACEPROC				glCullFace;
 
 // Uniforms and attributes
 extern PFNGLGETATTRIBLOCATIONPROC		glGetAttribLocation;
+extern PFNGLGETACTIVEATTRIBPROC			glGetActiveAttrib;
 extern PFNGLENABLEVERTEXATTRIBARRAYPROC glEnableVertexAttribArray;
 extern PFNGLVERTEXATTRIBPOINTERPROC		glVertexAttribPointer;
 extern PFNGLVERTEXATTRIBIPOINTERPROC	glVertexAttribIPointer;
 extern PFNGLVERTEXATTRIBDIVISORPROC		glVertexAttribDivisor;
 extern PFNGLGETUNIFORMLOCATIONPROC		glGetUniformLocation;
+extern PFNGLGETUNIFORMIVPROC			glGetUniformiv;
 extern PFNGLUNIFORMMATRIX4FVPROC		glUniformMatrix4fv;
 extern PFNGLUNIFORM1IPROC				glUniform1i;
 extern PFNGLUNIFORM1UIPROC				glUniform1ui;
@@ -63,6 +73,8 @@ extern PFNGLDRAWARRAYSPROC				glDrawArrays;
 extern PFNGLDRAWELEMENTSPROC			glDrawElements;
 extern PFNGLDRAWARRAYSINSTANCEDPROC		glDrawArraysInstanced;
 extern PFNGLDRAWELEMENTSINSTANCEDPROC	glDrawElementsInstanced;
+extern PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC	glDrawElementsInstancedBaseVertex;
+extern PFNGLMULTIDRAWELEMENTSINDIRECTPROC	glMultiDrawElementsIndirect;
 
 extern PFNGLGETACTIVEUNIFORMNAMEPROC		glGetActiveUniformName;
 extern PFNGLGETACTIVEUNIFORMBLOCKIVPROC		glGetActiveUniformBlockiv;
@@ -83,10 +95,23 @@ extern PFNGLGETPROGRAMIVPROC		glGetProgramiv;
 extern PFNGLDELETEPROGRAMPROC		glDeleteProgram;
 extern PFNGLDETACHSHADERPROC		glDetachShader;
 extern PFNGLGETPROGRAMINFOLOGPROC	glGetProgramInfoLog;
+extern PFNGLPROGRAMPARAMETERIPROC	glProgramParameteri;
+extern PFNGLGETPROGRAMBINARYPROC	glGetProgramBinary;
+extern PFNGLPROGRAMBINARYPROC		glProgramBinary;
+
+// Background shader compiles (ARB_parallel_shader_compile) - optional, nullptr if the driver doesn't have them
+extern PFNGLMAXSHADERCOMPILERTHREADSARBPROC	glMaxShaderCompilerThreadsARB;
 
 extern PFNGLDISPATCHCOMPUTEPROC				glDispatchCompute;
+extern PFNGLDISPATCHCOMPUTEINDIRECTPROC		glDispatchComputeIndirect;
 extern PFNGLMEMORYBARRIERPROC				glMemoryBarrier;
 
+extern PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC	glDrawElementsInstancedBaseVertexBaseInstance;
+extern PFNGLDRAWARRAYSINSTANCEDBASEINSTANCEPROC				glDrawArraysInstancedBaseInstance;
+
+// Immutable, persistently mappable storage (ARB_buffer_storage) - optional, nullptr if the driver doesn't have it
+extern PFNGLBUFFERSTORAGEPROC				glBufferStorage;
+
 // For Vertex Array Objects
 extern PFNGLGENVERTEXARRAYSPROC		glGenVertexArrays;
 extern PFNGLBINDVERTEXARRAYPROC		glBindVertexArray;
@@ -97,12 +122,29 @@ extern PFNGLISVERTEXARRAYPROC		glIsVertexArray;
 extern PFNGLGENBUFFERSPROC			glGenBuffers;
 extern PFNGLBINDBUFFERPROC			glBindBuffer;
 extern PFNGLBINDBUFFERBASEPROC		glBindBufferBase;
+extern PFNGLBINDBUFFERRANGEPROC		glBindBufferRange;
 extern PFNGLBUFFERDATAPROC			glBufferData;
+extern PFNGLBUFFERSUBDATAPROC		glBufferSubData;
 extern PFNGLDELETEBUFFERSPROC       glDeleteBuffers;
 extern PFNGLMAPBUFFERPROC			glMapBuffer;
+extern PFNGLMAPBUFFERRANGEPROC		glMapBufferRange;
 extern PFNGLUNMAPBUFFERPROC			glUnmapBuffer;
 extern PFNGLCOPYBUFFERSUBDATAPROC	glCopyBufferSubData;
 
+// Sync
+extern PFNGLFENCESYNCPROC			glFenceSync;
+extern PFNGLCLIENTWAITSYNCPROC		glClientWaitSync;
+extern PFNGLDELETESYNCPROC			glDeleteSync;
+extern PFNGLFLUSHPROC				glFlush;		// Fences made on one context only become visible to another once flushed
+
+// Queries
+extern PFNGLGENQUERIESPROC				glGenQueries;
+extern PFNGLDELETEQUERIESPROC			glDeleteQueries;
+extern PFNGLQUERYCOUNTERPROC			glQueryCounter;
+extern PFNGLGETQUERYOBJECTIVPROC		glGetQueryObjectiv;
+extern PFNGLGETQUERYOBJECTUI64VPROC		glGetQueryObjectui64v;
+extern PFNGLGETINTEGER64VPROC			glGetInteger64v;
+
 // FrameBuffer
 extern PFNGLGENFRAMEBUFFERSPROC			glGenFramebuffers;
 extern PFNGLDELETEFRAMEBUFFERSPROC		glDeleteFramebuffers;
@@ -113,6 +155,8 @@ extern PFNGLCHECKFRAMEBUFFERSTATUSPROC	glCheckFramebufferStatus;
 extern PFNGLBLITFRAMEBUFFERPROC			glBlitFramebuffer;
 extern PFNGLDEPTHFUNCPROC				glDepthFunc;
 extern PFNGLDEPTHMASKPROC				glDepthMask;
+extern PFNGLCOLORMASKPROC				glColorMask;
+extern PFNGLPOLYGONOFFSETPROC			glPolygonOffset;
 extern PFNGLCLEARDEPTHFPROC				glClearDepthf;
 extern PFNGLVIEWPORTPROC				glViewport;
 
@@ -126,10 +170,19 @@ extern PFNGLACTIVETEXTUREPROC		glActiveTexture;
 extern PFNGLCOPYIMAGESUBDATAPROC	glCopyImageSubData;
 extern PFNGLTEXSTORAGE2DPROC		glTexStorage2D;
 extern PFNGLTEXSUBIMAGE2DPROC		glTexSubImage2D;
+extern PFNGLTEXSTORAGE3DPROC		glTexStorage3D;
+extern PFNGLTEXSUBIMAGE3DPROC		glTexSubImage3D;
+extern PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC	glCompressedTexSubImage2D;
 extern PFNGLDELETETEXTURESPROC		glDeleteTextures;	
 extern PFNGLGENERATEMIPMAPPROC		glGenerateMipmap;
 extern PFNGLBINDIMAGETEXTUREPROC	glBindImageTexture;
 
+// Bindless textures (ARB_bindless_texture) - optional, nullptr if the driver doesn't have them
+extern PFNGLGETTEXTUREHANDLEARBPROC				glGetTextureHandleARB;
+extern PFNGLGETTEXTURESAMPLERHANDLEARBPROC		glGetTextureSamplerHandleARB;
+extern PFNGLMAKETEXTUREHANDLERESIDENTARBPROC	glMakeTextureHandleResidentARB;
+extern PFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC	glMakeTextureHandleNonResidentARB;
+
 // Generating samplers
 extern PFNGLGENSAMPLERSPROC			glGenSamplers;
 extern PFNGLSAMPLERPARAMETERIPROC	glSamplerParameteri;
@@ -142,6 +195,7 @@ extern PFNGLGETERRORPROC			glGetError;
 extern PFNGLREADPIXELSPROC			glReadPixels;
 extern PFNGLGETINTEGERI_VPROC		glGetIntegeri_v;
 extern PFNGLGETINTEGERVPROC			glGetIntegerv;
+extern PFNGLGETSTRINGPROC			glGetString;
 
 // For binding GL functions through macro
 // Use this to deduce type of the pointer so we can cast; 
@@ -161,8 +215,22 @@ void wglGetTypedProcAddress( T *out, char const *name )
 	ASSERT_RECOVERABLE(*out != nullptr, Stringf("Error: gl function \"%s\" could not bind correctly", name));
 }
 
+// For functions of extensions the driver may not have, leaves them nullptr instead of asserting
+template <typename T>
+void wglGetOptionalTypedProcAddress( T *out, char const *name ) 
+{
+	*out = (T) wglGetProcAddress(name); 
+
+	// Some drivers return small error values instead of nullptr
+	if ((size_t) (*out) <= 3 || (size_t) (*out) == (size_t) -1)
+	{
+		*out = nullptr;
+	}
+}
+
 // Binding macro for GL functions
 #define GL_BIND_FUNCTION(f)      wglGetTypedProcAddress( &f, #f )
+#define GL_BIND_OPTIONAL_FUNCTION(f)      wglGetOptionalTypedProcAddress( &f, #f )
 
 // For GL error checking
 bool GLCheckError(char const *file, int line);
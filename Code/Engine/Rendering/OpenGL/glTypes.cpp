@@ -34,10 +34,14 @@ unsigned int g_openGLDataTypes[NUM_RDTS] =
 {
 	GL_FLOAT,
 	GL_UNSIGNED_BYTE,
-	GL_UNSIGNED_INT
+	GL_UNSIGNED_INT,
+	GL_UNSIGNED_SHORT,
+	GL_SHORT,
+	GL_HALF_FLOAT
 };
 
 unsigned int ToGLType(RenderDataType type) { return g_openGLDataTypes[type]; }
+bool IsFloatingPointType(RenderDataType type) { return (type == RDT_FLOAT || type == RDT_HALF_FLOAT); }
 
 
 //-----------------------------------------------------------------------------------------------
@@ -140,6 +144,33 @@ unsigned int GetGLTypeSize(unsigned int type)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns whether the GL uniform type is a sampler, which takes a texture unit instead of data
+//
+bool IsSamplerType(unsigned int type)
+{
+	switch ((GLenum) type)
+	{
+	case GL_SAMPLER_2D:
+	case GL_SAMPLER_3D:
+	case GL_SAMPLER_CUBE:
+	case GL_SAMPLER_2D_SHADOW:
+	case GL_SAMPLER_2D_ARRAY:
+	case GL_SAMPLER_2D_ARRAY_SHADOW:
+	case GL_SAMPLER_CUBE_SHADOW:
+	case GL_SAMPLER_2D_MULTISAMPLE:
+	case GL_SAMPLER_BUFFER:
+	case GL_INT_SAMPLER_2D:
+	case GL_INT_SAMPLER_BUFFER:
+	case GL_UNSIGNED_INT_SAMPLER_2D:
+	case GL_UNSIGNED_INT_SAMPLER_BUFFER:
+		return true;
+	default:
+		return false;
+	}
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Sampler Filtering
 //
@@ -190,6 +221,8 @@ unsigned int ToGLType(EdgeSampling sampling) { return g_openGLEdgeSamplings[samp
 // |-------------------------|-------------------------|-------------------------|-------------------------| //
 // |D24S8 (Depth24/Stencil8) |   GL_DEPTH24_STENCIL8   |     GL_DEPTH_STENCIL    |   GL_UNSIGNED_INT_24_8  | //
 // |-------------------------|-------------------------|-------------------------|-------------------------| //
+// |    BC1/3/4/5/7          |  GL_COMPRESSED_* block  |  (same as internal)     |         GL_NONE         | //
+// |-------------------------|-------------------------|-------------------------|-------------------------| //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // Internal Format
@@ -199,7 +232,12 @@ int g_openGLInternalFormats[NUM_TEXTURE_FORMATS] =
 	GL_RG8,
 	GL_RGB8,
 	GL_RGBA8,
-	GL_DEPTH24_STENCIL8
+	GL_DEPTH24_STENCIL8,
+	GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,
+	GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
+	GL_COMPRESSED_RED_RGTC1,
+	GL_COMPRESSED_RG_RGTC2,
+	GL_COMPRESSED_RGBA_BPTC_UNORM
 };
 
 // Channels
@@ -209,7 +247,12 @@ int g_openGLChannels[NUM_TEXTURE_FORMATS] =
 	GL_RG,
 	GL_RGB,
 	GL_RGBA,
-	GL_DEPTH_STENCIL
+	GL_DEPTH_STENCIL,
+	GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,		// Compressed uploads pass the internal format as the format
+	GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
+	GL_COMPRESSED_RED_RGTC1,
+	GL_COMPRESSED_RG_RGTC2,
+	GL_COMPRESSED_RGBA_BPTC_UNORM
 };
 
 // Pixel Layouts
@@ -219,13 +262,52 @@ int g_openGLPixelLayouts[NUM_TEXTURE_FORMATS] =
 	GL_UNSIGNED_BYTE,
 	GL_UNSIGNED_BYTE,
 	GL_UNSIGNED_BYTE,
-	GL_UNSIGNED_INT_24_8
+	GL_UNSIGNED_INT_24_8,
+	GL_NONE,
+	GL_NONE,
+	GL_NONE,
+	GL_NONE,
+	GL_NONE
+};
+
+// Bytes per 4x4 block
+unsigned int g_compressedBlockByteCounts[NUM_TEXTURE_FORMATS] =
+{
+	0,
+	0,
+	0,
+	0,
+	0,
+	8,
+	16,
+	8,
+	16,
+	16
+};
+
+// What each texel takes on the GPU, drivers pad RGB8 out to 4 bytes
+unsigned int g_texelByteCounts[NUM_TEXTURE_FORMATS] =
+{
+	1,
+	2,
+	4,
+	4,
+	4,
+	0,
+	0,
+	0,
+	0,
+	0
 };
 
 unsigned int ToGLInternalFormat(TextureFormat format) { return g_openGLInternalFormats[format]; }
 unsigned int ToGLChannel(TextureFormat format) { return g_openGLChannels[format]; }
 unsigned int ToGLPixelLayout(TextureFormat format) { return g_openGLPixelLayouts[format]; }
 
+bool IsCompressedFormat(TextureFormat format) { return (g_compressedBlockByteCounts[format] > 0); }
+unsigned int GetCompressedBlockByteCount(TextureFormat format) { return g_compressedBlockByteCounts[format]; }
+unsigned int GetTexelByteCount(TextureFormat format) { return g_texelByteCounts[format]; }
+
 
 //-----------------------------------------------------------------------------------------------
 // Texture Target Structure
@@ -233,7 +315,8 @@ unsigned int ToGLPixelLayout(TextureFormat format) { return g_openGLPixelLayouts
 int g_openGLTextureTypes[NUM_TEXTURE_TYPES]
 {
 	GL_TEXTURE_2D,
-	GL_TEXTURE_CUBE_MAP
+	GL_TEXTURE_CUBE_MAP,
+	GL_TEXTURE_2D_ARRAY
 };
 
 unsigned int ToGLType(TextureType type) { return g_openGLTextureTypes[type]; }
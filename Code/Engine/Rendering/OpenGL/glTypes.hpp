@@ -33,10 +33,14 @@ enum RenderDataType
 	RDT_FLOAT,
 	RDT_UNSIGNED_BYTE,
 	RDT_UNSIGNED_INT,
+	RDT_UNSIGNED_SHORT,
+	RDT_SHORT,
+	RDT_HALF_FLOAT,
 	NUM_RDTS
 };
 
 unsigned int ToGLType(RenderDataType type);
+bool IsFloatingPointType(RenderDataType type);
 
 
 //-----------------------------------------------------------------------------------------------
@@ -122,6 +126,7 @@ unsigned int ToGLType(BlendOp op);
 unsigned int ToGLType(BlendFactor factor);
 
 unsigned int GetGLTypeSize(unsigned int type);
+bool IsSamplerType(unsigned int type);
 
 
 //-----------------------------------------------------------------------------------------------
@@ -167,6 +172,13 @@ enum TextureFormat
 	TEXTURE_FORMAT_RGB8,
 	TEXTURE_FORMAT_RGBA8,
 	TEXTURE_FORMAT_D24S8,
+
+	// Block compressed, uploaded as stored in DDS/KTX2 files
+	TEXTURE_FORMAT_BC1,		// RGB + 1 bit alpha, 8 bytes per 4x4 block
+	TEXTURE_FORMAT_BC3,		// RGBA, 16 bytes per block
+	TEXTURE_FORMAT_BC4,		// R, 8 bytes per block
+	TEXTURE_FORMAT_BC5,		// RG (i.e. normal maps), 16 bytes per block
+	TEXTURE_FORMAT_BC7,		// RGBA at higher quality than BC3, 16 bytes per block
 	NUM_TEXTURE_FORMATS
 };
 
@@ -174,6 +186,10 @@ unsigned int ToGLInternalFormat(TextureFormat format);
 unsigned int ToGLChannel(TextureFormat format);
 unsigned int ToGLPixelLayout(TextureFormat format);
 
+bool			IsCompressedFormat(TextureFormat format);
+unsigned int	GetCompressedBlockByteCount(TextureFormat format);		// 0 for uncompressed formats
+unsigned int	GetTexelByteCount(TextureFormat format);				// 0 for compressed formats
+
 
 //-----------------------------------------------------------------------------------------------
 // Texture target structure
@@ -182,6 +198,7 @@ enum TextureType
 {
 	TEXTURE_TYPE_2D,
 	TEXTURE_TYPE_CUBE_MAP,
+	TEXTURE_TYPE_2D_ARRAY,
 	NUM_TEXTURE_TYPES
 };
 
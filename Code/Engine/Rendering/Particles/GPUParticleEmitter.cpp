@@ -0,0 +1,449 @@
+/************************************************************************/
+/* File: GPUParticleEmitter.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the GPUParticleEmitter class
+/************************************************************************/
+#include "Engine/Assets/AssetDB.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time/Stopwatch.hpp"
+#include "Engine/Rendering/Core/Renderer.hpp"
+#include "Engine/Rendering/Meshes/Mesh.hpp"
+#include "Engine/Rendering/Meshes/MeshBuilder.hpp"
+#include "Engine/Rendering/Materials/Material.hpp"
+#include "Engine/Rendering/Shaders/ShaderSource.hpp"
+#include "Engine/Rendering/Shaders/ComputeShader.hpp"
+#include "Engine/Rendering/Particles/GPUParticleEmitter.hpp"
+#include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include "Engine/Rendering/OpenGL/GLStateCache.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+
+ComputeShader*	GPUParticleEmitter::s_updateShader = nullptr;
+ComputeShader*	GPUParticleEmitter::s_spawnShader = nullptr;
+ComputeShader*	GPUParticleEmitter::s_finalizeShader = nullptr;
+Mesh*			GPUParticleEmitter::s_quadMesh = nullptr;
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - takes a clock for timing, all particles of this emitter will use this clock
+//
+GPUParticleEmitter::GPUParticleEmitter(Clock* referenceClock, unsigned int maxParticles)
+	: m_maxParticles(maxParticles)
+	, m_stopwatch(referenceClock)
+{
+	GUARANTEE_OR_DIE(maxParticles > 0, "Error: GPUParticleEmitter constructed with no max particles");
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+GPUParticleEmitter::~GPUParticleEmitter()
+{
+	if (m_vaoHandle != 0)
+	{
+		Renderer::GetInstance()->DeleteVAO(m_vaoHandle);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the emitter's transform to match the parameters specified
+//
+void GPUParticleEmitter::SetTransform(const Vector3& position, const Vector3& rotation, const Vector3& scale)
+{
+	transform.position = position;
+	transform.rotation = rotation;
+	transform.scale = scale;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the mesh each particle is drawn as and the material to draw it with
+//
+void GPUParticleEmitter::SetRenderMesh(Mesh* mesh, Material* material)
+{
+	m_mesh = mesh;
+	m_material = material;
+	m_isDrawCommandDirty = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues any particles due, then runs the compute passes - the live particles are aged, moved and
+// compacted into the other buffer, the queued ones are spawned after them, and the live count is
+// copied into the draw command
+// Nothing is read back, so this never waits on the GPU
+//
+void GPUParticleEmitter::Update()
+{
+	if (!m_isGPUDataInitialized)
+	{
+		InitializeGPUData();
+
+		if (!m_isGPUDataInitialized)
+		{
+			return;
+		}
+	}
+
+	if (m_spawnsOverTime)
+	{
+		m_pendingSpawnCount += (unsigned int) m_stopwatch.DecrementByIntervalAll();
+	}
+
+	if (m_isDrawCommandDirty)
+	{
+		UpdateDrawCommand();
+	}
+
+	// Each pass appends to the counts the last one wrote
+	DispatchUpdate(m_stopwatch.GetDeltaSeconds());
+	ComputeShader::InsertBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+	if (m_pendingSpawnCount > 0)
+	{
+		DispatchSpawn((unsigned int) MinInt((int) m_pendingSpawnCount, (int) m_maxParticles));
+		m_lastDeathTime = m_stopwatch.GetTotalSeconds() + m_maxSpawnLifetime;
+		m_pendingSpawnCount = 0;
+
+		ComputeShader::InsertBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+	}
+
+	DispatchFinalize();
+
+	// The particles are read by the render shader, and the command by the indirect draw
+	ComputeShader::InsertBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+
+	// What was just written is what's drawn and updated next
+	m_readBufferIndex = 1 - m_readBufferIndex;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Draws every live particle with one indirect draw, using the renderer's current camera
+//
+void GPUParticleEmitter::Draw()
+{
+	if (!m_isGPUDataInitialized || m_isDrawCommandDirty)
+	{
+		return;
+	}
+
+	m_particleBuffers[m_readBufferIndex].Bind(GPU_PARTICLE_READ_BINDING);
+	Renderer::GetInstance()->DrawMeshIndirect(m_vaoHandle, m_mesh, m_material, m_drawCommandBuffer.GetHandle());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues a single particle
+//
+void GPUParticleEmitter::SpawnParticle()
+{
+	SpawnBurst(1);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues a set of particles, equal to a value in the burst range of the emitter
+//
+void GPUParticleEmitter::SpawnBurst()
+{
+	int spawnCount = m_random.GetIntInRange(m_burstRange.min, m_burstRange.max);
+	SpawnBurst(spawnCount);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues a set of particles, equal to the value passed
+//
+void GPUParticleEmitter::SpawnBurst(unsigned int numToSpawn)
+{
+	m_pendingSpawnCount += numToSpawn;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the emitter to spawn the given number of particles per second
+//
+void GPUParticleEmitter::SetSpawnRate(unsigned int particlesPerSecond)
+{
+	if (particlesPerSecond == 0)
+	{
+		m_spawnsOverTime = false;
+	}
+	else
+	{
+		m_spawnsOverTime = true;
+		m_stopwatch.SetInterval(1.0f / (float) particlesPerSecond);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the burst range to the range specified
+//
+void GPUParticleEmitter::SetBurst(int minAmount, int maxAmount /*= -1*/)
+{
+	if (maxAmount == -1)
+	{
+		maxAmount = minAmount;
+	}
+
+	m_burstRange = IntRange(minAmount, maxAmount);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the acceleration applied to every particle
+//
+void GPUParticleEmitter::SetForce(const Vector3& force)
+{
+	m_force = force;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the flag to indicate whether this emitter should be deleted if done emitting particles
+//
+void GPUParticleEmitter::SetKillWhenDone(bool killWhenDone)
+{
+	m_killWhenDone = killWhenDone;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reseeds the emitter's generator, so the bursts and the GPU's spawned values replay the same
+//
+void GPUParticleEmitter::SetRandomSeed(uint64_t seed)
+{
+	m_random.Seed(seed);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the range spawned particles pick their velocity from
+//
+void GPUParticleEmitter::SetSpawnVelocityRange(const Vector3& minVelocity, const Vector3& maxVelocity)
+{
+	m_minSpawnVelocity = minVelocity;
+	m_maxSpawnVelocity = maxVelocity;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the range spawned particles pick their lifetime from
+//
+void GPUParticleEmitter::SetSpawnLifetimeRange(float minLifetime, float maxLifetime)
+{
+	m_minSpawnLifetime = minLifetime;
+	m_maxSpawnLifetime = maxLifetime;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the range spawned particles pick their scale from
+//
+void GPUParticleEmitter::SetSpawnScaleRange(const Vector3& minScale, const Vector3& maxScale)
+{
+	m_minSpawnScale = minScale;
+	m_maxSpawnScale = maxScale;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if this emitter is finished spawning, all its particles' lifetimes have passed,
+// and it should be deleted when done
+//
+bool GPUParticleEmitter::IsFinished() const
+{
+	return (m_killWhenDone && m_spawnsOverTime == false && m_pendingSpawnCount == 0 && m_stopwatch.GetTotalSeconds() >= m_lastDeathTime);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the most particles the emitter can have alive at once
+//
+unsigned int GPUParticleEmitter::GetMaxParticleCount() const
+{
+	return m_maxParticles;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes the compute shaders and quad shared by all emitters, called when the Renderer shuts down
+//
+void GPUParticleEmitter::DestroySharedResources()
+{
+	if (s_updateShader != nullptr)
+	{
+		delete s_updateShader;
+		s_updateShader = nullptr;
+	}
+
+	if (s_spawnShader != nullptr)
+	{
+		delete s_spawnShader;
+		s_spawnShader = nullptr;
+	}
+
+	if (s_finalizeShader != nullptr)
+	{
+		delete s_finalizeShader;
+		s_finalizeShader = nullptr;
+	}
+
+	if (s_quadMesh != nullptr)
+	{
+		delete s_quadMesh;
+		s_quadMesh = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Allocates the particle buffers and zeroes the counters, once the shared shaders are ready
+//
+void GPUParticleEmitter::InitializeGPUData()
+{
+	if (!InitializeSharedResources())
+	{
+		return;
+	}
+
+	size_t particleBytes = sizeof(GPUParticle_t) * m_maxParticles;
+	m_particleBuffers[0].AllocateOnGPU(particleBytes);
+	m_particleBuffers[1].AllocateOnGPU(particleBytes);
+
+	unsigned int counters[2] = { 0, 0 };
+	m_counterBuffer.CopyToGPU(sizeof(counters), counters);
+
+	m_isGPUDataInitialized = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the mesh's indices into the draw command and rebinds the VAO, for a new mesh or material
+// The instance count starts at zero, the finalize pass fills it in this same update
+//
+void GPUParticleEmitter::UpdateDrawCommand()
+{
+	if (m_mesh == nullptr)
+	{
+		m_mesh = s_quadMesh;
+	}
+
+	if (m_material == nullptr)
+	{
+		m_material = AssetDB::GetSharedMaterial("GPU_Particle");
+	}
+
+	DrawInstruction instruction = m_mesh->GetDrawInstruction();
+	GUARANTEE_OR_DIE(instruction.m_usingIndices, "Error: GPUParticleEmitter render mesh must use indices");
+
+	DrawElementsIndirectCommand_t command;
+	command.count = instruction.m_elementCount;
+	command.instanceCount = 0;
+	command.firstIndex = instruction.m_startIndex;
+	command.baseVertex = 0;
+	command.baseInstance = 0;
+
+	m_drawCommandBuffer.CopyToGPU(sizeof(command), &command);
+	Renderer::GetInstance()->UpdateVAO(m_vaoHandle, m_mesh, m_material);
+
+	m_isDrawCommandDirty = false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Ages and moves every live particle, writing the ones still alive to the write buffer
+//
+void GPUParticleEmitter::DispatchUpdate(float deltaSeconds)
+{
+	SetParticleBuffers(m_updateBindings);
+	m_updateBindings.SetUniformFloat(0, deltaSeconds);
+	m_updateBindings.SetUniformVector3(1, m_force);
+
+	// The live count is on the GPU, so dispatch for all of them and let the spare threads exit
+	int numGroups = (int) ((m_maxParticles + GPU_PARTICLE_GROUP_SIZE - 1) / GPU_PARTICLE_GROUP_SIZE);
+	s_updateShader->Dispatch(m_updateBindings, numGroups, 1, 1);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Spawns the given number of particles at the emitter after the survivors, while there's room
+//
+void GPUParticleEmitter::DispatchSpawn(unsigned int spawnCount)
+{
+	SetParticleBuffers(m_spawnBindings);
+	m_spawnBindings.SetUniformUInt(0, spawnCount);
+	m_spawnBindings.SetUniformUInt(1, m_random.GetNextUInt32());
+	m_spawnBindings.SetUniformUInt(2, m_maxParticles);
+	m_spawnBindings.SetUniformVector3(3, transform.position);
+	m_spawnBindings.SetUniformVector3(4, m_minSpawnVelocity);
+	m_spawnBindings.SetUniformVector3(5, m_maxSpawnVelocity);
+	m_spawnBindings.SetUniformFloat(6, m_minSpawnLifetime);
+	m_spawnBindings.SetUniformFloat(7, m_maxSpawnLifetime);
+	m_spawnBindings.SetUniformVector3(8, m_minSpawnScale);
+	m_spawnBindings.SetUniformVector3(9, m_maxSpawnScale);
+
+	int numGroups = (int) ((spawnCount + GPU_PARTICLE_GROUP_SIZE - 1) / GPU_PARTICLE_GROUP_SIZE);
+	s_spawnShader->Dispatch(m_spawnBindings, numGroups, 1, 1);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Makes the count written this update the live count, and the draw command's instance count
+//
+void GPUParticleEmitter::DispatchFinalize()
+{
+	SetParticleBuffers(m_finalizeBindings);
+	m_finalizeBindings.SetUniformUInt(0, m_maxParticles);
+
+	s_finalizeShader->Dispatch(m_finalizeBindings, 1, 1, 1);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the emitter's buffers on the pass's table, for the current read/write direction
+//
+void GPUParticleEmitter::SetParticleBuffers(ComputeBindingTable& bindings) const
+{
+	bindings.SetStorageBuffer(GPU_PARTICLE_READ_BINDING, &m_particleBuffers[m_readBufferIndex]);
+	bindings.SetStorageBuffer(GPU_PARTICLE_WRITE_BINDING, &m_particleBuffers[1 - m_readBufferIndex]);
+	bindings.SetStorageBuffer(GPU_PARTICLE_COUNTERS_BINDING, &m_counterBuffer);
+	bindings.SetStorageBuffer(GPU_PARTICLE_COMMAND_BINDING, &m_drawCommandBuffer);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Compiles the shared compute shaders and builds the default quad the first time an emitter
+// needs them, returning false if any shader failed to compile
+//
+bool GPUParticleEmitter::InitializeSharedResources()
+{
+	if (s_updateShader == nullptr)
+	{
+		s_updateShader = new ComputeShader();
+		s_updateShader->InitializeFromSource(ShaderSource::GPU_PARTICLE_UPDATE_CS, ShaderSource::GPU_PARTICLE_UPDATE_NAME);
+		s_updateShader->SetProfileName("GPUParticles::Update");
+
+		s_spawnShader = new ComputeShader();
+		s_spawnShader->InitializeFromSource(ShaderSource::GPU_PARTICLE_SPAWN_CS, ShaderSource::GPU_PARTICLE_SPAWN_NAME);
+		s_spawnShader->SetProfileName("GPUParticles::Spawn");
+
+		s_finalizeShader = new ComputeShader();
+		s_finalizeShader->InitializeFromSource(ShaderSource::GPU_PARTICLE_FINALIZE_CS, ShaderSource::GPU_PARTICLE_FINALIZE_NAME);
+		s_finalizeShader->SetProfileName("GPUParticles::Finalize");
+
+		MeshBuilder mb;
+		mb.BeginBuilding(PRIMITIVE_TRIANGLES, true);
+		mb.Push3DQuad(Vector3::ZERO, Vector2::ONES, AABB2::UNIT_SQUARE_OFFCENTER);
+		mb.FinishBuilding();
+
+		s_quadMesh = mb.CreateMesh<Vertex3D_PCU>();
+	}
+
+	return (s_updateShader->GetProgramHandle() != NULL && s_spawnShader->GetProgramHandle() != NULL && s_finalizeShader->GetProgramHandle() != NULL);
+}
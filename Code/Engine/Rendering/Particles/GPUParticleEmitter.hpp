@@ -0,0 +1,157 @@
+/************************************************************************/
+/* File: GPUParticleEmitter.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Emitter whose particles live and are simulated entirely
+/*				on the GPU - compute passes spawn, integrate and compact
+/*				them, and they're drawn with an indirect draw whose
+/*				instance count the GPU writes itself
+/************************************************************************/
+#pragma once
+#include <stdint.h>
+#include "Engine/Math/IntRange.hpp"
+#include "Engine/Math/Transform.hpp"
+#include "Engine/Math/RandomGenerator.hpp"
+#include "Engine/Core/Time/Stopwatch.hpp"
+#include "Engine/Rendering/Shaders/ComputeShader.hpp"
+#include "Engine/Rendering/Buffers/RenderBuffer.hpp"
+
+class Mesh;
+class Clock;
+class Material;
+
+// Shader storage bindings, must match the GPU particle shaders
+#define GPU_PARTICLE_READ_BINDING (10)		// Live particles, also read by the render shader
+#define GPU_PARTICLE_WRITE_BINDING (11)		// Survivors and new particles of this frame
+#define GPU_PARTICLE_COUNTERS_BINDING (12)
+#define GPU_PARTICLE_COMMAND_BINDING (13)
+
+#define GPU_PARTICLE_GROUP_SIZE (64)		// Threads per work group of the update and spawn passes, must match the shaders
+
+// Layout of one particle in the storage buffers, std430 in the shaders
+struct GPUParticle_t
+{
+	Vector3 position;
+	float	age;
+	Vector3 velocity;
+	float	lifetime;
+	Vector3 scale;
+	float	padding;
+};
+
+
+class GPUParticleEmitter
+{
+public:
+	//-----Public Methods-----
+
+	// The particle buffers are allocated at the first Update(), so this can be made off the render thread
+	GPUParticleEmitter(Clock* referenceClock, unsigned int maxParticles);
+	~GPUParticleEmitter();
+
+	void SetTransform(const Vector3& position, const Vector3& rotation, const Vector3& scale);
+
+	// Null mesh draws a unit quad, null material the built-in "GPU_Particle" one
+	// The material's shader must read its particle from the read binding by instance
+	void SetRenderMesh(Mesh* mesh, Material* material);
+
+	// Render thread only
+	void Update();
+	void Draw();
+
+	// Spawning - particles are queued here and made on the GPU in the next Update()
+	// Any spawned past the max particle count are dropped
+	void SpawnParticle();
+	void SpawnBurst();
+	void SpawnBurst(unsigned int numToSpawn);
+
+	void SetSpawnRate(unsigned int particlesPerSecond);
+	void SetBurst(int minAmount, int maxAmount = -1);
+	void SetForce(const Vector3& force);
+
+	void SetKillWhenDone(bool killWhenDone);
+	void SetRandomSeed(uint64_t seed);
+
+	// Spawned values are uniform in these ranges, generated per particle on the GPU
+	void SetSpawnVelocityRange(const Vector3& minVelocity, const Vector3& maxVelocity);
+	void SetSpawnLifetimeRange(float minLifetime, float maxLifetime);
+	void SetSpawnScaleRange(const Vector3& minScale, const Vector3& maxScale);
+
+	// Accessors
+	bool IsFinished() const;
+	unsigned int GetMaxParticleCount() const;
+
+	static void DestroySharedResources();
+
+
+public:
+	//-----Public Data-----
+
+	Transform transform;
+
+
+private:
+	//-----Private Methods-----
+
+	void InitializeGPUData();
+	void UpdateDrawCommand();
+	void DispatchUpdate(float deltaSeconds);
+	void DispatchSpawn(unsigned int spawnCount);
+	void DispatchFinalize();
+	void SetParticleBuffers(ComputeBindingTable& bindings) const;
+
+	static bool InitializeSharedResources();
+
+
+private:
+	//-----Private Data-----
+
+	unsigned int m_maxParticles = 0;
+	bool m_isGPUDataInitialized = false;
+
+	// Ping-ponged each update, particles are read from one and the survivors written to the other
+	RenderBuffer m_particleBuffers[2];
+	int m_readBufferIndex = 0;
+
+	RenderBuffer m_counterBuffer;		// Live count, and the count written this update
+	RenderBuffer m_drawCommandBuffer;	// DrawElementsIndirectCommand_t, instance count written by the GPU
+
+	// One per pass, since their uniforms share locations
+	ComputeBindingTable m_updateBindings;
+	ComputeBindingTable m_spawnBindings;
+	ComputeBindingTable m_finalizeBindings;
+
+	Mesh* m_mesh = nullptr;
+	Material* m_material = nullptr;
+	unsigned int m_vaoHandle = 0;
+	bool m_isDrawCommandDirty = true;
+
+	bool m_spawnsOverTime = false;
+	Stopwatch m_stopwatch;
+	unsigned int m_pendingSpawnCount = 0;
+
+	bool m_killWhenDone = false;
+	IntRange m_burstRange;
+
+	// On the CPU only to seed the GPU's generator each update, and pick burst sizes
+	RandomGenerator m_random;
+
+	Vector3 m_force = Vector3(0.f, -9.8f, 0.f);
+
+	Vector3 m_minSpawnVelocity = Vector3::ZERO;
+	Vector3 m_maxSpawnVelocity = Vector3::ZERO;
+	float m_minSpawnLifetime = 1.0f;
+	float m_maxSpawnLifetime = 1.0f;
+	Vector3 m_minSpawnScale = Vector3::ONES;
+	Vector3 m_maxSpawnScale = Vector3::ONES;
+
+	// The live count stays on the GPU, so finishing is judged by when the last spawned particle could die
+	float m_lastDeathTime = 0.f;
+
+	// Shared by all emitters
+	static ComputeShader* s_updateShader;
+	static ComputeShader* s_spawnShader;
+	static ComputeShader* s_finalizeShader;
+	static Mesh* s_quadMesh;
+
+};
@@ -0,0 +1,429 @@
+/************************************************************************/
+/* File: ParticleBatch.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the ParticleBatch class
+/************************************************************************/
+#include "Game/Framework/EngineBuildPreferences.hpp"
+#include "Engine/Math/Matrix44.hpp"
+#include "Engine/Rendering/Particles/ParticleBatch.hpp"
+#include "Engine/Core/Utility/ErrorWarningAssert.hpp"
+#include "Engine/Core/Utility/StringUtils.hpp"
+
+// Same compile time selection as Matrix44 and BoundsBatch - 8 lanes with AVX, 4 with SSE or NEON,
+// and one lane as the scalar reference when MATRIX44_FORCE_SCALAR is defined or there's no SIMD
+#if !defined(MATRIX44_FORCE_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#if defined(__AVX__)
+#define PARTICLE_BATCH_SIMD_AVX
+#include <immintrin.h>
+#else
+#define PARTICLE_BATCH_SIMD_SSE
+#include <emmintrin.h>
+#endif
+#elif !defined(MATRIX44_FORCE_SCALAR) && (defined(__ARM_NEON) || defined(_M_ARM64))
+#define PARTICLE_BATCH_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+// Integration only needs loads, stores and multiply-adds; the arrays are only float aligned in
+// std::vector, so every load and store is unaligned
+#if defined(PARTICLE_BATCH_SIMD_AVX)
+
+typedef __m256 Lanes_t;
+#define LANE_COUNT (8)
+
+static inline Lanes_t	LoadLanes(const float* values)				{ return _mm256_loadu_ps(values); }
+static inline void		StoreLanes(float* out_values, Lanes_t lanes)	{ _mm256_storeu_ps(out_values, lanes); }
+static inline Lanes_t	SplatLanes(float value)						{ return _mm256_set1_ps(value); }
+static inline Lanes_t	MultiplyAddLanes(Lanes_t a, Lanes_t b, Lanes_t c) { return _mm256_add_ps(a, _mm256_mul_ps(b, c)); }
+
+#elif defined(PARTICLE_BATCH_SIMD_SSE)
+
+typedef __m128 Lanes_t;
+#define LANE_COUNT (4)
+
+static inline Lanes_t	LoadLanes(const float* values)				{ return _mm_loadu_ps(values); }
+static inline void		StoreLanes(float* out_values, Lanes_t lanes)	{ _mm_storeu_ps(out_values, lanes); }
+static inline Lanes_t	SplatLanes(float value)						{ return _mm_set1_ps(value); }
+static inline Lanes_t	MultiplyAddLanes(Lanes_t a, Lanes_t b, Lanes_t c) { return _mm_add_ps(a, _mm_mul_ps(b, c)); }
+
+#elif defined(PARTICLE_BATCH_SIMD_NEON)
+
+typedef float32x4_t Lanes_t;
+#define LANE_COUNT (4)
+
+static inline Lanes_t	LoadLanes(const float* values)				{ return vld1q_f32(values); }
+static inline void		StoreLanes(float* out_values, Lanes_t lanes)	{ vst1q_f32(out_values, lanes); }
+static inline Lanes_t	SplatLanes(float value)						{ return vdupq_n_f32(value); }
+static inline Lanes_t	MultiplyAddLanes(Lanes_t a, Lanes_t b, Lanes_t c) { return vaddq_f32(a, vmulq_f32(b, c)); }
+
+#else
+
+// Scalar reference - one lane
+typedef float Lanes_t;
+#define LANE_COUNT (1)
+
+static inline Lanes_t	LoadLanes(const float* values)				{ return *values; }
+static inline void		StoreLanes(float* out_values, Lanes_t lanes)	{ *out_values = lanes; }
+static inline Lanes_t	SplatLanes(float value)						{ return value; }
+static inline Lanes_t	MultiplyAddLanes(Lanes_t a, Lanes_t b, Lanes_t c) { return a + b * c; }
+
+#endif
+
+static_assert(PARTICLE_BATCH_PADDING % LANE_COUNT == 0, "Particle batches must be padded to a multiple of the SIMD width");
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Grows the padded array to hold count values, filling the new lanes with zeros
+//
+static void EnsurePaddedSize(std::vector<float>& values, int count)
+{
+	int paddedSize = ((count + PARTICLE_BATCH_PADDING - 1) / PARTICLE_BATCH_PADDING) * PARTICLE_BATCH_PADDING;
+
+	if (static_cast<int>(values.size()) < paddedSize)
+	{
+		values.resize(paddedSize, 0.f);
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Sets count values from firstIndex on to the given value
+//
+static void FillValues(std::vector<float>& values, int firstIndex, int count, float value)
+{
+	float* destination = values.data() + firstIndex;
+
+	for (int index = 0; index < count; ++index)
+	{
+		destination[index] = value;
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Scatters the vectors into the three arrays of a field, from firstIndex on
+//
+static void ScatterVectors(std::vector<float>& out_x, std::vector<float>& out_y, std::vector<float>& out_z, int firstIndex, int count, const Vector3* vectors)
+{
+	for (int index = 0; index < count; ++index)
+	{
+		out_x[firstIndex + index] = vectors[index].x;
+		out_y[firstIndex + index] = vectors[index].y;
+		out_z[firstIndex + index] = vectors[index].z;
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// values += rates * deltaSeconds, over every lane of the arrays
+//
+static void IntegrateValues(float* values, const float* rates, Lanes_t deltaSeconds, int laneGroupCount)
+{
+	for (int groupIndex = 0; groupIndex < laneGroupCount; ++groupIndex)
+	{
+		int first = groupIndex * LANE_COUNT;
+		StoreLanes(values + first, MultiplyAddLanes(LoadLanes(values + first), LoadLanes(rates + first), deltaSeconds));
+	}
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// values += rate * deltaSeconds, with the same rate for every lane
+//
+static void IntegrateValuesUniform(float* values, Lanes_t rate, Lanes_t deltaSeconds, int laneGroupCount)
+{
+	for (int groupIndex = 0; groupIndex < laneGroupCount; ++groupIndex)
+	{
+		int first = groupIndex * LANE_COUNT;
+		StoreLanes(values + first, MultiplyAddLanes(LoadLanes(values + first), rate, deltaSeconds));
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Appends count particles, at rest at the origin with unit scale, and returns the first one's index
+// Their lifetimes are empty, so they're removed on the next RemoveDeadParticles() unless set
+//
+int ParticleBatch::AddParticles(int count)
+{
+	int firstIndex = m_count;
+	int newCount = m_count + count;
+
+	std::vector<float>* fields[] =
+	{
+		&m_positionX, &m_positionY, &m_positionZ, &m_velocityX, &m_velocityY, &m_velocityZ,
+		&m_rotationX, &m_rotationY, &m_rotationZ, &m_angularVelocityX, &m_angularVelocityY, &m_angularVelocityZ,
+		&m_scaleX, &m_scaleY, &m_scaleZ, &m_timeCreated, &m_timeToDestroy
+	};
+
+	// Slots past the count may still hold removed particles, so every field is reset
+	for (std::vector<float>* field : fields)
+	{
+		EnsurePaddedSize(*field, newCount);
+		FillValues(*field, firstIndex, count, 0.f);
+	}
+
+	FillValues(m_scaleX, firstIndex, count, 1.f);
+	FillValues(m_scaleY, firstIndex, count, 1.f);
+	FillValues(m_scaleZ, firstIndex, count, 1.f);
+
+	m_count = newCount;
+	return firstIndex;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reserves space for count particles, so spawning that many won't allocate
+//
+void ParticleBatch::Reserve(int count)
+{
+	size_t paddedCount = static_cast<size_t>(((count + PARTICLE_BATCH_PADDING - 1) / PARTICLE_BATCH_PADDING) * PARTICLE_BATCH_PADDING);
+
+	std::vector<float>* fields[] =
+	{
+		&m_positionX, &m_positionY, &m_positionZ, &m_velocityX, &m_velocityY, &m_velocityZ,
+		&m_rotationX, &m_rotationY, &m_rotationZ, &m_angularVelocityX, &m_angularVelocityY, &m_angularVelocityZ,
+		&m_scaleX, &m_scaleY, &m_scaleZ, &m_timeCreated, &m_timeToDestroy
+	};
+
+	for (std::vector<float>* field : fields)
+	{
+		field->reserve(paddedCount);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes all particles, keeping the memory
+//
+void ParticleBatch::Clear()
+{
+	m_count = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of live particles
+//
+int ParticleBatch::GetCount() const
+{
+	return m_count;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Places count particles from firstIndex on at the given position
+//
+void ParticleBatch::SetPositions(int firstIndex, int count, const Vector3& position)
+{
+	ASSERT_OR_DIE(firstIndex >= 0 && firstIndex + count <= m_count, Stringf("Error: ParticleBatch::SetPositions called on particles %i to %i, batch only has %i", firstIndex, firstIndex + count, m_count));
+
+	FillValues(m_positionX, firstIndex, count, position.x);
+	FillValues(m_positionY, firstIndex, count, position.y);
+	FillValues(m_positionZ, firstIndex, count, position.z);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the velocities of count particles from firstIndex on, one value each
+//
+void ParticleBatch::SetVelocities(int firstIndex, int count, const Vector3* velocities)
+{
+	ASSERT_OR_DIE(firstIndex >= 0 && firstIndex + count <= m_count, Stringf("Error: ParticleBatch::SetVelocities called on particles %i to %i, batch only has %i", firstIndex, firstIndex + count, m_count));
+	ScatterVectors(m_velocityX, m_velocityY, m_velocityZ, firstIndex, count, velocities);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the angular velocities (degrees per second) of count particles from firstIndex on, one value each
+//
+void ParticleBatch::SetAngularVelocities(int firstIndex, int count, const Vector3* angularVelocities)
+{
+	ASSERT_OR_DIE(firstIndex >= 0 && firstIndex + count <= m_count, Stringf("Error: ParticleBatch::SetAngularVelocities called on particles %i to %i, batch only has %i", firstIndex, firstIndex + count, m_count));
+	ScatterVectors(m_angularVelocityX, m_angularVelocityY, m_angularVelocityZ, firstIndex, count, angularVelocities);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the scales of count particles from firstIndex on, one value each
+//
+void ParticleBatch::SetScales(int firstIndex, int count, const Vector3* scales)
+{
+	ASSERT_OR_DIE(firstIndex >= 0 && firstIndex + count <= m_count, Stringf("Error: ParticleBatch::SetScales called on particles %i to %i, batch only has %i", firstIndex, firstIndex + count, m_count));
+	ScatterVectors(m_scaleX, m_scaleY, m_scaleZ, firstIndex, count, scales);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts count particles from firstIndex on at timeCreated, each living for its given number of seconds
+//
+void ParticleBatch::SetLifetimes(int firstIndex, int count, float timeCreated, const float* lifetimes)
+{
+	ASSERT_OR_DIE(firstIndex >= 0 && firstIndex + count <= m_count, Stringf("Error: ParticleBatch::SetLifetimes called on particles %i to %i, batch only has %i", firstIndex, firstIndex + count, m_count));
+
+	for (int index = 0; index < count; ++index)
+	{
+		m_timeCreated[firstIndex + index] = timeCreated;
+		m_timeToDestroy[firstIndex + index] = timeCreated + lifetimes[index];
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Steps every particle forward by deltaSeconds - velocity by the acceleration, then position by the
+// new velocity, and rotation by the angular velocity
+// Runs over whole groups of lanes, padding included, which only ever holds unused values
+//
+void ParticleBatch::Integrate(const Vector3& acceleration, float deltaSeconds)
+{
+	int laneGroupCount = (m_count + LANE_COUNT - 1) / LANE_COUNT;
+	Lanes_t delta = SplatLanes(deltaSeconds);
+
+	IntegrateValuesUniform(m_velocityX.data(), SplatLanes(acceleration.x), delta, laneGroupCount);
+	IntegrateValuesUniform(m_velocityY.data(), SplatLanes(acceleration.y), delta, laneGroupCount);
+	IntegrateValuesUniform(m_velocityZ.data(), SplatLanes(acceleration.z), delta, laneGroupCount);
+
+	IntegrateValues(m_positionX.data(), m_velocityX.data(), delta, laneGroupCount);
+	IntegrateValues(m_positionY.data(), m_velocityY.data(), delta, laneGroupCount);
+	IntegrateValues(m_positionZ.data(), m_velocityZ.data(), delta, laneGroupCount);
+
+	IntegrateValues(m_rotationX.data(), m_angularVelocityX.data(), delta, laneGroupCount);
+	IntegrateValues(m_rotationY.data(), m_angularVelocityY.data(), delta, laneGroupCount);
+	IntegrateValues(m_rotationZ.data(), m_angularVelocityZ.data(), delta, laneGroupCount);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes every particle whose lifetime is over, moving the last live particle into each hole
+// Walks backwards so a particle swapped in has already been checked
+//
+int ParticleBatch::RemoveDeadParticles(float currentTime)
+{
+	int countBefore = m_count;
+
+	for (int index = m_count - 1; index >= 0; --index)
+	{
+		if (currentTime >= m_timeToDestroy[index])
+		{
+			SwapRemove(index);
+		}
+	}
+
+	return (countBefore - m_count);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the model matrix of every particle, in index order
+//
+void ParticleBatch::WriteModelMatrices(const Matrix44& parentMatrix, Matrix44* out_matrices) const
+{
+	for (int index = 0; index < m_count; ++index)
+	{
+		Vector3 position	= Vector3(m_positionX[index], m_positionY[index], m_positionZ[index]);
+		Vector3 rotation	= Vector3(m_rotationX[index], m_rotationY[index], m_rotationZ[index]);
+		Vector3 scale		= Vector3(m_scaleX[index], m_scaleY[index], m_scaleZ[index]);
+
+		out_matrices[index] = parentMatrix * Matrix44::MakeModelMatrix(position, rotation, scale);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finds the box around the particles' positions
+// Scalar, since the padding past the count isn't guaranteed to hold a real position
+//
+bool ParticleBatch::GetPositionBounds(Vector3& out_mins, Vector3& out_maxs) const
+{
+	if (m_count == 0)
+	{
+		return false;
+	}
+
+	Vector3 mins = Vector3(m_positionX[0], m_positionY[0], m_positionZ[0]);
+	Vector3 maxs = mins;
+
+	for (int index = 1; index < m_count; ++index)
+	{
+		mins.x = (m_positionX[index] < mins.x ? m_positionX[index] : mins.x);
+		mins.y = (m_positionY[index] < mins.y ? m_positionY[index] : mins.y);
+		mins.z = (m_positionZ[index] < mins.z ? m_positionZ[index] : mins.z);
+
+		maxs.x = (m_positionX[index] > maxs.x ? m_positionX[index] : maxs.x);
+		maxs.y = (m_positionY[index] > maxs.y ? m_positionY[index] : maxs.y);
+		maxs.z = (m_positionZ[index] > maxs.z ? m_positionZ[index] : maxs.z);
+	}
+
+	out_mins = mins;
+	out_maxs = maxs;
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the position of the particle at the given index
+//
+Vector3 ParticleBatch::GetPosition(int index) const
+{
+	ASSERT_OR_DIE(index >= 0 && index < m_count, Stringf("Error: ParticleBatch::GetPosition called with index %i, batch only has %i particles", index, m_count));
+	return Vector3(m_positionX[index], m_positionY[index], m_positionZ[index]);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the velocity of the particle at the given index
+//
+Vector3 ParticleBatch::GetVelocity(int index) const
+{
+	ASSERT_OR_DIE(index >= 0 && index < m_count, Stringf("Error: ParticleBatch::GetVelocity called with index %i, batch only has %i particles", index, m_count));
+	return Vector3(m_velocityX[index], m_velocityY[index], m_velocityZ[index]);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns how far through its life the particle at the given index is, 0 at spawn and 1 at death
+//
+float ParticleBatch::GetNormalizedTime(int index, float currentTime) const
+{
+	ASSERT_OR_DIE(index >= 0 && index < m_count, Stringf("Error: ParticleBatch::GetNormalizedTime called with index %i, batch only has %i particles", index, m_count));
+	return (currentTime - m_timeCreated[index]) / (m_timeToDestroy[index] - m_timeCreated[index]);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Replaces the particle at index with the last one, and shrinks the count
+//
+void ParticleBatch::SwapRemove(int index)
+{
+	int lastIndex = m_count - 1;
+
+	if (index != lastIndex)
+	{
+		m_positionX[index] = m_positionX[lastIndex];
+		m_positionY[index] = m_positionY[lastIndex];
+		m_positionZ[index] = m_positionZ[lastIndex];
+
+		m_velocityX[index] = m_velocityX[lastIndex];
+		m_velocityY[index] = m_velocityY[lastIndex];
+		m_velocityZ[index] = m_velocityZ[lastIndex];
+
+		m_rotationX[index] = m_rotationX[lastIndex];
+		m_rotationY[index] = m_rotationY[lastIndex];
+		m_rotationZ[index] = m_rotationZ[lastIndex];
+
+		m_angularVelocityX[index] = m_angularVelocityX[lastIndex];
+		m_angularVelocityY[index] = m_angularVelocityY[lastIndex];
+		m_angularVelocityZ[index] = m_angularVelocityZ[lastIndex];
+
+		m_scaleX[index] = m_scaleX[lastIndex];
+		m_scaleY[index] = m_scaleY[lastIndex];
+		m_scaleZ[index] = m_scaleZ[lastIndex];
+
+		m_timeCreated[index] = m_timeCreated[lastIndex];
+		m_timeToDestroy[index] = m_timeToDestroy[lastIndex];
+	}
+
+	m_count--;
+}
@@ -0,0 +1,92 @@
+/************************************************************************/
+/* File: ParticleBatch.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Structure-of-arrays storage for an emitter's particles,
+/*				integrated with SIMD and compacted by swapping the dead
+/*				ones with the last live particle
+/************************************************************************/
+#pragma once
+#include <vector>
+#include "Engine/Math/Vector3.hpp"
+
+class Matrix44;
+
+// Arrays are padded to a multiple of this, so the kernels never need a scalar tail
+#define PARTICLE_BATCH_PADDING (8)
+
+
+class ParticleBatch
+{
+public:
+	//-----Public Methods-----
+
+	ParticleBatch() {}
+	~ParticleBatch() {}
+
+	// Appends particles at rest at the origin with unit scale and no lifetime, returning the first one's index
+	// Then set them up a field at a time with the setters below
+	int		AddParticles(int count);
+	void	Reserve(int count);
+	void	Clear();
+	int		GetCount() const;
+
+	void	SetPositions(int firstIndex, int count, const Vector3& position);
+	void	SetVelocities(int firstIndex, int count, const Vector3* velocities);
+	void	SetAngularVelocities(int firstIndex, int count, const Vector3* angularVelocities);
+	void	SetScales(int firstIndex, int count, const Vector3* scales);
+	void	SetLifetimes(int firstIndex, int count, float timeCreated, const float* lifetimes);
+
+	// Forward euler on every particle - unit mass, so acceleration is the force applied
+	void	Integrate(const Vector3& acceleration, float deltaSeconds);
+
+	// Swaps each particle dead at currentTime with the last live one, returning how many were removed
+	int		RemoveDeadParticles(float currentTime);
+
+	// out_matrices needs GetCount() matrices, each parentMatrix * translation * rotation * scale
+	void	WriteModelMatrices(const Matrix44& parentMatrix, Matrix44* out_matrices) const;
+
+	// Box around every particle's position, returning false with nothing written if there are none
+	bool	GetPositionBounds(Vector3& out_mins, Vector3& out_maxs) const;
+
+	Vector3	GetPosition(int index) const;
+	Vector3	GetVelocity(int index) const;
+	float	GetNormalizedTime(int index, float currentTime) const;
+
+
+private:
+	//-----Private Methods-----
+
+	void	SwapRemove(int index);
+
+
+private:
+	//-----Private Data-----
+
+	// Position and rotation (euler degrees) are local to the emitter when its particles are parented
+	std::vector<float> m_positionX;
+	std::vector<float> m_positionY;
+	std::vector<float> m_positionZ;
+
+	std::vector<float> m_velocityX;
+	std::vector<float> m_velocityY;
+	std::vector<float> m_velocityZ;
+
+	std::vector<float> m_rotationX;
+	std::vector<float> m_rotationY;
+	std::vector<float> m_rotationZ;
+
+	std::vector<float> m_angularVelocityX;
+	std::vector<float> m_angularVelocityY;
+	std::vector<float> m_angularVelocityZ;
+
+	std::vector<float> m_scaleX;
+	std::vector<float> m_scaleY;
+	std::vector<float> m_scaleZ;
+
+	std::vector<float> m_timeCreated;
+	std::vector<float> m_timeToDestroy;
+
+	int m_count = 0;
+
+};
@@ -4,6 +4,7 @@
 /* Date: May 6th, 2018
 /* Description: Implementation of the ParticleEmitter class
 /************************************************************************/
+#include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/Time/Stopwatch.hpp"
 #include "Engine/Rendering/Core/Renderable.hpp"
 #include "Engine/Rendering/Particles/ParticleEmitter.hpp"
@@ -14,8 +15,9 @@
 // Constructor - takes a clock for timing, all particles of this emitter will use this clock
 //
 ParticleEmitter::ParticleEmitter(Clock* referenceClock)
+	: m_stopwatch(referenceClock)
 {
-	m_stopwatch = new Stopwatch(referenceClock);
+	UpdateBounds();
 }
 
 
@@ -24,8 +26,6 @@ ParticleEmitter::ParticleEmitter(Clock* referenceClock)
 //
 ParticleEmitter::~ParticleEmitter()
 {
-	delete m_stopwatch;
-	m_stopwatch = nullptr;
 }
 
 
@@ -54,66 +54,124 @@ void ParticleEmitter::SetRenderable(Renderable* renderable)
 }
 
 
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Fills out_values for a burst, with the batched callback if there is one, otherwise with the per
+// particle callback once for each value
+//
+template <typename VALUE_TYPE, typename BATCH_CB_TYPE, typename CB_TYPE>
+static void GenerateSpawnValues(RandomGenerator& random, BATCH_CB_TYPE batchCallback, CB_TYPE callback, std::vector<VALUE_TYPE>& out_values)
+{
+	int count = (int) out_values.size();
+
+	if (batchCallback != nullptr)
+	{
+		batchCallback(random, out_values.data(), count);
+	}
+	else
+	{
+		for (int index = 0; index < count; ++index)
+		{
+			out_values[index] = callback(random);
+		}
+	}
+}
+
+
 //-----------------------------------------------------------------------------------------------
-// Sets the renderable for this particle emitter
-// Also clears the passed renderable's instance list, to ensure we don't render anything other than
-// particle instances
+// Simulates the frame of the emitter's clock, then hands the particles' matrices to the renderable
+// as its instances
 //
 void ParticleEmitter::Update()
 {
-	if (m_spawnsOverTime)
+	Simulate(m_stopwatch.GetDeltaSeconds());
+	UpdateRenderableInstances();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Simulates the given time, which can span many frames when the emitter was culled or is only
+// updated every few frames
+// Time past the max fast forward is skipped over in one step without spawning, so an emitter
+// culled for minutes catches up in a bounded number of steps
+//
+void ParticleEmitter::Simulate(float deltaSeconds, float spawnRateScale /*= 1.f*/)
+{
+	if (deltaSeconds <= 0.f)
 	{
-		unsigned int numParticles = m_stopwatch->DecrementByIntervalAll();
-		SpawnBurst(numParticles);
+		return;
 	}
 
-	// Iterate across the particles
-	int numParticles = (int) m_particles.size();
-	for (int particleIndex = numParticles - 1; particleIndex >= 0; --particleIndex)
+	float skippedSeconds = deltaSeconds - m_maxFastForwardSeconds;
+	if (skippedSeconds > 0.f)
 	{
-		Particle& p = m_particles[particleIndex];
-		p.m_force = m_force;
-		p.Update(m_stopwatch->GetDeltaSeconds());
-		m_renderable->SetInstanceMatrix(particleIndex, p.m_transform.GetWorldMatrix());
+		SimulateStep(skippedSeconds, 0.f);
+		deltaSeconds = m_maxFastForwardSeconds;
+	}
 
-		if (p.IsDead(m_stopwatch->GetTotalSeconds()))
-		{
-			m_particles.erase(m_particles.begin() + particleIndex);
-			m_renderable->RemoveInstanceMatrix(particleIndex);
-		}
+	while (deltaSeconds > PARTICLE_FAST_FORWARD_STEP_SECONDS)
+	{
+		SimulateStep(PARTICLE_FAST_FORWARD_STEP_SECONDS, spawnRateScale);
+		deltaSeconds -= PARTICLE_FAST_FORWARD_STEP_SECONDS;
 	}
+
+	SimulateStep(deltaSeconds, spawnRateScale);
+	UpdateBounds();
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Spawns a single particle, given the emitter's current spawn state
+// Spawns what's due over the step, then steps every particle forward and removes the dead ones
 //
-void ParticleEmitter::SpawnParticle()
+void ParticleEmitter::SimulateStep(float deltaSeconds, float spawnRateScale)
 {
-	Particle particle;
-	particle.m_velocity = m_spawnVelocityCallback();
-	particle.m_angularVelocity = m_spawnAngularVelocityCallback();
-	particle.m_mass = 1.0f;
+	m_simulationTime += deltaSeconds;
+
+	if (m_spawnsOverTime)
+	{
+		m_spawnAccumulator += m_spawnRate * spawnRateScale * deltaSeconds;
 
-	particle.m_force = m_force;
-	particle.m_torque = Vector3::ZERO;
+		unsigned int spawnCount = (unsigned int) m_spawnAccumulator;
+		m_spawnAccumulator -= (float) spawnCount;
 
-	particle.m_timeCreated = m_stopwatch->GetTotalSeconds();
-	particle.m_timeToDestroy = particle.m_timeCreated + m_spawnLifetimeCallback();
+		SpawnBurst(spawnCount);
+	}
 
-	particle.m_transform.Scale(m_spawnScaleCallback());
+	m_particles.Integrate(m_force, deltaSeconds);
+	m_particles.RemoveDeadParticles(m_simulationTime);
+}
 
-	if (m_areParticlesParented)
+
+//-----------------------------------------------------------------------------------------------
+// Recalculates the world space box around the particles, or around the emitter if there aren't any
+//
+void ParticleEmitter::UpdateBounds()
+{
+	Vector3 mins, maxs;
+	bool hasParticles = m_particles.GetPositionBounds(mins, maxs);
+
+	if (!hasParticles)
 	{
-		particle.m_transform.SetParentTransform(&transform);
+		m_bounds = AABB3(transform.position, transform.position).GetExpanded(m_boundsPadding);
+		return;
 	}
-	else
+
+	m_bounds = AABB3(mins, maxs);
+
+	if (m_areParticlesParented)
 	{
-		particle.m_transform.position = transform.position;
+		m_bounds = m_bounds.GetTransformed(transform.GetWorldMatrix());
 	}
 
-	m_renderable->AddInstanceMatrix(particle.m_transform.GetWorldMatrix());
-	m_particles.push_back(particle);
+	m_bounds = m_bounds.GetExpanded(m_boundsPadding);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Spawns a single particle, given the emitter's current spawn state
+//
+void ParticleEmitter::SpawnParticle()
+{
+	SpawnBurst(1);
 }
 
 
@@ -122,19 +180,45 @@ void ParticleEmitter::SpawnParticle()
 //
 void ParticleEmitter::SpawnBurst()
 {
-	int spawnCount = m_burstRange.GetRandomInRange();
+	int spawnCount = m_random.GetIntInRange(m_burstRange.min, m_burstRange.max);
 	SpawnBurst(spawnCount);
 }
 
 
 //-----------------------------------------------------------------------------------------------
 // Spawns a set of particles, equal to the value passed
+// Each field of the burst is generated together, so batched callbacks get called once per field
+// The renderable picks the new particles up on the next Update()
 //
 void ParticleEmitter::SpawnBurst(unsigned int numToSpawn)
 {
-	for (int particleIndex = 0; particleIndex < (int) numToSpawn; ++particleIndex)
+	if (numToSpawn == 0)
+	{
+		return;
+	}
+
+	int spawnCount = (int) numToSpawn;
+	int firstIndex = m_particles.AddParticles(spawnCount);
+
+	m_spawnVectors.resize(spawnCount);
+	m_spawnLifetimes.resize(spawnCount);
+
+	GenerateSpawnValues(m_random, m_spawnVelocityBatchCallback, m_spawnVelocityCallback, m_spawnVectors);
+	m_particles.SetVelocities(firstIndex, spawnCount, m_spawnVectors.data());
+
+	GenerateSpawnValues(m_random, m_spawnAngularVelocityBatchCallback, m_spawnAngularVelocityCallback, m_spawnVectors);
+	m_particles.SetAngularVelocities(firstIndex, spawnCount, m_spawnVectors.data());
+
+	GenerateSpawnValues(m_random, m_spawnLifetimeBatchCallback, m_spawnLifetimeCallback, m_spawnLifetimes);
+	m_particles.SetLifetimes(firstIndex, spawnCount, m_simulationTime, m_spawnLifetimes.data());
+
+	GenerateSpawnValues(m_random, m_spawnScaleBatchCallback, m_spawnScaleCallback, m_spawnVectors);
+	m_particles.SetScales(firstIndex, spawnCount, m_spawnVectors.data());
+
+	// Parented particles start at the emitter's origin in its space
+	if (!m_areParticlesParented)
 	{
-		SpawnParticle();
+		m_particles.SetPositions(firstIndex, spawnCount, transform.position);
 	}
 }
 
@@ -144,15 +228,9 @@ void ParticleEmitter::SpawnBurst(unsigned int numToSpawn)
 //
 void ParticleEmitter::SetSpawnRate(unsigned int particlesPerSecond)
 {
-	if (particlesPerSecond == 0)
-	{
-		m_spawnsOverTime = false;
-	}
-	else
-	{
-		m_spawnsOverTime = true;
-		m_stopwatch->SetInterval(1.0f / (float) particlesPerSecond);
-	}
+	m_spawnsOverTime = (particlesPerSecond > 0);
+	m_spawnRate = (float) particlesPerSecond;
+	m_spawnAccumulator = 0.f;
 }
 
 
@@ -170,6 +248,52 @@ void ParticleEmitter::SetBurst(int minAmount, int maxAmount /*= -1*/)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Reseeds the emitter's generator, so the bursts and spawn callbacks replay the same values
+//
+void ParticleEmitter::SetRandomSeed(uint64_t seed)
+{
+	m_random.Seed(seed);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets how far past the particles' positions the bounds reach
+//
+void ParticleEmitter::SetBoundsPadding(float padding)
+{
+	m_boundsPadding = padding;
+	UpdateBounds();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets what the emitter does while culled
+//
+void ParticleEmitter::SetCullMode(eParticleCullMode cullMode)
+{
+	m_cullMode = cullMode;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the most time caught up on in steps, anything before is skipped with a single step
+//
+void ParticleEmitter::SetMaxFastForwardSeconds(float seconds)
+{
+	m_maxFastForwardSeconds = seconds;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the priority of the emitter against the particle budget
+//
+void ParticleEmitter::SetPriority(int priority)
+{
+	m_priority = priority;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Sets the flag to indicate whether this emitter should be deleted if done emitting particles
 //
@@ -224,6 +348,42 @@ void ParticleEmitter::SetSpawnScaleFunction(SpawnScale_cb callback)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Sets the batched spawn velocity callback function to the one specified
+//
+void ParticleEmitter::SetSpawnVelocityBatchFunction(SpawnVelocityBatch_cb callback)
+{
+	m_spawnVelocityBatchCallback = callback;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the batched spawn angular velocity callback function to the one specified
+//
+void ParticleEmitter::SetSpawnAngularVelocityBatchFunction(SpawnAngularVelocityBatch_cb callback)
+{
+	m_spawnAngularVelocityBatchCallback = callback;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the batched spawn lifetime callback function to the one specified
+//
+void ParticleEmitter::SetSpawnLifetimeBatchFunction(SpawnLifetimeBatch_cb callback)
+{
+	m_spawnLifetimeBatchCallback = callback;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the batched spawn scale callback function to the one specified
+//
+void ParticleEmitter::SetSpawnScaleBatchFunction(SpawnScaleBatch_cb callback)
+{
+	m_spawnScaleBatchCallback = callback;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns true if this emitter is finished spawning, has no particles, and should be deleted when done
 //
@@ -238,7 +398,7 @@ bool ParticleEmitter::IsFinished() const
 //
 int ParticleEmitter::GetParticleCount() const
 {
-	return (int) m_particles.size();
+	return m_particles.GetCount();
 }
 
 
@@ -251,13 +411,80 @@ Renderable* ParticleEmitter::GetRenderable() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the world space box around the particles
+//
+const AABB3& ParticleEmitter::GetBounds() const
+{
+	return m_bounds;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns what the emitter does while culled
+//
+eParticleCullMode ParticleEmitter::GetCullMode() const
+{
+	return m_cullMode;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the most time the emitter catches up on in steps
+//
+float ParticleEmitter::GetMaxFastForwardSeconds() const
+{
+	return m_maxFastForwardSeconds;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the priority of the emitter against the particle budget
+//
+int ParticleEmitter::GetPriority() const
+{
+	return m_priority;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the frame time of the emitter's clock
+//
+float ParticleEmitter::GetClockDeltaSeconds() const
+{
+	return m_stopwatch.GetDeltaSeconds();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Replaces the renderable's instances with the particles' matrices, so the renderer draws every
+// particle of the emitter in one instanced draw
+//
+void ParticleEmitter::UpdateRenderableInstances()
+{
+	if (m_renderable == nullptr)
+	{
+		return;
+	}
+
+	int particleCount = m_particles.GetCount();
+	m_instanceMatrices.resize(particleCount);
+
+	Matrix44 parentMatrix = (m_areParticlesParented ? transform.GetWorldMatrix() : Matrix44::IDENTITY);
+	m_particles.WriteModelMatrices(parentMatrix, m_instanceMatrices.data());
+
+	m_renderable->SetInstanceMatrices(m_instanceMatrices.data(), (unsigned int) particleCount);
+}
+
+
 //---------- Default Spawn Callbacks ----------
 
 //-----------------------------------------------------------------------------------------------
 // Just returns (0,0,0)
 //
-Vector3 DefaultSpawnVelocity()
+Vector3 DefaultSpawnVelocity(RandomGenerator& random)
 {
+	UNUSED(random);
 	return Vector3::ZERO;
 }
 
@@ -265,8 +492,9 @@ Vector3 DefaultSpawnVelocity()
 //-----------------------------------------------------------------------------------------------
 // Just returns (0,0,0)
 //
-Vector3 DefaultSpawnAngularVelocity()
+Vector3 DefaultSpawnAngularVelocity(RandomGenerator& random)
 {
+	UNUSED(random);
 	return Vector3::ZERO;
 }
 
@@ -274,8 +502,9 @@ Vector3 DefaultSpawnAngularVelocity()
 //-----------------------------------------------------------------------------------------------
 // Returns 1.0f, indicating each particle lives for 1 second
 //
-float DefaultSpawnLifetime()
+float DefaultSpawnLifetime(RandomGenerator& random)
 {
+	UNUSED(random);
 	return 1.0f;
 }
 
@@ -283,7 +512,8 @@ float DefaultSpawnLifetime()
 //-----------------------------------------------------------------------------------------------
 // Returns a default scale of (1,1,1)
 //
-Vector3 DefaultSpawnScale()
+Vector3 DefaultSpawnScale(RandomGenerator& random)
 {
+	UNUSED(random);
 	return Vector3::ONES;
 }
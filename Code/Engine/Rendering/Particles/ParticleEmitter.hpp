@@ -6,24 +6,47 @@
 /************************************************************************/
 #pragma once
 #include <vector>
+#include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/IntRange.hpp"
-#include "Engine/Rendering/Particles/Particle.hpp"
+#include "Engine/Math/Matrix44.hpp"
+#include "Engine/Math/Transform.hpp"
+#include "Engine/Math/RandomGenerator.hpp"
+#include "Engine/Core/Time/Stopwatch.hpp"
+#include "Engine/Rendering/Particles/ParticleBatch.hpp"
 
 class Clock;
-class Stopwatch;
 class Renderable;
 
-// Typedefs for spawning callbacks
-typedef Vector3 (*SpawnVelocity_cb)();
-typedef Vector3 (*SpawnAngularVelocity_cb)();
-typedef Vector3 (*SpawnScale_cb)();
-typedef float (*SpawnLifetime_cb)();
+// Typedefs for spawning callbacks, given the emitter's generator so a seeded emitter replays the same particles
+typedef Vector3 (*SpawnVelocity_cb)(RandomGenerator& random);
+typedef Vector3 (*SpawnAngularVelocity_cb)(RandomGenerator& random);
+typedef Vector3 (*SpawnScale_cb)(RandomGenerator& random);
+typedef float (*SpawnLifetime_cb)(RandomGenerator& random);
+
+// Batched versions, called once per burst to fill a value for each particle spawned
+// When set they're used instead of the per particle callbacks above
+typedef void (*SpawnVelocityBatch_cb)(RandomGenerator& random, Vector3* out_velocities, int count);
+typedef void (*SpawnAngularVelocityBatch_cb)(RandomGenerator& random, Vector3* out_angularVelocities, int count);
+typedef void (*SpawnScaleBatch_cb)(RandomGenerator& random, Vector3* out_scales, int count);
+typedef void (*SpawnLifetimeBatch_cb)(RandomGenerator& random, float* out_lifetimes, int count);
+
+// Time simulated at once when catching up, and the most that's caught up on - older time is skipped,
+// with the particles stepped over it once and nothing spawned
+#define PARTICLE_FAST_FORWARD_STEP_SECONDS (0.1f)
+#define PARTICLE_DEFAULT_MAX_FAST_FORWARD_SECONDS (5.f)
+
+// What the emitter does while the ParticleSystem has it culled
+enum eParticleCullMode
+{
+	PARTICLE_CULL_FAST_FORWARD,		// Catches up on the time when it's next seen, for effects that should look like they kept going
+	PARTICLE_CULL_FREEZE			// Picks up where it left off, for looping ambient effects nobody will notice paused
+};
 
 // Default callbacks, in case one isn't set explicitly
-Vector3 DefaultSpawnVelocity();
-Vector3 DefaultSpawnAngularVelocity();
-float	DefaultSpawnLifetime();
-Vector3 DefaultSpawnScale();
+Vector3 DefaultSpawnVelocity(RandomGenerator& random);
+Vector3 DefaultSpawnAngularVelocity(RandomGenerator& random);
+float	DefaultSpawnLifetime(RandomGenerator& random);
+Vector3 DefaultSpawnScale(RandomGenerator& random);
 
 
 class ParticleEmitter
@@ -37,7 +60,13 @@ public:
 	void SetTransform(const Vector3& position, const Vector3& rotation, const Vector3& scale);
 	void SetRenderable(Renderable* renderable);
 
+	// Simulates the clock's frame and updates the renderable - for emitters not in the ParticleSystem
 	void Update();
+
+	// Steps the particles and spawns what's due, at spawnRateScale of the spawn rate; spans longer
+	// than a step are stepped, and past the max fast forward only the end of them is
+	void Simulate(float deltaSeconds, float spawnRateScale = 1.f);
+	void UpdateRenderableInstances();
 	
 	// Spawning
 	void SpawnParticle();
@@ -49,6 +78,13 @@ public:
 
 	void SetKillWhenDone(bool killWhenDone);
 	void SetParticlesParented(bool shouldParent);
+	void SetRandomSeed(uint64_t seed);
+
+	// Culling and budget, used by the ParticleSystem
+	void SetBoundsPadding(float padding);				// Added around the particles' positions, to cover their size
+	void SetCullMode(eParticleCullMode cullMode);
+	void SetMaxFastForwardSeconds(float seconds);		// Around the longest particle lifetime is enough
+	void SetPriority(int priority);						// Lower priorities are throttled first when over the particle budget
 
 	// Setting callbacks used when particles are spawned
 	void SetSpawnVelocityFunction(SpawnVelocity_cb callback);
@@ -56,11 +92,23 @@ public:
 	void SetSpawnLifetimeFunction(SpawnLifetime_cb callback);
 	void SetSpawnScaleFunction(SpawnScale_cb callback);
 
+	// Null to go back to the per particle callbacks
+	void SetSpawnVelocityBatchFunction(SpawnVelocityBatch_cb callback);
+	void SetSpawnAngularVelocityBatchFunction(SpawnAngularVelocityBatch_cb callback);
+	void SetSpawnLifetimeBatchFunction(SpawnLifetimeBatch_cb callback);
+	void SetSpawnScaleBatchFunction(SpawnScaleBatch_cb callback);
+
 	// Accessors
 	bool IsFinished() const;
 	int GetParticleCount() const;
 	Renderable* GetRenderable() const;
 
+	const AABB3&		GetBounds() const;				// World space, as of the last simulation
+	eParticleCullMode	GetCullMode() const;
+	float				GetMaxFastForwardSeconds() const;
+	int					GetPriority() const;
+	float				GetClockDeltaSeconds() const;	// Of the emitter's clock this frame
+
 
 public:
 	//-----Public Data-----
@@ -68,19 +116,42 @@ public:
 	Transform transform;
 
 
+private:
+	//-----Private Methods-----
+
+	void SimulateStep(float deltaSeconds, float spawnRateScale);
+	void UpdateBounds();
+
+
 private:
 	//-----Private Data-----
 
-	Renderable* m_renderable;
+	Renderable* m_renderable = nullptr;
+
+	ParticleBatch m_particles;
 
-	std::vector<Particle> m_particles;
+	// Scratch for spawning and drawing, kept to avoid allocating each frame
+	std::vector<Vector3> m_spawnVectors;
+	std::vector<float> m_spawnLifetimes;
+	std::vector<Matrix44> m_instanceMatrices;
 
 	bool m_spawnsOverTime = false;
-	Stopwatch* m_stopwatch;
+	float m_spawnRate = 0.f;				// Particles per second
+	float m_spawnAccumulator = 0.f;			// Fraction of a particle due to spawn
+	float m_simulationTime = 0.f;			// Only advanced as the emitter is simulated, so particle lifetimes pause with it
+	Stopwatch m_stopwatch;
+
+	AABB3 m_bounds;
+	float m_boundsPadding = 1.f;
+	eParticleCullMode m_cullMode = PARTICLE_CULL_FAST_FORWARD;
+	float m_maxFastForwardSeconds = PARTICLE_DEFAULT_MAX_FAST_FORWARD_SECONDS;
+	int m_priority = 0;
 
 	bool m_killWhenDone = false;
 	IntRange m_burstRange;
 
+	RandomGenerator m_random;	// Per emitter, so emitters on other threads don't share a sequence
+
 	Vector3 m_force = Vector3(0.f, -9.8f, 0.f);
 
 	bool m_areParticlesParented = false;
@@ -90,4 +161,9 @@ private:
 	SpawnAngularVelocity_cb m_spawnAngularVelocityCallback = DefaultSpawnAngularVelocity;
 	SpawnLifetime_cb m_spawnLifetimeCallback = DefaultSpawnLifetime;
 	SpawnScale_cb m_spawnScaleCallback = DefaultSpawnScale;
+
+	SpawnVelocityBatch_cb m_spawnVelocityBatchCallback = nullptr;
+	SpawnAngularVelocityBatch_cb m_spawnAngularVelocityBatchCallback = nullptr;
+	SpawnLifetimeBatch_cb m_spawnLifetimeBatchCallback = nullptr;
+	SpawnScaleBatch_cb m_spawnScaleBatchCallback = nullptr;
 };
@@ -0,0 +1,361 @@
+/************************************************************************/
+/* File: ParticleSystem.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the ParticleSystem singleton class
+/************************************************************************/
+#include <algorithm>
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/JobSystem/ParallelFor.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
+#include "Engine/Rendering/Particles/ParticleEmitter.hpp"
+#include "Engine/Rendering/Particles/ParticleSystem.hpp"
+
+// Singleton instance
+ParticleSystem* ParticleSystem::s_instance = nullptr;
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the squared distance from the point to the nearest point of the box, 0 if it's inside
+//
+static float GetDistanceSquaredToBounds(const Vector3& point, const AABB3& bounds)
+{
+	Vector3 nearestPoint;
+	nearestPoint.x = (point.x < bounds.mins.x ? bounds.mins.x : (point.x > bounds.maxs.x ? bounds.maxs.x : point.x));
+	nearestPoint.y = (point.y < bounds.mins.y ? bounds.mins.y : (point.y > bounds.maxs.y ? bounds.maxs.y : point.y));
+	nearestPoint.z = (point.z < bounds.mins.z ? bounds.mins.z : (point.z > bounds.maxs.z ? bounds.maxs.z : point.z));
+
+	return (nearestPoint - point).GetLengthSquared();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Creates the singleton instance
+//
+void ParticleSystem::Initialize()
+{
+	ASSERT_OR_DIE(s_instance == nullptr, "ParticleSystem::Initialize() called twice!");
+	s_instance = new ParticleSystem();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes the singleton instance
+//
+void ParticleSystem::Shutdown()
+{
+	if (s_instance != nullptr)
+	{
+		delete s_instance;
+		s_instance = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the singleton instance
+//
+ParticleSystem* ParticleSystem::GetInstance()
+{
+	return s_instance;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Registers the emitter to be updated each frame
+//
+void ParticleSystem::AddEmitter(ParticleEmitter* emitter)
+{
+	ASSERT_OR_DIE(std::find(m_emitters.begin(), m_emitters.end(), emitter) == m_emitters.end(), "Error: ParticleSystem::AddEmitter called on an emitter already added");
+	m_emitters.push_back(emitter);
+
+	ParticleEmitterState_t state;
+	state.updateOffset = m_nextUpdateOffset++;
+
+	m_states.push_back(state);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stops updating the emitter, order of the rest doesn't matter so it's swapped out
+//
+void ParticleSystem::RemoveEmitter(ParticleEmitter* emitter)
+{
+	std::vector<ParticleEmitter*>::iterator itr = std::find(m_emitters.begin(), m_emitters.end(), emitter);
+
+	if (itr != m_emitters.end())
+	{
+		int emitterIndex = (int) (itr - m_emitters.begin());
+
+		*itr = m_emitters.back();
+		m_emitters.pop_back();
+
+		m_states[emitterIndex] = m_states.back();
+		m_states.pop_back();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of emitters being updated
+//
+int ParticleSystem::GetEmitterCount() const
+{
+	return (int) m_emitters.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Updates every emitter - each only touches its own particles and renderable, so they run as
+// independent jobs
+// Culled emitters either keep their time to catch up on when seen again, or drop it and freeze;
+// far ones spawn less and step every few frames with the time they skipped
+//
+void ParticleSystem::Update()
+{
+	PROFILE_SCOPE_CATEGORY("ParticleSystem::Update", "Particles");
+
+	int emitterCount = (int) m_emitters.size();
+	m_frameNumber++;
+
+	// Pick the visibility, LODs and who updates this frame, cheap enough to not be worth a job
+	m_particleCount = 0;
+	m_culledCount = 0;
+	m_emittersUpdated = 0;
+	for (int lod = 0; lod < PARTICLE_LOD_COUNT; ++lod)
+	{
+		m_lodCounts[lod] = 0;
+	}
+
+	for (int emitterIndex = 0; emitterIndex < emitterCount; ++emitterIndex)
+	{
+		ParticleEmitter* emitter = m_emitters[emitterIndex];
+		ParticleEmitterState_t& state = m_states[emitterIndex];
+
+		m_particleCount += emitter->GetParticleCount();
+		state.pendingSeconds += emitter->GetClockDeltaSeconds();
+
+		state.isVisible = true;
+		state.lod = 0;
+		state.distanceSquared = 0.f;
+
+		if (m_hasView)
+		{
+			const AABB3& bounds = emitter->GetBounds();
+
+			state.isVisible = m_viewFrustum.DoesAABB3Overlap(bounds);
+			state.distanceSquared = GetDistanceSquaredToBounds(m_viewPosition, bounds);
+			state.lod = CalculateLOD(state.distanceSquared);
+		}
+
+		if (!state.isVisible)
+		{
+			m_culledCount++;
+
+			if (emitter->GetCullMode() == PARTICLE_CULL_FREEZE)
+			{
+				state.pendingSeconds = 0.f;
+				state.isUpdatingThisFrame = false;
+			}
+			else
+			{
+				// Caught up early once there's more than it would catch up on, so an effect left
+				// off-screen still runs out and finishes
+				state.isUpdatingThisFrame = (state.pendingSeconds >= emitter->GetMaxFastForwardSeconds());
+			}
+		}
+		else
+		{
+			int updateInterval = m_lodSettings.updateIntervals[state.lod];
+			int framesIntoInterval = (updateInterval > 1 ? (int) ((m_frameNumber + (unsigned int) state.updateOffset) % (unsigned int) updateInterval) : 0);
+
+			state.isUpdatingThisFrame = (framesIntoInterval == 0);
+			m_lodCounts[state.lod]++;
+		}
+
+		m_emittersUpdated += (state.isUpdatingThisFrame ? 1 : 0);
+	}
+
+	ApplyParticleBudget();
+
+	ParallelFor(0, emitterCount, PARTICLE_EMITTERS_PER_JOB, [&](int emitterIndex)
+	{
+		ParticleEmitterState_t& state = m_states[emitterIndex];
+
+		if (!state.isUpdatingThisFrame)
+		{
+			return;
+		}
+
+		ParticleEmitter* emitter = m_emitters[emitterIndex];
+		float spawnRateScale = (state.isThrottled ? 0.f : m_lodSettings.spawnRateScales[state.lod]);
+
+		emitter->Simulate(state.pendingSeconds, spawnRateScale);
+		state.pendingSeconds = 0.f;
+
+		// Culled ones keep their old instances, since nothing will draw them
+		if (state.isVisible)
+		{
+			emitter->UpdateRenderableInstances();
+		}
+	});
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the view to cull against and measure LOD distances from
+//
+void ParticleSystem::SetView(const Frustum& frustum, const Vector3& position)
+{
+	m_viewFrustum = frustum;
+	m_viewPosition = position;
+	m_hasView = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Turns culling and LOD off
+//
+void ParticleSystem::ClearView()
+{
+	m_hasView = false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the distances and reductions of each LOD
+//
+void ParticleSystem::SetLODSettings(const ParticleLODSettings_t& settings)
+{
+	m_lodSettings = settings;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the number of live particles past which emitters are throttled
+//
+void ParticleSystem::SetParticleBudget(int maxParticles)
+{
+	m_particleBudget = maxParticles;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of live particles across every emitter
+//
+int ParticleSystem::GetParticleCount() const
+{
+	return m_particleCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of emitters outside the view
+//
+int ParticleSystem::GetCulledEmitterCount() const
+{
+	return m_culledCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of emitters that weren't allowed to spawn, for the budget
+//
+int ParticleSystem::GetThrottledEmitterCount() const
+{
+	return m_throttledCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of visible emitters at the given LOD
+//
+int ParticleSystem::GetEmitterCountAtLOD(int lod) const
+{
+	ASSERT_OR_DIE(lod >= 0 && lod < PARTICLE_LOD_COUNT, Stringf("Error: ParticleSystem::GetEmitterCountAtLOD() called with LOD %i", lod));
+	return m_lodCounts[lod];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of emitters simulated in the last Update()
+//
+int ParticleSystem::GetEmittersUpdatedLastFrame() const
+{
+	return m_emittersUpdated;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the LOD for an emitter at the given squared distance from the view
+//
+int ParticleSystem::CalculateLOD(float distanceSquared) const
+{
+	int lod = 0;
+	while (lod < PARTICLE_LOD_COUNT - 1)
+	{
+		float lodDistance = m_lodSettings.lodDistances[lod];
+
+		if (distanceSquared <= lodDistance * lodDistance)
+		{
+			break;
+		}
+
+		lod++;
+	}
+
+	return lod;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Throttles emitters while over the budget, lowest priority first and the farthest first within
+// a priority, until the particles of those throttled cover the excess - they stop spawning, so
+// the count falls as their particles die
+//
+void ParticleSystem::ApplyParticleBudget()
+{
+	int emitterCount = (int) m_emitters.size();
+	m_throttledCount = 0;
+
+	for (int emitterIndex = 0; emitterIndex < emitterCount; ++emitterIndex)
+	{
+		m_states[emitterIndex].isThrottled = false;
+	}
+
+	int excessCount = m_particleCount - m_particleBudget;
+	if (m_particleBudget <= 0 || excessCount <= 0)
+	{
+		return;
+	}
+
+	m_budgetOrder.resize(emitterCount);
+	for (int emitterIndex = 0; emitterIndex < emitterCount; ++emitterIndex)
+	{
+		m_budgetOrder[emitterIndex] = emitterIndex;
+	}
+
+	std::sort(m_budgetOrder.begin(), m_budgetOrder.end(), [this](int a, int b)
+	{
+		int priorityA = m_emitters[a]->GetPriority();
+		int priorityB = m_emitters[b]->GetPriority();
+
+		if (priorityA != priorityB)
+		{
+			return priorityA < priorityB;
+		}
+
+		return m_states[a].distanceSquared > m_states[b].distanceSquared;
+	});
+
+	for (int orderIndex = 0; orderIndex < emitterCount && excessCount > 0; ++orderIndex)
+	{
+		int emitterIndex = m_budgetOrder[orderIndex];
+
+		m_states[emitterIndex].isThrottled = true;
+		m_throttledCount++;
+
+		excessCount -= m_emitters[emitterIndex]->GetParticleCount();
+	}
+}
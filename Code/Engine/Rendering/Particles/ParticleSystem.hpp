@@ -0,0 +1,110 @@
+/************************************************************************/
+/* File: ParticleSystem.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Singleton that updates every registered ParticleEmitter
+/*				once a frame - culling the ones out of view, reducing
+/*				far ones, and throttling spawns over a particle budget
+/************************************************************************/
+#pragma once
+#include <vector>
+#include "Engine/Math/Vector3.hpp"
+#include "Engine/Math/Frustum.hpp"
+
+class ParticleEmitter;
+
+#define PARTICLE_LOD_COUNT (4)
+
+// Emitters are cheap to step, so several per job keeps the overhead small
+#define PARTICLE_EMITTERS_PER_JOB (8)
+
+// Distances are in world units, from the view to the nearest point of the emitter's bounds
+struct ParticleLODSettings_t
+{
+	float	lodDistances[PARTICLE_LOD_COUNT - 1]	= { 30.f, 60.f, 120.f };		// Past each, the next LOD is used
+	float	spawnRateScales[PARTICLE_LOD_COUNT]		= { 1.f, 0.5f, 0.25f, 0.1f };
+	int		updateIntervals[PARTICLE_LOD_COUNT]		= { 1, 1, 2, 4 };				// Frames between simulation steps
+};
+
+// The system's bookkeeping for each emitter, kept beside the list
+struct ParticleEmitterState_t
+{
+	int		updateOffset = 0;				// Staggers reduced rate updates across frames
+	int		lod = 0;
+	float	distanceSquared = 0.f;
+	float	pendingSeconds = 0.f;			// Clock time not simulated yet, from skipped frames or being culled
+	bool	isVisible = true;
+	bool	isThrottled = false;
+	bool	isUpdatingThisFrame = false;
+};
+
+
+class ParticleSystem
+{
+public:
+	//-----Public Methods-----
+
+	static void				Initialize();
+	static void				Shutdown();
+	static ParticleSystem*	GetInstance();
+
+	// The system doesn't own the emitters, remove them before deleting them
+	void	AddEmitter(ParticleEmitter* emitter);
+	void	RemoveEmitter(ParticleEmitter* emitter);
+	int		GetEmitterCount() const;
+
+	// Call once a frame, before the emitters' renderables are drawn
+	void	Update();
+
+	// Culling and LOD are off, with everything updating every frame, until a view is set
+	void	SetView(const Frustum& frustum, const Vector3& position);
+	void	ClearView();
+	void	SetLODSettings(const ParticleLODSettings_t& settings);
+
+	// Past this many live particles the lowest priority emitters stop spawning, 0 for no budget
+	void	SetParticleBudget(int maxParticles);
+
+	// As of the last Update()
+	int		GetParticleCount() const;
+	int		GetCulledEmitterCount() const;
+	int		GetThrottledEmitterCount() const;
+	int		GetEmitterCountAtLOD(int lod) const;
+	int		GetEmittersUpdatedLastFrame() const;
+
+
+private:
+	//-----Private Methods-----
+
+	// Singleton, use Initialize() instead
+	ParticleSystem() {}
+	~ParticleSystem() {}
+	ParticleSystem(const ParticleSystem& copy) = delete;
+
+	int		CalculateLOD(float distanceSquared) const;
+	void	ApplyParticleBudget();
+
+
+private:
+	//-----Private Data-----
+
+	std::vector<ParticleEmitter*>			m_emitters;
+	std::vector<ParticleEmitterState_t>		m_states;			// One per emitter, in the same order
+	std::vector<int>						m_budgetOrder;		// Scratch for ApplyParticleBudget(), kept to not allocate each frame
+
+	ParticleLODSettings_t	m_lodSettings;
+	Frustum					m_viewFrustum;
+	Vector3					m_viewPosition;
+	bool					m_hasView = false;
+	int						m_particleBudget = 0;
+
+	unsigned int			m_frameNumber = 0;
+	int						m_nextUpdateOffset = 0;
+	int						m_particleCount = 0;
+	int						m_culledCount = 0;
+	int						m_throttledCount = 0;
+	int						m_lodCounts[PARTICLE_LOD_COUNT] = {};
+	int						m_emittersUpdated = 0;
+
+	static ParticleSystem* s_instance;
+
+};
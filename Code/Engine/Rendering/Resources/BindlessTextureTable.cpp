@@ -0,0 +1,246 @@
+/************************************************************************/
+/* File: BindlessTextureTable.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the BindlessTextureTable class
+/************************************************************************/
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/Core/Renderer.hpp"
+#include "Engine/Rendering/Resources/Texture.hpp"
+#include "Engine/Rendering/Resources/BindlessTextureTable.hpp"
+
+std::vector<BindlessTextureTable*> BindlessTextureTable::s_tables;
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+BindlessTextureTable::BindlessTextureTable()
+{
+	s_tables.push_back(this);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor - the handles stay resident until their textures are deleted
+//
+BindlessTextureTable::~BindlessTextureTable()
+{
+	for (int tableIndex = 0; tableIndex < (int) s_tables.size(); ++tableIndex)
+	{
+		if (s_tables[tableIndex] == this)
+		{
+			s_tables.erase(s_tables.begin() + tableIndex);
+			break;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the texture and sampler pair to the table, returning its index
+//
+int BindlessTextureTable::AddTexture(const Texture* texture, const Sampler* sampler /*= nullptr*/)
+{
+	if (texture == nullptr || !Texture::IsBindlessSupported())
+	{
+		return -1;
+	}
+
+	sampler = GetSamplerOrDefault(sampler);
+
+	int existingIndex = GetTextureIndex(texture, sampler);
+	if (existingIndex >= 0)
+	{
+		return existingIndex;
+	}
+
+	uint64_t handle = texture->GetBindlessHandle(sampler);
+	if (handle == 0)
+	{
+		return -1;
+	}
+
+	TableEntry_t entry;
+	entry.texture = texture;
+	entry.sampler = sampler;
+
+	int entryIndex = (int) m_entries.size();
+	if (m_freeIndices.size() > 0)
+	{
+		entryIndex = m_freeIndices.back();
+		m_freeIndices.pop_back();
+
+		m_entries[entryIndex] = entry;
+		m_handles[entryIndex] = handle;
+	}
+	else
+	{
+		m_entries.push_back(entry);
+		m_handles.push_back(handle);
+	}
+
+	m_indicesByKey[TableKey(texture, sampler)] = entryIndex;
+	m_isDirty = true;
+
+	return entryIndex;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the index of the texture and sampler pair in the table, -1 if it isn't in it
+//
+int BindlessTextureTable::GetTextureIndex(const Texture* texture, const Sampler* sampler /*= nullptr*/) const
+{
+	sampler = GetSamplerOrDefault(sampler);
+
+	std::map<TableKey, int>::const_iterator itr = m_indicesByKey.find(TableKey(texture, sampler));
+	if (itr == m_indicesByKey.end())
+	{
+		return -1;
+	}
+
+	return itr->second;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes every entry of the texture, with any sampler
+//
+void BindlessTextureTable::RemoveTexture(const Texture* texture)
+{
+	for (int entryIndex = 0; entryIndex < (int) m_entries.size(); ++entryIndex)
+	{
+		if (m_entries[entryIndex].texture == texture)
+		{
+			RemoveEntry(entryIndex);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes every entry sampled with the sampler, releasing the textures' handles for it, as they
+// can't outlive the sampler
+//
+void BindlessTextureTable::RemoveSampler(const Sampler* sampler)
+{
+	for (int entryIndex = 0; entryIndex < (int) m_entries.size(); ++entryIndex)
+	{
+		if (m_entries[entryIndex].sampler == sampler)
+		{
+			m_entries[entryIndex].texture->ReleaseBindlessHandle(sampler);
+			RemoveEntry(entryIndex);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Empties the table, indices handed out before are no longer valid
+//
+void BindlessTextureTable::RemoveAll()
+{
+	m_entries.clear();
+	m_handles.clear();
+	m_freeIndices.clear();
+	m_indicesByKey.clear();
+	m_isDirty = true;
+	m_generation++;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of textures in the table
+//
+int BindlessTextureTable::GetCount() const
+{
+	return (int) (m_entries.size() - m_freeIndices.size());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the table's generation, which changes whenever an entry is removed
+//
+uint32_t BindlessTextureTable::GetGeneration() const
+{
+	return m_generation;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Uploads the handles if they've changed, and binds the buffer
+//
+void BindlessTextureTable::Bind()
+{
+	if (m_isDirty)
+	{
+		if (m_handles.size() > 0)
+		{
+			m_handleBuffer.CopyToGPU(m_handles.size() * sizeof(uint64_t), m_handles.data());
+		}
+
+		m_isDirty = false;
+	}
+
+	if (m_handleBuffer.GetHandle() != NULL)
+	{
+		m_handleBuffer.Bind(BINDLESS_TEXTURE_TABLE_BINDING);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the sampler given, or the renderer's default one if it's null
+//
+const Sampler* BindlessTextureTable::GetSamplerOrDefault(const Sampler* sampler) const
+{
+	if (sampler != nullptr)
+	{
+		return sampler;
+	}
+
+	return Renderer::GetInstance()->GetDefaultSampler();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Empties the entry's slot for reuse, zeroing its handle so the shaders never see a stale one
+//
+void BindlessTextureTable::RemoveEntry(int entryIndex)
+{
+	TableEntry_t& entry = m_entries[entryIndex];
+	m_indicesByKey.erase(TableKey(entry.texture, entry.sampler));
+
+	entry.texture = nullptr;
+	entry.sampler = nullptr;
+	m_handles[entryIndex] = 0;
+	m_freeIndices.push_back(entryIndex);
+
+	m_isDirty = true;
+	m_generation++;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes the texture from every table
+//
+void BindlessTextureTable::OnTextureDestroyed(const Texture* texture)
+{
+	for (int tableIndex = 0; tableIndex < (int) s_tables.size(); ++tableIndex)
+	{
+		s_tables[tableIndex]->RemoveTexture(texture);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes the sampler from every table
+//
+void BindlessTextureTable::OnSamplerDestroyed(const Sampler* sampler)
+{
+	for (int tableIndex = 0; tableIndex < (int) s_tables.size(); ++tableIndex)
+	{
+		s_tables[tableIndex]->RemoveSampler(sampler);
+	}
+}
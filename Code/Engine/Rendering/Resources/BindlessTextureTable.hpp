@@ -0,0 +1,94 @@
+/************************************************************************/
+/* File: BindlessTextureTable.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Storage buffer of bindless texture handles, so shaders can
+/*				pick their texture by index instead of it being bound
+/************************************************************************/
+#pragma once
+#include <map>
+#include <vector>
+#include <utility>
+#include <stdint.h>
+#include "Engine/Rendering/Buffers/RenderBuffer.hpp"
+
+class Texture;
+class Sampler;
+
+#define BINDLESS_TEXTURE_TABLE_BINDING (14)
+
+// Int property of materials' shaders that read their diffuse from the renderer's table, see Material::UpdateBindlessDiffuse()
+#define BINDLESS_TEXTURE_INDEX_PROPERTY "TEXTURE_INDEX"
+
+// Shader side, with GL_ARB_bindless_texture enabled:
+//
+//	layout(binding=14, std430) readonly buffer bindlessTextureBlock { uvec2 BINDLESS_TEXTURES[]; };
+//	vec4 color = texture(sampler2D(BINDLESS_TEXTURES[TEXTURE_INDEX]), uv);
+//
+// Materials whose shader has the TEXTURE_INDEX property get their diffuse's index set on it by the renderer
+// instead of binding it, so draws that only differ in texture stop costing a texture bind each
+
+class BindlessTextureTable
+{
+public:
+	//-----Public Methods-----
+
+	BindlessTextureTable();
+	~BindlessTextureTable();
+	BindlessTextureTable(const BindlessTextureTable& copy) = delete;
+
+	// Returns the texture's index in the table, adding it if it isn't there already
+	// Uses the renderer's default sampler if none is given; returns -1 if bindless isn't supported
+	int		AddTexture(const Texture* texture, const Sampler* sampler = nullptr);
+	int		GetTextureIndex(const Texture* texture, const Sampler* sampler = nullptr) const;
+
+	// Removed slots are reused by later adds, so anything holding an index should check the generation
+	void	RemoveTexture(const Texture* texture);
+	void	RemoveSampler(const Sampler* sampler);
+	void	RemoveAll();
+
+	int			GetCount() const;
+	uint32_t	GetGeneration() const;		// Changes whenever an index handed out stops being valid
+
+	// Uploads the handles if any were added since the last bind, then binds the table
+	void	Bind();
+
+	// Called by textures when their storage is deleted and by samplers when destroyed, so no table
+	// keeps a handle to them
+	static void OnTextureDestroyed(const Texture* texture);
+	static void OnSamplerDestroyed(const Sampler* sampler);
+
+
+private:
+	//-----Private Types-----
+
+	struct TableEntry_t
+	{
+		const Texture*	texture = nullptr;
+		const Sampler*	sampler = nullptr;
+	};
+
+
+private:
+	//-----Private Methods-----
+
+	const Sampler*	GetSamplerOrDefault(const Sampler* sampler) const;
+	void			RemoveEntry(int entryIndex);
+
+
+private:
+	//-----Private Data-----
+
+	typedef std::pair<const Texture*, const Sampler*> TableKey;
+
+	std::vector<TableEntry_t>	m_entries;			// Removed ones are left empty until reused
+	std::vector<uint64_t>		m_handles;			// Parallel to m_entries, 0 for empty ones
+	std::vector<int>			m_freeIndices;
+	std::map<TableKey, int>		m_indicesByKey;
+	RenderBuffer				m_handleBuffer;
+	bool						m_isDirty = false;
+	uint32_t					m_generation = 0;
+
+	static std::vector<BindlessTextureTable*> s_tables;		// Every live table, for the destroy callbacks
+
+};
@@ -18,6 +18,10 @@ BitmapFont::BitmapFont(const SpriteSheet& glyphSheet, float baseAspect)
 	: m_spriteSheet(glyphSheet)
 	, m_baseAspect(baseAspect)
 {
+	for (int glyphID = 0; glyphID < 256; ++glyphID)
+	{
+		m_glyphAspects[glyphID] = baseAspect;
+	}
 }
 
 
@@ -31,21 +35,37 @@ AABB2 BitmapFont::GetGlyphUVs(int glyphID) const
 
 
 //-----------------------------------------------------------------------------------------------
-// Returns the width of the given string, taking into consideration the base aspect, aspect scale,
+// Returns the width:height ratio of the given glyph
+//
+float BitmapFont::GetGlyphAspect(int glyphID) const
+{
+	return m_glyphAspects[glyphID & 0xFF];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the width:height ratio of the given glyph, for fonts that aren't monospaced
+//
+void BitmapFont::SetGlyphAspect(int glyphID, float aspect)
+{
+	m_glyphAspects[glyphID & 0xFF] = aspect;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the width of the given string, taking into consideration the glyph aspects, aspect scale,
 // and cell height of the font
 //
-float BitmapFont::GetStringWidth(const std::string& asciiText, float cellHeight, float aspectScale)
+float BitmapFont::GetStringWidth(std::string_view asciiText, float cellHeight, float aspectScale) const
 {
-	float totalWidth = 0.f;
+	float totalAspect = 0.f;
 
 	for (int charIndex = 0; charIndex < static_cast<int>(asciiText.length()); charIndex++)
 	{
-		float glyphAspect = GetGlyphAspect();
-		float glyphWidth = (glyphAspect * cellHeight) * aspectScale;
-		totalWidth += glyphWidth;
+		totalAspect += m_glyphAspects[(unsigned char) asciiText[charIndex]];
 	}
 
-	return totalWidth;
+	return totalAspect * cellHeight * aspectScale;
 }
 
 
@@ -56,3 +76,21 @@ const SpriteSheet& BitmapFont::GetSpriteSheet() const
 {
 	return m_spriteSheet;
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the sheet holds distances to the glyph edges instead of coverage
+//
+bool BitmapFont::IsSignedDistanceField() const
+{
+	return m_isSignedDistanceField;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets whether the sheet holds distances to the glyph edges, which changes the material text draws with
+//
+void BitmapFont::SetIsSignedDistanceField(bool isSignedDistanceField)
+{
+	m_isSignedDistanceField = isSignedDistanceField;
+}
@@ -6,6 +6,7 @@
 /* Description: Class to represent a font spritesheet
 /************************************************************************/
 #pragma once
+#include <string_view>
 #include "Engine/Rendering/Resources/SpriteSheet.hpp"
 
 
@@ -18,11 +19,18 @@ public:
 	//-----Public Methods-----
 
 	AABB2 GetGlyphUVs(int glyphID) const;
-	float GetGlyphAspect() const { return m_baseAspect; }	// Will replace later when we implement varied aspects
-	float GetStringWidth(const std::string& asciiText, float cellHeight, float aspectScale);
+	float GetGlyphAspect() const { return m_baseAspect; }
+	float GetGlyphAspect(int glyphID) const;
+	void  SetGlyphAspect(int glyphID, float aspect);
+	float GetStringWidth(std::string_view asciiText, float cellHeight, float aspectScale) const;
 
 	const SpriteSheet& GetSpriteSheet() const;
 
+	// Signed distance field fonts store the distance to each glyph's edge instead of its coverage,
+	// so one low resolution sheet draws sharp at any cell height
+	bool  IsSignedDistanceField() const;
+	void  SetIsSignedDistanceField(bool isSignedDistanceField);
+
 
 private:
 	//-----Private Methods-----
@@ -36,5 +44,7 @@ private:
 
 	const SpriteSheet m_spriteSheet;	// The spritesheet of the font, assumed to be 16x16
 	float m_baseAspect;					// The base width:height ratio of the font
+	float m_glyphAspects[256];			// Per glyph width:height, so measuring doesn't recompute them
+	bool  m_isSignedDistanceField = false;
 
 };
\ No newline at end of file
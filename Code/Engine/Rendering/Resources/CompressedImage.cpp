@@ -0,0 +1,488 @@
+/************************************************************************/
+/* File: CompressedImage.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the CompressedImage class
+/************************************************************************/
+#include <ctype.h>
+#include <string.h>
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
+#include "Engine/Rendering/Resources/CompressedImage.hpp"
+
+// DDS layout - "DDS ", then a 124 byte header, then a 20 byte DX10 header if the pixel format's fourCC is "DX10"
+#define DDS_MAGIC (0x20534444)
+#define DDS_HEADER_SIZE (124)
+#define DDS_DX10_HEADER_SIZE (20)
+#define DDS_FLAG_MIPMAPCOUNT (0x20000)
+#define DDS_PIXELFORMAT_FLAG_FOURCC (0x4)
+#define DDS_CAPS2_CUBEMAP (0x200)
+#define DDS_CAPS2_VOLUME (0x200000)
+#define DDS_DX10_DIMENSION_TEXTURE2D (3)
+#define DDS_DX10_MISC_TEXTURECUBE (0x4)
+
+// KTX2 layout - 12 byte identifier, 9 uint32 header fields, a 32 byte index, then 24 bytes per level
+#define KTX2_IDENTIFIER_SIZE (12)
+#define KTX2_LEVEL_INDEX_OFFSET (80)
+#define KTX2_LEVEL_INDEX_ENTRY_SIZE (24)
+
+static const uint8_t KTX2_IDENTIFIER[KTX2_IDENTIFIER_SIZE] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+// C functions
+static uint32_t		MakeFourCC(const char* characters);
+static uint32_t		ReadUInt32(const uint8_t* data);
+static uint64_t		ReadUInt64(const uint8_t* data);
+static bool			HasExtension(const std::string& filepath, const std::string& extension);
+static bool			GetFormatFromDDSFourCC(uint32_t fourCC, TextureFormat& out_format);
+static bool			GetFormatFromDXGIFormat(uint32_t dxgiFormat, TextureFormat& out_format);
+static bool			GetFormatFromVkFormat(uint32_t vkFormat, TextureFormat& out_format);
+static unsigned int	GetMaxMipLevelCount(const IntVector2& dimensions);
+
+
+//-----------------------------------------------------------------------------------------------
+// Maps the file and reads its format and levels, with each level pointing into the mapping
+// Only logs on failure, since this runs on the disk workers for async loads
+//
+bool CompressedImage::LoadFromFile(const std::string& filepath)
+{
+	PROFILE_SCOPE_CATEGORY("CompressedImage::LoadFromFile", "Assets");
+
+	m_file.Close();
+	m_mipLevels.clear();
+
+	if (!m_file.OpenMapped(filepath.c_str()))
+	{
+		LogTaggedPrintf("ASSETS", "Error: CompressedImage couldn't open \"%s\"", filepath.c_str());
+		return false;
+	}
+
+	bool succeeded = false;
+	if (HasExtension(filepath, ".dds"))
+	{
+		succeeded = ParseDDS();
+	}
+	else if (HasExtension(filepath, ".ktx2"))
+	{
+		succeeded = ParseKTX2();
+	}
+
+	if (!succeeded)
+	{
+		LogTaggedPrintf("ASSETS", "Error: CompressedImage couldn't read \"%s\", it isn't a 2D BC1/3/4/5/7 image", filepath.c_str());
+		m_file.Close();
+		m_mipLevels.clear();
+		return false;
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the block format of the image
+//
+TextureFormat CompressedImage::GetFormat() const
+{
+	return m_format;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the dimensions of the first mip level
+//
+IntVector2 CompressedImage::GetDimensions() const
+{
+	return m_dimensions;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of stored mip levels, 0 if nothing is loaded
+//
+int CompressedImage::GetMipLevelCount() const
+{
+	return (int) m_mipLevels.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the level given by levelIndex, with 0 the largest
+//
+const CompressedMipLevel_t& CompressedImage::GetMipLevel(int levelIndex) const
+{
+	ASSERT_OR_DIE(levelIndex >= 0 && levelIndex < (int) m_mipLevels.size(), Stringf("Error: CompressedImage::GetMipLevel() index %i out of range", levelIndex));
+	return m_mipLevels[levelIndex];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the file is one this class loads, by extension
+//
+bool CompressedImage::IsCompressedImagePath(const std::string& filepath)
+{
+	return (HasExtension(filepath, ".dds") || HasExtension(filepath, ".ktx2"));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the first source image next to the file with the same name, for machines that can't sample the format
+//
+std::string CompressedImage::GetFallbackImagePath(const std::string& filepath)
+{
+	size_t extensionIndex = filepath.find_last_of('.');
+
+	if (extensionIndex == std::string::npos)
+	{
+		return "";
+	}
+
+	std::string basePath = filepath.substr(0, extensionIndex);
+	const char* fallbackExtensions[] = { ".png", ".tga", ".jpg" };
+
+	for (const char* extension : fallbackExtensions)
+	{
+		std::string fallbackPath = basePath + extension;
+
+		if (DoesFileExist(fallbackPath))
+		{
+			return fallbackPath;
+		}
+	}
+
+	return "";
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads the DDS header, accepting the legacy DXTn/ATIn fourCCs and the DX10 extended header
+//
+bool CompressedImage::ParseDDS()
+{
+	const uint8_t* data = (const uint8_t*) m_file.GetData();
+	size_t fileSize = m_file.GetSize();
+
+	if (fileSize < 4 + DDS_HEADER_SIZE || ReadUInt32(data) != DDS_MAGIC || ReadUInt32(data + 4) != DDS_HEADER_SIZE)
+	{
+		return false;
+	}
+
+	const uint8_t* header = data + 4;
+	uint32_t flags			= ReadUInt32(header + 4);
+	uint32_t height			= ReadUInt32(header + 8);
+	uint32_t width			= ReadUInt32(header + 12);
+	uint32_t mipCount		= ReadUInt32(header + 24);
+	uint32_t pixelFlags		= ReadUInt32(header + 76);
+	uint32_t fourCC			= ReadUInt32(header + 80);
+	uint32_t caps2			= ReadUInt32(header + 108);
+
+	if ((pixelFlags & DDS_PIXELFORMAT_FLAG_FOURCC) == 0 || (caps2 & (DDS_CAPS2_CUBEMAP | DDS_CAPS2_VOLUME)) != 0)
+	{
+		return false;
+	}
+
+	size_t dataOffset = 4 + DDS_HEADER_SIZE;
+
+	if (fourCC == MakeFourCC("DX10"))
+	{
+		if (fileSize < dataOffset + DDS_DX10_HEADER_SIZE)
+		{
+			return false;
+		}
+
+		const uint8_t* dx10Header = data + dataOffset;
+		uint32_t dxgiFormat		= ReadUInt32(dx10Header);
+		uint32_t dimension		= ReadUInt32(dx10Header + 4);
+		uint32_t miscFlags		= ReadUInt32(dx10Header + 8);
+		uint32_t arraySize		= ReadUInt32(dx10Header + 12);
+
+		if (dimension != DDS_DX10_DIMENSION_TEXTURE2D || (miscFlags & DDS_DX10_MISC_TEXTURECUBE) != 0 || arraySize > 1)
+		{
+			return false;
+		}
+
+		if (!GetFormatFromDXGIFormat(dxgiFormat, m_format))
+		{
+			return false;
+		}
+
+		dataOffset += DDS_DX10_HEADER_SIZE;
+	}
+	else if (!GetFormatFromDDSFourCC(fourCC, m_format))
+	{
+		return false;
+	}
+
+	// Mip count is only meaningful with its flag set, some writers leave garbage in it otherwise
+	if ((flags & DDS_FLAG_MIPMAPCOUNT) == 0 || mipCount == 0)
+	{
+		mipCount = 1;
+	}
+
+	m_dimensions = IntVector2((int) width, (int) height);
+
+	return AddMipLevels(dataOffset, mipCount);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads the KTX2 header and level index, which stores levels smallest first but indexes them largest first
+//
+bool CompressedImage::ParseKTX2()
+{
+	const uint8_t* data = (const uint8_t*) m_file.GetData();
+	size_t fileSize = m_file.GetSize();
+
+	if (fileSize < KTX2_LEVEL_INDEX_OFFSET || memcmp(data, KTX2_IDENTIFIER, KTX2_IDENTIFIER_SIZE) != 0)
+	{
+		return false;
+	}
+
+	uint32_t vkFormat				= ReadUInt32(data + 12);
+	uint32_t width					= ReadUInt32(data + 20);
+	uint32_t height					= ReadUInt32(data + 24);
+	uint32_t depth					= ReadUInt32(data + 28);
+	uint32_t layerCount				= ReadUInt32(data + 32);
+	uint32_t faceCount				= ReadUInt32(data + 36);
+	uint32_t levelCount				= ReadUInt32(data + 40);
+	uint32_t supercompressionScheme	= ReadUInt32(data + 44);
+
+	if (depth > 0 || layerCount > 1 || faceCount != 1 || supercompressionScheme != 0)
+	{
+		return false;
+	}
+
+	if (!GetFormatFromVkFormat(vkFormat, m_format))
+	{
+		return false;
+	}
+
+	// 0 means the file only has the base level, and wants mips generated - which can't be done for block formats
+	if (levelCount == 0)
+	{
+		levelCount = 1;
+	}
+
+	m_dimensions = IntVector2((int) width, (int) height);
+
+	if (width == 0 || height == 0 || levelCount > GetMaxMipLevelCount(m_dimensions))
+	{
+		return false;
+	}
+
+	if (fileSize < KTX2_LEVEL_INDEX_OFFSET + (size_t) levelCount * KTX2_LEVEL_INDEX_ENTRY_SIZE)
+	{
+		return false;
+	}
+
+	for (uint32_t levelIndex = 0; levelIndex < levelCount; ++levelIndex)
+	{
+		const uint8_t* entry = data + KTX2_LEVEL_INDEX_OFFSET + levelIndex * KTX2_LEVEL_INDEX_ENTRY_SIZE;
+		uint64_t byteOffset = ReadUInt64(entry);
+		uint64_t byteLength = ReadUInt64(entry + 8);
+
+		if (byteOffset > fileSize || byteLength > fileSize)
+		{
+			return false;
+		}
+
+		if (!AddMipLevel((size_t) byteOffset, (size_t) byteLength))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds levelCount levels stored back to back from dataOffset, largest first
+//
+bool CompressedImage::AddMipLevels(size_t dataOffset, unsigned int levelCount)
+{
+	if (m_dimensions.x <= 0 || m_dimensions.y <= 0 || levelCount > GetMaxMipLevelCount(m_dimensions))
+	{
+		return false;
+	}
+
+	unsigned int blockByteCount = GetCompressedBlockByteCount(m_format);
+	IntVector2 levelDimensions = m_dimensions;
+
+	for (unsigned int levelIndex = 0; levelIndex < levelCount; ++levelIndex)
+	{
+		size_t blockCountX = (size_t) ((levelDimensions.x + 3) / 4);
+		size_t blockCountY = (size_t) ((levelDimensions.y + 3) / 4);
+		size_t byteCount = blockCountX * blockCountY * blockByteCount;
+
+		if (!AddMipLevel(dataOffset, byteCount))
+		{
+			return false;
+		}
+
+		dataOffset += byteCount;
+		levelDimensions = IntVector2(MaxInt(levelDimensions.x / 2, 1), MaxInt(levelDimensions.y / 2, 1));
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the next level down the chain, checking the data is the size its dimensions need and is inside the file
+//
+bool CompressedImage::AddMipLevel(size_t dataOffset, size_t byteCount)
+{
+	int levelIndex = (int) m_mipLevels.size();
+
+	CompressedMipLevel_t level;
+	level.dimensions = IntVector2(MaxInt(m_dimensions.x >> levelIndex, 1), MaxInt(m_dimensions.y >> levelIndex, 1));
+
+	size_t blockCountX = (size_t) ((level.dimensions.x + 3) / 4);
+	size_t blockCountY = (size_t) ((level.dimensions.y + 3) / 4);
+	size_t expectedByteCount = blockCountX * blockCountY * GetCompressedBlockByteCount(m_format);
+
+	if (byteCount != expectedByteCount || dataOffset > m_file.GetSize() || byteCount > m_file.GetSize() - dataOffset)
+	{
+		return false;
+	}
+
+	level.data = (const uint8_t*) m_file.GetData() + dataOffset;
+	level.byteCount = (unsigned int) byteCount;
+
+	m_mipLevels.push_back(level);
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the four characters as a little endian uint32, as they're stored in the file
+//
+static uint32_t MakeFourCC(const char* characters)
+{
+	return ((uint32_t) (uint8_t) characters[0]) | ((uint32_t) (uint8_t) characters[1] << 8) | ((uint32_t) (uint8_t) characters[2] << 16) | ((uint32_t) (uint8_t) characters[3] << 24);
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Reads a little endian uint32 from possibly unaligned data
+//
+static uint32_t ReadUInt32(const uint8_t* data)
+{
+	uint32_t value;
+	memcpy(&value, data, sizeof(uint32_t));
+
+	return value;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Reads a little endian uint64 from possibly unaligned data
+//
+static uint64_t ReadUInt64(const uint8_t* data)
+{
+	uint64_t value;
+	memcpy(&value, data, sizeof(uint64_t));
+
+	return value;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns true if the filepath ends with the extension, case insensitive since texture tools disagree on it
+//
+static bool HasExtension(const std::string& filepath, const std::string& extension)
+{
+	if (filepath.size() < extension.size())
+	{
+		return false;
+	}
+
+	size_t startIndex = filepath.size() - extension.size();
+	for (size_t charIndex = 0; charIndex < extension.size(); ++charIndex)
+	{
+		if (tolower((unsigned char) filepath[startIndex + charIndex]) != tolower((unsigned char) extension[charIndex]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Maps the legacy DDS fourCCs to formats, DXT3 (BC2) is left out as nothing in the engine uses it
+//
+static bool GetFormatFromDDSFourCC(uint32_t fourCC, TextureFormat& out_format)
+{
+	if (fourCC == MakeFourCC("DXT1"))									{ out_format = TEXTURE_FORMAT_BC1; }
+	else if (fourCC == MakeFourCC("DXT5"))								{ out_format = TEXTURE_FORMAT_BC3; }
+	else if (fourCC == MakeFourCC("ATI1") || fourCC == MakeFourCC("BC4U"))	{ out_format = TEXTURE_FORMAT_BC4; }
+	else if (fourCC == MakeFourCC("ATI2") || fourCC == MakeFourCC("BC5U"))	{ out_format = TEXTURE_FORMAT_BC5; }
+	else
+	{
+		return false;
+	}
+
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Maps DXGI_FORMAT values to formats - sRGB variants load as UNORM, matching how RGBA8 images are sampled
+//
+static bool GetFormatFromDXGIFormat(uint32_t dxgiFormat, TextureFormat& out_format)
+{
+	switch (dxgiFormat)
+	{
+	case 71: case 72: out_format = TEXTURE_FORMAT_BC1; break;	// DXGI_FORMAT_BC1_UNORM(_SRGB)
+	case 77: case 78: out_format = TEXTURE_FORMAT_BC3; break;	// DXGI_FORMAT_BC3_UNORM(_SRGB)
+	case 80:		  out_format = TEXTURE_FORMAT_BC4; break;	// DXGI_FORMAT_BC4_UNORM
+	case 83:		  out_format = TEXTURE_FORMAT_BC5; break;	// DXGI_FORMAT_BC5_UNORM
+	case 98: case 99: out_format = TEXTURE_FORMAT_BC7; break;	// DXGI_FORMAT_BC7_UNORM(_SRGB)
+	default:
+		return false;
+	}
+
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Maps VkFormat values to formats, with sRGB loaded as UNORM the same as for DDS
+//
+static bool GetFormatFromVkFormat(uint32_t vkFormat, TextureFormat& out_format)
+{
+	switch (vkFormat)
+	{
+	case 131: case 132: case 133: case 134: out_format = TEXTURE_FORMAT_BC1; break;	// VK_FORMAT_BC1_RGB(A)_UNORM/SRGB_BLOCK
+	case 137: case 138:						out_format = TEXTURE_FORMAT_BC3; break;	// VK_FORMAT_BC3_UNORM/SRGB_BLOCK
+	case 139:								out_format = TEXTURE_FORMAT_BC4; break;	// VK_FORMAT_BC4_UNORM_BLOCK
+	case 141:								out_format = TEXTURE_FORMAT_BC5; break;	// VK_FORMAT_BC5_UNORM_BLOCK
+	case 145: case 146:						out_format = TEXTURE_FORMAT_BC7; break;	// VK_FORMAT_BC7_UNORM/SRGB_BLOCK
+	default:
+		return false;
+	}
+
+	return true;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------
+// Returns the number of levels in a full chain down to 1x1, the most glTexStorage2D accepts
+//
+static unsigned int GetMaxMipLevelCount(const IntVector2& dimensions)
+{
+	unsigned int maxDimension = (unsigned int) MaxInt(dimensions.x, dimensions.y);
+	unsigned int levelCount = 1;
+
+	while (maxDimension > 1)
+	{
+		maxDimension >>= 1;
+		++levelCount;
+	}
+
+	return levelCount;
+}
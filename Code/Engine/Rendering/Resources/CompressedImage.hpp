@@ -0,0 +1,67 @@
+/************************************************************************/
+/* File: CompressedImage.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: A block compressed (BCn) image with its full mip chain,
+/*				read from .dds or .ktx2 files so textures upload without
+/*				decoding or generating mips at load
+/************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "Engine/Core/File.hpp"
+#include "Engine/Math/IntVector2.hpp"
+#include "Engine/Rendering/OpenGL/glTypes.hpp"
+
+// Points into the mapped file, valid as long as the image is
+struct CompressedMipLevel_t
+{
+	IntVector2		dimensions;
+	const uint8_t*	data = nullptr;
+	unsigned int	byteCount = 0;
+};
+
+
+class CompressedImage
+{
+public:
+	//-----Public Methods-----
+
+	CompressedImage() {}
+	~CompressedImage() {}
+
+	// Maps the file and checks every level fits in it, safe to call off the main thread
+	// Only 2D BC1/3/4/5/7 images are accepted - no cubemaps, arrays or supercompression
+	bool							LoadFromFile(const std::string& filepath);
+
+	TextureFormat					GetFormat() const;
+	IntVector2						GetDimensions() const;
+	int								GetMipLevelCount() const;
+	const CompressedMipLevel_t&		GetMipLevel(int levelIndex) const;
+
+	static bool						IsCompressedImagePath(const std::string& filepath);
+
+	// Returns the path of a .png/.tga/.jpg next to the compressed file, or "" if there isn't one
+	static std::string				GetFallbackImagePath(const std::string& filepath);
+
+
+private:
+	//-----Private Methods-----
+
+	bool	ParseDDS();
+	bool	ParseKTX2();
+
+	bool	AddMipLevels(size_t dataOffset, unsigned int levelCount);
+	bool	AddMipLevel(size_t dataOffset, size_t byteCount);
+
+
+private:
+	//-----Private Data-----
+
+	File								m_file;
+	TextureFormat						m_format = TEXTURE_FORMAT_BC1;
+	IntVector2							m_dimensions;
+	std::vector<CompressedMipLevel_t>	m_mipLevels;
+
+};
@@ -0,0 +1,183 @@
+/************************************************************************/
+/* File: RenderTargetPool.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the RenderTargetPool class
+/************************************************************************/
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/Resources/Texture.hpp"
+#include "Engine/Rendering/Resources/RenderTargetPool.hpp"
+
+std::vector<RenderTargetPool::PooledTarget_t>	RenderTargetPool::s_targets;
+uint64_t										RenderTargetPool::s_frameNumber = 0;
+bool											RenderTargetPool::s_isShutdown = false;
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a target of the size and format for this frame, returned to the pool at EndFrame() if
+// it isn't released before
+//
+Texture* RenderTargetPool::AcquireTransient(const IntVector2& dimensions, TextureFormat format)
+{
+	return AcquireInternal(dimensions, format, true);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a target of the size and format, kept until it's released
+//
+Texture* RenderTargetPool::Acquire(const IntVector2& dimensions, TextureFormat format)
+{
+	return AcquireInternal(dimensions, format, false);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the target to the pool, so the next acquire of its size and format can use it
+//
+void RenderTargetPool::Release(Texture* target)
+{
+	if (target == nullptr || s_isShutdown)
+	{
+		return;
+	}
+
+	for (int targetIndex = 0; targetIndex < (int) s_targets.size(); ++targetIndex)
+	{
+		if (s_targets[targetIndex].texture == target)
+		{
+			ASSERT_OR_DIE(s_targets[targetIndex].isAcquired, "Error: RenderTargetPool::Release() called on a target that was already released");
+			s_targets[targetIndex].isAcquired = false;
+			return;
+		}
+	}
+
+	ERROR_AND_DIE("Error: RenderTargetPool::Release() called on a target that isn't from the pool");
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the frame's transient targets to the pool, and deletes the free ones unused for a while
+//
+void RenderTargetPool::EndFrame()
+{
+	for (int targetIndex = (int) s_targets.size() - 1; targetIndex >= 0; --targetIndex)
+	{
+		PooledTarget_t& target = s_targets[targetIndex];
+
+		if (target.isAcquired && target.isTransient)
+		{
+			target.isAcquired = false;
+		}
+
+		if (!target.isAcquired && s_frameNumber - target.lastAcquiredFrame > RENDER_TARGET_POOL_UNUSED_FRAMES)
+		{
+			delete target.texture;
+
+			s_targets[targetIndex] = s_targets.back();
+			s_targets.pop_back();
+		}
+	}
+
+	s_frameNumber++;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes every target, acquired or not; needs the context, so is called before it's destroyed
+//
+void RenderTargetPool::Shutdown()
+{
+	for (int targetIndex = 0; targetIndex < (int) s_targets.size(); ++targetIndex)
+	{
+		delete s_targets[targetIndex].texture;
+	}
+
+	s_targets.clear();
+	s_isShutdown = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of targets in the pool, acquired or not
+//
+int RenderTargetPool::GetTargetCount()
+{
+	return (int) s_targets.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of targets currently acquired
+//
+int RenderTargetPool::GetAcquiredCount()
+{
+	int acquiredCount = 0;
+
+	for (int targetIndex = 0; targetIndex < (int) s_targets.size(); ++targetIndex)
+	{
+		if (s_targets[targetIndex].isAcquired)
+		{
+			acquiredCount++;
+		}
+	}
+
+	return acquiredCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the GPU memory of all targets in the pool
+//
+size_t RenderTargetPool::GetGPUByteCount()
+{
+	size_t byteCount = 0;
+
+	for (int targetIndex = 0; targetIndex < (int) s_targets.size(); ++targetIndex)
+	{
+		byteCount += s_targets[targetIndex].texture->GetGPUByteCount();
+	}
+
+	return byteCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a free target of the size and format, making one if there isn't one
+// Targets released earlier in the frame are reused, so the steps of an effect chain share memory
+//
+Texture* RenderTargetPool::AcquireInternal(const IntVector2& dimensions, TextureFormat format, bool isTransient)
+{
+	ASSERT_OR_DIE(dimensions.x > 0 && dimensions.y > 0, Stringf("Error: RenderTargetPool asked for a %ix%i target", dimensions.x, dimensions.y));
+
+	PooledTarget_t* pooledTarget = nullptr;
+
+	for (int targetIndex = 0; targetIndex < (int) s_targets.size(); ++targetIndex)
+	{
+		PooledTarget_t& target = s_targets[targetIndex];
+
+		if (!target.isAcquired && target.format == format && target.dimensions == dimensions)
+		{
+			pooledTarget = &target;
+			break;
+		}
+	}
+
+	if (pooledTarget == nullptr)
+	{
+		PooledTarget_t newTarget;
+		newTarget.texture = new Texture();
+		newTarget.texture->CreateRenderTarget((unsigned int) dimensions.x, (unsigned int) dimensions.y, format);
+		newTarget.dimensions = dimensions;
+		newTarget.format = format;
+
+		s_targets.push_back(newTarget);
+		pooledTarget = &s_targets.back();
+	}
+
+	pooledTarget->isAcquired = true;
+	pooledTarget->isTransient = isTransient;
+	pooledTarget->lastAcquiredFrame = s_frameNumber;
+
+	return pooledTarget->texture;
+}
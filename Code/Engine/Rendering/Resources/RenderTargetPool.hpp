@@ -0,0 +1,74 @@
+/************************************************************************/
+/* File: RenderTargetPool.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Pool of render targets by size and format, so image
+/*				effects and shadow maps reuse textures instead of each
+/*				keeping their own
+/************************************************************************/
+#pragma once
+#include <vector>
+#include <stdint.h>
+#include "Engine/Math/IntVector2.hpp"
+#include "Engine/Rendering/OpenGL/glTypes.hpp"
+
+class Texture;
+
+// Free targets not acquired for this many frames are deleted
+#define RENDER_TARGET_POOL_UNUSED_FRAMES (60)
+
+// How to use:
+//	- AcquireTransient() for a target that's only needed this frame, i.e. a step of a post process chain;
+//	  Release() it as soon as it's been read so a later step can reuse it, anything not released is at EndFrame()
+//	- Acquire() for one kept across frames, i.e. a shadow map, which must be Release()'d
+// The pool owns the textures, they must not be deleted, or used after they're released
+
+class RenderTargetPool
+{
+public:
+	//-----Public Methods-----
+
+	// Render thread only
+	static Texture*		AcquireTransient(const IntVector2& dimensions, TextureFormat format);
+	static Texture*		Acquire(const IntVector2& dimensions, TextureFormat format);
+	static void			Release(Texture* target);
+
+	// Returns this frame's transient targets, and evicts the ones unused for a while; called by the Renderer
+	static void			EndFrame();
+	static void			Shutdown();
+
+	static int			GetTargetCount();
+	static int			GetAcquiredCount();
+	static size_t		GetGPUByteCount();
+
+
+private:
+	//-----Private Types-----
+
+	struct PooledTarget_t
+	{
+		Texture*		texture = nullptr;
+		IntVector2		dimensions;
+		TextureFormat	format = TEXTURE_FORMAT_RGBA8;
+		bool			isAcquired = false;
+		bool			isTransient = false;
+		uint64_t		lastAcquiredFrame = 0;
+	};
+
+
+private:
+	//-----Private Methods-----
+
+	RenderTargetPool() {}
+
+	static Texture*		AcquireInternal(const IntVector2& dimensions, TextureFormat format, bool isTransient);
+
+
+private:
+	//-----Private Data-----
+
+	static std::vector<PooledTarget_t>	s_targets;
+	static uint64_t						s_frameNumber;
+	static bool							s_isShutdown;		// Owners released after the context is gone have nothing to return
+
+};
@@ -8,6 +8,8 @@
 #include "Engine/Math/Vector4.hpp"
 #include "Engine/Rendering/Resources/Sampler.hpp"
 #include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include "Engine/Rendering/OpenGL/GLStateCache.hpp"
+#include "Engine/Rendering/Resources/BindlessTextureTable.hpp"
 
 
 //-----------------------------------------------------------------------------------------------
@@ -89,7 +91,11 @@ bool Sampler::Initialize(SamplerFilter samplerFilter, EdgeSampling edgeSampling)
 void Sampler::Destroy()
 {
 	if (m_samplerHandle != NULL) {
+		// Textures' bindless handles for it go with it, and tables can't keep them
+		BindlessTextureTable::OnSamplerDestroyed(this);
+
 		glDeleteSamplers( 1, &m_samplerHandle ); 
+		GLStateCache::OnSamplerDeleted(m_samplerHandle);
 		m_samplerHandle = NULL; 
 	}
 } 
@@ -127,7 +127,7 @@ SpriteSheet* SpriteSheet::LoadSpriteSheet(const std::string& filePath)
 {
 	// First get the general spritesheet information
 	XMLDocument document;
-	XMLError error = document.LoadFile(filePath.c_str());
+	XMLError error = LoadXmlDocument(document, filePath);
 	ASSERT_OR_DIE(error == tinyxml2::XML_SUCCESS, Stringf("Error: SpriteSheet::LoadSpriteSheet() couldn't load file \"%s\"", filePath.c_str()));
 
 	XMLElement* rootElement = document.RootElement();
@@ -10,12 +10,19 @@
 #define WIN32_LEAN_AND_MEAN
 #endif
 #include <Windows.h>
+#include <vector>
 #include "Engine/Core/Image.hpp"
+#include "Engine/Core/LogSystem.hpp"
 #include "Engine/Assets/AssetDB.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Rendering/Resources/Texture.hpp"
+#include "Engine/Rendering/Resources/Sampler.hpp"
 #include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include "Engine/Rendering/OpenGL/GLStateCache.hpp"
+#include "Engine/Rendering/Buffers/GPUUploadQueue.hpp"
+#include "Engine/Rendering/Resources/CompressedImage.hpp"
+#include "Engine/Rendering/Resources/BindlessTextureTable.hpp"
 
 #include "ThirdParty/stb/stb_image.h"
 
@@ -34,6 +41,8 @@
 // |-------------------------|-------------------------|-------------------------|-------------------------| //
 // |D24S8 (Depth24/Stencil8) |   GL_DEPTH24_STENCIL8   |     GL_DEPTH_STENCIL    |   GL_UNSIGNED_INT_24_8  | //
 // |-------------------------|-------------------------|-------------------------|-------------------------| //
+// |    BC1/3/4/5/7          |  GL_COMPRESSED_* block  |  (same as internal)     |         GL_NONE         | //
+// |-------------------------|-------------------------|-------------------------|-------------------------| //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -49,16 +58,17 @@ Texture::Texture()
 	, m_dimensions(0, 0)
 	, m_textureFormat(TEXTURE_FORMAT_RGBA8)
 	, m_textureType(TEXTURE_TYPE_2D)
+	, m_isUsingMipMaps(false)
+	, m_mipLevelCount(0)
 {
 }
 
 
 Texture::~Texture()
 {
-	if (m_textureHandle != NULL)
-	{
-		glDeleteTextures(1, &m_textureHandle);
-	}
+	GPUUploadQueue::OnResourceDestroyed(this);
+
+	DeleteTextureHandle();
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -66,6 +76,28 @@ Texture::~Texture()
 //
 bool Texture::CreateFromFile(const std::string& filename, bool useMipMaps /*= false*/)
 {
+	// Compressed files upload their own mips, and fall back to a source image next to them if they can't be used
+	if (CompressedImage::IsCompressedImagePath(filename))
+	{
+		CompressedImage compressedImage;
+
+		if (compressedImage.LoadFromFile(filename) && CreateFromCompressedImage(&compressedImage))
+		{
+			return true;
+		}
+
+		std::string fallbackPath = CompressedImage::GetFallbackImagePath(filename);
+
+		if (fallbackPath.size() == 0)
+		{
+			LogTaggedPrintf("ASSETS", "Error: Texture couldn't load \"%s\", and has no source image to fall back to", filename.c_str());
+			return false;
+		}
+
+		LogTaggedPrintf("ASSETS", "Warning: Texture couldn't use \"%s\", falling back to \"%s\"", filename.c_str(), fallbackPath.c_str());
+		return CreateFromFile(fallbackPath, useMipMaps);
+	}
+
 	Image* loadedImage = AssetDB::CreateOrGetImage(filename);
 
 	if (loadedImage == nullptr)
@@ -97,21 +129,24 @@ void Texture::CreateFromImage(const Image* image, bool useMipMaps /*= false*/)
 
 //-----------------------------------------------------------------------------------------------
 // Initializes the texture using the raw image data given
+// Storage is immutable once allocated, so a texture that already has some gets a new handle
+// Any upload still queued for the texture is dropped, so it can't land over this data later
 //
 void Texture::CreateFromRawData(const IntVector2& dimensions, unsigned int numComponents, const unsigned char* imageData, bool useMipMaps)
 {
-	if (m_textureHandle == NULL)
-	{
-		glGenTextures(1, &m_textureHandle);
-		GL_CHECK_ERROR();
-	}
+	GPUUploadQueue::CancelUploads(this);
+
+	DeleteTextureHandle();
+
+	glGenTextures(1, &m_textureHandle);
+	GL_CHECK_ERROR();
 
 	m_dimensions = dimensions;
 	m_textureFormat = static_cast<TextureFormat>(numComponents - 1);
 
 	// Use texture slot 0 for the operation
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, m_textureHandle);  
+	GLStateCache::SetActiveTextureUnit(0);
+	GLStateCache::BindTexture(0, GL_TEXTURE_2D, m_textureHandle);
 
 	unsigned int numMipLevels = 1;
 	if (useMipMaps)
@@ -119,6 +154,9 @@ void Texture::CreateFromRawData(const IntVector2& dimensions, unsigned int numCo
 		numMipLevels = CalculateMipLevelCount(m_dimensions);
 	}
 
+	m_isUsingMipMaps = useMipMaps;
+	m_mipLevelCount = numMipLevels;
+
 	// Create the GPU-side buffer
 	glTexStorage2D(GL_TEXTURE_2D,
 		numMipLevels,						 // Number of mipmap levels
@@ -146,26 +184,77 @@ void Texture::CreateFromRawData(const IntVector2& dimensions, unsigned int numCo
 
 	GL_CHECK_ERROR();
 
-	glBindTexture(GL_TEXTURE_2D, NULL);
+	GLStateCache::BindTexture(0, GL_TEXTURE_2D, NULL);
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Creates a texture to be used as an ouput image target when ray tracing
+// Initializes the texture from block compressed data, one upload per stored mip level
+// Blocks can't be flipped cheaply, so files must already be authored with the bottom row first
 //
-void Texture::InitializeAsImageTexture(const IntVector2& dimensions)
+bool Texture::CreateFromCompressedImage(const CompressedImage* image)
 {
-	if (m_textureHandle != NULL)
+	TextureFormat format = image->GetFormat();
+	int levelCount = image->GetMipLevelCount();
+
+	if (levelCount == 0 || !IsFormatSupported(format))
 	{
-		glDeleteTextures(1, &m_textureHandle);
+		return false;
+	}
+
+	GPUUploadQueue::CancelUploads(this);
+
+	DeleteTextureHandle();
+
+	glGenTextures(1, &m_textureHandle);
+	GL_CHECK_ERROR();
+
+	m_dimensions = image->GetDimensions();
+	m_textureFormat = format;
+	m_isUsingMipMaps = (levelCount > 1);
+	m_mipLevelCount = levelCount;
+
+	GLStateCache::SetActiveTextureUnit(0);
+	GLStateCache::BindTexture(0, GL_TEXTURE_2D, m_textureHandle);
+
+	glTexStorage2D(GL_TEXTURE_2D, levelCount, ToGLInternalFormat(m_textureFormat), m_dimensions.x, m_dimensions.y);
+	GL_CHECK_ERROR();
+
+	for (int levelIndex = 0; levelIndex < levelCount; ++levelIndex)
+	{
+		const CompressedMipLevel_t& level = image->GetMipLevel(levelIndex);
+
+		glCompressedTexSubImage2D(GL_TEXTURE_2D,
+			levelIndex,
+			0, 0,
+			level.dimensions.x, level.dimensions.y,
+			ToGLChannel(m_textureFormat),		// Compressed uploads take the internal format here
+			level.byteCount,
+			level.data);
 	}
 
+	GL_CHECK_ERROR();
+
+	GLStateCache::BindTexture(0, GL_TEXTURE_2D, NULL);
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Creates a texture to be used as an ouput image target when ray tracing
+//
+void Texture::InitializeAsImageTexture(const IntVector2& dimensions)
+{
+	DeleteTextureHandle();
+
 	m_textureFormat = TEXTURE_FORMAT_RGBA8;
 	m_dimensions = dimensions;
+	m_mipLevelCount = 1;
 
 	glGenTextures(1, &m_textureHandle);
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, m_textureHandle);
+	GLStateCache::SetActiveTextureUnit(0);
+	GLStateCache::BindTexture(0, GL_TEXTURE_2D, m_textureHandle);
 
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
@@ -180,6 +269,48 @@ void Texture::InitializeAsImageTexture(const IntVector2& dimensions)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Allocates immutable storage for the levels without filling it, format must be uncompressed
+//
+void Texture::CreateEmpty(const IntVector2& dimensions, TextureFormat format, unsigned int mipLevelCount)
+{
+	GPUUploadQueue::CancelUploads(this);
+
+	DeleteTextureHandle();
+
+	glGenTextures(1, &m_textureHandle);
+	GL_CHECK_ERROR();
+
+	m_dimensions = dimensions;
+	m_textureFormat = format;
+	m_mipLevelCount = (mipLevelCount > 0 ? mipLevelCount : 1);
+	m_isUsingMipMaps = (m_mipLevelCount > 1);
+
+	GLStateCache::SetActiveTextureUnit(0);
+	GLStateCache::BindTexture(0, GL_TEXTURE_2D, m_textureHandle);
+
+	glTexStorage2D(GL_TEXTURE_2D, m_mipLevelCount, ToGLInternalFormat(m_textureFormat), m_dimensions.x, m_dimensions.y);
+	GL_CHECK_ERROR();
+
+	GLStateCache::BindTexture(0, GL_TEXTURE_2D, NULL);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies the texels over the region of the mip level, they must be in the texture's format
+//
+void Texture::UpdateTexels(unsigned int mipLevel, const IntVector2& offset, const IntVector2& dimensions, const void* texelData)
+{
+	GLStateCache::SetActiveTextureUnit(0);
+	GLStateCache::BindTexture(0, GL_TEXTURE_2D, m_textureHandle);
+
+	glTexSubImage2D(GL_TEXTURE_2D, mipLevel, offset.x, offset.y, dimensions.x, dimensions.y, ToGLChannel(m_textureFormat), ToGLPixelLayout(m_textureFormat), texelData);
+	GL_CHECK_ERROR();
+
+	GLStateCache::BindTexture(0, GL_TEXTURE_2D, NULL);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the dimensions of the texture
 //
@@ -189,6 +320,15 @@ IntVector2 Texture::GetDimensions() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the texel format of this texture
+//
+TextureFormat Texture::GetFormat() const
+{
+	return m_textureFormat;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns the GPU handle for this texture
 //
@@ -207,6 +347,34 @@ TextureType Texture::GetTextureType() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns roughly how much video memory the texture takes, summed over its mip levels
+//
+size_t Texture::GetGPUByteCount() const
+{
+	size_t byteCount = 0;
+	IntVector2 levelDimensions = m_dimensions;
+
+	for (unsigned int levelIndex = 0; levelIndex < m_mipLevelCount; ++levelIndex)
+	{
+		if (IsCompressedFormat(m_textureFormat))
+		{
+			size_t blockCount = (size_t) ((levelDimensions.x + 3) / 4) * (size_t) ((levelDimensions.y + 3) / 4);
+			byteCount += blockCount * GetCompressedBlockByteCount(m_textureFormat);
+		}
+		else
+		{
+			byteCount += (size_t) levelDimensions.x * (size_t) levelDimensions.y * GetTexelByteCount(m_textureFormat);
+		}
+
+		levelDimensions.x = MaxInt(levelDimensions.x / 2, 1);
+		levelDimensions.y = MaxInt(levelDimensions.y / 2, 1);
+	}
+
+	return byteCount;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Creates a target object on the GPU, full of garbage data, used as an intermediate render target
 //
@@ -219,8 +387,8 @@ bool Texture::CreateRenderTarget(unsigned int width, unsigned int height, Textur
 	}
 
 	// Copy the texture - first, get use to be using texture unit 0 for this;
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, m_textureHandle);  
+	GLStateCache::SetActiveTextureUnit(0);
+	GLStateCache::BindTexture(0, GL_TEXTURE_2D, m_textureHandle);
 	GL_CHECK_ERROR();
 
 	// Create the GPU-side buffer
@@ -233,11 +401,12 @@ bool Texture::CreateRenderTarget(unsigned int width, unsigned int height, Textur
 	GL_CHECK_ERROR(); 
 
 	// cleanup after myself; 
-	glBindTexture( GL_TEXTURE_2D, NULL );
+	GLStateCache::BindTexture(0, GL_TEXTURE_2D, NULL);
 
 	// Set members
 	m_dimensions = IntVector2((int)width, (int)height);  
 	m_textureFormat = format; 
+	m_mipLevelCount = 1;
 
 	return true; 
 }
@@ -284,6 +453,160 @@ bool Texture::CopyTexture(Texture* source, Texture* destination)
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns true if textures of the format can be created and sampled
+// RGTC and BPTC are core in 4.3, S3TC is an extension drivers are free to leave out
+//
+bool Texture::IsFormatSupported(TextureFormat format)
+{
+	if (format != TEXTURE_FORMAT_BC1 && format != TEXTURE_FORMAT_BC3)
+	{
+		return true;
+	}
+
+	static bool s_hasQueriedFormats = false;
+	static std::vector<GLint> s_compressedFormats;
+
+	if (!s_hasQueriedFormats)
+	{
+		GLint formatCount = 0;
+		glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &formatCount);
+
+		if (formatCount > 0)
+		{
+			s_compressedFormats.resize(formatCount);
+			glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, s_compressedFormats.data());
+		}
+
+		s_hasQueriedFormats = true;
+	}
+
+	GLint glFormat = (GLint) ToGLInternalFormat(format);
+	for (GLint supportedFormat : s_compressedFormats)
+	{
+		if (supportedFormat == glFormat)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the driver has bindless textures
+//
+bool Texture::IsBindlessSupported()
+{
+	return (glGetTextureSamplerHandleARB != nullptr && glMakeTextureHandleResidentARB != nullptr && glMakeTextureHandleNonResidentARB != nullptr);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the bindless handle for sampling the texture with the sampler, made on the first call and resident
+// until the texture's storage is replaced or deleted; 0 if bindless isn't supported
+// The texture's storage is immutable once a handle is made, so this should be called after it's created
+//
+uint64_t Texture::GetBindlessHandle(const Sampler* sampler) const
+{
+	if (!IsBindlessSupported() || m_textureHandle == NULL || sampler == nullptr)
+	{
+		return 0;
+	}
+
+	unsigned int samplerHandle = sampler->GetHandle();
+
+	for (int handleIndex = 0; handleIndex < (int) m_bindlessHandles.size(); ++handleIndex)
+	{
+		if (m_bindlessHandles[handleIndex].samplerHandle == samplerHandle)
+		{
+			return m_bindlessHandles[handleIndex].handle;
+		}
+	}
+
+	GLuint64 handle = glGetTextureSamplerHandleARB(m_textureHandle, samplerHandle);
+	GL_CHECK_ERROR();
+
+	if (handle == 0)
+	{
+		return 0;
+	}
+
+	glMakeTextureHandleResidentARB(handle);
+	GL_CHECK_ERROR();
+
+	BindlessHandle_t bindlessHandle;
+	bindlessHandle.samplerHandle = samplerHandle;
+	bindlessHandle.handle = handle;
+	m_bindlessHandles.push_back(bindlessHandle);
+
+	return handle;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Makes the handle for sampling with the sampler non resident, if the texture has one
+//
+void Texture::ReleaseBindlessHandle(const Sampler* sampler) const
+{
+	unsigned int samplerHandle = sampler->GetHandle();
+
+	for (int handleIndex = 0; handleIndex < (int) m_bindlessHandles.size(); ++handleIndex)
+	{
+		if (m_bindlessHandles[handleIndex].samplerHandle == samplerHandle)
+		{
+			glMakeTextureHandleNonResidentARB(m_bindlessHandles[handleIndex].handle);
+			m_bindlessHandles.erase(m_bindlessHandles.begin() + handleIndex);
+			return;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Makes the bindless handles non resident, and deletes the texture's storage if it has any
+// The handles are gone with the storage, so they're taken out of any bindless tables first
+//
+void Texture::DeleteTextureHandle()
+{
+	if (m_bindlessHandles.size() > 0)
+	{
+		BindlessTextureTable::OnTextureDestroyed(this);
+	}
+
+	for (int handleIndex = 0; handleIndex < (int) m_bindlessHandles.size(); ++handleIndex)
+	{
+		glMakeTextureHandleNonResidentARB(m_bindlessHandles[handleIndex].handle);
+	}
+
+	m_bindlessHandles.clear();
+
+	if (m_textureHandle != NULL)
+	{
+		glDeleteTextures(1, &m_textureHandle);
+		GLStateCache::OnTextureDeleted(m_textureHandle);
+		m_textureHandle = NULL;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Deletes the texture's storage and takes over the given one, which must be a 2D texture
+//
+void Texture::TakeUploadedTexture(unsigned int textureHandle, const IntVector2& dimensions, TextureFormat format, unsigned int mipLevelCount)
+{
+	DeleteTextureHandle();
+
+	m_textureHandle = textureHandle;
+	m_dimensions = dimensions;
+	m_textureFormat = format;
+	m_textureType = TEXTURE_TYPE_2D;
+	m_isUsingMipMaps = (mipLevelCount > 1);
+	m_mipLevelCount = mipLevelCount;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Determines the max number of mip levels that can be used by this function
 //
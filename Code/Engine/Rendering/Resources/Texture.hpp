@@ -8,15 +8,21 @@
 /************************************************************************/
 #pragma once
 #include <map>
+#include <vector>
 #include <string>
+#include <stdint.h>
 #include "Engine/Math/IntVector2.hpp"
 #include "Engine/Rendering/OpenGL/glTypes.hpp"
 
 class Image;
+class Sampler;
+class CompressedImage;
 
 //---------------------------------------------------------------------------
 class Texture
 {
+	friend class GPUUploadQueue;
+
 public:
 	//-----Public Methods-----
 
@@ -27,12 +33,27 @@ public:
 	virtual bool CreateFromFile(const std::string& filename, bool useMipMaps = false);
 	virtual void CreateFromImage(const Image* image, bool useMipMaps = false);
 	virtual void CreateFromRawData(const IntVector2& dimensions, unsigned int numComponents, const unsigned char* imageData, bool useMipMaps);
+
+	// Uploads the stored mip chain as is, returns false if the GPU can't sample the format
+	bool CreateFromCompressedImage(const CompressedImage* image);
 	
 	void InitializeAsImageTexture(const IntVector2& dimensions);
 
+	// Allocates uninitialized storage to be filled region by region, i.e. for caches written over time
+	void CreateEmpty(const IntVector2& dimensions, TextureFormat format, unsigned int mipLevelCount);
+	void UpdateTexels(unsigned int mipLevel, const IntVector2& offset, const IntVector2& dimensions, const void* texelData);
+
 	IntVector2		GetDimensions() const;
+	TextureFormat	GetFormat() const;
 	unsigned int	GetHandle() const;
 	TextureType		GetTextureType() const;
+	virtual size_t	GetGPUByteCount() const;
+
+	// Bindless (ARB_bindless_texture) - the handle can be put in a buffer and sampled without binding the texture
+	// Main thread only; check IsBindlessSupported() first, handles are 0 without it
+	uint64_t		GetBindlessHandle(const Sampler* sampler) const;
+	void			ReleaseBindlessHandle(const Sampler* sampler) const;		// For samplers being destroyed
+	static bool		IsBindlessSupported();
 
 	// Render target related
 	bool CreateRenderTarget(unsigned int width, unsigned int height, TextureFormat format);
@@ -40,6 +61,32 @@ public:
 	// Copying from one texture to another on the gpu
 	static bool CopyTexture(Texture* source, Texture* destination);
 
+	// Main thread only, queries the context the first time it's called
+	static bool IsFormatSupported(TextureFormat format);
+
+
+private:
+	//-----Private Methods-----
+
+	// For the GPUUploadQueue - replaces the texture's storage with the one an upload filled
+	void TakeUploadedTexture(unsigned int textureHandle, const IntVector2& dimensions, TextureFormat format, unsigned int mipLevelCount);
+
+
+protected:
+	//-----Protected Methods-----
+
+	void DeleteTextureHandle();
+
+
+protected:
+	//-----Protected Types-----
+
+	struct BindlessHandle_t
+	{
+		unsigned int	samplerHandle = 0;
+		uint64_t		handle = 0;
+	};
+
 
 protected:
 	//-----Protected Data-----
@@ -50,5 +97,8 @@ protected:
 	TextureType			m_textureType;
 
 	bool				m_isUsingMipMaps;
+	unsigned int		m_mipLevelCount;
+
+	mutable std::vector<BindlessHandle_t> m_bindlessHandles;	// One per sampler it's been sampled by
 
 };
@@ -0,0 +1,180 @@
+/************************************************************************/
+/* File: TextureArray.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the TextureArray class
+/************************************************************************/
+#include "Engine/Core/Image.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Assets/AssetDB.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include "Engine/Rendering/OpenGL/GLStateCache.hpp"
+#include "Engine/Rendering/Buffers/GPUUploadQueue.hpp"
+#include "Engine/Rendering/Resources/TextureArray.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - just sets the type enum
+//
+TextureArray::TextureArray()
+{
+	m_textureType = TEXTURE_TYPE_2D_ARRAY;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+TextureArray::~TextureArray()
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Loads the image from file as a one layer array
+//
+bool TextureArray::CreateFromFile(const std::string& filename, bool useMipMaps /*= false*/)
+{
+	Image* loadedImage = AssetDB::CreateOrGetImage(filename);
+
+	if (loadedImage == nullptr)
+	{
+		return false;
+	}
+
+	if (!loadedImage->IsFlippedForTextures())
+	{
+		loadedImage->FlipVertical();
+	}
+
+	CreateFromImage(loadedImage, useMipMaps);
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Creates a one layer array from the image
+//
+void TextureArray::CreateFromImage(const Image* image, bool useMipMaps /*= false*/)
+{
+	std::vector<const Image*> images;
+	images.push_back(image);
+
+	CreateFromImages(images, useMipMaps);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Allocates a layer for each image and copies them in, returns false if they don't all match
+//
+bool TextureArray::CreateFromImages(const std::vector<const Image*>& images, bool useMipMaps /*= false*/)
+{
+	if (images.size() == 0)
+	{
+		return false;
+	}
+
+	IntVector2 dimensions = images[0]->GetTexelDimensions();
+	int numComponents = images[0]->GetNumComponentsPerTexel();
+
+	for (int imageIndex = 1; imageIndex < (int) images.size(); ++imageIndex)
+	{
+		if (images[imageIndex]->GetTexelDimensions() != dimensions || images[imageIndex]->GetNumComponentsPerTexel() != numComponents)
+		{
+			LogTaggedPrintf("ASSETS", "Error: TextureArray layer %i doesn't match the dimensions or format of the first layer", imageIndex);
+			return false;
+		}
+	}
+
+	GPUUploadQueue::CancelUploads(this);
+
+	DeleteTextureHandle();
+
+	glGenTextures(1, &m_textureHandle);
+	GL_CHECK_ERROR();
+
+	m_dimensions = dimensions;
+	m_textureFormat = static_cast<TextureFormat>(numComponents - 1);
+	m_layerCount = (int) images.size();
+	m_isUsingMipMaps = useMipMaps;
+	m_mipLevelCount = 1;
+
+	if (useMipMaps)
+	{
+		m_mipLevelCount = (unsigned int) MaxInt(Ceiling(Log2((float) MaxInt(dimensions.x, dimensions.y))), 1);
+	}
+
+	GLStateCache::SetActiveTextureUnit(0);
+	GLStateCache::BindTexture(0, GL_TEXTURE_2D_ARRAY, m_textureHandle);
+
+	glTexStorage3D(GL_TEXTURE_2D_ARRAY, m_mipLevelCount, ToGLInternalFormat(m_textureFormat), m_dimensions.x, m_dimensions.y, m_layerCount);
+	GL_CHECK_ERROR();
+
+	for (int layerIndex = 0; layerIndex < m_layerCount; ++layerIndex)
+	{
+		glTexSubImage3D(GL_TEXTURE_2D_ARRAY,
+			0,										// Mip level
+			0, 0, layerIndex,						// Offset, z is the layer
+			m_dimensions.x, m_dimensions.y, 1,		// One layer at a time
+			ToGLChannel(m_textureFormat),
+			ToGLPixelLayout(m_textureFormat),
+			images[layerIndex]->GetImageData());
+	}
+
+	GL_CHECK_ERROR();
+
+	if (useMipMaps)
+	{
+		glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+		GL_CHECK_ERROR();
+	}
+
+	GLStateCache::BindTexture(0, GL_TEXTURE_2D_ARRAY, NULL);
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies the image over the given layer, regenerating the mips if it has them
+//
+void TextureArray::SetLayer(int layerIndex, const Image* image)
+{
+	ASSERT_OR_DIE(layerIndex >= 0 && layerIndex < m_layerCount, Stringf("Error: TextureArray::SetLayer() given layer %i of %i", layerIndex, m_layerCount));
+	ASSERT_OR_DIE(image->GetTexelDimensions() == m_dimensions && (image->GetNumComponentsPerTexel() - 1) == (int) m_textureFormat, "Error: TextureArray::SetLayer() given an image that doesn't match the array");
+
+	GLStateCache::SetActiveTextureUnit(0);
+	GLStateCache::BindTexture(0, GL_TEXTURE_2D_ARRAY, m_textureHandle);
+
+	glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layerIndex, m_dimensions.x, m_dimensions.y, 1, ToGLChannel(m_textureFormat), ToGLPixelLayout(m_textureFormat), image->GetImageData());
+	GL_CHECK_ERROR();
+
+	if (m_isUsingMipMaps)
+	{
+		glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+		GL_CHECK_ERROR();
+	}
+
+	GLStateCache::BindTexture(0, GL_TEXTURE_2D_ARRAY, NULL);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of layers in the array
+//
+int TextureArray::GetLayerCount() const
+{
+	return m_layerCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns roughly how much video memory the array takes, every layer has the same mip chain
+//
+size_t TextureArray::GetGPUByteCount() const
+{
+	return Texture::GetGPUByteCount() * (size_t) m_layerCount;
+}
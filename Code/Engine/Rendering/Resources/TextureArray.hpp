@@ -0,0 +1,42 @@
+/************************************************************************/
+/* File: TextureArray.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Class to represent a 2D array texture on the GPU - many
+/*				same sized layers sampled through one bind
+/************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include "Engine/Rendering/Resources/Texture.hpp"
+
+class Image;
+
+class TextureArray : public Texture
+{
+public:
+	//-----Public Methods-----
+
+	TextureArray();
+	~TextureArray();
+
+	// Single images become a one layer array
+	virtual bool CreateFromFile(const std::string& filename, bool useMipMaps = false) override;
+	virtual void CreateFromImage(const Image* image, bool useMipMaps = false) override;
+
+	// Every image must have the same dimensions and components, and be flipped for textures
+	bool			CreateFromImages(const std::vector<const Image*>& images, bool useMipMaps = false);
+
+	// Overwrites one layer, the image must match the array's dimensions and format
+	void			SetLayer(int layerIndex, const Image* image);
+
+	int				GetLayerCount() const;
+	virtual size_t	GetGPUByteCount() const override;
+
+
+private:
+	//-----Private Data-----
+
+	int m_layerCount = 0;
+
+};
@@ -0,0 +1,273 @@
+/************************************************************************/
+/* File: TextureAtlas.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the TextureAtlas class
+/************************************************************************/
+#include <string.h>
+#include <algorithm>
+#include "Engine/Core/Image.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/RectanglePacker.hpp"
+#include "Engine/Rendering/Resources/Texture.hpp"
+#include "Engine/Rendering/Resources/TextureAtlas.hpp"
+
+// Atlases are always RGBA, whatever the images are
+#define ATLAS_COMPONENTS_PER_TEXEL (4)
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+TextureAtlas::TextureAtlas()
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+TextureAtlas::~TextureAtlas()
+{
+	delete m_texture;
+	m_texture = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the image to be packed on the next Build()
+//
+void TextureAtlas::AddImage(const std::string& name, const Image* image)
+{
+	ASSERT_OR_DIE(image != nullptr, Stringf("Error: TextureAtlas::AddImage() passed a null image for \"%s\"", name.c_str()));
+
+	AtlasImage_t atlasImage;
+	atlasImage.name = name;
+	atlasImage.image = image;
+	atlasImage.position = IntVector2(0, 0);
+
+	m_images.push_back(atlasImage);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Packs the images tallest first, growing the texture a power of two at a time until they fit,
+// then copies them into it and uploads it
+//
+bool TextureAtlas::Build(int maxDimension /*= 4096*/, int padding /*= 1*/, bool useMipMaps /*= false*/)
+{
+	delete m_texture;
+	m_texture = nullptr;
+	m_uvsByName.clear();
+	m_dimensions = IntVector2(0, 0);
+
+	if (m_images.size() == 0)
+	{
+		return false;
+	}
+
+	std::vector<int> packOrder;
+	int totalArea = 0;
+	IntVector2 largestSize = IntVector2(0, 0);
+
+	for (int imageIndex = 0; imageIndex < (int) m_images.size(); ++imageIndex)
+	{
+		IntVector2 paddedSize = m_images[imageIndex].image->GetTexelDimensions() + IntVector2(2 * padding, 2 * padding);
+
+		totalArea += paddedSize.x * paddedSize.y;
+		largestSize.x = MaxInt(largestSize.x, paddedSize.x);
+		largestSize.y = MaxInt(largestSize.y, paddedSize.y);
+
+		packOrder.push_back(imageIndex);
+	}
+
+	if (largestSize.x > maxDimension || largestSize.y > maxDimension)
+	{
+		LogTaggedPrintf("ASSETS", "Error: TextureAtlas has an image larger than its max of %i texels a side", maxDimension);
+		return false;
+	}
+
+	std::sort(packOrder.begin(), packOrder.end(), [this](int a, int b)
+	{
+		IntVector2 aSize = m_images[a].image->GetTexelDimensions();
+		IntVector2 bSize = m_images[b].image->GetTexelDimensions();
+
+		return (aSize.y != bSize.y ? aSize.y > bSize.y : aSize.x > bSize.x);
+	});
+
+	// Start at the smallest power of two square that could hold them all
+	int side = 1;
+	while ((side * side < totalArea || side < largestSize.x || side < largestSize.y) && side < maxDimension)
+	{
+		side *= 2;
+	}
+
+	IntVector2 dimensions = IntVector2(side, side);
+
+	while (!PackImages(packOrder, dimensions, padding))
+	{
+		// Grow the shorter side, until neither can grow
+		if (dimensions.x <= dimensions.y && dimensions.x < maxDimension)
+		{
+			dimensions.x *= 2;
+		}
+		else if (dimensions.y < maxDimension)
+		{
+			dimensions.y *= 2;
+		}
+		else if (dimensions.x < maxDimension)
+		{
+			dimensions.x *= 2;
+		}
+		else
+		{
+			LogTaggedPrintf("ASSETS", "Error: TextureAtlas couldn't fit %i images into %ix%i", (int) m_images.size(), maxDimension, maxDimension);
+			return false;
+		}
+	}
+
+	m_dimensions = dimensions;
+
+	// Copy the images in, everything else stays clear
+	std::vector<unsigned char> atlasTexels((size_t) dimensions.x * (size_t) dimensions.y * ATLAS_COMPONENTS_PER_TEXEL, 0);
+
+	for (int imageIndex = 0; imageIndex < (int) m_images.size(); ++imageIndex)
+	{
+		const AtlasImage_t& atlasImage = m_images[imageIndex];
+		CopyImageToAtlas(atlasImage, atlasTexels);
+
+		IntVector2 size = atlasImage.image->GetTexelDimensions();
+		Vector2 uvMins = Vector2((float) atlasImage.position.x / (float) dimensions.x, (float) atlasImage.position.y / (float) dimensions.y);
+		Vector2 uvMaxs = Vector2((float) (atlasImage.position.x + size.x) / (float) dimensions.x, (float) (atlasImage.position.y + size.y) / (float) dimensions.y);
+
+		m_uvsByName[atlasImage.name] = AABB2(uvMins, uvMaxs);
+	}
+
+	m_texture = new Texture();
+	m_texture->CreateFromRawData(dimensions, ATLAS_COMPONENTS_PER_TEXEL, atlasTexels.data(), useMipMaps);
+
+	LogTaggedPrintf("ASSETS", "Built a %ix%i texture atlas of %i images", dimensions.x, dimensions.y, (int) m_images.size());
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the atlas' texture, nullptr until it's built
+//
+Texture* TextureAtlas::GetTexture() const
+{
+	return m_texture;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the texel dimensions of the built atlas
+//
+IntVector2 TextureAtlas::GetDimensions() const
+{
+	return m_dimensions;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of images added
+//
+int TextureAtlas::GetImageCount() const
+{
+	return (int) m_images.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets out_uvs to the UVs of the named image in the atlas, returning false if there isn't one
+//
+bool TextureAtlas::GetUVs(const std::string& name, AABB2& out_uvs) const
+{
+	std::map<std::string, AABB2>::const_iterator itr = m_uvsByName.find(name);
+
+	if (itr == m_uvsByName.end())
+	{
+		return false;
+	}
+
+	out_uvs = itr->second;
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the UVs of the named image in the atlas, or the whole texture if there isn't one
+//
+AABB2 TextureAtlas::GetUVs(const std::string& name) const
+{
+	AABB2 uvs = AABB2::UNIT_SQUARE_OFFCENTER;
+	GetUVs(name, uvs);
+
+	return uvs;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Packs every image with its padding into the dimensions, setting their positions
+// Returns false if they don't all fit
+//
+bool TextureAtlas::PackImages(const std::vector<int>& packOrder, const IntVector2& dimensions, int padding)
+{
+	RectanglePacker packer(dimensions);
+
+	for (int orderIndex = 0; orderIndex < (int) packOrder.size(); ++orderIndex)
+	{
+		AtlasImage_t& atlasImage = m_images[packOrder[orderIndex]];
+		IntVector2 paddedSize = atlasImage.image->GetTexelDimensions() + IntVector2(2 * padding, 2 * padding);
+
+		IntVector2 packedPosition;
+		if (!packer.Pack(paddedSize, packedPosition))
+		{
+			return false;
+		}
+
+		atlasImage.position = packedPosition + IntVector2(padding, padding);
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies the image's texels into the atlas' at its position, bottom row first as textures expect
+//
+void TextureAtlas::CopyImageToAtlas(const AtlasImage_t& atlasImage, std::vector<unsigned char>& atlasTexels) const
+{
+	const Image* image = atlasImage.image;
+	IntVector2 size = image->GetTexelDimensions();
+
+	int atlasRowBytes = m_dimensions.x * ATLAS_COMPONENTS_PER_TEXEL;
+	bool isBottomRowFirst = image->IsFlippedForTextures();
+
+	for (int rowIndex = 0; rowIndex < size.y; ++rowIndex)
+	{
+		// Row counted from the bottom of the image
+		int sourceRow = (isBottomRowFirst ? rowIndex : size.y - 1 - rowIndex);
+		unsigned char* destination = &atlasTexels[(size_t) (atlasImage.position.y + rowIndex) * atlasRowBytes + (size_t) atlasImage.position.x * ATLAS_COMPONENTS_PER_TEXEL];
+
+		if (image->GetNumComponentsPerTexel() == ATLAS_COMPONENTS_PER_TEXEL)
+		{
+			const unsigned char* source = image->GetImageData() + (size_t) sourceRow * size.x * ATLAS_COMPONENTS_PER_TEXEL;
+			memcpy(destination, source, (size_t) size.x * ATLAS_COMPONENTS_PER_TEXEL);
+			continue;
+		}
+
+		for (int columnIndex = 0; columnIndex < size.x; ++columnIndex)
+		{
+			Rgba color = image->GetTexelColor(columnIndex, sourceRow);
+
+			destination[columnIndex * ATLAS_COMPONENTS_PER_TEXEL + 0] = color.r;
+			destination[columnIndex * ATLAS_COMPONENTS_PER_TEXEL + 1] = color.g;
+			destination[columnIndex * ATLAS_COMPONENTS_PER_TEXEL + 2] = color.b;
+			destination[columnIndex * ATLAS_COMPONENTS_PER_TEXEL + 3] = color.a;
+		}
+	}
+}
@@ -0,0 +1,69 @@
+/************************************************************************/
+/* File: TextureAtlas.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Class to pack many small images into one texture, so
+/*				draws using any of them share a single texture bind
+/************************************************************************/
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/IntVector2.hpp"
+
+class Image;
+class Texture;
+
+class TextureAtlas
+{
+public:
+	//-----Public Methods-----
+
+	TextureAtlas();
+	~TextureAtlas();
+	TextureAtlas(const TextureAtlas& copy) = delete;
+
+	// Images are only read during Build(), so must live until then
+	void		AddImage(const std::string& name, const Image* image);
+
+	// Packs the images added into the smallest power of two texture that holds them, up to maxDimension a side
+	// Padding is left empty around each image so filtering doesn't bleed between them
+	// Returns false if they don't all fit, leaving the atlas without a texture
+	bool		Build(int maxDimension = 4096, int padding = 1, bool useMipMaps = false);
+
+	Texture*	GetTexture() const;
+	IntVector2	GetDimensions() const;
+	int			GetImageCount() const;
+
+	bool		GetUVs(const std::string& name, AABB2& out_uvs) const;
+	AABB2		GetUVs(const std::string& name) const;		// Whole texture if the name was never added
+
+
+private:
+	//-----Private Types-----
+
+	struct AtlasImage_t
+	{
+		std::string		name;
+		const Image*	image = nullptr;
+		IntVector2		position;			// Texel offset of the image's bottom left, once built
+	};
+
+
+private:
+	//-----Private Methods-----
+
+	bool		PackImages(const std::vector<int>& packOrder, const IntVector2& dimensions, int padding);
+	void		CopyImageToAtlas(const AtlasImage_t& atlasImage, std::vector<unsigned char>& atlasTexels) const;
+
+
+private:
+	//-----Private Data-----
+
+	std::vector<AtlasImage_t>	m_images;
+	std::map<std::string, AABB2> m_uvsByName;
+	Texture*					m_texture = nullptr;
+	IntVector2					m_dimensions = IntVector2(0, 0);
+
+};
@@ -8,6 +8,7 @@
 #include "Engine/Assets/AssetDB.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include "Engine/Rendering/OpenGL/GLStateCache.hpp"
 #include "Engine/Rendering/Resources/TextureCube.hpp"
 
 // Texture Data
@@ -87,7 +88,8 @@ void TextureCube::CreateFromImage(const Image* image, bool useMipMaps /*= false*
 
 	GLenum internalFormat = ToGLInternalFormat(m_textureFormat);
 
-	glBindTexture(GL_TEXTURE_CUBE_MAP, m_textureHandle);
+	GLStateCache::SetActiveTextureUnit(0);
+	GLStateCache::BindTexture(0, GL_TEXTURE_CUBE_MAP, m_textureHandle);
 	glTexStorage2D(GL_TEXTURE_CUBE_MAP, 1, internalFormat, tileSize, tileSize); 
 	GL_CHECK_ERROR();
 
@@ -0,0 +1,863 @@
+/************************************************************************/
+/* File: VirtualTexture.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the VirtualTexture class
+/************************************************************************/
+#include <string.h>
+#include <thread>
+#include <algorithm>
+#include <functional>
+#include "Engine/Core/Image.hpp"
+#include "Engine/Math/Vector2.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/JobSystem/JobSystem.hpp"
+#include "Engine/Core/JobSystem/FunctionJob.hpp"
+#include "Engine/Rendering/Materials/Material.hpp"
+#include "Engine/Rendering/Resources/Sampler.hpp"
+#include "Engine/Rendering/Resources/Texture.hpp"
+#include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include "Engine/Rendering/Resources/VirtualTexture.hpp"
+
+#define VIRTUAL_TEXTURE_FILE_VERSION (1)
+#define VIRTUAL_TEXTURE_FEEDBACK_PHASES (16)		// A 4x4 pixel pattern, one of which writes feedback each frame
+
+// Start of a tile file, followed by the padded RGBA tiles of every level, finest level first and
+// bottom row first within each level
+struct VirtualTextureFileHeader_t
+{
+	char		magic[4];
+	uint32_t	version;
+	uint32_t	width;				// Level 0 texels
+	uint32_t	height;
+	uint32_t	tileSize;			// Texels a side, not counting the border
+	uint32_t	borderTexels;
+	uint32_t	mipCount;
+	uint32_t	pageCount;
+};
+
+// Must match virtualTextureUBO in ShaderSource::VIRTUAL_TEXTURE_GLSL (std140)
+struct VirtualTextureProperties_t
+{
+	Vector2 pageCounts;				// Level 0
+	Vector2 virtualDimensions;
+	Vector2 physicalDimensions;
+	float	tileSize;
+	float	borderTexels;
+	float	mipCount;
+	float	feedbackPhase;
+	float	padding[2];
+};
+
+static void GetLevelPageCounts(const IntVector2& dimensions, int tileSize, std::vector<IntVector2>& out_levelPageCounts);
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor
+//
+VirtualTexture::VirtualTexture()
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor
+//
+VirtualTexture::~VirtualTexture()
+{
+	Close();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Cooks the image into a tile file that Open() can stream from
+//
+bool VirtualTexture::CookTileFile(const Image* source, const std::string& outputPath, int tileSize /*= 128*/, int borderTexels /*= 4*/)
+{
+	ASSERT_OR_DIE(tileSize > 0 && borderTexels >= 0 && borderTexels < tileSize, Stringf("Error: VirtualTexture::CookTileFile() given tile size %i with border %i", tileSize, borderTexels));
+
+	// Tile size times a power of two, so every level is a whole number of tiles
+	IntVector2 sourceDimensions = source->GetTexelDimensions();
+	IntVector2 dimensions = IntVector2(tileSize, tileSize);
+
+	while (dimensions.x < sourceDimensions.x) { dimensions.x *= 2; }
+	while (dimensions.y < sourceDimensions.y) { dimensions.y *= 2; }
+
+	std::vector<IntVector2> levelPageCounts;
+	GetLevelPageCounts(dimensions, tileSize, levelPageCounts);
+
+	int pageCount = 0;
+	for (int mip = 0; mip < (int) levelPageCounts.size(); ++mip)
+	{
+		pageCount += levelPageCounts[mip].x * levelPageCounts[mip].y;
+	}
+
+	File file;
+	if (!file.Open(outputPath.c_str(), "wb"))
+	{
+		LogTaggedPrintf("ASSETS", "Error: VirtualTexture couldn't open \"%s\" to cook into", outputPath.c_str());
+		return false;
+	}
+
+	VirtualTextureFileHeader_t header;
+	memcpy(header.magic, "VTEX", 4);
+	header.version		= VIRTUAL_TEXTURE_FILE_VERSION;
+	header.width		= (uint32_t) dimensions.x;
+	header.height		= (uint32_t) dimensions.y;
+	header.tileSize		= (uint32_t) tileSize;
+	header.borderTexels = (uint32_t) borderTexels;
+	header.mipCount		= (uint32_t) levelPageCounts.size();
+	header.pageCount	= (uint32_t) pageCount;
+
+	file.Write((const char*) &header, sizeof(header));
+
+	// Level 0 in RGBA, bottom row first like the tiles are uploaded
+	Image* level = source->CreateResized(dimensions, IMAGE_FILTER_KAISER);
+	level->ConvertToRGBA();
+
+	if (!level->IsFlippedForTextures())
+	{
+		level->FlipVertical();
+	}
+
+	int paddedTileSize = tileSize + 2 * borderTexels;
+	std::vector<unsigned char> tileTexels((size_t) paddedTileSize * paddedTileSize * 4);
+
+	for (int mip = 0; mip < (int) levelPageCounts.size(); ++mip)
+	{
+		IntVector2 levelDimensions = level->GetTexelDimensions();
+		const unsigned char* levelTexels = level->GetImageData();
+
+		for (int pageY = 0; pageY < levelPageCounts[mip].y; ++pageY)
+		{
+			for (int pageX = 0; pageX < levelPageCounts[mip].x; ++pageX)
+			{
+				// Border texels come from the neighbours, clamped at the level's edges
+				for (int tileY = 0; tileY < paddedTileSize; ++tileY)
+				{
+					int levelY = ClampInt(pageY * tileSize - borderTexels + tileY, 0, levelDimensions.y - 1);
+
+					for (int tileX = 0; tileX < paddedTileSize; ++tileX)
+					{
+						int levelX = ClampInt(pageX * tileSize - borderTexels + tileX, 0, levelDimensions.x - 1);
+						memcpy(&tileTexels[((size_t) tileY * paddedTileSize + tileX) * 4], &levelTexels[((size_t) levelY * levelDimensions.x + levelX) * 4], 4);
+					}
+				}
+
+				file.Write((const char*) tileTexels.data(), tileTexels.size());
+			}
+		}
+
+		// Next level is half this one, but never smaller than a tile
+		if (mip + 1 < (int) levelPageCounts.size())
+		{
+			IntVector2 nextDimensions = IntVector2(levelPageCounts[mip + 1].x * tileSize, levelPageCounts[mip + 1].y * tileSize);
+			Image* nextLevel = level->CreateResized(nextDimensions, IMAGE_FILTER_BOX);
+
+			delete level;
+			level = nextLevel;
+		}
+	}
+
+	delete level;
+	file.Close();
+
+	LogTaggedPrintf("ASSETS", "Cooked \"%s\", %ix%i in %i tiles over %i levels", outputPath.c_str(), dimensions.x, dimensions.y, pageCount, (int) levelPageCounts.size());
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Opens the tile file, and creates the page table and physical cache for it
+//
+bool VirtualTexture::Open(const std::string& tileFilePath, int physicalTilesPerSide /*= 32*/)
+{
+	ASSERT_OR_DIE(physicalTilesPerSide >= 2 && physicalTilesPerSide <= 256, Stringf("Error: VirtualTexture::Open() given %i physical tiles a side, page table entries hold up to 256", physicalTilesPerSide));
+
+	Close();
+
+	if (!m_tileFile.OpenMapped(tileFilePath.c_str()))
+	{
+		LogTaggedPrintf("ASSETS", "Error: VirtualTexture couldn't open \"%s\"", tileFilePath.c_str());
+		return false;
+	}
+
+	VirtualTextureFileHeader_t header;
+	bool isValid = (m_tileFile.GetSize() >= sizeof(header));
+
+	if (isValid)
+	{
+		memcpy(&header, m_tileFile.GetData(), sizeof(header));
+		isValid = (memcmp(header.magic, "VTEX", 4) == 0 && header.version == VIRTUAL_TEXTURE_FILE_VERSION && header.tileSize > 0);
+	}
+
+	if (isValid)
+	{
+		m_virtualDimensions = IntVector2((int) header.width, (int) header.height);
+		m_tileSize = (int) header.tileSize;
+		m_borderTexels = (int) header.borderTexels;
+
+		GetLevelPageCounts(m_virtualDimensions, m_tileSize, m_levelPageCounts);
+
+		m_mipCount = (int) m_levelPageCounts.size();
+		m_pageCount = 0;
+
+		for (int mip = 0; mip < m_mipCount; ++mip)
+		{
+			m_levelPageOffsets.push_back(m_pageCount);
+			m_pageCount += m_levelPageCounts[mip].x * m_levelPageCounts[mip].y;
+		}
+
+		isValid = (m_mipCount == (int) header.mipCount && m_pageCount == (int) header.pageCount
+			&& m_tileFile.GetSize() >= sizeof(header) + (size_t) m_pageCount * GetTileByteCount());
+	}
+
+	if (!isValid)
+	{
+		LogTaggedPrintf("ASSETS", "Error: VirtualTexture \"%s\" isn't a tile file of version %i, or is truncated", tileFilePath.c_str(), VIRTUAL_TEXTURE_FILE_VERSION);
+		m_tileFile.Close();
+		m_levelPageCounts.clear();
+		m_levelPageOffsets.clear();
+		return false;
+	}
+
+	m_pageStates.assign(m_pageCount, PAGE_STATE_NOT_RESIDENT);
+	m_pageSlots.assign(m_pageCount, -1);
+	m_pageTableTexels.assign(m_pageCount, 0);
+
+	m_pageTable = new Texture();
+	m_pageTable->CreateEmpty(m_levelPageCounts[0], TEXTURE_FORMAT_RGBA8, m_mipCount);
+
+	int paddedTileSize = m_tileSize + 2 * m_borderTexels;
+	m_physicalTilesPerSide = physicalTilesPerSide;
+	m_physicalSlots.assign(physicalTilesPerSide * physicalTilesPerSide, PhysicalSlot_t());
+
+	m_physicalTexture = new Texture();
+	m_physicalTexture->CreateEmpty(IntVector2(paddedTileSize * physicalTilesPerSide, paddedTileSize * physicalTilesPerSide), TEXTURE_FORMAT_RGBA8, 1);
+
+	m_physicalSampler = new Sampler();
+	m_physicalSampler->Initialize(SAMPLER_FILTER_LINEAR, EDGE_SAMPLING_CLAMP_TO_EDGE);
+
+	for (int loadIndex = 0; loadIndex < VIRTUAL_TEXTURE_MAX_LOADS_IN_FLIGHT; ++loadIndex)
+	{
+		m_loads[loadIndex].texels.resize(GetTileByteCount());
+	}
+
+	// One bit per page
+	m_feedbackClearWords.assign((m_pageCount + 31) / 32, 0);
+
+	for (int bufferIndex = 0; bufferIndex < VIRTUAL_TEXTURE_FEEDBACK_BUFFER_COUNT; ++bufferIndex)
+	{
+		m_feedbackBuffers[bufferIndex].buffer.CopyToGPU(m_feedbackClearWords.size() * sizeof(uint32_t), m_feedbackClearWords.data());
+	}
+
+	// The coarsest tile is what everything falls back to, so it's loaded now and pinned
+	int rootPageIndex = m_pageCount - 1;
+	const char* rootTexels = m_tileFile.GetData() + sizeof(header) + (size_t) rootPageIndex * GetTileByteCount();
+
+	m_physicalTexture->UpdateTexels(0, GetSlotTexelOffset(0), IntVector2(paddedTileSize, paddedTileSize), rootTexels);
+	m_physicalSlots[0].pageIndex = rootPageIndex;
+	m_physicalSlots[0].lastUsedFrame = UINT64_MAX;
+	m_pageStates[rootPageIndex] = PAGE_STATE_RESIDENT;
+	m_pageSlots[rootPageIndex] = 0;
+	m_residentPageCount = 1;
+
+	RebuildPageTable();
+
+	m_frameIndex = 0;
+	m_latestFeedbackFrame = 0;
+	m_isOpen = true;
+
+	LogTaggedPrintf("ASSETS", "Opened virtual texture \"%s\", %ix%i with a %i tile cache", tileFilePath.c_str(), m_virtualDimensions.x, m_virtualDimensions.y, (int) m_physicalSlots.size());
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Frees the GPU resources and closes the tile file, once the loads reading it have finished
+//
+void VirtualTexture::Close()
+{
+	for (int loadIndex = 0; loadIndex < VIRTUAL_TEXTURE_MAX_LOADS_IN_FLIGHT; ++loadIndex)
+	{
+		TileLoad_t& load = m_loads[loadIndex];
+
+		if (load.pageIndex >= 0)
+		{
+			while (!load.isFinished.load())
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		load.pageIndex = -1;
+		load.slotIndex = -1;
+		load.isFinished = false;
+	}
+
+	m_loadsInFlightCount = 0;
+
+	for (int bufferIndex = 0; bufferIndex < VIRTUAL_TEXTURE_FEEDBACK_BUFFER_COUNT; ++bufferIndex)
+	{
+		if (m_feedbackBuffers[bufferIndex].fence != nullptr)
+		{
+			glDeleteSync(m_feedbackBuffers[bufferIndex].fence);
+			m_feedbackBuffers[bufferIndex].fence = nullptr;
+		}
+	}
+
+	delete m_pageTable;
+	m_pageTable = nullptr;
+
+	delete m_physicalTexture;
+	m_physicalTexture = nullptr;
+
+	delete m_physicalSampler;
+	m_physicalSampler = nullptr;
+
+	if (m_isOpen)
+	{
+		m_tileFile.Close();
+	}
+
+	m_levelPageCounts.clear();
+	m_levelPageOffsets.clear();
+	m_pageStates.clear();
+	m_pageSlots.clear();
+	m_requestedPages.clear();
+	m_pageTableTexels.clear();
+	m_physicalSlots.clear();
+	m_feedbackClearWords.clear();
+
+	m_pageCount = 0;
+	m_residentPageCount = 0;
+	m_isFeedbackBound = false;
+	m_isOpen = false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads back whatever feedback the GPU has finished, streams in the tiles it asked for, and binds
+// a cleared feedback buffer for this frame's draws
+//
+void VirtualTexture::Update()
+{
+	if (!m_isOpen)
+	{
+		return;
+	}
+
+	m_frameIndex++;
+
+	// The buffer about to be written must be read first, even if it means waiting on the GPU
+	int nextWriteIndex = (m_feedbackWriteIndex + 1) % VIRTUAL_TEXTURE_FEEDBACK_BUFFER_COUNT;
+	if (m_feedbackBuffers[nextWriteIndex].fence != nullptr)
+	{
+		glClientWaitSync(m_feedbackBuffers[nextWriteIndex].fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+		ReadFeedback(m_feedbackBuffers[nextWriteIndex]);
+	}
+
+	// Oldest first, the rest only if they're done
+	for (int bufferOffset = 1; bufferOffset <= VIRTUAL_TEXTURE_FEEDBACK_BUFFER_COUNT; ++bufferOffset)
+	{
+		FeedbackBuffer_t& feedback = m_feedbackBuffers[(nextWriteIndex + bufferOffset) % VIRTUAL_TEXTURE_FEEDBACK_BUFFER_COUNT];
+
+		if (feedback.fence != nullptr)
+		{
+			GLenum waitResult = glClientWaitSync(feedback.fence, 0, 0);
+
+			if (waitResult == GL_ALREADY_SIGNALED || waitResult == GL_CONDITION_SATISFIED)
+			{
+				ReadFeedback(feedback);
+			}
+		}
+	}
+
+	QueueRequestedLoads();
+	UploadFinishedLoads();
+
+	if (m_isPageTableDirty)
+	{
+		RebuildPageTable();
+	}
+
+	m_feedbackWriteIndex = nextWriteIndex;
+
+	FeedbackBuffer_t& writeFeedback = m_feedbackBuffers[m_feedbackWriteIndex];
+	writeFeedback.buffer.CopySubDataToGPU(m_feedbackClearWords.size() * sizeof(uint32_t), m_feedbackClearWords.data(), 0);
+	writeFeedback.buffer.Bind(VIRTUAL_TEXTURE_FEEDBACK_BINDING);
+	writeFeedback.frameWritten = m_frameIndex;
+
+	m_isFeedbackBound = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Fences the feedback written by this frame's draws, to be read back once the GPU is through them
+//
+void VirtualTexture::EndFrame()
+{
+	if (!m_isFeedbackBound)
+	{
+		return;
+	}
+
+	// The shader's atomic writes must land before the buffer is mapped
+	glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+
+	m_feedbackBuffers[m_feedbackWriteIndex].fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	m_isFeedbackBound = false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the page table, cache and constants on the material, called each frame as the constants
+// include which fragments write feedback
+//
+void VirtualTexture::ApplyToMaterial(Material* material) const
+{
+	if (!m_isOpen)
+	{
+		return;
+	}
+
+	material->SetTexture(VIRTUAL_TEXTURE_PAGE_TABLE_SLOT, m_pageTable);
+	material->SetTexture(VIRTUAL_TEXTURE_PHYSICAL_SLOT, m_physicalTexture);
+	material->SetSampler(VIRTUAL_TEXTURE_PHYSICAL_SLOT, m_physicalSampler);
+
+	IntVector2 physicalDimensions = m_physicalTexture->GetDimensions();
+
+	VirtualTextureProperties_t properties;
+	properties.pageCounts			= Vector2((float) m_levelPageCounts[0].x, (float) m_levelPageCounts[0].y);
+	properties.virtualDimensions	= Vector2((float) m_virtualDimensions.x, (float) m_virtualDimensions.y);
+	properties.physicalDimensions	= Vector2((float) physicalDimensions.x, (float) physicalDimensions.y);
+	properties.tileSize				= (float) m_tileSize;
+	properties.borderTexels			= (float) m_borderTexels;
+	properties.mipCount				= (float) m_mipCount;
+	properties.feedbackPhase		= (float) (m_frameIndex % VIRTUAL_TEXTURE_FEEDBACK_PHASES);
+	properties.padding[0]			= 0.f;
+	properties.padding[1]			= 0.f;
+
+	material->SetPropertyBlock("virtualTextureUBO", properties);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if a tile file is open
+//
+bool VirtualTexture::IsOpen() const
+{
+	return m_isOpen;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the texel dimensions of level 0
+//
+IntVector2 VirtualTexture::GetVirtualDimensions() const
+{
+	return m_virtualDimensions;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the texels a side of a tile, not counting its border
+//
+int VirtualTexture::GetTileSize() const
+{
+	return m_tileSize;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of levels in the tile file
+//
+int VirtualTexture::GetMipCount() const
+{
+	return m_mipCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of tiles over every level
+//
+int VirtualTexture::GetPageCount() const
+{
+	return m_pageCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of tiles in the cache
+//
+int VirtualTexture::GetResidentPageCount() const
+{
+	return m_residentPageCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of tiles the cache can hold
+//
+int VirtualTexture::GetPhysicalSlotCount() const
+{
+	return (int) m_physicalSlots.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of tiles being loaded or waiting to be uploaded
+//
+int VirtualTexture::GetLoadsInFlightCount() const
+{
+	return m_loadsInFlightCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Touches every page set in the finished feedback buffer, then frees the fence
+//
+void VirtualTexture::ReadFeedback(FeedbackBuffer_t& feedback)
+{
+	glDeleteSync(feedback.fence);
+	feedback.fence = nullptr;
+
+	const uint32_t* feedbackWords = (const uint32_t*) feedback.buffer.MapBufferData();
+
+	if (feedbackWords != nullptr)
+	{
+		for (int wordIndex = 0; wordIndex < (int) m_feedbackClearWords.size(); ++wordIndex)
+		{
+			uint32_t bits = feedbackWords[wordIndex];
+
+			while (bits != 0)
+			{
+				int bitIndex = 0;
+				while ((bits & (1u << bitIndex)) == 0)
+				{
+					bitIndex++;
+				}
+
+				int pageIndex = wordIndex * 32 + bitIndex;
+				if (pageIndex < m_pageCount)
+				{
+					TouchPage(pageIndex, feedback.frameWritten);
+				}
+
+				bits &= bits - 1;
+			}
+		}
+
+		if (feedback.frameWritten > m_latestFeedbackFrame)
+		{
+			m_latestFeedbackFrame = feedback.frameWritten;
+		}
+	}
+
+	feedback.buffer.UnmapBufferData();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Marks the page as needed on the frame, requesting it if it isn't resident, and keeps it and the
+// coarser tiles it falls back to from being evicted
+//
+void VirtualTexture::TouchPage(int pageIndex, uint64_t frame)
+{
+	if (m_pageStates[pageIndex] == PAGE_STATE_NOT_RESIDENT)
+	{
+		m_requestedPages.push_back(pageIndex);
+	}
+
+	for (int currIndex = pageIndex; currIndex >= 0; currIndex = GetParentPageIndex(currIndex))
+	{
+		int slotIndex = m_pageSlots[currIndex];
+
+		if (slotIndex >= 0 && m_physicalSlots[slotIndex].lastUsedFrame < frame)
+		{
+			m_physicalSlots[slotIndex].lastUsedFrame = frame;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Starts loads for the requested pages, coarsest first so the fallbacks improve a level at a time
+// Requests that don't get a load are dropped, the next feedback asks again if they're still needed
+//
+void VirtualTexture::QueueRequestedLoads()
+{
+	if (m_requestedPages.size() == 0)
+	{
+		return;
+	}
+
+	// Coarser levels come after finer ones in the page indices
+	std::sort(m_requestedPages.begin(), m_requestedPages.end(), std::greater<int>());
+	m_requestedPages.erase(std::unique(m_requestedPages.begin(), m_requestedPages.end()), m_requestedPages.end());
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	size_t tileByteCount = GetTileByteCount();
+	int loadIndex = 0;
+
+	for (int requestIndex = 0; requestIndex < (int) m_requestedPages.size(); ++requestIndex)
+	{
+		int pageIndex = m_requestedPages[requestIndex];
+
+		if (m_loadsInFlightCount == VIRTUAL_TEXTURE_MAX_LOADS_IN_FLIGHT)
+		{
+			break;
+		}
+
+		if (m_pageStates[pageIndex] != PAGE_STATE_NOT_RESIDENT)
+		{
+			continue;
+		}
+
+		int slotIndex = ClaimPhysicalSlot(m_latestFeedbackFrame);
+		if (slotIndex < 0)
+		{
+			// Everything cached is in view, a bigger cache is needed to go finer
+			break;
+		}
+
+		while (m_loads[loadIndex].pageIndex >= 0)
+		{
+			loadIndex++;
+		}
+
+		TileLoad_t* load = &m_loads[loadIndex];
+		load->pageIndex = pageIndex;
+		load->slotIndex = slotIndex;
+		load->isFinished = false;
+
+		m_pageStates[pageIndex] = PAGE_STATE_LOADING;
+		m_pageSlots[pageIndex] = slotIndex;
+		m_physicalSlots[slotIndex].pageIndex = pageIndex;
+		m_physicalSlots[slotIndex].lastUsedFrame = m_latestFeedbackFrame;
+		m_loadsInFlightCount++;
+
+		// Copying out of the mapping is what pages the tile in from disk
+		const char* tileTexels = m_tileFile.GetData() + sizeof(VirtualTextureFileHeader_t) + (size_t) pageIndex * tileByteCount;
+		auto copyTile = [load, tileTexels, tileByteCount]()
+		{
+			memcpy(load->texels.data(), tileTexels, tileByteCount);
+			load->isFinished = true;
+		};
+
+		if (jobSystem != nullptr)
+		{
+			jobSystem->QueueJob(new FunctionJob(copyTile, JOB_PRIORITY_BACKGROUND, WORKER_FLAGS_DISK));
+		}
+		else
+		{
+			copyTile();
+		}
+	}
+
+	m_requestedPages.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies finished tiles into their cache slots, up to the per frame limit
+//
+void VirtualTexture::UploadFinishedLoads()
+{
+	int paddedTileSize = m_tileSize + 2 * m_borderTexels;
+	int uploadCount = 0;
+
+	for (int loadIndex = 0; loadIndex < VIRTUAL_TEXTURE_MAX_LOADS_IN_FLIGHT && uploadCount < VIRTUAL_TEXTURE_MAX_UPLOADS_PER_FRAME; ++loadIndex)
+	{
+		TileLoad_t& load = m_loads[loadIndex];
+
+		if (load.pageIndex < 0 || !load.isFinished.load())
+		{
+			continue;
+		}
+
+		m_physicalTexture->UpdateTexels(0, GetSlotTexelOffset(load.slotIndex), IntVector2(paddedTileSize, paddedTileSize), load.texels.data());
+
+		m_pageStates[load.pageIndex] = PAGE_STATE_RESIDENT;
+		m_residentPageCount++;
+		m_isPageTableDirty = true;
+
+		load.pageIndex = -1;
+		load.slotIndex = -1;
+		load.isFinished = false;
+
+		m_loadsInFlightCount--;
+		uploadCount++;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns an empty slot, or evicts the least recently used tile that wasn't needed since the frame
+// Returns -1 if every tile is loading or still needed
+//
+int VirtualTexture::ClaimPhysicalSlot(uint64_t frameRequested)
+{
+	int bestSlotIndex = -1;
+
+	for (int slotIndex = 0; slotIndex < (int) m_physicalSlots.size(); ++slotIndex)
+	{
+		const PhysicalSlot_t& slot = m_physicalSlots[slotIndex];
+
+		if (slot.pageIndex < 0)
+		{
+			return slotIndex;
+		}
+
+		if (m_pageStates[slot.pageIndex] == PAGE_STATE_LOADING || slot.lastUsedFrame >= frameRequested)
+		{
+			continue;
+		}
+
+		if (bestSlotIndex == -1 || slot.lastUsedFrame < m_physicalSlots[bestSlotIndex].lastUsedFrame)
+		{
+			bestSlotIndex = slotIndex;
+		}
+	}
+
+	if (bestSlotIndex >= 0)
+	{
+		int evictedPageIndex = m_physicalSlots[bestSlotIndex].pageIndex;
+
+		m_pageStates[evictedPageIndex] = PAGE_STATE_NOT_RESIDENT;
+		m_pageSlots[evictedPageIndex] = -1;
+		m_physicalSlots[bestSlotIndex].pageIndex = -1;
+
+		m_residentPageCount--;
+		m_isPageTableDirty = true;
+	}
+
+	return bestSlotIndex;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Points every page at its own tile if it's resident or its parent's entry if not, coarsest level
+// first, then uploads every level
+//
+void VirtualTexture::RebuildPageTable()
+{
+	for (int mip = m_mipCount - 1; mip >= 0; --mip)
+	{
+		IntVector2 pageCounts = m_levelPageCounts[mip];
+		int levelOffset = m_levelPageOffsets[mip];
+
+		for (int pageY = 0; pageY < pageCounts.y; ++pageY)
+		{
+			for (int pageX = 0; pageX < pageCounts.x; ++pageX)
+			{
+				int pageIndex = levelOffset + pageY * pageCounts.x + pageX;
+
+				if (m_pageStates[pageIndex] == PAGE_STATE_RESIDENT)
+				{
+					int slotIndex = m_pageSlots[pageIndex];
+					uint32_t slotX = (uint32_t) (slotIndex % m_physicalTilesPerSide);
+					uint32_t slotY = (uint32_t) (slotIndex / m_physicalTilesPerSide);
+
+					// RGBA bytes - slot x, slot y, the level the tile is from, and 255
+					m_pageTableTexels[pageIndex] = slotX | (slotY << 8) | ((uint32_t) mip << 16) | (255u << 24);
+				}
+				else
+				{
+					// The coarsest page is always resident, so every other page has a parent
+					m_pageTableTexels[pageIndex] = m_pageTableTexels[GetParentPageIndex(pageIndex)];
+				}
+			}
+		}
+
+		m_pageTable->UpdateTexels(mip, IntVector2(0, 0), pageCounts, &m_pageTableTexels[levelOffset]);
+	}
+
+	m_isPageTableDirty = false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the index of the page over every level
+//
+int VirtualTexture::GetPageIndex(int mip, int pageX, int pageY) const
+{
+	return m_levelPageOffsets[mip] + pageY * m_levelPageCounts[mip].x + pageX;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the level and coords of the page
+//
+void VirtualTexture::GetPageCoords(int pageIndex, int& out_mip, int& out_pageX, int& out_pageY) const
+{
+	int mip = m_mipCount - 1;
+	while (mip > 0 && m_levelPageOffsets[mip] > pageIndex)
+	{
+		mip--;
+	}
+
+	int levelIndex = pageIndex - m_levelPageOffsets[mip];
+
+	out_mip = mip;
+	out_pageX = levelIndex % m_levelPageCounts[mip].x;
+	out_pageY = levelIndex / m_levelPageCounts[mip].x;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the page covering this one in the next coarser level, -1 for the coarsest page
+//
+int VirtualTexture::GetParentPageIndex(int pageIndex) const
+{
+	int mip, pageX, pageY;
+	GetPageCoords(pageIndex, mip, pageX, pageY);
+
+	if (mip == m_mipCount - 1)
+	{
+		return -1;
+	}
+
+	IntVector2 parentPageCounts = m_levelPageCounts[mip + 1];
+	return GetPageIndex(mip + 1, MinInt(pageX / 2, parentPageCounts.x - 1), MinInt(pageY / 2, parentPageCounts.y - 1));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the bottom left texel of the slot's padded tile in the physical texture
+//
+IntVector2 VirtualTexture::GetSlotTexelOffset(int slotIndex) const
+{
+	int paddedTileSize = m_tileSize + 2 * m_borderTexels;
+	return IntVector2((slotIndex % m_physicalTilesPerSide) * paddedTileSize, (slotIndex / m_physicalTilesPerSide) * paddedTileSize);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the size of a padded RGBA tile
+//
+size_t VirtualTexture::GetTileByteCount() const
+{
+	size_t paddedTileSize = (size_t) (m_tileSize + 2 * m_borderTexels);
+	return paddedTileSize * paddedTileSize * 4;
+}
+
+
+//- C FUNCTION ----------------------------------------------------------------------------------------------
+// Fills in the tile counts of each level, halving until a single tile, with no level under a tile a side
+//
+static void GetLevelPageCounts(const IntVector2& dimensions, int tileSize, std::vector<IntVector2>& out_levelPageCounts)
+{
+	out_levelPageCounts.clear();
+
+	IntVector2 pageCounts = IntVector2(MaxInt(dimensions.x / tileSize, 1), MaxInt(dimensions.y / tileSize, 1));
+	out_levelPageCounts.push_back(pageCounts);
+
+	while (pageCounts.x > 1 || pageCounts.y > 1)
+	{
+		pageCounts = IntVector2(MaxInt(pageCounts.x / 2, 1), MaxInt(pageCounts.y / 2, 1));
+		out_levelPageCounts.push_back(pageCounts);
+	}
+}
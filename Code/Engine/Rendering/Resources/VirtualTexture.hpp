@@ -0,0 +1,164 @@
+/************************************************************************/
+/* File: VirtualTexture.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Class to stream tiles of a huge texture (i.e. terrain)
+/*				into a fixed size cache as the screen needs them, so its
+/*				memory scales with resolution instead of the source size
+/************************************************************************/
+#pragma once
+#include <atomic>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "Engine/Core/File.hpp"
+#include "Engine/Math/IntVector2.hpp"
+#include "Engine/Rendering/Buffers/RenderBuffer.hpp"
+
+class Image;
+class Texture;
+class Sampler;
+class Material;
+
+// Shader side resources, must match ShaderSource::VIRTUAL_TEXTURE_GLSL
+#define VIRTUAL_TEXTURE_PAGE_TABLE_SLOT (6)
+#define VIRTUAL_TEXTURE_PHYSICAL_SLOT (7)
+#define VIRTUAL_TEXTURE_UNIFORM_BINDING (9)
+#define VIRTUAL_TEXTURE_FEEDBACK_BINDING (15)
+
+#define VIRTUAL_TEXTURE_FEEDBACK_BUFFER_COUNT (3)	// Read back a couple frames late, without stalling
+#define VIRTUAL_TEXTURE_MAX_LOADS_IN_FLIGHT (32)
+#define VIRTUAL_TEXTURE_MAX_UPLOADS_PER_FRAME (16)
+
+// How to use:
+//	- Offline (or once), CookTileFile() the source image into a tile file of every mip
+//	- Open() the tile file, and call Update() each frame before, and EndFrame() after, the draws sampling it
+//	- ApplyToMaterial() each frame, on materials whose shader includes ShaderSource::VIRTUAL_TEXTURE_GLSL
+//	  and samples with SampleVirtualTexture(uv)
+// The shader reports the tiles it wanted into a feedback buffer, which is read back a few frames later
+// to load the missing ones; until they arrive it samples the finest coarser tile that's resident
+
+class VirtualTexture
+{
+public:
+	//-----Public Methods-----
+
+	VirtualTexture();
+	~VirtualTexture();
+	VirtualTexture(const VirtualTexture& copy) = delete;
+
+	// Writes every mip of the image as padded RGBA tiles, resizing it to tileSize times a power of two first
+	// Border texels are copied from the neighbouring tiles so filtering across a tile's edge is seamless
+	static bool	CookTileFile(const Image* source, const std::string& outputPath, int tileSize = 128, int borderTexels = 4);
+
+	// The cache holds physicalTilesPerSide^2 tiles, its coarsest tile is loaded immediately and never evicted
+	bool		Open(const std::string& tileFilePath, int physicalTilesPerSide = 32);
+	void		Close();			// Waits on any tile loads still running
+
+	// Render thread only
+	void		Update();			// Reads back feedback, queues tile loads and uploads the finished ones
+	void		EndFrame();			// Fences the frame's feedback for reading back
+	void		ApplyToMaterial(Material* material) const;
+
+	bool		IsOpen() const;
+	IntVector2	GetVirtualDimensions() const;
+	int			GetTileSize() const;
+	int			GetMipCount() const;
+	int			GetPageCount() const;
+	int			GetResidentPageCount() const;
+	int			GetPhysicalSlotCount() const;
+	int			GetLoadsInFlightCount() const;
+
+
+private:
+	//-----Private Types-----
+
+	enum ePageState : uint8_t
+	{
+		PAGE_STATE_NOT_RESIDENT,
+		PAGE_STATE_LOADING,
+		PAGE_STATE_RESIDENT
+	};
+
+	struct PhysicalSlot_t
+	{
+		int			pageIndex = -1;
+		uint64_t	lastUsedFrame = 0;
+	};
+
+	// Filled by a disk job, uploaded on the render thread once it's finished
+	struct TileLoad_t
+	{
+		int							pageIndex = -1;
+		int							slotIndex = -1;
+		std::vector<unsigned char>	texels;
+		std::atomic<bool>			isFinished{ false };
+	};
+
+	struct FeedbackBuffer_t
+	{
+		RenderBuffer	buffer;
+		GLsync			fence = nullptr;
+		uint64_t		frameWritten = 0;
+	};
+
+
+private:
+	//-----Private Methods-----
+
+	void		ReadFeedback(FeedbackBuffer_t& feedback);
+	void		TouchPage(int pageIndex, uint64_t frame);
+	void		QueueRequestedLoads();
+	void		UploadFinishedLoads();
+	int			ClaimPhysicalSlot(uint64_t frameRequested);
+	void		RebuildPageTable();
+
+	int			GetPageIndex(int mip, int pageX, int pageY) const;
+	void		GetPageCoords(int pageIndex, int& out_mip, int& out_pageX, int& out_pageY) const;
+	int			GetParentPageIndex(int pageIndex) const;
+	IntVector2	GetSlotTexelOffset(int slotIndex) const;
+	size_t		GetTileByteCount() const;
+
+
+private:
+	//-----Private Data-----
+
+	bool						m_isOpen = false;
+	File						m_tileFile;			// Mapped, so the disk jobs can copy tiles out of it concurrently
+	IntVector2					m_virtualDimensions = IntVector2(0, 0);
+	int							m_tileSize = 0;
+	int							m_borderTexels = 0;
+	int							m_mipCount = 0;
+
+	// Pages of every level, finest first
+	int							m_pageCount = 0;
+	std::vector<IntVector2>		m_levelPageCounts;
+	std::vector<int>			m_levelPageOffsets;
+	std::vector<ePageState>		m_pageStates;
+	std::vector<int>			m_pageSlots;		// Physical slot of each resident or loading page, -1 otherwise
+	std::vector<int>			m_requestedPages;
+
+	// Page table texel per page, pointing at the finest resident tile covering it
+	Texture*					m_pageTable = nullptr;
+	std::vector<uint32_t>		m_pageTableTexels;
+	bool						m_isPageTableDirty = false;
+
+	// LRU cache of tiles
+	Texture*					m_physicalTexture = nullptr;
+	Sampler*					m_physicalSampler = nullptr;
+	int							m_physicalTilesPerSide = 0;
+	std::vector<PhysicalSlot_t>	m_physicalSlots;
+	int							m_residentPageCount = 0;
+
+	TileLoad_t					m_loads[VIRTUAL_TEXTURE_MAX_LOADS_IN_FLIGHT];
+	int							m_loadsInFlightCount = 0;
+
+	FeedbackBuffer_t			m_feedbackBuffers[VIRTUAL_TEXTURE_FEEDBACK_BUFFER_COUNT];
+	int							m_feedbackWriteIndex = 0;
+	bool						m_isFeedbackBound = false;
+	std::vector<uint32_t>		m_feedbackClearWords;
+	uint64_t					m_latestFeedbackFrame = 0;	// Tiles used since this frame aren't evicted
+
+	uint64_t					m_frameIndex = 0;
+
+};
@@ -6,6 +6,14 @@
 /************************************************************************/
 #include "Engine/Rendering/Shaders/ComputeShader.hpp"
 #include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include "Engine/Rendering/OpenGL/GLStateCache.hpp"
+#include "Engine/Rendering/Core/GPUProfiler.hpp"
+#include "Engine/Rendering/Buffers/RenderBuffer.hpp"
+#include "Engine/Rendering/Resources/Sampler.hpp"
+#include "Engine/Rendering/Resources/Texture.hpp"
+#include "Engine/Core/Time/ProfileCounters.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/Vector3.hpp"
 #include "Engine/Core/File.hpp"
 #include "Engine/Core/LogSystem.hpp"
 
@@ -15,6 +23,238 @@ static void FormatAndPrintShaderError(const std::string& errorLog, const std::st
 static void LogProgramError(GLuint program_id);
 
 
+//-----------------------------------------------------------------------------------------------
+// Removes all resources and uniforms from the table
+//
+void ComputeBindingTable::Clear()
+{
+	m_resources.clear();
+	m_uniforms.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the range of the buffer to be bound to the shader storage binding
+//
+void ComputeBindingTable::SetStorageBuffer(unsigned int binding, const RenderBuffer* buffer, size_t byteOffset /*= 0*/, size_t byteCount /*= 0*/)
+{
+	ComputeResource_t& resource = GetOrAddResource(COMPUTE_RESOURCE_STORAGE_BUFFER, binding);
+	resource.handle = buffer->GetHandle();
+	resource.byteOffset = byteOffset;
+	resource.byteCount = byteCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the range of the buffer to be bound to the uniform block binding
+//
+void ComputeBindingTable::SetUniformBuffer(unsigned int binding, const RenderBuffer* buffer, size_t byteOffset /*= 0*/, size_t byteCount /*= 0*/)
+{
+	ComputeResource_t& resource = GetOrAddResource(COMPUTE_RESOURCE_UNIFORM_BUFFER, binding);
+	resource.handle = buffer->GetHandle();
+	resource.byteOffset = byteOffset;
+	resource.byteCount = byteCount;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the texture to be sampled from the unit
+//
+void ComputeBindingTable::SetTexture(unsigned int unit, const Texture* texture, const Sampler* sampler /*= nullptr*/)
+{
+	ComputeResource_t& resource = GetOrAddResource(COMPUTE_RESOURCE_TEXTURE, unit);
+	resource.handle = texture->GetHandle();
+	resource.target = ToGLType(texture->GetTextureType());
+	resource.samplerHandle = (sampler != nullptr ? sampler->GetHandle() : NULL);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the mip level of the texture to be loaded from/stored to on the image unit
+// Layered textures are bound with all of their layers
+//
+void ComputeBindingTable::SetImage(unsigned int unit, const Texture* texture, GLenum access, int mipLevel /*= 0*/)
+{
+	ComputeResource_t& resource = GetOrAddResource(COMPUTE_RESOURCE_IMAGE, unit);
+	resource.handle = texture->GetHandle();
+	resource.target = ToGLType(texture->GetTextureType());
+	resource.imageAccess = access;
+	resource.imageFormat = ToGLInternalFormat(texture->GetFormat());
+	resource.mipLevel = mipLevel;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the int uniform at the location
+//
+void ComputeBindingTable::SetUniformInt(int location, int value)
+{
+	ComputeUniform_t& uniform = GetOrAddUniform(location);
+	uniform.type = COMPUTE_UNIFORM_INT;
+	uniform.intValue = value;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the uint uniform at the location
+//
+void ComputeBindingTable::SetUniformUInt(int location, unsigned int value)
+{
+	ComputeUniform_t& uniform = GetOrAddUniform(location);
+	uniform.type = COMPUTE_UNIFORM_UINT;
+	uniform.uintValue = value;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the float uniform at the location
+//
+void ComputeBindingTable::SetUniformFloat(int location, float value)
+{
+	ComputeUniform_t& uniform = GetOrAddUniform(location);
+	uniform.type = COMPUTE_UNIFORM_FLOAT;
+	uniform.floatValues[0] = value;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the vec3 uniform at the location
+//
+void ComputeBindingTable::SetUniformVector3(int location, const Vector3& value)
+{
+	ComputeUniform_t& uniform = GetOrAddUniform(location);
+	uniform.type = COMPUTE_UNIFORM_VECTOR3;
+	uniform.floatValues[0] = value.x;
+	uniform.floatValues[1] = value.y;
+	uniform.floatValues[2] = value.z;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Binds every resource in the table, and sets the uniforms on the program currently in use
+//
+void ComputeBindingTable::Bind() const
+{
+	int numResources = (int) m_resources.size();
+
+	for (int resourceIndex = 0; resourceIndex < numResources; ++resourceIndex)
+	{
+		const ComputeResource_t& resource = m_resources[resourceIndex];
+
+		switch (resource.type)
+		{
+		case COMPUTE_RESOURCE_STORAGE_BUFFER:
+			if (resource.byteCount > 0)
+			{
+				glBindBufferRange(GL_SHADER_STORAGE_BUFFER, resource.slot, resource.handle, resource.byteOffset, resource.byteCount);
+			}
+			else
+			{
+				glBindBufferBase(GL_SHADER_STORAGE_BUFFER, resource.slot, resource.handle);
+			}
+			break;
+		case COMPUTE_RESOURCE_UNIFORM_BUFFER:
+			if (resource.byteCount > 0)
+			{
+				GLStateCache::BindUniformBufferRange(resource.slot, resource.handle, resource.byteOffset, resource.byteCount);
+			}
+			else
+			{
+				GLStateCache::BindUniformBuffer(resource.slot, resource.handle);
+			}
+			break;
+		case COMPUTE_RESOURCE_TEXTURE:
+			GLStateCache::BindTexture(resource.slot, resource.target, resource.handle);
+			GLStateCache::BindSampler(resource.slot, resource.samplerHandle);
+			break;
+		case COMPUTE_RESOURCE_IMAGE:
+		{
+			GLboolean isLayered = (resource.target != GL_TEXTURE_2D ? GL_TRUE : GL_FALSE);
+			glBindImageTexture(resource.slot, resource.handle, resource.mipLevel, isLayered, 0, resource.imageAccess, resource.imageFormat);
+		}
+			break;
+		default:
+			break;
+		}
+	}
+
+	int numUniforms = (int) m_uniforms.size();
+
+	for (int uniformIndex = 0; uniformIndex < numUniforms; ++uniformIndex)
+	{
+		const ComputeUniform_t& uniform = m_uniforms[uniformIndex];
+
+		switch (uniform.type)
+		{
+		case COMPUTE_UNIFORM_INT:
+			glUniform1i(uniform.location, uniform.intValue);
+			break;
+		case COMPUTE_UNIFORM_UINT:
+			glUniform1ui(uniform.location, uniform.uintValue);
+			break;
+		case COMPUTE_UNIFORM_FLOAT:
+			glUniform1f(uniform.location, uniform.floatValues[0]);
+			break;
+		case COMPUTE_UNIFORM_VECTOR3:
+			glUniform3f(uniform.location, uniform.floatValues[0], uniform.floatValues[1], uniform.floatValues[2]);
+			break;
+		default:
+			break;
+		}
+	}
+
+	GL_CHECK_ERROR();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the table's resource of the type on the slot, adding one if there isn't one yet
+//
+ComputeResource_t& ComputeBindingTable::GetOrAddResource(eComputeResourceType type, unsigned int slot)
+{
+	int numResources = (int) m_resources.size();
+
+	for (int resourceIndex = 0; resourceIndex < numResources; ++resourceIndex)
+	{
+		if (m_resources[resourceIndex].type == type && m_resources[resourceIndex].slot == slot)
+		{
+			return m_resources[resourceIndex];
+		}
+	}
+
+	ComputeResource_t resource;
+	resource.type = type;
+	resource.slot = slot;
+
+	m_resources.push_back(resource);
+	return m_resources.back();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the table's uniform at the location, adding one if there isn't one yet
+//
+ComputeUniform_t& ComputeBindingTable::GetOrAddUniform(int location)
+{
+	int numUniforms = (int) m_uniforms.size();
+
+	for (int uniformIndex = 0; uniformIndex < numUniforms; ++uniformIndex)
+	{
+		if (m_uniforms[uniformIndex].location == location)
+		{
+			return m_uniforms[uniformIndex];
+		}
+	}
+
+	ComputeUniform_t uniform;
+	uniform.location = location;
+	uniform.intValue = 0;
+
+	m_uniforms.push_back(uniform);
+	return m_uniforms.back();
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Default constructor
 //
@@ -31,6 +271,7 @@ ComputeShader::~ComputeShader()
 	if (m_programHandle != NULL)
 	{
 		glDeleteProgram(m_programHandle);
+		GLStateCache::OnProgramDeleted(m_programHandle);
 		m_programHandle = NULL;
 	}
 }
@@ -41,13 +282,22 @@ ComputeShader::~ComputeShader()
 //
 bool ComputeShader::Initialize(const char* filename)
 {
-	GLuint shaderID = glCreateShader(GL_COMPUTE_SHADER);
-
 	// Get the shader source
 	size_t size;
 	char* src = (char*)FileReadToNewBuffer(filename, size);
 
-	glShaderSource(shaderID, 1, &src, NULL);
+	return InitializeFromSource(src, filename);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Compiles the program from the given source, for built-in compute shaders
+//
+bool ComputeShader::InitializeFromSource(const char* source, const char* name)
+{
+	GLuint shaderID = glCreateShader(GL_COMPUTE_SHADER);
+
+	glShaderSource(shaderID, 1, &source, NULL);
 	glCompileShader(shaderID);
 
 	// Check compile status
@@ -55,7 +305,7 @@ bool ComputeShader::Initialize(const char* filename)
 	glGetShaderiv(shaderID, GL_COMPILE_STATUS, &status);
 	if (status == GL_FALSE) 
 	{
-		LogShaderError(shaderID, filename);
+		LogShaderError(shaderID, name);
 		glDeleteShader(shaderID);
 		return false;
 	}
@@ -72,6 +322,7 @@ bool ComputeShader::Initialize(const char* filename)
 	if (link_status == GL_FALSE) {
 		LogProgramError(m_programHandle);
 		glDeleteProgram(m_programHandle);
+		GLStateCache::OnProgramDeleted(m_programHandle);
 		m_programHandle = NULL;
 		return false;
 	}
@@ -95,15 +346,96 @@ void ComputeShader::Execute(int numGroupsX, int numGroupsY, int numGroupsZ)
 		return;
 	}
 
-	glUseProgram(m_programHandle);
+	GLStateCache::UseProgram(m_programHandle);
 	glDispatchCompute((GLuint)numGroupsX, (GLuint)numGroupsY, (GLuint)numGroupsZ);
 	GL_CHECK_ERROR();
 
+	PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_COMPUTE_DISPATCHES);
+
 	// Block all future gl calls until this step finishes
 	glMemoryBarrier(GL_ALL_BARRIER_BITS);
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Binds the program and the table, and runs the given groups
+//
+void ComputeShader::Dispatch(const ComputeBindingTable& bindings, int numGroupsX, int numGroupsY, int numGroupsZ)
+{
+	if (m_programHandle == NULL)
+	{
+		LogTaggedPrintf("COMPUTE_SHADER", "Error: Dispatch() called on a compute shader with NULL handle");
+		return;
+	}
+
+	PROFILE_GPU_SCOPE(m_profileName);
+
+	GLStateCache::UseProgram(m_programHandle);
+	bindings.Bind();
+
+	glDispatchCompute((GLuint)numGroupsX, (GLuint)numGroupsY, (GLuint)numGroupsZ);
+	GL_CHECK_ERROR();
+
+	PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_COMPUTE_DISPATCHES);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Binds the program and the table, and runs the groups counted in the argument buffer
+//
+void ComputeShader::DispatchIndirect(const ComputeBindingTable& bindings, const RenderBuffer* argumentBuffer, size_t byteOffset /*= 0*/)
+{
+	if (m_programHandle == NULL)
+	{
+		LogTaggedPrintf("COMPUTE_SHADER", "Error: DispatchIndirect() called on a compute shader with NULL handle");
+		return;
+	}
+
+	ASSERT_OR_DIE(byteOffset % 4 == 0, Stringf("Error: ComputeShader::DispatchIndirect() given offset %u, which isn't 4 byte aligned", (unsigned int) byteOffset));
+	ASSERT_OR_DIE(byteOffset + 3 * sizeof(GLuint) <= argumentBuffer->GetSize(), "Error: ComputeShader::DispatchIndirect() argument buffer too small for the offset");
+
+	PROFILE_GPU_SCOPE(m_profileName);
+
+	GLStateCache::UseProgram(m_programHandle);
+	bindings.Bind();
+
+	glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, argumentBuffer->GetHandle());
+	glDispatchComputeIndirect((GLintptr) byteOffset);
+	glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, NULL);
+	GL_CHECK_ERROR();
+
+	PROFILE_COUNTER_INCREMENT(PROFILE_COUNTER_COMPUTE_DISPATCHES);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Inserts a memory barrier for the given GL_*_BARRIER_BIT bits
+//
+void ComputeShader::InsertBarrier(GLbitfield barrierBits)
+{
+	glMemoryBarrier(barrierBits);
+	GL_CHECK_ERROR();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the name the shader's dispatches are timed under
+//
+void ComputeShader::SetProfileName(const char* profileName)
+{
+	m_profileName = profileName;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the GL program handle, for setting uniforms
+//
+unsigned int ComputeShader::GetProgramHandle() const
+{
+	return m_programHandle;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Parses the error log and makes a Visual Studio "Double-click to open" shortcut and prints it
 // to the output pane
@@ -5,6 +5,100 @@
 /* Description: Class to represent an OpenGL compute shader
 /************************************************************************/
 #pragma once
+#include <vector>
+#include "ThirdParty/gl/glcorearb.h"
+
+class Texture;
+class Sampler;
+class Vector3;
+class RenderBuffer;
+
+enum eComputeResourceType
+{
+	COMPUTE_RESOURCE_STORAGE_BUFFER,
+	COMPUTE_RESOURCE_UNIFORM_BUFFER,
+	COMPUTE_RESOURCE_TEXTURE,
+	COMPUTE_RESOURCE_IMAGE
+};
+
+struct ComputeResource_t
+{
+	eComputeResourceType	type = COMPUTE_RESOURCE_STORAGE_BUFFER;
+	unsigned int			slot = 0;				// Buffer binding, or texture/image unit
+	GLuint					handle = 0;
+
+	// Buffers - a byte count of 0 binds the whole buffer
+	size_t					byteOffset = 0;
+	size_t					byteCount = 0;
+
+	// Textures and images
+	GLenum					target = GL_TEXTURE_2D;
+	GLuint					samplerHandle = 0;
+	GLenum					imageAccess = GL_READ_WRITE;
+	GLenum					imageFormat = 0;
+	int						mipLevel = 0;
+};
+
+enum eComputeUniformType
+{
+	COMPUTE_UNIFORM_INT,
+	COMPUTE_UNIFORM_UINT,
+	COMPUTE_UNIFORM_FLOAT,
+	COMPUTE_UNIFORM_VECTOR3
+};
+
+struct ComputeUniform_t
+{
+	eComputeUniformType		type = COMPUTE_UNIFORM_INT;
+	int						location = 0;
+
+	union
+	{
+		int				intValue;
+		unsigned int	uintValue;
+		float			floatValues[3];
+	};
+};
+
+
+// Everything a dispatch reads and writes, bound together right before it
+// Setting a slot or location that's already set replaces it, so a table can be kept and updated each frame
+class ComputeBindingTable
+{
+public:
+	//-----Public Methods-----
+
+	void Clear();
+
+	void SetStorageBuffer(unsigned int binding, const RenderBuffer* buffer, size_t byteOffset = 0, size_t byteCount = 0);
+	void SetUniformBuffer(unsigned int binding, const RenderBuffer* buffer, size_t byteOffset = 0, size_t byteCount = 0);
+	void SetTexture(unsigned int unit, const Texture* texture, const Sampler* sampler = nullptr);	// No sampler for texelFetch
+	void SetImage(unsigned int unit, const Texture* texture, GLenum access, int mipLevel = 0);
+
+	void SetUniformInt(int location, int value);
+	void SetUniformUInt(int location, unsigned int value);
+	void SetUniformFloat(int location, float value);
+	void SetUniformVector3(int location, const Vector3& value);
+
+	// Binds the resources, and sets the uniforms on the program in use
+	void Bind() const;
+
+
+private:
+	//-----Private Methods-----
+
+	ComputeResource_t&	GetOrAddResource(eComputeResourceType type, unsigned int slot);
+	ComputeUniform_t&	GetOrAddUniform(int location);
+
+
+private:
+	//-----Private Data-----
+
+	std::vector<ComputeResource_t>	m_resources;
+	std::vector<ComputeUniform_t>	m_uniforms;
+
+};
+
 
 class ComputeShader
 {
@@ -16,13 +110,32 @@ public:
 
 	// Loads and compiles
 	bool Initialize(const char* filename);
+	bool InitializeFromSource(const char* source, const char* name);	// Name is only used for error messages
 
-	// Runs the program
+	// Runs the program, then waits for all of its writes; dispatches that know what reads their
+	// results should use Dispatch() and InsertBarrier() instead
 	void Execute(int numGroupsX, int numGroupsY, int numGroupsZ);
 
+	// Binds the table and runs the program without a barrier after, so independent dispatches can overlap
+	// Each is timed on the GPUProfiler under the profile name
+	void Dispatch(const ComputeBindingTable& bindings, int numGroupsX, int numGroupsY, int numGroupsZ);
+
+	// Group counts are read on the GPU from the buffer at the offset, as three uints, i.e. written by an
+	// earlier dispatch; needs a GL_COMMAND_BARRIER_BIT barrier after that dispatch
+	void DispatchIndirect(const ComputeBindingTable& bindings, const RenderBuffer* argumentBuffer, size_t byteOffset = 0);
+
+	// Makes the writes of earlier dispatches visible to the kinds of reads in the GL_*_BARRIER_BIT bits
+	static void InsertBarrier(GLbitfield barrierBits);
+
+	// Must outlive the GPUProfiler's history, usually a literal
+	void SetProfileName(const char* profileName);
+
+	unsigned int GetProgramHandle() const;
+
 private:
 	//-----Private Data-----
 
 	unsigned int m_programHandle = 0;
+	const char*	 m_profileName = "ComputeShader";
 
 };
@@ -47,12 +47,21 @@ PropertyBlockDescription::~PropertyBlockDescription()
 // Returns the property given by propertyName if it exists, nullptr otherwise
 //
 const PropertyDescription* PropertyBlockDescription::GetPropertyDescription(const std::string& propertyName) const
+{
+	return GetPropertyDescriptionByID(HashStringID(propertyName));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the property description of the property whose name has the given ID, nullptr if none does
+//
+const PropertyDescription* PropertyBlockDescription::GetPropertyDescriptionByID(StringID propertyNameID) const
 {
 	int numProperties = (int) m_propertyDescriptions.size();
 
 	for (int index = 0; index < numProperties; ++index)
 	{
-		if (m_propertyDescriptions[index]->GetName() == propertyName)
+		if (m_propertyDescriptions[index]->GetNameID() == propertyNameID)
 		{
 			return m_propertyDescriptions[index];
 		}
@@ -7,6 +7,7 @@
 #pragma once
 #include <vector>
 #include <string>
+#include "Engine/Core/Utility/StringID.hpp"
 
 class PropertyDescription;
 
@@ -27,6 +28,7 @@ public:
 
 	const PropertyDescription* GetPropertyDescription(int propertyIndex) const;
 	const PropertyDescription* GetPropertyDescription(const std::string& propertyName) const;
+	const PropertyDescription* GetPropertyDescriptionByID(StringID propertyNameID) const;		// i.e. by SID("TINT"), without hashing the name
 
 	// Mutators
 	void SetName(const char* name);
@@ -11,7 +11,7 @@
 // Constructor
 //
 PropertyDescription::PropertyDescription(const std::string& name, size_t offset, size_t byteSize)
-	: m_name(name), m_offset(offset), m_byteSize(byteSize)
+	: m_name(name), m_nameID(InternStringID(name)), m_offset(offset), m_byteSize(byteSize)
 {
 }
 
@@ -22,6 +22,7 @@ PropertyDescription::PropertyDescription(const std::string& name, size_t offset,
 PropertyDescription::PropertyDescription(const PropertyDescription& copyDescription)
 	: m_byteSize(copyDescription.m_byteSize)
 	, m_name(copyDescription.m_name)
+	, m_nameID(copyDescription.m_nameID)
 	, m_offset(copyDescription.m_offset)
 {
 }
@@ -6,6 +6,7 @@
 /************************************************************************/
 #pragma once
 #include <string>
+#include "Engine/Core/Utility/StringID.hpp"
 
 
 class PropertyDescription
@@ -16,15 +17,17 @@ public:
 	PropertyDescription(const std::string& name, size_t offset, size_t byteSize);
 	PropertyDescription(const PropertyDescription& copyDescription);
 
-	inline std::string	GetName() const		{ return m_name; }
-	inline size_t		GetOffset() const	{ return m_offset; }
-	inline size_t		GetSize() const		{ return m_byteSize; }
+	inline const std::string&	GetName() const		{ return m_name; }
+	inline StringID				GetNameID() const	{ return m_nameID; }
+	inline size_t				GetOffset() const	{ return m_offset; }
+	inline size_t				GetSize() const		{ return m_byteSize; }
 
 
 private:
 	//-----Private Data-----
 
 	std::string m_name;
+	StringID	m_nameID;
 	size_t		m_offset;
 	size_t		m_byteSize;
 
@@ -5,6 +5,7 @@
 /* Description: Implementation of the Shader class
 /************************************************************************/
 #include "Engine/Assets/AssetDB.hpp"
+#include "Engine/Core/LogSystem.hpp"
 #include "Engine/Rendering/Shaders/Shader.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Rendering/Shaders/ShaderProgram.hpp"
@@ -23,20 +24,40 @@ Shader::Shader(ShaderProgram* program)
 // Constructor from XML
 //
 Shader::Shader(const std::string& xmlfilepath)
+	: m_shaderProgram(nullptr)
+{
+	if (!LoadFromFile(xmlfilepath))
+	{
+		ERROR_RECOVERABLE(Stringf("Error: Shader::LoadShadersFromXML couldn't load file \"%s\"", xmlfilepath.c_str()));
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Parses the XML into this shader, reusing its program so anything holding either sees the change
+// Render state the file doesn't specify goes back to the defaults, for reloads
+//
+bool Shader::LoadFromFile(const std::string& xmlfilepath)
 {
 	// Load the document
 	XMLDocument document;
-	XMLError error = document.LoadFile(xmlfilepath.c_str());
+	XMLError error = LoadXmlDocument(document, xmlfilepath);
 
 	if (error != tinyxml2::XML_SUCCESS)
 	{
-		ERROR_RECOVERABLE(Stringf("Error: Shader::LoadShadersFromXML couldn't load file \"%s\"", xmlfilepath.c_str()));
-		return;
+		LogTaggedPrintf("ASSETS", "Error: Shader couldn't load file \"%s\"", xmlfilepath.c_str());
+		return false;
 	}
 
 	// I keep a root around just because I like having a single root element
 	XMLElement* shaderElement = document.RootElement();
 
+	m_renderState = RenderState();
+	m_layer = 0;
+	m_queue = SORTING_QUEUE_OPAQUE;
+	m_isDeferrable = false;
+	m_preskinnedShaderName.clear();
+
 	ParseProgram(*shaderElement);
 	ParseCullMode(*shaderElement);
 	ParseFillMode(*shaderElement);
@@ -44,6 +65,9 @@ Shader::Shader(const std::string& xmlfilepath)
 	ParseDepthMode(*shaderElement);
 	ParseBlendMode(*shaderElement);
 	ParseLayerAndQueue(*shaderElement);
+	ParsePreskinned(*shaderElement);
+
+	return true;
 }
 
 
@@ -79,6 +103,8 @@ Shader* Shader::Clone()
 	RenderState renderState = m_renderState;
 
 	Shader* cloneShader = new Shader(renderState, program);
+	cloneShader->m_isDeferrable = m_isDeferrable;
+	cloneShader->m_preskinnedShaderName = m_preskinnedShaderName;
 
 	return cloneShader;
 }
@@ -93,8 +119,9 @@ void Shader::ParseProgram(const XMLElement& shaderElement)
 
 	if (programElement != nullptr)
 	{
-		// Get the program name
+		// Get the program name, and the keywords of the variant to compile (e.g. keywords="INSTANCED, LIT")
 		std::string programName = ParseXmlAttribute(*programElement, "name", "NO_PROGRAM_NAME_SPECIFIED_IN_XML");
+		ShaderKeywords keywords = ShaderProgram::ParseKeywords(ParseXmlAttribute(*programElement, "keywords", ""));
 
 		// Get the program data and build it
 		const XMLElement* vsElement = programElement->FirstChildElement("vertex");
@@ -107,10 +134,12 @@ void Shader::ParseProgram(const XMLElement& shaderElement)
 
 			if (vsFilepath.size() > 0 && fsFilepath.size() > 0)
 			{
-				ShaderProgram* program = new ShaderProgram(programName);
-				program->LoadProgramFromFiles(vsFilepath.c_str(), fsFilepath.c_str());	// Will assign invalid program internally if compilation fails
+				if (m_shaderProgram == nullptr)
+				{
+					m_shaderProgram = new ShaderProgram(programName);
+				}
 
-				m_shaderProgram = program;			
+				m_shaderProgram->LoadProgramFromFiles(vsFilepath.c_str(), fsFilepath.c_str(), keywords);	// Will assign invalid program internally if compilation fails
 			}
 		}
 	}
@@ -314,6 +343,22 @@ void Shader::ParseLayerAndQueue(const XMLElement& shaderElement)
 		{
 			m_queue = SORTING_QUEUE_OPAQUE; // Default to opaque
 		}
+
+		m_isDeferrable = ParseXmlAttribute(*orderElement, "deferred", false);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Parses the element for the unskinned shader that draws this one's pre-skinned meshes, if any
+//
+void Shader::ParsePreskinned(const XMLElement& shaderElement)
+{
+	const XMLElement* preskinnedElement = shaderElement.FirstChildElement("preskinned");
+
+	if (preskinnedElement != nullptr)
+	{
+		m_preskinnedShaderName = ParseXmlAttribute(*preskinnedElement, "shader", "");
 	}
 }
 
@@ -454,14 +499,50 @@ SortingQueue Shader::GetQueue() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Sets whether deferred cameras may draw this shader's draws into their G-buffer
+//
+void Shader::SetDeferrable(bool isDeferrable)
+{
+	m_isDeferrable = isDeferrable;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if deferred cameras may draw this shader's draws into their G-buffer
+//
+bool Shader::IsDeferrable() const
+{
+	return m_isDeferrable;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the unskinned shader that draws the GPUSkinning output of this shader's draws, empty for none
+//
+void Shader::SetPreskinnedShaderName(const std::string& shaderName)
+{
+	m_preskinnedShaderName = shaderName;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the name of the unskinned shader for this shader's pre-skinned draws, empty if they aren't pre-skinned
+//
+std::string Shader::GetPreskinnedShaderName() const
+{
+	return m_preskinnedShaderName;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Builds and returns a shader given the shader source and render state
 //
 Shader* Shader::BuildShader(const std::string& name, const char* vsSource, const char* fsSource, 
-	const RenderState& state, unsigned int sortingLayer, SortingQueue sortingQueue)
+	const RenderState& state, unsigned int sortingLayer, SortingQueue sortingQueue, uint32_t keywords /*= 0*/)
 {
 	ShaderProgram* program = new ShaderProgram(name);
-	program->LoadProgramFromSources(vsSource, fsSource, true);
+	program->LoadProgramFromSources(vsSource, fsSource, true, (ShaderKeywords) keywords);
 
 	Shader* shader = new Shader(state, program);
 	shader->m_layer = sortingLayer;
@@ -7,6 +7,7 @@
 #pragma once
 #include <map>
 #include <string>
+#include <stdint.h>
 #include "Engine/Rendering/OpenGL/glTypes.hpp"
 #include "Engine/Core/Utility/XmlUtilities.hpp"
 
@@ -42,6 +43,11 @@ struct RenderState
 	// Depth State Control
 	DepthTest	m_depthTest = DEPTH_TEST_LESS;
 	bool		m_shouldWriteDepth = true;
+	float		m_depthBiasSlope = 0.f;		// Polygon offset applied to the written depth, none if both are zero
+	float		m_depthBiasConstant = 0.f;
+
+	// Color Write Control
+	bool		m_shouldWriteColor = true;
 
 	// Blend State Control
 	BlendOp		m_colorBlendOp = BLEND_OP_ADD;
@@ -66,8 +72,11 @@ public:
 
 	Shader* Clone();
 
+	bool LoadFromFile(const std::string& xmlfilepath);
+
+	// Keywords are ShaderKeywords from ShaderProgram.hpp, picking the variant of the sources to build
 	static Shader* BuildShader(const std::string& programName, const char* vsSource, const char* fsSource, 
-		const RenderState& state, unsigned int sortingLayer, SortingQueue sortingQueue);
+		const RenderState& state, unsigned int sortingLayer, SortingQueue sortingQueue, uint32_t keywords = 0);
 
 	// Mutators
 	void SetProgram(ShaderProgram* program);
@@ -85,12 +94,23 @@ public:
 	void DisableColorBlending();
 	void DisableAlphaBlending();
 
+	// Set for lit shaders using the Phong inputs (diffuse and normal maps, specularUBO), which deferred cameras can
+	// draw into their G-buffer instead; set in XML with <order deferred="true"/>
+	void SetDeferrable(bool isDeferrable);
+
+	// For skinned shaders - the unskinned shader (by name or path) that draws the GPUSkinning pre-pass's output in
+	// their place, with the same material inputs; none keeps the draws skinned in the vertex shader
+	// Set in XML with <preskinned shader="Phong_Opaque"/>
+	void SetPreskinnedShaderName(const std::string& shaderName);
+
 	// Accessors
 	ShaderProgram*			GetProgram() const;
 	const RenderState&		GetRenderState() const;
 
 	unsigned int	GetLayer() const;
 	SortingQueue	GetQueue() const;
+	bool			IsDeferrable() const;
+	std::string		GetPreskinnedShaderName() const;
 
 private:
 	//-----Private Methods-----
@@ -103,6 +123,7 @@ private:
 	void ParseDepthMode(const XMLElement& shaderElement);
 	void ParseBlendMode(const XMLElement& shaderElement);
 	void ParseLayerAndQueue(const XMLElement& shaderElement);
+	void ParsePreskinned(const XMLElement& shaderElement);
 
 
 private:
@@ -114,5 +135,8 @@ private:
 	// For the forward rendering path, is ignored elsewhere
 	unsigned int m_layer = 0;
 	SortingQueue m_queue = SORTING_QUEUE_OPAQUE;
+	bool m_isDeferrable = false;
+	std::string m_preskinnedShaderName;
+
 
 };
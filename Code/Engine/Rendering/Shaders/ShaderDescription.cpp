@@ -58,6 +58,7 @@ const PropertyBlockDescription* ShaderDescription::GetBlockDescription(int index
 //
 const PropertyDescription* ShaderDescription::GetPropertyDescription(const char* propertyName) const
 {
+	StringID propertyNameID = HashStringID(propertyName);
 	int numBlocks = (int) m_blockDescriptions.size();
 
 	// Iterate across all blocks
@@ -71,7 +72,7 @@ const PropertyDescription* ShaderDescription::GetPropertyDescription(const char*
 		{
 			const PropertyDescription* currProperty = currBlock->GetPropertyDescription(propertyIndex);
 
-			if (currProperty->GetName() == propertyName)
+			if (currProperty->GetNameID() == propertyNameID)
 			{
 				return currProperty;
 			}
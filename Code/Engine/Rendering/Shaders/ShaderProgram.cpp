@@ -4,11 +4,13 @@
 /* Date: January 25th, 2018
 /* Description: Implementation of the ShaderProgram class
 /************************************************************************/
+#include <algorithm>
 #include "Engine/Core/File.hpp"
 #include "Engine/Rendering/OpenGL/glTypes.hpp"
 #include "Engine/Core/Utility/StringUtils.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Rendering/OpenGL/glFunctions.hpp"
+#include "Engine/Rendering/OpenGL/GLStateCache.hpp"
 #include "Engine/Rendering/Shaders/PropertyDescription.hpp"
 #include "Engine/Rendering/Shaders/ShaderSource.hpp"
 #include "Engine/Rendering/Shaders/ShaderProgram.hpp"
@@ -17,28 +19,67 @@
 #include "Engine/Rendering/Shaders/ShaderDescription.hpp"
 #include "Engine/Core/DeveloperConsole/DevConsole.hpp"
 
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+
 //-----C functions declared here to ignore order-----
 
-// Creating shaders
-static GLuint	CreateShader(char const *filenameOrSource, GLenum type, bool isFilename);
+// Creating shaders, the results aren't checked until they're needed so the driver can work in the meantime
+static GLuint	IssueShaderCompile(const char* source, GLenum type);
+static bool		CheckShaderCompiled(GLuint shader_id, const std::string& filePath);
 
 // Shader error printing
 static void		LogShaderError(GLuint shader_id, const std::string& filePath);
 void			FormatAndPrintShaderError(const std::string& errorLog, const std::string& localFilePath);
 
 // Program creation and error reporting
-static GLuint	CreateAndLinkProgram( GLint vs, GLint fs );
+static GLuint	IssueProgramLink( GLuint vs, GLuint fs );
+static bool		CheckProgramLinked(GLuint program_id);
 static void		LogProgramError(GLuint program_id);
 
+// Keyword variants
+static std::string	AddKeywordDefines(const char* source, ShaderKeywords keywords);
+
+// Program binary cache
+static uint64_t		HashText(uint64_t hash, const char* text);
+static uint64_t		GetDriverHash();
+static uint64_t		HashProgramSources(const char* vsSource, const char* fsSource);
+static std::string	GetProgramBinaryPath(uint64_t cacheKey);
+static GLuint		LoadCachedProgramBinary(uint64_t cacheKey);
+static void			SaveProgramBinary(GLuint program_id, uint64_t cacheKey);
+
+// Written before the driver's binary so stale or foreign files are rejected without handing them to GL
+struct ProgramBinaryHeader_t
+{
+	uint32_t fourCC;
+	uint32_t binaryFormat;
+	uint64_t cacheKey;
+	uint64_t driverHash;
+};
+
+#define PROGRAM_BINARY_FOURCC (0x32494247) // "GBI2"
+
+bool									ShaderProgram::s_isCompilingInParallel = false;
+std::vector<ShaderProgram::PendingProgram_t>	ShaderProgram::s_pendingPrograms;
+std::vector<ShaderProgram::PendingProgram_t>	ShaderProgram::s_asyncPrograms;
+
+// Indexed by bit, the names the keywords are #defined as
+static const char* s_keywordNames[NUM_SHADER_KEYWORDS] = { "INSTANCED", "SKINNED", "LIT", "SHADOWED" };
+
 
 //-----------------------------------------------------------------------------------------------
 // Deletes the program from the GPU
 //
 ShaderProgram::~ShaderProgram()
 {
+	CancelAsyncCompile();
+
 	if (m_programHandle != NULL)
 	{
 		glDeleteProgram(m_programHandle);
+		GLStateCache::OnProgramDeleted(m_programHandle);
 		m_programHandle = NULL;
 	}
 
@@ -56,11 +97,11 @@ ShaderProgram* ShaderProgram::Clone() const
 
 	if (m_areFilepaths)
 	{
-		program->LoadProgramFromFiles(m_vsFilePathOrSource.c_str(), m_fsFilePathOrSource.c_str());
+		program->LoadProgramFromFiles(m_vsFilePathOrSource.c_str(), m_fsFilePathOrSource.c_str(), m_keywords);
 	}
 	else
 	{
-		program->LoadProgramFromSources(m_vsFilePathOrSource.c_str(), m_fsFilePathOrSource.c_str(), true);
+		program->LoadProgramFromSources(m_vsFilePathOrSource.c_str(), m_fsFilePathOrSource.c_str(), true, m_keywords);
 	}
 
 	return program;
@@ -103,6 +144,15 @@ const std::string& ShaderProgram::GetFSFilePathOrSource() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the keywords this program's variant was compiled with
+//
+ShaderKeywords ShaderProgram::GetKeywords() const
+{
+	return m_keywords;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns this shader program's uniform block description
 //
@@ -112,6 +162,73 @@ const ShaderDescription* ShaderProgram::GetUniformDescription() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Returns the location of the vertex attribute with the given name, or -1 if the program doesn't read it
+//
+int ShaderProgram::GetAttributeLocation(const std::string& name) const
+{
+	for (const ShaderAttribute_t& attribute : m_attributes)
+	{
+		if (attribute.name == name)
+		{
+			return attribute.location;
+		}
+	}
+
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of vertex attributes the program reads
+//
+int ShaderProgram::GetAttributeCount() const
+{
+	return (int) m_attributes.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the attribute at the given index, in no particular order
+//
+const ShaderAttribute_t& ShaderProgram::GetAttribute(int index) const
+{
+	return m_attributes[index];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of samplers the program reads
+//
+int ShaderProgram::GetSamplerCount() const
+{
+	return (int) m_samplers.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the sampler at the given index, in no particular order
+//
+const ShaderSampler_t& ShaderProgram::GetSampler(int index) const
+{
+	return m_samplers[index];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns whether the program has a uniform block at the given binding, so binding one there matters
+//
+bool ShaderProgram::UsesBlockBinding(unsigned int blockBinding) const
+{
+	if (blockBinding >= 32)
+	{
+		return true;
+	}
+
+	return ((m_blockBindingMask & (1u << blockBinding)) != 0);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Returns whether or not this program was built directly from source code
 //
@@ -127,7 +244,8 @@ bool ShaderProgram::WasBuiltFromSource() const
 void ShaderProgram::SetupPropertyBlockInfos()
 {
 	m_uniformDescription = new ShaderDescription();
-	glUseProgram(m_programHandle);
+	m_blockBindingMask = 0;
+	GLStateCache::UseProgram(m_programHandle);
 
 	GLint blockCount;
 	glGetProgramiv(m_programHandle, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
@@ -148,6 +266,7 @@ void ShaderProgram::SetupPropertyBlockInfos()
 			glGetActiveUniformBlockiv(m_programHandle, blockIndex, GL_UNIFORM_BLOCK_BINDING, &blockBinding);
 
 			ASSERT_OR_DIE(blockBinding != -1, Stringf("Error: ShaderProgram::FillBlockInfo() found uniform block with binding not specifed in shader."));
+			m_blockBindingMask |= (blockBinding < 32 ? (1u << blockBinding) : 0u);
 
 			// Get the block size
 			GLint blockSize = 0;
@@ -217,12 +336,96 @@ void ShaderProgram::FillBlockProperties(PropertyBlockDescription* blockInfo, int
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Reflects the active vertex attributes, so VAOs are set up from the table instead of asking GL
+// for each attribute of each mesh
+//
+void ShaderProgram::SetupAttributeInfos()
+{
+	m_attributes.clear();
+
+	GLint attributeCount = 0;
+	glGetProgramiv(m_programHandle, GL_ACTIVE_ATTRIBUTES, &attributeCount);
+
+	for (GLint attributeIndex = 0; attributeIndex < attributeCount; ++attributeIndex)
+	{
+		char attributeName[64];
+		GLsizei nameLength = 0;
+		GLint arraySize = 0;
+		GLenum type = 0;
+
+		glGetActiveAttrib(m_programHandle, (GLuint) attributeIndex, sizeof(attributeName), &nameLength, &arraySize, &type, attributeName);
+
+		// Built-ins like gl_VertexID are active, but have no location
+		GLint location = glGetAttribLocation(m_programHandle, attributeName);
+		if (nameLength <= 0 || location < 0)
+		{
+			continue;
+		}
+
+		ShaderAttribute_t attribute;
+		attribute.name = attributeName;
+		attribute.location = location;
+		attribute.glType = type;
+
+		m_attributes.push_back(attribute);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reflects the samplers outside of uniform blocks along with the texture units they read
+//
+void ShaderProgram::SetupSamplerInfos()
+{
+	m_samplers.clear();
+
+	GLint uniformCount = 0;
+	glGetProgramiv(m_programHandle, GL_ACTIVE_UNIFORMS, &uniformCount);
+
+	for (GLint uniformIndex = 0; uniformIndex < uniformCount; ++uniformIndex)
+	{
+		GLuint index = (GLuint) uniformIndex;
+		GLint type = 0;
+		GLint blockIndex = -1;
+
+		glGetActiveUniformsiv(m_programHandle, 1, &index, GL_UNIFORM_TYPE, &type);
+		glGetActiveUniformsiv(m_programHandle, 1, &index, GL_UNIFORM_BLOCK_INDEX, &blockIndex);
+
+		if (blockIndex != -1 || !IsSamplerType((unsigned int) type))
+		{
+			continue;
+		}
+
+		char uniformName[64];
+		GLsizei nameLength = 0;
+		glGetActiveUniformName(m_programHandle, index, sizeof(uniformName), &nameLength, uniformName);
+
+		// A sampler's value is the texture unit it reads, set by its layout(binding = ...)
+		GLint location = glGetUniformLocation(m_programHandle, uniformName);
+		GLint textureUnit = -1;
+
+		if (location >= 0)
+		{
+			glGetUniformiv(m_programHandle, location, &textureUnit);
+		}
+
+		ShaderSampler_t sampler;
+		sampler.name = uniformName;
+		sampler.textureUnit = textureUnit;
+		sampler.glType = (unsigned int) type;
+
+		m_samplers.push_back(sampler);
+	}
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Loads the shaders given by rootName, and compiles and links them into a shader program
 // Root name is the path without the extension, forces the program to be made from a vs and fs of
 // the same name
 //
-bool ShaderProgram::LoadProgramFromFiles(const char *rootName)
+bool ShaderProgram::LoadProgramFromFiles(const char *rootName, ShaderKeywords keywords /*= SHADER_KEYWORDS_NONE*/)
 {
 	// Assign the file paths to this program
 	std::string vsFilePath = rootName;
@@ -231,7 +434,7 @@ bool ShaderProgram::LoadProgramFromFiles(const char *rootName)
 	std::string fsFilePath = rootName; 
 	fsFilePath += ".fs"; 
 
-	bool success = LoadProgramFromFiles(vsFilePath.c_str(), fsFilePath.c_str());
+	bool success = LoadProgramFromFiles(vsFilePath.c_str(), fsFilePath.c_str(), keywords);
 
 	return success;
 }
@@ -240,109 +443,380 @@ bool ShaderProgram::LoadProgramFromFiles(const char *rootName)
 //-----------------------------------------------------------------------------------------------
 // Creates a program by the given vs and fs file paths
 //
-bool ShaderProgram::LoadProgramFromFiles(const char* vsFilePath, const char* fsFilePath)
+bool ShaderProgram::LoadProgramFromFiles(const char* vsFilePath, const char* fsFilePath, ShaderKeywords keywords /*= SHADER_KEYWORDS_NONE*/)
 {
-	// If this Shader Program already has a program ID on the gpu, free the memory there before
-	// attempting reload
-	if (m_programHandle != NULL)
+	CancelAsyncCompile();
+
+	PendingProgram_t pending = BeginProgramFromFiles(vsFilePath, fsFilePath, keywords);
+
+	if (s_isCompilingInParallel)
 	{
-		glDeleteProgram(m_programHandle);
-		m_programHandle = NULL;
+		s_pendingPrograms.push_back(pending);
+		return true;
 	}
 
-	// Compile the two stages we're using 
-	GLuint vert_shader = CreateShader(vsFilePath, GL_VERTEX_SHADER, true); 
-	GLuint frag_shader = CreateShader(fsFilePath, GL_FRAGMENT_SHADER, true); 
+	return FinishProgram(pending);
+}
+
 
-	// Only if both compilations were successful do we bother linking them
-	if (vert_shader != 0 && frag_shader != 0)
+//-----------------------------------------------------------------------------------------------
+// Loads the shaders given by the string source code, and compiles and links them into a shader program
+//
+bool ShaderProgram::LoadProgramFromSources(const char *vertexShaderSource, const char* fragmentShaderSource, bool overrideFlags, ShaderKeywords keywords /*= SHADER_KEYWORDS_NONE*/)
+{
+	CancelAsyncCompile();
+
+	// All shaders implement the vertex and fragment stages, later on we can add in more stages
+	PendingProgram_t pending = BeginProgramFromSources(vertexShaderSource, fragmentShaderSource, "", "", keywords);
+
+	if (overrideFlags)
 	{
-		m_programHandle = CreateAndLinkProgram( vert_shader, frag_shader ); 
+		m_vsFilePathOrSource = vertexShaderSource;
+		m_fsFilePathOrSource = fragmentShaderSource;
+		m_keywords = keywords;
+
+		m_areFilepaths = false;
 	}
 
-	// Delete the shaders, we don't need them anymore
-	glDeleteShader( vert_shader ); 
-	glDeleteShader( frag_shader ); 
+	if (s_isCompilingInParallel)
+	{
+		s_pendingPrograms.push_back(pending);
+		return true;
+	}
 
-	m_vsFilePathOrSource = vsFilePath;
-	m_fsFilePathOrSource = fsFilePath;
+	return FinishProgram(pending);
+}
 
-	// If the program could not be compiled or linked correctly, then assign it the invalid shader
+
+//-----------------------------------------------------------------------------------------------
+// Starts deferring the checks of the programs loaded from here on, until EndParallelCompile()
+//
+void ShaderProgram::BeginParallelCompile()
+{
+	ASSERT_OR_DIE(!s_isCompilingInParallel, "Error: ShaderProgram::BeginParallelCompile() called while already compiling in parallel");
+
+	// Lets drivers with background compiles use as many threads as they like
+	if (glMaxShaderCompilerThreadsARB != nullptr)
+	{
+		glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+	}
+
+	s_isCompilingInParallel = true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Checks and finishes every program loaded since BeginParallelCompile(), the first check waiting on
+// whatever the driver hasn't gotten through yet
+//
+void ShaderProgram::EndParallelCompile()
+{
+	ASSERT_OR_DIE(s_isCompilingInParallel, "Error: ShaderProgram::EndParallelCompile() called without BeginParallelCompile()");
+	s_isCompilingInParallel = false;
+
+	// Swapped out first, since a program that fails builds the invalid program in its place right away
+	std::vector<PendingProgram_t> pendingPrograms;
+	pendingPrograms.swap(s_pendingPrograms);
+
+	for (PendingProgram_t& pending : pendingPrograms)
+	{
+		pending.program->FinishProgram(pending);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Issues the program's compile and link for UpdateAsyncCompiles() to finish once the driver is done,
+// keeping the current program in use until then
+//
+bool ShaderProgram::LoadProgramFromFilesAsync(const char* vsFilePath, const char* fsFilePath, ShaderKeywords keywords /*= SHADER_KEYWORDS_NONE*/)
+{
+	ASSERT_OR_DIE(!s_isCompilingInParallel, "Error: ShaderProgram::LoadProgramFromFilesAsync() called during a parallel compile");
+
+	// A newer load replaces any still going
+	CancelAsyncCompile();
+
+	PendingProgram_t pending = BeginProgramFromFiles(vsFilePath, fsFilePath, keywords);
+
+	// Cached binaries are ready already, so there's nothing to wait on
+	if (pending.vsHandle == NULL)
+	{
+		return FinishProgram(pending);
+	}
+
+	// Something has to be drawn with in the meantime
 	if (m_programHandle == NULL)
 	{
-		if (DevConsole::GetInstance() != nullptr)
+		LoadProgramFromSources(ShaderSource::INVALID_VS, ShaderSource::INVALID_FS, false);
+	}
+
+	s_asyncPrograms.push_back(pending);
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns whether an async load was issued for this program that hasn't been swapped in yet
+//
+bool ShaderProgram::IsAsyncCompilePending() const
+{
+	for (const PendingProgram_t& pending : s_asyncPrograms)
+	{
+		if (pending.program == this)
 		{
-			ConsoleErrorf("Error: ShaderProgram %s failed to compile");
+			return true;
 		}
+	}
 
-		DebuggerPrintf("Error: ShaderProgram %s failed to compile", m_name.c_str());
-		LoadProgramFromSources(ShaderSource::INVALID_VS, ShaderSource::INVALID_FS, false);
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Finishes the async loads whose links are done, without waiting on the rest
+//
+void ShaderProgram::UpdateAsyncCompiles()
+{
+	// The extension is what lets completion be asked for without blocking
+	bool canPollCompletion = (glMaxShaderCompilerThreadsARB != nullptr);
+
+	int pendingIndex = 0;
+	while (pendingIndex < (int) s_asyncPrograms.size())
+	{
+		bool isDone = true;
+
+		if (canPollCompletion)
+		{
+			GLint isComplete = GL_FALSE;
+			glGetProgramiv(s_asyncPrograms[pendingIndex].programHandle, GL_COMPLETION_STATUS_ARB, &isComplete);
+			isDone = (isComplete == GL_TRUE);
+		}
+
+		if (isDone)
+		{
+			// Removed first, since finishing can load the invalid program into it
+			PendingProgram_t finished = s_asyncPrograms[pendingIndex];
+			s_asyncPrograms.erase(s_asyncPrograms.begin() + pendingIndex);
+
+			finished.program->FinishProgram(finished);
+		}
+		else
+		{
+			pendingIndex++;
+		}
 	}
+}
+
 
-	// Get Uniform Block information from the created shader
-	bool succeeded = (m_programHandle != NULL);
+//-----------------------------------------------------------------------------------------------
+// Returns the number of async loads still waiting on the driver
+//
+int ShaderProgram::GetPendingAsyncCompileCount()
+{
+	return (int) s_asyncPrograms.size();
+}
 
-	if (succeeded)
+
+//-----------------------------------------------------------------------------------------------
+// Returns the keywords named in the text, skipping (and reporting) any that aren't known
+//
+ShaderKeywords ShaderProgram::ParseKeywords(const std::string& keywordText)
+{
+	ShaderKeywords keywords = SHADER_KEYWORDS_NONE;
+
+	std::vector<std::string> tokens = Tokenize(keywordText, ',');
+	for (std::string& token : tokens)
 	{
-		SetupPropertyBlockInfos();
+		size_t nameStart = token.find_first_not_of(" \t");
+		size_t nameEnd = token.find_last_not_of(" \t");
+
+		if (nameStart == std::string::npos)
+		{
+			continue;
+		}
+
+		std::string name = token.substr(nameStart, nameEnd - nameStart + 1);
+		bool isKnown = false;
+
+		for (uint32_t keywordIndex = 0; keywordIndex < NUM_SHADER_KEYWORDS; ++keywordIndex)
+		{
+			if (name == s_keywordNames[keywordIndex])
+			{
+				keywords |= (1u << keywordIndex);
+				isKnown = true;
+				break;
+			}
+		}
+
+		if (!isKnown)
+		{
+			DebuggerPrintf("Warning: Unknown shader keyword \"%s\" ignored", name.c_str());
+		}
 	}
 
-	m_areFilepaths = true;
+	return keywords;
+}
+
 
-	return succeeded; 
+//-----------------------------------------------------------------------------------------------
+// Returns the name the keyword is #defined as in the sources
+//
+const char* ShaderProgram::GetKeywordName(eShaderKeyword keyword)
+{
+	uint32_t keywordIndex = 0;
+	while (keywordIndex < NUM_SHADER_KEYWORDS && keyword != (eShaderKeyword) (1u << keywordIndex))
+	{
+		keywordIndex++;
+	}
+
+	ASSERT_OR_DIE(keywordIndex < NUM_SHADER_KEYWORDS, Stringf("Error: ShaderProgram::GetKeywordName() given an invalid keyword %u", (unsigned int) keyword));
+	return s_keywordNames[keywordIndex];
 }
 
 
 //-----------------------------------------------------------------------------------------------
-// Loads the shaders given by the string source code, and compiles and links them into a shader program
+// Reads both stages and begins the program from them, taking the files as this program's sources
 //
-bool ShaderProgram::LoadProgramFromSources(const char *vertexShaderSource, const char* fragmentShaderSource, bool overrideFlags)
+ShaderProgram::PendingProgram_t ShaderProgram::BeginProgramFromFiles(const char* vsFilePath, const char* fsFilePath, ShaderKeywords keywords)
 {
-	// Compile the two stages we're using (all shaders will implement the vertex and fragment stages)
-	// later on, we can add in more stages;
-	GLuint vert_shader = CreateShader(vertexShaderSource, GL_VERTEX_SHADER, false); 
-	GLuint frag_shader = CreateShader(fragmentShaderSource, GL_FRAGMENT_SHADER, false); 
+	// Read both stages up front, since the cache is keyed by what's in the files rather than their names
+	size_t vsSize = 0;
+	size_t fsSize = 0;
+	char* vsSource = (char*) FileReadToNewBuffer(vsFilePath, vsSize);
+	char* fsSource = (char*) FileReadToNewBuffer(fsFilePath, fsSize);
 
+	GUARANTEE_OR_DIE(vsSource != nullptr, Stringf("Error: File \"%s\" could not be found or opened.", vsFilePath));
+	GUARANTEE_OR_DIE(fsSource != nullptr, Stringf("Error: File \"%s\" could not be found or opened.", fsFilePath));
 
-	// Only if both compilations were successful do we bother linking them
-	if (vert_shader != 0 && frag_shader != 0)
+	PendingProgram_t pending = BeginProgramFromSources(vsSource, fsSource, vsFilePath, fsFilePath, keywords);
+
+	free(vsSource);
+	free(fsSource);
+
+	m_vsFilePathOrSource = vsFilePath;
+	m_fsFilePathOrSource = fsFilePath;
+	m_keywords = keywords;
+	m_areFilepaths = true;
+
+	return pending;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Gets the program for the two stages with the keywords defined, loading the binary an earlier run
+// cached for the same variant if the driver still accepts it, and otherwise issuing the compile and
+// link for FinishProgram() to check
+//
+ShaderProgram::PendingProgram_t ShaderProgram::BeginProgramFromSources(const char* vsSource, const char* fsSource, const std::string& vsFilePath, const std::string& fsFilePath, ShaderKeywords keywords)
+{
+	std::string vsVariant = AddKeywordDefines(vsSource, keywords);
+	std::string fsVariant = AddKeywordDefines(fsSource, keywords);
+
+	// Keyed on the sources with the defines in them, so each variant is cached separately
+	PendingProgram_t pending;
+	pending.program = this;
+	pending.cacheKey = HashProgramSources(vsVariant.c_str(), fsVariant.c_str());
+	pending.vsFilePath = vsFilePath;
+	pending.fsFilePath = fsFilePath;
+
+	pending.programHandle = LoadCachedProgramBinary(pending.cacheKey);
+	if (pending.programHandle != NULL)
 	{
-		m_programHandle = CreateAndLinkProgram( vert_shader, frag_shader ); 
+		return pending;
 	}
 
-	// Delete the shaders, we don't need them anymore
-	glDeleteShader( vert_shader ); 
-	glDeleteShader( frag_shader ); 
+	pending.vsHandle = IssueShaderCompile(vsVariant.c_str(), GL_VERTEX_SHADER);
+	pending.fsHandle = IssueShaderCompile(fsVariant.c_str(), GL_FRAGMENT_SHADER);
+	pending.programHandle = IssueProgramLink(pending.vsHandle, pending.fsHandle);
 
-	if (overrideFlags)
+	return pending;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Checks the compile and link, caching the binary if they worked and falling back to the invalid
+// program if they didn't, then swaps the program in and reflects its uniform blocks
+//
+bool ShaderProgram::FinishProgram(PendingProgram_t& pending)
+{
+	bool wasCompiled = (pending.vsHandle != NULL);
+
+	if (wasCompiled)
 	{
-		m_vsFilePathOrSource = vertexShaderSource;
-		m_fsFilePathOrSource = fragmentShaderSource;
+		// Both checked, so both stages report their errors
+		bool vsCompiled = CheckShaderCompiled(pending.vsHandle, pending.vsFilePath);
+		bool fsCompiled = CheckShaderCompiled(pending.fsHandle, pending.fsFilePath);
 
-		m_areFilepaths = false;
+		// Link errors are only worth reporting if the stages themselves compiled
+		if (vsCompiled && fsCompiled && CheckProgramLinked(pending.programHandle))
+		{
+			SaveProgramBinary(pending.programHandle, pending.cacheKey);
+		}
+		else
+		{
+			glDeleteProgram(pending.programHandle);
+			GLStateCache::OnProgramDeleted(pending.programHandle);
+			pending.programHandle = NULL;
+		}
+
+		// Delete the shaders, we don't need them anymore
+		glDeleteShader(pending.vsHandle);
+		glDeleteShader(pending.fsHandle);
+		pending.vsHandle = NULL;
+		pending.fsHandle = NULL;
+	}
+
+	// Replaces whatever was used in the meantime, i.e. the old program during a reload
+	if (m_programHandle != NULL)
+	{
+		glDeleteProgram(m_programHandle);
+		GLStateCache::OnProgramDeleted(m_programHandle);
 	}
-	
+
+	m_programHandle = pending.programHandle;
+	pending.programHandle = NULL;
+
 	// If the program could not be compiled or linked correctly, then assign it the invalid shader
 	if (m_programHandle == NULL)
 	{
 		if (DevConsole::GetInstance() != nullptr)
 		{
-			ConsoleErrorf("Error: ShaderProgram %s failed to compile");
+			ConsoleErrorf("Error: ShaderProgram %s failed to compile", m_name.c_str());
 		}
 
 		DebuggerPrintf("Error: ShaderProgram %s failed to compile", m_name.c_str());
-		LoadProgramFromSources(ShaderSource::INVALID_VS, ShaderSource::INVALID_FS, false);
+		return LoadProgramFromSources(ShaderSource::INVALID_VS, ShaderSource::INVALID_FS, false);
 	}
 
-	// Get Uniform Block information from the created shader
-	bool succeeded = (m_programHandle != NULL);
+	// Get Uniform Block, attribute and sampler information from the created shader
+	SetupPropertyBlockInfos();
+	SetupAttributeInfos();
+	SetupSamplerInfos();
 
-	if (succeeded)
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Drops this program's async load if it has one, deleting what was issued for it
+//
+void ShaderProgram::CancelAsyncCompile()
+{
+	for (int pendingIndex = 0; pendingIndex < (int) s_asyncPrograms.size(); ++pendingIndex)
 	{
-		SetupPropertyBlockInfos();
-	}
+		PendingProgram_t& pending = s_asyncPrograms[pendingIndex];
 
-	return succeeded; 
+		if (pending.program == this)
+		{
+			glDeleteShader(pending.vsHandle);
+			glDeleteShader(pending.fsHandle);
+			glDeleteProgram(pending.programHandle);
+			GLStateCache::OnProgramDeleted(pending.programHandle);
+
+			s_asyncPrograms.erase(s_asyncPrograms.begin() + pendingIndex);
+			return;
+		}
+	}
 }
 
 
@@ -359,55 +833,41 @@ const std::string& ShaderProgram::GetName() const
 //------------------------------------------C Functions------------------------------------------
 
 //-----------------------------------------------------------------------------------------------
-// Takes a file, and creates an intermediary binary to be used in the linking process
+// Starts compiling the source into an intermediary binary to be used in the linking process
+// Nothing is checked here, so the compile can carry on while other work is issued
 //
-static GLuint CreateShader(char const *filenameOrSource, GLenum type, bool isFileName)
+static GLuint IssueShaderCompile(const char* source, GLenum type)
 {
 	// Create a shader
 	GLuint shader_id = glCreateShader(type);
-	GUARANTEE_OR_DIE(shader_id != NULL, Stringf("Error: glCreateShader failed in CreateShaderFromFile."));
+	GUARANTEE_OR_DIE(shader_id != NULL, Stringf("Error: glCreateShader failed in IssueShaderCompile."));
 
 	// Bind source to it, and compile
-	// If we're passed a file name, then load it from file
-	if (isFileName)
-	{
-		size_t size;
-		char* src = (char*)FileReadToNewBuffer(filenameOrSource, size);
-		GUARANTEE_OR_DIE(src != nullptr, Stringf("Error: File \"%s\" could not be found or opened.", filenameOrSource));
+	GLint shader_length = (GLint)strlen(source);
+	glShaderSource(shader_id, 1, &source, &shader_length);
+	glCompileShader(shader_id);
 
-		GLint shader_length = (GLint)strlen(src);
-		glShaderSource(shader_id, 1, &src, &shader_length);
-		glCompileShader(shader_id);
+	return shader_id;
+}
 
-		free(src);
-	}
-	// Otherwise treat the passed char* as a string source
-	else
-	{
-		GLint shader_length = (GLint)strlen(filenameOrSource);
-		glShaderSource(shader_id, 1, &filenameOrSource, &shader_length);
-		glCompileShader(shader_id);
-	}
 
-	// Check status
+//-----------------------------------------------------------------------------------------------
+// Returns whether the shader compiled, logging its errors if it didn't; waits on the compile if it's
+// still going
+// The file path is only for reporting errors, and is empty for built-in sources
+//
+static bool CheckShaderCompiled(GLuint shader_id, const std::string& filePath)
+{
 	GLint status;
 	glGetShaderiv(shader_id, GL_COMPILE_STATUS, &status);
-	if (status == GL_FALSE) {
-
-		if (isFileName)
-		{
-			LogShaderError(shader_id, filenameOrSource);
-		}
-		else
-		{
-			LogShaderError(shader_id, "");
-		}
 
-		glDeleteShader(shader_id);
-		shader_id = NULL;
+	if (status == GL_FALSE) 
+	{
+		LogShaderError(shader_id, filePath);
+		return false;
 	}
 
-	return shader_id;
+	return true;
 }
 
 
@@ -487,9 +947,10 @@ void FormatAndPrintShaderError(const std::string& errorLog, const std::string& l
 
 
 //-----------------------------------------------------------------------------------------------
-// Takes the binary shader objects and links them into a shader program
+// Takes the binary shader objects and starts linking them into a shader program
+// Linking waits on the compiles in the driver rather than here, so nothing is checked yet
 //
-static GLuint CreateAndLinkProgram( GLint vs, GLint fs )
+static GLuint IssueProgramLink( GLuint vs, GLuint fs )
 {
 	// create the program handle - how you will reference
 	// this program within OpenGL, like a texture handle
@@ -500,26 +961,36 @@ static GLuint CreateAndLinkProgram( GLint vs, GLint fs )
 	glAttachShader( program_id, vs );
 	glAttachShader( program_id, fs );
 
+	// So the linked binary can be saved to the cache
+	glProgramParameteri( program_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE );
+
 	// Link the program (create the GPU program)
 	glLinkProgram( program_id );
 
-	// Check for link errors - usually a result
-	// of incompatibility between stages.
+	// The link uses the shaders as they were when it was issued, so they can be detached right away
+	glDetachShader( program_id, vs );
+	glDetachShader( program_id, fs );
+
+	return program_id;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns whether the program linked, logging its errors if it didn't - usually a result of
+// incompatibility between stages
+//
+static bool CheckProgramLinked(GLuint program_id)
+{
 	GLint link_status;
 	glGetProgramiv(program_id, GL_LINK_STATUS, &link_status);
 
-	if (link_status == GL_FALSE) {
+	if (link_status == GL_FALSE) 
+	{
 		LogProgramError(program_id);
-		glDeleteProgram(program_id);
-		program_id = 0;
-	} 
-
-	// no longer need the shaders objects, you can detach them if you want
-	// (not necessary)
-	glDetachShader( program_id, vs );
-	glDetachShader( program_id, fs );
+		return false;
+	}
 
-	return program_id;
+	return true;
 }
 
 
@@ -545,3 +1016,208 @@ static void LogProgramError(GLuint program_id)
 	// cleanup
 	delete buffer;
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the source with a #define for each keyword after its #version line, which has to come first
+// A #line after them keeps the driver's error line numbers matching the source as written
+//
+static std::string AddKeywordDefines(const char* source, ShaderKeywords keywords)
+{
+	std::string variantSource = source;
+
+	if (keywords == SHADER_KEYWORDS_NONE)
+	{
+		return variantSource;
+	}
+
+	std::string defines;
+	for (uint32_t keywordIndex = 0; keywordIndex < NUM_SHADER_KEYWORDS; ++keywordIndex)
+	{
+		if ((keywords & (1u << keywordIndex)) != 0)
+		{
+			defines += Stringf("#define %s\n", s_keywordNames[keywordIndex]);
+		}
+	}
+
+	size_t insertIndex = 0;
+	size_t versionIndex = variantSource.find("#version");
+
+	if (versionIndex != std::string::npos)
+	{
+		size_t lineEndIndex = variantSource.find('\n', versionIndex);
+
+		if (lineEndIndex == std::string::npos)
+		{
+			variantSource += '\n';
+			lineEndIndex = variantSource.size() - 1;
+		}
+
+		insertIndex = lineEndIndex + 1;
+	}
+
+	// GLSL 3.30 and up number the line after a #line as the given line
+	int nextLineNumber = (int) std::count(variantSource.begin(), variantSource.begin() + insertIndex, '\n') + 1;
+	defines += Stringf("#line %i\n", nextLineNumber);
+
+	variantSource.insert(insertIndex, defines);
+	return variantSource;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Folds the text into the FNV-1a hash, with a separator after it so moving text between two hashed
+// strings changes the hash
+//
+static uint64_t HashText(uint64_t hash, const char* text)
+{
+	if (text != nullptr)
+	{
+		for (const char* currChar = text; *currChar != NULL; ++currChar)
+		{
+			hash = (hash ^ (uint8_t) *currChar) * 1099511628211ull;
+		}
+	}
+
+	return (hash ^ 0xFF) * 1099511628211ull;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns a hash of the vendor, renderer and driver version strings; binaries are only good for the
+// driver that made them, so a driver update or a different GPU makes a new set instead of failing to load
+//
+static uint64_t GetDriverHash()
+{
+	static uint64_t s_driverHash = 0;
+
+	if (s_driverHash == 0)
+	{
+		s_driverHash = 14695981039346656037ull;
+		s_driverHash = HashText(s_driverHash, (const char*) glGetString(GL_VENDOR));
+		s_driverHash = HashText(s_driverHash, (const char*) glGetString(GL_RENDERER));
+		s_driverHash = HashText(s_driverHash, (const char*) glGetString(GL_VERSION));
+	}
+
+	return s_driverHash;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the cache key of the variant, a hash of the driver and both stages' sources
+//
+static uint64_t HashProgramSources(const char* vsSource, const char* fsSource)
+{
+	uint64_t hash = GetDriverHash();
+	hash = HashText(hash, vsSource);
+	hash = HashText(hash, fsSource);
+
+	return hash;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the path of the cached binary for the variant with the given key
+//
+static std::string GetProgramBinaryPath(uint64_t cacheKey)
+{
+	return Stringf("%s/%016llx.glbin", SHADER_BINARY_CACHE_DIRECTORY, cacheKey);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Creates a program from the cached binary for the variant, or returns 0 if there isn't one
+// Drivers can still reject a binary (e.g. on a driver string collision), so those are just compiled again and overwritten
+//
+static GLuint LoadCachedProgramBinary(uint64_t cacheKey)
+{
+	std::string binaryPath = GetProgramBinaryPath(cacheKey);
+
+	size_t fileSize = 0;
+	uint8_t* fileData = (uint8_t*) FileReadBinaryToNewBuffer(binaryPath.c_str(), fileSize);
+
+	if (fileData == nullptr)
+	{
+		return 0;
+	}
+
+	ProgramBinaryHeader_t header;
+	bool isValid = (fileSize > sizeof(ProgramBinaryHeader_t));
+
+	if (isValid)
+	{
+		memcpy(&header, fileData, sizeof(ProgramBinaryHeader_t));
+		isValid = (header.fourCC == PROGRAM_BINARY_FOURCC && header.cacheKey == cacheKey && header.driverHash == GetDriverHash());
+	}
+
+	GLuint program_id = 0;
+
+	if (isValid)
+	{
+		program_id = glCreateProgram();
+		GUARANTEE_OR_DIE( program_id != 0, "Error: Shader program could not be created");
+
+		GLsizei binarySize = (GLsizei) (fileSize - sizeof(ProgramBinaryHeader_t));
+		glProgramBinary(program_id, (GLenum) header.binaryFormat, fileData + sizeof(ProgramBinaryHeader_t), binarySize);
+
+		GLint link_status;
+		glGetProgramiv(program_id, GL_LINK_STATUS, &link_status);
+
+		if (link_status == GL_FALSE)
+		{
+			glDeleteProgram(program_id);
+			GLStateCache::OnProgramDeleted(program_id);
+			program_id = 0;
+		}
+	}
+
+	free(fileData);
+	return program_id;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the linked program's binary to the cache, for the next run to load instead of compiling
+//
+static void SaveProgramBinary(GLuint program_id, uint64_t cacheKey)
+{
+	GLint binaryLength = 0;
+	glGetProgramiv(program_id, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+
+	// Drivers without any binary formats report nothing to save
+	if (binaryLength <= 0)
+	{
+		return;
+	}
+
+	size_t fileSize = sizeof(ProgramBinaryHeader_t) + (size_t) binaryLength;
+	uint8_t* fileData = (uint8_t*) malloc(fileSize);
+
+	GLenum binaryFormat = 0;
+	GLsizei amountWritten = 0;
+	glGetProgramBinary(program_id, binaryLength, &amountWritten, &binaryFormat, fileData + sizeof(ProgramBinaryHeader_t));
+
+	if (amountWritten > 0)
+	{
+		ProgramBinaryHeader_t header;
+		header.fourCC = PROGRAM_BINARY_FOURCC;
+		header.binaryFormat = (uint32_t) binaryFormat;
+		header.cacheKey = cacheKey;
+		header.driverHash = GetDriverHash();
+		memcpy(fileData, &header, sizeof(ProgramBinaryHeader_t));
+
+		CreateDirectoryA("Cache", NULL);
+		CreateDirectoryA(SHADER_BINARY_CACHE_DIRECTORY, NULL);
+
+		std::string binaryPath = GetProgramBinaryPath(cacheKey);
+		FILE* fp = OpenFile(binaryPath.c_str(), "wb");
+
+		if (fp != nullptr)
+		{
+			fwrite(fileData, 1, sizeof(ProgramBinaryHeader_t) + (size_t) amountWritten, fp);
+			CloseFile(fp);
+		}
+	}
+
+	free(fileData);
+}
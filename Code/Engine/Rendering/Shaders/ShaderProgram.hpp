@@ -9,10 +9,45 @@
 #pragma once
 #include <map>
 #include <string>
+#include <vector>
+#include <stdint.h>
 
 class ShaderDescription;
 class PropertyBlockDescription;
 
+// Linked programs are saved here keyed by a hash of their sources, so later runs load the driver's
+// binary instead of compiling GLSL; outside Data/ so it's never packed, and safe to delete at any time
+#define SHADER_BINARY_CACHE_DIRECTORY "Cache/Shaders"
+
+// Keywords a variant of a program is compiled with, each #defined by name in both stages right after
+// #version, so one source covers every combination through #ifdef
+enum eShaderKeyword : uint32_t
+{
+	SHADER_KEYWORD_INSTANCED	= (1 << 0),		// Model matrix comes from the INSTANCE_MODEL_MATRIX attribute instead of the model UBO
+	SHADER_KEYWORD_SKINNED		= (1 << 1),
+	SHADER_KEYWORD_LIT			= (1 << 2),
+	SHADER_KEYWORD_SHADOWED		= (1 << 3),
+	NUM_SHADER_KEYWORDS			= 4
+};
+
+typedef uint32_t ShaderKeywords;
+#define SHADER_KEYWORDS_NONE (0)
+
+// Reflected once the program links, so binding to it never has to ask GL
+struct ShaderAttribute_t
+{
+	std::string		name;
+	int				location = -1;
+	unsigned int	glType = 0;			// A matrix takes a location per column, starting at its location
+};
+
+struct ShaderSampler_t
+{
+	std::string		name;
+	int				textureUnit = -1;	// From the shader's layout(binding = ...)
+	unsigned int	glType = 0;
+};
+
 class ShaderProgram
 {
 public:
@@ -24,29 +59,84 @@ public:
 	ShaderProgram* Clone() const;
 
 	// Loads the shaders given by rootName, compiles them, and links them to this program
-	bool LoadProgramFromFiles(const char *rootName);
-	bool LoadProgramFromFiles(const char* vsFilepath, const char* fsFilepath);
+	bool LoadProgramFromFiles(const char *rootName, ShaderKeywords keywords = SHADER_KEYWORDS_NONE);
+	bool LoadProgramFromFiles(const char* vsFilepath, const char* fsFilepath, ShaderKeywords keywords = SHADER_KEYWORDS_NONE);
 
 	// Loads the shaders from the string literal source code provided, and links them to this program
-	bool LoadProgramFromSources(const char *vertexShaderSource, const char* fragmentShaderSource, bool flagAsSourceShader);
+	bool LoadProgramFromSources(const char *vertexShaderSource, const char* fragmentShaderSource, bool flagAsSourceShader, ShaderKeywords keywords = SHADER_KEYWORDS_NONE);
+
+	// Programs loaded between these have their compiles and links issued right away, but aren't checked until
+	// the end, so the driver can work on all of them at once instead of one at a time
+	// Main thread only, and the programs can't be used until EndParallelCompile() returns
+	static void BeginParallelCompile();
+	static void EndParallelCompile();
+
+	// Issues the compile and link without waiting on them; the program keeps using what it had, or the invalid
+	// program if it had nothing, until UpdateAsyncCompiles() sees the link is done and swaps the new one in
+	// Errors are reported, and the invalid program assigned, at that point as they would be for a blocking load
+	bool LoadProgramFromFilesAsync(const char* vsFilepath, const char* fsFilepath, ShaderKeywords keywords = SHADER_KEYWORDS_NONE);
+	bool IsAsyncCompilePending() const;
+
+	// Called by the Renderer each frame; drivers without ARB_parallel_shader_compile can't be asked whether a link is
+	// done without waiting on it, so there the programs are finished the frame after they're issued
+	static void UpdateAsyncCompiles();
+	static int	GetPendingAsyncCompileCount();
+
+	// Keywords are given by name, separated by commas (e.g. "INSTANCED, LIT")
+	static ShaderKeywords	ParseKeywords(const std::string& keywordText);
+	static const char*		GetKeywordName(eShaderKeyword keyword);
 
 	// Accessors
 	const std::string&	GetName() const;
 	unsigned int		GetHandle() const;
 	const std::string&	GetVSFilePathOrSource() const;
 	const std::string&	GetFSFilePathOrSource() const;
+	ShaderKeywords		GetKeywords() const;
 
 	const ShaderDescription* GetUniformDescription() const;
 
+	// Reflection - tables filled when the program links, nothing here queries GL
+	int							GetAttributeLocation(const std::string& name) const;	// -1 if the program doesn't read it
+	int							GetAttributeCount() const;
+	const ShaderAttribute_t&	GetAttribute(int index) const;
+	int							GetSamplerCount() const;
+	const ShaderSampler_t&		GetSampler(int index) const;
+	bool						UsesBlockBinding(unsigned int blockBinding) const;
+
 	bool WasBuiltFromSource() const;
 
 
+private:
+	//-----Private Types-----
+
+	// A program whose compile and link have been issued, but not checked
+	struct PendingProgram_t
+	{
+		ShaderProgram*	program = nullptr;
+		unsigned int	programHandle = 0;		// Swapped in once finished
+		unsigned int	vsHandle = 0;			// 0 for programs loaded from the binary cache
+		unsigned int	fsHandle = 0;
+		uint64_t		cacheKey = 0;
+		std::string		vsFilePath;				// Only for reporting errors, empty for built-in sources
+		std::string		fsFilePath;
+	};
+
+
 private:
 	//-----Private Methods-----
 
+	// Gets the program handle from the binary cache, or else issues the compile and link of the sources with the
+	// keywords defined, to be checked and cached by FinishProgram(); the program keeps its current handle until then
+	PendingProgram_t	BeginProgramFromFiles(const char* vsFilePath, const char* fsFilePath, ShaderKeywords keywords);
+	PendingProgram_t	BeginProgramFromSources(const char* vsSource, const char* fsSource, const std::string& vsFilePath, const std::string& fsFilePath, ShaderKeywords keywords);
+	bool				FinishProgram(PendingProgram_t& pending);
+	void				CancelAsyncCompile();
+
 	// Shader reflection
 	void SetupPropertyBlockInfos();
 	void FillBlockProperties(PropertyBlockDescription* blockInfo, int blockIndex);
+	void SetupAttributeInfos();
+	void SetupSamplerInfos();
 
 
 private:
@@ -62,6 +152,15 @@ private:
 	std::string m_fsFilePathOrSource;
 
 	bool m_areFilepaths = false;
+	ShaderKeywords m_keywords = SHADER_KEYWORDS_NONE;
 
 	ShaderDescription* m_uniformDescription = nullptr;
+
+	std::vector<ShaderAttribute_t>	m_attributes;
+	std::vector<ShaderSampler_t>	m_samplers;
+	uint32_t						m_blockBindingMask = 0;		// Bit per uniform block binding the program reads, bindings past 31 are always set
+
+	static bool								s_isCompilingInParallel;
+	static std::vector<PendingProgram_t>	s_pendingPrograms;		// Finished by EndParallelCompile()
+	static std::vector<PendingProgram_t>	s_asyncPrograms;		// Finished by UpdateAsyncCompiles() as they're done
 };
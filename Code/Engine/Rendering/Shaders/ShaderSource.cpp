@@ -31,9 +31,25 @@ const char* ShaderSource::DEFAULT_OPAQUE_VS = R"(
 		mat4 PROJECTION;
 	};
 	
+	// INSTANCED variants take the model matrix per instance instead of per draw, and custom data that's white unless the draw streams it
+	#ifdef INSTANCED
+	in mat4 INSTANCE_MODEL_MATRIX;
+	in vec4 INSTANCE_CUSTOM_DATA;
+	#define MODEL_MATRIX INSTANCE_MODEL_MATRIX
+	#else
 	layout(binding=2, std140) uniform modelUBO
 	{
 		mat4 MODEL;
+	};
+	#define MODEL_MATRIX MODEL
+	#endif
+
+	layout(binding=5, std140) uniform meshUBO
+	{
+		vec3	POSITION_OFFSET;		// Quantized positions decode to POSITION_OFFSET + POSITION_SCALE * POSITION
+		float	HAS_OCTAHEDRAL_NORMALS;
+		vec3	POSITION_SCALE;
+		float	MESH_PADDING_0;
 	};
 																												
 	in vec3 POSITION;												
@@ -45,8 +61,8 @@ const char* ShaderSource::DEFAULT_OPAQUE_VS = R"(
 																														
 	void main( void )												
 	{																										
-		vec4 world_pos = vec4( POSITION, 1 ); 						
-		vec4 clip_pos = PROJECTION * VIEW * MODEL * world_pos; 				
+		vec4 world_pos = vec4( POSITION_OFFSET + POSITION_SCALE * POSITION, 1 ); 						
+		vec4 clip_pos = PROJECTION * VIEW * MODEL_MATRIX * world_pos; 				
 																	
 		passUV = UV;												
 		passColor = COLOR;											
@@ -103,52 +119,8 @@ const RenderState ShaderSource::DEFAULT_ALPHA_STATE = RenderState(
 //
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------
 const char* ShaderSource::DEFAULT_OPAQUE_INSTANCED_NAME = "Default_Opaque_Instanced";
-const char* ShaderSource::DEFAULT_OPAQUE_INSTANCED_VS = R"(
-
-	#version 420 core												
-	
-	layout(binding=1, std140) uniform cameraUBO
-	{
-		mat4 VIEW;
-		mat4 PROJECTION;
-	};
-																												
-	in vec3 POSITION;												
-	in vec4 COLOR;													
-	in vec2 UV;	
-	in mat4 INSTANCE_MODEL_MATRIX;													
-																	
-	out vec2 passUV;												
-	out vec4 passColor;												
-																														
-	void main( void )												
-	{																										
-		vec4 world_pos = vec4( POSITION, 1 ); 						
-		vec4 clip_pos = PROJECTION * VIEW * INSTANCE_MODEL_MATRIX * world_pos; 				
-																	
-		passUV = UV;												
-		passColor = COLOR;											
-		gl_Position = clip_pos; 								
-	})";
-
-const char* ShaderSource::DEFAULT_OPAQUE_INSTANCED_FS = R"(
-	
-	#version 420 core											
-																											
-	in vec2 passUV;												
-	in vec4 passColor;											
-																  										
-	layout(binding = 0) uniform sampler2D gTexDiffuse;			
-																												
-	out vec4 outColor; 											
-																
-	// Entry Point												
-	void main( void )											
-	{																																			
-		vec4 diffuse = texture(gTexDiffuse, passUV);	
-		outColor = diffuse * passColor;	 				
-	})";
-
+const char* ShaderSource::DEFAULT_OPAQUE_INSTANCED_VS = ShaderSource::DEFAULT_OPAQUE_VS;	// Same sources, compiled with SHADER_KEYWORD_INSTANCED
+const char* ShaderSource::DEFAULT_OPAQUE_INSTANCED_FS = ShaderSource::DEFAULT_OPAQUE_FS;
 const RenderState ShaderSource::DEFAULT_OPAQUE_INSTANCED_STATE;
 
 
@@ -296,6 +268,36 @@ const RenderState ShaderSource::UI_SHADER_STATE = RenderState(
 	BLEND_FACTOR_ONE_MINUS_SOURCE_ALPHA		// Alpha destination factor
 );
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+//
+// Signed Distance Field Font Shader
+//
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+const char* ShaderSource::UI_SDF_SHADER_NAME = "UI_SDF";
+const char* ShaderSource::UI_SDF_SHADER_FS = R"(
+	
+	#version 420 core											
+																											
+	in vec2 passUV;												
+	in vec4 passColor;											
+																  										
+	// Alpha is the distance to the glyph's edge, 0.5 on it
+	layout(binding = 0) uniform sampler2D gTexDiffuse;			
+																												
+	out vec4 outColor; 											
+																
+	// Entry Point												
+	void main( void )											
+	{
+		float distance = texture(gTexDiffuse, passUV).a;
+
+		// Antialias over about a screen pixel, whatever size the glyph is drawn at
+		float edgeWidth = max(fwidth(distance) * 0.5, 0.0001);
+		float coverage = smoothstep(0.5 - edgeWidth, 0.5 + edgeWidth, distance);
+
+		outColor = vec4(passColor.rgb, passColor.a * coverage);
+	})";
+
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------
 //
 // Invalid Shader
@@ -481,9 +483,25 @@ layout(binding=1, std140) uniform cameraUBO
 	float	PADDING_3;
 };
 
+// INSTANCED variants take the model matrix per instance instead of per draw, and custom data that's white unless the draw streams it
+#ifdef INSTANCED
+in mat4 INSTANCE_MODEL_MATRIX;
+in vec4 INSTANCE_CUSTOM_DATA;
+#define MODEL_MATRIX INSTANCE_MODEL_MATRIX
+#else
 layout(binding=2, std140) uniform modelUBO
 {
 	mat4 MODEL;
+};
+#define MODEL_MATRIX MODEL
+#endif
+
+layout(binding=5, std140) uniform meshUBO
+{
+	vec3	POSITION_OFFSET;		// Quantized positions decode to POSITION_OFFSET + POSITION_SCALE * POSITION
+	float	HAS_OCTAHEDRAL_NORMALS;
+	vec3	POSITION_SCALE;
+	float	MESH_PADDING_0;
 };
 																											
 in vec3 POSITION;												
@@ -499,10 +517,20 @@ out mat4 passTBNTransform;
 out vec3 passEyePosition;
 
 																									
+// Unfolds a direction from the octahedral encoding the packed vertex types use
+vec3 DecodeOctahedral(vec2 encoded)
+{
+	vec3 direction = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+	float fold = max(-direction.z, 0.0);
+	direction.x += (direction.x >= 0.0 ? -fold : fold);
+	direction.y += (direction.y >= 0.0 ? -fold : fold);
+	return normalize(direction);
+}
+
 void main( void )												
 {						
-	vec4 localPosition = vec4(POSITION, 1);																				
-	vec4 worldPosition = MODEL * localPosition; 						
+	vec4 localPosition = vec4(POSITION_OFFSET + POSITION_SCALE * POSITION, 1);																				
+	vec4 worldPosition = MODEL_MATRIX * localPosition; 						
 	vec4 clipPosition = PROJECTION * VIEW * worldPosition; 				
 																
 	passUV = UV;												
@@ -510,10 +538,19 @@ void main( void )
 
 	passWorldPosition = worldPosition.xyz;
 
+	// Packed vertices store the tangent's w in z
+	vec3 normal = NORMAL;
+	vec4 tangent = TANGENT;
+	if (HAS_OCTAHEDRAL_NORMALS > 0.5)
+	{
+		normal = DecodeOctahedral(NORMAL.xy);
+		tangent = vec4(DecodeOctahedral(TANGENT.xy), TANGENT.z);
+	}
+
 	// Calculate the TBN transform
-	vec3 worldNormal = normalize((MODEL * vec4(NORMAL, 0.f)).xyz);
-	vec3 worldTangent = normalize((MODEL * vec4(TANGENT.xyz, 0.f)).xyz);
-	vec3 worldBitangent = cross(worldTangent, worldNormal) * TANGENT.w;
+	vec3 worldNormal = normalize((MODEL_MATRIX * vec4(normal, 0.f)).xyz);
+	vec3 worldTangent = normalize((MODEL_MATRIX * vec4(tangent.xyz, 0.f)).xyz);
+	vec3 worldBitangent = cross(worldTangent, worldNormal) * tangent.w;
 
 	passTBNTransform = mat4(vec4(worldTangent, 0.f), vec4(worldBitangent, 0.f), vec4(worldNormal, 0.f), vec4(passWorldPosition, 1.0f));
 	passEyePosition = CAMERA_POSITION;
@@ -524,8 +561,10 @@ void main( void )
 
 const char* ShaderSource::PHONG_OPAQUE_FS = R"(
 	
-	#version 420 core											
+	#version 430 core											
 	#define MAX_LIGHTS 8
+	#define SHADOW_CASCADE_COUNT 4
+	#define SHADOW_CASCADE_ATLAS_WIDTH 2
 																										
 	layout(binding = 0) uniform sampler2D gTexDiffuse;			
 	layout(binding = 1) uniform sampler2D gTexNormal;
@@ -540,7 +579,7 @@ const char* ShaderSource::PHONG_OPAQUE_FS = R"(
 		vec3 m_attenuationFactors;
 		float m_directionFactor;
 		vec4 m_color;
-		mat4 m_shadowVP;
+		mat4 m_shadowVP[SHADOW_CASCADE_COUNT];
 		vec3 m_padding;
 		float m_castsShadows;
 	};
@@ -551,6 +590,30 @@ const char* ShaderSource::PHONG_OPAQUE_FS = R"(
 		Light LIGHTS[MAX_LIGHTS];
 	};	
 
+	// The camera's light clusters, set by the ForwardRenderingPath (dimensions are 0 if not set)
+	layout(binding=6, std430) readonly buffer lightClusterSSBO
+	{
+		uvec4 CLUSTER_DIMENSIONS;		// xyz cluster counts
+		mat4 CLUSTER_VIEW_PROJECTION;
+		vec4 CLUSTER_NEAR_PLANE;		// xyz unit normal into the view, w distance
+		vec4 CLUSTER_DEPTH_PARAMS;		// x first slice depth, y 1 / log(slice depth ratio)
+		uint CLUSTER_DATA[];			// (first entry, count) per cluster, then the light index entries
+	};
+	
+	layout(binding=7, std430) readonly buffer clusterLightSSBO
+	{
+		Light CLUSTER_LIGHTS[];
+	};
+
+	// The scene's baked lights as L2 spherical harmonics irradiance, set by the ForwardRenderingPath (PROBE_VOLUME_MINS.w is 0 if not set)
+	layout(binding=18, std430) readonly buffer lightProbeSSBO
+	{
+		vec4 PROBE_VOLUME_MINS;			// xyz relative to the render origin
+		vec4 PROBE_INVERSE_CELL_SIZE;	// xyz, 0 on axes with a single probe
+		uvec4 PROBE_DIMENSIONS;			// xyz probe counts
+		vec4 PROBE_COEFFICIENTS[];		// 9 per probe, x fastest then y then z
+	};
+
 	layout(binding=8, std140) uniform specularUBO
 	{
 		float SPECULAR_AMOUNT;
@@ -623,16 +686,126 @@ const char* ShaderSource::PHONG_OPAQUE_FS = R"(
 			return 1.0f;
 		}
 
-		vec4 clipPos = light.m_shadowVP * vec4(fragPosition, 1.0f);
-		vec3 ndcPos = clipPos.xyz / clipPos.w;
+		// Use the first (highest resolution) cascade that contains the fragment
+		for (int cascadeIndex = 0; cascadeIndex < SHADOW_CASCADE_COUNT; ++cascadeIndex)
+		{
+			vec4 clipPos = light.m_shadowVP[cascadeIndex] * vec4(fragPosition, 1.0f);
+			vec3 ndcPos = clipPos.xyz / clipPos.w;
+
+			if (all(lessThanEqual(abs(ndcPos), vec3(1))))
+			{
+				ndcPos = (ndcPos + vec3(1)) * 0.5f;
+
+				// Cascades are laid out in a grid across the shadow texture
+				vec2 atlasCell = vec2(cascadeIndex % SHADOW_CASCADE_ATLAS_WIDTH, cascadeIndex / SHADOW_CASCADE_ATLAS_WIDTH);
+				vec2 atlasUV = (ndcPos.xy + atlasCell) / float(SHADOW_CASCADE_ATLAS_WIDTH);
 
-		ndcPos = (ndcPos + vec3(1)) * 0.5f;
+				float shadowDepth = texture(gShadowDepth, atlasUV).r;
+
+				return ndcPos.z - 0.001 > shadowDepth ? 0.f : 1.f;
+			}
+		}
 
-		float shadowDepth = texture(gShadowDepth, ndcPos.xy).r;
+		// Outside of every cascade
+		return 1.0f;
+	}
+	
+	// Returns where the light indices for the cluster containing the position are in CLUSTER_DATA, as (first, count)
+	uvec2 GetClusterLightRange(vec3 worldPosition)
+	{
+		// No clusters are set outside of the ForwardRenderingPath
+		if (CLUSTER_DIMENSIONS.x == 0)
+		{
+			return uvec2(0);
+		}
+	
+		vec4 clipPosition = CLUSTER_VIEW_PROJECTION * vec4(worldPosition, 1.0f);
+		vec2 ndcPosition = clipPosition.xy / clipPosition.w;
+		vec2 gridSize = vec2(CLUSTER_DIMENSIONS.xy);
+		uvec2 tile = uvec2(clamp((ndcPosition * 0.5f + vec2(0.5f)) * gridSize, vec2(0), gridSize - vec2(1)));
+	
+		// Slices are exponentially deeper away from the near plane, after a first slice of fixed depth
+		float depth = dot(CLUSTER_NEAR_PLANE.xyz, worldPosition) + CLUSTER_NEAR_PLANE.w;
+		uint slice = 0;
+	
+		if (depth > CLUSTER_DEPTH_PARAMS.x)
+		{
+			slice = min(uint(log(depth / CLUSTER_DEPTH_PARAMS.x) * CLUSTER_DEPTH_PARAMS.y) + 1, CLUSTER_DIMENSIONS.z - 1);
+		}
+	
+		uint clusterIndex = (slice * CLUSTER_DIMENSIONS.y + tile.y) * CLUSTER_DIMENSIONS.x + tile.x;
+		return uvec2(CLUSTER_DATA[2 * clusterIndex], CLUSTER_DATA[2 * clusterIndex + 1]);
+	}
+	
+	
+	// Returns one probe's irradiance for a surface facing along the normal
+	vec3 EvaluateLightProbe(uint probeIndex, vec3 n)
+	{
+		uint first = probeIndex * 9u;
+
+		vec3 irradiance = PROBE_COEFFICIENTS[first + 0u].xyz * 0.282095f
+			+ PROBE_COEFFICIENTS[first + 1u].xyz * (0.488603f * n.y)
+			+ PROBE_COEFFICIENTS[first + 2u].xyz * (0.488603f * n.z)
+			+ PROBE_COEFFICIENTS[first + 3u].xyz * (0.488603f * n.x)
+			+ PROBE_COEFFICIENTS[first + 4u].xyz * (1.092548f * n.x * n.y)
+			+ PROBE_COEFFICIENTS[first + 5u].xyz * (1.092548f * n.y * n.z)
+			+ PROBE_COEFFICIENTS[first + 6u].xyz * (0.315392f * (3.f * n.z * n.z - 1.f))
+			+ PROBE_COEFFICIENTS[first + 7u].xyz * (1.092548f * n.x * n.z)
+			+ PROBE_COEFFICIENTS[first + 8u].xyz * (0.546274f * (n.x * n.x - n.y * n.y));
+
+		return max(irradiance, vec3(0));
+	}
+	
+	// Returns the baked irradiance at the position, blended between the 8 closest probes and clamped to the volume
+	vec3 SampleLightProbes(vec3 worldPosition, vec3 normal)
+	{
+		if (PROBE_VOLUME_MINS.w == 0.f)
+		{
+			return vec3(0);
+		}
+	
+		uvec3 maxCoords = PROBE_DIMENSIONS.xyz - uvec3(1);
+		vec3 gridCoords = clamp((worldPosition - PROBE_VOLUME_MINS.xyz) * PROBE_INVERSE_CELL_SIZE.xyz, vec3(0), vec3(maxCoords));
+		uvec3 baseCoords = uvec3(gridCoords);
+		vec3 fractions = gridCoords - vec3(baseCoords);
+	
+		vec3 irradiance = vec3(0);
+		for (uint corner = 0u; corner < 8u; ++corner)
+		{
+			uvec3 offsets = uvec3(corner & 1u, (corner >> 1) & 1u, (corner >> 2) & 1u);
+			vec3 weights = mix(vec3(1) - fractions, fractions, vec3(offsets));
+			uvec3 coords = min(baseCoords + offsets, maxCoords);
+	
+			uint probeIndex = (coords.z * PROBE_DIMENSIONS.y + coords.y) * PROBE_DIMENSIONS.x + coords.x;
+			irradiance += weights.x * weights.y * weights.z * EvaluateLightProbe(probeIndex, normal);
+		}
+	
+		return irradiance;
+	}
+	
+	// Adds the contribution of a single light to the accumulated lighting
+	void AddLightContribution(Light light, vec3 worldNormal, vec3 directionToEye, inout vec3 surfaceLight, inout vec3 reflectedLight)
+	{
+		// Directions to the light
+		vec3 directionToLight = mix(-light.m_direction, normalize(light.m_position - passWorldPosition), light.m_directionFactor);
+	
+		// Attenuation
+		float attenuation = CalculateAttenuation(light.m_position, light.m_attenuationFactors, light.m_color.w);
+	
+		// Cone factor
+		float coneFactor = CalculateConeFactor(light.m_position, light.m_direction, light.m_dotOuterAngle, light.m_dotInnerAngle);
+	
+	
+		//-------------STEP 2: Add in the diffuse light from all lights------------	
+		float shadowFactor = CalculateShadowFactor(passWorldPosition, worldNormal, light);
 
-		return ndcPos.z - 0.001 > shadowDepth ? 0.f : 1.f;
+		surfaceLight += shadowFactor * CalculateDot3(directionToLight, worldNormal, light.m_color, attenuation, coneFactor);
+		
+		//-----STEP 3: Calculate and add in specular lighting from all lights----------
+		reflectedLight += shadowFactor * CalculateSpecular(directionToLight, worldNormal, directionToEye, light.m_color, attenuation, coneFactor);
 	}
 	
+	
 	// Entry point															
 	void main( void )											
 	{				
@@ -649,28 +822,14 @@ const char* ShaderSource::PHONG_OPAQUE_FS = R"(
 		vec3 surfaceLight = vec3(0);	// How much light is hitting the surface
 		vec3 reflectedLight = vec3(0);	// How much light is being reflected back
 	
-		//----------STEP 1: Add in the ambient light to the surface light----------
-		surfaceLight = AMBIENT.xyz * AMBIENT.w;
+		//----------STEP 1: Add in the ambient light and the baked lights to the surface light----------
+		surfaceLight = AMBIENT.xyz * AMBIENT.w + SampleLightProbes(passWorldPosition, worldNormal);
 	
-		for (int lightIndex = 0; lightIndex < MAX_LIGHTS; ++lightIndex)
+		// Add in every light reaching this fragment's cluster
+		uvec2 clusterLights = GetClusterLightRange(passWorldPosition);
+		for (uint entryIndex = clusterLights.x; entryIndex < clusterLights.x + clusterLights.y; ++entryIndex)
 		{
-			// Directions to the light
-			vec3 directionToLight = mix(-LIGHTS[lightIndex].m_direction, normalize(LIGHTS[lightIndex].m_position - passWorldPosition), LIGHTS[lightIndex].m_directionFactor);
-	
-			// Attenuation
-			float attenuation = CalculateAttenuation(LIGHTS[lightIndex].m_position, LIGHTS[lightIndex].m_attenuationFactors, LIGHTS[lightIndex].m_color.w);
-	
-			// Cone factor
-			float coneFactor = CalculateConeFactor(LIGHTS[lightIndex].m_position, LIGHTS[lightIndex].m_direction, LIGHTS[lightIndex].m_dotOuterAngle, LIGHTS[lightIndex].m_dotInnerAngle);
-	
-	
-			//-------------STEP 2: Add in the diffuse light from all lights------------	
-			float shadowFactor = CalculateShadowFactor(passWorldPosition, worldNormal, LIGHTS[lightIndex]);
-
-			surfaceLight += shadowFactor * CalculateDot3(directionToLight, worldNormal, LIGHTS[lightIndex].m_color, attenuation, coneFactor);
-			
-			//-----STEP 3: Calculate and add in specular lighting from all lights----------
-			reflectedLight += shadowFactor * CalculateSpecular(directionToLight, worldNormal, directionToEye, LIGHTS[lightIndex].m_color, attenuation, coneFactor);
+			AddLightContribution(CLUSTER_LIGHTS[CLUSTER_DATA[entryIndex]], worldNormal, directionToEye, surfaceLight, reflectedLight);
 		}
 	
 	
@@ -719,293 +878,72 @@ const RenderState ShaderSource::PHONG_ALPHA_STATE = RenderState(
 //
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------
 const char* ShaderSource::PHONG_OPAQUE_INSTANCED_NAME = "Phong_Opaque_Instanced";
-const char* ShaderSource::PHONG_OPAQUE_INSTANCED_VS = R"(
-	
-	#version 420 core												
-	
-	layout(binding=1, std140) uniform cameraUBO
-	{
-		mat4 VIEW;
-		mat4 PROJECTION;
-	
-		mat4 CAMERA_MATRIX;
+const char* ShaderSource::PHONG_OPAQUE_INSTANCED_VS = ShaderSource::PHONG_OPAQUE_VS;	// Same sources, compiled with SHADER_KEYWORD_INSTANCED
+const char* ShaderSource::PHONG_OPAQUE_INSTANCED_FS = ShaderSource::PHONG_OPAQUE_FS;
+const RenderState ShaderSource::PHONG_OPAQUE_INSTANCED_STATE = ShaderSource::PHONG_OPAQUE_STATE;
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+//
+// Phong Alpha Instanced
+//
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+const char* ShaderSource::PHONG_ALPHA_INSTANCED_NAME = "Phong_Alpha_Instanced";
+const char* ShaderSource::PHONG_ALPHA_INSTANCED_VS = ShaderSource::PHONG_OPAQUE_INSTANCED_VS;											 
+const char* ShaderSource::PHONG_ALPHA_INSTANCED_FS = ShaderSource::PHONG_OPAQUE_INSTANCED_FS;	
+const RenderState ShaderSource::PHONG_ALPHA_INSTANCED_STATE = ShaderSource::PHONG_ALPHA_STATE;
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+//
+// Vertex Normal
+//
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+const char* ShaderSource::VERTEX_NORMAL_NAME = "Vertex_Normal";
+const char* ShaderSource::VERTEX_NORMAL_VS = R"(
 	
-		vec3	CAMERA_RIGHT;
-		float	PADDING_0;
-		vec3	CAMERA_UP;
-		float	PADDING_1;
-		vec3	CAMERA_FORWARD;
-		float	PADDING_2;
-		vec3	CAMERA_POSITION;
-		float	PADDING_3;
-	};
+#version 420 core												
+
+layout(binding=1, std140) uniform cameraUBO
+{
+	mat4 VIEW;
+	mat4 PROJECTION;
+
+	mat4 CAMERA_MATRIX;
+
+	vec3	CAMERA_RIGHT;
+	float	PADDING_0;
+	vec3	CAMERA_UP;
+	float	PADDING_1;
+	vec3	CAMERA_FORWARD;
+	float	PADDING_2;
+	vec3	CAMERA_POSITION;
+	float	PADDING_3;
+};
+
+layout(binding=2, std140) uniform modelUBO
+{
+	mat4 MODEL;
+};
 																												
-	in vec3 POSITION;												
-	in vec4 COLOR;													
-	in vec2 UV;	
-	in vec3 NORMAL;	
-	in vec4 TANGENT;												
-	in mat4 INSTANCE_MODEL_MATRIX;													
-																
-	out vec2 passUV;												
-	out vec4 passColor;
-	out vec3 passWorldPosition; // For determining light direction
-	out mat4 passTBNTransform;					
-	out vec3 passEyePosition;
-	
-																										
-	void main( void )												
-	{						
-		vec4 localPosition = vec4(POSITION, 1);																				
-		vec4 worldPosition = INSTANCE_MODEL_MATRIX * localPosition; 						
-		vec4 clipPosition = PROJECTION * VIEW * worldPosition; 				
-																	
-		passUV = UV;												
-		passColor = COLOR;
-	
-		passWorldPosition = worldPosition.xyz;
-	
-		// Calculate the TBN transform
-		vec3 worldNormal = normalize((INSTANCE_MODEL_MATRIX * vec4(NORMAL, 0.f)).xyz);
-		vec3 worldTangent = normalize((INSTANCE_MODEL_MATRIX * vec4(TANGENT.xyz, 0.f)).xyz);
-		vec3 worldBitangent = cross(worldTangent, worldNormal) * TANGENT.w;
-	
-		passTBNTransform = mat4(vec4(worldTangent, 0.f), vec4(worldBitangent, 0.f), vec4(worldNormal, 0.f), vec4(passWorldPosition, 1.0f));
-		passEyePosition = CAMERA_POSITION;
-	
-		gl_Position = clipPosition; 
-										
-	})";			
+in vec3 POSITION;																								
+in vec3 NORMAL;													
+																												
+out vec3 passVertexNormal;					
+																											
+void main( void )												
+{						
+	vec4 localPosition = vec4(POSITION, 1);																				
+	vec4 worldPosition = MODEL * localPosition; 						
+	vec4 clipPosition = PROJECTION * VIEW * worldPosition; 				
 
-const char* ShaderSource::PHONG_OPAQUE_INSTANCED_FS = R"(
-	
-	#version 420 core											
-	#define MAX_LIGHTS 8
-																										
-	layout(binding = 0) uniform sampler2D gTexDiffuse;			
-	layout(binding = 1) uniform sampler2D gTexNormal;
-	layout(binding = 8) uniform sampler2D gShadowDepth;
+	passVertexNormal = (MODEL * vec4(NORMAL, 0.f)).xyz;															
 
-	struct Light
-	{
-		vec3 m_position;
-		float m_dotOuterAngle;
-		vec3 m_direction;
-		float m_dotInnerAngle;
-		vec3 m_attenuationFactors;
-		float m_directionFactor;
-		vec4 m_color;
-		mat4 m_shadowVP;
-		vec3 m_padding;
-		float m_castsShadows;
-	};
-	
-	layout(binding=3, std140) uniform lightUBO
-	{
-		vec4 AMBIENT;							// xyz color, w intensity
-		Light LIGHTS[MAX_LIGHTS];
-	};	
-	
-	layout(binding=8, std140) uniform specularUBO
-	{
-		float SPECULAR_AMOUNT;
-		float SPECULAR_POWER;
-		vec2 PADDING_4;
-	};
-	
-	in vec2 passUV;												
-	in vec4 passColor;											
-	
-	in vec3 passEyePosition;
-	in vec3 passWorldPosition;
-	in mat4 passTBNTransform;
-	
-	out vec4 outColor;
-	
-	//---------------------------------------------------Functions-----------------------------------------------------------------
-	
-	// Calculates the normal given the surface normal color sample and the TBN transformation
-	vec3 CalculateWorldNormal(vec4 color)
-	{
-		// Range map the values (Z should be between 0.5 and 1.0 always
-		vec3 surfaceNormal = normalize(2.f * color.xyz - vec3(1));
-		vec3 worldNormal = (passTBNTransform * vec4(surfaceNormal, 0.f)).xyz;
-	
-		return worldNormal;
-	}
-	
-	// Calculates the attenuation factor for the given light information
-	float CalculateAttenuation(vec3 lightPosition, vec3 attenuationFactors, float intensity)
-	{
-		float distance = length(lightPosition - passWorldPosition);
-		float denominator = attenuationFactors.x + attenuationFactors.y * distance + attenuationFactors.z * distance * distance;
-		float attenuation = (intensity / denominator);
-	
-		return attenuation;
-	} 	
-	
-	
-	// Calculates the cone factor (= 1.f for directional and point lights, 0.f <= x <= 1.f for spot lights)
-	float CalculateConeFactor(vec3 lightPosition, vec3 lightDirection, float outerDotThreshold, float innerDotThreshold)
-	{
-		float dotFactor = dot(normalize(passWorldPosition - lightPosition), lightDirection);
-		float coneFactor = smoothstep(outerDotThreshold, innerDotThreshold, dotFactor);
-	
-		return coneFactor;
-	}			
-	
-	
-	// Calculates the diffuse factor for the 
-	vec3 CalculateDot3(vec3 directionToLight, vec3 normal, vec4 lightColor, float attenuation, float coneFactor)
-	{
-		vec3 dot3 = (max(0.f, dot(directionToLight, normal)) * lightColor.xyz * lightColor.w * attenuation * coneFactor);
-		return dot3;
-	}
-	
-	vec3 CalculateSpecular(vec3 directionToLight, vec3 normal, vec3 directionToEye, vec4 lightColor, float attenuation, float coneFactor)
-	{
-		vec3 reflect = reflect(-directionToLight, normal);
-		float factor = max(0, dot(directionToEye, reflect));
-		vec3 specular = SPECULAR_AMOUNT * pow(factor, SPECULAR_POWER) * lightColor.xyz * lightColor.w * attenuation * coneFactor;
-		
-		return specular;
-	}
-	
-	float CalculateShadowFactor(vec3 fragPosition, vec3 normal, Light light)
-	{
-		if (light.m_castsShadows == 0.f)
-		{
-			return 1.0f;
-		}
-
-		vec4 clipPos = light.m_shadowVP * vec4(fragPosition, 1.0f);
-		vec3 ndcPos = clipPos.xyz / clipPos.w;
-
-		ndcPos = (ndcPos + vec3(1)) * 0.5f;
-
-		float shadowDepth = texture(gShadowDepth, ndcPos.xy).r;
-
-		return ndcPos.z - 0.001 > shadowDepth ? 0.f : 1.f;
-	}
-	
-	// Entry point															
-	void main( void )											
-	{				
-		//----------------------------SET UP VALUES-------------------------------		
-		vec4 surfaceColor = texture(gTexDiffuse, passUV);
-		vec3 directionToEye = normalize(passEyePosition - passWorldPosition);
-	
-		// Get the normal from the normal map, and transform it into TBN space
-		vec4 normalColor = texture(gTexNormal, passUV);
-		vec3 worldNormal = CalculateWorldNormal(normalColor);	
-	
-		// Calculate the direction TO light, attenuation, and cone factor for each light
-		// Set up accumulation variables
-		vec3 surfaceLight = vec3(0);	// How much light is hitting the surface
-		vec3 reflectedLight = vec3(0);	// How much light is being reflected back
-	
-		//----------STEP 1: Add in the ambient light to the surface light----------
-		surfaceLight = AMBIENT.xyz * AMBIENT.w;
-	
-		for (int lightIndex = 0; lightIndex < MAX_LIGHTS; ++lightIndex)
-		{
-			// Directions to the light
-			vec3 directionToLight = mix(-LIGHTS[lightIndex].m_direction, normalize(LIGHTS[lightIndex].m_position - passWorldPosition), LIGHTS[lightIndex].m_directionFactor);
-	
-			// Attenuation
-			float attenuation = CalculateAttenuation(LIGHTS[lightIndex].m_position, LIGHTS[lightIndex].m_attenuationFactors, LIGHTS[lightIndex].m_color.w);
-	
-			// Cone factor
-			float coneFactor = CalculateConeFactor(LIGHTS[lightIndex].m_position, LIGHTS[lightIndex].m_direction, LIGHTS[lightIndex].m_dotOuterAngle, LIGHTS[lightIndex].m_dotInnerAngle);
-	
-	
-			//-------------STEP 2: Add in the diffuse light from all lights------------	
-			float shadowFactor = CalculateShadowFactor(passWorldPosition, worldNormal, LIGHTS[lightIndex]);
-			surfaceLight += shadowFactor * CalculateDot3(directionToLight, worldNormal, LIGHTS[lightIndex].m_color, attenuation, coneFactor);
-			
-			//-----STEP 3: Calculate and add in specular lighting from all lights----------
-			reflectedLight += shadowFactor * CalculateSpecular(directionToLight, worldNormal, directionToEye, LIGHTS[lightIndex].m_color, attenuation, coneFactor);
-		}
-	
-	
-		// Clamp the surface light, since it alone shouldn't blow out the surface (either it's fully lit, or not fully lit)
-		surfaceLight = clamp(surfaceLight, vec3(0), vec3(1));
-	
-	
-		//---------------------STEP 4: CALCULATE FINAL COLOR-----------------------
-		// Calculate the final color, surface gets w = 1 since it is multiplied in, reflected gets w = 0 since it is added in
-		vec4 finalColor = vec4(surfaceLight, 1) * surfaceColor * passColor + vec4(reflectedLight, 0);
-	
-		// Clamp the color
-		finalColor = clamp(finalColor, vec4(0), vec4(1));
-		
-		outColor = finalColor; 				
-	})";
-
-const RenderState ShaderSource::PHONG_OPAQUE_INSTANCED_STATE = ShaderSource::PHONG_OPAQUE_STATE;
-
-
-//-------------------------------------------------------------------------------------------------------------------------------------------------------------
-//
-// Phong Alpha Instanced
-//
-//-------------------------------------------------------------------------------------------------------------------------------------------------------------
-const char* ShaderSource::PHONG_ALPHA_INSTANCED_NAME = "Phong_Alpha_Instanced";
-const char* ShaderSource::PHONG_ALPHA_INSTANCED_VS = ShaderSource::PHONG_OPAQUE_INSTANCED_VS;											 
-const char* ShaderSource::PHONG_ALPHA_INSTANCED_FS = ShaderSource::PHONG_OPAQUE_INSTANCED_FS;	
-const RenderState ShaderSource::PHONG_ALPHA_INSTANCED_STATE = ShaderSource::PHONG_ALPHA_STATE;
-
-
-//-------------------------------------------------------------------------------------------------------------------------------------------------------------
-//
-// Vertex Normal
-//
-//-------------------------------------------------------------------------------------------------------------------------------------------------------------
-const char* ShaderSource::VERTEX_NORMAL_NAME = "Vertex_Normal";
-const char* ShaderSource::VERTEX_NORMAL_VS = R"(
-	
-#version 420 core												
-
-layout(binding=1, std140) uniform cameraUBO
-{
-	mat4 VIEW;
-	mat4 PROJECTION;
-
-	mat4 CAMERA_MATRIX;
-
-	vec3	CAMERA_RIGHT;
-	float	PADDING_0;
-	vec3	CAMERA_UP;
-	float	PADDING_1;
-	vec3	CAMERA_FORWARD;
-	float	PADDING_2;
-	vec3	CAMERA_POSITION;
-	float	PADDING_3;
-};
-
-layout(binding=2, std140) uniform modelUBO
-{
-	mat4 MODEL;
-};
-																												
-in vec3 POSITION;																								
-in vec3 NORMAL;													
-																												
-out vec3 passVertexNormal;					
-																											
-void main( void )												
-{						
-	vec4 localPosition = vec4(POSITION, 1);																				
-	vec4 worldPosition = MODEL * localPosition; 						
-	vec4 clipPosition = PROJECTION * VIEW * worldPosition; 				
-
-	passVertexNormal = (MODEL * vec4(NORMAL, 0.f)).xyz;															
-
-	gl_Position = clipPosition; 
-									
-})";
-
-const char* ShaderSource::VERTEX_NORMAL_FS = R"(
+	gl_Position = clipPosition; 
+									
+})";
+
+const char* ShaderSource::VERTEX_NORMAL_FS = R"(
 	
 
 #version 420 core											
@@ -1401,8 +1339,9 @@ void main( void )
 const char* ShaderSource::DIFFUSE_FS = R"(
 	
 
-#version 420 core											
+#version 430 core											
 #define MAX_LIGHTS 8
+#define SHADOW_CASCADE_COUNT 4
 																									
 layout(binding = 0) uniform sampler2D gTexDiffuse;			
 layout(binding = 1) uniform sampler2D gTexNormal;
@@ -1416,7 +1355,7 @@ struct Light
 	vec3 m_attenuationFactors;
 	float m_directionFactor;
 	vec4 m_color;
-	mat4 m_shadowVP;
+	mat4 m_shadowVP[SHADOW_CASCADE_COUNT];
 	vec3 m_padding;
 	float m_castsShadows;
 };
@@ -1427,6 +1366,21 @@ layout(binding=3, std140) uniform lightUBO
 	Light LIGHTS[MAX_LIGHTS];
 };	
 
+// The camera's light clusters, set by the ForwardRenderingPath (dimensions are 0 if not set)
+layout(binding=6, std430) readonly buffer lightClusterSSBO
+{
+	uvec4 CLUSTER_DIMENSIONS;		// xyz cluster counts
+	mat4 CLUSTER_VIEW_PROJECTION;
+	vec4 CLUSTER_NEAR_PLANE;		// xyz unit normal into the view, w distance
+	vec4 CLUSTER_DEPTH_PARAMS;		// x first slice depth, y 1 / log(slice depth ratio)
+	uint CLUSTER_DATA[];			// (first entry, count) per cluster, then the light index entries
+};
+
+layout(binding=7, std430) readonly buffer clusterLightSSBO
+{
+	Light CLUSTER_LIGHTS[];
+};
+
 in vec2 passUV;																						
 
 in vec3 passEyePosition;
@@ -1476,6 +1430,52 @@ vec3 CalculateDot3(vec3 directionToLight, vec3 normal, vec4 lightColor, float at
 }
 
 
+// Returns where the light indices for the cluster containing the position are in CLUSTER_DATA, as (first, count)
+uvec2 GetClusterLightRange(vec3 worldPosition)
+{
+	// No clusters are set outside of the ForwardRenderingPath
+	if (CLUSTER_DIMENSIONS.x == 0)
+	{
+		return uvec2(0);
+	}
+
+	vec4 clipPosition = CLUSTER_VIEW_PROJECTION * vec4(worldPosition, 1.0f);
+	vec2 ndcPosition = clipPosition.xy / clipPosition.w;
+	vec2 gridSize = vec2(CLUSTER_DIMENSIONS.xy);
+	uvec2 tile = uvec2(clamp((ndcPosition * 0.5f + vec2(0.5f)) * gridSize, vec2(0), gridSize - vec2(1)));
+
+	// Slices are exponentially deeper away from the near plane, after a first slice of fixed depth
+	float depth = dot(CLUSTER_NEAR_PLANE.xyz, worldPosition) + CLUSTER_NEAR_PLANE.w;
+	uint slice = 0;
+
+	if (depth > CLUSTER_DEPTH_PARAMS.x)
+	{
+		slice = min(uint(log(depth / CLUSTER_DEPTH_PARAMS.x) * CLUSTER_DEPTH_PARAMS.y) + 1, CLUSTER_DIMENSIONS.z - 1);
+	}
+
+	uint clusterIndex = (slice * CLUSTER_DIMENSIONS.y + tile.y) * CLUSTER_DIMENSIONS.x + tile.x;
+	return uvec2(CLUSTER_DATA[2 * clusterIndex], CLUSTER_DATA[2 * clusterIndex + 1]);
+}
+
+
+// Adds the contribution of a single light to the accumulated lighting
+void AddLightContribution(Light light, vec3 worldNormal, vec3 directionToEye, inout vec3 surfaceLight)
+{
+	// Directions to the light
+	vec3 directionToLight = mix(-light.m_direction, normalize(light.m_position - passWorldPosition), light.m_directionFactor);
+
+	// Attenuation
+	float attenuation = CalculateAttenuation(light.m_position, light.m_attenuationFactors, light.m_color.w);
+
+	// Cone factor
+	float coneFactor = CalculateConeFactor(light.m_position, light.m_direction, light.m_dotOuterAngle, light.m_dotInnerAngle);
+
+
+	//-------------Add in the diffuse light from all lights------------	
+	surfaceLight += CalculateDot3(directionToLight, worldNormal, light.m_color, attenuation, coneFactor);
+}
+
+
 // Entry point															
 void main( void )											
 {				
@@ -1493,20 +1493,11 @@ void main( void )
 	//----------Add in the ambient light to the surface light----------
 	surfaceLight = AMBIENT.xyz * AMBIENT.w;
 
-	for (int lightIndex = 0; lightIndex < MAX_LIGHTS; ++lightIndex)
+	// Add in every light reaching this fragment's cluster
+	uvec2 clusterLights = GetClusterLightRange(passWorldPosition);
+	for (uint entryIndex = clusterLights.x; entryIndex < clusterLights.x + clusterLights.y; ++entryIndex)
 	{
-		// Directions to the light
-		vec3 directionToLight = mix(-LIGHTS[lightIndex].m_direction, normalize(LIGHTS[lightIndex].m_position - passWorldPosition), LIGHTS[lightIndex].m_directionFactor);
-
-		// Attenuation
-		float attenuation = CalculateAttenuation(LIGHTS[lightIndex].m_position, LIGHTS[lightIndex].m_attenuationFactors, LIGHTS[lightIndex].m_color.w);
-
-		// Cone factor
-		float coneFactor = CalculateConeFactor(LIGHTS[lightIndex].m_position, LIGHTS[lightIndex].m_direction, LIGHTS[lightIndex].m_dotOuterAngle, LIGHTS[lightIndex].m_dotInnerAngle);
-
-
-		//-------------Add in the diffuse light from all lights------------	
-		surfaceLight += CalculateDot3(directionToLight, worldNormal, LIGHTS[lightIndex].m_color, attenuation, coneFactor);
+		AddLightContribution(CLUSTER_LIGHTS[CLUSTER_DATA[entryIndex]], worldNormal, directionToEye, surfaceLight);
 	}
 
 
@@ -1595,8 +1586,9 @@ void main( void )
 const char* ShaderSource::SPECULAR_FS = R"(
 	
 
-#version 420 core											
+#version 430 core											
 #define MAX_LIGHTS 8
+#define SHADOW_CASCADE_COUNT 4
 																									
 layout(binding = 0) uniform sampler2D gTexDiffuse;			
 layout(binding = 1) uniform sampler2D gTexNormal;
@@ -1610,7 +1602,7 @@ struct Light
 	vec3 m_attenuationFactors;
 	float m_directionFactor;
 	vec4 m_color;
-	mat4 m_shadowVP;
+	mat4 m_shadowVP[SHADOW_CASCADE_COUNT];
 	vec3 m_padding;
 	float m_castsShadows;
 };
@@ -1621,6 +1613,21 @@ layout(binding=3, std140) uniform lightUBO
 	Light LIGHTS[MAX_LIGHTS];
 };	
 
+// The camera's light clusters, set by the ForwardRenderingPath (dimensions are 0 if not set)
+layout(binding=6, std430) readonly buffer lightClusterSSBO
+{
+	uvec4 CLUSTER_DIMENSIONS;		// xyz cluster counts
+	mat4 CLUSTER_VIEW_PROJECTION;
+	vec4 CLUSTER_NEAR_PLANE;		// xyz unit normal into the view, w distance
+	vec4 CLUSTER_DEPTH_PARAMS;		// x first slice depth, y 1 / log(slice depth ratio)
+	uint CLUSTER_DATA[];			// (first entry, count) per cluster, then the light index entries
+};
+
+layout(binding=7, std430) readonly buffer clusterLightSSBO
+{
+	Light CLUSTER_LIGHTS[];
+};
+
 layout(binding=8, std140) uniform specularUBO
 {
 	float SPECULAR_AMOUNT;
@@ -1678,6 +1685,51 @@ vec3 CalculateSpecular(vec3 directionToLight, vec3 normal, vec3 directionToEye,
 }
 
 
+// Returns where the light indices for the cluster containing the position are in CLUSTER_DATA, as (first, count)
+uvec2 GetClusterLightRange(vec3 worldPosition)
+{
+	// No clusters are set outside of the ForwardRenderingPath
+	if (CLUSTER_DIMENSIONS.x == 0)
+	{
+		return uvec2(0);
+	}
+
+	vec4 clipPosition = CLUSTER_VIEW_PROJECTION * vec4(worldPosition, 1.0f);
+	vec2 ndcPosition = clipPosition.xy / clipPosition.w;
+	vec2 gridSize = vec2(CLUSTER_DIMENSIONS.xy);
+	uvec2 tile = uvec2(clamp((ndcPosition * 0.5f + vec2(0.5f)) * gridSize, vec2(0), gridSize - vec2(1)));
+
+	// Slices are exponentially deeper away from the near plane, after a first slice of fixed depth
+	float depth = dot(CLUSTER_NEAR_PLANE.xyz, worldPosition) + CLUSTER_NEAR_PLANE.w;
+	uint slice = 0;
+
+	if (depth > CLUSTER_DEPTH_PARAMS.x)
+	{
+		slice = min(uint(log(depth / CLUSTER_DEPTH_PARAMS.x) * CLUSTER_DEPTH_PARAMS.y) + 1, CLUSTER_DIMENSIONS.z - 1);
+	}
+
+	uint clusterIndex = (slice * CLUSTER_DIMENSIONS.y + tile.y) * CLUSTER_DIMENSIONS.x + tile.x;
+	return uvec2(CLUSTER_DATA[2 * clusterIndex], CLUSTER_DATA[2 * clusterIndex + 1]);
+}
+
+
+// Adds the contribution of a single light to the accumulated lighting
+void AddLightContribution(Light light, vec3 worldNormal, vec3 directionToEye, inout vec3 reflectedLight)
+{
+	// Directions to the light
+	vec3 directionToLight = mix(-light.m_direction, normalize(light.m_position - passWorldPosition), light.m_directionFactor);
+
+	// Attenuation
+	float attenuation = CalculateAttenuation(light.m_position, light.m_attenuationFactors, light.m_color.w);
+
+	// Cone factor
+	float coneFactor = CalculateConeFactor(light.m_position, light.m_direction, light.m_dotOuterAngle, light.m_dotInnerAngle);
+	
+	//-----Calculate and add in specular lighting from all lights----------
+	reflectedLight += CalculateSpecular(directionToLight, worldNormal, directionToEye, light.m_color, attenuation, coneFactor);
+}
+
+
 // Entry point															
 void main( void )											
 {				
@@ -1692,19 +1744,11 @@ void main( void )
 	// Set up accumulation variables
 	vec3 reflectedLight = vec3(0);	// How much light is being reflected back
 
-	for (int lightIndex = 0; lightIndex < MAX_LIGHTS; ++lightIndex)
+	// Add in every light reaching this fragment's cluster
+	uvec2 clusterLights = GetClusterLightRange(passWorldPosition);
+	for (uint entryIndex = clusterLights.x; entryIndex < clusterLights.x + clusterLights.y; ++entryIndex)
 	{
-		// Directions to the light
-		vec3 directionToLight = mix(-LIGHTS[lightIndex].m_direction, normalize(LIGHTS[lightIndex].m_position - passWorldPosition), LIGHTS[lightIndex].m_directionFactor);
-
-		// Attenuation
-		float attenuation = CalculateAttenuation(LIGHTS[lightIndex].m_position, LIGHTS[lightIndex].m_attenuationFactors, LIGHTS[lightIndex].m_color.w);
-
-		// Cone factor
-		float coneFactor = CalculateConeFactor(LIGHTS[lightIndex].m_position, LIGHTS[lightIndex].m_direction, LIGHTS[lightIndex].m_dotOuterAngle, LIGHTS[lightIndex].m_dotInnerAngle);
-		
-		//-----Calculate and add in specular lighting from all lights----------
-		reflectedLight += CalculateSpecular(directionToLight, worldNormal, directionToEye, LIGHTS[lightIndex].m_color, attenuation, coneFactor);
+		AddLightContribution(CLUSTER_LIGHTS[CLUSTER_DATA[entryIndex]], worldNormal, directionToEye, reflectedLight);
 	}
 	
 	outColor = vec4(reflectedLight, 1.f);
@@ -1783,8 +1827,9 @@ void main( void )
 
 const char* ShaderSource::LIGHTING_FS = R"(
 	
-#version 420 core											
+#version 430 core											
 #define MAX_LIGHTS 8
+#define SHADOW_CASCADE_COUNT 4
 																									
 layout(binding = 0) uniform sampler2D gTexDiffuse;			
 layout(binding = 1) uniform sampler2D gTexNormal;
@@ -1798,7 +1843,7 @@ struct Light
 	vec3 m_attenuationFactors;
 	float m_directionFactor;
 	vec4 m_color;
-	mat4 m_shadowVP;
+	mat4 m_shadowVP[SHADOW_CASCADE_COUNT];
 	vec3 m_padding;
 	float m_castsShadows;
 };
@@ -1809,10 +1854,25 @@ layout(binding=3, std140) uniform lightUBO
 	Light LIGHTS[MAX_LIGHTS];
 };	
 
-layout(binding=8, std140) uniform specularUBO
+// The camera's light clusters, set by the ForwardRenderingPath (dimensions are 0 if not set)
+layout(binding=6, std430) readonly buffer lightClusterSSBO
 {
-	float SPECULAR_AMOUNT;
-	float SPECULAR_POWER;
+	uvec4 CLUSTER_DIMENSIONS;		// xyz cluster counts
+	mat4 CLUSTER_VIEW_PROJECTION;
+	vec4 CLUSTER_NEAR_PLANE;		// xyz unit normal into the view, w distance
+	vec4 CLUSTER_DEPTH_PARAMS;		// x first slice depth, y 1 / log(slice depth ratio)
+	uint CLUSTER_DATA[];			// (first entry, count) per cluster, then the light index entries
+};
+
+layout(binding=7, std430) readonly buffer clusterLightSSBO
+{
+	Light CLUSTER_LIGHTS[];
+};
+
+layout(binding=8, std140) uniform specularUBO
+{
+	float SPECULAR_AMOUNT;
+	float SPECULAR_POWER;
 	vec2 PADDING_4;
 };
 
@@ -1873,6 +1933,55 @@ vec3 CalculateSpecular(vec3 directionToLight, vec3 normal, vec3 directionToEye,
 	return specular;
 }
 
+// Returns where the light indices for the cluster containing the position are in CLUSTER_DATA, as (first, count)
+uvec2 GetClusterLightRange(vec3 worldPosition)
+{
+	// No clusters are set outside of the ForwardRenderingPath
+	if (CLUSTER_DIMENSIONS.x == 0)
+	{
+		return uvec2(0);
+	}
+
+	vec4 clipPosition = CLUSTER_VIEW_PROJECTION * vec4(worldPosition, 1.0f);
+	vec2 ndcPosition = clipPosition.xy / clipPosition.w;
+	vec2 gridSize = vec2(CLUSTER_DIMENSIONS.xy);
+	uvec2 tile = uvec2(clamp((ndcPosition * 0.5f + vec2(0.5f)) * gridSize, vec2(0), gridSize - vec2(1)));
+
+	// Slices are exponentially deeper away from the near plane, after a first slice of fixed depth
+	float depth = dot(CLUSTER_NEAR_PLANE.xyz, worldPosition) + CLUSTER_NEAR_PLANE.w;
+	uint slice = 0;
+
+	if (depth > CLUSTER_DEPTH_PARAMS.x)
+	{
+		slice = min(uint(log(depth / CLUSTER_DEPTH_PARAMS.x) * CLUSTER_DEPTH_PARAMS.y) + 1, CLUSTER_DIMENSIONS.z - 1);
+	}
+
+	uint clusterIndex = (slice * CLUSTER_DIMENSIONS.y + tile.y) * CLUSTER_DIMENSIONS.x + tile.x;
+	return uvec2(CLUSTER_DATA[2 * clusterIndex], CLUSTER_DATA[2 * clusterIndex + 1]);
+}
+
+
+// Adds the contribution of a single light to the accumulated lighting
+void AddLightContribution(Light light, vec3 worldNormal, vec3 directionToEye, inout vec3 surfaceLight, inout vec3 reflectedLight)
+{
+	// Directions to the light
+	vec3 directionToLight = mix(-light.m_direction, normalize(light.m_position - passWorldPosition), light.m_directionFactor);
+
+	// Attenuation
+	float attenuation = CalculateAttenuation(light.m_position, light.m_attenuationFactors, light.m_color.w);
+
+	// Cone factor
+	float coneFactor = CalculateConeFactor(light.m_position, light.m_direction, light.m_dotOuterAngle, light.m_dotInnerAngle);
+
+
+	//-------------STEP 2: Add in the diffuse light from all lights------------	
+	surfaceLight += CalculateDot3(directionToLight, worldNormal, light.m_color, attenuation, coneFactor);
+	
+	//-----STEP 3: Calculate and add in specular lighting from all lights----------
+	reflectedLight += CalculateSpecular(directionToLight, worldNormal, directionToEye, light.m_color, attenuation, coneFactor);
+}
+
+
 // Entry point															
 void main( void )											
 {				
@@ -1891,23 +2000,11 @@ void main( void )
 	//----------STEP 1: Add in the ambient light to the surface light----------
 	surfaceLight = AMBIENT.xyz * AMBIENT.w;
 
-	for (int lightIndex = 0; lightIndex < MAX_LIGHTS; ++lightIndex)
+	// Add in every light reaching this fragment's cluster
+	uvec2 clusterLights = GetClusterLightRange(passWorldPosition);
+	for (uint entryIndex = clusterLights.x; entryIndex < clusterLights.x + clusterLights.y; ++entryIndex)
 	{
-		// Directions to the light
-		vec3 directionToLight = mix(-LIGHTS[lightIndex].m_direction, normalize(LIGHTS[lightIndex].m_position - passWorldPosition), LIGHTS[lightIndex].m_directionFactor);
-
-		// Attenuation
-		float attenuation = CalculateAttenuation(LIGHTS[lightIndex].m_position, LIGHTS[lightIndex].m_attenuationFactors, LIGHTS[lightIndex].m_color.w);
-
-		// Cone factor
-		float coneFactor = CalculateConeFactor(LIGHTS[lightIndex].m_position, LIGHTS[lightIndex].m_direction, LIGHTS[lightIndex].m_dotOuterAngle, LIGHTS[lightIndex].m_dotInnerAngle);
-
-
-		//-------------STEP 2: Add in the diffuse light from all lights------------	
-		surfaceLight += CalculateDot3(directionToLight, worldNormal, LIGHTS[lightIndex].m_color, attenuation, coneFactor);
-		
-		//-----STEP 3: Calculate and add in specular lighting from all lights----------
-		reflectedLight += CalculateSpecular(directionToLight, worldNormal, directionToEye, LIGHTS[lightIndex].m_color, attenuation, coneFactor);
+		AddLightContribution(CLUSTER_LIGHTS[CLUSTER_DATA[entryIndex]], worldNormal, directionToEye, surfaceLight, reflectedLight);
 	}
 
 
@@ -1980,4 +2077,908 @@ void main( void )
 	outColor = vec4(passUV, 0.f, 1.f); 				
 })";
 
-const RenderState ShaderSource::UV_STATE; // Default state
\ No newline at end of file
+const RenderState ShaderSource::UV_STATE; // Default state
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+//
+// Depth Only Instanced Shader - for the depth pre-pass, writes depth pushed back slightly so the
+// color pass's LEQUAL test still passes on the same surfaces
+//
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+const char* ShaderSource::DEPTH_ONLY_NAME = "Depth_Only";
+const char* ShaderSource::DEPTH_ONLY_VS = R"(
+
+#version 420 core												
+
+layout(binding=1, std140) uniform cameraUBO
+{
+	mat4 VIEW;
+	mat4 PROJECTION;
+};
+
+layout(binding=5, std140) uniform meshUBO
+{
+	vec3	POSITION_OFFSET;		// Quantized positions decode to POSITION_OFFSET + POSITION_SCALE * POSITION
+	float	HAS_OCTAHEDRAL_NORMALS;
+	vec3	POSITION_SCALE;
+	float	MESH_PADDING_0;
+};
+																												
+in vec3 POSITION;
+in mat4 INSTANCE_MODEL_MATRIX;
+																													
+void main( void )												
+{																										
+	vec4 world_pos = vec4( POSITION_OFFSET + POSITION_SCALE * POSITION, 1 ); 						
+	gl_Position = PROJECTION * VIEW * INSTANCE_MODEL_MATRIX * world_pos; 								
+})";	
+
+const char* ShaderSource::DEPTH_ONLY_FS = R"(
+	
+#version 420 core											
+															
+// Entry Point												
+void main( void )											
+{																																				
+})";
+
+static RenderState MakeDepthOnlyState()
+{
+	RenderState state;
+	state.m_shouldWriteColor = false;
+	state.m_depthBiasSlope = 1.f;
+	state.m_depthBiasConstant = 1.f;
+
+	return state;
+}
+
+const RenderState ShaderSource::DEPTH_ONLY_STATE = MakeDepthOnlyState();
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+//
+// Deferred G-Buffer Instanced - writes the surface of a deferrable (Phong) draw for a deferred camera's lighting pass
+// Takes the draw's material's diffuse and normal maps and specularUBO; always instanced, like the depth-only shader
+//
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+const char* ShaderSource::DEFERRED_GBUFFER_NAME = "Deferred_GBuffer";
+const char* ShaderSource::DEFERRED_GBUFFER_VS = R"(
+
+#version 420 core
+
+layout(binding=1, std140) uniform cameraUBO
+{
+	mat4 VIEW;
+	mat4 PROJECTION;
+};
+
+layout(binding=5, std140) uniform meshUBO
+{
+	vec3	POSITION_OFFSET;		// Quantized positions decode to POSITION_OFFSET + POSITION_SCALE * POSITION
+	float	HAS_OCTAHEDRAL_NORMALS;
+	vec3	POSITION_SCALE;
+	float	MESH_PADDING_0;
+};
+
+in vec3 POSITION;
+in vec4 COLOR;
+in vec2 UV;
+in vec3 NORMAL;
+in vec4 TANGENT;
+in mat4 INSTANCE_MODEL_MATRIX;
+
+out vec2 passUV;
+out vec4 passColor;
+out mat3 passTBNTransform;
+
+// Unfolds a direction from the octahedral encoding the packed vertex types use
+vec3 DecodeOctahedral(vec2 encoded)
+{
+	vec3 direction = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+	float fold = max(-direction.z, 0.0);
+	direction.x += (direction.x >= 0.0 ? -fold : fold);
+	direction.y += (direction.y >= 0.0 ? -fold : fold);
+	return normalize(direction);
+}
+
+void main( void )
+{
+	vec4 localPosition = vec4(POSITION_OFFSET + POSITION_SCALE * POSITION, 1);
+	vec4 worldPosition = INSTANCE_MODEL_MATRIX * localPosition;
+
+	passUV = UV;
+	passColor = COLOR;
+
+	// Packed vertices store the tangent's w in z
+	vec3 normal = NORMAL;
+	vec4 tangent = TANGENT;
+	if (HAS_OCTAHEDRAL_NORMALS > 0.5)
+	{
+		normal = DecodeOctahedral(NORMAL.xy);
+		tangent = vec4(DecodeOctahedral(TANGENT.xy), TANGENT.z);
+	}
+
+	vec3 worldNormal = normalize((INSTANCE_MODEL_MATRIX * vec4(normal, 0.f)).xyz);
+	vec3 worldTangent = normalize((INSTANCE_MODEL_MATRIX * vec4(tangent.xyz, 0.f)).xyz);
+	vec3 worldBitangent = cross(worldTangent, worldNormal) * tangent.w;
+
+	passTBNTransform = mat3(worldTangent, worldBitangent, worldNormal);
+
+	gl_Position = PROJECTION * VIEW * worldPosition;
+})";
+
+const char* ShaderSource::DEFERRED_GBUFFER_FS = R"(
+
+#version 420 core
+#define MAX_SPECULAR_POWER 256.0		// Must match the deferred lighting shader
+
+layout(binding = 0) uniform sampler2D gTexDiffuse;
+layout(binding = 1) uniform sampler2D gTexNormal;
+
+layout(binding=8, std140) uniform specularUBO
+{
+	float SPECULAR_AMOUNT;
+	float SPECULAR_POWER;
+	vec2 PADDING_4;
+};
+
+in vec2 passUV;
+in vec4 passColor;
+in mat3 passTBNTransform;
+
+layout(location = 0) out vec4 outAlbedo;		// rgb surface color, a specular amount
+layout(location = 1) out vec4 outNormal;		// rgb world normal mapped to 0..1, a specular power over MAX_SPECULAR_POWER
+
+// Entry Point
+void main( void )
+{
+	vec4 surfaceColor = texture(gTexDiffuse, passUV) * passColor;
+
+	vec3 surfaceNormal = normalize(2.f * texture(gTexNormal, passUV).xyz - vec3(1));
+	vec3 worldNormal = normalize(passTBNTransform * surfaceNormal);
+
+	outAlbedo = vec4(surfaceColor.xyz, clamp(SPECULAR_AMOUNT, 0.f, 1.f));
+	outNormal = vec4(0.5f * worldNormal + vec3(0.5f), clamp(SPECULAR_POWER / MAX_SPECULAR_POWER, 0.f, 1.f));
+})";
+
+const RenderState ShaderSource::DEFERRED_GBUFFER_STATE;	// Default values, the same as Phong_Opaque
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+//
+// Deferred Lighting - one triangle over a deferred camera's view, lighting each covered pixel of its G-buffer
+// with the camera's light clusters, the same as Phong_Opaque would have; pixels with no geometry are left alone
+//
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+const char* ShaderSource::DEFERRED_LIGHTING_NAME = "Deferred_Lighting";
+const char* ShaderSource::DEFERRED_LIGHTING_VS = R"(
+
+#version 420 core
+
+out vec2 passNDCPosition;
+
+void main( void )
+{
+	// Vertices at (-1, -1), (3, -1) and (-1, 3) from the index alone, so no vertex buffer is needed
+	vec2 position = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+	passNDCPosition = 2.f * position - vec2(1.f);
+
+	gl_Position = vec4(passNDCPosition, 0.f, 1.f);
+})";
+
+const char* ShaderSource::DEFERRED_LIGHTING_FS = R"(
+
+	#version 430 core
+	#define SHADOW_CASCADE_COUNT 4
+	#define SHADOW_CASCADE_ATLAS_WIDTH 2
+	#define MAX_SPECULAR_POWER 256.0		// Must match the G-buffer shader
+
+	layout(binding = 0) uniform sampler2D gGBufferAlbedo;
+	layout(binding = 1) uniform sampler2D gGBufferNormal;
+	layout(binding = 2) uniform sampler2D gGBufferDepth;
+	layout(binding = 8) uniform sampler2D gShadowDepth;
+
+	layout(binding=1, std140) uniform cameraUBO
+	{
+		mat4 VIEW;
+		mat4 PROJECTION;
+
+		mat4 CAMERA_MATRIX;
+
+		vec3	CAMERA_RIGHT;
+		float	PADDING_0;
+		vec3	CAMERA_UP;
+		float	PADDING_1;
+		vec3	CAMERA_FORWARD;
+		float	PADDING_2;
+		vec3	CAMERA_POSITION;
+		float	PADDING_3;
+
+		mat4 INVERSE_VIEW_PROJECTION;
+	};
+
+	struct Light
+	{
+		vec3 m_position;
+		float m_dotOuterAngle;
+		vec3 m_direction;
+		float m_dotInnerAngle;
+		vec3 m_attenuationFactors;
+		float m_directionFactor;
+		vec4 m_color;
+		mat4 m_shadowVP[SHADOW_CASCADE_COUNT];
+		vec3 m_padding;
+		float m_castsShadows;
+	};
+
+	// Only the ambience is read, the per draw lights after it are never set for this draw
+	layout(binding=3, std140) uniform lightUBO
+	{
+		vec4 AMBIENT;							// xyz color, w intensity
+	};
+
+	layout(binding=6, std430) readonly buffer lightClusterSSBO
+	{
+		uvec4 CLUSTER_DIMENSIONS;		// xyz cluster counts
+		mat4 CLUSTER_VIEW_PROJECTION;
+		vec4 CLUSTER_NEAR_PLANE;		// xyz unit normal into the view, w distance
+		vec4 CLUSTER_DEPTH_PARAMS;		// x first slice depth, y 1 / log(slice depth ratio)
+		uint CLUSTER_DATA[];			// (first entry, count) per cluster, then the light index entries
+	};
+
+	layout(binding=7, std430) readonly buffer clusterLightSSBO
+	{
+		Light CLUSTER_LIGHTS[];
+	};
+
+	// The scene's baked lights as L2 spherical harmonics irradiance, set by the ForwardRenderingPath (PROBE_VOLUME_MINS.w is 0 if not set)
+	layout(binding=18, std430) readonly buffer lightProbeSSBO
+	{
+		vec4 PROBE_VOLUME_MINS;			// xyz relative to the render origin
+		vec4 PROBE_INVERSE_CELL_SIZE;	// xyz, 0 on axes with a single probe
+		uvec4 PROBE_DIMENSIONS;			// xyz probe counts
+		vec4 PROBE_COEFFICIENTS[];		// 9 per probe, x fastest then y then z
+	};
+
+	in vec2 passNDCPosition;
+
+	out vec4 outColor;
+
+	//---------------------------------------------------Functions-----------------------------------------------------------------
+
+	float CalculateAttenuation(vec3 worldPosition, vec3 lightPosition, vec3 attenuationFactors, float intensity)
+	{
+		float distance = length(lightPosition - worldPosition);
+		float denominator = attenuationFactors.x + attenuationFactors.y * distance + attenuationFactors.z * distance * distance;
+
+		return (intensity / denominator);
+	}
+
+	float CalculateConeFactor(vec3 worldPosition, vec3 lightPosition, vec3 lightDirection, float outerDotThreshold, float innerDotThreshold)
+	{
+		float dotFactor = dot(normalize(worldPosition - lightPosition), lightDirection);
+		return smoothstep(outerDotThreshold, innerDotThreshold, dotFactor);
+	}
+
+	float CalculateShadowFactor(vec3 worldPosition, Light light)
+	{
+		if (light.m_castsShadows == 0.f)
+		{
+			return 1.0f;
+		}
+
+		// Use the first (highest resolution) cascade that contains the position
+		for (int cascadeIndex = 0; cascadeIndex < SHADOW_CASCADE_COUNT; ++cascadeIndex)
+		{
+			vec4 clipPos = light.m_shadowVP[cascadeIndex] * vec4(worldPosition, 1.0f);
+			vec3 ndcPos = clipPos.xyz / clipPos.w;
+
+			if (all(lessThanEqual(abs(ndcPos), vec3(1))))
+			{
+				ndcPos = (ndcPos + vec3(1)) * 0.5f;
+
+				vec2 atlasCell = vec2(cascadeIndex % SHADOW_CASCADE_ATLAS_WIDTH, cascadeIndex / SHADOW_CASCADE_ATLAS_WIDTH);
+				vec2 atlasUV = (ndcPos.xy + atlasCell) / float(SHADOW_CASCADE_ATLAS_WIDTH);
+
+				float shadowDepth = texture(gShadowDepth, atlasUV).r;
+
+				return ndcPos.z - 0.001 > shadowDepth ? 0.f : 1.f;
+			}
+		}
+
+		return 1.0f;
+	}
+
+	// Returns one probe's irradiance for a surface facing along the normal
+	vec3 EvaluateLightProbe(uint probeIndex, vec3 n)
+	{
+		uint first = probeIndex * 9u;
+
+		vec3 irradiance = PROBE_COEFFICIENTS[first + 0u].xyz * 0.282095f
+			+ PROBE_COEFFICIENTS[first + 1u].xyz * (0.488603f * n.y)
+			+ PROBE_COEFFICIENTS[first + 2u].xyz * (0.488603f * n.z)
+			+ PROBE_COEFFICIENTS[first + 3u].xyz * (0.488603f * n.x)
+			+ PROBE_COEFFICIENTS[first + 4u].xyz * (1.092548f * n.x * n.y)
+			+ PROBE_COEFFICIENTS[first + 5u].xyz * (1.092548f * n.y * n.z)
+			+ PROBE_COEFFICIENTS[first + 6u].xyz * (0.315392f * (3.f * n.z * n.z - 1.f))
+			+ PROBE_COEFFICIENTS[first + 7u].xyz * (1.092548f * n.x * n.z)
+			+ PROBE_COEFFICIENTS[first + 8u].xyz * (0.546274f * (n.x * n.x - n.y * n.y));
+
+		return max(irradiance, vec3(0));
+	}
+
+	// Returns the baked irradiance at the position, blended between the 8 closest probes and clamped to the volume
+	vec3 SampleLightProbes(vec3 worldPosition, vec3 normal)
+	{
+		if (PROBE_VOLUME_MINS.w == 0.f)
+		{
+			return vec3(0);
+		}
+
+		uvec3 maxCoords = PROBE_DIMENSIONS.xyz - uvec3(1);
+		vec3 gridCoords = clamp((worldPosition - PROBE_VOLUME_MINS.xyz) * PROBE_INVERSE_CELL_SIZE.xyz, vec3(0), vec3(maxCoords));
+		uvec3 baseCoords = uvec3(gridCoords);
+		vec3 fractions = gridCoords - vec3(baseCoords);
+
+		vec3 irradiance = vec3(0);
+		for (uint corner = 0u; corner < 8u; ++corner)
+		{
+			uvec3 offsets = uvec3(corner & 1u, (corner >> 1) & 1u, (corner >> 2) & 1u);
+			vec3 weights = mix(vec3(1) - fractions, fractions, vec3(offsets));
+			uvec3 coords = min(baseCoords + offsets, maxCoords);
+
+			uint probeIndex = (coords.z * PROBE_DIMENSIONS.y + coords.y) * PROBE_DIMENSIONS.x + coords.x;
+			irradiance += weights.x * weights.y * weights.z * EvaluateLightProbe(probeIndex, normal);
+		}
+
+		return irradiance;
+	}
+
+	// Returns where the light indices for the cluster containing the position are in CLUSTER_DATA, as (first, count)
+	uvec2 GetClusterLightRange(vec3 worldPosition)
+	{
+		if (CLUSTER_DIMENSIONS.x == 0)
+		{
+			return uvec2(0);
+		}
+
+		vec4 clipPosition = CLUSTER_VIEW_PROJECTION * vec4(worldPosition, 1.0f);
+		vec2 ndcPosition = clipPosition.xy / clipPosition.w;
+		vec2 gridSize = vec2(CLUSTER_DIMENSIONS.xy);
+		uvec2 tile = uvec2(clamp((ndcPosition * 0.5f + vec2(0.5f)) * gridSize, vec2(0), gridSize - vec2(1)));
+
+		float depth = dot(CLUSTER_NEAR_PLANE.xyz, worldPosition) + CLUSTER_NEAR_PLANE.w;
+		uint slice = 0;
+
+		if (depth > CLUSTER_DEPTH_PARAMS.x)
+		{
+			slice = min(uint(log(depth / CLUSTER_DEPTH_PARAMS.x) * CLUSTER_DEPTH_PARAMS.y) + 1, CLUSTER_DIMENSIONS.z - 1);
+		}
+
+		uint clusterIndex = (slice * CLUSTER_DIMENSIONS.y + tile.y) * CLUSTER_DIMENSIONS.x + tile.x;
+		return uvec2(CLUSTER_DATA[2 * clusterIndex], CLUSTER_DATA[2 * clusterIndex + 1]);
+	}
+
+	// Adds the diffuse and specular contribution of a single light, as the Phong shader does
+	void AddLightContribution(Light light, vec3 worldPosition, vec3 worldNormal, vec3 directionToEye, float specularAmount, float specularPower, inout vec3 surfaceLight, inout vec3 reflectedLight)
+	{
+		vec3 directionToLight = mix(-light.m_direction, normalize(light.m_position - worldPosition), light.m_directionFactor);
+		float attenuation = CalculateAttenuation(worldPosition, light.m_position, light.m_attenuationFactors, light.m_color.w);
+		float coneFactor = CalculateConeFactor(worldPosition, light.m_position, light.m_direction, light.m_dotOuterAngle, light.m_dotInnerAngle);
+		float shadowFactor = CalculateShadowFactor(worldPosition, light);
+
+		vec3 lightColor = light.m_color.xyz * light.m_color.w * attenuation * coneFactor * shadowFactor;
+		surfaceLight += max(0.f, dot(directionToLight, worldNormal)) * lightColor;
+
+		vec3 reflected = reflect(-directionToLight, worldNormal);
+		reflectedLight += specularAmount * pow(max(0.f, dot(directionToEye, reflected)), specularPower) * lightColor;
+	}
+
+	// Entry point
+	void main( void )
+	{
+		// The G-buffer targets are the size of the camera's, so the fragment is on the same texel of each
+		ivec2 texel = ivec2(gl_FragCoord.xy);
+		float depth = texelFetch(gGBufferDepth, texel, 0).r;
+
+		// Nothing deferred drew here, leave it for the skybox and forward draws
+		if (depth >= 1.0f)
+		{
+			discard;
+		}
+
+		vec4 albedo = texelFetch(gGBufferAlbedo, texel, 0);
+		vec4 normalSample = texelFetch(gGBufferNormal, texel, 0);
+
+		vec4 worldPosition = INVERSE_VIEW_PROJECTION * vec4(passNDCPosition, 2.f * depth - 1.f, 1.f);
+		worldPosition /= worldPosition.w;
+
+		vec3 worldNormal = normalize(2.f * normalSample.xyz - vec3(1));
+		vec3 directionToEye = normalize(CAMERA_POSITION - worldPosition.xyz);
+		float specularAmount = albedo.w;
+		float specularPower = normalSample.w * MAX_SPECULAR_POWER;
+
+		vec3 surfaceLight = AMBIENT.xyz * AMBIENT.w + SampleLightProbes(worldPosition.xyz, worldNormal);
+		vec3 reflectedLight = vec3(0);
+
+		uvec2 clusterLights = GetClusterLightRange(worldPosition.xyz);
+		for (uint entryIndex = clusterLights.x; entryIndex < clusterLights.x + clusterLights.y; ++entryIndex)
+		{
+			AddLightContribution(CLUSTER_LIGHTS[CLUSTER_DATA[entryIndex]], worldPosition.xyz, worldNormal, directionToEye, specularAmount, specularPower, surfaceLight, reflectedLight);
+		}
+
+		surfaceLight = clamp(surfaceLight, vec3(0), vec3(1));
+
+		vec4 finalColor = vec4(surfaceLight, 1) * vec4(albedo.xyz, 1) + vec4(reflectedLight, 0);
+		outColor = clamp(finalColor, vec4(0), vec4(1));
+	})";
+
+const RenderState ShaderSource::DEFERRED_LIGHTING_STATE = RenderState(
+	CULL_MODE_NONE,								// Cull mode
+	FILL_MODE_SOLID, 							// Fill mode
+	WIND_COUNTER_CLOCKWISE, 					// Wind order
+	DEPTH_TEST_ALWAYS, 							// Depth compare method
+	false, 										// Write to depth buffer on draws?
+	BLEND_OP_ADD, 								// Color blend OP
+	BLEND_FACTOR_ONE, 							// Color source factor
+	BLEND_FACTOR_ZERO, 							// Color destination factor
+	BLEND_OP_ADD, 								// Alpha blend OP
+	BLEND_FACTOR_ONE, 							// Alpha source factor
+	BLEND_FACTOR_ZERO							// Alpha destination factor
+);
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+//
+// Hi-Z Reduce Compute Shader - writes the farthest depth under each cell of a coarse grid over the
+// viewport, one thread per cell; the grid size is the dispatch size
+//
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+const char* ShaderSource::HI_Z_REDUCE_NAME = "Hi_Z_Reduce";
+const char* ShaderSource::HI_Z_REDUCE_CS = R"(
+
+#version 430 core
+
+layout(local_size_x = 8, local_size_y = 8) in;
+
+layout(binding = 0) uniform sampler2D gDepthTexture;
+
+layout(location = 0) uniform int gViewportX;
+layout(location = 1) uniform int gViewportY;
+layout(location = 2) uniform int gViewportWidth;
+layout(location = 3) uniform int gViewportHeight;
+
+layout(binding = 9, std430) buffer hiZSSBO
+{
+	float HI_Z_DEPTHS[];
+};
+
+void main( void )
+{
+	uvec2 gridSize = gl_NumWorkGroups.xy * gl_WorkGroupSize.xy;
+	uvec2 cell = gl_GlobalInvocationID.xy;
+
+	vec2 cellSize = vec2(gViewportWidth, gViewportHeight) / vec2(gridSize);
+	ivec2 viewportMins = ivec2(gViewportX, gViewportY);
+
+	ivec2 start = viewportMins + ivec2(floor(vec2(cell) * cellSize));
+	ivec2 end = viewportMins + min(ivec2(ceil(vec2(cell + 1) * cellSize)), ivec2(gViewportWidth, gViewportHeight));
+
+	// Cells with no texels under them can't occlude anything
+	float farthestDepth = ((end.x > start.x && end.y > start.y) ? 0.0 : 1.0);
+	for (int y = start.y; y < end.y; ++y)
+	{
+		for (int x = start.x; x < end.x; ++x)
+		{
+			farthestDepth = max(farthestDepth, texelFetch(gDepthTexture, ivec2(x, y), 0).r);
+		}
+	}
+
+	HI_Z_DEPTHS[cell.y * gridSize.x + cell.x] = farthestDepth;
+})";
+
+
+//-----------------------------------------------------------------------------------------------
+// GPU Skinning - one invocation per vertex, read and written as raw words since the vertex structs
+// aren't std430 aligned; VertexSkinned is VertexLit followed by 4 bone indices and 4 weights
+//
+const char* ShaderSource::GPU_SKINNING_NAME = "GPU_Skinning";
+const char* ShaderSource::GPU_SKINNING_CS = R"(
+
+#version 430 core
+
+#define SKINNED_VERTEX_WORDS 21
+#define LIT_VERTEX_WORDS 13
+
+layout(local_size_x = 64) in;
+
+layout(location = 0) uniform uint gVertexCount;
+layout(location = 1) uniform uint gBoneOffset;
+
+layout(binding = 4, std430) readonly buffer skinningPaletteSSBO
+{
+	mat4 SKINNING_PALETTE[];
+};
+
+layout(binding = 16, std430) readonly buffer skinnedVerticesSSBO
+{
+	uint SKINNED_VERTICES[];
+};
+
+layout(binding = 17, std430) writeonly buffer litVerticesSSBO
+{
+	uint LIT_VERTICES[];
+};
+
+vec3 ReadVector3(uint word)
+{
+	return vec3(uintBitsToFloat(SKINNED_VERTICES[word]), uintBitsToFloat(SKINNED_VERTICES[word + 1]), uintBitsToFloat(SKINNED_VERTICES[word + 2]));
+}
+
+void WriteVector3(uint word, vec3 value)
+{
+	LIT_VERTICES[word] = floatBitsToUint(value.x);
+	LIT_VERTICES[word + 1] = floatBitsToUint(value.y);
+	LIT_VERTICES[word + 2] = floatBitsToUint(value.z);
+}
+
+void main( void )
+{
+	uint vertexIndex = gl_GlobalInvocationID.x;
+	if (vertexIndex >= gVertexCount)
+	{
+		return;
+	}
+
+	uint src = vertexIndex * SKINNED_VERTEX_WORDS;
+	uint dst = vertexIndex * LIT_VERTEX_WORDS;
+
+	// Position 0-2, color 3, uv 4-5, normal 6-8, tangent 9-12, bones 13-16, weights 17-20
+	vec3 position = ReadVector3(src);
+	vec3 normal = ReadVector3(src + 6);
+	vec3 tangent = ReadVector3(src + 9);
+
+	mat4 skinMatrix = mat4(0.0);
+	for (uint boneIndex = 0; boneIndex < 4; ++boneIndex)
+	{
+		uint bone = SKINNED_VERTICES[src + 13 + boneIndex];
+		float weight = uintBitsToFloat(SKINNED_VERTICES[src + 17 + boneIndex]);
+
+		skinMatrix += weight * SKINNING_PALETTE[gBoneOffset + bone];
+	}
+
+	vec3 skinnedPosition = (skinMatrix * vec4(position, 1.0)).xyz;
+	vec3 skinnedNormal = normalize((skinMatrix * vec4(normal, 0.0)).xyz);
+	vec3 skinnedTangent = normalize((skinMatrix * vec4(tangent, 0.0)).xyz);
+
+	WriteVector3(dst, skinnedPosition);
+	LIT_VERTICES[dst + 3] = SKINNED_VERTICES[src + 3];
+	LIT_VERTICES[dst + 4] = SKINNED_VERTICES[src + 4];
+	LIT_VERTICES[dst + 5] = SKINNED_VERTICES[src + 5];
+	WriteVector3(dst + 6, skinnedNormal);
+	WriteVector3(dst + 9, skinnedTangent);
+	LIT_VERTICES[dst + 12] = SKINNED_VERTICES[src + 12];
+})";
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+//
+// GPU Particle Update Compute Shader - ages and moves each live particle, one thread per particle,
+// appending the survivors to the write buffer
+//
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+const char* ShaderSource::GPU_PARTICLE_UPDATE_NAME = "GPU_Particle_Update";
+const char* ShaderSource::GPU_PARTICLE_UPDATE_CS = R"(
+
+#version 430 core
+
+layout(local_size_x = 64) in;
+
+struct Particle
+{
+	vec3 position;
+	float age;
+	vec3 velocity;
+	float lifetime;
+	vec3 scale;
+	float padding;
+};
+
+layout(binding = 10, std430) readonly buffer particleReadSSBO
+{
+	Particle PARTICLES_IN[];
+};
+
+layout(binding = 11, std430) writeonly buffer particleWriteSSBO
+{
+	Particle PARTICLES_OUT[];
+};
+
+layout(binding = 12, std430) buffer particleCounterSSBO
+{
+	uint LIVE_COUNT;
+	uint WRITE_COUNT;
+};
+
+layout(location = 0) uniform float gDeltaSeconds;
+layout(location = 1) uniform vec3 gForce;
+
+void main( void )
+{
+	uint index = gl_GlobalInvocationID.x;
+	if (index >= LIVE_COUNT)
+	{
+		return;
+	}
+
+	Particle particle = PARTICLES_IN[index];
+
+	particle.age += gDeltaSeconds;
+	if (particle.age >= particle.lifetime)
+	{
+		return;
+	}
+
+	// Forward euler with unit mass, same as the CPU emitter
+	particle.velocity += gForce * gDeltaSeconds;
+	particle.position += particle.velocity * gDeltaSeconds;
+
+	PARTICLES_OUT[atomicAdd(WRITE_COUNT, 1u)] = particle;
+})";
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+//
+// GPU Particle Spawn Compute Shader - appends new particles after the survivors, one thread per
+// particle, with values hashed from the seed and thread so no generator state is kept on the GPU
+//
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+const char* ShaderSource::GPU_PARTICLE_SPAWN_NAME = "GPU_Particle_Spawn";
+const char* ShaderSource::GPU_PARTICLE_SPAWN_CS = R"(
+
+#version 430 core
+
+layout(local_size_x = 64) in;
+
+struct Particle
+{
+	vec3 position;
+	float age;
+	vec3 velocity;
+	float lifetime;
+	vec3 scale;
+	float padding;
+};
+
+layout(binding = 11, std430) writeonly buffer particleWriteSSBO
+{
+	Particle PARTICLES_OUT[];
+};
+
+layout(binding = 12, std430) buffer particleCounterSSBO
+{
+	uint LIVE_COUNT;
+	uint WRITE_COUNT;
+};
+
+layout(location = 0) uniform uint gSpawnCount;
+layout(location = 1) uniform uint gSeed;
+layout(location = 2) uniform uint gMaxParticles;
+layout(location = 3) uniform vec3 gPosition;
+layout(location = 4) uniform vec3 gMinVelocity;
+layout(location = 5) uniform vec3 gMaxVelocity;
+layout(location = 6) uniform float gMinLifetime;
+layout(location = 7) uniform float gMaxLifetime;
+layout(location = 8) uniform vec3 gMinScale;
+layout(location = 9) uniform vec3 gMaxScale;
+
+// PCG hash
+uint Hash(uint value)
+{
+	uint state = value * 747796405u + 2891336453u;
+	uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+	return (word >> 22u) ^ word;
+}
+
+float GetRandomZeroToOne(inout uint state)
+{
+	state = Hash(state);
+	return float(state) / 4294967295.0;
+}
+
+void main( void )
+{
+	uint spawnIndex = gl_GlobalInvocationID.x;
+	if (spawnIndex >= gSpawnCount)
+	{
+		return;
+	}
+
+	// Past the max the count is clamped by the finalize pass, and the particle is dropped
+	uint index = atomicAdd(WRITE_COUNT, 1u);
+	if (index >= gMaxParticles)
+	{
+		return;
+	}
+
+	uint state = Hash(gSeed ^ Hash(spawnIndex));
+
+	Particle particle;
+	particle.position = gPosition;
+	particle.age = 0.0;
+	particle.velocity = mix(gMinVelocity, gMaxVelocity, vec3(GetRandomZeroToOne(state), GetRandomZeroToOne(state), GetRandomZeroToOne(state)));
+	particle.lifetime = mix(gMinLifetime, gMaxLifetime, GetRandomZeroToOne(state));
+	particle.scale = mix(gMinScale, gMaxScale, vec3(GetRandomZeroToOne(state), GetRandomZeroToOne(state), GetRandomZeroToOne(state)));
+	particle.padding = 0.0;
+
+	PARTICLES_OUT[index] = particle;
+})";
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+//
+// GPU Particle Finalize Compute Shader - a single thread, makes the count written this update the
+// live count and the draw command's instance count, and resets the write count for the next
+//
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+const char* ShaderSource::GPU_PARTICLE_FINALIZE_NAME = "GPU_Particle_Finalize";
+const char* ShaderSource::GPU_PARTICLE_FINALIZE_CS = R"(
+
+#version 430 core
+
+layout(local_size_x = 1) in;
+
+layout(binding = 12, std430) buffer particleCounterSSBO
+{
+	uint LIVE_COUNT;
+	uint WRITE_COUNT;
+};
+
+// DrawElementsIndirectCommand_t, only the instance count is written here
+layout(binding = 13, std430) buffer particleCommandSSBO
+{
+	uint COMMAND_COUNT;
+	uint COMMAND_INSTANCE_COUNT;
+	uint COMMAND_FIRST_INDEX;
+	int COMMAND_BASE_VERTEX;
+	uint COMMAND_BASE_INSTANCE;
+};
+
+layout(location = 0) uniform uint gMaxParticles;
+
+void main( void )
+{
+	LIVE_COUNT = min(WRITE_COUNT, gMaxParticles);
+	WRITE_COUNT = 0u;
+
+	COMMAND_INSTANCE_COUNT = LIVE_COUNT;
+})";
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+//
+// GPU Particle Shader - draws an instance of the mesh per particle, placed and scaled by the
+// particle it reads from the storage buffer, fading out over the particle's life
+//
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------
+const char* ShaderSource::GPU_PARTICLE_NAME = "GPU_Particle";
+const char* ShaderSource::GPU_PARTICLE_VS = R"(
+
+#version 430 core
+
+layout(binding=1, std140) uniform cameraUBO
+{
+	mat4 VIEW;
+	mat4 PROJECTION;
+};
+
+struct Particle
+{
+	vec3 position;
+	float age;
+	vec3 velocity;
+	float lifetime;
+	vec3 scale;
+	float padding;
+};
+
+layout(binding = 10, std430) readonly buffer particleReadSSBO
+{
+	Particle PARTICLES[];
+};
+
+in vec3 POSITION;
+in vec4 COLOR;
+in vec2 UV;
+
+out vec2 passUV;
+out vec4 passColor;
+
+void main( void )
+{
+	Particle particle = PARTICLES[gl_InstanceID];
+
+	vec4 world_pos = vec4(particle.position + POSITION * particle.scale, 1);
+	gl_Position = PROJECTION * VIEW * world_pos;
+
+	passUV = UV;
+	passColor = COLOR;
+	passColor.a *= 1.0 - clamp(particle.age / particle.lifetime, 0.0, 1.0);
+})";
+
+const char* ShaderSource::GPU_PARTICLE_FS = ShaderSource::DEFAULT_OPAQUE_INSTANCED_FS;
+const RenderState ShaderSource::GPU_PARTICLE_STATE = ShaderSource::DEFAULT_ALPHA_STATE;
+
+
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Virtual Texture sampling - SampleVirtualTexture(uv) looks the tile up in the page table, reads it out of the physical cache,
+// and reports the tile it wanted for one in 16 fragments a frame
+//------------------------------------------------------------------------------------------------------------------------------
+const char* ShaderSource::VIRTUAL_TEXTURE_GLSL = R"(
+
+layout(binding = 6) uniform sampler2D gVirtualPageTable;
+layout(binding = 7) uniform sampler2D gVirtualPhysicalCache;
+
+layout(binding=9, std140) uniform virtualTextureUBO
+{
+	vec2 VIRTUAL_PAGE_COUNTS;
+	vec2 VIRTUAL_DIMENSIONS;
+	vec2 VIRTUAL_PHYSICAL_DIMENSIONS;
+	float VIRTUAL_TILE_SIZE;
+	float VIRTUAL_BORDER_TEXELS;
+	float VIRTUAL_MIP_COUNT;
+	float VIRTUAL_FEEDBACK_PHASE;
+	vec2 VIRTUAL_PADDING;
+};
+
+layout(binding=15, std430) buffer virtualFeedbackSSBO
+{
+	uint VIRTUAL_FEEDBACK_BITS[];
+};
+
+vec4 SampleVirtualTexture(vec2 uv)
+{
+	uv = clamp(uv, vec2(0.0), vec2(0.99999));
+
+	// Level from the texel footprint at level 0
+	vec2 texelCoords = uv * VIRTUAL_DIMENSIONS;
+	vec2 dx = dFdx(texelCoords);
+	vec2 dy = dFdy(texelCoords);
+	int wantedMip = int(clamp(floor(0.5 * log2(max(max(dot(dx, dx), dot(dy, dy)), 1.0))), 0.0, VIRTUAL_MIP_COUNT - 1.0));
+
+	ivec2 basePageCounts = ivec2(VIRTUAL_PAGE_COUNTS);
+	ivec2 levelPageCounts = max(basePageCounts >> wantedMip, ivec2(1));
+	ivec2 page = min(ivec2(uv * vec2(levelPageCounts)), levelPageCounts - 1);
+
+	ivec2 patternCoords = ivec2(gl_FragCoord.xy) & 3;
+	if (patternCoords.x + patternCoords.y * 4 == int(VIRTUAL_FEEDBACK_PHASE))
+	{
+		uint pageIndex = 0u;
+		for (int mip = 0; mip < wantedMip; ++mip)
+		{
+			ivec2 mipPageCounts = max(basePageCounts >> mip, ivec2(1));
+			pageIndex += uint(mipPageCounts.x * mipPageCounts.y);
+		}
+
+		pageIndex += uint(page.y * levelPageCounts.x + page.x);
+
+		// Most fragments want a page some other fragment already reported
+		uint pageBit = 1u << (pageIndex & 31u);
+		if ((VIRTUAL_FEEDBACK_BITS[pageIndex >> 5u] & pageBit) == 0u)
+		{
+			atomicOr(VIRTUAL_FEEDBACK_BITS[pageIndex >> 5u], pageBit);
+		}
+	}
+
+	// The entry is the finest resident tile covering the page - slot x, slot y and the level it's from
+	vec4 entry = floor(texelFetch(gVirtualPageTable, page, wantedMip) * 255.0 + 0.5);
+	vec2 entryPageCounts = vec2(max(basePageCounts >> int(entry.z), ivec2(1)));
+	vec2 withinTile = fract(uv * entryPageCounts);
+
+	float paddedTileSize = VIRTUAL_TILE_SIZE + 2.0 * VIRTUAL_BORDER_TEXELS;
+	vec2 physicalTexel = entry.xy * paddedTileSize + VIRTUAL_BORDER_TEXELS + withinTile * VIRTUAL_TILE_SIZE;
+
+	return textureLod(gVirtualPhysicalCache, physicalTexel / VIRTUAL_PHYSICAL_DIMENSIONS, 0.0);
+})";
@@ -54,6 +54,10 @@ namespace ShaderSource
 	extern const char* UI_SHADER_FS;
 	extern const RenderState UI_SHADER_STATE;
 
+	// UI Signed Distance Field Shader, uses the UI vertex shader and state
+	extern const char* UI_SDF_SHADER_NAME;
+	extern const char* UI_SDF_SHADER_FS;
+
 
 	// Invalid Shader (SHOULD ALWAYS COMPILE)
 	extern const char* INVALID_SHADER_NAME;
@@ -162,4 +166,55 @@ namespace ShaderSource
 	extern const char* UV_FS;
 	extern const RenderState UV_STATE;
 
+
+	// Depth Only Instanced, for the depth pre-pass
+	extern const char* DEPTH_ONLY_NAME;
+	extern const char* DEPTH_ONLY_VS;
+	extern const char* DEPTH_ONLY_FS;
+	extern const RenderState DEPTH_ONLY_STATE;
+
+
+	// Deferred G-Buffer Instanced, for deferred cameras' deferrable draws
+	extern const char* DEFERRED_GBUFFER_NAME;
+	extern const char* DEFERRED_GBUFFER_VS;
+	extern const char* DEFERRED_GBUFFER_FS;
+	extern const RenderState DEFERRED_GBUFFER_STATE;
+
+
+	// Deferred Lighting, lights a deferred camera's G-buffer into its color target
+	extern const char* DEFERRED_LIGHTING_NAME;
+	extern const char* DEFERRED_LIGHTING_VS;
+	extern const char* DEFERRED_LIGHTING_FS;
+	extern const RenderState DEFERRED_LIGHTING_STATE;
+
+
+	// Hi-Z Reduce Compute, for occlusion culling
+	extern const char* HI_Z_REDUCE_NAME;
+	extern const char* HI_Z_REDUCE_CS;
+
+
+	// GPU Skinning Compute, skins a VertexSkinned mesh into a VertexLit one for GPUSkinning
+	extern const char* GPU_SKINNING_NAME;
+	extern const char* GPU_SKINNING_CS;
+
+
+	// GPU Particles - compute passes for GPUParticleEmitter, and the shader its particles are drawn with
+	extern const char* GPU_PARTICLE_UPDATE_NAME;
+	extern const char* GPU_PARTICLE_UPDATE_CS;
+
+	extern const char* GPU_PARTICLE_SPAWN_NAME;
+	extern const char* GPU_PARTICLE_SPAWN_CS;
+
+	extern const char* GPU_PARTICLE_FINALIZE_NAME;
+	extern const char* GPU_PARTICLE_FINALIZE_CS;
+
+	extern const char* GPU_PARTICLE_NAME;
+	extern const char* GPU_PARTICLE_VS;
+	extern const char* GPU_PARTICLE_FS;
+	extern const RenderState GPU_PARTICLE_STATE;
+
+
+	// Virtual Texture sampling functions, for fragment shaders to include after their #version (see VirtualTexture)
+	extern const char* VIRTUAL_TEXTURE_GLSL;
+
 };
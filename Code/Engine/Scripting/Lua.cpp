@@ -148,3 +148,258 @@ void LuaScript::PrintStack() const
 		}
 	}
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Looks up the variable once and stores it in the registry, returning an invalid reference if it doesn't exist
+//
+LuaReference_t LuaScript::CreateReference(const std::string& variableName)
+{
+	LuaReference_t reference;
+
+	if (m_luaVirtualMachine == nullptr)
+	{
+		PrintLuaMessage("Attempted to CreateReference() on a script that isn't loaded");
+		return reference;
+	}
+
+	if (GetToStack(variableName))
+	{
+		// Pops the value, so only the tables above it are left
+		reference.registryIndex = luaL_ref(m_luaVirtualMachine, LUA_REGISTRYINDEX);
+	}
+
+	ClearLuaStack();
+
+	return reference;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stores the string in the registry, so field lookups with it push the interned string instead of hashing a new one
+//
+LuaReference_t LuaScript::CreateKeyReference(const char* key)
+{
+	LuaReference_t reference;
+
+	if (m_luaVirtualMachine == nullptr)
+	{
+		PrintLuaMessage("Attempted to CreateKeyReference() on a script that isn't loaded");
+		return reference;
+	}
+
+	lua_pushstring(m_luaVirtualMachine, key);
+	reference.registryIndex = luaL_ref(m_luaVirtualMachine, LUA_REGISTRYINDEX);
+
+	return reference;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Frees the registry slot, so the referenced value can be collected
+//
+void LuaScript::ReleaseReference(LuaReference_t& reference)
+{
+	if (m_luaVirtualMachine != nullptr && reference.IsValid())
+	{
+		luaL_unref(m_luaVirtualMachine, LUA_REGISTRYINDEX, reference.registryIndex);
+	}
+
+	reference.registryIndex = LUA_NOREF;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the global to a C function, with userData given to it as its first upvalue
+// (lua_touserdata(L, lua_upvalueindex(1)))
+//
+void LuaScript::RegisterFunction(const char* name, lua_CFunction function, void* userData)
+{
+	if (m_luaVirtualMachine == nullptr)
+	{
+		PrintLuaMessage("Attempted to RegisterFunction() on a script that isn't loaded");
+		return;
+	}
+
+	lua_pushlightuserdata(m_luaVirtualMachine, userData);
+	lua_pushcclosure(m_luaVirtualMachine, function, 1);
+	lua_setglobal(m_luaVirtualMachine, name);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the global to a new empty table, returning a reference to it for SetField()
+//
+LuaReference_t LuaScript::CreateGlobalTable(const char* tableName)
+{
+	LuaReference_t reference;
+
+	if (m_luaVirtualMachine == nullptr)
+	{
+		PrintLuaMessage("Attempted to CreateGlobalTable() on a script that isn't loaded");
+		return reference;
+	}
+
+	lua_newtable(m_luaVirtualMachine);
+	lua_pushvalue(m_luaVirtualMachine, -1);
+	lua_setglobal(m_luaVirtualMachine, tableName);
+	reference.registryIndex = luaL_ref(m_luaVirtualMachine, LUA_REGISTRYINDEX);
+
+	return reference;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Pushes the referenced value onto the stack, returning false without pushing if the reference is invalid
+//
+bool LuaScript::PushReference(const LuaReference_t& reference)
+{
+	if (m_luaVirtualMachine == nullptr || !reference.IsValid())
+	{
+		return false;
+	}
+
+	lua_rawgeti(m_luaVirtualMachine, LUA_REGISTRYINDEX, reference.registryIndex);
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Pushes the referenced function onto the stack, returning false without pushing if it's not a function
+//
+bool LuaScript::PushFunction(const LuaReference_t& function)
+{
+	if (!PushReference(function))
+	{
+		PrintLuaMessage("Attempted to call an invalid function reference");
+		return false;
+	}
+
+	if (!lua_isfunction(m_luaVirtualMachine, -1))
+	{
+		PrintLuaMessage(Stringf("Attempted to call a reference to a %s", luaL_typename(m_luaVirtualMachine, -1)));
+		lua_pop(m_luaVirtualMachine, 1);
+		return false;
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Calls the function below the arguments, logging and popping the error if it fails
+//
+bool LuaScript::ProtectedCall(int numArgs, int numResults)
+{
+	if (lua_pcall(m_luaVirtualMachine, numArgs, numResults, 0) != LUA_OK)
+	{
+		const char* error = lua_tostring(m_luaVirtualMachine, -1);
+		PrintLuaMessage(Stringf("Function call failed: %s", (error != nullptr ? error : "unknown error")));
+		lua_pop(m_luaVirtualMachine, 1);
+		return false;
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Argument pushing, one per type
+//
+void LuaScript::PushValue(bool value)
+{
+	lua_pushboolean(m_luaVirtualMachine, (value ? 1 : 0));
+}
+
+void LuaScript::PushValue(int value)
+{
+	lua_pushinteger(m_luaVirtualMachine, (lua_Integer)value);
+}
+
+void LuaScript::PushValue(unsigned int value)
+{
+	lua_pushinteger(m_luaVirtualMachine, (lua_Integer)value);
+}
+
+void LuaScript::PushValue(float value)
+{
+	lua_pushnumber(m_luaVirtualMachine, (lua_Number)value);
+}
+
+void LuaScript::PushValue(double value)
+{
+	lua_pushnumber(m_luaVirtualMachine, (lua_Number)value);
+}
+
+void LuaScript::PushValue(const char* value)
+{
+	lua_pushstring(m_luaVirtualMachine, value);
+}
+
+void LuaScript::PushValue(const std::string& value)
+{
+	lua_pushlstring(m_luaVirtualMachine, value.data(), value.size());
+}
+
+void LuaScript::PushValue(const LuaReference_t& value)
+{
+	// Keep the argument count right even if the reference is bad
+	if (!PushReference(value))
+	{
+		lua_pushnil(m_luaVirtualMachine);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Value reading, one per type
+//
+bool LuaScript::ReadValue(int stackIndex, bool& out_value)
+{
+	if (!lua_isboolean(m_luaVirtualMachine, stackIndex))
+	{
+		PrintLuaMessage(Stringf("Attempted to read a %s as a bool", luaL_typename(m_luaVirtualMachine, stackIndex)));
+		return false;
+	}
+
+	out_value = (lua_toboolean(m_luaVirtualMachine, stackIndex) != 0);
+	return true;
+}
+
+bool LuaScript::ReadValue(int stackIndex, int& out_value)
+{
+	if (!lua_isnumber(m_luaVirtualMachine, stackIndex))
+	{
+		PrintLuaMessage(Stringf("Attempted to read a %s as an int", luaL_typename(m_luaVirtualMachine, stackIndex)));
+		return false;
+	}
+
+	out_value = (int)lua_tonumber(m_luaVirtualMachine, stackIndex);
+	return true;
+}
+
+bool LuaScript::ReadValue(int stackIndex, float& out_value)
+{
+	if (!lua_isnumber(m_luaVirtualMachine, stackIndex))
+	{
+		PrintLuaMessage(Stringf("Attempted to read a %s as a float", luaL_typename(m_luaVirtualMachine, stackIndex)));
+		return false;
+	}
+
+	out_value = (float)lua_tonumber(m_luaVirtualMachine, stackIndex);
+	return true;
+}
+
+bool LuaScript::ReadValue(int stackIndex, std::string& out_value)
+{
+	if (!lua_isstring(m_luaVirtualMachine, stackIndex))
+	{
+		PrintLuaMessage(Stringf("Attempted to read a %s as a string", luaL_typename(m_luaVirtualMachine, stackIndex)));
+		return false;
+	}
+
+	size_t length = 0;
+	const char* value = lua_tolstring(m_luaVirtualMachine, stackIndex, &length);
+	out_value.assign(value, length);
+	return true;
+}
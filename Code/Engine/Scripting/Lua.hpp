@@ -21,6 +21,15 @@ extern "C"
 #include <vector>
 #include "Engine/Core/Utility/StringUtils.hpp"
 
+// A value kept in the script's registry, i.e. a function or table, so it's fetched by index instead of by name
+// References are only valid for the script that made them, until released or the script is destroyed
+struct LuaReference_t
+{
+	bool IsValid() const { return (registryIndex != LUA_NOREF && registryIndex != LUA_REFNIL); }
+
+	int registryIndex = LUA_NOREF;
+};
+
 
 class LuaScript
 {
@@ -32,6 +41,170 @@ public:
 
 	void PrintLuaMessage(const std::string& message) const;
 	void ClearLuaStack();
+	bool IsLoaded() const { return (m_luaVirtualMachine != nullptr); }
+
+
+public:
+	//-----Cached References-----
+
+	// Names are looked up once here - calls and field reads through the references don't hash them again
+	LuaReference_t	CreateReference(const std::string& variableName);	// Same naming as Get(), i.e. "ai.think"
+	LuaReference_t	CreateKeyReference(const char* key);				// An interned string key, for GetField()
+	void			ReleaseReference(LuaReference_t& reference);
+
+
+	//-----------------------------------------------------------------------------------------------
+	// Returns the field of the referenced table, looked up by a key from CreateKeyReference()
+	//
+	template <typename T>
+	T GetField(const LuaReference_t& table, const LuaReference_t& key)
+	{
+		T result = T();
+
+		if (PushReference(table))
+		{
+			if (lua_istable(m_luaVirtualMachine, -1) && PushReference(key))
+			{
+				lua_gettable(m_luaVirtualMachine, -2);
+				ReadValue(-1, result);
+				lua_pop(m_luaVirtualMachine, 1);
+			}
+
+			lua_pop(m_luaVirtualMachine, 1);
+		}
+
+		return result;
+	}
+
+
+	//-----------------------------------------------------------------------------------------------
+	// Returns the element of the referenced array, Lua indices starting from 1
+	//
+	template <typename T>
+	T GetElement(const LuaReference_t& table, int luaIndex)
+	{
+		T result = T();
+
+		if (PushReference(table))
+		{
+			if (lua_istable(m_luaVirtualMachine, -1))
+			{
+				lua_rawgeti(m_luaVirtualMachine, -1, luaIndex);
+				ReadValue(-1, result);
+				lua_pop(m_luaVirtualMachine, 1);
+			}
+
+			lua_pop(m_luaVirtualMachine, 1);
+		}
+
+		return result;
+	}
+
+
+public:
+	//-----Globals-----
+
+	// For marshalling data in from C++
+	void			RegisterFunction(const char* name, lua_CFunction function, void* userData);	// userData is the function's first upvalue
+	LuaReference_t	CreateGlobalTable(const char* tableName);	// Replaces any global of that name with an empty table
+
+
+	//-----------------------------------------------------------------------------------------------
+	// Sets the field of the referenced table, taking the same value types as the calls' arguments
+	//
+	template <typename T>
+	void SetField(const LuaReference_t& table, const char* fieldName, const T& value)
+	{
+		if (PushReference(table))
+		{
+			if (lua_istable(m_luaVirtualMachine, -1))
+			{
+				PushValue(value);
+				lua_setfield(m_luaVirtualMachine, -2, fieldName);
+			}
+
+			lua_pop(m_luaVirtualMachine, 1);
+		}
+	}
+
+
+public:
+	//-----Typed Calls-----
+
+	// Arguments can be bools, ints, floats, doubles, strings or LuaReference_ts (pushing the referenced value)
+	// Calls return false if the reference isn't a function or the function errors, logging the error
+
+	//-----------------------------------------------------------------------------------------------
+	template <typename... ARGS>
+	bool CallFunction(const LuaReference_t& function, const ARGS&... args)
+	{
+		if (!PushFunction(function))
+		{
+			return false;
+		}
+
+		int numArgs = PushValues(args...);
+		return ProtectedCall(numArgs, 0);
+	}
+
+
+	//-----------------------------------------------------------------------------------------------
+	// Calls the function, reading its first return value into out_result - bool, int, float or std::string
+	//
+	template <typename RESULT, typename... ARGS>
+	bool CallFunctionWithResult(const LuaReference_t& function, RESULT& out_result, const ARGS&... args)
+	{
+		if (!PushFunction(function))
+		{
+			return false;
+		}
+
+		int numArgs = PushValues(args...);
+		if (!ProtectedCall(numArgs, 1))
+		{
+			return false;
+		}
+
+		bool readResult = ReadValue(-1, out_result);
+		lua_pop(m_luaVirtualMachine, 1);
+
+		return readResult;
+	}
+
+
+	//-----------------------------------------------------------------------------------------------
+	// Calls the function once per element, i.e. function(entities[i], deltaSeconds) for each entity's table,
+	// fetching the function once for the whole batch
+	// Returns the number of calls that failed, so one entity's error doesn't stop the rest
+	//
+	template <typename ELEMENT, typename... ARGS>
+	int CallFunctionForEach(const LuaReference_t& function, const ELEMENT* elements, int elementCount, const ARGS&... sharedArgs)
+	{
+		if (!PushFunction(function))
+		{
+			return elementCount;
+		}
+
+		int numFailed = 0;
+
+		for (int elementIndex = 0; elementIndex < elementCount; ++elementIndex)
+		{
+			lua_pushvalue(m_luaVirtualMachine, -1);		// pcall pops the function, so call a copy
+			PushValue(elements[elementIndex]);
+			int numArgs = 1 + PushValues(sharedArgs...);
+
+			if (!ProtectedCall(numArgs, 0))
+			{
+				numFailed++;
+			}
+		}
+
+		// Remove the function
+		lua_pop(m_luaVirtualMachine, 1);
+
+		return numFailed;
+	}
+
 
 public:
 	//-----Data Manipulation-----
@@ -69,6 +242,44 @@ public:
 	}
 
 
+private:
+	//-----Call Helpers-----
+
+	bool PushReference(const LuaReference_t& reference);
+	bool PushFunction(const LuaReference_t& function);
+	bool ProtectedCall(int numArgs, int numResults);	// Pops the error message on failure
+
+	// Pushing arguments, without making strings
+	void PushValue(bool value);
+	void PushValue(int value);
+	void PushValue(unsigned int value);
+	void PushValue(float value);
+	void PushValue(double value);
+	void PushValue(const char* value);
+	void PushValue(const std::string& value);
+	void PushValue(const LuaReference_t& value);
+
+	//-----------------------------------------------------------------------------------------------
+	inline int PushValues()
+	{
+		return 0;
+	}
+
+	//-----------------------------------------------------------------------------------------------
+	template <typename FIRST, typename... REST>
+	int PushValues(const FIRST& first, const REST&... rest)
+	{
+		PushValue(first);
+		return 1 + PushValues(rest...);
+	}
+
+	// Reading values off the stack, returning false and logging if the value isn't that type
+	bool ReadValue(int stackIndex, bool& out_value);
+	bool ReadValue(int stackIndex, int& out_value);
+	bool ReadValue(int stackIndex, float& out_value);
+	bool ReadValue(int stackIndex, std::string& out_value);
+
+
 private:
 	//-----Data Accessor Helpers (Template Specializations)-----
 
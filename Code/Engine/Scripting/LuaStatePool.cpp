@@ -0,0 +1,477 @@
+/************************************************************************/
+/* File: LuaStatePool.cpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: Implementation of the LuaStatePool class
+/************************************************************************/
+#include "Engine/Scripting/LuaStatePool.hpp"
+#include "Engine/Core/LogSystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/JobSystem/Job.hpp"
+#include "Engine/Core/JobSystem/JobSystem.hpp"
+#include "Engine/Core/Time/ProfileScopeRegistry.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// Runs a pool's update function over a range of entities on a worker
+//
+class ScriptUpdateJob : public Job
+{
+public:
+	//-----Public Methods-----
+
+	ScriptUpdateJob(LuaStatePool* pool, const char* functionName, const ScriptEntityInput_t* inputs, int inputCount, float deltaSeconds, ScriptCommandBuffer* out_commands, int* out_numFailed);
+
+	virtual void	Execute() override;		// Worker
+
+
+public:
+	//-----Public Data-----
+
+	LuaStatePool*				m_pool = nullptr;
+	std::string					m_functionName;
+	const ScriptEntityInput_t*	m_inputs = nullptr;
+	int							m_inputCount = 0;
+	float						m_deltaSeconds = 0.f;
+	ScriptCommandBuffer*		m_commands = nullptr;
+	int*						m_numFailed = nullptr;
+
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - script updates are frame work, so they're critical
+//
+ScriptUpdateJob::ScriptUpdateJob(LuaStatePool* pool, const char* functionName, const ScriptEntityInput_t* inputs, int inputCount, float deltaSeconds, ScriptCommandBuffer* out_commands, int* out_numFailed)
+	: m_pool(pool)
+	, m_functionName(functionName)
+	, m_inputs(inputs)
+	, m_inputCount(inputCount)
+	, m_deltaSeconds(deltaSeconds)
+	, m_commands(out_commands)
+	, m_numFailed(out_numFailed)
+{
+	m_jobType = SCRIPT_UPDATE_JOB_TYPE;
+	m_jobFlags = WORKER_FLAGS_ALL_BUT_DISK;
+	m_priority = JOB_PRIORITY_CRITICAL;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Runs the update on a borrowed state
+//
+void ScriptUpdateJob::Execute()
+{
+	PROFILE_SCOPE_CATEGORY("ScriptUpdateJob::Execute", "Scripting");
+
+	int numFailed = m_pool->RunUpdate(m_functionName, m_inputs, m_inputCount, m_deltaSeconds, m_commands);
+
+	if (m_numFailed != nullptr)
+	{
+		*m_numFailed = numFailed;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds the command to the end of the buffer
+//
+void ScriptCommandBuffer::Push(const ScriptCommand_t& command)
+{
+	m_commands.push_back(command);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Adds all of the other buffer's commands to the end of this one, in order
+//
+void ScriptCommandBuffer::Append(const ScriptCommandBuffer& other)
+{
+	m_commands.insert(m_commands.end(), other.m_commands.begin(), other.m_commands.end());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Removes all commands, keeping the memory for the next frame
+//
+void ScriptCommandBuffer::Clear()
+{
+	m_commands.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of commands in the buffer
+//
+int ScriptCommandBuffer::GetCount() const
+{
+	return (int)m_commands.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the command at the index, in the order they were emitted
+//
+const ScriptCommand_t& ScriptCommandBuffer::GetCommand(int commandIndex) const
+{
+	return m_commands[commandIndex];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Constructor - loads the script into every state up front, so the first frame doesn't
+//
+LuaStatePool::LuaStatePool(const char* scriptFilepath, int numStates /*= -1*/)
+	: m_scriptFilepath(scriptFilepath)
+{
+	if (numStates < 1)
+	{
+		JobSystem* jobSystem = JobSystem::GetInstance();
+		numStates = (jobSystem != nullptr ? jobSystem->GetWorkerThreadCount() + 1 : 1);
+	}
+
+	for (int stateIndex = 0; stateIndex < numStates; ++stateIndex)
+	{
+		PooledState_t* state = CreateState();
+		m_states.push_back(state);
+		m_freeStates.push_back(state);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Destructor - no jobs can still be using the states
+//
+LuaStatePool::~LuaStatePool()
+{
+	ASSERT_RECOVERABLE(m_freeStates.size() == m_states.size(), "Error: LuaStatePool destroyed while its states were still in use");
+
+	for (int stateIndex = 0; stateIndex < (int)m_states.size(); ++stateIndex)
+	{
+		// Closing the state frees its references
+		delete m_states[stateIndex]->script;
+		delete m_states[stateIndex];
+	}
+
+	m_states.clear();
+	m_freeStates.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the shared value, which each state copies in before its next update
+//
+void LuaStatePool::SetSharedBool(const std::string& name, bool value)
+{
+	SharedValue_t sharedValue;
+	sharedValue.type = SHARED_VALUE_BOOL;
+	sharedValue.number = (value ? 1.0 : 0.0);
+
+	SetSharedValue(name, sharedValue);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the shared value, which each state copies in before its next update
+//
+void LuaStatePool::SetSharedNumber(const std::string& name, double value)
+{
+	SharedValue_t sharedValue;
+	sharedValue.type = SHARED_VALUE_NUMBER;
+	sharedValue.number = value;
+
+	SetSharedValue(name, sharedValue);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Sets the shared value, which each state copies in before its next update
+//
+void LuaStatePool::SetSharedString(const std::string& name, const std::string& value)
+{
+	SharedValue_t sharedValue;
+	sharedValue.type = SHARED_VALUE_STRING;
+	sharedValue.string = value;
+
+	SetSharedValue(name, sharedValue);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Queues a job running the update function over the inputs on a pooled state
+//
+int LuaStatePool::QueueUpdate(const char* functionName, const ScriptEntityInput_t* inputs, int inputCount, float deltaSeconds, ScriptCommandBuffer* out_commands, int* out_numFailed /*= nullptr*/)
+{
+	ScriptUpdateJob* job = new ScriptUpdateJob(this, functionName, inputs, inputCount, deltaSeconds, out_commands, out_numFailed);
+	return JobSystem::GetInstance()->QueueJob(job);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Runs the update function over the inputs across the workers, with the main thread taking the last range
+// Each job writes its own command buffer, so the commands come back in input order without any locking
+//
+int LuaStatePool::UpdateEntities(const char* functionName, const ScriptEntityInput_t* inputs, int inputCount, float deltaSeconds, ScriptCommandBuffer& out_commands, int entitiesPerJob /*= LUA_STATE_POOL_DEFAULT_ENTITIES_PER_JOB*/)
+{
+	PROFILE_SCOPE_CATEGORY("LuaStatePool::UpdateEntities", "Scripting");
+
+	if (inputCount <= 0)
+	{
+		return 0;
+	}
+
+	entitiesPerJob = MaxInt(entitiesPerJob, 1);
+	int numRanges = (inputCount + entitiesPerJob - 1) / entitiesPerJob;
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	if (jobSystem == nullptr || jobSystem->GetWorkerThreadCount() == 0 || numRanges == 1)
+	{
+		return RunUpdate(functionName, inputs, inputCount, deltaSeconds, &out_commands);
+	}
+
+	m_jobCommandBuffers.resize(numRanges);
+	m_jobFailureCounts.assign(numRanges, 0);
+	m_jobIDs.clear();
+
+	for (int rangeIndex = 0; rangeIndex < numRanges; ++rangeIndex)
+	{
+		m_jobCommandBuffers[rangeIndex].Clear();
+	}
+
+	int lastRangeIndex = numRanges - 1;
+	for (int rangeIndex = 0; rangeIndex < lastRangeIndex; ++rangeIndex)
+	{
+		int rangeBegin = rangeIndex * entitiesPerJob;
+		int jobID = QueueUpdate(functionName, inputs + rangeBegin, entitiesPerJob, deltaSeconds, &m_jobCommandBuffers[rangeIndex], &m_jobFailureCounts[rangeIndex]);
+		m_jobIDs.push_back(jobID);
+	}
+
+	int lastRangeBegin = lastRangeIndex * entitiesPerJob;
+	m_jobFailureCounts[lastRangeIndex] = RunUpdate(functionName, inputs + lastRangeBegin, inputCount - lastRangeBegin, deltaSeconds, &m_jobCommandBuffers[lastRangeIndex]);
+
+	for (int jobIndex = 0; jobIndex < (int)m_jobIDs.size(); ++jobIndex)
+	{
+		jobSystem->BlockUntilJobIsFinalized(m_jobIDs[jobIndex]);
+	}
+
+	int numFailed = 0;
+	for (int rangeIndex = 0; rangeIndex < numRanges; ++rangeIndex)
+	{
+		out_commands.Append(m_jobCommandBuffers[rangeIndex]);
+		numFailed += m_jobFailureCounts[rangeIndex];
+	}
+
+	return numFailed;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the number of states made, including any made past the initial count
+//
+int LuaStatePool::GetStateCount() const
+{
+	std::lock_guard<std::mutex> lock(m_stateLock);
+	return (int)m_states.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns true if the script loaded, checked on the first state
+//
+bool LuaStatePool::IsLoaded() const
+{
+	std::lock_guard<std::mutex> lock(m_stateLock);
+	return (m_states.size() > 0 && m_states[0]->script->IsLoaded());
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Loads the script into a new state, with EmitCommand() bound to it
+//
+LuaStatePool::PooledState_t* LuaStatePool::CreateState()
+{
+	PooledState_t* state = new PooledState_t();
+	state->script = new LuaScript(m_scriptFilepath.c_str());
+
+	if (state->script->IsLoaded())
+	{
+		state->script->RegisterFunction(LUA_STATE_POOL_EMIT_FUNCTION_NAME, EmitCommand, state);
+		state->sharedTable = state->script->CreateGlobalTable(LUA_STATE_POOL_SHARED_TABLE_NAME);
+	}
+
+	return state;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Takes a free state, making a new one if they're all in use
+//
+LuaStatePool::PooledState_t* LuaStatePool::AcquireState()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_stateLock);
+
+		if (m_freeStates.size() > 0)
+		{
+			PooledState_t* state = m_freeStates.back();
+			m_freeStates.pop_back();
+			return state;
+		}
+	}
+
+	// Loading the script is slow, so don't hold the lock for it
+	LogTaggedPrintf("LUA", "All %i states of \"%s\" are in use, loading another", GetStateCount(), m_scriptFilepath.c_str());
+	PooledState_t* state = CreateState();
+
+	std::lock_guard<std::mutex> lock(m_stateLock);
+	m_states.push_back(state);
+
+	return state;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the state to the free list
+//
+void LuaStatePool::ReleaseState(PooledState_t* state)
+{
+	std::lock_guard<std::mutex> lock(m_stateLock);
+	m_freeStates.push_back(state);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Copies the shared values into the state's shared table, if they've changed since it last ran
+// The table is replaced instead of updated, so values removed or changed by a script don't linger
+//
+void LuaStatePool::CopySharedValues(PooledState_t* state)
+{
+	std::lock_guard<std::mutex> lock(m_sharedLock);
+
+	if (state->sharedVersion == m_sharedVersion)
+	{
+		return;
+	}
+
+	LuaScript* script = state->script;
+	script->ReleaseReference(state->sharedTable);
+	state->sharedTable = script->CreateGlobalTable(LUA_STATE_POOL_SHARED_TABLE_NAME);
+
+	std::map<std::string, SharedValue_t>::const_iterator valueItr = m_sharedValues.begin();
+	for (valueItr; valueItr != m_sharedValues.end(); ++valueItr)
+	{
+		const SharedValue_t& value = valueItr->second;
+
+		switch (value.type)
+		{
+		case SHARED_VALUE_BOOL:
+			script->SetField(state->sharedTable, valueItr->first.c_str(), (value.number != 0.0));
+			break;
+		case SHARED_VALUE_NUMBER:
+			script->SetField(state->sharedTable, valueItr->first.c_str(), value.number);
+			break;
+		case SHARED_VALUE_STRING:
+			script->SetField(state->sharedTable, valueItr->first.c_str(), value.string);
+			break;
+		default:
+			break;
+		}
+	}
+
+	state->sharedVersion = m_sharedVersion;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stores the shared value and bumps the version, so every state copies the values again
+//
+void LuaStatePool::SetSharedValue(const std::string& name, const SharedValue_t& value)
+{
+	std::lock_guard<std::mutex> lock(m_sharedLock);
+
+	m_sharedValues[name] = value;
+	m_sharedVersion++;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Calls the update function for each input on a borrowed state, with its commands going to out_commands
+// Returns the number of entities whose update failed, all of them if the function doesn't exist
+//
+int LuaStatePool::RunUpdate(const std::string& functionName, const ScriptEntityInput_t* inputs, int inputCount, float deltaSeconds, ScriptCommandBuffer* out_commands)
+{
+	PooledState_t* state = AcquireState();
+	LuaScript* script = state->script;
+
+	if (!script->IsLoaded())
+	{
+		ReleaseState(state);
+		return inputCount;
+	}
+
+	CopySharedValues(state);
+
+	// Each state has its own references, so each looks the function up once
+	std::map<std::string, LuaReference_t>::iterator functionItr = state->functions.find(functionName);
+	if (functionItr == state->functions.end())
+	{
+		functionItr = state->functions.insert(std::make_pair(functionName, script->CreateReference(functionName))).first;
+	}
+
+	LuaReference_t function = functionItr->second;
+	if (!function.IsValid())
+	{
+		ReleaseState(state);
+		return inputCount;
+	}
+
+	state->currentCommands = out_commands;
+	int numFailed = 0;
+
+	for (int inputIndex = 0; inputIndex < inputCount; ++inputIndex)
+	{
+		const ScriptEntityInput_t& input = inputs[inputIndex];
+		state->currentEntityID = input.entityID;
+
+		bool succeeded = script->CallFunction(function, input.entityID, input.values[0], input.values[1], input.values[2], input.values[3], deltaSeconds);
+		if (!succeeded)
+		{
+			numFailed++;
+		}
+	}
+
+	state->currentCommands = nullptr;
+	state->currentEntityID = -1;
+	ReleaseState(state);
+
+	return numFailed;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// EmitCommand(entityID, commandType, [args...]) - entityID can be nil for the entity being updated
+// Missing args are 0, and the pooled state is the closure's upvalue
+//
+int LuaStatePool::EmitCommand(lua_State* luaState)
+{
+	PooledState_t* state = (PooledState_t*)lua_touserdata(luaState, lua_upvalueindex(1));
+
+	if (state == nullptr || state->currentCommands == nullptr)
+	{
+		return luaL_error(luaState, "EmitCommand() called outside of an update");
+	}
+
+	ScriptCommand_t command;
+	command.entityID = (int)luaL_optinteger(luaState, 1, state->currentEntityID);
+	command.commandType = (int)luaL_checkinteger(luaState, 2);
+
+	for (int argIndex = 0; argIndex < SCRIPT_COMMAND_MAX_ARGS; ++argIndex)
+	{
+		command.args[argIndex] = (float)luaL_optnumber(luaState, argIndex + 3, 0.0);
+	}
+
+	state->currentCommands->Push(command);
+
+	return 0;
+}
@@ -0,0 +1,156 @@
+/************************************************************************/
+/* File: LuaStatePool.hpp
+/* Author: Andrew Chase
+/* Date: October 14th, 2026
+/* Description: A pool of Lua states running the same script, so entity
+/*				script updates can run on the job threads - each job
+/*				borrows a state, reads copied-in shared data and writes
+/*				its results to a command buffer
+/************************************************************************/
+#pragma once
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Engine/Scripting/Lua.hpp"
+
+// Job type of every script update job
+#define SCRIPT_UPDATE_JOB_TYPE (0x4c554155)
+
+#define SCRIPT_ENTITY_MAX_INPUTS (4)
+#define SCRIPT_COMMAND_MAX_ARGS (4)
+#define LUA_STATE_POOL_DEFAULT_ENTITIES_PER_JOB (64)
+
+// Globals set in every pooled state
+#define LUA_STATE_POOL_SHARED_TABLE_NAME "shared"			// Copy of the pool's shared values, read-only by convention
+#define LUA_STATE_POOL_EMIT_FUNCTION_NAME "EmitCommand"	// EmitCommand(entityID, commandType, [up to 4 numbers])
+
+// Passed to the update function as function(entityID, values[0..3], deltaSeconds)
+struct ScriptEntityInput_t
+{
+	int		entityID = -1;
+	float	values[SCRIPT_ENTITY_MAX_INPUTS] = { 0.f, 0.f, 0.f, 0.f };
+};
+
+// Written by scripts through EmitCommand(), commandType is up to the game
+struct ScriptCommand_t
+{
+	int		entityID = -1;
+	int		commandType = 0;
+	float	args[SCRIPT_COMMAND_MAX_ARGS] = { 0.f, 0.f, 0.f, 0.f };
+};
+
+
+class ScriptCommandBuffer
+{
+public:
+	//-----Public Methods-----
+
+	void					Push(const ScriptCommand_t& command);
+	void					Append(const ScriptCommandBuffer& other);
+	void					Clear();
+
+	int						GetCount() const;
+	const ScriptCommand_t&	GetCommand(int commandIndex) const;
+
+
+private:
+	//-----Private Data-----
+
+	std::vector<ScriptCommand_t> m_commands;
+
+};
+
+
+class LuaStatePool
+{
+	friend class ScriptUpdateJob;
+
+public:
+	//-----Public Methods-----
+
+	// Each state loads the script file on its own; numStates defaults to one per worker plus the main thread
+	// More are made if every state is in use, i.e. jobs suspended on fibers
+	LuaStatePool(const char* scriptFilepath, int numStates = -1);
+	~LuaStatePool();
+
+	// Shared data, copied into each state's shared table before it next runs - safe to call while jobs run
+	void	SetSharedBool(const std::string& name, bool value);
+	void	SetSharedNumber(const std::string& name, double value);
+	void	SetSharedString(const std::string& name, const std::string& value);
+
+	// Queues one job running the update function over the inputs, returning its job ID
+	// The inputs and command buffer must stay alive until the job is finalized
+	int		QueueUpdate(const char* functionName, const ScriptEntityInput_t* inputs, int inputCount, float deltaSeconds, ScriptCommandBuffer* out_commands, int* out_numFailed = nullptr);
+
+	// Splits the inputs into jobs and blocks until they're done, appending their commands in input order; main thread only
+	// Returns the number of entities whose update failed
+	int		UpdateEntities(const char* functionName, const ScriptEntityInput_t* inputs, int inputCount, float deltaSeconds, ScriptCommandBuffer& out_commands, int entitiesPerJob = LUA_STATE_POOL_DEFAULT_ENTITIES_PER_JOB);
+
+	int		GetStateCount() const;
+	bool	IsLoaded() const;
+
+
+private:
+	//-----Private Types-----
+
+	enum eSharedValueType
+	{
+		SHARED_VALUE_BOOL,
+		SHARED_VALUE_NUMBER,
+		SHARED_VALUE_STRING
+	};
+
+	struct SharedValue_t
+	{
+		eSharedValueType	type = SHARED_VALUE_NUMBER;
+		double				number = 0.0;		// Bools too
+		std::string			string;
+	};
+
+	// A state only runs one job at a time, so nothing in it is locked
+	struct PooledState_t
+	{
+		LuaScript*							script = nullptr;
+		LuaReference_t						sharedTable;
+		unsigned int						sharedVersion = 0;
+		std::map<std::string, LuaReference_t>	functions;			// Update functions by name, looked up once
+		ScriptCommandBuffer*				currentCommands = nullptr;	// For EmitCommand(), set while a job runs
+		int									currentEntityID = -1;
+	};
+
+
+private:
+	//-----Private Methods-----
+
+	PooledState_t*	CreateState();
+	PooledState_t*	AcquireState();
+	void			ReleaseState(PooledState_t* state);
+	void			CopySharedValues(PooledState_t* state);
+	void			SetSharedValue(const std::string& name, const SharedValue_t& value);
+
+	// Runs the update function on one state, returning the number of failed entities
+	int				RunUpdate(const std::string& functionName, const ScriptEntityInput_t* inputs, int inputCount, float deltaSeconds, ScriptCommandBuffer* out_commands);
+
+	static int		EmitCommand(lua_State* luaState);
+
+
+private:
+	//-----Private Data-----
+
+	std::string									m_scriptFilepath;
+
+	mutable std::mutex							m_stateLock;
+	std::vector<PooledState_t*>					m_states;
+	std::vector<PooledState_t*>					m_freeStates;
+
+	std::mutex									m_sharedLock;
+	std::map<std::string, SharedValue_t>		m_sharedValues;
+	unsigned int								m_sharedVersion = 1;	// States start at 0, so they copy on their first job
+
+	// Reused by UpdateEntities()
+	std::vector<ScriptCommandBuffer>			m_jobCommandBuffers;
+	std::vector<int>							m_jobIDs;
+	std::vector<int>							m_jobFailureCounts;
+
+};